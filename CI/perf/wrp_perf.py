@@ -0,0 +1,530 @@
+#!/usr/bin/env python3
+"""
+Performance regression harness for the IOWarp benchmarks.
+
+Runs the benchmarks listed in a suite file, pulls metrics out of their
+output with regular expressions, and writes one JSON result file. Each
+result carries an environment fingerprint: CPU, NUMA, memory, GPUs, git
+commit, and a hash of the runtime config. A second step compares a result
+file against a stored baseline and exits non-zero on regression.
+
+A metric regresses when both of these hold:
+  - it moves in the "worse" direction by more than the threshold (relative
+    change of the mean); and
+  - a Welch t-test over the repeated samples gives p < alpha. If either
+    side has fewer than two samples, only the threshold applies.
+
+Commands:
+  run         Run a suite and write results JSON
+  compare     Compare results against a baseline
+  fingerprint Print the environment fingerprint
+
+Examples:
+  CI/perf/wrp_perf.py run --bin-dir build/bin --tags cpu -o current.json
+  CI/perf/wrp_perf.py compare baseline.json current.json --report diff.md
+
+Exit 0 = success / no regressions, 1 = regressions or failed benchmarks,
+2 = usage or input error.
+"""
+
+import argparse
+import datetime
+import glob
+import hashlib
+import json
+import math
+import os
+import platform
+import re
+import shlex
+import shutil
+import socket
+import statistics
+import subprocess
+import sys
+
+import yaml
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+ROOT = os.path.dirname(os.path.dirname(HERE))
+DEFAULT_SUITE = os.path.join(HERE, "suite.yaml")
+SCHEMA_VERSION = 1
+
+# Runtime config files whose contents make up the config hash
+CONFIG_ENV_VARS = ["CHI_SERVER_CONF", "WRP_RUNTIME_CONF"]
+
+
+# ---------------------------------------------------------------------------
+# Environment fingerprint
+# ---------------------------------------------------------------------------
+
+def _read(path):
+    try:
+        with open(path) as f:
+            return f.read()
+    except OSError:
+        return ""
+
+
+def _cmd(args):
+    """Output of a command, or "" when it is missing or fails"""
+    if not shutil.which(args[0]):
+        return ""
+    try:
+        return subprocess.run(args, capture_output=True, text=True,
+                              timeout=30).stdout.strip()
+    except (OSError, subprocess.SubprocessError):
+        return ""
+
+
+def _cpu_model():
+    for line in _read("/proc/cpuinfo").splitlines():
+        if line.startswith("model name"):
+            return line.split(":", 1)[1].strip()
+    return platform.processor()
+
+
+def _numa_nodes():
+    nodes = []
+    for path in sorted(glob.glob("/sys/devices/system/node/node[0-9]*")):
+        nodes.append({
+            "node": int(os.path.basename(path)[4:]),
+            "cpus": _read(os.path.join(path, "cpulist")).strip(),
+        })
+    return nodes
+
+
+def _mem_total_kb():
+    for line in _read("/proc/meminfo").splitlines():
+        if line.startswith("MemTotal:"):
+            return int(line.split()[1])
+    return 0
+
+
+def _gpus():
+    out = _cmd(["nvidia-smi", "--query-gpu=name,memory.total,driver_version",
+                "--format=csv,noheader"])
+    gpus = [line.strip() for line in out.splitlines() if line.strip()]
+    if not gpus:
+        out = _cmd(["rocm-smi", "--showproductname"])
+        gpus = [line.split(":", 1)[1].strip() for line in out.splitlines()
+                if "Card series" in line]
+    return gpus
+
+
+def _config_hash(env=None):
+    """sha256 over the runtime config files named by the environment"""
+    env = os.environ if env is None else env
+    digest = hashlib.sha256()
+    files = {}
+    for var in CONFIG_ENV_VARS:
+        path = env.get(var)
+        if path and os.path.exists(path):
+            data = _read(path)
+            digest.update(data.encode())
+            files[var] = path
+    return (digest.hexdigest() if files else ""), files
+
+
+def fingerprint():
+    """Describe the machine and build a result was produced on"""
+    config_hash, config_files = _config_hash()
+    return {
+        "hostname": socket.gethostname(),
+        "kernel": platform.release(),
+        "cpu_model": _cpu_model(),
+        "cpu_count": os.cpu_count(),
+        "numa_nodes": _numa_nodes(),
+        "mem_total_kb": _mem_total_kb(),
+        "gpus": _gpus(),
+        "git_commit": _cmd(["git", "-C", ROOT, "rev-parse", "HEAD"]),
+        "git_dirty": bool(_cmd(["git", "-C", ROOT, "status", "--porcelain",
+                                "--untracked-files=no"])),
+        "config_hash": config_hash,
+        "config_files": config_files,
+    }
+
+
+# Fingerprint fields that must match for a comparison to be meaningful
+COMPARABLE_FIELDS = ["cpu_model", "cpu_count", "numa_nodes", "gpus",
+                     "config_hash"]
+
+
+# ---------------------------------------------------------------------------
+# Running a suite
+# ---------------------------------------------------------------------------
+
+def _parse_number(text):
+    return float(text.replace(",", ""))
+
+
+def _aggregate(values, how):
+    if how == "sum":
+        return sum(values)
+    if how == "min":
+        return min(values)
+    if how == "max":
+        return max(values)
+    if how == "last":
+        return values[-1]
+    return statistics.fmean(values)
+
+
+def load_suite(path):
+    with open(path) as f:
+        suite = yaml.safe_load(f)
+    if not isinstance(suite, dict) or "benchmarks" not in suite:
+        raise ValueError(f"{path}: missing 'benchmarks' list")
+    for bench in suite["benchmarks"]:
+        for key in ("name", "cmd", "metrics"):
+            if key not in bench:
+                raise ValueError(f"{path}: benchmark missing '{key}'")
+        for name, metric in bench["metrics"].items():
+            if metric.get("better") not in ("higher", "lower"):
+                raise ValueError(
+                    f"{path}: {bench['name']}.{name}: 'better' must be "
+                    "higher or lower")
+            re.compile(metric["regex"], re.MULTILINE)
+    return suite
+
+
+def select(benchmarks, tags, only):
+    """Benchmarks matching any requested tag and (if given) a name"""
+    picked = []
+    for bench in benchmarks:
+        bench_tags = set(bench.get("tags", []))
+        if tags and not bench_tags & set(tags):
+            continue
+        if only and bench["name"] not in only:
+            continue
+        picked.append(bench)
+    return picked
+
+
+def run_once(bench, bin_dir, timeout):
+    """Run one repetition; returns (metrics dict, error string or None)"""
+    subst = {"BIN": bin_dir, "ROOT": ROOT}
+    cmd = [str(arg).format(**subst) for arg in bench["cmd"]]
+    if bin_dir and not os.path.isabs(cmd[0]) and "/" not in cmd[0]:
+        candidate = os.path.join(bin_dir, cmd[0])
+        if os.path.exists(candidate):
+            cmd[0] = candidate
+    env = dict(os.environ)
+    env.update({k: str(v).format(**subst)
+                for k, v in bench.get("env", {}).items()})
+    try:
+        proc = subprocess.run(cmd, env=env, capture_output=True, text=True,
+                              timeout=bench.get("timeout", timeout))
+    except FileNotFoundError:
+        return {}, f"executable not found: {cmd[0]}"
+    except subprocess.TimeoutExpired:
+        return {}, "timed out"
+    output = proc.stdout + proc.stderr
+    if proc.returncode != 0:
+        tail = "\n".join(output.splitlines()[-5:])
+        return {}, f"exit code {proc.returncode}: {tail}"
+    metrics = {}
+    for name, metric in bench["metrics"].items():
+        matches = re.findall(metric["regex"], output, re.MULTILINE)
+        if not matches:
+            return {}, f"metric '{name}' not found in output"
+        values = [_parse_number(m if isinstance(m, str) else m[0])
+                  for m in matches]
+        metrics[name] = _aggregate(values, metric.get("aggregate", "mean"))
+    return metrics, None
+
+
+def cmd_run(args):
+    suite = load_suite(args.suite)
+    benchmarks = select(suite["benchmarks"], args.tags, args.only)
+    if not benchmarks:
+        print("No benchmarks selected", file=sys.stderr)
+        return 2
+    default_repeat = args.repeat or suite.get("repeat", 3)
+    result = {
+        "schema": SCHEMA_VERSION,
+        "suite": os.path.basename(args.suite),
+        "suite_hash": hashlib.sha256(_read(args.suite).encode()).hexdigest(),
+        "label": args.label,
+        "timestamp": datetime.datetime.now(datetime.timezone.utc).isoformat(),
+        "fingerprint": fingerprint(),
+        "benchmarks": {},
+    }
+    failed = 0
+    for bench in benchmarks:
+        repeat = args.repeat or bench.get("repeat", default_repeat)
+        print(f"[{bench['name']}] {repeat} run(s)", flush=True)
+        bench_env = dict(os.environ)
+        bench_env.update({k: str(v).format(BIN=args.bin_dir, ROOT=ROOT)
+                          for k, v in bench.get("env", {}).items()})
+        entry = {
+            "cmd": " ".join(shlex.quote(str(a)) for a in bench["cmd"]),
+            "config_hash": _config_hash(bench_env)[0],
+            "metrics": {},
+            "errors": [],
+        }
+        for name, metric in bench["metrics"].items():
+            entry["metrics"][name] = {
+                "better": metric["better"],
+                "unit": metric.get("unit", ""),
+                "samples": [],
+            }
+        for i in range(repeat):
+            values, error = run_once(bench, args.bin_dir,
+                                     suite.get("timeout", 600))
+            if error:
+                print(f"  run {i + 1}: FAIL: {error}", flush=True)
+                entry["errors"].append(error)
+                if args.fail_fast:
+                    break
+                continue
+            for name, value in values.items():
+                entry["metrics"][name]["samples"].append(value)
+            shown = ", ".join(f"{k}={v:g}" for k, v in values.items())
+            print(f"  run {i + 1}: {shown}", flush=True)
+        for metric in entry["metrics"].values():
+            samples = metric["samples"]
+            metric["mean"] = statistics.fmean(samples) if samples else None
+            metric["stdev"] = (statistics.stdev(samples)
+                               if len(samples) > 1 else 0.0)
+        if entry["errors"]:
+            failed += 1
+        result["benchmarks"][bench["name"]] = entry
+    with open(args.output, "w") as f:
+        json.dump(result, f, indent=2)
+    print(f"Wrote {args.output}")
+    return 1 if failed else 0
+
+
+# ---------------------------------------------------------------------------
+# Statistics
+# ---------------------------------------------------------------------------
+
+def _betacf(a, b, x):
+    """Continued fraction for the incomplete beta function"""
+    tiny = 1e-30
+    qab, qap, qam = a + b, a + 1.0, a - 1.0
+    c, d = 1.0, 1.0 - qab * x / qap
+    d = 1.0 / (d if abs(d) > tiny else tiny)
+    h = d
+    for m in range(1, 200):
+        m2 = 2 * m
+        aa = m * (b - m) * x / ((qam + m2) * (a + m2))
+        d = 1.0 + aa * d
+        d = 1.0 / (d if abs(d) > tiny else tiny)
+        c = 1.0 + aa / c
+        c = c if abs(c) > tiny else tiny
+        h *= d * c
+        aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2))
+        d = 1.0 + aa * d
+        d = 1.0 / (d if abs(d) > tiny else tiny)
+        c = 1.0 + aa / c
+        c = c if abs(c) > tiny else tiny
+        delta = d * c
+        h *= delta
+        if abs(delta - 1.0) < 1e-12:
+            break
+    return h
+
+
+def _betai(a, b, x):
+    """Regularized incomplete beta function I_x(a, b)"""
+    if x <= 0.0:
+        return 0.0
+    if x >= 1.0:
+        return 1.0
+    lbeta = (math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b) +
+             a * math.log(x) + b * math.log(1.0 - x))
+    if x < (a + 1.0) / (a + b + 2.0):
+        return math.exp(lbeta) * _betacf(a, b, x) / a
+    return 1.0 - math.exp(lbeta) * _betacf(b, a, 1.0 - x) / b
+
+
+def welch_p_value(xs, ys):
+    """Two-sided Welch t-test p-value; None if it cannot be computed"""
+    if len(xs) < 2 or len(ys) < 2:
+        return None
+    mx, my = statistics.fmean(xs), statistics.fmean(ys)
+    vx, vy = statistics.variance(xs), statistics.variance(ys)
+    sx, sy = vx / len(xs), vy / len(ys)
+    if sx + sy == 0:
+        return 0.0 if mx != my else 1.0
+    t = (mx - my) / math.sqrt(sx + sy)
+    dof = (sx + sy) ** 2 / (sx ** 2 / (len(xs) - 1) +
+                            sy ** 2 / (len(ys) - 1))
+    return _betai(dof / 2.0, 0.5, dof / (dof + t * t))
+
+
+# ---------------------------------------------------------------------------
+# Comparison
+# ---------------------------------------------------------------------------
+
+def compare(baseline, current, threshold, alpha, overrides):
+    """List of per-metric comparison rows"""
+    rows = []
+    for bench_name, cur in current["benchmarks"].items():
+        base = baseline["benchmarks"].get(bench_name)
+        for metric_name, cur_m in cur["metrics"].items():
+            row = {"benchmark": bench_name, "metric": metric_name,
+                   "unit": cur_m.get("unit", ""), "base": None,
+                   "current": cur_m["mean"], "change": None, "p": None}
+            base_m = base["metrics"].get(metric_name) if base else None
+            if not base_m or base_m.get("mean") is None:
+                row["status"] = "new"
+                rows.append(row)
+                continue
+            row["base"] = base_m["mean"]
+            if cur_m["mean"] is None:
+                row["status"] = "missing"
+                rows.append(row)
+                continue
+            limit = overrides.get(f"{bench_name}.{metric_name}", threshold)
+            change = ((cur_m["mean"] - base_m["mean"]) / base_m["mean"]
+                      if base_m["mean"] else 0.0)
+            worse = -change if cur_m["better"] == "higher" else change
+            p = welch_p_value(base_m["samples"], cur_m["samples"])
+            significant = p is None or p < alpha
+            row["change"], row["p"] = change, p
+            if worse > limit and significant:
+                row["status"] = "REGRESSION"
+            elif -worse > limit and significant:
+                row["status"] = "improved"
+            else:
+                row["status"] = "ok"
+            rows.append(row)
+    return rows
+
+
+def fingerprint_diffs(baseline, current):
+    base_fp, cur_fp = baseline["fingerprint"], current["fingerprint"]
+    diffs = [field for field in COMPARABLE_FIELDS
+             if base_fp.get(field) != cur_fp.get(field)]
+    for name, cur in current["benchmarks"].items():
+        base = baseline["benchmarks"].get(name)
+        if base and base.get("config_hash") != cur.get("config_hash"):
+            diffs.append(f"{name}.config_hash")
+    return diffs
+
+
+def format_report(rows, diffs, baseline, current):
+    lines = ["# Performance comparison", ""]
+    lines.append(f"- baseline: {baseline.get('label') or ''} "
+                 f"{baseline['fingerprint'].get('git_commit', '')[:12]} "
+                 f"({baseline.get('timestamp', '')})")
+    lines.append(f"- current: {current.get('label') or ''} "
+                 f"{current['fingerprint'].get('git_commit', '')[:12]} "
+                 f"({current.get('timestamp', '')})")
+    if diffs:
+        lines.append(f"- WARNING: environment differs in: {', '.join(diffs)}")
+    lines += ["", "| benchmark | metric | baseline | current | change | p | "
+              "status |", "|---|---|---|---|---|---|---|"]
+
+    def fmt(value, spec):
+        return "-" if value is None else format(value, spec)
+
+    for row in rows:
+        unit = f" {row['unit']}" if row["unit"] else ""
+        change = ("-" if row["change"] is None
+                  else f"{row['change'] * 100:+.1f}%")
+        lines.append(
+            f"| {row['benchmark']} | {row['metric']}{unit} | "
+            f"{fmt(row['base'], '.4g')} | {fmt(row['current'], '.4g')} | "
+            f"{change} | {fmt(row['p'], '.3f')} | {row['status']} |")
+    return "\n".join(lines) + "\n"
+
+
+def cmd_compare(args):
+    try:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        with open(args.current) as f:
+            current = json.load(f)
+    except (OSError, json.JSONDecodeError) as e:
+        print(f"Cannot load results: {e}", file=sys.stderr)
+        return 2
+    overrides = {}
+    if args.suite:
+        for bench in load_suite(args.suite)["benchmarks"]:
+            for name, metric in bench["metrics"].items():
+                if "threshold" in metric:
+                    overrides[f"{bench['name']}.{name}"] = metric["threshold"]
+    rows = compare(baseline, current, args.threshold, args.alpha, overrides)
+    diffs = fingerprint_diffs(baseline, current)
+    report = format_report(rows, diffs, baseline, current)
+    print(report)
+    if args.report:
+        with open(args.report, "w") as f:
+            f.write(report)
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump({"environment_diffs": diffs, "rows": rows}, f, indent=2)
+    if diffs and args.strict_env:
+        print("Environment fingerprints differ", file=sys.stderr)
+        return 2
+    failed = [b for b, e in current["benchmarks"].items() if e["errors"]]
+    regressions = [r for r in rows if r["status"] in ("REGRESSION", "missing")]
+    for bench in failed:
+        print(f"FAILED: {bench}", file=sys.stderr)
+    for row in regressions:
+        print(f"{row['status']}: {row['benchmark']}.{row['metric']}",
+              file=sys.stderr)
+    return 1 if regressions or failed else 0
+
+
+def cmd_fingerprint(_args):
+    print(json.dumps(fingerprint(), indent=2))
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="IOWarp performance regression harness")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    run = sub.add_parser("run", help="run a suite and write results JSON")
+    run.add_argument("--suite", default=DEFAULT_SUITE)
+    run.add_argument("--bin-dir", default="",
+                     help="directory holding the benchmark executables "
+                          "(default: look them up in PATH)")
+    run.add_argument("--tags", nargs="*", default=[],
+                     help="run benchmarks having any of these tags")
+    run.add_argument("--only", nargs="*", default=[],
+                     help="run only these benchmark names")
+    run.add_argument("--repeat", type=int, default=0,
+                     help="override the repetition count")
+    run.add_argument("--label", default="",
+                     help="free-form label stored with the results")
+    run.add_argument("--fail-fast", action="store_true",
+                     help="stop repeating a benchmark after a failure")
+    run.add_argument("-o", "--output", default="perf_results.json")
+    run.set_defaults(func=cmd_run)
+
+    cmp = sub.add_parser("compare", help="compare results to a baseline")
+    cmp.add_argument("baseline")
+    cmp.add_argument("current")
+    cmp.add_argument("--threshold", type=float, default=0.05,
+                     help="relative change counted as a regression "
+                          "(default: 0.05)")
+    cmp.add_argument("--alpha", type=float, default=0.05,
+                     help="significance level of the t-test (default: 0.05)")
+    cmp.add_argument("--suite", default="",
+                     help="suite file with per-metric 'threshold' overrides")
+    cmp.add_argument("--report", default="", help="write a Markdown report")
+    cmp.add_argument("--json", default="", help="write the rows as JSON")
+    cmp.add_argument("--strict-env", action="store_true",
+                     help="fail if the environment fingerprints differ")
+    cmp.set_defaults(func=cmd_compare)
+
+    fp = sub.add_parser("fingerprint", help="print the environment fingerprint")
+    fp.set_defaults(func=cmd_fingerprint)
+
+    args = parser.parse_args()
+    try:
+        return args.func(args)
+    except (OSError, ValueError, yaml.YAMLError) as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 2
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,550 @@
+#!/usr/bin/env python3
+"""
+Configuration autotuner for the IOWarp runtime and CTE.
+
+Searches the parameter space in a space file (default: tune_space.yaml)
+and writes the runtime YAML that scored best on this node. Every candidate
+is the space's base config plus one value per parameter, passed to the
+benchmarks through CHI_SERVER_CONF (and WRP_CAE_CONF for adapter params).
+The benchmarks come from the perf suite (CI/perf/suite.yaml), or from
+recorded workload traces replayed with wrp_cte_replay (--trace).
+
+The search is successive halving. Rung 0 runs every candidate with
+--min-repeat repetitions; each later rung keeps the best 1/eta of them and
+runs eta times as many repetitions, adding to the samples it already has.
+The base config is candidate 0 and runs at every rung, because scores are
+relative to it: the weighted sum of log(candidate / base) over the
+objective metrics, negated for metrics where lower is better.
+
+Runs are reproducible and resumable. Candidates are drawn from --seed and
+stored, with every finished evaluation, in a state file that is rewritten
+after each one. Running again with the same state file skips what is
+already done; --fresh starts over.
+
+Commands:
+  run   Search and write the best config
+  show  Print the candidates and scores recorded in a state file
+
+Examples:
+  CI/perf/wrp_tune.py run --bin-dir build/bin -o tuned.yaml
+  CI/perf/wrp_tune.py run --bin-dir build/bin --trace /tmp/app.*.wlt \\
+      -o tuned.yaml
+  CI/perf/wrp_tune.py show tune_state.json
+
+Exit 0 = success, 1 = no candidate could be evaluated, 2 = usage or
+input error.
+"""
+
+import argparse
+import copy
+import datetime
+import hashlib
+import itertools
+import json
+import math
+import os
+import random
+import re
+import socket
+import sys
+
+import yaml
+
+import wrp_perf
+
+HERE = wrp_perf.HERE
+ROOT = wrp_perf.ROOT
+DEFAULT_SPACE = os.path.join(HERE, "tune_space.yaml")
+STATE_VERSION = 1
+
+# Environment variable each config file is handed to the benchmarks through
+FILE_ENV = {"runtime": "CHI_SERVER_CONF", "adapter": "WRP_CAE_CONF"}
+
+# Objective used when tuning against a recorded trace
+REPLAY_BENCH = "replay"
+REPLAY_METRIC = "ops_per_sec"
+
+_NCPU_RE = re.compile(r"^ncpu(?:\s*([*/])\s*(\d+))?$")
+_SELECTOR_RE = re.compile(r"^([^\[\]]+)\[([^=\]]+)=([^\]]*)\]$")
+
+
+# ---------------------------------------------------------------------------
+# Search space
+# ---------------------------------------------------------------------------
+
+def _resolve_value(value, ncpu):
+    """Replace an ncpu expression by a CPU count; keep other values"""
+    if not isinstance(value, str):
+        return value
+    match = _NCPU_RE.match(value.strip())
+    if not match:
+        return value
+    count = ncpu
+    if match.group(1) == "*":
+        count = ncpu * int(match.group(2))
+    elif match.group(1) == "/":
+        count = ncpu // int(match.group(2))
+    return max(1, count)
+
+
+def _path_tokens(path):
+    tokens = []
+    for part in path.split("."):
+        match = _SELECTOR_RE.match(part)
+        if match:
+            tokens.append((match.group(1), match.group(2), match.group(3)))
+        else:
+            tokens.append((part, None, None))
+    return tokens
+
+
+def set_path(doc, path, value):
+    """Set a dotted path in a YAML document; False if a selector misses"""
+    node = doc
+    tokens = _path_tokens(path)
+    for i, (key, sel_key, sel_value) in enumerate(tokens):
+        last = i == len(tokens) - 1
+        if sel_key is None:
+            if last:
+                node[key] = value
+                return True
+            if not isinstance(node.get(key), dict):
+                node[key] = {}
+            node = node[key]
+            continue
+        items = node.get(key)
+        if not isinstance(items, list):
+            return False
+        picked = [item for item in items if isinstance(item, dict) and
+                  str(item.get(sel_key)) == sel_value]
+        if not picked or last:
+            return False
+        node = picked[0]
+    return True
+
+
+def _load_yaml(path):
+    with open(path) as f:
+        doc = yaml.safe_load(f)
+    return doc if isinstance(doc, dict) else {}
+
+
+def load_space(path, base_config, base_adapter_config):
+    """Parse a space file and check every param against its base config"""
+    with open(path) as f:
+        space = yaml.safe_load(f)
+    if not isinstance(space, dict) or not space.get("params"):
+        raise ValueError(f"{path}: missing 'params' list")
+    subst = {"ROOT": ROOT}
+    base_path = (base_config or space.get("base_config", "")).format(**subst)
+    if not base_path:
+        raise ValueError(f"{path}: no base_config")
+    adapter_path = (base_adapter_config or
+                    space.get("base_adapter_config", "")).format(**subst)
+    bases = {"runtime": _load_yaml(base_path),
+             "adapter": _load_yaml(adapter_path) if adapter_path else {}}
+    params = []
+    names = set()
+    for param in space["params"]:
+        for key in ("name", "path", "values"):
+            if key not in param:
+                raise ValueError(f"{path}: param missing '{key}'")
+        name = param["name"]
+        if name in names:
+            raise ValueError(f"{path}: duplicate param '{name}'")
+        names.add(name)
+        file_kind = param.get("file", "runtime")
+        if file_kind not in FILE_ENV:
+            raise ValueError(f"{path}: {name}: file must be runtime or "
+                             "adapter")
+        if not param["values"]:
+            raise ValueError(f"{path}: {name}: empty 'values'")
+        if not set_path(copy.deepcopy(bases[file_kind]), param["path"], 0):
+            if param.get("optional"):
+                print(f"Skipping {name}: {param['path']} is not in the "
+                      "base config", flush=True)
+                continue
+            raise ValueError(f"{path}: {name}: {param['path']} is not in "
+                             "the base config")
+        params.append({"name": name, "file": file_kind,
+                       "path": param["path"], "values": param["values"]})
+    objective = space.get("objective", [])
+    for goal in objective:
+        for key in ("benchmark", "metric"):
+            if key not in goal:
+                raise ValueError(f"{path}: objective entry missing '{key}'")
+    return {"base_config": base_path, "base_adapter_config": adapter_path,
+            "bases": bases, "params": params, "objective": objective}
+
+
+def draw_candidates(params, count, seed, ncpu):
+    """Base config first, then up to count-1 distinct seeded draws"""
+    choices = []
+    for param in params:
+        values = []
+        for value in param["values"]:
+            value = _resolve_value(value, ncpu)
+            if value not in values:
+                values.append(value)
+        choices.append(values)
+    grid_size = math.prod(len(values) for values in choices)
+    rng = random.Random(seed)
+    if grid_size <= count - 1:
+        combos = list(itertools.product(*choices))
+    else:
+        seen = set()
+        combos = []
+        while len(combos) < count - 1:
+            combo = tuple(rng.choice(values) for values in choices)
+            if combo not in seen:
+                seen.add(combo)
+                combos.append(combo)
+    candidates = [{"id": 0, "params": {}}]
+    for combo in combos:
+        candidates.append({
+            "id": len(candidates),
+            "params": {p["name"]: v for p, v in zip(params, combo)},
+        })
+    return candidates
+
+
+def render(space, candidate):
+    """Runtime and adapter documents of a candidate"""
+    docs = {kind: copy.deepcopy(doc) for kind, doc in space["bases"].items()}
+    for param in space["params"]:
+        if param["name"] in candidate["params"]:
+            set_path(docs[param["file"]], param["path"],
+                     candidate["params"][param["name"]])
+    return docs
+
+
+# ---------------------------------------------------------------------------
+# State file
+# ---------------------------------------------------------------------------
+
+def _digest(obj):
+    return hashlib.sha256(json.dumps(obj, sort_keys=True,
+                                     default=str).encode()).hexdigest()
+
+
+def save_state(path, state):
+    """Write the state through a temp file so a crash never truncates it"""
+    tmp = f"{path}.tmp"
+    with open(tmp, "w") as f:
+        json.dump(state, f, indent=2)
+    os.replace(tmp, path)
+
+
+def load_state(path, search_hash):
+    with open(path) as f:
+        state = json.load(f)
+    if state.get("schema") != STATE_VERSION:
+        raise ValueError(f"{path}: unsupported state version")
+    if state.get("search_hash") != search_hash:
+        raise ValueError(f"{path}: recorded for a different space, suite, "
+                         "objective or settings; rerun with --fresh")
+    return state
+
+
+# ---------------------------------------------------------------------------
+# Evaluation
+# ---------------------------------------------------------------------------
+
+def _samples(state, cid):
+    """All samples of a candidate, per "benchmark.metric", over all rungs"""
+    merged = {}
+    for key, entry in state["evals"].items():
+        if int(key.split(":")[0]) != cid:
+            continue
+        for name, values in entry["metrics"].items():
+            merged.setdefault(name, []).extend(values)
+    return merged
+
+
+def _failed(state, cid):
+    return any(entry["errors"] for key, entry in state["evals"].items()
+               if int(key.split(":")[0]) == cid)
+
+
+def score(state, cid, objective, better):
+    """Weighted log ratio against the base config; None if unusable"""
+    if _failed(state, cid) or _failed(state, 0):
+        return None
+    cand, base = _samples(state, cid), _samples(state, 0)
+    total = 0.0
+    for goal in objective:
+        name = f"{goal['benchmark']}.{goal['metric']}"
+        if not cand.get(name) or not base.get(name):
+            return None
+        cand_mean = sum(cand[name]) / len(cand[name])
+        base_mean = sum(base[name]) / len(base[name])
+        if cand_mean <= 0 or base_mean <= 0:
+            return None
+        ratio = math.log(cand_mean / base_mean)
+        if better[name] == "lower":
+            ratio = -ratio
+        total += goal.get("weight", 1.0) * ratio
+    return total
+
+
+def evaluate(candidate, space, benches, objective, repeat, args, timeout):
+    """Run the objective benchmarks on one candidate"""
+    docs = render(space, candidate)
+    env = {}
+    for kind, doc in docs.items():
+        if kind == "adapter" and not any(p["file"] == "adapter"
+                                         for p in space["params"]):
+            continue
+        path = os.path.join(args.work_dir,
+                            f"candidate_{candidate['id']}.{kind}.yaml")
+        with open(path, "w") as f:
+            yaml.safe_dump(doc, f, sort_keys=False)
+        env[FILE_ENV[kind]] = path
+    entry = {"repeat": repeat, "metrics": {}, "errors": []}
+    for bench_name in sorted({goal["benchmark"] for goal in objective}):
+        bench = copy.deepcopy(benches[bench_name])
+        bench.setdefault("env", {}).update(env)
+        wanted = {goal["metric"] for goal in objective
+                  if goal["benchmark"] == bench_name}
+        bench["metrics"] = {k: v for k, v in bench["metrics"].items()
+                            if k in wanted}
+        for _ in range(repeat):
+            values, error = wrp_perf.run_once(bench, args.bin_dir, timeout)
+            if error:
+                entry["errors"].append(f"{bench_name}: {error}")
+                return entry
+            for name, value in values.items():
+                entry["metrics"].setdefault(f"{bench_name}.{name}",
+                                            []).append(value)
+    return entry
+
+
+def _describe(candidate):
+    if not candidate["params"]:
+        return "base config"
+    return ", ".join(f"{k}={v}" for k, v in candidate["params"].items())
+
+
+# ---------------------------------------------------------------------------
+# Commands
+# ---------------------------------------------------------------------------
+
+def _replay_bench(args):
+    cmd = ["wrp_cte_replay", "--speed", str(args.speed)]
+    return {
+        "name": REPLAY_BENCH,
+        "cmd": cmd + list(args.trace),
+        "env": {"CHI_WITH_RUNTIME": "1"},
+        "metrics": {
+            REPLAY_METRIC: {"regex": r'rate:\s+([\d.]+) ops/s',
+                            "better": "higher"},
+        },
+    }
+
+
+def cmd_run(args):
+    space = load_space(args.space, args.base_config, args.base_adapter_config)
+    if args.trace:
+        benches = {REPLAY_BENCH: _replay_bench(args)}
+        objective = [{"benchmark": REPLAY_BENCH, "metric": REPLAY_METRIC,
+                      "weight": 1.0}]
+        timeout = 3600
+    else:
+        suite = wrp_perf.load_suite(args.suite)
+        benches = {b["name"]: b for b in suite["benchmarks"]}
+        objective = space["objective"]
+        timeout = suite.get("timeout", 600)
+    if not objective:
+        print("The space has no objective", file=sys.stderr)
+        return 2
+    better = {}
+    for goal in objective:
+        bench = benches.get(goal["benchmark"])
+        if not bench or goal["metric"] not in bench["metrics"]:
+            print(f"Unknown objective {goal['benchmark']}.{goal['metric']}",
+                  file=sys.stderr)
+            return 2
+        better[f"{goal['benchmark']}.{goal['metric']}"] = (
+            bench["metrics"][goal["metric"]]["better"])
+    if args.candidates < 2 or args.eta < 2 or args.min_repeat < 1:
+        print("Need --candidates >= 2, --eta >= 2 and --min-repeat >= 1",
+              file=sys.stderr)
+        return 2
+
+    args.work_dir = os.path.abspath(args.work_dir)
+    os.makedirs(args.work_dir, exist_ok=True)
+    state_path = args.state or os.path.join(args.work_dir, "tune_state.json")
+    search_hash = _digest({
+        "params": space["params"], "bases": space["bases"],
+        "objective": objective,
+        "benches": {name: benches[name]
+                    for name in sorted({g["benchmark"] for g in objective})},
+        "seed": args.seed, "candidates": args.candidates, "eta": args.eta,
+        "min_repeat": args.min_repeat,
+    })
+    if os.path.exists(state_path) and not args.fresh:
+        state = load_state(state_path, search_hash)
+        print(f"Resuming {state_path}: {len(state['evals'])} evaluation(s) "
+              "done", flush=True)
+    else:
+        fp = wrp_perf.fingerprint()
+        state = {
+            "schema": STATE_VERSION,
+            "search_hash": search_hash,
+            "seed": args.seed,
+            "timestamp": datetime.datetime.now(
+                datetime.timezone.utc).isoformat(),
+            "fingerprint": fp,
+            "base_config": space["base_config"],
+            "objective": objective,
+            "candidates": draw_candidates(space["params"], args.candidates,
+                                          args.seed, fp["cpu_count"] or 1),
+            "evals": {},
+            "rungs": [],
+        }
+        save_state(state_path, state)
+    candidates = state["candidates"]
+
+    if args.dry_run:
+        for cand in candidates:
+            print(f"  #{cand['id']}: {_describe(cand)}")
+        return 0
+
+    alive = [cand["id"] for cand in candidates]
+    rung = 0
+    while True:
+        repeat = args.min_repeat * args.eta ** rung
+        print(f"[rung {rung}] {len(alive)} candidate(s), {repeat} run(s) "
+              "each", flush=True)
+        for cid in alive:
+            key = f"{cid}:{rung}"
+            if key in state["evals"]:
+                continue
+            entry = evaluate(candidates[cid], space, benches, objective,
+                             repeat, args, timeout)
+            state["evals"][key] = entry
+            save_state(state_path, state)
+            status = ("FAIL: " + entry["errors"][0] if entry["errors"]
+                      else "ok")
+            print(f"  #{cid} {_describe(candidates[cid])}: {status}",
+                  flush=True)
+        scores = {cid: score(state, cid, objective, better) for cid in alive}
+        ranked = sorted((cid for cid in alive if cid != 0),
+                        key=lambda c: (scores[c] is None,
+                                       -(scores[c] or 0.0), c))
+        if len(state["rungs"]) <= rung:
+            state["rungs"].append({"alive": alive, "scores": scores})
+            save_state(state_path, state)
+        if len(ranked) <= 1:
+            break
+        keep = max(1, math.ceil(len(ranked) / args.eta))
+        alive = [0] + [cid for cid in ranked[:keep] if scores[cid] is not None]
+        if len(alive) == 1:
+            break
+        rung += 1
+
+    usable = {cid: s for cid, s in scores.items() if s is not None}
+    if 0 not in usable and _failed(state, 0):
+        print("The base config failed; nothing to compare against",
+              file=sys.stderr)
+        return 1
+    best = max(usable, key=lambda c: (usable[c], -c)) if usable else 0
+    if usable.get(best, 0.0) <= 0.0:
+        best = 0
+    gain = math.exp(usable.get(best, 0.0)) - 1.0
+    print(f"Best: #{best} {_describe(candidates[best])} "
+          f"({gain * 100:+.1f}% vs base)")
+    write_best(args.output, space, candidates[best], state, gain)
+    return 0
+
+
+def write_best(output, space, candidate, state, gain):
+    """Write the winning runtime config, and its adapter config if tuned"""
+    docs = render(space, candidate)
+    fp = state["fingerprint"]
+    header = [
+        f"# Tuned by CI/perf/wrp_tune.py on {socket.gethostname()} "
+        f"({fp.get('cpu_model', '')}, {fp.get('cpu_count', '')} CPUs)",
+        f"# Base: {space['base_config']}",
+        f"# Params: {_describe(candidate)}",
+        f"# Objective gain vs base: {gain * 100:+.1f}%",
+    ]
+    outputs = {"runtime": output}
+    if any(p["file"] == "adapter" for p in space["params"]):
+        outputs["adapter"] = os.path.splitext(output)[0] + ".adapter.yaml"
+    for kind, path in outputs.items():
+        with open(path, "w") as f:
+            f.write("\n".join(header) + "\n")
+            yaml.safe_dump(docs[kind], f, sort_keys=False)
+        print(f"Wrote {path}")
+
+
+def cmd_show(args):
+    with open(args.state) as f:
+        state = json.load(f)
+    print(f"seed {state['seed']}, {len(state['candidates'])} candidates, "
+          f"{len(state['evals'])} evaluation(s)")
+    for i, rung in enumerate(state["rungs"]):
+        print(f"[rung {i}]")
+        for cid in rung["alive"]:
+            value = rung["scores"].get(str(cid), rung["scores"].get(cid))
+            shown = ("-" if value is None
+                     else f"{(math.exp(value) - 1.0) * 100:+.1f}%")
+            print(f"  #{cid} {shown:>8}  "
+                  f"{_describe(state['candidates'][cid])}")
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="IOWarp runtime and CTE configuration autotuner")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    run = sub.add_parser("run", help="search and write the best config")
+    run.add_argument("--space", default=DEFAULT_SPACE)
+    run.add_argument("--suite", default=wrp_perf.DEFAULT_SUITE)
+    run.add_argument("--base-config", default="",
+                     help="runtime YAML to start from (default: the space's)")
+    run.add_argument("--base-adapter-config", default="",
+                     help="adapter YAML to start from (default: the space's)")
+    run.add_argument("--bin-dir", default="",
+                     help="directory holding the benchmark executables "
+                          "(default: look them up in PATH)")
+    run.add_argument("--trace", nargs="*", default=[],
+                     help="tune against these workload traces with "
+                          "wrp_cte_replay instead of the suite")
+    run.add_argument("--speed", type=float, default=0.0,
+                     help="wrp_cte_replay --speed (default: 0, as fast as "
+                          "possible)")
+    run.add_argument("--candidates", type=int, default=16,
+                     help="configs in rung 0, base included (default: 16)")
+    run.add_argument("--eta", type=int, default=2,
+                     help="keep 1/eta per rung (default: 2)")
+    run.add_argument("--min-repeat", type=int, default=1,
+                     help="repetitions in rung 0 (default: 1)")
+    run.add_argument("--seed", type=int, default=0)
+    run.add_argument("--work-dir", default="wrp_tune",
+                     help="candidate configs and state (default: wrp_tune)")
+    run.add_argument("--state", default="",
+                     help="state file (default: <work-dir>/tune_state.json)")
+    run.add_argument("--fresh", action="store_true",
+                     help="discard the state file and start over")
+    run.add_argument("--dry-run", action="store_true",
+                     help="print the candidates without running anything")
+    run.add_argument("-o", "--output", default="tuned.yaml")
+    run.set_defaults(func=cmd_run)
+
+    show = sub.add_parser("show", help="print a state file")
+    show.add_argument("state")
+    show.set_defaults(func=cmd_show)
+
+    args = parser.parse_args()
+    try:
+        return args.func(args)
+    except (OSError, ValueError, KeyError, yaml.YAMLError) as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 2
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -2,6 +2,7 @@
 #define WRP_CAE_CORE_AUTOGEN_METHODS_H_
 
 #include <chimaera/chimaera.h>
+#include <chimaera/method_traits.h>
 #include <string>
 #include <vector>
 
@@ -37,6 +38,28 @@ inline const std::vector<std::string>& GetMethodNames() {
   }();
   return names;
 }
+
+/** Per-method traits indexed by method ID (see chimaera_mod.yaml) */
+inline constexpr chi::MethodTraits kMethodTraits[13] = {
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 0: Create
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 1: Destroy
+    {},  // 2
+    {},  // 3
+    {},  // 4
+    {},  // 5
+    {},  // 6
+    {},  // 7
+    {},  // 8
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 9: Monitor
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 10: ParseOmni
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 11: ProcessHdf5Dataset
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 12: ExportData
+};
+
+/** @return Traits of a method, or chi::kNoMethodTraits if unknown */
+constexpr const chi::MethodTraits& GetMethodTraits(chi::u32 method) {
+  return method < 13 ? kMethodTraits[method] : chi::kNoMethodTraits;
+}
 }  // namespace Method
 
 }  // namespace wrp_cae::core
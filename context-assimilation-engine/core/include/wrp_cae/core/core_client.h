@@ -88,15 +88,18 @@ class Client : public chi::ContainerClient {
    * Asynchronous ParseOmni - Parse OMNI YAML file and schedule assimilation tasks
    * Accepts vector of AssimilationCtx and serializes it transparently in the task constructor
    * After Wait(), access results via task->num_tasks_scheduled_ and task->result_code_
+   * @param contexts Assimilation contexts to process
+   * @param pool_query Pool query for routing (default: Local)
    */
   chi::Future<ParseOmniTask> AsyncParseOmni(
-      const std::vector<AssimilationCtx>& contexts) {
+      const std::vector<AssimilationCtx>& contexts,
+      const chi::PoolQuery& pool_query = chi::PoolQuery::Local()) {
     auto* ipc_manager = CHI_IPC;
 
     auto task = ipc_manager->NewTask<ParseOmniTask>(
         chi::CreateTaskId(),
         pool_id_,
-        chi::PoolQuery::Local(),
+        pool_query,
         contexts);
 
     return ipc_manager->Send(task);
@@ -133,7 +136,10 @@ class Client : public chi::ContainerClient {
       const chi::PoolQuery& pool_query,
       const std::string& file_path,
       const std::string& dataset_path,
-      const std::string& tag_prefix) {
+      const std::string& tag_prefix,
+      bool raw_chunks = false,
+      bool lazy = false,
+      bool lazy_cache = false) {
     auto* ipc_manager = CHI_IPC;
 
     HLOG(kInfo, "AsyncProcessHdf5Dataset: Creating task for pool_id={}, file={}, dataset={}",
@@ -145,7 +151,10 @@ class Client : public chi::ContainerClient {
         pool_query,
         file_path,
         dataset_path,
-        tag_prefix);
+        tag_prefix,
+        raw_chunks,
+        lazy,
+        lazy_cache);
 
     if (task.IsNull()) {
       HLOG(kError, "AsyncProcessHdf5Dataset: NewTask returned null!");
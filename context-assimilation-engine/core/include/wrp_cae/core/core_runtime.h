@@ -126,6 +126,16 @@ class Runtime : public chi::Container {
   chi::TaskResume ExportData(hipc::FullPtr<ExportDataTask> task, chi::RunContext& ctx);
 
  private:
+  /**
+   * Fan a multi-context bundle out as one ParseOmni subtask per context,
+   * spread across nodes with a bounded number in flight
+   * @param contexts Assimilation contexts from the bundle
+   * @param task Parent ParseOmni task receiving the aggregated result
+   * @return TaskResume for coroutine suspension/resumption
+   */
+  chi::TaskResume FanOutContexts(const std::vector<AssimilationCtx>& contexts,
+                                 hipc::FullPtr<ParseOmniTask> task);
+
   Client client_;
   std::shared_ptr<wrp_cte::core::Client> cte_client_;
 };
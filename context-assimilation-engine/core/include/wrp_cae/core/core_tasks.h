@@ -172,6 +172,9 @@ struct ProcessHdf5DatasetTask : public chi::Task {
   IN chi::priv::string file_path_;       // HDF5 file path
   IN chi::priv::string dataset_path_;    // Dataset path within HDF5 file
   IN chi::priv::string tag_prefix_;      // Tag prefix for CTE storage
+  IN bool raw_chunks_;                   // Store filtered chunks undecoded
+  IN bool lazy_;                         // Register blob stubs, copy nothing
+  IN bool lazy_cache_;                   // Cache stubs on their first read
   OUT chi::u32 result_code_;             // Result code (0 = success)
   OUT chi::priv::string error_message_;  // Error message if failed
 
@@ -181,6 +184,9 @@ struct ProcessHdf5DatasetTask : public chi::Task {
         file_path_(HSHM_MALLOC),
         dataset_path_(HSHM_MALLOC),
         tag_prefix_(HSHM_MALLOC),
+        raw_chunks_(false),
+        lazy_(false),
+        lazy_cache_(false),
         result_code_(0),
         error_message_(HSHM_MALLOC) {}
 
@@ -190,11 +196,17 @@ struct ProcessHdf5DatasetTask : public chi::Task {
                                   const chi::PoolQuery &pool_query,
                                   const std::string &file_path,
                                   const std::string &dataset_path,
-                                  const std::string &tag_prefix)
+                                  const std::string &tag_prefix,
+                                  bool raw_chunks = false,
+                                  bool lazy = false,
+                                  bool lazy_cache = false)
       : chi::Task(task_node, pool_id, pool_query, Method::kProcessHdf5Dataset),
         file_path_(HSHM_MALLOC, file_path),
         dataset_path_(HSHM_MALLOC, dataset_path),
         tag_prefix_(HSHM_MALLOC, tag_prefix),
+        raw_chunks_(raw_chunks),
+        lazy_(lazy),
+        lazy_cache_(lazy_cache),
         result_code_(0),
         error_message_(HSHM_MALLOC) {
     task_id_ = task_node;
@@ -209,7 +221,8 @@ struct ProcessHdf5DatasetTask : public chi::Task {
   template <typename Archive>
   HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
     Task::SerializeIn(ar);
-    ar(file_path_, dataset_path_, tag_prefix_);
+    ar(file_path_, dataset_path_, tag_prefix_, raw_chunks_, lazy_,
+       lazy_cache_);
   }
 
   /**
@@ -227,6 +240,9 @@ struct ProcessHdf5DatasetTask : public chi::Task {
     file_path_ = other->file_path_;
     dataset_path_ = other->dataset_path_;
     tag_prefix_ = other->tag_prefix_;
+    raw_chunks_ = other->raw_chunks_;
+    lazy_ = other->lazy_;
+    lazy_cache_ = other->lazy_cache_;
     result_code_ = other->result_code_;
     error_message_ = other->error_message_;
   }
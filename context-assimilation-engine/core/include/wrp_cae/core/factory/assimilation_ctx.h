@@ -58,9 +58,21 @@ struct AssimilationCtx {
   std::vector<std::string> include_patterns;  // Glob patterns for datasets to include
   std::vector<std::string> exclude_patterns;  // Glob patterns for datasets to exclude
 
+  // Store filtered HDF5 chunks as-is (raw_chunk_N) instead of decoding them
+  bool raw_chunks;
+
+  // Register HDF5 blobs as CTE stubs over the source file instead of copying
+  bool lazy;
+  bool lazy_cache;  // Cache a stub in a CTE target on its first read
+
+  // Transfer tuning (0 = assimilator default)
+  size_t chunk_size;  // Bytes per chunk blob
+  unsigned io_depth;  // Chunk reads and PutBlobs in flight
+
   // Default constructor
   AssimilationCtx()
-      : range_off(0), range_size(0) {}
+      : range_off(0), range_size(0), raw_chunks(false), lazy(false),
+        lazy_cache(false), chunk_size(0), io_depth(0) {}
 
   // Full constructor
   AssimilationCtx(const std::string& src_url,
@@ -78,13 +90,19 @@ struct AssimilationCtx {
         range_off(offset),
         range_size(size),
         src_token(source_token),
-        dst_token(dest_token) {}
+        dst_token(dest_token),
+        raw_chunks(false),
+        lazy(false),
+        lazy_cache(false),
+        chunk_size(0),
+        io_depth(0) {}
 
   // Serialization support
   template<class Archive>
   void serialize(Archive& ar) {
     ar(src, dst, format, depends_on, range_off, range_size, src_token, dst_token,
-       include_patterns, exclude_patterns);
+       include_patterns, exclude_patterns, raw_chunks, lazy, lazy_cache,
+       chunk_size, io_depth);
   }
 };
 
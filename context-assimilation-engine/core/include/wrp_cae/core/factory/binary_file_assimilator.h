@@ -67,6 +67,24 @@ class BinaryFileAssimilator : public BaseAssimilator {
   chi::TaskResume Schedule(const AssimilationCtx& ctx, int& error_code) override;
 
  private:
+  /**
+   * Read a byte range of a file with hshm::AsyncIO straight into IPC
+   * buffers and store each chunk as blob chunk_<i>. Up to io_depth chunks
+   * are in flight; each PutBlob is issued as soon as its read completes
+   * @param tag_id CTE tag receiving the chunks
+   * @param src_path File to read
+   * @param offset Byte offset of the range in the file
+   * @param total_size Number of bytes to transfer
+   * @param chunk_size Bytes per chunk blob
+   * @param io_depth Chunks (reads plus PutBlobs) in flight
+   * @param error_code Output: 0 on success, non-zero error code on failure
+   * @return TaskResume for coroutine suspension/resumption
+   */
+  chi::TaskResume TransferRange(const chi::UniqueId& tag_id,
+                                const std::string& src_path, size_t offset,
+                                size_t total_size, size_t chunk_size,
+                                chi::u32 io_depth, int& error_code);
+
   /**
    * Extract protocol from URL (part before ::)
    * @param url URL in format protocol::path
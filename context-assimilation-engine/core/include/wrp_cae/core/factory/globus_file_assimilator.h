@@ -51,7 +51,8 @@ namespace wrp_cae::core {
  *
  * Protocol format:
  * - Source: globus://<endpoint_id>/<path>
- * - Destination: globus://<endpoint_id>/<path> OR file::/local/path
+ * - Destination: globus://<endpoint_id>/<path>, file::/local/path, or
+ *   iowarp::<tag_name> (streamed into CTE as chunk_<i> blobs)
  */
 class GlobusFileAssimilator : public BaseAssimilator {
  public:
@@ -80,6 +81,10 @@ class GlobusFileAssimilator : public BaseAssimilator {
    * -13: HTTP download request failed (Globus-to-local)
    * -14: Failed to open local output file (Globus-to-local)
    * -15: Exception during download (Globus-to-local)
+   * -16: Remote file empty or range requests unsupported (Globus-to-CTE)
+   * -17: Range GET failed (Globus-to-CTE)
+   * -18: PutBlob failed (Globus-to-CTE)
+   * -19: Tag creation or buffer allocation failed (Globus-to-CTE)
    * -20: Globus support not compiled in
    */
   chi::TaskResume Schedule(const AssimilationCtx& ctx, int& error_code) override;
@@ -200,6 +205,59 @@ class GlobusFileAssimilator : public BaseAssimilator {
                    const std::string& local_path,
                    const std::string& transfer_token,
                    const std::string& https_token);
+
+  /**
+   * Pick the token for HTTPS data access: dst_token, then
+   * GLOBUS_HTTPS_ACCESS_TOKEN, then the transfer API token
+   * @param ctx Assimilation context
+   * @param access_token Transfer API token
+   * @return Token to send with HTTPS requests
+   */
+  std::string GetHttpsToken(const AssimilationCtx& ctx,
+                            const std::string& access_token);
+
+  /**
+   * Build the HTTPS URL of a file from its endpoint's HTTPS server
+   * @param endpoint_id Globus endpoint ID
+   * @param remote_path Path on the Globus endpoint
+   * @param transfer_token Transfer API token
+   * @param download_url Output: HTTPS URL of the file
+   * @return 0 on success, -11, -12 or -15 on failure (see DownloadFile)
+   */
+  int ResolveDownloadUrl(const std::string& endpoint_id,
+                         const std::string& remote_path,
+                         const std::string& transfer_token,
+                         std::string& download_url);
+
+  /**
+   * Get a remote file's size with a one-byte range GET
+   * @param url HTTPS URL of the file
+   * @param https_token Collection HTTPS token
+   * @return Size in bytes, or 0 if unknown or ranges are unsupported
+   */
+  size_t GetRemoteSize(const std::string& url, const std::string& https_token);
+
+  /**
+   * Stream a remote file into CTE with parallel range GETs. Each range is
+   * read straight into an IPC buffer and stored as blob chunk_<i> as soon
+   * as it arrives, so early ranges are usable while later ones download
+   * @param endpoint_id Globus endpoint ID
+   * @param remote_path Path on the Globus endpoint
+   * @param tag_name CTE tag receiving the chunks
+   * @param transfer_token Transfer API token
+   * @param https_token Collection HTTPS token
+   * @param range_size Bytes per range GET and chunk blob
+   * @param num_streams Range GETs in flight
+   * @param error_code Output: 0 on success, -11 to -19 on failure
+   * @return TaskResume for coroutine suspension/resumption
+   */
+  chi::TaskResume IngestToCte(const std::string& endpoint_id,
+                              const std::string& remote_path,
+                              const std::string& tag_name,
+                              const std::string& transfer_token,
+                              const std::string& https_token,
+                              size_t range_size, unsigned num_streams,
+                              int& error_code);
 #endif
 
   std::shared_ptr<wrp_cte::core::Client> cte_client_;
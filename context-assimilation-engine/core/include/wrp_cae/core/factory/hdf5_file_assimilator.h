@@ -36,6 +36,7 @@
 
 #include <wrp_cae/core/factory/base_assimilator.h>
 #include <hdf5.h>
+#include <functional>
 #include <string>
 #include <vector>
 #include <memory>
@@ -121,12 +122,206 @@ class Hdf5FileAssimilator : public BaseAssimilator {
    * @param dataset_path Path to dataset within file (e.g., "/data/temperature")
    * @param tag_prefix Prefix for tag name (destination path without protocol)
    * @param error_code Output: 0 on success, non-zero error code on failure
+   * @param raw_chunks Store filtered chunks as-is instead of decoding them
+   * @param lazy Register blobs as stubs over the file instead of copying
+   * @param lazy_cache Cache each stub in a CTE target on its first read
    * @return TaskResume for coroutine suspension/resumption
    */
   chi::TaskResume ProcessDataset(hid_t file_id, const std::string& dataset_path,
-                                  const std::string& tag_prefix, int& error_code);
+                                  const std::string& tag_prefix, int& error_code,
+                                  bool raw_chunks = false, bool lazy = false,
+                                  bool lazy_cache = false);
 
  private:
+  /**
+   * Hyperslab layout of a dataset's chunk_N blobs. Every slab is a run of
+   * rows along split_dim_ (full extent in the inner dimensions), so the
+   * blobs concatenate to the dataset in row-major order.
+   */
+  struct SlabPlan {
+    int split_dim_ = -1;  // Dimension slabs are split along (-1 = scalar)
+    hsize_t rows_ = 1;    // Slab extent along split_dim_
+  };
+
+  /** Reads blob i of a transfer into its buffer; false on a read error */
+  using BlobReader = std::function<bool(size_t index, char* buffer)>;
+
+  /**
+   * Open a dataset with a chunk cache large enough for one row of its
+   * native chunks, so each chunk is decoded once while streaming
+   * @param file_id HDF5 file ID
+   * @param dataset_path Path to dataset within file
+   * @return Dataset ID, or negative value on error
+   */
+  hid_t OpenDataset(hid_t file_id, const std::string& dataset_path);
+
+  /**
+   * Get the native chunk dimensions of a dataset
+   * @param dataset_id HDF5 dataset ID
+   * @param rank Dataset rank
+   * @return Chunk dimensions, or empty if the dataset is not chunked
+   */
+  std::vector<hsize_t> GetChunkDims(hid_t dataset_id, int rank);
+
+  /**
+   * Plan the slabs of a dataset: split along the outermost dimension whose
+   * inner rows fit a blob, with slabs aligned to the native chunks
+   * @param dims Dataset dimensions
+   * @param chunk_dims Native chunk dimensions (empty if not chunked)
+   * @param type_size Element size in bytes
+   * @param max_bytes Maximum blob size in bytes
+   * @return Slab plan
+   */
+  static SlabPlan PlanSlabs(const std::vector<hsize_t>& dims,
+                            const std::vector<hsize_t>& chunk_dims,
+                            size_t type_size, size_t max_bytes);
+
+  /**
+   * Get the extent of the slab starting at start
+   * @param dims Dataset dimensions
+   * @param plan Slab plan
+   * @param start Slab start coordinates
+   * @return Slab count per dimension
+   */
+  static std::vector<hsize_t> SlabCount(const std::vector<hsize_t>& dims,
+                                        const SlabPlan& plan,
+                                        const std::vector<hsize_t>& start);
+
+  /**
+   * Advance start to the next slab in row-major order
+   * @param dims Dataset dimensions
+   * @param plan Slab plan
+   * @param start In/out: slab start coordinates
+   * @return false once every slab has been visited
+   */
+  static bool NextSlab(const std::vector<hsize_t>& dims, const SlabPlan& plan,
+                       std::vector<hsize_t>& start);
+
+  /**
+   * Read one hyperslab of a dataset into a flat buffer
+   * @param dataset_id HDF5 dataset ID
+   * @param datatype_id HDF5 datatype ID
+   * @param start Slab start coordinates (empty for a scalar)
+   * @param count Slab count per dimension
+   * @param buffer Output buffer of the slab's size
+   * @return true on success
+   */
+  bool ReadSlab(hid_t dataset_id, hid_t datatype_id,
+                const std::vector<hsize_t>& start,
+                const std::vector<hsize_t>& count, char* buffer);
+
+  /**
+   * Check whether a dataset's chunks can be stored without decoding: the
+   * dataset is chunked, filtered, and every stored chunk fits a blob
+   * @param dataset_id HDF5 dataset ID
+   * @param max_bytes Maximum blob size in bytes
+   * @return true if the raw chunks can be passed through
+   */
+  bool CanPassRawChunks(hid_t dataset_id, size_t max_bytes);
+
+  /**
+   * Describe the raw chunks of a dataset for the "chunk_index" blob: the
+   * chunk shape, the filter pipeline and each chunk's offset, filter mask
+   * and stored size
+   * @param dataset_id HDF5 dataset ID
+   * @param rank Dataset rank
+   * @param offsets Output: offset coordinates of each chunk
+   * @param sizes Output: stored size of each chunk
+   * @param addrs Output: file address of each chunk
+   * @return Chunk index text
+   */
+  std::string DescribeRawChunks(hid_t dataset_id, int rank,
+                                std::vector<std::vector<hsize_t>>& offsets,
+                                std::vector<size_t>& sizes,
+                                std::vector<hsize_t>& addrs);
+
+  /**
+   * File address of a dataset whose bytes can be served straight from the
+   * file: contiguous, unfiltered, allocated and of a fixed-size type
+   * @param dataset_id HDF5 dataset identifier
+   * @param datatype_id Datatype of the dataset
+   * @return Byte offset in the file (userblock included), or HADDR_UNDEF
+   */
+  static haddr_t GetContiguousAddress(hid_t dataset_id, hid_t datatype_id);
+
+  /**
+   * Absolute path of an open HDF5 file and the byte offset of its HDF5
+   * base address (the userblock size), which chunk addresses are relative to
+   * @param file_id HDF5 file identifier
+   * @param base Output: bytes preceding HDF5 address 0
+   * @return File path, or empty on failure
+   */
+  static std::string GetStubSource(hid_t file_id, hsize_t& base);
+
+  /**
+   * Register a sequence of CTE blob stubs named <prefix><i>, each over
+   * sizes[i] bytes of src_path at offsets[i], keeping a bounded window of
+   * registrations in flight
+   * @param tag_id CTE tag of the dataset
+   * @param prefix Blob name prefix
+   * @param src_path File the stubs read from
+   * @param offsets Byte offset of each blob in src_path
+   * @param sizes Size of each blob in bytes
+   * @param cache Cache each stub in a CTE target on its first read
+   * @param error_code Output: 0 on success, -10 if a registration failed
+   * @return TaskResume for coroutine suspension/resumption
+   */
+  chi::TaskResume RegisterStubs(const chi::UniqueId& tag_id,
+                                const std::string& prefix,
+                                const std::string& src_path,
+                                const std::vector<hsize_t>& offsets,
+                                const std::vector<size_t>& sizes, bool cache,
+                                int& error_code);
+
+  /**
+   * Put a sequence of blobs named <prefix><i>, keeping a bounded window
+   * of read buffers in flight: each blob is read as soon as a slot frees
+   * and its PutBlob is issued right after the read
+   * @param tag_id CTE tag of the dataset
+   * @param prefix Blob name prefix
+   * @param sizes Size of each blob in bytes
+   * @param reader Fills each blob's buffer, in order
+   * @param error_code Output: 0 on success, non-zero error code on failure
+   * @return TaskResume for coroutine suspension/resumption
+   */
+  chi::TaskResume PutBlobWindow(const chi::UniqueId& tag_id,
+                                const std::string& prefix,
+                                const std::vector<size_t>& sizes,
+                                const BlobReader& reader, int& error_code);
+
+  /**
+   * Order datasets largest first so the longest transfers start early
+   * and do not become stragglers at the end of a file
+   * @param file_id HDF5 file identifier
+   * @param paths Dataset paths, reordered in place
+   * @param sizes Output: storage size in bytes of each reordered dataset
+   */
+  static void OrderLargestFirst(hid_t file_id, std::vector<std::string>& paths,
+                                std::vector<hsize_t>& sizes);
+
+  /**
+   * Process datasets as ProcessHdf5Dataset subtasks. A bounded window is
+   * kept in flight; each new dataset goes to the least loaded node, and
+   * finished subtasks are reaped in completion order so slow nodes do not
+   * hold back fast ones
+   * @param src_path HDF5 file path
+   * @param tag_prefix Tag prefix for CTE storage
+   * @param datasets Dataset paths in dispatch order
+   * @param sizes Storage size of each dataset, used for progress reports
+   * @param raw_chunks Pass through filtered chunks undecoded
+   * @param lazy Register blob stubs instead of copying data
+   * @param lazy_cache Cache stubs on their first read
+   * @param num_nodes Number of nodes to spread subtasks across
+   * @param total_errors Output: number of datasets that failed
+   * @return TaskResume for coroutine suspension/resumption
+   */
+  chi::TaskResume DispatchDatasets(const std::string& src_path,
+                                   const std::string& tag_prefix,
+                                   const std::vector<std::string>& datasets,
+                                   const std::vector<hsize_t>& sizes,
+                                   bool raw_chunks, bool lazy,
+                                   bool lazy_cache, size_t num_nodes,
+                                   int& total_errors);
 
   /**
    * Get human-readable type name for HDF5 datatype
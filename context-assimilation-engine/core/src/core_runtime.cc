@@ -31,6 +31,7 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <chimaera/blocking_pool.h>
 #include <wrp_cae/core/core_runtime.h>
 #include <wrp_cae/core/factory/assimilation_ctx.h>
 #include <wrp_cae/core/factory/assimilator_factory.h>
@@ -40,6 +41,7 @@
 #endif
 
 #include "hermes_shm/data_structures/serialization/global_serialize.h"
+#include <algorithm>
 #include <fstream>
 #include <vector>
 
@@ -53,6 +55,12 @@ CHI_TASK_CC(wrp_cae::core::Runtime)
 
 namespace wrp_cae::core {
 
+/** ParseOmni subtasks (one per bundled context) in flight per node */
+static constexpr size_t kMaxContextsPerNode = 2;
+
+/** Contexts completed between bundle progress reports */
+static constexpr size_t kContextProgressInterval = 100;
+
 chi::TaskResume Runtime::Monitor(hipc::FullPtr<MonitorTask> task,
                                  chi::RunContext &rctx) {
   CHI_TASK_BODY_BEGIN
@@ -119,6 +127,13 @@ chi::TaskResume Runtime::ParseOmni(hipc::FullPtr<ParseOmniTask> task,
   HLOG(kInfo, "ParseOmni: Processing {} assimilation contexts",
        assimilation_contexts.size());
 
+  // Bundles fan out one subtask per context; each subtask then takes the
+  // sequential path below with a single context
+  if (assimilation_contexts.size() > 1) {
+    CHI_CO_AWAIT(FanOutContexts(assimilation_contexts, task));
+    CHI_CO_RETURN;
+  }
+
   // Process each assimilation context
   chi::u32 tasks_scheduled = 0;
   AssimilatorFactory factory(cte_client_);
@@ -172,6 +187,57 @@ chi::TaskResume Runtime::ParseOmni(hipc::FullPtr<ParseOmniTask> task,
   CHI_TASK_BODY_END
 }
 
+chi::TaskResume Runtime::FanOutContexts(
+    const std::vector<AssimilationCtx>& contexts,
+    hipc::FullPtr<ParseOmniTask> task) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  auto* ipc_manager = CHI_IPC;
+  size_t num_nodes = std::max<size_t>(ipc_manager->GetAllHosts().size(), 1);
+  size_t window = kMaxContextsPerNode * num_nodes;
+  chi::u32 tasks_scheduled = 0;
+  size_t failed = 0;
+  task->result_code_ = 0;
+
+  // Subtasks are awaited oldest first; the window keeps every node busy
+  // while one straggler file finishes
+  std::vector<chi::Future<ParseOmniTask>> active;
+  size_t next = 0, done = 0;
+  while (next < contexts.size() || !active.empty()) {
+    while (next < contexts.size() && active.size() < window) {
+      auto pool_query =
+          num_nodes > 1
+              ? chi::PoolQuery::DirectHash(static_cast<chi::u32>(next))
+              : chi::PoolQuery::Local();
+      active.push_back(client_.AsyncParseOmni({contexts[next]}, pool_query));
+      ++next;
+    }
+    auto& sub = active.front();
+    CHI_CO_AWAIT(sub);
+    tasks_scheduled += sub->num_tasks_scheduled_;
+    if (sub->result_code_ != 0) {
+      HLOG(kError, "ParseOmni: Context {}/{} failed with error code: {}",
+           done + 1, contexts.size(), sub->result_code_);
+      if (failed++ == 0) {
+        task->result_code_ = sub->result_code_;
+        task->error_message_ = sub->error_message_;
+      }
+    }
+    active.erase(active.begin());
+    if (++done % kContextProgressInterval == 0 || done == contexts.size()) {
+      HLOG(kInfo, "ParseOmni: Progress {}/{} contexts, {} failed", done,
+           contexts.size(), failed);
+    }
+  }
+  task->num_tasks_scheduled_ = tasks_scheduled;
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
 chi::TaskResume Runtime::ProcessHdf5Dataset(
     hipc::FullPtr<ProcessHdf5DatasetTask> task, chi::RunContext& ctx) {
 #ifdef __NVCOMPILER
@@ -201,7 +267,9 @@ chi::TaskResume Runtime::ProcessHdf5Dataset(
   wrp_cae::core::Hdf5FileAssimilator assimilator(cte_client_);
   int result = 0;
   CHI_CO_AWAIT(assimilator.ProcessDataset(file_id, task->dataset_path_.str(),
-                                      task->tag_prefix_.str(), result));
+                                      task->tag_prefix_.str(), result,
+                                      task->raw_chunks_, task->lazy_,
+                                      task->lazy_cache_));
 
   // Close the HDF5 file
   H5Fclose(file_id);
@@ -298,17 +366,24 @@ chi::TaskResume Runtime::ExportData(hipc::FullPtr<ExportDataTask> task,
       CHI_CO_AWAIT(get_future);
 
       if (get_future->GetReturnCode() == 0) {
-        hsize_t dims[1] = {static_cast<hsize_t>(blob_size)};
-        hid_t space = H5Screate_simple(1, dims, nullptr);
-        hid_t ds = H5Dcreate2(file_id, blob_name.c_str(), H5T_NATIVE_UINT8,
-                               space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
-        if (ds >= 0) {
-          H5Dwrite(ds, H5T_NATIVE_UINT8, H5S_ALL, H5S_ALL, H5P_DEFAULT,
-                   buf.ptr_);
-          H5Dclose(ds);
+        // The dataset write blocks on the file; keep it off the worker
+        bool wrote = false;
+        CHI_CO_AWAIT(chi::RunBlocking([&]() {
+          hsize_t dims[1] = {static_cast<hsize_t>(blob_size)};
+          hid_t space = H5Screate_simple(1, dims, nullptr);
+          hid_t ds = H5Dcreate2(file_id, blob_name.c_str(), H5T_NATIVE_UINT8,
+                                space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+          if (ds >= 0) {
+            H5Dwrite(ds, H5T_NATIVE_UINT8, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+                     buf.ptr_);
+            H5Dclose(ds);
+            wrote = true;
+          }
+          H5Sclose(space);
+        }));
+        if (wrote) {
           task->bytes_exported_ += blob_size;
         }
-        H5Sclose(space);
       }
       ipc_manager->FreeBuffer(buf);
     }
@@ -351,11 +426,15 @@ chi::TaskResume Runtime::ExportData(hipc::FullPtr<ExportDataTask> task,
 
       if (get_future->GetReturnCode() == 0) {
         // Header: name length (u32) + name + data length (u64) + data
-        uint32_t name_len = static_cast<uint32_t>(blob_name.size());
-        ofs.write(reinterpret_cast<const char *>(&name_len), sizeof(name_len));
-        ofs.write(blob_name.data(), name_len);
-        ofs.write(reinterpret_cast<const char *>(&blob_size), sizeof(blob_size));
-        ofs.write(buf.ptr_, static_cast<std::streamsize>(blob_size));
+        CHI_CO_AWAIT(chi::RunBlocking([&]() {
+          uint32_t name_len = static_cast<uint32_t>(blob_name.size());
+          ofs.write(reinterpret_cast<const char *>(&name_len),
+                    sizeof(name_len));
+          ofs.write(blob_name.data(), name_len);
+          ofs.write(reinterpret_cast<const char *>(&blob_size),
+                    sizeof(blob_size));
+          ofs.write(buf.ptr_, static_cast<std::streamsize>(blob_size));
+        }));
         task->bytes_exported_ += blob_size;
       }
       ipc_manager->FreeBuffer(buf);
@@ -32,14 +32,16 @@
  */
 
 #include <chimaera/chimaera.h>
+#include <fcntl.h>
 #ifndef _WIN32
 #include <sys/stat.h>
 #endif
+#include <hermes_shm/io/async_io_factory.h>
 #include <wrp_cae/core/factory/binary_file_assimilator.h>
 
 #include <algorithm>
 #include <cstring>
-#include <fstream>
+#include <deque>
 #include <vector>
 
 // Include wrp_cte headers after closing any wrp_cae namespace to avoid Method
@@ -49,6 +51,15 @@
 
 namespace wrp_cae::core {
 
+/** Default bytes per chunk blob */
+static constexpr size_t kDefaultChunkSize = 1024 * 1024;
+
+/** Default chunks (reads plus PutBlobs) in flight */
+static constexpr chi::u32 kDefaultIoDepth = 32;
+
+/** Delay between completion polls when no chunk made progress */
+static constexpr double kIoPollUs = 10.0;
+
 BinaryFileAssimilator::BinaryFileAssimilator(
     std::shared_ptr<wrp_cte::core::Client> cte_client)
     : cte_client_(cte_client) {}
@@ -196,170 +207,138 @@ chi::TaskResume BinaryFileAssimilator::Schedule(const AssimilationCtx& ctx,
   }
   HLOG(kDebug, "BinaryFileAssimilator: Description blob stored successfully");
 
-  // Define chunking parameters
-  static constexpr size_t kMaxChunkSize = 1024 * 1024;  // 1 MB
-  static constexpr size_t kMaxParallelTasks = 32;
-
-  // Calculate number of chunks
-  size_t num_chunks = (total_size + kMaxChunkSize - 1) / kMaxChunkSize;
+  size_t chunk_size = ctx.chunk_size > 0 ? ctx.chunk_size : kDefaultChunkSize;
+  chi::u32 io_depth = ctx.io_depth > 0 ? ctx.io_depth : kDefaultIoDepth;
+  size_t num_chunks = (total_size + chunk_size - 1) / chunk_size;
   HLOG(kDebug,
-       "BinaryFileAssimilator: Will transfer {} bytes in {} chunks (max {} "
-       "parallel)",
-       total_size, num_chunks, kMaxParallelTasks);
-
-  // Open file for reading
-  HLOG(kDebug, "BinaryFileAssimilator: Opening file '{}'", src_path);
-  std::ifstream file(src_path, std::ios::binary);
-  if (!file.is_open()) {
-    HLOG(kError, "BinaryFileAssimilator: Failed to open file '{}'", src_path);
-    error_code = -7;
+       "BinaryFileAssimilator: Will transfer {} bytes in {} chunks of {} "
+       "bytes (io depth {})",
+       total_size, num_chunks, chunk_size, io_depth);
+
+  int transfer_result = 0;
+  CHI_CO_AWAIT(TransferRange(tag_id, src_path, chunk_offset, total_size,
+                             chunk_size, io_depth, transfer_result));
+  if (transfer_result != 0) {
+    error_code = transfer_result;
     CHI_CO_RETURN;
   }
 
-  // Seek to the starting offset
-  HLOG(kDebug, "BinaryFileAssimilator: Seeking to offset {}", chunk_offset);
-  file.seekg(chunk_offset, std::ios::beg);
-  if (!file.good()) {
-    HLOG(kError,
-         "BinaryFileAssimilator: Failed to seek to offset {} in file '{}'",
-         chunk_offset, src_path);
-    error_code = -8;
+  HLOG(kDebug,
+       "BinaryFileAssimilator: Successfully scheduled {} chunks for file '{}' "
+       "to tag '{}'",
+       num_chunks, src_path, tag_name);
+  HLOG(kDebug, "BinaryFileAssimilator::Schedule EXIT: Success");
+
+  error_code = 0;
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+chi::TaskResume BinaryFileAssimilator::TransferRange(
+    const chi::UniqueId& tag_id, const std::string& src_path, size_t offset,
+    size_t total_size, size_t chunk_size, chi::u32 io_depth,
+    int& error_code) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  error_code = 0;
+  auto io = hshm::AsyncIoFactory::Get(io_depth);
+  if (!io || !io->Open(src_path, O_RDONLY, 0)) {
+    HLOG(kError, "BinaryFileAssimilator: Failed to open file '{}'", src_path);
+    error_code = -7;
     CHI_CO_RETURN;
   }
 
-  // Process chunks in batches
-  HLOG(kDebug, "BinaryFileAssimilator: Starting chunk processing");
-  size_t chunk_idx = 0;
-  size_t bytes_processed = 0;
-  std::vector<chi::Future<wrp_cte::core::PutBlobTask>> active_tasks;
-
-  while (bytes_processed < total_size) {
-    // Submit tasks up to the parallel limit
-    while (active_tasks.size() < kMaxParallelTasks &&
-           bytes_processed < total_size) {
-      // Calculate chunk size
-      size_t current_chunk_size =
-          std::min(kMaxChunkSize, total_size - bytes_processed);
-
-      // Allocate buffer in shared memory
-      auto buffer_ptr = CHI_IPC->AllocateBuffer(current_chunk_size);
-      char* buffer = buffer_ptr.ptr_;
-
-      // Read chunk from file
-      HLOG(kDebug,
-           "BinaryFileAssimilator: About to read chunk {} ({} bytes) at file "
-           "position {}",
-           chunk_idx, current_chunk_size, file.tellg());
-
-      file.read(buffer, current_chunk_size);
-      std::streamsize bytes_read = file.gcount();
-
-      HLOG(kDebug,
-           "BinaryFileAssimilator: After read - bytes_read={}, eof={}, "
-           "fail={}, bad={}, good={}",
-           bytes_read, file.eof(), file.fail(), file.bad(), file.good());
-
-      if (bytes_read != static_cast<std::streamsize>(current_chunk_size)) {
-        // Check if this is a legitimate short read at end of file
-        if (file.eof() && bytes_read > 0) {
-          // This is OK - we read partial data at the end
-          HLOG(kDebug,
-               "BinaryFileAssimilator: Chunk {} partial read: {} bytes "
-               "(expected {})",
-               chunk_idx, bytes_read, current_chunk_size);
-          current_chunk_size = static_cast<size_t>(bytes_read);
-        } else if (file.fail() || bytes_read == 0) {
-          HLOG(kError,
-               "BinaryFileAssimilator: Failed to read chunk {} from file '{}' "
-               "(bytes_read={}, eof={}, fail={}, bad={})",
-               chunk_idx, src_path, bytes_read, file.eof(), file.fail(),
-               file.bad());
-          HLOG(kError,
-               "BinaryFileAssimilator: File position: {}, bytes_processed: {}, "
-               "total_size: {}",
-               file.tellg(), bytes_processed, total_size);
-          CHI_IPC->FreeBuffer(buffer_ptr);
-          error_code = -9;
-          CHI_CO_RETURN;
-        }
+  // Each slot owns its IPC buffer from the read until its PutBlob is done
+  struct Slot {
+    size_t index_;
+    hipc::FullPtr<char> buffer_;
+    size_t size_;
+    hshm::IoToken token_;
+    bool put_issued_;
+    chi::Future<wrp_cte::core::PutBlobTask> put_;
+  };
+  std::deque<Slot> slots;
+  size_t next = 0, bytes_submitted = 0;
+  while (bytes_submitted < total_size || !slots.empty()) {
+    // Submit reads until the queue depth is reached
+    while (error_code == 0 && bytes_submitted < total_size &&
+           slots.size() < io_depth) {
+      size_t size = std::min(chunk_size, total_size - bytes_submitted);
+      auto buffer = CHI_IPC->AllocateBuffer(size);
+      if (buffer.IsNull()) {
+        HLOG(kError, "BinaryFileAssimilator: Failed to allocate {} bytes",
+             size);
+        error_code = -11;
+        break;
       }
-
-      HLOG(kDebug,
-           "BinaryFileAssimilator: Read chunk {} successfully ({} bytes)",
-           chunk_idx, bytes_read);
-
-      // Create blob name with chunk index
-      std::string blob_name = "chunk_" + std::to_string(chunk_idx);
-
-      HLOG(kDebug,
-           "BinaryFileAssimilator: Submitting chunk {} (offset={}, size={}, "
-           "blob='{}')",
-           chunk_idx, chunk_offset + bytes_processed, current_chunk_size,
-           blob_name);
-
-      // Submit PutBlob task asynchronously
-      HLOG(kDebug,
-           "BinaryFileAssimilator: About to call AsyncPutBlob for chunk {}",
-           chunk_idx);
-      auto task =
-          cte_client_->AsyncPutBlob(tag_id, blob_name, 0, current_chunk_size,
-                                    buffer_ptr.shm_.template Cast<void>(), 1.0f,
-                                    wrp_cte::core::Context(), 0);
-
-      active_tasks.push_back(task);
-
-      bytes_processed += current_chunk_size;
-      chunk_idx++;
+      hshm::IoToken token =
+          io->Read(buffer.ptr_, size, offset + bytes_submitted);
+      if (token == hshm::kInvalidIoToken) {
+        HLOG(kError, "BinaryFileAssimilator: Failed to submit read of chunk "
+             "{} from '{}'", next, src_path);
+        CHI_IPC->FreeBuffer(buffer);
+        error_code = -8;
+        break;
+      }
+      slots.push_back({next++, buffer, size, token, false, {}});
+      bytes_submitted += size;
+    }
+    if (error_code != 0) {
+      bytes_submitted = total_size;  // Stop reading, but drain the slots
     }
 
-    // Wait for at least one task to complete before continuing
-    if (!active_tasks.empty()) {
-      // Wait for the first task to complete
-      auto& first_task = active_tasks.front();
-      CHI_CO_AWAIT(first_task);
-
-      if (first_task->return_code_ != 0) {
-        HLOG(kError, "BinaryFileAssimilator: PutBlob task failed with code {}",
-             first_task->return_code_);
-        // Free the buffer before deleting the task
-        CHI_IPC->FreeBuffer(first_task->blob_data_.template Cast<char>());
-        error_code = -10;
-        CHI_CO_RETURN;
+    // Hand every finished read to CTE, in whatever order reads complete
+    bool progressed = false;
+    for (auto& slot : slots) {
+      hshm::IoResult result;
+      if (slot.put_issued_ || !io->IsComplete(slot.token_, result)) {
+        continue;
+      }
+      progressed = true;
+      slot.put_issued_ = true;
+      if (result.bytes_transferred != static_cast<ssize_t>(slot.size_)) {
+        HLOG(kError,
+             "BinaryFileAssimilator: Failed to read chunk {} from file '{}' "
+             "(bytes_read={}, expected={}, errno={})",
+             slot.index_, src_path, result.bytes_transferred, slot.size_,
+             result.error_code);
+        error_code = error_code != 0 ? error_code : -9;
+        continue;
+      }
+      if (error_code == 0) {
+        slot.put_ = cte_client_->AsyncPutBlob(
+            tag_id, "chunk_" + std::to_string(slot.index_), 0, slot.size_,
+            slot.buffer_.shm_.template Cast<void>(), 1.0f,
+            wrp_cte::core::Context(), 0);
       }
-
-      // Free the buffer before deleting the task
-      CHI_IPC->FreeBuffer(first_task->blob_data_.template Cast<char>());
-      active_tasks.erase(active_tasks.begin());
     }
-  }
 
-  // Wait for all remaining tasks to complete
-  HLOG(kDebug,
-       "BinaryFileAssimilator: Waiting for {} remaining tasks to complete",
-       active_tasks.size());
-  for (auto& task : active_tasks) {
-    CHI_CO_AWAIT(task);
-    if (task->return_code_ != 0) {
-      HLOG(kError, "BinaryFileAssimilator: PutBlob task failed with code {}",
-           task->return_code_);
-      // Free the buffer before deleting the task
-      CHI_IPC->FreeBuffer(task->blob_data_.template Cast<char>());
-      error_code = -10;
-      CHI_CO_RETURN;
+    // Retire finished slots from the front so memory is reused in order
+    while (!slots.empty() && slots.front().put_issued_ &&
+           (slots.front().put_.IsNull() || slots.front().put_.IsComplete())) {
+      auto& front = slots.front();
+      if (!front.put_.IsNull()) {
+        CHI_CO_AWAIT(front.put_);
+        if (front.put_->return_code_ != 0 && error_code == 0) {
+          HLOG(kError,
+               "BinaryFileAssimilator: PutBlob task failed with code {}",
+               front.put_->return_code_);
+          error_code = -10;
+        }
+      }
+      CHI_IPC->FreeBuffer(front.buffer_);
+      slots.pop_front();
+      progressed = true;
+    }
+    if (!progressed && !slots.empty()) {
+      CHI_CO_AWAIT(chi::yield(kIoPollUs));
     }
-    // Free the buffer before deleting the task
-    CHI_IPC->FreeBuffer(task->blob_data_.template Cast<char>());
   }
-
-  file.close();
-
-  HLOG(kDebug,
-       "BinaryFileAssimilator: Successfully scheduled {} chunks for file '{}' "
-       "to tag '{}'",
-       num_chunks, src_path, tag_name);
-  HLOG(kDebug, "BinaryFileAssimilator::Schedule EXIT: Success");
-
-  error_code = 0;
+  io->Close();
   CHI_CO_RETURN;
   CHI_TASK_BODY_END
 }
@@ -44,16 +44,31 @@
 #include <sys/wait.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <cerrno>
 #include <nlohmann/json.hpp>
 #include <sstream>
+#include <vector>
 #endif
 
 // Include wrp_cte headers after closing any wrp_cae namespace to avoid Method
 // namespace collision
 #include <wrp_cte/core/core_client.h>
+#include <wrp_cte/core/core_tasks.h>
 
 namespace wrp_cae::core {
 
+#ifdef CAE_ENABLE_GLOBUS
+/** Default bytes per range GET (and per chunk blob) for iowarp:: ingest */
+static constexpr size_t kDefaultRangeSize = 16 * 1024 * 1024;
+
+/** Default parallel range GET connections for iowarp:: ingest */
+static constexpr unsigned kDefaultStreams = 8;
+
+/** Delay between polls when no range stream made progress */
+static constexpr double kRangePollUs = 100.0;
+#endif
+
 GlobusFileAssimilator::GlobusFileAssimilator(
     std::shared_ptr<wrp_cte::core::Client> cte_client)
     : cte_client_(cte_client) {}
@@ -89,13 +104,13 @@ chi::TaskResume GlobusFileAssimilator::Schedule(const AssimilationCtx& ctx,
   bool is_dst_globus_web_url = (ctx.dst.find("https://app.globus.org") == 0);
   bool is_dst_globus_uri = (ctx.dst.find("globus://") == 0);
   std::string dst_protocol = GetUrlProtocol(ctx.dst);  // for file:: format
-  bool is_valid_dst = (dst_protocol == "file" || is_dst_globus_uri ||
-                       is_dst_globus_web_url);
+  bool is_valid_dst = (dst_protocol == "file" || dst_protocol == "iowarp" ||
+                       is_dst_globus_uri || is_dst_globus_web_url);
 
   if (!is_valid_dst) {
     HLOG(kError,
-         "GlobusFileAssimilator: Destination must be file::, globus://, or "
-         "Globus web URL, got: '{}'",
+         "GlobusFileAssimilator: Destination must be file::, iowarp::, "
+         "globus://, or Globus web URL, got: '{}'",
          ctx.dst);
     error_code = -3;
     CHI_CO_RETURN;
@@ -169,25 +184,7 @@ chi::TaskResume GlobusFileAssimilator::Schedule(const AssimilationCtx& ctx,
     HLOG(kInfo, "Source:       {}", ctx.src);
     HLOG(kInfo, "Destination:  {}", ctx.dst);
 
-    // HTTPS downloads require the collection-specific HTTPS token,
-    // not the Transfer API token. Check dst_token, then
-    // GLOBUS_HTTPS_ACCESS_TOKEN env var, then fall back to access_token.
-    std::string https_token;
-    if (!ctx.dst_token.empty()) {
-      https_token = ctx.dst_token;
-      HLOG(kDebug, "GlobusFileAssimilator: Using HTTPS token from dst_token");
-    } else {
-      const char* https_env = std::getenv("GLOBUS_HTTPS_ACCESS_TOKEN");
-      if (https_env && std::strlen(https_env) > 0) {
-        https_token = https_env;
-        HLOG(kDebug, "GlobusFileAssimilator: Using HTTPS token from "
-             "GLOBUS_HTTPS_ACCESS_TOKEN environment variable");
-      } else {
-        https_token = access_token;
-        HLOG(kDebug, "GlobusFileAssimilator: No collection HTTPS token found, "
-             "falling back to transfer API token");
-      }
-    }
+    std::string https_token = GetHttpsToken(ctx, access_token);
 
     // Download file from Globus to local filesystem.
     // Note: this blocks the chimaera scheduler worker, but ZMQ I/O threads
@@ -212,6 +209,23 @@ chi::TaskResume GlobusFileAssimilator::Schedule(const AssimilationCtx& ctx,
          "filesystem");
     CHI_CO_RETURN;
 
+  } else if (dst_protocol == "iowarp") {
+    // Globus straight into CTE: ranges become blobs as they arrive
+    std::string tag_name = GetUrlPath(ctx.dst);
+    if (tag_name.empty()) {
+      HLOG(kError,
+           "GlobusFileAssimilator: Invalid destination URL, no tag name found");
+      error_code = -5;
+      CHI_CO_RETURN;
+    }
+    signal(SIGPIPE, SIG_IGN);
+    size_t range_size = ctx.chunk_size > 0 ? ctx.chunk_size : kDefaultRangeSize;
+    unsigned num_streams = ctx.io_depth > 0 ? ctx.io_depth : kDefaultStreams;
+    CHI_CO_AWAIT(IngestToCte(src_endpoint, src_path, tag_name, access_token,
+                             GetHttpsToken(ctx, access_token), range_size,
+                             num_streams, error_code));
+    CHI_CO_RETURN;
+
   } else {
     // Globus to Globus transfer
     HLOG(kDebug, "GlobusFileAssimilator: Initiating Globus-to-Globus transfer");
@@ -450,17 +464,19 @@ static std::string UrlEncodePath(const std::string& path) {
 // RunCurlExec: forks curl and returns its exit code (0 = success).
 //   Used when the output is written to a file via -o.
 
-static std::string RunCurlCapture(const std::vector<std::string>& args) {
+// SpawnCurl: forks curl with stdout wired to a pipe and returns its pid
+//   (-1 on failure). The caller reads out_fd and reaps the child.
+static pid_t SpawnCurl(const std::vector<std::string>& args, int& out_fd) {
   int pipefd[2];
   if (pipe(pipefd) == -1) {
-    return "";
+    return -1;
   }
 
   pid_t pid = fork();
   if (pid == -1) {
     close(pipefd[0]);
     close(pipefd[1]);
-    return "";
+    return -1;
   }
 
   if (pid == 0) {
@@ -480,15 +496,26 @@ static std::string RunCurlCapture(const std::vector<std::string>& args) {
     _exit(1);
   }
 
-  // Parent: drain the read end.
   close(pipefd[1]);
+  out_fd = pipefd[0];
+  return pid;
+}
+
+static std::string RunCurlCapture(const std::vector<std::string>& args) {
+  int read_fd = -1;
+  pid_t pid = SpawnCurl(args, read_fd);
+  if (pid == -1) {
+    return "";
+  }
+
+  // Parent: drain the read end.
   std::string result;
   char buf[8192];
   ssize_t n;
-  while ((n = ::read(pipefd[0], buf, sizeof(buf))) > 0) {
+  while ((n = ::read(read_fd, buf, sizeof(buf))) > 0) {
     result.append(buf, static_cast<size_t>(n));
   }
-  close(pipefd[0]);
+  close(read_fd);
 
   int status = 0;
   waitpid(pid, &status, 0);
@@ -559,6 +586,26 @@ std::string GlobusFileAssimilator::HttpPost(const std::string& url,
   return result;
 }
 
+std::string GlobusFileAssimilator::GetHttpsToken(
+    const AssimilationCtx& ctx, const std::string& access_token) {
+  // HTTPS downloads require the collection-specific HTTPS token,
+  // not the Transfer API token. Check dst_token, then
+  // GLOBUS_HTTPS_ACCESS_TOKEN env var, then fall back to access_token.
+  if (!ctx.dst_token.empty()) {
+    HLOG(kDebug, "GlobusFileAssimilator: Using HTTPS token from dst_token");
+    return ctx.dst_token;
+  }
+  const char* https_env = std::getenv("GLOBUS_HTTPS_ACCESS_TOKEN");
+  if (https_env && std::strlen(https_env) > 0) {
+    HLOG(kDebug, "GlobusFileAssimilator: Using HTTPS token from "
+         "GLOBUS_HTTPS_ACCESS_TOKEN environment variable");
+    return https_env;
+  }
+  HLOG(kDebug, "GlobusFileAssimilator: No collection HTTPS token found, "
+       "falling back to transfer API token");
+  return access_token;
+}
+
 std::string GlobusFileAssimilator::GetSubmissionId(
     const std::string& access_token) {
   std::string url = "https://transfer.api.globus.org/v0.10/submission_id";
@@ -713,26 +760,14 @@ int GlobusFileAssimilator::PollTransferStatus(const std::string& task_id,
   return -8;
 }
 
-int GlobusFileAssimilator::DownloadFile(const std::string& endpoint_id,
-                                        const std::string& remote_path,
-                                        const std::string& local_path,
-                                        const std::string& transfer_token,
-                                        const std::string& https_token) {
-  HLOG(kInfo, "==========================================");
-  HLOG(kInfo, "Globus File Download Starting");
-  HLOG(kInfo, "==========================================");
-  HLOG(kInfo, "Endpoint ID:  {}", endpoint_id);
-  HLOG(kInfo, "Remote path:  {}", remote_path);
-  HLOG(kInfo, "Local path:   {}", local_path);
-
-  HLOG(kDebug, "GlobusFileAssimilator: Downloading file from Globus endpoint");
-  HLOG(kDebug,
-       "GlobusFileAssimilator: Endpoint: {}, Remote path: {}, Local path: {}",
-       endpoint_id, remote_path, local_path);
-
+int GlobusFileAssimilator::ResolveDownloadUrl(const std::string& endpoint_id,
+                                              const std::string& remote_path,
+                                              const std::string& transfer_token,
+                                              std::string& download_url) {
   try {
     // Get endpoint details to find the HTTPS server
     HLOG(kInfo, "[Step 1/4] Querying Globus endpoint details...");
+
     std::string endpoint_url =
         "https://transfer.api.globus.org/v0.10/endpoint/" + endpoint_id;
     HLOG(kInfo, "  API URL: {}", endpoint_url);
@@ -765,12 +800,10 @@ int GlobusFileAssimilator::DownloadFile(const std::string& endpoint_id,
     HLOG(kInfo, "  HTTPS server: {}", https_server);
 
     // Construct the download URL
-    HLOG(kInfo, "[Step 3/4] Initiating HTTPS download...");
     // https_server may already include the scheme (e.g. "https://host").
     // URL-encode the path so that spaces and other special characters are
     // properly percent-encoded (e.g. "Calibration Data" → "Calibration%20Data").
     std::string encoded_path = UrlEncodePath(remote_path);
-    std::string download_url;
     if (https_server.find("://") != std::string::npos) {
       download_url = https_server + encoded_path;
     } else {
@@ -778,6 +811,42 @@ int GlobusFileAssimilator::DownloadFile(const std::string& endpoint_id,
     }
     HLOG(kInfo, "  Download URL: {}", download_url);
 
+    return 0;
+  } catch (const std::exception& e) {
+    HLOG(kError, "GlobusFileAssimilator: Failed to parse endpoint details: {}",
+         e.what());
+    return -15;
+  }
+}
+
+int GlobusFileAssimilator::DownloadFile(const std::string& endpoint_id,
+                                        const std::string& remote_path,
+                                        const std::string& local_path,
+                                        const std::string& transfer_token,
+                                        const std::string& https_token) {
+  HLOG(kInfo, "==========================================");
+  HLOG(kInfo, "Globus File Download Starting");
+  HLOG(kInfo, "==========================================");
+  HLOG(kInfo, "Endpoint ID:  {}", endpoint_id);
+  HLOG(kInfo, "Remote path:  {}", remote_path);
+  HLOG(kInfo, "Local path:   {}", local_path);
+
+  HLOG(kDebug, "GlobusFileAssimilator: Downloading file from Globus endpoint");
+  HLOG(kDebug,
+       "GlobusFileAssimilator: Endpoint: {}, Remote path: {}, Local path: {}",
+       endpoint_id, remote_path, local_path);
+
+  try {
+    // Steps 1-2: find the endpoint's HTTPS server
+    std::string download_url;
+    int resolve_result = ResolveDownloadUrl(endpoint_id, remote_path,
+                                            transfer_token, download_url);
+    if (resolve_result != 0) {
+      return resolve_result;
+    }
+
+    HLOG(kInfo, "[Step 3/4] Initiating HTTPS download...");
+
     // Download the file using fork/exec curl (avoids NSS/POCO crash).
     // curl writes the body directly to local_path (-o), stdout is the HTTP
     // status code (-w "%{http_code}"), and stderr shows progress/errors.
@@ -837,6 +906,226 @@ int GlobusFileAssimilator::DownloadFile(const std::string& endpoint_id,
     return -15;
   }
 }
+
+size_t GlobusFileAssimilator::GetRemoteSize(const std::string& url,
+                                            const std::string& https_token) {
+  // A one-byte range GET proves the server honours ranges and its
+  // Content-Range header ("bytes 0-0/<total>") carries the file size
+  std::string auth = "Authorization: Bearer " + https_token;
+  std::string headers = RunCurlCapture({
+      "-s", "-L", "-k", "--fail",
+      "-r", "0-0",
+      "-H", auth,
+      "-H", "User-Agent: CAE-Globus-Client/1.0",
+      "-D", "-",
+      "-o", "/dev/null",
+      url,
+  });
+  size_t total = 0;
+  std::istringstream lines(headers);
+  std::string line;
+  while (std::getline(lines, line)) {
+    std::string lower = line;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    size_t slash = lower.find('/');
+    if (lower.rfind("content-range:", 0) == 0 && slash != std::string::npos) {
+      total = std::strtoull(line.c_str() + slash + 1, nullptr, 10);
+    }
+  }
+  return total;
+}
+
+/** One in-flight range GET and the IPC buffer it streams into */
+struct GlobusRangeStream {
+  size_t index_;
+  pid_t pid_;
+  int fd_;
+  hipc::FullPtr<char> buffer_;
+  size_t size_;
+  size_t received_;
+  bool overflow_;
+  chi::Future<wrp_cte::core::PutBlobTask> put_;
+};
+
+/**
+ * Copy whatever curl has written so far into the range's buffer
+ * @return 1 if bytes arrived, 0 if none are ready yet, -1 at end of stream
+ */
+static int DrainRangeStream(GlobusRangeStream& stream) {
+  char spill[8192];
+  bool progressed = false;
+  while (true) {
+    size_t room = stream.size_ - stream.received_;
+    char* dst = room > 0 ? stream.buffer_.ptr_ + stream.received_ : spill;
+    ssize_t n = ::read(stream.fd_, dst, room > 0 ? room : sizeof(spill));
+    if (n > 0) {
+      progressed = true;
+      if (room > 0) {
+        stream.received_ += static_cast<size_t>(n);
+      } else {
+        stream.overflow_ = true;  // Server ignored the Range header
+      }
+      continue;
+    }
+    if (n < 0 && (errno == EAGAIN || errno == EINTR)) {
+      return progressed ? 1 : 0;
+    }
+    return -1;
+  }
+}
+
+chi::TaskResume GlobusFileAssimilator::IngestToCte(
+    const std::string& endpoint_id, const std::string& remote_path,
+    const std::string& tag_name, const std::string& transfer_token,
+    const std::string& https_token, size_t range_size, unsigned num_streams,
+    int& error_code) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  std::string url;
+  error_code = ResolveDownloadUrl(endpoint_id, remote_path, transfer_token, url);
+  if (error_code != 0) {
+    CHI_CO_RETURN;
+  }
+  size_t total_size = GetRemoteSize(url, https_token);
+  if (total_size == 0) {
+    HLOG(kError,
+         "GlobusFileAssimilator: '{}' is empty or the server does not "
+         "support range requests",
+         url);
+    error_code = -16;
+    CHI_CO_RETURN;
+  }
+
+  auto tag_task = cte_client_->AsyncGetOrCreateTag(tag_name);
+  CHI_CO_AWAIT(tag_task);
+  wrp_cte::core::TagId tag_id = tag_task->tag_id_;
+  if (tag_id.IsNull()) {
+    HLOG(kError, "GlobusFileAssimilator: Failed to get or create tag '{}'",
+         tag_name);
+    error_code = -19;
+    CHI_CO_RETURN;
+  }
+
+  // Same description as BinaryFileAssimilator, so readers treat both alike
+  std::string description =
+      "binary<size=" + std::to_string(total_size) + ", offset=0>";
+  auto desc_buffer = CHI_IPC->AllocateBuffer(description.size());
+  std::memcpy(desc_buffer.ptr_, description.c_str(), description.size());
+  auto desc_task = cte_client_->AsyncPutBlob(
+      tag_id, "description", 0, description.size(),
+      desc_buffer.shm_.template Cast<void>(), 1.0f, wrp_cte::core::Context(),
+      0);
+  CHI_CO_AWAIT(desc_task);
+  CHI_IPC->FreeBuffer(desc_buffer);
+  if (desc_task->return_code_ != 0) {
+    error_code = -18;
+    CHI_CO_RETURN;
+  }
+
+  size_t num_ranges = (total_size + range_size - 1) / range_size;
+  HLOG(kInfo,
+       "GlobusFileAssimilator: Ingesting {} bytes as {} range(s) over {} "
+       "connection(s)",
+       total_size, num_ranges, num_streams);
+  std::string auth = "Authorization: Bearer " + https_token;
+  std::vector<GlobusRangeStream> streams;
+  size_t next = 0, done = 0;
+  while (next < num_ranges || !streams.empty()) {
+    // Open range GETs until every connection slot is busy
+    while (error_code == 0 && next < num_ranges &&
+           streams.size() < num_streams) {
+      size_t start = next * range_size;
+      size_t size = std::min(range_size, total_size - start);
+      auto buffer = CHI_IPC->AllocateBuffer(size);
+      if (buffer.IsNull()) {
+        error_code = -19;
+        break;
+      }
+      std::string range =
+          std::to_string(start) + "-" + std::to_string(start + size - 1);
+      int fd = -1;
+      pid_t pid = SpawnCurl({"-s", "-L", "-k", "--fail", "-r", range, "-H",
+                             auth, "-H", "User-Agent: CAE-Globus-Client/1.0",
+                             url},
+                            fd);
+      if (pid < 0) {
+        CHI_IPC->FreeBuffer(buffer);
+        error_code = -17;
+        break;
+      }
+      fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+      streams.push_back({next++, pid, fd, buffer, size, 0, false, {}});
+    }
+    if (error_code != 0) {
+      next = num_ranges;  // Open no more ranges, but reap the running ones
+    }
+
+    bool progressed = false;
+    for (auto& stream : streams) {
+      if (stream.fd_ < 0) {
+        continue;
+      }
+      if (error_code != 0) {
+        kill(stream.pid_, SIGTERM);
+      }
+      int drained = DrainRangeStream(stream);
+      progressed |= drained != 0;
+      if (drained >= 0) {
+        continue;
+      }
+      close(stream.fd_);
+      stream.fd_ = -1;
+      int status = 0;
+      waitpid(stream.pid_, &status, 0);
+      bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0 &&
+                stream.received_ == stream.size_ && !stream.overflow_;
+      if (!ok && error_code == 0) {
+        HLOG(kError,
+             "GlobusFileAssimilator: Range {} failed ({} of {} bytes, "
+             "overflow={})",
+             stream.index_, stream.received_, stream.size_, stream.overflow_);
+        error_code = -17;
+      } else if (ok && error_code == 0) {
+        stream.put_ = cte_client_->AsyncPutBlob(
+            tag_id, "chunk_" + std::to_string(stream.index_), 0, stream.size_,
+            stream.buffer_.shm_.template Cast<void>(), 1.0f,
+            wrp_cte::core::Context(), 0);
+      }
+    }
+
+    // Retire ranges whose PutBlob (if any) has finished, in any order
+    for (size_t i = 0; i < streams.size();) {
+      auto& stream = streams[i];
+      if (stream.fd_ >= 0 ||
+          (!stream.put_.IsNull() && !stream.put_.IsComplete())) {
+        ++i;
+        continue;
+      }
+      if (!stream.put_.IsNull()) {
+        CHI_CO_AWAIT(stream.put_);
+        if (stream.put_->return_code_ != 0 && error_code == 0) {
+          error_code = -18;
+        }
+        ++done;
+      }
+      CHI_IPC->FreeBuffer(stream.buffer_);
+      streams.erase(streams.begin() + i);
+      progressed = true;
+    }
+    if (!progressed) {
+      CHI_CO_AWAIT(chi::yield(kRangePollUs));
+    }
+  }
+  HLOG(kInfo, "GlobusFileAssimilator: Ingested {}/{} range(s) into tag '{}'",
+       done, num_ranges, tag_name);
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
 #endif  // CAE_ENABLE_GLOBUS
 
 }  // namespace wrp_cae::core
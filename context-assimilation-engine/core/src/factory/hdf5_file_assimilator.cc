@@ -31,6 +31,7 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <chimaera/blocking_pool.h>
 #include <chimaera/chimaera.h>
 #include <chimaera/ipc_manager.h>
 #ifndef _WIN32
@@ -44,6 +45,8 @@
 
 #include <algorithm>
 #include <cstring>
+#include <filesystem>
+#include <sstream>
 #include <vector>
 
 // Include wrp_cte headers after closing any wrp_cae namespace to avoid Method
@@ -53,6 +56,21 @@
 
 namespace wrp_cae::core {
 
+/** HDF5's default chunk cache size */
+static constexpr size_t kDefaultChunkCacheBytes = 1024 * 1024;
+
+/** Largest chunk cache a streamed dataset is opened with */
+static constexpr size_t kMaxChunkCacheBytes = 256 * 1024 * 1024;
+
+/** PutBlob tasks (and read buffers) in flight per dataset */
+static constexpr size_t kMaxParallelTasks = 32;
+
+/** ProcessHdf5Dataset subtasks in flight per node */
+static constexpr size_t kMaxDatasetsPerNode = 4;
+
+/** Delay between completion polls of in-flight dataset subtasks */
+static constexpr double kDatasetPollUs = 50.0;
+
 Hdf5FileAssimilator::Hdf5FileAssimilator(
     std::shared_ptr<wrp_cte::core::Client> cte_client)
     : cte_client_(cte_client) {}
@@ -178,13 +196,15 @@ chi::TaskResume Hdf5FileAssimilator::Schedule(const AssimilationCtx& ctx,
     filtered_paths = dataset_paths;
   }
 
+  // Start the largest datasets first so they do not trail the rest
+  std::vector<hsize_t> dataset_sizes;
+  OrderLargestFirst(file_id, filtered_paths, dataset_sizes);
+
   // Get distributed processing info from CTE/IPC manager
   size_t num_nodes = 1;
   auto* ipc_manager = CHI_IPC;
-  std::vector<chi::Host> all_hosts;
   if (ipc_manager) {
-    all_hosts = ipc_manager->GetAllHosts();
-    num_nodes = all_hosts.size();
+    num_nodes = std::max<size_t>(ipc_manager->GetAllHosts().size(), 1);
     if (num_nodes > 1) {
       HLOG(kDebug,
            "Hdf5FileAssimilator: CTE distributed mode - {} nodes available",
@@ -200,95 +220,11 @@ chi::TaskResume Hdf5FileAssimilator::Schedule(const AssimilationCtx& ctx,
        "processing...");
   CloseHdf5File(file_id);
 
-  // Distribute datasets across nodes using CTE task routing
+  // Fan the datasets out as subtasks so they run on every worker and node
   int total_errors = 0;
-  if (num_nodes > 1 && !all_hosts.empty()) {
-    // Distributed mode: create per-dataset tasks routed to specific nodes
-    HLOG(kDebug,
-         "Hdf5FileAssimilator: Creating {} distributed tasks across {} nodes",
-         filtered_paths.size(), num_nodes);
-
-    // Create a local CAE client with the correct pool_id for distributed tasks
-    // Do NOT use WRP_CAE_CLIENT global singleton as it may not be properly initialized
-    // with the correct pool_id from the runtime's compose configuration
-    wrp_cae::core::Client cae_client(kCaePoolId);
-    HLOG(kInfo, "Hdf5FileAssimilator: Created CAE client with pool_id {} for distributed tasks",
-          kCaePoolId);
-
-    // Create futures for all dataset tasks
-    std::vector<chi::Future<ProcessHdf5DatasetTask>> futures;
-    futures.reserve(filtered_paths.size());
-
-    for (size_t i = 0; i < filtered_paths.size(); ++i) {
-      const auto& dataset_path = filtered_paths[i];
-      // Round-robin distribution to nodes using direct hash
-      chi::u32 target_node = static_cast<chi::u32>(i % num_nodes);
-      auto pool_query = chi::PoolQuery::DirectHash(target_node);
-
-      HLOG(kDebug, "Hdf5FileAssimilator: Routing dataset {}/{} '{}' to node {}",
-           i + 1, filtered_paths.size(), dataset_path, target_node);
-
-      HLOG(kInfo, "Hdf5FileAssimilator: Calling AsyncProcessHdf5Dataset for pool_id={}",
-            kCaePoolId);
-
-      auto future = cae_client.AsyncProcessHdf5Dataset(
-          pool_query, src_path, dataset_path, tag_prefix);
-
-      HLOG(kInfo, "Hdf5FileAssimilator: AsyncProcessHdf5Dataset returned, task_ptr IsNull={}",
-            future.GetTaskPtr().IsNull());
-
-      futures.push_back(std::move(future));
-    }
-
-    // Wait for all tasks to complete using co_await (not blocking Wait!)
-    // Using co_await allows the coroutine to yield, letting other tasks run
-    HLOG(kDebug,
-         "Hdf5FileAssimilator: Waiting for {} distributed tasks to complete...",
-         futures.size());
-    for (size_t i = 0; i < futures.size(); ++i) {
-      CHI_CO_AWAIT(futures[i]);  // Yield coroutine, allow other tasks to run
-      if (futures[i]->result_code_ != 0) {
-        HLOG(kError, "Hdf5FileAssimilator: Dataset {} failed (error: {})",
-             filtered_paths[i], futures[i]->result_code_);
-        total_errors++;
-      } else {
-        HLOG(kDebug, "Hdf5FileAssimilator: Dataset {} completed successfully",
-             filtered_paths[i]);
-      }
-    }
-  } else {
-    // Single node mode: process locally
-    // Re-open the file for local processing
-    file_id = OpenHdf5File(src_path);
-    if (file_id < 0) {
-      HLOG(kError,
-           "Hdf5FileAssimilator: Failed to re-open HDF5 file for local "
-           "processing");
-      error_code = -8;
-      CHI_CO_RETURN;
-    }
-
-    for (size_t i = 0; i < filtered_paths.size(); ++i) {
-      const auto& dataset_path = filtered_paths[i];
-      HLOG(kDebug, "Hdf5FileAssimilator: Processing dataset {}/{}: '{}'", i + 1,
-           filtered_paths.size(), dataset_path);
-      int result = 0;
-      CHI_CO_AWAIT(ProcessDataset(file_id, dataset_path, tag_prefix, result));
-      if (result != 0) {
-        HLOG(kError,
-             "Hdf5FileAssimilator: Failed to process dataset '{}' (error code: "
-             "{})",
-             dataset_path, result);
-        total_errors++;
-      } else {
-        HLOG(kDebug, "Hdf5FileAssimilator: Successfully processed dataset '{}'",
-             dataset_path);
-      }
-    }
-
-    HLOG(kDebug, "Hdf5FileAssimilator: Closing HDF5 file...");
-    CloseHdf5File(file_id);
-  }
+  CHI_CO_AWAIT(DispatchDatasets(src_path, tag_prefix, filtered_paths,
+                                dataset_sizes, ctx.raw_chunks, ctx.lazy,
+                                ctx.lazy_cache, num_nodes, total_errors));
 
   HLOG(kDebug, "Hdf5FileAssimilator: HDF5 file closed");
 
@@ -397,7 +333,8 @@ int Hdf5FileAssimilator::DiscoverDatasets(
 
 chi::TaskResume Hdf5FileAssimilator::ProcessDataset(
     hid_t file_id, const std::string& dataset_path,
-    const std::string& tag_prefix, int& error_code) {
+    const std::string& tag_prefix, int& error_code, bool raw_chunks,
+    bool lazy, bool lazy_cache) {
 #ifdef __NVCOMPILER
   thread_local chi::RunContext _fb_rctx;
   chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
@@ -409,7 +346,7 @@ chi::TaskResume Hdf5FileAssimilator::ProcessDataset(
 
   // Open dataset
   HLOG(kDebug, "ProcessDataset: Opening dataset '{}'...", dataset_path);
-  hid_t dataset_id = H5Dopen2(file_id, dataset_path.c_str(), H5P_DEFAULT);
+  hid_t dataset_id = OpenDataset(file_id, dataset_path);
   if (dataset_id < 0) {
     HLOG(kError, "Hdf5FileAssimilator: Failed to open dataset '{}'",
          dataset_path);
@@ -530,153 +467,651 @@ chi::TaskResume Hdf5FileAssimilator::ProcessDataset(
   HLOG(kDebug, "Hdf5FileAssimilator: Stored description for '{}': {}", tag_name,
        description);
 
-  // Define chunking parameters
   // Note: kMaxChunkSize must be < 2MB due to hermes_shm MultiProcessAllocator
   // thread_unit_ limit (2MB). Using 1.5MB to leave room for allocator overhead.
   static constexpr size_t kMaxChunkSize = 1536 * 1024;  // 1.5 MB
-  static constexpr size_t kMaxParallelTasks = 32;
 
-  // Calculate number of chunks
-  size_t num_chunks = (total_bytes + kMaxChunkSize - 1) / kMaxChunkSize;
-  HLOG(kDebug,
-       "ProcessDataset: Starting data transfer - total_bytes: {}, num_chunks: "
-       "{}, kMaxChunkSize: {}",
-       total_bytes, num_chunks, kMaxChunkSize);
+  int transfer_result = 0;
+  size_t num_chunks = 0;
+  if (raw_chunks && CanPassRawChunks(dataset_id, kMaxChunkSize)) {
+    // Filtered chunks are stored as-is, described by the "raw_index" blob
+    std::vector<std::vector<hsize_t>> offsets;
+    std::vector<size_t> sizes;
+    std::vector<hsize_t> addrs;
+    std::string index =
+        DescribeRawChunks(dataset_id, rank, offsets, sizes, addrs);
+    auto index_buffer = CHI_IPC->AllocateBuffer(index.size());
+    std::memcpy(index_buffer.ptr_, index.data(), index.size());
+    auto index_task =
+        cte_client_->AsyncPutBlob(tag_id, "raw_index", 0, index.size(),
+                                  index_buffer.shm_.template Cast<void>(),
+                                  1.0f, wrp_cte::core::Context(), 0);
+    CHI_CO_AWAIT(index_task);
+    CHI_IPC->FreeBuffer(index_buffer);
+    if (index_task->return_code_ != 0) {
+      HLOG(kError,
+           "Hdf5FileAssimilator: Failed to store chunk index for dataset "
+           "'{}', return_code: {}",
+           dataset_path, index_task->return_code_);
+      H5Tclose(datatype_id);
+      H5Sclose(dataspace_id);
+      H5Dclose(dataset_id);
+      error_code = -6;
+      CHI_CO_RETURN;
+    }
 
-  // Allocate buffer for reading entire dataset using malloc (not IPC allocator)
-  // This avoids the 2MB allocator limit for HDF5 read operations
-  HLOG(kDebug,
-       "ProcessDataset: Allocating read buffer of size: {} bytes (malloc)",
-       total_bytes);
-  char* dataset_buffer = static_cast<char*>(malloc(total_bytes));
-  if (!dataset_buffer) {
-    HLOG(kError,
-         "Hdf5FileAssimilator: Failed to allocate {} bytes for dataset '{}'",
-         total_bytes, dataset_path);
-    H5Tclose(datatype_id);
-    H5Sclose(dataspace_id);
-    H5Dclose(dataset_id);
-    error_code = -7;
-    CHI_CO_RETURN;
+    HLOG(kDebug, "ProcessDataset: Passing {} raw chunks through",
+         offsets.size());
+    num_chunks = sizes.size();
+    hsize_t base = 0;
+    std::string src_path = lazy ? GetStubSource(file_id, base) : "";
+    if (!src_path.empty()) {
+      // Stored chunks are already the raw_chunk_N bytes; point stubs at them
+      for (hsize_t& addr : addrs) {
+        addr += base;
+      }
+      CHI_CO_AWAIT(RegisterStubs(tag_id, "raw_chunk_", src_path, addrs, sizes,
+                                 lazy_cache, transfer_result));
+    } else {
+      BlobReader reader = [&](size_t i, char* buffer) {
+        uint32_t filter_mask = 0;
+        return H5Dread_chunk(dataset_id, H5P_DEFAULT, offsets[i].data(),
+                             &filter_mask, buffer) >= 0;
+      };
+      CHI_CO_AWAIT(PutBlobWindow(tag_id, "raw_chunk_", sizes, reader,
+                                 transfer_result));
+    }
+  } else {
+    // Stream hyperslabs aligned to the native chunks; blob sizes follow
+    // from the plan and the reader walks the same slabs in order
+    SlabPlan plan = PlanSlabs(dims, GetChunkDims(dataset_id, rank), type_size,
+                              kMaxChunkSize);
+    std::vector<size_t> sizes;
+    std::vector<hsize_t> start(dims.size(), 0);
+    if (total_bytes > 0) {
+      do {
+        size_t slab_elements = 1;
+        for (hsize_t count : SlabCount(dims, plan, start)) {
+          slab_elements *= count;
+        }
+        sizes.push_back(slab_elements * type_size);
+      } while (NextSlab(dims, plan, start));
+    }
+    HLOG(kDebug,
+         "ProcessDataset: Streaming {} bytes as {} slab(s) split along "
+         "dimension {} ({} rows each)",
+         total_bytes, sizes.size(), plan.split_dim_, plan.rows_);
+
+    num_chunks = sizes.size();
+    hsize_t base = 0;
+    haddr_t addr = lazy ? GetContiguousAddress(dataset_id, datatype_id)
+                        : HADDR_UNDEF;
+    std::string src_path =
+        addr != HADDR_UNDEF ? GetStubSource(file_id, base) : "";
+    if (!src_path.empty()) {
+      // Slabs concatenate in row-major order, as a contiguous layout stores
+      // them, so each chunk_N stub starts where the previous one ends. The
+      // dataset offset already counts the userblock.
+      std::vector<hsize_t> offsets(sizes.size());
+      hsize_t offset = static_cast<hsize_t>(addr);
+      for (size_t i = 0; i < sizes.size(); ++i) {
+        offsets[i] = offset;
+        offset += sizes[i];
+      }
+      CHI_CO_AWAIT(RegisterStubs(tag_id, "chunk_", src_path, offsets, sizes,
+                                 lazy_cache, transfer_result));
+    } else {
+      std::vector<hsize_t> cursor(dims.size(), 0);
+      BlobReader reader = [&](size_t, char* buffer) {
+        bool ok = ReadSlab(dataset_id, datatype_id, cursor,
+                           SlabCount(dims, plan, cursor), buffer);
+        NextSlab(dims, plan, cursor);
+        return ok;
+      };
+      CHI_CO_AWAIT(
+          PutBlobWindow(tag_id, "chunk_", sizes, reader, transfer_result));
+    }
   }
 
-  // Read the entire dataset in one H5Dread call
-  HLOG(kDebug, "ProcessDataset: Reading entire dataset with H5Dread...");
-  herr_t read_status = H5Dread(dataset_id, datatype_id, H5S_ALL, H5S_ALL,
-                               H5P_DEFAULT, dataset_buffer);
-  if (read_status < 0) {
-    HLOG(kError, "Hdf5FileAssimilator: H5Dread failed for dataset '{}'",
-         dataset_path);
-    free(dataset_buffer);
+  if (transfer_result != 0) {
+    HLOG(kError,
+         "Hdf5FileAssimilator: Failed to transfer dataset '{}' (error: {})",
+         dataset_path, transfer_result);
     H5Tclose(datatype_id);
     H5Sclose(dataspace_id);
     H5Dclose(dataset_id);
-    error_code = -8;
+    error_code = transfer_result;
     CHI_CO_RETURN;
   }
-  HLOG(kDebug, "ProcessDataset: Dataset read successfully ({} bytes)",
-       total_bytes);
 
-  // Process data in chunks and send to CTE
-  size_t chunk_idx = 0;
-  size_t bytes_processed = 0;
-  std::vector<chi::Future<wrp_cte::core::PutBlobTask>> active_tasks;
+  HLOG(kDebug, "ProcessDataset: All tasks completed, cleaning up resources...");
+  H5Tclose(datatype_id);
+  HLOG(kDebug, "ProcessDataset: Datatype closed");
+  H5Sclose(dataspace_id);
+  HLOG(kDebug, "ProcessDataset: Dataspace closed");
+  H5Dclose(dataset_id);
+  HLOG(kDebug, "ProcessDataset: Dataset closed");
 
-  HLOG(kDebug, "ProcessDataset: Starting chunk transfer loop...");
-  while (bytes_processed < total_bytes) {
-    HLOG(kDebug,
-         "ProcessDataset: Loop iteration - bytes_processed: {}/{}, "
-         "active_tasks: {}",
-         bytes_processed, total_bytes, active_tasks.size());
-
-    // Submit tasks up to the parallel limit
-    while (active_tasks.size() < kMaxParallelTasks &&
-           bytes_processed < total_bytes) {
-      size_t current_chunk_size =
-          std::min(kMaxChunkSize, total_bytes - bytes_processed);
-
-      // Create blob name with chunk index
-      std::string blob_name = "chunk_" + std::to_string(chunk_idx);
-      HLOG(kDebug,
-           "ProcessDataset: Creating blob '{}' with size: {} bytes (chunk "
-           "{}/{})",
-           blob_name, current_chunk_size, chunk_idx + 1, num_chunks);
+  HLOG(kDebug,
+       "Hdf5FileAssimilator: Successfully transferred {} chunk(s) ({} bytes) "
+       "for dataset '{}'",
+       num_chunks, total_bytes, tag_name);
+  HLOG(kDebug, "ProcessDataset: EXIT - success");
 
-      // Allocate IPC buffer for this chunk and copy data
-      auto chunk_buffer = CHI_IPC->AllocateBuffer(current_chunk_size);
-      std::memcpy(chunk_buffer.ptr_, dataset_buffer + bytes_processed,
-                  current_chunk_size);
+  error_code = 0;
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
 
-      // Submit PutBlob task asynchronously
-      auto task =
-          cte_client_->AsyncPutBlob(tag_id, blob_name, 0, current_chunk_size,
-                                    chunk_buffer.shm_.template Cast<void>(),
-                                    1.0f, wrp_cte::core::Context(), 0);
+hid_t Hdf5FileAssimilator::OpenDataset(hid_t file_id,
+                                       const std::string& dataset_path) {
+  hid_t dataset_id = H5Dopen2(file_id, dataset_path.c_str(), H5P_DEFAULT);
+  if (dataset_id < 0) {
+    return dataset_id;
+  }
+  hid_t space_id = H5Dget_space(dataset_id);
+  int rank = space_id >= 0 ? H5Sget_simple_extent_ndims(space_id) : -1;
+  std::vector<hsize_t> dims(rank > 0 ? rank : 0);
+  if (rank > 0) {
+    H5Sget_simple_extent_dims(space_id, dims.data(), nullptr);
+  }
+  if (space_id >= 0) {
+    H5Sclose(space_id);
+  }
+  std::vector<hsize_t> chunk_dims = GetChunkDims(dataset_id, rank);
+  if (chunk_dims.empty()) {
+    return dataset_id;
+  }
 
-      active_tasks.push_back(task);
+  // Slabs never cross a chunk row along the first dimension, so caching
+  // one row decodes every chunk once
+  hid_t type_id = H5Dget_type(dataset_id);
+  size_t chunk_bytes = type_id >= 0 ? H5Tget_size(type_id) : 0;
+  if (type_id >= 0) {
+    H5Tclose(type_id);
+  }
+  size_t row_chunks = 1;
+  for (int i = 0; i < rank; ++i) {
+    chunk_bytes *= chunk_dims[i];
+    if (i > 0) {
+      row_chunks *= (dims[i] + chunk_dims[i] - 1) / chunk_dims[i];
+    }
+  }
+  size_t cache_bytes = std::min(chunk_bytes * row_chunks, kMaxChunkCacheBytes);
+  if (cache_bytes <= kDefaultChunkCacheBytes) {
+    return dataset_id;
+  }
+  size_t slots = std::max<size_t>(521, 10 * (cache_bytes / chunk_bytes) + 1);
+  hid_t dapl = H5Pcreate(H5P_DATASET_ACCESS);
+  H5Pset_chunk_cache(dapl, slots, cache_bytes, H5D_CHUNK_CACHE_W0_DEFAULT);
+  hid_t cached_id = H5Dopen2(file_id, dataset_path.c_str(), dapl);
+  H5Pclose(dapl);
+  if (cached_id < 0) {
+    return dataset_id;  // Keep the default cache
+  }
+  H5Dclose(dataset_id);
+  HLOG(kDebug, "OpenDataset: '{}' opened with a {} byte chunk cache",
+       dataset_path, cache_bytes);
+  return cached_id;
+}
 
-      bytes_processed += current_chunk_size;
-      chunk_idx++;
+std::vector<hsize_t> Hdf5FileAssimilator::GetChunkDims(hid_t dataset_id,
+                                                       int rank) {
+  std::vector<hsize_t> chunk_dims;
+  if (rank <= 0) {
+    return chunk_dims;
+  }
+  hid_t dcpl = H5Dget_create_plist(dataset_id);
+  if (dcpl < 0) {
+    return chunk_dims;
+  }
+  if (H5Pget_layout(dcpl) == H5D_CHUNKED) {
+    chunk_dims.resize(rank);
+    if (H5Pget_chunk(dcpl, rank, chunk_dims.data()) != rank) {
+      chunk_dims.clear();
     }
+  }
+  H5Pclose(dcpl);
+  return chunk_dims;
+}
 
-    // Wait for at least one task to complete before continuing
-    if (!active_tasks.empty()) {
-      auto& first_task = active_tasks.front();
-      CHI_CO_AWAIT(first_task);
-
-      if (first_task->return_code_ != 0) {
-        HLOG(kError, "Hdf5FileAssimilator: PutBlob task failed with code {}",
-             first_task->return_code_);
-        CHI_IPC->FreeBuffer(first_task->blob_data_.template Cast<char>());
-        free(dataset_buffer);
-        H5Tclose(datatype_id);
-        H5Sclose(dataspace_id);
-        H5Dclose(dataset_id);
-        error_code = -9;
-        CHI_CO_RETURN;
+Hdf5FileAssimilator::SlabPlan Hdf5FileAssimilator::PlanSlabs(
+    const std::vector<hsize_t>& dims, const std::vector<hsize_t>& chunk_dims,
+    size_t type_size, size_t max_bytes) {
+  SlabPlan plan;
+  if (dims.empty()) {
+    return plan;  // A scalar is one slab
+  }
+  // Walk outward while whole slabs of the inner dimensions still fit
+  int dim = static_cast<int>(dims.size()) - 1;
+  size_t row_bytes = std::max<size_t>(type_size, 1);
+  while (dim > 0 && row_bytes * dims[dim] <= max_bytes) {
+    row_bytes *= dims[dim];
+    --dim;
+  }
+  hsize_t rows = std::max<hsize_t>(1, max_bytes / row_bytes);
+  rows = std::min<hsize_t>(rows, std::max<hsize_t>(dims[dim], 1));
+
+  // Align to the native chunks: whole chunks per slab, or a divisor of
+  // the chunk extent so no slab straddles a chunk boundary
+  if (!chunk_dims.empty() && chunk_dims[dim] > 0 && rows < dims[dim]) {
+    hsize_t chunk_rows = chunk_dims[dim];
+    if (rows >= chunk_rows) {
+      rows -= rows % chunk_rows;
+    } else {
+      while (chunk_rows % rows != 0) {
+        --rows;
       }
+    }
+  }
+  plan.split_dim_ = dim;
+  plan.rows_ = rows;
+  return plan;
+}
+
+std::vector<hsize_t> Hdf5FileAssimilator::SlabCount(
+    const std::vector<hsize_t>& dims, const SlabPlan& plan,
+    const std::vector<hsize_t>& start) {
+  std::vector<hsize_t> count(dims.size(), 1);
+  for (int i = plan.split_dim_ + 1; i < static_cast<int>(dims.size()); ++i) {
+    count[i] = dims[i];
+  }
+  if (plan.split_dim_ >= 0) {
+    int dim = plan.split_dim_;
+    count[dim] = std::min(plan.rows_, dims[dim] - start[dim]);
+  }
+  return count;
+}
 
-      CHI_IPC->FreeBuffer(first_task->blob_data_.template Cast<char>());
-      active_tasks.erase(active_tasks.begin());
+bool Hdf5FileAssimilator::NextSlab(const std::vector<hsize_t>& dims,
+                                   const SlabPlan& plan,
+                                   std::vector<hsize_t>& start) {
+  if (plan.split_dim_ < 0) {
+    return false;
+  }
+  int dim = plan.split_dim_;
+  start[dim] += plan.rows_;
+  if (start[dim] < dims[dim]) {
+    return true;
+  }
+  // Carry into the outer dimensions
+  start[dim] = 0;
+  for (int i = dim - 1; i >= 0; --i) {
+    if (++start[i] < dims[i]) {
+      return true;
     }
+    start[i] = 0;
   }
+  return false;
+}
 
-  // Wait for all remaining tasks to complete
-  HLOG(kDebug, "ProcessDataset: Waiting for {} remaining tasks to complete...",
-       active_tasks.size());
-  for (auto& task : active_tasks) {
-    CHI_CO_AWAIT(task);
-    if (task->return_code_ != 0) {
-      HLOG(kError, "Hdf5FileAssimilator: PutBlob task failed with code {}",
-           task->return_code_);
-      CHI_IPC->FreeBuffer(task->blob_data_.template Cast<char>());
-      free(dataset_buffer);
-      H5Tclose(datatype_id);
-      H5Sclose(dataspace_id);
-      H5Dclose(dataset_id);
-      error_code = -10;
-      CHI_CO_RETURN;
+bool Hdf5FileAssimilator::ReadSlab(hid_t dataset_id, hid_t datatype_id,
+                                   const std::vector<hsize_t>& start,
+                                   const std::vector<hsize_t>& count,
+                                   char* buffer) {
+  if (start.empty()) {
+    return H5Dread(dataset_id, datatype_id, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+                   buffer) >= 0;
+  }
+  hid_t file_space = H5Dget_space(dataset_id);
+  if (file_space < 0) {
+    return false;
+  }
+  hsize_t num_elements = 1;
+  for (hsize_t c : count) {
+    num_elements *= c;
+  }
+  hid_t mem_space = H5Screate_simple(1, &num_elements, nullptr);
+  herr_t status = H5Sselect_hyperslab(file_space, H5S_SELECT_SET,
+                                      start.data(), nullptr, count.data(),
+                                      nullptr);
+  if (status >= 0 && mem_space >= 0) {
+    status = H5Dread(dataset_id, datatype_id, mem_space, file_space,
+                     H5P_DEFAULT, buffer);
+  }
+  if (mem_space >= 0) {
+    H5Sclose(mem_space);
+  }
+  H5Sclose(file_space);
+  return status >= 0 && mem_space >= 0;
+}
+
+bool Hdf5FileAssimilator::CanPassRawChunks(hid_t dataset_id,
+                                           size_t max_bytes) {
+  hid_t dcpl = H5Dget_create_plist(dataset_id);
+  if (dcpl < 0) {
+    return false;
+  }
+  bool filtered =
+      H5Pget_layout(dcpl) == H5D_CHUNKED && H5Pget_nfilters(dcpl) > 0;
+  H5Pclose(dcpl);
+  if (!filtered) {
+    return false;
+  }
+  // Older HDF5 releases reject H5S_ALL here, so pass the dataspace
+  hid_t space_id = H5Dget_space(dataset_id);
+  hsize_t num_chunks = 0;
+  bool fits = space_id >= 0 &&
+              H5Dget_num_chunks(dataset_id, space_id, &num_chunks) >= 0 &&
+              num_chunks > 0;
+  for (hsize_t i = 0; fits && i < num_chunks; ++i) {
+    hsize_t size = 0;
+    fits = H5Dget_chunk_info(dataset_id, space_id, i, nullptr, nullptr,
+                             nullptr, &size) >= 0 &&
+           size > 0 && size <= max_bytes;
+  }
+  if (space_id >= 0) {
+    H5Sclose(space_id);
+  }
+  return fits;
+}
+
+std::string Hdf5FileAssimilator::DescribeRawChunks(
+    hid_t dataset_id, int rank, std::vector<std::vector<hsize_t>>& offsets,
+    std::vector<size_t>& sizes, std::vector<hsize_t>& addrs) {
+  std::ostringstream index;
+  index << "chunk";
+  for (hsize_t extent : GetChunkDims(dataset_id, rank)) {
+    index << " " << extent;
+  }
+  index << "\n";
+
+  // The filter pipeline, with the client data a reader needs to decode
+  hid_t dcpl = H5Dget_create_plist(dataset_id);
+  int num_filters = dcpl >= 0 ? H5Pget_nfilters(dcpl) : 0;
+  for (int f = 0; f < num_filters; ++f) {
+    unsigned int flags = 0;
+    unsigned int cd_values[16] = {0};
+    size_t cd_nelmts = 16;
+    char name[64] = {0};
+    unsigned int config = 0;
+    H5Z_filter_t id = H5Pget_filter2(dcpl, f, &flags, &cd_nelmts, cd_values,
+                                     sizeof(name), name, &config);
+    index << "filter " << id << " " << name;
+    for (size_t v = 0; v < std::min<size_t>(cd_nelmts, 16); ++v) {
+      index << " " << cd_values[v];
     }
-    CHI_IPC->FreeBuffer(task->blob_data_.template Cast<char>());
+    index << "\n";
+  }
+  if (dcpl >= 0) {
+    H5Pclose(dcpl);
   }
 
-  HLOG(kDebug, "ProcessDataset: All tasks completed, cleaning up resources...");
-  free(dataset_buffer);
-  HLOG(kDebug, "ProcessDataset: Buffer freed");
-  H5Tclose(datatype_id);
-  HLOG(kDebug, "ProcessDataset: Datatype closed");
-  H5Sclose(dataspace_id);
-  HLOG(kDebug, "ProcessDataset: Dataspace closed");
-  H5Dclose(dataset_id);
-  HLOG(kDebug, "ProcessDataset: Dataset closed");
+  hid_t space_id = H5Dget_space(dataset_id);
+  hsize_t num_chunks = 0;
+  H5Dget_num_chunks(dataset_id, space_id, &num_chunks);
+  offsets.assign(num_chunks, std::vector<hsize_t>(rank));
+  sizes.assign(num_chunks, 0);
+  addrs.assign(num_chunks, 0);
+  for (hsize_t i = 0; i < num_chunks; ++i) {
+    unsigned int filter_mask = 0;
+    haddr_t addr = 0;
+    hsize_t size = 0;
+    H5Dget_chunk_info(dataset_id, space_id, i, offsets[i].data(),
+                      &filter_mask, &addr, &size);
+    sizes[i] = static_cast<size_t>(size);
+    addrs[i] = static_cast<hsize_t>(addr);
+    index << "raw_chunk_" << i << " offset";
+    for (hsize_t coord : offsets[i]) {
+      index << " " << coord;
+    }
+    index << " mask " << filter_mask << " size " << size << "\n";
+  }
+  if (space_id >= 0) {
+    H5Sclose(space_id);
+  }
+  return index.str();
+}
 
-  HLOG(kDebug,
-       "Hdf5FileAssimilator: Successfully transferred {} chunk(s) ({} bytes) "
-       "for dataset '{}'",
-       num_chunks, total_bytes, tag_name);
-  HLOG(kDebug, "ProcessDataset: EXIT - success");
+haddr_t Hdf5FileAssimilator::GetContiguousAddress(hid_t dataset_id,
+                                                  hid_t datatype_id) {
+  if (H5Tdetect_class(datatype_id, H5T_VLEN) != 0 ||
+      H5Tis_variable_str(datatype_id) != 0) {
+    return HADDR_UNDEF;  // The file holds heap references, not the values
+  }
+  hid_t dcpl = H5Dget_create_plist(dataset_id);
+  if (dcpl < 0) {
+    return HADDR_UNDEF;
+  }
+  bool plain = H5Pget_layout(dcpl) == H5D_CONTIGUOUS &&
+               H5Pget_nfilters(dcpl) == 0 && H5Pget_external_count(dcpl) == 0;
+  H5Pclose(dcpl);
+  return plain ? H5Dget_offset(dataset_id) : HADDR_UNDEF;
+}
+
+std::string Hdf5FileAssimilator::GetStubSource(hid_t file_id, hsize_t& base) {
+  base = 0;
+  ssize_t len = H5Fget_name(file_id, nullptr, 0);
+  if (len <= 0) {
+    return "";
+  }
+  std::string name(static_cast<size_t>(len) + 1, '\0');
+  H5Fget_name(file_id, name.data(), name.size());
+  name.resize(static_cast<size_t>(len));
+  hid_t fcpl = H5Fget_create_plist(file_id);
+  if (fcpl < 0 || H5Pget_userblock(fcpl, &base) < 0) {
+    base = 0;
+  }
+  if (fcpl >= 0) {
+    H5Pclose(fcpl);
+  }
+  // CTE opens the path on whichever node owns the blob
+  std::error_code ec;
+  std::filesystem::path path = std::filesystem::absolute(name, ec);
+  return ec ? name : path.string();
+}
+
+chi::TaskResume Hdf5FileAssimilator::RegisterStubs(
+    const chi::UniqueId& tag_id, const std::string& prefix,
+    const std::string& src_path, const std::vector<hsize_t>& offsets,
+    const std::vector<size_t>& sizes, bool cache, int& error_code) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  error_code = 0;
+  chi::u32 flags = cache ? wrp_cte::core::kBlobStubCache : 0;
+  size_t next = 0;
+  std::vector<chi::Future<wrp_cte::core::RegisterBlobStubTask>> active_tasks;
+  while (next < sizes.size() || !active_tasks.empty()) {
+    while (error_code == 0 && next < sizes.size() &&
+           active_tasks.size() < kMaxParallelTasks) {
+      active_tasks.push_back(cte_client_->AsyncRegisterBlobStub(
+          tag_id, prefix + std::to_string(next), src_path, offsets[next],
+          sizes[next], 1.0f, flags));
+      ++next;
+    }
+    if (active_tasks.empty()) {
+      break;
+    }
+    auto& first_task = active_tasks.front();
+    CHI_CO_AWAIT(first_task);
+    if (first_task->return_code_ != 0 && error_code == 0) {
+      HLOG(kError, "Hdf5FileAssimilator: RegisterBlobStub failed with code {}",
+           first_task->return_code_);
+      error_code = -10;
+      next = sizes.size();  // Stop registering, but drain the window
+    }
+    active_tasks.erase(active_tasks.begin());
+  }
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
 
+chi::TaskResume Hdf5FileAssimilator::PutBlobWindow(
+    const chi::UniqueId& tag_id, const std::string& prefix,
+    const std::vector<size_t>& sizes, const BlobReader& reader,
+    int& error_code) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  CHI_TASK_BODY_BEGIN
   error_code = 0;
+  size_t next = 0;
+  std::vector<chi::Future<wrp_cte::core::PutBlobTask>> active_tasks;
+  while (next < sizes.size() || !active_tasks.empty()) {
+    // Read and submit blobs until the window is full
+    while (error_code == 0 && next < sizes.size() &&
+           active_tasks.size() < kMaxParallelTasks) {
+      auto buffer = CHI_IPC->AllocateBuffer(sizes[next]);
+      if (buffer.IsNull()) {
+        HLOG(kError, "Hdf5FileAssimilator: Failed to allocate {} bytes",
+             sizes[next]);
+        error_code = -7;
+        break;
+      }
+      // H5Dread blocks for the whole slab; run it off the worker so the
+      // PutBlobs already in flight keep completing
+      bool read_ok = false;
+      char* dst = buffer.ptr_;
+      CHI_CO_AWAIT(
+          chi::RunBlocking([&]() { read_ok = reader(next, dst); }));
+      if (!read_ok) {
+        HLOG(kError, "Hdf5FileAssimilator: Failed to read blob {}{}", prefix,
+             next);
+        CHI_IPC->FreeBuffer(buffer);
+        error_code = -8;
+        break;
+      }
+      std::string blob_name = prefix + std::to_string(next);
+      active_tasks.push_back(cte_client_->AsyncPutBlob(
+          tag_id, blob_name, 0, sizes[next],
+          buffer.shm_.template Cast<void>(), 1.0f, wrp_cte::core::Context(),
+          0));
+      ++next;
+    }
+    if (error_code != 0) {
+      next = sizes.size();  // Stop reading, but drain the window
+    }
+    if (active_tasks.empty()) {
+      break;
+    }
+
+    // Free the oldest slot before reading the next blob
+    auto& first_task = active_tasks.front();
+    CHI_CO_AWAIT(first_task);
+    if (first_task->return_code_ != 0 && error_code == 0) {
+      HLOG(kError, "Hdf5FileAssimilator: PutBlob task failed with code {}",
+           first_task->return_code_);
+      error_code = -9;
+    }
+    CHI_IPC->FreeBuffer(first_task->blob_data_.template Cast<char>());
+    active_tasks.erase(active_tasks.begin());
+  }
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+void Hdf5FileAssimilator::OrderLargestFirst(hid_t file_id,
+                                            std::vector<std::string>& paths,
+                                            std::vector<hsize_t>& sizes) {
+  std::vector<std::pair<hsize_t, std::string>> order;
+  order.reserve(paths.size());
+  for (auto& path : paths) {
+    hsize_t size = 0;
+    hid_t dataset_id = H5Dopen2(file_id, path.c_str(), H5P_DEFAULT);
+    if (dataset_id >= 0) {
+      size = H5Dget_storage_size(dataset_id);
+      H5Dclose(dataset_id);
+    }
+    order.emplace_back(size, std::move(path));
+  }
+  std::stable_sort(
+      order.begin(), order.end(),
+      [](const auto& a, const auto& b) { return a.first > b.first; });
+  sizes.resize(order.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    sizes[i] = order[i].first;
+    paths[i] = std::move(order[i].second);
+  }
+}
+
+chi::TaskResume Hdf5FileAssimilator::DispatchDatasets(
+    const std::string& src_path, const std::string& tag_prefix,
+    const std::vector<std::string>& datasets, const std::vector<hsize_t>& sizes,
+    bool raw_chunks, bool lazy, bool lazy_cache, size_t num_nodes,
+    int& total_errors) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  total_errors = 0;
+  // Do NOT use WRP_CAE_CLIENT global singleton as it may not be properly
+  // initialized with the correct pool_id from the runtime's compose config
+  wrp_cae::core::Client cae_client(kCaePoolId);
+  struct Inflight {
+    size_t index_;
+    size_t node_;
+    chi::Future<ProcessHdf5DatasetTask> future_;
+  };
+  std::vector<Inflight> active;
+  std::vector<size_t> node_load(num_nodes, 0);
+  size_t window = kMaxDatasetsPerNode * num_nodes;
+  hsize_t total_bytes = 0;
+  for (hsize_t size : sizes) {
+    total_bytes += size;
+  }
+  size_t next = 0, done = 0, reported_decile = 0;
+  hsize_t done_bytes = 0;
+  while (next < datasets.size() || !active.empty()) {
+    // Faster nodes drain their slots sooner and so pull more datasets
+    while (next < datasets.size() && active.size() < window) {
+      size_t node = std::min_element(node_load.begin(), node_load.end()) -
+                    node_load.begin();
+      auto pool_query = num_nodes > 1
+                            ? chi::PoolQuery::DirectHash(
+                                  static_cast<chi::u32>(node))
+                            : chi::PoolQuery::Local();
+      HLOG(kDebug, "Hdf5FileAssimilator: Routing dataset {}/{} '{}' to node {}",
+           next + 1, datasets.size(), datasets[next], node);
+      active.push_back({next, node,
+                        cae_client.AsyncProcessHdf5Dataset(
+                            pool_query, src_path, datasets[next], tag_prefix,
+                            raw_chunks, lazy, lazy_cache)});
+      ++node_load[node];
+      ++next;
+    }
+
+    // Reap whichever subtask finishes first
+    size_t slot = active.size();
+    while (slot == active.size()) {
+      for (size_t i = 0; i < active.size(); ++i) {
+        if (active[i].future_.IsComplete()) {
+          slot = i;
+          break;
+        }
+      }
+      if (slot == active.size()) {
+        CHI_CO_AWAIT(chi::yield(kDatasetPollUs));
+      }
+    }
+    auto& entry = active[slot];
+    CHI_CO_AWAIT(entry.future_);
+    if (entry.future_->result_code_ != 0) {
+      HLOG(kError, "Hdf5FileAssimilator: Dataset {} failed (error: {})",
+           datasets[entry.index_], entry.future_->result_code_);
+      total_errors++;
+    }
+    --node_load[entry.node_];
+    done_bytes += sizes[entry.index_];
+    active.erase(active.begin() + slot);
+
+    size_t decile = ++done * 10 / datasets.size();
+    if (decile > reported_decile) {
+      reported_decile = decile;
+      HLOG(kInfo,
+           "Hdf5FileAssimilator: Progress '{}': {}/{} datasets, {}/{} bytes, "
+           "{} failed",
+           src_path, done, datasets.size(), done_bytes, total_bytes,
+           total_errors);
+    }
+  }
   CHI_CO_RETURN;
   CHI_TASK_BODY_END
 }
@@ -140,6 +140,28 @@ std::vector<wrp_cae::core::AssimilationCtx> LoadOmni(
       }
     }
 
+    // Pass filtered HDF5 chunks through without decoding them
+    if (transfer["raw_chunks"]) {
+      ctx.raw_chunks = transfer["raw_chunks"].as<bool>();
+    }
+
+    // Register HDF5 blobs as stubs over the source file, optionally cached
+    if (transfer["lazy"]) {
+      ctx.lazy = transfer["lazy"].as<bool>();
+    }
+    if (transfer["lazy_cache"]) {
+      ctx.lazy_cache = transfer["lazy_cache"].as<bool>();
+    }
+
+    // Transfer tuning: chunk size accepts suffixes such as "16MB"
+    if (transfer["chunk_size"]) {
+      ctx.chunk_size = hshm::ConfigParse::ParseSize(
+          transfer["chunk_size"].as<std::string>());
+    }
+    if (transfer["io_depth"]) {
+      ctx.io_depth = transfer["io_depth"].as<unsigned>();
+    }
+
     contexts.push_back(ctx);
 
     HLOG(kInfo, "  Loaded transfer {}/{}: ", (i + 1), transfers.size());
@@ -72,6 +72,7 @@
 
 // Logging
 #include <hermes_shm/util/logging.h>
+#include <hermes_shm/util/config_parse.h>
 
 // Test configuration
 constexpr size_t kDefaultFileSizeMB = 256;
@@ -174,6 +175,10 @@ std::vector<wrp_cae::core::AssimilationCtx> LoadOmni(const std::string& omni_pat
     ctx.depends_on = transfer["depends_on"] ? transfer["depends_on"].as<std::string>() : "";
     ctx.range_off = transfer["range_off"] ? transfer["range_off"].as<size_t>() : 0;
     ctx.range_size = transfer["range_size"] ? transfer["range_size"].as<size_t>() : 0;
+    if (transfer["chunk_size"]) {
+      ctx.chunk_size = hshm::ConfigParse::ParseSize(transfer["chunk_size"].as<std::string>());
+    }
+    ctx.io_depth = transfer["io_depth"] ? transfer["io_depth"].as<unsigned>() : 0;
 
     contexts.push_back(ctx);
 
@@ -340,6 +345,21 @@ int main(int argc, char* argv[]) {
       } else {
         HLOG(kSuccess, "Tag size matches file size - data verified in CTE");
       }
+
+      // The OMNI file sets chunk_size, so expect that many chunk blobs
+      // plus the description blob
+      size_t chunk_size = contexts[0].chunk_size;
+      size_t expected_blobs = (file_size_bytes + chunk_size - 1) / chunk_size + 1;
+      auto blobs_task = cte_client->AsyncGetContainedBlobs(tag_id);
+      blobs_task.Wait();
+      size_t num_blobs = blobs_task->blob_names_.size();
+      if (num_blobs != expected_blobs) {
+        HLOG(kError, "Expected {} blobs for chunk size {}, found {}",
+             expected_blobs, chunk_size, num_blobs);
+        exit_code = 1;
+      } else {
+        HLOG(kSuccess, "Found {} blobs for chunk size {}", num_blobs, chunk_size);
+      }
     }
 
     // Step 9: Cleanup
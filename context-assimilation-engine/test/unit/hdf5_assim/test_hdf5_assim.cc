@@ -171,6 +171,29 @@ bool GenerateTestHDF5File(const std::string& file_path) {
     HLOG(kInfo, "Created /group/nested_dataset: nested 1D array of 30 integers");
   }
 
+  // Dataset 5: /chunked_dataset - 2D chunked array (600x1000) of floats,
+  // large enough to be streamed as several chunk-aligned hyperslabs
+  {
+    hsize_t dims[2] = {600, 1000};
+    hsize_t chunk_dims[2] = {64, 250};
+    hid_t dataspace_id = H5Screate_simple(2, dims, NULL);
+    hid_t dcpl_id = H5Pcreate(H5P_DATASET_CREATE);
+    H5Pset_chunk(dcpl_id, 2, chunk_dims);
+    hid_t dataset_id = H5Dcreate2(file_id, "/chunked_dataset", H5T_NATIVE_FLOAT,
+                                 dataspace_id, H5P_DEFAULT, dcpl_id, H5P_DEFAULT);
+
+    std::vector<float> data(600 * 1000);
+    for (size_t i = 0; i < data.size(); ++i) {
+      data[i] = static_cast<float>(i) * 0.5f;
+    }
+    H5Dwrite(dataset_id, H5T_NATIVE_FLOAT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+
+    H5Dclose(dataset_id);
+    H5Pclose(dcpl_id);
+    H5Sclose(dataspace_id);
+    HLOG(kInfo, "Created /chunked_dataset: 2D chunked array (600x1000) of floats");
+  }
+
   H5Fclose(file_id);
   HLOG(kSuccess, "Test HDF5 file generated successfully");
   return true;
@@ -574,7 +597,8 @@ int main(int argc, char* argv[]) {
       "int_dataset",
       "double_dataset",
       "float_dataset",
-      "group/nested_dataset"
+      "group/nested_dataset",
+      "chunked_dataset"
     };
 
     HLOG(kInfo, "Expected {} datasets to be created", expected_datasets.size());
@@ -34,12 +34,67 @@
 #ifndef WRP_CEE_API_CONTEXT_INTERFACE_H_
 #define WRP_CEE_API_CONTEXT_INTERFACE_H_
 
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include <wrp_cae/core/factory/assimilation_ctx.h>
 
 namespace iowarp {
 
+/**
+ * One page of ContextQueryPage results
+ *
+ * Results are ordered by (tag name, blob name). To fetch the next page, pass
+ * next_tag/next_blob back as the cursor while has_more is true.
+ */
+struct ContextQueryResult {
+  std::vector<std::string> tag_names;   /**< Tag of each matching blob */
+  std::vector<std::string> blob_names;  /**< Matching blob names */
+  std::string next_tag;   /**< Cursor tag for the following page */
+  std::string next_blob;  /**< Cursor blob for the following page */
+  bool has_more = false;  /**< True if more matches may follow */
+};
+
+/**
+ * One blob returned by ContextRetrieveBlobs or ContextRetrieveStream
+ *
+ * data points into the shared-memory buffer the blob was read into, so no
+ * copy is made. The buffer is freed once every ContextBlob sharing owner
+ * (including Python views of it) is gone.
+ */
+struct ContextBlob {
+  std::string tag_name;   /**< Tag containing the blob */
+  std::string blob_name;  /**< Blob name */
+  char *data = nullptr;   /**< Blob contents */
+  size_t size = 0;        /**< Bytes at data */
+  std::shared_ptr<void> owner;  /**< Keeps the shared-memory buffer alive */
+};
+
+/**
+ * Streams the blobs matched by ContextRetrieveStream one batch at a time
+ *
+ * Each Next() issues the AsyncGetBlobs for one batch into a single
+ * shared-memory buffer and returns the blobs once they complete.
+ */
+class ContextStream {
+public:
+  /**
+   * Fetch the next batch of blobs
+   * @param batch Output: blobs of this batch (cleared first)
+   * @return false once every match was returned or the size budget is spent
+   */
+  bool Next(std::vector<ContextBlob> &batch);
+
+private:
+  friend class ContextInterface;
+
+  std::vector<std::pair<std::string, std::string>> matches_;  /**< Tag, blob */
+  size_t next_ = 0;          /**< Index of the next match to fetch */
+  size_t bytes_left_ = 0;    /**< Remaining max_context_size budget */
+  unsigned int batch_size_ = 32;  /**< Matches fetched per Next() */
+};
+
 /**
  * ContextInterface - High-level API for context exploration and management
  *
@@ -85,6 +140,25 @@ public:
                                          const std::string &blob_re,
                                          unsigned int max_results = 0);
 
+  /**
+   * Retrieve one page of objects matching tag and blob patterns
+   *
+   * Each container stops scanning once it has page_size matches, so
+   * exploring very large namespaces only costs one page per call.
+   *
+   * @param tag_re Tag regex pattern to match
+   * @param blob_re Blob regex pattern to match
+   * @param page_size Maximum number of results in this page (must be > 0)
+   * @param cursor_tag next_tag of the previous page ("" for the first page)
+   * @param cursor_blob next_blob of the previous page ("" for the first page)
+   * @return Page of (tag, blob) results plus the cursor for the next page
+   */
+  ContextQueryResult ContextQueryPage(const std::string &tag_re,
+                                      const std::string &blob_re,
+                                      unsigned int page_size,
+                                      const std::string &cursor_tag = "",
+                                      const std::string &cursor_blob = "");
+
   /**
    * Retrieve the identities and data of objects matching patterns
    *
@@ -107,10 +181,53 @@ public:
                                             size_t max_context_size = 256 * 1024 * 1024,
                                             unsigned int batch_size = 32);
 
+  /**
+   * Retrieve the data of objects matching patterns without packing it
+   *
+   * Like ContextRetrieve, but each blob is returned as a view into the
+   * shared-memory buffer it was read into instead of being copied into one
+   * packed string.
+   *
+   * @param tag_re Tag regex pattern to match
+   * @param blob_re Blob regex pattern to match
+   * @param max_results Maximum number of blobs to retrieve (0 = unlimited, default: 1024)
+   * @param max_context_size Maximum total size in bytes (default: 256MB)
+   * @param batch_size Number of concurrent AsyncGetBlob operations (default: 32)
+   * @return Retrieved blobs in match order (empty if none)
+   */
+  std::vector<ContextBlob> ContextRetrieveBlobs(
+      const std::string &tag_re, const std::string &blob_re,
+      unsigned int max_results = 1024,
+      size_t max_context_size = 256 * 1024 * 1024,
+      unsigned int batch_size = 32);
+
+  /**
+   * Query for objects matching patterns and stream their data in batches
+   *
+   * The query runs here; the data is fetched by ContextStream::Next().
+   *
+   * @param tag_re Tag regex pattern to match
+   * @param blob_re Blob regex pattern to match
+   * @param max_results Maximum number of blobs to retrieve (0 = unlimited, default: 1024)
+   * @param max_context_size Maximum total size in bytes (default: 256MB)
+   * @param batch_size Blobs fetched per batch (default: 32)
+   * @return Stream over the matches (empty if the query failed)
+   */
+  ContextStream ContextRetrieveStream(
+      const std::string &tag_re, const std::string &blob_re,
+      unsigned int max_results = 1024,
+      size_t max_context_size = 256 * 1024 * 1024,
+      unsigned int batch_size = 32);
+
   /**
    * Split/splice objects into a new context
    *
-   * NOTE: This functionality is not yet implemented and will be added in a future version.
+   * Creates new_ctx and links every blob matching tag_re/blob_re into it
+   * under the same blob name. Linking is metadata-only: the new blob
+   * shares the source's data blocks, and a later partial write to either
+   * copy detaches it first. Blobs whose new owner is another node are
+   * copied instead. When a single source tag matches, new_ctx follows
+   * its placement so that every blob can be linked.
    *
    * @param new_ctx Name of the new context to create
    * @param tag_re Tag regex pattern to match for source objects
@@ -36,7 +36,10 @@
 #include <wrp_cte/core/core_client.h>
 #include <wrp_cae/core/constants.h>
 #include <chimaera/chimaera.h>
+#include <algorithm>
 #include <iostream>
+#include <unordered_map>
+#include <unordered_set>
 #include <hermes_shm/util/logging.h>
 
 namespace iowarp {
@@ -165,6 +168,55 @@ std::vector<std::string> ContextInterface::ContextQuery(
   }
 }
 
+ContextQueryResult ContextInterface::ContextQueryPage(
+    const std::string &tag_re,
+    const std::string &blob_re,
+    unsigned int page_size,
+    const std::string &cursor_tag,
+    const std::string &cursor_blob) {
+  ContextQueryResult page;
+  if (page_size == 0) {
+    HLOG(kError, "ContextQueryPage requires a non-zero page_size");
+    return page;
+  }
+  if (!EnsureInitialized()) {
+    HLOG(kError, "ContextInterface failed to initialize");
+    return page;
+  }
+
+  try {
+    // Get the CTE client singleton
+    auto* cte_client = WRP_CTE_CLIENT;
+    if (!cte_client) {
+      HLOG(kError, "CTE client not initialized");
+      return page;
+    }
+
+    // Broadcast one page request; containers terminate early at page_size
+    auto task = cte_client->AsyncBlobQuery(
+        tag_re,
+        blob_re,
+        page_size,
+        chi::PoolQuery::Broadcast(),
+        cursor_tag,
+        cursor_blob);
+    task.Wait();
+
+    page.tag_names = task->tag_names_;
+    page.blob_names = task->blob_names_;
+    page.has_more = task->has_more_ && !page.tag_names.empty();
+    if (page.has_more) {
+      page.next_tag = page.tag_names.back();
+      page.next_blob = page.blob_names.back();
+    }
+    return page;
+
+  } catch (const std::exception& e) {
+    HLOG(kError, "Error in ContextQueryPage: {}", e.what());
+    return ContextQueryResult();
+  }
+}
+
 std::vector<std::string> ContextInterface::ContextRetrieve(
     const std::string &tag_re,
     const std::string &blob_re,
@@ -313,17 +365,284 @@ std::vector<std::string> ContextInterface::ContextRetrieve(
   }
 }
 
+std::vector<ContextBlob> ContextInterface::ContextRetrieveBlobs(
+    const std::string &tag_re,
+    const std::string &blob_re,
+    unsigned int max_results,
+    size_t max_context_size,
+    unsigned int batch_size) {
+  ContextStream stream = ContextRetrieveStream(
+      tag_re, blob_re, max_results, max_context_size, batch_size);
+  std::vector<ContextBlob> results;
+  std::vector<ContextBlob> batch;
+  while (stream.Next(batch)) {
+    for (auto &blob : batch) {
+      results.push_back(std::move(blob));
+    }
+  }
+  return results;
+}
+
+ContextStream ContextInterface::ContextRetrieveStream(
+    const std::string &tag_re,
+    const std::string &blob_re,
+    unsigned int max_results,
+    size_t max_context_size,
+    unsigned int batch_size) {
+  ContextStream stream;
+  if (!EnsureInitialized()) {
+    HLOG(kError, "ContextInterface failed to initialize");
+    return stream;
+  }
+
+  try {
+    auto* cte_client = WRP_CTE_CLIENT;
+    if (!cte_client) {
+      HLOG(kError, "CTE client not initialized");
+      return stream;
+    }
+
+    auto query_task = cte_client->AsyncBlobQuery(
+        tag_re,
+        blob_re,
+        max_results,
+        chi::PoolQuery::Broadcast());
+    query_task.Wait();
+
+    size_t result_count = std::min(query_task->tag_names_.size(),
+                                   query_task->blob_names_.size());
+    stream.matches_.reserve(result_count);
+    for (size_t i = 0; i < result_count; ++i) {
+      stream.matches_.emplace_back(query_task->tag_names_[i],
+                                   query_task->blob_names_[i]);
+    }
+    stream.bytes_left_ = max_context_size;
+    stream.batch_size_ = std::max(batch_size, 1u);
+    HLOG(kInfo, "ContextRetrieveStream: Found {} matching blobs",
+         stream.matches_.size());
+    return stream;
+
+  } catch (const std::exception& e) {
+    HLOG(kError, "Error in ContextRetrieveStream: {}", e.what());
+    return ContextStream();
+  }
+}
+
+bool ContextStream::Next(std::vector<ContextBlob> &batch) {
+  batch.clear();
+  auto* cte_client = WRP_CTE_CLIENT;
+  auto* ipc_manager = CHI_IPC;
+  if (!cte_client || !ipc_manager) {
+    return false;
+  }
+
+  // Loop past batches whose blobs have all disappeared since the query
+  while (batch.empty() && next_ < matches_.size() && bytes_left_ > 0) {
+    size_t batch_start = next_;
+    size_t batch_end = std::min(next_ + batch_size_, matches_.size());
+    next_ = batch_end;
+
+    // Resolve each distinct tag of the batch once, all in flight together
+    std::unordered_map<std::string, wrp_cte::core::TagId> tag_ids;
+    std::vector<std::string> tag_names;
+    for (size_t i = batch_start; i < batch_end; ++i) {
+      if (tag_ids.emplace(matches_[i].first,
+                          wrp_cte::core::TagId::GetNull()).second) {
+        tag_names.push_back(matches_[i].first);
+      }
+    }
+    std::vector<decltype(cte_client->AsyncGetOrCreateTag(""))> tag_tasks;
+    tag_tasks.reserve(tag_names.size());
+    for (const auto &tag_name : tag_names) {
+      tag_tasks.push_back(cte_client->AsyncGetOrCreateTag(tag_name));
+    }
+    for (size_t i = 0; i < tag_tasks.size(); ++i) {
+      tag_tasks[i].Wait();
+      tag_ids[tag_names[i]] = tag_tasks[i]->tag_id_;
+    }
+
+    // Then every blob size of the batch
+    std::vector<size_t> pending;
+    std::vector<chi::Future<wrp_cte::core::GetBlobSizeTask>> size_tasks;
+    for (size_t i = batch_start; i < batch_end; ++i) {
+      const wrp_cte::core::TagId &tag_id = tag_ids[matches_[i].first];
+      if (tag_id.IsNull()) {
+        HLOG(kWarning, "Failed to get tag '{}', skipping blob",
+             matches_[i].first);
+        continue;
+      }
+      pending.push_back(i);
+      size_tasks.push_back(
+          cte_client->AsyncGetBlobSize(tag_id, matches_[i].second));
+    }
+
+    // Lay the blobs that fit the budget out back to back in one buffer
+    std::vector<size_t> offsets;
+    size_t batch_bytes = 0;
+    size_t fitting = 0;  // Blobs before the first one over budget
+    bool full = false;
+    for (size_t j = 0; j < size_tasks.size(); ++j) {
+      size_tasks[j].Wait();
+      chi::u64 blob_size = size_tasks[j]->size_;
+      offsets.push_back(batch_bytes);
+      if (full) {
+        continue;
+      }
+      if (batch_bytes + blob_size > bytes_left_) {
+        HLOG(kInfo,
+             "ContextRetrieveStream: Not enough space for blob '{}' ({} "
+             "bytes), stopping",
+             matches_[pending[j]].second, blob_size);
+        next_ = matches_.size();
+        full = true;
+        continue;
+      }
+      if (blob_size == 0) {
+        HLOG(kWarning, "Blob '{}' has zero size, skipping",
+             matches_[pending[j]].second);
+      }
+      batch_bytes += blob_size;
+      fitting = j + 1;
+    }
+    if (batch_bytes == 0) {
+      continue;
+    }
+    bytes_left_ -= batch_bytes;
+
+    hipc::FullPtr<char> buffer = ipc_manager->AllocateBuffer(batch_bytes);
+    if (buffer.IsNull()) {
+      HLOG(kError, "Failed to allocate context buffer");
+      return false;
+    }
+    std::shared_ptr<void> owner(buffer.ptr_, [buffer](void *) mutable {
+      auto* ipc = CHI_IPC;
+      if (ipc) {
+        ipc->FreeBuffer(buffer);
+      }
+    });
+
+    std::vector<size_t> fetched;
+    std::vector<chi::Future<wrp_cte::core::GetBlobTask>> get_tasks;
+    for (size_t j = 0; j < fitting; ++j) {
+      chi::u64 blob_size = size_tasks[j]->size_;
+      if (blob_size == 0) {
+        continue;
+      }
+      hipc::ShmPtr<> blob_buffer_ptr;
+      blob_buffer_ptr.alloc_id_ = buffer.shm_.alloc_id_;
+      blob_buffer_ptr.off_ = buffer.shm_.off_.load() + offsets[j];
+      const auto &match = matches_[pending[j]];
+      fetched.push_back(j);
+      get_tasks.push_back(cte_client->AsyncGetBlob(
+          tag_ids[match.first], match.second, 0, blob_size, 0,
+          blob_buffer_ptr));
+    }
+    for (size_t k = 0; k < get_tasks.size(); ++k) {
+      get_tasks[k].Wait();
+      size_t j = fetched[k];
+      const auto &match = matches_[pending[j]];
+      if (get_tasks[k]->return_code_ != 0) {
+        HLOG(kWarning, "GetBlob failed for blob '{}'", match.second);
+        continue;
+      }
+      ContextBlob blob;
+      blob.tag_name = match.first;
+      blob.blob_name = match.second;
+      blob.data = buffer.ptr_ + offsets[j];
+      blob.size = size_tasks[j]->size_;
+      blob.owner = owner;
+      batch.push_back(std::move(blob));
+    }
+  }
+  return !batch.empty();
+}
+
 int ContextInterface::ContextSplice(
     const std::string &new_ctx,
     const std::string &tag_re,
     const std::string &blob_re) {
-  (void)new_ctx;  // Suppress unused parameter warning
-  (void)tag_re;   // Suppress unused parameter warning
-  (void)blob_re;  // Suppress unused parameter warning
+  if (!EnsureInitialized()) {
+    HLOG(kError, "ContextInterface failed to initialize");
+    return 1;
+  }
 
-  // Not yet implemented
-  HLOG(kWarning, "ContextSplice is not yet implemented");
-  return 1;
+  if (new_ctx.empty()) {
+    HLOG(kError, "ContextSplice requires a non-empty new_ctx");
+    return 1;
+  }
+
+  try {
+    auto* cte_client = WRP_CTE_CLIENT;
+    if (!cte_client) {
+      HLOG(kError, "CTE client not initialized");
+      return 1;
+    }
+
+    // Find the distinct source tags holding matching blobs
+    auto query_task = cte_client->AsyncBlobQuery(
+        tag_re, blob_re, 0, chi::PoolQuery::Broadcast());
+    query_task.Wait();
+    std::vector<std::string> src_tags;
+    std::unordered_set<std::string> seen;
+    for (size_t i = 0; i < query_task->tag_names_.size(); ++i) {
+      std::string tag_name = query_task->tag_names_[i];
+      if (tag_name != new_ctx && seen.insert(tag_name).second) {
+        src_tags.push_back(tag_name);
+      }
+    }
+
+    std::vector<wrp_cte::core::TagId> src_ids;
+    for (const auto &tag_name : src_tags) {
+      auto tag_task = cte_client->AsyncGetOrCreateTag(tag_name);
+      tag_task.Wait();
+      if (tag_task->tag_id_.IsNull()) {
+        HLOG(kError, "Failed to get source tag '{}'", tag_name);
+        return 1;
+      }
+      src_ids.push_back(tag_task->tag_id_);
+    }
+
+    // A single source lets the new context place its blobs wherever the
+    // source's blobs already live, so every blob can be linked in place
+    wrp_cte::core::TagPlacement placement;
+    if (src_ids.size() == 1) {
+      placement = wrp_cte::core::TagPlacement::Follow(src_ids[0]);
+    }
+    auto dst_task = cte_client->AsyncGetOrCreateTag(
+        new_ctx, wrp_cte::core::TagId::GetNull(), chi::PoolQuery::Dynamic(),
+        placement);
+    dst_task.Wait();
+    wrp_cte::core::TagId dst_id = dst_task->tag_id_;
+    if (dst_id.IsNull()) {
+      HLOG(kError, "Failed to create context '{}'", new_ctx);
+      return 1;
+    }
+
+    // Link the matching blobs of every source tag into the new context
+    int error_count = 0;
+    chi::u64 linked = 0;
+    chi::u64 copied = 0;
+    for (size_t i = 0; i < src_ids.size(); ++i) {
+      auto task = cte_client->AsyncSpliceBlobs(src_ids[i], blob_re, dst_id);
+      task.Wait();
+      if (task->return_code_ != 0) {
+        HLOG(kError, "SpliceBlobs failed for tag '{}' with code {}",
+             src_tags[i], task->return_code_);
+        ++error_count;
+        continue;
+      }
+      linked += task->blobs_linked_;
+      copied += task->blobs_copied_;
+    }
+
+    HLOG(kInfo, "ContextSplice: '{}' has {} linked and {} copied blobs",
+         new_ctx, linked, copied);
+    return error_count > 0 ? 1 : 0;
+
+  } catch (const std::exception& e) {
+    HLOG(kError, "Error in ContextSplice: {}", e.what());
+    return 1;
+  }
 }
 
 int ContextInterface::ContextDestroy(
@@ -32,6 +32,7 @@
  */
 
 #include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
 #include <nanobind/stl/string.h>
 #include <nanobind/stl/vector.h>
 #include <wrp_cee/api/context_interface.h>
@@ -74,6 +75,72 @@ NB_MODULE(wrp_cee, m) {
              "' format='" + ctx.format + "'>";
     });
 
+  // Bind ContextQueryResult struct (one page of a paginated query)
+  nb::class_<iowarp::ContextQueryResult>(m, "ContextQueryResult",
+      "One page of context_query_page results")
+    .def(nb::init<>(),
+         "Default constructor")
+    .def_rw("tag_names", &iowarp::ContextQueryResult::tag_names,
+            "Tag of each matching blob")
+    .def_rw("blob_names", &iowarp::ContextQueryResult::blob_names,
+            "Matching blob names")
+    .def_rw("next_tag", &iowarp::ContextQueryResult::next_tag,
+            "Cursor tag for the following page")
+    .def_rw("next_blob", &iowarp::ContextQueryResult::next_blob,
+            "Cursor blob for the following page")
+    .def_rw("has_more", &iowarp::ContextQueryResult::has_more,
+            "True if more matches may follow");
+
+  // Bind ContextBlob (zero-copy view of one retrieved blob)
+  nb::class_<iowarp::ContextBlob>(m, "ContextBlob",
+      "One retrieved blob, backed by the shared-memory buffer it was read into")
+    .def_ro("tag_name", &iowarp::ContextBlob::tag_name,
+            "Tag containing the blob")
+    .def_ro("blob_name", &iowarp::ContextBlob::blob_name,
+            "Blob name")
+    .def_ro("size", &iowarp::ContextBlob::size,
+            "Blob size in bytes")
+    .def_prop_ro("data", [](const iowarp::ContextBlob &blob) {
+      // The array holds its own reference to the buffer, so it stays valid
+      // after the ContextBlob is gone
+      auto *owner = new std::shared_ptr<void>(blob.owner);
+      nb::capsule capsule(owner, [](void *p) noexcept {
+        delete static_cast<std::shared_ptr<void> *>(p);
+      });
+      size_t shape[1] = {blob.size};
+      return nb::ndarray<uint8_t, nb::ndim<1>, nb::c_contig>(
+          blob.data, 1, shape, capsule);
+    },
+         "uint8 array over the blob's bytes without copying. Supports the\n"
+         "buffer protocol (memoryview, numpy.asarray) and DLPack\n"
+         "(torch.from_dlpack).")
+    .def("__len__", [](const iowarp::ContextBlob &blob) { return blob.size; })
+    .def("__repr__", [](const iowarp::ContextBlob &blob) {
+      return "<ContextBlob tag='" + blob.tag_name + "' blob='" +
+             blob.blob_name + "' size=" + std::to_string(blob.size) + ">";
+    });
+
+  // Bind ContextStream (iterator over retrieved batches)
+  nb::class_<iowarp::ContextStream>(m, "ContextStream",
+      "Iterator yielding lists of ContextBlob, one batch at a time")
+    .def("__iter__",
+         [](iowarp::ContextStream &stream) -> iowarp::ContextStream & {
+           return stream;
+         },
+         nb::rv_policy::reference)
+    .def("__next__", [](iowarp::ContextStream &stream) {
+      std::vector<iowarp::ContextBlob> batch;
+      bool more;
+      {
+        nb::gil_scoped_release release;
+        more = stream.Next(batch);
+      }
+      if (!more) {
+        throw nb::stop_iteration();
+      }
+      return batch;
+    });
+
   // Bind ContextInterface class
   // C++ uses PascalCase (Google style), Python exposes snake_case
   nb::class_<iowarp::ContextInterface>(m, "ContextInterface",
@@ -96,6 +163,18 @@ NB_MODULE(wrp_cee, m) {
          "  max_results: Maximum number of results to return (0 = unlimited, default: 0)\n\n"
          "Returns:\n"
          "  List of matching blob names")
+    .def("context_query_page", &iowarp::ContextInterface::ContextQueryPage,
+         nb::arg("tag_re"), nb::arg("blob_re"), nb::arg("page_size"),
+         nb::arg("cursor_tag") = "", nb::arg("cursor_blob") = "",
+         "Retrieve one page of objects matching tag and blob patterns\n\n"
+         "Parameters:\n"
+         "  tag_re: Tag regex pattern to match\n"
+         "  blob_re: Blob regex pattern to match\n"
+         "  page_size: Maximum number of results in this page (> 0)\n"
+         "  cursor_tag: next_tag of the previous page ('' for the first)\n"
+         "  cursor_blob: next_blob of the previous page ('' for the first)\n\n"
+         "Returns:\n"
+         "  ContextQueryResult with results and the next-page cursor")
     .def("context_retrieve", &iowarp::ContextInterface::ContextRetrieve,
          nb::arg("tag_re"), nb::arg("blob_re"),
          nb::arg("max_results") = 1024,
@@ -112,9 +191,39 @@ NB_MODULE(wrp_cee, m) {
          "  batch_size: Concurrent AsyncGetBlob operations (default: 32)\n\n"
          "Returns:\n"
          "  List with one string containing packed binary context data (empty if none)")
+    .def("context_retrieve_blobs", &iowarp::ContextInterface::ContextRetrieveBlobs,
+         nb::arg("tag_re"), nb::arg("blob_re"),
+         nb::arg("max_results") = 1024,
+         nb::arg("max_context_size") = 256 * 1024 * 1024,
+         nb::arg("batch_size") = 32,
+         nb::call_guard<nb::gil_scoped_release>(),
+         "Retrieve the data of objects matching patterns without copying it\n\n"
+         "Parameters:\n"
+         "  tag_re: Tag regex pattern to match\n"
+         "  blob_re: Blob regex pattern to match\n"
+         "  max_results: Max number of blobs (0=unlimited, default: 1024)\n"
+         "  max_context_size: Max total size in bytes (default: 256MB)\n"
+         "  batch_size: Concurrent AsyncGetBlob operations (default: 32)\n\n"
+         "Returns:\n"
+         "  List of ContextBlob; each .data is a view of shared memory")
+    .def("context_retrieve_iter", &iowarp::ContextInterface::ContextRetrieveStream,
+         nb::arg("tag_re"), nb::arg("blob_re"),
+         nb::arg("max_results") = 1024,
+         nb::arg("max_context_size") = 256 * 1024 * 1024,
+         nb::arg("batch_size") = 32,
+         nb::call_guard<nb::gil_scoped_release>(),
+         "Query for objects matching patterns and stream their data\n\n"
+         "Parameters:\n"
+         "  tag_re: Tag regex pattern to match\n"
+         "  blob_re: Blob regex pattern to match\n"
+         "  max_results: Max number of blobs (0=unlimited, default: 1024)\n"
+         "  max_context_size: Max total size in bytes (default: 256MB)\n"
+         "  batch_size: Blobs fetched per batch (default: 32)\n\n"
+         "Returns:\n"
+         "  ContextStream yielding one list of ContextBlob per batch")
     .def("context_splice", &iowarp::ContextInterface::ContextSplice,
          nb::arg("new_ctx"), nb::arg("tag_re"), nb::arg("blob_re"),
-         "Split/splice objects into a new context (NOT YET IMPLEMENTED)\n\n"
+         "Link objects matching tag and blob patterns into a new context\n\n"
          "Parameters:\n"
          "  new_ctx: Name of the new context to create\n"
          "  tag_re: Tag regex pattern to match for source objects\n"
@@ -315,6 +315,50 @@ TEST_CASE("CEE - ContextRetrieve With Max Results Limit", "[cee][retrieve][limit
   INFO("Retrieved with max_results=1: " << retrieved.size() << " contexts");
 }
 
+TEST_CASE("CEE - ContextRetrieveBlobs Zero Copy", "[cee][retrieve][blobs]") {
+  CEEComprehensiveFixture fixture;
+  fixture.SetupTestData();
+
+  ContextInterface ctx_interface;
+
+  // Bundle test data
+  std::string src_url = "file::" + fixture.test_binary_file_;
+  std::string dst_url = "iowarp::cee_blobs_test";
+
+  wrp_cae::core::AssimilationCtx ctx(src_url, dst_url, "binary");
+  std::vector<wrp_cae::core::AssimilationCtx> bundle = {ctx};
+
+  REQUIRE(ctx_interface.ContextBundle(bundle) == 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  // The blobs hold the same bytes as the packed form, in the same order
+  auto packed = ctx_interface.ContextRetrieve(
+      "cee_blobs_test", ".*", 1024, 1024 * 1024, 32);
+  auto blobs = ctx_interface.ContextRetrieveBlobs(
+      "cee_blobs_test", ".*", 1024, 1024 * 1024, 32);
+  REQUIRE(packed.size() == 1);
+  REQUIRE(!blobs.empty());
+  std::string joined;
+  for (const auto &blob : blobs) {
+    REQUIRE(blob.data != nullptr);
+    REQUIRE(blob.owner != nullptr);
+    joined.append(blob.data, blob.size);
+  }
+  REQUIRE(joined == packed[0]);
+
+  // Streaming one blob per batch yields the same blobs
+  ContextStream stream = ctx_interface.ContextRetrieveStream(
+      "cee_blobs_test", ".*", 1024, 1024 * 1024, 1);
+  std::vector<ContextBlob> batch;
+  size_t streamed = 0;
+  while (stream.Next(batch)) {
+    REQUIRE(batch.size() == 1);
+    REQUIRE(batch[0].blob_name == blobs[streamed].blob_name);
+    streamed++;
+  }
+  REQUIRE(streamed == blobs.size());
+}
+
 // ============================================================================
 // ContextBundle Enhanced Tests
 // ============================================================================
@@ -484,19 +528,60 @@ TEST_CASE("CEE - ContextDestroy Partial Failure", "[cee][destroy][partial]") {
 }
 
 // ============================================================================
-// ContextSplice Tests (stub implementation)
+// ContextSplice Tests
 // ============================================================================
 
-TEST_CASE("CEE - ContextSplice Not Implemented", "[cee][splice][stub]") {
+TEST_CASE("CEE - ContextSplice Links Blobs", "[cee][splice][link]") {
+  CEEComprehensiveFixture fixture;
+  fixture.SetupTestData();
+
+  ContextInterface ctx_interface;
+
+  // Bundle test data
+  std::string src_url = "file::" + fixture.test_binary_file_;
+  std::string dst_url = "iowarp::cee_splice_src";
+
+  wrp_cae::core::AssimilationCtx ctx(src_url, dst_url, "binary");
+  std::vector<wrp_cae::core::AssimilationCtx> bundle = {ctx};
+
+  REQUIRE(ctx_interface.ContextBundle(bundle) == 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  auto original = ctx_interface.ContextRetrieve(
+      "cee_splice_src", ".*", 1024, 1024 * 1024, 32);
+  REQUIRE(original.size() == 1);
+
+  // The new context holds the same bytes as its source
+  REQUIRE(ctx_interface.ContextSplice("cee_splice_dst", "cee_splice_src",
+                                      ".*") == 0);
+  auto spliced = ctx_interface.ContextRetrieve(
+      "cee_splice_dst", ".*", 1024, 1024 * 1024, 32);
+  REQUIRE(spliced.size() == 1);
+  REQUIRE(spliced[0] == original[0]);
+
+  // And keeps them after the source is destroyed
+  REQUIRE(ctx_interface.ContextDestroy({"cee_splice_src"}) == 0);
+  spliced = ctx_interface.ContextRetrieve(
+      "cee_splice_dst", ".*", 1024, 1024 * 1024, 32);
+  REQUIRE(spliced.size() == 1);
+  REQUIRE(spliced[0] == original[0]);
+
+  ctx_interface.ContextDestroy({"cee_splice_dst"});
+}
+
+TEST_CASE("CEE - ContextSplice No Matching Blobs", "[cee][splice][empty]") {
   CEEComprehensiveFixture fixture;
 
   ContextInterface ctx_interface;
 
-  // Call ContextSplice (should return error code 1)
-  int result = ctx_interface.ContextSplice("new_ctx", "tag_.*", "blob_.*");
+  // Nothing matches, so the new context is simply empty
+  int result = ctx_interface.ContextSplice(
+      "cee_splice_empty", "nonexistent_tag_.*", "blob_.*");
+  REQUIRE(result == 0);
+  auto blobs = ctx_interface.ContextQuery("cee_splice_empty", ".*");
+  REQUIRE(blobs.empty());
 
-  REQUIRE(result == 1);
-  INFO("ContextSplice correctly returns not-implemented error");
+  ctx_interface.ContextDestroy({"cee_splice_empty"});
 }
 
 // ============================================================================
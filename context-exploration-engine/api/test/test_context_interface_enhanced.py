@@ -326,18 +326,22 @@ def test_context_destroy():
 
 
 def test_context_splice():
-    """Test ContextInterface.context_splice (not implemented)"""
-    print("\nTest 11: ContextInterface.context_splice (stub)")
+    """Test ContextInterface.context_splice"""
+    print("\nTest 11: ContextInterface.context_splice")
 
     try:
         import wrp_cee as cee
 
         ctx_interface = cee.ContextInterface()
 
-        # Should return error code 1 (not implemented)
-        result = ctx_interface.context_splice("new_ctx", "tag_.*", "blob_.*")
-        assert result == 1, "context_splice should return 1 (not implemented)"
-        print(f"  ✅ context_splice correctly returns not-implemented (code={result})")
+        # Nothing matches, so the new context is created empty
+        result = ctx_interface.context_splice(
+            "py_splice_ctx", "nonexistent_tag_.*", "blob_.*")
+        assert result == 0, "context_splice should return 0"
+        blobs = ctx_interface.context_query("py_splice_ctx", ".*")
+        assert len(blobs) == 0, "spliced context should be empty"
+        ctx_interface.context_destroy(["py_splice_ctx"])
+        print(f"  ✅ context_splice succeeded (code={result})")
 
         return True
     except Exception as e:
@@ -418,7 +422,7 @@ def main():
         ("context_query", test_context_query),
         ("context_retrieve", test_context_retrieve),
         ("context_destroy", test_context_destroy),
-        ("context_splice (stub)", test_context_splice),
+        ("context_splice", test_context_splice),
         ("Full Python Workflow", test_python_workflow),
     ]
 
@@ -38,6 +38,7 @@
  * 1. Calling ContextQuery with various patterns
  * 2. Verifying the function completes without crashes
  * 3. Testing different regex patterns
+ * 4. Paging through results with ContextQueryPage
  *
  * Environment Variables:
  * - INIT_CHIMAERA: If set to "1", initializes Chimaera runtime
@@ -49,6 +50,7 @@
 #include <cassert>
 #include <cstring>
 #include <set>
+#include <utility>
 #include <hermes_shm/util/logging.h>
 
 /**
@@ -88,6 +90,52 @@ void test_specific_patterns() {
   HLOG(kSuccess, "PASSED: Specific patterns test");
 }
 
+/**
+ * Test that ContextQueryPage walks all results in order without duplicates
+ */
+void test_paged_query() {
+  HLOG(kInfo, "TEST: Paged query");
+
+  iowarp::ContextInterface ctx_interface;
+
+  std::vector<std::string> all = ctx_interface.ContextQuery(".*", ".*");
+
+  std::set<std::pair<std::string, std::string>> seen;
+  std::pair<std::string, std::string> prev;
+  std::string cursor_tag, cursor_blob;
+  size_t pages = 0;
+  while (true) {
+    iowarp::ContextQueryResult page = ctx_interface.ContextQueryPage(
+        ".*", ".*", 2, cursor_tag, cursor_blob);
+    assert(page.tag_names.size() == page.blob_names.size());
+    assert(page.blob_names.size() <= 2);
+    for (size_t i = 0; i < page.blob_names.size(); ++i) {
+      std::pair<std::string, std::string> key(page.tag_names[i],
+                                              page.blob_names[i]);
+      assert(seen.empty() || prev < key);
+      assert(seen.insert(key).second);
+      prev = key;
+    }
+    ++pages;
+    if (!page.has_more) {
+      break;
+    }
+    cursor_tag = page.next_tag;
+    cursor_blob = page.next_blob;
+  }
+
+  // Paging must cover exactly the unpaged result set
+  assert(seen.size() == all.size());
+  HLOG(kInfo, "Paged query visited {} results in {} pages", seen.size(),
+       pages);
+
+  // Zero page size is rejected without querying
+  iowarp::ContextQueryResult empty = ctx_interface.ContextQueryPage(".*", ".*", 0);
+  assert(empty.blob_names.empty() && !empty.has_more);
+  (void)empty;
+  HLOG(kSuccess, "PASSED: Paged query test");
+}
+
 int main(int argc, char** argv) {
   (void)argc;  // Suppress unused parameter warning
   (void)argv;  // Suppress unused parameter warning
@@ -119,6 +167,8 @@ int main(int argc, char** argv) {
 
     test_specific_patterns();
 
+    test_paged_query();
+
     HLOG(kSuccess, "All tests PASSED!");
     return 0;
   } catch (const std::exception& e) {
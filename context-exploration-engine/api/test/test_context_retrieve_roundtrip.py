@@ -70,6 +70,17 @@ def test_retrieve_roundtrip():
             f"original data ({len(original_data)} bytes)"
         )
 
+        # 4b. Zero-copy retrieval returns the same bytes, blob by blob
+        blobs = ctx_interface.context_retrieve_blobs(
+            tag_name, ".*", max_context_size=4 * 1024 * 1024)
+        assert b"".join(bytes(memoryview(b.data)) for b in blobs) == \
+            retrieved_bytes, "context_retrieve_blobs differs from packed data"
+        streamed = [b for batch in ctx_interface.context_retrieve_iter(
+            tag_name, ".*", max_context_size=4 * 1024 * 1024, batch_size=1)
+            for b in batch]
+        assert [b.blob_name for b in streamed] == \
+            [b.blob_name for b in blobs], "context_retrieve_iter differs"
+
         # 5. Destroy (cleanup)
         destroy_result = ctx_interface.context_destroy([tag_name])
         assert destroy_result == 0, f"context_destroy failed with code {destroy_result}"
@@ -125,6 +125,7 @@ extern "C" int run_gpu_bench_putblob(chi::PoolId cte_pool_id,
                                       float *out_elapsed_ms);
 extern "C" int run_gpu_bench_parallel_dispatch(chi::PoolId pool_id,
                                                 chi::u32 parallelism,
+                                                chi::u32 batch_size,
                                                 chi::u32 total_tasks,
                                                 float *out_elapsed_ms);
 extern "C" int run_gpu_bench_bdev(chi::PoolId bdev_pool_id,
@@ -205,7 +206,7 @@ extern "C" __attribute__((weak)) int run_gpu_bench_putblob(
   return -200;  // No GPU support compiled
 }
 extern "C" __attribute__((weak)) int run_gpu_bench_parallel_dispatch(
-    chi::PoolId, chi::u32, chi::u32, float *) {
+    chi::PoolId, chi::u32, chi::u32, chi::u32, float *) {
   return -200;  // No GPU support compiled
 }
 extern "C" __attribute__((weak)) int run_gpu_bench_bdev(
@@ -267,7 +268,9 @@ static void PrintHelp(const char *prog) {
   HIPRINT("  --rt-threads <N>       GPU runtime orchestrator threads/block (default: 32)");
   HIPRINT("  --client-blocks <N>    GPU client kernel blocks (default: 1)");
   HIPRINT("  --client-threads <N>   GPU client kernel threads/block (default: 32)");
-  HIPRINT("  --batch-size <N>       Tasks per batch per GPU thread (default: 1)");
+  HIPRINT("  --batch-size <N>       Tasks per batch per GPU thread; parallel_dispatch");
+  HIPRINT("                         sends N tasks per doorbell, 0 sweeps batch sizes");
+  HIPRINT("                         and gpu.max_pop_burst (default: 1)");
   HIPRINT("  --total-tasks <N>      Total tasks per GPU thread (default: 100)");
   HIPRINT("  --subtasks <N>         Subtasks per coroutine task (default: 1)");
   HIPRINT("  --parallelism <N>      GPU lane parallelism (parallel_dispatch, default: 32)");
@@ -606,7 +609,8 @@ static int RunBenchmark(const BenchmarkConfig &cfg) {
     }
     std::this_thread::sleep_for(500ms);
     rc = run_gpu_bench_parallel_dispatch(pool_id, cfg.parallelism,
-                                          cfg.total_tasks, &elapsed_ms);
+                                          cfg.batch_size, cfg.total_tasks,
+                                          &elapsed_ms);
   } else {
     // Runtime tests need pool + orchestrator stabilization
     std::this_thread::sleep_for(500ms);
@@ -47,6 +47,7 @@
 #if HSHM_ENABLE_CUDA || HSHM_ENABLE_ROCM
 
 #include <chimaera/ipc_manager.h>
+#include <chimaera/config_manager.h>
 #include <chimaera/gpu/work_orchestrator.h>
 #include <chimaera/task.h>
 #include <chimaera/MOD_NAME/MOD_NAME_client.h>
@@ -67,8 +68,10 @@
 #include <hermes_shm/memory/allocator/buddy_allocator.h>
 #include <hermes_shm/memory/allocator/slab_allocator.h>
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
+#include <vector>
 
 namespace chi_bench {
 
@@ -2814,9 +2817,55 @@ extern "C" int run_gpu_bench_cdp(
   return 0;
 }
 
+/**
+ * Time total_tasks CPU→GPU GpuSubmit round trips sent batch_size at a time.
+ * batch_size 1 uses Send/Wait; larger batches use SendGpuBatch, which
+ * rings the queue doorbell once per chunk, and WaitGpuBatch.
+ * @return Elapsed ms, or a negative value if a task timed out
+ */
+static float TimeCpu2GpuDispatch(chi::PoolId pool_id, chi::u32 parallelism,
+                                 chi::u32 batch_size, chi::u32 total_tasks) {
+  chimaera::MOD_NAME::Client client(pool_id);
+  auto *ipc = CHI_CPU_IPC;
+  chi::u32 gpu_id = 0;
+  std::vector<hipc::FullPtr<chimaera::MOD_NAME::GpuSubmitTask>> tasks;
+
+  auto t_start = std::chrono::high_resolution_clock::now();
+  for (chi::u32 i = 0; i < total_tasks; i += batch_size) {
+    if (batch_size <= 1) {
+      auto future = client.AsyncGpuSubmit(
+          chi::PoolQuery::ToLocalGpu(gpu_id, parallelism), gpu_id, i);
+      if (!future.Wait(30.0f)) return -1.0f;
+      continue;
+    }
+    chi::u32 n = std::min(batch_size, total_tasks - i);
+    tasks.clear();
+    for (chi::u32 j = 0; j < n; ++j) {
+      tasks.push_back(ipc->NewTask<chimaera::MOD_NAME::GpuSubmitTask>(
+          chi::CreateTaskId(), pool_id,
+          chi::PoolQuery::ToLocalGpu(gpu_id, parallelism), gpu_id, i + j));
+    }
+    auto futures = ipc->SendGpuBatch(tasks, gpu_id);
+    if (futures.size() != n || !ipc->WaitGpuBatch(futures, 30.0f)) {
+      return -1.0f;
+    }
+  }
+  auto t_end = std::chrono::high_resolution_clock::now();
+  return static_cast<float>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          t_end - t_start).count() / 1e6);
+}
+
+/**
+ * batch_size 0 sweeps client batch sizes against orchestrator pop bursts
+ * (set live with SetGpuOrchestratorElasticity) and reports the fastest
+ * pair; put its burst in gpu.max_pop_burst and batch that many tasks per
+ * SendGpuBatch. The elapsed time returned is that of the fastest pair.
+ */
 extern "C" int run_gpu_bench_parallel_dispatch(
     chi::PoolId pool_id,
     chi::u32 parallelism,
+    chi::u32 batch_size,
     chi::u32 total_tasks,
     float *out_elapsed_ms) {
   chimaera::MOD_NAME::Client client(pool_id);
@@ -2832,19 +2881,49 @@ extern "C" int run_gpu_bench_parallel_dispatch(
     }
   }
 
-  auto t_start = std::chrono::high_resolution_clock::now();
-  for (chi::u32 i = 0; i < total_tasks; ++i) {
-    auto future = client.AsyncGpuSubmit(
-        chi::PoolQuery::ToLocalGpu(gpu_id, parallelism),
-        gpu_id, i);
-    if (!future.Wait(30.0f)) {
-      return -4;
+  if (batch_size > 0) {
+    float ms = TimeCpu2GpuDispatch(pool_id, parallelism, batch_size,
+                                   total_tasks);
+    if (ms < 0) return -4;
+    *out_elapsed_ms = ms;
+    return 0;
+  }
+
+  auto *ipc = CHI_CPU_IPC;
+  auto *config = CHI_CONFIG_MANAGER;
+  const chi::u32 kBursts[] = {1, 4, 16, 64};
+  const chi::u32 kBatches[] = {1, 4, 16, 64, 256};
+  float best_ms = -1.0f;
+  chi::u32 best_burst = 0, best_batch = 0;
+  printf("\n=== CPU->GPU batch sweep (%u tasks, us/task) ===\n", total_tasks);
+  printf("  burst\\batch");
+  for (chi::u32 batch : kBatches) printf(" %8u", batch);
+  printf("\n");
+  for (chi::u32 burst : kBursts) {
+    ipc->SetGpuOrchestratorElasticity(burst, config->GetGpuIdleSleepMaxNs());
+    printf("  %11u", burst);
+    for (chi::u32 batch : kBatches) {
+      float ms = TimeCpu2GpuDispatch(pool_id, parallelism, batch,
+                                     total_tasks);
+      if (ms < 0) {
+        ipc->SetGpuOrchestratorElasticity(config->GetGpuMaxPopBurst(),
+                                          config->GetGpuIdleSleepMaxNs());
+        return -4;
+      }
+      printf(" %8.2f", ms * 1000.0f / total_tasks);
+      if (best_ms < 0 || ms < best_ms) {
+        best_ms = ms;
+        best_burst = burst;
+        best_batch = batch;
+      }
     }
+    printf("\n");
   }
-  auto t_end = std::chrono::high_resolution_clock::now();
-  *out_elapsed_ms = static_cast<float>(
-      std::chrono::duration_cast<std::chrono::nanoseconds>(
-          t_end - t_start).count() / 1e6);
+  ipc->SetGpuOrchestratorElasticity(config->GetGpuMaxPopBurst(),
+                                    config->GetGpuIdleSleepMaxNs());
+  printf("  Best: gpu.max_pop_burst=%u with %u tasks per batch\n",
+         best_burst, best_batch);
+  *out_elapsed_ms = best_ms;
   return 0;
 }
 
@@ -38,6 +38,8 @@
  * - BDev I/O throughput (allocate/write/free)
  * - BDev allocation throughput (allocate/free only)
  * - Round-trip latency using MOD_NAME Custom function
+ * - Metadata throughput using pipelined local MOD_NAME Custom tasks, which
+ *   is the load that separates the local_sched scheduler choices
  */
 
 #include <atomic>
@@ -62,7 +64,8 @@ enum class TestCase {
   kBDevIO,         // Full I/O (Allocate -> Write -> Free)
   kBDevAllocation, // Allocation only (Allocate -> Free)
   kBDevTaskAlloc,  // Task allocation/deletion (NewTask -> DelTask)
-  kLatency         // Round-trip latency using MOD_NAME Custom
+  kLatency,        // Round-trip latency using MOD_NAME Custom
+  kMetadata        // Pipelined small local tasks using MOD_NAME Custom
 };
 
 /**
@@ -97,6 +100,9 @@ bool ParseTestCase(const std::string &str, TestCase &test_case) {
   } else if (str == "latency") {
     test_case = TestCase::kLatency;
     return true;
+  } else if (str == "metadata") {
+    test_case = TestCase::kMetadata;
+    return true;
   }
   return false;
 }
@@ -110,7 +116,7 @@ bool ParseArgs(int argc, char **argv, BenchmarkConfig &config) {
 
     if (arg == "--test-case" && i + 1 < argc) {
       if (!ParseTestCase(argv[++i], config.test_case)) {
-        HLOG(kError, "ERROR: Invalid test case. Valid options: bdev_io, bdev_allocation, bdev_task_alloc, latency");
+        HLOG(kError, "ERROR: Invalid test case. Valid options: bdev_io, bdev_allocation, bdev_task_alloc, latency, metadata");
         return false;
       }
     } else if (arg == "--threads" && i + 1 < argc) {
@@ -130,7 +136,7 @@ bool ParseArgs(int argc, char **argv, BenchmarkConfig &config) {
     } else if (arg == "--help" || arg == "-h") {
       HIPRINT("Usage: {} [options]", argv[0]);
       HIPRINT("Options:");
-      HIPRINT("  --test-case <case>      Test case: bdev_io, bdev_allocation, bdev_task_alloc, latency (default: bdev_io)");
+      HIPRINT("  --test-case <case>      Test case: bdev_io, bdev_allocation, bdev_task_alloc, latency, metadata (default: bdev_io)");
       HIPRINT("  --threads <N>           Number of client threads (default: 4)");
       HIPRINT("  --duration <seconds>    Duration to run benchmark in seconds (default: 10.0)");
       HIPRINT("  --max-file-size <size>  Maximum file size with suffix: k, m, g (default: 1g)");
@@ -145,6 +151,7 @@ bool ParseArgs(int argc, char **argv, BenchmarkConfig &config) {
       HIPRINT("  bdev_allocation  - BDev allocation throughput (Allocate -> Free)");
       HIPRINT("  bdev_task_alloc  - BDev task allocation (NewTask -> DelTask)");
       HIPRINT("  latency          - Round-trip task latency using MOD_NAME Custom");
+      HIPRINT("  metadata         - Pipelined small local tasks (scheduler comparison)");
       return false;
     } else {
       HLOG(kError, "Unknown argument: {}", arg);
@@ -430,6 +437,62 @@ void LatencyWorkerThread(size_t thread_id, const BenchmarkConfig &config,
   }
 }
 
+/**
+ * Metadata worker thread function - measures small-task throughput
+ * Keeps a batch of local MOD_NAME Custom tasks in flight so the runtime's
+ * local scheduler decides how they spread over workers
+ */
+void MetadataWorkerThread(size_t thread_id, const BenchmarkConfig &config,
+                          chi::PoolId pool_id, std::atomic<bool> &stop_flag,
+                          std::atomic<size_t> &completed_ops,
+                          std::chrono::nanoseconds &elapsed_time) {
+  const size_t kBatchSize = 16;
+  chimaera::MOD_NAME::Client mod_client(pool_id);
+
+  size_t local_ops = 0;
+  const size_t WARMUP_OPS = 5 * kBatchSize; // Ignore first 5 batches
+  auto start_time = std::chrono::high_resolution_clock::now();
+
+  std::string input_data = "test";
+  std::vector<chi::Future<chimaera::MOD_NAME::CustomTask>> tasks;
+  tasks.reserve(kBatchSize);
+  while (!stop_flag.load(std::memory_order_relaxed)) {
+    for (size_t i = 0; i < kBatchSize; ++i) {
+      tasks.emplace_back(
+          mod_client.AsyncCustom(chi::PoolQuery::Local(), input_data, 0));
+    }
+    for (auto &task : tasks) {
+      task.Wait();
+      if (task->return_code_ != 0) {
+        HLOG(kError, "ERROR: Thread {} received unexpected result: {}",
+             thread_id, task->return_code_);
+        stop_flag.store(true, std::memory_order_relaxed);
+      }
+    }
+    tasks.clear();
+
+    local_ops += kBatchSize;
+
+    // Start timer after warmup operations
+    if (local_ops == WARMUP_OPS) {
+      start_time = std::chrono::high_resolution_clock::now();
+    }
+  }
+
+  auto end_time = std::chrono::high_resolution_clock::now();
+  elapsed_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      end_time - start_time);
+
+  // Update global counters
+  completed_ops.fetch_add(local_ops, std::memory_order_relaxed);
+
+  if (config.verbose) {
+    double thread_throughput = (local_ops * 1e9) / elapsed_time.count();
+    HIPRINT("Thread {}: {} metadata ops in {} ms, {} ops/sec",
+            thread_id, local_ops, (elapsed_time.count() / 1e6), thread_throughput);
+  }
+}
+
 int main(int argc, char **argv) {
   BenchmarkConfig config;
 
@@ -456,10 +519,15 @@ int main(int argc, char **argv) {
   case TestCase::kLatency:
     HIPRINT("Test case: Round-trip Latency (MOD_NAME Custom)");
     break;
+  case TestCase::kMetadata:
+    HIPRINT("Test case: Metadata Throughput (pipelined local MOD_NAME Custom)");
+    break;
   }
+  bool uses_mod_pool = config.test_case == TestCase::kLatency ||
+                       config.test_case == TestCase::kMetadata;
   HIPRINT("Threads: {}", config.num_threads);
   HIPRINT("Duration: {} seconds", config.duration_seconds);
-  if (config.test_case != TestCase::kLatency) {
+  if (!uses_mod_pool) {
     HIPRINT("Max file size: {} bytes", config.max_file_size);
   }
 
@@ -472,10 +540,17 @@ int main(int argc, char **argv) {
   // Lane mapping always uses PID+TID hash
   HIPRINT("Lane policy: map_by_pid_tid (default)");
 
+  // Results are only comparable between runs whose runtime used the same
+  // scheduler; report what the shared configuration selects
+  auto *config_manager = CHI_CONFIG_MANAGER;
+  if (config_manager) {
+    HIPRINT("Local scheduler: {}", config_manager->GetLocalSched());
+  }
+
   // Create pool based on test case
   chi::PoolId test_pool_id;
-  if (config.test_case == TestCase::kLatency) {
-    // Create MOD_NAME container for latency test
+  if (uses_mod_pool) {
+    // Create MOD_NAME container for latency and metadata tests
     test_pool_id = chi::PoolId(8000, 0);
     chimaera::MOD_NAME::Client mod_client(test_pool_id);
     auto create_task = mod_client.AsyncCreate(chi::PoolQuery::Broadcast(),
@@ -588,6 +663,15 @@ int main(int argc, char **argv) {
                            std::ref(completed_ops), std::ref(thread_times[i]));
     }
     break;
+
+  case TestCase::kMetadata:
+    // Spawn metadata worker threads
+    for (size_t i = 0; i < config.num_threads; i++) {
+      threads.emplace_back(MetadataWorkerThread, i, std::ref(config),
+                           test_pool_id, std::ref(stop_flag),
+                           std::ref(completed_ops), std::ref(thread_times[i]));
+    }
+    break;
   }
 
   // Sleep for the specified duration
@@ -657,6 +741,11 @@ int main(int argc, char **argv) {
     HIPRINT("Throughput: {} Custom ops/sec", throughput);
     HIPRINT("Avg round-trip latency: {} us/op", avg_latency_us);
     break;
+
+  case TestCase::kMetadata:
+    // Metadata mode results
+    HIPRINT("Throughput: {} metadata ops/sec", throughput);
+    break;
   }
 
   return 0;
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#ifndef CHIMAERA_INCLUDE_CHIMAERA_BLOCKING_POOL_H_
+#define CHIMAERA_INCLUDE_CHIMAERA_BLOCKING_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "chimaera/task.h"
+#include "chimaera/types.h"
+
+namespace chi {
+
+/**
+ * Bounded pool of OS threads for ChiMod code that must block.
+ *
+ * Workers only run stackless coroutines, so a third-party call that blocks
+ * (HDF5, Globus, a CAE assimilator) stalls every task on the worker. Such
+ * calls are handed to this pool with RunBlocking(); the calling coroutine
+ * yields until the job finishes and the worker keeps serving other lanes.
+ * The queue is bounded: Submit() fails instead of growing without limit.
+ */
+class BlockingPool {
+ public:
+  /** One queued call; done_ is set after fn_ returns */
+  struct Job {
+    std::function<void()> fn_;
+    std::atomic<bool> done_{false};
+  };
+
+  BlockingPool() = default;
+  ~BlockingPool() { Stop(); }
+
+  BlockingPool(const BlockingPool &) = delete;
+  BlockingPool &operator=(const BlockingPool &) = delete;
+
+  /**
+   * Start the pool threads. A pool with zero threads stays disabled.
+   * @param num_threads Number of threads
+   * @param max_queued Jobs that may wait for a thread before Submit() fails
+   */
+  void Start(u32 num_threads, u32 max_queued);
+
+  /** Run every queued job, then join the threads */
+  void Stop();
+
+  /**
+   * Queue a call for a pool thread.
+   * @param fn Call to run
+   * @return The queued job, or nullptr if the pool is disabled or full
+   */
+  std::shared_ptr<Job> Submit(std::function<void()> fn);
+
+  /** @return true if the pool has threads to run jobs */
+  bool IsEnabled() const { return !threads_.empty(); }
+
+  /** @return Number of pool threads */
+  u32 GetNumThreads() const { return static_cast<u32>(threads_.size()); }
+
+  /** @return Jobs waiting for a thread */
+  size_t GetQueuedCount();
+
+ private:
+  /** Body of each pool thread */
+  void ThreadLoop();
+
+  std::mutex lock_;
+  std::condition_variable cv_;
+  std::deque<std::shared_ptr<Job>> queue_;
+  u32 max_queued_ = 0;
+  bool stop_ = false;
+  std::vector<std::thread> threads_;
+};
+
+/**
+ * Run a blocking call off the worker thread.
+ *
+ * The call goes to the worker orchestrator's BlockingPool and the coroutine
+ * yields, backing off from 10us to 1ms, until it returns. When the pool is
+ * full the coroutine yields and retries; when runtime.blocking_threads is 0
+ * the call runs inline on the worker, as it would without this helper.
+ * The call must not touch state that workers mutate without a lock.
+ *
+ * Usage:
+ *   CHI_CO_AWAIT(chi::RunBlocking([&]() { H5Fflush(fid, H5F_SCOPE_LOCAL); }));
+ *
+ * @param fn Blocking call; captured references must outlive the co_await
+ * @return Coroutine to co_await
+ */
+TaskResume RunBlocking(std::function<void()> fn);
+
+}  // namespace chi
+
+#endif  // CHIMAERA_INCLUDE_CHIMAERA_BLOCKING_POOL_H_
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#ifndef CHIMAERA_INCLUDE_CHIMAERA_CLIENT_CREDITS_H_
+#define CHIMAERA_INCLUDE_CHIMAERA_CLIENT_CREDITS_H_
+
+#include <signal.h>
+
+#include <atomic>
+#include <cerrno>
+
+#include "chimaera/types.h"
+
+namespace chi {
+
+/** Admission credits of one client process */
+struct ClientCreditSlot {
+  std::atomic<u32> pid_;       /**< Owning client PID (0 = free) */
+  std::atomic<u32> inflight_;  /**< Tasks submitted and not yet ended */
+  std::atomic<u32> window_;    /**< Tasks the client may have in flight */
+};
+
+/**
+ * Per-client flow control shared between the runtime and SHM clients.
+ *
+ * Lives in the queue segment. A client claims a slot by PID when it
+ * attaches, takes a credit before pushing a task onto a worker lane, and
+ * stops submitting while inflight_ has reached window_. The worker that
+ * ends the task returns the credit and adapts the window (AIMD): it grows by
+ * one per uncongested completion up to the configured maximum, and shrinks
+ * by a quarter when the worker's own lane is deeper than the congestion
+ * depth. The window therefore follows how fast workers drain.
+ */
+class ClientCreditTable {
+ public:
+  static constexpr u32 kNumSlots = 1024;
+  static constexpr u32 kMinWindow = 8;
+
+  /**
+   * Initialize every slot as free. Runtime only, before clients attach.
+   * @param max_window Largest window a client can reach
+   * @param congested_depth Lane depth that counts as congestion
+   */
+  void Init(u32 max_window, u32 congested_depth) {
+    max_window_ = max_window < kMinWindow ? kMinWindow : max_window;
+    congested_depth_ = congested_depth;
+    for (u32 i = 0; i < kNumSlots; ++i) {
+      slots_[i].pid_.store(0, std::memory_order_relaxed);
+      slots_[i].inflight_.store(0, std::memory_order_relaxed);
+      slots_[i].window_.store(max_window_, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Claim the slot of a client process. A slot left by an earlier process
+   * with the same PID is reset; slots of dead processes are recycled.
+   * @param pid Client process ID
+   * @return Slot index, or kNumSlots if the table is full
+   */
+  u32 Claim(u32 pid) {
+    for (int pass = 0; pass < 2; ++pass) {
+      for (u32 n = 0; n < kNumSlots; ++n) {
+        u32 idx = (pid + n) % kNumSlots;
+        ClientCreditSlot &slot = slots_[idx];
+        u32 owner = slot.pid_.load(std::memory_order_acquire);
+        if (owner != pid && owner != 0) {
+          // Second pass: take over slots whose owner has exited
+          if (pass == 0 || kill(static_cast<pid_t>(owner), 0) == 0 ||
+              errno != ESRCH ||
+              !slot.pid_.compare_exchange_strong(owner, pid)) {
+            continue;
+          }
+        } else if (owner == 0 &&
+                   !slot.pid_.compare_exchange_strong(owner, pid)) {
+          continue;
+        }
+        slot.inflight_.store(0, std::memory_order_relaxed);
+        slot.window_.store(max_window_, std::memory_order_release);
+        return idx;
+      }
+    }
+    return kNumSlots;
+  }
+
+  /**
+   * Free a slot when its client detaches
+   * @param idx Slot index returned by Claim()
+   */
+  void Unclaim(u32 idx) {
+    if (idx < kNumSlots) {
+      slots_[idx].pid_.store(0, std::memory_order_release);
+    }
+  }
+
+  /**
+   * Take one credit without blocking
+   * @param idx Slot index returned by Claim()
+   * @return false if the client is at its window (EAGAIN)
+   */
+  bool TryAcquire(u32 idx) {
+    ClientCreditSlot &slot = slots_[idx];
+    u32 cur = slot.inflight_.load(std::memory_order_relaxed);
+    do {
+      if (cur >= slot.window_.load(std::memory_order_acquire)) {
+        return false;
+      }
+    } while (!slot.inflight_.compare_exchange_weak(
+        cur, cur + 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+    return true;
+  }
+
+  /**
+   * Return one credit without adapting the window, e.g. when a client
+   * fails to submit the task it took the credit for
+   * @param idx Slot index returned by Claim()
+   */
+  void Refund(u32 idx) {
+    ClientCreditSlot &slot = slots_[idx];
+    // The slot may have been reset by a restarted client; never underflow
+    u32 cur = slot.inflight_.load(std::memory_order_relaxed);
+    while (cur > 0 && !slot.inflight_.compare_exchange_weak(
+                          cur, cur - 1, std::memory_order_acq_rel,
+                          std::memory_order_relaxed)) {
+    }
+  }
+
+  /**
+   * Return one credit and adapt the window. Runtime only.
+   * @param idx Slot index carried by the task's FutureShm
+   * @param lane_depth Depth of the ending worker's lane
+   */
+  void Release(u32 idx, size_t lane_depth) {
+    if (idx >= kNumSlots) {
+      return;
+    }
+    Refund(idx);
+    ClientCreditSlot &slot = slots_[idx];
+    u32 window = slot.window_.load(std::memory_order_relaxed);
+    u32 next = window;
+    if (congested_depth_ && lane_depth > congested_depth_) {
+      next = window - window / 4;
+      if (next < kMinWindow) next = kMinWindow;
+    } else if (window < max_window_) {
+      next = window + 1;
+    }
+    if (next != window) {
+      slot.window_.compare_exchange_strong(window, next,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Get a slot for inspection
+   * @param idx Slot index
+   * @return Reference to the slot
+   */
+  const ClientCreditSlot &GetSlot(u32 idx) const { return slots_[idx]; }
+
+  /** @return Largest window a client can reach */
+  u32 GetMaxWindow() const { return max_window_; }
+
+ private:
+  u32 max_window_ = kMinWindow;
+  u32 congested_depth_ = 0;
+  ClientCreditSlot slots_[kNumSlots];
+};
+
+}  // namespace chi
+
+#endif  // CHIMAERA_INCLUDE_CHIMAERA_CLIENT_CREDITS_H_
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CHIMAERA_INCLUDE_CHIMAERA_CO_LOCK_QUEUE_H_
+#define CHIMAERA_INCLUDE_CHIMAERA_CO_LOCK_QUEUE_H_
+
+#include <algorithm>
+#include <chrono>
+
+#include <hermes_shm/thread/lock/futex.h>
+#include <hermes_shm/thread/lock/spin_lock.h>
+#include "chimaera/types.h"
+
+namespace chi {
+
+/** Contention counters of a CoMutex or CoRwLock */
+struct CoLockStats {
+  u64 acquired_;     /**< Acquisitions, excluding reentrant ones */
+  u64 contended_;    /**< Acquisitions that had to queue */
+  u64 handoffs_;     /**< Releases that passed the lock to a waiter */
+  u64 wait_ns_;      /**< Total time spent queued */
+  u32 waiters_;      /**< Currently queued */
+  u32 max_waiters_;  /**< Longest queue seen */
+
+  CoLockStats()
+      : acquired_(0),
+        contended_(0),
+        handoffs_(0),
+        wait_ns_(0),
+        waiters_(0),
+        max_waiters_(0) {}
+};
+
+/**
+ * One caller queued on a CoMutex or CoRwLock. Lives on the caller's stack
+ * for the duration of the wait.
+ *
+ * The releasing side grants the lock to the waiter while holding the
+ * lock's guard, so ownership is already transferred when the waiter
+ * wakes; it never competes for the lock again. Only this waiter is woken.
+ */
+struct CoLockWaiter {
+  CoLockWaiter *next_;
+  LockOwnerId owner_;
+  bool writer_;
+  hshm::ipc::atomic<u32> granted_;
+  hshm::Futex futex_;
+
+  CoLockWaiter(const LockOwnerId &owner, bool writer)
+      : next_(nullptr), owner_(owner), writer_(writer), granted_(0) {}
+
+  /** Block the calling thread until Grant() */
+  void Wait() {
+    futex_.Wait([this]() { return granted_.load() != 0; });
+  }
+
+  /** Hand the lock to this waiter and wake it */
+  void Grant() {
+    granted_.store(1);
+    futex_.WakeAll();
+  }
+};
+
+/** Intrusive FIFO of CoLockWaiters, protected by the owning lock's guard */
+class CoLockQueue {
+ public:
+  CoLockQueue() : head_(nullptr), tail_(nullptr), size_(0) {}
+
+  bool Empty() const { return head_ == nullptr; }
+  u32 Size() const { return size_; }
+  CoLockWaiter *Front() const { return head_; }
+
+  /** Append a waiter at the tail */
+  void Push(CoLockWaiter *waiter) {
+    waiter->next_ = nullptr;
+    if (tail_) {
+      tail_->next_ = waiter;
+    } else {
+      head_ = waiter;
+    }
+    tail_ = waiter;
+    ++size_;
+  }
+
+  /**
+   * Unlink a waiter
+   * @param prev The waiter before it, or nullptr if it is the head
+   * @param waiter The waiter to remove
+   */
+  void Remove(CoLockWaiter *prev, CoLockWaiter *waiter) {
+    if (prev) {
+      prev->next_ = waiter->next_;
+    } else {
+      head_ = waiter->next_;
+    }
+    if (tail_ == waiter) {
+      tail_ = prev;
+    }
+    waiter->next_ = nullptr;
+    --size_;
+  }
+
+  /** Remove and return the head, or nullptr if empty */
+  CoLockWaiter *Pop() {
+    CoLockWaiter *waiter = head_;
+    if (waiter) {
+      Remove(nullptr, waiter);
+    }
+    return waiter;
+  }
+
+ private:
+  CoLockWaiter *head_;
+  CoLockWaiter *tail_;
+  u32 size_;
+};
+
+/** Monotonic clock used for CoLockStats::wait_ns_ */
+inline u64 CoLockNowNs() {
+  return static_cast<u64>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+}  // namespace chi
+
+#endif  // CHIMAERA_INCLUDE_CHIMAERA_CO_LOCK_QUEUE_H_
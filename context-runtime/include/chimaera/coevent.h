@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+
+#ifndef CHIMAERA_INCLUDE_CHIMAERA_COEVENT_H_
+#define CHIMAERA_INCLUDE_CHIMAERA_COEVENT_H_
+
+#include <vector>
+
+#include <hermes_shm/thread/lock/spin_lock.h>
+#include "chimaera/ipc_manager.h"
+#include "chimaera/task.h"
+
+namespace chi {
+
+/**
+ * CoEvent - One-shot event for runtime coroutines.
+ *
+ * A coroutine co_awaits Wait() and is parked without polling: it is on no
+ * blocked queue or timer. Set() marks the event and resumes every parked
+ * waiter on its own worker through that worker's event queue. Waiting on
+ * an event that is already set does not suspend.
+ */
+class CoEvent {
+ public:
+  /** Awaitable returned by Wait() */
+  class Awaiter {
+   public:
+    explicit Awaiter(CoEvent &event) : event_(event) {}
+
+    bool await_ready() const noexcept { return event_.IsSet(); }
+
+#ifndef __NVCOMPILER
+    /**
+     * Park the coroutine until Set(), unless the event was set meanwhile
+     * @return True to suspend
+     */
+    template <typename PromiseT>
+    bool await_suspend(std::coroutine_handle<PromiseT> handle) noexcept {
+      RunContext *run_ctx = handle.promise().get_run_context();
+      if (!run_ctx) {
+        return false;
+      }
+      return event_.Park(run_ctx, handle);
+    }
+#endif  // !__NVCOMPILER
+
+    void await_resume() noexcept {}
+
+    /** Event being waited on (used by fiber_co_await for NVHPC) */
+    CoEvent &GetEvent() const { return event_; }
+
+   private:
+    CoEvent &event_;
+  };
+
+  CoEvent() : set_(false) {}
+  CoEvent(const CoEvent &) = delete;
+  CoEvent &operator=(const CoEvent &) = delete;
+
+  /** @return Whether Set() was called */
+  bool IsSet() const {
+    guard_.Lock(0);
+    bool set = set_;
+    guard_.Unlock();
+    return set;
+  }
+
+  /** @return Awaitable that completes once the event is set */
+  Awaiter Wait() { return Awaiter(*this); }
+
+  /** Set the event and resume all parked waiters */
+  void Set() {
+    guard_.Lock(0);
+    set_ = true;
+    std::vector<RunContext *> waiters;
+    waiters.swap(waiters_);
+    guard_.Unlock();
+    auto *ipc_manager = CHI_IPC;
+    for (RunContext *run_ctx : waiters) {
+      ipc_manager->ResumeParkedTask(run_ctx);
+    }
+  }
+
+  /**
+   * Register a coroutine that is about to suspend. Its worker parks it
+   * because the yield has no delay; Set() resumes it from the event queue.
+   * @param run_ctx Context of the suspending task
+   * @param handle Coroutine (or fiber) to resume
+   * @return False if the event is already set (do not suspend)
+   */
+  template <typename HandleT>
+  bool Park(RunContext *run_ctx, HandleT handle) {
+    guard_.Lock(0);
+    if (set_) {
+      guard_.Unlock();
+      return false;
+    }
+    run_ctx->coro_handle_ = handle;
+    run_ctx->is_yielded_ = true;
+    run_ctx->yield_time_us_ = 0.0;
+    waiters_.push_back(run_ctx);
+    guard_.Unlock();
+    return true;
+  }
+
+ private:
+  mutable hshm::SpinLock guard_;  ///< Protects set_ and waiters_
+  bool set_;
+  std::vector<RunContext *> waiters_;
+};
+
+}  // namespace chi
+
+#ifdef __NVCOMPILER
+namespace chi::detail {
+
+/// CoEvent overload: parks the fiber until the event is set
+inline void fiber_co_await(chi::CoEvent::Awaiter awaiter,
+                           chi::RunContext &rctx) {
+  auto *fs = tls_current_fiber;
+  if (!fs || !awaiter.GetEvent().Park(&rctx, rctx.coro_handle_)) {
+    return;
+  }
+  swapcontext(&fs->fiber_ctx, &fs->caller_ctx);
+  rctx.is_yielded_ = false;
+}
+
+}  // namespace chi::detail
+#endif  // __NVCOMPILER
+
+#endif  // CHIMAERA_INCLUDE_CHIMAERA_COEVENT_H_
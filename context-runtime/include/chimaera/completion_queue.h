@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#ifndef CHIMAERA_INCLUDE_CHIMAERA_COMPLETION_QUEUE_H_
+#define CHIMAERA_INCLUDE_CHIMAERA_COMPLETION_QUEUE_H_
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#include "chimaera/ipc_manager.h"
+
+namespace chi {
+
+/**
+ * Collects outstanding futures and hands them back in completion order
+ *
+ * Lets a client keep a constant I/O depth without head-of-line blocking:
+ * instead of Wait()ing on futures in submission order, it Push()es them here
+ * and takes whichever finishes first via PollN or WaitAny. Readiness is the
+ * completion bit already kept in each future's FutureShm, so no extra
+ * runtime work is involved. Every returned future has been waited on and its
+ * outputs are ready to read. Not thread-safe; use one queue per thread.
+ *
+ * @tparam TaskT Task type of the attached futures
+ */
+template <typename TaskT>
+class CompletionQueue {
+ public:
+  /** A finished future and the tag it was pushed with */
+  struct Completion {
+    Future<TaskT> future_;
+    u64 tag_ = 0;
+  };
+
+  /**
+   * Attach a future to the queue
+   * @param future Future to track; the queue takes ownership
+   * @param tag Caller-defined value returned with the completion
+   */
+  void Push(Future<TaskT> &&future, u64 tag = 0) {
+    pending_.push_back(Completion{std::move(future), tag});
+  }
+
+  /** Number of futures not yet returned */
+  size_t Size() const { return pending_.size(); }
+
+  /** Whether no futures are outstanding */
+  bool Empty() const { return pending_.empty(); }
+
+  /**
+   * Non-blocking: return up to max_count ready futures
+   * @param out Receives the completions (appended)
+   * @param max_count Maximum number of completions to return
+   * @return Number of completions appended to out
+   */
+  size_t PollN(std::vector<Completion> &out, size_t max_count) {
+    size_t found = 0;
+    size_t checked = 0;
+    size_t total = pending_.size();
+    auto *ipc_manager = CHI_IPC;
+    bool server_alive = ipc_manager->IsServerAliveCache();
+    while (found < max_count && checked < total && !pending_.empty()) {
+      if (scan_pos_ >= pending_.size()) {
+        scan_pos_ = 0;
+      }
+      Completion &entry = pending_[scan_pos_];
+      ++checked;
+      // A dead server never completes anything; let Wait fail over
+      if (!server_alive || entry.future_.IsReady()) {
+        out.push_back(Take(scan_pos_));
+        ++found;
+      } else {
+        ++scan_pos_;
+      }
+    }
+    return found;
+  }
+
+  /**
+   * Block until any attached future completes
+   * @param out Receives the completion (appended)
+   * @param max_sec Maximum seconds to wait (0 = wait indefinitely)
+   * @return true if a completion was appended, false on timeout or if the
+   * queue is empty
+   */
+  bool WaitAny(std::vector<Completion> &out, float max_sec = 0) {
+    auto start = std::chrono::steady_clock::now();
+    while (!pending_.empty()) {
+      if (PollN(out, 1) == 1) {
+        return true;
+      }
+      if (max_sec > 0) {
+        float elapsed = std::chrono::duration<float>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+        if (elapsed >= max_sec) {
+          return false;
+        }
+      }
+      HSHM_THREAD_MODEL->Yield();
+    }
+    return false;
+  }
+
+ private:
+  /**
+   * Remove the entry at idx (swap with the last), finish its Wait
+   * @param idx Index into pending_
+   * @return The completed entry
+   */
+  Completion Take(size_t idx) {
+    Completion entry = std::move(pending_[idx]);
+    if (idx + 1 != pending_.size()) {
+      pending_[idx] = std::move(pending_.back());
+    }
+    pending_.pop_back();
+    entry.future_.Wait();
+    return entry;
+  }
+
+  std::vector<Completion> pending_; /**< Futures not yet returned */
+  size_t scan_pos_ = 0; /**< Rotating scan start so no future starves */
+};
+
+}  // namespace chi
+
+#endif  // CHIMAERA_INCLUDE_CHIMAERA_COMPLETION_QUEUE_H_
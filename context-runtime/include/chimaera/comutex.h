@@ -34,7 +34,7 @@
 #ifndef CHIMAERA_INCLUDE_CHIMAERA_COMUTEX_H_
 #define CHIMAERA_INCLUDE_CHIMAERA_COMUTEX_H_
 
-#include <hermes_shm/thread/lock/mutex.h>
+#include "chimaera/co_lock_queue.h"
 #include "chimaera/types.h"
 
 namespace chi {
@@ -43,48 +43,100 @@ namespace chi {
  * CoMutex - Reentrant cooperative mutex for coroutine-based task execution.
  * When a parent task holds the lock and spawns a subtask on the same worker,
  * the subtask can reacquire the lock without deadlocking.
+ *
+ * Contended callers queue in FIFO order and park their own thread. Unlock
+ * hands the lock straight to the oldest waiter and wakes only that one, so
+ * no caller can overtake a queued one and waiters never retry.
  */
 class CoMutex {
  public:
-  hshm::Mutex lock_;
-  LockOwnerId holder_;
-  u32 depth_;
-
-  CoMutex() : depth_(0) {}
+  CoMutex() : locked_(false), depth_(0) {}
 
   /** Copy constructor reinitializes to unlocked (needed for std::vector) */
-  CoMutex(const CoMutex &other) : depth_(0) { (void)other; }
+  CoMutex(const CoMutex &other) : locked_(false), depth_(0) { (void)other; }
 
   void Lock() {
     LockOwnerId cur = GetCurrentLockOwnerId();
-    if (cur == holder_) {
+    guard_.Lock(0);
+    if (locked_ && cur == holder_) {
       ++depth_;
+      guard_.Unlock();
+      return;
+    }
+    ++stats_.acquired_;
+    // Queued waiters keep locked_ set, so a free lock has no queue
+    if (!locked_) {
+      locked_ = true;
+      holder_ = cur;
+      depth_ = 1;
+      guard_.Unlock();
       return;
     }
-    lock_.Lock(0);
-    holder_ = cur;
-    depth_ = 1;
+    CoLockWaiter self(cur, false);
+    waiters_.Push(&self);
+    ++stats_.contended_;
+    stats_.max_waiters_ = std::max(stats_.max_waiters_, waiters_.Size());
+    guard_.Unlock();
+
+    u64 start_ns = CoLockNowNs();
+    self.Wait();
+    // Retaking the guard also waits until Unlock() is done with self
+    guard_.Lock(0);
+    stats_.wait_ns_ += CoLockNowNs() - start_ns;
+    guard_.Unlock();
   }
 
   bool TryLock() {
     LockOwnerId cur = GetCurrentLockOwnerId();
-    if (cur == holder_) {
+    guard_.Lock(0);
+    bool acquired = true;
+    if (locked_ && cur == holder_) {
       ++depth_;
-      return true;
+    } else if (!locked_) {
+      locked_ = true;
+      holder_ = cur;
+      depth_ = 1;
+      ++stats_.acquired_;
+    } else {
+      acquired = false;
     }
-    if (!lock_.TryLock(0)) return false;
-    holder_ = cur;
-    depth_ = 1;
-    return true;
+    guard_.Unlock();
+    return acquired;
   }
 
   void Unlock() {
-    --depth_;
-    if (depth_ == 0) {
-      holder_.Clear();
-      lock_.Unlock();
+    guard_.Lock(0);
+    if (--depth_ == 0) {
+      CoLockWaiter *next = waiters_.Pop();
+      if (next) {
+        holder_ = next->owner_;
+        depth_ = 1;
+        ++stats_.handoffs_;
+        next->Grant();
+      } else {
+        locked_ = false;
+        holder_.Clear();
+      }
     }
+    guard_.Unlock();
+  }
+
+  /** @return Snapshot of the contention counters */
+  CoLockStats GetStats() const {
+    guard_.Lock(0);
+    CoLockStats stats = stats_;
+    stats.waiters_ = waiters_.Size();
+    guard_.Unlock();
+    return stats;
   }
+
+ private:
+  mutable hshm::SpinLock guard_;  ///< Protects every field below
+  bool locked_;
+  LockOwnerId holder_;
+  u32 depth_;
+  CoLockQueue waiters_;
+  CoLockStats stats_;
 };
 
 /**
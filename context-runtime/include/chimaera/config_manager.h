@@ -52,6 +52,8 @@ struct PoolConfig {
   PoolQuery pool_query_;     /**< Pool query routing (Dynamic or Local) */
   std::string config_;       /**< Remaining YAML configuration as string */
   bool restart_ = false;     /**< If true, store compose file for crash-restart */
+  u32 containers_per_node_ = 1; /**< Containers on each node ("numa": one
+                                     per NUMA node) */
 
   PoolConfig() = default;
 
@@ -70,7 +72,8 @@ struct PoolConfig {
    */
   template <class Archive>
   void serialize(Archive& ar) {
-    ar(mod_name_, pool_name_, pool_id_, pool_query_, config_, restart_);
+    ar(mod_name_, pool_name_, pool_id_, pool_query_, config_, restart_,
+       containers_per_node_);
   }
 };
 
@@ -83,6 +86,22 @@ struct ComposeConfig {
   ComposeConfig() = default;
 };
 
+/**
+ * Worker CPU pinning from runtime.worker_affinity. Each role is "none" (not
+ * pinned), "any" (any free core) or "device" (a free core on the NUMA node
+ * of the role's device: NVMe drives for io, the GPU for gpu, the NIC for
+ * net; any core when the device's node is unknown).
+ */
+struct WorkerAffinityConfig {
+  bool enabled_ = false;       /**< Pin workers at all */
+  bool smt_siblings_ = false;  /**< Also hand out second hardware threads */
+  std::string sched_ = "any";  /**< Worker 0 (scheduler, metadata) */
+  std::string io_ = "device";  /**< Every other task worker */
+  std::string gpu_ = "device"; /**< Worker polling the GPU queues */
+  std::string net_ = "device"; /**< Network workers */
+  std::string nic_ = "";       /**< Net device ("" = fabric_domain, or any NIC) */
+};
+
 /**
  * Configuration manager singleton
  *
@@ -163,6 +182,33 @@ class ConfigManager : public hshm::BaseConfig {
    */
   size_t GetMemorySegmentSize(MemorySegment segment) const;
 
+  /**
+   * Get the page size requested for a memory segment
+   * @param segment Memory segment identifier
+   * @return Huge page mode (default: kNone)
+   */
+  hipc::HugePageMode GetMemorySegmentHugePages(MemorySegment segment) const;
+
+  /**
+   * Parse a huge page setting: none, thp, 2MB or 1GB (case-insensitive)
+   * @param value Setting from the YAML config
+   * @return Huge page mode (kNone for unknown values, with a warning)
+   */
+  static hipc::HugePageMode ParseHugePageMode(const std::string &value);
+
+  /**
+   * Get the page size requested for GPU-registered pinned host backends
+   * @return Huge page mode (default: kNone)
+   */
+  hipc::HugePageMode GetGpuHugePages() const { return gpu_huge_pages_; }
+
+  /**
+   * Whether the runtime prefaults its shared memory segments in a
+   * background thread at startup
+   * @return true to prefault (default: false)
+   */
+  bool GetPrefaultSegments() const { return prefault_segments_; }
+
   /**
    * Get networking port
    * @return Port number for networking
@@ -206,6 +252,18 @@ class ConfigManager : public hshm::BaseConfig {
    */
   std::string GetLocalSched() const { return local_sched_; }
 
+  /**
+   * Get number of workers that metadata and small I/O tasks are hashed onto
+   * @return Metadata worker count (default: 1, i.e. worker 0 only)
+   */
+  u32 GetMetadataWorkers() const { return metadata_workers_; }
+
+  /**
+   * Get number of workers that runtime-to-runtime traffic is sharded across
+   * @return Network worker count (default: 1, i.e. the last worker only)
+   */
+  u32 GetNetWorkers() const { return net_workers_; }
+
   /**
    * Get compose configuration
    * @return Compose configuration with all pool definitions
@@ -230,6 +288,62 @@ class ConfigManager : public hshm::BaseConfig {
    */
   u32 GetWaitForRestartPollPeriod() const { return wait_for_restart_poll_period_; }
 
+  /**
+   * Get the byte threshold at which a coalesced network batch is flushed
+   * @return Bytes of task data per destination before flushing (default: 64KB)
+   */
+  u32 GetNetCoalesceBytes() const { return net_coalesce_bytes_; }
+
+  /**
+   * Get the maximum number of tasks packed into one network message
+   * @return Tasks per destination before flushing (default: 64)
+   */
+  u32 GetNetCoalesceMaxTasks() const { return net_coalesce_max_tasks_; }
+
+  /**
+   * Get the maximum time a request batch may be held for coalescing
+   * @return Microseconds; 0 flushes every pass (default: 50)
+   */
+  u32 GetNetCoalesceDelay() const { return net_coalesce_delay_us_; }
+
+  /**
+   * Get the transport used between runtimes
+   * @return "zeromq" (default), "libfabric" or "io_uring"
+   */
+  const std::string &GetNetTransport() const { return net_transport_; }
+
+  /**
+   * Get the libfabric provider for the libfabric transport
+   * @return Provider name, e.g. "verbs;ofi_rxm"; empty lets libfabric choose
+   */
+  const std::string &GetFabricProvider() const { return fabric_provider_; }
+
+  /**
+   * Get the libfabric domain (NIC) for the libfabric transport
+   * @return Domain name, e.g. "mlx5_0"; empty picks the first match
+   */
+  const std::string &GetFabricDomain() const { return fabric_domain_; }
+
+  /**
+   * Get the number of parallel connections opened to each peer per shard
+   * @return Connections per peer; batches rotate over them (default: 1)
+   */
+  u32 GetNetStripes() const { return net_stripes_; }
+
+  /**
+   * Get the codec used to compress bulks sent to other runtimes
+   * @return "none" (default), "lz4", "zstd" or "auto" (lz4, zstd when large)
+   */
+  const std::string &GetNetCompression() const { return net_compression_; }
+
+  /**
+   * Get the smallest bulk worth compressing on the wire
+   * @return Bytes; smaller bulks are sent raw (default: 64KB)
+   */
+  u64 GetNetCompressionMinBytes() const {
+    return net_compression_min_bytes_;
+  }
+
   /**
    * Get first busy wait duration in microseconds
    * @return Duration to busy wait before sleeping when there is no work (default: 10000us = 10ms)
@@ -242,12 +356,74 @@ class ConfigManager : public hshm::BaseConfig {
    */
   u32 GetMaxSleep() const { return max_sleep_; }
 
+  /**
+   * Get worker idle policy
+   * @return "sleep", "busy" or "adaptive" (default: "sleep")
+   */
+  const std::string &GetPollMode() const { return poll_mode_; }
+
+  /**
+   * Get p99 wake-up latency target for adaptive polling
+   * @return Target in microseconds (default: 0 = no target)
+   */
+  u32 GetWakeLatencyTarget() const { return wake_latency_target_us_; }
+
+  /**
+   * Get maximum busy + spin time per idle period for adaptive polling
+   * @return Budget in microseconds (default: 1000us)
+   */
+  u32 GetMaxSpin() const { return max_spin_us_; }
+
+  /**
+   * Check whether per-task lifecycle latency histograms are recorded
+   * @return True if tasks are timestamped (default: false)
+   */
+  bool GetTaskLatency() const { return task_latency_; }
+
+  /**
+   * Get the TCP port of the metrics HTTP endpoint
+   * @return Port serving GET /metrics (default: 0 = disabled)
+   */
+  u32 GetMetricsPort() const { return metrics_port_; }
+
+  /**
+   * Get the IPv4 address the metrics endpoint listens on
+   * @return Bind address (default: "127.0.0.1")
+   */
+  const std::string &GetMetricsBind() const { return metrics_bind_; }
+
   /**
    * Get SGD learning rate for task load prediction model
    * @return Learning rate (default: 0.2)
    */
   float GetLearningRate() const { return learning_rate_; }
 
+  /**
+   * Get topology-aware worker pinning settings
+   * @return Pinning per worker role (default: disabled)
+   */
+  const WorkerAffinityConfig &GetWorkerAffinity() const {
+    return worker_affinity_;
+  }
+
+  /**
+   * Get number of threads that run blocking ChiMod calls (RunBlocking)
+   * @return Thread count (default: 2; 0 = calls run inline on the worker)
+   */
+  u32 GetBlockingThreads() const { return blocking_threads_; }
+
+  /**
+   * Get how many blocking calls may wait for a pool thread
+   * @return Queue bound (default: 256)
+   */
+  u32 GetBlockingQueueDepth() const { return blocking_queue_depth_; }
+
+  /**
+   * Get the largest number of tasks one SHM client may have in flight
+   * @return Credit window cap (default: 1024; 0 = no flow control)
+   */
+  u32 GetClientCredits() const { return client_credits_; }
+
   /**
    * Get number of GPU blocks for GPU orchestrator
    * @return Number of blocks (default: 32)
@@ -266,6 +442,18 @@ class ConfigManager : public hshm::BaseConfig {
    */
   u32 GetGpuQueueDepth() const { return gpu_queue_depth_; }
 
+  /**
+   * Get the GPU orchestrator's max pops per queue per poll round
+   * @return Pop burst cap (default: 16)
+   */
+  u32 GetGpuMaxPopBurst() const { return gpu_max_pop_burst_; }
+
+  /**
+   * Get the GPU orchestrator's idle backoff ceiling
+   * @return Max idle sleep in nanoseconds, 0 = always spin (default: 20000)
+   */
+  u32 GetGpuIdleSleepMaxNs() const { return gpu_idle_sleep_max_ns_; }
+
  private:
   /**
    * Set default configuration values (implements hshm::BaseConfig)
@@ -287,6 +475,16 @@ class ConfigManager : public hshm::BaseConfig {
   size_t main_segment_size_ = hshm::Unit<size_t>::Gigabytes(1);
   size_t client_data_segment_size_ = hshm::Unit<size_t>::Megabytes(256);
 
+  // Huge page backing per memory segment (opt-in)
+  hipc::HugePageMode main_segment_huge_pages_ = hipc::HugePageMode::kNone;
+  hipc::HugePageMode client_data_segment_huge_pages_ =
+      hipc::HugePageMode::kNone;
+  hipc::HugePageMode queue_segment_huge_pages_ = hipc::HugePageMode::kNone;
+  hipc::HugePageMode gpu_huge_pages_ = hipc::HugePageMode::kNone;
+
+  // Touch shared memory segment pages in the background at startup
+  bool prefault_segments_ = false;
+
   u32 port_ = 9413;
   std::string server_addr_ = "127.0.0.1";
   u32 neighborhood_size_ = 32;
@@ -301,22 +499,59 @@ class ConfigManager : public hshm::BaseConfig {
 
   // Local task scheduler
   std::string local_sched_ = "default";
+  u32 metadata_workers_ = 1;
+  u32 net_workers_ = 1;
 
   // Network retry configuration for system boot
   u32 wait_for_restart_timeout_ = 30;        // Default: 30 seconds
   u32 wait_for_restart_poll_period_ = 1;     // Default: 1 second
 
+  // Network message coalescing
+  u32 net_coalesce_bytes_ = 65536;           // Default: 64KB per message
+  u32 net_coalesce_max_tasks_ = 64;          // Default: 64 tasks per message
+  u32 net_coalesce_delay_us_ = 50;           // Default: hold at most 50us
+
+  // Runtime-to-runtime transport
+  std::string net_transport_ = "zeromq";     // Default: ZeroMQ over TCP
+  std::string fabric_provider_ = "";         // Default: libfabric chooses
+  std::string fabric_domain_ = "";           // Default: first matching NIC
+  u32 net_stripes_ = 1;                      // Default: one connection per peer
+  std::string net_compression_ = "none";     // Default: bulks sent raw
+  u64 net_compression_min_bytes_ = 65536;    // Default: compress from 64KB
+
   // Worker sleep configuration (in microseconds)
   u32 first_busy_wait_ = 10000;              // Default: 10000us (10ms) busy wait
   u32 max_sleep_ = 50000;                    // Default: 50000us (50ms) maximum sleep
+  std::string poll_mode_ = "sleep";          // Default: busy-wait, then epoll
+  u32 wake_latency_target_us_ = 0;           // Default: no p99 target
+  u32 max_spin_us_ = 1000;                   // Default: 1000us adaptive spin cap
+
+  // Task lifecycle latency histograms
+  bool task_latency_ = false;                // Default: no timestamps
+
+  // Prometheus/OpenMetrics endpoint
+  u32 metrics_port_ = 0;                     // Default: disabled
+  std::string metrics_bind_ = "127.0.0.1";   // Default: loopback only
 
   // Task load prediction model
   float learning_rate_ = 0.2f;               // Default: 0.2 SGD learning rate
 
+  // Topology-aware worker pinning
+  WorkerAffinityConfig worker_affinity_;     // Default: workers not pinned
+
+  // Pool for blocking ChiMod calls
+  u32 blocking_threads_ = 2;                 // Default: 2 pool threads
+  u32 blocking_queue_depth_ = 256;           // Default: 256 queued calls
+
+  // Per-client admission control
+  u32 client_credits_ = 1024;                // Default: 1024 in-flight tasks
+
   // GPU orchestrator configuration
   u32 gpu_blocks_ = 1;                       // Default: 1 block
   u32 gpu_threads_per_block_ = 32;           // Default: 32 threads per block
   u32 gpu_queue_depth_ = 16;                 // Default: 16 tasks per queue
+  u32 gpu_max_pop_burst_ = 16;               // Default: 16 pops per round
+  u32 gpu_idle_sleep_max_ns_ = 20000;        // Default: 20 us idle backoff cap
 
   // Compose configuration
   ComposeConfig compose_config_;
@@ -48,6 +48,7 @@
 #include "chimaera/task.h"
 #include "chimaera/task_archives.h"
 #include "chimaera/local_task_archives.h"
+#include "chimaera/method_traits.h"
 #include "chimaera/types.h"
 
 // Forward declarations to avoid circular dependencies
@@ -94,6 +95,8 @@ class Container {
   std::string pool_name_;  ///< The semantic name of this pool
   u32 container_id_;       ///< The logical ID of this container instance
   hshm::abitfield32_t flags_;  ///< Atomic bitfield for container state
+  /** NUMA node a shard of a sharded pool is homed on (-1: not sharded) */
+  int numa_node_ = -1;
 
   /** Group affinity map: TaskGroup id -> pinned Worker* */
   std::unordered_map<int64_t, Worker*> task_group_map_;
@@ -106,7 +109,10 @@ class Container {
   std::vector<float> method_mape_;   ///< Per-method CPU MAPE (exponential moving average)
   std::vector<float> method_model_wall_;  ///< Per-method wall clock coefficient "b"
   std::vector<float> method_mape_wall_;   ///< Per-method wall clock MAPE
+  std::vector<float> method_cost_us_;     ///< Per-method EMA of wall time (us)
   std::vector<std::string> method_names_;  ///< Per-method human-readable names
+  const MethodTraits *method_traits_ = nullptr;  ///< Method::kMethodTraits
+  u32 num_method_traits_ = 0;                    ///< Entries in method_traits_
   float learning_rate_ = 0.2f;      ///< SGD learning rate for model updates
 
  public:
@@ -145,6 +151,7 @@ class Container {
     method_mape_.resize(max_method_id, 0.0f);
     method_model_wall_.resize(max_method_id, 1.0f);
     method_mape_wall_.resize(max_method_id, 0.0f);
+    method_cost_us_.resize(max_method_id, 0.0f);
     auto *config = CHI_CONFIG_MANAGER;
     if (config) {
       learning_rate_ = config->GetLearningRate();
@@ -160,6 +167,29 @@ class Container {
     method_names_ = names;
   }
 
+  /**
+   * Set the compile-time method traits table.
+   * Called by autogenerated Init() with Method::kMethodTraits.
+   * @param traits Table indexed by method ID
+   */
+  template <size_t N>
+  void SetMethodTraits(const MethodTraits (&traits)[N]) {
+    method_traits_ = traits;
+    num_method_traits_ = static_cast<u32>(N);
+  }
+
+  /**
+   * Get the declared traits of a method.
+   * @param method_id Method to query
+   * @return Traits from the ChiMod's table, or kNoMethodTraits if unknown
+   */
+  const MethodTraits& GetMethodTraits(u32 method_id) const {
+    if (method_id < num_method_traits_) {
+      return method_traits_[method_id];
+    }
+    return kNoMethodTraits;
+  }
+
   /**
    * Get live task statistics for a method.
    * Override in modules to provide dynamic stats (e.g., queue depth).
@@ -234,6 +264,35 @@ class Container {
     }
   }
 
+  /**
+   * Fold a completed run into the method's moving-average cost.
+   * The first sample seeds the average; later samples are blended with
+   * weight learning_rate_. Used by schedulers to estimate queue latency.
+   * @param method_id Method that completed
+   * @param real_wall Measured wall clock time in microseconds
+   */
+  void UpdateMethodCost(u32 method_id, float real_wall) {
+    if (method_id >= method_cost_us_.size() || real_wall < 0) return;
+    float &cost = method_cost_us_[method_id];
+    if (cost <= 0) {
+      cost = real_wall;
+    } else {
+      cost = (1.0f - learning_rate_) * cost + learning_rate_ * real_wall;
+    }
+  }
+
+  /**
+   * Get the moving-average cost of a method.
+   * @param method_id Method to query
+   * @return Average wall clock time in microseconds (0 if never run)
+   */
+  float GetMethodCost(u32 method_id) const {
+    if (method_id < method_cost_us_.size()) {
+      return method_cost_us_[method_id];
+    }
+    return 0.0f;
+  }
+
   /**
    * Get the MAPE for a given method.
    * @param method_id Method to query
@@ -250,6 +309,7 @@ class Container {
   const std::vector<float>& GetMethodMapeVec() const { return method_mape_; }
   const std::vector<float>& GetMethodModelWall() const { return method_model_wall_; }
   const std::vector<float>& GetMethodMapeWallVec() const { return method_mape_wall_; }
+  const std::vector<float>& GetMethodCostVec() const { return method_cost_us_; }
   const std::vector<std::string>& GetMethodNames() const { return method_names_; }
   float GetLearningRate() const { return learning_rate_; }
 
@@ -362,6 +422,29 @@ class Container {
     (void)dest_node_id;
   }
 
+  /**
+   * Copy state to a migration destination while the container keeps serving
+   *
+   * Admin::MigrateContainers calls this in rounds before plugging the
+   * container, then once more with final_round set after plugging. Each
+   * round only has to copy what changed during the previous one, so the
+   * final round, which I/O waits on, stays short.
+   * Default implementation has nothing to copy.
+   * @param dest_node_id The node ID to migrate to
+   * @param final_round true for the last round, run while plugged
+   * @param remaining Output: entries changed during this round
+   * @param rctx Run context of the calling admin task
+   */
+  virtual TaskResume MigratePrecopy(u32 dest_node_id, bool final_round,
+                                    u64 &remaining, RunContext &rctx) {
+    (void)dest_node_id;
+    (void)final_round;
+    remaining = 0;
+    CHI_TASK_BODY_BEGIN
+    CHI_CO_RETURN;
+    CHI_TASK_BODY_END
+  }
+
   /**
    * Called after the GPU container for this pool has been allocated and
    * registered with the GPU work orchestrator (and the orchestrator has been
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#ifndef CHIMAERA_INCLUDE_CHIMAERA_CORO_FRAME_POOL_H_
+#define CHIMAERA_INCLUDE_CHIMAERA_CORO_FRAME_POOL_H_
+
+#include <cstddef>
+
+#include "chimaera/types.h"
+
+namespace chi {
+
+/** Frame pool counters, summed over threads by CoroFramePool::CollectStats */
+struct CoroFrameStats {
+  /** Size classes 64, 128, ... 16384 bytes plus one for larger frames */
+  static constexpr u32 kNumBins = 10;
+
+  u64 allocs_[kNumBins] = {};  ///< Frames allocated per size class
+  u64 pool_hits_ = 0;          ///< Allocations served from a free list
+  u64 frees_ = 0;              ///< Frames released
+  u64 max_frame_size_ = 0;     ///< Largest frame requested, in bytes
+  u64 cached_frames_ = 0;      ///< Frames parked on live free lists
+
+  /** @return Total frames allocated */
+  u64 Allocs() const {
+    u64 total = 0;
+    for (u64 count : allocs_) total += count;
+    return total;
+  }
+};
+
+/**
+ * Size-classed allocator for TaskResume coroutine frames.
+ *
+ * Every ChiMod method is a coroutine, and nested CHI_CO_AWAITs create
+ * several frames per task, so frames come and go at the task rate. Each
+ * thread keeps one free list per power-of-two class from 64 B to 16 KiB;
+ * a released frame goes onto the list of whichever thread releases it, so
+ * frames resumed on another worker are recycled there. Larger frames and
+ * lists that are already full fall through to global operator new/delete.
+ */
+class CoroFramePool {
+ public:
+  static constexpr size_t kMinClassSize = 64;
+  static constexpr u32 kNumClasses = CoroFrameStats::kNumBins - 1;
+  static constexpr size_t kMaxClassSize = kMinClassSize << (kNumClasses - 1);
+  /** Frames each thread keeps per class before releasing to the heap */
+  static constexpr u32 kMaxCachedPerClass = 256;
+
+  /**
+   * Allocate a coroutine frame.
+   * @param size Frame size the compiler asked for
+   * @return Storage aligned for any fundamental type; throws bad_alloc
+   */
+  static void *Allocate(size_t size);
+
+  /**
+   * Release a frame from Allocate on any thread.
+   * @param ptr Frame storage, may be null
+   */
+  static void Free(void *ptr) noexcept;
+
+  /**
+   * Get the class serving a frame size.
+   * @param size Frame size in bytes
+   * @return Class index, or kNumClasses when the frame is too large to pool
+   */
+  static u32 ClassOf(size_t size) {
+    if (size > kMaxClassSize) return kNumClasses;
+    u32 cls = 0;
+    size_t class_size = kMinClassSize;
+    while (class_size < size) {
+      class_size <<= 1;
+      ++cls;
+    }
+    return cls;
+  }
+
+  /**
+   * Get the frame size a class holds.
+   * @param cls Class index below kNumClasses
+   * @return Bytes per frame
+   */
+  static size_t ClassSize(u32 cls) { return kMinClassSize << cls; }
+
+  /** @return Counters of all threads, live and exited */
+  static CoroFrameStats CollectStats();
+
+  /** @return Counters of the calling thread */
+  static CoroFrameStats GetThreadStats();
+};
+
+}  // namespace chi
+
+#endif  // CHIMAERA_INCLUDE_CHIMAERA_CORO_FRAME_POOL_H_
@@ -34,7 +34,7 @@
 #ifndef CHIMAERA_INCLUDE_CHIMAERA_CORWLOCK_H_
 #define CHIMAERA_INCLUDE_CHIMAERA_CORWLOCK_H_
 
-#include <hermes_shm/thread/lock/rwlock.h>
+#include "chimaera/co_lock_queue.h"
 #include "chimaera/types.h"
 
 namespace chi {
@@ -43,78 +43,205 @@ namespace chi {
  * CoRwLock - Reentrant cooperative read-write lock for coroutine-based
  * task execution. Allows write->write and write->read reentrancy
  * from the same logical execution context (parent/subtask chain).
+ *
+ * Contended callers queue in FIFO order and park their own thread; a
+ * release hands the lock straight to the next waiters and wakes only them.
+ * By default the queue is served in arrival order, with a run of queued
+ * readers admitted together, and new readers queue behind a waiting writer
+ * so writers cannot starve. With writer preference, a release serves the
+ * oldest queued writer before any queued reader.
  */
 class CoRwLock {
  public:
-  hshm::RwLock lock_;
-  LockOwnerId holder_;
-  u32 write_depth_;
-  u32 read_depth_;
+  CoRwLock()
+      : writer_(false),
+        readers_(0),
+        write_depth_(0),
+        read_depth_(0),
+        writer_preferred_(false),
+        queued_writers_(0) {}
 
-  CoRwLock() : write_depth_(0), read_depth_(0) {}
+  /** @param writer_preferred Serve queued writers before queued readers */
+  explicit CoRwLock(bool writer_preferred) : CoRwLock() {
+    writer_preferred_ = writer_preferred;
+  }
 
-  /** Deleted copy constructor (matches hshm::RwLock) */
+  /** Deleted copy constructor */
   CoRwLock(const CoRwLock &other) = delete;
 
-  CoRwLock(CoRwLock &&other) noexcept
-      : lock_(std::move(other.lock_)),
-        holder_(other.holder_),
-        write_depth_(other.write_depth_),
-        read_depth_(other.read_depth_) {
-    other.holder_.Clear();
-    other.write_depth_ = 0;
-    other.read_depth_ = 0;
+  /** Move an unlocked, idle lock; queued waiters cannot be moved */
+  CoRwLock(CoRwLock &&other) noexcept : CoRwLock() {
+    writer_preferred_ = other.writer_preferred_;
   }
 
   CoRwLock &operator=(CoRwLock &&other) noexcept {
     if (this != &other) {
-      lock_ = std::move(other.lock_);
-      holder_ = other.holder_;
-      write_depth_ = other.write_depth_;
-      read_depth_ = other.read_depth_;
-      other.holder_.Clear();
-      other.write_depth_ = 0;
-      other.read_depth_ = 0;
+      writer_preferred_ = other.writer_preferred_;
     }
     return *this;
   }
 
+  /** Select writer preference; only change it while the lock is idle */
+  void SetWriterPreferred(bool writer_preferred) {
+    guard_.Lock(0);
+    writer_preferred_ = writer_preferred;
+    guard_.Unlock();
+  }
+
   void ReadLock() {
     LockOwnerId cur = GetCurrentLockOwnerId();
-    if (cur == holder_) {
+    guard_.Lock(0);
+    if (writer_ && cur == holder_) {
       ++read_depth_;
+      guard_.Unlock();
+      return;
+    }
+    ++stats_.acquired_;
+    // Queued writers keep later readers out in both modes
+    if (!writer_ && queued_writers_ == 0) {
+      ++readers_;
+      guard_.Unlock();
       return;
     }
-    lock_.ReadLock(0);
+    Enqueue(cur, false);
   }
 
   void ReadUnlock() {
     LockOwnerId cur = GetCurrentLockOwnerId();
-    if (cur == holder_ && read_depth_ > 0) {
+    guard_.Lock(0);
+    if (writer_ && cur == holder_ && read_depth_ > 0) {
       --read_depth_;
+      if (read_depth_ == 0 && write_depth_ == 0) {
+        ReleaseWrite();
+      }
+      guard_.Unlock();
       return;
     }
-    lock_.ReadUnlock();
+    if (--readers_ == 0) {
+      Dispatch();
+    }
+    guard_.Unlock();
   }
 
   void WriteLock() {
     LockOwnerId cur = GetCurrentLockOwnerId();
-    if (cur == holder_) {
+    guard_.Lock(0);
+    if (writer_ && cur == holder_) {
       ++write_depth_;
+      guard_.Unlock();
       return;
     }
-    lock_.WriteLock(0);
-    holder_ = cur;
-    write_depth_ = 1;
+    ++stats_.acquired_;
+    if (!writer_ && readers_ == 0 && waiters_.Empty()) {
+      writer_ = true;
+      holder_ = cur;
+      write_depth_ = 1;
+      guard_.Unlock();
+      return;
+    }
+    ++queued_writers_;
+    Enqueue(cur, true);
   }
 
   void WriteUnlock() {
+    guard_.Lock(0);
     --write_depth_;
     if (write_depth_ == 0 && read_depth_ == 0) {
-      holder_.Clear();
-      lock_.WriteUnlock();
+      ReleaseWrite();
+    }
+    guard_.Unlock();
+  }
+
+  /** @return Snapshot of the contention counters */
+  CoLockStats GetStats() const {
+    guard_.Lock(0);
+    CoLockStats stats = stats_;
+    stats.waiters_ = waiters_.Size();
+    guard_.Unlock();
+    return stats;
+  }
+
+ private:
+  /**
+   * Queue the caller and park until a release grants it the lock.
+   * Called with guard_ held; returns with it released.
+   */
+  void Enqueue(const LockOwnerId &cur, bool writer) {
+    CoLockWaiter self(cur, writer);
+    waiters_.Push(&self);
+    ++stats_.contended_;
+    stats_.max_waiters_ = std::max(stats_.max_waiters_, waiters_.Size());
+    guard_.Unlock();
+
+    u64 start_ns = CoLockNowNs();
+    self.Wait();
+    // Retaking the guard also waits until Dispatch() is done with self
+    guard_.Lock(0);
+    stats_.wait_ns_ += CoLockNowNs() - start_ns;
+    guard_.Unlock();
+  }
+
+  /** Drop write ownership and serve the queue. guard_ must be held */
+  void ReleaseWrite() {
+    writer_ = false;
+    holder_.Clear();
+    Dispatch();
+  }
+
+  /** Hand a free lock to the next waiters. guard_ must be held */
+  void Dispatch() {
+    if (writer_ || waiters_.Empty()) {
+      return;
+    }
+    if (writer_preferred_ && queued_writers_ > 0) {
+      if (readers_ > 0) {
+        return;  // The last reader out dispatches again
+      }
+      CoLockWaiter *prev = nullptr;
+      CoLockWaiter *waiter = waiters_.Front();
+      while (!waiter->writer_) {
+        prev = waiter;
+        waiter = waiter->next_;
+      }
+      waiters_.Remove(prev, waiter);
+      GrantWrite(waiter);
+      return;
     }
+    if (waiters_.Front()->writer_) {
+      if (readers_ == 0) {
+        GrantWrite(waiters_.Pop());
+      }
+      return;
+    }
+    // Admit the run of readers at the head together
+    while (!waiters_.Empty() && !waiters_.Front()->writer_) {
+      CoLockWaiter *waiter = waiters_.Pop();
+      ++readers_;
+      ++stats_.handoffs_;
+      waiter->Grant();
+    }
+  }
+
+  /** Give write ownership to a dequeued writer. guard_ must be held */
+  void GrantWrite(CoLockWaiter *waiter) {
+    writer_ = true;
+    holder_ = waiter->owner_;
+    write_depth_ = 1;
+    --queued_writers_;
+    ++stats_.handoffs_;
+    waiter->Grant();
   }
+
+  mutable hshm::SpinLock guard_;  ///< Protects every field below
+  bool writer_;                   ///< A writer holds the lock
+  u32 readers_;                   ///< Readers holding the lock
+  LockOwnerId holder_;            ///< Writer holding the lock
+  u32 write_depth_;
+  u32 read_depth_;                ///< Reentrant reads by the writer
+  bool writer_preferred_;
+  u32 queued_writers_;
+  CoLockQueue waiters_;
+  CoLockStats stats_;
 };
 
 /**
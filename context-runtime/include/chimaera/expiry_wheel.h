@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#ifndef CHIMAERA_INCLUDE_CHIMAERA_EXPIRY_WHEEL_H_
+#define CHIMAERA_INCLUDE_CHIMAERA_EXPIRY_WHEEL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "chimaera/types.h"
+
+namespace chi {
+
+/**
+ * Hashed timer wheel of expiry deadlines.
+ *
+ * Time is cut into ticks; a deadline is filed in the slot of its tick,
+ * modulo the number of slots. Advance only visits the slots of the ticks
+ * from the previous call up to now, so its cost follows the elapsed time
+ * and the entries that come due, not the number of scheduled keys.
+ * Deadlines more than one revolution away stay in their slot until a later
+ * visit finds them due. An occupancy bitmap lets Advance and NextDeadline
+ * skip empty slots. Entries are never cancelled: a key that is deleted or
+ * rescheduled leaves a stale entry the caller skips when it fires.
+ *
+ * Times may use any unit (CTE uses nanoseconds, workers microseconds) as
+ * long as tick and deadlines agree. Not thread-safe.
+ */
+template <typename Key>
+class ExpiryWheel {
+ public:
+  static constexpr u64 kNoDeadline = ~0ull;  ///< NextDeadline of no entries
+
+  /**
+   * @param tick Width of one slot
+   * @param num_slots Slots per revolution
+   */
+  ExpiryWheel(u64 tick, size_t num_slots)
+      : slots_(std::max<size_t>(num_slots, 1)),
+        occupied_((slots_.size() + 63) / 64, 0),
+        tick_(std::max<u64>(tick, 1)) {}
+
+  /**
+   * File a deadline. A deadline in a tick Advance has already finished is
+   * checked on every Advance until it fires.
+   * @param key Key passed back when the deadline fires
+   * @param deadline Absolute time
+   */
+  void Schedule(const Key &key, u64 deadline) {
+    u64 tick = deadline / tick_;
+    if (tick < next_tick_) {
+      overdue_.push_back(Entry{key, deadline});
+    } else {
+      size_t slot = static_cast<size_t>(tick % slots_.size());
+      slots_[slot].push_back(Entry{key, deadline});
+      occupied_[slot / 64] |= 1ull << (slot % 64);
+    }
+    ++size_;
+  }
+
+  /**
+   * Fire every entry whose deadline is at or before now
+   * @param now Current time
+   * @param fire Called as fire(key, deadline) for each due entry
+   * @return Entries fired
+   */
+  template <typename F>
+  size_t Advance(u64 now, F &&fire) {
+    size_t fired = FireDue(overdue_, now, fire);
+    u64 now_tick = now / tick_;
+    if (now_tick >= next_tick_) {
+      // A gap of a whole revolution or more visits every slot once
+      u64 ticks = std::min<u64>(now_tick - next_tick_ + 1, slots_.size());
+      for (u64 i = 0; i < ticks; ++i) {
+        size_t slot = static_cast<size_t>((next_tick_ + i) % slots_.size());
+        if (!IsOccupied(slot)) {
+          continue;
+        }
+        fired += FireDue(slots_[slot], now, fire);
+        if (slots_[slot].empty()) {
+          occupied_[slot / 64] &= ~(1ull << (slot % 64));
+        }
+      }
+      // The current tick stays open for deadlines later in it
+      next_tick_ = now_tick;
+    }
+    size_ -= fired;
+    return fired;
+  }
+
+  /**
+   * Earliest deadline on the wheel, stale entries included. Visits the
+   * occupied slots in tick order and stops at the first one holding a
+   * deadline of the current revolution, so it rarely touches more than one
+   * slot's entries.
+   * @return Earliest deadline, or kNoDeadline if the wheel is empty
+   */
+  u64 NextDeadline() const {
+    u64 best = kNoDeadline;
+    for (const Entry &entry : overdue_) {
+      best = std::min(best, entry.deadline_);
+    }
+    size_t num_slots = slots_.size();
+    size_t start = static_cast<size_t>(next_tick_ % num_slots);
+    u64 revolution_end = next_tick_ + num_slots;
+    // Slots in tick order: [start, num_slots), then [0, start)
+    const size_t ranges[2][2] = {{start, num_slots}, {0, start}};
+    for (const auto &range : ranges) {
+      for (size_t slot = FindOccupied(range[0], range[1]); slot != kNoSlot;
+           slot = FindOccupied(slot + 1, range[1])) {
+        u64 slot_min = kNoDeadline;
+        for (const Entry &entry : slots_[slot]) {
+          slot_min = std::min(slot_min, entry.deadline_);
+        }
+        best = std::min(best, slot_min);
+        // Later slots only hold later ticks of this revolution
+        if (slot_min / tick_ < revolution_end) {
+          return best;
+        }
+      }
+    }
+    return best;
+  }
+
+  /** @return Entries scheduled and not yet fired, stale ones included */
+  size_t Size() const { return size_; }
+
+  /** @return Whether no entries are scheduled */
+  bool Empty() const { return size_ == 0; }
+
+  /** Drop every entry without firing it */
+  void Clear() {
+    for (std::vector<Entry> &slot : slots_) {
+      slot.clear();
+    }
+    std::fill(occupied_.begin(), occupied_.end(), 0);
+    overdue_.clear();
+    size_ = 0;
+  }
+
+ private:
+  struct Entry {
+    Key key_;
+    u64 deadline_;
+  };
+
+  static constexpr size_t kNoSlot = ~static_cast<size_t>(0);
+
+  /** @return Whether slot holds any entry */
+  bool IsOccupied(size_t slot) const {
+    return (occupied_[slot / 64] >> (slot % 64)) & 1;
+  }
+
+  /** @return First occupied slot in [begin, end), or kNoSlot */
+  size_t FindOccupied(size_t begin, size_t end) const {
+    while (begin < end) {
+      u64 word = occupied_[begin / 64] >> (begin % 64);
+      if (word != 0) {
+        size_t slot = begin + static_cast<size_t>(__builtin_ctzll(word));
+        return slot < end ? slot : kNoSlot;
+      }
+      begin = (begin / 64 + 1) * 64;
+    }
+    return kNoSlot;
+  }
+
+  /** Fire and drop the entries of one list that are due by now */
+  template <typename F>
+  static size_t FireDue(std::vector<Entry> &entries, u64 now, F &fire) {
+    auto kept = std::remove_if(entries.begin(), entries.end(),
+                               [&](const Entry &entry) {
+                                 if (entry.deadline_ > now) {
+                                   return false;
+                                 }
+                                 fire(entry.key_, entry.deadline_);
+                                 return true;
+                               });
+    size_t fired = static_cast<size_t>(entries.end() - kept);
+    entries.erase(kept, entries.end());
+    return fired;
+  }
+
+  std::vector<std::vector<Entry>> slots_;
+  std::vector<u64> occupied_;  // Bit per slot, set while it holds entries
+  std::vector<Entry> overdue_;  // Filed after their tick was visited
+  u64 tick_;
+  u64 next_tick_ = 0;  // First tick Advance has not finished
+  size_t size_ = 0;
+};
+
+}  // namespace chi
+
+#endif  // CHIMAERA_INCLUDE_CHIMAERA_EXPIRY_WHEEL_H_
@@ -36,6 +36,7 @@
 
 #include <coroutine>
 
+#include "chimaera/task_latency.h"
 #include "chimaera/types.h"
 #include "hermes_shm/lightbeam/shm_transport.h"
 #include "hermes_shm/memory/allocator/allocator.h"
@@ -63,7 +64,8 @@ struct RunContext;
  * - Fixed-size header fields (pool_id, method_id, etc.)
  * - Flexible array: char copy_space[]
  *
- * Allocation: AllocateBuffer(sizeof(FutureShm) + copy_space_size)
+ * Allocation: AllocateBuffer(sizeof(FutureShm) + copy_space_size), or
+ * AllocateStagingBuffer on the hot send paths (alloc_size_ records it)
  */
 struct FutureShm {
   // Bitfield flags for flags_
@@ -77,6 +79,8 @@ struct FutureShm {
       16; /**< GPU->GPU path: use device-scope atomics (no system fence) */
   static constexpr u32 FUTURE_POD_COPY =
       32; /**< POD cudaMemcpy path: no serialization, task is raw memcpy'd */
+  static constexpr u32 FUTURE_CREDIT_HELD =
+      64; /**< Task holds a ClientCreditTable credit in slot credit_slot_ */
 
   // Origin constants: how the client submitted this task
   static constexpr u32 FUTURE_CLIENT_SHM = 0; /**< Client used shared memory */
@@ -115,6 +119,9 @@ struct FutureShm {
   /** Client PID for per-client response routing */
   u32 client_pid_;
 
+  /** ClientCreditTable slot to return the credit to (FUTURE_CREDIT_HELD) */
+  u32 credit_slot_;
+
   /** SHM transfer info for input direction (client -> worker) */
   hshm::lbm::ShmTransferInfo input_;
 
@@ -153,6 +160,12 @@ struct FutureShm {
   /** sizeof(TaskT) for POD copy sizing */
   u32 task_size_;
 
+  /** Capacity from AllocateStagingBuffer (0 = release with FreeBuffer) */
+  u32 alloc_size_;
+
+  /** Submit time for lifecycle latency histograms (0 = not recorded) */
+  u64 submit_ns_;
+
   /** Copy space for serialized task data (flexible array member).
    *  Must be 4-byte aligned for WarpMemCpy uint32_t strided access. */
   char copy_space[];
@@ -167,6 +180,7 @@ struct FutureShm {
     origin_ = FUTURE_CLIENT_SHM;
     client_task_vaddr_ = 0;
     client_pid_ = 0;
+    credit_slot_ = 0;
     response_transport_ = nullptr;
     response_fd_ = -1;
     response_identity_len_ = 0;
@@ -175,6 +189,12 @@ struct FutureShm {
     total_warps_ = 1;
     task_device_ptr_ = 0;
     task_size_ = 0;
+    alloc_size_ = 0;
+#if HSHM_IS_HOST
+    submit_ns_ = TaskLatencyStats::Stamp();
+#else
+    submit_ns_ = 0;
+#endif
     flags_.Clear();
   }
 
@@ -193,6 +213,7 @@ struct FutureShm {
     parent_gpu_rctx_ = nullptr;
     task_device_ptr_ = 0;
     task_size_ = 0;
+    submit_ns_ = 0;
     flags_.Clear();
     input_.total_written_.store(0);
     input_.total_read_.store(0);
@@ -423,6 +444,15 @@ class Future {
    */
   HSHM_CROSS_FUN bool IsComplete() const;
 
+  /**
+   * Check whether Wait would return without waiting on task execution.
+   * True once the task completed or its response began streaming through
+   * the SHM ring (responses larger than the copy space are only marked
+   * complete after the client drains them). Used by CompletionQueue.
+   * @return True if the future is ready to be waited on
+   */
+  HSHM_HOST_FUN bool IsReady() const;
+
   /**
    * CPU-to-CPU completion check.
    * Reads FUTURE_COMPLETE via normal atomic load.
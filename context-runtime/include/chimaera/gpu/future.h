@@ -42,6 +42,7 @@ namespace gpu {
 
 // Forward declarations
 struct RunContext;
+struct Cpu2GpuDoneMap;
 
 // ============================================================================
 // gpu::FutureShm - Lightweight shared memory structure for GPU task futures
@@ -100,6 +101,13 @@ struct FutureShm {
   void *parent_gpu_rctx_;
   /** Device pointer to POD task for cudaMemcpy (POD copy paths) */
   uintptr_t task_device_ptr_;
+  /**
+   * Completion bitmap of a CPU→GPU task (pinned host), or null when
+   * completion is reported through flags_ alone
+   */
+  Cpu2GpuDoneMap *done_map_;
+  /** Bit of this task in done_map_ */
+  u32 done_slot_;
 
   /**
    * Default constructor - initializes all fields
@@ -112,6 +120,8 @@ struct FutureShm {
     task_size_ = 0;
     parent_gpu_rctx_ = nullptr;
     task_device_ptr_ = 0;
+    done_map_ = nullptr;
+    done_slot_ = 0;
     flags_.Clear();
   }
 
@@ -128,10 +138,81 @@ struct FutureShm {
     parent_gpu_rctx_ = nullptr;
     task_device_ptr_ = 0;
     task_size_ = 0;
+    done_map_ = nullptr;
+    done_slot_ = 0;
     flags_.Clear();
   }
 };
 
+// ============================================================================
+// gpu::Cpu2GpuDoneMap - Coalesced CPU→GPU completions
+// ============================================================================
+
+/**
+ * Completion bitmap for CPU→GPU tasks, in pinned host memory.
+ *
+ * Each task claims the next slot when it is sent and records the map in
+ * its FutureShm. The orchestrator relays the completions it finds in a
+ * poll round behind one system-scope fence, with one OR per 64-slot word,
+ * rather than a fence and a read-modify-write of each task's flags over
+ * PCIe. A waiter tests a whole batch with one
+ * load per word. Slots are reused round-robin, so at most kSlots tasks
+ * may be in flight, the same bound the wrap-around send pool relies on.
+ */
+struct Cpu2GpuDoneMap {
+  static constexpr u32 kWords = 64;
+  static constexpr u32 kSlots = kWords * 64;
+
+  /** One bit per slot, set by the GPU when the slot's task finishes */
+  unsigned long long words_[kWords];
+  /** Next slot to hand out (host only) */
+  unsigned long long next_slot_;
+
+#if HSHM_IS_HOST
+  /**
+   * Claim count consecutive slots and clear their bits.
+   * @param count Slots to claim; at most kSlots
+   * @return First slot; slot i of the batch is (first + i) % kSlots
+   */
+  u32 Claim(u32 count) {
+    u32 first = static_cast<u32>(
+        __atomic_fetch_add(&next_slot_, count, __ATOMIC_RELAXED) % kSlots);
+    for (u32 i = 0; i < count; ++i) {
+      u32 slot = (first + i) % kSlots;
+      __atomic_fetch_and(&words_[slot / 64], ~(1ull << (slot % 64)),
+                         __ATOMIC_RELAXED);
+    }
+    return first;
+  }
+
+  /** Whether the task in a slot has finished */
+  bool IsDone(u32 slot) const {
+    return (__atomic_load_n(&words_[slot / 64], __ATOMIC_ACQUIRE) >>
+            (slot % 64)) & 1ull;
+  }
+
+  /**
+   * Whether every task in count consecutive slots has finished.
+   * Reads each covered word once.
+   */
+  bool AllDone(u32 first, u32 count) const {
+    while (count > 0) {
+      u32 bit = first % 64;
+      u32 span = count < 64 - bit ? count : 64 - bit;
+      unsigned long long mask =
+          span == 64 ? ~0ull : (((1ull << span) - 1) << bit);
+      if ((__atomic_load_n(&words_[first / 64], __ATOMIC_ACQUIRE) & mask) !=
+          mask) {
+        return false;
+      }
+      first = (first + span) % kSlots;
+      count -= span;
+    }
+    return true;
+  }
+#endif
+};
+
 // ============================================================================
 // gpu::Future - Lightweight future for GPU task paths
 // ============================================================================
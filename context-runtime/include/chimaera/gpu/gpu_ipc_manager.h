@@ -51,6 +51,34 @@
 namespace chi {
 namespace gpu {
 
+/**
+ * Kernel-owned device memory registered for in-place task I/O.
+ *
+ * Addresses handed out by At() carry a null allocator id, so runtime tasks
+ * resolve them to the caller's memory instead of the partitioned heap. Reads
+ * such as bdev Read then write straight into this buffer and completion is
+ * observed through the task's FutureShm flags; no scratch buffer or result
+ * copy is involved. The memory stays owned by the kernel: FreeBuffer never
+ * releases it.
+ */
+struct GpuUserBuffer {
+  char *ptr_;    /**< Device address of the registered range */
+  size_t size_;  /**< Bytes in the registered range */
+
+  /** Whether [off, off + len) lies inside the registered range */
+  HSHM_CROSS_FUN bool Contains(size_t off, size_t len) const {
+    return ptr_ != nullptr && off <= size_ && len <= size_ - off;
+  }
+
+  /** Task data pointer for byte offset off of the registered range */
+  HSHM_CROSS_FUN hipc::ShmPtr<> At(size_t off) const {
+    hipc::ShmPtr<> shm;
+    shm.alloc_id_.SetNull();
+    shm.off_ = reinterpret_cast<size_t>(ptr_ + off);
+    return shm;
+  }
+};
+
 /**
  * GPU IPC infrastructure manager.
  *
@@ -211,6 +239,22 @@ class IpcManager {
     FreeBuffer(full_ptr);
   }
 
+  /**
+   * Register kernel-owned device memory as a task I/O destination.
+   * Register once at kernel start and pass GpuUserBuffer::At() slices to
+   * GetBlob / bdev Read tasks routed to the GPU runtime.
+   * @param ptr Device address owned by the calling kernel
+   * @param size Bytes available at ptr
+   * @return Handle for the range (null ptr_ if ptr is null)
+   */
+  HSHM_CROSS_FUN static GpuUserBuffer RegisterUserBuffer(void *ptr,
+                                                         size_t size) {
+    GpuUserBuffer buf;
+    buf.ptr_ = static_cast<char *>(ptr);
+    buf.size_ = ptr ? size : 0;
+    return buf;
+  }
+
   HSHM_CROSS_FUN hipc::Arena<hipc::RoundRobinAllocator> PushArena(
       size_t size) {
 #if HSHM_IS_GPU
@@ -471,6 +515,8 @@ class IpcManager {
   bool PauseGpuOrchestrator();
   void ResumeGpuOrchestrator();
   void SetGpuOrchestratorBlocks(u32 blocks, u32 threads_per_block = 0);
+  /** Tune idle backoff and load-driven pop burst live (no pause) */
+  void SetGpuOrchestratorElasticity(u32 max_pop_burst, u32 idle_sleep_max_ns);
   void PrintGpuOrchestratorProfile();
   void RebuildGpu2GpuQueue(u32 gpu_id, u32 new_lanes);
   void RebuildInternalQueue(u32 gpu_id, u32 new_lanes);
@@ -503,6 +549,7 @@ class IpcManager {
     char *cpu2gpu_fshm_pool = nullptr;   ///< Pinned host pool for [Task|FutureShm]
     size_t cpu2gpu_fshm_pool_size = 0;
     size_t cpu2gpu_fshm_next = 0;        ///< Simple bump allocator offset
+    gpu::Cpu2GpuDoneMap *cpu2gpu_done = nullptr;  ///< Completion bitmap
   };
 
   std::vector<GpuDeviceInfo> gpu_devices_;
@@ -37,6 +37,7 @@
 #include "chimaera/types.h"
 #include "chimaera/task.h"
 #include "chimaera/gpu/gpu_info.h"
+#include <chrono>
 #include <string>
 
 #if HSHM_ENABLE_CUDA || HSHM_ENABLE_ROCM
@@ -118,6 +119,22 @@ struct WorkOrchestratorControl {
   volatile long long prof_alloc_task_buddy[kMaxDebugWorkers];   /**< BuddyAlloc */
   volatile long long prof_alloc_task_ctor[kMaxDebugWorkers];    /**< placement new RunContext */
   volatile long long prof_alloc_task_deser[kMaxDebugWorkers];   /**< LoadTaskTmpl (deser) */
+
+  /** Elastic polling knobs. Written by the CPU at any time (no pause
+   *  needed) and re-read by the GPU worker every poll round. */
+  static constexpr unsigned int kDefaultPopBurst = 16;
+  static constexpr unsigned int kDefaultIdleSleepMaxNs = 20000;
+  static constexpr unsigned int kIdleSleepMinNs = 128;
+  volatile unsigned int max_pop_burst;      /**< Max pops per queue per round */
+  volatile unsigned int idle_sleep_max_ns;  /**< Idle backoff cap (0 = spin) */
+
+  /** Elasticity counters, accumulated across pause/resume cycles */
+  volatile long long prof_poll_rounds[kMaxDebugWorkers];
+  volatile long long prof_idle_rounds[kMaxDebugWorkers];
+  volatile long long prof_sleep_ns[kMaxDebugWorkers];
+  volatile long long prof_blocks_launched[kMaxDebugWorkers];
+  volatile unsigned int prof_peak_depth[kMaxDebugWorkers];
+  volatile unsigned int prof_peak_burst[kMaxDebugWorkers];
 };
 
 /**
@@ -142,6 +159,10 @@ class WorkOrchestrator {
   void *warp_group_queue_ptr_ = nullptr;  // GpuTaskQueue* on device
   u32 launched_num_warps_ = 0;            // Warp count at last Launch/Resume
 
+  // Wall time the orchestrator kernel has been running (for occupancy)
+  std::chrono::steady_clock::time_point run_start_;
+  u64 run_ns_ = 0;
+
   /**
    * Launch the GPU work orchestrator
    * @param gpu_info IPC info with queue pointers
@@ -179,6 +200,22 @@ class WorkOrchestrator {
    */
   void Resume(const IpcManagerGpuInfo &gpu_info);
 
+  /**
+   * Tune elastic polling on a running orchestrator. Takes effect on the
+   * next poll round; no Pause/Resume cycle is needed.
+   * @param max_pop_burst Max pops per queue per round when tasks back up
+   *        (0 = kDefaultPopBurst)
+   * @param idle_sleep_max_ns Ceiling of the idle backoff sleep; 0 keeps the
+   *        poller spinning
+   */
+  void SetElasticity(u32 max_pop_burst, u32 idle_sleep_max_ns);
+
+  /**
+   * Wall time the orchestrator kernel has run, including the current run
+   * @return Nanoseconds accumulated over all Launch/Resume cycles
+   */
+  u64 GetRunNs() const;
+
   /**
    * Register a GPU container with the device-side PoolManager.
    * Since all containers are allocated within this CUDA module,
@@ -76,22 +76,16 @@ class Worker;
 // ============================================================================
 
 /**
- * __global__ kernel launched by Worker::TryPopFromQueue() for each task.
+ * Execute one task method on the calling block.
  *
- * Executes the task method with the given parallelism (gridDim.x * blockDim.x).
- * Thread 0 marks completion after container->Run() returns.
- * Fire-and-forget: relies on CDP implicit synchronization at parent exit.
+ * Shared by the CDP child kernel (RunTask) and, on HIP, the orchestrator
+ * block itself. Does not mark completion; the caller does that once every
+ * participating thread has returned.
  */
-__global__ void RunTask(Container *container, u32 method,
-                        Task *task_raw, size_t task_shm_off,
-                        FutureShm *fshm, bool is_gpu2gpu,
-                        chi::IpcManagerGpuInfo *gpu_info_ptr) {
-  // Initialize IpcManager for this CDP child kernel block.
-  // Reattaches to the orchestrator's existing RoundRobinAllocator and
-  // claims a partition for this block.
-  chi::IpcManagerGpuInfo gpu_info = *gpu_info_ptr;
-  CHIMAERA_GPU_SUBTASK_INIT(gpu_info, gridDim.x);
-
+HSHM_INLINE_GPU_FUN void RunTaskBody(Container *container, u32 method,
+                                     Task *task_raw, size_t task_shm_off,
+                                     FutureShm *fshm, bool is_gpu2gpu,
+                                     u32 parallelism) {
   // Reconstruct FullPtr from raw pointer + offset (avoids passing
   // user-defined-copy-ctor type to kernel)
   hipc::FullPtr<Task> task_ptr;
@@ -99,13 +93,13 @@ __global__ void RunTask(Container *container, u32 method,
   task_ptr.shm_.off_ = task_shm_off;
   task_ptr.shm_.alloc_id_ = hipc::AllocatorId::GetNull();
 
-  // Construct RunContext on the stack of the child kernel
+  // Construct RunContext on the stack of the executing thread
   RunContext rctx;
   rctx.container_ = container;
   rctx.method_id_ = method;
   rctx.task_ptr_ = task_ptr;
   rctx.task_fshm_ = fshm;
-  rctx.parallelism_ = gridDim.x * blockDim.x;
+  rctx.parallelism_ = parallelism;
 
   // Fix up SSO/SVO pointers for CPU→GPU POD-copied tasks
   if (!is_gpu2gpu) {
@@ -114,17 +108,44 @@ __global__ void RunTask(Container *container, u32 method,
 
   // Execute the task method
   container->Run(method, task_ptr, rctx);
+}
+
+/**
+ * Mark a task complete via device-scope atomic.
+ * The fshm is always in device memory (even for CPU→GPU tasks, where it
+ * sits right after the task copy in device space). The orchestrator
+ * polls this flag and relays completion to the pinned-host FutureShm
+ * mirror via system-scope write (see RelayPendingCompletions).
+ */
+HSHM_INLINE_GPU_FUN void SignalTaskComplete(FutureShm *fshm) {
+  __threadfence();
+  atomicOr(reinterpret_cast<unsigned int*>(&fshm->flags_.bits_.x),
+           static_cast<unsigned int>(FutureShm::FUTURE_COMPLETE));
+  __threadfence();
+}
+
+/**
+ * __global__ kernel launched by Worker::TryPopFromQueue() for each task.
+ *
+ * Executes the task method with the given parallelism (gridDim.x * blockDim.x).
+ * Thread 0 marks completion after container->Run() returns.
+ * Fire-and-forget: relies on CDP implicit synchronization at parent exit.
+ */
+__global__ void RunTask(Container *container, u32 method,
+                        Task *task_raw, size_t task_shm_off,
+                        FutureShm *fshm, bool is_gpu2gpu,
+                        chi::IpcManagerGpuInfo *gpu_info_ptr) {
+  // Initialize IpcManager for this CDP child kernel block.
+  // Reattaches to the orchestrator's existing RoundRobinAllocator and
+  // claims a partition for this block.
+  chi::IpcManagerGpuInfo gpu_info = *gpu_info_ptr;
+  CHIMAERA_GPU_SUBTASK_INIT(gpu_info, gridDim.x);
+
+  RunTaskBody(container, method, task_raw, task_shm_off, fshm, is_gpu2gpu,
+              gridDim.x * blockDim.x);
 
-  // Thread 0 marks task as complete via device-scope atomic.
-  // The fshm is always in device memory (even for CPU→GPU tasks, where it
-  // sits right after the task copy in device space). The orchestrator parent
-  // kernel polls this flag and relays completion to the pinned-host FutureShm
-  // mirror via system-scope write (see RelayPendingCompletions).
   if (threadIdx.x == 0 && blockIdx.x == 0) {
-    __threadfence();
-    atomicOr(reinterpret_cast<unsigned int*>(&fshm->flags_.bits_.x),
-             static_cast<unsigned int>(FutureShm::FUTURE_COMPLETE));
-    __threadfence();
+    SignalTaskComplete(fshm);
   }
 }
 
@@ -163,6 +184,29 @@ class Worker {
   // Profiling counters
   long long prof_queue_pop_, prof_task_count_;
 
+  // Elastic polling state and counters
+  u32 sleep_ns_;  /**< Current idle backoff (0 = spinning) */
+  long long prof_poll_rounds_, prof_idle_rounds_, prof_sleep_ns_;
+  long long prof_blocks_launched_;
+  u32 prof_peak_depth_, prof_peak_burst_;
+
+#if HSHM_ENABLE_ROCM
+  /** A popped task waiting to run on the orchestrator block (HIP only) */
+  struct InlineTask {
+    Container *container_;
+    u32 method_;
+    Task *task_;
+    size_t task_shm_off_;
+    FutureShm *fshm_;
+    bool is_gpu2gpu_;
+  };
+  /** HIP has no dynamic parallelism, so popped tasks are parked here and
+   *  run by the whole orchestrator block after each poll round. */
+  static constexpr u32 kMaxInlineTasks = 16;
+  InlineTask inline_tasks_[kMaxInlineTasks];
+  u32 num_inline_;
+#endif
+
   HSHM_GPU_FUN void Init(u32 worker_id, GpuTaskQueue *cpu2gpu_queue,
                          GpuTaskQueue *gpu2gpu_queue, GpuTaskQueue *internal_queue,
                          PoolManager *pool_mgr, char *queue_backend_base,
@@ -183,6 +227,16 @@ class Worker {
     }
     prof_queue_pop_ = 0;
     prof_task_count_ = 0;
+    sleep_ns_ = 0;
+    prof_poll_rounds_ = 0;
+    prof_idle_rounds_ = 0;
+    prof_sleep_ns_ = 0;
+    prof_blocks_launched_ = 0;
+    prof_peak_depth_ = 0;
+    prof_peak_burst_ = 0;
+#if HSHM_ENABLE_ROCM
+    num_inline_ = 0;
+#endif
   }
 
   HSHM_GPU_FUN void FlushProfile() {
@@ -190,6 +244,17 @@ class Worker {
       return;
     dbg_ctrl_->prof_queue_pop[worker_id_] = prof_queue_pop_;
     dbg_ctrl_->prof_task_count[worker_id_] = prof_task_count_;
+    // Elasticity counters accumulate, like the host-side run time
+    u32 w = worker_id_;
+    dbg_ctrl_->prof_poll_rounds[w] = dbg_ctrl_->prof_poll_rounds[w] + prof_poll_rounds_;
+    dbg_ctrl_->prof_idle_rounds[w] = dbg_ctrl_->prof_idle_rounds[w] + prof_idle_rounds_;
+    dbg_ctrl_->prof_sleep_ns[w] = dbg_ctrl_->prof_sleep_ns[w] + prof_sleep_ns_;
+    dbg_ctrl_->prof_blocks_launched[w] =
+        dbg_ctrl_->prof_blocks_launched[w] + prof_blocks_launched_;
+    if (prof_peak_depth_ > dbg_ctrl_->prof_peak_depth[w])
+      dbg_ctrl_->prof_peak_depth[w] = prof_peak_depth_;
+    if (prof_peak_burst_ > dbg_ctrl_->prof_peak_burst[w])
+      dbg_ctrl_->prof_peak_burst[w] = prof_peak_burst_;
   }
 
   HSHM_GPU_FUN void Stop() { is_running_ = false; }
@@ -199,42 +264,133 @@ class Worker {
   // Main poll loop (thread 0 only)
   // ================================================================
 
-  /** Poll GPU→GPU queues (high priority) */
+  /**
+   * Poll GPU→GPU queues (high priority). The pop budget follows the
+   * backlog: one probe per queue when the queues are empty, growing with
+   * queue depth up to max_pop_burst pops per queue, so the number of
+   * RunTask blocks launched per round scales with load.
+   */
   HSHM_GPU_FUN int PollGpu2Gpu() {
+    u32 depth = QueueDepth(gpu2gpu_queue_, worker_id_);
+    u32 internal_depth = QueueDepth(internal_queue_, worker_id_);
+    if (internal_depth > depth) depth = internal_depth;
+    u32 budget = depth > 0 ? depth : 1;
+    u32 cap = GetMaxPopBurst();
+    if (budget > cap) budget = cap;
+    if (depth > prof_peak_depth_) prof_peak_depth_ = depth;
+    if (budget > prof_peak_burst_) prof_peak_burst_ = budget;
+
     int count = 0;
-    for (int i = 0; i < 16; ++i) {
-      count += TryPopFromQueue(gpu2gpu_queue_, worker_id_, true);
-      count += TryPopFromQueue(internal_queue_, worker_id_, true);
+    for (u32 i = 0; i < budget; ++i) {
+      int popped = TryPopFromQueue(gpu2gpu_queue_, worker_id_, true);
+      popped += TryPopFromQueue(internal_queue_, worker_id_, true);
+      if (popped == 0) break;
+      count += popped;
     }
     return count;
   }
 
-  /** Poll CPU→GPU queue AND check pending task completions */
+  /**
+   * Idle backoff, called once per poll round with the work it found.
+   * After an empty round the poller sleeps for an interval that doubles
+   * from kIdleSleepMinNs up to idle_sleep_max_ns, so an idle orchestrator
+   * issues almost no instructions on its SM; any work resets it to
+   * spinning. While CPU→GPU completions await relay the sleep stays at
+   * the minimum so their latency is not stretched.
+   */
+  HSHM_GPU_FUN void Backoff(int work) {
+    ++prof_poll_rounds_;
+    if (work > 0) {
+      sleep_ns_ = 0;
+      return;
+    }
+    ++prof_idle_rounds_;
+    u32 max_ns = dbg_ctrl_ ? dbg_ctrl_->idle_sleep_max_ns : 0;
+    if (max_ns == 0) return;
+    if (num_pending_ > 0 && max_ns > WorkOrchestratorControl::kIdleSleepMinNs) {
+      max_ns = WorkOrchestratorControl::kIdleSleepMinNs;
+    }
+    sleep_ns_ = sleep_ns_ == 0 ? WorkOrchestratorControl::kIdleSleepMinNs
+                               : sleep_ns_ * 2;
+    if (sleep_ns_ > max_ns) sleep_ns_ = max_ns;
+    SleepNs(sleep_ns_);
+    prof_sleep_ns_ += sleep_ns_;
+  }
+
+  /**
+   * Poll CPU→GPU queue AND check pending task completions.
+   *
+   * The queue lives in pinned host memory, so every head/tail access is a
+   * PCIe round trip. The backlog is drained with one PopBatch (one tail
+   * read, one head write), so the batch size follows queue depth, capped
+   * by the live max_pop_burst knob and the free completion-tracking
+   * slots; a client that pushed a batch behind one doorbell is picked up
+   * in the same round.
+   */
   HSHM_GPU_FUN int PollCpu2Gpu() {
     // Check pending CPU→GPU tasks for completion and relay to host
     RelayPendingCompletions();
-    return TryPopFromQueue(cpu2gpu_queue_, 0, false);
+    if (!cpu2gpu_queue_) return 0;
+    u32 budget = GetMaxPopBurst();
+    if (budget > kMaxPendingCpu2Gpu - num_pending_) {
+      budget = kMaxPendingCpu2Gpu - num_pending_;
+    }
+#if HSHM_ENABLE_ROCM
+    if (budget > kMaxInlineTasks - num_inline_) {
+      budget = kMaxInlineTasks - num_inline_;
+    }
+#endif
+    if (budget == 0) return 0;
+
+    auto &lane = cpu2gpu_queue_->GetLane(0, 0);
+    GPU_WORKER_TIMER_DEF(_qpop_tc);
+    GPU_WORKER_TIMER_START(_qpop_tc);
+    Future<Task> batch[kMaxPendingCpu2Gpu];
+    u32 popped = static_cast<u32>(lane.PopBatch(batch, budget));
+    if (popped == 0) return 0;
+    GPU_WORKER_TIMER_END(prof_queue_pop_, _qpop_tc);
+    if (popped > prof_peak_burst_) prof_peak_burst_ = popped;
+
+    int count = 0;
+    for (u32 i = 0; i < popped; ++i) {
+      DbgQueuePop();
+      count += DispatchPopped(batch[i], false);
+    }
+    return count;
   }
 
   /**
-   * Check pending CPU→GPU tasks. If a CDP child completed (device FutureShm
-   * has FUTURE_COMPLETE), relay the flag to the pinned-host FutureShm mirror
-   * via system-scope write so the CPU can see it.
+   * Check pending CPU→GPU tasks. CPU-visible completion needs a
+   * system-scope write (CDP child writes are visible to this parent
+   * kernel only), so the tasks found finished in one pass are published
+   * together: one system fence, then one atomicOr_system per done-map
+   * word they touch. Tasks without a done map get their pinned-host
+   * flags written instead.
    */
   HSHM_GPU_FUN void RelayPendingCompletions() {
+    unsigned long long *words[kMaxPendingCpu2Gpu];
+    unsigned long long masks[kMaxPendingCpu2Gpu];
+    FutureShm *flag_only[kMaxPendingCpu2Gpu];
+    u32 num_words = 0, num_flag_only = 0;
     for (u32 i = 0; i < num_pending_; ) {
       FutureShm *dev_fshm = pending_device_fshm_[i];
       FutureShm *host_fshm = pending_host_fshm_[i];
       // Parent kernel CAN see CDP child writes to device memory
       if (dev_fshm->flags_.AnyDevice(FutureShm::FUTURE_COMPLETE)) {
-        // Relay to pinned host via system-scope write (parent kernel writes
-        // ARE visible to CPU, unlike CDP child kernel writes)
-        __threadfence_system();
-        volatile u32 *host_flags = reinterpret_cast<volatile u32 *>(
-            &host_fshm->flags_.bits_.x);
-        u32 old_val = *host_flags;
-        *host_flags = old_val | FutureShm::FUTURE_COMPLETE;
-        __threadfence_system();
+        Cpu2GpuDoneMap *map = host_fshm->done_map_;
+        if (map) {
+          u32 slot = host_fshm->done_slot_;
+          unsigned long long *word = &map->words_[slot / 64];
+          u32 w = 0;
+          while (w < num_words && words[w] != word) ++w;
+          if (w == num_words) {
+            words[num_words] = word;
+            masks[num_words++] = 0;
+          }
+          masks[w] |= 1ull << (slot % 64);
+        } else {
+          flag_only[num_flag_only++] = host_fshm;
+        }
         // Remove from pending (swap with last)
         --num_pending_;
         pending_device_fshm_[i] = pending_device_fshm_[num_pending_];
@@ -244,8 +400,48 @@ class Worker {
         ++i;
       }
     }
+    if (num_words == 0 && num_flag_only == 0) return;
+
+    // Task results (written to pinned host) reach the CPU before the bits
+    __threadfence_system();
+    for (u32 w = 0; w < num_words; ++w) {
+      atomicOr_system(words[w], masks[w]);
+    }
+    for (u32 i = 0; i < num_flag_only; ++i) {
+      volatile u32 *host_flags = reinterpret_cast<volatile u32 *>(
+          &flag_only[i]->flags_.bits_.x);
+      u32 old_val = *host_flags;
+      *host_flags = old_val | FutureShm::FUTURE_COMPLETE;
+    }
+    __threadfence_system();
   }
 
+#if HSHM_ENABLE_ROCM
+  /**
+   * Run the tasks parked by this poll round. Called by every thread of the
+   * orchestrator block (after a __syncthreads that publishes num_inline_);
+   * each task gets the block's threads as its parallelism. Thread 0 marks
+   * completion once the whole block has returned from the task and then
+   * clears the batch.
+   */
+  HSHM_GPU_FUN void RunInlineTasks() {
+    u32 count = num_inline_;
+    for (u32 i = 0; i < count; ++i) {
+      InlineTask &t = inline_tasks_[i];
+      RunTaskBody(t.container_, t.method_, t.task_, t.task_shm_off_, t.fshm_,
+                  t.is_gpu2gpu_, blockDim.x);
+      __syncthreads();
+      if (threadIdx.x == 0) {
+        SignalTaskComplete(t.fshm_);
+      }
+    }
+    __syncthreads();
+    if (threadIdx.x == 0) {
+      num_inline_ = 0;
+    }
+  }
+#endif
+
   /** Poll all queues (backward-compatible) */
   HSHM_GPU_FUN int PollOnce() {
     DbgPoll();
@@ -257,12 +453,46 @@ class Worker {
   }
 
  private:
+  // ================================================================
+  // Elastic polling helpers
+  // ================================================================
+
+  /** Tasks waiting in a queue lane (tail - head) */
+  HSHM_GPU_FUN u32 QueueDepth(GpuTaskQueue *queue, u32 qlane) {
+    if (!queue) return 0;
+    auto &lane = queue->GetLane(qlane, 0);
+    u64 head = lane.GetHeadDevice();
+    u64 tail = lane.GetTailDevice();
+    return tail > head ? static_cast<u32>(tail - head) : 0;
+  }
+
+  /** Live pop-burst cap from the control block */
+  HSHM_GPU_FUN u32 GetMaxPopBurst() {
+    u32 cap = dbg_ctrl_ ? dbg_ctrl_->max_pop_burst : 0;
+    return cap ? cap : WorkOrchestratorControl::kDefaultPopBurst;
+  }
+
+  /** Yield the SM's issue slots for roughly ns nanoseconds */
+  HSHM_GPU_FUN static void SleepNs(u32 ns) {
+#if defined(HSHM_IS_ROCM_GPU)
+    for (u32 t = 0; t < ns; t += 64) __builtin_amdgcn_s_sleep(1);
+#elif defined(HSHM_CUDA_ARCH_GE_700)
+    __nanosleep(ns);
+#else
+    (void)ns;
+#endif
+  }
+
   // ================================================================
   // Queue polling and CDP launch
   // ================================================================
 
   HSHM_GPU_FUN int TryPopFromQueue(GpuTaskQueue *queue, u32 qlane, bool is_gpu2gpu) {
     if (!queue) return 0;
+#if HSHM_ENABLE_ROCM
+    // Leave the task queued until this round's inline batch has run
+    if (num_inline_ >= kMaxInlineTasks) return 0;
+#endif
 
     auto &lane = queue->GetLane(qlane, 0);
 
@@ -302,6 +532,15 @@ class Worker {
           dbg_ctrl_->dbg_iq_pops[worker_id_] + 1;
     }
 
+    return DispatchPopped(future, is_gpu2gpu);
+  }
+
+  /**
+   * Resolve a popped future to its task and launch it (or park it for the
+   * inline batch on HIP). CPU→GPU tasks are tracked for completion relay.
+   * @return 1 if the task was dispatched, 0 otherwise
+   */
+  HSHM_GPU_FUN int DispatchPopped(Future<Task> &future, bool is_gpu2gpu) {
     // Extract FutureShm from the popped future
     hipc::ShmPtr<FutureShm> sptr = future.GetFutureShmPtr();
     if (sptr.IsNull()) {
@@ -361,11 +600,23 @@ class Worker {
 
     DbgTaskPopped();
     ++prof_task_count_;
+    prof_blocks_launched_ += grid_dim;
 
     printf("[POP] pool=(%u,%u) method=%u grid=%u is_gpu2gpu=%d task=%p fshm=%p\n",
            pool_id.major_, pool_id.minor_, method_id, grid_dim,
            (int)is_gpu2gpu, (void*)task_ptr.ptr_, (void*)fshm);
 
+#if HSHM_ENABLE_ROCM
+    // No dynamic parallelism on HIP: park the task for the orchestrator
+    // block, which runs it right after this poll round.
+    InlineTask &slot = inline_tasks_[num_inline_++];
+    slot.container_ = container;
+    slot.method_ = method_id;
+    slot.task_ = task_ptr.ptr_;
+    slot.task_shm_off_ = task_ptr.shm_.off_.load();
+    slot.fshm_ = fshm;
+    slot.is_gpu2gpu_ = is_gpu2gpu;
+#else
     // Launch CDP child on an explicit non-blocking stream so multiple
     // children can run concurrently (default stream serializes them).
     cudaStream_t child_stream;
@@ -381,6 +632,7 @@ class Worker {
     } else {
       printf("[POP] RunTask launched OK\n");
     }
+#endif
 
     // Track CPU→GPU tasks for completion relay
     if (host_fshm_for_relay && num_pending_ < kMaxPendingCpu2Gpu) {
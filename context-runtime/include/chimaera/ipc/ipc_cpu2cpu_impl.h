@@ -17,14 +17,25 @@ Future<TaskT> IpcCpu2Cpu::ClientSend(IpcManager *ipc,
                                       const hipc::FullPtr<TaskT> &task_ptr) {
   if (task_ptr.IsNull()) return Future<TaskT>();
 
+  // Admission control: wait for a credit before taking client memory, so
+  // an overloaded runtime bounds what this client keeps in flight
+  u32 credit = ipc->AcquireSendCredit();
+
   // Allocate FutureShm with copy_space
   size_t copy_space_size = task_ptr->GetCopySpaceSize();
   if (copy_space_size == 0) copy_space_size = KILOBYTES(4);
   size_t alloc_size = sizeof(FutureShm) + copy_space_size;
-  auto buffer = ipc->AllocateBuffer(alloc_size);
-  if (buffer.IsNull()) return Future<TaskT>();
+  size_t capacity = 0;
+  auto buffer = ipc->AllocateStagingBuffer(alloc_size, capacity);
+  if (buffer.IsNull()) {
+    ipc->RefundSendCredit(credit);
+    return Future<TaskT>();
+  }
+  // Size-class rounding slack becomes extra copy space
+  copy_space_size = capacity - sizeof(FutureShm);
 
   FutureShm *future_shm = new (buffer.ptr_) FutureShm();
+  future_shm->alloc_size_ = static_cast<u32>(capacity);
   future_shm->pool_id_ = task_ptr->pool_id_;
   future_shm->method_id_ = task_ptr->method_;
   future_shm->origin_ = FutureShm::FUTURE_CLIENT_SHM;
@@ -32,6 +43,10 @@ Future<TaskT> IpcCpu2Cpu::ClientSend(IpcManager *ipc,
   future_shm->input_.copy_space_size_ = copy_space_size;
   future_shm->output_.copy_space_size_ = copy_space_size;
   future_shm->flags_.SetBits(FutureShm::FUTURE_COPY_FROM_CLIENT);
+  if (credit < ClientCreditTable::kNumSlots) {
+    future_shm->credit_slot_ = credit;
+    future_shm->flags_.SetBits(FutureShm::FUTURE_CREDIT_HELD);
+  }
 
   // Create Future
   auto future_shm_shmptr = buffer.shm_.template Cast<FutureShm>();
@@ -45,12 +60,7 @@ Future<TaskT> IpcCpu2Cpu::ClientSend(IpcManager *ipc,
   // Enqueue BEFORE sending (worker must start RecvMetadata concurrently)
   LaneId lane_id =
       ipc->scheduler_->ClientMapTask(ipc, future.template Cast<Task>());
-  auto &lane = ipc->worker_queues_->GetLane(lane_id, 0);
-  bool was_empty = lane.Empty();
-  lane.Push(future.template Cast<Task>());
-  if (was_empty) {
-    ipc->AwakenWorker(&lane);
-  }
+  ipc->EnqueueWorkerTask(lane_id, future.template Cast<Task>());
 
   SaveTaskArchive archive(MsgType::kSerializeIn,
                            ipc->shm_send_transport_.get());
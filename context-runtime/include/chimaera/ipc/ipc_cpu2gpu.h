@@ -28,6 +28,22 @@ struct IpcCpu2Gpu {
       gpu::IpcManager *ipc, const hipc::FullPtr<TaskT> &task_ptr,
       u32 gpu_id = 0);
 
+  /**
+   * Send several tasks with one queue doorbell per chunk. A chunk is as
+   * much of the batch as the queue has room for, up to 64 tasks. Their
+   * completions land in consecutive bits of the device's done map, so
+   * ClientWaitBatch can test the whole batch with a few loads.
+   * @param tasks Tasks to send; none may be null
+   * @param count Number of tasks; at most Cpu2GpuDoneMap::kSlots
+   * @param out Receives one future per task
+   * @return count, or 0 if nothing was sent (unknown device, a null task,
+   * or count above the done-map size, which is logged as an error)
+   */
+  template <typename TaskT>
+  static size_t ClientSendBatch(
+      gpu::IpcManager *ipc, const hipc::FullPtr<TaskT> *tasks,
+      size_t count, chi::Future<TaskT> *out, u32 gpu_id = 0);
+
   /** RuntimeRecv: handled by gpu::Worker::TryPopFromQueue (not called directly). */
 
   /** Set FUTURE_COMPLETE on CPU side. */
@@ -38,6 +54,39 @@ struct IpcCpu2Gpu {
   /** Client-side wait: poll pinned-host gpu::FutureShm, copy result D2H. */
   template <typename TaskT, typename AllocT>
   static bool ClientRecv(Future<TaskT, AllocT> &future, float max_sec);
+
+  /**
+   * Wait until every future of a batch has completed, without copying
+   * results back (ClientRecv does that). Consecutive done-map slots are
+   * checked a word at a time.
+   * @return false if max_sec (> 0) elapsed first
+   */
+  template <typename TaskT, typename AllocT>
+  static bool ClientWaitBatch(Future<TaskT, AllocT> *futures, size_t count,
+                              float max_sec);
+
+  /** Whether the GPU has finished the task of a pinned-host FutureShm. */
+  static bool IsComplete(const gpu::FutureShm *fshm);
+
+ private:
+  /**
+   * Copy a task into the pinned-host send pool and build its FutureShm.
+   * @param done_map Completion bitmap, or null for flag-only completion
+   * @param done_slot Bit of this task in done_map
+   * @return The task's FutureShm, which is what the queue carries
+   */
+  template <typename TaskT>
+  static gpu::FutureShm *StageTask(
+      gpu::IpcManager *ipc, const hipc::FullPtr<TaskT> &task_ptr,
+      u32 gpu_id, gpu::Cpu2GpuDoneMap *done_map, u32 done_slot);
+
+  /** Wrap a staged FutureShm for the queue */
+  static gpu::Future<Task> MakeQueueFuture(gpu::FutureShm *host_fshm);
+
+  /** Wrap a staged FutureShm for the client */
+  template <typename TaskT>
+  static chi::Future<TaskT> MakeClientFuture(
+      gpu::FutureShm *host_fshm, const hipc::FullPtr<TaskT> &task_ptr);
 };
 
 }  // namespace chi
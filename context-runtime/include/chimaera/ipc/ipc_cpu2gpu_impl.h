@@ -27,11 +27,9 @@ namespace chi {
  * - No device-synchronizing calls — safe while orchestrator is running
  */
 template <typename TaskT>
-chi::Future<TaskT> IpcCpu2Gpu::ClientSend(
-    gpu::IpcManager *ipc, const hipc::FullPtr<TaskT> &task_ptr, u32 gpu_id) {
-  if (task_ptr.IsNull() || gpu_id >= ipc->gpu_devices_.size()) {
-    return chi::Future<TaskT>();
-  }
+gpu::FutureShm *IpcCpu2Gpu::StageTask(
+    gpu::IpcManager *ipc, const hipc::FullPtr<TaskT> &task_ptr, u32 gpu_id,
+    gpu::Cpu2GpuDoneMap *done_map, u32 done_slot) {
   auto &dev = ipc->gpu_devices_[gpu_id];
 
   size_t task_size = sizeof(TaskT);
@@ -61,32 +59,127 @@ chi::Future<TaskT> IpcCpu2Gpu::ClientSend(
   host_fshm->client_task_vaddr_ = reinterpret_cast<uintptr_t>(pinned_buf);
   host_fshm->task_device_ptr_ = reinterpret_cast<uintptr_t>(pinned_buf);
   host_fshm->task_size_ = static_cast<u32>(task_size);
+  host_fshm->done_map_ = done_map;
+  host_fshm->done_slot_ = done_slot;
   host_fshm->flags_.SetBits(gpu::FutureShm::FUTURE_POD_COPY);
+  return host_fshm;
+}
 
-  // Push to cpu2gpu_queue (pinned host queue, GPU-accessible)
+inline gpu::Future<Task> IpcCpu2Gpu::MakeQueueFuture(
+    gpu::FutureShm *host_fshm) {
   hipc::ShmPtr<gpu::FutureShm> gpu_fshmptr;
   gpu_fshmptr.alloc_id_ = gpu::FutureShm::GetCpu2GpuAllocId();
   gpu_fshmptr.off_ = reinterpret_cast<size_t>(host_fshm);
-  auto &lane = dev.cpu2gpu_queue.ptr_->GetLane(0, 0);
-  gpu::Future<Task> task_future(gpu_fshmptr);
-  lane.Push(task_future);
+  return gpu::Future<Task>(gpu_fshmptr);
+}
 
-  // Return chi::Future (polls pinned-host FutureShm for completion)
+template <typename TaskT>
+chi::Future<TaskT> IpcCpu2Gpu::MakeClientFuture(
+    gpu::FutureShm *host_fshm, const hipc::FullPtr<TaskT> &task_ptr) {
+  // chi::Future polls the pinned-host FutureShm for completion
   hipc::ShmPtr<chi::FutureShm> chi_fshmptr;
   chi_fshmptr.alloc_id_ = gpu::FutureShm::GetCpu2GpuAllocId();
   chi_fshmptr.off_ = reinterpret_cast<size_t>(host_fshm);
   return chi::Future<TaskT>(chi_fshmptr, task_ptr);
 }
 
+/**
+ * CPU→GPU ClientSend using pre-allocated pools.
+ *
+ * - Task and FutureShm staged in the pinned host pool (no cudaMalloc)
+ * - Completion reported through a bit of the device's done map
+ * - No device-synchronizing calls — safe while orchestrator is running
+ */
+template <typename TaskT>
+chi::Future<TaskT> IpcCpu2Gpu::ClientSend(
+    gpu::IpcManager *ipc, const hipc::FullPtr<TaskT> &task_ptr, u32 gpu_id) {
+  if (task_ptr.IsNull() || gpu_id >= ipc->gpu_devices_.size()) {
+    return chi::Future<TaskT>();
+  }
+  auto &dev = ipc->gpu_devices_[gpu_id];
+  gpu::Cpu2GpuDoneMap *done_map = dev.cpu2gpu_done;
+  u32 slot = done_map ? done_map->Claim(1) : 0;
+  gpu::FutureShm *host_fshm = StageTask(ipc, task_ptr, gpu_id, done_map, slot);
+
+  // Push to cpu2gpu_queue (pinned host queue, GPU-accessible)
+  auto &lane = dev.cpu2gpu_queue.ptr_->GetLane(0, 0);
+  lane.Push(MakeQueueFuture(host_fshm));
+  return MakeClientFuture(host_fshm, task_ptr);
+}
+
+template <typename TaskT>
+size_t IpcCpu2Gpu::ClientSendBatch(
+    gpu::IpcManager *ipc, const hipc::FullPtr<TaskT> *tasks, size_t count,
+    chi::Future<TaskT> *out, u32 gpu_id) {
+  if (count == 0 || gpu_id >= ipc->gpu_devices_.size()) {
+    return 0;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (tasks[i].IsNull()) {
+      HLOG(kError, "ClientSendBatch: task {} of {} is null", i, count);
+      return 0;
+    }
+  }
+  auto &dev = ipc->gpu_devices_[gpu_id];
+  gpu::Cpu2GpuDoneMap *done_map = dev.cpu2gpu_done;
+  if (done_map && count > gpu::Cpu2GpuDoneMap::kSlots) {
+    // More tasks than slots would alias bits of tasks still in flight
+    HLOG(kError, "ClientSendBatch: {} tasks exceed the {} in-flight "
+         "completion slots of GPU {}", count, gpu::Cpu2GpuDoneMap::kSlots,
+         gpu_id);
+    return 0;
+  }
+  auto &lane = dev.cpu2gpu_queue.ptr_->GetLane(0, 0);
+  if (lane.Capacity() == 0) {
+    return 0;
+  }
+
+  // Each chunk is what the ring can take right now (at most kChunk), so
+  // an idle orchestrator gets the batch behind one doorbell and a busy one
+  // gets shorter pushes as it frees room, instead of a producer stalled
+  // on a full-chunk reservation.
+  constexpr size_t kChunk = 64;
+  gpu::Future<Task> staged[kChunk];
+  u32 first = done_map ? done_map->Claim(static_cast<u32>(count)) : 0;
+  for (size_t base = 0; base < count;) {
+    u64 depth = lane.GetTail() - lane.GetHead();
+    size_t room = depth < lane.Capacity() ? lane.Capacity() - depth : 1;
+    size_t n = count - base;
+    if (n > room) n = room;
+    if (n > kChunk) n = kChunk;
+    for (size_t i = 0; i < n; ++i) {
+      const hipc::FullPtr<TaskT> &task_ptr = tasks[base + i];
+      u32 slot = static_cast<u32>((first + base + i) %
+                                  gpu::Cpu2GpuDoneMap::kSlots);
+      gpu::FutureShm *host_fshm =
+          StageTask(ipc, task_ptr, gpu_id, done_map, slot);
+      staged[i] = MakeQueueFuture(host_fshm);
+      out[base + i] = MakeClientFuture(host_fshm, task_ptr);
+    }
+    lane.PushBatch(staged, n);
+    base += n;
+  }
+  return count;
+}
+
+inline bool IpcCpu2Gpu::IsComplete(const gpu::FutureShm *fshm) {
+  // The orchestrator reports through the done map; flags_ is still set
+  // directly for tasks it rejects (e.g., no container for the pool).
+  if (fshm->done_map_ && fshm->done_map_->IsDone(fshm->done_slot_)) {
+    return true;
+  }
+  return fshm->flags_.AnySystem(gpu::FutureShm::FUTURE_COMPLETE);
+}
+
 template <typename TaskT, typename AllocT>
 bool IpcCpu2Gpu::ClientRecv(Future<TaskT, AllocT> &future, float max_sec) {
   // ShmPtr offset points to pinned-host gpu::FutureShm
-  void *host_fshm = reinterpret_cast<void *>(future.future_shm_.off_.load());
+  auto *fshm = reinterpret_cast<gpu::FutureShm *>(
+      future.future_shm_.off_.load());
   auto start = std::chrono::steady_clock::now();
 
-  // Poll flags on pinned-host gpu::FutureShm (direct CPU read, no cudaMemcpy)
-  auto *fshm = reinterpret_cast<gpu::FutureShm *>(host_fshm);
-  while (!fshm->flags_.AnySystem(gpu::FutureShm::FUTURE_COMPLETE)) {
+  // Poll the pinned-host done map / flags (direct CPU read, no cudaMemcpy)
+  while (!IsComplete(fshm)) {
     HSHM_THREAD_MODEL->Yield();
     if (max_sec > 0) {
       float elapsed = std::chrono::duration<float>(
@@ -106,6 +199,50 @@ bool IpcCpu2Gpu::ClientRecv(Future<TaskT, AllocT> &future, float max_sec) {
   return true;
 }
 
+template <typename TaskT, typename AllocT>
+bool IpcCpu2Gpu::ClientWaitBatch(Future<TaskT, AllocT> *futures,
+                                 size_t count, float max_sec) {
+  auto start = std::chrono::steady_clock::now();
+  size_t i = 0;
+  while (i < count) {
+    auto *fshm = reinterpret_cast<gpu::FutureShm *>(
+        futures[i].future_shm_.off_.load());
+    // Extend the run of consecutive slots in the same map
+    size_t run = 1;
+    if (fshm->done_map_) {
+      while (i + run < count && run < gpu::Cpu2GpuDoneMap::kSlots) {
+        auto *next = reinterpret_cast<gpu::FutureShm *>(
+            futures[i + run].future_shm_.off_.load());
+        if (next->done_map_ != fshm->done_map_ ||
+            next->done_slot_ != (fshm->done_slot_ + run) %
+                                    gpu::Cpu2GpuDoneMap::kSlots) {
+          break;
+        }
+        ++run;
+      }
+    }
+    if (run > 1 && fshm->done_map_->AllDone(fshm->done_slot_,
+                                            static_cast<u32>(run))) {
+      i += run;
+      continue;
+    }
+    // Tasks the orchestrator rejects only set flags_, so an incomplete
+    // run is drained one task at a time.
+    if (IsComplete(fshm)) {
+      ++i;
+      continue;
+    }
+    HSHM_THREAD_MODEL->Yield();
+    if (max_sec > 0) {
+      float elapsed = std::chrono::duration<float>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+      if (elapsed >= max_sec) return false;
+    }
+  }
+  return true;
+}
+
 #endif  // HSHM_IS_HOST
 
 }  // namespace chi
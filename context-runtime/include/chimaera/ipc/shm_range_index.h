@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#ifndef CHIMAERA_INCLUDE_CHIMAERA_IPC_SHM_RANGE_INDEX_H_
+#define CHIMAERA_INCLUDE_CHIMAERA_IPC_SHM_RANGE_INDEX_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "chimaera/types.h"
+
+namespace chi {
+
+/**
+ * Address-sorted interval table mapping raw pointers to the shared-memory
+ * allocator whose data region contains them.
+ *
+ * Readers never lock: Find() binary-searches an immutable snapshot.
+ * Writers (serialized externally, e.g. by allocator_map_lock_) publish a new
+ * snapshot and free the old one after a grace period. The grace period uses
+ * two reader counters selected by an epoch parity bit (the SRCU scheme):
+ * a reader registers on the current parity before loading the snapshot,
+ * and the writer flips the parity and waits for the old side to drain.
+ *
+ * @tparam AllocT Allocator type stored in the table
+ */
+template <typename AllocT>
+class ShmRangeIndex {
+ public:
+  ShmRangeIndex() : snapshot_(new Snapshot()) {}
+
+  ~ShmRangeIndex() { delete snapshot_.load(std::memory_order_acquire); }
+
+  ShmRangeIndex(const ShmRangeIndex &) = delete;
+  ShmRangeIndex &operator=(const ShmRangeIndex &) = delete;
+
+  /**
+   * Find the allocator whose data region contains a pointer.
+   * Lock-free; O(log n) in the number of registered segments.
+   * @param ptr Raw pointer to resolve
+   * @return Owning allocator, or nullptr if the pointer is private memory
+   */
+  AllocT *Find(const void *ptr) const {
+    uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
+    u32 parity = ReadLock();
+    const Snapshot *snap = snapshot_.load(std::memory_order_seq_cst);
+    AllocT *result = snap->catch_all_;
+    const std::vector<Range> &ranges = snap->ranges_;
+    auto it = std::upper_bound(
+        ranges.begin(), ranges.end(), addr,
+        [](uintptr_t a, const Range &r) { return a < r.begin_; });
+    if (it != ranges.begin()) {
+      --it;
+      if (addr < it->end_) {
+        result = it->alloc_;
+      }
+    }
+    ReadUnlock(parity);
+    return result;
+  }
+
+  /**
+   * Replace the table contents with the given allocators.
+   * Must be serialized against other Rebuild calls. Returns only after no
+   * reader can still observe the previous table.
+   * @param allocs Allocators to index (nullptr entries are skipped)
+   */
+  void Rebuild(const std::vector<AllocT *> &allocs) {
+    auto *snap = new Snapshot();
+    snap->ranges_.reserve(allocs.size());
+    for (AllocT *alloc : allocs) {
+      if (alloc == nullptr) {
+        continue;
+      }
+      size_t capacity = alloc->GetBackendDataCapacity();
+      if (capacity == SIZE_MAX) {
+        // Unbounded backend: ContainsPtr() accepts every pointer
+        if (snap->catch_all_ == nullptr) {
+          snap->catch_all_ = alloc;
+        }
+        continue;
+      }
+      uintptr_t begin = reinterpret_cast<uintptr_t>(alloc->GetBackendData());
+      snap->ranges_.push_back(Range{begin, begin + capacity, alloc});
+    }
+    std::sort(snap->ranges_.begin(), snap->ranges_.end(),
+              [](const Range &a, const Range &b) {
+                return a.begin_ < b.begin_;
+              });
+    Snapshot *old = snapshot_.exchange(snap, std::memory_order_seq_cst);
+    Synchronize();
+    delete old;
+  }
+
+  /** @return Number of bounded ranges in the current table */
+  size_t Size() const {
+    u32 parity = ReadLock();
+    size_t size = snapshot_.load(std::memory_order_seq_cst)->ranges_.size();
+    ReadUnlock(parity);
+    return size;
+  }
+
+ private:
+  /** One allocator data region [begin_, end_) */
+  struct Range {
+    uintptr_t begin_;
+    uintptr_t end_;
+    AllocT *alloc_;
+  };
+
+  /** Immutable table published to readers */
+  struct Snapshot {
+    std::vector<Range> ranges_;
+    AllocT *catch_all_ = nullptr;
+  };
+
+  /** Reader counter padded to its own cache line */
+  struct alignas(64) ReaderCount {
+    std::atomic<u64> count_{0};
+  };
+
+  /**
+   * Register a reader on the current epoch parity.
+   * @return Parity to pass to ReadUnlock()
+   */
+  u32 ReadLock() const {
+    while (true) {
+      u32 parity = parity_.load(std::memory_order_seq_cst);
+      readers_[parity].count_.fetch_add(1, std::memory_order_seq_cst);
+      // A writer may have flipped between the load and the increment;
+      // retry so the writer waiting on the old parity cannot miss us
+      if (parity_.load(std::memory_order_seq_cst) == parity) {
+        return parity;
+      }
+      readers_[parity].count_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+  }
+
+  /** Unregister a reader. @param parity Value returned by ReadLock() */
+  void ReadUnlock(u32 parity) const {
+    readers_[parity].count_.fetch_sub(1, std::memory_order_release);
+  }
+
+  /** Wait until every reader that could see the old snapshot is done */
+  void Synchronize() {
+    u32 old_parity = parity_.load(std::memory_order_seq_cst);
+    parity_.store(old_parity ^ 1u, std::memory_order_seq_cst);
+    while (readers_[old_parity].count_.load(std::memory_order_acquire) != 0) {
+      HSHM_THREAD_MODEL->Yield();
+    }
+  }
+
+  std::atomic<Snapshot *> snapshot_;
+  std::atomic<u32> parity_{0};
+  mutable ReaderCount readers_[2];
+};
+
+}  // namespace chi
+
+#endif  // CHIMAERA_INCLUDE_CHIMAERA_IPC_SHM_RANGE_INDEX_H_
@@ -43,11 +43,14 @@
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "hermes_shm/data_structures/priv/array_vector.h"
 #include "hermes_shm/memory/allocator/round_robin_allocator.h"
 #include "chimaera/chimaera_manager.h"
+#include "chimaera/client_credits.h"
+#include "chimaera/lane_stats.h"
 #include "chimaera/corwlock.h"
 #include "chimaera/scheduler/scheduler.h"
 #include "chimaera/task.h"
@@ -59,6 +62,7 @@
 #include "chimaera/ipc/ipc_cpu2cpu_zmq.h"
 #include "chimaera/ipc/ipc_cpu2gpu.h"
 #include "chimaera/ipc/ipc_gpu2cpu.h"
+#include "chimaera/ipc/shm_range_index.h"
 #include "hermes_shm/data_structures/serialization/serialize_common.h"
 #include "hermes_shm/lightbeam/transport_factory_impl.h"
 #include "hermes_shm/memory/backend/posix_shm_mmap.h"
@@ -156,6 +160,17 @@ struct ClientShmInfo {
   }
 };
 
+/**
+ * Lands bulks received over ZeroMQ/socket transports in the runtime's
+ * data segment, so a remote or client task's data is written once into the
+ * shared-memory buffer the task then uses in place
+ */
+class ShmRecvAllocator : public hshm::lbm::RecvAllocator {
+ public:
+  hipc::FullPtr<char> Allocate(size_t size) override;
+  void Free(const hipc::FullPtr<char> &buf) override;
+};
+
 // IpcManagerGpuInfo and IpcManagerGpu are defined in gpu_info.h
 
 /**
@@ -299,6 +314,66 @@ class IpcManager {
    */
   FullPtr<char> AllocateBuffer(size_t size);
 
+  /**
+   * Allocate a buffer, page-locked for GPU DMA if pinned is set
+   * Pinned requests are rounded up to a power-of-two class (64KB .. 64MB)
+   * and carved from slabs the process registered with the GPU once, so
+   * H2D/D2H copies never re-register memory. Larger requests get a slab of
+   * their own. FreeBuffer returns them to the pool; free them in the
+   * process that allocated them. Without a GPU build, or when page-locking
+   * fails, this is AllocateBuffer(size).
+   * @param size Size in bytes to allocate
+   * @param pinned Whether to serve the buffer from the pinned pool
+   * @return FullPtr<char> to allocated memory, or null on failure
+   */
+  FullPtr<char> AllocateBuffer(size_t size, bool pinned);
+
+  /**
+   * Allocate a buffer from the calling thread's recycled staging pool
+   * Requests up to 16KB are rounded up to a power-of-two size class and
+   * served from buffers this thread released with FreeStagingBuffer,
+   * falling back to AllocateBuffer. Larger requests use AllocateBuffer
+   * @param size Minimum size in bytes
+   * @param capacity Output: usable size of the buffer, to be passed back to
+   *        FreeStagingBuffer
+   * @return FullPtr<char> to the buffer, or null on failure
+   */
+  FullPtr<char> AllocateStagingBuffer(size_t size, size_t &capacity);
+
+  /**
+   * Return a buffer from AllocateStagingBuffer to the calling thread's pool
+   * Buffers the pool cannot hold are released with FreeBuffer
+   * @param buffer_ptr Buffer to release
+   * @param capacity Capacity reported by AllocateStagingBuffer
+   */
+  void FreeStagingBuffer(FullPtr<char> buffer_ptr, size_t capacity);
+
+  /**
+   * Return a buffer to the pinned pool if it came from one of its slabs
+   * @param buffer_ptr Buffer to release
+   * @return true if the pool took the buffer
+   */
+  bool FreePinnedBuffer(FullPtr<char> buffer_ptr);
+
+  /**
+   * Allocate a long-lived user buffer in a dedicated client shm segment
+   * The segment is registered with the runtime like any other client
+   * segment, but AllocateBuffer never carves task data out of it. Raw
+   * pointers into the buffer resolve through ToFullPtr, so Tag::PutBlob and
+   * Tag::GetBlob hand them to the runtime without a staging copy. Outside
+   * client SHM mode this falls back to AllocateBuffer
+   * @param size Size of the buffer in bytes
+   * @return FullPtr<char> to the buffer, or null on failure
+   */
+  FullPtr<char> AllocateUserShm(size_t size);
+
+  /**
+   * Release a buffer from AllocateUserShm
+   * The segment stays mapped and is reused by later AllocateUserShm calls
+   * @param buffer_ptr Buffer to release
+   */
+  void FreeUserShm(FullPtr<char> buffer_ptr);
+
   /**
    * Push a bump arena for fast allocation.
    * All subsequent AllocateBuffer/NewObj/NewTask calls will bump-allocate
@@ -382,13 +457,17 @@ class IpcManager {
     size_t copy_space_size = task_ptr->GetCopySpaceSize();
     if (copy_space_size == 0) copy_space_size = KILOBYTES(4);
     size_t alloc_size = sizeof(FutureShm) + copy_space_size;
-    hipc::FullPtr<char> buffer = AllocateBuffer(alloc_size);
+    size_t capacity = 0;
+    hipc::FullPtr<char> buffer = AllocateStagingBuffer(alloc_size, capacity);
     if (buffer.IsNull()) {
       return Future<TaskT>();
     }
+    // Size-class rounding slack becomes extra copy space
+    copy_space_size = capacity - sizeof(FutureShm);
 
     // Construct FutureShm in-place
     FutureShm *future_shm_ptr = new (buffer.ptr_) FutureShm();
+    future_shm_ptr->alloc_size_ = static_cast<u32>(capacity);
     future_shm_ptr->pool_id_ = task_ptr->pool_id_;
     future_shm_ptr->method_id_ = task_ptr->method_;
     future_shm_ptr->origin_ = FutureShm::FUTURE_CLIENT_SHM;
@@ -423,10 +502,15 @@ class IpcManager {
     }
 
     // Allocate and construct FutureShm (no copy_space for runtime path)
-    hipc::FullPtr<FutureShm> future_shm = NewObj<FutureShm>();
-    if (future_shm.IsNull()) {
+    size_t capacity = 0;
+    hipc::FullPtr<char> buffer =
+        AllocateStagingBuffer(sizeof(FutureShm), capacity);
+    if (buffer.IsNull()) {
       return Future<TaskT>();
     }
+    new (buffer.ptr_) FutureShm();
+    hipc::FullPtr<FutureShm> future_shm = buffer.Cast<FutureShm>();
+    future_shm.ptr_->alloc_size_ = static_cast<u32>(capacity);
 
     // Initialize FutureShm fields
     future_shm.ptr_->pool_id_ = task_ptr->pool_id_;
@@ -646,6 +730,44 @@ class IpcManager {
 
   u64 GetWorkerQueuesOffset() const { return worker_queues_off_; }
 
+  /** @return SHM offset of the ClientCreditTable (0 = no flow control) */
+  u64 GetClientCreditsOffset() const { return client_credits_off_; }
+
+  /** @return SHM offset of the LaneStatsTable (0 = no load tracking) */
+  u64 GetLaneStatsOffset() const { return lane_stats_off_; }
+
+  /** @return Per-lane load estimates, or nullptr if unavailable */
+  LaneStatsTable *GetLaneStats() const { return lane_stats_; }
+
+  /**
+   * Check whether a SHM-mode Send would be admitted right now. Callers that
+   * must not block can poll this and back off instead (EAGAIN semantics).
+   * @return true if this client has a free credit or flow control is off
+   */
+  bool HasSendCredit() const;
+
+  /**
+   * Take an admission credit for a SHM-mode submission, waiting while the
+   * client is at its window. Client only.
+   * @return Credit slot to record in the task's FutureShm, or
+   *         ClientCreditTable::kNumSlots if no credit was taken
+   */
+  u32 AcquireSendCredit();
+
+  /**
+   * Return a credit taken by AcquireSendCredit() for a task never submitted
+   * @param slot Value returned by AcquireSendCredit()
+   */
+  void RefundSendCredit(u32 slot);
+
+  /**
+   * Return the admission credit held by a task, if any. Called by the
+   * worker that ends (or fails) the task.
+   * @param future_shm FutureShm of the task
+   * @param lane_depth Depth of the ending worker's lane, adapts the window
+   */
+  void ReleaseSendCredit(FutureShm *future_shm, size_t lane_depth);
+
   /**
    * Check if the runtime server process is alive
    * SHM mode: checks runtime PID via kill(pid, 0)
@@ -716,6 +838,22 @@ class IpcManager {
    */
   void AwakenWorker(TaskLane *lane);
 
+  /**
+   * Resume a task parked on a zero-delay yield (e.g. a CoEvent waiter).
+   * Queues a wake-up on the event queue of the task's worker, which
+   * resumes it on that worker's thread.
+   * @param run_ctx Context of the parked task
+   */
+  void ResumeParkedTask(RunContext *run_ctx);
+
+  /**
+   * Push a task onto a worker's queue and wake the worker if the lane was
+   * empty. High-priority tasks go to the worker's high-priority lane.
+   * @param lane_id Worker lane chosen by the scheduler
+   * @param future Future of the task to queue
+   */
+  void EnqueueWorkerTask(u32 lane_id, const Future<Task> &future);
+
   /**
    * Set the node ID in the shared memory header
    * @param hostname Hostname string to hash and store
@@ -831,11 +969,38 @@ class IpcManager {
 
   /**
    * Add a new node to the internal hostfile
+   *
+   * Each addition is one delta of the versioned host table. The node that
+   * starts the broadcast picks the node ID and version (AssignNodeId,
+   * GetHostTableVersion() + 1) so every receiver applies the same delta.
+   *
    * @param ip_address IP address of the new node
    * @param port Port of the new node's runtime
+   * @param node_id ID chosen by the origin, or kUnassignedNodeId to pick
+   *        the next free one here
+   * @param table_version Host table version after this delta, or 0 to
+   *        bump the local version
    * @return Assigned node ID for the new node
    */
-  u64 AddNode(const std::string &ip_address, u32 port);
+  u64 AddNode(const std::string &ip_address, u32 port,
+              u64 node_id = kUnassignedNodeId, u64 table_version = 0);
+
+  /**
+   * Node ID a new host would get: its current ID if already known,
+   * otherwise one past the largest ID in the table
+   * @param ip_address IP address of the host
+   * @return Node ID
+   */
+  u64 AssignNodeId(const std::string &ip_address) const;
+
+  /**
+   * Version of the host table, bumped by every AddNode delta
+   * @return Current version (0 = hostfile only)
+   */
+  u64 GetHostTableVersion() const { return host_table_version_; }
+
+  /** Node ID placeholder for an AddNode delta not yet assigned */
+  static constexpr u64 kUnassignedNodeId = ~0ULL;
 
   /**
    * Identify current host from hostfile by attempting TCP server binding
@@ -856,9 +1021,45 @@ class IpcManager {
    */
   /**
    * Get the main ZeroMQ server for network communication
+   * @param shard Network shard whose server to return (0 = config port)
    * @return Pointer to main server or nullptr if not initialized
    */
-  hshm::lbm::Transport *GetMainTransport() const;
+  hshm::lbm::Transport *GetMainTransport(u32 shard = 0) const;
+
+  /**
+   * Get the allocator that receive paths pass as LbmContext::recv_alloc_
+   * @return Allocator placing received bulks in the runtime data segment
+   */
+  hshm::lbm::RecvAllocator *GetRecvAllocator() { return &recv_allocator_; }
+
+  /**
+   * Get the number of network shards, each served by its own net worker,
+   * server port and NetQueue lane
+   * @return Shard count (runtime.net_workers, at least 1)
+   */
+  u32 GetNumNetShards() const { return num_net_shards_; }
+
+  /**
+   * Map a net_key (origin task address) to the network shard owning it
+   * Requester and responder compute the same shard from the same key
+   * @param net_key Task's net_key_
+   * @return Shard index in [0, GetNumNetShards())
+   */
+  u32 GetNetShard(size_t net_key) const {
+    if (num_net_shards_ <= 1) {
+      return 0;
+    }
+    return static_cast<u32>(((net_key * 0x9e3779b97f4a7c15ULL) >> 32) %
+                            num_net_shards_);
+  }
+
+  /**
+   * Get the port a network shard's server listens on
+   * Shard 0 uses the configured port; shard k uses port + 3 + k
+   * @param shard Network shard index
+   * @return Port number
+   */
+  u32 GetNetShardPort(u32 shard) const;
 
   /**
    * Get this host identified during host identification
@@ -956,11 +1157,11 @@ class IpcManager {
 
   /**
    * Convert raw pointer to FullPtr by checking allocators
-   * Uses ContainsPtr() on each allocator to find the matching one
-   * Checks main allocator first, then per-process allocators
+   * Checks the main allocator, then looks the address up in shm_range_index_,
+   * which covers every segment in alloc_map_ (owned and registered)
    * If no allocator contains the pointer, returns a FullPtr with null allocator
    * (private memory)
-   * Acquires reader lock on allocator_map_lock_ for thread-safe access
+   * Lock-free: does not take allocator_map_lock_
    * @param ptr The raw pointer to convert
    * @return FullPtr with matching allocator and pointer, or FullPtr with null
    * allocator if no match (private memory)
@@ -978,35 +1179,46 @@ class IpcManager {
     }
 
     // Check per-process shared memory allocators
-    // Acquire reader lock for thread-safe access
-    allocator_map_lock_.ReadLock();
-
-    hipc::FullPtr<T> result;
-    for (auto *alloc : alloc_vector_) {
-      if (alloc && alloc->ContainsPtr(ptr)) {
-        result = hipc::FullPtr<T>(alloc, ptr);
-        allocator_map_lock_.ReadUnlock();
-        return result;
-      }
+    hipc::MultiProcessAllocator *alloc = shm_range_index_.Find(ptr);
+    if (alloc) {
+      return hipc::FullPtr<T>(alloc, ptr);
     }
 
-    // Release the lock before returning
-    allocator_map_lock_.ReadUnlock();
-
     // No matching allocator found - treat as private memory
     // Return FullPtr with the raw pointer (null allocator ID)
     return hipc::FullPtr<T>(ptr);
   }
 
+  /**
+   * Find the shared-memory segment whose data region holds a pointer
+   * Checks the main segment, then shm_range_index_. Lock-free
+   * @param ptr Pointer to look up
+   * @param base Set to the start of the segment's data region
+   * @param size Set to the size of the segment's data region
+   * @return false if ptr is private memory or its segment is unbounded
+   */
+  bool FindShmSegment(const void *ptr, char **base, size_t *size);
+
+  /**
+   * Counter bumped before any segment is unmapped
+   * Callers that cache segment addresses (e.g. as pinned I/O buffers) drop
+   * them when it changes, since the address may be reused by a new segment
+   */
+  u64 GetShmUnmapEpoch() const {
+    return shm_unmap_epoch_.load(std::memory_order_acquire);
+  }
+
   /**
    * Get or create a persistent ZeroMQ client connection from the pool
    * Creates a new connection if one doesn't exist for the given address:port
    * Thread-safe using internal mutex protection
    * @param addr IP address to connect to
    * @param port Port number to connect to
+   * @param stripe Which of the parallel connections to addr:port to use
    * @return Pointer to the ZeroMQ client (owned by the pool)
    */
-  hshm::lbm::Transport *GetOrCreateClient(const std::string &addr, int port);
+  hshm::lbm::Transport *GetOrCreateClient(const std::string &addr, int port,
+                                          u32 stripe = 0);
 
   /**
    * Clear all cached client connections
@@ -1017,9 +1229,22 @@ class IpcManager {
   /**
    * Set the net worker's lane pointer for signaling on EnqueueNetTask
    * Called by scheduler after DivideWorkers assigns net_worker_
-   * @param lane Pointer to the net worker's TaskLane
+   * @param lane Pointer to the net worker's TaskLane, used for every shard
    */
-  void SetNetLane(TaskLane *lane) { net_lane_ = lane; }
+  void SetNetLane(TaskLane *lane) {
+    net_lanes_.assign(num_net_shards_, lane);
+  }
+
+  /**
+   * Set the lane of the net worker serving one network shard
+   * @param shard Network shard index
+   * @param lane Pointer to that net worker's TaskLane
+   */
+  void SetNetLane(u32 shard, TaskLane *lane) {
+    if (shard < net_lanes_.size()) {
+      net_lanes_[shard] = lane;
+    }
+  }
 
   /**
    * Enqueue a Future<SendTask> to the network queue
@@ -1032,9 +1257,11 @@ class IpcManager {
    * Try to pop a Future<SendTask> from the network queue
    * @param priority Network queue priority to pop from
    * @param future Output parameter for the popped Future
+   * @param shard Network shard (NetQueue lane) to pop from
    * @return true if a Future was popped, false if queue is empty
    */
-  bool TryPopNetTask(NetQueuePriority priority, Future<Task> &future);
+  bool TryPopNetTask(NetQueuePriority priority, Future<Task> &future,
+                     u32 shard = 0);
 
   /**
    * Get the network queue for direct access
@@ -1186,6 +1413,13 @@ class IpcManager {
    */
   bool ServerInitShm();
 
+  /**
+   * Fault in the main and queue segments in chunks on a background thread
+   * so workers and clients do not take first-touch faults on the hot path.
+   * Stops early when prefault_stop_ is set.
+   */
+  void PrefaultSegments();
+
   /**
    * Initialize memory segments for client
    * @return true if successful, false otherwise
@@ -1261,6 +1495,12 @@ class IpcManager {
   void SetGpuOrchestratorBlocks(u32 blocks, u32 threads_per_block = 0) {
 #if HSHM_ENABLE_CUDA || HSHM_ENABLE_ROCM
     if (auto *g = GetGpuIpcManager()) g->SetGpuOrchestratorBlocks(blocks, threads_per_block);
+#endif
+  }
+  void SetGpuOrchestratorElasticity(u32 max_pop_burst, u32 idle_sleep_max_ns) {
+#if HSHM_ENABLE_CUDA || HSHM_ENABLE_ROCM
+    if (auto *g = GetGpuIpcManager())
+      g->SetGpuOrchestratorElasticity(max_pop_burst, idle_sleep_max_ns);
 #endif
   }
   void PrintGpuOrchestratorProfile() {
@@ -1269,6 +1509,57 @@ class IpcManager {
 #endif
   }
 
+  /**
+   * Send a batch of tasks to a local GPU. The queue doorbell is rung once
+   * per queue-sized chunk instead of once per task, and the completions
+   * share consecutive bits of the device's done map (see WaitGpuBatch).
+   * @param tasks Tasks to send; routed like Send with ToLocalGpu. At most
+   *        gpu::Cpu2GpuDoneMap::kSlots (4096) tasks may be in flight
+   * @param gpu_id Target GPU device index
+   * @return One future per task, or empty if the batch was rejected
+   *         (unknown device, a null task, more than kSlots tasks) or there
+   *         is no GPU support; the batch is never sent in part
+   */
+  template <typename TaskT>
+  std::vector<Future<TaskT>> SendGpuBatch(
+      const std::vector<hipc::FullPtr<TaskT>> &tasks, u32 gpu_id = 0) {
+    std::vector<Future<TaskT>> futures;
+#if HSHM_ENABLE_CUDA || HSHM_ENABLE_ROCM
+    if (auto *g = GetGpuIpcManager()) {
+      futures.resize(tasks.size());
+      futures.resize(IpcCpu2Gpu::ClientSendBatch(
+          g, tasks.data(), tasks.size(), futures.data(), gpu_id));
+    }
+#else
+    (void)tasks;
+    (void)gpu_id;
+#endif
+    return futures;
+  }
+
+  /**
+   * Wait for a batch from SendGpuBatch, checking a done-map word per 64
+   * tasks, then copy each task's results back.
+   * @param futures Futures returned by SendGpuBatch
+   * @param max_sec Timeout for the whole batch (0 = wait forever)
+   * @return false if the batch timed out
+   */
+  template <typename TaskT>
+  bool WaitGpuBatch(std::vector<Future<TaskT>> &futures, float max_sec = 0) {
+#if HSHM_ENABLE_CUDA || HSHM_ENABLE_ROCM
+    if (!IpcCpu2Gpu::ClientWaitBatch(futures.data(), futures.size(),
+                                     max_sec)) {
+      return false;
+    }
+#else
+    (void)max_sec;
+#endif
+    for (auto &future : futures) {
+      future.Wait();
+    }
+    return true;
+  }
+
  private:
   /**
    * Initialize priority queues for client
@@ -1287,12 +1578,26 @@ class IpcManager {
   /**
    * Try to start main server on given hostname
    * Helper method for host identification
-   * Uses ZMQ port from ConfigManager and sets main_transport_
+   * Uses ZMQ port from ConfigManager and sets main_transport_, plus one
+   * server per additional network shard
    * @param hostname Hostname to bind to
    * @return true if server started successfully, false otherwise
    */
   bool TryStartMainServer(const std::string &hostname);
 
+  /**
+   * Create a runtime-to-runtime transport of the configured type
+   * (networking.transport). Falls back to ZeroMQ when libfabric is
+   * requested but not compiled in.
+   * @param addr Host to bind (server) or connect to (client)
+   * @param mode Server or client
+   * @param port Port to use
+   * @return The transport, or nullptr on failure
+   */
+  hshm::lbm::TransportPtr CreateNetTransport(const std::string &addr,
+                                             hshm::lbm::TransportMode mode,
+                                             u32 port);
+
   bool is_initialized_ = false;
 
   // Shared memory backend for main segment (task data, FutureShm)
@@ -1309,6 +1614,10 @@ class IpcManager {
   // Shared memory backend for queue segment (TaskQueue ring buffers)
   hipc::PosixShmMmap queue_backend_;
 
+  // Background prefault of the segments above (memory.prefault_segments)
+  std::thread prefault_thread_;
+  std::atomic<bool> prefault_stop_{false};
+
   // Allocator ID for queue segment
   hipc::AllocatorId queue_allocator_id_;
 
@@ -1334,11 +1643,25 @@ class IpcManager {
   // ClientInitQueues)
   u64 worker_queues_off_ = 0;
 
-  // Network queue for send operations (one lane, two priorities)
+  // Per-client admission credits in the queue segment (null = disabled)
+  ClientCreditTable *client_credits_ = nullptr;
+  u64 client_credits_off_ = 0;
+  // This client's slot in client_credits_
+  u32 credit_slot_ = ClientCreditTable::kNumSlots;
+  // Per-lane load estimates in the queue segment (null = hash mapping only)
+  LaneStatsTable *lane_stats_ = nullptr;
+  u64 lane_stats_off_ = 0;
+  // Longest a Send waits for a credit before submitting without one
+  static constexpr double kCreditWaitSec = 5.0;
+
+  // Network queue for send operations (one lane per shard, four priorities)
   hipc::FullPtr<NetQueue> net_queue_;
 
-  // Net worker's lane pointer for signaling on EnqueueNetTask
-  TaskLane *net_lane_ = nullptr;
+  // Number of network shards (NetQueue lanes, net workers, server ports)
+  u32 num_net_shards_ = 1;
+
+  // Each shard's net worker lane pointer for signaling on EnqueueNetTask
+  std::vector<TaskLane *> net_lanes_;
 
   // GPU task queues (one ring buffer per GPU device, empty when no GPU)
   std::vector<hipc::FullPtr<GpuTaskQueue>> gpu_queues_;
@@ -1349,6 +1672,12 @@ class IpcManager {
   // Main ZeroMQ transport (server mode) for distributed communication
   hshm::lbm::TransportPtr main_transport_;
 
+  // Servers of network shards 1..N-1 (shard 0 is main_transport_)
+  std::vector<hshm::lbm::TransportPtr> shard_transports_;
+
+  // Receive buffers for bulks arriving on ZeroMQ/socket transports
+  ShmRecvAllocator recv_allocator_;
+
   // IPC transport mode (TCP default, configurable via CHI_IPC_MODE)
   IpcMode ipc_mode_ = IpcMode::kTcp;
 
@@ -1393,6 +1722,7 @@ class IpcManager {
 
   // Hostfile management
   std::unordered_map<u64, Host> hostfile_map_;  // Map node_id -> Host
+  u64 host_table_version_ = 0;  // Number of AddNode deltas applied
   mutable std::vector<Host>
       hosts_cache_;  // Cached vector of hosts for GetAllHosts
   mutable bool hosts_cache_valid_ = false;  // Flag to track cache validity
@@ -1437,6 +1767,16 @@ class IpcManager {
    */
   std::unordered_map<u64, hipc::MultiProcessAllocator *> alloc_map_;
 
+  /**
+   * Address range index over alloc_map_ for raw-pointer resolution
+   * Rebuilt under the allocator_map_lock_ writer lock whenever alloc_map_
+   * changes; read lock-free by ToFullPtr(T *)
+   */
+  ShmRangeIndex<hipc::MultiProcessAllocator> shm_range_index_;
+
+  /** Bumped by RebuildShmRangeIndex when it unpublishes segments */
+  std::atomic<u64> shm_unmap_epoch_{0};
+
   /**
    * Map of AllocatorId -> {data_ptr, capacity} for GPU backend memory
    * Used by ToFullPtr to resolve ShmPtrs allocated by GPU kernels.
@@ -1486,6 +1826,41 @@ class IpcManager {
    */
   bool IncreaseClientShm(size_t size);
 
+  /**
+   * Create and register a new per-process shared memory segment
+   * Caller must hold shm_mutex_. Pooled segments join alloc_vector_ and
+   * become last_alloc_; user segments are additionally tracked in
+   * user_allocs_ so general allocation skips them
+   * @param size Size in bytes to allocate (32MB will be added for metadata)
+   * @param user_region Whether the segment backs AllocateUserShm buffers
+   * @return The new allocator, or nullptr on failure
+   */
+  hipc::MultiProcessAllocator *CreateClientShm(size_t size, bool user_region);
+
+  /**
+   * NUMA node whose client segments the calling thread should use
+   * @return Index into numa_last_alloc_, or -1 on single-node hosts
+   */
+  int ClientNumaNode() const;
+
+  /**
+   * Try every pooled client allocator that belongs to node
+   * Takes shm_mutex_. The allocator that succeeds becomes the node's
+   * fast-path allocator
+   * @param size Size in bytes to allocate
+   * @param node NUMA node to restrict the search to, or -1 for any node
+   */
+  FullPtr<char> AllocateFromClientShm(size_t size, int node);
+
+  /**
+   * Republish shm_range_index_ from alloc_map_
+   * Caller must hold the allocator_map_lock_ writer lock. Blocks until no
+   * reader can observe the previous index, so excluded segments may be
+   * unmapped once this returns
+   * @param exclude_keys alloc_map_ keys to leave out (about to be removed)
+   */
+  void RebuildShmRangeIndex(const std::vector<u64> &exclude_keys = {});
+
   /**
    * Vector of allocators owned by this process
    * Used for allocation attempts before calling IncreaseClientShm
@@ -1504,6 +1879,18 @@ class IpcManager {
    */
   hipc::MultiProcessAllocator *last_alloc_ = nullptr;
 
+  /**
+   * Per-NUMA-node fast-path allocators (empty on single-node hosts)
+   * Sized once in ClientInit; entries are written under shm_mutex_
+   */
+  std::vector<hipc::MultiProcessAllocator *> numa_last_alloc_;
+
+  /** NUMA node each pooled client segment is bound to */
+  std::unordered_map<hipc::MultiProcessAllocator *, int> alloc_numa_node_;
+
+  /** Allocators of segments created by AllocateUserShm */
+  std::unordered_set<hipc::MultiProcessAllocator *> user_allocs_;
+
   /** Mutex for thread-safe access to shared memory structures */
   mutable std::mutex shm_mutex_;
 #endif
@@ -1586,9 +1973,14 @@ HSHM_CROSS_FUN Future<TaskT, AllocT>::~Future() {
                            fs->origin_ == FutureShm::FUTURE_CLIENT_IPC)) {
         CHI_CPU_IPC->CleanupResponseArchive(fs->client_task_vaddr_);
       }
-      // Free FutureShm (host only)
-      hipc::ShmPtr<char> buffer_shm = future_shm_.template Cast<char>();
-      CHI_CPU_IPC->FreeBuffer(buffer_shm);
+      // Free FutureShm (host only); pooled ones go back to this thread
+      if (!fs.IsNull() && fs->alloc_size_ != 0) {
+        size_t capacity = fs->alloc_size_;
+        CHI_CPU_IPC->FreeStagingBuffer(fs.template Cast<char>(), capacity);
+      } else {
+        hipc::ShmPtr<char> buffer_shm = future_shm_.template Cast<char>();
+        CHI_CPU_IPC->FreeBuffer(buffer_shm);
+      }
       future_shm_.SetNull();
 #endif
     }
@@ -1643,6 +2035,27 @@ HSHM_CROSS_FUN bool Future<TaskT, AllocT>::IsComplete() const {
 #endif
 }
 
+template <typename TaskT, typename AllocT>
+HSHM_HOST_FUN bool Future<TaskT, AllocT>::IsReady() const {
+  if (task_ptr_.IsNull() || future_shm_.IsNull()) {
+    return true;
+  }
+  if (task_ptr_->task_flags_.Any(TASK_FIRE_AND_FORGET) || IsComplete()) {
+    return true;
+  }
+#if HSHM_ENABLE_CUDA || HSHM_ENABLE_ROCM
+  if (future_shm_.alloc_id_ == FutureShm::GetCpu2GpuAllocId()) {
+    return false;
+  }
+#endif
+  auto future_shm = GetFutureShm();
+  if (future_shm.IsNull()) {
+    return false;
+  }
+  return future_shm->output_.total_written_.load() >
+         future_shm->output_.total_read_.load();
+}
+
 template <typename TaskT, typename AllocT>
 HSHM_HOST_FUN bool Future<TaskT, AllocT>::IsCompleteCpu2Cpu() const {
   auto future_shm = GetFutureShm();
@@ -1665,15 +2078,8 @@ template <typename TaskT, typename AllocT>
 HSHM_HOST_FUN bool Future<TaskT, AllocT>::IsCompleteCpu2Gpu() const {
 #if HSHM_ENABLE_CUDA || HSHM_ENABLE_ROCM
   // ShmPtr offset points to pinned-host gpu::FutureShm
-  void *host_fshm = reinterpret_cast<void *>(future_shm_.off_.load());
-  u32 flags_val = 0;
-  size_t flags_offset = offsetof(gpu::FutureShm, flags_);
-  hshm::GpuApi::Memcpy(
-      &flags_val,
-      reinterpret_cast<u32 *>(
-          static_cast<char *>(host_fshm) + flags_offset),
-      sizeof(u32));
-  return (flags_val & gpu::FutureShm::FUTURE_COMPLETE) != 0;
+  return IpcCpu2Gpu::IsComplete(
+      reinterpret_cast<const gpu::FutureShm *>(future_shm_.off_.load()));
 #else
   return false;
 #endif
@@ -1738,7 +2144,19 @@ HSHM_CROSS_FUN bool Future<TaskT, AllocT>::Wait(float max_sec,
   if (is_gpu_future) {
     return WaitGpu2Cpu(max_sec, reuse_task);
   }
-  return WaitCpu2Cpu(max_sec, reuse_task);
+  // Copy the submit stamp first: WaitCpu2Cpu frees the FutureShm
+  u64 submit_ns = future_full->submit_ns_;
+  if (submit_ns == 0) {
+    return WaitCpu2Cpu(max_sec, reuse_task);
+  }
+  PoolId pool_id = future_full->pool_id_;
+  u32 method_id = future_full->method_id_;
+  bool ok = WaitCpu2Cpu(max_sec, reuse_task);
+  u64 now_ns = TaskLatencyStats::Now();
+  TaskLatencyStats::Client().Record(
+      pool_id, method_id, TaskStage::kWait,
+      now_ns > submit_ns ? now_ns - submit_ns : 0);
+  return ok;
 #endif
 }
 
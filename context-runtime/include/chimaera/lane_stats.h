@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#ifndef CHIMAERA_INCLUDE_CHIMAERA_LANE_STATS_H_
+#define CHIMAERA_INCLUDE_CHIMAERA_LANE_STATS_H_
+
+#include <atomic>
+
+#include "chimaera/types.h"
+
+namespace chi {
+
+/** Load and remap counters of one worker lane */
+struct LaneStatsEntry {
+  std::atomic<u32> load_us_;     /**< Expected wait published by the worker */
+  std::atomic<u64> remaps_in_;   /**< Client threads moved onto this lane */
+  std::atomic<u64> remaps_out_;  /**< Client threads moved off this lane */
+};
+
+/**
+ * Per-lane load estimates shared between the runtime and SHM clients.
+ *
+ * Lives in the queue segment. Each worker publishes the expected wait of its
+ * lane from PublishCounters(); the LocalScheduler of every client reads the
+ * loads to decide whether a client thread should leave its sticky lane.
+ * Lanes past kMaxLanes are never remapped and keep the hash mapping.
+ */
+class LaneStatsTable {
+ public:
+  static constexpr u32 kMaxLanes = 256;
+  /** Smallest load gap (us) worth giving up the current lane's cache */
+  static constexpr u32 kMinImbalanceUs = 100;
+
+  /** Zero every lane. Runtime only, before clients attach. */
+  void Init() {
+    for (u32 i = 0; i < kMaxLanes; ++i) {
+      lanes_[i].load_us_.store(0, std::memory_order_relaxed);
+      lanes_[i].remaps_in_.store(0, std::memory_order_relaxed);
+      lanes_[i].remaps_out_.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Publish the load of a lane
+   * @param lane Lane (worker) ID
+   * @param load_us Expected wait in microseconds
+   */
+  void SetLoad(u32 lane, float load_us) {
+    if (lane < kMaxLanes) {
+      lanes_[lane].load_us_.store(
+          load_us > 0 ? static_cast<u32>(load_us) : 0,
+          std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Get the last published load of a lane
+   * @param lane Lane (worker) ID
+   * @return Expected wait in microseconds, 0 if untracked
+   */
+  u32 GetLoad(u32 lane) const {
+    return lane < kMaxLanes
+               ? lanes_[lane].load_us_.load(std::memory_order_relaxed)
+               : 0;
+  }
+
+  /**
+   * Count a client thread moving between lanes
+   * @param from Lane the thread left
+   * @param to Lane the thread moved to
+   */
+  void RecordRemap(u32 from, u32 to) {
+    if (from < kMaxLanes && to < kMaxLanes) {
+      lanes_[from].remaps_out_.fetch_add(1, std::memory_order_relaxed);
+      lanes_[to].remaps_in_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  /** @return Client threads moved onto a lane */
+  u64 GetRemapsIn(u32 lane) const {
+    return lane < kMaxLanes
+               ? lanes_[lane].remaps_in_.load(std::memory_order_relaxed)
+               : 0;
+  }
+
+  /** @return Client threads moved off a lane */
+  u64 GetRemapsOut(u32 lane) const {
+    return lane < kMaxLanes
+               ? lanes_[lane].remaps_out_.load(std::memory_order_relaxed)
+               : 0;
+  }
+
+  /**
+   * Choose the lane a client thread should use next. The thread stays on
+   * cur unless the least loaded lane is both kMinImbalanceUs and 2x lighter,
+   * so small or transient differences never cost it its warm cache.
+   * @param cur Lane the thread uses now
+   * @param loads Load of each lane in microseconds
+   * @param num_lanes Number of entries in loads
+   * @return cur, or the lane to move to
+   */
+  static u32 PickLane(u32 cur, const u32 *loads, u32 num_lanes) {
+    if (cur >= num_lanes) {
+      return cur;
+    }
+    u32 best = cur;
+    for (u32 i = 0; i < num_lanes; ++i) {
+      if (loads[i] < loads[best]) {
+        best = i;
+      }
+    }
+    u32 cur_load = loads[cur];
+    u32 best_load = loads[best];
+    if (cur_load - best_load > kMinImbalanceUs && cur_load > 2 * best_load) {
+      return best;
+    }
+    return cur;
+  }
+
+  /**
+   * Choose the next lane from the published loads
+   * @param cur Lane the thread uses now
+   * @param num_lanes Number of lanes to consider
+   * @return cur, or the lane to move to
+   */
+  u32 PickLane(u32 cur, u32 num_lanes) const {
+    if (num_lanes > kMaxLanes) {
+      return cur;
+    }
+    u32 loads[kMaxLanes];
+    for (u32 i = 0; i < num_lanes; ++i) {
+      loads[i] = GetLoad(i);
+    }
+    return PickLane(cur, loads, num_lanes);
+  }
+
+ private:
+  LaneStatsEntry lanes_[kMaxLanes];
+};
+
+}  // namespace chi
+
+#endif  // CHIMAERA_INCLUDE_CHIMAERA_LANE_STATS_H_
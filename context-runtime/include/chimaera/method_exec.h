@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#ifndef CHIMAERA_INCLUDE_CHIMAERA_METHOD_EXEC_H_
+#define CHIMAERA_INCLUDE_CHIMAERA_METHOD_EXEC_H_
+
+#include <cstddef>
+
+#include "chimaera/ipc_manager.h"
+#include "chimaera/task.h"
+#include "chimaera/task_archives.h"
+
+namespace chi {
+
+/**
+ * Per-method entry of the dispatch table that autogenerated lib_exec files
+ * emit. It holds the typed serialization, allocation, and deletion
+ * functions, so the Container APIs do one indexed load instead of a switch.
+ */
+struct MethodExec {
+  void (*save_)(SaveTaskArchive &, const hipc::FullPtr<Task> &) = nullptr;
+  void (*load_)(LoadTaskArchive &, const hipc::FullPtr<Task> &) = nullptr;
+  void (*local_save_)(DefaultSaveArchive &,
+                      const hipc::FullPtr<Task> &) = nullptr;
+  void (*local_load_)(DefaultLoadArchive &,
+                      const hipc::FullPtr<Task> &) = nullptr;
+  hipc::FullPtr<Task> (*new_task_)() = nullptr;
+  hipc::FullPtr<Task> (*new_copy_)(const hipc::FullPtr<Task> &) = nullptr;
+  void (*aggregate_)(const hipc::FullPtr<Task> &,
+                     const hipc::FullPtr<Task> &) = nullptr;
+  void (*del_)(const hipc::FullPtr<Task> &) = nullptr;
+  size_t task_size_ = 0;  ///< sizeof the concrete task type
+
+  /** @return True if the entry belongs to an implemented method */
+  constexpr bool IsDefined() const { return new_task_ != nullptr; }
+};
+
+namespace detail {
+
+/** Typed implementations behind a MethodExec entry */
+template <typename TaskT>
+struct MethodExecOps {
+  static void Save(SaveTaskArchive &archive, const hipc::FullPtr<Task> &task) {
+    archive << *task.template Cast<TaskT>().ptr_;
+  }
+
+  static void Load(LoadTaskArchive &archive, const hipc::FullPtr<Task> &task) {
+    archive >> *task.template Cast<TaskT>().ptr_;
+  }
+
+  /** The archive operators respect the archive's msg_type */
+  static void LocalSave(DefaultSaveArchive &archive,
+                        const hipc::FullPtr<Task> &task) {
+    archive << *task.template Cast<TaskT>().ptr_;
+  }
+
+  static void LocalLoad(DefaultLoadArchive &archive,
+                        const hipc::FullPtr<Task> &task) {
+    archive >> *task.template Cast<TaskT>().ptr_;
+  }
+
+  static hipc::FullPtr<Task> New() {
+    auto *ipc_manager = CHI_IPC;
+    if (!ipc_manager) {
+      return hipc::FullPtr<Task>();
+    }
+    return ipc_manager->NewTask<TaskT>().template Cast<Task>();
+  }
+
+  /** Copies task fields, including the base Task fields */
+  static hipc::FullPtr<Task> NewCopy(const hipc::FullPtr<Task> &orig) {
+    auto *ipc_manager = CHI_IPC;
+    if (!ipc_manager) {
+      return hipc::FullPtr<Task>();
+    }
+    auto new_task_ptr = ipc_manager->NewTask<TaskT>();
+    if (new_task_ptr.IsNull()) {
+      return hipc::FullPtr<Task>();
+    }
+    new_task_ptr->Copy(orig.template Cast<TaskT>());
+    return new_task_ptr.template Cast<Task>();
+  }
+
+  static void Aggregate(const hipc::FullPtr<Task> &orig,
+                        const hipc::FullPtr<Task> &replica) {
+    orig.template Cast<TaskT>()->Aggregate(replica);
+  }
+
+  static void Del(const hipc::FullPtr<Task> &task) {
+    auto *ipc_manager = CHI_IPC;
+    if (!ipc_manager) return;
+    ipc_manager->DelTask(task.template Cast<TaskT>());
+  }
+};
+
+}  // namespace detail
+
+/**
+ * Build the dispatch table entry for a task type
+ * @return Entry whose functions cast to TaskT before operating
+ */
+template <typename TaskT>
+constexpr MethodExec MakeMethodExec() {
+  using Ops = detail::MethodExecOps<TaskT>;
+  MethodExec exec;
+  exec.save_ = &Ops::Save;
+  exec.load_ = &Ops::Load;
+  exec.local_save_ = &Ops::LocalSave;
+  exec.local_load_ = &Ops::LocalLoad;
+  exec.new_task_ = &Ops::New;
+  exec.new_copy_ = &Ops::NewCopy;
+  exec.aggregate_ = &Ops::Aggregate;
+  exec.del_ = &Ops::Del;
+  exec.task_size_ = sizeof(TaskT);
+  return exec;
+}
+
+/**
+ * Look up a method in a dispatch table
+ * @param table Table indexed by method ID
+ * @param method Method ID
+ * @return The entry, or nullptr if the method is out of range or unused
+ */
+template <size_t N>
+inline const MethodExec *FindMethodExec(const MethodExec (&table)[N],
+                                        u32 method) {
+  if (method >= N || !table[method].IsDefined()) {
+    return nullptr;
+  }
+  return &table[method];
+}
+
+}  // namespace chi
+
+#endif  // CHIMAERA_INCLUDE_CHIMAERA_METHOD_EXEC_H_
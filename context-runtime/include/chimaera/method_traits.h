@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#ifndef CHIMAERA_INCLUDE_CHIMAERA_METHOD_TRAITS_H_
+#define CHIMAERA_INCLUDE_CHIMAERA_METHOD_TRAITS_H_
+
+#include "chimaera/types.h"
+
+namespace chi {
+
+/**
+ * Scheduling class a method declares under method_traits in
+ * chimaera_mod.yaml. Schedulers read it instead of hardcoding method IDs.
+ */
+enum class MethodRoute : u32 {
+  kDefault = 0,   ///< Scheduler decides from runtime statistics
+  kNetwork = 1,   ///< Network Send/Recv; runs on a network worker
+  kIo = 2,        ///< Large or slow I/O; runs on an I/O worker
+  kMetadata = 3,  ///< Small metadata op; never sent to an I/O worker
+};
+
+/** The method ID is implemented by the ChiMod */
+static constexpr u32 kMethodDefined = (1u << 0);
+/** The method is listed in gpu_methods and has a GPU implementation */
+static constexpr u32 kMethodGpu = (1u << 1);
+
+/**
+ * Compile-time descriptor of one ChiMod method.
+ * The autogenerated methods header emits Method::kMethodTraits, a table of
+ * these indexed by method ID.
+ */
+struct MethodTraits {
+  MethodRoute route_ = MethodRoute::kDefault;  ///< Scheduling class
+  u32 flags_ = 0;                              ///< kMethod* bits
+  u64 io_size_hint_ = 0;  ///< Typical bytes moved per task (0 = unknown)
+
+  /** @return True if the method ID is implemented */
+  constexpr bool IsDefined() const { return flags_ & kMethodDefined; }
+
+  /** @return True if the method runs on network workers */
+  constexpr bool IsNetwork() const { return route_ == MethodRoute::kNetwork; }
+};
+
+/** Traits returned for method IDs with no table entry */
+inline constexpr MethodTraits kNoMethodTraits{};
+
+}  // namespace chi
+
+#endif  // CHIMAERA_INCLUDE_CHIMAERA_METHOD_TRAITS_H_
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#ifndef CHIMAERA_INCLUDE_CHIMAERA_METRICS_H_
+#define CHIMAERA_INCLUDE_CHIMAERA_METRICS_H_
+
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "chimaera/types.h"
+
+namespace chi {
+
+/** Metric family type, as in the Prometheus/OpenMetrics exposition formats */
+enum class MetricType {
+  kCounter,  ///< Monotonic total; samples get a _total suffix
+  kGauge,    ///< Value that can go up and down
+};
+
+/**
+ * Builds a Prometheus text (0.0.4) or OpenMetrics (1.0.0) exposition.
+ *
+ * Collectors select a family with Family() and then add samples to it.
+ * Samples are buffered per family, so several collectors may feed the same
+ * family (e.g. one per CTE pool) and it is still emitted contiguously.
+ */
+class MetricsWriter {
+ public:
+  using Labels = std::initializer_list<std::pair<const char *, std::string>>;
+
+  /**
+   * @param openmetrics Emit OpenMetrics instead of Prometheus text format
+   */
+  explicit MetricsWriter(bool openmetrics = false)
+      : openmetrics_(openmetrics), cur_(0) {}
+
+  /**
+   * Select (declaring on first use) the family later samples belong to.
+   * @param name Family name without the _total suffix
+   * @param type Counter or gauge
+   * @param help One-line description
+   */
+  void Family(const std::string &name, MetricType type,
+              const std::string &help);
+
+  /**
+   * Add an integer sample to the current family.
+   * @param labels Label name/value pairs
+   * @param value Sample value
+   */
+  void Sample(Labels labels, u64 value);
+
+  /**
+   * Add a floating-point sample to the current family.
+   * @param labels Label name/value pairs
+   * @param value Sample value
+   */
+  void Sample(Labels labels, double value);
+
+  /** @return The complete exposition text */
+  std::string Finish() const;
+
+  /** @return Content-Type header value matching the format */
+  const char *ContentType() const;
+
+ private:
+  struct FamilyBuf {
+    std::string name_;
+    MetricType type_;
+    std::string help_;
+    std::string body_;
+  };
+
+  /** Append "name{labels} " for the current family */
+  void BeginSample(Labels labels);
+
+  bool openmetrics_;
+  size_t cur_;
+  std::vector<FamilyBuf> families_;
+  std::unordered_map<std::string, size_t> index_;
+};
+
+/**
+ * Registry of metric collectors plus the embedded HTTP endpoint.
+ *
+ * Runtime components and ChiMods register a collector that snapshots their
+ * counters into a MetricsWriter; a scrape of GET /metrics runs every
+ * collector on the server thread. Collectors must only read state that is
+ * safe to read concurrently (atomics or lock-free ring sizes), so scrapes
+ * never stall workers. Unregister() waits for a running scrape, so a
+ * container may unregister in its destructor and then free its counters.
+ */
+class MetricsRegistry {
+ public:
+  using Collector = std::function<void(MetricsWriter &)>;
+
+  MetricsRegistry() = default;
+  ~MetricsRegistry();
+
+  /**
+   * Add or replace a collector.
+   * @param key Unique owner key (e.g. the pool id string)
+   * @param collector Callback filling the writer
+   */
+  void Register(const std::string &key, Collector collector);
+
+  /**
+   * Remove a collector; blocks while a scrape is running it.
+   * @param key Key given to Register()
+   */
+  void Unregister(const std::string &key);
+
+  /**
+   * Run every collector.
+   * @param writer Writer to fill
+   */
+  void Collect(MetricsWriter &writer);
+
+  /**
+   * Register the built-in worker, lane and network queue collector.
+   * Called once by the runtime after the workers start.
+   */
+  void RegisterRuntimeCollector();
+
+  /**
+   * Start serving GET /metrics.
+   * @param bind_addr IPv4 address to listen on
+   * @param port TCP port (0 = do not serve)
+   * @return true if the server is listening (or disabled), false on error
+   */
+  bool StartServer(const std::string &bind_addr, u32 port);
+
+  /** Stop the HTTP server and join its thread */
+  void StopServer();
+
+  /**
+   * Render a full response body.
+   * @param openmetrics Emit OpenMetrics instead of Prometheus text format
+   * @return Exposition text
+   */
+  std::string Render(bool openmetrics);
+
+ private:
+  /** Accept loop of the HTTP server thread */
+  void ServeLoop();
+
+  /** Read one request from a client socket and answer it */
+  void HandleConnection(int fd);
+
+  std::mutex lock_;
+  std::vector<std::pair<std::string, Collector>> collectors_;
+  int listen_fd_ = -1;
+  std::atomic<bool> stop_{false};
+  std::thread server_;
+};
+
+}  // namespace chi
+
+// Global pointer variable declaration for the metrics registry singleton
+HSHM_DEFINE_GLOBAL_PTR_VAR_H(chi::MetricsRegistry, g_metrics_registry);
+
+// Macro for accessing the metrics registry singleton
+#define CHI_METRICS \
+  HSHM_GET_GLOBAL_PTR_VAR(::chi::MetricsRegistry, g_metrics_registry)
+
+#endif  // CHIMAERA_INCLUDE_CHIMAERA_METRICS_H_
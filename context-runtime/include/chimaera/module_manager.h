@@ -38,6 +38,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <functional>
 #include "chimaera/types.h"
 
@@ -80,19 +81,23 @@ struct ChiModInfo {
  * 
  * Each ChiMod provides functions to query name and allocate ChiContainers.
  * Uses HSHM SharedLibrary for cross-platform dynamic loading.
+ *
+ * Init only records candidate libraries by file name; a library is opened
+ * the first time its ChiMod is requested, so startup does not pay for
+ * dlopen and static initializers of modules the node never uses.
  */
 class ModuleManager {
  public:
   /**
    * Initialize module manager (generic wrapper)
-   * Scans for and loads all available ChiMods
+   * Scans for available ChiMods
    * @return true if initialization successful, false otherwise
    */
   bool Init() { return ServerInit(); }
 
   /**
    * Initialize module manager (server/runtime only)
-   * Scans for and loads all available ChiMods
+   * Scans for available ChiMods
    * @return true if initialization successful, false otherwise
    */
   bool ServerInit();
@@ -110,7 +115,7 @@ class ModuleManager {
   bool LoadChiMod(const std::string& lib_path);
 
   /**
-   * Get ChiMod by name
+   * Get ChiMod by name, loading its library on first use
    * @param chimod_name Name of ChiMod
    * @return Pointer to ChiModInfo or nullptr if not found
    */
@@ -208,10 +213,43 @@ class ModuleManager {
    */
   bool ValidateChiMod(hshm::SharedLibrary& lib) const;
 
+  /**
+   * ChiMod name implied by a library file name
+   * (e.g., ".../libchimaera_bdev_runtime.so" -> "chimaera_bdev")
+   * @param file_path Path to shared object file
+   * @return Expected ChiMod name
+   */
+  std::string ChiModNameFromPath(const std::string& file_path) const;
+
+  /**
+   * LoadChiMod body; caller holds lock_
+   * @param lib_path Path to shared library
+   * @return true if loaded successfully, false otherwise
+   */
+  bool LoadChiModLocked(const std::string& lib_path);
+
+  /**
+   * Open the candidate libraries for a ChiMod; caller holds lock_.
+   * Falls back to opening every remaining candidate once, for libraries
+   * whose file name does not match the name they report.
+   * @param chimod_name Name of ChiMod
+   * @return Pointer to ChiModInfo or nullptr if not found
+   */
+  ChiModInfo* LoadLazyChiMod(const std::string& chimod_name);
+
   bool is_initialized_ = false;
   
   // Map ChiMod name to ChiModInfo
   std::map<std::string, std::unique_ptr<ChiModInfo>> chimods_;
+
+  // Unopened libraries keyed by file-derived name, in scan priority order
+  std::map<std::string, std::vector<std::string>> candidates_;
+
+  // Whether every candidate has been opened (name fallback done)
+  bool loaded_all_ = false;
+
+  // Pools of different ChiMods may be created concurrently
+  mutable std::mutex lock_;
 };
 
 }  // namespace chi
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#ifndef CHIMAERA_INCLUDE_CHIMAERA_POLL_CONTROLLER_H_
+#define CHIMAERA_INCLUDE_CHIMAERA_POLL_CONTROLLER_H_
+
+#include <string>
+
+#include "chimaera/types.h"
+
+namespace chi {
+
+/** Worker idle policy selected by runtime.poll_mode */
+enum class PollMode {
+  kSleep,     ///< Busy-wait first_busy_wait us, then epoll (legacy)
+  kBusy,      ///< Never sleep; lowest latency, one core per worker
+  kAdaptive,  ///< Pick busy/spin/epoll from arrival rate and latency target
+};
+
+/** What an idle worker should do on the current iteration */
+enum class PollAction {
+  kBusy,   ///< Return immediately and poll the lanes again
+  kSpin,   ///< Execute a short burst of CPU relax instructions, then poll
+  kSleep,  ///< Block in epoll until signaled or a periodic task is due
+};
+
+/** Counters describing the CPU versus wake-up latency trade-off */
+struct PollStats {
+  u64 idle_cpu_us_;          /**< Idle time spent polling or spinning */
+  u64 sleep_us_;             /**< Idle time spent blocked in epoll */
+  u64 busy_wakeups_;         /**< Arrivals picked up while busy polling */
+  u64 spin_wakeups_;         /**< Arrivals picked up while spinning */
+  u64 sleep_wakeups_;        /**< Arrivals picked up after an epoll sleep */
+  float wake_latency_p99_us_;  /**< Estimated p99 epoll wake-up latency */
+  float arrival_gap_us_;     /**< Moving average idle gap between arrivals */
+  u32 poll_window_us_;       /**< Current busy + spin window */
+
+  PollStats()
+      : idle_cpu_us_(0),
+        sleep_us_(0),
+        busy_wakeups_(0),
+        spin_wakeups_(0),
+        sleep_wakeups_(0),
+        wake_latency_p99_us_(0),
+        arrival_gap_us_(0),
+        poll_window_us_(0) {}
+};
+
+/**
+ * Per-worker controller that decides how an idle worker waits for work.
+ *
+ * In adaptive mode the controller keeps a moving average of the idle gap
+ * between arrivals and an estimate of the p99 latency of waking from
+ * epoll (measured as the overshoot of timed waits). If epoll wake-ups meet
+ * the configured target, the worker polls for about one average gap when
+ * that is under first_busy_wait, and otherwise sleeps at once. Otherwise it spins for
+ * up to two average gaps, bounded below by the target and above by
+ * max_spin_us, so batch nodes never burn more than that per idle period.
+ * The first quarter of the window is a plain busy poll; the rest issues
+ * CPU relax instructions to free the sibling hyperthread.
+ *
+ * One controller belongs to exactly one worker thread; it is not
+ * thread-safe.
+ */
+class PollController {
+ public:
+  PollController();
+
+  /**
+   * Set the policy parameters.
+   * @param mode Idle policy
+   * @param first_busy_wait_us Busy window for PollMode::kSleep, and the
+   *        window upper bound in adaptive mode when sleeping meets the target
+   * @param wake_target_us p99 wake-up latency target (0 = no target)
+   * @param max_spin_us Maximum busy + spin time per idle period
+   */
+  void Configure(PollMode mode, u32 first_busy_wait_us, u32 wake_target_us,
+                 u32 max_spin_us);
+
+  /**
+   * Parse a poll mode name ("sleep", "busy" or "adaptive").
+   * @param name Mode name from the configuration
+   * @return Parsed mode; unknown names map to PollMode::kSleep
+   */
+  static PollMode ParseMode(const std::string &name);
+
+  /**
+   * Decide how to wait on this idle iteration.
+   * @param elapsed_idle_us Time since the worker last did work
+   * @return Action to take
+   */
+  PollAction Decide(double elapsed_idle_us);
+
+  /**
+   * Record an epoll wait.
+   * @param timeout_us Timeout passed to the wait (-1 = infinite)
+   * @param actual_us Measured blocking time
+   * @param timed_out Whether the wait returned without an event
+   */
+  void RecordSleep(int timeout_us, double actual_us, bool timed_out);
+
+  /**
+   * Record that work arrived, ending an idle period.
+   * @param idle_us Total length of the idle period
+   */
+  void RecordArrival(double idle_us);
+
+  /**
+   * Execute a short burst of CPU relax instructions.
+   * Uses pause on x86 and yield on ARM; a no-op elsewhere.
+   */
+  static void Spin();
+
+  /** @return Current counters */
+  PollStats GetStats() const;
+
+ private:
+  /** @return Busy + spin window for the current estimates */
+  u32 ComputeWindowUs() const;
+
+  static constexpr u32 kSpinPauses = 64;           ///< Pauses per Spin()
+  static constexpr float kDefaultWakeUs = 50.0f;   ///< Prior wake latency
+  static constexpr float kEmaWeight = 0.1f;        ///< Estimator weight
+
+  PollMode mode_;
+  u32 first_busy_wait_us_;
+  u32 wake_target_us_;
+  u32 max_spin_us_;
+  u32 window_us_;           ///< Cached ComputeWindowUs()
+  float gap_avg_us_;        ///< EMA of idle gaps between arrivals
+  float wake_avg_us_;       ///< EMA of epoll wake overshoot
+  float wake_dev_us_;       ///< EMA of absolute deviation of overshoot
+  double period_sleep_us_;  ///< Time slept in the current idle period
+  bool slept_;              ///< Whether the current idle period slept
+  PollAction last_action_;  ///< Last action returned by Decide()
+  PollStats stats_;
+};
+
+}  // namespace chi
+
+#endif  // CHIMAERA_INCLUDE_CHIMAERA_POLL_CONTROLLER_H_
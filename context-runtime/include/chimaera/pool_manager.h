@@ -210,11 +210,22 @@ class PoolManager {
   bool ValidatePoolParams(const std::string& chimod_name, const std::string& pool_name);
 
   /**
-   * Initialize address map for a pool (ContainerId -> NodeId)
+   * Unregister and destroy the containers of a pool whose creation failed
+   * @param pool_id Pool identifier
+   * @param chimod_name ChiMod that created the containers
+   * @param shards Containers registered on this node so far
+   */
+  void DestroyShards(PoolId pool_id, const std::string& chimod_name,
+                     const std::vector<Container*>& shards);
+
+  /**
+   * Initialize address map for a pool (ContainerId -> NodeId). Containers
+   * are dealt round-robin, so container c lives on node c % num_nodes.
    * @param pool_id Pool identifier
    * @param num_containers Number of containers in the pool
+   * @param num_nodes Number of nodes in the cluster
    */
-  void InitAddressMap(PoolId pool_id, u32 num_containers);
+  void InitAddressMap(PoolId pool_id, u32 num_containers, u32 num_nodes);
 
   /**
    * Create or get a complete pool with get-or-create semantics
@@ -45,8 +45,16 @@ namespace chi {
 /**
  * Default scheduler implementation with I/O-size-based routing.
  * Routes tasks based on io_size_: small I/O and metadata go to the scheduler
- * worker (worker 0), large I/O (>= 4KB) goes to dedicated I/O workers via
- * round-robin, and network tasks go to the last worker.
+ * worker (worker 0), large I/O (>= 4KB) and methods whose moving-average
+ * cost exceeds 1ms go to the dedicated I/O worker with the shortest
+ * expected wait, and network tasks go to the last runtime.net_workers
+ * workers, one per network shard. When
+ * runtime.metadata_workers is above 1, small I/O and metadata are instead
+ * hashed by pool and container onto workers 0..metadata_workers-1, so each
+ * container's metadata stays on one worker while containers (e.g. CTE NUMA
+ * shards) spread across cores. A pool with one container per node gains
+ * nothing from it, which is why CTE pools default to metadata_workers
+ * containers per node.
  */
 class DefaultScheduler : public Scheduler {
  public:
@@ -63,15 +71,36 @@ class DefaultScheduler : public Scheduler {
   void AdjustPolling(RunContext *run_ctx) override;
   Worker *GetGpuWorker() const override { return gpu_worker_; }
   Worker *GetNetWorker() const override { return net_worker_; }
+  Worker *GetNetShardWorker(u32 shard) const override {
+    return shard < net_workers_.size() ? net_workers_[shard] : net_worker_;
+  }
 
  private:
   static constexpr size_t kLargeIOThreshold = 4096;  ///< I/O size threshold
+  static constexpr float kSlowTaskUs = 1000.0f;  ///< Avg cost marking I/O
+
+  /**
+   * Select the I/O worker with the smallest expected queueing delay.
+   * @param numa_node Prefer workers pinned to this NUMA node (-1: any)
+   * @return I/O worker; requires io_workers_ to be non-empty
+   */
+  Worker *PickLeastLoadedIoWorker(int numa_node = -1);
+
+  /**
+   * Select the metadata worker owning a routing key.
+   * @param key Metadata routing key
+   * @param numa_node Prefer workers pinned to this NUMA node (-1: any)
+   * @return Metadata worker; requires metadata_workers_ to be non-empty
+   */
+  Worker *PickMetadataWorker(u32 key, int numa_node);
 
   Worker *scheduler_worker_;              ///< Worker 0: metadata + small I/O
-  std::vector<Worker *> io_workers_;      ///< Workers 1..N-2: large I/O
-  Worker *net_worker_;                    ///< Worker N-1: network
+  std::vector<Worker *> metadata_workers_;  ///< Hash targets for metadata
+  std::vector<Worker *> io_workers_;      ///< Workers 1..N-K-1: large I/O
+  Worker *net_worker_;                    ///< Worker N-1: network shard 0
+  std::vector<Worker *> net_workers_;     ///< Workers N-1..N-K: net shards
   Worker *gpu_worker_;                    ///< GPU queue polling worker
-  std::atomic<u32> next_io_idx_{0};       ///< Round-robin index for I/O workers
+  std::atomic<u32> next_io_idx_{0};       ///< Rotating scan start for I/O workers
 };
 
 }  // namespace chi
@@ -44,7 +44,10 @@ namespace chi {
 
 /**
  * Local scheduler implementation.
- * Uses PID+TID hash-based lane mapping and provides no rebalancing.
+ * Each client thread starts on the lane its PID+TID hashes to and keeps
+ * using it, so its tasks stay warm in one worker's cache. Every
+ * kAffinityCheckInterval tasks the thread compares the per-lane loads in the
+ * LaneStatsTable and moves only when its lane is clearly overloaded.
  * All workers process tasks; scheduler tracks worker groups for routing decisions.
  */
 class LocalScheduler : public Scheduler {
@@ -62,8 +65,20 @@ class LocalScheduler : public Scheduler {
   Worker *GetNetWorker() const override { return net_worker_; }
 
  private:
+  /** Tasks a client thread submits between load checks */
+  static constexpr u32 kAffinityCheckInterval = 64;
+
   u32 MapByPidTid(u32 num_lanes);
 
+  /**
+   * Map the calling thread to its sticky lane, remapping it when the
+   * published lane loads are imbalanced
+   * @param ipc_manager IPC manager holding the LaneStatsTable
+   * @param num_lanes Number of scheduler lanes
+   * @return Lane ID
+   */
+  u32 MapByAffinity(IpcManager *ipc_manager, u32 num_lanes);
+
   std::vector<Worker *> scheduler_workers_;
   Worker *net_worker_;
   Worker *gpu_worker_;
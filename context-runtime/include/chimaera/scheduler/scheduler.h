@@ -118,6 +118,17 @@ class Scheduler {
    * @return Pointer to net worker, or nullptr if none assigned
    */
   virtual Worker *GetNetWorker() const { return nullptr; }
+
+  /**
+   * Get the network worker serving one network shard.
+   * Schedulers with a single net worker serve every shard on it.
+   * @param shard Network shard index (see IpcManager::GetNetShard)
+   * @return Pointer to the shard's net worker, or nullptr if none assigned
+   */
+  virtual Worker *GetNetShardWorker(u32 shard) const {
+    (void)shard;
+    return GetNetWorker();
+  }
 };
 
 }  // namespace chi
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#ifndef CHIMAERA_INCLUDE_CHIMAERA_SCHEDULER_WORK_STEALING_SCHED_H_
+#define CHIMAERA_INCLUDE_CHIMAERA_SCHEDULER_WORK_STEALING_SCHED_H_
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "chimaera/scheduler/scheduler.h"
+
+namespace chi {
+
+/**
+ * Work-stealing scheduler implementation.
+ * Client tasks are spread over all non-network workers by PID+TID hash and
+ * runtime tasks stay on the worker that routed them. A worker whose lane
+ * runs dry steals half of the backlog of a busy lane, preferring victims
+ * last seen on its own NUMA node. Tasks pinned by task-group affinity,
+ * periodic tasks, and tasks that already started are never stolen.
+ */
+class WorkStealingScheduler : public Scheduler {
+ public:
+  WorkStealingScheduler() : net_worker_(nullptr), gpu_worker_(nullptr) {}
+  ~WorkStealingScheduler() override = default;
+
+  void DivideWorkers(WorkOrchestrator *work_orch) override;
+  u32 ClientMapTask(IpcManager *ipc_manager, const Future<Task> &task) override;
+  u32 RuntimeMapTask(Worker *worker, const Future<Task> &task,
+                     Container *container) override;
+  void RebalanceWorker(Worker *worker) override;
+  void AdjustPolling(RunContext *run_ctx) override;
+  Worker *GetGpuWorker() const override { return gpu_worker_; }
+  Worker *GetNetWorker() const override { return net_worker_; }
+
+ private:
+  static constexpr size_t kMinVictimDepth = 2;  ///< Queued tasks worth stealing
+  static constexpr size_t kMaxStealBatch = 8;   ///< Tasks taken per steal
+
+  u32 MapByPidTid(u32 num_lanes);
+
+  /**
+   * Move up to count stealable tasks from a victim lane to a thief lane
+   * @param victim Worker to steal from
+   * @param thief Worker receiving the tasks
+   * @param count Maximum number of tasks to move
+   * @return Number of tasks moved
+   */
+  size_t StealFrom(Worker *victim, Worker *thief, size_t count);
+
+  /**
+   * Get the NUMA node \a worker runs on: its home node when pinned,
+   * otherwise the node of the CPU the caller is running on
+   * @param worker Calling worker
+   * @return NUMA node index (0 when unknown)
+   */
+  int GetCurrentNumaNode(Worker *worker) const;
+
+  std::vector<Worker *> sched_workers_;  ///< Workers that run tasks
+  std::unique_ptr<std::atomic<int>[]> worker_nodes_;  ///< Last seen node
+  Worker *net_worker_;
+  Worker *gpu_worker_;
+  std::atomic<u32> next_sched_idx_{0};
+};
+
+}  // namespace chi
+
+#endif  // CHIMAERA_INCLUDE_CHIMAERA_SCHEDULER_WORK_STEALING_SCHED_H_
@@ -45,6 +45,7 @@
 #include "chimaera/chimaera_manager.h"
 #include "chimaera/config_manager.h"
 #include "chimaera/ipc_manager.h"
+#include "chimaera/metrics.h"
 #include "chimaera/pool_manager.h"
 #include "chimaera/module_manager.h"
 #include "chimaera/work_orchestrator.h"
@@ -65,6 +66,7 @@
 // CHI_MODULE_MANAGER   - Module manager for dynamic loading
 // CHI_WORK_ORCHESTRATOR - Work orchestrator for thread management
 // CHI_ADMIN            - Admin ChiMod client singleton
+// CHI_METRICS          - Metrics collectors and the /metrics endpoint
 
 // All macros are defined in their respective header files:
 // - CHI_CHIMAERA_MANAGER defined in chimaera/chimaera_manager.h
@@ -74,6 +76,7 @@
 // - CHI_MODULE_MANAGER defined in chimaera/module_manager.h
 // - CHI_WORK_ORCHESTRATOR defined in chimaera/work_orchestrator.h
 // - CHI_ADMIN defined in chimaera/admin.h
+// - CHI_METRICS defined in chimaera/metrics.h
 
 /**
  * Example usage:
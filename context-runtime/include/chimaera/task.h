@@ -48,6 +48,7 @@ using pid_t = int;
 #include <sstream>
 #include <vector>
 
+#include "chimaera/coro_frame_pool.h"
 #include "chimaera/pool_query.h"
 #include "chimaera/types.h"
 #include "hermes_shm/data_structures/ipc/shm_container.h"
@@ -325,6 +326,34 @@ class Task {
    */
   HSHM_CROSS_FUN bool IsRemote() const { return task_flags_.Any(TASK_REMOTE); }
 
+  /**
+   * Check if task is latency-critical
+   * @return true if task has high priority flag set
+   */
+  HSHM_CROSS_FUN bool IsHighPriority() const {
+    return task_flags_.Any(TASK_HIGH_PRIORITY);
+  }
+
+  /**
+   * Get the scheduling priority, which selects the worker lane
+   * @return TaskPrio::kHigh if the high priority flag is set
+   */
+  HSHM_CROSS_FUN TaskPrio GetPriority() const {
+    return IsHighPriority() ? TaskPrio::kHigh : TaskPrio::kNormal;
+  }
+
+  /**
+   * Set the scheduling priority. Must be called before the task is sent.
+   * @param prio Priority to schedule the task with
+   */
+  HSHM_CROSS_FUN void SetPriority(TaskPrio prio) {
+    if (prio == TaskPrio::kHigh) {
+      task_flags_.SetBits(TASK_HIGH_PRIORITY);
+    } else {
+      task_flags_.UnsetBits(TASK_HIGH_PRIORITY);
+    }
+  }
+
   /**
    * Get task execution period in specified time unit
    * @param unit Time unit constant (kNano, kMicro, kMilli, kSec, kMin, kHour)
@@ -612,6 +641,8 @@ struct RunContext {
       0; /**< Predicted wall time from InferWallClockTime */
   TaskStat
       predicted_stat_; /**< TaskStat used for prediction (for reinforcement) */
+  u64 pop_ns_ = 0;   /**< Time a worker popped the task (0 = not recorded) */
+  u64 start_ns_ = 0; /**< Time the coroutine first ran (0 = not recorded) */
 
   RunContext()
       : coro_handle_(),
@@ -653,7 +684,9 @@ struct RunContext {
         predicted_load_(other.predicted_load_),
         wall_timer_(other.wall_timer_),
         predicted_wall_us_(other.predicted_wall_us_),
-        predicted_stat_(other.predicted_stat_) {
+        predicted_stat_(other.predicted_stat_),
+        pop_ns_(other.pop_ns_),
+        start_ns_(other.start_ns_) {
 #ifndef __NVCOMPILER
     other.coro_handle_ = nullptr;
 #else
@@ -689,6 +722,8 @@ struct RunContext {
       wall_timer_ = other.wall_timer_;
       predicted_wall_us_ = other.predicted_wall_us_;
       predicted_stat_ = other.predicted_stat_;
+      pop_ns_ = other.pop_ns_;
+      start_ns_ = other.start_ns_;
 #ifndef __NVCOMPILER
       other.coro_handle_ = nullptr;
 #else
@@ -722,6 +757,8 @@ struct RunContext {
     wall_timer_.time_ns_ = 0;
     predicted_wall_us_ = 0;
     predicted_stat_ = TaskStat();
+    pop_ns_ = 0;
+    start_ns_ = 0;
   }
 };
 
@@ -774,6 +811,7 @@ class TaskResume {
    * - initial_suspend: suspend immediately (lazy start)
    * - final_suspend: resume caller if exists, else suspend
    * - return_void: coroutines return void
+   * - operator new/delete: frames come from the per-thread CoroFramePool
    */
   struct promise_type {
     /** Pointer to the RunContext for this coroutine */
@@ -781,6 +819,23 @@ class TaskResume {
     /** Handle to the caller coroutine (for nested coroutine support) */
     std::coroutine_handle<> caller_handle_ = nullptr;
 
+    /**
+     * Allocate the coroutine frame from the frame pool
+     * @param size Frame size chosen by the compiler
+     * @return Frame storage
+     */
+    static void* operator new(size_t size) {
+      return CoroFramePool::Allocate(size);
+    }
+
+    /**
+     * Return the coroutine frame to the frame pool
+     * @param ptr Frame storage
+     */
+    static void operator delete(void* ptr) noexcept {
+      CoroFramePool::Free(ptr);
+    }
+
     /**
      * Create the TaskResume object from this promise
      * @return TaskResume wrapping the coroutine handle
@@ -968,37 +1023,34 @@ class TaskResume {
   // ============================================================
 
   /**
-   * Check if the coroutine is already done
-   * @return True if coroutine completed, false otherwise
+   * Check if there is nothing left to run
+   * @return True if coroutine completed or there is none, false otherwise
    */
-  bool await_ready() const noexcept { return handle_ && handle_.done(); }
+  bool await_ready() const noexcept { return !handle_ || handle_.done(); }
 
   /**
-   * Suspend the calling coroutine and run this one to completion or suspension
+   * Suspend the calling coroutine and transfer control to this one
    *
-   * This runs the inner coroutine (TaskResume) until it either:
-   * - Completes (co_return)
-   * - Suspends at a co_await (is_yielded_ is true)
+   * Symmetric transfer: the inner coroutine (TaskResume) is resumed as a
+   * tail call of the caller's suspension rather than a nested resume(), so
+   * chains of CHI_CO_AWAIT do not grow the worker stack. The inner runs
+   * until it either:
+   * - Completes (co_return): its FinalAwaiter transfers straight back to
+   *   the caller, which continues in the same worker dispatch
+   * - Suspends at a co_await on a Future: control returns to the worker,
+   *   and the inner's handle is in run_ctx->coro_handle_. When the inner
+   *   later completes, FinalAwaiter resumes the caller the same way.
    *
    * IMPORTANT: Propagates the RunContext from the caller to the inner coroutine
    * so that nested co_await calls on Futures work correctly.
    *
-   * When the inner coroutine suspends on a Future, the caller is also
-   * suspended. When the awaited Future completes, the inner coroutine's handle
-   * (stored in run_ctx->coro_handle_) is resumed. The await_resume of this
-   * TaskResume will then continue running the inner coroutine to completion.
-   *
    * @tparam PromiseT The promise type of the calling coroutine
    * @param caller_handle The coroutine handle of the caller
-   * @return True if we should suspend (inner suspended), false if inner
-   * completed
+   * @return Handle of the inner coroutine to resume
    */
   template <typename PromiseT>
-  bool await_suspend(std::coroutine_handle<PromiseT> caller_handle) noexcept {
-    if (!handle_) {
-      return false;  // Nothing to run, don't suspend
-    }
-
+  std::coroutine_handle<> await_suspend(
+      std::coroutine_handle<PromiseT> caller_handle) noexcept {
     // Store caller handle for await_resume to use when updating run_ctx
     caller_handle_ = caller_handle;
 
@@ -1009,33 +1061,10 @@ class TaskResume {
       handle_.promise().set_run_context(caller_run_ctx);
     }
 
-    // NOTE: We do NOT set caller_handle in inner's promise yet!
-    // If the inner coroutine completes synchronously during resume(),
-    // final_suspend would try to resume caller while we're still inside
-    // await_suspend, causing undefined behavior. We only set it after
-    // confirming suspension.
-
-    // Resume the inner coroutine
-    handle_.resume();
-
-    // Check if inner coroutine is done
-    if (handle_.done()) {
-      // Inner completed synchronously, destroy it
-      handle_.destroy();
-      handle_ = nullptr;
-      return false;  // Don't suspend caller
-    }
-
-    // Inner coroutine suspended (on co_await Future or yield)
-    // NOW it's safe to set caller_handle - the inner will complete
-    // asynchronously and final_suspend will properly resume the caller
+    // The caller is already suspended here, so the inner's final_suspend
+    // may resume it whether the inner finishes now or after a Future
     handle_.promise().set_caller(caller_handle);
-
-    // The inner's handle is now stored in run_ctx->coro_handle_ by
-    // Future::await_suspend When the awaited Future completes, worker will
-    // resume inner via run_ctx->coro_handle_ When inner eventually completes,
-    // final_suspend will resume the caller (this coroutine)
-    return true;
+    return handle_;
   }
 
   /**
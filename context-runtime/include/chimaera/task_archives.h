@@ -63,6 +63,33 @@ enum class MsgType : uint8_t {
   kHeartbeat = 2     /**< Heartbeat message (no task data) */
 };
 
+/** Identifies a network task archive on the wire ("CHIW") */
+static constexpr u32 kTaskWireMagic = 0x57494843;
+/**
+ * Task archive wire format version. Bump it whenever the layout of the
+ * archive or of any task's SerializeIn/SerializeOut changes, so mismatched
+ * peers reject each other's messages instead of misreading them.
+ */
+static constexpr u32 kTaskWireVersion = 2;
+
+/** Wire codecs a runtime can decode, advertised in NetTaskArchive */
+static constexpr u32 kWireCodecLz4 = 1u << 0;
+static constexpr u32 kWireCodecZstd = 1u << 1;
+
+/**
+ * A bulk the sender compressed. The bulk's descriptor carries the
+ * compressed size; the receiver restores raw_size_ bytes before decoding
+ */
+struct BulkCodec {
+  u32 bulk_idx_;   /**< Index of the bulk in send/recv */
+  u32 library_id_; /**< CompressionFactory library id of the codec */
+  u64 raw_size_;   /**< Bulk size before compression */
+
+  template <class Archive> void serialize(Archive &ar) {
+    ar(bulk_idx_, library_id_, raw_size_);
+  }
+};
+
 /**
  * Common task information structure used by network task archives
  */
@@ -88,11 +115,16 @@ struct TaskInfo {
  * NetTaskArchive adds:
  * - task_infos_: vector of TaskInfo for task metadata
  * - msg_type_: MsgType for message type (SerializeIn, SerializeOut, Heartbeat)
+ * - src_node_, codec_mask_: sender and the wire codecs it can decode
+ * - bulk_codecs_: the bulks the sender compressed
  */
 class NetTaskArchive : public hshm::lbm::LbmMeta<> {
 public:
   std::vector<TaskInfo> task_infos_; /**< Task metadata for each serialized task */
   MsgType msg_type_;                 /**< Message type: kSerializeIn, kSerializeOut, or kHeartbeat */
+  u64 src_node_ = 0;                 /**< Node that sent the message */
+  u32 codec_mask_ = 0;               /**< kWireCodec* bits the sender decodes */
+  std::vector<BulkCodec> bulk_codecs_; /**< Compressed bulks, by index */
 
   /**
    * Default constructor
@@ -116,7 +148,10 @@ public:
   NetTaskArchive(NetTaskArchive &&other) noexcept
       : hshm::lbm::LbmMeta<>(std::move(other)),
         task_infos_(std::move(other.task_infos_)),
-        msg_type_(other.msg_type_) {}
+        msg_type_(other.msg_type_),
+        src_node_(other.src_node_),
+        codec_mask_(other.codec_mask_),
+        bulk_codecs_(std::move(other.bulk_codecs_)) {}
 
   /**
    * Move assignment operator
@@ -126,6 +161,9 @@ public:
       hshm::lbm::LbmMeta<>::operator=(std::move(other));
       task_infos_ = std::move(other.task_infos_);
       msg_type_ = other.msg_type_;
+      src_node_ = other.src_node_;
+      codec_mask_ = other.codec_mask_;
+      bulk_codecs_ = std::move(other.bulk_codecs_);
     }
     return *this;
   }
@@ -258,10 +296,16 @@ public:
 
   void SetTransport(hshm::lbm::Transport *lbm_transport) { lbm_transport_ = lbm_transport; }
 
+  /**
+   * Bulk descriptors come first so a peer that rejects the version can
+   * still drain the bulks that follow
+   */
   template <typename Ar>
   void serialize(Ar &ar) {
     ar(send, recv, send_bulks, recv_bulks);
-    ar(task_infos_, msg_type_);
+    u32 magic = kTaskWireMagic, version = kTaskWireVersion;
+    ar(magic, version);
+    ar(task_infos_, msg_type_, src_node_, codec_mask_, bulk_codecs_);
     serializer_.Finalize();
     ar(buffer_);
   }
@@ -406,10 +450,26 @@ public:
     deserializer_.range(args...);
   }
 
+  /**
+   * A message with the wrong magic or version is turned into a heartbeat
+   * with no tasks; its bulk descriptors are kept so the transport still
+   * drains them
+   */
   template <typename Ar>
   void serialize(Ar &ar) {
     ar(send, recv, send_bulks, recv_bulks);
-    ar(task_infos_, msg_type_);
+    u32 magic = 0, version = 0;
+    ar(magic, version);
+    if (magic != kTaskWireMagic || version != kTaskWireVersion) {
+      HLOG(kError,
+           "LoadTaskArchive: rejecting message with wire magic {} "
+           "version {} (expected magic {} version {})",
+           magic, version, kTaskWireMagic, kTaskWireVersion);
+      task_infos_.clear();
+      msg_type_ = MsgType::kHeartbeat;
+      return;
+    }
+    ar(task_infos_, msg_type_, src_node_, codec_mask_, bulk_codecs_);
     ar(data_);
     // Reinitialize deserializer with new data
     new (&deserializer_)
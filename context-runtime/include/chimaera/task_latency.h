@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#ifndef CHIMAERA_INCLUDE_CHIMAERA_TASK_LATENCY_H_
+#define CHIMAERA_INCLUDE_CHIMAERA_TASK_LATENCY_H_
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "chimaera/types.h"
+
+namespace chi {
+
+/** Lifecycle stage whose latency is histogrammed */
+enum class TaskStage : u32 {
+  kQueue = 0,  ///< Submit until a worker pops the task from its lane
+  kDispatch,   ///< Pop until the task's coroutine first starts running
+  kRun,        ///< Time the task actually spent executing on a worker
+  kSuspend,    ///< Start until completion, minus run time (yields, waits)
+  kTotal,      ///< Submit until the worker ends the task
+  kWait,       ///< Client submit until Future::Wait returns
+  kCount
+};
+
+/** Number of TaskStage values */
+constexpr u32 kNumTaskStages = static_cast<u32>(TaskStage::kCount);
+
+/**
+ * Get the short name of a stage ("queue", "dispatch", ...).
+ * @param stage Stage to name
+ * @return Static string naming the stage
+ */
+const char *TaskStageName(TaskStage stage);
+
+/**
+ * Log-linear latency histogram in nanoseconds.
+ *
+ * Values below 8 get exact buckets; above that every power of two is split
+ * into 8 linear sub-buckets, so any percentile is within 12.5% of the true
+ * value. The range tops out at 2^40 ns (about 18 minutes); larger samples
+ * land in the last bucket. Not thread-safe.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr u32 kSubBits = 3;
+  static constexpr u32 kSubBuckets = 1u << kSubBits;
+  static constexpr u32 kMaxExp = 40;
+  static constexpr u32 kNumBuckets = (kMaxExp - kSubBits + 1) * kSubBuckets;
+
+  LatencyHistogram() { Clear(); }
+
+  /**
+   * Add one sample.
+   * @param value_ns Sample in nanoseconds
+   */
+  void Record(u64 value_ns) {
+    buckets_[BucketOf(value_ns)] += 1;
+    count_ += 1;
+    sum_ += value_ns;
+    if (value_ns > max_) max_ = value_ns;
+  }
+
+  /**
+   * Add every sample of another histogram.
+   * @param other Histogram to fold into this one
+   */
+  void Merge(const LatencyHistogram &other);
+
+  /** Reset to empty */
+  void Clear();
+
+  /** @return Number of samples */
+  u64 Count() const { return count_; }
+
+  /** @return Sum of all samples in nanoseconds */
+  u64 Sum() const { return sum_; }
+
+  /** @return Largest sample in nanoseconds */
+  u64 Max() const { return max_; }
+
+  /** @return Mean sample in nanoseconds, 0 when empty */
+  double Mean() const {
+    return count_ ? static_cast<double>(sum_) / count_ : 0.0;
+  }
+
+  /**
+   * Estimate a percentile.
+   * @param q Quantile in [0, 1]
+   * @return Upper bound of the bucket holding the quantile, capped at Max()
+   */
+  u64 Percentile(double q) const;
+
+  /**
+   * Map a value to its bucket index.
+   * @param value_ns Sample in nanoseconds
+   * @return Bucket index in [0, kNumBuckets)
+   */
+  static u32 BucketOf(u64 value_ns) {
+    constexpr u64 kMaxValue = (1ull << kMaxExp) - 1;
+    if (value_ns > kMaxValue) value_ns = kMaxValue;
+    if (value_ns < kSubBuckets) return static_cast<u32>(value_ns);
+    u32 exp = 63 - static_cast<u32>(__builtin_clzll(value_ns));
+    u32 sub = static_cast<u32>(value_ns >> (exp - kSubBits)) &
+              (kSubBuckets - 1);
+    return (exp - kSubBits + 1) * kSubBuckets + sub;
+  }
+
+  /**
+   * Largest value that maps to a bucket.
+   * @param idx Bucket index
+   * @return Inclusive upper bound of the bucket in nanoseconds
+   */
+  static u64 BucketUpperBound(u32 idx);
+
+ private:
+  u64 buckets_[kNumBuckets];
+  u64 count_;
+  u64 sum_;
+  u64 max_;
+};
+
+/** Histograms of every stage for one (pool, method) pair */
+struct TaskLatencyEntry {
+  PoolId pool_id_;
+  u32 method_ = 0;
+  LatencyHistogram stages_[kNumTaskStages];
+
+  /**
+   * Fold another entry's histograms into this one.
+   * @param other Entry for the same (pool, method)
+   */
+  void Merge(const TaskLatencyEntry &other) {
+    for (u32 i = 0; i < kNumTaskStages; ++i) {
+      stages_[i].Merge(other.stages_[i]);
+    }
+  }
+};
+
+/**
+ * Per-(pool, method) lifecycle histograms owned by one recorder.
+ *
+ * Each worker owns one instance and records into it from its own thread
+ * when a task ends; the monitor path snapshots it from another thread, so
+ * a mutex protects the map. The lock is uncontended on the hot path.
+ * Recording is controlled by a process-wide switch (runtime.task_latency)
+ * and costs one relaxed load per task while disabled.
+ */
+class TaskLatencyStats {
+ public:
+  /**
+   * Record one sample of a stage.
+   * @param pool_id Pool the task belongs to
+   * @param method Method of the task
+   * @param stage Stage being measured
+   * @param value_ns Stage latency in nanoseconds
+   */
+  void Record(const PoolId &pool_id, u32 method, TaskStage stage,
+              u64 value_ns);
+
+  /**
+   * Record the worker-side stages of a completed task. Timestamps of 0 are
+   * treated as missing and the stages that need them are skipped.
+   * @param pool_id Pool the task belongs to
+   * @param method Method of the task
+   * @param submit_ns Time the task was submitted (Stamp clock)
+   * @param pop_ns Time a worker popped the task
+   * @param start_ns Time the task's coroutine first ran
+   * @param end_ns Time the task completed
+   * @param run_ns Accumulated execution time
+   */
+  void RecordTask(const PoolId &pool_id, u32 method, u64 submit_ns,
+                  u64 pop_ns, u64 start_ns, u64 end_ns, u64 run_ns);
+
+  /**
+   * Copy every entry, optionally merging into an existing snapshot.
+   * @param out Entries are merged into matching (pool, method) pairs
+   */
+  void Snapshot(std::vector<TaskLatencyEntry> &out) const;
+
+  /** Drop every entry */
+  void Clear();
+
+  /**
+   * Enable or disable recording process-wide.
+   * @param enabled Whether tasks should be timestamped
+   */
+  static void SetEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+
+  /** @return Whether recording is enabled */
+  static bool IsEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  /** @return Monotonic time in nanoseconds, or 0 when recording is off */
+  static u64 Stamp() {
+    if (!IsEnabled()) return 0;
+    return Now();
+  }
+
+  /** @return Monotonic time in nanoseconds */
+  static u64 Now() {
+    return static_cast<u64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+  }
+
+  /** @return Process-wide recorder for client-side (kWait) samples */
+  static TaskLatencyStats &Client();
+
+ private:
+  struct Key {
+    PoolId pool_id_;
+    u32 method_;
+    bool operator==(const Key &other) const {
+      return pool_id_ == other.pool_id_ && method_ == other.method_;
+    }
+  };
+  struct KeyHash {
+    size_t operator()(const Key &key) const {
+      return std::hash<PoolId>()(key.pool_id_) * 31 + key.method_;
+    }
+  };
+
+  /** Find or create the entry for (pool, method); lock must be held */
+  TaskLatencyEntry &GetEntry(const PoolId &pool_id, u32 method);
+
+  static std::atomic<bool> enabled_;
+  mutable std::mutex lock_;
+  std::unordered_map<Key, TaskLatencyEntry, KeyHash> entries_;
+};
+
+}  // namespace chi
+
+#endif  // CHIMAERA_INCLUDE_CHIMAERA_TASK_LATENCY_H_
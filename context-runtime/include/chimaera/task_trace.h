@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+
+#ifndef CHIMAERA_INCLUDE_CHIMAERA_TASK_TRACE_H_
+#define CHIMAERA_INCLUDE_CHIMAERA_TASK_TRACE_H_
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "chimaera/types.h"
+
+namespace chi {
+
+/** What a recorded trace event describes */
+enum class TraceKind : u32 {
+  kTaskRun = 0,  ///< One execution slice of a task (start/resume to yield/end)
+  kTask,         ///< Whole task lifetime, worker pop to completion
+  kBdevRead,     ///< Bdev read, first submission to last completion
+  kBdevWrite,    ///< Bdev write, first submission to last completion
+  kNetSend,      ///< One lightbeam message (a coalesced batch of tasks)
+};
+
+/** TraceEvent::flags_ bits */
+enum TraceFlags : u32 {
+  kTraceResumed = 1u << 0,  ///< kTaskRun slice resumed a suspended coroutine
+  kTraceYielded = 1u << 1,  ///< kTaskRun slice ended in a suspend, not done
+  kTraceResponse = 1u << 2,  ///< kNetSend carried responses (SendOut)
+};
+
+/**
+ * One fixed-size trace record. The meaning of the argument fields depends
+ * on kind_:
+ *   kTaskRun / kTask:        pool_id_, method_; arg0_ = run ns (kTask)
+ *   kBdevRead / kBdevWrite:  pool_id_ = bdev pool; arg0_ = bytes,
+ *                            arg1_ = I/O submissions
+ *   kNetSend:                arg0_ = bulk bytes, arg1_ = destination node,
+ *                            method_ = tasks in the message
+ */
+struct TraceEvent {
+  u64 begin_ns_ = 0;
+  u64 end_ns_ = 0;
+  PoolId pool_id_;
+  u64 arg0_ = 0;
+  u64 arg1_ = 0;
+  u32 method_ = 0;
+  TraceKind kind_ = TraceKind::kTaskRun;
+  u32 flags_ = 0;
+};
+
+/**
+ * Ring-buffered timeline capture dumped as Chrome trace / Perfetto JSON.
+ *
+ * Every thread that records gets its own ring of the most recent events,
+ * so recording is a few stores with no lock or shared cache line; when a
+ * ring wraps the oldest events are overwritten and counted as dropped.
+ * Capture is off until Start() (the admin "trace_start" Monitor query) and
+ * costs one relaxed load per hook while off. DumpJson() may run while
+ * capture continues; events overwritten during the copy are discarded
+ * rather than emitted torn.
+ */
+class TaskTracer {
+ public:
+  /** Events kept per thread when Start() is given 0 */
+  static constexpr u32 kDefaultEventsPerThread = 1u << 16;
+
+  /** Maps (pool, method) to an event name; the default prints the ids */
+  using NameFn = std::function<std::string(const PoolId &, u32)>;
+
+  /**
+   * Drop all captured events and start capturing.
+   * @param events_per_thread Ring size, rounded up to a power of two
+   */
+  static void Start(u32 events_per_thread);
+
+  /** Stop capturing; captured events stay available to DumpJson() */
+  static void Stop();
+
+  /** @return Whether capture is on */
+  static bool IsEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  /** @return Monotonic time in nanoseconds, or 0 when capture is off */
+  static u64 Stamp() {
+    if (!IsEnabled()) return 0;
+    return Now();
+  }
+
+  /** @return Monotonic time in nanoseconds (same clock as TaskLatencyStats) */
+  static u64 Now() {
+    return static_cast<u64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+  }
+
+  /**
+   * Name the calling thread's track in the trace (e.g. "worker 3").
+   * @param name Track name
+   */
+  static void SetThreadName(const std::string &name);
+
+  /**
+   * Append an event to the calling thread's ring. Dropped when capture is
+   * off, so a Stop() racing a hook cannot resurrect a ring.
+   * @param event Event to record
+   */
+  static void Record(const TraceEvent &event);
+
+  /**
+   * Record one execution slice of a task.
+   * @param pool_id Pool of the task
+   * @param method Method of the task
+   * @param begin_ns Slice start (Stamp clock)
+   * @param end_ns Slice end
+   * @param flags kTraceResumed / kTraceYielded
+   */
+  static void RecordTaskRun(const PoolId &pool_id, u32 method, u64 begin_ns,
+                            u64 end_ns, u32 flags);
+
+  /**
+   * Record a task's lifetime from worker pop to completion.
+   * @param pool_id Pool of the task
+   * @param method Method of the task
+   * @param begin_ns Worker pop time
+   * @param end_ns Completion time
+   * @param run_ns Accumulated execution time
+   */
+  static void RecordTask(const PoolId &pool_id, u32 method, u64 begin_ns,
+                         u64 end_ns, u64 run_ns);
+
+  /**
+   * Record a bdev transfer.
+   * @param pool_id Bdev pool
+   * @param is_write Write or read
+   * @param begin_ns First submission
+   * @param end_ns Last completion
+   * @param bytes Bytes transferred
+   * @param submissions Number of I/O submissions
+   */
+  static void RecordBdevIo(const PoolId &pool_id, bool is_write, u64 begin_ns,
+                           u64 end_ns, u64 bytes, u64 submissions);
+
+  /**
+   * Record one network message send.
+   * @param node_id Destination node
+   * @param begin_ns Send start
+   * @param end_ns Send return
+   * @param bytes Bulk bytes in the message
+   * @param num_tasks Tasks coalesced into the message
+   * @param is_response Whether the message carried responses
+   */
+  static void RecordNetSend(u64 node_id, u64 begin_ns, u64 end_ns, u64 bytes,
+                            u32 num_tasks, bool is_response);
+
+  /**
+   * Render this process's captured events as a JSON fragment: comma
+   * separated Chrome trace event objects, one process (pid) per node.
+   * @param node_id Node id used as the trace pid
+   * @param host Host name shown in the process label
+   * @param name_fn Resolves task event names (may be empty)
+   * @return Fragment for WrapJson(); empty when nothing was captured
+   */
+  static std::string DumpJson(u64 node_id, const std::string &host,
+                              const NameFn &name_fn);
+
+  /**
+   * Join fragments (e.g. one per node) into a trace document that
+   * chrome://tracing and ui.perfetto.dev load directly.
+   * @param fragments DumpJson() outputs
+   * @return Complete JSON document
+   */
+  static std::string WrapJson(const std::vector<std::string> &fragments);
+
+  /** @return Events overwritten since the last Start() */
+  static u64 GetDroppedCount();
+
+ private:
+  static std::atomic<bool> enabled_;
+};
+
+}  // namespace chi
+
+#endif  // CHIMAERA_INCLUDE_CHIMAERA_TASK_TRACE_H_
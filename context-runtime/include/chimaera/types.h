@@ -423,11 +423,24 @@ struct AddressHash {
   BIT_OPT(chi::u32, 7)  ///< Task does not need a response. Wait/co_await return
                         ///< instantly; SendOut, ClientSend, and
                         ///< IpcManager::SendRuntime are skipped.
+#define TASK_HIGH_PRIORITY \
+  BIT_OPT(chi::u32, 8)  ///< Latency-critical task. Queued on its worker's
+                        ///< high-priority lane and resumed ahead of normal
+                        ///< tasks (see TaskPrio)
 
 // Bulk transfer flags are defined in hermes_shm/lightbeam/lightbeam.h:
 // - BULK_EXPOSE: Bulk is exposed (sender exposes for reading)
 // - BULK_XFER: Bulk is exposed for writing (receiver)
 
+/**
+ * Client-assigned scheduling priority. The value is also the priority index
+ * of the worker's lane in the TaskQueue.
+ */
+enum class TaskPrio : u32 {
+  kNormal = 0,  ///< Bulk and background work
+  kHigh = 1,    ///< Served first; normal lanes still drain every iteration
+};
+
 // Lane mapping policies for task distribution
 enum class LaneMapPolicy {
   kMapByPidTid = 0,  ///< Map tasks to lanes by hashing PID+TID (ensures
@@ -38,6 +38,7 @@
 #include <memory>
 #include <vector>
 
+#include "chimaera/blocking_pool.h"
 #include "chimaera/task.h"
 #include "chimaera/types.h"
 #include "chimaera/worker.h"
@@ -141,6 +142,12 @@ class WorkOrchestrator {
    */
   u32 GetTotalWorkerCount() const { return static_cast<u32>(all_workers_.size()); }
 
+  /**
+   * Get the pool that runs blocking ChiMod calls off the workers
+   * @return Blocking pool (disabled when runtime.blocking_threads is 0)
+   */
+  BlockingPool* GetBlockingPool() { return &blocking_pool_; }
+
  private:
   /**
    * Spawn worker threads using HSHM thread model
@@ -148,6 +155,13 @@ class WorkOrchestrator {
    */
   bool SpawnWorkerThreads();
 
+  /**
+   * Choose a CPU for each worker from runtime.worker_affinity and the host
+   * topology (see WorkerAffinityPlanner)
+   * @return Per worker index: CPU id, or WorkerAffinityPlanner::kUnpinned
+   */
+  std::vector<int> PlanWorkerAffinity() const;
+
   /**
    * Create workers
    * @param count Number of workers to create
@@ -189,6 +203,9 @@ class WorkOrchestrator {
   // Scheduler pointer (owned by IpcManager, not WorkOrchestrator)
   Scheduler *scheduler_;
 
+  // Threads for RunBlocking() calls (started with the workers)
+  BlockingPool blocking_pool_;
+
 };
 
 }  // namespace chi
@@ -34,6 +34,7 @@
 #ifndef CHIMAERA_INCLUDE_CHIMAERA_WORKERS_WORKER_H_
 #define CHIMAERA_INCLUDE_CHIMAERA_WORKERS_WORKER_H_
 
+#include <atomic>
 #include <chrono>
 #ifndef __NVCOMPILER
 #include <coroutine>
@@ -45,6 +46,10 @@
 #include <vector>
 
 #include "chimaera/container.h"
+#include "chimaera/poll_controller.h"
+#include "chimaera/task_latency.h"
+#include "chimaera/task_trace.h"
+#include "chimaera/expiry_wheel.h"
 #include "chimaera/pool_query.h"
 #include "chimaera/task.h"
 #include "chimaera/types.h"
@@ -52,6 +57,7 @@
 #include "hermes_shm/lightbeam/event_manager.h"
 #include "hermes_shm/lightbeam/transport_factory_impl.h"
 #include "hermes_shm/memory/allocator/malloc_allocator.h"
+#include "hermes_shm/thread/epoch_reclaimer.h"
 
 namespace chi {
 
@@ -80,6 +86,9 @@ struct WorkerStats {
   bool is_active_;           /**< Whether the worker's lane is currently active (processing tasks) */
   u32 worker_id_;            /**< Worker identifier */
   float load_;               /**< Current estimated load in microseconds */
+  PollStats poll_;           /**< Idle policy CPU/latency counters */
+  u64 lane_remaps_in_;       /**< Client threads the scheduler moved onto this lane */
+  u64 lane_remaps_out_;      /**< Client threads the scheduler moved off this lane */
 
   /** Default constructor */
   WorkerStats()
@@ -93,20 +102,83 @@ struct WorkerStats {
         is_running_(false),
         is_active_(false),
         worker_id_(0),
-        load_(0) {}
+        load_(0),
+        lane_remaps_in_(0),
+        lane_remaps_out_(0) {}
 
   template <typename Archive>
   void save(Archive& ar) const {
     ar(num_tasks_processed_, num_queued_tasks_, num_blocked_tasks_,
        num_periodic_tasks_, num_retry_tasks_, suspend_period_us_,
-       idle_iterations_, is_running_, is_active_, worker_id_, load_);
+       idle_iterations_, is_running_, is_active_, worker_id_, load_,
+       poll_.idle_cpu_us_, poll_.sleep_us_, poll_.busy_wakeups_,
+       poll_.spin_wakeups_, poll_.sleep_wakeups_,
+       poll_.wake_latency_p99_us_, poll_.arrival_gap_us_,
+       poll_.poll_window_us_, lane_remaps_in_, lane_remaps_out_);
   }
 
   template <typename Archive>
   void load(Archive& ar) {
     ar(num_tasks_processed_, num_queued_tasks_, num_blocked_tasks_,
        num_periodic_tasks_, num_retry_tasks_, suspend_period_us_,
-       idle_iterations_, is_running_, is_active_, worker_id_, load_);
+       idle_iterations_, is_running_, is_active_, worker_id_, load_,
+       poll_.idle_cpu_us_, poll_.sleep_us_, poll_.busy_wakeups_,
+       poll_.spin_wakeups_, poll_.sleep_wakeups_,
+       poll_.wake_latency_p99_us_, poll_.arrival_gap_us_,
+       poll_.poll_window_us_, lane_remaps_in_, lane_remaps_out_);
+  }
+};
+
+/**
+ * Counters a worker publishes for the metrics endpoint.
+ *
+ * The worker is the only writer and stores with relaxed ordering from its
+ * own loop, so a scrape from another thread never touches the worker's
+ * private queues or takes a lock.
+ */
+struct WorkerCounters {
+  /** Method-ID slots in method_tasks_; larger IDs share the last slot */
+  static constexpr u32 kNumMethodSlots = 64;
+
+  std::atomic<u64> tasks_processed_{0};  /**< Tasks completed */
+  std::atomic<u32> blocked_tasks_{0};    /**< Tasks in the blocked queues */
+  std::atomic<u32> periodic_tasks_{0};   /**< Tasks waiting on periodic timers */
+  std::atomic<u32> retry_tasks_{0};      /**< Tasks in the retry queue */
+  std::atomic<float> load_{0};           /**< Estimated load (us) */
+  std::atomic<u64> idle_cpu_us_{0};      /**< Idle time polling/spinning */
+  std::atomic<u64> sleep_us_{0};         /**< Idle time blocked in epoll */
+  std::atomic<u64> start_us_{0};         /**< Steady-clock start of Run() */
+  std::atomic<u64> resumes_{0};          /**< Coroutine resumptions */
+  std::atomic<u64> inline_tasks_{0};     /**< Subtasks run inline at send */
+  /** Tasks completed per method ID, summed over pools */
+  std::atomic<u64> method_tasks_[kNumMethodSlots] = {};
+
+  /** @return Slot in method_tasks_ that counts the given method */
+  static u32 MethodSlot(u32 method) {
+    return method < kNumMethodSlots ? method : kNumMethodSlots - 1;
+  }
+
+  /**
+   * Bump a counter owned by the worker thread. A relaxed load and store
+   * avoids the locked read-modify-write of fetch_add on the task path.
+   */
+  static void Bump(std::atomic<u64> &counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_relaxed);
+  }
+
+  /**
+   * Time outside idle polling and sleep since Run() started.
+   * The idle time of a period still in progress is not yet counted.
+   * @param now_us Current steady-clock time in microseconds
+   * @return Busy time in microseconds
+   */
+  u64 BusyUs(u64 now_us) const {
+    u64 start_us = start_us_.load(std::memory_order_relaxed);
+    u64 idle_us = idle_cpu_us_.load(std::memory_order_relaxed) +
+                  sleep_us_.load(std::memory_order_relaxed);
+    u64 up_us = (start_us && now_us > start_us) ? now_us - start_us : 0;
+    return up_us > idle_us ? up_us - idle_us : 0;
   }
 };
 
@@ -171,12 +243,45 @@ class Worker {
    */
   auto *GetEventQueue() { return event_queue_; }
 
+  /**
+   * Run a subtask sent to this worker's own lane right away, inside the
+   * sending coroutine, instead of enqueueing it. A subtask that finishes
+   * without suspending completes its future directly, so the parent's
+   * co_await takes the await_ready fast path and never suspends.
+   * @param lane This worker's lane (the subtask's destination)
+   * @param future Future of the subtask, with its RunContext already begun
+   * @return false if the subtask must be enqueued instead
+   */
+  bool ExecInline(TaskLane *lane, Future<Task> &future);
+
+  /**
+   * Check whether a task is the parent of a subtask running inline; its
+   * coroutine is on this thread's stack, not suspended
+   * @param run_ctx RunContext of the parent
+   * @return true if subtask completion may set FUTURE_COMPLETE directly
+   */
+  bool IsInlineParent(const RunContext *run_ctx) const {
+    return run_ctx != nullptr && run_ctx == inline_parent_;
+  }
+
   /**
    * Check if worker is running
    * @return true if worker is active, false otherwise
    */
   bool IsRunning() const;
 
+  /**
+   * Get the NUMA node of the CPU this worker is pinned to
+   * @return NUMA node, or -1 if the worker is not pinned
+   */
+  int GetNumaNode() const { return numa_node_; }
+
+  /**
+   * Record the NUMA node of the CPU this worker is pinned to
+   * @param node NUMA node, or -1 if the worker is not pinned
+   */
+  void SetNumaNode(int node) { numa_node_ = node; }
+
   /**
    * Get current RunContext for this worker thread
    * @return Pointer to current RunContext or nullptr
@@ -236,6 +341,18 @@ class Worker {
    */
   WorkerStats GetWorkerStats() const;
 
+  /**
+   * Get this worker's lifecycle latency histograms
+   * @return Per-(pool, method) histograms recorded in EndTask
+   */
+  const TaskLatencyStats &GetTaskLatencyStats() const { return task_latency_; }
+
+  /**
+   * Get the counters published for the metrics endpoint
+   * @return Counters safe to read from any thread
+   */
+  const WorkerCounters &GetCounters() const { return counters_; }
+
   /**
    * Get the EventManager for this worker
    * @return Reference to this worker's EventManager
@@ -279,6 +396,27 @@ class Worker {
    */
   TaskLane *GetLane() const;
 
+  /**
+   * Set the lane holding this worker's TaskPrio::kHigh tasks
+   * @param lane Pointer to the high-priority TaskLane of the worker's lane ID
+   */
+  void SetHighPrioLane(TaskLane *lane);
+
+  /**
+   * Get the worker's high-priority lane
+   * @return Pointer to the high-priority TaskLane, or nullptr if unset
+   */
+  TaskLane *GetHighPrioLane() const;
+
+  /**
+   * Estimate how long a newly queued task would wait on this worker.
+   * Sums the predicted load of active tasks and the queued lane depth
+   * times the worker's average task cost. Read racily by schedulers on
+   * other workers, so the result is an approximation.
+   * @return Expected wait in microseconds
+   */
+  float GetExpectedWaitUs() const;
+
   /**
    * Set GPU lanes for this worker to process
    * @param lanes Vector of TaskLane pointers for GPU queues
@@ -308,18 +446,25 @@ class Worker {
 
  private:
   /**
-   * Process a blocked queue, checking tasks and re-queuing as needed
+   * Process a blocked queue, checking tasks and re-queuing as needed.
+   * High-priority tasks in the checked window are resumed first.
    * @param queue Reference to the ext_ring_buffer to process
    * @param queue_idx Index of the queue being processed (0-3)
    */
   void ProcessBlockedQueue(std::queue<RunContext *> &queue, u32 queue_idx);
 
   /**
-   * Process a periodic queue, checking time-based tasks and executing if ready
-   * @param queue Reference to the ext_ring_buffer to process
-   * @param queue_idx Index of the queue being processed (0-3)
+   * Resume every periodic task whose deadline has passed.
+   * Tasks that yield again are re-armed through AddToBlockedQueue.
    */
-  void ProcessPeriodicQueue(std::queue<RunContext *> &queue, u32 queue_idx);
+  void ProcessPeriodicTimers();
+
+  /**
+   * @param time Point on the steady clock
+   * @return Microseconds from the worker's spawn to time, the clock of
+   *         periodic_timers_
+   */
+  u64 TimerNowUs(hshm::Timepoint &time) const;
 
   /**
    * Process event queue for waking up tasks when subtasks complete
@@ -347,6 +492,19 @@ class Worker {
                bool can_resched);
 
  private:
+  /**
+   * Record the lifecycle stages of a completed task
+   * @param task_ptr Full pointer to the completed task
+   * @param run_ctx Pointer to RunContext holding the pop and start stamps
+   */
+  void RecordTaskLatency(const FullPtr<Task> &task_ptr, RunContext *run_ctx);
+
+  /**
+   * Copy the worker's private counters into counters_ for the metrics
+   * endpoint. Called from the worker loop only.
+   */
+  void PublishCounters();
+
   /**
    * Continue processing blocked tasks that are ready to resume
    * @param force If true, process both queues regardless of iteration count
@@ -355,19 +513,24 @@ class Worker {
 
   /**
    * Process tasks from a given lane
-   * Processes up to MAX_TASKS_PER_ITERATION tasks per call
+   * Pops up to kLaneBatchSize futures at once, prefetches their headers,
+   * then dispatches them in order
    * @param lane The TaskLane to process tasks from
    * @return Number of tasks processed
    */
   u32 ProcessNewTasks(TaskLane *lane);
 
   /**
-   * Process a single task from a given lane
-   * Handles task retrieval, deserialization, routing, and execution
-   * @param lane The TaskLane to pop a task from
-   * @return true if a task was processed, false if lane was empty
+   * Process a single popped task
+   * Handles deserialization, routing, and execution
+   * @param lane The TaskLane the task was popped from
+   * @param future Popped future
+   * @param future_shm FutureShm of the future
+   * @param container Static container of the task's pool (may be nullptr)
    */
-  bool ProcessNewTask(TaskLane *lane);
+  void DispatchNewTask(TaskLane *lane, Future<Task> &future,
+                       const hipc::FullPtr<FutureShm> &future_shm,
+                       Container *container);
 
   /**
    * Get task pointer from Future, copying from client if needed
@@ -383,8 +546,8 @@ class Worker {
 
   /**
    * Get the time remaining before the next periodic task should resume
-   * Scans all periodic queues to find the task with the shortest remaining time
-   * @return Time in microseconds until next periodic task, or 0 if no periodic tasks
+   * Reads the next deadline of the periodic timer wheel
+   * @return Time in microseconds until next periodic task, or -1 if no periodic tasks
    */
   double GetSuspendPeriod() const;
 
@@ -420,9 +583,11 @@ class Worker {
   void ResumeCoroutine(const FullPtr<Task> &task_ptr, RunContext *run_ctx);
 
   u32 worker_id_;
+  int numa_node_ = -1;  // NUMA node of the pinned CPU (-1: not pinned)
   bool is_running_;
   bool is_initialized_;
   float load_;          // Estimated total CPU time (us) of active tasks
+  float avg_task_us_;   // EMA of wall time (us) of non-periodic tasks
   bool did_work_;       // Tracks if any work was done in current loop iteration
   bool task_did_work_;  // Tracks if current task did actual work (set by tasks
                         // via CHI_CUR_WORKER)
@@ -430,9 +595,18 @@ class Worker {
   // Current RunContext for this worker thread
   RunContext *current_run_context_;
 
+  // Inline subtask execution (ExecInline). inline_parent_ is the task whose
+  // coroutine is sending the innermost inline subtask.
+  static constexpr u32 kMaxInlineDepth = 8;
+  RunContext *inline_parent_ = nullptr;
+  u32 inline_depth_ = 0;
+
   // Single lane assigned to this worker (one lane per worker)
   TaskLane *assigned_lane_;
 
+  // High-priority lane of the same lane ID, drained before assigned_lane_
+  TaskLane *high_prio_lane_ = nullptr;
+
   // GPU lanes assigned to this worker (one lane per GPU, empty when no GPU)
   std::vector<GpuTaskLane *> gpu_lanes_;
 
@@ -461,17 +635,19 @@ class Worker {
   static constexpr u32 EVENT_QUEUE_DEPTH = 1024;
   hshm::ipc::mpsc_ring_buffer<Future<Task, CHI_QUEUE_ALLOC_T>, hshm::ipc::MallocAllocator> *event_queue_;
 
-  // Periodic queue system for time-based periodic tasks:
-  // - Queue[0]: Tasks with yield_time_us_ <= 50us (checked every 16 iterations)
-  // - Queue[1]: Tasks with yield_time_us_ <= 200us (checked every 32
-  // iterations)
-  // - Queue[2]: Tasks with yield_time_us_ <= 50ms/50000us (checked every 64
-  // iterations)
-  // - Queue[3]: Tasks with yield_time_us_ > 50ms (checked every 128 iterations)
-  // Using std::queue for O(1) enqueue/dequeue operations
-  static constexpr u32 NUM_PERIODIC_QUEUES = 4;
-  static constexpr u32 PERIODIC_QUEUE_SIZE = 1024;
-  std::queue<RunContext *> periodic_queues_[NUM_PERIODIC_QUEUES];
+  static constexpr u32 kLaneBatchSize = 16;  // Futures popped per drain
+  // High-priority batches drained per iteration before the normal lane.
+  // Bounds how long normal tasks wait behind a high-priority flood.
+  static constexpr u32 kHighPrioBurst = 4;
+
+  // Time-based periodic tasks, keyed by the deadline block_start_ +
+  // yield_time_us_ on the TimerNowUs() clock. Checked every 4 iterations
+  // and before sleeping; the next deadline bounds the epoll timeout.
+  // 16 us ticks over 4096 slots: one revolution covers about 65 ms
+  static constexpr u64 kTimerTickUs = 16;
+  static constexpr size_t kTimerSlots = 4096;
+  ExpiryWheel<RunContext *> periodic_timers_{kTimerTickUs, kTimerSlots};
+  std::vector<RunContext *> due_timers_;  // Reused by ProcessPeriodicTimers
 
   // Worker spawn time
   hshm::Timepoint spawn_time_;  // Time when worker was spawned
@@ -487,6 +663,12 @@ class Worker {
   u32 current_sleep_us_;  // Current sleep duration in microseconds
   u64 sleep_count_;  // Number of times sleep was called in current idle period
   hshm::Timepoint idle_start_;  // Time when worker became idle
+  PollController poll_ctrl_;    // Chooses busy poll, spin, or epoll when idle
+  TaskLatencyStats task_latency_;  // Lifecycle histograms (runtime.task_latency)
+  WorkerCounters counters_;        // Published for the metrics endpoint
+
+  // Epoch reclamation slot: quiesced every iteration, offline while asleep
+  hshm::EpochReclaimer::Participant *ebr_ = nullptr;
 
   // EventManager for efficient worker suspension and event monitoring
   hshm::lbm::EventManager event_manager_;
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#ifndef CHIMAERA_INCLUDE_CHIMAERA_WORKER_AFFINITY_H_
+#define CHIMAERA_INCLUDE_CHIMAERA_WORKER_AFFINITY_H_
+
+#include <string>
+#include <vector>
+
+namespace chi {
+
+/** How a worker role is pinned by runtime.worker_affinity */
+enum class AffinityPolicy {
+  kNone,    ///< Not pinned
+  kAny,     ///< Any free core
+  kDevice,  ///< A free core on the NUMA node of the role's device
+};
+
+/** One CPU the planner may hand out */
+struct AffinityCpu {
+  int cpu_;       ///< CPU id
+  int node_;      ///< NUMA node of the CPU
+  bool primary_;  ///< Lowest-numbered hardware thread of its core
+};
+
+/**
+ * Picks a CPU for each worker from the host topology.
+ *
+ * Workers that want a NUMA node take free cores on that node first, in
+ * worker order. Then the other pinned workers, and node workers whose
+ * node ran out, take the remaining free cores in CPU order. Each CPU goes
+ * to at most one worker, and workers left when the CPUs run out stay
+ * unpinned. Unless siblings are allowed only the first hardware thread of
+ * each core is handed out, leaving the others to application threads.
+ */
+class WorkerAffinityPlanner {
+ public:
+  /** Plan entry for a worker that is not pinned */
+  static constexpr int kUnpinned = -1;
+  /** Wanted node: any free core */
+  static constexpr int kAnyNode = -1;
+  /** Wanted node: do not pin this worker */
+  static constexpr int kNoPin = -2;
+
+  /**
+   * Parse a role policy name ("none", "any" or "device").
+   * @param name Policy name from the configuration
+   * @return Parsed policy; unknown names map to AffinityPolicy::kAny
+   */
+  static AffinityPolicy ParsePolicy(const std::string &name);
+
+  /**
+   * Read the CPUs this process may run on, with their NUMA nodes and
+   * whether each is the first hardware thread of its core.
+   * @return CPUs in ascending id order
+   */
+  static std::vector<AffinityCpu> ReadTopology();
+
+  /**
+   * Assign CPUs to workers.
+   * @param cpus Candidate CPUs
+   * @param nodes Per worker: wanted NUMA node, kAnyNode or kNoPin
+   * @param use_siblings Also hand out second hardware threads
+   * @return Per worker: CPU id or kUnpinned
+   */
+  static std::vector<int> Plan(const std::vector<AffinityCpu> &cpus,
+                               const std::vector<int> &nodes,
+                               bool use_siblings);
+};
+
+}  // namespace chi
+
+#endif  // CHIMAERA_INCLUDE_CHIMAERA_WORKER_AFFINITY_H_
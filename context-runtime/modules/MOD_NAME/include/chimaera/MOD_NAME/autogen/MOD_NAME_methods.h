@@ -2,6 +2,7 @@
 #define CHIMAERA_MOD_NAME_AUTOGEN_METHODS_H_
 
 #include <chimaera/chimaera.h>
+#include <chimaera/method_traits.h>
 #include <string>
 #include <vector>
 
@@ -45,6 +46,42 @@ inline const std::vector<std::string>& GetMethodNames() {
   }();
   return names;
 }
+
+/** Per-method traits indexed by method ID (see chimaera_mod.yaml) */
+inline constexpr chi::MethodTraits kMethodTraits[27] = {
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 0: Create
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 1: Destroy
+    {},  // 2
+    {},  // 3
+    {},  // 4
+    {},  // 5
+    {},  // 6
+    {},  // 7
+    {},  // 8
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 9: Monitor
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 10: Custom
+    {},  // 11
+    {},  // 12
+    {},  // 13
+    {},  // 14
+    {},  // 15
+    {},  // 16
+    {},  // 17
+    {},  // 18
+    {},  // 19
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 20: CoMutexTest
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 21: CoRwLockTest
+    {},  // 22
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 23: WaitTest
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 24: TestLargeOutput
+    {chi::MethodRoute::kDefault, chi::kMethodDefined | chi::kMethodGpu, 0},  // 25: GpuSubmit
+    {chi::MethodRoute::kDefault, chi::kMethodDefined | chi::kMethodGpu, 0},  // 26: SubtaskTest
+};
+
+/** @return Traits of a method, or chi::kNoMethodTraits if unknown */
+constexpr const chi::MethodTraits& GetMethodTraits(chi::u32 method) {
+  return method < 27 ? kMethodTraits[method] : chi::kNoMethodTraits;
+}
 }  // namespace Method
 
 }  // namespace chimaera::MOD_NAME
@@ -1,7 +1,7 @@
 /**
  * Auto-generated execution implementation for MOD_NAME ChiMod
- * Implements Container virtual APIs (Run, SaveTask, LoadTask, NewCopyTask, NewTask)
- * using switch-case dispatch
+ * Implements Container virtual APIs (Run, SaveTask, LoadTask, NewCopyTask, NewTask).
+ * Run uses switch-case dispatch; the others index the kMethodExec table.
  * 
  * This file is autogenerated - do not edit manually.
  * Changes should be made to the autogen tool or the YAML configuration.
@@ -11,9 +11,45 @@
 #include "chimaera/MOD_NAME/autogen/MOD_NAME_methods.h"
 #include <chimaera/chimaera.h>
 #include <chimaera/task.h>  // For TaskResume coroutine return type
+#include <chimaera/method_exec.h>
 
 namespace chimaera::MOD_NAME {
 
+namespace {
+
+/** Per-method dispatch table indexed by method ID */
+constexpr chi::MethodExec kMethodExec[27] = {
+    chi::MakeMethodExec<CreateTask>(),  // 0: Create
+    chi::MakeMethodExec<DestroyTask>(),  // 1: Destroy
+    {},  // 2
+    {},  // 3
+    {},  // 4
+    {},  // 5
+    {},  // 6
+    {},  // 7
+    {},  // 8
+    chi::MakeMethodExec<MonitorTask>(),  // 9: Monitor
+    chi::MakeMethodExec<CustomTask>(),  // 10: Custom
+    {},  // 11
+    {},  // 12
+    {},  // 13
+    {},  // 14
+    {},  // 15
+    {},  // 16
+    {},  // 17
+    {},  // 18
+    {},  // 19
+    chi::MakeMethodExec<CoMutexTestTask>(),  // 20: CoMutexTest
+    chi::MakeMethodExec<CoRwLockTestTask>(),  // 21: CoRwLockTest
+    {},  // 22
+    chi::MakeMethodExec<WaitTestTask>(),  // 23: WaitTest
+    chi::MakeMethodExec<TestLargeOutputTask>(),  // 24: TestLargeOutput
+    chi::MakeMethodExec<GpuSubmitTask>(),  // 25: GpuSubmit
+    chi::MakeMethodExec<SubtaskTestTask>(),  // 26: SubtaskTest
+};
+
+}  // namespace
+
 //==============================================================================
 // Container Virtual API Implementations
 //==============================================================================
@@ -29,6 +65,7 @@ void Runtime::Init(const chi::PoolId &pool_id, const std::string &pool_name,
   // Initialize per-method load prediction model
   DefineModel(Method::kMaxMethodId);
   SetMethodNames(Method::GetMethodNames());
+  SetMethodTraits(Method::kMethodTraits);
 }
 
 chi::TaskResume Runtime::Run(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr, chi::RunContext& rctx) {
@@ -91,7 +128,7 @@ chi::TaskResume Runtime::Run(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr,
     case Method::kSubtaskTest: {
       // Cast task FullPtr to specific type
       hipc::FullPtr<SubtaskTestTask> typed_task = task_ptr.template Cast<SubtaskTestTask>();
-      co_await SubtaskTest(typed_task, rctx);
+      CHI_CO_AWAIT(SubtaskTest(typed_task, rctx));
       break;
     }
     default: {
@@ -105,121 +142,17 @@ chi::TaskResume Runtime::Run(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr,
 
 void Runtime::SaveTask(chi::u32 method, chi::SaveTaskArchive& archive, 
                         hipc::FullPtr<chi::Task> task_ptr) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = task_ptr.template Cast<CreateTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = task_ptr.template Cast<DestroyTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = task_ptr.template Cast<MonitorTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kCustom: {
-      auto typed_task = task_ptr.template Cast<CustomTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kCoMutexTest: {
-      auto typed_task = task_ptr.template Cast<CoMutexTestTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kCoRwLockTest: {
-      auto typed_task = task_ptr.template Cast<CoRwLockTestTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kWaitTest: {
-      auto typed_task = task_ptr.template Cast<WaitTestTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kTestLargeOutput: {
-      auto typed_task = task_ptr.template Cast<TestLargeOutputTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kGpuSubmit: {
-      auto typed_task = task_ptr.template Cast<GpuSubmitTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kSubtaskTest: {
-      auto typed_task = task_ptr.template Cast<SubtaskTestTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    default: {
-      // Unknown method - do nothing
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->save_(archive, task_ptr);
   }
 }
 
 void Runtime::LoadTask(chi::u32 method, chi::LoadTaskArchive& archive,
                         hipc::FullPtr<chi::Task> task_ptr) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = task_ptr.template Cast<CreateTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = task_ptr.template Cast<DestroyTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = task_ptr.template Cast<MonitorTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kCustom: {
-      auto typed_task = task_ptr.template Cast<CustomTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kCoMutexTest: {
-      auto typed_task = task_ptr.template Cast<CoMutexTestTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kCoRwLockTest: {
-      auto typed_task = task_ptr.template Cast<CoRwLockTestTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kWaitTest: {
-      auto typed_task = task_ptr.template Cast<WaitTestTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kTestLargeOutput: {
-      auto typed_task = task_ptr.template Cast<TestLargeOutputTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGpuSubmit: {
-      auto typed_task = task_ptr.template Cast<GpuSubmitTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kSubtaskTest: {
-      auto typed_task = task_ptr.template Cast<SubtaskTestTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    default: {
-      // Unknown method - do nothing
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->load_(archive, task_ptr);
   }
 }
 
@@ -233,71 +166,9 @@ hipc::FullPtr<chi::Task> Runtime::AllocLoadTask(chi::u32 method, chi::LoadTaskAr
 
 void Runtime::LocalLoadTask(chi::u32 method, chi::DefaultLoadArchive& archive,
                             hipc::FullPtr<chi::Task> task_ptr) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = task_ptr.template Cast<CreateTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = task_ptr.template Cast<DestroyTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = task_ptr.template Cast<MonitorTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kCustom: {
-      auto typed_task = task_ptr.template Cast<CustomTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kCoMutexTest: {
-      auto typed_task = task_ptr.template Cast<CoMutexTestTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kCoRwLockTest: {
-      auto typed_task = task_ptr.template Cast<CoRwLockTestTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kWaitTest: {
-      auto typed_task = task_ptr.template Cast<WaitTestTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kTestLargeOutput: {
-      auto typed_task = task_ptr.template Cast<TestLargeOutputTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGpuSubmit: {
-      auto typed_task = task_ptr.template Cast<GpuSubmitTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kSubtaskTest: {
-      auto typed_task = task_ptr.template Cast<SubtaskTestTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    default: {
-      // Unknown method - do nothing
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->local_load_(archive, task_ptr);
   }
 }
 
@@ -311,369 +182,58 @@ hipc::FullPtr<chi::Task> Runtime::LocalAllocLoadTask(chi::u32 method, chi::Defau
 
 void Runtime::LocalSaveTask(chi::u32 method, chi::DefaultSaveArchive& archive, 
                              hipc::FullPtr<chi::Task> task_ptr) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = task_ptr.template Cast<CreateTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = task_ptr.template Cast<DestroyTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = task_ptr.template Cast<MonitorTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kCustom: {
-      auto typed_task = task_ptr.template Cast<CustomTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kCoMutexTest: {
-      auto typed_task = task_ptr.template Cast<CoMutexTestTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kCoRwLockTest: {
-      auto typed_task = task_ptr.template Cast<CoRwLockTestTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kWaitTest: {
-      auto typed_task = task_ptr.template Cast<WaitTestTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kTestLargeOutput: {
-      auto typed_task = task_ptr.template Cast<TestLargeOutputTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kGpuSubmit: {
-      auto typed_task = task_ptr.template Cast<GpuSubmitTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kSubtaskTest: {
-      auto typed_task = task_ptr.template Cast<SubtaskTestTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    default: {
-      // Unknown method - do nothing
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->local_save_(archive, task_ptr);
   }
 }
 
 hipc::FullPtr<chi::Task> Runtime::NewCopyTask(chi::u32 method, hipc::FullPtr<chi::Task> orig_task_ptr, bool deep) {
+  (void)deep;    // Deep copy parameter reserved for future use
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    return exec->new_copy_(orig_task_ptr);
+  }
+  // For unknown methods, create base Task copy
   auto* ipc_manager = CHI_IPC;
   if (!ipc_manager) {
     return hipc::FullPtr<chi::Task>();
   }
-  
-  switch (method) {
-    case Method::kCreate: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<CreateTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<CreateTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kDestroy: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<DestroyTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<DestroyTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kMonitor: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<MonitorTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<MonitorTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kCustom: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<CustomTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<CustomTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kCoMutexTest: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<CoMutexTestTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<CoMutexTestTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kCoRwLockTest: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<CoRwLockTestTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<CoRwLockTestTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kWaitTest: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<WaitTestTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<WaitTestTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kTestLargeOutput: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<TestLargeOutputTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<TestLargeOutputTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kGpuSubmit: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<GpuSubmitTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<GpuSubmitTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kSubtaskTest: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<SubtaskTestTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<SubtaskTestTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    default: {
-      // For unknown methods, create base Task copy
-      auto new_task_ptr = ipc_manager->NewTask<chi::Task>();
-      if (!new_task_ptr.IsNull()) {
-        new_task_ptr->Copy(orig_task_ptr);
-        return new_task_ptr;
-      }
-      break;
-    }
+  auto new_task_ptr = ipc_manager->NewTask<chi::Task>();
+  if (!new_task_ptr.IsNull()) {
+    new_task_ptr->Copy(orig_task_ptr);
   }
-  
-  (void)deep;    // Deep copy parameter reserved for future use
-  return hipc::FullPtr<chi::Task>();
+  return new_task_ptr;
 }
 
 hipc::FullPtr<chi::Task> Runtime::NewTask(chi::u32 method) {
-  auto* ipc_manager = CHI_IPC;
-  if (!ipc_manager) {
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec == nullptr) {
+    // For unknown methods, return null pointer
     return hipc::FullPtr<chi::Task>();
   }
-  
-  switch (method) {
-    case Method::kCreate: {
-      auto new_task_ptr = ipc_manager->NewTask<CreateTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kDestroy: {
-      auto new_task_ptr = ipc_manager->NewTask<DestroyTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kMonitor: {
-      auto new_task_ptr = ipc_manager->NewTask<MonitorTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kCustom: {
-      auto new_task_ptr = ipc_manager->NewTask<CustomTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kCoMutexTest: {
-      auto new_task_ptr = ipc_manager->NewTask<CoMutexTestTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kCoRwLockTest: {
-      auto new_task_ptr = ipc_manager->NewTask<CoRwLockTestTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kWaitTest: {
-      auto new_task_ptr = ipc_manager->NewTask<WaitTestTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kTestLargeOutput: {
-      auto new_task_ptr = ipc_manager->NewTask<TestLargeOutputTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kGpuSubmit: {
-      auto new_task_ptr = ipc_manager->NewTask<GpuSubmitTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kSubtaskTest: {
-      auto new_task_ptr = ipc_manager->NewTask<SubtaskTestTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    default: {
-      // For unknown methods, return null pointer
-      return hipc::FullPtr<chi::Task>();
-    }
-  }
+  return exec->new_task_();
 }
 
 void Runtime::Aggregate(chi::u32 method, hipc::FullPtr<chi::Task> orig_task,
                         const hipc::FullPtr<chi::Task>& replica_task) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = orig_task.template Cast<CreateTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = orig_task.template Cast<DestroyTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = orig_task.template Cast<MonitorTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kCustom: {
-      auto typed_task = orig_task.template Cast<CustomTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kCoMutexTest: {
-      auto typed_task = orig_task.template Cast<CoMutexTestTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kCoRwLockTest: {
-      auto typed_task = orig_task.template Cast<CoRwLockTestTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kWaitTest: {
-      auto typed_task = orig_task.template Cast<WaitTestTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kTestLargeOutput: {
-      auto typed_task = orig_task.template Cast<TestLargeOutputTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kGpuSubmit: {
-      auto typed_task = orig_task.template Cast<GpuSubmitTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kSubtaskTest: {
-      auto typed_task = orig_task.template Cast<SubtaskTestTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    default: {
-      orig_task->Aggregate(replica_task);
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->aggregate_(orig_task, replica_task);
+  } else {
+    orig_task->Aggregate(replica_task);
   }
 }
 
 void Runtime::DelTask(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr) {
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->del_(task_ptr);
+    return;
+  }
   auto* ipc_manager = CHI_IPC;
   if (!ipc_manager) return;
-  switch (method) {
-    case Method::kCreate: {
-      ipc_manager->DelTask(task_ptr.template Cast<CreateTask>());
-      break;
-    }
-    case Method::kDestroy: {
-      ipc_manager->DelTask(task_ptr.template Cast<DestroyTask>());
-      break;
-    }
-    case Method::kMonitor: {
-      ipc_manager->DelTask(task_ptr.template Cast<MonitorTask>());
-      break;
-    }
-    case Method::kCustom: {
-      ipc_manager->DelTask(task_ptr.template Cast<CustomTask>());
-      break;
-    }
-    case Method::kCoMutexTest: {
-      ipc_manager->DelTask(task_ptr.template Cast<CoMutexTestTask>());
-      break;
-    }
-    case Method::kCoRwLockTest: {
-      ipc_manager->DelTask(task_ptr.template Cast<CoRwLockTestTask>());
-      break;
-    }
-    case Method::kWaitTest: {
-      ipc_manager->DelTask(task_ptr.template Cast<WaitTestTask>());
-      break;
-    }
-    case Method::kTestLargeOutput: {
-      ipc_manager->DelTask(task_ptr.template Cast<TestLargeOutputTask>());
-      break;
-    }
-    case Method::kGpuSubmit: {
-      ipc_manager->DelTask(task_ptr.template Cast<GpuSubmitTask>());
-      break;
-    }
-    case Method::kSubtaskTest: {
-      ipc_manager->DelTask(task_ptr.template Cast<SubtaskTestTask>());
-      break;
-    }
-    default: {
-      ipc_manager->DelTask(task_ptr);
-      break;
-    }
-  }
+  ipc_manager->DelTask(task_ptr);
 }
 
 } // namespace chimaera::MOD_NAME
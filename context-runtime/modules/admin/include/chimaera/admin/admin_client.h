@@ -112,16 +112,19 @@ class Client : public chi::ContainerClient {
    * @param pool_query Pool query for routing
    * @param transfer_flags Transfer flags
    * @param period_us Period in microseconds (default 25us)
+   * @param shard Network shard whose NetQueue lane this task polls
    * @return Future for the periodic SendTask
    */
   chi::Future<SendTask> AsyncSendPoll(const chi::PoolQuery& pool_query,
                                       chi::u32 transfer_flags = 0,
-                                      double period_us = 25) {
+                                      double period_us = 25,
+                                      chi::u32 shard = 0) {
     auto* ipc_manager = CHI_IPC;
 
     // Allocate SendTask for polling
     auto task = ipc_manager->NewTask<SendTask>(chi::CreateTaskId(), pool_id_,
                                                pool_query, transfer_flags);
+    task->task_group_ = chi::TaskGroup(shard);  // Pins it to the shard worker
 
     // Set task as periodic if period is specified
     if (period_us > 0) {
@@ -137,15 +140,18 @@ class Client : public chi::ContainerClient {
    * Receive tasks from network (asynchronous)
    * Can be used for both SerializeIn (receiving inputs) and SerializeOut
    * (receiving outputs)
+   * @param shard Network shard whose server this task polls
    */
   chi::Future<RecvTask> AsyncRecv(const chi::PoolQuery& pool_query,
                                   chi::u32 transfer_flags = 0,
-                                  double period_us = 25) {
+                                  double period_us = 25,
+                                  chi::u32 shard = 0) {
     auto* ipc_manager = CHI_IPC;
 
     // Allocate RecvTask
     auto task = ipc_manager->NewTask<RecvTask>(chi::CreateTaskId(), pool_id_,
                                                pool_query, transfer_flags);
+    task->task_group_ = chi::TaskGroup(shard);  // Pins it to the shard worker
 
     // Set task as periodic if period is specified
     if (period_us > 0) {
@@ -367,7 +373,8 @@ class Client : public chi::ContainerClient {
 
   /**
    * AddNode - Register a new node with all nodes in the cluster
-   * @param pool_query Pool routing (use Broadcast to reach all nodes)
+   * @param pool_query Pool routing (use Dynamic so the local admin assigns
+   *        the node ID and host table version, then broadcasts)
    * @param new_node_ip IP address of the new node
    * @param new_node_port Port of the new node's runtime
    * @return Future for the AddNode task
@@ -405,12 +412,15 @@ class Client : public chi::ContainerClient {
   /**
    * Heartbeat - Liveness probe to a specific node
    * @param pool_query Pool routing (use Physical(node_id) to target a node)
+   * @param gossip Membership updates to piggyback (HeartbeatTask::PackGossip)
    * @return Future for the HeartbeatTask
    */
-  chi::Future<HeartbeatTask> AsyncHeartbeat(const chi::PoolQuery& pool_query) {
+  chi::Future<HeartbeatTask> AsyncHeartbeat(
+      const chi::PoolQuery& pool_query,
+      const std::vector<chi::u64>& gossip = {}) {
     auto* ipc_manager = CHI_IPC;
     auto task = ipc_manager->NewTask<HeartbeatTask>(
-        chi::CreateTaskId(), pool_id_, pool_query);
+        chi::CreateTaskId(), pool_id_, pool_query, gossip);
     return ipc_manager->Send(task);
   }
 
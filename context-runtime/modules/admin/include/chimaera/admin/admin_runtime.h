@@ -45,8 +45,12 @@
 #include <hermes_shm/memory/allocator/malloc_allocator.h>
 
 #include <deque>
+#include <memory>
+#include <mutex>
 #include <random>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace chimaera::admin {
 
@@ -63,6 +67,69 @@ struct RetryEntry {
   std::chrono::steady_clock::time_point enqueued_at;
 };
 
+/**
+ * Tasks bound for one node, packed into a single lightbeam message
+ * SendIn batches hold replica copies; SendOut batches hold completed tasks
+ */
+struct NetBatch {
+  std::unique_ptr<chi::SaveTaskArchive> archive;
+  hshm::lbm::Transport *transport = nullptr;
+  std::vector<hipc::FullPtr<chi::Task>> tasks;
+  size_t bytes = 0;  /**< Bulk bytes queued so far */
+  std::chrono::steady_clock::time_point opened_at;
+};
+
+/** A request sent to a remote node, awaiting its RecvOut */
+struct InflightSend {
+  chi::u64 node_id = 0;
+  std::chrono::steady_clock::time_point sent_at;
+};
+
+/** Buckets of the lock-free send/recv/in-flight maps of each network shard */
+static constexpr size_t kNumMapBuckets = 1024;
+
+/** A reply of a RecvOut batch resolved to the request it answers */
+struct NetReply {
+  size_t net_key = 0;
+  hipc::FullPtr<chi::Task> origin;
+  hipc::FullPtr<chi::Task> replica;
+  chi::Container *container = nullptr;
+};
+
+/**
+ * Network state owned by one shard's net worker (no locking)
+ * A task's shard is IpcManager::GetNetShard(net_key), so the request, its
+ * remote execution and its reply are all handled by the same shard on both
+ * nodes. Only stale_nodes is written by other shards.
+ */
+struct NetShard {
+  chi::u32 id = 0;
+  hshm::priv::unordered_map_ll<size_t, hipc::FullPtr<chi::Task>> send_map{
+      kNumMapBuckets};  ///< Tasks sent to remote nodes, by net_key
+  hshm::priv::unordered_map_ll<size_t, hipc::FullPtr<chi::Task>> recv_map{
+      kNumMapBuckets};  ///< Tasks received from remote nodes, by recv key
+  std::deque<RetryEntry> send_in_retry;
+  std::deque<RetryEntry> send_out_retry;
+  std::unordered_map<chi::u64, NetBatch> send_in_batches;
+  std::unordered_map<chi::u64, NetBatch> send_out_batches;
+  hshm::priv::unordered_map_ll<size_t, InflightSend> inflight_sends{
+      kNumMapBuckets};  ///< Requests awaiting a reply, by recv key
+  std::unordered_map<chi::u64, chi::u32> node_inflight;
+  std::unordered_map<chi::u64, float> node_srtt_us;
+  std::unordered_map<chi::u64, chi::u32> next_stripe;  ///< Per-node rotation
+  /** Sent responses, deleted on the next pass for zero-copy send safety */
+  std::vector<hipc::FullPtr<chi::Task>> send_out_deferred;
+  /** Compressed bulk copies, freed on the next pass like send_out_deferred */
+  std::vector<hipc::FullPtr<char>> send_compressed_deferred;
+  /** kWireCodec* bits each peer advertised in its last message here */
+  std::unordered_map<chi::u64, chi::u32> peer_codecs;
+  /** Scratch list of the replies in the RecvOut batch being processed */
+  std::vector<NetReply> recv_replies;
+  /** Restarted nodes found by other shards, flushed on the next pass */
+  std::mutex stale_nodes_lock;
+  std::vector<chi::u64> stale_nodes;
+};
+
 // Admin local queue indices
 enum AdminQueueIndex {
   kMetadataQueue = 0,          // Queue for metadata operations
@@ -106,12 +173,33 @@ private:
       system_stats_ring_;
   hshm::CpuTimes prev_cpu_times_;
 
-  // Network task tracking maps (keyed by net_key for efficient lookup)
-  // Using lock-free unordered_map_ll with 1024 buckets for high concurrency
-  // Thread safety: All Send/Recv tasks are routed to a single dedicated net worker
-  static constexpr size_t kNumMapBuckets = 1024;
-  hshm::priv::unordered_map_ll<size_t, hipc::FullPtr<chi::Task>> send_map_{kNumMapBuckets};  // Tasks sent to remote nodes
-  hshm::priv::unordered_map_ll<size_t, hipc::FullPtr<chi::Task>> recv_map_{kNumMapBuckets};  // Tasks received from remote nodes
+  // Per-worker counter samples taken with each system_stats sample
+  static inline constexpr size_t kWorkerSampleRingSize = 4096;
+  std::unique_ptr<hipc::circular_mpsc_ring_buffer<WorkerSample, hipc::MallocAllocator>>
+      worker_sample_ring_;
+
+  // Stat subscriptions (the "subscribe" monitor query). While anyone is
+  // subscribed, SystemMonitor flattens workers, lanes, net queues and bdev
+  // targets into stat_snapshot_, and each call returns only the values
+  // that changed since the subscriber's previous call.
+  struct StatSubscriber {
+    std::unordered_map<std::string, double> sent_;  // Values last returned
+    chi::u64 seq_ = 0;            // Snapshot last returned (0 = none)
+    chi::u64 round_ = 0;          // Caller's number for the last call
+    uint64_t last_call_ns_ = 0;   // Steady clock time of the last call
+  };
+  static inline constexpr uint64_t kStatSubscriberIdleNs = 60000000000ULL;
+  static inline constexpr chi::u32 kStatSubscribeMaxWaitMs = 10000;
+  static inline constexpr double kStatSubscribePollUs = 10000.0;
+  std::mutex stat_lock_;  // Monitor and SystemMonitor may run on two workers
+  std::unordered_map<std::string, StatSubscriber> stat_subscribers_;
+  std::unordered_map<std::string, double> stat_snapshot_;
+  chi::u64 stat_seq_ = 0;
+  uint64_t stat_timestamp_ns_ = 0;
+
+  // Network task tracking state, one shard per net worker
+  // Thread safety: each shard's Send/Recv tasks run on its own net worker
+  std::vector<std::unique_ptr<NetShard>> net_shards_;
 
 public:
   /**
@@ -194,15 +282,122 @@ public:
    */
   chi::TaskResume Send(hipc::FullPtr<SendTask> task, chi::RunContext &rctx);
 
+  /**
+   * Helper: Get the network shard with the given index
+   * @param shard Shard index; out-of-range indices map to shard 0
+   * @return The shard's state
+   */
+  NetShard &GetNetShard(chi::u32 shard);
+
   /**
    * Helper: Send task inputs to remote node
    */
-  void SendIn(hipc::FullPtr<chi::Task> origin_task, chi::RunContext &rctx);
+  void SendIn(NetShard &net, hipc::FullPtr<chi::Task> origin_task,
+              chi::RunContext &rctx);
 
   /**
    * Helper: Send task outputs back to origin node
    */
-  void SendOut(hipc::FullPtr<chi::Task> origin_task);
+  void SendOut(NetShard &net, hipc::FullPtr<chi::Task> origin_task);
+
+  /**
+   * Helper: Get the connection to use for the next task bound for a node
+   * Reuses the open batch's stripe, else rotates over networking.stripes
+   * connections to the peer's server for this shard
+   * @param net Network shard
+   * @param node_id Destination node
+   * @param addr Destination address
+   * @param msg_type kSerializeIn (requests) or kSerializeOut (responses)
+   * @return Lightbeam client, or nullptr if it could not be created
+   */
+  hshm::lbm::Transport *GetNetClient(NetShard &net, chi::u64 node_id,
+                                     const std::string &addr,
+                                     chi::MsgType msg_type);
+
+  /**
+   * Helper: Append a serialized task to the batch for a destination node
+   * Flushes the batch when it reaches the configured size limits
+   * @param net Network shard
+   * @param node_id Destination node
+   * @param transport Lightbeam client for the node
+   * @param msg_type kSerializeIn (requests) or kSerializeOut (responses)
+   * @param container Container owning the task's method
+   * @param task_ptr Task copy (requests) or completed task (responses)
+   */
+  void EnqueueNetTask(NetShard &net, chi::u64 node_id,
+                      hshm::lbm::Transport *transport,
+                      chi::MsgType msg_type, chi::Container *container,
+                      hipc::FullPtr<chi::Task> task_ptr);
+
+  /**
+   * Helper: Send one coalesced batch and reset it
+   * On failure the node is marked dead and every task goes to the retry queue
+   * @param net Network shard
+   * @param node_id Destination node
+   * @param batch Batch to send
+   * @param msg_type kSerializeIn or kSerializeOut
+   */
+  void FlushNetBatch(NetShard &net, chi::u64 node_id, NetBatch &batch,
+                     chi::MsgType msg_type);
+
+  /**
+   * Helper: Stamp an outgoing archive with this node and its wire codecs,
+   * then compress its large bulks if the peer decodes the configured codec
+   * Only ZeroMQ and socket transports are compressed; RDMA reads the
+   * exposed buffer directly
+   * @param net Network shard
+   * @param node_id Destination node
+   * @param archive Archive about to be sent
+   * @param transport Transport the archive goes out on
+   */
+  void CompressNetBulks(NetShard &net, chi::u64 node_id,
+                        chi::SaveTaskArchive &archive,
+                        hshm::lbm::Transport *transport);
+
+  /**
+   * Helper: Record the sender's wire codecs and restore its compressed
+   * bulks in place, before the tasks are loaded
+   * @param net Network shard the message arrived on
+   * @param archive Received archive
+   * @return false if a bulk failed to decompress
+   */
+  bool DecompressNetBulks(NetShard &net, chi::LoadTaskArchive &archive);
+
+  /**
+   * Helper: Flush batches that are due at the end of a Send pass
+   * Responses always go out. Requests go out when nothing is in flight to
+   * the node (Nagle) or once held for min(srtt / 4, coalesce_delay_us)
+   * @param net Network shard
+   * @return true if any batch is still held
+   */
+  bool FlushDueNetBatches(NetShard &net);
+
+  /**
+   * Helper: Record the reply to an in-flight request
+   * Updates the node's smoothed RTT and its in-flight count
+   * @param net Network shard
+   * @param recv_key Key built from the reply's net_key and replica_id
+   */
+  void RecordNetReply(NetShard &net, size_t recv_key);
+
+  /**
+   * Helper: Aggregate one reply into its request
+   * Completes the request with EndTask once every replica has replied
+   * @param net Network shard owning the request
+   * @param reply Reply resolved to its origin, replica and container
+   * @return True if the reply completed the request
+   */
+  bool FinishNetReply(NetShard &net, const NetReply &reply);
+
+  /**
+   * Helper: Resolve a completed replica that SendIn ran on this node
+   * @param net Network shard owning the request
+   * @param task Completed task popped for SendOut
+   * @param reply Output: the task resolved to its origin and container
+   * @return True if task is the replica itself, not a decoded loopback copy
+   */
+  bool FindLocalReply(NetShard &net, hipc::FullPtr<chi::Task> task,
+                      NetReply &reply);
 
   /**
    * Handle Recv - Receive task inputs or outputs from network
@@ -242,12 +437,27 @@ public:
    *   "pool_stats://<pool_id>:<routing>:<selector>" - delegate to a pool
    *   "system_stats[:<min_event_id>]" - system resource utilization
    *   "bdev_stats" - block device statistics
+   *   "subscribe:<id>[:<round>[:<wait_ms>]]" - long-poll for the stats that
+   *       changed since the previous call (see MonitorSubscribe)
+   *   "container_stats" - per-method model and moving-average cost table
+   *   "task_latency" - per-(pool, method) lifecycle latency percentiles
+   *   "trace_start[:<events>]" / "trace_stop" - toggle timeline capture
+   *   "trace_dump" - captured timeline as a Chrome trace JSON fragment
    */
   chi::TaskResume Monitor(hipc::FullPtr<MonitorTask> task, chi::RunContext &rctx);
 
   /** Monitor sub-handler: collect per-worker statistics. */
   void MonitorWorkerStats(hipc::FullPtr<MonitorTask> task);
 
+  /** Monitor sub-handler: merge workers' lifecycle latency histograms. */
+  void MonitorTaskLatency(hipc::FullPtr<MonitorTask> task);
+
+  /** Monitor sub-handler: report coroutine frame pool counters. */
+  void MonitorCoroFrames(hipc::FullPtr<MonitorTask> task);
+
+  /** Monitor sub-handler: start, stop or dump the task timeline trace. */
+  void MonitorTrace(hipc::FullPtr<MonitorTask> task);
+
   /** Monitor sub-handler: return per-container model statistics. */
   void MonitorContainerStats(hipc::FullPtr<MonitorTask> task);
 
@@ -257,9 +467,28 @@ public:
   /** Monitor sub-handler: return system_stats ring buffer entries. */
   void MonitorSystemStats(hipc::FullPtr<MonitorTask> task);
 
+  /** Monitor sub-handler: return worker_samples ring buffer entries. */
+  void MonitorWorkerSamples(hipc::FullPtr<MonitorTask> task);
+
+  /** Push one WorkerSample per worker into worker_sample_ring_. */
+  void SampleWorkers(uint64_t timestamp_ns);
+
   /** Monitor sub-handler: collect bdev pool statistics. */
   chi::TaskResume MonitorBdevStats(hipc::FullPtr<MonitorTask> task);
 
+  /**
+   * Monitor sub-handler: wait for a stat snapshot the subscriber has not
+   * been sent and return the values that changed since its previous call.
+   */
+  chi::TaskResume MonitorSubscribe(hipc::FullPtr<MonitorTask> task);
+
+  /**
+   * Flatten worker, lane, net queue and bdev target stats into
+   * stat_snapshot_. Does nothing while nobody is subscribed.
+   * @param stats System sample SystemMonitor just took
+   */
+  chi::TaskResume SnapshotStats(SystemStats stats);
+
   /** Monitor sub-handler: return host info (hostname, IP, node_id). */
   void MonitorGetHostInfo(hipc::FullPtr<MonitorTask> task);
 
@@ -348,12 +577,12 @@ public:
   /**
    * Helper: Receive task inputs from remote node
    */
-  void RecvIn(hipc::FullPtr<RecvTask> task, chi::LoadTaskArchive& archive, hshm::lbm::Transport* lbm_transport);
+  void RecvIn(NetShard &net, hipc::FullPtr<RecvTask> task, chi::LoadTaskArchive& archive, hshm::lbm::Transport* lbm_transport);
 
   /**
    * Helper: Receive task outputs from remote node
    */
-  void RecvOut(hipc::FullPtr<RecvTask> task, chi::LoadTaskArchive& archive, hshm::lbm::Transport* lbm_transport);
+  void RecvOut(NetShard &net, hipc::FullPtr<RecvTask> task, chi::LoadTaskArchive& archive, hshm::lbm::Transport* lbm_transport);
 
   /**
    * Get live task statistics per method.
@@ -439,20 +668,24 @@ public:
   /**
    * Process retry queues: retry sends to revived nodes, re-route via
    * recovery address map updates, timeout stale entries
+   * @param net Network shard whose queues to process
    */
-  void ProcessRetryQueues();
+  void ProcessRetryQueues(NetShard &net);
 
   /**
-   * Scan send_map_ for tasks waiting on dead nodes and time them out
+   * Scan a shard's send_map for tasks waiting on dead nodes and time them out
+   * @param net Network shard
    */
-  void ScanSendMapTimeouts();
+  void ScanSendMapTimeouts(NetShard &net);
 
   /**
    * Flush stale retry-queue entries and send_map origins targeting a node
    * that is about to be marked alive (restarted). Old tasks from the
    * previous incarnation must not be resent to a fresh runtime.
+   * @param net Network shard to flush
+   * @param node_id Restarted node
    */
-  void FlushStaleStateForNode(chi::u64 node_id);
+  void FlushStaleStateForNode(NetShard &net, chi::u64 node_id);
 
 private:
   /**
@@ -460,10 +693,6 @@ private:
    */
   void InitiateShutdown(chi::u32 grace_period_ms);
 
-  // Retry queues for tasks that failed to send due to dead nodes
-  std::deque<RetryEntry> send_in_retry_;
-  std::deque<RetryEntry> send_out_retry_;
-
   // SWIM failure detection state
   struct PendingProbe {
     chi::Future<HeartbeatTask> future;
@@ -477,15 +706,74 @@ private:
     std::chrono::steady_clock::time_point sent_at;
   };
 
-  size_t probe_round_robin_idx_ = 0;
+  /** A membership update still being piggybacked on heartbeats */
+  struct SwimUpdate {
+    chi::u64 node_id;
+    chi::NodeState state;
+    chi::u32 incarnation;
+    chi::u32 sends_left;  // Retransmissions before the update is dropped
+  };
+
+  std::vector<chi::u64> probe_order_;  // Randomized round-robin probe order
+  size_t probe_order_idx_ = 0;
   std::vector<PendingProbe> pending_direct_probes_;
   std::vector<PendingIndirectProbe> pending_indirect_probes_;
   std::mt19937 probe_rng_{std::random_device{}()};
+  std::mutex swim_lock_;  // Heartbeat and HeartbeatProbe may run on two workers
+  std::vector<SwimUpdate> swim_updates_;
+  std::unordered_map<chi::u64, chi::u32> node_incarnation_;
+  std::vector<chi::u64> swim_dead_;  // Declared dead by gossip, to recover
+  chi::u32 self_incarnation_ = 0;    // Seeded from the clock in Create
+  chi::u32 local_health_ = 0;        // Lifeguard local health multiplier
 
   static constexpr float kDirectProbeTimeoutSec = 5.0f;
   static constexpr float kIndirectProbeTimeoutSec = 3.0f;
   static constexpr size_t kIndirectProbeHelpers = 3;
   static constexpr float kSuspicionTimeoutSec = 10.0f;
+  static constexpr size_t kMaxGossipPerMessage = 8;
+  static constexpr chi::u32 kGossipRetransmitMult = 4;
+  static constexpr chi::u32 kMaxLocalHealth = 8;
+
+  // Live migration: pre-copy rounds run until a round leaves at most
+  // kMigrateFinalSyncEntries changed entries, or kMaxMigratePrecopyRounds
+  static constexpr chi::u32 kMaxMigratePrecopyRounds = 8;
+  static constexpr chi::u64 kMigrateFinalSyncEntries = 64;
+
+  /**
+   * Queue a membership update for dissemination, replacing older news
+   * about the same node. Caller holds swim_lock_.
+   * @param node_id Node the update is about
+   * @param state Reported state
+   * @param incarnation Incarnation the state applies to
+   */
+  void QueueSwimUpdate(chi::u64 node_id, chi::NodeState state,
+                       chi::u32 incarnation);
+
+  /**
+   * Pack the freshest queued updates into a heartbeat's gossip list
+   * @param gossip Output list (see HeartbeatTask::PackGossip)
+   */
+  void PiggybackSwimUpdates(std::vector<chi::u64> &gossip);
+
+  /**
+   * Apply membership updates received on a heartbeat
+   * Refutes suspicion of this node by bumping its incarnation. Nodes the
+   * gossip declares dead are queued in swim_dead_ for recovery.
+   * @param gossip Received list
+   */
+  void ApplySwimUpdates(const std::vector<chi::u64> &gossip);
+
+  /**
+   * Seconds a node stays suspected before it is declared dead
+   * Grows with log10 of the cluster size, as in SWIM
+   */
+  float GetSuspicionTimeoutSec() const;
+
+  /**
+   * Next node to probe from a per-round shuffled order of peers
+   * @return Node ID, or self when there is no peer to probe
+   */
+  chi::u64 NextProbeTarget();
 
   // Recovery state
   std::vector<chi::RecoveryAssignment> ComputeRecoveryPlan(chi::u64 dead_node_id);
@@ -786,6 +786,8 @@ struct ClientConnectTask : public chi::Task {
 
   // Worker task queue SHM offset (for SHM-mode client attach)
   OUT chi::u64 worker_queues_off_;  ///< SHM offset of worker_queues_ within main allocator
+  OUT chi::u64 client_credits_off_;  ///< SHM offset of the ClientCreditTable (0 = none)
+  OUT chi::u64 lane_stats_off_;  ///< SHM offset of the LaneStatsTable (0 = none)
 
   // GPU queue info (populated by server if GPUs are present)
   OUT chi::u32 num_gpus_;  ///< Number of GPU devices
@@ -804,6 +806,8 @@ struct ClientConnectTask : public chi::Task {
         server_generation_(0),
         server_pid_(0),
         worker_queues_off_(0),
+        client_credits_off_(0),
+        lane_stats_off_(0),
         num_gpus_(0),
         gpu_queue_depth_(0) {
     memset(cpu2gpu_queue_off_, 0, sizeof(cpu2gpu_queue_off_));
@@ -823,6 +827,8 @@ struct ClientConnectTask : public chi::Task {
         server_generation_(0),
         server_pid_(0),
         worker_queues_off_(0),
+        client_credits_off_(0),
+        lane_stats_off_(0),
         num_gpus_(0),
         gpu_queue_depth_(0) {
     task_id_ = task_node;
@@ -846,7 +852,8 @@ struct ClientConnectTask : public chi::Task {
   template <typename Archive>
   HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
     Task::SerializeOut(ar);
-    ar(response_, server_generation_, server_pid_, worker_queues_off_, num_gpus_, gpu_queue_depth_);
+    ar(response_, server_generation_, server_pid_, worker_queues_off_,
+       client_credits_off_, lane_stats_off_, num_gpus_, gpu_queue_depth_);
     for (chi::u32 i = 0; i < kMaxGpuDevices; ++i) {
       ar(cpu2gpu_queue_off_[i], gpu2cpu_queue_off_[i], gpu2gpu_queue_off_[i],
          cpu2gpu_backend_size_[i], gpu2cpu_backend_size_[i]);
@@ -866,6 +873,8 @@ struct ClientConnectTask : public chi::Task {
     server_generation_ = other->server_generation_;
     server_pid_ = other->server_pid_;
     worker_queues_off_ = other->worker_queues_off_;
+    client_credits_off_ = other->client_credits_off_;
+    lane_stats_off_ = other->lane_stats_off_;
     num_gpus_ = other->num_gpus_;
     gpu_queue_depth_ = other->gpu_queue_depth_;
     memcpy(cpu2gpu_queue_off_, other->cpu2gpu_queue_off_,
@@ -1139,6 +1148,9 @@ class TaskBatch {
     // Append serialized data
     const auto &data = archive.GetData();
     serialized_data_.insert(serialized_data_.end(), data.begin(), data.end());
+
+    // The runtime deserializes its own copy; this one is no longer needed
+    CHI_IPC->DelTask(task);
 #endif  // HSHM_IS_HOST
   }
 
@@ -1187,6 +1199,11 @@ struct SubmitBatchTask : public chi::Task {
   // Results
   OUT chi::u32 tasks_completed_;         ///< Number of tasks completed
   OUT chi::priv::string error_message_;  ///< Error description if failed
+  OUT std::vector<chi::u32> return_codes_;  ///< Per sub-task return code
+  OUT std::vector<char> serialized_out_;  ///< Outputs of sub-tasks that ran
+
+  /** return_codes_ entry for a sub-task that could not be loaded */
+  static constexpr chi::u32 kNotRun = ~static_cast<chi::u32>(0);
 
   /**
    * SHM default constructor
@@ -1196,7 +1213,9 @@ struct SubmitBatchTask : public chi::Task {
         task_infos_(),
         serialized_data_(),
         tasks_completed_(0),
-        error_message_(CHI_PRIV_ALLOC) {}
+        error_message_(CHI_PRIV_ALLOC),
+        return_codes_(),
+        serialized_out_() {}
 
   /**
    * Emplace constructor
@@ -1208,7 +1227,9 @@ struct SubmitBatchTask : public chi::Task {
         task_infos_(),
         serialized_data_(),
         tasks_completed_(0),
-        error_message_(CHI_PRIV_ALLOC) {
+        error_message_(CHI_PRIV_ALLOC),
+        return_codes_(),
+        serialized_out_() {
     // Initialize task
     task_id_ = task_node;
     pool_id_ = pool_id;
@@ -1228,7 +1249,9 @@ struct SubmitBatchTask : public chi::Task {
         task_infos_(batch.GetTaskInfos()),
         serialized_data_(batch.GetSerializedData()),
         tasks_completed_(0),
-        error_message_(CHI_PRIV_ALLOC) {
+        error_message_(CHI_PRIV_ALLOC),
+        return_codes_(),
+        serialized_out_() {
     // Initialize task
     task_id_ = task_node;
     pool_id_ = pool_id;
@@ -1249,12 +1272,13 @@ struct SubmitBatchTask : public chi::Task {
 
   /**
    * Serialize OUT and INOUT parameters for network transfer
-   * This includes: tasks_completed_, error_message_
+   * This includes: tasks_completed_, error_message_, return_codes_,
+   * serialized_out_
    */
   template <typename Archive>
   HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
     Task::SerializeOut(ar);
-    ar(tasks_completed_, error_message_);
+    ar(tasks_completed_, error_message_, return_codes_, serialized_out_);
   }
 
   /**
@@ -1269,6 +1293,8 @@ struct SubmitBatchTask : public chi::Task {
     serialized_data_ = other->serialized_data_;
     tasks_completed_ = other->tasks_completed_;
     error_message_ = other->error_message_;
+    return_codes_ = other->return_codes_;
+    serialized_out_ = other->serialized_out_;
   }
 
   /**
@@ -1457,12 +1483,15 @@ struct RestartContainersTask : public chi::Task {
 
 /**
  * AddNodeTask - Register a new node with all existing nodes in the cluster
- * Broadcasts to all nodes to update their internal hostfile
+ * Broadcasts to all nodes to update their internal hostfile. Submitted with
+ * a Dynamic query, the origin's ScheduleTask fills in new_node_id_ and
+ * table_version_ so the broadcast carries one agreed host table delta.
  */
 struct AddNodeTask : public chi::Task {
   IN chi::priv::string new_node_ip_;
   IN chi::u32 new_node_port_;
-  OUT chi::u64 new_node_id_;
+  INOUT chi::u64 new_node_id_;
+  IN chi::u64 table_version_;
   OUT chi::priv::string error_message_;
 
   /** SHM default constructor */
@@ -1470,7 +1499,8 @@ struct AddNodeTask : public chi::Task {
       : chi::Task(),
         new_node_ip_(CHI_PRIV_ALLOC),
         new_node_port_(0),
-        new_node_id_(0),
+        new_node_id_(chi::IpcManager::kUnassignedNodeId),
+        table_version_(0),
         error_message_(CHI_PRIV_ALLOC) {}
 
   /** Emplace constructor */
@@ -1480,7 +1510,8 @@ struct AddNodeTask : public chi::Task {
       : chi::Task(task_node, pool_id, pool_query, Method::kAddNode),
         new_node_ip_(CHI_PRIV_ALLOC, new_node_ip),
         new_node_port_(new_node_port),
-        new_node_id_(0),
+        new_node_id_(chi::IpcManager::kUnassignedNodeId),
+        table_version_(0),
         error_message_(CHI_PRIV_ALLOC) {
     task_id_ = task_node;
     pool_id_ = pool_id;
@@ -1492,7 +1523,7 @@ struct AddNodeTask : public chi::Task {
   template <typename Archive>
   HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
     Task::SerializeIn(ar);
-    ar(new_node_ip_, new_node_port_);
+    ar(new_node_ip_, new_node_port_, new_node_id_, table_version_);
   }
 
   template <typename Archive>
@@ -1506,6 +1537,7 @@ struct AddNodeTask : public chi::Task {
     new_node_ip_ = other->new_node_ip_;
     new_node_port_ = other->new_node_port_;
     new_node_id_ = other->new_node_id_;
+    table_version_ = other->table_version_;
     error_message_ = other->error_message_;
   }
 
@@ -1636,18 +1668,23 @@ struct MigrateContainersTask : public chi::Task {
 };
 
 /**
- * HeartbeatTask - Liveness probe that just returns success
- * No input or output fields beyond base Task
+ * HeartbeatTask - SWIM liveness probe
+ * Carries piggybacked membership updates: the prober's in the request and
+ * the target's in the reply. Each update is two words, see PackGossip.
  */
 struct HeartbeatTask : public chi::Task {
+  INOUT std::vector<chi::u64> gossip_;  ///< Packed membership updates
+
   /** SHM default constructor */
   HeartbeatTask() : chi::Task() {}
 
   /** Emplace constructor */
   explicit HeartbeatTask(const chi::TaskId &task_node,
                          const chi::PoolId &pool_id,
-                         const chi::PoolQuery &pool_query)
-      : chi::Task(task_node, pool_id, pool_query, Method::kHeartbeat) {
+                         const chi::PoolQuery &pool_query,
+                         const std::vector<chi::u64> &gossip = {})
+      : chi::Task(task_node, pool_id, pool_query, Method::kHeartbeat),
+        gossip_(gossip) {
     task_id_ = task_node;
     pool_id_ = pool_id;
     method_ = Method::kHeartbeat;
@@ -1655,18 +1692,52 @@ struct HeartbeatTask : public chi::Task {
     pool_query_ = pool_query;
   }
 
+  /**
+   * Append a membership update to a gossip list
+   * @param gossip List to append to
+   * @param node_id Node the update is about
+   * @param state State the sender believes the node is in
+   * @param incarnation Incarnation of the node the state applies to
+   */
+  static void PackGossip(std::vector<chi::u64> &gossip, chi::u64 node_id,
+                         chi::NodeState state, chi::u32 incarnation) {
+    gossip.push_back(node_id);
+    gossip.push_back((static_cast<chi::u64>(incarnation) << 32) |
+                     static_cast<chi::u32>(state));
+  }
+
+  /**
+   * Decode the update at index i of a gossip list
+   * @param gossip List produced by PackGossip
+   * @param i Update index (not word index)
+   * @param node_id Output: node the update is about
+   * @param state Output: reported state
+   * @param incarnation Output: reported incarnation
+   */
+  static void UnpackGossip(const std::vector<chi::u64> &gossip, size_t i,
+                           chi::u64 &node_id, chi::NodeState &state,
+                           chi::u32 &incarnation) {
+    node_id = gossip[2 * i];
+    chi::u64 word = gossip[2 * i + 1];
+    state = static_cast<chi::NodeState>(word & 0xffffffffULL);
+    incarnation = static_cast<chi::u32>(word >> 32);
+  }
+
   template <typename Archive>
   HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
     Task::SerializeIn(ar);
+    ar(gossip_);
   }
 
   template <typename Archive>
   HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
     Task::SerializeOut(ar);
+    ar(gossip_);
   }
 
   void Copy(const hipc::FullPtr<HeartbeatTask> &other) {
     Task::Copy(other.template Cast<Task>());
+    gossip_ = other->gossip_;
   }
 
   void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
@@ -1859,6 +1930,46 @@ struct SystemStats {
         hbm_total_bytes_(0) {}
 };
 
+/**
+ * WorkerSample - One worker's counters at a SystemMonitor tick.
+ * Time and task counts are cumulative since the worker started; diff two
+ * samples of the same worker for rates. Trivially copyable for ring
+ * buffer storage.
+ */
+struct WorkerSample {
+  static constexpr uint32_t kNumMethodSlots =
+      chi::WorkerCounters::kNumMethodSlots;
+
+  uint64_t timestamp_ns_;       // steady_clock nanoseconds (monotonic)
+  uint32_t worker_id_;          // Worker index in the WorkOrchestrator
+  uint64_t busy_us_;            // Time outside idle polling and sleep
+  uint64_t idle_cpu_us_;        // Idle time spent polling or spinning
+  uint64_t sleep_us_;           // Idle time blocked in epoll
+  uint64_t tasks_processed_;    // Tasks completed
+  uint64_t resumes_;            // Coroutine resumptions
+  uint32_t lane_depth_;         // Tasks waiting in the worker's lane
+  uint32_t blocked_tasks_;      // Tasks in the blocked queues
+  uint32_t periodic_tasks_;     // Tasks in the periodic queues
+  uint32_t retry_tasks_;        // Tasks in the retry queue
+  float load_us_;               // Predicted CPU time of active tasks
+  uint64_t method_tasks_[kNumMethodSlots];  // Completed tasks per method ID
+
+  WorkerSample()
+      : timestamp_ns_(0),
+        worker_id_(0),
+        busy_us_(0),
+        idle_cpu_us_(0),
+        sleep_us_(0),
+        tasks_processed_(0),
+        resumes_(0),
+        lane_depth_(0),
+        blocked_tasks_(0),
+        periodic_tasks_(0),
+        retry_tasks_(0),
+        load_us_(0),
+        method_tasks_{} {}
+};
+
 /**
  * SystemMonitorTask - Periodic task that samples system resource utilization.
  * No IN/OUT fields — the task is just a trigger.
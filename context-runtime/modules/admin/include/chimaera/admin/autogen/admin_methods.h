@@ -2,6 +2,7 @@
 #define CHIMAERA_ADMIN_AUTOGEN_METHODS_H_
 
 #include <chimaera/chimaera.h>
+#include <chimaera/method_traits.h>
 #include <string>
 #include <vector>
 
@@ -77,6 +78,49 @@ inline const std::vector<std::string>& GetMethodNames() {
   }();
   return names;
 }
+
+/** Per-method traits indexed by method ID (see chimaera_mod.yaml) */
+inline constexpr chi::MethodTraits kMethodTraits[34] = {
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 0: Create
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 1: Destroy
+    {},  // 2
+    {},  // 3
+    {},  // 4
+    {},  // 5
+    {},  // 6
+    {},  // 7
+    {},  // 8
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 9: Monitor
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 10: GetOrCreatePool
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 11: DestroyPool
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 12: StopRuntime
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 13: Flush
+    {chi::MethodRoute::kNetwork, chi::kMethodDefined, 0},  // 14: Send
+    {chi::MethodRoute::kNetwork, chi::kMethodDefined, 0},  // 15: Recv
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 16: ClientConnect
+    {},  // 17
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 18: SubmitBatch
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 19: WreapDeadIpcs
+    {chi::MethodRoute::kNetwork, chi::kMethodDefined, 0},  // 20: ClientRecv
+    {chi::MethodRoute::kNetwork, chi::kMethodDefined, 0},  // 21: ClientSend
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 22: RegisterMemory
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 23: RestartContainers
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 24: AddNode
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 25: ChangeAddressTable
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 26: MigrateContainers
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 27: Heartbeat
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 28: HeartbeatProbe
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 29: ProbeRequest
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 30: RecoverContainers
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 31: SystemMonitor
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 32: AnnounceShutdown
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 33: RegisterGpuContainer
+};
+
+/** @return Traits of a method, or chi::kNoMethodTraits if unknown */
+constexpr const chi::MethodTraits& GetMethodTraits(chi::u32 method) {
+  return method < 34 ? kMethodTraits[method] : chi::kNoMethodTraits;
+}
 }  // namespace Method
 
 }  // namespace chimaera::admin
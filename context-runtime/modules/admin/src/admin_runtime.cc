@@ -45,11 +45,16 @@
 #include <chimaera/pool_manager.h>
 #include <chimaera/task_archives.h>
 #include <chimaera/worker.h>
+#include <hermes_shm/compress/compress_factory.h>
 #include <hermes_shm/lightbeam/transport_factory_impl.h>
 #include <hermes_shm/serialize/msgpack_wrapper.h>
 
 #include "hermes_shm/data_structures/serialization/global_serialize.h"
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <filesystem>
 #include <memory>
 #include <unordered_map>
@@ -58,6 +63,98 @@
 
 namespace chimaera::admin {
 
+namespace {
+
+/** Key of a replica in a shard recv_map: net_key_ mixed with the replica id */
+size_t NetRecvKey(const chi::TaskId &task_id) {
+  return task_id.net_key_ ^
+         (static_cast<size_t>(task_id.replica_id_) * 0x9e3779b97f4a7c15ULL);
+}
+
+/** Network shard a periodic Send/Recv task serves: its affinity group */
+chi::u32 NetShardOf(const chi::Task &task) {
+  return task.task_group_.IsNull() ? 0
+                                   : static_cast<chi::u32>(task.task_group_.id_);
+}
+
+/** Mark an outgoing archive with this node and the codecs it decodes */
+void StampNetArchive(chi::NetTaskArchive &archive) {
+  auto *ipc_manager = CHI_IPC;
+  archive.src_node_ = ipc_manager->GetNodeId();
+#if HSHM_ENABLE_COMPRESS
+  archive.codec_mask_ = chi::kWireCodecLz4 | chi::kWireCodecZstd;
+#endif
+}
+
+#if HSHM_ENABLE_COMPRESS
+/** Under "auto", bulks from this size use zstd; lz4 keeps up below it */
+constexpr size_t kWireZstdBytes = 1ull << 20;
+/** Bulks from this size compress zstd at the balanced level */
+constexpr size_t kWireBalancedBytes = 16ull << 20;
+/** Leading bytes trial-compressed before committing to a large bulk */
+constexpr size_t kWireProbeBytes = 16ull << 10;
+/** A bulk goes compressed only if it shrinks below this fraction */
+constexpr double kWireMaxRatio = 0.9;
+
+/** Codec chosen for one bulk */
+struct WireCodec {
+  const char *library_ = nullptr;  ///< Null sends the bulk raw
+  chi::u32 bit_ = 0;               ///< kWireCodec* bit the peer must have
+  hshm::CompressionPreset preset_ = hshm::CompressionPreset::FAST;
+};
+
+/**
+ * Pick the codec for a bulk of the given size. lz4 stays at its fast
+ * level; zstd steps up to the balanced level for transfers large enough
+ * to hide the extra CPU time
+ */
+WireCodec PickWireCodec(const std::string &mode, size_t size) {
+  WireCodec codec;
+  bool zstd = mode == "zstd" || (mode == "auto" && size >= kWireZstdBytes);
+  if (zstd) {
+    codec.library_ = "zstd";
+    codec.bit_ = chi::kWireCodecZstd;
+    codec.preset_ = size >= kWireBalancedBytes
+                        ? hshm::CompressionPreset::BALANCED
+                        : hshm::CompressionPreset::FAST;
+  } else if (mode == "lz4" || mode == "auto") {
+    codec.library_ = "lz4";
+    codec.bit_ = chi::kWireCodecLz4;
+  }
+  return codec;
+}
+
+/**
+ * Whether a bulk is not worth compressing: it starts with a zstd or lz4
+ * frame magic, or its leading bytes barely shrink under lz4. This skips
+ * blobs the compressor chimod already packed
+ */
+bool IsIncompressible(char *data, size_t size) {
+  static const unsigned char kZstdMagic[4] = {0x28, 0xb5, 0x2f, 0xfd};
+  static const unsigned char kLz4Magic[4] = {0x04, 0x22, 0x4d, 0x18};
+  if (size >= 4 && (memcmp(data, kZstdMagic, 4) == 0 ||
+                    memcmp(data, kLz4Magic, 4) == 0)) {
+    return true;
+  }
+  if (size < 4 * kWireProbeBytes) {
+    return false;
+  }
+  hshm::Compressor *probe = hshm::CompressionFactory::GetThreadLocal(
+      "lz4", hshm::CompressionPreset::FAST);
+  if (probe == nullptr) {
+    return false;
+  }
+  thread_local std::vector<char> probe_out(kWireProbeBytes * 2);
+  size_t probe_size = probe_out.size();
+  if (!probe->Compress(probe_out.data(), probe_size, data, kWireProbeBytes)) {
+    return true;
+  }
+  return probe_size > kWireProbeBytes * kWireMaxRatio;
+}
+#endif
+
+}  // namespace
+
 // Method implementations for Runtime class
 
 // Virtual method implementations (Init, Run, Del, SaveTask, LoadTask, NewCopy,
@@ -77,19 +174,28 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
   // Note: Admin container is already initialized by the framework before Create
   // is called
 
-  // Note: No locks needed - all Send/Recv tasks are routed to a single
-  // dedicated network worker, ensuring thread-safe access to
-  // send_map_/recv_map_
+  // Note: No locks needed - each shard's Send/Recv tasks are routed to that
+  // shard's dedicated network worker, ensuring thread-safe access to its
+  // send_map/recv_map
+  auto *ipc_manager = CHI_IPC;
+  chi::u32 num_shards = ipc_manager->GetNumNetShards();
+  net_shards_.clear();
+  for (chi::u32 shard = 0; shard < num_shards; ++shard) {
+    net_shards_.push_back(std::make_unique<NetShard>());
+    net_shards_.back()->id = shard;
+  }
 
   create_count_++;
 
-  // Spawn periodic Recv task with 25 microsecond period (default)
-  // Worker will automatically reschedule periodic tasks
-  client_.AsyncRecv(chi::PoolQuery::Local(), 0, 500);
+  for (chi::u32 shard = 0; shard < num_shards; ++shard) {
+    // Spawn periodic Recv task with 25 microsecond period (default)
+    // Worker will automatically reschedule periodic tasks
+    client_.AsyncRecv(chi::PoolQuery::Local(), 0, 500, shard);
 
-  // Spawn periodic Send task with 25 microsecond period
-  // This task polls net_queue_ for send operations
-  client_.AsyncSendPoll(chi::PoolQuery::Local(), 0, 500);
+    // Spawn periodic Send task with 25 microsecond period
+    // This task polls the shard's net_queue_ lane for send operations
+    client_.AsyncSendPoll(chi::PoolQuery::Local(), 0, 500, shard);
+  }
 
   // Spawn periodic ClientRecv task for client task reception via lightbeam
   client_.AsyncClientRecv(chi::PoolQuery::Local(), 100);
@@ -97,12 +203,12 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
   // Spawn periodic ClientSend task for client response sending via lightbeam
   client_.AsyncClientSend(chi::PoolQuery::Local(), 100);
 
-  // Register ALL transport FDs with the net worker's EventManager
-  // This ensures epoll wakes the net worker when data arrives on any transport
+  // Register ALL transport FDs with the net workers' EventManagers
+  // This ensures epoll wakes a net worker when data arrives on its transport
   {
-    auto *ipc_manager = CHI_IPC;
-    chi::Worker *net_worker = ipc_manager->GetScheduler()->GetNetWorker();
-    if (net_worker && ipc_manager) {
+    chi::Scheduler *scheduler = ipc_manager->GetScheduler();
+    chi::Worker *net_worker = scheduler->GetNetWorker();
+    if (net_worker) {
       auto &em = net_worker->GetEventManager();
       auto *tcp_transport = ipc_manager->GetClientTransport(chi::IpcMode::kTcp);
       if (tcp_transport) {
@@ -116,11 +222,16 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
         HLOG(kDebug,
              "Admin: IPC transport registered with net worker EventManager");
       }
-      auto *main_transport = ipc_manager->GetMainTransport();
-      if (main_transport) {
-        main_transport->RegisterEventManager(em);
+    }
+    for (chi::u32 shard = 0; shard < num_shards; ++shard) {
+      chi::Worker *shard_worker = scheduler->GetNetShardWorker(shard);
+      auto *main_transport = ipc_manager->GetMainTransport(shard);
+      if (shard_worker && main_transport) {
+        main_transport->RegisterEventManager(shard_worker->GetEventManager());
         HLOG(kDebug,
-             "Admin: Main transport registered with net worker EventManager");
+             "Admin: Shard {} transport registered with net worker "
+             "EventManager",
+             shard);
       }
     }
   }
@@ -129,7 +240,13 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
   // This task reaps shared memory segments from dead processes
   client_.AsyncWreapDeadIpcs(chi::PoolQuery::Local(), 1000000);
 
-  // Spawn periodic HeartbeatProbe task (SWIM failure detector, 2s period)
+  // Spawn periodic HeartbeatProbe task (SWIM failure detector, 2s period).
+  // The incarnation starts at the clock so a restarted node outranks what
+  // peers remember of its previous life.
+  self_incarnation_ = static_cast<chi::u32>(
+      std::chrono::duration_cast<std::chrono::seconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count());
   client_.AsyncHeartbeatProbe(chi::PoolQuery::Local(), 2000000);
 
   // Initialize system stats ring buffer and spawn periodic monitor task
@@ -137,6 +254,9 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
       hipc::circular_mpsc_ring_buffer<SystemStats, hipc::MallocAllocator>>(
       HSHM_MALLOC, kSystemStatsRingSize);
   prev_cpu_times_ = hshm::SystemInfo::GetCpuTimes();
+  worker_sample_ring_ = std::make_unique<
+      hipc::circular_mpsc_ring_buffer<WorkerSample, hipc::MallocAllocator>>(
+      HSHM_MALLOC, kWorkerSampleRingSize);
   client_.AsyncSystemMonitor(chi::PoolQuery::Local(), 1000000);  // 1s
 
   HLOG(kDebug,
@@ -164,6 +284,17 @@ chi::PoolQuery Runtime::ScheduleTask(const hipc::FullPtr<chi::Task> &task) {
       }
       return chi::PoolQuery::Broadcast();
     }
+    case Method::kAddNode: {
+      // Only the origin resolves Dynamic, so it alone picks the delta
+      auto typed = task.template Cast<AddNodeTask>();
+      auto *ipc_manager = CHI_IPC;
+      if (typed->new_node_id_ == chi::IpcManager::kUnassignedNodeId) {
+        typed->new_node_id_ =
+            ipc_manager->AssignNodeId(typed->new_node_ip_.str());
+        typed->table_version_ = ipc_manager->GetHostTableVersion() + 1;
+      }
+      return chi::PoolQuery::Broadcast();
+    }
     default:
       return task->pool_query_;
   }
@@ -364,12 +495,20 @@ chi::TaskResume Runtime::Flush(hipc::FullPtr<FlushTask> task,
 // Distributed Task Scheduling Method Implementations
 //===========================================================================
 
+NetShard &Runtime::GetNetShard(chi::u32 shard) {
+  if (shard >= net_shards_.size()) {
+    shard = 0;
+  }
+  return *net_shards_[shard];
+}
+
 /**
  * Helper function: Send task inputs to remote node
+ * @param net Network shard owning the task
  * @param origin_task Task to send to remote nodes
  * @param rctx RunContext for managing subtasks
  */
-void Runtime::SendIn(hipc::FullPtr<chi::Task> origin_task,
+void Runtime::SendIn(NetShard &net, hipc::FullPtr<chi::Task> origin_task,
                      chi::RunContext &rctx) {
   auto *ipc_manager = CHI_IPC;
   auto *pool_manager = CHI_POOL_MANAGER;
@@ -394,8 +533,8 @@ void Runtime::SendIn(hipc::FullPtr<chi::Task> origin_task,
   size_t send_map_key = size_t(origin_task.ptr_);
 
   // Add the origin task to send_map before creating copies
-  // Note: No lock needed - single net worker processes all Send/Recv tasks
-  send_map_[send_map_key] = origin_task;
+  // Note: No lock needed - only this shard's net worker touches its state
+  net.send_map[send_map_key] = origin_task;
 
   // Get pool_queries from task's RunContext
   if (!origin_task->GetRunCtx()) {
@@ -475,6 +614,22 @@ void Runtime::SendIn(hipc::FullPtr<chi::Task> origin_task,
     chi::u64 this_node_id = ipc_manager->GetNodeId();
     task_copy->pool_query_.SetReturnNode(this_node_id);
 
+    // This node's own share of a range or broadcast runs here instead of
+    // looping back through the transport. It is executed like a received
+    // task (a sub-range resolves and fans out again from this node) and
+    // SendOut aggregates the replica in place once it completes.
+    if (target_node_id == this_node_id &&
+        !origin_task->task_flags_.Any(TASK_FORCE_NET | TASK_FIRE_AND_FORGET)) {
+      task_copy->SetFlags(TASK_REMOTE);
+      task_copy->ClearFlags(TASK_PERIODIC | TASK_ROUTED |
+                            TASK_RUN_CTX_EXISTS | TASK_STARTED);
+      net.recv_map[NetRecvKey(copy_id)] = task_copy;
+      HLOG(kDebug, "[SendIn] Task {} replica {} runs on this node",
+           origin_task->task_id_, i);
+      (void)ipc_manager->Send(task_copy, false);
+      continue;
+    }
+
     // Check aliveness before sending
     if (!ipc_manager->IsAlive(target_node_id)) {
       float net_timeout = origin_task->pool_query_.GetNetTimeout();
@@ -489,72 +644,42 @@ void Runtime::SendIn(hipc::FullPtr<chi::Task> origin_task,
       HLOG(kWarning,
            "[SendIn] Task {} target node {} is dead, queuing for retry",
            origin_task->task_id_, target_node_id);
-      send_in_retry_.push_back(
+      net.send_in_retry.push_back(
           {task_copy, target_node_id, std::chrono::steady_clock::now()});
       continue;
     }
 
     // Get or create persistent Lightbeam client using connection pool
-    auto *config_manager = CHI_CONFIG_MANAGER;
-    int port = static_cast<int>(config_manager->GetPort());
     hshm::lbm::Transport *lbm_transport =
-        ipc_manager->GetOrCreateClient(target_host->ip_address, port);
+        GetNetClient(net, target_node_id, target_host->ip_address,
+                     chi::MsgType::kSerializeIn);
 
     if (!lbm_transport) {
-      HLOG(kError, "[SendIn] Task {} FAILED: Could not get client for {}:{}",
-           origin_task->task_id_, target_host->ip_address, port);
+      HLOG(kError, "[SendIn] Task {} FAILED: Could not get client for {}",
+           origin_task->task_id_, target_host->ip_address);
       ipc_manager->SetDead(target_node_id);
-      send_in_retry_.push_back(
+      net.send_in_retry.push_back(
           {task_copy, target_node_id, std::chrono::steady_clock::now()});
       continue;
     }
 
-    // Create SaveTaskArchive with SerializeIn mode and lbm_transport
-    chi::SaveTaskArchive archive(chi::MsgType::kSerializeIn, lbm_transport);
-
-    // Serialize the task using container->SaveTask (Expose will be called
-    // automatically for bulks)
-    container->SaveTask(task_copy->method_, archive, task_copy);
-
-    // Send using Lightbeam asynchronously (non-blocking)
-    // Note: No lock needed - single net worker processes all Send/Recv tasks
-    hshm::lbm::LbmContext ctx(0);  // Non-blocking async send
-    HLOG(kDebug, "[SendIn] Task {} sending to node {} via lightbeam",
+    // Coalesce with other requests bound for the same node
+    HLOG(kDebug, "[SendIn] Task {} queued for node {} via lightbeam",
          origin_task->task_id_, target_node_id);
-    int rc = lbm_transport->Send(archive, ctx);
-    HLOG(kDebug, "[SendIn] Task {} lightbeam Send rc={}", origin_task->task_id_,
-         rc);
-
-    if (rc != 0) {
-      HLOG(kError,
-           "[SendIn] Task {} Lightbeam async Send FAILED with error code {}",
-           origin_task->task_id_, rc);
-      ipc_manager->SetDead(target_node_id);
-      send_in_retry_.push_back(
-          {task_copy, target_node_id, std::chrono::steady_clock::now()});
-      continue;
-    }
+    EnqueueNetTask(net, target_node_id, lbm_transport,
+                   chi::MsgType::kSerializeIn, container, task_copy);
   }
 }
 
 /**
  * Helper function: Send task outputs back to origin node
+ * @param net Network shard owning the task
  * @param origin_task Completed task whose outputs need to be sent back
  */
-void Runtime::SendOut(hipc::FullPtr<chi::Task> origin_task) {
+void Runtime::SendOut(NetShard &net, hipc::FullPtr<chi::Task> origin_task) {
   auto *ipc_manager = CHI_IPC;
   auto *pool_manager = CHI_POOL_MANAGER;
 
-  // Flush deferred deletes from previous invocation (zero-copy send safety)
-  static std::vector<hipc::FullPtr<chi::Task>> deferred_deletes;
-  for (auto &t : deferred_deletes) {
-    auto *del_container = pool_manager->GetStaticContainer(t->pool_id_);
-    if (del_container) {
-      del_container->DelTask(t->method_, t);
-    }
-  }
-  deferred_deletes.clear();
-
   // Validate origin_task
   if (origin_task.IsNull()) {
     HLOG(kError, "SendOut: origin_task is null");
@@ -572,29 +697,39 @@ void Runtime::SendOut(hipc::FullPtr<chi::Task> origin_task) {
 
   // Remove task from recv_map as we're completing it
   // Key must match RecvIn: combines net_key and replica_id
-  // Note: No lock needed - single net worker processes all Send/Recv tasks
-  size_t recv_key = origin_task->task_id_.net_key_ ^
-                    (static_cast<size_t>(origin_task->task_id_.replica_id_) *
-                     0x9e3779b97f4a7c15ULL);
-  auto *it = recv_map_.find(recv_key);
+  // Note: No lock needed - only this shard's net worker touches its state
+  size_t recv_key = NetRecvKey(origin_task->task_id_);
+  auto *it = net.recv_map.find(recv_key);
   if (it == nullptr) {
     HLOG(kError,
          "[SendOut] Task {} FAILED: Not found in recv_map (size: {}) with "
          "recv_key {}",
-         origin_task->task_id_, recv_map_.size(), recv_key);
+         origin_task->task_id_, net.recv_map.size(), recv_key);
     return;
   }
-  recv_map_.erase(recv_key);
+  net.recv_map.erase(recv_key);
 
   // Get return node from pool_query
   chi::u64 target_node_id = origin_task->pool_query_.GetReturnNode();
 
+  // A replica SendIn ran on this node is the request's own subtask; its
+  // outputs are already in place, so aggregate it without a message
+  if (target_node_id == ipc_manager->GetNodeId()) {
+    NetReply reply;
+    if (FindLocalReply(net, origin_task, reply)) {
+      HLOG(kDebug, "[SendOut] Task {} completed on this node",
+           origin_task->task_id_);
+      FinishNetReply(net, reply);
+      return;
+    }
+  }
+
   // Check aliveness before sending output back
   if (!ipc_manager->IsAlive(target_node_id)) {
     HLOG(kWarning,
          "[SendOut] Task {} return node {} is dead, queuing for retry",
          origin_task->task_id_, target_node_id);
-    send_out_retry_.push_back(
+    net.send_out_retry.push_back(
         {origin_task, target_node_id, std::chrono::steady_clock::now()});
     return;
   }
@@ -608,49 +743,298 @@ void Runtime::SendOut(hipc::FullPtr<chi::Task> origin_task) {
   }
 
   // Get or create persistent Lightbeam client using connection pool
-  auto *config_manager = CHI_CONFIG_MANAGER;
-  int port = static_cast<int>(config_manager->GetPort());
   hshm::lbm::Transport *lbm_transport =
-      ipc_manager->GetOrCreateClient(target_host->ip_address, port);
+      GetNetClient(net, target_node_id, target_host->ip_address,
+                   chi::MsgType::kSerializeOut);
 
   if (lbm_transport == nullptr) {
-    HLOG(kError, "[SendOut] Task {} FAILED: Could not get client for {}:{}",
-         origin_task->task_id_, target_host->ip_address, port);
+    HLOG(kError, "[SendOut] Task {} FAILED: Could not get client for {}",
+         origin_task->task_id_, target_host->ip_address);
     ipc_manager->SetDead(target_node_id);
-    send_out_retry_.push_back(
+    net.send_out_retry.push_back(
         {origin_task, target_node_id, std::chrono::steady_clock::now()});
     return;
   }
 
-  // Create SaveTaskArchive with SerializeOut mode and lbm_transport
-  // The client will automatically call Expose internally during serialization
-  chi::SaveTaskArchive archive(chi::MsgType::kSerializeOut, lbm_transport);
+  // Coalesce with other responses bound for the same node; sent tasks are
+  // deleted on the next Send pass for zero-copy send safety
+  HLOG(kDebug, "[SendOut] Task {}", origin_task->task_id_);
+  EnqueueNetTask(net, target_node_id, lbm_transport,
+                 chi::MsgType::kSerializeOut, container, origin_task);
+}
+
+hshm::lbm::Transport *Runtime::GetNetClient(NetShard &net, chi::u64 node_id,
+                                            const std::string &addr,
+                                            chi::MsgType msg_type) {
+  auto &batches = msg_type == chi::MsgType::kSerializeIn
+                      ? net.send_in_batches
+                      : net.send_out_batches;
+  auto open = batches.find(node_id);
+  if (open != batches.end() && open->second.archive) {
+    return open->second.transport;
+  }
+
+  // Whole batches rotate over the stripes, so one task is never split
+  auto *ipc_manager = CHI_IPC;
+  auto *config_manager = CHI_CONFIG_MANAGER;
+  chi::u32 stripes = std::max(1u, config_manager->GetNetStripes());
+  chi::u32 stripe = net.next_stripe[node_id]++ % stripes;
+  int port = static_cast<int>(ipc_manager->GetNetShardPort(net.id));
+  return ipc_manager->GetOrCreateClient(addr, port, stripe);
+}
+
+void Runtime::EnqueueNetTask(NetShard &net, chi::u64 node_id,
+                             hshm::lbm::Transport *transport,
+                             chi::MsgType msg_type, chi::Container *container,
+                             hipc::FullPtr<chi::Task> task_ptr) {
+  auto &batches = msg_type == chi::MsgType::kSerializeIn
+                      ? net.send_in_batches
+                      : net.send_out_batches;
+  NetBatch &batch = batches[node_id];
+  if (batch.archive && batch.transport != transport) {
+    FlushNetBatch(net, node_id, batch, msg_type);
+  }
+  if (!batch.archive) {
+    batch.archive = std::make_unique<chi::SaveTaskArchive>(msg_type, transport);
+    batch.transport = transport;
+    batch.opened_at = std::chrono::steady_clock::now();
+  }
+
+  // Serialize the task (Expose is called automatically for bulks)
+  size_t prev_bulks = batch.archive->send.size();
+  container->SaveTask(task_ptr->method_, *batch.archive, task_ptr);
+  for (size_t i = prev_bulks; i < batch.archive->send.size(); ++i) {
+    batch.bytes += batch.archive->send[i].size;
+  }
+  batch.tasks.push_back(task_ptr);
 
-  // Serialize the task outputs using container->SaveTask (Expose called
-  // automatically)
-  container->SaveTask(origin_task->method_, archive, origin_task);
+  auto *config_manager = CHI_CONFIG_MANAGER;
+  if (batch.bytes >= config_manager->GetNetCoalesceBytes() ||
+      batch.tasks.size() >= config_manager->GetNetCoalesceMaxTasks()) {
+    FlushNetBatch(net, node_id, batch, msg_type);
+  }
+}
 
-  // Use non-timed, non-sync context for SendOut
-  // Note: No lock needed - single net worker processes all Send/Recv tasks
-  hshm::lbm::LbmContext ctx(0);
-  int rc = lbm_transport->Send(archive, ctx);
+void Runtime::FlushNetBatch(NetShard &net, chi::u64 node_id, NetBatch &batch,
+                            chi::MsgType msg_type) {
+  if (!batch.archive) {
+    return;
+  }
+  auto *ipc_manager = CHI_IPC;
+  bool is_send_in = msg_type == chi::MsgType::kSerializeIn;
+
+  // Non-blocking async send of the whole batch as one message. Responses are
+  // deleted on the next pass, so RDMA transports must not read them lazily;
+  // requests stay alive until the reply arrives
+  hshm::lbm::LbmContext ctx(is_send_in ? 0 : hshm::lbm::LBM_STAGE_BULKS);
+  chi::u64 trace_begin_ns = chi::TaskTracer::Stamp();
+  CompressNetBulks(net, node_id, *batch.archive, batch.transport);
+  int rc = batch.transport->Send(*batch.archive, ctx);
+  if (trace_begin_ns) {
+    chi::TaskTracer::RecordNetSend(
+        node_id, trace_begin_ns, chi::TaskTracer::Now(), batch.bytes,
+        static_cast<chi::u32>(batch.tasks.size()), !is_send_in);
+  }
+  auto now = std::chrono::steady_clock::now();
   if (rc != 0) {
-    HLOG(kError, "[SendOut] Task {} Lightbeam Send FAILED with error code {}",
-         origin_task->task_id_, rc);
-    ipc_manager->SetDead(target_node_id);
-    send_out_retry_.push_back(
-        {origin_task, target_node_id, std::chrono::steady_clock::now()});
+    HLOG(kError,
+         "[Send] Batch of {} tasks to node {} Lightbeam Send FAILED with "
+         "error code {}",
+         batch.tasks.size(), node_id, rc);
+    ipc_manager->SetDead(node_id);
+    auto &retry = is_send_in ? net.send_in_retry : net.send_out_retry;
+    for (auto &task_ptr : batch.tasks) {
+      retry.push_back({task_ptr, node_id, now});
+    }
+  } else if (is_send_in) {
+    for (auto &task_ptr : batch.tasks) {
+      net.inflight_sends[NetRecvKey(task_ptr->task_id_)] = {node_id, now};
+    }
+    net.node_inflight[node_id] += static_cast<chi::u32>(batch.tasks.size());
+  } else {
+    // Clear TASK_DATA_OWNER before deferred deletion so the destructor
+    // doesn't try to FreeBuffer on transport-allocated data
+    for (auto &task_ptr : batch.tasks) {
+      task_ptr->ClearFlags(TASK_DATA_OWNER);
+      net.send_out_deferred.push_back(task_ptr);
+    }
+  }
+  HLOG(kDebug, "[Send] Flushed {} tasks ({} bulk bytes) to node {}",
+       batch.tasks.size(), batch.bytes, node_id);
+  batch = NetBatch();
+}
+
+void Runtime::CompressNetBulks(NetShard &net, chi::u64 node_id,
+                               chi::SaveTaskArchive &archive,
+                               hshm::lbm::Transport *transport) {
+  StampNetArchive(archive);
+#if HSHM_ENABLE_COMPRESS
+  if (transport->type_ != hshm::lbm::TransportType::kZeroMq &&
+      transport->type_ != hshm::lbm::TransportType::kSocket) {
     return;
   }
+  // Only compress for a peer that has told this shard what it decodes
+  auto peer = net.peer_codecs.find(node_id);
+  if (peer == net.peer_codecs.end() || peer->second == 0) {
+    return;
+  }
+  auto *ipc_manager = CHI_IPC;
+  auto *config_manager = CHI_CONFIG_MANAGER;
+  const std::string &mode = config_manager->GetNetCompression();
+  chi::u64 min_bytes = config_manager->GetNetCompressionMinBytes();
+  for (size_t i = 0; i < archive.send.size(); ++i) {
+    hshm::lbm::Bulk &bulk = archive.send[i];
+    if (!bulk.flags.Any(BULK_XFER) || bulk.data.ptr_ == nullptr ||
+        bulk.size < min_bytes) {
+      continue;
+    }
+    WireCodec codec = PickWireCodec(mode, bulk.size);
+    if (codec.library_ == nullptr || !(peer->second & codec.bit_) ||
+        IsIncompressible(bulk.data.ptr_, bulk.size)) {
+      continue;
+    }
+    hshm::Compressor *compressor =
+        hshm::CompressionFactory::GetThreadLocal(codec.library_,
+                                                 codec.preset_);
+    if (compressor == nullptr) {
+      continue;
+    }
+    // Room for the worst-case expansion of both lz4 and zstd
+    size_t out_size = bulk.size + bulk.size / 128 + 1024;
+    hipc::FullPtr<char> out = ipc_manager->AllocateBuffer(out_size);
+    if (out.IsNull()) {
+      continue;
+    }
+    if (!compressor->Compress(out.ptr_, out_size, bulk.data.ptr_,
+                              bulk.size) ||
+        out_size > bulk.size * kWireMaxRatio) {
+      ipc_manager->FreeBuffer(out);
+      continue;
+    }
+    int library_id =
+        hshm::CompressionFactory::GetLibraryId(codec.library_, codec.preset_);
+    archive.bulk_codecs_.push_back({static_cast<chi::u32>(i),
+                                    static_cast<chi::u32>(library_id),
+                                    static_cast<chi::u64>(bulk.size)});
+    HLOG(kDebug, "[Send] Compressed bulk {} for node {}: {} -> {} bytes", i,
+         node_id, bulk.size, out_size);
+    // The transport sends without copying, so the buffer outlives this pass
+    bulk.data = out;
+    bulk.size = out_size;
+    net.send_compressed_deferred.push_back(out);
+  }
+#else
+  (void)net;
+  (void)node_id;
+  (void)transport;
+#endif
+}
 
-  HLOG(kDebug, "[SendOut] Task {}", origin_task->task_id_);
+bool Runtime::DecompressNetBulks(NetShard &net,
+                                 chi::LoadTaskArchive &archive) {
+  net.peer_codecs[archive.src_node_] = archive.codec_mask_;
+  if (archive.bulk_codecs_.empty()) {
+    return true;
+  }
+#if HSHM_ENABLE_COMPRESS
+  auto *ipc_manager = CHI_IPC;
+  hshm::lbm::RecvAllocator *recv_alloc = ipc_manager->GetRecvAllocator();
+  for (const chi::BulkCodec &codec : archive.bulk_codecs_) {
+    if (codec.bulk_idx_ >= archive.recv.size()) {
+      return false;
+    }
+    // Decoded bulks replace the received one, so it must be ours to free
+    hshm::lbm::Bulk &bulk = archive.recv[codec.bulk_idx_];
+    if (!bulk.flags.Any(BULK_RECV_ALLOC) || bulk.data.ptr_ == nullptr) {
+      return false;
+    }
+    auto library = hshm::CompressionFactory::GetLibraryInfo(
+        static_cast<int>(codec.library_id_));
+    hshm::Compressor *compressor = hshm::CompressionFactory::GetThreadLocal(
+        library.first, library.second);
+    if (compressor == nullptr) {
+      return false;
+    }
+    hipc::FullPtr<char> raw = recv_alloc->Allocate(codec.raw_size_);
+    if (raw.IsNull()) {
+      return false;
+    }
+    size_t raw_size = codec.raw_size_;
+    if (!compressor->Decompress(raw.ptr_, raw_size, bulk.data.ptr_,
+                                bulk.size) ||
+        raw_size != codec.raw_size_) {
+      recv_alloc->Free(raw);
+      return false;
+    }
+    recv_alloc->Free(bulk.data);
+    bulk.data = raw;
+    bulk.size = raw_size;
+  }
+  return true;
+#else
+  HLOG(kError, "[Recv] Node {} sent compressed bulks but compression is "
+       "not built in", archive.src_node_);
+  return false;
+#endif
+}
 
-  // Clear TASK_DATA_OWNER before deferred deletion so the destructor
-  // doesn't try to FreeBuffer on transport-allocated data
-  origin_task->ClearFlags(TASK_DATA_OWNER);
+bool Runtime::FlushDueNetBatches(NetShard &net) {
+  auto *config_manager = CHI_CONFIG_MANAGER;
+  float max_delay_us = static_cast<float>(config_manager->GetNetCoalesceDelay());
+  auto now = std::chrono::steady_clock::now();
+
+  // Responses complete remote work; never hold them past the pass
+  for (auto &[node_id, batch] : net.send_out_batches) {
+    FlushNetBatch(net, node_id, batch, chi::MsgType::kSerializeOut);
+  }
 
-  // Defer task deletion to next invocation for zero-copy send safety
-  deferred_deletes.push_back(origin_task);
+  bool held = false;
+  for (auto &[node_id, batch] : net.send_in_batches) {
+    if (!batch.archive) {
+      continue;
+    }
+    // Nagle: an idle link sends at once, a busy one waits for company
+    float hold_us = 0;
+    auto inflight = net.node_inflight.find(node_id);
+    if (inflight != net.node_inflight.end() && inflight->second > 0) {
+      auto srtt = net.node_srtt_us.find(node_id);
+      hold_us = srtt == net.node_srtt_us.end()
+                    ? max_delay_us
+                    : std::min(srtt->second / 4, max_delay_us);
+    }
+    float age_us =
+        std::chrono::duration<float, std::micro>(now - batch.opened_at)
+            .count();
+    if (age_us >= hold_us) {
+      FlushNetBatch(net, node_id, batch, chi::MsgType::kSerializeIn);
+    } else {
+      held = true;
+    }
+  }
+  return held;
+}
+
+void Runtime::RecordNetReply(NetShard &net, size_t recv_key) {
+  InflightSend *sent = net.inflight_sends.find(recv_key);
+  if (sent == nullptr) {
+    return;
+  }
+  chi::u64 node_id = sent->node_id;
+  float rtt_us = std::chrono::duration<float, std::micro>(
+                     std::chrono::steady_clock::now() - sent->sent_at)
+                     .count();
+  // Smoothed RTT with gain 1/8, as in TCP (RFC 6298)
+  auto srtt = net.node_srtt_us.find(node_id);
+  if (srtt == net.node_srtt_us.end()) {
+    net.node_srtt_us[node_id] = rtt_us;
+  } else {
+    srtt->second += (rtt_us - srtt->second) / 8;
+  }
+  chi::u32 &inflight = net.node_inflight[node_id];
+  if (inflight > 0) {
+    --inflight;
+  }
+  net.inflight_sends.erase(recv_key);
 }
 
 /**
@@ -661,25 +1045,50 @@ chi::TaskResume Runtime::Send(hipc::FullPtr<SendTask> task,
                               chi::RunContext &rctx) {
   CHI_TASK_BODY_BEGIN
   auto *ipc_manager = CHI_IPC;
+  NetShard &net = GetNetShard(NetShardOf(*task));
   chi::Future<chi::Task> queued_future;
   bool did_send = false;
   int send_in_count = 0;
 
+  // Delete responses sent on the previous pass (zero-copy send safety)
+  auto *pool_manager = CHI_POOL_MANAGER;
+  for (auto &sent_task : net.send_out_deferred) {
+    auto *del_container = pool_manager->GetStaticContainer(sent_task->pool_id_);
+    if (del_container) {
+      del_container->DelTask(sent_task->method_, sent_task);
+    }
+  }
+  net.send_out_deferred.clear();
+  for (auto &buf : net.send_compressed_deferred) {
+    ipc_manager->FreeBuffer(buf);
+  }
+  net.send_compressed_deferred.clear();
+
+  // Drop state for nodes another shard found restarted
+  std::vector<chi::u64> stale_nodes;
+  {
+    std::lock_guard<std::mutex> lock(net.stale_nodes_lock);
+    stale_nodes.swap(net.stale_nodes);
+  }
+  for (chi::u64 node_id : stale_nodes) {
+    FlushStaleStateForNode(net, node_id);
+  }
+
   // Process retry queues before normal sends
-  ProcessRetryQueues();
+  ProcessRetryQueues(net);
 
-  // Scan send_map_ for timed-out entries from dead nodes
-  ScanSendMapTimeouts();
+  // Scan send_map for timed-out entries from dead nodes
+  ScanSendMapTimeouts(net);
 
   // Poll priority 0 (SendIn) queue - tasks waiting to be sent to remote nodes
   while (ipc_manager->TryPopNetTask(chi::NetQueuePriority::kSendIn,
-                                    queued_future)) {
+                                    queued_future, net.id)) {
     // Get the original task from the Future
     auto origin_task = queued_future.GetTaskPtr();
     if (!origin_task.IsNull()) {
       HLOG(kDebug, "[Send] Processing SendIn task method={}, pool_id={}",
            origin_task->method_, origin_task->pool_id_);
-      SendIn(origin_task, rctx);
+      SendIn(net, origin_task, rctx);
       did_send = true;
       send_in_count++;
     }
@@ -692,13 +1101,13 @@ chi::TaskResume Runtime::Send(hipc::FullPtr<SendTask> task,
   // Poll priority 1 (SendOut) queue - tasks with outputs to send back
   int send_out_count = 0;
   while (ipc_manager->TryPopNetTask(chi::NetQueuePriority::kSendOut,
-                                    queued_future)) {
+                                    queued_future, net.id)) {
     // Get the original task from the Future
     auto origin_task = queued_future.GetTaskPtr();
     if (!origin_task.IsNull()) {
       HLOG(kDebug, "[Send] Processing SendOut task method={}, pool_id={}",
            origin_task->method_, origin_task->pool_id_);
-      SendOut(origin_task);
+      SendOut(net, origin_task);
       did_send = true;
       send_out_count++;
     }
@@ -708,8 +1117,11 @@ chi::TaskResume Runtime::Send(hipc::FullPtr<SendTask> task,
     HLOG(kDebug, "[Send] Processed {} SendOut tasks", send_out_count);
   }
 
+  // Send the coalesced batches that are due; keep polling while any are held
+  bool held = FlushDueNetBatches(net);
+
   // Track whether this execution did actual work
-  rctx.did_work_ = did_send;
+  rctx.did_work_ = did_send || held;
 
   task->SetReturnCode(0);
   CHI_CO_RETURN;
@@ -718,11 +1130,12 @@ chi::TaskResume Runtime::Send(hipc::FullPtr<SendTask> task,
 
 /**
  * Helper function: Receive task inputs from remote node
+ * @param net Network shard the message arrived on
  * @param task RecvTask containing control information
  * @param archive Already-parsed LoadTaskArchive containing task info
  * @param lbm_transport Lightbeam server for receiving bulk data
  */
-void Runtime::RecvIn(hipc::FullPtr<RecvTask> task,
+void Runtime::RecvIn(NetShard &net, hipc::FullPtr<RecvTask> task,
                      chi::LoadTaskArchive &archive,
                      hshm::lbm::Transport *lbm_transport) {
   auto *ipc_manager = CHI_IPC;
@@ -769,7 +1182,15 @@ void Runtime::RecvIn(hipc::FullPtr<RecvTask> task,
            sender_node);
       // Flush stale retry entries BEFORE marking alive so
       // ProcessRetryQueues doesn't resend old tasks to the fresh runtime.
-      FlushStaleStateForNode(sender_node);
+      // Other shards flush theirs at the start of their next Send pass.
+      for (auto &other : net_shards_) {
+        if (other.get() == &net) {
+          FlushStaleStateForNode(net, sender_node);
+        } else {
+          std::lock_guard<std::mutex> lock(other->stale_nodes_lock);
+          other->stale_nodes.push_back(sender_node);
+        }
+      }
       ipc_manager->SetAlive(sender_node);
     }
 
@@ -783,11 +1204,9 @@ void Runtime::RecvIn(hipc::FullPtr<RecvTask> task,
     // Add task to recv_map for later lookup
     // Key combines net_key and replica_id so multiple replicas targeting the
     // same node (e.g., after container migration) get distinct entries.
-    // Note: No lock needed - single net worker processes all Send/Recv tasks
-    size_t recv_key = task_ptr->task_id_.net_key_ ^
-                      (static_cast<size_t>(task_ptr->task_id_.replica_id_) *
-                       0x9e3779b97f4a7c15ULL);
-    recv_map_[recv_key] = task_ptr;
+    // Note: No lock needed - only this shard's net worker touches its state
+    size_t recv_key = NetRecvKey(task_ptr->task_id_);
+    net.recv_map[recv_key] = task_ptr;
 
     HLOG(kDebug, "[RecvIn] Task {} method={} pool_id={} dispatching to workers",
          task_ptr->task_id_, task_ptr->method_, task_ptr->pool_id_);
@@ -802,13 +1221,84 @@ void Runtime::RecvIn(hipc::FullPtr<RecvTask> task,
   task->SetReturnCode(0);
 }
 
+bool Runtime::FinishNetReply(NetShard &net, const NetReply &reply) {
+  hipc::FullPtr<chi::Task> origin_task = reply.origin;
+  chi::RunContext *origin_rctx = origin_task->GetRunCtx();
+  chi::Container *container = reply.container;
+
+  // Aggregate replica results into origin task via container dispatch
+  container->Aggregate(origin_task->method_, origin_task, reply.replica);
+
+  HLOG(kDebug, "[NetReply] Task {}", origin_task->task_id_);
+
+  // Increment completed replicas counter in origin's rctx
+  origin_rctx->completed_replicas_++;
+  chi::u32 completed = origin_rctx->completed_replicas_;
+  if (completed != origin_rctx->subtasks_.size()) {
+    return false;
+  }
+
+  // All replicas completed. Unmark TASK_DATA_OWNER before deleting replicas
+  // to avoid freeing the same data pointers twice. Delete all origin_task
+  // replicas using container->DelTask() to avoid memory leak
+  for (const auto &origin_task_ptr : origin_rctx->subtasks_) {
+    origin_task_ptr->ClearFlags(TASK_DATA_OWNER);
+    container->DelTask(origin_task->method_, origin_task_ptr);
+  }
+
+  // Clear subtasks vector after deleting tasks
+  origin_rctx->subtasks_.clear();
+
+  // Remove origin from send_map
+  // Note: No lock needed - only this shard's net worker touches its state
+  net.send_map.erase(reply.net_key);
+
+  // Set container in origin RunContext (may be null if task was routed
+  // globally without passing through RouteLocal, e.g. TASK_FORCE_NET)
+  origin_rctx->container_ = container;
+
+  // Complete the origin task via EndTask
+  auto *worker = CHI_CUR_WORKER;
+  worker->EndTask(origin_task, origin_rctx, true);
+  return true;
+}
+
+bool Runtime::FindLocalReply(NetShard &net, hipc::FullPtr<chi::Task> task,
+                             NetReply &reply) {
+  size_t net_key = task->task_id_.net_key_;
+  auto send_it = net.send_map.find(net_key);
+  if (send_it == nullptr) {
+    return false;
+  }
+  hipc::FullPtr<chi::Task> origin_task = *send_it;
+  chi::RunContext *origin_rctx = origin_task->GetRunCtx();
+  if (!origin_rctx) {
+    return false;
+  }
+  chi::u32 replica_id = task->task_id_.replica_id_;
+  if (replica_id >= origin_rctx->subtasks_.size() ||
+      origin_rctx->subtasks_[replica_id].ptr_ != task.ptr_) {
+    // A loopback message decoded into a new task, not the replica itself
+    return false;
+  }
+  auto *pool_manager = CHI_POOL_MANAGER;
+  chi::Container *container =
+      pool_manager->GetStaticContainer(origin_task->pool_id_);
+  if (!container) {
+    return false;
+  }
+  reply = {net_key, origin_task, task, container};
+  return true;
+}
+
 /**
  * Helper function: Receive task outputs from remote node
+ * @param net Network shard the message arrived on
  * @param task RecvTask containing control information
  * @param archive Already-parsed LoadTaskArchive containing task info
  * @param lbm_transport Lightbeam server for receiving bulk data
  */
-void Runtime::RecvOut(hipc::FullPtr<RecvTask> task,
+void Runtime::RecvOut(NetShard &net, hipc::FullPtr<RecvTask> task,
                       chi::LoadTaskArchive &archive,
                       hshm::lbm::Transport *lbm_transport) {
   auto *pool_manager = CHI_POOL_MANAGER;
@@ -824,22 +1314,27 @@ void Runtime::RecvOut(hipc::FullPtr<RecvTask> task,
   // Set lbm_transport in archive for bulk transfer exposure in output mode
   archive.SetTransport(lbm_transport);
 
-  // First pass: Deserialize to expose buffers
-  // LoadTask will call ar.bulk() which will expose the pointers and populate
-  // archive.recv
+  // First pass: correlate each reply with its request and deserialize to
+  // expose buffers. LoadTask will call ar.bulk() which will expose the
+  // pointers and populate archive.recv. The resolved replies are kept so the
+  // second pass does not look them up again.
+  std::vector<NetReply> &replies = net.recv_replies;
+  replies.clear();
+  replies.reserve(task_infos.size());
   for (size_t task_idx = 0; task_idx < task_infos.size(); ++task_idx) {
     const auto &task_info = task_infos[task_idx];
 
     // Locate origin task from send_map using net_key
     size_t net_key = task_info.task_id_.net_key_;
+    RecordNetReply(net, NetRecvKey(task_info.task_id_));
 
-    // Note: No lock needed - single net worker processes all Send/Recv tasks
-    auto send_it = send_map_.find(net_key);
+    // Note: No lock needed - only this shard's net worker touches its state
+    auto send_it = net.send_map.find(net_key);
     if (send_it == nullptr) {
       HLOG(kError,
            "[RecvOut] Task {} FAILED: Origin task not found in send_map "
            "(size: {}) with net_key {}",
-           task_info.task_id_, send_map_.size(), net_key);
+           task_info.task_id_, net.send_map.size(), net_key);
       task->SetReturnCode(5);
       return;
     }
@@ -875,89 +1370,27 @@ void Runtime::RecvOut(hipc::FullPtr<RecvTask> task,
     // Deserialize outputs directly into the replica task using LoadTask
     // This exposes buffers via ar.bulk() and populates archive.recv
     container->LoadTask(origin_task->method_, archive, replica);
+    replies.push_back({net_key, origin_task, replica, container});
   }
 
-  // Second pass: Aggregate results
-  for (size_t task_idx = 0; task_idx < task_infos.size(); ++task_idx) {
-    const auto &task_info = task_infos[task_idx];
-
-    // Locate origin task from send_map using net_key
-    // Note: No lock needed - single net worker processes all Send/Recv tasks
-    size_t net_key = task_info.task_id_.net_key_;
-    auto send_it = send_map_.find(net_key);
-    if (send_it == nullptr) {
-      HLOG(kError, "Admin: Origin task not found in send_map with net_key {}",
-           net_key);
-      continue;
-    }
-    hipc::FullPtr<chi::Task> origin_task = *send_it;
-    if (!origin_task->GetRunCtx()) {
-      HLOG(kError, "Admin: origin_task has no RunContext");
-      continue;
-    }
-    chi::RunContext *origin_rctx = origin_task->GetRunCtx();
-
-    // Locate replica in origin's run_ctx using replica_id
-    chi::u32 replica_id = task_info.task_id_.replica_id_;
-    if (replica_id >= origin_rctx->subtasks_.size()) {
-      HLOG(kError, "Admin: Invalid replica_id {} (subtasks size: {})",
-           replica_id, origin_rctx->subtasks_.size());
+  // Second pass: Aggregate results and complete finished requests here, on
+  // the net worker, without another trip through a worker lane
+  for (size_t reply_idx = 0; reply_idx < replies.size(); ++reply_idx) {
+    NetReply &reply = replies[reply_idx];
+    if (reply.origin.IsNull()) {
+      // Origin already completed by an earlier reply in this batch
       continue;
     }
-
-    hipc::FullPtr<chi::Task> replica = origin_rctx->subtasks_[replica_id];
-
-    // Get the container associated with the origin task
-    chi::Container *container =
-        pool_manager->GetStaticContainer(origin_task->pool_id_);
-    if (!container) {
-      HLOG(kError, "Admin: Container not found for pool_id {}",
-           origin_task->pool_id_);
-      continue;
-    }
-
-    // Aggregate replica results into origin task via container dispatch
-    container->Aggregate(origin_task->method_, origin_task, replica);
-
-    HLOG(kDebug, "[RecvOut] Task {}", origin_task->task_id_);
-
-    // Increment completed replicas counter in origin's rctx
-    origin_rctx->completed_replicas_++;
-    chi::u32 completed = origin_rctx->completed_replicas_;
-
-    // If all replicas completed
-    if (completed == origin_rctx->subtasks_.size()) {
-      // Get pool manager to access container
-      auto *pool_manager = CHI_POOL_MANAGER;
-      chi::Container *container =
-          pool_manager->GetStaticContainer(origin_task->pool_id_);
-
-      // Unmark TASK_DATA_OWNER before deleting replicas to avoid freeing the
-      // same data pointers twice. Delete all origin_task replicas using
-      // container->DelTask() to avoid memory leak
-      for (const auto &origin_task_ptr : origin_rctx->subtasks_) {
-        origin_task_ptr->ClearFlags(TASK_DATA_OWNER);
-        container->DelTask(origin_task->method_, origin_task_ptr);
-      }
-
-      // Clear subtasks vector after deleting tasks
-      origin_rctx->subtasks_.clear();
-
-      // Remove origin from send_map
-      // Note: No lock needed - single net worker processes all Send/Recv tasks
-      send_map_.erase(net_key);
-
-      // Set container in origin RunContext (may be null if task was routed
-      // globally without passing through RouteLocal, e.g. TASK_FORCE_NET)
-      if (container) {
-        origin_rctx->container_ = container;
+    if (FinishNetReply(net, reply)) {
+      // Later duplicates of this request in the batch must not touch it
+      for (size_t j = reply_idx + 1; j < replies.size(); ++j) {
+        if (replies[j].net_key == reply.net_key) {
+          replies[j].origin.SetNull();
+        }
       }
-
-      // Complete the origin task via EndTask
-      auto *worker = CHI_CUR_WORKER;
-      worker->EndTask(origin_task, origin_rctx, true);
     }
   }
+  replies.clear();
 
   task->SetReturnCode(0);
 }
@@ -972,16 +1405,19 @@ chi::TaskResume Runtime::Recv(hipc::FullPtr<RecvTask> task,
   // Get the main server from CHI_IPC (already bound during initialization)
   auto *ipc_manager = CHI_IPC;
 
-  hshm::lbm::Transport *lbm_transport = ipc_manager->GetMainTransport();
+  NetShard &net = GetNetShard(NetShardOf(*task));
+  hshm::lbm::Transport *lbm_transport = ipc_manager->GetMainTransport(net.id);
   if (lbm_transport == nullptr) {
     CHI_CO_RETURN;
   }
 
-  // Note: No socket lock needed - single net worker processes all Recv tasks
+  // Note: No socket lock needed - one net worker polls each shard's server
 
-  // Receive metadata + bulks (non-blocking)
+  // Receive metadata + bulks (non-blocking); bulks land in shared memory
   chi::LoadTaskArchive archive;
-  auto info = lbm_transport->Recv(archive);
+  hshm::lbm::LbmContext ctx;
+  ctx.recv_alloc_ = ipc_manager->GetRecvAllocator();
+  auto info = lbm_transport->Recv(archive, ctx);
   int rc = info.rc;
   if (rc == EAGAIN) {
     // No message available - this is normal for polling, mark as no work done
@@ -1006,15 +1442,32 @@ chi::TaskResume Runtime::Recv(hipc::FullPtr<RecvTask> task,
   HLOG(kDebug, "[Recv] Received message with msg_type={}",
        static_cast<int>(msg_type));
 
+  // Undo the sender's wire compression before any task reads its bulks
+  if (msg_type != chi::MsgType::kHeartbeat &&
+      !DecompressNetBulks(net, archive)) {
+    HLOG(kError, "[Recv] Dropping message from node {}: a compressed bulk "
+         "failed to decode", archive.src_node_);
+    auto *recv_alloc = ipc_manager->GetRecvAllocator();
+    for (auto &bulk : archive.recv) {
+      if (bulk.flags.Any(BULK_RECV_ALLOC)) {
+        recv_alloc->Free(bulk.data);
+        bulk.flags.UnsetBits(BULK_RECV_ALLOC);
+      }
+    }
+    lbm_transport->ClearRecvHandles(archive);
+    task->SetReturnCode(4);
+    CHI_CO_RETURN;
+  }
+
   // Dispatch based on message type
   switch (msg_type) {
     case chi::MsgType::kSerializeIn:
       HLOG(kDebug, "[Recv] Dispatching to RecvIn");
-      RecvIn(task, archive, lbm_transport);
+      RecvIn(net, task, archive, lbm_transport);
       break;
     case chi::MsgType::kSerializeOut:
       HLOG(kDebug, "[Recv] Dispatching to RecvOut");
-      RecvOut(task, archive, lbm_transport);
+      RecvOut(net, task, archive, lbm_transport);
       break;
     case chi::MsgType::kHeartbeat:
       task->SetReturnCode(0);
@@ -1042,6 +1495,8 @@ chi::TaskResume Runtime::ClientConnect(hipc::FullPtr<ClientConnectTask> task,
   task->server_generation_ = CHI_IPC->GetServerGeneration();
   task->server_pid_ = static_cast<int32_t>(getpid());
   task->worker_queues_off_ = CHI_IPC->GetWorkerQueuesOffset();
+  task->client_credits_off_ = CHI_IPC->GetClientCreditsOffset();
+  task->lane_stats_off_ = CHI_IPC->GetLaneStatsOffset();
 
   // Populate GPU queue info for client attachment
 #if HSHM_ENABLE_CUDA || HSHM_ENABLE_ROCM
@@ -1116,10 +1571,20 @@ chi::TaskResume Runtime::Monitor(hipc::FullPtr<MonitorTask> task,
     CHI_CO_AWAIT(MonitorPoolStats(task));
   } else if (task->query_.rfind("system_stats", 0) == 0) {
     MonitorSystemStats(task);
+  } else if (task->query_.rfind("worker_samples", 0) == 0) {
+    MonitorWorkerSamples(task);
   } else if (task->query_ == "bdev_stats") {
     CHI_CO_AWAIT(MonitorBdevStats(task));
+  } else if (task->query_.rfind("subscribe:", 0) == 0) {
+    CHI_CO_AWAIT(MonitorSubscribe(task));
   } else if (task->query_ == "container_stats") {
     MonitorContainerStats(task);
+  } else if (task->query_ == "task_latency") {
+    MonitorTaskLatency(task);
+  } else if (task->query_ == "coro_frames") {
+    MonitorCoroFrames(task);
+  } else if (task->query_.rfind("trace_", 0) == 0) {
+    MonitorTrace(task);
   } else if (task->query_ == "get_host_info") {
     MonitorGetHostInfo(task);
   } else {
@@ -1153,7 +1618,7 @@ void Runtime::MonitorWorkerStats(hipc::FullPtr<MonitorTask> task) {
       continue;
     }
     chi::WorkerStats stats = worker->GetWorkerStats();
-    pk.pack_map(11);
+    pk.pack_map(14);
     pk.pack("worker_id");
     pk.pack(stats.worker_id_);
     pk.pack("is_running");
@@ -1176,11 +1641,162 @@ void Runtime::MonitorWorkerStats(hipc::FullPtr<MonitorTask> task) {
     pk.pack(stats.num_tasks_processed_);
     pk.pack("load");
     pk.pack(stats.load_);
+    pk.pack("lane_remaps_in");
+    pk.pack(stats.lane_remaps_in_);
+    pk.pack("lane_remaps_out");
+    pk.pack(stats.lane_remaps_out_);
+    pk.pack("poll");
+    pk.pack_map(8);
+    pk.pack("idle_cpu_us");
+    pk.pack(stats.poll_.idle_cpu_us_);
+    pk.pack("sleep_us");
+    pk.pack(stats.poll_.sleep_us_);
+    pk.pack("busy_wakeups");
+    pk.pack(stats.poll_.busy_wakeups_);
+    pk.pack("spin_wakeups");
+    pk.pack(stats.poll_.spin_wakeups_);
+    pk.pack("sleep_wakeups");
+    pk.pack(stats.poll_.sleep_wakeups_);
+    pk.pack("wake_latency_p99_us");
+    pk.pack(stats.poll_.wake_latency_p99_us_);
+    pk.pack("arrival_gap_us");
+    pk.pack(stats.poll_.arrival_gap_us_);
+    pk.pack("poll_window_us");
+    pk.pack(stats.poll_.poll_window_us_);
+  }
+
+  task->results_[container_id_] = std::string(sbuf.data(), sbuf.size());
+}
+
+void Runtime::MonitorTaskLatency(hipc::FullPtr<MonitorTask> task) {
+  auto *work_orchestrator = CHI_WORK_ORCHESTRATOR;
+  if (!work_orchestrator) {
+    task->SetReturnCode(1);
+    HLOG(kError, "Monitor(task_latency): WorkOrchestrator not available");
+    return;
+  }
+
+  // Merge every worker's histograms per (pool, method)
+  std::vector<chi::TaskLatencyEntry> entries;
+  size_t num_workers = work_orchestrator->GetWorkerCount();
+  for (size_t i = 0; i < num_workers; ++i) {
+    chi::Worker *worker =
+        work_orchestrator->GetWorker(static_cast<chi::u32>(i));
+    if (worker) {
+      worker->GetTaskLatencyStats().Snapshot(entries);
+    }
+  }
+
+  msgpack::sbuffer sbuf;
+  msgpack::packer<msgpack::sbuffer> pk(sbuf);
+  pk.pack_array(entries.size());
+  for (const auto &entry : entries) {
+    chi::u32 num_stages = 0;
+    for (const auto &hist : entry.stages_) {
+      num_stages += hist.Count() ? 1 : 0;
+    }
+    pk.pack_map(3);
+    pk.pack("pool_id");
+    pk.pack(entry.pool_id_.ToString());
+    pk.pack("method");
+    pk.pack(entry.method_);
+    pk.pack("stages");
+    pk.pack_map(num_stages);
+    for (chi::u32 s = 0; s < chi::kNumTaskStages; ++s) {
+      const chi::LatencyHistogram &hist = entry.stages_[s];
+      if (!hist.Count()) continue;
+      pk.pack(chi::TaskStageName(static_cast<chi::TaskStage>(s)));
+      pk.pack_map(7);
+      pk.pack("count");
+      pk.pack(hist.Count());
+      pk.pack("mean_ns");
+      pk.pack(hist.Mean());
+      pk.pack("p50_ns");
+      pk.pack(hist.Percentile(0.50));
+      pk.pack("p90_ns");
+      pk.pack(hist.Percentile(0.90));
+      pk.pack("p99_ns");
+      pk.pack(hist.Percentile(0.99));
+      pk.pack("p999_ns");
+      pk.pack(hist.Percentile(0.999));
+      pk.pack("max_ns");
+      pk.pack(hist.Max());
+    }
   }
 
   task->results_[container_id_] = std::string(sbuf.data(), sbuf.size());
 }
 
+void Runtime::MonitorCoroFrames(hipc::FullPtr<MonitorTask> task) {
+  chi::CoroFrameStats stats = chi::CoroFramePool::CollectStats();
+
+  msgpack::sbuffer sbuf;
+  msgpack::packer<msgpack::sbuffer> pk(sbuf);
+  pk.pack_map(6);
+  pk.pack("allocs");
+  pk.pack(stats.Allocs());
+  pk.pack("pool_hits");
+  pk.pack(stats.pool_hits_);
+  pk.pack("frees");
+  pk.pack(stats.frees_);
+  pk.pack("cached_frames");
+  pk.pack(stats.cached_frames_);
+  pk.pack("max_frame_size");
+  pk.pack(stats.max_frame_size_);
+  // Frames per size class, keyed by the class size; "large" is unpooled
+  pk.pack("size_classes");
+  pk.pack_map(chi::CoroFrameStats::kNumBins);
+  for (chi::u32 cls = 0; cls < chi::CoroFramePool::kNumClasses; ++cls) {
+    pk.pack(std::to_string(chi::CoroFramePool::ClassSize(cls)));
+    pk.pack(stats.allocs_[cls]);
+  }
+  pk.pack("large");
+  pk.pack(stats.allocs_[chi::CoroFramePool::kNumClasses]);
+
+  task->results_[container_id_] = std::string(sbuf.data(), sbuf.size());
+}
+
+void Runtime::MonitorTrace(hipc::FullPtr<MonitorTask> task) {
+  const std::string &query = task->query_;
+  if (query.rfind("trace_start", 0) == 0) {
+    // "trace_start" or "trace_start:<events per thread>"
+    chi::u32 events_per_thread = 0;
+    size_t colon = query.find(':');
+    if (colon != std::string::npos) {
+      events_per_thread = static_cast<chi::u32>(
+          std::strtoul(query.c_str() + colon + 1, nullptr, 10));
+    }
+    chi::TaskTracer::Start(events_per_thread);
+    HLOG(kInfo, "Monitor(trace_start): capturing task timeline");
+  } else if (query == "trace_stop") {
+    chi::TaskTracer::Stop();
+    HLOG(kInfo, "Monitor(trace_stop): {} events overwritten",
+         chi::TaskTracer::GetDroppedCount());
+  } else if (query == "trace_dump") {
+    // Name task events after the ChiMod methods where the pool is known
+    auto *pool_manager = CHI_POOL_MANAGER;
+    auto name_fn = [pool_manager](const chi::PoolId &pool_id,
+                                  chi::u32 method) -> std::string {
+      chi::Container *container = pool_manager->GetStaticContainer(pool_id);
+      if (!container) return std::string();
+      const auto &names = container->GetMethodNames();
+      if (method >= names.size() || names[method].empty()) {
+        return std::string();
+      }
+      return container->pool_name_ + "::" + names[method];
+    };
+    auto *ipc_manager = CHI_IPC;
+    task->results_[container_id_] = chi::TaskTracer::DumpJson(
+        ipc_manager->GetNodeId(), ipc_manager->GetCurrentHostname(), name_fn);
+    return;
+  } else {
+    task->SetReturnCode(1);
+    HLOG(kError, "Monitor: unknown trace query '{}'", query);
+    return;
+  }
+  task->results_[container_id_] = std::string();
+}
+
 void Runtime::MonitorContainerStats(hipc::FullPtr<MonitorTask> task) {
   auto *pool_manager = CHI_POOL_MANAGER;
   if (!pool_manager) {
@@ -1221,12 +1837,13 @@ void Runtime::MonitorContainerStats(hipc::FullPtr<MonitorTask> task) {
       const auto &mape = container->GetMethodMapeVec();
       const auto &model_wall = container->GetMethodModelWall();
       const auto &mape_wall = container->GetMethodMapeWallVec();
+      const auto &cost = container->GetMethodCostVec();
       const auto &names = container->GetMethodNames();
 
       pk.pack("methods");
       pk.pack_array(model.size());
       for (size_t i = 0; i < model.size(); ++i) {
-        pk.pack_map(6);
+        pk.pack_map(7);
         pk.pack("id");
         pk.pack(static_cast<uint32_t>(i));
         pk.pack("name");
@@ -1239,6 +1856,8 @@ void Runtime::MonitorContainerStats(hipc::FullPtr<MonitorTask> task) {
         pk.pack(i < model_wall.size() ? model_wall[i] : 0.0f);
         pk.pack("wall_mape");
         pk.pack(i < mape_wall.size() ? mape_wall[i] : 0.0f);
+        pk.pack("avg_cost_us");
+        pk.pack(i < cost.size() ? cost[i] : 0.0f);
       }
 
       pk.pack("learning_rate");
@@ -1449,6 +2068,117 @@ void Runtime::MonitorSystemStats(hipc::FullPtr<MonitorTask> task) {
   task->SetReturnCode(0);
 }
 
+void Runtime::MonitorWorkerSamples(hipc::FullPtr<MonitorTask> task) {
+  // worker_samples or worker_samples:<min_event_id>
+  uint64_t min_event_id = 0;
+  if (task->query_.size() > 15 && task->query_[14] == ':') {
+    try {
+      min_event_id = std::stoull(task->query_.substr(15));
+    } catch (...) {
+      // ignore parse errors, default to 0
+    }
+  }
+
+  if (!worker_sample_ring_) {
+    task->SetReturnCode(1);
+    return;
+  }
+
+  chi::u64 head = worker_sample_ring_->GetHead();
+  chi::u64 tail = worker_sample_ring_->GetTail();
+  chi::u64 start = (min_event_id > head) ? min_event_id : head;
+
+  msgpack::sbuffer sbuf;
+  msgpack::packer<msgpack::sbuffer> pk(sbuf);
+  uint64_t count = (tail > start) ? (tail - start) : 0;
+  pk.pack_array(static_cast<uint32_t>(count));
+
+  for (chi::u64 idx = start; idx < tail; ++idx) {
+    WorkerSample s;
+    if (!worker_sample_ring_->Peek(idx, s)) {
+      pk.pack_map(0);
+      continue;
+    }
+    pk.pack_map(14);
+    pk.pack("event_id");
+    pk.pack(idx);
+    pk.pack("timestamp_ns");
+    pk.pack(s.timestamp_ns_);
+    pk.pack("worker_id");
+    pk.pack(s.worker_id_);
+    pk.pack("busy_us");
+    pk.pack(s.busy_us_);
+    pk.pack("idle_cpu_us");
+    pk.pack(s.idle_cpu_us_);
+    pk.pack("sleep_us");
+    pk.pack(s.sleep_us_);
+    pk.pack("tasks_processed");
+    pk.pack(s.tasks_processed_);
+    pk.pack("resumes");
+    pk.pack(s.resumes_);
+    pk.pack("lane_depth");
+    pk.pack(s.lane_depth_);
+    pk.pack("blocked_tasks");
+    pk.pack(s.blocked_tasks_);
+    pk.pack("periodic_tasks");
+    pk.pack(s.periodic_tasks_);
+    pk.pack("retry_tasks");
+    pk.pack(s.retry_tasks_);
+    pk.pack("load_us");
+    pk.pack(s.load_us_);
+    // Only methods that ran; the last slot also counts larger method IDs
+    chi::u32 num_methods = 0;
+    for (chi::u32 m = 0; m < WorkerSample::kNumMethodSlots; ++m) {
+      num_methods += s.method_tasks_[m] ? 1 : 0;
+    }
+    pk.pack("method_tasks");
+    pk.pack_map(num_methods);
+    for (chi::u32 m = 0; m < WorkerSample::kNumMethodSlots; ++m) {
+      if (!s.method_tasks_[m]) continue;
+      pk.pack(m);
+      pk.pack(s.method_tasks_[m]);
+    }
+  }
+
+  task->results_[container_id_] = std::string(sbuf.data(), sbuf.size());
+  task->SetReturnCode(0);
+}
+
+void Runtime::SampleWorkers(uint64_t timestamp_ns) {
+  auto *work_orchestrator = CHI_WORK_ORCHESTRATOR;
+  if (!worker_sample_ring_ || !work_orchestrator) {
+    return;
+  }
+  chi::u64 now_us = timestamp_ns / 1000;
+  size_t num_workers = work_orchestrator->GetWorkerCount();
+  for (size_t i = 0; i < num_workers; ++i) {
+    chi::Worker *worker =
+        work_orchestrator->GetWorker(static_cast<chi::u32>(i));
+    if (!worker) continue;
+    // Only the published atomics are read; the worker's queues are private
+    const chi::WorkerCounters &c = worker->GetCounters();
+    chi::TaskLane *lane = worker->GetLane();
+    WorkerSample sample;
+    sample.timestamp_ns_ = timestamp_ns;
+    sample.worker_id_ = static_cast<uint32_t>(i);
+    sample.busy_us_ = c.BusyUs(now_us);
+    sample.idle_cpu_us_ = c.idle_cpu_us_.load(std::memory_order_relaxed);
+    sample.sleep_us_ = c.sleep_us_.load(std::memory_order_relaxed);
+    sample.tasks_processed_ = c.tasks_processed_.load(std::memory_order_relaxed);
+    sample.resumes_ = c.resumes_.load(std::memory_order_relaxed);
+    sample.lane_depth_ = lane ? static_cast<uint32_t>(lane->Size()) : 0;
+    sample.blocked_tasks_ = c.blocked_tasks_.load(std::memory_order_relaxed);
+    sample.periodic_tasks_ = c.periodic_tasks_.load(std::memory_order_relaxed);
+    sample.retry_tasks_ = c.retry_tasks_.load(std::memory_order_relaxed);
+    sample.load_us_ = c.load_.load(std::memory_order_relaxed);
+    for (chi::u32 m = 0; m < WorkerSample::kNumMethodSlots; ++m) {
+      sample.method_tasks_[m] =
+          c.method_tasks_[m].load(std::memory_order_relaxed);
+    }
+    worker_sample_ring_->Push(sample);
+  }
+}
+
 void Runtime::MonitorGetHostInfo(hipc::FullPtr<MonitorTask> task) {
   msgpack::sbuffer sbuf;
   msgpack::packer<msgpack::sbuffer> pk(sbuf);
@@ -1544,6 +2274,262 @@ chi::TaskResume Runtime::MonitorBdevStats(hipc::FullPtr<MonitorTask> task) {
   CHI_TASK_BODY_END
 }
 
+chi::TaskResume Runtime::MonitorSubscribe(hipc::FullPtr<MonitorTask> task) {
+#ifdef __NVCOMPILER
+  chi::RunContext _dummy_rctx;
+  chi::RunContext& rctx = _dummy_rctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  // subscribe:<id>[:<round>[:<wait_ms>]]. The caller numbers its calls;
+  // the reply is a delta against the reply for round base_round, which
+  // the caller must have applied. Round 0 asks for the full snapshot.
+  std::vector<std::string> parts;
+  const std::string &query = task->query_;
+  for (size_t pos = 0; pos <= query.size();) {
+    size_t end = query.find(':', pos);
+    if (end == std::string::npos) end = query.size();
+    parts.push_back(query.substr(pos, end - pos));
+    pos = end + 1;
+  }
+  std::string id = parts.size() > 1 ? parts[1] : "";
+  chi::u64 round = 0;
+  chi::u32 wait_ms = 1000;
+  try {
+    if (parts.size() > 2) round = std::stoull(parts[2]);
+    if (parts.size() > 3) {
+      wait_ms = std::min<chi::u32>(
+          static_cast<chi::u32>(std::stoul(parts[3])), kStatSubscribeMaxWaitMs);
+    }
+  } catch (...) {
+    // ignore parse errors, keep the defaults
+  }
+  if (id.empty()) {
+    task->SetReturnCode(1);
+    CHI_CO_RETURN;
+  }
+
+  auto now_ns = []() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+  };
+  uint64_t start_ns = now_ns();
+  chi::u64 seen_seq = 0;
+  {
+    std::lock_guard<std::mutex> lock(stat_lock_);
+    StatSubscriber &sub = stat_subscribers_[id];
+    sub.last_call_ns_ = start_ns;
+    if (round == 0) {
+      sub.sent_.clear();
+      sub.seq_ = 0;
+    }
+    seen_seq = sub.seq_;
+  }
+  // Wait for a snapshot this subscriber has not been sent
+  while (round != 0) {
+    {
+      std::lock_guard<std::mutex> lock(stat_lock_);
+      if (stat_seq_ != 0 && stat_seq_ != seen_seq) break;
+    }
+    if (now_ns() - start_ns >= static_cast<uint64_t>(wait_ms) * 1000000ULL) {
+      break;
+    }
+    CHI_CO_AWAIT(chi::yield(kStatSubscribePollUs));
+  }
+
+  std::vector<std::pair<std::string, double>> changed;
+  std::vector<std::string> removed;
+  chi::u64 base_round = 0;
+  chi::u64 seq = 0;
+  uint64_t timestamp_ns = 0;
+  bool full = false;
+  {
+    std::lock_guard<std::mutex> lock(stat_lock_);
+    StatSubscriber &sub = stat_subscribers_[id];
+    sub.last_call_ns_ = now_ns();
+    full = sub.seq_ == 0;
+    base_round = full ? 0 : sub.round_;
+    if (stat_seq_ != sub.seq_) {
+      for (const auto &kv : stat_snapshot_) {
+        auto it = sub.sent_.find(kv.first);
+        if (it == sub.sent_.end() || it->second != kv.second) {
+          changed.emplace_back(kv.first, kv.second);
+        }
+      }
+      for (const auto &kv : sub.sent_) {
+        if (stat_snapshot_.find(kv.first) == stat_snapshot_.end()) {
+          removed.push_back(kv.first);
+        }
+      }
+      sub.sent_ = stat_snapshot_;
+      sub.seq_ = stat_seq_;
+    }
+    sub.round_ = round;
+    seq = sub.seq_;
+    timestamp_ns = stat_timestamp_ns_;
+  }
+
+  msgpack::sbuffer sbuf;
+  msgpack::packer<msgpack::sbuffer> pk(sbuf);
+  pk.pack_map(9);
+  pk.pack("round");
+  pk.pack(round);
+  pk.pack("base_round");
+  pk.pack(base_round);
+  pk.pack("full");
+  pk.pack(full);
+  pk.pack("seq");
+  pk.pack(seq);
+  pk.pack("timestamp_ns");
+  pk.pack(timestamp_ns);
+  pk.pack("node_id");
+  pk.pack(CHI_IPC->GetNodeId());
+  pk.pack("hostname");
+  pk.pack(CHI_IPC->GetCurrentHostname());
+  pk.pack("set");
+  pk.pack_map(changed.size());
+  for (const auto &kv : changed) {
+    pk.pack(kv.first);
+    pk.pack(kv.second);
+  }
+  pk.pack("removed");
+  pk.pack_array(removed.size());
+  for (const auto &key : removed) {
+    pk.pack(key);
+  }
+  task->results_[container_id_] = std::string(sbuf.data(), sbuf.size());
+  task->SetReturnCode(0);
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+chi::TaskResume Runtime::SnapshotStats(SystemStats stats) {
+#ifdef __NVCOMPILER
+  chi::RunContext _dummy_rctx;
+  chi::RunContext& rctx = _dummy_rctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  {
+    std::lock_guard<std::mutex> lock(stat_lock_);
+    for (auto it = stat_subscribers_.begin(); it != stat_subscribers_.end();) {
+      if (stats.timestamp_ns_ - it->second.last_call_ns_ >
+          kStatSubscriberIdleNs) {
+        it = stat_subscribers_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (stat_subscribers_.empty()) {
+      stat_snapshot_.clear();
+      CHI_CO_RETURN;
+    }
+  }
+
+  std::unordered_map<std::string, double> snapshot;
+  snapshot["system.cpu_usage_pct"] = stats.cpu_usage_pct_;
+  snapshot["system.ram_usage_pct"] = stats.ram_usage_pct_;
+  snapshot["system.ram_available_bytes"] =
+      static_cast<double>(stats.ram_available_bytes_);
+
+  // Workers and their lanes, from the published counters
+  auto *work_orchestrator = CHI_WORK_ORCHESTRATOR;
+  if (work_orchestrator) {
+    chi::u64 now_us = stats.timestamp_ns_ / 1000;
+    size_t num_workers = work_orchestrator->GetWorkerCount();
+    for (size_t i = 0; i < num_workers; ++i) {
+      chi::Worker *worker =
+          work_orchestrator->GetWorker(static_cast<chi::u32>(i));
+      if (!worker) continue;
+      const chi::WorkerCounters &c = worker->GetCounters();
+      chi::TaskLane *lane = worker->GetLane();
+      std::string prefix = "worker." + std::to_string(i) + ".";
+      snapshot[prefix + "busy_us"] = static_cast<double>(c.BusyUs(now_us));
+      snapshot[prefix + "sleep_us"] =
+          static_cast<double>(c.sleep_us_.load(std::memory_order_relaxed));
+      snapshot[prefix + "tasks_processed"] = static_cast<double>(
+          c.tasks_processed_.load(std::memory_order_relaxed));
+      snapshot[prefix + "blocked_tasks"] = static_cast<double>(
+          c.blocked_tasks_.load(std::memory_order_relaxed));
+      snapshot[prefix + "load_us"] =
+          static_cast<double>(c.load_.load(std::memory_order_relaxed));
+      snapshot[prefix + "lane_depth"] =
+          lane ? static_cast<double>(lane->Size()) : 0.0;
+    }
+  }
+
+  // Network queue lanes, per shard and priority
+  chi::NetQueue *net_queue = CHI_IPC->GetNetQueue();
+  if (net_queue) {
+    for (size_t shard = 0; shard < net_queue->GetNumLanes(); ++shard) {
+      for (size_t prio = 0; prio < net_queue->GetNumPrios(); ++prio) {
+        snapshot["net_queue." + std::to_string(shard) + "." +
+                 std::to_string(prio)] =
+            static_cast<double>(net_queue->GetLane(shard, prio).Size());
+      }
+    }
+  }
+
+  // Numeric fields of each local bdev's "stats" report
+  auto *pool_manager = CHI_POOL_MANAGER;
+  auto *ipc_manager = CHI_IPC;
+  std::vector<std::pair<chi::PoolId, std::string>> bdev_pools;
+  for (const auto &pid : pool_manager->GetAllPoolIds()) {
+    const auto *info = pool_manager->GetPoolInfo(pid);
+    if (info && info->chimod_name_ == "chimaera_bdev") {
+      bdev_pools.emplace_back(pid, info->pool_name_);
+    }
+  }
+  for (const auto &bdev : bdev_pools) {
+    chi::PoolQuery bdev_query;  // default = Local routing
+    auto sub_task = ipc_manager->NewTask<MonitorTask>(
+        chi::CreateTaskId(), bdev.first, bdev_query, "stats");
+    chi::Future<MonitorTask> sub_future = ipc_manager->Send(sub_task);
+    CHI_CO_AWAIT(sub_future);
+    if (sub_future->GetReturnCode() != 0 || sub_future->results_.empty()) {
+      continue;
+    }
+    const std::string &blob = sub_future->results_.begin()->second;
+    if (blob.empty()) continue;
+    try {
+      msgpack::object_handle oh = msgpack::unpack(blob.data(), blob.size());
+      const msgpack::object &obj = oh.get();
+      if (obj.type != msgpack::type::MAP) continue;
+      std::string prefix = "target." + bdev.second + ".";
+      for (chi::u32 j = 0; j < obj.via.map.size; ++j) {
+        const auto &kv = obj.via.map.ptr[j];
+        if (kv.key.type != msgpack::type::STR) continue;
+        double value;
+        switch (kv.val.type) {
+          case msgpack::type::POSITIVE_INTEGER:
+            value = static_cast<double>(kv.val.via.u64);
+            break;
+          case msgpack::type::NEGATIVE_INTEGER:
+            value = static_cast<double>(kv.val.via.i64);
+            break;
+          case msgpack::type::FLOAT32:
+          case msgpack::type::FLOAT64:
+            value = kv.val.via.f64;
+            break;
+          default:
+            continue;
+        }
+        snapshot[prefix + std::string(kv.key.via.str.ptr,
+                                      kv.key.via.str.size)] = value;
+      }
+    } catch (const std::exception &) {
+      // Skip a report that does not parse
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(stat_lock_);
+  stat_snapshot_.swap(snapshot);
+  ++stat_seq_;
+  stat_timestamp_ns_ = stats.timestamp_ns_;
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
 chi::TaskResume Runtime::SubmitBatch(hipc::FullPtr<SubmitBatchTask> task,
                                      chi::RunContext &rctx) {
   CHI_TASK_BODY_BEGIN
@@ -1556,6 +2542,9 @@ chi::TaskResume Runtime::SubmitBatch(hipc::FullPtr<SubmitBatchTask> task,
   // Initialize output values
   task->tasks_completed_ = 0;
   task->error_message_ = "";
+  task->return_codes_.assign(task->task_infos_.size(),
+                             SubmitBatchTask::kNotRun);
+  task->serialized_out_.clear();
 
   // If no tasks to submit
   if (task->task_infos_.empty()) {
@@ -1572,10 +2561,19 @@ chi::TaskResume Runtime::SubmitBatch(hipc::FullPtr<SubmitBatchTask> task,
   }
   chi::DefaultLoadArchive archive(load_buf);
 
+  // Sub-task outputs, serialized in submission order
+  chi::priv::vector<char> out_buf(CHI_PRIV_ALLOC);
+  chi::DefaultSaveArchive out_archive(chi::LocalMsgType::kSerializeOut,
+                                      out_buf);
+
   // Process tasks in batches of 32
   constexpr size_t kMaxParallelTasks = 32;
   std::vector<chi::Future<chi::Task>> pending_futures;
+  std::vector<chi::Container *> pending_containers;
+  std::vector<size_t> pending_indices;
   pending_futures.reserve(kMaxParallelTasks);
+  pending_containers.reserve(kMaxParallelTasks);
+  pending_indices.reserve(kMaxParallelTasks);
 
   size_t task_idx = 0;
   size_t total_tasks = task->task_infos_.size();
@@ -1583,6 +2581,8 @@ chi::TaskResume Runtime::SubmitBatch(hipc::FullPtr<SubmitBatchTask> task,
   while (task_idx < total_tasks) {
     // Submit up to kMaxParallelTasks tasks
     pending_futures.clear();
+    pending_containers.clear();
+    pending_indices.clear();
 
     for (size_t i = 0; i < kMaxParallelTasks && task_idx < total_tasks;
          ++i, ++task_idx) {
@@ -1609,11 +2609,19 @@ chi::TaskResume Runtime::SubmitBatch(hipc::FullPtr<SubmitBatchTask> task,
       // Submit task and collect future
       chi::Future<chi::Task> future = ipc_manager->Send(sub_task_ptr);
       pending_futures.push_back(std::move(future));
+      pending_containers.push_back(container);
+      pending_indices.push_back(task_idx);
     }
 
-    // CHI_CO_AWAIT all pending futures in this batch
-    for (auto &future : pending_futures) {
+    // CHI_CO_AWAIT all pending futures in this batch and record outputs
+    for (size_t i = 0; i < pending_futures.size(); ++i) {
+      auto &future = pending_futures[i];
       CHI_CO_AWAIT(future);
+      size_t idx = pending_indices[i];
+      hipc::FullPtr<chi::Task> sub_task = future.GetTaskPtr();
+      task->return_codes_[idx] = sub_task->GetReturnCode();
+      pending_containers[i]->LocalSaveTask(task->task_infos_[idx].method_id_,
+                                           out_archive, sub_task);
       task->tasks_completed_++;
     }
 
@@ -1621,6 +2629,9 @@ chi::TaskResume Runtime::SubmitBatch(hipc::FullPtr<SubmitBatchTask> task,
          task->tasks_completed_);
   }
 
+  const auto &out_data = out_archive.GetData();
+  task->serialized_out_.assign(out_data.begin(), out_data.end());
+
   task->SetReturnCode(0);
   HLOG(kInfo, "SubmitBatch: Completed {} of {} tasks", task->tasks_completed_,
        total_tasks);
@@ -1760,9 +2771,10 @@ chi::TaskResume Runtime::AddNode(hipc::FullPtr<AddNodeTask> task,
   auto *ipc_manager = CHI_IPC;
   auto *pool_manager = CHI_POOL_MANAGER;
 
-  // Add the new node to the IpcManager's hostfile
+  // Apply the origin's delta to the IpcManager's hostfile
   chi::u64 new_node_id =
-      ipc_manager->AddNode(task->new_node_ip_.str(), task->new_node_port_);
+      ipc_manager->AddNode(task->new_node_ip_.str(), task->new_node_port_,
+                           task->new_node_id_, task->table_version_);
   task->new_node_id_ = new_node_id;
 
   // Notify all containers about the new node
@@ -1842,7 +2854,6 @@ chi::TaskResume Runtime::ChangeAddressTable(
 chi::TaskResume Runtime::MigrateContainers(
     hipc::FullPtr<MigrateContainersTask> task, chi::RunContext &rctx) {
   CHI_TASK_BODY_BEGIN
-  (void)rctx;
   HLOG(kInfo, "Admin: Executing MigrateContainers task");
 
   auto *pool_manager = CHI_POOL_MANAGER;
@@ -1863,14 +2874,30 @@ chi::TaskResume Runtime::MigrateContainers(
     chi::u32 src_node =
         pool_manager->GetContainerNodeId(info.pool_id_, info.container_id_);
 
-    // Plug the container to stop new tasks and wait for work to complete
-    pool_manager->PlugContainer(info.pool_id_, info.container_id_);
-
-    // Get the specific Container on this node and call Migrate
+    // Pre-copy while the container keeps serving; each round copies what
+    // the previous one saw change
     bool is_plugged = false;
     chi::Container *container = pool_manager->GetContainer(
         info.pool_id_, info.container_id_, is_plugged);
+    chi::u64 remaining = 0;
+    for (chi::u32 round = 0; container && round < kMaxMigratePrecopyRounds;
+         ++round) {
+      CHI_CO_AWAIT(container->MigratePrecopy(info.dest_, false, remaining,
+                                             rctx));
+      if (remaining <= kMigrateFinalSyncEntries) {
+        break;
+      }
+    }
+
+    // Plug the container to stop new tasks and wait for work to complete
+    pool_manager->PlugContainer(info.pool_id_, info.container_id_);
+
+    // Final sync of the last changes, then let the container hand off
+    container = pool_manager->GetContainer(info.pool_id_, info.container_id_,
+                                           is_plugged);
     if (container) {
+      CHI_CO_AWAIT(container->MigratePrecopy(info.dest_, true, remaining,
+                                             rctx));
       container->Migrate(info.dest_);
     }
 
@@ -1914,13 +2941,14 @@ chi::TaskResume Runtime::MigrateContainers(
 bool Runtime::RetrySendToNode(RetryEntry &entry, chi::u64 node_id) {
   auto *ipc_manager = CHI_IPC;
   auto *pool_manager = CHI_POOL_MANAGER;
-  auto *config_manager = CHI_CONFIG_MANAGER;
 
   const chi::Host *target_host = ipc_manager->GetHost(node_id);
   if (!target_host) {
     return false;
   }
-  int port = static_cast<int>(config_manager->GetPort());
+  // Retries go to the peer shard that owns the task's net_key
+  chi::u32 shard = ipc_manager->GetNetShard(entry.task->task_id_.net_key_);
+  int port = static_cast<int>(ipc_manager->GetNetShardPort(shard));
   hshm::lbm::Transport *lbm_transport =
       ipc_manager->GetOrCreateClient(target_host->ip_address, port);
   if (!lbm_transport) {
@@ -1933,6 +2961,7 @@ bool Runtime::RetrySendToNode(RetryEntry &entry, chi::u64 node_id) {
   }
   chi::SaveTaskArchive archive(chi::MsgType::kSerializeIn, lbm_transport);
   container->SaveTask(entry.task->method_, archive, entry.task);
+  StampNetArchive(archive);
   hshm::lbm::LbmContext ctx(0);
   int rc = lbm_transport->Send(archive, ctx);
   return rc == 0;
@@ -1968,13 +2997,13 @@ chi::u64 Runtime::RerouteRetryEntry(RetryEntry &entry) {
   return 0;
 }
 
-void Runtime::ProcessRetryQueues() {
+void Runtime::ProcessRetryQueues(NetShard &net) {
   auto *ipc_manager = CHI_IPC;
   auto now = std::chrono::steady_clock::now();
 
   // Process send_in retry queue
-  auto it = send_in_retry_.begin();
-  while (it != send_in_retry_.end()) {
+  auto it = net.send_in_retry.begin();
+  while (it != net.send_in_retry.end()) {
     float elapsed = std::chrono::duration<float>(now - it->enqueued_at).count();
     float task_timeout = kRetryTimeoutSec;
     float task_net_timeout = it->task->pool_query_.GetNetTimeout();
@@ -1986,13 +3015,13 @@ void Runtime::ProcessRetryQueues() {
       HLOG(kError, "[RetryQueue] SendIn task timed out after {}s for node {}",
            elapsed, it->target_node_id);
       it->task->SetReturnCode(kNetworkTimeoutRC);
-      it = send_in_retry_.erase(it);
+      it = net.send_in_retry.erase(it);
     } else if (ipc_manager->IsAlive(it->target_node_id)) {
       // Original node came back: retry the send
       if (RetrySendToNode(*it, it->target_node_id)) {
         HLOG(kInfo, "[RetryQueue] SendIn retry succeeded for node {}",
              it->target_node_id);
-        it = send_in_retry_.erase(it);
+        it = net.send_in_retry.erase(it);
         continue;
       }
       // Retry failed, keep in queue
@@ -2011,7 +3040,7 @@ void Runtime::ProcessRetryQueues() {
                "[RetryQueue] SendIn re-routed retry succeeded "
                "for node {}",
                new_node);
-          it = send_in_retry_.erase(it);
+          it = net.send_in_retry.erase(it);
           continue;
         }
       }
@@ -2020,8 +3049,8 @@ void Runtime::ProcessRetryQueues() {
   }
 
   // Process send_out retry queue
-  it = send_out_retry_.begin();
-  while (it != send_out_retry_.end()) {
+  it = net.send_out_retry.begin();
+  while (it != net.send_out_retry.end()) {
     float elapsed = std::chrono::duration<float>(now - it->enqueued_at).count();
     float out_task_timeout = kRetryTimeoutSec;
     float out_task_net_timeout = it->task->pool_query_.GetNetTimeout();
@@ -2032,22 +3061,22 @@ void Runtime::ProcessRetryQueues() {
       HLOG(kError, "[RetryQueue] SendOut task timed out after {}s for node {}",
            elapsed, it->target_node_id);
       // For send_out, the result is lost; origin will timeout
-      it = send_out_retry_.erase(it);
+      it = net.send_out_retry.erase(it);
     } else if (ipc_manager->IsAlive(it->target_node_id)) {
       // Node came back: retry by calling SendOut
-      SendOut(it->task);
-      it = send_out_retry_.erase(it);
+      SendOut(net, it->task);
+      it = net.send_out_retry.erase(it);
     } else {
       ++it;
     }
   }
 }
 
-void Runtime::ScanSendMapTimeouts() {
+void Runtime::ScanSendMapTimeouts(NetShard &net) {
   auto *ipc_manager = CHI_IPC;
   auto now = std::chrono::steady_clock::now();
 
-  // Iterate dead nodes and check if any send_map_ entries target them
+  // Iterate dead nodes and check if any send_map entries target them
   const auto &dead_nodes = ipc_manager->GetDeadNodes();
   if (dead_nodes.empty()) return;
 
@@ -2057,9 +3086,9 @@ void Runtime::ScanSendMapTimeouts() {
     dead_map[entry.node_id] = entry.detected_at;
   }
 
-  // Scan send_map_ for tasks targeting dead nodes using for_each
+  // Scan send_map for tasks targeting dead nodes using for_each
   std::vector<size_t> keys_to_remove;
-  send_map_.for_each(
+  net.send_map.for_each(
       [&](const size_t &key, hipc::FullPtr<chi::Task> &origin_task) {
         if (origin_task.IsNull() || !origin_task->GetRunCtx()) return;
 
@@ -2101,18 +3130,31 @@ void Runtime::ScanSendMapTimeouts() {
       });
 
   for (size_t key : keys_to_remove) {
-    send_map_.erase(key);
+    net.send_map.erase(key);
   }
 }
 
-void Runtime::FlushStaleStateForNode(chi::u64 node_id) {
+void Runtime::FlushStaleStateForNode(NetShard &net, chi::u64 node_id) {
+  // 0. Requests to the old incarnation will never be answered
+  std::vector<size_t> stale_sends;
+  net.inflight_sends.for_each(
+      [&](const size_t &recv_key, const InflightSend &sent) {
+        if (sent.node_id == node_id) {
+          stale_sends.push_back(recv_key);
+        }
+      });
+  for (size_t recv_key : stale_sends) {
+    net.inflight_sends.erase(recv_key);
+  }
+  net.node_inflight.erase(node_id);
+
   // 1. Discard send_in retry entries targeting this node.
   //    For each discarded entry, increment the origin task's
   //    completed_replicas so broadcast origins can still complete.
-  for (auto it = send_in_retry_.begin(); it != send_in_retry_.end();) {
+  for (auto it = net.send_in_retry.begin(); it != net.send_in_retry.end();) {
     if (it->target_node_id == node_id) {
       size_t net_key = it->task->task_id_.net_key_;
-      auto send_it = send_map_.find(net_key);
+      auto send_it = net.send_map.find(net_key);
       if (send_it != nullptr) {
         auto &origin = *send_it;
         if (origin->GetRunCtx()) {
@@ -2122,7 +3164,7 @@ void Runtime::FlushStaleStateForNode(chi::u64 node_id) {
       HLOG(kInfo,
            "[FlushStale] Discarding SendIn retry for restarted node {}",
            node_id);
-      it = send_in_retry_.erase(it);
+      it = net.send_in_retry.erase(it);
     } else {
       ++it;
     }
@@ -2130,21 +3172,181 @@ void Runtime::FlushStaleStateForNode(chi::u64 node_id) {
 
   // 2. Discard send_out retry entries targeting this node.
   //    These are responses destined for the old incarnation; drop them.
-  for (auto it = send_out_retry_.begin(); it != send_out_retry_.end();) {
+  for (auto it = net.send_out_retry.begin(); it != net.send_out_retry.end();) {
     if (it->target_node_id == node_id) {
       HLOG(kInfo,
            "[FlushStale] Discarding SendOut retry for restarted node {}",
            node_id);
-      it = send_out_retry_.erase(it);
+      it = net.send_out_retry.erase(it);
     } else {
       ++it;
     }
   }
 }
 
+void Runtime::QueueSwimUpdate(chi::u64 node_id, chi::NodeState state,
+                              chi::u32 incarnation) {
+  auto *ipc_manager = CHI_IPC;
+  // Each update is retransmitted lambda * log10(N) times, as in SWIM
+  size_t num_hosts = ipc_manager->GetAllHosts().size();
+  chi::u32 sends = kGossipRetransmitMult *
+                   static_cast<chi::u32>(std::ceil(
+                       std::log10(static_cast<float>(num_hosts) + 1.0f)));
+  sends = std::max<chi::u32>(sends, 1);
+  for (auto &update : swim_updates_) {
+    if (update.node_id == node_id) {
+      update = {node_id, state, incarnation, sends};
+      return;
+    }
+  }
+  swim_updates_.push_back({node_id, state, incarnation, sends});
+}
+
+void Runtime::PiggybackSwimUpdates(std::vector<chi::u64> &gossip) {
+  std::lock_guard<std::mutex> lock(swim_lock_);
+  if (swim_updates_.empty()) {
+    return;
+  }
+  // Freshest news first: it has the most retransmissions left
+  std::sort(swim_updates_.begin(), swim_updates_.end(),
+            [](const SwimUpdate &a, const SwimUpdate &b) {
+              return a.sends_left > b.sends_left;
+            });
+  size_t count = std::min(kMaxGossipPerMessage, swim_updates_.size());
+  gossip.reserve(gossip.size() + 2 * count);
+  for (size_t i = 0; i < count; ++i) {
+    SwimUpdate &update = swim_updates_[i];
+    HeartbeatTask::PackGossip(gossip, update.node_id, update.state,
+                              update.incarnation);
+    --update.sends_left;
+  }
+  swim_updates_.erase(
+      std::remove_if(swim_updates_.begin(), swim_updates_.end(),
+                     [](const SwimUpdate &u) { return u.sends_left == 0; }),
+      swim_updates_.end());
+}
+
+void Runtime::ApplySwimUpdates(const std::vector<chi::u64> &gossip) {
+  auto *ipc_manager = CHI_IPC;
+  chi::u64 self_node_id = ipc_manager->GetNodeId();
+  std::lock_guard<std::mutex> lock(swim_lock_);
+  for (size_t i = 0; i < gossip.size() / 2; ++i) {
+    chi::u64 node_id;
+    chi::NodeState state;
+    chi::u32 incarnation;
+    HeartbeatTask::UnpackGossip(gossip, i, node_id, state, incarnation);
+
+    if (node_id == self_node_id) {
+      if (state == chi::NodeState::kAlive) {
+        continue;
+      }
+      // Refute: outrank the suspicion and tell everyone this node is alive.
+      // Being suspected also hints that this node is the slow one.
+      if (incarnation >= self_incarnation_) {
+        self_incarnation_ = incarnation + 1;
+      }
+      local_health_ = std::min(local_health_ + 1, kMaxLocalHealth);
+      HLOG(kWarning, "SWIM: Refuting suspicion of this node (incarnation {})",
+           self_incarnation_);
+      QueueSwimUpdate(self_node_id, chi::NodeState::kAlive, self_incarnation_);
+      continue;
+    }
+
+    chi::NodeState local_state = ipc_manager->GetNodeState(node_id);
+    if (local_state == chi::NodeState::kDead) {
+      // Dead is final; a restarted node rejoins through the recv path
+      continue;
+    }
+    chi::u32 &known = node_incarnation_[node_id];
+    switch (state) {
+      case chi::NodeState::kAlive:
+        if (incarnation <= known) {
+          break;
+        }
+        known = incarnation;
+        if (local_state != chi::NodeState::kAlive) {
+          ipc_manager->SetNodeState(node_id, chi::NodeState::kAlive);
+        }
+        QueueSwimUpdate(node_id, state, incarnation);
+        break;
+      case chi::NodeState::kProbeFailed:
+      case chi::NodeState::kSuspected:
+        if (incarnation < known ||
+            (incarnation == known &&
+             local_state == chi::NodeState::kSuspected)) {
+          break;
+        }
+        known = incarnation;
+        HLOG(kWarning, "SWIM: Gossip reports node {} suspected", node_id);
+        ipc_manager->SetNodeState(node_id, chi::NodeState::kSuspected);
+        QueueSwimUpdate(node_id, chi::NodeState::kSuspected, incarnation);
+        break;
+      case chi::NodeState::kDead:
+        // A confirmation overrides any incarnation
+        HLOG(kError, "SWIM: Gossip reports node {} dead", node_id);
+        ipc_manager->SetDead(node_id);
+        QueueSwimUpdate(node_id, state, incarnation);
+        swim_dead_.push_back(node_id);
+        break;
+    }
+  }
+}
+
+float Runtime::GetSuspicionTimeoutSec() const {
+  auto *ipc_manager = CHI_IPC;
+  size_t num_hosts = ipc_manager->GetAllHosts().size();
+  // News needs about log(N) probe periods to reach every node
+  float scale = std::log10(static_cast<float>(num_hosts) + 1.0f);
+  return kSuspicionTimeoutSec * std::max(1.0f, scale);
+}
+
+chi::u64 Runtime::NextProbeTarget() {
+  auto *ipc_manager = CHI_IPC;
+  chi::u64 self_node_id = ipc_manager->GetNodeId();
+  // SWIM randomized round-robin: visit every peer once per round, in a
+  // fresh random order each round, so a failure is probed within N periods
+  for (size_t tries = 0; tries <= probe_order_.size(); ++tries) {
+    if (probe_order_idx_ >= probe_order_.size()) {
+      probe_order_.clear();
+      for (const auto &h : ipc_manager->GetAllHosts()) {
+        if (h.node_id != self_node_id) {
+          probe_order_.push_back(h.node_id);
+        }
+      }
+      std::shuffle(probe_order_.begin(), probe_order_.end(), probe_rng_);
+      probe_order_idx_ = 0;
+      if (probe_order_.empty()) {
+        break;
+      }
+    }
+    chi::u64 node_id = probe_order_[probe_order_idx_++];
+    // Skip nodes that are being probed, suspected or dead. Re-probing a
+    // suspected node would reset its suspicion timer.
+    if (ipc_manager->GetNodeState(node_id) != chi::NodeState::kAlive) {
+      continue;
+    }
+    bool already_probing = false;
+    for (const auto &p : pending_direct_probes_) {
+      if (p.target_node_id == node_id) {
+        already_probing = true;
+        break;
+      }
+    }
+    if (!already_probing) {
+      return node_id;
+    }
+  }
+  return self_node_id;
+}
+
 chi::TaskResume Runtime::Heartbeat(hipc::FullPtr<HeartbeatTask> task,
                                    chi::RunContext &rctx) {
   CHI_TASK_BODY_BEGIN
+  // Learn the prober's news and answer with ours. Recovery for nodes the
+  // gossip declared dead runs in HeartbeatProbe so the ack is not delayed.
+  ApplySwimUpdates(task->gossip_);
+  task->gossip_.clear();
+  PiggybackSwimUpdates(task->gossip_);
   task->SetReturnCode(0);
   rctx.did_work_ = true;
   CHI_CO_RETURN;
@@ -2159,17 +3361,45 @@ chi::TaskResume Runtime::HeartbeatProbe(hipc::FullPtr<HeartbeatProbeTask> task,
   chi::u64 self_node_id = ipc_manager->GetNodeId();
   bool did_work = false;
 
+  // Move a node to suspected once its last indirect probe has failed
+  auto suspect_if_no_indirect_left = [this, ipc_manager](chi::u64 target) {
+    for (const auto &p : pending_indirect_probes_) {
+      if (p.target_node_id == target) {
+        return;
+      }
+    }
+    if (ipc_manager->GetNodeState(target) != chi::NodeState::kProbeFailed) {
+      return;
+    }
+    ipc_manager->SetNodeState(target, chi::NodeState::kSuspected);
+    HLOG(kWarning,
+         "SWIM: All indirect probes for node {} failed, marking suspected",
+         target);
+    std::lock_guard<std::mutex> lock(swim_lock_);
+    QueueSwimUpdate(target, chi::NodeState::kSuspected,
+                    node_incarnation_[target]);
+  };
+
+  // Lifeguard: a slow prober waits longer before blaming its target
+  float direct_timeout_sec =
+      kDirectProbeTimeoutSec * static_cast<float>(1 + local_health_);
+
   // 1. Check pending direct probes
   for (auto it = pending_direct_probes_.begin();
        it != pending_direct_probes_.end();) {
     if (it->future.IsComplete()) {
-      // Direct probe succeeded - node is alive
+      // Direct probe succeeded - node is alive; learn its gossip
+      it->future.Wait(0);  // Finalize
+      ApplySwimUpdates(it->future->gossip_);
       ipc_manager->SetNodeState(it->target_node_id, chi::NodeState::kAlive);
+      if (local_health_ > 0) {
+        --local_health_;
+      }
       it = pending_direct_probes_.erase(it);
       did_work = true;
     } else {
       float elapsed = std::chrono::duration<float>(now - it->sent_at).count();
-      if (elapsed > kDirectProbeTimeoutSec) {
+      if (elapsed > direct_timeout_sec) {
         // Direct probe timed out - escalate to indirect probing
         ipc_manager->SetNodeState(it->target_node_id,
                                   chi::NodeState::kProbeFailed);
@@ -2197,7 +3427,11 @@ chi::TaskResume Runtime::HeartbeatProbe(hipc::FullPtr<HeartbeatProbeTask> task,
                std::chrono::steady_clock::now()});
         }
 
+        chi::u64 target = it->target_node_id;
         it = pending_direct_probes_.erase(it);
+        if (num_helpers == 0) {
+          suspect_if_no_indirect_left(target);
+        }
         did_work = true;
       } else {
         ++it;
@@ -2211,8 +3445,10 @@ chi::TaskResume Runtime::HeartbeatProbe(hipc::FullPtr<HeartbeatProbeTask> task,
     if (it->future.IsComplete()) {
       it->future.Wait(0);  // Finalize
       if (it->future->probe_result_ == 0) {
-        // Indirect probe succeeded - node is alive
+        // Indirect probe succeeded - node is alive. Others reach it while
+        // this node could not, which hints that this node is the slow one.
         ipc_manager->SetNodeState(it->target_node_id, chi::NodeState::kAlive);
+        local_health_ = std::min(local_health_ + 1, kMaxLocalHealth);
         HLOG(kInfo, "SWIM: Indirect probe via node {} confirmed node {} alive",
              it->helper_node_id, it->target_node_id);
         // Remove all pending indirects for this target
@@ -2230,22 +3466,7 @@ chi::TaskResume Runtime::HeartbeatProbe(hipc::FullPtr<HeartbeatProbeTask> task,
         chi::u64 target = it->target_node_id;
         it = pending_indirect_probes_.erase(it);
         did_work = true;
-        // If no more pending indirects for this target, move to suspected
-        bool has_more = false;
-        for (const auto &p : pending_indirect_probes_) {
-          if (p.target_node_id == target) {
-            has_more = true;
-            break;
-          }
-        }
-        if (!has_more &&
-            ipc_manager->GetNodeState(target) == chi::NodeState::kProbeFailed) {
-          ipc_manager->SetNodeState(target, chi::NodeState::kSuspected);
-          HLOG(
-              kWarning,
-              "SWIM: All indirect probes for node {} failed, marking suspected",
-              target);
-        }
+        suspect_if_no_indirect_left(target);
       }
     } else {
       float elapsed = std::chrono::duration<float>(now - it->sent_at).count();
@@ -2253,44 +3474,44 @@ chi::TaskResume Runtime::HeartbeatProbe(hipc::FullPtr<HeartbeatProbeTask> task,
         chi::u64 target = it->target_node_id;
         it = pending_indirect_probes_.erase(it);
         did_work = true;
-        // If no more pending indirects for this target, move to suspected
-        bool has_more = false;
-        for (const auto &p : pending_indirect_probes_) {
-          if (p.target_node_id == target) {
-            has_more = true;
-            break;
-          }
-        }
-        if (!has_more &&
-            ipc_manager->GetNodeState(target) == chi::NodeState::kProbeFailed) {
-          ipc_manager->SetNodeState(target, chi::NodeState::kSuspected);
-          HLOG(
-              kWarning,
-              "SWIM: All indirect probes for node {} failed, marking suspected",
-              target);
-        }
+        suspect_if_no_indirect_left(target);
       } else {
         ++it;
       }
     }
   }
 
-  // 3. Check suspicion timeouts
+  // 3. Check suspicion timeouts and recover nodes the gossip declared dead
   {
+    std::vector<chi::u64> dead_nodes;
+    float suspicion_timeout_sec = GetSuspicionTimeoutSec();
     const auto &hosts = ipc_manager->GetAllHosts();
     for (const auto &h : hosts) {
       if (h.state == chi::NodeState::kSuspected) {
         float since_change =
             std::chrono::duration<float>(now - h.state_changed_at).count();
-        if (since_change >= kSuspicionTimeoutSec) {
+        if (since_change >= suspicion_timeout_sec) {
           HLOG(kError, "SWIM: Node {} confirmed dead after suspicion timeout",
                h.node_id);
-          ipc_manager->SetDead(h.node_id);
-          did_work = true;
-          CHI_CO_AWAIT(TriggerRecovery(h.node_id));
+          dead_nodes.push_back(h.node_id);
         }
       }
     }
+    {
+      std::lock_guard<std::mutex> lock(swim_lock_);
+      for (chi::u64 node_id : dead_nodes) {
+        QueueSwimUpdate(node_id, chi::NodeState::kDead,
+                        node_incarnation_[node_id]);
+      }
+      dead_nodes.insert(dead_nodes.end(), swim_dead_.begin(),
+                        swim_dead_.end());
+      swim_dead_.clear();
+    }
+    for (chi::u64 node_id : dead_nodes) {
+      ipc_manager->SetDead(node_id);
+      did_work = true;
+      CHI_CO_AWAIT(TriggerRecovery(node_id));
+    }
   }
 
   // 4. Self-fencing: if majority of other nodes are suspected/dead, fence self
@@ -2321,40 +3542,17 @@ chi::TaskResume Runtime::HeartbeatProbe(hipc::FullPtr<HeartbeatProbeTask> task,
     }
   }
 
-  // 5. Send new direct probe (round-robin, one per invocation)
+  // 5. Send one new direct probe per period, carrying our gossip
   {
-    const auto &hosts = ipc_manager->GetAllHosts();
-    if (hosts.size() > 1) {
-      size_t start_idx = probe_round_robin_idx_;
-      for (size_t i = 0; i < hosts.size(); ++i) {
-        size_t idx = (start_idx + i) % hosts.size();
-        const auto &h = hosts[idx];
-        if (h.node_id == self_node_id) continue;
-        if (h.state == chi::NodeState::kDead) continue;
-        // Skip suspected nodes — let the suspicion timeout fire
-        // before re-probing, otherwise the state cycles
-        // kSuspected→kProbeFailed→kSuspected and resets the timer
-        if (h.state == chi::NodeState::kSuspected) continue;
-        if (h.state == chi::NodeState::kProbeFailed) continue;
-        // Skip if already probing this node
-        bool already_probing = false;
-        for (const auto &p : pending_direct_probes_) {
-          if (p.target_node_id == h.node_id) {
-            already_probing = true;
-            break;
-          }
-        }
-        if (already_probing) continue;
-
-        // Send direct probe
-        auto future =
-            client_.AsyncHeartbeat(chi::PoolQuery::Physical(h.node_id));
-        pending_direct_probes_.push_back(
-            {std::move(future), h.node_id, std::chrono::steady_clock::now()});
-        probe_round_robin_idx_ = (idx + 1) % hosts.size();
-        did_work = true;
-        break;  // One probe per invocation
-      }
+    chi::u64 target = NextProbeTarget();
+    if (target != self_node_id) {
+      std::vector<chi::u64> gossip;
+      PiggybackSwimUpdates(gossip);
+      auto future =
+          client_.AsyncHeartbeat(chi::PoolQuery::Physical(target), gossip);
+      pending_direct_probes_.push_back(
+          {std::move(future), target, std::chrono::steady_clock::now()});
+      did_work = true;
     }
   }
 
@@ -2415,8 +3613,12 @@ chi::TaskStat Runtime::GetTaskStats(chi::u32 method_id) const {
 }
 
 chi::u64 Runtime::GetWorkRemaining() const {
-  // Note: No lock needed - single net worker processes all Send/Recv tasks
-  return send_map_.size() + recv_map_.size();
+  // Approximate across shards; each map is only written by its net worker
+  chi::u64 remaining = 0;
+  for (const auto &net : net_shards_) {
+    remaining += net->send_map.size() + net->recv_map.size();
+  }
+  return remaining;
 }
 
 //===========================================================================
@@ -2590,6 +3792,8 @@ chi::TaskResume Runtime::SystemMonitor(hipc::FullPtr<SystemMonitorTask> task,
   if (system_stats_ring_) {
     system_stats_ring_->Push(stats);
   }
+  SampleWorkers(stats.timestamp_ns_);
+  CHI_CO_AWAIT(SnapshotStats(stats));
 
   rctx.did_work_ = true;
   (void)task;
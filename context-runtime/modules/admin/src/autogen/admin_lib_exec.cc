@@ -1,7 +1,7 @@
 /**
  * Auto-generated execution implementation for admin ChiMod
- * Implements Container virtual APIs (Run, SaveTask, LoadTask, NewCopyTask, NewTask)
- * using switch-case dispatch
+ * Implements Container virtual APIs (Run, SaveTask, LoadTask, NewCopyTask, NewTask).
+ * Run uses switch-case dispatch; the others index the kMethodExec table.
  * 
  * This file is autogenerated - do not edit manually.
  * Changes should be made to the autogen tool or the YAML configuration.
@@ -11,9 +11,52 @@
 #include "chimaera/admin/autogen/admin_methods.h"
 #include <chimaera/chimaera.h>
 #include <chimaera/task.h>  // For TaskResume coroutine return type
+#include <chimaera/method_exec.h>
 
 namespace chimaera::admin {
 
+namespace {
+
+/** Per-method dispatch table indexed by method ID */
+constexpr chi::MethodExec kMethodExec[34] = {
+    chi::MakeMethodExec<CreateTask>(),  // 0: Create
+    chi::MakeMethodExec<DestroyTask>(),  // 1: Destroy
+    {},  // 2
+    {},  // 3
+    {},  // 4
+    {},  // 5
+    {},  // 6
+    {},  // 7
+    {},  // 8
+    chi::MakeMethodExec<MonitorTask>(),  // 9: Monitor
+    chi::MakeMethodExec<admin::GetOrCreatePoolTask<admin::CreateParams>>(),  // 10: GetOrCreatePool
+    chi::MakeMethodExec<DestroyPoolTask>(),  // 11: DestroyPool
+    chi::MakeMethodExec<StopRuntimeTask>(),  // 12: StopRuntime
+    chi::MakeMethodExec<FlushTask>(),  // 13: Flush
+    chi::MakeMethodExec<SendTask>(),  // 14: Send
+    chi::MakeMethodExec<RecvTask>(),  // 15: Recv
+    chi::MakeMethodExec<ClientConnectTask>(),  // 16: ClientConnect
+    {},  // 17
+    chi::MakeMethodExec<SubmitBatchTask>(),  // 18: SubmitBatch
+    chi::MakeMethodExec<WreapDeadIpcsTask>(),  // 19: WreapDeadIpcs
+    chi::MakeMethodExec<ClientRecvTask>(),  // 20: ClientRecv
+    chi::MakeMethodExec<ClientSendTask>(),  // 21: ClientSend
+    chi::MakeMethodExec<RegisterMemoryTask>(),  // 22: RegisterMemory
+    chi::MakeMethodExec<RestartContainersTask>(),  // 23: RestartContainers
+    chi::MakeMethodExec<AddNodeTask>(),  // 24: AddNode
+    chi::MakeMethodExec<ChangeAddressTableTask>(),  // 25: ChangeAddressTable
+    chi::MakeMethodExec<MigrateContainersTask>(),  // 26: MigrateContainers
+    chi::MakeMethodExec<HeartbeatTask>(),  // 27: Heartbeat
+    chi::MakeMethodExec<HeartbeatProbeTask>(),  // 28: HeartbeatProbe
+    chi::MakeMethodExec<ProbeRequestTask>(),  // 29: ProbeRequest
+    chi::MakeMethodExec<RecoverContainersTask>(),  // 30: RecoverContainers
+    chi::MakeMethodExec<SystemMonitorTask>(),  // 31: SystemMonitor
+    chi::MakeMethodExec<AnnounceShutdownTask>(),  // 32: AnnounceShutdown
+    chi::MakeMethodExec<RegisterGpuContainerTask>(),  // 33: RegisterGpuContainer
+};
+
+}  // namespace
+
 //==============================================================================
 // Container Virtual API Implementations
 //==============================================================================
@@ -29,6 +72,7 @@ void Runtime::Init(const chi::PoolId &pool_id, const std::string &pool_name,
   // Initialize per-method load prediction model
   DefineModel(Method::kMaxMethodId);
   SetMethodNames(Method::GetMethodNames());
+  SetMethodTraits(Method::kMethodTraits);
 }
 
 chi::TaskResume Runtime::Run(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr, chi::RunContext& rctx) {
@@ -187,7 +231,7 @@ chi::TaskResume Runtime::Run(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr,
     case Method::kRegisterGpuContainer: {
       // Cast task FullPtr to specific type
       hipc::FullPtr<RegisterGpuContainerTask> typed_task = task_ptr.template Cast<RegisterGpuContainerTask>();
-      co_await RegisterGpuContainer(typed_task, rctx);
+      CHI_CO_AWAIT(RegisterGpuContainer(typed_task, rctx));
       break;
     }
     default: {
@@ -201,281 +245,17 @@ chi::TaskResume Runtime::Run(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr,
 
 void Runtime::SaveTask(chi::u32 method, chi::SaveTaskArchive& archive, 
                         hipc::FullPtr<chi::Task> task_ptr) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = task_ptr.template Cast<CreateTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = task_ptr.template Cast<DestroyTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = task_ptr.template Cast<MonitorTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetOrCreatePool: {
-      auto typed_task = task_ptr.template Cast<admin::GetOrCreatePoolTask<admin::CreateParams>>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroyPool: {
-      auto typed_task = task_ptr.template Cast<DestroyPoolTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kStopRuntime: {
-      auto typed_task = task_ptr.template Cast<StopRuntimeTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kFlush: {
-      auto typed_task = task_ptr.template Cast<FlushTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kSend: {
-      auto typed_task = task_ptr.template Cast<SendTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kRecv: {
-      auto typed_task = task_ptr.template Cast<RecvTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kClientConnect: {
-      auto typed_task = task_ptr.template Cast<ClientConnectTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kSubmitBatch: {
-      auto typed_task = task_ptr.template Cast<SubmitBatchTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kWreapDeadIpcs: {
-      auto typed_task = task_ptr.template Cast<WreapDeadIpcsTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kClientRecv: {
-      auto typed_task = task_ptr.template Cast<ClientRecvTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kClientSend: {
-      auto typed_task = task_ptr.template Cast<ClientSendTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kRegisterMemory: {
-      auto typed_task = task_ptr.template Cast<RegisterMemoryTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kRestartContainers: {
-      auto typed_task = task_ptr.template Cast<RestartContainersTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kAddNode: {
-      auto typed_task = task_ptr.template Cast<AddNodeTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kChangeAddressTable: {
-      auto typed_task = task_ptr.template Cast<ChangeAddressTableTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kMigrateContainers: {
-      auto typed_task = task_ptr.template Cast<MigrateContainersTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kHeartbeat: {
-      auto typed_task = task_ptr.template Cast<HeartbeatTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kHeartbeatProbe: {
-      auto typed_task = task_ptr.template Cast<HeartbeatProbeTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kProbeRequest: {
-      auto typed_task = task_ptr.template Cast<ProbeRequestTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kRecoverContainers: {
-      auto typed_task = task_ptr.template Cast<RecoverContainersTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kSystemMonitor: {
-      auto typed_task = task_ptr.template Cast<SystemMonitorTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kAnnounceShutdown: {
-      auto typed_task = task_ptr.template Cast<AnnounceShutdownTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kRegisterGpuContainer: {
-      auto typed_task = task_ptr.template Cast<RegisterGpuContainerTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    default: {
-      // Unknown method - do nothing
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->save_(archive, task_ptr);
   }
 }
 
 void Runtime::LoadTask(chi::u32 method, chi::LoadTaskArchive& archive,
                         hipc::FullPtr<chi::Task> task_ptr) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = task_ptr.template Cast<CreateTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = task_ptr.template Cast<DestroyTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = task_ptr.template Cast<MonitorTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetOrCreatePool: {
-      auto typed_task = task_ptr.template Cast<admin::GetOrCreatePoolTask<admin::CreateParams>>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroyPool: {
-      auto typed_task = task_ptr.template Cast<DestroyPoolTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kStopRuntime: {
-      auto typed_task = task_ptr.template Cast<StopRuntimeTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kFlush: {
-      auto typed_task = task_ptr.template Cast<FlushTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kSend: {
-      auto typed_task = task_ptr.template Cast<SendTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kRecv: {
-      auto typed_task = task_ptr.template Cast<RecvTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kClientConnect: {
-      auto typed_task = task_ptr.template Cast<ClientConnectTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kSubmitBatch: {
-      auto typed_task = task_ptr.template Cast<SubmitBatchTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kWreapDeadIpcs: {
-      auto typed_task = task_ptr.template Cast<WreapDeadIpcsTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kClientRecv: {
-      auto typed_task = task_ptr.template Cast<ClientRecvTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kClientSend: {
-      auto typed_task = task_ptr.template Cast<ClientSendTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kRegisterMemory: {
-      auto typed_task = task_ptr.template Cast<RegisterMemoryTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kRestartContainers: {
-      auto typed_task = task_ptr.template Cast<RestartContainersTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kAddNode: {
-      auto typed_task = task_ptr.template Cast<AddNodeTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kChangeAddressTable: {
-      auto typed_task = task_ptr.template Cast<ChangeAddressTableTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kMigrateContainers: {
-      auto typed_task = task_ptr.template Cast<MigrateContainersTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kHeartbeat: {
-      auto typed_task = task_ptr.template Cast<HeartbeatTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kHeartbeatProbe: {
-      auto typed_task = task_ptr.template Cast<HeartbeatProbeTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kProbeRequest: {
-      auto typed_task = task_ptr.template Cast<ProbeRequestTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kRecoverContainers: {
-      auto typed_task = task_ptr.template Cast<RecoverContainersTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kSystemMonitor: {
-      auto typed_task = task_ptr.template Cast<SystemMonitorTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kAnnounceShutdown: {
-      auto typed_task = task_ptr.template Cast<AnnounceShutdownTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kRegisterGpuContainer: {
-      auto typed_task = task_ptr.template Cast<RegisterGpuContainerTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    default: {
-      // Unknown method - do nothing
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->load_(archive, task_ptr);
   }
 }
 
@@ -489,167 +269,9 @@ hipc::FullPtr<chi::Task> Runtime::AllocLoadTask(chi::u32 method, chi::LoadTaskAr
 
 void Runtime::LocalLoadTask(chi::u32 method, chi::DefaultLoadArchive& archive,
                             hipc::FullPtr<chi::Task> task_ptr) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = task_ptr.template Cast<CreateTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = task_ptr.template Cast<DestroyTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = task_ptr.template Cast<MonitorTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetOrCreatePool: {
-      auto typed_task = task_ptr.template Cast<admin::GetOrCreatePoolTask<admin::CreateParams>>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroyPool: {
-      auto typed_task = task_ptr.template Cast<DestroyPoolTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kStopRuntime: {
-      auto typed_task = task_ptr.template Cast<StopRuntimeTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kFlush: {
-      auto typed_task = task_ptr.template Cast<FlushTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kSend: {
-      auto typed_task = task_ptr.template Cast<SendTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kRecv: {
-      auto typed_task = task_ptr.template Cast<RecvTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kClientConnect: {
-      auto typed_task = task_ptr.template Cast<ClientConnectTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kSubmitBatch: {
-      auto typed_task = task_ptr.template Cast<SubmitBatchTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kWreapDeadIpcs: {
-      auto typed_task = task_ptr.template Cast<WreapDeadIpcsTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kClientRecv: {
-      auto typed_task = task_ptr.template Cast<ClientRecvTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kClientSend: {
-      auto typed_task = task_ptr.template Cast<ClientSendTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kRegisterMemory: {
-      auto typed_task = task_ptr.template Cast<RegisterMemoryTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kRestartContainers: {
-      auto typed_task = task_ptr.template Cast<RestartContainersTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kAddNode: {
-      auto typed_task = task_ptr.template Cast<AddNodeTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kChangeAddressTable: {
-      auto typed_task = task_ptr.template Cast<ChangeAddressTableTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kMigrateContainers: {
-      auto typed_task = task_ptr.template Cast<MigrateContainersTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kHeartbeat: {
-      auto typed_task = task_ptr.template Cast<HeartbeatTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kHeartbeatProbe: {
-      auto typed_task = task_ptr.template Cast<HeartbeatProbeTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kProbeRequest: {
-      auto typed_task = task_ptr.template Cast<ProbeRequestTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kRecoverContainers: {
-      auto typed_task = task_ptr.template Cast<RecoverContainersTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kSystemMonitor: {
-      auto typed_task = task_ptr.template Cast<SystemMonitorTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kAnnounceShutdown: {
-      auto typed_task = task_ptr.template Cast<AnnounceShutdownTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kRegisterGpuContainer: {
-      auto typed_task = task_ptr.template Cast<RegisterGpuContainerTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    default: {
-      // Unknown method - do nothing
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->local_load_(archive, task_ptr);
   }
 }
 
@@ -663,849 +285,58 @@ hipc::FullPtr<chi::Task> Runtime::LocalAllocLoadTask(chi::u32 method, chi::Defau
 
 void Runtime::LocalSaveTask(chi::u32 method, chi::DefaultSaveArchive& archive, 
                              hipc::FullPtr<chi::Task> task_ptr) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = task_ptr.template Cast<CreateTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = task_ptr.template Cast<DestroyTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = task_ptr.template Cast<MonitorTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetOrCreatePool: {
-      auto typed_task = task_ptr.template Cast<admin::GetOrCreatePoolTask<admin::CreateParams>>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroyPool: {
-      auto typed_task = task_ptr.template Cast<DestroyPoolTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kStopRuntime: {
-      auto typed_task = task_ptr.template Cast<StopRuntimeTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kFlush: {
-      auto typed_task = task_ptr.template Cast<FlushTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kSend: {
-      auto typed_task = task_ptr.template Cast<SendTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kRecv: {
-      auto typed_task = task_ptr.template Cast<RecvTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kClientConnect: {
-      auto typed_task = task_ptr.template Cast<ClientConnectTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kSubmitBatch: {
-      auto typed_task = task_ptr.template Cast<SubmitBatchTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kWreapDeadIpcs: {
-      auto typed_task = task_ptr.template Cast<WreapDeadIpcsTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kClientRecv: {
-      auto typed_task = task_ptr.template Cast<ClientRecvTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kClientSend: {
-      auto typed_task = task_ptr.template Cast<ClientSendTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kRegisterMemory: {
-      auto typed_task = task_ptr.template Cast<RegisterMemoryTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kRestartContainers: {
-      auto typed_task = task_ptr.template Cast<RestartContainersTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kAddNode: {
-      auto typed_task = task_ptr.template Cast<AddNodeTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kChangeAddressTable: {
-      auto typed_task = task_ptr.template Cast<ChangeAddressTableTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kMigrateContainers: {
-      auto typed_task = task_ptr.template Cast<MigrateContainersTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kHeartbeat: {
-      auto typed_task = task_ptr.template Cast<HeartbeatTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kHeartbeatProbe: {
-      auto typed_task = task_ptr.template Cast<HeartbeatProbeTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kProbeRequest: {
-      auto typed_task = task_ptr.template Cast<ProbeRequestTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kRecoverContainers: {
-      auto typed_task = task_ptr.template Cast<RecoverContainersTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kSystemMonitor: {
-      auto typed_task = task_ptr.template Cast<SystemMonitorTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kAnnounceShutdown: {
-      auto typed_task = task_ptr.template Cast<AnnounceShutdownTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kRegisterGpuContainer: {
-      auto typed_task = task_ptr.template Cast<RegisterGpuContainerTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    default: {
-      // Unknown method - do nothing
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->local_save_(archive, task_ptr);
   }
 }
 
 hipc::FullPtr<chi::Task> Runtime::NewCopyTask(chi::u32 method, hipc::FullPtr<chi::Task> orig_task_ptr, bool deep) {
+  (void)deep;    // Deep copy parameter reserved for future use
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    return exec->new_copy_(orig_task_ptr);
+  }
+  // For unknown methods, create base Task copy
   auto* ipc_manager = CHI_IPC;
   if (!ipc_manager) {
     return hipc::FullPtr<chi::Task>();
   }
-  
-  switch (method) {
-    case Method::kCreate: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<CreateTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<CreateTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kDestroy: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<DestroyTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<DestroyTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kMonitor: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<MonitorTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<MonitorTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kGetOrCreatePool: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<admin::GetOrCreatePoolTask<admin::CreateParams>>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<admin::GetOrCreatePoolTask<admin::CreateParams>>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kDestroyPool: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<DestroyPoolTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<DestroyPoolTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kStopRuntime: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<StopRuntimeTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<StopRuntimeTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kFlush: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<FlushTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<FlushTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kSend: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<SendTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<SendTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kRecv: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<RecvTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<RecvTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kClientConnect: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<ClientConnectTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<ClientConnectTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kSubmitBatch: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<SubmitBatchTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<SubmitBatchTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kWreapDeadIpcs: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<WreapDeadIpcsTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<WreapDeadIpcsTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kClientRecv: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<ClientRecvTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<ClientRecvTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kClientSend: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<ClientSendTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<ClientSendTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kRegisterMemory: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<RegisterMemoryTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<RegisterMemoryTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kRestartContainers: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<RestartContainersTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<RestartContainersTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kAddNode: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<AddNodeTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<AddNodeTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kChangeAddressTable: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<ChangeAddressTableTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<ChangeAddressTableTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kMigrateContainers: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<MigrateContainersTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<MigrateContainersTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kHeartbeat: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<HeartbeatTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<HeartbeatTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kHeartbeatProbe: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<HeartbeatProbeTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<HeartbeatProbeTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kProbeRequest: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<ProbeRequestTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<ProbeRequestTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kRecoverContainers: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<RecoverContainersTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<RecoverContainersTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kSystemMonitor: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<SystemMonitorTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<SystemMonitorTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kAnnounceShutdown: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<AnnounceShutdownTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<AnnounceShutdownTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kRegisterGpuContainer: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<RegisterGpuContainerTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<RegisterGpuContainerTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    default: {
-      // For unknown methods, create base Task copy
-      auto new_task_ptr = ipc_manager->NewTask<chi::Task>();
-      if (!new_task_ptr.IsNull()) {
-        new_task_ptr->Copy(orig_task_ptr);
-        return new_task_ptr;
-      }
-      break;
-    }
+  auto new_task_ptr = ipc_manager->NewTask<chi::Task>();
+  if (!new_task_ptr.IsNull()) {
+    new_task_ptr->Copy(orig_task_ptr);
   }
-  
-  (void)deep;    // Deep copy parameter reserved for future use
-  return hipc::FullPtr<chi::Task>();
+  return new_task_ptr;
 }
 
 hipc::FullPtr<chi::Task> Runtime::NewTask(chi::u32 method) {
-  auto* ipc_manager = CHI_IPC;
-  if (!ipc_manager) {
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec == nullptr) {
+    // For unknown methods, return null pointer
     return hipc::FullPtr<chi::Task>();
   }
-  
-  switch (method) {
-    case Method::kCreate: {
-      auto new_task_ptr = ipc_manager->NewTask<CreateTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kDestroy: {
-      auto new_task_ptr = ipc_manager->NewTask<DestroyTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kMonitor: {
-      auto new_task_ptr = ipc_manager->NewTask<MonitorTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kGetOrCreatePool: {
-      auto new_task_ptr = ipc_manager->NewTask<admin::GetOrCreatePoolTask<admin::CreateParams>>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kDestroyPool: {
-      auto new_task_ptr = ipc_manager->NewTask<DestroyPoolTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kStopRuntime: {
-      auto new_task_ptr = ipc_manager->NewTask<StopRuntimeTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kFlush: {
-      auto new_task_ptr = ipc_manager->NewTask<FlushTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kSend: {
-      auto new_task_ptr = ipc_manager->NewTask<SendTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kRecv: {
-      auto new_task_ptr = ipc_manager->NewTask<RecvTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kClientConnect: {
-      auto new_task_ptr = ipc_manager->NewTask<ClientConnectTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kSubmitBatch: {
-      auto new_task_ptr = ipc_manager->NewTask<SubmitBatchTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kWreapDeadIpcs: {
-      auto new_task_ptr = ipc_manager->NewTask<WreapDeadIpcsTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kClientRecv: {
-      auto new_task_ptr = ipc_manager->NewTask<ClientRecvTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kClientSend: {
-      auto new_task_ptr = ipc_manager->NewTask<ClientSendTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kRegisterMemory: {
-      auto new_task_ptr = ipc_manager->NewTask<RegisterMemoryTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kRestartContainers: {
-      auto new_task_ptr = ipc_manager->NewTask<RestartContainersTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kAddNode: {
-      auto new_task_ptr = ipc_manager->NewTask<AddNodeTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kChangeAddressTable: {
-      auto new_task_ptr = ipc_manager->NewTask<ChangeAddressTableTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kMigrateContainers: {
-      auto new_task_ptr = ipc_manager->NewTask<MigrateContainersTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kHeartbeat: {
-      auto new_task_ptr = ipc_manager->NewTask<HeartbeatTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kHeartbeatProbe: {
-      auto new_task_ptr = ipc_manager->NewTask<HeartbeatProbeTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kProbeRequest: {
-      auto new_task_ptr = ipc_manager->NewTask<ProbeRequestTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kRecoverContainers: {
-      auto new_task_ptr = ipc_manager->NewTask<RecoverContainersTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kSystemMonitor: {
-      auto new_task_ptr = ipc_manager->NewTask<SystemMonitorTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kAnnounceShutdown: {
-      auto new_task_ptr = ipc_manager->NewTask<AnnounceShutdownTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kRegisterGpuContainer: {
-      auto new_task_ptr = ipc_manager->NewTask<RegisterGpuContainerTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    default: {
-      // For unknown methods, return null pointer
-      return hipc::FullPtr<chi::Task>();
-    }
-  }
+  return exec->new_task_();
 }
 
 void Runtime::Aggregate(chi::u32 method, hipc::FullPtr<chi::Task> orig_task,
                         const hipc::FullPtr<chi::Task>& replica_task) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = orig_task.template Cast<CreateTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = orig_task.template Cast<DestroyTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = orig_task.template Cast<MonitorTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kGetOrCreatePool: {
-      auto typed_task = orig_task.template Cast<admin::GetOrCreatePoolTask<admin::CreateParams>>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kDestroyPool: {
-      auto typed_task = orig_task.template Cast<DestroyPoolTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kStopRuntime: {
-      auto typed_task = orig_task.template Cast<StopRuntimeTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kFlush: {
-      auto typed_task = orig_task.template Cast<FlushTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kSend: {
-      auto typed_task = orig_task.template Cast<SendTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kRecv: {
-      auto typed_task = orig_task.template Cast<RecvTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kClientConnect: {
-      auto typed_task = orig_task.template Cast<ClientConnectTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kSubmitBatch: {
-      auto typed_task = orig_task.template Cast<SubmitBatchTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kWreapDeadIpcs: {
-      auto typed_task = orig_task.template Cast<WreapDeadIpcsTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kClientRecv: {
-      auto typed_task = orig_task.template Cast<ClientRecvTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kClientSend: {
-      auto typed_task = orig_task.template Cast<ClientSendTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kRegisterMemory: {
-      auto typed_task = orig_task.template Cast<RegisterMemoryTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kRestartContainers: {
-      auto typed_task = orig_task.template Cast<RestartContainersTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kAddNode: {
-      auto typed_task = orig_task.template Cast<AddNodeTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kChangeAddressTable: {
-      auto typed_task = orig_task.template Cast<ChangeAddressTableTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kMigrateContainers: {
-      auto typed_task = orig_task.template Cast<MigrateContainersTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kHeartbeat: {
-      auto typed_task = orig_task.template Cast<HeartbeatTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kHeartbeatProbe: {
-      auto typed_task = orig_task.template Cast<HeartbeatProbeTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kProbeRequest: {
-      auto typed_task = orig_task.template Cast<ProbeRequestTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kRecoverContainers: {
-      auto typed_task = orig_task.template Cast<RecoverContainersTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kSystemMonitor: {
-      auto typed_task = orig_task.template Cast<SystemMonitorTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kAnnounceShutdown: {
-      auto typed_task = orig_task.template Cast<AnnounceShutdownTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kRegisterGpuContainer: {
-      auto typed_task = orig_task.template Cast<RegisterGpuContainerTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    default: {
-      orig_task->Aggregate(replica_task);
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->aggregate_(orig_task, replica_task);
+  } else {
+    orig_task->Aggregate(replica_task);
   }
 }
 
 void Runtime::DelTask(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr) {
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->del_(task_ptr);
+    return;
+  }
   auto* ipc_manager = CHI_IPC;
   if (!ipc_manager) return;
-  switch (method) {
-    case Method::kCreate: {
-      ipc_manager->DelTask(task_ptr.template Cast<CreateTask>());
-      break;
-    }
-    case Method::kDestroy: {
-      ipc_manager->DelTask(task_ptr.template Cast<DestroyTask>());
-      break;
-    }
-    case Method::kMonitor: {
-      ipc_manager->DelTask(task_ptr.template Cast<MonitorTask>());
-      break;
-    }
-    case Method::kGetOrCreatePool: {
-      ipc_manager->DelTask(task_ptr.template Cast<admin::GetOrCreatePoolTask<admin::CreateParams>>());
-      break;
-    }
-    case Method::kDestroyPool: {
-      ipc_manager->DelTask(task_ptr.template Cast<DestroyPoolTask>());
-      break;
-    }
-    case Method::kStopRuntime: {
-      ipc_manager->DelTask(task_ptr.template Cast<StopRuntimeTask>());
-      break;
-    }
-    case Method::kFlush: {
-      ipc_manager->DelTask(task_ptr.template Cast<FlushTask>());
-      break;
-    }
-    case Method::kSend: {
-      ipc_manager->DelTask(task_ptr.template Cast<SendTask>());
-      break;
-    }
-    case Method::kRecv: {
-      ipc_manager->DelTask(task_ptr.template Cast<RecvTask>());
-      break;
-    }
-    case Method::kClientConnect: {
-      ipc_manager->DelTask(task_ptr.template Cast<ClientConnectTask>());
-      break;
-    }
-    case Method::kSubmitBatch: {
-      ipc_manager->DelTask(task_ptr.template Cast<SubmitBatchTask>());
-      break;
-    }
-    case Method::kWreapDeadIpcs: {
-      ipc_manager->DelTask(task_ptr.template Cast<WreapDeadIpcsTask>());
-      break;
-    }
-    case Method::kClientRecv: {
-      ipc_manager->DelTask(task_ptr.template Cast<ClientRecvTask>());
-      break;
-    }
-    case Method::kClientSend: {
-      ipc_manager->DelTask(task_ptr.template Cast<ClientSendTask>());
-      break;
-    }
-    case Method::kRegisterMemory: {
-      ipc_manager->DelTask(task_ptr.template Cast<RegisterMemoryTask>());
-      break;
-    }
-    case Method::kRestartContainers: {
-      ipc_manager->DelTask(task_ptr.template Cast<RestartContainersTask>());
-      break;
-    }
-    case Method::kAddNode: {
-      ipc_manager->DelTask(task_ptr.template Cast<AddNodeTask>());
-      break;
-    }
-    case Method::kChangeAddressTable: {
-      ipc_manager->DelTask(task_ptr.template Cast<ChangeAddressTableTask>());
-      break;
-    }
-    case Method::kMigrateContainers: {
-      ipc_manager->DelTask(task_ptr.template Cast<MigrateContainersTask>());
-      break;
-    }
-    case Method::kHeartbeat: {
-      ipc_manager->DelTask(task_ptr.template Cast<HeartbeatTask>());
-      break;
-    }
-    case Method::kHeartbeatProbe: {
-      ipc_manager->DelTask(task_ptr.template Cast<HeartbeatProbeTask>());
-      break;
-    }
-    case Method::kProbeRequest: {
-      ipc_manager->DelTask(task_ptr.template Cast<ProbeRequestTask>());
-      break;
-    }
-    case Method::kRecoverContainers: {
-      ipc_manager->DelTask(task_ptr.template Cast<RecoverContainersTask>());
-      break;
-    }
-    case Method::kSystemMonitor: {
-      ipc_manager->DelTask(task_ptr.template Cast<SystemMonitorTask>());
-      break;
-    }
-    case Method::kAnnounceShutdown: {
-      ipc_manager->DelTask(task_ptr.template Cast<AnnounceShutdownTask>());
-      break;
-    }
-    case Method::kRegisterGpuContainer: {
-      ipc_manager->DelTask(task_ptr.template Cast<RegisterGpuContainerTask>());
-      break;
-    }
-    default: {
-      ipc_manager->DelTask(task_ptr);
-      break;
-    }
-  }
+  ipc_manager->DelTask(task_ptr);
 }
 
 } // namespace chimaera::admin
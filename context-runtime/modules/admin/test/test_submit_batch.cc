@@ -200,6 +200,13 @@ TEST_CASE("SubmitBatch Multiple Tasks", "[submit_batch][admin]") {
     // Verify results
     REQUIRE(submit_task->GetReturnCode() == 0);
     REQUIRE(submit_task->tasks_completed_ == num_tasks);
+
+    // Every sub-task reports its own completion
+    REQUIRE(submit_task->return_codes_.size() == num_tasks);
+    for (chi::u32 rc : submit_task->return_codes_) {
+      REQUIRE(rc == 0);
+    }
+    REQUIRE(!submit_task->serialized_out_.empty());
   }
 }
 
@@ -2,6 +2,7 @@
 #define CHIMAERA_BDEV_AUTOGEN_METHODS_H_
 
 #include <chimaera/chimaera.h>
+#include <chimaera/method_traits.h>
 #include <string>
 #include <vector>
 
@@ -43,6 +44,31 @@ inline const std::vector<std::string>& GetMethodNames() {
   }();
   return names;
 }
+
+/** Per-method traits indexed by method ID (see chimaera_mod.yaml) */
+inline constexpr chi::MethodTraits kMethodTraits[16] = {
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 0: Create
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 1: Destroy
+    {},  // 2
+    {},  // 3
+    {},  // 4
+    {},  // 5
+    {},  // 6
+    {},  // 7
+    {},  // 8
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 9: Monitor
+    {chi::MethodRoute::kDefault, chi::kMethodDefined | chi::kMethodGpu, 0},  // 10: AllocateBlocks
+    {chi::MethodRoute::kDefault, chi::kMethodDefined | chi::kMethodGpu, 0},  // 11: FreeBlocks
+    {chi::MethodRoute::kDefault, chi::kMethodDefined | chi::kMethodGpu, 0},  // 12: Write
+    {chi::MethodRoute::kDefault, chi::kMethodDefined | chi::kMethodGpu, 0},  // 13: Read
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 14: GetStats
+    {chi::MethodRoute::kDefault, chi::kMethodDefined | chi::kMethodGpu, 0},  // 15: Update
+};
+
+/** @return Traits of a method, or chi::kNoMethodTraits if unknown */
+constexpr const chi::MethodTraits& GetMethodTraits(chi::u32 method) {
+  return method < 16 ? kMethodTraits[method] : chi::kNoMethodTraits;
+}
 }  // namespace Method
 
 }  // namespace chimaera::bdev
@@ -154,6 +154,31 @@ class Client : public chi::ContainerClient {
     return ipc_manager->Send(task);
   }
 
+  /**
+   * Write scattered pieces of a buffer to blocks - asynchronous
+   * Block i is written from data + data_offsets[i], so blocks that the
+   * caller's buffer interleaves with other targets still share one task
+   * @param pool_query Pool query for routing
+   * @param blocks Blocks to write to
+   * @param data_offsets Byte offset of each block's data within data
+   * @param data ShmPtr to data buffer
+   * @param span Bytes of data covering every block's piece
+   * @return Future for the write task
+   */
+  chi::Future<chimaera::bdev::WriteTask> AsyncWrite(
+      const chi::PoolQuery& pool_query,
+      const chi::priv::vector<Block>& blocks,
+      const chi::priv::vector<chi::u64>& data_offsets, hipc::ShmPtr<> data,
+      size_t span) {
+    auto* ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<chimaera::bdev::WriteTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, blocks, data_offsets, data,
+        span);
+
+    return ipc_manager->Send(task);
+  }
+
   /**
    * Read data from blocks - asynchronous
    * @param pool_query Pool query for routing
@@ -174,6 +199,31 @@ class Client : public chi::ContainerClient {
     return ipc_manager->Send(task);
   }
 
+  /**
+   * Read blocks into scattered pieces of a buffer - asynchronous
+   * Block i is read into data + data_offsets[i] (see the scattered
+   * AsyncWrite)
+   * @param pool_query Pool query for routing
+   * @param blocks Blocks to read from
+   * @param data_offsets Byte offset of each block's data within data
+   * @param data ShmPtr to output data buffer
+   * @param span Bytes of data covering every block's piece
+   * @return Future for the read task
+   */
+  chi::Future<chimaera::bdev::ReadTask> AsyncRead(
+      const chi::PoolQuery& pool_query,
+      const chi::priv::vector<Block>& blocks,
+      const chi::priv::vector<chi::u64>& data_offsets, hipc::ShmPtr<> data,
+      size_t span) {
+    auto* ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<chimaera::bdev::ReadTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, blocks, data_offsets, data,
+        span);
+
+    return ipc_manager->Send(task);
+  }
+
   /**
    * Update GPU container with device/pinned memory pointers - asynchronous.
    * The CPU runtime fills in the actual pointers; callers pass zeros.
@@ -39,10 +39,15 @@
 #include "bdev_client.h"
 #include "bdev_tasks.h"
 #include <hermes_shm/io/async_io_factory.h>
+#include <array>
 #include <vector>
-#include <list>
 #include <atomic>
 #include <chrono>
+#include <map>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <utility>
 
 /**
  * Runtime container for bdev ChiMod
@@ -60,12 +65,21 @@ namespace chimaera::bdev {
 struct WorkerIOContext {
   std::unique_ptr<hshm::AsyncIO> async_io_;  /**< Async I/O backend for this worker */
   bool is_initialized_ = false;              /**< Whether this context is initialized */
+  chi::u64 shm_epoch_ = 0;  /**< IpcManager unmap epoch of the registered buffers */
+  std::vector<char *> bounce_free_;  /**< Idle direct I/O bounce buffers */
+
+  /** Bytes in each direct I/O bounce buffer */
+  static constexpr size_t kBounceBufferSize = 1024 * 1024;
+  /** Idle bounce buffers kept per worker; extra ones are freed on release */
+  static constexpr size_t kMaxIdleBounceBuffers = 16;
 
   WorkerIOContext() = default;
 
   WorkerIOContext(WorkerIOContext &&other) noexcept
       : async_io_(std::move(other.async_io_)),
-        is_initialized_(other.is_initialized_) {
+        is_initialized_(other.is_initialized_),
+        shm_epoch_(other.shm_epoch_),
+        bounce_free_(std::move(other.bounce_free_)) {
     other.is_initialized_ = false;
   }
 
@@ -74,6 +88,8 @@ struct WorkerIOContext {
       Cleanup();
       async_io_ = std::move(other.async_io_);
       is_initialized_ = other.is_initialized_;
+      shm_epoch_ = other.shm_epoch_;
+      bounce_free_ = std::move(other.bounce_free_);
       other.is_initialized_ = false;
     }
     return *this;
@@ -86,16 +102,33 @@ struct WorkerIOContext {
    * Initialize the worker I/O context
    * @param file_path Path to the file to open
    * @param io_depth Maximum number of concurrent I/O operations
+   * @param io_opts Async I/O backend options
+   * @param backend Async I/O backend (kDefault picks the platform's best)
    * @param worker_id Worker ID for logging
    * @return true if initialization successful, false otherwise
    */
-  bool Init(const std::string &file_path, chi::u32 io_depth, chi::u32 worker_id);
+  bool Init(const std::string &file_path, chi::u32 io_depth,
+            const hshm::AsyncIoOptions &io_opts,
+            hshm::AsyncIoBackend backend, chi::u32 worker_id);
 
   /**
    * Cleanup and close all resources
    */
   void Cleanup();
 
+  /**
+   * Take a bounce buffer of kBounceBufferSize bytes, aligned for O_DIRECT
+   * and locked in memory. Buffers are reused across tasks.
+   * @return Buffer, or nullptr if allocation failed
+   */
+  char *AcquireBounceBuffer();
+
+  /**
+   * Return a buffer obtained from AcquireBounceBuffer
+   * @param buf Buffer to release
+   */
+  void ReleaseBounceBuffer(char *buf);
+
   ~WorkerIOContext() {
     Cleanup();
   }
@@ -104,88 +137,153 @@ struct WorkerIOContext {
 
 /**
  * Block size categories for data allocator
- * We cache the following block sizes: 256B, 1KB, 4KB, 64KB, 128KB, 1MB
+ * We cache the following block sizes: 4KB, 16KB, 32KB, 64KB, 128KB, 1MB,
+ * 4MB, 16MB
  */
 enum class BlockSizeCategory : chi::u32 {
-  k256B = 0,
-  k1KB = 1,
-  k4KB = 2,
+  k4KB = 0,
+  k16KB = 1,
+  k32KB = 2,
   k64KB = 3,
   k128KB = 4,
   k1MB = 5,
-  kMaxCategories = 6
+  k4MB = 6,
+  k16MB = 7,
+  kMaxCategories = 8
 };
 
 /**
- * Per-worker block cache
- * Maintains free lists for different block sizes without locking
+ * Free-list node holding one cached block. Nodes are linked by arena index
+ * rather than pointer so the global stacks can tag their heads against ABA.
  */
-class WorkerBlockMap {
+struct BlockNode {
+  Block block_;
+  std::atomic<chi::u32> next_;  // Arena index of the next node
+
+  BlockNode() : next_(0) {}
+};
+
+/**
+ * Grow-only arena of free-list nodes addressed by 32-bit index.
+ * Chunks are never released while the arena is alive, so an index read by
+ * a racing pop always refers to valid memory.
+ */
+class BlockNodeArena {
  public:
-  WorkerBlockMap();
+  static constexpr chi::u32 kNullNode = 0xFFFFFFFFu;
+  static constexpr chi::u32 kChunkNodes = 4096;
+  static constexpr chi::u32 kMaxChunks = 4096;
+
+  BlockNodeArena();
+  ~BlockNodeArena();
+
+  BlockNodeArena(const BlockNodeArena &) = delete;
+  BlockNodeArena &operator=(const BlockNodeArena &) = delete;
 
   /**
-   * Allocate a block from the cache
-   * @param block_type Block size category index
-   * @param block Output block to populate
-   * @return true if allocation succeeded, false if cache is empty
+   * Allocate a new chunk of kChunkNodes nodes
+   * @return Index of the chunk's first node, or kNullNode if the arena is full
    */
-  bool AllocateBlock(int block_type, Block& block);
+  chi::u32 AllocateChunk();
 
   /**
-   * Free a block back to the cache
-   * @param block Block to free
+   * Get a node by index
+   * @param idx Node index returned by AllocateChunk or a stack
+   * @return Reference to the node
    */
-  void FreeBlock(Block block);
+  BlockNode &Get(chi::u32 idx) {
+    return chunks_[idx / kChunkNodes].load(std::memory_order_acquire)
+        [idx % kChunkNodes];
+  }
 
  private:
-  std::vector<std::list<Block>> blocks_;
+  std::atomic<BlockNode *> chunks_[kMaxChunks];
+  std::atomic<chi::u32> num_chunks_;
 };
 
 /**
- * Global block map with per-worker caching and locking
+ * Lock-free LIFO of arena nodes (Treiber stack)
+ * The head packs a 32-bit modification tag above the top node's index.
  */
-class GlobalBlockMap {
+class BlockNodeStack {
  public:
-  GlobalBlockMap();
+  BlockNodeStack();
 
   /**
-   * Initialize with number of workers
-   * @param num_workers Number of worker threads
+   * Push a pre-linked chain of nodes with a single CAS
+   * @param arena Arena owning the nodes
+   * @param first First node of the chain
+   * @param last Last node of the chain (its next_ is overwritten)
    */
-  void Init(size_t num_workers);
+  void PushChain(BlockNodeArena &arena, chi::u32 first, chi::u32 last);
 
   /**
-   * Allocate a block for a given worker
-   * @param worker Worker ID
-   * @param io_size Requested I/O size
-   * @param block Output block to populate
-   * @return true if allocation succeeded, false otherwise
+   * Pop the top node
+   * @param arena Arena owning the nodes
+   * @return Node index, or BlockNodeArena::kNullNode if empty
    */
-  bool AllocateBlock(int worker, size_t io_size, Block& block);
+  chi::u32 Pop(BlockNodeArena &arena);
+
+ private:
+  std::atomic<chi::u64> head_;
+};
+
+/**
+ * Per-worker block cache
+ * Intrusive free stacks, one per block size plus one of spare nodes. Only
+ * the owning worker touches them, so no locking is needed; the map is
+ * aligned to a cache line so neighbouring workers do not false-share.
+ */
+class alignas(64) WorkerBlockMap {
+ public:
+  /** Stack index holding nodes that carry no block */
+  static constexpr int kSpareList =
+      static_cast<int>(BlockSizeCategory::kMaxCategories);
+  static constexpr int kNumLists = kSpareList + 1;
+
+  WorkerBlockMap();
 
   /**
-   * Free a block for a given worker
-   * @param worker Worker ID
-   * @param block Block to free
-   * @return true if free succeeded
+   * Pop a node from one of the stacks
+   * @param arena Arena owning the nodes
+   * @param list Block size category or kSpareList
+   * @return Node index, or BlockNodeArena::kNullNode if the stack is empty
    */
-  bool FreeBlock(int worker, Block& block);
+  chi::u32 Pop(BlockNodeArena &arena, int list);
 
- private:
-  std::vector<WorkerBlockMap> worker_maps_;
-  std::vector<chi::CoMutex> worker_locks_;
+  /**
+   * Push a node onto one of the stacks
+   * @param arena Arena owning the nodes
+   * @param list Block size category or kSpareList
+   * @param idx Node index
+   */
+  void Push(BlockNodeArena &arena, int list, chi::u32 idx);
 
   /**
-   * Find the next block size category larger than the requested size
-   * @param io_size Requested I/O size
-   * @return Block type index, or -1 if no suitable size
+   * Unlink the top count nodes of a stack as a chain
+   * @param arena Arena owning the nodes
+   * @param list Block size category or kSpareList
+   * @param count Number of nodes to unlink (must not exceed Count(list))
+   * @param last Output: last node of the chain
+   * @return First node of the chain
    */
-  int FindBlockType(size_t io_size);
+  chi::u32 DetachChain(BlockNodeArena &arena, int list, chi::u32 count,
+                       chi::u32 &last);
+
+  /** Number of nodes on a stack */
+  chi::u32 Count(int list) const { return counts_[list]; }
+
+ private:
+  chi::u32 heads_[kNumLists];
+  chi::u32 counts_[kNumLists];
 };
 
 /**
- * Heap allocator for new blocks
+ * Free-space manager for new blocks
+ * Space below the bump pointer that has been returned is kept as an extent
+ * tree. Adjacent extents are coalesced when freed regardless of the block
+ * size they came from, and extents that reach the bump pointer lower it.
+ * Allocation takes the smallest free extent that fits before bumping.
  */
 class Heap {
  public:
@@ -195,8 +293,12 @@ class Heap {
    * Initialize heap with total size and alignment
    * @param total_size Total size available for allocation
    * @param alignment Alignment requirement for offsets and sizes (default 4096)
+   * @param base Device offset of the heap's first byte (default 0)
+   * @param stripe PFS stripe size, 0 for none. Blocks of a stripe or more
+   * then fill whole stripes and smaller ones stay within one stripe
    */
-  void Init(chi::u64 total_size, chi::u32 alignment = 4096);
+  void Init(chi::u64 total_size, chi::u32 alignment = 4096,
+            chi::u64 base = 0, chi::u64 stripe = 0);
 
   /**
    * Allocate a block from the heap
@@ -207,18 +309,158 @@ class Heap {
    */
   bool Allocate(size_t block_size, int block_type, Block& block);
 
+  /**
+   * Return a block to the heap, coalescing it with neighbouring free space
+   * @param block Block to free
+   */
+  void Free(const Block& block);
+
   /**
    * Get remaining allocatable space
-   * @return Number of bytes remaining for allocation
+   * @return Bytes above the bump pointer plus bytes in free extents
    */
   chi::u64 GetRemainingSize() const;
 
+  /**
+   * Get the number of free extents below the bump pointer
+   * @return Free extent count
+   */
+  size_t GetFreeExtentCount();
+
  private:
+  hshm::Mutex lock_;
+  std::map<chi::u64, chi::u64> free_extents_;            // offset -> size
+  std::set<std::pair<chi::u64, chi::u64>> free_by_size_;  // (size, offset)
   std::atomic<chi::u64> heap_;
+  std::atomic<chi::u64> free_bytes_;
+  chi::u64 base_;
   chi::u64 total_size_;
   chi::u32 alignment_;
+  chi::u64 stripe_;  // PFS stripe size, 0 if allocations ignore stripes
+
+  /** Free extents checked for a stripe-aligned fit before bumping */
+  static constexpr int kMaxStripeFitScan = 64;
+
+  /** Round a size up to the heap alignment */
+  chi::u64 AlignSize(chi::u64 size) const;
+
+  /** Insert a free extent into both indexes (lock must be held) */
+  void InsertExtent(chi::u64 offset, chi::u64 size);
+
+  /** Remove a free extent from both indexes (lock must be held) */
+  std::map<chi::u64, chi::u64>::iterator EraseExtent(
+      std::map<chi::u64, chi::u64>::iterator it);
 };
 
+/**
+ * Global block map: per-worker caches backed by a lock-free overflow pool
+ * Workers allocate and free small blocks through their own cache. Caches
+ * spill to the overflow pool when full and refill from it when empty, which
+ * is also how blocks freed on one worker reach another. Blocks of 1MB and
+ * up, and all blocks of threads outside the worker pool, go straight to the
+ * overflow pool so no worker hoards large capacity.
+ */
+class GlobalBlockMap {
+ public:
+  /** First block size category that is never cached per worker */
+  static constexpr int kFirstSharedType =
+      static_cast<int>(BlockSizeCategory::k1MB);
+  /** Cached blocks per size kept by a worker before spilling half */
+  static constexpr chi::u32 kMaxCachedBlocks = 64;
+  /** Spare nodes kept by a worker before returning half to the pool */
+  static constexpr chi::u32 kMaxSpareNodes = 1024;
+
+  GlobalBlockMap();
+
+  /**
+   * Initialize with number of workers
+   * @param num_workers Number of worker threads
+   * @param heap Heap that receives blocks the cache cannot hold
+   */
+  void Init(size_t num_workers, Heap *heap);
+
+  /**
+   * Allocate a block for a given worker
+   * @param worker Worker ID (-1 for threads outside the worker pool)
+   * @param io_size Requested I/O size
+   * @param block Output block to populate
+   * @return true if allocation succeeded, false otherwise
+   */
+  bool AllocateBlock(int worker, size_t io_size, Block& block);
+
+  /**
+   * Free a block for a given worker. The block is split into cached block
+   * sizes, so merged or trimmed extents can be freed as well.
+   * @param worker Worker ID (-1 for threads outside the worker pool)
+   * @param block Block to free
+   * @return true if every piece of the block was cached
+   */
+  bool FreeBlock(int worker, Block& block);
+
+  /**
+   * Return cached blocks to the heap so they can coalesce across sizes.
+   * Drains the shared overflow pool and the calling worker's own cache;
+   * other workers' caches are left alone since only their owner may touch
+   * them.
+   * @param worker Worker ID (-1 for threads outside the worker pool)
+   * @return Number of bytes returned to the heap
+   */
+  chi::u64 Reclaim(int worker);
+
+  /** Bytes currently held in caches and the overflow pool */
+  chi::u64 GetCachedBytes() const {
+    return cached_bytes_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  Heap *heap_;
+  std::atomic<chi::u64> cached_bytes_;
+  BlockNodeArena arena_;
+  std::vector<WorkerBlockMap> worker_maps_;
+  BlockNodeStack overflow_[static_cast<int>(BlockSizeCategory::kMaxCategories)];
+  BlockNodeStack spare_nodes_;
+
+  /**
+   * Find the next block size category larger than the requested size
+   * @param io_size Requested I/O size
+   * @return Block type index, or -1 if no suitable size
+   */
+  int FindBlockType(size_t io_size);
+
+  /**
+   * Get the calling worker's cache
+   * @param worker Worker ID
+   * @return Cache pointer, or nullptr for threads outside the worker pool
+   */
+  WorkerBlockMap *GetWorkerMap(int worker);
+
+  /**
+   * Get a node with no block attached
+   * @param local Calling worker's cache, or nullptr
+   * @return Node index, or BlockNodeArena::kNullNode if the arena is full
+   */
+  chi::u32 AcquireNode(WorkerBlockMap *local);
+
+  /**
+   * Return a node whose block was handed out
+   * @param local Calling worker's cache, or nullptr
+   * @param idx Node index
+   */
+  void ReleaseNode(WorkerBlockMap *local, chi::u32 idx);
+
+  /**
+   * Cache one block whose size is exactly a category size
+   * @param local Calling worker's cache, or nullptr
+   * @param block_type Block size category
+   * @param block Block to cache
+   * @return false if no node could be obtained
+   */
+  bool CacheBlock(WorkerBlockMap *local, int block_type, const Block &block);
+};
+
+/** Run of file-adjacent blocks submitted as one I/O (see bdev_runtime.cc) */
+struct IoExtent;
+
 /**
  * Runtime container for bdev operations
  */
@@ -373,28 +615,89 @@ class Runtime : public chi::Container {
   // Storage backend configuration
   BdevType bdev_type_;                            // Backend type (file or RAM)
 
-  // File-based storage (kFile)
+  // File-based storage (kFile, and kNvme on the namespace char device)
   std::string file_path_;                         // Path to the file (for per-worker FD creation)
   std::vector<WorkerIOContext> worker_io_contexts_;  // Per-worker I/O contexts
   chi::u64 file_size_;                            // Total file size
   chi::u32 alignment_;                            // I/O alignment requirement
   chi::u32 io_depth_;                             // Max concurrent I/O operations
+  hshm::AsyncIoOptions io_opts_;                  // Async I/O backend options
+  hshm::AsyncIoBackend io_backend_ = hshm::AsyncIoBackend::kDefault;  // kNvme: passthrough
+  bool direct_io_ = false;                        // Bounce unaligned I/O to O_DIRECT
   chi::u32 max_blocks_per_operation_;             // Maximum blocks per I/O operation
 
+  // Parallel file system mode (kFile with pfs_). Blocks are stripe-aligned,
+  // and writes covering part of a stripe are staged until it fills
+  bool pfs_ = false;
+  chi::u64 stripe_size_ = 0;                      // Bytes per stripe
+  chi::u32 stripe_count_ = 1;                     // Servers striped over
+  chi::u64 region_base_ = 0;                      // Start of this node's region
+  chi::u32 pfs_max_staged_ = 16;                  // Staged stripes before evicting
+  chi::u64 pfs_flush_ns_ = 0;                     // Age flushed by GetStats
+
+  /** A stripe whose writes so far cover only part of it */
+  struct StagedStripe {
+    char *data_ = nullptr;                 // stripe_size_ bytes, sector aligned
+    std::map<chi::u64, chi::u64> dirty_;   // Written ranges: begin -> end
+    chi::u64 dirty_bytes_ = 0;             // Bytes covered by dirty_
+    chi::u64 staged_ns_ = 0;               // When the first write was staged
+    bool flushing_ = false;                // Being written; writers must wait
+
+    ~StagedStripe() { free(data_); }
+
+    /**
+     * Record a write of [begin, end) in the stripe
+     * @return Bytes of the range that were not dirty yet
+     */
+    chi::u64 MarkDirty(chi::u64 begin, chi::u64 end);
+  };
+  std::unordered_map<chi::u64, std::unique_ptr<StagedStripe>>
+      staged_stripes_;                            // Stripe index -> staged data
+  hshm::Mutex stage_lock_;                        // Guards staged_stripes_
+  std::atomic<chi::u64> staged_bytes_{0};         // Dirty bytes not yet written
+  std::atomic<chi::u64> stripe_writes_{0};        // Staged stripes written out
+  std::atomic<chi::u64> stripe_fills_{0};         // ... that read the rest first
+
   // RAM-based storage (kRam)
   char* ram_buffer_;                              // RAM storage buffer
   chi::u64 ram_size_;                            // Total RAM buffer size
+  size_t ram_mapped_size_ = 0;                    // Bytes mapped for ram_buffer_
+  hshm::File ram_fd_;                             // Segment of ram_buffer_ (shared_)
+  std::string ram_segment_;                       // Its name, empty if private
+
+  /** One NUMA node's slice of a node-local kRam buffer */
+  struct RamNode {
+    GlobalBlockMap block_map_;  // Block cache of this slice
+    Heap heap_;                 // Free space of this slice
+    chi::u64 base_ = 0;         // Offset of the slice in ram_buffer_
+    chi::u64 size_ = 0;         // Bytes in the slice
+  };
+  std::vector<std::unique_ptr<RamNode>> ram_nodes_;  // Empty unless kNodeLocal
 
   // GPU HBM storage (kHbm) — device memory via cudaMalloc
   char* hbm_buffer_;
   chi::u64 hbm_size_;
+  int hbm_device_ = 0;                      // GPU holding hbm_buffer_
+  std::atomic<chi::u64> peer_bytes_{0};     // Bytes copied GPU-to-GPU
 
   // Pinned host storage (kPinned) — pinned memory via cudaMallocHost
   char* pinned_buffer_;
   chi::u64 pinned_size_;
 
+  // GPUDirect Storage (kGds) — file_path_ opened O_DIRECT and registered with
+  // cuFile. cuFile types stay opaque so the layout is the same in every build
+  int gds_fd_ = -1;
+  void *gds_handle_ = nullptr;                   // CUfileHandle_t
+  bool gds_driver_open_ = false;                 // Holds a cuFileDriverOpen ref
+  std::vector<void *> gds_batches_;              // Idle CUfileBatchHandle_t
+  hshm::Mutex gds_lock_;                         // Guards gds_batches_
+  /** Max I/Os per cuFileBatchIOSubmit (cuFile's default batch limit) */
+  static constexpr chi::u32 kGdsBatchMax = 128;
+  /** Smaller transfers use cuFile's internal bounce buffers unregistered */
+  static constexpr chi::u64 kGdsRegisterMinBytes = 1024 * 1024;
+
   // New allocator components
-  GlobalBlockMap global_block_map_;              // Global block cache with per-worker locking
+  GlobalBlockMap global_block_map_;              // Global block cache (per-worker, lock-free)
   Heap heap_;                                     // Heap allocator for new blocks
 
   // Performance tracking
@@ -402,16 +705,155 @@ class Runtime : public chi::Container {
   std::atomic<chi::u64> total_writes_;
   std::atomic<chi::u64> total_bytes_read_;
   std::atomic<chi::u64> total_bytes_written_;
+  std::atomic<chi::u64> inflight_bytes_{0};  // Bytes of running Write/Read tasks
+  std::atomic<chi::u32> inflight_ios_{0};    // Running Write/Read tasks
   std::chrono::high_resolution_clock::time_point start_time_;
   
-  // User-provided performance characteristics
+  // Performance characteristics: configured, calibrated, or defaults that
+  // completed file I/O replaces with moving averages
   PerfMetrics perf_metrics_;
+  bool perf_metrics_user_ = false;  // Configured: never overwritten
+  chi::u32 perf_measured_ = 0;      // kPerf* bits holding measured values
+  hshm::Mutex perf_lock_;           // Guards the two fields above
+
+  /** perf_measured_ bits, one per PerfMetrics field */
+  static constexpr chi::u32 kPerfReadBw = 1u << 0;
+  static constexpr chi::u32 kPerfWriteBw = 1u << 1;
+  static constexpr chi::u32 kPerfReadLat = 1u << 2;
+  static constexpr chi::u32 kPerfWriteLat = 1u << 3;
+  static constexpr chi::u32 kPerfIops = 1u << 4;
+  static constexpr chi::u32 kPerfAll = (1u << 5) - 1;
+  /** Weight of a new sample in the moving averages */
+  static constexpr double kPerfEwmaWeight = 0.05;
+  /** Transfers up to this size are latency samples */
+  static constexpr chi::u64 kPerfLatencyMaxBytes = 64 * 1024;
+  /** Transfers of at least this size are bandwidth samples */
+  static constexpr chi::u64 kPerfBandwidthMinBytes = 1024 * 1024;
+
+  /** One completed I/O kept for fitting perf_model_ */
+  struct PerfSample {
+    double size_mb_;
+    double depth_;
+    double elapsed_us_;
+  };
+  /** Recent samples per direction (0 = read, 1 = write), ring of kModelSamples */
+  std::vector<PerfSample> model_samples_[2];
+  size_t model_next_[2] = {0, 0};        // Next ring slot to overwrite
+  chi::u32 model_unfit_[2] = {0, 0};     // Samples since the last fit
+  bool model_fitting_ = false;           // A refit is running
+  PerfModel perf_model_;                 // Guarded by perf_lock_
+  /** Samples kept per direction */
+  static constexpr size_t kModelSamples = 256;
+  /** New samples that trigger a refit */
+  static constexpr chi::u32 kModelRefitSamples = 64;
+  /** Samples needed before the first fit */
+  static constexpr size_t kModelMinSamples = 32;
+  /** Largest to smallest sampled size needed to separate the two terms */
+  static constexpr double kModelMinSpread = 4.0;
+
+  /**
+   * Blend one completed file I/O into perf_metrics_. The first sample of a
+   * field replaces the default estimate. No-op if the metrics were
+   * configured.
+   * @param is_write Whether the I/O was a write
+   * @param bytes Bytes transferred
+   * @param elapsed_us Time from submission to completion
+   */
+  void RecordIoSample(bool is_write, chi::u64 bytes, double elapsed_us);
+
+  /**
+   * Refit the curves of perf_model_ whose directions gathered
+   * kModelRefitSamples since their last fit, using NonlinearLeastSquares on
+   * a copy of the samples taken outside perf_lock_
+   * @return The current model
+   */
+  PerfModel GetPerfModel();
+
+  /**
+   * Fit a curve to completed I/Os of one direction with Levenberg-Marquardt,
+   * minimizing relative error so small and large transfers weigh alike
+   * @param samples Completed I/Os
+   * @param curve Replaced by the fit on success
+   * @return true if the samples span enough sizes and the fit is usable
+   */
+  static bool FitPerfCurve(const std::vector<PerfSample> &samples,
+                           PerfCurve &curve);
+
+  /**
+   * Metrics for GetStats/Monitor: configured or measured fields as held,
+   * the others from the learned wall-clock model
+   * @return Reported performance characteristics
+   */
+  PerfMetrics GetReportedMetrics();
   
   /**
    * Initialize the data allocator
    */
   void InitializeAllocator();
 
+  /**
+   * Allocate one block for a piece of an allocation request. A node-local
+   * kRam device tries the calling worker's NUMA node first, then the others.
+   * @param worker_id Worker ID (-1 for threads outside the worker pool)
+   * @param io_size Size of the piece
+   * @param block Output block
+   * @return true if allocation succeeded
+   */
+  bool AllocateIoPiece(int worker_id, size_t io_size, Block& block);
+
+  /**
+   * Allocate one block from a block cache and its heap. Tries the cache,
+   * then the heap, and finally reclaims cached blocks into the heap and
+   * retries.
+   * @param block_map Block cache
+   * @param heap Heap backing block_map
+   * @param worker_id Worker ID (-1 for threads outside the worker pool)
+   * @param io_size Size of the piece
+   * @param block Output block
+   * @return true if allocation succeeded
+   */
+  static bool AllocateFromHeap(GlobalBlockMap &block_map, Heap &heap,
+                               int worker_id, size_t io_size, Block &block);
+
+  /**
+   * Return a block to the cache that owns its offset. Blocks spanning
+   * node slices of a node-local kRam device are split at the boundaries.
+   * @param worker_id Worker ID (-1 for threads outside the worker pool)
+   * @param block Block to free
+   */
+  void FreeIoBlock(int worker_id, const Block &block);
+
+  /**
+   * Index in ram_nodes_ of the slice holding a device offset
+   * @param offset Offset in ram_buffer_
+   * @return Slice index (ram_nodes_ must not be empty)
+   */
+  size_t GetRamNodeIndex(chi::u64 offset) const;
+
+  /**
+   * Map ram_buffer_ with the NUMA placement and page size of params. Pages
+   * are left untouched so each is faulted in under its slice's policy.
+   * @param params Creation parameters (ram_numa_, huge_pages_, alignment_)
+   * @return true if the buffer was mapped
+   */
+  bool MapRamBuffer(const CreateParams &params);
+
+  /**
+   * Bytes that can still be allocated, including blocks sitting in caches
+   * @return Remaining capacity in bytes
+   */
+  chi::u64 GetRemainingCapacity() const {
+    if (ram_nodes_.empty()) {
+      return heap_.GetRemainingSize() + global_block_map_.GetCachedBytes();
+    }
+    chi::u64 remaining = 0;
+    for (const auto &node : ram_nodes_) {
+      remaining += node->heap_.GetRemainingSize() +
+                   node->block_map_.GetCachedBytes();
+    }
+    return remaining;
+  }
+
   /**
    * Initialize POSIX AIO control blocks
    */
@@ -444,6 +886,15 @@ class Runtime : public chi::Container {
    */
   WorkerIOContext *GetWorkerIOContext(size_t worker_id);
 
+  /**
+   * Let the worker's async I/O use fixed buffers for a task's data
+   * Registers the shared-memory segment holding data, after dropping all
+   * registrations if a segment was unmapped since the last call
+   * @param io_ctx Worker I/O context
+   * @param data Task data pointer
+   */
+  void RegisterIoBuffer(WorkerIOContext *io_ctx, const void *data);
+
   /**
    * Initialize per-worker I/O contexts
    * Called during Create to set up worker-specific file descriptors
@@ -467,6 +918,97 @@ class Runtime : public chi::Container {
   chi::TaskResume WriteToFile(hipc::FullPtr<WriteTask> task, chi::RunContext &ctx);
   chi::TaskResume ReadFromFile(hipc::FullPtr<ReadTask> task, chi::RunContext &ctx);
 
+  /**
+   * Wait for submitted async I/O, yielding between polls
+   * @param io_ctx Worker I/O context the tokens belong to
+   * @param tokens Tokens to wait for
+   * @param results Output: result per token
+   */
+  chi::TaskResume WaitIoTokens(WorkerIOContext *io_ctx,
+                               const std::vector<hshm::IoToken> &tokens,
+                               std::vector<hshm::IoResult> &results);
+
+  /**
+   * Find the stripe layout of file_path_ and claim this node's region of
+   * the shared file, growing the file to hold every node's region
+   * @param setup_io Open setup backend of the file
+   * @param params Creation parameters (pfs_*, total_size_, alignment_)
+   * @param current_size Size of the file when it was opened
+   * @return false if the file could not be grown
+   */
+  bool SetupPfs(hshm::AsyncIO *setup_io, const CreateParams &params,
+                chi::u64 current_size);
+
+  /** Outcome of TryStagePiece */
+  enum class StageResult {
+    kStaged,    // Copied into its stripe
+    kWait,      // The stripe is being written; retry after a yield
+    kEvict,     // Too many stripes staged; write out the victim and retry
+    kNoMemory,  // No buffer for a new stripe
+  };
+
+  /**
+   * Copy one piece of a write into its staged stripe, creating the stripe
+   * if there is room
+   * @param piece Extent within one stripe
+   * @param victim Output: stripe to write out first (kEvict)
+   * @param full Output: the stripe is now fully covered (kStaged)
+   * @return What happened
+   */
+  StageResult TryStagePiece(const IoExtent &piece, chi::u64 &victim,
+                            bool &full);
+
+  /**
+   * Copy pieces of a write that cover part of a stripe into the staged
+   * stripe, writing out those that become full. A new stripe beyond
+   * pfs_max_staged_ first evicts the oldest.
+   * @param io_ctx Worker I/O context
+   * @param pieces Extents that each lie within one stripe
+   * @param ok Output: false if a buffer or write-out failed
+   */
+  chi::TaskResume StageStripeWrites(WorkerIOContext *io_ctx,
+                                    const std::vector<IoExtent> &pieces,
+                                    bool &ok);
+
+  /**
+   * Write one staged stripe as a single full-stripe write, reading the
+   * bytes no write covered first. No-op if the stripe is not staged or
+   * another task is already writing it.
+   * @param io_ctx Worker I/O context
+   * @param stripe Stripe index in the file
+   * @param ok Output: false if an I/O failed (the stripe is dropped)
+   */
+  chi::TaskResume FlushStripe(WorkerIOContext *io_ctx, chi::u64 stripe,
+                              bool &ok);
+
+  /**
+   * Write out staged stripes staged at least min_age_ns ago
+   * @param io_ctx Worker I/O context
+   * @param min_age_ns Minimum age, 0 for all
+   */
+  chi::TaskResume FlushStagedStripes(WorkerIOContext *io_ctx,
+                                     chi::u64 min_age_ns);
+
+  /**
+   * Settle staged stripes that extents touch before they go to the file.
+   * Reads flush them; whole-stripe writes replace them, so they are dropped.
+   * Both wait for stripes being written out.
+   * @param io_ctx Worker I/O context
+   * @param extents Extents about to be submitted
+   * @param is_write Whether the extents are whole-stripe writes
+   */
+  chi::TaskResume SettleStripes(WorkerIOContext *io_ctx,
+                                const std::vector<IoExtent> &extents,
+                                bool is_write);
+
+  /**
+   * @return true if the worker's unaligned file I/O is bounced so that every
+   * transfer uses O_DIRECT
+   */
+  bool UseDirectIo(WorkerIOContext *io_ctx) const {
+    return direct_io_ && io_ctx->async_io_->SupportsDirectIo();
+  }
+
   /**
    * Backend-specific RAM operations (synchronous, no coroutine needed)
    */
@@ -480,6 +1022,13 @@ class Runtime : public chi::Container {
   chi::TaskResume WriteToHbm(hipc::FullPtr<WriteTask> task, chi::RunContext &ctx);
   chi::TaskResume ReadFromHbm(hipc::FullPtr<ReadTask> task, chi::RunContext &ctx);
 
+  /**
+   * Record the HBM buffer's device and enable peer access between it and
+   * every GPU that can reach it, so remote-device reads and writes move
+   * over NVLink/PCIe instead of through the host
+   */
+  void EnableHbmPeerAccess();
+
   /**
    * Backend-specific pinned-host-memory operations (async cudaMemcpyAsync)
    * Uses cudaMemcpyAsync + cudaStreamQuery polling with coroutine yield.
@@ -487,6 +1036,68 @@ class Runtime : public chi::Container {
   chi::TaskResume WriteToPinned(hipc::FullPtr<WriteTask> task, chi::RunContext &ctx);
   chi::TaskResume ReadFromPinned(hipc::FullPtr<ReadTask> task, chi::RunContext &ctx);
 
+  /**
+   * Open the cuFile driver and register file_path_ with it. The file must
+   * already exist with its final size
+   * @return true if the file is ready for GPUDirect I/O
+   */
+  bool InitGds();
+
+  /**
+   * Deregister buffers and the file handle, destroy the batch handles and
+   * close the cuFile driver
+   */
+  void CleanupGds();
+
+  /**
+   * @param ptr Task data buffer
+   * @return true if ptr is CUDA device memory that cuFile can DMA to
+   */
+  static bool IsDeviceBuffer(const void *ptr);
+
+  /**
+   * Register a task's device buffer with cuFile for the length of one
+   * transfer. Buffers below kGdsRegisterMinBytes, or already registered by
+   * the caller, are left alone and go through cuFile's bounce buffers.
+   * @param ptr Device buffer
+   * @param size Bytes of the buffer the transfer touches
+   * @return true if the caller must cuFileBufDeregister ptr afterwards
+   */
+  bool RegisterGdsBuffer(const void *ptr, chi::u64 size);
+
+  /**
+   * Take an idle cuFile batch handle, or set up a new one
+   * @return CUfileBatchHandle_t, or nullptr on failure
+   */
+  void *AcquireGdsBatch();
+
+  /**
+   * Return a batch handle with no outstanding I/O to the idle pool
+   * @param batch Handle from AcquireGdsBatch
+   */
+  void ReleaseGdsBatch(void *batch);
+
+  /**
+   * Backend-specific GPUDirect Storage operations. Device buffers go to the
+   * file as cuFile batches polled with coroutine yield; host buffers take
+   * WriteToFile/ReadFromFile.
+   */
+  chi::TaskResume WriteToGds(hipc::FullPtr<WriteTask> task, chi::RunContext &ctx);
+  chi::TaskResume ReadFromGds(hipc::FullPtr<ReadTask> task, chi::RunContext &ctx);
+
+  /**
+   * Submit one cuFile batch per kGdsBatchMax I/Os and wait for all of them,
+   * yielding between polls
+   * @param data Device buffer the I/Os address
+   * @param ios (file offset, buffer offset, size) per I/O
+   * @param is_write Whether to write the file
+   * @param bytes Output: bytes transferred
+   * @param error_code Output: 0 on success
+   */
+  chi::TaskResume SubmitGdsBatches(
+      char *data, const std::vector<std::array<chi::u64, 3>> &ios,
+      bool is_write, chi::u64 &bytes, chi::u32 &error_code);
+
   /**
    * Update performance metrics
    */
@@ -60,16 +60,44 @@ enum class BdevType : chi::u32 {
   kRam = 1,     // RAM-based block device
   kHbm = 2,     // GPU High-Bandwidth Memory via cudaMalloc (device memory)
   kPinned = 3,  // Pinned host memory via cudaMallocHost
-  kNoop = 4     // No-op backend for latency testing (no actual I/O)
+  kNoop = 4,    // No-op backend for latency testing (no actual I/O)
+  kNvme = 5,    // NVMe namespace via io_uring passthrough (/dev/ngXnY)
+  kGds = 6      // File accessed with GPUDirect Storage (cuFile) from HBM
 };
 
+/**
+ * NUMA placement of a kRam device's buffer
+ */
+enum class RamNumaMode : chi::u32 {
+  kFlat = 0,        // One region with the kernel's default policy
+  kInterleave = 1,  // One region, pages interleaved across all nodes
+  kNodeLocal = 2    // One sub-heap per node, allocated near the caller
+};
+
+/**
+ * Name of the segment holding a kRam bdev's buffer when it is created with
+ * shared_, derived from the runtime's main segment so that several runtimes
+ * on one node do not collide
+ * @param pool_id Pool id of the bdev
+ * @return Shared memory object name
+ */
+inline std::string GetRamSegmentName(const chi::PoolId &pool_id) {
+  auto *config = CHI_CONFIG_MANAGER;
+  std::string base = "chimaera_main";
+  if (config && config->IsValid()) {
+    base = config->GetSharedMemorySegmentName(chi::kMainSegment);
+  }
+  return base + "_bdev_" + std::to_string(pool_id.major_) + "_" +
+         std::to_string(pool_id.minor_);
+}
+
 /**
  * Block structure for data allocation
  */
 struct Block {
   chi::u64 offset_;      // Offset within file
   chi::u64 size_;        // Size of block
-  chi::u32 block_type_;  // Block size category (0=4KB, 1=64KB, 2=256KB, 3=1MB)
+  chi::u32 block_type_;  // Block size category (see BlockSizeCategory)
 
   HSHM_GPU_FUN Block() : offset_(0), size_(0), block_type_(0) {}
   HSHM_GPU_FUN Block(chi::u64 offset, chi::u64 size, chi::u32 block_type)
@@ -108,6 +136,55 @@ struct PerfMetrics {
   }
 };
 
+/**
+ * Fitted service-time curve of one I/O direction on a device: a transfer of
+ * s MB issued while d I/Os are in flight takes
+ * (base_us_ + s * us_per_mb_) * (1 + queue_factor_ * (d - 1)) microseconds
+ */
+struct PerfCurve {
+  double base_us_;       // Fixed per-I/O cost in microseconds
+  double us_per_mb_;     // Transfer cost per MB (0 = not fitted)
+  double queue_factor_;  // Slowdown per additional in-flight I/O
+
+  HSHM_CROSS_FUN PerfCurve()
+      : base_us_(0.0), us_per_mb_(0.0), queue_factor_(0.0) {}
+
+  /** Whether the curve holds a fit */
+  HSHM_CROSS_FUN bool IsFitted() const { return us_per_mb_ > 0.0; }
+
+  /**
+   * Predict the service time of one transfer
+   * @param bytes Transfer size
+   * @param depth I/Os in flight, including this one
+   * @return Predicted time in microseconds
+   */
+  HSHM_CROSS_FUN double PredictUs(chi::u64 bytes, double depth = 1.0) const {
+    double mb = static_cast<double>(bytes) / (1024.0 * 1024.0);
+    double queue = depth > 1.0 ? 1.0 + queue_factor_ * (depth - 1.0) : 1.0;
+    return (base_us_ + mb * us_per_mb_) * queue;
+  }
+
+  // Cereal serialization
+  template <class Archive>
+  HSHM_CROSS_FUN void serialize(Archive &ar) {
+    ar(base_us_, us_per_mb_, queue_factor_);
+  }
+};
+
+/**
+ * Device model fitted from completed I/Os, one curve per direction
+ */
+struct PerfModel {
+  PerfCurve read_;
+  PerfCurve write_;
+
+  // Cereal serialization
+  template <class Archive>
+  HSHM_CROSS_FUN void serialize(Archive &ar) {
+    ar(read_, write_);
+  }
+};
+
 /**
  * Persistence level for block devices
  */
@@ -131,10 +208,40 @@ struct CreateParams {
 
   // Performance characteristics (user-defined instead of benchmarked)
   PerfMetrics perf_metrics_;  // User-provided performance characteristics
+  bool perf_metrics_user_ = false;  // perf_metrics_ set explicitly (kNvme
+                                    // benchmarks at startup otherwise)
 
   // Persistence level for this block device
   PersistenceLevel persistence_level_ = PersistenceLevel::kVolatile;
 
+  // io_uring tuning for kFile (other async I/O backends ignore it)
+  bool io_fixed_buffers_ = false;  // Pin data segments as fixed buffers
+  bool io_batch_submit_ = false;   // One submit per worker iteration
+  bool io_sqpoll_ = false;         // Kernel SQ poll thread per device
+  int io_sqpoll_cpu_ = -1;         // CPU for the SQ poll thread (-1 = any)
+
+  // kFile: keep every transfer on O_DIRECT, bouncing unaligned ones
+  bool direct_io_ = false;
+
+  // kFile: probe the device at creation to fill perf_metrics_ (kNvme always
+  // does unless perf_metrics_user_)
+  bool calibrate_ = false;
+
+  // kRam: NUMA placement and page size of the buffer
+  RamNumaMode ram_numa_ = RamNumaMode::kFlat;
+  hipc::HugePageMode huge_pages_ = hipc::HugePageMode::kNone;
+  // kRam: keep the buffer in a named segment that local clients map
+  // read-only (see GetRamSegmentName)
+  bool shared_ = false;
+
+  // kFile on a parallel file system (Lustre, GPFS): allocate and write whole
+  // stripes, each node in its own region of the shared file
+  bool pfs_ = false;
+  chi::u64 pfs_stripe_size_ = 0;   // 0 = ask the file system
+  chi::u32 pfs_stripe_count_ = 0;  // 0 = ask the file system
+  chi::u32 pfs_max_staged_ = 16;   // Partial stripes held back at once
+  chi::u32 pfs_flush_ms_ = 1000;   // Age at which a partial stripe is flushed
+
   // Required: chimod library name for module manager
   static constexpr const char *chimod_lib_name = "chimaera_bdev";
 
@@ -184,6 +291,7 @@ struct CreateParams {
     // Set performance metrics (use provided metrics or defaults)
     if (perf_metrics != nullptr) {
       perf_metrics_ = *perf_metrics;
+      perf_metrics_user_ = true;
       HLOG(kDebug,
            "DEBUG: CreateParams constructor called with custom performance: "
            "bdev_type={}, total_size={}, io_depth={}, alignment={}, "
@@ -209,7 +317,11 @@ struct CreateParams {
   // Serialization support for cereal
   template <class Archive>
   void serialize(Archive &ar) {
-    ar(bdev_type_, total_size_, io_depth_, alignment_, perf_metrics_, persistence_level_);
+    ar(bdev_type_, total_size_, io_depth_, alignment_, perf_metrics_, persistence_level_,
+       io_fixed_buffers_, io_batch_submit_, io_sqpoll_, io_sqpoll_cpu_,
+       direct_io_, perf_metrics_user_, calibrate_, ram_numa_, huge_pages_,
+       shared_, pfs_, pfs_stripe_size_, pfs_stripe_count_, pfs_max_staged_,
+       pfs_flush_ms_);
   }
 
   /**
@@ -233,6 +345,10 @@ struct CreateParams {
         bdev_type_ = BdevType::kPinned;
       } else if (type_str == "noop") {
         bdev_type_ = BdevType::kNoop;
+      } else if (type_str == "nvme") {
+        bdev_type_ = BdevType::kNvme;
+      } else if (type_str == "gds") {
+        bdev_type_ = BdevType::kGds;
       }
     }
 
@@ -252,9 +368,86 @@ struct CreateParams {
       alignment_ = config["alignment"].as<chi::u32>();
     }
 
+    // Load direct I/O mode (optional)
+    if (config["direct_io"]) {
+      direct_io_ = config["direct_io"].as<bool>();
+    }
+
+    // Load startup calibration (optional)
+    if (config["calibrate"]) {
+      calibrate_ = config["calibrate"].as<bool>();
+    }
+
+    // Load kRam NUMA placement (optional)
+    if (config["numa"]) {
+      std::string numa_str = config["numa"].as<std::string>();
+      if (numa_str == "interleave") {
+        ram_numa_ = RamNumaMode::kInterleave;
+      } else if (numa_str == "local") {
+        ram_numa_ = RamNumaMode::kNodeLocal;
+      } else if (numa_str == "none") {
+        ram_numa_ = RamNumaMode::kFlat;
+      }
+    }
+
+    // Load kRam client-mappable buffer (optional)
+    if (config["shared"]) {
+      shared_ = config["shared"].as<bool>();
+    }
+
+    // Load kRam huge pages (optional)
+    if (config["huge_pages"]) {
+      huge_pages_ = chi::ConfigManager::ParseHugePageMode(
+          config["huge_pages"].as<std::string>());
+    }
+
+    // Load parallel file system mode (optional): `pfs: true` or a map
+    if (config["pfs"]) {
+      auto pfs = config["pfs"];
+      if (pfs.IsMap()) {
+        pfs_ = true;
+        if (pfs["enabled"]) {
+          pfs_ = pfs["enabled"].as<bool>();
+        }
+        if (pfs["stripe_size"]) {
+          pfs_stripe_size_ = hshm::ConfigParse::ParseSize(
+              pfs["stripe_size"].as<std::string>());
+        }
+        if (pfs["stripe_count"]) {
+          pfs_stripe_count_ = pfs["stripe_count"].as<chi::u32>();
+        }
+        if (pfs["max_staged_stripes"]) {
+          pfs_max_staged_ = pfs["max_staged_stripes"].as<chi::u32>();
+        }
+        if (pfs["flush_ms"]) {
+          pfs_flush_ms_ = pfs["flush_ms"].as<chi::u32>();
+        }
+      } else {
+        pfs_ = pfs.as<bool>();
+      }
+    }
+
+    // Load io_uring tuning (optional)
+    if (config["io_uring"]) {
+      auto io_uring = config["io_uring"];
+      if (io_uring["fixed_buffers"]) {
+        io_fixed_buffers_ = io_uring["fixed_buffers"].as<bool>();
+      }
+      if (io_uring["batch_submit"]) {
+        io_batch_submit_ = io_uring["batch_submit"].as<bool>();
+      }
+      if (io_uring["sqpoll"]) {
+        io_sqpoll_ = io_uring["sqpoll"].as<bool>();
+      }
+      if (io_uring["sqpoll_cpu"]) {
+        io_sqpoll_cpu_ = io_uring["sqpoll_cpu"].as<int>();
+      }
+    }
+
     // Load performance metrics (optional)
     if (config["perf_metrics"]) {
       auto perf = config["perf_metrics"];
+      perf_metrics_user_ = true;
       if (perf["read_bandwidth_mbps"]) {
         perf_metrics_.read_bandwidth_mbps_ =
             perf["read_bandwidth_mbps"].as<double>();
@@ -433,12 +626,16 @@ struct FreeBlocksTask : public chi::Task {
 struct WriteTask : public chi::Task {
   // Task-specific data
   IN chi::priv::vector<Block> blocks_;  // Blocks to write to
+  IN chi::priv::vector<chi::u64> data_offsets_;  // Per-block offset in data_
+                                                 // (empty: back to back)
   IN hipc::ShmPtr<> data_;              // Data to write (pointer-based)
   IN size_t length_;                    // Size of data to write
   OUT chi::u64 bytes_written_;          // Number of bytes actually written
 
   /** SHM default constructor */
-  HSHM_CROSS_FUN WriteTask() : chi::Task(), blocks_(CHI_PRIV_ALLOC), length_(0), bytes_written_(0) {}
+  HSHM_CROSS_FUN WriteTask()
+      : chi::Task(), blocks_(CHI_PRIV_ALLOC), data_offsets_(CHI_PRIV_ALLOC),
+        length_(0), bytes_written_(0) {}
 
   /** Emplace constructor */
   HSHM_CROSS_FUN explicit WriteTask(const chi::TaskId &task_node, const chi::PoolId &pool_id,
@@ -447,6 +644,25 @@ struct WriteTask : public chi::Task {
                      size_t length)
       : chi::Task(task_node, pool_id, pool_query, Method::kWrite),
         blocks_(blocks),
+        data_offsets_(CHI_PRIV_ALLOC),
+        data_(data),
+        length_(length),
+        bytes_written_(0) {
+  }
+
+  /**
+   * Multi-extent constructor: block i is written from
+   * data + data_offsets[i], and length is the span of data covering all
+   * blocks
+   */
+  HSHM_CROSS_FUN explicit WriteTask(const chi::TaskId &task_node, const chi::PoolId &pool_id,
+                     const chi::PoolQuery &pool_query,
+                     const chi::priv::vector<Block> &blocks,
+                     const chi::priv::vector<chi::u64> &data_offsets,
+                     hipc::ShmPtr<> data, size_t length)
+      : chi::Task(task_node, pool_id, pool_query, Method::kWrite),
+        blocks_(blocks),
+        data_offsets_(data_offsets),
         data_(data),
         length_(length),
         bytes_written_(0) {
@@ -468,7 +684,7 @@ struct WriteTask : public chi::Task {
   template <typename Archive>
   HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
     Task::SerializeIn(ar);
-    ar(blocks_, length_);
+    ar(blocks_, data_offsets_, length_);
     // Use bulk transfer for data pointer - BULK_XFER for actual data
     // transmission
     ar.bulk(data_, length_, BULK_XFER);
@@ -484,6 +700,7 @@ struct WriteTask : public chi::Task {
   /** Fix up priv::vector SVO pointer after cudaMemcpy D→H */
   HSHM_CROSS_FUN void FixupAfterCopy() {
     blocks_.FixupSvoPtr();
+    data_offsets_.FixupSvoPtr();
   }
 
   /** Aggregate */
@@ -501,6 +718,7 @@ struct WriteTask : public chi::Task {
     Task::Copy(other.template Cast<Task>());
     // Copy WriteTask-specific fields
     blocks_ = other->blocks_;
+    data_offsets_ = other->data_offsets_;
     data_ = other->data_;
     length_ = other->length_;
     bytes_written_ = other->bytes_written_;
@@ -513,13 +731,17 @@ struct WriteTask : public chi::Task {
 struct ReadTask : public chi::Task {
   // Task-specific data
   IN chi::priv::vector<Block> blocks_;  // Blocks to read from
+  IN chi::priv::vector<chi::u64> data_offsets_;  // Per-block offset in data_
+                                                 // (empty: back to back)
   OUT hipc::ShmPtr<> data_;             // Read data (pointer-based)
   INOUT size_t
       length_;  // Size of data buffer (IN: buffer size, OUT: actual size)
   OUT chi::u64 bytes_read_;  // Number of bytes actually read
 
   /** SHM default constructor */
-  HSHM_CROSS_FUN ReadTask() : chi::Task(), blocks_(CHI_PRIV_ALLOC), length_(0), bytes_read_(0) {}
+  HSHM_CROSS_FUN ReadTask()
+      : chi::Task(), blocks_(CHI_PRIV_ALLOC), data_offsets_(CHI_PRIV_ALLOC),
+        length_(0), bytes_read_(0) {}
 
   /** Emplace constructor */
   HSHM_CROSS_FUN explicit ReadTask(const chi::TaskId &task_node, const chi::PoolId &pool_id,
@@ -528,6 +750,24 @@ struct ReadTask : public chi::Task {
                     size_t length)
       : chi::Task(task_node, pool_id, pool_query, Method::kRead),
         blocks_(blocks),
+        data_offsets_(CHI_PRIV_ALLOC),
+        data_(data),
+        length_(length),
+        bytes_read_(0) {
+  }
+
+  /**
+   * Multi-extent constructor: block i is read into data + data_offsets[i],
+   * and length is the span of data covering all blocks
+   */
+  HSHM_CROSS_FUN explicit ReadTask(const chi::TaskId &task_node, const chi::PoolId &pool_id,
+                    const chi::PoolQuery &pool_query,
+                    const chi::priv::vector<Block> &blocks,
+                    const chi::priv::vector<chi::u64> &data_offsets,
+                    hipc::ShmPtr<> data, size_t length)
+      : chi::Task(task_node, pool_id, pool_query, Method::kRead),
+        blocks_(blocks),
+        data_offsets_(data_offsets),
         data_(data),
         length_(length),
         bytes_read_(0) {
@@ -549,7 +789,7 @@ struct ReadTask : public chi::Task {
   template <typename Archive>
   HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
     Task::SerializeIn(ar);
-    ar(blocks_, length_);
+    ar(blocks_, data_offsets_, length_);
     // Use BULK_EXPOSE to indicate metadata only - receiver will allocate buffer
     ar.bulk(data_, length_, BULK_EXPOSE);
   }
@@ -566,6 +806,7 @@ struct ReadTask : public chi::Task {
   /** Fix up priv::vector SVO pointer after cudaMemcpy D→H */
   HSHM_CROSS_FUN void FixupAfterCopy() {
     blocks_.FixupSvoPtr();
+    data_offsets_.FixupSvoPtr();
   }
 
   /** Aggregate */
@@ -583,12 +824,54 @@ struct ReadTask : public chi::Task {
     Task::Copy(other.template Cast<Task>());
     // Copy ReadTask-specific fields
     blocks_ = other->blocks_;
+    data_offsets_ = other->data_offsets_;
     data_ = other->data_;
     length_ = other->length_;
     bytes_read_ = other->bytes_read_;
   }
 };
 
+/**
+ * Locate block i of a WriteTask/ReadTask within its data buffer. Blocks are
+ * back to back (starting at seq_offset) unless data_offsets_ is set.
+ * @param task Write or read task
+ * @param i Block index
+ * @param seq_offset Bytes consumed by blocks [0, i) in sequential mode
+ * @param data_off Output: byte offset of the block within data_
+ * @return Bytes to transfer for this block, 0 once the data is exhausted
+ */
+template <typename TaskT>
+HSHM_CROSS_FUN chi::u64 GetBlockDataRange(const TaskT &task, size_t i,
+                                          chi::u64 seq_offset,
+                                          chi::u64 *data_off) {
+  chi::u64 off = i < task.data_offsets_.size() ? task.data_offsets_[i]
+                                               : seq_offset;
+  *data_off = off;
+  if (off >= task.length_) {
+    return 0;
+  }
+  chi::u64 remaining = task.length_ - off;
+  chi::u64 block_size = task.blocks_[i].size_;
+  return remaining < block_size ? remaining : block_size;
+}
+
+/**
+ * Total bytes a WriteTask/ReadTask transfers across all of its blocks
+ * @param task Write or read task
+ * @return Sum of GetBlockDataRange over the blocks
+ */
+template <typename TaskT>
+HSHM_CROSS_FUN chi::u64 GetTaskDataBytes(const TaskT &task) {
+  chi::u64 total = 0;
+  chi::u64 data_off = 0;
+  for (size_t i = 0; i < task.blocks_.size(); ++i) {
+    chi::u64 n = GetBlockDataRange(task, i, total, &data_off);
+    if (n == 0) break;
+    total += n;
+  }
+  return total;
+}
+
 /**
  * GetStatsTask - Get performance statistics and remaining size
  */
@@ -596,15 +879,24 @@ struct GetStatsTask : public chi::Task {
   // Task-specific data (no inputs)
   OUT PerfMetrics metrics_;      // Performance metrics
   OUT chi::u64 remaining_size_;  // Remaining allocatable space
+  OUT chi::u64 inflight_bytes_;  // Bytes of Write/Read tasks in progress
+  OUT PerfModel model_;          // Fitted curves (unfitted until sampled)
+  OUT chi::priv::vector<chi::u64> node_remaining_;  // Per NUMA node (node-local
+                                                    // kRam only, else empty)
+  OUT bool shared_buffer_;  // kRam buffer is in GetRamSegmentName(pool_id_)
 
   /** SHM default constructor */
-  GetStatsTask() : chi::Task(), remaining_size_(0) {}
+  GetStatsTask()
+      : chi::Task(), remaining_size_(0), inflight_bytes_(0),
+        node_remaining_(CHI_PRIV_ALLOC), shared_buffer_(false) {}
 
   /** Emplace constructor */
   explicit GetStatsTask(const chi::TaskId &task_node,
                         const chi::PoolId &pool_id,
                         const chi::PoolQuery &pool_query)
-      : chi::Task(task_node, pool_id, pool_query, 10), remaining_size_(0) {
+      : chi::Task(task_node, pool_id, pool_query, 10), remaining_size_(0),
+        inflight_bytes_(0), node_remaining_(CHI_PRIV_ALLOC),
+        shared_buffer_(false) {
     // Initialize task
     task_id_ = task_node;
     pool_id_ = pool_id;
@@ -624,7 +916,8 @@ struct GetStatsTask : public chi::Task {
   template <typename Archive>
   HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
     Task::SerializeOut(ar);
-    ar(metrics_, remaining_size_);
+    ar(metrics_, remaining_size_, inflight_bytes_, model_, node_remaining_,
+       shared_buffer_);
   }
 
   /**
@@ -637,6 +930,10 @@ struct GetStatsTask : public chi::Task {
     // Copy GetStatsTask-specific fields
     metrics_ = other->metrics_;
     remaining_size_ = other->remaining_size_;
+    inflight_bytes_ = other->inflight_bytes_;
+    model_ = other->model_;
+    node_remaining_ = other->node_remaining_;
+    shared_buffer_ = other->shared_buffer_;
   }
 
   /** Aggregate replica results into this task */
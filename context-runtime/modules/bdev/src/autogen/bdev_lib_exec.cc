@@ -1,7 +1,7 @@
 /**
  * Auto-generated execution implementation for bdev ChiMod
- * Implements Container virtual APIs (Run, SaveTask, LoadTask, NewCopyTask, NewTask)
- * using switch-case dispatch
+ * Implements Container virtual APIs (Run, SaveTask, LoadTask, NewCopyTask, NewTask).
+ * Run uses switch-case dispatch; the others index the kMethodExec table.
  * 
  * This file is autogenerated - do not edit manually.
  * Changes should be made to the autogen tool or the YAML configuration.
@@ -11,9 +11,34 @@
 #include "chimaera/bdev/autogen/bdev_methods.h"
 #include <chimaera/chimaera.h>
 #include <chimaera/task.h>  // For TaskResume coroutine return type
+#include <chimaera/method_exec.h>
 
 namespace chimaera::bdev {
 
+namespace {
+
+/** Per-method dispatch table indexed by method ID */
+constexpr chi::MethodExec kMethodExec[16] = {
+    chi::MakeMethodExec<CreateTask>(),  // 0: Create
+    chi::MakeMethodExec<DestroyTask>(),  // 1: Destroy
+    {},  // 2
+    {},  // 3
+    {},  // 4
+    {},  // 5
+    {},  // 6
+    {},  // 7
+    {},  // 8
+    chi::MakeMethodExec<MonitorTask>(),  // 9: Monitor
+    chi::MakeMethodExec<AllocateBlocksTask>(),  // 10: AllocateBlocks
+    chi::MakeMethodExec<FreeBlocksTask>(),  // 11: FreeBlocks
+    chi::MakeMethodExec<WriteTask>(),  // 12: Write
+    chi::MakeMethodExec<ReadTask>(),  // 13: Read
+    chi::MakeMethodExec<GetStatsTask>(),  // 14: GetStats
+    chi::MakeMethodExec<UpdateTask>(),  // 15: Update
+};
+
+}  // namespace
+
 //==============================================================================
 // Container Virtual API Implementations
 //==============================================================================
@@ -29,6 +54,7 @@ void Runtime::Init(const chi::PoolId &pool_id, const std::string &pool_name,
   // Initialize per-method load prediction model
   DefineModel(Method::kMaxMethodId);
   SetMethodNames(Method::GetMethodNames());
+  SetMethodTraits(Method::kMethodTraits);
 }
 
 chi::TaskResume Runtime::Run(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr, chi::RunContext& rctx) {
@@ -85,7 +111,7 @@ chi::TaskResume Runtime::Run(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr,
     case Method::kUpdate: {
       // Cast task FullPtr to specific type
       hipc::FullPtr<UpdateTask> typed_task = task_ptr.template Cast<UpdateTask>();
-      co_await Update(typed_task, rctx);
+      CHI_CO_AWAIT(Update(typed_task, rctx));
       break;
     }
     default: {
@@ -99,111 +125,17 @@ chi::TaskResume Runtime::Run(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr,
 
 void Runtime::SaveTask(chi::u32 method, chi::SaveTaskArchive& archive, 
                         hipc::FullPtr<chi::Task> task_ptr) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = task_ptr.template Cast<CreateTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = task_ptr.template Cast<DestroyTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = task_ptr.template Cast<MonitorTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kAllocateBlocks: {
-      auto typed_task = task_ptr.template Cast<AllocateBlocksTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kFreeBlocks: {
-      auto typed_task = task_ptr.template Cast<FreeBlocksTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kWrite: {
-      auto typed_task = task_ptr.template Cast<WriteTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kRead: {
-      auto typed_task = task_ptr.template Cast<ReadTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetStats: {
-      auto typed_task = task_ptr.template Cast<GetStatsTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kUpdate: {
-      auto typed_task = task_ptr.template Cast<UpdateTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    default: {
-      // Unknown method - do nothing
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->save_(archive, task_ptr);
   }
 }
 
 void Runtime::LoadTask(chi::u32 method, chi::LoadTaskArchive& archive,
                         hipc::FullPtr<chi::Task> task_ptr) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = task_ptr.template Cast<CreateTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = task_ptr.template Cast<DestroyTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = task_ptr.template Cast<MonitorTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kAllocateBlocks: {
-      auto typed_task = task_ptr.template Cast<AllocateBlocksTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kFreeBlocks: {
-      auto typed_task = task_ptr.template Cast<FreeBlocksTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kWrite: {
-      auto typed_task = task_ptr.template Cast<WriteTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kRead: {
-      auto typed_task = task_ptr.template Cast<ReadTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetStats: {
-      auto typed_task = task_ptr.template Cast<GetStatsTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kUpdate: {
-      auto typed_task = task_ptr.template Cast<UpdateTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    default: {
-      // Unknown method - do nothing
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->load_(archive, task_ptr);
   }
 }
 
@@ -217,65 +149,9 @@ hipc::FullPtr<chi::Task> Runtime::AllocLoadTask(chi::u32 method, chi::LoadTaskAr
 
 void Runtime::LocalLoadTask(chi::u32 method, chi::DefaultLoadArchive& archive,
                             hipc::FullPtr<chi::Task> task_ptr) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = task_ptr.template Cast<CreateTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = task_ptr.template Cast<DestroyTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = task_ptr.template Cast<MonitorTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kAllocateBlocks: {
-      auto typed_task = task_ptr.template Cast<AllocateBlocksTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kFreeBlocks: {
-      auto typed_task = task_ptr.template Cast<FreeBlocksTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kWrite: {
-      auto typed_task = task_ptr.template Cast<WriteTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kRead: {
-      auto typed_task = task_ptr.template Cast<ReadTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetStats: {
-      auto typed_task = task_ptr.template Cast<GetStatsTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kUpdate: {
-      auto typed_task = task_ptr.template Cast<UpdateTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    default: {
-      // Unknown method - do nothing
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->local_load_(archive, task_ptr);
   }
 }
 
@@ -289,339 +165,58 @@ hipc::FullPtr<chi::Task> Runtime::LocalAllocLoadTask(chi::u32 method, chi::Defau
 
 void Runtime::LocalSaveTask(chi::u32 method, chi::DefaultSaveArchive& archive, 
                              hipc::FullPtr<chi::Task> task_ptr) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = task_ptr.template Cast<CreateTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = task_ptr.template Cast<DestroyTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = task_ptr.template Cast<MonitorTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kAllocateBlocks: {
-      auto typed_task = task_ptr.template Cast<AllocateBlocksTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kFreeBlocks: {
-      auto typed_task = task_ptr.template Cast<FreeBlocksTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kWrite: {
-      auto typed_task = task_ptr.template Cast<WriteTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kRead: {
-      auto typed_task = task_ptr.template Cast<ReadTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetStats: {
-      auto typed_task = task_ptr.template Cast<GetStatsTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kUpdate: {
-      auto typed_task = task_ptr.template Cast<UpdateTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    default: {
-      // Unknown method - do nothing
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->local_save_(archive, task_ptr);
   }
 }
 
 hipc::FullPtr<chi::Task> Runtime::NewCopyTask(chi::u32 method, hipc::FullPtr<chi::Task> orig_task_ptr, bool deep) {
+  (void)deep;    // Deep copy parameter reserved for future use
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    return exec->new_copy_(orig_task_ptr);
+  }
+  // For unknown methods, create base Task copy
   auto* ipc_manager = CHI_IPC;
   if (!ipc_manager) {
     return hipc::FullPtr<chi::Task>();
   }
-  
-  switch (method) {
-    case Method::kCreate: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<CreateTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<CreateTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kDestroy: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<DestroyTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<DestroyTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kMonitor: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<MonitorTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<MonitorTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kAllocateBlocks: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<AllocateBlocksTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<AllocateBlocksTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kFreeBlocks: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<FreeBlocksTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<FreeBlocksTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kWrite: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<WriteTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<WriteTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kRead: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<ReadTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<ReadTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kGetStats: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<GetStatsTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<GetStatsTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kUpdate: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<UpdateTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<UpdateTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    default: {
-      // For unknown methods, create base Task copy
-      auto new_task_ptr = ipc_manager->NewTask<chi::Task>();
-      if (!new_task_ptr.IsNull()) {
-        new_task_ptr->Copy(orig_task_ptr);
-        return new_task_ptr;
-      }
-      break;
-    }
+  auto new_task_ptr = ipc_manager->NewTask<chi::Task>();
+  if (!new_task_ptr.IsNull()) {
+    new_task_ptr->Copy(orig_task_ptr);
   }
-  
-  (void)deep;    // Deep copy parameter reserved for future use
-  return hipc::FullPtr<chi::Task>();
+  return new_task_ptr;
 }
 
 hipc::FullPtr<chi::Task> Runtime::NewTask(chi::u32 method) {
-  auto* ipc_manager = CHI_IPC;
-  if (!ipc_manager) {
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec == nullptr) {
+    // For unknown methods, return null pointer
     return hipc::FullPtr<chi::Task>();
   }
-  
-  switch (method) {
-    case Method::kCreate: {
-      auto new_task_ptr = ipc_manager->NewTask<CreateTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kDestroy: {
-      auto new_task_ptr = ipc_manager->NewTask<DestroyTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kMonitor: {
-      auto new_task_ptr = ipc_manager->NewTask<MonitorTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kAllocateBlocks: {
-      auto new_task_ptr = ipc_manager->NewTask<AllocateBlocksTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kFreeBlocks: {
-      auto new_task_ptr = ipc_manager->NewTask<FreeBlocksTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kWrite: {
-      auto new_task_ptr = ipc_manager->NewTask<WriteTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kRead: {
-      auto new_task_ptr = ipc_manager->NewTask<ReadTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kGetStats: {
-      auto new_task_ptr = ipc_manager->NewTask<GetStatsTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kUpdate: {
-      auto new_task_ptr = ipc_manager->NewTask<UpdateTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    default: {
-      // For unknown methods, return null pointer
-      return hipc::FullPtr<chi::Task>();
-    }
-  }
+  return exec->new_task_();
 }
 
 void Runtime::Aggregate(chi::u32 method, hipc::FullPtr<chi::Task> orig_task,
                         const hipc::FullPtr<chi::Task>& replica_task) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = orig_task.template Cast<CreateTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = orig_task.template Cast<DestroyTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = orig_task.template Cast<MonitorTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kAllocateBlocks: {
-      auto typed_task = orig_task.template Cast<AllocateBlocksTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kFreeBlocks: {
-      auto typed_task = orig_task.template Cast<FreeBlocksTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kWrite: {
-      auto typed_task = orig_task.template Cast<WriteTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kRead: {
-      auto typed_task = orig_task.template Cast<ReadTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kGetStats: {
-      auto typed_task = orig_task.template Cast<GetStatsTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kUpdate: {
-      auto typed_task = orig_task.template Cast<UpdateTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    default: {
-      orig_task->Aggregate(replica_task);
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->aggregate_(orig_task, replica_task);
+  } else {
+    orig_task->Aggregate(replica_task);
   }
 }
 
 void Runtime::DelTask(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr) {
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->del_(task_ptr);
+    return;
+  }
   auto* ipc_manager = CHI_IPC;
   if (!ipc_manager) return;
-  switch (method) {
-    case Method::kCreate: {
-      ipc_manager->DelTask(task_ptr.template Cast<CreateTask>());
-      break;
-    }
-    case Method::kDestroy: {
-      ipc_manager->DelTask(task_ptr.template Cast<DestroyTask>());
-      break;
-    }
-    case Method::kMonitor: {
-      ipc_manager->DelTask(task_ptr.template Cast<MonitorTask>());
-      break;
-    }
-    case Method::kAllocateBlocks: {
-      ipc_manager->DelTask(task_ptr.template Cast<AllocateBlocksTask>());
-      break;
-    }
-    case Method::kFreeBlocks: {
-      ipc_manager->DelTask(task_ptr.template Cast<FreeBlocksTask>());
-      break;
-    }
-    case Method::kWrite: {
-      ipc_manager->DelTask(task_ptr.template Cast<WriteTask>());
-      break;
-    }
-    case Method::kRead: {
-      ipc_manager->DelTask(task_ptr.template Cast<ReadTask>());
-      break;
-    }
-    case Method::kGetStats: {
-      ipc_manager->DelTask(task_ptr.template Cast<GetStatsTask>());
-      break;
-    }
-    case Method::kUpdate: {
-      ipc_manager->DelTask(task_ptr.template Cast<UpdateTask>());
-      break;
-    }
-    default: {
-      ipc_manager->DelTask(task_ptr);
-      break;
-    }
-  }
+  ipc_manager->DelTask(task_ptr);
 }
 
 } // namespace chimaera::bdev
@@ -37,14 +37,34 @@
 #include <chimaera/worker.h>
 
 #include <hermes_shm/serialize/msgpack_wrapper.h>
+#include <hermes_shm/solver/nonlinear_least_squares.h>
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/vfs.h>
+
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <thread>
 
 #include "hermes_shm/util/timer.h"
 
+#if CHI_BDEV_ENABLE_GDS
+#include <cufile.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <mutex>
+#endif
+
+#if CHI_BDEV_ENABLE_LUSTRE
+#include <lustre/lustreapi.h>
+#endif
+
 namespace chimaera::bdev {
 
 //===========================================================================
@@ -52,17 +72,19 @@ namespace chimaera::bdev {
 //===========================================================================
 
 bool WorkerIOContext::Init(const std::string &file_path, chi::u32 io_depth,
-                           chi::u32 worker_id) {
+                           const hshm::AsyncIoOptions &io_opts,
+                           hshm::AsyncIoBackend backend, chi::u32 worker_id) {
   if (is_initialized_) {
     return true;  // Already initialized
   }
 
   // Create async I/O backend via factory (io_depth passed at construction)
 #if HSHM_ENABLE_NIXL
-  async_io_ = hshm::AsyncIoFactory::Get(io_depth, hshm::AsyncIoBackend::kNixl);
-#else
-  async_io_ = hshm::AsyncIoFactory::Get(io_depth);
+  if (backend == hshm::AsyncIoBackend::kDefault) {
+    backend = hshm::AsyncIoBackend::kNixl;
+  }
 #endif
+  async_io_ = hshm::AsyncIoFactory::Get(io_depth, backend, io_opts);
   if (!async_io_) {
     HLOG(kError, "Worker {} failed to create async I/O backend", worker_id);
     return false;
@@ -83,6 +105,11 @@ bool WorkerIOContext::Init(const std::string &file_path, chi::u32 io_depth,
 }
 
 void WorkerIOContext::Cleanup() {
+  for (char *buf : bounce_free_) {
+    munlock(buf, kBounceBufferSize);
+    free(buf);
+  }
+  bounce_free_.clear();
   if (!is_initialized_) {
     return;
   }
@@ -95,16 +122,47 @@ void WorkerIOContext::Cleanup() {
   is_initialized_ = false;
 }
 
-// Block size constants (in bytes) - 4KB, 16KB, 32KB, 64KB, 128KB, 1MB
+char *WorkerIOContext::AcquireBounceBuffer() {
+  if (!bounce_free_.empty()) {
+    char *buf = bounce_free_.back();
+    bounce_free_.pop_back();
+    return buf;
+  }
+  void *buf = nullptr;
+  if (posix_memalign(&buf, hshm::AsyncIO::kDirectAlignment,
+                     kBounceBufferSize) != 0) {
+    return nullptr;
+  }
+  // Best effort: an unlocked buffer still works, it may just be paged out
+  mlock(buf, kBounceBufferSize);
+  return static_cast<char *>(buf);
+}
+
+void WorkerIOContext::ReleaseBounceBuffer(char *buf) {
+  if (bounce_free_.size() < kMaxIdleBounceBuffers) {
+    bounce_free_.push_back(buf);
+    return;
+  }
+  munlock(buf, kBounceBufferSize);
+  free(buf);
+}
+
+// Block size constants (in bytes) - 4KB, 16KB, 32KB, 64KB, 128KB, 1MB, 4MB,
+// 16MB
 static const size_t kBlockSizes[] = {
-    4096,     // 4KB
-    16384,    // 16KB
-    32768,    // 32KB
-    65536,    // 64KB
-    131072,   // 128KB
-    1048576   // 1MB
+    4096,      // 4KB
+    16384,     // 16KB
+    32768,     // 32KB
+    65536,     // 64KB
+    131072,    // 128KB
+    1048576,   // 1MB
+    4194304,   // 4MB
+    16777216   // 16MB
 };
 
+static constexpr int kNumBlockSizes =
+    static_cast<int>(BlockSizeCategory::kMaxCategories);
+
 //===========================================================================
 // Helper Functions
 //===========================================================================
@@ -117,8 +175,7 @@ static const size_t kBlockSizes[] = {
  */
 static int FindBlockTypeForSize(size_t io_size, size_t &out_block_size) {
   // Find the next block size that is larger than or equal to io_size
-  for (int i = 0; i < static_cast<int>(BlockSizeCategory::kMaxCategories);
-       ++i) {
+  for (int i = 0; i < kNumBlockSizes; ++i) {
     if (kBlockSizes[i] >= io_size) {
       out_block_size = kBlockSizes[i];
       return i;
@@ -129,50 +186,714 @@ static int FindBlockTypeForSize(size_t io_size, size_t &out_block_size) {
   return -1;
 }
 
-//===========================================================================
-// WorkerBlockMap Implementation
-//===========================================================================
+/**
+ * Find the largest block type that fits inside a given size (rounds down)
+ * @param size Available size
+ * @return Block type index, or -1 if smaller than all cached sizes
+ */
+static int FindBlockTypeWithin(chi::u64 size) {
+  for (int i = kNumBlockSizes - 1; i >= 0; --i) {
+    if (kBlockSizes[i] <= size) {
+      return i;
+    }
+  }
+  return -1;
+}
 
-WorkerBlockMap::WorkerBlockMap() {
-  // Initialize vector with 5 empty lists (one for each block size category)
-  blocks_.resize(static_cast<size_t>(BlockSizeCategory::kMaxCategories));
+/**
+ * Divide an allocation request into cached block sizes. Whole largest-size
+ * blocks come first, then the largest sizes that fit above 1MB, and any
+ * remainder is rounded up to a single block.
+ * @param total_size Requested allocation size
+ * @param io_divisions Output: size of each block to allocate
+ */
+static void DivideIoSize(chi::u64 total_size,
+                         std::vector<size_t> &io_divisions) {
+  const chi::u64 kRoundUpLimit =
+      kBlockSizes[static_cast<int>(BlockSizeCategory::k1MB)];
+  chi::u64 remaining = total_size;
+  while (remaining > kRoundUpLimit) {
+    size_t piece = kBlockSizes[FindBlockTypeWithin(remaining)];
+    io_divisions.push_back(piece);
+    remaining -= piece;
+  }
+  if (remaining > 0) {
+    io_divisions.push_back(static_cast<size_t>(remaining));
+  }
 }
 
-bool WorkerBlockMap::AllocateBlock(int block_type, Block &block) {
-  if (block_type < 0 ||
-      block_type >= static_cast<int>(BlockSizeCategory::kMaxCategories)) {
-    return false;
+/**
+ * A run of file-adjacent blocks submitted as one (vectored) I/O
+ */
+struct IoExtent {
+  chi::u64 file_offset_;           /**< Device offset of the first block */
+  chi::u64 size_;                  /**< Bytes in the extent */
+  std::vector<hshm::IoVec> iov_;   /**< Task buffer segments, in file order */
+};
+
+/**
+ * Coalesce a write/read task's blocks into file extents. Blocks that follow
+ * each other on the device share an extent; their buffer segments merge
+ * when they are also adjacent in memory.
+ * @param task Write or read task
+ * @param data Task data buffer
+ * @param extents Output: extents in block order
+ */
+template <typename TaskT>
+static void BuildIoExtents(const TaskT &task, char *data,
+                           std::vector<IoExtent> &extents) {
+  chi::u64 seq_offset = 0;
+  for (size_t i = 0; i < task.blocks_.size(); ++i) {
+    chi::u64 data_off = 0;
+    chi::u64 n = GetBlockDataRange(task, i, seq_offset, &data_off);
+    if (n == 0) break;
+    seq_offset += n;
+    const Block &block = task.blocks_[i];
+    char *base = data + data_off;
+    if (!extents.empty()) {
+      IoExtent &last = extents.back();
+      if (last.file_offset_ + last.size_ == block.offset_) {
+        hshm::IoVec &tail = last.iov_.back();
+        if (static_cast<char *>(tail.base_) + tail.size_ == base) {
+          tail.size_ += n;
+          last.size_ += n;
+          continue;
+        }
+        if (last.iov_.size() < hshm::AsyncIO::kMaxIoVecs) {
+          last.iov_.push_back(hshm::IoVec{base, static_cast<size_t>(n)});
+          last.size_ += n;
+          continue;
+        }
+      }
+    }
+    extents.push_back(IoExtent{
+        block.offset_, n, {hshm::IoVec{base, static_cast<size_t>(n)}}});
+  }
+}
+
+/**
+ * Submit extents to an async I/O backend, one submission per extent. A
+ * backend without vectored I/O gets one submission per segment instead.
+ * @param async_io Worker's async I/O backend
+ * @param extents Extents to submit
+ * @param is_write Write if true, read otherwise
+ * @param tokens Output: token per submission
+ * @param sizes Output: bytes per submission
+ * @return false if a submission failed (earlier ones are still in flight)
+ */
+static bool SubmitIoExtents(hshm::AsyncIO *async_io,
+                            const std::vector<IoExtent> &extents,
+                            bool is_write,
+                            std::vector<hshm::IoToken> &tokens,
+                            std::vector<chi::u64> &sizes) {
+  for (const IoExtent &extent : extents) {
+    off_t offset = static_cast<off_t>(extent.file_offset_);
+    if (extent.iov_.size() > 1) {
+      hshm::IoToken token =
+          is_write ? async_io->WriteV(extent.iov_.data(), extent.iov_.size(),
+                                      offset)
+                   : async_io->ReadV(extent.iov_.data(), extent.iov_.size(),
+                                     offset);
+      if (token != hshm::kInvalidIoToken) {
+        tokens.push_back(token);
+        sizes.push_back(extent.size_);
+        continue;
+      }
+    }
+    for (const hshm::IoVec &seg : extent.iov_) {
+      hshm::IoToken token =
+          is_write ? async_io->Write(seg.base_, seg.size_, offset)
+                   : async_io->Read(seg.base_, seg.size_, offset);
+      if (token == hshm::kInvalidIoToken) {
+        HLOG(kError, "Failed to submit async {}: offset={}, size={}",
+             is_write ? "write" : "read", offset, seg.size_);
+        return false;
+      }
+      tokens.push_back(token);
+      sizes.push_back(seg.size_);
+      offset += static_cast<off_t>(seg.size_);
+    }
+  }
+  return true;
+}
+
+/**
+ * Aligned bounce buffer standing in for part of an unaligned extent under
+ * direct I/O
+ */
+struct BounceChunk {
+  char *buf_;                     /**< Aligned buffer from the worker pool */
+  chi::u64 file_offset_;          /**< Aligned device offset of buf_ */
+  chi::u64 size_;                 /**< Aligned bytes transferred */
+  chi::u64 data_start_;           /**< Offset of the task data within buf_ */
+  chi::u64 data_size_;            /**< Task data bytes in this chunk */
+  std::vector<hshm::IoVec> iov_;  /**< Task buffer segments of that data */
+};
+
+/** @return true if O_DIRECT can transfer the extent in place */
+static bool IsExtentDirectAligned(const IoExtent &extent) {
+  return extent.file_offset_ % hshm::AsyncIO::kDirectAlignment == 0 &&
+         hshm::AsyncIO::IsDirectAligned(
+             extent.iov_.data(), extent.iov_.size(),
+             static_cast<off_t>(extent.file_offset_));
+}
+
+/**
+ * Collect the buffer segments holding bytes [start, start + len) of an
+ * extent
+ * @param iov Extent segments
+ * @param start First byte, relative to the extent
+ * @param len Bytes to collect
+ * @param out Output: the segments, trimmed to the range
+ */
+static void SliceIoVecs(const std::vector<hshm::IoVec> &iov, chi::u64 start,
+                        chi::u64 len, std::vector<hshm::IoVec> &out) {
+  chi::u64 pos = 0;
+  for (const hshm::IoVec &seg : iov) {
+    if (len == 0) break;
+    chi::u64 seg_end = pos + seg.size_;
+    if (start < seg_end) {
+      chi::u64 skip = start - pos;
+      chi::u64 n = std::min<chi::u64>(seg.size_ - skip, len);
+      out.push_back(hshm::IoVec{static_cast<char *>(seg.base_) + skip,
+                                static_cast<size_t>(n)});
+      start += n;
+      len -= n;
+    }
+    pos = seg_end;
+  }
+}
+
+/**
+ * Replace the extents O_DIRECT cannot transfer in place with bounce chunks
+ * covering their sector-aligned range. Extents must not share a sector,
+ * which holds for blocks allocated at a sector-multiple alignment.
+ * @param io_ctx Worker I/O context providing the bounce buffers
+ * @param extents Extents; only the aligned ones are left
+ * @param chunks Output: bounce chunks, to be released by the caller
+ * @return false if a bounce buffer could not be allocated
+ */
+static bool SplitUnalignedExtents(WorkerIOContext *io_ctx,
+                                  std::vector<IoExtent> &extents,
+                                  std::vector<BounceChunk> &chunks) {
+  const chi::u64 kAlign = hshm::AsyncIO::kDirectAlignment;
+  const chi::u64 kChunk = WorkerIOContext::kBounceBufferSize;
+  size_t kept = 0;
+  for (IoExtent &extent : extents) {
+    if (IsExtentDirectAligned(extent)) {
+      extents[kept++] = std::move(extent);
+      continue;
+    }
+    chi::u64 start = extent.file_offset_;
+    chi::u64 end = start + extent.size_;
+    chi::u64 aligned_end = (end + kAlign - 1) / kAlign * kAlign;
+    for (chi::u64 pos = start / kAlign * kAlign; pos < aligned_end;
+         pos += kChunk) {
+      BounceChunk chunk;
+      chunk.buf_ = io_ctx->AcquireBounceBuffer();
+      if (chunk.buf_ == nullptr) {
+        extents.resize(kept);
+        return false;
+      }
+      chunk.file_offset_ = pos;
+      chunk.size_ = std::min(kChunk, aligned_end - pos);
+      chi::u64 data_begin = std::max(start, pos);
+      chi::u64 data_end = std::min(end, pos + chunk.size_);
+      chunk.data_start_ = data_begin - pos;
+      chunk.data_size_ = data_end - data_begin;
+      SliceIoVecs(extent.iov_, data_begin - start, chunk.data_size_,
+                  chunk.iov_);
+      chunks.push_back(std::move(chunk));
+    }
+  }
+  extents.resize(kept);
+  return true;
+}
+
+/**
+ * Split extents at stripe boundaries. Runs of whole stripes stay in
+ * extents; the pieces covering part of a stripe move to partial, one per
+ * stripe touched.
+ * @param stripe_size Stripe size in bytes
+ * @param extents Extents; only the whole-stripe runs are left
+ * @param partial Output: pieces that each lie within one stripe
+ */
+static void SplitStripeExtents(chi::u64 stripe_size,
+                               std::vector<IoExtent> &extents,
+                               std::vector<IoExtent> &partial) {
+  std::vector<IoExtent> whole;
+  for (const IoExtent &extent : extents) {
+    chi::u64 start = extent.file_offset_;
+    chi::u64 end = start + extent.size_;
+    chi::u64 pos = start;
+    while (pos < end) {
+      chi::u64 run_end = end / stripe_size * stripe_size;
+      chi::u64 piece_end = std::min(end, (pos / stripe_size + 1) * stripe_size);
+      bool is_whole = pos % stripe_size == 0 && run_end > pos;
+      if (is_whole) {
+        piece_end = run_end;
+      }
+      IoExtent piece;
+      piece.file_offset_ = pos;
+      piece.size_ = piece_end - pos;
+      SliceIoVecs(extent.iov_, pos - start, piece.size_, piece.iov_);
+      (is_whole ? whole : partial).push_back(std::move(piece));
+      pos = piece_end;
+    }
+  }
+  extents.swap(whole);
+}
+
+/**
+ * Read-modify-write: read the sectors a bounce chunk only partly
+ * overwrites, so the write keeps their other bytes. Bytes past the end of
+ * the file read as zeros.
+ * @param async_io Worker's async I/O backend
+ * @param chunks Bounce chunks of a write
+ * @param tokens Output: token per sector read
+ * @return false if a submission failed
+ */
+static bool SubmitBounceFills(hshm::AsyncIO *async_io,
+                              std::vector<BounceChunk> &chunks,
+                              std::vector<hshm::IoToken> &tokens) {
+  const chi::u64 kAlign = hshm::AsyncIO::kDirectAlignment;
+  for (BounceChunk &chunk : chunks) {
+    chi::u64 data_end = chunk.data_start_ + chunk.data_size_;
+    chi::u64 sectors[2] = {0, chunk.size_ - kAlign};
+    bool partial[2] = {chunk.data_start_ % kAlign != 0,
+                       data_end % kAlign != 0};
+    for (int i = 0; i < 2; ++i) {
+      if (!partial[i] || (i == 1 && partial[0] && sectors[1] == 0)) {
+        continue;
+      }
+      char *sector = chunk.buf_ + sectors[i];
+      memset(sector, 0, kAlign);
+      hshm::IoToken token = async_io->Read(
+          sector, kAlign, static_cast<off_t>(chunk.file_offset_ + sectors[i]));
+      if (token == hshm::kInvalidIoToken) {
+        return false;
+      }
+      tokens.push_back(token);
+    }
+  }
+  return true;
+}
+
+/**
+ * Copy task data between a bounce chunk and the task buffer
+ * @param chunk Bounce chunk
+ * @param to_bounce Gather into the chunk (write) or scatter out of it (read)
+ * @param avail Bytes of the chunk that hold valid data (after a read)
+ * @return Task data bytes copied
+ */
+static chi::u64 CopyBounceChunk(const BounceChunk &chunk, bool to_bounce,
+                                chi::u64 avail) {
+  chi::u64 pos = chunk.data_start_;
+  chi::u64 copied = 0;
+  for (const hshm::IoVec &seg : chunk.iov_) {
+    chi::u64 n = seg.size_;
+    if (!to_bounce) {
+      n = pos < avail ? std::min(n, avail - pos) : 0;
+    }
+    if (n == 0) break;
+    if (to_bounce) {
+      memcpy(chunk.buf_ + pos, seg.base_, n);
+    } else {
+      memcpy(seg.base_, chunk.buf_ + pos, n);
+    }
+    pos += n;
+    copied += n;
+  }
+  return copied;
+}
+
+/**
+ * Submit the aligned transfer of every bounce chunk
+ * @param async_io Worker's async I/O backend
+ * @param chunks Bounce chunks
+ * @param is_write Write if true, read otherwise
+ * @param tokens Output: token per chunk
+ * @param sizes Output: task data bytes per chunk
+ * @return false if a submission failed
+ */
+static bool SubmitBounceChunks(hshm::AsyncIO *async_io,
+                               const std::vector<BounceChunk> &chunks,
+                               bool is_write,
+                               std::vector<hshm::IoToken> &tokens,
+                               std::vector<chi::u64> &sizes) {
+  for (const BounceChunk &chunk : chunks) {
+    off_t offset = static_cast<off_t>(chunk.file_offset_);
+    hshm::IoToken token =
+        is_write ? async_io->Write(chunk.buf_, chunk.size_, offset)
+                 : async_io->Read(chunk.buf_, chunk.size_, offset);
+    if (token == hshm::kInvalidIoToken) {
+      HLOG(kError, "Failed to submit direct {}: offset={}, size={}",
+           is_write ? "write" : "read", offset, chunk.size_);
+      return false;
+    }
+    tokens.push_back(token);
+    sizes.push_back(chunk.data_size_);
+  }
+  return true;
+}
+
+/** Return every chunk's bounce buffer to the worker pool */
+static void ReleaseBounceChunks(WorkerIOContext *io_ctx,
+                                std::vector<BounceChunk> &chunks) {
+  for (BounceChunk &chunk : chunks) {
+    io_ctx->ReleaseBounceBuffer(chunk.buf_);
+  }
+  chunks.clear();
+}
+
+/** Bytes of the device the startup benchmark touches */
+static constexpr chi::u64 kBenchRegion = 64ULL * 1024 * 1024;
+/** Bytes moved by each bandwidth probe */
+static constexpr chi::u64 kBenchProbeBytes = 16ULL * 1024 * 1024;
+/** Transfer size of the latency and IOPS runs */
+static constexpr size_t kBenchSmallIo = 4096;
+/** Queue depth cap of the bandwidth probes, and of the IOPS run */
+static constexpr chi::u32 kBenchBandwidthDepth = 8;
+static constexpr chi::u32 kBenchMaxDepth = 64;
+/** Operations in the latency and IOPS runs */
+static constexpr size_t kBenchLatencyOps = 256;
+static constexpr size_t kBenchIopsOps = 4096;
+
+/** One bandwidth probe: transfer size and queue depth */
+struct BenchProbe {
+  size_t io_size_;
+  chi::u32 depth_;
+};
+
+/** Bandwidth probes; the best of them is the device's bandwidth */
+static constexpr BenchProbe kBenchProbes[] = {
+    {64 * 1024, 1},
+    {64 * 1024, kBenchBandwidthDepth},
+    {1024 * 1024, 1},
+    {1024 * 1024, kBenchBandwidthDepth},
+};
+
+/**
+ * Run count transfers of io_size bytes keeping up to depth in flight, each
+ * slot of buf serving every depth-th operation. Reads visit the units of
+ * the region in order or scattered; a write rewrites its slot's own unit
+ * (slot i -> unit i), so writes after a sequential read of depth units
+ * leave the device contents unchanged.
+ * @return Elapsed seconds, or a negative value if an I/O failed
+ */
+static double TimeBenchIo(hshm::AsyncIO *io, char *buf, size_t io_size,
+                          chi::u32 depth, size_t count, chi::u64 units,
+                          bool is_write, bool scattered) {
+  std::vector<hshm::IoToken> tokens(depth, hshm::kInvalidIoToken);
+  bool ok = true;
+  auto wait = [&](hshm::IoToken &token) {
+    hshm::IoResult result;
+    while (!io->IsComplete(token, result)) {
+    }
+    ok = ok && result.error_code == 0;
+    token = hshm::kInvalidIoToken;
+  };
+  auto start = std::chrono::high_resolution_clock::now();
+  for (size_t k = 0; k < count && ok; ++k) {
+    chi::u32 slot = static_cast<chi::u32>(k % depth);
+    if (tokens[slot] != hshm::kInvalidIoToken) {
+      wait(tokens[slot]);
+    }
+    chi::u64 unit = is_write    ? slot
+                    : scattered ? (k * 2654435761ULL) % units
+                                : k % units;
+    char *slot_buf = buf + static_cast<size_t>(slot) * io_size;
+    off_t offset = static_cast<off_t>(unit * io_size);
+    tokens[slot] = is_write ? io->Write(slot_buf, io_size, offset)
+                            : io->Read(slot_buf, io_size, offset);
+    ok = ok && tokens[slot] != hshm::kInvalidIoToken;
+  }
+  for (hshm::IoToken &token : tokens) {
+    if (token != hshm::kInvalidIoToken) {
+      wait(token);
+    }
   }
+  std::chrono::duration<double> elapsed =
+      std::chrono::high_resolution_clock::now() - start;
+  return ok ? elapsed.count() : -1.0;
+}
 
-  // Pop from the head of the list for this block type
-  if (blocks_[block_type].empty()) {
+/**
+ * Measure latency, bandwidth and IOPS on the first kBenchRegion bytes of a
+ * device: 4KB latency at depth 1, bandwidth as the best of kBenchProbes
+ * and 4KB IOPS at up to kBenchMaxDepth. Every run is bounded in bytes or
+ * operations. Writes only put back data just read from the same place.
+ * @param io Open backend on the device
+ * @param size Usable device bytes
+ * @param io_depth Backend queue depth
+ * @param perf Filled on success
+ * @return true if every run completed
+ */
+static bool BenchmarkDevice(hshm::AsyncIO *io, chi::u64 size,
+                            chi::u32 io_depth, PerfMetrics &perf) {
+  chi::u64 region = std::min(size, kBenchRegion);
+  chi::u32 iops_depth = std::min(io_depth, kBenchMaxDepth);
+  size_t buf_size = iops_depth * kBenchSmallIo;
+  for (const BenchProbe &probe : kBenchProbes) {
+    chi::u32 depth = std::min(io_depth, probe.depth_);
+    if (region < depth * probe.io_size_) {
+      return false;
+    }
+    buf_size = std::max(buf_size, depth * probe.io_size_);
+  }
+  if (iops_depth == 0) {
     return false;
   }
+  void *mem = nullptr;
+  if (posix_memalign(&mem, hshm::AsyncIO::kDirectAlignment, buf_size) != 0) {
+    return false;
+  }
+  char *buf = static_cast<char *>(mem);
+  chi::u64 small_units = region / kBenchSmallIo;
+
+  // Each write run follows a read of the units its slots rewrite, and is
+  // skipped if that read failed so no stale buffer reaches the device
+  double read_lat = TimeBenchIo(io, buf, kBenchSmallIo, 1, kBenchLatencyOps,
+                                small_units, false, true);
+  bool ok = read_lat > 0 && TimeBenchIo(io, buf, kBenchSmallIo, 1, 1,
+                                        small_units, false, false) >= 0;
+  double write_lat = ok ? TimeBenchIo(io, buf, kBenchSmallIo, 1,
+                                      kBenchLatencyOps, small_units, true,
+                                      false)
+                        : -1.0;
+  ok = ok && write_lat > 0;
+  double read_bw = 0;
+  double write_bw = 0;
+  for (const BenchProbe &probe : kBenchProbes) {
+    if (!ok) break;
+    chi::u32 depth = std::min(io_depth, probe.depth_);
+    chi::u64 units = region / probe.io_size_;
+    size_t count = kBenchProbeBytes / probe.io_size_;
+    double mb = static_cast<double>(count * probe.io_size_) /
+                (1024.0 * 1024.0);
+    double t = TimeBenchIo(io, buf, probe.io_size_, depth, count, units,
+                           false, false);
+    ok = t > 0 && TimeBenchIo(io, buf, probe.io_size_, depth, depth, units,
+                              false, false) >= 0;
+    read_bw = ok ? std::max(read_bw, mb / t) : read_bw;
+    t = ok ? TimeBenchIo(io, buf, probe.io_size_, depth, count, units, true,
+                         false)
+           : -1.0;
+    ok = ok && t > 0;
+    write_bw = ok ? std::max(write_bw, mb / t) : write_bw;
+  }
+  double iops = ok ? TimeBenchIo(io, buf, kBenchSmallIo, iops_depth,
+                                 kBenchIopsOps, small_units, false, true)
+                   : -1.0;
+  free(mem);
+  if (!ok || iops <= 0) {
+    return false;
+  }
+  perf.read_latency_us_ = read_lat * 1e6 / kBenchLatencyOps;
+  perf.write_latency_us_ = write_lat * 1e6 / kBenchLatencyOps;
+  perf.read_bandwidth_mbps_ = read_bw;
+  perf.write_bandwidth_mbps_ = write_bw;
+  perf.iops_ = kBenchIopsOps / iops;
+  return true;
+}
 
-  block = blocks_[block_type].front();
-  blocks_[block_type].pop_front();
+/**
+ * Run BenchmarkDevice and log the outcome
+ * @param io Open backend on the device
+ * @param pool_name Bdev name for the log
+ * @param size Usable device bytes
+ * @param io_depth Backend queue depth
+ * @param perf Replaced by the measurements on success
+ * @return true if perf now holds measured values
+ */
+static bool CalibrateDevice(hshm::AsyncIO *io, const std::string &pool_name,
+                            chi::u64 size, chi::u32 io_depth,
+                            PerfMetrics &perf) {
+  PerfMetrics measured;
+  if (!BenchmarkDevice(io, size, io_depth, measured)) {
+    HLOG(kWarning, "Bdev {}: calibration failed, keeping default "
+         "performance metrics", pool_name);
+    return false;
+  }
+  perf = measured;
+  HLOG(kInfo,
+       "Bdev {} calibrated: read {:.0f} MB/s, write {:.0f} MB/s, read "
+       "latency {:.1f} us, write latency {:.1f} us, {:.0f} IOPS",
+       pool_name, measured.read_bandwidth_mbps_,
+       measured.write_bandwidth_mbps_, measured.read_latency_us_,
+       measured.write_latency_us_, measured.iops_);
   return true;
 }
 
-void WorkerBlockMap::FreeBlock(Block block) {
-  int block_type = static_cast<int>(block.block_type_);
-  if (block_type >= 0 &&
-      block_type < static_cast<int>(BlockSizeCategory::kMaxCategories)) {
-    // Append to the block list
-    blocks_[block_type].push_back(block);
+/** statfs f_type of Lustre clients */
+static constexpr long kLustreSuperMagic = 0x0BD00BD0;
+/** statfs f_type of GPFS (Storage Scale) */
+static constexpr long kGpfsSuperMagic = 0x47504653;
+
+/** Stripe layout of a file on a parallel file system */
+struct PfsLayout {
+  const char *fs_name_ = "unknown";  // lustre, gpfs or unknown
+  chi::u64 stripe_size_ = 0;         // 0 if the file system did not say
+  chi::u32 stripe_count_ = 0;
+};
+
+/**
+ * Ask the file system for the stripe layout of a file. Lustre reports it
+ * through llapi_file_get_stripe when built with WRP_CORE_ENABLE_LUSTRE;
+ * otherwise the preferred I/O size (st_blksize), which is the stripe size
+ * on Lustre and the block size on GPFS, stands in with one stripe.
+ * @param path File path
+ * @return Layout; fields the file system did not report stay 0
+ */
+static PfsLayout DiscoverPfsLayout(const std::string &path) {
+  PfsLayout layout;
+  struct statfs fs;
+  if (statfs(path.c_str(), &fs) == 0) {
+    if (static_cast<long>(fs.f_type) == kLustreSuperMagic) {
+      layout.fs_name_ = "lustre";
+    } else if (static_cast<long>(fs.f_type) == kGpfsSuperMagic) {
+      layout.fs_name_ = "gpfs";
+    }
+  }
+#if CHI_BDEV_ENABLE_LUSTRE
+  if (strcmp(layout.fs_name_, "lustre") == 0) {
+    std::vector<char> lum_buf(sizeof(struct lov_user_md_v3) +
+                              LOV_MAX_STRIPE_COUNT *
+                                  sizeof(struct lov_user_ost_data_v1));
+    auto *lum = reinterpret_cast<struct lov_user_md *>(lum_buf.data());
+    if (llapi_file_get_stripe(path.c_str(), lum) == 0) {
+      layout.stripe_size_ = lum->lmm_stripe_size;
+      layout.stripe_count_ = lum->lmm_stripe_count;
+    }
+  }
+#endif
+  struct stat st;
+  if (layout.stripe_size_ == 0 && stat(path.c_str(), &st) == 0 &&
+      st.st_blksize > 0) {
+    layout.stripe_size_ = static_cast<chi::u64>(st.st_blksize);
+  }
+  return layout;
+}
+
+//===========================================================================
+// BlockNodeArena Implementation
+//===========================================================================
+
+BlockNodeArena::BlockNodeArena() : num_chunks_(0) {
+  for (chi::u32 i = 0; i < kMaxChunks; ++i) {
+    chunks_[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+BlockNodeArena::~BlockNodeArena() {
+  for (chi::u32 i = 0; i < kMaxChunks; ++i) {
+    delete[] chunks_[i].load(std::memory_order_relaxed);
+  }
+}
+
+chi::u32 BlockNodeArena::AllocateChunk() {
+  chi::u32 chunk = num_chunks_.fetch_add(1, std::memory_order_relaxed);
+  if (chunk >= kMaxChunks) {
+    num_chunks_.store(kMaxChunks, std::memory_order_relaxed);
+    return kNullNode;
+  }
+  chunks_[chunk].store(new BlockNode[kChunkNodes], std::memory_order_release);
+  return chunk * kChunkNodes;
+}
+
+//===========================================================================
+// BlockNodeStack Implementation
+//===========================================================================
+
+/** Pack an ABA tag and a node index into a stack head */
+static inline chi::u64 PackHead(chi::u32 tag, chi::u32 idx) {
+  return (static_cast<chi::u64>(tag) << 32) | idx;
+}
+
+BlockNodeStack::BlockNodeStack()
+    : head_(PackHead(0, BlockNodeArena::kNullNode)) {}
+
+void BlockNodeStack::PushChain(BlockNodeArena &arena, chi::u32 first,
+                               chi::u32 last) {
+  BlockNode &tail = arena.Get(last);
+  chi::u64 old_head = head_.load(std::memory_order_relaxed);
+  chi::u64 new_head;
+  do {
+    tail.next_.store(static_cast<chi::u32>(old_head),
+                     std::memory_order_relaxed);
+    new_head = PackHead(static_cast<chi::u32>(old_head >> 32) + 1, first);
+  } while (!head_.compare_exchange_weak(old_head, new_head,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed));
+}
+
+chi::u32 BlockNodeStack::Pop(BlockNodeArena &arena) {
+  chi::u64 old_head = head_.load(std::memory_order_acquire);
+  chi::u64 new_head;
+  chi::u32 top;
+  do {
+    top = static_cast<chi::u32>(old_head);
+    if (top == BlockNodeArena::kNullNode) {
+      return BlockNodeArena::kNullNode;
+    }
+    // The tag rejects the CAS if top was popped and pushed again meanwhile
+    chi::u32 next = arena.Get(top).next_.load(std::memory_order_relaxed);
+    new_head = PackHead(static_cast<chi::u32>(old_head >> 32) + 1, next);
+  } while (!head_.compare_exchange_weak(old_head, new_head,
+                                        std::memory_order_acquire,
+                                        std::memory_order_acquire));
+  return top;
+}
+
+//===========================================================================
+// WorkerBlockMap Implementation
+//===========================================================================
+
+WorkerBlockMap::WorkerBlockMap() {
+  for (int i = 0; i < kNumLists; ++i) {
+    heads_[i] = BlockNodeArena::kNullNode;
+    counts_[i] = 0;
+  }
+}
+
+chi::u32 WorkerBlockMap::Pop(BlockNodeArena &arena, int list) {
+  chi::u32 top = heads_[list];
+  if (top == BlockNodeArena::kNullNode) {
+    return top;
   }
+  heads_[list] = arena.Get(top).next_.load(std::memory_order_relaxed);
+  --counts_[list];
+  return top;
+}
+
+void WorkerBlockMap::Push(BlockNodeArena &arena, int list, chi::u32 idx) {
+  arena.Get(idx).next_.store(heads_[list], std::memory_order_relaxed);
+  heads_[list] = idx;
+  ++counts_[list];
+}
+
+chi::u32 WorkerBlockMap::DetachChain(BlockNodeArena &arena, int list,
+                                     chi::u32 count, chi::u32 &last) {
+  chi::u32 first = heads_[list];
+  last = first;
+  for (chi::u32 i = 1; i < count; ++i) {
+    last = arena.Get(last).next_.load(std::memory_order_relaxed);
+  }
+  heads_[list] = arena.Get(last).next_.load(std::memory_order_relaxed);
+  counts_[list] -= count;
+  return first;
 }
 
 //===========================================================================
 // GlobalBlockMap Implementation
 //===========================================================================
 
-GlobalBlockMap::GlobalBlockMap() {}
+GlobalBlockMap::GlobalBlockMap() : heap_(nullptr), cached_bytes_(0) {}
 
-void GlobalBlockMap::Init(size_t num_workers) {
-  // Pre-allocate vectors for specified number of workers
+void GlobalBlockMap::Init(size_t num_workers, Heap *heap) {
+  // Pre-allocate one cache per worker
   worker_maps_.resize(num_workers);
-  worker_locks_.resize(num_workers);
+  heap_ = heap;
 }
 
 int GlobalBlockMap::FindBlockType(size_t io_size) {
@@ -181,113 +902,346 @@ int GlobalBlockMap::FindBlockType(size_t io_size) {
   return FindBlockTypeForSize(io_size, block_size);
 }
 
-bool GlobalBlockMap::AllocateBlock(int worker, size_t io_size, Block &block) {
+WorkerBlockMap *GlobalBlockMap::GetWorkerMap(int worker) {
   if (worker < 0 || static_cast<size_t>(worker) >= worker_maps_.size()) {
+    return nullptr;
+  }
+  return &worker_maps_[static_cast<size_t>(worker)];
+}
+
+chi::u32 GlobalBlockMap::AcquireNode(WorkerBlockMap *local) {
+  chi::u32 idx = BlockNodeArena::kNullNode;
+  if (local != nullptr) {
+    idx = local->Pop(arena_, WorkerBlockMap::kSpareList);
+  }
+  if (idx == BlockNodeArena::kNullNode) {
+    idx = spare_nodes_.Pop(arena_);
+  }
+  if (idx != BlockNodeArena::kNullNode) {
+    return idx;
+  }
+
+  // Out of spare nodes: carve a new chunk and keep all but the first node
+  chi::u32 first = arena_.AllocateChunk();
+  if (first == BlockNodeArena::kNullNode) {
+    return first;
+  }
+  chi::u32 last = first + BlockNodeArena::kChunkNodes - 1;
+  if (local != nullptr) {
+    for (chi::u32 i = last; i > first; --i) {
+      local->Push(arena_, WorkerBlockMap::kSpareList, i);
+    }
+  } else {
+    for (chi::u32 i = first + 1; i < last; ++i) {
+      arena_.Get(i).next_.store(i + 1, std::memory_order_relaxed);
+    }
+    spare_nodes_.PushChain(arena_, first + 1, last);
+  }
+  return first;
+}
+
+void GlobalBlockMap::ReleaseNode(WorkerBlockMap *local, chi::u32 idx) {
+  if (local == nullptr) {
+    spare_nodes_.PushChain(arena_, idx, idx);
+    return;
+  }
+  local->Push(arena_, WorkerBlockMap::kSpareList, idx);
+  if (local->Count(WorkerBlockMap::kSpareList) > kMaxSpareNodes) {
+    chi::u32 last;
+    chi::u32 first = local->DetachChain(arena_, WorkerBlockMap::kSpareList,
+                                        kMaxSpareNodes / 2, last);
+    spare_nodes_.PushChain(arena_, first, last);
+  }
+}
+
+bool GlobalBlockMap::CacheBlock(WorkerBlockMap *local, int block_type,
+                                const Block &block) {
+  chi::u32 idx = AcquireNode(local);
+  if (idx == BlockNodeArena::kNullNode) {
     return false;
   }
+  BlockNode &node = arena_.Get(idx);
+  node.block_ = block;
+  node.block_.block_type_ = static_cast<chi::u32>(block_type);
+  cached_bytes_.fetch_add(block.size_, std::memory_order_relaxed);
+
+  if (local == nullptr || block_type >= kFirstSharedType) {
+    overflow_[block_type].PushChain(arena_, idx, idx);
+    return true;
+  }
 
-  size_t worker_idx = static_cast<size_t>(worker);
+  // Spill half of a full cache so other workers can reuse the blocks
+  if (local->Count(block_type) >= kMaxCachedBlocks) {
+    chi::u32 last;
+    chi::u32 first = local->DetachChain(arena_, block_type,
+                                        kMaxCachedBlocks / 2, last);
+    overflow_[block_type].PushChain(arena_, first, last);
+  }
+  local->Push(arena_, block_type, idx);
+  return true;
+}
 
+bool GlobalBlockMap::AllocateBlock(int worker, size_t io_size, Block &block) {
   // Find the next block size that is larger than this
   int block_type = FindBlockType(io_size);
   if (block_type == -1) {
     return false;  // No suitable cached size
   }
 
-  // Acquire this worker's mutex using ScopedCoMutex
-  {
-    chi::ScopedCoMutex lock(worker_locks_[worker_idx]);
-    // First attempt to allocate from this worker's map
-    if (worker_maps_[worker_idx].AllocateBlock(block_type, block)) {
-      return true;
-    }
+  // Try this worker's cache first, then the shared overflow pool
+  WorkerBlockMap *local = GetWorkerMap(worker);
+  chi::u32 idx = BlockNodeArena::kNullNode;
+  if (local != nullptr && block_type < kFirstSharedType) {
+    idx = local->Pop(arena_, block_type);
   }
-
-  // If we fail, try up to 4 other workers (iterate linearly)
-  size_t num_workers = worker_maps_.size();
-  for (size_t i = 1; i <= 4 && i < num_workers; ++i) {
-    size_t other_worker = (worker_idx + i) % num_workers;
-    chi::ScopedCoMutex lock(worker_locks_[other_worker]);
-    if (worker_maps_[other_worker].AllocateBlock(block_type, block)) {
-      return true;
-    }
+  if (idx == BlockNodeArena::kNullNode) {
+    idx = overflow_[block_type].Pop(arena_);
+  }
+  if (idx == BlockNodeArena::kNullNode) {
+    return false;
   }
 
-  return false;
+  block = arena_.Get(idx).block_;
+  ReleaseNode(local, idx);
+  cached_bytes_.fetch_sub(block.size_, std::memory_order_relaxed);
+  return true;
 }
 
 bool GlobalBlockMap::FreeBlock(int worker, Block &block) {
-  if (worker < 0 || static_cast<size_t>(worker) >= worker_maps_.size()) {
-    return false;
+  WorkerBlockMap *local = GetWorkerMap(worker);
+
+  // Every allocation spans whole 4KB units, so round the end up and carve
+  // the extent into the largest cached sizes that fit
+  const chi::u64 kUnit = kBlockSizes[0];
+  chi::u64 offset = block.offset_;
+  chi::u64 remaining = ((block.size_ + kUnit - 1) / kUnit) * kUnit;
+  bool cached_all = true;
+  while (remaining > 0) {
+    int block_type = FindBlockTypeWithin(remaining);
+    if (block_type < 0) {
+      break;
+    }
+    chi::u64 piece = kBlockSizes[block_type];
+    Block cached(offset, piece, block_type);
+    if (!CacheBlock(local, block_type, cached)) {
+      // No node to track the block; hand it straight back to the heap
+      if (heap_ != nullptr) {
+        heap_->Free(cached);
+      }
+      cached_all = false;
+    }
+    offset += piece;
+    remaining -= piece;
   }
+  return cached_all;
+}
 
-  size_t worker_idx = static_cast<size_t>(worker);
-
-  // Free on this worker's map (with lock for thread safety)
-  chi::ScopedCoMutex lock(worker_locks_[worker_idx]);
-  worker_maps_[worker_idx].FreeBlock(block);
-  return true;
+chi::u64 GlobalBlockMap::Reclaim(int worker) {
+  if (heap_ == nullptr) {
+    return 0;
+  }
+  WorkerBlockMap *local = GetWorkerMap(worker);
+  chi::u64 reclaimed = 0;
+  for (int block_type = 0; block_type < kNumBlockSizes; ++block_type) {
+    while (true) {
+      chi::u32 idx = BlockNodeArena::kNullNode;
+      if (local != nullptr) {
+        idx = local->Pop(arena_, block_type);
+      }
+      if (idx == BlockNodeArena::kNullNode) {
+        idx = overflow_[block_type].Pop(arena_);
+      }
+      if (idx == BlockNodeArena::kNullNode) {
+        break;
+      }
+      Block block = arena_.Get(idx).block_;
+      ReleaseNode(local, idx);
+      cached_bytes_.fetch_sub(block.size_, std::memory_order_relaxed);
+      heap_->Free(block);
+      reclaimed += block.size_;
+    }
+  }
+  return reclaimed;
 }
 
 //===========================================================================
 // Heap Implementation
 //===========================================================================
 
-Heap::Heap() : heap_(0), total_size_(0), alignment_(4096) {}
+Heap::Heap()
+    : heap_(0), free_bytes_(0), base_(0), total_size_(0), alignment_(4096),
+      stripe_(0) {}
 
-void Heap::Init(chi::u64 total_size, chi::u32 alignment) {
+void Heap::Init(chi::u64 total_size, chi::u32 alignment, chi::u64 base,
+                chi::u64 stripe) {
+  hshm::ScopedMutex guard(lock_, 0);
+  base_ = base;
   total_size_ = total_size;
   alignment_ = (alignment == 0) ? 4096 : alignment;
-  heap_.store(0);
+  stripe_ = stripe;
+  free_extents_.clear();
+  free_by_size_.clear();
+  heap_.store(base);
+  free_bytes_.store(0);
 }
 
-bool Heap::Allocate(size_t block_size, int block_type, Block &block) {
-  // Align the requested block size to alignment boundary for O_DIRECT I/O
-  // Formula: aligned_size = ((block_size + alignment_ - 1) / alignment_) *
-  // alignment_
+chi::u64 Heap::AlignSize(chi::u64 size) const {
   chi::u32 alignment = (alignment_ == 0) ? 4096 : alignment_;
+  return ((size + alignment - 1) / alignment) * alignment;
+}
 
-  // Align the requested size
-  chi::u64 aligned_size =
-      ((block_size + alignment - 1) / alignment) * alignment;
-  HLOG(kDebug,
-       "Allocating block: block_size = {}, alignment = {}, aligned_size = {}",
-       block_size, alignment, aligned_size);
+void Heap::InsertExtent(chi::u64 offset, chi::u64 size) {
+  free_extents_.emplace(offset, size);
+  free_by_size_.emplace(size, offset);
+  free_bytes_.fetch_add(size);
+}
 
-  // Atomic fetch-and-add to allocate from heap using aligned size
-  chi::u64 old_heap = heap_.fetch_add(aligned_size);
+std::map<chi::u64, chi::u64>::iterator Heap::EraseExtent(
+    std::map<chi::u64, chi::u64>::iterator it) {
+  free_by_size_.erase(std::make_pair(it->second, it->first));
+  free_bytes_.fetch_sub(it->second);
+  return free_extents_.erase(it);
+}
 
-  if (old_heap + aligned_size > total_size_) {
-    // Out of space - rollback
-    return false;
+bool Heap::Allocate(size_t block_size, int block_type, Block &block) {
+  // Both offset and size stay aligned for O_DIRECT I/O
+  chi::u64 aligned_size = AlignSize(block_size);
+  // On a PFS, blocks of a stripe or more start on a stripe boundary and
+  // end on one, so their writes never share a stripe with another block
+  bool whole_stripes = stripe_ != 0 && aligned_size >= stripe_;
+  if (whole_stripes) {
+    aligned_size = ((aligned_size + stripe_ - 1) / stripe_) * stripe_;
+  }
+  HLOG(kDebug,
+       "Allocating block: block_size = {}, alignment = {}, aligned_size = {}",
+       block_size, alignment_, aligned_size);
+
+  hshm::ScopedMutex guard(lock_, 0);
+
+  // Best fit among reclaimed extents; the head skipped to reach a stripe
+  // boundary and the tail of the extent stay free
+  auto fit = free_by_size_.lower_bound(
+      std::make_pair(aligned_size, static_cast<chi::u64>(0)));
+  for (int scanned = 0; fit != free_by_size_.end() &&
+                        scanned < kMaxStripeFitScan;
+       ++fit, ++scanned) {
+    chi::u64 extent_offset = fit->second;
+    chi::u64 extent_size = fit->first;
+    chi::u64 skip = 0;
+    if (whole_stripes && extent_offset % stripe_ != 0) {
+      skip = stripe_ - extent_offset % stripe_;
+    }
+    if (extent_size < skip + aligned_size) {
+      continue;
+    }
+    EraseExtent(free_extents_.find(extent_offset));
+    if (skip > 0) {
+      InsertExtent(extent_offset, skip);
+    }
+    if (extent_size > skip + aligned_size) {
+      InsertExtent(extent_offset + skip + aligned_size,
+                   extent_size - skip - aligned_size);
+    }
+    block.offset_ = extent_offset + skip;
+    block.size_ = aligned_size;
+    block.block_type_ = static_cast<chi::u32>(block_type);
+    return true;
   }
 
-  // Allocation successful - both offset and size are aligned
+  // Otherwise bump the top of the heap, first padding it to the next stripe
+  // if the block must start there or would straddle one. The padding stays
+  // free for smaller blocks
+  chi::u64 old_heap = heap_.load();
+  chi::u64 pad = 0;
+  if (stripe_ != 0 && old_heap % stripe_ != 0 &&
+      (whole_stripes || old_heap % stripe_ + aligned_size > stripe_)) {
+    pad = stripe_ - old_heap % stripe_;
+  }
+  if (old_heap + pad + aligned_size > base_ + total_size_) {
+    return false;  // Out of space
+  }
+  if (pad > 0) {
+    InsertExtent(old_heap, pad);
+    old_heap += pad;
+  }
+  heap_.store(old_heap + aligned_size);
   block.offset_ = old_heap;
   block.size_ = aligned_size;
   block.block_type_ = static_cast<chi::u32>(block_type);
   return true;
 }
 
+void Heap::Free(const Block &block) {
+  chi::u64 offset = block.offset_;
+  chi::u64 size = AlignSize(block.size_);
+  if (size == 0) {
+    return;
+  }
+
+  hshm::ScopedMutex guard(lock_, 0);
+
+  // Merge with the free extent that starts where this one ends
+  auto next = free_extents_.lower_bound(offset);
+  if (next != free_extents_.end() && next->first == offset + size) {
+    size += next->second;
+    next = EraseExtent(next);
+  }
+
+  // Merge with the free extent that ends where this one starts
+  if (next != free_extents_.begin()) {
+    auto prev = std::prev(next);
+    if (prev->first + prev->second == offset) {
+      offset = prev->first;
+      size += prev->second;
+      EraseExtent(prev);
+    }
+  }
+
+  // Space touching the bump pointer goes back above it
+  if (offset + size == heap_.load()) {
+    heap_.store(offset);
+    return;
+  }
+  InsertExtent(offset, size);
+}
+
 chi::u64 Heap::GetRemainingSize() const {
   chi::u64 current_heap = heap_.load();
-  if (current_heap >= total_size_) {
-    return 0;
+  chi::u64 free_bytes = free_bytes_.load();
+  if (current_heap >= base_ + total_size_) {
+    return free_bytes;
   }
-  return total_size_ - current_heap;
+  return base_ + total_size_ - current_heap + free_bytes;
+}
+
+size_t Heap::GetFreeExtentCount() {
+  hshm::ScopedMutex guard(lock_, 0);
+  return free_extents_.size();
 }
 
 Runtime::~Runtime() {
   // Clean up libaio (only for file-based storage)
-  if (bdev_type_ == BdevType::kFile) {
+  if (bdev_type_ == BdevType::kFile || bdev_type_ == BdevType::kNvme ||
+      bdev_type_ == BdevType::kGds) {
     CleanupAsyncIO();
     CleanupWorkerIOContexts();
   }
 
+#if CHI_BDEV_ENABLE_GDS
+  // Clean up GPUDirect Storage backend
+  if (bdev_type_ == BdevType::kGds) {
+    CleanupGds();
+  }
+#endif
+
   // Clean up RAM backend
   if (bdev_type_ == BdevType::kRam && ram_buffer_ != nullptr) {
-    delete[] ram_buffer_;
+    hshm::SystemInfo::UnmapMemory(ram_buffer_, ram_mapped_size_);
     ram_buffer_ = nullptr;
+    if (!ram_segment_.empty()) {
+      hshm::SystemInfo::CloseSharedMemory(ram_fd_);
+      hshm::SystemInfo::DestroySharedMemory(ram_segment_);
+    }
   }
 
 #if HSHM_ENABLE_CUDA
@@ -336,7 +1290,8 @@ WorkerIOContext *Runtime::GetWorkerIOContext(size_t worker_id) {
 
   // Lazy initialization: initialize on first access
   if (!ctx->is_initialized_) {
-    if (!ctx->Init(file_path_, io_depth_, static_cast<chi::u32>(worker_id))) {
+    if (!ctx->Init(file_path_, io_depth_, io_opts_, io_backend_,
+                   static_cast<chi::u32>(worker_id))) {
       HLOG(kError, "Failed to initialize I/O context for worker {}", worker_id);
       return nullptr;
     }
@@ -359,6 +1314,23 @@ WorkerIOContext *Runtime::GetWorkerIOContext(size_t worker_id) {
   return ctx;
 }
 
+void Runtime::RegisterIoBuffer(WorkerIOContext *io_ctx, const void *data) {
+  if (!io_opts_.fixed_buffers_ || io_ctx == nullptr || !io_ctx->async_io_) {
+    return;
+  }
+  auto *ipc_manager = CHI_IPC;
+  chi::u64 epoch = ipc_manager->GetShmUnmapEpoch();
+  if (epoch != io_ctx->shm_epoch_) {
+    io_ctx->async_io_->UnregisterBuffers();
+    io_ctx->shm_epoch_ = epoch;
+  }
+  char *base = nullptr;
+  size_t size = 0;
+  if (ipc_manager->FindShmSegment(data, &base, &size)) {
+    io_ctx->async_io_->RegisterBuffer(base, size);
+  }
+}
+
 chi::TaskStat Runtime::GetTaskStats(chi::u32 method_id) const {
   switch (method_id) {
     case Method::kWrite:
@@ -396,9 +1368,31 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
 
   // Store backend type
   bdev_type_ = params.bdev_type_;
+  io_opts_.fixed_buffers_ = params.io_fixed_buffers_;
+  io_opts_.batch_submit_ = params.io_batch_submit_;
+  io_opts_.sqpoll_ = params.io_sqpoll_;
+  io_opts_.sqpoll_cpu_ = params.io_sqpoll_cpu_;
+  // Bounced sectors are rewritten whole, so no two blocks may share one
+  direct_io_ = params.direct_io_ &&
+               params.alignment_ % hshm::AsyncIO::kDirectAlignment == 0;
+  if (params.direct_io_ && !direct_io_) {
+    HLOG(kWarning, "Bdev {}: direct_io needs an alignment that is a "
+         "multiple of {}, got {}", pool_name, hshm::AsyncIO::kDirectAlignment,
+         params.alignment_);
+  }
+
+#if !CHI_BDEV_ENABLE_GDS
+  if (bdev_type_ == BdevType::kGds) {
+    HLOG(kError, "Bdev {}: bdev_type gds needs a build with "
+         "WRP_CORE_ENABLE_GDS and libcufile", pool_name);
+    task->return_code_ = 7;
+    CHI_CO_RETURN;
+  }
+#endif
 
-  // Initialize storage backend based on type
-  if (bdev_type_ == BdevType::kFile) {
+  // Initialize storage backend based on type. kGds keeps a regular file:
+  // host buffers use the file path, device buffers go through cuFile
+  if (bdev_type_ == BdevType::kFile || bdev_type_ == BdevType::kGds) {
     // Store file path for per-worker FD creation
     file_path_ = pool_name;
 
@@ -432,28 +1426,50 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
     HLOG(kDebug, "File stat: file_size={}, params.total_size={}", file_size_,
          params.total_size_);
 
-    if (params.total_size_ > 0 && params.total_size_ < file_size_) {
-      file_size_ = params.total_size_;
-    }
-
-    // If file is empty, create it with default size (1GB)
-    if (file_size_ == 0) {
-      file_size_ = (params.total_size_ > 0) ? params.total_size_
-                                            : (1ULL << 30);  // 1GB default
-      HLOG(kDebug,
-           "File is empty, setting file_size_ to {} and calling Truncate",
-           file_size_);
-      if (!setup_io->Truncate(static_cast<size_t>(file_size_))) {
+    // A PFS file is shared by every node and only ever grows
+    pfs_ = params.pfs_ && bdev_type_ == BdevType::kFile;
+    if (pfs_) {
+      if (!SetupPfs(setup_io.get(), params, file_size_)) {
         task->return_code_ = 3;
-        HLOG(kError, "Failed to truncate file: {}", pool_name);
         setup_io->Close();
         CHI_CO_RETURN;
       }
-      HLOG(kDebug, "Truncate succeeded, file_size_={}", file_size_);
+    } else {
+      if (params.total_size_ > 0 && params.total_size_ < file_size_) {
+        file_size_ = params.total_size_;
+      }
+
+      // If file is empty, create it with default size (1GB)
+      if (file_size_ == 0) {
+        file_size_ = (params.total_size_ > 0) ? params.total_size_
+                                              : (1ULL << 30);  // 1GB default
+        HLOG(kDebug,
+             "File is empty, setting file_size_ to {} and calling Truncate",
+             file_size_);
+        if (!setup_io->Truncate(static_cast<size_t>(file_size_))) {
+          task->return_code_ = 3;
+          HLOG(kError, "Failed to truncate file: {}", pool_name);
+          setup_io->Close();
+          CHI_CO_RETURN;
+        }
+        HLOG(kDebug, "Truncate succeeded, file_size_={}", file_size_);
+      }
     }
     HLOG(kDebug, "Create: Final file_size_={}, initializing allocator",
          file_size_);
 
+    // The setup backend was built with the default depth (io_depth_). The
+    // probe covers the start of the file, which only the first PFS region
+    // owns
+    if (params.calibrate_ && pfs_ && region_base_ != 0) {
+      HLOG(kWarning, "Bdev {}: calibrate skipped, the start of the shared "
+           "file belongs to another node", pool_name);
+    } else if (params.calibrate_ && !params.perf_metrics_user_ &&
+               CalibrateDevice(setup_io.get(), pool_name, file_size_,
+                               io_depth_, params.perf_metrics_)) {
+      perf_measured_ = kPerfAll;
+    }
+
     // Close setup I/O — per-worker contexts will open their own
     setup_io->Close();
 
@@ -467,6 +1483,60 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
            "falling back to single FD");
     }
 
+#if CHI_BDEV_ENABLE_GDS
+    if (bdev_type_ == BdevType::kGds) {
+      if (!InitGds()) {
+        task->return_code_ = 7;
+        CHI_CO_RETURN;
+      }
+      if (params.alignment_ % hshm::AsyncIO::kDirectAlignment != 0) {
+        HLOG(kWarning, "GDS bdev {}: alignment {} is not a multiple of {}; "
+             "cuFile falls back to slower unaligned I/O", pool_name,
+             params.alignment_, hshm::AsyncIO::kDirectAlignment);
+      }
+    }
+#endif
+
+  } else if (bdev_type_ == BdevType::kNvme) {
+    // NVMe namespace through io_uring passthrough: the pool name is its
+    // generic char device (/dev/ngXnY). All I/O is direct, so blocks must
+    // not share a bounce sector
+    file_path_ = pool_name;
+    io_backend_ = hshm::AsyncIoBackend::kNvmePassthru;
+    if (params.alignment_ % hshm::AsyncIO::kDirectAlignment != 0) {
+      HLOG(kError, "NVMe bdev {} needs an alignment that is a multiple of {}",
+           pool_name, hshm::AsyncIO::kDirectAlignment);
+      task->return_code_ = 6;
+      CHI_CO_RETURN;
+    }
+    auto setup_io = hshm::AsyncIoFactory::Get(params.io_depth_, io_backend_);
+    if (!setup_io || !setup_io->Open(pool_name, O_RDWR, 0)) {
+      HLOG(kError, "Failed to open NVMe passthrough device: {}", pool_name);
+      task->return_code_ = 1;
+      CHI_CO_RETURN;
+    }
+    ssize_t capacity = setup_io->GetFileSize();
+    if (capacity <= 0) {
+      task->return_code_ = 2;
+      setup_io->Close();
+      CHI_CO_RETURN;
+    }
+    file_size_ = static_cast<chi::u64>(capacity);
+    if (params.total_size_ > 0 && params.total_size_ < file_size_) {
+      file_size_ = params.total_size_;
+    }
+
+    // Replace the default estimates with measured ones unless configured
+    if (!params.perf_metrics_user_ &&
+        CalibrateDevice(setup_io.get(), pool_name, file_size_,
+                        params.io_depth_, params.perf_metrics_)) {
+      perf_measured_ = kPerfAll;
+    }
+    setup_io->Close();
+
+    direct_io_ = true;
+    InitializeWorkerIOContexts();
+
   } else if (bdev_type_ == BdevType::kRam) {
     // RAM-based storage initialization
     if (params.total_size_ == 0) {
@@ -476,12 +1546,10 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
     }
 
     ram_size_ = params.total_size_;
-    ram_buffer_ = new (std::nothrow) char[ram_size_];
-    if (ram_buffer_ == nullptr) {
+    if (!MapRamBuffer(params)) {
       task->return_code_ = 5;
       CHI_CO_RETURN;
     }
-    memset(ram_buffer_, 0, ram_size_);
     file_size_ = ram_size_;  // Use file_size_ for common allocation logic
 
 #if HSHM_ENABLE_CUDA
@@ -501,6 +1569,7 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
     }
     cudaMemset(hbm_buffer_, 0, hbm_size_);
     file_size_ = hbm_size_;
+    EnableHbmPeerAccess();
 
   } else if (bdev_type_ == BdevType::kPinned) {
     // Pinned host memory via cudaMallocHost
@@ -545,8 +1614,9 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
   total_bytes_read_ = 0;
   total_bytes_written_ = 0;
 
-  // Store user-provided performance characteristics
+  // Store configured, calibrated or default performance characteristics
   perf_metrics_ = params.perf_metrics_;
+  perf_metrics_user_ = params.perf_metrics_user_;
 
   // Note: max_blocks_per_operation_ is already initialized in Runtime
   // constructor to 64
@@ -567,8 +1637,10 @@ chi::TaskResume Runtime::AllocateBlocks(hipc::FullPtr<AllocateBlocksTask> task,
        task->pool_id_.major_, task->pool_id_.minor_, task->size_,
        container_id_);
 
-  // Get worker ID for allocation
-  int worker_id = static_cast<int>(GetWorkerID(rctx));
+  // Get worker ID for allocation (threads outside the worker pool bypass the
+  // per-worker caches)
+  int worker_id =
+      CHI_CUR_WORKER ? static_cast<int>(GetWorkerID(rctx)) : -1;
 
   chi::u64 total_size = task->size_;
   if (total_size == 0) {
@@ -581,81 +1653,59 @@ chi::TaskResume Runtime::AllocateBlocks(hipc::FullPtr<AllocateBlocksTask> task,
   // Create local vector in private memory to build up the block list
   std::vector<Block> local_blocks;
 
-  // Divide the I/O request into blocks
-  // If I/O size >= largest cached block, divide into units of that size
-  // Else, just use this I/O size
+  // Divide the I/O request into cached block sizes (e.g. a 16MB request is
+  // a single 16MB block, 5MB is 4MB + 1MB)
   std::vector<size_t> io_divisions;
+  DivideIoSize(total_size, io_divisions);
 
-  const size_t kMaxBlock =
-      kBlockSizes[static_cast<int>(BlockSizeCategory::kMaxCategories) - 1];
-  if (total_size >= kMaxBlock) {
-    // Divide into max-block-sized chunks
-    chi::u64 remaining = total_size;
-    while (remaining >= kMaxBlock) {
-      io_divisions.push_back(kMaxBlock);
-      remaining -= kMaxBlock;
-    }
-    // Add remaining bytes if any
-    if (remaining > 0) {
-      io_divisions.push_back(static_cast<size_t>(remaining));
-    }
-  } else {
-    // Use the entire I/O size as a single division
-    io_divisions.push_back(static_cast<size_t>(total_size));
+  // Check if we would exceed max_blocks limit
+  if (io_divisions.size() > max_blocks_per_operation_) {
+    task->blocks_.clear();
+    HLOG(kError,
+         "Operation requires {} blocks but max_blocks_per_operation is {}",
+         io_divisions.size(), max_blocks_per_operation_);
+    task->return_code_ = 2;  // Too many blocks required
+    CHI_CO_RETURN;
   }
 
-  // For each expected I/O size division, allocate a block
-  for (size_t io_size : io_divisions) {
-    Block block;
-    bool allocated = false;
-
-    // First attempt to allocate from the GlobalBlockMap
-    if (global_block_map_.AllocateBlock(worker_id, io_size, block)) {
-      allocated = true;
-    } else {
-      // If that fails, allocate from heap
-      // Find the appropriate block type and size for this I/O size
-      size_t alloc_size;
-      int block_type = FindBlockTypeForSize(io_size, alloc_size);
-
-      // If no cached size fits, use largest category
-      if (block_type == -1) {
-        block_type = static_cast<int>(BlockSizeCategory::kMaxCategories) - 1;
-      }
+  // Allocate each division. A piece the device cannot place contiguously is
+  // split into pieces of the next smaller size, so free space fragmented
+  // across sizes is still usable
+  std::vector<size_t> pending(io_divisions.rbegin(), io_divisions.rend());
+  while (!pending.empty()) {
+    size_t io_size = pending.back();
+    pending.pop_back();
 
-      if (heap_.Allocate(alloc_size, block_type, block)) {
-        allocated = true;
-      }
+    Block block;
+    if (AllocateIoPiece(worker_id, io_size, block)) {
+      local_blocks.push_back(block);
+      continue;
     }
 
-    // If allocation failed, clean up and return error
-    if (!allocated) {
-      // Return all allocated blocks to the GlobalBlockMap
-      for (Block &allocated_block : local_blocks) {
-        global_block_map_.FreeBlock(worker_id, allocated_block);
-      }
-      task->blocks_.clear();
-      // HLOG(kError, "Out of space: {} bytes requested", total_size);
-      task->return_code_ = 1;  // Out of space
-      CHI_CO_RETURN;
+    size_t alloc_size;
+    int block_type = FindBlockTypeForSize(io_size, alloc_size);
+    if (block_type == -1) {
+      block_type = kNumBlockSizes - 1;
     }
-
-    // Check if we would exceed max_blocks limit
-    if (local_blocks.size() >= max_blocks_per_operation_) {
-      // Return all allocated blocks to the GlobalBlockMap
-      for (Block &allocated_block : local_blocks) {
-        global_block_map_.FreeBlock(worker_id, allocated_block);
+    if (block_type > 0) {
+      size_t piece = kBlockSizes[block_type - 1];
+      size_t num_pieces = (io_size + piece - 1) / piece;
+      if (local_blocks.size() + pending.size() + num_pieces <=
+          max_blocks_per_operation_) {
+        for (size_t i = num_pieces; i > 0; --i) {
+          pending.push_back(std::min(piece, io_size - (i - 1) * piece));
+        }
+        continue;
       }
-      task->blocks_.clear();
-      HLOG(kError,
-           "Operation requires {} blocks but max_blocks_per_operation is {}",
-           io_divisions.size(), max_blocks_per_operation_);
-      task->return_code_ = 2;  // Too many blocks required
-      CHI_CO_RETURN;
     }
 
-    // Add the allocated block to the local vector
-    local_blocks.push_back(block);
+    // Out of space: return all allocated blocks to the GlobalBlockMap
+    for (Block &allocated_block : local_blocks) {
+      FreeIoBlock(worker_id, allocated_block);
+    }
+    task->blocks_.clear();
+    task->return_code_ = 1;  // Out of space
+    CHI_CO_RETURN;
   }
 
   // Copy the local vector to the task's shared memory vector using assignment
@@ -679,14 +1729,14 @@ chi::TaskResume Runtime::FreeBlocks(hipc::FullPtr<FreeBlocksTask> task,
                                     chi::RunContext &ctx) {
   chi::RunContext& rctx = ctx;
   CHI_TASK_BODY_BEGIN
-  // Get worker ID for free operation
-  int worker_id = static_cast<int>(GetWorkerID(rctx));
+  // Get worker ID for free operation (threads outside the worker pool bypass
+  // the per-worker caches)
+  int worker_id =
+      CHI_CUR_WORKER ? static_cast<int>(GetWorkerID(rctx)) : -1;
 
   // Free all blocks in the vector using GlobalBlockMap
   for (size_t i = 0; i < task->blocks_.size(); ++i) {
-    Block block_copy = task->blocks_[i];  // Make a copy since FreeBlock takes
-                                          // non-const reference
-    global_block_map_.FreeBlock(worker_id, block_copy);
+    FreeIoBlock(worker_id, task->blocks_[i]);
   }
 
   task->return_code_ = 0;
@@ -698,8 +1748,14 @@ chi::TaskResume Runtime::Write(hipc::FullPtr<WriteTask> task,
                                chi::RunContext &ctx) {
   chi::RunContext& rctx = ctx;
   CHI_TASK_BODY_BEGIN
+  // A multi-extent task's length_ spans gaps that carry no data
+  chi::u64 inflight = task->data_offsets_.empty() ? task->length_
+                                                 : GetTaskDataBytes(*task);
+  inflight_bytes_.fetch_add(inflight);
+  inflight_ios_.fetch_add(1);
   switch (bdev_type_) {
     case BdevType::kFile:
+    case BdevType::kNvme:
       CHI_CO_AWAIT(WriteToFile(task, rctx));
       break;
     case BdevType::kRam:
@@ -712,16 +1768,23 @@ chi::TaskResume Runtime::Write(hipc::FullPtr<WriteTask> task,
     case BdevType::kPinned:
       co_await WriteToPinned(task, ctx);
       break;
+#endif
+#if CHI_BDEV_ENABLE_GDS
+    case BdevType::kGds:
+      co_await WriteToGds(task, ctx);
+      break;
 #endif
     case BdevType::kNoop:
       task->return_code_ = 0;
-      task->bytes_written_ = task->length_;
+      task->bytes_written_ = inflight;
       break;
     default:
       task->return_code_ = 1;
       task->bytes_written_ = 0;
       break;
   }
+  inflight_ios_.fetch_sub(1);
+  inflight_bytes_.fetch_sub(inflight);
   CHI_CO_RETURN;
   CHI_TASK_BODY_END
 }
@@ -730,8 +1793,14 @@ chi::TaskResume Runtime::Read(hipc::FullPtr<ReadTask> task,
                               chi::RunContext &ctx) {
   chi::RunContext& rctx = ctx;
   CHI_TASK_BODY_BEGIN
+  // A multi-extent task's length_ spans gaps that carry no data
+  chi::u64 inflight = task->data_offsets_.empty() ? task->length_
+                                                 : GetTaskDataBytes(*task);
+  inflight_bytes_.fetch_add(inflight);
+  inflight_ios_.fetch_add(1);
   switch (bdev_type_) {
     case BdevType::kFile:
+    case BdevType::kNvme:
       CHI_CO_AWAIT(ReadFromFile(task, rctx));
       break;
     case BdevType::kRam:
@@ -744,20 +1813,44 @@ chi::TaskResume Runtime::Read(hipc::FullPtr<ReadTask> task,
     case BdevType::kPinned:
       co_await ReadFromPinned(task, ctx);
       break;
+#endif
+#if CHI_BDEV_ENABLE_GDS
+    case BdevType::kGds:
+      co_await ReadFromGds(task, ctx);
+      break;
 #endif
     case BdevType::kNoop:
       task->return_code_ = 0;
-      task->bytes_read_ = task->length_;
+      task->bytes_read_ = inflight;
       break;
     default:
       task->return_code_ = 1;
       task->bytes_read_ = 0;
       break;
   }
+  inflight_ios_.fetch_sub(1);
+  inflight_bytes_.fetch_sub(inflight);
   CHI_CO_RETURN;
   CHI_TASK_BODY_END
 }
 
+chi::TaskResume Runtime::WaitIoTokens(
+    WorkerIOContext *io_ctx, const std::vector<hshm::IoToken> &tokens,
+    std::vector<hshm::IoResult> &results) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  results.assign(tokens.size(), hshm::IoResult());
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    while (!io_ctx->async_io_->IsComplete(tokens[i], results[i])) {
+      CHI_CO_AWAIT(chi::yield(10.0));
+    }
+  }
+  CHI_CO_RETURN;
+}
+
 chi::TaskResume Runtime::WriteToFile(hipc::FullPtr<WriteTask> task,
                                      chi::RunContext &ctx) {
   chi::RunContext& rctx = ctx;
@@ -768,56 +1861,106 @@ chi::TaskResume Runtime::WriteToFile(hipc::FullPtr<WriteTask> task,
   auto *ipc_mgr = CHI_IPC;
   hipc::FullPtr<char> data_ptr = ipc_mgr->ToFullPtr(task->data_).Cast<char>();
 
-  chi::u64 total_bytes_written = 0;
-  chi::u64 data_offset = 0;
-
-  for (size_t i = 0; i < task->blocks_.size(); ++i) {
-    const Block &block = task->blocks_[i];
-
-    chi::u64 remaining = task->length_ - total_bytes_written;
-    if (remaining == 0) break;
-    chi::u64 block_write_size = std::min(remaining, block.size_);
-
-    void *block_data = data_ptr.ptr_ + data_offset;
+  if (io_ctx == nullptr || !io_ctx->is_initialized_ || !io_ctx->async_io_) {
+    HLOG(kError, "WriteToFile called with invalid I/O context");
+    task->return_code_ = 1;
+    task->bytes_written_ = 0;
+    CHI_CO_RETURN;
+  }
+  RegisterIoBuffer(io_ctx, data_ptr.ptr_);
+  hshm::AsyncIO *async_io = io_ctx->async_io_.get();
+
+  // Submit every extent before waiting on any, so they reach the device
+  // together instead of one round trip per block. File-adjacent blocks go
+  // out as a single vectored write.
+  std::vector<IoExtent> extents;
+  BuildIoExtents(*task, data_ptr.ptr_, extents);
+  std::vector<BounceChunk> bounces;
+  std::vector<hshm::IoToken> tokens;
+  std::vector<chi::u64> sizes;
+  std::vector<hshm::IoResult> results;
+  hshm::Timer io_timer;
+  io_timer.Resume();
+  task->return_code_ = 0;
 
-    if (io_ctx == nullptr || !io_ctx->is_initialized_ || !io_ctx->async_io_) {
-      HLOG(kError, "WriteToFile called with invalid I/O context");
-      task->return_code_ = 1;
-      task->bytes_written_ = total_bytes_written;
-      CHI_CO_RETURN;
+  // On a PFS, pieces covering part of a stripe are staged until the stripe
+  // fills; whole stripes replace any staged copy and go out now
+  chi::u64 staged_bytes = 0;
+  if (pfs_) {
+    std::vector<IoExtent> partial;
+    SplitStripeExtents(stripe_size_, extents, partial);
+    CHI_CO_AWAIT(SettleStripes(io_ctx, extents, true));
+    bool staged_ok = true;
+    CHI_CO_AWAIT(StageStripeWrites(io_ctx, partial, staged_ok));
+    if (!staged_ok) {
+      task->return_code_ = 4;
+    }
+    for (const IoExtent &piece : partial) {
+      staged_bytes += piece.size_;
     }
+  }
 
-    hshm::IoToken token = io_ctx->async_io_->Write(
-        block_data, static_cast<size_t>(block_write_size),
-        static_cast<off_t>(block.offset_));
-    if (token == hshm::kInvalidIoToken) {
-      HLOG(kError, "Failed to submit async write: offset={}, size={}",
-           block.offset_, block_write_size);
+  if (UseDirectIo(io_ctx) &&
+      !SplitUnalignedExtents(io_ctx, extents, bounces)) {
+    HLOG(kError, "WriteToFile failed to allocate a bounce buffer");
+    task->return_code_ = 3;
+  }
+
+  // Bounced data only partly covers its first and last sectors: read them
+  // before copying the task data over the rest
+  if (task->return_code_ == 0 && !bounces.empty()) {
+    if (!SubmitBounceFills(async_io, bounces, tokens)) {
       task->return_code_ = 2;
-      task->bytes_written_ = total_bytes_written;
-      CHI_CO_RETURN;
     }
-
-    hshm::IoResult result;
-    while (!io_ctx->async_io_->IsComplete(token, result)) {
-      CHI_CO_AWAIT(chi::yield(10.0));
+    CHI_CO_AWAIT(WaitIoTokens(io_ctx, tokens, results));
+    for (const hshm::IoResult &result : results) {
+      if (result.error_code != 0) task->return_code_ = 4;
     }
+    for (const BounceChunk &chunk : bounces) {
+      CopyBounceChunk(chunk, true, chunk.size_);
+    }
+    tokens.clear();
+  }
+
+  chi::u64 trace_submit_ns = chi::TaskTracer::Stamp();
+  if (task->return_code_ == 0 &&
+      (!SubmitIoExtents(async_io, extents, true, tokens, sizes) ||
+       !SubmitBounceChunks(async_io, bounces, true, tokens, sizes))) {
+    task->return_code_ = 2;
+  }
 
-    if (result.error_code != 0) {
-      HLOG(kError, "Async write failed: error_code={}", result.error_code);
+  // In batch mode the first poll waits one yield, so the writes of the other
+  // tasks on this worker are submitted with ours
+  if (io_opts_.batch_submit_ && !tokens.empty()) {
+    CHI_CO_AWAIT(chi::yield());
+  }
+
+  // Wait for everything submitted, even after an error: the I/O still
+  // references the task's buffer
+  CHI_CO_AWAIT(WaitIoTokens(io_ctx, tokens, results));
+  ReleaseBounceChunks(io_ctx, bounces);
+  chi::u64 total_bytes_written = 0;
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    if (results[i].error_code != 0) {
+      HLOG(kError, "Async write failed: error_code={}", results[i].error_code);
       task->return_code_ = 4;
-      task->bytes_written_ = total_bytes_written;
-      CHI_CO_RETURN;
+      continue;
     }
-
-    chi::u64 actual_bytes = std::min(
-        static_cast<chi::u64>(result.bytes_transferred), block_write_size);
-    total_bytes_written += actual_bytes;
-    data_offset += actual_bytes;
+    total_bytes_written += std::min(
+        static_cast<chi::u64>(results[i].bytes_transferred), sizes[i]);
   }
 
-  task->return_code_ = 0;
-  task->bytes_written_ = total_bytes_written;
+  task->bytes_written_ = total_bytes_written + staged_bytes;
+  if (trace_submit_ns && !tokens.empty()) {
+    chi::TaskTracer::RecordBdevIo(pool_id_, true, trace_submit_ns,
+                                  chi::TaskTracer::Now(), total_bytes_written,
+                                  tokens.size());
+  }
+  if (task->return_code_ != 0) {
+    CHI_CO_RETURN;
+  }
+  io_timer.Pause();
+  RecordIoSample(true, total_bytes_written, io_timer.GetUsec());
   total_writes_.fetch_add(1);
   total_bytes_written_.fetch_add(task->bytes_written_);
   CHI_CO_RETURN;
@@ -834,60 +1977,411 @@ chi::TaskResume Runtime::ReadFromFile(hipc::FullPtr<ReadTask> task,
   auto *ipc_mgr = CHI_IPC;
   hipc::FullPtr<char> data_ptr = ipc_mgr->ToFullPtr(task->data_).Cast<char>();
 
+  if (io_ctx == nullptr || !io_ctx->is_initialized_ || !io_ctx->async_io_) {
+    HLOG(kError, "ReadFromFile called with invalid I/O context");
+    task->return_code_ = 1;
+    task->bytes_read_ = 0;
+    CHI_CO_RETURN;
+  }
+  RegisterIoBuffer(io_ctx, data_ptr.ptr_);
+  hshm::AsyncIO *async_io = io_ctx->async_io_.get();
+
+  // Submit every extent before waiting on any (see WriteToFile)
+  std::vector<IoExtent> extents;
+  BuildIoExtents(*task, data_ptr.ptr_, extents);
+  if (pfs_) {
+    // Staged stripes reach the file before it is read
+    CHI_CO_AWAIT(SettleStripes(io_ctx, extents, false));
+  }
+  std::vector<BounceChunk> bounces;
+  std::vector<hshm::IoToken> tokens;
+  std::vector<chi::u64> sizes;
+  std::vector<hshm::IoResult> results;
+  hshm::Timer io_timer;
+  io_timer.Resume();
+  task->return_code_ = 0;
+  if (UseDirectIo(io_ctx) &&
+      !SplitUnalignedExtents(io_ctx, extents, bounces)) {
+    HLOG(kError, "ReadFromFile failed to allocate a bounce buffer");
+    task->return_code_ = 3;
+  }
+  chi::u64 trace_submit_ns = chi::TaskTracer::Stamp();
+  if (task->return_code_ == 0 &&
+      !SubmitIoExtents(async_io, extents, false, tokens, sizes)) {
+    task->return_code_ = 2;
+  }
+  size_t num_extent_tokens = tokens.size();
+  if (task->return_code_ == 0 &&
+      !SubmitBounceChunks(async_io, bounces, false, tokens, sizes)) {
+    task->return_code_ = 2;
+  }
+
+  if (io_opts_.batch_submit_ && !tokens.empty()) {
+    CHI_CO_AWAIT(chi::yield());
+  }
+
+  CHI_CO_AWAIT(WaitIoTokens(io_ctx, tokens, results));
   chi::u64 total_bytes_read = 0;
-  chi::u64 data_offset = 0;
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    if (results[i].error_code != 0) {
+      HLOG(kError, "Async read failed: error_code={}", results[i].error_code);
+      task->return_code_ = 4;
+      continue;
+    }
+    chi::u64 transferred = static_cast<chi::u64>(results[i].bytes_transferred);
+    if (i < num_extent_tokens) {
+      total_bytes_read += std::min(transferred, sizes[i]);
+    } else {
+      // Bounce chunks land in the task buffer only now
+      total_bytes_read += CopyBounceChunk(bounces[i - num_extent_tokens],
+                                          false, transferred);
+    }
+  }
+  ReleaseBounceChunks(io_ctx, bounces);
 
-  for (size_t i = 0; i < task->blocks_.size(); ++i) {
-    const Block &block = task->blocks_[i];
+  task->bytes_read_ = total_bytes_read;
+  if (trace_submit_ns && !tokens.empty()) {
+    chi::TaskTracer::RecordBdevIo(pool_id_, false, trace_submit_ns,
+                                  chi::TaskTracer::Now(), total_bytes_read,
+                                  tokens.size());
+  }
+  if (task->return_code_ != 0) {
+    CHI_CO_RETURN;
+  }
+  io_timer.Pause();
+  RecordIoSample(false, total_bytes_read, io_timer.GetUsec());
+  total_reads_.fetch_add(1);
+  total_bytes_read_.fetch_add(total_bytes_read);
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
 
-    chi::u64 remaining = task->length_ - total_bytes_read;
-    if (remaining == 0) break;
-    chi::u64 block_read_size = std::min(remaining, block.size_);
+//===========================================================================
+// Parallel file system staging
+//===========================================================================
 
-    void *block_data = data_ptr.ptr_ + data_offset;
+/** @return Monotonic time in nanoseconds */
+static chi::u64 SteadyNowNs() {
+  return static_cast<chi::u64>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
 
-    if (io_ctx == nullptr || !io_ctx->is_initialized_ || !io_ctx->async_io_) {
-      HLOG(kError, "ReadFromFile called with invalid I/O context");
-      task->return_code_ = 1;
-      task->bytes_read_ = total_bytes_read;
-      CHI_CO_RETURN;
+bool Runtime::SetupPfs(hshm::AsyncIO *setup_io, const CreateParams &params,
+                       chi::u64 current_size) {
+  PfsLayout layout = DiscoverPfsLayout(file_path_);
+  stripe_size_ = params.pfs_stripe_size_ != 0 ? params.pfs_stripe_size_
+                                              : layout.stripe_size_;
+  stripe_count_ = params.pfs_stripe_count_ != 0 ? params.pfs_stripe_count_
+                                                : layout.stripe_count_;
+  if (stripe_size_ == 0) {
+    stripe_size_ = 1024 * 1024;  // The Lustre default
+  }
+  if (stripe_count_ == 0) {
+    stripe_count_ = 1;
+  }
+  // Stripes hold whole allocation units, so no block straddles two
+  chi::u64 align = (params.alignment_ == 0) ? 4096 : params.alignment_;
+  stripe_size_ = (stripe_size_ + align - 1) / align * align;
+  pfs_max_staged_ = std::max<chi::u32>(1, params.pfs_max_staged_);
+  pfs_flush_ns_ = static_cast<chi::u64>(params.pfs_flush_ms_) * 1000000ULL;
+
+  // Regions span whole stripe widths: no stripe has two owners, and each
+  // node's writes still spread over every server. Nodes take the region of
+  // their position in the hostfile
+  chi::u64 width = stripe_size_ * stripe_count_;
+  chi::u64 wanted = (params.total_size_ > 0) ? params.total_size_
+                                             : (1ULL << 30);  // 1GB default
+  chi::u64 region = (wanted + width - 1) / width * width;
+  auto *ipc_manager = CHI_IPC;
+  const std::vector<chi::Host> &hosts = ipc_manager->GetAllHosts();
+  chi::u64 node_id = ipc_manager->GetNodeId();
+  size_t num_regions = 1;
+  size_t index = 0;
+  for (size_t i = 0; i < hosts.size(); ++i) {
+    if (hosts[i].node_id == node_id) {
+      index = i;
+      num_regions = hosts.size();
+      break;
+    }
+  }
+  region_base_ = index * region;
+  file_size_ = region;
+
+  // Every node grows the file to hold all regions; none shrinks it
+  chi::u64 file_len = num_regions * region;
+  if (current_size < file_len &&
+      !setup_io->Truncate(static_cast<size_t>(file_len))) {
+    HLOG(kError, "Bdev {}: failed to grow the shared file to {} bytes",
+         file_path_, file_len);
+    return false;
+  }
+  HLOG(kInfo,
+       "Bdev {} on {}: stripe size {}, stripe count {}, region {} of {} at "
+       "offset {} ({} bytes)",
+       file_path_, layout.fs_name_, stripe_size_, stripe_count_, index,
+       num_regions, region_base_, region);
+  return true;
+}
+
+chi::u64 Runtime::StagedStripe::MarkDirty(chi::u64 begin, chi::u64 end) {
+  chi::u64 before = dirty_bytes_;
+  // Merge with every range that overlaps or touches [begin, end)
+  auto it = dirty_.upper_bound(begin);
+  if (it != dirty_.begin() && std::prev(it)->second >= begin) {
+    --it;
+  }
+  while (it != dirty_.end() && it->first <= end) {
+    begin = std::min(begin, it->first);
+    end = std::max(end, it->second);
+    dirty_bytes_ -= it->second - it->first;
+    it = dirty_.erase(it);
+  }
+  dirty_.emplace(begin, end);
+  dirty_bytes_ += end - begin;
+  return dirty_bytes_ - before;
+}
+
+Runtime::StageResult Runtime::TryStagePiece(const IoExtent &piece,
+                                            chi::u64 &victim, bool &full) {
+  chi::u64 stripe = piece.file_offset_ / stripe_size_;
+  chi::u64 begin = piece.file_offset_ - stripe * stripe_size_;
+  hshm::ScopedMutex guard(stage_lock_, 0);
+  auto it = staged_stripes_.find(stripe);
+  if (it == staged_stripes_.end()) {
+    if (staged_stripes_.size() >= pfs_max_staged_) {
+      // Make room by writing out the stripe staged longest ago
+      bool found = false;
+      chi::u64 oldest_ns = 0;
+      for (const auto &entry : staged_stripes_) {
+        if (!entry.second->flushing_ &&
+            (!found || entry.second->staged_ns_ < oldest_ns)) {
+          found = true;
+          oldest_ns = entry.second->staged_ns_;
+          victim = entry.first;
+        }
+      }
+      return found ? StageResult::kEvict : StageResult::kWait;
+    }
+    void *mem = nullptr;
+    if (posix_memalign(&mem, hshm::AsyncIO::kDirectAlignment,
+                       stripe_size_) != 0) {
+      return StageResult::kNoMemory;
     }
+    auto staged = std::make_unique<StagedStripe>();
+    staged->data_ = static_cast<char *>(mem);
+    staged->staged_ns_ = SteadyNowNs();
+    it = staged_stripes_.emplace(stripe, std::move(staged)).first;
+  } else if (it->second->flushing_) {
+    return StageResult::kWait;
+  }
 
-    hshm::IoToken token = io_ctx->async_io_->Read(
-        block_data, static_cast<size_t>(block_read_size),
-        static_cast<off_t>(block.offset_));
-    if (token == hshm::kInvalidIoToken) {
-      HLOG(kError, "Failed to submit async read: offset={}, size={}",
-           block.offset_, block_read_size);
-      task->return_code_ = 2;
-      task->bytes_read_ = total_bytes_read;
-      CHI_CO_RETURN;
+  StagedStripe &staged = *it->second;
+  char *dst = staged.data_ + begin;
+  for (const hshm::IoVec &seg : piece.iov_) {
+    memcpy(dst, seg.base_, seg.size_);
+    dst += seg.size_;
+  }
+  staged_bytes_.fetch_add(staged.MarkDirty(begin, begin + piece.size_));
+  full = staged.dirty_bytes_ == stripe_size_;
+  return StageResult::kStaged;
+}
+
+chi::TaskResume Runtime::StageStripeWrites(WorkerIOContext *io_ctx,
+                                           const std::vector<IoExtent> &pieces,
+                                           bool &ok) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  ok = true;
+  for (const IoExtent &piece : pieces) {
+    while (true) {
+      chi::u64 victim = 0;
+      bool full = false;
+      StageResult result = TryStagePiece(piece, victim, full);
+      if (result == StageResult::kNoMemory) {
+        HLOG(kError, "Bdev {}: no buffer to stage a partial stripe",
+             file_path_);
+        ok = false;
+        break;
+      }
+      if (result == StageResult::kWait) {
+        CHI_CO_AWAIT(chi::yield(10.0));
+        continue;
+      }
+      // A full stripe, or the victim of an eviction, goes out whole
+      bool flushed = true;
+      chi::u64 stripe = (result == StageResult::kEvict)
+                            ? victim
+                            : piece.file_offset_ / stripe_size_;
+      if (result == StageResult::kEvict || full) {
+        CHI_CO_AWAIT(FlushStripe(io_ctx, stripe, flushed));
+        ok = ok && flushed;
+      }
+      if (result == StageResult::kStaged) {
+        break;
+      }
+    }
+  }
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::FlushStripe(WorkerIOContext *io_ctx, chi::u64 stripe,
+                                     bool &ok) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  ok = true;
+  // Claim the stripe; it stays in the map so readers and writers wait
+  StagedStripe *staged = nullptr;
+  {
+    hshm::ScopedMutex guard(stage_lock_, 0);
+    auto it = staged_stripes_.find(stripe);
+    if (it != staged_stripes_.end() && !it->second->flushing_) {
+      it->second->flushing_ = true;
+      staged = it->second.get();
     }
+  }
+  if (staged == nullptr) {
+    CHI_CO_RETURN;
+  }
+
+  hshm::AsyncIO *async_io = io_ctx->async_io_.get();
+  off_t offset = static_cast<off_t>(stripe * stripe_size_);
+  std::vector<hshm::IoToken> tokens;
+  std::vector<hshm::IoResult> results;
+
+  // Bytes no write covered keep what the file holds: read the stripe into
+  // scratch and copy the gaps around the dirty ranges
+  if (staged->dirty_bytes_ < stripe_size_) {
+    void *mem = nullptr;
+    if (posix_memalign(&mem, hshm::AsyncIO::kDirectAlignment,
+                       stripe_size_) != 0) {
+      mem = nullptr;
+      ok = false;
+    }
+    if (ok) {
+      memset(mem, 0, stripe_size_);
+      hshm::IoToken token = async_io->Read(mem, stripe_size_, offset);
+      ok = token != hshm::kInvalidIoToken;
+      if (ok) {
+        tokens.push_back(token);
+        CHI_CO_AWAIT(WaitIoTokens(io_ctx, tokens, results));
+        ok = results[0].error_code == 0;
+        tokens.clear();
+      }
+    }
+    if (ok) {
+      char *scratch = static_cast<char *>(mem);
+      chi::u64 pos = 0;
+      for (const auto &range : staged->dirty_) {
+        memcpy(staged->data_ + pos, scratch + pos, range.first - pos);
+        pos = range.second;
+      }
+      memcpy(staged->data_ + pos, scratch + pos, stripe_size_ - pos);
+      stripe_fills_.fetch_add(1);
+    }
+    free(mem);
+  }
+
+  if (ok) {
+    hshm::IoToken token = async_io->Write(staged->data_, stripe_size_, offset);
+    ok = token != hshm::kInvalidIoToken;
+    if (ok) {
+      tokens.push_back(token);
+      CHI_CO_AWAIT(WaitIoTokens(io_ctx, tokens, results));
+      ok = results[0].error_code == 0 &&
+           static_cast<chi::u64>(results[0].bytes_transferred) ==
+               stripe_size_;
+    }
+  }
+  if (ok) {
+    stripe_writes_.fetch_add(1);
+  } else {
+    HLOG(kError, "Bdev {}: writing staged stripe {} failed, {} bytes lost",
+         file_path_, stripe, staged->dirty_bytes_);
+  }
 
-    hshm::IoResult result;
-    while (!io_ctx->async_io_->IsComplete(token, result)) {
-      CHI_CO_AWAIT(chi::yield(10.0));
-    }
+  hshm::ScopedMutex guard(stage_lock_, 0);
+  staged_bytes_.fetch_sub(staged->dirty_bytes_);
+  staged_stripes_.erase(stripe);
+  CHI_CO_RETURN;
+}
 
-    if (result.error_code != 0) {
-      HLOG(kError, "Async read failed: error_code={}", result.error_code);
-      task->return_code_ = 4;
-      task->bytes_read_ = total_bytes_read;
-      CHI_CO_RETURN;
+chi::TaskResume Runtime::FlushStagedStripes(WorkerIOContext *io_ctx,
+                                            chi::u64 min_age_ns) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  std::vector<chi::u64> due;
+  {
+    hshm::ScopedMutex guard(stage_lock_, 0);
+    chi::u64 now_ns = SteadyNowNs();
+    for (const auto &entry : staged_stripes_) {
+      if (!entry.second->flushing_ &&
+          now_ns - entry.second->staged_ns_ >= min_age_ns) {
+        due.push_back(entry.first);
+      }
     }
-
-    chi::u64 actual_bytes = std::min(
-        static_cast<chi::u64>(result.bytes_transferred), block_read_size);
-    total_bytes_read += actual_bytes;
-    data_offset += actual_bytes;
   }
+  for (chi::u64 stripe : due) {
+    bool flushed;
+    CHI_CO_AWAIT(FlushStripe(io_ctx, stripe, flushed));
+  }
+  CHI_CO_RETURN;
+}
 
-  task->return_code_ = 0;
-  task->bytes_read_ = total_bytes_read;
-  total_reads_.fetch_add(1);
-  total_bytes_read_.fetch_add(total_bytes_read);
+chi::TaskResume Runtime::SettleStripes(WorkerIOContext *io_ctx,
+                                       const std::vector<IoExtent> &extents,
+                                       bool is_write) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  for (const IoExtent &extent : extents) {
+    if (staged_bytes_.load() == 0) {
+      break;
+    }
+    chi::u64 first = extent.file_offset_ / stripe_size_;
+    chi::u64 last = (extent.file_offset_ + extent.size_ - 1) / stripe_size_;
+    for (chi::u64 stripe = first; stripe <= last; ++stripe) {
+      while (true) {
+        bool staged = false;
+        bool flushing = false;
+        {
+          hshm::ScopedMutex guard(stage_lock_, 0);
+          auto it = staged_stripes_.find(stripe);
+          if (it != staged_stripes_.end()) {
+            staged = true;
+            flushing = it->second->flushing_;
+            if (is_write && !flushing) {
+              staged_bytes_.fetch_sub(it->second->dirty_bytes_);
+              staged_stripes_.erase(it);
+              staged = false;
+            }
+          }
+        }
+        if (!staged) {
+          break;
+        }
+        if (flushing) {
+          CHI_CO_AWAIT(chi::yield(10.0));
+          continue;
+        }
+        bool flushed;
+        CHI_CO_AWAIT(FlushStripe(io_ctx, stripe, flushed));
+      }
+    }
+  }
   CHI_CO_RETURN;
-  CHI_TASK_BODY_END
 }
 
 chi::TaskResume Runtime::Update(hipc::FullPtr<UpdateTask> task,
@@ -900,6 +2394,59 @@ chi::TaskResume Runtime::Update(hipc::FullPtr<UpdateTask> task,
 }
 
 #if HSHM_ENABLE_CUDA
+/**
+ * Make a device current until Restore() or the end of the scope. Restore
+ * before yielding: other tasks on the worker expect its own device.
+ */
+class ScopedGpuDevice {
+ public:
+  explicit ScopedGpuDevice(int gpu_id) : prev_(hshm::GpuApi::GetDevice()) {
+    switched_ = gpu_id != prev_ && cudaSetDevice(gpu_id) == cudaSuccess;
+  }
+  ~ScopedGpuDevice() { Restore(); }
+  void Restore() {
+    if (switched_) {
+      cudaSetDevice(prev_);
+      switched_ = false;
+    }
+  }
+
+ private:
+  int prev_;
+  bool switched_ = false;
+};
+
+void Runtime::EnableHbmPeerAccess() {
+  hbm_device_ = hshm::GpuApi::GetDevice();
+  int num_gpus = hshm::GpuApi::GetDeviceCount();
+  int num_peers = 0;
+  for (int gpu_id = 0; gpu_id < num_gpus; ++gpu_id) {
+    if (gpu_id == hbm_device_) continue;
+    // Both directions: kernels on the peer load and store the HBM buffer,
+    // and copies issued from the HBM device reach the peer's buffers
+    if (hshm::GpuApi::EnablePeerAccess(gpu_id, hbm_device_) &&
+        hshm::GpuApi::EnablePeerAccess(hbm_device_, gpu_id)) {
+      ++num_peers;
+    }
+  }
+  HLOG(kInfo, "HBM bdev {} on GPU {}: peer access from {} of {} other GPUs",
+       pool_name_, hbm_device_, num_peers, num_gpus > 0 ? num_gpus - 1 : 0);
+}
+
+/**
+ * Copy between the HBM buffer and a task buffer. A task buffer on another
+ * device is copied peer-to-peer (NVLink/PCIe) instead of through the host.
+ * @return CUDA status of the enqueue
+ */
+static cudaError_t HbmCopyAsync(void *dst, int dst_dev, const void *src,
+                                int src_dev, size_t size,
+                                cudaStream_t stream) {
+  if (dst_dev >= 0 && src_dev >= 0 && dst_dev != src_dev) {
+    return cudaMemcpyPeerAsync(dst, dst_dev, src, src_dev, size, stream);
+  }
+  return cudaMemcpyAsync(dst, src, size, cudaMemcpyDefault, stream);
+}
+
 chi::TaskResume Runtime::WriteToHbm(hipc::FullPtr<WriteTask> task,
                                     chi::RunContext &ctx) {
   auto *ipc_mgr = CHI_IPC;
@@ -908,14 +2455,19 @@ chi::TaskResume Runtime::WriteToHbm(hipc::FullPtr<WriteTask> task,
   chi::u64 total_bytes_written = 0;
   chi::u64 data_offset = 0;
 
+  // Copies are issued from the HBM device; a task buffer on another GPU
+  // is reached peer-to-peer
+  int task_device = hshm::GpuApi::GetPointerDevice(data_ptr.ptr_);
+  ScopedGpuDevice device_guard(hbm_device_);
   cudaStream_t stream;
   cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking);
 
   for (size_t i = 0; i < task->blocks_.size(); ++i) {
     const Block &block = task->blocks_[i];
-    chi::u64 remaining = task->length_ - total_bytes_written;
-    if (remaining == 0) break;
-    chi::u64 copy_size = std::min(remaining, block.size_);
+    chi::u64 block_data_off = 0;
+    chi::u64 copy_size =
+        GetBlockDataRange(*task, i, data_offset, &block_data_off);
+    if (copy_size == 0) break;
 
     if (block.offset_ + copy_size > hbm_size_) {
       cudaStreamDestroy(stream);
@@ -924,12 +2476,10 @@ chi::TaskResume Runtime::WriteToHbm(hipc::FullPtr<WriteTask> task,
       co_return;
     }
 
-    cudaError_t err = cudaMemcpyAsync(
-        hbm_buffer_ + block.offset_,
-        data_ptr.ptr_ + data_offset,
-        copy_size,
-        cudaMemcpyDefault,
-        stream);
+    cudaError_t err = HbmCopyAsync(
+        hbm_buffer_ + block.offset_, hbm_device_,
+        data_ptr.ptr_ + block_data_off, task_device,
+        copy_size, stream);
     if (err != cudaSuccess) {
       cudaStreamDestroy(stream);
       task->return_code_ = 2;
@@ -941,6 +2491,11 @@ chi::TaskResume Runtime::WriteToHbm(hipc::FullPtr<WriteTask> task,
     data_offset += copy_size;
   }
 
+  device_guard.Restore();
+  if (task_device >= 0 && task_device != hbm_device_) {
+    peer_bytes_.fetch_add(data_offset);
+  }
+
   // Poll for completion, yield if not ready
   while (true) {
     cudaError_t status = cudaStreamQuery(stream);
@@ -971,14 +2526,19 @@ chi::TaskResume Runtime::ReadFromHbm(hipc::FullPtr<ReadTask> task,
   chi::u64 total_bytes_read = 0;
   chi::u64 data_offset = 0;
 
+  // Copies are issued from the HBM device; a task buffer on another GPU
+  // is reached peer-to-peer
+  int task_device = hshm::GpuApi::GetPointerDevice(data_ptr.ptr_);
+  ScopedGpuDevice device_guard(hbm_device_);
   cudaStream_t stream;
   cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking);
 
   for (size_t i = 0; i < task->blocks_.size(); ++i) {
     const Block &block = task->blocks_[i];
-    chi::u64 remaining = task->length_ - total_bytes_read;
-    if (remaining == 0) break;
-    chi::u64 copy_size = std::min(remaining, block.size_);
+    chi::u64 block_data_off = 0;
+    chi::u64 copy_size =
+        GetBlockDataRange(*task, i, data_offset, &block_data_off);
+    if (copy_size == 0) break;
 
     if (block.offset_ + copy_size > hbm_size_) {
       cudaStreamDestroy(stream);
@@ -987,12 +2547,10 @@ chi::TaskResume Runtime::ReadFromHbm(hipc::FullPtr<ReadTask> task,
       co_return;
     }
 
-    cudaError_t err = cudaMemcpyAsync(
-        data_ptr.ptr_ + data_offset,
-        hbm_buffer_ + block.offset_,
-        copy_size,
-        cudaMemcpyDefault,
-        stream);
+    cudaError_t err = HbmCopyAsync(
+        data_ptr.ptr_ + block_data_off, task_device,
+        hbm_buffer_ + block.offset_, hbm_device_,
+        copy_size, stream);
     if (err != cudaSuccess) {
       cudaStreamDestroy(stream);
       task->return_code_ = 2;
@@ -1004,6 +2562,11 @@ chi::TaskResume Runtime::ReadFromHbm(hipc::FullPtr<ReadTask> task,
     data_offset += copy_size;
   }
 
+  device_guard.Restore();
+  if (task_device >= 0 && task_device != hbm_device_) {
+    peer_bytes_.fetch_add(data_offset);
+  }
+
   // Poll for completion, yield if not ready
   while (true) {
     cudaError_t status = cudaStreamQuery(stream);
@@ -1039,9 +2602,10 @@ chi::TaskResume Runtime::WriteToPinned(hipc::FullPtr<WriteTask> task,
 
   for (size_t i = 0; i < task->blocks_.size(); ++i) {
     const Block &block = task->blocks_[i];
-    chi::u64 remaining = task->length_ - total_bytes_written;
-    if (remaining == 0) break;
-    chi::u64 copy_size = std::min(remaining, block.size_);
+    chi::u64 block_data_off = 0;
+    chi::u64 copy_size =
+        GetBlockDataRange(*task, i, data_offset, &block_data_off);
+    if (copy_size == 0) break;
 
     if (block.offset_ + copy_size > pinned_size_) {
       cudaStreamDestroy(stream);
@@ -1052,7 +2616,7 @@ chi::TaskResume Runtime::WriteToPinned(hipc::FullPtr<WriteTask> task,
 
     cudaError_t err = cudaMemcpyAsync(
         pinned_buffer_ + block.offset_,
-        data_ptr.ptr_ + data_offset,
+        data_ptr.ptr_ + block_data_off,
         copy_size,
         cudaMemcpyDefault,
         stream);
@@ -1102,9 +2666,10 @@ chi::TaskResume Runtime::ReadFromPinned(hipc::FullPtr<ReadTask> task,
 
   for (size_t i = 0; i < task->blocks_.size(); ++i) {
     const Block &block = task->blocks_[i];
-    chi::u64 remaining = task->length_ - total_bytes_read;
-    if (remaining == 0) break;
-    chi::u64 copy_size = std::min(remaining, block.size_);
+    chi::u64 block_data_off = 0;
+    chi::u64 copy_size =
+        GetBlockDataRange(*task, i, data_offset, &block_data_off);
+    if (copy_size == 0) break;
 
     if (block.offset_ + copy_size > pinned_size_) {
       cudaStreamDestroy(stream);
@@ -1114,7 +2679,7 @@ chi::TaskResume Runtime::ReadFromPinned(hipc::FullPtr<ReadTask> task,
     }
 
     cudaError_t err = cudaMemcpyAsync(
-        data_ptr.ptr_ + data_offset,
+        data_ptr.ptr_ + block_data_off,
         pinned_buffer_ + block.offset_,
         copy_size,
         cudaMemcpyDefault,
@@ -1153,14 +2718,422 @@ chi::TaskResume Runtime::ReadFromPinned(hipc::FullPtr<ReadTask> task,
 }
 #endif  // HSHM_ENABLE_CUDA
 
-chi::TaskResume Runtime::GetStats(hipc::FullPtr<GetStatsTask> task,
-                                  chi::RunContext &ctx) {
-#ifdef __NVCOMPILER
-  chi::RunContext& rctx = ctx;
-#else
-  (void)ctx;
-#endif
-  CHI_TASK_BODY_BEGIN
+#if CHI_BDEV_ENABLE_GDS
+/** cuFileDriverOpen references held by the kGds bdevs of this process */
+static std::mutex g_gds_driver_lock;
+static int g_gds_driver_refs = 0;
+
+/**
+ * Turn a write/read task's blocks into cuFile I/Os. Blocks adjacent both on
+ * the device and in the buffer share one I/O.
+ * @param task Write or read task
+ * @param ios Output: (file offset, buffer offset, size) per I/O
+ * @return Bytes of the buffer the I/Os span
+ */
+template <typename TaskT>
+static chi::u64 BuildGdsIos(const TaskT &task,
+                            std::vector<std::array<chi::u64, 3>> &ios) {
+  chi::u64 seq_offset = 0;
+  chi::u64 span = 0;
+  for (size_t i = 0; i < task.blocks_.size(); ++i) {
+    chi::u64 data_off = 0;
+    chi::u64 n = GetBlockDataRange(task, i, seq_offset, &data_off);
+    if (n == 0) break;
+    seq_offset += n;
+    chi::u64 file_off = task.blocks_[i].offset_;
+    if (!ios.empty() && ios.back()[0] + ios.back()[2] == file_off &&
+        ios.back()[1] + ios.back()[2] == data_off) {
+      ios.back()[2] += n;
+    } else {
+      ios.push_back({file_off, data_off, n});
+    }
+    span = std::max(span, data_off + n);
+  }
+  return span;
+}
+
+bool Runtime::InitGds() {
+  {
+    std::lock_guard<std::mutex> guard(g_gds_driver_lock);
+    if (g_gds_driver_refs == 0) {
+      CUfileError_t status = cuFileDriverOpen();
+      if (status.err != CU_FILE_SUCCESS) {
+        HLOG(kError, "cuFileDriverOpen failed: err={}",
+             static_cast<int>(status.err));
+        return false;
+      }
+    }
+    ++g_gds_driver_refs;
+    gds_driver_open_ = true;
+  }
+
+  gds_fd_ = open(file_path_.c_str(), O_RDWR | O_DIRECT);
+  if (gds_fd_ < 0) {
+    HLOG(kError, "GDS bdev {}: O_DIRECT open failed: {}", file_path_,
+         strerror(errno));
+    CleanupGds();
+    return false;
+  }
+  CUfileDescr_t descr;
+  memset(&descr, 0, sizeof(descr));
+  descr.handle.fd = gds_fd_;
+  descr.type = CU_FILE_HANDLE_TYPE_OPAQUE_FD;
+  CUfileHandle_t handle;
+  CUfileError_t status = cuFileHandleRegister(&handle, &descr);
+  if (status.err != CU_FILE_SUCCESS) {
+    HLOG(kError, "GDS bdev {}: cuFileHandleRegister failed: err={}",
+         file_path_, static_cast<int>(status.err));
+    CleanupGds();
+    return false;
+  }
+  gds_handle_ = handle;
+  return true;
+}
+
+void Runtime::CleanupGds() {
+  {
+    hshm::ScopedMutex guard(gds_lock_, 0);
+    for (void *batch : gds_batches_) {
+      cuFileBatchIODestroy(static_cast<CUfileBatchHandle_t>(batch));
+    }
+    gds_batches_.clear();
+  }
+  if (gds_handle_ != nullptr) {
+    cuFileHandleDeregister(static_cast<CUfileHandle_t>(gds_handle_));
+    gds_handle_ = nullptr;
+  }
+  if (gds_fd_ >= 0) {
+    close(gds_fd_);
+    gds_fd_ = -1;
+  }
+  if (gds_driver_open_) {
+    std::lock_guard<std::mutex> guard(g_gds_driver_lock);
+    if (--g_gds_driver_refs == 0) {
+      cuFileDriverClose();
+    }
+    gds_driver_open_ = false;
+  }
+}
+
+bool Runtime::IsDeviceBuffer(const void *ptr) {
+  cudaPointerAttributes attr;
+  if (ptr == nullptr || cudaPointerGetAttributes(&attr, ptr) != cudaSuccess) {
+    cudaGetLastError();  // Clear the sticky error for unknown host pointers
+    return false;
+  }
+  return attr.type == cudaMemoryTypeDevice;
+}
+
+bool Runtime::RegisterGdsBuffer(const void *ptr, chi::u64 size) {
+  if (size < kGdsRegisterMinBytes) {
+    return false;
+  }
+  CUfileError_t status = cuFileBufRegister(ptr, size, 0);
+  return status.err == CU_FILE_SUCCESS;
+}
+
+void *Runtime::AcquireGdsBatch() {
+  {
+    hshm::ScopedMutex guard(gds_lock_, 0);
+    if (!gds_batches_.empty()) {
+      void *batch = gds_batches_.back();
+      gds_batches_.pop_back();
+      return batch;
+    }
+  }
+  CUfileBatchHandle_t batch;
+  CUfileError_t status = cuFileBatchIOSetUp(&batch, kGdsBatchMax);
+  if (status.err != CU_FILE_SUCCESS) {
+    HLOG(kError, "GDS bdev {}: cuFileBatchIOSetUp failed: err={}",
+         file_path_, static_cast<int>(status.err));
+    return nullptr;
+  }
+  return batch;
+}
+
+void Runtime::ReleaseGdsBatch(void *batch) {
+  hshm::ScopedMutex guard(gds_lock_, 0);
+  gds_batches_.push_back(batch);
+}
+
+chi::TaskResume Runtime::SubmitGdsBatches(
+    char *data, const std::vector<std::array<chi::u64, 3>> &ios,
+    bool is_write, chi::u64 &bytes, chi::u32 &error_code) {
+  bytes = 0;
+  error_code = 0;
+  void *batch = AcquireGdsBatch();
+  if (batch == nullptr) {
+    error_code = 2;
+    co_return;
+  }
+  CUfileBatchHandle_t handle = static_cast<CUfileBatchHandle_t>(batch);
+  std::vector<CUfileIOParams_t> params;
+  std::vector<CUfileIOEvents_t> events(kGdsBatchMax);
+  bool handle_ok = true;
+
+  for (size_t first = 0; first < ios.size() && error_code == 0;
+       first += kGdsBatchMax) {
+    size_t count = std::min<size_t>(kGdsBatchMax, ios.size() - first);
+    params.assign(count, CUfileIOParams_t{});
+    for (size_t i = 0; i < count; ++i) {
+      const std::array<chi::u64, 3> &io = ios[first + i];
+      CUfileIOParams_t &param = params[i];
+      param.mode = CUFILE_BATCH;
+      param.fh = static_cast<CUfileHandle_t>(gds_handle_);
+      param.opcode = is_write ? CUFILE_WRITE : CUFILE_READ;
+      param.u.batch.devPtr_base = data;
+      param.u.batch.file_offset = static_cast<off_t>(io[0]);
+      param.u.batch.devPtr_offset = static_cast<off_t>(io[1]);
+      param.u.batch.size = static_cast<size_t>(io[2]);
+    }
+    CUfileError_t status = cuFileBatchIOSubmit(
+        handle, static_cast<unsigned>(count), params.data(), 0);
+    if (status.err != CU_FILE_SUCCESS) {
+      HLOG(kError, "GDS bdev {}: cuFileBatchIOSubmit failed: err={}",
+           file_path_, static_cast<int>(status.err));
+      error_code = 2;
+      break;
+    }
+
+    // Poll without blocking the worker; completed I/Os are reported once
+    size_t done = 0;
+    while (done < count) {
+      unsigned nr = kGdsBatchMax;
+      struct timespec timeout = {0, 0};
+      status = cuFileBatchIOGetStatus(handle, 0, &nr, events.data(), &timeout);
+      if (status.err != CU_FILE_SUCCESS) {
+        HLOG(kError, "GDS bdev {}: cuFileBatchIOGetStatus failed: err={}",
+             file_path_, static_cast<int>(status.err));
+        cuFileBatchIOCancel(handle);
+        handle_ok = false;
+        error_code = 3;
+        break;
+      }
+      for (unsigned i = 0; i < nr; ++i) {
+        CUfileStatus_t io_status = events[i].status;
+        if (io_status == CUFILE_COMPLETE) {
+          bytes += events[i].ret;
+          ++done;
+        } else if (io_status == CUFILE_FAILED ||
+                   io_status == CUFILE_CANCELED ||
+                   io_status == CUFILE_TIMEOUT ||
+                   io_status == CUFILE_INVALID) {
+          error_code = 4;
+          ++done;
+        }
+      }
+      if (done < count) {
+        co_await chi::yield(5.0);
+      }
+    }
+  }
+
+  if (handle_ok) {
+    ReleaseGdsBatch(batch);
+  } else {
+    cuFileBatchIODestroy(handle);
+  }
+  co_return;
+}
+
+chi::TaskResume Runtime::WriteToGds(hipc::FullPtr<WriteTask> task,
+                                    chi::RunContext &ctx) {
+  auto *ipc_mgr = CHI_IPC;
+  hipc::FullPtr<char> data_ptr = ipc_mgr->ToFullPtr(task->data_).Cast<char>();
+  if (!IsDeviceBuffer(data_ptr.ptr_)) {
+    co_await WriteToFile(task, ctx);
+    co_return;
+  }
+
+  std::vector<std::array<chi::u64, 3>> ios;
+  chi::u64 span = BuildGdsIos(*task, ios);
+  bool registered = RegisterGdsBuffer(data_ptr.ptr_, span);
+  hshm::Timer io_timer;
+  io_timer.Resume();
+  chi::u64 total_bytes_written = 0;
+  chi::u32 error_code = 0;
+  co_await SubmitGdsBatches(data_ptr.ptr_, ios, true, total_bytes_written,
+                            error_code);
+  io_timer.Pause();
+  if (registered) {
+    cuFileBufDeregister(data_ptr.ptr_);
+  }
+
+  task->bytes_written_ = total_bytes_written;
+  task->return_code_ = error_code;
+  if (error_code != 0) {
+    HLOG(kError, "GDS write failed: error_code={}", error_code);
+    co_return;
+  }
+  RecordIoSample(true, total_bytes_written, io_timer.GetUsec());
+  total_writes_.fetch_add(1);
+  total_bytes_written_.fetch_add(total_bytes_written);
+  co_return;
+}
+
+chi::TaskResume Runtime::ReadFromGds(hipc::FullPtr<ReadTask> task,
+                                     chi::RunContext &ctx) {
+  auto *ipc_mgr = CHI_IPC;
+  hipc::FullPtr<char> data_ptr = ipc_mgr->ToFullPtr(task->data_).Cast<char>();
+  if (!IsDeviceBuffer(data_ptr.ptr_)) {
+    co_await ReadFromFile(task, ctx);
+    co_return;
+  }
+
+  std::vector<std::array<chi::u64, 3>> ios;
+  chi::u64 span = BuildGdsIos(*task, ios);
+  bool registered = RegisterGdsBuffer(data_ptr.ptr_, span);
+  hshm::Timer io_timer;
+  io_timer.Resume();
+  chi::u64 total_bytes_read = 0;
+  chi::u32 error_code = 0;
+  co_await SubmitGdsBatches(data_ptr.ptr_, ios, false, total_bytes_read,
+                            error_code);
+  io_timer.Pause();
+  if (registered) {
+    cuFileBufDeregister(data_ptr.ptr_);
+  }
+
+  task->bytes_read_ = total_bytes_read;
+  task->return_code_ = error_code;
+  if (error_code != 0) {
+    HLOG(kError, "GDS read failed: error_code={}", error_code);
+    co_return;
+  }
+  RecordIoSample(false, total_bytes_read, io_timer.GetUsec());
+  total_reads_.fetch_add(1);
+  total_bytes_read_.fetch_add(total_bytes_read);
+  co_return;
+}
+#endif  // CHI_BDEV_ENABLE_GDS
+
+/** Fold a sample into a moving average, or start it if not yet seeded */
+static double BlendPerfSample(double avg, double sample, bool seeded,
+                              double weight) {
+  return seeded ? (1.0 - weight) * avg + weight * sample : sample;
+}
+
+void Runtime::RecordIoSample(bool is_write, chi::u64 bytes,
+                             double elapsed_us) {
+  if (perf_metrics_user_ || bytes == 0 || elapsed_us <= 0) {
+    return;
+  }
+  bool latency = bytes <= kPerfLatencyMaxBytes;
+  bool bandwidth = bytes >= kPerfBandwidthMinBytes;
+  // The sample's own task is still counted as in flight
+  double depth = std::max<chi::u32>(inflight_ios_.load(), 1);
+  hshm::ScopedMutex guard(perf_lock_, 0);
+  std::vector<PerfSample> &ring = model_samples_[is_write];
+  PerfSample sample{static_cast<double>(bytes) / (1024.0 * 1024.0), depth,
+                    elapsed_us};
+  if (ring.size() < kModelSamples) {
+    ring.push_back(sample);
+  } else {
+    ring[model_next_[is_write]] = sample;
+    model_next_[is_write] = (model_next_[is_write] + 1) % kModelSamples;
+  }
+  ++model_unfit_[is_write];
+  if (latency) {
+    chi::u32 bit = is_write ? kPerfWriteLat : kPerfReadLat;
+    double &avg = is_write ? perf_metrics_.write_latency_us_
+                           : perf_metrics_.read_latency_us_;
+    avg = BlendPerfSample(avg, elapsed_us, perf_measured_ & bit,
+                          kPerfEwmaWeight);
+    perf_measured_ |= bit;
+  }
+  if (bandwidth) {
+    chi::u32 bit = is_write ? kPerfWriteBw : kPerfReadBw;
+    double &avg = is_write ? perf_metrics_.write_bandwidth_mbps_
+                           : perf_metrics_.read_bandwidth_mbps_;
+    double mbps = static_cast<double>(bytes) / (1024.0 * 1024.0) /
+                  (elapsed_us * 1e-6);
+    avg = BlendPerfSample(avg, mbps, perf_measured_ & bit, kPerfEwmaWeight);
+    perf_measured_ |= bit;
+  }
+}
+
+bool Runtime::FitPerfCurve(const std::vector<PerfSample> &samples,
+                           PerfCurve &curve) {
+  if (samples.size() < kModelMinSamples) {
+    return false;
+  }
+  double min_mb = samples[0].size_mb_;
+  double max_mb = samples[0].size_mb_;
+  double min_us = samples[0].elapsed_us_;
+  for (const PerfSample &sample : samples) {
+    min_mb = std::min(min_mb, sample.size_mb_);
+    max_mb = std::max(max_mb, sample.size_mb_);
+    min_us = std::min(min_us, sample.elapsed_us_);
+  }
+  if (max_mb < kModelMinSpread * min_mb) {
+    return false;  // One size: base and transfer cost are not separable
+  }
+
+  // Seed from the fastest I/O and the mean cost per MB above it
+  double per_mb = 0;
+  for (const PerfSample &sample : samples) {
+    per_mb += std::max(sample.elapsed_us_ - min_us, 0.0) / sample.size_mb_;
+  }
+  per_mb = std::max(per_mb / samples.size(), 1e-3);
+  hermes_shm::NonlinearLeastSquares solver;
+  solver.SetParameters({min_us, per_mb, 0.0});
+  solver.SetMaxIterations(50);
+  auto cost = [&samples](const std::vector<double> &params,
+                         std::vector<double> &residuals) {
+    residuals.resize(samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+      const PerfSample &sample = samples[i];
+      double queue = 1.0 + params[2] * (sample.depth_ - 1.0);
+      double predicted = (params[0] + sample.size_mb_ * params[1]) * queue;
+      residuals[i] = (predicted - sample.elapsed_us_) / sample.elapsed_us_;
+    }
+  };
+  solver.Minimize(cost);
+  const std::vector<double> &fit = solver.GetParameters();
+  if (!std::isfinite(fit[0]) || !std::isfinite(fit[1]) ||
+      !std::isfinite(fit[2]) || fit[1] <= 0) {
+    return false;
+  }
+  curve.base_us_ = std::max(fit[0], 0.0);
+  curve.us_per_mb_ = fit[1];
+  curve.queue_factor_ = std::max(fit[2], 0.0);
+  return true;
+}
+
+PerfModel Runtime::GetPerfModel() {
+  std::vector<PerfSample> samples[2];
+  {
+    hshm::ScopedMutex guard(perf_lock_, 0);
+    if (model_fitting_) {
+      return perf_model_;
+    }
+    for (int dir = 0; dir < 2; ++dir) {
+      if (model_unfit_[dir] >= kModelRefitSamples) {
+        samples[dir] = model_samples_[dir];
+        model_unfit_[dir] = 0;
+      }
+    }
+    if (samples[0].empty() && samples[1].empty()) {
+      return perf_model_;
+    }
+    model_fitting_ = true;
+  }
+  PerfCurve read = perf_model_.read_;
+  PerfCurve write = perf_model_.write_;
+  bool read_fit = FitPerfCurve(samples[0], read);
+  bool write_fit = FitPerfCurve(samples[1], write);
+  hshm::ScopedMutex guard(perf_lock_, 0);
+  if (read_fit) {
+    perf_model_.read_ = read;
+  }
+  if (write_fit) {
+    perf_model_.write_ = write;
+  }
+  model_fitting_ = false;
+  return perf_model_;
+}
+
+PerfMetrics Runtime::GetReportedMetrics() {
   // Predict wall time from learned model
   chi::TaskStat read_stat = GetTaskStats(Method::kRead);
   chi::TaskStat write_stat = GetTaskStats(Method::kWrite);
@@ -1168,16 +3141,49 @@ chi::TaskResume Runtime::GetStats(hipc::FullPtr<GetStatsTask> task,
   float write_wall_us = InferWallClockTime(Method::kWrite, write_stat);
   double read_size_mb = static_cast<double>(read_stat.io_size_) / (1024.0 * 1024.0);
   double write_size_mb = static_cast<double>(write_stat.io_size_) / (1024.0 * 1024.0);
-  task->metrics_.read_bandwidth_mbps_ = (read_wall_us > 0)
-      ? read_size_mb / (read_wall_us * 1e-6) : perf_metrics_.read_bandwidth_mbps_;
-  task->metrics_.write_bandwidth_mbps_ = (write_wall_us > 0)
-      ? write_size_mb / (write_wall_us * 1e-6) : perf_metrics_.write_bandwidth_mbps_;
-  task->metrics_.read_latency_us_ = read_wall_us;
-  task->metrics_.write_latency_us_ = write_wall_us;
-  task->metrics_.iops_ = perf_metrics_.iops_;
-  // Get remaining size from heap allocator
-  chi::u64 remaining = heap_.GetRemainingSize();
+
+  hshm::ScopedMutex guard(perf_lock_, 0);
+  chi::u32 held = perf_metrics_user_ ? kPerfAll : perf_measured_;
+  PerfMetrics metrics = perf_metrics_;
+  if (!(held & kPerfReadBw) && read_wall_us > 0) {
+    metrics.read_bandwidth_mbps_ = read_size_mb / (read_wall_us * 1e-6);
+  }
+  if (!(held & kPerfWriteBw) && write_wall_us > 0) {
+    metrics.write_bandwidth_mbps_ = write_size_mb / (write_wall_us * 1e-6);
+  }
+  if (!(held & kPerfReadLat)) {
+    metrics.read_latency_us_ = read_wall_us;
+  }
+  if (!(held & kPerfWriteLat)) {
+    metrics.write_latency_us_ = write_wall_us;
+  }
+  return metrics;
+}
+
+chi::TaskResume Runtime::GetStats(hipc::FullPtr<GetStatsTask> task,
+                                  chi::RunContext &ctx) {
+  chi::RunContext& rctx = ctx;
+  CHI_TASK_BODY_BEGIN
+  // CTE polls stats periodically, which bounds how long a partial stripe
+  // waits for the rest of its writes
+  if (pfs_) {
+    WorkerIOContext *io_ctx = GetWorkerIOContext(GetWorkerID(rctx));
+    if (io_ctx != nullptr && io_ctx->is_initialized_) {
+      CHI_CO_AWAIT(FlushStagedStripes(io_ctx, pfs_flush_ns_));
+    }
+  }
+  task->metrics_ = GetReportedMetrics();
+  // Remaining size counts free heap extents and cached blocks
+  chi::u64 remaining = GetRemainingCapacity();
   task->remaining_size_ = remaining;
+  task->shared_buffer_ = !ram_segment_.empty();
+  task->node_remaining_.clear();
+  for (const auto &node : ram_nodes_) {
+    task->node_remaining_.push_back(node->heap_.GetRemainingSize() +
+                                    node->block_map_.GetCachedBytes());
+  }
+  task->inflight_bytes_ = inflight_bytes_.load();
+  task->model_ = GetPerfModel();
   task->return_code_ = 0;
   CHI_CO_RETURN;
   CHI_TASK_BODY_END
@@ -1185,12 +3191,14 @@ chi::TaskResume Runtime::GetStats(hipc::FullPtr<GetStatsTask> task,
 
 chi::TaskResume Runtime::Destroy(hipc::FullPtr<DestroyTask> task,
                                  chi::RunContext &ctx) {
-#ifdef __NVCOMPILER
   chi::RunContext& rctx = ctx;
-#else
-  (void)ctx;
-#endif
   CHI_TASK_BODY_BEGIN
+  if (pfs_) {
+    WorkerIOContext *io_ctx = GetWorkerIOContext(GetWorkerID(rctx));
+    if (io_ctx != nullptr && io_ctx->is_initialized_) {
+      CHI_CO_AWAIT(FlushStagedStripes(io_ctx, 0));
+    }
+  }
   // Worker I/O contexts (and their AsyncIO instances) are cleaned up by destructor
   // Note: GlobalBlockMap and Heap cleanup is handled by their destructors
 
@@ -1204,10 +3212,175 @@ void Runtime::InitializeAllocator() {
   chi::WorkOrchestrator *work_orchestrator = CHI_WORK_ORCHESTRATOR;
   size_t num_workers =
       work_orchestrator ? work_orchestrator->GetWorkerCount() : 16;
-  global_block_map_.Init(num_workers);
+  global_block_map_.Init(num_workers, &heap_);
 
   // Initialize heap with total file size and alignment requirement
-  heap_.Init(file_size_, alignment_);
+  heap_.Init(file_size_, alignment_, region_base_, stripe_size_);
+
+  // Node-local kRam: each slice gets its own cache and heap
+  for (auto &node : ram_nodes_) {
+    node->block_map_.Init(num_workers, &node->heap_);
+    node->heap_.Init(node->size_, alignment_, node->base_);
+  }
+}
+
+bool Runtime::AllocateIoPiece(int worker_id, size_t io_size, Block &block) {
+  if (ram_nodes_.empty()) {
+    return AllocateFromHeap(global_block_map_, heap_, worker_id, io_size,
+                            block);
+  }
+  // Start at the caller's node and spill to the others once it is full
+  auto *sys_info = HSHM_SYSTEM_INFO;
+  size_t num_nodes = ram_nodes_.size();
+  size_t home = static_cast<size_t>(sys_info->GetCurrentNumaNode()) % num_nodes;
+  for (size_t i = 0; i < num_nodes; ++i) {
+    RamNode &node = *ram_nodes_[(home + i) % num_nodes];
+    if (AllocateFromHeap(node.block_map_, node.heap_, worker_id, io_size,
+                         block)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Runtime::AllocateFromHeap(GlobalBlockMap &block_map, Heap &heap,
+                               int worker_id, size_t io_size, Block &block) {
+  if (block_map.AllocateBlock(worker_id, io_size, block)) {
+    return true;
+  }
+
+  // Find the appropriate block type and size for this I/O size; if no
+  // cached size fits, use the largest category
+  size_t alloc_size;
+  int block_type = FindBlockTypeForSize(io_size, alloc_size);
+  if (block_type == -1) {
+    block_type = kNumBlockSizes - 1;
+  }
+  if (heap.Allocate(alloc_size, block_type, block)) {
+    return true;
+  }
+
+  // Blocks cached under other sizes may coalesce into a fitting extent
+  if (block_map.Reclaim(worker_id) == 0) {
+    return false;
+  }
+  return heap.Allocate(alloc_size, block_type, block);
+}
+
+void Runtime::FreeIoBlock(int worker_id, const Block &block) {
+  Block piece = block;  // FreeBlock takes a non-const reference
+  if (ram_nodes_.empty()) {
+    global_block_map_.FreeBlock(worker_id, piece);
+    return;
+  }
+  // Adjacent blocks of two slices may have been merged by the caller
+  chi::u64 end = block.offset_ + block.size_;
+  chi::u64 offset = block.offset_;
+  while (offset < end) {
+    RamNode &node = *ram_nodes_[GetRamNodeIndex(offset)];
+    piece.offset_ = offset;
+    piece.size_ = std::min(end, node.base_ + node.size_) - offset;
+    offset += piece.size_;
+    node.block_map_.FreeBlock(worker_id, piece);
+  }
+}
+
+size_t Runtime::GetRamNodeIndex(chi::u64 offset) const {
+  // Slices are equal-sized except the last, which takes the remainder
+  size_t idx = static_cast<size_t>(offset / ram_nodes_[0]->size_);
+  return std::min(idx, ram_nodes_.size() - 1);
+}
+
+bool Runtime::MapRamBuffer(const CreateParams &params) {
+  size_t huge_size = hipc::GetHugePageSize(params.huge_pages_);
+  size_t granule = std::max<size_t>(huge_size, params.alignment_);
+  if (granule == 0) {
+    granule = 4096;
+  }
+  ram_mapped_size_ = ((ram_size_ + granule - 1) / granule) * granule;
+
+  // Explicit hugetlb pages fall back to transparent ones like the segments
+  void *ptr = nullptr;
+  bool hugetlb = params.huge_pages_ == hipc::HugePageMode::k2MB ||
+                 params.huge_pages_ == hipc::HugePageMode::k1GB;
+  if (params.shared_) {
+    // A named segment local clients can map read-only for blob views
+    ram_segment_ = GetRamSegmentName(pool_id_);
+    hshm::SystemInfo::DestroySharedMemory(ram_segment_);
+    bool created = hugetlb && hshm::SystemInfo::CreateNewSharedMemory(
+                                  ram_fd_, ram_segment_, ram_mapped_size_,
+                                  huge_size);
+    if (hugetlb && !created) {
+      HLOG(kWarning, "RAM bdev: hugetlb pages unavailable for {} bytes, "
+           "falling back to transparent huge pages", ram_mapped_size_);
+    }
+    if (!created && !hshm::SystemInfo::CreateNewSharedMemory(
+                        ram_fd_, ram_segment_, ram_mapped_size_)) {
+      HLOG(kError, "RAM bdev: could not create segment {}", ram_segment_);
+      ram_segment_.clear();
+      return false;
+    }
+    ptr = hshm::SystemInfo::MapSharedMemory(ram_fd_, ram_mapped_size_, 0);
+    if (ptr == nullptr) {
+      hshm::SystemInfo::CloseSharedMemory(ram_fd_);
+      hshm::SystemInfo::DestroySharedMemory(ram_segment_);
+      ram_segment_.clear();
+      return false;
+    }
+    if (params.huge_pages_ != hipc::HugePageMode::kNone && !created) {
+      hshm::SystemInfo::AdviseHugePages(ptr, ram_mapped_size_);
+    }
+  } else if (hugetlb) {
+    ptr = hshm::SystemInfo::MapHugePrivateMemory(ram_mapped_size_, huge_size);
+    if (ptr == nullptr) {
+      HLOG(kWarning, "RAM bdev: hugetlb pages unavailable for {} bytes, "
+           "falling back to transparent huge pages", ram_mapped_size_);
+    }
+  }
+  if (ptr == nullptr) {
+    ptr = hshm::SystemInfo::MapPrivateMemory(ram_mapped_size_);
+    if (ptr == nullptr || ptr == reinterpret_cast<void *>(-1)) {  // MAP_FAILED
+      return false;
+    }
+    if (params.huge_pages_ != hipc::HugePageMode::kNone) {
+      hshm::SystemInfo::AdviseHugePages(ptr, ram_mapped_size_);
+    }
+  }
+  ram_buffer_ = static_cast<char *>(ptr);
+
+  // Policies are set before the first touch, so pages land where asked
+  auto *sys_info = HSHM_SYSTEM_INFO;
+  int num_nodes = sys_info->numa_nodes_;
+  if (params.ram_numa_ == RamNumaMode::kInterleave && num_nodes > 1) {
+    if (!hshm::SystemInfo::InterleaveMemory(ram_buffer_, ram_mapped_size_)) {
+      HLOG(kWarning, "RAM bdev: could not interleave {} bytes across {} "
+           "NUMA nodes", ram_mapped_size_, num_nodes);
+    }
+  } else if (params.ram_numa_ == RamNumaMode::kNodeLocal && num_nodes > 1) {
+    chi::u64 slice = (ram_size_ / num_nodes / granule) * granule;
+    if (slice == 0) {
+      HLOG(kWarning, "RAM bdev: {} bytes is too small for {} NUMA slices, "
+           "using one heap", ram_size_, num_nodes);
+      return true;
+    }
+    for (int n = 0; n < num_nodes; ++n) {
+      auto node = std::make_unique<RamNode>();
+      node->base_ = slice * n;
+      node->size_ = (n == num_nodes - 1) ? ram_size_ - node->base_ : slice;
+      size_t map_len = (n == num_nodes - 1) ? ram_mapped_size_ - node->base_
+                                            : slice;
+      if (!hshm::SystemInfo::BindMemoryToNumaNode(ram_buffer_ + node->base_,
+                                                  map_len, n)) {
+        HLOG(kWarning, "RAM bdev: could not bind slice {} to NUMA node {}",
+             node->base_, n);
+      }
+      ram_nodes_.push_back(std::move(node));
+    }
+  }
+  HLOG(kInfo, "RAM bdev: mapped {} bytes, huge_pages={}, numa={}, {} slices",
+       ram_mapped_size_, static_cast<int>(params.huge_pages_),
+       static_cast<chi::u32>(params.ram_numa_), ram_nodes_.size());
+  return true;
 }
 
 size_t Runtime::GetBlockSize(int block_type) {
@@ -1270,11 +3443,12 @@ void Runtime::WriteToRam(hipc::FullPtr<WriteTask> task) {
     const Block &block = task->blocks_[i];
 
     // Calculate how much data to write to this block
-    chi::u64 remaining = task->length_ - total_bytes_written;
-    if (remaining == 0) {
+    chi::u64 block_data_off = 0;
+    chi::u64 block_write_size =
+        GetBlockDataRange(*task, i, data_offset, &block_data_off);
+    if (block_write_size == 0) {
       break;  // All data has been written
     }
-    chi::u64 block_write_size = std::min(remaining, block.size_);
 
     // Check bounds
     if (block.offset_ + block_write_size > ram_size_) {
@@ -1288,7 +3462,7 @@ void Runtime::WriteToRam(hipc::FullPtr<WriteTask> task) {
     }
 
     // Simple memory copy
-    memcpy(ram_buffer_ + block.offset_, data_ptr.ptr_ + data_offset,
+    memcpy(ram_buffer_ + block.offset_, data_ptr.ptr_ + block_data_off,
            block_write_size);
 
     // Update counters
@@ -1327,11 +3501,12 @@ void Runtime::ReadFromRam(hipc::FullPtr<ReadTask> task) {
     const Block &block = task->blocks_[i];
 
     // Calculate how much data to read from this block
-    chi::u64 remaining = task->length_ - total_bytes_read;
-    if (remaining == 0) {
+    chi::u64 block_data_off = 0;
+    chi::u64 block_read_size =
+        GetBlockDataRange(*task, i, data_offset, &block_data_off);
+    if (block_read_size == 0) {
       break;  // All data has been read
     }
-    chi::u64 block_read_size = std::min(remaining, block.size_);
 
     // Check bounds
     if (block.offset_ + block_read_size > ram_size_) {
@@ -1345,7 +3520,7 @@ void Runtime::ReadFromRam(hipc::FullPtr<ReadTask> task) {
     }
 
     // Copy data from RAM buffer to task output
-    memcpy(data_ptr.ptr_ + data_offset, ram_buffer_ + block.offset_,
+    memcpy(data_ptr.ptr_ + block_data_off, ram_buffer_ + block.offset_,
            block_read_size);
 
     // Update counters
@@ -1370,35 +3545,41 @@ chi::TaskResume Runtime::Monitor(hipc::FullPtr<MonitorTask> task,
   CHI_TASK_BODY_BEGIN
   (void)rctx;
   if (task->query_ == "stats") {
-    // Predict wall time from learned model
-    chi::TaskStat read_stat = GetTaskStats(Method::kRead);
-    chi::TaskStat write_stat = GetTaskStats(Method::kWrite);
-    float read_wall_us = InferWallClockTime(Method::kRead, read_stat);
-    float write_wall_us = InferWallClockTime(Method::kWrite, write_stat);
-    double read_size_mb = static_cast<double>(read_stat.io_size_) / (1024.0 * 1024.0);
-    double write_size_mb = static_cast<double>(write_stat.io_size_) / (1024.0 * 1024.0);
-    double read_bw = (read_wall_us > 0)
-        ? read_size_mb / (read_wall_us * 1e-6) : perf_metrics_.read_bandwidth_mbps_;
-    double write_bw = (write_wall_us > 0)
-        ? write_size_mb / (write_wall_us * 1e-6) : perf_metrics_.write_bandwidth_mbps_;
+    PerfMetrics metrics = GetReportedMetrics();
 
     msgpack::sbuffer sbuf;
     msgpack::packer<msgpack::sbuffer> pk(sbuf);
 
-    pk.pack_map(13);
+    size_t free_extents = heap_.GetFreeExtentCount();
+    for (auto &node : ram_nodes_) {
+      free_extents += node->heap_.GetFreeExtentCount();
+    }
+    pk.pack_map(20);
     pk.pack("pool_name");              pk.pack(pool_name_);
     pk.pack("bdev_type");              pk.pack(static_cast<chi::u32>(bdev_type_));
     pk.pack("total_capacity");         pk.pack(file_size_);
-    pk.pack("remaining_capacity");     pk.pack(heap_.GetRemainingSize());
-    pk.pack("read_bandwidth_mbps");    pk.pack(read_bw);
-    pk.pack("write_bandwidth_mbps");   pk.pack(write_bw);
-    pk.pack("read_latency_us");        pk.pack(static_cast<double>(read_wall_us));
-    pk.pack("write_latency_us");       pk.pack(static_cast<double>(write_wall_us));
-    pk.pack("iops");                   pk.pack(perf_metrics_.iops_);
+    pk.pack("remaining_capacity");     pk.pack(GetRemainingCapacity());
+    pk.pack("node_remaining_capacity");
+    pk.pack_array(ram_nodes_.size());
+    for (auto &node : ram_nodes_) {
+      pk.pack(node->heap_.GetRemainingSize() +
+              node->block_map_.GetCachedBytes());
+    }
+    pk.pack("free_extents");           pk.pack(free_extents);
+    pk.pack("read_bandwidth_mbps");    pk.pack(metrics.read_bandwidth_mbps_);
+    pk.pack("write_bandwidth_mbps");   pk.pack(metrics.write_bandwidth_mbps_);
+    pk.pack("read_latency_us");        pk.pack(metrics.read_latency_us_);
+    pk.pack("write_latency_us");       pk.pack(metrics.write_latency_us_);
+    pk.pack("iops");                   pk.pack(metrics.iops_);
     pk.pack("total_reads");            pk.pack(total_reads_.load());
     pk.pack("total_writes");           pk.pack(total_writes_.load());
     pk.pack("total_bytes_read");       pk.pack(total_bytes_read_.load());
     pk.pack("total_bytes_written");    pk.pack(total_bytes_written_.load());
+    pk.pack("peer_bytes");             pk.pack(peer_bytes_.load());
+    pk.pack("stripe_size");            pk.pack(stripe_size_);
+    pk.pack("staged_bytes");           pk.pack(staged_bytes_.load());
+    pk.pack("stripe_writes");          pk.pack(stripe_writes_.load());
+    pk.pack("stripe_fills");           pk.pack(stripe_fills_.load());
 
     task->results_[container_id_] = std::string(sbuf.data(), sbuf.size());
   }
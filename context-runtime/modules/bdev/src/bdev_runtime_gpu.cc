@@ -143,7 +143,9 @@ HSHM_GPU_FUN void GpuRuntime::Write(hipc::FullPtr<WriteTask> task,
 
   if (bdev_type_ == kNoop) {
     if (lane == 0) {
-      task->bytes_written_ = task->length_;
+      task->bytes_written_ = task->data_offsets_.empty()
+                                 ? task->length_
+                                 : GetTaskDataBytes(*task);
       task->return_code_ = 0;
     }
     return;
@@ -165,12 +167,12 @@ HSHM_GPU_FUN void GpuRuntime::Write(hipc::FullPtr<WriteTask> task,
   chi::u64 data_off = 0;
   for (size_t i = 0; i < num_blocks; ++i) {
     const Block &block = task->blocks_[i];
-    chi::u64 remaining = task->length_ - data_off;
-    if (remaining == 0) break;
-    chi::u64 copy_size = (block.size_ < remaining) ? block.size_ : remaining;
+    chi::u64 block_off = 0;
+    chi::u64 copy_size = GetBlockDataRange(*task, i, data_off, &block_off);
+    if (copy_size == 0) break;
 
     char *block_dst = dst_base + block.offset_;
-    const char *block_src = src + data_off;
+    const char *block_src = src + block_off;
 
     if (lane >= num_lanes) { data_off += copy_size; continue; }
     chi::u64 stripe = copy_size / num_lanes;
@@ -225,7 +227,9 @@ HSHM_GPU_FUN void GpuRuntime::Read(hipc::FullPtr<ReadTask> task,
 
   if (bdev_type_ == kNoop) {
     if (lane == 0) {
-      task->bytes_read_ = task->length_;
+      task->bytes_read_ = task->data_offsets_.empty()
+                                 ? task->length_
+                                 : GetTaskDataBytes(*task);
       task->return_code_ = 0;
     }
     return;
@@ -252,12 +256,12 @@ HSHM_GPU_FUN void GpuRuntime::Read(hipc::FullPtr<ReadTask> task,
   chi::u64 data_off = 0;
   for (size_t i = 0; i < num_blocks; ++i) {
     const Block &block = task->blocks_[i];
-    chi::u64 remaining = task->length_ - data_off;
-    if (remaining == 0) break;
-    chi::u64 copy_size = (block.size_ < remaining) ? block.size_ : remaining;
+    chi::u64 block_off = 0;
+    chi::u64 copy_size = GetBlockDataRange(*task, i, data_off, &block_off);
+    if (copy_size == 0) break;
 
     const char *block_src = src_base + block.offset_;
-    char *block_dst = dst + data_off;
+    char *block_dst = dst + block_off;
 
     if (lane >= num_lanes) { data_off += copy_size; continue; }
     chi::u64 stripe = copy_size / num_lanes;
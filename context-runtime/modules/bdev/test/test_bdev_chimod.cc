@@ -974,6 +974,126 @@ TEST_CASE("bdev_ram_large_blocks", "[bdev][ram][large]") {
   HLOG(kInfo, "RAM backend large block tests completed");
 }
 
+TEST_CASE("bdev_ram_checkpoint_blocks", "[bdev][ram][large]") {
+  BdevChimodFixture fixture;
+  REQUIRE(g_initialized);
+
+  // Admin client is automatically initialized via CHI_ADMIN singleton
+  std::this_thread::sleep_for(100ms);
+
+  // Create RAM-based bdev container large enough for checkpoint-sized blocks
+  chi::PoolId custom_pool_id(8011, 0);
+  chimaera::bdev::Client bdev_client(custom_pool_id);
+  const chi::u64 ram_size = 48 * k1MB;
+  std::string pool_name =
+      "ram_test_" + std::to_string(getpid()) + "_" + std::to_string(8011);
+  bool bdev_success = BdevChimodFixture::CreateBdevAsync(
+      bdev_client, chi::PoolQuery::Dynamic(), pool_name, custom_pool_id,
+      chimaera::bdev::BdevType::kRam, ram_size);
+  REQUIRE(bdev_success);
+  std::this_thread::sleep_for(100ms);
+
+  auto pool_query = chi::PoolQuery::Local();
+
+  // A 16MB request is served by a single block of the largest size class
+  auto alloc_task = bdev_client.AsyncAllocateBlocks(pool_query, 16 * k1MB);
+  alloc_task.Wait();
+  REQUIRE(alloc_task->return_code_ == 0);
+  REQUIRE(alloc_task->blocks_.size() == 1);
+  chimaera::bdev::Block big_block = alloc_task->blocks_[0];
+  REQUIRE(big_block.size_ == 16 * k1MB);
+  REQUIRE(big_block.block_type_ == 7);  // BlockSizeCategory::k16MB
+
+  // A 5MB request splits into a 4MB and a 1MB block
+  auto split_task = bdev_client.AsyncAllocateBlocks(pool_query, 5 * k1MB);
+  split_task.Wait();
+  REQUIRE(split_task->return_code_ == 0);
+  REQUIRE(split_task->blocks_.size() == 2);
+  std::vector<chimaera::bdev::Block> split_blocks;
+  for (size_t i = 0; i < split_task->blocks_.size(); ++i) {
+    split_blocks.push_back(split_task->blocks_[i]);
+  }
+  REQUIRE(split_blocks[0].size_ == 4 * k1MB);
+  REQUIRE(split_blocks[1].size_ == k1MB);
+
+  // A freed 16MB block is reused by the next 16MB allocation
+  std::vector<chimaera::bdev::Block> free_blocks = {big_block};
+  auto free_task = bdev_client.AsyncFreeBlocks(pool_query, free_blocks);
+  free_task.Wait();
+  REQUIRE(free_task->return_code_ == 0);
+
+  auto realloc_task = bdev_client.AsyncAllocateBlocks(pool_query, 16 * k1MB);
+  realloc_task.Wait();
+  REQUIRE(realloc_task->return_code_ == 0);
+  REQUIRE(realloc_task->blocks_.size() == 1);
+  REQUIRE(realloc_task->blocks_[0].offset_ == big_block.offset_);
+
+  std::vector<chimaera::bdev::Block> cleanup = {realloc_task->blocks_[0]};
+  cleanup.insert(cleanup.end(), split_blocks.begin(), split_blocks.end());
+  auto cleanup_task = bdev_client.AsyncFreeBlocks(pool_query, cleanup);
+  cleanup_task.Wait();
+  REQUIRE(cleanup_task->return_code_ == 0);
+
+  HLOG(kInfo, "RAM backend checkpoint block tests completed");
+}
+
+TEST_CASE("bdev_ram_cross_class_reclaim", "[bdev][ram][reclaim]") {
+  BdevChimodFixture fixture;
+  REQUIRE(g_initialized);
+
+  // Admin client is automatically initialized via CHI_ADMIN singleton
+  std::this_thread::sleep_for(100ms);
+
+  // Create a RAM-based bdev container that 1MB blocks fill completely
+  chi::PoolId custom_pool_id(8012, 0);
+  chimaera::bdev::Client bdev_client(custom_pool_id);
+  const chi::u64 ram_size = 16 * k1MB;
+  std::string pool_name =
+      "ram_test_" + std::to_string(getpid()) + "_" + std::to_string(8012);
+  bool bdev_success = BdevChimodFixture::CreateBdevAsync(
+      bdev_client, chi::PoolQuery::Dynamic(), pool_name, custom_pool_id,
+      chimaera::bdev::BdevType::kRam, ram_size);
+  REQUIRE(bdev_success);
+  std::this_thread::sleep_for(100ms);
+
+  auto pool_query = chi::PoolQuery::Local();
+
+  // Fill the device with 1MB blocks
+  std::vector<chimaera::bdev::Block> small_blocks;
+  for (int i = 0; i < 16; ++i) {
+    auto alloc_task = bdev_client.AsyncAllocateBlocks(pool_query, k1MB);
+    alloc_task.Wait();
+    REQUIRE(alloc_task->return_code_ == 0);
+    REQUIRE(alloc_task->blocks_.size() == 1);
+    small_blocks.push_back(alloc_task->blocks_[0]);
+  }
+  auto full_task = bdev_client.AsyncAllocateBlocks(pool_query, k1MB);
+  full_task.Wait();
+  REQUIRE(full_task->return_code_ != 0);
+
+  // Freed blocks still count as remaining capacity
+  auto free_task = bdev_client.AsyncFreeBlocks(pool_query, small_blocks);
+  free_task.Wait();
+  REQUIRE(free_task->return_code_ == 0);
+  auto stats_task = bdev_client.AsyncGetStats();
+  stats_task.Wait();
+  REQUIRE(stats_task->remaining_size_ == ram_size);
+
+  // A 16MB block is carved from the coalesced 1MB blocks
+  auto big_task = bdev_client.AsyncAllocateBlocks(pool_query, ram_size);
+  big_task.Wait();
+  REQUIRE(big_task->return_code_ == 0);
+  REQUIRE(big_task->blocks_.size() == 1);
+  REQUIRE(big_task->blocks_[0].size_ == ram_size);
+
+  std::vector<chimaera::bdev::Block> cleanup = {big_task->blocks_[0]};
+  auto cleanup_task = bdev_client.AsyncFreeBlocks(pool_query, cleanup);
+  cleanup_task.Wait();
+  REQUIRE(cleanup_task->return_code_ == 0);
+
+  HLOG(kInfo, "RAM backend cross-class reclaim tests completed");
+}
+
 TEST_CASE("bdev_ram_bounds_checking", "[bdev][ram][bounds]") {
   BdevChimodFixture fixture;
   REQUIRE(g_initialized);
@@ -1245,6 +1365,89 @@ TEST_CASE("bdev_file_vs_ram_comparison", "[bdev][file][ram][comparison]") {
   }
 }
 
+TEST_CASE("bdev_file_multi_extent_io", "[bdev][file][io][vectored]") {
+  BdevChimodFixture fixture;
+  REQUIRE(g_initialized);
+  REQUIRE(fixture.createTestFile(kDefaultFileSize));
+
+  chi::PoolId pool_id(8013, 0);
+  chimaera::bdev::Client client(pool_id);
+  bool success = BdevChimodFixture::CreateBdevAsync(
+      client, chi::PoolQuery::Dynamic(), fixture.getTestFile(), pool_id,
+      chimaera::bdev::BdevType::kFile);
+  REQUIRE(success);
+
+  auto pool_query = chi::PoolQuery::Local();
+
+  // Three file-adjacent 4KB blocks, so the write coalesces into one extent
+  chi::u64 base = 0;
+  {
+    auto alloc_task = client.AsyncAllocateBlocks(pool_query, 3 * k4KB);
+    alloc_task.Wait();
+    REQUIRE(alloc_task->return_code_ == 0);
+    REQUIRE(alloc_task->blocks_.size() > 0);
+    base = alloc_task->blocks_[0].offset_;
+  }
+  chi::priv::vector<chimaera::bdev::Block> blocks(HSHM_MALLOC);
+  for (chi::u64 i = 0; i < 3; ++i) {
+    blocks.push_back(chimaera::bdev::Block(base + i * k4KB, k4KB, 0));
+  }
+
+  // The buffer holds the blocks out of order with a 4KB gap before the last
+  const size_t span = 4 * k4KB;
+  const chi::u64 offsets[] = {k4KB, 0, 3 * k4KB};
+  chi::priv::vector<chi::u64> data_offsets(HSHM_MALLOC);
+  for (chi::u64 off : offsets) {
+    data_offsets.push_back(off);
+  }
+  std::vector<hshm::u8> write_data = fixture.generateTestData(span, 0x5A);
+  auto write_buffer = CHI_IPC->AllocateBuffer(span);
+  REQUIRE_FALSE(write_buffer.IsNull());
+  memcpy(write_buffer.ptr_, write_data.data(), span);
+
+  auto write_task = client.AsyncWrite(
+      pool_query, blocks, data_offsets,
+      write_buffer.shm_.template Cast<void>().template Cast<void>(), span);
+  write_task.Wait();
+  REQUIRE(write_task->return_code_ == 0);
+  REQUIRE(write_task->bytes_written_ == 3 * k4KB);
+
+  // Read the blocks back sequentially: the file now holds the pieces in
+  // block order
+  auto read_buffer = CHI_IPC->AllocateBuffer(3 * k4KB);
+  REQUIRE_FALSE(read_buffer.IsNull());
+  auto read_task = client.AsyncRead(
+      pool_query, blocks,
+      read_buffer.shm_.template Cast<void>().template Cast<void>(),
+      3 * k4KB);
+  read_task.Wait();
+  REQUIRE(read_task->return_code_ == 0);
+  REQUIRE(read_task->bytes_read_ == 3 * k4KB);
+  for (size_t i = 0; i < 3; ++i) {
+    REQUIRE(memcmp(read_buffer.ptr_ + i * k4KB,
+                   write_data.data() + offsets[i], k4KB) == 0);
+  }
+
+  // Scatter them back into the original layout with a multi-extent read
+  auto scatter_buffer = CHI_IPC->AllocateBuffer(span);
+  REQUIRE_FALSE(scatter_buffer.IsNull());
+  memset(scatter_buffer.ptr_, 0, span);
+  auto scatter_task = client.AsyncRead(
+      pool_query, blocks, data_offsets,
+      scatter_buffer.shm_.template Cast<void>().template Cast<void>(), span);
+  scatter_task.Wait();
+  REQUIRE(scatter_task->return_code_ == 0);
+  REQUIRE(scatter_task->bytes_read_ == 3 * k4KB);
+  for (chi::u64 off : offsets) {
+    REQUIRE(memcmp(scatter_buffer.ptr_ + off, write_data.data() + off,
+                   k4KB) == 0);
+  }
+
+  CHI_IPC->FreeBuffer(write_buffer);
+  CHI_IPC->FreeBuffer(read_buffer);
+  CHI_IPC->FreeBuffer(scatter_buffer);
+}
+
 /**
  * Helper: runs the bdev file explicit backend write/read test.
  * Called by per-mode TEST_CASEs (SHM, TCP, IPC).
@@ -59,7 +59,7 @@ inline void *AllocGpuContainerHost(const PoolId &pool_id, u32 container_id,
   PoolId *d_pid = hshm::GpuApi::Malloc<PoolId>(sizeof(PoolId));
   hshm::GpuApi::Memcpy(d_pid, &pool_id, sizeof(PoolId));
   _gpu_alloc_container<<<1, 1, 0,
-      static_cast<cudaStream_t>(stream)>>>(d_out, module_id, d_pid, container_id);
+      static_cast<hshm::GpuStream>(stream)>>>(d_out, module_id, d_pid, container_id);
   hshm::GpuApi::Synchronize(stream);
   Container *h_ptr = nullptr;
   hshm::GpuApi::Memcpy(&h_ptr, d_out, sizeof(Container *));
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#include "chimaera/blocking_pool.h"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+#include "chimaera/work_orchestrator.h"
+
+namespace chi {
+
+void BlockingPool::Start(u32 num_threads, u32 max_queued) {
+  if (!threads_.empty()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    stop_ = false;
+    max_queued_ = max_queued;
+  }
+  threads_.reserve(num_threads);
+  for (u32 i = 0; i < num_threads; ++i) {
+    threads_.emplace_back([this]() { ThreadLoop(); });
+  }
+}
+
+void BlockingPool::Stop() {
+  if (threads_.empty()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+  threads_.clear();
+}
+
+std::shared_ptr<BlockingPool::Job> BlockingPool::Submit(
+    std::function<void()> fn) {
+  if (threads_.empty()) {
+    return nullptr;
+  }
+  auto job = std::make_shared<Job>();
+  job->fn_ = std::move(fn);
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (stop_ || queue_.size() >= max_queued_) {
+      return nullptr;
+    }
+    queue_.push_back(job);
+  }
+  cv_.notify_one();
+  return job;
+}
+
+size_t BlockingPool::GetQueuedCount() {
+  std::lock_guard<std::mutex> guard(lock_);
+  return queue_.size();
+}
+
+void BlockingPool::ThreadLoop() {
+  while (true) {
+    std::shared_ptr<Job> job;
+    {
+      std::unique_lock<std::mutex> guard(lock_);
+      cv_.wait(guard, [this]() { return stop_ || !queue_.empty(); });
+      // Drain before exiting so no coroutine waits on a job that never runs
+      if (queue_.empty()) {
+        return;
+      }
+      job = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    try {
+      job->fn_();
+    } catch (const std::exception &e) {
+      HLOG(kError, "BlockingPool: job threw: {}", e.what());
+    } catch (...) {
+      HLOG(kError, "BlockingPool: job threw a non-standard exception");
+    }
+    job->fn_ = nullptr;
+    job->done_.store(true, std::memory_order_release);
+  }
+}
+
+TaskResume RunBlocking(std::function<void()> fn) {
+#ifdef __NVCOMPILER
+  thread_local RunContext fallback_rctx;
+  RunContext *cur_rctx = GetCurrentRunContextFromWorker();
+  RunContext &rctx = cur_rctx ? *cur_rctx : fallback_rctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  auto *orchestrator = CHI_WORK_ORCHESTRATOR;
+  BlockingPool *pool = orchestrator ? orchestrator->GetBlockingPool() : nullptr;
+  if (!pool || !pool->IsEnabled()) {
+    fn();
+    CHI_CO_RETURN;
+  }
+
+  // Poll with exponential backoff: short calls resume quickly, long ones
+  // cost the worker one check per millisecond
+  constexpr double kMinPollUs = 10.0;
+  constexpr double kMaxPollUs = 1000.0;
+  double poll_us = kMinPollUs;
+  std::shared_ptr<BlockingPool::Job> job = pool->Submit(fn);
+  while (!job) {
+    CHI_CO_AWAIT(chi::yield(poll_us));
+    poll_us = std::min(poll_us * 2, kMaxPollUs);
+    job = pool->Submit(fn);
+  }
+  poll_us = kMinPollUs;
+  while (!job->done_.load(std::memory_order_acquire)) {
+    CHI_CO_AWAIT(chi::yield(poll_us));
+    poll_us = std::min(poll_us * 2, kMaxPollUs);
+  }
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+}  // namespace chi
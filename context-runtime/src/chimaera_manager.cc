@@ -38,9 +38,14 @@
 #include <cstdlib>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <utility>
+#include <vector>
 
 #include "chimaera/admin/admin_client.h"
+#include "chimaera/metrics.h"
 #include "chimaera/singletons.h"
+#include "chimaera/task_latency.h"
 
 // Global pointer variable definition for Chimaera manager singleton
 HSHM_DEFINE_GLOBAL_PTR_VAR_CC(chi::Chimaera, g_chimaera_manager);
@@ -143,6 +148,7 @@ bool Chimaera::ClientInit() {
     client_is_initializing_ = false;
     return false;
   }
+  TaskLatencyStats::SetEnabled(config_manager->GetTaskLatency());
 
   HLOG(kDebug, "IpcManager::ClientInit");
   // Initialize IPC manager for client
@@ -191,6 +197,18 @@ bool Chimaera::ServerInit() {
   is_runtime_mode_ = true;
   runtime_is_initializing_ = true;
 
+  // Time each startup phase; the breakdown is logged once the runtime is up
+  hshm::Timepoint startup_start, phase_start;
+  startup_start.Now();
+  phase_start.Now();
+  std::vector<std::pair<const char *, double>> phases;
+  auto end_phase = [&](const char *name) {
+    double ms = phase_start.GetMsecFromStart();
+    phases.emplace_back(name, ms);
+    HLOG(kDebug, "Startup phase {}: {} ms", name, ms);
+    phase_start.Now();
+  };
+
   // Initialize configuration manager first
   auto *config_manager = CHI_CONFIG_MANAGER;
   if (!config_manager->Init()) {
@@ -198,6 +216,8 @@ bool Chimaera::ServerInit() {
     runtime_is_initializing_ = false;
     return false;
   }
+  TaskLatencyStats::SetEnabled(config_manager->GetTaskLatency());
+  end_phase("config");
 
   // Initialize IPC manager for server
   auto *ipc_manager = CHI_IPC;
@@ -209,6 +229,7 @@ bool Chimaera::ServerInit() {
 
   HLOG(kDebug, "Host identification successful: {}",
        ipc_manager->GetCurrentHostname());
+  end_phase("ipc");
 
   // Initialize module manager first (needed for admin chimod)
   auto *module_manager = CHI_MODULE_MANAGER;
@@ -217,6 +238,7 @@ bool Chimaera::ServerInit() {
     runtime_is_initializing_ = false;
     return false;
   }
+  end_phase("modules");
 
   // Initialize work orchestrator before pool manager
   auto *work_orchestrator = CHI_WORK_ORCHESTRATOR;
@@ -232,6 +254,9 @@ bool Chimaera::ServerInit() {
     runtime_is_initializing_ = false;
     return false;
   }
+  auto *metrics = CHI_METRICS;
+  metrics->RegisterRuntimeCollector();
+  end_phase("workers");
 
   // Initialize pool manager (server mode only) after work orchestrator
   auto *pool_manager = CHI_POOL_MANAGER;
@@ -240,6 +265,7 @@ bool Chimaera::ServerInit() {
     runtime_is_initializing_ = false;
     return false;
   }
+  end_phase("pools");
 
   // Process compose section if present
   const auto &compose_config = config_manager->GetComposeConfig();
@@ -254,34 +280,59 @@ bool Chimaera::ServerInit() {
       return false;
     }
 
-    // Iterate over each pool configuration and create asynchronously
-    for (auto pool_config : compose_config.pools_) {
-      // On restart, force restart_=true so containers call Restart() instead of
-      // Init()
-      if (is_restart_) {
-        pool_config.restart_ = true;
+    // Consecutive entries of the same ChiMod (e.g. a list of bdevs) are
+    // independent, so each such run is created concurrently and its
+    // broadcast rounds overlap. A change of module is a barrier, since a
+    // later module may open pools composed before it.
+    const auto &pools = compose_config.pools_;
+    size_t run_begin = 0;
+    while (run_begin < pools.size()) {
+      size_t run_end = run_begin + 1;
+      while (run_end < pools.size() &&
+             pools[run_end].mod_name_ == pools[run_begin].mod_name_) {
+        ++run_end;
       }
 
-      HLOG(kInfo, "Compose: Creating pool {} (module: {}, restart: {})",
-           pool_config.pool_name_, pool_config.mod_name_, pool_config.restart_);
-
-      // Create pool asynchronously and wait
-      auto task = admin_client->AsyncCompose(pool_config);
-      task.Wait();
+      std::vector<chi::Future<chimaera::admin::ComposeTask<PoolConfig>>> tasks;
+      tasks.reserve(run_end - run_begin);
+      for (size_t i = run_begin; i < run_end; ++i) {
+        PoolConfig pool_config = pools[i];
+        // On restart, force restart_=true so containers call Restart()
+        // instead of Init()
+        if (is_restart_) {
+          pool_config.restart_ = true;
+        }
+
+        HLOG(kInfo, "Compose: Creating pool {} (module: {}, restart: {})",
+             pool_config.pool_name_, pool_config.mod_name_,
+             pool_config.restart_);
+        tasks.push_back(admin_client->AsyncCompose(pool_config));
+      }
 
-      // Check return code
-      u32 return_code = task->GetReturnCode();
-      if (return_code != 0) {
-        HLOG(kError,
-             "Compose: Failed to create pool {} (module: {}), return code: {}",
-             pool_config.pool_name_, pool_config.mod_name_, return_code);
+      // Wait for the whole run before reporting so no task is abandoned
+      bool run_failed = false;
+      for (size_t i = run_begin; i < run_end; ++i) {
+        auto &task = tasks[i - run_begin];
+        task.Wait();
+
+        // Check return code
+        u32 return_code = task->GetReturnCode();
+        if (return_code != 0) {
+          HLOG(kError,
+               "Compose: Failed to create pool {} (module: {}), return code: "
+               "{}",
+               pools[i].pool_name_, pools[i].mod_name_, return_code);
+          run_failed = true;
+          continue;
+        }
+
+        HLOG(kInfo, "Compose: Successfully created pool {} (module: {})",
+             pools[i].pool_name_, pools[i].mod_name_);
+      }
+      if (run_failed) {
         return false;
       }
-
-      HLOG(kInfo, "Compose: Successfully created pool {} (module: {})",
-           pool_config.pool_name_, pool_config.mod_name_);
-
-      // Cleanup task
+      run_begin = run_end;
     }
 
     HLOG(kInfo, "Compose: All {} pools created successfully",
@@ -294,6 +345,7 @@ bool Chimaera::ServerInit() {
       pool_manager->ReplayAddressTableWAL();
     }
   }
+  end_phase("compose");
 
   // Launch GPU work orchestrator after all initial pools are created, so that
   // cudaMalloc calls during GPU container allocation don't deadlock
@@ -307,6 +359,10 @@ bool Chimaera::ServerInit() {
   }
 #endif
 
+  // A metrics port that cannot be bound is logged but is not fatal
+  metrics->StartServer(config_manager->GetMetricsBind(),
+                       config_manager->GetMetricsPort());
+
   // Start local server last - after all other initialization is complete
   // This ensures clients can connect only when runtime is fully ready
   if (!ipc_manager->StartLocalServer()) {
@@ -317,6 +373,17 @@ bool Chimaera::ServerInit() {
     return false;
   }
 
+  end_phase("servers");
+
+  // HLOG has no precision specifiers, so the summary is formatted here
+  std::ostringstream breakdown;
+  breakdown << std::fixed << std::setprecision(1)
+            << startup_start.GetMsecFromStart() << " ms:";
+  for (const auto &phase : phases) {
+    breakdown << " " << phase.first << "=" << phase.second << "ms";
+  }
+  HLOG(kInfo, "Runtime started in {}", breakdown.str());
+
   is_runtime_initialized_ = true;
   is_initialized_ = true;
   runtime_is_initializing_ = false;
@@ -349,6 +416,11 @@ void Chimaera::ServerFinalize() {
     return;
   }
 
+  // Stop scraping before the workers and pools it reads go away
+  auto *metrics = CHI_METRICS;
+  metrics->StopServer();
+  metrics->Unregister("chimaera");
+
   // Stop workers and finalize server components
   auto *work_orchestrator = CHI_WORK_ORCHESTRATOR;
   work_orchestrator->StopWorkers();
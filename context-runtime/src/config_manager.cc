@@ -38,6 +38,7 @@
 #include "chimaera/config_manager.h"
 #include "chimaera/task.h"
 #include "chimaera/ipc_manager.h"
+#include <cctype>
 #include <cstdlib>
 #include <filesystem>
 
@@ -139,6 +140,40 @@ std::string ConfigManager::GetServerAddr() const { return server_addr_; }
 
 u32 ConfigManager::GetNeighborhoodSize() const { return neighborhood_size_; }
 
+hipc::HugePageMode ConfigManager::ParseHugePageMode(const std::string &value) {
+  std::string v = value;
+  for (char &c : v) {
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  if (v == "thp" || v == "transparent") {
+    return hipc::HugePageMode::kTransparent;
+  }
+  if (v == "2mb") {
+    return hipc::HugePageMode::k2MB;
+  }
+  if (v == "1gb") {
+    return hipc::HugePageMode::k1GB;
+  }
+  if (v != "none" && !v.empty()) {
+    HLOG(kWarning, "Unknown huge page mode '{}', using none", value);
+  }
+  return hipc::HugePageMode::kNone;
+}
+
+hipc::HugePageMode
+ConfigManager::GetMemorySegmentHugePages(MemorySegment segment) const {
+  switch (segment) {
+  case kMainSegment:
+    return main_segment_huge_pages_;
+  case kClientDataSegment:
+    return client_data_segment_huge_pages_;
+  case kQueueSegment:
+    return queue_segment_huge_pages_;
+  default:
+    return hipc::HugePageMode::kNone;
+  }
+}
+
 std::string
 ConfigManager::GetSharedMemorySegmentName(MemorySegment segment) const {
   std::string segment_name;
@@ -183,6 +218,13 @@ void ConfigManager::LoadDefault() {
   port_ = 9413;
   neighborhood_size_ = 32;
 
+  // Huge pages are opt-in per segment
+  main_segment_huge_pages_ = hipc::HugePageMode::kNone;
+  client_data_segment_huge_pages_ = hipc::HugePageMode::kNone;
+  queue_segment_huge_pages_ = hipc::HugePageMode::kNone;
+  gpu_huge_pages_ = hipc::HugePageMode::kNone;
+  prefault_segments_ = false;
+
   // Set default shared memory segment names with environment variables
   main_segment_name_ = "chi_main_segment_${USER}";
   client_data_segment_name_ = "chi_client_data_segment_${USER}";
@@ -193,13 +235,42 @@ void ConfigManager::LoadDefault() {
   // Set default network retry configuration
   wait_for_restart_timeout_ = 30;      // 30 seconds
   wait_for_restart_poll_period_ = 1;   // 1 second
+  net_coalesce_bytes_ = 65536;         // 64KB per message
+  net_coalesce_max_tasks_ = 64;        // 64 tasks per message
+  net_coalesce_delay_us_ = 50;         // hold at most 50us
+  net_transport_ = "zeromq";
+  fabric_provider_ = "";
+  fabric_domain_ = "";
+  net_stripes_ = 1;
+  net_compression_ = "none";
+  net_compression_min_bytes_ = 65536;  // compress bulks from 64KB
 
   // Set default worker sleep configuration (in microseconds)
   first_busy_wait_ = 50;               // 50us busy wait
   max_sleep_ = 50000;                  // 50000us (50ms) maximum sleep
+  poll_mode_ = "sleep";                // busy-wait, then epoll
+  wake_latency_target_us_ = 0;         // no wake-up latency target
+  max_spin_us_ = 1000;                 // 1ms adaptive spin budget
+
+  // Task lifecycle latency histograms are off by default
+  task_latency_ = false;
+
+  // Metrics endpoint is off by default and loopback-only when enabled
+  metrics_port_ = 0;
+  metrics_bind_ = "127.0.0.1";
 
   // Set default task load prediction model learning rate
   learning_rate_ = 0.2f;
+
+  // Workers are not pinned by default
+  worker_affinity_ = WorkerAffinityConfig();
+
+  // Two threads take blocking calls (file flushes, HDF5 reads) off workers
+  blocking_threads_ = 2;
+  blocking_queue_depth_ = 256;
+
+  // Each SHM client may have up to 1024 tasks in flight
+  client_credits_ = 1024;
 }
 
 void ConfigManager::ParseYAML(YAML::Node &yaml_conf) {
@@ -223,10 +294,42 @@ void ConfigManager::ParseYAML(YAML::Node &yaml_conf) {
       local_sched_ = runtime["local_sched"].as<std::string>();
     }
 
+    // Workers that metadata tasks are hash-partitioned across
+    if (runtime["metadata_workers"]) {
+      metadata_workers_ = runtime["metadata_workers"].as<u32>();
+    }
+
+    // Workers that runtime-to-runtime traffic is sharded across
+    if (runtime["net_workers"]) {
+      net_workers_ = runtime["net_workers"].as<u32>();
+    }
+
     // Worker sleep configuration
     if (runtime["first_busy_wait"]) {
       first_busy_wait_ = runtime["first_busy_wait"].as<u32>();
     }
+    if (runtime["poll_mode"]) {
+      poll_mode_ = runtime["poll_mode"].as<std::string>();
+    }
+    if (runtime["wake_latency_target_us"]) {
+      wake_latency_target_us_ = runtime["wake_latency_target_us"].as<u32>();
+    }
+    if (runtime["max_spin_us"]) {
+      max_spin_us_ = runtime["max_spin_us"].as<u32>();
+    }
+
+    // Per-task lifecycle latency histograms
+    if (runtime["task_latency"]) {
+      task_latency_ = runtime["task_latency"].as<bool>();
+    }
+
+    // Prometheus/OpenMetrics endpoint
+    if (runtime["metrics_port"]) {
+      metrics_port_ = runtime["metrics_port"].as<u32>();
+    }
+    if (runtime["metrics_bind"]) {
+      metrics_bind_ = runtime["metrics_bind"].as<std::string>();
+    }
 
     // Configuration directory for persistent runtime config
     if (runtime["conf_dir"]) {
@@ -238,10 +341,74 @@ void ConfigManager::ParseYAML(YAML::Node &yaml_conf) {
       learning_rate_ = runtime["learning_rate"].as<float>();
     }
 
+    // Topology-aware worker pinning
+    if (runtime["worker_affinity"]) {
+      auto affinity = runtime["worker_affinity"];
+      WorkerAffinityConfig &conf = worker_affinity_;
+      if (affinity["enabled"]) {
+        conf.enabled_ = affinity["enabled"].as<bool>();
+      }
+      if (affinity["smt_siblings"]) {
+        conf.smt_siblings_ = affinity["smt_siblings"].as<bool>();
+      }
+      if (affinity["sched"]) {
+        conf.sched_ = affinity["sched"].as<std::string>();
+      }
+      if (affinity["io"]) {
+        conf.io_ = affinity["io"].as<std::string>();
+      }
+      if (affinity["gpu"]) {
+        conf.gpu_ = affinity["gpu"].as<std::string>();
+      }
+      if (affinity["net"]) {
+        conf.net_ = affinity["net"].as<std::string>();
+      }
+      if (affinity["nic"]) {
+        conf.nic_ = affinity["nic"].as<std::string>();
+      }
+    }
+
+    // Pool for blocking ChiMod calls
+    if (runtime["blocking_threads"]) {
+      blocking_threads_ = runtime["blocking_threads"].as<u32>();
+    }
+    if (runtime["blocking_queue_depth"]) {
+      blocking_queue_depth_ = runtime["blocking_queue_depth"].as<u32>();
+    }
+
+    // Per-client admission control
+    if (runtime["client_credits"]) {
+      client_credits_ = runtime["client_credits"].as<u32>();
+    }
+
     // Note: stack_size parameter removed (was never used)
     // Note: heartbeat_interval parsing removed (not used by runtime)
   }
 
+  // Parse memory segment configuration
+  if (yaml_conf["memory"]) {
+    auto memory = yaml_conf["memory"];
+    if (memory["main_segment_huge_pages"]) {
+      main_segment_huge_pages_ = ParseHugePageMode(
+          memory["main_segment_huge_pages"].as<std::string>());
+    }
+    if (memory["client_data_segment_huge_pages"]) {
+      client_data_segment_huge_pages_ = ParseHugePageMode(
+          memory["client_data_segment_huge_pages"].as<std::string>());
+    }
+    if (memory["queue_segment_huge_pages"]) {
+      queue_segment_huge_pages_ = ParseHugePageMode(
+          memory["queue_segment_huge_pages"].as<std::string>());
+    }
+    if (memory["gpu_huge_pages"]) {
+      gpu_huge_pages_ =
+          ParseHugePageMode(memory["gpu_huge_pages"].as<std::string>());
+    }
+    if (memory["prefault_segments"]) {
+      prefault_segments_ = memory["prefault_segments"].as<bool>();
+    }
+  }
+
   // Parse GPU orchestrator configuration
   if (yaml_conf["gpu"]) {
     auto gpu = yaml_conf["gpu"];
@@ -254,6 +421,12 @@ void ConfigManager::ParseYAML(YAML::Node &yaml_conf) {
     if (gpu["queue_depth"]) {
       gpu_queue_depth_ = gpu["queue_depth"].as<u32>();
     }
+    if (gpu["max_pop_burst"]) {
+      gpu_max_pop_burst_ = gpu["max_pop_burst"].as<u32>();
+    }
+    if (gpu["idle_sleep_max_ns"]) {
+      gpu_idle_sleep_max_ns_ = gpu["idle_sleep_max_ns"].as<u32>();
+    }
   }
   // Environment variable overrides for GPU config (higher priority than YAML).
   // Allows benchmarks to set the partition count dynamically from their
@@ -283,6 +456,34 @@ void ConfigManager::ParseYAML(YAML::Node &yaml_conf) {
     if (networking["wait_for_restart_poll_period"]) {
       wait_for_restart_poll_period_ = networking["wait_for_restart_poll_period"].as<u32>();
     }
+    if (networking["coalesce_bytes"]) {
+      net_coalesce_bytes_ = networking["coalesce_bytes"].as<u32>();
+    }
+    if (networking["coalesce_max_tasks"]) {
+      net_coalesce_max_tasks_ = networking["coalesce_max_tasks"].as<u32>();
+    }
+    if (networking["coalesce_delay_us"]) {
+      net_coalesce_delay_us_ = networking["coalesce_delay_us"].as<u32>();
+    }
+    if (networking["transport"]) {
+      net_transport_ = networking["transport"].as<std::string>();
+    }
+    if (networking["fabric_provider"]) {
+      fabric_provider_ = networking["fabric_provider"].as<std::string>();
+    }
+    if (networking["fabric_domain"]) {
+      fabric_domain_ = networking["fabric_domain"].as<std::string>();
+    }
+    if (networking["stripes"]) {
+      net_stripes_ = networking["stripes"].as<u32>();
+    }
+    if (networking["compression"]) {
+      net_compression_ = networking["compression"].as<std::string>();
+    }
+    if (networking["compression_min_bytes"]) {
+      net_compression_min_bytes_ = hshm::ConfigParse::ParseSize(
+          networking["compression_min_bytes"].as<std::string>());
+    }
   }
 
   // Segment names are hardcoded and expanded in ipc_manager.cc
@@ -324,6 +525,28 @@ void ConfigManager::ParseYAML(YAML::Node &yaml_conf) {
           pool_config.restart_ = pool_node["restart"].as<bool>();
         }
 
+        // Shard the pool into several containers per node. "numa" gives
+        // one per NUMA node of this machine.
+        if (pool_node["containers_per_node"]) {
+          std::string shards =
+              pool_node["containers_per_node"].as<std::string>();
+          if (shards == "numa") {
+            pool_config.containers_per_node_ = static_cast<u32>(
+                hshm::SystemInfo::GetNumaNodeCount());
+          } else {
+            pool_config.containers_per_node_ =
+                pool_node["containers_per_node"].as<u32>();
+          }
+          if (pool_config.containers_per_node_ == 0) {
+            pool_config.containers_per_node_ = 1;
+          }
+        } else if (pool_config.mod_name_ == "wrp_cte_core" &&
+                   metadata_workers_ > 1) {
+          // Metadata is routed by container, so one CTE container would use
+          // a single metadata worker; start one shard per metadata worker
+          pool_config.containers_per_node_ = metadata_workers_;
+        }
+
         // Add to compose config
         compose_config_.pools_.push_back(pool_config);
       }
@@ -345,7 +568,7 @@ size_t ConfigManager::CalculateMainSegmentSize() const {
 size_t ConfigManager::CalculateQueueSegmentSize() const {
   // Queue segment holds TaskQueue and NetQueue ring buffers (ArenaAllocator)
   constexpr size_t BASE_OVERHEAD = 4 * 1024 * 1024;  // 4MB for allocator metadata
-  constexpr u32 NUM_PRIORITIES = 2;                   // normal + resumed
+  constexpr u32 NUM_PRIORITIES = 2;                   // normal + high
 
   // Calculate total workers: num_threads + 1 network worker
   u32 total_workers = num_threads_ + 1;
@@ -362,7 +585,8 @@ size_t ConfigManager::CalculateQueueSegmentSize() const {
       4,                  // num_priorities: SendIn, SendOut, ClientSendTcp, ClientSendIpc
       queue_depth_);      // depth per queue
 
-  return BASE_OVERHEAD + worker_queues_size + net_queue_size;
+  return BASE_OVERHEAD + worker_queues_size + net_queue_size +
+         sizeof(ClientCreditTable) + sizeof(LaneStatsTable);
 }
 
 } // namespace chi
\ No newline at end of file
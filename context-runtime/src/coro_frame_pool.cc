@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#include "chimaera/coro_frame_pool.h"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace chi {
+
+namespace {
+
+/**
+ * Prefix of every frame. It records the class so Free needs no size, and
+ * pads the frame to the default new alignment.
+ */
+struct alignas(std::max_align_t) FrameHeader {
+  u32 cls_;
+};
+
+/** Free-list link stored in the body of a released frame */
+struct FreeFrame {
+  FreeFrame *next_;
+};
+
+/**
+ * Counters of one thread. Only the owner writes them, with relaxed
+ * load/store pairs, so collecting them from another thread is race-free
+ * without locked instructions on the hot path.
+ */
+struct ThreadFrameStats {
+  std::atomic<u64> allocs_[CoroFrameStats::kNumBins] = {};
+  std::atomic<u64> pool_hits_{0};
+  std::atomic<u64> frees_{0};
+  std::atomic<u64> max_frame_size_{0};
+  std::atomic<u64> cached_frames_{0};
+
+  static void Bump(std::atomic<u64> &counter, u64 delta = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + delta,
+                  std::memory_order_relaxed);
+  }
+
+  void AddTo(CoroFrameStats &out) const {
+    for (u32 i = 0; i < CoroFrameStats::kNumBins; ++i) {
+      out.allocs_[i] += allocs_[i].load(std::memory_order_relaxed);
+    }
+    out.pool_hits_ += pool_hits_.load(std::memory_order_relaxed);
+    out.frees_ += frees_.load(std::memory_order_relaxed);
+    u64 max_size = max_frame_size_.load(std::memory_order_relaxed);
+    if (max_size > out.max_frame_size_) out.max_frame_size_ = max_size;
+  }
+};
+
+/** Registry of live threads' counters plus totals of exited threads */
+struct FramePoolState {
+  std::mutex lock_;
+  std::vector<ThreadFrameStats *> live_;
+  CoroFrameStats retired_;
+};
+
+FramePoolState &State() {
+  static FramePoolState *state = new FramePoolState();  // Outlives threads
+  return *state;
+}
+
+/** Per-thread free lists; the heap gets everything back at thread exit */
+struct ThreadFrameCache {
+  FreeFrame *heads_[CoroFramePool::kNumClasses] = {};
+  u32 counts_[CoroFramePool::kNumClasses] = {};
+  ThreadFrameStats stats_;
+
+  ThreadFrameCache() {
+    FramePoolState &state = State();
+    std::lock_guard<std::mutex> guard(state.lock_);
+    state.live_.push_back(&stats_);
+  }
+
+  ~ThreadFrameCache();
+};
+
+/** Set once this thread's cache is destroyed; frames then bypass it */
+thread_local bool t_cache_dead = false;
+thread_local ThreadFrameCache t_cache;
+
+ThreadFrameCache::~ThreadFrameCache() {
+  t_cache_dead = true;
+  for (u32 cls = 0; cls < CoroFramePool::kNumClasses; ++cls) {
+    FreeFrame *frame = heads_[cls];
+    while (frame) {
+      FreeFrame *next = frame->next_;
+      ::operator delete(reinterpret_cast<FrameHeader *>(frame) - 1);
+      frame = next;
+    }
+    heads_[cls] = nullptr;
+  }
+  stats_.cached_frames_.store(0, std::memory_order_relaxed);
+  FramePoolState &state = State();
+  std::lock_guard<std::mutex> guard(state.lock_);
+  stats_.AddTo(state.retired_);
+  for (auto it = state.live_.begin(); it != state.live_.end(); ++it) {
+    if (*it == &stats_) {
+      state.live_.erase(it);
+      break;
+    }
+  }
+}
+
+/** Get fresh storage for a frame of class cls holding size bytes */
+void *NewFrame(u32 cls, size_t size) {
+  size_t body = cls < CoroFramePool::kNumClasses
+                    ? CoroFramePool::ClassSize(cls)
+                    : size;
+  auto *header = static_cast<FrameHeader *>(
+      ::operator new(sizeof(FrameHeader) + body));
+  header->cls_ = cls;
+  return header + 1;
+}
+
+}  // namespace
+
+void *CoroFramePool::Allocate(size_t size) {
+  u32 cls = ClassOf(size);
+  if (t_cache_dead) {
+    return NewFrame(cls, size);
+  }
+  ThreadFrameCache &cache = t_cache;
+  ThreadFrameStats &stats = cache.stats_;
+  ThreadFrameStats::Bump(stats.allocs_[cls]);
+  if (size > stats.max_frame_size_.load(std::memory_order_relaxed)) {
+    stats.max_frame_size_.store(size, std::memory_order_relaxed);
+  }
+  if (cls < kNumClasses && cache.heads_[cls]) {
+    FreeFrame *frame = cache.heads_[cls];
+    cache.heads_[cls] = frame->next_;
+    cache.counts_[cls] -= 1;
+    ThreadFrameStats::Bump(stats.pool_hits_);
+    stats.cached_frames_.store(
+        stats.cached_frames_.load(std::memory_order_relaxed) - 1,
+        std::memory_order_relaxed);
+    return frame;
+  }
+  return NewFrame(cls, size);
+}
+
+void CoroFramePool::Free(void *ptr) noexcept {
+  if (!ptr) return;
+  FrameHeader *header = static_cast<FrameHeader *>(ptr) - 1;
+  u32 cls = header->cls_;
+  if (t_cache_dead) {
+    ::operator delete(header);
+    return;
+  }
+  ThreadFrameCache &cache = t_cache;
+  ThreadFrameStats::Bump(cache.stats_.frees_);
+  if (cls >= kNumClasses || cache.counts_[cls] >= kMaxCachedPerClass) {
+    ::operator delete(header);
+    return;
+  }
+  FreeFrame *frame = static_cast<FreeFrame *>(ptr);
+  frame->next_ = cache.heads_[cls];
+  cache.heads_[cls] = frame;
+  cache.counts_[cls] += 1;
+  ThreadFrameStats::Bump(cache.stats_.cached_frames_);
+}
+
+CoroFrameStats CoroFramePool::CollectStats() {
+  FramePoolState &state = State();
+  std::lock_guard<std::mutex> guard(state.lock_);
+  CoroFrameStats out = state.retired_;
+  for (ThreadFrameStats *stats : state.live_) {
+    stats->AddTo(out);
+    out.cached_frames_ +=
+        stats->cached_frames_.load(std::memory_order_relaxed);
+  }
+  return out;
+}
+
+CoroFrameStats CoroFramePool::GetThreadStats() {
+  CoroFrameStats out;
+  if (t_cache_dead) return out;
+  const ThreadFrameStats &stats = t_cache.stats_;
+  stats.AddTo(out);
+  out.cached_frames_ = stats.cached_frames_.load(std::memory_order_relaxed);
+  return out;
+}
+
+}  // namespace chi
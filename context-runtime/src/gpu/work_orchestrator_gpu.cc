@@ -42,6 +42,19 @@
  * child kernel launches. Thread 0 polls queues and launches child kernels as needed.
  * Container tasks run in those child kernels rather than in the persistent kernel itself.
  *
+ * HIP has no dynamic parallelism. There the orchestrator runs as one block of
+ * kWarpSize threads: thread 0 polls and parks up to Worker::kMaxInlineTasks
+ * popped tasks, then the whole block runs them inline before the next round.
+ * Task methods see the same 32-lane parallelism they get from RunTask, but a
+ * task that waits on another GPU task would stall the poller, so such tasks
+ * must be submitted from client kernels rather than from container methods.
+ *
+ * Elasticity: the poller sleeps with exponential backoff while the queues are
+ * idle (shrinking to one mostly-sleeping thread), and its per-round pop
+ * budget grows with queue depth, so the RunTask blocks in flight track load.
+ * Both knobs live in the pinned control block and can be changed while the
+ * kernel runs.
+ *
  * All GPU containers are allocated within this CUDA module's context, so
  * virtual function dispatch (vtables) works correctly. No companion .so
  * files or function pointer fixups are needed.
@@ -61,10 +74,18 @@
 
 namespace chi {
 
+#if HSHM_ENABLE_ROCM
+/** Orchestrator block size: the block also executes the popped tasks */
+static constexpr u32 kOrchestratorThreads = gpu::kWarpSize;
+#else
+/** Orchestrator block size: one polling thread, tasks run in CDP children */
+static constexpr u32 kOrchestratorThreads = 1;
+#endif
+
 /**
  * GPU Work Orchestrator - persistent kernel for GPU task execution.
  * Thread 0 polls queues and launches GPU tasks via CUDA Dynamic Parallelism.
- * Runs with 1 block, 1 thread.
+ * Runs with 1 block of kOrchestratorThreads threads.
  */
 __global__ void chimaera_gpu_orchestrator(gpu::PoolManager *pool_mgr,
                                            gpu::WorkOrchestratorControl *control,
@@ -81,6 +102,43 @@ __global__ void chimaera_gpu_orchestrator(gpu::PoolManager *pool_mgr,
   }
   __syncthreads();
 
+#if HSHM_ENABLE_ROCM
+  // Thread 0 polls; the whole block then runs the tasks it parked
+  __shared__ gpu::Worker worker;
+  __shared__ int s_work;
+  __shared__ int s_stop;
+  if (threadIdx.x == 0) {
+    worker.Init(0,           // worker_id
+                gpu_info.cpu2gpu_queue,
+                gpu_info.gpu2gpu_queue,
+                gpu_info.internal_queue,
+                pool_mgr,
+                control->cpu2gpu_queue_base,
+                control);
+  }
+  __syncthreads();
+
+  while (true) {
+    if (threadIdx.x == 0) {
+      s_work = worker.PollGpu2Gpu() + worker.PollCpu2Gpu();
+      s_stop = !(worker.is_running_ && !control->exit_flag);
+    }
+    __syncthreads();
+    worker.RunInlineTasks();
+    if (threadIdx.x == 0) {
+      // Relay CPU→GPU completions now rather than one round later
+      worker.RelayPendingCompletions();
+      worker.Backoff(s_work);
+    }
+    __syncthreads();
+    if (s_stop) break;
+  }
+
+  if (threadIdx.x == 0) {
+    worker.FlushProfile();
+    worker.Finalize();
+  }
+#else
   // Only thread 0 polls
   if (threadIdx.x == 0) {
     // Store gpu_info in device heap so CDP child kernels can access it
@@ -109,10 +167,11 @@ __global__ void chimaera_gpu_orchestrator(gpu::PoolManager *pool_mgr,
            (void*)worker.cpu2gpu_queue_);
     while (worker.is_running_ && !control->exit_flag) {
       int g2g = worker.PollGpu2Gpu();
-      worker.PollCpu2Gpu();
+      int c2g = worker.PollCpu2Gpu();
       if (g2g > 0) {
         printf("[ORCH] loop=%d g2g=%d\n", loop_count, g2g);
       }
+      worker.Backoff(g2g + c2g);
       ++loop_count;
     }
 
@@ -121,6 +180,7 @@ __global__ void chimaera_gpu_orchestrator(gpu::PoolManager *pool_mgr,
     worker.Finalize();
     if (d_gpu_info) free(d_gpu_info);
   }
+#endif
 }
 
 //==============================================================================
@@ -129,7 +189,8 @@ __global__ void chimaera_gpu_orchestrator(gpu::PoolManager *pool_mgr,
 
 /**
  * Launch the persistent GPU work orchestrator.
- * Runs with 1 block, 1 thread (CDP child kernels will handle actual task execution).
+ * Runs with 1 block of kOrchestratorThreads threads: CDP child kernels handle
+ * task execution on CUDA, the block itself runs them inline on HIP.
  */
 bool gpu::WorkOrchestrator::Launch(const IpcManagerGpuInfo &gpu_info, u32 blocks,
                                     u32 threads_per_block,
@@ -139,22 +200,24 @@ bool gpu::WorkOrchestrator::Launch(const IpcManagerGpuInfo &gpu_info, u32 blocks
   }
 
   // Allocate WorkOrchestratorControl in pinned host memory
-  gpu::WorkOrchestratorControl *pinned_control = nullptr;
-  cudaMallocHost(&pinned_control, sizeof(gpu::WorkOrchestratorControl));
-  control_ = pinned_control;
+  control_ = hshm::GpuApi::MallocHost<gpu::WorkOrchestratorControl>(
+      sizeof(gpu::WorkOrchestratorControl));
   if (!control_) {
     HLOG(kError, "gpu::WorkOrchestrator: Failed to allocate control structure");
     return false;
   }
   memset(control_, 0, sizeof(gpu::WorkOrchestratorControl));
   control_->cpu2gpu_queue_base = cpu2gpu_queue_base;
+  control_->max_pop_burst = gpu::WorkOrchestratorControl::kDefaultPopBurst;
+  control_->idle_sleep_max_ns =
+      gpu::WorkOrchestratorControl::kDefaultIdleSleepMaxNs;
 
   // Allocate gpu::PoolManager on device
   gpu::PoolManager *d_pm = hshm::GpuApi::Malloc<gpu::PoolManager>(
       sizeof(gpu::PoolManager));
   if (!d_pm) {
     HLOG(kError, "gpu::WorkOrchestrator: Failed to allocate GPU PoolManager");
-    cudaFreeHost(control_);
+    hshm::GpuApi::FreeHost(control_);
     control_ = nullptr;
     return false;
   }
@@ -164,12 +227,18 @@ bool gpu::WorkOrchestrator::Launch(const IpcManagerGpuInfo &gpu_info, u32 blocks
   gpu::PoolManager host_pm;
   hshm::GpuApi::Memcpy(d_pm, &host_pm, sizeof(gpu::PoolManager));
 
-  // Set GPU limits for CDP
+  // Set GPU limits (the device-runtime ones only matter for CDP)
+#if HSHM_ENABLE_ROCM
+  (void)hipDeviceSetLimit(hipLimitStackSize, 16384);
+  (void)hipDeviceSetLimit(hipLimitPrintfFifoSize, 4 * 1024 * 1024);
+  (void)hipDeviceSetLimit(hipLimitMallocHeapSize, 32 * 1024 * 1024);
+#else
   cudaDeviceSetLimit(cudaLimitStackSize, 16384);
   cudaDeviceSetLimit(cudaLimitPrintfFifoSize, 4 * 1024 * 1024);
   cudaDeviceSetLimit(cudaLimitDevRuntimePendingLaunchCount, 4096);
   cudaDeviceSetLimit(cudaLimitDevRuntimeSyncDepth, 16);
   cudaDeviceSetLimit(cudaLimitMallocHeapSize, 32 * 1024 * 1024);
+#endif
 
   // Create dedicated stream
   stream_ = hshm::GpuApi::CreateStream();
@@ -186,12 +255,15 @@ bool gpu::WorkOrchestrator::Launch(const IpcManagerGpuInfo &gpu_info, u32 blocks
   launch_info.gpu2gpu_num_lanes = 1;
   launch_info.internal_num_lanes = 1;
 
-  // Launch persistent GPU work orchestrator with 1 block, 1 thread
-  HLOG(kInfo, "Launching GPU work orchestrator with 1 block, 1 thread (CDP-based)");
-  chimaera_gpu_orchestrator<<<1, 1, 0,
-      static_cast<cudaStream_t>(stream_)>>>(
+  // Launch persistent GPU work orchestrator as a single block
+  HLOG(kInfo, "Launching GPU work orchestrator with 1 block, {} thread(s)",
+       kOrchestratorThreads);
+  chimaera_gpu_orchestrator<<<1, kOrchestratorThreads, 0,
+      static_cast<hshm::GpuStream>(stream_)>>>(
       d_pm, control_, launch_info, 1);
 
+  run_start_ = std::chrono::steady_clock::now();
+  run_ns_ = 0;
   launched_num_warps_ = 1;
   is_launched_ = true;
   HLOG(kInfo, "GPU work orchestrator launched successfully");
@@ -210,6 +282,7 @@ void gpu::WorkOrchestrator::Finalize() {
 
   if (stream_) {
     hshm::GpuApi::Synchronize(stream_);
+    run_ns_ = GetRunNs();
     hshm::GpuApi::DestroyStream(stream_);
     stream_ = nullptr;
   } else {
@@ -221,7 +294,7 @@ void gpu::WorkOrchestrator::Finalize() {
     d_pool_mgr_ = nullptr;
   }
   if (control_) {
-    cudaFreeHost(control_);
+    hshm::GpuApi::FreeHost(control_);
     control_ = nullptr;
   }
 
@@ -237,14 +310,14 @@ void gpu::WorkOrchestrator::Pause() {
   control_->exit_flag = 1;
   HLOG(kInfo, "GPU work orchestrator: exit_flag set, waiting for kernel...");
 
-  cudaError_t pre_err = cudaGetLastError();
-  if (pre_err != cudaSuccess) {
-    HLOG(kError, "GPU work orchestrator: pre-sync CUDA error: {}",
-         cudaGetErrorString(pre_err));
+  const char *pre_err = hshm::GpuApi::PopLastError();
+  if (pre_err) {
+    HLOG(kError, "GPU work orchestrator: pre-sync GPU error: {}", pre_err);
   }
 
   hshm::GpuApi::Synchronize(stream_);
   HLOG(kInfo, "GPU work orchestrator: kernel synchronized");
+  run_ns_ = GetRunNs();
   is_launched_ = false;
 }
 
@@ -263,10 +336,10 @@ void gpu::WorkOrchestrator::Resume(const IpcManagerGpuInfo &gpu_info) {
     return;
   }
 
-  cudaError_t pre_err = cudaGetLastError();
-  if (pre_err != cudaSuccess) {
-    HLOG(kError, "GPU work orchestrator Resume: clearing sticky CUDA error: {}",
-         cudaGetErrorString(pre_err));
+  const char *pre_err = hshm::GpuApi::PopLastError();
+  if (pre_err) {
+    HLOG(kError, "GPU work orchestrator Resume: clearing sticky GPU error: {}",
+         pre_err);
   }
 
   control_->exit_flag = 0;
@@ -281,21 +354,48 @@ void gpu::WorkOrchestrator::Resume(const IpcManagerGpuInfo &gpu_info) {
 
   auto *d_pm = static_cast<gpu::PoolManager *>(d_pool_mgr_);
 
-  // Resume with 1 block, 1 thread (CDP model)
-  chimaera_gpu_orchestrator<<<1, 1, 0,
-      static_cast<cudaStream_t>(stream_)>>>(
+  // Resume with the same single-block shape as Launch
+  chimaera_gpu_orchestrator<<<1, kOrchestratorThreads, 0,
+      static_cast<hshm::GpuStream>(stream_)>>>(
       d_pm, control_, resume_info, 1);
 
-  cudaError_t launch_err = cudaGetLastError();
-  if (launch_err != cudaSuccess) {
+  const char *launch_err = hshm::GpuApi::PopLastError();
+  if (launch_err) {
     HLOG(kError, "GPU work orchestrator Resume: kernel launch failed: {}",
-         cudaGetErrorString(launch_err));
+         launch_err);
     is_launched_ = false;
     return;
   }
 
+  run_start_ = std::chrono::steady_clock::now();
   is_launched_ = true;
-  HLOG(kInfo, "GPU work orchestrator resumed (1 block, 1 thread CDP model)");
+  HLOG(kInfo, "GPU work orchestrator resumed (1 block, {} thread(s))",
+       kOrchestratorThreads);
+}
+
+/** Tune elastic polling on a running (or paused) orchestrator. */
+void gpu::WorkOrchestrator::SetElasticity(u32 max_pop_burst,
+                                          u32 idle_sleep_max_ns) {
+  if (!control_) {
+    return;
+  }
+  control_->max_pop_burst =
+      max_pop_burst ? max_pop_burst
+                    : gpu::WorkOrchestratorControl::kDefaultPopBurst;
+  control_->idle_sleep_max_ns = idle_sleep_max_ns;
+  HLOG(kInfo, "GPU work orchestrator elasticity: pop burst {}, idle sleep <= {} ns",
+       control_->max_pop_burst, idle_sleep_max_ns);
+}
+
+/** Wall time the orchestrator kernel has run. */
+u64 gpu::WorkOrchestrator::GetRunNs() const {
+  if (!is_launched_) {
+    return run_ns_;
+  }
+  auto now = std::chrono::steady_clock::now();
+  return run_ns_ + static_cast<u64>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now - run_start_)
+          .count());
 }
 
 /**
@@ -353,38 +453,33 @@ hipc::FullPtr<GpuTaskQueue> gpu::InitQueueOnDevice(char *device_data,
                                                   size_t capacity,
                                                   u32 num_lanes,
                                                   u32 queue_depth) {
-  size_t *d_out_off = nullptr;
-  cudaError_t err = cudaMalloc(&d_out_off, sizeof(size_t));
-  if (err != cudaSuccess) {
-    HLOG(kError, "InitQueueOnDevice: cudaMalloc for d_out_off failed: {}",
-         cudaGetErrorString(err));
+  size_t *d_out_off = hshm::GpuApi::Malloc<size_t>(sizeof(size_t));
+  if (!d_out_off) {
+    HLOG(kError, "InitQueueOnDevice: device allocation for d_out_off failed");
     return hipc::FullPtr<GpuTaskQueue>::GetNull();
   }
 
   // Use a dedicated stream to avoid blocking on persistent kernels
   // that may be running on other streams (e.g., client kernels).
-  // cudaDeviceSynchronize() and default-stream cudaMemcpy would deadlock
+  // A device-wide synchronize or default-stream memcpy would deadlock
   // if a persistent kernel is active on another stream.
-  cudaStream_t init_stream;
-  cudaStreamCreate(&init_stream);
-  gpu_init_queue_kernel<<<1, 1, 0, init_stream>>>(device_data, capacity,
-                                                    num_lanes, queue_depth,
-                                                    d_out_off);
-  err = cudaStreamSynchronize(init_stream);
-  if (err != cudaSuccess) {
-    HLOG(kError, "InitQueueOnDevice: kernel launch failed: {}",
-         cudaGetErrorString(err));
-    cudaStreamDestroy(init_stream);
-    cudaFree(d_out_off);
+  void *init_stream = hshm::GpuApi::CreateStream();
+  gpu_init_queue_kernel<<<1, 1, 0, static_cast<hshm::GpuStream>(init_stream)>>>(
+      device_data, capacity, num_lanes, queue_depth, d_out_off);
+  hshm::GpuApi::Synchronize(init_stream);
+  const char *err = hshm::GpuApi::PopLastError();
+  if (err) {
+    HLOG(kError, "InitQueueOnDevice: kernel launch failed: {}", err);
+    hshm::GpuApi::DestroyStream(init_stream);
+    hshm::GpuApi::Free(d_out_off);
     return hipc::FullPtr<GpuTaskQueue>::GetNull();
   }
 
   size_t off = static_cast<size_t>(-1);
-  cudaMemcpyAsync(&off, d_out_off, sizeof(size_t), cudaMemcpyDeviceToHost,
-                  init_stream);
-  cudaStreamSynchronize(init_stream);
-  cudaStreamDestroy(init_stream);
-  cudaFree(d_out_off);
+  hshm::GpuApi::MemcpyAsync(&off, d_out_off, sizeof(size_t), init_stream);
+  hshm::GpuApi::Synchronize(init_stream);
+  hshm::GpuApi::DestroyStream(init_stream);
+  hshm::GpuApi::Free(d_out_off);
 
   hipc::FullPtr<GpuTaskQueue> result;
   if (off == static_cast<size_t>(-1)) {
@@ -25,10 +25,13 @@ bool IpcCpu2CpuZmq::RuntimeRecv(IpcManager *ipc, u32 &tasks_received) {
     hshm::lbm::Transport *transport = ipc->GetClientTransport(mode);
     if (!transport) continue;
 
-    // Drain all pending messages from this transport
+    // Drain all pending messages from this transport; bulks are received
+    // straight into the runtime data segment
+    hshm::lbm::LbmContext ctx;
+    ctx.recv_alloc_ = ipc->GetRecvAllocator();
     while (true) {
       LoadTaskArchive archive;
-      auto recv_info = transport->Recv(archive);
+      auto recv_info = transport->Recv(archive, ctx);
       int rc = recv_info.rc;
       if (rc == EAGAIN) break;
       if (rc != 0) {
@@ -91,13 +94,7 @@ bool IpcCpu2CpuZmq::RuntimeRecv(IpcManager *ipc, u32 &tasks_received) {
       Future<Task> future(future_shm.shm_, task_ptr);
       LaneId lane_id =
           ipc->GetScheduler()->ClientMapTask(ipc, future);
-      auto *worker_queues = ipc->GetTaskQueue();
-      auto &lane_ref = worker_queues->GetLane(lane_id, 0);
-      bool was_empty = lane_ref.Empty();
-      lane_ref.Push(future);
-      if (was_empty) {
-        ipc->AwakenWorker(&lane_ref);
-      }
+      ipc->EnqueueWorkerTask(lane_id, future);
 
       did_work = true;
       tasks_received++;
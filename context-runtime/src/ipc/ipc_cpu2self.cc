@@ -62,11 +62,13 @@ Future<Task> IpcCpu2Self::ClientSend(IpcManager *ipc,
       u32 lane_id = ipc->scheduler_->ClientMapTask(ipc, future);
       if (!ipc->worker_queues_.IsNull()) {
         auto &dest_lane = ipc->worker_queues_->GetLane(lane_id, 0);
-        bool was_empty = dest_lane.Empty();
-        dest_lane.Push(future);
-        if (was_empty) {
-          ipc->AwakenWorker(&dest_lane);
+        // Subtasks for this worker's own lane run now instead of waiting
+        // for the next lane drain
+        if (&dest_lane == worker->GetLane() &&
+            worker->ExecInline(&dest_lane, future)) {
+          return future;
         }
+        ipc->EnqueueWorkerTask(lane_id, future);
       }
     }
   } else {
@@ -103,7 +105,13 @@ void IpcCpu2Self::RuntimeSend(const FullPtr<Task> &task_ptr,
   }
 
   RunContext *parent_task = run_ctx->future_.GetParentTask();
-  if (parent_task && parent_task->event_queue_) {
+  Worker *worker = CHI_CUR_WORKER;
+  if (parent_task && worker && worker->IsInlineParent(parent_task)) {
+    // Inline subtask finished before its sender reached co_await. The
+    // parent is running on this thread, so completing here is safe and
+    // lets co_await see a ready future.
+    run_ctx->future_.Complete();
+  } else if (parent_task && parent_task->event_queue_) {
     // Runtime subtask with parent: enqueue Future to parent worker's event
     // queue. FUTURE_COMPLETE is NOT set here — it will be set by
     // ProcessEventQueue on the parent's worker thread.
@@ -41,6 +41,7 @@
 #include <arpa/inet.h>
 #include <dirent.h>
 #include <endian.h>
+#include <ifaddrs.h>
 #include <netdb.h>
 #include <signal.h>
 #include <sys/epoll.h>
@@ -59,7 +60,9 @@
 #include <cstring>
 #include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <random>
 
 #include "chimaera/admin.h"
@@ -82,6 +85,230 @@ HSHM_DEFINE_GLOBAL_PTR_VAR_CC(chi::IpcManager, g_ipc_manager);
 
 namespace chi {
 
+namespace {
+
+/** Smallest staging size class (1 << kStagingMinShift bytes) */
+constexpr u32 kStagingMinShift = 8;
+/** Number of power-of-two size classes (256B .. 16KB) */
+constexpr u32 kStagingClasses = 7;
+/** Buffers retained per size class per thread */
+constexpr u32 kStagingDepth = 4;
+
+/**
+ * Bumped whenever the allocators backing cached buffers go away
+ * (finalize, reaping). Caches from an older epoch are dropped unfreed.
+ */
+std::atomic<u64> g_staging_epoch{0};
+
+/** Per-thread cache of released staging buffers */
+struct StagingCache {
+  FullPtr<char> bufs_[kStagingClasses][kStagingDepth];
+  u32 count_[kStagingClasses] = {};
+  u64 epoch_ = ~0ULL;
+  u32 pid_ = 0;
+
+  /** Free whatever is still cached if its allocators are still alive */
+  ~StagingCache() {
+    if (epoch_ != g_staging_epoch.load(std::memory_order_acquire)) {
+      return;
+    }
+    auto *ipc = CHI_IPC;
+    if (ipc == nullptr) {
+      return;
+    }
+    for (u32 c = 0; c < kStagingClasses; ++c) {
+      for (u32 i = 0; i < count_[c]; ++i) {
+        ipc->FreeBuffer(bufs_[c][i]);
+      }
+    }
+  }
+
+  /** Forget cached buffers left over from an older epoch */
+  void Sync() {
+    u64 epoch = g_staging_epoch.load(std::memory_order_acquire);
+    if (epoch_ != epoch) {
+      for (u32 c = 0; c < kStagingClasses; ++c) {
+        count_[c] = 0;
+      }
+      epoch_ = epoch;
+      pid_ = static_cast<u32>(getpid());
+    }
+  }
+};
+
+/** Get the calling thread's staging cache */
+StagingCache &GetStagingCache() {
+  static thread_local StagingCache cache;
+  cache.Sync();
+  return cache;
+}
+
+/**
+ * Map a size to its staging class
+ * @return Class index, or kStagingClasses if the size is too large
+ */
+u32 StagingClassOf(size_t size) {
+  u32 cls = 0;
+  while (cls < kStagingClasses &&
+         (static_cast<size_t>(1) << (kStagingMinShift + cls)) < size) {
+    ++cls;
+  }
+  return cls;
+}
+
+/** Smallest pinned size class (1 << kPinnedMinShift bytes) */
+constexpr u32 kPinnedMinShift = 16;
+/** Number of power-of-two pinned size classes (64KB .. 64MB) */
+constexpr u32 kPinnedClasses = 11;
+/** Bytes page-locked per slab; larger classes get one buffer per slab */
+constexpr size_t kPinnedSlabSize = 16ULL << 20;
+
+/** One page-locked region, carved into buffers of a single size class */
+struct PinnedSlab {
+  FullPtr<char> buf_;        /**< Region from AllocateBuffer */
+  size_t size_ = 0;          /**< Region bytes */
+  u32 cls_ = 0;              /**< Size class, kPinnedClasses if dedicated */
+  bool registered_ = false;  /**< Whether this pool page-locked it */
+};
+
+/**
+ * Process-wide pool of page-locked buffers. Slabs are registered with the
+ * GPU once and recycled, so H2D/D2H copies always DMA without paying for
+ * registration per transfer.
+ */
+struct PinnedPool {
+  std::mutex lock_;
+  std::map<const char *, PinnedSlab> slabs_;  /**< Keyed by region base */
+  std::vector<FullPtr<char>> free_[kPinnedClasses];
+  std::atomic<bool> active_{false};  /**< Set once any slab exists */
+  std::atomic<bool> pin_failed_{false};  /**< Page-locking is unavailable */
+  u64 epoch_ = 0;
+
+  /** Forget slabs whose allocators were torn down (lock_ held) */
+  void Sync() {
+    u64 epoch = g_staging_epoch.load(std::memory_order_acquire);
+    if (epoch_ != epoch) {
+      slabs_.clear();
+      for (u32 c = 0; c < kPinnedClasses; ++c) {
+        free_[c].clear();
+      }
+      epoch_ = epoch;
+    }
+  }
+
+  /**
+   * Find the slab holding ptr (lock_ held)
+   * @return Slab iterator, or slabs_.end()
+   */
+  std::map<const char *, PinnedSlab>::iterator Find(const char *ptr) {
+    auto it = slabs_.upper_bound(ptr);
+    if (it == slabs_.begin()) {
+      return slabs_.end();
+    }
+    --it;
+    return ptr < it->first + it->second.size_ ? it : slabs_.end();
+  }
+};
+
+/** Get the process's pinned pool */
+PinnedPool &GetPinnedPool() {
+  static PinnedPool pool;
+  return pool;
+}
+
+/**
+ * Map a size to its pinned class
+ * @return Class index, or kPinnedClasses if the size is too large
+ */
+u32 PinnedClassOf(size_t size) {
+  u32 cls = 0;
+  while (cls < kPinnedClasses &&
+         (static_cast<size_t>(1) << (kPinnedMinShift + cls)) < size) {
+    ++cls;
+  }
+  return cls;
+}
+
+/**
+ * Page-lock host memory for GPU DMA
+ * @param registered Output: whether the caller must unregister it
+ * @return true if the memory is page-locked (by this call or before)
+ */
+bool PinHostMemory(void *ptr, size_t size, bool &registered) {
+  registered = false;
+#if HSHM_ENABLE_CUDA
+  cudaError_t err = cudaHostRegister(ptr, size, cudaHostRegisterPortable);
+  if (err == cudaSuccess) {
+    registered = true;
+    return true;
+  }
+  cudaGetLastError();  // Clear the error state
+  return err == cudaErrorHostMemoryAlreadyRegistered;
+#elif HSHM_ENABLE_ROCM
+  hipError_t err = hipHostRegister(ptr, size, hipHostRegisterPortable);
+  if (err == hipSuccess) {
+    registered = true;
+    return true;
+  }
+  hipGetLastError();
+  return err == hipErrorHostMemoryAlreadyRegistered;
+#else
+  (void)ptr;
+  (void)size;
+  return false;
+#endif
+}
+
+/** Undo a PinHostMemory that registered the memory */
+void UnpinHostMemory(void *ptr) {
+#if HSHM_ENABLE_CUDA
+  cudaHostUnregister(ptr);
+#elif HSHM_ENABLE_ROCM
+  hipHostUnregister(ptr);
+#else
+  (void)ptr;
+#endif
+}
+
+/**
+ * Names this machine answers to: interface addresses plus the full and
+ * short hostname. Lets a node find itself in a large hostfile without
+ * trying to bind every entry.
+ */
+std::unordered_set<std::string> GetLocalAddresses() {
+  std::unordered_set<std::string> addrs = {"localhost", "127.0.0.1", "::1"};
+  struct ifaddrs *ifas = nullptr;
+  if (getifaddrs(&ifas) == 0) {
+    for (struct ifaddrs *ifa = ifas; ifa != nullptr; ifa = ifa->ifa_next) {
+      if (ifa->ifa_addr == nullptr) {
+        continue;
+      }
+      int family = ifa->ifa_addr->sa_family;
+      if (family != AF_INET && family != AF_INET6) {
+        continue;
+      }
+      socklen_t len = family == AF_INET ? sizeof(struct sockaddr_in)
+                                        : sizeof(struct sockaddr_in6);
+      char host[NI_MAXHOST];
+      if (getnameinfo(ifa->ifa_addr, len, host, sizeof(host), nullptr, 0,
+                      NI_NUMERICHOST) == 0) {
+        addrs.insert(host);
+      }
+    }
+    freeifaddrs(ifas);
+  }
+  char name[256];
+  if (gethostname(name, sizeof(name)) == 0) {
+    name[sizeof(name) - 1] = '\0';
+    std::string hostname(name);
+    addrs.insert(hostname);
+    addrs.insert(hostname.substr(0, hostname.find('.')));
+  }
+  return addrs;
+}
+
+}  // namespace
+
 // Host struct methods
 
 // IpcManager methods
@@ -220,6 +447,12 @@ bool IpcManager::ClientInit() {
       return false;
     }
 
+    // One allocation fast path per NUMA node (see ClientNumaNode)
+    auto *sys_info = HSHM_SYSTEM_INFO;
+    if (sys_info->numa_nodes_ > 1) {
+      numa_last_alloc_.assign(sys_info->numa_nodes_, nullptr);
+    }
+
     // Create per-process shared memory for client allocations
     auto *config = CHI_CONFIG_MANAGER;
     size_t initial_size =
@@ -354,6 +587,17 @@ bool IpcManager::ServerInit() {
 }
 
 void IpcManager::ClientFinalize() {
+  // Cached staging buffers die with the allocators below
+  g_staging_epoch.fetch_add(1, std::memory_order_acq_rel);
+
+  // Give the admission credit slot back to the runtime
+  if (client_credits_) {
+    client_credits_->Unclaim(credit_slot_);
+    client_credits_ = nullptr;
+    credit_slot_ = ClientCreditTable::kNumSlots;
+  }
+  lane_stats_ = nullptr;
+
   // Clean up thread-local task counter
   TaskCounter *counter =
       HSHM_THREAD_MODEL->GetTls<TaskCounter>(chi_task_counter_key_);
@@ -389,6 +633,13 @@ void IpcManager::ServerFinalize() {
   if (!is_initialized_) {
     return;
   }
+  g_staging_epoch.fetch_add(1, std::memory_order_acq_rel);
+
+  // The prefault thread touches the segments; stop it before they go away
+  prefault_stop_.store(true);
+  if (prefault_thread_.joinable()) {
+    prefault_thread_.join();
+  }
 
 #if HSHM_ENABLE_CUDA || HSHM_ENABLE_ROCM
   // Finalize GPU orchestrator before cleaning up GPU resources
@@ -400,6 +651,7 @@ void IpcManager::ServerFinalize() {
 
   // Cleanup servers
   local_transport_.reset();
+  shard_transports_.clear();
   main_transport_.reset();
 
   // Clean up lightbeam client transport objects
@@ -459,6 +711,84 @@ void IpcManager::AwakenWorker(TaskLane *lane) {
   }
 }
 
+void IpcManager::ResumeParkedTask(RunContext *run_ctx) {
+  if (!run_ctx || !run_ctx->event_queue_) {
+    return;
+  }
+  // A wake-up is a future with no task whose parent is the parked task;
+  // ProcessEventQueue resumes the parent and completing it is a no-op
+  auto *event_queue =
+      reinterpret_cast<hipc::mpsc_ring_buffer<Future<Task, CHI_QUEUE_ALLOC_T>,
+                                              hshm::ipc::MallocAllocator> *>(
+          run_ctx->event_queue_);
+  Future<Task, CHI_QUEUE_ALLOC_T> wake;
+  wake.SetParentTask(run_ctx);
+  bool was_empty = event_queue->Empty();
+  event_queue->Emplace(wake);
+  if (was_empty && run_ctx->lane_) {
+    AwakenWorker(run_ctx->lane_);
+  }
+}
+
+void IpcManager::EnqueueWorkerTask(u32 lane_id, const Future<Task> &future) {
+  Task *task = future.get();
+  TaskPrio prio = task ? task->GetPriority() : TaskPrio::kNormal;
+  auto &lane = worker_queues_->GetLane(lane_id, static_cast<u32>(prio));
+  bool was_empty = lane.Empty();
+  lane.Push(future);
+  if (was_empty) {
+    AwakenWorker(&lane);
+  }
+}
+
+bool IpcManager::HasSendCredit() const {
+  if (!client_credits_) {
+    return true;
+  }
+  const ClientCreditSlot &slot = client_credits_->GetSlot(credit_slot_);
+  return slot.inflight_.load(std::memory_order_relaxed) <
+         slot.window_.load(std::memory_order_acquire);
+}
+
+u32 IpcManager::AcquireSendCredit() {
+  if (!client_credits_) {
+    return ClientCreditTable::kNumSlots;
+  }
+  if (client_credits_->TryAcquire(credit_slot_)) {
+    return credit_slot_;
+  }
+  // At the window: wait for workers to drain. Give up after kCreditWaitSec
+  // so a credit lost to a runtime restart can never wedge the client.
+  hshm::Timepoint start;
+  start.Now();
+  while (!client_credits_->TryAcquire(credit_slot_)) {
+    hshm::Timepoint now;
+    now.Now();
+    if (start.GetSecFromStart(now) > kCreditWaitSec) {
+      HLOG(kWarning, "AcquireSendCredit: no credit after {}s, submitting "
+           "without one", kCreditWaitSec);
+      return ClientCreditTable::kNumSlots;
+    }
+    HSHM_THREAD_MODEL->Yield();
+  }
+  return credit_slot_;
+}
+
+void IpcManager::RefundSendCredit(u32 slot) {
+  if (client_credits_ && slot < ClientCreditTable::kNumSlots) {
+    client_credits_->Refund(slot);
+  }
+}
+
+void IpcManager::ReleaseSendCredit(FutureShm *future_shm, size_t lane_depth) {
+  if (!client_credits_ || !future_shm ||
+      !future_shm->flags_.Any(FutureShm::FUTURE_CREDIT_HELD)) {
+    return;
+  }
+  future_shm->flags_.UnsetBits(FutureShm::FUTURE_CREDIT_HELD);
+  client_credits_->Release(future_shm->credit_slot_, lane_depth);
+}
+
 bool IpcManager::ServerInitShm() {
   ConfigManager *config = CHI_CONFIG_MANAGER;
 
@@ -479,10 +809,20 @@ bool IpcManager::ServerInitShm() {
     // Initialize main backend with custom header size
     if (!main_backend_.shm_init(main_allocator_id_,
                                 hshm::Unit<size_t>::Bytes(main_segment_size),
-                                main_segment_name)) {
+                                main_segment_name,
+                                config->GetMemorySegmentHugePages(
+                                    kMainSegment))) {
       return false;
     }
 
+    // Spread the shared task segment over all sockets so no single node
+    // serves every worker's task memory
+    auto *sys_info = HSHM_SYSTEM_INFO;
+    if (sys_info->numa_nodes_ > 1 && !main_backend_.InterleaveNumaNodes()) {
+      HLOG(kWarning, "ServerInitShm: failed to interleave {} across {} nodes",
+           main_segment_name, sys_info->numa_nodes_);
+    }
+
     // Create main allocator (CHI_TASK_ALLOC_T = BuddyAllocator) for task data
     main_allocator_ = main_backend_.MakeAlloc<CHI_TASK_ALLOC_T>();
     if (!main_allocator_) {
@@ -498,7 +838,9 @@ bool IpcManager::ServerInitShm() {
          queue_segment_size, queue_segment_size / 1024);
     if (!queue_backend_.shm_init(queue_allocator_id_,
                                  hshm::Unit<size_t>::Bytes(queue_segment_size),
-                                 queue_segment_name)) {
+                                 queue_segment_name,
+                                 config->GetMemorySegmentHugePages(
+                                     kQueueSegment))) {
       return false;
     }
     queue_allocator_ = queue_backend_.MakeAlloc<CHI_QUEUE_ALLOC_T>();
@@ -506,12 +848,40 @@ bool IpcManager::ServerInitShm() {
       return false;
     }
 
+    // Page faults on a multi-GB segment otherwise land on the first tasks
+    if (config->GetPrefaultSegments()) {
+      prefault_stop_.store(false);
+      prefault_thread_ = std::thread([this]() { PrefaultSegments(); });
+    }
+
     return true;
   } catch (const std::exception &e) {
     return false;
   }
 }
 
+void IpcManager::PrefaultSegments() {
+  constexpr size_t kChunk = hshm::Unit<size_t>::Megabytes(64);
+  hshm::Timepoint start;
+  start.Now();
+  size_t total = 0;
+  for (hipc::PosixShmMmap *backend : {&queue_backend_, &main_backend_}) {
+    size_t size = backend->data_capacity_;
+    for (size_t off = 0; off < size; off += kChunk) {
+      if (prefault_stop_.load(std::memory_order_relaxed)) {
+        return;
+      }
+      size_t len = std::min(kChunk, size - off);
+      if (!backend->Prefault(off, len)) {
+        break;
+      }
+      total += len;
+    }
+  }
+  HLOG(kInfo, "Prefaulted {} MB of shared memory in {} ms",
+       total / (1024 * 1024), start.GetMsecFromStart());
+}
+
 bool IpcManager::ClientInitShm() {
   ConfigManager *config = CHI_CONFIG_MANAGER;
 
@@ -588,16 +958,39 @@ bool IpcManager::ServerInitQueues() {
     worker_queues_ = queue_allocator_->NewObj<TaskQueue>(
         queue_allocator_,
         total_workers,  // num_lanes equals total worker count
-        2,  // num_priorities (2 priorities: 0=normal, 1=resumed tasks)
+        2,  // num_priorities: one lane per TaskPrio (0=normal, 1=high)
         queue_depth);  // Use configured depth instead of hardcoded 1024
     worker_queues_off_ = worker_queues_.shm_.off_.load();
 
+    // Per-client admission credits; a lane over half full is congested
+    if (config->GetClientCredits() > 0) {
+      auto credits = queue_allocator_->NewObj<ClientCreditTable>();
+      if (!credits.IsNull()) {
+        credits->Init(config->GetClientCredits(), queue_depth / 2);
+        client_credits_ = credits.ptr_;
+        client_credits_off_ = credits.shm_.off_.load();
+      }
+    }
+
+    // Per-lane loads for the LocalScheduler's affinity remapping
+    auto lane_stats = queue_allocator_->NewObj<LaneStatsTable>();
+    if (!lane_stats.IsNull()) {
+      lane_stats->Init();
+      lane_stats_ = lane_stats.ptr_;
+      lane_stats_off_ = lane_stats.shm_.off_.load();
+    }
+
+    // Network shards: one per net worker, never all the workers
+    u32 max_net = (total_workers > 1) ? (total_workers - 1) : 1;
+    num_net_shards_ = std::max(1u, std::min(config->GetNetWorkers(), max_net));
+    net_lanes_.assign(num_net_shards_, nullptr);
+
     // Initialize network queue for send operations
-    // One lane with four priorities (SendIn, SendOut, ClientSendTcp,
-    // ClientSendIpc)
+    // One lane per shard with four priorities (SendIn, SendOut,
+    // ClientSendTcp, ClientSendIpc); client sends always use lane 0
     net_queue_ = queue_allocator_->NewObj<NetQueue>(
         queue_allocator_,
-        1,             // num_lanes: single lane for network operations
+        num_net_shards_,  // num_lanes: one lane per network shard
         4,             // num_priorities: 0=SendIn, 1=SendOut, 2=ClientSendTcp,
                        // 3=ClientSendIpc
         queue_depth);  // Use configured depth instead of hardcoded 1024
@@ -738,7 +1131,7 @@ bool IpcManager::InitGpuBackendsForDevice(int gpu_id, u32 queue_depth) {
     std::string url = "/chi_gpu2cpu_q_" + sid;
     auto backend = std::make_unique<hipc::GpuShmMmap>();
     if (!backend->shm_init(bid, hshm::Unit<size_t>::Megabytes(4), url,
-                           gpu_id)) {
+                           gpu_id, config->GetGpuHugePages())) {
       HLOG(kError, "Failed to init gpu2cpu queue backend for GPU {}", gpu_id);
       return false;
     }
@@ -759,7 +1152,7 @@ bool IpcManager::InitGpuBackendsForDevice(int gpu_id, u32 queue_depth) {
     std::string url = "/chi_cpu2gpu_q_" + sid;
     auto backend = std::make_unique<hipc::GpuShmMmap>();
     if (!backend->shm_init(bid, hshm::Unit<size_t>::Megabytes(4), url,
-                           gpu_id)) {
+                           gpu_id, config->GetGpuHugePages())) {
       HLOG(kError, "Failed to init cpu2gpu queue backend for GPU {}", gpu_id);
       return false;
     }
@@ -780,7 +1173,7 @@ bool IpcManager::InitGpuBackendsForDevice(int gpu_id, u32 queue_depth) {
     std::string url = "/chi_gpu2cpu_cp_" + sid;
     auto backend = std::make_unique<hipc::GpuShmMmap>();
     if (!backend->shm_init(bid, hshm::Unit<size_t>::Megabytes(32), url,
-                           gpu_id)) {
+                           gpu_id, config->GetGpuHugePages())) {
       HLOG(kError, "Failed to init gpu2cpu copy backend for GPU {}", gpu_id);
       return false;
     }
@@ -797,7 +1190,7 @@ bool IpcManager::InitGpuBackendsForDevice(int gpu_id, u32 queue_depth) {
     std::string url = "/chi_cpu2gpu_cp_" + sid;
     auto backend = std::make_unique<hipc::GpuShmMmap>();
     if (!backend->shm_init(bid, hshm::Unit<size_t>::Megabytes(32), url,
-                           gpu_id)) {
+                           gpu_id, config->GetGpuHugePages())) {
       HLOG(kError, "Failed to init cpu2gpu copy backend for GPU {}", gpu_id);
       return false;
     }
@@ -825,7 +1218,7 @@ bool IpcManager::InitGpuBackendsForDevice(int gpu_id, u32 queue_depth) {
     std::string url = "/chi_gpu_orch_" + sid;
     auto backend = std::make_unique<hipc::GpuShmMmap>();
     if (!backend->shm_init(bid, scratch_total, url,
-                           gpu_id)) {
+                           gpu_id, config->GetGpuHugePages())) {
       HLOG(kError, "Failed to init orchestrator backend for GPU {}", gpu_id);
       return false;
     }
@@ -887,6 +1280,14 @@ void gpu::IpcManager::InitCpu2GpuSendPools(u32 gpu_id,
   dev.cpu2gpu_fshm_pool_size = fshm_pool_size;
   dev.cpu2gpu_fshm_next = 0;
 
+  // Completion bitmap the orchestrator ORs finished tasks into. Without
+  // it tasks fall back to per-task completion flags.
+  dev.cpu2gpu_done = hshm::GpuApi::MallocHost<gpu::Cpu2GpuDoneMap>(
+      sizeof(gpu::Cpu2GpuDoneMap));
+  if (dev.cpu2gpu_done) {
+    memset(dev.cpu2gpu_done, 0, sizeof(gpu::Cpu2GpuDoneMap));
+  }
+
   HLOG(kInfo, "GPU {} CPU→GPU send pool initialized ({}MB pinned host)",
        gpu_id, fshm_pool_size / (1024*1024));
 }
@@ -929,6 +1330,8 @@ bool IpcManager::LaunchGpuOrchestrator() {
     delete orchestrator;
     return false;
   }
+  orchestrator->SetElasticity(config->GetGpuMaxPopBurst(),
+                              config->GetGpuIdleSleepMaxNs());
 
   gpu_ipc_->gpu_orchestrator_= orchestrator;
   return true;
@@ -994,7 +1397,34 @@ void gpu::IpcManager::PrintGpuOrchestratorProfile() {
   // Ensure GPU kernel has flushed profile data to pinned memory
   cudaDeviceSynchronize();
   auto *ctrl = orch->control_;
+  int num_sms = 0;
+  cudaDeviceGetAttribute(&num_sms, cudaDevAttrMultiProcessorCount, 0);
+  double run_ns = static_cast<double>(orch->GetRunNs());
   for (int w = 0; w < gpu::WorkOrchestratorControl::kMaxDebugWorkers; ++w) {
+    long long rounds = ctrl->prof_poll_rounds[w];
+    if (rounds > 0) {
+      // The poller is one thread in one resident block; while it sleeps that
+      // block issues nothing, so its SM share is scaled by the awake fraction.
+      long long idle = ctrl->prof_idle_rounds[w];
+      long long slept = ctrl->prof_sleep_ns[w];
+      long long blocks = ctrl->prof_blocks_launched[w];
+      long long tasks = ctrl->prof_task_count[w];
+      double awake = run_ns > 0 ? 1.0 - slept / run_ns : 1.0;
+      if (awake < 0) awake = 0;
+      printf("\n--- Orchestrator Worker %d Occupancy ---\n", w);
+      printf("  Poll rounds:             %lld  (%lld idle, %.1f%%)\n", rounds,
+             idle, 100.0 * idle / rounds);
+      printf("  Idle sleep:              %.3f ms of %.3f ms run (cap %u ns)\n",
+             slept / 1e6, run_ns / 1e6, ctrl->idle_sleep_max_ns);
+      printf("  Poller SM occupancy:     1 block on 1/%d SMs, awake %.1f%%"
+             " (%.3f SM-equivalents)\n",
+             num_sms, 100.0 * awake, awake);
+      printf("  RunTask blocks launched: %lld  (%.2f/task)\n", blocks,
+             tasks > 0 ? static_cast<double>(blocks) / tasks : 0.0);
+      printf("  Peak queue depth:        %u  (peak pop burst %u, cap %u)\n",
+             ctrl->prof_peak_depth[w], ctrl->prof_peak_burst[w],
+             ctrl->max_pop_burst);
+    }
     long long n = ctrl->prof_task_count[w];
     if (n == 0) continue;
     printf("\n--- Orchestrator Worker %d Profile (%lld tasks) ---\n", w, n);
@@ -1083,6 +1513,15 @@ void gpu::IpcManager::SetGpuOrchestratorBlocks(u32 blocks, u32 threads_per_block
   orchestrator->blocks_ = blocks;
   orchestrator->threads_per_block_ = threads_per_block;
 }
+
+void gpu::IpcManager::SetGpuOrchestratorElasticity(u32 max_pop_burst,
+                                                   u32 idle_sleep_max_ns) {
+  if (!gpu_orchestrator_) {
+    return;
+  }
+  auto *orchestrator = static_cast<gpu::WorkOrchestrator *>(gpu_orchestrator_);
+  orchestrator->SetElasticity(max_pop_burst, idle_sleep_max_ns);
+}
 void gpu::IpcManager::RebuildGpu2GpuQueue(u32 gpu_id, u32 new_lanes) {
   u32 queue_depth = gpu_orchestrator_info_.gpu_queue_depth;
 
@@ -1200,6 +1639,23 @@ bool IpcManager::ClientInitQueues() {
     worker_queues_.ptr_ = reinterpret_cast<TaskQueue *>(
         queue_allocator_->GetBackendData() + worker_queues_off_);
 
+    // Claim this process's admission credit slot
+    if (client_credits_off_ != 0) {
+      client_credits_ = reinterpret_cast<ClientCreditTable *>(
+          queue_allocator_->GetBackendData() + client_credits_off_);
+      credit_slot_ = client_credits_->Claim(static_cast<u32>(getpid()));
+      if (credit_slot_ >= ClientCreditTable::kNumSlots) {
+        HLOG(kWarning, "ClientInitQueues: credit table full, flow control "
+             "disabled for this client");
+        client_credits_ = nullptr;
+      }
+    }
+
+    if (lane_stats_off_ != 0) {
+      lane_stats_ = reinterpret_cast<LaneStatsTable *>(
+          queue_allocator_->GetBackendData() + lane_stats_off_);
+    }
+
     return !worker_queues_.IsNull();
   } catch (const std::exception &e) {
     return false;
@@ -1270,6 +1726,8 @@ bool IpcManager::WaitForLocalServer() {
   if (task->response_ == 0) {
     client_generation_ = task->server_generation_;
     worker_queues_off_ = task->worker_queues_off_;
+    client_credits_off_ = task->client_credits_off_;
+    lane_stats_off_ = task->lane_stats_off_;
     if (task->server_pid_ > 0) {
       runtime_pid_ = static_cast<pid_t>(task->server_pid_);
     }
@@ -1359,6 +1817,7 @@ bool IpcManager::LoadHostfile() {
   // Clear existing hostfile map
   hostfile_map_.clear();
   hosts_cache_valid_ = false;
+  host_table_version_ = 0;
 
   if (hostfile_path.empty()) {
     // No hostfile configured - assume localhost as node 0
@@ -1516,26 +1975,68 @@ u64 IpcManager::GetLeaderNodeId() const {
 
 bool IpcManager::IsLeader() const { return GetNodeId() == GetLeaderNodeId(); }
 
-u64 IpcManager::AddNode(const std::string &ip_address, u32 port) {
+u64 IpcManager::AssignNodeId(const std::string &ip_address) const {
+  const Host *host = GetHostByIp(ip_address);
+  if (host) {
+    return host->node_id;
+  }
+  u64 next_id = 0;
+  for (const auto &pair : hostfile_map_) {
+    next_id = std::max(next_id, pair.first + 1);
+  }
+  return next_id;
+}
+
+u64 IpcManager::AddNode(const std::string &ip_address, u32 port,
+                        u64 node_id, u64 table_version) {
   (void)port;  // Port stored elsewhere (ConfigManager) for now
 
-  // Check if node already exists
-  for (const auto &pair : hostfile_map_) {
-    if (pair.second.ip_address == ip_address) {
-      HLOG(kInfo, "AddNode: Node {} already registered as node_id={}",
-           ip_address, pair.first);
-      SetAlive(pair.first);
-      return pair.first;
+  // The delta only adds one host, so a node that missed earlier versions
+  // still applies it; the gap is reported so the missing hosts can be found
+  if (table_version != 0) {
+    if (table_version > host_table_version_ + 1) {
+      HLOG(kWarning,
+           "AddNode: host table jumped from version {} to {}; earlier "
+           "additions were not received",
+           host_table_version_, table_version);
     }
+    host_table_version_ = std::max(host_table_version_, table_version);
+  } else {
+    ++host_table_version_;
   }
 
-  // Assign next node ID (linear offset)
-  u64 new_node_id = static_cast<u64>(hostfile_map_.size());
+  // Check if node already exists
+  const Host *existing = GetHostByIp(ip_address);
+  if (existing) {
+    u64 existing_id = existing->node_id;
+    if (node_id != kUnassignedNodeId && node_id != existing_id) {
+      HLOG(kWarning,
+           "AddNode: {} is node_id={} here but node_id={} at the origin",
+           ip_address, existing_id, node_id);
+    }
+    HLOG(kInfo, "AddNode: Node {} already registered as node_id={}",
+         ip_address, existing_id);
+    SetAlive(existing_id);
+    return existing_id;
+  }
+
+  // Use the origin's ID so every node agrees; fall back to the next free
+  // linear offset when none was assigned or it is taken here
+  u64 new_node_id = node_id;
+  if (new_node_id == kUnassignedNodeId ||
+      hostfile_map_.find(new_node_id) != hostfile_map_.end()) {
+    if (new_node_id != kUnassignedNodeId) {
+      HLOG(kWarning, "AddNode: node_id={} for {} is already taken",
+           new_node_id, ip_address);
+    }
+    new_node_id = AssignNodeId(ip_address);
+  }
   Host host(ip_address, new_node_id);
   hostfile_map_[new_node_id] = host;
   hosts_cache_valid_ = false;
 
-  HLOG(kInfo, "AddNode: Registered {} as node_id={}", ip_address, new_node_id);
+  HLOG(kInfo, "AddNode: Registered {} as node_id={} (table version {})",
+       ip_address, new_node_id, host_table_version_);
   return new_node_id;
 }
 
@@ -1565,6 +2066,30 @@ bool IpcManager::IdentifyThisHost() {
   // Collect list of attempted hosts for error reporting
   std::vector<std::string> attempted_hosts;
 
+  // Entries naming a local address or hostname are tried first. Each bind
+  // attempt resolves the name and opens sockets, so binding every entry of
+  // a thousand-node hostfile dominates startup. The full scan remains as a
+  // fallback for aliases not visible locally.
+  std::unordered_set<std::string> local_addrs = GetLocalAddresses();
+  for (const auto &pair : hostfile_map_) {
+    const Host &host = pair.second;
+    if (local_addrs.count(host.ip_address) == 0) {
+      continue;
+    }
+    try {
+      if (TryStartMainServer(host.ip_address)) {
+        HLOG(kInfo, "SUCCESS: Main server started on {} (node={})",
+             host.ip_address, host.node_id);
+        this_host_ = host;
+        return true;
+      }
+    } catch (const std::exception &e) {
+      HLOG(kDebug, "Failed to bind to {}: {}", host.ip_address, e.what());
+    } catch (...) {
+      HLOG(kDebug, "Failed to bind to {}: Unknown error", host.ip_address);
+    }
+  }
+
   // Try to start TCP server on each host IP
   for (const auto &pair : hostfile_map_) {
     const Host &host = pair.second;
@@ -1621,14 +2146,12 @@ bool IpcManager::TryStartMainServer(const std::string &hostname) {
 
   try {
     // Create main server using Lightbeam TransportFactory
-    std::string protocol = "tcp";
     u32 port = config->GetPort();
 
     HLOG(kDebug, "Attempting to start main server on {}:{}", hostname, port);
 
-    main_transport_ = hshm::lbm::TransportFactory::Get(
-        hostname, hshm::lbm::TransportType::kZeroMq,
-        hshm::lbm::TransportMode::kServer, protocol, port);
+    main_transport_ = CreateNetTransport(
+        hostname, hshm::lbm::TransportMode::kServer, port);
 
     if (!main_transport_) {
       HLOG(kDebug,
@@ -1640,6 +2163,29 @@ bool IpcManager::TryStartMainServer(const std::string &hostname) {
 
     HLOG(kDebug, "Main server successfully bound to {}:{}", hostname, port);
 
+    // Each additional network shard listens on its own port
+    shard_transports_.clear();
+    for (u32 shard = 1; shard < num_net_shards_; ++shard) {
+      u32 shard_port = GetNetShardPort(shard);
+      hshm::lbm::TransportPtr server = CreateNetTransport(
+          hostname, hshm::lbm::TransportMode::kServer, shard_port);
+      if (!server) {
+        HLOG(kDebug, "Failed to create shard {} server on {}:{}", shard,
+             hostname, shard_port);
+        shard_transports_.clear();
+        main_transport_.reset();
+        return false;
+      }
+      shard_transports_.push_back(std::move(server));
+    }
+
+    // Register the segments attached so far for RDMA transports
+    if (main_transport_->type_ == hshm::lbm::TransportType::kLibfabric) {
+      allocator_map_lock_.WriteLock();
+      RebuildShmRangeIndex();
+      allocator_map_lock_.WriteUnlock();
+    }
+
     return true;
 
   } catch (const std::exception &e) {
@@ -1653,8 +2199,21 @@ bool IpcManager::TryStartMainServer(const std::string &hostname) {
   }
 }
 
-hshm::lbm::Transport *IpcManager::GetMainTransport() const {
-  return main_transport_.get();
+hshm::lbm::Transport *IpcManager::GetMainTransport(u32 shard) const {
+  if (shard == 0) {
+    return main_transport_.get();
+  }
+  if (shard - 1 < shard_transports_.size()) {
+    return shard_transports_[shard - 1].get();
+  }
+  return nullptr;
+}
+
+u32 IpcManager::GetNetShardPort(u32 shard) const {
+  ConfigManager *config = CHI_CONFIG_MANAGER;
+  u32 port = config->GetPort();
+  // port+1 is the local server and port+3 the client TCP server
+  return shard == 0 ? port : port + 3 + shard;
 }
 
 hshm::lbm::Transport *IpcManager::GetClientTransport(IpcMode mode) const {
@@ -1691,27 +2250,26 @@ FullPtr<char> IpcManager::AllocateBuffer(size_t size) {
     return buffer;
   }
 
-  // CLIENT SHM PATH: Use per-process shared memory allocation strategy
-  // 1. Check last accessed allocator first (fast path)
-  if (last_alloc_ != nullptr) {
-    FullPtr<char> buffer = last_alloc_->AllocateObjs<char>(size);
+  // CLIENT SHM PATH: Use per-process shared memory allocation strategy.
+  // On multi-socket hosts segments are bound to the NUMA node of the thread
+  // that created them, and each node has its own fast-path allocator.
+  int node = ClientNumaNode();
+  hipc::MultiProcessAllocator *&local_alloc =
+      node < 0 ? last_alloc_ : numa_last_alloc_[node];
+
+  // 1. Check last accessed allocator of this node first (fast path)
+  hipc::MultiProcessAllocator *fast_alloc = local_alloc;
+  if (fast_alloc != nullptr) {
+    FullPtr<char> buffer = fast_alloc->AllocateObjs<char>(size);
     if (!buffer.IsNull()) {
       return buffer;
     }
   }
 
-  // 2. Check all allocators in alloc_vector_
-  {
-    std::lock_guard<std::mutex> lock(shm_mutex_);
-    for (auto *alloc : alloc_vector_) {
-      if (alloc != nullptr && alloc != last_alloc_) {
-        FullPtr<char> buffer = alloc->AllocateObjs<char>(size);
-        if (!buffer.IsNull()) {
-          last_alloc_ = alloc;  // Update last accessed
-          return buffer;
-        }
-      }
-    }
+  // 2. Check the other allocators of this node in alloc_vector_
+  FullPtr<char> buffer = AllocateFromClientShm(size, node);
+  if (!buffer.IsNull()) {
+    return buffer;
   }
 
   // 3. All existing allocators are full - create new shared memory segment
@@ -1719,14 +2277,22 @@ FullPtr<char> IpcManager::AllocateBuffer(size_t size) {
   size_t new_size = static_cast<size_t>((size + kShmMetadataOverhead) *
                                         kShmAllocationMultiplier);
   if (!IncreaseClientShm(new_size)) {
+    // A remote node's segment still beats failing the allocation
+    if (node >= 0) {
+      buffer = AllocateFromClientShm(size, -1);
+      if (!buffer.IsNull()) {
+        return buffer;
+      }
+    }
     HLOG(kError, "AllocateBuffer: Failed to increase memory for {} bytes",
          size);
     return FullPtr<char>::GetNull();
   }
 
-  // 4. Retry allocation from the newly created allocator (last_alloc_)
-  if (last_alloc_ != nullptr) {
-    FullPtr<char> buffer = last_alloc_->AllocateObjs<char>(size);
+  // 4. Retry allocation from the newly created allocator
+  fast_alloc = local_alloc;
+  if (fast_alloc != nullptr) {
+    buffer = fast_alloc->AllocateObjs<char>(size);
     if (!buffer.IsNull()) {
       return buffer;
     }
@@ -1743,12 +2309,50 @@ FullPtr<char> IpcManager::AllocateBuffer(size_t size) {
 #endif  // HSHM_IS_HOST
 }
 
+#if HSHM_IS_HOST
+int IpcManager::ClientNumaNode() const {
+  if (numa_last_alloc_.size() <= 1) {
+    return -1;
+  }
+  auto *sys_info = HSHM_SYSTEM_INFO;
+  int node = sys_info->GetCurrentNumaNode();
+  return node < static_cast<int>(numa_last_alloc_.size()) ? node : 0;
+}
+
+FullPtr<char> IpcManager::AllocateFromClientShm(size_t size, int node) {
+  std::lock_guard<std::mutex> lock(shm_mutex_);
+  hipc::MultiProcessAllocator *&local_alloc =
+      node < 0 ? last_alloc_ : numa_last_alloc_[node];
+  for (auto *alloc : alloc_vector_) {
+    if (alloc == nullptr || alloc == local_alloc ||
+        user_allocs_.count(alloc) != 0) {
+      continue;
+    }
+    if (node >= 0) {
+      auto it = alloc_numa_node_.find(alloc);
+      if (it == alloc_numa_node_.end() || it->second != node) {
+        continue;
+      }
+    }
+    FullPtr<char> buffer = alloc->AllocateObjs<char>(size);
+    if (!buffer.IsNull()) {
+      local_alloc = alloc;  // Update last accessed
+      return buffer;
+    }
+  }
+  return FullPtr<char>::GetNull();
+}
+#endif  // HSHM_IS_HOST
+
 void IpcManager::FreeBuffer(FullPtr<char> buffer_ptr) {
 #if HSHM_IS_HOST
   // HOST PATH: Check various allocators
   if (buffer_ptr.IsNull()) {
     return;
   }
+  if (FreePinnedBuffer(buffer_ptr)) {
+    return;
+  }
 
   // Check if allocator ID is null (private memory allocated with HSHM_MALLOC)
   if (buffer_ptr.shm_.alloc_id_ == hipc::AllocatorId::GetNull()) {
@@ -1794,10 +2398,141 @@ void IpcManager::FreeBuffer(FullPtr<char> buffer_ptr) {
 #endif  // HSHM_IS_HOST
 }
 
+FullPtr<char> IpcManager::AllocateBuffer(size_t size, bool pinned) {
+  // Page-locking only pays off with a GPU to DMA to
+  static const bool has_gpu = hshm::GpuApi::GetDeviceCount() > 0;
+  PinnedPool &pool = GetPinnedPool();
+  if (!pinned || !has_gpu ||
+      pool.pin_failed_.load(std::memory_order_relaxed)) {
+    return AllocateBuffer(size);
+  }
+  u32 cls = PinnedClassOf(size);
+  size_t chunk = cls < kPinnedClasses
+                     ? static_cast<size_t>(1) << (kPinnedMinShift + cls)
+                     : size;
+  if (cls < kPinnedClasses) {
+    std::lock_guard<std::mutex> guard(pool.lock_);
+    pool.Sync();
+    std::vector<FullPtr<char>> &free_list = pool.free_[cls];
+    if (!free_list.empty()) {
+      FullPtr<char> buffer = free_list.back();
+      free_list.pop_back();
+      return buffer;
+    }
+  }
+
+  // Carve a new slab. Registration happens outside the lock: it pins every
+  // page and can take milliseconds for a large slab
+  PinnedSlab slab;
+  slab.cls_ = cls;
+  slab.size_ = std::max(chunk, kPinnedSlabSize);
+  if (cls >= kPinnedClasses) {
+    slab.size_ = chunk;
+  }
+  slab.buf_ = AllocateBuffer(slab.size_);
+  if (slab.buf_.IsNull()) {
+    return slab.buf_;
+  }
+  if (!PinHostMemory(slab.buf_.ptr_, slab.size_, slab.registered_)) {
+    // Unpinned memory still works, the copies are just staged by the driver
+    HLOG(kWarning, "AllocateBuffer: could not page-lock {} bytes; pinned "
+         "requests fall back to pageable memory", slab.size_);
+    pool.pin_failed_.store(true, std::memory_order_relaxed);
+    FreeBuffer(slab.buf_);
+    return AllocateBuffer(size);
+  }
+  std::lock_guard<std::mutex> guard(pool.lock_);
+  pool.Sync();
+  pool.slabs_[slab.buf_.ptr_] = slab;
+  pool.active_.store(true, std::memory_order_release);
+  if (cls < kPinnedClasses) {
+    for (size_t off = chunk; off + chunk <= slab.size_; off += chunk) {
+      FullPtr<char> piece = slab.buf_;
+      piece.ptr_ += off;
+      piece.shm_.off_ += off;
+      pool.free_[cls].push_back(piece);
+    }
+  }
+  return slab.buf_;
+}
+
+bool IpcManager::FreePinnedBuffer(FullPtr<char> buffer_ptr) {
+  PinnedPool &pool = GetPinnedPool();
+  if (!pool.active_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  PinnedSlab dedicated;
+  {
+    std::lock_guard<std::mutex> guard(pool.lock_);
+    pool.Sync();
+    auto it = pool.Find(buffer_ptr.ptr_);
+    if (it == pool.slabs_.end()) {
+      return false;
+    }
+    if (it->second.cls_ < kPinnedClasses) {
+      pool.free_[it->second.cls_].push_back(buffer_ptr);
+      return true;
+    }
+    dedicated = it->second;
+    pool.slabs_.erase(it);
+  }
+  // Buffers above the largest class are not kept
+  if (dedicated.registered_) {
+    UnpinHostMemory(dedicated.buf_.ptr_);
+  }
+  FreeBuffer(dedicated.buf_);
+  return true;
+}
+
+FullPtr<char> IpcManager::AllocateStagingBuffer(size_t size,
+                                                size_t &capacity) {
+  u32 cls = StagingClassOf(size);
+  if (cls >= kStagingClasses) {
+    capacity = 0;
+    return AllocateBuffer(size);
+  }
+  capacity = static_cast<size_t>(1) << (kStagingMinShift + cls);
+  StagingCache &cache = GetStagingCache();
+  if (cache.count_[cls] > 0) {
+    return cache.bufs_[cls][--cache.count_[cls]];
+  }
+  FullPtr<char> buffer = AllocateBuffer(capacity);
+  if (buffer.IsNull()) {
+    capacity = 0;
+  }
+  return buffer;
+}
+
+void IpcManager::FreeStagingBuffer(FullPtr<char> buffer_ptr,
+                                   size_t capacity) {
+  if (buffer_ptr.IsNull()) {
+    return;
+  }
+  u32 cls = StagingClassOf(capacity);
+  if (capacity == 0 || cls >= kStagingClasses ||
+      capacity != (static_cast<size_t>(1) << (kStagingMinShift + cls))) {
+    FreeBuffer(buffer_ptr);
+    return;
+  }
+  // Only keep private memory or this process's own shm segments: buffers
+  // allocated by another process must go back to their own allocator
+  StagingCache &cache = GetStagingCache();
+  const hipc::AllocatorId &id = buffer_ptr.shm_.alloc_id_;
+  bool owned = id == hipc::AllocatorId::GetNull() || id.major_ == cache.pid_;
+  if (!owned || cache.count_[cls] >= kStagingDepth) {
+    FreeBuffer(buffer_ptr);
+    return;
+  }
+  cache.bufs_[cls][cache.count_[cls]++] = buffer_ptr;
+}
+
 hshm::lbm::Transport *IpcManager::GetOrCreateClient(const std::string &addr,
-                                                    int port) {
-  // Create key for the pool map
+                                                    int port, u32 stripe) {
+  // Create key for the pool map; each stripe is its own connection
   std::string key = addr + ":" + std::to_string(port);
+  if (stripe > 0) {
+    key += "#" + std::to_string(stripe);
+  }
 
   // Lock the pool for thread-safe access
   std::lock_guard<std::mutex> lock(client_pool_mutex_);
@@ -1811,9 +2546,13 @@ hshm::lbm::Transport *IpcManager::GetOrCreateClient(const std::string &addr,
 
   // Create new persistent client connection
   HLOG(kInfo, "[ClientPool] Creating new persistent connection to {}", key);
-  auto transport = hshm::lbm::TransportFactory::Get(
-      addr, hshm::lbm::TransportType::kZeroMq,
-      hshm::lbm::TransportMode::kClient, "tcp", port);
+  hshm::lbm::TransportPtr transport;
+  try {
+    transport =
+        CreateNetTransport(addr, hshm::lbm::TransportMode::kClient, port);
+  } catch (const std::exception &e) {
+    HLOG(kError, "[ClientPool] Transport to {} failed: {}", key, e.what());
+  }
 
   if (!transport) {
     HLOG(kError, "[ClientPool] Failed to create client for {}", key);
@@ -1828,6 +2567,44 @@ hshm::lbm::Transport *IpcManager::GetOrCreateClient(const std::string &addr,
   return raw_ptr;
 }
 
+hipc::FullPtr<char> ShmRecvAllocator::Allocate(size_t size) {
+  auto *ipc_manager = CHI_IPC;
+  return ipc_manager->AllocateBuffer(size);
+}
+
+void ShmRecvAllocator::Free(const hipc::FullPtr<char> &buf) {
+  auto *ipc_manager = CHI_IPC;
+  ipc_manager->FreeBuffer(buf);
+}
+
+hshm::lbm::TransportPtr IpcManager::CreateNetTransport(
+    const std::string &addr, hshm::lbm::TransportMode mode, u32 port) {
+  ConfigManager *config = CHI_CONFIG_MANAGER;
+  if (config->GetNetTransport() == "libfabric") {
+#if HSHM_ENABLE_LIBFABRIC
+    return hshm::lbm::TransportFactory::Get(
+        addr, hshm::lbm::TransportType::kLibfabric, mode,
+        config->GetFabricProvider(), port, config->GetFabricDomain());
+#else
+    HLOG(kWarning,
+         "networking.transport is libfabric but libfabric support was not "
+         "compiled in; using ZeroMQ");
+#endif
+  }
+  if (config->GetNetTransport() == "io_uring") {
+#if HSHM_ENABLE_IO_URING
+    return hshm::lbm::TransportFactory::Get(
+        addr, hshm::lbm::TransportType::kIoUring, mode, "tcp", port);
+#else
+    HLOG(kWarning,
+         "networking.transport is io_uring but io_uring support was not "
+         "compiled in; using ZeroMQ");
+#endif
+  }
+  return hshm::lbm::TransportFactory::Get(
+      addr, hshm::lbm::TransportType::kZeroMq, mode, "tcp", port);
+}
+
 void IpcManager::ClearClientPool() {
   std::lock_guard<std::mutex> lock(client_pool_mutex_);
   HLOG(kInfo, "[ClientPool] Clearing {} persistent connections",
@@ -1842,31 +2619,42 @@ void IpcManager::EnqueueNetTask(Future<Task> future,
     return;
   }
 
-  // Get lane 0 (single lane) with the specified priority
+  // Runtime-to-runtime sends go to the lane of the shard owning the task;
+  // a request is keyed by its own address, a response by the net_key it
+  // arrived with, so both sides of an exchange land on the same shard
+  u32 shard = 0;
+  if (priority == NetQueuePriority::kSendIn) {
+    shard = GetNetShard(size_t(future.GetTaskPtr().ptr_));
+  } else if (priority == NetQueuePriority::kSendOut) {
+    shard = GetNetShard(future.GetTaskPtr()->task_id_.net_key_);
+  }
+
   u32 priority_idx = static_cast<u32>(priority);
-  auto &lane = net_queue_->GetLane(0, priority_idx);
+  auto &lane = net_queue_->GetLane(shard, priority_idx);
   bool was_empty = lane.Empty();
   lane.Push(future);
 
-  // Signal the net worker if the lane was empty (same pattern as
+  // Signal the shard's net worker if the lane was empty (same pattern as
   // admin_runtime.cc:1086-1089)
-  if (was_empty && net_lane_) {
-    AwakenWorker(net_lane_);
+  TaskLane *net_lane = shard < net_lanes_.size() ? net_lanes_[shard] : nullptr;
+  if (was_empty && net_lane) {
+    AwakenWorker(net_lane);
   }
 
-  HLOG(kDebug, "EnqueueNetTask: priority={}, was_empty={}, net_lane={}",
-       priority_idx, was_empty, net_lane_ != nullptr);
+  HLOG(kDebug,
+       "EnqueueNetTask: shard={}, priority={}, was_empty={}, net_lane={}",
+       shard, priority_idx, was_empty, net_lane != nullptr);
 }
 
 bool IpcManager::TryPopNetTask(NetQueuePriority priority,
-                               Future<Task> &future) {
-  if (net_queue_.IsNull()) {
+                               Future<Task> &future, u32 shard) {
+  if (net_queue_.IsNull() || shard >= num_net_shards_) {
     return false;
   }
 
-  // Get lane 0 (single lane) with the specified priority
+  // Get the shard's lane with the specified priority
   u32 priority_idx = static_cast<u32>(priority);
-  auto &lane = net_queue_->GetLane(0, priority_idx);
+  auto &lane = net_queue_->GetLane(shard, priority_idx);
 
   if (lane.Pop(future)) {
     return true;
@@ -1882,6 +2670,11 @@ bool IpcManager::TryPopNetTask(NetQueuePriority priority,
 bool IpcManager::IncreaseClientShm(size_t size) {
   HLOG(kDebug, "IncreaseClientShm CALLED: size={}", size);
   std::lock_guard<std::mutex> lock(shm_mutex_);
+  return CreateClientShm(size, false) != nullptr;
+}
+
+hipc::MultiProcessAllocator *IpcManager::CreateClientShm(size_t size,
+                                                         bool user_region) {
   // Acquire writer lock on allocator_map_lock_ during memory increase
   // This ensures exclusive access to the allocator_map_ structures
   allocator_map_lock_.WriteLock();
@@ -1897,7 +2690,7 @@ bool IpcManager::IncreaseClientShm(size_t size) {
   size_t total_size = size + kShmMetadataOverhead;
 
   HLOG(kInfo,
-       "IpcManager::IncreaseClientShm: Creating {} with size {} ({} + {} "
+       "IpcManager::CreateClientShm: Creating {} with size {} ({} + {} "
        "overhead)",
        shm_name, total_size, size, kShmMetadataOverhead);
 
@@ -1908,15 +2701,31 @@ bool IpcManager::IncreaseClientShm(size_t size) {
     // Create allocator ID: major = pid, minor = index
     hipc::AllocatorId alloc_id(static_cast<u32>(pid), index);
 
+    // Client data segments may opt into huge pages via the config
+    auto *config = CHI_CONFIG_MANAGER;
+    hipc::HugePageMode huge = hipc::HugePageMode::kNone;
+    if (config && config->IsValid()) {
+      huge = config->GetMemorySegmentHugePages(kClientDataSegment);
+    }
+
     // Initialize shared memory using backend's shm_init method
     if (!backend->shm_init(alloc_id, hshm::Unit<size_t>::Bytes(total_size),
-                           shm_name)) {
-      HLOG(kError, "IpcManager::IncreaseClientShm: Failed to create shm for {}",
+                           shm_name, huge)) {
+      HLOG(kError, "IpcManager::CreateClientShm: Failed to create shm for {}",
            shm_name);
       shm_count_.fetch_sub(1, std::memory_order_relaxed);
       allocator_map_lock_
           .WriteUnlock();  // CRITICAL: Release lock before returning
-      return false;
+      return nullptr;
+    }
+
+    // Keep the segment on the creating thread's node (before MakeAlloc
+    // touches its first pages)
+    int node = ClientNumaNode();
+    if (node >= 0 && !backend->BindNumaNode(node)) {
+      HLOG(kWarning,
+           "IpcManager::CreateClientShm: Failed to bind {} to NUMA node {}",
+           shm_name, node);
     }
 
     // Create allocator using backend's MakeAlloc method
@@ -1925,12 +2734,12 @@ bool IpcManager::IncreaseClientShm(size_t size) {
 
     if (allocator == nullptr) {
       HLOG(kError,
-           "IpcManager::IncreaseClientShm: Failed to create allocator for {}",
+           "IpcManager::CreateClientShm: Failed to create allocator for {}",
            shm_name);
       shm_count_.fetch_sub(1, std::memory_order_relaxed);
       allocator_map_lock_
           .WriteUnlock();  // CRITICAL: Release lock before returning
-      return false;
+      return nullptr;
     }
 
     // Add to our tracking structures
@@ -1939,10 +2748,21 @@ bool IpcManager::IncreaseClientShm(size_t size) {
     alloc_map_[alloc_key] = allocator;
     alloc_vector_.push_back(allocator);
     client_backends_.push_back(std::move(backend));
-    last_alloc_ = allocator;
+    if (node >= 0) {
+      alloc_numa_node_[allocator] = node;
+    }
+    if (user_region) {
+      user_allocs_.insert(allocator);
+    } else {
+      last_alloc_ = allocator;
+      if (node >= 0) {
+        numa_last_alloc_[node] = allocator;
+      }
+    }
+    RebuildShmRangeIndex();
 
     HLOG(kInfo,
-         "IpcManager::IncreaseClientShm: Created allocator {} with ID ({}.{})",
+         "IpcManager::CreateClientShm: Created allocator {} with ID ({}.{})",
          shm_name, alloc_id.major_, alloc_id.minor_);
 
     // Release the lock before returning
@@ -1956,17 +2776,48 @@ bool IpcManager::IncreaseClientShm(size_t size) {
         alloc_id);
     IpcCpu2CpuZmq::ClientSend(this,reg_task, IpcMode::kTcp).Wait();
 
-    return true;
+    return allocator;
 
   } catch (const std::exception &e) {
     allocator_map_lock_.WriteUnlock();
-    HLOG(kError, "IpcManager::IncreaseClientShm: Exception creating {}: {}",
+    HLOG(kError, "IpcManager::CreateClientShm: Exception creating {}: {}",
          shm_name, e.what());
     shm_count_.fetch_sub(1, std::memory_order_relaxed);
-    return false;
+    return nullptr;
   }
 }
 
+FullPtr<char> IpcManager::AllocateUserShm(size_t size) {
+  auto *chimaera_manager = CHI_CHIMAERA_MANAGER;
+  if ((chimaera_manager && chimaera_manager->IsRuntime()) ||
+      ipc_mode_ != IpcMode::kShm) {
+    return AllocateBuffer(size);
+  }
+
+  std::lock_guard<std::mutex> lock(shm_mutex_);
+  for (auto *alloc : user_allocs_) {
+    FullPtr<char> buffer = alloc->AllocateObjs<char>(size);
+    if (!buffer.IsNull()) {
+      return buffer;
+    }
+  }
+  hipc::MultiProcessAllocator *alloc = CreateClientShm(size, true);
+  if (alloc == nullptr) {
+    HLOG(kError, "AllocateUserShm: Failed to create segment for {} bytes",
+         size);
+    return FullPtr<char>::GetNull();
+  }
+  FullPtr<char> buffer = alloc->AllocateObjs<char>(size);
+  if (buffer.IsNull()) {
+    HLOG(kError, "AllocateUserShm: Failed to allocate {} bytes", size);
+  }
+  return buffer;
+}
+
+void IpcManager::FreeUserShm(FullPtr<char> buffer_ptr) {
+  FreeBuffer(buffer_ptr);
+}
+
 bool IpcManager::RegisterMemory(const hipc::AllocatorId &alloc_id) {
   HLOG(kDebug, "RegisterMemory CALLED: alloc_id=({}.{})", alloc_id.major_,
        alloc_id.minor_);
@@ -2022,6 +2873,7 @@ bool IpcManager::RegisterMemory(const hipc::AllocatorId &alloc_id) {
     // Note: Don't add to alloc_vector_ since this is not our memory
     // (we don't allocate from it, just need to resolve ShmPtrs)
     client_backends_.push_back(std::move(backend));
+    RebuildShmRangeIndex();
 
     HLOG(kInfo, "IpcManager::RegisterMemory: Successfully registered {}",
          shm_name);
@@ -2062,6 +2914,52 @@ ClientShmInfo IpcManager::GetClientShmInfo(u32 index) const {
   return ClientShmInfo(shm_name, pid, index, size, alloc_id);
 }
 
+void IpcManager::RebuildShmRangeIndex(const std::vector<u64> &exclude_keys) {
+  if (!exclude_keys.empty()) {
+    shm_unmap_epoch_.fetch_add(1, std::memory_order_acq_rel);
+  }
+  std::vector<hipc::MultiProcessAllocator *> allocs;
+  allocs.reserve(alloc_map_.size());
+  for (const auto &pair : alloc_map_) {
+    if (std::find(exclude_keys.begin(), exclude_keys.end(), pair.first) ==
+        exclude_keys.end()) {
+      allocs.push_back(pair.second);
+    }
+  }
+  shm_range_index_.Rebuild(allocs);
+
+  // Keep RDMA registrations in step with the published segments
+  if (main_transport_) {
+    for (u64 key : exclude_keys) {
+      auto it = alloc_map_.find(key);
+      if (it != alloc_map_.end()) {
+        main_transport_->DeregisterMemory(it->second->GetBackendData());
+      }
+    }
+    for (hipc::MultiProcessAllocator *alloc : allocs) {
+      size_t capacity = alloc->GetBackendDataCapacity();
+      if (capacity != SIZE_MAX) {
+        main_transport_->RegisterMemory(alloc->GetBackendData(), capacity);
+      }
+    }
+  }
+}
+
+bool IpcManager::FindShmSegment(const void *ptr, char **base, size_t *size) {
+  hipc::MultiProcessAllocator *alloc = nullptr;
+  if (main_allocator_ && main_allocator_->ContainsPtr(ptr)) {
+    alloc = main_allocator_;
+  } else {
+    alloc = shm_range_index_.Find(ptr);
+  }
+  if (alloc == nullptr || alloc->GetBackendDataCapacity() == SIZE_MAX) {
+    return false;
+  }
+  *base = alloc->GetBackendData();
+  *size = alloc->GetBackendDataCapacity();
+  return true;
+}
+
 size_t IpcManager::WreapDeadIpcs() {
   HLOG(kDebug, "WreapDeadIpcs CALLED");
   std::lock_guard<std::mutex> lock(shm_mutex_);
@@ -2104,6 +3002,11 @@ size_t IpcManager::WreapDeadIpcs() {
     }
   }
 
+  // Unpublish the dead segments before unmapping them
+  if (!keys_to_remove.empty()) {
+    RebuildShmRangeIndex(keys_to_remove);
+  }
+
   // Remove marked allocators and their backends
   for (u64 key : keys_to_remove) {
     // Find the allocator in the map
@@ -2135,6 +3038,8 @@ size_t IpcManager::WreapDeadIpcs() {
       }
     }
 
+    user_allocs_.erase(allocator);
+
     // Remove from alloc_vector_ if present
     auto vec_it =
         std::find(alloc_vector_.begin(), alloc_vector_.end(), allocator);
@@ -2146,6 +3051,9 @@ size_t IpcManager::WreapDeadIpcs() {
     if (last_alloc_ == allocator) {
       last_alloc_ = alloc_vector_.empty() ? nullptr : alloc_vector_.back();
     }
+    alloc_numa_node_.erase(allocator);
+    std::replace(numa_last_alloc_.begin(), numa_last_alloc_.end(), allocator,
+                 static_cast<hipc::MultiProcessAllocator *>(nullptr));
 
     // Remove from alloc_map_
     alloc_map_.erase(map_it);
@@ -2167,6 +3075,7 @@ size_t IpcManager::WreapDeadIpcs() {
 size_t IpcManager::WreapAllIpcs() {
   HLOG(kDebug, "WreapAllIpcs CALLED");
   std::lock_guard<std::mutex> lock(shm_mutex_);
+  g_staging_epoch.fetch_add(1, std::memory_order_acq_rel);
   // Acquire writer lock on allocator_map_lock_ during cleanup
   allocator_map_lock_.WriteLock();
 
@@ -2190,6 +3099,9 @@ size_t IpcManager::WreapAllIpcs() {
     keys_to_remove.push_back(alloc_key);
   }
 
+  // Unpublish the segments before unmapping them
+  RebuildShmRangeIndex(keys_to_remove);
+
   // Destroy all backends and remove from tracking structures
   for (u64 key : keys_to_remove) {
     auto map_it = alloc_map_.find(key);
@@ -2227,7 +3139,10 @@ size_t IpcManager::WreapAllIpcs() {
 
   // Clear remaining structures
   alloc_vector_.clear();
+  user_allocs_.clear();
   last_alloc_ = nullptr;
+  alloc_numa_node_.clear();
+  std::fill(numa_last_alloc_.begin(), numa_last_alloc_.end(), nullptr);
 
   // Note: client_backends_ may still have some entries if backends were
   // not found in the loop above (shouldn't happen in normal operation)
@@ -2339,6 +3254,9 @@ bool IpcManager::ReconnectToOriginalHost() {
     // Detach old shared memory (don't destroy — server owns it)
     main_allocator_ = nullptr;
     worker_queues_ = hipc::FullPtr<TaskQueue>();
+    client_credits_ = nullptr;
+    credit_slot_ = ClientCreditTable::kNumSlots;
+    lane_stats_ = nullptr;
     main_backend_ = hipc::PosixShmMmap();
 
     // Re-attach to new shared memory
@@ -2741,8 +3659,9 @@ bool IpcManager::IsTaskLocal(const FullPtr<Task> &task_ptr,
     return false;
   }
 
-  // If there's only one node, all tasks are local
-  if (GetNumHosts() == 1) {
+  // If there's only one node, all tasks are local, unless the query fans
+  // out over several containers of a sharded pool
+  if (GetNumHosts() == 1 && pool_queries.size() == 1) {
     return true;
   }
 
@@ -2801,7 +3720,18 @@ RouteResult IpcManager::RouteLocal(Future<Task> &future, bool force_enqueue) {
   // Resolve the actual execution container
   auto *pool_manager = CHI_POOL_MANAGER;
   bool is_plugged = false;
-  ContainerId container_id = task_ptr->pool_query_.GetContainerId();
+  const PoolQuery &query = task_ptr->pool_query_;
+  ContainerId container_id = query.GetContainerId();
+  // Hash and single-container range queries name a container too; on a
+  // node with several shards of the pool it picks the shard
+  if (query.IsDirectHashMode()) {
+    const PoolInfo *pool_info = pool_manager->GetPoolInfo(task_ptr->pool_id_);
+    if (pool_info != nullptr && pool_info->num_containers_ > 0) {
+      container_id = query.GetHash() % pool_info->num_containers_;
+    }
+  } else if (query.IsRangeMode() && query.GetRangeCount() == 1) {
+    container_id = query.GetRangeOffset();
+  }
   Container *exec_container =
       pool_manager->GetContainer(task_ptr->pool_id_, container_id, is_plugged);
 
@@ -2847,12 +3777,7 @@ RouteResult IpcManager::RouteLocal(Future<Task> &future, bool force_enqueue) {
   }
 
   // Enqueue to the destination worker's lane
-  auto &dest_lane = worker_queues_->GetLane(dest_worker_id, 0);
-  bool was_empty = dest_lane.Empty();
-  dest_lane.Push(future);
-  if (was_empty) {
-    AwakenWorker(&dest_lane);
-  }
+  EnqueueWorkerTask(dest_worker_id, future);
   return RouteResult::Local;
 }
 
@@ -0,0 +1,434 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#include "chimaera/metrics.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "chimaera/ipc_manager.h"
+#include "chimaera/work_orchestrator.h"
+#include "chimaera/worker.h"
+
+// Global pointer variable definition for the metrics registry singleton
+HSHM_DEFINE_GLOBAL_PTR_VAR_CC(chi::MetricsRegistry, g_metrics_registry);
+
+namespace chi {
+
+namespace {
+
+/** Poll timeout of the accept loop; bounds how long StopServer() waits */
+constexpr int kAcceptPollMs = 200;
+/** Largest request header accepted */
+constexpr size_t kMaxRequestBytes = 8192;
+
+/** Escape a label value (backslash, double quote, newline) */
+void AppendEscaped(std::string &out, const std::string &value) {
+  for (char c : value) {
+    if (c == '\\') {
+      out += "\\\\";
+    } else if (c == '"') {
+      out += "\\\"";
+    } else if (c == '\n') {
+      out += "\\n";
+    } else {
+      out += c;
+    }
+  }
+}
+
+/** Send the whole buffer, giving up on error */
+void SendAll(int fd, const char *data, size_t size) {
+  while (size > 0) {
+    ssize_t sent = send(fd, data, size, MSG_NOSIGNAL);
+    if (sent <= 0) return;
+    data += sent;
+    size -= static_cast<size_t>(sent);
+  }
+}
+
+/** Name of a network queue priority as a label value */
+const char *NetPriorityName(u32 prio) {
+  switch (static_cast<NetQueuePriority>(prio)) {
+    case NetQueuePriority::kSendIn:
+      return "send_in";
+    case NetQueuePriority::kSendOut:
+      return "send_out";
+    case NetQueuePriority::kClientSendTcp:
+      return "client_send_tcp";
+    case NetQueuePriority::kClientSendIpc:
+      return "client_send_ipc";
+    default:
+      return "unknown";
+  }
+}
+
+}  // namespace
+
+//===========================================================================
+// MetricsWriter
+//===========================================================================
+
+void MetricsWriter::Family(const std::string &name, MetricType type,
+                           const std::string &help) {
+  auto it = index_.find(name);
+  if (it != index_.end()) {
+    cur_ = it->second;
+    return;
+  }
+  cur_ = families_.size();
+  index_.emplace(name, cur_);
+  families_.push_back(FamilyBuf{name, type, help, std::string()});
+}
+
+void MetricsWriter::BeginSample(Labels labels) {
+  FamilyBuf &family = families_[cur_];
+  std::string &out = family.body_;
+  out += family.name_;
+  if (family.type_ == MetricType::kCounter) out += "_total";
+  if (labels.size() > 0) {
+    out += '{';
+    bool first = true;
+    for (const auto &label : labels) {
+      if (!first) out += ',';
+      first = false;
+      out += label.first;
+      out += "=\"";
+      AppendEscaped(out, label.second);
+      out += '"';
+    }
+    out += '}';
+  }
+  out += ' ';
+}
+
+void MetricsWriter::Sample(Labels labels, u64 value) {
+  if (families_.empty()) return;
+  BeginSample(labels);
+  std::string &out = families_[cur_].body_;
+  out += std::to_string(value);
+  out += '\n';
+}
+
+void MetricsWriter::Sample(Labels labels, double value) {
+  if (families_.empty()) return;
+  BeginSample(labels);
+  std::string &out = families_[cur_].body_;
+  if (std::isnan(value)) {
+    out += "NaN";
+  } else if (std::isinf(value)) {
+    out += value > 0 ? "+Inf" : "-Inf";
+  } else {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.9g", value);
+    out += buf;
+  }
+  out += '\n';
+}
+
+std::string MetricsWriter::Finish() const {
+  std::string out;
+  for (const auto &family : families_) {
+    if (family.body_.empty()) continue;
+    bool counter = family.type_ == MetricType::kCounter;
+    // Prometheus text names the counter family with its _total suffix;
+    // OpenMetrics names the family and suffixes only the samples
+    std::string name = family.name_;
+    if (counter && !openmetrics_) name += "_total";
+    out += "# HELP " + name + " " + family.help_ + "\n";
+    out += "# TYPE " + name + (counter ? " counter\n" : " gauge\n");
+    out += family.body_;
+  }
+  if (openmetrics_) out += "# EOF\n";
+  return out;
+}
+
+const char *MetricsWriter::ContentType() const {
+  return openmetrics_ ? "application/openmetrics-text; version=1.0.0; "
+                        "charset=utf-8"
+                      : "text/plain; version=0.0.4; charset=utf-8";
+}
+
+//===========================================================================
+// MetricsRegistry
+//===========================================================================
+
+MetricsRegistry::~MetricsRegistry() { StopServer(); }
+
+void MetricsRegistry::Register(const std::string &key, Collector collector) {
+  std::lock_guard<std::mutex> guard(lock_);
+  for (auto &entry : collectors_) {
+    if (entry.first == key) {
+      entry.second = std::move(collector);
+      return;
+    }
+  }
+  collectors_.emplace_back(key, std::move(collector));
+}
+
+void MetricsRegistry::Unregister(const std::string &key) {
+  std::lock_guard<std::mutex> guard(lock_);
+  for (auto it = collectors_.begin(); it != collectors_.end(); ++it) {
+    if (it->first == key) {
+      collectors_.erase(it);
+      return;
+    }
+  }
+}
+
+void MetricsRegistry::Collect(MetricsWriter &writer) {
+  // Collectors only read atomics, so holding the lock across them is short
+  // and guarantees Unregister() never races a running collector
+  std::lock_guard<std::mutex> guard(lock_);
+  for (auto &entry : collectors_) {
+    entry.second(writer);
+  }
+}
+
+std::string MetricsRegistry::Render(bool openmetrics) {
+  MetricsWriter writer(openmetrics);
+  Collect(writer);
+  return writer.Finish();
+}
+
+void MetricsRegistry::RegisterRuntimeCollector() {
+  Register("chimaera", [](MetricsWriter &w) {
+    auto *work_orchestrator = CHI_WORK_ORCHESTRATOR;
+    size_t num_workers = work_orchestrator->GetWorkerCount();
+    u64 now_us = static_cast<u64>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+    for (size_t i = 0; i < num_workers; ++i) {
+      Worker *worker = work_orchestrator->GetWorker(static_cast<u32>(i));
+      if (!worker) continue;
+      const WorkerCounters &c = worker->GetCounters();
+      std::string id = std::to_string(i);
+      u64 idle_us = c.idle_cpu_us_.load(std::memory_order_relaxed);
+      u64 sleep_us = c.sleep_us_.load(std::memory_order_relaxed);
+      u64 busy_us = c.BusyUs(now_us);
+      TaskLane *lane = worker->GetLane();
+
+      w.Family("chimaera_worker_tasks_processed", MetricType::kCounter,
+               "Tasks completed by the worker");
+      w.Sample({{"worker", id}},
+               c.tasks_processed_.load(std::memory_order_relaxed));
+      w.Family("chimaera_worker_busy_seconds", MetricType::kCounter,
+               "Time the worker spent outside idle polling and sleep");
+      w.Sample({{"worker", id}}, busy_us / 1e6);
+      w.Family("chimaera_worker_idle_poll_seconds", MetricType::kCounter,
+               "Idle time spent busy polling or spinning");
+      w.Sample({{"worker", id}}, idle_us / 1e6);
+      w.Family("chimaera_worker_sleep_seconds", MetricType::kCounter,
+               "Idle time spent blocked in epoll");
+      w.Sample({{"worker", id}}, sleep_us / 1e6);
+      w.Family("chimaera_worker_lane_depth", MetricType::kGauge,
+               "Tasks waiting in the worker's lane");
+      w.Sample({{"worker", id}}, static_cast<u64>(lane ? lane->Size() : 0));
+      w.Family("chimaera_worker_blocked_tasks", MetricType::kGauge,
+               "Tasks suspended in the worker's blocked queues");
+      w.Sample({{"worker", id}},
+               static_cast<u64>(
+                   c.blocked_tasks_.load(std::memory_order_relaxed)));
+      w.Family("chimaera_worker_periodic_tasks", MetricType::kGauge,
+               "Periodic tasks scheduled on the worker");
+      w.Sample({{"worker", id}},
+               static_cast<u64>(
+                   c.periodic_tasks_.load(std::memory_order_relaxed)));
+      w.Family("chimaera_worker_retry_tasks", MetricType::kGauge,
+               "Tasks waiting in the worker's retry queue");
+      w.Sample({{"worker", id}},
+               static_cast<u64>(
+                   c.retry_tasks_.load(std::memory_order_relaxed)));
+      w.Family("chimaera_worker_load_us", MetricType::kGauge,
+               "Predicted CPU time of the worker's active tasks");
+      w.Sample({{"worker", id}},
+               static_cast<double>(c.load_.load(std::memory_order_relaxed)));
+      w.Family("chimaera_worker_coroutine_resumes", MetricType::kCounter,
+               "Times the worker resumed a suspended task");
+      w.Sample({{"worker", id}}, c.resumes_.load(std::memory_order_relaxed));
+      w.Family("chimaera_worker_inline_tasks", MetricType::kCounter,
+               "Subtasks the worker ran inline in their sender");
+      w.Sample({{"worker", id}},
+               c.inline_tasks_.load(std::memory_order_relaxed));
+      w.Family("chimaera_worker_method_tasks", MetricType::kCounter,
+               "Tasks completed by the worker per method ID");
+      for (u32 m = 0; m < WorkerCounters::kNumMethodSlots; ++m) {
+        u64 n = c.method_tasks_[m].load(std::memory_order_relaxed);
+        if (n) w.Sample({{"method", std::to_string(m)}, {"worker", id}}, n);
+      }
+    }
+
+    NetQueue *net_queue = CHI_IPC->GetNetQueue();
+    if (net_queue) {
+      w.Family("chimaera_net_queue_depth", MetricType::kGauge,
+               "Futures waiting in a network queue lane");
+      for (size_t shard = 0; shard < net_queue->GetNumLanes(); ++shard) {
+        for (size_t prio = 0; prio < net_queue->GetNumPrios(); ++prio) {
+          w.Sample({{"priority", NetPriorityName(static_cast<u32>(prio))},
+                    {"shard", std::to_string(shard)}},
+                   static_cast<u64>(net_queue->GetLane(shard, prio).Size()));
+        }
+      }
+    }
+  });
+}
+
+bool MetricsRegistry::StartServer(const std::string &bind_addr, u32 port) {
+  if (port == 0 || server_.joinable()) {
+    return true;
+  }
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) {
+    HLOG(kError, "Metrics: socket() failed: {}", std::strerror(errno));
+    return false;
+  }
+  int one = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  sockaddr_in addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(static_cast<uint16_t>(port));
+  if (inet_pton(AF_INET, bind_addr.c_str(), &addr.sin_addr) != 1) {
+    HLOG(kError, "Metrics: invalid bind address '{}'", bind_addr);
+    close(fd);
+    return false;
+  }
+  if (bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 ||
+      listen(fd, 16) != 0) {
+    HLOG(kError, "Metrics: cannot listen on {}:{}: {}", bind_addr, port,
+         std::strerror(errno));
+    close(fd);
+    return false;
+  }
+  listen_fd_ = fd;
+  stop_.store(false);
+  server_ = std::thread([this]() { ServeLoop(); });
+  HLOG(kInfo, "Metrics: serving http://{}:{}/metrics", bind_addr, port);
+  return true;
+}
+
+void MetricsRegistry::StopServer() {
+  if (!server_.joinable()) {
+    return;
+  }
+  stop_.store(true);
+  server_.join();
+  close(listen_fd_);
+  listen_fd_ = -1;
+}
+
+void MetricsRegistry::ServeLoop() {
+  while (!stop_.load()) {
+    pollfd pfd;
+    pfd.fd = listen_fd_;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if (poll(&pfd, 1, kAcceptPollMs) <= 0) {
+      continue;
+    }
+    int client = accept(listen_fd_, nullptr, nullptr);
+    if (client < 0) {
+      continue;
+    }
+    HandleConnection(client);
+    close(client);
+  }
+}
+
+void MetricsRegistry::HandleConnection(int fd) {
+  // A stuck client may hold the single server thread for at most a second
+  timeval timeout;
+  timeout.tv_sec = 1;
+  timeout.tv_usec = 0;
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+  std::string request;
+  char buf[1024];
+  while (request.find("\r\n\r\n") == std::string::npos &&
+         request.size() < kMaxRequestBytes) {
+    ssize_t got = recv(fd, buf, sizeof(buf), 0);
+    if (got <= 0) break;
+    request.append(buf, static_cast<size_t>(got));
+  }
+
+  std::string status = "200 OK";
+  std::string content_type = "text/plain; charset=utf-8";
+  std::string body;
+  size_t line_end = request.find("\r\n");
+  std::string line = request.substr(0, line_end);
+  bool is_get = line.rfind("GET ", 0) == 0;
+  std::string path;
+  if (is_get) {
+    size_t path_end = line.find(' ', 4);
+    path = line.substr(4, path_end == std::string::npos ? std::string::npos
+                                                        : path_end - 4);
+    size_t query = path.find('?');
+    if (query != std::string::npos) path.resize(query);
+  }
+  if (!is_get) {
+    status = "405 Method Not Allowed";
+    body = "only GET is supported\n";
+  } else if (path != "/metrics") {
+    status = "404 Not Found";
+    body = "metrics are served at /metrics\n";
+  } else {
+    bool openmetrics =
+        request.find("application/openmetrics-text") != std::string::npos;
+    MetricsWriter writer(openmetrics);
+    Collect(writer);
+    body = writer.Finish();
+    content_type = writer.ContentType();
+  }
+
+  std::string header = "HTTP/1.1 " + status +
+                       "\r\nContent-Type: " + content_type +
+                       "\r\nContent-Length: " + std::to_string(body.size()) +
+                       "\r\nConnection: close\r\n\r\n";
+  SendAll(fd, header.data(), header.size());
+  SendAll(fd, body.data(), body.size());
+}
+
+}  // namespace chi
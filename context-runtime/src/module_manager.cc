@@ -68,11 +68,11 @@ bool ModuleManager::ServerInit() {
 
   HLOG(kDebug, "Initializing Module Manager...");
 
-  // Scan for and load ChiMods
+  // Scan for ChiMods; libraries are opened on first GetChiMod
   ScanForChiMods();
 
-  HLOG(kDebug, "Module Manager initialized with {} ChiMods loaded",
-       chimods_.size());
+  HLOG(kDebug, "Module Manager initialized with {} ChiMods found",
+       candidates_.size());
 
   is_initialized_ = true;
   return true;
@@ -86,12 +86,20 @@ void ModuleManager::Finalize() {
   HLOG(kDebug, "Finalizing Module Manager...");
 
   // Clear all loaded ChiMods - SharedLibrary destructor handles cleanup
+  std::lock_guard<std::mutex> guard(lock_);
   chimods_.clear();
+  candidates_.clear();
+  loaded_all_ = false;
 
   is_initialized_ = false;
 }
 
 bool ModuleManager::LoadChiMod(const std::string &lib_path) {
+  std::lock_guard<std::mutex> guard(lock_);
+  return LoadChiModLocked(lib_path);
+}
+
+bool ModuleManager::LoadChiModLocked(const std::string &lib_path) {
   auto chimod_info = std::make_unique<ChiModInfo>();
   chimod_info->lib_path = lib_path;
 
@@ -148,8 +156,44 @@ bool ModuleManager::LoadChiMod(const std::string &lib_path) {
 }
 
 ChiModInfo *ModuleManager::GetChiMod(const std::string &chimod_name) {
+  std::lock_guard<std::mutex> guard(lock_);
   auto it = chimods_.find(chimod_name);
-  return (it != chimods_.end()) ? it->second.get() : nullptr;
+  if (it != chimods_.end()) {
+    return it->second.get();
+  }
+  return LoadLazyChiMod(chimod_name);
+}
+
+ChiModInfo *ModuleManager::LoadLazyChiMod(const std::string &chimod_name) {
+  // Candidates are in scan-directory order, preserving first-wins
+  auto cand = candidates_.find(chimod_name);
+  if (cand != candidates_.end()) {
+    std::vector<std::string> paths = std::move(cand->second);
+    candidates_.erase(cand);
+    for (const std::string &path : paths) {
+      LoadChiModLocked(path);
+      auto it = chimods_.find(chimod_name);
+      if (it != chimods_.end()) {
+        return it->second.get();
+      }
+    }
+  }
+
+  // The file name did not predict the ChiMod name; open everything once
+  if (!loaded_all_) {
+    loaded_all_ = true;
+    for (const auto &pair : candidates_) {
+      for (const std::string &path : pair.second) {
+        LoadChiModLocked(path);
+      }
+    }
+    candidates_.clear();
+    auto it = chimods_.find(chimod_name);
+    if (it != chimods_.end()) {
+      return it->second.get();
+    }
+  }
+  return nullptr;
 }
 
 Container *ModuleManager::CreateContainer(const std::string &chimod_name,
@@ -172,6 +216,7 @@ void ModuleManager::DestroyContainer(const std::string &chimod_name,
 }
 
 std::vector<std::string> ModuleManager::GetLoadedChiMods() const {
+  std::lock_guard<std::mutex> guard(lock_);
   std::vector<std::string> names;
   for (const auto &pair : chimods_) {
     names.push_back(pair.first);
@@ -195,8 +240,8 @@ void ModuleManager::ScanForChiMods() {
           std::string file_path = entry.path().string();
           if (IsSharedLibrary(file_path) &&
               HasModuleNamingConvention(file_path)) {
-            HLOG(kDebug, "Attempting to load ChiMod from: {}", file_path);
-            LoadChiMod(file_path);
+            HLOG(kDebug, "Found ChiMod candidate: {}", file_path);
+            candidates_[ChiModNameFromPath(file_path)].push_back(file_path);
           }
         }
       }
@@ -303,6 +348,19 @@ bool ModuleManager::HasModuleNamingConvention(
   return file_path.find("_runtime.so") != std::string::npos;
 }
 
+std::string ModuleManager::ChiModNameFromPath(
+    const std::string &file_path) const {
+  std::string name = std::filesystem::path(file_path).filename().string();
+  if (name.compare(0, 3, "lib") == 0) {
+    name = name.substr(3);
+  }
+  size_t pos = name.find("_runtime.");
+  if (pos != std::string::npos) {
+    name = name.substr(0, pos);
+  }
+  return name;
+}
+
 bool ModuleManager::ValidateChiMod(hshm::SharedLibrary &lib) const {
   // Check for required ChiMod functions
   void *alloc_func = lib.GetSymbol("alloc_chimod");
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#include "chimaera/poll_controller.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace chi {
+
+PollController::PollController()
+    : mode_(PollMode::kSleep),
+      first_busy_wait_us_(0),
+      wake_target_us_(0),
+      max_spin_us_(0),
+      window_us_(0),
+      gap_avg_us_(0),
+      wake_avg_us_(kDefaultWakeUs),
+      wake_dev_us_(0),
+      period_sleep_us_(0),
+      slept_(false),
+      last_action_(PollAction::kBusy) {}
+
+void PollController::Configure(PollMode mode, u32 first_busy_wait_us,
+                               u32 wake_target_us, u32 max_spin_us) {
+  mode_ = mode;
+  first_busy_wait_us_ = first_busy_wait_us;
+  wake_target_us_ = wake_target_us;
+  max_spin_us_ = max_spin_us;
+  window_us_ = ComputeWindowUs();
+}
+
+PollMode PollController::ParseMode(const std::string &name) {
+  if (name == "busy") {
+    return PollMode::kBusy;
+  }
+  if (name == "adaptive") {
+    return PollMode::kAdaptive;
+  }
+  return PollMode::kSleep;
+}
+
+PollAction PollController::Decide(double elapsed_idle_us) {
+  if (mode_ == PollMode::kBusy) {
+    last_action_ = PollAction::kBusy;
+  } else if (elapsed_idle_us >= window_us_) {
+    last_action_ = PollAction::kSleep;
+  } else if (mode_ == PollMode::kSleep || elapsed_idle_us < window_us_ / 4) {
+    last_action_ = PollAction::kBusy;
+  } else {
+    last_action_ = PollAction::kSpin;
+  }
+  return last_action_;
+}
+
+void PollController::RecordSleep(int timeout_us, double actual_us,
+                                 bool timed_out) {
+  stats_.sleep_us_ += static_cast<u64>(actual_us);
+  period_sleep_us_ += actual_us;
+  slept_ = true;
+  // A timed-out wait should return right at its deadline; the overshoot is
+  // the kernel's wake-up latency for this worker
+  if (timed_out && timeout_us > 0) {
+    float overshoot = static_cast<float>(
+        std::max(0.0, actual_us - static_cast<double>(timeout_us)));
+    float dev = std::fabs(overshoot - wake_avg_us_);
+    wake_avg_us_ = (1.0f - kEmaWeight) * wake_avg_us_ + kEmaWeight * overshoot;
+    wake_dev_us_ = (1.0f - kEmaWeight) * wake_dev_us_ + kEmaWeight * dev;
+    window_us_ = ComputeWindowUs();
+  }
+}
+
+void PollController::RecordArrival(double idle_us) {
+  double polled_us = std::max(0.0, idle_us - period_sleep_us_);
+  stats_.idle_cpu_us_ += static_cast<u64>(polled_us);
+  if (slept_) {
+    ++stats_.sleep_wakeups_;
+  } else if (last_action_ == PollAction::kSpin) {
+    ++stats_.spin_wakeups_;
+  } else {
+    ++stats_.busy_wakeups_;
+  }
+  float gap = static_cast<float>(idle_us);
+  gap_avg_us_ = (gap_avg_us_ <= 0)
+                    ? gap
+                    : (1.0f - kEmaWeight) * gap_avg_us_ + kEmaWeight * gap;
+  period_sleep_us_ = 0;
+  slept_ = false;
+  last_action_ = PollAction::kBusy;
+  window_us_ = ComputeWindowUs();
+}
+
+void PollController::Spin() {
+  for (u32 i = 0; i < kSpinPauses; ++i) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+  }
+}
+
+PollStats PollController::GetStats() const {
+  PollStats stats = stats_;
+  stats.wake_latency_p99_us_ = wake_avg_us_ + 3.0f * wake_dev_us_;
+  stats.arrival_gap_us_ = gap_avg_us_;
+  stats.poll_window_us_ = window_us_;
+  return stats;
+}
+
+u32 PollController::ComputeWindowUs() const {
+  if (mode_ != PollMode::kAdaptive) {
+    return first_busy_wait_us_;
+  }
+  float gap = (gap_avg_us_ > 0) ? gap_avg_us_
+                                : static_cast<float>(first_busy_wait_us_);
+  // Mean + 3 deviations approximates the p99 of the overshoot distribution
+  float wake_p99 = wake_avg_us_ + 3.0f * wake_dev_us_;
+  float window;
+  if (wake_target_us_ == 0 || wake_p99 <= wake_target_us_) {
+    // Sleeping meets the target: poll only while an arrival is likely,
+    // and sleep at once when arrivals usually take longer than the window
+    float busy_wait = static_cast<float>(first_busy_wait_us_);
+    window = (gap <= busy_wait) ? gap : 0.0f;
+  } else {
+    // Sleeping would miss the target: spin through about two arrival gaps
+    window = std::max(2.0f * gap, static_cast<float>(wake_target_us_));
+  }
+  window = std::min(window, static_cast<float>(max_spin_us_));
+  return static_cast<u32>(window);
+}
+
+}  // namespace chi
@@ -43,10 +43,13 @@
 #include "chimaera/module_manager.h"
 #include "chimaera/task.h"
 
+#include <algorithm>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
 
+#include "hermes_shm/introspect/system_info.h"
+
 // Global pointer variable definition for Pool manager singleton
 HSHM_DEFINE_GLOBAL_PTR_VAR_CC(chi::PoolManager, g_pool_manager);
 
@@ -396,7 +399,17 @@ bool PoolManager::ValidatePoolParams(const std::string& chimod_name,
   return true;
 }
 
-void PoolManager::InitAddressMap(PoolId pool_id, u32 num_containers) {
+void PoolManager::DestroyShards(PoolId pool_id, const std::string& chimod_name,
+                                const std::vector<Container*>& shards) {
+  auto* module_manager = CHI_MODULE_MANAGER;
+  for (Container* shard : shards) {
+    UnregisterContainer(pool_id, shard->container_id_);
+    module_manager->DestroyContainer(chimod_name, shard);
+  }
+}
+
+void PoolManager::InitAddressMap(PoolId pool_id, u32 num_containers,
+                                 u32 num_nodes) {
   if (!is_initialized_) {
     return;
   }
@@ -412,11 +425,14 @@ void PoolManager::InitAddressMap(PoolId pool_id, u32 num_containers) {
   HLOG(kDebug, "=== Address Map for Pool {} ===", pool_id);
   HLOG(kDebug, "Creating address map with {} containers", num_containers);
 
-  // Initially ContainerId == NodeId (one container per node)
+  // Initially ContainerId == NodeId for the first container of each node;
+  // the extra shards of a sharded pool follow in rounds of num_nodes
+  num_nodes = std::max(num_nodes, 1u);
   for (u32 container_idx = 0; container_idx < num_containers; ++container_idx) {
-    info.address_map_[container_idx] = container_idx;
+    u32 node_idx = container_idx % num_nodes;
+    info.address_map_[container_idx] = node_idx;
     HLOG(kDebug, "  Container[{}] -> Node[{}] (pool: {})", container_idx,
-         container_idx, pool_id);
+         node_idx, pool_id);
   }
 
   HLOG(kDebug, "=== Address Map Complete ===");
@@ -448,14 +464,25 @@ TaskResume PoolManager::CreatePool(FullPtr<Task> task, RunContext* run_ctx) {
   const std::string pool_name = create_task->pool_name_.str();
   const std::string chimod_params = create_task->chimod_params_.str();
 
-  // Set num_containers equal to number of nodes in the cluster
+  // A composed pool may ask for several containers (shards) per node;
+  // otherwise there is one container per node
+  bool is_restart = false;
+  u32 shards_per_node = 1;
+  if (create_task->do_compose_) {
+    chi::PoolConfig pool_config =
+        chi::Task::Deserialize<chi::PoolConfig>(create_task->chimod_params_);
+    is_restart = pool_config.restart_;
+    shards_per_node = std::max(pool_config.containers_per_node_, 1u);
+  }
+
   auto* ipc_manager = CHI_IPC;
   std::vector<Host> all_hosts = ipc_manager->GetAllHosts();
-  const u32 num_containers = static_cast<u32>(all_hosts.size());
+  const u32 num_nodes = static_cast<u32>(all_hosts.size());
+  const u32 num_containers = num_nodes * shards_per_node;
 
   HLOG(kInfo,
-       "PoolManager: Creating pool '{}' with {} containers (one per node)",
-       pool_name, num_containers);
+       "PoolManager: Creating pool '{}' with {} containers ({} per node)",
+       pool_name, num_containers, shards_per_node);
 
   // Make was_created a local variable
   bool was_created;
@@ -508,7 +535,7 @@ TaskResume PoolManager::CreatePool(FullPtr<Task> task, RunContext* run_ctx) {
   UpdatePoolMetadata(target_pool_id, pool_info);
 
   // Initialize address map for the pool (ContainerId -> NodeId)
-  InitAddressMap(target_pool_id, num_containers);
+  InitAddressMap(target_pool_id, num_containers, num_nodes);
 
   // Create local pool with containers (merged from CreateLocalPool)
   // Get module manager to create containers
@@ -519,71 +546,75 @@ TaskResume PoolManager::CreatePool(FullPtr<Task> task, RunContext* run_ctx) {
     CHI_CO_RETURN;
   }
 
-  Container* container = nullptr;
+  std::vector<Container*> shards;
   auto* ipc_manager2 = CHI_IPC;
   u32 node_id = ipc_manager2->GetNodeId();
+  int num_numa_nodes = hshm::SystemInfo::GetNumaNodeCount();
   try {
-    // Create container
-    container =
-        module_manager->CreateContainer(chimod_name, target_pool_id, pool_name);
-    if (!container) {
-      HLOG(kError, "PoolManager: Failed to create container for ChiMod: {}",
-           chimod_name);
-      pool_metadata_.erase(target_pool_id);
-      CHI_CO_RETURN;
-    }
-
-    // node_id already obtained above try block
-    HLOG(kInfo,
-         "Creating container for pool {} on node {} with container_id={}",
-         target_pool_id, node_id, node_id);
-
-    // Check if this is a restart scenario (compose mode with restart flag)
-    bool is_restart = false;
-    if (create_task->do_compose_) {
-      chi::PoolConfig pool_config =
-          chi::Task::Deserialize<chi::PoolConfig>(create_task->chimod_params_);
-      is_restart = pool_config.restart_;
-    }
-
-    // Initialize container with pool ID, name, and container ID
-    if (is_restart) {
-      HLOG(kInfo, "PoolManager: Restart detected for pool {}, calling Restart()", pool_name);
-      container->Restart(target_pool_id, pool_name, node_id);
-    } else {
-      container->Init(target_pool_id, pool_name, node_id);
-    }
-
-    HLOG(kInfo,
-         "Container initialized with pool ID {}, name {}, and container ID {}",
-         target_pool_id, pool_name, container->container_id_);
-
-    // Register the container BEFORE running Create method
-    // This allows Create to spawn tasks that can find this container in the map
-    if (!RegisterContainer(target_pool_id, node_id, container, /*is_static=*/true)) {
-      HLOG(kError, "PoolManager: Failed to register container");
-      module_manager->DestroyContainer(chimod_name, container);
-      pool_metadata_.erase(target_pool_id);
-      CHI_CO_RETURN;
-    }
+    // Shard k of this node is container node_id + k * num_nodes, so shard 0
+    // keeps ContainerId == NodeId. Shards are homed on NUMA nodes in turn.
+    for (u32 shard = 0; shard < shards_per_node; ++shard) {
+      u32 container_id = node_id + shard * num_nodes;
+      Container* shard_container =
+          module_manager->CreateContainer(chimod_name, target_pool_id, pool_name);
+      if (!shard_container) {
+        HLOG(kError, "PoolManager: Failed to create container for ChiMod: {}",
+             chimod_name);
+        DestroyShards(target_pool_id, chimod_name, shards);
+        pool_metadata_.erase(target_pool_id);
+        CHI_CO_RETURN;
+      }
+      HLOG(kInfo,
+           "Creating container for pool {} on node {} with container_id={}",
+           target_pool_id, node_id, container_id);
+
+      // Initialize container with pool ID, name, and container ID
+      if (is_restart) {
+        HLOG(kInfo, "PoolManager: Restart detected for pool {}, calling Restart()", pool_name);
+        shard_container->Restart(target_pool_id, pool_name, container_id);
+      } else {
+        shard_container->Init(target_pool_id, pool_name, container_id);
+      }
+      if (shards_per_node > 1) {
+        shard_container->numa_node_ =
+            static_cast<int>(shard % static_cast<u32>(num_numa_nodes));
+      }
 
-    // Run create method on container as a coroutine
-    // The Create method returns a TaskResume that may yield (co_await) for
-    // nested pool creation (e.g., CTE Create calling bdev Create).
-    // By using co_await, we properly suspend and resume, allowing the worker
-    // to process nested tasks while we wait.
-    HLOG(kInfo, "CreatePool: Running Create method for pool {}", target_pool_id);
-    CHI_CO_AWAIT(container->Run(0, task, *run_ctx));  // Method::kCreate = 0
-    HLOG(kInfo, "CreatePool: Create method completed for pool {}", target_pool_id);
-
-    if (task->GetReturnCode() != 0) {
-      HLOG(kError, "PoolManager: Failed to create container for ChiMod: {}",
-           chimod_name);
-      // Unregister the container since Create failed
-      UnregisterContainer(target_pool_id, node_id);
-      module_manager->DestroyContainer(chimod_name, container);
-      pool_metadata_.erase(target_pool_id);
-      CHI_CO_RETURN;
+      HLOG(kInfo,
+           "Container initialized with pool ID {}, name {}, and container ID {}",
+           target_pool_id, pool_name, shard_container->container_id_);
+
+      // Register the container BEFORE running Create method
+      // This allows Create to spawn tasks that can find this container in the map
+      if (!RegisterContainer(target_pool_id, container_id, shard_container,
+                             /*is_static=*/shard == 0)) {
+        HLOG(kError, "PoolManager: Failed to register container");
+        module_manager->DestroyContainer(chimod_name, shard_container);
+        DestroyShards(target_pool_id, chimod_name, shards);
+        pool_metadata_.erase(target_pool_id);
+        CHI_CO_RETURN;
+      }
+      shards.push_back(shard_container);
+
+      // Run create method on container as a coroutine
+      // The Create method returns a TaskResume that may yield (co_await) for
+      // nested pool creation (e.g., CTE Create calling bdev Create).
+      // By using co_await, we properly suspend and resume, allowing the worker
+      // to process nested tasks while we wait.
+      HLOG(kInfo, "CreatePool: Running Create method for pool {} container {}",
+           target_pool_id, container_id);
+      CHI_CO_AWAIT(shard_container->Run(0, task, *run_ctx));  // Method::kCreate = 0
+      HLOG(kInfo, "CreatePool: Create method completed for pool {} container {}",
+           target_pool_id, container_id);
+
+      if (task->GetReturnCode() != 0) {
+        HLOG(kError, "PoolManager: Failed to create container for ChiMod: {}",
+             chimod_name);
+        // Unregister the containers since Create failed
+        DestroyShards(target_pool_id, chimod_name, shards);
+        pool_metadata_.erase(target_pool_id);
+        CHI_CO_RETURN;
+      }
     }
 
     // Create GPU container via the work orchestrator.
@@ -609,7 +640,7 @@ TaskResume PoolManager::CreatePool(FullPtr<Task> task, RunContext* run_ctx) {
         // Allow container to send GPU-init tasks now that the GPU container
         // is registered and the orchestrator is running.
         if (gpu_container_ptr) {
-          container->PostGpuContainerCreate();
+          shards[0]->PostGpuContainerCreate();
         }
       }
     }
@@ -617,11 +648,8 @@ TaskResume PoolManager::CreatePool(FullPtr<Task> task, RunContext* run_ctx) {
 
   } catch (const std::exception& e) {
     HLOG(kError, "PoolManager: Exception during pool creation: {}", e.what());
-    if (container) {
-      // Unregister if it was registered before the exception
-      UnregisterContainer(target_pool_id, node_id);
-      module_manager->DestroyContainer(chimod_name, container);
-    }
+    // Unregister whatever was registered before the exception
+    DestroyShards(target_pool_id, chimod_name, shards);
     pool_metadata_.erase(target_pool_id);
     CHI_CO_RETURN;
   }
@@ -34,6 +34,9 @@
 // Copyright 2024 IOWarp contributors
 #include "chimaera/scheduler/default_sched.h"
 
+#include <algorithm>
+
+#include "chimaera/admin/autogen/admin_methods.h"
 #include "chimaera/config_manager.h"
 #include "chimaera/container.h"
 #include "chimaera/ipc_manager.h"
@@ -43,6 +46,27 @@
 
 namespace chi {
 
+/**
+ * Compute the key that partitions metadata tasks across workers.
+ * Combines only the pool and the executing container: ChiMods such as CTE
+ * keep per-container metadata that assumes one metadata worker, so every
+ * task on one container (and one CTE NUMA shard) maps to the same worker
+ * and containers spread across workers.
+ * @param task_ptr Task being routed
+ * @param container Execution container (may be nullptr)
+ * @return Routing key
+ */
+static u32 MetadataRoutingKey(const Task *task_ptr,
+                              const Container *container) {
+  u32 key = task_ptr->pool_id_.major_;
+  auto combine = [&key](u32 value) {
+    key ^= value + 0x9e3779b9 + (key << 6) + (key >> 2);
+  };
+  combine(task_ptr->pool_id_.minor_);
+  combine(container != nullptr ? container->container_id_ : 0);
+  return key;
+}
+
 void DefaultScheduler::DivideWorkers(WorkOrchestrator *work_orch) {
   if (!work_orch) {
     return;
@@ -53,43 +77,65 @@ void DefaultScheduler::DivideWorkers(WorkOrchestrator *work_orch) {
   scheduler_worker_ = nullptr;
   io_workers_.clear();
   net_worker_ = nullptr;
+  net_workers_.clear();
   gpu_worker_ = nullptr;
 
   // Worker 0 is always the scheduler worker
   scheduler_worker_ = work_orch->GetWorker(0);
 
-  // Network worker is always the last worker
-  net_worker_ = work_orch->GetWorker(total_workers - 1);
+  // Network shards take the last workers, one each (shard 0 is worker N-1)
+  IpcManager *ipc = CHI_IPC;
+  u32 num_net = ipc ? ipc->GetNumNetShards() : 1;
+  num_net = std::max(1u, std::min(num_net, total_workers));
+  u32 first_net = (total_workers > num_net) ? total_workers - num_net : 0;
 
-  // GPU worker is worker N-2 if we have more than 2 workers
-  if (total_workers > 2) {
-    gpu_worker_ = work_orch->GetWorker(total_workers - 2);
+  // Metadata is partitioned over the first workers, never a network worker
+  metadata_workers_.clear();
+  ConfigManager *config = CHI_CONFIG_MANAGER;
+  u32 num_metadata = config ? config->GetMetadataWorkers() : 1;
+  u32 max_metadata = (first_net > 0) ? first_net : 1;
+  num_metadata = std::max(1u, std::min(num_metadata, max_metadata));
+  for (u32 i = 0; i < num_metadata; ++i) {
+    Worker *worker = work_orch->GetWorker(i);
+    if (worker) {
+      metadata_workers_.push_back(worker);
+    }
   }
 
-  // I/O workers are workers 1..N-2 (empty if N <= 2)
-  if (total_workers > 2) {
-    for (u32 i = 1; i < total_workers - 1; ++i) {
-      Worker *worker = work_orch->GetWorker(i);
-      if (worker) {
-        io_workers_.push_back(worker);
-      }
+  // Network workers are always the last workers
+  for (u32 shard = 0; shard < num_net; ++shard) {
+    net_workers_.push_back(work_orch->GetWorker(total_workers - 1 - shard));
+  }
+  net_worker_ = net_workers_[0];
+
+  // GPU worker is the one just below the network workers, if not worker 0
+  if (first_net > 1) {
+    gpu_worker_ = work_orch->GetWorker(first_net - 1);
+  }
+
+  // I/O workers are workers 1..N-K-1 (empty if no worker is left)
+  for (u32 i = 1; i < first_net; ++i) {
+    Worker *worker = work_orch->GetWorker(i);
+    if (worker) {
+      io_workers_.push_back(worker);
     }
   }
 
-  // Number of scheduling queues excludes the network worker
-  IpcManager *ipc = CHI_IPC;
+  // Number of scheduling queues excludes the network workers
   if (ipc) {
     ipc->SetNumSchedQueues(1);
-    if (net_worker_) {
-      ipc->SetNetLane(net_worker_->GetLane());
+    for (u32 shard = 0; shard < num_net; ++shard) {
+      if (net_workers_[shard]) {
+        ipc->SetNetLane(shard, net_workers_[shard]->GetLane());
+      }
     }
   }
 
   HLOG(kInfo,
-       "DefaultScheduler: 1 scheduler worker (0), {} I/O workers, "
-       "1 network worker ({}), gpu_worker={}",
-       io_workers_.size(), total_workers - 1,
-       gpu_worker_ ? (int)gpu_worker_->GetId() : -1);
+       "DefaultScheduler: 1 scheduler worker (0), {} metadata workers, "
+       "{} I/O workers, {} network workers ({}..{}), gpu_worker={}",
+       metadata_workers_.size(), io_workers_.size(), num_net, first_net,
+       total_workers - 1, gpu_worker_ ? (int)gpu_worker_->GetId() : -1);
 }
 
 u32 DefaultScheduler::ClientMapTask(IpcManager *ipc_manager,
@@ -104,7 +150,7 @@ u32 DefaultScheduler::ClientMapTask(IpcManager *ipc_manager,
   // Network tasks (Send/Recv from admin pool) → last lane
   if (task_ptr != nullptr && task_ptr->pool_id_ == chi::kAdminPoolId) {
     u32 method_id = task_ptr->method_;
-    if (method_id == 14 || method_id == 15 || method_id == 20 || method_id == 21) {
+    if (chimaera::admin::Method::GetMethodTraits(method_id).IsNetwork()) {
       return num_lanes - 1;
     }
   }
@@ -135,36 +181,59 @@ u32 DefaultScheduler::RuntimeMapTask(Worker *worker, const Future<Task> &task,
 
   // ---- Normal routing: determine selected worker ----
   Worker *selected = nullptr;
+  // A shard of a per-NUMA pool runs on workers of its own socket
+  int home_node = container != nullptr ? container->numa_node_ : -1;
 
-  // Periodic Send/Recv → network worker
+  // Periodic Send/Recv → network worker of the task's shard (its group id)
   if (task_ptr != nullptr && task_ptr->IsPeriodic()) {
     if (task_ptr->pool_id_ == chi::kAdminPoolId) {
       u32 method_id = task_ptr->method_;
-      if (method_id == 14 || method_id == 15 || method_id == 20 || method_id == 21) {
-        if (net_worker_ != nullptr) {
-          return net_worker_->GetId();
+      if (chimaera::admin::Method::GetMethodTraits(method_id).IsNetwork()) {
+        u32 shard = task_ptr->task_group_.IsNull()
+                        ? 0
+                        : static_cast<u32>(task_ptr->task_group_.id_);
+        Worker *net_worker = GetNetShardWorker(shard);
+        if (net_worker != nullptr) {
+          return net_worker->GetId();
         }
       }
     }
   }
 
-  // Route large I/O to dedicated I/O workers (round-robin)
+  // Route large or historically slow tasks to the I/O worker with the
+  // shortest expected wait, so slow reads don't queue behind fast metadata
   if (selected == nullptr && task_ptr != nullptr && !io_workers_.empty()) {
     size_t io_size = 0;
+    float cost_us = 0;
+    MethodRoute route = MethodRoute::kDefault;
     bool is_plugged = false;
     Container *container = CHI_POOL_MANAGER->GetContainer(
         task_ptr->pool_id_, task_ptr->pool_query_.GetContainerId(), is_plugged);
     if (container) {
+      // Declared traits fill in for methods with no observed I/O size yet
+      const MethodTraits &traits = container->GetMethodTraits(task_ptr->method_);
+      route = traits.route_;
       io_size = container->GetTaskStats(task_ptr->method_).io_size_;
+      if (io_size == 0) {
+        io_size = traits.io_size_hint_;
+      }
+      cost_us = container->GetMethodCost(task_ptr->method_);
     }
-    if (io_size >= kLargeIOThreshold) {
-      u32 idx = next_io_idx_.fetch_add(1, std::memory_order_relaxed) %
-                static_cast<u32>(io_workers_.size());
-      selected = io_workers_[idx];
+    bool is_heavy = io_size >= kLargeIOThreshold || cost_us >= kSlowTaskUs;
+    if (route == MethodRoute::kIo ||
+        (route != MethodRoute::kMetadata && is_heavy)) {
+      selected = PickLeastLoadedIoWorker(home_node);
     }
   }
 
-  // Small I/O / metadata → scheduler worker
+  // Small I/O / metadata → metadata worker owning the routing key
+  if (selected == nullptr && task_ptr != nullptr &&
+      metadata_workers_.size() > 1) {
+    u32 key = MetadataRoutingKey(task_ptr, container);
+    selected = PickMetadataWorker(key, home_node);
+  }
+
+  // Otherwise → scheduler worker
   if (selected == nullptr && scheduler_worker_ != nullptr) {
     selected = scheduler_worker_;
   }
@@ -190,6 +259,51 @@ u32 DefaultScheduler::RuntimeMapTask(Worker *worker, const Future<Task> &task,
   return 0;
 }
 
+Worker *DefaultScheduler::PickLeastLoadedIoWorker(int numa_node) {
+  u32 num_io = static_cast<u32>(io_workers_.size());
+  // Only the node's workers compete when it has any
+  if (numa_node >= 0 &&
+      std::none_of(io_workers_.begin(), io_workers_.end(),
+                   [numa_node](const Worker *w) {
+                     return w->GetNumaNode() == numa_node;
+                   })) {
+    numa_node = -1;
+  }
+  // Rotate the scan start so equally loaded workers share the traffic
+  u32 start = next_io_idx_.fetch_add(1, std::memory_order_relaxed) % num_io;
+  Worker *best = nullptr;
+  float best_wait = 0;
+  for (u32 i = 0; i < num_io; ++i) {
+    Worker *candidate = io_workers_[(start + i) % num_io];
+    if (numa_node >= 0 && candidate->GetNumaNode() != numa_node) {
+      continue;
+    }
+    float wait = candidate->GetExpectedWaitUs();
+    if (best == nullptr || wait < best_wait) {
+      best = candidate;
+      best_wait = wait;
+    }
+  }
+  return best;
+}
+
+Worker *DefaultScheduler::PickMetadataWorker(u32 key, int numa_node) {
+  if (numa_node >= 0) {
+    u32 num_local = static_cast<u32>(std::count_if(
+        metadata_workers_.begin(), metadata_workers_.end(),
+        [numa_node](const Worker *w) { return w->GetNumaNode() == numa_node; }));
+    if (num_local > 0) {
+      u32 pick = key % num_local;
+      for (Worker *w : metadata_workers_) {
+        if (w->GetNumaNode() == numa_node && pick-- == 0) {
+          return w;
+        }
+      }
+    }
+  }
+  return metadata_workers_[key % metadata_workers_.size()];
+}
+
 void DefaultScheduler::RebalanceWorker(Worker *worker) { (void)worker; }
 
 void DefaultScheduler::AdjustPolling(RunContext *run_ctx) {
@@ -36,6 +36,7 @@
 
 #include <functional>
 
+#include "chimaera/admin/autogen/admin_methods.h"
 #include "chimaera/config_manager.h"
 #include "chimaera/ipc_manager.h"
 #include "chimaera/work_orchestrator.h"
@@ -43,6 +44,19 @@
 
 namespace chi {
 
+namespace {
+
+/** Lane a client thread sticks to between remaps */
+struct LaneAffinity {
+  u32 lane_ = 0;
+  u32 num_lanes_ = 0;  /**< Lane count lane_ was chosen for (0 = unset) */
+  u32 since_check_ = 0;
+};
+
+thread_local LaneAffinity g_lane_affinity;
+
+}  // namespace
+
 void LocalScheduler::DivideWorkers(WorkOrchestrator *work_orch) {
   if (!work_orch) {
     return;
@@ -101,12 +115,12 @@ u32 LocalScheduler::ClientMapTask(IpcManager *ipc_manager,
   Task *task_ptr = task.get();
   if (task_ptr != nullptr && task_ptr->pool_id_ == chi::kAdminPoolId) {
     u32 method_id = task_ptr->method_;
-    if (method_id == 14 || method_id == 15 || method_id == 20 || method_id == 21) {
+    if (chimaera::admin::Method::GetMethodTraits(method_id).IsNetwork()) {
       return num_lanes - 1;
     }
   }
 
-  u32 lane = MapByPidTid(num_lanes);
+  u32 lane = MapByAffinity(ipc_manager, num_lanes);
   return lane;
 }
 
@@ -137,7 +151,7 @@ u32 LocalScheduler::RuntimeMapTask(Worker *worker, const Future<Task> &task,
   if (task_ptr != nullptr && task_ptr->IsPeriodic()) {
     if (task_ptr->pool_id_ == chi::kAdminPoolId) {
       u32 method_id = task_ptr->method_;
-      if (method_id == 14 || method_id == 15 || method_id == 20 || method_id == 21) {
+      if (chimaera::admin::Method::GetMethodTraits(method_id).IsNetwork()) {
         if (net_worker_ != nullptr) {
           return net_worker_->GetId();
         }
@@ -206,4 +220,31 @@ u32 LocalScheduler::MapByPidTid(u32 num_lanes) {
   return static_cast<u32>(combined_hash % num_lanes);
 }
 
+u32 LocalScheduler::MapByAffinity(IpcManager *ipc_manager, u32 num_lanes) {
+  LaneAffinity &affinity = g_lane_affinity;
+  if (affinity.num_lanes_ != num_lanes) {
+    affinity.lane_ = MapByPidTid(num_lanes);
+    affinity.num_lanes_ = num_lanes;
+    affinity.since_check_ = 0;
+  }
+
+  LaneStatsTable *lane_stats = ipc_manager->GetLaneStats();
+  if (lane_stats == nullptr ||
+      ++affinity.since_check_ < kAffinityCheckInterval) {
+    return affinity.lane_;
+  }
+  affinity.since_check_ = 0;
+
+  u32 next = lane_stats->PickLane(affinity.lane_, num_lanes);
+  if (next != affinity.lane_) {
+    HLOG(kDebug, "LocalScheduler: remapping client thread lane {} -> {}"
+         " (load {} us -> {} us)",
+         affinity.lane_, next, lane_stats->GetLoad(affinity.lane_),
+         lane_stats->GetLoad(next));
+    lane_stats->RecordRemap(affinity.lane_, next);
+    affinity.lane_ = next;
+  }
+  return affinity.lane_;
+}
+
 }  // namespace chi
@@ -36,6 +36,7 @@
 
 #include "chimaera/scheduler/default_sched.h"
 #include "chimaera/scheduler/local_sched.h"
+#include "chimaera/scheduler/work_stealing_sched.h"
 
 namespace chi {
 
@@ -46,6 +47,9 @@ std::unique_ptr<Scheduler> SchedulerFactory::Get(const std::string &sched_name)
   if (sched_name == "local") {
     return std::make_unique<LocalScheduler>();
   }
+  if (sched_name == "work_stealing") {
+    return std::make_unique<WorkStealingScheduler>();
+  }
 
   // If scheduler name not recognized, return default scheduler
   HLOG(kWarning, "Unknown scheduler name '{}', using default scheduler",
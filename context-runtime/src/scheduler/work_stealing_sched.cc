@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#include "chimaera/scheduler/work_stealing_sched.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "chimaera/admin/autogen/admin_methods.h"
+#include "chimaera/config_manager.h"
+#include "chimaera/container.h"
+#include "chimaera/ipc_manager.h"
+#include "chimaera/work_orchestrator.h"
+#include "chimaera/worker.h"
+
+namespace chi {
+
+/**
+ * Check whether a queued task may run on a worker other than its lane owner
+ * @param future Future popped from a lane
+ * @return true if the task can be moved
+ */
+static bool IsStealable(Future<Task> &future) {
+  auto future_shm = future.GetFutureShm();
+  if (future_shm.IsNull()) {
+    return false;
+  }
+
+  // Client tasks that are still serialized get routed, and have task-group
+  // affinity applied, by whichever worker deserializes them
+  if (future_shm->flags_.Any(FutureShm::FUTURE_COPY_FROM_CLIENT) &&
+      !future_shm->flags_.Any(FutureShm::FUTURE_WAS_COPIED)) {
+    return future_shm->origin_ == FutureShm::FUTURE_CLIENT_SHM ||
+           future_shm->origin_ == FutureShm::FUTURE_CLIENT_TCP ||
+           future_shm->origin_ == FutureShm::FUTURE_CLIENT_IPC;
+  }
+
+  // Runtime tasks were already routed to this lane; leave pinned ones alone
+  FullPtr<Task> task_ptr = future.GetTaskPtr();
+  if (task_ptr.IsNull()) {
+    return false;
+  }
+  return task_ptr->task_group_.IsNull() && !task_ptr->IsPeriodic() &&
+         !task_ptr->task_flags_.Any(TASK_STARTED);
+}
+
+void WorkStealingScheduler::DivideWorkers(WorkOrchestrator *work_orch) {
+  if (!work_orch) {
+    return;
+  }
+
+  u32 total_workers = work_orch->GetTotalWorkerCount();
+
+  sched_workers_.clear();
+  net_worker_ = nullptr;
+  gpu_worker_ = nullptr;
+
+  net_worker_ = work_orch->GetWorker(total_workers - 1);
+
+  if (total_workers > 2) {
+    gpu_worker_ = work_orch->GetWorker(total_workers - 2);
+  }
+
+  u32 num_sched_workers = (total_workers == 1) ? 1 : (total_workers - 1);
+  for (u32 i = 0; i < num_sched_workers; ++i) {
+    Worker *worker = work_orch->GetWorker(i);
+    if (worker) {
+      sched_workers_.push_back(worker);
+    }
+  }
+
+  // Unpinned workers move, so each one reports its node as it runs
+  worker_nodes_ = std::make_unique<std::atomic<int>[]>(total_workers);
+  for (u32 i = 0; i < total_workers; ++i) {
+    worker_nodes_[i].store(0, std::memory_order_relaxed);
+  }
+
+  IpcManager *ipc = CHI_IPC;
+  if (ipc) {
+    ipc->SetNumSchedQueues(num_sched_workers);
+    if (net_worker_) {
+      ipc->SetNetLane(net_worker_->GetLane());
+    }
+  }
+
+  HLOG(kInfo,
+       "WorkStealingScheduler: {} scheduler workers, 1 network worker "
+       "(worker {}), gpu_worker={}",
+       sched_workers_.size(), total_workers - 1,
+       gpu_worker_ ? (int)gpu_worker_->GetId() : -1);
+}
+
+u32 WorkStealingScheduler::ClientMapTask(IpcManager *ipc_manager,
+                                         const Future<Task> &task) {
+  u32 num_lanes = ipc_manager->GetNumSchedQueues();
+  if (num_lanes == 0) {
+    return 0;
+  }
+
+  Task *task_ptr = task.get();
+  if (task_ptr != nullptr && task_ptr->pool_id_ == chi::kAdminPoolId) {
+    u32 method_id = task_ptr->method_;
+    if (chimaera::admin::Method::GetMethodTraits(method_id).IsNetwork()) {
+      return num_lanes - 1;
+    }
+  }
+
+  return MapByPidTid(num_lanes);
+}
+
+u32 WorkStealingScheduler::RuntimeMapTask(Worker *worker,
+                                          const Future<Task> &task,
+                                          Container *container) {
+  Task *task_ptr = task.get();
+
+  // ---- Task group affinity: return early if group already pinned ----
+  Container *grp_container =
+      (container != nullptr && task_ptr != nullptr &&
+       !task_ptr->task_group_.IsNull())
+          ? container
+          : nullptr;
+  if (grp_container != nullptr) {
+    int64_t group_id = task_ptr->task_group_.id_;
+    ScopedCoRwReadLock read_lock(grp_container->task_group_lock_);
+    auto it = grp_container->task_group_map_.find(group_id);
+    if (it != grp_container->task_group_map_.end() && it->second != nullptr) {
+      return it->second->GetId();
+    }
+  }
+
+  // ---- Normal routing: determine selected worker ----
+  Worker *selected = nullptr;
+
+  // Periodic Send/Recv → network worker
+  if (task_ptr != nullptr && task_ptr->IsPeriodic()) {
+    if (task_ptr->pool_id_ == chi::kAdminPoolId) {
+      u32 method_id = task_ptr->method_;
+      if (chimaera::admin::Method::GetMethodTraits(method_id).IsNetwork()) {
+        if (net_worker_ != nullptr) {
+          return net_worker_->GetId();
+        }
+      }
+    }
+  }
+
+  // GPU and network worker tasks → delegate to a scheduler worker
+  bool is_special_worker = worker != nullptr &&
+                           (worker == gpu_worker_ || worker == net_worker_);
+  if (is_special_worker && !sched_workers_.empty()) {
+    u32 idx = next_sched_idx_.fetch_add(1, std::memory_order_relaxed) %
+              sched_workers_.size();
+    selected = sched_workers_[idx];
+  }
+
+  // Otherwise stay on the current worker; idle workers steal the surplus
+  if (selected == nullptr) {
+    selected = worker;
+  }
+
+  // ---- Update group map after routing decision ----
+  if (grp_container != nullptr && task_ptr != nullptr && selected != nullptr) {
+    int64_t group_id = task_ptr->task_group_.id_;
+    ScopedCoRwWriteLock write_lock(grp_container->task_group_lock_);
+    auto it = grp_container->task_group_map_.find(group_id);
+    if (it == grp_container->task_group_map_.end() || it->second == nullptr) {
+      grp_container->task_group_map_[group_id] = selected;
+    }
+  }
+
+  if (selected != nullptr) {
+    return selected->GetId();
+  }
+  return 0;
+}
+
+void WorkStealingScheduler::RebalanceWorker(Worker *worker) {
+  if (worker == nullptr || !worker_nodes_) {
+    return;
+  }
+  int thief_node = GetCurrentNumaNode(worker);
+  worker_nodes_[worker->GetId()].store(thief_node, std::memory_order_relaxed);
+
+  // Only idle scheduler workers steal; the GPU worker keeps polling its
+  // GPU lanes and the network worker only serves network tasks
+  TaskLane *thief_lane = worker->GetLane();
+  if (thief_lane == nullptr || !thief_lane->Empty() ||
+      worker == gpu_worker_ || worker == net_worker_) {
+    return;
+  }
+
+  // Find the thief's position so victims are scanned round-robin from it
+  size_t num_workers = sched_workers_.size();
+  size_t start = 0;
+  for (size_t i = 0; i < num_workers; ++i) {
+    if (sched_workers_[i] == worker) {
+      start = i;
+      break;
+    }
+  }
+
+  // First pass only considers victims on the thief's NUMA node
+  for (int pass = 0; pass < 2; ++pass) {
+    for (size_t off = 1; off < num_workers; ++off) {
+      Worker *victim = sched_workers_[(start + off) % num_workers];
+      TaskLane *victim_lane = victim->GetLane();
+      if (victim == worker || victim_lane == nullptr) {
+        continue;
+      }
+      int victim_node =
+          worker_nodes_[victim->GetId()].load(std::memory_order_relaxed);
+      if ((victim_node == thief_node) != (pass == 0)) {
+        continue;
+      }
+      size_t depth = victim_lane->Size();
+      if (depth < kMinVictimDepth) {
+        continue;
+      }
+      size_t count = std::min(depth / 2, kMaxStealBatch);
+      if (StealFrom(victim, worker, count) > 0) {
+        return;
+      }
+    }
+  }
+}
+
+size_t WorkStealingScheduler::StealFrom(Worker *victim, Worker *thief,
+                                        size_t count) {
+  TaskLane *victim_lane = victim->GetLane();
+  TaskLane *thief_lane = thief->GetLane();
+  size_t stolen = 0;
+  while (stolen < count) {
+    Future<Task> future;
+    if (!victim_lane->Pop(future)) {
+      break;
+    }
+    if (!IsStealable(future)) {
+      // Hand it back and leave the rest of this lane to its owner
+      victim_lane->Push(future);
+      break;
+    }
+    thief_lane->Push(future);
+    ++stolen;
+  }
+  return stolen;
+}
+
+void WorkStealingScheduler::AdjustPolling(RunContext *run_ctx) {
+  if (!run_ctx) {
+    return;
+  }
+  // Adaptive polling disabled for now - restore the true period
+  // This is critical because co_await on Futures sets yield_time_us_ = 0,
+  // so we must restore it here to prevent periodic tasks from busy-looping
+  run_ctx->yield_time_us_ = run_ctx->true_period_ns_ / 1000.0;
+}
+
+u32 WorkStealingScheduler::MapByPidTid(u32 num_lanes) {
+  auto *sys_info = HSHM_SYSTEM_INFO;
+  pid_t pid = sys_info->pid_;
+  auto tid = HSHM_THREAD_MODEL->GetTid();
+
+  size_t combined_hash =
+      std::hash<pid_t>{}(pid) ^ (std::hash<hshm::u64>{}(tid.tid_) << 1);
+  return static_cast<u32>(combined_hash % num_lanes);
+}
+
+int WorkStealingScheduler::GetCurrentNumaNode(Worker *worker) const {
+  if (worker->GetNumaNode() >= 0) {
+    return worker->GetNumaNode();
+  }
+  auto *sys_info = HSHM_SYSTEM_INFO;
+  return sys_info->GetCurrentNumaNode();
+}
+
+}  // namespace chi
@@ -116,6 +116,13 @@ void LoadTaskArchive::bulk(hipc::ShmPtr<> &ptr, size_t size, uint32_t flags) {
           if (dst.ptr_ && src) {
             memcpy(dst.ptr_, src, copy_size);
           }
+          // Receive buffers from the runtime's RecvAllocator are not
+          // referenced past this copy
+          if (recv[current_bulk_index_].flags.Any(BULK_RECV_ALLOC)) {
+            CHI_IPC->FreeBuffer(recv[current_bulk_index_].data);
+            recv[current_bulk_index_].data = hipc::FullPtr<char>::GetNull();
+            recv[current_bulk_index_].flags.UnsetBits(BULK_RECV_ALLOC);
+          }
         } else {
           // No original buffer — zero-copy, point directly at recv buffer
           ptr = recv[current_bulk_index_].data.shm_.template Cast<void>();
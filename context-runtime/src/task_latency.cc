@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#include "chimaera/task_latency.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace chi {
+
+std::atomic<bool> TaskLatencyStats::enabled_{false};
+
+const char *TaskStageName(TaskStage stage) {
+  switch (stage) {
+    case TaskStage::kQueue:
+      return "queue";
+    case TaskStage::kDispatch:
+      return "dispatch";
+    case TaskStage::kRun:
+      return "run";
+    case TaskStage::kSuspend:
+      return "suspend";
+    case TaskStage::kTotal:
+      return "total";
+    case TaskStage::kWait:
+      return "wait";
+    default:
+      return "unknown";
+  }
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram &other) {
+  for (u32 i = 0; i < kNumBuckets; ++i) {
+    buckets_[i] += other.buckets_[i];
+  }
+  count_ += other.count_;
+  sum_ += other.sum_;
+  if (other.max_ > max_) max_ = other.max_;
+}
+
+void LatencyHistogram::Clear() {
+  std::memset(buckets_, 0, sizeof(buckets_));
+  count_ = 0;
+  sum_ = 0;
+  max_ = 0;
+}
+
+u64 LatencyHistogram::BucketUpperBound(u32 idx) {
+  if (idx < kSubBuckets) return idx;
+  u32 exp = idx / kSubBuckets - 1 + kSubBits;
+  u64 sub = idx % kSubBuckets;
+  u64 width = 1ull << (exp - kSubBits);
+  return (1ull << exp) + sub * width + width - 1;
+}
+
+u64 LatencyHistogram::Percentile(double q) const {
+  if (count_ == 0) return 0;
+  if (q < 0) q = 0;
+  if (q > 1) q = 1;
+  u64 rank = static_cast<u64>(std::ceil(q * static_cast<double>(count_)));
+  if (rank == 0) rank = 1;
+  u64 seen = 0;
+  for (u32 i = 0; i < kNumBuckets; ++i) {
+    seen += buckets_[i];
+    if (seen >= rank) {
+      u64 upper = BucketUpperBound(i);
+      return upper < max_ ? upper : max_;
+    }
+  }
+  return max_;
+}
+
+TaskLatencyEntry &TaskLatencyStats::GetEntry(const PoolId &pool_id,
+                                             u32 method) {
+  Key key{pool_id, method};
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    it = entries_.emplace(key, TaskLatencyEntry()).first;
+    it->second.pool_id_ = pool_id;
+    it->second.method_ = method;
+  }
+  return it->second;
+}
+
+void TaskLatencyStats::Record(const PoolId &pool_id, u32 method,
+                              TaskStage stage, u64 value_ns) {
+  std::lock_guard<std::mutex> guard(lock_);
+  GetEntry(pool_id, method).stages_[static_cast<u32>(stage)].Record(value_ns);
+}
+
+void TaskLatencyStats::RecordTask(const PoolId &pool_id, u32 method,
+                                  u64 submit_ns, u64 pop_ns, u64 start_ns,
+                                  u64 end_ns, u64 run_ns) {
+  std::lock_guard<std::mutex> guard(lock_);
+  LatencyHistogram *stages = GetEntry(pool_id, method).stages_;
+  // Clocks are monotonic, but submit_ns may come from another process that
+  // stamped it just before this worker's pop; clamp instead of wrapping
+  auto span = [](u64 from, u64 to) -> u64 { return to > from ? to - from : 0; };
+  if (submit_ns && pop_ns) {
+    stages[static_cast<u32>(TaskStage::kQueue)].Record(span(submit_ns, pop_ns));
+  }
+  if (pop_ns && start_ns) {
+    stages[static_cast<u32>(TaskStage::kDispatch)].Record(
+        span(pop_ns, start_ns));
+  }
+  stages[static_cast<u32>(TaskStage::kRun)].Record(run_ns);
+  if (start_ns) {
+    u64 elapsed = span(start_ns, end_ns);
+    stages[static_cast<u32>(TaskStage::kSuspend)].Record(
+        elapsed > run_ns ? elapsed - run_ns : 0);
+  }
+  if (submit_ns) {
+    stages[static_cast<u32>(TaskStage::kTotal)].Record(span(submit_ns, end_ns));
+  }
+}
+
+void TaskLatencyStats::Snapshot(std::vector<TaskLatencyEntry> &out) const {
+  std::lock_guard<std::mutex> guard(lock_);
+  for (const auto &kv : entries_) {
+    bool merged = false;
+    for (auto &entry : out) {
+      if (entry.pool_id_ == kv.second.pool_id_ &&
+          entry.method_ == kv.second.method_) {
+        entry.Merge(kv.second);
+        merged = true;
+        break;
+      }
+    }
+    if (!merged) out.push_back(kv.second);
+  }
+}
+
+void TaskLatencyStats::Clear() {
+  std::lock_guard<std::mutex> guard(lock_);
+  entries_.clear();
+}
+
+TaskLatencyStats &TaskLatencyStats::Client() {
+  static TaskLatencyStats stats;
+  return stats;
+}
+
+}  // namespace chi
@@ -0,0 +1,437 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+
+#include "chimaera/task_trace.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace chi {
+
+std::atomic<bool> TaskTracer::enabled_{false};
+
+namespace {
+
+/** Events of one thread; only the owning thread writes slots and head_ */
+struct TraceRing {
+  std::vector<TraceEvent> events_;
+  std::atomic<u64> head_{0};  // Events ever written since the last reset
+  u64 generation_ = 0;        // Capture this ring belongs to
+  u32 track_ = 0;             // Trace tid
+  std::string name_;
+  bool dead_ = false;         // Owning thread exited
+};
+
+/** Process-wide capture state; lock_ guards everything but ring contents */
+struct TraceState {
+  std::mutex lock_;
+  std::vector<TraceRing *> rings_;
+  std::atomic<u64> generation_{0};
+  u32 capacity_ = TaskTracer::kDefaultEventsPerThread;
+  u32 next_track_ = 1;
+};
+
+TraceState &State() {
+  static TraceState *state = new TraceState();  // Outlives thread exits
+  return *state;
+}
+
+/** Per-thread handle; marks the ring dead when the thread exits */
+struct TraceOwner {
+  TraceRing *ring_ = nullptr;
+  std::string name_;
+
+  ~TraceOwner() {
+    if (!ring_) return;
+    TraceState &state = State();
+    std::lock_guard<std::mutex> guard(state.lock_);
+    ring_->dead_ = true;
+  }
+};
+
+thread_local TraceOwner t_owner;
+
+/**
+ * Give the calling thread a ring for the current capture, reusing its old
+ * ring when the size still matches.
+ */
+TraceRing *AcquireRing(TraceOwner &owner, u64 generation) {
+  TraceState &state = State();
+  std::lock_guard<std::mutex> guard(state.lock_);
+  TraceRing *ring = owner.ring_;
+  if (ring && ring->events_.size() != state.capacity_) {
+    for (auto it = state.rings_.begin(); it != state.rings_.end(); ++it) {
+      if (*it == ring) {
+        state.rings_.erase(it);
+        break;
+      }
+    }
+    delete ring;
+    ring = nullptr;
+  }
+  if (!ring) {
+    ring = new TraceRing();
+    ring->events_.resize(state.capacity_);
+    ring->track_ = state.next_track_++;
+    state.rings_.push_back(ring);
+  }
+  ring->head_.store(0, std::memory_order_relaxed);
+  ring->generation_ = generation;
+  ring->name_ = owner.name_.empty()
+                    ? "thread " + std::to_string(ring->track_)
+                    : owner.name_;
+  owner.ring_ = ring;
+  return ring;
+}
+
+/** Append a JSON string literal, escaping as RFC 8259 requires */
+void AppendJsonString(std::string &out, const std::string &value) {
+  out += '"';
+  for (char c : value) {
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char buf[8];
+          std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+          out += buf;
+        } else {
+          out += c;
+        }
+    }
+  }
+  out += '"';
+}
+
+/** Append a timestamp or duration in microseconds with ns precision */
+void AppendUs(std::string &out, u64 ns) {
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%" PRIu64 ".%03" PRIu64, ns / 1000,
+                ns % 1000);
+  out += buf;
+}
+
+/** Append the fields shared by every event of a track */
+void AppendHeader(std::string &out, const char *ph, const char *cat,
+                  const std::string &name, u64 pid, u32 tid) {
+  out += "{\"ph\":\"";
+  out += ph;
+  out += "\",\"cat\":\"";
+  out += cat;
+  out += "\",\"name\":";
+  AppendJsonString(out, name);
+  out += ",\"pid\":" + std::to_string(pid);
+  out += ",\"tid\":" + std::to_string(tid);
+}
+
+}  // namespace
+
+void TaskTracer::Start(u32 events_per_thread) {
+  TraceState &state = State();
+  std::lock_guard<std::mutex> guard(state.lock_);
+  u32 capacity = 1;
+  u32 wanted = events_per_thread ? events_per_thread : kDefaultEventsPerThread;
+  while (capacity < wanted && capacity < (1u << 30)) capacity <<= 1;
+  state.capacity_ = capacity;
+  // Rings of exited threads are only needed until the next capture
+  for (auto it = state.rings_.begin(); it != state.rings_.end();) {
+    if ((*it)->dead_) {
+      delete *it;
+      it = state.rings_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  state.generation_.fetch_add(1, std::memory_order_release);
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void TaskTracer::Stop() { enabled_.store(false, std::memory_order_relaxed); }
+
+void TaskTracer::SetThreadName(const std::string &name) {
+  TraceOwner &owner = t_owner;
+  TraceState &state = State();
+  std::lock_guard<std::mutex> guard(state.lock_);
+  owner.name_ = name;
+  if (owner.ring_) owner.ring_->name_ = name;
+}
+
+void TaskTracer::Record(const TraceEvent &event) {
+  if (!IsEnabled()) return;
+  TraceOwner &owner = t_owner;
+  u64 generation = State().generation_.load(std::memory_order_acquire);
+  TraceRing *ring = owner.ring_;
+  if (!ring || ring->generation_ != generation) {
+    ring = AcquireRing(owner, generation);
+  }
+  u64 head = ring->head_.load(std::memory_order_relaxed);
+  ring->events_[head & (ring->events_.size() - 1)] = event;
+  ring->head_.store(head + 1, std::memory_order_release);
+}
+
+void TaskTracer::RecordTaskRun(const PoolId &pool_id, u32 method,
+                               u64 begin_ns, u64 end_ns, u32 flags) {
+  TraceEvent event;
+  event.kind_ = TraceKind::kTaskRun;
+  event.begin_ns_ = begin_ns;
+  event.end_ns_ = end_ns;
+  event.pool_id_ = pool_id;
+  event.method_ = method;
+  event.flags_ = flags;
+  Record(event);
+}
+
+void TaskTracer::RecordTask(const PoolId &pool_id, u32 method, u64 begin_ns,
+                            u64 end_ns, u64 run_ns) {
+  TraceEvent event;
+  event.kind_ = TraceKind::kTask;
+  event.begin_ns_ = begin_ns;
+  event.end_ns_ = end_ns;
+  event.pool_id_ = pool_id;
+  event.method_ = method;
+  event.arg0_ = run_ns;
+  Record(event);
+}
+
+void TaskTracer::RecordBdevIo(const PoolId &pool_id, bool is_write,
+                              u64 begin_ns, u64 end_ns, u64 bytes,
+                              u64 submissions) {
+  TraceEvent event;
+  event.kind_ = is_write ? TraceKind::kBdevWrite : TraceKind::kBdevRead;
+  event.begin_ns_ = begin_ns;
+  event.end_ns_ = end_ns;
+  event.pool_id_ = pool_id;
+  event.arg0_ = bytes;
+  event.arg1_ = submissions;
+  Record(event);
+}
+
+void TaskTracer::RecordNetSend(u64 node_id, u64 begin_ns, u64 end_ns,
+                               u64 bytes, u32 num_tasks, bool is_response) {
+  TraceEvent event;
+  event.kind_ = TraceKind::kNetSend;
+  event.begin_ns_ = begin_ns;
+  event.end_ns_ = end_ns;
+  event.arg0_ = bytes;
+  event.arg1_ = node_id;
+  event.method_ = num_tasks;
+  event.flags_ = is_response ? kTraceResponse : 0;
+  Record(event);
+}
+
+u64 TaskTracer::GetDroppedCount() {
+  TraceState &state = State();
+  std::lock_guard<std::mutex> guard(state.lock_);
+  u64 generation = state.generation_.load(std::memory_order_relaxed);
+  u64 dropped = 0;
+  for (TraceRing *ring : state.rings_) {
+    if (ring->generation_ != generation) continue;
+    u64 head = ring->head_.load(std::memory_order_acquire);
+    if (head > ring->events_.size()) dropped += head - ring->events_.size();
+  }
+  return dropped;
+}
+
+std::string TaskTracer::DumpJson(u64 node_id, const std::string &host,
+                                 const NameFn &name_fn) {
+  // Steady-clock stamps are shifted onto the wall clock so that dumps of
+  // several nodes line up (to the accuracy of their clock sync)
+  u64 wall_now = static_cast<u64>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count());
+  u64 offset = wall_now - Now();
+
+  struct Track {
+    u32 tid_;
+    std::string name_;
+    std::vector<TraceEvent> events_;
+  };
+  std::vector<Track> tracks;
+  u64 dropped = 0;
+  {
+    TraceState &state = State();
+    std::lock_guard<std::mutex> guard(state.lock_);
+    u64 generation = state.generation_.load(std::memory_order_relaxed);
+    for (TraceRing *ring : state.rings_) {
+      if (ring->generation_ != generation) continue;
+      u64 capacity = ring->events_.size();
+      u64 head = ring->head_.load(std::memory_order_acquire);
+      u64 first = head > capacity ? head - capacity : 0;
+      Track track{ring->track_, ring->name_, {}};
+      track.events_.reserve(head - first);
+      for (u64 i = first; i < head; ++i) {
+        track.events_.push_back(ring->events_[i & (capacity - 1)]);
+      }
+      // Slots the owner overwrote while we copied may be torn
+      u64 after = ring->head_.load(std::memory_order_acquire);
+      u64 valid = after > capacity ? after - capacity : 0;
+      if (valid > first) {
+        u64 skip = std::min(valid - first, head - first);
+        track.events_.erase(track.events_.begin(),
+                            track.events_.begin() + skip);
+      }
+      dropped += (after > capacity ? after - capacity : 0);
+      tracks.push_back(std::move(track));
+    }
+  }
+  if (tracks.empty()) {
+    return std::string();
+  }
+
+  std::map<std::pair<u64, u32>, std::string> names;
+  auto task_name = [&](const PoolId &pool_id, u32 method) -> const std::string & {
+    auto key = std::make_pair(pool_id.ToU64(), method);
+    auto it = names.find(key);
+    if (it != names.end()) return it->second;
+    std::string name = name_fn ? name_fn(pool_id, method) : std::string();
+    if (name.empty()) {
+      name = pool_id.ToString() + ":" + std::to_string(method);
+    }
+    return names.emplace(key, std::move(name)).first->second;
+  };
+
+  std::string out;
+  out += "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":" +
+         std::to_string(node_id) + ",\"args\":{\"name\":";
+  AppendJsonString(out, "node " + std::to_string(node_id) +
+                            (host.empty() ? "" : " (" + host + ")"));
+  out += "}}";
+  if (dropped) {
+    out += ",\n{\"ph\":\"M\",\"name\":\"process_labels\",\"pid\":" +
+           std::to_string(node_id) + ",\"args\":{\"labels\":\"" +
+           std::to_string(dropped) + " events overwritten\"}}";
+  }
+
+  u64 async_id = 0;
+  for (const Track &track : tracks) {
+    out += ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" +
+           std::to_string(node_id) + ",\"tid\":" + std::to_string(track.tid_) +
+           ",\"args\":{\"name\":";
+    AppendJsonString(out, track.name_);
+    out += "}}";
+    for (const TraceEvent &ev : track.events_) {
+      u64 dur = ev.end_ns_ > ev.begin_ns_ ? ev.end_ns_ - ev.begin_ns_ : 0;
+      std::string args;
+      const char *cat = "task";
+      std::string name;
+      bool is_async = true;
+      switch (ev.kind_) {
+        case TraceKind::kTaskRun:
+          // Slices of one worker never overlap, so they nest as X events
+          is_async = false;
+          name = task_name(ev.pool_id_, ev.method_);
+          args = std::string("\"resumed\":") +
+                 ((ev.flags_ & kTraceResumed) ? "true" : "false") +
+                 ",\"end\":\"" +
+                 ((ev.flags_ & kTraceYielded) ? "suspend" : "done") + "\"";
+          break;
+        case TraceKind::kTask:
+          name = task_name(ev.pool_id_, ev.method_);
+          args = "\"run_us\":";
+          AppendUs(args, ev.arg0_);
+          break;
+        case TraceKind::kBdevRead:
+        case TraceKind::kBdevWrite:
+          cat = "bdev";
+          name = ev.kind_ == TraceKind::kBdevWrite ? "bdev write"
+                                                   : "bdev read";
+          args = "\"pool\":\"" + ev.pool_id_.ToString() + "\",\"bytes\":" +
+                 std::to_string(ev.arg0_) +
+                 ",\"submissions\":" + std::to_string(ev.arg1_);
+          break;
+        case TraceKind::kNetSend:
+          is_async = false;
+          cat = "net";
+          name = (ev.flags_ & kTraceResponse) ? "send out" : "send in";
+          args = "\"node\":" + std::to_string(ev.arg1_) +
+                 ",\"tasks\":" + std::to_string(ev.method_) +
+                 ",\"bytes\":" + std::to_string(ev.arg0_);
+          break;
+      }
+      if (is_async) {
+        // Concurrent tasks and I/Os overlap, so they get async tracks
+        std::string id = "\"" + std::to_string(node_id) + "." +
+                         std::to_string(async_id++) + "\"";
+        out += ",\n";
+        AppendHeader(out, "b", cat, name, node_id, track.tid_);
+        out += ",\"id\":" + id + ",\"ts\":";
+        AppendUs(out, ev.begin_ns_ + offset);
+        out += ",\"args\":{" + args + "}}";
+        out += ",\n";
+        AppendHeader(out, "e", cat, name, node_id, track.tid_);
+        out += ",\"id\":" + id + ",\"ts\":";
+        AppendUs(out, ev.end_ns_ + offset);
+        out += "}";
+      } else {
+        out += ",\n";
+        AppendHeader(out, "X", cat, name, node_id, track.tid_);
+        out += ",\"ts\":";
+        AppendUs(out, ev.begin_ns_ + offset);
+        out += ",\"dur\":";
+        AppendUs(out, dur);
+        out += ",\"args\":{" + args + "}}";
+      }
+    }
+  }
+  return out;
+}
+
+std::string TaskTracer::WrapJson(const std::vector<std::string> &fragments) {
+  std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+  bool first = true;
+  for (const std::string &fragment : fragments) {
+    if (fragment.empty()) continue;
+    if (!first) out += ",\n";
+    first = false;
+    out += fragment;
+  }
+  out += "\n]}\n";
+  return out;
+}
+
+}  // namespace chi
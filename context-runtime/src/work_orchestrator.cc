@@ -47,6 +47,7 @@
 #include "chimaera/pool_manager.h"
 #include "chimaera/singletons.h"
 #include "chimaera/ipc_manager.h"
+#include "chimaera/worker_affinity.h"
 
 // Global pointer variable definition for Work Orchestrator singleton
 HSHM_DEFINE_GLOBAL_PTR_VAR_CC(chi::WorkOrchestrator, g_work_orchestrator);
@@ -147,6 +148,15 @@ bool WorkOrchestrator::StartWorkers() {
     return false;
   }
 
+  // Blocking calls may be offloaded as soon as the first task runs
+  ConfigManager *config = CHI_CONFIG_MANAGER;
+  u32 blocking_threads = config->GetBlockingThreads();
+  if (blocking_threads > 0) {
+    blocking_pool_.Start(blocking_threads, config->GetBlockingQueueDepth());
+    HLOG(kInfo, "Blocking pool: {} threads, {} queued calls max",
+         blocking_threads, config->GetBlockingQueueDepth());
+  }
+
   // Spawn worker threads using HSHM thread model
   if (!SpawnWorkerThreads()) {
     return false;
@@ -228,6 +238,9 @@ void WorkOrchestrator::StopWorkers() {
 
   HLOG(kDebug, "Joined {} of {} worker threads", joined_count,
        worker_threads_.size());
+
+  // No worker polls the pool anymore; run what is left and join
+  blocking_pool_.Stop();
   workers_running_ = false;
 }
 
@@ -293,6 +306,12 @@ bool WorkOrchestrator::SpawnWorkerThreads() {
       // Mark the lane with the assigned worker ID
       lane->SetAssignedWorkerId(worker->GetId());
 
+      // Same worker serves the high-priority lane of its lane ID
+      TaskLane *high_lane = &worker_queues->GetLane(
+          lane_id, static_cast<u32>(TaskPrio::kHigh));
+      worker->SetHighPrioLane(high_lane);
+      high_lane->SetAssignedWorkerId(worker->GetId());
+
       HLOG(kInfo, "WorkOrchestrator: Mapped worker {} (ID {}) to lane {}",
             worker_idx, worker->GetId(), lane_id);
     } else {
@@ -327,14 +346,29 @@ bool WorkOrchestrator::SpawnWorkerThreads() {
   // Use HSHM thread model to spawn worker threads
   auto thread_model = HSHM_THREAD_MODEL;
   worker_threads_.reserve(all_workers_.size());
+  std::vector<int> cpus = PlanWorkerAffinity();
+  auto *sys_info = HSHM_SYSTEM_INFO;
 
   try {
     for (size_t i = 0; i < all_workers_.size(); ++i) {
       auto *worker = all_workers_[i];
       if (worker) {
-        // Spawn thread using HSHM thread model
+        // Spawn thread using HSHM thread model; a planned worker pins
+        // itself before it runs
+        int cpu = cpus[i];
+        if (cpu != WorkerAffinityPlanner::kUnpinned) {
+          worker->SetNumaNode(sys_info->GetNumaNodeOfCpu(cpu));
+        }
         hshm::thread::Thread thread = thread_model->Spawn(
-            thread_group_, [worker](int tid) { worker->Run(); },
+            thread_group_,
+            [worker, cpu](int tid) {
+              if (cpu != WorkerAffinityPlanner::kUnpinned &&
+                  !hshm::SystemInfo::PinThreadToCpu(cpu)) {
+                HLOG(kWarning, "WorkOrchestrator: failed to pin worker {} "
+                     "to CPU {}", worker->GetId(), cpu);
+              }
+              worker->Run();
+            },
             static_cast<int>(i));
         worker_threads_.emplace_back(std::move(thread));
       }
@@ -349,6 +383,93 @@ bool WorkOrchestrator::SpawnWorkerThreads() {
   }
 }
 
+std::vector<int> WorkOrchestrator::PlanWorkerAffinity() const {
+  size_t num_workers = all_workers_.size();
+  std::vector<int> plan(num_workers, WorkerAffinityPlanner::kUnpinned);
+  ConfigManager *config = CHI_CONFIG_MANAGER;
+  const WorkerAffinityConfig &conf = config->GetWorkerAffinity();
+  if (!conf.enabled_ || num_workers == 0) {
+    return plan;
+  }
+
+  // Device nodes are only worth looking up on multi-node hosts
+  auto *sys_info = HSHM_SYSTEM_INFO;
+  bool numa = sys_info->numa_nodes_ > 1;
+  std::vector<int> nvme_nodes, gpu_nodes;
+  int nic_node = WorkerAffinityPlanner::kAnyNode;
+  if (numa) {
+    nvme_nodes = hshm::SystemInfo::GetDeviceClassNumaNodes("nvme");
+    gpu_nodes = hshm::SystemInfo::GetGpuNumaNodes();
+    const std::string &domain = config->GetFabricDomain();
+    std::vector<int> nics;
+    if (!conf.nic_.empty()) {
+      nics.push_back(hshm::SystemInfo::GetDeviceNumaNode("net", conf.nic_));
+    } else if (!domain.empty()) {
+      nics.push_back(
+          hshm::SystemInfo::GetDeviceNumaNode("infiniband", domain));
+    } else {
+      nics = hshm::SystemInfo::GetDeviceClassNumaNodes("infiniband");
+      if (nics.empty()) {
+        nics = hshm::SystemInfo::GetDeviceClassNumaNodes("net");
+      }
+    }
+    if (!nics.empty() && nics[0] >= 0) {
+      nic_node = nics[0];
+    }
+  }
+
+  // Map a role's policy to the node its workers want; io workers rotate
+  // over the NVMe drives' nodes
+  size_t io_index = 0;
+  auto want = [](const std::string &policy, int device_node) {
+    switch (WorkerAffinityPlanner::ParsePolicy(policy)) {
+      case AffinityPolicy::kNone:
+        return WorkerAffinityPlanner::kNoPin;
+      case AffinityPolicy::kDevice:
+        return device_node;
+      default:
+        return WorkerAffinityPlanner::kAnyNode;
+    }
+  };
+  std::vector<int> nodes(num_workers);
+  nodes[0] = want(conf.sched_, WorkerAffinityPlanner::kAnyNode);
+  for (size_t i = 1; i < num_workers; ++i) {
+    int nvme_node = nvme_nodes.empty()
+                        ? WorkerAffinityPlanner::kAnyNode
+                        : nvme_nodes[io_index++ % nvme_nodes.size()];
+    nodes[i] = want(conf.io_, nvme_node);
+  }
+  if (scheduler_) {
+    Worker *gpu_worker = scheduler_->GetGpuWorker();
+    if (gpu_worker && gpu_worker->GetId() < num_workers) {
+      nodes[gpu_worker->GetId()] =
+          want(conf.gpu_, gpu_nodes.empty() ? WorkerAffinityPlanner::kAnyNode
+                                            : gpu_nodes[0]);
+    }
+    IpcManager *ipc = CHI_IPC;
+    u32 num_shards = ipc ? ipc->GetNumNetShards() : 1;
+    for (u32 shard = 0; shard < num_shards; ++shard) {
+      Worker *net_worker = scheduler_->GetNetShardWorker(shard);
+      if (net_worker && net_worker->GetId() < num_workers) {
+        nodes[net_worker->GetId()] = want(conf.net_, nic_node);
+      }
+    }
+  }
+
+  plan = WorkerAffinityPlanner::Plan(WorkerAffinityPlanner::ReadTopology(),
+                                     nodes, conf.smt_siblings_);
+  for (size_t i = 0; i < num_workers; ++i) {
+    if (plan[i] != WorkerAffinityPlanner::kUnpinned) {
+      HLOG(kInfo, "WorkOrchestrator: worker {} -> CPU {} (NUMA node {})", i,
+           plan[i], sys_info->GetNumaNodeOfCpu(plan[i]));
+    } else if (nodes[i] != WorkerAffinityPlanner::kNoPin) {
+      HLOG(kWarning, "WorkOrchestrator: no free core for worker {}, "
+           "leaving it unpinned", i);
+    }
+  }
+  return plan;
+}
+
 bool WorkOrchestrator::CreateWorker() {
   u32 worker_id = static_cast<u32>(all_workers_.size());
   auto worker = std::make_unique<Worker>(worker_id);
@@ -68,11 +68,21 @@ namespace chi {
 
 // Stack detection is now handled by WorkOrchestrator during initialization
 
+/**
+ * Stamp a lifecycle point needed by latency histograms or the trace.
+ * @return Monotonic time in nanoseconds, or 0 when neither is enabled
+ */
+static inline u64 StampLifecycle() {
+  if (!TaskLatencyStats::IsEnabled() && !TaskTracer::IsEnabled()) return 0;
+  return TaskLatencyStats::Now();
+}
+
 Worker::Worker(u32 worker_id)
     : worker_id_(worker_id),
       is_running_(false),
       is_initialized_(false),
       load_(0),
+      avg_task_us_(0),
       did_work_(false),
       task_did_work_(false),
       current_run_context_(nullptr),
@@ -149,6 +159,9 @@ WorkerStats Worker::GetWorkerStats() const {
     stats.num_queued_tasks_ = assigned_lane_->Size();
     stats.is_active_ = assigned_lane_->IsActive();
   }
+  if (high_prio_lane_) {
+    stats.num_queued_tasks_ += high_prio_lane_->Size();
+  }
 
   // Count blocked tasks across all blocked queues
   stats.num_blocked_tasks_ = 0;
@@ -156,11 +169,7 @@ WorkerStats Worker::GetWorkerStats() const {
     stats.num_blocked_tasks_ += blocked_queues_[i].size();
   }
 
-  // Count periodic tasks across all periodic queues
-  stats.num_periodic_tasks_ = 0;
-  for (u32 i = 0; i < NUM_PERIODIC_QUEUES; ++i) {
-    stats.num_periodic_tasks_ += periodic_queues_[i].size();
-  }
+  stats.num_periodic_tasks_ = periodic_timers_.Size();
 
   // Count retry tasks
   stats.num_retry_tasks_ = retry_queue_.size();
@@ -172,6 +181,14 @@ WorkerStats Worker::GetWorkerStats() const {
 
   stats.num_tasks_processed_ = num_tasks_processed_;
   stats.load_ = load_;
+  stats.poll_ = poll_ctrl_.GetStats();
+
+  auto *ipc_manager = CHI_IPC;
+  LaneStatsTable *lane_stats = ipc_manager->GetLaneStats();
+  if (lane_stats) {
+    stats.lane_remaps_in_ = lane_stats->GetRemapsIn(worker_id_);
+    stats.lane_remaps_out_ = lane_stats->GetRemapsOut(worker_id_);
+  }
 
   return stats;
 }
@@ -198,12 +215,8 @@ void Worker::Finalize() {
     }
   }
 
-  // Clean up all periodic queues
-  for (u32 i = 0; i < NUM_PERIODIC_QUEUES; ++i) {
-    while (!periodic_queues_[i].empty()) {
-      periodic_queues_[i].pop();
-    }
-  }
+  // Drop the periodic timers
+  periodic_timers_.Clear();
 
   // Clean up retry queue
   while (!retry_queue_.empty()) {
@@ -212,6 +225,7 @@ void Worker::Finalize() {
 
   // Clear assigned lane reference (don't delete - it's in shared memory)
   assigned_lane_ = nullptr;
+  high_prio_lane_ = nullptr;
 
   is_initialized_ = false;
 }
@@ -229,14 +243,41 @@ void Worker::Run() {
   if (assigned_lane_) {
     assigned_lane_->SetTid(tid);
   }
+  if (high_prio_lane_) {
+    high_prio_lane_->SetTid(tid);
+  }
   event_manager_.AddSignalEvent(nullptr);
+  TaskTracer::SetThreadName("worker " + std::to_string(worker_id_));
+
+  // Configure the idle policy once the config is final
+  auto *config = CHI_CONFIG_MANAGER;
+  poll_ctrl_.Configure(PollController::ParseMode(config->GetPollMode()),
+                       config->GetFirstBusyWait(),
+                       config->GetWakeLatencyTarget(), config->GetMaxSpin());
+  counters_.start_us_.store(
+      static_cast<u64>(std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch())
+                           .count()),
+      std::memory_order_relaxed);
+
+  // Each iteration is a quiescent point for epoch-based reclamation, so
+  // tasks must not hold lock-free references across a suspension
+  auto *ebr = HSHM_EBR;
+  ebr_ = hshm::EpochReclaimer::Local();
 
   // Main worker loop - process tasks from assigned lane
   while (is_running_) {
+    ebr->Quiesce(ebr_);
     did_work_ = false;  // Reset work tracker at start of each loop iteration
     task_did_work_ = false;  // Reset task-level work tracker
 
-    // Process tasks from assigned lane
+    // High-priority lane first, for at most kHighPrioBurst batches, then
+    // one batch from the normal lane so it is never starved
+    for (u32 b = 0; high_prio_lane_ && b < kHighPrioBurst; ++b) {
+      u32 count = ProcessNewTasks(high_prio_lane_);
+      if (count > 0) did_work_ = true;
+      if (count < kLaneBatchSize) break;
+    }
     if (assigned_lane_) {
       u32 count = ProcessNewTasks(assigned_lane_);
       if (count > 0) did_work_ = true;
@@ -244,19 +285,44 @@ void Worker::Run() {
     u32 gpu_count = ProcessNewTasksGpu();
     if (gpu_count > 0) did_work_ = true;
 
+    // Let the scheduler steal or delegate work; anything it moved onto our
+    // lane is picked up next iteration, so do not suspend
+    if (scheduler_) {
+      scheduler_->RebalanceWorker(this);
+      if (!did_work_ && assigned_lane_ && !assigned_lane_->Empty()) {
+        did_work_ = true;
+      }
+      if (!did_work_ && high_prio_lane_ && !high_prio_lane_->Empty()) {
+        did_work_ = true;
+      }
+    }
+
     // Check blocked queue for completed tasks at end of each iteration
     ContinueBlockedTasks(false);
 
+    // Submit network I/O that transports deferred during this iteration
+    event_manager_.Flush();
+
     // Increment iteration counter
     iteration_count_++;
 
+    // Refresh the metrics snapshot before idling, and periodically when busy
+    if (!did_work_ || iteration_count_ % 64 == 0) {
+      PublishCounters();
+    }
+
     if (!did_work_) {
       // No work was done - suspend worker with adaptive sleep
       SuspendMe();
     }
 
     if (did_work_) {
-      // Work was done - reset idle counters
+      // Work was done - close the idle period and reset idle counters
+      if (idle_iterations_ > 0) {
+        hshm::Timepoint now;
+        now.Now();
+        poll_ctrl_.RecordArrival(idle_start_.GetUsecFromStart(now));
+      }
       idle_iterations_ = 0;
       current_sleep_us_ = 0;
       sleep_count_ = 0;
@@ -264,11 +330,37 @@ void Worker::Run() {
     }
   }
 
+  ebr->Offline(ebr_);
   // EventManager destructor handles signalfd and epoll cleanup
 }
 
 void Worker::Stop() { is_running_ = false; }
 
+void Worker::PublishCounters() {
+  u32 blocked = 0;
+  for (u32 i = 0; i < NUM_BLOCKED_QUEUES; ++i) {
+    blocked += static_cast<u32>(blocked_queues_[i].size());
+  }
+  u32 periodic = static_cast<u32>(periodic_timers_.Size());
+  PollStats poll = poll_ctrl_.GetStats();
+  counters_.tasks_processed_.store(num_tasks_processed_,
+                                   std::memory_order_relaxed);
+  counters_.blocked_tasks_.store(blocked, std::memory_order_relaxed);
+  counters_.periodic_tasks_.store(periodic, std::memory_order_relaxed);
+  counters_.retry_tasks_.store(static_cast<u32>(retry_queue_.size()),
+                               std::memory_order_relaxed);
+  counters_.load_.store(load_, std::memory_order_relaxed);
+  counters_.idle_cpu_us_.store(poll.idle_cpu_us_, std::memory_order_relaxed);
+  counters_.sleep_us_.store(poll.sleep_us_, std::memory_order_relaxed);
+
+  // Lane load the LocalScheduler balances client threads on
+  auto *ipc_manager = CHI_IPC;
+  LaneStatsTable *lane_stats = ipc_manager->GetLaneStats();
+  if (lane_stats) {
+    lane_stats->SetLoad(worker_id_, GetExpectedWaitUs());
+  }
+}
+
 void Worker::SetLane(TaskLane *lane) {
   assigned_lane_ = lane;
   // Mark lane as active when assigned to worker
@@ -279,6 +371,24 @@ void Worker::SetLane(TaskLane *lane) {
 
 TaskLane *Worker::GetLane() const { return assigned_lane_; }
 
+void Worker::SetHighPrioLane(TaskLane *lane) {
+  high_prio_lane_ = lane;
+  if (high_prio_lane_) {
+    high_prio_lane_->SetActive(true);
+  }
+}
+
+TaskLane *Worker::GetHighPrioLane() const { return high_prio_lane_; }
+
+float Worker::GetExpectedWaitUs() const {
+  float queued = assigned_lane_ ? static_cast<float>(assigned_lane_->Size())
+                                : 0.0f;
+  if (high_prio_lane_) {
+    queued += static_cast<float>(high_prio_lane_->Size());
+  }
+  return load_ + queued * avg_task_us_;
+}
+
 void Worker::SetGpuLanes(const std::vector<GpuTaskLane *> &lanes) {
   gpu_lanes_ = lanes;
 }
@@ -405,6 +515,10 @@ bool Worker::ProcessNewTaskGpu(GpuTaskLane *gpu_lane) {
   // Step 7: Allocate RunContext and route the task.
   if (!task_full_ptr->task_flags_.Any(TASK_RUN_CTX_EXISTS)) {
     CHI_IPC->BeginTask(future, container, assigned_lane_);
+    RunContext *run_ctx = task_full_ptr->GetRunCtx();
+    if (run_ctx) {
+      run_ctx->pop_ns_ = StampLifecycle();
+    }
   } else {
     RunContext *run_ctx = task_full_ptr->GetRunCtx();
     if (run_ctx) {
@@ -431,57 +545,70 @@ hipc::FullPtr<Task> Worker::GetOrCopyTaskFromFuture(Future<Task> &future,
 }
 
 u32 Worker::ProcessNewTasks(TaskLane *lane) {
-  const u32 MAX_TASKS_PER_ITERATION = 16;
-  u32 tasks_processed = 0;
-
   if (!lane) {
     return 0;
   }
 
-  while (tasks_processed < MAX_TASKS_PER_ITERATION) {
-    if (ProcessNewTask(lane)) {
-      tasks_processed++;
-    } else {
-      break;
+  // Drain a burst of futures and prefetch their headers, so the cache
+  // misses of the whole batch overlap instead of stalling one at a time
+  Future<Task> batch[kLaneBatchSize];
+  hipc::FullPtr<FutureShm> batch_shm[kLaneBatchSize];
+  u32 count = 0;
+  while (count < kLaneBatchSize && lane->Pop(batch[count])) {
+    batch_shm[count] = batch[count].GetFutureShm();
+    if (!batch_shm[count].IsNull()) {
+      __builtin_prefetch(batch_shm[count].ptr_);
     }
+    if (batch[count].get() != nullptr) {
+      __builtin_prefetch(batch[count].get());
+    }
+    ++count;
   }
-
-  return tasks_processed;
-}
-
-bool Worker::ProcessNewTask(TaskLane *lane) {
-  Future<Task> future;
-  // Pop Future<Task> from lane
-  if (!lane->Pop(future)) {
-    return false;
+  if (count == 0) {
+    return 0;
   }
 
+  // Dispatch in FIFO order. The container is looked up per task, right
+  // before it runs: an earlier task of the batch may create or destroy a
+  // pool, which would leave a container resolved for the whole batch stale.
+  auto *pool_manager = CHI_POOL_MANAGER;
+  for (u32 i = 0; i < count; ++i) {
+    Container *container =
+        batch_shm[i].IsNull()
+            ? nullptr
+            : pool_manager->GetStaticContainer(batch_shm[i]->pool_id_);
+    DispatchNewTask(lane, batch[i], batch_shm[i], container);
+  }
+  return count;
+}
 
+void Worker::DispatchNewTask(TaskLane *lane, Future<Task> &future,
+                             const hipc::FullPtr<FutureShm> &future_shm,
+                             Container *container) {
   SetCurrentRunContext(nullptr);
 
-  // Get FutureShm (allocator is pre-registered by Admin::RegisterMemory)
-  auto future_shm = future.GetFutureShm();
+  // FutureShm allocator is pre-registered by Admin::RegisterMemory
   if (future_shm.IsNull()) {
     HLOG(kError, "Worker {}: Failed to get FutureShm (null pointer)",
          worker_id_);
-    return true;
+    return;
   }
 
   // Get pool_id and method_id from FutureShm
   PoolId pool_id = future_shm->pool_id_;
   u32 method_id = future_shm->method_id_;
 
-  // Get static container for task deserialization (stateless operation)
-  auto *pool_manager = CHI_POOL_MANAGER;
-  Container *container = pool_manager->GetStaticContainer(pool_id);
-
+  // The static container (for stateless deserialization) was resolved by
+  // the caller just before dispatch
   if (!container) {
     // Container not found - mark as complete with error
     HLOG(kError, "Worker {}: Container not found for pool_id={}, method={}",
          worker_id_, pool_id, method_id);
     // Set both error bit AND FUTURE_COMPLETE so client doesn't hang
+    auto *ipc_manager = CHI_IPC;
+    ipc_manager->ReleaseSendCredit(future_shm.ptr_, lane->Size());
     future_shm->flags_.SetBits(1 | FutureShm::FUTURE_COMPLETE);
-    return true;
+    return;
   }
 
   // Get or copy task from Future (handles deserialization if needed)
@@ -494,13 +621,19 @@ bool Worker::ProcessNewTask(TaskLane *lane) {
          "Worker {}: Failed to deserialize task for pool_id={}, method={}",
          worker_id_, pool_id, method_id);
     // Mark as complete with error so client doesn't hang
+    auto *ipc_manager = CHI_IPC;
+    ipc_manager->ReleaseSendCredit(future_shm.ptr_, lane->Size());
     future_shm->flags_.SetBits(1 | FutureShm::FUTURE_COMPLETE);
-    return true;
+    return;
   }
 
   // Allocate RunContext before routing (skip if already created)
   if (!task_full_ptr->task_flags_.Any(TASK_RUN_CTX_EXISTS)) {
     CHI_IPC->BeginTask(future, container, lane);
+    RunContext *run_ctx = task_full_ptr->GetRunCtx();
+    if (run_ctx) {
+      run_ctx->pop_ns_ = StampLifecycle();
+    }
   } else {
     // Task was re-enqueued from another worker (e.g., by RouteLocal).
     // Update worker-specific RunContext fields to match this worker,
@@ -524,42 +657,60 @@ bool Worker::ProcessNewTask(TaskLane *lane) {
     ExecTask(task_full_ptr, run_ctx, is_started);
 #endif
   }
-
-  return true;
 }
 
-double Worker::GetSuspendPeriod() const {
-  // Scan all periodic queues to find the minimum yield_time (polling period)
-  // We must wake up for the fastest periodic task to avoid starving it
-  double min_yield_time_us = 0;
-  bool found_task = false;
-
-  // Check all periodic queues (0-3)
-  for (u32 queue_idx = 0; queue_idx < NUM_PERIODIC_QUEUES; ++queue_idx) {
-    const std::queue<RunContext *> &queue = periodic_queues_[queue_idx];
-
-    if (queue.empty()) {
-      continue;
-    }
-
-    // Check just the front task of each queue (representative of the queue's
-    // period)
-    RunContext *run_ctx = queue.front();
-
-    if (!run_ctx || run_ctx->task_.IsNull()) {
-      continue;
-    }
+bool Worker::ExecInline(TaskLane *lane, Future<Task> &future) {
+  RunContext *parent = GetCurrentRunContext();
+  FullPtr<Task> task_ptr = future.GetTaskPtr();
+  // Only plain subtasks of a running coroutine, and a bounded nesting
+  // depth so chains of inline sends cannot exhaust the worker stack
+  if (!parent || task_ptr.IsNull() || inline_depth_ >= kMaxInlineDepth ||
+      task_ptr->IsPeriodic() ||
+      task_ptr->task_flags_.Any(TASK_FIRE_AND_FORGET)) {
+    return false;
+  }
+  hipc::FullPtr<FutureShm> future_shm = future.GetFutureShm();
+  if (future_shm.IsNull()) {
+    return false;
+  }
+  Container *container =
+      CHI_POOL_MANAGER->GetStaticContainer(future_shm->pool_id_);
+  if (!container) {
+    return false;
+  }
 
-    // Use the yield_time directly - this is the adaptive polling period
-    if (!found_task || run_ctx->yield_time_us_ < min_yield_time_us) {
-      min_yield_time_us = run_ctx->yield_time_us_;
-      found_task = true;
-    }
+  RunContext *prev_parent = inline_parent_;
+  inline_parent_ = parent;
+  ++inline_depth_;
+  WorkerCounters::Bump(counters_.inline_tasks_);
+  if (RunContext *run_ctx = task_ptr->GetRunCtx()) {
+    run_ctx->pop_ns_ = StampLifecycle();
   }
+  // Routes like a popped task: runs here, or goes to another worker or the
+  // network if the scheduler places it elsewhere
+  DispatchNewTask(lane, future, future_shm, container);
+  --inline_depth_;
+  inline_parent_ = prev_parent;
+  SetCurrentRunContext(parent);
+  return true;
+}
 
+double Worker::GetSuspendPeriod() const {
   // Return -1 if no periodic tasks (means wait indefinitely in epoll_wait)
-  // Otherwise return the minimum yield_time across all periodic queues
-  return found_task ? min_yield_time_us : -1;
+  u64 deadline_us = periodic_timers_.NextDeadline();
+  if (deadline_us == ExpiryWheel<RunContext *>::kNoDeadline) {
+    return -1;
+  }
+  hshm::Timepoint now;
+  now.Now();
+  u64 now_us = TimerNowUs(now);
+  return deadline_us > now_us ? static_cast<double>(deadline_us - now_us)
+                              : 0.0;
+}
+
+u64 Worker::TimerNowUs(hshm::Timepoint &time) const {
+  double us = spawn_time_.GetUsecFromStart(time);
+  return us > 0 ? static_cast<u64>(us) : 0;
 }
 
 void Worker::SuspendMe() {
@@ -576,19 +727,19 @@ void Worker::SuspendMe() {
     idle_start_.Now();
   }
 
-  // Get configuration parameters
-  auto *config = CHI_CONFIG_MANAGER;
-  u32 first_busy_wait = config->GetFirstBusyWait();
-  u32 max_sleep = config->GetMaxSleep();
-
   // Calculate actual elapsed idle time
   hshm::Timepoint current_time;
   current_time.Now();
   double elapsed_idle_us = idle_start_.GetUsecFromStart(current_time);
 
-  if (elapsed_idle_us < first_busy_wait) {
+  PollAction action = poll_ctrl_.Decide(elapsed_idle_us);
+  if (action == PollAction::kBusy) {
     // Still in busy wait period - just return
     return;
+  } else if (action == PollAction::kSpin) {
+    // Relax the core briefly without giving it up
+    PollController::Spin();
+    return;
   } else {
     // Past busy wait period - use epoll
     // Before sleeping, check blocked queues with force=true
@@ -603,14 +754,26 @@ void Worker::SuspendMe() {
     if (assigned_lane_) {
       assigned_lane_->SetActive(false);
     }
+    if (high_prio_lane_) {
+      high_prio_lane_->SetActive(false);
+    }
 
     // Calculate timeout from periodic tasks
     double suspend_period_us = GetSuspendPeriod();
     int timeout_us =
         (suspend_period_us < 0) ? -1 : static_cast<int>(suspend_period_us);
 
-    // Wait for signal using EventManager
+    // Wait for signal using EventManager. Go offline first so a sleeping
+    // worker does not hold back epoch reclamation
+    auto *ebr = HSHM_EBR;
+    ebr->Offline(ebr_);
+    hshm::Timepoint sleep_start;
+    sleep_start.Now();
     int nfds = event_manager_.Wait(timeout_us);
+    hshm::Timepoint sleep_end;
+    sleep_end.Now();
+    poll_ctrl_.RecordSleep(timeout_us, sleep_start.GetUsecFromStart(sleep_end),
+                           nfds == 0);
 
     if (nfds == 0) {
       sleep_count_++;
@@ -773,6 +936,7 @@ void Worker::ResumeCoroutine(const FullPtr<Task> &task_ptr,
   }
 
   // Resume the coroutine/fiber - it will run until next suspension or completion
+  WorkerCounters::Bump(counters_.resumes_);
   try {
     run_ctx->coro_handle_.resume();
 
@@ -837,11 +1001,13 @@ void Worker::ExecTask(const FullPtr<Task> &task_ptr, RunContext *run_ctx,
   // Start CPU and wall timers before execution
   run_ctx->cpu_timer_.Resume();
   run_ctx->wall_timer_.Resume();
+  u64 trace_begin_ns = TaskTracer::Stamp();
 
   // Call appropriate coroutine function based on task state
   if (is_started) {
     ResumeCoroutine(task_ptr, run_ctx);
   } else {
+    run_ctx->start_ns_ = TaskLatencyStats::Stamp();
     StartCoroutine(task_ptr, run_ctx);
     task_ptr->SetFlags(TASK_STARTED);
 
@@ -872,9 +1038,20 @@ void Worker::ExecTask(const FullPtr<Task> &task_ptr, RunContext *run_ctx,
 
   // Check if coroutine is done or yielded
   bool coro_done = run_ctx->coro_handle_ && run_ctx->coro_handle_.done();
+  bool yielded = run_ctx->is_yielded_ && !coro_done;
+
+  // Idle polls of periodic tasks would flood the trace, so only slices
+  // that did work are recorded for them
+  if (trace_begin_ns && (!task_ptr->IsPeriodic() || run_ctx->did_work_)) {
+    TaskTracer::RecordTaskRun(
+        task_ptr->pool_id_, task_ptr->method_, trace_begin_ns,
+        TaskTracer::Now(),
+        static_cast<u32>((is_started ? kTraceResumed : 0) |
+                        (yielded ? kTraceYielded : 0)));
+  }
 
   // If coroutine yielded (not done and is_yielded_ set), don't clean up
-  if (run_ctx->is_yielded_ && !coro_done) {
+  if (yielded) {
     // yield_time_us_ > 0 means cooperative yield (polling) — add to periodic
     // queue so the worker re-checks after the requested delay.
     // yield_time_us_ == 0 means waiting for a Future event — the event queue
@@ -901,6 +1078,8 @@ void Worker::EndTask(const FullPtr<Task> &task_ptr, RunContext *run_ctx,
 
   // Track completed tasks
   ++num_tasks_processed_;
+  WorkerCounters::Bump(
+      counters_.method_tasks_[WorkerCounters::MethodSlot(task_ptr->method_)]);
 
   // Subtract predicted load from worker
   load_ -= run_ctx->predicted_load_;
@@ -919,6 +1098,16 @@ void Worker::EndTask(const FullPtr<Task> &task_ptr, RunContext *run_ctx,
   bool is_remote = task_ptr->IsRemote();
   bool is_periodic = task_ptr->IsPeriodic();
 
+  // Track per-method and per-worker cost for latency-aware routing.
+  // Periodic pollers are excluded so they don't drag the averages down.
+  if (!is_periodic) {
+    container->UpdateMethodCost(task_ptr->method_, actual_wall_us);
+    float lr = container->GetLearningRate();
+    avg_task_us_ = (avg_task_us_ <= 0)
+                       ? actual_wall_us
+                       : (1.0f - lr) * avg_task_us_ + lr * actual_wall_us;
+  }
+
   // Handle periodic task rescheduling
   if (is_periodic && can_resched) {
     ReschedulePeriodicTask(run_ctx, task_ptr);
@@ -928,6 +1117,23 @@ void Worker::EndTask(const FullPtr<Task> &task_ptr, RunContext *run_ctx,
   // Decrement work remaining for non-periodic tasks
   if (!is_periodic) {
     container->UpdateWork(task_ptr, *run_ctx, -1);
+    if (TaskLatencyStats::IsEnabled()) {
+      RecordTaskLatency(task_ptr, run_ctx);
+    }
+    if (TaskTracer::IsEnabled() && run_ctx->pop_ns_) {
+      TaskTracer::RecordTask(task_ptr->pool_id_, task_ptr->method_,
+                             run_ctx->pop_ns_, TaskTracer::Now(),
+                             static_cast<u64>(run_ctx->wall_timer_.GetNsec()));
+    }
+  }
+
+  // Return the submitting client's admission credit before the client can
+  // observe completion and free the FutureShm
+  auto *ipc_manager = CHI_IPC;
+  if (ipc_manager->GetClientCreditsOffset() != 0) {
+    ipc_manager->ReleaseSendCredit(
+        run_ctx->future_.GetFutureShm().ptr_,
+        assigned_lane_ ? assigned_lane_->Size() : 0);
   }
 
   // Fire-and-forget: skip all response paths, just delete the task
@@ -963,64 +1169,76 @@ void Worker::EndTask(const FullPtr<Task> &task_ptr, RunContext *run_ctx,
                            shm_send_transport_.get());
 }
 
+void Worker::RecordTaskLatency(const FullPtr<Task> &task_ptr,
+                               RunContext *run_ctx) {
+  // Read submit_ns_ before any response path can release the FutureShm
+  auto future_shm = run_ctx->future_.GetFutureShm();
+  u64 submit_ns = future_shm.IsNull() ? 0 : future_shm->submit_ns_;
+  task_latency_.RecordTask(task_ptr->pool_id_, task_ptr->method_, submit_ns,
+                           run_ctx->pop_ns_, run_ctx->start_ns_,
+                           TaskLatencyStats::Now(),
+                           static_cast<u64>(run_ctx->wall_timer_.GetNsec()));
+}
+
 void Worker::ProcessBlockedQueue(std::queue<RunContext *> &queue,
                                  u32 queue_idx) {
   (void)queue_idx;  // Unused parameter, kept for API consistency
 
-  // Process only first 8 tasks in the queue
-  size_t queue_size = queue.size();
-  size_t check_limit = std::min(queue_size, size_t(8));
-
-  for (size_t i = 0; i < check_limit; i++) {
-    if (queue.empty()) {
-      break;
-    }
-
-    RunContext *run_ctx = queue.front();
+  // Take only the first 8 tasks in the queue
+  constexpr size_t kCheckLimit = 8;
+  RunContext *window[kCheckLimit];
+  size_t count = 0;
+  while (count < kCheckLimit && !queue.empty()) {
+    window[count++] = queue.front();
     queue.pop();
+  }
 
-    if (!run_ctx || run_ctx->task_.IsNull()) {
-      // Invalid entry, don't re-add
-      continue;
-    }
-
-    // Determine if this is a resume (task was started before) or first
-    // execution
-    bool is_started = run_ctx->task_->task_flags_.Any(TASK_STARTED);
-
-    // Skip if task was started but coroutine already completed
-    // This can happen with orphan events from parallel subtasks
-    if (is_started &&
-        (!run_ctx->coro_handle_ || run_ctx->coro_handle_.done())) {
-      continue;
-    }
+  // Resume high-priority tasks first, then the rest in FIFO order
+  for (int pass = 0; pass < 2; ++pass) {
+    bool want_high = (pass == 0);
+    for (size_t i = 0; i < count; i++) {
+      RunContext *run_ctx = window[i];
+      if (!run_ctx) {
+        continue;
+      }
+      if (run_ctx->task_.IsNull()) {
+        // Invalid entry, don't re-add
+        window[i] = nullptr;
+        continue;
+      }
+      if (run_ctx->task_->IsHighPriority() != want_high) {
+        continue;
+      }
+      window[i] = nullptr;
 
-    run_ctx->yield_count_ = 0;
+      // Determine if this is a resume (task was started before) or first
+      // execution
+      bool is_started = run_ctx->task_->task_flags_.Any(TASK_STARTED);
 
-    // CRITICAL: Clear the is_yielded_ flag before resuming the task
-    // This allows the task to call Wait() again if needed
-    run_ctx->is_yielded_ = false;
+      // Skip if task was started but coroutine already completed
+      // This can happen with orphan events from parallel subtasks
+      if (is_started &&
+          (!run_ctx->coro_handle_ || run_ctx->coro_handle_.done())) {
+        continue;
+      }
 
-    // Execute task with existing RunContext
-    ExecTask(run_ctx->task_, run_ctx, is_started);
+      run_ctx->yield_count_ = 0;
 
-    // Don't re-add to queue
-    continue;
+      // CRITICAL: Clear the is_yielded_ flag before resuming the task
+      // This allows the task to call Wait() again if needed
+      run_ctx->is_yielded_ = false;
 
-    // Re-add to appropriate blocked queue based on current block count
-    // AddToBlockedQueue will increment yield_count_ and determine the queue
-    AddToBlockedQueue(run_ctx);
+      // Execute task with existing RunContext. If it blocks again,
+      // ExecTask re-adds it through AddToBlockedQueue
+      ExecTask(run_ctx->task_, run_ctx, is_started);
+    }
   }
 }
 
-void Worker::ProcessPeriodicQueue(std::queue<RunContext *> &queue,
-                                  u32 queue_idx) {
-  (void)queue_idx;  // Unused parameter, kept for API consistency
-
-  // Check up to 8 tasks from the queue
-  size_t check_limit = 8;
-  size_t queue_size = queue.size();
-  size_t actual_limit = std::min(queue_size, check_limit);
+void Worker::ProcessPeriodicTimers() {
+  if (periodic_timers_.Empty()) {
+    return;
+  }
 
   // Capture SINGLE timestamp for ALL tasks processed in this batch
   // This prevents timestamp desynchronization between tasks with same
@@ -1028,53 +1246,47 @@ void Worker::ProcessPeriodicQueue(std::queue<RunContext *> &queue,
   hshm::Timepoint batch_timestamp;
   batch_timestamp.Now();
 
-  // Get current time for all checks
-  for (size_t i = 0; i < actual_limit; i++) {
-    if (queue.empty()) {
-      break;
-    }
-
-    RunContext *run_ctx = queue.front();
-    queue.pop();
+  // Collect the due tasks first: resuming one may re-arm it in the wheel
+  std::vector<RunContext *> due;
+  due.swap(due_timers_);
+  periodic_timers_.Advance(TimerNowUs(batch_timestamp),
+                           [&due](RunContext *run_ctx, u64) {
+                             due.push_back(run_ctx);
+                           });
 
+  for (RunContext *run_ctx : due) {
     if (!run_ctx || run_ctx->task_.IsNull()) {
       // Invalid entry, don't re-add
       continue;
     }
 
-    // Check if the time threshold has been surpassed using batch timestamp
-    // Add 2ms tolerance to account for timing variance and ms/us precision
-    // mismatch
-    double elapsed_us = run_ctx->block_start_.GetUsecFromStart(batch_timestamp);
-    if (elapsed_us + 2000.0 >= run_ctx->yield_time_us_) {
-      // Time threshold reached (within tolerance) - execute the task
-      bool is_started = run_ctx->task_->task_flags_.Any(TASK_STARTED);
+    bool is_started = run_ctx->task_->task_flags_.Any(TASK_STARTED);
 
-      // CRITICAL: Clear the is_yielded_ flag before resuming the task
-      // This allows the task to call Wait() again if needed
-      run_ctx->is_yielded_ = false;
+    // CRITICAL: Clear the is_yielded_ flag before resuming the task
+    // This allows the task to call Wait() again if needed
+    run_ctx->is_yielded_ = false;
 
-      // For periodic tasks, unmark TASK_ROUTED and route again
-      run_ctx->task_->ClearFlags(TASK_ROUTED);
-      Container *container = run_ctx->container_;
+    // For periodic tasks, unmark TASK_ROUTED and route again
+    run_ctx->task_->ClearFlags(TASK_ROUTED);
+    Container *container = run_ctx->container_;
 
-      // Use batch timestamp for rescheduling to prevent desynchronization
-      // This ensures all tasks in this batch get the same block_start time
-      run_ctx->block_start_ = batch_timestamp;
+    // Use batch timestamp for rescheduling to prevent desynchronization
+    // This ensures all tasks in this batch get the same block_start time
+    run_ctx->block_start_ = batch_timestamp;
 
-      // Route task again - this will handle both local and distributed routing
-      // RouteTask handles Retry/Dne internally via AddToRetryQueue
-      if (CHI_IPC->RouteTask(run_ctx->future_) == RouteResult::ExecHere) {
-        ExecTask(run_ctx->task_, run_ctx, is_started);
+    // Route task again - this will handle both local and distributed routing
+    // RouteTask handles Retry/Dne internally via AddToRetryQueue
+    if (CHI_IPC->RouteTask(run_ctx->future_) == RouteResult::ExecHere) {
+      ExecTask(run_ctx->task_, run_ctx, is_started);
 
-        // If task re-yielded with a polling interval, ExecTask already
-        // re-added it to the periodic queue via AddToBlockedQueue.
-      }
-    } else {
-      // Time threshold not reached yet - re-add to same queue
-      queue.push(run_ctx);
+      // If task re-yielded with a polling interval, ExecTask already
+      // re-armed its timer via AddToBlockedQueue.
     }
   }
+
+  // Keep the vector's capacity for the next batch
+  due.clear();
+  due_timers_.swap(due);
 }
 
 void Worker::ProcessEventQueue() {
@@ -1128,10 +1340,8 @@ void Worker::ContinueBlockedTasks(bool force) {
     for (u32 i = 0; i < NUM_BLOCKED_QUEUES; ++i) {
       ProcessBlockedQueue(blocked_queues_[i], i);
     }
-    // Also process all periodic queues in force mode
-    for (u32 i = 0; i < NUM_PERIODIC_QUEUES; ++i) {
-      ProcessPeriodicQueue(periodic_queues_[i], i);
-    }
+    // Also fire all due periodic timers in force mode
+    ProcessPeriodicTimers();
   } else {
     // Normal mode: check blocked queues based on iteration count
     // blocked_queues_[0] every 2 iterations
@@ -1154,25 +1364,10 @@ void Worker::ContinueBlockedTasks(bool force) {
       ProcessBlockedQueue(blocked_queues_[3], 3);
     }
 
-    // Process periodic queues with different checking frequencies
-    // periodic_queues_[0] (<=50us) every 4 iterations
+    // Periodic timers every 4 iterations; firing nothing costs one
+    // clock read, whatever the number of periodic tasks
     if (iteration_count_ % 4 == 0) {
-      ProcessPeriodicQueue(periodic_queues_[0], 0);
-    }
-
-    // periodic_queues_[1] (<=200us) every 8 iterations
-    if (iteration_count_ % 8 == 0) {
-      ProcessPeriodicQueue(periodic_queues_[1], 1);
-    }
-
-    // periodic_queues_[2] (<=50ms) every 64 iterations
-    if (iteration_count_ % 64 == 0) {
-      ProcessPeriodicQueue(periodic_queues_[2], 2);
-    }
-
-    // periodic_queues_[3] (>50ms) every 128 iterations
-    if (iteration_count_ % 128 == 0) {
-      ProcessPeriodicQueue(periodic_queues_[3], 3);
+      ProcessPeriodicTimers();
     }
   }
 }
@@ -1188,7 +1383,7 @@ void Worker::AddToBlockedQueue(RunContext *run_ctx, bool wait_for_task) {
     return;
   }
 
-  // Check if task should go to blocked queue or periodic queue
+  // Check if task should go to blocked queue or periodic timer
   // Go to blocked queue if: block_time is 0 OR task is already started
   if (run_ctx->yield_time_us_ == 0.0) {
     // Cooperative task waiting for subtasks - add to blocked queue
@@ -1200,8 +1395,9 @@ void Worker::AddToBlockedQueue(RunContext *run_ctx, bool wait_for_task) {
     // Queue[1]: Tasks blocked <= 4 times (checked every % 4 iterations)
     // Queue[2]: Tasks blocked <= 8 times (checked every % 8 iterations)
     // Queue[3]: Tasks blocked > 8 times (checked every % 16 iterations)
+    // High-priority tasks stay in Queue[0] so they never back off
     u32 queue_idx;
-    if (run_ctx->yield_count_ <= 2) {
+    if (run_ctx->yield_count_ <= 2 || run_ctx->task_->IsHighPriority()) {
       queue_idx = 0;
     } else if (run_ctx->yield_count_ <= 4) {
       queue_idx = 1;
@@ -1214,7 +1410,7 @@ void Worker::AddToBlockedQueue(RunContext *run_ctx, bool wait_for_task) {
     // Add to the appropriate blocked queue
     blocked_queues_[queue_idx].push(run_ctx);
   } else {
-    // Time-based periodic task - add to periodic queue
+    // Time-based periodic task - arm its timer
     // Record the time when task was blocked (if not already set recently)
     // Check if timestamp was set within last 10ms (indicates batch processing)
     double elapsed_since_block_us = run_ctx->block_start_.GetUsecFromStart();
@@ -1225,24 +1421,9 @@ void Worker::AddToBlockedQueue(RunContext *run_ctx, bool wait_for_task) {
     // else: timestamp is fresh (< 10ms old), keep it to maintain
     // synchronization
 
-    // Determine which periodic queue based on yield_time_us_:
-    // Queue[0]: yield_time_us_ <= 50us
-    // Queue[1]: yield_time_us_ <= 200us
-    // Queue[2]: yield_time_us_ <= 50ms (50000us)
-    // Queue[3]: yield_time_us_ > 50ms
-    u32 queue_idx;
-    if (run_ctx->yield_time_us_ <= 50.0) {
-      queue_idx = 0;
-    } else if (run_ctx->yield_time_us_ <= 200.0) {
-      queue_idx = 1;
-    } else if (run_ctx->yield_time_us_ <= 50000.0) {
-      queue_idx = 2;
-    } else {
-      queue_idx = 3;
-    }
-
-    // Add to the appropriate periodic queue
-    periodic_queues_[queue_idx].push(run_ctx);
+    u64 deadline_us = TimerNowUs(run_ctx->block_start_) +
+                      static_cast<u64>(run_ctx->yield_time_us_);
+    periodic_timers_.Schedule(run_ctx, deadline_us);
   }
 }
 
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+#include "chimaera/worker_affinity.h"
+
+#include <sched.h>
+
+#include <algorithm>
+
+#include "hermes_shm/introspect/system_info.h"
+
+namespace chi {
+
+AffinityPolicy WorkerAffinityPlanner::ParsePolicy(const std::string &name) {
+  if (name == "none") {
+    return AffinityPolicy::kNone;
+  }
+  if (name == "device") {
+    return AffinityPolicy::kDevice;
+  }
+  return AffinityPolicy::kAny;
+}
+
+std::vector<AffinityCpu> WorkerAffinityPlanner::ReadTopology() {
+  std::vector<AffinityCpu> cpus;
+  auto *sys_info = HSHM_SYSTEM_INFO;
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  bool have_mask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+  for (int cpu = 0; cpu < sys_info->ncpu_; ++cpu) {
+    if (have_mask && cpu < CPU_SETSIZE && !CPU_ISSET(cpu, &allowed)) {
+      continue;
+    }
+    std::vector<int> siblings = hshm::SystemInfo::GetCpuSiblings(cpu);
+    int first = *std::min_element(siblings.begin(), siblings.end());
+    cpus.push_back({cpu, sys_info->GetNumaNodeOfCpu(cpu), first == cpu});
+  }
+  return cpus;
+}
+
+std::vector<int> WorkerAffinityPlanner::Plan(
+    const std::vector<AffinityCpu> &cpus, const std::vector<int> &nodes,
+    bool use_siblings) {
+  std::vector<int> plan(nodes.size(), kUnpinned);
+  std::vector<bool> taken(cpus.size(), false);
+  auto take = [&](size_t worker, bool match_node) {
+    for (size_t i = 0; i < cpus.size(); ++i) {
+      if (taken[i] || (!use_siblings && !cpus[i].primary_) ||
+          (match_node && cpus[i].node_ != nodes[worker])) {
+        continue;
+      }
+      taken[i] = true;
+      plan[worker] = cpus[i].cpu_;
+      return;
+    }
+  };
+  for (size_t worker = 0; worker < nodes.size(); ++worker) {
+    if (nodes[worker] >= 0) {
+      take(worker, true);
+    }
+  }
+  for (size_t worker = 0; worker < nodes.size(); ++worker) {
+    if (nodes[worker] != kNoPin && plan[worker] == kUnpinned) {
+      take(worker, false);
+    }
+  }
+  return plan;
+}
+
+}  // namespace chi
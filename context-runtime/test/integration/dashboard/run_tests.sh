@@ -200,6 +200,25 @@ run_tests() {
         "entries" \
         "1"
 
+    # --- Test 3b: Sampled worker counters for node 0 ---
+    assert_curl \
+        "GET /api/node/0/worker_samples returns entries" \
+        "$DASHBOARD_URL/api/node/0/worker_samples" \
+        "GET" \
+        "entries" \
+        "1"
+
+    # --- Test 3c: Streamed stats from the subscription ---
+    # The first request starts the subscription thread
+    curl -s --max-time 10 "$DASHBOARD_URL/api/live" > /dev/null 2>&1 || true
+    sleep 3
+    assert_curl \
+        "GET /api/live returns nodes" \
+        "$DASHBOARD_URL/api/live" \
+        "GET" \
+        "nodes" \
+        "1"
+
     # --- Test 4: Shutdown node 3 (last node, 0-indexed) ---
     # Find the highest node_id from topology
     local last_node_id
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+/**
+ * Unit tests for the pool that runs blocking ChiMod calls.
+ * Exercise BlockingPool directly without starting a runtime.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include "simple_test.h"
+#include "chimaera/blocking_pool.h"
+
+using chi::BlockingPool;
+
+namespace {
+
+/** Spin until a job finishes or two seconds pass */
+bool WaitDone(const std::shared_ptr<BlockingPool::Job> &job) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  while (!job->done_.load()) {
+    if (std::chrono::steady_clock::now() > deadline) return false;
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST_CASE("BlockingPool: disabled pool rejects jobs", "[blocking_pool]") {
+  BlockingPool pool;
+  REQUIRE_FALSE(pool.IsEnabled());
+  REQUIRE(pool.Submit([]() {}) == nullptr);
+  pool.Start(0, 16);
+  REQUIRE_FALSE(pool.IsEnabled());
+}
+
+TEST_CASE("BlockingPool: jobs run off the calling thread", "[blocking_pool]") {
+  BlockingPool pool;
+  pool.Start(2, 16);
+  REQUIRE(pool.GetNumThreads() == 2);
+  std::thread::id caller = std::this_thread::get_id();
+  std::thread::id ran_on;
+  auto job = pool.Submit([&]() { ran_on = std::this_thread::get_id(); });
+  REQUIRE(job != nullptr);
+  REQUIRE(WaitDone(job));
+  REQUIRE(ran_on != caller);
+}
+
+TEST_CASE("BlockingPool: queue is bounded and drained on stop",
+          "[blocking_pool]") {
+  BlockingPool pool;
+  pool.Start(1, 2);
+  std::atomic<bool> release{false};
+  std::atomic<int> ran{0};
+  auto gate = pool.Submit([&]() {
+    while (!release.load()) std::this_thread::yield();
+    ran++;
+  });
+  REQUIRE(gate != nullptr);
+  // Wait for the thread to take the gate job so the queue is empty
+  while (pool.GetQueuedCount() != 0) std::this_thread::yield();
+  auto a = pool.Submit([&]() { ran++; });
+  auto b = pool.Submit([&]() { ran++; });
+  REQUIRE(a != nullptr);
+  REQUIRE(b != nullptr);
+  REQUIRE(pool.Submit([&]() { ran++; }) == nullptr);
+  release.store(true);
+  pool.Stop();
+  REQUIRE(ran.load() == 3);
+  REQUIRE(a->done_.load());
+  REQUIRE(b->done_.load());
+  REQUIRE_FALSE(pool.IsEnabled());
+}
+
+TEST_CASE("BlockingPool: a throwing job still completes", "[blocking_pool]") {
+  BlockingPool pool;
+  pool.Start(1, 4);
+  auto job = pool.Submit([]() { throw std::runtime_error("boom"); });
+  REQUIRE(job != nullptr);
+  REQUIRE(WaitDone(job));
+}
+
+SIMPLE_TEST_MAIN()
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * Unit tests for per-client admission credits.
+ * Exercise ClientCreditTable directly without starting a runtime.
+ */
+
+#include <unistd.h>
+
+#include <memory>
+
+#include "simple_test.h"
+#include "chimaera/client_credits.h"
+
+using chi::ClientCreditTable;
+
+namespace {
+std::unique_ptr<ClientCreditTable> MakeTable(chi::u32 max_window,
+                                             chi::u32 congested_depth) {
+  auto table = std::make_unique<ClientCreditTable>();
+  table->Init(max_window, congested_depth);
+  return table;
+}
+}  // namespace
+
+TEST_CASE("ClientCredits: client stops at its window", "[client_credits]") {
+  auto table = MakeTable(16, 8);
+  chi::u32 slot = table->Claim(1234);
+  REQUIRE(slot < ClientCreditTable::kNumSlots);
+  for (int i = 0; i < 16; ++i) {
+    REQUIRE(table->TryAcquire(slot));
+  }
+  REQUIRE_FALSE(table->TryAcquire(slot));
+  table->Release(slot, 0);
+  REQUIRE(table->TryAcquire(slot));
+  REQUIRE(table->GetSlot(slot).inflight_.load() == 16);
+}
+
+TEST_CASE("ClientCredits: congestion shrinks and drain regrows the window",
+          "[client_credits]") {
+  auto table = MakeTable(64, 8);
+  chi::u32 slot = table->Claim(1234);
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(table->TryAcquire(slot));
+  }
+  // Deep lanes cut the window by a quarter per completion, down to the floor
+  table->Release(slot, 100);
+  REQUIRE(table->GetSlot(slot).window_.load() == 48);
+  for (int i = 0; i < 9; ++i) {
+    table->Release(slot, 100);
+  }
+  REQUIRE(table->GetSlot(slot).window_.load() == ClientCreditTable::kMinWindow);
+  REQUIRE(table->GetSlot(slot).inflight_.load() == 0);
+
+  // Fast drains grow it back one credit at a time, capped at the maximum
+  for (int i = 0; i < 200; ++i) {
+    REQUIRE(table->TryAcquire(slot));
+    table->Release(slot, 0);
+  }
+  REQUIRE(table->GetSlot(slot).window_.load() == 64);
+}
+
+TEST_CASE("ClientCredits: refunds and stray releases never underflow",
+          "[client_credits]") {
+  auto table = MakeTable(16, 8);
+  chi::u32 slot = table->Claim(1234);
+  REQUIRE(table->TryAcquire(slot));
+  table->Refund(slot);
+  table->Refund(slot);
+  table->Release(slot, 0);
+  REQUIRE(table->GetSlot(slot).inflight_.load() == 0);
+  REQUIRE(table->GetSlot(slot).window_.load() == 16);
+  // Out-of-range slots (no credit taken) are ignored
+  table->Release(ClientCreditTable::kNumSlots, 0);
+}
+
+TEST_CASE("ClientCredits: slots are reused by PID and reclaimed from exited "
+          "clients", "[client_credits]") {
+  auto table = MakeTable(16, 8);
+  chi::u32 a = table->Claim(7);
+  REQUIRE(table->TryAcquire(a));
+  // Same PID again (restarted client): same slot, credits reset
+  REQUIRE(table->Claim(7) == a);
+  REQUIRE(table->GetSlot(a).inflight_.load() == 0);
+
+  // Another PID hashing to the same slot probes to the next one
+  chi::u32 b = table->Claim(7 + ClientCreditTable::kNumSlots);
+  REQUIRE(b != a);
+  table->Unclaim(b);
+  REQUIRE(table->GetSlot(b).pid_.load() == 0);
+
+  // A table full of exited owners (PIDs above any pid_max) still admits
+  auto full = MakeTable(16, 8);
+  constexpr chi::u32 kDeadPid = 0x7fff0000;
+  for (chi::u32 i = 0; i < ClientCreditTable::kNumSlots; ++i) {
+    REQUIRE(full->Claim(kDeadPid + i) < ClientCreditTable::kNumSlots);
+  }
+  chi::u32 live = full->Claim(static_cast<chi::u32>(getpid()));
+  REQUIRE(live < ClientCreditTable::kNumSlots);
+  REQUIRE(full->GetSlot(live).pid_.load() ==
+          static_cast<chi::u32>(getpid()));
+}
+
+SIMPLE_TEST_MAIN()
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+/**
+ * Unit tests for the TaskResume coroutine frame pool.
+ * Exercise CoroFramePool directly and through TaskResume coroutines without
+ * starting a runtime.
+ */
+
+#include <thread>
+#include <vector>
+
+#include "simple_test.h"
+#include "chimaera/coro_frame_pool.h"
+#include "chimaera/task.h"
+
+using chi::CoroFramePool;
+using chi::CoroFrameStats;
+
+namespace {
+
+/** Coroutine that finishes on its first resume */
+chi::TaskResume TrivialCoroutine(int *counter) {
+  *counter += 1;
+  co_return;
+}
+
+/** Coroutine awaiting another, like CHI_CO_AWAIT of a nested method */
+chi::TaskResume NestedCoroutine(int *counter) {
+  co_await TrivialCoroutine(counter);
+  *counter += 1;
+  co_return;
+}
+
+}  // namespace
+
+TEST_CASE("CoroFramePool: size classes", "[coro_frame_pool]") {
+  REQUIRE(CoroFramePool::ClassOf(1) == 0);
+  REQUIRE(CoroFramePool::ClassOf(64) == 0);
+  REQUIRE(CoroFramePool::ClassOf(65) == 1);
+  REQUIRE(CoroFramePool::ClassOf(128) == 1);
+  REQUIRE(CoroFramePool::ClassOf(CoroFramePool::kMaxClassSize) ==
+          CoroFramePool::kNumClasses - 1);
+  REQUIRE(CoroFramePool::ClassOf(CoroFramePool::kMaxClassSize + 1) ==
+          CoroFramePool::kNumClasses);
+  for (chi::u32 cls = 0; cls < CoroFramePool::kNumClasses; ++cls) {
+    REQUIRE(CoroFramePool::ClassOf(CoroFramePool::ClassSize(cls)) == cls);
+  }
+}
+
+TEST_CASE("CoroFramePool: released frames are reused", "[coro_frame_pool]") {
+  CoroFrameStats before = CoroFramePool::GetThreadStats();
+  void *a = CoroFramePool::Allocate(200);
+  REQUIRE(a != nullptr);
+  REQUIRE(reinterpret_cast<uintptr_t>(a) % alignof(std::max_align_t) == 0);
+  memset(a, 0xab, 200);
+  CoroFramePool::Free(a);
+  // Any size in the same class gets the cached frame back
+  void *b = CoroFramePool::Allocate(256);
+  REQUIRE(b == a);
+  CoroFramePool::Free(b);
+
+  CoroFrameStats after = CoroFramePool::GetThreadStats();
+  REQUIRE(after.allocs_[2] - before.allocs_[2] == 2);
+  REQUIRE(after.pool_hits_ - before.pool_hits_ == 1);
+  REQUIRE(after.frees_ - before.frees_ == 2);
+  REQUIRE(after.max_frame_size_ >= 256);
+  REQUIRE(after.cached_frames_ >= 1);
+}
+
+TEST_CASE("CoroFramePool: large frames bypass the pool",
+          "[coro_frame_pool]") {
+  CoroFrameStats before = CoroFramePool::GetThreadStats();
+  size_t size = CoroFramePool::kMaxClassSize * 2;
+  void *a = CoroFramePool::Allocate(size);
+  memset(a, 0, size);
+  CoroFramePool::Free(a);
+  CoroFrameStats after = CoroFramePool::GetThreadStats();
+  REQUIRE(after.allocs_[CoroFramePool::kNumClasses] -
+              before.allocs_[CoroFramePool::kNumClasses] ==
+          1);
+  REQUIRE(after.pool_hits_ == before.pool_hits_);
+  REQUIRE(after.cached_frames_ == before.cached_frames_);
+  REQUIRE(after.max_frame_size_ >= size);
+}
+
+TEST_CASE("CoroFramePool: free lists are bounded", "[coro_frame_pool]") {
+  std::vector<void *> frames;
+  for (chi::u32 i = 0; i < CoroFramePool::kMaxCachedPerClass + 16; ++i) {
+    frames.push_back(CoroFramePool::Allocate(4000));
+  }
+  CoroFrameStats before = CoroFramePool::GetThreadStats();
+  for (void *frame : frames) {
+    CoroFramePool::Free(frame);
+  }
+  CoroFrameStats after = CoroFramePool::GetThreadStats();
+  REQUIRE(after.cached_frames_ - before.cached_frames_ <=
+          CoroFramePool::kMaxCachedPerClass);
+}
+
+TEST_CASE("CoroFramePool: frames freed on another thread",
+          "[coro_frame_pool]") {
+  std::vector<void *> frames;
+  for (int i = 0; i < 64; ++i) {
+    frames.push_back(CoroFramePool::Allocate(100));
+  }
+  CoroFrameStats before = CoroFramePool::CollectStats();
+  std::thread releaser([&frames]() {
+    for (void *frame : frames) {
+      CoroFramePool::Free(frame);
+    }
+    // Reuse one on this thread before it exits
+    CoroFramePool::Free(CoroFramePool::Allocate(100));
+  });
+  releaser.join();
+  CoroFrameStats after = CoroFramePool::CollectStats();
+  // The exited thread's counters are kept, its cached frames are released
+  REQUIRE(after.frees_ - before.frees_ == 65);
+  REQUIRE(after.pool_hits_ - before.pool_hits_ >= 1);
+  REQUIRE(after.cached_frames_ <= before.cached_frames_);
+}
+
+TEST_CASE("CoroFramePool: TaskResume frames come from the pool",
+          "[coro_frame_pool]") {
+  int counter = 0;
+  CoroFrameStats before = CoroFramePool::GetThreadStats();
+  for (int i = 0; i < 10; ++i) {
+    chi::TaskResume coro = NestedCoroutine(&counter);
+    coro.resume();
+    REQUIRE(coro.done());
+  }
+  CoroFrameStats after = CoroFramePool::GetThreadStats();
+  REQUIRE(counter == 20);
+  // Up to two frames per run (the compiler may elide the inner one); every
+  // run after the first reuses freed frames
+  chi::u64 allocs = after.Allocs() - before.Allocs();
+  REQUIRE(allocs >= 10);
+  REQUIRE(allocs <= 20);
+  REQUIRE(after.frees_ - before.frees_ == allocs);
+  REQUIRE(after.pool_hits_ - before.pool_hits_ >= allocs - 2);
+}
+
+SIMPLE_TEST_MAIN()
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Unit tests for the runtime expiry wheel as workers use it for periodic
+ * tasks. Exercise ExpiryWheel directly with fake task pointers and a fake
+ * clock.
+ */
+
+#include <vector>
+
+#include "simple_test.h"
+#include "chimaera/expiry_wheel.h"
+
+namespace chi {
+struct RunContext;
+}  // namespace chi
+
+using chi::ExpiryWheel;
+using chi::RunContext;
+using chi::u64;
+
+using Wheel = ExpiryWheel<RunContext *>;
+
+/** Distinct fake task pointer; the wheel never dereferences them */
+static RunContext *Ctx(size_t id) {
+  return reinterpret_cast<RunContext *>(id * 64 + 64);
+}
+
+/** Advance the wheel, appending due tasks to out */
+static size_t Expire(Wheel &wheel, u64 now, std::vector<RunContext *> &out) {
+  return wheel.Advance(now, [&out](RunContext *run_ctx, u64) {
+    out.push_back(run_ctx);
+  });
+}
+
+TEST_CASE("ExpiryWheel: empty wheel has no deadline", "[expiry_wheel]") {
+  Wheel wheel(16, 64);
+  std::vector<RunContext *> due;
+  REQUIRE(wheel.Empty());
+  REQUIRE(wheel.NextDeadline() == Wheel::kNoDeadline);
+  REQUIRE(Expire(wheel, 1000000, due) == 0);
+  REQUIRE(due.empty());
+}
+
+TEST_CASE("ExpiryWheel: fires at the deadline, never before",
+          "[expiry_wheel]") {
+  Wheel wheel(16, 64);
+  std::vector<RunContext *> due;
+  wheel.Schedule(Ctx(1), 100);
+  REQUIRE(wheel.Size() == 1);
+  REQUIRE(wheel.NextDeadline() == 100);
+  REQUIRE(Expire(wheel, 99, due) == 0);
+  REQUIRE(Expire(wheel, 100, due) == 1);
+  REQUIRE(due.size() == 1);
+  REQUIRE(due[0] == Ctx(1));
+  REQUIRE(wheel.Empty());
+}
+
+TEST_CASE("ExpiryWheel: next deadline looks past far revolutions",
+          "[expiry_wheel]") {
+  Wheel wheel(1, 64);
+  std::vector<RunContext *> due;
+  // Out of order, most of them several revolutions away
+  std::vector<u64> deadlines = {70000000, 50, 300000, 5000, 20000000};
+  for (size_t i = 0; i < deadlines.size(); ++i) {
+    wheel.Schedule(Ctx(i), deadlines[i]);
+  }
+  // A sleeping worker jumps straight to each reported deadline
+  std::vector<RunContext *> expected = {Ctx(1), Ctx(3), Ctx(2), Ctx(4),
+                                        Ctx(0)};
+  for (RunContext *run_ctx : expected) {
+    u64 next = wheel.NextDeadline();
+    REQUIRE(next != Wheel::kNoDeadline);
+    REQUIRE(Expire(wheel, next - 1, due) == 0);
+    REQUIRE(Expire(wheel, next, due) == 1);
+    REQUIRE(due.back() == run_ctx);
+  }
+  REQUIRE(wheel.Empty());
+}
+
+TEST_CASE("ExpiryWheel: one late Advance collects everything due",
+          "[expiry_wheel]") {
+  Wheel wheel(16, 4096);
+  std::vector<RunContext *> due;
+  for (size_t i = 0; i < 1000; ++i) {
+    wheel.Schedule(Ctx(i), 50 + i * 1000);
+  }
+  REQUIRE(Expire(wheel, 500000, due) == 500);
+  REQUIRE(wheel.Size() == 500);
+  REQUIRE(wheel.NextDeadline() == 500050);
+  REQUIRE(Expire(wheel, 2000000, due) == 500);
+  REQUIRE(due.size() == 1000);
+}
+
+TEST_CASE("ExpiryWheel: past deadlines fire on the next Advance",
+          "[expiry_wheel]") {
+  Wheel wheel(16, 64);
+  std::vector<RunContext *> due;
+  Expire(wheel, 10000, due);
+  wheel.Schedule(Ctx(1), 5000);
+  REQUIRE(wheel.NextDeadline() == 5000);
+  REQUIRE(Expire(wheel, 10001, due) == 1);
+  REQUIRE(due[0] == Ctx(1));
+}
+
+TEST_CASE("ExpiryWheel: rescheduling from a fired batch", "[expiry_wheel]") {
+  Wheel wheel(16, 4096);
+  std::vector<RunContext *> due;
+  // A 50ms periodic task re-armed from its firing time for 100 periods
+  wheel.Schedule(Ctx(1), 50000);
+  for (int period = 1; period <= 100; ++period) {
+    u64 now = wheel.NextDeadline();
+    REQUIRE(now == static_cast<u64>(period) * 50000);
+    REQUIRE(Expire(wheel, now, due) == 1);
+    wheel.Schedule(due.back(), now + 50000);
+  }
+  REQUIRE(wheel.Size() == 1);
+  wheel.Clear();
+  REQUIRE(wheel.Empty());
+  REQUIRE(wheel.NextDeadline() == Wheel::kNoDeadline);
+}
+
+SIMPLE_TEST_MAIN()
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Unit tests for the LocalScheduler's lane load tracking.
+ * Exercise LaneStatsTable directly without starting a runtime.
+ */
+
+#include <memory>
+
+#include "simple_test.h"
+#include "chimaera/lane_stats.h"
+
+using chi::LaneStatsTable;
+
+TEST_CASE("LaneStats: small imbalance keeps the sticky lane", "[lane_stats]") {
+  // Gap below the threshold
+  chi::u32 close[] = {150, 60, 200, 90};
+  REQUIRE(LaneStatsTable::PickLane(0, close, 4) == 0);
+  // Gap above the threshold, but the best lane is not 2x lighter
+  chi::u32 similar[] = {900, 600, 700, 800};
+  REQUIRE(LaneStatsTable::PickLane(0, similar, 4) == 0);
+  // Already on the lightest lane
+  chi::u32 light[] = {0, 500, 500, 500};
+  REQUIRE(LaneStatsTable::PickLane(0, light, 4) == 0);
+}
+
+TEST_CASE("LaneStats: overloaded lane moves to the lightest", "[lane_stats]") {
+  chi::u32 loads[] = {2000, 300, 50, 800};
+  REQUIRE(LaneStatsTable::PickLane(0, loads, 4) == 2);
+  REQUIRE(LaneStatsTable::PickLane(3, loads, 4) == 2);
+  // Out-of-range lanes are left alone
+  REQUIRE(LaneStatsTable::PickLane(7, loads, 4) == 7);
+}
+
+TEST_CASE("LaneStats: published loads drive remaps and counters",
+          "[lane_stats]") {
+  auto table = std::make_unique<LaneStatsTable>();
+  table->Init();
+  table->SetLoad(0, 1500.7f);
+  table->SetLoad(1, 20.0f);
+  table->SetLoad(2, -5.0f);
+  REQUIRE(table->GetLoad(0) == 1500);
+  REQUIRE(table->GetLoad(2) == 0);
+
+  chi::u32 next = table->PickLane(0, 2);
+  REQUIRE(next == 1);
+  table->RecordRemap(0, next);
+  REQUIRE(table->GetRemapsOut(0) == 1);
+  REQUIRE(table->GetRemapsIn(1) == 1);
+  REQUIRE(table->GetRemapsIn(0) == 0);
+
+  // Lanes past the table never remap
+  REQUIRE(table->PickLane(0, LaneStatsTable::kMaxLanes + 1) == 0);
+  table->SetLoad(LaneStatsTable::kMaxLanes, 100.0f);
+  REQUIRE(table->GetLoad(LaneStatsTable::kMaxLanes) == 0);
+}
+
+SIMPLE_TEST_MAIN()
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+/**
+ * Unit tests for the autogenerated method descriptor tables.
+ * Check Method::kMethodTraits and chi::MethodExec lookups without starting
+ * a runtime.
+ */
+
+#include "simple_test.h"
+#include "chimaera/admin/admin_tasks.h"
+#include "chimaera/admin/autogen/admin_methods.h"
+#include "chimaera/method_exec.h"
+
+namespace Method = chimaera::admin::Method;
+
+TEST_CASE("MethodTraits: admin network methods are declared",
+          "[method_traits]") {
+  static_assert(Method::GetMethodTraits(Method::kSend).IsNetwork());
+  REQUIRE(Method::GetMethodTraits(Method::kRecv).IsNetwork());
+  REQUIRE(Method::GetMethodTraits(Method::kClientRecv).IsNetwork());
+  REQUIRE(Method::GetMethodTraits(Method::kClientSend).IsNetwork());
+  REQUIRE_FALSE(Method::GetMethodTraits(Method::kFlush).IsNetwork());
+  REQUIRE(Method::GetMethodTraits(Method::kFlush).route_ ==
+          chi::MethodRoute::kDefault);
+}
+
+TEST_CASE("MethodTraits: gaps and out-of-range IDs are undefined",
+          "[method_traits]") {
+  REQUIRE(Method::GetMethodTraits(Method::kCreate).IsDefined());
+  REQUIRE(Method::GetMethodTraits(Method::kMonitor).IsDefined());
+  REQUIRE_FALSE(Method::GetMethodTraits(2).IsDefined());
+  REQUIRE_FALSE(Method::GetMethodTraits(17).IsDefined());
+  REQUIRE_FALSE(Method::GetMethodTraits(Method::kMaxMethodId).IsDefined());
+  REQUIRE_FALSE(Method::GetMethodTraits(0xFFFFFFFF).IsDefined());
+}
+
+TEST_CASE("MethodExec: table lookup returns typed entries",
+          "[method_traits]") {
+  constexpr chi::MethodExec kTable[3] = {
+      chi::MakeMethodExec<chimaera::admin::FlushTask>(),
+      {},
+      chi::MakeMethodExec<chimaera::admin::HeartbeatTask>(),
+  };
+
+  const chi::MethodExec *flush = chi::FindMethodExec(kTable, 0);
+  REQUIRE(flush != nullptr);
+  REQUIRE(flush->task_size_ == sizeof(chimaera::admin::FlushTask));
+  REQUIRE(flush->save_ != nullptr);
+  REQUIRE(flush->del_ != nullptr);
+
+  const chi::MethodExec *heartbeat = chi::FindMethodExec(kTable, 2);
+  REQUIRE(heartbeat != nullptr);
+  REQUIRE(heartbeat->task_size_ == sizeof(chimaera::admin::HeartbeatTask));
+
+  REQUIRE(chi::FindMethodExec(kTable, 1) == nullptr);
+  REQUIRE(chi::FindMethodExec(kTable, 3) == nullptr);
+}
+
+SIMPLE_TEST_MAIN()
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * Unit tests for the /metrics exposition writer and collector registry.
+ * Exercise MetricsWriter and MetricsRegistry without starting a runtime.
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <string>
+
+#include "simple_test.h"
+#include "chimaera/metrics.h"
+#include "chimaera/worker.h"
+
+using chi::MetricsRegistry;
+using chi::MetricsWriter;
+using chi::MetricType;
+
+namespace {
+
+/** Send one request to a loopback port and return the full response */
+std::string HttpGet(chi::u32 port, const std::string &request) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(static_cast<uint16_t>(port));
+  inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+  std::string response;
+  if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0) {
+    send(fd, request.data(), request.size(), 0);
+    char buf[1024];
+    ssize_t got;
+    while ((got = recv(fd, buf, sizeof(buf), 0)) > 0) {
+      response.append(buf, static_cast<size_t>(got));
+    }
+  }
+  close(fd);
+  return response;
+}
+
+/** Find a free loopback port by binding port 0 */
+chi::u32 FreePort() {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+  socklen_t len = sizeof(addr);
+  getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &len);
+  close(fd);
+  return ntohs(addr.sin_port);
+}
+
+}  // namespace
+
+TEST_CASE("MetricsWriter: Prometheus text format", "[metrics]") {
+  MetricsWriter w;
+  w.Family("chi_ops", MetricType::kCounter, "Operations");
+  w.Sample({{"worker", "0"}}, static_cast<chi::u64>(42));
+  w.Family("chi_depth", MetricType::kGauge, "Queue depth");
+  w.Sample({}, 1.5);
+  REQUIRE(w.Finish() ==
+          "# HELP chi_ops_total Operations\n"
+          "# TYPE chi_ops_total counter\n"
+          "chi_ops_total{worker=\"0\"} 42\n"
+          "# HELP chi_depth Queue depth\n"
+          "# TYPE chi_depth gauge\n"
+          "chi_depth 1.5\n");
+  REQUIRE(std::string(w.ContentType()).find("0.0.4") != std::string::npos);
+}
+
+TEST_CASE("MetricsWriter: OpenMetrics format and escaping", "[metrics]") {
+  MetricsWriter w(true);
+  w.Family("chi_ops", MetricType::kCounter, "Operations");
+  w.Sample({{"name", "a\"b\\c\nd"}}, static_cast<chi::u64>(1));
+  // Families without samples are omitted
+  w.Family("chi_empty", MetricType::kGauge, "Never sampled");
+  REQUIRE(w.Finish() ==
+          "# HELP chi_ops Operations\n"
+          "# TYPE chi_ops counter\n"
+          "chi_ops_total{name=\"a\\\"b\\\\c\\nd\"} 1\n"
+          "# EOF\n");
+  REQUIRE(std::string(w.ContentType()).find("openmetrics") !=
+          std::string::npos);
+}
+
+TEST_CASE("MetricsRegistry: collectors share families", "[metrics]") {
+  MetricsRegistry registry;
+  for (int pool = 0; pool < 2; ++pool) {
+    registry.Register("pool" + std::to_string(pool),
+                      [pool](MetricsWriter &w) {
+                        w.Family("cte_bytes", MetricType::kCounter, "Bytes");
+                        w.Sample({{"pool", std::to_string(pool)}},
+                                 static_cast<chi::u64>(pool + 10));
+                        w.Family("cte_ratio", MetricType::kGauge, "Ratio");
+                        w.Sample({{"pool", std::to_string(pool)}}, 2.0);
+                      });
+  }
+  std::string text = registry.Render(false);
+  // Both pools' samples sit under a single HELP/TYPE header
+  REQUIRE(text ==
+          "# HELP cte_bytes_total Bytes\n"
+          "# TYPE cte_bytes_total counter\n"
+          "cte_bytes_total{pool=\"0\"} 10\n"
+          "cte_bytes_total{pool=\"1\"} 11\n"
+          "# HELP cte_ratio Ratio\n"
+          "# TYPE cte_ratio gauge\n"
+          "cte_ratio{pool=\"0\"} 2\n"
+          "cte_ratio{pool=\"1\"} 2\n");
+
+  // Re-registering a key replaces its collector; unregistering removes it
+  registry.Register("pool0", [](MetricsWriter &w) {
+    w.Family("cte_bytes", MetricType::kCounter, "Bytes");
+    w.Sample({{"pool", "0"}}, static_cast<chi::u64>(99));
+  });
+  registry.Unregister("pool1");
+  REQUIRE(registry.Render(false) ==
+          "# HELP cte_bytes_total Bytes\n"
+          "# TYPE cte_bytes_total counter\n"
+          "cte_bytes_total{pool=\"0\"} 99\n");
+}
+
+TEST_CASE("MetricsRegistry: HTTP endpoint", "[metrics]") {
+  MetricsRegistry registry;
+  registry.Register("test", [](MetricsWriter &w) {
+    w.Family("chi_up", MetricType::kGauge, "Always one");
+    w.Sample({}, static_cast<chi::u64>(1));
+  });
+  // Port 0 leaves the endpoint disabled
+  REQUIRE(registry.StartServer("127.0.0.1", 0));
+  REQUIRE_FALSE(registry.StartServer("not-an-address", FreePort()));
+
+  chi::u32 port = FreePort();
+  REQUIRE(registry.StartServer("127.0.0.1", port));
+
+  std::string ok = HttpGet(port, "GET /metrics HTTP/1.1\r\nHost: x\r\n\r\n");
+  REQUIRE(ok.rfind("HTTP/1.1 200 OK\r\n", 0) == 0);
+  REQUIRE(ok.find("text/plain; version=0.0.4") != std::string::npos);
+  REQUIRE(ok.find("\r\n\r\n# HELP chi_up Always one\n") != std::string::npos);
+  REQUIRE(ok.find("chi_up 1\n") != std::string::npos);
+
+  std::string om = HttpGet(port,
+                           "GET /metrics?x=1 HTTP/1.1\r\n"
+                           "Accept: application/openmetrics-text\r\n\r\n");
+  REQUIRE(om.find("application/openmetrics-text") != std::string::npos);
+  REQUIRE(om.find("# EOF\n") != std::string::npos);
+
+  std::string missing = HttpGet(port, "GET / HTTP/1.1\r\n\r\n");
+  REQUIRE(missing.rfind("HTTP/1.1 404", 0) == 0);
+  std::string post = HttpGet(port, "POST /metrics HTTP/1.1\r\n\r\n");
+  REQUIRE(post.rfind("HTTP/1.1 405", 0) == 0);
+
+  registry.StopServer();
+  REQUIRE(HttpGet(port, "GET /metrics HTTP/1.1\r\n\r\n").empty());
+}
+
+TEST_CASE("WorkerCounters: busy time and method slots", "[metrics]") {
+  chi::WorkerCounters c;
+  // Not started yet: no busy time
+  REQUIRE(c.BusyUs(1000) == 0);
+
+  c.start_us_.store(1000);
+  c.idle_cpu_us_.store(200);
+  c.sleep_us_.store(300);
+  REQUIRE(c.BusyUs(2000) == 500);
+  // Idle time larger than uptime clamps to zero
+  c.sleep_us_.store(5000);
+  REQUIRE(c.BusyUs(2000) == 0);
+
+  REQUIRE(chi::WorkerCounters::MethodSlot(0) == 0);
+  REQUIRE(chi::WorkerCounters::MethodSlot(44) == 44);
+  chi::u32 last = chi::WorkerCounters::kNumMethodSlots - 1;
+  REQUIRE(chi::WorkerCounters::MethodSlot(last) == last);
+  REQUIRE(chi::WorkerCounters::MethodSlot(1000) == last);
+
+  chi::WorkerCounters::Bump(c.resumes_);
+  chi::WorkerCounters::Bump(c.resumes_);
+  chi::WorkerCounters::Bump(c.method_tasks_[chi::WorkerCounters::MethodSlot(10)]);
+  REQUIRE(c.resumes_.load() == 2);
+  REQUIRE(c.method_tasks_[10].load() == 1);
+  REQUIRE(c.method_tasks_[11].load() == 0);
+}
+
+SIMPLE_TEST_MAIN()
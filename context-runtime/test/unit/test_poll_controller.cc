@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Unit tests for the worker idle-policy controller.
+ * Exercise PollController decisions directly without starting a runtime.
+ */
+
+#include "simple_test.h"
+#include "chimaera/poll_controller.h"
+
+using chi::PollAction;
+using chi::PollController;
+using chi::PollMode;
+
+TEST_CASE("PollController: sleep mode busy-waits then sleeps",
+          "[poll_controller]") {
+  PollController ctrl;
+  ctrl.Configure(PollMode::kSleep, 100, 0, 1000);
+  REQUIRE(ctrl.Decide(0) == PollAction::kBusy);
+  REQUIRE(ctrl.Decide(99) == PollAction::kBusy);
+  REQUIRE(ctrl.Decide(100) == PollAction::kSleep);
+}
+
+TEST_CASE("PollController: busy mode never sleeps", "[poll_controller]") {
+  PollController ctrl;
+  ctrl.Configure(PollMode::kBusy, 100, 0, 1000);
+  REQUIRE(ctrl.Decide(1e9) == PollAction::kBusy);
+}
+
+TEST_CASE("PollController: adaptive sleeps at once for rare arrivals",
+          "[poll_controller]") {
+  PollController ctrl;
+  ctrl.Configure(PollMode::kAdaptive, 100, 0, 1000);
+  // Idle gaps far above first_busy_wait: polling would only burn CPU
+  for (int i = 0; i < 20; ++i) {
+    ctrl.RecordArrival(10000);
+  }
+  REQUIRE(ctrl.GetStats().poll_window_us_ == 0);
+  REQUIRE(ctrl.Decide(0) == PollAction::kSleep);
+}
+
+TEST_CASE("PollController: adaptive polls through dense arrivals",
+          "[poll_controller]") {
+  PollController ctrl;
+  ctrl.Configure(PollMode::kAdaptive, 100, 0, 1000);
+  for (int i = 0; i < 20; ++i) {
+    ctrl.RecordArrival(40);
+  }
+  REQUIRE(ctrl.GetStats().poll_window_us_ == 40);
+  REQUIRE(ctrl.Decide(5) == PollAction::kBusy);
+  REQUIRE(ctrl.Decide(20) == PollAction::kSpin);
+  REQUIRE(ctrl.Decide(40) == PollAction::kSleep);
+}
+
+TEST_CASE("PollController: adaptive spins when epoll misses the target",
+          "[poll_controller]") {
+  PollController ctrl;
+  ctrl.Configure(PollMode::kAdaptive, 100, 20, 1000);
+  // Timed waits that overshoot by 200us: sleeping cannot meet a 20us p99
+  for (int i = 0; i < 50; ++i) {
+    ctrl.RecordSleep(1000, 1200, true);
+  }
+  ctrl.RecordArrival(300);
+  chi::PollStats stats = ctrl.GetStats();
+  REQUIRE(stats.wake_latency_p99_us_ > 20.0f);
+  REQUIRE(stats.poll_window_us_ == 600);
+  REQUIRE(stats.sleep_wakeups_ == 1);
+  REQUIRE(stats.idle_cpu_us_ == 0);
+  REQUIRE(ctrl.Decide(500) == PollAction::kSpin);
+
+  // The spin budget caps CPU burn regardless of the target
+  for (int i = 0; i < 50; ++i) {
+    ctrl.RecordArrival(5000);
+  }
+  REQUIRE(ctrl.GetStats().poll_window_us_ == 1000);
+}
+
+TEST_CASE("PollController: arrivals are attributed to the wait mode",
+          "[poll_controller]") {
+  PollController ctrl;
+  ctrl.Configure(PollMode::kAdaptive, 100, 0, 1000);
+  for (int i = 0; i < 20; ++i) {
+    ctrl.RecordArrival(40);
+  }
+  chi::PollStats before = ctrl.GetStats();
+  ctrl.Decide(30);
+  ctrl.RecordArrival(30);
+  chi::PollStats after = ctrl.GetStats();
+  REQUIRE(after.spin_wakeups_ == before.spin_wakeups_ + 1);
+  REQUIRE(after.idle_cpu_us_ == before.idle_cpu_us_ + 30);
+}
+
+SIMPLE_TEST_MAIN()
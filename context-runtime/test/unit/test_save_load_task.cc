@@ -46,6 +46,8 @@
  */
 
 #include "../simple_test.h"
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <vector>
@@ -315,6 +317,41 @@ TEST_CASE("SaveTask and LoadTask - Admin FlushTask full flow",
   ipc_manager->DelTask(loaded_out_task);
 }
 
+TEST_CASE("SaveTask and LoadTask - task priority survives transfer",
+          "[save_load_task][admin][priority]") {
+  ChimaeraTestFixture fixture;
+
+  auto *ipc_manager = CHI_IPC;
+  auto *pool_manager = CHI_POOL_MANAGER;
+  auto *container = pool_manager->GetStaticContainer(chi::kAdminPoolId);
+  REQUIRE(container != nullptr);
+
+  auto orig_task = ipc_manager->NewTask<chimaera::admin::FlushTask>(
+      chi::TaskId(1, 2, 3, 0, 4), chi::kAdminPoolId, chi::PoolQuery::Local());
+  REQUIRE(!orig_task.IsNull());
+  REQUIRE(orig_task->GetPriority() == chi::TaskPrio::kNormal);
+  orig_task->SetPriority(chi::TaskPrio::kHigh);
+  REQUIRE(orig_task->IsHighPriority());
+
+  chi::SaveTaskArchive save_in_archive(chi::MsgType::kSerializeIn);
+  hipc::FullPtr<chi::Task> orig_task_ptr = orig_task.template Cast<chi::Task>();
+  container->SaveTask(chimaera::admin::Method::kFlush, save_in_archive,
+                      orig_task_ptr);
+
+  std::string save_in_data = save_in_archive.GetData();
+  chi::LoadTaskArchive load_in_archive(save_in_data);
+  load_in_archive.msg_type_ = chi::MsgType::kSerializeIn;
+  auto loaded_task = ipc_manager->NewTask<chimaera::admin::FlushTask>();
+  load_in_archive >> *loaded_task;
+
+  REQUIRE(loaded_task->GetPriority() == chi::TaskPrio::kHigh);
+  loaded_task->SetPriority(chi::TaskPrio::kNormal);
+  REQUIRE_FALSE(loaded_task->IsHighPriority());
+
+  ipc_manager->DelTask(orig_task);
+  ipc_manager->DelTask(loaded_task);
+}
+
 TEST_CASE("SaveTask and LoadTask - Admin SendTask full flow",
           "[save_load_task][admin][send]") {
   ChimaeraTestFixture fixture;
@@ -477,5 +514,93 @@ TEST_CASE("SaveTask and LoadTask - Admin DestroyPoolTask full flow",
   ipc_manager->DelTask(loaded_out_task);
 }
 
+namespace {
+/** Serialize an archive the way the lightbeam transports frame it */
+std::vector<char> ToWire(chi::SaveTaskArchive &archive) {
+  std::vector<char> wire;
+  hshm::ipc::GlobalSerialize<std::vector<char>> ar(wire);
+  ar(archive);
+  ar.Finalize();
+  return wire;
+}
+
+/** Deserialize a wire message in place, as the receive paths do */
+void FromWire(const std::vector<char> &wire, chi::LoadTaskArchive &archive) {
+  hshm::ipc::ByteView view(wire.data(), wire.size());
+  hshm::ipc::GlobalDeserialize<hshm::ipc::ByteView> ar(view);
+  ar(archive);
+}
+}  // namespace
+
+TEST_CASE("Task archive wire format - round trip in place",
+          "[save_load_task][wire]") {
+  chi::SaveTaskArchive save(chi::MsgType::kSerializeOut);
+  chi::u32 value = 42;
+  double ratio = 0.5;
+  std::string name = "blob";
+  save.range(value, ratio);
+  save << name;
+  std::vector<char> wire = ToWire(save);
+
+  chi::LoadTaskArchive load;
+  FromWire(wire, load);
+  REQUIRE(load.GetMsgType() == chi::MsgType::kSerializeOut);
+
+  chi::u32 loaded_value = 0;
+  double loaded_ratio = 0;
+  std::string loaded_name;
+  load.range(loaded_value, loaded_ratio);
+  load >> loaded_name;
+  REQUIRE(loaded_value == 42);
+  REQUIRE(loaded_ratio == 0.5);
+  REQUIRE(loaded_name == "blob");
+}
+
+TEST_CASE("Task archive wire format - version mismatch is rejected",
+          "[save_load_task][wire]") {
+  chi::SaveTaskArchive save(chi::MsgType::kSerializeIn);
+  chi::u32 value = 7;
+  save << value;
+  std::vector<char> wire = ToWire(save);
+
+  // Bump the version that follows the wire magic
+  chi::u32 magic = chi::kTaskWireMagic;
+  auto it = std::search(wire.begin(), wire.end(),
+                        reinterpret_cast<char *>(&magic),
+                        reinterpret_cast<char *>(&magic) + sizeof(magic));
+  REQUIRE(it != wire.end());
+  chi::u32 bad_version = chi::kTaskWireVersion + 1;
+  memcpy(&*(it + sizeof(magic)), &bad_version, sizeof(bad_version));
+
+  chi::LoadTaskArchive load;
+  FromWire(wire, load);
+  REQUIRE(load.GetMsgType() == chi::MsgType::kHeartbeat);
+  REQUIRE(load.GetTaskInfos().empty());
+}
+
+TEST_CASE("Task archive wire format - codec header round trip",
+          "[save_load_task][wire]") {
+  chi::SaveTaskArchive save(chi::MsgType::kSerializeIn);
+  save.src_node_ = 3;
+  save.codec_mask_ = chi::kWireCodecLz4 | chi::kWireCodecZstd;
+  save.bulk_codecs_.push_back({1, 31, 1 << 20});
+  chi::u32 value = 9;
+  save << value;
+  std::vector<char> wire = ToWire(save);
+
+  chi::LoadTaskArchive load;
+  FromWire(wire, load);
+  REQUIRE(load.GetMsgType() == chi::MsgType::kSerializeIn);
+  REQUIRE(load.src_node_ == 3);
+  REQUIRE(load.codec_mask_ == (chi::kWireCodecLz4 | chi::kWireCodecZstd));
+  REQUIRE(load.bulk_codecs_.size() == 1);
+  REQUIRE(load.bulk_codecs_[0].bulk_idx_ == 1);
+  REQUIRE(load.bulk_codecs_[0].library_id_ == 31);
+  REQUIRE(load.bulk_codecs_[0].raw_size_ == (1u << 20));
+  chi::u32 loaded_value = 0;
+  load >> loaded_value;
+  REQUIRE(loaded_value == 9);
+}
+
 // Define main function for test executable
 SIMPLE_TEST_MAIN()
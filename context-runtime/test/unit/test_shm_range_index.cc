@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Unit tests for ShmRangeIndex, the lock-free pointer-to-allocator table
+ * used by IpcManager::ToFullPtr(T *).
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "simple_test.h"
+#include "chimaera/ipc/shm_range_index.h"
+
+/** Minimal stand-in exposing the allocator accessors the index reads */
+struct FakeAlloc {
+  char *data_;
+  size_t capacity_;
+  char *GetBackendData() const { return data_; }
+  size_t GetBackendDataCapacity() const { return capacity_; }
+};
+
+TEST_CASE("ShmRangeIndex: resolves pointers to owning region",
+          "[shm_range_index]") {
+  std::vector<char> a(4096), b(4096), c(4096);
+  FakeAlloc fa{a.data(), a.size()};
+  FakeAlloc fb{b.data(), b.size()};
+  FakeAlloc fc{c.data(), c.size()};
+  chi::ShmRangeIndex<FakeAlloc> index;
+  index.Rebuild({&fc, &fa, &fb});
+  REQUIRE(index.Size() == 3);
+  REQUIRE(index.Find(a.data()) == &fa);
+  REQUIRE(index.Find(a.data() + 4095) == &fa);
+  REQUIRE(index.Find(b.data() + 100) == &fb);
+  REQUIRE(index.Find(c.data() + 2048) == &fc);
+  int local = 0;
+  REQUIRE(index.Find(&local) == nullptr);
+}
+
+TEST_CASE("ShmRangeIndex: rebuild removes segments", "[shm_range_index]") {
+  std::vector<char> a(4096), b(4096);
+  FakeAlloc fa{a.data(), a.size()};
+  FakeAlloc fb{b.data(), b.size()};
+  chi::ShmRangeIndex<FakeAlloc> index;
+  index.Rebuild({&fa, &fb});
+  index.Rebuild({&fb});
+  REQUIRE(index.Find(a.data()) == nullptr);
+  REQUIRE(index.Find(b.data()) == &fb);
+  index.Rebuild({});
+  REQUIRE(index.Size() == 0);
+  REQUIRE(index.Find(b.data()) == nullptr);
+}
+
+TEST_CASE("ShmRangeIndex: unbounded backend matches everything",
+          "[shm_range_index]") {
+  std::vector<char> a(4096);
+  FakeAlloc fa{a.data(), a.size()};
+  FakeAlloc unbounded{nullptr, SIZE_MAX};
+  chi::ShmRangeIndex<FakeAlloc> index;
+  index.Rebuild({&fa, &unbounded});
+  int local = 0;
+  REQUIRE(index.Find(a.data()) == &fa);
+  REQUIRE(index.Find(&local) == &unbounded);
+}
+
+TEST_CASE("ShmRangeIndex: concurrent readers during rebuilds",
+          "[shm_range_index]") {
+  std::vector<char> a(4096), b(4096);
+  FakeAlloc fa{a.data(), a.size()};
+  FakeAlloc fb{b.data(), b.size()};
+  chi::ShmRangeIndex<FakeAlloc> index;
+  index.Rebuild({&fa});
+  std::atomic<bool> stop{false};
+  std::atomic<int> errors{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&]() {
+      while (!stop.load()) {
+        // fa is always present; fb comes and goes
+        if (index.Find(a.data() + 10) != &fa) {
+          errors.fetch_add(1);
+        }
+        FakeAlloc *found = index.Find(b.data() + 10);
+        if (found != nullptr && found != &fb) {
+          errors.fetch_add(1);
+        }
+      }
+    });
+  }
+  for (int i = 0; i < 2000; ++i) {
+    index.Rebuild({&fa, &fb});
+    index.Rebuild({&fa});
+  }
+  stop.store(true);
+  for (auto &th : readers) {
+    th.join();
+  }
+  REQUIRE(errors.load() == 0);
+}
+
+SIMPLE_TEST_MAIN()
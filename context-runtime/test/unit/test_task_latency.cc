@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Unit tests for the per-task lifecycle latency histograms.
+ * Exercise LatencyHistogram and TaskLatencyStats without starting a runtime.
+ */
+
+#include "simple_test.h"
+#include "chimaera/task_latency.h"
+
+using chi::LatencyHistogram;
+using chi::TaskLatencyEntry;
+using chi::TaskLatencyStats;
+using chi::TaskStage;
+
+TEST_CASE("LatencyHistogram: buckets bound relative error",
+          "[task_latency]") {
+  // Exact below 8, then each bucket's upper bound is within 12.5%
+  for (chi::u64 v = 0; v < 8; ++v) {
+    REQUIRE(LatencyHistogram::BucketOf(v) == v);
+  }
+  for (chi::u64 v = 8; v < (1ull << 40); v = v * 3 / 2 + 1) {
+    chi::u32 idx = LatencyHistogram::BucketOf(v);
+    REQUIRE(idx < LatencyHistogram::kNumBuckets);
+    chi::u64 upper = LatencyHistogram::BucketUpperBound(idx);
+    REQUIRE(upper >= v);
+    REQUIRE(upper - v <= v / 8);
+    REQUIRE(LatencyHistogram::BucketOf(upper) == idx);
+    REQUIRE(LatencyHistogram::BucketOf(upper + 1) == idx + 1);
+  }
+  // Values past the range land in the last bucket
+  REQUIRE(LatencyHistogram::BucketOf(~0ull) ==
+          LatencyHistogram::kNumBuckets - 1);
+}
+
+TEST_CASE("LatencyHistogram: percentiles and merge", "[task_latency]") {
+  LatencyHistogram a, b;
+  REQUIRE(a.Percentile(0.5) == 0);
+  for (chi::u64 v = 1; v <= 900; ++v) {
+    a.Record(v * 1000);
+  }
+  for (chi::u64 v = 901; v <= 1000; ++v) {
+    b.Record(v * 1000);
+  }
+  a.Merge(b);
+  REQUIRE(a.Count() == 1000);
+  REQUIRE(a.Max() == 1000000);
+  REQUIRE(a.Mean() == 500500.0);
+  chi::u64 p50 = a.Percentile(0.5);
+  chi::u64 p99 = a.Percentile(0.99);
+  REQUIRE(p50 >= 500000);
+  REQUIRE(p50 <= 500000 + 500000 / 8);
+  REQUIRE(p99 >= 990000);
+  REQUIRE(p99 <= 1000000);
+  REQUIRE(a.Percentile(1.0) == 1000000);
+  a.Clear();
+  REQUIRE(a.Count() == 0);
+  REQUIRE(a.Max() == 0);
+}
+
+TEST_CASE("TaskLatencyStats: records stages per pool and method",
+          "[task_latency]") {
+  TaskLatencyStats stats;
+  chi::PoolId pool(512, 0);
+  // submit=100, pop=150, start=175, end=400, run=125 (suspended 100)
+  stats.RecordTask(pool, 3, 100, 150, 175, 400, 125);
+  stats.RecordTask(pool, 4, 0, 150, 175, 400, 125);
+  stats.Record(pool, 3, TaskStage::kWait, 500);
+
+  std::vector<TaskLatencyEntry> entries;
+  stats.Snapshot(entries);
+  REQUIRE(entries.size() == 2);
+  const TaskLatencyEntry *m3 = nullptr;
+  const TaskLatencyEntry *m4 = nullptr;
+  for (const auto &entry : entries) {
+    REQUIRE(entry.pool_id_ == pool);
+    if (entry.method_ == 3) m3 = &entry;
+    if (entry.method_ == 4) m4 = &entry;
+  }
+  REQUIRE(m3 != nullptr);
+  REQUIRE(m4 != nullptr);
+  auto stage = [](const TaskLatencyEntry *e, TaskStage s) {
+    return e->stages_[static_cast<chi::u32>(s)];
+  };
+  REQUIRE(stage(m3, TaskStage::kQueue).Max() == 50);
+  REQUIRE(stage(m3, TaskStage::kDispatch).Max() == 25);
+  REQUIRE(stage(m3, TaskStage::kRun).Max() == 125);
+  REQUIRE(stage(m3, TaskStage::kSuspend).Max() == 100);
+  REQUIRE(stage(m3, TaskStage::kTotal).Max() == 300);
+  REQUIRE(stage(m3, TaskStage::kWait).Max() == 500);
+  // A missing submit stamp skips the stages that need it
+  REQUIRE(stage(m4, TaskStage::kQueue).Count() == 0);
+  REQUIRE(stage(m4, TaskStage::kTotal).Count() == 0);
+  REQUIRE(stage(m4, TaskStage::kRun).Count() == 1);
+
+  // Snapshotting a second recorder merges matching entries
+  TaskLatencyStats other;
+  other.RecordTask(pool, 3, 100, 200, 200, 300, 100);
+  other.Snapshot(entries);
+  REQUIRE(entries.size() == 2);
+  for (const auto &entry : entries) {
+    if (entry.method_ == 3) {
+      REQUIRE(stage(&entry, TaskStage::kQueue).Count() == 2);
+      REQUIRE(stage(&entry, TaskStage::kQueue).Max() == 100);
+    }
+  }
+}
+
+TEST_CASE("TaskLatencyStats: stamps are zero while disabled",
+          "[task_latency]") {
+  TaskLatencyStats::SetEnabled(false);
+  REQUIRE(TaskLatencyStats::Stamp() == 0);
+  TaskLatencyStats::SetEnabled(true);
+  chi::u64 t0 = TaskLatencyStats::Stamp();
+  chi::u64 t1 = TaskLatencyStats::Stamp();
+  REQUIRE(t0 != 0);
+  REQUIRE(t1 >= t0);
+  TaskLatencyStats::SetEnabled(false);
+}
+
+SIMPLE_TEST_MAIN()
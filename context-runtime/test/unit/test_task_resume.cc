@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+/**
+ * Unit tests for nested TaskResume coroutines.
+ * Drive coroutine chains the way a worker does, without starting a runtime,
+ * and check that completions transfer straight back to the awaiting caller.
+ */
+
+#include "simple_test.h"
+#include "chimaera/task.h"
+
+using chi::RunContext;
+using chi::TaskResume;
+
+namespace {
+
+/** Await a chain of depth nested coroutines that never suspend */
+TaskResume SyncChain(int depth, int *counter) {
+  if (depth > 0) {
+    co_await SyncChain(depth - 1, counter);
+  }
+  *counter += 1;
+  co_return;
+}
+
+/** Innermost coroutine: suspends once, like a co_await on a Future */
+TaskResume YieldingLeaf(int *trace) {
+  *trace = *trace * 10 + 1;
+  co_await chi::yield();
+  *trace = *trace * 10 + 2;
+  co_return;
+}
+
+/** Middle of the chain */
+TaskResume Middle(int *trace) {
+  co_await YieldingLeaf(trace);
+  *trace = *trace * 10 + 3;
+  co_return;
+}
+
+/** Top-level method coroutine */
+TaskResume Top(int *trace) {
+  co_await Middle(trace);
+  *trace = *trace * 10 + 4;
+  co_return;
+}
+
+/** Start a coroutine like Worker::StartCoroutine */
+TaskResume::handle_type Start(TaskResume coro, RunContext &rctx) {
+  auto handle = coro.release();
+  rctx.coro_handle_ = handle;
+  handle.promise().set_run_context(&rctx);
+  handle.resume();
+  return handle;
+}
+
+}  // namespace
+
+TEST_CASE("TaskResume: nested chain without suspension completes at once",
+          "[task_resume]") {
+  RunContext rctx;
+  int counter = 0;
+  auto top = Start(SyncChain(1000, &counter), rctx);
+  // One dispatch runs every level; nothing is left for the worker
+  REQUIRE(top.done());
+  REQUIRE(counter == 1001);
+  REQUIRE(!rctx.is_yielded_);
+  REQUIRE(rctx.coro_handle_ == top);
+  top.destroy();
+}
+
+TEST_CASE("TaskResume: completion of a suspended leaf resumes its callers",
+          "[task_resume]") {
+  RunContext rctx;
+  int trace = 0;
+  auto top = Start(Top(&trace), rctx);
+  REQUIRE(!top.done());
+  REQUIRE(rctx.is_yielded_);
+  REQUIRE(trace == 1);
+  // The worker resumes whatever handle the leaf left in the RunContext
+  REQUIRE(rctx.coro_handle_ != top);
+  rctx.is_yielded_ = false;
+  rctx.coro_handle_.resume();
+  REQUIRE(trace == 1234);
+  // Each caller took the handle back as it resumed, ending at the top
+  REQUIRE(rctx.coro_handle_ == top);
+  REQUIRE(top.done());
+  top.destroy();
+}
+
+SIMPLE_TEST_MAIN()
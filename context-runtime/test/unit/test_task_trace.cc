@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * Unit tests for the ring-buffered Chrome trace / Perfetto timeline.
+ * Exercise TaskTracer without starting a runtime.
+ */
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "simple_test.h"
+#include "chimaera/task_trace.h"
+
+using chi::TaskTracer;
+
+namespace {
+
+/** Count non-overlapping occurrences of a substring */
+size_t CountOf(const std::string &text, const std::string &needle) {
+  size_t count = 0;
+  for (size_t pos = text.find(needle); pos != std::string::npos;
+       pos = text.find(needle, pos + needle.size())) {
+    ++count;
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST_CASE("TaskTracer: off by default and after Stop", "[task_trace]") {
+  REQUIRE_FALSE(TaskTracer::IsEnabled());
+  REQUIRE(TaskTracer::Stamp() == 0);
+  TaskTracer::RecordTaskRun(chi::PoolId(7, 0), 1, 10, 20, 0);
+  REQUIRE(TaskTracer::DumpJson(0, "", nullptr).empty());
+
+  TaskTracer::Start(16);
+  REQUIRE(TaskTracer::IsEnabled());
+  REQUIRE(TaskTracer::Stamp() != 0);
+  TaskTracer::Stop();
+  TaskTracer::RecordTaskRun(chi::PoolId(7, 0), 1, 10, 20, 0);
+  REQUIRE(TaskTracer::DumpJson(0, "", nullptr).find("\"ph\":\"X\"") ==
+          std::string::npos);
+}
+
+TEST_CASE("TaskTracer: events render as Chrome trace JSON", "[task_trace]") {
+  TaskTracer::Start(64);
+  TaskTracer::SetThreadName("worker \"0\"");
+  chi::PoolId pool(512, 0);
+  TaskTracer::RecordTaskRun(pool, 3, 1000, 2500,
+                            chi::kTraceResumed | chi::kTraceYielded);
+  TaskTracer::RecordTask(pool, 3, 500, 4000, 1500);
+  TaskTracer::RecordBdevIo(pool, true, 1200, 2200, 4096, 2);
+  TaskTracer::RecordNetSend(2, 3000, 3100, 65536, 4, false);
+  TaskTracer::Stop();
+
+  auto name_fn = [](const chi::PoolId &, chi::u32 method) {
+    return method == 3 ? std::string("bdev::Write") : std::string();
+  };
+  std::string json = TaskTracer::DumpJson(1, "host-a", name_fn);
+  // Process and (escaped) thread names
+  REQUIRE(json.find("\"args\":{\"name\":\"node 1 (host-a)\"}") !=
+          std::string::npos);
+  REQUIRE(json.find("\"name\":\"worker \\\"0\\\"\"") != std::string::npos);
+  // Run slice: complete event, ts and dur in microseconds
+  REQUIRE(json.find("\"ph\":\"X\",\"cat\":\"task\",\"name\":\"bdev::Write\"") !=
+          std::string::npos);
+  REQUIRE(json.find("\"dur\":1.500,\"args\":{\"resumed\":true,"
+                    "\"end\":\"suspend\"}") != std::string::npos);
+  // Lifetime and bdev I/O overlap, so they are async begin/end pairs
+  REQUIRE(CountOf(json, "\"ph\":\"b\"") == 2);
+  REQUIRE(CountOf(json, "\"ph\":\"e\"") == 2);
+  REQUIRE(json.find("\"id\":\"1.0\"") != std::string::npos);
+  REQUIRE(json.find("\"name\":\"bdev write\"") != std::string::npos);
+  REQUIRE(json.find("\"bytes\":4096,\"submissions\":2") != std::string::npos);
+  REQUIRE(json.find("\"cat\":\"net\",\"name\":\"send in\"") !=
+          std::string::npos);
+  REQUIRE(json.find("\"node\":2,\"tasks\":4,\"bytes\":65536") !=
+          std::string::npos);
+
+  std::string doc = TaskTracer::WrapJson({json, std::string(), json});
+  REQUIRE(doc.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", 0) ==
+          0);
+  REQUIRE(doc.find("}\n]}\n") != std::string::npos);
+  REQUIRE(CountOf(doc, "\"ph\":\"X\"") == 4);
+}
+
+TEST_CASE("TaskTracer: rings keep the newest events", "[task_trace]") {
+  // 10 rounds up to 16 slots
+  TaskTracer::Start(10);
+  for (chi::u32 i = 0; i < 40; ++i) {
+    TaskTracer::RecordTaskRun(chi::PoolId(1, 0), i, 1000 * i, 1000 * i + 1, 0);
+  }
+  REQUIRE(TaskTracer::GetDroppedCount() == 24);
+  std::string json = TaskTracer::DumpJson(0, "", nullptr);
+  REQUIRE(CountOf(json, "\"ph\":\"X\"") == 16);
+  REQUIRE(json.find("\"name\":\"1.0:23\"") == std::string::npos);
+  REQUIRE(json.find("\"name\":\"1.0:24\"") != std::string::npos);
+  REQUIRE(json.find("\"name\":\"1.0:39\"") != std::string::npos);
+  REQUIRE(json.find("24 events overwritten") != std::string::npos);
+
+  // Start() clears every ring
+  TaskTracer::Start(10);
+  REQUIRE(TaskTracer::GetDroppedCount() == 0);
+  REQUIRE(CountOf(TaskTracer::DumpJson(0, "", nullptr), "\"ph\":\"X\"") == 0);
+  TaskTracer::Stop();
+}
+
+TEST_CASE("TaskTracer: one track per thread", "[task_trace]") {
+  TaskTracer::Start(1024);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([t]() {
+      TaskTracer::SetThreadName("worker " + std::to_string(t));
+      for (chi::u32 i = 0; i < 100; ++i) {
+        TaskTracer::RecordTaskRun(chi::PoolId(2, 0), 0, i * 10, i * 10 + 5, 0);
+      }
+    });
+  }
+  // Dumping while threads record must only ever emit whole events
+  std::string partial = TaskTracer::DumpJson(0, "", nullptr);
+  (void)partial;
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  TaskTracer::Stop();
+  std::string json = TaskTracer::DumpJson(0, "", nullptr);
+  REQUIRE(CountOf(json, "\"ph\":\"X\"") == 400);
+  for (int t = 0; t < 4; ++t) {
+    REQUIRE(json.find("\"args\":{\"name\":\"worker " + std::to_string(t) +
+                      "\"}") != std::string::npos);
+  }
+}
+
+SIMPLE_TEST_MAIN()
@@ -483,6 +483,139 @@ TEST_F(UnorderedMapLLTest, BucketDistribution) {
   return 0;
 }
 
+/**
+ * Test incremental growth from a tiny table: every entry stays reachable
+ * while stripes are migrating between their old and new tables
+ */
+TEST_F(UnorderedMapLLTest, IncrementalGrowth) {
+  hshm::priv::unordered_map_ll<std::string, int> map(4, 4);
+  const int num_keys = 20000;
+  size_t initial_buckets = map.bucket_count();
+
+  for (int i = 0; i < num_keys; ++i) {
+    auto [inserted, val] = map.insert("key_" + std::to_string(i), i);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(*val, i);
+    // Spot-check earlier keys mid-migration
+    int probe = i / 2;
+    int *found = map.find("key_" + std::to_string(probe));
+    EXPECT_NE(found, nullptr);
+    EXPECT_EQ(*found, probe);
+  }
+  EXPECT_EQ(map.size(), static_cast<size_t>(num_keys));
+  EXPECT_GT(map.bucket_count(), initial_buckets);
+  EXPECT_TRUE(map.bucket_count() * 3 >= map.size() * 4);
+
+  // Erase every other key, then re-insert with new values
+  for (int i = 0; i < num_keys; i += 2) {
+    EXPECT_EQ(map.erase("key_" + std::to_string(i)), 1);
+  }
+  EXPECT_EQ(map.size(), static_cast<size_t>(num_keys / 2));
+  for (int i = 0; i < num_keys; i += 2) {
+    auto [inserted, val] =
+        map.insert_or_assign("key_" + std::to_string(i), -i);
+    EXPECT_TRUE(inserted);
+  }
+
+  long long sum = 0;
+  size_t visited = 0;
+  map.for_each([&](const std::string &key, const int &value) {
+    sum += value;
+    ++visited;
+  });
+  EXPECT_EQ(visited, static_cast<size_t>(num_keys));
+  for (int i = 0; i < num_keys; ++i) {
+    int *found = map.find("key_" + std::to_string(i));
+    EXPECT_NE(found, nullptr);
+    EXPECT_EQ(*found, (i % 2 == 0) ? -i : i);
+  }
+  return 0;
+}
+
+/**
+ * Test concurrent growth relying only on the map's stripe locks
+ */
+TEST_F(UnorderedMapLLTest, ConcurrentGrowthNoExternalLock) {
+  hshm::priv::unordered_map_ll<int, int> map(16, 16);
+  const int num_threads = 8;
+  const int insertions_per_thread = 5000;
+  std::atomic<int> missing{0};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&map, &missing, t]() {
+      for (int i = 0; i < insertions_per_thread; ++i) {
+        int key = t * insertions_per_thread + i;
+        map.insert(key, key * 3);
+        if (map.find(key) == nullptr) {
+          missing.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(missing.load(), 0);
+  int total = num_threads * insertions_per_thread;
+  EXPECT_EQ(map.size(), static_cast<size_t>(total));
+  for (int key = 0; key < total; ++key) {
+    int *found = map.find(key);
+    EXPECT_NE(found, nullptr);
+    EXPECT_EQ(*found, key * 3);
+  }
+  return 0;
+}
+
+/**
+ * Test shared-lock lookups racing with inserts that grow the stripes
+ */
+TEST_F(UnorderedMapLLTest, ConcurrentFindDuringGrowth) {
+  hshm::priv::unordered_map_ll<int, int> map(16, 4);
+  const int num_stable = 2000;
+  const int num_growth = 20000;
+  for (int i = 0; i < num_stable; ++i) {
+    map.insert(i, i + 7);
+  }
+
+  std::atomic<bool> done{false};
+  std::atomic<int> bad{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&map, &done, &bad, t]() {
+      int i = t;
+      while (!done.load(std::memory_order_acquire)) {
+        // Values may move when their stripe grows, so only presence is
+        // checked while the writer runs
+        if (!map.contains(i % num_stable)) {
+          bad.fetch_add(1, std::memory_order_relaxed);
+        }
+        i += 13;
+      }
+    });
+  }
+  std::thread writer([&map]() {
+    for (int i = 0; i < num_growth; ++i) {
+      map.insert(num_stable + i, i);
+    }
+  });
+  writer.join();
+  done.store(true, std::memory_order_release);
+  for (auto &reader : readers) {
+    reader.join();
+  }
+
+  EXPECT_EQ(bad.load(), 0);
+  EXPECT_EQ(map.size(), static_cast<size_t>(num_stable + num_growth));
+  for (int i = 0; i < num_stable; ++i) {
+    int *found = map.find(i);
+    EXPECT_NE(found, nullptr);
+    EXPECT_EQ(*found, i + 7);
+  }
+  return 0;
+}
+
 // Main function to run all tests
 int main() {
   int failed = 0;
@@ -512,6 +645,9 @@ int main() {
   RUN_TEST(UnorderedMapLLTest, ConcurrentInsertionsWithCollisions);
   RUN_TEST(UnorderedMapLLTest, ConcurrentMixedOperations);
   RUN_TEST(UnorderedMapLLTest, BucketDistribution);
+  RUN_TEST(UnorderedMapLLTest, IncrementalGrowth);
+  RUN_TEST(UnorderedMapLLTest, ConcurrentGrowthNoExternalLock);
+  RUN_TEST(UnorderedMapLLTest, ConcurrentFindDuringGrowth);
 
   HIPRINT("{}/{} tests passed", (total - failed), total);
   return failed > 0 ? 1 : 0;
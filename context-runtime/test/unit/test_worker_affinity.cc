@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Unit tests for topology-aware worker placement.
+ * Exercise WorkerAffinityPlanner on synthetic topologies without starting
+ * a runtime.
+ */
+
+#include "simple_test.h"
+#include "chimaera/worker_affinity.h"
+
+using chi::AffinityCpu;
+using chi::AffinityPolicy;
+using chi::WorkerAffinityPlanner;
+
+namespace {
+
+/**
+ * Two NUMA nodes, two cores each, two hardware threads per core. CPUs
+ * 0-3 are the first threads, 4-7 their siblings; node 0 holds 0, 1, 4, 5.
+ */
+std::vector<AffinityCpu> TwoNodeTopology() {
+  std::vector<AffinityCpu> cpus;
+  for (int cpu = 0; cpu < 8; ++cpu) {
+    cpus.push_back({cpu, (cpu % 4) / 2, cpu < 4});
+  }
+  return cpus;
+}
+
+}  // namespace
+
+TEST_CASE("WorkerAffinity: policy names", "[worker_affinity]") {
+  REQUIRE(WorkerAffinityPlanner::ParsePolicy("none") == AffinityPolicy::kNone);
+  REQUIRE(WorkerAffinityPlanner::ParsePolicy("any") == AffinityPolicy::kAny);
+  REQUIRE(WorkerAffinityPlanner::ParsePolicy("device") ==
+          AffinityPolicy::kDevice);
+  REQUIRE(WorkerAffinityPlanner::ParsePolicy("bogus") == AffinityPolicy::kAny);
+}
+
+TEST_CASE("WorkerAffinity: node workers go first and siblings stay free",
+          "[worker_affinity]") {
+  const int any = WorkerAffinityPlanner::kAnyNode;
+  // Worker 3 (net) wants node 1 and must get it even though the "any"
+  // workers before it would otherwise take the first cores
+  std::vector<int> plan =
+      WorkerAffinityPlanner::Plan(TwoNodeTopology(), {any, any, any, 1}, false);
+  REQUIRE(plan.size() == 4);
+  REQUIRE(plan[3] == 2);
+  REQUIRE(plan[0] == 0);
+  REQUIRE(plan[1] == 1);
+  REQUIRE(plan[2] == 3);
+}
+
+TEST_CASE("WorkerAffinity: workers beyond the cores stay unpinned",
+          "[worker_affinity]") {
+  const int any = WorkerAffinityPlanner::kAnyNode;
+  std::vector<int> plan = WorkerAffinityPlanner::Plan(
+      TwoNodeTopology(), {any, any, any, any, any}, false);
+  REQUIRE(plan[3] == 3);
+  REQUIRE(plan[4] == WorkerAffinityPlanner::kUnpinned);
+
+  // With siblings allowed the fifth worker takes a second hardware thread
+  plan = WorkerAffinityPlanner::Plan(TwoNodeTopology(),
+                                     {any, any, any, any, any}, true);
+  REQUIRE(plan[4] == 4);
+}
+
+TEST_CASE("WorkerAffinity: full node falls back and none is skipped",
+          "[worker_affinity]") {
+  const int none = WorkerAffinityPlanner::kNoPin;
+  // Three workers want node 0, which has two cores; the third takes a
+  // core on node 1. The unpinned worker consumes nothing.
+  std::vector<int> plan =
+      WorkerAffinityPlanner::Plan(TwoNodeTopology(), {none, 0, 0, 0}, false);
+  REQUIRE(plan[0] == WorkerAffinityPlanner::kUnpinned);
+  REQUIRE(plan[1] == 0);
+  REQUIRE(plan[2] == 1);
+  REQUIRE(plan[3] == 2);
+}
+
+SIMPLE_TEST_MAIN()
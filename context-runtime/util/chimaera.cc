@@ -14,6 +14,7 @@ void PrintUsage() {
             << "  runtime stop    Stop the Chimaera runtime server\n"
             << "  migrate         Migrate a container to a different node\n"
             << "  monitor         Monitor worker statistics\n"
+            << "  trace           Capture a task timeline (start|stop|dump)\n"
             << "  compose         Create/destroy pools from compose config\n"
             << "  repo refresh    Autogenerate ChiMod method files\n"
             << "\n"
@@ -90,6 +91,8 @@ int main(int argc, char* argv[]) {
     return Monitor(new_argc, new_argv);
   } else if (cmd == "compose") {
     return Compose(new_argc, new_argv);
+  } else if (cmd == "trace") {
+    return Trace(new_argc, new_argv);
   } else {
     std::cerr << "Unknown command: " << cmd << "\n";
     PrintUsage();
@@ -100,6 +100,8 @@ std::vector<chi::WorkerStats> DecodeWorkerStats(
         else if (key == "num_retry_tasks")    kv.val.convert(stats.num_retry_tasks_);
         else if (key == "suspend_period_us")  kv.val.convert(stats.suspend_period_us_);
         else if (key == "num_tasks_processed") kv.val.convert(stats.num_tasks_processed_);
+        else if (key == "lane_remaps_in")  kv.val.convert(stats.lane_remaps_in_);
+        else if (key == "lane_remaps_out") kv.val.convert(stats.lane_remaps_out_);
       }
       result.push_back(stats);
     }
@@ -123,11 +125,13 @@ void PrintStats(const std::vector<chi::WorkerStats>& workers) {
   chi::u32 total_queued = 0;
   chi::u32 total_blocked = 0;
   chi::u32 total_periodic = 0;
+  chi::u64 total_remaps = 0;
 
   for (const auto& stats : workers) {
     total_queued += stats.num_queued_tasks_;
     total_blocked += stats.num_blocked_tasks_;
     total_periodic += stats.num_periodic_tasks_;
+    total_remaps += stats.lane_remaps_out_;
   }
 
   HIPRINT("Summary:");
@@ -135,6 +139,7 @@ void PrintStats(const std::vector<chi::WorkerStats>& workers) {
   HIPRINT("  Total Queued Tasks:   {}", total_queued);
   HIPRINT("  Total Blocked Tasks:  {}", total_blocked);
   HIPRINT("  Total Periodic Tasks: {}", total_periodic);
+  HIPRINT("  Total Lane Remaps:    {}", total_remaps);
   HIPRINT("");
 
   std::ostringstream header;
@@ -145,10 +150,12 @@ void PrintStats(const std::vector<chi::WorkerStats>& workers) {
          << std::setw(10) << "Queued"
          << std::setw(10) << "Blocked"
          << std::setw(10) << "Periodic"
-         << std::setw(15) << "Suspend (us)";
+         << std::setw(15) << "Suspend (us)"
+         << std::setw(12) << "Remaps In"
+         << std::setw(12) << "Remaps Out";
   HIPRINT("Worker Details:");
   HIPRINT("{}", header.str());
-  HIPRINT("{}", std::string(83, '-'));
+  HIPRINT("{}", std::string(107, '-'));
 
   for (const auto& stats : workers) {
     std::ostringstream row;
@@ -159,7 +166,9 @@ void PrintStats(const std::vector<chi::WorkerStats>& workers) {
         << std::setw(10) << stats.num_queued_tasks_
         << std::setw(10) << stats.num_blocked_tasks_
         << std::setw(10) << stats.num_periodic_tasks_
-        << std::setw(15) << stats.suspend_period_us_;
+        << std::setw(15) << stats.suspend_period_us_
+        << std::setw(12) << stats.lane_remaps_in_
+        << std::setw(12) << stats.lane_remaps_out_;
     HIPRINT("{}", row.str());
   }
 
@@ -226,7 +235,9 @@ int Monitor(int argc, char* argv[]) {
                << "\"num_periodic_tasks\":" << stats.num_periodic_tasks_ << ","
                << "\"num_retry_tasks\":" << stats.num_retry_tasks_ << ","
                << "\"suspend_period_us\":" << stats.suspend_period_us_ << ","
-               << "\"num_tasks_processed\":" << stats.num_tasks_processed_ << "}";
+               << "\"num_tasks_processed\":" << stats.num_tasks_processed_ << ","
+               << "\"lane_remaps_in\":" << stats.lane_remaps_in_ << ","
+               << "\"lane_remaps_out\":" << stats.lane_remaps_out_ << "}";
         }
         json << "]}";
         HIPRINT("{}", json.str());
@@ -39,7 +39,15 @@
  *
  * The libexec source files implement Container virtual API methods (Run, Del,
  * SaveTask, LoadTask, AllocLoadTask, LocalLoadTask, LocalAllocLoadTask,
- * NewCopy, Aggregate) with switch-case dispatch.
+ * NewCopy, Aggregate). Run uses switch-case dispatch; the others index a
+ * constexpr chi::MethodExec table. The methods header also emits a
+ * chi::MethodTraits table built from the optional method_traits section:
+ *
+ *     method_traits:
+ *       kSend: {route: network}
+ *       kPutBlob: {route: io, io_size_hint: 1M}
+ *
+ * route is one of default, network, io, or metadata.
  *
  * Usage:
  *     chimaera repo refresh <chimod_repo_path>
@@ -55,6 +63,7 @@
 #include <vector>
 
 #include <yaml-cpp/yaml.h>
+#include <hermes_shm/util/config_parse.h>
 #include <hermes_shm/util/logging.h>
 
 #include "chimaera_commands.h"
@@ -69,6 +78,9 @@ struct Method {
   std::string method_name;
   int method_id;
   bool is_inherited;
+  std::string route = "kDefault";  ///< chi::MethodRoute enumerator
+  size_t io_size_hint = 0;         ///< Typical bytes moved per task
+  bool is_gpu = false;             ///< Listed in gpu_methods
 };
 
 /**
@@ -161,6 +173,7 @@ class ChiModGenerator {
       method.method_name = method_name;
       method.method_id = value;
       method.is_inherited = value < 10;  // Inherited methods have IDs < 10
+      LoadMethodTraits(config, method);
       methods.push_back(method);
     }
 
@@ -173,6 +186,43 @@ class ChiModGenerator {
     return methods;
   }
 
+  /**
+   * Fill a method's traits from the method_traits and gpu_methods sections
+   */
+  void LoadMethodTraits(const YAML::Node& config, Method& method) {
+    if (config["gpu_methods"] && config["gpu_methods"].IsSequence()) {
+      for (const auto& gm : config["gpu_methods"]) {
+        if (gm.as<std::string>() == method.constant_name) {
+          method.is_gpu = true;
+        }
+      }
+    }
+
+    const YAML::Node traits = config["method_traits"];
+    if (!traits || !traits[method.constant_name]) {
+      return;
+    }
+    const YAML::Node node = traits[method.constant_name];
+    if (node["route"]) {
+      static const std::map<std::string, std::string> kRoutes = {
+          {"default", "kDefault"},
+          {"network", "kNetwork"},
+          {"io", "kIo"},
+          {"metadata", "kMetadata"}};
+      std::string route = node["route"].as<std::string>();
+      auto it = kRoutes.find(route);
+      if (it == kRoutes.end()) {
+        throw std::runtime_error("Unknown route '" + route + "' for " +
+                                 method.constant_name);
+      }
+      method.route = it->second;
+    }
+    if (node["io_size_hint"]) {
+      method.io_size_hint =
+          hshm::ConfigParse::ParseSize(node["io_size_hint"].as<std::string>());
+    }
+  }
+
   /**
    * Generate the methods header file
    */
@@ -200,6 +250,7 @@ class ChiModGenerator {
     oss << "#define " << namespace_upper << "_" << chimod_upper << "_AUTOGEN_METHODS_H_\n";
     oss << "\n";
     oss << "#include <chimaera/chimaera.h>\n";
+    oss << "#include <chimaera/method_traits.h>\n";
     oss << "#include <string>\n";
     oss << "#include <vector>\n";
     oss << "\n";
@@ -255,6 +306,31 @@ class ChiModGenerator {
     oss << "  return names;\n";
     oss << "}\n";
 
+    // Emit kMethodTraits: one entry per method ID, empty for unused IDs.
+    // The size is a literal so host code never reads the GPU constant.
+    int num_traits = methods.empty() ? 1 : methods.back().method_id + 1;
+    oss << "\n/** Per-method traits indexed by method ID (see chimaera_mod.yaml) */\n";
+    oss << "inline constexpr chi::MethodTraits kMethodTraits[" << num_traits << "] = {\n";
+    size_t next = 0;
+    for (int id = 0; id < num_traits; ++id) {
+      if (next < methods.size() && methods[next].method_id == id) {
+        const Method& method = methods[next++];
+        oss << "    {chi::MethodRoute::" << method.route << ", chi::kMethodDefined";
+        if (method.is_gpu) {
+          oss << " | chi::kMethodGpu";
+        }
+        oss << ", " << method.io_size_hint << "},  // " << id << ": "
+            << method.method_name << "\n";
+      } else {
+        oss << "    {},  // " << id << "\n";
+      }
+    }
+    oss << "};\n";
+    oss << "\n/** @return Traits of a method, or chi::kNoMethodTraits if unknown */\n";
+    oss << "constexpr const chi::MethodTraits& GetMethodTraits(chi::u32 method) {\n";
+    oss << "  return method < " << num_traits << " ? kMethodTraits[method] : chi::kNoMethodTraits;\n";
+    oss << "}\n";
+
     oss << "}  // namespace Method\n";
     oss << "\n";
     oss << "}  // namespace " << namespace_name << "::" << chimod_name << "\n";
@@ -273,8 +349,10 @@ class ChiModGenerator {
       return "CreateTask";
     } else if (method_name == "Destroy") {
       return "DestroyTask";
-    } else if (method_name.length() >= 11 && method_name.substr(0, 11) == "GetOrCreate") {
-      // Template-based task
+    } else if (method_name.length() >= 11 && method_name.substr(0, 11) == "GetOrCreate" &&
+               method_name.back() != 's') {
+      // Template-based task; batch variants (e.g. GetOrCreateTags) are
+      // regular tasks over plain name lists
       return chimod_name + "::" + method_name + "Task<" + chimod_name + "::CreateParams>";
     }
 
@@ -296,8 +374,8 @@ class ChiModGenerator {
     // Build the source content
     oss << "/**\n";
     oss << " * Auto-generated execution implementation for " << module_name << " ChiMod\n";
-    oss << " * Implements Container virtual APIs (Run, SaveTask, LoadTask, NewCopyTask, NewTask)\n";
-    oss << " * using switch-case dispatch\n";
+    oss << " * Implements Container virtual APIs (Run, SaveTask, LoadTask, NewCopyTask, NewTask).\n";
+    oss << " * Run uses switch-case dispatch; the others index the kMethodExec table.\n";
     oss << " * \n";
     oss << " * This file is autogenerated - do not edit manually.\n";
     oss << " * Changes should be made to the autogen tool or the YAML configuration.\n";
@@ -307,9 +385,32 @@ class ChiModGenerator {
     oss << "#include \"" << namespace_name << "/" << module_name << "/autogen/" << chimod_name << "_methods.h\"\n";
     oss << "#include <chimaera/chimaera.h>\n";
     oss << "#include <chimaera/task.h>  // For TaskResume coroutine return type\n";
+    oss << "#include <chimaera/method_exec.h>\n";
     oss << "\n";
     oss << "namespace " << namespace_name << "::" << chimod_name << " {\n";
     oss << "\n";
+
+    // Emit the per-method dispatch table: typed entries for implemented
+    // method IDs, empty entries for the gaps
+    int num_exec = methods.empty() ? 1 : methods.back().method_id + 1;
+    oss << "namespace {\n";
+    oss << "\n";
+    oss << "/** Per-method dispatch table indexed by method ID */\n";
+    oss << "constexpr chi::MethodExec kMethodExec[" << num_exec << "] = {\n";
+    size_t next = 0;
+    for (int id = 0; id < num_exec; ++id) {
+      if (next < methods.size() && methods[next].method_id == id) {
+        const Method& method = methods[next++];
+        oss << "    chi::MakeMethodExec<" << GetTaskTypeName(method.method_name, chimod_name)
+            << ">(),  // " << id << ": " << method.method_name << "\n";
+      } else {
+        oss << "    {},  // " << id << "\n";
+      }
+    }
+    oss << "};\n";
+    oss << "\n";
+    oss << "}  // namespace\n";
+    oss << "\n";
     oss << "//==============================================================================\n";
     oss << "// Container Virtual API Implementations\n";
     oss << "//==============================================================================\n";
@@ -325,6 +426,7 @@ class ChiModGenerator {
     oss << "  // Initialize per-method load prediction model\n";
     oss << "  DefineModel(Method::kMaxMethodId);\n";
     oss << "  SetMethodNames(Method::GetMethodNames());\n";
+    oss << "  SetMethodTraits(Method::kMethodTraits);\n";
     oss << "}\n";
     oss << "\n";
 
@@ -339,6 +441,7 @@ class ChiModGenerator {
     }
 
     oss << "chi::TaskResume Runtime::Run(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr, chi::RunContext& rctx) {\n";
+    oss << "  CHI_TASK_BODY_BEGIN\n";
     oss << "  switch (method) {\n";
 
     // Add Run switch cases for each method
@@ -351,7 +454,7 @@ class ChiModGenerator {
       oss << "    case Method::" << method.constant_name << ": {\n";
       oss << "      // Cast task FullPtr to specific type\n";
       oss << "      hipc::FullPtr<" << task_type << "> typed_task = task_ptr.template Cast<" << task_type << ">();\n";
-      oss << "      co_await " << method.method_name << "(typed_task, rctx);\n";
+      oss << "      CHI_CO_AWAIT(" << method.method_name << "(typed_task, rctx));\n";
       oss << "      break;\n";
       oss << "    }\n";
     }
@@ -361,49 +464,24 @@ class ChiModGenerator {
     oss << "      break;\n";
     oss << "    }\n";
     oss << "  }\n";
-    oss << "  // co_return makes this a coroutine returning TaskResume\n";
-    oss << "  co_return;\n";
+    oss << "  CHI_CO_RETURN;\n";
+    oss << "  CHI_TASK_BODY_END\n";
     oss << "}\n";
     oss << "\n";
+    // The remaining Container APIs look the method up in kMethodExec
     oss << "void Runtime::SaveTask(chi::u32 method, chi::SaveTaskArchive& archive, \n";
     oss << "                        hipc::FullPtr<chi::Task> task_ptr) {\n";
-    oss << "  switch (method) {\n";
-
-    // Add SaveTask switch cases
-    for (const auto& method : methods) {
-      std::string task_type = GetTaskTypeName(method.method_name, chimod_name);
-      oss << "    case Method::" << method.constant_name << ": {\n";
-      oss << "      auto typed_task = task_ptr.template Cast<" << task_type << ">();\n";
-      oss << "      archive << *typed_task.ptr_;\n";
-      oss << "      break;\n";
-      oss << "    }\n";
-    }
-
-    oss << "    default: {\n";
-    oss << "      // Unknown method - do nothing\n";
-    oss << "      break;\n";
-    oss << "    }\n";
+    oss << "  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);\n";
+    oss << "  if (exec != nullptr) {\n";
+    oss << "    exec->save_(archive, task_ptr);\n";
     oss << "  }\n";
     oss << "}\n";
     oss << "\n";
     oss << "void Runtime::LoadTask(chi::u32 method, chi::LoadTaskArchive& archive,\n";
     oss << "                        hipc::FullPtr<chi::Task> task_ptr) {\n";
-    oss << "  switch (method) {\n";
-
-    // Add LoadTask switch cases
-    for (const auto& method : methods) {
-      std::string task_type = GetTaskTypeName(method.method_name, chimod_name);
-      oss << "    case Method::" << method.constant_name << ": {\n";
-      oss << "      auto typed_task = task_ptr.template Cast<" << task_type << ">();\n";
-      oss << "      archive >> *typed_task.ptr_;\n";
-      oss << "      break;\n";
-      oss << "    }\n";
-    }
-
-    oss << "    default: {\n";
-    oss << "      // Unknown method - do nothing\n";
-    oss << "      break;\n";
-    oss << "    }\n";
+    oss << "  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);\n";
+    oss << "  if (exec != nullptr) {\n";
+    oss << "    exec->load_(archive, task_ptr);\n";
     oss << "  }\n";
     oss << "}\n";
     oss << "\n";
@@ -417,23 +495,9 @@ class ChiModGenerator {
     oss << "\n";
     oss << "void Runtime::LocalLoadTask(chi::u32 method, chi::DefaultLoadArchive& archive,\n";
     oss << "                            hipc::FullPtr<chi::Task> task_ptr) {\n";
-    oss << "  switch (method) {\n";
-
-    // Add LocalLoadTask switch cases
-    for (const auto& method : methods) {
-      std::string task_type = GetTaskTypeName(method.method_name, chimod_name);
-      oss << "    case Method::" << method.constant_name << ": {\n";
-      oss << "      auto typed_task = task_ptr.template Cast<" << task_type << ">();\n";
-      oss << "      // Use archive operator which respects msg_type\n";
-      oss << "      archive >> *typed_task.ptr_;\n";
-      oss << "      break;\n";
-      oss << "    }\n";
-    }
-
-    oss << "    default: {\n";
-    oss << "      // Unknown method - do nothing\n";
-    oss << "      break;\n";
-    oss << "    }\n";
+    oss << "  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);\n";
+    oss << "  if (exec != nullptr) {\n";
+    oss << "    exec->local_load_(archive, task_ptr);\n";
     oss << "  }\n";
     oss << "}\n";
     oss << "\n";
@@ -447,130 +511,58 @@ class ChiModGenerator {
     oss << "\n";
     oss << "void Runtime::LocalSaveTask(chi::u32 method, chi::DefaultSaveArchive& archive, \n";
     oss << "                             hipc::FullPtr<chi::Task> task_ptr) {\n";
-    oss << "  switch (method) {\n";
-
-    // Add LocalSaveTask switch cases
-    for (const auto& method : methods) {
-      std::string task_type = GetTaskTypeName(method.method_name, chimod_name);
-      oss << "    case Method::" << method.constant_name << ": {\n";
-      oss << "      auto typed_task = task_ptr.template Cast<" << task_type << ">();\n";
-      oss << "      // Use archive operator which respects msg_type\n";
-      oss << "      archive << *typed_task.ptr_;\n";
-      oss << "      break;\n";
-      oss << "    }\n";
-    }
-
-    oss << "    default: {\n";
-    oss << "      // Unknown method - do nothing\n";
-    oss << "      break;\n";
-    oss << "    }\n";
+    oss << "  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);\n";
+    oss << "  if (exec != nullptr) {\n";
+    oss << "    exec->local_save_(archive, task_ptr);\n";
     oss << "  }\n";
     oss << "}\n";
     oss << "\n";
     oss << "hipc::FullPtr<chi::Task> Runtime::NewCopyTask(chi::u32 method, hipc::FullPtr<chi::Task> orig_task_ptr, bool deep) {\n";
+    oss << "  (void)deep;    // Deep copy parameter reserved for future use\n";
+    oss << "  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);\n";
+    oss << "  if (exec != nullptr) {\n";
+    oss << "    return exec->new_copy_(orig_task_ptr);\n";
+    oss << "  }\n";
+    oss << "  // For unknown methods, create base Task copy\n";
     oss << "  auto* ipc_manager = CHI_IPC;\n";
     oss << "  if (!ipc_manager) {\n";
     oss << "    return hipc::FullPtr<chi::Task>();\n";
     oss << "  }\n";
-    oss << "  \n";
-    oss << "  switch (method) {\n";
-
-    // Add NewCopyTask switch cases
-    for (const auto& method : methods) {
-      std::string task_type = GetTaskTypeName(method.method_name, chimod_name);
-      oss << "    case Method::" << method.constant_name << ": {\n";
-      oss << "      // Allocate new task\n";
-      oss << "      auto new_task_ptr = ipc_manager->NewTask<" << task_type << ">();\n";
-      oss << "      if (!new_task_ptr.IsNull()) {\n";
-      oss << "        // Copy task fields (includes base Task fields)\n";
-      oss << "        auto task_typed = orig_task_ptr.template Cast<" << task_type << ">();\n";
-      oss << "        new_task_ptr->Copy(task_typed);\n";
-      oss << "        return new_task_ptr.template Cast<chi::Task>();\n";
-      oss << "      }\n";
-      oss << "      break;\n";
-      oss << "    }\n";
-    }
-
-    oss << "    default: {\n";
-    oss << "      // For unknown methods, create base Task copy\n";
-      oss << "      auto new_task_ptr = ipc_manager->NewTask<chi::Task>();\n";
-    oss << "      if (!new_task_ptr.IsNull()) {\n";
-    oss << "        new_task_ptr->Copy(orig_task_ptr);\n";
-    oss << "        return new_task_ptr;\n";
-    oss << "      }\n";
-    oss << "      break;\n";
-    oss << "    }\n";
+    oss << "  auto new_task_ptr = ipc_manager->NewTask<chi::Task>();\n";
+    oss << "  if (!new_task_ptr.IsNull()) {\n";
+    oss << "    new_task_ptr->Copy(orig_task_ptr);\n";
     oss << "  }\n";
-    oss << "  \n";
-    oss << "  (void)deep;    // Deep copy parameter reserved for future use\n";
-    oss << "  return hipc::FullPtr<chi::Task>();\n";
+    oss << "  return new_task_ptr;\n";
     oss << "}\n";
     oss << "\n";
     oss << "hipc::FullPtr<chi::Task> Runtime::NewTask(chi::u32 method) {\n";
-    oss << "  auto* ipc_manager = CHI_IPC;\n";
-    oss << "  if (!ipc_manager) {\n";
+    oss << "  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);\n";
+    oss << "  if (exec == nullptr) {\n";
+    oss << "    // For unknown methods, return null pointer\n";
     oss << "    return hipc::FullPtr<chi::Task>();\n";
     oss << "  }\n";
-    oss << "  \n";
-    oss << "  switch (method) {\n";
-
-    // Add NewTask switch cases
-    for (const auto& method : methods) {
-      std::string task_type = GetTaskTypeName(method.method_name, chimod_name);
-      oss << "    case Method::" << method.constant_name << ": {\n";
-      oss << "      auto new_task_ptr = ipc_manager->NewTask<" << task_type << ">();\n";
-      oss << "      return new_task_ptr.template Cast<chi::Task>();\n";
-      oss << "    }\n";
-    }
-
-    oss << "    default: {\n";
-    oss << "      // For unknown methods, return null pointer\n";
-    oss << "      return hipc::FullPtr<chi::Task>();\n";
-    oss << "    }\n";
-    oss << "  }\n";
+    oss << "  return exec->new_task_();\n";
     oss << "}\n";
     oss << "\n";
-    // Generate Aggregate method - dispatches to typed task's Aggregate
     oss << "void Runtime::Aggregate(chi::u32 method, hipc::FullPtr<chi::Task> orig_task,\n";
     oss << "                        const hipc::FullPtr<chi::Task>& replica_task) {\n";
-    oss << "  switch (method) {\n";
-
-    for (const auto& method : methods) {
-      std::string task_type = GetTaskTypeName(method.method_name, chimod_name);
-      oss << "    case Method::" << method.constant_name << ": {\n";
-      oss << "      auto typed_task = orig_task.template Cast<" << task_type << ">();\n";
-      oss << "      typed_task->Aggregate(replica_task);\n";
-      oss << "      break;\n";
-      oss << "    }\n";
-    }
-
-    oss << "    default: {\n";
-    oss << "      orig_task->Aggregate(replica_task);\n";
-    oss << "      break;\n";
-    oss << "    }\n";
+    oss << "  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);\n";
+    oss << "  if (exec != nullptr) {\n";
+    oss << "    exec->aggregate_(orig_task, replica_task);\n";
+    oss << "  } else {\n";
+    oss << "    orig_task->Aggregate(replica_task);\n";
     oss << "  }\n";
     oss << "}\n";
     oss << "\n";
-
-    // Generate DelTask method - dispatches to typed task deletion
     oss << "void Runtime::DelTask(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr) {\n";
+    oss << "  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);\n";
+    oss << "  if (exec != nullptr) {\n";
+    oss << "    exec->del_(task_ptr);\n";
+    oss << "    return;\n";
+    oss << "  }\n";
     oss << "  auto* ipc_manager = CHI_IPC;\n";
     oss << "  if (!ipc_manager) return;\n";
-    oss << "  switch (method) {\n";
-
-    for (const auto& method : methods) {
-      std::string task_type = GetTaskTypeName(method.method_name, chimod_name);
-      oss << "    case Method::" << method.constant_name << ": {\n";
-      oss << "      ipc_manager->DelTask(task_ptr.template Cast<" << task_type << ">());\n";
-      oss << "      break;\n";
-      oss << "    }\n";
-    }
-
-    oss << "    default: {\n";
-    oss << "      ipc_manager->DelTask(task_ptr);\n";
-    oss << "      break;\n";
-    oss << "    }\n";
-    oss << "  }\n";
+    oss << "  ipc_manager->DelTask(task_ptr);\n";
     oss << "}\n";
     oss << "\n";
     oss << "} // namespace " << namespace_name << "::" << chimod_name << "\n";
@@ -877,7 +869,7 @@ class ChiModGenerator {
     oss << "  PoolId *d_pid = hshm::GpuApi::Malloc<PoolId>(sizeof(PoolId));\n";
     oss << "  hshm::GpuApi::Memcpy(d_pid, &pool_id, sizeof(PoolId));\n";
     oss << "  _gpu_alloc_container<<<1, 1, 0,\n";
-    oss << "      static_cast<cudaStream_t>(stream)>>>(d_out, module_id, d_pid, container_id);\n";
+    oss << "      static_cast<hshm::GpuStream>(stream)>>>(d_out, module_id, d_pid, container_id);\n";
     oss << "  hshm::GpuApi::Synchronize(stream);\n";
     oss << "  Container *h_ptr = nullptr;\n";
     oss << "  hshm::GpuApi::Memcpy(&h_ptr, d_out, sizeof(Container *));\n";
@@ -87,8 +87,9 @@ bool InductNode() {
 
   HLOG(kInfo, "Inducting this node ({}:{}) into the cluster...", my_ip, my_port);
 
+  // Dynamic lets this node's admin assign the ID before the broadcast
   auto task = admin_client->AsyncAddNode(
-      chi::PoolQuery::Broadcast(), my_ip, my_port);
+      chi::PoolQuery::Dynamic(), my_ip, my_port);
   task.Wait();
 
   if (task->GetReturnCode() != 0) {
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Copyright 2024 IOWarp contributors
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "chimaera/chimaera.h"
+#include "chimaera/admin/admin_client.h"
+#include "chimaera/task_trace.h"
+#include "chimaera/types.h"
+#include "chimaera_commands.h"
+
+namespace {
+void PrintTraceUsage() {
+  HIPRINT("Usage: chimaera trace <start|stop|dump> [OPTIONS]");
+  HIPRINT("  Capture a task timeline viewable in ui.perfetto.dev or chrome://tracing");
+  HIPRINT("");
+  HIPRINT("Subcommands:");
+  HIPRINT("  start             Clear the trace rings and start capturing");
+  HIPRINT("  stop              Stop capturing (captured events are kept)");
+  HIPRINT("  dump              Write the captured events as trace JSON");
+  HIPRINT("");
+  HIPRINT("Options:");
+  HIPRINT("  --events N        Events kept per thread (start; default {})",
+          chi::TaskTracer::kDefaultEventsPerThread);
+  HIPRINT("  -o, --output F    Output file (dump; default chimaera_trace.json)");
+  HIPRINT("  --local           Only this node (default: every node)");
+}
+}  // namespace
+
+int Trace(int argc, char** argv) {
+  if (argc < 1 || std::strcmp(argv[0], "--help") == 0 ||
+      std::strcmp(argv[0], "-h") == 0) {
+    PrintTraceUsage();
+    return argc < 1 ? 1 : 0;
+  }
+  std::string subcmd = argv[0];
+  chi::u32 events_per_thread = 0;
+  std::string output = "chimaera_trace.json";
+  bool local = false;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--events") == 0 && i + 1 < argc) {
+      events_per_thread =
+          static_cast<chi::u32>(std::strtoul(argv[++i], nullptr, 10));
+    } else if ((std::strcmp(argv[i], "-o") == 0 ||
+                std::strcmp(argv[i], "--output") == 0) &&
+               i + 1 < argc) {
+      output = argv[++i];
+    } else if (std::strcmp(argv[i], "--local") == 0) {
+      local = true;
+    } else {
+      HLOG(kError, "Unknown option: {}", argv[i]);
+      PrintTraceUsage();
+      return 1;
+    }
+  }
+
+  std::string query;
+  if (subcmd == "start") {
+    query = "trace_start";
+    if (events_per_thread) query += ":" + std::to_string(events_per_thread);
+  } else if (subcmd == "stop") {
+    query = "trace_stop";
+  } else if (subcmd == "dump") {
+    query = "trace_dump";
+  } else {
+    HLOG(kError, "Unknown trace subcommand: {}", subcmd);
+    PrintTraceUsage();
+    return 1;
+  }
+
+  if (!chi::CHIMAERA_INIT(chi::ChimaeraMode::kClient, false)) {
+    HLOG(kError, "Failed to initialize Chimaera client");
+    return 1;
+  }
+  auto* admin_client = CHI_ADMIN;
+  if (!admin_client) {
+    HLOG(kError, "Failed to get admin client");
+    return 1;
+  }
+
+  auto future = admin_client->AsyncMonitor(
+      local ? chi::PoolQuery::Local() : chi::PoolQuery::Broadcast(), query);
+  future.Wait();
+  if (future->GetReturnCode() != 0) {
+    HLOG(kError, "Monitor({}) failed with return code {}", query,
+         future->GetReturnCode());
+    return 1;
+  }
+
+  if (subcmd != "dump") {
+    HLOG(kSuccess, "Trace {} on {} node(s)", subcmd, future->results_.size());
+    return 0;
+  }
+
+  // One fragment per node; each node is its own process in the trace
+  std::vector<std::string> fragments;
+  for (const auto& [container_id, fragment] : future->results_) {
+    fragments.push_back(fragment);
+  }
+  std::ofstream out(output, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    HLOG(kError, "Cannot open {} for writing", output);
+    return 1;
+  }
+  out << chi::TaskTracer::WrapJson(fragments);
+  HLOG(kSuccess, "Wrote trace of {} node(s) to {}", fragments.size(), output);
+  return 0;
+}
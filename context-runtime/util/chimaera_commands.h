@@ -13,5 +13,6 @@ int Monitor(int argc, char** argv);
 int Compose(int argc, char** argv);
 int Migrate(int argc, char** argv);
 int RefreshRepo(int argc, char** argv);
+int Trace(int argc, char** argv);
 
 #endif  // CHIMAERA_COMMANDS_H_
@@ -33,7 +33,9 @@
 
 #include "iowarp_engine.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <stdexcept>
@@ -57,6 +59,8 @@ IowarpEngine::IowarpEngine(adios2::core::IO &io, const std::string &name,
       current_step_(0),
       rank_(m_Comm.Rank()),
       open_(false),
+      next_blob_index_(0),
+      read_step_(SIZE_MAX),
       total_io_time_ms_(0.0) {
   HLOG(kDebug, "[IowarpEngine] Constructor entered, rank={}, name={}", rank_, name);
 
@@ -134,11 +138,57 @@ void IowarpEngine::Init_() {
   HLOG(kDebug, "[IowarpEngine] Init_() completed");
 }
 
+namespace {
+
+/** Identifies a step manifest blob ("IWSM") */
+constexpr chi::u32 kStepManifestMagic = 0x4D535749;
+
+/** Fixed header of a step manifest */
+struct StepManifestHeader {
+  chi::u32 magic;
+  chi::u32 num_vars;
+  chi::u64 packed_bytes;
+};
+
+/** Manifest record of one variable block; its name follows the record */
+struct StepManifestEntry {
+  chi::u32 name_len;
+  chi::u32 packed;
+  chi::u64 where;
+  chi::u64 size;
+};
+
+/** Local selection size of a variable in bytes */
+template <typename T>
+size_t VariableBytes(const adios2::core::Variable<T> &variable) {
+  // Use m_Count (local selection size), not m_Shape (global): in MPI
+  // applications each rank only has a portion of the global array
+  const adios2::Dims &dims =
+      variable.m_Count.empty() ? variable.m_Shape : variable.m_Count;
+  size_t element_count = 1;
+  for (size_t dim : dims) {
+    element_count *= dim;
+  }
+  return element_count * sizeof(T);
+}
+
+/** Block of a variable selected for reading (put order within the step) */
+template <typename T>
+size_t SelectedBlock(const adios2::core::Variable<T> &variable) {
+  return variable.m_SelectionType == adios2::SelectionType::WriteBlock
+             ? variable.m_BlockID
+             : 0;
+}
+
+}  // namespace
+
 /**
- * Begin a new step
+ * Begin a new step. Readers load the step's manifest and start fetching all
+ * of its variables, so the Get calls of the step only wait for data that is
+ * already in flight.
  * @param mode Step mode (Read, Append, Update)
  * @param timeoutSeconds Timeout in seconds (-1 for no timeout)
- * @return Step status
+ * @return Step status; EndOfStream for readers once no step is left
  */
 adios2::StepStatus IowarpEngine::BeginStep(adios2::StepMode mode,
                                            const float timeoutSeconds) {
@@ -158,6 +208,19 @@ adios2::StepStatus IowarpEngine::BeginStep(adios2::StepMode mode,
   IncrementCurrentStep();
   HLOG(kDebug, "[IowarpEngine] BeginStep() completed, step={}", current_step_);
 
+  if (IsReader_()) {
+    auto io_start = std::chrono::high_resolution_clock::now();
+    ReleaseReadStep_();
+    bool found = PrefetchStep_();
+    total_io_time_ms_ += std::chrono::duration<double, std::milli>(
+                             std::chrono::high_resolution_clock::now() -
+                             io_start)
+                             .count();
+    if (!found) {
+      return adios2::StepStatus::EndOfStream;
+    }
+  }
+
   return adios2::StepStatus::OK;
 }
 
@@ -172,21 +235,13 @@ void IowarpEngine::EndStep() {
   // Timing measurement for I/O operations
   auto io_start = std::chrono::high_resolution_clock::now();
 
-  // Process all deferred put tasks from this step
-  for (auto &deferred : deferred_tasks_) {
-    // Set TASK_DATA_OWNER flag so task destructor will free the buffer
-    auto *task_ptr = deferred.task.get();
-    if (task_ptr != nullptr) {
-      task_ptr->SetFlags(TASK_DATA_OWNER);
-    }
-
-    // Wait for task to complete
-    deferred.task.Wait();
+  if (IsReader_()) {
+    PerformGets();
+    ReleaseReadStep_();
+  } else {
+    FlushStep_();
   }
 
-  // Clear the deferred tasks vector for the next step
-  deferred_tasks_.clear();
-
   // Measure and log I/O time
   auto io_end = std::chrono::high_resolution_clock::now();
   double io_time_ms = std::chrono::duration<double, std::milli>(io_end - io_start).count();
@@ -207,6 +262,57 @@ void IowarpEngine::EndStep() {
  */
 size_t IowarpEngine::CurrentStep() const { return current_step_; }
 
+/**
+ * Submit the puts recorded since the last call. Variables are numbered in
+ * put order and sent kMaxPutBlobBatch at a time, so a step of N large
+ * variables costs ceil(N / 32) tasks instead of N.
+ */
+void IowarpEngine::PerformPuts() {
+  if (pending_puts_.empty()) {
+    return;
+  }
+  if (!current_tag_) {
+    throw std::runtime_error("IowarpEngine::PerformPuts: No active tag");
+  }
+
+  auto *cte_client = WRP_CTE_CLIENT;
+  std::string prefix = StepPrefix_(current_step_) + "var_";
+  std::vector<wrp_cte::core::PutBlobBatchEntry> entries;
+  entries.reserve(wrp_cte::core::kMaxPutBlobBatch);
+  for (PendingPut &put : pending_puts_) {
+    wrp_cte::core::PutBlobBatchEntry entry;
+    entry.blob_index_ = next_blob_index_++;
+    entry.offset_ = 0;
+    entry.size_ = put.size;
+    entry.data_ = put.data;
+    entries.push_back(entry);
+    step_vars_.push_back(StepVar{put.name, false, entry.blob_index_, put.size});
+    if (!put.buffer.IsNull()) {
+      step_buffers_.push_back(StepBuffer{std::move(put.buffer), put.capacity});
+    }
+    if (entries.size() == wrp_cte::core::kMaxPutBlobBatch) {
+      batch_tasks_.push_back(cte_client->AsyncPutBlobBatch(
+          current_tag_->GetTagId(), prefix, entries, 1.0f));
+      entries.clear();
+    }
+  }
+  if (!entries.empty()) {
+    batch_tasks_.push_back(cte_client->AsyncPutBlobBatch(
+        current_tag_->GetTagId(), prefix, entries, 1.0f));
+  }
+  pending_puts_.clear();
+}
+
+/**
+ * Serve the gets recorded since the last call from the step prefetch
+ */
+void IowarpEngine::PerformGets() {
+  for (const PendingGet &get : pending_gets_) {
+    ServeGet_(get.name, get.block, get.values, get.size);
+  }
+  pending_gets_.clear();
+}
+
 /**
  * Close the engine
  * @param transportIndex Transport index to close (-1 for all)
@@ -218,13 +324,288 @@ void IowarpEngine::DoClose(const int transportIndex) {
     return;
   }
 
+  // A writer closed without EndStep still publishes its last step
+  if (IsReader_()) {
+    ReleaseReadStep_();
+  } else if (!pending_puts_.empty() || !step_vars_.empty()) {
+    // DoClose also runs from the destructor, so failures are only logged
+    try {
+      FlushStep_();
+    } catch (const std::exception &e) {
+      HLOG(kError, "[IowarpEngine] DoClose: {}", e.what());
+    }
+  }
+
   // Clean up resources
   current_tag_.reset();
   open_ = false;
 }
 
 /**
- * Put data synchronously
+ * Blob name prefix of a step for this rank
+ * @param step Step number
+ * @return Prefix such as "step_3_rank_0_"
+ */
+std::string IowarpEngine::StepPrefix_(size_t step) const {
+  return "step_" + std::to_string(step) + "_rank_" + std::to_string(rank_) +
+         "_";
+}
+
+/**
+ * Check whether the engine was opened for reading
+ * @return True in Read or ReadRandomAccess mode
+ */
+bool IowarpEngine::IsReader_() const {
+  return m_OpenMode == adios2::Mode::Read ||
+         m_OpenMode == adios2::Mode::ReadRandomAccess;
+}
+
+/**
+ * Record a put of one variable block in the current step. Small blocks are
+ * copied into the step's packed area; larger ones wait for PerformPuts.
+ * @param name Variable name
+ * @param data Variable data
+ * @param size Bytes to put
+ * @param borrow Whether data may be read until EndStep (deferred puts)
+ */
+void IowarpEngine::QueuePut_(const std::string &name, const char *data,
+                             size_t size, bool borrow) {
+  if (data == nullptr && size > 0) {
+    throw std::runtime_error("IowarpEngine::QueuePut_: values pointer is null");
+  }
+
+  if (size <= kPackedVarBytes) {
+    step_vars_.push_back(StepVar{name, true, packed_.size(), size});
+    packed_.insert(packed_.end(), data, data + size);
+    return;
+  }
+
+  // Data already in a registered segment (CHI_IPC->AllocateUserShm) is put
+  // in place when the caller keeps it alive until EndStep
+  hipc::ShmPtr<> user_ptr;
+  if (borrow &&
+      wrp_cte::core::Tag::ResolveShmBuffer(data, size, user_ptr)) {
+    pending_puts_.push_back(
+        PendingPut{name, user_ptr, hipc::FullPtr<char>(), 0, size});
+    return;
+  }
+
+  // Otherwise copy into a buffer from the thread's staging pool
+  auto *ipc_manager = CHI_IPC;
+  size_t capacity = 0;
+  auto buffer = ipc_manager->AllocateStagingBuffer(size, capacity);
+  if (buffer.ptr_ == nullptr) {
+    throw std::runtime_error(
+        "IowarpEngine::QueuePut_: Failed to allocate buffer");
+  }
+  std::memcpy(buffer.ptr_, data, size);
+  hipc::ShmPtr<> shm = buffer.shm_.template Cast<void>();
+  pending_puts_.push_back(
+      PendingPut{name, shm, std::move(buffer), capacity, size});
+}
+
+/**
+ * Submit the remaining puts, write the step manifest and wait for every
+ * put of the step. The manifest lists each variable block in put order
+ * and carries the packed small variables, so readers find the whole step
+ * with one lookup.
+ * @throws std::runtime_error if any put of the step failed
+ */
+void IowarpEngine::FlushStep_() {
+  PerformPuts();
+
+  chi::u32 failed = 0;
+  if (!step_vars_.empty()) {
+    StepManifestHeader header{kStepManifestMagic,
+                              static_cast<chi::u32>(step_vars_.size()),
+                              packed_.size()};
+    std::vector<char> manifest(sizeof(header));
+    std::memcpy(manifest.data(), &header, sizeof(header));
+    for (const StepVar &var : step_vars_) {
+      StepManifestEntry entry{static_cast<chi::u32>(var.name.size()),
+                              var.packed ? 1u : 0u, var.where, var.size};
+      const char *raw = reinterpret_cast<const char *>(&entry);
+      manifest.insert(manifest.end(), raw, raw + sizeof(entry));
+      manifest.insert(manifest.end(), var.name.begin(), var.name.end());
+    }
+    manifest.insert(manifest.end(), packed_.begin(), packed_.end());
+
+    // Puts of the step are already in flight, so this overlaps them
+    try {
+      current_tag_->PutBlob(StepPrefix_(current_step_) + "manifest",
+                            manifest.data(), manifest.size(), 0, 1.0f);
+    } catch (const std::exception &e) {
+      HLOG(kError, "[IowarpEngine] Step {} manifest put failed: {}",
+           current_step_, e.what());
+      ++failed;
+    }
+  }
+
+  for (auto &task : batch_tasks_) {
+    task.Wait();
+    failed += task->failed_;
+  }
+
+  // Staged copies go back to the pool; in-place puts borrowed user memory
+  auto *ipc_manager = CHI_IPC;
+  for (StepBuffer &staged : step_buffers_) {
+    ipc_manager->FreeStagingBuffer(staged.buffer, staged.capacity);
+  }
+
+  batch_tasks_.clear();
+  step_buffers_.clear();
+  step_vars_.clear();
+  packed_.clear();
+  next_blob_index_ = 0;
+
+  if (failed > 0) {
+    throw std::runtime_error("IowarpEngine::EndStep: " +
+                             std::to_string(failed) + " put(s) of step " +
+                             std::to_string(current_step_) + " failed");
+  }
+}
+
+/**
+ * Load the manifest of the current step and start a GetBlob for each of its
+ * variable blobs, all in flight at once
+ * @return false if the step has no manifest
+ */
+bool IowarpEngine::PrefetchStep_() {
+  std::string prefix = StepPrefix_(current_step_);
+  std::string manifest_name = prefix + "manifest";
+  chi::u64 manifest_size = current_tag_->GetBlobSize(manifest_name);
+  if (manifest_size < sizeof(StepManifestHeader)) {
+    return false;
+  }
+  read_manifest_.resize(manifest_size);
+  current_tag_->GetBlob(manifest_name, read_manifest_.data(), manifest_size,
+                        0);
+
+  StepManifestHeader header;
+  std::memcpy(&header, read_manifest_.data(), sizeof(header));
+  if (header.magic != kStepManifestMagic) {
+    throw std::runtime_error("IowarpEngine::BeginStep: Bad manifest for step " +
+                             std::to_string(current_step_));
+  }
+
+  // Parse the table; packed data follows it
+  size_t pos = sizeof(header);
+  std::vector<StepVar> vars;
+  vars.reserve(header.num_vars);
+  for (chi::u32 i = 0; i < header.num_vars; ++i) {
+    StepManifestEntry entry;
+    if (pos + sizeof(entry) > manifest_size) {
+      throw std::runtime_error(
+          "IowarpEngine::BeginStep: Truncated manifest for step " +
+          std::to_string(current_step_));
+    }
+    std::memcpy(&entry, read_manifest_.data() + pos, sizeof(entry));
+    pos += sizeof(entry);
+    if (pos + entry.name_len > manifest_size) {
+      throw std::runtime_error(
+          "IowarpEngine::BeginStep: Truncated manifest for step " +
+          std::to_string(current_step_));
+    }
+    vars.push_back(StepVar{std::string(read_manifest_.data() + pos,
+                                       entry.name_len),
+                           entry.packed != 0, entry.where, entry.size});
+    pos += entry.name_len;
+  }
+  size_t packed_base = pos;
+  if (packed_base + header.packed_bytes > manifest_size) {
+    throw std::runtime_error(
+        "IowarpEngine::BeginStep: Truncated manifest for step " +
+        std::to_string(current_step_));
+  }
+
+  auto *ipc_manager = CHI_IPC;
+  auto *cte_client = WRP_CTE_CLIENT;
+  for (StepVar &var : vars) {
+    if (var.packed) {
+      // Packed offsets become offsets into read_manifest_
+      var.where += packed_base;
+    } else {
+      PrefetchedVar fetch;
+      fetch.size = var.size;
+      fetch.capacity = 0;
+      fetch.waited = false;
+      fetch.buffer = ipc_manager->AllocateStagingBuffer(var.size,
+                                                        fetch.capacity);
+      if (fetch.buffer.ptr_ == nullptr) {
+        throw std::runtime_error(
+            "IowarpEngine::BeginStep: Failed to allocate buffer");
+      }
+      fetch.task = cte_client->AsyncGetBlob(
+          current_tag_->GetTagId(), prefix + "var_" + std::to_string(var.where),
+          0, var.size, 0, fetch.buffer.shm_.template Cast<void>());
+      prefetched_.emplace(var.where, std::move(fetch));
+    }
+    read_vars_[var.name].push_back(var);
+  }
+  read_step_ = current_step_;
+  return true;
+}
+
+/**
+ * Wait for the read step's outstanding prefetches and free their buffers
+ */
+void IowarpEngine::ReleaseReadStep_() {
+  auto *ipc_manager = CHI_IPC;
+  for (auto &entry : prefetched_) {
+    PrefetchedVar &fetch = entry.second;
+    // The runtime may still write a prefetch that was never read
+    if (!fetch.waited) {
+      fetch.task.Wait();
+    }
+    ipc_manager->FreeStagingBuffer(fetch.buffer, fetch.capacity);
+  }
+  prefetched_.clear();
+  read_vars_.clear();
+  read_manifest_.clear();
+  pending_gets_.clear();
+  read_step_ = SIZE_MAX;
+}
+
+/**
+ * Copy a variable block of the read step into values
+ * @param name Variable name
+ * @param block Block of the variable in put order
+ * @param values Output buffer
+ * @param size Bytes to copy (at most the block size)
+ */
+void IowarpEngine::ServeGet_(const std::string &name, size_t block,
+                             char *values, size_t size) {
+  if (read_step_ != current_step_) {
+    throw std::runtime_error("IowarpEngine: Get outside of a read step");
+  }
+  auto it = read_vars_.find(name);
+  if (it == read_vars_.end() || block >= it->second.size()) {
+    throw std::runtime_error("IowarpEngine: Variable " + name + " block " +
+                             std::to_string(block) + " not in step " +
+                             std::to_string(current_step_));
+  }
+  const StepVar &var = it->second[block];
+  size_t bytes = std::min<size_t>(size, var.size);
+  if (var.packed) {
+    std::memcpy(values, read_manifest_.data() + var.where, bytes);
+    return;
+  }
+
+  PrefetchedVar &fetch = prefetched_.at(var.where);
+  if (!fetch.waited) {
+    fetch.task.Wait();
+    fetch.waited = true;
+  }
+  if (fetch.task->GetReturnCode() != 0) {
+    throw std::runtime_error("IowarpEngine: Failed to get variable " + name);
+  }
+  std::memcpy(values, fetch.buffer.ptr_, bytes);
+}
+
+/**
+ * Put data synchronously. ADIOS2 lets values be reused once the call
+ * returns, so the data is staged and the step's pending puts are submitted
+ * right away.
  * @tparam T Data type
  * @param variable ADIOS2 variable
  * @param values Data pointer
@@ -241,28 +622,10 @@ void IowarpEngine::DoPutSync_(const adios2::core::Variable<T> &variable,
     throw std::runtime_error("IowarpEngine::DoPutSync_: No active tag");
   }
 
-  // Calculate blob name from variable name, current step, and rank
-  std::string blob_name =
-      variable.m_Name + "_step_" + std::to_string(current_step_) +
-      "_rank_" + std::to_string(rank_);
-
-  // Calculate data size using m_Count (local selection size), not m_Shape (global)
-  size_t element_count = 1;
-  if (!variable.m_Count.empty()) {
-    for (size_t dim : variable.m_Count) {
-      element_count *= dim;
-    }
-  } else if (!variable.m_Shape.empty()) {
-    for (size_t dim : variable.m_Shape) {
-      element_count *= dim;
-    }
-  }
-  size_t data_size = element_count * sizeof(T);
-
-  // Put blob to CTE synchronously
   try {
-    current_tag_->PutBlob(blob_name, reinterpret_cast<const char *>(values),
-                          data_size, 0, 1.0f);
+    QueuePut_(variable.m_Name, reinterpret_cast<const char *>(values),
+              VariableBytes(variable), false);
+    PerformPuts();
   } catch (const std::exception &e) {
     throw std::runtime_error(
         std::string("IowarpEngine::DoPutSync_: Failed to put blob: ") +
@@ -271,7 +634,8 @@ void IowarpEngine::DoPutSync_(const adios2::core::Variable<T> &variable,
 }
 
 /**
- * Put data asynchronously
+ * Put data asynchronously. The put is recorded and submitted with the rest
+ * of the step by PerformPuts or EndStep.
  * @tparam T Data type
  * @param variable ADIOS2 variable
  * @param values Data pointer
@@ -288,56 +652,9 @@ void IowarpEngine::DoPutDeferred_(const adios2::core::Variable<T> &variable,
     throw std::runtime_error("IowarpEngine::DoPutDeferred_: No active tag");
   }
 
-  // Calculate blob name from variable name, current step, and rank
-  // Each rank writes its own portion with a unique blob name
-  std::string blob_name =
-      variable.m_Name + "_step_" + std::to_string(current_step_) +
-      "_rank_" + std::to_string(rank_);
-
-  // Calculate data size using m_Count (local selection size), not m_Shape (global)
-  // In MPI applications, each rank only has a portion of the global array
-  size_t element_count = 1;
-  if (!variable.m_Count.empty()) {
-    // Use local count if available (for selections/MPI decomposition)
-    for (size_t dim : variable.m_Count) {
-      element_count *= dim;
-    }
-  } else if (!variable.m_Shape.empty()) {
-    // Fall back to global shape if no selection
-    for (size_t dim : variable.m_Shape) {
-      element_count *= dim;
-    }
-  }
-  size_t data_size = element_count * sizeof(T);
-
-  // Put blob asynchronously
   try {
-    auto *ipc_manager = CHI_IPC;
-    if (ipc_manager == nullptr) {
-      throw std::runtime_error("IowarpEngine::DoPutDeferred_: CHI_IPC is null");
-    }
-
-    // Allocate shared memory buffer and copy data
-    auto buffer = ipc_manager->AllocateBuffer(data_size);
-    if (buffer.ptr_ == nullptr) {
-      throw std::runtime_error(
-          "IowarpEngine::DoPutDeferred_: Failed to allocate buffer");
-    }
-
-    // Check if values pointer is valid
-    if (values == nullptr) {
-      throw std::runtime_error(
-          "IowarpEngine::DoPutDeferred_: values pointer is null");
-    }
-
-    std::memcpy(buffer.ptr_, values, data_size);
-
-    auto task = current_tag_->AsyncPutBlob(
-        blob_name, buffer.shm_.template Cast<void>(), data_size, 0, 1.0f);
-
-    // Store task and buffer in deferred_tasks_ vector
-    // Buffer will be kept alive until EndStep processes the task
-    deferred_tasks_.emplace_back(DeferredTask{std::move(task), std::move(buffer)});
+    QueuePut_(variable.m_Name, reinterpret_cast<const char *>(values),
+              VariableBytes(variable), true);
   } catch (const std::exception &e) {
     throw std::runtime_error(
         std::string("IowarpEngine::DoPutDeferred_: Failed to put blob: ") +
@@ -346,7 +663,7 @@ void IowarpEngine::DoPutDeferred_(const adios2::core::Variable<T> &variable,
 }
 
 /**
- * Get data synchronously
+ * Get data synchronously from the step prefetch
  * @tparam T Data type
  * @param variable ADIOS2 variable
  * @param values Output buffer
@@ -363,28 +680,9 @@ void IowarpEngine::DoGetSync_(const adios2::core::Variable<T> &variable,
     throw std::runtime_error("IowarpEngine::DoGetSync_: No active tag");
   }
 
-  // Calculate blob name from variable name, current step, and rank
-  std::string blob_name =
-      variable.m_Name + "_step_" + std::to_string(current_step_) +
-      "_rank_" + std::to_string(rank_);
-
-  // Calculate expected data size using m_Count (local selection size)
-  size_t element_count = 1;
-  if (!variable.m_Count.empty()) {
-    for (size_t dim : variable.m_Count) {
-      element_count *= dim;
-    }
-  } else if (!variable.m_Shape.empty()) {
-    for (size_t dim : variable.m_Shape) {
-      element_count *= dim;
-    }
-  }
-  size_t expected_size = element_count * sizeof(T);
-
-  // Get blob from CTE synchronously
   try {
-    current_tag_->GetBlob(blob_name, reinterpret_cast<char *>(values),
-                          expected_size, 0);
+    ServeGet_(variable.m_Name, SelectedBlock(variable),
+              reinterpret_cast<char *>(values), VariableBytes(variable));
   } catch (const std::exception &e) {
     throw std::runtime_error(
         std::string("IowarpEngine::DoGetSync_: Failed to get blob: ") +
@@ -393,7 +691,8 @@ void IowarpEngine::DoGetSync_(const adios2::core::Variable<T> &variable,
 }
 
 /**
- * Get data asynchronously
+ * Get data asynchronously. The get is served by PerformGets or EndStep;
+ * its data is usually already prefetched by then.
  * @tparam T Data type
  * @param variable ADIOS2 variable
  * @param values Output buffer
@@ -410,9 +709,9 @@ void IowarpEngine::DoGetDeferred_(const adios2::core::Variable<T> &variable,
     throw std::runtime_error("IowarpEngine::DoGetDeferred_: No active tag");
   }
 
-  // For now, just call the sync version
-  // In production, should use async API and track the Future
-  DoGetSync_(variable, values);
+  pending_gets_.push_back(PendingGet{variable.m_Name, SelectedBlock(variable),
+                                     reinterpret_cast<char *>(values),
+                                     VariableBytes(variable)});
 }
 
 }  // namespace coeus
@@ -42,6 +42,12 @@
 #include <wrp_cte/core/core_client.h>
 #include <wrp_cte/core/core_tasks.h>
 
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace coeus {
 
 class IowarpEngine : public adios2::plugin::PluginEngineInterface {
@@ -72,6 +78,19 @@ class IowarpEngine : public adios2::plugin::PluginEngineInterface {
    * */
   size_t CurrentStep() const override;
 
+  /**
+   * Submit the deferred puts of this step. The puts are grouped into
+   * PutBlobBatch tasks of up to kMaxPutBlobBatch variables each. EndStep
+   * waits for them.
+   */
+  void PerformPuts() override;
+
+  /** Serve the deferred gets of this step from the step prefetch */
+  void PerformGets() override;
+
+  /** Variables at most this large are packed into the step manifest blob */
+  static constexpr size_t kPackedVarBytes = 4096;
+
  protected:
   /** Initialize parameters */
   void InitParameters() override {}
@@ -125,12 +144,80 @@ class IowarpEngine : public adios2::plugin::PluginEngineInterface {
 #undef declare_type
 
  private:
-  /** Structure to hold deferred task and its buffer */
-  struct DeferredTask {
-    chi::Future<wrp_cte::core::PutBlobTask> task;
+  /** A put recorded during the step, submitted by PerformPuts */
+  struct PendingPut {
+    std::string name;            /**< Variable name */
+    hipc::ShmPtr<> data;         /**< User shm or staging copy */
+    hipc::FullPtr<char> buffer;  /**< Staging copy; null for in-place puts */
+    size_t capacity;             /**< Staging capacity of buffer */
+    size_t size;                 /**< Bytes to put */
+  };
+
+  /** A staging buffer held until the step's puts complete */
+  struct StepBuffer {
     hipc::FullPtr<char> buffer;
+    size_t capacity;
+  };
+
+  /** Manifest record of one variable block written in a step */
+  struct StepVar {
+    std::string name;  /**< Variable name */
+    bool packed;       /**< Stored in the manifest blob */
+    chi::u64 where;    /**< Packed offset, or index of the variable blob */
+    chi::u64 size;     /**< Bytes */
   };
 
+  /** A variable blob of the read step, fetched ahead of the Get calls */
+  struct PrefetchedVar {
+    chi::Future<wrp_cte::core::GetBlobTask> task;
+    hipc::FullPtr<char> buffer;
+    size_t capacity;
+    size_t size;
+    bool waited;  /**< task.Wait() has returned */
+  };
+
+  /** A deferred get served by PerformGets */
+  struct PendingGet {
+    std::string name;
+    size_t block;  /**< Block of the variable (put order) */
+    char *values;
+    size_t size;
+  };
+
+  /** Blob name prefix shared by a step's blobs for this rank */
+  std::string StepPrefix_(size_t step) const;
+
+  /** Whether the engine was opened for reading */
+  bool IsReader_() const;
+
+  /** Record a put of size bytes; staged copies if borrow is false */
+  void QueuePut_(const std::string &name, const char *data, size_t size,
+                 bool borrow);
+
+  /**
+   * Write the manifest (variable table plus packed small variables) and
+   * wait for every put of the step
+   */
+  void FlushStep_();
+
+  /**
+   * Load the current step's manifest and start GetBlobs for all of its
+   * non-packed variables
+   * @return false if the step has no manifest
+   */
+  bool PrefetchStep_();
+
+  /** Free the read step's buffers */
+  void ReleaseReadStep_();
+
+  /**
+   * Copy a variable block of the read step into values, waiting for its
+   * prefetch if needed
+   * @throws std::runtime_error if the step has no such variable
+   */
+  void ServeGet_(const std::string &name, size_t block, char *values,
+                 size_t size);
+
   /** CTE Tag for this ADIOS file/session */
   std::unique_ptr<wrp_cte::core::Tag> current_tag_;
 
@@ -143,8 +230,38 @@ class IowarpEngine : public adios2::plugin::PluginEngineInterface {
   /** Engine open status */
   bool open_;
 
-  /** Vector of deferred put tasks for current step */
-  std::vector<DeferredTask> deferred_tasks_;
+  /** Puts recorded since the last PerformPuts */
+  std::vector<PendingPut> pending_puts_;
+
+  /** Batched put tasks of the current step */
+  std::vector<chi::Future<wrp_cte::core::PutBlobBatchTask>> batch_tasks_;
+
+  /** Staging buffers of submitted puts, freed once the step completes */
+  std::vector<StepBuffer> step_buffers_;
+
+  /** Variable table of the step being written */
+  std::vector<StepVar> step_vars_;
+
+  /** Small variables of the step being written, packed back to back */
+  std::vector<char> packed_;
+
+  /** Index of the next variable blob of the step being written */
+  chi::u64 next_blob_index_;
+
+  /** Manifest of the read step (its table entries point into it) */
+  std::vector<char> read_manifest_;
+
+  /** Variable blocks of the read step, by name in put order */
+  std::unordered_map<std::string, std::vector<StepVar>> read_vars_;
+
+  /** Prefetches of the read step, keyed by blob index */
+  std::unordered_map<chi::u64, PrefetchedVar> prefetched_;
+
+  /** Step whose manifest is loaded (SIZE_MAX = none) */
+  size_t read_step_;
+
+  /** Gets recorded since the last PerformGets */
+  std::vector<PendingGet> pending_gets_;
 
   /** Total I/O time in milliseconds */
   double total_io_time_ms_;
@@ -160,6 +160,75 @@ bool CaeConfig::LoadFromYaml(const YAML::Node &config) {
       interception_enabled_ = config["interception_enabled"].as<bool>();
     }
 
+    // Load page cache settings (optional)
+    if (config["adapter_readahead_pages"]) {
+      adapter_readahead_pages_ =
+          config["adapter_readahead_pages"].as<size_t>();
+    }
+    if (config["adapter_write_behind"]) {
+      adapter_write_behind_ = config["adapter_write_behind"].as<bool>();
+    }
+
+    // Load file placement settings (optional)
+    if (config["adapter_tag_placement"]) {
+      std::string placement = config["adapter_tag_placement"].as<std::string>();
+      if (placement == "blob" || placement == "tag" || placement == "stripe" ||
+          placement == "creator") {
+        adapter_tag_placement_ = placement;
+      } else {
+        HLOG(kWarning, "Unknown adapter tag placement '{}', using 'blob'",
+             placement);
+        adapter_tag_placement_ = "blob";
+      }
+    }
+    if (config["adapter_stripe_pages"]) {
+      adapter_stripe_pages_ = config["adapter_stripe_pages"].as<size_t>();
+      if (adapter_stripe_pages_ == 0) {
+        HLOG(kWarning, "Invalid adapter stripe pages 0, using default 256");
+        adapter_stripe_pages_ = 256;
+      }
+    }
+
+    // Load blob mapper settings (optional)
+    if (config["adapter_mapper"]) {
+      std::string mapper = config["adapter_mapper"].as<std::string>();
+      if (mapper == "balanced" || mapper == "adaptive") {
+        adapter_mapper_ = mapper;
+      } else {
+        HLOG(kWarning, "Unknown adapter mapper '{}', using 'balanced'",
+             mapper);
+        adapter_mapper_ = "balanced";
+      }
+    }
+    if (config["adapter_max_extent_pages"]) {
+      adapter_max_extent_pages_ =
+          config["adapter_max_extent_pages"].as<size_t>();
+      if (adapter_max_extent_pages_ == 0) {
+        HLOG(kWarning, "Invalid adapter max extent pages 0, using default 256");
+        adapter_max_extent_pages_ = 256;
+      }
+    }
+
+    // Load metadata cache settings (optional)
+    if (config["adapter_meta_cache_ttl_ms"]) {
+      adapter_meta_cache_ttl_ms_ =
+          config["adapter_meta_cache_ttl_ms"].as<size_t>();
+    }
+
+    // Load HDF5 VFD metadata cache settings (optional)
+    if (config["vfd_meta_cache_size"]) {
+      vfd_meta_cache_size_ = hshm::ConfigParse::ParseSize(
+          config["vfd_meta_cache_size"].as<std::string>());
+    }
+    if (config["vfd_meta_block_size"]) {
+      vfd_meta_block_size_ = hshm::ConfigParse::ParseSize(
+          config["vfd_meta_block_size"].as<std::string>());
+      if (vfd_meta_block_size_ == 0) {
+        HLOG(kWarning, "Invalid VFD metadata block size 0, using 64KB");
+        vfd_meta_block_size_ = 64 << 10;
+      }
+    }
+
     size_t include_count =
         std::count_if(patterns_.begin(), patterns_.end(),
                       [](const PathPattern &p) { return p.include; });
@@ -235,6 +304,25 @@ std::string CaeConfig::ToYamlString() const {
   // Add interception enabled setting
   config["interception_enabled"] = interception_enabled_;
 
+  // Add page cache settings
+  config["adapter_readahead_pages"] = adapter_readahead_pages_;
+  config["adapter_write_behind"] = adapter_write_behind_;
+
+  // Add file placement settings
+  config["adapter_tag_placement"] = adapter_tag_placement_;
+  config["adapter_stripe_pages"] = adapter_stripe_pages_;
+
+  // Add blob mapper settings
+  config["adapter_mapper"] = adapter_mapper_;
+  config["adapter_max_extent_pages"] = adapter_max_extent_pages_;
+
+  // Add metadata cache settings
+  config["adapter_meta_cache_ttl_ms"] = adapter_meta_cache_ttl_ms_;
+
+  // Add HDF5 VFD metadata cache settings
+  config["vfd_meta_cache_size"] = vfd_meta_cache_size_;
+  config["vfd_meta_block_size"] = vfd_meta_block_size_;
+
   YAML::Emitter emitter;
   emitter << config;
 
@@ -62,9 +62,24 @@ public:
   std::vector<PathPattern> patterns_;     // Include/exclude patterns sorted by specificity
   size_t adapter_page_size_;              // Page size for adapter operations (bytes)
   bool interception_enabled_;             // Global enable/disable for interception
+  size_t adapter_readahead_pages_;        // Max readahead window (0 disables)
+  bool adapter_write_behind_;             // Buffer sub-page writes client-side
+  std::string adapter_tag_placement_;     // blob, tag, stripe or creator
+  size_t adapter_stripe_pages_;           // Pages per stripe for "stripe"
+  std::string adapter_mapper_;            // balanced or adaptive
+  size_t adapter_max_extent_pages_;       // Largest adaptive extent (pages)
+  size_t adapter_meta_cache_ttl_ms_;      // Metadata lease time (0 disables)
+  size_t vfd_meta_cache_size_;            // HDF5 VFD metadata cache (bytes)
+  size_t vfd_meta_block_size_;            // HDF5 VFD metadata block (bytes)
 
   // Default constructor
-  CaeConfig() : adapter_page_size_(4096), interception_enabled_(true) {}
+  CaeConfig()
+      : adapter_page_size_(4096), interception_enabled_(true),
+        adapter_readahead_pages_(8), adapter_write_behind_(false),
+        adapter_tag_placement_("blob"), adapter_stripe_pages_(256),
+        adapter_mapper_("balanced"), adapter_max_extent_pages_(256),
+        adapter_meta_cache_ttl_ms_(1000), vfd_meta_cache_size_(16 << 20),
+        vfd_meta_block_size_(64 << 10) {}
   
   /**
    * Load configuration from YAML file
@@ -131,6 +146,128 @@ public:
    */
   void SetAdapterPageSize(size_t page_size) { adapter_page_size_ = page_size; }
 
+  /**
+   * Get the maximum readahead window of the adapter page cache
+   * @return Window in pages; 0 means readahead is disabled
+   */
+  size_t GetAdapterReadaheadPages() const { return adapter_readahead_pages_; }
+
+  /**
+   * Set the maximum readahead window of the adapter page cache
+   * @param pages Window in pages; 0 disables readahead
+   */
+  void SetAdapterReadaheadPages(size_t pages) {
+    adapter_readahead_pages_ = pages;
+  }
+
+  /**
+   * Check if write-behind buffering of sub-page writes is enabled
+   * @return true if small writes are acknowledged once buffered
+   */
+  bool IsAdapterWriteBehindEnabled() const { return adapter_write_behind_; }
+
+  /**
+   * Enable or disable write-behind buffering of sub-page writes
+   * @param enable true to buffer and coalesce small writes until fsync/close
+   */
+  void SetAdapterWriteBehind(bool enable) { adapter_write_behind_ = enable; }
+
+  /**
+   * Get how the pages of a file are placed on containers
+   * @return "blob" (hash each page), "tag" (whole file on one container),
+   * "stripe" (runs of adapter_stripe_pages_ pages) or "creator" (the node
+   * that first opened the file)
+   */
+  const std::string &GetAdapterTagPlacement() const {
+    return adapter_tag_placement_;
+  }
+
+  /**
+   * Set how the pages of a file are placed on containers
+   * @param placement "blob", "tag", "stripe" or "creator"
+   */
+  void SetAdapterTagPlacement(const std::string &placement) {
+    adapter_tag_placement_ = placement;
+  }
+
+  /**
+   * Get the stripe width used by the "stripe" placement
+   * @return Consecutive pages kept on one container
+   */
+  size_t GetAdapterStripePages() const { return adapter_stripe_pages_; }
+
+  /**
+   * Set the stripe width used by the "stripe" placement
+   * @param pages Consecutive pages kept on one container
+   */
+  void SetAdapterStripePages(size_t pages) { adapter_stripe_pages_ = pages; }
+
+  /**
+   * Get how file ranges are mapped onto blobs
+   * @return "balanced" (fixed pages) or "adaptive" (extents that grow with
+   * sequential writes, pages otherwise)
+   */
+  const std::string &GetAdapterMapper() const { return adapter_mapper_; }
+
+  /**
+   * Set how file ranges are mapped onto blobs
+   * @param mapper "balanced" or "adaptive"
+   */
+  void SetAdapterMapper(const std::string &mapper) { adapter_mapper_ = mapper; }
+
+  /**
+   * Get the largest extent the "adaptive" mapper may grow
+   * @return Maximum extent size in pages
+   */
+  size_t GetAdapterMaxExtentPages() const { return adapter_max_extent_pages_; }
+
+  /**
+   * Set the largest extent the "adaptive" mapper may grow
+   * @param pages Maximum extent size in pages
+   */
+  void SetAdapterMaxExtentPages(size_t pages) {
+    adapter_max_extent_pages_ = pages;
+  }
+
+  /**
+   * Get how long cached file metadata (tag ID, size) may be used without
+   * asking the runtime
+   * @return Lease time in milliseconds; 0 disables the metadata cache
+   */
+  size_t GetAdapterMetaCacheTtlMs() const { return adapter_meta_cache_ttl_ms_; }
+
+  /**
+   * Set how long cached file metadata may be used without asking the runtime
+   * @param ttl_ms Lease time in milliseconds; 0 disables the metadata cache
+   */
+  void SetAdapterMetaCacheTtlMs(size_t ttl_ms) {
+    adapter_meta_cache_ttl_ms_ = ttl_ms;
+  }
+
+  /**
+   * Get the capacity of the HDF5 VFD metadata block cache
+   * @return Capacity in bytes; 0 disables the cache
+   */
+  size_t GetVfdMetaCacheSize() const { return vfd_meta_cache_size_; }
+
+  /**
+   * Set the capacity of the HDF5 VFD metadata block cache
+   * @param size Capacity in bytes; 0 disables the cache
+   */
+  void SetVfdMetaCacheSize(size_t size) { vfd_meta_cache_size_ = size; }
+
+  /**
+   * Get the size of the aligned blocks the HDF5 VFD caches metadata in
+   * @return Block size in bytes
+   */
+  size_t GetVfdMetaBlockSize() const { return vfd_meta_block_size_; }
+
+  /**
+   * Set the size of the aligned blocks the HDF5 VFD caches metadata in
+   * @param size Block size in bytes
+   */
+  void SetVfdMetaBlockSize(size_t size) { vfd_meta_block_size_ = size; }
+
   /**
    * Get list of all patterns
    * @return Vector of path patterns
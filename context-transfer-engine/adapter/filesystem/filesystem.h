@@ -45,6 +45,7 @@
 #include <future>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "adapter/adapter_types.h"
 #include "adapter/cae_config.h"
@@ -117,9 +118,12 @@ public:
       // Use singleton client that should be configured globally
 
       // Create Tag object for this file - Tag constructor handles
-      // GetOrCreateTag
-      wrp_cte::core::Tag file_tag(stat.path_);
-      stat.tag_id_ = file_tag.GetTagId();
+      // GetOrCreateTag. A leased tag ID from an earlier open skips the IPC.
+      if (!mdm->meta_cache_.GetTagId(stat.path_, stat.tag_id_)) {
+        wrp_cte::core::Tag file_tag(stat.path_, GetFilePlacement());
+        stat.tag_id_ = file_tag.GetTagId();
+        mdm->meta_cache_.PutTagId(stat.path_, stat.tag_id_);
+      }
 
       if (stat.hflags_.Any(WRP_CTE_FS_TRUNC)) {
         // The file was opened with TRUNCATION
@@ -137,6 +141,27 @@ public:
       } else {
         stat.st_ptr_ = 0;
       }
+      // Per-file extent map of the adaptive mapper. The page cache works
+      // in page blobs, so such files go without it.
+      auto *cae_config = WRP_CAE_CONF;
+      if (stat.adapter_mode_ != AdapterMode::kBypass &&
+          cae_config->GetAdapterMapper() == "adaptive") {
+        stat.extent_map_ = std::make_shared<ExtentMap>(
+            stat.page_size_,
+            cae_config->GetAdapterMaxExtentPages() * stat.page_size_,
+            stat.file_size_);
+        if (!stat.hflags_.Any(WRP_CTE_FS_TRUNC)) {
+          LoadExtents(stat);
+        }
+      }
+      // Per-file readahead / write-behind page cache
+      size_t readahead = cae_config->GetAdapterReadaheadPages();
+      bool write_behind = cae_config->IsAdapterWriteBehindEnabled();
+      if (stat.adapter_mode_ != AdapterMode::kBypass && !stat.extent_map_ &&
+          (readahead > 0 || write_behind)) {
+        stat.page_cache_ = std::make_shared<FilePageCache>(
+            stat.page_size_, readahead, write_behind);
+      }
       // Allocate internal hermes data
       auto stat_ptr = std::make_shared<AdapterStat>(stat);
       FilesystemIoClientState fs_ctx(&mdm->fs_mdm_, (void *)stat_ptr.get());
@@ -148,7 +173,30 @@ public:
     }
   }
 
-private:
+protected:
+  /** Map the configured adapter_tag_placement to a tag placement policy */
+  static wrp_cte::core::TagPlacement GetFilePlacement() {
+    using wrp_cte::core::TagPlacement;
+    using wrp_cte::core::TagPlacementPolicy;
+    auto *cae_config = WRP_CAE_CONF;
+    if (!cae_config) {
+      return TagPlacement();
+    }
+    const std::string &placement = cae_config->GetAdapterTagPlacement();
+    if (placement == "tag") {
+      return TagPlacement(TagPlacementPolicy::kHashTag);
+    }
+    if (placement == "stripe") {
+      return TagPlacement(
+          TagPlacementPolicy::kStripe,
+          static_cast<chi::u32>(cae_config->GetAdapterStripePages()));
+    }
+    if (placement == "creator") {
+      return TagPlacement(TagPlacementPolicy::kPinCreator);
+    }
+    return TagPlacement();
+  }
+
   /** Helper function to calculate page index from offset */
   static size_t CalculatePageIndex(size_t offset, size_t page_size) {
     return offset / page_size;
@@ -165,6 +213,208 @@ private:
     return page_size - page_offset;
   }
 
+  /**
+   * Split a byte range of a file into per-page blob extents
+   * @param off File offset of the first byte
+   * @param total_size Number of bytes in the range
+   * @param page_size Adapter page size (one blob per page)
+   * @return Extents named by stringified page index, in file order
+   */
+  static std::vector<wrp_cte::core::BlobExtent> BuildPageExtents(
+      size_t off, size_t total_size, size_t page_size) {
+    std::vector<wrp_cte::core::BlobExtent> extents;
+    extents.reserve(total_size / page_size + 2);
+    size_t bytes_mapped = 0;
+    size_t current_offset = off;
+    while (bytes_mapped < total_size) {
+      size_t page_index = CalculatePageIndex(current_offset, page_size);
+      size_t page_offset = CalculatePageOffset(current_offset, page_size);
+      size_t bytes_in_page =
+          std::min(CalculateRemainingPageSpace(current_offset, page_size),
+                   total_size - bytes_mapped);
+      extents.push_back(wrp_cte::core::BlobExtent{
+          std::to_string(page_index), page_offset, bytes_in_page});
+      bytes_mapped += bytes_in_page;
+      current_offset += bytes_in_page;
+    }
+    return extents;
+  }
+
+  /** The adaptive mapper shared by all files that use extents */
+  static AdaptiveMapper *GetAdaptiveMapper() {
+    return static_cast<AdaptiveMapper *>(
+        MapperFactory::Get(MapperType::kAdaptiveMapper));
+  }
+
+  /**
+   * Record the extent blobs already in the file's tag, e.g. those written
+   * by other processes
+   * @param stat File statistics with an extent map
+   */
+  static void LoadExtents(AdapterStat &stat) {
+    wrp_cte::core::Tag file_tag(stat.tag_id_);
+    for (const std::string &name : file_tag.GetContainedBlobs()) {
+      size_t ext_off;
+      if (ExtentMap::ParseExtentName(name, ext_off)) {
+        stat.extent_map_->AddExtent(ext_off, file_tag.GetBlobSize(name));
+      }
+    }
+  }
+
+  /**
+   * Write a byte range as page blobs, going through write-behind when the
+   * file has it enabled and the write is smaller than a page
+   * @param stat File statistics
+   * @param off File offset of the first byte
+   * @param data Data to write
+   * @param total_size Number of bytes to write
+   * @return Bytes written, counted as a leading run from \a off
+   * @throws std::runtime_error if shared memory cannot be allocated
+   */
+  size_t WritePages(AdapterStat &stat, size_t off, const char *data,
+                    size_t total_size) {
+    FilePageCache *cache = stat.page_cache_.get();
+    if (cache) {
+      cache->Invalidate(off, total_size);
+      if (cache->WriteBehindEnabled() && total_size < stat.page_size_ &&
+          cache->BufferWrite(stat.tag_id_, off, data, total_size)) {
+        return total_size;
+      }
+      // Older buffered bytes must land before this write overwrites them
+      if (!cache->Flush(stat.tag_id_)) {
+        return 0;
+      }
+    }
+    auto mdm = WRP_CTE_FS_METADATA_MANAGER;
+    mdm->meta_cache_.InvalidateSize(stat.path_);
+    wrp_cte::core::Tag file_tag(stat.tag_id_);
+    std::vector<wrp_cte::core::BlobExtent> extents =
+        stat.extent_map_
+            ? GetAdaptiveMapper()->MapWrite(*stat.extent_map_, off, total_size)
+            : BuildPageExtents(off, total_size, stat.page_size_);
+    return file_tag.PutBlobBatch(extents, data);
+  }
+
+  /**
+   * Append data at the end of the file as one runtime-side AppendBlob
+   * @param stat File statistics
+   * @param data Data to append
+   * @param total_size Number of bytes to append
+   * @return File offset the runtime reserved for the data
+   * @throws std::runtime_error if buffered pages cannot be written back or
+   * the append fails
+   */
+  size_t AppendPages(AdapterStat &stat, const char *data, size_t total_size) {
+    FilePageCache *cache = stat.page_cache_.get();
+    // The cursor is seeded from the tag size, so buffered bytes must land
+    if (cache && !cache->Flush(stat.tag_id_)) {
+      throw std::runtime_error("Failed to write back buffered pages");
+    }
+    auto mdm = WRP_CTE_FS_METADATA_MANAGER;
+    mdm->meta_cache_.InvalidateSize(stat.path_);
+    wrp_cte::core::Tag file_tag(stat.tag_id_);
+    if (stat.extent_map_) {
+      // AppendBlob lays the data out in pages, which would break the extent
+      // layout, so adaptive files append at the current tag size
+      auto *cte_client = WRP_CTE_CLIENT;
+      auto size_task = cte_client->AsyncGetTagSize(stat.tag_id_);
+      size_task.Wait();
+      size_t end = size_task->tag_size_;
+      if (WritePages(stat, end, data, total_size) < total_size) {
+        throw std::runtime_error("Failed to append extent blobs");
+      }
+      stat.file_size_ = std::max(stat.file_size_, end + total_size);
+      return end;
+    }
+    size_t off = file_tag.AppendBlob(data, total_size, stat.page_size_);
+    if (cache) {
+      cache->Invalidate(off, total_size);
+    }
+    stat.file_size_ = std::max(stat.file_size_, off + total_size);
+    return off;
+  }
+
+  /**
+   * Read a byte range from page blobs, serving prefetched pages from the
+   * page cache and fetching the remaining runs as vectored batches
+   * @param stat File statistics
+   * @param off File offset of the first byte
+   * @param data Destination buffer
+   * @param total_size Number of bytes to read
+   * @return Bytes read, counted as a leading run from \a off
+   * @throws std::runtime_error if shared memory cannot be allocated
+   */
+  size_t ReadPages(AdapterStat &stat, size_t off, char *data,
+                   size_t total_size) {
+    FilePageCache *cache = stat.page_cache_.get();
+    wrp_cte::core::Tag file_tag(stat.tag_id_);
+    if (stat.extent_map_) {
+      return ReadExtents(stat, off, data, total_size);
+    }
+    if (cache) {
+      // Reads must observe writes still held in write-behind buffers
+      if (cache->HasDirty() && !cache->Flush(stat.tag_id_)) {
+        return 0;
+      }
+      cache->Observe(off, total_size);
+    }
+    size_t page_size = stat.page_size_;
+    size_t done = 0;
+    while (done < total_size) {
+      size_t cur = off + done;
+      size_t len = std::min(CalculateRemainingPageSpace(cur, page_size),
+                            total_size - done);
+      if (cache && cache->TryRead(CalculatePageIndex(cur, page_size),
+                                  CalculatePageOffset(cur, page_size), len,
+                                  data + done)) {
+        done += len;
+        continue;
+      }
+      // Extend the miss up to the next cached page and fetch it as a batch
+      size_t run = len;
+      while (done + run < total_size &&
+             !(cache && cache->Contains(
+                            CalculatePageIndex(cur + run, page_size)))) {
+        run += std::min(page_size, total_size - done - run);
+      }
+      size_t got = file_tag.GetBlobBatch(
+          BuildPageExtents(cur, run, page_size), data + done);
+      done += got;
+      if (got < run) {
+        return done;
+      }
+    }
+    if (cache) {
+      cache->Prefetch(stat.tag_id_, std::max(stat.file_size_, off + done));
+    }
+    return done;
+  }
+
+  /**
+   * Read a byte range of an adaptive file through its extent map. A short
+   * read reloads the map once, since another process may have added
+   * extents since the file was opened.
+   * @param stat File statistics with an extent map
+   * @param off File offset of the first byte
+   * @param data Destination buffer
+   * @param total_size Number of bytes to read
+   * @return Bytes read, counted as a leading run from \a off
+   */
+  size_t ReadExtents(AdapterStat &stat, size_t off, char *data,
+                     size_t total_size) {
+    wrp_cte::core::Tag file_tag(stat.tag_id_);
+    AdaptiveMapper *mapper = GetAdaptiveMapper();
+    size_t done = file_tag.GetBlobBatch(
+        mapper->MapRead(*stat.extent_map_, off, total_size), data);
+    if (done < total_size) {
+      LoadExtents(stat);
+      done += file_tag.GetBlobBatch(
+          mapper->MapRead(*stat.extent_map_, off + done, total_size - done),
+          data + done);
+    }
+    return done;
+  }
+
 public:
   /** write */
   size_t Write(File &f, AdapterStat &stat, const void *ptr, size_t off,
@@ -200,52 +450,41 @@ public:
     // CTE doesn't need Context objects
 
     if (is_append) {
-      // TODO: Append operations not yet supported in CTE
-      // Perform append
-      HLOG(kWarning, "Append operations not yet supported in CTE, treating as "
-                      "regular write");
-      // Fallback to regular write at end of file
-      off = stat.file_size_;
+      // The runtime reserves the offset at the tag's append cursor, so
+      // concurrent appenders never overlap and no size round trip is needed
+      try {
+        off = AppendPages(stat, static_cast<const char *>(ptr), total_size);
+      } catch (const std::exception &e) {
+        HLOG(kError, "Tag AppendBlob failed: {}", e.what());
+        io_status.success_ = false;
+        return 0;
+      }
+      HLOG(kDebug, "Appended {} bytes to {} at offset {}", total_size,
+           filename, off);
+      stat.UpdateTime();
+      io_status.size_ = total_size;
+      UpdateIoStatus(opts, io_status);
+      return total_size;
     }
 
-    // Use page-based CTE PutBlob operations with Tag API
+    // Use page-based CTE PutBlob operations with Tag API. All page Puts of
+    // the request are issued together as one vectored batch instead of one
+    // blocking round trip per page.
     {
-      size_t bytes_written = 0;
-      size_t current_offset = off;
       const char *data_ptr = static_cast<const char *>(ptr);
-
-      // Create Tag object from stored TagId
-      wrp_cte::core::Tag file_tag(stat.tag_id_);
-
-      while (bytes_written < total_size) {
-        // Calculate current page index and offset within page
-        size_t page_index = CalculatePageIndex(current_offset, stat.page_size_);
-        size_t page_offset =
-            CalculatePageOffset(current_offset, stat.page_size_);
-        size_t remaining_page_space =
-            CalculateRemainingPageSpace(current_offset, stat.page_size_);
-
-        // Calculate how much to write in this page
-        size_t bytes_to_write =
-            std::min(remaining_page_space, total_size - bytes_written);
-
-        // Generate blob name using stringified page index
-        std::string blob_name = std::to_string(page_index);
-
-        // Use Tag API PutBlob with raw char* (handles SHM allocation internally)
-        try {
-          file_tag.PutBlob(blob_name, data_ptr + bytes_written, bytes_to_write,
-                           page_offset);
-        } catch (const std::exception &e) {
-          HLOG(kError, "Tag PutBlob failed for page {}: {}", page_index,
-                e.what());
-          io_status.success_ = false;
-          return bytes_written;
-        }
-
-        // Update counters for next iteration
-        bytes_written += bytes_to_write;
-        current_offset += bytes_to_write;
+      size_t bytes_written = 0;
+      try {
+        bytes_written = WritePages(stat, off, data_ptr, total_size);
+      } catch (const std::exception &e) {
+        HLOG(kError, "Tag PutBlobBatch failed: {}", e.what());
+        io_status.success_ = false;
+        return 0;
+      }
+      if (bytes_written < total_size) {
+        HLOG(kError, "Tag PutBlobBatch failed for page {}",
+             CalculatePageIndex(off + bytes_written, stat.page_size_));
+        io_status.success_ = false;
+        return bytes_written;
       }
 
       if (opts.DoSeek()) {
@@ -322,42 +561,22 @@ public:
             "Async read operations not yet fully supported, using sync read");
     }
 
-    // Use page-based CTE GetBlob operations with Tag API
-    size_t bytes_read = 0;
-    size_t current_offset = off;
+    // Use page-based CTE GetBlob operations with Tag API, issued together
+    // as vectored batches around pages already prefetched by readahead
     char *data_ptr = static_cast<char *>(ptr);
-
-    // Create Tag object from stored TagId
-    wrp_cte::core::Tag file_tag(stat.tag_id_);
-
-    while (bytes_read < total_size) {
-      // Calculate current page index and offset within page
-      size_t page_index = CalculatePageIndex(current_offset, stat.page_size_);
-      size_t page_offset = CalculatePageOffset(current_offset, stat.page_size_);
-      size_t remaining_page_space =
-          CalculateRemainingPageSpace(current_offset, stat.page_size_);
-
-      // Calculate how much to read from this page
-      size_t bytes_to_read =
-          std::min(remaining_page_space, total_size - bytes_read);
-
-      // Generate blob name using stringified page index
-      std::string blob_name = std::to_string(page_index);
-
-      // Use Tag API GetBlob with raw char* (handles SHM allocation internally)
-      try {
-        file_tag.GetBlob(blob_name, data_ptr + bytes_read, bytes_to_read,
-                         page_offset);
-      } catch (const std::exception &e) {
-        HLOG(kError, "Tag GetBlob failed for page {}: {}", page_index,
-              e.what());
-        io_status.success_ = false;
-        return bytes_read;
-      }
-
-      // Update counters for next iteration
-      bytes_read += bytes_to_read;
-      current_offset += bytes_to_read;
+    size_t bytes_read = 0;
+    try {
+      bytes_read = ReadPages(stat, off, data_ptr, total_size);
+    } catch (const std::exception &e) {
+      HLOG(kError, "Tag GetBlobBatch failed: {}", e.what());
+      io_status.success_ = false;
+      return 0;
+    }
+    if (bytes_read < total_size) {
+      HLOG(kError, "Tag GetBlobBatch failed for page {}",
+           CalculatePageIndex(off + bytes_read, stat.page_size_));
+      io_status.success_ = false;
+      return bytes_read;
     }
 
     size_t data_offset = bytes_read; // Total bytes read
@@ -477,10 +696,25 @@ public:
   size_t GetSize(File &f, AdapterStat &stat) {
     (void)f;
     if (stat.adapter_mode_ != AdapterMode::kBypass) {
+      auto mdm = WRP_CTE_FS_METADATA_MANAGER;
+      // Buffered writes are not part of the tag until written back
+      if (stat.page_cache_ && stat.page_cache_->HasDirty()) {
+        stat.page_cache_->Flush(stat.tag_id_);
+        mdm->meta_cache_.InvalidateSize(stat.path_);
+      }
+      // A leased size avoids the GetTagSize broadcast
+      size_t cached_size;
+      if (mdm->meta_cache_.GetSize(stat.path_, cached_size)) {
+        stat.file_size_ = cached_size;
+        return cached_size;
+      }
       // For CTE, query the actual tag size from CTE runtime
+      chi::u64 lease_version = mdm->meta_cache_.GetVersion(stat.tag_id_);
       auto *cte_client = WRP_CTE_CLIENT;
       size_t cte_tag_size =
           cte_client->GetTagSize(hipc::MemContext(), stat.tag_id_);
+      mdm->meta_cache_.PutSize(stat.path_, stat.tag_id_, cte_tag_size,
+                               lease_version);
 
       HLOG(
           kDebug,
@@ -509,9 +743,52 @@ public:
   /** sync */
   int Sync(File &f, AdapterStat &stat) {
     (void)f;
-    (void)stat;
-    // CTE sync operations would be handled by the runtime
-    // For now, no explicit sync needed
+    // Write back pages held by write-behind; persistence beyond that is
+    // handled by the runtime
+    if (stat.page_cache_ && stat.page_cache_->HasDirty()) {
+      auto mdm = WRP_CTE_FS_METADATA_MANAGER;
+      mdm->meta_cache_.InvalidateSize(stat.path_);
+      if (!stat.page_cache_->Flush(stat.tag_id_)) {
+        HLOG(kError, "Failed to write back buffered pages of {}", stat.path_);
+        return -1;
+      }
+    }
+    return 0;
+  }
+
+  /**
+   * Reserve a byte range, like posix_fallocate: the blobs covering it are
+   * allocated and zero-filled once, so later writes into the range reuse
+   * them instead of allocating per chunk
+   * @param f File
+   * @param stat File statistics
+   * @param off File offset of the first byte
+   * @param len Number of bytes to reserve
+   * @return 0 on success, -1 if a reservation failed
+   */
+  int Reserve(File &f, AdapterStat &stat, size_t off, size_t len) {
+    (void)f;
+    if (len == 0) {
+      return 0;
+    }
+    if (stat.page_cache_) {
+      stat.page_cache_->Invalidate(off, len);
+    }
+    auto mdm = WRP_CTE_FS_METADATA_MANAGER;
+    mdm->meta_cache_.InvalidateSize(stat.path_);
+    wrp_cte::core::Tag file_tag(stat.tag_id_);
+    std::vector<wrp_cte::core::BlobExtent> extents =
+        stat.extent_map_
+            ? GetAdaptiveMapper()->MapWrite(*stat.extent_map_, off, len)
+            : BuildPageExtents(off, len, stat.page_size_);
+    try {
+      file_tag.ReserveBlobBatch(extents);
+    } catch (const std::exception &e) {
+      HLOG(kError, "Failed to reserve {} bytes of {}: {}", len, stat.path_,
+           e.what());
+      return -1;
+    }
+    stat.file_size_ = std::max(stat.file_size_, off + len);
     return 0;
   }
 
@@ -529,6 +806,8 @@ public:
     FilesystemIoClientState fs_ctx(&mdm->fs_mdm_, (void *)&stat);
     HermesClose(f, stat, fs_ctx);
     RealClose(f, stat);
+    stat.page_cache_.reset();
+    stat.extent_map_.reset();
     mdm->Delete(stat.path_, f);
     if (stat.amode_ & MPI_MODE_DELETE_ON_CLOSE) {
       Remove(stat.path_);
@@ -546,6 +825,7 @@ public:
     // CTE tag cleanup - delete the tag associated with this file using
     // canonical path as tag name
     std::string canon_path = stdfs::absolute(pathname).string();
+    mdm->meta_cache_.Invalidate(canon_path);
     // Note: Tag API doesn't provide delete functionality yet, so we use core
     // client directly
     auto *cte_client = WRP_CTE_CLIENT;
@@ -571,6 +851,9 @@ public:
       FilesystemIoClientState fs_ctx(&mdm->fs_mdm_, (void *)&stat);
       HermesClose(f, *stat, fs_ctx);
       RealClose(f, *stat);
+      // Buffered pages of a removed file are dropped, not written back
+      stat->page_cache_.reset();
+      stat->extent_map_.reset();
       mdm->Delete(stat->path_, f);
       if (stat->adapter_mode_ == AdapterMode::kScratch) {
         ret = 0;
@@ -39,11 +39,15 @@
 #include <filesystem>
 #include <future>
 #include <limits>
+#include <memory>
+#include <vector>
 
 #include "wrp_cte/core/core_client.h"
 #include "wrp_cte/core/core_tasks.h"
 #include "adapter/adapter_types.h"
+#include "adapter/mapper/adaptive_mapper.h"
 #include "adapter/mapper/balanced_mapper.h"
+#include "adapter/filesystem/page_cache.h"
 #include "hermes_shm/types/bitfield.h"
 #include "hermes_shm/thread/lock.h"
 
@@ -211,6 +215,30 @@ struct File {
   }
 };
 
+/** How an MPI-IO file chooses between collective buffering and
+ * independent I/O (ROMIO romio_cb_write / romio_cb_read hint values) */
+enum class CollectiveBufferingMode {
+  kAutomatic, /**< Decide per call from the access pattern */
+  kEnable,    /**< Always aggregate, unless the pattern cannot be */
+  kDisable    /**< Always use independent I/O */
+};
+
+/** MPI-IO collective buffering settings of a file, set up at open */
+struct CollectiveBuffering {
+  CollectiveBufferingMode write_mode_; /**< MPI_File_write_all policy */
+  CollectiveBufferingMode read_mode_;  /**< MPI_File_read_all policy */
+  size_t buffer_size_;           /**< Aggregator bytes per exchange round */
+  std::vector<int> aggregators_; /**< One rank of the file comm per node */
+
+  /** Default constructor */
+  CollectiveBuffering()
+      : write_mode_(CollectiveBufferingMode::kAutomatic),
+        read_mode_(CollectiveBufferingMode::kAutomatic),
+        buffer_size_(16 * 1024 * 1024) {}
+};
+
+class StdioBuffer;
+
 /** Any relevant statistics from the I/O client */
 struct AdapterStat {
   std::string path_;         /**< The URL of this file */
@@ -235,10 +263,17 @@ struct AdapterStat {
   MPI_Info info_;  /**< Info object (handle) */
   MPI_Comm comm_;  /**< Communicator for the file.*/
   bool atomicity_; /**< Consistency semantics for data-access */
+  CollectiveBuffering cb_; /**< Collective buffering settings (MPI) */
 
   wrp_cte::core::TagId tag_id_; /**< tag associated with the file */
   /** Page size used for file */
   size_t page_size_;
+  /** Readahead / write-behind state, shared by copies of this stat */
+  std::shared_ptr<FilePageCache> page_cache_;
+  /** Extents of the adaptive mapper; null for fixed-page files */
+  std::shared_ptr<ExtentMap> extent_map_;
+  /** User-space buffer of a STDIO stream (STDIO) */
+  std::shared_ptr<StdioBuffer> stdio_buf_;
 
   /** Default constructor */
   AdapterStat()
@@ -34,12 +34,17 @@
 #ifndef WRP_CTE_ADAPTER_METADATA_MANAGER_H
 #define WRP_CTE_ADAPTER_METADATA_MANAGER_H
 
+#include <chrono>
 #include <cstdio>
+#include <mutex>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "filesystem_io_client.h"
 #include "hermes_shm/thread/lock.h"
 #include "adapter/cae_config.h"
+#include "wrp_cte/core/metadata_lease.h"
 
 namespace wrp::cae {
 
@@ -50,6 +55,182 @@ const int kMDM_Delete = 3;
 const int kMDM_Find = 4;
 const int kMDM_Find2 = 5;
 
+/**
+ * Client-side cache of per-file metadata (tag ID and size) that open, stat
+ * and lseek can use without IPC. Every entry holds a lease: it is used until
+ * the lease time (adapter_meta_cache_ttl_ms) runs out or the local runtime
+ * revokes it through the MetadataLeaseTable because the file's tag changed.
+ * Writes by this process drop the cached size directly.
+ */
+class FileMetaCache {
+ public:
+  /** Entries kept before the cache is cleared */
+  static constexpr size_t kMaxEntries = 65536;
+
+  /**
+   * Look up the tag of \a path
+   * @param tag_id Output tag ID on a hit
+   * @return False on a miss or an expired or revoked lease
+   */
+  bool GetTagId(const std::string &path, wrp_cte::core::TagId &tag_id) {
+    std::lock_guard<std::mutex> guard(lock_);
+    Entry *entry = FindValid(path);
+    if (!entry) {
+      return false;
+    }
+    tag_id = entry->tag_id_;
+    return true;
+  }
+
+  /** Cache the tag of \a path after GetOrCreateTag returned it */
+  void PutTagId(const std::string &path, const wrp_cte::core::TagId &tag_id) {
+    std::lock_guard<std::mutex> guard(lock_);
+    Clock::duration ttl = GetTtl();
+    if (ttl.count() == 0) {
+      return;
+    }
+    Entry *entry = Insert(path, tag_id, Version(tag_id), ttl);
+    entry->has_size_ = false;
+  }
+
+  /**
+   * Lease version of \a tag_id, read before querying the runtime so a
+   * change racing with the query revokes the result
+   */
+  chi::u64 GetVersion(const wrp_cte::core::TagId &tag_id) {
+    std::lock_guard<std::mutex> guard(lock_);
+    return Version(tag_id);
+  }
+
+  /**
+   * Look up the size of \a path
+   * @param size Output size on a hit
+   * @return False on a miss or an expired or revoked lease
+   */
+  bool GetSize(const std::string &path, size_t &size) {
+    std::lock_guard<std::mutex> guard(lock_);
+    Entry *entry = FindValid(path);
+    if (!entry || !entry->has_size_) {
+      return false;
+    }
+    size = entry->size_;
+    return true;
+  }
+
+  /**
+   * Cache the size of \a path
+   * @param version Result of GetVersion taken before the size was queried
+   */
+  void PutSize(const std::string &path, const wrp_cte::core::TagId &tag_id,
+               size_t size, chi::u64 version) {
+    std::lock_guard<std::mutex> guard(lock_);
+    Clock::duration ttl = GetTtl();
+    if (ttl.count() == 0) {
+      return;
+    }
+    Entry *entry = Insert(path, tag_id, version, ttl);
+    entry->has_size_ = true;
+    entry->size_ = size;
+  }
+
+  /** Drop the cached size of \a path after this process changed it */
+  void InvalidateSize(const std::string &path) {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = entries_.find(path);
+    if (it != entries_.end()) {
+      it->second.has_size_ = false;
+    }
+  }
+
+  /** Drop everything cached for \a path, e.g. after it was removed */
+  void Invalidate(const std::string &path) {
+    std::lock_guard<std::mutex> guard(lock_);
+    entries_.erase(path);
+  }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  /** Cached metadata of one file */
+  struct Entry {
+    wrp_cte::core::TagId tag_id_;
+    chi::u64 version_ = 0;     /**< Lease table version when cached */
+    Clock::time_point expires_;
+    bool has_size_ = false;
+    size_t size_ = 0;
+  };
+
+  /** Lease time from the CAE config; zero disables the cache */
+  static Clock::duration GetTtl() {
+    auto *cae_config = WRP_CAE_CONF;
+    if (!cae_config) {
+      return Clock::duration::zero();
+    }
+    return std::chrono::duration_cast<Clock::duration>(
+        std::chrono::milliseconds(cae_config->GetAdapterMetaCacheTtlMs()));
+  }
+
+  /**
+   * Map the local runtime's lease table once. Without one (e.g. a TCP
+   * client) entries only expire by time.
+   */
+  void AttachLeases() {
+    if (attach_tried_ && (!attached_ || leases_.IsLive())) {
+      return;
+    }
+    if (attached_) {
+      // The runtime restarted: its new table starts from zero again
+      leases_.Detach();
+      entries_.clear();
+    }
+    attach_tried_ = true;
+    attached_ = leases_.Attach(wrp_cte::core::MetadataLeaseTable::SegmentName());
+  }
+
+  /** Current lease version of \a tag_id */
+  chi::u64 Version(const wrp_cte::core::TagId &tag_id) {
+    AttachLeases();
+    return leases_.GetVersion(tag_id);
+  }
+
+  /** Find the entry of \a path if its lease still holds */
+  Entry *FindValid(const std::string &path) {
+    auto it = entries_.find(path);
+    if (it == entries_.end()) {
+      return nullptr;
+    }
+    Entry &entry = it->second;
+    if (Clock::now() >= entry.expires_ ||
+        Version(entry.tag_id_) != entry.version_) {
+      entries_.erase(path);
+      return nullptr;
+    }
+    return &entry;
+  }
+
+  /** Create or refresh the entry of \a path */
+  Entry *Insert(const std::string &path, const wrp_cte::core::TagId &tag_id,
+                chi::u64 version, Clock::duration ttl) {
+    if (entries_.size() >= kMaxEntries && !entries_.count(path)) {
+      entries_.clear();
+    }
+    Entry &entry = entries_[path];
+    if (!(entry.tag_id_ == tag_id)) {
+      entry.has_size_ = false;
+    }
+    entry.tag_id_ = tag_id;
+    entry.version_ = version;
+    entry.expires_ = Clock::now() + ttl;
+    return &entry;
+  }
+
+  std::unordered_map<std::string, Entry> entries_;
+  wrp_cte::core::MetadataLeaseTable leases_;
+  bool attach_tried_ = false;
+  bool attached_ = false;
+  std::mutex lock_;
+};
+
 /**
  * Metadata manager for POSIX adapter
  */
@@ -65,6 +246,7 @@ public:
   std::unordered_map<uint64_t, FsAsyncTask *>
       request_map_;           /**< Map for async FS requests */
   FsIoClientMetadata fs_mdm_; /**< Context needed for I/O clients */
+  FileMetaCache meta_cache_;  /**< Leased tag IDs and sizes by path */
 
   /** Constructor */
   MetadataManager() = default;
@@ -185,6 +367,16 @@ public:
       return iter->second;
   }
 
+  /**
+   * Copy every metadata entry, e.g. to flush all open files
+   * @param files Filled with each tracked file handler and its metadata
+   */
+  void GetAll(
+      std::vector<std::pair<File, std::shared_ptr<AdapterStat>>> &files) {
+    hshm::ScopedRwReadLock md_lock(lock_, kMDM_Find2);
+    files.assign(hermes_file_to_stat_.begin(), hermes_file_to_stat_.end());
+  }
+
   /**
    * Add a request to the request map.
    * */
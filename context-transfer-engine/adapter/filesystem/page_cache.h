@@ -0,0 +1,467 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef WRP_CTE_ADAPTER_FILESYSTEM_PAGE_CACHE_H_
+#define WRP_CTE_ADAPTER_FILESYSTEM_PAGE_CACHE_H_
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "chimaera/chimaera.h"
+#include "wrp_cte/core/core_client.h"
+#include "wrp_cte/core/core_tasks.h"
+
+namespace wrp::cae {
+
+/**
+ * Detects sequential and fixed-stride access in the stream of read requests
+ * issued against one file. Confidence grows with every request that
+ * continues the current pattern, and the readahead window doubles with it.
+ */
+class AccessPatternDetector {
+ public:
+  /** Requests that must continue a pattern before readahead kicks in */
+  static constexpr int kConfidenceThreshold = 2;
+
+  /** Constructor */
+  explicit AccessPatternDetector(size_t max_window)
+      : max_window_(max_window) {}
+
+  /**
+   * Record a read request and update the detected pattern
+   * @param off File offset of the request
+   * @param size Size of the request in bytes
+   */
+  void Observe(size_t off, size_t size) {
+    if (has_last_ && off > last_off_ &&
+        (off - last_off_ == delta_ || off == last_off_ + last_size_)) {
+      delta_ = off - last_off_;
+      ++confidence_;
+      window_ = std::min(std::max<size_t>(window_ * 2, 1), max_window_);
+    } else {
+      delta_ = has_last_ && off > last_off_ ? off - last_off_ : 0;
+      confidence_ = 0;
+      window_ = 0;
+    }
+    has_last_ = true;
+    last_off_ = off;
+    last_size_ = size;
+  }
+
+  /** Whether the stream is predictable enough to read ahead */
+  bool IsPredictable() const {
+    return confidence_ >= kConfidenceThreshold && window_ > 0;
+  }
+
+  /** Whether the detected pattern is contiguous (stride equals size) */
+  bool IsSequential() const { return delta_ == last_size_; }
+
+  /** Distance between consecutive request offsets */
+  size_t GetStride() const { return delta_; }
+
+  /** Offset of the most recent request */
+  size_t GetLastOffset() const { return last_off_; }
+
+  /** Size of the most recent request */
+  size_t GetLastSize() const { return last_size_; }
+
+  /** Current readahead window, in pages or in requests for strides */
+  size_t GetWindow() const { return window_; }
+
+ private:
+  size_t max_window_;     /**< Upper bound for window_ */
+  bool has_last_ = false; /**< Whether a request was observed */
+  size_t last_off_ = 0;   /**< Offset of the previous request */
+  size_t last_size_ = 0;  /**< Size of the previous request */
+  size_t delta_ = 0;      /**< Offset delta of the detected pattern */
+  int confidence_ = 0;    /**< Requests continuing the pattern */
+  size_t window_ = 0;     /**< Current readahead window */
+};
+
+/**
+ * Client-side per-file page cache in shared memory.
+ *
+ * Read side: once the AccessPatternDetector sees a sequential or strided
+ * stream, the next pages are fetched with AsyncGetBlob into shared memory
+ * buffers and served from there by later reads.
+ *
+ * Write side (write-behind): sub-page writes are acknowledged once copied
+ * into a shared memory page buffer and coalesced there, then issued as one
+ * PutBlob per page when the page fills, when a non-adjoining write lands on
+ * it, when too many pages are dirty, or on Flush (fsync/close).
+ */
+class FilePageCache {
+ public:
+  /** Dirty pages tolerated before write-behind flushes everything */
+  static constexpr size_t kMaxDirtyPages = 64;
+
+  /**
+   * Constructor
+   * @param page_size Adapter page size of the file
+   * @param max_readahead Maximum readahead window in pages, 0 disables it
+   * @param write_behind Whether sub-page writes are buffered
+   */
+  FilePageCache(size_t page_size, size_t max_readahead, bool write_behind)
+      : page_size_(page_size),
+        max_readahead_(max_readahead),
+        write_behind_(write_behind),
+        detector_(max_readahead) {}
+
+  /** Destructor; buffered dirty data that was never flushed is dropped */
+  ~FilePageCache() {
+    std::lock_guard<std::mutex> guard(lock_);
+    for (auto &it : pages_) {
+      ReleasePage(it.second);
+    }
+    pages_.clear();
+    fifo_.clear();
+    auto *ipc_manager = CHI_IPC;
+    for (auto &it : dirty_) {
+      ipc_manager->FreeBuffer(it.second.buf_);
+    }
+    dirty_.clear();
+  }
+
+  FilePageCache(const FilePageCache &) = delete;
+  FilePageCache &operator=(const FilePageCache &) = delete;
+
+  /** Whether readahead is enabled */
+  bool ReadaheadEnabled() const { return max_readahead_ > 0; }
+
+  /** Whether write-behind is enabled */
+  bool WriteBehindEnabled() const { return write_behind_; }
+
+  /** Whether any page holds buffered writes */
+  bool HasDirty() {
+    std::lock_guard<std::mutex> guard(lock_);
+    return !dirty_.empty();
+  }
+
+  /**
+   * Record a read request with the access-pattern detector
+   * @param off File offset of the request
+   * @param size Size of the request in bytes
+   */
+  void Observe(size_t off, size_t size) {
+    std::lock_guard<std::mutex> guard(lock_);
+    detector_.Observe(off, size);
+  }
+
+  /**
+   * Whether a page is resident or being prefetched
+   * @param page_idx Page index within the file
+   */
+  bool Contains(size_t page_idx) {
+    std::lock_guard<std::mutex> guard(lock_);
+    return pages_.find(page_idx) != pages_.end();
+  }
+
+  /**
+   * Serve part of a page from the cache, waiting for its prefetch if needed
+   * @param page_idx Page index within the file
+   * @param page_off Offset of the first byte within the page
+   * @param size Number of bytes to copy
+   * @param dst Destination buffer
+   * @return true if the bytes were copied, false on a miss
+   */
+  bool TryRead(size_t page_idx, size_t page_off, size_t size, char *dst) {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = pages_.find(page_idx);
+    if (it == pages_.end()) {
+      return false;
+    }
+    CachedPage &page = it->second;
+    if (page.pending_) {
+      page.task_.Wait();
+      page.valid_ = page.task_->GetReturnCode() == 0;
+      page.pending_ = false;
+    }
+    if (!page.valid_ || page_off + size > page.size_) {
+      EraseLocked(page_idx);
+      return false;
+    }
+    memcpy(dst, page.buf_.ptr_ + page_off, size);
+    return true;
+  }
+
+  /**
+   * Issue asynchronous fetches for the pages the detector predicts next
+   * @param tag_id Tag holding the file's page blobs
+   * @param file_end Known size of the file; pages past it are not fetched
+   */
+  void Prefetch(const wrp_cte::core::TagId &tag_id, size_t file_end) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (!ReadaheadEnabled() || !detector_.IsPredictable()) {
+      return;
+    }
+    size_t end = detector_.GetLastOffset() + detector_.GetLastSize();
+    size_t window = detector_.GetWindow();
+    if (detector_.IsSequential()) {
+      size_t first = end / page_size_;
+      for (size_t i = 0; i < window; ++i) {
+        FetchLocked(tag_id, first + i, file_end);
+      }
+      return;
+    }
+    // Strided: fetch the pages covering the next `window` requests
+    for (size_t k = 1; k <= window; ++k) {
+      size_t req_off = detector_.GetLastOffset() + k * detector_.GetStride();
+      size_t req_end = req_off + detector_.GetLastSize();
+      for (size_t p = req_off / page_size_; p * page_size_ < req_end; ++p) {
+        FetchLocked(tag_id, p, file_end);
+      }
+    }
+  }
+
+  /**
+   * Drop cached copies of the pages touched by a byte range
+   * @param off File offset of the range
+   * @param size Size of the range in bytes
+   */
+  void Invalidate(size_t off, size_t size) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (pages_.empty() || size == 0) {
+      return;
+    }
+    for (size_t p = off / page_size_; p * page_size_ < off + size; ++p) {
+      EraseLocked(p);
+    }
+  }
+
+  /**
+   * Buffer a write in shared memory page buffers (write-behind)
+   * @param tag_id Tag holding the file's page blobs
+   * @param off File offset of the write
+   * @param data Data to write
+   * @param size Size of the write in bytes
+   * @return true if the write is buffered, false if a flush failed or no
+   * buffer could be allocated
+   */
+  bool BufferWrite(const wrp_cte::core::TagId &tag_id, size_t off,
+                   const char *data, size_t size) {
+    std::lock_guard<std::mutex> guard(lock_);
+    size_t done = 0;
+    while (done < size) {
+      size_t cur = off + done;
+      size_t page_idx = cur / page_size_;
+      size_t page_off = cur % page_size_;
+      size_t len = std::min(page_size_ - page_off, size - done);
+      if (!BufferPageLocked(tag_id, page_idx, page_off, data + done, len)) {
+        return false;
+      }
+      done += len;
+    }
+    if (dirty_.size() > kMaxDirtyPages) {
+      return FlushLocked(tag_id);
+    }
+    return true;
+  }
+
+  /**
+   * Write all buffered pages back to CTE
+   * @param tag_id Tag holding the file's page blobs
+   * @return true if every page was written
+   */
+  bool Flush(const wrp_cte::core::TagId &tag_id) {
+    std::lock_guard<std::mutex> guard(lock_);
+    return FlushLocked(tag_id);
+  }
+
+ private:
+  /** A resident or in-flight page */
+  struct CachedPage {
+    hipc::FullPtr<char> buf_;                      /**< Page buffer */
+    size_t size_ = 0;                              /**< Bytes requested */
+    chi::Future<wrp_cte::core::GetBlobTask> task_; /**< Pending fetch */
+    bool pending_ = false;                         /**< Fetch not awaited */
+    bool valid_ = false;                           /**< Fetch succeeded */
+  };
+
+  /** A page holding buffered writes over [begin_, end_) */
+  struct DirtyPage {
+    hipc::FullPtr<char> buf_; /**< Page buffer */
+    size_t begin_ = 0;        /**< First dirty byte within the page */
+    size_t end_ = 0;          /**< One past the last dirty byte */
+  };
+
+  /** Maximum resident pages; older prefetches are evicted first */
+  size_t Capacity() const { return 2 * max_readahead_ + 2; }
+
+  /** Wait for an in-flight fetch and release the page buffer */
+  static void ReleasePage(CachedPage &page) {
+    if (page.pending_) {
+      page.task_.Wait();
+      page.pending_ = false;
+    }
+    auto *ipc_manager = CHI_IPC;
+    ipc_manager->FreeBuffer(page.buf_);
+  }
+
+  /** Remove a page from the cache; caller holds lock_ */
+  void EraseLocked(size_t page_idx) {
+    auto it = pages_.find(page_idx);
+    if (it == pages_.end()) {
+      return;
+    }
+    ReleasePage(it->second);
+    pages_.erase(it);
+    fifo_.erase(std::remove(fifo_.begin(), fifo_.end(), page_idx),
+                fifo_.end());
+  }
+
+  /** Start fetching one page unless present or past EOF; holds lock_ */
+  void FetchLocked(const wrp_cte::core::TagId &tag_id, size_t page_idx,
+                   size_t file_end) {
+    size_t page_start = page_idx * page_size_;
+    if (page_start >= file_end || pages_.find(page_idx) != pages_.end() ||
+        dirty_.find(page_idx) != dirty_.end()) {
+      return;
+    }
+    while (pages_.size() >= Capacity() && !fifo_.empty()) {
+      EraseLocked(fifo_.front());
+    }
+    auto *ipc_manager = CHI_IPC;
+    CachedPage page;
+    page.size_ = std::min(page_size_, file_end - page_start);
+    page.buf_ = ipc_manager->AllocateBuffer(page.size_);
+    if (page.buf_.IsNull()) {
+      return;
+    }
+    auto *cte_client = WRP_CTE_CLIENT;
+    page.task_ = cte_client->AsyncGetBlob(tag_id, std::to_string(page_idx), 0,
+                                          page.size_, 0,
+                                          hipc::ShmPtr<>(page.buf_.shm_));
+    page.pending_ = true;
+    pages_.emplace(page_idx, std::move(page));
+    fifo_.push_back(page_idx);
+  }
+
+  /** Merge a sub-page write into its dirty page buffer; holds lock_ */
+  bool BufferPageLocked(const wrp_cte::core::TagId &tag_id, size_t page_idx,
+                        size_t page_off, const char *data, size_t len) {
+    auto it = dirty_.find(page_idx);
+    if (it != dirty_.end() &&
+        (page_off > it->second.end_ || page_off + len < it->second.begin_)) {
+      // A gap would have to be filled with stale bytes; write back first
+      if (!FlushPageLocked(tag_id, page_idx)) {
+        return false;
+      }
+      it = dirty_.end();
+    }
+    if (it == dirty_.end()) {
+      auto *ipc_manager = CHI_IPC;
+      DirtyPage page;
+      page.buf_ = ipc_manager->AllocateBuffer(page_size_);
+      if (page.buf_.IsNull()) {
+        return false;
+      }
+      page.begin_ = page_off;
+      page.end_ = page_off;
+      it = dirty_.emplace(page_idx, page).first;
+    }
+    DirtyPage &page = it->second;
+    memcpy(page.buf_.ptr_ + page_off, data, len);
+    page.begin_ = std::min(page.begin_, page_off);
+    page.end_ = std::max(page.end_, page_off + len);
+    if (page.end_ - page.begin_ == page_size_) {
+      return FlushPageLocked(tag_id, page_idx);
+    }
+    return true;
+  }
+
+  /** Issue the PutBlob for one dirty page and wait for it; holds lock_ */
+  bool FlushPageLocked(const wrp_cte::core::TagId &tag_id, size_t page_idx) {
+    auto it = dirty_.find(page_idx);
+    if (it == dirty_.end()) {
+      return true;
+    }
+    auto task = IssuePut(tag_id, page_idx, it->second);
+    task.Wait();
+    bool ok = task->GetReturnCode() == 0;
+    auto *ipc_manager = CHI_IPC;
+    ipc_manager->FreeBuffer(it->second.buf_);
+    dirty_.erase(it);
+    return ok;
+  }
+
+  /** Issue the PutBlobs for every dirty page together; holds lock_ */
+  bool FlushLocked(const wrp_cte::core::TagId &tag_id) {
+    if (dirty_.empty()) {
+      return true;
+    }
+    std::vector<chi::Future<wrp_cte::core::PutBlobTask>> tasks;
+    tasks.reserve(dirty_.size());
+    for (auto &it : dirty_) {
+      tasks.emplace_back(IssuePut(tag_id, it.first, it.second));
+    }
+    bool ok = true;
+    for (auto &task : tasks) {
+      task.Wait();
+      ok = ok && task->GetReturnCode() == 0;
+    }
+    auto *ipc_manager = CHI_IPC;
+    for (auto &it : dirty_) {
+      ipc_manager->FreeBuffer(it.second.buf_);
+    }
+    dirty_.clear();
+    return ok;
+  }
+
+  /** Start the PutBlob covering the dirty range of a page */
+  static chi::Future<wrp_cte::core::PutBlobTask> IssuePut(
+      const wrp_cte::core::TagId &tag_id, size_t page_idx,
+      const DirtyPage &page) {
+    auto *cte_client = WRP_CTE_CLIENT;
+    return cte_client->AsyncPutBlob(
+        tag_id, std::to_string(page_idx), page.begin_, page.end_ - page.begin_,
+        hipc::ShmPtr<>(page.buf_.shm_) + page.begin_, 1.0f);
+  }
+
+  size_t page_size_;                               /**< Adapter page size */
+  size_t max_readahead_;                           /**< Max window (pages) */
+  bool write_behind_;                              /**< Buffer small writes */
+  std::mutex lock_;                                /**< Guards all state */
+  AccessPatternDetector detector_;                 /**< Read stream model */
+  std::unordered_map<size_t, CachedPage> pages_;   /**< Readahead pages */
+  std::deque<size_t> fifo_;                        /**< Eviction order */
+  std::unordered_map<size_t, DirtyPage> dirty_;    /**< Write-behind pages */
+};
+
+}  // namespace wrp::cae
+
+#endif  // WRP_CTE_ADAPTER_FILESYSTEM_PAGE_CACHE_H_
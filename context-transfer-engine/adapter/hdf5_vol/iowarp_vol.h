@@ -20,14 +20,14 @@ extern "C" {
 #define IOWARP_VOL_CONNECTOR_VALUE   600  /* Unique connector class value */
 #define IOWARP_VOL_CONNECTOR_VERSION 1
 
-/* Default chunk size for async PutBlob/GetBlob (1 MB) */
+/* Default chunk size in bytes for datasets without an HDF5 chunk layout (1 MB) */
 #define IOWARP_VOL_DEFAULT_CHUNK_SIZE (1024 * 1024)
 
 /* VOL connector info (passed via H5Pset_vol) */
 typedef struct iowarp_vol_info_t {
     hid_t  under_vol_id;    /* VOL ID for the underlying connector */
     void  *under_vol_info;  /* Info for the underlying connector */
-    size_t chunk_size;      /* Chunk size for async I/O (0 = default) */
+    size_t chunk_size;      /* Bytes per CTE chunk blob (0 = default) */
 } iowarp_vol_info_t;
 
 /* Global VOL connector class */
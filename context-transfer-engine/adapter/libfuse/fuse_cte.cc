@@ -34,12 +34,50 @@
 #include "fuse_cte.h"
 
 #include <climits>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+#include <fuse3/fuse_lowlevel.h>
 
 #include "chimaera/chimaera.h"
 #include "wrp_cte/core/content_transfer_engine.h"
 
 using namespace wrp::cae::fuse;
 
+// ============================================================================
+// Options
+// ============================================================================
+
+/** Daemon options, parsed from -o cte_*=... before FUSE sees the args */
+struct CteFuseOptions {
+  unsigned max_write = 1024 * 1024;  /**< Largest write request (bytes) */
+  unsigned max_read = 1024 * 1024;   /**< Largest read request (bytes) */
+  unsigned threads = 0;   /**< Idle worker threads kept (0 = FUSE default) */
+  double cache_ttl = 1.0; /**< getattr / readdir cache TTL in seconds */
+  int no_splice = 0;      /**< Do not move request data with splice() */
+  int page_cache = 0;     /**< Let the kernel page cache hold file data */
+  int show_help = 0;
+};
+
+#define CTE_FUSE_OPT(t, p) {t, offsetof(CteFuseOptions, p), 1}
+static const struct fuse_opt kCteFuseOptSpecs[] = {
+    CTE_FUSE_OPT("cte_max_write=%u", max_write),
+    CTE_FUSE_OPT("cte_max_read=%u", max_read),
+    CTE_FUSE_OPT("cte_threads=%u", threads),
+    CTE_FUSE_OPT("cte_cache_ttl=%lf", cache_ttl),
+    CTE_FUSE_OPT("cte_no_splice", no_splice),
+    CTE_FUSE_OPT("cte_page_cache", page_cache),
+    CTE_FUSE_OPT("-h", show_help),
+    CTE_FUSE_OPT("--help", show_help),
+    FUSE_OPT_END};
+#undef CTE_FUSE_OPT
+
+static CteFuseOptions g_options;
+
+/** getattr / readdir results shared by all worker threads */
+static FuseMetaCache g_meta_cache;
+
 // ============================================================================
 // Helpers
 // ============================================================================
@@ -48,15 +86,65 @@ static FuseFileHandle *GetHandle(struct fuse_file_info *fi) {
   return reinterpret_cast<FuseFileHandle *>(fi->fh);
 }
 
+/** Fill \a stbuf for a directory */
+static void FillDirStat(struct stat *stbuf) {
+  stbuf->st_mode = S_IFDIR | 0755;
+  stbuf->st_nlink = 2;
+  stbuf->st_uid = getuid();
+  stbuf->st_gid = getgid();
+}
+
+/** Fill \a stbuf for a file of \a size bytes */
+static void FillFileStat(struct stat *stbuf, size_t size) {
+  stbuf->st_mode = S_IFREG | 0644;
+  stbuf->st_nlink = 1;
+  stbuf->st_uid = getuid();
+  stbuf->st_gid = getgid();
+  stbuf->st_size = static_cast<off_t>(size);
+}
+
+/**
+ * Write \a size bytes already in shared memory at \a offset
+ * @return Bytes written, or -EIO if nothing was written
+ */
+static int WriteFromShm(FuseFileHandle *handle,
+                        const hipc::FullPtr<char> &shm, size_t size,
+                        off_t offset) {
+  size_t written =
+      CtePutPages(handle->tag_id, static_cast<size_t>(offset), shm, size);
+  if (written == 0 && size > 0) return -EIO;
+  g_meta_cache.GrowFile(handle->path, static_cast<size_t>(offset) + written);
+  return static_cast<int>(written);
+}
+
 // ============================================================================
 // FUSE lifecycle
 // ============================================================================
 
 static void *cte_fuse_init(struct fuse_conn_info *conn,
                            struct fuse_config *cfg) {
-  (void)conn;
   cfg->use_ino = 0;
-  cfg->direct_io = 1;
+  // direct_io sends every read to the daemon; with cte_page_cache the
+  // kernel keeps file data and drops it when getattr reports a new size
+  cfg->direct_io = g_options.page_cache ? 0 : 1;
+  cfg->kernel_cache = 0;
+  cfg->auto_cache = g_options.page_cache ? 1 : 0;
+
+  // Requests up to max_write bytes; FUSE's 128KB default splits large
+  // writes into many round trips. The kernel caps it at its max_pages.
+  conn->max_write = std::max(g_options.max_write,
+                             static_cast<unsigned>(kDefaultPageSize));
+  if (!g_options.no_splice) {
+    // SPLICE_READ moves write payloads from /dev/fuse through a pipe
+    // straight into the shared memory staging buffer (see write_buf)
+    if (conn->capable & FUSE_CAP_SPLICE_READ)
+      conn->want |= FUSE_CAP_SPLICE_READ;
+    if (conn->capable & FUSE_CAP_SPLICE_WRITE)
+      conn->want |= FUSE_CAP_SPLICE_WRITE;
+    if (conn->capable & FUSE_CAP_SPLICE_MOVE)
+      conn->want |= FUSE_CAP_SPLICE_MOVE;
+  }
+  g_meta_cache.SetTtl(g_options.cache_ttl);
 
   bool success = chi::CHIMAERA_INIT(chi::ChimaeraMode::kClient, true);
   if (!success) {
@@ -78,43 +166,44 @@ static void cte_fuse_destroy(void *private_data) {
 
 static int cte_fuse_getattr(const char *path, struct stat *stbuf,
                             struct fuse_file_info *fi) {
-  (void)fi;
   memset(stbuf, 0, sizeof(struct stat));
 
   std::string p(path);
 
   // Root is always a directory
   if (p == "/") {
-    stbuf->st_mode = S_IFDIR | 0755;
-    stbuf->st_nlink = 2;
-    stbuf->st_uid = getuid();
-    stbuf->st_gid = getgid();
+    FillDirStat(stbuf);
+    return 0;
+  }
+
+  // An open file needs no name lookup, only its size
+  if (fi != nullptr && GetHandle(fi) != nullptr) {
+    FillFileStat(stbuf, CteGetTagSize(GetHandle(fi)->tag_id));
     return 0;
   }
 
+  int err = 0;
+  if (g_meta_cache.GetAttr(p, *stbuf, err)) return err;
+
   // Check if path is an explicit directory (sentinel tag with trailing /)
   // or an implicit directory (any tags under this prefix).
   // Check directories BEFORE files so that "mkdir foo && touch foo" doesn't
   // shadow the directory with a file of the same name.
   if (CteTagExists(p + "/") || CteDirExists(p)) {
-    stbuf->st_mode = S_IFDIR | 0755;
-    stbuf->st_nlink = 2;
-    stbuf->st_uid = getuid();
-    stbuf->st_gid = getgid();
+    FillDirStat(stbuf);
+    g_meta_cache.PutAttr(p, *stbuf, 0);
     return 0;
   }
 
   // Check if path is a file (tag exists with this exact name)
   if (CteTagExists(p)) {
     auto tag_id = CteGetOrCreateTag(p);
-    stbuf->st_mode = S_IFREG | 0644;
-    stbuf->st_nlink = 1;
-    stbuf->st_uid = getuid();
-    stbuf->st_gid = getgid();
-    stbuf->st_size = static_cast<off_t>(CteGetTagSize(tag_id));
+    FillFileStat(stbuf, CteGetTagSize(tag_id));
+    g_meta_cache.PutAttr(p, *stbuf, 0);
     return 0;
   }
 
+  g_meta_cache.PutAttr(p, *stbuf, -ENOENT);
   return -ENOENT;
 }
 
@@ -144,10 +233,20 @@ static int cte_fuse_readdir(const char *path, void *buf,
   filler(buf, ".", nullptr, 0, static_cast<fuse_fill_dir_flags>(0));
   filler(buf, "..", nullptr, 0, static_cast<fuse_fill_dir_flags>(0));
 
+  std::vector<std::string> names;
+  if (g_meta_cache.GetDir(p, names)) {
+    for (const auto &name : names) {
+      filler(buf, name.c_str(), nullptr, 0,
+             static_cast<fuse_fill_dir_flags>(0));
+    }
+    return 0;
+  }
+
   // List direct file children (tags whose full path is dir/name with no further slashes)
   auto files = CteListDirectChildren(p);
   for (const auto &name : files) {
     filler(buf, name.c_str(), nullptr, 0, static_cast<fuse_fill_dir_flags>(0));
+    names.push_back(name);
   }
 
   // List implicit subdirectories (dirs with files beneath them)
@@ -184,9 +283,11 @@ static int cte_fuse_readdir(const char *path, void *buf,
     if (std::find(files.begin(), files.end(), name) == files.end()) {
       filler(buf, name.c_str(), nullptr, 0,
              static_cast<fuse_fill_dir_flags>(0));
+      names.push_back(name);
     }
   }
 
+  g_meta_cache.PutDir(p, names);
   return 0;
 }
 
@@ -197,6 +298,7 @@ static int cte_fuse_mkdir(const char *path, mode_t mode) {
   // This lets getattr report the directory before any files exist under it.
   std::string sentinel = p + "/";
   auto tag_id = CteGetOrCreateTag(sentinel);
+  g_meta_cache.Invalidate(p);
   if (tag_id.IsNull()) return -EIO;
   return 0;
 }
@@ -212,6 +314,7 @@ static int cte_fuse_rmdir(const char *path) {
   if (CteTagExists(sentinel)) {
     CteDelTag(sentinel);
   }
+  g_meta_cache.Invalidate(p);
   return 0;
 }
 
@@ -225,6 +328,7 @@ static int cte_fuse_create(const char *path, mode_t mode,
   std::string p(path);
 
   auto tag_id = CteGetOrCreateTag(p);
+  g_meta_cache.Invalidate(p);
   if (tag_id.IsNull()) return -EIO;
 
   auto *handle = new FuseFileHandle();
@@ -275,22 +379,8 @@ static int cte_fuse_read(const char *path, char *buf, size_t size,
   if (static_cast<size_t>(offset) + size > file_size)
     size = file_size - offset;
 
-  size_t bytes_read = 0;
-  size_t cur = static_cast<size_t>(offset);
-
-  while (bytes_read < size) {
-    size_t page = cur / kDefaultPageSize;
-    size_t poff = cur % kDefaultPageSize;
-    size_t to_read = std::min(kDefaultPageSize - poff, size - bytes_read);
-
-    if (!CteGetBlob(handle->tag_id, std::to_string(page),
-                    buf + bytes_read, to_read, poff))
-      break;
-
-    bytes_read += to_read;
-    cur += to_read;
-  }
-  return static_cast<int>(bytes_read);
+  return static_cast<int>(CteGetPages(handle->tag_id,
+                                      static_cast<size_t>(offset), buf, size));
 }
 
 static int cte_fuse_write(const char *path, const char *buf, size_t size,
@@ -301,24 +391,40 @@ static int cte_fuse_write(const char *path, const char *buf, size_t size,
   if (size > static_cast<size_t>(INT_MAX))
     size = static_cast<size_t>(INT_MAX);
 
-  size_t bytes_written = 0;
-  size_t cur = static_cast<size_t>(offset);
-
-  while (bytes_written < size) {
-    size_t page = cur / kDefaultPageSize;
-    size_t poff = cur % kDefaultPageSize;
-    size_t to_write = std::min(kDefaultPageSize - poff, size - bytes_written);
+  auto *ipc_manager = CHI_IPC;
+  size_t capacity = 0;
+  hipc::FullPtr<char> shm = ipc_manager->AllocateStagingBuffer(size, capacity);
+  if (shm.IsNull()) return -ENOMEM;
+  memcpy(shm.ptr_, buf, size);
+  int ret = WriteFromShm(handle, shm, size, offset);
+  ipc_manager->FreeStagingBuffer(shm, capacity);
+  return ret;
+}
 
-    if (!CtePutBlob(handle->tag_id, std::to_string(page),
-                    buf + bytes_written, to_write, poff)) {
-      if (bytes_written == 0) return -EIO;
-      break;
-    }
+/**
+ * Write from a FUSE buffer vector. With splice the payload is still in a
+ * pipe, and fuse_buf_copy moves it straight into the shared memory the
+ * page puts read from, skipping the bounce buffer of the plain write path.
+ */
+static int cte_fuse_write_buf(const char *path, struct fuse_bufvec *buf,
+                              off_t offset, struct fuse_file_info *fi) {
+  (void)path;
+  auto *handle = GetHandle(fi);
 
-    bytes_written += to_write;
-    cur += to_write;
-  }
-  return static_cast<int>(bytes_written);
+  size_t size = std::min(fuse_buf_size(buf), static_cast<size_t>(INT_MAX));
+  auto *ipc_manager = CHI_IPC;
+  size_t capacity = 0;
+  hipc::FullPtr<char> shm = ipc_manager->AllocateStagingBuffer(size, capacity);
+  if (shm.IsNull()) return -ENOMEM;
+
+  struct fuse_bufvec dst = FUSE_BUFVEC_INIT(size);
+  dst.buf[0].mem = shm.ptr_;
+  ssize_t copied = fuse_buf_copy(&dst, buf, static_cast<fuse_buf_copy_flags>(0));
+  int ret = copied < 0 ? static_cast<int>(copied)
+                       : WriteFromShm(handle, shm, static_cast<size_t>(copied),
+                                      offset);
+  ipc_manager->FreeStagingBuffer(shm, capacity);
+  return ret;
 }
 
 // ============================================================================
@@ -329,6 +435,7 @@ static int cte_fuse_unlink(const char *path) {
   std::string p(path);
   if (!CteTagExists(p)) return -ENOENT;
   CteDelTag(p);
+  g_meta_cache.Invalidate(p);
   return 0;
 }
 
@@ -361,8 +468,91 @@ static const struct fuse_operations cte_fuse_ops = {
     .destroy = cte_fuse_destroy,
     .create = cte_fuse_create,
     .utimens = cte_fuse_utimens,
+    .write_buf = cte_fuse_write_buf,
 };
 
+static void PrintUsage(const char *prog) {
+  printf("usage: %s [options] <mountpoint>\n\n", prog);
+  printf("CTE options:\n"
+         "    -o cte_max_write=BYTES  largest write request (default 1MB)\n"
+         "    -o cte_max_read=BYTES   largest read request (default 1MB)\n"
+         "    -o cte_threads=N        idle worker threads to keep\n"
+         "    -o cte_cache_ttl=SEC    getattr/readdir cache TTL (default 1,"
+         " 0 = off)\n"
+         "    -o cte_no_splice        do not use splice() for request data\n"
+         "    -o cte_page_cache       cache file data in the kernel page"
+         " cache\n\n");
+}
+
+/**
+ * Mount and serve requests. Mirrors fuse_main, but the multi-threaded loop
+ * is configured from the CTE options and max_read is passed to the mount.
+ */
 int main(int argc, char *argv[]) {
-  return fuse_main(argc, argv, &cte_fuse_ops, nullptr);
+  struct fuse_args args = FUSE_ARGS_INIT(argc, argv);
+  if (fuse_opt_parse(&args, &g_options, kCteFuseOptSpecs, nullptr) == -1)
+    return 1;
+
+  // The kernel only sends reads up to the mount's max_read
+  std::string max_read_opt = "-omax_read=" + std::to_string(g_options.max_read);
+  fuse_opt_add_arg(&args, max_read_opt.c_str());
+
+  struct fuse_cmdline_opts opts;
+  if (fuse_parse_cmdline(&args, &opts) != 0) {
+    fuse_opt_free_args(&args);
+    return 1;
+  }
+  if (g_options.show_help || opts.show_help) {
+    PrintUsage(argv[0]);
+    fuse_cmdline_help();
+    fuse_lib_help(&args);
+    free(opts.mountpoint);
+    fuse_opt_free_args(&args);
+    return 0;
+  }
+  if (opts.show_version) {
+    printf("FUSE library version %s\n", fuse_pkgversion());
+    fuse_lowlevel_version();
+    free(opts.mountpoint);
+    fuse_opt_free_args(&args);
+    return 0;
+  }
+  if (opts.mountpoint == nullptr) {
+    fprintf(stderr, "error: no mountpoint specified\n");
+    PrintUsage(argv[0]);
+    fuse_opt_free_args(&args);
+    return 1;
+  }
+
+  int ret = 1;
+  struct fuse *fuse =
+      fuse_new(&args, &cte_fuse_ops, sizeof(cte_fuse_ops), nullptr);
+  if (fuse == nullptr) goto out_free;
+  if (fuse_mount(fuse, opts.mountpoint) != 0) goto out_destroy;
+  if (fuse_daemonize(opts.foreground) != 0) goto out_unmount;
+  if (fuse_set_signal_handlers(fuse_get_session(fuse)) != 0)
+    goto out_unmount;
+
+  if (opts.singlethread) {
+    ret = fuse_loop(fuse);
+  } else {
+    // Requests of different files run on different workers; clone_fd gives
+    // each worker its own /dev/fuse queue
+    struct fuse_loop_config loop_config;
+    loop_config.clone_fd = opts.clone_fd;
+    loop_config.max_idle_threads =
+        g_options.threads > 0 ? g_options.threads : opts.max_idle_threads;
+    ret = fuse_loop_mt(fuse, &loop_config);
+  }
+  if (ret != 0) ret = 1;
+  fuse_remove_signal_handlers(fuse_get_session(fuse));
+
+out_unmount:
+  fuse_unmount(fuse);
+out_destroy:
+  fuse_destroy(fuse);
+out_free:
+  free(opts.mountpoint);
+  fuse_opt_free_args(&args);
+  return ret;
 }
@@ -43,10 +43,13 @@
 
 #include <algorithm>
 #include <cerrno>
+#include <chrono>
 #include <cstring>
+#include <mutex>
 #include <string>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <unordered_map>
 #include <vector>
 
 #include "wrp_cte/core/core_client.h"
@@ -271,6 +274,224 @@ static inline bool CteGetBlob(const wrp_cte::core::TagId &tag_id,
   return ok;
 }
 
+/** Page requests one CtePutPages / CteGetPages call keeps in flight */
+static constexpr size_t kMaxPagesInflight = 64;
+
+/**
+ * Write a byte range that already sits in shared memory as page blobs.
+ * Every page put of a window is in flight at once, so a 1MB FUSE write
+ * costs one round trip per kMaxPagesInflight pages instead of one per page.
+ * @param tag_id File tag
+ * @param off File offset of the first byte
+ * @param shm Shared memory holding the data
+ * @param size Bytes to write
+ * @return Bytes written, counted as a leading run from \a off
+ */
+static inline size_t CtePutPages(const wrp_cte::core::TagId &tag_id,
+                                 size_t off, const hipc::FullPtr<char> &shm,
+                                 size_t size) {
+  auto *cte_client = WRP_CTE_CLIENT;
+  hipc::ShmPtr<> shm_ptr(shm.shm_);
+  std::vector<chi::Future<wrp_cte::core::PutBlobTask>> tasks;
+  std::vector<size_t> sizes;
+  size_t done = 0;
+  size_t issued = 0;
+  while (done < size) {
+    tasks.clear();
+    sizes.clear();
+    while (issued < size && tasks.size() < kMaxPagesInflight) {
+      size_t cur = off + issued;
+      size_t poff = cur % kDefaultPageSize;
+      size_t len = std::min(kDefaultPageSize - poff, size - issued);
+      tasks.emplace_back(cte_client->AsyncPutBlob(
+          tag_id, std::to_string(cur / kDefaultPageSize), poff, len,
+          shm_ptr + issued));
+      sizes.push_back(len);
+      issued += len;
+    }
+    bool failed = false;
+    for (size_t i = 0; i < tasks.size(); ++i) {
+      tasks[i].Wait();
+      if (failed || tasks[i]->GetReturnCode() != 0) {
+        failed = true;
+      } else {
+        done += sizes[i];
+      }
+    }
+    if (failed) break;
+  }
+  return done;
+}
+
+/**
+ * Read a byte range from page blobs with every page get of a window in
+ * flight at once
+ * @param tag_id File tag
+ * @param off File offset of the first byte
+ * @param data Destination buffer
+ * @param size Bytes to read
+ * @return Bytes read, counted as a leading run from \a off
+ */
+static inline size_t CteGetPages(const wrp_cte::core::TagId &tag_id,
+                                 size_t off, char *data, size_t size) {
+  auto *ipc_manager = CHI_IPC;
+  auto *cte_client = WRP_CTE_CLIENT;
+  size_t capacity = 0;
+  hipc::FullPtr<char> shm = ipc_manager->AllocateStagingBuffer(size, capacity);
+  if (shm.IsNull()) return 0;
+  hipc::ShmPtr<> shm_ptr(shm.shm_);
+  std::vector<chi::Future<wrp_cte::core::GetBlobTask>> tasks;
+  std::vector<size_t> sizes;
+  size_t done = 0;
+  size_t issued = 0;
+  while (done < size) {
+    tasks.clear();
+    sizes.clear();
+    while (issued < size && tasks.size() < kMaxPagesInflight) {
+      size_t cur = off + issued;
+      size_t poff = cur % kDefaultPageSize;
+      size_t len = std::min(kDefaultPageSize - poff, size - issued);
+      tasks.emplace_back(cte_client->AsyncGetBlob(
+          tag_id, std::to_string(cur / kDefaultPageSize), poff, len, 0,
+          shm_ptr + issued));
+      sizes.push_back(len);
+      issued += len;
+    }
+    bool failed = false;
+    for (size_t i = 0; i < tasks.size(); ++i) {
+      tasks[i].Wait();
+      if (failed || tasks[i]->GetReturnCode() != 0) {
+        failed = true;
+      } else {
+        done += sizes[i];
+      }
+    }
+    if (failed) break;
+  }
+  memcpy(data, shm.ptr_, done);
+  ipc_manager->FreeStagingBuffer(shm, capacity);
+  return done;
+}
+
+/**
+ * getattr results and directory listings shared by the daemon's worker
+ * threads. Each lookup otherwise costs several TagQuery round trips.
+ * Entries expire after a TTL, which bounds how long changes made by other
+ * CTE clients stay invisible; changes made through this daemon invalidate
+ * the affected entries right away. A TTL of zero disables the cache.
+ */
+class FuseMetaCache {
+ public:
+  /** Entries kept per map before the map is cleared */
+  static constexpr size_t kMaxEntries = 65536;
+
+  /** Set how long entries stay valid */
+  void SetTtl(double seconds) {
+    std::lock_guard<std::mutex> guard(lock_);
+    ttl_ = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(std::max(seconds, 0.0)));
+    attrs_.clear();
+    dirs_.clear();
+  }
+
+  /**
+   * Look up a cached getattr result
+   * @param st Output attributes when \a err is 0
+   * @param err Output: 0, or the cached negative errno
+   * @return False on a miss
+   */
+  bool GetAttr(const std::string &path, struct stat &st, int &err) {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = attrs_.find(path);
+    if (it == attrs_.end()) return false;
+    if (Clock::now() >= it->second.expires) {
+      attrs_.erase(it);
+      return false;
+    }
+    st = it->second.st;
+    err = it->second.err;
+    return true;
+  }
+
+  /** Cache a getattr result; \a err is 0 or a negative errno */
+  void PutAttr(const std::string &path, const struct stat &st, int err) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (ttl_.count() == 0) return;
+    if (attrs_.size() >= kMaxEntries) attrs_.clear();
+    attrs_[path] = AttrEntry{st, err, Clock::now() + ttl_};
+  }
+
+  /** Look up a cached directory listing */
+  bool GetDir(const std::string &path, std::vector<std::string> &names) {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = dirs_.find(path);
+    if (it == dirs_.end()) return false;
+    if (Clock::now() >= it->second.expires) {
+      dirs_.erase(it);
+      return false;
+    }
+    names = it->second.names;
+    return true;
+  }
+
+  /** Cache a directory listing */
+  void PutDir(const std::string &path, const std::vector<std::string> &names) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (ttl_.count() == 0) return;
+    if (dirs_.size() >= kMaxEntries) dirs_.clear();
+    dirs_[path] = DirEntry{names, Clock::now() + ttl_};
+  }
+
+  /** Raise the cached size of a file written through this daemon */
+  void GrowFile(const std::string &path, size_t size) {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = attrs_.find(path);
+    if (it != attrs_.end() && it->second.err == 0 &&
+        static_cast<size_t>(it->second.st.st_size) < size) {
+      it->second.st.st_size = static_cast<off_t>(size);
+    }
+  }
+
+  /**
+   * Drop the entries a namespace change of \a path can affect: the path
+   * itself and its listing, plus every ancestor, since creating or
+   * removing a file can make implicit parent directories appear or vanish
+   */
+  void Invalidate(const std::string &path) {
+    std::lock_guard<std::mutex> guard(lock_);
+    attrs_.erase(path);
+    dirs_.erase(path);
+    std::string dir = path;
+    while (!dir.empty() && dir != "/") {
+      size_t slash = dir.find_last_of('/');
+      dir = slash == 0 ? "/" : dir.substr(0, slash);
+      attrs_.erase(dir);
+      dirs_.erase(dir);
+    }
+  }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  /** One cached getattr result */
+  struct AttrEntry {
+    struct stat st;
+    int err;
+    Clock::time_point expires;
+  };
+
+  /** One cached directory listing */
+  struct DirEntry {
+    std::vector<std::string> names;
+    Clock::time_point expires;
+  };
+
+  std::mutex lock_;
+  Clock::duration ttl_ = std::chrono::seconds(1);
+  std::unordered_map<std::string, AttrEntry> attrs_;
+  std::unordered_map<std::string, DirEntry> dirs_;
+};
+
 /** Escape a string for use as a literal in std::regex */
 static inline std::string RegexEscape(const std::string &s) {
   std::string out;
@@ -43,7 +43,8 @@ namespace wrp::cae {
  * Also define its construction in the MapperFactory.
  */
 enum class MapperType {
-  kBalancedMapper
+  kBalancedMapper,
+  kAdaptiveMapper
 };
 
 /**
@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef WRP_CTE_ADAPTIVE_MAPPER_H
+#define WRP_CTE_ADAPTIVE_MAPPER_H
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "balanced_mapper.h"
+#include "wrp_cte/core/core_client.h"
+
+namespace wrp::cae {
+
+/**
+ * Per-file record of the variable-size blobs written by the adaptive mapper.
+ * An extent blob named "x<file offset>" holds the bytes [off, off + size) of
+ * the file. Bytes outside every extent live in the regular page blobs named
+ * by page index, so a file may mix both.
+ */
+class ExtentMap {
+ public:
+  /**
+   * Create an empty extent map
+   * @param page_size Adapter page size of the file
+   * @param max_extent_bytes Largest size an extent may grow to
+   * @param frontier End offset of bytes that already exist in the file
+   */
+  ExtentMap(size_t page_size, size_t max_extent_bytes, size_t frontier)
+      : page_size_(page_size),
+        max_extent_bytes_(std::max(max_extent_bytes, page_size)),
+        frontier_(frontier),
+        last_write_end_(frontier) {}
+
+  /** Blob name of the extent starting at file offset \a off */
+  static std::string ExtentName(size_t off) {
+    return "x" + std::to_string(off);
+  }
+
+  /**
+   * Decode an extent blob name
+   * @param name Blob name found in the file's tag
+   * @param off Set to the file offset of the extent
+   * @return false if \a name is not an extent (e.g. a page blob)
+   */
+  static bool ParseExtentName(const std::string &name, size_t &off) {
+    if (name.size() < 2 || name[0] != 'x') {
+      return false;
+    }
+    size_t value = 0;
+    for (size_t i = 1; i < name.size(); ++i) {
+      if (name[i] < '0' || name[i] > '9') {
+        return false;
+      }
+      value = value * 10 + static_cast<size_t>(name[i] - '0');
+    }
+    off = value;
+    return true;
+  }
+
+  /**
+   * Record an extent that exists in the tag (e.g. written by another process)
+   * @param off File offset of the extent
+   * @param size Current size of the extent blob
+   */
+  void AddExtent(size_t off, size_t size) {
+    std::lock_guard<std::mutex> guard(lock_);
+    size_t &cur = extents_[off];
+    cur = std::max(cur, size);
+    frontier_ = std::max(frontier_, off + cur);
+  }
+
+  /**
+   * Move the frontier past bytes written without the mapper
+   * @param end End offset of the written bytes
+   */
+  void Advance(size_t end) {
+    std::lock_guard<std::mutex> guard(lock_);
+    frontier_ = std::max(frontier_, end);
+  }
+
+  /** Number of extents currently known */
+  size_t NumExtents() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return extents_.size();
+  }
+
+ private:
+  friend class AdaptiveMapper;
+
+  size_t page_size_;           /**< Page size of the page blobs */
+  size_t max_extent_bytes_;    /**< Largest size of one extent blob */
+  size_t frontier_;            /**< No extent or page exists past this */
+  size_t last_write_end_;      /**< End offset of the previous write */
+  std::map<size_t, size_t> extents_; /**< File offset -> extent size */
+  mutable std::mutex lock_;
+};
+
+/**
+ * Map file ranges onto extent blobs that grow with sequential writes,
+ * falling back to fixed pages for everything else.
+ *
+ * A write that continues the previous write at the end of the file grows
+ * the last extent (up to its maximum size) or opens a new one, so streams
+ * of small records land in a few large blobs. Writes elsewhere keep the
+ * page layout of BalancedMapper. Bytes already owned by an extent are
+ * always rewritten in place, so reads only need the extent lookup.
+ */
+class AdaptiveMapper : public BalancedMapper {
+ public:
+  /** Virtual destructor */
+  virtual ~AdaptiveMapper() = default;
+
+  /**
+   * Map a write, creating or growing extents as needed
+   * @param map Extent map of the file
+   * @param off File offset of the first byte
+   * @param size Number of bytes written
+   * @return Blob extents in file order covering the whole range
+   */
+  std::vector<wrp_cte::core::BlobExtent> MapWrite(ExtentMap &map, size_t off,
+                                                  size_t size) {
+    std::vector<wrp_cte::core::BlobExtent> out;
+    std::lock_guard<std::mutex> guard(map.lock_);
+    bool sequential = off == map.last_write_end_;
+    size_t end = off + size;
+    size_t cur = off;
+    while (cur < end) {
+      size_t gap_end = MapCovered(map, cur, end, out);
+      if (gap_end == cur) {
+        continue;
+      }
+      if (sequential && cur == map.frontier_) {
+        GrowExtents(map, cur, gap_end, out);
+      } else {
+        MapPages(cur, gap_end - cur, map.page_size_, out);
+      }
+      map.frontier_ = std::max(map.frontier_, gap_end);
+      cur = gap_end;
+    }
+    map.last_write_end_ = end;
+    return out;
+  }
+
+  /**
+   * Map a read onto the extents and pages that hold it
+   * @param map Extent map of the file
+   * @param off File offset of the first byte
+   * @param size Number of bytes read
+   * @return Blob extents in file order covering the whole range
+   */
+  std::vector<wrp_cte::core::BlobExtent> MapRead(ExtentMap &map, size_t off,
+                                                 size_t size) {
+    std::vector<wrp_cte::core::BlobExtent> out;
+    std::lock_guard<std::mutex> guard(map.lock_);
+    size_t end = off + size;
+    size_t cur = off;
+    while (cur < end) {
+      size_t gap_end = MapCovered(map, cur, end, out);
+      if (gap_end == cur) {
+        continue;
+      }
+      MapPages(cur, gap_end - cur, map.page_size_, out);
+      cur = gap_end;
+    }
+    return out;
+  }
+
+ private:
+  /**
+   * Map the bytes at \a cur owned by an extent, or find the gap before the
+   * next extent
+   * @return The end of the gap at \a cur; equals the advanced \a cur when
+   * the bytes were owned by an extent
+   */
+  static size_t MapCovered(ExtentMap &map, size_t &cur, size_t end,
+                           std::vector<wrp_cte::core::BlobExtent> &out) {
+    auto next = map.extents_.upper_bound(cur);
+    if (next != map.extents_.begin()) {
+      auto prev = std::prev(next);
+      size_t ext_end = prev->first + prev->second;
+      if (cur < ext_end) {
+        size_t take = std::min(end, ext_end) - cur;
+        out.push_back(wrp_cte::core::BlobExtent{
+            ExtentMap::ExtentName(prev->first), cur - prev->first, take});
+        cur += take;
+        return cur;
+      }
+    }
+    if (next == map.extents_.end()) {
+      return end;
+    }
+    return std::min(end, next->first);
+  }
+
+  /** Append [cur, end) at the frontier to the last extent or new ones */
+  static void GrowExtents(ExtentMap &map, size_t cur, size_t end,
+                          std::vector<wrp_cte::core::BlobExtent> &out) {
+    while (cur < end) {
+      auto tail = map.extents_.empty() ? map.extents_.end()
+                                       : std::prev(map.extents_.end());
+      size_t take;
+      if (tail != map.extents_.end() && tail->first + tail->second == cur &&
+          tail->second < map.max_extent_bytes_) {
+        take = std::min(map.max_extent_bytes_ - tail->second, end - cur);
+        out.push_back(wrp_cte::core::BlobExtent{
+            ExtentMap::ExtentName(tail->first), tail->second, take});
+        tail->second += take;
+      } else {
+        take = std::min(map.max_extent_bytes_, end - cur);
+        out.push_back(
+            wrp_cte::core::BlobExtent{ExtentMap::ExtentName(cur), 0, take});
+        map.extents_[cur] = take;
+      }
+      cur += take;
+    }
+  }
+
+  /** Append the page blobs covering [off, off + size) */
+  void MapPages(size_t off, size_t size, size_t page_size,
+                std::vector<wrp_cte::core::BlobExtent> &out) {
+    BlobPlacements ps;
+    map(off, size, page_size, ps);
+    for (const BlobPlacement &p : ps) {
+      out.push_back(wrp_cte::core::BlobExtent{std::to_string(p.page_),
+                                              p.blob_off_, p.blob_size_});
+    }
+  }
+};
+
+}  // namespace wrp::cae
+
+#endif  // WRP_CTE_ADAPTIVE_MAPPER_H
@@ -35,6 +35,7 @@
 #define WRP_CTE_ADAPTER_FACTORY_H
 
 #include "abstract_mapper.h"
+#include "adaptive_mapper.h"
 #include "balanced_mapper.h"
 #include "hermes_shm/util/singleton.h"
 
@@ -55,6 +56,9 @@ class MapperFactory {
       case MapperType::kBalancedMapper: {
         return hshm::Singleton<BalancedMapper>::GetInstance();
       }
+      case MapperType::kAdaptiveMapper: {
+        return hshm::Singleton<AdaptiveMapper>::GetInstance();
+      }
       default: {
         // TODO(llogan): @error_handling Mapper not implemented
       }
@@ -34,7 +34,14 @@
 #ifndef WRP_CTE_ADAPTER_MPIIO_MPIIO_FS_API_H_
 #define WRP_CTE_ADAPTER_MPIIO_MPIIO_FS_API_H_
 
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "adapter/filesystem/filesystem.h"
 #include "adapter/filesystem/filesystem_mdm.h"
@@ -115,6 +122,11 @@ public:
 
   int ReadAll(File &f, AdapterStat &stat, void *ptr, size_t offset, int count,
               MPI_Datatype datatype, MPI_Status *status, FsIoOptions opts) {
+    size_t total_size = IoSizeFromCount(count, datatype, opts);
+    CbPlan plan;
+    if (PlanCollective(stat, offset, total_size, false, plan)) {
+      return CollectiveRead(stat, ptr, offset, total_size, status, opts, plan);
+    }
     MPI_Barrier(stat.comm_);
     size_t ret = Read(f, stat, ptr, offset, count, datatype, status, opts);
     MPI_Barrier(stat.comm_);
@@ -161,6 +173,12 @@ public:
                    int count, MPI_Datatype datatype, MPI_Status *status,
                    MPI_Request *request, FsIoOptions opts) {
     if constexpr (!ASYNC) {
+      size_t total_size = IoSizeFromCount(count, datatype, opts);
+      CbPlan plan;
+      if (PlanCollective(stat, offset, total_size, true, plan)) {
+        return CollectiveWrite(stat, ptr, offset, total_size, status, opts,
+                               plan);
+      }
       MPI_Barrier(stat.comm_);
       int ret = Write(f, stat, ptr, offset, count, datatype, status, opts);
       MPI_Barrier(stat.comm_);
@@ -548,6 +566,8 @@ public:
         stat.comm_, path.c_str(), stat.amode_, stat.info_, &stat.mpi_fh_);
     if (f.mpi_status_ != MPI_SUCCESS) {
       f.status_ = false;
+    } else {
+      SetupCollectiveBuffering(stat);
     }
     HLOG(kDebug, "Finished real MPI open");
 
@@ -718,6 +738,405 @@ public:
 #error "No MPI implementation specified for MPIIO adapter"
 #endif
   }
+
+  //////////////////////////
+  /// COLLECTIVE BUFFERING
+  //////////////////////////
+
+  /** Density (requested bytes / extent) below which automatic mode keeps
+   * collective calls independent */
+  static constexpr double kCbMinDensity = 0.5;
+
+  /** Mean per-rank request at or above which page-aligned collective calls
+   * stay independent in automatic mode */
+  static constexpr size_t kCbIndependentBytes = 4 * 1024 * 1024;
+
+  /**
+   * Read the collective buffering hints of a file and pick one aggregator
+   * rank per node of its communicator. Collective over stat.comm_.
+   * Recognized hints: romio_cb_write and romio_cb_read (enable, disable,
+   * automatic) and cb_buffer_size (bytes per aggregator and round).
+   */
+  void SetupCollectiveBuffering(AdapterStat &stat) {
+    CollectiveBuffering &cb = stat.cb_;
+    if (stat.info_ != MPI_INFO_NULL) {
+      cb.write_mode_ = GetCbModeHint(stat.info_, "romio_cb_write");
+      cb.read_mode_ = GetCbModeHint(stat.info_, "romio_cb_read");
+      char value[MPI_MAX_INFO_VAL + 1];
+      int flag = 0;
+      MPI_Info_get(stat.info_, "cb_buffer_size", MPI_MAX_INFO_VAL, value,
+                   &flag);
+      if (flag) {
+        size_t size = std::strtoull(value, nullptr, 10);
+        if (size > 0) {
+          cb.buffer_size_ = size;
+        }
+      }
+    }
+
+    // The lowest rank of each node aggregates for that node
+    MPI_Comm node_comm;
+    int node_rank = 0;
+    MPI_Comm_split_type(stat.comm_, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                        &node_comm);
+    MPI_Comm_rank(node_comm, &node_rank);
+    MPI_Comm_free(&node_comm);
+    int nprocs = 0;
+    MPI_Comm_size(stat.comm_, &nprocs);
+    int is_aggregator = node_rank == 0 ? 1 : 0;
+    std::vector<int> flags(nprocs);
+    MPI_Allgather(&is_aggregator, 1, MPI_INT, flags.data(), 1, MPI_INT,
+                  stat.comm_);
+    cb.aggregators_.clear();
+    for (int rank = 0; rank < nprocs; ++rank) {
+      if (flags[rank]) {
+        cb.aggregators_.push_back(rank);
+      }
+    }
+  }
+
+  /** Parse a romio_cb_* hint of \a info; automatic when unset */
+  static CollectiveBufferingMode GetCbModeHint(MPI_Info info,
+                                               const char *key) {
+    char value[MPI_MAX_INFO_VAL + 1];
+    int flag = 0;
+    MPI_Info_get(info, key, MPI_MAX_INFO_VAL, value, &flag);
+    if (flag && strcmp(value, "enable") == 0) {
+      return CollectiveBufferingMode::kEnable;
+    }
+    if (flag && strcmp(value, "disable") == 0) {
+      return CollectiveBufferingMode::kDisable;
+    }
+    return CollectiveBufferingMode::kAutomatic;
+  }
+
+private:
+  /** The byte range one rank passed to a collective call */
+  struct CbRange {
+    uint64_t off_;
+    uint64_t size_;
+  };
+
+  /** How a collective call is split over the aggregators. Every rank
+   * builds the same plan from the gathered ranges. */
+  struct CbPlan {
+    std::vector<CbRange> ranges_;  /**< Request of each rank */
+    std::vector<int> aggregators_; /**< Aggregator ranks */
+    std::vector<size_t> dom_lo_;   /**< File domain start per aggregator */
+    std::vector<size_t> dom_hi_;   /**< File domain end per aggregator */
+    size_t buffer_size_;           /**< Window bytes per round */
+    size_t rounds_;                /**< Exchange rounds */
+    int rank_;                     /**< This rank */
+    int my_agg_;                   /**< Aggregator index of rank_, or -1 */
+  };
+
+  /** Bytes of \a range inside [lo, hi); its first byte goes to \a start */
+  static size_t CbOverlap(const CbRange &range, size_t lo, size_t hi,
+                          size_t &start) {
+    start = std::max<size_t>(range.off_, lo);
+    size_t end = std::min<size_t>(range.off_ + range.size_, hi);
+    return end > start ? end - start : 0;
+  }
+
+  /** Window of aggregator \a agg in round \a round */
+  static void CbWindow(const CbPlan &plan, size_t agg, size_t round,
+                       size_t &lo, size_t &hi) {
+    lo = std::min(plan.dom_lo_[agg] + round * plan.buffer_size_,
+                  plan.dom_hi_[agg]);
+    hi = std::min(lo + plan.buffer_size_, plan.dom_hi_[agg]);
+  }
+
+  /** Merged runs of [lo, hi) requested by any rank */
+  static std::vector<std::pair<size_t, size_t>> CbRuns(const CbPlan &plan,
+                                                       size_t lo, size_t hi) {
+    std::vector<std::pair<size_t, size_t>> parts;
+    for (const CbRange &range : plan.ranges_) {
+      size_t start;
+      size_t len = CbOverlap(range, lo, hi, start);
+      if (len > 0) {
+        parts.emplace_back(start, start + len);
+      }
+    }
+    std::sort(parts.begin(), parts.end());
+    std::vector<std::pair<size_t, size_t>> runs;
+    for (const auto &part : parts) {
+      if (!runs.empty() && part.first <= runs.back().second) {
+        runs.back().second = std::max(runs.back().second, part.second);
+      } else {
+        runs.push_back(part);
+      }
+    }
+    return runs;
+  }
+
+  /**
+   * Decide whether a collective call goes through the aggregators. Ranges
+   * of all ranks are gathered, so every rank reaches the same decision.
+   * Automatic mode aggregates dense patterns made of small or page-unaligned
+   * pieces, where per-rank puts would be many partial pages; sparse or
+   * large aligned patterns stay independent.
+   * @return True with \a plan filled in to aggregate
+   */
+  bool PlanCollective(AdapterStat &stat, size_t off, size_t size,
+                      bool is_write, CbPlan &plan) {
+    const CollectiveBuffering &cb = stat.cb_;
+    CollectiveBufferingMode mode = is_write ? cb.write_mode_ : cb.read_mode_;
+    int nprocs = 0;
+    MPI_Comm_size(stat.comm_, &nprocs);
+    if (mode == CollectiveBufferingMode::kDisable ||
+        stat.adapter_mode_ == AdapterMode::kBypass || nprocs < 2 ||
+        cb.aggregators_.empty()) {
+      return false;
+    }
+
+    MPI_Comm_rank(stat.comm_, &plan.rank_);
+    CbRange mine{off, size};
+    plan.ranges_.resize(nprocs);
+    MPI_Allgather(&mine, 2, MPI_UINT64_T, plan.ranges_.data(), 2,
+                  MPI_UINT64_T, stat.comm_);
+
+    // Alltoallv counts and displacements are ints; SEEK_END is no offset
+    std::vector<CbRange> active;
+    for (const CbRange &range : plan.ranges_) {
+      if (range.off_ == std::numeric_limits<size_t>::max() ||
+          range.size_ > static_cast<uint64_t>(INT_MAX)) {
+        return false;
+      }
+      if (range.size_ > 0) {
+        active.push_back(range);
+      }
+    }
+    if (active.empty()) {
+      return false;
+    }
+    std::sort(active.begin(), active.end(),
+              [](const CbRange &a, const CbRange &b) { return a.off_ < b.off_; });
+
+    size_t page_size = stat.page_size_;
+    size_t lo = active.front().off_;
+    size_t hi = 0;
+    size_t covered = 0;
+    bool unaligned = false;
+    for (const CbRange &range : active) {
+      size_t end = range.off_ + range.size_;
+      // Aggregators cannot order overlapping writes from several ranks
+      if (range.off_ < hi) {
+        if (is_write) {
+          return false;
+        }
+        covered += end > hi ? end - hi : 0;
+      } else {
+        covered += range.size_;
+      }
+      hi = std::max(hi, end);
+      unaligned |= range.off_ % page_size != 0 || end % page_size != 0;
+    }
+    if (mode == CollectiveBufferingMode::kAutomatic) {
+      bool dense = static_cast<double>(covered) >=
+                   kCbMinDensity * static_cast<double>(hi - lo);
+      bool small = covered / active.size() < kCbIndependentBytes;
+      if (!dense || !(small || unaligned)) {
+        return false;
+      }
+    }
+
+    // Page-aligned file domains: each page has exactly one writer
+    plan.aggregators_ = cb.aggregators_;
+    size_t num_aggs = plan.aggregators_.size();
+    size_t aligned_lo = lo - lo % page_size;
+    size_t per_agg = (hi - aligned_lo + num_aggs - 1) / num_aggs;
+    per_agg = (per_agg + page_size - 1) / page_size * page_size;
+    plan.buffer_size_ =
+        std::max(page_size, cb.buffer_size_ / page_size * page_size);
+    plan.buffer_size_ = std::min(plan.buffer_size_,
+                                 static_cast<size_t>(INT_MAX) /
+                                     page_size * page_size);
+    plan.dom_lo_.resize(num_aggs);
+    plan.dom_hi_.resize(num_aggs);
+    plan.rounds_ = 0;
+    plan.my_agg_ = -1;
+    for (size_t agg = 0; agg < num_aggs; ++agg) {
+      size_t dom_lo = std::min(std::max(lo, aligned_lo + agg * per_agg), hi);
+      size_t dom_hi = std::min(hi, aligned_lo + (agg + 1) * per_agg);
+      plan.dom_lo_[agg] = dom_lo;
+      plan.dom_hi_[agg] = std::max(dom_lo, dom_hi);
+      size_t rounds = (plan.dom_hi_[agg] - dom_lo + plan.buffer_size_ - 1) /
+                      plan.buffer_size_;
+      plan.rounds_ = std::max(plan.rounds_, rounds);
+      if (plan.aggregators_[agg] == plan.rank_) {
+        plan.my_agg_ = static_cast<int>(agg);
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Fill the Alltoallv arguments of one round. Rank-side counts cover this
+   * rank's piece of each aggregator window; aggregator-side counts cover
+   * every rank's piece of this aggregator's window.
+   */
+  static void CbRoundCounts(const CbPlan &plan, size_t round,
+                            std::vector<int> &rank_counts,
+                            std::vector<int> &rank_displs,
+                            std::vector<int> &agg_counts,
+                            std::vector<int> &agg_displs, size_t &win_lo,
+                            size_t &win_hi) {
+    std::fill(rank_counts.begin(), rank_counts.end(), 0);
+    std::fill(rank_displs.begin(), rank_displs.end(), 0);
+    std::fill(agg_counts.begin(), agg_counts.end(), 0);
+    std::fill(agg_displs.begin(), agg_displs.end(), 0);
+    const CbRange &mine = plan.ranges_[plan.rank_];
+    for (size_t agg = 0; agg < plan.aggregators_.size(); ++agg) {
+      size_t lo, hi, start;
+      CbWindow(plan, agg, round, lo, hi);
+      size_t len = CbOverlap(mine, lo, hi, start);
+      int peer = plan.aggregators_[agg];
+      rank_counts[peer] = static_cast<int>(len);
+      rank_displs[peer] = static_cast<int>(len > 0 ? start - mine.off_ : 0);
+    }
+    win_lo = win_hi = 0;
+    if (plan.my_agg_ < 0) {
+      return;
+    }
+    CbWindow(plan, plan.my_agg_, round, win_lo, win_hi);
+    for (size_t rank = 0; rank < plan.ranges_.size(); ++rank) {
+      size_t start;
+      size_t len = CbOverlap(plan.ranges_[rank], win_lo, win_hi, start);
+      agg_counts[rank] = static_cast<int>(len);
+      agg_displs[rank] = static_cast<int>(len > 0 ? start - win_lo : 0);
+    }
+  }
+
+  /**
+   * Write the buffered pages of this rank back and wait for every rank to
+   * do the same, so aggregators never race an older buffered write
+   * @return False if the write-back failed
+   */
+  bool CbFlushPageCache(AdapterStat &stat) {
+    bool ok = true;
+    FilePageCache *cache = stat.page_cache_.get();
+    if (cache && cache->HasDirty()) {
+      ok = cache->Flush(stat.tag_id_);
+    }
+    MPI_Barrier(stat.comm_);
+    return ok;
+  }
+
+  /** Report \a bytes of a collective call in \a status and the file pointer */
+  void CbFinish(AdapterStat &stat, size_t off, size_t bytes,
+                MPI_Status *status, FsIoOptions &opts) {
+    IoStatus io_status;
+    io_status.mpi_status_ptr_ = status;
+    io_status.size_ = bytes;
+    UpdateIoStatus(opts, io_status);
+    if (opts.DoSeek()) {
+      stat.st_ptr_ = off + bytes;
+    }
+    stat.UpdateTime();
+  }
+
+  /**
+   * Two-phase collective write: ranks send their pieces of each aggregator
+   * window with one Alltoallv per round, and aggregators put the merged
+   * runs of their window as whole pages
+   */
+  int CollectiveWrite(AdapterStat &stat, const void *ptr, size_t off,
+                      size_t size, MPI_Status *status, FsIoOptions &opts,
+                      const CbPlan &plan) {
+    int ok = CbFlushPageCache(stat) ? 1 : 0;
+    // Aggregators write this rank's bytes, so its read cache goes stale
+    if (stat.page_cache_) {
+      stat.page_cache_->Invalidate(off, size);
+    }
+    size_t nprocs = plan.ranges_.size();
+    std::vector<int> send_counts(nprocs), send_displs(nprocs);
+    std::vector<int> recv_counts(nprocs), recv_displs(nprocs);
+    std::vector<char> window(plan.my_agg_ >= 0 ? plan.buffer_size_ : 0);
+    for (size_t round = 0; round < plan.rounds_; ++round) {
+      size_t win_lo, win_hi;
+      CbRoundCounts(plan, round, send_counts, send_displs, recv_counts,
+                    recv_displs, win_lo, win_hi);
+      MPI_Alltoallv(const_cast<void *>(ptr), send_counts.data(),
+                    send_displs.data(), MPI_BYTE, window.data(),
+                    recv_counts.data(), recv_displs.data(), MPI_BYTE,
+                    stat.comm_);
+      if (plan.my_agg_ < 0 || !ok) {
+        continue;
+      }
+      for (const auto &run : CbRuns(plan, win_lo, win_hi)) {
+        size_t len = run.second - run.first;
+        try {
+          if (WritePages(stat, run.first, window.data() + run.first - win_lo,
+                         len) < len) {
+            ok = 0;
+          }
+        } catch (const std::exception &e) {
+          HLOG(kError, "Collective write of {} bytes at {} failed: {}", len,
+               run.first, e.what());
+          ok = 0;
+        }
+      }
+    }
+    // Aggregated data must be visible to every rank once the call returns
+    FilePageCache *cache = stat.page_cache_.get();
+    if (plan.my_agg_ >= 0 && cache && cache->HasDirty() &&
+        !cache->Flush(stat.tag_id_)) {
+      ok = 0;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, stat.comm_);
+    CbFinish(stat, off, ok ? size : 0, status, opts);
+    return ok ? MPI_SUCCESS : MPI_ERR_IO;
+  }
+
+  /**
+   * Two-phase collective read: aggregators fetch the merged runs of their
+   * window, then one Alltoallv per round scatters the pieces to the ranks.
+   * Bytes past the end of the file read as zero and are not counted.
+   */
+  int CollectiveRead(AdapterStat &stat, void *ptr, size_t off, size_t size,
+                     MPI_Status *status, FsIoOptions &opts,
+                     const CbPlan &plan) {
+    // {ok, first offset a run came up short}
+    uint64_t result[2] = {CbFlushPageCache(stat) ? 1u : 0u,
+                          std::numeric_limits<uint64_t>::max()};
+    size_t nprocs = plan.ranges_.size();
+    std::vector<int> recv_counts(nprocs), recv_displs(nprocs);
+    std::vector<int> send_counts(nprocs), send_displs(nprocs);
+    std::vector<char> window(plan.my_agg_ >= 0 ? plan.buffer_size_ : 0);
+    for (size_t round = 0; round < plan.rounds_; ++round) {
+      size_t win_lo, win_hi;
+      CbRoundCounts(plan, round, recv_counts, recv_displs, send_counts,
+                    send_displs, win_lo, win_hi);
+      if (plan.my_agg_ >= 0) {
+        for (const auto &run : CbRuns(plan, win_lo, win_hi)) {
+          size_t len = run.second - run.first;
+          char *dst = window.data() + run.first - win_lo;
+          size_t got = 0;
+          try {
+            got = ReadPages(stat, run.first, dst, len);
+          } catch (const std::exception &e) {
+            HLOG(kError, "Collective read of {} bytes at {} failed: {}", len,
+                 run.first, e.what());
+            result[0] = 0;
+          }
+          if (got < len) {
+            memset(dst + got, 0, len - got);
+            result[1] = std::min<uint64_t>(result[1], run.first + got);
+          }
+        }
+      }
+      MPI_Alltoallv(window.data(), send_counts.data(), send_displs.data(),
+                    MPI_BYTE, ptr, recv_counts.data(), recv_displs.data(),
+                    MPI_BYTE, stat.comm_);
+    }
+    MPI_Allreduce(MPI_IN_PLACE, result, 2, MPI_UINT64_T, MPI_MIN, stat.comm_);
+    size_t bytes = 0;
+    if (result[0] && result[1] > off) {
+      bytes = std::min<uint64_t>(size, result[1] - off);
+    }
+    CbFinish(stat, off, bytes, status, opts);
+    return result[0] ? MPI_SUCCESS : MPI_ERR_IO;
+  }
 };
 
 } // namespace wrp::cae
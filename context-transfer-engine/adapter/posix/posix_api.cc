@@ -47,11 +47,13 @@ bool posix_intercepted = true;
 #include "hermes_shm/util/logging.h"
 #include "hermes_shm/util/singleton.h"
 #include "posix_fs_api.h"
+#include "posix_mmap.h"
 
 namespace wrp::cae {
 // Define global pointer variables in source file
 HSHM_DEFINE_GLOBAL_PTR_VAR_CC(PosixApi, g_posix_api);
 HSHM_DEFINE_GLOBAL_PTR_VAR_CC(PosixFs, g_posix_fs);
+HSHM_DEFINE_GLOBAL_PTR_VAR_CC(PosixMmap, g_posix_mmap);
 
 /** Used for compatability with older kernel versions */
 int fxstat_to_fstat(int fd, struct stat *stbuf) {
@@ -535,6 +537,48 @@ int WRP_CTE_DECL(ftruncate64)(int fd, off64_t length) {
   return real_api->ftruncate64(fd, length);
 }
 
+int WRP_CTE_DECL(posix_fallocate)(int fd, off_t offset, off_t len) {
+  auto real_api = WRP_CTE_POSIX_API;
+  auto fs_api = WRP_CTE_POSIX_FS;
+  if (fs_api->IsFdTracked(fd)) {
+    File f;
+    f.hermes_fd_ = fd;
+    HLOG(kDebug, "Intercepted posix_fallocate.");
+    return fs_api->Fallocate(f, offset, len);
+  }
+  return real_api->posix_fallocate(fd, offset, len);
+}
+
+int WRP_CTE_DECL(posix_fallocate64)(int fd, off64_t offset, off64_t len) {
+  auto real_api = WRP_CTE_POSIX_API;
+  auto fs_api = WRP_CTE_POSIX_FS;
+  if (fs_api->IsFdTracked(fd)) {
+    File f;
+    f.hermes_fd_ = fd;
+    HLOG(kDebug, "Intercepted posix_fallocate64.");
+    return fs_api->Fallocate(f, offset, len);
+  }
+  return real_api->posix_fallocate64(fd, offset, len);
+}
+
+int WRP_CTE_DECL(fallocate)(int fd, int mode, off_t offset, off_t len) {
+  auto real_api = WRP_CTE_POSIX_API;
+  auto fs_api = WRP_CTE_POSIX_FS;
+  if (fs_api->IsFdTracked(fd)) {
+    File f;
+    f.hermes_fd_ = fd;
+    HLOG(kDebug, "Intercepted fallocate.");
+    // Only the default mode, which extends the file, maps to a reservation
+    int ret = mode == 0 ? fs_api->Fallocate(f, offset, len) : EOPNOTSUPP;
+    if (ret != 0) {
+      errno = ret;
+      return -1;
+    }
+    return 0;
+  }
+  return real_api->fallocate(fd, mode, offset, len);
+}
+
 int WRP_CTE_DECL(close)(int fd) {
   bool stat_exists;
   auto real_api = WRP_CTE_POSIX_API;
@@ -579,4 +623,55 @@ int WRP_CTE_DECL(unlink)(const char *pathname) {
   return real_api->unlink(pathname);
 }
 
+/**
+ * Memory mapping
+ */
+void *WRP_CTE_DECL(mmap)(void *addr, size_t length, int prot, int flags,
+                         int fd, off_t offset) {
+  auto real_api = WRP_CTE_POSIX_API;
+  auto fs_api = WRP_CTE_POSIX_FS;
+  if (!(flags & MAP_ANONYMOUS) && fs_api->IsFdTracked(fd)) {
+    HLOG(kDebug, "Intercept mmap.");
+    auto mmap_api = WRP_CTE_POSIX_MMAP;
+    return mmap_api->Map(addr, length, prot, flags, fd, offset);
+  }
+  return real_api->mmap(addr, length, prot, flags, fd, offset);
+}
+
+void *WRP_CTE_DECL(mmap64)(void *addr, size_t length, int prot, int flags,
+                           int fd, off64_t offset) {
+  auto real_api = WRP_CTE_POSIX_API;
+  auto fs_api = WRP_CTE_POSIX_FS;
+  if (!(flags & MAP_ANONYMOUS) && fs_api->IsFdTracked(fd)) {
+    HLOG(kDebug, "Intercept mmap64.");
+    auto mmap_api = WRP_CTE_POSIX_MMAP;
+    return mmap_api->Map(addr, length, prot, flags, fd, offset);
+  }
+  return real_api->mmap64(addr, length, prot, flags, fd, offset);
+}
+
+int WRP_CTE_DECL(munmap)(void *addr, size_t length) {
+  auto real_api = WRP_CTE_POSIX_API;
+  if (wrp::cae::PosixMmap::HasRegions()) {
+    auto mmap_api = WRP_CTE_POSIX_MMAP;
+    if (mmap_api->IsTracked(addr)) {
+      HLOG(kDebug, "Intercept munmap.");
+      return mmap_api->Unmap(addr, length);
+    }
+  }
+  return real_api->munmap(addr, length);
+}
+
+int WRP_CTE_DECL(msync)(void *addr, size_t length, int flags) {
+  auto real_api = WRP_CTE_POSIX_API;
+  if (wrp::cae::PosixMmap::HasRegions()) {
+    auto mmap_api = WRP_CTE_POSIX_MMAP;
+    if (mmap_api->IsTracked(addr)) {
+      HLOG(kDebug, "Intercept msync.");
+      return mmap_api->Sync(addr, length, flags);
+    }
+  }
+  return real_api->msync(addr, length, flags);
+}
+
 } // extern C
@@ -34,6 +34,7 @@
 #ifndef WRP_CTE_ADAPTER_POSIX_H
 #define WRP_CTE_ADAPTER_POSIX_H
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -114,6 +115,15 @@ typedef int (*remove_t)(const char *pathname);
 typedef int (*unlink_t)(const char *pathname);
 typedef int (*ftruncate_t)(int fd, off_t length);
 typedef int (*ftruncate64_t)(int fd, off64_t length);
+typedef int (*posix_fallocate_t)(int fd, off_t offset, off_t len);
+typedef int (*posix_fallocate64_t)(int fd, off64_t offset, off64_t len);
+typedef int (*fallocate_t)(int fd, int mode, off_t offset, off_t len);
+typedef void *(*mmap_t)(void *addr, size_t length, int prot, int flags,
+                        int fd, off_t offset);
+typedef void *(*mmap64_t)(void *addr, size_t length, int prot, int flags,
+                          int fd, off64_t offset);
+typedef int (*munmap_t)(void *addr, size_t length);
+typedef int (*msync_t)(void *addr, size_t length, int flags);
 }
 
 namespace wrp::cae {
@@ -198,6 +208,20 @@ class PosixApi : public RealApi {
   ftruncate_t ftruncate = nullptr;
   /** ftruncate64 */
   ftruncate64_t ftruncate64 = nullptr;
+  /** posix_fallocate */
+  posix_fallocate_t posix_fallocate = nullptr;
+  /** posix_fallocate64 */
+  posix_fallocate64_t posix_fallocate64 = nullptr;
+  /** fallocate */
+  fallocate_t fallocate = nullptr;
+  /** mmap */
+  mmap_t mmap = nullptr;
+  /** mmap64 */
+  mmap64_t mmap64 = nullptr;
+  /** munmap */
+  munmap_t munmap = nullptr;
+  /** msync */
+  msync_t msync = nullptr;
 
   PosixApi() : RealApi("open", "posix_intercepted") {
     open = (open_t)dlsym(real_lib_, "open");
@@ -263,6 +287,21 @@ class PosixApi : public RealApi {
     REQUIRE_API(ftruncate)
     ftruncate64 = (ftruncate64_t)dlsym(real_lib_, "ftruncate64");
     REQUIRE_API(ftruncate64)
+    posix_fallocate = (posix_fallocate_t)dlsym(real_lib_, "posix_fallocate");
+    REQUIRE_API(posix_fallocate)
+    posix_fallocate64 =
+        (posix_fallocate64_t)dlsym(real_lib_, "posix_fallocate64");
+    REQUIRE_API(posix_fallocate64)
+    fallocate = (fallocate_t)dlsym(real_lib_, "fallocate");
+    REQUIRE_API(fallocate)
+    mmap = (mmap_t)dlsym(real_lib_, "mmap");
+    REQUIRE_API(mmap)
+    mmap64 = (mmap64_t)dlsym(real_lib_, "mmap64");
+    REQUIRE_API(mmap64)
+    munmap = (munmap_t)dlsym(real_lib_, "munmap");
+    REQUIRE_API(munmap)
+    msync = (msync_t)dlsym(real_lib_, "msync");
+    REQUIRE_API(msync)
   }
 
   bool IsInterceptorLoaded() {
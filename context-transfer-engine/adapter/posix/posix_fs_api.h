@@ -96,6 +96,30 @@ public:
     return result;
   }
 
+  /**
+   * posix_fallocate on a tracked file. Bypassed files are extended on
+   * disk; the others reserve the blobs covering the range.
+   * @param f File
+   * @param off File offset of the first byte
+   * @param len Number of bytes to allocate
+   * @return 0 on success, otherwise an errno value
+   */
+  int Fallocate(File &f, off64_t off, off64_t len) {
+    auto mdm = WRP_CTE_FS_METADATA_MANAGER;
+    auto existing = mdm->Find(f);
+    if (!existing) {
+      return EBADF;
+    }
+    if (off < 0 || len <= 0) {
+      return EINVAL;
+    }
+    AdapterStat &astat = *existing;
+    if (astat.adapter_mode_ == AdapterMode::kBypass) {
+      return real_api_->posix_fallocate64(astat.fd_, off, len);
+    }
+    return Reserve(f, astat, off, len) == 0 ? 0 : ENOSPC;
+  }
+
   /** Whether or not \a fd FILE DESCRIPTOR was generated by Hermes */
   static bool IsFdTracked(int fd, std::shared_ptr<AdapterStat> &stat) {
     if (fd < 8192) {
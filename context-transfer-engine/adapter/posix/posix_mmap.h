@@ -0,0 +1,568 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef WRP_CTE_ADAPTER_POSIX_MMAP_H_
+#define WRP_CTE_ADAPTER_POSIX_MMAP_H_
+
+#include <fcntl.h>
+#include <linux/userfaultfd.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "hermes_shm/util/logging.h"
+#include "posix_api.h"
+#include "posix_fs_api.h"
+
+namespace wrp::cae {
+
+/** One intercepted mmap() of a tracked file, backed by CTE page blobs */
+struct MmapRegion {
+  char *base_ = nullptr;     /**< Start of the anonymous mapping */
+  size_t len_ = 0;           /**< Mapping length rounded to system pages */
+  size_t file_off_ = 0;      /**< File offset mapped at base_ */
+  size_t chunk_size_ = 0;    /**< Fault/readahead unit (system page multiple) */
+  bool writeback_ = false;   /**< MAP_SHARED + PROT_WRITE: flush on msync */
+  File file_;                /**< Private handle open for the mapping's life */
+  std::vector<bool> resident_;  /**< Per-chunk: populated from CTE */
+  std::vector<bool> dirty_;     /**< Per-chunk: modified since last flush */
+
+  /** Number of chunks covering the mapping */
+  size_t NumChunks() const { return resident_.size(); }
+
+  /** Byte length of chunk \a idx (the last chunk may be short) */
+  size_t ChunkLen(size_t idx) const {
+    return std::min(chunk_size_, len_ - idx * chunk_size_);
+  }
+};
+
+/**
+ * Memory-mapped mode for the POSIX adapter.
+ *
+ * mmap() of a tracked file returns an anonymous region registered with
+ * userfaultfd. A handler thread fills missing pages on demand from the
+ * file's page blobs, reading kReadaheadChunks adjacent chunks in the same
+ * batched GetBlob. Writable shared mappings are populated write-protected
+ * (when the kernel supports UFFD write-protect) so the first store to a
+ * chunk marks it dirty; msync() and munmap() write dirty chunks back through
+ * the batched PutBlob path. Without userfaultfd the region is filled eagerly
+ * and every chunk of a writable shared mapping is treated as dirty.
+ */
+class PosixMmap {
+ public:
+  /** Chunks fetched after a faulting chunk in the same batch */
+  static constexpr size_t kReadaheadChunks = 4;
+
+  /** Whether any region is mapped (checked before touching singletons) */
+  static bool HasRegions() { return NumRegions().load() > 0; }
+
+  /**
+   * Map a tracked file
+   * @return Mapping address, or MAP_FAILED with errno set
+   */
+  void *Map(void *addr, size_t length, int prot, int flags, int fd,
+            off64_t offset) {
+    size_t sys_page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    if (length == 0 || offset < 0 ||
+        static_cast<size_t>(offset) % sys_page != 0) {
+      errno = EINVAL;
+      return MAP_FAILED;
+    }
+    auto fs_api = WRP_CTE_POSIX_FS;
+    auto mdm = WRP_CTE_FS_METADATA_MANAGER;
+    File orig;
+    orig.hermes_fd_ = fd;
+    std::shared_ptr<AdapterStat> orig_stat = mdm->Find(orig);
+    if (!orig_stat) {
+      errno = EBADF;
+      return MAP_FAILED;
+    }
+
+    auto region = std::make_unique<MmapRegion>();
+    region->len_ = (length + sys_page - 1) / sys_page * sys_page;
+    region->file_off_ = static_cast<size_t>(offset);
+    region->chunk_size_ =
+        std::max(sys_page, orig_stat->page_size_ / sys_page * sys_page);
+    region->writeback_ = (flags & MAP_SHARED) && (prot & PROT_WRITE);
+    size_t num_chunks =
+        (region->len_ + region->chunk_size_ - 1) / region->chunk_size_;
+    region->resident_.assign(num_chunks, false);
+    region->dirty_.assign(num_chunks, false);
+
+    // Keep a private handle so the mapping outlives close(fd), as in POSIX
+    AdapterStat stat;
+    stat.flags_ = region->writeback_ ? O_RDWR : O_RDONLY;
+    stat.st_mode_ = 0;
+    region->file_ = fs_api->Open(stat, orig_stat->path_);
+    if (!region->file_.status_) {
+      errno = EACCES;
+      return MAP_FAILED;
+    }
+
+    std::lock_guard<std::mutex> lock(lock_);
+    bool use_uffd = InitUffd();
+    int anon_prot = use_uffd ? prot : (prot | PROT_WRITE);
+    int anon_flags = MAP_PRIVATE | MAP_ANONYMOUS | (flags & MAP_FIXED);
+    void *base = WRP_CTE_POSIX_API->mmap(addr, region->len_, anon_prot,
+                                         anon_flags, -1, 0);
+    if (base == MAP_FAILED) {
+      int saved_errno = errno;
+      CloseFile(*region);
+      errno = saved_errno;
+      return MAP_FAILED;
+    }
+    region->base_ = static_cast<char *>(base);
+    if (!use_uffd || !Register(*region)) {
+      FillEager(*region, prot);
+    }
+    HLOG(kDebug, "mmap of {} off={} len={} at {} ({})", orig_stat->path_,
+         offset, region->len_, base, use_uffd ? "on-demand" : "eager");
+    AddRegion(std::move(region));
+    return base;
+  }
+
+  /** Whether \a addr falls inside an intercepted mapping */
+  bool IsTracked(const void *addr) {
+    std::lock_guard<std::mutex> lock(lock_);
+    return FindRegion(addr) != nullptr;
+  }
+
+  /**
+   * Unmap (part of) an intercepted mapping, writing dirty chunks back first
+   * @return 0 on success, -1 with errno set
+   */
+  int Unmap(void *addr, size_t length) {
+    std::lock_guard<std::mutex> lock(lock_);
+    MmapRegion *region = FindRegion(addr);
+    if (region == nullptr) {
+      errno = EINVAL;
+      return -1;
+    }
+    // munmap() removes whole pages, so the hole ends on a page boundary
+    size_t sys_page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    char *begin = static_cast<char *>(addr);
+    char *region_end = region->base_ + region->len_;
+    size_t hole_len = (length + sys_page - 1) / sys_page * sys_page;
+    char *end = begin + std::min(hole_len,
+                                 static_cast<size_t>(region_end - begin));
+    WriteBack(*region, begin, end);
+    int ret = WRP_CTE_POSIX_API->munmap(addr, length);
+    if (ret != 0) {
+      return ret;
+    }
+    std::unique_ptr<MmapRegion> old =
+        std::move(regions_[reinterpret_cast<uintptr_t>(region->base_)]);
+    regions_.erase(reinterpret_cast<uintptr_t>(old->base_));
+    NumRegions().fetch_sub(1);
+    // A partial unmap leaves the pieces before and after the hole mapped;
+    // each becomes its own region (the kernel keeps their uffd registration)
+    bool file_taken = false;
+    if (begin > old->base_) {
+      std::unique_ptr<MmapRegion> head = Slice(*old, old->base_, begin);
+      head->file_ = old->file_;
+      file_taken = true;
+      AddRegion(std::move(head));
+    }
+    if (end < region_end) {
+      std::unique_ptr<MmapRegion> tail = Slice(*old, end, region_end);
+      if (file_taken) {
+        tail->file_ = ReopenFile(*old);
+        if (!tail->file_.status_) {
+          HLOG(kWarning, "munmap: cannot reopen file of the mapping tail, "
+               "its stores will not be written back");
+          tail->writeback_ = false;
+        }
+      } else {
+        tail->file_ = old->file_;
+        file_taken = true;
+      }
+      AddRegion(std::move(tail));
+    }
+    if (!file_taken) {
+      // Whole mapping gone; the kernel drops the uffd registration with it
+      CloseFile(*old);
+    }
+    return 0;
+  }
+
+  /**
+   * msync: write back dirty chunks of an intercepted mapping
+   * @return 0 on success, -1 with errno set
+   */
+  int Sync(void *addr, size_t length, int flags) {
+    (void)flags;
+    std::lock_guard<std::mutex> lock(lock_);
+    MmapRegion *region = FindRegion(addr);
+    if (region == nullptr) {
+      errno = ENOMEM;
+      return -1;
+    }
+    char *begin = static_cast<char *>(addr);
+    char *end = std::min(begin + length, region->base_ + region->len_);
+    return WriteBack(*region, begin, end) ? 0 : (errno = EIO, -1);
+  }
+
+ private:
+  /** Process-wide count of live regions */
+  static std::atomic<size_t> &NumRegions() {
+    static std::atomic<size_t> num_regions(0);
+    return num_regions;
+  }
+
+  /** Track a mapped region (lock_ must be held) */
+  void AddRegion(std::unique_ptr<MmapRegion> region) {
+    uintptr_t key = reinterpret_cast<uintptr_t>(region->base_);
+    regions_[key] = std::move(region);
+    NumRegions().fetch_add(1);
+  }
+
+  /**
+   * Piece [begin, end) of \a region as a region of its own, without a file
+   * handle. A chunk of the piece is resident only if every old chunk it
+   * overlaps is, and dirty if any of them is.
+   */
+  static std::unique_ptr<MmapRegion> Slice(const MmapRegion &region,
+                                           char *begin, char *end) {
+    auto piece = std::make_unique<MmapRegion>();
+    piece->base_ = begin;
+    piece->len_ = static_cast<size_t>(end - begin);
+    piece->file_off_ =
+        region.file_off_ + static_cast<size_t>(begin - region.base_);
+    piece->chunk_size_ = region.chunk_size_;
+    piece->writeback_ = region.writeback_;
+    size_t num_chunks =
+        (piece->len_ + piece->chunk_size_ - 1) / piece->chunk_size_;
+    piece->resident_.assign(num_chunks, true);
+    piece->dirty_.assign(num_chunks, false);
+    for (size_t j = 0; j < num_chunks; ++j) {
+      size_t lo = static_cast<size_t>(begin - region.base_) +
+                  j * piece->chunk_size_;
+      size_t hi = lo + piece->ChunkLen(j);
+      for (size_t i = lo / region.chunk_size_;
+           i <= (hi - 1) / region.chunk_size_; ++i) {
+        piece->resident_[j] = piece->resident_[j] && region.resident_[i];
+        piece->dirty_[j] = piece->dirty_[j] || region.dirty_[i];
+      }
+    }
+    return piece;
+  }
+
+  /** Open another private handle on the file of \a region */
+  File ReopenFile(const MmapRegion &region) {
+    auto fs_api = WRP_CTE_POSIX_FS;
+    auto mdm = WRP_CTE_FS_METADATA_MANAGER;
+    std::shared_ptr<AdapterStat> file_stat = mdm->Find(region.file_);
+    if (!file_stat) {
+      File file;
+      file.status_ = false;
+      return file;
+    }
+    AdapterStat stat;
+    stat.flags_ = region.writeback_ ? O_RDWR : O_RDONLY;
+    stat.st_mode_ = 0;
+    return fs_api->Open(stat, file_stat->path_);
+  }
+
+  /** Region containing \a addr, or nullptr (lock_ must be held) */
+  MmapRegion *FindRegion(const void *addr) {
+    uintptr_t key = reinterpret_cast<uintptr_t>(addr);
+    auto it = regions_.upper_bound(key);
+    if (it == regions_.begin()) {
+      return nullptr;
+    }
+    --it;
+    MmapRegion *region = it->second.get();
+    if (key >= it->first + region->len_) {
+      return nullptr;
+    }
+    return region;
+  }
+
+  /**
+   * Open the userfaultfd and start the fault handler once (lock_ held)
+   * @return false if userfaultfd is unavailable (eager fallback)
+   */
+  bool InitUffd() {
+    if (uffd_init_) {
+      return uffd_ >= 0;
+    }
+    uffd_init_ = true;
+    // Not UFFD_USER_MODE_ONLY: the kernel also touches mapped pages, e.g.
+    // write() or send() from a mapped buffer, and a user-mode-only uffd
+    // fails those with EFAULT instead of letting the handler fill the page
+    uffd_ = static_cast<int>(syscall(SYS_userfaultfd, O_CLOEXEC));
+    if (uffd_ < 0) {
+      HLOG(kWarning, "userfaultfd unavailable ({}), mmap will fill eagerly",
+           strerror(errno));
+      return false;
+    }
+    struct uffdio_api api;
+    memset(&api, 0, sizeof(api));
+    api.api = UFFD_API;
+#ifdef UFFD_FEATURE_PAGEFAULT_FLAG_WP
+    api.features = UFFD_FEATURE_PAGEFAULT_FLAG_WP;
+#endif
+    if (ioctl(uffd_, UFFDIO_API, &api) != 0) {
+      // Retry without write-protect support
+      memset(&api, 0, sizeof(api));
+      api.api = UFFD_API;
+      if (ioctl(uffd_, UFFDIO_API, &api) != 0) {
+        WRP_CTE_POSIX_API->close(uffd_);
+        uffd_ = -1;
+        return false;
+      }
+    }
+#ifdef UFFD_FEATURE_PAGEFAULT_FLAG_WP
+    wp_supported_ = (api.features & UFFD_FEATURE_PAGEFAULT_FLAG_WP) != 0;
+#endif
+    std::thread(&PosixMmap::HandlerLoop, this).detach();
+    return true;
+  }
+
+  /** Register a fresh region with the userfaultfd (lock_ held) */
+  bool Register(MmapRegion &region) {
+    struct uffdio_register reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.range.start = reinterpret_cast<__u64>(region.base_);
+    reg.range.len = region.len_;
+    reg.mode = UFFDIO_REGISTER_MODE_MISSING;
+#ifdef UFFDIO_REGISTER_MODE_WP
+    if (wp_supported_ && region.writeback_) {
+      reg.mode |= UFFDIO_REGISTER_MODE_WP;
+    }
+#endif
+    if (ioctl(uffd_, UFFDIO_REGISTER, &reg) != 0) {
+      HLOG(kWarning, "UFFDIO_REGISTER failed ({}), filling mmap eagerly",
+           strerror(errno));
+      return false;
+    }
+    return true;
+  }
+
+  /** Serve page faults until the process exits */
+  void HandlerLoop() {
+    struct pollfd pfd;
+    pfd.fd = uffd_;
+    pfd.events = POLLIN;
+    while (true) {
+      if (poll(&pfd, 1, -1) <= 0) {
+        continue;
+      }
+      struct uffd_msg msg;
+      ssize_t nread = WRP_CTE_POSIX_API->read(uffd_, &msg, sizeof(msg));
+      if (nread != sizeof(msg) || msg.event != UFFD_EVENT_PAGEFAULT) {
+        continue;
+      }
+      char *fault = reinterpret_cast<char *>(msg.arg.pagefault.address);
+      std::lock_guard<std::mutex> lock(lock_);
+      MmapRegion *region = FindRegion(fault);
+      if (region == nullptr) {
+        continue;
+      }
+      size_t chunk = (fault - region->base_) / region->chunk_size_;
+#ifdef UFFD_PAGEFAULT_FLAG_WP
+      if (msg.arg.pagefault.flags & UFFD_PAGEFAULT_FLAG_WP) {
+        // First store to a populated chunk: mark dirty and allow writes
+        region->dirty_[chunk] = true;
+        SetWriteProtect(*region, chunk, false);
+        continue;
+      }
+#endif
+      FillMissing(*region, chunk);
+    }
+  }
+
+  /**
+   * Populate a faulting chunk plus up to kReadaheadChunks non-resident
+   * successors with one batched read (lock_ held)
+   */
+  void FillMissing(MmapRegion &region, size_t chunk) {
+    size_t last = chunk;
+    while (last + 1 < region.NumChunks() && last - chunk < kReadaheadChunks &&
+           !region.resident_[last + 1]) {
+      ++last;
+    }
+    size_t run_off = chunk * region.chunk_size_;
+    size_t run_len = (last - chunk) * region.chunk_size_ + region.ChunkLen(last);
+    size_t sys_page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    char *buf = static_cast<char *>(aligned_alloc(sys_page, run_len));
+    if (buf == nullptr) {
+      return;
+    }
+    ReadRange(region, run_off, buf, run_len);
+
+    bool protect = wp_supported_ && region.writeback_;
+    for (size_t i = chunk; i <= last; ++i) {
+      struct uffdio_copy copy;
+      memset(&copy, 0, sizeof(copy));
+      copy.dst = reinterpret_cast<__u64>(region.base_ + i * region.chunk_size_);
+      copy.src = reinterpret_cast<__u64>(buf + (i - chunk) * region.chunk_size_);
+      copy.len = region.ChunkLen(i);
+#ifdef UFFDIO_COPY_MODE_WP
+      copy.mode = protect ? UFFDIO_COPY_MODE_WP : 0;
+#endif
+      // EEXIST: another thread raced us to this chunk; nothing to do
+      if (ioctl(uffd_, UFFDIO_COPY, &copy) == 0 || errno == EEXIST) {
+        region.resident_[i] = true;
+        region.dirty_[i] = region.writeback_ && !protect;
+      }
+    }
+    free(buf);
+  }
+
+  /** Populate a whole region up front when userfaultfd is unavailable */
+  void FillEager(MmapRegion &region, int prot) {
+    ReadRange(region, 0, region.base_, region.len_);
+    for (size_t i = 0; i < region.NumChunks(); ++i) {
+      region.resident_[i] = true;
+      region.dirty_[i] = region.writeback_;
+    }
+    if (!(prot & PROT_WRITE)) {
+      mprotect(region.base_, region.len_, prot);
+    }
+  }
+
+  /** Read region bytes [off, off + len) from CTE, zero-filling past EOF */
+  void ReadRange(MmapRegion &region, size_t off, char *buf, size_t len) {
+    auto fs_api = WRP_CTE_POSIX_FS;
+    bool stat_exists;
+    size_t file_size = fs_api->GetSize(region.file_, stat_exists);
+    size_t file_pos = region.file_off_ + off;
+    size_t avail = file_pos < file_size ? std::min(len, file_size - file_pos)
+                                        : 0;
+    size_t got = 0;
+    if (avail > 0) {
+      IoStatus io_status;
+      got = fs_api->Read(region.file_, stat_exists, buf, file_pos, avail,
+                         io_status);
+      got = std::min(got, avail);
+    }
+    memset(buf + got, 0, len - got);
+  }
+
+  /** Toggle UFFD write protection on one chunk (lock_ held) */
+  void SetWriteProtect(MmapRegion &region, size_t chunk, bool enable) {
+#ifdef UFFDIO_WRITEPROTECT
+    struct uffdio_writeprotect wp;
+    memset(&wp, 0, sizeof(wp));
+    wp.range.start =
+        reinterpret_cast<__u64>(region.base_ + chunk * region.chunk_size_);
+    wp.range.len = region.ChunkLen(chunk);
+    wp.mode = enable ? UFFDIO_WRITEPROTECT_MODE_WP : 0;
+    ioctl(uffd_, UFFDIO_WRITEPROTECT, &wp);
+#else
+    (void)region;
+    (void)chunk;
+    (void)enable;
+#endif
+  }
+
+  /**
+   * Write dirty chunks overlapping [begin, end) back to CTE (lock_ held).
+   * Chunks are re-protected before the copy so concurrent stores re-dirty.
+   * @return false if any write failed
+   */
+  bool WriteBack(MmapRegion &region, char *begin, char *end) {
+    if (!region.writeback_) {
+      return true;
+    }
+    auto fs_api = WRP_CTE_POSIX_FS;
+    bool stat_exists;
+    size_t file_size = fs_api->GetSize(region.file_, stat_exists);
+    bool protect = wp_supported_ && uffd_ >= 0;
+    bool ok = true;
+    for (size_t i = 0; i < region.NumChunks(); ++i) {
+      char *chunk = region.base_ + i * region.chunk_size_;
+      if (!region.dirty_[i] || chunk + region.ChunkLen(i) <= begin ||
+          chunk >= end) {
+        continue;
+      }
+      if (protect) {
+        SetWriteProtect(region, i, true);
+      }
+      region.dirty_[i] = !protect;
+      // msync never extends the file
+      size_t file_pos = region.file_off_ + i * region.chunk_size_;
+      if (file_pos >= file_size) {
+        continue;
+      }
+      size_t len = std::min(region.ChunkLen(i), file_size - file_pos);
+      IoStatus io_status;
+      size_t wrote = fs_api->Write(region.file_, stat_exists, chunk, file_pos,
+                                   len, io_status);
+      ok = ok && wrote == len;
+    }
+    return ok;
+  }
+
+  /** Release the private file handle of a region */
+  void CloseFile(MmapRegion &region) {
+    auto fs_api = WRP_CTE_POSIX_FS;
+    bool stat_exists;
+    fs_api->Close(region.file_, stat_exists);
+  }
+
+  std::mutex lock_;
+  std::map<uintptr_t, std::unique_ptr<MmapRegion>> regions_;
+  int uffd_ = -1;
+  bool uffd_init_ = false;
+  bool wp_supported_ = false;
+};
+
+}  // namespace wrp::cae
+
+// Global pointer-based singleton
+#include "hermes_shm/util/singleton.h"
+
+namespace wrp::cae {
+HSHM_DEFINE_GLOBAL_PTR_VAR_H(PosixMmap, g_posix_mmap);
+}
+
+/** Simplify access to the PosixMmap Singleton */
+#define WRP_CTE_POSIX_MMAP \
+  (HSHM_GET_GLOBAL_PTR_VAR(wrp::cae::PosixMmap, wrp::cae::g_posix_mmap))
+
+#endif  // WRP_CTE_ADAPTER_POSIX_MMAP_H_
@@ -39,6 +39,7 @@ bool stdio_intercepted = true;
 #include <sys/file.h>
 
 #include "wrp_cte/core/core_client.h"
+#include <cerrno>
 #include <cstdio>
 
 #include "stdio_fs_api.h"
@@ -130,7 +131,15 @@ int WRP_CTE_DECL(fflush)(FILE *fp) {
     HLOG(kDebug, "Intercepting fflush");
     File f;
     f.hermes_fh_ = fp;
-    return fs_api->Sync(f, stat_exists);
+    bool flushed = fs_api->FlushBuffer(f, stat_exists);
+    int ret = fs_api->Sync(f, stat_exists);
+    return flushed ? ret : EOF;
+  }
+  if (fp == nullptr) {
+    // fflush(NULL) flushes every output stream, intercepted ones included
+    bool flushed = fs_api->FlushAllBuffers(true);
+    int ret = real_api->fflush(nullptr);
+    return flushed ? ret : EOF;
   }
   return real_api->fflush(fp);
 }
@@ -143,7 +152,9 @@ int WRP_CTE_DECL(fclose)(FILE *fp) {
     HLOG(kDebug, "Intercepting fclose({})", (void *)fp);
     File f;
     f.hermes_fh_ = fp;
-    return fs_api->Close(f, stat_exists);
+    bool flushed = fs_api->FlushBuffer(f, stat_exists);
+    int ret = fs_api->Close(f, stat_exists);
+    return flushed ? ret : EOF;
   }
   return real_api->fclose(fp);
 }
@@ -159,7 +170,7 @@ size_t WRP_CTE_DECL(fwrite)(const void *ptr, size_t size, size_t nmemb,
     File f;
     f.hermes_fh_ = fp;
     IoStatus io_status;
-    int ret = fs_api->Write(f, stat_exists, ptr, size * nmemb, io_status);
+    int ret = fs_api->BufferedWrite(f, stat_exists, ptr, size * nmemb, io_status);
     if (ret > 0) {
       return ret / size;
     } else {
@@ -178,7 +189,7 @@ int WRP_CTE_DECL(fputc)(int c, FILE *fp) {
     File f;
     f.hermes_fh_ = fp;
     IoStatus io_status;
-    fs_api->Write(f, stat_exists, &c, 1, io_status);
+    fs_api->BufferedWrite(f, stat_exists, &c, 1, io_status);
     if (stat_exists) {
       return c;
     }
@@ -199,7 +210,7 @@ int WRP_CTE_DECL(fgetpos)(FILE *fp, fpos_t *pos) {
     // conversion state information. In other systems, it might have a
     // different internal representation. This will need to change to support
     // other compilers.
-    pos->__pos = fs_api->Tell(f, stat_exists);
+    pos->__pos = fs_api->BufferedTell(f, stat_exists);
     if (stat_exists) {
       return 0;
     }
@@ -220,7 +231,7 @@ int WRP_CTE_DECL(fgetpos64)(FILE *fp, fpos64_t *pos) {
     // conversion state information. In other systems, it might have a
     // different internal representation. This will need to change to support
     // other compilers.
-    pos->__pos = fs_api->Tell(f, stat_exists);
+    pos->__pos = fs_api->BufferedTell(f, stat_exists);
     return 0;
   }
   return real_api->fgetpos64(fp, pos);
@@ -235,7 +246,7 @@ int WRP_CTE_DECL(putc)(int c, FILE *fp) {
     f.hermes_fh_ = fp;
     IoStatus io_status;
     HLOG(kDebug, "Intercepting putc");
-    fs_api->Write(f, stat_exists, &c, 1, io_status);
+    fs_api->BufferedWrite(f, stat_exists, &c, 1, io_status);
     return c;
   }
   return real_api->fputc(c, fp);
@@ -250,7 +261,7 @@ int WRP_CTE_DECL(putw)(int w, FILE *fp) {
     File f;
     f.hermes_fh_ = fp;
     IoStatus io_status;
-    int ret = fs_api->Write(f, stat_exists, &w, sizeof(w), io_status);
+    int ret = fs_api->BufferedWrite(f, stat_exists, &w, sizeof(w), io_status);
     if (ret == sizeof(w)) {
       return 0;
     } else {
@@ -269,7 +280,7 @@ int WRP_CTE_DECL(fputs)(const char *s, FILE *stream) {
     File f;
     f.hermes_fh_ = stream;
     IoStatus io_status;
-    return fs_api->Write(f, stat_exists, s, strlen(s), io_status);
+    return fs_api->BufferedWrite(f, stat_exists, s, strlen(s), io_status);
   }
   return real_api->fputs(s, stream);
 }
@@ -284,7 +295,7 @@ size_t WRP_CTE_DECL(fread)(void *ptr, size_t size, size_t nmemb, FILE *stream) {
     File f;
     f.hermes_fh_ = stream;
     IoStatus io_status;
-    int ret = fs_api->Read(f, stat_exists, ptr, size * nmemb, io_status);
+    int ret = fs_api->BufferedRead(f, stat_exists, ptr, size * nmemb, io_status);
     if (ret > 0) {
       return ret / size;
     } else {
@@ -304,7 +315,10 @@ int WRP_CTE_DECL(fgetc)(FILE *stream) {
     f.hermes_fh_ = stream;
     IoStatus io_status;
     u8 value;
-    fs_api->Read(f, stat_exists, &value, sizeof(u8), io_status);
+    if (fs_api->BufferedRead(f, stat_exists, &value, sizeof(u8), io_status) ==
+        0) {
+      return EOF;
+    }
     return value;
   }
   return real_api->fgetc(stream);
@@ -320,7 +334,10 @@ int WRP_CTE_DECL(getc)(FILE *stream) {
     f.hermes_fh_ = stream;
     IoStatus io_status;
     u8 value;
-    fs_api->Read(f, stat_exists, &value, sizeof(u8), io_status);
+    if (fs_api->BufferedRead(f, stat_exists, &value, sizeof(u8), io_status) ==
+        0) {
+      return EOF;
+    }
     return value;
   }
   return real_api->getc(stream);
@@ -336,7 +353,10 @@ int WRP_CTE_DECL(getw)(FILE *stream) {
     f.hermes_fh_ = stream;
     IoStatus io_status;
     int value;
-    fs_api->Read(f, stat_exists, &value, sizeof(int), io_status);
+    if (fs_api->BufferedRead(f, stat_exists, &value, sizeof(int),
+                             io_status) != sizeof(int)) {
+      return EOF;
+    }
     return value;
   }
   return real_api->getc(stream);
@@ -351,26 +371,17 @@ char *WRP_CTE_DECL(fgets)(char *s, int size, FILE *stream) {
     File f;
     f.hermes_fh_ = stream;
     IoStatus io_status;
-    size_t read_size = size - 1;
-    size_t ret_size = fs_api->Read(f, stat_exists, s, read_size, io_status);
-    if (ret_size < read_size) {
-      /* FILE ended */
-      read_size = ret_size;
+    if (size <= 0) {
+      return nullptr;
     }
-    /* Check if \0 or \n in s.*/
-    size_t copy_pos = 0;
-    for (size_t i = 0; i < read_size; ++i) {
-      if (s[i] == '\0' || s[i] == '\n') {
-        copy_pos = i;
-        break;
-      }
-    }
-    if (copy_pos > 0) {
-      /* \n and \0 was found. */
-      s[copy_pos + 1] = '\0';
-    } else {
-      s[read_size] = '\0';
+    // The buffer stops at the first newline, so the stream is left right
+    // after the returned line
+    size_t read_size = fs_api->BufferedRead(f, stat_exists, s, size - 1,
+                                            io_status, true);
+    if (read_size == 0) {
+      return nullptr;
     }
+    s[read_size] = '\0';
     return s;
   }
   return real_api->fgets(s, size, stream);
@@ -384,7 +395,7 @@ void WRP_CTE_DECL(rewind)(FILE *stream) {
     HLOG(kDebug, "Intercepting rewind");
     File f;
     f.hermes_fh_ = stream;
-    fs_api->Seek(f, stat_exists, SeekMode::kSet, 0);
+    fs_api->BufferedSeek(f, stat_exists, SeekMode::kSet, 0);
     return;
   }
   real_api->rewind(stream);
@@ -398,7 +409,7 @@ int WRP_CTE_DECL(fseek)(FILE *stream, long offset, int whence) {
     HLOG(kDebug, "Intercepting fseek offset: {} whence: {}", offset, whence);
     File f;
     f.hermes_fh_ = stream;
-    fs_api->Seek(f, stat_exists, static_cast<SeekMode>(whence), offset);
+    fs_api->BufferedSeek(f, stat_exists, static_cast<SeekMode>(whence), offset);
     return 0;
   }
   return real_api->fseek(stream, offset, whence);
@@ -412,7 +423,7 @@ int WRP_CTE_DECL(fseeko)(FILE *stream, off_t offset, int whence) {
     HLOG(kDebug, "Intercepting fseeko offset: {} whence: {}", offset, whence);
     File f;
     f.hermes_fh_ = stream;
-    fs_api->Seek(f, stat_exists, static_cast<SeekMode>(whence), offset);
+    fs_api->BufferedSeek(f, stat_exists, static_cast<SeekMode>(whence), offset);
     return 0;
   }
   return real_api->fseeko(stream, offset, whence);
@@ -427,7 +438,7 @@ int WRP_CTE_DECL(fseeko64)(FILE *stream, off64_t offset, int whence) {
           whence);
     File f;
     f.hermes_fh_ = stream;
-    fs_api->Seek(f, stat_exists, static_cast<SeekMode>(whence), offset);
+    fs_api->BufferedSeek(f, stat_exists, static_cast<SeekMode>(whence), offset);
     return 0;
   }
   return real_api->fseeko64(stream, offset, whence);
@@ -442,7 +453,7 @@ int WRP_CTE_DECL(fsetpos)(FILE *stream, const fpos_t *pos) {
     HLOG(kDebug, "Intercepting fsetpos offset: {}", offset);
     File f;
     f.hermes_fh_ = stream;
-    fs_api->Seek(f, stat_exists, SeekMode::kSet, offset);
+    fs_api->BufferedSeek(f, stat_exists, SeekMode::kSet, offset);
     return 0;
   }
   return real_api->fsetpos(stream, pos);
@@ -457,7 +468,7 @@ int WRP_CTE_DECL(fsetpos64)(FILE *stream, const fpos64_t *pos) {
     HLOG(kDebug, "Intercepting fsetpos64 offset: {}", offset);
     File f;
     f.hermes_fh_ = stream;
-    fs_api->Seek(f, stat_exists, SeekMode::kSet, offset);
+    fs_api->BufferedSeek(f, stat_exists, SeekMode::kSet, offset);
     return 0;
   }
   return real_api->fsetpos64(stream, pos);
@@ -471,10 +482,44 @@ long int WRP_CTE_DECL(ftell)(FILE *fp) {
     HLOG(kDebug, "Intercepting ftell");
     File f;
     f.hermes_fh_ = fp;
-    off_t ret = fs_api->Tell(f, stat_exists);
+    off_t ret = fs_api->BufferedTell(f, stat_exists);
     return ret;
   }
   return real_api->ftell(fp);
 }
 
+int WRP_CTE_DECL(setvbuf)(FILE *stream, char *buf, int mode, size_t size) {
+  bool stat_exists;
+  auto real_api = WRP_CTE_STDIO_API;
+  auto fs_api = WRP_CTE_STDIO_FS;
+  if (fs_api->IsFpTracked(stream)) {
+    HLOG(kDebug, "Intercepting setvbuf mode: {} size: {}", mode, size);
+    if (mode != _IOFBF && mode != _IOLBF && mode != _IONBF) {
+      errno = EINVAL;
+      return -1;
+    }
+    // The adapter keeps its own storage; only the mode and size are used
+    (void)buf;
+    File f;
+    f.hermes_fh_ = stream;
+    return fs_api->SetBuffer(f, stat_exists, mode, size);
+  }
+  return real_api->setvbuf(stream, buf, mode, size);
+}
+
+void WRP_CTE_DECL(setbuf)(FILE *stream, char *buf) {
+  bool stat_exists;
+  auto real_api = WRP_CTE_STDIO_API;
+  auto fs_api = WRP_CTE_STDIO_FS;
+  if (fs_api->IsFpTracked(stream)) {
+    HLOG(kDebug, "Intercepting setbuf");
+    File f;
+    f.hermes_fh_ = stream;
+    fs_api->SetBuffer(f, stat_exists, buf ? _IOFBF : _IONBF,
+                      buf ? BUFSIZ : 0);
+    return;
+  }
+  real_api->setbuf(stream, buf);
+}
+
 } // extern C
@@ -70,6 +70,8 @@ typedef int (*fseeko64_t)(FILE* stream, off64_t offset, int whence);
 typedef int (*fsetpos_t)(FILE* stream, const fpos_t* pos);
 typedef int (*fsetpos64_t)(FILE* stream, const fpos64_t* pos);
 typedef long int (*ftell_t)(FILE* fp);
+typedef int (*setvbuf_t)(FILE* stream, char* buf, int mode, size_t size);
+typedef void (*setbuf_t)(FILE* stream, char* buf);
 }
 
 namespace wrp::cae {
@@ -131,6 +133,10 @@ class StdioApi : public RealApi {
   fsetpos64_t fsetpos64 = nullptr;
   /** ftell */
   ftell_t ftell = nullptr;
+  /** setvbuf */
+  setvbuf_t setvbuf = nullptr;
+  /** setbuf */
+  setbuf_t setbuf = nullptr;
 
   StdioApi() : RealApi("fopen", "stdio_intercepted") {
     fopen = (fopen_t)dlsym(real_lib_, "fopen");
@@ -185,6 +191,10 @@ class StdioApi : public RealApi {
     REQUIRE_API(fsetpos64)
     ftell = (ftell_t)dlsym(real_lib_, "ftell");
     REQUIRE_API(ftell)
+    setvbuf = (setvbuf_t)dlsym(real_lib_, "setvbuf");
+    REQUIRE_API(setvbuf)
+    setbuf = (setbuf_t)dlsym(real_lib_, "setbuf");
+    REQUIRE_API(setbuf)
   }
 };
 }  // namespace wrp::cae
@@ -34,7 +34,13 @@
 #ifndef WRP_CTE_ADAPTER_STDIO_NATIVE_H_
 #define WRP_CTE_ADAPTER_STDIO_NATIVE_H_
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "adapter/filesystem/filesystem.h"
 #include "adapter/filesystem/filesystem_mdm.h"
@@ -44,18 +50,100 @@
 
 namespace wrp::cae {
 
+/**
+ * User-space buffer of one intercepted FILE. The real FILE buffering is
+ * bypassed, so without this every fputc or small fwrite would become its own
+ * PutBlob. The buffer holds either dirty bytes waiting to be written or
+ * clean bytes read ahead, never both. Its windows end on adapter page
+ * boundaries, so flushes and refills move whole pages.
+ */
+class StdioBuffer {
+ public:
+  /**
+   * Create a fully buffered stream buffer
+   * @param page_size Adapter page size of the file, also the default size
+   */
+  explicit StdioBuffer(size_t page_size)
+      : mode_(_IOFBF), capacity_(page_size), page_size_(page_size) {
+    if (page_size_ == 0) {
+      page_size_ = 4096;
+      capacity_ = page_size_;
+    }
+  }
+
+  /**
+   * Change the buffering like setvbuf
+   * @param mode _IOFBF, _IOLBF or _IONBF
+   * @param size Buffer size in bytes; 0 keeps the current size
+   */
+  void SetMode(int mode, size_t size) {
+    mode_ = mode;
+    if (size > 0) {
+      capacity_ = size;
+      data_.clear();
+      data_.shrink_to_fit();
+    }
+  }
+
+  /** Whether writes and reads bypass the buffer */
+  bool IsUnbuffered() const { return mode_ == _IONBF; }
+
+  /** Whether a newline flushes the buffer */
+  bool IsLineBuffered() const { return mode_ == _IOLBF; }
+
+  /** Whether the buffer holds bytes not written to the file yet */
+  bool IsDirty() const { return dirty_ && len_ > 0; }
+
+  /** End offset at which a window starting at off_ is full */
+  size_t WindowEnd() const {
+    size_t end = off_ + capacity_;
+    size_t aligned = end - end % page_size_;
+    return aligned > off_ ? aligned : end;
+  }
+
+  /** Drop whatever the buffer holds */
+  void Reset() {
+    len_ = 0;
+    dirty_ = false;
+    append_ = false;
+  }
+
+  int mode_;                /**< _IOFBF, _IOLBF or _IONBF */
+  size_t capacity_;         /**< Size of a window */
+  size_t page_size_;        /**< Adapter page size windows align to */
+  std::vector<char> data_;  /**< Window storage, allocated on first use */
+  size_t off_ = 0;          /**< File offset of data_[0] */
+  size_t len_ = 0;          /**< Valid bytes in data_ */
+  bool dirty_ = false;      /**< data_ holds bytes to write */
+  bool append_ = false;     /**< Dirty bytes go to the end of the file */
+  std::mutex lock_;
+};
+
 /** A class to represent POSIX IO file system */
 class StdioFs : public wrp::cae::Filesystem {
 public:
   WRP_CTE_STDIO_API_T real_api_; /**< pointer to real APIs */
 
 public:
-  StdioFs() : Filesystem(AdapterType::kStdio) { real_api_ = WRP_CTE_STDIO_API; }
+  StdioFs() : Filesystem(AdapterType::kStdio) {
+    real_api_ = WRP_CTE_STDIO_API;
+    // exit() flushes real FILEs only; intercepted streams are flushed here
+    std::atexit(FlushAtExit);
+  }
 
   /** Close an existing stream and then open with new path */
   FILE *Reopen(const std::string &user_path, const char *mode,
                AdapterStat &stat) {
     auto real_api_ = WRP_CTE_STDIO_API;
+    File f;
+    f.hermes_fh_ = (FILE *)&stat;
+    if (!FlushBuffer(f, stat)) {
+      HLOG(kError, "Reopen: failed to write back the buffer of {}",
+           stat.path_);
+    }
+    if (stat.stdio_buf_) {
+      stat.stdio_buf_->Reset();
+    }
     FILE *ret;
     ret = real_api_->freopen(user_path.c_str(), mode, stat.fh_);
     if (!ret) {
@@ -73,6 +161,9 @@ public:
     auto mdm = WRP_CTE_FS_METADATA_MANAGER;
     stat->fh_ = real_api_->fdopen(stat->fd_, mode.c_str());
     stat->mode_str_ = mode;
+    if (!stat->stdio_buf_) {
+      stat->stdio_buf_ = std::make_shared<StdioBuffer>(stat->page_size_);
+    }
     File f;
     f.hermes_fh_ = (FILE *)stat.get();
     mdm->Create(f, stat);
@@ -128,6 +219,316 @@ public:
     return filename;
   }
 
+public:
+  /**
+   * Buffered I/O on intercepted streams. These stand in for the Filesystem
+   * calls of the same name without the prefix and keep stat.st_ptr_ at the
+   * logical stream position, which may be ahead of what reached the tag.
+   */
+
+  /**
+   * Write through the stream buffer, flushing each window as it fills
+   * @return Bytes accepted
+   */
+  size_t BufferedWrite(File &f, bool &stat_exists, const void *ptr,
+                       size_t total_size, IoStatus &io_status) {
+    auto mdm = WRP_CTE_FS_METADATA_MANAGER;
+    auto stat = mdm->Find(f);
+    if (!stat) {
+      stat_exists = false;
+      return 0;
+    }
+    stat_exists = true;
+    StdioBuffer *buf = stat->stdio_buf_.get();
+    if (!buf || buf->IsUnbuffered()) {
+      return Write(f, *stat, ptr, total_size, io_status, FsIoOptions());
+    }
+    std::lock_guard<std::mutex> guard(buf->lock_);
+    bool append = stat->st_ptr_ == std::numeric_limits<size_t>::max();
+    if (!buf->dirty_) {
+      buf->Reset();
+    } else if (buf->append_ != append ||
+               (!append && buf->off_ + buf->len_ != stat->st_ptr_)) {
+      // Not contiguous with the buffered bytes
+      if (!WriteBack(f, *stat, *buf)) {
+        io_status.success_ = false;
+        return 0;
+      }
+    }
+    const char *src = static_cast<const char *>(ptr);
+    size_t done = 0;
+    while (done < total_size) {
+      size_t left = total_size - done;
+      if (buf->len_ == 0) {
+        buf->off_ = append ? 0 : stat->st_ptr_;
+        buf->append_ = append;
+        if (left >= buf->capacity_) {
+          // Large writes skip the copy once the buffer is empty
+          IoStatus direct_status;
+          done += Write(f, *stat, src + done, left, direct_status,
+                        FsIoOptions());
+          if (!direct_status.success_) {
+            io_status.success_ = false;
+          }
+          break;
+        }
+      }
+      if (buf->data_.size() < buf->capacity_) {
+        buf->data_.resize(buf->capacity_);
+      }
+      size_t room = buf->WindowEnd() - (buf->off_ + buf->len_);
+      size_t n = std::min(room, left);
+      memcpy(buf->data_.data() + buf->len_, src + done, n);
+      buf->len_ += n;
+      buf->dirty_ = true;
+      done += n;
+      if (!append) {
+        stat->st_ptr_ += n;
+      }
+      if (buf->off_ + buf->len_ == buf->WindowEnd() &&
+          !WriteBack(f, *stat, *buf)) {
+        io_status.success_ = false;
+        break;
+      }
+    }
+    if (buf->IsLineBuffered() && buf->IsDirty() &&
+        memchr(src, '\n', total_size) != nullptr &&
+        !WriteBack(f, *stat, *buf)) {
+      io_status.success_ = false;
+    }
+    io_status.size_ = done;
+    return done;
+  }
+
+  /**
+   * Read through the stream buffer, refilling it a page-aligned window at
+   * a time and never past the end of the file
+   * @param stop_at_newline Stop after the first '\n' (fgets)
+   * @return Bytes read; 0 at the end of the file
+   */
+  size_t BufferedRead(File &f, bool &stat_exists, void *ptr,
+                      size_t total_size, IoStatus &io_status,
+                      bool stop_at_newline = false) {
+    auto mdm = WRP_CTE_FS_METADATA_MANAGER;
+    auto stat = mdm->Find(f);
+    if (!stat) {
+      stat_exists = false;
+      return 0;
+    }
+    stat_exists = true;
+    StdioBuffer *buf = stat->stdio_buf_.get();
+    bool append = stat->st_ptr_ == std::numeric_limits<size_t>::max();
+    if (!buf || (buf->IsUnbuffered() && !stop_at_newline) || append) {
+      if (buf) {
+        std::lock_guard<std::mutex> guard(buf->lock_);
+        if (!WriteBack(f, *stat, *buf)) {
+          io_status.success_ = false;
+          return 0;
+        }
+      }
+      return Read(f, *stat, ptr, total_size, io_status, FsIoOptions());
+    }
+    std::lock_guard<std::mutex> guard(buf->lock_);
+    if (buf->dirty_ && !WriteBack(f, *stat, *buf)) {
+      io_status.success_ = false;
+      return 0;
+    }
+    char *dst = static_cast<char *>(ptr);
+    size_t done = 0;
+    size_t file_size = std::numeric_limits<size_t>::max();
+    while (done < total_size) {
+      size_t cur = stat->st_ptr_;
+      if (buf->len_ > 0 && cur >= buf->off_ && cur < buf->off_ + buf->len_) {
+        size_t n = std::min(total_size - done, buf->off_ + buf->len_ - cur);
+        const char *src = buf->data_.data() + (cur - buf->off_);
+        if (stop_at_newline) {
+          const void *nl = memchr(src, '\n', n);
+          if (nl) {
+            n = static_cast<const char *>(nl) - src + 1;
+          }
+        }
+        memcpy(dst + done, src, n);
+        done += n;
+        stat->st_ptr_ += n;
+        if (stop_at_newline && dst[done - 1] == '\n') {
+          break;
+        }
+        continue;
+      }
+      size_t left = total_size - done;
+      if (left >= buf->capacity_ && !stop_at_newline) {
+        IoStatus direct_status;
+        done += Read(f, *stat, dst + done, left, direct_status,
+                     FsIoOptions());
+        if (!direct_status.success_) {
+          io_status.success_ = false;
+        }
+        break;
+      }
+      if (file_size == std::numeric_limits<size_t>::max()) {
+        file_size = GetSize(f, *stat);
+      }
+      if (cur >= file_size) {
+        break;
+      }
+      size_t start = cur - cur % buf->page_size_;
+      if (cur - start >= buf->capacity_) {
+        start = cur;
+      }
+      buf->off_ = start;
+      size_t want = std::min(buf->WindowEnd(), file_size) - start;
+      if (buf->data_.size() < buf->capacity_) {
+        buf->data_.resize(buf->capacity_);
+      }
+      IoStatus fill_status;
+      FsIoOptions opts;
+      opts.UnsetSeek();
+      buf->len_ = Read(f, *stat, buf->data_.data(), start, want, fill_status,
+                       opts);
+      buf->dirty_ = false;
+      if (buf->off_ + buf->len_ <= cur) {
+        buf->Reset();
+        io_status.success_ = fill_status.success_;
+        break;
+      }
+    }
+    io_status.size_ = done;
+    return done;
+  }
+
+  /**
+   * Write back the dirty bytes of the stream buffer
+   * @return false if the write-back failed
+   */
+  bool FlushBuffer(File &f, bool &stat_exists) {
+    auto mdm = WRP_CTE_FS_METADATA_MANAGER;
+    auto stat = mdm->Find(f);
+    if (!stat) {
+      stat_exists = false;
+      return false;
+    }
+    stat_exists = true;
+    return FlushBuffer(f, *stat);
+  }
+
+  /** Write back the dirty bytes of \a stat's stream buffer */
+  bool FlushBuffer(File &f, AdapterStat &stat) {
+    StdioBuffer *buf = stat.stdio_buf_.get();
+    if (!buf) {
+      return true;
+    }
+    std::lock_guard<std::mutex> guard(buf->lock_);
+    return WriteBack(f, stat, *buf);
+  }
+
+  /**
+   * Write back the buffer of every intercepted stream, as fflush(NULL) does
+   * @param sync Also flush each stream's real FILE
+   * @return false if any write-back failed
+   */
+  bool FlushAllBuffers(bool sync) {
+    auto *cte_manager = CTE_MANAGER;
+    if (cte_manager != nullptr && !cte_manager->IsInitialized()) {
+      return true;  // Nothing was intercepted
+    }
+    auto mdm = WRP_CTE_FS_METADATA_MANAGER;
+    std::vector<std::pair<File, std::shared_ptr<AdapterStat>>> files;
+    mdm->GetAll(files);
+    bool ok = true;
+    for (auto &[f, stat] : files) {
+      if (!stat->stdio_buf_) {
+        continue;  // Not a stream
+      }
+      ok &= FlushBuffer(f, *stat);
+      if (sync) {
+        ok &= Filesystem::Sync(f, *stat) == 0;
+      }
+    }
+    return ok;
+  }
+
+  /** Seek after writing back the buffer, as fseek does */
+  size_t BufferedSeek(File &f, bool &stat_exists, SeekMode whence,
+                      size_t offset) {
+    if (!FlushBuffer(f, stat_exists) && !stat_exists) {
+      return static_cast<size_t>(-1);
+    }
+    return Seek(f, stat_exists, whence, offset);
+  }
+
+  /**
+   * Logical stream position. Appended bytes have no offset until they are
+   * written, so those are written back first.
+   */
+  size_t BufferedTell(File &f, bool &stat_exists) {
+    auto mdm = WRP_CTE_FS_METADATA_MANAGER;
+    auto stat = mdm->Find(f);
+    if (stat && stat->stdio_buf_ &&
+        stat->st_ptr_ == std::numeric_limits<size_t>::max()) {
+      FlushBuffer(f, *stat);
+    }
+    return Tell(f, stat_exists);
+  }
+
+  /**
+   * Change the buffering of a stream like setvbuf
+   * @param mode _IOFBF, _IOLBF or _IONBF
+   * @param size Buffer size; 0 keeps the current size
+   * @return 0 on success, -1 if the buffer could not be written back
+   */
+  int SetBuffer(File &f, bool &stat_exists, int mode, size_t size) {
+    auto mdm = WRP_CTE_FS_METADATA_MANAGER;
+    auto stat = mdm->Find(f);
+    if (!stat) {
+      stat_exists = false;
+      return -1;
+    }
+    stat_exists = true;
+    if (!stat->stdio_buf_) {
+      stat->stdio_buf_ = std::make_shared<StdioBuffer>(stat->page_size_);
+    }
+    StdioBuffer &buf = *stat->stdio_buf_;
+    std::lock_guard<std::mutex> guard(buf.lock_);
+    if (!WriteBack(f, *stat, buf)) {
+      return -1;
+    }
+    buf.Reset();
+    buf.SetMode(mode, size);
+    return 0;
+  }
+
+private:
+  /** atexit hook: write back the streams the program left open */
+  static void FlushAtExit() {
+    auto *fs_api = hshm::Singleton<StdioFs>::GetInstance();
+    if (!fs_api->FlushAllBuffers(false)) {
+      HLOG(kError, "FlushAtExit: failed to write back an open stream");
+    }
+  }
+
+  /**
+   * Write the dirty bytes of \a buf to the file through the page path.
+   * Caller holds buf.lock_. Clean read-ahead bytes are kept.
+   */
+  bool WriteBack(File &f, AdapterStat &stat, StdioBuffer &buf) {
+    if (!buf.IsDirty()) {
+      buf.dirty_ = false;
+      return true;
+    }
+    IoStatus io_status;
+    FsIoOptions opts;
+    opts.UnsetSeek();
+    size_t wrote =
+        Write(f, stat, buf.data_.data(), buf.off_, buf.len_, io_status, opts);
+    bool ok = wrote == buf.len_ && io_status.success_;
+    if (!ok) {
+      HLOG(kError, "Failed to write back {} buffered bytes of {}", buf.len_,
+           stat.path_);
+    }
+    buf.Reset();
+    return ok;
+  }
+
 public:
   /** Allocate an fd for the file f */
   void RealOpen(File &f, AdapterStat &stat, const std::string &path) override {
@@ -174,6 +575,9 @@ public:
   void HermesOpen(File &f, const AdapterStat &stat,
                   FilesystemIoClientState &fs_mdm) override {
     f.hermes_fh_ = (FILE *)fs_mdm.stat_;
+    // Each stream gets its own buffer, one adapter page by default
+    auto *hermes_stat = reinterpret_cast<AdapterStat *>(fs_mdm.stat_);
+    hermes_stat->stdio_buf_ = std::make_shared<StdioBuffer>(stat.page_size_);
   }
 
   /** Synchronize \a file FILE f */
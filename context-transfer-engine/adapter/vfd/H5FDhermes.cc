@@ -56,7 +56,9 @@
 
 /* HDF5 header for dynamic plugin loading */
 #include "H5FDhermes.h" /* Hermes file driver     */
+#include "H5FDhermes_meta_cache.h"
 #include "H5PLextern.h"
+#include "adapter/cae_config.h"
 #include "adapter/posix/posix_fs_api.h"
 #include "wrp_cte/core/core_client.h"
 #include <hermes_shm/util/logging.h>
@@ -82,6 +84,7 @@ hid_t H5FDhermes_err_class_g = H5I_INVALID_HID;
 using wrp::cae::AdapterStat;
 using wrp::cae::File;
 using wrp::cae::IoStatus;
+using wrp::cae::VfdMetaCache;
 
 /* POSIX I/O mode used as the third parameter to open/_open
  * when creating a new file (O_CREAT is set). */
@@ -110,6 +113,7 @@ typedef struct H5FD_hermes_t {
   int fd;              /* the filesystem file descriptor        */
   char *filename_;     /* the name of the file */
   unsigned flags;      /* The flags passed from H5Fcreate/H5Fopen */
+  VfdMetaCache *meta_cache; /* cached metadata blocks, NULL if disabled */
 } H5FD_hermes_t;
 
 /* Driver-specific file access properties */
@@ -131,6 +135,8 @@ static herr_t H5FD__hermes_read(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id,
                                 haddr_t addr, size_t size, void *buf);
 static herr_t H5FD__hermes_write(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id,
                                  haddr_t addr, size_t size, const void *buf);
+static herr_t H5FD__hermes_flush(H5FD_t *_file, hid_t dxpl_id,
+                                 hbool_t closing);
 
 static const H5FD_class_t H5FD_hermes_g = {
     H5FD_CLASS_VERSION,   /* struct version       */
@@ -166,7 +172,7 @@ static const H5FD_class_t H5FD_hermes_g = {
     NULL,                 /* write_vector         */
     NULL,                 /* read_selection       */
     NULL,                 /* write_selection      */
-    NULL,                 /* flush                */
+    H5FD__hermes_flush,   /* flush                */
     NULL,                 /* truncate             */
     NULL,                 /* lock                 */
     NULL,                 /* unlock               */
@@ -175,6 +181,68 @@ static const H5FD_class_t H5FD_hermes_g = {
     H5FD_FLMAP_DICHOTOMY  /* fl_map               */
 };
 
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__hermes_is_metadata
+ *
+ * Purpose:     Whether an I/O of memory type TYPE is file metadata. Only
+ *              H5FD_MEM_DRAW is raw data; the superblock, B-trees, heaps
+ *              and object headers are all cached.
+ *
+ *-------------------------------------------------------------------------
+ */
+static bool H5FD__hermes_is_metadata(H5FD_mem_t type) {
+  return type != H5FD_MEM_DRAW;
+}
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__hermes_meta_cache_init
+ *
+ * Purpose:     Attach a metadata block cache to FILE, sized by the
+ *              vfd_meta_cache_size and vfd_meta_block_size CAE options.
+ *              Misses and write-backs go through the POSIX adapter.
+ *
+ *-------------------------------------------------------------------------
+ */
+static void H5FD__hermes_meta_cache_init(H5FD_hermes_t *file) {
+  auto *cae_config = WRP_CAE_CONF;
+  size_t capacity = 16 << 20;
+  size_t block_size = 64 << 10;
+  if (cae_config) {
+    capacity = cae_config->GetVfdMetaCacheSize();
+    block_size = cae_config->GetVfdMetaBlockSize();
+  }
+  if (capacity == 0) {
+    file->meta_cache = NULL;
+    return;
+  }
+  int fd = file->fd;
+  file->meta_cache = new VfdMetaCache(
+      capacity, block_size,
+      [fd](void *buf, size_t off, size_t size) -> size_t {
+        bool stat_exists;
+        auto fs_api = WRP_CTE_POSIX_FS;
+        File f;
+        f.hermes_fd_ = fd;
+        IoStatus io_status;
+        size_t count =
+            fs_api->Read(f, stat_exists, buf, off, size, io_status);
+        if (!stat_exists) {
+          return static_cast<size_t>(-1);
+        }
+        return count;
+      },
+      [fd](const void *buf, size_t off, size_t size) -> bool {
+        bool stat_exists;
+        auto fs_api = WRP_CTE_POSIX_FS;
+        File f;
+        f.hermes_fd_ = fd;
+        IoStatus io_status;
+        size_t count =
+            fs_api->Write(f, stat_exists, buf, off, size, io_status);
+        return stat_exists && count == size;
+      });
+}
+
 /*-------------------------------------------------------------------------
  * Function:    H5FD_hermes_init
  *
@@ -295,6 +363,7 @@ static H5FD_t *H5FD__hermes_open(const char *name, unsigned flags,
 
 #ifdef USE_HERMES
   file->eof = (haddr_t)fs_api->GetSize(f, stat_exists);
+  H5FD__hermes_meta_cache_init(file);
 #else
   file->eof = stdfs::file_size(name);
 #endif
@@ -317,6 +386,15 @@ static herr_t H5FD__hermes_close(H5FD_t *_file) {
   herr_t ret_value = SUCCEED; /* Return value */
   assert(file);
 #ifdef USE_HERMES
+  if (file->meta_cache) {
+    if (!file->meta_cache->Flush()) {
+      HLOG(kError, "Failed to write back the cached metadata of {}",
+           file->filename_ ? file->filename_ : "");
+      ret_value = FAIL;
+    }
+    delete file->meta_cache;
+    file->meta_cache = NULL;
+  }
   auto fs_api = WRP_CTE_POSIX_FS;
   File f;
   f.hermes_fd_ = file->fd;
@@ -377,7 +455,11 @@ static herr_t H5FD__hermes_query(const H5FD_t *_file,
   herr_t ret_value = SUCCEED;
 
   if (flags) {
-    *flags = 0;
+    /* Let the library allocate metadata and small raw data from separate
+     * aggregation blocks, so metadata lands in few cache blocks and raw
+     * data stays in long contiguous runs */
+    *flags = H5FD_FEAT_AGGREGATE_METADATA | H5FD_FEAT_ACCUMULATE_METADATA |
+             H5FD_FEAT_DATA_SIEVE | H5FD_FEAT_AGGREGATE_SMALLDATA;
   } /* end if */
 
   return ret_value;
@@ -470,17 +552,25 @@ static haddr_t H5FD__hermes_get_eof(const H5FD_t *_file, H5FD_mem_t type) {
 static herr_t H5FD__hermes_read(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id,
                                 haddr_t addr, size_t size, void *buf) {
   (void)dxpl_id;
-  (void)type;
   H5FD_hermes_t *file = (H5FD_hermes_t *)_file;
   herr_t ret_value = SUCCEED;
 
 #ifdef USE_HERMES
+  if (file->meta_cache && H5FD__hermes_is_metadata(type)) {
+    if (!file->meta_cache->Read(buf, addr, size)) {
+      return FAIL;
+    }
+    return ret_value;
+  }
   bool stat_exists;
   auto fs_api = WRP_CTE_POSIX_FS;
   File f;
   f.hermes_fd_ = file->fd;
   IoStatus io_status;
   size_t count = fs_api->Read(f, stat_exists, buf, addr, size, io_status);
+  if (file->meta_cache) {
+    file->meta_cache->OverlayRaw(buf, addr, size);
+  }
   HLOG(kDebug, "");
 #else
   size_t count = read(file->fd, (char *)buf + addr, size);
@@ -509,16 +599,27 @@ static herr_t H5FD__hermes_read(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id,
 static herr_t H5FD__hermes_write(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id,
                                  haddr_t addr, size_t size, const void *buf) {
   (void)dxpl_id;
-  (void)type;
   H5FD_hermes_t *file = (H5FD_hermes_t *)_file;
   herr_t ret_value = SUCCEED;
+  if (addr + size > file->eof) {
+    file->eof = addr + size;
+  }
 #ifdef USE_HERMES
+  if (file->meta_cache && H5FD__hermes_is_metadata(type)) {
+    if (!file->meta_cache->Write(buf, addr, size)) {
+      return FAIL;
+    }
+    return ret_value;
+  }
   bool stat_exists;
   auto fs_api = WRP_CTE_POSIX_FS;
   File f;
   f.hermes_fd_ = file->fd;
   IoStatus io_status;
   size_t count = fs_api->Write(f, stat_exists, buf, addr, size, io_status);
+  if (file->meta_cache) {
+    file->meta_cache->PatchRaw(buf, addr, size);
+  }
   HLOG(kDebug, "");
 #else
   size_t count = write(file->fd, (char *)buf + addr, size);
@@ -529,6 +630,28 @@ static herr_t H5FD__hermes_write(H5FD_t *_file, H5FD_mem_t type, hid_t dxpl_id,
   return ret_value;
 } /* end H5FD__hermes_write() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__hermes_flush
+ *
+ * Purpose:     Writes the metadata held in the client-side cache to Hermes.
+ *              Adjacent dirty blocks are aggregated into one write each.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t H5FD__hermes_flush(H5FD_t *_file, hid_t dxpl_id,
+                                 hbool_t closing) {
+  (void)dxpl_id;
+  (void)closing;
+  H5FD_hermes_t *file = (H5FD_hermes_t *)_file;
+  herr_t ret_value = SUCCEED;
+  if (file->meta_cache && !file->meta_cache->Flush()) {
+    ret_value = FAIL;
+  }
+  return ret_value;
+} /* end H5FD__hermes_flush() */
+
 /*
  * Stub routines for dynamic plugin loading
  */
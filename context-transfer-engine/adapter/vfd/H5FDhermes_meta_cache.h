@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * Purpose: Client-side metadata block cache of the Hermes VFD.
+ */
+#ifndef H5FDhermes_meta_cache_H
+#define H5FDhermes_meta_cache_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <vector>
+
+namespace wrp::cae {
+
+/**
+ * Cache of the HDF5 metadata (superblock, object headers, B-tree nodes,
+ * heaps) of one open file. HDF5 issues these as many small reads and
+ * writes; the cache keeps them in aligned blocks so that reads are served
+ * locally after the first miss, and writes are held until Flush(), which
+ * writes each run of adjacent dirty blocks with a single call. Raw data
+ * never enters the cache, but raw writes patch blocks already cached so
+ * the two views stay coherent.
+ */
+class VfdMetaCache {
+ public:
+  /** Read \a size bytes at \a off; returns the bytes read, short at EOF */
+  typedef std::function<size_t(void *buf, size_t off, size_t size)> ReadFn;
+  /** Write \a size bytes at \a off; returns false on failure */
+  typedef std::function<bool(const void *buf, size_t off, size_t size)>
+      WriteFn;
+
+  /**
+   * Create a cache
+   * @param capacity Bytes of blocks kept before clean blocks are evicted;
+   *        0 disables the cache
+   * @param block_size Size and alignment of a cached block
+   * @param read Backend read of the file
+   * @param write Backend write of the file
+   */
+  VfdMetaCache(size_t capacity, size_t block_size, ReadFn read, WriteFn write)
+      : capacity_(capacity),
+        block_size_(block_size ? block_size : 4096),
+        read_(std::move(read)),
+        write_(std::move(write)) {}
+
+  /** Whether metadata goes through the cache */
+  bool IsEnabled() const { return capacity_ > 0; }
+
+  /** Number of cached blocks */
+  size_t NumBlocks() const { return blocks_.size(); }
+
+  /**
+   * Read metadata, loading the blocks it touches on a miss
+   * @return false if a block could not be loaded
+   */
+  bool Read(void *buf, size_t addr, size_t size) {
+    char *dst = static_cast<char *>(buf);
+    while (size > 0) {
+      size_t idx = addr / block_size_;
+      size_t boff = addr % block_size_;
+      size_t n = std::min(size, block_size_ - boff);
+      Block *blk = Load(idx, false);
+      if (!blk) {
+        return false;
+      }
+      memcpy(dst, blk->data_.data() + boff, n);
+      dst += n;
+      addr += n;
+      size -= n;
+    }
+    return Shrink();
+  }
+
+  /**
+   * Write metadata into the cache; it reaches the file at Flush()
+   * @return false if a partially written block could not be loaded
+   */
+  bool Write(const void *buf, size_t addr, size_t size) {
+    const char *src = static_cast<const char *>(buf);
+    while (size > 0) {
+      size_t idx = addr / block_size_;
+      size_t boff = addr % block_size_;
+      size_t n = std::min(size, block_size_ - boff);
+      Block *blk = Load(idx, n == block_size_);
+      if (!blk) {
+        return false;
+      }
+      memcpy(blk->data_.data() + boff, src, n);
+      if (blk->dirty_lo_ >= blk->dirty_hi_) {
+        blk->dirty_lo_ = boff;
+        blk->dirty_hi_ = boff + n;
+      } else {
+        blk->dirty_lo_ = std::min(blk->dirty_lo_, boff);
+        blk->dirty_hi_ = std::max(blk->dirty_hi_, boff + n);
+      }
+      src += n;
+      addr += n;
+      size -= n;
+    }
+    return Shrink();
+  }
+
+  /**
+   * Copy cached bytes not yet flushed over a raw read of the same range
+   */
+  void OverlayRaw(void *buf, size_t addr, size_t size) {
+    ForEachCached(addr, size, [&](Block &blk, size_t boff, size_t n,
+                                  size_t buf_off) {
+      size_t lo = std::max(boff, blk.dirty_lo_);
+      size_t hi = std::min(boff + n, blk.dirty_hi_);
+      if (lo < hi) {
+        memcpy(static_cast<char *>(buf) + buf_off + (lo - boff),
+               blk.data_.data() + lo, hi - lo);
+      }
+    });
+  }
+
+  /**
+   * Apply a raw write to the blocks it overlaps. The write itself goes to
+   * the file directly.
+   */
+  void PatchRaw(const void *buf, size_t addr, size_t size) {
+    ForEachCached(addr, size, [&](Block &blk, size_t boff, size_t n,
+                                  size_t buf_off) {
+      memcpy(blk.data_.data() + boff,
+             static_cast<const char *>(buf) + buf_off, n);
+    });
+  }
+
+  /**
+   * Write every dirty block, merging adjacent dirty blocks into one write
+   * @return false if any write failed; failed blocks stay dirty
+   */
+  bool Flush() {
+    bool ok = true;
+    std::vector<char> run;
+    auto it = blocks_.begin();
+    while (it != blocks_.end()) {
+      if (!it->second.IsDirty()) {
+        ++it;
+        continue;
+      }
+      // Extend the run while each block is dirty to its end and the next
+      // one is dirty from its start
+      auto first = it;
+      auto last = it;
+      while (last->second.dirty_hi_ == block_size_) {
+        auto next = std::next(last);
+        if (next == blocks_.end() || next->first != last->first + 1 ||
+            !next->second.IsDirty() || next->second.dirty_lo_ != 0) {
+          break;
+        }
+        last = next;
+      }
+      size_t off = first->first * block_size_ + first->second.dirty_lo_;
+      bool written;
+      if (first == last) {
+        Block &blk = first->second;
+        written = write_(blk.data_.data() + blk.dirty_lo_, off,
+                         blk.dirty_hi_ - blk.dirty_lo_);
+      } else {
+        run.clear();
+        for (auto cur = first;; ++cur) {
+          Block &blk = cur->second;
+          run.insert(run.end(), blk.data_.begin() + blk.dirty_lo_,
+                     blk.data_.begin() + blk.dirty_hi_);
+          if (cur == last) {
+            break;
+          }
+        }
+        written = write_(run.data(), off, run.size());
+      }
+      it = std::next(last);
+      if (!written) {
+        ok = false;
+        continue;
+      }
+      for (auto cur = first; cur != it; ++cur) {
+        cur->second.dirty_lo_ = cur->second.dirty_hi_ = 0;
+      }
+    }
+    return ok;
+  }
+
+  /** Drop every cached block, dirty or not */
+  void Clear() { blocks_.clear(); }
+
+ private:
+  /** One aligned block of the file */
+  struct Block {
+    std::vector<char> data_;  /**< block_size_ bytes */
+    size_t dirty_lo_ = 0;     /**< Start of the unflushed range */
+    size_t dirty_hi_ = 0;     /**< End of the unflushed range */
+    uint64_t last_use_ = 0;   /**< Tick of the last access, for eviction */
+
+    bool IsDirty() const { return dirty_lo_ < dirty_hi_; }
+  };
+
+  /**
+   * Find block \a idx or read it from the file
+   * @param overwrite The caller replaces the whole block, so skip the read
+   */
+  Block *Load(size_t idx, bool overwrite) {
+    auto it = blocks_.find(idx);
+    if (it == blocks_.end()) {
+      Block blk;
+      blk.data_.resize(block_size_);
+      if (!overwrite) {
+        size_t got = read_(blk.data_.data(), idx * block_size_, block_size_);
+        if (got == static_cast<size_t>(-1)) {
+          return nullptr;
+        }
+        // Past the end of the file reads as zeros
+        std::fill(blk.data_.begin() + std::min(got, block_size_),
+                  blk.data_.end(), 0);
+      }
+      it = blocks_.emplace(idx, std::move(blk)).first;
+    }
+    it->second.last_use_ = ++tick_;
+    return &it->second;
+  }
+
+  /** Visit the cached parts of [addr, addr + size) */
+  template <typename FuncT>
+  void ForEachCached(size_t addr, size_t size, FuncT &&func) {
+    if (blocks_.empty() || size == 0) {
+      return;
+    }
+    size_t end = addr + size;
+    auto it = blocks_.lower_bound(addr / block_size_);
+    for (; it != blocks_.end() && it->first * block_size_ < end; ++it) {
+      size_t bstart = it->first * block_size_;
+      size_t lo = std::max(addr, bstart);
+      size_t hi = std::min(end, bstart + block_size_);
+      func(it->second, lo - bstart, hi - lo, lo - addr);
+    }
+  }
+
+  /**
+   * Evict least recently used blocks until the cache fits its capacity.
+   * Dirty victims are flushed first, all together.
+   */
+  bool Shrink() {
+    bool ok = true;
+    while (blocks_.size() * block_size_ > capacity_ && blocks_.size() > 1) {
+      auto victim = blocks_.begin();
+      for (auto it = blocks_.begin(); it != blocks_.end(); ++it) {
+        if (it->second.last_use_ < victim->second.last_use_) {
+          victim = it;
+        }
+      }
+      if (victim->second.IsDirty()) {
+        if (!Flush()) {
+          ok = false;
+          break;
+        }
+      }
+      blocks_.erase(victim);
+    }
+    return ok;
+  }
+
+  size_t capacity_;                 /**< Bytes of blocks to keep */
+  size_t block_size_;               /**< Size of each block */
+  ReadFn read_;                     /**< Backend read */
+  WriteFn write_;                   /**< Backend write */
+  std::map<size_t, Block> blocks_;  /**< Cached blocks by block index */
+  uint64_t tick_ = 0;               /**< Access counter */
+};
+
+}  // namespace wrp::cae
+
+#endif /* end H5FDhermes_meta_cache_H */
@@ -52,6 +52,8 @@ struct WorkloadConfig {
   IoPattern io_pattern = IoPattern::kSequential;
   bool validate = false;
   std::string routing = "local";  // "local" or "to_cpu"
+  std::string submit = "warp";    // "warp", "lane" or "batch" (see --submit)
+  bool graph = false;             // Replay CTE-mode steps from a CUDA graph
 
   // Storage targets (from --target flags)
   std::vector<TargetSpec> targets;
@@ -4,7 +4,9 @@
  * CTE mode: Combined kernel. Each warp owns a batch of nodes.
  *   Lane 0 calls AsyncGetBlob to load feature vectors for its batch.
  *   All 32 lanes gather and aggregate features (the science).
- *   No PutBlob (read-only workload).
+ *   No PutBlob by default (read-only workload). With --submit lane|batch
+ *   each node's output embedding is written back as blob "gnn_o<node>",
+ *   either one PutBlob per node or one warp-level PutBlobBatch per 32 nodes.
  *
  * BaM mode: Uses bam::ArrayDevice<float>::read() for feature access.
  *   Transparent page cache — no raw page_cache_acquire.
@@ -15,11 +17,13 @@
 #include <cstdint>
 #include <cmath>
 #include <wrp_cte/core/core_client.h>
+#include <wrp_cte/core/warp_batch.h>
 #include <chimaera/chimaera.h>
 #include <chimaera/singletons.h>
 #include <chimaera/gpu/work_orchestrator.h>
 #include <chimaera/ipc_manager.h>
 #include <hermes_shm/util/gpu_api.h>
+#include <hermes_shm/util/gpu_graph.h>
 
 #ifdef WRP_CORE_ENABLE_BAM
 #include <bam/array.cuh>
@@ -114,6 +118,9 @@ __global__ void gnn_gather_bam(bam::ArrayDevice<float> features,
  *   chunk_i = features for nodes [chunk_i_start, chunk_i_end)
  *
  * Each warp loads chunks that overlap [node_start, node_end).
+ *
+ * submit_mode selects the optional output write-back: 0 = none,
+ * 1 = lane 0 submits one PutBlob per node, 2 = one PutBlobBatch per 32 nodes.
  */
 __global__ void gnn_cte_kernel(
     chi::IpcManagerGpu gpu_info,
@@ -140,7 +147,9 @@ __global__ void gnn_cte_kernel(
     chi::u32 total_warps,
     chi::u32 emb_dim,
     int *d_load_done,                   // atomic counter for load barrier
-    int *d_done) {
+    int *d_done,
+    chi::u32 submit_mode,               // output write-back (see above)
+    unsigned long long *d_tasks) {      // queue tasks issued by write-back
   CHIMAERA_GPU_CLIENT_INIT(gpu_info, num_blocks);
 
   chi::u32 warp_id = chi::gpu::IpcManager::GetWarpId();
@@ -223,6 +232,51 @@ __global__ void gnn_cte_kernel(
       }
       __syncwarp();
     }
+
+    // === PHASE 3 (optional): write back output embeddings, one blob/node ===
+    if (!alloc_failed && submit_mode != 0) {
+      uint64_t node_bytes = (uint64_t)emb_dim * sizeof(float);
+      for (uint32_t base = my_node_start; base < my_node_end; base += 32) {
+        if (submit_mode == 2) {
+          uint32_t node_id = base + lane_id;
+          hipc::ShmPtr<> shm;
+          shm.alloc_id_.SetNull();
+          shm.off_.exchange(reinterpret_cast<size_t>(
+              d_output + (uint64_t)node_id * emb_dim));
+          wrp_cte::core::WarpPutBlobBatch(
+              cte_pool_id, chi::PoolQuery::Local(), tag_id, "gnn_o",
+              node_id < my_node_end, node_id, 0, node_bytes, shm);
+          if (lane_id == 0) atomicAdd_system(d_tasks, 1ULL);
+        } else if (chi::gpu::IpcManager::IsWarpScheduler()) {
+          uint32_t group_end = min(base + 32, my_node_end);
+          for (uint32_t node_id = base; node_id < group_end; node_id++) {
+            using StrT = hshm::priv::basic_string<char, CHI_PRIV_ALLOC_T>;
+            char name_buf[32];
+            int pos = 0;
+            const char *pfx = "gnn_o";
+            while (*pfx) name_buf[pos++] = *pfx++;
+            pos += StrT::NumberToStr(name_buf + pos, 32 - pos, node_id);
+            name_buf[pos] = '\0';
+
+            hipc::ShmPtr<> shm;
+            shm.alloc_id_.SetNull();
+            shm.off_.exchange(reinterpret_cast<size_t>(
+                d_output + (uint64_t)node_id * emb_dim));
+
+            auto put_task = CHI_IPC->NewTask<wrp_cte::core::PutBlobTask>(
+                chi::CreateTaskId(), cte_pool_id, chi::PoolQuery::Local(),
+                tag_id, name_buf, (chi::u64)0, node_bytes,
+                shm, -1.0f, wrp_cte::core::Context(), (chi::u32)0);
+            auto put_future = CHI_IPC->Send(put_task);
+            if (put_future.GetFutureShmPtr().IsNull()) break;
+            put_future.WaitGpu();
+            CHI_IPC->DelTask(put_task);
+            atomicAdd_system(d_tasks, 1ULL);
+          }
+        }
+        __syncwarp();
+      }
+    }
   }
 
   // Signal completion
@@ -406,6 +460,8 @@ int run_workload_gnn(const WorkloadConfig &cfg, const char *mode,
     gpu_info.backend = scratch_backend;
     int *d_done; cudaMallocHost(&d_done, sizeof(int)); *d_done = 0;
     int *d_load_done; cudaMallocHost(&d_load_done, sizeof(int)); *d_load_done = 0;
+    unsigned long long *d_tasks; cudaMallocHost(&d_tasks, sizeof(unsigned long long)); *d_tasks = 0;
+    chi::u32 submit_mode = cfg.submit == "batch" ? 2 : (cfg.submit == "lane" ? 1 : 0);
     if(scratch_backend.data_) cudaMemset(scratch_backend.data_,0,sizeof(hipc::PartitionedAllocator));
     if(heap_backend.data_) cudaMemset(heap_backend.data_,0,sizeof(hipc::PartitionedAllocator));
     cudaDeviceSynchronize();
@@ -457,24 +513,43 @@ int run_workload_gnn(const WorkloadConfig &cfg, const char *mode,
     if(heap_backend.data_) cudaMemset(heap_backend.data_,0,sizeof(hipc::PartitionedAllocator));
     cudaDeviceSynchronize();
 
-    // Run combined CTE kernel for each iteration
-    auto t0 = std::chrono::high_resolution_clock::now();
-    int iter;
-    for (iter = 0; iter < iters; iter++) {
-      *d_done = 0;
-      *d_load_done = 0;
-      if(scratch_backend.data_) cudaMemset(scratch_backend.data_,0,sizeof(hipc::PartitionedAllocator));
-      cudaDeviceSynchronize();
-
-      void *stream = hshm::GpuApi::CreateStream();
+    // One step's CTE kernel; replayed from a CUDA graph with --graph
+    auto launch_step = [&](void *s) {
       gnn_cte_kernel<<<cfg.client_blocks, cfg.client_threads, 0,
-                       static_cast<cudaStream_t>(stream)>>>(
+                       static_cast<cudaStream_t>(s)>>>(
           gpu_info, cfg.cte_pool_id, cfg.tag_id, cfg.client_blocks,
           array_ptr, data_alloc_id,
           d_adj, d_offsets, d_output,
           h_co, h_cs, h_cns, h_cne, num_chunks,
           h_wns, h_wne, h_wfc, h_wlc,
-          total_warps, emb_dim, d_load_done, d_done);
+          total_warps, emb_dim, d_load_done, d_done,
+          submit_mode, d_tasks);
+    };
+    hshm::GpuGraph step_graph;
+    void *graph_stream = cfg.graph ? hshm::GpuApi::CreateStream() : nullptr;
+
+    // Run combined CTE kernel for each iteration
+    auto t0 = std::chrono::high_resolution_clock::now();
+    int iter;
+    for (iter = 0; iter < iters; iter++) {
+      *d_done = 0;
+      *d_load_done = 0;
+      void *stream = graph_stream;
+      if (cfg.graph) {
+        // Capture the scratch reset + kernel once, then replay it
+        if (!step_graph.IsReady()) {
+          step_graph.BeginCapture(stream);
+          if(scratch_backend.data_) cudaMemsetAsync(scratch_backend.data_,0,sizeof(hipc::PartitionedAllocator),static_cast<cudaStream_t>(stream));
+          launch_step(stream);
+          step_graph.EndCapture(stream);
+        }
+        step_graph.Launch(stream);
+      } else {
+        if(scratch_backend.data_) cudaMemset(scratch_backend.data_,0,sizeof(hipc::PartitionedAllocator));
+        cudaDeviceSynchronize();
+        stream = hshm::GpuApi::CreateStream();
+        launch_step(stream);
+      }
 
       CHI_CPU_IPC->ResumeGpuOrchestrator();
       auto *orch = static_cast<chi::gpu::WorkOrchestrator*>(CHI_CPU_IPC->GetGpuIpcManager()->gpu_orchestrator_);
@@ -485,19 +560,24 @@ int run_workload_gnn(const WorkloadConfig &cfg, const char *mode,
         std::this_thread::sleep_for(std::chrono::microseconds(100));el+=100;}
       CHI_CPU_IPC->PauseGpuOrchestrator();
       hshm::GpuApi::Synchronize(stream);
-      hshm::GpuApi::DestroyStream(stream);
+      if (!cfg.graph) hshm::GpuApi::DestroyStream(stream);
 
       if(__atomic_load_n(d_done,__ATOMIC_ACQUIRE)<(int)total_warps){
         HLOG(kError,"GNN CTE iter {} timed out",iter); break;}
     }
+    if (graph_stream) hshm::GpuApi::DestroyStream(graph_stream);
     auto t1 = std::chrono::high_resolution_clock::now();
 
     result->elapsed_ms = std::chrono::duration<double,std::milli>(t1-t0).count();
     result->primary_metric = (double)adj_list.size()*iter/(result->elapsed_ms/1e3);
     result->metric_name = "edges/sec";
     result->bandwidth_gbps = (total_warp_io*(double)iter)/(1e9*(result->elapsed_ms/1e3));
+    if (submit_mode != 0) {
+      HIPRINT("  CTE submit={}: {} output blobs via {} queue tasks",
+              cfg.submit, (uint64_t)num_nodes * iter, *d_tasks);
+    }
 
-    cudaFreeHost(d_done); cudaFreeHost(d_load_done);
+    cudaFreeHost(d_done); cudaFreeHost(d_load_done); cudaFreeHost(d_tasks);
     cudaFreeHost(h_co); cudaFreeHost(h_cs); cudaFreeHost(h_cns); cudaFreeHost(h_cne);
     cudaFreeHost(h_wns); cudaFreeHost(h_wne); cudaFreeHost(h_wfc); cudaFreeHost(h_wlc);
   }
@@ -20,6 +20,7 @@
 #include <chimaera/gpu/work_orchestrator.h>
 #include <chimaera/ipc_manager.h>
 #include <hermes_shm/util/gpu_api.h>
+#include <hermes_shm/util/gpu_graph.h>
 
 #ifdef WRP_CORE_ENABLE_BAM
 #include <bam/array.cuh>
@@ -367,22 +368,40 @@ int run_workload_pagerank(const WorkloadConfig &cfg, const char *mode,
     if(heap_backend.data_) cudaMemset(heap_backend.data_,0,sizeof(hipc::PartitionedAllocator));
     cudaDeviceSynchronize();
 
-    // Run combined CTE kernel for each PR iteration
-    auto t0 = std::chrono::high_resolution_clock::now();
-    int iter;
-    for (iter = 0; iter < iters; iter++) {
-      *d_done = 0;
-      if(scratch_backend.data_) cudaMemset(scratch_backend.data_,0,sizeof(hipc::PartitionedAllocator));
-      cudaDeviceSynchronize();
-
-      void *stream = hshm::GpuApi::CreateStream();
+    // One step's CTE kernel; replayed from a CUDA graph with --graph
+    auto launch_step = [&](void *s) {
       pr_cte_kernel<<<cfg.client_blocks, cfg.client_threads, 0,
-                       static_cast<cudaStream_t>(stream)>>>(
+                       static_cast<cudaStream_t>(s)>>>(
           gpu_info, cfg.cte_pool_id, cfg.tag_id, cfg.client_blocks,
           array_ptr, data_alloc_id,
           d_off, d_vals, d_res,
           h_eo, h_eb, h_vs, h_ve,
           total_warps, alpha, d_done);
+    };
+    hshm::GpuGraph step_graph;
+    void *graph_stream = cfg.graph ? hshm::GpuApi::CreateStream() : nullptr;
+
+    // Run combined CTE kernel for each PR iteration
+    auto t0 = std::chrono::high_resolution_clock::now();
+    int iter;
+    for (iter = 0; iter < iters; iter++) {
+      *d_done = 0;
+      void *stream = graph_stream;
+      if (cfg.graph) {
+        // Capture the scratch reset + kernel once, then replay it
+        if (!step_graph.IsReady()) {
+          step_graph.BeginCapture(stream);
+          if(scratch_backend.data_) cudaMemsetAsync(scratch_backend.data_,0,sizeof(hipc::PartitionedAllocator),static_cast<cudaStream_t>(stream));
+          launch_step(stream);
+          step_graph.EndCapture(stream);
+        }
+        step_graph.Launch(stream);
+      } else {
+        if(scratch_backend.data_) cudaMemset(scratch_backend.data_,0,sizeof(hipc::PartitionedAllocator));
+        cudaDeviceSynchronize();
+        stream = hshm::GpuApi::CreateStream();
+        launch_step(stream);
+      }
 
       CHI_CPU_IPC->ResumeGpuOrchestrator();
       auto *orch = static_cast<chi::gpu::WorkOrchestrator*>(CHI_CPU_IPC->GetGpuIpcManager()->gpu_orchestrator_);
@@ -393,7 +412,7 @@ int run_workload_pagerank(const WorkloadConfig &cfg, const char *mode,
         std::this_thread::sleep_for(std::chrono::microseconds(100));el+=100;}
       CHI_CPU_IPC->PauseGpuOrchestrator();
       hshm::GpuApi::Synchronize(stream);
-      hshm::GpuApi::DestroyStream(stream);
+      if (!cfg.graph) hshm::GpuApi::DestroyStream(stream);
 
       if(__atomic_load_n(d_done,__ATOMIC_ACQUIRE)<(int)total_warps){
         HLOG(kError,"PR CTE iter {} timed out",iter); break;}
@@ -404,6 +423,7 @@ int run_workload_pagerank(const WorkloadConfig &cfg, const char *mode,
       cudaDeviceSynchronize();
       if (*d_active==0) { iter++; break; }
     }
+    if (graph_stream) hshm::GpuApi::DestroyStream(graph_stream);
     auto t1 = std::chrono::high_resolution_clock::now();
 
     result->elapsed_ms = std::chrono::duration<double,std::milli>(t1-t0).count();
@@ -6,6 +6,8 @@
  * operations on a fixed-size buffer per iteration.
  *
  * CTE mode: AsyncPutBlob + AsyncGetBlob round-trip per iteration
+ *   (--submit lane|batch: put-only, one blob per lane, submitted per lane
+ *   or as one warp-level PutBlobBatch)
  * BaM mode: warp_page_cache_acquire for write/read through HBM cache
  * Direct: memcpy to/from pinned DRAM
  * HBM: memcpy within device memory
@@ -13,6 +15,7 @@
 
 #include <cstdint>
 #include <wrp_cte/core/core_client.h>
+#include <wrp_cte/core/warp_batch.h>
 #include <chimaera/chimaera.h>
 #include <chimaera/singletons.h>
 #include <chimaera/gpu/work_orchestrator.h>
@@ -316,6 +319,8 @@ __global__ void synthetic_cte_kernel(
 
   char *my_write = write_base + warp_id * warp_bytes;
   char *my_read = read_base + warp_id * warp_bytes;
+  chi::gpu::GpuUserBuffer read_buf =
+      chi::gpu::IpcManager::RegisterUserBuffer(my_read, warp_bytes);
 
   uint64_t lcg_seed = warp_id + 1;  // LCG seed (non-zero)
   chi::PoolQuery pool_query = to_cpu ? chi::PoolQuery::ToLocalCpu() : chi::PoolQuery::Local();
@@ -362,18 +367,10 @@ __global__ void synthetic_cte_kernel(
     }
     __syncwarp();
 
-    // === I/O: GetBlob — retrieve data from CTE ===
-    if (chi::gpu::IpcManager::IsWarpScheduler() && !alloc_failed) {
-      hipc::ShmPtr<> shm;
-      shm.alloc_id_.SetNull();
-      shm.off_.exchange(reinterpret_cast<size_t>(my_read));
-
-      auto get_task = CHI_IPC->NewTask<wrp_cte::core::GetBlobTask>(
-          chi::CreateTaskId(), cte_pool_id, pool_query,
-          tag_id, name_buf, offset, warp_bytes,
-          (chi::u32)0, shm);
-      auto get_future = CHI_IPC->Send(get_task);
-      get_future.WaitGpu();
+    // === I/O: GetBlob — read straight into this warp's registered buffer ===
+    if (!alloc_failed) {
+      wrp_cte::core::WarpGetBlob(cte_pool_id, pool_query, tag_id, name_buf,
+                                 offset, warp_bytes, read_buf, 0);
     }
     __syncwarp();
 
@@ -399,6 +396,96 @@ __global__ void synthetic_cte_kernel(
   }
 }
 
+// ================================================================
+// CTE lane kernel: one blob per lane, per-lane vs. warp-batched submit
+//
+// Each lane owns a warp_bytes/32 slice stored as blob "syn_l<warp*32+lane>".
+//   batched=false: lane 0 submits one PutBlob per lane (32 queue tasks)
+//   batched=true:  WarpPutBlobBatch folds the 32 records into one task
+// ================================================================
+
+__global__ void synthetic_cte_lanes_kernel(
+    chi::IpcManagerGpu gpu_info,
+    chi::PoolId cte_pool_id,
+    wrp_cte::core::TagId tag_id,
+    chi::u32 num_blocks,
+    char *write_base,
+    uint64_t warp_bytes,
+    uint32_t total_warps,
+    uint32_t iterations,
+    bool to_cpu,
+    bool batched,
+    int *d_done,
+    int *d_errors,
+    unsigned long long *d_tasks) {
+
+  CHIMAERA_GPU_CLIENT_INIT(gpu_info, num_blocks);
+
+  chi::u32 warp_id = chi::gpu::IpcManager::GetWarpId();
+  chi::u32 lane_id = chi::gpu::IpcManager::GetLaneId();
+
+  if (warp_id >= total_warps) return;
+
+  uint64_t lane_bytes = warp_bytes / 32;
+  char *my_write = write_base + warp_id * warp_bytes + lane_id * lane_bytes;
+  chi::PoolQuery pool_query = to_cpu ? chi::PoolQuery::ToLocalCpu() : chi::PoolQuery::Local();
+  using StrT = hshm::priv::basic_string<char, CHI_PRIV_ALLOC_T>;
+
+  for (uint32_t iter = 0; iter < iterations; iter++) {
+    // Every lane fills its own slice
+    uint64_t pattern = (((uint64_t)warp_id << 32) | iter);
+    for (uint64_t i = 0; i + 8 <= lane_bytes; i += 8) {
+      *(uint64_t*)(my_write + i) = pattern;
+    }
+    __syncwarp();
+
+    if (batched) {
+      hipc::ShmPtr<> shm;
+      shm.alloc_id_.SetNull();
+      shm.off_.exchange(reinterpret_cast<size_t>(my_write));
+      wrp_cte::core::WarpBatchResult res = wrp_cte::core::WarpPutBlobBatch(
+          cte_pool_id, pool_query, tag_id, "syn_l", true,
+          (chi::u64)warp_id * 32 + lane_id, 0, lane_bytes, shm);
+      if (lane_id == 0) {
+        atomicAdd_system(d_tasks, 1ULL);
+        if (res.failed_) atomicAdd(d_errors, (int)res.failed_);
+      }
+    } else if (chi::gpu::IpcManager::IsWarpScheduler()) {
+      for (chi::u32 l = 0; l < 32; l++) {
+        char name_buf[32];
+        int pos = 0;
+        const char *pfx = "syn_l";
+        while (*pfx) name_buf[pos++] = *pfx++;
+        pos += StrT::NumberToStr(name_buf + pos, 32 - pos,
+                                 (chi::u64)warp_id * 32 + l);
+        name_buf[pos] = '\0';
+
+        hipc::ShmPtr<> shm;
+        shm.alloc_id_.SetNull();
+        shm.off_.exchange(reinterpret_cast<size_t>(
+            write_base + warp_id * warp_bytes + l * lane_bytes));
+
+        auto put_task = CHI_IPC->NewTask<wrp_cte::core::PutBlobTask>(
+            chi::CreateTaskId(), cte_pool_id, pool_query,
+            tag_id, name_buf, (chi::u64)0, lane_bytes,
+            shm, -1.0f, wrp_cte::core::Context(), (chi::u32)0);
+        auto put_future = CHI_IPC->Send(put_task);
+        put_future.WaitGpu();
+        if (put_task->return_code_.load() != 0) atomicAdd(d_errors, 1);
+        CHI_IPC->DelTask(put_task);
+        atomicAdd_system(d_tasks, 1ULL);
+      }
+    }
+    __syncwarp();
+  }
+
+  // Signal completion
+  if (chi::gpu::IpcManager::IsWarpScheduler()) {
+    atomicAdd_system(d_done, 1);
+    __threadfence_system();
+  }
+}
+
 // ================================================================
 // Alloc kernel (used by CTE mode)
 // ================================================================
@@ -448,7 +535,80 @@ int run_workload_synthetic(const WorkloadConfig &cfg, const char *mode,
   HIPRINT("  Synthetic I/O: {} warps, {} KB/warp, {} iterations",
           total_warps, warp_bytes / 1024, iters);
 
-  if (m == "cte") {
+  if (m == "cte" && cfg.submit != "warp") {
+    // ======== CTE: per-lane blobs, per-lane vs. warp-batched submit ========
+
+    bool batched = cfg.submit == "batch";
+    if (warp_bytes < 32 * 8) {
+      HLOG(kError, "synthetic --submit {} needs at least 256 B per warp",
+           cfg.submit);
+      return -1;
+    }
+
+    CHI_CPU_IPC->GetGpuIpcManager()->SetGpuOrchestratorBlocks(cfg.rt_blocks, cfg.rt_threads);
+    CteGpuContext ctx;
+    if (ctx.init(total_bytes, total_warps) != 0) {
+      HLOG(kError, "synthetic CTE init failed");
+      return -1;
+    }
+
+    int *d_errors;
+    cudaMallocHost(&d_errors, sizeof(int));
+    *d_errors = 0;
+    unsigned long long *d_tasks;
+    cudaMallocHost(&d_tasks, sizeof(unsigned long long));
+    *d_tasks = 0;
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    void *stream = hshm::GpuApi::CreateStream();
+    PrintKernelInfo("synthetic_cte_lanes_kernel",
+                    (const void *)synthetic_cte_lanes_kernel,
+                    cfg.client_blocks, cfg.client_threads);
+    synthetic_cte_lanes_kernel<<<cfg.client_blocks, cfg.client_threads, 0,
+                                 static_cast<cudaStream_t>(stream)>>>(
+        ctx.gpu_info, cfg.cte_pool_id, cfg.tag_id, cfg.client_blocks,
+        ctx.array_ptr.ptr_, warp_bytes, total_warps, iters,
+        cfg.routing == "to_cpu", batched, ctx.d_done, d_errors, d_tasks);
+
+    if (!ctx.resume_and_poll(cfg.timeout_sec)) {
+      HLOG(kError, "synthetic CTE timed out");
+      CHI_CPU_IPC->PauseGpuOrchestrator();
+      hshm::GpuApi::Synchronize(stream);
+      hshm::GpuApi::DestroyStream(stream);
+      cudaFreeHost(d_tasks);
+      cudaFreeHost(d_errors);
+      ctx.cleanup();
+      return -2;
+    }
+
+    CHI_CPU_IPC->PauseGpuOrchestrator();
+    hshm::GpuApi::Synchronize(stream);
+    hshm::GpuApi::DestroyStream(stream);
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    result->elapsed_ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+
+    if (*d_errors > 0) {
+      HLOG(kWarning, "synthetic CTE: {} lane puts failed", *d_errors);
+    }
+    HIPRINT("  CTE submit={}: {} queue tasks ({:.1f} per warp-iteration)",
+            cfg.submit, *d_tasks,
+            (double)*d_tasks / ((double)total_warps * iters));
+
+    // Metrics: one put per lane per iteration
+    result->bandwidth_gbps = (total_bytes * 1.0 * iters) /
+                             (result->elapsed_ms / 1e3) / 1e9;
+    result->primary_metric = (total_warps * 32.0 * iters * 1000.0) /
+                             result->elapsed_ms;
+    result->metric_name = "puts/sec";
+
+    cudaFreeHost(d_tasks);
+    cudaFreeHost(d_errors);
+    ctx.cleanup();
+  }
+
+  else if (m == "cte") {
     // ======== CTE: AsyncPutBlob + AsyncGetBlob per iteration ========
 
     CHI_CPU_IPC->GetGpuIpcManager()->SetGpuOrchestratorBlocks(cfg.rt_blocks, cfg.rt_threads);
@@ -41,15 +41,29 @@
  *   wrp_cte_bench <test_case> <num_threads> <depth> <io_size> <io_count>
  *
  * Parameters:
- *   test_case: Benchmark to conduct (Put, Get, PutGet)
- *   num_threads: Number of worker threads to spawn (e.g., 4)
- *   depth: Number of async requests to generate per thread
+ *   test_case: Benchmark to conduct (Put, Get, PutGet, Scale, OpenPut,
+ *              OpenGet)
+ *   num_threads: Number of worker threads to spawn (e.g., 4). For Scale,
+ *                the maximum thread count of the 1..N sweep
+ *   depth: Number of async requests to generate per thread. For
+ *          OpenPut/OpenGet, the cap on requests in flight per thread
  *   io_size: Size of I/O operations in bytes (supports k/K, m/M, g/G suffixes)
- *   io_count: Number of I/O operations to generate per thread
+ *   io_count: Number of I/O operations to generate per thread (per rate
+ *             step for OpenPut/OpenGet)
+ *
+ * OpenPut and OpenGet are open-loop: requests arrive at a target aggregate
+ * rate regardless of completions, and latency is measured from each
+ * request's intended send time, so time spent queued behind a slow request
+ * is counted (no coordinated omission). CTE_BENCH_RATES lists the rates to
+ * sweep in ops/s (e.g. "1000,5000,20000"); by default the rate doubles from
+ * 1000 ops/s until the achieved rate falls below 90% of the target.
+ * CTE_BENCH_ARRIVAL selects "poisson" (default) or "constant" arrivals.
  */
 
 #include <chimaera/chimaera.h>
+#include <chimaera/completion_queue.h>
 #include <wrp_cte/core/core_client.h>
+#include <hermes_shm/serialize/msgpack_wrapper.h>
 #include <hermes_shm/util/logging.h>
 
 #include <unistd.h>
@@ -62,6 +76,8 @@
 #include <iomanip>
 #include <iostream>
 #include <mutex>
+#include <random>
+#include <sstream>
 #include <string>
 #include <thread>
 #include <vector>
@@ -154,6 +170,92 @@ double CalcBandwidth(chi::u64 total_bytes, double microseconds) {
   return megabytes / seconds;
 }
 
+/**
+ * Print the client-side submit-to-Wait() histograms of every (pool, method)
+ * this process waited on. Requires runtime.task_latency.
+ */
+void PrintClientLatency() {
+  std::vector<chi::TaskLatencyEntry> entries;
+  chi::TaskLatencyStats::Client().Snapshot(entries);
+  HLOG(kInfo, "");
+  HLOG(kInfo, "=== Client Wait Latency (us) ===");
+  HLOG(kInfo, "pool | method | count | mean | p50 | p99 | p99.9 | max");
+  for (const auto &entry : entries) {
+    const chi::LatencyHistogram &hist =
+        entry.stages_[static_cast<chi::u32>(chi::TaskStage::kWait)];
+    if (!hist.Count()) continue;
+    HLOG(kInfo, "{} | {} | {} | {} | {} | {} | {} | {}",
+         entry.pool_id_.ToString(), entry.method_, hist.Count(),
+         hist.Mean() / 1000.0, hist.Percentile(0.50) / 1000.0,
+         hist.Percentile(0.99) / 1000.0, hist.Percentile(0.999) / 1000.0,
+         hist.Max() / 1000.0);
+  }
+  HLOG(kInfo, "===========================");
+}
+
+/**
+ * Query the runtime's task_latency monitor and print each stage's
+ * percentiles per (pool, method).
+ */
+void PrintRuntimeLatency() {
+  auto future =
+      CHI_ADMIN->AsyncMonitor(chi::PoolQuery::Local(), "task_latency");
+  future.Wait();
+  if (future->GetReturnCode() != 0) {
+    HLOG(kWarning, "Monitor(task_latency) failed with return code {}",
+         future->GetReturnCode());
+    return;
+  }
+  HLOG(kInfo, "");
+  HLOG(kInfo, "=== Runtime Task Latency (us) ===");
+  HLOG(kInfo, "pool | method | stage | count | mean | p50 | p99 | p99.9 | max");
+  for (const auto &[container_id, blob] : future->results_) {
+    if (blob.empty()) continue;
+    msgpack::object_handle oh = msgpack::unpack(blob.data(), blob.size());
+    const msgpack::object &obj = oh.get();
+    if (obj.type != msgpack::type::ARRAY) continue;
+    for (chi::u32 i = 0; i < obj.via.array.size; ++i) {
+      const msgpack::object &item = obj.via.array.ptr[i];
+      if (item.type != msgpack::type::MAP) continue;
+      std::string pool_id;
+      chi::u32 method = 0;
+      const msgpack::object *stages = nullptr;
+      for (chi::u32 j = 0; j < item.via.map.size; ++j) {
+        const auto &kv = item.via.map.ptr[j];
+        std::string key;
+        kv.key.convert(key);
+        if (key == "pool_id") kv.val.convert(pool_id);
+        else if (key == "method") kv.val.convert(method);
+        else if (key == "stages") stages = &kv.val;
+      }
+      if (!stages || stages->type != msgpack::type::MAP) continue;
+      for (chi::u32 j = 0; j < stages->via.map.size; ++j) {
+        const auto &stage_kv = stages->via.map.ptr[j];
+        std::string stage;
+        stage_kv.key.convert(stage);
+        if (stage_kv.val.type != msgpack::type::MAP) continue;
+        chi::u64 count = 0, p50 = 0, p99 = 0, p999 = 0, max = 0;
+        double mean = 0;
+        for (chi::u32 k = 0; k < stage_kv.val.via.map.size; ++k) {
+          const auto &kv = stage_kv.val.via.map.ptr[k];
+          std::string key;
+          kv.key.convert(key);
+          if (key == "count") kv.val.convert(count);
+          else if (key == "mean_ns") kv.val.convert(mean);
+          else if (key == "p50_ns") kv.val.convert(p50);
+          else if (key == "p99_ns") kv.val.convert(p99);
+          else if (key == "p999_ns") kv.val.convert(p999);
+          else if (key == "max_ns") kv.val.convert(max);
+        }
+        HLOG(kInfo, "{} | {} | {} | {} | {} | {} | {} | {} | {}", pool_id,
+             method, stage, count, mean / 1000.0, p50 / 1000.0, p99 / 1000.0,
+             p999 / 1000.0, max / 1000.0);
+      }
+    }
+  }
+  HLOG(kInfo, "===========================");
+}
+
 }  // namespace
 
 /**
@@ -184,9 +286,13 @@ class CTEBenchmark {
       RunGetBenchmark();
     } else if (test_case_ == "PutGet") {
       RunPutGetBenchmark();
+    } else if (test_case_ == "Scale") {
+      RunScaleBenchmark();
+    } else if (test_case_ == "OpenPut" || test_case_ == "OpenGet") {
+      RunOpenLoopBenchmark(test_case_ == "OpenGet");
     } else {
       HLOG(kError, "Unknown test case: {}", test_case_);
-      HLOG(kError, "Valid options: Put, Get, PutGet");
+      HLOG(kError, "Valid options: Put, Get, PutGet, Scale, OpenPut, OpenGet");
     }
   }
 
@@ -225,25 +331,23 @@ class CTEBenchmark {
 
     auto start_time = high_resolution_clock::now();
 
-    for (int i = 0; i < io_count_; i += depth_) {
-      if (error_flag.load(std::memory_order_relaxed)) {
-        break;
-      }
-
-      int batch_size = std::min(depth_, io_count_ - i);
-      std::vector<chi::Future<wrp_cte::core::PutBlobTask>> tasks;
-      tasks.reserve(batch_size);
-
-      for (int j = 0; j < batch_size; ++j) {
-        std::string blob_name = "blob_t" + std::to_string(thread_id) + "_" + std::to_string(i + j);
-        auto task = cte_client->AsyncPutBlob(tag_id, blob_name, 0, io_size_,
-                                             shm_ptr, 0.8f);
-        tasks.push_back(task);
-      }
-
-      for (auto &task : tasks) {
-        task.Wait();
+    // Keep depth_ puts in flight, refilling as soon as any one completes
+    using PutQueue = chi::CompletionQueue<wrp_cte::core::PutBlobTask>;
+    PutQueue queue;
+    std::vector<PutQueue::Completion> done;
+    int issued = 0;
+    while (issued < io_count_ && !error_flag.load(std::memory_order_relaxed)) {
+      while (issued < io_count_ && static_cast<int>(queue.Size()) < depth_) {
+        std::string blob_name = "blob_t" + std::to_string(thread_id) + "_" + std::to_string(issued);
+        queue.Push(cte_client->AsyncPutBlob(tag_id, blob_name, 0, io_size_,
+                                            shm_ptr, 0.8f));
+        ++issued;
       }
+      done.clear();
+      queue.WaitAny(done);
+    }
+    while (queue.WaitAny(done)) {
+      done.clear();
     }
 
     auto end_time = high_resolution_clock::now();
@@ -423,6 +527,309 @@ class CTEBenchmark {
     PrintResults("PutGet", thread_times);
   }
 
+  /**
+   * Worker thread for Scale benchmark: Put then Get every blob in a tag
+   * that no other thread touches, so only metadata contention remains.
+   * @param round Thread count of the current sweep step (keeps tags unique)
+   * @param thread_id Index of this thread within the step
+   * @param thread_times Output elapsed time per thread (us)
+   */
+  void ScaleWorkerThread(size_t round, size_t thread_id,
+                         std::vector<long long> &thread_times) {
+    auto *cte_client = WRP_CTE_CLIENT;
+
+    auto put_shm = CHI_IPC->AllocateBuffer(io_size_);
+    auto get_shm = CHI_IPC->AllocateBuffer(io_size_);
+    std::memset(put_shm.ptr_, thread_id & 0xFF, io_size_);
+    hipc::ShmPtr<> put_ptr = put_shm.shm_.template Cast<void>();
+    hipc::ShmPtr<> get_ptr = get_shm.shm_.template Cast<void>();
+
+    std::string tag_name = "scale_n" + node_id_ + "_r" +
+                           std::to_string(round) + "_t" +
+                           std::to_string(thread_id);
+    auto tag_task = cte_client->AsyncGetOrCreateTag(tag_name);
+    tag_task.Wait();
+    wrp_cte::core::TagId tag_id = tag_task->tag_id_;
+
+    auto start_time = high_resolution_clock::now();
+
+    for (int i = 0; i < io_count_; i += depth_) {
+      int batch_size = std::min(depth_, io_count_ - i);
+      std::vector<chi::Future<wrp_cte::core::PutBlobTask>> put_tasks;
+      put_tasks.reserve(batch_size);
+      for (int j = 0; j < batch_size; ++j) {
+        std::string blob_name = "blob_" + std::to_string(i + j);
+        put_tasks.push_back(cte_client->AsyncPutBlob(
+            tag_id, blob_name, 0, io_size_, put_ptr, 0.8f));
+      }
+      for (auto &task : put_tasks) {
+        task.Wait();
+      }
+
+      std::vector<chi::Future<wrp_cte::core::GetBlobTask>> get_tasks;
+      get_tasks.reserve(batch_size);
+      for (int j = 0; j < batch_size; ++j) {
+        std::string blob_name = "blob_" + std::to_string(i + j);
+        get_tasks.push_back(cte_client->AsyncGetBlob(
+            tag_id, blob_name, 0, io_size_, 0, get_ptr));
+      }
+      for (auto &task : get_tasks) {
+        task.Wait();
+      }
+    }
+
+    auto end_time = high_resolution_clock::now();
+    thread_times[thread_id] =
+        duration_cast<microseconds>(end_time - start_time).count();
+
+    CHI_IPC->FreeBuffer(put_shm);
+    CHI_IPC->FreeBuffer(get_shm);
+  }
+
+  /**
+   * Sweep thread counts 1, 2, 4, ... up to num_threads_ over disjoint tags
+   * and report aggregate metadata throughput and speedup over one thread.
+   */
+  void RunScaleBenchmark() {
+    std::vector<size_t> sweep;
+    for (size_t n = 1; n < num_threads_; n *= 2) {
+      sweep.push_back(n);
+    }
+    sweep.push_back(num_threads_);
+
+    double base_ops_per_sec = 0.0;
+    HLOG(kInfo, "");
+    HLOG(kInfo, "=== Scale Benchmark Results (disjoint tags) ===");
+    HLOG(kInfo, "threads | ops/s | speedup | max thread time (us)");
+    for (size_t nthreads : sweep) {
+      std::vector<std::thread> threads;
+      std::vector<long long> thread_times(nthreads);
+      for (size_t i = 0; i < nthreads; ++i) {
+        threads.emplace_back(&CTEBenchmark::ScaleWorkerThread, this, nthreads,
+                             i, std::ref(thread_times));
+      }
+      for (auto &thread : threads) {
+        thread.join();
+      }
+
+      long long max_time =
+          *std::max_element(thread_times.begin(), thread_times.end());
+      // Each iteration issues one PutBlob and one GetBlob
+      double total_ops = 2.0 * static_cast<double>(io_count_) * nthreads;
+      double ops_per_sec =
+          max_time > 0 ? total_ops / (max_time / 1000000.0) : 0.0;
+      if (nthreads == 1) {
+        base_ops_per_sec = ops_per_sec;
+      }
+      double speedup =
+          base_ops_per_sec > 0.0 ? ops_per_sec / base_ops_per_sec : 0.0;
+      HLOG(kInfo, "{} | {} | {}x | {}", nthreads, ops_per_sec, speedup,
+           max_time);
+    }
+    HLOG(kInfo, "===========================");
+  }
+
+  /** Result of one sender thread at one open-loop rate */
+  struct OpenLoopResult {
+    chi::LatencyHistogram hist_;
+    chi::u64 errors_ = 0;
+    chi::u64 last_done_ns_ = 0;  /**< Last completion, from thread start */
+  };
+
+  /**
+   * Open-loop sender: issue io_count_ requests at the intended arrival
+   * times of a per-thread rate, capping in-flight requests at depth_.
+   * Latency runs from the intended send time, not the actual one.
+   * @param get Issue GetBlob (blobs populated beforehand) instead of PutBlob
+   * @param thread_id Index of this thread
+   * @param rate_per_thread Target arrivals per second for this thread
+   * @param poisson Exponential inter-arrival gaps instead of constant ones
+   * @param step Rate step index (seeds the arrival process)
+   * @param result Output histogram and counters
+   */
+  void OpenLoopWorkerThread(bool get, size_t thread_id, double rate_per_thread,
+                            bool poisson, size_t step,
+                            OpenLoopResult &result) {
+    auto *cte_client = WRP_CTE_CLIENT;
+    auto shm = CHI_IPC->AllocateBuffer(io_size_);
+    std::memset(shm.ptr_, thread_id & 0xFF, io_size_);
+    hipc::ShmPtr<> ptr = shm.shm_.template Cast<void>();
+
+    std::string tag_name =
+        "open_n" + node_id_ + "_t" + std::to_string(thread_id);
+    auto tag_task = cte_client->AsyncGetOrCreateTag(tag_name);
+    tag_task.Wait();
+    wrp_cte::core::TagId tag_id = tag_task->tag_id_;
+
+    // Arrivals are scheduled from here, after setup
+    auto start = high_resolution_clock::now();
+    std::mt19937_64 rng(thread_id * 7919 + step + 1);
+    std::exponential_distribution<double> gap(rate_per_thread);
+    double mean_gap_ns = 1e9 / rate_per_thread;
+
+    // The tag of each completion is its intended send time (ns from start)
+    using PutQueue = chi::CompletionQueue<wrp_cte::core::PutBlobTask>;
+    using GetQueue = chi::CompletionQueue<wrp_cte::core::GetBlobTask>;
+    PutQueue put_queue;
+    GetQueue get_queue;
+    std::vector<PutQueue::Completion> put_done;
+    std::vector<GetQueue::Completion> get_done;
+    auto since_start = [start] {
+      return static_cast<chi::u64>(
+          duration_cast<nanoseconds>(high_resolution_clock::now() - start)
+              .count());
+    };
+    auto retire = [&](size_t max_count) {
+      size_t n = get ? get_queue.PollN(get_done, max_count)
+                     : put_queue.PollN(put_done, max_count);
+      if (n == 0) return;
+      chi::u64 now_ns = since_start();
+      result.last_done_ns_ = now_ns;
+      auto record = [&](chi::u64 intended_ns, chi::u32 rc) {
+        result.hist_.Record(now_ns > intended_ns ? now_ns - intended_ns : 0);
+        if (rc != 0) ++result.errors_;
+      };
+      for (auto &c : put_done) record(c.tag_, c.future_->GetReturnCode());
+      for (auto &c : get_done) record(c.tag_, c.future_->GetReturnCode());
+      put_done.clear();
+      get_done.clear();
+    };
+    auto in_flight = [&] { return get ? get_queue.Size() : put_queue.Size(); };
+
+    double intended_ns = 0;
+    for (int i = 0; i < io_count_; ++i) {
+      intended_ns += poisson ? gap(rng) * 1e9 : mean_gap_ns;
+      chi::u64 send_ns = static_cast<chi::u64>(intended_ns);
+      // Spin on completions until the send time; a late sender is still
+      // charged from send_ns
+      while (since_start() < send_ns) {
+        retire(in_flight());
+      }
+      while (static_cast<int>(in_flight()) >= depth_) {
+        retire(in_flight());
+      }
+      std::string blob_name =
+          "blob_t" + std::to_string(thread_id) + "_" + std::to_string(i);
+      if (get) {
+        get_queue.Push(cte_client->AsyncGetBlob(tag_id, blob_name, 0,
+                                                io_size_, 0, ptr),
+                       send_ns);
+      } else {
+        put_queue.Push(cte_client->AsyncPutBlob(tag_id, blob_name, 0,
+                                                io_size_, ptr, 0.8f),
+                       send_ns);
+      }
+    }
+    while (in_flight() > 0) {
+      retire(in_flight());
+    }
+
+    CHI_IPC->FreeBuffer(shm);
+  }
+
+  /**
+   * Write the blobs OpenGet reads, one tag per thread
+   * @param thread_id Index of this thread
+   */
+  void OpenLoopPopulateThread(size_t thread_id) {
+    auto *cte_client = WRP_CTE_CLIENT;
+    auto shm = CHI_IPC->AllocateBuffer(io_size_);
+    std::memset(shm.ptr_, thread_id & 0xFF, io_size_);
+    hipc::ShmPtr<> ptr = shm.shm_.template Cast<void>();
+    std::string tag_name =
+        "open_n" + node_id_ + "_t" + std::to_string(thread_id);
+    auto tag_task = cte_client->AsyncGetOrCreateTag(tag_name);
+    tag_task.Wait();
+    wrp_cte::core::TagId tag_id = tag_task->tag_id_;
+    for (int i = 0; i < io_count_; ++i) {
+      std::string blob_name =
+          "blob_t" + std::to_string(thread_id) + "_" + std::to_string(i);
+      auto task = cte_client->AsyncPutBlob(tag_id, blob_name, 0, io_size_,
+                                           ptr, 0.8f);
+      task.Wait();
+    }
+    CHI_IPC->FreeBuffer(shm);
+  }
+
+  /**
+   * Sweep target arrival rates open-loop and report the latency
+   * percentiles at each, showing where the latency curve bends.
+   * @param get Sweep GetBlob instead of PutBlob
+   */
+  void RunOpenLoopBenchmark(bool get) {
+    std::vector<double> rates;
+    const char *rates_env = std::getenv("CTE_BENCH_RATES");
+    if (rates_env && rates_env[0] != '\0') {
+      std::stringstream ss(rates_env);
+      std::string item;
+      while (std::getline(ss, item, ',')) {
+        double rate = std::atof(item.c_str());
+        if (rate > 0) rates.push_back(rate);
+      }
+    }
+    bool auto_sweep = rates.empty();
+    if (auto_sweep) {
+      for (double rate = 1000; rate <= 1024000; rate *= 2) {
+        rates.push_back(rate);
+      }
+    }
+    const char *arrival_env = std::getenv("CTE_BENCH_ARRIVAL");
+    bool poisson = !(arrival_env && std::string(arrival_env) == "constant");
+
+    if (get) {
+      HLOG(kInfo, "Populating data for OpenGet benchmark...");
+      std::vector<std::thread> threads;
+      for (size_t i = 0; i < num_threads_; ++i) {
+        threads.emplace_back(&CTEBenchmark::OpenLoopPopulateThread, this, i);
+      }
+      for (auto &thread : threads) {
+        thread.join();
+      }
+    }
+
+    HLOG(kInfo, "");
+    HLOG(kInfo, "=== {} Open-Loop Results ({} arrivals, latency in us) ===",
+         get ? "Get" : "Put", poisson ? "poisson" : "constant");
+    HLOG(kInfo,
+         "target ops/s | achieved ops/s | errors | p50 | p99 | p99.9 | "
+         "p99.99 | max");
+    for (size_t step = 0; step < rates.size(); ++step) {
+      double rate = rates[step];
+      std::vector<OpenLoopResult> results(num_threads_);
+      std::vector<std::thread> threads;
+      for (size_t i = 0; i < num_threads_; ++i) {
+        threads.emplace_back(&CTEBenchmark::OpenLoopWorkerThread, this, get,
+                             i, rate / num_threads_, poisson, step,
+                             std::ref(results[i]));
+      }
+      for (auto &thread : threads) {
+        thread.join();
+      }
+
+      chi::LatencyHistogram hist;
+      chi::u64 errors = 0;
+      chi::u64 last_done_ns = 0;
+      for (const auto &result : results) {
+        hist.Merge(result.hist_);
+        errors += result.errors_;
+        last_done_ns = std::max(last_done_ns, result.last_done_ns_);
+      }
+      double achieved =
+          last_done_ns > 0 ? hist.Count() / (last_done_ns / 1e9) : 0.0;
+      HLOG(kInfo, "{} | {} | {} | {} | {} | {} | {} | {}", rate, achieved,
+           errors, hist.Percentile(0.50) / 1000.0,
+           hist.Percentile(0.99) / 1000.0, hist.Percentile(0.999) / 1000.0,
+           hist.Percentile(0.9999) / 1000.0, hist.Max() / 1000.0);
+      // Past the knee: the system no longer keeps up with the offered load
+      if (auto_sweep && achieved < 0.9 * rate) {
+        HLOG(kInfo, "Saturated: achieved rate below 90% of {} ops/s", rate);
+        break;
+      }
+    }
+    HLOG(kInfo, "Percentiles are histogram bucket bounds (within 12.5%)");
+    HLOG(kInfo, "===========================");
+  }
+
   void PrintResults(const std::string &operation,
                     const std::vector<long long> &thread_times) {
     // Calculate statistics
@@ -492,7 +899,7 @@ int main(int argc, char **argv) {
   if (argc != 6) {
     HLOG(kError, "Usage: {} <test_case> <num_threads> <depth> <io_size> <io_count>",
          argv[0]);
-    HLOG(kError, "  test_case: Put, Get, or PutGet");
+    HLOG(kError, "  test_case: Put, Get, PutGet, Scale, OpenPut, or OpenGet");
     HLOG(kError, "  num_threads: Number of worker threads (e.g., 4)");
     HLOG(kError, "  depth: Number of async requests per thread (e.g., 4)");
     HLOG(kError, "  io_size: Size of I/O operations (e.g., 1m, 4k, 1g)");
@@ -572,5 +979,11 @@ int main(int argc, char **argv) {
   CTEBenchmark benchmark(num_threads, test_case, depth, io_size, io_count, node_id);
   benchmark.Run();
 
+  // Lifecycle histograms are only recorded with runtime.task_latency: true
+  if (chi::TaskLatencyStats::IsEnabled()) {
+    PrintClientLatency();
+    PrintRuntimeLatency();
+  }
+
   return 0;
 }
@@ -9,7 +9,7 @@
 #   ./wrp_cte_bench.sh <test_case> <num_procs> <depth> <io_size> <io_count>
 #
 # Parameters:
-#   test_case: Benchmark to conduct (Put, Get, PutGet)
+#   test_case: Benchmark to conduct (Put, Get, PutGet, Scale)
 #   num_procs: Number of MPI processes
 #   depth: Number of async requests to generate
 #   io_size: Size of I/O operations in bytes (supports k/K, m/M, g/G suffixes)
@@ -74,7 +74,7 @@ print_usage() {
     echo "Usage: $0 <test_case> <num_procs> <depth> <io_size> <io_count>"
     echo ""
     echo "Parameters:"
-    echo "  test_case: Benchmark to conduct (Put, Get, PutGet)"
+    echo "  test_case: Benchmark to conduct (Put, Get, PutGet, Scale)"
     echo "  num_procs: Number of MPI processes (e.g., 1, 4, 8)"
     echo "  depth: Number of async requests to generate (e.g., 4)"
     echo "  io_size: Size of I/O operations (e.g., 1m, 4k, 1g)"
@@ -118,11 +118,11 @@ main() {
 
     # Validate test case
     case "${test_case,,}" in
-        put|get|putget)
+        put|get|putget|scale)
             ;;
         *)
             echo -e "${RED}Error: Unknown test case: $test_case${NC}" >&2
-            echo "Valid options: Put, Get, PutGet" >&2
+            echo "Valid options: Put, Get, PutGet, Scale" >&2
             exit 1
             ;;
     esac
@@ -93,6 +93,8 @@ struct BenchConfig {
   bool validate = false;
   std::string io_pattern = "sequential";  // "sequential" or "random"
   std::string routing = "local";          // "local" or "to_cpu"
+  std::string submit = "warp";            // "warp", "lane" or "batch"
+  bool graph = false;                     // Replay CTE steps as a CUDA graph
   // Workload mode: hbm, direct, cte, bam
   std::string workload_mode = "hbm";
   // CTE storage targets (populated via --target flags)
@@ -151,6 +153,12 @@ void PrintUsage(const char *prog) {
   HIPRINT("  --validate             Enable data validation after reads");
   HIPRINT("  --io-pattern <p>       I/O pattern: sequential or random (default: sequential)");
   HIPRINT("  --routing <r>          Task routing: local or to_cpu (default: local)");
+  HIPRINT("  --submit <s>           CTE put submission (synthetic, gnn): warp,");
+  HIPRINT("                         lane (one task per lane) or batch (one");
+  HIPRINT("                         PutBlobBatch per warp) (default: warp)");
+  HIPRINT("  --graph                Capture each CTE-mode step (gray_scott,");
+  HIPRINT("                         pagerank, gnn) once and replay it as a");
+  HIPRINT("                         CUDA graph");
   HIPRINT("  --target <type:size>   CTE storage target (repeatable). type: hbm, pinned, ram");
   HIPRINT("                         Example: --target hbm:256m --target pinned:256m");
   HIPRINT("                         If omitted, defaults to one target based on --hbm-cache");
@@ -219,6 +227,15 @@ bool ParseArgs(int argc, char **argv, BenchConfig &cfg) {
       cfg.io_pattern = argv[++i];
     } else if (arg == "--routing" && i + 1 < argc) {
       cfg.routing = argv[++i];
+    } else if (arg == "--submit" && i + 1 < argc) {
+      cfg.submit = argv[++i];
+      if (cfg.submit != "warp" && cfg.submit != "lane" &&
+          cfg.submit != "batch") {
+        HLOG(kError, "--submit must be warp, lane or batch");
+        return false;
+      }
+    } else if (arg == "--graph") {
+      cfg.graph = true;
     } else if (arg == "--vertices" && i + 1 < argc) {
       cfg.param_vertices = static_cast<chi::u32>(std::stoul(argv[++i]));
     } else if (arg == "--avg-degree" && i + 1 < argc) {
@@ -374,6 +391,8 @@ int main(int argc, char **argv) {
     wcfg.warp_bytes = cfg.warp_bytes;
     wcfg.validate = cfg.validate;
     wcfg.routing = cfg.routing;
+    wcfg.submit = cfg.submit;
+    wcfg.graph = cfg.graph;
     wcfg.io_pattern = (cfg.io_pattern == "random") ? IoPattern::kRandom
                                                     : IoPattern::kSequential;
 
@@ -0,0 +1,563 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * CTE Metadata Benchmark
+ *
+ * mdtest-style benchmark for CTE metadata operations: tag creation, small
+ * blob creation, stat, listing, regex queries, metadata flush, and deletes.
+ * Every phase reports its op rate and latency percentiles.
+ *
+ * Usage:
+ *   wrp_cte_mdbench <phase> <num_threads> <num_tags> <blobs_per_tag>
+ *                   [blob_size] [depth]
+ *
+ * Parameters:
+ *   phase: run (populate, measure and delete), populate (create tags and
+ *          blobs, then flush metadata and leave them in place), recover
+ *          (after a runtime restart: time RestartContainers and verify every
+ *          populated tag lists blobs_per_tag blobs), or clean (delete
+ *          populated tags)
+ *   num_threads: Number of client threads; each owns num_tags/num_threads
+ *                tags
+ *   num_tags: Number of tags
+ *   blobs_per_tag: Blobs created in each tag (num_tags * blobs_per_tag
+ *                  blobs in total)
+ *   blob_size: Bytes per blob (supports k/K, m/M suffixes; default 64)
+ *   depth: Async requests in flight per thread (default 32)
+ *
+ * Measuring restart and recovery:
+ *   wrp_cte_mdbench populate 8 1000 10000
+ *   (restart the runtime without composing)
+ *   wrp_cte_mdbench recover 8 1000 10000
+ */
+
+#include <chimaera/admin.h>
+#include <chimaera/chimaera.h>
+#include <chimaera/completion_queue.h>
+#include <wrp_cte/core/core_client.h>
+#include <hermes_shm/util/logging.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono;
+
+namespace {
+
+/** Parse a size with an optional k/K or m/M suffix */
+chi::u64 ParseSize(const std::string &size_str) {
+  char *end = nullptr;
+  double size = std::strtod(size_str.c_str(), &end);
+  chi::u64 multiplier = 1;
+  if (end && (*end == 'k' || *end == 'K')) {
+    multiplier = 1024;
+  } else if (end && (*end == 'm' || *end == 'M')) {
+    multiplier = 1024 * 1024;
+  }
+  return static_cast<chi::u64>(size * multiplier);
+}
+
+/** Nanoseconds since an arbitrary steady epoch */
+chi::u64 NowNs() {
+  return static_cast<chi::u64>(
+      duration_cast<nanoseconds>(steady_clock::now().time_since_epoch())
+          .count());
+}
+
+/** Latency and error counts of one thread in one phase */
+struct PhaseResult {
+  chi::LatencyHistogram hist_;
+  chi::u64 errors_ = 0;
+};
+
+/**
+ * Keep up to depth requests in flight until count have been issued, then
+ * drain. Each completion's latency is its submit-to-completion time.
+ * @param count Number of requests
+ * @param depth Maximum requests in flight
+ * @param issue Callable (size_t i) -> Future<TaskT> submitting request i
+ * @param result Receives latencies and errors
+ */
+template <typename TaskT, typename IssueFn>
+void RunAsync(size_t count, size_t depth, IssueFn issue,
+              PhaseResult &result) {
+  chi::CompletionQueue<TaskT> queue;
+  std::vector<typename chi::CompletionQueue<TaskT>::Completion> done;
+  auto retire = [&] {
+    chi::u64 now_ns = NowNs();
+    for (auto &completion : done) {
+      result.hist_.Record(now_ns - completion.tag_);
+      if (completion.future_->GetReturnCode() != 0) {
+        ++result.errors_;
+      }
+    }
+    done.clear();
+  };
+  for (size_t i = 0; i < count; ++i) {
+    while (queue.Size() >= depth) {
+      queue.WaitAny(done);
+      retire();
+    }
+    chi::u64 submit_ns = NowNs();
+    queue.Push(issue(i), submit_ns);
+  }
+  while (queue.WaitAny(done)) {
+    retire();
+  }
+}
+
+}  // namespace
+
+/**
+ * Metadata benchmark driver
+ */
+class MdBenchmark {
+ public:
+  MdBenchmark(size_t num_threads, size_t num_tags, size_t blobs_per_tag,
+              chi::u64 blob_size, size_t depth, const std::string &node_id)
+      : num_threads_(num_threads),
+        num_tags_(num_tags),
+        blobs_per_tag_(blobs_per_tag),
+        blob_size_(blob_size),
+        depth_(depth),
+        node_id_(node_id),
+        tag_ids_(num_tags) {}
+
+  /**
+   * Run one phase of the benchmark
+   * @param phase run, populate, recover or clean
+   * @return Process exit code
+   */
+  int Run(const std::string &phase) {
+    HLOG(kInfo, "=== CTE Metadata Benchmark ===");
+    HLOG(kInfo, "Phase: {}  threads: {}  tags: {}  blobs/tag: {}", phase,
+         num_threads_, num_tags_, blobs_per_tag_);
+    HLOG(kInfo, "Total blobs: {}  blob size: {} B  depth: {}",
+         num_tags_ * blobs_per_tag_, blob_size_, depth_);
+    HLOG(kInfo, "");
+    HLOG(kInfo,
+         "phase | ops | errors | seconds | ops/s | p50 us | p99 us | "
+         "p99.9 us | max us");
+    if (phase == "run") {
+      Populate();
+      StatAndList();
+      Query();
+      Flush();
+      Delete();
+    } else if (phase == "populate") {
+      Populate();
+      Flush();
+    } else if (phase == "recover") {
+      return Recover();
+    } else if (phase == "clean") {
+      Step("TagLookup", num_tags_, &MdBenchmark::TagCreateWorker);
+      Delete();
+    } else {
+      HLOG(kError, "Unknown phase: {} (run, populate, recover, clean)",
+           phase);
+      return 1;
+    }
+    HLOG(kInfo, "===========================");
+    return 0;
+  }
+
+ private:
+  using WorkerFn = void (MdBenchmark::*)(size_t, PhaseResult &);
+
+  /** Tag name of tag index i; unique per node */
+  std::string TagName(size_t i) const {
+    return "md_n" + node_id_ + "_" + std::to_string(i);
+  }
+
+  /** Blob name of blob index j within a tag */
+  static std::string BlobName(size_t j) { return "b" + std::to_string(j); }
+
+  /** Number of tags thread t owns (tags t, t + T, t + 2T, ...) */
+  size_t TagsOf(size_t t) const {
+    return t < num_tags_ ? (num_tags_ - t + num_threads_ - 1) / num_threads_
+                         : 0;
+  }
+
+  /** Tag index of the k-th tag thread t owns */
+  size_t TagAt(size_t t, size_t k) const { return t + k * num_threads_; }
+
+  /**
+   * Run a worker on every thread, then print the merged phase row
+   * @param name Phase label
+   * @param ops Total ops the phase issues (for the rate)
+   * @param worker Per-thread body
+   */
+  void Step(const char *name, size_t ops, WorkerFn worker) {
+    std::vector<PhaseResult> results(num_threads_);
+    std::vector<std::thread> threads;
+    auto start = steady_clock::now();
+    for (size_t t = 0; t < num_threads_; ++t) {
+      threads.emplace_back(worker, this, t, std::ref(results[t]));
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    double seconds =
+        duration_cast<microseconds>(steady_clock::now() - start).count() /
+        1e6;
+    chi::LatencyHistogram hist;
+    chi::u64 errors = 0;
+    for (const auto &result : results) {
+      hist.Merge(result.hist_);
+      errors += result.errors_;
+    }
+    PrintRow(name, ops, errors, seconds, hist);
+  }
+
+  /** Print one result row */
+  static void PrintRow(const char *name, size_t ops, chi::u64 errors,
+                       double seconds, const chi::LatencyHistogram &hist) {
+    HLOG(kInfo, "{} | {} | {} | {} | {} | {} | {} | {} | {}", name, ops,
+         errors, seconds, seconds > 0 ? ops / seconds : 0.0,
+         hist.Percentile(0.50) / 1000.0, hist.Percentile(0.99) / 1000.0,
+         hist.Percentile(0.999) / 1000.0, hist.Max() / 1000.0);
+  }
+
+  void TagCreateWorker(size_t t, PhaseResult &result) {
+    auto *cte_client = WRP_CTE_CLIENT;
+    size_t count = TagsOf(t);
+    std::vector<chi::Future<wrp_cte::core::GetOrCreateTagTask<
+        wrp_cte::core::CreateParams>>>
+        pending;
+    // Tag ids are needed by later phases, so keep futures in issue order
+    for (size_t k = 0; k < count; k += depth_) {
+      size_t batch = std::min(depth_, count - k);
+      chi::u64 submit_ns = NowNs();
+      for (size_t b = 0; b < batch; ++b) {
+        pending.push_back(
+            cte_client->AsyncGetOrCreateTag(TagName(TagAt(t, k + b))));
+      }
+      for (size_t b = 0; b < batch; ++b) {
+        pending[b].Wait();
+        result.hist_.Record(NowNs() - submit_ns);
+        if (pending[b]->GetReturnCode() != 0) {
+          ++result.errors_;
+        }
+        tag_ids_[TagAt(t, k + b)] = pending[b]->tag_id_;
+      }
+      pending.clear();
+    }
+  }
+
+  void BlobCreateWorker(size_t t, PhaseResult &result) {
+    auto *cte_client = WRP_CTE_CLIENT;
+    auto shm = CHI_IPC->AllocateBuffer(blob_size_);
+    std::memset(shm.ptr_, t & 0xFF, blob_size_);
+    hipc::ShmPtr<> ptr = shm.shm_.template Cast<void>();
+    RunAsync<wrp_cte::core::PutBlobTask>(
+        TagsOf(t) * blobs_per_tag_, depth_,
+        [&](size_t i) {
+          const wrp_cte::core::TagId &tag_id =
+              tag_ids_[TagAt(t, i / blobs_per_tag_)];
+          return cte_client->AsyncPutBlob(tag_id, BlobName(i % blobs_per_tag_),
+                                          0, blob_size_, ptr, 0.5f);
+        },
+        result);
+    CHI_IPC->FreeBuffer(shm);
+  }
+
+  void BlobStatWorker(size_t t, PhaseResult &result) {
+    auto *cte_client = WRP_CTE_CLIENT;
+    RunAsync<wrp_cte::core::GetBlobSizeTask>(
+        TagsOf(t) * blobs_per_tag_, depth_,
+        [&](size_t i) {
+          return cte_client->AsyncGetBlobSize(
+              tag_ids_[TagAt(t, i / blobs_per_tag_)],
+              BlobName(i % blobs_per_tag_));
+        },
+        result);
+  }
+
+  void TagListWorker(size_t t, PhaseResult &result) {
+    auto *cte_client = WRP_CTE_CLIENT;
+    RunAsync<wrp_cte::core::GetContainedBlobsTask>(
+        TagsOf(t), depth_,
+        [&](size_t k) {
+          return cte_client->AsyncGetContainedBlobs(tag_ids_[TagAt(t, k)]);
+        },
+        result);
+  }
+
+  void BlobDeleteWorker(size_t t, PhaseResult &result) {
+    auto *cte_client = WRP_CTE_CLIENT;
+    RunAsync<wrp_cte::core::DelBlobTask>(
+        TagsOf(t) * blobs_per_tag_, depth_,
+        [&](size_t i) {
+          return cte_client->AsyncDelBlob(
+              tag_ids_[TagAt(t, i / blobs_per_tag_)],
+              BlobName(i % blobs_per_tag_));
+        },
+        result);
+  }
+
+  void TagDeleteWorker(size_t t, PhaseResult &result) {
+    auto *cte_client = WRP_CTE_CLIENT;
+    RunAsync<wrp_cte::core::DelTagTask>(
+        TagsOf(t), depth_,
+        [&](size_t k) {
+          return cte_client->AsyncDelTag(tag_ids_[TagAt(t, k)]);
+        },
+        result);
+  }
+
+  /** Create every tag, then blobs_per_tag blobs in each */
+  void Populate() {
+    Step("TagCreate", num_tags_, &MdBenchmark::TagCreateWorker);
+    Step("BlobCreate", num_tags_ * blobs_per_tag_,
+         &MdBenchmark::BlobCreateWorker);
+  }
+
+  /** Stat every blob and list every tag */
+  void StatAndList() {
+    Step("BlobStat", num_tags_ * blobs_per_tag_,
+         &MdBenchmark::BlobStatWorker);
+    Step("TagList", num_tags_, &MdBenchmark::TagListWorker);
+  }
+
+  /**
+   * Broadcast queries from one thread: a TagQuery matching every tag, and
+   * a paged BlobQuery walking every blob
+   */
+  void Query() {
+    auto *cte_client = WRP_CTE_CLIENT;
+    std::string tag_regex = "md_n" + node_id_ + "_.*";
+
+    chi::LatencyHistogram tag_hist;
+    chi::u64 tag_errors = 0;
+    auto start = steady_clock::now();
+    constexpr int kTagQueries = 10;
+    for (int i = 0; i < kTagQueries; ++i) {
+      chi::u64 submit_ns = NowNs();
+      auto task = cte_client->AsyncTagQuery(tag_regex);
+      task.Wait();
+      tag_hist.Record(NowNs() - submit_ns);
+      if (task->GetReturnCode() != 0 ||
+          task->total_tags_matched_ != num_tags_) {
+        ++tag_errors;
+      }
+    }
+    PrintRow("TagQuery", kTagQueries, tag_errors, SecondsSince(start),
+             tag_hist);
+
+    // Page through all blobs; one op per page
+    constexpr chi::u32 kPageSize = 10000;
+    chi::LatencyHistogram blob_hist;
+    chi::u64 blob_errors = 0;
+    size_t pages = 0;
+    size_t blobs_seen = 0;
+    std::string cursor_tag;
+    std::string cursor_blob;
+    start = steady_clock::now();
+    while (true) {
+      chi::u64 submit_ns = NowNs();
+      auto task = cte_client->AsyncBlobQuery(
+          tag_regex, ".*", kPageSize, chi::PoolQuery::Broadcast(), cursor_tag,
+          cursor_blob);
+      task.Wait();
+      blob_hist.Record(NowNs() - submit_ns);
+      ++pages;
+      if (task->GetReturnCode() != 0) {
+        ++blob_errors;
+        break;
+      }
+      blobs_seen += task->blob_names_.size();
+      if (!task->has_more_ || task->blob_names_.empty()) {
+        break;
+      }
+      cursor_tag = task->tag_names_.back();
+      cursor_blob = task->blob_names_.back();
+    }
+    if (blobs_seen != num_tags_ * blobs_per_tag_) {
+      HLOG(kWarning, "BlobQuery walked {} of {} blobs", blobs_seen,
+           num_tags_ * blobs_per_tag_);
+      ++blob_errors;
+    }
+    PrintRow("BlobQueryPage", pages, blob_errors, SecondsSince(start),
+             blob_hist);
+  }
+
+  /** One-shot FlushMetadata on the local node */
+  void Flush() {
+    auto *cte_client = WRP_CTE_CLIENT;
+    chi::LatencyHistogram hist;
+    auto start = steady_clock::now();
+    chi::u64 submit_ns = NowNs();
+    auto task = cte_client->AsyncFlushMetadata(chi::PoolQuery::Local(), 0);
+    task.Wait();
+    hist.Record(NowNs() - submit_ns);
+    PrintRow("FlushMetadata", 1, task->GetReturnCode() != 0 ? 1 : 0,
+             SecondsSince(start), hist);
+  }
+
+  /** Delete every blob, then every tag */
+  void Delete() {
+    Step("BlobDelete", num_tags_ * blobs_per_tag_,
+         &MdBenchmark::BlobDeleteWorker);
+    Step("TagDelete", num_tags_, &MdBenchmark::TagDeleteWorker);
+  }
+
+  /**
+   * After a runtime restart: time RestartContainers, then time looking up
+   * and listing every populated tag and check its blob count
+   * @return 0 if every tag came back with blobs_per_tag blobs
+   */
+  int Recover() {
+    chi::LatencyHistogram hist;
+    auto start = steady_clock::now();
+    auto *admin_client = CHI_ADMIN;
+    auto restart_task =
+        admin_client->AsyncRestartContainers(chi::PoolQuery::Local());
+    restart_task.Wait();
+    double restart_s = SecondsSince(start);
+    hist.Record(static_cast<chi::u64>(restart_s * 1e9));
+    PrintRow("RestartContainers", 1, restart_task->GetReturnCode() != 0,
+             restart_s, hist);
+    HLOG(kInfo, "Containers restarted: {}",
+         restart_task->containers_restarted_);
+    if (!wrp_cte::core::WRP_CTE_CLIENT_INIT()) {
+      HLOG(kError, "Failed to initialize CTE client after restart");
+      return 1;
+    }
+
+    Step("TagLookup", num_tags_, &MdBenchmark::TagCreateWorker);
+    std::atomic<size_t> short_tags{0};
+    std::vector<std::thread> threads;
+    start = steady_clock::now();
+    for (size_t t = 0; t < num_threads_; ++t) {
+      threads.emplace_back([this, t, &short_tags] {
+        auto *cte_client = WRP_CTE_CLIENT;
+        for (size_t k = 0; k < TagsOf(t); ++k) {
+          auto task =
+              cte_client->AsyncGetContainedBlobs(tag_ids_[TagAt(t, k)]);
+          task.Wait();
+          if (task->GetReturnCode() != 0 ||
+              task->blob_names_.size() != blobs_per_tag_) {
+            short_tags.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    HLOG(kInfo, "Verified {} tags in {} s; {} incomplete", num_tags_,
+         SecondsSince(start), short_tags.load());
+    HLOG(kInfo, "Time to full recovery: {} s",
+         SecondsSince(start) + restart_s);
+    HLOG(kInfo, "===========================");
+    return short_tags.load() == 0 ? 0 : 1;
+  }
+
+  static double SecondsSince(steady_clock::time_point start) {
+    return duration_cast<microseconds>(steady_clock::now() - start).count() /
+           1e6;
+  }
+
+  size_t num_threads_;
+  size_t num_tags_;
+  size_t blobs_per_tag_;
+  chi::u64 blob_size_;
+  size_t depth_;
+  std::string node_id_;
+  std::vector<wrp_cte::core::TagId> tag_ids_;
+};
+
+int main(int argc, char **argv) {
+  if (argc < 5 || argc > 7) {
+    HLOG(kError,
+         "Usage: {} <phase> <num_threads> <num_tags> <blobs_per_tag> "
+         "[blob_size] [depth]",
+         argv[0]);
+    HLOG(kError, "  phase: run, populate, recover, or clean");
+    HLOG(kError, "  blob_size: bytes per blob (default 64)");
+    HLOG(kError, "  depth: async requests in flight per thread (default 32)");
+    return 1;
+  }
+  std::string phase = argv[1];
+  size_t num_threads = std::strtoull(argv[2], nullptr, 10);
+  size_t num_tags = std::strtoull(argv[3], nullptr, 10);
+  size_t blobs_per_tag = std::strtoull(argv[4], nullptr, 10);
+  chi::u64 blob_size = argc > 5 ? ParseSize(argv[5]) : 64;
+  size_t depth = argc > 6 ? std::strtoull(argv[6], nullptr, 10) : 32;
+  if (num_threads == 0 || num_tags == 0 || blob_size == 0 || depth == 0) {
+    HLOG(kError, "num_threads, num_tags, blob_size and depth must be > 0");
+    return 1;
+  }
+
+  if (!chi::CHIMAERA_INIT(chi::ChimaeraMode::kClient, false)) {
+    HLOG(kError, "Failed to initialize Chimaera client");
+    return 1;
+  }
+  // Join the ZMQ receive thread before static destructors run
+  struct ClientFinalizeGuard {
+    ~ClientFinalizeGuard() {
+      auto *mgr = CHI_CHIMAERA_MANAGER;
+      if (mgr) {
+        mgr->ClientFinalize();
+      }
+    }
+  } finalize_guard;
+
+  std::string node_id;
+  const char *node_id_env = std::getenv("NODE_ID");
+  if (node_id_env && node_id_env[0] != '\0') {
+    node_id = node_id_env;
+  } else {
+    char hostname[256] = {};
+    gethostname(hostname, sizeof(hostname) - 1);
+    node_id = hostname;
+  }
+  MdBenchmark benchmark(num_threads, num_tags, blobs_per_tag, blob_size,
+                        depth, node_id);
+  // Recover restarts the pools before the CTE client attaches to them
+  if (phase != "recover" && !wrp_cte::core::WRP_CTE_CLIENT_INIT()) {
+    HLOG(kError, "Failed to initialize CTE client");
+    return 1;
+  }
+  return benchmark.Run(phase);
+}
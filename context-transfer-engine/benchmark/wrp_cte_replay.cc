@@ -0,0 +1,597 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * CTE Workload Replayer
+ *
+ * Replays workload traces captured with WRP_CTE_WORKLOAD_TRACE=<prefix>
+ * (see wrp_cte/core/workload_trace.h) against a running runtime. Replay is
+ * open-loop: every record is issued at its recorded time divided by the
+ * speed factor, whether or not earlier operations have completed, so the
+ * measured latency (completion minus scheduled issue time) includes any
+ * queueing the system under test causes. --depth caps the number of
+ * operations in flight; if the cap is hit, issues slip and the slip shows up
+ * in the latencies and the reported lag.
+ *
+ * Usage:
+ *   wrp_cte_replay [--speed X] [--depth N] [--max-ops N] [--dry-run]
+ *                  <trace.wlt>...
+ *
+ * Parameters:
+ *   --speed X: Time compression factor (2 = twice as fast, 0 = ignore
+ *              timestamps and issue as fast as --depth allows). Default 1
+ *   --depth N: Maximum operations in flight. Default 256
+ *   --max-ops N: Stop after N records (0 = all)
+ *   --dry-run: Summarize the traces without connecting to a runtime
+ *
+ * Several traces (e.g. one per client process) are merged by wall-clock
+ * time. Tags are recreated by name; records whose tag id has no recorded
+ * binding replay against a synthetic tag "wlt_<major>_<minor>". Put and get
+ * payloads come from one shared buffer, so data contents are not
+ * reproduced, only sizes, offsets and names.
+ */
+
+#include <chimaera/chimaera.h>
+#include <chimaera/completion_queue.h>
+#include <wrp_cte/core/core_client.h>
+#include <wrp_cte/core/workload_trace.h>
+#include <hermes_shm/util/logging.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using wrp_cte::core::TagId;
+using wrp_cte::core::WorkloadEvent;
+using wrp_cte::core::WorkloadOp;
+using wrp_cte::core::WorkloadOpName;
+using wrp_cte::core::WorkloadTraceReader;
+using Clock = std::chrono::steady_clock;
+
+/** A trace record placed on the merged replay timeline */
+struct ReplayEvent {
+  chi::u64 at_ns_;  /**< Offset from the start of the merged timeline */
+  WorkloadEvent event_;
+};
+
+/** Latency samples and counters for one op */
+struct OpStats {
+  chi::u64 count_ = 0;
+  chi::u64 errors_ = 0;
+  std::vector<chi::u64> lat_ns_;
+
+  /** Add one completed op */
+  void Add(chi::u64 lat_ns, bool ok) {
+    ++count_;
+    if (!ok) {
+      ++errors_;
+    }
+    lat_ns_.push_back(lat_ns);
+  }
+
+  /** Latency percentile in microseconds (sorts the samples) */
+  double PercentileUs(double pct) {
+    if (lat_ns_.empty()) {
+      return 0.0;
+    }
+    std::sort(lat_ns_.begin(), lat_ns_.end());
+    size_t idx = static_cast<size_t>(pct * (lat_ns_.size() - 1));
+    return lat_ns_[idx] / 1000.0;
+  }
+};
+
+using StatsTable =
+    std::array<OpStats, static_cast<size_t>(WorkloadOp::kCount)>;
+
+/** Nanoseconds elapsed since start */
+chi::u64 SinceNs(Clock::time_point start) {
+  return static_cast<chi::u64>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                           start)
+          .count());
+}
+
+/**
+ * In-flight operations of one task type. The completion tag carries the
+ * scheduled issue time so latency is measured open-loop.
+ */
+template <typename TaskT>
+class OpQueue {
+ public:
+  explicit OpQueue(WorkloadOp op) : op_(op) {}
+
+  /** Track a submitted future scheduled at sched_ns */
+  void Push(chi::Future<TaskT> &&future, chi::u64 sched_ns) {
+    queue_.Push(std::move(future), sched_ns);
+  }
+
+  /** Number of futures outstanding */
+  size_t Size() const { return queue_.Size(); }
+
+  /**
+   * Retire ready futures into the stats table
+   * @return Number retired
+   */
+  size_t Poll(Clock::time_point start, StatsTable &stats) {
+    done_.clear();
+    size_t n = queue_.PollN(done_, queue_.Size());
+    if (n == 0) {
+      return 0;
+    }
+    chi::u64 now_ns = SinceNs(start);
+    OpStats &op_stats = stats[static_cast<size_t>(op_)];
+    for (auto &completion : done_) {
+      chi::u64 lat = now_ns > completion.tag_ ? now_ns - completion.tag_ : 0;
+      op_stats.Add(lat, completion.future_->GetReturnCode() == 0);
+    }
+    return n;
+  }
+
+ private:
+  WorkloadOp op_;
+  chi::CompletionQueue<TaskT> queue_;
+  std::vector<typename chi::CompletionQueue<TaskT>::Completion> done_;
+};
+
+/** Replays a merged timeline against the CTE client */
+class Replayer {
+ public:
+  Replayer(double speed, size_t depth) : speed_(speed), depth_(depth) {}
+
+  /**
+   * Replay every event
+   * @param events Merged, time-ordered events
+   * @return true if the payload buffer could be allocated
+   */
+  bool Run(const std::vector<ReplayEvent> &events) {
+    chi::u64 max_size = 1;
+    for (const auto &ev : events) {
+      max_size = std::max<chi::u64>(max_size, ev.event_.rec_.size_);
+    }
+    auto *ipc_manager = CHI_IPC;
+    buffer_ = ipc_manager->AllocateBuffer(max_size);
+    if (buffer_.IsNull()) {
+      HLOG(kError, "Cannot allocate a {}-byte replay buffer", max_size);
+      return false;
+    }
+    std::memset(buffer_.ptr_, 0x5a, max_size);
+    data_ = buffer_.shm_.template Cast<void>();
+
+    start_ = Clock::now();
+    for (const auto &ev : events) {
+      chi::u64 sched_ns =
+          speed_ > 0 ? static_cast<chi::u64>(ev.at_ns_ / speed_) : 0;
+      WaitUntil(sched_ns);
+      while (InFlight() >= depth_) {
+        if (PollAll() == 0) {
+          HSHM_THREAD_MODEL->Yield();
+        }
+      }
+      chi::u64 issue_ns = SinceNs(start_);
+      if (speed_ > 0 && issue_ns > sched_ns) {
+        max_lag_ns_ = std::max(max_lag_ns_, issue_ns - sched_ns);
+      }
+      Issue(ev.event_, speed_ > 0 ? sched_ns : issue_ns);
+    }
+    while (InFlight() > 0) {
+      if (PollAll() == 0) {
+        HSHM_THREAD_MODEL->Yield();
+      }
+    }
+    elapsed_ns_ = SinceNs(start_);
+    ipc_manager->FreeBuffer(buffer_);
+    return true;
+  }
+
+  /** Per-op results */
+  StatsTable &GetStats() { return stats_; }
+
+  /** Wall time of the replay */
+  chi::u64 GetElapsedNs() const { return elapsed_ns_; }
+
+  /** Worst issue slip behind the schedule */
+  chi::u64 GetMaxLagNs() const { return max_lag_ns_; }
+
+ private:
+  /** Poll completions until the scheduled time, sleeping when far off */
+  void WaitUntil(chi::u64 sched_ns) {
+    while (true) {
+      PollAll();
+      chi::u64 now_ns = SinceNs(start_);
+      if (now_ns >= sched_ns) {
+        return;
+      }
+      chi::u64 ahead_ns = sched_ns - now_ns;
+      if (ahead_ns > 200000) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(
+            std::min<chi::u64>(ahead_ns - 100000, 1000000)));
+      } else {
+        HSHM_THREAD_MODEL->Yield();
+      }
+    }
+  }
+
+  /** Operations outstanding across all queues */
+  size_t InFlight() const {
+    return put_.Size() + append_.Size() + get_.Size() + reorg_.Size() +
+           del_blob_.Size() + del_tag_.Size() + tag_size_.Size() +
+           blob_score_.Size() + blob_size_.Size() + blob_info_.Size() +
+           contained_.Size();
+  }
+
+  /** Retire whatever has completed */
+  size_t PollAll() {
+    return put_.Poll(start_, stats_) + append_.Poll(start_, stats_) +
+           get_.Poll(start_, stats_) + reorg_.Poll(start_, stats_) +
+           del_blob_.Poll(start_, stats_) + del_tag_.Poll(start_, stats_) +
+           tag_size_.Poll(start_, stats_) + blob_score_.Poll(start_, stats_) +
+           blob_size_.Poll(start_, stats_) + blob_info_.Poll(start_, stats_) +
+           contained_.Poll(start_, stats_);
+  }
+
+  /**
+   * Create (or look up) a tag by name. Synchronous: later records depend
+   * on the id it returns.
+   */
+  TagId GetOrCreateTag(const std::string &name, chi::u64 sched_ns) {
+    auto it = tags_by_name_.find(name);
+    if (it != tags_by_name_.end()) {
+      return it->second;
+    }
+    auto *cte_client = WRP_CTE_CLIENT;
+    auto task = cte_client->AsyncGetOrCreateTag(name);
+    task.Wait();
+    chi::u64 now_ns = SinceNs(start_);
+    bool ok = task->GetReturnCode() == 0;
+    stats_[static_cast<size_t>(WorkloadOp::kGetOrCreateTag)].Add(
+        now_ns > sched_ns ? now_ns - sched_ns : 0, ok);
+    TagId tag_id = ok ? TagId(task->tag_id_) : TagId::GetNull();
+    tags_by_name_[name] = tag_id;
+    return tag_id;
+  }
+
+  /** Map a recorded tag id to the replay tag */
+  TagId ResolveTag(const TagId &recorded, chi::u64 sched_ns) {
+    auto it = tags_by_id_.find(Key(recorded));
+    if (it != tags_by_id_.end()) {
+      return it->second;
+    }
+    TagId tag_id = GetOrCreateTag("wlt_" + std::to_string(recorded.major_) +
+                                      "_" + std::to_string(recorded.minor_),
+                                  sched_ns);
+    tags_by_id_[Key(recorded)] = tag_id;
+    return tag_id;
+  }
+
+  static chi::u64 Key(const TagId &id) {
+    return (static_cast<chi::u64>(id.major_) << 32) | id.minor_;
+  }
+
+  /** Submit one record */
+  void Issue(const WorkloadEvent &ev, chi::u64 sched_ns) {
+    auto *cte_client = WRP_CTE_CLIENT;
+    const auto &rec = ev.rec_;
+    WorkloadOp op = ev.GetOp();
+    if (op == WorkloadOp::kGetOrCreateTag) {
+      GetOrCreateTag(ev.name_, sched_ns);
+      return;
+    }
+    if (op == WorkloadOp::kTagBind) {
+      tags_by_id_[Key(ev.GetTagId())] = GetOrCreateTag(ev.name_, sched_ns);
+      return;
+    }
+    if (op == WorkloadOp::kDelTag && ev.GetTagId().IsNull()) {
+      tags_by_name_.erase(ev.name_);
+      del_tag_.Push(cte_client->AsyncDelTag(ev.name_), sched_ns);
+      return;
+    }
+    TagId tag_id = ResolveTag(ev.GetTagId(), sched_ns);
+    switch (op) {
+      case WorkloadOp::kPutBlob:
+        put_.Push(cte_client->AsyncPutBlob(tag_id, ev.name_, rec.offset_,
+                                           rec.size_, data_, rec.score_,
+                                           wrp_cte::core::Context(),
+                                           rec.flags_),
+                  sched_ns);
+        break;
+      case WorkloadOp::kAppendBlob:
+        append_.Push(cte_client->AsyncAppendBlob(tag_id, rec.size_, rec.size_,
+                                                 data_, rec.score_),
+                     sched_ns);
+        break;
+      case WorkloadOp::kGetBlob:
+        get_.Push(cte_client->AsyncGetBlob(tag_id, ev.name_, rec.offset_,
+                                           rec.size_, rec.flags_, data_),
+                  sched_ns);
+        break;
+      case WorkloadOp::kReorganizeBlob:
+        reorg_.Push(
+            cte_client->AsyncReorganizeBlob(tag_id, ev.name_, rec.score_),
+            sched_ns);
+        break;
+      case WorkloadOp::kDelBlob:
+        del_blob_.Push(cte_client->AsyncDelBlob(tag_id, ev.name_), sched_ns);
+        break;
+      case WorkloadOp::kDelTag:
+        tags_by_id_.erase(Key(ev.GetTagId()));
+        del_tag_.Push(cte_client->AsyncDelTag(tag_id), sched_ns);
+        break;
+      case WorkloadOp::kGetTagSize:
+        tag_size_.Push(cte_client->AsyncGetTagSize(tag_id), sched_ns);
+        break;
+      case WorkloadOp::kGetBlobScore:
+        blob_score_.Push(cte_client->AsyncGetBlobScore(tag_id, ev.name_),
+                         sched_ns);
+        break;
+      case WorkloadOp::kGetBlobSize:
+        blob_size_.Push(cte_client->AsyncGetBlobSize(tag_id, ev.name_),
+                        sched_ns);
+        break;
+      case WorkloadOp::kGetBlobInfo:
+        blob_info_.Push(cte_client->AsyncGetBlobInfo(tag_id, ev.name_),
+                        sched_ns);
+        break;
+      case WorkloadOp::kGetContainedBlobs:
+        contained_.Push(cte_client->AsyncGetContainedBlobs(tag_id), sched_ns);
+        break;
+      default:
+        break;
+    }
+  }
+
+  double speed_;
+  size_t depth_;
+  Clock::time_point start_;
+  chi::u64 elapsed_ns_ = 0;
+  chi::u64 max_lag_ns_ = 0;
+  hipc::FullPtr<char> buffer_;
+  hipc::ShmPtr<> data_;
+  StatsTable stats_;
+  std::unordered_map<std::string, TagId> tags_by_name_;
+  std::unordered_map<chi::u64, TagId> tags_by_id_;
+
+  OpQueue<wrp_cte::core::PutBlobTask> put_{WorkloadOp::kPutBlob};
+  OpQueue<wrp_cte::core::AppendBlobTask> append_{WorkloadOp::kAppendBlob};
+  OpQueue<wrp_cte::core::GetBlobTask> get_{WorkloadOp::kGetBlob};
+  OpQueue<wrp_cte::core::ReorganizeBlobTask> reorg_{
+      WorkloadOp::kReorganizeBlob};
+  OpQueue<wrp_cte::core::DelBlobTask> del_blob_{WorkloadOp::kDelBlob};
+  OpQueue<wrp_cte::core::DelTagTask> del_tag_{WorkloadOp::kDelTag};
+  OpQueue<wrp_cte::core::GetTagSizeTask> tag_size_{WorkloadOp::kGetTagSize};
+  OpQueue<wrp_cte::core::GetBlobScoreTask> blob_score_{
+      WorkloadOp::kGetBlobScore};
+  OpQueue<wrp_cte::core::GetBlobSizeTask> blob_size_{
+      WorkloadOp::kGetBlobSize};
+  OpQueue<wrp_cte::core::GetBlobInfoTask> blob_info_{
+      WorkloadOp::kGetBlobInfo};
+  OpQueue<wrp_cte::core::GetContainedBlobsTask> contained_{
+      WorkloadOp::kGetContainedBlobs};
+};
+
+/**
+ * Load and merge traces onto one timeline
+ * @param paths Trace files
+ * @param events Receives the merged events
+ * @return false if a file could not be opened
+ */
+bool LoadTraces(const std::vector<std::string> &paths,
+                std::vector<ReplayEvent> &events) {
+  chi::u64 base_wall_ns = UINT64_MAX;
+  std::vector<std::pair<chi::u64, size_t>> file_starts;
+  for (const auto &path : paths) {
+    WorkloadTraceReader reader;
+    if (!reader.Open(path)) {
+      HLOG(kError, "Not a readable workload trace: {}", path);
+      return false;
+    }
+    chi::u64 start_wall_ns = reader.GetHeader().start_wall_ns_;
+    base_wall_ns = std::min(base_wall_ns, start_wall_ns);
+    file_starts.emplace_back(start_wall_ns, events.size());
+    WorkloadEvent ev;
+    size_t count = 0;
+    while (reader.Next(ev)) {
+      events.push_back(ReplayEvent{ev.rec_.ts_ns_, ev});
+      ++count;
+    }
+    HLOG(kInfo, "Loaded {} records from {} (host {}, pid {})", count, path,
+         reader.GetHeader().host_, reader.GetHeader().pid_);
+  }
+  // Shift every file onto the earliest start, then merge
+  for (size_t i = 0; i < file_starts.size(); ++i) {
+    size_t end = i + 1 < file_starts.size() ? file_starts[i + 1].second
+                                            : events.size();
+    chi::u64 shift = file_starts[i].first - base_wall_ns;
+    for (size_t j = file_starts[i].second; j < end; ++j) {
+      events[j].at_ns_ += shift;
+    }
+  }
+  std::stable_sort(events.begin(), events.end(),
+                   [](const ReplayEvent &a, const ReplayEvent &b) {
+                     return a.at_ns_ < b.at_ns_;
+                   });
+  return true;
+}
+
+/** printf-style formatting for aligned report rows */
+template <typename... Args>
+std::string Printf(const char *fmt, Args... args) {
+  char buf[256];
+  snprintf(buf, sizeof(buf), fmt, args...);
+  return buf;
+}
+
+/** Print what the traces contain */
+void PrintSummary(const std::vector<ReplayEvent> &events) {
+  std::array<chi::u64, static_cast<size_t>(WorkloadOp::kCount)> counts{};
+  std::array<chi::u64, static_cast<size_t>(WorkloadOp::kCount)> bytes{};
+  for (const auto &ev : events) {
+    size_t op = ev.event_.rec_.op_;
+    if (op < counts.size()) {
+      ++counts[op];
+      bytes[op] += ev.event_.rec_.size_;
+    }
+  }
+  double span_s = events.empty() ? 0.0 : events.back().at_ns_ / 1e9;
+  HLOG(kInfo, "=== Workload Trace ===");
+  HLOG(kInfo, "{}", Printf("Records: %zu  span: %.3f s", events.size(),
+                           span_s));
+  for (size_t op = 0; op < counts.size(); ++op) {
+    if (counts[op] == 0) {
+      continue;
+    }
+    HLOG(kInfo, "{}",
+         Printf("  %-18s %10llu ops %14llu bytes",
+                WorkloadOpName(static_cast<WorkloadOp>(op)),
+                static_cast<unsigned long long>(counts[op]),
+                static_cast<unsigned long long>(bytes[op])));
+  }
+}
+
+/** Print replay latencies */
+void PrintResults(Replayer &replayer, size_t num_events) {
+  double elapsed_s = replayer.GetElapsedNs() / 1e9;
+  HLOG(kInfo, "=== Replay Results ===");
+  HLOG(kInfo, "{}",
+       Printf("Records: %zu  wall: %.3f s  rate: %.1f ops/s", num_events,
+              elapsed_s, elapsed_s > 0 ? num_events / elapsed_s : 0.0));
+  HLOG(kInfo, "{}", Printf("Max issue lag behind schedule: %.1f us",
+                           replayer.GetMaxLagNs() / 1000.0));
+  HLOG(kInfo, "{}", Printf("  %-18s %10s %8s %12s %12s %12s", "op", "count",
+                           "errors", "p50 us", "p99 us", "max us"));
+  StatsTable &stats = replayer.GetStats();
+  for (size_t op = 0; op < stats.size(); ++op) {
+    OpStats &op_stats = stats[op];
+    if (op_stats.count_ == 0) {
+      continue;
+    }
+    HLOG(kInfo, "{}",
+         Printf("  %-18s %10llu %8llu %12.1f %12.1f %12.1f",
+                WorkloadOpName(static_cast<WorkloadOp>(op)),
+                static_cast<unsigned long long>(op_stats.count_),
+                static_cast<unsigned long long>(op_stats.errors_),
+                op_stats.PercentileUs(0.50), op_stats.PercentileUs(0.99),
+                op_stats.PercentileUs(1.0)));
+  }
+}
+
+void PrintUsage(const char *prog) {
+  HLOG(kError,
+       "Usage: {} [--speed X] [--depth N] [--max-ops N] [--dry-run] "
+       "<trace.wlt>...",
+       prog);
+  HLOG(kError, "  --speed X: time compression (0 = as fast as depth allows)");
+  HLOG(kError, "  --depth N: maximum operations in flight (default 256)");
+  HLOG(kError, "  --max-ops N: replay at most N records (default all)");
+  HLOG(kError, "  --dry-run: summarize the traces only");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  double speed = 1.0;
+  size_t depth = 256;
+  size_t max_ops = 0;
+  bool dry_run = false;
+  std::vector<std::string> paths;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--speed" && i + 1 < argc) {
+      speed = std::atof(argv[++i]);
+    } else if (arg == "--depth" && i + 1 < argc) {
+      depth = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--max-ops" && i + 1 < argc) {
+      max_ops = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--dry-run") {
+      dry_run = true;
+    } else if (!arg.empty() && arg[0] == '-') {
+      PrintUsage(argv[0]);
+      return 1;
+    } else {
+      paths.push_back(arg);
+    }
+  }
+  if (paths.empty() || depth == 0 || speed < 0) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  std::vector<ReplayEvent> events;
+  if (!LoadTraces(paths, events)) {
+    return 1;
+  }
+  if (max_ops > 0 && events.size() > max_ops) {
+    events.resize(max_ops);
+  }
+  PrintSummary(events);
+  if (dry_run) {
+    return 0;
+  }
+
+  if (!chi::CHIMAERA_INIT(chi::ChimaeraMode::kClient, false)) {
+    HLOG(kError, "Failed to initialize Chimaera client");
+    return 1;
+  }
+  // Join the ZMQ receive thread before static destructors run
+  struct ClientFinalizeGuard {
+    ~ClientFinalizeGuard() {
+      auto *mgr = CHI_CHIMAERA_MANAGER;
+      if (mgr) {
+        mgr->ClientFinalize();
+      }
+    }
+  } finalize_guard;
+
+  if (!wrp_cte::core::WRP_CTE_CLIENT_INIT()) {
+    HLOG(kError, "Failed to initialize CTE client");
+    return 1;
+  }
+  // Never record the replay itself
+  wrp_cte::core::WorkloadRecorder::Stop();
+
+  Replayer replayer(speed, depth);
+  if (!replayer.Run(events)) {
+    return 1;
+  }
+  PrintResults(replayer, events.size());
+  return 0;
+}
@@ -2,6 +2,7 @@
 #define WRP_CTE_COMPRESSOR_AUTOGEN_METHODS_H_
 
 #include <chimaera/chimaera.h>
+#include <chimaera/method_traits.h>
 #include <string>
 #include <vector>
 
@@ -21,8 +22,10 @@ GLOBAL_CROSS_CONST chi::u32 kMonitor = 9;
 GLOBAL_CROSS_CONST chi::u32 kDynamicSchedule = 10;
 GLOBAL_CROSS_CONST chi::u32 kCompress = 11;
 GLOBAL_CROSS_CONST chi::u32 kDecompress = 12;
+GLOBAL_CROSS_CONST chi::u32 kRefitModels = 13;
+GLOBAL_CROSS_CONST chi::u32 kSetTagErrorBound = 14;
 
-GLOBAL_CROSS_CONST chi::u32 kMaxMethodId = 13;
+GLOBAL_CROSS_CONST chi::u32 kMaxMethodId = 15;
 
 inline const std::vector<std::string>& GetMethodNames() {
   static const std::vector<std::string> names = [] {
@@ -33,10 +36,36 @@ inline const std::vector<std::string>& GetMethodNames() {
     v[10] = "DynamicSchedule";
     v[11] = "Compress";
     v[12] = "Decompress";
+    v[13] = "RefitModels";
+    v[14] = "SetTagErrorBound";
     return v;
   }();
   return names;
 }
+
+/** Per-method traits indexed by method ID (see chimaera_mod.yaml) */
+inline constexpr chi::MethodTraits kMethodTraits[15] = {
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 0: Create
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 1: Destroy
+    {},  // 2
+    {},  // 3
+    {},  // 4
+    {},  // 5
+    {},  // 6
+    {},  // 7
+    {},  // 8
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 9: Monitor
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 10: DynamicSchedule
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 11: Compress
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 12: Decompress
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 13: RefitModels
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 14: SetTagErrorBound
+};
+
+/** @return Traits of a method, or chi::kNoMethodTraits if unknown */
+constexpr const chi::MethodTraits& GetMethodTraits(chi::u32 method) {
+  return method < 15 ? kMethodTraits[method] : chi::kNoMethodTraits;
+}
 }  // namespace Method
 
 }  // namespace wrp_cte::compressor
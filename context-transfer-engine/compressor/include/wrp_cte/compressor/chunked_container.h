@@ -0,0 +1,438 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file chunked_container.h
+ * @brief Chunked container format for parallel blob compression
+ *
+ * Layout: ChunkedCompressionHeader, a ChunkTableEntry per chunk, then the
+ * chunk payloads back to back. Chunks are compressed independently, so they
+ * can be built on several threads and a ranged read only has to fetch and
+ * decompress the chunks it overlaps.
+ */
+
+#ifndef WRP_CTE_COMPRESSOR_CHUNKED_CONTAINER_H_
+#define WRP_CTE_COMPRESSOR_CHUNKED_CONTAINER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "hermes_shm/compress/compress.h"
+
+namespace wrp_cte::compressor {
+
+/**
+ * @brief Header of a chunked compressed blob
+ */
+struct ChunkedCompressionHeader {
+  static constexpr uint32_t kMagic = 0x4B435443;  // "CTCK" in ASCII
+  uint32_t magic_;            // Magic number to identify chunked data
+  uint32_t compress_lib_;     // Compression library ID
+  uint32_t compress_preset_;  // Compression preset
+  uint32_t num_chunks_;       // Entries in the chunk table
+  uint64_t original_size_;    // Original uncompressed size
+  uint64_t chunk_size_;       // Uncompressed bytes per chunk (last may be less)
+
+  ChunkedCompressionHeader()
+      : magic_(kMagic),
+        compress_lib_(0),
+        compress_preset_(0),
+        num_chunks_(0),
+        original_size_(0),
+        chunk_size_(0) {}
+
+  bool IsValid() const { return magic_ == kMagic && chunk_size_ > 0; }
+};
+static_assert(sizeof(ChunkedCompressionHeader) == 32,
+              "ChunkedCompressionHeader must be 32 bytes");
+
+/**
+ * @brief Location of one chunk's payload
+ */
+struct ChunkTableEntry {
+  static constexpr uint32_t kRaw = 1;  // Stored uncompressed
+  uint64_t offset_;  // Payload offset from the end of the chunk table
+  uint32_t size_;    // Stored payload bytes
+  uint32_t flags_;   // kRaw if compression did not shrink the chunk
+};
+static_assert(sizeof(ChunkTableEntry) == 16, "ChunkTableEntry must be 16 bytes");
+
+/**
+ * @brief Header and chunk table of one chunked blob
+ */
+struct ChunkIndex {
+  ChunkedCompressionHeader header_;
+  std::vector<ChunkTableEntry> table_;
+};
+
+/**
+ * @brief Builds and reads chunked containers
+ */
+class ChunkedCodec {
+ public:
+  /** Creates a compressor; called once per thread, since they hold state */
+  using CompressorFactory = std::function<std::unique_ptr<hshm::Compressor>()>;
+
+  /**
+   * @brief Number of chunks a blob is split into
+   * @param size Uncompressed blob size
+   * @param chunk_size Uncompressed bytes per chunk
+   */
+  static uint32_t NumChunks(uint64_t size, uint64_t chunk_size) {
+    return static_cast<uint32_t>((size + chunk_size - 1) / chunk_size);
+  }
+
+  /**
+   * @brief Offset of the first payload: header plus chunk table
+   * @param num_chunks Entries in the chunk table
+   */
+  static size_t DataOffset(uint32_t num_chunks) {
+    return sizeof(ChunkedCompressionHeader) +
+           static_cast<size_t>(num_chunks) * sizeof(ChunkTableEntry);
+  }
+
+  /**
+   * @brief Parse the header and chunk table at the start of a container
+   * @param data Stored bytes from offset 0
+   * @param size Number of bytes available
+   * @param index Output: the parsed index
+   * @return false if data is not a chunked container or is too short
+   */
+  static bool ParseIndex(const char* data, size_t size, ChunkIndex& index) {
+    if (size < sizeof(ChunkedCompressionHeader)) return false;
+    std::memcpy(&index.header_, data, sizeof(ChunkedCompressionHeader));
+    if (!index.header_.IsValid() ||
+        size < DataOffset(index.header_.num_chunks_)) {
+      return false;
+    }
+    index.table_.resize(index.header_.num_chunks_);
+    std::memcpy(index.table_.data(), data + sizeof(ChunkedCompressionHeader),
+                index.table_.size() * sizeof(ChunkTableEntry));
+    return true;
+  }
+
+  /**
+   * @brief Run fn(thread, index) for every index, strided across threads
+   * @param count Number of indices
+   * @param num_threads Threads to use (1 runs inline)
+   * @param fn Work item
+   */
+  static void ParallelFor(size_t count, size_t num_threads,
+                          const std::function<void(size_t, size_t)>& fn) {
+    num_threads = std::max<size_t>(std::min(num_threads, count), 1);
+    if (num_threads == 1) {
+      for (size_t i = 0; i < count; ++i) fn(0, i);
+      return;
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t]() {
+        for (size_t i = t; i < count; i += num_threads) fn(t, i);
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  /**
+   * @brief Compress a blob into a chunked container
+   *
+   * Chunks that fail to compress or do not shrink are stored raw.
+   *
+   * @param factory Compressor factory
+   * @param compress_lib Library ID recorded in the header
+   * @param compress_preset Preset recorded in the header
+   * @param chunk_size Uncompressed bytes per chunk
+   * @param input Blob data
+   * @param input_size Blob size in bytes
+   * @param num_threads Compression threads
+   * @param output Output: the container
+   * @return false if no compressor could be created
+   */
+  static bool Compress(const CompressorFactory& factory, uint32_t compress_lib,
+                       uint32_t compress_preset, uint64_t chunk_size,
+                       const char* input, uint64_t input_size,
+                       size_t num_threads, std::vector<char>& output) {
+    ChunkedCompressionHeader header;
+    header.compress_lib_ = compress_lib;
+    header.compress_preset_ = compress_preset;
+    header.num_chunks_ = NumChunks(input_size, chunk_size);
+    header.original_size_ = input_size;
+    header.chunk_size_ = chunk_size;
+
+    std::vector<std::vector<char>> payloads(header.num_chunks_);
+    std::vector<ChunkTableEntry> table(header.num_chunks_);
+    num_threads = std::max<size_t>(num_threads, 1);
+    std::vector<std::unique_ptr<hshm::Compressor>> compressors(num_threads);
+    std::atomic<bool> ok{true};
+    ParallelFor(header.num_chunks_, num_threads, [&](size_t t, size_t i) {
+      auto& compressor = compressors[t];
+      if (!compressor) compressor = factory();
+      if (!compressor) {
+        ok = false;
+        return;
+      }
+      uint64_t begin = i * chunk_size;
+      size_t len = static_cast<size_t>(std::min(chunk_size, input_size - begin));
+      auto& payload = payloads[i];
+      payload.resize(len + len / 20 + 1024);
+      size_t stored = payload.size();
+      bool shrunk = compressor->Compress(payload.data(), stored,
+                                         const_cast<char*>(input + begin), len) &&
+                    stored < len;
+      if (!shrunk) {
+        stored = len;
+        payload.assign(input + begin, input + begin + len);
+        table[i].flags_ = ChunkTableEntry::kRaw;
+      }
+      payload.resize(stored);
+      table[i].size_ = static_cast<uint32_t>(stored);
+    });
+    if (!ok) return false;
+
+    uint64_t data_size = 0;
+    for (uint32_t i = 0; i < header.num_chunks_; ++i) {
+      table[i].offset_ = data_size;
+      data_size += table[i].size_;
+    }
+    size_t data_offset = DataOffset(header.num_chunks_);
+    output.resize(data_offset + data_size);
+    std::memcpy(output.data(), &header, sizeof(header));
+    std::memcpy(output.data() + sizeof(header), table.data(),
+                table.size() * sizeof(ChunkTableEntry));
+    for (uint32_t i = 0; i < header.num_chunks_; ++i) {
+      std::memcpy(output.data() + data_offset + table[i].offset_,
+                  payloads[i].data(), table[i].size_);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Chunks that overlap a byte range of the original blob
+   * @param header Container header
+   * @param offset Range start in the original blob
+   * @param size Range length
+   * @param first Output: first chunk
+   * @param last Output: last chunk (inclusive)
+   * @return false if the range is empty or past the end of the blob
+   */
+  static bool ChunkSpan(const ChunkedCompressionHeader& header, uint64_t offset,
+                        uint64_t size, uint32_t& first, uint32_t& last) {
+    if (size == 0 || offset >= header.original_size_) return false;
+    uint64_t end = std::min(offset + size, header.original_size_);
+    first = static_cast<uint32_t>(offset / header.chunk_size_);
+    last = static_cast<uint32_t>((end - 1) / header.chunk_size_);
+    return true;
+  }
+
+  /**
+   * @brief Decompress a byte range of the original blob
+   *
+   * Only the chunks from ChunkSpan are touched. Chunks fully inside the
+   * range are decompressed in place; the edge chunks go through a scratch
+   * buffer.
+   *
+   * @param factory Compressor factory
+   * @param header Container header
+   * @param table Chunk table
+   * @param data Payload bytes, starting at the first payload of the span
+   * @param offset Range start in the original blob
+   * @param size Range length (clipped to the blob)
+   * @param output Output buffer of at least the clipped size
+   * @param num_threads Decompression threads
+   * @return Bytes written, or 0 if a chunk failed to decompress
+   */
+  static uint64_t DecompressRange(const CompressorFactory& factory,
+                                  const ChunkedCompressionHeader& header,
+                                  const ChunkTableEntry* table, const char* data,
+                                  uint64_t offset, uint64_t size, char* output,
+                                  size_t num_threads) {
+    uint32_t first = 0, last = 0;
+    if (!ChunkSpan(header, offset, size, first, last)) return 0;
+    uint64_t end = std::min(offset + size, header.original_size_);
+    uint64_t base = table[first].offset_;
+    num_threads = std::max<size_t>(num_threads, 1);
+    std::vector<std::unique_ptr<hshm::Compressor>> compressors(num_threads);
+    std::atomic<bool> ok{true};
+    ParallelFor(last - first + 1, num_threads, [&](size_t t, size_t k) {
+      uint32_t i = first + static_cast<uint32_t>(k);
+      uint64_t begin = static_cast<uint64_t>(i) * header.chunk_size_;
+      size_t len = static_cast<size_t>(
+          std::min(header.chunk_size_, header.original_size_ - begin));
+      uint64_t copy_begin = std::max(begin, offset);
+      uint64_t copy_end = std::min(begin + len, end);
+      char* dst = output + (copy_begin - offset);
+      char* src = const_cast<char*>(data + (table[i].offset_ - base));
+      if (table[i].flags_ & ChunkTableEntry::kRaw) {
+        std::memcpy(dst, src + (copy_begin - begin), copy_end - copy_begin);
+        return;
+      }
+      auto& compressor = compressors[t];
+      if (!compressor) compressor = factory();
+      bool whole = copy_begin == begin && copy_end == begin + len;
+      std::vector<char> scratch(whole ? 0 : len);
+      size_t out_len = len;
+      if (!compressor ||
+          !compressor->Decompress(whole ? dst : scratch.data(), out_len, src,
+                                  table[i].size_) ||
+          out_len != len) {
+        ok = false;
+        return;
+      }
+      if (!whole) {
+        std::memcpy(dst, scratch.data() + (copy_begin - begin),
+                    copy_end - copy_begin);
+      }
+    });
+    return ok ? end - offset : 0;
+  }
+};
+
+/**
+ * @brief Thread-safe LRU cache of chunk indexes by blob
+ *
+ * Lets repeated ranged reads of a chunked blob fetch only payload bytes,
+ * skipping the header and chunk table reads.
+ */
+class ChunkIndexCache {
+ public:
+  /**
+   * @brief Constructor
+   * @param capacity Maximum blobs (0 disables the cache)
+   */
+  explicit ChunkIndexCache(size_t capacity = 0) : capacity_(capacity) {}
+
+  /**
+   * @brief Change the capacity, evicting the oldest entries if needed
+   * @param capacity Maximum blobs (0 disables the cache)
+   */
+  void SetCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    EvictToCapacity();
+  }
+
+  /**
+   * @brief Build the key of a blob
+   * @param tag_id Tag ID as a u64
+   * @param blob_name Blob name
+   */
+  static std::string MakeKey(uint64_t tag_id, const std::string& blob_name) {
+    std::string key(reinterpret_cast<const char*>(&tag_id), sizeof(tag_id));
+    key += blob_name;
+    return key;
+  }
+
+  /**
+   * @brief Look up a blob's index and mark it most recently used
+   * @param key Key from MakeKey
+   * @return The index, or nullptr on a miss
+   */
+  std::shared_ptr<const ChunkIndex> Lookup(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = map_.find(key);
+    if (it == map_.end()) return nullptr;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->second;
+  }
+
+  /**
+   * @brief Insert or replace a blob's index
+   * @param key Key from MakeKey
+   * @param index Parsed index
+   */
+  void Insert(const std::string& key, ChunkIndex index) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (capacity_ == 0) return;
+    auto value = std::make_shared<const ChunkIndex>(std::move(index));
+    auto it = map_.find(key);
+    if (it != map_.end()) {
+      it->second->second = std::move(value);
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return;
+    }
+    lru_.emplace_front(key, std::move(value));
+    map_[key] = lru_.begin();
+    EvictToCapacity();
+  }
+
+  /**
+   * @brief Forget a blob, e.g. because it is being rewritten
+   * @param key Key from MakeKey
+   */
+  void Erase(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = map_.find(key);
+    if (it == map_.end()) return;
+    lru_.erase(it->second);
+    map_.erase(it);
+  }
+
+  /** @return Number of cached indexes */
+  size_t Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lru_.size();
+  }
+
+ private:
+  using Entry = std::pair<std::string, std::shared_ptr<const ChunkIndex>>;
+
+  void EvictToCapacity() {
+    while (lru_.size() > capacity_) {
+      map_.erase(lru_.back().first);
+      lru_.pop_back();
+    }
+  }
+
+  mutable std::mutex mutex_;
+  size_t capacity_;
+  std::list<Entry> lru_;  // Most recently used first
+  std::unordered_map<std::string, std::list<Entry>::iterator> map_;
+};
+
+}  // namespace wrp_cte::compressor
+
+#endif  // WRP_CTE_COMPRESSOR_CHUNKED_CONTAINER_H_
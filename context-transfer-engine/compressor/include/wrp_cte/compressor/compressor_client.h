@@ -150,6 +150,53 @@ class Client : public wrp_cte::core::Client {
                         blob_data, pool_query);
   }
 
+  // ------------------------------------------------------------------
+  // Tag error bounds
+  // ------------------------------------------------------------------
+
+  /**
+   * Get or create a tag and set the error bound its float blobs may be
+   * compressed lossily within. Blocks until both are done.
+   * @param tag_name Tag name
+   * @param error_bound Error bound (kNone keeps the tag lossless)
+   * @param placement Placement policy (used when first set)
+   * @return Tag ID, or a null ID if the tag could not be created
+   */
+  wrp_cte::core::TagId GetOrCreateTag(
+      const std::string &tag_name, const TagErrorBound &error_bound,
+      const wrp_cte::core::TagPlacement &placement =
+          wrp_cte::core::TagPlacement()) {
+    auto tag_task =
+        AsyncGetOrCreateTag(tag_name, wrp_cte::core::TagId::GetNull(),
+                            chi::PoolQuery::Dynamic(), placement);
+    tag_task.Wait();
+    if (tag_task->return_code_ != 0) {
+      return wrp_cte::core::TagId::GetNull();
+    }
+    wrp_cte::core::TagId tag_id = tag_task->tag_id_;
+    if (error_bound.IsSet()) {
+      auto bound_task = AsyncSetTagErrorBound(tag_id, error_bound);
+      bound_task.Wait();
+    }
+    return tag_id;
+  }
+
+  /**
+   * Set the error bound of a tag on every compressor container
+   * @param tag_id Tag whose float blobs the bound applies to
+   * @param error_bound Error bound (kNone clears it)
+   * @param pool_query Pool query for task routing (default: Broadcast)
+   */
+  chi::Future<SetTagErrorBoundTask> AsyncSetTagErrorBound(
+      const wrp_cte::core::TagId &tag_id, const TagErrorBound &error_bound,
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast()) {
+    auto *ipc_manager = CHI_IPC;
+    auto task = ipc_manager->NewTask<SetTagErrorBoundTask>(
+        chi::CreateTaskId(), compressor_pool_id_, pool_query, tag_id,
+        error_bound);
+    return ipc_manager->Send(task);
+  }
+
   // ------------------------------------------------------------------
   // Compressor-specific methods (used internally by compressor runtime)
   // ------------------------------------------------------------------
@@ -204,6 +251,24 @@ class Client : public wrp_cte::core::Client {
     return ipc_manager->Send(task);
   }
 
+  /**
+   * Refit the predictors from observed compression outcomes.
+   * @param pool_query Pool query for task routing (default: Local)
+   * @param period_us Period in microseconds (0 = one-shot)
+   */
+  chi::Future<RefitModelsTask> AsyncRefitModels(
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Local(),
+      double period_us = 0) {
+    auto *ipc_manager = CHI_IPC;
+    auto task = ipc_manager->NewTask<RefitModelsTask>(
+        chi::CreateTaskId(), compressor_pool_id_, pool_query);
+    if (period_us > 0) {
+      task->SetPeriod(period_us, chi::kMicro);
+      task->SetFlags(TASK_PERIODIC);
+    }
+    return ipc_manager->Send(task);
+  }
+
  private:
   chi::PoolId compressor_pool_id_;
 };
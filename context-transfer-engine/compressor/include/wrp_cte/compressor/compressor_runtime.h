@@ -39,8 +39,14 @@
 #include <chimaera/chimaera.h>
 #include <hermes_shm/data_structures/ipc/ring_buffer.h>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <wrp_cte/compressor/compressor_tasks.h>
+#include <wrp_cte/compressor/chunked_container.h>
 #include <wrp_cte/compressor/compressor_client.h>
+#include <wrp_cte/compressor/decision_cache.h>
+#include <wrp_cte/compressor/dictionary_store.h>
+#include <wrp_cte/compressor/feedback_ring.h>
 #include <wrp_cte/compressor/models/compression_features.h>
 #include <wrp_cte/compressor/models/qtable_predictor.h>
 #include <wrp_cte/compressor/models/linreg_table_predictor.h>
@@ -82,7 +88,7 @@ public:
   using CreateParams = CompressorConfig; // Required for CHI_TASK_CC (defined in compressor_tasks.h)
 
   Runtime() = default;
-  ~Runtime() override = default;
+  ~Runtime() override;
 
 private:
   // Client for this ChiMod
@@ -130,6 +136,21 @@ private:
   chi::TaskResume Decompress(hipc::FullPtr<DecompressTask> task,
                               chi::RunContext &ctx);
 
+  /**
+   * Refit the predictors (Method::kRefitModels)
+   * Periodic; folds the outcomes recorded by Compress into the Q-table and
+   * LinReg models using the container's learning rate
+   */
+  chi::TaskResume RefitModels(hipc::FullPtr<RefitModelsTask> task,
+                               chi::RunContext &ctx);
+
+  /**
+   * Set a tag's lossy error bound (Method::kSetTagErrorBound)
+   * Broadcast so every container compresses the tag's blobs the same way
+   */
+  chi::TaskResume SetTagErrorBound(hipc::FullPtr<SetTagErrorBoundTask> task,
+                                    chi::RunContext &ctx);
+
   /**
    * Schedule a task by resolving Dynamic pool queries.
    */
@@ -183,27 +204,151 @@ private:
   std::unordered_map<std::string, TargetState> target_states_;
   std::mutex target_states_mutex_;
 
+  // DynamicSchedule decisions by tag and feature bucket; cleared when a
+  // target's score changes
+  CompressionDecisionCache decision_cache_;
+
+  // Chunk indexes of chunked blobs, so ranged reads skip the table fetch
+  ChunkIndexCache chunk_index_cache_;
+
+  // zstd dictionaries trained from each tag's small blobs
+  TagDictionaryStore tag_dictionaries_;
+
+  // Outcomes observed by Compress, drained by RefitModels
+  CompressionFeedbackRing feedback_ring_;
+
+  // Lossy error bounds of tags, by TagId::ToU64()
+  std::unordered_map<chi::u64, TagErrorBound> tag_error_bounds_;
+  std::mutex tag_error_bounds_mutex_;
+
+  /**
+   * Get the error bound of a tag
+   * @param tag_id Tag
+   * @return Its bound, or an unset bound if it has none
+   */
+  TagErrorBound GetTagErrorBound(const wrp_cte::core::TagId& tag_id);
+
+  /**
+   * Pick the lossy codec and preset with the best ratio on a sample of a
+   * float blob whose reconstruction stays within the tag's bound
+   * @param bound Error bound of the blob's tag
+   * @param data Blob data
+   * @param size Blob size in bytes
+   * @param decision In/out: library and preset replaced if one qualifies
+   * @return true if a lossy codec met the bound
+   */
+  bool ScheduleLossy(const TagErrorBound& bound, const char* data,
+                     chi::u64 size, CompressionDecision& decision);
+
+  /**
+   * Spot-check the reconstruction of sampled blocks of a lossy blob
+   * @param bound Error bound of the blob's tag
+   * @param context Compression context (library and preset used)
+   * @param input Original blob
+   * @param input_size Blob size in bytes
+   * @param stored Header plus compressed data (whole or chunked)
+   * @param min_psnr Output: lowest PSNR of the checked blocks (0 = exact)
+   * @return true if every checked block is within the bound
+   */
+  bool VerifyErrorBound(const TagErrorBound& bound, const Context& context,
+                        const char* input, chi::u64 input_size,
+                        const std::vector<char>& stored, double& min_psnr);
+
+  // Incompressible blobs seen in a row, by TagId::ToU64()
+  struct IncompressibleTag {
+    chi::u32 streak_ = 0;   // Consecutive blobs over the entropy threshold
+    chi::u32 skipped_ = 0;  // Blobs bypassed without sampling since then
+  };
+  std::unordered_map<chi::u64, IncompressibleTag> incompressible_tags_;
+  std::mutex incompressible_tags_mutex_;
+
+  // Compression totals exported on the runtime's /metrics endpoint
+  std::atomic<chi::u64> metric_blobs_compressed_{0};  // Stored compressed
+  std::atomic<chi::u64> metric_blobs_raw_{0};     // Stored uncompressed
+  std::atomic<chi::u64> metric_input_bytes_{0};   // Bytes given to Compress
+  std::atomic<chi::u64> metric_stored_bytes_{0};  // Bytes handed to PutBlob
+
+  /**
+   * Count one Compress outcome for the metrics endpoint
+   * @param input_size Blob bytes before compression
+   * @param stored_size Bytes stored (input_size when kept uncompressed)
+   */
+  void CountCompression(chi::u64 input_size, chi::u64 stored_size);
+
+  /** Key of this container's collector in CHI_METRICS */
+  std::string MetricsKey() const;
+
   /**
-   * Estimate compression statistics using AI models
+   * Emit compression totals and ratio (runs on the metrics thread)
+   * @param writer Exposition being built
+   */
+  void CollectMetrics(chi::MetricsWriter &writer);
+
+  /**
+   * Check a blob for data not worth compressing (encrypted or already
+   * compressed) from the byte entropy of a few KB. Once a tag has had
+   * incompressible_streak such blobs in a row, its blobs skip the check
+   * and are only re-sampled now and then.
+   * @param tag_id Tag of the blob
+   * @param data Blob data (host memory)
+   * @param size Blob size in bytes
+   * @param context Compression context (data type)
+   * @return true if the blob should be stored uncompressed
+   */
+  bool IsIncompressible(const wrp_cte::core::TagId& tag_id, const void* data,
+                        chi::u64 size, const Context& context);
+
+  /**
+   * Compute the features of the sample of a chunk the predictors look at
    * @param chunk Pointer to data chunk
    * @param chunk_size Size of chunk in bytes
    * @param context Compression context with parameters
+   * @return Features of the first 64KB of the chunk (copied to the host
+   *         first if the chunk is in device memory)
+   */
+  hshm::CompressionFeatureSet SampleChunkFeatures(
+      const void* chunk, chi::u64 chunk_size, const Context& context);
+
+  /**
+   * Estimate compression statistics using AI models. All candidate
+   * library/preset pairs are scored in one PredictBatch call.
+   * @param chunk_features Features from SampleChunkFeatures
+   * @param chunk_size Size of chunk in bytes
+   * @param context Compression context with parameters
+   * @param on_device Chunk is in device memory; candidates are GPU codecs
    * @return Vector of compression statistics for candidate libraries
    */
   std::vector<CompressionStats> EstCompressionStats(
-      const void* chunk, chi::u64 chunk_size, const Context& context);
+      const hshm::CompressionFeatureSet& chunk_features, chi::u64 chunk_size,
+      const Context& context, bool on_device);
+
+  /**
+   * Record what compressing a blob achieved, for RefitModels. Does
+   * nothing without a CPU predictor to refit.
+   * @param context Compression context (library and preset that ran)
+   * @param input Blob data
+   * @param input_size Blob size in bytes
+   * @param stored_size Size of the header plus compressed data
+   * @param compress_time_ms Measured compression time
+   */
+  void RecordCompressOutcome(const Context& context, const char* input,
+                             chi::u64 input_size, size_t stored_size,
+                             double compress_time_ms);
 
   /**
    * Estimate workflow compression time for a specific tier
    * @param chunk_size Size of chunk in bytes
    * @param tier_bw Tier bandwidth in bytes/second
+   * @param tier_curve Tier's fitted write curve; used instead of tier_bw
+   *        once fitted
    * @param stats Compression statistics for library
    * @param context Compression context
    * @return Estimated time in milliseconds
    */
   double EstWorkflowCompressTime(
-      chi::u64 chunk_size, double tier_bw, const CompressionStats& stats,
-      const Context& context);
+      chi::u64 chunk_size, double tier_bw,
+      const chimaera::bdev::PerfCurve& tier_curve,
+      const CompressionStats& stats, const Context& context);
 
   /**
    * Find best compression for ratio optimization
@@ -244,6 +389,124 @@ private:
       const Context& context, const void* chunk, chi::u64 chunk_size,
       int container_id, const std::vector<CompressionStats>& stats);
 
+  /**
+   * Predict the candidates for a chunk and pick the best one
+   * @param context Compression context
+   * @param chunk Pointer to data chunk
+   * @param chunk_size Size of chunk
+   * @param chunk_features Features from SampleChunkFeatures
+   * @param on_device Chunk is in device memory
+   * @return Chosen library, preset and tier score
+   */
+  CompressionDecision ScheduleChunk(
+      const Context& context, const void* chunk, chi::u64 chunk_size,
+      const hshm::CompressionFeatureSet& chunk_features, bool on_device);
+
+  /**
+   * Compress a blob as one buffer behind a CompressionHeader
+   * @param compressor Compressor for the requested library and preset
+   * @param context Compression context
+   * @param input Blob data
+   * @param input_size Blob size in bytes
+   * @param dict_id ID of the dictionary compressor uses (0 if none)
+   * @param stored Output: header plus compressed data
+   * @return true if the compressor succeeded
+   */
+  bool CompressWhole(hshm::Compressor* compressor, const Context& context,
+                     const char* input, chi::u64 input_size, chi::u32 dict_id,
+                     std::vector<char>& stored);
+
+  /**
+   * Get the dictionary to compress a small blob of a tag with. Until the
+   * tag has one, the blob is kept as a training sample, and the sample
+   * that fills the batch trains the dictionary.
+   * @param tag_id Tag of the blob
+   * @param input Blob data
+   * @param input_size Blob size in bytes
+   * @return The tag's dictionary, or nullptr if it has none yet
+   */
+  TagDictionaryStore::DictPtr GetTagDictionary(
+      const wrp_cte::core::TagId& tag_id, const char* input,
+      chi::u64 input_size);
+
+  /**
+   * Train a tag's dictionary, store it as a blob of the tag and make it
+   * the tag's current dictionary
+   * @param tag_id Tag the samples came from
+   * @param batch Sample blobs
+   * @return The dictionary, or nullptr if training or storing failed
+   */
+  TagDictionaryStore::DictPtr TrainTagDictionary(
+      const wrp_cte::core::TagId& tag_id, const DictionarySamples& batch);
+
+  /**
+   * Find a dictionary of a tag by ID, reading it from the tag's
+   * dictionary blob if it is not loaded
+   * @param tag_id Tag of the blob being decompressed
+   * @param dict_id Dictionary ID from the blob's header
+   * @return The dictionary, or nullptr if it cannot be found
+   */
+  TagDictionaryStore::DictPtr LoadTagDictionary(
+      const wrp_cte::core::TagId& tag_id, chi::u32 dict_id);
+
+  /**
+   * Compress a blob as a chunked container on compress_threads_ threads
+   * @param context Compression context
+   * @param input Blob data
+   * @param input_size Blob size in bytes
+   * @param stored Output: the chunked container
+   * @return true if a compressor could be created
+   */
+  bool CompressChunked(const Context& context, const char* input,
+                       chi::u64 input_size, std::vector<char>& stored);
+
+  /**
+   * Read stored bytes of a blob through the next pool's GetBlob
+   * @param task Decompress task (names the blob)
+   * @param offset Offset in the stored blob
+   * @param size Bytes to read
+   * @param buffer Output: shared-memory buffer the caller frees
+   * @return 0 on success, else a Decompress return code
+   */
+  chi::u32 ReadStored(const hipc::FullPtr<DecompressTask>& task,
+                      chi::u64 offset, chi::u64 size,
+                      hipc::FullPtr<char>& buffer);
+
+  /**
+   * Serve a read of a chunked blob from its cached index, or by probing
+   * the stored header when the read does not start at offset 0
+   * @param task Decompress task
+   * @return true if the read was handled (task->return_code_ is set)
+   */
+  bool TryDecompressChunked(hipc::FullPtr<DecompressTask> task);
+
+  /**
+   * Load the index of a chunked blob and add it to chunk_index_cache_
+   * @param task Decompress task (names the blob)
+   * @param header Chunked container header
+   * @param prefix Stored bytes from offset 0 that were already read
+   * @param prefix_size Size of prefix
+   * @param index Output: header and chunk table
+   * @return 0 on success, else a Decompress return code
+   */
+  chi::u32 LoadChunkIndex(const hipc::FullPtr<DecompressTask>& task,
+                          const ChunkedCompressionHeader& header,
+                          const char* prefix, chi::u64 prefix_size,
+                          ChunkIndex& index);
+
+  /**
+   * Decompress the task's range of a chunked blob, fetching only the
+   * chunks the range overlaps
+   * @param task Decompress task
+   * @param index Header and chunk table of the blob
+   * @param prefix Stored bytes from offset 0 that were already read
+   * @param prefix_size Size of prefix (0 if none)
+   * @return 0 on success, else a Decompress return code
+   */
+  chi::u32 DecompressChunked(hipc::FullPtr<DecompressTask> task,
+                             const ChunkIndex& index, const char* prefix,
+                             chi::u64 prefix_size);
+
   /**
    * Log compression telemetry for performance monitoring
    * @param telemetry Compression telemetry entry
@@ -40,6 +40,9 @@
 #include <chimaera/admin/admin_tasks.h>
 #include <wrp_cte/core/core_tasks.h>
 #include <wrp_cte/compressor/autogen/compressor_methods.h>
+#include <wrp_cte/compressor/error_bound.h>
+
+#include "hermes_shm/util/config_parse.h"
 
 namespace wrp_cte::compressor {
 
@@ -59,10 +62,41 @@ struct CompressorConfig {
   std::string distribution_model_path_;
   std::string dnn_model_weights_path_;
   std::string trace_folder_path_;
+  chi::u32 decision_cache_size_;  ///< DynamicSchedule decisions kept (0 = off)
+  chi::u64 chunk_size_;  ///< Blobs above this are compressed in chunks (0 = off)
+  chi::u32 compress_threads_;  ///< Threads per chunked (de)compression
+  chi::u32 chunk_index_cache_size_;  ///< Chunked blob indexes kept (0 = off)
+  chi::u64 dict_max_blob_size_;  ///< zstd blobs up to this use a tag
+                                 ///< dictionary (0 = off)
+  chi::u32 dict_train_samples_;  ///< Sample blobs per dictionary
+  chi::u64 dict_size_;           ///< Maximum dictionary size in bytes
+  chi::u32 feedback_buffer_size_;  ///< Observed outcomes kept for model
+                                   ///< refits (0 = off)
+  chi::u32 refit_period_ms_;       ///< Period of RefitModels (0 = off)
+  chi::u32 refit_min_samples_;     ///< Outcomes required before a refit
+  double incompressible_entropy_;  ///< Sampled bits/byte at which a blob is
+                                   ///< stored uncompressed (0 = off)
+  chi::u32 entropy_sample_bytes_;  ///< Bytes sampled for the entropy check
+  chi::u32 incompressible_streak_;  ///< Incompressible blobs in a row before
+                                    ///< a tag skips the check (0 = never)
   chi::PoolId next_pool_id_;  ///< Pool ID of the next module in the pipeline
                                ///< (e.g., CTE core at 513.0)
 
-  CompressorConfig() : next_pool_id_(chi::PoolId::GetNull()) {}
+  CompressorConfig()
+      : decision_cache_size_(256),
+        chunk_size_(4 * 1024 * 1024),
+        compress_threads_(4),
+        chunk_index_cache_size_(1024),
+        dict_max_blob_size_(16 * 1024),
+        dict_train_samples_(1024),
+        dict_size_(16 * 1024),
+        feedback_buffer_size_(1024),
+        refit_period_ms_(10000),
+        refit_min_samples_(32),
+        incompressible_entropy_(7.9),
+        entropy_sample_bytes_(4096),
+        incompressible_streak_(3),
+        next_pool_id_(chi::PoolId::GetNull()) {}
 
   CompressorConfig(const chi::PoolId &pool_id, const CompressorConfig &other)
       : qtable_model_path_(other.qtable_model_path_),
@@ -70,6 +104,19 @@ struct CompressorConfig {
         distribution_model_path_(other.distribution_model_path_),
         dnn_model_weights_path_(other.dnn_model_weights_path_),
         trace_folder_path_(other.trace_folder_path_),
+        decision_cache_size_(other.decision_cache_size_),
+        chunk_size_(other.chunk_size_),
+        compress_threads_(other.compress_threads_),
+        chunk_index_cache_size_(other.chunk_index_cache_size_),
+        dict_max_blob_size_(other.dict_max_blob_size_),
+        dict_train_samples_(other.dict_train_samples_),
+        dict_size_(other.dict_size_),
+        feedback_buffer_size_(other.feedback_buffer_size_),
+        refit_period_ms_(other.refit_period_ms_),
+        refit_min_samples_(other.refit_min_samples_),
+        incompressible_entropy_(other.incompressible_entropy_),
+        entropy_sample_bytes_(other.entropy_sample_bytes_),
+        incompressible_streak_(other.incompressible_streak_),
         next_pool_id_(other.next_pool_id_) {
     (void)pool_id;
   }
@@ -77,12 +124,20 @@ struct CompressorConfig {
   template <class Archive>
   void serialize(Archive &ar) {
     ar(qtable_model_path_, linreg_model_path_, distribution_model_path_,
-       dnn_model_weights_path_, trace_folder_path_);
+       dnn_model_weights_path_, trace_folder_path_, decision_cache_size_,
+       chunk_size_, compress_threads_, chunk_index_cache_size_,
+       dict_max_blob_size_, dict_train_samples_, dict_size_,
+       feedback_buffer_size_, refit_period_ms_, refit_min_samples_,
+       incompressible_entropy_, entropy_sample_bytes_, incompressible_streak_);
   }
 
   /**
    * Load configuration from compose YAML.
-   * Reads next_pool_id from the pool config.
+   * Reads next_pool_id, decision_cache_size, chunk_size, compress_threads,
+   * chunk_index_cache_size, dict_max_blob_size, dict_train_samples,
+   * dict_size, feedback_buffer_size, refit_period_ms, refit_min_samples,
+   * incompressible_entropy, entropy_sample_bytes and incompressible_streak
+   * from the pool config.
    */
   void LoadConfig(const chi::PoolConfig &pool_config) {
     // Parse next_pool_id from compose YAML config
@@ -99,6 +154,51 @@ struct CompressorConfig {
             next_pool_id_ = chi::PoolId(major, minor);
           }
         }
+        if (node["decision_cache_size"]) {
+          decision_cache_size_ = node["decision_cache_size"].as<chi::u32>();
+        }
+        if (node["chunk_size"]) {
+          chunk_size_ = hshm::ConfigParse::ParseSize(
+              node["chunk_size"].as<std::string>());
+        }
+        if (node["compress_threads"]) {
+          compress_threads_ = node["compress_threads"].as<chi::u32>();
+        }
+        if (node["chunk_index_cache_size"]) {
+          chunk_index_cache_size_ =
+              node["chunk_index_cache_size"].as<chi::u32>();
+        }
+        if (node["dict_max_blob_size"]) {
+          dict_max_blob_size_ = hshm::ConfigParse::ParseSize(
+              node["dict_max_blob_size"].as<std::string>());
+        }
+        if (node["dict_train_samples"]) {
+          dict_train_samples_ = node["dict_train_samples"].as<chi::u32>();
+        }
+        if (node["dict_size"]) {
+          dict_size_ = hshm::ConfigParse::ParseSize(
+              node["dict_size"].as<std::string>());
+        }
+        if (node["feedback_buffer_size"]) {
+          feedback_buffer_size_ = node["feedback_buffer_size"].as<chi::u32>();
+        }
+        if (node["refit_period_ms"]) {
+          refit_period_ms_ = node["refit_period_ms"].as<chi::u32>();
+        }
+        if (node["refit_min_samples"]) {
+          refit_min_samples_ = node["refit_min_samples"].as<chi::u32>();
+        }
+        if (node["incompressible_entropy"]) {
+          incompressible_entropy_ =
+              node["incompressible_entropy"].as<double>();
+        }
+        if (node["entropy_sample_bytes"]) {
+          entropy_sample_bytes_ = hshm::ConfigParse::ParseSize(
+              node["entropy_sample_bytes"].as<std::string>());
+        }
+        if (node["incompressible_streak"]) {
+          incompressible_streak_ = node["incompressible_streak"].as<chi::u32>();
+        }
       } catch (...) {
         // Config parsing is best-effort
       }
@@ -139,6 +239,7 @@ struct TargetState {
   float target_score_;           // Target score (0-1, normalized log bandwidth)
   chi::u64 remaining_space_;     // Remaining allocatable space in bytes
   chi::u64 bytes_written_;       // Bytes written to target
+  chimaera::bdev::PerfModel perf_model_;  // Curves fitted by the target's bdev
   Timestamp last_updated_;       // When this state was last refreshed
 
   TargetState()
@@ -418,6 +519,80 @@ struct DecompressTask : public chi::Task {
   }
 };
 
+/**
+ * RefitModelsTask - Periodically folds the outcomes observed by Compress
+ * back into the loaded predictors.
+ */
+struct RefitModelsTask : public chi::Task {
+  OUT chi::u32 experiences_used_;  // Outcomes consumed by this refit
+
+  // SHM constructor
+  RefitModelsTask() : chi::Task(), experiences_used_(0) {}
+
+  // Emplace constructor
+  explicit RefitModelsTask(const chi::TaskId &task_id,
+                           const chi::PoolId &pool_id,
+                           const chi::PoolQuery &pool_query)
+      : chi::Task(task_id, pool_id, pool_query, Method::kRefitModels),
+        experiences_used_(0) {}
+
+  void Copy(const hipc::FullPtr<RefitModelsTask>& other) {
+    experiences_used_ = other->experiences_used_;
+  }
+
+  /** Serialize */
+  template <typename Ar>
+  void SerializeStart(Ar &ar) {
+    task_serialize<Ar>(ar);
+    ar(experiences_used_);
+  }
+
+  /** Deserialize */
+  template <typename Ar>
+  void SerializeEnd(Ar &ar) {
+    ar(experiences_used_);
+  }
+};
+
+/**
+ * SetTagErrorBoundTask - Sets the lossy error bound of a tag's float blobs
+ * on every compressor container
+ */
+struct SetTagErrorBoundTask : public chi::Task {
+  IN wrp_cte::core::TagId tag_id_;  // Tag the bound applies to
+  IN TagErrorBound error_bound_;    // kNone clears the bound
+
+  // SHM constructor
+  SetTagErrorBoundTask()
+      : chi::Task(), tag_id_(wrp_cte::core::TagId::GetNull()) {}
+
+  // Emplace constructor
+  explicit SetTagErrorBoundTask(const chi::TaskId &task_id,
+                                const chi::PoolId &pool_id,
+                                const chi::PoolQuery &pool_query,
+                                const wrp_cte::core::TagId &tag_id,
+                                const TagErrorBound &error_bound)
+      : chi::Task(task_id, pool_id, pool_query, Method::kSetTagErrorBound),
+        tag_id_(tag_id),
+        error_bound_(error_bound) {}
+
+  void Copy(const hipc::FullPtr<SetTagErrorBoundTask>& other) {
+    tag_id_ = other->tag_id_;
+    error_bound_ = other->error_bound_;
+  }
+
+  /** Serialize */
+  template <typename Ar>
+  void SerializeStart(Ar &ar) {
+    task_serialize<Ar>(ar);
+    ar(tag_id_, error_bound_);
+  }
+
+  /** Deserialize */
+  template <typename Ar>
+  void SerializeEnd(Ar &ar) {}
+};
+
 }  // namespace wrp_cte::compressor
 
 #endif  // WRP_CTE_COMPRESSOR_COMPRESSOR_TASKS_H_
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file decision_cache.h
+ * @brief LRU cache of compression decisions made by DynamicSchedule
+ *
+ * Repeated timesteps of a variable tend to land in the same feature bucket,
+ * so the library and preset chosen for one of them can be reused for the
+ * next without running the predictors again.
+ */
+
+#ifndef WRP_CTE_COMPRESSOR_DECISION_CACHE_H_
+#define WRP_CTE_COMPRESSOR_DECISION_CACHE_H_
+
+#include <wrp_cte/core/core_tasks.h>
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "hermes_shm/compress/data_stats.h"
+
+namespace wrp_cte::compressor {
+
+/**
+ * @brief Everything a compression decision depends on, quantized
+ */
+struct CompressionDecisionKey {
+  wrp_cte::core::TagId tag_id_;
+  int data_type_ = 0;
+  int dynamic_compress_ = 0;
+  int compress_lib_ = 0;     // Requested library (static mode)
+  chi::u32 target_psnr_ = 0;
+  bool max_performance_ = false;
+  bool on_device_ = false;   // Chunk was in device memory
+  int size_bucket_ = 0;      // log2 of the chunk size
+  int entropy_bucket_ = 0;   // Quarter bits
+  int mad_bucket_ = 0;       // Quarter steps of log2(1 + MAD)
+  int curve_bucket_ = 0;     // Quarter steps of log2(1 + second derivative)
+
+  bool operator==(const CompressionDecisionKey& other) const {
+    return tag_id_ == other.tag_id_ && data_type_ == other.data_type_ &&
+           dynamic_compress_ == other.dynamic_compress_ &&
+           compress_lib_ == other.compress_lib_ &&
+           target_psnr_ == other.target_psnr_ &&
+           max_performance_ == other.max_performance_ &&
+           on_device_ == other.on_device_ &&
+           size_bucket_ == other.size_bucket_ &&
+           entropy_bucket_ == other.entropy_bucket_ &&
+           mad_bucket_ == other.mad_bucket_ &&
+           curve_bucket_ == other.curve_bucket_;
+  }
+};
+
+/**
+ * @brief Hash for CompressionDecisionKey
+ */
+struct CompressionDecisionKeyHash {
+  size_t operator()(const CompressionDecisionKey& key) const {
+    size_t hash = std::hash<wrp_cte::core::TagId>()(key.tag_id_);
+    auto mix = [&hash](uint64_t value) {
+      hash ^= std::hash<uint64_t>()(value) + 0x9e3779b97f4a7c15ULL +
+              (hash << 6) + (hash >> 2);
+    };
+    mix(static_cast<uint64_t>(key.data_type_) << 32 |
+        static_cast<uint32_t>(key.dynamic_compress_));
+    mix(static_cast<uint64_t>(key.compress_lib_) << 32 | key.target_psnr_);
+    mix(static_cast<uint64_t>(key.size_bucket_) << 34 |
+        static_cast<uint64_t>(key.on_device_) << 33 |
+        static_cast<uint64_t>(key.max_performance_) << 32 |
+        static_cast<uint32_t>(key.entropy_bucket_));
+    mix(static_cast<uint64_t>(key.mad_bucket_) << 32 |
+        static_cast<uint32_t>(key.curve_bucket_));
+    return hash;
+  }
+};
+
+/**
+ * @brief A cached DynamicSchedule decision
+ */
+struct CompressionDecision {
+  bool compress_ = false;  // false: no candidate was usable, store raw
+  int compress_lib_ = 0;
+  int compress_preset_ = 2;
+  float tier_score_ = 0.0F;
+};
+
+/**
+ * @brief Thread-safe LRU cache of compression decisions
+ */
+class CompressionDecisionCache {
+ public:
+  /**
+   * @brief Constructor
+   * @param capacity Maximum entries (0 disables the cache)
+   */
+  explicit CompressionDecisionCache(size_t capacity = 0)
+      : capacity_(capacity) {}
+
+  /**
+   * @brief Change the capacity, evicting the oldest entries if needed
+   * @param capacity Maximum entries (0 disables the cache)
+   */
+  void SetCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    EvictToCapacity();
+  }
+
+  /** @return true if the cache can hold entries */
+  bool Enabled() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_ > 0;
+  }
+
+  /**
+   * @brief Build the key of a chunk
+   * @param tag_id Tag the chunk belongs to
+   * @param features Features of the chunk's sample
+   * @param chunk_size Chunk size in bytes
+   * @param context Compression context of the request
+   * @param on_device Chunk is in device memory (GPU candidates)
+   * @return Quantized key
+   */
+  static CompressionDecisionKey MakeKey(
+      const wrp_cte::core::TagId& tag_id,
+      const hshm::CompressionFeatureSet& features, chi::u64 chunk_size,
+      const wrp_cte::core::Context& context, bool on_device = false) {
+    CompressionDecisionKey key;
+    key.tag_id_ = tag_id;
+    key.data_type_ = context.data_type_;
+    key.dynamic_compress_ = context.dynamic_compress_;
+    key.compress_lib_ = context.dynamic_compress_ == 1 ? context.compress_lib_ : 0;
+    key.target_psnr_ = context.target_psnr_;
+    key.max_performance_ = context.max_performance_;
+    key.on_device_ = on_device;
+    key.size_bucket_ = chunk_size > 0 ? static_cast<int>(std::log2(
+                                            static_cast<double>(chunk_size)))
+                                      : 0;
+    key.entropy_bucket_ = static_cast<int>(features.shannon_entropy * 4.0);
+    key.mad_bucket_ = static_cast<int>(std::log2(1.0 + features.mad) * 4.0);
+    key.curve_bucket_ =
+        static_cast<int>(std::log2(1.0 + features.second_derivative) * 4.0);
+    return key;
+  }
+
+  /**
+   * @brief Look up a decision and mark it most recently used
+   * @param key Key from MakeKey
+   * @param decision Output: the cached decision
+   * @return true on a hit
+   */
+  bool Lookup(const CompressionDecisionKey& key, CompressionDecision& decision) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      ++misses_;
+      return false;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    decision = it->second->second;
+    ++hits_;
+    return true;
+  }
+
+  /**
+   * @brief Insert or replace a decision
+   * @param key Key from MakeKey
+   * @param decision Decision to remember
+   */
+  void Insert(const CompressionDecisionKey& key,
+              const CompressionDecision& decision) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (capacity_ == 0) {
+      return;
+    }
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      it->second->second = decision;
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return;
+    }
+    lru_.emplace_front(key, decision);
+    index_[key] = lru_.begin();
+    EvictToCapacity();
+  }
+
+  /** @brief Drop every decision, e.g. when target bandwidths change */
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    index_.clear();
+  }
+
+  /** @return Number of cached decisions */
+  size_t Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lru_.size();
+  }
+
+  /** @return Lookups that found a decision */
+  size_t GetHits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+  }
+
+  /** @return Lookups that missed */
+  size_t GetMisses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+  }
+
+ private:
+  using Entry = std::pair<CompressionDecisionKey, CompressionDecision>;
+
+  void EvictToCapacity() {
+    while (lru_.size() > capacity_) {
+      index_.erase(lru_.back().first);
+      lru_.pop_back();
+    }
+  }
+
+  mutable std::mutex mutex_;
+  size_t capacity_;
+  std::list<Entry> lru_;  // Most recently used first
+  std::unordered_map<CompressionDecisionKey, std::list<Entry>::iterator,
+                     CompressionDecisionKeyHash>
+      index_;
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+};
+
+}  // namespace wrp_cte::compressor
+
+#endif  // WRP_CTE_COMPRESSOR_DECISION_CACHE_H_
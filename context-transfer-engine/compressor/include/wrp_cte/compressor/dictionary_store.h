@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file dictionary_store.h
+ * @brief Per-tag zstd dictionaries for small blobs
+ *
+ * Tags that hold many small, similar blobs sample the first few of them.
+ * Once a batch is full a dictionary is trained from it, and later blobs
+ * of the tag are compressed with that dictionary. Dictionaries are kept
+ * by ID so blobs written with them can still be decompressed.
+ */
+
+#ifndef WRP_CTE_COMPRESSOR_DICTIONARY_STORE_H_
+#define WRP_CTE_COMPRESSOR_DICTIONARY_STORE_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace hshm {
+class ZstdDictionary;
+}  // namespace hshm
+
+namespace wrp_cte::compressor {
+
+/**
+ * @brief A batch of sample blobs to train a dictionary from
+ */
+struct DictionarySamples {
+  std::vector<char> data_;    // Samples, concatenated
+  std::vector<size_t> sizes_; // Size of each sample
+};
+
+/**
+ * @brief Thread-safe store of per-tag dictionaries and their samples
+ */
+class TagDictionaryStore {
+ public:
+  using DictPtr = std::shared_ptr<const hshm::ZstdDictionary>;
+
+  /**
+   * @brief Set when a sample batch is full
+   * @param train_samples Samples per batch (0 disables sampling)
+   * @param max_sample_bytes Bytes per batch
+   */
+  void Configure(size_t train_samples, size_t max_sample_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    train_samples_ = train_samples;
+    max_sample_bytes_ = max_sample_bytes;
+  }
+
+  /**
+   * @brief Get a tag's current dictionary
+   * @param tag Tag ID
+   * @return Dictionary, or nullptr if the tag has none yet
+   */
+  DictPtr Current(uint64_t tag) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tags_.find(tag);
+    return it == tags_.end() ? nullptr : it->second.current_;
+  }
+
+  /**
+   * @brief Look up a dictionary of a tag by ID
+   * @param tag Tag ID
+   * @param id Dictionary ID
+   * @return Dictionary, or nullptr if it is not loaded
+   */
+  DictPtr Find(uint64_t tag, uint32_t id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tags_.find(tag);
+    if (it == tags_.end()) {
+      return nullptr;
+    }
+    auto dict_it = it->second.by_id_.find(id);
+    return dict_it == it->second.by_id_.end() ? nullptr : dict_it->second;
+  }
+
+  /**
+   * @brief Record a sample blob of a tag that is still sampling
+   *
+   * When the batch fills up it is moved into batch and the tag stops
+   * sampling, so exactly one caller trains it. That caller must then
+   * call Publish or Fail.
+   *
+   * @param tag Tag ID
+   * @param data Blob data
+   * @param size Blob size
+   * @param batch Receives the full batch
+   * @return true if batch holds a full batch to train on
+   */
+  bool AddSample(uint64_t tag, const char* data, size_t size,
+                 DictionarySamples& batch) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (train_samples_ == 0) {
+      return false;
+    }
+    TagState& state = tags_[tag];
+    if (state.phase_ != Phase::kSampling) {
+      return false;
+    }
+    state.samples_.data_.insert(state.samples_.data_.end(), data, data + size);
+    state.samples_.sizes_.push_back(size);
+    if (state.samples_.sizes_.size() < train_samples_ &&
+        state.samples_.data_.size() < max_sample_bytes_) {
+      return false;
+    }
+    batch = std::move(state.samples_);
+    state.samples_ = DictionarySamples();
+    state.phase_ = Phase::kTraining;
+    return true;
+  }
+
+  /**
+   * @brief Make a trained dictionary the tag's current one
+   * @param tag Tag ID
+   * @param id Dictionary ID
+   * @param dict Dictionary
+   */
+  void Publish(uint64_t tag, uint32_t id, DictPtr dict) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TagState& state = tags_[tag];
+    state.phase_ = Phase::kReady;
+    state.current_ = dict;
+    state.by_id_[id] = std::move(dict);
+  }
+
+  /**
+   * @brief Record that training failed; the tag stops sampling
+   * @param tag Tag ID
+   */
+  void Fail(uint64_t tag) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tags_[tag].phase_ = Phase::kFailed;
+  }
+
+  /**
+   * @brief Keep a dictionary loaded to decompress an existing blob
+   * @param tag Tag ID
+   * @param id Dictionary ID
+   * @param dict Dictionary
+   */
+  void Insert(uint64_t tag, uint32_t id, DictPtr dict) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tags_[tag].by_id_[id] = std::move(dict);
+  }
+
+ private:
+  enum class Phase { kSampling, kTraining, kReady, kFailed };
+
+  struct TagState {
+    Phase phase_ = Phase::kSampling;
+    DictionarySamples samples_;
+    DictPtr current_;
+    std::unordered_map<uint32_t, DictPtr> by_id_;
+  };
+
+  mutable std::mutex mutex_;
+  size_t train_samples_ = 0;
+  size_t max_sample_bytes_ = 0;
+  std::unordered_map<uint64_t, TagState> tags_;
+};
+
+}  // namespace wrp_cte::compressor
+
+#endif  // WRP_CTE_COMPRESSOR_DICTIONARY_STORE_H_
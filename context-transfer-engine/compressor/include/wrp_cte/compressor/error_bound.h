@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file error_bound.h
+ * @brief Per-tag error bounds for lossy compression of float data
+ *
+ * A tag may declare how much error its float blobs tolerate. The
+ * compressor then tries the lossy codecs on a sample of each blob, keeps
+ * the one with the best ratio whose reconstruction stays within the
+ * bound, and spot-checks sampled blocks of the stored result.
+ */
+
+#ifndef WRP_CTE_COMPRESSOR_ERROR_BOUND_H_
+#define WRP_CTE_COMPRESSOR_ERROR_BOUND_H_
+
+#include <chimaera/chimaera.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "hermes_shm/compress/data_stats.h"
+
+namespace wrp_cte::compressor {
+
+/**
+ * @brief How the error bound of a tag is measured
+ */
+enum class ErrorBoundMode : chi::u32 {
+  kNone = 0,      // No bound: the tag is compressed losslessly
+  kAbsolute = 1,  // Max |original - reconstructed| <= bound_
+  kRelative = 2,  // Max error <= bound_ * value range of the blob
+  kPsnr = 3,      // PSNR of every checked block >= bound_ dB
+};
+
+/**
+ * @brief Error bound of a tag, chosen when the tag is created
+ */
+struct TagErrorBound {
+  ErrorBoundMode mode_;
+  double bound_;
+  chi::u32 verify_blocks_;  // Blocks spot-checked per blob (0 = no check)
+
+  TagErrorBound()
+      : mode_(ErrorBoundMode::kNone), bound_(0.0), verify_blocks_(4) {}
+
+  TagErrorBound(ErrorBoundMode mode, double bound, chi::u32 verify_blocks = 4)
+      : mode_(mode), bound_(bound), verify_blocks_(verify_blocks) {}
+
+  /** @return true if the tag's float blobs may be compressed lossily */
+  bool IsSet() const { return mode_ != ErrorBoundMode::kNone && bound_ > 0; }
+
+  template <class Archive>
+  void serialize(Archive &ar) {
+    ar(mode_, bound_, verify_blocks_);
+  }
+};
+
+/**
+ * @brief Measures reconstructions of float blocks against a bound
+ */
+class ErrorBoundChecker {
+ public:
+  /** Floats per spot-checked block (64KB) */
+  static constexpr size_t kBlockFloats = 16384;
+
+  /**
+   * @brief Value range of a float array
+   * @param data Values
+   * @param count Number of values
+   * @return max - min (0 for an empty array)
+   */
+  static double ValueRange(const float *data, size_t count) {
+    if (count == 0) {
+      return 0.0;
+    }
+    auto [lo, hi] = std::minmax_element(data, data + count);
+    return static_cast<double>(*hi) - static_cast<double>(*lo);
+  }
+
+  /**
+   * @brief Check one block of a reconstruction
+   * @param bound Error bound of the tag
+   * @param original Original values
+   * @param reconstructed Reconstructed values
+   * @param count Number of values
+   * @param value_range Value range of the whole blob (kRelative)
+   * @param psnr Output: PSNR of the block (0 = exact)
+   * @return true if the block is within the bound
+   */
+  static bool CheckBlock(const TagErrorBound &bound, const float *original,
+                         const float *reconstructed, size_t count,
+                         double value_range, double &psnr) {
+    psnr = hshm::DataStatistics<float>::CalculatePSNR(original, reconstructed,
+                                                      count);
+    switch (bound.mode_) {
+      case ErrorBoundMode::kAbsolute:
+        return MaxError(original, reconstructed, count) <= bound.bound_;
+      case ErrorBoundMode::kRelative:
+        return MaxError(original, reconstructed, count) <=
+               bound.bound_ * value_range;
+      case ErrorBoundMode::kPsnr:
+        // CalculatePSNR also reports 0 for a reconstruction worse than 0 dB
+        if (psnr == 0.0) {
+          return hshm::DataStatistics<float>::CalculateMSE(
+                     original, reconstructed, count) < 1e-10;
+        }
+        return psnr >= bound.bound_;
+      case ErrorBoundMode::kNone:
+      default:
+        return MaxError(original, reconstructed, count) == 0.0;
+    }
+  }
+
+  /**
+   * @brief Pick blocks to spot-check, spread evenly over the blob
+   * @param count Number of floats in the blob
+   * @param num_blocks Blocks wanted
+   * @return (first float, float count) of each block, in order
+   */
+  static std::vector<std::pair<size_t, size_t>> SampleBlocks(
+      size_t count, size_t num_blocks) {
+    std::vector<std::pair<size_t, size_t>> blocks;
+    size_t total = (count + kBlockFloats - 1) / kBlockFloats;
+    num_blocks = std::min(num_blocks, total);
+    for (size_t i = 0; i < num_blocks; ++i) {
+      // The first and last blocks are always checked
+      size_t block = num_blocks == 1 ? 0 : i * (total - 1) / (num_blocks - 1);
+      size_t begin = block * kBlockFloats;
+      blocks.emplace_back(begin, std::min(kBlockFloats, count - begin));
+    }
+    return blocks;
+  }
+
+  /**
+   * @brief Check the sampled blocks of a reconstruction
+   * @param bound Error bound of the tag
+   * @param original Original values
+   * @param reconstructed Reconstructed values (same length)
+   * @param count Number of values
+   * @param value_range Value range of the whole blob
+   * @param min_psnr Output: lowest block PSNR (0 if all blocks are exact)
+   * @return true if every sampled block is within the bound
+   */
+  static bool Check(const TagErrorBound &bound, const float *original,
+                    const float *reconstructed, size_t count,
+                    double value_range, double &min_psnr) {
+    min_psnr = 0.0;
+    size_t num_blocks = std::max<size_t>(bound.verify_blocks_, 1);
+    for (const auto &[begin, len] : SampleBlocks(count, num_blocks)) {
+      double psnr = 0.0;
+      if (!CheckBlock(bound, original + begin, reconstructed + begin, len,
+                      value_range, psnr)) {
+        min_psnr = psnr;
+        return false;
+      }
+      if (psnr > 0.0 && (min_psnr == 0.0 || psnr < min_psnr)) {
+        min_psnr = psnr;
+      }
+    }
+    return true;
+  }
+
+ private:
+  /** Largest absolute difference; infinity if a value became non-finite */
+  static double MaxError(const float *original, const float *reconstructed,
+                         size_t count) {
+    double max_error = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+      if (original[i] == reconstructed[i] ||
+          (std::isnan(original[i]) && std::isnan(reconstructed[i]))) {
+        continue;
+      }
+      double diff = std::abs(static_cast<double>(original[i]) -
+                             static_cast<double>(reconstructed[i]));
+      // A NaN or infinity that was not in the input fails any bound
+      if (!std::isfinite(diff)) {
+        return std::numeric_limits<double>::infinity();
+      }
+      max_error = std::max(max_error, diff);
+    }
+    return max_error;
+  }
+};
+
+}  // namespace wrp_cte::compressor
+
+#endif  // WRP_CTE_COMPRESSOR_ERROR_BOUND_H_
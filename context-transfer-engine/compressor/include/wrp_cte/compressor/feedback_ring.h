@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file feedback_ring.h
+ * @brief Bounded ring of observed compression outcomes
+ *
+ * Compress pushes what it actually achieved for the library and preset it
+ * ran; RefitModels drains the ring and folds the outcomes into the
+ * predictors. When the refit falls behind, the oldest outcomes are dropped.
+ */
+
+#ifndef WRP_CTE_COMPRESSOR_FEEDBACK_RING_H_
+#define WRP_CTE_COMPRESSOR_FEEDBACK_RING_H_
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "wrp_cte/compressor/models/compression_features.h"
+
+namespace wrp_cte::compressor {
+
+/**
+ * @brief Thread-safe ring of RLExperience records
+ */
+class CompressionFeedbackRing {
+ public:
+  /**
+   * @brief Constructor
+   * @param capacity Maximum records held (0 disables the ring)
+   */
+  explicit CompressionFeedbackRing(size_t capacity = 0) {
+    SetCapacity(capacity);
+  }
+
+  /**
+   * @brief Change the capacity, discarding held records
+   * @param capacity Maximum records held (0 disables the ring)
+   */
+  void SetCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ring_.clear();
+    ring_.resize(capacity);
+    head_ = 0;
+    size_ = 0;
+  }
+
+  /** @return true if the ring can hold records */
+  bool Enabled() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !ring_.empty();
+  }
+
+  /**
+   * @brief Append a record, overwriting the oldest one when full
+   * @param experience Observed outcome
+   */
+  void Push(const RLExperience& experience) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ring_.empty()) {
+      return;
+    }
+    ring_[(head_ + size_) % ring_.size()] = experience;
+    if (size_ < ring_.size()) {
+      ++size_;
+    } else {
+      head_ = (head_ + 1) % ring_.size();
+      ++dropped_;
+    }
+  }
+
+  /**
+   * @brief Remove every held record
+   * @return Records, oldest first
+   */
+  std::vector<RLExperience> Drain() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<RLExperience> out;
+    out.reserve(size_);
+    for (size_t i = 0; i < size_; ++i) {
+      out.push_back(ring_[(head_ + i) % ring_.size()]);
+    }
+    head_ = 0;
+    size_ = 0;
+    return out;
+  }
+
+  /** @return Records currently held */
+  size_t Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_;
+  }
+
+  /** @return Records overwritten before they were drained */
+  size_t GetDropped() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<RLExperience> ring_;
+  size_t head_ = 0;  // Index of the oldest record
+  size_t size_ = 0;
+  size_t dropped_ = 0;
+};
+
+}  // namespace wrp_cte::compressor
+
+#endif  // WRP_CTE_COMPRESSOR_FEEDBACK_RING_H_
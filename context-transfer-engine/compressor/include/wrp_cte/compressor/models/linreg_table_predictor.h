@@ -45,6 +45,7 @@
 #define WRP_CTE_COMPRESSOR_MODELS_LINREG_TABLE_PREDICTOR_H_
 
 #include "compression_features.h"
+#include <deque>
 #include <map>
 #include <vector>
 #include <string>
@@ -386,6 +387,40 @@ class LinRegTablePredictor : public CompressionPredictor {
    */
   std::vector<std::string> GetDataTypes() const;
 
+  // ============================================================================
+  // Reinforcement Learning Methods
+  // ============================================================================
+
+  /**
+   * @brief Record an observed outcome for the next refit
+   * @param experience Features, prediction, and actual result
+   */
+  void RecordExperience(const RLExperience& experience) override;
+
+  /**
+   * @brief Refit the regressors of every key with enough recorded outcomes
+   *
+   * Each key's outcomes are fit with OLS and blended into the existing
+   * coefficients with weight config.learning_rate. Keys with fewer than
+   * min_samples outcomes stay buffered for a later refit.
+   *
+   * @param config RL configuration (batch_size, learning_rate,
+   *               replay_buffer_size)
+   * @return true if any regressor changed
+   */
+  bool UpdateFromExperiences(const RLConfig& config = RLConfig()) override;
+
+  /**
+   * @brief Get number of buffered outcomes
+   * @return Outcomes not yet folded into the table
+   */
+  size_t GetExperienceCount() const override;
+
+  /**
+   * @brief Discard buffered outcomes
+   */
+  void ClearExperiences() override;
+
  private:
   /**
    * @brief Fit a single linear regression model using OLS
@@ -415,11 +450,33 @@ class LinRegTablePredictor : public CompressionPredictor {
    */
   std::string GetDataTypeFromFeatures(const CompressionFeatures& features) const;
 
+  /**
+   * @brief PredictByKey body; the caller holds mutex_
+   * @param key Table key
+   * @param data_size Data size in bytes
+   * @return Prediction result
+   */
+  CompressionPrediction PredictByKeyLocked(const LinRegTableKey& key,
+                                           double data_size) const;
+
+  /**
+   * @brief Blend one OLS fit into an existing regressor
+   * @param x Data sizes
+   * @param y Observed values of the target metric
+   * @param rate Weight of the new fit in [0, 1]
+   * @param slope In/out slope coefficient
+   * @param intercept In/out intercept coefficient
+   * @param r2 Output R² score of the new fit
+   */
+  void BlendFit(const std::vector<double>& x, const std::vector<double>& y,
+                double rate, double& slope, double& intercept, double& r2);
+
   LinRegTableConfig config_;                        /**< Predictor configuration */
   std::map<LinRegTableKey, LinearRegressionCoeffs> table_; /**< Main lookup table */
   bool ready_;                                      /**< Whether model is ready */
   mutable std::mutex mutex_;                        /**< Mutex for thread safety */
   std::map<int, std::pair<std::string, std::string>> id_to_lib_config_; /**< ID decoder */
+  std::deque<RLExperience> experience_buffer_;      /**< Outcomes awaiting a refit */
 };
 
 }  // namespace wrp_cte::compressor
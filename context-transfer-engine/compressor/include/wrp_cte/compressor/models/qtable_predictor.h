@@ -44,6 +44,7 @@
 #define WRP_CTE_COMPRESSOR_MODELS_QTABLE_PREDICTOR_H_
 
 #include "compression_features.h"
+#include <deque>
 #include <map>
 #include <vector>
 #include <string>
@@ -239,6 +240,39 @@ class QTablePredictor : public CompressionPredictor {
    */
   size_t GetUnknownCount() const { return unknown_count_; }
 
+  // ============================================================================
+  // Reinforcement Learning Methods
+  // ============================================================================
+
+  /**
+   * @brief Record an observed outcome for the next update
+   * @param experience Features, prediction, and actual result
+   */
+  void RecordExperience(const RLExperience& experience) override;
+
+  /**
+   * @brief Move each visited state's Q-value toward the observed outcomes
+   *
+   * Known states take an exponential moving average step of
+   * config.learning_rate; unseen states are added with the outcome itself.
+   * The binning edges are kept, so the table must already be trained.
+   *
+   * @param config RL configuration (batch_size, learning_rate)
+   * @return true if the table was updated
+   */
+  bool UpdateFromExperiences(const RLConfig& config = RLConfig()) override;
+
+  /**
+   * @brief Get number of buffered outcomes
+   * @return Outcomes not yet folded into the table
+   */
+  size_t GetExperienceCount() const override;
+
+  /**
+   * @brief Discard buffered outcomes
+   */
+  void ClearExperiences() override;
+
  private:
   /**
    * @brief Discretize features to create a state
@@ -283,6 +317,7 @@ class QTablePredictor : public CompressionPredictor {
   bool table_ready_;                       /**< Whether table is ready */
   mutable size_t unknown_count_;           /**< Count of unknown states */
   mutable std::mutex mutex_;               /**< Mutex for thread safety */
+  std::deque<RLExperience> experience_buffer_; /**< Outcomes awaiting an update */
 };
 
 }  // namespace wrp_cte::compressor
@@ -1,7 +1,7 @@
 /**
  * Auto-generated execution implementation for compressor ChiMod
- * Implements Container virtual APIs (Run, SaveTask, LoadTask, NewCopyTask, NewTask)
- * using switch-case dispatch
+ * Implements Container virtual APIs (Run, SaveTask, LoadTask, NewCopyTask, NewTask).
+ * Run uses switch-case dispatch; the others index the kMethodExec table.
  * 
  * This file is autogenerated - do not edit manually.
  * Changes should be made to the autogen tool or the YAML configuration.
@@ -11,9 +11,33 @@
 #include "wrp_cte/compressor/autogen/compressor_methods.h"
 #include <chimaera/chimaera.h>
 #include <chimaera/task.h>  // For TaskResume coroutine return type
+#include <chimaera/method_exec.h>
 
 namespace wrp_cte::compressor {
 
+namespace {
+
+/** Per-method dispatch table indexed by method ID */
+constexpr chi::MethodExec kMethodExec[15] = {
+    chi::MakeMethodExec<CreateTask>(),  // 0: Create
+    chi::MakeMethodExec<DestroyTask>(),  // 1: Destroy
+    {},  // 2
+    {},  // 3
+    {},  // 4
+    {},  // 5
+    {},  // 6
+    {},  // 7
+    {},  // 8
+    chi::MakeMethodExec<MonitorTask>(),  // 9: Monitor
+    chi::MakeMethodExec<DynamicScheduleTask>(),  // 10: DynamicSchedule
+    chi::MakeMethodExec<CompressTask>(),  // 11: Compress
+    chi::MakeMethodExec<DecompressTask>(),  // 12: Decompress
+    chi::MakeMethodExec<RefitModelsTask>(),  // 13: RefitModels
+    chi::MakeMethodExec<SetTagErrorBoundTask>(),  // 14: SetTagErrorBound
+};
+
+}  // namespace
+
 //==============================================================================
 // Container Virtual API Implementations
 //==============================================================================
@@ -29,6 +53,7 @@ void Runtime::Init(const chi::PoolId &pool_id, const std::string &pool_name,
   // Initialize per-method load prediction model
   DefineModel(Method::kMaxMethodId);
   SetMethodNames(Method::GetMethodNames());
+  SetMethodTraits(Method::kMethodTraits);
 }
 
 chi::TaskResume Runtime::Run(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr, chi::RunContext& rctx) {
@@ -70,6 +95,18 @@ chi::TaskResume Runtime::Run(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr,
       CHI_CO_AWAIT(Decompress(typed_task, rctx));
       break;
     }
+    case Method::kRefitModels: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<RefitModelsTask> typed_task = task_ptr.template Cast<RefitModelsTask>();
+      CHI_CO_AWAIT(RefitModels(typed_task, rctx));
+      break;
+    }
+    case Method::kSetTagErrorBound: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<SetTagErrorBoundTask> typed_task = task_ptr.template Cast<SetTagErrorBoundTask>();
+      CHI_CO_AWAIT(SetTagErrorBound(typed_task, rctx));
+      break;
+    }
     default: {
       // Unknown method - do nothing
       break;
@@ -81,81 +118,17 @@ chi::TaskResume Runtime::Run(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr,
 
 void Runtime::SaveTask(chi::u32 method, chi::SaveTaskArchive& archive, 
                         hipc::FullPtr<chi::Task> task_ptr) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = task_ptr.template Cast<CreateTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = task_ptr.template Cast<DestroyTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = task_ptr.template Cast<MonitorTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kDynamicSchedule: {
-      auto typed_task = task_ptr.template Cast<DynamicScheduleTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kCompress: {
-      auto typed_task = task_ptr.template Cast<CompressTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kDecompress: {
-      auto typed_task = task_ptr.template Cast<DecompressTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    default: {
-      // Unknown method - do nothing
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->save_(archive, task_ptr);
   }
 }
 
 void Runtime::LoadTask(chi::u32 method, chi::LoadTaskArchive& archive,
                         hipc::FullPtr<chi::Task> task_ptr) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = task_ptr.template Cast<CreateTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = task_ptr.template Cast<DestroyTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = task_ptr.template Cast<MonitorTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kDynamicSchedule: {
-      auto typed_task = task_ptr.template Cast<DynamicScheduleTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kCompress: {
-      auto typed_task = task_ptr.template Cast<CompressTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kDecompress: {
-      auto typed_task = task_ptr.template Cast<DecompressTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    default: {
-      // Unknown method - do nothing
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->load_(archive, task_ptr);
   }
 }
 
@@ -169,47 +142,9 @@ hipc::FullPtr<chi::Task> Runtime::AllocLoadTask(chi::u32 method, chi::LoadTaskAr
 
 void Runtime::LocalLoadTask(chi::u32 method, chi::DefaultLoadArchive& archive,
                             hipc::FullPtr<chi::Task> task_ptr) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = task_ptr.template Cast<CreateTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = task_ptr.template Cast<DestroyTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = task_ptr.template Cast<MonitorTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kDynamicSchedule: {
-      auto typed_task = task_ptr.template Cast<DynamicScheduleTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kCompress: {
-      auto typed_task = task_ptr.template Cast<CompressTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kDecompress: {
-      auto typed_task = task_ptr.template Cast<DecompressTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    default: {
-      // Unknown method - do nothing
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->local_load_(archive, task_ptr);
   }
 }
 
@@ -223,249 +158,58 @@ hipc::FullPtr<chi::Task> Runtime::LocalAllocLoadTask(chi::u32 method, chi::Defau
 
 void Runtime::LocalSaveTask(chi::u32 method, chi::DefaultSaveArchive& archive, 
                              hipc::FullPtr<chi::Task> task_ptr) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = task_ptr.template Cast<CreateTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = task_ptr.template Cast<DestroyTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = task_ptr.template Cast<MonitorTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kDynamicSchedule: {
-      auto typed_task = task_ptr.template Cast<DynamicScheduleTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kCompress: {
-      auto typed_task = task_ptr.template Cast<CompressTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kDecompress: {
-      auto typed_task = task_ptr.template Cast<DecompressTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    default: {
-      // Unknown method - do nothing
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->local_save_(archive, task_ptr);
   }
 }
 
 hipc::FullPtr<chi::Task> Runtime::NewCopyTask(chi::u32 method, hipc::FullPtr<chi::Task> orig_task_ptr, bool deep) {
+  (void)deep;    // Deep copy parameter reserved for future use
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    return exec->new_copy_(orig_task_ptr);
+  }
+  // For unknown methods, create base Task copy
   auto* ipc_manager = CHI_IPC;
   if (!ipc_manager) {
     return hipc::FullPtr<chi::Task>();
   }
-  
-  switch (method) {
-    case Method::kCreate: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<CreateTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<CreateTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kDestroy: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<DestroyTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<DestroyTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kMonitor: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<MonitorTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<MonitorTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kDynamicSchedule: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<DynamicScheduleTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<DynamicScheduleTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kCompress: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<CompressTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<CompressTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kDecompress: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<DecompressTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<DecompressTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    default: {
-      // For unknown methods, create base Task copy
-      auto new_task_ptr = ipc_manager->NewTask<chi::Task>();
-      if (!new_task_ptr.IsNull()) {
-        new_task_ptr->Copy(orig_task_ptr);
-        return new_task_ptr;
-      }
-      break;
-    }
+  auto new_task_ptr = ipc_manager->NewTask<chi::Task>();
+  if (!new_task_ptr.IsNull()) {
+    new_task_ptr->Copy(orig_task_ptr);
   }
-  
-  (void)deep;    // Deep copy parameter reserved for future use
-  return hipc::FullPtr<chi::Task>();
+  return new_task_ptr;
 }
 
 hipc::FullPtr<chi::Task> Runtime::NewTask(chi::u32 method) {
-  auto* ipc_manager = CHI_IPC;
-  if (!ipc_manager) {
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec == nullptr) {
+    // For unknown methods, return null pointer
     return hipc::FullPtr<chi::Task>();
   }
-  
-  switch (method) {
-    case Method::kCreate: {
-      auto new_task_ptr = ipc_manager->NewTask<CreateTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kDestroy: {
-      auto new_task_ptr = ipc_manager->NewTask<DestroyTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kMonitor: {
-      auto new_task_ptr = ipc_manager->NewTask<MonitorTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kDynamicSchedule: {
-      auto new_task_ptr = ipc_manager->NewTask<DynamicScheduleTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kCompress: {
-      auto new_task_ptr = ipc_manager->NewTask<CompressTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kDecompress: {
-      auto new_task_ptr = ipc_manager->NewTask<DecompressTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    default: {
-      // For unknown methods, return null pointer
-      return hipc::FullPtr<chi::Task>();
-    }
-  }
+  return exec->new_task_();
 }
 
 void Runtime::Aggregate(chi::u32 method, hipc::FullPtr<chi::Task> orig_task,
                         const hipc::FullPtr<chi::Task>& replica_task) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = orig_task.template Cast<CreateTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = orig_task.template Cast<DestroyTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = orig_task.template Cast<MonitorTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kDynamicSchedule: {
-      auto typed_task = orig_task.template Cast<DynamicScheduleTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kCompress: {
-      auto typed_task = orig_task.template Cast<CompressTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kDecompress: {
-      auto typed_task = orig_task.template Cast<DecompressTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    default: {
-      orig_task->Aggregate(replica_task);
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->aggregate_(orig_task, replica_task);
+  } else {
+    orig_task->Aggregate(replica_task);
   }
 }
 
 void Runtime::DelTask(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr) {
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->del_(task_ptr);
+    return;
+  }
   auto* ipc_manager = CHI_IPC;
   if (!ipc_manager) return;
-  switch (method) {
-    case Method::kCreate: {
-      ipc_manager->DelTask(task_ptr.template Cast<CreateTask>());
-      break;
-    }
-    case Method::kDestroy: {
-      ipc_manager->DelTask(task_ptr.template Cast<DestroyTask>());
-      break;
-    }
-    case Method::kMonitor: {
-      ipc_manager->DelTask(task_ptr.template Cast<MonitorTask>());
-      break;
-    }
-    case Method::kDynamicSchedule: {
-      ipc_manager->DelTask(task_ptr.template Cast<DynamicScheduleTask>());
-      break;
-    }
-    case Method::kCompress: {
-      ipc_manager->DelTask(task_ptr.template Cast<CompressTask>());
-      break;
-    }
-    case Method::kDecompress: {
-      ipc_manager->DelTask(task_ptr.template Cast<DecompressTask>());
-      break;
-    }
-    default: {
-      ipc_manager->DelTask(task_ptr);
-      break;
-    }
-  }
+  ipc_manager->DelTask(task_ptr);
 }
 
 } // namespace wrp_cte::compressor
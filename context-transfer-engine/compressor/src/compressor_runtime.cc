@@ -45,11 +45,13 @@
 #include <sstream>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "chimaera/worker.h"
 #include "hermes_shm/compress/compress_factory.h"
 #include "hermes_shm/compress/data_stats.h"
+#include "hermes_shm/util/gpu_api.h"
 #include "hermes_shm/util/logging.h"
 
 namespace wrp_cte::compressor {
@@ -64,28 +66,158 @@ using chi::Worker;
  */
 struct CompressionHeader {
   static constexpr uint32_t kMagic = 0x43544543;  // "CTEC" in ASCII
+  static constexpr uint32_t kDictMagic = 0x44455443;  // "CTED": uses dict_id_
   uint32_t magic_;            // Magic number to identify compressed data
   uint32_t compress_lib_;     // Compression library ID
   uint32_t compress_preset_;  // Compression preset
+  uint32_t dict_id_;          // Tag dictionary ID (kDictMagic only)
   uint64_t original_size_;    // Original uncompressed size
 
   CompressionHeader()
       : magic_(kMagic),
         compress_lib_(0),
         compress_preset_(0),
+        dict_id_(0),
         original_size_(0) {}
 
-  CompressionHeader(uint32_t lib, uint32_t preset, uint64_t orig_size)
-      : magic_(kMagic),
+  CompressionHeader(uint32_t lib, uint32_t preset, uint64_t orig_size,
+                    uint32_t dict_id = 0)
+      : magic_(dict_id != 0 ? kDictMagic : kMagic),
         compress_lib_(lib),
         compress_preset_(preset),
+        dict_id_(dict_id),
         original_size_(orig_size) {}
 
-  bool IsValid() const { return magic_ == kMagic; }
+  bool IsValid() const { return magic_ == kMagic || magic_ == kDictMagic; }
+
+  /** Blobs written before dict_id_ existed left it as padding */
+  bool HasDictionary() const { return magic_ == kDictMagic; }
 };
 static_assert(sizeof(CompressionHeader) == 24,
               "CompressionHeader must be 24 bytes");
 
+/** Library names by Context::compress_lib_ ID */
+static const char* const kLibNames[] = {
+    "brotli", "bzip2",      "blosc2",          "fpzip",         "lz4",
+    "lzma",   "snappy",     "sz3",             "zfp",           "zlib",
+    "zstd",   "nvcomp_lz4", "nvcomp_cascaded", "nvcomp_bitcomp"};
+static constexpr int kNumLibs = sizeof(kLibNames) / sizeof(kLibNames[0]);
+
+/** IDs of the nvCOMP GPU libraries */
+static constexpr int kNvcompLz4 = 11;
+static constexpr int kNvcompCascaded = 12;
+static constexpr int kNvcompBitcomp = 13;
+
+/** ID of zstd, the library tag dictionaries are trained for */
+static constexpr int kZstd = 10;
+
+/** Prefix of the blob a tag dictionary is stored in, followed by its ID */
+static const char* const kDictBlobPrefix = "__cte_zstd_dict_";
+
+/**
+ * Check whether a library ID compresses on the GPU
+ * @param compress_lib Library ID
+ * @return true for the nvCOMP libraries
+ */
+static bool IsGpuLibrary(int compress_lib) {
+  return compress_lib >= kNvcompLz4 && compress_lib < kNumLibs;
+}
+
+/** IDs of the lossy libraries */
+static constexpr int kFpzip = 3;
+static constexpr int kSz3 = 7;
+static constexpr int kZfp = 8;
+
+/** Floats of a blob the lossy codecs are trialed on */
+static constexpr size_t kLossySampleFloats = 64 * 1024;
+
+/** Blobs of an incompressible tag bypassed between entropy re-checks */
+static constexpr chi::u32 kIncompressibleRecheck = 64;
+
+/**
+ * Check whether a library ID is lossy
+ * @param compress_lib Library ID
+ * @return true for fpzip, sz3 and zfp
+ */
+static bool IsLossyLibrary(int compress_lib) {
+  return compress_lib == kFpzip || compress_lib == kSz3 ||
+         compress_lib == kZfp;
+}
+
+/**
+ * Check whether a buffer lives in device memory (HBM)
+ * @param ptr Buffer
+ * @return true if the GPU codecs can work on it in place
+ */
+static bool IsDeviceResident(const void* ptr) {
+#if HSHM_ENABLE_NVCOMP
+  return hshm::GpuApi::IsDevicePointer(ptr);
+#else
+  (void)ptr;
+  return false;
+#endif
+}
+
+/**
+ * Map a library ID and preset integer to the factory's name and preset
+ * @param compress_lib Library ID (0-13; anything else maps to zstd)
+ * @param compress_preset 1=FAST, 2=BALANCED, 3=BEST
+ * @return Library name and preset
+ */
+static std::pair<std::string, hshm::CompressionPreset> LibraryPreset(
+    int compress_lib, int compress_preset) {
+  std::string library_name = (compress_lib >= 0 && compress_lib < kNumLibs)
+                                 ? kLibNames[compress_lib]
+                                 : "zstd";
+  hshm::CompressionPreset preset = hshm::CompressionPreset::BALANCED;
+  if (compress_preset == 1) {
+    preset = hshm::CompressionPreset::FAST;
+  } else if (compress_preset == 3) {
+    preset = hshm::CompressionPreset::BEST;
+  }
+  return {library_name, preset};
+}
+
+/**
+ * Create the compressor for a library ID and preset integer
+ * @param compress_lib Library ID (0-13; anything else maps to zstd)
+ * @param compress_preset 1=FAST, 2=BALANCED, 3=BEST
+ * @return Compressor, or nullptr if the library is unavailable
+ */
+static std::unique_ptr<hshm::Compressor> MakeCompressor(int compress_lib,
+                                                        int compress_preset) {
+  auto [library_name, preset] = LibraryPreset(compress_lib, compress_preset);
+  return hshm::CompressionFactory::GetPreset(library_name, preset);
+}
+
+/**
+ * Map a preset integer to the lossless mode of the same level
+ * @param compress_preset 1=FAST, 2=BALANCED, 3=BEST
+ * @return Lossless mode
+ */
+static hshm::LosslessMode LosslessModeFor(int compress_preset) {
+  if (compress_preset == 1) {
+    return hshm::LosslessMode::FAST;
+  }
+  if (compress_preset == 3) {
+    return hshm::LosslessMode::BEST;
+  }
+  return hshm::LosslessMode::BALANCED;
+}
+
+/**
+ * Get this worker thread's cached compressor, whose library contexts are
+ * reused across blobs. Only for one-shot calls that finish before a yield.
+ * @param compress_lib Library ID (0-13; anything else maps to zstd)
+ * @param compress_preset 1=FAST, 2=BALANCED, 3=BEST
+ * @return Thread-owned compressor, or nullptr if the library is unavailable
+ */
+static hshm::Compressor* ThreadCompressor(int compress_lib,
+                                          int compress_preset) {
+  auto [library_name, preset] = LibraryPreset(compress_lib, compress_preset);
+  return hshm::CompressionFactory::GetThreadLocal(library_name, preset);
+}
+
 chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
                                 chi::RunContext& ctx) {
   // Load configuration from compose YAML (or direct CreateParams)
@@ -98,6 +230,12 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
 
   // Initialize atomic counters
   compression_logical_time_ = 0;
+  decision_cache_.SetCapacity(config_.decision_cache_size_);
+  chunk_index_cache_.SetCapacity(config_.chunk_index_cache_size_);
+  tag_dictionaries_.Configure(
+      config_.dict_max_blob_size_ > 0 ? config_.dict_train_samples_ : 0,
+      100 * config_.dict_size_);
+  feedback_ring_.SetCapacity(config_.feedback_buffer_size_);
 
   // Load Q-table model if configured (primary prediction method)
   if (!config_.qtable_model_path_.empty()) {
@@ -173,8 +311,18 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
     HLOG(kDebug,
          "No compression predictor configured, dynamic compression prediction "
          "disabled");
+  } else if (config_.feedback_buffer_size_ > 0 &&
+             config_.refit_period_ms_ > 0) {
+    // Spawn periodic RefitModels to learn from observed outcomes
+    client_.AsyncRefitModels(chi::PoolQuery::Local(),
+                             config_.refit_period_ms_ * 1000.0);
   }
 
+  // Export compression totals on the runtime's /metrics endpoint
+  auto *metrics = CHI_METRICS;
+  metrics->Register(MetricsKey(),
+                    [this](chi::MetricsWriter &w) { CollectMetrics(w); });
+
   HLOG(kDebug,
        "CTE Compressor container created and initialized for pool: {} (ID: {})",
        pool_name_, pool_id_);
@@ -182,9 +330,54 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
   CHI_CO_RETURN;
 }
 
+Runtime::~Runtime() {
+  auto *metrics = CHI_METRICS;
+  metrics->Unregister(MetricsKey());
+}
+
+std::string Runtime::MetricsKey() const {
+  return "wrp_cte_compressor/" + pool_id_.ToString();
+}
+
+void Runtime::CountCompression(chi::u64 input_size, chi::u64 stored_size) {
+  if (stored_size < input_size) {
+    metric_blobs_compressed_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    metric_blobs_raw_.fetch_add(1, std::memory_order_relaxed);
+  }
+  metric_input_bytes_.fetch_add(input_size, std::memory_order_relaxed);
+  metric_stored_bytes_.fetch_add(stored_size, std::memory_order_relaxed);
+}
+
+void Runtime::CollectMetrics(chi::MetricsWriter &w) {
+  std::string pool = pool_id_.ToString();
+  chi::u64 input = metric_input_bytes_.load(std::memory_order_relaxed);
+  chi::u64 stored = metric_stored_bytes_.load(std::memory_order_relaxed);
+  w.Family("cte_compress_blobs", chi::MetricType::kCounter,
+           "Blobs passed through Compress, by how they were stored");
+  w.Sample({{"pool", pool}, {"stored", "compressed"}},
+           metric_blobs_compressed_.load(std::memory_order_relaxed));
+  w.Sample({{"pool", pool}, {"stored", "raw"}},
+           metric_blobs_raw_.load(std::memory_order_relaxed));
+  w.Family("cte_compress_input_bytes", chi::MetricType::kCounter,
+           "Blob bytes given to Compress");
+  w.Sample({{"pool", pool}}, input);
+  w.Family("cte_compress_stored_bytes", chi::MetricType::kCounter,
+           "Bytes stored by Compress, headers included");
+  w.Sample({{"pool", pool}}, stored);
+  w.Family("cte_compress_ratio", chi::MetricType::kGauge,
+           "Input bytes over stored bytes since the container started");
+  w.Sample({{"pool", pool}},
+           stored ? static_cast<double>(input) / static_cast<double>(stored)
+                  : 1.0);
+}
+
 chi::TaskResume Runtime::Destroy(hipc::FullPtr<DestroyTask> task,
                                  chi::RunContext& ctx) {
   try {
+    auto *metrics = CHI_METRICS;
+    metrics->Unregister(MetricsKey());
+
     // Reset predictors
     qtable_predictor_.reset();
     linreg_predictor_.reset();
@@ -232,10 +425,21 @@ chi::TaskResume Runtime::Monitor(hipc::FullPtr<MonitorTask> task,
         stat_task.Wait();
         if (stat_task->GetReturnCode() == 0) {
           auto &state = target_states_[target_name];
+          if (state.target_score_ != stat_task->target_score_) {
+            // Cached decisions assumed the old tier bandwidth
+            decision_cache_.Clear();
+          }
           state.target_name_ = target_name;
           state.target_score_ = stat_task->target_score_;
           state.remaining_space_ = stat_task->remaining_space_;
           state.bytes_written_ = stat_task->bytes_written_;
+          double old_cost = state.perf_model_.write_.us_per_mb_;
+          double new_cost = stat_task->perf_model_.write_.us_per_mb_;
+          if (std::abs(new_cost - old_cost) > 0.1 * old_cost) {
+            // Cached decisions assumed a transfer time off by over 10%
+            decision_cache_.Clear();
+          }
+          state.perf_model_ = stat_task->perf_model_;
         }
       }
     }
@@ -264,10 +468,49 @@ chi::TaskResume Runtime::Monitor(hipc::FullPtr<MonitorTask> task,
 // Compression Statistics Estimation
 // ==============================================================================
 
-std::vector<CompressionStats> Runtime::EstCompressionStats(
-    const void* chunk, chi::u64 chunk_size, const Context& context) {
-  std::vector<CompressionStats> results;
+bool Runtime::IsIncompressible(const wrp_cte::core::TagId& tag_id,
+                               const void* data, chi::u64 size,
+                               const Context& context) {
+  if (config_.incompressible_entropy_ <= 0.0) {
+    return false;
+  }
+  // Float blobs of a tag with an error bound compress lossily regardless
+  if (context.data_type_ == 1 && GetTagErrorBound(tag_id).IsSet()) {
+    return false;
+  }
+  chi::u64 tag_key = tag_id.ToU64();
+  {
+    std::lock_guard<std::mutex> lock(incompressible_tags_mutex_);
+    auto it = incompressible_tags_.find(tag_key);
+    if (it != incompressible_tags_.end() &&
+        config_.incompressible_streak_ > 0 &&
+        it->second.streak_ >= config_.incompressible_streak_ &&
+        ++it->second.skipped_ % kIncompressibleRecheck != 0) {
+      return true;
+    }
+  }
 
+  constexpr size_t kSampleBlocks = 4;
+  size_t block_bytes = std::max<size_t>(
+      config_.entropy_sample_bytes_ / kSampleBlocks, 1);
+  double entropy = hshm::DataStatistics<uint8_t>::SampleByteEntropy(
+      data, static_cast<size_t>(size), kSampleBlocks, block_bytes);
+  bool incompressible = entropy >= config_.incompressible_entropy_;
+
+  std::lock_guard<std::mutex> lock(incompressible_tags_mutex_);
+  if (incompressible) {
+    IncompressibleTag& state = incompressible_tags_[tag_key];
+    state.streak_ = std::min(state.streak_ + 1,
+                             std::max<chi::u32>(config_.incompressible_streak_,
+                                                1));
+  } else {
+    incompressible_tags_.erase(tag_key);
+  }
+  return incompressible;
+}
+
+hshm::CompressionFeatureSet Runtime::SampleChunkFeatures(
+    const void* chunk, chi::u64 chunk_size, const Context& context) {
   // Determine data type from context
   // context.data_type_: 0 = char/uint8, 1 = float
   hshm::DataType data_type = (context.data_type_ == 1) ? hshm::DataType::FLOAT32
@@ -281,23 +524,94 @@ std::vector<CompressionStats> Runtime::EstCompressionStats(
     num_elements = 1;
   }
 
-  // Calculate compression features using DataStatisticsFactory
-  double entropy = hshm::DataStatisticsFactory::CalculateShannonEntropy(
-      chunk, num_elements, data_type);
-  double mad =
-      hshm::DataStatisticsFactory::CalculateMAD(chunk, num_elements, data_type);
-  double second_derivative_mean =
-      hshm::DataStatisticsFactory::CalculateSecondDerivative(
-          chunk, num_elements, data_type);
+#if HSHM_ENABLE_NVCOMP
+  // Only the sample of a device-resident chunk is copied to the host
+  std::vector<char> host_sample;
+  if (IsDeviceResident(chunk)) {
+    host_sample.resize(std::max<size_t>(sample_bytes, type_size));
+    hshm::GpuApi::Memcpy(host_sample.data(), static_cast<const char*>(chunk),
+                         static_cast<size_t>(sample_bytes));
+    chunk = host_sample.data();
+  }
+#endif
+
+  // Calculate compression features in one read of the sample
+  return hshm::DataStatisticsFactory::CalculateAllFeatures(chunk, num_elements,
+                                                           data_type);
+}
+
+/**
+ * Encode a candidate the way the predictors score it
+ * @param chunk_features Features from SampleChunkFeatures
+ * @param chunk_size Size of chunk in bytes
+ * @param lib_id Library ID (0-13)
+ * @param config_id Config ID: balanced=0, best=1, default=2, fast=3
+ * @param context Compression context (data type)
+ * @return Predictor input
+ */
+static CompressionFeatures ModelFeatures(
+    const hshm::CompressionFeatureSet& chunk_features, chi::u64 chunk_size,
+    int lib_id, int config_id, const Context& context) {
+  CompressionFeatures features;
+  features.library_config_id = static_cast<double>(lib_id);
+  features.chunk_size_bytes = static_cast<double>(chunk_size);
+  features.shannon_entropy = chunk_features.shannon_entropy;
+  features.mad = chunk_features.mad;
+  features.second_derivative_mean = chunk_features.second_derivative;
+  // Set config encoding
+  features.config_fast = (config_id == 3) ? 1 : 0;
+  features.config_balanced = (config_id == 0) ? 1 : 0;
+  features.config_best = (config_id == 1) ? 1 : 0;
+  // Set data type encoding
+  features.data_type_char = (context.data_type_ == 0) ? 1 : 0;
+  features.data_type_float = (context.data_type_ == 1) ? 1 : 0;
+  return features;
+}
+
+/**
+ * Map a library and config ID to the library_config_id the LinReg table
+ * is keyed by (base_id * 10 + preset_id, see LinRegTablePredictor)
+ * @param lib_id Library ID (0-13)
+ * @param config_id Config ID: balanced=0, best=1, default=2, fast=3
+ * @return Encoded ID, or -1 if the table has no such library
+ */
+static int LinRegConfigId(int lib_id, int config_id) {
+  // LinReg bases: BZIP2=1, ZSTD=2, LZ4=3, ZLIB=4, LZMA=5, BROTLI=6,
+  //               SNAPPY=7, Blosc2=8; presets: fast=0, balanced=1,
+  //               best=2, default=3
+  static const int kBaseIds[] = {6, 1, 8, -1, 3, 5, 7, -1, -1, 4, 2};
+  static const int kPresetIds[] = {1, 2, 3, 0};
+  constexpr int kNumBases = sizeof(kBaseIds) / sizeof(kBaseIds[0]);
+  if (lib_id < 0 || lib_id >= kNumBases || kBaseIds[lib_id] < 0 ||
+      config_id < 0 || config_id > 3) {
+    return -1;
+  }
+  return kBaseIds[lib_id] * 10 + kPresetIds[config_id];
+}
+
+std::vector<CompressionStats> Runtime::EstCompressionStats(
+    const hshm::CompressionFeatureSet& chunk_features, chi::u64 chunk_size,
+    const Context& context, bool on_device) {
+  std::vector<CompressionStats> results;
 
   // Determine candidate compression libraries and configs
   // Library IDs: BROTLI=0, BZIP2=1, Blosc2=2, FPZIP=3, LZ4=4, LZMA=5,
-  //              SNAPPY=6, SZ3=7, ZFP=8, ZLIB=9, ZSTD=10
+  //              SNAPPY=6, SZ3=7, ZFP=8, ZLIB=9, ZSTD=10,
+  //              NVCOMP_LZ4=11, NVCOMP_CASCADED=12, NVCOMP_BITCOMP=13
   // Config IDs: balanced=0, best=1, default=2, fast=3
   std::vector<std::pair<int, int>> candidate_lib_configs;
   if (context.dynamic_compress_ == 1) {
     // Static mode: use specified library with default config
     candidate_lib_configs.push_back({context.compress_lib_, 2});
+  } else if (on_device) {
+    // Data in HBM: GPU codecs compress it in place, so only compressed
+    // bytes cross PCIe. Bitcomp and Cascaded suit numeric arrays.
+    if (context.data_type_ == 1) {
+      candidate_lib_configs = {{kNvcompBitcomp, 2}, {kNvcompCascaded, 2},
+                               {kNvcompLz4, 2}};
+    } else {
+      candidate_lib_configs = {{kNvcompLz4, 2}, {kNvcompCascaded, 2}};
+    }
   } else {
     // Dynamic mode: test common library/config combinations
     candidate_lib_configs = {
@@ -309,50 +623,42 @@ std::vector<CompressionStats> Runtime::EstCompressionStats(
     };
   }
 
-  // Run predictions for each candidate library/config
+  // Score every candidate in one batch
+  std::vector<CompressionFeatures> batch;
+  batch.reserve(candidate_lib_configs.size());
   for (const auto& [lib_id, config_id] : candidate_lib_configs) {
-    CompressionPrediction pred;
+    batch.push_back(
+        ModelFeatures(chunk_features, chunk_size, lib_id, config_id, context));
+  }
 
-    // Use Q-table predictor if available (primary method)
-    if (qtable_predictor_ && qtable_predictor_->IsReady()) {
-      CompressionFeatures features;
-      features.library_config_id = static_cast<double>(lib_id);
-      features.chunk_size_bytes = static_cast<double>(chunk_size);
-      features.shannon_entropy = entropy;
-      features.mad = mad;
-      features.second_derivative_mean = second_derivative_mean;
-      // Set config encoding
-      features.config_fast = (config_id == 3) ? 1 : 0;
-      features.config_balanced = (config_id == 0) ? 1 : 0;
-      features.config_best = (config_id == 1) ? 1 : 0;
-      // Set data type encoding
-      features.data_type_char = (context.data_type_ == 0) ? 1 : 0;
-      features.data_type_float = (context.data_type_ == 1) ? 1 : 0;
-
-      pred = qtable_predictor_->Predict(features);
-    }
+  // Use Q-table predictor if available (primary method). The models are
+  // trained on the CPU codecs only, so GPU candidates use the heuristic.
+  std::vector<CompressionPrediction> predictions;
+  if (on_device) {
+    // Heuristic below
+  } else if (qtable_predictor_ && qtable_predictor_->IsReady()) {
+    predictions = qtable_predictor_->PredictBatch(batch);
+  }
 #ifdef WRP_COMPRESSOR_ENABLE_DENSE_NN
-    // Fallback to DNN if Q-table not available
-    else if (nn_predictor_ && nn_predictor_->IsReady()) {
-      CompressionFeatures features;
-      features.library_config_id = static_cast<double>(lib_id);
-      features.chunk_size_bytes = static_cast<double>(chunk_size);
-      features.shannon_entropy = entropy;
-      features.mad = mad;
-      features.second_derivative_mean = second_derivative_mean;
-      features.config_fast = (config_id == 3) ? 1 : 0;
-      features.config_balanced = (config_id == 0) ? 1 : 0;
-      features.config_best = (config_id == 1) ? 1 : 0;
-      features.data_type_char = (context.data_type_ == 0) ? 1 : 0;
-      features.data_type_float = (context.data_type_ == 1) ? 1 : 0;
-      pred = nn_predictor_->Predict(features);
-    }
+  // Fallback to DNN if Q-table not available
+  else if (nn_predictor_ && nn_predictor_->IsReady()) {
+    predictions = nn_predictor_->PredictBatch(batch);
+  }
 #endif  // WRP_COMPRESSOR_ENABLE_DENSE_NN
-    else {
-      // Heuristic fallback if no predictor available
+
+  for (size_t i = 0; i < candidate_lib_configs.size(); ++i) {
+    const auto& [lib_id, config_id] = candidate_lib_configs[i];
+    CompressionPrediction pred;
+    if (i < predictions.size()) {
+      pred = predictions[i];
+    } else {
+      // Heuristic fallback if no predictor available: ~100 MB/s on a CPU
+      // core, ~10 GB/s on a GPU
       pred.compression_ratio = 2.0;
       pred.psnr_db = 0.0;
-      pred.compression_time_ms = static_cast<double>(chunk_size) / 100000.0;
+      pred.compression_time_ms =
+          static_cast<double>(chunk_size) /
+          (IsGpuLibrary(lib_id) ? 10000000.0 : 100000.0);
     }
 
     // Filter out compressions below PSNR threshold
@@ -370,11 +676,16 @@ std::vector<CompressionStats> Runtime::EstCompressionStats(
   return results;
 }
 
-double Runtime::EstWorkflowCompressTime(chi::u64 chunk_size, double tier_bw,
-                                        const CompressionStats& stats,
-                                        const Context& context) {
+double Runtime::EstWorkflowCompressTime(
+    chi::u64 chunk_size, double tier_bw,
+    const chimaera::bdev::PerfCurve& tier_curve,
+    const CompressionStats& stats, const Context& context) {
   double compressed_size = chunk_size / stats.compression_ratio_;
-  double transfer_time_ms = (compressed_size / tier_bw) * 1000.0;
+  double transfer_time_ms =
+      tier_curve.IsFitted()
+          ? tier_curve.PredictUs(static_cast<chi::u64>(compressed_size)) /
+                1000.0
+          : (compressed_size / tier_bw) * 1000.0;
 
   if (stats.psnr_db_ == 0.0) {
     // Lossless compression
@@ -401,6 +712,7 @@ std::tuple<int, int, int, double, float> Runtime::BestCompressRatio(
 
   // Get target bandwidth from cached target states
   double tier_bw = 1e9;  // Default: 1 GB/s
+  chimaera::bdev::PerfCurve tier_curve;
   {
     std::lock_guard<std::mutex> lock(target_states_mutex_);
     if (!target_states_.empty()) {
@@ -415,6 +727,7 @@ std::tuple<int, int, int, double, float> Runtime::BestCompressRatio(
           tier_bw = std::pow(1001.0, max_score) - 1.0;
           tier_bw = std::max(tier_bw, 1e6);   // At least 1 MB/s
           tier_bw = std::min(tier_bw, 1e10);  // Cap at 10 GB/s
+          tier_curve = state.perf_model_.write_;
         }
       }
     }
@@ -423,7 +736,8 @@ std::tuple<int, int, int, double, float> Runtime::BestCompressRatio(
   for (const auto& stat : stats) {
     // Calculate workflow time for this compression
     double est_time =
-        EstWorkflowCompressTime(chunk_size, tier_bw, stat, context);
+        EstWorkflowCompressTime(chunk_size, tier_bw, tier_curve, stat,
+                                context);
 
     // Choose compression with best ratio that meets time constraints
     if (stat.compression_ratio_ > best_ratio) {
@@ -450,6 +764,7 @@ std::tuple<int, int, int, double, float> Runtime::BestCompressTime(
 
   // Get target bandwidth from cached target states
   double tier_bw = 1e9;  // Default: 1 GB/s
+  chimaera::bdev::PerfCurve tier_curve;
   {
     std::lock_guard<std::mutex> lock(target_states_mutex_);
     if (!target_states_.empty()) {
@@ -464,6 +779,7 @@ std::tuple<int, int, int, double, float> Runtime::BestCompressTime(
           tier_bw = std::pow(1001.0, max_score) - 1.0;
           tier_bw = std::max(tier_bw, 1e6);   // At least 1 MB/s
           tier_bw = std::min(tier_bw, 1e10);  // Cap at 10 GB/s
+          tier_curve = state.perf_model_.write_;
         }
       }
     }
@@ -472,7 +788,8 @@ std::tuple<int, int, int, double, float> Runtime::BestCompressTime(
   // For each compression library and tier, calculate workflow time
   for (const auto& stat : stats) {
     double est_time =
-        EstWorkflowCompressTime(chunk_size, tier_bw, stat, context);
+        EstWorkflowCompressTime(chunk_size, tier_bw, tier_curve, stat,
+                                context);
 
     // Choose combination with best performance
     if (est_time < best_time) {
@@ -525,6 +842,42 @@ static void WriteTraceLog(const std::string& trace_folder,
   }
 }
 
+CompressionDecision Runtime::ScheduleChunk(
+    const Context& context, const void* chunk, chi::u64 chunk_size,
+    const hshm::CompressionFeatureSet& chunk_features, bool on_device) {
+  CompressionDecision decision;
+
+  // Get compression stats
+  auto stats =
+      EstCompressionStats(chunk_features, chunk_size, context, on_device);
+  if (stats.empty()) {
+    return decision;
+  }
+
+  // Log predicted compression stats if tracing enabled
+  if (context.trace_) {
+    for (const auto& stat : stats) {
+      std::ostringstream log_entry;
+      log_entry << context.trace_key_ << "," << stat.compress_lib_ << ","
+                << stat.compression_ratio_ << "," << stat.compress_time_ms_
+                << "," << stat.decompress_time_ms_ << "," << stat.psnr_db_;
+      WriteTraceLog(config_.trace_folder_path_, "predicted_stats.log",
+                    pool_id_.major_, log_entry.str());
+    }
+  }
+
+  // Choose best compression strategy
+  auto [best_tier, best_lib, best_preset, best_time, tier_score] =
+      BestCompressForNode(context, chunk, chunk_size, container_id_, stats);
+  (void)best_tier;
+  (void)best_time;
+  decision.compress_ = true;
+  decision.compress_lib_ = best_lib;
+  decision.compress_preset_ = best_preset;
+  decision.tier_score_ = tier_score;
+  return decision;
+}
+
 chi::TaskResume Runtime::DynamicSchedule(
     hipc::FullPtr<DynamicScheduleTask> task, chi::RunContext& ctx) {
   try {
@@ -552,50 +905,59 @@ chi::TaskResume Runtime::DynamicSchedule(
       CHI_CO_RETURN;
     }
 
-    // Get compression stats
-    auto stats = EstCompressionStats(chunk_data, chunk_size, context);
-
-    if (stats.empty()) {
-      // No valid compression available, disable compression
+    // Encrypted or already compressed data goes straight to placement
+    bool on_device = IsDeviceResident(chunk_data);
+    if (!on_device &&
+        IsIncompressible(task->tag_id_, chunk_data, chunk_size, context)) {
       context.compress_lib_ = 0;
       context.dynamic_compress_ = 0;
-      task->return_code_ = 0;
-      CHI_CO_RETURN;
-    }
-
-    // Log predicted compression stats if tracing enabled
-    if (context.trace_ && !stats.empty()) {
-      for (const auto& stat : stats) {
-        std::ostringstream log_entry;
-        log_entry << context.trace_key_ << "," << stat.compress_lib_ << ","
-                  << stat.compression_ratio_ << "," << stat.compress_time_ms_
-                  << "," << stat.decompress_time_ms_ << "," << stat.psnr_db_;
-        WriteTraceLog(config_.trace_folder_path_, "predicted_stats.log",
-                      pool_id_.major_, log_entry.str());
+    } else {
+      // Repeated timesteps of a variable reuse the decision for their bucket;
+      // traced requests always run the predictors so every trace is complete
+      hshm::CompressionFeatureSet chunk_features =
+          SampleChunkFeatures(chunk_data, chunk_size, context);
+      CompressionDecisionKey decision_key = CompressionDecisionCache::MakeKey(
+          task->tag_id_, chunk_features, chunk_size, context, on_device);
+      CompressionDecision decision;
+      bool cached = !context.trace_ && decision_cache_.Enabled() &&
+                    decision_cache_.Lookup(decision_key, decision);
+      if (!cached) {
+        decision = ScheduleChunk(context, chunk_data, chunk_size,
+                                 chunk_features, on_device);
+        // Float blobs of a tag with an error bound may go lossy
+        TagErrorBound bound = GetTagErrorBound(task->tag_id_);
+        if (bound.IsSet() && context.data_type_ == 1 && !on_device) {
+          ScheduleLossy(bound, static_cast<const char*>(chunk_data),
+                        chunk_size, decision);
+        }
+        decision_cache_.Insert(decision_key, decision);
       }
-    }
 
-    // Choose best compression strategy
-    auto [best_tier, best_lib, best_preset, best_time, tier_score] =
-        BestCompressForNode(context, chunk_data, chunk_size, container_id_,
-                            stats);
+      if (!decision.compress_) {
+        // No valid compression available, disable compression
+        context.compress_lib_ = 0;
+        context.dynamic_compress_ = 0;
+        task->return_code_ = 0;
+        CHI_CO_RETURN;
+      }
 
-    // Update context with selected compression library and preset
-    context.compress_lib_ = best_lib;
-    context.compress_preset_ = best_preset;
-    task->tier_score_ = tier_score;
+      // Update context with selected compression library and preset
+      context.compress_lib_ = decision.compress_lib_;
+      context.compress_preset_ = decision.compress_preset_;
+      task->tier_score_ = decision.tier_score_;
 
-    // Log scheduling decision time if tracing enabled
-    if (context.trace_) {
-      auto end_time = std::chrono::high_resolution_clock::now();
-      auto duration_ms =
-          std::chrono::duration<double, std::milli>(end_time - start_time)
-              .count();
+      // Log scheduling decision time if tracing enabled
+      if (context.trace_) {
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration_ms =
+            std::chrono::duration<double, std::milli>(end_time - start_time)
+                .count();
 
-      std::ostringstream log_entry;
-      log_entry << context.trace_key_ << "," << duration_ms;
-      WriteTraceLog(config_.trace_folder_path_, "sched_decision.log",
-                    pool_id_.major_, log_entry.str());
+        std::ostringstream log_entry;
+        log_entry << context.trace_key_ << "," << duration_ms;
+        WriteTraceLog(config_.trace_folder_path_, "sched_decision.log",
+                      pool_id_.major_, log_entry.str());
+      }
     }
 
     // Now call Compress to perform compression and PutBlob
@@ -631,6 +993,11 @@ chi::TaskResume Runtime::Compress(hipc::FullPtr<CompressTask> task,
       CHI_CO_RETURN;
     }
 
+    // The blob is being rewritten, so its cached chunk index is stale
+    std::string index_key = ChunkIndexCache::MakeKey(task->tag_id_.ToU64(),
+                                                     task->blob_name_.str());
+    chunk_index_cache_.Erase(index_key);
+
     // Initialize core client if needed (from compose next_pool_id or task param)
     if (!core_client_) {
       chi::PoolId core_id = !config_.next_pool_id_.IsNull()
@@ -664,62 +1031,89 @@ chi::TaskResume Runtime::Compress(hipc::FullPtr<CompressTask> task,
       CHI_CO_RETURN;
     }
 
-    // Map compress_lib_ ID to library name
-    const char* lib_names[] = {"brotli", "bzip2", "blosc2", "fpzip",
-                               "lz4",    "lzma",  "snappy", "sz3",
-                               "zfp",    "zlib",  "zstd"};
-    std::string library_name =
-        (context.compress_lib_ >= 0 && context.compress_lib_ <= 10)
-            ? lib_names[context.compress_lib_]
-            : "zstd";
-
-    // Map preset integer to enum
-    hshm::CompressionPreset preset = hshm::CompressionPreset::BALANCED;
-    if (context.compress_preset_ == 1) {
-      preset = hshm::CompressionPreset::FAST;
-    } else if (context.compress_preset_ == 3) {
-      preset = hshm::CompressionPreset::BEST;
-    }
-
-    // Create compressor with specified preset
-    auto compressor = hshm::CompressionFactory::GetPreset(library_name, preset);
+    // Create compressor with specified library and preset
+    hshm::Compressor* compressor =
+        ThreadCompressor(context.compress_lib_, context.compress_preset_);
 
     if (!compressor) {
       HLOG(kWarning, "Failed to create compressor for library: {}",
-           library_name);
+           context.compress_lib_);
       task->return_code_ = 3;  // Compressor creation failed
       CHI_CO_RETURN;
     }
 
     auto compress_start = std::chrono::high_resolution_clock::now();
 
-    // Allocate buffer for compressed data (worst case: original size + 5%
-    // overhead)
-    std::vector<char> compressed_buffer(input_size + (input_size / 20) + 1024);
-
-    // Compress the data
-    size_t compressed_size = compressed_buffer.size();
+    // Compress the data; large blobs are split into independently
+    // compressed chunks so they use several threads and ranged reads
+    // only decompress what they need
     // Convert ShmPtr to raw pointer via FullPtr
     auto input_fullptr =
         CHI_IPC->ToFullPtr<char>(task->blob_data_.template Cast<char>());
     char* input_ptr = input_fullptr.ptr_;
-    bool success = compressor->Compress(compressed_buffer.data(),
-                                        compressed_size, input_ptr, input_size);
+    std::vector<char> stored;
+    // nvCOMP already splits its input across the GPU, and its input may
+    // be device memory the chunker cannot read
+    bool chunked = config_.chunk_size_ > 0 &&
+                   input_size > config_.chunk_size_ &&
+                   !IsGpuLibrary(context.compress_lib_);
+    // Small whole zstd blobs use their tag's trained dictionary
+    TagDictionaryStore::DictPtr dict;
+    if (!chunked && context.compress_lib_ == kZstd && task->offset_ == 0 &&
+        input_size <= config_.dict_max_blob_size_) {
+      dict = GetTagDictionary(task->tag_id_, input_ptr, input_size);
+    }
+    std::unique_ptr<hshm::Compressor> dict_compressor;
+    if (dict) {
+      dict_compressor = std::make_unique<hshm::ZstdDictCompressor>(
+          dict, LosslessModeFor(context.compress_preset_));
+    }
+    bool success =
+        chunked ? CompressChunked(context, input_ptr, input_size, stored)
+        : dict  ? CompressWhole(dict_compressor.get(), context, input_ptr,
+                                input_size, dict->Id(), stored)
+                : CompressWhole(compressor, context, input_ptr, input_size, 0,
+                                stored);
 
     auto compress_end = std::chrono::high_resolution_clock::now();
     double compress_time =
         std::chrono::duration<double, std::milli>(compress_end - compress_start)
             .count();
 
+    // Lossy blobs of a tag with an error bound are spot-checked; one that
+    // misses the bound is stored losslessly instead
+    TagErrorBound bound = GetTagErrorBound(task->tag_id_);
+    if (success && IsLossyLibrary(context.compress_lib_) && bound.IsSet()) {
+      double min_psnr = 0.0;
+      if (!VerifyErrorBound(bound, context, input_ptr, input_size, stored,
+                            min_psnr)) {
+        HLOG(kWarning,
+             "Library {} missed the error bound of tag {} (PSNR {:.2f}), "
+             "storing losslessly",
+             context.compress_lib_, task->tag_id_.ToU64(), min_psnr);
+        context.compress_lib_ = kZstd;
+        context.compress_preset_ = 2;
+        compressor = ThreadCompressor(kZstd, 2);
+        success =
+            compressor != nullptr &&
+            (chunked ? CompressChunked(context, input_ptr, input_size, stored)
+                     : CompressWhole(compressor, context, input_ptr,
+                                     input_size, 0, stored));
+        min_psnr = 0.0;
+      }
+      context.actual_psnr_db_ = min_psnr;
+    }
+
     // Check if compression succeeded and is beneficial
-    // Include header size in the total stored size
-    size_t header_size = sizeof(CompressionHeader);
-    size_t total_stored_size = compressed_size + header_size;
+    // The stored size includes the header (and chunk table)
+    size_t total_stored_size = stored.size();
+    if (success) {
+      RecordCompressOutcome(context, input_ptr, input_size, total_stored_size,
+                            compress_time);
+    }
 
     if (success && total_stored_size < input_size) {
       // Compression succeeded and reduced size (including header overhead)
-      compressed_buffer.resize(compressed_size);
-
       // Update context with compression statistics
       context.actual_original_size_ = input_size;
       context.actual_compressed_size_ = total_stored_size;
@@ -736,14 +1130,8 @@ chi::TaskResume Runtime::Compress(hipc::FullPtr<CompressTask> task,
         CHI_CO_RETURN;
       }
 
-      // Write compression header
-      CompressionHeader header(context.compress_lib_, context.compress_preset_,
-                               input_size);
-      std::memcpy(compressed_shm.ptr_, &header, header_size);
-
-      // Write compressed data after header
-      std::memcpy(compressed_shm.ptr_ + header_size, compressed_buffer.data(),
-                  compressed_size);
+      // Copy header + compressed data
+      std::memcpy(compressed_shm.ptr_, stored.data(), total_stored_size);
 
       // Call PutBlob with header + compressed data
       hipc::ShmPtr<> compressed_shm_ptr =
@@ -757,6 +1145,13 @@ chi::TaskResume Runtime::Compress(hipc::FullPtr<CompressTask> task,
       // Free compressed data buffer
       CHI_IPC->FreeBuffer(compressed_shm);
 
+      // Seed the chunk index so the first ranged read skips the table fetch
+      ChunkIndex index;
+      if (put_task->return_code_ == 0 && task->offset_ == 0 &&
+          ChunkedCodec::ParseIndex(stored.data(), stored.size(), index)) {
+        chunk_index_cache_.Insert(index_key, std::move(index));
+      }
+
       // Log compression telemetry
       CompressionTelemetry telemetry(
           CteOp::kPutBlob, context.compress_lib_, input_size, total_stored_size,
@@ -773,6 +1168,7 @@ chi::TaskResume Runtime::Compress(hipc::FullPtr<CompressTask> task,
 
       task->context_ = context;
       task->return_code_ = put_task->return_code_;
+      CountCompression(input_size, total_stored_size);
     } else {
       // Compression failed or didn't reduce size - store original data
       HLOG(kDebug, "Compression not beneficial, storing original data");
@@ -786,6 +1182,7 @@ chi::TaskResume Runtime::Compress(hipc::FullPtr<CompressTask> task,
       context.compress_lib_ = 0;  // Mark as uncompressed
       task->context_ = put_task->context_;
       task->return_code_ = put_task->return_code_;
+      CountCompression(input_size, input_size);
     }
 
   } catch (const std::exception& e) {
@@ -817,6 +1214,11 @@ chi::TaskResume Runtime::Decompress(hipc::FullPtr<DecompressTask> task,
       }
     }
 
+    // A read of a chunked blob fetches only the chunks it overlaps
+    if (TryDecompressChunked(task)) {
+      CHI_CO_RETURN;
+    }
+
     // Allocate temporary buffer to receive compressed data from GetBlob
     // We don't know the compressed size, so allocate expected_size as upper
     // bound
@@ -839,6 +1241,23 @@ chi::TaskResume Runtime::Decompress(hipc::FullPtr<DecompressTask> task,
       CHI_CO_RETURN;
     }
 
+    // Check for a chunked container
+    if (task->offset_ == 0 && expected_size >= sizeof(ChunkedCompressionHeader)) {
+      ChunkedCompressionHeader chunked;
+      std::memcpy(&chunked, temp_buffer.ptr_, sizeof(chunked));
+      ChunkIndex index;
+      if (chunked.IsValid()) {
+        task->return_code_ = LoadChunkIndex(task, chunked, temp_buffer.ptr_,
+                                            expected_size, index);
+        if (task->return_code_ == 0) {
+          task->return_code_ =
+              DecompressChunked(task, index, temp_buffer.ptr_, expected_size);
+        }
+        CHI_IPC->FreeBuffer(temp_buffer);
+        CHI_CO_RETURN;
+      }
+    }
+
     // Check for compression header
     auto* header = reinterpret_cast<CompressionHeader*>(temp_buffer.ptr_);
     size_t header_size = sizeof(CompressionHeader);
@@ -849,29 +1268,23 @@ chi::TaskResume Runtime::Decompress(hipc::FullPtr<DecompressTask> task,
       int compress_preset = static_cast<int>(header->compress_preset_);
       chi::u64 original_size = header->original_size_;
 
-      // Map compress_lib ID to library name
-      const char* lib_names[] = {"brotli", "bzip2", "blosc2", "fpzip",
-                                 "lz4",    "lzma",  "snappy", "sz3",
-                                 "zfp",    "zlib",  "zstd"};
-      std::string library_name = (compress_lib >= 0 && compress_lib <= 10)
-                                     ? lib_names[compress_lib]
-                                     : "zstd";
-
-      // Map preset integer to enum
-      hshm::CompressionPreset preset = hshm::CompressionPreset::BALANCED;
-      if (compress_preset == 1) {
-        preset = hshm::CompressionPreset::FAST;
-      } else if (compress_preset == 3) {
-        preset = hshm::CompressionPreset::BEST;
+      // Create decompressor; blobs written with a tag dictionary need it
+      hshm::Compressor* decompressor = nullptr;
+      std::unique_ptr<hshm::Compressor> dict_decompressor;
+      if (header->HasDictionary()) {
+        auto dict = LoadTagDictionary(task->tag_id_, header->dict_id_);
+        if (dict) {
+          dict_decompressor = std::make_unique<hshm::ZstdDictCompressor>(
+              dict, LosslessModeFor(compress_preset));
+          decompressor = dict_decompressor.get();
+        }
+      } else {
+        decompressor = ThreadCompressor(compress_lib, compress_preset);
       }
-
-      // Create decompressor
-      auto decompressor =
-          hshm::CompressionFactory::GetPreset(library_name, preset);
       if (!decompressor) {
         CHI_IPC->FreeBuffer(temp_buffer);
         HLOG(kWarning, "Failed to create decompressor for library: {}",
-             library_name);
+             compress_lib);
         task->return_code_ = 3;  // Decompressor creation failed
         CHI_CO_RETURN;
       }
@@ -941,6 +1354,524 @@ chi::TaskResume Runtime::Decompress(hipc::FullPtr<DecompressTask> task,
   CHI_CO_RETURN;
 }
 
+bool Runtime::CompressWhole(hshm::Compressor* compressor,
+                            const Context& context, const char* input,
+                            chi::u64 input_size, chi::u32 dict_id,
+                            std::vector<char>& stored) {
+  // Worst case: original size + 5% overhead, after the header
+  size_t header_size = sizeof(CompressionHeader);
+  stored.resize(header_size + input_size + (input_size / 20) + 1024);
+  size_t compressed_size = stored.size() - header_size;
+  if (!compressor->Compress(stored.data() + header_size, compressed_size,
+                            const_cast<char*>(input), input_size)) {
+    return false;
+  }
+  CompressionHeader header(context.compress_lib_, context.compress_preset_,
+                           input_size, dict_id);
+  std::memcpy(stored.data(), &header, header_size);
+  stored.resize(header_size + compressed_size);
+  return true;
+}
+
+TagDictionaryStore::DictPtr Runtime::GetTagDictionary(
+    const wrp_cte::core::TagId& tag_id, const char* input,
+    chi::u64 input_size) {
+  chi::u64 tag = tag_id.ToU64();
+  TagDictionaryStore::DictPtr dict = tag_dictionaries_.Current(tag);
+  if (dict) {
+    return dict;
+  }
+  DictionarySamples batch;
+  if (!tag_dictionaries_.AddSample(tag, input, input_size, batch)) {
+    return nullptr;
+  }
+  return TrainTagDictionary(tag_id, batch);
+}
+
+TagDictionaryStore::DictPtr Runtime::TrainTagDictionary(
+    const wrp_cte::core::TagId& tag_id, const DictionarySamples& batch) {
+  chi::u64 tag = tag_id.ToU64();
+  std::shared_ptr<hshm::ZstdDictionary> dict = hshm::ZstdDictionary::Train(
+      batch.data_, batch.sizes_, config_.dict_size_);
+  if (!dict) {
+    HLOG(kDebug, "Dictionary training failed for tag {}", tag);
+    tag_dictionaries_.Fail(tag);
+    return nullptr;
+  }
+
+  // Store the dictionary in the tag so blobs using it stay readable
+  // after a restart
+  const std::vector<char>& data = dict->Data();
+  auto buffer = CHI_IPC->AllocateBuffer(data.size());
+  if (buffer.IsNull()) {
+    tag_dictionaries_.Fail(tag);
+    return nullptr;
+  }
+  std::memcpy(buffer.ptr_, data.data(), data.size());
+  std::string blob_name = kDictBlobPrefix + std::to_string(dict->Id());
+  auto put_task = core_client_->AsyncPutBlob(
+      tag_id, blob_name, 0, data.size(), buffer.shm_.template Cast<void>(),
+      1.0F, Context(), 0, chi::PoolQuery::Local());
+  put_task.Wait();
+  CHI_IPC->FreeBuffer(buffer);
+  if (put_task->return_code_ != 0) {
+    HLOG(kWarning, "Failed to store dictionary for tag {}: {}", tag,
+         put_task->return_code_);
+    tag_dictionaries_.Fail(tag);
+    return nullptr;
+  }
+
+  tag_dictionaries_.Publish(tag, dict->Id(), dict);
+  HLOG(kDebug, "Trained {}-byte dictionary {} for tag {} from {} samples",
+       data.size(), dict->Id(), tag, batch.sizes_.size());
+  return dict;
+}
+
+TagDictionaryStore::DictPtr Runtime::LoadTagDictionary(
+    const wrp_cte::core::TagId& tag_id, chi::u32 dict_id) {
+  chi::u64 tag = tag_id.ToU64();
+  TagDictionaryStore::DictPtr dict = tag_dictionaries_.Find(tag, dict_id);
+  if (dict) {
+    return dict;
+  }
+
+  std::string blob_name = kDictBlobPrefix + std::to_string(dict_id);
+  auto size_task = core_client_->AsyncGetBlobSize(tag_id, blob_name,
+                                                  chi::PoolQuery::Local());
+  size_task.Wait();
+  chi::u64 size = size_task->size_;
+  if (size_task->return_code_ != 0 || size == 0) {
+    HLOG(kWarning, "Dictionary {} of tag {} not found", dict_id, tag);
+    return nullptr;
+  }
+  auto buffer = CHI_IPC->AllocateBuffer(size);
+  if (buffer.IsNull()) {
+    return nullptr;
+  }
+  auto get_task = core_client_->AsyncGetBlob(
+      tag_id, blob_name, 0, size, 0, buffer.shm_.template Cast<void>(),
+      chi::PoolQuery::Local());
+  get_task.Wait();
+  if (get_task->return_code_ == 0) {
+    std::shared_ptr<hshm::ZstdDictionary> loaded =
+        hshm::ZstdDictionary::Load(buffer.ptr_, size);
+    if (loaded && loaded->Id() == dict_id) {
+      dict = loaded;
+      tag_dictionaries_.Insert(tag, dict_id, dict);
+    }
+  }
+  CHI_IPC->FreeBuffer(buffer);
+  return dict;
+}
+
+bool Runtime::CompressChunked(const Context& context, const char* input,
+                              chi::u64 input_size, std::vector<char>& stored) {
+  int compress_lib = context.compress_lib_;
+  int compress_preset = context.compress_preset_;
+  return ChunkedCodec::Compress(
+      [compress_lib, compress_preset]() {
+        return MakeCompressor(compress_lib, compress_preset);
+      },
+      compress_lib, compress_preset, config_.chunk_size_, input, input_size,
+      config_.compress_threads_, stored);
+}
+
+chi::u32 Runtime::ReadStored(const hipc::FullPtr<DecompressTask>& task,
+                             chi::u64 offset, chi::u64 size,
+                             hipc::FullPtr<char>& buffer) {
+  buffer = CHI_IPC->AllocateBuffer(size);
+  if (buffer.IsNull()) {
+    return 2;  // Memory allocation failed
+  }
+  auto get_task = core_client_->AsyncGetBlob(
+      task->tag_id_, task->blob_name_.str(), offset, size, task->flags_,
+      buffer.shm_.template Cast<void>(), chi::PoolQuery::Local());
+  get_task.Wait();
+  if (get_task->return_code_ != 0) {
+    CHI_IPC->FreeBuffer(buffer);
+    return 10 + get_task->return_code_;  // GetBlob failed
+  }
+  return 0;
+}
+
+bool Runtime::TryDecompressChunked(hipc::FullPtr<DecompressTask> task) {
+  // With a cached index the read is a single GetBlob of the payload bytes
+  std::string index_key = ChunkIndexCache::MakeKey(task->tag_id_.ToU64(),
+                                                   task->blob_name_.str());
+  if (auto cached = chunk_index_cache_.Lookup(index_key)) {
+    if (DecompressChunked(task, *cached, nullptr, 0) == 0) {
+      task->return_code_ = 0;
+      return true;
+    }
+    chunk_index_cache_.Erase(index_key);  // Rewritten behind our back
+  }
+
+  // Reads at offset 0 learn the format from the buffer Decompress fetches
+  if (task->offset_ == 0) {
+    return false;
+  }
+  hipc::FullPtr<char> probe;
+  if (ReadStored(task, 0, sizeof(ChunkedCompressionHeader), probe) != 0) {
+    return false;
+  }
+  ChunkedCompressionHeader header;
+  std::memcpy(&header, probe.ptr_, sizeof(header));
+  CHI_IPC->FreeBuffer(probe);
+  if (!header.IsValid()) {
+    return false;
+  }
+  ChunkIndex index;
+  task->return_code_ = LoadChunkIndex(task, header, nullptr, 0, index);
+  if (task->return_code_ == 0) {
+    task->return_code_ = DecompressChunked(task, index, nullptr, 0);
+  }
+  return true;
+}
+
+chi::u32 Runtime::LoadChunkIndex(const hipc::FullPtr<DecompressTask>& task,
+                                 const ChunkedCompressionHeader& header,
+                                 const char* prefix, chi::u64 prefix_size,
+                                 ChunkIndex& index) {
+  // Chunk table, from the prefix if it was already read
+  chi::u64 data_offset = ChunkedCodec::DataOffset(header.num_chunks_);
+  chi::u64 table_bytes = data_offset - sizeof(ChunkedCompressionHeader);
+  index.header_ = header;
+  index.table_.resize(header.num_chunks_);
+  if (prefix_size >= data_offset) {
+    std::memcpy(index.table_.data(), prefix + sizeof(ChunkedCompressionHeader),
+                table_bytes);
+  } else {
+    hipc::FullPtr<char> table_buffer;
+    chi::u32 rc = ReadStored(task, sizeof(ChunkedCompressionHeader),
+                             table_bytes, table_buffer);
+    if (rc != 0) {
+      return rc;
+    }
+    std::memcpy(index.table_.data(), table_buffer.ptr_, table_bytes);
+    CHI_IPC->FreeBuffer(table_buffer);
+  }
+  chunk_index_cache_.Insert(
+      ChunkIndexCache::MakeKey(task->tag_id_.ToU64(), task->blob_name_.str()),
+      index);
+  return 0;
+}
+
+chi::u32 Runtime::DecompressChunked(hipc::FullPtr<DecompressTask> task,
+                                    const ChunkIndex& index, const char* prefix,
+                                    chi::u64 prefix_size) {
+  auto decompress_start = std::chrono::high_resolution_clock::now();
+  const ChunkedCompressionHeader& header = index.header_;
+  const std::vector<ChunkTableEntry>& table = index.table_;
+  chi::u64 data_offset = ChunkedCodec::DataOffset(header.num_chunks_);
+
+  chi::u32 first = 0, last = 0;
+  if (!ChunkedCodec::ChunkSpan(header, task->offset_, task->size_, first,
+                               last)) {
+    task->output_size_ = 0;
+    task->decompress_time_ms_ = 0.0;
+    return 0;  // Range is past the end of the blob
+  }
+
+  // Stored bytes of the overlapped chunks
+  chi::u64 begin = data_offset + table[first].offset_;
+  chi::u64 end = data_offset + table[last].offset_ + table[last].size_;
+  hipc::FullPtr<char> payload_buffer;
+  const char* payload = nullptr;
+  if (end <= prefix_size) {
+    payload = prefix + begin;
+  } else {
+    chi::u32 rc = ReadStored(task, begin, end - begin, payload_buffer);
+    if (rc != 0) {
+      return rc;
+    }
+    payload = payload_buffer.ptr_;
+  }
+
+  auto output_fullptr =
+      CHI_IPC->ToFullPtr<char>(task->blob_data_.template Cast<char>());
+  int compress_lib = static_cast<int>(header.compress_lib_);
+  int compress_preset = static_cast<int>(header.compress_preset_);
+  chi::u64 written = ChunkedCodec::DecompressRange(
+      [compress_lib, compress_preset]() {
+        return MakeCompressor(compress_lib, compress_preset);
+      },
+      header, table.data(), payload, task->offset_, task->size_,
+      output_fullptr.ptr_, config_.compress_threads_);
+  if (!payload_buffer.IsNull()) {
+    CHI_IPC->FreeBuffer(payload_buffer);
+  }
+
+  double decompress_time = std::chrono::duration<double, std::milli>(
+                               std::chrono::high_resolution_clock::now() -
+                               decompress_start)
+                               .count();
+  if (written == 0) {
+    HLOG(kError, "Chunked decompression failed");
+    task->output_size_ = 0;
+    task->decompress_time_ms_ = 0.0;
+    return 5;  // Decompression failed
+  }
+  task->output_size_ = written;
+  task->decompress_time_ms_ = decompress_time;
+
+  CompressionTelemetry telemetry(
+      CteOp::kGetBlob, compress_lib, written, end - begin, 0.0,
+      decompress_time, 0.0, std::chrono::steady_clock::now(),
+      compression_logical_time_.fetch_add(1));
+  LogCompressionTelemetry(telemetry);
+
+  HLOG(kDebug,
+       "Chunked decompression: chunks {}-{} of {}, {} bytes -> {} bytes "
+       "(time: {:.2f}ms)",
+       first, last, header.num_chunks_, end - begin, written, decompress_time);
+  return 0;
+}
+
+void Runtime::RecordCompressOutcome(const Context& context, const char* input,
+                                    chi::u64 input_size, size_t stored_size,
+                                    double compress_time_ms) {
+  // The models are trained on the CPU codecs only
+  if (!feedback_ring_.Enabled() || stored_size == 0 ||
+      IsGpuLibrary(context.compress_lib_) ||
+      (!qtable_predictor_ && !linreg_predictor_)) {
+    return;
+  }
+  RLExperience experience;
+  experience.features = ModelFeatures(
+      SampleChunkFeatures(input, input_size, context), input_size,
+      context.compress_lib_, context.compress_preset_, context);
+  experience.actual_ratio =
+      static_cast<double>(input_size) / static_cast<double>(stored_size);
+  experience.actual_compress_time = compress_time_ms;
+  feedback_ring_.Push(experience);
+}
+
+chi::TaskResume Runtime::RefitModels(hipc::FullPtr<RefitModelsTask> task,
+                                     chi::RunContext& ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  task->experiences_used_ = 0;
+  size_t min_samples = std::max<chi::u32>(config_.refit_min_samples_, 1);
+  if (feedback_ring_.Size() < min_samples) {
+    task->SetReturnCode(0);
+    CHI_CO_RETURN;
+  }
+  std::vector<RLExperience> experiences = feedback_ring_.Drain();
+
+  RLConfig rl_config;
+  rl_config.learning_rate = GetLearningRate();
+  rl_config.batch_size = config_.refit_min_samples_;
+  rl_config.replay_buffer_size = config_.feedback_buffer_size_;
+
+  bool updated = false;
+  if (qtable_predictor_ && qtable_predictor_->IsReady()) {
+    for (const auto& experience : experiences) {
+      qtable_predictor_->RecordExperience(experience);
+    }
+    updated |= qtable_predictor_->UpdateFromExperiences(rl_config);
+  }
+  if (linreg_predictor_) {
+    // The LinReg table encodes library and preset differently
+    for (RLExperience experience : experiences) {
+      const auto& f = experience.features;
+      int config_id = f.config_fast > 0.5       ? 3
+                      : f.config_best > 0.5     ? 1
+                      : f.config_balanced > 0.5 ? 0
+                                                : 2;
+      int linreg_id =
+          LinRegConfigId(static_cast<int>(f.library_config_id), config_id);
+      if (linreg_id < 0) {
+        continue;
+      }
+      experience.features.library_config_id = linreg_id;
+      linreg_predictor_->RecordExperience(experience);
+    }
+    updated |= linreg_predictor_->UpdateFromExperiences(rl_config);
+  }
+
+  // Cached decisions were made with the old models
+  if (updated) {
+    decision_cache_.Clear();
+  }
+  task->experiences_used_ = static_cast<chi::u32>(experiences.size());
+  HLOG(kDebug, "RefitModels: {} outcomes, models {}",
+       task->experiences_used_, updated ? "updated" : "unchanged");
+  task->SetReturnCode(0);
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+chi::TaskResume Runtime::SetTagErrorBound(
+    hipc::FullPtr<SetTagErrorBoundTask> task, chi::RunContext& ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  {
+    std::lock_guard<std::mutex> lock(tag_error_bounds_mutex_);
+    if (task->error_bound_.IsSet()) {
+      tag_error_bounds_[task->tag_id_.ToU64()] = task->error_bound_;
+    } else {
+      tag_error_bounds_.erase(task->tag_id_.ToU64());
+    }
+  }
+  // Cached decisions of the tag were made under its old bound
+  decision_cache_.Clear();
+  HLOG(kDebug, "SetTagErrorBound: tag {} mode {} bound {}",
+       task->tag_id_.ToU64(), static_cast<chi::u32>(task->error_bound_.mode_),
+       task->error_bound_.bound_);
+  task->SetReturnCode(0);
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+TagErrorBound Runtime::GetTagErrorBound(const wrp_cte::core::TagId& tag_id) {
+  std::lock_guard<std::mutex> lock(tag_error_bounds_mutex_);
+  auto it = tag_error_bounds_.find(tag_id.ToU64());
+  return it != tag_error_bounds_.end() ? it->second : TagErrorBound();
+}
+
+bool Runtime::ScheduleLossy(const TagErrorBound& bound, const char* data,
+                            chi::u64 size, CompressionDecision& decision) {
+  size_t count = size / sizeof(float);
+  if (count == 0 || size % sizeof(float) != 0) {
+    return false;
+  }
+  const float* values = reinterpret_cast<const float*>(data);
+  double value_range = ErrorBoundChecker::ValueRange(values, count);
+
+  // Trial every lossy codec and preset on a prefix of the blob, checking
+  // the whole prefix against the bound
+  size_t sample_count = std::min(count, kLossySampleFloats);
+  size_t sample_size = sample_count * sizeof(float);
+  TagErrorBound sample_bound = bound;
+  sample_bound.verify_blocks_ = static_cast<chi::u32>(
+      (sample_count + ErrorBoundChecker::kBlockFloats - 1) /
+      ErrorBoundChecker::kBlockFloats);
+  std::vector<char> compressed(sample_size + sample_size / 20 + 1024);
+  std::vector<float> recon(sample_count);
+  double best_ratio = 1.0;
+  bool found = false;
+  for (int lib : {kSz3, kZfp, kFpzip}) {
+    for (int preset = 1; preset <= 3; ++preset) {
+      hshm::Compressor* compressor = ThreadCompressor(lib, preset);
+      if (!compressor) {
+        continue;  // Built without this library
+      }
+      size_t compressed_size = compressed.size();
+      if (!compressor->Compress(compressed.data(), compressed_size,
+                                const_cast<char*>(data), sample_size) ||
+          compressed_size == 0) {
+        continue;
+      }
+      size_t recon_size = sample_size;
+      if (!compressor->Decompress(recon.data(), recon_size, compressed.data(),
+                                  compressed_size) ||
+          recon_size != sample_size) {
+        continue;
+      }
+      double psnr = 0.0;
+      if (!ErrorBoundChecker::Check(sample_bound, values, recon.data(),
+                                    sample_count, value_range, psnr)) {
+        continue;
+      }
+      double ratio = static_cast<double>(sample_size) /
+                     static_cast<double>(compressed_size);
+      if (ratio > best_ratio) {
+        best_ratio = ratio;
+        decision.compress_ = true;
+        decision.compress_lib_ = lib;
+        decision.compress_preset_ = preset;
+        found = true;
+      }
+    }
+  }
+  return found;
+}
+
+bool Runtime::VerifyErrorBound(const TagErrorBound& bound,
+                               const Context& context, const char* input,
+                               chi::u64 input_size,
+                               const std::vector<char>& stored,
+                               double& min_psnr) {
+  min_psnr = 0.0;
+  size_t count = input_size / sizeof(float);
+  if (bound.verify_blocks_ == 0 || context.data_type_ != 1 || count == 0 ||
+      input_size % sizeof(float) != 0) {
+    return true;  // Nothing the bound can be checked against
+  }
+  const float* values = reinterpret_cast<const float*>(input);
+  double value_range = ErrorBoundChecker::ValueRange(values, count);
+  int compress_lib = context.compress_lib_;
+  int compress_preset = context.compress_preset_;
+
+  // A whole blob only decodes in full; a chunked one per sampled block
+  ChunkIndex index;
+  bool chunked = ChunkedCodec::ParseIndex(stored.data(), stored.size(), index);
+  std::vector<float> whole;
+  if (!chunked) {
+    hshm::Compressor* compressor =
+        ThreadCompressor(compress_lib, compress_preset);
+    size_t header_size = sizeof(CompressionHeader);
+    whole.resize(count);
+    size_t recon_size = input_size;
+    if (!compressor || stored.size() <= header_size ||
+        !compressor->Decompress(whole.data(), recon_size,
+                                const_cast<char*>(stored.data()) + header_size,
+                                stored.size() - header_size) ||
+        recon_size != input_size) {
+      return false;
+    }
+  }
+
+  const char* payload =
+      chunked
+          ? stored.data() + ChunkedCodec::DataOffset(index.header_.num_chunks_)
+          : nullptr;
+  std::vector<float> block;
+  for (const auto& [begin, len] :
+       ErrorBoundChecker::SampleBlocks(count, bound.verify_blocks_)) {
+    const float* recon = whole.data() + begin;
+    if (chunked) {
+      chi::u64 offset = begin * sizeof(float);
+      chi::u64 size = len * sizeof(float);
+      chi::u32 first = 0, last = 0;
+      if (!ChunkedCodec::ChunkSpan(index.header_, offset, size, first,
+                                   last)) {
+        return false;
+      }
+      block.resize(len);
+      chi::u64 written = ChunkedCodec::DecompressRange(
+          [compress_lib, compress_preset]() {
+            return MakeCompressor(compress_lib, compress_preset);
+          },
+          index.header_, index.table_.data(),
+          payload + index.table_[first].offset_, offset, size,
+          reinterpret_cast<char*>(block.data()), 1);
+      if (written != size) {
+        return false;
+      }
+      recon = block.data();
+    }
+    double psnr = 0.0;
+    bool passed = ErrorBoundChecker::CheckBlock(bound, values + begin, recon,
+                                                len, value_range, psnr);
+    if (psnr > 0.0 && (min_psnr == 0.0 || psnr < min_psnr)) {
+      min_psnr = psnr;
+    }
+    if (!passed) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void Runtime::LogCompressionTelemetry(const CompressionTelemetry& telemetry) {
   // Log to compression telemetry buffer if available
   if (!compression_telemetry_log_.IsNull()) {
@@ -159,7 +159,8 @@ LinRegTablePredictor::LinRegTablePredictor(LinRegTablePredictor&& other) noexcep
     : config_(std::move(other.config_)),
       table_(std::move(other.table_)),
       ready_(other.ready_),
-      id_to_lib_config_(std::move(other.id_to_lib_config_)) {
+      id_to_lib_config_(std::move(other.id_to_lib_config_)),
+      experience_buffer_(std::move(other.experience_buffer_)) {
   other.ready_ = false;
 }
 
@@ -170,6 +171,7 @@ LinRegTablePredictor& LinRegTablePredictor::operator=(LinRegTablePredictor&& oth
     table_ = std::move(other.table_);
     ready_ = other.ready_;
     id_to_lib_config_ = std::move(other.id_to_lib_config_);
+    experience_buffer_ = std::move(other.experience_buffer_);
     other.ready_ = false;
   }
   return *this;
@@ -373,8 +375,13 @@ std::vector<CompressionPrediction> LinRegTablePredictor::PredictBatch(
     const std::vector<CompressionFeatures>& batch) {
   std::vector<CompressionPrediction> results;
   results.reserve(batch.size());
+  // One lock for the whole batch
+  std::lock_guard<std::mutex> lock(mutex_);
   for (const auto& features : batch) {
-    results.push_back(Predict(features));
+    std::string library, config;
+    DecodeLibraryConfigId(static_cast<int>(features.library_config_id), library, config);
+    LinRegTableKey key(library, config, GetDataTypeFromFeatures(features), "");
+    results.push_back(PredictByKeyLocked(key, features.chunk_size_bytes));
   }
   return results;
 }
@@ -384,10 +391,14 @@ CompressionPrediction LinRegTablePredictor::PredictByKey(
     const std::string& data_type, const std::string& distribution,
     double data_size) {
   std::lock_guard<std::mutex> lock(mutex_);
+  return PredictByKeyLocked(
+      LinRegTableKey(library, config, data_type, distribution), data_size);
+}
 
+CompressionPrediction LinRegTablePredictor::PredictByKeyLocked(
+    const LinRegTableKey& key, double data_size) const {
   CompressionPrediction result;
 
-  LinRegTableKey key(library, config, data_type, distribution);
   auto it = table_.find(key);
 
   if (it != table_.end()) {
@@ -651,4 +662,119 @@ std::vector<std::string> LinRegTablePredictor::GetDistributions() const {
   return std::vector<std::string>(dists.begin(), dists.end());
 }
 
+void LinRegTablePredictor::RecordExperience(const RLExperience& experience) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  experience_buffer_.push_back(experience);
+
+  // Limit buffer size (default 10000)
+  while (experience_buffer_.size() > 10000) {
+    experience_buffer_.pop_front();
+  }
+}
+
+bool LinRegTablePredictor::UpdateFromExperiences(const RLConfig& config) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (experience_buffer_.empty() ||
+      experience_buffer_.size() < config.batch_size) {
+    return false;
+  }
+  double rate = std::clamp(config.learning_rate, 0.0, 1.0);
+
+  // Group outcomes by (library, config, data_type), as Predict looks them up
+  std::map<LinRegTableKey, std::vector<size_t>> groups;
+  for (size_t i = 0; i < experience_buffer_.size(); ++i) {
+    const auto& features = experience_buffer_[i].features;
+    std::string library, lib_config;
+    DecodeLibraryConfigId(static_cast<int>(features.library_config_id),
+                          library, lib_config);
+    LinRegTableKey key(library, lib_config, GetDataTypeFromFeatures(features));
+    groups[key].push_back(i);
+  }
+
+  bool updated = false;
+  std::vector<bool> consumed(experience_buffer_.size(), false);
+  for (const auto& [key, indices] : groups) {
+    if (indices.size() < static_cast<size_t>(config_.min_samples)) {
+      continue;
+    }
+    std::vector<double> x_data, y_time, y_ratio;
+    x_data.reserve(indices.size());
+    y_time.reserve(indices.size());
+    y_ratio.reserve(indices.size());
+    for (size_t idx : indices) {
+      const auto& exp = experience_buffer_[idx];
+      x_data.push_back(exp.features.chunk_size_bytes);
+      y_time.push_back(exp.actual_compress_time);
+      y_ratio.push_back(exp.actual_ratio);
+      consumed[idx] = true;
+    }
+
+    // An unseen key takes the fit as is; decompression is not observed
+    double key_rate = rate;
+    auto it = table_.find(key);
+    if (it == table_.end()) {
+      LinearRegressionCoeffs coeffs;
+      coeffs.intercept_decompress_time = config_.fallback_decompress_time;
+      it = table_.emplace(key, coeffs).first;
+      key_rate = 1.0;
+    }
+    auto& coeffs = it->second;
+    BlendFit(x_data, y_time, key_rate, coeffs.slope_compress_time,
+             coeffs.intercept_compress_time, coeffs.r2_compress_time);
+    BlendFit(x_data, y_ratio, key_rate, coeffs.slope_compress_ratio,
+             coeffs.intercept_compress_ratio, coeffs.r2_compress_ratio);
+    coeffs.sample_count += indices.size();
+    updated = true;
+  }
+
+  // Keep the outcomes of keys still short of min_samples
+  std::deque<RLExperience> pending;
+  for (size_t i = 0; i < experience_buffer_.size(); ++i) {
+    if (!consumed[i]) {
+      pending.push_back(std::move(experience_buffer_[i]));
+    }
+  }
+  while (pending.size() > config.replay_buffer_size) {
+    pending.pop_front();
+  }
+  experience_buffer_ = std::move(pending);
+
+  ready_ = !table_.empty();
+  return updated;
+}
+
+size_t LinRegTablePredictor::GetExperienceCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return experience_buffer_.size();
+}
+
+void LinRegTablePredictor::ClearExperiences() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  experience_buffer_.clear();
+}
+
+void LinRegTablePredictor::BlendFit(const std::vector<double>& x,
+                                    const std::vector<double>& y, double rate,
+                                    double& slope, double& intercept,
+                                    double& r2) {
+  double fit_slope = 0.0;
+  double fit_intercept = 0.0;
+  FitLinearRegression(x, y, fit_slope, fit_intercept, r2);
+
+  double mean_x = std::accumulate(x.begin(), x.end(), 0.0) / x.size();
+  double min_x = *std::min_element(x.begin(), x.end());
+  double max_x = *std::max_element(x.begin(), x.end());
+  if (max_x - min_x < 1e-10 * std::max(1.0, std::abs(mean_x))) {
+    // All outcomes share one data size: they say nothing about the slope,
+    // so only move the regressor's value at that size toward their mean
+    double current = slope * mean_x + intercept;
+    intercept += rate * (fit_intercept - current);
+    return;
+  }
+  slope += rate * (fit_slope - slope);
+  intercept += rate * (fit_intercept - intercept);
+}
+
 }  // namespace wrp_cte::compressor
@@ -83,7 +83,8 @@ QTablePredictor::QTablePredictor(QTablePredictor&& other) noexcept
       bin_edges_(std::move(other.bin_edges_)),
       global_average_(other.global_average_),
       table_ready_(other.table_ready_),
-      unknown_count_(other.unknown_count_) {
+      unknown_count_(other.unknown_count_),
+      experience_buffer_(std::move(other.experience_buffer_)) {
   other.table_ready_ = false;
 }
 
@@ -95,6 +96,7 @@ QTablePredictor& QTablePredictor::operator=(QTablePredictor&& other) noexcept {
     global_average_ = other.global_average_;
     table_ready_ = other.table_ready_;
     unknown_count_ = other.unknown_count_;
+    experience_buffer_ = std::move(other.experience_buffer_);
     other.table_ready_ = false;
   }
   return *this;
@@ -250,6 +252,8 @@ bool QTablePredictor::IsReady() const {
 CompressionPrediction QTablePredictor::Predict(const CompressionFeatures& features) {
   auto start = std::chrono::high_resolution_clock::now();
 
+  // UpdateFromExperiences may be changing the table concurrently
+  std::lock_guard<std::mutex> lock(mutex_);
   QState state = DiscretizeFeatures(features);
   QValue value = GetPrediction(state);
 
@@ -269,6 +273,8 @@ std::vector<CompressionPrediction> QTablePredictor::PredictBatch(
   std::vector<CompressionPrediction> results;
   results.reserve(batch.size());
 
+  // One lock for the whole batch
+  std::lock_guard<std::mutex> lock(mutex_);
   unknown_count_ = 0;
 
   auto start = std::chrono::high_resolution_clock::now();
@@ -542,4 +548,61 @@ QValue QTablePredictor::GetPrediction(const QState& state) {
   return global_average_;
 }
 
+void QTablePredictor::RecordExperience(const RLExperience& experience) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  experience_buffer_.push_back(experience);
+
+  // Limit buffer size (default 10000)
+  while (experience_buffer_.size() > 10000) {
+    experience_buffer_.pop_front();
+  }
+}
+
+bool QTablePredictor::UpdateFromExperiences(const RLConfig& config) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // Need trained binning edges and enough experiences for a batch
+  if (!table_ready_ || experience_buffer_.empty() ||
+      experience_buffer_.size() < config.batch_size) {
+    return false;
+  }
+  float rate = static_cast<float>(std::clamp(config.learning_rate, 0.0, 1.0));
+  auto step = [rate](float& value, double target) {
+    value += rate * (static_cast<float>(target) - value);
+  };
+
+  for (const auto& exp : experience_buffer_) {
+    QState state = DiscretizeFeatures(exp.features);
+    auto it = qtable_.find(state);
+    if (it == qtable_.end()) {
+      qtable_.emplace(state, QValue(static_cast<float>(exp.actual_ratio),
+                                    static_cast<float>(exp.actual_psnr),
+                                    static_cast<float>(exp.actual_compress_time)));
+    } else {
+      step(it->second.compression_ratio, exp.actual_ratio);
+      step(it->second.psnr_db, exp.actual_psnr);
+      step(it->second.compression_time_ms, exp.actual_compress_time);
+      it->second.sample_count++;
+    }
+    step(global_average_.compression_ratio, exp.actual_ratio);
+    step(global_average_.psnr_db, exp.actual_psnr);
+    step(global_average_.compression_time_ms, exp.actual_compress_time);
+    global_average_.sample_count++;
+  }
+
+  experience_buffer_.clear();
+  return true;
+}
+
+size_t QTablePredictor::GetExperienceCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return experience_buffer_.size();
+}
+
+void QTablePredictor::ClearExperiences() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  experience_buffer_.clear();
+}
+
 }  // namespace wrp_cte::compressor
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file test_chunked_container.cc
+ * @brief Unit tests for the chunked compression container
+ */
+
+#include "wrp_cte/compressor/chunked_container.h"
+#include "../../../context-runtime/test/simple_test.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace wrp_cte::compressor;
+
+namespace {
+
+/** Byte run-length coder: (count, value) pairs */
+class RleCompressor : public hshm::Compressor {
+ public:
+  bool Compress(void* output, size_t& output_size, void* input,
+                size_t input_size) override {
+    auto* in = static_cast<unsigned char*>(input);
+    auto* out = static_cast<unsigned char*>(output);
+    size_t pos = 0;
+    for (size_t i = 0; i < input_size;) {
+      size_t run = 1;
+      while (i + run < input_size && run < 255 && in[i + run] == in[i]) ++run;
+      if (pos + 2 > output_size) return false;
+      out[pos++] = static_cast<unsigned char>(run);
+      out[pos++] = in[i];
+      i += run;
+    }
+    output_size = pos;
+    return true;
+  }
+
+  bool Decompress(void* output, size_t& output_size, void* input,
+                  size_t input_size) override {
+    auto* in = static_cast<unsigned char*>(input);
+    auto* out = static_cast<unsigned char*>(output);
+    size_t pos = 0;
+    for (size_t i = 0; i + 1 < input_size; i += 2) {
+      if (pos + in[i] > output_size) return false;
+      std::memset(out + pos, in[i + 1], in[i]);
+      pos += in[i];
+    }
+    output_size = pos;
+    return true;
+  }
+};
+
+ChunkedCodec::CompressorFactory RleFactory() {
+  return []() { return std::make_unique<RleCompressor>(); };
+}
+
+/** Runs of zeros with a few noisy chunks that RLE cannot shrink */
+std::vector<char> MakeBlob(size_t size, size_t chunk_size) {
+  std::vector<char> blob(size, 0);
+  for (size_t i = 0; i < size; ++i) {
+    if ((i / chunk_size) % 3 == 1) {
+      blob[i] = static_cast<char>((i * 2654435761u) >> 13);
+    } else {
+      blob[i] = static_cast<char>(i / 1000);
+    }
+  }
+  return blob;
+}
+
+/** Decompress [offset, offset + size) straight from a container */
+std::vector<char> ReadRange(const std::vector<char>& container,
+                            uint64_t offset, uint64_t size, size_t threads) {
+  ChunkedCompressionHeader header;
+  std::memcpy(&header, container.data(), sizeof(header));
+  const auto* table = reinterpret_cast<const ChunkTableEntry*>(
+      container.data() + sizeof(header));
+  uint32_t first = 0, last = 0;
+  REQUIRE(ChunkedCodec::ChunkSpan(header, offset, size, first, last));
+  const char* data = container.data() +
+                     ChunkedCodec::DataOffset(header.num_chunks_) +
+                     table[first].offset_;
+  std::vector<char> out(size);
+  uint64_t written = ChunkedCodec::DecompressRange(
+      RleFactory(), header, table, data, offset, size, out.data(), threads);
+  out.resize(written);
+  return out;
+}
+
+}  // namespace
+
+TEST_CASE("ChunkedCodec - Round Trip", "[compression][chunked]") {
+  const size_t chunk_size = 4096;
+  std::vector<char> blob = MakeBlob(10 * chunk_size + 123, chunk_size);
+
+  for (size_t threads : {1, 4}) {
+    std::vector<char> container;
+    REQUIRE(ChunkedCodec::Compress(RleFactory(), 7, 2, chunk_size, blob.data(),
+                                   blob.size(), threads, container));
+    REQUIRE(container.size() < blob.size());
+
+    ChunkedCompressionHeader header;
+    std::memcpy(&header, container.data(), sizeof(header));
+    REQUIRE(header.IsValid());
+    REQUIRE(header.num_chunks_ == 11);
+    REQUIRE(header.compress_lib_ == 7);
+    REQUIRE(header.original_size_ == blob.size());
+
+    // Noisy chunks are stored raw, the rest compressed
+    const auto* table = reinterpret_cast<const ChunkTableEntry*>(
+        container.data() + sizeof(header));
+    REQUIRE(table[1].flags_ == ChunkTableEntry::kRaw);
+    REQUIRE(table[0].flags_ == 0);
+
+    REQUIRE(ReadRange(container, 0, blob.size(), threads) == blob);
+  }
+}
+
+TEST_CASE("ChunkedCodec - Ranged Read", "[compression][chunked]") {
+  const size_t chunk_size = 4096;
+  std::vector<char> blob = MakeBlob(8 * chunk_size, chunk_size);
+  std::vector<char> container;
+  REQUIRE(ChunkedCodec::Compress(RleFactory(), 0, 2, chunk_size, blob.data(),
+                                 blob.size(), 3, container));
+
+  ChunkedCompressionHeader header;
+  std::memcpy(&header, container.data(), sizeof(header));
+  uint32_t first = 0, last = 0;
+  REQUIRE(ChunkedCodec::ChunkSpan(header, 5000, 5000, first, last));
+  REQUIRE(first == 1);
+  REQUIRE(last == 2);
+  REQUIRE_FALSE(ChunkedCodec::ChunkSpan(header, blob.size(), 10, first, last));
+
+  // Unaligned ranges inside one chunk, across chunks, and past the end
+  struct Range {
+    uint64_t offset, size;
+  };
+  for (Range r : {Range{100, 50}, Range{4000, 9000}, Range{8192, 4096},
+                  Range{30000, 10000}}) {
+    uint64_t expect = std::min<uint64_t>(r.size, blob.size() - r.offset);
+    std::vector<char> got = ReadRange(container, r.offset, r.size, 2);
+    REQUIRE(got.size() == expect);
+    REQUIRE(std::memcmp(got.data(), blob.data() + r.offset, expect) == 0);
+  }
+}
+
+TEST_CASE("ChunkedCodec - Missing Compressor", "[compression][chunked]") {
+  std::vector<char> blob(10000, 0);
+  std::vector<char> container;
+  REQUIRE_FALSE(ChunkedCodec::Compress(
+      []() { return std::unique_ptr<hshm::Compressor>(); }, 0, 2, 4096,
+      blob.data(), blob.size(), 2, container));
+}
+
+TEST_CASE("ChunkedCodec - Parse Index", "[compression][chunked]") {
+  const size_t chunk_size = 4096;
+  std::vector<char> blob = MakeBlob(5 * chunk_size, chunk_size);
+  std::vector<char> container;
+  REQUIRE(ChunkedCodec::Compress(RleFactory(), 0, 2, chunk_size, blob.data(),
+                                 blob.size(), 2, container));
+
+  ChunkIndex index;
+  REQUIRE(ChunkedCodec::ParseIndex(container.data(), container.size(), index));
+  REQUIRE(index.header_.num_chunks_ == 5);
+  REQUIRE(index.table_.size() == 5);
+  REQUIRE(index.table_[0].offset_ == 0);
+  REQUIRE(index.table_[1].offset_ == index.table_[0].size_);
+
+  // Too short for the table, or not a container at all
+  REQUIRE_FALSE(ChunkedCodec::ParseIndex(container.data(),
+                                         sizeof(ChunkedCompressionHeader), index));
+  REQUIRE_FALSE(ChunkedCodec::ParseIndex(blob.data(), blob.size(), index));
+}
+
+TEST_CASE("ChunkIndexCache - LRU and Erase", "[compression][chunked]") {
+  ChunkIndexCache cache(2);
+  std::string a = ChunkIndexCache::MakeKey(1, "a");
+  std::string b = ChunkIndexCache::MakeKey(1, "b");
+  std::string c = ChunkIndexCache::MakeKey(2, "a");
+  REQUIRE(a != c);
+
+  ChunkIndex index;
+  index.header_.num_chunks_ = 3;
+  cache.Insert(a, index);
+  cache.Insert(b, index);
+  REQUIRE(cache.Lookup(a) != nullptr);  // b is now the oldest
+  cache.Insert(c, index);
+  REQUIRE(cache.Size() == 2);
+  REQUIRE(cache.Lookup(b) == nullptr);
+  REQUIRE(cache.Lookup(a)->header_.num_chunks_ == 3);
+
+  cache.Erase(a);
+  REQUIRE(cache.Lookup(a) == nullptr);
+  REQUIRE(cache.Lookup(c) != nullptr);
+
+  ChunkIndexCache disabled(0);
+  disabled.Insert(a, index);
+  REQUIRE(disabled.Size() == 0);
+}
+
+SIMPLE_TEST_MAIN()
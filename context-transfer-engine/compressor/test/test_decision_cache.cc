@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file test_decision_cache.cc
+ * @brief Unit tests for the compression decision cache
+ */
+
+#include "wrp_cte/compressor/decision_cache.h"
+#include "../../../context-runtime/test/simple_test.h"
+
+using namespace wrp_cte::compressor;
+
+namespace {
+
+/** Build a feature set with the fields MakeKey quantizes */
+hshm::CompressionFeatureSet MakeFeatures(double entropy, double mad,
+                                         double second_derivative) {
+  hshm::CompressionFeatureSet features{};
+  features.shannon_entropy = entropy;
+  features.mad = mad;
+  features.second_derivative = second_derivative;
+  return features;
+}
+
+/** Build a dynamic-compression context for float data */
+wrp_cte::core::Context MakeContext() {
+  wrp_cte::core::Context context;
+  context.dynamic_compress_ = 2;
+  context.data_type_ = 1;
+  return context;
+}
+
+/** Build a distinct key per index */
+CompressionDecisionKey KeyFor(int i) {
+  return CompressionDecisionCache::MakeKey(
+      wrp_cte::core::TagId(1, static_cast<chi::u32>(i)),
+      MakeFeatures(4.0, 1.0, 0.5), 65536, MakeContext());
+}
+
+}  // namespace
+
+TEST_CASE("DecisionCache - Hit and Miss", "[compression][decision_cache]") {
+  CompressionDecisionCache cache(4);
+  REQUIRE(cache.Enabled());
+
+  CompressionDecision decision;
+  REQUIRE_FALSE(cache.Lookup(KeyFor(0), decision));
+  REQUIRE(cache.GetMisses() == 1);
+
+  CompressionDecision chosen;
+  chosen.compress_ = true;
+  chosen.compress_lib_ = 3;
+  chosen.compress_preset_ = 1;
+  chosen.tier_score_ = 0.5F;
+  cache.Insert(KeyFor(0), chosen);
+
+  REQUIRE(cache.Lookup(KeyFor(0), decision));
+  REQUIRE(cache.GetHits() == 1);
+  REQUIRE(decision.compress_);
+  REQUIRE(decision.compress_lib_ == 3);
+  REQUIRE(decision.compress_preset_ == 1);
+
+  cache.Clear();
+  REQUIRE(cache.Size() == 0);
+  REQUIRE_FALSE(cache.Lookup(KeyFor(0), decision));
+}
+
+TEST_CASE("DecisionCache - LRU Eviction", "[compression][decision_cache]") {
+  CompressionDecisionCache cache(2);
+  CompressionDecision decision;
+  cache.Insert(KeyFor(0), decision);
+  cache.Insert(KeyFor(1), decision);
+
+  // Touch 0 so that 1 becomes the oldest entry
+  REQUIRE(cache.Lookup(KeyFor(0), decision));
+  cache.Insert(KeyFor(2), decision);
+
+  REQUIRE(cache.Size() == 2);
+  REQUIRE(cache.Lookup(KeyFor(0), decision));
+  REQUIRE_FALSE(cache.Lookup(KeyFor(1), decision));
+  REQUIRE(cache.Lookup(KeyFor(2), decision));
+
+  cache.SetCapacity(1);
+  REQUIRE(cache.Size() == 1);
+  REQUIRE(cache.Lookup(KeyFor(2), decision));
+}
+
+TEST_CASE("DecisionCache - Disabled", "[compression][decision_cache]") {
+  CompressionDecisionCache cache(0);
+  REQUIRE_FALSE(cache.Enabled());
+  CompressionDecision decision;
+  cache.Insert(KeyFor(0), decision);
+  REQUIRE(cache.Size() == 0);
+}
+
+TEST_CASE("DecisionCache - Key Bucketing", "[compression][decision_cache]") {
+  wrp_cte::core::Context context = MakeContext();
+  wrp_cte::core::TagId tag(1, 7);
+
+  // Nearby samples of the same variable share a bucket
+  auto a = CompressionDecisionCache::MakeKey(tag, MakeFeatures(4.01, 1.0, 0.5),
+                                             65536, context);
+  auto b = CompressionDecisionCache::MakeKey(tag, MakeFeatures(4.05, 1.02, 0.51),
+                                             70000, context);
+  REQUIRE(a == b);
+  REQUIRE(CompressionDecisionKeyHash()(a) == CompressionDecisionKeyHash()(b));
+
+  // A different tag, entropy, size class or objective does not
+  auto other_tag = CompressionDecisionCache::MakeKey(
+      wrp_cte::core::TagId(1, 8), MakeFeatures(4.01, 1.0, 0.5), 65536, context);
+  REQUIRE_FALSE(a == other_tag);
+  auto other_entropy = CompressionDecisionCache::MakeKey(
+      tag, MakeFeatures(6.0, 1.0, 0.5), 65536, context);
+  REQUIRE_FALSE(a == other_entropy);
+  auto other_size = CompressionDecisionCache::MakeKey(
+      tag, MakeFeatures(4.01, 1.0, 0.5), 1 << 20, context);
+  REQUIRE_FALSE(a == other_size);
+  context.max_performance_ = true;
+  auto other_objective = CompressionDecisionCache::MakeKey(
+      tag, MakeFeatures(4.01, 1.0, 0.5), 65536, context);
+  REQUIRE_FALSE(a == other_objective);
+}
+
+SIMPLE_TEST_MAIN()
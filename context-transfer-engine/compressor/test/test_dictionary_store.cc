@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file test_dictionary_store.cc
+ * @brief Unit tests for tag dictionaries of small blobs
+ */
+
+#include "wrp_cte/compressor/dictionary_store.h"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "hermes_shm/compress/compress_factory.h"
+#include "../../../context-runtime/test/simple_test.h"
+
+using namespace wrp_cte::compressor;
+
+namespace {
+
+/** A small JSON particle record, like the per-blob metadata of a tag */
+std::string MakeRecord(std::mt19937& gen, int id) {
+  std::uniform_real_distribution<double> pos(0.0, 100.0);
+  char record[256];
+  std::snprintf(record, sizeof(record),
+                "{\"id\":%d,\"species\":\"electron\",\"x\":%.4f,\"y\":%.4f,"
+                "\"z\":%.4f,\"charge\":-1,\"mass\":9.109e-31,\"alive\":true}",
+                id, pos(gen), pos(gen), pos(gen));
+  return record;
+}
+
+/** Collect num_samples records into a training batch */
+DictionarySamples MakeSamples(size_t num_samples) {
+  std::mt19937 gen(11);
+  DictionarySamples batch;
+  for (size_t i = 0; i < num_samples; ++i) {
+    std::string record = MakeRecord(gen, static_cast<int>(i));
+    batch.data_.insert(batch.data_.end(), record.begin(), record.end());
+    batch.sizes_.push_back(record.size());
+  }
+  return batch;
+}
+
+}  // namespace
+
+TEST_CASE("ZstdDictionary - Train and Round Trip", "[compression][dictionary]") {
+  DictionarySamples batch = MakeSamples(2048);
+  auto dict = hshm::ZstdDictionary::Train(batch.data_, batch.sizes_, 4096);
+  REQUIRE(dict != nullptr);
+  REQUIRE(dict->Id() != 0);
+  REQUIRE(dict->Data().size() <= 4096);
+
+  std::mt19937 gen(99);
+  std::string record = MakeRecord(gen, 100000);
+  std::vector<char> plain(1024);
+  std::vector<char> with_dict(1024);
+  size_t plain_size = plain.size();
+  size_t dict_size = with_dict.size();
+  hshm::ZstdWithModes zstd(hshm::LosslessMode::BALANCED);
+  hshm::ZstdDictCompressor dict_zstd(dict, hshm::LosslessMode::BALANCED);
+  REQUIRE(zstd.Compress(plain.data(), plain_size, record.data(),
+                        record.size()));
+  REQUIRE(dict_zstd.Compress(with_dict.data(), dict_size, record.data(),
+                             record.size()));
+  REQUIRE(dict_size < plain_size);
+
+  // A dictionary reloaded from its bytes decodes the same frames
+  auto loaded = hshm::ZstdDictionary::Load(dict->Data().data(),
+                                           dict->Data().size());
+  REQUIRE(loaded != nullptr);
+  REQUIRE(loaded->Id() == dict->Id());
+  hshm::ZstdDictCompressor loaded_zstd(loaded, hshm::LosslessMode::BALANCED);
+  std::vector<char> output(1024);
+  size_t output_size = output.size();
+  REQUIRE(loaded_zstd.Decompress(output.data(), output_size, with_dict.data(),
+                                 dict_size));
+  REQUIRE(std::string(output.data(), output_size) == record);
+
+  REQUIRE(hshm::ZstdDictionary::Load(record.data(), record.size()) == nullptr);
+}
+
+TEST_CASE("TagDictionaryStore - Sampling", "[compression][dictionary]") {
+  DictionarySamples training = MakeSamples(2048);
+  TagDictionaryStore::DictPtr dict =
+      hshm::ZstdDictionary::Train(training.data_, training.sizes_, 4096);
+  REQUIRE(dict != nullptr);
+
+  TagDictionaryStore store;
+  store.Configure(3, 1 << 20);
+  DictionarySamples batch;
+  const char sample[] = "{\"id\":1}";
+  REQUIRE_FALSE(store.AddSample(7, sample, sizeof(sample), batch));
+  REQUIRE_FALSE(store.AddSample(7, sample, sizeof(sample), batch));
+  REQUIRE(store.AddSample(7, sample, sizeof(sample), batch));
+  REQUIRE(batch.sizes_.size() == 3);
+  REQUIRE(batch.data_.size() == 3 * sizeof(sample));
+
+  // Only the caller that filled the batch trains it
+  DictionarySamples ignored;
+  REQUIRE_FALSE(store.AddSample(7, sample, sizeof(sample), ignored));
+  REQUIRE(store.Current(7) == nullptr);
+
+  store.Publish(7, dict->Id(), dict);
+  REQUIRE(store.Current(7) == dict);
+  REQUIRE(store.Find(7, dict->Id()) == dict);
+  REQUIRE(store.Find(8, dict->Id()) == nullptr);
+
+  // A failed tag stops sampling; a loaded dictionary is found, not current
+  store.Fail(8);
+  REQUIRE_FALSE(store.AddSample(8, sample, sizeof(sample), ignored));
+  REQUIRE_FALSE(store.AddSample(8, sample, sizeof(sample), ignored));
+  REQUIRE_FALSE(store.AddSample(8, sample, sizeof(sample), ignored));
+  store.Insert(9, dict->Id(), dict);
+  REQUIRE(store.Find(9, dict->Id()) == dict);
+  REQUIRE(store.Current(9) == nullptr);
+}
+
+TEST_CASE("TagDictionaryStore - Byte Budget and Disable",
+          "[compression][dictionary]") {
+  TagDictionaryStore store;
+  std::vector<char> blob(600, 'a');
+  DictionarySamples batch;
+
+  // The batch also fills once it reaches the byte budget
+  store.Configure(100, 1000);
+  REQUIRE_FALSE(store.AddSample(1, blob.data(), blob.size(), batch));
+  REQUIRE(store.AddSample(1, blob.data(), blob.size(), batch));
+  REQUIRE(batch.sizes_.size() == 2);
+
+  store.Configure(0, 1000);
+  REQUIRE_FALSE(store.AddSample(2, blob.data(), blob.size(), batch));
+  REQUIRE_FALSE(store.AddSample(2, blob.data(), blob.size(), batch));
+}
+
+SIMPLE_TEST_MAIN()
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file test_error_bound.cc
+ * @brief Unit tests for lossy error bounds of tags
+ */
+
+#include "wrp_cte/compressor/error_bound.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "../../../context-runtime/test/simple_test.h"
+
+using namespace wrp_cte::compressor;
+
+/** Smooth signal in [-1, 1] */
+static std::vector<float> MakeSignal(size_t count) {
+  std::vector<float> data(count);
+  for (size_t i = 0; i < count; ++i) {
+    data[i] = static_cast<float>(std::sin(static_cast<double>(i) * 0.01));
+  }
+  return data;
+}
+
+TEST_CASE("ErrorBound - absolute and relative bounds",
+          "[compression][error_bound]") {
+  std::vector<float> original = MakeSignal(40000);
+  std::vector<float> recon = original;
+  for (auto& v : recon) {
+    v += 0.001F;
+  }
+  double range =
+      ErrorBoundChecker::ValueRange(original.data(), original.size());
+  REQUIRE(range > 1.9);
+  double psnr = 0.0;
+
+  TagErrorBound abs_ok(ErrorBoundMode::kAbsolute, 0.01);
+  REQUIRE(ErrorBoundChecker::Check(abs_ok, original.data(), recon.data(),
+                                   original.size(), range, psnr));
+  REQUIRE(psnr > 0.0);
+  TagErrorBound abs_tight(ErrorBoundMode::kAbsolute, 0.0001);
+  REQUIRE_FALSE(ErrorBoundChecker::Check(abs_tight, original.data(),
+                                         recon.data(), original.size(), range,
+                                         psnr));
+
+  // 0.001 is 0.05% of the range
+  TagErrorBound rel_ok(ErrorBoundMode::kRelative, 0.001);
+  REQUIRE(ErrorBoundChecker::Check(rel_ok, original.data(), recon.data(),
+                                   original.size(), range, psnr));
+  TagErrorBound rel_tight(ErrorBoundMode::kRelative, 0.0001);
+  REQUIRE_FALSE(ErrorBoundChecker::Check(rel_tight, original.data(),
+                                         recon.data(), original.size(), range,
+                                         psnr));
+}
+
+TEST_CASE("ErrorBound - PSNR bound", "[compression][error_bound]") {
+  std::vector<float> original = MakeSignal(20000);
+  std::vector<float> recon = original;
+  double range =
+      ErrorBoundChecker::ValueRange(original.data(), original.size());
+  double psnr = 0.0;
+  TagErrorBound bound(ErrorBoundMode::kPsnr, 40.0);
+
+  // An exact reconstruction passes any bound
+  REQUIRE(ErrorBoundChecker::Check(bound, original.data(), recon.data(),
+                                   original.size(), range, psnr));
+  REQUIRE(psnr == 0.0);
+
+  for (auto& v : recon) {
+    v += 0.001F;
+  }
+  REQUIRE(ErrorBoundChecker::Check(bound, original.data(), recon.data(),
+                                   original.size(), range, psnr));
+  REQUIRE(psnr > 40.0);
+
+  // Noise larger than the signal: CalculatePSNR clamps to 0, which must
+  // not read as exact
+  for (size_t i = 0; i < recon.size(); ++i) {
+    recon[i] = original[i] + ((i % 2 == 0) ? 5.0F : -5.0F);
+  }
+  REQUIRE_FALSE(ErrorBoundChecker::Check(bound, original.data(), recon.data(),
+                                         original.size(), range, psnr));
+}
+
+TEST_CASE("ErrorBound - non-finite values", "[compression][error_bound]") {
+  std::vector<float> original = MakeSignal(1000);
+  original[10] = std::numeric_limits<float>::quiet_NaN();
+  std::vector<float> recon = original;
+  double range = 2.0;
+  double psnr = 0.0;
+  TagErrorBound bound(ErrorBoundMode::kAbsolute, 0.5);
+
+  // A NaN kept as NaN is not an error
+  REQUIRE(ErrorBoundChecker::Check(bound, original.data(), recon.data(),
+                                   original.size(), range, psnr));
+
+  // A NaN the codec introduced fails any bound
+  recon[20] = std::numeric_limits<float>::quiet_NaN();
+  REQUIRE_FALSE(ErrorBoundChecker::Check(bound, original.data(), recon.data(),
+                                         original.size(), range, psnr));
+}
+
+TEST_CASE("ErrorBound - sampled blocks", "[compression][error_bound]") {
+  const size_t kBlock = ErrorBoundChecker::kBlockFloats;
+  size_t count = kBlock * 10 + 100;
+  auto blocks = ErrorBoundChecker::SampleBlocks(count, 4);
+  REQUIRE(blocks.size() == 4);
+  REQUIRE(blocks.front().first == 0);
+  REQUIRE(blocks.front().second == kBlock);
+  // The short last block is always checked
+  REQUIRE(blocks.back().first == kBlock * 10);
+  REQUIRE(blocks.back().second == 100);
+  for (size_t i = 1; i < blocks.size(); ++i) {
+    REQUIRE(blocks[i].first > blocks[i - 1].first);
+  }
+
+  // Fewer blocks than wanted: every block is checked once
+  REQUIRE(ErrorBoundChecker::SampleBlocks(kBlock + 1, 8).size() == 2);
+  REQUIRE(ErrorBoundChecker::SampleBlocks(0, 4).empty());
+
+  // An unsampled block is not checked
+  std::vector<float> original = MakeSignal(count);
+  std::vector<float> recon = original;
+  recon[kBlock + 5] += 1.0F;
+  TagErrorBound bound(ErrorBoundMode::kAbsolute, 0.1, 2);
+  double psnr = 0.0;
+  REQUIRE(ErrorBoundChecker::Check(bound, original.data(), recon.data(),
+                                   count, 2.0, psnr));
+  recon[kBlock * 10 + 5] += 1.0F;
+  REQUIRE_FALSE(ErrorBoundChecker::Check(bound, original.data(), recon.data(),
+                                         count, 2.0, psnr));
+}
+
+TEST_CASE("ErrorBound - unset bound", "[compression][error_bound]") {
+  REQUIRE_FALSE(TagErrorBound().IsSet());
+  REQUIRE_FALSE(TagErrorBound(ErrorBoundMode::kAbsolute, 0.0).IsSet());
+  REQUIRE(TagErrorBound(ErrorBoundMode::kPsnr, 30.0).IsSet());
+}
+
+SIMPLE_TEST_MAIN()
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file test_model_feedback.cc
+ * @brief Unit tests for refitting the predictors from observed outcomes
+ */
+
+#include <cmath>
+#include <vector>
+
+#include "../../../context-runtime/test/simple_test.h"
+#include "wrp_cte/compressor/feedback_ring.h"
+#include "wrp_cte/compressor/models/linreg_table_predictor.h"
+#include "wrp_cte/compressor/models/qtable_predictor.h"
+
+using namespace wrp_cte::compressor;
+
+namespace {
+
+/** Build the features of a zstd-fast char chunk */
+CompressionFeatures MakeFeatures(double chunk_size, double entropy) {
+  CompressionFeatures f;
+  f.chunk_size_bytes = chunk_size;
+  f.shannon_entropy = entropy;
+  f.mad = 0.5;
+  f.second_derivative_mean = 1.0;
+  f.library_config_id = 20;  // ZSTD fast in the LinReg encoding
+  f.config_fast = 1;
+  f.data_type_char = 1;
+  return f;
+}
+
+/** Build an observed outcome */
+RLExperience MakeExperience(const CompressionFeatures& f, double ratio,
+                            double time_ms) {
+  RLExperience exp;
+  exp.features = f;
+  exp.actual_ratio = ratio;
+  exp.actual_compress_time = time_ms;
+  return exp;
+}
+
+/** Build an RL config with a given batch and learning rate */
+RLConfig MakeRLConfig(size_t batch_size, double learning_rate) {
+  RLConfig config;
+  config.batch_size = batch_size;
+  config.learning_rate = learning_rate;
+  return config;
+}
+
+}  // namespace
+
+TEST_CASE("FeedbackRing - Overwrites Oldest", "[compression][feedback]") {
+  CompressionFeedbackRing ring(3);
+  REQUIRE(ring.Enabled());
+  for (int i = 0; i < 5; ++i) {
+    ring.Push(MakeExperience(MakeFeatures(4096, 4.0), i, 1.0));
+  }
+  REQUIRE(ring.Size() == 3);
+  REQUIRE(ring.GetDropped() == 2);
+
+  auto drained = ring.Drain();
+  REQUIRE(drained.size() == 3);
+  REQUIRE(drained[0].actual_ratio == 2.0);
+  REQUIRE(drained[2].actual_ratio == 4.0);
+  REQUIRE(ring.Size() == 0);
+
+  CompressionFeedbackRing disabled;
+  REQUIRE_FALSE(disabled.Enabled());
+  disabled.Push(MakeExperience(MakeFeatures(4096, 4.0), 1.0, 1.0));
+  REQUIRE(disabled.Size() == 0);
+}
+
+TEST_CASE("QTablePredictor - Feedback Moves Predictions",
+          "[compression][feedback][qtable]") {
+  std::vector<CompressionFeatures> features;
+  std::vector<TrainingLabels> labels;
+  for (int i = 0; i < 100; ++i) {
+    features.push_back(MakeFeatures(32768 + (i % 10) * 8192, 2.0 + (i % 8)));
+    TrainingLabels label;
+    label.compression_ratio = 2.0f;
+    label.compression_time_ms = 5.0f;
+    labels.push_back(label);
+  }
+
+  QTablePredictor predictor;
+  // An untrained table has no binning edges to place outcomes with
+  predictor.RecordExperience(MakeExperience(features[0], 8.0, 1.0));
+  REQUIRE_FALSE(predictor.UpdateFromExperiences(MakeRLConfig(1, 0.5)));
+  predictor.ClearExperiences();
+
+  REQUIRE(predictor.Train(features, labels));
+  double before = predictor.Predict(features[0]).compression_ratio;
+
+  for (int i = 0; i < 4; ++i) {
+    predictor.RecordExperience(MakeExperience(features[0], 8.0, 1.0));
+  }
+  // Below the batch size nothing changes
+  REQUIRE_FALSE(predictor.UpdateFromExperiences(MakeRLConfig(8, 0.5)));
+  REQUIRE(predictor.UpdateFromExperiences(MakeRLConfig(4, 0.5)));
+  REQUIRE(predictor.GetExperienceCount() == 0);
+
+  double after = predictor.Predict(features[0]).compression_ratio;
+  REQUIRE(before == 2.0);
+  REQUIRE(after > 7.0);
+  REQUIRE(after < 8.0);
+}
+
+TEST_CASE("LinRegTablePredictor - Feedback Refits Keys",
+          "[compression][feedback][linreg]") {
+  LinRegTablePredictor predictor;
+  REQUIRE_FALSE(predictor.IsReady());
+
+  // An unseen key takes the fit of its outcomes as is
+  for (int i = 0; i < 20; ++i) {
+    double size = 16384.0 * (i + 1);
+    predictor.RecordExperience(
+        MakeExperience(MakeFeatures(size, 4.0), 3.0, 0.001 * size + 1.0));
+  }
+  // Too few outcomes of another key to fit; they stay buffered
+  CompressionFeatures other = MakeFeatures(4096, 4.0);
+  other.library_config_id = 30;  // LZ4 fast
+  for (int i = 0; i < 3; ++i) {
+    predictor.RecordExperience(MakeExperience(other, 1.5, 0.1));
+  }
+  REQUIRE(predictor.UpdateFromExperiences(MakeRLConfig(8, 0.25)));
+  REQUIRE(predictor.IsReady());
+  REQUIRE(predictor.GetNumModels() == 1);
+  REQUIRE(predictor.GetExperienceCount() == 3);
+
+  auto pred = predictor.PredictByKey("ZSTD", "fast", "char", 100000.0);
+  REQUIRE(std::abs(pred.compression_time_ms - 101.0) < 1e-6);
+  REQUIRE(std::abs(pred.compression_ratio - 3.0) < 1e-6);
+
+  // A known key moves by the learning rate toward the new fit
+  predictor.ClearExperiences();
+  for (int i = 0; i < 20; ++i) {
+    double size = 16384.0 * (i + 1);
+    predictor.RecordExperience(
+        MakeExperience(MakeFeatures(size, 4.0), 5.0, 0.003 * size + 1.0));
+  }
+  REQUIRE(predictor.UpdateFromExperiences(MakeRLConfig(8, 0.25)));
+  pred = predictor.PredictByKey("ZSTD", "fast", "char", 100000.0);
+  REQUIRE(std::abs(pred.compression_time_ms - 151.0) < 1e-6);
+  REQUIRE(std::abs(pred.compression_ratio - 3.5) < 1e-6);
+}
+
+SIMPLE_TEST_MAIN()
@@ -0,0 +1,601 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * Gray-Scott I/O Pipeline Benchmark
+ *
+ * End-to-end regression benchmark for the in-situ staging path. A 3D
+ * Gray-Scott reaction-diffusion simulation stages its u and v fields into
+ * CTE every plotgap steps while an analysis thread reads each staged step
+ * back and reduces it to a PDF, as the iowarp-gray-scott pdf_calc reader
+ * does. The same simulation is first run without any I/O, so one
+ * invocation reports the step-time overhead of staging, the latency from a
+ * step's data being ready to the reader holding it, and the compression
+ * ratio achieved on the staged fields.
+ *
+ * Usage:
+ *   wrp_cte_gs_pipeline <compress_type> <grid_size> <steps> <plotgap>
+ *
+ * Parameters:
+ *   compress_type: none (stage through the CTE core directly), dynamic, or a
+ *                  library (zstd, lz4, zlib, snappy, brotli, blosc2, bzip2,
+ *                  lzma, fpzip, sz3, zfp) staged through the compressor
+ *   grid_size: Edge length L of the L^3 domain
+ *   steps: Simulation steps per phase
+ *   plotgap: Steps between staged outputs
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <chimaera/chimaera.h>
+#include <hermes_shm/util/logging.h>
+#include <wrp_cte/compressor/compressor_client.h>
+#include <wrp_cte/core/core_client.h>
+#include <wrp_cte/core/core_tasks.h>
+
+using namespace std::chrono;
+
+namespace {
+
+// Compression library IDs (from core_runtime.cc)
+enum CompressionLib {
+  kBrotli = 0,
+  kBzip2 = 1,
+  kBlosc2 = 2,
+  kFpzip = 3,
+  kLz4 = 4,
+  kLzma = 5,
+  kSnappy = 6,
+  kSz3 = 7,
+  kZfp = 8,
+  kZlib = 9,
+  kZstd = 10,
+};
+
+/** Bins of the analysis PDF, as in pdf_calc */
+constexpr size_t kPdfBins = 100;
+
+/** Gray-Scott parameters, matching the GPU gray_scott workload */
+struct GSParams {
+  float Du = 0.05f;
+  float Dv = 0.1f;
+  float F = 0.04f;
+  float k = 0.06075f;
+  float dt = 0.2f;
+  float noise = 1e-7f;
+};
+
+/**
+ * Parse compression type string to library ID and dynamic mode
+ * @param type_str Compression type string
+ * @param dynamic_compress Output: 0=none, 1=static, 2=dynamic
+ * @param compress_lib Output: Library ID for static compression
+ * @return true if valid compression type
+ */
+bool ParseCompressionType(const std::string &type_str, int &dynamic_compress,
+                          int &compress_lib) {
+  static const std::pair<const char *, int> kLibs[] = {
+      {"brotli", kBrotli}, {"bzip2", kBzip2}, {"blosc2", kBlosc2},
+      {"fpzip", kFpzip},   {"lz4", kLz4},     {"lzma", kLzma},
+      {"snappy", kSnappy}, {"sz3", kSz3},     {"zfp", kZfp},
+      {"zlib", kZlib},     {"zstd", kZstd},
+  };
+  if (type_str == "none") {
+    dynamic_compress = 0;
+    compress_lib = 0;
+    return true;
+  }
+  if (type_str == "dynamic") {
+    dynamic_compress = 2;
+    compress_lib = kZstd;
+    return true;
+  }
+  for (const auto &[name, lib] : kLibs) {
+    if (type_str == name) {
+      dynamic_compress = 1;
+      compress_lib = lib;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Percentile of a sample set
+ * @param values Samples (sorted in place)
+ * @param p Percentile in [0, 1]
+ * @return The sample at p, or 0 when there are none
+ */
+double Percentile(std::vector<double> &values, double p) {
+  if (values.empty()) return 0.0;
+  std::sort(values.begin(), values.end());
+  size_t idx = static_cast<size_t>(p * (values.size() - 1) + 0.5);
+  return values[idx];
+}
+
+/**
+ * 3D Gray-Scott simulation on a periodic L^3 grid, single threaded like
+ * one rank of the iowarp-gray-scott simulation.
+ */
+class GrayScott {
+ public:
+  /**
+   * Seed the domain: u = 1 and v = 0 except for a cube in the center
+   * @param L Edge length of the domain
+   * @param params Reaction-diffusion parameters
+   */
+  GrayScott(int L, const GSParams &params)
+      : L_(L), params_(params), rng_(42), noise_(-1.0f, 1.0f) {
+    size_t cells = static_cast<size_t>(L) * L * L;
+    u_.assign(cells, 1.0f);
+    v_.assign(cells, 0.0f);
+    u2_.resize(cells);
+    v2_.resize(cells);
+    int lo = L / 2 - L / 8, hi = L / 2 + L / 8;
+    for (int z = lo; z < hi; ++z) {
+      for (int y = lo; y < hi; ++y) {
+        for (int x = lo; x < hi; ++x) {
+          u_[Index(x, y, z)] = 0.25f;
+          v_[Index(x, y, z)] = 0.33f;
+        }
+      }
+    }
+  }
+
+  /** Advance the simulation by one step */
+  void Iterate() {
+    const GSParams &p = params_;
+    for (int z = 0; z < L_; ++z) {
+      for (int y = 0; y < L_; ++y) {
+        for (int x = 0; x < L_; ++x) {
+          size_t i = Index(x, y, z);
+          float u = u_[i], v = v_[i];
+          float uvv = u * v * v;
+          float du = p.Du * Laplacian(u_, x, y, z) - uvv + p.F * (1.0f - u);
+          float dv = p.Dv * Laplacian(v_, x, y, z) + uvv - (p.F + p.k) * v;
+          u2_[i] = u + p.dt * (du + p.noise * noise_(rng_));
+          v2_[i] = v + p.dt * dv;
+        }
+      }
+    }
+    u_.swap(u2_);
+    v_.swap(v2_);
+  }
+
+  const std::vector<float> &U() const { return u_; }
+  const std::vector<float> &V() const { return v_; }
+
+ private:
+  size_t Index(int x, int y, int z) const {
+    x = (x + L_) % L_;
+    y = (y + L_) % L_;
+    z = (z + L_) % L_;
+    return static_cast<size_t>(z) * L_ * L_ + static_cast<size_t>(y) * L_ + x;
+  }
+
+  float Laplacian(const std::vector<float> &s, int x, int y, int z) const {
+    float sum = s[Index(x - 1, y, z)] + s[Index(x + 1, y, z)] +
+                s[Index(x, y - 1, z)] + s[Index(x, y + 1, z)] +
+                s[Index(x, y, z - 1)] + s[Index(x, y, z + 1)] -
+                6.0f * s[Index(x, y, z)];
+    return sum / 6.0f;
+  }
+
+  int L_;
+  GSParams params_;
+  std::mt19937 rng_;
+  std::uniform_real_distribution<float> noise_;
+  std::vector<float> u_, v_, u2_, v2_;
+};
+
+/** A staged step the analysis reader has not consumed yet */
+struct StagedStep {
+  int step_;
+  high_resolution_clock::time_point ready_;  // When compute produced it
+};
+
+/** Stages blobs through the CTE core without compression */
+struct CoreStager {
+  wrp_cte::core::Client &client_;
+
+  chi::Future<wrp_cte::core::PutBlobTask> AsyncPut(
+      const wrp_cte::core::TagId &tag_id, const std::string &name,
+      chi::u64 size, hipc::ShmPtr<> data, const wrp_cte::core::Context &ctx) {
+    return client_.AsyncPutBlob(tag_id, name, 0, size, data, 1.0f, ctx);
+  }
+
+  chi::Future<wrp_cte::core::GetBlobTask> AsyncGet(
+      const wrp_cte::core::TagId &tag_id, const std::string &name,
+      chi::u64 size, hipc::ShmPtr<> data) {
+    return client_.AsyncGetBlob(tag_id, name, 0, size, 0, data);
+  }
+};
+
+/** Stages blobs through the compressor in front of a core pool */
+struct CompressStager {
+  wrp_cte::compressor::Client &client_;
+  chi::PoolId core_pool_id_;
+
+  chi::Future<wrp_cte::compressor::DynamicScheduleTask> AsyncPut(
+      const wrp_cte::core::TagId &tag_id, const std::string &name,
+      chi::u64 size, hipc::ShmPtr<> data, const wrp_cte::core::Context &ctx) {
+    return client_.AsyncDynamicSchedule(chi::PoolQuery::Local(), tag_id, name,
+                                        0, size, data, 1.0f, ctx, 0,
+                                        core_pool_id_);
+  }
+
+  chi::Future<wrp_cte::compressor::DecompressTask> AsyncGet(
+      const wrp_cte::core::TagId &tag_id, const std::string &name,
+      chi::u64 size, hipc::ShmPtr<> data) {
+    return client_.AsyncDecompressExplicit(chi::PoolQuery::Local(), tag_id,
+                                           name, 0, size, 0, data,
+                                           core_pool_id_);
+  }
+};
+
+/**
+ * Simulation writer plus concurrent analysis reader over one stager
+ * (CoreStager or CompressStager)
+ */
+template <typename StagerT>
+class GsPipeline {
+ public:
+  GsPipeline(StagerT &stager, const wrp_cte::core::TagId &tag_id,
+             const wrp_cte::core::Context &ctx, int L, int steps, int plotgap)
+      : stager_(stager),
+        tag_id_(tag_id),
+        ctx_(ctx),
+        L_(L),
+        steps_(steps),
+        plotgap_(plotgap),
+        field_size_(static_cast<chi::u64>(L) * L * L * sizeof(float)) {}
+
+  /**
+   * Run the simulation with no I/O
+   * @return Mean step time in milliseconds
+   */
+  double RunBaseline() {
+    GrayScott sim(L_, GSParams());
+    auto start = high_resolution_clock::now();
+    for (int step = 1; step <= steps_; ++step) {
+      sim.Iterate();
+    }
+    auto end = high_resolution_clock::now();
+    return duration<double, std::milli>(end - start).count() / steps_;
+  }
+
+  /**
+   * Run the simulation staging every plotgap steps while the analysis
+   * reader consumes them
+   * @return Mean step time in milliseconds
+   */
+  double RunPipeline() {
+    GrayScott sim(L_, GSParams());
+    std::thread reader(&GsPipeline::ReaderLoop, this);
+    auto start = high_resolution_clock::now();
+    for (int step = 1; step <= steps_; ++step) {
+      sim.Iterate();
+      if (step % plotgap_ == 0) {
+        Stage(sim, step);
+      }
+    }
+    auto end = high_resolution_clock::now();
+    {
+      std::lock_guard<std::mutex> lock(queue_lock_);
+      writer_done_ = true;
+    }
+    queue_cv_.notify_one();
+    reader.join();
+    return duration<double, std::milli>(end - start).count() / steps_;
+  }
+
+  /** Ratio of bytes staged to bytes stored */
+  double CompressionRatio() const {
+    return stored_bytes_ ? static_cast<double>(staged_bytes_) / stored_bytes_
+                         : 1.0;
+  }
+
+  std::vector<double> &StagingLatencies() { return staging_ms_; }
+  size_t StagedSteps() const { return staged_steps_; }
+  size_t AnalyzedSteps() const { return analyzed_steps_; }
+  size_t Failures() const { return failures_; }
+
+ private:
+  static std::string BlobName(const char *var, int step) {
+    return std::string(var) + "/step" + std::to_string(step);
+  }
+
+  /**
+   * Put u and v of the current step and hand it to the reader once both
+   * are stored
+   */
+  void Stage(const GrayScott &sim, int step) {
+    auto ready = high_resolution_clock::now();
+    auto *ipc_manager = CHI_IPC;
+    const char *vars[] = {"u", "v"};
+    const std::vector<float> *fields[] = {&sim.U(), &sim.V()};
+    hipc::FullPtr<char> buffers[2];
+    for (int i = 0; i < 2; ++i) {
+      buffers[i] = ipc_manager->AllocateBuffer(field_size_);
+      if (buffers[i].IsNull()) {
+        HLOG(kError, "Failed to allocate {} bytes for step {}", field_size_,
+             step);
+        ++failures_;
+        for (int j = 0; j < i; ++j) ipc_manager->FreeBuffer(buffers[j]);
+        return;
+      }
+      std::memcpy(buffers[i].ptr_, fields[i]->data(), field_size_);
+    }
+    auto put_u = stager_.AsyncPut(tag_id_, BlobName(vars[0], step),
+                                  field_size_,
+                                  buffers[0].shm_.template Cast<void>(), ctx_);
+    auto put_v = stager_.AsyncPut(tag_id_, BlobName(vars[1], step),
+                                  field_size_,
+                                  buffers[1].shm_.template Cast<void>(), ctx_);
+    put_u.Wait();
+    put_v.Wait();
+    bool ok = true;
+    for (auto *put : {&put_u, &put_v}) {
+      if ((*put)->GetReturnCode() != 0) {
+        ok = false;
+        continue;
+      }
+      // The compressor leaves the sizes unset when it stored the blob raw
+      const wrp_cte::core::Context &out = (*put)->context_;
+      staged_bytes_ += field_size_;
+      stored_bytes_ += out.actual_compressed_size_ ? out.actual_compressed_size_
+                                                   : field_size_;
+    }
+    for (auto &buffer : buffers) ipc_manager->FreeBuffer(buffer);
+    if (!ok) {
+      HLOG(kError, "Staging step {} failed", step);
+      ++failures_;
+      return;
+    }
+    ++staged_steps_;
+    {
+      std::lock_guard<std::mutex> lock(queue_lock_);
+      queue_.push_back(StagedStep{step, ready});
+    }
+    queue_cv_.notify_one();
+  }
+
+  /** Analysis reader: fetch each staged step and reduce v to a PDF */
+  void ReaderLoop() {
+    auto *ipc_manager = CHI_IPC;
+    hipc::FullPtr<char> u_buf = ipc_manager->AllocateBuffer(field_size_);
+    hipc::FullPtr<char> v_buf = ipc_manager->AllocateBuffer(field_size_);
+    std::vector<size_t> pdf(kPdfBins);
+    while (true) {
+      StagedStep staged;
+      {
+        std::unique_lock<std::mutex> lock(queue_lock_);
+        queue_cv_.wait(lock, [this] { return writer_done_ || !queue_.empty(); });
+        if (queue_.empty()) break;
+        staged = queue_.front();
+        queue_.pop_front();
+      }
+      if (u_buf.IsNull() || v_buf.IsNull()) {
+        ++failures_;
+        continue;
+      }
+      auto get_u = stager_.AsyncGet(tag_id_, BlobName("u", staged.step_),
+                                    field_size_,
+                                    u_buf.shm_.template Cast<void>());
+      auto get_v = stager_.AsyncGet(tag_id_, BlobName("v", staged.step_),
+                                    field_size_,
+                                    v_buf.shm_.template Cast<void>());
+      get_u.Wait();
+      get_v.Wait();
+      if (get_u->GetReturnCode() != 0 || get_v->GetReturnCode() != 0) {
+        HLOG(kError, "Reading step {} failed", staged.step_);
+        ++failures_;
+        continue;
+      }
+      auto received = high_resolution_clock::now();
+      staging_ms_.push_back(
+          duration<double, std::milli>(received - staged.ready_).count());
+      ComputePdf(reinterpret_cast<const float *>(v_buf.ptr_), pdf);
+      ++analyzed_steps_;
+    }
+    if (!u_buf.IsNull()) ipc_manager->FreeBuffer(u_buf);
+    if (!v_buf.IsNull()) ipc_manager->FreeBuffer(v_buf);
+  }
+
+  /** Histogram of a field over its own [min, max] */
+  void ComputePdf(const float *field, std::vector<size_t> &pdf) const {
+    size_t cells = field_size_ / sizeof(float);
+    auto [lo, hi] = std::minmax_element(field, field + cells);
+    float width = (*hi - *lo) / kPdfBins;
+    std::fill(pdf.begin(), pdf.end(), 0);
+    for (size_t i = 0; i < cells; ++i) {
+      size_t bin = width > 0.0f
+                       ? static_cast<size_t>((field[i] - *lo) / width)
+                       : 0;
+      ++pdf[std::min(bin, kPdfBins - 1)];
+    }
+  }
+
+  StagerT &stager_;
+  wrp_cte::core::TagId tag_id_;
+  wrp_cte::core::Context ctx_;
+  int L_;
+  int steps_;
+  int plotgap_;
+  chi::u64 field_size_;
+
+  std::mutex queue_lock_;
+  std::condition_variable queue_cv_;
+  std::deque<StagedStep> queue_;
+  bool writer_done_ = false;
+
+  chi::u64 staged_bytes_ = 0;
+  chi::u64 stored_bytes_ = 0;
+  size_t staged_steps_ = 0;
+  size_t analyzed_steps_ = 0;
+  std::atomic<size_t> failures_{0};
+  std::vector<double> staging_ms_;
+};
+
+/**
+ * Run both phases and print the regression metrics
+ * @return Process exit code
+ */
+template <typename StagerT>
+int RunBenchmark(StagerT &stager, const wrp_cte::core::TagId &tag_id,
+                 const std::string &compress_type,
+                 const wrp_cte::core::Context &ctx, int L, int steps,
+                 int plotgap) {
+  GsPipeline<StagerT> pipeline(stager, tag_id, ctx, L, steps, plotgap);
+
+  double baseline_ms = pipeline.RunBaseline();
+  double pipeline_ms = pipeline.RunPipeline();
+  std::vector<double> &latencies = pipeline.StagingLatencies();
+  double p50 = Percentile(latencies, 0.50);
+  double p99 = Percentile(latencies, 0.99);
+  double step_ratio = baseline_ms > 0.0 ? pipeline_ms / baseline_ms : 0.0;
+
+  HLOG(kInfo, "");
+  HLOG(kInfo, "=== Gray-Scott I/O Pipeline ===");
+  HLOG(kInfo, "Compression:          {}", compress_type);
+  HLOG(kInfo, "Grid:                 {}^3 ({} MB per field)", L,
+       static_cast<double>(L * L * L * sizeof(float)) / (1024.0 * 1024.0));
+  HLOG(kInfo, "Steps / plotgap:      {} / {}", steps, plotgap);
+  HLOG(kInfo, "Staged steps:         {}", pipeline.StagedSteps());
+  HLOG(kInfo, "Analyzed steps:       {}", pipeline.AnalyzedSteps());
+  HLOG(kInfo, "Baseline step time:   {:.3f} ms", baseline_ms);
+  HLOG(kInfo, "Pipeline step time:   {:.3f} ms", pipeline_ms);
+  HLOG(kInfo, "Step time ratio:      {:.3f}", step_ratio);
+  HLOG(kInfo, "Step time overhead:   {:.2f} %", (step_ratio - 1.0) * 100.0);
+  HLOG(kInfo, "Staging latency p50:  {:.3f} ms", p50);
+  HLOG(kInfo, "Staging latency p99:  {:.3f} ms", p99);
+  HLOG(kInfo, "Compression ratio:    {:.3f}", pipeline.CompressionRatio());
+  HLOG(kInfo, "===============================");
+
+  if (pipeline.Failures() != 0 ||
+      pipeline.AnalyzedSteps() != pipeline.StagedSteps()) {
+    HLOG(kError, "{} staging or analysis failures", pipeline.Failures());
+    return 1;
+  }
+  return 0;
+}
+
+void PrintUsage(const char *program) {
+  HLOG(kError, "Usage: {} <compress_type> <grid_size> <steps> <plotgap>",
+       program);
+  HLOG(kError, "  compress_type: none, dynamic, zstd, lz4, zlib, snappy, "
+               "brotli, blosc2, bzip2, lzma, fpzip, sz3, zfp");
+  HLOG(kError, "  grid_size: Edge length L of the L^3 domain (e.g., 64)");
+  HLOG(kError, "  steps: Simulation steps per phase (e.g., 100)");
+  HLOG(kError, "  plotgap: Steps between staged outputs (e.g., 10)");
+  HLOG(kError, "");
+  HLOG(kError, "Example:");
+  HLOG(kError, "  {} dynamic 64 100 10", program);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  if (argc != 5) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  std::string compress_type = argv[1];
+  int dynamic_compress, compress_lib;
+  if (!ParseCompressionType(compress_type, dynamic_compress, compress_lib)) {
+    HLOG(kError, "Invalid compression type: {}", compress_type);
+    PrintUsage(argv[0]);
+    return 1;
+  }
+  int L = std::atoi(argv[2]);
+  int steps = std::atoi(argv[3]);
+  int plotgap = std::atoi(argv[4]);
+  if (L < 8 || steps <= 0 || plotgap <= 0) {
+    HLOG(kError, "Invalid parameters");
+    HLOG(kError, "  grid_size must be >= 8");
+    HLOG(kError, "  steps and plotgap must be > 0");
+    return 1;
+  }
+
+  HLOG(kInfo, "Initializing Chimaera runtime...");
+  if (!chi::CHIMAERA_INIT(chi::ChimaeraMode::kClient, true)) {
+    HLOG(kError, "Failed to initialize Chimaera runtime");
+    return 1;
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  // Dedicated core and compressor pools, the compressor in front of the core
+  chi::PoolId core_pool_id(620, 0);
+  chi::PoolId compressor_pool_id(621, 0);
+  wrp_cte::core::Client core_client;
+  wrp_cte::core::CreateParams core_params;
+  auto core_create = core_client.AsyncCreate(
+      chi::PoolQuery::Local(), "gs_pipeline_core", core_pool_id, core_params);
+  core_create.Wait();
+  core_client.Init(core_pool_id);
+
+  wrp_cte::core::Context ctx;
+  ctx.dynamic_compress_ = dynamic_compress;
+  ctx.compress_lib_ = compress_lib;
+  ctx.compress_preset_ = 2;  // BALANCED
+  ctx.data_type_ = 1;        // float
+  auto tag_task = core_client.AsyncGetOrCreateTag("gs_pipeline");
+  tag_task.Wait();
+  wrp_cte::core::TagId tag_id = tag_task->tag_id_;
+  if (dynamic_compress == 0) {
+    CoreStager stager{core_client};
+    return RunBenchmark(stager, tag_id, compress_type, ctx, L, steps, plotgap);
+  }
+
+  wrp_cte::compressor::Client creator;
+  auto compressor_create = creator.AsyncCreateCompressor(
+      chi::PoolQuery::Local(), "gs_pipeline_compressor", compressor_pool_id);
+  compressor_create.Wait();
+  wrp_cte::compressor::Client compressor_client(compressor_pool_id,
+                                                core_pool_id);
+  CompressStager stager{compressor_client, core_pool_id};
+  return RunBenchmark(stager, tag_id, compress_type, ctx, L, steps, plotgap);
+}
@@ -31,6 +31,14 @@ HSHM_GPU_FUN void LoadTaskTmpl(
         typed->SerializeOut(archive);
       break;
     }
+    case Method::kPutBlobBatch: {
+      auto typed = task.template Cast<PutBlobBatchTask>();
+      if (archive.GetMsgType() == chi::LocalMsgType::kSerializeIn)
+        typed->SerializeIn(archive);
+      else
+        typed->SerializeOut(archive);
+      break;
+    }
     case Method::kGetBlob: {
       auto typed = task.template Cast<GetBlobTask>();
       if (archive.GetMsgType() == chi::LocalMsgType::kSerializeIn)
@@ -57,6 +65,9 @@ HSHM_GPU_FUN void SaveTaskTmpl(
     case Method::kPutBlob:
       task.template Cast<PutBlobTask>()->SerializeOut(archive);
       break;
+    case Method::kPutBlobBatch:
+      task.template Cast<PutBlobBatchTask>()->SerializeOut(archive);
+      break;
     case Method::kGetBlob:
       task.template Cast<GetBlobTask>()->SerializeOut(archive);
       break;
@@ -78,6 +89,9 @@ static HSHM_GPU_FUN void RunImpl(
     case Method::kPutBlob:
       self->PutBlob(task_ptr.template Cast<PutBlobTask>(), rctx);
       break;
+    case Method::kPutBlobBatch:
+      self->PutBlobBatch(task_ptr.template Cast<PutBlobBatchTask>(), rctx);
+      break;
     case Method::kGetBlob:
       self->GetBlob(task_ptr.template Cast<GetBlobTask>(), rctx);
       break;
@@ -98,6 +112,9 @@ static HSHM_GPU_FUN hipc::FullPtr<chi::Task> AllocTaskImpl(
     case Method::kPutBlob: {
       auto _tp = CHI_IPC->NewTaskBase<PutBlobTask>(0); return _tp.template Cast<chi::Task>();
     }
+    case Method::kPutBlobBatch: {
+      auto _tp = CHI_IPC->NewTaskBase<PutBlobBatchTask>(0); return _tp.template Cast<chi::Task>();
+    }
     case Method::kGetBlob: {
       auto _tp = CHI_IPC->NewTaskBase<GetBlobTask>(0); return _tp.template Cast<chi::Task>();
     }
@@ -161,6 +178,9 @@ static HSHM_GPU_FUN void DestroyTaskImpl(
     case Method::kPutBlob:
       task.template Cast<PutBlobTask>().ptr_->~PutBlobTask();
       break;
+    case Method::kPutBlobBatch:
+      task.template Cast<PutBlobBatchTask>().ptr_->~PutBlobBatchTask();
+      break;
     case Method::kGetBlob:
       task.template Cast<GetBlobTask>().ptr_->~GetBlobTask();
       break;
@@ -183,6 +203,9 @@ static HSHM_GPU_FUN void FixupTaskImpl(
     case Method::kPutBlob:
       task.template Cast<PutBlobTask>().ptr_->FixupAfterCopy();
       break;
+    case Method::kPutBlobBatch:
+      task.template Cast<PutBlobBatchTask>().ptr_->FixupAfterCopy();
+      break;
     case Method::kGetBlob:
       task.template Cast<GetBlobTask>().ptr_->FixupAfterCopy();
       break;
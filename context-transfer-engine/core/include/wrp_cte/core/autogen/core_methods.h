@@ -2,6 +2,7 @@
 #define WRP_CTE_CORE_AUTOGEN_METHODS_H_
 
 #include <chimaera/chimaera.h>
+#include <chimaera/method_traits.h>
 #include <string>
 #include <vector>
 
@@ -39,8 +40,30 @@ GLOBAL_CROSS_CONST chi::u32 kBlobQuery = 31;
 GLOBAL_CROSS_CONST chi::u32 kGetTargetInfo = 32;
 GLOBAL_CROSS_CONST chi::u32 kFlushMetadata = 33;
 GLOBAL_CROSS_CONST chi::u32 kFlushData = 34;
+GLOBAL_CROSS_CONST chi::u32 kAppendBlob = 35;
+GLOBAL_CROSS_CONST chi::u32 kDefragBlobs = 36;
+GLOBAL_CROSS_CONST chi::u32 kMigrateBlobs = 37;
+GLOBAL_CROSS_CONST chi::u32 kCommitTransactionLogs = 38;
+GLOBAL_CROSS_CONST chi::u32 kSetTagReplication = 39;
+GLOBAL_CROSS_CONST chi::u32 kRepairReplicas = 40;
+GLOBAL_CROSS_CONST chi::u32 kSetPlacementWeights = 41;
+GLOBAL_CROSS_CONST chi::u32 kRebalanceBlobs = 42;
+GLOBAL_CROSS_CONST chi::u32 kSetTagPlacement = 43;
+GLOBAL_CROSS_CONST chi::u32 kRegisterBlobStub = 44;
+GLOBAL_CROSS_CONST chi::u32 kPutBlobBatch = 45;
+GLOBAL_CROSS_CONST chi::u32 kSpliceBlobs = 46;
+GLOBAL_CROSS_CONST chi::u32 kSetTagDedup = 47;
+GLOBAL_CROSS_CONST chi::u32 kSetTagErasure = 48;
+GLOBAL_CROSS_CONST chi::u32 kEvictTargets = 49;
+GLOBAL_CROSS_CONST chi::u32 kSetTagTtl = 50;
+GLOBAL_CROSS_CONST chi::u32 kExpireBlobs = 51;
+GLOBAL_CROSS_CONST chi::u32 kReserveBlob = 52;
+GLOBAL_CROSS_CONST chi::u32 kGetOrCreateTags = 53;
+GLOBAL_CROSS_CONST chi::u32 kSetTagEncryption = 54;
+GLOBAL_CROSS_CONST chi::u32 kGetBlobView = 55;
+GLOBAL_CROSS_CONST chi::u32 kReleaseBlobView = 56;
 
-GLOBAL_CROSS_CONST chi::u32 kMaxMethodId = 35;
+GLOBAL_CROSS_CONST chi::u32 kMaxMethodId = 57;
 
 inline const std::vector<std::string>& GetMethodNames() {
   static const std::vector<std::string> names = [] {
@@ -69,10 +92,98 @@ inline const std::vector<std::string>& GetMethodNames() {
     v[32] = "GetTargetInfo";
     v[33] = "FlushMetadata";
     v[34] = "FlushData";
+    v[35] = "AppendBlob";
+    v[36] = "DefragBlobs";
+    v[37] = "MigrateBlobs";
+    v[38] = "CommitTransactionLogs";
+    v[39] = "SetTagReplication";
+    v[40] = "RepairReplicas";
+    v[41] = "SetPlacementWeights";
+    v[42] = "RebalanceBlobs";
+    v[43] = "SetTagPlacement";
+    v[44] = "RegisterBlobStub";
+    v[45] = "PutBlobBatch";
+    v[46] = "SpliceBlobs";
+    v[47] = "SetTagDedup";
+    v[48] = "SetTagErasure";
+    v[49] = "EvictTargets";
+    v[50] = "SetTagTtl";
+    v[51] = "ExpireBlobs";
+    v[52] = "ReserveBlob";
+    v[53] = "GetOrCreateTags";
+    v[54] = "SetTagEncryption";
+    v[55] = "GetBlobView";
+    v[56] = "ReleaseBlobView";
     return v;
   }();
   return names;
 }
+
+/** Per-method traits indexed by method ID (see chimaera_mod.yaml) */
+inline constexpr chi::MethodTraits kMethodTraits[57] = {
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 0: Create
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 1: Destroy
+    {},  // 2
+    {},  // 3
+    {},  // 4
+    {},  // 5
+    {},  // 6
+    {},  // 7
+    {},  // 8
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 9: Monitor
+    {chi::MethodRoute::kDefault, chi::kMethodDefined | chi::kMethodGpu, 0},  // 10: RegisterTarget
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 11: UnregisterTarget
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 12: ListTargets
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 13: StatTargets
+    {chi::MethodRoute::kDefault, chi::kMethodDefined | chi::kMethodGpu, 0},  // 14: GetOrCreateTag
+    {chi::MethodRoute::kDefault, chi::kMethodDefined | chi::kMethodGpu, 0},  // 15: PutBlob
+    {chi::MethodRoute::kDefault, chi::kMethodDefined | chi::kMethodGpu, 0},  // 16: GetBlob
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 17: ReorganizeBlob
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 18: DelBlob
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 19: DelTag
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 20: GetTagSize
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 21: PollTelemetryLog
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 22: GetBlobScore
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 23: GetBlobSize
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 24: GetContainedBlobs
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 25: GetBlobInfo
+    {},  // 26
+    {},  // 27
+    {},  // 28
+    {},  // 29
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 30: TagQuery
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 31: BlobQuery
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 32: GetTargetInfo
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 33: FlushMetadata
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 34: FlushData
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 35: AppendBlob
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 36: DefragBlobs
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 37: MigrateBlobs
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 38: CommitTransactionLogs
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 39: SetTagReplication
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 40: RepairReplicas
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 41: SetPlacementWeights
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 42: RebalanceBlobs
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 43: SetTagPlacement
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 44: RegisterBlobStub
+    {chi::MethodRoute::kDefault, chi::kMethodDefined | chi::kMethodGpu, 0},  // 45: PutBlobBatch
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 46: SpliceBlobs
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 47: SetTagDedup
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 48: SetTagErasure
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 49: EvictTargets
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 50: SetTagTtl
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 51: ExpireBlobs
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 52: ReserveBlob
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 53: GetOrCreateTags
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 54: SetTagEncryption
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 55: GetBlobView
+    {chi::MethodRoute::kDefault, chi::kMethodDefined, 0},  // 56: ReleaseBlobView
+};
+
+/** @return Traits of a method, or chi::kNoMethodTraits if unknown */
+constexpr const chi::MethodTraits& GetMethodTraits(chi::u32 method) {
+  return method < 57 ? kMethodTraits[method] : chi::kNoMethodTraits;
+}
 }  // namespace Method
 
 }  // namespace wrp_cte::core
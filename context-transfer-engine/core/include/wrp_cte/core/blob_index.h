@@ -0,0 +1,862 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef WRPCTE_CORE_BLOB_INDEX_H_
+#define WRPCTE_CORE_BLOB_INDEX_H_
+
+#include <chimaera/chimaera.h>
+#include <chimaera/corwlock.h>
+#include <hermes_shm/data_structures/priv/unordered_map_ll.h>
+#include <hermes_shm/types/hash.h>
+#include <wrp_cte/core/core_tasks.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace wrp_cte::core {
+
+/**
+ * Net effect of a batch of operations on one blob, applied in this order:
+ * erase the entry, insert info_ (replacing any entry), or replace the
+ * blocks and erasure-code layout of an existing entry with info_'s.
+ */
+struct BlobPatch {
+  TagId tag_id_;
+  std::string blob_name_;
+  bool erase_ = false;
+  bool insert_ = false;
+  bool set_blocks_ = false;
+  bool set_stub_ = false;  // Replace the stub source of a live blob
+  BlobInfo info_;
+};
+
+/**
+ * Binary key of the blob index: a TagId plus either a 64-bit page index
+ * (for names that are canonical decimal numbers, as the filesystem
+ * adapters use for pages) or the blob name itself.
+ *
+ * The hash is computed once at construction and reused for shard
+ * selection and the map probe. Lookup keys borrow the caller's name bytes,
+ * so Find/Erase never allocate. Copies, which is how the map stores keys,
+ * own their name, and short names stay in std::string's inline buffer.
+ */
+class BlobKey {
+ public:
+  /** Empty key (the map's default slot key) */
+  BlobKey() = default;
+
+  /**
+   * Build a lookup key borrowing blob_name (must outlive the key)
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob name within the tag
+   */
+  BlobKey(const TagId &tag_id, std::string_view blob_name)
+      : tag_id_(tag_id) {
+    is_page_ = ParsePageIndex(blob_name, page_index_);
+    if (!is_page_) {
+      view_ = blob_name.data();
+      view_len_ = blob_name.size();
+    }
+    hash_ = ComputeHash();
+  }
+
+  /** Copies own their name bytes */
+  BlobKey(const BlobKey &other)
+      : tag_id_(other.tag_id_),
+        hash_(other.hash_),
+        page_index_(other.page_index_),
+        is_page_(other.is_page_),
+        name_(other.NameView()) {}
+
+  BlobKey(BlobKey &&other) noexcept
+      : tag_id_(other.tag_id_),
+        hash_(other.hash_),
+        page_index_(other.page_index_),
+        is_page_(other.is_page_),
+        view_(other.view_),
+        view_len_(other.view_len_),
+        name_(std::move(other.name_)) {}
+
+  BlobKey &operator=(const BlobKey &other) {
+    if (this != &other) {
+      name_.assign(other.NameView());
+      view_ = nullptr;
+      view_len_ = 0;
+      tag_id_ = other.tag_id_;
+      hash_ = other.hash_;
+      page_index_ = other.page_index_;
+      is_page_ = other.is_page_;
+    }
+    return *this;
+  }
+
+  BlobKey &operator=(BlobKey &&other) noexcept {
+    if (this != &other) {
+      tag_id_ = other.tag_id_;
+      hash_ = other.hash_;
+      page_index_ = other.page_index_;
+      is_page_ = other.is_page_;
+      view_ = other.view_;
+      view_len_ = other.view_len_;
+      name_ = std::move(other.name_);
+    }
+    return *this;
+  }
+
+  /** Tag containing the blob */
+  const TagId &GetTagId() const { return tag_id_; }
+
+  /** Precomputed hash of (tag, name) */
+  chi::u64 Hash() const { return hash_; }
+
+  /** Blob name (formats the page index for numeric names) */
+  std::string GetName() const {
+    return is_page_ ? std::to_string(page_index_) : std::string(NameView());
+  }
+
+  /** Composite string form "major.minor.blob_name" (checkpoints, logs) */
+  std::string ToString() const {
+    return std::to_string(tag_id_.major_) + "." +
+           std::to_string(tag_id_.minor_) + "." + GetName();
+  }
+
+  bool operator==(const BlobKey &other) const {
+    if (hash_ != other.hash_ || is_page_ != other.is_page_ ||
+        tag_id_ != other.tag_id_) {
+      return false;
+    }
+    return is_page_ ? page_index_ == other.page_index_
+                    : NameView() == other.NameView();
+  }
+
+ private:
+  TagId tag_id_;
+  chi::u64 hash_ = 0;
+  chi::u64 page_index_ = 0;
+  bool is_page_ = false;
+  const char *view_ = nullptr; /**< Borrowed name (lookup keys only) */
+  size_t view_len_ = 0;
+  std::string name_;           /**< Owned name (stored keys) */
+
+  /** Name bytes, borrowed or owned */
+  std::string_view NameView() const {
+    return view_ != nullptr ? std::string_view(view_, view_len_)
+                            : std::string_view(name_);
+  }
+
+  /**
+   * Accept only canonical decimal numbers ("0", "17", not "017" or "+1")
+   * so that GetName() round-trips exactly
+   */
+  static bool ParsePageIndex(std::string_view name, chi::u64 &index) {
+    if (name.empty() || name.size() > 19 ||
+        (name.size() > 1 && name[0] == '0')) {
+      return false;
+    }
+    chi::u64 value = 0;
+    for (char c : name) {
+      if (c < '0' || c > '9') {
+        return false;
+      }
+      value = value * 10 + static_cast<chi::u64>(c - '0');
+    }
+    index = value;
+    return true;
+  }
+
+  /** Hash the tag with the page index or name bytes */
+  chi::u64 ComputeHash() const {
+    std::string_view view = NameView();
+    chi::u64 h = is_page_ ? page_index_ * 0x9e3779b97f4a7c15ULL
+                          : hshm::HashBytes(view.data(), view.size());
+    h ^= (static_cast<chi::u64>(tag_id_.major_) << 32 | tag_id_.minor_) +
+         0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+  }
+};
+
+/** unordered_map_ll hasher returning the key's cached hash */
+struct BlobKeyHash {
+  size_t operator()(const BlobKey &key) const {
+    return static_cast<size_t>(key.Hash());
+  }
+};
+
+/**
+ * Sharded blob metadata index.
+ *
+ * Blob metadata is keyed by BlobKey (TagId plus name or page index, with a
+ * cached hash). Keys are spread over a fixed number of shards by that hash.
+ * Each shard owns its own unordered_map_ll and CoRwLock, so operations
+ * on unrelated blobs never contend and lookups only take a shared lock on
+ * their own shard. Whole-map walks (ForEach, EraseTag) visit one shard at a
+ * time and never hold more than one shard lock.
+ *
+ * A secondary per-tag membership index (ordered set of blob names per TagId)
+ * is kept in sync with every insert and erase. Tag-scoped operations
+ * (ListTagBlobs, ForEachTagBlob, EraseTag) therefore cost O(blobs in tag)
+ * instead of a scan of every blob on the node, and name-prefix queries
+ * become ordered range scans. Membership shards are locked separately from
+ * blob shards and the two are never held at the same time.
+ *
+ * A restart may defer whole tags (DeferTags): their blobs stay in the
+ * checkpoint image until the first operation that touches the tag loads
+ * them through the TagLoader. Whole-map walks load every deferred tag
+ * first. While nothing is deferred the check is a single atomic load.
+ *
+ * Returned BlobInfo pointers stay valid until the entry is erased, matching
+ * the semantics of unordered_map_ll::find.
+ */
+class BlobMetadataIndex {
+ public:
+  static constexpr size_t kDefaultNumShards = 64;
+  /** Stripe locks inside each shard map (the shard lock serializes writers) */
+  static constexpr size_t kStripesPerShard = 4;
+  /** Shards of the per-tag membership index */
+  static constexpr size_t kNumTagShards = 16;
+
+  /** Produces the entries of a deferred tag when it is first touched */
+  using TagLoader = std::function<std::vector<BlobPatch>(const TagId &)>;
+
+  BlobMetadataIndex() = default;
+
+  /**
+   * Construct and initialize the index
+   * @param total_capacity Expected number of blobs across all shards
+   * @param num_shards Number of independent shards
+   */
+  explicit BlobMetadataIndex(size_t total_capacity,
+                             size_t num_shards = kDefaultNumShards) {
+    Init(total_capacity, num_shards);
+  }
+
+  BlobMetadataIndex(const BlobMetadataIndex &) = delete;
+  BlobMetadataIndex &operator=(const BlobMetadataIndex &) = delete;
+  BlobMetadataIndex(BlobMetadataIndex &&) = default;
+  BlobMetadataIndex &operator=(BlobMetadataIndex &&) = default;
+
+  /**
+   * (Re)initialize the index, discarding all entries
+   * @param total_capacity Expected number of blobs across all shards
+   * @param num_shards Number of independent shards (at least 1)
+   */
+  void Init(size_t total_capacity, size_t num_shards = kDefaultNumShards) {
+    if (num_shards == 0) {
+      num_shards = 1;
+    }
+    size_t per_shard = std::max<size_t>(total_capacity / num_shards, 16);
+    shards_.clear();
+    shards_.reserve(num_shards);
+    for (size_t i = 0; i < num_shards; ++i) {
+      shards_.emplace_back(std::make_unique<Shard>(per_shard));
+    }
+    tag_shards_.clear();
+    tag_shards_.reserve(kNumTagShards);
+    for (size_t i = 0; i < kNumTagShards; ++i) {
+      tag_shards_.emplace_back(std::make_unique<TagShard>());
+    }
+    ResetDeferred();
+  }
+
+  /**
+   * Build the composite string key for a blob, as stored in checkpoints
+   * and the dirty-metadata log (the in-memory index uses BlobKey)
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob name within the tag
+   * @return "major.minor.blob_name"
+   */
+  static std::string MakeKey(const TagId &tag_id,
+                             const std::string &blob_name) {
+    return MakeTagPrefix(tag_id) + blob_name;
+  }
+
+  /**
+   * Build the composite key prefix shared by all blobs of a tag
+   * @param tag_id Tag ID
+   * @return "major.minor."
+   */
+  static std::string MakeTagPrefix(const TagId &tag_id) {
+    return std::to_string(tag_id.major_) + "." +
+           std::to_string(tag_id.minor_) + ".";
+  }
+
+  /**
+   * Split a composite key back into its tag ID and blob name
+   * @param key Composite key produced by MakeKey
+   * @param tag_id Output tag ID
+   * @param blob_name Output blob name
+   * @return false if the key is malformed
+   */
+  static bool ParseKey(const std::string &key, TagId &tag_id,
+                       std::string &blob_name) {
+    size_t first_dot = key.find('.');
+    if (first_dot == std::string::npos) return false;
+    size_t second_dot = key.find('.', first_dot + 1);
+    if (second_dot == std::string::npos) return false;
+    try {
+      tag_id.major_ =
+          static_cast<chi::u32>(std::stoul(key.substr(0, first_dot)));
+      tag_id.minor_ = static_cast<chi::u32>(
+          std::stoul(key.substr(first_dot + 1, second_dot - first_dot - 1)));
+    } catch (const std::exception &) {
+      return false;
+    }
+    blob_name = key.substr(second_dot + 1);
+    return true;
+  }
+
+  /**
+   * Select the shard owning a blob
+   * @param key Blob key
+   * @return Shard index in [0, NumShards())
+   */
+  size_t GetShardIndex(const BlobKey &key) const {
+    // Remix the cached hash so shard choice is independent of both the
+    // map's stripe bits and Runtime::HashBlobToContainer.
+    chi::u64 h = key.Hash() * 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 29;
+    return static_cast<size_t>(h % shards_.size());
+  }
+
+  /**
+   * Select the shard owning a blob
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob name within the tag
+   * @return Shard index in [0, NumShards())
+   */
+  size_t GetShardIndex(const TagId &tag_id,
+                       const std::string &blob_name) const {
+    return GetShardIndex(BlobKey(tag_id, blob_name));
+  }
+
+  /**
+   * Look up a blob
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob name within the tag
+   * @return Pointer to the BlobInfo, or nullptr if absent
+   */
+  BlobInfo *Find(const TagId &tag_id, const std::string &blob_name) {
+    Materialize(tag_id);
+    BlobKey key(tag_id, blob_name);
+    Shard &shard = GetShard(key);
+    chi::ScopedCoRwReadLock lock(shard.lock_);
+    return shard.map_.find(key);
+  }
+
+  /**
+   * Insert or replace a blob entry
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob name within the tag
+   * @param blob_info Metadata to store
+   * @return Pointer to the stored BlobInfo, or nullptr if the shard is full
+   */
+  BlobInfo *InsertOrAssign(const TagId &tag_id, const std::string &blob_name,
+                           const BlobInfo &blob_info) {
+    Materialize(tag_id);
+    hshm::priv::InsertResult<BlobInfo> result;
+    {
+      BlobKey key(tag_id, blob_name);
+      Shard &shard = GetShard(key);
+      chi::ScopedCoRwWriteLock lock(shard.lock_);
+      result = shard.map_.insert_or_assign(key, blob_info);
+    }
+    if (result.inserted) {
+      TagShard &tag_shard = GetTagShard(tag_id);
+      chi::ScopedCoRwWriteLock lock(tag_shard.lock_);
+      tag_shard.members_[tag_id].insert(blob_name);
+    }
+    return result.value;
+  }
+
+  /**
+   * Remove a blob entry
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob name within the tag
+   * @return true if an entry was removed
+   */
+  bool Erase(const TagId &tag_id, const std::string &blob_name) {
+    Materialize(tag_id);
+    bool erased;
+    {
+      BlobKey key(tag_id, blob_name);
+      Shard &shard = GetShard(key);
+      chi::ScopedCoRwWriteLock lock(shard.lock_);
+      erased = shard.map_.erase(key) != 0;
+    }
+    if (erased) {
+      TagShard &tag_shard = GetTagShard(tag_id);
+      chi::ScopedCoRwWriteLock lock(tag_shard.lock_);
+      auto it = tag_shard.members_.find(tag_id);
+      if (it != tag_shard.members_.end()) {
+        it->second.erase(blob_name);
+        if (it->second.empty()) {
+          tag_shard.members_.erase(it);
+        }
+      }
+    }
+    return erased;
+  }
+
+  /**
+   * Remove every blob belonging to a tag
+   * @param tag_id Tag whose blobs are removed
+   * @return Number of entries removed
+   */
+  size_t EraseTag(const TagId &tag_id) {
+    // A deferred tag's blobs were never loaded; there is nothing to erase
+    DropDeferred(tag_id);
+    // Detach the tag's membership set, then erase each blob from its shard
+    std::set<std::string> names;
+    {
+      TagShard &tag_shard = GetTagShard(tag_id);
+      chi::ScopedCoRwWriteLock lock(tag_shard.lock_);
+      auto it = tag_shard.members_.find(tag_id);
+      if (it == tag_shard.members_.end()) {
+        return 0;
+      }
+      names.swap(it->second);
+      tag_shard.members_.erase(it);
+    }
+    size_t erased = 0;
+    for (const auto &blob_name : names) {
+      BlobKey key(tag_id, blob_name);
+      Shard &shard = GetShard(key);
+      chi::ScopedCoRwWriteLock lock(shard.lock_);
+      erased += shard.map_.erase(key);
+    }
+    return erased;
+  }
+
+  /**
+   * Visit the names of a tag's blobs in sorted order, optionally restricted
+   * to names starting with a prefix (ordered range scan).
+   * @param tag_id Tag to scan
+   * @param prefix Only visit names starting with this prefix ("" for all)
+   * @param fn Callable as bool fn(const std::string &blob_name); return
+   *        false to stop the scan early
+   */
+  template <typename Func>
+  void ForEachTagBlob(const TagId &tag_id, const std::string &prefix,
+                      Func fn) {
+    ForEachTagBlob(tag_id, prefix, nullptr, std::move(fn));
+  }
+
+  /**
+   * Visit the names of a tag's blobs in sorted order, starting strictly
+   * after a resume point (pagination cursor)
+   * @param tag_id Tag to scan
+   * @param prefix Only visit names starting with this prefix ("" for all)
+   * @param start_after Skip names <= *start_after (nullptr = no cursor)
+   * @param fn Callable as bool fn(const std::string &blob_name); return
+   *        false to stop the scan early
+   */
+  template <typename Func>
+  void ForEachTagBlob(const TagId &tag_id, const std::string &prefix,
+                      const std::string *start_after, Func fn) {
+    Materialize(tag_id);
+    TagShard &tag_shard = GetTagShard(tag_id);
+    chi::ScopedCoRwReadLock lock(tag_shard.lock_);
+    auto it = tag_shard.members_.find(tag_id);
+    if (it == tag_shard.members_.end()) {
+      return;
+    }
+    const std::set<std::string> &names = it->second;
+    auto name_it = names.lower_bound(prefix);
+    if (start_after != nullptr && *start_after >= prefix) {
+      name_it = names.upper_bound(*start_after);
+    }
+    for (; name_it != names.end(); ++name_it) {
+      if (name_it->compare(0, prefix.size(), prefix) != 0) {
+        break;
+      }
+      if (!fn(*name_it)) {
+        break;
+      }
+    }
+  }
+
+  /**
+   * Copy the sorted names of all blobs in a tag
+   * @param tag_id Tag to list
+   * @return Blob names in the tag
+   */
+  std::vector<std::string> ListTagBlobs(const TagId &tag_id) {
+    std::vector<std::string> names;
+    ForEachTagBlob(tag_id, "", [&names](const std::string &name) {
+      names.push_back(name);
+      return true;
+    });
+    return names;
+  }
+
+  /**
+   * Number of blobs in a tag
+   * @param tag_id Tag to count
+   */
+  size_t TagBlobCount(const TagId &tag_id) {
+    Materialize(tag_id);
+    TagShard &tag_shard = GetTagShard(tag_id);
+    chi::ScopedCoRwReadLock lock(tag_shard.lock_);
+    auto it = tag_shard.members_.find(tag_id);
+    return it == tag_shard.members_.end() ? 0 : it->second.size();
+  }
+
+  /**
+   * Visit a tag's blob entries in name order, each under its shard's read
+   * lock so that it cannot be erased while fn runs
+   * @param tag_id Tag to scan
+   * @param fn Callable as fn(const std::string &blob_name, BlobInfo &info)
+   */
+  template <typename Func>
+  void ForEachTagEntry(const TagId &tag_id, Func fn) {
+    for (const auto &blob_name : ListTagBlobs(tag_id)) {
+      BlobKey key(tag_id, blob_name);
+      Shard &shard = GetShard(key);
+      chi::ScopedCoRwReadLock lock(shard.lock_);
+      BlobInfo *info = shard.map_.find(key);
+      if (info != nullptr) {
+        fn(blob_name, *info);
+      }
+    }
+  }
+
+  /**
+   * IDs of every tag with loaded blobs, one membership shard at a time
+   * @return Tag IDs in no particular order
+   */
+  std::vector<TagId> ListTags() {
+    std::vector<TagId> tag_ids;
+    for (auto &tag_shard : tag_shards_) {
+      chi::ScopedCoRwReadLock lock(tag_shard->lock_);
+      for (const auto &entry : tag_shard->members_) {
+        tag_ids.push_back(entry.first);
+      }
+    }
+    return tag_ids;
+  }
+
+  /**
+   * Visit every blob entry, one shard at a time under its read lock
+   * @param fn Callable as fn(const BlobKey &key, BlobInfo &info)
+   */
+  template <typename Func>
+  void ForEach(Func fn) {
+    MaterializeAll();
+    ForEachLoaded(std::move(fn));
+  }
+
+  /**
+   * Visit the loaded blob entries, skipping deferred tags
+   * @param fn Callable as fn(const BlobKey &key, BlobInfo &info)
+   */
+  template <typename Func>
+  void ForEachLoaded(Func fn) {
+    for (auto &shard : shards_) {
+      chi::ScopedCoRwReadLock lock(shard->lock_);
+      shard->map_.for_each(
+          [&fn](const BlobKey &key, BlobInfo &info) { fn(key, info); });
+    }
+  }
+
+  /**
+   * Grow every shard so that a total number of entries fits without any
+   * rehash on insert (bulk loading builds each table once, at its final size)
+   * @param total_entries Expected number of entries across all shards
+   */
+  void Reserve(size_t total_entries) {
+    size_t per_shard = total_entries / shards_.size() + 1;
+    // Shard maps rehash above 75% occupancy; allow for hash skew
+    size_t slots = per_shard * 3 / 2 + 16;
+    for (auto &shard : shards_) {
+      chi::ScopedCoRwWriteLock lock(shard->lock_);
+      if (shard->map_.bucket_count() < slots) {
+        shard->map_.rehash(slots);
+      }
+    }
+  }
+
+  /**
+   * Apply a batch of patches, taking each shard lock once. Patches to the
+   * same blob are applied in batch order.
+   * @param patches Patches to apply
+   * @return Number of patches that inserted or updated an entry
+   */
+  size_t ApplyPatches(const std::vector<BlobPatch> &patches) {
+    if (deferred_->count_.load(std::memory_order_acquire) != 0) {
+      std::unordered_set<TagId> tags;
+      for (const auto &patch : patches) {
+        if (tags.insert(patch.tag_id_).second) {
+          Materialize(patch.tag_id_);
+        }
+      }
+    }
+    return ApplyLoadedPatches(patches);
+  }
+
+  /**
+   * Defer loading the blobs of some tags until each is first touched
+   * @param tag_ids Tags whose blobs are not loaded yet
+   * @param loader Produces a tag's entries; called once per tag
+   */
+  void DeferTags(const std::vector<TagId> &tag_ids, TagLoader loader) {
+    chi::ScopedCoRwWriteLock lock(deferred_->lock_);
+    deferred_->loader_ = std::move(loader);
+    for (const auto &tag_id : tag_ids) {
+      if (deferred_->tags_.insert(tag_id).second) {
+        deferred_->count_.fetch_add(1, std::memory_order_release);
+      }
+    }
+  }
+
+  /**
+   * Load a deferred tag's blobs now; a no-op for tags already loaded
+   * @param tag_id Tag to load
+   */
+  void Materialize(const TagId &tag_id) {
+    if (deferred_->count_.load(std::memory_order_acquire) == 0 ||
+        !IsDeferred(tag_id)) {
+      return;
+    }
+    // One load at a time; a racing caller waits here for the same tag
+    hshm::ScopedMutex guard(deferred_->load_lock_, 0);
+    if (!IsDeferred(tag_id)) {
+      return;
+    }
+    ApplyLoadedPatches(deferred_->loader_(tag_id));
+    chi::ScopedCoRwWriteLock lock(deferred_->lock_);
+    deferred_->tags_.erase(tag_id);
+    deferred_->count_.fetch_sub(1, std::memory_order_release);
+  }
+
+  /** Load every deferred tag */
+  void MaterializeAll() {
+    if (deferred_->count_.load(std::memory_order_acquire) == 0) {
+      return;
+    }
+    std::vector<TagId> tag_ids;
+    {
+      chi::ScopedCoRwReadLock lock(deferred_->lock_);
+      tag_ids.assign(deferred_->tags_.begin(), deferred_->tags_.end());
+    }
+    for (const auto &tag_id : tag_ids) {
+      Materialize(tag_id);
+    }
+  }
+
+  /**
+   * Whether a tag's blobs are still deferred
+   * @param tag_id Tag to check
+   */
+  bool IsDeferred(const TagId &tag_id) {
+    if (deferred_->count_.load(std::memory_order_acquire) == 0) {
+      return false;
+    }
+    chi::ScopedCoRwReadLock lock(deferred_->lock_);
+    return deferred_->tags_.count(tag_id) != 0;
+  }
+
+  /** @return Number of tags whose blobs are not loaded yet */
+  size_t NumDeferredTags() const {
+    return deferred_->count_.load(std::memory_order_acquire);
+  }
+
+  /** Remove all entries from every shard */
+  void Clear() {
+    ResetDeferred();
+    for (auto &shard : shards_) {
+      chi::ScopedCoRwWriteLock lock(shard->lock_);
+      shard->map_.clear();
+    }
+    for (auto &tag_shard : tag_shards_) {
+      chi::ScopedCoRwWriteLock lock(tag_shard->lock_);
+      tag_shard->members_.clear();
+    }
+  }
+
+  /** Total number of blob entries across all shards */
+  size_t Size() const {
+    size_t total = 0;
+    for (const auto &shard : shards_) {
+      total += shard->map_.size();
+    }
+    return total;
+  }
+
+  /** Number of shards */
+  size_t NumShards() const { return shards_.size(); }
+
+ private:
+  /** One independently locked partition of the index */
+  struct Shard {
+    chi::CoRwLock lock_;
+    hshm::priv::unordered_map_ll<BlobKey, BlobInfo,
+                                 hshm::ipc::MallocAllocator, BlobKeyHash>
+        map_;
+
+    explicit Shard(size_t capacity) : map_(capacity, kStripesPerShard) {}
+  };
+
+  /** One independently locked partition of the per-tag membership index */
+  struct TagShard {
+    chi::CoRwLock lock_;
+    std::unordered_map<TagId, std::set<std::string>> members_;
+  };
+
+  /** Tags restored lazily from a checkpoint image (DeferTags) */
+  struct DeferredTags {
+    chi::CoRwLock lock_;     /**< Guards tags_ and loader_ */
+    hshm::Mutex load_lock_;  /**< Serializes loads */
+    std::atomic<size_t> count_{0};
+    std::unordered_set<TagId> tags_;
+    TagLoader loader_;
+  };
+
+  /** Get the shard owning a blob */
+  Shard &GetShard(const BlobKey &key) {
+    return *shards_[GetShardIndex(key)];
+  }
+
+  /** Index of the membership shard owning a tag */
+  size_t TagShardIndex(const TagId &tag_id) const {
+    return std::hash<TagId>{}(tag_id) % tag_shards_.size();
+  }
+
+  /** Get the membership shard owning a tag */
+  TagShard &GetTagShard(const TagId &tag_id) {
+    return *tag_shards_[TagShardIndex(tag_id)];
+  }
+
+  /** ApplyPatches() for tags known to be loaded */
+  size_t ApplyLoadedPatches(const std::vector<BlobPatch> &patches) {
+    std::vector<std::vector<size_t>> by_shard(shards_.size());
+    std::vector<BlobKey> keys;
+    keys.reserve(patches.size());
+    for (size_t i = 0; i < patches.size(); ++i) {
+      keys.emplace_back(patches[i].tag_id_, patches[i].blob_name_);
+      by_shard[GetShardIndex(keys.back())].push_back(i);
+    }
+    // Membership changes: (patch index, inserted) per membership shard
+    std::vector<std::vector<std::pair<size_t, bool>>> members(
+        tag_shards_.size());
+    size_t applied = 0;
+    for (size_t s = 0; s < shards_.size(); ++s) {
+      if (by_shard[s].empty()) continue;
+      Shard &shard = *shards_[s];
+      chi::ScopedCoRwWriteLock lock(shard.lock_);
+      for (size_t i : by_shard[s]) {
+        const BlobPatch &patch = patches[i];
+        const BlobKey &key = keys[i];
+        size_t tag_shard = TagShardIndex(patch.tag_id_);
+        if (patch.erase_ && shard.map_.erase(key) != 0) {
+          members[tag_shard].emplace_back(i, false);
+        }
+        if (patch.insert_) {
+          if (shard.map_.insert_or_assign(key, patch.info_).inserted) {
+            members[tag_shard].emplace_back(i, true);
+          }
+          ++applied;
+        } else if (patch.set_blocks_ || patch.set_stub_) {
+          BlobInfo *info = shard.map_.find(key);
+          if (info != nullptr) {
+            if (patch.set_blocks_) {
+              info->blocks_ = patch.info_.blocks_;
+              info->CopyErasureLayout(patch.info_);
+            }
+            if (patch.set_stub_) {
+              info->CopyStub(patch.info_);
+            }
+            ++applied;
+          }
+        }
+      }
+    }
+    for (size_t t = 0; t < tag_shards_.size(); ++t) {
+      if (members[t].empty()) continue;
+      TagShard &tag_shard = *tag_shards_[t];
+      chi::ScopedCoRwWriteLock lock(tag_shard.lock_);
+      for (const auto &[i, inserted] : members[t]) {
+        const BlobPatch &patch = patches[i];
+        if (inserted) {
+          tag_shard.members_[patch.tag_id_].insert(patch.blob_name_);
+          continue;
+        }
+        auto it = tag_shard.members_.find(patch.tag_id_);
+        if (it != tag_shard.members_.end()) {
+          it->second.erase(patch.blob_name_);
+          if (it->second.empty()) tag_shard.members_.erase(it);
+        }
+      }
+    }
+    return applied;
+  }
+
+  /** Forget the deferred tags without loading them */
+  void ResetDeferred() {
+    chi::ScopedCoRwWriteLock lock(deferred_->lock_);
+    deferred_->tags_.clear();
+    deferred_->count_.store(0, std::memory_order_release);
+    deferred_->loader_ = nullptr;
+  }
+
+  /** Stop deferring a tag without loading it */
+  void DropDeferred(const TagId &tag_id) {
+    if (deferred_->count_.load(std::memory_order_acquire) == 0) {
+      return;
+    }
+    hshm::ScopedMutex guard(deferred_->load_lock_, 0);
+    chi::ScopedCoRwWriteLock lock(deferred_->lock_);
+    if (deferred_->tags_.erase(tag_id) != 0) {
+      deferred_->count_.fetch_sub(1, std::memory_order_release);
+    }
+  }
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::vector<std::unique_ptr<TagShard>> tag_shards_;
+
+  std::unique_ptr<DeferredTags> deferred_ = std::make_unique<DeferredTags>();
+};
+
+}  // namespace wrp_cte::core
+
+#endif  // WRPCTE_CORE_BLOB_INDEX_H_
@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef WRPCTE_CORE_BLOB_META_TABLE_H_
+#define WRPCTE_CORE_BLOB_META_TABLE_H_
+
+#include <wrp_cte/core/core_tasks.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+#include "hermes_shm/introspect/system_info.h"
+
+namespace wrp_cte::core {
+
+/**
+ * Node-wide cache of blob sizes and scores in POSIX shared memory.
+ *
+ * The runtime publishes a blob's size and score when it answers a
+ * GetBlobSize, GetBlobScore or GetBlobInfo for a blob it owns. Clients on
+ * the node read the copy under a seqlock, with no task. Every change to a
+ * blob ends in MarkBlobDirty, which invalidates its slot. A publish only
+ * lands if the slot has not been written since the runtime took its
+ * ticket, i.e. before it read the BlobInfo, so a racing change always
+ * wins. Blobs share slots by hash, so a collision evicts the other blob.
+ * Reads that hit are not stamped into the blob's last_read_.
+ */
+class BlobMetaTable {
+ public:
+  /** Number of slots; a power of two */
+  static constexpr size_t kNumSlots = 1 << 14;
+  /** Longest blob name that is published */
+  static constexpr size_t kMaxNameLen = 88;
+  /** Read attempts before a reader gives up on a slot being written */
+  static constexpr int kReadRetries = 4;
+
+  /** Published metadata of one blob */
+  struct Entry {
+    chi::u64 size_ = 0;
+    float score_ = 0;
+  };
+
+  /** Outcome of a lookup */
+  enum class LookupResult {
+    kHit,      /**< Entry holds the blob's current metadata */
+    kMiss,     /**< Blob not published, or the table is not mapped */
+    kConflict  /**< Slot kept changing while being read */
+  };
+
+  /** Slot state taken before reading a BlobInfo, checked by Publish */
+  struct Ticket {
+    chi::u64 seq_ = 1;  /**< Odd never matches a slot, so Publish fails */
+    chi::u64 epoch_ = 0;
+  };
+
+  BlobMetaTable() = default;
+  BlobMetaTable(const BlobMetaTable &) = delete;
+  BlobMetaTable &operator=(const BlobMetaTable &) = delete;
+  ~BlobMetaTable() { Detach(); }
+
+  /**
+   * Name of the table's segment, derived from the runtime's main segment
+   * so that several runtimes on one node do not share a table
+   */
+  static std::string SegmentName() {
+    auto *config = CHI_CONFIG_MANAGER;
+    std::string base = "chimaera_main";
+    if (config && config->IsValid()) {
+      base = config->GetSharedMemorySegmentName(chi::kMainSegment);
+    }
+    return base + "_cte_blob_meta";
+  }
+
+  /**
+   * Create the table (runtime side). Calling it again is a no-op.
+   * @param name Shared memory object name
+   * @return false if the segment could not be created
+   */
+  bool Create(const std::string &name) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (header_) {
+      return true;
+    }
+    hshm::SystemInfo::DestroySharedMemory(name);
+    if (!hshm::SystemInfo::CreateNewSharedMemory(fd_, name, kSegmentSize)) {
+      return false;
+    }
+    if (!Map()) {
+      hshm::SystemInfo::DestroySharedMemory(name);
+      return false;
+    }
+    name_ = name;
+    owner_ = true;
+    header_->alive_.store(1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Map the table created by the local runtime (client side)
+   * @param name Shared memory object name
+   * @return false if no runtime table exists
+   */
+  bool Attach(const std::string &name) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (header_) {
+      return true;
+    }
+    if (!hshm::SystemInfo::OpenSharedMemory(fd_, name)) {
+      return false;
+    }
+    if (!Map()) {
+      return false;
+    }
+    name_ = name;
+    return true;
+  }
+
+  /** Unmap the table; the runtime also removes the segment */
+  void Detach() {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (!header_) {
+      return;
+    }
+    if (owner_) {
+      // Clients still mapping the removed segment see it is gone
+      header_->alive_.store(0, std::memory_order_release);
+    }
+    hshm::SystemInfo::UnmapMemory(header_, kSegmentSize);
+    hshm::SystemInfo::CloseSharedMemory(fd_);
+    if (owner_) {
+      hshm::SystemInfo::DestroySharedMemory(name_);
+    }
+    header_ = nullptr;
+    owner_ = false;
+  }
+
+  /** Whether the table is mapped and its runtime is still running */
+  bool IsLive() const {
+    return header_ && header_->alive_.load(std::memory_order_acquire) != 0;
+  }
+
+  /**
+   * Take a ticket for publishing \a blob_name; call before reading its
+   * BlobInfo
+   */
+  Ticket GetTicket(const TagId &tag_id, const std::string &blob_name) const {
+    Ticket ticket;
+    if (header_) {
+      ticket.epoch_ = header_->epoch_.load(std::memory_order_acquire);
+      ticket.seq_ = header_->slots_[Slot(tag_id, blob_name)].seq_.load(
+          std::memory_order_acquire);
+    }
+    return ticket;
+  }
+
+  /**
+   * Publish a blob's metadata read after taking \a ticket
+   * @return false if the slot changed since the ticket, or the name is
+   * too long to publish
+   */
+  bool Publish(const TagId &tag_id, const std::string &blob_name,
+               const Ticket &ticket, const Entry &entry) {
+    if (!header_ || blob_name.empty() || blob_name.size() > kMaxNameLen ||
+        (ticket.seq_ & 1)) {
+      return false;
+    }
+    SlotData &slot = header_->slots_[Slot(tag_id, blob_name)];
+    chi::u64 seq = ticket.seq_;
+    if (!slot.seq_.compare_exchange_strong(seq, seq + 1,
+                                           std::memory_order_acquire)) {
+      return false;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.epoch_ = ticket.epoch_;
+    slot.tag_id_ = tag_id;
+    slot.size_ = entry.size_;
+    slot.score_ = entry.score_;
+    slot.name_len_ = static_cast<chi::u32>(blob_name.size());
+    memcpy(slot.name_, blob_name.data(), blob_name.size());
+    slot.seq_.store(seq + 2, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Drop \a blob_name from its slot and fail every publish of the slot
+   * that took its ticket before now
+   */
+  void Invalidate(const TagId &tag_id, const std::string &blob_name) {
+    if (!header_) {
+      return;
+    }
+    SlotData &slot = header_->slots_[Slot(tag_id, blob_name)];
+    chi::u64 seq = LockSlot(slot);
+    if (Matches(slot, tag_id, blob_name)) {
+      slot.name_len_ = 0;
+    }
+    slot.seq_.store(seq + 2, std::memory_order_release);
+  }
+
+  /** Drop every entry, e.g. when a whole tag goes away */
+  void InvalidateAll() {
+    if (header_) {
+      header_->epoch_.fetch_add(1, std::memory_order_acq_rel);
+    }
+  }
+
+  /**
+   * Read the published metadata of \a blob_name
+   * @param entry Filled on a hit
+   */
+  LookupResult Lookup(const TagId &tag_id, const std::string &blob_name,
+                      Entry &entry) const {
+    if (!IsLive() || blob_name.empty() || blob_name.size() > kMaxNameLen) {
+      return LookupResult::kMiss;
+    }
+    const SlotData &slot = header_->slots_[Slot(tag_id, blob_name)];
+    for (int attempt = 0; attempt < kReadRetries; ++attempt) {
+      chi::u64 begin = slot.seq_.load(std::memory_order_acquire);
+      if (begin & 1) {
+        continue;
+      }
+      bool match = slot.epoch_ ==
+                       header_->epoch_.load(std::memory_order_acquire) &&
+                   Matches(slot, tag_id, blob_name);
+      Entry copy;
+      copy.size_ = slot.size_;
+      copy.score_ = slot.score_;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.seq_.load(std::memory_order_relaxed) != begin) {
+        continue;
+      }
+      if (!match) {
+        return LookupResult::kMiss;
+      }
+      entry = copy;
+      return LookupResult::kHit;
+    }
+    return LookupResult::kConflict;
+  }
+
+ private:
+  /** One blob's published copy; seq_ is odd while a writer holds it */
+  struct SlotData {
+    std::atomic<chi::u64> seq_;
+    chi::u64 epoch_;
+    TagId tag_id_;
+    chi::u64 size_;
+    float score_;
+    chi::u32 name_len_;  /**< 0 when the slot is empty */
+    char name_[kMaxNameLen];
+  };
+
+  /** Layout of the shared segment */
+  struct Header {
+    std::atomic<chi::u64> alive_;  /**< 0 once the runtime left */
+    std::atomic<chi::u64> epoch_;  /**< Entries of older epochs are stale */
+    SlotData slots_[kNumSlots];
+  };
+  static constexpr size_t kSegmentSize =
+      (sizeof(Header) + 4095) & ~static_cast<size_t>(4095);
+
+  /** Map the open segment */
+  bool Map() {
+    header_ = reinterpret_cast<Header *>(
+        hshm::SystemInfo::MapSharedMemory(fd_, kSegmentSize, 0));
+    if (!header_) {
+      hshm::SystemInfo::CloseSharedMemory(fd_);
+      return false;
+    }
+    return true;
+  }
+
+  /** Spin until this writer holds \a slot; returns the even seq it held */
+  static chi::u64 LockSlot(SlotData &slot) {
+    chi::u64 seq = slot.seq_.load(std::memory_order_relaxed);
+    while ((seq & 1) ||
+           !slot.seq_.compare_exchange_weak(seq, seq + 1,
+                                            std::memory_order_acquire)) {
+      seq = slot.seq_.load(std::memory_order_relaxed);
+    }
+    return seq;
+  }
+
+  /** Whether \a slot holds \a blob_name of \a tag_id */
+  static bool Matches(const SlotData &slot, const TagId &tag_id,
+                      const std::string &blob_name) {
+    return slot.name_len_ == blob_name.size() && slot.tag_id_ == tag_id &&
+           memcmp(slot.name_, blob_name.data(), blob_name.size()) == 0;
+  }
+
+  /** Slot of \a blob_name in \a tag_id (FNV-1a over the name) */
+  static size_t Slot(const TagId &tag_id, const std::string &blob_name) {
+    chi::u64 key = (static_cast<chi::u64>(tag_id.major_) << 32) |
+                   static_cast<chi::u64>(tag_id.minor_);
+    chi::u64 hash = 0xcbf29ce484222325ull ^ key;
+    for (char c : blob_name) {
+      hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+    }
+    hash *= 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(hash >> 40) & (kNumSlots - 1);
+  }
+
+  Header *header_ = nullptr;
+  hshm::File fd_{};
+  std::string name_;
+  bool owner_ = false;
+  std::mutex lock_;
+};
+
+}  // namespace wrp_cte::core
+
+#endif  // WRPCTE_CORE_BLOB_META_TABLE_H_
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef WRPCTE_CORE_BLOB_VIEW_H_
+#define WRPCTE_CORE_BLOB_VIEW_H_
+
+#include <wrp_cte/core/core_tasks.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace wrp_cte::core {
+
+/** One contiguous piece of a blob view in this process's address space */
+struct BlobViewPiece {
+  const char *data_;
+  size_t size_;
+};
+
+/**
+ * Read-only view of a blob range held on RAM targets of this node. The
+ * bytes are read through this process's mapping of each target's buffer,
+ * with no copy by the runtime. The runtime pins the blocks for the view:
+ * writes to the blob meanwhile go to new blocks, so a view keeps showing
+ * the bytes it was opened on. Release the view when done; a view kept
+ * past its lease may see its blocks reused.
+ */
+class BlobView {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  BlobView() = default;
+
+  /**
+   * Adopt a lease granted by GetBlobView
+   * @param tag_id Tag of the viewed blob
+   * @param blob_name Viewed blob
+   * @param lease_id Lease to release
+   * @param lease_ms Lease length in milliseconds
+   * @param pieces Mapped pieces in blob order
+   */
+  BlobView(const TagId &tag_id, const std::string &blob_name,
+           chi::u64 lease_id, chi::u64 lease_ms,
+           std::vector<BlobViewPiece> pieces);
+
+  /** Releases the lease */
+  ~BlobView() { Release(); }
+
+  BlobView(const BlobView &) = delete;
+  BlobView &operator=(const BlobView &) = delete;
+  BlobView(BlobView &&other) noexcept;
+  BlobView &operator=(BlobView &&other) noexcept;
+
+  /** @return true while the view holds a lease */
+  bool IsValid() const { return lease_id_ != 0; }
+
+  /** @return true once the lease time has run out */
+  bool IsExpired() const { return Clock::now() >= deadline_; }
+
+  /** @return Pieces of the view in blob order */
+  const std::vector<BlobViewPiece> &GetPieces() const { return pieces_; }
+
+  /** @return Bytes in the view */
+  size_t GetSize() const { return size_; }
+
+  /**
+   * Copy the viewed bytes into a caller buffer
+   * @param data Output buffer of at least GetSize() bytes
+   */
+  void CopyTo(char *data) const;
+
+  /** Unpin the blocks; the pieces are not valid afterwards */
+  void Release();
+
+  /**
+   * Map the buffer of a RAM target read-only, once per process
+   * @param target_id Bdev pool id of the target
+   * @param segment_size Bytes of the buffer to map
+   * @return Start of the mapping, or nullptr if the segment cannot be opened
+   */
+  static const char *MapTarget(const chi::PoolId &target_id,
+                               chi::u64 segment_size);
+
+ private:
+  TagId tag_id_;
+  std::string blob_name_;
+  chi::u64 lease_id_ = 0;
+  Clock::time_point deadline_;
+  std::vector<BlobViewPiece> pieces_;
+  size_t size_ = 0;
+};
+
+}  // namespace wrp_cte::core
+
+#endif  // WRPCTE_CORE_BLOB_VIEW_H_
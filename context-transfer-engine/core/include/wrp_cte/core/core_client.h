@@ -35,11 +35,152 @@
 #define WRPCTE_CORE_CLIENT_H_
 
 #include <chimaera/chimaera.h>
+#include <chimaera/admin.h>
+#include <chimaera/admin/admin_client.h>
 #include <hermes_shm/util/singleton.h>
+#include <wrp_cte/core/blob_view.h>
 #include <wrp_cte/core/core_tasks.h>
+#include <wrp_cte/core/tag_id_cache.h>
+#include <wrp_cte/core/workload_trace.h>
 
 namespace wrp_cte::core {
 
+#if HSHM_IS_HOST
+/** Kind of operation recorded in a BlobBatch */
+enum class BlobBatchOp : chi::u32 {
+  kPut = 0,
+  kGet = 1,
+  kDel = 2,
+  kGetSize = 3,
+};
+
+/** Completion of one BlobBatch operation */
+struct BlobBatchResult {
+  BlobBatchOp op_;
+  /** Task return code, or SubmitBatchTask::kNotRun if it never ran */
+  chi::u32 return_code_ = chimaera::admin::SubmitBatchTask::kNotRun;
+  /** Blob size for kGetSize, 0 otherwise */
+  chi::u64 size_ = 0;
+};
+
+/**
+ * Builder for mixed blob operations submitted as one admin SubmitBatch task
+ * The whole batch is a single ring-buffer entry; the runtime unpacks and
+ * runs the operations with up to 32 in flight. Data pointers must live in
+ * client shared memory (AllocateBuffer / AllocateUserShm) until the batch
+ * completes.
+ */
+class BlobBatch {
+ public:
+  /**
+   * Create an empty batch for a CTE pool
+   * @param pool_id CTE core pool the operations target
+   */
+  explicit BlobBatch(const chi::PoolId &pool_id) : pool_id_(pool_id) {}
+
+  /** Queue a PutBlob of size bytes at offset from blob_data */
+  void Put(const TagId &tag_id, const std::string &blob_name,
+           chi::u64 offset, chi::u64 size, hipc::ShmPtr<> blob_data,
+           float score = -1.0f, const Context &context = Context(),
+           chi::u32 flags = 0) {
+    batch_.Add<PutBlobTask>(chi::CreateTaskId(), pool_id_,
+                            chi::PoolQuery::Dynamic(), tag_id,
+                            blob_name.c_str(), offset, size, blob_data, score,
+                            context, flags);
+    ops_.push_back(BlobBatchOp::kPut);
+  }
+
+  /** Queue a GetBlob of size bytes at offset into blob_data */
+  void Get(const TagId &tag_id, const std::string &blob_name,
+           chi::u64 offset, chi::u64 size, hipc::ShmPtr<> blob_data,
+           chi::u32 flags = 0) {
+    batch_.Add<GetBlobTask>(chi::CreateTaskId(), pool_id_,
+                            chi::PoolQuery::Dynamic(), tag_id,
+                            blob_name.c_str(), offset, size, flags,
+                            blob_data);
+    ops_.push_back(BlobBatchOp::kGet);
+  }
+
+  /** Queue a DelBlob */
+  void Del(const TagId &tag_id, const std::string &blob_name) {
+    batch_.Add<DelBlobTask>(chi::CreateTaskId(), pool_id_,
+                            chi::PoolQuery::Dynamic(), tag_id, blob_name);
+    ops_.push_back(BlobBatchOp::kDel);
+  }
+
+  /** Queue a GetBlobSize; the size is reported in BlobBatchResult::size_ */
+  void GetSize(const TagId &tag_id, const std::string &blob_name) {
+    batch_.Add<GetBlobSizeTask>(chi::CreateTaskId(), pool_id_,
+                                chi::PoolQuery::Dynamic(), tag_id,
+                                blob_name);
+    ops_.push_back(BlobBatchOp::kGetSize);
+  }
+
+  /** Number of queued operations */
+  size_t Size() const { return ops_.size(); }
+
+  /** Serialized operations, as consumed by Admin::AsyncSubmitBatch */
+  const chimaera::admin::TaskBatch &GetTaskBatch() const { return batch_; }
+
+  /**
+   * Decode per-operation completions from a finished SubmitBatch task
+   * @param task Completed task returned by Client::AsyncBatch
+   * @return One result per queued operation, in queue order
+   */
+  std::vector<BlobBatchResult> GetResults(
+      const chimaera::admin::SubmitBatchTask &task) const {
+    std::vector<BlobBatchResult> results(ops_.size());
+    chi::priv::vector<char> out_buf(CHI_PRIV_ALLOC);
+    out_buf.reserve(task.serialized_out_.size());
+    for (char c : task.serialized_out_) {
+      out_buf.push_back(c);
+    }
+    chi::DefaultLoadArchive archive(out_buf);
+    archive.SetMsgType(chi::LocalMsgType::kSerializeOut);
+
+    for (size_t i = 0; i < ops_.size(); ++i) {
+      BlobBatchResult &result = results[i];
+      result.op_ = ops_[i];
+      if (i >= task.return_codes_.size() ||
+          task.return_codes_[i] == chimaera::admin::SubmitBatchTask::kNotRun) {
+        continue;
+      }
+      switch (ops_[i]) {
+        case BlobBatchOp::kPut:
+          result.return_code_ = LoadOutput<PutBlobTask>(archive).GetReturnCode();
+          break;
+        case BlobBatchOp::kGet:
+          result.return_code_ = LoadOutput<GetBlobTask>(archive).GetReturnCode();
+          break;
+        case BlobBatchOp::kDel:
+          result.return_code_ = LoadOutput<DelBlobTask>(archive).GetReturnCode();
+          break;
+        case BlobBatchOp::kGetSize: {
+          GetBlobSizeTask out = LoadOutput<GetBlobSizeTask>(archive);
+          result.return_code_ = out.GetReturnCode();
+          result.size_ = out.size_;
+          break;
+        }
+      }
+    }
+    return results;
+  }
+
+ private:
+  /** Deserialize the next sub-task's outputs */
+  template <typename TaskT>
+  static TaskT LoadOutput(chi::DefaultLoadArchive &archive) {
+    TaskT out;
+    archive >> out;
+    return out;
+  }
+
+  chi::PoolId pool_id_;
+  chimaera::admin::TaskBatch batch_;
+  std::vector<BlobBatchOp> ops_;
+};
+#endif  // HSHM_IS_HOST
+
 class Client : public chi::ContainerClient {
  public:
   HSHM_CROSS_FUN Client() = default;
@@ -205,20 +346,55 @@ class Client : public chi::ContainerClient {
    * @param tag_name Name of the tag
    * @param tag_id Optional tag ID
    * @param pool_query Pool query for task routing (default: Dynamic)
+   * @param placement Blob placement policy, applied if the tag has none yet
    */
   chi::Future<GetOrCreateTagTask<CreateParams>> AsyncGetOrCreateTag(
       const std::string &tag_name,
       const TagId &tag_id = TagId::GetNull(),
-      const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic(),
+      const TagPlacement &placement = TagPlacement()) {
     auto *ipc_manager = CHI_IPC;
+    if (WorkloadRecorder::IsEnabled()) {
+      WorkloadRecorder::Record(WorkloadOp::kGetOrCreateTag, tag_id,
+                               tag_name.c_str());
+    }
 
     auto task = ipc_manager->NewTask<GetOrCreateTagTask<CreateParams>>(
         chi::CreateTaskId(), pool_id_, pool_query, tag_name,
-        tag_id);
+        tag_id, placement);
+
+    return ipc_manager->Send(task);
+  }
+
+  /**
+   * Asynchronous get or create of many tags in one round trip
+   * @param tag_names Names of the tags
+   * @param placement Blob placement policy, applied to tags that have none
+   * @param pool_query Pool query for task routing (default: Local)
+   */
+  chi::Future<GetOrCreateTagsTask> AsyncGetOrCreateTags(
+      const std::vector<std::string> &tag_names,
+      const TagPlacement &placement = TagPlacement(),
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Local()) {
+    auto *ipc_manager = CHI_IPC;
+    if (WorkloadRecorder::IsEnabled()) {
+      for (const std::string &tag_name : tag_names) {
+        WorkloadRecorder::Record(WorkloadOp::kGetOrCreateTag,
+                                 TagId::GetNull(), tag_name.c_str());
+      }
+    }
+
+    auto task = ipc_manager->NewTask<GetOrCreateTagsTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, tag_names, placement);
 
     return ipc_manager->Send(task);
   }
 
+  /** Process-wide tag name to ID cache that Tag(tag_name) consults */
+  static TagIdCache *GetTagIdCache() {
+    return hshm::Singleton<TagIdCache>::GetInstance();
+  }
+
   /**
    * Asynchronous put blob with optional compression context - returns immediately
    * @param tag_id Tag ID
@@ -240,10 +416,15 @@ class Client : public chi::ContainerClient {
       chi::u32 flags = 0,
       const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
     auto *ipc_manager = CHI_IPC;
+    if (WorkloadRecorder::IsEnabled()) {
+      WorkloadRecorder::Record(WorkloadOp::kPutBlob, tag_id, blob_name,
+                               offset, size, score, flags);
+    }
 
     auto task = ipc_manager->NewTask<PutBlobTask>(
         chi::CreateTaskId(), pool_id_, pool_query, tag_id,
         blob_name, offset, size, blob_data, score, context, flags);
+    task->qos_class_ = qos_class_;
 
     return ipc_manager->Send(task);
   }
@@ -261,6 +442,65 @@ class Client : public chi::ContainerClient {
                         blob_data, score, context, flags, pool_query);
   }
 
+  /**
+   * Asynchronous batched put - writes several blobs of one tag with a single
+   * task. Blob i is named name_prefix + entries[i].blob_index_.
+   * @param tag_id Tag ID
+   * @param name_prefix Prefix shared by every blob name
+   * @param entries Blob writes; at most kMaxPutBlobBatch are sent
+   * @param score Blob score for placement: -1.0=unknown (auto)
+   * @param flags PutBlob flags for every blob
+   * @param pool_query Pool query for task routing (default: Local; each
+   *        entry is then routed like a standalone PutBlob)
+   */
+  chi::Future<PutBlobBatchTask> AsyncPutBlobBatch(
+      const TagId &tag_id, const std::string &name_prefix,
+      const std::vector<PutBlobBatchEntry> &entries, float score = -1.0f,
+      chi::u32 flags = 0,
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Local()) {
+    auto *ipc_manager = CHI_IPC;
+    auto task = ipc_manager->NewTask<PutBlobBatchTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, tag_id,
+        name_prefix.c_str(), score, flags);
+    for (const PutBlobBatchEntry &entry : entries) {
+      if (!task->Add(entry.blob_index_, entry.offset_, entry.size_,
+                     entry.data_)) {
+        break;
+      }
+    }
+    return ipc_manager->Send(task);
+  }
+
+  /**
+   * Asynchronous append - reserves the next size bytes of the tag on the
+   * container owning its append cursor and writes them as chunk blobs
+   * @param tag_id Tag ID
+   * @param size Size of data
+   * @param chunk_size Size of each chunk blob (blobs are named by chunk index)
+   * @param blob_data Shared memory pointer to data
+   * @param score Blob score for placement: -1.0=unknown (auto), 0.0-1.0=explicit tier
+   * @param context Compression context
+   * @param pool_query Pool query for task routing (default: Dynamic)
+   * @return Future whose offset_ holds the tag offset of the appended data
+   */
+  chi::Future<AppendBlobTask> AsyncAppendBlob(
+      const TagId &tag_id, chi::u64 size, chi::u64 chunk_size,
+      hipc::ShmPtr<> blob_data, float score = -1.0f,
+      const Context &context = Context(),
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
+    auto *ipc_manager = CHI_IPC;
+    if (WorkloadRecorder::IsEnabled()) {
+      WorkloadRecorder::Record(WorkloadOp::kAppendBlob, tag_id, nullptr, 0,
+                               size, score);
+    }
+
+    auto task = ipc_manager->NewTask<AppendBlobTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, tag_id, size, chunk_size,
+        blob_data, score, context);
+
+    return ipc_manager->Send(task);
+  }
+
   /**
    * Asynchronous get blob - returns immediately
    * @param tag_id Tag ID
@@ -279,10 +519,15 @@ class Client : public chi::ContainerClient {
       hipc::ShmPtr<> blob_data,
       const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
     auto *ipc_manager = CHI_IPC;
+    if (WorkloadRecorder::IsEnabled()) {
+      WorkloadRecorder::Record(WorkloadOp::kGetBlob, tag_id, blob_name,
+                               offset, size, 0.0f, flags);
+    }
 
     auto task = ipc_manager->NewTask<GetBlobTask>(
         chi::CreateTaskId(), pool_id_, pool_query, tag_id,
         blob_name, offset, size, flags, blob_data);
+    task->qos_class_ = qos_class_;
 
     return ipc_manager->Send(task);
   }
@@ -299,6 +544,49 @@ class Client : public chi::ContainerClient {
                         flags, blob_data, pool_query);
   }
 
+#if HSHM_IS_HOST
+  /**
+   * Asynchronous blob view - pin a blob range on RAM targets for this
+   * process to read in place
+   * @param tag_id Tag ID
+   * @param blob_name Name of the blob
+   * @param offset Offset within the blob
+   * @param size Bytes to view (0 = to the end of the blob)
+   * @param pool_query Pool query for task routing (default: Dynamic)
+   */
+  chi::Future<GetBlobViewTask> AsyncGetBlobView(
+      const TagId &tag_id, const std::string &blob_name, chi::u64 offset,
+      chi::u64 size,
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<GetBlobViewTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, tag_id, blob_name, offset,
+        size, ipc_manager->GetNodeId());
+
+    return ipc_manager->Send(task);
+  }
+
+  /**
+   * Asynchronous blob view release - unpin the blocks of a view
+   * @param tag_id Tag of the viewed blob
+   * @param blob_name Viewed blob
+   * @param lease_id Lease from AsyncGetBlobView
+   * @param pool_query Pool query for task routing (default: Dynamic)
+   */
+  chi::Future<ReleaseBlobViewTask> AsyncReleaseBlobView(
+      const TagId &tag_id, const std::string &blob_name, chi::u64 lease_id,
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<ReleaseBlobViewTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, tag_id, blob_name,
+        lease_id);
+
+    return ipc_manager->Send(task);
+  }
+#endif  // HSHM_IS_HOST
+
   /**
    * Asynchronous reorganize blob - returns immediately
    * @param tag_id Tag ID
@@ -310,6 +598,10 @@ class Client : public chi::ContainerClient {
       const TagId &tag_id, const std::string &blob_name, float new_score,
       const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
     auto *ipc_manager = CHI_IPC;
+    if (WorkloadRecorder::IsEnabled()) {
+      WorkloadRecorder::Record(WorkloadOp::kReorganizeBlob, tag_id,
+                               blob_name.c_str(), 0, 0, new_score);
+    }
 
     auto task = ipc_manager->NewTask<ReorganizeBlobTask>(
         chi::CreateTaskId(), pool_id_, pool_query, tag_id,
@@ -329,6 +621,9 @@ class Client : public chi::ContainerClient {
       const std::string &blob_name,
       const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
     auto *ipc_manager = CHI_IPC;
+    if (WorkloadRecorder::IsEnabled()) {
+      WorkloadRecorder::Record(WorkloadOp::kDelBlob, tag_id, blob_name.c_str());
+    }
 
     auto task = ipc_manager->NewTask<DelBlobTask>(chi::CreateTaskId(), pool_id_,
                                                   pool_query,
@@ -346,6 +641,10 @@ class Client : public chi::ContainerClient {
       const TagId &tag_id,
       const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
     auto *ipc_manager = CHI_IPC;
+    if (WorkloadRecorder::IsEnabled()) {
+      WorkloadRecorder::Record(WorkloadOp::kDelTag, tag_id, nullptr);
+    }
+    GetTagIdCache()->Erase(tag_id);
 
     auto task = ipc_manager->NewTask<DelTagTask>(
         chi::CreateTaskId(), pool_id_, pool_query, tag_id);
@@ -362,6 +661,11 @@ class Client : public chi::ContainerClient {
       const std::string &tag_name,
       const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
     auto *ipc_manager = CHI_IPC;
+    if (WorkloadRecorder::IsEnabled()) {
+      WorkloadRecorder::Record(WorkloadOp::kDelTag, TagId::GetNull(),
+                               tag_name.c_str());
+    }
+    GetTagIdCache()->Erase(tag_name);
 
     auto task = ipc_manager->NewTask<DelTagTask>(
         chi::CreateTaskId(), pool_id_, pool_query, tag_name);
@@ -378,6 +682,9 @@ class Client : public chi::ContainerClient {
       const TagId &tag_id,
       const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
     auto *ipc_manager = CHI_IPC;
+    if (WorkloadRecorder::IsEnabled()) {
+      WorkloadRecorder::Record(WorkloadOp::kGetTagSize, tag_id, nullptr);
+    }
 
     auto task = ipc_manager->NewTask<GetTagSizeTask>(
         chi::CreateTaskId(), pool_id_, pool_query, tag_id);
@@ -412,6 +719,10 @@ class Client : public chi::ContainerClient {
       const TagId &tag_id, const std::string &blob_name,
       const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
     auto *ipc_manager = CHI_IPC;
+    if (WorkloadRecorder::IsEnabled()) {
+      WorkloadRecorder::Record(WorkloadOp::kGetBlobScore, tag_id,
+                               blob_name.c_str());
+    }
 
     auto task = ipc_manager->NewTask<GetBlobScoreTask>(
         chi::CreateTaskId(), pool_id_, pool_query, tag_id,
@@ -431,6 +742,10 @@ class Client : public chi::ContainerClient {
       const std::string &blob_name,
       const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
     auto *ipc_manager = CHI_IPC;
+    if (WorkloadRecorder::IsEnabled()) {
+      WorkloadRecorder::Record(WorkloadOp::kGetBlobSize, tag_id,
+                               blob_name.c_str());
+    }
 
     auto task = ipc_manager->NewTask<GetBlobSizeTask>(
         chi::CreateTaskId(), pool_id_, pool_query, tag_id,
@@ -452,6 +767,10 @@ class Client : public chi::ContainerClient {
       const std::string &blob_name,
       const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
     auto *ipc_manager = CHI_IPC;
+    if (WorkloadRecorder::IsEnabled()) {
+      WorkloadRecorder::Record(WorkloadOp::kGetBlobInfo, tag_id,
+                               blob_name.c_str());
+    }
 
     auto task = ipc_manager->NewTask<GetBlobInfoTask>(
         chi::CreateTaskId(), pool_id_, pool_query, tag_id,
@@ -469,6 +788,9 @@ class Client : public chi::ContainerClient {
       const TagId &tag_id,
       const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
     auto *ipc_manager = CHI_IPC;
+    if (WorkloadRecorder::IsEnabled()) {
+      WorkloadRecorder::Record(WorkloadOp::kGetContainedBlobs, tag_id, nullptr);
+    }
 
     auto task = ipc_manager->NewTask<GetContainedBlobsTask>(
         chi::CreateTaskId(), pool_id_, pool_query, tag_id);
@@ -500,17 +822,21 @@ class Client : public chi::ContainerClient {
    * @param blob_regex Blob regex pattern to match
    * @param max_blobs Maximum number of blobs to return (0 = no limit)
    * @param pool_query Pool query for routing (default: Broadcast)
+   * @param cursor_tag Tag name of the last result of the previous page
+   * @param cursor_blob Blob name of the last result of the previous page
    * @return Future for async operation
    */
   chi::Future<BlobQueryTask> AsyncBlobQuery(
       const std::string &tag_regex, const std::string &blob_regex,
       chi::u32 max_blobs = 0,
-      const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast()) {
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast(),
+      const std::string &cursor_tag = "",
+      const std::string &cursor_blob = "") {
     auto *ipc_manager = CHI_IPC;
 
     auto task = ipc_manager->NewTask<BlobQueryTask>(
         chi::CreateTaskId(), pool_id_, pool_query, tag_regex, blob_regex,
-        max_blobs);
+        max_blobs, cursor_tag, cursor_blob);
 
     return ipc_manager->Send(task);
   }
@@ -535,20 +861,373 @@ class Client : public chi::ContainerClient {
     return ipc_manager->Send(task);
   }
 
+  /**
+   * Asynchronous WAL group commit - returns immediately
+   * @param pool_query Pool query for task routing (default: Local)
+   * @param period_us Period in microseconds (0 = one-shot)
+   */
+  chi::Future<CommitTransactionLogsTask> AsyncCommitTransactionLogs(
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Local(),
+      double period_us = 0) {
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<CommitTransactionLogsTask>(
+        chi::CreateTaskId(), pool_id_, pool_query);
+
+    if (period_us > 0) {
+      task->SetPeriod(period_us, chi::kMicro);
+      task->SetFlags(TASK_PERIODIC);
+    }
+
+    return ipc_manager->Send(task);
+  }
+
+  /**
+   * Asynchronous set tag replication - returns immediately
+   * @param tag_id Tag whose blobs are replicated
+   * @param replicas Containers holding each blob (1 = no replication)
+   * @param pool_query Pool query for task routing (default: Broadcast)
+   */
+  chi::Future<SetTagReplicationTask> AsyncSetTagReplication(
+      const TagId &tag_id, chi::u32 replicas,
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast()) {
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<SetTagReplicationTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, tag_id, replicas);
+
+    return ipc_manager->Send(task);
+  }
+
+  /**
+   * Asynchronous set tag placement - returns immediately
+   * @param tag_id Tag whose blobs are placed
+   * @param placement Placement policy
+   * @param pool_query Pool query for task routing (default: Broadcast)
+   */
+  chi::Future<SetTagPlacementTask> AsyncSetTagPlacement(
+      const TagId &tag_id, const TagPlacement &placement,
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast()) {
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<SetTagPlacementTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, tag_id, placement);
+
+    return ipc_manager->Send(task);
+  }
+
+  /**
+   * Asynchronous set tag dedup - returns immediately
+   * @param tag_id Tag whose blobs are deduplicated
+   * @param chunk_size Bytes per fingerprinted chunk (0 = off)
+   * @param pool_query Pool query for task routing (default: Broadcast)
+   */
+  chi::Future<SetTagDedupTask> AsyncSetTagDedup(
+      const TagId &tag_id, chi::u64 chunk_size,
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast()) {
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<SetTagDedupTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, tag_id, chunk_size);
+
+    return ipc_manager->Send(task);
+  }
+
+  /**
+   * Asynchronous set tag TTL - returns immediately
+   * @param tag_id Tag whose blobs expire
+   * @param ttl_ms Lifetime of each write in milliseconds (0 = off)
+   * @param pool_query Pool query for task routing (default: Broadcast)
+   */
+  chi::Future<SetTagTtlTask> AsyncSetTagTtl(
+      const TagId &tag_id, chi::u64 ttl_ms,
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast()) {
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<SetTagTtlTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, tag_id, ttl_ms);
+
+    return ipc_manager->Send(task);
+  }
+
+  /**
+   * Asynchronous set tag erasure coding - returns immediately
+   * @param tag_id Tag whose blobs are erasure coded
+   * @param data_shards Data shards per blob (0 = off)
+   * @param parity_shards Parity shards per blob
+   * @param pool_query Pool query for task routing (default: Broadcast)
+   */
+  chi::Future<SetTagErasureTask> AsyncSetTagErasure(
+      const TagId &tag_id, chi::u32 data_shards, chi::u32 parity_shards,
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast()) {
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<SetTagErasureTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, tag_id, data_shards,
+        parity_shards);
+
+    return ipc_manager->Send(task);
+  }
+
+  /**
+   * Asynchronous set tag encryption - returns immediately
+   * @param tag_id Tag whose blobs are encrypted at rest
+   * @param chunk_size Plaintext bytes per sealed chunk (0 = off)
+   * @param pool_query Pool query for task routing (default: Broadcast)
+   */
+  chi::Future<SetTagEncryptionTask> AsyncSetTagEncryption(
+      const TagId &tag_id, chi::u32 chunk_size,
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast()) {
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<SetTagEncryptionTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, tag_id, chunk_size);
+
+    return ipc_manager->Send(task);
+  }
+
+  /**
+   * Asynchronous blob splice - returns immediately
+   * @param src_tag_id Tag holding the blobs
+   * @param blob_regex Pattern selecting the blobs to splice
+   * @param dst_tag_id Tag receiving the links (same blob names)
+   * @param pool_query Pool query for task routing (default: Broadcast)
+   */
+  chi::Future<SpliceBlobsTask> AsyncSpliceBlobs(
+      const TagId &src_tag_id, const std::string &blob_regex,
+      const TagId &dst_tag_id,
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast()) {
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<SpliceBlobsTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, src_tag_id, blob_regex,
+        dst_tag_id);
+
+    return ipc_manager->Send(task);
+  }
+
+  /**
+   * Asynchronous blob stub registration - returns immediately
+   * @param tag_id Tag ID
+   * @param blob_name Name of the blob
+   * @param source_path File holding the blob's bytes
+   * @param source_offset Byte offset of the blob in source_path
+   * @param size Blob size in bytes
+   * @param score Score applied if the stub is cached on first read
+   * @param stub_flags kBlobStub* flags (e.g. kBlobStubCache)
+   * @param pool_query Pool query for task routing (default: Dynamic)
+   */
+  chi::Future<RegisterBlobStubTask> AsyncRegisterBlobStub(
+      const TagId &tag_id, const std::string &blob_name,
+      const std::string &source_path, chi::u64 source_offset, chi::u64 size,
+      float score = 1.0f, chi::u32 stub_flags = 0,
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<RegisterBlobStubTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, tag_id, blob_name,
+        source_path, source_offset, size, score, stub_flags);
+
+    return ipc_manager->Send(task);
+  }
+
+  /**
+   * Asynchronous blob reservation - returns immediately
+   * @param tag_id Tag ID
+   * @param blob_name Name of the blob
+   * @param size Capacity to allocate; the blob reads as zeros past its data
+   * @param score Placement score (negative keeps the blob's, default 1.0)
+   * @param pool_query Pool query for task routing (default: Dynamic)
+   */
+  chi::Future<ReserveBlobTask> AsyncReserveBlob(
+      const TagId &tag_id, const std::string &blob_name, chi::u64 size,
+      float score = -1.0f,
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Dynamic()) {
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<ReserveBlobTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, tag_id, blob_name, size,
+        score);
+
+    return ipc_manager->Send(task);
+  }
+
+  /**
+   * Asynchronous replica repair - returns immediately
+   * @param pool_query Pool query for task routing (default: Local)
+   * @param force Scan even if no container moved since the last pass
+   * @param period_us Period in microseconds (0 = one-shot)
+   */
+  chi::Future<RepairReplicasTask> AsyncRepairReplicas(
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Local(),
+      bool force = false, double period_us = 0) {
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<RepairReplicasTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, force);
+
+    if (period_us > 0) {
+      task->SetPeriod(period_us, chi::kMicro);
+      task->SetFlags(TASK_PERIODIC);
+    }
+
+    return ipc_manager->Send(task);
+  }
+
+  /**
+   * Asynchronous set placement weights - returns immediately
+   * @param weights Weight per container ID, e.g. proportional to the
+   * capacity of its node (empty = modulo hashing)
+   * @param vnodes Virtual nodes per unit of weight
+   * @param pool_query Pool query for task routing (default: Broadcast)
+   */
+  chi::Future<SetPlacementWeightsTask> AsyncSetPlacementWeights(
+      const std::vector<chi::u32> &weights, chi::u32 vnodes = 64,
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Broadcast()) {
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<SetPlacementWeightsTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, weights, vnodes);
+
+    return ipc_manager->Send(task);
+  }
+
+  /**
+   * Asynchronous blob rebalancing - returns immediately
+   * @param pool_query Pool query for task routing (default: Local)
+   * @param max_blobs Maximum blobs moved per pass
+   * @param period_us Period in microseconds (0 = one-shot)
+   */
+  chi::Future<RebalanceBlobsTask> AsyncRebalanceBlobs(
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Local(),
+      chi::u32 max_blobs = 256, double period_us = 0) {
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<RebalanceBlobsTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, max_blobs);
+
+    if (period_us > 0) {
+      task->SetPeriod(period_us, chi::kMicro);
+      task->SetFlags(TASK_PERIODIC);
+    }
+
+    return ipc_manager->Send(task);
+  }
+
   /**
    * Asynchronous flush data - returns immediately
    * @param pool_query Pool query for task routing (default: Local)
    * @param target_persistence_level Minimum persistence level for flush target
    * @param period_us Period in microseconds (0 = one-shot)
+   * @param max_inflight Dirty blobs read and written per batch
    */
   chi::Future<FlushDataTask> AsyncFlushData(
       const chi::PoolQuery &pool_query = chi::PoolQuery::Local(),
       int target_persistence_level = 1,
-      double period_us = 0) {
+      double period_us = 0, chi::u32 max_inflight = 8) {
     auto *ipc_manager = CHI_IPC;
 
     auto task = ipc_manager->NewTask<FlushDataTask>(
-        chi::CreateTaskId(), pool_id_, pool_query, target_persistence_level);
+        chi::CreateTaskId(), pool_id_, pool_query, target_persistence_level,
+        max_inflight);
+
+    if (period_us > 0) {
+      task->SetPeriod(period_us, chi::kMicro);
+      task->SetFlags(TASK_PERIODIC);
+    }
+
+    return ipc_manager->Send(task);
+  }
+
+  /**
+   * Asynchronous blob defragmentation - returns immediately
+   * @param pool_query Pool query for task routing (default: Local)
+   * @param min_blocks Rewrite blobs made of at least this many blocks
+   * @param period_us Period in microseconds (0 = one-shot)
+   */
+  chi::Future<DefragBlobsTask> AsyncDefragBlobs(
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Local(),
+      chi::u32 min_blocks = 16,
+      double period_us = 0) {
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<DefragBlobsTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, min_blocks);
+
+    if (period_us > 0) {
+      task->SetPeriod(period_us, chi::kMicro);
+      task->SetFlags(TASK_PERIODIC);
+    }
+
+    return ipc_manager->Send(task);
+  }
+
+  /**
+   * Asynchronous heat-driven tier migration - returns immediately
+   * @param pool_query Pool query for task routing (default: Local)
+   * @param bandwidth_mbps Max data moved by migration (MB/s)
+   * @param half_life_ms Half-life of blob access heat
+   * @param promote_heat Promote blobs at or above this heat
+   * @param demote_heat Demote blobs at or below this heat
+   * @param period_us Period in microseconds (0 = one-shot)
+   */
+  chi::Future<MigrateBlobsTask> AsyncMigrateBlobs(
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Local(),
+      chi::u32 bandwidth_mbps = 64, chi::u32 half_life_ms = 60000,
+      float promote_heat = 4.0f, float demote_heat = 0.25f,
+      double period_us = 0) {
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<MigrateBlobsTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, bandwidth_mbps,
+        half_life_ms, promote_heat, demote_heat);
+
+    if (period_us > 0) {
+      task->SetPeriod(period_us, chi::kMicro);
+      task->SetFlags(TASK_PERIODIC);
+    }
+
+    return ipc_manager->Send(task);
+  }
+
+  /**
+   * Asynchronous capacity-pressure eviction - returns immediately
+   * @param pool_query Pool query for task routing (default: Local)
+   * @param high_watermark Used fraction of a target that starts eviction
+   * @param low_watermark Used fraction eviction drains the target to
+   * @param period_us Period in microseconds (0 = one-shot)
+   */
+  chi::Future<EvictTargetsTask> AsyncEvictTargets(
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Local(),
+      float high_watermark = 0.9f, float low_watermark = 0.75f,
+      double period_us = 0) {
+    auto *ipc_manager = CHI_IPC;
+
+    auto task = ipc_manager->NewTask<EvictTargetsTask>(
+        chi::CreateTaskId(), pool_id_, pool_query, high_watermark,
+        low_watermark);
+
+    if (period_us > 0) {
+      task->SetPeriod(period_us, chi::kMicro);
+      task->SetFlags(TASK_PERIODIC);
+    }
+
+    return ipc_manager->Send(task);
+  }
+
+  /**
+   * Asynchronous TTL expiry - returns immediately
+   * @param pool_query Pool query for task routing (default: Local)
+   * @param period_us Period in microseconds (0 = one-shot)
+   */
+  chi::Future<ExpireBlobsTask> AsyncExpireBlobs(
+      const chi::PoolQuery &pool_query = chi::PoolQuery::Local(),
+      double period_us = 0) {
+    auto *ipc_manager = CHI_IPC;
+
+    auto task =
+        ipc_manager->NewTask<ExpireBlobsTask>(chi::CreateTaskId(), pool_id_,
+                                              pool_query);
 
     if (period_us > 0) {
       task->SetPeriod(period_us, chi::kMicro);
@@ -557,7 +1236,67 @@ class Client : public chi::ContainerClient {
 
     return ipc_manager->Send(task);
   }
+
+  /**
+   * Start a batch of blob operations against this pool
+   * @return Empty BlobBatch bound to pool_id_
+   */
+  BlobBatch NewBatch() const { return BlobBatch(pool_id_); }
+
+  /**
+   * Asynchronous batch submission - one enqueue for the whole batch
+   * @param batch Operations built with NewBatch()
+   * @return Future for the admin SubmitBatchTask; pass the completed task to
+   * BlobBatch::GetResults for per-operation completions
+   */
+  chi::Future<chimaera::admin::SubmitBatchTask> AsyncBatch(
+      const BlobBatch &batch) {
+    auto *admin_client = CHI_ADMIN;
+    return admin_client->AsyncSubmitBatch(chi::PoolQuery::Local(),
+                                          batch.GetTaskBatch());
+  }
 #endif  // HSHM_IS_HOST
+
+  /**
+   * Put this client's blob reads and writes in one QoS class, overriding
+   * the class assigned to their tags
+   * @param qos_class Class ID (index in the qos classes plus one, 0 = by tag)
+   */
+  HSHM_CROSS_FUN void SetQosClass(chi::u32 qos_class) {
+    qos_class_ = qos_class;
+  }
+
+  /** @return QoS class set by SetQosClass */
+  HSHM_CROSS_FUN chi::u32 GetQosClass() const { return qos_class_; }
+
+  /**
+   * Let Tag::GetBlob into a plain buffer copy straight from a blob view
+   * when the range sits on RAM targets this process can map, instead of
+   * having the runtime copy it into a staging buffer
+   * @param enable true to try views first
+   */
+  HSHM_CROSS_FUN void SetBlobViews(bool enable) { blob_views_ = enable; }
+
+  /** @return Whether SetBlobViews enabled views */
+  HSHM_CROSS_FUN bool UseBlobViews() const { return blob_views_; }
+
+  /**
+   * Let Tag::GetBlobSize and Tag::GetBlobScore read the copy the local
+   * runtime publishes in shared memory before sending a task. On by
+   * default; a miss or a slot being written falls back to the task
+   * @param enable false to always ask the runtime
+   */
+  HSHM_CROSS_FUN void SetBlobMetaReads(bool enable) {
+    blob_meta_reads_ = enable;
+  }
+
+  /** @return Whether SetBlobMetaReads left shared reads on */
+  HSHM_CROSS_FUN bool UseBlobMetaReads() const { return blob_meta_reads_; }
+
+ private:
+  chi::u32 qos_class_ = 0;
+  bool blob_views_ = false;
+  bool blob_meta_reads_ = true;
 };
 
 // Global pointer-based singleton for CTE client with lazy initialization
@@ -577,6 +1316,17 @@ bool WRP_CTE_CLIENT_INIT(
 /**
  * Tag wrapper class - provides convenient API for tag operations
  */
+/**
+ * One piece of a vectored blob operation: size_ bytes at blob_off_ within
+ * blob blob_name_. Extents in a batch map to consecutive bytes of the
+ * caller's buffer, in order.
+ */
+struct BlobExtent {
+  std::string blob_name_;
+  size_t blob_off_;
+  size_t size_;
+};
+
 class Tag {
  private:
   TagId tag_id_;
@@ -584,11 +1334,21 @@ class Tag {
 
  public:
   /**
-   * Constructor - Call the WRP_CTE client GetOrCreateTag function
+   * Constructor - Call the WRP_CTE client GetOrCreateTag function. A name
+   * this process resolved recently is served from the TagIdCache.
    * @param tag_name Tag name to get or create
    */
   explicit Tag(const std::string &tag_name);
 
+  /**
+   * Constructor - GetOrCreateTag with a blob placement policy. Only the
+   * default placement uses the TagIdCache, since a placement must reach
+   * the tag's container.
+   * @param tag_name Tag name to get or create
+   * @param placement Placement policy, applied if the tag has none yet
+   */
+  Tag(const std::string &tag_name, const TagPlacement &placement);
+
   /**
    * Constructor - Does not call WRP_CTE client function, just sets the TagId
    * variable
@@ -596,8 +1356,22 @@ class Tag {
    */
   explicit Tag(const TagId &tag_id);
 
+  /**
+   * Open or create many tags with one GetOrCreateTags round trip for the
+   * names that miss the TagIdCache
+   * @param tag_names Tag names to get or create
+   * @param placement Placement policy, applied to tags that have none yet
+   * @return Tags in tag_names order
+   * @throws std::runtime_error if any tag could not be opened
+   */
+  static std::vector<Tag> GetOrCreateTags(
+      const std::vector<std::string> &tag_names,
+      const TagPlacement &placement = TagPlacement());
+
   /**
    * PutBlob - Allocates a SHM pointer and then calls PutBlob (SHM)
+   * If data already lives in client shared memory (e.g. a buffer from
+   * CHI_IPC->AllocateUserShm), it is passed through without a copy
    * @param blob_name Name of the blob
    * @param data Raw data pointer
    * @param data_size Size of data
@@ -641,6 +1415,71 @@ class Tag {
                                         float score = -1.0f,
                                         const Context &context = Context());
 
+  /**
+   * PutBlobBatch - Vectored PutBlob that keeps up to kMaxBatchInflight
+   * AsyncPutBlob tasks in flight instead of one blocking round trip per blob
+   * @param extents Blob pieces to write, in buffer order
+   * @param data Raw data holding all extents back to back
+   * @param score Blob score for placement decisions (default 1.0)
+   * @param context Compression context for workflow-aware decisions
+   * @return Bytes covered by the leading run of extents that succeeded
+   * @throws std::runtime_error if shared memory cannot be allocated
+   */
+  size_t PutBlobBatch(const std::vector<BlobExtent> &extents,
+                      const char *data, float score = 1.0f,
+                      const Context &context = Context());
+
+  /**
+   * GetBlobBatch - Vectored GetBlob that keeps up to kMaxBatchInflight
+   * AsyncGetBlob tasks in flight and copies results into one buffer
+   * @param extents Blob pieces to read, in buffer order
+   * @param data Output buffer large enough for all extents back to back
+   * @return Bytes covered by the leading run of extents that succeeded
+   * @throws std::runtime_error if shared memory cannot be allocated
+   */
+  size_t GetBlobBatch(const std::vector<BlobExtent> &extents, char *data);
+
+  /**
+   * AppendBlob - Atomically append data to the end of the tag in a single
+   * round trip; the offset is reserved by the runtime, not computed here
+   * @param data Raw data pointer
+   * @param data_size Size of data
+   * @param chunk_size Size of each chunk blob of the tag
+   * @param score Blob score for placement decisions (default 1.0)
+   * @param context Compression context for workflow-aware decisions
+   * @return Tag offset at which the data was appended
+   * @throws std::runtime_error if allocation or the append fails
+   */
+  size_t AppendBlob(const char *data, size_t data_size, size_t chunk_size,
+                    float score = 1.0f, const Context &context = Context());
+
+  /**
+   * ReserveBlob - Allocate a blob's capacity up front, like posix_fallocate.
+   * The blob grows to size bytes, reading as zeros past its data, and later
+   * writes inside it, including chunks written at offset 0, reuse the
+   * reserved blocks. A blob already that large is left as it is.
+   * @param blob_name Name of the blob
+   * @param size Capacity in bytes
+   * @param score Placement score (negative keeps the blob's, default 1.0)
+   * @throws std::runtime_error if the capacity cannot be allocated
+   */
+  void ReserveBlob(const std::string &blob_name, size_t size,
+                   float score = -1.0f);
+
+  /**
+   * ReserveBlobBatch - Reserve several blobs, keeping up to
+   * kMaxBatchInflight reservations in flight
+   * @param extents Ranges to reserve; each blob is reserved up to
+   *        blob_off_ + size_
+   * @param score Placement score (negative keeps each blob's, default 1.0)
+   * @throws std::runtime_error if any reservation fails
+   */
+  void ReserveBlobBatch(const std::vector<BlobExtent> &extents,
+                        float score = -1.0f);
+
+  /** Maximum blob tasks kept in flight by PutBlobBatch / GetBlobBatch */
+  static constexpr size_t kMaxBatchInflight = 32;
+
   /**
    * GetBlob - Allocates shared memory, retrieves blob data, copies to output
    * buffer
@@ -649,7 +1488,10 @@ class Tag {
    * caller)
    * @param data_size Size of data to retrieve (must be > 0)
    * @param off Offset within blob (default 0)
-   * @note Automatically handles shared memory allocation/deallocation
+   * @note Automatically handles shared memory allocation/deallocation; an
+   * output buffer from CHI_IPC->AllocateUserShm is filled in place, and with
+   * Client::SetBlobViews a range on mappable RAM targets is copied straight
+   * from a blob view
    */
   void GetBlob(const std::string &blob_name, char *data, size_t data_size,
                size_t off = 0);
@@ -668,14 +1510,29 @@ class Tag {
                size_t data_size, size_t off = 0);
 
   /**
-   * Get blob score
+   * GetBlobView - Read-only view of a blob range in place on RAM targets
+   * created with shared: true on this node; see BlobView
+   * @param blob_name Name of the blob
+   * @param data_size Bytes to view (0 = to the end of the blob)
+   * @param off Offset within blob (default 0)
+   * @return View holding the lease; IsValid() is false if the range cannot
+   * be viewed (other targets, another node, or encoded), in which case
+   * GetBlob reads it
+   * @throws std::runtime_error if the blob or range does not exist
+   */
+  BlobView GetBlobView(const std::string &blob_name, size_t data_size = 0,
+                       size_t off = 0);
+
+  /**
+   * Get blob score. Read from the local runtime's shared copy when it has
+   * one (Client::SetBlobMetaReads), else from the owning container
    * @param blob_name Name of the blob
    * @return Blob score (0.0-1.0)
    */
   float GetBlobScore(const std::string &blob_name);
 
   /**
-   * Get blob size
+   * Get blob size, read like GetBlobScore
    * @param blob_name Name of the blob
    * @return Blob size in bytes
    */
@@ -694,11 +1551,115 @@ class Tag {
    */
   void ReorganizeBlob(const std::string &blob_name, float new_score);
 
+  /**
+   * Keep each blob of this tag on several containers. Writes succeed once a
+   * majority of the replicas hold the data; reads go to the nearest replica.
+   * @param replicas Containers holding each blob (1 = no replication)
+   * @throws std::runtime_error if the setting could not be applied
+   */
+  void SetReplication(chi::u32 replicas);
+
+  /**
+   * Store each chunk of identical content in this tag's blobs only once.
+   * Full writes are split into chunk_size pieces; a piece whose bytes are
+   * already stored references the existing extent instead.
+   * @param chunk_size Bytes per chunk, a multiple of 4KB (0 = off)
+   * @throws std::runtime_error if the setting could not be applied
+   */
+  void SetDedup(chi::u64 chunk_size);
+
+  /**
+   * Protect this tag's blobs with a Reed-Solomon code instead of copies.
+   * Each blob is stored as data_shards pieces plus parity_shards parity
+   * pieces on distinct targets; any data_shards of them rebuild the blob,
+   * at (k + m) / k times the space.
+   * @param data_shards k, at least 1 (0 = off)
+   * @param parity_shards m, at least 1, with k + m <= 256
+   * @throws std::runtime_error if the setting could not be applied
+   */
+  void SetErasureCoding(chi::u32 data_shards, chi::u32 parity_shards);
+
+  /** Default plaintext bytes per sealed chunk of an encrypted tag */
+  static constexpr chi::u32 kDefaultEncryptChunk = 64 * 1024;
+
+  /**
+   * Encrypt this tag's blobs at rest with AES-256-GCM under the key named
+   * by the runtime's encryption_key_path. Blobs are sealed in chunks of
+   * chunk_size bytes, so a ranged read opens only the chunks it covers.
+   * @param chunk_size Plaintext bytes per chunk (0 = off)
+   * @throws std::runtime_error if the setting could not be applied (no key
+   *         configured, or the tag is erasure coded)
+   */
+  void SetEncryption(chi::u32 chunk_size = kDefaultEncryptChunk);
+
+  /**
+   * Free each blob of this tag ttl_ms after its last write. A TTL given in
+   * the Context of a PutBlob takes precedence for that write.
+   * @param ttl_ms Lifetime in milliseconds (0 = off)
+   * @throws std::runtime_error if the setting could not be applied
+   */
+  void SetTtl(chi::u64 ttl_ms);
+
+  /**
+   * Freeze the current contents of this tag. Every blob is linked into a
+   * snapshot tag that shares its extents, so the cost is one metadata entry
+   * per blob. Later writes to this tag go to new extents and leave the
+   * snapshot as it was.
+   * @param retain_ms Free the snapshot's blobs this long after it is taken
+   *        (0 = keep until DeleteSnapshot)
+   * @return Snapshot id, larger than that of every listed snapshot
+   * @throws std::runtime_error if the tag was opened by id or linking failed
+   */
+  chi::u64 Snapshot(chi::u64 retain_ms = 0);
+
+  /**
+   * Ids of this tag's snapshots
+   * @return Snapshot ids in ascending order
+   */
+  std::vector<chi::u64> ListSnapshots();
+
+  /**
+   * Open a snapshot for reading
+   * @param snapshot_id Id returned by Snapshot
+   * @return Tag holding the snapshot's blobs under their original names
+   * @throws std::runtime_error if there is no such snapshot
+   */
+  Tag OpenSnapshot(chi::u64 snapshot_id);
+
+  /**
+   * Delete a snapshot. Extents still used by this tag or by other
+   * snapshots stay.
+   * @param snapshot_id Id returned by Snapshot
+   * @throws std::runtime_error if the snapshot could not be deleted
+   */
+  void DeleteSnapshot(chi::u64 snapshot_id);
+
+  /**
+   * Name of the tag that holds a snapshot
+   * @param tag_name Name of the snapshotted tag
+   * @param snapshot_id Snapshot id
+   * @return Tag name of the snapshot
+   */
+  static std::string SnapshotName(const std::string &tag_name,
+                                  chi::u64 snapshot_id);
+
   /**
    * Get the TagId for this tag
    * @return TagId of this tag
    */
   const TagId &GetTagId() const { return tag_id_; }
+
+  /**
+   * Resolve a raw buffer that already lives in a registered shm segment
+   * Adapters use this to hand user buffers from CHI_IPC->AllocateUserShm to
+   * AsyncPutBlob without a staging copy
+   * @param data Start of the buffer
+   * @param data_size Size of the buffer
+   * @param shm_ptr Output: shared memory pointer to data
+   * @return true if the whole range is inside one segment
+   */
+  static bool ResolveShmBuffer(const char *data, size_t data_size,
+                               hipc::ShmPtr<> &shm_ptr);
 };
 
 }  // namespace wrp_cte::core
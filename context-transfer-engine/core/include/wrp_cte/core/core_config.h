@@ -59,11 +59,46 @@ struct PerformanceConfig {
   chi::u32 flush_metadata_period_ms_;  // Period for periodic metadata flush
                                        // (default 5s)
   std::string metadata_log_path_;   // Path for metadata log (empty = disabled)
+  chi::u32 metadata_compact_deltas_;  // Deltas folded into a new base image
   chi::u32 flush_data_period_ms_;   // Period for data flush (default 10s)
   int flush_data_min_persistence_;  // Min persistence level to flush to
                                     // (1=temp-nonvolatile)
+  chi::u32 flush_data_max_inflight_;  // Blobs in flight per flush batch
+  chi::u32 defrag_period_ms_;   // Period for blob defragmentation (default 60s)
+  chi::u32 defrag_min_blocks_;  // Blocks at which a blob is rewritten
+  chi::u32 migrate_period_ms_;  // Period for heat-driven tier migration
+                                // (default 10s, 0 = off)
+  chi::u32 migrate_bandwidth_mbps_;  // Migration bandwidth budget (MB/s)
+  chi::u32 migrate_half_life_ms_;    // Half-life of blob access heat
+  float migrate_promote_heat_;  // Heat at or above which blobs are promoted
+  float migrate_demote_heat_;   // Heat at or below which blobs are demoted
+  chi::u32 evict_period_ms_;  // Period for capacity-pressure eviction
+                              // (default 1s, 0 = off)
+  float evict_high_watermark_;  // Used fraction that starts eviction
+  float evict_low_watermark_;   // Used fraction eviction drains down to
+  std::string evict_policy_;    // Victim order ("lru", "lfu", "arc")
+  chi::u64 read_cache_size_;  // DRAM read cache per container (0 = off)
+  chi::u64 read_cache_max_blob_;  // Largest blob the read cache holds (4MB)
+  chi::u64 small_object_max_size_;  // Largest PutBlob packed into segments
+                                    // (4KB, 0 = off)
+  chi::u64 small_segment_size_;     // Size of a packing segment (1MB)
+  float small_segment_clean_ratio_;  // Live fraction at which DefragBlobs
+                                     // cleans a sealed segment
+  chi::u32 expire_period_ms_;  // Period for freeing blobs past their TTL
+                               // (default 1s, 0 = off)
+  chi::u32 replica_repair_period_ms_;  // Period for replica repair checks
+                                       // (default 5s, 0 = off)
+  chi::u32 placement_vnodes_;  // Consistent-hash virtual nodes per container
+                               // (0 = modulo placement)
+  chi::u32 rebalance_period_ms_;  // Period for moving re-placed blobs (1s)
   chi::u64
       transaction_log_capacity_bytes_;  // Total WAL capacity (default 32MB)
+  chi::u64 transaction_log_segment_bytes_;  // WAL segment file size (4MB)
+  chi::u32 transaction_log_commit_ms_;  // WAL group commit window (10ms)
+  chi::u32 telemetry_capacity_;     // Telemetry entries kept per worker
+  chi::u32 telemetry_sample_rate_;  // Record one of every N operations
+  std::string encryption_key_path_;  // Key file for encrypted tags
+                                     // (empty = encryption unavailable)
 
   PerformanceConfig()
       : target_stat_interval_ms_(5000),
@@ -73,9 +108,36 @@ struct PerformanceConfig {
         score_difference_threshold_(0.05f),
         flush_metadata_period_ms_(5000),
         metadata_log_path_(""),
+        metadata_compact_deltas_(16),
         flush_data_period_ms_(10000),
         flush_data_min_persistence_(1),
-        transaction_log_capacity_bytes_(32ULL * 1024ULL * 1024ULL) {}
+        flush_data_max_inflight_(8),
+        defrag_period_ms_(60000),
+        defrag_min_blocks_(16),
+        migrate_period_ms_(10000),
+        migrate_bandwidth_mbps_(64),
+        migrate_half_life_ms_(60000),
+        migrate_promote_heat_(4.0f),
+        migrate_demote_heat_(0.25f),
+        evict_period_ms_(1000),
+        evict_high_watermark_(0.9f),
+        evict_low_watermark_(0.75f),
+        evict_policy_("arc"),
+        read_cache_size_(0),
+        read_cache_max_blob_(4ULL * 1024ULL * 1024ULL),
+        small_object_max_size_(4096),
+        small_segment_size_(1024ULL * 1024ULL),
+        small_segment_clean_ratio_(0.25f),
+        expire_period_ms_(1000),
+        replica_repair_period_ms_(5000),
+        placement_vnodes_(0),
+        rebalance_period_ms_(1000),
+        transaction_log_capacity_bytes_(32ULL * 1024ULL * 1024ULL),
+        transaction_log_segment_bytes_(4ULL * 1024ULL * 1024ULL),
+        transaction_log_commit_ms_(10),
+        telemetry_capacity_(8192),
+        telemetry_sample_rate_(1),
+        encryption_key_path_("") {}
 };
 
 /**
@@ -103,9 +165,15 @@ struct StorageDeviceConfig {
   float score_;  // Optional manual score (0.0-1.0), -1.0 means use automatic
                  // scoring
   std::string persistence_level_;  // "volatile", "temporary", "long_term"
+  chi::u64 max_bandwidth_;  // QoS rate limit in bytes/s per target (0 = none)
+  int numa_node_;  // Socket the device hangs off (-1 = detect from the path)
 
   StorageDeviceConfig()
-      : capacity_limit_(0), score_(-1.0f), persistence_level_("volatile") {}
+      : capacity_limit_(0),
+        score_(-1.0f),
+        persistence_level_("volatile"),
+        max_bandwidth_(0),
+        numa_node_(-1) {}
   StorageDeviceConfig(const std::string &path, const std::string &bdev_type,
                       chi::u64 capacity, float score = -1.0f,
                       const std::string &persistence_level = "volatile")
@@ -113,7 +181,9 @@ struct StorageDeviceConfig {
         bdev_type_(bdev_type),
         capacity_limit_(capacity),
         score_(score),
-        persistence_level_(persistence_level) {}
+        persistence_level_(persistence_level),
+        max_bandwidth_(0),
+        numa_node_(-1) {}
 };
 
 /**
@@ -125,6 +195,30 @@ struct StorageConfig {
   StorageConfig() = default;
 };
 
+/**
+ * One QoS class: a token-bucket rate limit and a fair-queuing weight,
+ * assigned to tags whose names match one of its patterns
+ */
+struct QosClassConfig {
+  std::string name_;
+  chi::u32 weight_;      // Share of a busy target relative to other classes
+  chi::u64 rate_;        // Bytes per second (0 = unlimited)
+  chi::u64 burst_;       // Token bucket depth in bytes
+  std::vector<std::string> tag_patterns_;  // Regexes over tag names
+
+  QosClassConfig() : weight_(1), rate_(0), burst_(16ULL * 1024ULL * 1024ULL) {}
+};
+
+/**
+ * I/O QoS configuration. Class IDs are the index in classes_ plus one; ID 0
+ * is the default class for unmatched tags and internal I/O.
+ */
+struct QosConfig {
+  std::vector<QosClassConfig> classes_;
+
+  QosConfig() = default;
+};
+
 /**
  * Data Placement Engine configuration
  */
@@ -162,6 +256,11 @@ class Config {
    */
   DpeConfig dpe_;
 
+  /**
+   * I/O QoS classes
+   */
+  QosConfig qos_;
+
   /**
    * Default constructor
    */
@@ -272,6 +371,13 @@ class Config {
    */
   bool ParseDpeConfig(const YAML::Node &node);
 
+  /**
+   * Parse QoS configuration from YAML
+   * @param node YAML node containing QoS config
+   * @return true if successful, false otherwise
+   */
+  bool ParseQosConfig(const YAML::Node &node);
+
   /**
    * Parse size string to bytes (e.g., "1GB", "512MB", "2TB")
    * @param size_str Size string to parse
@@ -49,7 +49,8 @@ namespace wrp_cte::core {
 enum class DpeType : chi::u32 {
   kRandom = 0,    // Random placement
   kRoundRobin = 1, // Round-robin placement
-  kMaxBW = 2      // Max bandwidth placement
+  kMaxBW = 2,     // Max bandwidth placement
+  kMinCompletion = 3  // Earliest predicted completion placement
 };
 
 /**
@@ -80,6 +81,15 @@ public:
                                                float blob_score, 
                                                chi::u64 data_size) = 0;
   
+  /**
+   * Bytes to place on each target of the last SelectTargets result, in the
+   * same order (0: nothing planned). Empty means fill the targets in order.
+   */
+  virtual const std::vector<chi::u64>& GetPlacementSizes() const {
+    static const std::vector<chi::u64> kNoPlan;
+    return kNoPlan;
+  }
+
   /**
    * Get the DPE type
    */
@@ -121,7 +131,10 @@ private:
 };
 
 /**
- * Max Bandwidth Data Placement Engine
+ * Max Bandwidth Data Placement Engine. Ranks targets by write bandwidth, or
+ * by latency below kLatencyThreshold. When every candidate's bdev has
+ * fitted curves, targets are ranked by the predicted time of the blob's
+ * size instead.
  */
 class MaxBwDpe : public DataPlacementEngine {
 public:
@@ -137,6 +150,62 @@ private:
   static constexpr chi::u64 kLatencyThreshold = 32 * 1024; // 32KB threshold
 };
 
+/**
+ * Earliest-completion Data Placement Engine. Predicts when each target
+ * would finish a write of the data from its measured write latency and
+ * bandwidth and the bytes already queued on it:
+ *   finish = latency + (inflight + size) / bandwidth
+ * or, once the bdev has fitted a write curve, that curve's time for
+ * inflight + size bytes. Targets are ranked by that time, preferred tier (score <= blob score)
+ * first. Blobs of at least kStripeMinSize are split over the preferred
+ * targets so they all finish at about the same time, when that beats the
+ * best single target; GetPlacementSizes then holds the split.
+ */
+class MinCompletionDpe : public DataPlacementEngine {
+public:
+  MinCompletionDpe();
+
+  std::vector<TargetInfo> SelectTargets(const std::vector<TargetInfo>& targets,
+                                       float blob_score,
+                                       chi::u64 data_size) override;
+
+  const std::vector<chi::u64>& GetPlacementSizes() const override {
+    return sizes_;
+  }
+
+  DpeType GetType() const override { return DpeType::kMinCompletion; }
+
+  /**
+   * Predict when a target would finish writing bytes after its queue, from
+   * the bdev's fitted write curve or else its reported metrics
+   * @param target Target with perf_model_, perf_metrics_ and inflight_bytes_
+   * @param bytes Bytes to write
+   * @return Predicted completion time in microseconds from now
+   */
+  static double PredictFinishUs(const TargetInfo& target, chi::u64 bytes);
+
+private:
+  static constexpr chi::u64 kStripeMinSize = 4ULL * 1024 * 1024;
+  static constexpr chi::u64 kStripeUnit = 1024 * 1024;
+  /** Bandwidth assumed for targets that report none (MB/s) */
+  static constexpr double kMinBandwidthMbps = 1.0;
+
+  /**
+   * Split data_size over targets so they finish together, in kStripeUnit
+   * multiples and within each target's remaining space
+   * @param targets Candidate targets
+   * @param data_size Bytes to place
+   * @param shares Output: bytes per target, same order as targets
+   * @return Predicted completion time of the split, or a negative value if
+   *         the targets cannot hold the data
+   */
+  static double PlanStripes(const std::vector<TargetInfo>& targets,
+                            chi::u64 data_size,
+                            std::vector<chi::u64>& shares);
+
+  std::vector<chi::u64> sizes_;
+};
+
 /**
  * Data Placement Engine Factory
  */
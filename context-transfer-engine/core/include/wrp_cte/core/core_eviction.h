@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef WRPCTE_CORE_EVICTION_H_
+#define WRPCTE_CORE_EVICTION_H_
+
+#include <chimaera/chimaera.h>
+#include <wrp_cte/core/blob_index.h>
+#include <wrp_cte/core/core_tasks.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace wrp_cte::core {
+
+/**
+ * Eviction policy types
+ */
+enum class EvictionPolicyType : chi::u32 {
+  kLru = 0,  // Least recently accessed first
+  kLfu = 1,  // Least frequently read first, with aging
+  kArc = 2   // Adaptive replacement (recency vs. frequency, scan-resistant)
+};
+
+/**
+ * Convert eviction policy string to enum
+ */
+EvictionPolicyType StringToEvictionPolicyType(const std::string& policy_str);
+
+/**
+ * Convert eviction policy enum to string
+ */
+std::string EvictionPolicyTypeToString(EvictionPolicyType policy_type);
+
+/**
+ * One blob as seen by an eviction pass
+ */
+struct EvictionCandidate {
+  BlobKey key_;
+  chi::u64 size_ = 0;         // Bytes of the blob on the fast tiers
+  Timestamp last_access_ = 0;  // Latest of last_read_ and last_modified_
+  chi::u64 reads_ = 0;        // Reads since the previous pass
+  bool resident_ = false;     // Holds bytes on a fast tier
+};
+
+/**
+ * Abstract eviction policy interface. A policy sees every blob of the
+ * container once per pass, then ranks the blobs of a target that is over
+ * its high watermark. Policies keep their state between passes.
+ */
+class EvictionPolicy {
+public:
+  virtual ~EvictionPolicy() = default;
+
+  /**
+   * Fold one pass worth of accesses into the policy state
+   * @param blobs Every blob of the container (blobs missing are forgotten)
+   * @param cache_bytes Capacity of the fast tiers
+   */
+  virtual void Update(const std::vector<EvictionCandidate>& blobs,
+                      chi::u64 cache_bytes) = 0;
+
+  /**
+   * Order candidates so that the first one is evicted first
+   * @param candidates Blobs on the target under pressure
+   */
+  virtual void RankVictims(std::vector<EvictionCandidate>& candidates) = 0;
+
+  /**
+   * Note that a blob left the fast tiers
+   * @param key Evicted blob
+   */
+  virtual void OnEvict(const BlobKey& key) { (void)key; }
+
+  /**
+   * Get the policy type
+   */
+  virtual EvictionPolicyType GetType() const = 0;
+};
+
+/**
+ * LRU eviction policy: the blob accessed longest ago goes first
+ */
+class LruEvictionPolicy : public EvictionPolicy {
+public:
+  void Update(const std::vector<EvictionCandidate>& blobs,
+              chi::u64 cache_bytes) override;
+
+  void RankVictims(std::vector<EvictionCandidate>& candidates) override;
+
+  EvictionPolicyType GetType() const override {
+    return EvictionPolicyType::kLru;
+  }
+};
+
+/**
+ * LFU eviction policy. Each blob's read count halves every pass, so blobs
+ * that were hot long ago do not stay resident forever. Ties go to LRU.
+ */
+class LfuEvictionPolicy : public EvictionPolicy {
+public:
+  void Update(const std::vector<EvictionCandidate>& blobs,
+              chi::u64 cache_bytes) override;
+
+  void RankVictims(std::vector<EvictionCandidate>& candidates) override;
+
+  EvictionPolicyType GetType() const override {
+    return EvictionPolicyType::kLfu;
+  }
+
+private:
+  std::unordered_map<BlobKey, double, BlobKeyHash> frequency_;
+};
+
+/**
+ * Adaptive Replacement Cache policy, driven by passes instead of single
+ * accesses. Resident blobs are on T1 (seen once) or T2 (read again since
+ * they arrived). Evicted blobs leave a ghost entry on B1 or B2. A read of a
+ * B1 ghost grows p_, the byte share of the fast tiers given to T1; a read
+ * of a B2 ghost shrinks it. The ghost then moves to T2 if the blob is back
+ * on a fast tier, or is dropped. Victims come from T1 while it holds more than
+ * p_ bytes, otherwise from T2, oldest first. A scan reads each blob once,
+ * so it only churns T1 and leaves the T2 working set resident.
+ */
+class ArcEvictionPolicy : public EvictionPolicy {
+public:
+  void Update(const std::vector<EvictionCandidate>& blobs,
+              chi::u64 cache_bytes) override;
+
+  void RankVictims(std::vector<EvictionCandidate>& candidates) override;
+
+  void OnEvict(const BlobKey& key) override;
+
+  EvictionPolicyType GetType() const override {
+    return EvictionPolicyType::kArc;
+  }
+
+  /** Current byte target of the T1 list (for tests) */
+  double GetRecencyTarget() const { return p_; }
+
+private:
+  enum class List : chi::u32 { kT1, kT2, kB1, kB2 };
+
+  struct Entry {
+    List list_ = List::kT1;
+    chi::u64 size_ = 0;
+    Timestamp last_access_ = 0;
+    chi::u64 pass_ = 0;  // Last pass that saw the blob (stale = deleted)
+  };
+
+  std::unordered_map<BlobKey, Entry, BlobKeyHash> entries_;
+  chi::u64 pass_ = 0;
+  chi::u64 cache_bytes_ = 0;
+  double p_ = 0.0;
+  chi::u64 list_bytes_[4] = {0, 0, 0, 0};
+
+  /** Bytes currently on a list */
+  chi::u64& Bytes(List list) { return list_bytes_[static_cast<size_t>(list)]; }
+
+  /** Recount list_bytes_ and drop the oldest ghosts beyond cache_bytes_ */
+  void TrimGhosts();
+};
+
+/**
+ * Eviction Policy Factory
+ */
+class EvictionPolicyFactory {
+public:
+  /**
+   * Create an eviction policy instance
+   * @param policy_type Type of policy to create
+   * @return Unique pointer to policy instance
+   */
+  static std::unique_ptr<EvictionPolicy> CreatePolicy(
+      EvictionPolicyType policy_type);
+
+  /**
+   * Create an eviction policy instance from string
+   * @param policy_str Policy type as string
+   * @return Unique pointer to policy instance
+   */
+  static std::unique_ptr<EvictionPolicy> CreatePolicy(
+      const std::string& policy_str);
+};
+
+} // namespace wrp_cte::core
+
+#endif // WRPCTE_CORE_EVICTION_H_
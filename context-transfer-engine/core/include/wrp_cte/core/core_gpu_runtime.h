@@ -64,6 +64,7 @@ struct GetTagSizeTask;
 struct DelTagTask;
 struct GetContainedBlobsTask;
 struct PutBlobTask;
+struct PutBlobBatchTask;
 struct GetBlobTask;
 struct ReorganizeBlobTask;
 struct DelBlobTask;
@@ -177,6 +178,24 @@ class GpuRuntime : public chi::gpu::Container {
   HSHM_GPU_FUN void PutBlob(hipc::FullPtr<PutBlobTask> task,
                               chi::gpu::RunContext &rctx);
 
+  /**
+   * GPU handler for PutBlobBatch.
+   * Stores each entry in turn, as PutBlob would.
+   * @param task PutBlobBatch task filled by a warp.
+   * @param rctx GPU run context.
+   */
+  HSHM_GPU_FUN void PutBlobBatch(hipc::FullPtr<PutBlobBatchTask> task,
+                                  chi::gpu::RunContext &rctx);
+
+  /**
+   * Store one blob in GPU metadata and a bdev target.
+   * Shared by PutBlob and PutBlobBatch.
+   * @return 0 on success, otherwise the PutBlob error code.
+   */
+  HSHM_GPU_FUN chi::u32 StoreBlob(const TagId &tag_id, const char *blob_name,
+                                  int blob_name_len, chi::u64 size,
+                                  float blob_score, hipc::ShmPtr<> blob_data);
+
   /**
    * GPU handler for GetBlob.
    * Converts blob_data_ ShmPtr to a GPU-accessible FullPtr via
@@ -34,16 +34,40 @@
 #ifndef WRPCTE_CORE_RUNTIME_H_
 #define WRPCTE_CORE_RUNTIME_H_
 
+#include <array>
 #include <atomic>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <chimaera/chimaera.h>
+#include <chimaera/coevent.h>
 #include <chimaera/comutex.h>
 #include <chimaera/corwlock.h>
+#include <chimaera/expiry_wheel.h>
+#include <hermes_shm/encrypt/encrypt.h>
 #include <hermes_shm/data_structures/priv/unordered_map_ll.h>
 #include <hermes_shm/data_structures/ipc/ring_buffer.h>
 #include <hermes_shm/memory/allocator/malloc_allocator.h>
+#include <wrp_cte/core/blob_index.h>
+#include <wrp_cte/core/blob_meta_table.h>
 #include <wrp_cte/core/core_client.h>
 #include <wrp_cte/core/core_config.h>
 #include <wrp_cte/core/core_tasks.h>
+#include <wrp_cte/core/core_eviction.h>
+#include <wrp_cte/core/erasure_code.h>
+#include <wrp_cte/core/hash_ring.h>
+#include <wrp_cte/core/metadata_checkpoint.h>
+#include <wrp_cte/core/metadata_lease.h>
+#include <wrp_cte/core/name_pattern.h>
+#include <wrp_cte/core/pack_segments.h>
+#include <wrp_cte/core/qos_scheduler.h>
+#include <wrp_cte/core/read_cache.h>
+#include <wrp_cte/core/telemetry_log.h>
 #include <wrp_cte/core/transaction_log.h>
 
 // Forward declarations to avoid circular dependency
@@ -63,7 +87,7 @@ public:
   using CreateParams = wrp_cte::core::CreateParams; // Required for CHI_TASK_CC
 
   Runtime() = default;
-  ~Runtime() override = default;
+  ~Runtime() override;
 
   /**
    * Create the container (Method::kCreate)
@@ -118,12 +142,34 @@ public:
   chi::TaskResume GetOrCreateTag(hipc::FullPtr<GetOrCreateTagTask<CreateParamsT>> task,
                       chi::RunContext &ctx);
 
+  /**
+   * Get or create many tags in one task (Method::kGetOrCreateTags)
+   */
+  chi::TaskResume GetOrCreateTags(hipc::FullPtr<GetOrCreateTagsTask> task,
+                                  chi::RunContext &ctx);
+
   /**
    * Put blob (Method::kPutBlob) - allocates and writes data to blob
    * Returns TaskResume for coroutine-based async operations
    */
   chi::TaskResume PutBlob(hipc::FullPtr<PutBlobTask> task, chi::RunContext &ctx);
 
+  /**
+   * Put blob batch (Method::kPutBlobBatch) - writes every entry of the batch
+   * via PutBlob, a bounded window at a time
+   * Returns TaskResume for coroutine-based async operations
+   */
+  chi::TaskResume PutBlobBatch(hipc::FullPtr<PutBlobBatchTask> task,
+                               chi::RunContext &ctx);
+
+  /**
+   * Append blob (Method::kAppendBlob) - reserves the next bytes of a tag at
+   * its append cursor and writes them as chunk blobs via PutBlob
+   * Returns TaskResume for coroutine-based async operations
+   */
+  chi::TaskResume AppendBlob(hipc::FullPtr<AppendBlobTask> task,
+                             chi::RunContext &ctx);
+
   /**
    * Get blob (Method::kGetBlob) - reads data from existing blob
    * Returns TaskResume for coroutine-based async operations
@@ -168,6 +214,20 @@ public:
                       chi::RunContext &rctx) override;
   chi::u64 GetWorkRemaining() const override;
 
+  /**
+   * Copy this container's tags and blobs to a migration destination while
+   * it keeps serving. The first round copies everything; later rounds copy
+   * what changed since the previous one. The final round, run while
+   * plugged, also drops the local copies that reached the destination.
+   * @param dest_node_id Node the container migrates to
+   * @param final_round true for the last round
+   * @param remaining Output: entries changed during this round
+   * @param rctx Run context of the calling admin task
+   */
+  chi::TaskResume MigratePrecopy(chi::u32 dest_node_id, bool final_round,
+                                 chi::u64 &remaining,
+                                 chi::RunContext &rctx) override;
+
   // Container virtual method implementations (defined in autogen/core_lib_exec.cc)
   void SaveTask(chi::u32 method, chi::SaveTaskArchive &archive,
                 hipc::FullPtr<chi::Task> task_ptr) override;
@@ -208,29 +268,25 @@ private:
   hshm::priv::unordered_map_ll<std::string, TagId>
       tag_name_to_id_;                                   // tag_name -> tag_id
   hshm::priv::unordered_map_ll<TagId, TagInfo> tag_id_to_info_; // tag_id -> TagInfo
-  hshm::priv::unordered_map_ll<std::string, BlobInfo>
-      tag_blob_name_to_info_; // "tag_id.blob_name" -> BlobInfo
+  BlobMetadataIndex
+      tag_blob_name_to_info_; // "tag_id.blob_name" -> BlobInfo (sharded)
+  hshm::priv::unordered_map_ll<TagId, chi::u64>
+      append_cursors_; // tag_id -> next append offset (on the owning container)
 
   // Atomic counters for thread-safe ID generation
   std::atomic<chi::u32>
       next_tag_id_minor_; // Minor counter for TagId UniqueId generation
 
   // Map sizes for data structures (must be large enough for expected entries)
-  static const size_t kBlobMapSize = 1000000;  // 1M blobs
+  static const size_t kBlobMapSize = 1000000;  // 1M blobs (all shards)
+  static const size_t kBlobMapShards = 64;     // Independent blob map shards
   static const size_t kTagMapSize = 100000;    // 100K tags
 
   // Synchronization primitives for thread-safe access to data structures
   // Single lock per data structure ensures all operations synchronize correctly
+  // (tag_blob_name_to_info_ carries its own per-shard locks)
   chi::CoRwLock target_lock_;  // For registered_targets_ + target_name_to_id_
   chi::CoRwLock tag_map_lock_;  // For tag_name_to_id_ + tag_id_to_info_
-  chi::CoRwLock blob_map_lock_;  // For tag_blob_name_to_info_
-  // Use a set of locks based on maximum number of lanes for better concurrency
-  static const size_t kMaxLocks =
-      64; // Maximum number of locks (matches max lanes)
-  std::vector<std::unique_ptr<chi::CoRwLock>>
-      target_locks_; // For registered_targets_ (DEPRECATED - use target_lock_)
-  std::vector<std::unique_ptr<chi::CoRwLock>>
-      tag_locks_; // For tag management structures (DEPRECATED - use tag_map_lock_ / blob_map_lock_)
 
   // Storage configuration (parsed from config file)
   std::vector<StorageDeviceConfig> storage_devices_;
@@ -241,16 +297,300 @@ private:
   // Restart flag: set by Restart() before calling Init()/Create()
   bool is_restart_ = false;
 
-  // Telemetry ring buffer for performance monitoring
-  static inline constexpr size_t kTelemetryRingSize = 1024; // Ring buffer size
-  std::unique_ptr<hipc::circular_mpsc_ring_buffer<CteTelemetry, hipc::MallocAllocator>> telemetry_log_;
-  std::atomic<std::uint64_t>
-      telemetry_counter_; // Atomic counter for logical time
+  // Per-worker telemetry rings for performance monitoring
+  static inline constexpr size_t kTelemetryPollMax = 1000;  // Entries per poll
+  TelemetryLog telemetry_log_;
+
+  // Node-wide lease table revoking client-side metadata caches
+  MetadataLeaseTable *leases_ = nullptr;
+
+  // Node-wide blob size/score copies read by local clients without a task
+  BlobMetaTable *blob_meta_ = nullptr;
+
+  /** Decayed access heat of one blob, kept between MigrateBlobs passes */
+  struct BlobHeat {
+    double heat_ = 1.0;      // Decayed read count
+    Timestamp last_read_ = 0;  // Blob last_read_ seen by the previous pass
+    chi::u64 pass_ = 0;      // Last pass that saw the blob (stale = deleted)
+  };
+
+  // Tier migration state (only touched by the MigrateBlobs task)
+  static inline constexpr double kMigrateMaxCreditMs = 4000.0;
+
+  // Poll interval while a stub's source range is read (microseconds)
+  static inline constexpr double kStubIoPollUs = 10.0;
+  std::unordered_map<BlobKey, BlobHeat, BlobKeyHash> blob_heat_;
+  std::uint64_t heat_logical_time_ = 0;  // Last telemetry entry consumed
+  chi::u64 migrate_pass_ = 0;
+  Timestamp migrate_last_pass_ = 0;
+  double migrate_credit_bytes_ = 0;  // Unused migration bandwidth budget
+
+  // Capacity-pressure eviction state (only touched by the EvictTargets task)
+  std::unique_ptr<EvictionPolicy> evict_policy_;
+  std::unordered_map<BlobKey, Timestamp, BlobKeyHash> evict_last_read_;
+  std::uint64_t evict_logical_time_ = 0;  // Last telemetry entry consumed
+  std::atomic<chi::u64> evict_blobs_{0};
+  std::atomic<chi::u64> evict_bytes_{0};
+
+  // TTL expiry: lifetimes set by SetTagTtl, and a timer wheel of the
+  // deadlines PutBlob stamped on blobs. Deadlines are in memory only, so
+  // blobs restored from the metadata log do not expire.
+  static inline constexpr chi::u64 kExpiryTickNs = 100ULL * 1000 * 1000;
+  static inline constexpr size_t kExpirySlots = 4096;
+  chi::CoRwLock ttl_lock_;
+  std::unordered_map<TagId, chi::u64> tag_ttl_;
+  hshm::Mutex expiry_lock_;
+  chi::ExpiryWheel<BlobKey> expiry_wheel_{kExpiryTickNs, kExpirySlots};
+  std::atomic<chi::u64> expired_blobs_{0};
+  std::atomic<chi::u64> expired_bytes_{0};
+
+  // Reservations: zeros written per bdev call when ReserveBlob grows a blob
+  static inline constexpr chi::u64 kReserveZeroChunk = 1ULL << 20;
+  std::atomic<chi::u64> reserved_bytes_{0};
+
+  // GetOrCreateTag lookups a GetOrCreateTags task keeps in flight
+  static inline constexpr size_t kTagBatchInflight = 256;
+
+  /** Per-target I/O counters, readable from the metrics thread */
+  struct TargetMetricSlot {
+    static constexpr size_t kNameSize = 128;
+    std::atomic<chi::u64> target_id_{0};  // Packed PoolId (0 = unclaimed)
+    char name_[kNameSize] = {};           // Written before target_id_
+    std::atomic<bool> live_{false};       // Cleared by UnregisterTarget
+    std::atomic<chi::u64> bytes_read_{0};
+    std::atomic<chi::u64> bytes_written_{0};
+    std::atomic<chi::u64> ops_read_{0};
+    std::atomic<chi::u64> ops_written_{0};
+    std::atomic<chi::u64> capacity_{0};
+    std::atomic<chi::u64> remaining_space_{0};
+    std::atomic<double> read_bw_mbps_{0};
+    std::atomic<double> write_bw_mbps_{0};
+  };
+
+  // Metric slots per target, claimed in RegisterTarget order
+  static inline constexpr size_t kMaxTargetMetrics = 64;
+  std::array<TargetMetricSlot, kMaxTargetMetrics> target_metrics_;
+  std::atomic<chi::u32> num_target_metrics_{0};
+  std::mutex target_metrics_lock_;  // Serializes ClaimTargetMetrics only
 
   // Write-Ahead Transaction Logs (per-worker)
   std::vector<std::unique_ptr<TransactionLog>> blob_txn_logs_;
   std::vector<std::unique_ptr<TransactionLog>> tag_txn_logs_;
 
+  // Incremental metadata checkpoints (base image + deltas, FlushMetadata)
+  DirtyMetadataSet dirty_metadata_;  // Entries changed since last checkpoint
+  chi::u64 next_delta_seq_ = 0;      // Sequence number of the next delta
+  bool checkpoint_base_written_ = false;  // Set by the first base image
+  // Base image a restart attached instead of loading: each tag's blobs are
+  // loaded from it when the tag is first touched (LoadDeferredTag)
+  std::unique_ptr<MappedFile> base_image_;
+  std::unordered_map<TagId, CheckpointTagIndex::Section> deferred_sections_;
+  std::unordered_set<chi::PoolId> deferred_volatile_targets_;
+  // Composite keys and tags the restart replayed past the base image; the
+  // first checkpoint writes them as a delta instead of a new base
+  std::vector<std::string> replayed_blob_keys_;
+  std::vector<TagId> replayed_tag_ids_;
+  std::atomic<bool> flush_running_{false};  // A FlushMetadata is writing
+  // A tag policy changed since the last checkpoint, which lists them all
+  std::atomic<bool> tag_policy_dirty_{false};
+  // Routing hash; a restart adopts the one its checkpoint was written with
+  BlobHashId blob_hash_id_ = BlobHashId::kHashBytes;
+
+  /** A blob waiting for write-back to the persistent tier */
+  struct DirtyBlob {
+    TagId tag_id_;
+    std::string blob_name_;
+    Timestamp dirty_since_ = 0;  // BlobInfo::dirty_since_ when queued
+                                 // (0 = untracked, recheck the blocks)
+  };
+
+  /** A dirty blob read into memory and waiting to be rewritten */
+  struct FlushItem {
+    DirtyBlob blob_;
+    hipc::FullPtr<char> buffer_;
+    chi::u64 size_ = 0;
+    float score_ = 0;
+    Timestamp last_modified_ = 0;  // Blob version that was read
+  };
+
+  // Write-back queue for FlushData, oldest dirty blob first
+  hshm::Mutex write_back_lock_;
+  std::deque<DirtyBlob> write_back_queue_;
+  bool write_back_seeded_ = false;  // Set once existing blobs were scanned
+
+  // Blob replication: factors are set on every container by
+  // SetTagReplication so routing and fan-out agree cluster-wide
+  chi::CoRwLock replication_lock_;
+  std::unordered_map<TagId, chi::u32> tag_replicas_;
+  std::atomic<chi::u32> replica_read_rr_{0};  // Spreads remote replica reads
+  std::vector<chi::u32> repair_node_map_;  // Container nodes at last repair
+  std::atomic<bool> replica_rescan_{false};  // A factor changed since then
+
+  // Consistent-hash placement; a null ring means modulo hashing as in
+  // ResolveDirectHashQuery. The previous placement is kept so that misses
+  // can be redirected to blobs that have not been moved yet.
+  static inline constexpr chi::u32 kDefaultPlacementVnodes = 64;
+  chi::CoRwLock placement_lock_;
+  std::shared_ptr<const HashRing> placement_ring_;
+  std::shared_ptr<const HashRing> previous_ring_;
+  bool placement_changed_ = false;  // previous_ring_ is meaningful
+  std::atomic<bool> rebalance_pending_{false};
+
+  /** Hash of a block extent, for block_refs_ */
+  struct BlobBlockHash {
+    size_t operator()(const BlobBlock &block) const {
+      return std::hash<chi::PoolId>{}(block.target_id_) ^
+             std::hash<chi::u64>{}(block.target_offset_ * 31 + block.size_);
+    }
+  };
+  // Blocks shared by blobs that SpliceBlobs linked or dedup writes matched,
+  // with the number of references to each. Blocks of unshared blobs are not
+  // listed. A shared blob is never written in place: a partial write copies
+  // it first.
+  hshm::Mutex block_refs_lock_;
+  std::unordered_map<BlobBlock, chi::u32, BlobBlockHash> block_refs_;
+  // Blocks of the blobs loaded at restart while other tags stayed deferred.
+  // Only these can share an extent with a deferred blob. Fixed after
+  // restart, so it is read without a lock.
+  std::unordered_set<BlobBlock, BlobBlockHash> restart_blocks_;
+
+  // Content dedup: chunk sizes set by SetTagDedup, and a fingerprint index
+  // over the chunks dedup writes stored in a single extent. The index is
+  // guarded by block_refs_lock_ so that a hit takes its reference before
+  // the extent can be freed. An entry goes when its extent is freed or
+  // written in place. The index is in memory only and starts empty.
+  static inline constexpr chi::u64 kDedupChunkUnit = 4096;
+  chi::CoRwLock dedup_lock_;
+  std::unordered_map<TagId, chi::u64> tag_dedup_;
+  std::unordered_map<chi::u64, BlobBlock> dedup_index_;
+  std::unordered_map<BlobBlock, chi::u64, BlobBlockHash> dedup_fingerprints_;
+  std::atomic<chi::u64> dedup_chunks_hit_{0};
+  std::atomic<chi::u64> dedup_bytes_saved_{0};
+
+  // Erasure coding: (data, parity) shard counts set by SetTagErasure. A
+  // blob keeps the counts it was encoded with, so changing them only
+  // affects later writes. RepairReplicas rebuilds shards whose target went
+  // away; erasure_rescan_ is set when that may have happened.
+  chi::CoRwLock erasure_lock_;
+  std::unordered_map<TagId, std::pair<chi::u32, chi::u32>> tag_erasure_;
+  std::vector<chi::u32> erasure_node_map_;  // Container nodes at last rebuild
+  std::atomic<bool> erasure_rescan_{false};
+  std::atomic<chi::u64> erasure_degraded_reads_{0};
+  std::atomic<chi::u64> erasure_shards_rebuilt_{0};
+
+  // At-rest encryption: plaintext chunk size set by SetTagEncryption. The
+  // key comes from encryption_key_path; without one no tag can be
+  // encrypted. A blob keeps the chunk size it was sealed with.
+  chi::CoRwLock encrypt_lock_;
+  std::unordered_map<TagId, chi::u32> tag_encrypt_;
+#if HSHM_ENABLE_ENCRYPT
+  hshm::AesGcm cipher_;
+#endif
+  std::atomic<chi::u64> encrypt_auth_failures_{0};
+
+  // PutBlob calls that overwrote existing blocks in place
+  std::atomic<chi::u64> put_in_place_{0};
+
+  // Small-object packing: a fresh PutBlob of at most small_object_max_size
+  // bytes is copied into the open segment of its worker on the target the
+  // DPE picked, instead of getting a bdev block of its own. A segment is
+  // written out in large sequential writes: when it fills, and whenever
+  // StatTargets or FlushData find appended bytes pending. Until it is
+  // sealed and written its bytes are also kept in memory, and reads of its
+  // objects are served from there. DefragBlobs copies the live objects out
+  // of sealed segments that fell below small_segment_clean_ratio, and a
+  // segment is freed as soon as no blob references it. Segments are
+  // recorded in every checkpoint and in tag log 0 as they are allocated and
+  // freed; a restart restores them sealed and recounts their live objects
+  // from the blobs (restored_pack_segments_ holds them until then, by
+  // target and base).
+  static inline constexpr double kPackFlushPollUs = 10.0;
+  hshm::Mutex pack_lock_;
+  PackSegmentTable pack_segments_;
+  std::unordered_map<chi::PoolId, std::map<chi::u64, chi::u64>>
+      restored_pack_segments_;
+  // Open segment per worker and target
+  std::vector<std::unordered_map<chi::PoolId, chi::u64>> pack_open_;
+  std::atomic<chi::u64> pack_objects_{0};
+  std::atomic<chi::u64> pack_flushes_{0};
+  std::atomic<chi::u64> pack_flushed_bytes_{0};
+  std::atomic<chi::u64> pack_buffer_reads_{0};
+  std::atomic<chi::u64> pack_objects_cleaned_{0};
+  std::atomic<chi::u64> pack_segments_freed_{0};
+
+  // Single-flight reads: a plain GetBlob whose range lies inside a read of
+  // the same blob already in flight parks on it rather than issuing the
+  // same bdev reads again. It only joins a read that began after the blob's
+  // last write. The leader copies into every joined reader's buffer and
+  // then wakes them.
+  struct ReadFlightJoiner {
+    hipc::ShmPtr<> data_;  // Joined reader's output buffer
+    chi::u64 offset_ = 0;
+    chi::u64 size_ = 0;
+    bool copied_ = false;  // Set by the leader before it wakes the reader
+  };
+  struct ReadFlight {
+    chi::u64 offset_;
+    chi::u64 size_;
+    chi::u64 version_;                         // Blob version_ at the start
+    hipc::ShmPtr<> data_;                      // Leader's output buffer
+    chi::u32 result_ = 0;                      // ReadData error code
+    std::vector<ReadFlightJoiner *> joiners_;  // Under read_flight_lock_
+    chi::CoEvent done_;
+  };
+  hshm::Mutex read_flight_lock_;
+  std::unordered_map<BlobKey, std::vector<std::shared_ptr<ReadFlight>>,
+                     BlobKeyHash>
+      read_flights_;
+  std::atomic<chi::u64> reads_coalesced_{0};
+  std::atomic<chi::u64> bytes_coalesced_{0};
+
+  // DRAM read cache: whole copies of hot blobs that live on slower targets,
+  // kept in a RAM bdev of this container that is not a target. An entry is
+  // only used while its version matches the blob's version_. readers_
+  // counts hit reads in flight; whoever removes an entry waits for them to
+  // finish before freeing its blocks.
+  struct ReadCacheCopy {
+    std::vector<chimaera::bdev::Block> blocks_;
+    chi::u64 version_;
+    std::atomic<chi::u32> readers_{0};
+  };
+  using ReadCache =
+      TinyLfuCache<BlobKey, std::shared_ptr<ReadCacheCopy>, BlobKeyHash>;
+  static inline constexpr double kReadCachePollUs = 10.0;
+  hshm::Mutex read_cache_lock_;
+  std::unique_ptr<ReadCache> read_cache_;
+  chi::PoolId read_cache_id_;  // RAM bdev holding the cached bytes
+  std::atomic<chi::u64> read_cache_hits_{0};
+  std::atomic<chi::u64> read_cache_misses_{0};
+  std::atomic<chi::u64> read_cache_fills_{0};
+
+  // Blob views: blocks pinned for local clients that map RAM targets. Each
+  // pin counts in block_refs_ like a linked blob, so a pinned block is
+  // neither freed nor written in place until its lease is released or
+  // runs out.
+  struct BlobViewLease {
+    std::vector<BlobBlock> blocks_;  // Pinned blocks
+    Timestamp deadline_;             // When StatTargets drops the pins
+  };
+  static inline constexpr chi::u64 kBlobViewLeaseMs = 30000;
+  hshm::Mutex view_lease_lock_;
+  std::unordered_map<chi::u64, BlobViewLease> view_leases_;
+  std::atomic<chi::u64> next_view_lease_{1};
+  std::atomic<chi::u64> views_served_{0};
+
+  // Live container migration: entries changed since the last pre-copy
+  // round, tracked whether or not a metadata log is configured
+  DirtyMetadataSet migration_dirty_;
+  std::atomic<bool> migration_active_{false};
+  chi::u32 migration_dest_ = 0;  // Node the active migration copies to
+  // Per-tag placement policies, broadcast by each tag's canonical container
+  std::unordered_map<TagId, TagPlacement> tag_placement_;
+
+  // Admission control for bdev submissions, configured from the qos
+  // section and the storage devices' max_bandwidth
+  QosScheduler qos_;
+
   /**
    * Get access to configuration manager
    */
@@ -271,42 +611,56 @@ private:
       const std::string &target_name);
 
   /**
-   * Helper function to get or assign a tag ID
+   * Get the NUMA node of a target's device: the storage device config's
+   * numa_node, else the node of the block device holding its path
+   * @param target_name Name of the target to look up
+   * @return NUMA node, or -1 if unknown (e.g. RAM targets)
    */
-  TagId GetOrAssignTagId(const std::string &tag_name,
-                         const TagId &preferred_id = TagId::GetNull());
+  int GetNumaNodeForTarget(const std::string &target_name);
 
   /**
-   * Helper function to generate a new TagId using node_id as major and atomic
-   * counter as minor
+   * Move the targets on this shard's NUMA node ahead of the other targets
+   * of the same tier, keeping the DPE's order otherwise. A no-op unless the
+   * pool runs one container per NUMA node.
+   * @param targets Targets in DPE order
+   * @param planned_sizes Bytes planned per target, permuted alongside
+   *        (may be nullptr)
    */
-  TagId GenerateNewTagId();
+  void PreferLocalTargets(std::vector<TargetInfo> &targets,
+                          std::vector<chi::u64> *planned_sizes) const;
 
   /**
-   * Get target lock index based on TargetId hash
+   * Query that routes a task to this container itself. Local() would pick
+   * the node's first container, which is another shard of a sharded pool.
+   * @return DirectId query for container_id_
    */
-  size_t GetTargetLockIndex(const chi::PoolId &target_id) const;
+  chi::PoolQuery SelfQuery() const {
+    return chi::PoolQuery::DirectId(container_id_);
+  }
 
   /**
-   * Get tag lock index based on tag name hash
+   * Helper function to get or assign a tag ID
    */
-  size_t GetTagLockIndex(const std::string &tag_name) const;
+  TagId GetOrAssignTagId(const std::string &tag_name,
+                         const TagId &preferred_id = TagId::GetNull());
 
   /**
-   * Get tag lock index based on tag ID hash
+   * Helper function to generate a new TagId using node_id as major and atomic
+   * counter as minor
    */
-  size_t GetTagLockIndex(const TagId &tag_id) const;
+  TagId GenerateNewTagId();
 
   /**
    * Allocate space from a target for new blob data
    * @param target_info Target to allocate from
    * @param size Size to allocate
-   * @param allocated_offset Output parameter for allocated offset
+   * @param allocated_blocks Output: target blocks covering exactly size bytes
    * @param success Output parameter: true if allocation succeeded, false otherwise
    * Returns TaskResume for coroutine-based async operations
    */
-  chi::TaskResume AllocateFromTarget(TargetInfo &target_info, chi::u64 size,
-                                     chi::u64 &allocated_offset, bool &success);
+  chi::TaskResume AllocateFromTarget(
+      TargetInfo &target_info, chi::u64 size,
+      std::vector<chimaera::bdev::Block> &allocated_blocks, bool &success);
 
   /**
    * Free all blocks from a blob back to their respective targets
@@ -316,6 +670,20 @@ private:
    */
   chi::TaskResume FreeAllBlobBlocks(BlobInfo &blob_info, chi::u32 &error_code);
 
+  /**
+   * Delete a local blob: release its blocks, drop it from the tag size and
+   * the blob map, log the delete, and remove the other replicas
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob name
+   * @param blob_info The blob's entry in the blob map
+   * @param freed If not null, the blocks are moved here for the caller to
+   *        free in one batch instead of being freed now
+   * @param blob_size Output: logical size of the deleted blob
+   */
+  chi::TaskResume RemoveBlob(const TagId &tag_id, const std::string &blob_name,
+                             BlobInfo &blob_info, BlobInfo *freed,
+                             chi::u64 &blob_size);
+
   /**
    * Check if blob exists and return pointer to BlobInfo if found
    * @param blob_name Blob name to search for (required)
@@ -334,6 +702,54 @@ private:
   BlobInfo *CreateNewBlob(const std::string &blob_name, const TagId &tag_id,
                           float blob_score);
 
+  /**
+   * Copy a stub's source range into target blocks and turn it into a
+   * regular blob. The stub is left in place if any step fails.
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob to fault in
+   * @param blob_info Stub metadata
+   * @param error_code Output: 0 on success, 1 alloc, 2 read, 3 extend,
+   *                   4 write
+   */
+  chi::TaskResume MaterializeStub(const TagId &tag_id,
+                                  const std::string &blob_name,
+                                  BlobInfo &blob_info, chi::u32 &error_code);
+
+  /**
+   * Read a byte range of a stub's source file without blocking the worker
+   * @param path Source file
+   * @param offset Byte offset in the file
+   * @param data Destination buffer of at least size bytes
+   * @param size Bytes to read
+   * @param error_code Output: 0 on success, 1 on open or short read
+   */
+  chi::TaskResume ReadStubSource(const std::string &path, chi::u64 offset,
+                                 char *data, chi::u64 size,
+                                 chi::u32 &error_code);
+
+  /** Drop a blob's source range so reads go to its blocks */
+  static void ClearBlobStub(BlobInfo &blob_info);
+
+  /**
+   * Whether a write can go straight into the blob's current blocks, with
+   * no allocation and no WAL record: the blocks hold plain bytes (not a
+   * stub, erasure-code shards or sealed chunks), cover the range (a write
+   * at offset 0 must keep the size unless the blob holds a reservation,
+   * which such a write fills like any other chunk), are not shared,
+   * already meet the persistence level, and a replacement would not
+   * re-place, re-encode or re-chunk the blob
+   * @param tag_id Tag containing the blob
+   * @param blob_info Existing blob
+   * @param offset Write offset
+   * @param size Write size
+   * @param blob_score Score of the incoming put
+   * @param min_persistence_level Persistence level the write asks for
+   * @return true if the write may overwrite the blocks in place
+   */
+  bool CanWriteInPlace(const TagId &tag_id, const BlobInfo &blob_info,
+                       chi::u64 offset, chi::u64 size, float blob_score,
+                       int min_persistence_level);
+
   /**
    * Clear all blocks from a blob if this is a full replacement.
    * Conditions: score in [0,1], offset == 0, size >= current blob size.
@@ -356,10 +772,258 @@ private:
    * @param blob_score Score for target selection
    * @param error_code Output: 0 for success, non-zero for failure
    * @param min_persistence_level Minimum persistence level for target filtering
+   * @param exclude_targets Targets to avoid while any other target qualifies
+   *        (erasure-code shards of one blob go to distinct targets)
+   */
+  chi::TaskResume ExtendBlob(
+      BlobInfo &blob_info, chi::u64 offset, chi::u64 size, float blob_score,
+      chi::u32 &error_code, int min_persistence_level = 0,
+      const std::unordered_set<chi::PoolId> *exclude_targets = nullptr);
+
+  /**
+   * Copy one blob into a fresh allocation and free its old blocks. The swap
+   * is skipped if the blob is written while the copy is in flight or the new
+   * allocation is not less fragmented than the old one.
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob to rewrite
+   * @param min_blocks Only rewrite if the blob has at least this many blocks
+   * @param bytes_moved Output: bytes rewritten (0 if the blob was left as is)
+   */
+  chi::TaskResume DefragBlob(const TagId &tag_id, const std::string &blob_name,
+                             size_t min_blocks, chi::u64 &bytes_moved);
+
+  /**
+   * Copy one blob into a fresh allocation at a given score and free its old
+   * blocks. The swap is skipped if accept rejects the new layout or the blob
+   * is written while the copy is in flight.
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob to rewrite
+   * @param score Score used to place the copy (becomes the blob's score)
+   * @param min_persistence_level Minimum persistence level of the copy
+   * @param accept Called with (old, new) layouts; false keeps the old one
+   * @param bytes_moved Output: bytes rewritten (0 if the blob was left as is)
+   * @param exclude_targets Targets the copy avoids while others have room
+   */
+  chi::TaskResume RelocateBlob(
+      const TagId &tag_id, const std::string &blob_name, float score,
+      int min_persistence_level,
+      const std::function<bool(const BlobInfo &, const BlobInfo &)> &accept,
+      chi::u64 &bytes_moved,
+      const std::unordered_set<chi::PoolId> *exclude_targets = nullptr);
+
+  /**
+   * Check whether a layout lives entirely in device-addressable targets
+   * (hbm, or gds which DMAs to and from device memory)
+   * @param layout Blob layout to check
+   * @return true if every block is on an hbm or gds target
+   */
+  bool IsDeviceLayout(const BlobInfo &layout);
+
+  /**
+   * Check whether a layout lives entirely in DRAM-speed targets
+   * (ram, hbm or pinned), which the read cache does not front
+   * @param layout Blob layout to check
+   * @return true if every block is on a ram, hbm or pinned target
+   */
+  bool IsDramLayout(const BlobInfo &layout);
+
+  /**
+   * Serve a GetBlob range from the read cache
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob name
+   * @param blob_info Blob being read
+   * @param data Output buffer to read data into
+   * @param data_size Size of data to read
+   * @param data_offset_in_blob Offset within blob where reading starts
+   * @param hit Output: true if the range was read from the cache
+   */
+  chi::TaskResume ReadFromCache(const TagId &tag_id,
+                                const std::string &blob_name,
+                                const BlobInfo &blob_info, hipc::ShmPtr<> data,
+                                size_t data_size, size_t data_offset_in_blob,
+                                bool &hit);
+
+  /**
+   * Copy a blob just read in full into the read cache, if TinyLFU admits it
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob name
+   * @param version The blob's version_ before the read
+   * @param data Buffer holding the whole blob
+   * @param size Blob size in bytes
+   */
+  chi::TaskResume FillReadCache(const TagId &tag_id,
+                                const std::string &blob_name,
+                                chi::u64 version, hipc::ShmPtr<> data,
+                                chi::u64 size);
+
+  /**
+   * Drop a blob's read cache entry, if any
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob name
+   */
+  chi::TaskResume InvalidateReadCache(const TagId &tag_id,
+                                      const std::string &blob_name);
+
+  /**
+   * Free the cache blocks of removed entries once no hit reads them
+   * @param copies Entries already removed from the read cache
+   */
+  chi::TaskResume FreeReadCacheCopies(
+      std::vector<std::shared_ptr<ReadCacheCopy>> copies);
+
+  /**
+   * Fold reads since the previous MigrateBlobs pass into every blob's heat.
+   * Reads come from blob last_read_ times, weighted by the GetBlob count of
+   * the blob's tag in the telemetry log.
+   * @param decay Factor applied to the heat carried over from the last pass
+   */
+  void UpdateBlobHeat(double decay);
+
+  /**
+   * Count GetBlob calls per tag in the telemetry log. Each sampled entry
+   * stands for sample_rate calls.
+   * @param logical_time In: last entry already counted; out: newest entry
+   * @return Reads per tag since logical_time
+   */
+  std::unordered_map<TagId, chi::u64> CountTagReads(
+      std::uint64_t &logical_time);
+
+  /**
+   * Byte-weighted mean score of the targets holding a layout
+   * @param blocks Blob blocks
+   * @param target_scores Target score by pool id
+   */
+  static float LayoutTierScore(
+      const BlobBlockList &blocks,
+      const std::unordered_map<chi::PoolId, float> &target_scores);
+
+  /**
+   * Snapshot a tag's replication factor, placement policy and dedup chunk
+   * size as one record
+   * @param tag_id Tag to snapshot
+   */
+  TxnTagPolicy GetTagPolicy(const TagId &tag_id);
+
+  /**
+   * Install a tag's settings from a checkpoint or log record; defaults
+   * remove the tag from the policy maps
+   * @param txn Settings to install
+   */
+  void ApplyTagPolicy(const TxnTagPolicy &txn);
+
+  /**
+   * Record a tag's settings after SetTagReplication, SetTagPlacement or
+   * SetTagDedup changed one (kSetTagPolicy). A tag always logs to the same
+   * tag log, so replay sees its changes in order.
+   * @param tag_id Tag whose settings changed
+   */
+  void LogTagPolicy(const TagId &tag_id);
+
+  /**
+   * Record a stub's source file range in the write-ahead log (kSetBlobStub)
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob name
+   * @param blob_info Stub blob whose source is logged
+   */
+  void LogBlobStub(const TagId &tag_id, const std::string &blob_name,
+                   const BlobInfo &blob_info);
+
+  /**
+   * Record a blob's full block list in the write-ahead log (kExtendBlob)
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob name
+   * @param blob_info Blob whose blocks are logged
+   */
+  void LogBlobBlocks(const TagId &tag_id, const std::string &blob_name,
+                     const BlobInfo &blob_info);
+
+  /**
+   * Piece of a blob I/O that lands on a single target, sent as one bdev
+   * Write/Read. The data is laid out sequentially across blocks_ starting at
+   * data_offset_ in the caller's buffer, unless block_offsets_ gives each
+   * block's offset relative to data_offset_.
+   */
+  struct BlockIoRun {
+    chi::PoolId target_id_;
+    std::vector<chimaera::bdev::Block> blocks_;
+    std::vector<chi::u64> block_offsets_;  // Empty while sequential
+    size_t data_offset_;
+    size_t size_;  // Bytes transferred
+    size_t span_;  // Bytes of the buffer covered, gaps included
+  };
+
+  /**
+   * Resolve the pool query used to issue bdev calls to a registered target
+   * @param target_id Bdev pool id referenced by a BlobBlock
+   * @param target_query Output: pool query of the target
+   * @return true if the target is registered, false otherwise
+   */
+  bool GetTargetQuery(const chi::PoolId &target_id,
+                      chi::PoolQuery &target_query);
+
+  /**
+   * Find the metric slot of a target without locking
+   * @param target_id Bdev pool id of the target
+   * @return Slot, or nullptr if the target never claimed one
+   */
+  TargetMetricSlot *FindTargetMetrics(const chi::PoolId &target_id);
+
+  /**
+   * Find or claim the metric slot of a target (RegisterTarget only).
+   * Slots are never recycled, so the metrics thread can read them freely.
+   * @param target_id Bdev pool id of the target
+   * @param target_name Target name used as the metric label
+   * @return Slot, or nullptr once kMaxTargetMetrics targets were seen
+   */
+  TargetMetricSlot *ClaimTargetMetrics(const chi::PoolId &target_id,
+                                       const std::string &target_name);
+
+  /**
+   * Count a completed bdev transfer against its target
+   * @param target_id Bdev pool id of the target
+   * @param bytes Bytes transferred
+   * @param is_write Whether the transfer was a write
+   */
+  void CountTargetIo(const chi::PoolId &target_id, chi::u64 bytes,
+                     bool is_write);
+
+  /** Key of this container's collector in CHI_METRICS */
+  std::string MetricsKey() const;
+
+  /**
+   * Emit target and WAL metrics (runs on the metrics thread)
+   * @param writer Exposition being built
    */
-  chi::TaskResume ExtendBlob(BlobInfo &blob_info, chi::u64 offset, chi::u64 size,
-                             float blob_score, chi::u32 &error_code,
-                             int min_persistence_level = 0);
+  void CollectMetrics(chi::MetricsWriter &writer);
+
+  /**
+   * Split a byte range of a blob into per-target I/O runs. Consecutive
+   * blocks on the same target are grouped into one run.
+   * @param blocks Blob blocks in blob order
+   * @param data_offset_in_blob Offset within blob where the range starts
+   * @param data_size Size of the range
+   * @param runs Output: runs covering the part of the range backed by blocks
+   * @param merge_interleaved Also fold a block into an earlier run of its
+   *        target when the run's span stays within twice its payload
+   */
+  static void BuildBlockIoRuns(const BlobBlockList &blocks,
+                               size_t data_offset_in_blob, size_t data_size,
+                               std::vector<BlockIoRun> &runs,
+                               bool merge_interleaved = false);
+
+  /**
+   * Find the run a block piece joins in BuildBlockIoRuns
+   * @param runs Runs built so far
+   * @param target_id Target of the piece
+   * @param piece_offset Offset of the piece in the caller's buffer
+   * @param piece_size Size of the piece
+   * @param merge_interleaved Whether runs other than the last may be joined
+   * @return The run to extend, or nullptr to start a new one
+   */
+  static BlockIoRun *FindBlockIoRun(std::vector<BlockIoRun> &runs,
+                                    const chi::PoolId &target_id,
+                                    size_t piece_offset, size_t piece_size,
+                                    bool merge_interleaved);
 
   /**
    * Write data to existing blob blocks
@@ -368,11 +1032,13 @@ private:
    * @param data_size Size of data to write
    * @param data_offset_in_blob Offset within blob where data starts
    * @param error_code Output: 0 for success, 1 for failure
+   * @param qos_class QoS class the bdev writes are admitted under
    * Returns TaskResume for coroutine-based async operations
    */
-  chi::TaskResume ModifyExistingData(const chi::priv::vector<BlobBlock> &blocks,
+  chi::TaskResume ModifyExistingData(const BlobBlockList &blocks,
                                      hipc::ShmPtr<> data, size_t data_size,
-                                     size_t data_offset_in_blob, chi::u32 &error_code);
+                                     size_t data_offset_in_blob, chi::u32 &error_code,
+                                     chi::u32 qos_class = 0);
 
   /**
    * Read existing blob data from blocks
@@ -381,10 +1047,55 @@ private:
    * @param data_size Size of data to read
    * @param data_offset_in_blob Offset within blob where reading starts
    * @param error_code Output: 0 for success, 1 for failure
+   * @param qos_class QoS class the bdev reads are admitted under
+   * Returns TaskResume for coroutine-based async operations
+   */
+  chi::TaskResume ReadData(const BlobBlockList &blocks, hipc::ShmPtr<> data,
+                           size_t data_size, size_t data_offset_in_blob, chi::u32 &error_code,
+                           chi::u32 qos_class = 0);
+
+  /**
+   * ReadData for GetBlob, sharing one bdev read between concurrent readers:
+   * joins a read of the same blob in flight that covers the range, or
+   * leads a new one other readers can join
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob name
+   * @param blob_info Blob to read
+   * @param data Output buffer to read data into
+   * @param data_size Size of data to read
+   * @param data_offset_in_blob Offset within blob where reading starts
+   * @param error_code Output: 0 for success, else the ReadData error
+   * @param qos_class QoS class the bdev reads are admitted under
+   */
+  chi::TaskResume ReadDataOnce(const TagId &tag_id,
+                               const std::string &blob_name,
+                               const BlobInfo &blob_info, hipc::ShmPtr<> data,
+                               size_t data_size, size_t data_offset_in_blob,
+                               chi::u32 &error_code, chi::u32 qos_class);
+
+  /**
+   * Read a byte range of a blob as readers see it, decoding an
+   * erasure-coded blob's shards
+   * @param layout Blob layout (blocks and erasure-code fields)
+   * @param data Output buffer to read data into
+   * @param data_size Size of data to read
+   * @param data_offset_in_blob Offset within blob where reading starts
+   * @param error_code Output: 0 for success, non-zero for failure
+   * @param qos_class QoS class the bdev reads are admitted under
+   */
+  chi::TaskResume ReadBlobData(const BlobInfo &layout, hipc::ShmPtr<> data,
+                               size_t data_size, size_t data_offset_in_blob,
+                               chi::u32 &error_code, chi::u32 qos_class = 0);
+
+  /**
+   * Wait until the QoS scheduler admits one bdev submission
+   * @param qos_class QoS class of the submission
+   * @param target_id Target the submission goes to
+   * @param bytes Bytes read or written
    * Returns TaskResume for coroutine-based async operations
    */
-  chi::TaskResume ReadData(const chi::priv::vector<BlobBlock> &blocks, hipc::ShmPtr<> data,
-                           size_t data_size, size_t data_offset_in_blob, chi::u32 &error_code);
+  chi::TaskResume AdmitIo(chi::u32 qos_class, const chi::PoolId &target_id,
+                          chi::u64 bytes);
 
   /**
    * Log telemetry data for CTE operations
@@ -421,13 +1132,247 @@ private:
    */
   void ReplayTransactionLogs();
 
+  /**
+   * Apply one checkpoint file (base image or delta) to the metadata maps
+   * @param path Checkpoint file path (memory mapped)
+   * @param volatile_targets Targets whose blocks are dropped on restart
+   * @param max_minor In/out: one past the largest restored tag minor
+   * @param tags_restored In/out: tag entries applied
+   * @param blobs_restored In/out: blob entries applied
+   * @param hash_id In/out: routing hash recorded by the file, if any
+   * @return false if the file could not be opened
+   */
+  bool LoadCheckpointFile(
+      const std::string &path,
+      const std::unordered_set<chi::PoolId> &volatile_targets,
+      chi::u32 &max_minor, chi::u32 &tags_restored, chi::u32 &blobs_restored,
+      BlobHashId &hash_id);
+
+  /**
+   * Apply the entries under a checkpoint cursor to the metadata maps
+   * @param reader Cursor over a checkpoint file or a prefix of one
+   * @param path Checkpoint file path (for log messages)
+   * @param volatile_targets Targets whose blocks are dropped on restart
+   * @param max_minor In/out: one past the largest restored tag minor
+   * @param tags_restored In/out: tag entries applied
+   * @param blobs_restored In/out: blob entries applied
+   * @param hash_id In/out: routing hash recorded by the file, if any
+   */
+  void LoadCheckpointEntries(
+      CheckpointReader &reader, const std::string &path,
+      const std::unordered_set<chi::PoolId> &volatile_targets,
+      chi::u32 &max_minor, chi::u32 &tags_restored, chi::u32 &blobs_restored,
+      BlobHashId &hash_id);
+
+  /**
+   * Attach a base image without loading its blobs: restore the tags,
+   * validate the tag index and defer every tag's blobs to LoadDeferredTag
+   * @param path Base image path
+   * @param volatile_targets Targets whose blocks are dropped on restart
+   * @param max_minor In/out: one past the largest restored tag minor
+   * @param tags_restored In/out: tag entries applied
+   * @param hash_id In/out: routing hash recorded by the image
+   * @param deferred Output: number of tags deferred
+   * @return false if the image has no valid index or shares blocks between
+   *         blobs; the caller then loads it in full
+   */
+  bool AttachBaseImage(
+      const std::string &path,
+      const std::unordered_set<chi::PoolId> &volatile_targets,
+      chi::u32 &max_minor, chi::u32 &tags_restored, BlobHashId &hash_id,
+      size_t &deferred);
+
+  /**
+   * Read a deferred tag's blobs from the attached base image
+   * @param tag_id Tag being touched for the first time since restart
+   * @return Insert patches for the tag's blobs (empty if its section fails
+   *         its checksum)
+   */
+  std::vector<BlobPatch> LoadDeferredTag(const TagId &tag_id);
+
+  /**
+   * Parse one blob checkpoint entry (after its type byte), dropping blocks
+   * on volatile targets
+   * @param reader Cursor over the checkpoint file
+   * @param volatile_targets Targets whose blocks are dropped on restart
+   * @param key Output composite blob key
+   * @param blob_info Output blob metadata
+   * @param is_stub Entry is a kBlobStub carrying a source range
+   * @param is_erasure Entry is a kBlobErasure carrying a shard layout
+   * @param is_encrypted Entry is a kBlobEncrypted carrying its chunking
+   * @return false on a truncated entry
+   */
+  bool ReadBlobEntry(CheckpointReader &reader,
+                     const std::unordered_set<chi::PoolId> &volatile_targets,
+                     std::string &key, BlobInfo &blob_info,
+                     bool is_stub = false, bool is_erasure = false,
+                     bool is_encrypted = false);
+
+  /** IDs of registered targets with volatile persistence */
+  std::unordered_set<chi::PoolId> SnapshotVolatileTargets();
+
+  /**
+   * Reduce one worker's blob WAL to the net patch of each blob it touched.
+   * Touches no runtime state, so logs can be folded concurrently.
+   * @param path Blob WAL base path
+   * @param volatile_targets Targets whose blocks are dropped on restart
+   * @param ops Output: number of records folded
+   * @return One patch per blob, to be applied in log order
+   */
+  static std::vector<BlobPatch> FoldBlobLog(
+      const std::string &path,
+      const std::unordered_set<chi::PoolId> &volatile_targets, chi::u32 &ops);
+
+  /**
+   * Check whether a blob still has blocks below a persistence level
+   * (caller holds target_lock_)
+   * @param blob_info Blob to inspect
+   * @param level Persistence level the blob should reach
+   * @return true if any block lives on a target below level
+   */
+  bool HasBlocksBelow(const BlobInfo &blob_info, int level);
+
+  /**
+   * Mark a blob dirty and queue it for write-back when it gains blocks
+   * below the flush level, or mark it clean when it has none left
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob name
+   * @param blob_info Blob metadata (dirty_since_ is updated)
+   */
+  void UpdateWriteBackState(const TagId &tag_id, const std::string &blob_name,
+                            BlobInfo &blob_info);
+
+  /**
+   * Scan every blob for blocks below a persistence level
+   * @param level Persistence level the blobs should reach
+   * @param track Mark the blobs dirty and add them to write_back_queue_
+   * @return The blobs found, oldest modification first
+   */
+  std::deque<DirtyBlob> ScanDirtyBlobs(int level, bool track);
+
+  /**
+   * Take up to max_items dirty blobs off a work list and read their data
+   * @param work Dirty blobs still to flush
+   * @param max_items Maximum number of blobs to read
+   * @param level Persistence level the blobs should reach
+   * @param items Output: blobs read into memory
+   */
+  chi::TaskResume ReadFlushBatch(std::deque<DirtyBlob> &work,
+                                 size_t max_items, int level,
+                                 std::vector<FlushItem> &items);
+
+  /**
+   * Put a dirty blob back at the head of the write-back queue
+   * @param blob Blob to retry on the next pass
+   */
+  void RequeueWriteBack(const DirtyBlob &blob);
+
+  /**
+   * Record that a blob changed since the last metadata checkpoint
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob name
+   */
+  void MarkBlobDirty(const TagId &tag_id, const std::string &blob_name);
+
+  /**
+   * Publish a blob's size and score to local clients, unless it is a
+   * replica copy or changed since \a ticket was taken
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob name
+   * @param ticket Taken before blob_info was looked up
+   * @param blob_info Blob metadata
+   */
+  void PublishBlobMeta(const TagId &tag_id, const std::string &blob_name,
+                       const BlobMetaTable::Ticket &ticket,
+                       const BlobInfo &blob_info);
+
+  /**
+   * Record that a tag changed since the last metadata checkpoint and revoke
+   * client metadata leases on it
+   * @param tag_id Tag ID
+   */
+  void MarkTagDirty(const TagId &tag_id);
+
+  /**
+   * Resolve every registered target to its pool query (taken once per
+   * checkpoint so the blob scan does not hold target_lock_)
+   */
+  std::unordered_map<chi::PoolId, chi::PoolQuery> SnapshotTargetQueries();
+
+  /**
+   * Serialize the routing-hash record that leads every checkpoint file
+   * @param os Output stream
+   */
+  void WriteHashIdEntry(std::ostream &os) const;
+
+  /**
+   * Serialize the list of small-object segments allocated right now
+   * @param os Output stream
+   */
+  void WritePackSegmentsEntry(std::ostream &os);
+
+  /**
+   * Serialize every tag's replication, placement and dedup settings
+   * @param os Output stream
+   */
+  void WriteTagPoliciesEntry(std::ostream &os);
+
+  /**
+   * Serialize one tag checkpoint entry
+   * @param os Output stream
+   * @param tag_id Tag ID
+   * @param info Tag metadata
+   */
+  static void WriteTagEntry(std::ostream &os, const TagId &tag_id,
+                            const TagInfo &info);
+
+  /**
+   * Serialize one blob checkpoint entry
+   * @param os Output stream
+   * @param key Composite blob key
+   * @param blob_info Blob metadata
+   * @param queries Target pool queries from SnapshotTargetQueries()
+   */
+  static void WriteBlobEntry(
+      std::ostream &os, const std::string &key, const BlobInfo &blob_info,
+      const std::unordered_map<chi::PoolId, chi::PoolQuery> &queries);
+
+  /**
+   * Serialize a full base image of all tags and blobs
+   * @param os Image stream (written to disk by MetadataCheckpoint::Write)
+   * @param entries Output: number of entries written
+   */
+  void SerializeBaseImage(std::ostream &os, chi::u64 &entries);
+
+  /**
+   * Serialize a delta holding the current state of the given tags and
+   * blobs, with tombstones for those that no longer exist
+   * @param os Image stream (written to disk by MetadataCheckpoint::Write)
+   * @param blob_keys Composite keys of changed blobs
+   * @param tag_ids Changed tags
+   * @param entries Output: number of entries written
+   */
+  void SerializeDeltaImage(std::ostream &os,
+                           const std::vector<std::string> &blob_keys,
+                           const std::vector<TagId> &tag_ids,
+                           chi::u64 &entries);
+
+  /**
+   * Sync the WALs and truncate them once a checkpoint covers them and they
+   * exceed the configured capacity. Only touches the (locked) logs, so it
+   * may run on a blocking pool thread.
+   */
+  void TruncateCoveredTransactionLogs();
+
   /**
    * Retrieve telemetry entries for analysis (non-destructive peek)
-   * @param entries Vector to store retrieved entries
+   * @param entries Vector to store retrieved entries, oldest first
+   * @param min_logical_time Smallest logical time to retrieve
    * @param max_entries Maximum number of entries to retrieve
    * @return Number of entries actually retrieved
    */
   size_t GetTelemetryEntries(std::vector<CteTelemetry> &entries,
+                             std::uint64_t min_logical_time = 0,
                              size_t max_entries = 100);
 
   /**
@@ -487,11 +1432,110 @@ private:
    */
   chi::TaskResume FlushMetadata(hipc::FullPtr<FlushMetadataTask> task, chi::RunContext &ctx);
 
+  /**
+   * Group-commit buffered WAL records (Method::kCommitTransactionLogs)
+   */
+  chi::TaskResume CommitTransactionLogs(hipc::FullPtr<CommitTransactionLogsTask> task, chi::RunContext &ctx);
+
+  /**
+   * Register a virtual blob backed by a source file range
+   * (Method::kRegisterBlobStub)
+   */
+  chi::TaskResume RegisterBlobStub(hipc::FullPtr<RegisterBlobStubTask> task, chi::RunContext &ctx);
+
+  /**
+   * Allocate a blob's capacity ahead of chunked writes, zero-filling the
+   * new range (Method::kReserveBlob)
+   */
+  chi::TaskResume ReserveBlob(hipc::FullPtr<ReserveBlobTask> task, chi::RunContext &ctx);
+
+  /**
+   * Pin a blob range on RAM targets for a local client to read in place
+   * (Method::kGetBlobView)
+   */
+  chi::TaskResume GetBlobView(hipc::FullPtr<GetBlobViewTask> task, chi::RunContext &ctx);
+
+  /**
+   * Unpin the blocks of a blob view (Method::kReleaseBlobView)
+   */
+  chi::TaskResume ReleaseBlobView(hipc::FullPtr<ReleaseBlobViewTask> task, chi::RunContext &ctx);
+
+  /**
+   * Link matching blobs of one tag into another (Method::kSpliceBlobs)
+   */
+  chi::TaskResume SpliceBlobs(hipc::FullPtr<SpliceBlobsTask> task, chi::RunContext &ctx);
+
+  /**
+   * Set a tag's content dedup chunk size (Method::kSetTagDedup)
+   */
+  chi::TaskResume SetTagDedup(hipc::FullPtr<SetTagDedupTask> task, chi::RunContext &ctx);
+
+  /**
+   * Set a tag's erasure code (Method::kSetTagErasure)
+   */
+  chi::TaskResume SetTagErasure(hipc::FullPtr<SetTagErasureTask> task, chi::RunContext &ctx);
+
+  /**
+   * Set a tag's at-rest encryption (Method::kSetTagEncryption)
+   */
+  chi::TaskResume SetTagEncryption(hipc::FullPtr<SetTagEncryptionTask> task, chi::RunContext &ctx);
+
+  /**
+   * Set a tag's blob time to live (Method::kSetTagTtl)
+   */
+  chi::TaskResume SetTagTtl(hipc::FullPtr<SetTagTtlTask> task, chi::RunContext &ctx);
+
+  /**
+   * Set a tag's blob placement policy (Method::kSetTagPlacement)
+   */
+  chi::TaskResume SetTagPlacement(hipc::FullPtr<SetTagPlacementTask> task, chi::RunContext &ctx);
+
+  /**
+   * Set a tag's blob replication factor (Method::kSetTagReplication)
+   */
+  chi::TaskResume SetTagReplication(hipc::FullPtr<SetTagReplicationTask> task, chi::RunContext &ctx);
+
+  /**
+   * Re-copy replicas lost to container recovery (Method::kRepairReplicas)
+   */
+  chi::TaskResume RepairReplicas(hipc::FullPtr<RepairReplicasTask> task, chi::RunContext &ctx);
+
+  /**
+   * Install consistent-hash placement weights (Method::kSetPlacementWeights)
+   */
+  chi::TaskResume SetPlacementWeights(hipc::FullPtr<SetPlacementWeightsTask> task, chi::RunContext &ctx);
+
+  /**
+   * Move blobs whose placement owner changed (Method::kRebalanceBlobs)
+   */
+  chi::TaskResume RebalanceBlobs(hipc::FullPtr<RebalanceBlobsTask> task, chi::RunContext &ctx);
+
   /**
    * Flush data from volatile to non-volatile targets (Method::kFlushData)
    */
   chi::TaskResume FlushData(hipc::FullPtr<FlushDataTask> task, chi::RunContext &ctx);
 
+  /**
+   * Rewrite fragmented blobs into contiguous blocks (Method::kDefragBlobs)
+   */
+  chi::TaskResume DefragBlobs(hipc::FullPtr<DefragBlobsTask> task, chi::RunContext &ctx);
+
+  /**
+   * Move blobs between storage tiers by access heat (Method::kMigrateBlobs)
+   */
+  chi::TaskResume MigrateBlobs(hipc::FullPtr<MigrateBlobsTask> task, chi::RunContext &ctx);
+
+  /**
+   * Demote blobs off targets above their high watermark
+   * (Method::kEvictTargets)
+   */
+  chi::TaskResume EvictTargets(hipc::FullPtr<EvictTargetsTask> task, chi::RunContext &ctx);
+
+  /**
+   * Free the blobs whose TTL has run out (Method::kExpireBlobs)
+   */
+  chi::TaskResume ExpireBlobs(hipc::FullPtr<ExpireBlobsTask> task, chi::RunContext &ctx);
+
 private:
   /**
    * Helper function to compute hash-based pool query for blob operations
@@ -501,6 +1545,582 @@ private:
    */
   chi::PoolQuery HashBlobToContainer(const TagId &tag_id,
                                      const std::string &blob_name);
+
+  /**
+   * Hash a blob key the way HashBlobToContainer routes it (blob_hash_id_)
+   * @param tag_id Tag ID for the blob
+   * @param blob_name Blob name
+   * @return Hash whose value modulo the container count is the primary
+   */
+  chi::u32 HashBlobKey(const TagId &tag_id, const std::string &blob_name);
+
+  /**
+   * Get a tag's placement policy
+   * @param tag_id Tag ID
+   * @return Policy set by SetTagPlacement, or the default blob-name hash
+   */
+  TagPlacement GetTagPlacement(const TagId &tag_id);
+
+  /**
+   * Compute the key a blob is placed by under a tag's policy
+   * @param tag_id Tag ID for the blob
+   * @param blob_name Blob name
+   * @param placement Policy of the tag (not kPinCreator)
+   * @param ring Ring the key is looked up in, or null for modulo placement
+   * @return Key for ring->Lookup, or whose value modulo the container
+   * count is the primary
+   */
+  chi::u32 PlacementKey(const TagId &tag_id, const std::string &blob_name,
+                        const TagPlacement &placement, const HashRing *ring);
+
+  /**
+   * Get a tag's replication factor, capped at the pool's container count
+   * @param tag_id Tag ID
+   * @return Containers holding each blob of the tag (1 = not replicated)
+   */
+  chi::u32 GetTagReplicas(const TagId &tag_id);
+
+  /**
+   * Get the containers holding a blob: the primary chosen by
+   * HashBlobToContainer followed by the next replicas - 1 containers
+   * @param tag_id Tag ID for the blob
+   * @param blob_name Blob name
+   * @param replicas Replication factor from GetTagReplicas
+   * @return Container IDs, primary first
+   */
+  std::vector<chi::ContainerId> GetBlobReplicas(const TagId &tag_id,
+                                                const std::string &blob_name,
+                                                chi::u32 replicas);
+
+  /**
+   * Check whether this container holds a blob as a non-primary replica
+   * @param tag_id Tag ID for the blob
+   * @param blob_name Blob name
+   * @param replicas Replication factor from GetTagReplicas
+   * @return true if the blob is replicated and another container is primary
+   */
+  bool IsReplicaCopy(const TagId &tag_id, const std::string &blob_name,
+                     chi::u32 replicas);
+
+  /**
+   * Route a read of a replicated blob: a replica on this node if there is
+   * one, otherwise the replicas in turn
+   * @param tag_id Tag ID for the blob
+   * @param blob_name Blob name
+   * @return PoolQuery for the chosen replica
+   */
+  chi::PoolQuery ScheduleReplicaRead(const TagId &tag_id,
+                                     const std::string &blob_name);
+
+  /**
+   * Copy a write applied on the primary to the other replicas, failing the
+   * task (return code 30) unless a majority of the replicas hold it
+   * @param task PutBlob task that was applied locally
+   * @param score Placement score the primary resolved for the blob
+   * @param replicas Replication factor from GetTagReplicas
+   */
+  chi::TaskResume ReplicateBlobWrite(hipc::FullPtr<PutBlobTask> task,
+                                     float score, chi::u32 replicas);
+
+  /**
+   * Delete the non-primary replicas of a blob
+   * @param tag_id Tag ID for the blob
+   * @param blob_name Blob name
+   * @param replicas Containers holding the blob, primary first
+   */
+  chi::TaskResume ReplicateBlobDelete(const TagId &tag_id,
+                                      const std::string &blob_name,
+                                      const std::vector<chi::ContainerId> &replicas);
+
+  /**
+   * Copy one local blob to the replicas this container is responsible for
+   * repairing (the first holder after each missing replica in ring order)
+   * @param tag_id Tag ID for the blob
+   * @param blob_name Blob name
+   * @param replicas Replication factor from GetTagReplicas
+   * @param bytes_repaired Output: bytes written to other containers
+   */
+  chi::TaskResume RepairBlobReplicas(const TagId &tag_id,
+                                     const std::string &blob_name,
+                                     chi::u32 replicas,
+                                     chi::u64 &bytes_repaired);
+
+  /**
+   * Get the current placement ring
+   * @return Ring, or null when blobs are placed by modulo hashing
+   */
+  std::shared_ptr<const HashRing> GetPlacementRing();
+
+  /**
+   * Find the container that owned a blob before the last placement change
+   * @param tag_id Tag ID for the blob
+   * @param blob_name Blob name
+   * @param owner Output: previous owner
+   * @return true if placement changed and the previous owner is another
+   * container
+   */
+  bool GetPreviousOwner(const TagId &tag_id, const std::string &blob_name,
+                        chi::ContainerId &owner);
+
+  /**
+   * Pick the container a local miss should be forwarded to: the previous
+   * owner while blobs may still be moving, else the primary replica
+   * @param tag_id Tag ID for the blob
+   * @param blob_name Blob name
+   * @param holder Output: container to read from
+   * @return true if the miss should be forwarded
+   */
+  bool FindRedirectTarget(const TagId &tag_id, const std::string &blob_name,
+                          chi::ContainerId &holder);
+
+  /**
+   * Move a blob from its previous owner to this container ahead of a
+   * partial write (a full write simply replaces it)
+   * @param tag_id Tag ID for the blob
+   * @param blob_name Blob name
+   * @param owner Previous owner
+   */
+  chi::TaskResume PullFromPreviousOwner(const TagId &tag_id,
+                                        const std::string &blob_name,
+                                        chi::ContainerId owner);
+
+  /**
+   * Copy a local blob to its new owner and drop the local copy
+   * @param tag_id Tag ID for the blob
+   * @param blob_name Blob name
+   * @param owner New owner
+   * @param bytes_moved Output: bytes moved (0 if the blob stayed)
+   */
+  chi::TaskResume MoveBlob(const TagId &tag_id, const std::string &blob_name,
+                           chi::ContainerId owner, chi::u64 &bytes_moved);
+
+  /**
+   * Copy a local blob to a migration destination, replacing any older copy
+   * there. A blob that no longer exists locally is deleted there instead.
+   * @param tag_id Tag ID for the blob
+   * @param blob_name Blob name
+   * @param node_id Destination node
+   * @param copied Output: true if the destination now matches this node
+   */
+  chi::TaskResume CopyBlobToNode(const TagId &tag_id,
+                                 const std::string &blob_name,
+                                 chi::u32 node_id, bool &copied);
+
+  /**
+   * Link a local blob into another tag under the same name. The new blob
+   * shares the source's blocks; neither copy is written in place again.
+   * @param src_tag_id Tag holding the blob
+   * @param dst_tag_id Tag receiving the link
+   * @param blob_name Blob name
+   * @return true if the link was created (false if the source is gone or
+   *         the destination name is taken)
+   */
+  bool LinkBlob(const TagId &src_tag_id, const TagId &dst_tag_id,
+                const std::string &blob_name);
+
+  /**
+   * Whether any block of a blob is shared with another blob
+   * @param blob_info Blob to check
+   * @return true if the blob must be copied before an in-place write
+   */
+  bool IsBlobShared(const BlobInfo &blob_info);
+
+  /**
+   * Recount blocks shared between blobs after metadata was restored
+   * (links are persisted as ordinary block lists)
+   */
+  void RebuildBlockRefs();
+
+  /**
+   * Track the small-object segments restored from the checkpoint and the
+   * logs again, counting the packed blocks of the restored blobs as their
+   * live objects
+   */
+  void RebuildPackSegments();
+
+  /**
+   * Load every deferred tag if a blob holds a block restored at restart,
+   * so that block_refs_ also counts the block's deferred holders. Call
+   * before deciding whether a blob's blocks are shared.
+   * @param blob_info Blob about to be freed or written in place
+   */
+  void SettleDeferredBlocks(const BlobInfo &blob_info);
+
+  /**
+   * Dedup chunk size of a tag
+   * @param tag_id Tag to look up
+   * @return Bytes per chunk, or 0 if the tag is not deduplicated
+   */
+  chi::u64 GetTagDedupChunk(const TagId &tag_id);
+
+  /**
+   * TTL of a tag
+   * @param tag_id Tag to look up
+   * @return Lifetime of each write in milliseconds, or 0 if none
+   */
+  chi::u64 GetTagTtl(const TagId &tag_id);
+
+  /**
+   * Give a blob a deadline ttl_ms from now and file it in the expiry wheel
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob name
+   * @param blob_info Blob to stamp
+   * @param ttl_ms Lifetime in milliseconds (0 = keep the current deadline)
+   * @param now Time of the write
+   */
+  void StampExpiry(const TagId &tag_id, const std::string &blob_name,
+                   BlobInfo &blob_info, chi::u64 ttl_ms, Timestamp now);
+
+  /**
+   * Context carrying a blob's remaining TTL, so that a copy or an internal
+   * rewrite of the blob expires when the original would have
+   * @param blob_info Blob being copied or rewritten
+   * @param ctx Context to carry it in
+   * @return ctx, with ttl_ms_ set if the blob has a deadline
+   */
+  static Context KeepTtl(const BlobInfo &blob_info, Context ctx = Context());
+
+  /**
+   * Store a full blob write chunk by chunk, referencing the stored extent of
+   * any chunk whose bytes match an indexed one instead of writing it again
+   * @param blob_info Blob being written; must hold no blocks
+   * @param blob_data Data to write (the whole blob)
+   * @param size Bytes to write
+   * @param chunk_size Bytes per fingerprinted chunk
+   * @param blob_score Score used to place the chunks that are stored
+   * @param min_persistence_level Minimum persistence level of their targets
+   * @param qos_class QoS class of the bdev I/O
+   * @param error_code 0 on success, 10 + ExtendBlob error or 20 + write
+   *        error as in PutBlob
+   */
+  chi::TaskResume DedupWriteBlob(BlobInfo &blob_info, hipc::ShmPtr<> blob_data,
+                                 chi::u64 size, chi::u64 chunk_size,
+                                 float blob_score, int min_persistence_level,
+                                 chi::u32 qos_class, chi::u32 &error_code);
+
+  /**
+   * Whether any block of a blob is a packed small object
+   * @param blob_info Blob to check
+   */
+  static bool HasPackedBlocks(const BlobInfo &blob_info);
+
+  /**
+   * Append a small blob write to the open segment of this worker on the
+   * target the DPE picks for it, opening a segment there if needed. Returns
+   * once the segment write covering the object has reached the target.
+   * @param blob_info Blob being written; must hold no blocks
+   * @param blob_data Data to write (the whole blob)
+   * @param size Bytes to write
+   * @param blob_score Score used to pick the target
+   * @param min_persistence_level Minimum persistence level of the target
+   * @param packed Set if the blob now holds a packed block; if not, the
+   *        caller stores it as an ordinary blob
+   */
+  chi::TaskResume PackWriteBlob(BlobInfo &blob_info, hipc::ShmPtr<> blob_data,
+                                chi::u64 size, float blob_score,
+                                int min_persistence_level, bool &packed);
+
+  /**
+   * Allocate a segment on a target and make it the open one of a worker
+   * @param target Target to allocate on
+   * @param slot Worker slot in pack_open_
+   * @param opened Set if the slot has an open segment on the target
+   */
+  chi::TaskResume OpenPackSegment(const TargetInfo &target, size_t slot,
+                                  bool &opened);
+
+  /**
+   * Write the appended bytes of a segment that are not on its target yet,
+   * as one write from the last unit boundary written. A sealed segment
+   * drops its memory copy once written, and is freed if no object is live.
+   * @param seg_id Segment to write out
+   * @param until Return once this many leading bytes are written, even if
+   *        more were appended since (default: all of them)
+   */
+  chi::TaskResume FlushPackSegment(chi::u64 seg_id, chi::u64 until = ~0ULL);
+
+  /**
+   * Write out every segment with appended bytes pending
+   */
+  chi::TaskResume FlushPackSegments();
+
+  /**
+   * Give a segment's space back to its target and stop tracking it
+   * @param seg_id Segment to free; must be reclaimable
+   */
+  chi::TaskResume FreePackSegment(chi::u64 seg_id);
+
+  /**
+   * Log the allocation or release of a segment to tag log 0, the one log
+   * all segment records go to so that replay sees them in order. The
+   * record is made durable right away: blob records referencing the
+   * segment may be committed to other logs first.
+   * @param type kAddPackSegment or kFreePackSegment
+   * @param target_id Target of the segment
+   * @param base Offset of the segment on the target
+   * @param size Bytes allocated
+   */
+  void LogPackSegment(TxnType type, const chi::PoolId &target_id,
+                      chi::u64 base, chi::u64 size);
+
+  /**
+   * Drop the references freed packed blocks held on their segments
+   * @param blocks Blocks being freed; the packed ones are removed
+   * @param reclaim Filled with segments no object references any more
+   */
+  void ReleasePackedBlocks(std::vector<BlobBlock> &blocks,
+                           std::vector<chi::u64> &reclaim);
+
+  /**
+   * Prepare a read of packed blocks. A read of a single packed block whose
+   * segment is still in memory is copied from there; otherwise the
+   * segments of the packed blocks read are written out first.
+   * @param blocks Blocks of the blob being read
+   * @param data Output buffer
+   * @param data_size Bytes to read
+   * @param data_offset_in_blob Offset of the read in the blob
+   * @param copied Set if the read was served from memory
+   */
+  chi::TaskResume ReadPackedData(const BlobBlockList &blocks,
+                                 hipc::ShmPtr<> data, size_t data_size,
+                                 size_t data_offset_in_blob, bool &copied);
+
+  /**
+   * Copy the live objects out of sealed segments whose live bytes fell to
+   * small_segment_clean_ratio, so the segments can be freed
+   * @param blobs_moved Output: blobs copied
+   * @param bytes_moved Output: bytes copied
+   */
+  chi::TaskResume CleanPackSegments(chi::u64 &blobs_moved,
+                                    chi::u64 &bytes_moved);
+
+  /**
+   * Copy a packed blob into an open segment, if no writer changes it
+   * meanwhile
+   * @param tag_id Tag of the blob
+   * @param blob_name Name of the blob
+   * @param bytes_moved Output: bytes copied (0 if it stayed)
+   */
+  chi::TaskResume RepackBlob(const TagId &tag_id, const std::string &blob_name,
+                             chi::u64 &bytes_moved);
+
+  /**
+   * Remove a blob's extents from the dedup index before they are written
+   * in place
+   * @param blob_info Blob about to be modified
+   */
+  void DropBlobFingerprints(const BlobInfo &blob_info);
+
+  /**
+   * Drop the pins of a blob view, freeing each block no blob holds any more
+   * @param blocks Blocks the view pinned
+   */
+  chi::TaskResume UnpinViewBlocks(const std::vector<BlobBlock> &blocks);
+
+  /**
+   * Unpin the views whose lease ran out without a release
+   */
+  chi::TaskResume ExpireBlobViewLeases();
+
+  /**
+   * Remove one extent from the dedup index; block_refs_lock_ must be held
+   * @param block Extent being freed or modified
+   */
+  void EraseFingerprint(const BlobBlock &block);
+
+  /**
+   * Erasure code of a tag
+   * @param tag_id Tag to look up
+   * @param data_shards Output: data shards k (0 if the tag is not coded)
+   * @param parity_shards Output: parity shards m
+   */
+  void GetTagErasure(const TagId &tag_id, chi::u32 &data_shards,
+                     chi::u32 &parity_shards);
+
+  /**
+   * Store a blob write as k data shards and m parity shards, each on a
+   * target no other shard of the blob uses where possible. A partial write
+   * to a blob with blocks decodes the blob, patches it and re-encodes it;
+   * the old blocks are then released.
+   * @param blob_info Blob being written; empty or holding its current data
+   * @param blob_data Data to write
+   * @param offset Offset in the blob where the data starts
+   * @param size Bytes to write
+   * @param data_shards k
+   * @param parity_shards m
+   * @param blob_score Score used to place the shards
+   * @param min_persistence_level Minimum persistence level of their targets
+   * @param qos_class QoS class of the bdev I/O
+   * @param error_code 0 on success, 10 + ExtendBlob error or 20 + write
+   *        error as in PutBlob, 40 + read error if the blob cannot be decoded
+   */
+  chi::TaskResume ErasureWriteBlob(BlobInfo &blob_info,
+                                   hipc::ShmPtr<> blob_data, chi::u64 offset,
+                                   chi::u64 size, chi::u32 data_shards,
+                                   chi::u32 parity_shards, float blob_score,
+                                   int min_persistence_level,
+                                   chi::u32 qos_class, chi::u32 &error_code);
+
+  /**
+   * Read a byte range of an erasure-coded blob. The data shards hold the
+   * blob bytes in order, so a healthy read is a plain read; if a shard is
+   * unreachable any k shards are read and the blob is rebuilt in memory.
+   * @param layout Blob layout (blocks and erasure-code fields)
+   * @param data Output buffer to read data into
+   * @param size Bytes to read
+   * @param offset Offset within the blob
+   * @param qos_class QoS class of the bdev reads
+   * @param error_code 0 on success, 1 if the range is past the blob end, 2
+   *        if fewer than k shards could be read
+   */
+  chi::TaskResume ReadErasureData(const BlobInfo &layout,
+                                  hipc::ShmPtr<> data, chi::u64 size,
+                                  chi::u64 offset, chi::u32 qos_class,
+                                  chi::u32 &error_code);
+
+  /** Bytes AES-GCM adds to each sealed chunk (nonce and tag) */
+  static constexpr chi::u64 kSealOverhead = 28;
+
+  /** Largest plaintext chunk SetTagEncryption accepts */
+  static constexpr chi::u32 kMaxEncryptChunk = 16 * 1024 * 1024;
+
+  /**
+   * Load the key for encrypted tags from encryption_key_path. A file of
+   * exactly 32 bytes is the key itself; anything else is a passphrase the
+   * key is derived from.
+   * @return true if a key is loaded
+   */
+  bool LoadEncryptionKey();
+
+  /**
+   * Encryption chunk size of a tag
+   * @param tag_id Tag to look up
+   * @return Plaintext bytes per sealed chunk, 0 if the tag is not encrypted
+   */
+  chi::u32 GetTagEncryptChunk(const TagId &tag_id);
+
+  /**
+   * Bytes an encrypted blob occupies in its blocks
+   * @param size Plaintext size
+   * @param chunk Plaintext bytes per chunk
+   */
+  static chi::u64 GetSealedSize(chi::u64 size, chi::u64 chunk);
+
+  /**
+   * Store a blob write as AES-GCM sealed chunks. Chunk i holds plaintext
+   * bytes [i, i + 1) * chunk at block offset i * (chunk + kSealOverhead).
+   * A write to a blob already sealed this way reseals only the chunks it
+   * touches, in place, opening the partly covered ones at either end; any
+   * other blob with blocks is read, merged with the write and sealed into
+   * new blocks.
+   * @param blob_info Blob being written; empty or holding its current data
+   * @param blob_data Data to write
+   * @param offset Offset in the blob where the data starts
+   * @param size Bytes to write
+   * @param chunk Plaintext bytes per chunk (the blob's own if it has one)
+   * @param blob_score Score used to place new blocks
+   * @param min_persistence_level Minimum persistence level of their targets
+   * @param qos_class QoS class of the bdev I/O
+   * @param error_code 0 on success, 10 + ExtendBlob error or 20 + write
+   *        error as in PutBlob, 21 if a buffer cannot be allocated or a
+   *        chunk cannot be sealed, 40 + read error if the current data
+   *        cannot be read
+   */
+  chi::TaskResume EncryptWriteBlob(BlobInfo &blob_info,
+                                   hipc::ShmPtr<> blob_data, chi::u64 offset,
+                                   chi::u64 size, chi::u32 chunk,
+                                   float blob_score, int min_persistence_level,
+                                   chi::u32 qos_class, chi::u32 &error_code);
+
+  /**
+   * Read a byte range of an encrypted blob. Only the sealed chunks covering
+   * the range are read and opened; chunks the range covers whole are
+   * opened straight into the output.
+   * @param layout Blob layout (blocks and encryption fields)
+   * @param data Output buffer to read data into
+   * @param size Bytes to read
+   * @param offset Offset within the blob
+   * @param qos_class QoS class of the bdev reads
+   * @param error_code 0 on success, 1 if the range is past the blob end, 2
+   *        if no buffer could be allocated, 3 if a chunk fails
+   *        authentication (altered data or wrong key), 4 if no key is
+   *        loaded, 10 + read error
+   */
+  chi::TaskResume ReadEncryptedData(const BlobInfo &layout,
+                                    hipc::ShmPtr<> data, chi::u64 size,
+                                    chi::u64 offset, chi::u32 qos_class,
+                                    chi::u32 &error_code);
+
+  /**
+   * Blocks holding one shard of an erasure-coded blob
+   * @param layout Blob layout
+   * @param shard Shard index (data shards first)
+   * @param blocks Output: the shard's byte range of layout.blocks_
+   */
+  static void GetShardBlocks(const BlobInfo &layout, chi::u32 shard,
+                             BlobBlockList &blocks);
+
+  /**
+   * Targets that can serve I/O: registered and, if pinned to a node, on a
+   * node that is not known to be dead
+   */
+  std::unordered_set<chi::PoolId> SnapshotReachableTargets();
+
+  /**
+   * Rebuild erasure-code shards that sit on unreachable targets
+   * @param blobs_repaired Output: incremented per blob rebuilt
+   * @param bytes_repaired Output: incremented by the shard bytes written
+   */
+  chi::TaskResume RepairErasureBlobs(chi::u64 &blobs_repaired,
+                                     chi::u64 &bytes_repaired);
+
+  /**
+   * Rebuild the unreachable shards of one erasure-coded blob onto targets it
+   * does not use yet. The new shards are kept only if the blob was not
+   * rewritten meanwhile.
+   * @param tag_id Tag containing the blob
+   * @param blob_name Blob to repair
+   * @param reachable Targets that can serve I/O
+   * @param bytes_repaired Output: shard bytes written (0 if none)
+   */
+  chi::TaskResume RepairErasureBlob(
+      const TagId &tag_id, const std::string &blob_name,
+      const std::unordered_set<chi::PoolId> &reachable,
+      chi::u64 &bytes_repaired);
+
+  /**
+   * Whether a container of this pool is served by this container, either
+   * as itself or as one mapped to this node with no container of its own
+   * here (another shard of a sharded pool is not)
+   * @param container_id Container ID
+   * @return true if the container is local
+   */
+  bool IsLocalContainer(chi::ContainerId container_id) const;
+
+  /**
+   * Remove a local blob unless it was written since a given time
+   * @param tag_id Tag ID for the blob
+   * @param blob_name Blob name
+   * @param expected_modified last_modified_ seen when the copy was taken
+   * @param evicted Output: true if the blob was removed
+   */
+  chi::TaskResume EvictBlob(const TagId &tag_id, const std::string &blob_name,
+                            Timestamp expected_modified, bool &evicted);
+
+  /**
+   * Snapshot the node hosting each container of this pool
+   * @return Node IDs indexed by container ID
+   */
+  std::vector<chi::u32> SnapshotContainerNodes();
+
+  /**
+   * Collect the local tags whose names match a pattern. Literal patterns are
+   * answered with a single lookup instead of a scan.
+   * @param pattern Classified tag name pattern
+   * @return (tag_name, tag_id) pairs in unspecified order
+   */
+  std::vector<std::pair<std::string, TagId>> CollectMatchingTags(
+      const NamePattern &pattern);
 };
 
 } // namespace wrp_cte::core
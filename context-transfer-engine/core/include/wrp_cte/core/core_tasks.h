@@ -49,7 +49,9 @@
 #include <yaml-cpp/yaml.h>
 
 #include <hermes_shm/data_structures/serialization/global_serialize.h>
+#include <algorithm>
 #include <chrono>
+#include <tuple>
 #endif
 
 namespace wrp_cte::core {
@@ -179,8 +181,15 @@ struct TargetInfo {
   chi::u64 ops_written_;
   float target_score_;        // Target score (0-1, normalized log bandwidth)
   chi::u64 remaining_space_;  // Remaining allocatable space in bytes
+  chi::u64 capacity_;         // Total capacity at registration (0: unknown)
+  chi::u64 inflight_bytes_;   // Bytes queued on the bdev at the last stat,
+                              // plus bytes placed on it since
   chimaera::bdev::PerfMetrics perf_metrics_;  // Performance metrics from bdev
+  chimaera::bdev::PerfModel perf_model_;      // Curves fitted by the bdev
   chimaera::bdev::PersistenceLevel persistence_level_;
+  chimaera::bdev::BdevType bdev_type_;  // Backend of the target's bdev
+  bool client_mappable_;  // Buffer is a segment local clients can map
+  int numa_node_;         // Socket of the device (-1: unknown)
 
   HSHM_CROSS_FUN TargetInfo()
       : target_name_(CHI_PRIV_ALLOC),
@@ -191,7 +200,12 @@ struct TargetInfo {
         ops_written_(0),
         target_score_(0.0f),
         remaining_space_(0),
-        persistence_level_(chimaera::bdev::PersistenceLevel::kVolatile) {}
+        capacity_(0),
+        inflight_bytes_(0),
+        persistence_level_(chimaera::bdev::PersistenceLevel::kVolatile),
+        bdev_type_(chimaera::bdev::BdevType::kFile),
+        client_mappable_(false),
+        numa_node_(-1) {}
 
 #if HSHM_IS_HOST
   TargetInfo(const std::string &name, const std::string &bdev_name)
@@ -203,7 +217,12 @@ struct TargetInfo {
         ops_written_(0),
         target_score_(0.0f),
         remaining_space_(0),
-        persistence_level_(chimaera::bdev::PersistenceLevel::kVolatile) {}
+        capacity_(0),
+        inflight_bytes_(0),
+        persistence_level_(chimaera::bdev::PersistenceLevel::kVolatile),
+        bdev_type_(chimaera::bdev::BdevType::kFile),
+        client_mappable_(false),
+        numa_node_(-1) {}
 #endif
 
   HSHM_CROSS_FUN TargetInfo(const TargetInfo &other)
@@ -217,8 +236,14 @@ struct TargetInfo {
         ops_written_(other.ops_written_),
         target_score_(other.target_score_),
         remaining_space_(other.remaining_space_),
+        capacity_(other.capacity_),
+        inflight_bytes_(other.inflight_bytes_),
         perf_metrics_(other.perf_metrics_),
-        persistence_level_(other.persistence_level_) {}
+        perf_model_(other.perf_model_),
+        persistence_level_(other.persistence_level_),
+        bdev_type_(other.bdev_type_),
+        client_mappable_(other.client_mappable_),
+        numa_node_(other.numa_node_) {}
 
   HSHM_CROSS_FUN TargetInfo &operator=(const TargetInfo &other) {
     if (this != &other) {
@@ -232,8 +257,14 @@ struct TargetInfo {
       ops_written_ = other.ops_written_;
       target_score_ = other.target_score_;
       remaining_space_ = other.remaining_space_;
+      capacity_ = other.capacity_;
+      inflight_bytes_ = other.inflight_bytes_;
       perf_metrics_ = other.perf_metrics_;
+      perf_model_ = other.perf_model_;
       persistence_level_ = other.persistence_level_;
+      bdev_type_ = other.bdev_type_;
+      client_mappable_ = other.client_mappable_;
+      numa_node_ = other.numa_node_;
     }
     return *this;
   }
@@ -517,6 +548,7 @@ struct GetTargetInfoTask : public chi::Task {
   OUT chi::u64 bytes_written_;    // Bytes written to target
   OUT chi::u64 ops_read_;         // Read operations
   OUT chi::u64 ops_written_;      // Write operations
+  OUT chimaera::bdev::PerfModel perf_model_;  // Curves fitted by the bdev
 
   // SHM constructor
   GetTargetInfoTask()
@@ -565,7 +597,7 @@ struct GetTargetInfoTask : public chi::Task {
   HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
     Task::SerializeOut(ar);
     ar(target_score_, remaining_space_, bytes_read_, bytes_written_, ops_read_,
-       ops_written_);
+       ops_written_, perf_model_);
   }
 
   /**
@@ -580,6 +612,7 @@ struct GetTargetInfoTask : public chi::Task {
     bytes_written_ = other->bytes_written_;
     ops_read_ = other->ops_read_;
     ops_written_ = other->ops_written_;
+    perf_model_ = other->perf_model_;
   }
 
   /**
@@ -667,35 +700,77 @@ struct TagInfo {
 };
 
 /**
- * Block structure for blob management
- * Each block represents a portion of a blob stored in a target
+ * Extent structure for blob management
+ * Each block is a contiguous byte range of a blob stored on one target. The
+ * target is referenced by its bdev pool id; the bdev client and pool query
+ * are resolved from the registered target table when I/O is issued.
  */
 struct BlobBlock {
-  chimaera::bdev::Client bdev_client_;  // Bdev client for this block's target
-  chi::PoolQuery target_query_;         // Target pool query for bdev API calls
+  chi::PoolId target_id_;   // Bdev pool id of the target holding this block
   chi::u64 target_offset_;  // Offset within target where this block is stored
   chi::u64 size_;           // Size of this block in bytes
 
   HSHM_CROSS_FUN BlobBlock() : target_offset_(0), size_(0) {}
 
-  HSHM_CROSS_FUN BlobBlock(const chimaera::bdev::Client &client,
-                           const chi::PoolQuery &target_query, chi::u64 offset,
+  HSHM_CROSS_FUN BlobBlock(const chi::PoolId &target_id, chi::u64 offset,
                            chi::u64 size)
-      : bdev_client_(client),
-        target_query_(target_query),
-        target_offset_(offset),
-        size_(size) {}
+      : target_id_(target_id), target_offset_(offset), size_(size) {}
+
+  HSHM_CROSS_FUN bool operator==(const BlobBlock &other) const {
+    return target_id_ == other.target_id_ &&
+           target_offset_ == other.target_offset_ && size_ == other.size_;
+  }
+
+  /**
+   * Check whether another block begins exactly where this one ends
+   * @param other Block that would follow this one in the blob
+   * @return true if both blocks live on the same target and are adjacent
+   */
+  HSHM_CROSS_FUN bool IsContiguousWith(const BlobBlock &other) const {
+    return target_id_ == other.target_id_ &&
+           target_offset_ + size_ == other.target_offset_;
+  }
 };
 
+/**
+ * Append a block to a blob's block list, merging it into the last block
+ * when the two are contiguous on the same target
+ * @param blocks Block list (host or GPU vector of BlobBlock)
+ * @param block Block to append
+ */
+template <typename BlockVecT>
+HSHM_CROSS_FUN void AppendBlobBlock(BlockVecT &blocks, const BlobBlock &block) {
+  if (block.size_ == 0) {
+    return;
+  }
+  size_t count = blocks.size();
+  if (count > 0 && blocks[count - 1].IsContiguousWith(block)) {
+    blocks[count - 1].size_ += block.size_;
+    return;
+  }
+  blocks.push_back(block);
+}
+
+/**
+ * Block list of a blob. Nearly every blob has one or two blocks, so two are
+ * stored inline: the common BlobInfo needs no allocation for its layout and
+ * is 144 bytes smaller than with the default eight inline slots.
+ */
+using BlobBlockList = hshm::priv::vector<BlobBlock, CHI_PRIV_ALLOC_T, 2>;
+
 /**
  * Blob information structure with block-based management
  */
 struct BlobInfo {
   chi::priv::string blob_name_;
-  chi::priv::vector<BlobBlock> blocks_;
+  BlobBlockList blocks_;
   float score_;  // 0-1 score for reorganization
   Timestamp last_modified_;
+  chi::u64 version_;  // Bumped by every write of the blob's bytes
   Timestamp last_read_;
+  Timestamp dirty_since_;  // First unflushed write below the flush level
+                           // (0 = clean)
+  Timestamp expire_time_;  // When a TTL frees the blob (0 = never)
   int compress_lib_;     // Compression library ID used for this blob (0 = no
                          // compression)
   int compress_preset_;  // Compression preset used (1=FAST, 2=BALANCED, 3=BEST)
@@ -703,17 +778,45 @@ struct BlobInfo {
       trace_key_;  // Unique trace ID for linking to trace logs (0 = not traced)
   chi::u64 preallocated_size_;  // Total preallocated capacity in bytes
   hshm::Mutex prealloc_lock_;   // Mutex for preallocation
+  chi::priv::string stub_path_;  // Source file of a virtual blob (stub)
+  chi::u64 stub_offset_;         // Byte offset of the blob in stub_path_
+  chi::u64 stub_size_;           // Blob size in the source (0 = not a stub)
+  chi::u32 stub_flags_;          // kBlobStub* flags
+  chi::u32 stub_loading_;        // 1 while a reader faults the stub in
+  chi::u32 erasure_data_;    // Data shards k of an erasure-coded blob (0 = not)
+  chi::u32 erasure_parity_;  // Parity shards m
+  chi::u64 erasure_shard_;   // Bytes per shard; shard i is block bytes
+                             // [i * shard, (i + 1) * shard)
+  chi::u64 erasure_size_;    // Blob size before encoding
+  chi::u32 encrypt_chunk_;   // Plaintext bytes per sealed chunk (0 = not
+                             // encrypted); chunk i is block bytes
+                             // [i * (chunk + overhead), ...)
+  chi::u64 encrypt_size_;    // Blob size before encryption
 
   HSHM_CROSS_FUN BlobInfo()
       : blob_name_(CHI_PRIV_ALLOC),
         blocks_(CHI_PRIV_ALLOC),
         score_(0.0f),
         last_modified_(0),
+        version_(0),
         last_read_(0),
+        dirty_since_(0),
+        expire_time_(0),
         compress_lib_(0),
         compress_preset_(2),
         trace_key_(0),
-        preallocated_size_(0) {
+        preallocated_size_(0),
+        stub_path_(CHI_PRIV_ALLOC),
+        stub_offset_(0),
+        stub_size_(0),
+        stub_flags_(0),
+        stub_loading_(0),
+        erasure_data_(0),
+        erasure_parity_(0),
+        erasure_shard_(0),
+        erasure_size_(0),
+        encrypt_chunk_(0),
+        encrypt_size_(0) {
     prealloc_lock_.Init();
   }
 
@@ -722,11 +825,25 @@ struct BlobInfo {
         blocks_(CHI_PRIV_ALLOC),
         score_(score),
         last_modified_(0),
+        version_(0),
         last_read_(0),
+        dirty_since_(0),
+        expire_time_(0),
         compress_lib_(0),
         compress_preset_(2),
         trace_key_(0),
-        preallocated_size_(0) {
+        preallocated_size_(0),
+        stub_path_(CHI_PRIV_ALLOC),
+        stub_offset_(0),
+        stub_size_(0),
+        stub_flags_(0),
+        stub_loading_(0),
+        erasure_data_(0),
+        erasure_parity_(0),
+        erasure_shard_(0),
+        erasure_size_(0),
+        encrypt_chunk_(0),
+        encrypt_size_(0) {
     prealloc_lock_.Init();
   }
 
@@ -736,11 +853,25 @@ struct BlobInfo {
         blocks_(CHI_PRIV_ALLOC),
         score_(score),
         last_modified_(GetCurrentTimeNs()),
+        version_(0),
         last_read_(GetCurrentTimeNs()),
+        dirty_since_(0),
+        expire_time_(0),
         compress_lib_(0),
         compress_preset_(2),
         trace_key_(0),
-        preallocated_size_(0) {
+        preallocated_size_(0),
+        stub_path_(CHI_PRIV_ALLOC),
+        stub_offset_(0),
+        stub_size_(0),
+        stub_flags_(0),
+        stub_loading_(0),
+        erasure_data_(0),
+        erasure_parity_(0),
+        erasure_shard_(0),
+        erasure_size_(0),
+        encrypt_chunk_(0),
+        encrypt_size_(0) {
     prealloc_lock_.Init();
   }
 #endif
@@ -750,11 +881,25 @@ struct BlobInfo {
         blocks_(other.blocks_),
         score_(other.score_),
         last_modified_(other.last_modified_),
+        version_(other.version_),
         last_read_(other.last_read_),
+        dirty_since_(other.dirty_since_),
+        expire_time_(other.expire_time_),
         compress_lib_(other.compress_lib_),
         compress_preset_(other.compress_preset_),
         trace_key_(other.trace_key_),
-        preallocated_size_(other.preallocated_size_) {
+        preallocated_size_(other.preallocated_size_),
+        stub_path_(other.stub_path_),
+        stub_offset_(other.stub_offset_),
+        stub_size_(other.stub_size_),
+        stub_flags_(other.stub_flags_),
+        stub_loading_(0),
+        erasure_data_(other.erasure_data_),
+        erasure_parity_(other.erasure_parity_),
+        erasure_shard_(other.erasure_shard_),
+        erasure_size_(other.erasure_size_),
+        encrypt_chunk_(other.encrypt_chunk_),
+        encrypt_size_(other.encrypt_size_) {
     prealloc_lock_.Init();
   }
 
@@ -764,15 +909,52 @@ struct BlobInfo {
       blocks_ = other.blocks_;
       score_ = other.score_;
       last_modified_ = other.last_modified_;
+      version_ = other.version_;
       last_read_ = other.last_read_;
+      dirty_since_ = other.dirty_since_;
+      expire_time_ = other.expire_time_;
       compress_lib_ = other.compress_lib_;
       compress_preset_ = other.compress_preset_;
       trace_key_ = other.trace_key_;
       preallocated_size_ = other.preallocated_size_;
+      CopyStub(other);
+      CopyErasureLayout(other);
     }
     return *this;
   }
 
+  /** Take another blob's stub source (none if it is not a stub) */
+  HSHM_CROSS_FUN void CopyStub(const BlobInfo &other) {
+    stub_path_ = other.stub_path_;
+    stub_offset_ = other.stub_offset_;
+    stub_size_ = other.stub_size_;
+    stub_flags_ = other.stub_flags_;
+  }
+
+  /**
+   * Take another blob's coded layout: erasure-code shard counts and sizes,
+   * or the chunking of an encrypted blob
+   */
+  HSHM_CROSS_FUN void CopyErasureLayout(const BlobInfo &other) {
+    erasure_data_ = other.erasure_data_;
+    erasure_parity_ = other.erasure_parity_;
+    erasure_shard_ = other.erasure_shard_;
+    erasure_size_ = other.erasure_size_;
+    encrypt_chunk_ = other.encrypt_chunk_;
+    encrypt_size_ = other.encrypt_size_;
+  }
+
+  /** Forget the coded layout once the blocks are released */
+  HSHM_CROSS_FUN void ClearErasureLayout() {
+    erasure_data_ = 0;
+    erasure_parity_ = 0;
+    erasure_shard_ = 0;
+    erasure_size_ = 0;
+    encrypt_chunk_ = 0;
+    encrypt_size_ = 0;
+  }
+
+  /** Bytes held in target blocks */
   HSHM_CROSS_FUN chi::u64 GetTotalSize() const {
     chi::u64 total = 0;
     for (size_t i = 0; i < blocks_.size(); ++i) {
@@ -780,8 +962,38 @@ struct BlobInfo {
     }
     return total;
   }
+
+  /**
+   * @return true while reads are served from the source file. Cleared only
+   * once a fault-in has written every byte, so blocks that are still being
+   * filled are never read.
+   */
+  HSHM_CROSS_FUN bool IsStub() const { return stub_size_ > 0; }
+
+  /** @return true if blocks_ holds k data shards and m parity shards */
+  HSHM_CROSS_FUN bool IsErasureCoded() const { return erasure_data_ > 0; }
+
+  /** @return true if blocks_ holds AES-GCM sealed chunks */
+  HSHM_CROSS_FUN bool IsEncrypted() const { return encrypt_chunk_ > 0; }
+
+  /**
+   * Size readers see: the source size for a stub, the size before encoding
+   * for an erasure-coded or encrypted blob, else the block total
+   */
+  HSHM_CROSS_FUN chi::u64 GetLogicalSize() const {
+    if (IsStub()) {
+      return stub_size_;
+    }
+    if (IsEncrypted()) {
+      return encrypt_size_;
+    }
+    return IsErasureCoded() ? erasure_size_ : GetTotalSize();
+  }
 };
 
+/** RegisterBlobStub flag: copy the data into a target on the first read */
+GLOBAL_CROSS_CONST chi::u32 kBlobStubCache = 1;
+
 /**
  * Context structure for workflow-aware compression
  * Provides metadata for compression decision-making
@@ -794,10 +1006,13 @@ struct Context {
 
   chi::u64 preallocate_;  // Preallocate this many bytes for GPU block storage
                           // (0 = disabled)
+  chi::u64 ttl_ms_;  // Free the blob this long after the write (0 = the
+                     // tag's TTL, if any)
 
 #if HSHM_ENABLE_COMPRESS
   int dynamic_compress_;  // 0 - skip, 1 - static, 2 - dynamic
-  int compress_lib_;      // The compression library to apply (0-10)
+  int compress_lib_;      // The compression library to apply (0-10 CPU,
+                          // 11-13 nvCOMP GPU)
   int compress_preset_;   // Compression preset: 1=FAST, 2=BALANCED, 3=BEST
                           // (default=2)
   chi::u32 target_psnr_;  // The acceptable PSNR for lossy compression (0 means
@@ -824,7 +1039,8 @@ struct Context {
   HSHM_CROSS_FUN Context()
       : persistence_target_(-1),
         min_persistence_level_(0),
-        preallocate_(0)
+        preallocate_(0),
+        ttl_ms_(0)
 #if HSHM_ENABLE_COMPRESS
         ,
         dynamic_compress_(0),
@@ -849,7 +1065,8 @@ struct Context {
 
   template <class Archive>
   HSHM_CROSS_FUN void serialize(Archive &ar) {
-    ar.range(persistence_target_, min_persistence_level_, preallocate_);
+    ar.range(persistence_target_, min_persistence_level_, preallocate_,
+             ttl_ms_);
 #if HSHM_ENABLE_COMPRESS
     ar.range(dynamic_compress_, compress_lib_, compress_preset_, target_psnr_,
              psnr_chance_, max_performance_, consumer_node_, data_type_,
@@ -864,6 +1081,70 @@ struct Context {
     ctx.preallocate_ = size;
     return ctx;
   }
+
+  HSHM_CROSS_FUN static Context Ttl(chi::u64 ttl_ms) {
+    Context ctx;
+    ctx.ttl_ms_ = ttl_ms;
+    return ctx;
+  }
+};
+
+/**
+ * How the blobs of a tag are spread over containers
+ */
+enum class TagPlacementPolicy : chi::u32 {
+  kHashBlob = 0,    // Hash tag and blob name (default)
+  kHashTag = 1,     // Hash the tag only: every blob on one container
+  kStripe = 2,      // Hash runs of stripe_pages_ numerically named blobs
+  kPinCreator = 3,  // Keep every blob on the creator's local container
+  kFollowTag = 4,   // Place each blob where follow_tag_'s blob of that name is
+};
+
+/**
+ * Placement policy of a tag, chosen in GetOrCreateTag
+ */
+struct TagPlacement {
+  TagPlacementPolicy policy_;
+  chi::u32 stripe_pages_;         // Blobs per stripe for kStripe
+  chi::ContainerId pin_container_;  // Filled in by the creator's node
+  TagId follow_tag_;                // Tag whose placement kFollowTag reuses
+
+  static constexpr chi::ContainerId kNoContainer =
+      static_cast<chi::ContainerId>(-1);
+
+  HSHM_CROSS_FUN TagPlacement()
+      : policy_(TagPlacementPolicy::kHashBlob),
+        stripe_pages_(0),
+        pin_container_(kNoContainer),
+        follow_tag_(TagId::GetNull()) {}
+
+  HSHM_CROSS_FUN explicit TagPlacement(TagPlacementPolicy policy,
+                                       chi::u32 stripe_pages = 0)
+      : policy_(policy),
+        stripe_pages_(stripe_pages),
+        pin_container_(kNoContainer),
+        follow_tag_(TagId::GetNull()) {}
+
+  /**
+   * Placement that puts each blob on the container holding the blob of the
+   * same name in another tag (used by SpliceBlobs to link instead of copy)
+   * @param tag_id Tag to follow
+   */
+  HSHM_CROSS_FUN static TagPlacement Follow(const TagId &tag_id) {
+    TagPlacement placement(TagPlacementPolicy::kFollowTag);
+    placement.follow_tag_ = tag_id;
+    return placement;
+  }
+
+  /** @return true if blobs are placed by the default blob-name hash */
+  HSHM_CROSS_FUN bool IsDefault() const {
+    return policy_ == TagPlacementPolicy::kHashBlob;
+  }
+
+  template <class Archive>
+  HSHM_CROSS_FUN void serialize(Archive &ar) {
+    ar.range(policy_, stripe_pages_, pin_container_, follow_tag_);
+  }
 };
 
 /**
@@ -919,6 +1200,34 @@ struct CteTelemetry {
 #endif
 };
 
+/**
+ * Queueing statistics of one QoS class on a container
+ */
+struct QosClassTelemetry {
+  chi::u32 class_id_;        // 0 = default class, else qos.classes index + 1
+  chi::u64 requests_;        // bdev submissions admitted
+  chi::u64 bytes_;           // Bytes admitted
+  chi::u64 total_wait_ns_;   // Time spent waiting for admission
+  chi::u64 max_wait_ns_;     // Longest single wait
+  chi::u64 queued_;          // Submissions waiting right now
+
+  QosClassTelemetry()
+      : class_id_(0),
+        requests_(0),
+        bytes_(0),
+        total_wait_ns_(0),
+        max_wait_ns_(0),
+        queued_(0) {}
+
+#if HSHM_IS_HOST
+  // Serialization support for cereal
+  template <class Archive>
+  void serialize(Archive &ar) {
+    ar(class_id_, requests_, bytes_, total_wait_ns_, max_wait_ns_, queued_);
+  }
+#endif
+};
+
 /**
  * GetOrCreateTag task - Get or create a tag for blob grouping
  * Template parameter allows different CreateParams types
@@ -927,6 +1236,7 @@ template <typename CreateParamsT = CreateParams>
 struct GetOrCreateTagTask : public chi::Task {
   IN chi::priv::string tag_name_;  // Tag name (required)
   INOUT TagId tag_id_;  // Tag unique ID (default null, output on creation)
+  IN TagPlacement placement_;  // Placement policy (used when first set)
 
   // SHM constructor
   HSHM_CROSS_FUN GetOrCreateTagTask()
@@ -936,10 +1246,12 @@ struct GetOrCreateTagTask : public chi::Task {
   HSHM_CROSS_FUN explicit GetOrCreateTagTask(
       const chi::TaskId &task_id, const chi::PoolId &pool_id,
       const chi::PoolQuery &pool_query, const std::string &tag_name,
-      const TagId &tag_id = TagId::GetNull())
+      const TagId &tag_id = TagId::GetNull(),
+      const TagPlacement &placement = TagPlacement())
       : chi::Task(task_id, pool_id, pool_query, Method::kGetOrCreateTag),
         tag_name_(CHI_PRIV_ALLOC, tag_name),
-        tag_id_(tag_id) {
+        tag_id_(tag_id),
+        placement_(placement) {
     task_id_ = task_id;
     pool_id_ = pool_id;
     method_ = Method::kGetOrCreateTag;
@@ -953,7 +1265,7 @@ struct GetOrCreateTagTask : public chi::Task {
   template <typename Archive>
   HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
     Task::SerializeIn(ar);
-    ar(tag_name_, tag_id_);
+    ar(tag_name_, tag_id_, placement_);
   }
 
   /**
@@ -978,6 +1290,7 @@ struct GetOrCreateTagTask : public chi::Task {
     Task::Copy(other.template Cast<Task>());
     tag_name_ = other->tag_name_;
     tag_id_ = other->tag_id_;
+    placement_ = other->placement_;
   }
 
   /**
@@ -990,6 +1303,12 @@ struct GetOrCreateTagTask : public chi::Task {
   }
 };
 
+/** PutBlob flag: leave an existing blob untouched (used by rebalancing) */
+static constexpr chi::u32 kPutBlobIfAbsent = 0x1;
+
+/** GetBlob flag: serve from this container only, never forward a miss */
+static constexpr chi::u32 kGetBlobNoRedirect = 0x1;
+
 /**
  * PutBlob task - Store a blob with optional compression context
  */
@@ -1003,6 +1322,7 @@ struct PutBlobTask : public chi::Task {
                            // 0.0-1.0=explicit
   INOUT Context context_;  // Context for compression control and statistics
   IN chi::u32 flags_;      // Operation flags
+  IN chi::u32 qos_class_ = 0;  // QoS class (0 = assigned by tag)
 
   // SHM constructor
   // Default score -1.0f means "unknown" - runtime will use 1.0 for new blobs
@@ -1076,7 +1396,7 @@ struct PutBlobTask : public chi::Task {
     ar.PushPod(blob_name_.UsingSso());
     Task::SerializeIn(ar);
     ar(tag_id_, blob_name_, offset_, size_, blob_data_,
-       score_, context_, flags_);
+       score_, context_, flags_, qos_class_);
     ar.PopPod();
     ar.bulk(blob_data_, size_, BULK_XFER);
   }
@@ -1112,6 +1432,7 @@ struct PutBlobTask : public chi::Task {
     score_ = other->score_;
     context_ = other->context_;
     flags_ = other->flags_;
+    qos_class_ = other->qos_class_;
   }
 
   /**
@@ -1124,6 +1445,259 @@ struct PutBlobTask : public chi::Task {
   }
 };
 
+/** Most blobs carried by one PutBlobBatch task (one per warp lane) */
+static constexpr chi::u32 kMaxPutBlobBatch = 32;
+
+/**
+ * One blob write of a PutBlobBatch task. The blob is named by the batch's
+ * name prefix followed by blob_index_ in decimal.
+ */
+struct PutBlobBatchEntry {
+  chi::u64 blob_index_;   // Appended to the batch's name prefix
+  chi::u64 offset_;       // Offset within blob
+  chi::u64 size_;         // Size of blob data
+  hipc::ShmPtr<> data_;   // Blob data (shared memory or absolute address)
+
+  HSHM_CROSS_FUN PutBlobBatchEntry()
+      : blob_index_(0), offset_(0), size_(0),
+        data_(hipc::ShmPtr<>::GetNull()) {}
+
+  template <class Archive>
+  HSHM_CROSS_FUN void serialize(Archive &ar) {
+    ar(blob_index_, offset_, size_, data_);
+  }
+};
+
+/**
+ * PutBlobBatch task - Store up to kMaxPutBlobBatch blobs of one tag with a
+ * single submission. GPU warps fill one of these cooperatively (see
+ * WarpPutBlobBatch) so a warp issues one queue entry instead of one per
+ * lane. The runtime fans the entries out as ordinary PutBlobs.
+ */
+struct PutBlobBatchTask : public chi::Task {
+  IN TagId tag_id_;                      // Tag of every blob in the batch
+  IN chi::priv::string name_prefix_;     // Blob names are prefix + index
+  IN float score_;                       // Placement score for every blob
+  IN chi::u32 flags_;                    // PutBlob flags for every blob
+  IN chi::u32 count_;                    // Valid entries in entries_
+  IN PutBlobBatchEntry entries_[kMaxPutBlobBatch];
+  OUT chi::u32 failed_;                  // Entries whose PutBlob failed
+
+  // SHM constructor
+  HSHM_CROSS_FUN PutBlobBatchTask()
+      : chi::Task(),
+        tag_id_(TagId::GetNull()),
+        name_prefix_(CHI_PRIV_ALLOC),
+        score_(-1.0f),
+        flags_(0),
+        count_(0),
+        failed_(0) {}
+
+  // Emplace constructor (const char* so GPU kernels can build it)
+  HSHM_CROSS_FUN explicit PutBlobBatchTask(const chi::TaskId &task_id,
+                                           const chi::PoolId &pool_id,
+                                           const chi::PoolQuery &pool_query,
+                                           const TagId &tag_id,
+                                           const char *name_prefix,
+                                           float score = -1.0f,
+                                           chi::u32 flags = 0)
+      : chi::Task(task_id, pool_id, pool_query, Method::kPutBlobBatch),
+        tag_id_(tag_id),
+        name_prefix_(CHI_PRIV_ALLOC, name_prefix),
+        score_(score),
+        flags_(flags),
+        count_(0),
+        failed_(0) {
+    task_id_ = task_id;
+    pool_id_ = pool_id;
+    method_ = Method::kPutBlobBatch;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  /** Buffer size that holds any entry name GetBlobName produces */
+  static constexpr int kMaxBlobName = 128;
+
+  /**
+   * Write the name of entry i (prefix + decimal blob index) into buf
+   * @return Name length without the NUL, or -1 if it does not fit
+   */
+  HSHM_CROSS_FUN int GetBlobName(chi::u32 i, char *buf, int buf_size) const {
+    int len = static_cast<int>(name_prefix_.size());
+    if (len + 21 > buf_size) return -1;  // 20 digits + NUL
+    const char *prefix = name_prefix_.data();
+    for (int c = 0; c < len; ++c) buf[c] = prefix[c];
+    len += static_cast<int>(chi::priv::string::NumberToStr(
+        buf + len, buf_size - len, entries_[i].blob_index_));
+    buf[len] = '\0';
+    return len;
+  }
+
+  /**
+   * Append one blob write
+   * @return false if the batch is full
+   */
+  HSHM_CROSS_FUN bool Add(chi::u64 blob_index, chi::u64 offset, chi::u64 size,
+                          hipc::ShmPtr<> data) {
+    if (count_ >= kMaxPutBlobBatch) return false;
+    PutBlobBatchEntry &entry = entries_[count_++];
+    entry.blob_index_ = blob_index;
+    entry.offset_ = offset;
+    entry.size_ = size;
+    entry.data_ = data;
+    return true;
+  }
+
+  /**
+   * Serialize IN and INOUT parameters.
+   */
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    ar.PushPod(name_prefix_.UsingSso());
+    Task::SerializeIn(ar);
+    ar(tag_id_, name_prefix_, score_, flags_, count_);
+    ar.PopPod();
+    if (count_ > kMaxPutBlobBatch) count_ = kMaxPutBlobBatch;
+    for (chi::u32 i = 0; i < count_; ++i) {
+      ar(entries_[i]);
+      ar.bulk(entries_[i].data_, entries_[i].size_, BULK_XFER);
+    }
+  }
+
+  /**
+   * Serialize OUT and INOUT parameters.
+   */
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+    ar(count_, failed_);
+  }
+
+  /** Fix up priv::string SSO pointer after cudaMemcpy D→H */
+  HSHM_CROSS_FUN void FixupAfterCopy() {
+    name_prefix_.FixupSsoPointer();
+  }
+
+  /**
+   * Copy from another PutBlobBatchTask
+   */
+  void Copy(const hipc::FullPtr<PutBlobBatchTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    tag_id_ = other->tag_id_;
+    name_prefix_ = other->name_prefix_;
+    score_ = other->score_;
+    flags_ = other->flags_;
+    count_ = other->count_;
+    for (chi::u32 i = 0; i < count_; ++i) {
+      entries_[i] = other->entries_[i];
+    }
+    failed_ = other->failed_;
+  }
+
+  /**
+   * Aggregate replica results into this task
+   * @param other Pointer to the replica task to aggregate from
+   */
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    Copy(other_base.template Cast<PutBlobBatchTask>());
+  }
+};
+
+/**
+ * AppendBlob task - Atomically append data to the end of a tag.
+ * The tag is treated as a byte stream split into chunk_size_ blobs named by
+ * decimal chunk index (the filesystem adapter page layout). The container
+ * owning the tag's append cursor reserves [offset_, offset_ + size_) and
+ * writes the covered chunks, so concurrent appenders never overlap.
+ */
+struct AppendBlobTask : public chi::Task {
+  IN TagId tag_id_;              // Tag to append to
+  IN chi::u64 size_;             // Size of data to append
+  IN chi::u64 chunk_size_;       // Size of each chunk blob of the tag
+  IN hipc::ShmPtr<> blob_data_;  // Data to append (shared memory pointer)
+  IN float score_;               // Placement score, -1.0 = use defaults
+  IN Context context_;           // Context for compression control
+  OUT chi::u64 offset_;          // Tag offset reserved for the data
+
+  // SHM constructor
+  HSHM_CROSS_FUN AppendBlobTask()
+      : chi::Task(),
+        tag_id_(TagId::GetNull()),
+        size_(0),
+        chunk_size_(0),
+        blob_data_(hipc::ShmPtr<>::GetNull()),
+        score_(-1.0f),
+        context_(),
+        offset_(0) {}
+
+  // Emplace constructor
+  HSHM_CROSS_FUN explicit AppendBlobTask(const chi::TaskId &task_id,
+                                         const chi::PoolId &pool_id,
+                                         const chi::PoolQuery &pool_query,
+                                         const TagId &tag_id, chi::u64 size,
+                                         chi::u64 chunk_size,
+                                         hipc::ShmPtr<> blob_data, float score,
+                                         const Context &context)
+      : chi::Task(task_id, pool_id, pool_query, Method::kAppendBlob),
+        tag_id_(tag_id),
+        size_(size),
+        chunk_size_(chunk_size),
+        blob_data_(blob_data),
+        score_(score),
+        context_(context),
+        offset_(0) {
+    task_id_ = task_id;
+    pool_id_ = pool_id;
+    method_ = Method::kAppendBlob;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  /**
+   * Serialize IN and INOUT parameters.
+   */
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+    ar(tag_id_, size_, chunk_size_, blob_data_, score_, context_);
+    ar.bulk(blob_data_, size_, BULK_XFER);
+  }
+
+  /**
+   * Serialize OUT and INOUT parameters.
+   */
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+    ar(offset_);
+  }
+
+  /**
+   * Copy from another AppendBlobTask
+   */
+  void Copy(const hipc::FullPtr<AppendBlobTask> &other) {
+    // Copy base Task fields
+    Task::Copy(other.template Cast<Task>());
+    tag_id_ = other->tag_id_;
+    size_ = other->size_;
+    chunk_size_ = other->chunk_size_;
+    blob_data_ = other->blob_data_;
+    score_ = other->score_;
+    context_ = other->context_;
+    offset_ = other->offset_;
+  }
+
+  /**
+   * Aggregate replica results into this task
+   * @param other_base Pointer to the replica task to aggregate from
+   */
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    Copy(other_base.template Cast<AppendBlobTask>());
+  }
+};
+
 /**
  * GetBlob task - Retrieve a blob (unimplemented for now)
  */
@@ -1135,6 +1709,7 @@ struct GetBlobTask : public chi::Task {
   IN chi::u32 flags_;               // Operation flags
   IN hipc::ShmPtr<>
       blob_data_;  // Input buffer for blob data (shared memory pointer)
+  IN chi::u32 qos_class_ = 0;  // QoS class (0 = assigned by tag)
 
   // SHM constructor
   HSHM_CROSS_FUN GetBlobTask()
@@ -1197,7 +1772,7 @@ struct GetBlobTask : public chi::Task {
   HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
     ar.PushPod(blob_name_.UsingSso());
     Task::SerializeIn(ar);
-    ar(tag_id_, blob_name_, offset_, size_, flags_, blob_data_);
+    ar(tag_id_, blob_name_, offset_, size_, flags_, blob_data_, qos_class_);
     ar.PopPod();
     ar.bulk(blob_data_, size_, BULK_EXPOSE);
   }
@@ -1228,6 +1803,7 @@ struct GetBlobTask : public chi::Task {
     size_ = other->size_;
     flags_ = other->flags_;
     blob_data_ = other->blob_data_;
+    qos_class_ = other->qos_class_;
   }
 
   /**
@@ -1378,42 +1954,130 @@ struct DelBlobTask : public chi::Task {
 };
 
 /**
- * DelTag task - Remove all blobs from tag and remove tag
- * Supports lookup by either tag ID or tag name
+ * RegisterBlobStub task - Register a virtual blob whose bytes stay in a
+ * source file until the first GetBlob faults them in
  */
-struct DelTagTask : public chi::Task {
-  INOUT TagId tag_id_;             // Tag ID to delete (input or lookup result)
-  IN chi::priv::string tag_name_;  // Tag name for lookup (optional)
+struct RegisterBlobStubTask : public chi::Task {
+  IN TagId tag_id_;                   // Tag the blob belongs to
+  IN chi::priv::string blob_name_;    // Blob name (required)
+  IN chi::priv::string source_path_;  // File holding the blob's bytes
+  IN chi::u64 source_offset_;         // Byte offset of the blob in the file
+  IN chi::u64 size_;                  // Blob size in bytes
+  IN float score_;                    // Score used if the stub is cached
+  IN chi::u32 stub_flags_;            // kBlobStub* flags
 
   // SHM constructor
-  DelTagTask()
-      : chi::Task(), tag_id_(TagId::GetNull()), tag_name_(CHI_PRIV_ALLOC) {}
+  RegisterBlobStubTask()
+      : chi::Task(),
+        tag_id_(TagId::GetNull()),
+        blob_name_(CHI_PRIV_ALLOC),
+        source_path_(CHI_PRIV_ALLOC),
+        source_offset_(0),
+        size_(0),
+        score_(1.0f),
+        stub_flags_(0) {}
 
-  // Emplace constructor with tag ID
-  HSHM_CROSS_FUN explicit DelTagTask(const chi::TaskId &task_id,
-                                     const chi::PoolId &pool_id,
-                                     const chi::PoolQuery &pool_query,
-                                     const TagId &tag_id)
-      : chi::Task(task_id, pool_id, pool_query, Method::kDelTag),
+  // Emplace constructor
+  HSHM_CROSS_FUN explicit RegisterBlobStubTask(
+      const chi::TaskId &task_id, const chi::PoolId &pool_id,
+      const chi::PoolQuery &pool_query, const TagId &tag_id,
+      const std::string &blob_name, const std::string &source_path,
+      chi::u64 source_offset, chi::u64 size, float score, chi::u32 stub_flags)
+      : chi::Task(task_id, pool_id, pool_query, Method::kRegisterBlobStub),
         tag_id_(tag_id),
-        tag_name_(CHI_PRIV_ALLOC) {
+        blob_name_(CHI_PRIV_ALLOC, blob_name),
+        source_path_(CHI_PRIV_ALLOC, source_path),
+        source_offset_(source_offset),
+        size_(size),
+        score_(score),
+        stub_flags_(stub_flags) {
     task_id_ = task_id;
     pool_id_ = pool_id;
-    method_ = Method::kDelTag;
+    method_ = Method::kRegisterBlobStub;
     task_flags_.Clear();
     pool_query_ = pool_query;
   }
 
-  // Emplace constructor with tag name
-  HSHM_CROSS_FUN explicit DelTagTask(const chi::TaskId &task_id,
-                                     const chi::PoolId &pool_id,
-                                     const chi::PoolQuery &pool_query,
-                                     const std::string &tag_name)
-      : chi::Task(task_id, pool_id, pool_query, Method::kDelTag),
-        tag_id_(TagId::GetNull()),
-        tag_name_(CHI_PRIV_ALLOC, tag_name) {
-    task_id_ = task_id;
-    pool_id_ = pool_id;
+  /**
+   * Serialize IN and INOUT parameters
+   */
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+    ar(tag_id_, blob_name_, source_path_, source_offset_, size_, score_,
+       stub_flags_);
+  }
+
+  /**
+   * Serialize OUT and INOUT parameters
+   */
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+    // No output parameters (return_code_ handled by base class)
+  }
+
+  /**
+   * Copy from another RegisterBlobStubTask
+   */
+  void Copy(const hipc::FullPtr<RegisterBlobStubTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    tag_id_ = other->tag_id_;
+    blob_name_ = other->blob_name_;
+    source_path_ = other->source_path_;
+    source_offset_ = other->source_offset_;
+    size_ = other->size_;
+    score_ = other->score_;
+    stub_flags_ = other->stub_flags_;
+  }
+
+  /**
+   * Aggregate replica results into this task
+   * @param other Pointer to the replica task to aggregate from
+   */
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    Copy(other_base.template Cast<RegisterBlobStubTask>());
+  }
+};
+
+/**
+ * DelTag task - Remove all blobs from tag and remove tag
+ * Supports lookup by either tag ID or tag name
+ */
+struct DelTagTask : public chi::Task {
+  INOUT TagId tag_id_;             // Tag ID to delete (input or lookup result)
+  IN chi::priv::string tag_name_;  // Tag name for lookup (optional)
+
+  // SHM constructor
+  DelTagTask()
+      : chi::Task(), tag_id_(TagId::GetNull()), tag_name_(CHI_PRIV_ALLOC) {}
+
+  // Emplace constructor with tag ID
+  HSHM_CROSS_FUN explicit DelTagTask(const chi::TaskId &task_id,
+                                     const chi::PoolId &pool_id,
+                                     const chi::PoolQuery &pool_query,
+                                     const TagId &tag_id)
+      : chi::Task(task_id, pool_id, pool_query, Method::kDelTag),
+        tag_id_(tag_id),
+        tag_name_(CHI_PRIV_ALLOC) {
+    task_id_ = task_id;
+    pool_id_ = pool_id;
+    method_ = Method::kDelTag;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  // Emplace constructor with tag name
+  HSHM_CROSS_FUN explicit DelTagTask(const chi::TaskId &task_id,
+                                     const chi::PoolId &pool_id,
+                                     const chi::PoolQuery &pool_query,
+                                     const std::string &tag_name)
+      : chi::Task(task_id, pool_id, pool_query, Method::kDelTag),
+        tag_id_(TagId::GetNull()),
+        tag_name_(CHI_PRIV_ALLOC, tag_name) {
+    task_id_ = task_id;
+    pool_id_ = pool_id;
     method_ = Method::kDelTag;
     task_flags_.Clear();
     pool_query_ = pool_query;
@@ -1528,13 +2192,15 @@ struct PollTelemetryLogTask : public chi::Task {
   IN std::uint64_t minimum_logical_time_;        // Minimum logical time filter
   OUT std::uint64_t last_logical_time_;          // Last logical time scanned
   OUT chi::priv::vector<CteTelemetry> entries_;  // Retrieved telemetry entries
+  OUT chi::priv::vector<QosClassTelemetry> qos_classes_;  // Queueing per class
 
   // SHM constructor
   PollTelemetryLogTask()
       : chi::Task(),
         minimum_logical_time_(0),
         last_logical_time_(0),
-        entries_(CHI_PRIV_ALLOC) {}
+        entries_(CHI_PRIV_ALLOC),
+        qos_classes_(CHI_PRIV_ALLOC) {}
 
   // Emplace constructor
   HSHM_CROSS_FUN explicit PollTelemetryLogTask(
@@ -1543,7 +2209,8 @@ struct PollTelemetryLogTask : public chi::Task {
       : chi::Task(task_id, pool_id, pool_query, Method::kPollTelemetryLog),
         minimum_logical_time_(minimum_logical_time),
         last_logical_time_(0),
-        entries_(CHI_PRIV_ALLOC) {
+        entries_(CHI_PRIV_ALLOC),
+        qos_classes_(CHI_PRIV_ALLOC) {
     task_id_ = task_id;
     pool_id_ = pool_id;
     method_ = Method::kPollTelemetryLog;
@@ -1566,7 +2233,7 @@ struct PollTelemetryLogTask : public chi::Task {
   template <typename Archive>
   HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
     Task::SerializeOut(ar);
-    ar(last_logical_time_, entries_);
+    ar(last_logical_time_, entries_, qos_classes_);
   }
 
   /**
@@ -1578,6 +2245,7 @@ struct PollTelemetryLogTask : public chi::Task {
     minimum_logical_time_ = other->minimum_logical_time_;
     last_logical_time_ = other->last_logical_time_;
     entries_ = other->entries_;
+    qos_classes_ = other->qos_classes_;
   }
 
   /**
@@ -1993,14 +2661,23 @@ struct TagQueryTask : public chi::Task {
  *   limit.
  * - Returns a vector of pairs where each pair contains (tag_name, blob_name)
  *   for blobs matching the query.
- * - total_blobs_matched_ sums the total number of blobs that matched across
- *   replicas during Aggregate.
+ * - Results are ordered by (tag_name, blob_name). Each container stops
+ *   scanning once it holds max_blobs_ results, and Aggregate merges replicas
+ *   in order, so the union is the first max_blobs_ matches cluster-wide.
+ * - Pagination: results start strictly after the (cursor_tag_, cursor_blob_)
+ *   pair (empty = from the beginning). When has_more_ is set, pass the last
+ *   returned pair back as the cursor to fetch the next page.
+ * - total_blobs_matched_ sums the matches each replica examined. It is the
+ *   full match count only when has_more_ is false.
  */
 struct BlobQueryTask : public chi::Task {
   IN chi::priv::string tag_regex_;
   IN chi::priv::string blob_regex_;
   IN chi::u32 max_blobs_;
+  IN chi::priv::string cursor_tag_;
+  IN chi::priv::string cursor_blob_;
   OUT chi::u64 total_blobs_matched_;
+  OUT bool has_more_;
   OUT std::vector<std::string> tag_names_;
   OUT std::vector<std::string> blob_names_;
 
@@ -2010,7 +2687,10 @@ struct BlobQueryTask : public chi::Task {
         tag_regex_(CHI_PRIV_ALLOC),
         blob_regex_(CHI_PRIV_ALLOC),
         max_blobs_(0),
-        total_blobs_matched_(0) {}
+        cursor_tag_(CHI_PRIV_ALLOC),
+        cursor_blob_(CHI_PRIV_ALLOC),
+        total_blobs_matched_(0),
+        has_more_(false) {}
 
   // Emplace constructor
   HSHM_CROSS_FUN explicit BlobQueryTask(const chi::TaskId &task_id,
@@ -2018,12 +2698,17 @@ struct BlobQueryTask : public chi::Task {
                                         const chi::PoolQuery &pool_query,
                                         const std::string &tag_regex,
                                         const std::string &blob_regex,
-                                        chi::u32 max_blobs = 0)
+                                        chi::u32 max_blobs = 0,
+                                        const std::string &cursor_tag = "",
+                                        const std::string &cursor_blob = "")
       : chi::Task(task_id, pool_id, pool_query, Method::kBlobQuery),
         tag_regex_(CHI_PRIV_ALLOC, tag_regex),
         blob_regex_(CHI_PRIV_ALLOC, blob_regex),
         max_blobs_(max_blobs),
-        total_blobs_matched_(0) {
+        cursor_tag_(CHI_PRIV_ALLOC, cursor_tag),
+        cursor_blob_(CHI_PRIV_ALLOC, cursor_blob),
+        total_blobs_matched_(0),
+        has_more_(false) {
     task_id_ = task_id;
     pool_id_ = pool_id;
     method_ = Method::kBlobQuery;
@@ -2037,7 +2722,7 @@ struct BlobQueryTask : public chi::Task {
   template <typename Archive>
   HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
     Task::SerializeIn(ar);
-    ar(tag_regex_, blob_regex_, max_blobs_);
+    ar(tag_regex_, blob_regex_, max_blobs_, cursor_tag_, cursor_blob_);
   }
 
   /**
@@ -2046,7 +2731,7 @@ struct BlobQueryTask : public chi::Task {
   template <typename Archive>
   HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
     Task::SerializeOut(ar);
-    ar(total_blobs_matched_, tag_names_, blob_names_);
+    ar(total_blobs_matched_, has_more_, tag_names_, blob_names_);
   }
 
   /**
@@ -2058,7 +2743,10 @@ struct BlobQueryTask : public chi::Task {
     tag_regex_ = other->tag_regex_;
     blob_regex_ = other->blob_regex_;
     max_blobs_ = other->max_blobs_;
+    cursor_tag_ = other->cursor_tag_;
+    cursor_blob_ = other->cursor_blob_;
     total_blobs_matched_ = other->total_blobs_matched_;
+    has_more_ = other->has_more_;
     tag_names_ = other->tag_names_;
     blob_names_ = other->blob_names_;
   }
@@ -2071,15 +2759,39 @@ struct BlobQueryTask : public chi::Task {
     auto other = other_base.template Cast<BlobQueryTask>();
     // Sum total matched blobs across replicas
     total_blobs_matched_ += other->total_blobs_matched_;
-
-    // Append results up to max_blobs_ (if non-zero)
-    for (size_t i = 0; i < other->tag_names_.size(); ++i) {
-      if (max_blobs_ != 0 &&
-          tag_names_.size() >= static_cast<size_t>(max_blobs_))
-        break;
-      tag_names_.push_back(other->tag_names_[i]);
-      blob_names_.push_back(other->blob_names_[i]);
+    has_more_ = has_more_ || other->has_more_;
+
+    // Merge the two (tag_name, blob_name)-ordered lists, keeping the first
+    // max_blobs_ (if non-zero) so pagination stays globally ordered
+    size_t limit = max_blobs_ == 0 ? static_cast<size_t>(-1)
+                                   : static_cast<size_t>(max_blobs_);
+    std::vector<std::string> tags, blobs;
+    size_t total = tag_names_.size() + other->tag_names_.size();
+    tags.reserve(std::min(total, limit));
+    blobs.reserve(std::min(total, limit));
+    size_t a = 0, b = 0;
+    while ((a < tag_names_.size() || b < other->tag_names_.size()) &&
+           tags.size() < limit) {
+      bool take_other =
+          a >= tag_names_.size() ||
+          (b < other->tag_names_.size() &&
+           std::tie(other->tag_names_[b], other->blob_names_[b]) <
+               std::tie(tag_names_[a], blob_names_[a]));
+      if (take_other) {
+        tags.push_back(std::move(other->tag_names_[b]));
+        blobs.push_back(std::move(other->blob_names_[b]));
+        ++b;
+      } else {
+        tags.push_back(std::move(tag_names_[a]));
+        blobs.push_back(std::move(blob_names_[a]));
+        ++a;
+      }
     }
+    if (tags.size() < total) {
+      has_more_ = true;
+    }
+    tag_names_.swap(tags);
+    blob_names_.swap(blobs);
   }
 };
 
@@ -2129,33 +2841,188 @@ struct FlushMetadataTask : public chi::Task {
 };
 
 /**
- * FlushDataTask - Periodic task to flush data from volatile to non-volatile
- * targets
+ * CommitTransactionLogsTask - Periodic group commit of the records buffered
+ * in the write-ahead logs (one write and fdatasync per log)
  */
-struct FlushDataTask : public chi::Task {
-  IN int target_persistence_level_;
-  OUT chi::u64 bytes_flushed_;
-  OUT chi::u64 blobs_flushed_;
+struct CommitTransactionLogsTask : public chi::Task {
+  OUT chi::u32 logs_committed_;
 
   /** SHM default constructor */
-  FlushDataTask()
+  CommitTransactionLogsTask() : chi::Task(), logs_committed_(0) {}
+
+  /** Emplace constructor */
+  HSHM_CROSS_FUN explicit CommitTransactionLogsTask(
+      const chi::TaskId &task_node, const chi::PoolId &pool_id,
+      const chi::PoolQuery &pool_query)
+      : chi::Task(task_node, pool_id, pool_query,
+                  Method::kCommitTransactionLogs),
+        logs_committed_(0) {
+    task_id_ = task_node;
+    pool_id_ = pool_id;
+    method_ = Method::kCommitTransactionLogs;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+    ar(logs_committed_);
+  }
+
+  void Copy(const hipc::FullPtr<CommitTransactionLogsTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    logs_committed_ = other->logs_committed_;
+  }
+
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    Copy(other_base.template Cast<CommitTransactionLogsTask>());
+  }
+};
+
+/**
+ * SetTagReplicationTask - Set how many containers hold each blob of a tag.
+ * Broadcast so that every container routes and replicates the same way.
+ */
+struct SetTagReplicationTask : public chi::Task {
+  IN TagId tag_id_;
+  IN chi::u32 replicas_;
+
+  /** SHM default constructor */
+  SetTagReplicationTask()
+      : chi::Task(), tag_id_(TagId::GetNull()), replicas_(1) {}
+
+  /** Emplace constructor */
+  HSHM_CROSS_FUN explicit SetTagReplicationTask(
+      const chi::TaskId &task_node, const chi::PoolId &pool_id,
+      const chi::PoolQuery &pool_query, const TagId &tag_id,
+      chi::u32 replicas)
+      : chi::Task(task_node, pool_id, pool_query, Method::kSetTagReplication),
+        tag_id_(tag_id),
+        replicas_(replicas) {
+    task_id_ = task_node;
+    pool_id_ = pool_id;
+    method_ = Method::kSetTagReplication;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+    ar(tag_id_, replicas_);
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+  }
+
+  void Copy(const hipc::FullPtr<SetTagReplicationTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    tag_id_ = other->tag_id_;
+    replicas_ = other->replicas_;
+  }
+
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    Copy(other_base.template Cast<SetTagReplicationTask>());
+  }
+};
+
+/**
+ * SetTagPlacementTask - Set how the blobs of a tag are spread over
+ * containers. Broadcast by the tag's canonical container so that every
+ * container routes the tag's blobs the same way.
+ */
+struct SetTagPlacementTask : public chi::Task {
+  IN TagId tag_id_;
+  IN TagPlacement placement_;
+
+  /** SHM default constructor */
+  SetTagPlacementTask() : chi::Task(), tag_id_(TagId::GetNull()) {}
+
+  /** Emplace constructor */
+  HSHM_CROSS_FUN explicit SetTagPlacementTask(
+      const chi::TaskId &task_node, const chi::PoolId &pool_id,
+      const chi::PoolQuery &pool_query, const TagId &tag_id,
+      const TagPlacement &placement)
+      : chi::Task(task_node, pool_id, pool_query, Method::kSetTagPlacement),
+        tag_id_(tag_id),
+        placement_(placement) {
+    task_id_ = task_node;
+    pool_id_ = pool_id;
+    method_ = Method::kSetTagPlacement;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+    ar(tag_id_, placement_);
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+  }
+
+  void Copy(const hipc::FullPtr<SetTagPlacementTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    tag_id_ = other->tag_id_;
+    placement_ = other->placement_;
+  }
+
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    Copy(other_base.template Cast<SetTagPlacementTask>());
+  }
+};
+
+/**
+ * SpliceBlobsTask - Link the blobs of one tag that match a pattern into
+ * another tag. Broadcast: each container links the blobs it holds by
+ * sharing their blocks, and copies those whose new name it does not own.
+ */
+struct SpliceBlobsTask : public chi::Task {
+  IN TagId src_tag_id_;
+  IN chi::priv::string blob_regex_;
+  IN TagId dst_tag_id_;
+  OUT chi::u64 blobs_linked_;
+  OUT chi::u64 blobs_copied_;
+
+  /** SHM default constructor */
+  SpliceBlobsTask()
       : chi::Task(),
-        target_persistence_level_(1),
-        bytes_flushed_(0),
-        blobs_flushed_(0) {}
+        src_tag_id_(TagId::GetNull()),
+        blob_regex_(CHI_PRIV_ALLOC),
+        dst_tag_id_(TagId::GetNull()),
+        blobs_linked_(0),
+        blobs_copied_(0) {}
 
   /** Emplace constructor */
-  HSHM_CROSS_FUN explicit FlushDataTask(const chi::TaskId &task_node,
-                                        const chi::PoolId &pool_id,
-                                        const chi::PoolQuery &pool_query,
-                                        int target_persistence_level = 1)
-      : chi::Task(task_node, pool_id, pool_query, Method::kFlushData),
-        target_persistence_level_(target_persistence_level),
-        bytes_flushed_(0),
-        blobs_flushed_(0) {
+  HSHM_CROSS_FUN explicit SpliceBlobsTask(const chi::TaskId &task_node,
+                                          const chi::PoolId &pool_id,
+                                          const chi::PoolQuery &pool_query,
+                                          const TagId &src_tag_id,
+                                          const std::string &blob_regex,
+                                          const TagId &dst_tag_id)
+      : chi::Task(task_node, pool_id, pool_query, Method::kSpliceBlobs),
+        src_tag_id_(src_tag_id),
+        blob_regex_(CHI_PRIV_ALLOC, blob_regex),
+        dst_tag_id_(dst_tag_id),
+        blobs_linked_(0),
+        blobs_copied_(0) {
     task_id_ = task_node;
     pool_id_ = pool_id;
-    method_ = Method::kFlushData;
+    method_ = Method::kSpliceBlobs;
     task_flags_.Clear();
     pool_query_ = pool_query;
   }
@@ -2163,25 +3030,1005 @@ struct FlushDataTask : public chi::Task {
   template <typename Archive>
   HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
     Task::SerializeIn(ar);
-    ar(target_persistence_level_);
+    ar(src_tag_id_, blob_regex_, dst_tag_id_);
   }
 
   template <typename Archive>
   HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
     Task::SerializeOut(ar);
-    ar(bytes_flushed_, blobs_flushed_);
+    ar(blobs_linked_, blobs_copied_);
   }
 
-  void Copy(const hipc::FullPtr<FlushDataTask> &other) {
+  void Copy(const hipc::FullPtr<SpliceBlobsTask> &other) {
     Task::Copy(other.template Cast<Task>());
-    target_persistence_level_ = other->target_persistence_level_;
-    bytes_flushed_ = other->bytes_flushed_;
-    blobs_flushed_ = other->blobs_flushed_;
+    src_tag_id_ = other->src_tag_id_;
+    blob_regex_ = other->blob_regex_;
+    dst_tag_id_ = other->dst_tag_id_;
+    blobs_linked_ = other->blobs_linked_;
+    blobs_copied_ = other->blobs_copied_;
   }
 
+  /** Sum the counts of every container */
   void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
     Task::Aggregate(other_base);
-    Copy(other_base.template Cast<FlushDataTask>());
+    auto other = other_base.template Cast<SpliceBlobsTask>();
+    blobs_linked_ += other->blobs_linked_;
+    blobs_copied_ += other->blobs_copied_;
+  }
+};
+
+/**
+ * SetTagDedupTask - Turn content deduplication of a tag's blobs on or off.
+ * Broadcast so that every container, replicas included, chunks the tag's
+ * writes the same way.
+ */
+struct SetTagDedupTask : public chi::Task {
+  IN TagId tag_id_;
+  IN chi::u64 chunk_size_;  // Bytes per fingerprinted chunk (0 = off)
+
+  /** SHM default constructor */
+  SetTagDedupTask()
+      : chi::Task(), tag_id_(TagId::GetNull()), chunk_size_(0) {}
+
+  /** Emplace constructor */
+  HSHM_CROSS_FUN explicit SetTagDedupTask(const chi::TaskId &task_node,
+                                          const chi::PoolId &pool_id,
+                                          const chi::PoolQuery &pool_query,
+                                          const TagId &tag_id,
+                                          chi::u64 chunk_size)
+      : chi::Task(task_node, pool_id, pool_query, Method::kSetTagDedup),
+        tag_id_(tag_id),
+        chunk_size_(chunk_size) {
+    task_id_ = task_node;
+    pool_id_ = pool_id;
+    method_ = Method::kSetTagDedup;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+    ar(tag_id_, chunk_size_);
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+  }
+
+  void Copy(const hipc::FullPtr<SetTagDedupTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    tag_id_ = other->tag_id_;
+    chunk_size_ = other->chunk_size_;
+  }
+
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    Copy(other_base.template Cast<SetTagDedupTask>());
+  }
+};
+
+/**
+ * SetTagErasureTask - Store a tag's blobs as k data shards plus m parity
+ * shards on distinct targets instead of whole copies. Broadcast so that
+ * every container encodes the tag's writes the same way.
+ */
+struct SetTagErasureTask : public chi::Task {
+  IN TagId tag_id_;
+  IN chi::u32 data_shards_;    // k (0 = off)
+  IN chi::u32 parity_shards_;  // m
+
+  /** SHM default constructor */
+  SetTagErasureTask()
+      : chi::Task(),
+        tag_id_(TagId::GetNull()),
+        data_shards_(0),
+        parity_shards_(0) {}
+
+  /** Emplace constructor */
+  HSHM_CROSS_FUN explicit SetTagErasureTask(const chi::TaskId &task_node,
+                                            const chi::PoolId &pool_id,
+                                            const chi::PoolQuery &pool_query,
+                                            const TagId &tag_id,
+                                            chi::u32 data_shards,
+                                            chi::u32 parity_shards)
+      : chi::Task(task_node, pool_id, pool_query, Method::kSetTagErasure),
+        tag_id_(tag_id),
+        data_shards_(data_shards),
+        parity_shards_(parity_shards) {
+    task_id_ = task_node;
+    pool_id_ = pool_id;
+    method_ = Method::kSetTagErasure;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+    ar(tag_id_, data_shards_, parity_shards_);
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+  }
+
+  void Copy(const hipc::FullPtr<SetTagErasureTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    tag_id_ = other->tag_id_;
+    data_shards_ = other->data_shards_;
+    parity_shards_ = other->parity_shards_;
+  }
+
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    Copy(other_base.template Cast<SetTagErasureTask>());
+  }
+};
+
+/**
+ * RepairReplicasTask - Re-copy blobs of replicated tags to replica
+ * containers that no longer hold them, and rebuild erasure-code shards whose
+ * target was unregistered or whose node died. A pass only scans when the
+ * pool's container-to-node map changed since the previous pass (or, for
+ * shards, a target was unregistered), unless forced.
+ */
+struct RepairReplicasTask : public chi::Task {
+  IN bool force_;
+  OUT chi::u64 blobs_repaired_;
+  OUT chi::u64 bytes_repaired_;
+
+  /** SHM default constructor */
+  RepairReplicasTask()
+      : chi::Task(), force_(false), blobs_repaired_(0), bytes_repaired_(0) {}
+
+  /** Emplace constructor */
+  HSHM_CROSS_FUN explicit RepairReplicasTask(const chi::TaskId &task_node,
+                                             const chi::PoolId &pool_id,
+                                             const chi::PoolQuery &pool_query,
+                                             bool force = false)
+      : chi::Task(task_node, pool_id, pool_query, Method::kRepairReplicas),
+        force_(force),
+        blobs_repaired_(0),
+        bytes_repaired_(0) {
+    task_id_ = task_node;
+    pool_id_ = pool_id;
+    method_ = Method::kRepairReplicas;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+    ar(force_);
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+    ar(blobs_repaired_, bytes_repaired_);
+  }
+
+  void Copy(const hipc::FullPtr<RepairReplicasTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    force_ = other->force_;
+    blobs_repaired_ = other->blobs_repaired_;
+    bytes_repaired_ = other->bytes_repaired_;
+  }
+
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    auto other = other_base.template Cast<RepairReplicasTask>();
+    blobs_repaired_ += other->blobs_repaired_;
+    bytes_repaired_ += other->bytes_repaired_;
+  }
+};
+
+/**
+ * SetPlacementWeightsTask - Install a weighted consistent-hash ring for
+ * blob placement. Broadcast so that every container routes the same way.
+ * Empty weights restore plain modulo hashing.
+ */
+struct SetPlacementWeightsTask : public chi::Task {
+  IN std::vector<chi::u32> weights_;  // Weight per container ID
+  IN chi::u32 vnodes_;  // Virtual nodes per unit of weight
+
+  /** SHM default constructor */
+  SetPlacementWeightsTask() : chi::Task(), vnodes_(0) {}
+
+  /** Emplace constructor */
+  HSHM_CROSS_FUN explicit SetPlacementWeightsTask(
+      const chi::TaskId &task_node, const chi::PoolId &pool_id,
+      const chi::PoolQuery &pool_query, const std::vector<chi::u32> &weights,
+      chi::u32 vnodes)
+      : chi::Task(task_node, pool_id, pool_query,
+                  Method::kSetPlacementWeights),
+        weights_(weights),
+        vnodes_(vnodes) {
+    task_id_ = task_node;
+    pool_id_ = pool_id;
+    method_ = Method::kSetPlacementWeights;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+    ar(weights_, vnodes_);
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+  }
+
+  void Copy(const hipc::FullPtr<SetPlacementWeightsTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    weights_ = other->weights_;
+    vnodes_ = other->vnodes_;
+  }
+
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    Copy(other_base.template Cast<SetPlacementWeightsTask>());
+  }
+};
+
+/**
+ * RebalanceBlobsTask - Move local blobs whose placement owner changed after
+ * SetPlacementWeights to their new owner, at most max_blobs_ per pass
+ */
+struct RebalanceBlobsTask : public chi::Task {
+  IN chi::u32 max_blobs_;
+  OUT chi::u64 blobs_moved_;
+  OUT chi::u64 bytes_moved_;
+
+  /** SHM default constructor */
+  RebalanceBlobsTask()
+      : chi::Task(), max_blobs_(256), blobs_moved_(0), bytes_moved_(0) {}
+
+  /** Emplace constructor */
+  HSHM_CROSS_FUN explicit RebalanceBlobsTask(const chi::TaskId &task_node,
+                                             const chi::PoolId &pool_id,
+                                             const chi::PoolQuery &pool_query,
+                                             chi::u32 max_blobs = 256)
+      : chi::Task(task_node, pool_id, pool_query, Method::kRebalanceBlobs),
+        max_blobs_(max_blobs),
+        blobs_moved_(0),
+        bytes_moved_(0) {
+    task_id_ = task_node;
+    pool_id_ = pool_id;
+    method_ = Method::kRebalanceBlobs;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+    ar(max_blobs_);
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+    ar(blobs_moved_, bytes_moved_);
+  }
+
+  void Copy(const hipc::FullPtr<RebalanceBlobsTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    max_blobs_ = other->max_blobs_;
+    blobs_moved_ = other->blobs_moved_;
+    bytes_moved_ = other->bytes_moved_;
+  }
+
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    auto other = other_base.template Cast<RebalanceBlobsTask>();
+    blobs_moved_ += other->blobs_moved_;
+    bytes_moved_ += other->bytes_moved_;
+  }
+};
+
+/**
+ * FlushDataTask - Periodic task to flush data from volatile to non-volatile
+ * targets
+ */
+struct FlushDataTask : public chi::Task {
+  IN int target_persistence_level_;
+  IN chi::u32 max_inflight_;
+  OUT chi::u64 bytes_flushed_;
+  OUT chi::u64 blobs_flushed_;
+
+  /** SHM default constructor */
+  FlushDataTask()
+      : chi::Task(),
+        target_persistence_level_(1),
+        max_inflight_(8),
+        bytes_flushed_(0),
+        blobs_flushed_(0) {}
+
+  /** Emplace constructor */
+  HSHM_CROSS_FUN explicit FlushDataTask(const chi::TaskId &task_node,
+                                        const chi::PoolId &pool_id,
+                                        const chi::PoolQuery &pool_query,
+                                        int target_persistence_level = 1,
+                                        chi::u32 max_inflight = 8)
+      : chi::Task(task_node, pool_id, pool_query, Method::kFlushData),
+        target_persistence_level_(target_persistence_level),
+        max_inflight_(max_inflight),
+        bytes_flushed_(0),
+        blobs_flushed_(0) {
+    task_id_ = task_node;
+    pool_id_ = pool_id;
+    method_ = Method::kFlushData;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+    ar(target_persistence_level_, max_inflight_);
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+    ar(bytes_flushed_, blobs_flushed_);
+  }
+
+  void Copy(const hipc::FullPtr<FlushDataTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    target_persistence_level_ = other->target_persistence_level_;
+    max_inflight_ = other->max_inflight_;
+    bytes_flushed_ = other->bytes_flushed_;
+    blobs_flushed_ = other->blobs_flushed_;
+  }
+
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    Copy(other_base.template Cast<FlushDataTask>());
+  }
+};
+
+/**
+ * DefragBlobs task - Rewrite fragmented blobs into fewer, contiguous blocks.
+ * Blobs whose block list has at least min_blocks_ entries are copied into a
+ * fresh allocation and their old blocks are freed.
+ */
+struct DefragBlobsTask : public chi::Task {
+  IN chi::u32 min_blocks_;
+  OUT chi::u64 blobs_defragmented_;
+  OUT chi::u64 bytes_moved_;
+
+  /** SHM default constructor */
+  DefragBlobsTask()
+      : chi::Task(),
+        min_blocks_(16),
+        blobs_defragmented_(0),
+        bytes_moved_(0) {}
+
+  /** Emplace constructor */
+  HSHM_CROSS_FUN explicit DefragBlobsTask(const chi::TaskId &task_node,
+                                          const chi::PoolId &pool_id,
+                                          const chi::PoolQuery &pool_query,
+                                          chi::u32 min_blocks = 16)
+      : chi::Task(task_node, pool_id, pool_query, Method::kDefragBlobs),
+        min_blocks_(min_blocks),
+        blobs_defragmented_(0),
+        bytes_moved_(0) {
+    task_id_ = task_node;
+    pool_id_ = pool_id;
+    method_ = Method::kDefragBlobs;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+    ar(min_blocks_);
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+    ar(blobs_defragmented_, bytes_moved_);
+  }
+
+  void Copy(const hipc::FullPtr<DefragBlobsTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    min_blocks_ = other->min_blocks_;
+    blobs_defragmented_ = other->blobs_defragmented_;
+    bytes_moved_ = other->bytes_moved_;
+  }
+
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    Copy(other_base.template Cast<DefragBlobsTask>());
+  }
+};
+
+/**
+ * MigrateBlobs task - Move blobs between storage tiers by access heat.
+ * Each blob's heat decays with half_life_ms_ and grows with its reads. Blobs
+ * at or above promote_heat_ move to the fastest tier, blobs at or below
+ * demote_heat_ to the slowest, moving at most bandwidth_mbps_ MB/s overall.
+ */
+struct MigrateBlobsTask : public chi::Task {
+  IN chi::u32 bandwidth_mbps_;
+  IN chi::u32 half_life_ms_;
+  IN float promote_heat_;
+  IN float demote_heat_;
+  OUT chi::u64 blobs_promoted_;
+  OUT chi::u64 blobs_demoted_;
+  OUT chi::u64 bytes_moved_;
+
+  /** SHM default constructor */
+  MigrateBlobsTask()
+      : chi::Task(),
+        bandwidth_mbps_(64),
+        half_life_ms_(60000),
+        promote_heat_(4.0f),
+        demote_heat_(0.25f),
+        blobs_promoted_(0),
+        blobs_demoted_(0),
+        bytes_moved_(0) {}
+
+  /** Emplace constructor */
+  HSHM_CROSS_FUN explicit MigrateBlobsTask(const chi::TaskId &task_node,
+                                           const chi::PoolId &pool_id,
+                                           const chi::PoolQuery &pool_query,
+                                           chi::u32 bandwidth_mbps = 64,
+                                           chi::u32 half_life_ms = 60000,
+                                           float promote_heat = 4.0f,
+                                           float demote_heat = 0.25f)
+      : chi::Task(task_node, pool_id, pool_query, Method::kMigrateBlobs),
+        bandwidth_mbps_(bandwidth_mbps),
+        half_life_ms_(half_life_ms),
+        promote_heat_(promote_heat),
+        demote_heat_(demote_heat),
+        blobs_promoted_(0),
+        blobs_demoted_(0),
+        bytes_moved_(0) {
+    task_id_ = task_node;
+    pool_id_ = pool_id;
+    method_ = Method::kMigrateBlobs;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+    ar(bandwidth_mbps_, half_life_ms_, promote_heat_, demote_heat_);
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+    ar(blobs_promoted_, blobs_demoted_, bytes_moved_);
+  }
+
+  void Copy(const hipc::FullPtr<MigrateBlobsTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    bandwidth_mbps_ = other->bandwidth_mbps_;
+    half_life_ms_ = other->half_life_ms_;
+    promote_heat_ = other->promote_heat_;
+    demote_heat_ = other->demote_heat_;
+    blobs_promoted_ = other->blobs_promoted_;
+    blobs_demoted_ = other->blobs_demoted_;
+    bytes_moved_ = other->bytes_moved_;
+  }
+
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    Copy(other_base.template Cast<MigrateBlobsTask>());
+  }
+};
+
+/**
+ * EvictTargets task - Relieve capacity pressure on the fast tiers.
+ * Every target outside the slowest tier whose used fraction exceeds
+ * high_watermark_ has blobs demoted to the next lower tier, in the order of
+ * the configured eviction policy, until it is at or below low_watermark_.
+ */
+struct EvictTargetsTask : public chi::Task {
+  IN float high_watermark_;
+  IN float low_watermark_;
+  OUT chi::u64 blobs_evicted_;
+  OUT chi::u64 bytes_evicted_;
+
+  /** SHM default constructor */
+  EvictTargetsTask()
+      : chi::Task(),
+        high_watermark_(0.9f),
+        low_watermark_(0.75f),
+        blobs_evicted_(0),
+        bytes_evicted_(0) {}
+
+  /** Emplace constructor */
+  HSHM_CROSS_FUN explicit EvictTargetsTask(const chi::TaskId &task_node,
+                                           const chi::PoolId &pool_id,
+                                           const chi::PoolQuery &pool_query,
+                                           float high_watermark = 0.9f,
+                                           float low_watermark = 0.75f)
+      : chi::Task(task_node, pool_id, pool_query, Method::kEvictTargets),
+        high_watermark_(high_watermark),
+        low_watermark_(low_watermark),
+        blobs_evicted_(0),
+        bytes_evicted_(0) {
+    task_id_ = task_node;
+    pool_id_ = pool_id;
+    method_ = Method::kEvictTargets;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+    ar(high_watermark_, low_watermark_);
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+    ar(blobs_evicted_, bytes_evicted_);
+  }
+
+  void Copy(const hipc::FullPtr<EvictTargetsTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    high_watermark_ = other->high_watermark_;
+    low_watermark_ = other->low_watermark_;
+    blobs_evicted_ = other->blobs_evicted_;
+    bytes_evicted_ = other->bytes_evicted_;
+  }
+
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    Copy(other_base.template Cast<EvictTargetsTask>());
+  }
+};
+
+/**
+ * SetTagTtlTask - Give a tag's blobs a time to live. Broadcast so that every
+ * container, replicas included, stamps the tag's writes the same way.
+ */
+struct SetTagTtlTask : public chi::Task {
+  IN TagId tag_id_;
+  IN chi::u64 ttl_ms_;  // Lifetime of each write in milliseconds (0 = off)
+
+  /** SHM default constructor */
+  SetTagTtlTask() : chi::Task(), tag_id_(TagId::GetNull()), ttl_ms_(0) {}
+
+  /** Emplace constructor */
+  HSHM_CROSS_FUN explicit SetTagTtlTask(const chi::TaskId &task_node,
+                                        const chi::PoolId &pool_id,
+                                        const chi::PoolQuery &pool_query,
+                                        const TagId &tag_id, chi::u64 ttl_ms)
+      : chi::Task(task_node, pool_id, pool_query, Method::kSetTagTtl),
+        tag_id_(tag_id),
+        ttl_ms_(ttl_ms) {
+    task_id_ = task_node;
+    pool_id_ = pool_id;
+    method_ = Method::kSetTagTtl;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+    ar(tag_id_, ttl_ms_);
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+  }
+
+  void Copy(const hipc::FullPtr<SetTagTtlTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    tag_id_ = other->tag_id_;
+    ttl_ms_ = other->ttl_ms_;
+  }
+
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    Copy(other_base.template Cast<SetTagTtlTask>());
+  }
+};
+
+/**
+ * ExpireBlobs task - Free the blobs whose TTL has run out.
+ * Deadlines are kept in a timer wheel, so a pass only looks at the blobs
+ * that came due since the previous one.
+ */
+struct ExpireBlobsTask : public chi::Task {
+  OUT chi::u64 blobs_expired_;
+  OUT chi::u64 bytes_expired_;
+
+  /** SHM default constructor */
+  ExpireBlobsTask() : chi::Task(), blobs_expired_(0), bytes_expired_(0) {}
+
+  /** Emplace constructor */
+  HSHM_CROSS_FUN explicit ExpireBlobsTask(const chi::TaskId &task_node,
+                                          const chi::PoolId &pool_id,
+                                          const chi::PoolQuery &pool_query)
+      : chi::Task(task_node, pool_id, pool_query, Method::kExpireBlobs),
+        blobs_expired_(0),
+        bytes_expired_(0) {
+    task_id_ = task_node;
+    pool_id_ = pool_id;
+    method_ = Method::kExpireBlobs;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+    ar(blobs_expired_, bytes_expired_);
+  }
+
+  void Copy(const hipc::FullPtr<ExpireBlobsTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    blobs_expired_ = other->blobs_expired_;
+    bytes_expired_ = other->bytes_expired_;
+  }
+
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    Copy(other_base.template Cast<ExpireBlobsTask>());
+  }
+};
+
+/**
+ * ReserveBlob task - Allocate a blob's capacity up front, so that later
+ * chunked writes land in place without per-chunk allocation
+ */
+struct ReserveBlobTask : public chi::Task {
+  IN TagId tag_id_;                 // Tag the blob belongs to
+  IN chi::priv::string blob_name_;  // Blob name (required)
+  IN chi::u64 size_;                // Capacity to reserve in bytes
+  IN float score_;                  // Placement score (-1 keeps the blob's)
+
+  /** SHM default constructor */
+  ReserveBlobTask()
+      : chi::Task(),
+        tag_id_(TagId::GetNull()),
+        blob_name_(CHI_PRIV_ALLOC),
+        size_(0),
+        score_(-1.0f) {}
+
+  /** Emplace constructor */
+  HSHM_CROSS_FUN explicit ReserveBlobTask(const chi::TaskId &task_node,
+                                          const chi::PoolId &pool_id,
+                                          const chi::PoolQuery &pool_query,
+                                          const TagId &tag_id,
+                                          const std::string &blob_name,
+                                          chi::u64 size, float score)
+      : chi::Task(task_node, pool_id, pool_query, Method::kReserveBlob),
+        tag_id_(tag_id),
+        blob_name_(CHI_PRIV_ALLOC, blob_name),
+        size_(size),
+        score_(score) {
+    task_id_ = task_node;
+    pool_id_ = pool_id;
+    method_ = Method::kReserveBlob;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+    ar(tag_id_, blob_name_, size_, score_);
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+  }
+
+  void Copy(const hipc::FullPtr<ReserveBlobTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    tag_id_ = other->tag_id_;
+    blob_name_ = other->blob_name_;
+    size_ = other->size_;
+    score_ = other->score_;
+  }
+
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    Copy(other_base.template Cast<ReserveBlobTask>());
+  }
+};
+
+/**
+ * GetOrCreateTags task - Resolve many tag names in one round trip. The
+ * container that receives it looks each name up where GetOrCreateTag
+ * would, keeping the lookups in flight together.
+ */
+struct GetOrCreateTagsTask : public chi::Task {
+  IN std::vector<std::string> tag_names_;  // Tags to open or create
+  IN TagPlacement placement_;              // Placement used by new tags
+  OUT std::vector<TagId> tag_ids_;  // IDs in tag_names_ order (null = failed)
+
+  /** SHM default constructor */
+  GetOrCreateTagsTask() : chi::Task() {}
+
+  /** Emplace constructor */
+  HSHM_CROSS_FUN explicit GetOrCreateTagsTask(
+      const chi::TaskId &task_node, const chi::PoolId &pool_id,
+      const chi::PoolQuery &pool_query,
+      const std::vector<std::string> &tag_names,
+      const TagPlacement &placement = TagPlacement())
+      : chi::Task(task_node, pool_id, pool_query, Method::kGetOrCreateTags),
+        tag_names_(tag_names),
+        placement_(placement) {
+    task_id_ = task_node;
+    pool_id_ = pool_id;
+    method_ = Method::kGetOrCreateTags;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+    ar(tag_names_, placement_);
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+    ar(tag_ids_);
+  }
+
+  void Copy(const hipc::FullPtr<GetOrCreateTagsTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    tag_names_ = other->tag_names_;
+    placement_ = other->placement_;
+    tag_ids_ = other->tag_ids_;
+  }
+
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    Copy(other_base.template Cast<GetOrCreateTagsTask>());
+  }
+};
+
+/**
+ * SetTagEncryptionTask - Store a tag's blobs as AES-256-GCM sealed chunks
+ * under the runtime's key. Broadcast so that every container seals the
+ * tag's writes the same way.
+ */
+struct SetTagEncryptionTask : public chi::Task {
+  IN TagId tag_id_;
+  IN chi::u32 chunk_size_;  // Plaintext bytes per sealed chunk (0 = off)
+
+  /** SHM default constructor */
+  SetTagEncryptionTask()
+      : chi::Task(), tag_id_(TagId::GetNull()), chunk_size_(0) {}
+
+  /** Emplace constructor */
+  HSHM_CROSS_FUN explicit SetTagEncryptionTask(
+      const chi::TaskId &task_node, const chi::PoolId &pool_id,
+      const chi::PoolQuery &pool_query, const TagId &tag_id,
+      chi::u32 chunk_size)
+      : chi::Task(task_node, pool_id, pool_query, Method::kSetTagEncryption),
+        tag_id_(tag_id),
+        chunk_size_(chunk_size) {
+    task_id_ = task_node;
+    pool_id_ = pool_id;
+    method_ = Method::kSetTagEncryption;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+    ar(tag_id_, chunk_size_);
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+  }
+
+  void Copy(const hipc::FullPtr<SetTagEncryptionTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    tag_id_ = other->tag_id_;
+    chunk_size_ = other->chunk_size_;
+  }
+
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    Copy(other_base.template Cast<SetTagEncryptionTask>());
+  }
+};
+
+/**
+ * One piece of a blob view: bytes of a RAM target's buffer that a local
+ * client reads through its own read-only mapping of the target
+ */
+struct BlobViewExtent {
+  chi::PoolId target_id_;   // Bdev pool id of the target
+  chi::u64 target_offset_;  // Offset of the piece in the target's buffer
+  chi::u64 size_;           // Bytes of the view in this piece
+  chi::u64 segment_size_;   // Bytes of the target's buffer to map
+
+  BlobViewExtent() : target_offset_(0), size_(0), segment_size_(0) {}
+  BlobViewExtent(const chi::PoolId &target_id, chi::u64 target_offset,
+                 chi::u64 size, chi::u64 segment_size)
+      : target_id_(target_id),
+        target_offset_(target_offset),
+        size_(size),
+        segment_size_(segment_size) {}
+
+  template <typename Archive>
+  void serialize(Archive &ar) {
+    chi::u64 pool_id_u64 = target_id_.IsNull() ? 0 : target_id_.ToU64();
+    ar(pool_id_u64, target_offset_, size_, segment_size_);
+    target_id_ = chi::PoolId::FromU64(pool_id_u64);
+  }
+};
+
+/**
+ * GetBlobView task - Pin the blocks of a blob range on RAM targets and
+ * return where they sit, so that a client on the same node reads them in
+ * place. The blocks stay valid until ReleaseBlobView or until the lease
+ * runs out; writes meanwhile go to new blocks. Return codes: 1 no such
+ * blob or range, 2 client on another node, 3 range not viewable (not on
+ * mappable RAM targets, or stored encoded).
+ */
+struct GetBlobViewTask : public chi::Task {
+  IN TagId tag_id_;                 // Tag ID for blob lookup
+  IN chi::priv::string blob_name_;  // Blob name (required)
+  IN chi::u64 offset_;              // Offset within blob
+  IN chi::u64 size_;                // Bytes to view (0 = to the end)
+  IN chi::u32 client_node_;         // Node of the client that maps the view
+  OUT chi::u64 lease_id_;           // Handle for ReleaseBlobView
+  OUT chi::u64 lease_ms_;           // Lease length in milliseconds
+  OUT std::vector<BlobViewExtent> extents_;  // Pieces in blob order
+
+  /** SHM default constructor */
+  GetBlobViewTask()
+      : chi::Task(),
+        tag_id_(TagId::GetNull()),
+        blob_name_(CHI_PRIV_ALLOC),
+        offset_(0),
+        size_(0),
+        client_node_(0),
+        lease_id_(0),
+        lease_ms_(0) {}
+
+  /** Emplace constructor */
+  HSHM_CROSS_FUN explicit GetBlobViewTask(const chi::TaskId &task_node,
+                                          const chi::PoolId &pool_id,
+                                          const chi::PoolQuery &pool_query,
+                                          const TagId &tag_id,
+                                          const std::string &blob_name,
+                                          chi::u64 offset, chi::u64 size,
+                                          chi::u32 client_node)
+      : chi::Task(task_node, pool_id, pool_query, Method::kGetBlobView),
+        tag_id_(tag_id),
+        blob_name_(CHI_PRIV_ALLOC, blob_name),
+        offset_(offset),
+        size_(size),
+        client_node_(client_node),
+        lease_id_(0),
+        lease_ms_(0) {
+    task_id_ = task_node;
+    pool_id_ = pool_id;
+    method_ = Method::kGetBlobView;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+    ar(tag_id_, blob_name_, offset_, size_, client_node_);
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+    ar(lease_id_, lease_ms_, extents_);
+  }
+
+  void Copy(const hipc::FullPtr<GetBlobViewTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    tag_id_ = other->tag_id_;
+    blob_name_ = other->blob_name_;
+    offset_ = other->offset_;
+    size_ = other->size_;
+    client_node_ = other->client_node_;
+    lease_id_ = other->lease_id_;
+    lease_ms_ = other->lease_ms_;
+    extents_ = other->extents_;
+  }
+
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    Copy(other_base.template Cast<GetBlobViewTask>());
+  }
+};
+
+/**
+ * ReleaseBlobView task - Unpin the blocks of a view. Routed like the blob
+ * so that it reaches the container holding the lease.
+ */
+struct ReleaseBlobViewTask : public chi::Task {
+  IN TagId tag_id_;                 // Tag of the viewed blob
+  IN chi::priv::string blob_name_;  // Viewed blob
+  IN chi::u64 lease_id_;            // Lease from GetBlobView
+  OUT bool expired_;                // The lease had already run out
+
+  /** SHM default constructor */
+  ReleaseBlobViewTask()
+      : chi::Task(),
+        tag_id_(TagId::GetNull()),
+        blob_name_(CHI_PRIV_ALLOC),
+        lease_id_(0),
+        expired_(false) {}
+
+  /** Emplace constructor */
+  HSHM_CROSS_FUN explicit ReleaseBlobViewTask(const chi::TaskId &task_node,
+                                              const chi::PoolId &pool_id,
+                                              const chi::PoolQuery &pool_query,
+                                              const TagId &tag_id,
+                                              const std::string &blob_name,
+                                              chi::u64 lease_id)
+      : chi::Task(task_node, pool_id, pool_query, Method::kReleaseBlobView),
+        tag_id_(tag_id),
+        blob_name_(CHI_PRIV_ALLOC, blob_name),
+        lease_id_(lease_id),
+        expired_(false) {
+    task_id_ = task_node;
+    pool_id_ = pool_id;
+    method_ = Method::kReleaseBlobView;
+    task_flags_.Clear();
+    pool_query_ = pool_query;
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeIn(Archive &ar) {
+    Task::SerializeIn(ar);
+    ar(tag_id_, blob_name_, lease_id_);
+  }
+
+  template <typename Archive>
+  HSHM_CROSS_FUN void SerializeOut(Archive &ar) {
+    Task::SerializeOut(ar);
+    ar(expired_);
+  }
+
+  void Copy(const hipc::FullPtr<ReleaseBlobViewTask> &other) {
+    Task::Copy(other.template Cast<Task>());
+    tag_id_ = other->tag_id_;
+    blob_name_ = other->blob_name_;
+    lease_id_ = other->lease_id_;
+    expired_ = other->expired_;
+  }
+
+  void Aggregate(const hipc::FullPtr<chi::Task> &other_base) {
+    Task::Aggregate(other_base);
+    Copy(other_base.template Cast<ReleaseBlobViewTask>());
   }
 };
 
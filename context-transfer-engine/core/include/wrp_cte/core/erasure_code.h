@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef WRPCTE_CORE_ERASURE_CODE_H_
+#define WRPCTE_CORE_ERASURE_CODE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace wrp_cte::core {
+
+/**
+ * Systematic Reed-Solomon code over GF(2^8).
+ *
+ * A blob is split into k data shards and m parity shards of equal size. The
+ * data shards hold the blob bytes unchanged and parity shard i is
+ * sum_j C[i][j] * data_j, where C is the Cauchy matrix 1 / ((k + i) ^ j).
+ * Every k x k submatrix of [I; C] is invertible, so any k of the k + m
+ * shards rebuild the others. Multiplication by a constant uses 4-bit
+ * lookup tables so the inner loop is one byte shuffle per 16 or 32 bytes.
+ */
+class ErasureCode {
+ public:
+  /** Largest k + m the field allows */
+  static constexpr size_t kMaxShards = 256;
+
+  /**
+   * @param data_shards Data shards per blob (k >= 1)
+   * @param parity_shards Parity shards per blob (m >= 1, k + m <= 256)
+   */
+  ErasureCode(size_t data_shards, size_t parity_shards)
+      : k_(data_shards), m_(parity_shards), parity_rows_(m_ * k_) {
+    for (size_t i = 0; i < m_; ++i) {
+      for (size_t j = 0; j < k_; ++j) {
+        parity_rows_[i * k_ + j] =
+            Inv(static_cast<uint8_t>((k_ + i) ^ j));
+      }
+    }
+  }
+
+  /** @return Data shards per blob */
+  size_t DataShards() const { return k_; }
+
+  /** @return Parity shards per blob */
+  size_t ParityShards() const { return m_; }
+
+  /**
+   * Size of each shard for a blob of a given size
+   * @param size Blob size in bytes
+   * @param data_shards Data shards per blob
+   * @return Bytes per shard; the last data shard is zero-padded
+   */
+  static size_t ShardSize(size_t size, size_t data_shards) {
+    return (size + data_shards - 1) / data_shards;
+  }
+
+  /**
+   * Compute the parity shards
+   * @param data k pointers to len-byte data shards
+   * @param parity m pointers to len-byte outputs
+   * @param len Shard size in bytes
+   */
+  void Encode(const uint8_t *const *data, uint8_t *const *parity,
+              size_t len) const {
+    for (size_t i = 0; i < m_; ++i) {
+      std::memset(parity[i], 0, len);
+      for (size_t j = 0; j < k_; ++j) {
+        MulAdd(parity_rows_[i * k_ + j], data[j], parity[i], len);
+      }
+    }
+  }
+
+  /**
+   * Rebuild missing shards in place
+   * @param shards k + m pointers to len-byte shards, data first; the
+   *        buffers of missing shards are overwritten
+   * @param present Which shards hold valid bytes (k + m entries)
+   * @param len Shard size in bytes
+   * @param data_only Skip rebuilding missing parity shards (reads)
+   * @return false if fewer than k shards are present
+   */
+  bool Reconstruct(uint8_t *const *shards, const std::vector<bool> &present,
+                   size_t len, bool data_only = false) const {
+    std::vector<size_t> rows;
+    bool data_missing = false;
+    for (size_t r = 0; r < k_ + m_ && rows.size() < k_; ++r) {
+      if (present[r]) {
+        rows.push_back(r);
+      }
+    }
+    if (rows.size() < k_) {
+      return false;
+    }
+    for (size_t j = 0; j < k_; ++j) {
+      data_missing |= !present[j];
+    }
+    if (data_missing) {
+      // Decode matrix: invert the rows of [I; C] for the shards we have
+      std::vector<uint8_t> sub(k_ * k_, 0);
+      for (size_t r = 0; r < k_; ++r) {
+        for (size_t j = 0; j < k_; ++j) {
+          sub[r * k_ + j] = rows[r] < k_ ? (rows[r] == j ? 1 : 0)
+                                         : parity_rows_[(rows[r] - k_) * k_ + j];
+        }
+      }
+      std::vector<uint8_t> inv;
+      if (!Invert(sub, inv)) {
+        return false;
+      }
+      for (size_t j = 0; j < k_; ++j) {
+        if (present[j]) {
+          continue;
+        }
+        std::memset(shards[j], 0, len);
+        for (size_t r = 0; r < k_; ++r) {
+          MulAdd(inv[j * k_ + r], shards[rows[r]], shards[j], len);
+        }
+      }
+    }
+    for (size_t i = 0; i < m_ && !data_only; ++i) {
+      if (present[k_ + i]) {
+        continue;
+      }
+      std::memset(shards[k_ + i], 0, len);
+      for (size_t j = 0; j < k_; ++j) {
+        MulAdd(parity_rows_[i * k_ + j], shards[j], shards[k_ + i], len);
+      }
+    }
+    return true;
+  }
+
+  /** Product of two field elements */
+  static uint8_t Mul(uint8_t a, uint8_t b) {
+    if (a == 0 || b == 0) {
+      return 0;
+    }
+    const Tables &t = GetTables();
+    return t.exp_[t.log_[a] + t.log_[b]];
+  }
+
+  /** Multiplicative inverse of a nonzero field element */
+  static uint8_t Inv(uint8_t a) {
+    const Tables &t = GetTables();
+    return t.exp_[255 - t.log_[a]];
+  }
+
+ private:
+  /** Log and antilog tables for the field polynomial x^8+x^4+x^3+x^2+1 */
+  struct Tables {
+    std::array<uint8_t, 512> exp_{};
+    std::array<uint8_t, 256> log_{};
+    Tables() {
+      unsigned x = 1;
+      for (unsigned i = 0; i < 255; ++i) {
+        exp_[i] = static_cast<uint8_t>(x);
+        log_[x] = static_cast<uint8_t>(i);
+        x <<= 1;
+        if (x & 0x100) {
+          x ^= 0x11d;
+        }
+      }
+      for (unsigned i = 255; i < 512; ++i) {
+        exp_[i] = exp_[i - 255];
+      }
+    }
+  };
+
+  static const Tables &GetTables() {
+    static const Tables tables;
+    return tables;
+  }
+
+  /** dst ^= c * src over len bytes */
+  static void MulAdd(uint8_t c, const uint8_t *src, uint8_t *dst,
+                     size_t len) {
+    if (c == 0) {
+      return;
+    }
+    size_t i = 0;
+    if (c == 1) {
+      for (; i < len; ++i) {
+        dst[i] ^= src[i];
+      }
+      return;
+    }
+    // c * x = c * (x & 0xf) ^ c * (x & 0xf0), each a 16-entry lookup
+    alignas(16) uint8_t lo[16];
+    alignas(16) uint8_t hi[16];
+    for (unsigned n = 0; n < 16; ++n) {
+      lo[n] = Mul(c, static_cast<uint8_t>(n));
+      hi[n] = Mul(c, static_cast<uint8_t>(n << 4));
+    }
+#if defined(__AVX2__) || defined(__AVX512F__)
+    const __m256i vlo = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i *>(lo)));
+    const __m256i vhi = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i *>(hi)));
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+    for (; i + 32 <= len; i += 32) {
+      __m256i x =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+      __m256i p = _mm256_xor_si256(
+          _mm256_shuffle_epi8(vlo, _mm256_and_si256(x, mask)),
+          _mm256_shuffle_epi8(
+              vhi, _mm256_and_si256(_mm256_srli_epi16(x, 4), mask)));
+      __m256i d = _mm256_loadu_si256(reinterpret_cast<__m256i *>(dst + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i),
+                          _mm256_xor_si256(d, p));
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    const uint8x16_t vlo = vld1q_u8(lo);
+    const uint8x16_t vhi = vld1q_u8(hi);
+    const uint8x16_t mask = vdupq_n_u8(0x0f);
+    for (; i + 16 <= len; i += 16) {
+      uint8x16_t x = vld1q_u8(src + i);
+      uint8x16_t p = veorq_u8(vqtbl1q_u8(vlo, vandq_u8(x, mask)),
+                              vqtbl1q_u8(vhi, vshrq_n_u8(x, 4)));
+      vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), p));
+    }
+#endif
+    for (; i < len; ++i) {
+      dst[i] ^= static_cast<uint8_t>(lo[src[i] & 0x0f] ^ hi[src[i] >> 4]);
+    }
+  }
+
+  /** Gauss-Jordan inverse of an n x n matrix; false if singular */
+  bool Invert(std::vector<uint8_t> a, std::vector<uint8_t> &inv) const {
+    size_t n = k_;
+    inv.assign(n * n, 0);
+    for (size_t i = 0; i < n; ++i) {
+      inv[i * n + i] = 1;
+    }
+    for (size_t col = 0; col < n; ++col) {
+      size_t pivot = col;
+      while (pivot < n && a[pivot * n + col] == 0) {
+        ++pivot;
+      }
+      if (pivot == n) {
+        return false;
+      }
+      if (pivot != col) {
+        for (size_t j = 0; j < n; ++j) {
+          std::swap(a[pivot * n + j], a[col * n + j]);
+          std::swap(inv[pivot * n + j], inv[col * n + j]);
+        }
+      }
+      uint8_t scale = Inv(a[col * n + col]);
+      for (size_t j = 0; j < n; ++j) {
+        a[col * n + j] = Mul(a[col * n + j], scale);
+        inv[col * n + j] = Mul(inv[col * n + j], scale);
+      }
+      for (size_t r = 0; r < n; ++r) {
+        uint8_t f = a[r * n + col];
+        if (r == col || f == 0) {
+          continue;
+        }
+        for (size_t j = 0; j < n; ++j) {
+          a[r * n + j] ^= Mul(f, a[col * n + j]);
+          inv[r * n + j] ^= Mul(f, inv[col * n + j]);
+        }
+      }
+    }
+    return true;
+  }
+
+  size_t k_;
+  size_t m_;
+  std::vector<uint8_t> parity_rows_;
+};
+
+}  // namespace wrp_cte::core
+
+#endif  // WRPCTE_CORE_ERASURE_CODE_H_
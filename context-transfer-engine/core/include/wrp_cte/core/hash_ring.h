@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef WRPCTE_CORE_HASH_RING_H_
+#define WRPCTE_CORE_HASH_RING_H_
+
+#include <chimaera/chimaera.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace wrp_cte::core {
+
+/**
+ * Weighted consistent-hash ring mapping blob hashes to containers.
+ *
+ * Each container owns a number of virtual nodes proportional to its weight.
+ * A hash belongs to the first virtual node at or after it on the ring, so
+ * changing one container's weight only moves the hashes next to the
+ * virtual nodes it gains or loses. A container with weight 0 owns nothing.
+ */
+class HashRing {
+ public:
+  HashRing() = default;
+
+  /** Upper bound on virtual nodes per container, whatever its weight */
+  static constexpr chi::u32 kMaxPointsPerContainer = 1u << 16;
+
+  /**
+   * Build a ring. Points are positioned by (container, index) only, so
+   * raising one weight adds points for that container alone and only keys
+   * next to those points move to it.
+   * @param weights Weight of each container, indexed by container ID
+   * @param vnodes Virtual nodes per unit of weight
+   */
+  HashRing(const std::vector<chi::u32> &weights, chi::u32 vnodes)
+      : weights_(weights), vnodes_(vnodes) {
+    for (chi::ContainerId id = 0; id < weights.size(); ++id) {
+      uint64_t count = std::min<uint64_t>(
+          static_cast<uint64_t>(vnodes) * weights[id], kMaxPointsPerContainer);
+      for (chi::u32 v = 0; v < count; ++v) {
+        points_.emplace_back(PointHash(id, v), id);
+      }
+    }
+    std::sort(points_.begin(), points_.end());
+  }
+
+  /** @return true if no container has a positive weight */
+  bool Empty() const { return points_.empty(); }
+
+  /** @return Container weights the ring was built from */
+  const std::vector<chi::u32> &GetWeights() const { return weights_; }
+
+  /** @return Virtual nodes per unit of weight */
+  chi::u32 GetVnodes() const { return vnodes_; }
+
+  /**
+   * Find the container owning a hash
+   * @param hash Blob hash (see Runtime::HashBlobKey)
+   * @return Owning container ID (the ring must not be empty)
+   */
+  chi::ContainerId Lookup(chi::u32 hash) const {
+    return points_[FirstPoint(hash)].second;
+  }
+
+  /**
+   * Find the first count distinct containers clockwise from a hash; the
+   * first is the owner and the rest are natural replica locations
+   * @param hash Blob hash
+   * @param count Containers wanted
+   * @return Up to count distinct container IDs, owner first
+   */
+  std::vector<chi::ContainerId> Successors(chi::u32 hash,
+                                           size_t count) const {
+    std::vector<chi::ContainerId> ids;
+    if (points_.empty()) {
+      return ids;
+    }
+    size_t start = FirstPoint(hash);
+    for (size_t i = 0; i < points_.size() && ids.size() < count; ++i) {
+      chi::ContainerId id = points_[(start + i) % points_.size()].second;
+      if (std::find(ids.begin(), ids.end(), id) == ids.end()) {
+        ids.push_back(id);
+      }
+    }
+    return ids;
+  }
+
+ private:
+  /** Index of the first virtual node at or after hash (wrapping) */
+  size_t FirstPoint(chi::u32 hash) const {
+    auto it = std::lower_bound(
+        points_.begin(), points_.end(), hash,
+        [](const std::pair<chi::u32, chi::ContainerId> &point,
+           chi::u32 value) { return point.first < value; });
+    return it == points_.end() ? 0 : static_cast<size_t>(it - points_.begin());
+  }
+
+  /** Position of virtual node v of a container (murmur3 finalizer) */
+  static chi::u32 PointHash(chi::ContainerId id, chi::u32 v) {
+    uint64_t x = (static_cast<uint64_t>(id) << 32) | v;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return static_cast<chi::u32>(x);
+  }
+
+  std::vector<chi::u32> weights_;
+  chi::u32 vnodes_ = 0;
+  std::vector<std::pair<chi::u32, chi::ContainerId>> points_;
+};
+
+}  // namespace wrp_cte::core
+
+#endif  // WRPCTE_CORE_HASH_RING_H_
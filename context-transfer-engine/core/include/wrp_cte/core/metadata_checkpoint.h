@@ -0,0 +1,440 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef WRPCTE_CORE_METADATA_CHECKPOINT_H_
+#define WRPCTE_CORE_METADATA_CHECKPOINT_H_
+
+#include <chimaera/chimaera.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <wrp_cte/core/blob_index.h>
+#include <wrp_cte/core/transaction_log.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace wrp_cte::core {
+
+/** Entry types of a metadata checkpoint file (base image or delta) */
+enum class CheckpointEntry : uint8_t {
+  kTag = 0,
+  kBlob = 1,
+  kDelTag = 2,   // Tombstone: tag (name mapping and blobs) removed
+  kDelBlob = 3,  // Tombstone: blob removed
+  kBlobStub = 4,  // Blob entry followed by the source range of a stub
+  kHashId = 5,    // BlobHashId the file's placements were made with
+  kBlobErasure = 6,  // Blob entry followed by its erasure-code layout
+  kBlobEncrypted = 7,  // Blob entry followed by its encryption chunking
+  kTagIndex = 8,  // Last entry of a base image: per-tag blob ranges
+  kPackSegments = 9,  // Every small-object segment allocated when written
+  kTagPolicies = 10,  // Every tag replication, placement and dedup setting
+};
+
+/**
+ * Hash that routes blobs to containers. Every checkpoint file records it
+ * so a restarted runtime keeps placing blobs where the snapshot left them;
+ * files without the record predate it and were written under kLegacy.
+ */
+enum class BlobHashId : uint32_t {
+  kLegacy = 0,     // std::hash of the name, combined with the tag halves
+  kHashBytes = 1,  // hshm::HashBytes (kHashBytesVersion 1) seeded by the tag
+};
+
+/**
+ * Tags and blobs modified since the last metadata checkpoint.
+ *
+ * Sharded so that workers marking entries on the I/O path rarely contend;
+ * the checkpoint drains one shard at a time under that shard's lock only.
+ * Entries are marked after the mutation they record, and a drained entry
+ * that no longer exists in the runtime maps is written as a tombstone.
+ */
+class DirtyMetadataSet {
+ public:
+  static constexpr size_t kDefaultNumShards = 16;
+
+  /**
+   * Enable tracking
+   * @param num_shards Number of independently locked shards (at least 1)
+   */
+  void Init(size_t num_shards = kDefaultNumShards) {
+    shards_.clear();
+    for (size_t i = 0; i < std::max<size_t>(num_shards, 1); ++i) {
+      shards_.emplace_back(std::make_unique<Shard>());
+    }
+  }
+
+  /** Whether Init() was called (tracking is off without a metadata log) */
+  bool IsEnabled() const { return !shards_.empty(); }
+
+  /**
+   * Record that a blob changed
+   * @param key Composite key produced by BlobMetadataIndex::MakeKey
+   */
+  void MarkBlob(const std::string &key) {
+    if (shards_.empty()) return;
+    Shard &shard = *shards_[hshm::hash<std::string>{}(key) % shards_.size()];
+    hshm::ScopedMutex guard(shard.lock_, 0);
+    shard.blobs_.insert(key);
+  }
+
+  /**
+   * Record that a tag changed
+   * @param tag_id Tag ID
+   */
+  void MarkTag(const TagId &tag_id) {
+    if (shards_.empty()) return;
+    Shard &shard = *shards_[std::hash<TagId>{}(tag_id) % shards_.size()];
+    hshm::ScopedMutex guard(shard.lock_, 0);
+    shard.tags_.insert(tag_id);
+  }
+
+  /** @return Number of marked blobs and tags */
+  size_t Size() const {
+    size_t count = 0;
+    for (auto &shard_ptr : shards_) {
+      hshm::ScopedMutex guard(shard_ptr->lock_, 0);
+      count += shard_ptr->blobs_.size() + shard_ptr->tags_.size();
+    }
+    return count;
+  }
+
+  /**
+   * Move every marked entry out of the set
+   * @param blob_keys Output composite blob keys
+   * @param tag_ids Output tag IDs
+   */
+  void Drain(std::vector<std::string> &blob_keys,
+             std::vector<TagId> &tag_ids) {
+    for (auto &shard_ptr : shards_) {
+      std::unordered_set<std::string> blobs;
+      std::unordered_set<TagId> shard_tags;
+      {
+        hshm::ScopedMutex guard(shard_ptr->lock_, 0);
+        blobs.swap(shard_ptr->blobs_);
+        shard_tags.swap(shard_ptr->tags_);
+      }
+      blob_keys.insert(blob_keys.end(), blobs.begin(), blobs.end());
+      tag_ids.insert(tag_ids.end(), shard_tags.begin(), shard_tags.end());
+    }
+  }
+
+ private:
+  struct Shard {
+    hshm::Mutex lock_;
+    std::unordered_set<std::string> blobs_;
+    std::unordered_set<TagId> tags_;
+  };
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+/**
+ * Bounds-checked cursor over a memory-mapped checkpoint file. A read past
+ * the end (a torn tail) clears good() and leaves the output untouched.
+ */
+class CheckpointReader {
+ public:
+  explicit CheckpointReader(const MappedFile &file)
+      : data_(file.data()), size_(file.size()) {}
+
+  /** Cursor over a byte range, e.g. one tag's section of a base image */
+  CheckpointReader(const char *data, size_t size) : data_(data), size_(size) {}
+
+  /** @return true while every read so far was in bounds */
+  bool good() const { return good_; }
+
+  /** @return true if unread bytes remain */
+  bool HasMore() const { return good_ && off_ < size_; }
+
+  /** Read a trivially copyable value */
+  template <typename T>
+  void Read(T &val) {
+    if (!Check(sizeof(T))) return;
+    std::memcpy(&val, data_ + off_, sizeof(T));
+    off_ += sizeof(T);
+  }
+
+  /** Read len bytes into a string */
+  void ReadString(std::string &str, size_t len) {
+    if (!Check(len)) return;
+    str.assign(data_ + off_, len);
+    off_ += len;
+  }
+
+ private:
+  bool Check(size_t len) {
+    good_ = good_ && len <= size_ - off_;
+    return good_;
+  }
+
+  const char *data_;
+  size_t size_;
+  size_t off_ = 0;
+  bool good_ = true;
+};
+
+/**
+ * Directory of the blob sections of a base image.
+ *
+ * A base image writes the blobs of each tag back to back and ends with a
+ * kTagIndex entry listing every tag's byte range and CRC-32C. The entry
+ * closes with a fixed trailer, so a restart finds it from the end of the
+ * file without scanning the blobs:
+ *   [u8 kTagIndex][u32 flags][u64 blobs_begin][u32 num_tags]
+ *   num_tags x [TagId][u64 begin][u64 end][u32 crc]
+ *   [u64 index_begin][u32 index_crc][u32 kMagic]
+ * index_crc covers everything from index_begin up to itself.
+ */
+class CheckpointTagIndex {
+ public:
+  static constexpr chi::u32 kMagic = 0x58444954;  // "TIDX"
+  static constexpr size_t kTrailerSize = 16;
+  /** No block was shared between blobs when the image was written */
+  static constexpr chi::u32 kNoSharedBlocks = 1;
+
+  /** Byte range of one tag's blob entries */
+  struct Section {
+    TagId tag_id_;
+    chi::u64 begin_ = 0;
+    chi::u64 end_ = 0;
+    chi::u32 crc_ = 0;
+  };
+
+  chi::u32 flags_ = 0;
+  chi::u64 blobs_begin_ = 0;  /**< Offset of the first blob section */
+  std::vector<Section> sections_;
+
+  /**
+   * Append one tag's serialized blob entries and record their range
+   * @param os Image stream, positioned at the end of the image
+   * @param tag_id Tag the entries belong to
+   * @param bytes Serialized blob entries
+   */
+  void AddSection(std::ostream &os, const TagId &tag_id,
+                  const std::string &bytes) {
+    Section section;
+    section.tag_id_ = tag_id;
+    section.begin_ = static_cast<chi::u64>(os.tellp());
+    section.end_ = section.begin_ + bytes.size();
+    section.crc_ = TransactionLog::Crc32c(bytes.data(), bytes.size());
+    os.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    sections_.push_back(section);
+  }
+
+  /**
+   * Append the kTagIndex entry and trailer
+   * @param os Image stream, positioned at the end of the image
+   */
+  void Write(std::ostream &os) const {
+    std::string buf;
+    auto put = [&buf](const auto &val) {
+      buf.append(reinterpret_cast<const char *>(&val), sizeof(val));
+    };
+    chi::u64 index_begin = static_cast<chi::u64>(os.tellp());
+    put(static_cast<uint8_t>(CheckpointEntry::kTagIndex));
+    put(flags_);
+    put(blobs_begin_);
+    put(static_cast<chi::u32>(sections_.size()));
+    for (const auto &section : sections_) {
+      put(section.tag_id_);
+      put(section.begin_);
+      put(section.end_);
+      put(section.crc_);
+    }
+    put(index_begin);
+    put(TransactionLog::Crc32c(buf.data(), buf.size()));
+    put(kMagic);
+    os.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+  }
+
+  /**
+   * Locate and validate the index at the end of a mapped base image
+   * @param data Image bytes
+   * @param size Image size
+   * @return false if the image has no index or it fails validation
+   */
+  bool Parse(const char *data, size_t size) {
+    sections_.clear();
+    if (data == nullptr || size < kTrailerSize) return false;
+    chi::u64 index_begin = 0;
+    chi::u32 index_crc = 0, magic = 0;
+    const char *trailer = data + size - kTrailerSize;
+    std::memcpy(&index_begin, trailer, sizeof(index_begin));
+    std::memcpy(&index_crc, trailer + 8, sizeof(index_crc));
+    std::memcpy(&magic, trailer + 12, sizeof(magic));
+    if (magic != kMagic || index_begin >= size - kTrailerSize) return false;
+    size_t covered = size - 8 - index_begin;
+    if (TransactionLog::Crc32c(data + index_begin, covered) != index_crc) {
+      return false;
+    }
+
+    CheckpointReader reader(data + index_begin, size - kTrailerSize -
+                                                    index_begin);
+    uint8_t entry_type = 0;
+    chi::u32 num_tags = 0;
+    reader.Read(entry_type);
+    reader.Read(flags_);
+    reader.Read(blobs_begin_);
+    reader.Read(num_tags);
+    if (!reader.good() ||
+        entry_type != static_cast<uint8_t>(CheckpointEntry::kTagIndex) ||
+        blobs_begin_ > index_begin) {
+      return false;
+    }
+    sections_.resize(num_tags);
+    for (auto &section : sections_) {
+      reader.Read(section.tag_id_);
+      reader.Read(section.begin_);
+      reader.Read(section.end_);
+      reader.Read(section.crc_);
+      if (!reader.good() || section.begin_ < blobs_begin_ ||
+          section.begin_ > section.end_ || section.end_ > index_begin) {
+        sections_.clear();
+        return false;
+      }
+    }
+    return !reader.HasMore();
+  }
+
+  /**
+   * Check a section against its recorded CRC
+   * @param data Image bytes
+   * @param section Section to check (bounds already validated by Parse)
+   */
+  static bool Verify(const char *data, const Section &section) {
+    return TransactionLog::Crc32c(data + section.begin_,
+                                  section.end_ - section.begin_) ==
+           section.crc_;
+  }
+};
+
+/**
+ * File layout of a metadata checkpoint: a base image at the configured
+ * path plus numbered delta files "<path>.delta.<seq>" applied in order.
+ */
+class MetadataCheckpoint {
+ public:
+  /**
+   * Path of a delta file
+   * @param base_path Base image path
+   * @param seq Delta sequence number
+   */
+  static std::string DeltaPath(const std::string &base_path, chi::u64 seq) {
+    return base_path + ".delta." + std::to_string(seq);
+  }
+
+  /**
+   * List the delta files next to a base image
+   * @param base_path Base image path
+   * @return Delta sequence numbers, ascending
+   */
+  static std::vector<chi::u64> ListDeltas(const std::string &base_path) {
+    namespace fs = std::filesystem;
+    std::vector<chi::u64> seqs;
+    fs::path base(base_path);
+    fs::path dir = base.has_parent_path() ? base.parent_path() : fs::path(".");
+    std::string prefix = base.filename().string() + ".delta.";
+    std::error_code ec;
+    for (const auto &entry : fs::directory_iterator(dir, ec)) {
+      std::string name = entry.path().filename().string();
+      if (name.size() <= prefix.size() ||
+          name.compare(0, prefix.size(), prefix) != 0) {
+        continue;
+      }
+      std::string suffix = name.substr(prefix.size());
+      if (!std::all_of(suffix.begin(), suffix.end(), [](unsigned char c) {
+            return std::isdigit(c) != 0;
+          })) {
+        continue;
+      }
+      seqs.push_back(std::stoull(suffix));
+    }
+    std::sort(seqs.begin(), seqs.end());
+    return seqs;
+  }
+
+  /**
+   * Durably move a fully written temporary file into place
+   * @param tmp_path Temporary file (closed)
+   * @param path Final path
+   * @return true on success
+   */
+  static bool Publish(const std::string &tmp_path, const std::string &path) {
+    int fd = ::open(tmp_path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    if (!synced) return false;
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    return !ec;
+  }
+
+  /**
+   * Durably write a serialized image: a temporary file, then Publish()
+   * @param path Final path
+   * @param bytes Image contents
+   * @return true on success
+   */
+  static bool Write(const std::string &path, const std::string &bytes) {
+    std::string tmp_path = path + ".tmp";
+    std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) return false;
+    ofs.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    ofs.close();
+    return !ofs.fail() && Publish(tmp_path, path);
+  }
+
+  /**
+   * Remove delta files that a new base image has superseded
+   * @param base_path Base image path
+   * @param seqs Sequence numbers to remove
+   */
+  static void RemoveDeltas(const std::string &base_path,
+                           const std::vector<chi::u64> &seqs) {
+    std::error_code ec;
+    for (chi::u64 seq : seqs) {
+      std::filesystem::remove(DeltaPath(base_path, seq), ec);
+    }
+  }
+};
+
+}  // namespace wrp_cte::core
+
+#endif  // WRPCTE_CORE_METADATA_CHECKPOINT_H_
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef WRPCTE_CORE_METADATA_LEASE_H_
+#define WRPCTE_CORE_METADATA_LEASE_H_
+
+#include <wrp_cte/core/core_tasks.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "hermes_shm/introspect/system_info.h"
+
+namespace wrp_cte::core {
+
+/**
+ * Node-wide table of tag modification counters in POSIX shared memory.
+ *
+ * The runtime bumps a tag's slot whenever the tag is created or deleted or
+ * its blobs change. Client-side metadata caches remember the slot value
+ * when they read a tag's metadata and treat their copy as revoked as soon
+ * as the value moves, so checking a lease costs one shared-memory load and
+ * no IPC. Tags share slots by hash; a collision only revokes more than
+ * needed. Revocations are seen by clients on the node that executed the
+ * modification, so caches still expire entries after a lease time.
+ */
+class MetadataLeaseTable {
+ public:
+  /** Number of counters; a power of two */
+  static constexpr size_t kNumSlots = 1 << 16;
+
+  MetadataLeaseTable() = default;
+  MetadataLeaseTable(const MetadataLeaseTable &) = delete;
+  MetadataLeaseTable &operator=(const MetadataLeaseTable &) = delete;
+  ~MetadataLeaseTable() { Detach(); }
+
+  /**
+   * Name of the table's segment, derived from the runtime's main segment
+   * so that several runtimes on one node do not share a table
+   */
+  static std::string SegmentName() {
+    auto *config = CHI_CONFIG_MANAGER;
+    std::string base = "chimaera_main";
+    if (config && config->IsValid()) {
+      base = config->GetSharedMemorySegmentName(chi::kMainSegment);
+    }
+    return base + "_cte_leases";
+  }
+
+  /**
+   * Create the table (runtime side). Calling it again is a no-op.
+   * @param name Shared memory object name
+   * @return false if the segment could not be created
+   */
+  bool Create(const std::string &name) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (header_) {
+      return true;
+    }
+    hshm::SystemInfo::DestroySharedMemory(name);
+    if (!hshm::SystemInfo::CreateNewSharedMemory(fd_, name, kSegmentSize)) {
+      return false;
+    }
+    if (!Map()) {
+      hshm::SystemInfo::DestroySharedMemory(name);
+      return false;
+    }
+    name_ = name;
+    owner_ = true;
+    header_->alive_.store(1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Map the table created by the local runtime (client side)
+   * @param name Shared memory object name
+   * @return false if no runtime table exists
+   */
+  bool Attach(const std::string &name) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (header_) {
+      return true;
+    }
+    if (!hshm::SystemInfo::OpenSharedMemory(fd_, name)) {
+      return false;
+    }
+    if (!Map()) {
+      return false;
+    }
+    name_ = name;
+    return true;
+  }
+
+  /** Unmap the table; the runtime also removes the segment */
+  void Detach() {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (!header_) {
+      return;
+    }
+    if (owner_) {
+      // Clients still mapping the removed segment see it is gone
+      header_->alive_.store(0, std::memory_order_release);
+    }
+    hshm::SystemInfo::UnmapMemory(header_, kSegmentSize);
+    hshm::SystemInfo::CloseSharedMemory(fd_);
+    if (owner_) {
+      hshm::SystemInfo::DestroySharedMemory(name_);
+    }
+    header_ = nullptr;
+    owner_ = false;
+  }
+
+  /** Whether the table is mapped and its runtime is still running */
+  bool IsLive() const {
+    return header_ && header_->alive_.load(std::memory_order_acquire) != 0;
+  }
+
+  /** Revoke every lease on \a tag_id */
+  void Revoke(const TagId &tag_id) {
+    if (header_) {
+      header_->slots_[Slot(tag_id)].fetch_add(1, std::memory_order_release);
+    }
+  }
+
+  /**
+   * Current modification count of \a tag_id's slot
+   * @return 0 when the table is not mapped
+   */
+  chi::u64 GetVersion(const TagId &tag_id) const {
+    if (!header_) {
+      return 0;
+    }
+    return header_->slots_[Slot(tag_id)].load(std::memory_order_acquire);
+  }
+
+ private:
+  /** Layout of the shared segment */
+  struct Header {
+    std::atomic<chi::u64> alive_;             /**< 0 once the runtime left */
+    std::atomic<chi::u64> slots_[kNumSlots];  /**< Per-slot versions */
+  };
+  static constexpr size_t kSegmentSize =
+      (sizeof(Header) + 4095) & ~static_cast<size_t>(4095);
+
+  /** Map the open segment */
+  bool Map() {
+    header_ = reinterpret_cast<Header *>(
+        hshm::SystemInfo::MapSharedMemory(fd_, kSegmentSize, 0));
+    if (!header_) {
+      hshm::SystemInfo::CloseSharedMemory(fd_);
+      return false;
+    }
+    return true;
+  }
+
+  /** Slot of \a tag_id */
+  static size_t Slot(const TagId &tag_id) {
+    chi::u64 key = (static_cast<chi::u64>(tag_id.major_) << 32) |
+                   static_cast<chi::u64>(tag_id.minor_);
+    key *= 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(key >> 48) & (kNumSlots - 1);
+  }
+
+  Header *header_ = nullptr;
+  hshm::File fd_{};
+  std::string name_;
+  bool owner_ = false;
+  std::mutex lock_;
+};
+
+}  // namespace wrp_cte::core
+
+#endif  // WRPCTE_CORE_METADATA_LEASE_H_
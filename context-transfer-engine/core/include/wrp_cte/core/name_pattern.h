@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef WRPCTE_CORE_NAME_PATTERN_H_
+#define WRPCTE_CORE_NAME_PATTERN_H_
+
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace wrp_cte::core {
+
+/**
+ * Pre-classified tag/blob name pattern used by TagQuery and BlobQuery.
+ *
+ * Query patterns are ECMAScript regexes matched against the whole name, but
+ * most of them are plain literals ("run_42"), prefixes ("run_.*") or simple
+ * globs built from "." and ".*". Those forms are answered with string
+ * comparisons (and, for prefixes, ordered range scans of the name index);
+ * only genuine regexes pay for std::regex. Compiled patterns are cached
+ * process-wide, so every container on a node shares one compilation per
+ * broadcast query.
+ */
+class NamePattern {
+ public:
+  /** Shape of a pattern, from cheapest to most expensive to evaluate */
+  enum class Kind { kLiteral, kPrefix, kGlob, kRegex };
+
+  /** Bound on cached patterns before the cache is reset */
+  static constexpr size_t kMaxCachedPatterns = 256;
+
+  /**
+   * Classify and compile a pattern
+   * @param pattern ECMAScript regex matched against entire names
+   * @throws std::regex_error if the pattern is a malformed regex
+   */
+  explicit NamePattern(const std::string &pattern) : pattern_(pattern) {
+    Classify();
+    if (kind_ == Kind::kRegex) {
+      regex_ = std::regex(pattern_);
+    }
+  }
+
+  /**
+   * Get the shared compiled form of a pattern, compiling it at most once
+   * per process while it stays cached
+   * @param pattern ECMAScript regex matched against entire names
+   * @return Shared immutable pattern
+   * @throws std::regex_error if the pattern is a malformed regex
+   */
+  static std::shared_ptr<const NamePattern> Get(const std::string &pattern) {
+    static std::mutex cache_lock;
+    static std::unordered_map<std::string, std::shared_ptr<const NamePattern>>
+        cache;
+    {
+      std::lock_guard<std::mutex> lock(cache_lock);
+      auto it = cache.find(pattern);
+      if (it != cache.end()) {
+        return it->second;
+      }
+    }
+    // Compile outside the lock; a racing duplicate compile is harmless
+    auto compiled = std::make_shared<const NamePattern>(pattern);
+    std::lock_guard<std::mutex> lock(cache_lock);
+    if (cache.size() >= kMaxCachedPatterns) {
+      cache.clear();
+    }
+    cache.emplace(pattern, compiled);
+    return compiled;
+  }
+
+  /** Shape of this pattern */
+  Kind GetKind() const { return kind_; }
+
+  /**
+   * Literal text every match begins with. For kLiteral this is the whole
+   * name; for other kinds it may be empty.
+   */
+  const std::string &GetPrefix() const { return prefix_; }
+
+  /** Original pattern text */
+  const std::string &GetPattern() const { return pattern_; }
+
+  /**
+   * Test whether a name matches the pattern in full
+   * @param name Tag or blob name
+   * @return True on match
+   */
+  bool Match(const std::string &name) const {
+    switch (kind_) {
+      case Kind::kLiteral:
+        return name == prefix_;
+      case Kind::kPrefix:
+        return name.compare(0, prefix_.size(), prefix_) == 0;
+      case Kind::kGlob:
+        return GlobMatch(name);
+      case Kind::kRegex:
+      default:
+        return std::regex_match(name, regex_);
+    }
+  }
+
+ private:
+  /** One element of a glob: a literal char, "." or ".*" */
+  struct GlobToken {
+    enum Type { kChar, kAnyOne, kAnyRun } type_;
+    char c_;
+  };
+
+  /** Characters that may be escaped with '\' to denote themselves */
+  static bool IsEscapablePunct(char c) {
+    static const std::string kPunct = ".[]{}()*+?^$|\\/-";
+    return kPunct.find(c) != std::string::npos;
+  }
+
+  /** Characters with regex meaning when unescaped */
+  static bool IsMeta(char c) {
+    static const std::string kMeta = ".[]{}()*+?^$|\\";
+    return kMeta.find(c) != std::string::npos;
+  }
+
+  /** Whether the char at i is a quantifier applying to the previous atom */
+  static bool IsQuantifier(const std::string &s, size_t i) {
+    return i < s.size() &&
+           (s[i] == '*' || s[i] == '+' || s[i] == '?' || s[i] == '{');
+  }
+
+  /**
+   * Tokenize the pattern into glob tokens, falling back to kRegex at the
+   * first construct a glob cannot express. Alternation anywhere makes the
+   * literal prefix unsafe, so it is cleared in that case.
+   */
+  void Classify() {
+    kind_ = Kind::kRegex;
+    prefix_.clear();
+    bool has_alternation = pattern_.find('|') != std::string::npos;
+    size_t begin = (!pattern_.empty() && pattern_[0] == '^') ? 1 : 0;
+    size_t end = pattern_.size();
+    if (end > begin && pattern_[end - 1] == '$' &&
+        (end < 2 || pattern_[end - 2] != '\\')) {
+      --end;
+    }
+    bool is_glob = true;
+    bool prefix_open = true;
+    for (size_t i = begin; i < end;) {
+      char c = pattern_[i];
+      GlobToken tok{GlobToken::kChar, c};
+      size_t next = i + 1;
+      if (c == '\\') {
+        if (next >= end || !IsEscapablePunct(pattern_[next])) {
+          is_glob = false;  // \d, \w, back-references, ...
+          break;
+        }
+        tok.c_ = pattern_[next];
+        next = i + 2;
+      } else if (c == '.') {
+        tok.type_ = GlobToken::kAnyOne;
+        if (next < end && pattern_[next] == '*') {
+          tok.type_ = GlobToken::kAnyRun;
+          ++next;
+        }
+      } else if (IsMeta(c)) {
+        is_glob = false;
+        break;
+      }
+      if (IsQuantifier(pattern_, next) && next < end) {
+        is_glob = false;  // "a*", "\.?", ".+", "x{2}" ...
+        break;
+      }
+      if (tok.type_ != GlobToken::kChar) {
+        prefix_open = false;
+      } else if (prefix_open) {
+        prefix_.push_back(tok.c_);
+      }
+      glob_.push_back(tok);
+      i = next;
+    }
+    if (has_alternation) {
+      prefix_.clear();
+      glob_.clear();
+      return;
+    }
+    if (!is_glob) {
+      glob_.clear();
+      return;
+    }
+    size_t wildcards = 0;
+    for (const auto &tok : glob_) {
+      wildcards += (tok.type_ != GlobToken::kChar);
+    }
+    if (wildcards == 0) {
+      kind_ = Kind::kLiteral;
+    } else if (wildcards == 1 && glob_.back().type_ == GlobToken::kAnyRun) {
+      kind_ = Kind::kPrefix;
+    } else {
+      kind_ = Kind::kGlob;
+    }
+  }
+
+  /**
+   * Match a name against glob_ with the standard greedy-star backtracking
+   * algorithm (linear in practice, no allocation)
+   */
+  bool GlobMatch(const std::string &name) const {
+    size_t n = 0, g = 0;
+    size_t star_g = std::string::npos, star_n = 0;
+    while (n < name.size()) {
+      if (g < glob_.size() && glob_[g].type_ == GlobToken::kAnyRun) {
+        star_g = g++;
+        star_n = n;
+      } else if (g < glob_.size() &&
+                 (glob_[g].type_ == GlobToken::kAnyOne ||
+                  glob_[g].c_ == name[n])) {
+        ++g;
+        ++n;
+      } else if (star_g != std::string::npos) {
+        g = star_g + 1;
+        n = ++star_n;
+      } else {
+        return false;
+      }
+    }
+    while (g < glob_.size() && glob_[g].type_ == GlobToken::kAnyRun) {
+      ++g;
+    }
+    return g == glob_.size();
+  }
+
+  std::string pattern_;
+  Kind kind_ = Kind::kRegex;
+  std::string prefix_;
+  std::vector<GlobToken> glob_;
+  std::regex regex_;
+};
+
+}  // namespace wrp_cte::core
+
+#endif  // WRPCTE_CORE_NAME_PATTERN_H_
@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef WRPCTE_CORE_PACK_SEGMENTS_H_
+#define WRPCTE_CORE_PACK_SEGMENTS_H_
+
+#include <chimaera/chimaera.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace wrp_cte::core {
+
+/**
+ * One segment of the small-object store: a single large allocation on a
+ * target that small blobs are appended to, log-structured.
+ */
+struct PackSegment {
+  chi::PoolId target_id_;  // Bdev pool id of the target holding it
+  chi::u64 base_ = 0;      // Offset of the segment on the target
+  chi::u64 size_ = 0;      // Bytes allocated for it
+  chi::u64 fill_ = 0;      // Bytes appended so far
+  chi::u64 durable_ = 0;   // Leading bytes written out to the target
+  chi::u64 live_bytes_ = 0;    // Bytes of objects still referenced
+  chi::u32 live_objects_ = 0;  // Objects still referenced
+  bool sealed_ = false;    // Takes no more appends
+  bool flushing_ = false;  // A write of the tail is in flight
+  hipc::FullPtr<char> buffer_;  // Copy of the segment until it is written
+};
+
+/**
+ * Index of the small-object segments of a container.
+ *
+ * Objects are placed at 8-byte boundaries, but never on a multiple of
+ * kUnit: every ordinary allocation starts on one, so an extent that does
+ * not is a packed object, even without the index.
+ * Finding the segment of an extent is a lookup in a per-target map ordered
+ * by segment offset. The table only keeps the books; allocating, writing
+ * and freeing segments is up to the caller. Not thread safe.
+ */
+class PackSegmentTable {
+ public:
+  static inline constexpr chi::u64 kAlign = 8;
+  static inline constexpr chi::u64 kUnit = 4096;
+
+  /**
+   * Whether an extent at this target offset can only be a packed object
+   * @param target_offset Offset of the extent on its target
+   */
+  static bool IsPackedOffset(chi::u64 target_offset) {
+    return target_offset % kUnit != 0;
+  }
+
+  /**
+   * Start tracking a new, empty segment
+   * @param target_id Target the segment was allocated on
+   * @param base Offset of the segment on the target
+   * @param size Bytes allocated
+   * @return Id of the segment, never 0
+   */
+  chi::u64 Add(const chi::PoolId &target_id, chi::u64 base, chi::u64 size) {
+    chi::u64 id = next_id_++;
+    PackSegment &seg = segments_[id];
+    seg.target_id_ = target_id;
+    seg.base_ = base;
+    seg.size_ = size;
+    by_offset_[target_id][base] = id;
+    return id;
+  }
+
+  /**
+   * @param id Segment id
+   * @return The segment, or nullptr if it is not tracked
+   */
+  PackSegment *Get(chi::u64 id) {
+    auto it = segments_.find(id);
+    return it != segments_.end() ? &it->second : nullptr;
+  }
+
+  /**
+   * Place an object at the end of an unsealed segment and count it live
+   * @param id Segment id
+   * @param size Object size in bytes
+   * @param offset Set to the object's offset within the segment
+   * @return false if the segment is sealed or the object does not fit
+   */
+  bool Reserve(chi::u64 id, chi::u64 size, chi::u64 &offset) {
+    PackSegment *seg = Get(id);
+    if (seg == nullptr || seg->sealed_ || size == 0) {
+      return false;
+    }
+    chi::u64 pos = (seg->fill_ + kAlign - 1) / kAlign * kAlign;
+    if (!IsPackedOffset(seg->base_ + pos)) {
+      pos += kAlign;
+    }
+    if (pos + size > seg->size_) {
+      return false;
+    }
+    offset = pos;
+    seg->fill_ = pos + size;
+    seg->live_bytes_ += size;
+    seg->live_objects_++;
+    return true;
+  }
+
+  /**
+   * Track a segment restored after a restart: sealed, fully written and
+   * with no live objects until Retain counts them
+   * @param target_id Target the segment was allocated on
+   * @param base Offset of the segment on the target
+   * @param size Bytes allocated
+   * @return Id of the segment, never 0
+   */
+  chi::u64 Restore(const chi::PoolId &target_id, chi::u64 base,
+                   chi::u64 size) {
+    chi::u64 id = Add(target_id, base, size);
+    PackSegment &seg = segments_[id];
+    seg.fill_ = size;
+    seg.durable_ = size;
+    seg.sealed_ = true;
+    return id;
+  }
+
+  /**
+   * Count an object of a restored segment as referenced
+   * @param id Segment id
+   * @param size Object size in bytes
+   */
+  void Retain(chi::u64 id, chi::u64 size) {
+    PackSegment *seg = Get(id);
+    if (seg != nullptr) {
+      seg->live_bytes_ += size;
+      seg->live_objects_++;
+    }
+  }
+
+  /**
+   * Find the segment an extent lies in
+   * @param target_id Target of the extent
+   * @param target_offset Offset of the extent on the target
+   * @param size Size of the extent
+   * @return Segment id, or 0 if no tracked segment holds the whole extent
+   */
+  chi::u64 Find(const chi::PoolId &target_id, chi::u64 target_offset,
+                chi::u64 size) const {
+    auto target_it = by_offset_.find(target_id);
+    if (target_it == by_offset_.end()) {
+      return 0;
+    }
+    const std::map<chi::u64, chi::u64> &bases = target_it->second;
+    auto it = bases.upper_bound(target_offset);
+    if (it == bases.begin()) {
+      return 0;
+    }
+    --it;
+    const PackSegment &seg = segments_.at(it->second);
+    if (target_offset + size > seg.base_ + seg.fill_) {
+      return 0;
+    }
+    return it->second;
+  }
+
+  /**
+   * Count one object of a segment as no longer referenced
+   * @param id Segment id
+   * @param size Object size in bytes
+   * @return Whether the segment can now be freed
+   */
+  bool Release(chi::u64 id, chi::u64 size) {
+    PackSegment *seg = Get(id);
+    if (seg == nullptr) {
+      return false;
+    }
+    seg->live_bytes_ -= std::min(seg->live_bytes_, size);
+    if (seg->live_objects_ > 0) {
+      seg->live_objects_--;
+    }
+    return IsReclaimable(*seg);
+  }
+
+  /** Stop appending to a segment */
+  void Seal(chi::u64 id) {
+    PackSegment *seg = Get(id);
+    if (seg != nullptr) {
+      seg->sealed_ = true;
+    }
+  }
+
+  /**
+   * A sealed segment no object references, and no write is using
+   * @param seg Segment to check
+   */
+  static bool IsReclaimable(const PackSegment &seg) {
+    return seg.sealed_ && seg.live_objects_ == 0 && !seg.flushing_;
+  }
+
+  /**
+   * Stop tracking a segment
+   * @param id Segment id
+   * @param removed Set to the segment as it was, if it was tracked
+   * @return Whether the segment was tracked
+   */
+  bool Remove(chi::u64 id, PackSegment &removed) {
+    auto it = segments_.find(id);
+    if (it == segments_.end()) {
+      return false;
+    }
+    removed = it->second;
+    auto target_it = by_offset_.find(removed.target_id_);
+    if (target_it != by_offset_.end()) {
+      target_it->second.erase(removed.base_);
+      if (target_it->second.empty()) {
+        by_offset_.erase(target_it);
+      }
+    }
+    segments_.erase(it);
+    return true;
+  }
+
+  /**
+   * Sealed, fully written segments whose live bytes fell to a fraction of
+   * their size, so that copying the live objects out frees the most space
+   * @param max_live_ratio Largest live fraction to collect
+   * @param ids Filled with the segment ids, sparsest first
+   */
+  void CollectSparse(double max_live_ratio, std::vector<chi::u64> &ids) const {
+    ids.clear();
+    for (const auto &entry : segments_) {
+      const PackSegment &seg = entry.second;
+      if (!seg.sealed_ || seg.flushing_ || seg.durable_ < seg.fill_ ||
+          seg.live_objects_ == 0) {
+        continue;
+      }
+      if (seg.live_bytes_ <= max_live_ratio * seg.size_) {
+        ids.push_back(entry.first);
+      }
+    }
+    std::sort(ids.begin(), ids.end(), [this](chi::u64 a, chi::u64 b) {
+      return segments_.at(a).live_bytes_ < segments_.at(b).live_bytes_;
+    });
+  }
+
+  /**
+   * Segments that can be freed right away (e.g. restored segments whose
+   * objects were all deleted before the restart)
+   * @param ids Filled with the segment ids
+   */
+  void CollectReclaimable(std::vector<chi::u64> &ids) const {
+    ids.clear();
+    for (const auto &entry : segments_) {
+      if (IsReclaimable(entry.second)) {
+        ids.push_back(entry.first);
+      }
+    }
+  }
+
+  /**
+   * Call fn(id, segment) for every tracked segment
+   * @param fn Visitor; it must not add or remove segments
+   */
+  template <typename F>
+  void ForEach(F &&fn) {
+    for (auto &entry : segments_) {
+      fn(entry.first, entry.second);
+    }
+  }
+
+  /** @return Segments tracked */
+  size_t Size() const { return segments_.size(); }
+
+ private:
+  std::unordered_map<chi::u64, PackSegment> segments_;
+  std::unordered_map<chi::PoolId, std::map<chi::u64, chi::u64>> by_offset_;
+  chi::u64 next_id_ = 1;
+};
+
+}  // namespace wrp_cte::core
+
+#endif  // WRPCTE_CORE_PACK_SEGMENTS_H_
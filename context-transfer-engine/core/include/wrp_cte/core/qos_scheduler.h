@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef WRPCTE_CORE_QOS_SCHEDULER_H_
+#define WRPCTE_CORE_QOS_SCHEDULER_H_
+
+#include <chimaera/chimaera.h>
+#include <hermes_shm/thread/lock/mutex.h>
+#include <wrp_cte/core/core_config.h>
+#include <wrp_cte/core/core_tasks.h>
+
+#include <algorithm>
+#include <map>
+#include <regex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace wrp_cte::core {
+
+/**
+ * Admission control for bdev submissions.
+ *
+ * Every class has a token bucket, and so does every rate-limited target.
+ * Submissions waiting on the same target are admitted in weighted fair
+ * queuing order: a submission's finish tag grows by bytes / weight of its
+ * class, and the smallest tag whose class has tokens goes next. A class
+ * that is out of tokens therefore never holds up the others. Time is
+ * passed in so the scheduler can be driven without a runtime.
+ */
+class QosScheduler {
+ public:
+  /** Shortest and longest retry delay handed back by TryAdmit */
+  static constexpr double kMinWaitUs = 10.0;
+  static constexpr double kMaxWaitUs = 10000.0;
+
+  /** A submission waiting for admission */
+  struct Ticket {
+    chi::u32 class_id_ = 0;
+    chi::PoolId target_id_;
+    chi::u64 bytes_ = 0;
+    double finish_ = 0;
+    chi::u64 seq_ = 0;
+    chi::u64 enqueue_ns_ = 0;
+  };
+
+  /**
+   * Install the configured classes; class 0 is the unlimited default
+   * @param classes Classes in configuration order (IDs 1..N)
+   */
+  void Configure(const std::vector<QosClassConfig> &classes) {
+    hshm::ScopedMutex guard(lock_, 0);
+    classes_.assign(1, ClassState());
+    for (const QosClassConfig &config : classes) {
+      ClassState state;
+      state.weight_ = std::max<chi::u32>(config.weight_, 1);
+      state.bucket_.Init(static_cast<double>(config.rate_),
+                         static_cast<double>(config.burst_));
+      for (const std::string &pattern : config.tag_patterns_) {
+        state.patterns_.emplace_back(pattern);
+      }
+      classes_.push_back(std::move(state));
+    }
+    for (chi::u32 id = 0; id < classes_.size(); ++id) {
+      classes_[id].stats_.class_id_ = id;
+    }
+    enabled_ = classes_.size() > 1 || enabled_;
+  }
+
+  /**
+   * Limit the total rate of a target, whatever the class
+   * @param target_id Target (bdev pool) ID
+   * @param rate Bytes per second (0 = unlimited)
+   * @param burst Token bucket depth in bytes
+   */
+  void SetTargetRate(const chi::PoolId &target_id, chi::u64 rate,
+                     chi::u64 burst) {
+    hshm::ScopedMutex guard(lock_, 0);
+    targets_[target_id].bucket_.Init(static_cast<double>(rate),
+                                     static_cast<double>(burst));
+    enabled_ = enabled_ || rate > 0;
+    if (classes_.empty()) {
+      classes_.assign(1, ClassState());
+    }
+  }
+
+  /** @return true if any class or target is configured */
+  bool Enabled() const { return enabled_; }
+
+  /**
+   * Remember the class of a tag from its name
+   * @param tag_id Tag ID
+   * @param tag_name Tag name matched against the class patterns
+   */
+  void AssignTag(const TagId &tag_id, const std::string &tag_name) {
+    hshm::ScopedMutex guard(lock_, 0);
+    for (chi::u32 id = 1; id < classes_.size(); ++id) {
+      for (const std::regex &pattern : classes_[id].patterns_) {
+        if (std::regex_match(tag_name, pattern)) {
+          tag_classes_[tag_id] = id;
+          return;
+        }
+      }
+    }
+  }
+
+  /**
+   * Get the class of a tag seen by AssignTag
+   * @param tag_id Tag ID
+   * @return Class ID, 0 if the tag matched no class or was never seen
+   */
+  chi::u32 GetTagClass(const TagId &tag_id) {
+    hshm::ScopedMutex guard(lock_, 0);
+    auto it = tag_classes_.find(tag_id);
+    return it != tag_classes_.end() ? it->second : 0;
+  }
+
+  /**
+   * Queue a submission
+   * @param class_id Class of the submission (unknown IDs use class 0)
+   * @param target_id Target it is sent to
+   * @param bytes Bytes it reads or writes
+   * @param now_ns Current time
+   * @return Ticket to pass to TryAdmit until it is admitted
+   */
+  Ticket Enqueue(chi::u32 class_id, const chi::PoolId &target_id,
+                 chi::u64 bytes, chi::u64 now_ns) {
+    hshm::ScopedMutex guard(lock_, 0);
+    Ticket ticket;
+    ticket.class_id_ = class_id < classes_.size() ? class_id : 0;
+    ticket.target_id_ = target_id;
+    ticket.bytes_ = bytes;
+    ticket.seq_ = next_seq_++;
+    ticket.enqueue_ns_ = now_ns;
+    ClassState &cls = classes_[ticket.class_id_];
+    TargetState &target = targets_[target_id];
+    double &last_finish = target.last_finish_[ticket.class_id_];
+    double start = std::max(target.vtime_, last_finish);
+    ticket.finish_ = start + static_cast<double>(bytes) / cls.weight_;
+    last_finish = ticket.finish_;
+    target.waiting_.emplace(std::make_pair(ticket.finish_, ticket.seq_),
+                            std::make_pair(ticket.class_id_, bytes));
+    cls.stats_.queued_++;
+    return ticket;
+  }
+
+  /**
+   * Try to admit a queued submission
+   * @param ticket Ticket from Enqueue
+   * @param now_ns Current time
+   * @return 0 if admitted, else microseconds to wait before trying again
+   */
+  double TryAdmit(const Ticket &ticket, chi::u64 now_ns) {
+    hshm::ScopedMutex guard(lock_, 0);
+    ClassState &cls = classes_[ticket.class_id_];
+    TargetState &target = targets_[ticket.target_id_];
+    double bytes = static_cast<double>(ticket.bytes_);
+    cls.bucket_.Refill(now_ns);
+    if (!cls.bucket_.Ready(bytes)) {
+      return ClampWait(cls.bucket_.WaitUs(bytes));
+    }
+    // An earlier tag whose class has tokens goes first
+    auto mine = std::make_pair(ticket.finish_, ticket.seq_);
+    for (auto it = target.waiting_.begin();
+         it != target.waiting_.end() && it->first < mine; ++it) {
+      Bucket &other = classes_[it->second.first].bucket_;
+      other.Refill(now_ns);
+      if (other.Ready(static_cast<double>(it->second.second))) {
+        return kMinWaitUs;
+      }
+    }
+    target.bucket_.Refill(now_ns);
+    if (!target.bucket_.Ready(bytes)) {
+      return ClampWait(target.bucket_.WaitUs(bytes));
+    }
+
+    target.waiting_.erase(mine);
+    target.vtime_ = std::max(target.vtime_, ticket.finish_);
+    cls.bucket_.Take(bytes);
+    target.bucket_.Take(bytes);
+    chi::u64 wait_ns =
+        now_ns > ticket.enqueue_ns_ ? now_ns - ticket.enqueue_ns_ : 0;
+    cls.stats_.queued_--;
+    cls.stats_.requests_++;
+    cls.stats_.bytes_ += ticket.bytes_;
+    cls.stats_.total_wait_ns_ += wait_ns;
+    cls.stats_.max_wait_ns_ = std::max(cls.stats_.max_wait_ns_, wait_ns);
+    return 0;
+  }
+
+  /** @return Queueing statistics of every class, default class first */
+  std::vector<QosClassTelemetry> GetTelemetry() {
+    hshm::ScopedMutex guard(lock_, 0);
+    std::vector<QosClassTelemetry> stats;
+    for (const ClassState &cls : classes_) {
+      stats.push_back(cls.stats_);
+    }
+    return stats;
+  }
+
+ private:
+  /** Token bucket; a zero rate never limits */
+  struct Bucket {
+    double rate_ = 0;  // Bytes per second
+    double burst_ = 0;
+    double tokens_ = 0;
+    chi::u64 last_ns_ = 0;
+
+    void Init(double rate, double burst) {
+      rate_ = rate;
+      burst_ = std::max(burst, 1.0);
+      tokens_ = burst_;
+      last_ns_ = 0;
+    }
+    void Refill(chi::u64 now_ns) {
+      if (rate_ <= 0) return;
+      if (last_ns_ != 0 && now_ns > last_ns_) {
+        tokens_ = std::min(burst_, tokens_ + (now_ns - last_ns_) * rate_ / 1e9);
+      }
+      last_ns_ = std::max(last_ns_, now_ns);
+    }
+    /** A submission larger than the bucket only needs a full bucket */
+    bool Ready(double bytes) const {
+      return rate_ <= 0 || tokens_ >= std::min(bytes, burst_);
+    }
+    double WaitUs(double bytes) const {
+      return (std::min(bytes, burst_) - tokens_) / rate_ * 1e6;
+    }
+    void Take(double bytes) {
+      if (rate_ > 0) tokens_ -= bytes;
+    }
+  };
+
+  struct ClassState {
+    chi::u32 weight_ = 1;
+    Bucket bucket_;
+    std::vector<std::regex> patterns_;
+    QosClassTelemetry stats_;
+  };
+
+  struct TargetState {
+    Bucket bucket_;
+    double vtime_ = 0;  // Finish tag of the last admitted submission
+    std::unordered_map<chi::u32, double> last_finish_;  // Per class
+    // (finish tag, sequence) -> (class, bytes)
+    std::map<std::pair<double, chi::u64>, std::pair<chi::u32, chi::u64>>
+        waiting_;
+  };
+
+  static double ClampWait(double wait_us) {
+    return std::min(kMaxWaitUs, std::max(kMinWaitUs, wait_us));
+  }
+
+  hshm::Mutex lock_;
+  bool enabled_ = false;
+  chi::u64 next_seq_ = 0;
+  std::vector<ClassState> classes_{ClassState()};
+  std::unordered_map<chi::PoolId, TargetState> targets_;
+  std::unordered_map<TagId, chi::u32> tag_classes_;
+};
+
+}  // namespace wrp_cte::core
+
+#endif  // WRPCTE_CORE_QOS_SCHEDULER_H_
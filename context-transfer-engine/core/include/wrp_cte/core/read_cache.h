@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef WRPCTE_CORE_READ_CACHE_H_
+#define WRPCTE_CORE_READ_CACHE_H_
+
+#include <chimaera/chimaera.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace wrp_cte::core {
+
+/**
+ * Byte-bounded LRU cache with TinyLFU admission.
+ *
+ * Every access is counted in a count-min sketch of 4-bit counters that
+ * halve once the sketch has seen ten samples per counter, so frequencies
+ * follow recent traffic. A new entry is admitted only if it was accessed
+ * more often than each LRU entry it would push out; a scan of blobs read
+ * once therefore cannot flush the hot set. The cache only tracks entries:
+ * storing the bytes, and freeing the space of evicted entries, is up to
+ * the caller. Not thread safe.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class TinyLfuCache {
+ public:
+  /** An entry pushed out by Admit or removed by Erase */
+  struct Evicted {
+    Key key_;
+    Value value_;
+    chi::u64 size_;
+  };
+
+  /**
+   * @param capacity Bytes the entries may hold in total
+   * @param sketch_width Counters per sketch row (rounded up to a power
+   *        of two); about the number of distinct keys worth telling apart
+   */
+  explicit TinyLfuCache(chi::u64 capacity, size_t sketch_width = 4096)
+      : capacity_(capacity) {
+    size_t width = 64;
+    while (width < sketch_width) {
+      width <<= 1;
+    }
+    mask_ = width - 1;
+    sketch_.assign(kRows * width / 2, 0);
+    sample_limit_ = 10 * width;
+  }
+
+  /**
+   * Count one access in the frequency sketch
+   * @param hash Hash of the accessed key
+   */
+  void Touch(chi::u64 hash) {
+    for (size_t row = 0; row < kRows; ++row) {
+      size_t idx = Index(hash, row);
+      hshm::u8 &cell = sketch_[idx / 2];
+      unsigned shift = (idx & 1) * 4;
+      if (((cell >> shift) & 0xF) != 0xF) {
+        cell = static_cast<hshm::u8>(cell + (1u << shift));
+      }
+    }
+    if (++samples_ >= sample_limit_) {
+      Age();
+    }
+  }
+
+  /**
+   * Estimated recent accesses of a key
+   * @param hash Hash of the key
+   * @return Smallest counter over the sketch rows (0-15)
+   */
+  chi::u32 Frequency(chi::u64 hash) const {
+    chi::u32 freq = 0xF;
+    for (size_t row = 0; row < kRows; ++row) {
+      size_t idx = Index(hash, row);
+      chi::u32 count = (sketch_[idx / 2] >> ((idx & 1) * 4)) & 0xF;
+      freq = std::min(freq, count);
+    }
+    return freq;
+  }
+
+  /**
+   * Look up an entry, marking it most recently used
+   * @param key Key to look up
+   * @return The entry's value, or nullptr if absent
+   */
+  Value *Find(const Key &key) {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return &it->second->value_;
+  }
+
+  /**
+   * Decide whether a new entry of size bytes may come in. If so, the LRU
+   * entries it displaces are removed and returned, and its bytes are held
+   * for it until Insert or Cancel.
+   * @param hash Hash of the candidate key
+   * @param size Bytes the candidate needs
+   * @param victims Output: entries removed to make room
+   * @return true if the candidate is admitted
+   */
+  bool Admit(chi::u64 hash, chi::u64 size, std::vector<Evicted> &victims) {
+    victims.clear();
+    if (size == 0 || size > capacity_) {
+      return false;
+    }
+    chi::u32 freq = Frequency(hash);
+    chi::u64 free_bytes = capacity_ - std::min(capacity_, used_ + held_);
+    auto it = lru_.end();
+    size_t count = 0;
+    while (free_bytes < size && it != lru_.begin()) {
+      --it;
+      if (Frequency(it->hash_) >= freq) {
+        return false;
+      }
+      free_bytes += it->size_;
+      ++count;
+    }
+    if (free_bytes < size) {
+      return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      Entry &victim = lru_.back();
+      index_.erase(victim.key_);
+      used_ -= victim.size_;
+      victims.push_back(
+          Evicted{std::move(victim.key_), std::move(victim.value_),
+                  victim.size_});
+      lru_.pop_back();
+    }
+    held_ += size;
+    return true;
+  }
+
+  /**
+   * Add an admitted entry as most recently used. An existing entry of the
+   * same key is replaced and returned in replaced.
+   * @param key Key of the entry
+   * @param hash Hash of the key, as given to Admit
+   * @param size Bytes held for it by Admit
+   * @param value Value to store
+   * @param replaced Output: entry the key held before, if any
+   * @return true if an entry was replaced
+   */
+  bool Insert(const Key &key, chi::u64 hash, chi::u64 size, Value value,
+              Evicted &replaced) {
+    held_ -= std::min(held_, size);
+    bool had = Erase(key, replaced);
+    lru_.push_front(Entry{key, std::move(value), hash, size});
+    index_.emplace(key, lru_.begin());
+    used_ += size;
+    return had;
+  }
+
+  /**
+   * Give back the bytes Admit held for a candidate that was not inserted
+   * @param size Bytes passed to Admit
+   */
+  void Cancel(chi::u64 size) { held_ -= std::min(held_, size); }
+
+  /**
+   * Remove an entry
+   * @param key Key to remove
+   * @param removed Output: the removed entry
+   * @return true if the key was cached
+   */
+  bool Erase(const Key &key, Evicted &removed) {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      return false;
+    }
+    auto entry = it->second;
+    index_.erase(it);
+    used_ -= entry->size_;
+    removed = Evicted{std::move(entry->key_), std::move(entry->value_),
+                      entry->size_};
+    lru_.erase(entry);
+    return true;
+  }
+
+  /** @return Number of cached entries */
+  size_t Size() const { return lru_.size(); }
+
+  /** @return Bytes held by cached entries */
+  chi::u64 GetUsedBytes() const { return used_; }
+
+  /** @return Capacity in bytes */
+  chi::u64 GetCapacity() const { return capacity_; }
+
+ private:
+  static constexpr size_t kRows = 4;
+
+  struct Entry {
+    Key key_;
+    Value value_;
+    chi::u64 hash_;
+    chi::u64 size_;
+  };
+
+  /** Counter of a key in one row; rows use independent mixes of the hash */
+  size_t Index(chi::u64 hash, size_t row) const {
+    chi::u64 h = (hash + row) * 0x9e3779b97f4a7c15ULL;
+    h ^= h >> 29;
+    return (static_cast<size_t>(h) & mask_) + row * (mask_ + 1);
+  }
+
+  /** Halve every counter */
+  void Age() {
+    for (auto &cell : sketch_) {
+      cell = static_cast<hshm::u8>((cell >> 1) & 0x77);
+    }
+    samples_ /= 2;
+  }
+
+  chi::u64 capacity_;
+  chi::u64 used_ = 0;
+  chi::u64 held_ = 0;  // Bytes admitted but not yet inserted
+  size_t mask_ = 0;
+  std::vector<hshm::u8> sketch_;  // Two 4-bit counters per byte
+  size_t samples_ = 0;
+  size_t sample_limit_ = 0;
+  std::list<Entry> lru_;  // Most recently used first
+  std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> index_;
+};
+
+}  // namespace wrp_cte::core
+
+#endif  // WRPCTE_CORE_READ_CACHE_H_
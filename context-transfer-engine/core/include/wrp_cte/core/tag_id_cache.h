@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef WRPCTE_CORE_TAG_ID_CACHE_H_
+#define WRPCTE_CORE_TAG_ID_CACHE_H_
+
+#include <wrp_cte/core/core_tasks.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace wrp_cte::core {
+
+/**
+ * Process-wide cache of tag name to TagId, so that opening a tag by name a
+ * second time costs no GetOrCreateTag round trip. DelTag through this
+ * process drops the entry at once. Deletions by other processes are only
+ * noticed once an entry's lease time runs out, which bounds how long a
+ * recreated tag can be reached under its old ID.
+ */
+class TagIdCache {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /** Entries kept before the cache is cleared */
+  static constexpr size_t kMaxEntries = 65536;
+  /** Default lease time of an entry in milliseconds */
+  static constexpr chi::u32 kDefaultTtlMs = 5000;
+
+  /**
+   * Look up the ID of \a tag_name
+   * @param tag_id Output tag ID on a hit
+   * @return False on a miss or an expired entry
+   */
+  bool Get(const std::string &tag_name, TagId &tag_id) {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = entries_.find(tag_name);
+    if (it == entries_.end()) {
+      return false;
+    }
+    if (Clock::now() >= it->second.expires_) {
+      entries_.erase(it);
+      return false;
+    }
+    tag_id = it->second.tag_id_;
+    return true;
+  }
+
+  /** Cache the ID of \a tag_name after GetOrCreateTag returned it */
+  void Put(const std::string &tag_name, const TagId &tag_id) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (ttl_.count() == 0 || tag_id.IsNull()) {
+      return;
+    }
+    if (entries_.size() >= kMaxEntries && !entries_.count(tag_name)) {
+      entries_.clear();
+    }
+    Entry &entry = entries_[tag_name];
+    entry.tag_id_ = tag_id;
+    entry.expires_ = Clock::now() + ttl_;
+  }
+
+  /** Drop the entry of \a tag_name, e.g. before the tag is deleted */
+  void Erase(const std::string &tag_name) {
+    std::lock_guard<std::mutex> guard(lock_);
+    entries_.erase(tag_name);
+  }
+
+  /** Drop every entry that maps to \a tag_id */
+  void Erase(const TagId &tag_id) {
+    std::lock_guard<std::mutex> guard(lock_);
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (it->second.tag_id_ == tag_id) {
+        it = entries_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  /**
+   * Set the lease time of new entries
+   * @param ttl_ms Lease time in milliseconds (0 = disable and clear)
+   */
+  void SetTtl(chi::u32 ttl_ms) {
+    std::lock_guard<std::mutex> guard(lock_);
+    ttl_ = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::milliseconds(ttl_ms));
+    if (ttl_ms == 0) {
+      entries_.clear();
+    }
+  }
+
+ private:
+  /** Cached ID of one tag */
+  struct Entry {
+    TagId tag_id_;
+    Clock::time_point expires_;
+  };
+
+  std::unordered_map<std::string, Entry> entries_;
+  Clock::duration ttl_ = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::milliseconds(kDefaultTtlMs));
+  std::mutex lock_;
+};
+
+}  // namespace wrp_cte::core
+
+#endif  // WRPCTE_CORE_TAG_ID_CACHE_H_
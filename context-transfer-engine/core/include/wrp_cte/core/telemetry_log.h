@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef WRPCTE_CORE_TELEMETRY_LOG_H_
+#define WRPCTE_CORE_TELEMETRY_LOG_H_
+
+#include <wrp_cte/core/core_tasks.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace wrp_cte::core {
+
+/**
+ * Sharded telemetry log with one single-producer ring per worker.
+ *
+ * Each worker appends only to its own shard, so logging never touches a
+ * cache line written by another core. Readers take a non-destructive
+ * snapshot of every shard and merge the entries by logical time. A slot is
+ * protected by a sequence number: a reader that races with the owner
+ * overwriting the slot sees the number change and drops the copy.
+ *
+ * Logical times need no shared counter. The upper bits are a coarse clock
+ * shared by all workers and the low kShardBits hold the shard index, so
+ * times are unique, strictly increasing within a shard and ordered across
+ * shards to within the clock granularity.
+ */
+class TelemetryLog {
+ public:
+  /** Bits of a logical time that hold the shard index */
+  static constexpr chi::u32 kShardBits = 10;
+  /** Largest number of shards; more workers share shards by modulo */
+  static constexpr chi::u32 kMaxShards = 1u << kShardBits;
+  /** Clock ticks per logical time step (16ns) */
+  static constexpr chi::u32 kTickShift = 4;
+
+  TelemetryLog() = default;
+  TelemetryLog(const TelemetryLog &) = delete;
+  TelemetryLog &operator=(const TelemetryLog &) = delete;
+
+  /**
+   * Allocate the shards and drop every entry
+   * @param num_shards Number of producers (one per worker)
+   * @param capacity Entries kept per shard, rounded up to a power of two
+   * @param sample_rate Record one of every sample_rate events (0 or 1 = all)
+   */
+  void Init(chi::u32 num_shards, size_t capacity, chi::u32 sample_rate) {
+    num_shards = std::min(std::max(num_shards, (chi::u32)1), kMaxShards);
+    size_t cap = 1;
+    while (cap < std::max(capacity, (size_t)1)) cap <<= 1;
+    capacity_ = cap;
+    sample_rate_ = std::max(sample_rate, (chi::u32)1);
+    num_shards_ = num_shards;
+    shards_ = std::make_unique<Shard[]>(num_shards);
+    for (chi::u32 i = 0; i < num_shards; ++i) {
+      shards_[i].slots_ = std::make_unique<Slot[]>(cap);
+    }
+    epoch_ = std::chrono::steady_clock::now();
+  }
+
+  /**
+   * Record an event. Must only be called by the owner of the shard.
+   * @param shard Producer index (taken modulo the shard count)
+   * @param entry Event to record; its logical_time_ is assigned here
+   * @return True if the event was sampled
+   */
+  bool Log(chi::u32 shard, CteTelemetry entry) {
+    if (num_shards_ == 0) return false;
+    shard %= num_shards_;
+    Shard &s = shards_[shard];
+    if (sample_rate_ > 1 && (s.events_++ % sample_rate_) != 0) {
+      return false;
+    }
+
+    // Unique per shard and monotonic even if the clock stalls
+    std::uint64_t ticks =
+        (static_cast<std::uint64_t>(
+             std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 std::chrono::steady_clock::now() - epoch_)
+                 .count()) >>
+         kTickShift) +
+        1;
+    std::uint64_t logical_time = (ticks << kShardBits) | shard;
+    if (logical_time <= s.last_time_) {
+      logical_time = s.last_time_ + kMaxShards;
+    }
+    s.last_time_ = logical_time;
+    entry.logical_time_ = logical_time;
+
+    // Odd sequence while the slot is being written
+    std::uint64_t idx = s.tail_.load(std::memory_order_relaxed);
+    Slot &slot = s.slots_[idx & (capacity_ - 1)];
+    slot.seq_.store(2 * idx + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.entry_ = entry;
+    slot.seq_.store(2 * idx + 2, std::memory_order_release);
+    s.tail_.store(idx + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Copy the retained entries at or after a logical time, oldest first
+   * @param entries Output, replaced
+   * @param min_logical_time Smallest logical time to return
+   * @param max_entries Keep only the oldest max_entries matches
+   * @return Number of entries returned
+   */
+  size_t Collect(std::vector<CteTelemetry> &entries,
+                 std::uint64_t min_logical_time, size_t max_entries) const {
+    entries.clear();
+    for (chi::u32 i = 0; i < num_shards_; ++i) {
+      const Shard &s = shards_[i];
+      std::uint64_t tail = s.tail_.load(std::memory_order_acquire);
+      std::uint64_t begin = tail > capacity_ ? tail - capacity_ : 0;
+      for (std::uint64_t idx = begin; idx < tail; ++idx) {
+        const Slot &slot = s.slots_[idx & (capacity_ - 1)];
+        std::uint64_t seq = slot.seq_.load(std::memory_order_acquire);
+        if (seq != 2 * idx + 2) continue;  // Overwritten or in progress
+        CteTelemetry entry = slot.entry_;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq_.load(std::memory_order_relaxed) != seq) continue;
+        if (entry.logical_time_ >= min_logical_time) {
+          entries.push_back(entry);
+        }
+      }
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const CteTelemetry &a, const CteTelemetry &b) {
+                return a.logical_time_ < b.logical_time_;
+              });
+    if (entries.size() > max_entries) {
+      entries.resize(max_entries);
+    }
+    return entries.size();
+  }
+
+  /** Number of entries currently retained over all shards */
+  size_t Size() const {
+    size_t total = 0;
+    for (chi::u32 i = 0; i < num_shards_; ++i) {
+      std::uint64_t tail = shards_[i].tail_.load(std::memory_order_acquire);
+      total += static_cast<size_t>(std::min<std::uint64_t>(tail, capacity_));
+    }
+    return total;
+  }
+
+  /** Entries kept per shard */
+  size_t GetCapacity() const { return capacity_; }
+
+  /** Number of shards */
+  chi::u32 GetNumShards() const { return num_shards_; }
+
+  /** One of every GetSampleRate() events is recorded */
+  chi::u32 GetSampleRate() const { return sample_rate_; }
+
+ private:
+  /** One ring slot; seq_ is 2 * index + 2 once the entry is complete */
+  struct Slot {
+    std::atomic<std::uint64_t> seq_{0};
+    CteTelemetry entry_;
+  };
+
+  /** Ring owned by one worker, padded so shards never share a line */
+  struct alignas(64) Shard {
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<std::uint64_t> tail_{0};  // Entries ever written
+    std::uint64_t events_ = 0;     // Events seen, sampled or not (owner only)
+    std::uint64_t last_time_ = 0;  // Last logical time issued (owner only)
+  };
+
+  std::unique_ptr<Shard[]> shards_;
+  chi::u32 num_shards_ = 0;
+  size_t capacity_ = 0;
+  chi::u32 sample_rate_ = 1;
+  std::chrono::steady_clock::time_point epoch_;
+};
+
+}  // namespace wrp_cte::core
+
+#endif  // WRPCTE_CORE_TELEMETRY_LOG_H_
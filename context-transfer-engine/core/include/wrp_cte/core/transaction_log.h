@@ -35,7 +35,16 @@
 #define WRPCTE_CORE_TRANSACTION_LOG_H_
 
 #include <chimaera/chimaera.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
@@ -53,6 +62,12 @@ enum class TxnType : uint8_t {
   kDelBlob = 3,
   kCreateTag = 4,
   kDelTag = 5,
+  kSetBlobLayout = 6,
+  kSetBlobCipher = 7,
+  kAddPackSegment = 8,
+  kFreePackSegment = 9,
+  kSetBlobStub = 10,
+  kSetTagPolicy = 11,
 };
 
 /** A single block entry within TxnExtendBlob */
@@ -80,6 +95,62 @@ struct TxnExtendBlob {
   std::vector<TxnExtendBlobBlock> new_blocks_;
 };
 
+/** Payload: erasure-code layout of a blob's blocks (k = 0: plain blocks) */
+struct TxnBlobLayout {
+  chi::u32 tag_major_;
+  chi::u32 tag_minor_;
+  std::string blob_name_;
+  chi::u32 data_shards_;
+  chi::u32 parity_shards_;
+  chi::u64 shard_size_;
+  chi::u64 blob_size_;
+};
+
+/** Payload: chunking of an encrypted blob's sealed blocks */
+struct TxnBlobCipher {
+  chi::u32 tag_major_;
+  chi::u32 tag_minor_;
+  std::string blob_name_;
+  chi::u32 chunk_size_;
+  chi::u64 blob_size_;
+};
+
+/** Payload: the source file range a stub blob is read from */
+struct TxnBlobStub {
+  chi::u32 tag_major_;
+  chi::u32 tag_minor_;
+  std::string blob_name_;
+  std::string source_path_;
+  chi::u64 source_offset_;
+  chi::u64 size_;
+  chi::u32 flags_;
+  float score_;
+};
+
+/**
+ * Payload: a tag's replication factor, placement policy and dedup chunk
+ * size, logged whole whenever one of them changes
+ */
+struct TxnTagPolicy {
+  chi::u32 tag_major_;
+  chi::u32 tag_minor_;
+  chi::u32 replicas_;
+  chi::u32 placement_policy_;
+  chi::u32 stripe_pages_;
+  chi::u32 pin_container_;
+  chi::u32 follow_major_;
+  chi::u32 follow_minor_;
+  chi::u64 dedup_chunk_;
+};
+
+/** Payload: a small-object segment allocated on (or freed from) a target */
+struct TxnPackSegment {
+  chi::u32 bdev_major_;
+  chi::u32 bdev_minor_;
+  chi::u64 base_;
+  chi::u64 size_;
+};
+
 /** Payload: clear all blocks from a blob */
 struct TxnClearBlob {
   chi::u32 tag_major_;
@@ -109,156 +180,370 @@ struct TxnDelTag {
 };
 
 /**
- * Header-only Write-Ahead Transaction Log.
+ * Read-only memory mapping of a whole file, used to scan logs and
+ * checkpoints without copying them through stream buffers
+ */
+class MappedFile {
+ public:
+  MappedFile() = default;
+  ~MappedFile() { Close(); }
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  /**
+   * Map a file for sequential reading
+   * @param path File to map
+   * @return false if the file cannot be opened or mapped
+   */
+  bool Open(const std::string &path) {
+    Close();
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat st;
+    bool ok = fstat(fd, &st) == 0;
+    size_ = ok ? static_cast<size_t>(st.st_size) : 0;
+    if (ok && size_ > 0) {
+      void *addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr == MAP_FAILED) {
+        ok = false;
+        size_ = 0;
+      } else {
+        data_ = static_cast<const char *>(addr);
+        madvise(addr, size_, MADV_SEQUENTIAL);
+      }
+    }
+    close(fd);
+    return ok;
+  }
+
+  /** Unmap the file */
+  void Close() {
+    if (data_ != nullptr) {
+      munmap(const_cast<char *>(data_), size_);
+      data_ = nullptr;
+    }
+    size_ = 0;
+  }
+
+  const char *data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  const char *data_ = nullptr;
+  size_t size_ = 0;
+};
+
+/**
+ * Header-only Write-Ahead Transaction Log with group commit.
+ *
+ * The log is a sequence of segment files "<path>.seg<N>". Each segment is
+ * preallocated to the segment size and starts with a kSegmentHeaderSize
+ * header (magic, version, sequence number). Records follow back to back:
+ *   [u32 crc32c][u8 txn_type][u32 payload_size][payload bytes]
+ * The CRC covers the type, size and payload. Replay of a segment stops at
+ * the first record that fails its CRC, which is where the last writer
+ * stopped (the preallocated tail reads as zeros).
  *
- * Record format on disk:
- *   [u8 txn_type][u32 payload_size][payload bytes]
+ * Log() only serializes into an in-memory buffer shared by all tasks that
+ * log here. Sync() writes everything buffered with one pwrite and one
+ * fdatasync (group commit); Log() also commits on its own once
+ * kMaxPendingBytes are buffered. Segments are opened with O_DIRECT where the
+ * file system supports it, so every commit writes whole 4KB blocks and
+ * rewrites the last partial one.
  *
- * The payload bytes are a simple binary serialization (not cereal) so the
- * on-disk format is self-contained.
+ * A legacy single-file log at <path> (records without CRC) is still read by
+ * Load() so that logs written by older versions replay once.
  */
 class TransactionLog {
  public:
-  TransactionLog() = default;
+  static constexpr chi::u64 kDefaultSegmentBytes = 4ULL * 1024 * 1024;
+  static constexpr chi::u64 kMinSegmentBytes = 64ULL * 1024;
+  static constexpr size_t kMaxPendingBytes = 256 * 1024;
+  static constexpr size_t kBlockSize = 4096;
+  static constexpr size_t kSegmentHeaderSize = 64;
+  static constexpr size_t kRecordHeaderSize = 9;  // crc + type + size
+  static constexpr chi::u32 kSegmentMagic = 0x4C415743;  // "CWAL"
+  static constexpr chi::u32 kSegmentVersion = 1;
+
+  TransactionLog() { lock_.Init(); }
   ~TransactionLog() { Close(); }
+  TransactionLog(const TransactionLog &) = delete;
+  TransactionLog &operator=(const TransactionLog &) = delete;
 
-  /** Open (or create) the WAL file in append mode. */
-  void Open(const std::string &file_path, chi::u64 capacity_bytes) {
+  /**
+   * Open (or create) the WAL. Appends resume after the last valid record of
+   * the newest existing segment; new segments are created on demand.
+   * @param file_path Base path of the log
+   * @param capacity_bytes Capacity budget (compaction is driven by Size())
+   * @param segment_bytes Preallocated size of each segment file
+   */
+  void Open(const std::string &file_path, chi::u64 capacity_bytes,
+            chi::u64 segment_bytes = kDefaultSegmentBytes) {
+    Close();
+    hshm::ScopedMutex guard(lock_, 0);
     file_path_ = file_path;
     capacity_bytes_ = capacity_bytes;
-    buffer_.reserve(4096);
-    ofs_.open(file_path_,
-              std::ios::binary | std::ios::app);
+    segment_bytes_ = AlignUp(std::max(segment_bytes, kMinSegmentBytes));
+    pending_.reserve(kMaxPendingBytes);
+    seq_ = 0;
+    sealed_bytes_ = 0;
+    durable_off_ = 0;
+
+    // Find the newest segment; the older ones only count towards Size()
+    chi::u64 num_segments = 0;
+    while (std::filesystem::exists(SegmentPath(file_path_, num_segments))) {
+      ++num_segments;
+    }
+    if (num_segments == 0) {
+      PublishSize();
+      return;
+    }
+    for (chi::u64 i = 0; i + 1 < num_segments; ++i) {
+      sealed_bytes_ += ScanSegment(SegmentPath(file_path_, i));
+    }
+    seq_ = num_segments - 1;
+    chi::u64 end = ScanSegment(SegmentPath(file_path_, seq_));
+    if (end < kSegmentHeaderSize || !OpenSegmentFile(false) ||
+        !LoadTailBlock(end)) {
+      // Unreadable head segment: start a fresh one after it
+      CloseSegmentFile();
+      seq_ = num_segments;
+      PublishSize();
+      return;
+    }
+    durable_off_ = end;
+    PublishSize();
   }
 
   // ---- Log helpers for each transaction type ----
 
   void Log(TxnType type, const TxnCreateNewBlob &txn) {
-    buffer_.clear();
-    WriteU32(buffer_, txn.tag_major_);
-    WriteU32(buffer_, txn.tag_minor_);
-    WriteString(buffer_, txn.blob_name_);
-    WriteFloat(buffer_, txn.score_);
-    WriteRecord(type, buffer_);
+    hshm::ScopedMutex guard(lock_, 0);
+    size_t rec = BeginRecord(type);
+    WriteU32(pending_, txn.tag_major_);
+    WriteU32(pending_, txn.tag_minor_);
+    WriteString(pending_, txn.blob_name_);
+    WriteFloat(pending_, txn.score_);
+    EndRecord(rec);
   }
 
   void Log(TxnType type, const TxnExtendBlob &txn) {
-    buffer_.clear();
-    WriteU32(buffer_, txn.tag_major_);
-    WriteU32(buffer_, txn.tag_minor_);
-    WriteString(buffer_, txn.blob_name_);
-    WriteU32(buffer_, static_cast<chi::u32>(txn.new_blocks_.size()));
+    hshm::ScopedMutex guard(lock_, 0);
+    size_t rec = BeginRecord(type);
+    WriteU32(pending_, txn.tag_major_);
+    WriteU32(pending_, txn.tag_minor_);
+    WriteString(pending_, txn.blob_name_);
+    WriteU32(pending_, static_cast<chi::u32>(txn.new_blocks_.size()));
     for (const auto &blk : txn.new_blocks_) {
-      WriteU32(buffer_, blk.bdev_major_);
-      WriteU32(buffer_, blk.bdev_minor_);
-      WriteRaw(buffer_, &blk.target_query_, sizeof(chi::PoolQuery));
-      WriteU64(buffer_, blk.target_offset_);
-      WriteU64(buffer_, blk.size_);
+      WriteU32(pending_, blk.bdev_major_);
+      WriteU32(pending_, blk.bdev_minor_);
+      WriteRaw(pending_, &blk.target_query_, sizeof(chi::PoolQuery));
+      WriteU64(pending_, blk.target_offset_);
+      WriteU64(pending_, blk.size_);
     }
-    WriteRecord(type, buffer_);
+    EndRecord(rec);
+  }
+
+  void Log(TxnType type, const TxnBlobLayout &txn) {
+    hshm::ScopedMutex guard(lock_, 0);
+    size_t rec = BeginRecord(type);
+    WriteU32(pending_, txn.tag_major_);
+    WriteU32(pending_, txn.tag_minor_);
+    WriteString(pending_, txn.blob_name_);
+    WriteU32(pending_, txn.data_shards_);
+    WriteU32(pending_, txn.parity_shards_);
+    WriteU64(pending_, txn.shard_size_);
+    WriteU64(pending_, txn.blob_size_);
+    EndRecord(rec);
+  }
+
+  void Log(TxnType type, const TxnBlobCipher &txn) {
+    hshm::ScopedMutex guard(lock_, 0);
+    size_t rec = BeginRecord(type);
+    WriteU32(pending_, txn.tag_major_);
+    WriteU32(pending_, txn.tag_minor_);
+    WriteString(pending_, txn.blob_name_);
+    WriteU32(pending_, txn.chunk_size_);
+    WriteU64(pending_, txn.blob_size_);
+    EndRecord(rec);
+  }
+
+  void Log(TxnType type, const TxnBlobStub &txn) {
+    hshm::ScopedMutex guard(lock_, 0);
+    size_t rec = BeginRecord(type);
+    WriteU32(pending_, txn.tag_major_);
+    WriteU32(pending_, txn.tag_minor_);
+    WriteString(pending_, txn.blob_name_);
+    WriteString(pending_, txn.source_path_);
+    WriteU64(pending_, txn.source_offset_);
+    WriteU64(pending_, txn.size_);
+    WriteU32(pending_, txn.flags_);
+    WriteFloat(pending_, txn.score_);
+    EndRecord(rec);
+  }
+
+  void Log(TxnType type, const TxnTagPolicy &txn) {
+    hshm::ScopedMutex guard(lock_, 0);
+    size_t rec = BeginRecord(type);
+    WriteU32(pending_, txn.tag_major_);
+    WriteU32(pending_, txn.tag_minor_);
+    WriteU32(pending_, txn.replicas_);
+    WriteU32(pending_, txn.placement_policy_);
+    WriteU32(pending_, txn.stripe_pages_);
+    WriteU32(pending_, txn.pin_container_);
+    WriteU32(pending_, txn.follow_major_);
+    WriteU32(pending_, txn.follow_minor_);
+    WriteU64(pending_, txn.dedup_chunk_);
+    EndRecord(rec);
+  }
+
+  void Log(TxnType type, const TxnPackSegment &txn) {
+    hshm::ScopedMutex guard(lock_, 0);
+    size_t rec = BeginRecord(type);
+    WriteU32(pending_, txn.bdev_major_);
+    WriteU32(pending_, txn.bdev_minor_);
+    WriteU64(pending_, txn.base_);
+    WriteU64(pending_, txn.size_);
+    EndRecord(rec);
   }
 
   void Log(TxnType type, const TxnClearBlob &txn) {
-    buffer_.clear();
-    WriteU32(buffer_, txn.tag_major_);
-    WriteU32(buffer_, txn.tag_minor_);
-    WriteString(buffer_, txn.blob_name_);
-    WriteRecord(type, buffer_);
+    hshm::ScopedMutex guard(lock_, 0);
+    size_t rec = BeginRecord(type);
+    WriteU32(pending_, txn.tag_major_);
+    WriteU32(pending_, txn.tag_minor_);
+    WriteString(pending_, txn.blob_name_);
+    EndRecord(rec);
   }
 
   void Log(TxnType type, const TxnDelBlob &txn) {
-    buffer_.clear();
-    WriteU32(buffer_, txn.tag_major_);
-    WriteU32(buffer_, txn.tag_minor_);
-    WriteString(buffer_, txn.blob_name_);
-    WriteRecord(type, buffer_);
+    hshm::ScopedMutex guard(lock_, 0);
+    size_t rec = BeginRecord(type);
+    WriteU32(pending_, txn.tag_major_);
+    WriteU32(pending_, txn.tag_minor_);
+    WriteString(pending_, txn.blob_name_);
+    EndRecord(rec);
   }
 
   void Log(TxnType type, const TxnCreateTag &txn) {
-    buffer_.clear();
-    WriteString(buffer_, txn.tag_name_);
-    WriteU32(buffer_, txn.tag_major_);
-    WriteU32(buffer_, txn.tag_minor_);
-    WriteRecord(type, buffer_);
+    hshm::ScopedMutex guard(lock_, 0);
+    size_t rec = BeginRecord(type);
+    WriteString(pending_, txn.tag_name_);
+    WriteU32(pending_, txn.tag_major_);
+    WriteU32(pending_, txn.tag_minor_);
+    EndRecord(rec);
   }
 
   void Log(TxnType type, const TxnDelTag &txn) {
-    buffer_.clear();
-    WriteString(buffer_, txn.tag_name_);
-    WriteU32(buffer_, txn.tag_major_);
-    WriteU32(buffer_, txn.tag_minor_);
-    WriteRecord(type, buffer_);
+    hshm::ScopedMutex guard(lock_, 0);
+    size_t rec = BeginRecord(type);
+    WriteString(pending_, txn.tag_name_);
+    WriteU32(pending_, txn.tag_major_);
+    WriteU32(pending_, txn.tag_minor_);
+    EndRecord(rec);
   }
 
-  /** Flush pending writes to disk */
-  void Sync() {
-    if (ofs_.is_open()) {
-      ofs_.flush();
-    }
+  /**
+   * Group commit: make every record logged so far durable with one write
+   * and one fdatasync
+   * @return false if the write failed (the batch is dropped)
+   */
+  bool Sync() {
+    hshm::ScopedMutex guard(lock_, 0);
+    return Commit();
+  }
+
+  /** @return true if records are waiting for the next Sync() */
+  bool HasPending() {
+    hshm::ScopedMutex guard(lock_, 0);
+    return !pending_.empty();
+  }
+
+  /** Return the logical size of the log, including buffered records */
+  chi::u64 Size() {
+    hshm::ScopedMutex guard(lock_, 0);
+    return sealed_bytes_ + durable_off_ + pending_.size();
   }
 
-  /** Return current on-disk file size */
-  chi::u64 Size() const {
-    namespace fs = std::filesystem;
-    if (fs::exists(file_path_)) {
-      return static_cast<chi::u64>(fs::file_size(file_path_));
+  /** @return Committed size of the log; lock-free, for metrics */
+  chi::u64 DurableBytes() const {
+    return durable_bytes_.load(std::memory_order_relaxed);
+  }
+
+  /** @return Total bytes ever committed by this process; lock-free */
+  chi::u64 CommittedBytesTotal() const {
+    return committed_total_.load(std::memory_order_relaxed);
+  }
+
+  /** @return true if a log (segmented or legacy) exists at file_path */
+  static bool Exists(const std::string &file_path) {
+    return std::filesystem::exists(SegmentPath(file_path, 0)) ||
+           std::filesystem::exists(file_path);
+  }
+
+  /**
+   * Visit every valid record on disk, oldest first. Files are memory
+   * mapped and payloads are passed in place, without a copy per record.
+   * @param fn Callable as fn(TxnType type, const char *payload, size_t size);
+   *        the payload is only valid during the call
+   */
+  template <typename Func>
+  void ForEachRecord(Func fn) const {
+    ScanLegacy(fn);
+    for (chi::u64 i = 0;; ++i) {
+      std::string path = SegmentPath(file_path_, i);
+      if (!std::filesystem::exists(path)) break;
+      ScanSegment(path, fn);
     }
-    return 0;
   }
 
   /**
-   * Load all entries from the WAL file on disk.
+   * Load all entries from the WAL on disk, oldest first.
    * Returns a vector of (TxnType, raw payload bytes).
    */
   std::vector<std::pair<TxnType, std::vector<char>>> Load() const {
     std::vector<std::pair<TxnType, std::vector<char>>> entries;
-    namespace fs = std::filesystem;
-    if (!fs::exists(file_path_)) return entries;
-
-    std::ifstream ifs(file_path_, std::ios::binary);
-    if (!ifs.is_open()) return entries;
-
-    while (ifs.peek() != EOF) {
-      uint8_t type_byte;
-      ifs.read(reinterpret_cast<char *>(&type_byte), sizeof(type_byte));
-      if (!ifs.good()) break;
-
-      uint32_t payload_size;
-      ifs.read(reinterpret_cast<char *>(&payload_size), sizeof(payload_size));
-      if (!ifs.good()) break;
-
-      std::vector<char> payload(payload_size);
-      ifs.read(payload.data(), payload_size);
-      if (!ifs.good() && static_cast<uint32_t>(ifs.gcount()) != payload_size)
-        break;
-
-      entries.emplace_back(static_cast<TxnType>(type_byte), std::move(payload));
-    }
+    ForEachRecord([&entries](TxnType type, const char *data, size_t size) {
+      entries.emplace_back(type, std::vector<char>(data, data + size));
+    });
     return entries;
   }
 
-  /** Truncate the WAL file (called after a full snapshot compaction) */
+  /** Drop the whole WAL (called after a full snapshot compaction) */
   void Truncate() {
-    if (ofs_.is_open()) {
-      ofs_.close();
+    hshm::ScopedMutex guard(lock_, 0);
+    pending_.clear();
+    CloseSegmentFile();
+    std::error_code ec;
+    for (chi::u64 i = 0;; ++i) {
+      std::string path = SegmentPath(file_path_, i);
+      if (!std::filesystem::exists(path)) break;
+      std::filesystem::remove(path, ec);
     }
-    // Re-open in truncate mode then re-open in append mode
-    ofs_.open(file_path_, std::ios::binary | std::ios::trunc);
-    ofs_.close();
-    ofs_.open(file_path_, std::ios::binary | std::ios::app);
+    std::filesystem::remove(file_path_, ec);
+    seq_ = 0;
+    sealed_bytes_ = 0;
+    durable_off_ = 0;
+    PublishSize();
   }
 
   /** Sync then close the file handle */
   void Close() {
-    if (ofs_.is_open()) {
-      ofs_.flush();
-      ofs_.close();
-    }
+    hshm::ScopedMutex guard(lock_, 0);
+    Commit();
+    CloseSegmentFile();
+    std::free(stage_);
+    stage_ = nullptr;
+    stage_cap_ = 0;
   }
 
   // ---- Static deserialization helpers ----
 
   static TxnCreateNewBlob DeserializeCreateNewBlob(const std::vector<char> &data) {
+    return DeserializeCreateNewBlob(data.data());
+  }
+
+  static TxnCreateNewBlob DeserializeCreateNewBlob(const char *data) {
     TxnCreateNewBlob txn;
     size_t off = 0;
     txn.tag_major_ = ReadU32(data, off);
@@ -269,6 +554,10 @@ class TransactionLog {
   }
 
   static TxnExtendBlob DeserializeExtendBlob(const std::vector<char> &data) {
+    return DeserializeExtendBlob(data.data());
+  }
+
+  static TxnExtendBlob DeserializeExtendBlob(const char *data) {
     TxnExtendBlob txn;
     size_t off = 0;
     txn.tag_major_ = ReadU32(data, off);
@@ -287,7 +576,94 @@ class TransactionLog {
     return txn;
   }
 
+  static TxnBlobLayout DeserializeBlobLayout(const std::vector<char> &data) {
+    return DeserializeBlobLayout(data.data());
+  }
+
+  static TxnBlobLayout DeserializeBlobLayout(const char *data) {
+    TxnBlobLayout txn;
+    size_t off = 0;
+    txn.tag_major_ = ReadU32(data, off);
+    txn.tag_minor_ = ReadU32(data, off);
+    txn.blob_name_ = ReadString(data, off);
+    txn.data_shards_ = ReadU32(data, off);
+    txn.parity_shards_ = ReadU32(data, off);
+    txn.shard_size_ = ReadU64(data, off);
+    txn.blob_size_ = ReadU64(data, off);
+    return txn;
+  }
+
+  static TxnBlobCipher DeserializeBlobCipher(const std::vector<char> &data) {
+    return DeserializeBlobCipher(data.data());
+  }
+
+  static TxnBlobCipher DeserializeBlobCipher(const char *data) {
+    TxnBlobCipher txn;
+    size_t off = 0;
+    txn.tag_major_ = ReadU32(data, off);
+    txn.tag_minor_ = ReadU32(data, off);
+    txn.blob_name_ = ReadString(data, off);
+    txn.chunk_size_ = ReadU32(data, off);
+    txn.blob_size_ = ReadU64(data, off);
+    return txn;
+  }
+
+  static TxnBlobStub DeserializeBlobStub(const std::vector<char> &data) {
+    return DeserializeBlobStub(data.data());
+  }
+
+  static TxnBlobStub DeserializeBlobStub(const char *data) {
+    TxnBlobStub txn;
+    size_t off = 0;
+    txn.tag_major_ = ReadU32(data, off);
+    txn.tag_minor_ = ReadU32(data, off);
+    txn.blob_name_ = ReadString(data, off);
+    txn.source_path_ = ReadString(data, off);
+    txn.source_offset_ = ReadU64(data, off);
+    txn.size_ = ReadU64(data, off);
+    txn.flags_ = ReadU32(data, off);
+    txn.score_ = ReadFloat(data, off);
+    return txn;
+  }
+
+  static TxnTagPolicy DeserializeTagPolicy(const std::vector<char> &data) {
+    return DeserializeTagPolicy(data.data());
+  }
+
+  static TxnTagPolicy DeserializeTagPolicy(const char *data) {
+    TxnTagPolicy txn;
+    size_t off = 0;
+    txn.tag_major_ = ReadU32(data, off);
+    txn.tag_minor_ = ReadU32(data, off);
+    txn.replicas_ = ReadU32(data, off);
+    txn.placement_policy_ = ReadU32(data, off);
+    txn.stripe_pages_ = ReadU32(data, off);
+    txn.pin_container_ = ReadU32(data, off);
+    txn.follow_major_ = ReadU32(data, off);
+    txn.follow_minor_ = ReadU32(data, off);
+    txn.dedup_chunk_ = ReadU64(data, off);
+    return txn;
+  }
+
+  static TxnPackSegment DeserializePackSegment(const std::vector<char> &data) {
+    return DeserializePackSegment(data.data());
+  }
+
+  static TxnPackSegment DeserializePackSegment(const char *data) {
+    TxnPackSegment txn;
+    size_t off = 0;
+    txn.bdev_major_ = ReadU32(data, off);
+    txn.bdev_minor_ = ReadU32(data, off);
+    txn.base_ = ReadU64(data, off);
+    txn.size_ = ReadU64(data, off);
+    return txn;
+  }
+
   static TxnClearBlob DeserializeClearBlob(const std::vector<char> &data) {
+    return DeserializeClearBlob(data.data());
+  }
+
+  static TxnClearBlob DeserializeClearBlob(const char *data) {
     TxnClearBlob txn;
     size_t off = 0;
     txn.tag_major_ = ReadU32(data, off);
@@ -297,6 +673,10 @@ class TransactionLog {
   }
 
   static TxnDelBlob DeserializeDelBlob(const std::vector<char> &data) {
+    return DeserializeDelBlob(data.data());
+  }
+
+  static TxnDelBlob DeserializeDelBlob(const char *data) {
     TxnDelBlob txn;
     size_t off = 0;
     txn.tag_major_ = ReadU32(data, off);
@@ -306,6 +686,10 @@ class TransactionLog {
   }
 
   static TxnCreateTag DeserializeCreateTag(const std::vector<char> &data) {
+    return DeserializeCreateTag(data.data());
+  }
+
+  static TxnCreateTag DeserializeCreateTag(const char *data) {
     TxnCreateTag txn;
     size_t off = 0;
     txn.tag_name_ = ReadString(data, off);
@@ -315,6 +699,10 @@ class TransactionLog {
   }
 
   static TxnDelTag DeserializeDelTag(const std::vector<char> &data) {
+    return DeserializeDelTag(data.data());
+  }
+
+  static TxnDelTag DeserializeDelTag(const char *data) {
     TxnDelTag txn;
     size_t off = 0;
     txn.tag_name_ = ReadString(data, off);
@@ -323,21 +711,276 @@ class TransactionLog {
     return txn;
   }
 
+  /** CRC-32C (Castagnoli), table driven */
+  static chi::u32 Crc32c(const char *data, size_t len) {
+    static const std::array<chi::u32, 256> table = [] {
+      std::array<chi::u32, 256> t{};
+      for (chi::u32 i = 0; i < 256; ++i) {
+        chi::u32 c = i;
+        for (int k = 0; k < 8; ++k) {
+          c = (c & 1) ? (c >> 1) ^ 0x82F63B78u : c >> 1;
+        }
+        t[i] = c;
+      }
+      return t;
+    }();
+    chi::u32 crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; ++i) {
+      crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+  }
+
  private:
   std::string file_path_;
   chi::u64 capacity_bytes_ = 0;
-  std::ofstream ofs_;
-  std::vector<char> buffer_;  // Reusable serialization buffer
+  chi::u64 segment_bytes_ = kDefaultSegmentBytes;
+  hshm::Mutex lock_;
+  int fd_ = -1;                // Current segment (-1 = none open)
+  chi::u64 seq_ = 0;           // Sequence number of the current segment
+  chi::u64 segment_size_ = 0;  // Preallocated size of the current segment
+  chi::u64 durable_off_ = 0;   // Committed bytes of the current segment
+  chi::u64 sealed_bytes_ = 0;  // Committed bytes of finished segments
+  std::vector<char> pending_;  // Records not yet committed
+  char *stage_ = nullptr;      // Aligned write buffer; starts with the
+  size_t stage_cap_ = 0;       // current partial block of the segment
+  // Mirrors of the committed size for lock-free metric reads
+  std::atomic<chi::u64> durable_bytes_{0};
+  std::atomic<chi::u64> committed_total_{0};
+
+  /** Refresh durable_bytes_ from the committed offsets (lock held) */
+  void PublishSize() {
+    durable_bytes_.store(sealed_bytes_ + durable_off_,
+                         std::memory_order_relaxed);
+  }
+
+  static chi::u64 AlignUp(chi::u64 x) {
+    return (x + kBlockSize - 1) / kBlockSize * kBlockSize;
+  }
+
+  static std::string SegmentPath(const std::string &base, chi::u64 seq) {
+    return base + ".seg" + std::to_string(seq);
+  }
+
+  /** Reserve a record header in pending_ and return the record offset */
+  size_t BeginRecord(TxnType type) {
+    size_t rec = pending_.size();
+    pending_.resize(rec + kRecordHeaderSize, 0);
+    pending_[rec + 4] = static_cast<char>(type);
+    return rec;
+  }
+
+  /**
+   * Seal a record: fill in its size and CRC, and move it to a new segment
+   * if it does not fit in the current one
+   */
+  void EndRecord(size_t rec) {
+    chi::u32 payload_size =
+        static_cast<chi::u32>(pending_.size() - rec - kRecordHeaderSize);
+    std::memcpy(pending_.data() + rec + 5, &payload_size, sizeof(chi::u32));
+    chi::u32 crc = Crc32c(pending_.data() + rec + 4,
+                          pending_.size() - rec - 4);
+    std::memcpy(pending_.data() + rec, &crc, sizeof(chi::u32));
+
+    if (fd_ < 0 || durable_off_ + pending_.size() > segment_size_) {
+      std::vector<char> record(pending_.begin() + rec, pending_.end());
+      pending_.resize(rec);
+      Commit();
+      if (!NextSegment(record.size())) {
+        HLOG(kError, "TransactionLog: cannot create segment {} of {}", seq_,
+             file_path_);
+        return;
+      }
+      pending_.insert(pending_.end(), record.begin(), record.end());
+    }
+    if (pending_.size() >= kMaxPendingBytes) {
+      Commit();
+    }
+  }
+
+  /** Write pending_ after the committed bytes and fdatasync (lock held) */
+  bool Commit() {
+    if (pending_.empty() || fd_ < 0) {
+      return pending_.empty();
+    }
+    size_t head = durable_off_ % kBlockSize;
+    size_t total = head + pending_.size();
+    size_t padded = AlignUp(total);
+    if (!ReserveStage(padded)) {
+      pending_.clear();
+      return false;
+    }
+    std::memcpy(stage_ + head, pending_.data(), pending_.size());
+    std::memset(stage_ + total, 0, padded - total);
+    chi::u64 block_off = durable_off_ - head;
+    bool ok = WriteFull(stage_, padded, block_off) && fdatasync(fd_) == 0;
+    if (!ok) {
+      HLOG(kError, "TransactionLog: commit of {} bytes to {} failed: {}",
+           pending_.size(), SegmentPath(file_path_, seq_),
+           std::strerror(errno));
+      pending_.clear();
+      return false;
+    }
+    durable_off_ += pending_.size();
+    committed_total_.fetch_add(pending_.size(), std::memory_order_relaxed);
+    pending_.clear();
+    PublishSize();
+    // Keep the new partial block at the front for the next commit
+    size_t new_head = durable_off_ % kBlockSize;
+    std::memmove(stage_, stage_ + (total - new_head), new_head);
+    return true;
+  }
+
+  /** Seal the current segment (if any) and start the next one */
+  bool NextSegment(size_t min_record_bytes) {
+    if (fd_ >= 0) {
+      sealed_bytes_ += durable_off_;
+      CloseSegmentFile();
+      ++seq_;
+    }
+    segment_size_ = std::max<chi::u64>(
+        segment_bytes_, AlignUp(kSegmentHeaderSize + min_record_bytes));
+    if (!OpenSegmentFile(true)) return false;
+    if (posix_fallocate(fd_, 0, static_cast<off_t>(segment_size_)) != 0 &&
+        ftruncate(fd_, static_cast<off_t>(segment_size_)) != 0) {
+      CloseSegmentFile();
+      return false;
+    }
+
+    // The header is the start of the first partial block
+    if (!ReserveStage(kBlockSize)) return false;
+    std::memset(stage_, 0, kBlockSize);
+    chi::u32 magic = kSegmentMagic;
+    chi::u32 version = kSegmentVersion;
+    std::memcpy(stage_, &magic, sizeof(magic));
+    std::memcpy(stage_ + 4, &version, sizeof(version));
+    std::memcpy(stage_ + 8, &seq_, sizeof(seq_));
+    std::memcpy(stage_ + 16, &segment_size_, sizeof(segment_size_));
+    if (!WriteFull(stage_, kBlockSize, 0)) {
+      CloseSegmentFile();
+      return false;
+    }
+    durable_off_ = kSegmentHeaderSize;
+    PublishSize();
+    return true;
+  }
+
+  /** Open the current segment, with O_DIRECT if the file system allows */
+  bool OpenSegmentFile(bool create) {
+    std::string path = SegmentPath(file_path_, seq_);
+    int flags = O_RDWR | O_CLOEXEC | (create ? O_CREAT | O_TRUNC : 0);
+#ifdef O_DIRECT
+    fd_ = open(path.c_str(), flags | O_DIRECT, 0644);
+    if (fd_ >= 0) return true;
+#endif
+    fd_ = open(path.c_str(), flags, 0644);
+    return fd_ >= 0;
+  }
 
-  /** Write a complete record: [u8 type][u32 size][payload] */
-  void WriteRecord(TxnType type, const std::vector<char> &payload) {
-    if (!ofs_.is_open()) return;
-    uint8_t type_byte = static_cast<uint8_t>(type);
-    uint32_t payload_size = static_cast<uint32_t>(payload.size());
-    ofs_.write(reinterpret_cast<const char *>(&type_byte), sizeof(type_byte));
-    ofs_.write(reinterpret_cast<const char *>(&payload_size),
-               sizeof(payload_size));
-    ofs_.write(payload.data(), payload_size);
+  void CloseSegmentFile() {
+    if (fd_ >= 0) {
+      close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  /** Read the partial block holding end into the stage buffer */
+  bool LoadTailBlock(chi::u64 end) {
+    if (!ReserveStage(kBlockSize)) return false;
+    chi::u64 block_off = end - end % kBlockSize;
+    ssize_t rc = pread(fd_, stage_, kBlockSize, static_cast<off_t>(block_off));
+    if (rc < static_cast<ssize_t>(end % kBlockSize)) return false;
+    struct stat st;
+    if (fstat(fd_, &st) != 0) return false;
+    segment_size_ = static_cast<chi::u64>(st.st_size);
+    return true;
+  }
+
+  bool ReserveStage(size_t bytes) {
+    if (bytes <= stage_cap_) return true;
+    size_t cap = std::max(AlignUp(bytes), AlignUp(kMaxPendingBytes) +
+                                              kBlockSize * 2);
+    void *mem = nullptr;
+    if (posix_memalign(&mem, kBlockSize, cap) != 0) return false;
+    if (stage_ != nullptr) {
+      std::memcpy(mem, stage_, kBlockSize);
+      std::free(stage_);
+    }
+    stage_ = static_cast<char *>(mem);
+    stage_cap_ = cap;
+    return true;
+  }
+
+  bool WriteFull(const char *buf, size_t len, chi::u64 off) {
+    size_t done = 0;
+    while (done < len) {
+      ssize_t rc = pwrite(fd_, buf + done, len - done,
+                          static_cast<off_t>(off + done));
+      if (rc < 0 && errno == EINTR) continue;
+      if (rc <= 0) return false;
+      done += static_cast<size_t>(rc);
+    }
+    return true;
+  }
+
+  /**
+   * Parse one memory-mapped segment file
+   * @param path Segment file
+   * @param fn Record visitor, as in ForEachRecord
+   * @return Offset just past the last valid record (0 if the header is bad)
+   */
+  template <typename Func>
+  static chi::u64 ScanSegment(const std::string &path, Func &&fn) {
+    MappedFile file;
+    if (!file.Open(path) || file.size() < kSegmentHeaderSize) {
+      return 0;
+    }
+    const char *data = file.data();
+    chi::u32 magic;
+    std::memcpy(&magic, data, sizeof(magic));
+    if (magic != kSegmentMagic) return 0;
+
+    size_t off = kSegmentHeaderSize;
+    while (off + kRecordHeaderSize <= file.size()) {
+      chi::u32 crc;
+      chi::u32 payload_size;
+      std::memcpy(&crc, data + off, sizeof(crc));
+      std::memcpy(&payload_size, data + off + 5, sizeof(payload_size));
+      size_t rec_end = off + kRecordHeaderSize + payload_size;
+      if (rec_end > file.size() ||
+          Crc32c(data + off + 4, rec_end - off - 4) != crc) {
+        break;
+      }
+      fn(static_cast<TxnType>(data[off + 4]), data + off + kRecordHeaderSize,
+         static_cast<size_t>(payload_size));
+      off = rec_end;
+    }
+    return off;
+  }
+
+  /** Find the end of the valid records of a segment */
+  static chi::u64 ScanSegment(const std::string &path) {
+    return ScanSegment(path, [](TxnType, const char *, size_t) {});
+  }
+
+  /** Read a pre-segment log: [u8 type][u32 size][payload] records */
+  template <typename Func>
+  void ScanLegacy(Func &&fn) const {
+    MappedFile file;
+    if (!std::filesystem::is_regular_file(file_path_) ||
+        !file.Open(file_path_)) {
+      return;
+    }
+    const char *data = file.data();
+    size_t off = 0;
+    while (off + 5 <= file.size()) {
+      chi::u32 payload_size;
+      std::memcpy(&payload_size, data + off + 1, sizeof(payload_size));
+      if (off + 5 + payload_size > file.size()) break;
+      fn(static_cast<TxnType>(data[off]), data + off + 5,
+         static_cast<size_t>(payload_size));
+      off += 5 + payload_size;
+    }
   }
 
   // ---- Serialization primitives ----
@@ -363,33 +1006,32 @@ class TransactionLog {
   }
 
   // ---- Deserialization primitives ----
-  static chi::u32 ReadU32(const std::vector<char> &data, size_t &off) {
+  static chi::u32 ReadU32(const char *data, size_t &off) {
     chi::u32 val;
-    std::memcpy(&val, data.data() + off, sizeof(val));
+    std::memcpy(&val, data + off, sizeof(val));
     off += sizeof(val);
     return val;
   }
-  static chi::u64 ReadU64(const std::vector<char> &data, size_t &off) {
+  static chi::u64 ReadU64(const char *data, size_t &off) {
     chi::u64 val;
-    std::memcpy(&val, data.data() + off, sizeof(val));
+    std::memcpy(&val, data + off, sizeof(val));
     off += sizeof(val);
     return val;
   }
-  static float ReadFloat(const std::vector<char> &data, size_t &off) {
+  static float ReadFloat(const char *data, size_t &off) {
     float val;
-    std::memcpy(&val, data.data() + off, sizeof(val));
+    std::memcpy(&val, data + off, sizeof(val));
     off += sizeof(val);
     return val;
   }
-  static std::string ReadString(const std::vector<char> &data, size_t &off) {
+  static std::string ReadString(const char *data, size_t &off) {
     chi::u32 len = ReadU32(data, off);
-    std::string s(data.data() + off, len);
+    std::string s(data + off, len);
     off += len;
     return s;
   }
-  static void ReadRaw(const std::vector<char> &data, size_t &off, void *ptr,
-                      size_t len) {
-    std::memcpy(ptr, data.data() + off, len);
+  static void ReadRaw(const char *data, size_t &off, void *ptr, size_t len) {
+    std::memcpy(ptr, data + off, len);
     off += len;
   }
 };
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef WRPCTE_CORE_WARP_BATCH_H_
+#define WRPCTE_CORE_WARP_BATCH_H_
+
+#include <chimaera/chimaera.h>
+#include <wrp_cte/core/core_tasks.h>
+
+namespace wrp_cte::core {
+
+/** Outcome of a warp batch, the same on every lane */
+struct WarpBatchResult {
+  chi::u32 submitted_;    // Records in the batch (active lanes)
+  chi::u32 failed_;       // Records whose PutBlob failed
+  chi::u32 return_code_;  // 0, or the last failure's PutBlob code
+};
+
+#if HSHM_IS_GPU
+/**
+ * Warp-cooperative PutBlob: every active lane contributes one
+ * (blob, offset, size) record and the warp submits them as a single
+ * PutBlobBatch task, so the GPU queues see one entry per warp instead of
+ * one per lane.
+ *
+ * The leader lane allocates the task and broadcasts its address; each
+ * active lane writes its record straight into the task at its rank among
+ * the active lanes, so no separate staging buffer is needed. Must be called
+ * by all 32 lanes of a converged warp.
+ *
+ * @param pool_id CTE pool
+ * @param pool_query Routing for the batch (Local or ToLocalCpu)
+ * @param tag_id Tag of every blob
+ * @param name_prefix Blob names are name_prefix + decimal blob_index
+ * @param active Whether this lane contributes a record
+ * @param blob_index This lane's blob index
+ * @param offset Offset within this lane's blob
+ * @param size Bytes this lane writes
+ * @param data This lane's data (ShmPtr or absolute device address)
+ * @param score Placement score for every blob (-1 = automatic)
+ * @return Batch outcome, broadcast to all lanes
+ */
+HSHM_GPU_FUN inline WarpBatchResult WarpPutBlobBatch(
+    const chi::PoolId &pool_id, const chi::PoolQuery &pool_query,
+    const TagId &tag_id, const char *name_prefix, bool active,
+    chi::u64 blob_index, chi::u64 offset, chi::u64 size, hipc::ShmPtr<> data,
+    float score = -1.0f) {
+  WarpBatchResult result = {0, 0, 0};
+  chi::u32 lane = chi::gpu::IpcManager::GetLaneId();
+  unsigned int ballot = __ballot_sync(0xFFFFFFFF, active);
+  chi::u32 count = __popc(ballot);
+  if (count == 0) return result;
+  result.submitted_ = count;
+
+  hipc::FullPtr<PutBlobBatchTask> task;
+  if (lane == 0) {
+    task = CHI_IPC->NewTask<PutBlobBatchTask>(chi::CreateTaskId(), pool_id,
+                                              pool_query, tag_id, name_prefix,
+                                              score);
+  }
+  auto *staged = reinterpret_cast<PutBlobBatchTask *>(hipc::shfl_sync_u64(
+      0xFFFFFFFF, reinterpret_cast<unsigned long long>(task.ptr_), 0));
+  if (staged == nullptr) {
+    result.failed_ = count;
+    result.return_code_ = 1;
+    return result;
+  }
+
+  // Active lanes fill consecutive entries in lane order
+  if (active) {
+    PutBlobBatchEntry &entry =
+        staged->entries_[__popc(ballot & ((1u << lane) - 1))];
+    entry.blob_index_ = blob_index;
+    entry.offset_ = offset;
+    entry.size_ = size;
+    entry.data_ = data;
+  }
+  __syncwarp();
+
+  if (lane == 0) {
+    task->count_ = count;
+    auto future = CHI_IPC->Send(task);
+    if (!future.GetFutureShmPtr().IsNull()) {
+      future.WaitGpu();
+      result.failed_ = task->failed_;
+      result.return_code_ = task->return_code_.load();
+    } else {
+      result.failed_ = count;
+      result.return_code_ = 1;
+    }
+    CHI_IPC->DelTask(task);
+  }
+  result.failed_ = __shfl_sync(0xFFFFFFFF, result.failed_, 0);
+  result.return_code_ = __shfl_sync(0xFFFFFFFF, result.return_code_, 0);
+  return result;
+}
+
+/**
+ * Warp-cooperative GetBlob into a registered kernel buffer.
+ *
+ * The leader lane submits one GetBlob whose destination is dst.At(dst_off),
+ * so the bdev read writes the blob straight into the caller's memory. Every
+ * lane then spins on the task's FutureShm completion flag and returns once
+ * the data is visible, instead of waiting for the leader to hand over a
+ * separate buffer. Must be called by all 32 lanes of a converged warp.
+ *
+ * dst must be writable by the runtime pool_query routes to: any device
+ * memory for PoolQuery::Local(), host-visible memory for ToLocalCpu().
+ *
+ * @param pool_id CTE pool
+ * @param pool_query Routing for the read
+ * @param tag_id Tag of the blob
+ * @param blob_name Blob name
+ * @param offset Offset within the blob
+ * @param size Bytes to read
+ * @param dst Buffer from gpu::IpcManager::RegisterUserBuffer
+ * @param dst_off Byte offset in dst where the data lands
+ * @return GetBlob return code (0 on success), broadcast to all lanes
+ */
+HSHM_GPU_FUN inline chi::u32 WarpGetBlob(
+    const chi::PoolId &pool_id, const chi::PoolQuery &pool_query,
+    const TagId &tag_id, const char *blob_name, chi::u64 offset,
+    chi::u64 size, const chi::gpu::GpuUserBuffer &dst, chi::u64 dst_off) {
+  chi::u32 lane = chi::gpu::IpcManager::GetLaneId();
+  hipc::FullPtr<GetBlobTask> task;
+  chi::gpu::Future<GetBlobTask> future;
+  chi::gpu::FutureShm *fshm = nullptr;
+  if (lane == 0 && dst.Contains(dst_off, size)) {
+    task = CHI_IPC->NewTask<GetBlobTask>(chi::CreateTaskId(), pool_id,
+                                         pool_query, tag_id, blob_name,
+                                         offset, size, chi::u32(0),
+                                         dst.At(dst_off));
+    if (!task.IsNull()) {
+      future = CHI_IPC->Send(task);
+      fshm = future.GetFutureShm().ptr_;
+    }
+  }
+  auto *flags = reinterpret_cast<chi::gpu::FutureShm *>(hipc::shfl_sync_u64(
+      0xFFFFFFFF, reinterpret_cast<unsigned long long>(fshm), 0));
+  if (flags == nullptr) {
+    if (lane == 0 && !task.IsNull()) CHI_IPC->DelTask(task);
+    return 1;
+  }
+
+  // Every lane observes completion on the same flag word
+  volatile unsigned int *fp = reinterpret_cast<volatile unsigned int *>(
+      &flags->flags_.bits_.x);
+  while (!((*fp) & chi::gpu::FutureShm::FUTURE_COMPLETE)) {}
+  __threadfence_system();
+
+  chi::u32 rc = 0;
+  if (lane == 0) {
+    rc = task->GetReturnCode();
+    CHI_IPC->DelTask(task);
+  }
+  return __shfl_sync(0xFFFFFFFF, rc, 0);
+}
+#endif  // HSHM_IS_GPU
+
+}  // namespace wrp_cte::core
+
+#endif  // WRPCTE_CORE_WARP_BATCH_H_
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef WRPCTE_CORE_WORKLOAD_TRACE_H_
+#define WRPCTE_CORE_WORKLOAD_TRACE_H_
+
+#include <chimaera/chimaera.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace wrp_cte::core {
+
+using TagId = chi::UniqueId;
+
+/** Client operations captured in a workload trace */
+enum class WorkloadOp : uint8_t {
+  kGetOrCreateTag = 0,
+  kTagBind = 1,  /**< name_ resolved to tag id (emitted after a create) */
+  kPutBlob = 2,
+  kAppendBlob = 3,
+  kGetBlob = 4,
+  kReorganizeBlob = 5,
+  kDelBlob = 6,
+  kDelTag = 7,
+  kGetTagSize = 8,
+  kGetBlobScore = 9,
+  kGetBlobSize = 10,
+  kGetBlobInfo = 11,
+  kGetContainedBlobs = 12,
+  kCount = 13,
+};
+
+/**
+ * Human-readable name of a workload op
+ * @param op Operation
+ * @return Static string (e.g. "PutBlob")
+ */
+const char *WorkloadOpName(WorkloadOp op);
+
+/** Leading header of a workload trace file */
+struct WorkloadTraceHeader {
+  char magic_[8];           /**< kMagic */
+  uint32_t version_;        /**< kVersion */
+  uint32_t pid_;            /**< Recording process */
+  uint64_t start_wall_ns_;  /**< Wall clock at ts_ns_ == 0 */
+  char host_[64];           /**< Recording host, NUL-terminated */
+
+  static constexpr char kMagic[8] = {'C', 'T', 'E', 'W', 'L', 'T', 'R', '1'};
+  static constexpr uint32_t kVersion = 1;
+};
+static_assert(sizeof(WorkloadTraceHeader) == 88,
+              "WorkloadTraceHeader layout is part of the file format");
+
+/**
+ * One fixed-size trace record, followed in the file by name_len_ bytes of
+ * blob (or tag) name. Fields are stored in host byte order.
+ */
+struct WorkloadRecord {
+  uint64_t ts_ns_;      /**< Issue time relative to the trace start */
+  uint64_t offset_;     /**< Blob offset (PutBlob/GetBlob) */
+  uint64_t size_;       /**< Transfer size (PutBlob/GetBlob/AppendBlob) */
+  uint32_t tag_major_;  /**< Tag id as issued by the client */
+  uint32_t tag_minor_;
+  uint32_t thread_;     /**< Per-process client thread index */
+  float score_;         /**< Placement score (PutBlob/ReorganizeBlob) */
+  uint16_t name_len_;   /**< Bytes of name following the record */
+  uint8_t op_;          /**< WorkloadOp */
+  uint8_t flags_;       /**< Op flags (low byte) */
+  uint32_t reserved_;
+};
+static_assert(sizeof(WorkloadRecord) == 48,
+              "WorkloadRecord layout is part of the file format");
+
+/**
+ * Records the CTE operations a client process issues
+ *
+ * Capture happens at the client API boundary (the inline Async* calls of
+ * wrp_cte::core::Client), so every record is one request the application
+ * made: tasks the runtime forwards, replicates or fans out are not counted
+ * twice, and calls made from runtime worker threads (an embedded runtime's
+ * own subtasks) are skipped. Recording is off unless
+ * WRP_CTE_WORKLOAD_TRACE=<prefix> is set when a client-mode process runs
+ * WRP_CTE_CLIENT_INIT; records then go to <prefix>.<host>.<pid>.wlt. While
+ * off, the per-call cost is one relaxed load. Records are buffered under a
+ * mutex and the file is flushed on Stop() and at process exit.
+ */
+class WorkloadRecorder {
+ public:
+  /** Environment variable holding the trace path prefix */
+  static constexpr const char *kEnvVar = "WRP_CTE_WORKLOAD_TRACE";
+
+  /**
+   * Start recording if kEnvVar is set; no-op otherwise
+   * @return true if recording is active afterwards
+   */
+  static bool InitFromEnv();
+
+  /**
+   * Start recording to a file (truncates it)
+   * @param path Output file
+   * @return true on success
+   */
+  static bool Start(const std::string &path);
+
+  /** Flush and close the trace; further records are dropped */
+  static void Stop();
+
+  /** Whether records are being captured */
+  static bool IsEnabled() {
+    return s_enabled_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Append one record
+   * @param op Operation
+   * @param tag_id Tag the operation targets (null for name-only ops)
+   * @param name Blob or tag name (may be nullptr)
+   * @param offset Blob offset
+   * @param size Transfer size
+   * @param score Placement score
+   * @param flags Op flags
+   */
+  static void Record(WorkloadOp op, const TagId &tag_id, const char *name,
+                     chi::u64 offset = 0, chi::u64 size = 0,
+                     float score = 0.0f, chi::u32 flags = 0);
+
+  /**
+   * Record that a tag name resolved to tag_id. GetOrCreateTag completes
+   * asynchronously, so the replayer relies on these to map the tag ids of
+   * later records; the Tag wrapper emits them automatically and raw
+   * AsyncGetOrCreateTag users may call this after Wait().
+   * @param name Tag name
+   * @param tag_id Resolved tag id
+   */
+  static void BindTag(const std::string &name, const TagId &tag_id) {
+    if (IsEnabled()) {
+      Record(WorkloadOp::kTagBind, tag_id, name.c_str());
+    }
+  }
+
+ private:
+  static std::atomic<bool> s_enabled_;
+};
+
+/** A decoded trace record */
+struct WorkloadEvent {
+  WorkloadRecord rec_;
+  std::string name_;
+
+  WorkloadOp GetOp() const { return static_cast<WorkloadOp>(rec_.op_); }
+  TagId GetTagId() const { return TagId(rec_.tag_major_, rec_.tag_minor_); }
+};
+
+/** Sequential reader for a workload trace file */
+class WorkloadTraceReader {
+ public:
+  WorkloadTraceReader() = default;
+  ~WorkloadTraceReader() { Close(); }
+  WorkloadTraceReader(const WorkloadTraceReader &) = delete;
+  WorkloadTraceReader &operator=(const WorkloadTraceReader &) = delete;
+
+  /**
+   * Open a trace and validate its header
+   * @param path Trace file
+   * @return true if the file is a readable trace of a known version
+   */
+  bool Open(const std::string &path);
+
+  /** Close the file */
+  void Close();
+
+  /** Header of the open trace */
+  const WorkloadTraceHeader &GetHeader() const { return header_; }
+
+  /**
+   * Read the next record
+   * @param event Receives the record
+   * @return false at end of file or on a truncated record
+   */
+  bool Next(WorkloadEvent &event);
+
+ private:
+  FILE *file_ = nullptr;
+  WorkloadTraceHeader header_{};
+};
+
+}  // namespace wrp_cte::core
+
+#endif  // WRPCTE_CORE_WORKLOAD_TRACE_H_
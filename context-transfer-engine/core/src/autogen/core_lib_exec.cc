@@ -1,7 +1,7 @@
 /**
  * Auto-generated execution implementation for core ChiMod
- * Implements Container virtual APIs (Run, SaveTask, LoadTask, NewCopyTask, NewTask)
- * using switch-case dispatch
+ * Implements Container virtual APIs (Run, SaveTask, LoadTask, NewCopyTask, NewTask).
+ * Run uses switch-case dispatch; the others index the kMethodExec table.
  * 
  * This file is autogenerated - do not edit manually.
  * Changes should be made to the autogen tool or the YAML configuration.
@@ -11,9 +11,75 @@
 #include "wrp_cte/core/autogen/core_methods.h"
 #include <chimaera/chimaera.h>
 #include <chimaera/task.h>  // For TaskResume coroutine return type
+#include <chimaera/method_exec.h>
 
 namespace wrp_cte::core {
 
+namespace {
+
+/** Per-method dispatch table indexed by method ID */
+constexpr chi::MethodExec kMethodExec[57] = {
+    chi::MakeMethodExec<CreateTask>(),  // 0: Create
+    chi::MakeMethodExec<DestroyTask>(),  // 1: Destroy
+    {},  // 2
+    {},  // 3
+    {},  // 4
+    {},  // 5
+    {},  // 6
+    {},  // 7
+    {},  // 8
+    chi::MakeMethodExec<MonitorTask>(),  // 9: Monitor
+    chi::MakeMethodExec<RegisterTargetTask>(),  // 10: RegisterTarget
+    chi::MakeMethodExec<UnregisterTargetTask>(),  // 11: UnregisterTarget
+    chi::MakeMethodExec<ListTargetsTask>(),  // 12: ListTargets
+    chi::MakeMethodExec<StatTargetsTask>(),  // 13: StatTargets
+    chi::MakeMethodExec<core::GetOrCreateTagTask<core::CreateParams>>(),  // 14: GetOrCreateTag
+    chi::MakeMethodExec<PutBlobTask>(),  // 15: PutBlob
+    chi::MakeMethodExec<GetBlobTask>(),  // 16: GetBlob
+    chi::MakeMethodExec<ReorganizeBlobTask>(),  // 17: ReorganizeBlob
+    chi::MakeMethodExec<DelBlobTask>(),  // 18: DelBlob
+    chi::MakeMethodExec<DelTagTask>(),  // 19: DelTag
+    chi::MakeMethodExec<GetTagSizeTask>(),  // 20: GetTagSize
+    chi::MakeMethodExec<PollTelemetryLogTask>(),  // 21: PollTelemetryLog
+    chi::MakeMethodExec<GetBlobScoreTask>(),  // 22: GetBlobScore
+    chi::MakeMethodExec<GetBlobSizeTask>(),  // 23: GetBlobSize
+    chi::MakeMethodExec<GetContainedBlobsTask>(),  // 24: GetContainedBlobs
+    chi::MakeMethodExec<GetBlobInfoTask>(),  // 25: GetBlobInfo
+    {},  // 26
+    {},  // 27
+    {},  // 28
+    {},  // 29
+    chi::MakeMethodExec<TagQueryTask>(),  // 30: TagQuery
+    chi::MakeMethodExec<BlobQueryTask>(),  // 31: BlobQuery
+    chi::MakeMethodExec<GetTargetInfoTask>(),  // 32: GetTargetInfo
+    chi::MakeMethodExec<FlushMetadataTask>(),  // 33: FlushMetadata
+    chi::MakeMethodExec<FlushDataTask>(),  // 34: FlushData
+    chi::MakeMethodExec<AppendBlobTask>(),  // 35: AppendBlob
+    chi::MakeMethodExec<DefragBlobsTask>(),  // 36: DefragBlobs
+    chi::MakeMethodExec<MigrateBlobsTask>(),  // 37: MigrateBlobs
+    chi::MakeMethodExec<CommitTransactionLogsTask>(),  // 38: CommitTransactionLogs
+    chi::MakeMethodExec<SetTagReplicationTask>(),  // 39: SetTagReplication
+    chi::MakeMethodExec<RepairReplicasTask>(),  // 40: RepairReplicas
+    chi::MakeMethodExec<SetPlacementWeightsTask>(),  // 41: SetPlacementWeights
+    chi::MakeMethodExec<RebalanceBlobsTask>(),  // 42: RebalanceBlobs
+    chi::MakeMethodExec<SetTagPlacementTask>(),  // 43: SetTagPlacement
+    chi::MakeMethodExec<RegisterBlobStubTask>(),  // 44: RegisterBlobStub
+    chi::MakeMethodExec<PutBlobBatchTask>(),  // 45: PutBlobBatch
+    chi::MakeMethodExec<SpliceBlobsTask>(),  // 46: SpliceBlobs
+    chi::MakeMethodExec<SetTagDedupTask>(),  // 47: SetTagDedup
+    chi::MakeMethodExec<SetTagErasureTask>(),  // 48: SetTagErasure
+    chi::MakeMethodExec<EvictTargetsTask>(),  // 49: EvictTargets
+    chi::MakeMethodExec<SetTagTtlTask>(),  // 50: SetTagTtl
+    chi::MakeMethodExec<ExpireBlobsTask>(),  // 51: ExpireBlobs
+    chi::MakeMethodExec<ReserveBlobTask>(),  // 52: ReserveBlob
+    chi::MakeMethodExec<GetOrCreateTagsTask>(),  // 53: GetOrCreateTags
+    chi::MakeMethodExec<SetTagEncryptionTask>(),  // 54: SetTagEncryption
+    chi::MakeMethodExec<GetBlobViewTask>(),  // 55: GetBlobView
+    chi::MakeMethodExec<ReleaseBlobViewTask>(),  // 56: ReleaseBlobView
+};
+
+}  // namespace
+
 //==============================================================================
 // Container Virtual API Implementations
 //==============================================================================
@@ -29,6 +95,7 @@ void Runtime::Init(const chi::PoolId &pool_id, const std::string &pool_name,
   // Initialize per-method load prediction model
   DefineModel(Method::kMaxMethodId);
   SetMethodNames(Method::GetMethodNames());
+  SetMethodTraits(Method::kMethodTraits);
 }
 
 void Runtime::Restart(const chi::PoolId &pool_id, const std::string &pool_name,
@@ -184,136 +251,136 @@ chi::TaskResume Runtime::Run(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr,
       CHI_CO_AWAIT(FlushData(typed_task, rctx));
       break;
     }
-    default: {
-      // Unknown method - do nothing
-      break;
-    }
-  }
-  CHI_CO_RETURN;
-  CHI_TASK_BODY_END
-}
-
-void Runtime::SaveTask(chi::u32 method, chi::SaveTaskArchive& archive, 
-                        hipc::FullPtr<chi::Task> task_ptr) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = task_ptr.template Cast<CreateTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = task_ptr.template Cast<DestroyTask>();
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = task_ptr.template Cast<MonitorTask>();
-      archive << *typed_task.ptr_;
+    case Method::kAppendBlob: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<AppendBlobTask> typed_task = task_ptr.template Cast<AppendBlobTask>();
+      CHI_CO_AWAIT(AppendBlob(typed_task, rctx));
       break;
     }
-    case Method::kRegisterTarget: {
-      auto typed_task = task_ptr.template Cast<RegisterTargetTask>();
-      archive << *typed_task.ptr_;
+    case Method::kDefragBlobs: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<DefragBlobsTask> typed_task = task_ptr.template Cast<DefragBlobsTask>();
+      CHI_CO_AWAIT(DefragBlobs(typed_task, rctx));
       break;
     }
-    case Method::kUnregisterTarget: {
-      auto typed_task = task_ptr.template Cast<UnregisterTargetTask>();
-      archive << *typed_task.ptr_;
+    case Method::kMigrateBlobs: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<MigrateBlobsTask> typed_task = task_ptr.template Cast<MigrateBlobsTask>();
+      CHI_CO_AWAIT(MigrateBlobs(typed_task, rctx));
       break;
     }
-    case Method::kListTargets: {
-      auto typed_task = task_ptr.template Cast<ListTargetsTask>();
-      archive << *typed_task.ptr_;
+    case Method::kCommitTransactionLogs: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<CommitTransactionLogsTask> typed_task = task_ptr.template Cast<CommitTransactionLogsTask>();
+      CHI_CO_AWAIT(CommitTransactionLogs(typed_task, rctx));
       break;
     }
-    case Method::kStatTargets: {
-      auto typed_task = task_ptr.template Cast<StatTargetsTask>();
-      archive << *typed_task.ptr_;
+    case Method::kSetTagReplication: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<SetTagReplicationTask> typed_task = task_ptr.template Cast<SetTagReplicationTask>();
+      CHI_CO_AWAIT(SetTagReplication(typed_task, rctx));
       break;
     }
-    case Method::kGetOrCreateTag: {
-      auto typed_task = task_ptr.template Cast<core::GetOrCreateTagTask<core::CreateParams>>();
-      archive << *typed_task.ptr_;
+    case Method::kRepairReplicas: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<RepairReplicasTask> typed_task = task_ptr.template Cast<RepairReplicasTask>();
+      CHI_CO_AWAIT(RepairReplicas(typed_task, rctx));
       break;
     }
-    case Method::kPutBlob: {
-      auto typed_task = task_ptr.template Cast<PutBlobTask>();
-      archive << *typed_task.ptr_;
+    case Method::kSetPlacementWeights: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<SetPlacementWeightsTask> typed_task = task_ptr.template Cast<SetPlacementWeightsTask>();
+      CHI_CO_AWAIT(SetPlacementWeights(typed_task, rctx));
       break;
     }
-    case Method::kGetBlob: {
-      auto typed_task = task_ptr.template Cast<GetBlobTask>();
-      archive << *typed_task.ptr_;
+    case Method::kRebalanceBlobs: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<RebalanceBlobsTask> typed_task = task_ptr.template Cast<RebalanceBlobsTask>();
+      CHI_CO_AWAIT(RebalanceBlobs(typed_task, rctx));
       break;
     }
-    case Method::kReorganizeBlob: {
-      auto typed_task = task_ptr.template Cast<ReorganizeBlobTask>();
-      archive << *typed_task.ptr_;
+    case Method::kSetTagPlacement: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<SetTagPlacementTask> typed_task = task_ptr.template Cast<SetTagPlacementTask>();
+      CHI_CO_AWAIT(SetTagPlacement(typed_task, rctx));
       break;
     }
-    case Method::kDelBlob: {
-      auto typed_task = task_ptr.template Cast<DelBlobTask>();
-      archive << *typed_task.ptr_;
+    case Method::kRegisterBlobStub: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<RegisterBlobStubTask> typed_task = task_ptr.template Cast<RegisterBlobStubTask>();
+      CHI_CO_AWAIT(RegisterBlobStub(typed_task, rctx));
       break;
     }
-    case Method::kDelTag: {
-      auto typed_task = task_ptr.template Cast<DelTagTask>();
-      archive << *typed_task.ptr_;
+    case Method::kPutBlobBatch: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<PutBlobBatchTask> typed_task = task_ptr.template Cast<PutBlobBatchTask>();
+      CHI_CO_AWAIT(PutBlobBatch(typed_task, rctx));
       break;
     }
-    case Method::kGetTagSize: {
-      auto typed_task = task_ptr.template Cast<GetTagSizeTask>();
-      archive << *typed_task.ptr_;
+    case Method::kSpliceBlobs: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<SpliceBlobsTask> typed_task = task_ptr.template Cast<SpliceBlobsTask>();
+      CHI_CO_AWAIT(SpliceBlobs(typed_task, rctx));
       break;
     }
-    case Method::kPollTelemetryLog: {
-      auto typed_task = task_ptr.template Cast<PollTelemetryLogTask>();
-      archive << *typed_task.ptr_;
+    case Method::kSetTagDedup: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<SetTagDedupTask> typed_task = task_ptr.template Cast<SetTagDedupTask>();
+      CHI_CO_AWAIT(SetTagDedup(typed_task, rctx));
       break;
     }
-    case Method::kGetBlobScore: {
-      auto typed_task = task_ptr.template Cast<GetBlobScoreTask>();
-      archive << *typed_task.ptr_;
+    case Method::kSetTagErasure: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<SetTagErasureTask> typed_task = task_ptr.template Cast<SetTagErasureTask>();
+      CHI_CO_AWAIT(SetTagErasure(typed_task, rctx));
       break;
     }
-    case Method::kGetBlobSize: {
-      auto typed_task = task_ptr.template Cast<GetBlobSizeTask>();
-      archive << *typed_task.ptr_;
+    case Method::kEvictTargets: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<EvictTargetsTask> typed_task = task_ptr.template Cast<EvictTargetsTask>();
+      CHI_CO_AWAIT(EvictTargets(typed_task, rctx));
       break;
     }
-    case Method::kGetContainedBlobs: {
-      auto typed_task = task_ptr.template Cast<GetContainedBlobsTask>();
-      archive << *typed_task.ptr_;
+    case Method::kSetTagTtl: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<SetTagTtlTask> typed_task = task_ptr.template Cast<SetTagTtlTask>();
+      CHI_CO_AWAIT(SetTagTtl(typed_task, rctx));
       break;
     }
-    case Method::kGetBlobInfo: {
-      auto typed_task = task_ptr.template Cast<GetBlobInfoTask>();
-      archive << *typed_task.ptr_;
+    case Method::kExpireBlobs: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<ExpireBlobsTask> typed_task = task_ptr.template Cast<ExpireBlobsTask>();
+      CHI_CO_AWAIT(ExpireBlobs(typed_task, rctx));
       break;
     }
-    case Method::kTagQuery: {
-      auto typed_task = task_ptr.template Cast<TagQueryTask>();
-      archive << *typed_task.ptr_;
+    case Method::kReserveBlob: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<ReserveBlobTask> typed_task = task_ptr.template Cast<ReserveBlobTask>();
+      CHI_CO_AWAIT(ReserveBlob(typed_task, rctx));
       break;
     }
-    case Method::kBlobQuery: {
-      auto typed_task = task_ptr.template Cast<BlobQueryTask>();
-      archive << *typed_task.ptr_;
+    case Method::kGetOrCreateTags: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<GetOrCreateTagsTask> typed_task = task_ptr.template Cast<GetOrCreateTagsTask>();
+      CHI_CO_AWAIT(GetOrCreateTags(typed_task, rctx));
       break;
     }
-    case Method::kGetTargetInfo: {
-      auto typed_task = task_ptr.template Cast<GetTargetInfoTask>();
-      archive << *typed_task.ptr_;
+    case Method::kSetTagEncryption: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<SetTagEncryptionTask> typed_task = task_ptr.template Cast<SetTagEncryptionTask>();
+      CHI_CO_AWAIT(SetTagEncryption(typed_task, rctx));
       break;
     }
-    case Method::kFlushMetadata: {
-      auto typed_task = task_ptr.template Cast<FlushMetadataTask>();
-      archive << *typed_task.ptr_;
+    case Method::kGetBlobView: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<GetBlobViewTask> typed_task = task_ptr.template Cast<GetBlobViewTask>();
+      CHI_CO_AWAIT(GetBlobView(typed_task, rctx));
       break;
     }
-    case Method::kFlushData: {
-      auto typed_task = task_ptr.template Cast<FlushDataTask>();
-      archive << *typed_task.ptr_;
+    case Method::kReleaseBlobView: {
+      // Cast task FullPtr to specific type
+      hipc::FullPtr<ReleaseBlobViewTask> typed_task = task_ptr.template Cast<ReleaseBlobViewTask>();
+      CHI_CO_AWAIT(ReleaseBlobView(typed_task, rctx));
       break;
     }
     default: {
@@ -321,135 +388,23 @@ void Runtime::SaveTask(chi::u32 method, chi::SaveTaskArchive& archive,
       break;
     }
   }
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+void Runtime::SaveTask(chi::u32 method, chi::SaveTaskArchive& archive, 
+                        hipc::FullPtr<chi::Task> task_ptr) {
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->save_(archive, task_ptr);
+  }
 }
 
 void Runtime::LoadTask(chi::u32 method, chi::LoadTaskArchive& archive,
                         hipc::FullPtr<chi::Task> task_ptr) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = task_ptr.template Cast<CreateTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = task_ptr.template Cast<DestroyTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = task_ptr.template Cast<MonitorTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kRegisterTarget: {
-      auto typed_task = task_ptr.template Cast<RegisterTargetTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kUnregisterTarget: {
-      auto typed_task = task_ptr.template Cast<UnregisterTargetTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kListTargets: {
-      auto typed_task = task_ptr.template Cast<ListTargetsTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kStatTargets: {
-      auto typed_task = task_ptr.template Cast<StatTargetsTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetOrCreateTag: {
-      auto typed_task = task_ptr.template Cast<core::GetOrCreateTagTask<core::CreateParams>>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kPutBlob: {
-      auto typed_task = task_ptr.template Cast<PutBlobTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetBlob: {
-      auto typed_task = task_ptr.template Cast<GetBlobTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kReorganizeBlob: {
-      auto typed_task = task_ptr.template Cast<ReorganizeBlobTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kDelBlob: {
-      auto typed_task = task_ptr.template Cast<DelBlobTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kDelTag: {
-      auto typed_task = task_ptr.template Cast<DelTagTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetTagSize: {
-      auto typed_task = task_ptr.template Cast<GetTagSizeTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kPollTelemetryLog: {
-      auto typed_task = task_ptr.template Cast<PollTelemetryLogTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetBlobScore: {
-      auto typed_task = task_ptr.template Cast<GetBlobScoreTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetBlobSize: {
-      auto typed_task = task_ptr.template Cast<GetBlobSizeTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetContainedBlobs: {
-      auto typed_task = task_ptr.template Cast<GetContainedBlobsTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetBlobInfo: {
-      auto typed_task = task_ptr.template Cast<GetBlobInfoTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kTagQuery: {
-      auto typed_task = task_ptr.template Cast<TagQueryTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kBlobQuery: {
-      auto typed_task = task_ptr.template Cast<BlobQueryTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetTargetInfo: {
-      auto typed_task = task_ptr.template Cast<GetTargetInfoTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kFlushMetadata: {
-      auto typed_task = task_ptr.template Cast<FlushMetadataTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kFlushData: {
-      auto typed_task = task_ptr.template Cast<FlushDataTask>();
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    default: {
-      // Unknown method - do nothing
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->load_(archive, task_ptr);
   }
 }
 
@@ -463,155 +418,9 @@ hipc::FullPtr<chi::Task> Runtime::AllocLoadTask(chi::u32 method, chi::LoadTaskAr
 
 void Runtime::LocalLoadTask(chi::u32 method, chi::DefaultLoadArchive& archive,
                             hipc::FullPtr<chi::Task> task_ptr) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = task_ptr.template Cast<CreateTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = task_ptr.template Cast<DestroyTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = task_ptr.template Cast<MonitorTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kRegisterTarget: {
-      auto typed_task = task_ptr.template Cast<RegisterTargetTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kUnregisterTarget: {
-      auto typed_task = task_ptr.template Cast<UnregisterTargetTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kListTargets: {
-      auto typed_task = task_ptr.template Cast<ListTargetsTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kStatTargets: {
-      auto typed_task = task_ptr.template Cast<StatTargetsTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetOrCreateTag: {
-      auto typed_task = task_ptr.template Cast<core::GetOrCreateTagTask<core::CreateParams>>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kPutBlob: {
-      auto typed_task = task_ptr.template Cast<PutBlobTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetBlob: {
-      auto typed_task = task_ptr.template Cast<GetBlobTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kReorganizeBlob: {
-      auto typed_task = task_ptr.template Cast<ReorganizeBlobTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kDelBlob: {
-      auto typed_task = task_ptr.template Cast<DelBlobTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kDelTag: {
-      auto typed_task = task_ptr.template Cast<DelTagTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetTagSize: {
-      auto typed_task = task_ptr.template Cast<GetTagSizeTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kPollTelemetryLog: {
-      auto typed_task = task_ptr.template Cast<PollTelemetryLogTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetBlobScore: {
-      auto typed_task = task_ptr.template Cast<GetBlobScoreTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetBlobSize: {
-      auto typed_task = task_ptr.template Cast<GetBlobSizeTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetContainedBlobs: {
-      auto typed_task = task_ptr.template Cast<GetContainedBlobsTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetBlobInfo: {
-      auto typed_task = task_ptr.template Cast<GetBlobInfoTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kTagQuery: {
-      auto typed_task = task_ptr.template Cast<TagQueryTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kBlobQuery: {
-      auto typed_task = task_ptr.template Cast<BlobQueryTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetTargetInfo: {
-      auto typed_task = task_ptr.template Cast<GetTargetInfoTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kFlushMetadata: {
-      auto typed_task = task_ptr.template Cast<FlushMetadataTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    case Method::kFlushData: {
-      auto typed_task = task_ptr.template Cast<FlushDataTask>();
-      // Use archive operator which respects msg_type
-      archive >> *typed_task.ptr_;
-      break;
-    }
-    default: {
-      // Unknown method - do nothing
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->local_load_(archive, task_ptr);
   }
 }
 
@@ -625,789 +434,58 @@ hipc::FullPtr<chi::Task> Runtime::LocalAllocLoadTask(chi::u32 method, chi::Defau
 
 void Runtime::LocalSaveTask(chi::u32 method, chi::DefaultSaveArchive& archive, 
                              hipc::FullPtr<chi::Task> task_ptr) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = task_ptr.template Cast<CreateTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = task_ptr.template Cast<DestroyTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = task_ptr.template Cast<MonitorTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kRegisterTarget: {
-      auto typed_task = task_ptr.template Cast<RegisterTargetTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kUnregisterTarget: {
-      auto typed_task = task_ptr.template Cast<UnregisterTargetTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kListTargets: {
-      auto typed_task = task_ptr.template Cast<ListTargetsTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kStatTargets: {
-      auto typed_task = task_ptr.template Cast<StatTargetsTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetOrCreateTag: {
-      auto typed_task = task_ptr.template Cast<core::GetOrCreateTagTask<core::CreateParams>>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kPutBlob: {
-      auto typed_task = task_ptr.template Cast<PutBlobTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetBlob: {
-      auto typed_task = task_ptr.template Cast<GetBlobTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kReorganizeBlob: {
-      auto typed_task = task_ptr.template Cast<ReorganizeBlobTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kDelBlob: {
-      auto typed_task = task_ptr.template Cast<DelBlobTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kDelTag: {
-      auto typed_task = task_ptr.template Cast<DelTagTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetTagSize: {
-      auto typed_task = task_ptr.template Cast<GetTagSizeTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kPollTelemetryLog: {
-      auto typed_task = task_ptr.template Cast<PollTelemetryLogTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetBlobScore: {
-      auto typed_task = task_ptr.template Cast<GetBlobScoreTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetBlobSize: {
-      auto typed_task = task_ptr.template Cast<GetBlobSizeTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetContainedBlobs: {
-      auto typed_task = task_ptr.template Cast<GetContainedBlobsTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetBlobInfo: {
-      auto typed_task = task_ptr.template Cast<GetBlobInfoTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kTagQuery: {
-      auto typed_task = task_ptr.template Cast<TagQueryTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kBlobQuery: {
-      auto typed_task = task_ptr.template Cast<BlobQueryTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kGetTargetInfo: {
-      auto typed_task = task_ptr.template Cast<GetTargetInfoTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kFlushMetadata: {
-      auto typed_task = task_ptr.template Cast<FlushMetadataTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    case Method::kFlushData: {
-      auto typed_task = task_ptr.template Cast<FlushDataTask>();
-      // Use archive operator which respects msg_type
-      archive << *typed_task.ptr_;
-      break;
-    }
-    default: {
-      // Unknown method - do nothing
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->local_save_(archive, task_ptr);
   }
 }
 
 hipc::FullPtr<chi::Task> Runtime::NewCopyTask(chi::u32 method, hipc::FullPtr<chi::Task> orig_task_ptr, bool deep) {
+  (void)deep;    // Deep copy parameter reserved for future use
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    return exec->new_copy_(orig_task_ptr);
+  }
+  // For unknown methods, create base Task copy
   auto* ipc_manager = CHI_IPC;
   if (!ipc_manager) {
     return hipc::FullPtr<chi::Task>();
   }
-  
-  switch (method) {
-    case Method::kCreate: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<CreateTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<CreateTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kDestroy: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<DestroyTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<DestroyTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kMonitor: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<MonitorTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<MonitorTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kRegisterTarget: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<RegisterTargetTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<RegisterTargetTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kUnregisterTarget: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<UnregisterTargetTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<UnregisterTargetTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kListTargets: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<ListTargetsTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<ListTargetsTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kStatTargets: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<StatTargetsTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<StatTargetsTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kGetOrCreateTag: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<core::GetOrCreateTagTask<core::CreateParams>>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<core::GetOrCreateTagTask<core::CreateParams>>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kPutBlob: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<PutBlobTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<PutBlobTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kGetBlob: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<GetBlobTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<GetBlobTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kReorganizeBlob: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<ReorganizeBlobTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<ReorganizeBlobTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kDelBlob: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<DelBlobTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<DelBlobTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kDelTag: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<DelTagTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<DelTagTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kGetTagSize: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<GetTagSizeTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<GetTagSizeTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kPollTelemetryLog: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<PollTelemetryLogTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<PollTelemetryLogTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kGetBlobScore: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<GetBlobScoreTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<GetBlobScoreTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kGetBlobSize: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<GetBlobSizeTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<GetBlobSizeTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kGetContainedBlobs: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<GetContainedBlobsTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<GetContainedBlobsTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kGetBlobInfo: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<GetBlobInfoTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<GetBlobInfoTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kTagQuery: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<TagQueryTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<TagQueryTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kBlobQuery: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<BlobQueryTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<BlobQueryTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kGetTargetInfo: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<GetTargetInfoTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<GetTargetInfoTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kFlushMetadata: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<FlushMetadataTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<FlushMetadataTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    case Method::kFlushData: {
-      // Allocate new task
-      auto new_task_ptr = ipc_manager->NewTask<FlushDataTask>();
-      if (!new_task_ptr.IsNull()) {
-        // Copy task fields (includes base Task fields)
-        auto task_typed = orig_task_ptr.template Cast<FlushDataTask>();
-        new_task_ptr->Copy(task_typed);
-        return new_task_ptr.template Cast<chi::Task>();
-      }
-      break;
-    }
-    default: {
-      // For unknown methods, create base Task copy
-      auto new_task_ptr = ipc_manager->NewTask<chi::Task>();
-      if (!new_task_ptr.IsNull()) {
-        new_task_ptr->Copy(orig_task_ptr);
-        return new_task_ptr;
-      }
-      break;
-    }
+  auto new_task_ptr = ipc_manager->NewTask<chi::Task>();
+  if (!new_task_ptr.IsNull()) {
+    new_task_ptr->Copy(orig_task_ptr);
   }
-  
-  (void)deep;    // Deep copy parameter reserved for future use
-  return hipc::FullPtr<chi::Task>();
+  return new_task_ptr;
 }
 
 hipc::FullPtr<chi::Task> Runtime::NewTask(chi::u32 method) {
-  auto* ipc_manager = CHI_IPC;
-  if (!ipc_manager) {
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec == nullptr) {
+    // For unknown methods, return null pointer
     return hipc::FullPtr<chi::Task>();
   }
-  
-  switch (method) {
-    case Method::kCreate: {
-      auto new_task_ptr = ipc_manager->NewTask<CreateTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kDestroy: {
-      auto new_task_ptr = ipc_manager->NewTask<DestroyTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kMonitor: {
-      auto new_task_ptr = ipc_manager->NewTask<MonitorTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kRegisterTarget: {
-      auto new_task_ptr = ipc_manager->NewTask<RegisterTargetTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kUnregisterTarget: {
-      auto new_task_ptr = ipc_manager->NewTask<UnregisterTargetTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kListTargets: {
-      auto new_task_ptr = ipc_manager->NewTask<ListTargetsTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kStatTargets: {
-      auto new_task_ptr = ipc_manager->NewTask<StatTargetsTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kGetOrCreateTag: {
-      auto new_task_ptr = ipc_manager->NewTask<core::GetOrCreateTagTask<core::CreateParams>>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kPutBlob: {
-      auto new_task_ptr = ipc_manager->NewTask<PutBlobTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kGetBlob: {
-      auto new_task_ptr = ipc_manager->NewTask<GetBlobTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kReorganizeBlob: {
-      auto new_task_ptr = ipc_manager->NewTask<ReorganizeBlobTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kDelBlob: {
-      auto new_task_ptr = ipc_manager->NewTask<DelBlobTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kDelTag: {
-      auto new_task_ptr = ipc_manager->NewTask<DelTagTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kGetTagSize: {
-      auto new_task_ptr = ipc_manager->NewTask<GetTagSizeTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kPollTelemetryLog: {
-      auto new_task_ptr = ipc_manager->NewTask<PollTelemetryLogTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kGetBlobScore: {
-      auto new_task_ptr = ipc_manager->NewTask<GetBlobScoreTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kGetBlobSize: {
-      auto new_task_ptr = ipc_manager->NewTask<GetBlobSizeTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kGetContainedBlobs: {
-      auto new_task_ptr = ipc_manager->NewTask<GetContainedBlobsTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kGetBlobInfo: {
-      auto new_task_ptr = ipc_manager->NewTask<GetBlobInfoTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kTagQuery: {
-      auto new_task_ptr = ipc_manager->NewTask<TagQueryTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kBlobQuery: {
-      auto new_task_ptr = ipc_manager->NewTask<BlobQueryTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kGetTargetInfo: {
-      auto new_task_ptr = ipc_manager->NewTask<GetTargetInfoTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kFlushMetadata: {
-      auto new_task_ptr = ipc_manager->NewTask<FlushMetadataTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    case Method::kFlushData: {
-      auto new_task_ptr = ipc_manager->NewTask<FlushDataTask>();
-      return new_task_ptr.template Cast<chi::Task>();
-    }
-    default: {
-      // For unknown methods, return null pointer
-      return hipc::FullPtr<chi::Task>();
-    }
-  }
+  return exec->new_task_();
 }
 
 void Runtime::Aggregate(chi::u32 method, hipc::FullPtr<chi::Task> orig_task,
                         const hipc::FullPtr<chi::Task>& replica_task) {
-  switch (method) {
-    case Method::kCreate: {
-      auto typed_task = orig_task.template Cast<CreateTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kDestroy: {
-      auto typed_task = orig_task.template Cast<DestroyTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kMonitor: {
-      auto typed_task = orig_task.template Cast<MonitorTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kRegisterTarget: {
-      auto typed_task = orig_task.template Cast<RegisterTargetTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kUnregisterTarget: {
-      auto typed_task = orig_task.template Cast<UnregisterTargetTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kListTargets: {
-      auto typed_task = orig_task.template Cast<ListTargetsTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kStatTargets: {
-      auto typed_task = orig_task.template Cast<StatTargetsTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kGetOrCreateTag: {
-      auto typed_task = orig_task.template Cast<core::GetOrCreateTagTask<core::CreateParams>>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kPutBlob: {
-      auto typed_task = orig_task.template Cast<PutBlobTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kGetBlob: {
-      auto typed_task = orig_task.template Cast<GetBlobTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kReorganizeBlob: {
-      auto typed_task = orig_task.template Cast<ReorganizeBlobTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kDelBlob: {
-      auto typed_task = orig_task.template Cast<DelBlobTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kDelTag: {
-      auto typed_task = orig_task.template Cast<DelTagTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kGetTagSize: {
-      auto typed_task = orig_task.template Cast<GetTagSizeTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kPollTelemetryLog: {
-      auto typed_task = orig_task.template Cast<PollTelemetryLogTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kGetBlobScore: {
-      auto typed_task = orig_task.template Cast<GetBlobScoreTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kGetBlobSize: {
-      auto typed_task = orig_task.template Cast<GetBlobSizeTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kGetContainedBlobs: {
-      auto typed_task = orig_task.template Cast<GetContainedBlobsTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kGetBlobInfo: {
-      auto typed_task = orig_task.template Cast<GetBlobInfoTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kTagQuery: {
-      auto typed_task = orig_task.template Cast<TagQueryTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kBlobQuery: {
-      auto typed_task = orig_task.template Cast<BlobQueryTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kGetTargetInfo: {
-      auto typed_task = orig_task.template Cast<GetTargetInfoTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kFlushMetadata: {
-      auto typed_task = orig_task.template Cast<FlushMetadataTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    case Method::kFlushData: {
-      auto typed_task = orig_task.template Cast<FlushDataTask>();
-      typed_task->Aggregate(replica_task);
-      break;
-    }
-    default: {
-      orig_task->Aggregate(replica_task);
-      break;
-    }
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->aggregate_(orig_task, replica_task);
+  } else {
+    orig_task->Aggregate(replica_task);
   }
 }
 
 void Runtime::DelTask(chi::u32 method, hipc::FullPtr<chi::Task> task_ptr) {
+  const chi::MethodExec *exec = chi::FindMethodExec(kMethodExec, method);
+  if (exec != nullptr) {
+    exec->del_(task_ptr);
+    return;
+  }
   auto* ipc_manager = CHI_IPC;
   if (!ipc_manager) return;
-  switch (method) {
-    case Method::kCreate: {
-      ipc_manager->DelTask(task_ptr.template Cast<CreateTask>());
-      break;
-    }
-    case Method::kDestroy: {
-      ipc_manager->DelTask(task_ptr.template Cast<DestroyTask>());
-      break;
-    }
-    case Method::kMonitor: {
-      ipc_manager->DelTask(task_ptr.template Cast<MonitorTask>());
-      break;
-    }
-    case Method::kRegisterTarget: {
-      ipc_manager->DelTask(task_ptr.template Cast<RegisterTargetTask>());
-      break;
-    }
-    case Method::kUnregisterTarget: {
-      ipc_manager->DelTask(task_ptr.template Cast<UnregisterTargetTask>());
-      break;
-    }
-    case Method::kListTargets: {
-      ipc_manager->DelTask(task_ptr.template Cast<ListTargetsTask>());
-      break;
-    }
-    case Method::kStatTargets: {
-      ipc_manager->DelTask(task_ptr.template Cast<StatTargetsTask>());
-      break;
-    }
-    case Method::kGetOrCreateTag: {
-      ipc_manager->DelTask(task_ptr.template Cast<core::GetOrCreateTagTask<core::CreateParams>>());
-      break;
-    }
-    case Method::kPutBlob: {
-      ipc_manager->DelTask(task_ptr.template Cast<PutBlobTask>());
-      break;
-    }
-    case Method::kGetBlob: {
-      ipc_manager->DelTask(task_ptr.template Cast<GetBlobTask>());
-      break;
-    }
-    case Method::kReorganizeBlob: {
-      ipc_manager->DelTask(task_ptr.template Cast<ReorganizeBlobTask>());
-      break;
-    }
-    case Method::kDelBlob: {
-      ipc_manager->DelTask(task_ptr.template Cast<DelBlobTask>());
-      break;
-    }
-    case Method::kDelTag: {
-      ipc_manager->DelTask(task_ptr.template Cast<DelTagTask>());
-      break;
-    }
-    case Method::kGetTagSize: {
-      ipc_manager->DelTask(task_ptr.template Cast<GetTagSizeTask>());
-      break;
-    }
-    case Method::kPollTelemetryLog: {
-      ipc_manager->DelTask(task_ptr.template Cast<PollTelemetryLogTask>());
-      break;
-    }
-    case Method::kGetBlobScore: {
-      ipc_manager->DelTask(task_ptr.template Cast<GetBlobScoreTask>());
-      break;
-    }
-    case Method::kGetBlobSize: {
-      ipc_manager->DelTask(task_ptr.template Cast<GetBlobSizeTask>());
-      break;
-    }
-    case Method::kGetContainedBlobs: {
-      ipc_manager->DelTask(task_ptr.template Cast<GetContainedBlobsTask>());
-      break;
-    }
-    case Method::kGetBlobInfo: {
-      ipc_manager->DelTask(task_ptr.template Cast<GetBlobInfoTask>());
-      break;
-    }
-    case Method::kTagQuery: {
-      ipc_manager->DelTask(task_ptr.template Cast<TagQueryTask>());
-      break;
-    }
-    case Method::kBlobQuery: {
-      ipc_manager->DelTask(task_ptr.template Cast<BlobQueryTask>());
-      break;
-    }
-    case Method::kGetTargetInfo: {
-      ipc_manager->DelTask(task_ptr.template Cast<GetTargetInfoTask>());
-      break;
-    }
-    case Method::kFlushMetadata: {
-      ipc_manager->DelTask(task_ptr.template Cast<FlushMetadataTask>());
-      break;
-    }
-    case Method::kFlushData: {
-      ipc_manager->DelTask(task_ptr.template Cast<FlushDataTask>());
-      break;
-    }
-    default: {
-      ipc_manager->DelTask(task_ptr);
-      break;
-    }
-  }
+  ipc_manager->DelTask(task_ptr);
 }
 
 } // namespace wrp_cte::core
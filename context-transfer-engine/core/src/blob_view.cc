@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <wrp_cte/core/blob_view.h>
+#include <wrp_cte/core/core_client.h>
+
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace wrp_cte::core {
+
+namespace {
+
+/** A target buffer mapped into this process */
+struct MappedTarget {
+  const char *data_;
+  chi::u64 size_;
+};
+
+/** Mappings stay until exit: targets outlive the views of a process */
+std::mutex g_map_lock;
+std::unordered_map<chi::PoolId, MappedTarget> g_mapped_targets;
+
+}  // namespace
+
+BlobView::BlobView(const TagId &tag_id, const std::string &blob_name,
+                   chi::u64 lease_id, chi::u64 lease_ms,
+                   std::vector<BlobViewPiece> pieces)
+    : tag_id_(tag_id),
+      blob_name_(blob_name),
+      lease_id_(lease_id),
+      deadline_(Clock::now() + std::chrono::milliseconds(lease_ms)),
+      pieces_(std::move(pieces)) {
+  for (const auto &piece : pieces_) {
+    size_ += piece.size_;
+  }
+}
+
+BlobView::BlobView(BlobView &&other) noexcept
+    : tag_id_(other.tag_id_),
+      blob_name_(std::move(other.blob_name_)),
+      lease_id_(other.lease_id_),
+      deadline_(other.deadline_),
+      pieces_(std::move(other.pieces_)),
+      size_(other.size_) {
+  other.lease_id_ = 0;
+  other.size_ = 0;
+}
+
+BlobView &BlobView::operator=(BlobView &&other) noexcept {
+  if (this != &other) {
+    Release();
+    tag_id_ = other.tag_id_;
+    blob_name_ = std::move(other.blob_name_);
+    lease_id_ = other.lease_id_;
+    deadline_ = other.deadline_;
+    pieces_ = std::move(other.pieces_);
+    size_ = other.size_;
+    other.lease_id_ = 0;
+    other.size_ = 0;
+  }
+  return *this;
+}
+
+void BlobView::CopyTo(char *data) const {
+  for (const auto &piece : pieces_) {
+    memcpy(data, piece.data_, piece.size_);
+    data += piece.size_;
+  }
+}
+
+void BlobView::Release() {
+  if (lease_id_ == 0) {
+    return;
+  }
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto task =
+      cte_client->AsyncReleaseBlobView(tag_id_, blob_name_, lease_id_);
+  task.Wait();
+  lease_id_ = 0;
+  pieces_.clear();
+  size_ = 0;
+}
+
+const char *BlobView::MapTarget(const chi::PoolId &target_id,
+                                chi::u64 segment_size) {
+  std::lock_guard<std::mutex> guard(g_map_lock);
+  auto it = g_mapped_targets.find(target_id);
+  if (it != g_mapped_targets.end() && it->second.size_ >= segment_size) {
+    return it->second.data_;
+  }
+  hshm::File fd;
+  std::string name = chimaera::bdev::GetRamSegmentName(target_id);
+  if (!hshm::SystemInfo::OpenSharedMemory(fd, name)) {
+    return nullptr;
+  }
+  void *ptr =
+      hshm::SystemInfo::MapSharedMemoryReadOnly(fd, segment_size, 0);
+  hshm::SystemInfo::CloseSharedMemory(fd);
+  if (ptr == nullptr) {
+    return nullptr;
+  }
+  // A smaller earlier mapping may still back live views, so it is kept
+  g_mapped_targets[target_id] = {static_cast<const char *>(ptr),
+                                 segment_size};
+  return static_cast<const char *>(ptr);
+}
+
+}  // namespace wrp_cte::core
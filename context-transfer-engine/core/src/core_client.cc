@@ -62,6 +62,10 @@ bool WRP_CTE_CLIENT_INIT(const std::string &config_path,
   // Mark as initialized on success
   if (result) {
     s_initialized = true;
+    auto *chimaera_manager = CHI_CHIMAERA_MANAGER;
+    if (chimaera_manager != nullptr && chimaera_manager->IsClient()) {
+      WorkloadRecorder::InitFromEnv();
+    }
   }
 
   return result;
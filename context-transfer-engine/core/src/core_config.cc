@@ -32,12 +32,14 @@
  */
 
 #include <wrp_cte/core/core_config.h>
+
 #include <yaml-cpp/yaml.h>
 #include <fstream>
 #include <iostream>
 #include <cstdlib>
 #include <cctype>
 #include <cstdio>
+#include <regex>
 #include "hermes_shm/util/logging.h"
 
 namespace wrp_cte::core {
@@ -178,6 +180,45 @@ bool Config::Validate() const {
     return false;
   }
 
+  if (performance_.migrate_period_ms_ > 0 &&
+      (performance_.migrate_half_life_ms_ == 0 ||
+       performance_.migrate_demote_heat_ >= performance_.migrate_promote_heat_)) {
+    HLOG(kError, "Config validation error: migration needs migrate_half_life_ms > 0 and migrate_demote_heat < migrate_promote_heat");
+    return false;
+  }
+
+  if (performance_.evict_period_ms_ > 0 &&
+      !(performance_.evict_low_watermark_ > 0.0f &&
+        performance_.evict_low_watermark_ < performance_.evict_high_watermark_ &&
+        performance_.evict_high_watermark_ <= 1.0f)) {
+    HLOG(kError, "Config validation error: eviction needs 0 < evict_low_watermark < evict_high_watermark <= 1");
+    return false;
+  }
+
+  if (performance_.evict_policy_ != "lru" && performance_.evict_policy_ != "lfu" &&
+      performance_.evict_policy_ != "arc") {
+    HLOG(kError, "Config validation error: Invalid evict_policy '{}' (must be 'lru', 'lfu', or 'arc')", performance_.evict_policy_);
+    return false;
+  }
+
+  if (performance_.small_object_max_size_ > 0 &&
+      (performance_.small_segment_size_ < 16 * performance_.small_object_max_size_ ||
+       performance_.small_segment_clean_ratio_ < 0.0f ||
+       performance_.small_segment_clean_ratio_ >= 1.0f)) {
+    HLOG(kError, "Config validation error: packing needs small_segment_size >= 16 * small_object_max_size and 0 <= small_segment_clean_ratio < 1");
+    return false;
+  }
+
+  if (performance_.telemetry_capacity_ == 0 || performance_.telemetry_capacity_ > (1u << 24)) {
+    HLOG(kError, "Config validation error: Invalid telemetry_capacity {} (must be 1-16777216)", performance_.telemetry_capacity_);
+    return false;
+  }
+
+  if (performance_.telemetry_sample_rate_ == 0) {
+    HLOG(kError, "Config validation error: telemetry_sample_rate must be at least 1");
+    return false;
+  }
+
   // Validate target configuration
   if (targets_.neighborhood_ == 0 || targets_.neighborhood_ > 1024) {
     HLOG(kError, "Config validation error: Invalid neighborhood {} (must be 1-1024)", targets_.neighborhood_);
@@ -287,6 +328,13 @@ bool Config::ParseYamlNode(const YAML::Node &node) {
     }
   }
 
+  // Parse QoS configuration
+  if (node["qos"]) {
+    if (!ParseQosConfig(node["qos"])) {
+      return false;
+    }
+  }
+
   // Parse environment variable configuration
   if (node["config_env_var"]) {
     config_env_var_ = node["config_env_var"].as<std::string>();
@@ -311,10 +359,44 @@ void Config::EmitYaml(YAML::Emitter &emitter) const {
   if (!performance_.metadata_log_path_.empty()) {
     emitter << YAML::Key << "metadata_log_path" << YAML::Value << performance_.metadata_log_path_;
   }
+  emitter << YAML::Key << "metadata_compact_deltas" << YAML::Value << performance_.metadata_compact_deltas_;
+  if (!performance_.encryption_key_path_.empty()) {
+    emitter << YAML::Key << "encryption_key_path" << YAML::Value << performance_.encryption_key_path_;
+  }
   emitter << YAML::Key << "transaction_log_capacity"
           << YAML::Value << FormatSizeBytes(performance_.transaction_log_capacity_bytes_);
+  emitter << YAML::Key << "transaction_log_segment_size"
+          << YAML::Value << FormatSizeBytes(performance_.transaction_log_segment_bytes_);
+  emitter << YAML::Key << "transaction_log_commit_ms" << YAML::Value << performance_.transaction_log_commit_ms_;
   emitter << YAML::Key << "flush_data_period_ms" << YAML::Value << performance_.flush_data_period_ms_;
   emitter << YAML::Key << "flush_data_min_persistence" << YAML::Value << performance_.flush_data_min_persistence_;
+  emitter << YAML::Key << "flush_data_max_inflight" << YAML::Value << performance_.flush_data_max_inflight_;
+  emitter << YAML::Key << "defrag_period_ms" << YAML::Value << performance_.defrag_period_ms_;
+  emitter << YAML::Key << "defrag_min_blocks" << YAML::Value << performance_.defrag_min_blocks_;
+  emitter << YAML::Key << "migrate_period_ms" << YAML::Value << performance_.migrate_period_ms_;
+  emitter << YAML::Key << "migrate_bandwidth_mbps" << YAML::Value << performance_.migrate_bandwidth_mbps_;
+  emitter << YAML::Key << "migrate_half_life_ms" << YAML::Value << performance_.migrate_half_life_ms_;
+  emitter << YAML::Key << "migrate_promote_heat" << YAML::Value << performance_.migrate_promote_heat_;
+  emitter << YAML::Key << "migrate_demote_heat" << YAML::Value << performance_.migrate_demote_heat_;
+  emitter << YAML::Key << "evict_period_ms" << YAML::Value << performance_.evict_period_ms_;
+  emitter << YAML::Key << "evict_high_watermark" << YAML::Value << performance_.evict_high_watermark_;
+  emitter << YAML::Key << "evict_low_watermark" << YAML::Value << performance_.evict_low_watermark_;
+  emitter << YAML::Key << "evict_policy" << YAML::Value << performance_.evict_policy_;
+  emitter << YAML::Key << "read_cache_size"
+          << YAML::Value << FormatSizeBytes(performance_.read_cache_size_);
+  emitter << YAML::Key << "read_cache_max_blob"
+          << YAML::Value << FormatSizeBytes(performance_.read_cache_max_blob_);
+  emitter << YAML::Key << "small_object_max_size"
+          << YAML::Value << FormatSizeBytes(performance_.small_object_max_size_);
+  emitter << YAML::Key << "small_segment_size"
+          << YAML::Value << FormatSizeBytes(performance_.small_segment_size_);
+  emitter << YAML::Key << "small_segment_clean_ratio" << YAML::Value << performance_.small_segment_clean_ratio_;
+  emitter << YAML::Key << "expire_period_ms" << YAML::Value << performance_.expire_period_ms_;
+  emitter << YAML::Key << "replica_repair_period_ms" << YAML::Value << performance_.replica_repair_period_ms_;
+  emitter << YAML::Key << "placement_vnodes" << YAML::Value << performance_.placement_vnodes_;
+  emitter << YAML::Key << "rebalance_period_ms" << YAML::Value << performance_.rebalance_period_ms_;
+  emitter << YAML::Key << "telemetry_capacity" << YAML::Value << performance_.telemetry_capacity_;
+  emitter << YAML::Key << "telemetry_sample_rate" << YAML::Value << performance_.telemetry_sample_rate_;
   emitter << YAML::EndMap;
 
   // Emit target configuration
@@ -337,6 +419,12 @@ void Config::EmitYaml(YAML::Emitter &emitter) const {
       if (device.score_ >= 0.0f) {
         emitter << YAML::Key << "score" << YAML::Value << device.score_;
       }
+      if (device.max_bandwidth_ > 0) {
+        emitter << YAML::Key << "max_bandwidth" << YAML::Value << FormatSizeBytes(device.max_bandwidth_);
+      }
+      if (device.numa_node_ >= 0) {
+        emitter << YAML::Key << "numa_node" << YAML::Value << device.numa_node_;
+      }
       
       emitter << YAML::EndMap;
     }
@@ -348,6 +436,23 @@ void Config::EmitYaml(YAML::Emitter &emitter) const {
   emitter << YAML::Key << "dpe_type" << YAML::Value << dpe_.dpe_type_;
   emitter << YAML::EndMap;
 
+  // Emit QoS configuration
+  if (!qos_.classes_.empty()) {
+    emitter << YAML::Key << "qos" << YAML::Value << YAML::BeginMap;
+    emitter << YAML::Key << "classes" << YAML::Value << YAML::BeginSeq;
+    for (const auto& qos_class : qos_.classes_) {
+      emitter << YAML::BeginMap;
+      emitter << YAML::Key << "name" << YAML::Value << qos_class.name_;
+      emitter << YAML::Key << "weight" << YAML::Value << qos_class.weight_;
+      emitter << YAML::Key << "rate" << YAML::Value << FormatSizeBytes(qos_class.rate_);
+      emitter << YAML::Key << "burst" << YAML::Value << FormatSizeBytes(qos_class.burst_);
+      emitter << YAML::Key << "tags" << YAML::Value << qos_class.tag_patterns_;
+      emitter << YAML::EndMap;
+    }
+    emitter << YAML::EndSeq;
+    emitter << YAML::EndMap;
+  }
+
   emitter << YAML::EndMap;
 }
 
@@ -381,6 +486,15 @@ bool Config::ParsePerformanceConfig(const YAML::Node &node) {
     performance_.metadata_log_path_ = hshm::ConfigParse::ExpandPath(path);
   }
 
+  if (node["encryption_key_path"]) {
+    std::string path = node["encryption_key_path"].as<std::string>();
+    performance_.encryption_key_path_ = hshm::ConfigParse::ExpandPath(path);
+  }
+
+  if (node["metadata_compact_deltas"]) {
+    performance_.metadata_compact_deltas_ = node["metadata_compact_deltas"].as<chi::u32>();
+  }
+
   if (node["flush_data_period_ms"]) {
     performance_.flush_data_period_ms_ = node["flush_data_period_ms"].as<chi::u32>();
   }
@@ -389,11 +503,116 @@ bool Config::ParsePerformanceConfig(const YAML::Node &node) {
     performance_.flush_data_min_persistence_ = node["flush_data_min_persistence"].as<int>();
   }
 
+  if (node["flush_data_max_inflight"]) {
+    performance_.flush_data_max_inflight_ = node["flush_data_max_inflight"].as<chi::u32>();
+  }
+
+  if (node["defrag_period_ms"]) {
+    performance_.defrag_period_ms_ = node["defrag_period_ms"].as<chi::u32>();
+  }
+
+  if (node["defrag_min_blocks"]) {
+    performance_.defrag_min_blocks_ = node["defrag_min_blocks"].as<chi::u32>();
+  }
+
+  if (node["migrate_period_ms"]) {
+    performance_.migrate_period_ms_ = node["migrate_period_ms"].as<chi::u32>();
+  }
+
+  if (node["migrate_bandwidth_mbps"]) {
+    performance_.migrate_bandwidth_mbps_ = node["migrate_bandwidth_mbps"].as<chi::u32>();
+  }
+
+  if (node["migrate_half_life_ms"]) {
+    performance_.migrate_half_life_ms_ = node["migrate_half_life_ms"].as<chi::u32>();
+  }
+
+  if (node["migrate_promote_heat"]) {
+    performance_.migrate_promote_heat_ = node["migrate_promote_heat"].as<float>();
+  }
+
+  if (node["migrate_demote_heat"]) {
+    performance_.migrate_demote_heat_ = node["migrate_demote_heat"].as<float>();
+  }
+
+  if (node["evict_period_ms"]) {
+    performance_.evict_period_ms_ = node["evict_period_ms"].as<chi::u32>();
+  }
+
+  if (node["evict_high_watermark"]) {
+    performance_.evict_high_watermark_ = node["evict_high_watermark"].as<float>();
+  }
+
+  if (node["evict_low_watermark"]) {
+    performance_.evict_low_watermark_ = node["evict_low_watermark"].as<float>();
+  }
+
+  if (node["evict_policy"]) {
+    performance_.evict_policy_ = node["evict_policy"].as<std::string>();
+  }
+
+  if (node["read_cache_size"]) {
+    std::string size_str = node["read_cache_size"].as<std::string>();
+    ParseSizeString(size_str, performance_.read_cache_size_);
+  }
+
+  if (node["read_cache_max_blob"]) {
+    std::string size_str = node["read_cache_max_blob"].as<std::string>();
+    ParseSizeString(size_str, performance_.read_cache_max_blob_);
+  }
+
+  if (node["small_object_max_size"]) {
+    std::string size_str = node["small_object_max_size"].as<std::string>();
+    ParseSizeString(size_str, performance_.small_object_max_size_);
+  }
+
+  if (node["small_segment_size"]) {
+    std::string size_str = node["small_segment_size"].as<std::string>();
+    ParseSizeString(size_str, performance_.small_segment_size_);
+  }
+
+  if (node["small_segment_clean_ratio"]) {
+    performance_.small_segment_clean_ratio_ = node["small_segment_clean_ratio"].as<float>();
+  }
+
+  if (node["expire_period_ms"]) {
+    performance_.expire_period_ms_ = node["expire_period_ms"].as<chi::u32>();
+  }
+
+  if (node["replica_repair_period_ms"]) {
+    performance_.replica_repair_period_ms_ = node["replica_repair_period_ms"].as<chi::u32>();
+  }
+
+  if (node["placement_vnodes"]) {
+    performance_.placement_vnodes_ = node["placement_vnodes"].as<chi::u32>();
+  }
+
+  if (node["rebalance_period_ms"]) {
+    performance_.rebalance_period_ms_ = node["rebalance_period_ms"].as<chi::u32>();
+  }
+
   if (node["transaction_log_capacity"]) {
     std::string cap_str = node["transaction_log_capacity"].as<std::string>();
     ParseSizeString(cap_str, performance_.transaction_log_capacity_bytes_);
   }
 
+  if (node["transaction_log_segment_size"]) {
+    std::string seg_str = node["transaction_log_segment_size"].as<std::string>();
+    ParseSizeString(seg_str, performance_.transaction_log_segment_bytes_);
+  }
+
+  if (node["transaction_log_commit_ms"]) {
+    performance_.transaction_log_commit_ms_ = node["transaction_log_commit_ms"].as<chi::u32>();
+  }
+
+  if (node["telemetry_capacity"]) {
+    performance_.telemetry_capacity_ = node["telemetry_capacity"].as<chi::u32>();
+  }
+
+  if (node["telemetry_sample_rate"]) {
+    performance_.telemetry_sample_rate_ = node["telemetry_sample_rate"].as<chi::u32>();
+  }
+
   return true;
 }
 
@@ -443,8 +662,9 @@ bool Config::ParseStorageConfig(const YAML::Node &node) {
     // Validate bdev_type
     if (device_config.bdev_type_ != "file" && device_config.bdev_type_ != "ram" &&
         device_config.bdev_type_ != "hbm" && device_config.bdev_type_ != "pinned" &&
-        device_config.bdev_type_ != "noop") {
-      HLOG(kError, "Config error: Invalid bdev_type '{}' (must be 'file', 'ram', 'hbm', 'pinned', or 'noop')", device_config.bdev_type_);
+        device_config.bdev_type_ != "noop" && device_config.bdev_type_ != "nvme" &&
+        device_config.bdev_type_ != "gds") {
+      HLOG(kError, "Config error: Invalid bdev_type '{}' (must be 'file', 'ram', 'hbm', 'pinned', 'noop', 'nvme', or 'gds')", device_config.bdev_type_);
       return false;
     }
     
@@ -473,6 +693,20 @@ bool Config::ParseStorageConfig(const YAML::Node &node) {
       }
     }
     // score_ defaults to -1.0f (use automatic scoring) if not specified
+
+    // Parse max_bandwidth (optional, bytes per second)
+    if (device_node["max_bandwidth"]) {
+      std::string bandwidth_str = device_node["max_bandwidth"].as<std::string>();
+      if (!ParseSizeString(bandwidth_str, device_config.max_bandwidth_)) {
+        HLOG(kError, "Config error: Invalid max_bandwidth format '{}' for device {}", bandwidth_str, device_config.path_);
+        return false;
+      }
+    }
+    
+    // Parse numa_node (optional, detected from the path when omitted)
+    if (device_node["numa_node"]) {
+      device_config.numa_node_ = device_node["numa_node"].as<int>();
+    }
     
     // Validate parsed values
     if (device_config.path_.empty()) {
@@ -498,8 +732,9 @@ bool Config::ParseDpeConfig(const YAML::Node &node) {
 
     // Validate DPE type
     if (dpe_type != "random" && dpe_type != "round_robin" &&
-        dpe_type != "roundrobin" && dpe_type != "max_bw" && dpe_type != "maxbw") {
-      HLOG(kError, "Config error: Invalid dpe_type '{}' (must be 'random', 'round_robin', or 'max_bw')", dpe_type);
+        dpe_type != "roundrobin" && dpe_type != "max_bw" && dpe_type != "maxbw" &&
+        dpe_type != "min_completion") {
+      HLOG(kError, "Config error: Invalid dpe_type '{}' (must be 'random', 'round_robin', 'max_bw', or 'min_completion')", dpe_type);
       return false;
     }
 
@@ -510,6 +745,62 @@ bool Config::ParseDpeConfig(const YAML::Node &node) {
   return true;
 }
 
+bool Config::ParseQosConfig(const YAML::Node &node) {
+  qos_.classes_.clear();
+  if (!node["classes"]) {
+    return true;
+  }
+  if (!node["classes"].IsSequence()) {
+    HLOG(kError, "Config error: qos.classes must be a sequence");
+    return false;
+  }
+  for (const auto& class_node : node["classes"]) {
+    QosClassConfig qos_class;
+    if (!class_node["name"]) {
+      HLOG(kError, "Config error: QoS class missing required 'name' field");
+      return false;
+    }
+    qos_class.name_ = class_node["name"].as<std::string>();
+    if (class_node["weight"]) {
+      qos_class.weight_ = class_node["weight"].as<chi::u32>();
+    }
+    if (qos_class.weight_ == 0) {
+      HLOG(kError, "Config error: QoS class '{}' weight must be greater than 0", qos_class.name_);
+      return false;
+    }
+    if (class_node["rate"]) {
+      std::string rate_str = class_node["rate"].as<std::string>();
+      if (!ParseSizeString(rate_str, qos_class.rate_)) {
+        HLOG(kError, "Config error: Invalid rate format '{}' for QoS class '{}'", rate_str, qos_class.name_);
+        return false;
+      }
+    }
+    if (class_node["burst"]) {
+      std::string burst_str = class_node["burst"].as<std::string>();
+      if (!ParseSizeString(burst_str, qos_class.burst_) || qos_class.burst_ == 0) {
+        HLOG(kError, "Config error: Invalid burst '{}' for QoS class '{}'", burst_str, qos_class.name_);
+        return false;
+      }
+    }
+    if (class_node["tags"]) {
+      for (const auto& pattern_node : class_node["tags"]) {
+        std::string pattern = pattern_node.as<std::string>();
+        try {
+          std::regex check(pattern);
+        } catch (const std::regex_error &) {
+          HLOG(kError, "Config error: Invalid tag pattern '{}' for QoS class '{}'", pattern, qos_class.name_);
+          return false;
+        }
+        qos_class.tag_patterns_.push_back(pattern);
+      }
+    }
+    qos_.classes_.push_back(std::move(qos_class));
+  }
+
+  HLOG(kInfo, "Parsed {} QoS classes", qos_.classes_.size());
+  return true;
+}
+
 bool Config::ParseSizeString(const std::string &size_str, chi::u64 &size_bytes) const {
   if (size_str.empty()) {
     return false;
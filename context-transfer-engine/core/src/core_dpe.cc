@@ -35,6 +35,7 @@
 #include <algorithm>
 #include <iostream>
 #include <chrono>
+#include <limits>
 #include "hermes_shm/util/logging.h"
 
 namespace wrp_cte::core {
@@ -50,6 +51,8 @@ DpeType StringToDpeType(const std::string& dpe_str) {
     return DpeType::kRoundRobin;
   } else if (dpe_str == "max_bw" || dpe_str == "maxbw") {
     return DpeType::kMaxBW;
+  } else if (dpe_str == "min_completion") {
+    return DpeType::kMinCompletion;
   } else {
     HLOG(kError, "Unknown DPE type: {}, defaulting to random", dpe_str);
     return DpeType::kRandom;
@@ -64,6 +67,8 @@ std::string DpeTypeToString(DpeType dpe_type) {
       return "round_robin";
     case DpeType::kMaxBW:
       return "max_bw";
+    case DpeType::kMinCompletion:
+      return "min_completion";
     default:
       return "random";
   }
@@ -198,7 +203,27 @@ std::vector<TargetInfo> MaxBwDpe::SelectTargets(const std::vector<TargetInfo>& t
   }
 
   // Sort targets by performance metrics (bandwidth or latency)
-  auto perf_comparator = [data_size](const TargetInfo& a, const TargetInfo& b) {
+  // Fitted curves are used only when every candidate has one, so the
+  // ordering stays consistent
+  bool write_fitted = true;
+  bool read_fitted = true;
+  for (const auto& target : available_targets) {
+    write_fitted = write_fitted && target.perf_model_.write_.IsFitted();
+    read_fitted = read_fitted && target.perf_model_.read_.IsFitted();
+  }
+  bool average_read = read_fitted && data_size < kLatencyThreshold;
+  auto predict_us = [data_size, average_read](const TargetInfo& target) {
+    double time = target.perf_model_.write_.PredictUs(data_size);
+    if (average_read) {
+      time = (time + target.perf_model_.read_.PredictUs(data_size)) / 2.0;
+    }
+    return time;
+  };
+  auto perf_comparator = [data_size, write_fitted, &predict_us](
+                             const TargetInfo& a, const TargetInfo& b) {
+    if (write_fitted) {
+      return predict_us(a) < predict_us(b);
+    }
     if (data_size >= kLatencyThreshold) {
       // Sort by write bandwidth (descending)
       return a.perf_metrics_.write_bandwidth_mbps_ > b.perf_metrics_.write_bandwidth_mbps_;
@@ -259,6 +284,177 @@ std::vector<TargetInfo> MaxBwDpe::SelectTargets(const std::vector<TargetInfo>& t
   return result;
 }
 
+// MinCompletionDpe Implementation
+MinCompletionDpe::MinCompletionDpe() {
+}
+
+double MinCompletionDpe::PredictFinishUs(const TargetInfo& target,
+                                         chi::u64 bytes) {
+  const chimaera::bdev::PerfCurve& curve = target.perf_model_.write_;
+  if (curve.IsFitted()) {
+    // Queued bytes drain at the fitted rate ahead of this write
+    return curve.PredictUs(target.inflight_bytes_ + bytes);
+  }
+  double mbps = std::max(target.perf_metrics_.write_bandwidth_mbps_,
+                         kMinBandwidthMbps);
+  double bytes_per_us = mbps * 1024.0 * 1024.0 / 1e6;
+  double latency_us = std::max(target.perf_metrics_.write_latency_us_, 0.0);
+  return latency_us +
+         static_cast<double>(target.inflight_bytes_ + bytes) / bytes_per_us;
+}
+
+double MinCompletionDpe::PlanStripes(const std::vector<TargetInfo>& targets,
+                                     chi::u64 data_size,
+                                     std::vector<chi::u64>& shares) {
+  size_t n = targets.size();
+  shares.assign(n, 0);
+  std::vector<double> start(n), rate(n);
+  chi::u64 capacity = 0;
+  for (size_t i = 0; i < n; ++i) {
+    start[i] = PredictFinishUs(targets[i], 0);
+    rate[i] = PredictFinishUs(targets[i], kStripeUnit) - start[i];
+    rate[i] = static_cast<double>(kStripeUnit) / rate[i];  // Bytes per us
+    capacity += targets[i].remaining_space_;
+  }
+  if (capacity < data_size) {
+    return -1.0;
+  }
+
+  // Find the time T by which the targets can absorb the data: target i
+  // takes (T - start_i) * rate_i bytes, up to its remaining space
+  auto fill = [&](double t) {
+    double total = 0;
+    for (size_t i = 0; i < n; ++i) {
+      double take = std::max(0.0, (t - start[i]) * rate[i]);
+      total += std::min(take,
+                        static_cast<double>(targets[i].remaining_space_));
+    }
+    return total;
+  };
+  double lo = *std::min_element(start.begin(), start.end());
+  double hi = *std::max_element(start.begin(), start.end()) +
+              static_cast<double>(data_size) /
+                  *std::min_element(rate.begin(), rate.end());
+  for (int iter = 0; iter < 64; ++iter) {
+    double mid = (lo + hi) / 2;
+    (fill(mid) >= static_cast<double>(data_size) ? hi : lo) = mid;
+  }
+
+  // Round down to whole stripe units, then hand out what is left one unit
+  // at a time to whichever target would finish it first
+  chi::u64 planned = 0;
+  for (size_t i = 0; i < n; ++i) {
+    double take = std::min(std::max(0.0, (hi - start[i]) * rate[i]),
+                           static_cast<double>(targets[i].remaining_space_));
+    shares[i] = std::min<chi::u64>(
+        static_cast<chi::u64>(take) / kStripeUnit * kStripeUnit,
+        data_size - planned);
+    planned += shares[i];
+  }
+  while (planned < data_size) {
+    size_t best = n;
+    chi::u64 best_step = 0;
+    double best_finish = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < n; ++i) {
+      chi::u64 step = std::min({kStripeUnit, data_size - planned,
+                                targets[i].remaining_space_ - shares[i]});
+      if (step == 0) continue;
+      double finish = start[i] + static_cast<double>(shares[i] + step) /
+                                     rate[i];
+      if (finish < best_finish) {
+        best = i;
+        best_step = step;
+        best_finish = finish;
+      }
+    }
+    if (best == n) {
+      return -1.0;
+    }
+    shares[best] += best_step;
+    planned += best_step;
+  }
+
+  double finish = 0;
+  for (size_t i = 0; i < n; ++i) {
+    if (shares[i] > 0) {
+      finish = std::max(finish,
+                        start[i] + static_cast<double>(shares[i]) / rate[i]);
+    }
+  }
+  return finish;
+}
+
+std::vector<TargetInfo> MinCompletionDpe::SelectTargets(
+    const std::vector<TargetInfo>& targets, float blob_score,
+    chi::u64 data_size) {
+  std::vector<TargetInfo> result;
+  sizes_.clear();
+
+  // Partition targets with any space by score, as the other engines do;
+  // a target that cannot hold all the data can still take a stripe
+  std::vector<TargetInfo> low_score_targets;
+  std::vector<TargetInfo> high_score_targets;
+  for (const auto& target : targets) {
+    if (target.remaining_space_ == 0) continue;
+    if (target.target_score_ <= blob_score) {
+      low_score_targets.push_back(target);
+    } else {
+      high_score_targets.push_back(target);
+    }
+  }
+
+  // Targets that can hold all the data first, then by predicted finish
+  auto finish_comparator = [data_size](const TargetInfo& a,
+                                       const TargetInfo& b) {
+    bool a_fits = a.remaining_space_ >= data_size;
+    bool b_fits = b.remaining_space_ >= data_size;
+    if (a_fits != b_fits) {
+      return a_fits;
+    }
+    return PredictFinishUs(a, data_size) < PredictFinishUs(b, data_size);
+  };
+  std::sort(low_score_targets.begin(), low_score_targets.end(),
+            finish_comparator);
+  std::sort(high_score_targets.begin(), high_score_targets.end(),
+            finish_comparator);
+
+  std::vector<chi::u64> shares;
+  if (data_size >= kStripeMinSize && low_score_targets.size() >= 2) {
+    double striped = PlanStripes(low_score_targets, data_size, shares);
+    const TargetInfo& best = low_score_targets.front();
+    double single = best.remaining_space_ >= data_size
+                        ? PredictFinishUs(best, data_size)
+                        : std::numeric_limits<double>::infinity();
+    HLOG(kDebug, "MinCompletionDpe::SelectTargets: size={}, single={} us, "
+         "striped={} us", data_size, single, striped);
+    if (striped < 0 || striped >= single) {
+      shares.clear();
+    }
+  }
+
+  // Build result: striped targets first, then the rest of the preferred
+  // tier, then the higher tiers (fallback)
+  result.reserve(low_score_targets.size() + high_score_targets.size());
+  for (size_t i = 0; i < shares.size(); ++i) {
+    if (shares[i] > 0) {
+      result.push_back(low_score_targets[i]);
+      sizes_.push_back(shares[i]);
+    }
+  }
+  for (size_t i = 0; i < low_score_targets.size(); ++i) {
+    if (i >= shares.size() || shares[i] == 0) {
+      result.push_back(low_score_targets[i]);
+    }
+  }
+  for (const auto& target : high_score_targets) {
+    result.push_back(target);
+  }
+  if (!sizes_.empty()) {
+    sizes_.resize(result.size(), 0);
+  }
+  return result;
+}
+
 // DpeFactory Implementation
 std::unique_ptr<DataPlacementEngine> DpeFactory::CreateDpe(DpeType dpe_type) {
   switch (dpe_type) {
@@ -268,6 +464,8 @@ std::unique_ptr<DataPlacementEngine> DpeFactory::CreateDpe(DpeType dpe_type) {
       return std::make_unique<RoundRobinDpe>();
     case DpeType::kMaxBW:
       return std::make_unique<MaxBwDpe>();
+    case DpeType::kMinCompletion:
+      return std::make_unique<MinCompletionDpe>();
     default:
       HLOG(kError, "Unknown DPE type, defaulting to Random");
       return std::make_unique<RandomDpe>();
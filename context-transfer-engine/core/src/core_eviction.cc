@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <wrp_cte/core/core_eviction.h>
+#include <algorithm>
+#include "hermes_shm/util/logging.h"
+
+namespace wrp_cte::core {
+
+// Eviction policy type conversion functions
+EvictionPolicyType StringToEvictionPolicyType(const std::string& policy_str) {
+  if (policy_str == "lru") {
+    return EvictionPolicyType::kLru;
+  } else if (policy_str == "lfu") {
+    return EvictionPolicyType::kLfu;
+  } else if (policy_str == "arc") {
+    return EvictionPolicyType::kArc;
+  } else {
+    HLOG(kError, "Unknown eviction policy: {}, defaulting to arc", policy_str);
+    return EvictionPolicyType::kArc;
+  }
+}
+
+std::string EvictionPolicyTypeToString(EvictionPolicyType policy_type) {
+  switch (policy_type) {
+    case EvictionPolicyType::kLru:
+      return "lru";
+    case EvictionPolicyType::kLfu:
+      return "lfu";
+    case EvictionPolicyType::kArc:
+      return "arc";
+    default:
+      return "arc";
+  }
+}
+
+namespace {
+
+/** Oldest access first */
+bool OlderAccess(const EvictionCandidate& a, const EvictionCandidate& b) {
+  return a.last_access_ < b.last_access_;
+}
+
+}  // namespace
+
+// LruEvictionPolicy Implementation
+void LruEvictionPolicy::Update(const std::vector<EvictionCandidate>& blobs,
+                               chi::u64 cache_bytes) {
+  (void)blobs;
+  (void)cache_bytes;
+}
+
+void LruEvictionPolicy::RankVictims(
+    std::vector<EvictionCandidate>& candidates) {
+  std::stable_sort(candidates.begin(), candidates.end(), OlderAccess);
+}
+
+// LfuEvictionPolicy Implementation
+void LfuEvictionPolicy::Update(const std::vector<EvictionCandidate>& blobs,
+                               chi::u64 cache_bytes) {
+  (void)cache_bytes;
+  std::unordered_map<BlobKey, double, BlobKeyHash> frequency;
+  for (const auto& blob : blobs) {
+    if (!blob.resident_) continue;
+    auto it = frequency_.find(blob.key_);
+    double previous = it == frequency_.end() ? 0.0 : it->second;
+    frequency[blob.key_] = previous * 0.5 + static_cast<double>(blob.reads_);
+  }
+  frequency_ = std::move(frequency);
+}
+
+void LfuEvictionPolicy::RankVictims(
+    std::vector<EvictionCandidate>& candidates) {
+  auto frequency_of = [this](const EvictionCandidate& candidate) {
+    auto it = frequency_.find(candidate.key_);
+    return it == frequency_.end() ? 0.0 : it->second;
+  };
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [&](const EvictionCandidate& a, const EvictionCandidate& b) {
+                     double fa = frequency_of(a);
+                     double fb = frequency_of(b);
+                     if (fa != fb) {
+                       return fa < fb;
+                     }
+                     return OlderAccess(a, b);
+                   });
+}
+
+// ArcEvictionPolicy Implementation
+void ArcEvictionPolicy::Update(const std::vector<EvictionCandidate>& blobs,
+                               chi::u64 cache_bytes) {
+  cache_bytes_ = cache_bytes;
+  chi::u64 pass = ++pass_;
+  for (const auto& blob : blobs) {
+    auto it = entries_.find(blob.key_);
+    if (it == entries_.end()) {
+      if (!blob.resident_) continue;
+      Entry entry;
+      entry.list_ = blob.reads_ > 0 ? List::kT2 : List::kT1;
+      entry.size_ = blob.size_;
+      entry.last_access_ = blob.last_access_;
+      entry.pass_ = pass;
+      entries_.emplace(blob.key_, entry);
+      continue;
+    }
+    Entry& entry = it->second;
+    entry.pass_ = pass;
+    entry.last_access_ = blob.last_access_;
+    if (blob.resident_) {
+      entry.size_ = blob.size_;
+    }
+    switch (entry.list_) {
+      case List::kT1:
+      case List::kT2:
+        // Left the fast tiers without this policy, e.g. by tier migration
+        if (!blob.resident_) {
+          entry.list_ = entry.list_ == List::kT1 ? List::kB1 : List::kB2;
+        } else if (blob.reads_ > 0) {
+          entry.list_ = List::kT2;
+        }
+        break;
+      case List::kB1:
+      case List::kB2: {
+        if (blob.reads_ == 0) break;
+        // Evicted too early: shift the T1/T2 split towards this ghost list
+        bool recent = entry.list_ == List::kB1;
+        double own = static_cast<double>(Bytes(entry.list_));
+        double other =
+            static_cast<double>(Bytes(recent ? List::kB2 : List::kB1));
+        double delta = std::max(1.0, own > 0 ? other / own : 1.0) *
+                       static_cast<double>(entry.size_);
+        p_ = recent ? p_ + delta : p_ - delta;
+        p_ = std::clamp(p_, 0.0, static_cast<double>(cache_bytes_));
+        if (blob.resident_) {
+          entry.list_ = List::kT2;
+        } else {
+          entries_.erase(it);
+        }
+        break;
+      }
+    }
+  }
+
+  // Forget blobs that no longer exist
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    it = it->second.pass_ == pass ? std::next(it) : entries_.erase(it);
+  }
+  TrimGhosts();
+}
+
+void ArcEvictionPolicy::RankVictims(
+    std::vector<EvictionCandidate>& candidates) {
+  std::vector<EvictionCandidate> recent, frequent;
+  for (auto& candidate : candidates) {
+    auto it = entries_.find(candidate.key_);
+    bool is_frequent = it != entries_.end() && it->second.list_ == List::kT2;
+    (is_frequent ? frequent : recent).push_back(std::move(candidate));
+  }
+  std::stable_sort(recent.begin(), recent.end(), OlderAccess);
+  std::stable_sort(frequent.begin(), frequent.end(), OlderAccess);
+
+  // REPLACE: take from T1 while it is over its target, else from T2
+  double t1_bytes = static_cast<double>(Bytes(List::kT1));
+  candidates.clear();
+  size_t r = 0, f = 0;
+  while (r < recent.size() || f < frequent.size()) {
+    bool take_recent =
+        r < recent.size() && (t1_bytes > p_ || f >= frequent.size());
+    EvictionCandidate& next = take_recent ? recent[r++] : frequent[f++];
+    if (take_recent) {
+      t1_bytes -= static_cast<double>(next.size_);
+    }
+    candidates.push_back(std::move(next));
+  }
+}
+
+void ArcEvictionPolicy::OnEvict(const BlobKey& key) {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) return;
+  Entry& entry = it->second;
+  if (entry.list_ != List::kT1 && entry.list_ != List::kT2) return;
+  List ghost = entry.list_ == List::kT1 ? List::kB1 : List::kB2;
+  Bytes(entry.list_) -= std::min(entry.size_, Bytes(entry.list_));
+  Bytes(ghost) += entry.size_;
+  entry.list_ = ghost;
+}
+
+void ArcEvictionPolicy::TrimGhosts() {
+  std::fill(std::begin(list_bytes_), std::end(list_bytes_), 0);
+  std::vector<std::pair<Timestamp, const BlobKey*>> ghosts;
+  for (const auto& [key, entry] : entries_) {
+    Bytes(entry.list_) += entry.size_;
+    if (entry.list_ == List::kB1 || entry.list_ == List::kB2) {
+      ghosts.emplace_back(entry.last_access_, &key);
+    }
+  }
+  chi::u64 ghost_bytes = Bytes(List::kB1) + Bytes(List::kB2);
+  if (ghost_bytes <= cache_bytes_) return;
+  std::sort(ghosts.begin(), ghosts.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+  std::vector<BlobKey> dropped;
+  for (const auto& ghost : ghosts) {
+    if (ghost_bytes <= cache_bytes_) break;
+    const Entry& entry = entries_.at(*ghost.second);
+    ghost_bytes -= entry.size_;
+    Bytes(entry.list_) -= entry.size_;
+    dropped.push_back(*ghost.second);
+  }
+  for (const auto& key : dropped) {
+    entries_.erase(key);
+  }
+}
+
+// EvictionPolicyFactory Implementation
+std::unique_ptr<EvictionPolicy> EvictionPolicyFactory::CreatePolicy(
+    EvictionPolicyType policy_type) {
+  switch (policy_type) {
+    case EvictionPolicyType::kLru:
+      return std::make_unique<LruEvictionPolicy>();
+    case EvictionPolicyType::kLfu:
+      return std::make_unique<LfuEvictionPolicy>();
+    case EvictionPolicyType::kArc:
+      return std::make_unique<ArcEvictionPolicy>();
+    default:
+      HLOG(kError, "Unknown eviction policy, defaulting to arc");
+      return std::make_unique<ArcEvictionPolicy>();
+  }
+}
+
+std::unique_ptr<EvictionPolicy> EvictionPolicyFactory::CreatePolicy(
+    const std::string& policy_str) {
+  return CreatePolicy(StringToEvictionPolicyType(policy_str));
+}
+
+} // namespace wrp_cte::core
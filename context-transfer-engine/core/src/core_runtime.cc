@@ -32,11 +32,14 @@
  */
 
 #include <chimaera/admin/admin_client.h>
+#include <fcntl.h>
+#include <hermes_shm/io/async_io_factory.h>
 #include <wrp_cte/core/core_config.h>
 #include <wrp_cte/core/core_dpe.h>
 #include <wrp_cte/core/core_runtime.h>
 
 #include <algorithm>
+#include <charconv>
 #include <chrono>
 #include <cmath>
 #include <cstdio>
@@ -45,16 +48,21 @@
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <regex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include "chimaera/blocking_pool.h"
 #include "chimaera/worker.h"
+#include "hermes_shm/introspect/system_info.h"
 #include "hermes_shm/util/logging.h"
 #include "hermes_shm/util/timer.h"
 
@@ -66,6 +74,11 @@ using chi::Worker;
 
 // No more static member definitions - using instance-based locking
 
+Runtime::~Runtime() {
+  auto *metrics = CHI_METRICS;
+  metrics->Unregister(MetricsKey());
+}
+
 chi::u64 Runtime::ParseCapacityToBytes(const std::string &capacity_str) {
   if (capacity_str.empty()) {
     return 0;
@@ -117,6 +130,16 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
   (void)ctx;
 #endif
   CHI_TASK_BODY_BEGIN
+  // A re-created container must not be scraped while it is rebuilt
+  auto *metrics = CHI_METRICS;
+  metrics->Unregister(MetricsKey());
+
+  // A shard of a per-NUMA pool keeps its metadata on its own socket: the
+  // bucket arrays below are faulted in under a preference for that node
+  if (numa_node_ >= 0) {
+    hshm::SystemInfo::SetThreadNumaPreference(numa_node_);
+  }
+
   // Initialize unordered_map_ll instances with appropriately sized bucket
   // counts Tag/blob maps are large to avoid excessive collisions at scale
   // Target maps use tag size since target counts are similar
@@ -127,28 +150,16 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
   tag_name_to_id_ =
       hshm::priv::unordered_map_ll<std::string, TagId>(kTagMapSize);
   tag_id_to_info_ = hshm::priv::unordered_map_ll<TagId, TagInfo>(kTagMapSize);
-  tag_blob_name_to_info_ =
-      hshm::priv::unordered_map_ll<std::string, BlobInfo>(kBlobMapSize);
-
-  // Initialize lock vectors for concurrent access
-  target_locks_.reserve(kMaxLocks);
-  tag_locks_.reserve(kMaxLocks);
-  for (size_t i = 0; i < kMaxLocks; ++i) {
-    target_locks_.emplace_back(std::make_unique<chi::CoRwLock>());
-    tag_locks_.emplace_back(std::make_unique<chi::CoRwLock>());
+  tag_blob_name_to_info_.Init(kBlobMapSize, kBlobMapShards);
+  if (numa_node_ >= 0) {
+    hshm::SystemInfo::SetThreadNumaPreference(-1);
   }
 
   // Get IPC manager for later use
   auto *ipc_manager = CHI_IPC;
 
-  // Initialize telemetry ring buffer using unique_ptr with HSHM_MALLOC
-  telemetry_log_ = std::make_unique<
-      hipc::circular_mpsc_ring_buffer<CteTelemetry, hipc::MallocAllocator>>(
-      HSHM_MALLOC, kTelemetryRingSize);
-
   // Initialize atomic counters
   next_tag_id_minor_ = 1;
-  telemetry_counter_ = 0;
 
   // Initialize WAL vectors (will be opened later if metadata_log_path is set)
   blob_txn_logs_.clear();
@@ -160,6 +171,11 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
        task->do_compose_);
   auto params = task->GetParams();
   config_ = params.config_;
+  // Shards of one node must not share metadata log files
+  if (numa_node_ >= 0 && !config_.performance_.metadata_log_path_.empty()) {
+    config_.performance_.metadata_log_path_ +=
+        ".shard" + std::to_string(container_id_);
+  }
   HLOG(kDebug,
        "CTE Create: GetParams() returned, storage devices in config: {}",
        config_.storage_.devices_.size());
@@ -171,6 +187,34 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
   storage_devices_ = config_.storage_.devices_;
   HLOG(kDebug, "CTE Create: Copied storage devices to runtime, count: {}",
        storage_devices_.size());
+  qos_.Configure(config_.qos_.classes_);
+
+  // One telemetry ring per worker, so logging never contends across cores
+  telemetry_log_.Init(CHI_WORK_ORCHESTRATOR->GetTotalWorkerCount(),
+                      config_.performance_.telemetry_capacity_,
+                      config_.performance_.telemetry_sample_rate_);
+
+  // One set of open packing segments per worker
+  if (config_.performance_.small_object_max_size_ > 0) {
+    pack_open_.resize(
+        std::max(CHI_WORK_ORCHESTRATOR->GetTotalWorkerCount(), (chi::u32)1));
+  }
+
+  // Tags can only be encrypted once the key is loaded
+  if (!config_.performance_.encryption_key_path_.empty()) {
+    LoadEncryptionKey();
+  }
+
+  // Clients validate cached tag metadata against this node's lease table.
+  // Containers of one runtime process share it.
+  leases_ = hshm::Singleton<MetadataLeaseTable>::GetInstance();
+  if (!leases_->Create(MetadataLeaseTable::SegmentName())) {
+    HLOG(kWarning, "CTE Create: Failed to create the metadata lease table");
+  }
+  blob_meta_ = hshm::Singleton<BlobMetaTable>::GetInstance();
+  if (!blob_meta_->Create(BlobMetaTable::SegmentName())) {
+    HLOG(kWarning, "CTE Create: Failed to create the blob metadata table");
+  }
 
   // Initialize the client with the pool ID
   client_.Init(task->new_pool_id_);
@@ -210,6 +254,10 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
         bdev_type = chimaera::bdev::BdevType::kPinned;
       } else if (device.bdev_type_ == "noop") {
         bdev_type = chimaera::bdev::BdevType::kNoop;
+      } else if (device.bdev_type_ == "nvme") {
+        bdev_type = chimaera::bdev::BdevType::kNvme;
+      } else if (device.bdev_type_ == "gds") {
+        bdev_type = chimaera::bdev::BdevType::kGds;
       }
 
       // Iterate over neighborhood nodes (container hashes from 0 to
@@ -237,13 +285,20 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
              client_.pool_id_, target_path, device.bdev_type_, capacity_bytes,
              container_hash, bdev_id.major_, bdev_id.minor_);
         auto reg_task = client_.AsyncRegisterTarget(
-            target_path, bdev_type, capacity_bytes, target_query, bdev_id);
+            target_path, bdev_type, capacity_bytes, target_query, bdev_id,
+            SelfQuery());
         CHI_CO_AWAIT(reg_task);
         chi::u32 result = reg_task->GetReturnCode();
 
         if (result == 0) {
           HLOG(kDebug, "  - Registered target: {} ({}, {} bytes) on node {}",
                target_path, device.bdev_type_, capacity_bytes, container_hash);
+          if (device.max_bandwidth_ > 0) {
+            // Allow a burst of about 100 ms at the configured rate
+            qos_.SetTargetRate(
+                bdev_id, device.max_bandwidth_,
+                std::max<chi::u64>(device.max_bandwidth_ / 10, 1ULL << 20));
+          }
         } else {
           HLOG(kWarning,
                "  - Failed to register target {} on node {} (error code: {})",
@@ -255,6 +310,28 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
     HLOG(kWarning, "Warning: No storage devices configured");
   }
 
+  // The read cache gets a RAM bdev of its own rather than a target, so
+  // placement never puts a blob in it
+  chi::u64 read_cache_size = config_.performance_.read_cache_size_;
+  if (read_cache_size > 0) {
+    chimaera::bdev::Client cache_client;
+    std::string cache_name =
+        "ram::cte_read_cache_" + std::to_string(container_id_);
+    auto cache_create = cache_client.AsyncCreate(
+        chi::PoolQuery::Local(), cache_name, chi::PoolId(511, 1 + container_id_),
+        chimaera::bdev::BdevType::kRam, read_cache_size);
+    CHI_CO_AWAIT(cache_create);
+    if (cache_create->GetReturnCode() == 0) {
+      read_cache_id_ = cache_create->new_pool_id_;
+      read_cache_ = std::make_unique<ReadCache>(read_cache_size);
+      HLOG(kDebug, "Read cache: {} bytes in bdev ({},{})", read_cache_size,
+           read_cache_id_.major_, read_cache_id_.minor_);
+    } else {
+      HLOG(kWarning, "Failed to create the {} byte read cache (error code: {})",
+           read_cache_size, cache_create->GetReturnCode());
+    }
+  }
+
   // Queue management has been removed - queues are now managed by Chimaera
   // runtime Local queues (kTargetManagementQueue, kTagManagementQueue,
   // kBlobOperationsQueue, kStatsQueue) are no longer created explicitly
@@ -273,29 +350,57 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
   if (is_restart_) {
     RestoreMetadataFromLog();
     ReplayTransactionLogs();
+    RebuildBlockRefs();
+    RebuildPackSegments();
   }
 
+  migration_dirty_.Init();
+
   // Open WAL files if metadata_log_path is configured
   if (!config_.performance_.metadata_log_path_.empty()) {
+    dirty_metadata_.Init();
+    // What the restart replayed past an attached base image goes into the
+    // first delta, so that image stays the base and is never reloaded
+    if (base_image_) {
+      for (const auto &key : replayed_blob_keys_) {
+        dirty_metadata_.MarkBlob(key);
+      }
+      for (const auto &tag_id : replayed_tag_ids_) {
+        dirty_metadata_.MarkTag(tag_id);
+      }
+      checkpoint_base_written_ = true;
+    }
+    replayed_blob_keys_.clear();
+    replayed_tag_ids_.clear();
     chi::u32 num_workers =
         std::max(CHI_WORK_ORCHESTRATOR->GetTotalWorkerCount(), (chi::u32)1);
     chi::u64 per_worker_capacity = std::max(
         config_.performance_.transaction_log_capacity_bytes_ / num_workers,
         (chi::u64)4096);
+    chi::u64 segment_bytes = std::min(
+        config_.performance_.transaction_log_segment_bytes_,
+        per_worker_capacity);
     blob_txn_logs_.resize(num_workers);
     tag_txn_logs_.resize(num_workers);
     for (chi::u32 i = 0; i < num_workers; ++i) {
       blob_txn_logs_[i] = std::make_unique<TransactionLog>();
       blob_txn_logs_[i]->Open(config_.performance_.metadata_log_path_ +
                                   ".blob." + std::to_string(i),
-                              per_worker_capacity);
+                              per_worker_capacity, segment_bytes);
       tag_txn_logs_[i] = std::make_unique<TransactionLog>();
       tag_txn_logs_[i]->Open(
           config_.performance_.metadata_log_path_ + ".tag." + std::to_string(i),
-          per_worker_capacity);
+          per_worker_capacity, segment_bytes);
     }
     HLOG(kInfo, "WAL: Opened {} blob and {} tag transaction logs", num_workers,
          num_workers);
+
+    // Group-commit buffered records once per commit window
+    if (config_.performance_.transaction_log_commit_ms_ > 0) {
+      client_.AsyncCommitTransactionLogs(
+          SelfQuery(),
+          config_.performance_.transaction_log_commit_ms_ * 1000.0);
+    }
   }
 
   // Start periodic StatTargets task to keep target stats updated
@@ -303,7 +408,7 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
   if (stat_period_ms > 0) {
     HLOG(kInfo, "Starting periodic StatTargets task with period {} ms",
          stat_period_ms);
-    client_.AsyncStatTargets(chi::PoolQuery::Local(), stat_period_ms);
+    client_.AsyncStatTargets(SelfQuery(), stat_period_ms);
   }
 
   // Spawn periodic FlushMetadata if metadata_log_path is configured and period
@@ -311,16 +416,79 @@ chi::TaskResume Runtime::Create(hipc::FullPtr<CreateTask> task,
   if (!config_.performance_.metadata_log_path_.empty() &&
       config_.performance_.flush_metadata_period_ms_ > 0) {
     client_.AsyncFlushMetadata(
-        chi::PoolQuery::Local(),
+        SelfQuery(),
         config_.performance_.flush_metadata_period_ms_ * 1000.0);
   }
 
   // Spawn periodic FlushData if configured
   if (config_.performance_.flush_data_period_ms_ > 0) {
-    client_.AsyncFlushData(chi::PoolQuery::Local(),
+    client_.AsyncFlushData(SelfQuery(),
                            config_.performance_.flush_data_min_persistence_,
-                           config_.performance_.flush_data_period_ms_ * 1000.0);
+                           config_.performance_.flush_data_period_ms_ * 1000.0,
+                           config_.performance_.flush_data_max_inflight_);
+  }
+
+  // Spawn periodic RepairReplicas if configured
+  if (config_.performance_.replica_repair_period_ms_ > 0) {
+    client_.AsyncRepairReplicas(
+        SelfQuery(), false,
+        config_.performance_.replica_repair_period_ms_ * 1000.0);
+  }
+
+  // Start on an equal-weight ring when consistent hashing is configured
+  if (config_.performance_.placement_vnodes_ > 0) {
+    auto *pool_manager = CHI_POOL_MANAGER;
+    const chi::PoolInfo *pool_info = pool_manager->GetPoolInfo(pool_id_);
+    if (pool_info != nullptr && pool_info->num_containers_ > 0) {
+      placement_ring_ = std::make_shared<const HashRing>(
+          std::vector<chi::u32>(pool_info->num_containers_, 1),
+          config_.performance_.placement_vnodes_);
+    }
+  }
+
+  // Spawn periodic RebalanceBlobs if configured
+  if (config_.performance_.rebalance_period_ms_ > 0) {
+    client_.AsyncRebalanceBlobs(
+        SelfQuery(), 256,
+        config_.performance_.rebalance_period_ms_ * 1000.0);
+  }
+
+  // Spawn periodic DefragBlobs if configured
+  if (config_.performance_.defrag_period_ms_ > 0) {
+    client_.AsyncDefragBlobs(SelfQuery(),
+                             config_.performance_.defrag_min_blocks_,
+                             config_.performance_.defrag_period_ms_ * 1000.0);
+  }
+
+  // Spawn periodic heat-driven tier migration if configured
+  if (config_.performance_.migrate_period_ms_ > 0) {
+    client_.AsyncMigrateBlobs(
+        SelfQuery(), config_.performance_.migrate_bandwidth_mbps_,
+        config_.performance_.migrate_half_life_ms_,
+        config_.performance_.migrate_promote_heat_,
+        config_.performance_.migrate_demote_heat_,
+        config_.performance_.migrate_period_ms_ * 1000.0);
+  }
+
+  // Spawn periodic capacity-pressure eviction if configured
+  evict_policy_ =
+      EvictionPolicyFactory::CreatePolicy(config_.performance_.evict_policy_);
+  if (config_.performance_.evict_period_ms_ > 0) {
+    client_.AsyncEvictTargets(SelfQuery(),
+                              config_.performance_.evict_high_watermark_,
+                              config_.performance_.evict_low_watermark_,
+                              config_.performance_.evict_period_ms_ * 1000.0);
+  }
+
+  // Spawn periodic TTL expiry if configured
+  if (config_.performance_.expire_period_ms_ > 0) {
+    client_.AsyncExpireBlobs(SelfQuery(),
+                             config_.performance_.expire_period_ms_ * 1000.0);
   }
+
+  // Export target and WAL counters on the runtime's /metrics endpoint
+  metrics->Register(MetricsKey(),
+                    [this](chi::MetricsWriter &w) { CollectMetrics(w); });
   CHI_CO_RETURN;
   CHI_TASK_BODY_END
 }
@@ -334,6 +502,25 @@ chi::TaskResume Runtime::Destroy(hipc::FullPtr<DestroyTask> task,
 #endif
   CHI_TASK_BODY_BEGIN
   try {
+    // Stop the metrics thread from reading the logs and targets
+    auto *metrics = CHI_METRICS;
+    metrics->Unregister(MetricsKey());
+
+    // Write out the packing segments while their targets are known
+    CHI_CO_AWAIT(FlushPackSegments());
+    {
+      auto *ipc_manager = CHI_IPC;
+      hshm::ScopedMutex guard(pack_lock_, 0);
+      pack_segments_.ForEach([ipc_manager](chi::u64, PackSegment &seg) {
+        if (!seg.buffer_.IsNull()) {
+          ipc_manager->FreeBuffer(seg.buffer_);
+          seg.buffer_ = hipc::FullPtr<char>();
+        }
+      });
+      pack_segments_ = PackSegmentTable();
+      pack_open_.clear();
+    }
+
     // Close WAL files before clearing data structures
     for (auto &log : blob_txn_logs_) {
       if (log) log->Close();
@@ -351,7 +538,10 @@ chi::TaskResume Runtime::Destroy(hipc::FullPtr<DestroyTask> task,
     // Clear tag and blob management structures
     tag_name_to_id_.clear();
     tag_id_to_info_.clear();
-    tag_blob_name_to_info_.clear();
+    tag_blob_name_to_info_.Clear();
+    if (blob_meta_) {
+      blob_meta_->InvalidateAll();
+    }
 
     // Reset atomic counters
     next_tag_id_minor_.store(1);
@@ -359,10 +549,6 @@ chi::TaskResume Runtime::Destroy(hipc::FullPtr<DestroyTask> task,
     // Clear storage device configuration
     storage_devices_.clear();
 
-    // Clear lock vectors
-    target_locks_.clear();
-    tag_locks_.clear();
-
     // Set success status
     task->return_code_ = 0;
 
@@ -382,18 +568,29 @@ chi::PoolQuery Runtime::ScheduleTask(const hipc::FullPtr<chi::Task> &task) {
     case Method::kListTargets:
     case Method::kStatTargets:
     case Method::kGetTargetInfo:
+    case Method::kGetOrCreateTags:
       return chi::PoolQuery::Local();
 
     // GetOrCreateTag: check local tag cache, hash to container if not found
     case Method::kGetOrCreateTag: {
       auto typed = task.template Cast<GetOrCreateTagTask<CreateParams>>();
       std::string tag_name = typed->tag_name_.str();
-      bool tag_exists = false;
+      TagPlacement &placement = typed->placement_;
+      if (placement.policy_ == TagPlacementPolicy::kPinCreator &&
+          placement.pin_container_ == TagPlacement::kNoContainer) {
+        placement.pin_container_ = container_id_;  // The creator's node
+      }
+      TagId *tag_id_ptr = nullptr;
+      TagId tag_id;
       {
         chi::ScopedCoRwReadLock lock(tag_map_lock_);
-        tag_exists = (tag_name_to_id_.find(tag_name) != nullptr);
+        tag_id_ptr = tag_name_to_id_.find(tag_name);
+        if (tag_id_ptr != nullptr) tag_id = *tag_id_ptr;
       }
-      if (tag_exists) {
+      // A placement request for a tag without one goes to the canonical
+      // container, which broadcasts it
+      if (tag_id_ptr != nullptr &&
+          (placement.IsDefault() || !GetTagPlacement(tag_id).IsDefault())) {
         return chi::PoolQuery::Local();
       }
       std::hash<std::string> string_hasher;
@@ -404,11 +601,22 @@ chi::PoolQuery Runtime::ScheduleTask(const hipc::FullPtr<chi::Task> &task) {
     // Blob operations: hash blob name to container
     case Method::kPutBlob: {
       auto typed = task.template Cast<PutBlobTask>();
+      if (typed->qos_class_ == 0) {
+        typed->qos_class_ = qos_.GetTagClass(typed->tag_id_);
+      }
       return HashBlobToContainer(typed->tag_id_, typed->blob_name_.str());
     }
     case Method::kGetBlob: {
       auto typed = task.template Cast<GetBlobTask>();
-      return HashBlobToContainer(typed->tag_id_, typed->blob_name_.str());
+      if (typed->qos_class_ == 0) {
+        typed->qos_class_ = qos_.GetTagClass(typed->tag_id_);
+      }
+      return ScheduleReplicaRead(typed->tag_id_, typed->blob_name_.str());
+    }
+    case Method::kAppendBlob: {
+      // One container owns each tag's append cursor
+      auto typed = task.template Cast<AppendBlobTask>();
+      return HashBlobToContainer(typed->tag_id_, "");
     }
     case Method::kReorganizeBlob: {
       auto typed = task.template Cast<ReorganizeBlobTask>();
@@ -418,6 +626,22 @@ chi::PoolQuery Runtime::ScheduleTask(const hipc::FullPtr<chi::Task> &task) {
       auto typed = task.template Cast<DelBlobTask>();
       return HashBlobToContainer(typed->tag_id_, typed->blob_name_.str());
     }
+    case Method::kRegisterBlobStub: {
+      auto typed = task.template Cast<RegisterBlobStubTask>();
+      return HashBlobToContainer(typed->tag_id_, typed->blob_name_.str());
+    }
+    case Method::kReserveBlob: {
+      auto typed = task.template Cast<ReserveBlobTask>();
+      return HashBlobToContainer(typed->tag_id_, typed->blob_name_.str());
+    }
+    case Method::kGetBlobView: {
+      auto typed = task.template Cast<GetBlobViewTask>();
+      return HashBlobToContainer(typed->tag_id_, typed->blob_name_.str());
+    }
+    case Method::kReleaseBlobView: {
+      auto typed = task.template Cast<ReleaseBlobViewTask>();
+      return HashBlobToContainer(typed->tag_id_, typed->blob_name_.str());
+    }
     case Method::kGetBlobScore: {
       auto typed = task.template Cast<GetBlobScoreTask>();
       return HashBlobToContainer(typed->tag_id_, typed->blob_name_.str());
@@ -514,6 +738,7 @@ chi::TaskResume Runtime::RegisterTarget(hipc::FullPtr<RegisterTargetTask> task,
     CHI_CO_AWAIT(stats_task);
     chimaera::bdev::PerfMetrics perf_metrics = stats_task->metrics_;
     remaining_size = stats_task->remaining_size_;
+    chi::u64 inflight_bytes = stats_task->inflight_bytes_;
 
     // Create target info with bdev client and performance stats
     TargetInfo target_info(target_name, bdev_pool_name);
@@ -544,9 +769,15 @@ chi::TaskResume Runtime::RegisterTarget(hipc::FullPtr<RegisterTargetTask> task,
     }
     target_info.remaining_space_ =
         total_size;  // Use actual remaining space from bdev
+    target_info.capacity_ = total_size;
     target_info.perf_metrics_ =
         perf_metrics;  // Store the entire PerfMetrics structure
+    target_info.perf_model_ = stats_task->model_;
+    target_info.inflight_bytes_ = inflight_bytes;
     target_info.persistence_level_ = GetPersistenceLevelForTarget(target_name);
+    target_info.bdev_type_ = bdev_type;
+    target_info.client_mappable_ = stats_task->shared_buffer_;
+    target_info.numa_node_ = GetNumaNodeForTarget(target_name);
 
     // Register the target using TargetId as key
     {
@@ -556,6 +787,17 @@ chi::TaskResume Runtime::RegisterTarget(hipc::FullPtr<RegisterTargetTask> task,
           target_name,
           target_id);  // Maintain reverse lookup
     }
+    TargetMetricSlot *metric_slot = ClaimTargetMetrics(target_id, target_name);
+    if (metric_slot) {
+      metric_slot->capacity_.store(total_size, std::memory_order_relaxed);
+      metric_slot->remaining_space_.store(total_size,
+                                          std::memory_order_relaxed);
+      metric_slot->read_bw_mbps_.store(perf_metrics.read_bandwidth_mbps_,
+                                       std::memory_order_relaxed);
+      metric_slot->write_bw_mbps_.store(perf_metrics.write_bandwidth_mbps_,
+                                        std::memory_order_relaxed);
+      metric_slot->live_.store(true, std::memory_order_relaxed);
+    }
 
     task->return_code_ = 0;  // Success
     HLOG(kDebug,
@@ -608,9 +850,15 @@ chi::TaskResume Runtime::UnregisterTarget(
         CHI_CO_RETURN;
       }
 
+      TargetMetricSlot *metric_slot = FindTargetMetrics(target_id);
+      if (metric_slot) {
+        metric_slot->live_.store(false, std::memory_order_relaxed);
+      }
       registered_targets_.erase(target_id);
       target_name_to_id_.erase(target_name);  // Remove reverse lookup
     }
+    // Erasure-code shards on the target are rebuilt by the repair pass
+    erasure_rescan_.store(true);
 
     task->return_code_ = 0;  // Success
     HLOG(kDebug, "Target '{}' unregistered", target_name);
@@ -693,7 +941,9 @@ chi::TaskResume Runtime::StatTargets(hipc::FullPtr<StatTargetsTask> task,
       auto stats_task = bdev_client_copy.AsyncGetStats();
       CHI_CO_AWAIT(stats_task);
       chimaera::bdev::PerfMetrics perf_metrics = stats_task->metrics_;
+      chimaera::bdev::PerfModel perf_model = stats_task->model_;
       remaining_size = stats_task->remaining_size_;
+      chi::u64 inflight_bytes = stats_task->inflight_bytes_;
 
       // Re-acquire write lock to update target info
       {
@@ -701,7 +951,19 @@ chi::TaskResume Runtime::StatTargets(hipc::FullPtr<StatTargetsTask> task,
         TargetInfo *target_info = registered_targets_.find(target_id);
         if (target_info != nullptr) {
           target_info->perf_metrics_ = perf_metrics;
+          target_info->perf_model_ = perf_model;
           target_info->remaining_space_ = remaining_size;
+          TargetMetricSlot *metric_slot = FindTargetMetrics(target_id);
+          if (metric_slot) {
+            metric_slot->remaining_space_.store(remaining_size,
+                                                std::memory_order_relaxed);
+            metric_slot->read_bw_mbps_.store(perf_metrics.read_bandwidth_mbps_,
+                                             std::memory_order_relaxed);
+            metric_slot->write_bw_mbps_.store(
+                perf_metrics.write_bandwidth_mbps_, std::memory_order_relaxed);
+          }
+          // Replaces the bytes ExtendBlob projected since the last stat
+          target_info->inflight_bytes_ = inflight_bytes;
 
           float manual_score =
               GetManualScoreForTarget(target_info->target_name_.str());
@@ -724,6 +986,12 @@ chi::TaskResume Runtime::StatTargets(hipc::FullPtr<StatTargetsTask> task,
       }
     }
 
+    // Views whose client never released them
+    CHI_CO_AWAIT(ExpireBlobViewLeases());
+
+    // Objects appended to packing segments since the last period
+    CHI_CO_AWAIT(FlushPackSegments());
+
     task->return_code_ = 0;  // Success
 
   } catch (const std::exception &e) {
@@ -759,6 +1027,7 @@ chi::TaskResume Runtime::GetOrCreateTag(
       if (existing_tag_id_ptr == nullptr) {
         tag_name_to_id_.insert_or_assign(tag_name, preferred_id);
       }
+      qos_.AssignTag(preferred_id, tag_name);
       task->tag_id_ = preferred_id;
       task->return_code_ = 0;
       CHI_CO_RETURN;
@@ -766,6 +1035,25 @@ chi::TaskResume Runtime::GetOrCreateTag(
 
     TagId tag_id = GetOrAssignTagId(tag_name, preferred_id);
     task->tag_id_ = tag_id;
+    qos_.AssignTag(tag_id, tag_name);
+
+    // The first placement requested for a tag applies to all its blobs
+    if (!task->placement_.IsDefault() && GetTagPlacement(tag_id).IsDefault()) {
+      TagPlacement placement = task->placement_;
+      if (placement.policy_ == TagPlacementPolicy::kFollowTag) {
+        // Following a pinned or following tag means placing as it does
+        TagPlacement followed = GetTagPlacement(placement.follow_tag_);
+        if (followed.policy_ == TagPlacementPolicy::kPinCreator ||
+            followed.policy_ == TagPlacementPolicy::kFollowTag) {
+          placement = followed;
+        }
+      }
+      if (placement.pin_container_ == TagPlacement::kNoContainer) {
+        placement.pin_container_ = container_id_;
+      }
+      auto placement_task = client_.AsyncSetTagPlacement(tag_id, placement);
+      CHI_CO_AWAIT(placement_task);
+    }
 
     auto now = GetCurrentTimeNs();
     {
@@ -787,6 +1075,49 @@ chi::TaskResume Runtime::GetOrCreateTag(
   CHI_TASK_BODY_END
 }
 
+chi::TaskResume Runtime::GetOrCreateTags(
+    hipc::FullPtr<GetOrCreateTagsTask> task, chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  try {
+    // Each name goes where a single GetOrCreateTag would route it; the
+    // client pays one round trip for the whole list
+    const std::vector<std::string> &tag_names = task->tag_names_;
+    task->tag_ids_.assign(tag_names.size(), TagId::GetNull());
+    std::vector<chi::Future<GetOrCreateTagTask<CreateParams>>> tag_tasks;
+    bool failed = false;
+    for (size_t begin = 0; begin < tag_names.size();
+         begin += kTagBatchInflight) {
+      size_t end = std::min(begin + kTagBatchInflight, tag_names.size());
+      tag_tasks.clear();
+      for (size_t i = begin; i < end; ++i) {
+        tag_tasks.push_back(client_.AsyncGetOrCreateTag(
+            tag_names[i], TagId::GetNull(), chi::PoolQuery::Dynamic(),
+            task->placement_));
+      }
+      for (size_t i = 0; i < tag_tasks.size(); ++i) {
+        auto &tag_task = tag_tasks[i];
+        CHI_CO_AWAIT(tag_task);
+        if (tag_task->GetReturnCode() == 0) {
+          task->tag_ids_[begin + i] = tag_task->tag_id_;
+        } else {
+          failed = true;
+        }
+      }
+    }
+    task->return_code_ = failed ? 2 : 0;
+  } catch (const std::exception &e) {
+    HLOG(kError, "GetOrCreateTags: Exception: {}", e.what());
+    task->return_code_ = 1;
+  }
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
 chi::TaskResume Runtime::GetTargetInfo(hipc::FullPtr<GetTargetInfoTask> task,
                                        chi::RunContext &ctx) {
 #ifdef __NVCOMPILER
@@ -818,10 +1149,23 @@ chi::TaskResume Runtime::GetTargetInfo(hipc::FullPtr<GetTargetInfoTask> task,
     // Copy target information to task output
     task->target_score_ = target_ptr->target_score_;
     task->remaining_space_ = target_ptr->remaining_space_;
-    task->bytes_read_ = target_ptr->bytes_read_;
-    task->bytes_written_ = target_ptr->bytes_written_;
-    task->ops_read_ = target_ptr->ops_read_;
-    task->ops_written_ = target_ptr->ops_written_;
+    task->perf_model_ = target_ptr->perf_model_;
+    // I/O totals are kept in the target's metric slot
+    TargetMetricSlot *metric_slot = FindTargetMetrics(target_id);
+    if (metric_slot) {
+      task->bytes_read_ =
+          metric_slot->bytes_read_.load(std::memory_order_relaxed);
+      task->bytes_written_ =
+          metric_slot->bytes_written_.load(std::memory_order_relaxed);
+      task->ops_read_ = metric_slot->ops_read_.load(std::memory_order_relaxed);
+      task->ops_written_ =
+          metric_slot->ops_written_.load(std::memory_order_relaxed);
+    } else {
+      task->bytes_read_ = target_ptr->bytes_read_;
+      task->bytes_written_ = target_ptr->bytes_written_;
+      task->ops_read_ = target_ptr->ops_read_;
+      task->ops_written_ = target_ptr->ops_written_;
+    }
 
     task->return_code_ = 0;  // Success
 
@@ -865,6 +1209,43 @@ chi::TaskResume Runtime::PutBlob(hipc::FullPtr<PutBlobTask> task,
     // Check if blob exists and resolve score
     BlobInfo *blob_info_ptr = CheckBlobExists(blob_name, tag_id);
     bool blob_found = (blob_info_ptr != nullptr);
+    if (blob_found && (task->flags_ & kPutBlobIfAbsent)) {
+      task->return_code_ = 0;
+      CHI_CO_RETURN;
+    }
+    if (blob_found) {
+      CHI_CO_AWAIT(InvalidateReadCache(tag_id, blob_name));
+    }
+    // A partial write onto blocks shared with a spliced or deduplicated
+    // blob, or onto a packed one, copies the blob to private blocks first;
+    // a write at offset 0 replaces them. Extents written in place stop
+    // matching their fingerprints. An erasure-coded blob is re-encoded into
+    // new blocks by any write, so it needs no copy.
+    if (blob_found && offset != 0) {
+      DropBlobFingerprints(*blob_info_ptr);
+    }
+    if (blob_found && offset != 0 && !blob_info_ptr->IsErasureCoded() &&
+        (HasPackedBlocks(*blob_info_ptr) || IsBlobShared(*blob_info_ptr))) {
+      chi::u64 bytes_copied = 0;
+      CHI_CO_AWAIT(RelocateBlob(
+          tag_id, blob_name, blob_info_ptr->score_,
+          task->context_.min_persistence_level_,
+          [](const BlobInfo &, const BlobInfo &) { return true; },
+          bytes_copied));
+      blob_info_ptr = CheckBlobExists(blob_name, tag_id);
+      blob_found = (blob_info_ptr != nullptr);
+      if (blob_found && IsBlobShared(*blob_info_ptr)) {
+        task->return_code_ = 6;
+        CHI_CO_RETURN;
+      }
+    }
+    chi::ContainerId previous_owner;
+    if (!blob_found && offset != 0 &&
+        GetPreviousOwner(tag_id, blob_name, previous_owner)) {
+      CHI_CO_AWAIT(PullFromPreviousOwner(tag_id, blob_name, previous_owner));
+      blob_info_ptr = CheckBlobExists(blob_name, tag_id);
+      blob_found = (blob_info_ptr != nullptr);
+    }
     if (blob_score < 0.0f) {
       blob_score = blob_found ? blob_info_ptr->score_ : 1.0f;
     }
@@ -873,11 +1254,44 @@ chi::TaskResume Runtime::PutBlob(hipc::FullPtr<PutBlobTask> task,
       CHI_CO_RETURN;
     }
 
-    // Step 1: ClearBlob — free blocks if full replacement
+    // A partial write onto a stub faults the source bytes in first; a write
+    // at offset 0 replaces the blob, so the source is simply dropped
     chi::u64 old_blob_size = 0;
+    if (blob_found && blob_info_ptr->IsStub()) {
+      if (offset != 0) {
+        chi::u32 load_result = 0;
+        CHI_CO_AWAIT(MaterializeStub(tag_id, blob_name, *blob_info_ptr,
+                                     load_result));
+        if (load_result != 0) {
+          task->return_code_ = 30 + load_result;
+          CHI_CO_RETURN;
+        }
+      } else {
+        old_blob_size = blob_info_ptr->stub_size_;
+        ClearBlobStub(*blob_info_ptr);
+      }
+    }
+
+    // Same-size rewrites and updates inside the blob skip steps 1-2 and the
+    // WAL record: the block list does not change
+    bool in_place =
+        blob_found &&
+        CanWriteInPlace(tag_id, *blob_info_ptr, offset, size, blob_score,
+                        task->context_.min_persistence_level_);
+    if (in_place) {
+      if (offset == 0) {
+        DropBlobFingerprints(*blob_info_ptr);
+      }
+      put_in_place_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Step 1: ClearBlob — free blocks if full replacement
     if (blob_found) {
       bool cleared = false;
-      CHI_CO_AWAIT(ClearBlob(*blob_info_ptr, blob_score, offset, size, cleared));
+      if (!in_place) {
+        CHI_CO_AWAIT(
+            ClearBlob(*blob_info_ptr, blob_score, offset, size, cleared));
+      }
       if (cleared) {
         // WAL: log blob clear
         if (!blob_txn_logs_.empty()) {
@@ -890,7 +1304,7 @@ chi::TaskResume Runtime::PutBlob(hipc::FullPtr<PutBlobTask> task,
                                                            txn);
         }
       } else {
-        old_blob_size = blob_info_ptr->GetTotalSize();
+        old_blob_size += blob_info_ptr->GetLogicalSize();
       }
     }
 
@@ -903,42 +1317,100 @@ chi::TaskResume Runtime::PutBlob(hipc::FullPtr<PutBlobTask> task,
       }
     }
 
-    // Step 2: ExtendBlob — allocate new blocks if needed
-    chi::u32 alloc_result = 0;
-    CHI_CO_AWAIT(ExtendBlob(*blob_info_ptr, offset, size, blob_score, alloc_result,
-                        task->context_.min_persistence_level_));
-    if (alloc_result != 0) {
-      task->return_code_ = 10 + alloc_result;
-      CHI_CO_RETURN;
+    // Encryption takes precedence over erasure coding, which takes
+    // precedence over dedup. A partial write keeps the blob's own chunking
+    // or code, even if the tag no longer sets one.
+    chi::u32 encrypt_chunk = GetTagEncryptChunk(tag_id);
+    if (offset != 0 && blob_info_ptr->IsEncrypted()) {
+      encrypt_chunk = blob_info_ptr->encrypt_chunk_;
     }
-
-    // WAL: log all current blocks (full replacement semantics)
-    if (!blob_txn_logs_.empty() && !blob_info_ptr->blocks_.empty()) {
-      chi::u32 wid = CHI_CUR_WORKER->GetWorkerStats().worker_id_;
-      TxnExtendBlob txn;
-      txn.tag_major_ = tag_id.major_;
-      txn.tag_minor_ = tag_id.minor_;
-      txn.blob_name_ = blob_name;
-      for (const auto &blk : blob_info_ptr->blocks_) {
-        TxnExtendBlobBlock tb;
-        tb.bdev_major_ = blk.bdev_client_.pool_id_.major_;
-        tb.bdev_minor_ = blk.bdev_client_.pool_id_.minor_;
-        tb.target_query_ = blk.target_query_;
-        tb.target_offset_ = blk.target_offset_;
-        tb.size_ = blk.size_;
-        txn.new_blocks_.push_back(tb);
-      }
-      blob_txn_logs_[wid % blob_txn_logs_.size()]->Log(TxnType::kExtendBlob,
-                                                       txn);
+    chi::u32 erasure_data = 0;
+    chi::u32 erasure_parity = 0;
+    if (encrypt_chunk == 0) {
+      GetTagErasure(tag_id, erasure_data, erasure_parity);
+    }
+    if (encrypt_chunk == 0 && erasure_data == 0 && offset != 0 &&
+        blob_info_ptr->IsErasureCoded()) {
+      erasure_data = blob_info_ptr->erasure_data_;
+      erasure_parity = blob_info_ptr->erasure_parity_;
+    }
+    chi::u64 dedup_chunk = (encrypt_chunk == 0 && erasure_data == 0 &&
+                            offset == 0 && blob_info_ptr->blocks_.empty())
+                               ? GetTagDedupChunk(tag_id)
+                               : 0;
+    // A small blob written whole is appended to a packing segment
+    bool packed = false;
+    if (encrypt_chunk == 0 && erasure_data == 0 && dedup_chunk == 0 &&
+        !in_place && offset == 0 && blob_info_ptr->blocks_.empty() &&
+        size <= GetConfig().performance_.small_object_max_size_) {
+      CHI_CO_AWAIT(PackWriteBlob(*blob_info_ptr, blob_data, size, blob_score,
+                                 task->context_.min_persistence_level_,
+                                 packed));
     }
+    if (packed) {
+      // Steps 2-3 for a packed blob: the segment already wrote the bytes
+      LogBlobBlocks(tag_id, blob_name, *blob_info_ptr);
+    } else if (encrypt_chunk != 0) {
+      // Steps 2-3 for an encrypted tag: seal the chunks the write touches
+      chi::u32 encrypt_result = 0;
+      CHI_CO_AWAIT(EncryptWriteBlob(*blob_info_ptr, blob_data, offset, size,
+                                    encrypt_chunk, blob_score,
+                                    task->context_.min_persistence_level_,
+                                    task->qos_class_, encrypt_result));
+      if (encrypt_result != 0) {
+        task->return_code_ = encrypt_result;
+        CHI_CO_RETURN;
+      }
+      LogBlobBlocks(tag_id, blob_name, *blob_info_ptr);
+    } else if (erasure_data != 0) {
+      // Steps 2-3 for an erasure-coded tag: encode the blob into shards
+      chi::u32 erasure_result = 0;
+      CHI_CO_AWAIT(ErasureWriteBlob(*blob_info_ptr, blob_data, offset, size,
+                                    erasure_data, erasure_parity, blob_score,
+                                    task->context_.min_persistence_level_,
+                                    task->qos_class_, erasure_result));
+      if (erasure_result != 0) {
+        task->return_code_ = erasure_result;
+        CHI_CO_RETURN;
+      }
+      LogBlobBlocks(tag_id, blob_name, *blob_info_ptr);
+    } else if (dedup_chunk != 0) {
+      // Steps 2-3 for a dedup tag: store the chunks not already held
+      chi::u32 dedup_result = 0;
+      CHI_CO_AWAIT(DedupWriteBlob(*blob_info_ptr, blob_data, size, dedup_chunk,
+                                  blob_score,
+                                  task->context_.min_persistence_level_,
+                                  task->qos_class_, dedup_result));
+      if (dedup_result != 0) {
+        task->return_code_ = dedup_result;
+        CHI_CO_RETURN;
+      }
+      LogBlobBlocks(tag_id, blob_name, *blob_info_ptr);
+    } else if (!in_place) {
+      // Step 2: ExtendBlob — allocate new blocks if needed
+      chi::u32 alloc_result = 0;
+      CHI_CO_AWAIT(ExtendBlob(*blob_info_ptr, offset, size, blob_score,
+                              alloc_result,
+                              task->context_.min_persistence_level_));
+      if (alloc_result != 0) {
+        task->return_code_ = 10 + alloc_result;
+        CHI_CO_RETURN;
+      }
 
-    // Step 3: ModifyExistingData — write data to blocks
-    chi::u32 write_result = 0;
-    CHI_CO_AWAIT(ModifyExistingData(blob_info_ptr->blocks_, blob_data, size, offset,
-                                write_result));
-    if (write_result != 0) {
-      task->return_code_ = 20 + write_result;
-      CHI_CO_RETURN;
+      // WAL: log all current blocks (full replacement semantics)
+      LogBlobBlocks(tag_id, blob_name, *blob_info_ptr);
+    }
+    if (encrypt_chunk == 0 && erasure_data == 0 && dedup_chunk == 0 &&
+        !packed) {
+      // Step 3: ModifyExistingData — write data to blocks
+      chi::u32 write_result = 0;
+      CHI_CO_AWAIT(ModifyExistingData(blob_info_ptr->blocks_, blob_data, size,
+                                      offset, write_result,
+                                      task->qos_class_));
+      if (write_result != 0) {
+        task->return_code_ = 20 + write_result;
+        CHI_CO_RETURN;
+      }
     }
 
 #if HSHM_ENABLE_COMPRESS
@@ -950,13 +1422,22 @@ chi::TaskResume Runtime::PutBlob(hipc::FullPtr<PutBlobTask> task,
 #endif
 
     // Update tag size
-    chi::u64 new_blob_size = blob_info_ptr->GetTotalSize();
+    chi::u64 new_blob_size = blob_info_ptr->GetLogicalSize();
     chi::i64 size_change = static_cast<chi::i64>(new_blob_size) -
                            static_cast<chi::i64>(old_blob_size);
     auto now = GetCurrentTimeNs();
     blob_info_ptr->last_modified_ = now;
+    ++blob_info_ptr->version_;
     blob_info_ptr->score_ = blob_score;
-    {
+    // A TTL given with the write wins over the tag's; without either the
+    // blob keeps its deadline
+    chi::u64 ttl_ms = task->context_.ttl_ms_;
+    StampExpiry(tag_id, blob_name, *blob_info_ptr,
+                ttl_ms > 0 ? ttl_ms : GetTagTtl(tag_id), now);
+    chi::u32 replicas = GetTagReplicas(tag_id);
+    bool replica_copy = IsReplicaCopy(tag_id, blob_name, replicas);
+    if (!replica_copy) {
+      // Replica copies are not counted towards the tag size
       chi::ScopedCoRwReadLock lock(tag_map_lock_);
       TagInfo *tag_info_ptr = tag_id_to_info_.find(tag_id);
       if (tag_info_ptr) {
@@ -972,10 +1453,18 @@ chi::TaskResume Runtime::PutBlob(hipc::FullPtr<PutBlobTask> task,
         }
       }
     }
+    MarkBlobDirty(tag_id, blob_name);
+    MarkTagDirty(tag_id);
+    UpdateWriteBackState(tag_id, blob_name, *blob_info_ptr);
 
     LogTelemetry(CteOp::kPutBlob, offset, size, tag_id, now,
                  blob_info_ptr->last_read_);
     task->return_code_ = 0;
+
+    // The primary copies the write to the other replicas
+    if (replicas > 1 && !replica_copy) {
+      CHI_CO_AWAIT(ReplicateBlobWrite(task, blob_score, replicas));
+    }
   } catch (const std::exception &e) {
     HLOG(kError, "PutBlob failed with exception: {}", e.what());
     task->return_code_ = 1;
@@ -984,6 +1473,143 @@ chi::TaskResume Runtime::PutBlob(hipc::FullPtr<PutBlobTask> task,
   CHI_TASK_BODY_END
 }
 
+chi::TaskResume Runtime::PutBlobBatch(hipc::FullPtr<PutBlobBatchTask> task,
+                                      chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  try {
+    chi::u32 count = std::min(task->count_, kMaxPutBlobBatch);
+    std::string prefix = task->name_prefix_.str();
+    chi::u32 failed = 0;
+    task->return_code_ = 0;
+
+    // Every entry is routed like a standalone PutBlob, so one batch may
+    // span containers; all of them are in flight at once
+    std::vector<chi::Future<PutBlobTask>> put_tasks;
+    put_tasks.reserve(count);
+    for (chi::u32 i = 0; i < count; ++i) {
+      const PutBlobBatchEntry &entry = task->entries_[i];
+      put_tasks.push_back(client_.AsyncPutBlob(
+          task->tag_id_, prefix + std::to_string(entry.blob_index_),
+          entry.offset_, entry.size_, entry.data_, task->score_, Context(),
+          task->flags_));
+    }
+    for (auto &put_task : put_tasks) {
+      CHI_CO_AWAIT(put_task);
+      if (put_task->GetReturnCode() != 0) {
+        // The return code is the last failure
+        ++failed;
+        task->return_code_ = put_task->GetReturnCode();
+      }
+    }
+    task->failed_ = failed;
+  } catch (const std::exception &e) {
+    HLOG(kError, "PutBlobBatch failed with exception: {}", e.what());
+    task->return_code_ = 1;
+  }
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+chi::TaskResume Runtime::AppendBlob(hipc::FullPtr<AppendBlobTask> task,
+                                    chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  try {
+    TagId tag_id = task->tag_id_;
+    chi::u64 size = task->size_;
+    chi::u64 chunk_size = task->chunk_size_;
+    hipc::ShmPtr<> blob_data = task->blob_data_;
+
+    // Validate inputs
+    if (size == 0) {
+      task->return_code_ = 2;
+      CHI_CO_RETURN;
+    }
+    if (blob_data.IsNull()) {
+      task->return_code_ = 3;
+      CHI_CO_RETURN;
+    }
+    if (chunk_size == 0) {
+      task->return_code_ = 4;
+      CHI_CO_RETURN;
+    }
+
+    // Step 1: Seed the cursor from the tag size across all nodes on first
+    // use. A concurrent append may seed it first; insert keeps that value.
+    if (append_cursors_.find(tag_id) == nullptr) {
+      auto size_task =
+          client_.AsyncGetTagSize(tag_id, chi::PoolQuery::Broadcast());
+      CHI_CO_AWAIT(size_task);
+      if (size_task->GetReturnCode() != 0) {
+        task->return_code_ = 5;
+        CHI_CO_RETURN;
+      }
+      append_cursors_.insert(tag_id,
+                             static_cast<chi::u64>(size_task->tag_size_));
+    }
+
+    // Step 2: Reserve [offset, offset + size) atomically
+    chi::u64 offset = 0;
+    append_cursors_.lock_key(tag_id);
+    chi::u64 *cursor = append_cursors_.find_locked(tag_id);
+    if (cursor == nullptr) {
+      // The tag was deleted after seeding; it restarts empty
+      append_cursors_.insert_locked(tag_id, size);
+    } else {
+      offset = *cursor;
+      *cursor += size;
+    }
+    append_cursors_.unlock_key(tag_id);
+    task->offset_ = offset;
+
+    // Step 3: Write the covered chunk blobs, a bounded window at a time
+    constexpr size_t kMaxConcurrentPutBlobTasks = 32;
+    std::vector<chi::Future<PutBlobTask>> put_tasks;
+    chi::u32 put_result = 0;
+    chi::u64 done = 0;
+    while (done < size) {
+      put_tasks.clear();
+      while (done < size && put_tasks.size() < kMaxConcurrentPutBlobTasks) {
+        chi::u64 cur = offset + done;
+        chi::u64 chunk_off = cur % chunk_size;
+        chi::u64 len = std::min(chunk_size - chunk_off, size - done);
+        put_tasks.push_back(client_.AsyncPutBlob(
+            tag_id, std::to_string(cur / chunk_size), chunk_off, len,
+            blob_data + done, task->score_, task->context_));
+        done += len;
+      }
+      for (auto &put_task : put_tasks) {
+        CHI_CO_AWAIT(put_task);
+        if (put_task->GetReturnCode() != 0) {
+          put_result = put_task->GetReturnCode();
+        }
+      }
+      if (put_result != 0) {
+        // The reserved range stays a hole; later appends are unaffected
+        HLOG(kError, "AppendBlob failed at tag offset {} (size {})", offset,
+             size);
+        task->return_code_ = 10 + put_result;
+        CHI_CO_RETURN;
+      }
+    }
+    task->return_code_ = 0;
+  } catch (const std::exception &e) {
+    HLOG(kError, "AppendBlob failed with exception: {}", e.what());
+    task->return_code_ = 1;
+  }
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
 chi::TaskResume Runtime::GetBlob(hipc::FullPtr<GetBlobTask> task,
                                  chi::RunContext &ctx) {
 #ifdef __NVCOMPILER
@@ -1000,9 +1626,6 @@ chi::TaskResume Runtime::GetBlob(hipc::FullPtr<GetBlobTask> task,
     chi::u64 size = task->size_;
     chi::u32 flags = task->flags_;
 
-    // Suppress unused variable warning for flags - may be used in future
-    (void)flags;
-
     // Validate input parameters
     if (size == 0) {
       task->return_code_ = 1;
@@ -1018,19 +1641,81 @@ chi::TaskResume Runtime::GetBlob(hipc::FullPtr<GetBlobTask> task,
     // Step 1: Check if blob exists
     BlobInfo *blob_info_ptr = CheckBlobExists(blob_name, tag_id);
 
-    // If blob doesn't exist, error
+    // If blob doesn't exist, error. A replica that has not received the
+    // blob yet, or a new owner it has not been moved to yet, forwards the
+    // read once to the container that should still hold it.
+    chi::ContainerId holder;
     if (blob_info_ptr == nullptr) {
-      task->return_code_ = 1;
+      if ((flags & kGetBlobNoRedirect) ||
+          !FindRedirectTarget(tag_id, blob_name, holder)) {
+        task->return_code_ = 1;
+        CHI_CO_RETURN;
+      }
+      auto redirect_get = client_.AsyncGetBlob(
+          tag_id, blob_name, offset, size, flags | kGetBlobNoRedirect,
+          task->blob_data_, chi::PoolQuery::DirectId(holder));
+      CHI_CO_AWAIT(redirect_get);
+      task->return_code_ = redirect_get->GetReturnCode();
       CHI_CO_RETURN;
     }
 
     // Use the pre-provided data pointer from the task
     hipc::ShmPtr<> blob_data_ptr = task->blob_data_;
 
-    // Step 2: Read data from blob blocks (no lock held during I/O)
+    // A stub is read from its source file. With kBlobStubCache the first
+    // reader copies it into a target and every later read hits the blocks.
     chi::u32 read_result = 0;
-    CHI_CO_AWAIT(ReadData(blob_info_ptr->blocks_, blob_data_ptr, size, offset,
-                      read_result));
+    if (blob_info_ptr->IsStub()) {
+      if (offset + size > blob_info_ptr->stub_size_) {
+        task->return_code_ = 1;
+        CHI_CO_RETURN;
+      }
+      if ((blob_info_ptr->stub_flags_ & kBlobStubCache) &&
+          __atomic_exchange_n(&blob_info_ptr->stub_loading_, 1,
+                              __ATOMIC_ACQ_REL) == 0) {
+        chi::u32 load_result = 0;
+        CHI_CO_AWAIT(MaterializeStub(tag_id, blob_name, *blob_info_ptr,
+                                     load_result));
+        __atomic_store_n(&blob_info_ptr->stub_loading_, 0, __ATOMIC_RELEASE);
+      }
+    }
+    if (blob_info_ptr->IsStub()) {
+      auto out = CHI_IPC->ToFullPtr<char>(blob_data_ptr.template Cast<char>());
+      CHI_CO_AWAIT(ReadStubSource(blob_info_ptr->stub_path_.str(),
+                                  blob_info_ptr->stub_offset_ + offset,
+                                  out.ptr_, size, read_result));
+    } else if (blob_info_ptr->IsErasureCoded()) {
+      // Step 2: Read the data shards, rebuilding any that are unreachable
+      CHI_CO_AWAIT(ReadErasureData(*blob_info_ptr, blob_data_ptr, size, offset,
+                                   task->qos_class_, read_result));
+    } else if (blob_info_ptr->IsEncrypted()) {
+      // Step 2: Read and open only the sealed chunks covering the range
+      CHI_CO_AWAIT(ReadEncryptedData(*blob_info_ptr, blob_data_ptr, size,
+                                     offset, task->qos_class_, read_result));
+    } else {
+      // Step 2: Read data from the read cache, else from blob blocks (no
+      // lock held during I/O), sharing the bdev reads with concurrent
+      // readers of the same range
+      bool cached = false;
+      bool cacheable = read_cache_ != nullptr && !IsDramLayout(*blob_info_ptr);
+      if (cacheable) {
+        CHI_CO_AWAIT(ReadFromCache(tag_id, blob_name, *blob_info_ptr,
+                                   blob_data_ptr, size, offset, cached));
+      }
+      if (!cached) {
+        chi::u64 version = blob_info_ptr->version_;
+        CHI_CO_AWAIT(ReadDataOnce(tag_id, blob_name, *blob_info_ptr,
+                                  blob_data_ptr, size, offset, read_result,
+                                  task->qos_class_));
+        // Only a read of the whole blob fills the cache
+        if (cacheable && read_result == 0 && offset == 0 &&
+            size == blob_info_ptr->GetTotalSize() &&
+            size <= config_.performance_.read_cache_max_blob_) {
+          CHI_CO_AWAIT(FillReadCache(tag_id, blob_name, version,
+                                     blob_data_ptr, size));
+        }
+      }
+    }
     if (read_result != 0) {
       task->return_code_ = read_result;
       CHI_CO_RETURN;
@@ -1116,7 +1801,8 @@ chi::TaskResume Runtime::ReorganizeBlob(hipc::FullPtr<ReorganizeBlobTask> task,
          blob_name, blob_info.score_, new_score);
 
     // Step 4: Get blob size from blob_info
-    chi::u64 blob_size = blob_info.GetTotalSize();
+    chi::u64 blob_size = blob_info.GetLogicalSize();
+    Context put_ctx = KeepTtl(blob_info);
 
     if (blob_size == 0) {
       // Empty blob, no data to reorganize
@@ -1152,7 +1838,7 @@ chi::TaskResume Runtime::ReorganizeBlob(hipc::FullPtr<ReorganizeBlobTask> task,
          blob_name, new_score);
     auto put_task = client_.AsyncPutBlob(
         tag_id, blob_name, 0, blob_size,
-        blob_data_buffer.shm_.template Cast<void>(), new_score, Context(), 0);
+        blob_data_buffer.shm_.template Cast<void>(), new_score, put_ctx, 0);
     CHI_CO_AWAIT(put_task);
 
     if (put_task->return_code_ != 0) {
@@ -1198,17 +1884,59 @@ chi::TaskResume Runtime::DelBlob(hipc::FullPtr<DelBlobTask> task,
     // Step 1: Check if blob exists
     BlobInfo *blob_info_ptr = CheckBlobExists(blob_name, tag_id);
 
+    // The primary forwards a miss to where an unmoved blob still lives
+    chi::ContainerId previous_owner;
     if (blob_info_ptr == nullptr) {
-      task->return_code_ = 1;  // Blob not found
+      if (IsReplicaCopy(tag_id, blob_name, GetTagReplicas(tag_id)) ||
+          !GetPreviousOwner(tag_id, blob_name, previous_owner)) {
+        task->return_code_ = 1;  // Blob not found
+        CHI_CO_RETURN;
+      }
+      auto redirect_del = client_.AsyncDelBlob(
+          tag_id, blob_name, chi::PoolQuery::DirectId(previous_owner));
+      CHI_CO_AWAIT(redirect_del);
+      task->return_code_ = redirect_del->GetReturnCode();
       CHI_CO_RETURN;
     }
 
-    // Step 2: Get blob size before deletion for tag size accounting
-    chi::u64 blob_size = blob_info_ptr->GetTotalSize();
+    // Step 2: Free the blocks and drop the blob everywhere
+    chi::u64 blob_size = 0;
+    CHI_CO_AWAIT(
+        RemoveBlob(tag_id, blob_name, *blob_info_ptr, nullptr, blob_size));
+
+    // Success
+    task->return_code_ = 0;
+    HLOG(kDebug, "DelBlob successful: name={}, blob_size={}", blob_name,
+         blob_size);
+  } catch (const std::exception &e) {
+    task->return_code_ = 1;
+  }
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
 
-    // Step 2.5: Free all blocks back to their targets before removing blob
+chi::TaskResume Runtime::RemoveBlob(const TagId &tag_id,
+                                    const std::string &blob_name,
+                                    BlobInfo &blob_info, BlobInfo *freed,
+                                    chi::u64 &blob_size) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  // Get blob size before deletion for tag size accounting
+  blob_size = blob_info.GetLogicalSize();
+  CHI_CO_AWAIT(InvalidateReadCache(tag_id, blob_name));
+
+  // Free all blocks back to their targets before removing blob
+  if (freed != nullptr) {
+    for (const auto &blob_block : blob_info.blocks_) {
+      freed->blocks_.push_back(blob_block);
+    }
+    blob_info.blocks_.clear();
+  } else {
     chi::u32 free_result = 0;
-    CHI_CO_AWAIT(FreeAllBlobBlocks(*blob_info_ptr, free_result));
+    CHI_CO_AWAIT(FreeAllBlobBlocks(blob_info, free_result));
     if (free_result != 0) {
       HLOG(kWarning,
            "Failed to free some blocks for blob={}, continuing with deletion",
@@ -1216,57 +1944,52 @@ chi::TaskResume Runtime::DelBlob(hipc::FullPtr<DelBlobTask> task,
       // Continue with deletion even if freeing fails to avoid orphaned blob
       // entries
     }
+  }
 
-    // Step 3: Update tag's total_size_
-    {
-      chi::ScopedCoRwWriteLock lock(tag_map_lock_);
-      TagInfo *tag_info_ptr = tag_id_to_info_.find(tag_id);
-      if (tag_info_ptr != nullptr) {
-        if (blob_size <= tag_info_ptr->total_size_) {
-          tag_info_ptr->total_size_ -= blob_size;
-        } else {
-          tag_info_ptr->total_size_ = 0;
-        }
+  // Update tag's total_size_ (replica copies were never counted)
+  chi::u32 replicas = GetTagReplicas(tag_id);
+  bool replica_copy = IsReplicaCopy(tag_id, blob_name, replicas);
+  if (!replica_copy) {
+    chi::ScopedCoRwWriteLock lock(tag_map_lock_);
+    TagInfo *tag_info_ptr = tag_id_to_info_.find(tag_id);
+    if (tag_info_ptr != nullptr) {
+      if (blob_size <= tag_info_ptr->total_size_) {
+        tag_info_ptr->total_size_ -= blob_size;
+      } else {
+        tag_info_ptr->total_size_ = 0;
       }
     }
+  }
 
-    // Step 5: Remove blob from tag_blob_name_to_info_ map
-    {
-      chi::ScopedCoRwWriteLock lock(blob_map_lock_);
-      std::string compound_key = std::to_string(tag_id.major_) + "." +
-                                 std::to_string(tag_id.minor_) + "." +
-                                 blob_name;
-      tag_blob_name_to_info_.erase(compound_key);
-    }
-
-    // Step 6: Log telemetry for DelBlob operation
-    auto now = GetCurrentTimeNs();
-    LogTelemetry(CteOp::kDelBlob, 0, blob_size, tag_id, now, now);
+  // Remove blob from tag_blob_name_to_info_ map
+  tag_blob_name_to_info_.Erase(tag_id, blob_name);
+  MarkBlobDirty(tag_id, blob_name);
+  MarkTagDirty(tag_id);
 
-    // WAL: log blob deletion
-    if (!blob_txn_logs_.empty()) {
-      chi::u32 wid = CHI_CUR_WORKER->GetWorkerStats().worker_id_;
-      TxnDelBlob txn;
-      txn.tag_major_ = tag_id.major_;
-      txn.tag_minor_ = tag_id.minor_;
-      txn.blob_name_ = blob_name;
-      blob_txn_logs_[wid % blob_txn_logs_.size()]->Log(TxnType::kDelBlob, txn);
-    }
+  // Log telemetry for DelBlob operation
+  auto now = GetCurrentTimeNs();
+  LogTelemetry(CteOp::kDelBlob, 0, blob_size, tag_id, now, now);
 
-    // Success
-    task->return_code_ = 0;
-    HLOG(kDebug, "DelBlob successful: name={}, blob_size={}", blob_name,
-         blob_size);
+  // WAL: log blob deletion
+  if (!blob_txn_logs_.empty()) {
+    chi::u32 wid = CHI_CUR_WORKER->GetWorkerStats().worker_id_;
+    TxnDelBlob txn;
+    txn.tag_major_ = tag_id.major_;
+    txn.tag_minor_ = tag_id.minor_;
+    txn.blob_name_ = blob_name;
+    blob_txn_logs_[wid % blob_txn_logs_.size()]->Log(TxnType::kDelBlob, txn);
+  }
 
-  } catch (const std::exception &e) {
-    task->return_code_ = 1;
+  // The primary removes the other replicas too
+  if (replicas > 1 && !replica_copy) {
+    CHI_CO_AWAIT(ReplicateBlobDelete(
+        tag_id, blob_name, GetBlobReplicas(tag_id, blob_name, replicas)));
   }
   CHI_CO_RETURN;
-  CHI_TASK_BODY_END
 }
 
-chi::TaskResume Runtime::DelTag(hipc::FullPtr<DelTagTask> task,
-                                chi::RunContext &ctx) {
+chi::TaskResume Runtime::RegisterBlobStub(
+    hipc::FullPtr<RegisterBlobStubTask> task, chi::RunContext &ctx) {
 #ifdef __NVCOMPILER
   chi::RunContext& rctx = ctx;
 #else
@@ -1275,150 +1998,217 @@ chi::TaskResume Runtime::DelTag(hipc::FullPtr<DelTagTask> task,
   CHI_TASK_BODY_BEGIN
   try {
     TagId tag_id = task->tag_id_;
-    std::string tag_name = task->tag_name_.str();
+    std::string blob_name = task->blob_name_.str();
+    std::string source_path = task->source_path_.str();
+    chi::u64 size = task->size_;
+    float blob_score = task->score_;
 
-    // Step 1: Resolve tag ID if tag name was provided instead
-    if (tag_id.IsNull() && !tag_name.empty()) {
-      chi::ScopedCoRwReadLock lock(tag_map_lock_);
-      TagId *found_tag_id_ptr = tag_name_to_id_.find(tag_name);
-      if (found_tag_id_ptr == nullptr) {
-        task->return_code_ = 1;  // Tag not found by name
-        CHI_CO_RETURN;
-      }
-      tag_id = *found_tag_id_ptr;
-      task->tag_id_ = tag_id;
-    } else if (tag_id.IsNull() && tag_name.empty()) {
+    // Validate inputs
+    if (blob_name.empty() || source_path.empty()) {
       task->return_code_ = 1;
       CHI_CO_RETURN;
     }
+    if (size == 0) {
+      task->return_code_ = 2;
+      CHI_CO_RETURN;
+    }
+    if (blob_score < 0.0f || blob_score > 1.0f) {
+      task->return_code_ = 3;
+      CHI_CO_RETURN;
+    }
 
-    // Step 2: Find the tag by ID
-    std::string cached_tag_name;
-    {
-      chi::ScopedCoRwReadLock lock(tag_map_lock_);
-      TagInfo *tag_info_ptr = tag_id_to_info_.find(tag_id);
-      if (tag_info_ptr == nullptr) {
-        task->return_code_ = 1;  // Tag not found by ID
+    // Re-registering a stub moves it; a blob holding data is left alone
+    chi::u64 old_blob_size = 0;
+    BlobInfo *blob_info_ptr = CheckBlobExists(blob_name, tag_id);
+    if (blob_info_ptr != nullptr) {
+      if (!blob_info_ptr->IsStub()) {
+        task->return_code_ = 4;
+        CHI_CO_RETURN;
+      }
+      old_blob_size = blob_info_ptr->stub_size_;
+    } else {
+      blob_info_ptr = CreateNewBlob(blob_name, tag_id, blob_score);
+      if (blob_info_ptr == nullptr) {
+        task->return_code_ = 5;
         CHI_CO_RETURN;
       }
-      cached_tag_name = tag_info_ptr->tag_name_.str();
     }
+    blob_info_ptr->stub_path_ = source_path;
+    blob_info_ptr->stub_offset_ = task->source_offset_;
+    blob_info_ptr->stub_size_ = size;
+    blob_info_ptr->stub_flags_ = task->stub_flags_;
+    blob_info_ptr->score_ = blob_score;
+    auto now = GetCurrentTimeNs();
+    blob_info_ptr->last_modified_ = now;
+    ++blob_info_ptr->version_;
+    LogBlobStub(tag_id, blob_name, *blob_info_ptr);
 
-    // Step 3: Collect blob names under read lock, then delete
-    std::string tag_prefix = std::to_string(tag_id.major_) + "." +
-                             std::to_string(tag_id.minor_) + ".";
-    std::vector<std::string> blob_names_to_delete;
+    // Stubs count towards the tag size like the data they stand for
     {
-      chi::ScopedCoRwReadLock lock(blob_map_lock_);
-      tag_blob_name_to_info_.for_each(
-          [&tag_prefix, &blob_names_to_delete](const std::string &compound_key,
-                                               const BlobInfo &blob_info) {
-            if (compound_key.compare(0, tag_prefix.length(), tag_prefix) == 0) {
-              blob_names_to_delete.push_back(blob_info.blob_name_.str());
-            }
-          });
-    }
-
-    // Process blobs in batches to limit concurrent async tasks
-    constexpr size_t kMaxConcurrentDelBlobTasks = 32;
-    std::vector<chi::Future<DelBlobTask>> async_tasks;
-    size_t processed_blobs = 0;
-
-    for (size_t i = 0; i < blob_names_to_delete.size();
-         i += kMaxConcurrentDelBlobTasks) {
-      // Create a batch of async tasks (up to kMaxConcurrentDelBlobTasks)
-      async_tasks.clear();
-      size_t batch_end =
-          std::min(i + kMaxConcurrentDelBlobTasks, blob_names_to_delete.size());
-
-      for (size_t j = i; j < batch_end; ++j) {
-        const std::string &blob_name = blob_names_to_delete[j];
-
-        // Call AsyncDelBlob from client
-        auto async_task = client_.AsyncDelBlob(tag_id, blob_name);
-        async_tasks.push_back(async_task);
+      chi::ScopedCoRwReadLock lock(tag_map_lock_);
+      TagInfo *tag_info_ptr = tag_id_to_info_.find(tag_id);
+      if (tag_info_ptr) {
+        tag_info_ptr->last_modified_ = now;
+        tag_info_ptr->total_size_ -=
+            std::min(old_blob_size, tag_info_ptr->total_size_);
+        tag_info_ptr->total_size_ += size;
       }
+    }
+    MarkBlobDirty(tag_id, blob_name);
+    MarkTagDirty(tag_id);
+    task->return_code_ = 0;
+  } catch (const std::exception &e) {
+    task->return_code_ = 1;
+  }
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
 
-      // Wait for all async DelBlob operations in this batch to complete
-      for (auto task : async_tasks) {
-        CHI_CO_AWAIT(task);
-
-        // Check if DelBlob succeeded
-        if (task->return_code_ != 0) {
-          HLOG(kWarning,
-               "DelBlob failed for blob during tag deletion, continuing");
-          // Continue with other blobs even if one fails
-        }
+chi::TaskResume Runtime::ReserveBlob(hipc::FullPtr<ReserveBlobTask> task,
+                                     chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  try {
+    TagId tag_id = task->tag_id_;
+    std::string blob_name = task->blob_name_.str();
+    chi::u64 size = task->size_;
+    float blob_score = task->score_;
 
-        // Clean up the task
-        ++processed_blobs;
-      }
+    // Validate inputs
+    if (blob_name.empty()) {
+      task->return_code_ = 1;
+      CHI_CO_RETURN;
+    }
+    if (size == 0) {
+      task->return_code_ = 2;
+      CHI_CO_RETURN;
     }
 
-    // Step 4: Remove all blob name mappings for this tag
-    {
-      chi::ScopedCoRwWriteLock lock(blob_map_lock_);
-      std::vector<std::string> keys_to_erase;
-      tag_blob_name_to_info_.for_each(
-          [&tag_prefix, &keys_to_erase](const std::string &compound_key,
-                                        const BlobInfo &blob_info) {
-            if (compound_key.compare(0, tag_prefix.length(), tag_prefix) == 0) {
-              keys_to_erase.push_back(compound_key);
-            }
-          });
-      for (const auto &key : keys_to_erase) {
-        tag_blob_name_to_info_.erase(key);
+    BlobInfo *blob_info_ptr = CheckBlobExists(blob_name, tag_id);
+    chi::ContainerId previous_owner;
+    if (blob_info_ptr == nullptr &&
+        GetPreviousOwner(tag_id, blob_name, previous_owner)) {
+      CHI_CO_AWAIT(PullFromPreviousOwner(tag_id, blob_name, previous_owner));
+      blob_info_ptr = CheckBlobExists(blob_name, tag_id);
+    }
+    if (blob_score < 0.0f) {
+      blob_score = blob_info_ptr != nullptr ? blob_info_ptr->score_ : 1.0f;
+    }
+    if (blob_score > 1.0f) {
+      task->return_code_ = 3;
+      CHI_CO_RETURN;
+    }
+    // Stubs, erasure-coded and encrypted blobs have no plain block list to
+    // grow, and an encrypted tag would seal over the reservation
+    if ((blob_info_ptr != nullptr &&
+         (blob_info_ptr->IsStub() || blob_info_ptr->IsErasureCoded() ||
+          blob_info_ptr->IsEncrypted())) ||
+        GetTagEncryptChunk(tag_id) != 0) {
+      task->return_code_ = 4;
+      CHI_CO_RETURN;
+    }
+    if (blob_info_ptr == nullptr) {
+      blob_info_ptr = CreateNewBlob(blob_name, tag_id, blob_score);
+      if (blob_info_ptr == nullptr) {
+        task->return_code_ = 5;
+        CHI_CO_RETURN;
       }
     }
-
-    // Step 5: Remove tag name and tag info mappings
-    size_t blob_count = processed_blobs;
-    size_t total_size = 0;
-    {
-      chi::ScopedCoRwWriteLock lock(tag_map_lock_);
-      TagInfo *tag_info_ptr = tag_id_to_info_.find(tag_id);
-      if (tag_info_ptr != nullptr) {
-        total_size = tag_info_ptr->total_size_;
-        if (!tag_info_ptr->tag_name_.empty()) {
-          tag_name_to_id_.erase(tag_info_ptr->tag_name_.str());
-        }
+    blob_info_ptr->preallocated_size_ =
+        std::max(blob_info_ptr->preallocated_size_, size);
+
+    // Allocate the missing capacity once, then zero it so the reserved
+    // range never exposes bytes of freed blocks
+    chi::u64 old_blob_size = blob_info_ptr->GetLogicalSize();
+    if (old_blob_size < size) {
+      chi::u32 alloc_result = 0;
+      CHI_CO_AWAIT(ExtendBlob(*blob_info_ptr, 0, size, blob_score,
+                              alloc_result));
+      if (alloc_result != 0) {
+        task->return_code_ = 10 + alloc_result;
+        CHI_CO_RETURN;
+      }
+      LogBlobBlocks(tag_id, blob_name, *blob_info_ptr);
+
+      chi::u64 gap = size - old_blob_size;
+      chi::u64 chunk = std::min(gap, kReserveZeroChunk);
+      auto *ipc_manager = CHI_IPC;
+      hipc::FullPtr<char> zeros = ipc_manager->AllocateBuffer(chunk);
+      if (zeros.IsNull()) {
+        task->return_code_ = 6;
+        CHI_CO_RETURN;
       }
+      memset(zeros.ptr_, 0, chunk);
+      chi::u32 write_result = 0;
+      for (chi::u64 off = old_blob_size; off < size && write_result == 0;
+           off += chunk) {
+        CHI_CO_AWAIT(ModifyExistingData(
+            blob_info_ptr->blocks_, hipc::ShmPtr<>(zeros.shm_),
+            std::min(chunk, size - off), off, write_result));
+      }
+      ipc_manager->FreeBuffer(zeros);
+      if (write_result != 0) {
+        task->return_code_ = 20 + write_result;
+        CHI_CO_RETURN;
+      }
+      reserved_bytes_.fetch_add(gap, std::memory_order_relaxed);
     }
 
-    // Log telemetry for DelTag operation
+    // Update tag size
     auto now = GetCurrentTimeNs();
-    LogTelemetry(CteOp::kDelTag, 0, total_size, tag_id, now, now);
-
-    // WAL: log tag deletion
-    if (!tag_txn_logs_.empty()) {
-      chi::u32 wid = CHI_CUR_WORKER->GetWorkerStats().worker_id_;
-      TxnDelTag txn;
-      txn.tag_name_ = cached_tag_name;
-      txn.tag_major_ = tag_id.major_;
-      txn.tag_minor_ = tag_id.minor_;
-      tag_txn_logs_[wid % tag_txn_logs_.size()]->Log(TxnType::kDelTag, txn);
-    }
-
-    {
-      chi::ScopedCoRwWriteLock lock(tag_map_lock_);
-      tag_id_to_info_.erase(tag_id);
+    blob_info_ptr->last_modified_ = now;
+    ++blob_info_ptr->version_;
+    blob_info_ptr->score_ = blob_score;
+    StampExpiry(tag_id, blob_name, *blob_info_ptr, GetTagTtl(tag_id), now);
+    chi::u32 replicas = GetTagReplicas(tag_id);
+    bool replica_copy = IsReplicaCopy(tag_id, blob_name, replicas);
+    if (!replica_copy) {
+      chi::ScopedCoRwReadLock lock(tag_map_lock_);
+      TagInfo *tag_info_ptr = tag_id_to_info_.find(tag_id);
+      if (tag_info_ptr) {
+        tag_info_ptr->last_modified_ = now;
+        tag_info_ptr->total_size_ +=
+            blob_info_ptr->GetLogicalSize() - old_blob_size;
+      }
     }
-
-    // Success
+    MarkBlobDirty(tag_id, blob_name);
+    MarkTagDirty(tag_id);
+    UpdateWriteBackState(tag_id, blob_name, *blob_info_ptr);
     task->return_code_ = 0;
-    HLOG(kDebug,
-         "DelTag successful: tag_id={},{}, removed {} blobs, total_size={}",
-         tag_id.major_, tag_id.minor_, blob_count, total_size);
 
+    // The primary reserves the other replicas too, so chunked writes copied
+    // to them also land in place
+    if (replicas > 1 && !replica_copy) {
+      std::vector<chi::ContainerId> containers =
+          GetBlobReplicas(tag_id, blob_name, replicas);
+      std::vector<chi::Future<ReserveBlobTask>> reserve_tasks;
+      for (size_t i = 1; i < containers.size(); ++i) {
+        reserve_tasks.push_back(client_.AsyncReserveBlob(
+            tag_id, blob_name, size, blob_score,
+            chi::PoolQuery::DirectId(containers[i])));
+      }
+      for (auto &reserve_task : reserve_tasks) {
+        CHI_CO_AWAIT(reserve_task);
+        if (reserve_task->GetReturnCode() != 0) {
+          HLOG(kWarning, "ReserveBlob: replica reservation of {} failed "
+               "(error {})", blob_name, reserve_task->GetReturnCode());
+        }
+      }
+    }
   } catch (const std::exception &e) {
+    HLOG(kError, "ReserveBlob failed with exception: {}", e.what());
     task->return_code_ = 1;
   }
   CHI_CO_RETURN;
   CHI_TASK_BODY_END
 }
 
-chi::TaskResume Runtime::GetTagSize(hipc::FullPtr<GetTagSizeTask> task,
-                                    chi::RunContext &ctx) {
+chi::TaskResume Runtime::GetBlobView(hipc::FullPtr<GetBlobViewTask> task,
+                                     chi::RunContext &ctx) {
 #ifdef __NVCOMPILER
   chi::RunContext& rctx = ctx;
 #else
@@ -1427,33 +2217,460 @@ chi::TaskResume Runtime::GetTagSize(hipc::FullPtr<GetTagSizeTask> task,
   CHI_TASK_BODY_BEGIN
   try {
     TagId tag_id = task->tag_id_;
+    std::string blob_name = task->blob_name_.str();
+    chi::u64 offset = task->offset_;
+    task->extents_.clear();
 
-    // Find the tag
-    chi::ScopedCoRwWriteLock lock(tag_map_lock_);
-    TagInfo *tag_info_ptr = tag_id_to_info_.find(tag_id);
-    if (tag_info_ptr == nullptr) {
-      task->return_code_ = 1;  // Tag not found
-      task->tag_size_ = 0;
+    // Only a client on this node shares the targets' memory
+    auto *ipc_manager = CHI_IPC;
+    chi::u32 node_id = ipc_manager->GetNodeId();
+    if (task->client_node_ != node_id) {
+      task->return_code_ = 2;
+      CHI_CO_RETURN;
+    }
+    BlobInfo *blob_info_ptr = CheckBlobExists(blob_name, tag_id);
+    if (blob_info_ptr == nullptr) {
+      task->return_code_ = 1;
+      CHI_CO_RETURN;
+    }
+    // Encoded blobs are not stored as their bytes
+    if (blob_info_ptr->IsStub() || blob_info_ptr->IsErasureCoded() ||
+        blob_info_ptr->IsEncrypted()) {
+      task->return_code_ = 3;
+      CHI_CO_RETURN;
+    }
+    chi::u64 blob_size = blob_info_ptr->GetTotalSize();
+    chi::u64 size = task->size_ != 0 ? task->size_ : blob_size - offset;
+    if (offset >= blob_size || size == 0 || offset + size > blob_size) {
+      task->return_code_ = 1;
       CHI_CO_RETURN;
     }
 
-    // Update timestamp and return the total size
+    // Clip each overlapping block to the range; pin the whole block
+    std::vector<BlobBlock> pinned;
+    bool viewable = true;
+    {
+      chi::ScopedCoRwReadLock read_lock(target_lock_);
+      chi::u64 block_start = 0;
+      for (const auto &block : blob_info_ptr->blocks_) {
+        chi::u64 block_end = block_start + block.size_;
+        if (block_end > offset && block_start < offset + size) {
+          TargetInfo *target = registered_targets_.find(block.target_id_);
+          bool local =
+              target != nullptr &&
+              (target->target_query_.IsLocalMode() ||
+               (target->target_query_.IsPhysicalMode() &&
+                target->target_query_.GetNodeId() == node_id));
+          if (!local || !target->client_mappable_ ||
+              target->bdev_type_ != chimaera::bdev::BdevType::kRam ||
+              target->capacity_ == 0) {
+            viewable = false;
+            break;
+          }
+          chi::u64 piece_start = std::max(block_start, offset);
+          chi::u64 piece_end = std::min(block_end, offset + size);
+          task->extents_.emplace_back(
+              block.target_id_,
+              block.target_offset_ + (piece_start - block_start),
+              piece_end - piece_start, target->capacity_);
+          pinned.push_back(block);
+        }
+        block_start = block_end;
+      }
+    }
+    if (!viewable) {
+      task->extents_.clear();
+      task->return_code_ = 3;
+      CHI_CO_RETURN;
+    }
+
+    // Pinned blocks count as shared, so writes copy the blob rather than
+    // change the bytes under the view
+    SettleDeferredBlocks(*blob_info_ptr);
+    {
+      hshm::ScopedMutex guard(block_refs_lock_, 0);
+      for (const auto &block : pinned) {
+        chi::u32 &refs = block_refs_[block];
+        refs = refs == 0 ? 2 : refs + 1;
+      }
+    }
+    chi::u64 lease_id = next_view_lease_.fetch_add(1);
     auto now = GetCurrentTimeNs();
-    tag_info_ptr->last_read_ = now;
+    {
+      hshm::ScopedMutex guard(view_lease_lock_, 0);
+      BlobViewLease &lease = view_leases_[lease_id];
+      lease.blocks_ = std::move(pinned);
+      lease.deadline_ = now + kBlobViewLeaseMs * 1000000ULL;
+    }
+    blob_info_ptr->last_read_ = now;
+    views_served_.fetch_add(1, std::memory_order_relaxed);
+    LogTelemetry(CteOp::kGetBlob, offset, size, tag_id,
+                 blob_info_ptr->last_modified_, now);
 
-    task->tag_size_ = tag_info_ptr->total_size_;
+    task->lease_id_ = lease_id;
+    task->lease_ms_ = kBlobViewLeaseMs;
     task->return_code_ = 0;
-
-    // Log telemetry for GetTagSize operation
-    LogTelemetry(CteOp::kGetTagSize, 0, tag_info_ptr->total_size_, tag_id,
-                 tag_info_ptr->last_modified_, now);
-
-    HLOG(kDebug, "GetTagSize successful: tag_id={},{}, total_size={}",
-         tag_id.major_, tag_id.minor_, task->tag_size_);
-
   } catch (const std::exception &e) {
+    HLOG(kError, "GetBlobView failed with exception: {}", e.what());
     task->return_code_ = 1;
-    task->tag_size_ = 0;
+  }
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+chi::TaskResume Runtime::ReleaseBlobView(
+    hipc::FullPtr<ReleaseBlobViewTask> task, chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  std::vector<BlobBlock> blocks;
+  bool found = false;
+  {
+    hshm::ScopedMutex guard(view_lease_lock_, 0);
+    auto it = view_leases_.find(task->lease_id_);
+    if (it != view_leases_.end()) {
+      blocks = std::move(it->second.blocks_);
+      view_leases_.erase(it);
+      found = true;
+    }
+  }
+  // An expired lease was already unpinned by StatTargets
+  task->expired_ = !found;
+  if (found) {
+    CHI_CO_AWAIT(UnpinViewBlocks(blocks));
+  }
+  task->return_code_ = 0;
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+chi::TaskResume Runtime::UnpinViewBlocks(const std::vector<BlobBlock> &blocks) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  // A block without an entry lost its last blob while pinned; the pin
+  // owns it and frees it
+  BlobInfo freed;
+  {
+    hshm::ScopedMutex guard(block_refs_lock_, 0);
+    for (const auto &block : blocks) {
+      auto it = block_refs_.find(block);
+      if (it == block_refs_.end()) {
+        freed.blocks_.push_back(block);
+      } else if (--it->second <= 1) {
+        block_refs_.erase(it);
+      }
+    }
+  }
+  if (!freed.blocks_.empty()) {
+    chi::u32 free_result = 0;
+    CHI_CO_AWAIT(FreeAllBlobBlocks(freed, free_result));
+  }
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::ExpireBlobViewLeases() {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  std::vector<BlobBlock> blocks;
+  auto now = GetCurrentTimeNs();
+  {
+    hshm::ScopedMutex guard(view_lease_lock_, 0);
+    for (auto it = view_leases_.begin(); it != view_leases_.end();) {
+      if (it->second.deadline_ > now) {
+        ++it;
+        continue;
+      }
+      blocks.insert(blocks.end(), it->second.blocks_.begin(),
+                    it->second.blocks_.end());
+      it = view_leases_.erase(it);
+    }
+  }
+  if (!blocks.empty()) {
+    HLOG(kDebug, "ExpireBlobViewLeases: unpinning {} blocks", blocks.size());
+    CHI_CO_AWAIT(UnpinViewBlocks(blocks));
+  }
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::MaterializeStub(const TagId &tag_id,
+                                         const std::string &blob_name,
+                                         BlobInfo &blob_info,
+                                         chi::u32 &error_code) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  error_code = 0;
+  chi::u64 size = blob_info.stub_size_;
+  auto *ipc_manager = CHI_IPC;
+  hipc::FullPtr<char> buffer = ipc_manager->AllocateBuffer(size);
+  if (buffer.IsNull()) {
+    error_code = 1;
+    CHI_CO_RETURN;
+  }
+
+  // Read the source range, then write it through the normal put path
+  chi::u32 io_result = 0;
+  CHI_CO_AWAIT(ReadStubSource(blob_info.stub_path_.str(),
+                              blob_info.stub_offset_, buffer.ptr_, size,
+                              io_result));
+  if (io_result != 0) {
+    error_code = 2;
+  }
+  if (error_code == 0) {
+    chi::u32 alloc_result = 0;
+    CHI_CO_AWAIT(ExtendBlob(blob_info, 0, size, blob_info.score_,
+                            alloc_result));
+    if (alloc_result != 0) {
+      error_code = 3;
+    }
+  }
+  if (error_code == 0) {
+    hipc::ShmPtr<> shm_ptr(buffer.shm_);
+    chi::u32 write_result = 0;
+    CHI_CO_AWAIT(ModifyExistingData(blob_info.blocks_, shm_ptr, size, 0,
+                                    write_result));
+    if (write_result != 0) {
+      error_code = 4;
+    }
+  }
+  // Logged once written: replay drops the source of a blob with blocks
+  if (error_code == 0) {
+    LogBlobBlocks(tag_id, blob_name, blob_info);
+  }
+  ipc_manager->FreeBuffer(buffer);
+  if (error_code != 0) {
+    HLOG(kWarning, "MaterializeStub: failed to load blob={} from {} ({})",
+         blob_name, blob_info.stub_path_.str(), error_code);
+    CHI_CO_RETURN;
+  }
+  ClearBlobStub(blob_info);
+  MarkBlobDirty(tag_id, blob_name);
+  UpdateWriteBackState(tag_id, blob_name, blob_info);
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::ReadStubSource(const std::string &path,
+                                        chi::u64 offset, char *data,
+                                        chi::u64 size, chi::u32 &error_code) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  error_code = 0;
+  auto io = hshm::AsyncIoFactory::Get(1);
+  if (!io || !io->Open(path, O_RDONLY, 0)) {
+    HLOG(kError, "ReadStubSource: failed to open {}", path);
+    error_code = 1;
+    CHI_CO_RETURN;
+  }
+  hshm::IoToken token = io->Read(data, size, static_cast<off_t>(offset));
+  hshm::IoResult result;
+  if (token == hshm::kInvalidIoToken) {
+    error_code = 1;
+  } else {
+    // Yield rather than block the worker while the read is in flight
+    while (!io->IsComplete(token, result)) {
+      CHI_CO_AWAIT(chi::yield(kStubIoPollUs));
+    }
+    if (result.bytes_transferred != static_cast<ssize_t>(size)) {
+      HLOG(kError, "ReadStubSource: short read of {} at {} ({} of {} bytes)",
+           path, offset, result.bytes_transferred, size);
+      error_code = 1;
+    }
+  }
+  io->Close();
+  CHI_CO_RETURN;
+}
+
+void Runtime::ClearBlobStub(BlobInfo &blob_info) {
+  blob_info.stub_path_ = std::string();
+  blob_info.stub_offset_ = 0;
+  blob_info.stub_size_ = 0;
+  blob_info.stub_flags_ = 0;
+}
+
+chi::TaskResume Runtime::DelTag(hipc::FullPtr<DelTagTask> task,
+                                chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  try {
+    TagId tag_id = task->tag_id_;
+    std::string tag_name = task->tag_name_.str();
+
+    // Step 1: Resolve tag ID if tag name was provided instead
+    if (tag_id.IsNull() && !tag_name.empty()) {
+      chi::ScopedCoRwReadLock lock(tag_map_lock_);
+      TagId *found_tag_id_ptr = tag_name_to_id_.find(tag_name);
+      if (found_tag_id_ptr == nullptr) {
+        task->return_code_ = 1;  // Tag not found by name
+        CHI_CO_RETURN;
+      }
+      tag_id = *found_tag_id_ptr;
+      task->tag_id_ = tag_id;
+    } else if (tag_id.IsNull() && tag_name.empty()) {
+      task->return_code_ = 1;
+      CHI_CO_RETURN;
+    }
+
+    // Step 2: Find the tag by ID
+    std::string cached_tag_name;
+    {
+      chi::ScopedCoRwReadLock lock(tag_map_lock_);
+      TagInfo *tag_info_ptr = tag_id_to_info_.find(tag_id);
+      if (tag_info_ptr == nullptr) {
+        task->return_code_ = 1;  // Tag not found by ID
+        CHI_CO_RETURN;
+      }
+      cached_tag_name = tag_info_ptr->tag_name_.str();
+    }
+
+    // Step 3: Collect blob names from the per-tag index, then delete
+    std::vector<std::string> blob_names_to_delete =
+        tag_blob_name_to_info_.ListTagBlobs(tag_id);
+
+    // Process blobs in batches to limit concurrent async tasks
+    constexpr size_t kMaxConcurrentDelBlobTasks = 32;
+    std::vector<chi::Future<DelBlobTask>> async_tasks;
+    size_t processed_blobs = 0;
+
+    for (size_t i = 0; i < blob_names_to_delete.size();
+         i += kMaxConcurrentDelBlobTasks) {
+      // Create a batch of async tasks (up to kMaxConcurrentDelBlobTasks)
+      async_tasks.clear();
+      size_t batch_end =
+          std::min(i + kMaxConcurrentDelBlobTasks, blob_names_to_delete.size());
+
+      for (size_t j = i; j < batch_end; ++j) {
+        const std::string &blob_name = blob_names_to_delete[j];
+
+        // Call AsyncDelBlob from client
+        auto async_task = client_.AsyncDelBlob(tag_id, blob_name);
+        async_tasks.push_back(async_task);
+      }
+
+      // Wait for all async DelBlob operations in this batch to complete
+      for (auto task : async_tasks) {
+        CHI_CO_AWAIT(task);
+
+        // Check if DelBlob succeeded
+        if (task->return_code_ != 0) {
+          HLOG(kWarning,
+               "DelBlob failed for blob during tag deletion, continuing");
+          // Continue with other blobs even if one fails
+        }
+
+        // Clean up the task
+        ++processed_blobs;
+      }
+    }
+
+    // Step 4: Remove all blob name mappings for this tag
+    tag_blob_name_to_info_.EraseTag(tag_id);
+    if (blob_meta_) {
+      blob_meta_->InvalidateAll();
+    }
+    append_cursors_.erase(tag_id);
+
+    // Step 5: Remove tag name and tag info mappings
+    size_t blob_count = processed_blobs;
+    size_t total_size = 0;
+    {
+      chi::ScopedCoRwWriteLock lock(tag_map_lock_);
+      TagInfo *tag_info_ptr = tag_id_to_info_.find(tag_id);
+      if (tag_info_ptr != nullptr) {
+        total_size = tag_info_ptr->total_size_;
+        if (!tag_info_ptr->tag_name_.empty()) {
+          tag_name_to_id_.erase(tag_info_ptr->tag_name_.str());
+        }
+      }
+    }
+
+    // Log telemetry for DelTag operation
+    auto now = GetCurrentTimeNs();
+    LogTelemetry(CteOp::kDelTag, 0, total_size, tag_id, now, now);
+
+    // WAL: log tag deletion
+    if (!tag_txn_logs_.empty()) {
+      chi::u32 wid = CHI_CUR_WORKER->GetWorkerStats().worker_id_;
+      TxnDelTag txn;
+      txn.tag_name_ = cached_tag_name;
+      txn.tag_major_ = tag_id.major_;
+      txn.tag_minor_ = tag_id.minor_;
+      tag_txn_logs_[wid % tag_txn_logs_.size()]->Log(TxnType::kDelTag, txn);
+    }
+
+    {
+      chi::ScopedCoRwWriteLock lock(tag_map_lock_);
+      tag_id_to_info_.erase(tag_id);
+    }
+    MarkTagDirty(tag_id);
+
+    // Success
+    task->return_code_ = 0;
+    HLOG(kDebug,
+         "DelTag successful: tag_id={},{}, removed {} blobs, total_size={}",
+         tag_id.major_, tag_id.minor_, blob_count, total_size);
+
+  } catch (const std::exception &e) {
+    task->return_code_ = 1;
+  }
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+chi::TaskResume Runtime::GetTagSize(hipc::FullPtr<GetTagSizeTask> task,
+                                    chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  try {
+    TagId tag_id = task->tag_id_;
+
+    // Find the tag
+    chi::ScopedCoRwWriteLock lock(tag_map_lock_);
+    TagInfo *tag_info_ptr = tag_id_to_info_.find(tag_id);
+    if (tag_info_ptr == nullptr) {
+      task->return_code_ = 1;  // Tag not found
+      task->tag_size_ = 0;
+      CHI_CO_RETURN;
+    }
+
+    // Update timestamp and return the total size
+    auto now = GetCurrentTimeNs();
+    tag_info_ptr->last_read_ = now;
+
+    task->tag_size_ = tag_info_ptr->total_size_;
+    task->return_code_ = 0;
+
+    // Log telemetry for GetTagSize operation
+    LogTelemetry(CteOp::kGetTagSize, 0, tag_info_ptr->total_size_, tag_id,
+                 tag_info_ptr->last_modified_, now);
+
+    HLOG(kDebug, "GetTagSize successful: tag_id={},{}, total_size={}",
+         tag_id.major_, tag_id.minor_, task->tag_size_);
+
+  } catch (const std::exception &e) {
+    task->return_code_ = 1;
+    task->tag_size_ = 0;
   }
   CHI_CO_RETURN;
   CHI_TASK_BODY_END
@@ -1462,422 +2679,4029 @@ chi::TaskResume Runtime::GetTagSize(hipc::FullPtr<GetTagSizeTask> task,
 // Private helper methods
 const Config &Runtime::GetConfig() const { return config_; }
 
-float Runtime::GetManualScoreForTarget(const std::string &target_name) {
-  // Check if the target name matches a configured storage device with manual
-  // score
-  for (size_t i = 0; i < storage_devices_.size(); ++i) {
-    const auto &device = storage_devices_[i];
+float Runtime::GetManualScoreForTarget(const std::string &target_name) {
+  // Check if the target name matches a configured storage device with manual
+  // score
+  for (size_t i = 0; i < storage_devices_.size(); ++i) {
+    const auto &device = storage_devices_[i];
+
+    // Create the expected target name based on how targets are registered
+    std::string expected_target_name = "storage_device_" + std::to_string(i);
+
+    // Check if target name matches:
+    // 1. Exact match with "storage_device_N"
+    // 2. Exact match with device path
+    // 3. Starts with device path (to handle "_nodeX" suffix added during
+    // registration)
+    if (target_name == expected_target_name || target_name == device.path_ ||
+        (target_name.rfind(device.path_, 0) == 0 &&
+         (target_name.size() == device.path_.size() ||
+          target_name[device.path_.size()] == '_'))) {
+      return device.score_;  // Return configured score (-1.0f if not set)
+    }
+  }
+
+  return -1.0f;  // No manual score configured for this target
+}
+
+chimaera::bdev::PersistenceLevel Runtime::GetPersistenceLevelForTarget(
+    const std::string &target_name) {
+  for (size_t i = 0; i < storage_devices_.size(); ++i) {
+    const auto &device = storage_devices_[i];
+    std::string expected_target_name = "storage_device_" + std::to_string(i);
+    if (target_name == expected_target_name || target_name == device.path_ ||
+        (target_name.rfind(device.path_, 0) == 0 &&
+         (target_name.size() == device.path_.size() ||
+          target_name[device.path_.size()] == '_'))) {
+      // Convert string persistence level to enum
+      if (device.persistence_level_ == "temporary") {
+        return chimaera::bdev::PersistenceLevel::kTemporaryNonVolatile;
+      } else if (device.persistence_level_ == "long_term") {
+        return chimaera::bdev::PersistenceLevel::kLongTerm;
+      }
+      return chimaera::bdev::PersistenceLevel::kVolatile;
+    }
+  }
+  return chimaera::bdev::PersistenceLevel::kVolatile;
+}
+
+int Runtime::GetNumaNodeForTarget(const std::string &target_name) {
+  for (size_t i = 0; i < storage_devices_.size(); ++i) {
+    const auto &device = storage_devices_[i];
+    std::string expected_target_name = "storage_device_" + std::to_string(i);
+    if (target_name == expected_target_name || target_name == device.path_ ||
+        (target_name.rfind(device.path_, 0) == 0 &&
+         (target_name.size() == device.path_.size() ||
+          target_name[device.path_.size()] == '_'))) {
+      if (device.numa_node_ >= 0) {
+        return device.numa_node_;
+      }
+      // Memory tiers have no device to look up
+      if (device.bdev_type_ == "ram" || device.bdev_type_ == "hbm" ||
+          device.bdev_type_ == "pinned" || device.bdev_type_ == "noop") {
+        return -1;
+      }
+      return hshm::SystemInfo::GetPathNumaNode(device.path_);
+    }
+  }
+  return -1;
+}
+
+void Runtime::PreferLocalTargets(std::vector<TargetInfo> &targets,
+                                 std::vector<chi::u64> *planned_sizes) const {
+  if (numa_node_ < 0 || targets.size() < 2) {
+    return;
+  }
+  // Within each run of same-tier targets, this socket's targets go first
+  std::vector<size_t> order(targets.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  size_t run_begin = 0;
+  while (run_begin < targets.size()) {
+    size_t run_end = run_begin + 1;
+    while (run_end < targets.size() &&
+           targets[run_end].bdev_type_ == targets[run_begin].bdev_type_) {
+      ++run_end;
+    }
+    std::stable_partition(
+        order.begin() + run_begin, order.begin() + run_end,
+        [&](size_t idx) { return targets[idx].numa_node_ == numa_node_; });
+    run_begin = run_end;
+  }
+  std::vector<TargetInfo> sorted;
+  sorted.reserve(targets.size());
+  for (size_t idx : order) {
+    sorted.push_back(targets[idx]);
+  }
+  targets = std::move(sorted);
+  if (planned_sizes != nullptr && planned_sizes->size() == order.size()) {
+    std::vector<chi::u64> sizes;
+    sizes.reserve(order.size());
+    for (size_t idx : order) {
+      sizes.push_back((*planned_sizes)[idx]);
+    }
+    *planned_sizes = std::move(sizes);
+  }
+}
+
+TagId Runtime::GetOrAssignTagId(const std::string &tag_name,
+                                const TagId &preferred_id) {
+  chi::ScopedCoRwWriteLock write_lock(tag_map_lock_);
+
+  // Check if tag already exists
+  TagId *existing_tag_id_ptr = tag_name_to_id_.find(tag_name);
+  if (existing_tag_id_ptr != nullptr) {
+    return *existing_tag_id_ptr;
+  }
+
+  // Assign new tag ID
+  TagId tag_id;
+  if ((preferred_id.major_ != 0 || preferred_id.minor_ != 0) &&
+      !tag_id_to_info_.contains(preferred_id)) {
+    tag_id = preferred_id;
+  } else {
+    tag_id = GenerateNewTagId();
+  }
+
+  // Create tag info (use default constructor, allocator not used in struct)
+  TagInfo tag_info;
+  tag_info.tag_name_ = tag_name;
+  tag_info.tag_id_ = tag_id;
+
+  // Store mappings
+  tag_name_to_id_.insert_or_assign(tag_name, tag_id);
+  tag_id_to_info_.insert_or_assign(tag_id, tag_info);
+  MarkTagDirty(tag_id);
+
+  // WAL: log tag creation
+  if (!tag_txn_logs_.empty()) {
+    chi::u32 wid = CHI_CUR_WORKER->GetWorkerStats().worker_id_;
+    TxnCreateTag txn;
+    txn.tag_name_ = tag_name;
+    txn.tag_major_ = tag_id.major_;
+    txn.tag_minor_ = tag_id.minor_;
+    tag_txn_logs_[wid % tag_txn_logs_.size()]->Log(TxnType::kCreateTag, txn);
+  }
+
+  return tag_id;
+}
+
+chi::TaskResume Runtime::FlushMetadata(hipc::FullPtr<FlushMetadataTask> task,
+                                       chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  task->entries_flushed_ = 0;
+
+  const std::string &log_path = config_.performance_.metadata_log_path_;
+  if (log_path.empty()) {
+    task->return_code_ = 0;
+    CHI_CO_RETURN;
+  }
+  // The image is written off the worker, so a second flush could start
+  // meanwhile; it would race on the same files. Its entries stay marked.
+  if (flush_running_.exchange(true)) {
+    task->return_code_ = 0;
+    CHI_CO_RETURN;
+  }
+
+  try {
+    namespace fs = std::filesystem;
+    fs::create_directories(fs::path(log_path).parent_path());
+
+    // Everything marked so far is covered by whichever image is written
+    // next. Entries changed while it is written stay marked for the next
+    // checkpoint; applying them twice on restore is harmless.
+    std::vector<std::string> blob_keys;
+    std::vector<TagId> tag_ids;
+    dirty_metadata_.Drain(blob_keys, tag_ids);
+    bool policies_dirty = tag_policy_dirty_.exchange(false);
+
+    std::vector<chi::u64> deltas = MetadataCheckpoint::ListDeltas(log_path);
+    if (!deltas.empty()) {
+      next_delta_seq_ = std::max(next_delta_seq_, deltas.back() + 1);
+    }
+    bool compact = !checkpoint_base_written_ ||
+                   deltas.size() >= config_.performance_.metadata_compact_deltas_;
+
+    // Serialize on the worker, which owns the metadata maps; only the file
+    // write and fsync go to the blocking pool
+    chi::u64 entries = 0;
+    bool written = true;
+    std::string image_path;
+    std::ostringstream image;
+    if (compact) {
+      // Compaction: fold the deltas into a fresh base image
+      SerializeBaseImage(image, entries);
+      image_path = log_path;
+    } else if (!blob_keys.empty() || !tag_ids.empty() || policies_dirty) {
+      SerializeDeltaImage(image, blob_keys, tag_ids, entries);
+      image_path = MetadataCheckpoint::DeltaPath(log_path, next_delta_seq_);
+    }
+    if (!image_path.empty()) {
+      std::string bytes = std::move(image).str();
+      CHI_CO_AWAIT(chi::RunBlocking([&]() {
+        written = MetadataCheckpoint::Write(image_path, bytes);
+        if (written && compact) {
+          MetadataCheckpoint::RemoveDeltas(log_path, deltas);
+        }
+      }));
+      if (written && compact) {
+        checkpoint_base_written_ = true;
+        // Compaction loaded every deferred tag into the new image
+        if (tag_blob_name_to_info_.NumDeferredTags() == 0) {
+          base_image_.reset();
+        }
+      } else if (written) {
+        ++next_delta_seq_;
+      }
+    }
+    task->entries_flushed_ = static_cast<chi::u32>(entries);
+
+    if (!written) {
+      // Keep the drained entries for the next attempt
+      for (const auto &key : blob_keys) dirty_metadata_.MarkBlob(key);
+      for (const auto &tag_id : tag_ids) dirty_metadata_.MarkTag(tag_id);
+      if (policies_dirty) tag_policy_dirty_.store(true);
+      HLOG(kError, "FlushMetadata: Failed to write checkpoint to {}",
+           log_path);
+      task->return_code_ = 1;
+      flush_running_.store(false);
+      CHI_CO_RETURN;
+    }
+
+    CHI_CO_AWAIT(
+        chi::RunBlocking([this]() { TruncateCoveredTransactionLogs(); }));
+
+    task->return_code_ = 0;
+    HLOG(kDebug, "FlushMetadata: Flushed {} entries to {} ({})",
+         task->entries_flushed_, log_path, compact ? "base" : "delta");
+  } catch (const std::exception &e) {
+    HLOG(kError, "FlushMetadata: Exception: {}", e.what());
+    task->return_code_ = 99;
+  }
+  flush_running_.store(false);
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+void Runtime::MarkBlobDirty(const TagId &tag_id,
+                            const std::string &blob_name) {
+  if (blob_meta_) {
+    blob_meta_->Invalidate(tag_id, blob_name);
+  }
+  bool migrating = migration_active_.load(std::memory_order_acquire);
+  if (dirty_metadata_.IsEnabled() || migrating) {
+    std::string key = BlobMetadataIndex::MakeKey(tag_id, blob_name);
+    dirty_metadata_.MarkBlob(key);
+    if (migrating) {
+      migration_dirty_.MarkBlob(key);
+    }
+  }
+}
+
+void Runtime::PublishBlobMeta(const TagId &tag_id,
+                              const std::string &blob_name,
+                              const BlobMetaTable::Ticket &ticket,
+                              const BlobInfo &blob_info) {
+  // Clients route to the primary; a replica's copy may lag behind it
+  if (!blob_meta_ ||
+      IsReplicaCopy(tag_id, blob_name, GetTagReplicas(tag_id))) {
+    return;
+  }
+  BlobMetaTable::Entry entry;
+  entry.size_ = blob_info.GetLogicalSize();
+  entry.score_ = blob_info.score_;
+  blob_meta_->Publish(tag_id, blob_name, ticket, entry);
+}
+
+void Runtime::MarkTagDirty(const TagId &tag_id) {
+  dirty_metadata_.MarkTag(tag_id);
+  if (migration_active_.load(std::memory_order_acquire)) {
+    migration_dirty_.MarkTag(tag_id);
+  }
+  if (leases_) {
+    leases_->Revoke(tag_id);
+  }
+}
+
+std::unordered_map<chi::PoolId, chi::PoolQuery>
+Runtime::SnapshotTargetQueries() {
+  std::unordered_map<chi::PoolId, chi::PoolQuery> queries;
+  chi::ScopedCoRwReadLock target_read_lock(target_lock_);
+  registered_targets_.for_each(
+      [&](const chi::PoolId &target_id, const TargetInfo &info) {
+        queries[target_id] = info.target_query_;
+      });
+  return queries;
+}
+
+void Runtime::WriteHashIdEntry(std::ostream &os) const {
+  uint8_t entry_type = static_cast<uint8_t>(CheckpointEntry::kHashId);
+  uint32_t hash_id = static_cast<uint32_t>(blob_hash_id_);
+  os.write(reinterpret_cast<const char *>(&entry_type), sizeof(entry_type));
+  os.write(reinterpret_cast<const char *>(&hash_id), sizeof(hash_id));
+}
+
+void Runtime::WritePackSegmentsEntry(std::ostream &os) {
+  std::vector<std::pair<chi::PoolId, std::pair<chi::u64, chi::u64>>> segments;
+  {
+    hshm::ScopedMutex guard(pack_lock_, 0);
+    pack_segments_.ForEach([&segments](chi::u64, const PackSegment &seg) {
+      segments.push_back({seg.target_id_, {seg.base_, seg.size_}});
+    });
+  }
+  uint8_t entry_type = static_cast<uint8_t>(CheckpointEntry::kPackSegments);
+  uint32_t count = static_cast<uint32_t>(segments.size());
+  os.write(reinterpret_cast<const char *>(&entry_type), sizeof(entry_type));
+  os.write(reinterpret_cast<const char *>(&count), sizeof(count));
+  for (const auto &seg : segments) {
+    chi::u32 bdev_major = seg.first.major_;
+    chi::u32 bdev_minor = seg.first.minor_;
+    os.write(reinterpret_cast<const char *>(&bdev_major), sizeof(bdev_major));
+    os.write(reinterpret_cast<const char *>(&bdev_minor), sizeof(bdev_minor));
+    os.write(reinterpret_cast<const char *>(&seg.second.first),
+             sizeof(seg.second.first));
+    os.write(reinterpret_cast<const char *>(&seg.second.second),
+             sizeof(seg.second.second));
+  }
+}
+
+void Runtime::WriteTagPoliciesEntry(std::ostream &os) {
+  std::unordered_set<TagId> tag_ids;
+  {
+    chi::ScopedCoRwReadLock lock(replication_lock_);
+    for (const auto &entry : tag_replicas_) tag_ids.insert(entry.first);
+  }
+  {
+    chi::ScopedCoRwReadLock lock(placement_lock_);
+    for (const auto &entry : tag_placement_) tag_ids.insert(entry.first);
+  }
+  {
+    chi::ScopedCoRwReadLock lock(dedup_lock_);
+    for (const auto &entry : tag_dedup_) tag_ids.insert(entry.first);
+  }
+  uint8_t entry_type = static_cast<uint8_t>(CheckpointEntry::kTagPolicies);
+  uint32_t count = static_cast<uint32_t>(tag_ids.size());
+  os.write(reinterpret_cast<const char *>(&entry_type), sizeof(entry_type));
+  os.write(reinterpret_cast<const char *>(&count), sizeof(count));
+  for (const auto &tag_id : tag_ids) {
+    TxnTagPolicy txn = GetTagPolicy(tag_id);
+    for (chi::u32 value :
+         {txn.tag_major_, txn.tag_minor_, txn.replicas_,
+          txn.placement_policy_, txn.stripe_pages_, txn.pin_container_,
+          txn.follow_major_, txn.follow_minor_}) {
+      os.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+    os.write(reinterpret_cast<const char *>(&txn.dedup_chunk_),
+             sizeof(txn.dedup_chunk_));
+  }
+}
+
+void Runtime::WriteTagEntry(std::ostream &os, const TagId &tag_id,
+                            const TagInfo &info) {
+  uint8_t entry_type = static_cast<uint8_t>(CheckpointEntry::kTag);
+  uint32_t name_len = static_cast<uint32_t>(info.tag_name_.size());
+  chi::u64 total_size = info.total_size_;
+  os.write(reinterpret_cast<const char *>(&entry_type), sizeof(entry_type));
+  os.write(reinterpret_cast<const char *>(&name_len), sizeof(name_len));
+  os.write(info.tag_name_.data(), name_len);
+  os.write(reinterpret_cast<const char *>(&tag_id), sizeof(tag_id));
+  os.write(reinterpret_cast<const char *>(&total_size), sizeof(total_size));
+}
+
+void Runtime::WriteBlobEntry(
+    std::ostream &os, const std::string &key, const BlobInfo &blob_info,
+    const std::unordered_map<chi::PoolId, chi::PoolQuery> &queries) {
+  CheckpointEntry kind = CheckpointEntry::kBlob;
+  if (blob_info.IsStub()) {
+    kind = CheckpointEntry::kBlobStub;
+  } else if (blob_info.IsErasureCoded()) {
+    kind = CheckpointEntry::kBlobErasure;
+  } else if (blob_info.IsEncrypted()) {
+    kind = CheckpointEntry::kBlobEncrypted;
+  }
+  uint8_t entry_type = static_cast<uint8_t>(kind);
+  uint32_t key_len = static_cast<uint32_t>(key.size());
+  uint32_t blob_name_len = static_cast<uint32_t>(blob_info.blob_name_.size());
+  float score = blob_info.score_;
+  int32_t compress_lib = blob_info.compress_lib_;
+  int32_t compress_preset = blob_info.compress_preset_;
+  chi::u64 trace_key = blob_info.trace_key_;
+  uint32_t num_blocks = static_cast<uint32_t>(blob_info.blocks_.size());
+
+  os.write(reinterpret_cast<const char *>(&entry_type), sizeof(entry_type));
+  os.write(reinterpret_cast<const char *>(&key_len), sizeof(key_len));
+  os.write(key.data(), key_len);
+  os.write(reinterpret_cast<const char *>(&blob_name_len),
+           sizeof(blob_name_len));
+  os.write(blob_info.blob_name_.data(), blob_name_len);
+  os.write(reinterpret_cast<const char *>(&score), sizeof(score));
+  os.write(reinterpret_cast<const char *>(&compress_lib),
+           sizeof(compress_lib));
+  os.write(reinterpret_cast<const char *>(&compress_preset),
+           sizeof(compress_preset));
+  os.write(reinterpret_cast<const char *>(&trace_key), sizeof(trace_key));
+  os.write(reinterpret_cast<const char *>(&num_blocks), sizeof(num_blocks));
+
+  // Write per-block data
+  for (const auto &block : blob_info.blocks_) {
+    chi::u32 bdev_major = block.target_id_.major_;
+    chi::u32 bdev_minor = block.target_id_.minor_;
+    os.write(reinterpret_cast<const char *>(&bdev_major), sizeof(bdev_major));
+    os.write(reinterpret_cast<const char *>(&bdev_minor), sizeof(bdev_minor));
+
+    // Write target_query as raw bytes (POD-like struct)
+    chi::PoolQuery target_query;
+    auto it = queries.find(block.target_id_);
+    if (it != queries.end()) {
+      target_query = it->second;
+    }
+    os.write(reinterpret_cast<const char *>(&target_query),
+             sizeof(chi::PoolQuery));
+
+    chi::u64 offset = block.target_offset_;
+    chi::u64 size = block.size_;
+    os.write(reinterpret_cast<const char *>(&offset), sizeof(offset));
+    os.write(reinterpret_cast<const char *>(&size), sizeof(size));
+  }
+
+  // Stubs keep the source range their bytes are faulted in from
+  if (blob_info.IsStub()) {
+    uint32_t path_len = static_cast<uint32_t>(blob_info.stub_path_.size());
+    os.write(reinterpret_cast<const char *>(&path_len), sizeof(path_len));
+    os.write(blob_info.stub_path_.data(), path_len);
+    os.write(reinterpret_cast<const char *>(&blob_info.stub_offset_),
+             sizeof(blob_info.stub_offset_));
+    os.write(reinterpret_cast<const char *>(&blob_info.stub_size_),
+             sizeof(blob_info.stub_size_));
+    os.write(reinterpret_cast<const char *>(&blob_info.stub_flags_),
+             sizeof(blob_info.stub_flags_));
+  } else if (blob_info.IsErasureCoded()) {
+    os.write(reinterpret_cast<const char *>(&blob_info.erasure_data_),
+             sizeof(blob_info.erasure_data_));
+    os.write(reinterpret_cast<const char *>(&blob_info.erasure_parity_),
+             sizeof(blob_info.erasure_parity_));
+    os.write(reinterpret_cast<const char *>(&blob_info.erasure_shard_),
+             sizeof(blob_info.erasure_shard_));
+    os.write(reinterpret_cast<const char *>(&blob_info.erasure_size_),
+             sizeof(blob_info.erasure_size_));
+  } else if (blob_info.IsEncrypted()) {
+    os.write(reinterpret_cast<const char *>(&blob_info.encrypt_chunk_),
+             sizeof(blob_info.encrypt_chunk_));
+    os.write(reinterpret_cast<const char *>(&blob_info.encrypt_size_),
+             sizeof(blob_info.encrypt_size_));
+  }
+}
+
+void Runtime::SerializeBaseImage(std::ostream &ofs, chi::u64 &entries) {
+  WriteHashIdEntry(ofs);
+  WritePackSegmentsEntry(ofs);
+  WriteTagPoliciesEntry(ofs);
+
+  tag_id_to_info_.for_each([&](const TagId &id, const TagInfo &info) {
+    WriteTagEntry(ofs, id, info);
+    entries++;
+  });
+
+  // Blobs are written tag by tag behind a tag index, so a restart can
+  // attach the image and load each tag only when it is first touched. The
+  // blob index locks one shard at a time, so writers on other shards
+  // proceed while the image is written.
+  tag_blob_name_to_info_.MaterializeAll();
+  auto queries = SnapshotTargetQueries();
+  auto no_shared_blocks = [this]() {
+    hshm::ScopedMutex guard(block_refs_lock_, 0);
+    return block_refs_.empty();
+  };
+  CheckpointTagIndex index;
+  bool unshared = no_shared_blocks();
+  index.blobs_begin_ = static_cast<chi::u64>(ofs.tellp());
+  for (const TagId &tag_id : tag_blob_name_to_info_.ListTags()) {
+    std::ostringstream section;
+    tag_blob_name_to_info_.ForEachTagEntry(
+        tag_id, [&](const std::string &blob_name, const BlobInfo &blob_info) {
+          WriteBlobEntry(section, BlobMetadataIndex::MakeKey(tag_id, blob_name),
+                         blob_info, queries);
+          entries++;
+        });
+    index.AddSection(ofs, tag_id, std::move(section).str());
+  }
+  // A link made while the image was written may span two sections
+  if (unshared && no_shared_blocks()) {
+    index.flags_ |= CheckpointTagIndex::kNoSharedBlocks;
+  }
+  index.Write(ofs);
+}
+
+void Runtime::SerializeDeltaImage(std::ostream &ofs,
+                                  const std::vector<std::string> &blob_keys,
+                                  const std::vector<TagId> &tag_ids,
+                                  chi::u64 &entries) {
+  WriteHashIdEntry(ofs);
+  WritePackSegmentsEntry(ofs);
+  WriteTagPoliciesEntry(ofs);
+
+  // Tags first: a tag tombstone drops the tag's blobs, and blob entries
+  // that follow re-add any that were written after it was recreated
+  for (const auto &tag_id : tag_ids) {
+    TagInfo info;
+    bool found = false;
+    {
+      chi::ScopedCoRwReadLock lock(tag_map_lock_);
+      TagInfo *info_ptr = tag_id_to_info_.find(tag_id);
+      if (info_ptr != nullptr) {
+        info = *info_ptr;
+        found = true;
+      }
+    }
+    if (found) {
+      WriteTagEntry(ofs, tag_id, info);
+    } else {
+      uint8_t entry_type = static_cast<uint8_t>(CheckpointEntry::kDelTag);
+      ofs.write(reinterpret_cast<const char *>(&entry_type),
+                sizeof(entry_type));
+      ofs.write(reinterpret_cast<const char *>(&tag_id), sizeof(tag_id));
+    }
+    entries++;
+  }
+
+  auto queries = SnapshotTargetQueries();
+  for (const auto &key : blob_keys) {
+    TagId tag_id;
+    std::string blob_name;
+    if (!BlobMetadataIndex::ParseKey(key, tag_id, blob_name)) {
+      continue;
+    }
+    BlobInfo *blob_info = tag_blob_name_to_info_.Find(tag_id, blob_name);
+    if (blob_info != nullptr) {
+      WriteBlobEntry(ofs, key, *blob_info, queries);
+    } else {
+      uint8_t entry_type = static_cast<uint8_t>(CheckpointEntry::kDelBlob);
+      uint32_t key_len = static_cast<uint32_t>(key.size());
+      ofs.write(reinterpret_cast<const char *>(&entry_type),
+                sizeof(entry_type));
+      ofs.write(reinterpret_cast<const char *>(&key_len), sizeof(key_len));
+      ofs.write(key.data(), key_len);
+    }
+    entries++;
+  }
+}
+
+void Runtime::TruncateCoveredTransactionLogs() {
+  if (blob_txn_logs_.empty()) {
+    return;
+  }
+  chi::u64 total_wal_size = 0;
+  for (auto &log : blob_txn_logs_) {
+    if (log) {
+      log->Sync();
+      total_wal_size += log->Size();
+    }
+  }
+  for (auto &log : tag_txn_logs_) {
+    if (log) {
+      log->Sync();
+      total_wal_size += log->Size();
+    }
+  }
+  if (total_wal_size > config_.performance_.transaction_log_capacity_bytes_) {
+    for (auto &log : blob_txn_logs_) {
+      if (log) log->Truncate();
+    }
+    for (auto &log : tag_txn_logs_) {
+      if (log) log->Truncate();
+    }
+    HLOG(kDebug, "FlushMetadata: Truncated WAL files (was {} bytes)",
+         total_wal_size);
+  }
+}
+
+chi::TaskResume Runtime::CommitTransactionLogs(
+    hipc::FullPtr<CommitTransactionLogsTask> task, chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  // Group commit is a write plus fdatasync per log; the logs are locked,
+  // so the pool thread may sync them while workers keep appending
+  chi::u32 committed = 0;
+  CHI_CO_AWAIT(chi::RunBlocking([&]() {
+    for (auto *logs : {&blob_txn_logs_, &tag_txn_logs_}) {
+      for (auto &log : *logs) {
+        if (log && log->HasPending()) {
+          log->Sync();
+          committed++;
+        }
+      }
+    }
+  }));
+  task->logs_committed_ = committed;
+  task->return_code_ = 0;
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+chi::TaskResume Runtime::SetTagReplication(
+    hipc::FullPtr<SetTagReplicationTask> task, chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  {
+    chi::ScopedCoRwWriteLock lock(replication_lock_);
+    if (task->replicas_ <= 1) {
+      tag_replicas_.erase(task->tag_id_);
+    } else {
+      tag_replicas_[task->tag_id_] = task->replicas_;
+    }
+  }
+  LogTagPolicy(task->tag_id_);
+  // Existing blobs of the tag get their copies on the next repair pass
+  replica_rescan_.store(true);
+  task->return_code_ = 0;
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+chi::TaskResume Runtime::SetTagPlacement(
+    hipc::FullPtr<SetTagPlacementTask> task, chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  {
+    chi::ScopedCoRwWriteLock lock(placement_lock_);
+    if (task->placement_.IsDefault()) {
+      tag_placement_.erase(task->tag_id_);
+    } else {
+      tag_placement_[task->tag_id_] = task->placement_;
+    }
+  }
+  LogTagPolicy(task->tag_id_);
+  // Blobs the tag already has are moved to their new containers
+  rebalance_pending_.store(true);
+  task->return_code_ = 0;
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+chi::TaskResume Runtime::SetTagDedup(hipc::FullPtr<SetTagDedupTask> task,
+                                     chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  // Each stored chunk is its own allocation, so chunks are kept to whole
+  // bdev allocation units
+  if (task->chunk_size_ % kDedupChunkUnit != 0) {
+    task->return_code_ = 1;
+    CHI_CO_RETURN;
+  }
+  {
+    chi::ScopedCoRwWriteLock lock(dedup_lock_);
+    if (task->chunk_size_ == 0) {
+      tag_dedup_.erase(task->tag_id_);
+    } else {
+      tag_dedup_[task->tag_id_] = task->chunk_size_;
+    }
+  }
+  LogTagPolicy(task->tag_id_);
+  // Blobs already stored are only deduplicated when rewritten
+  task->return_code_ = 0;
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+chi::TaskResume Runtime::SetTagTtl(hipc::FullPtr<SetTagTtlTask> task,
+                                   chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  {
+    chi::ScopedCoRwWriteLock lock(ttl_lock_);
+    if (task->ttl_ms_ == 0) {
+      tag_ttl_.erase(task->tag_id_);
+    } else {
+      tag_ttl_[task->tag_id_] = task->ttl_ms_;
+    }
+  }
+  // Blobs already stored keep their deadline until rewritten
+  task->return_code_ = 0;
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+chi::TaskResume Runtime::SetTagErasure(
+    hipc::FullPtr<SetTagErasureTask> task, chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  chi::u32 data_shards = task->data_shards_;
+  chi::u32 parity_shards = task->parity_shards_;
+  if (data_shards != 0 &&
+      (parity_shards == 0 ||
+       data_shards + parity_shards > ErasureCode::kMaxShards)) {
+    task->return_code_ = 1;
+    CHI_CO_RETURN;
+  }
+  // Sealed chunks are not sharded; a tag is encrypted or coded, not both
+  if (data_shards != 0 && GetTagEncryptChunk(task->tag_id_) != 0) {
+    task->return_code_ = 2;
+    CHI_CO_RETURN;
+  }
+  {
+    chi::ScopedCoRwWriteLock lock(erasure_lock_);
+    if (data_shards == 0) {
+      tag_erasure_.erase(task->tag_id_);
+    } else {
+      tag_erasure_[task->tag_id_] = std::make_pair(data_shards, parity_shards);
+    }
+  }
+  // Blobs already stored keep their layout until they are rewritten
+  task->return_code_ = 0;
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+chi::TaskResume Runtime::SetTagEncryption(
+    hipc::FullPtr<SetTagEncryptionTask> task, chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  chi::u32 chunk_size = task->chunk_size_;
+  if (chunk_size != 0) {
+#if HSHM_ENABLE_ENCRYPT
+    bool have_key = cipher_.HasKey();
+#else
+    bool have_key = false;
+#endif
+    if (!have_key) {
+      task->return_code_ = 1;
+      CHI_CO_RETURN;
+    }
+    chi::u32 data_shards = 0;
+    chi::u32 parity_shards = 0;
+    GetTagErasure(task->tag_id_, data_shards, parity_shards);
+    if (data_shards != 0) {
+      task->return_code_ = 2;
+      CHI_CO_RETURN;
+    }
+    if (chunk_size > kMaxEncryptChunk) {
+      task->return_code_ = 3;
+      CHI_CO_RETURN;
+    }
+  }
+  {
+    chi::ScopedCoRwWriteLock lock(encrypt_lock_);
+    if (chunk_size == 0) {
+      tag_encrypt_.erase(task->tag_id_);
+    } else {
+      tag_encrypt_[task->tag_id_] = chunk_size;
+    }
+  }
+  // Blobs already stored stay as they are until they are rewritten
+  task->return_code_ = 0;
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+chi::TaskResume Runtime::SpliceBlobs(hipc::FullPtr<SpliceBlobsTask> task,
+                                     chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  task->blobs_linked_ = 0;
+  task->blobs_copied_ = 0;
+  TagId src_tag_id = task->src_tag_id_;
+  TagId dst_tag_id = task->dst_tag_id_;
+  if (src_tag_id.IsNull() || dst_tag_id.IsNull() || src_tag_id == dst_tag_id) {
+    task->return_code_ = 1;
+    CHI_CO_RETURN;
+  }
+  std::shared_ptr<const NamePattern> pattern;
+  try {
+    pattern = NamePattern::Get(task->blob_regex_.str());
+  } catch (const std::regex_error &e) {
+    HLOG(kError, "SpliceBlobs: invalid blob pattern: {}", e.what());
+    task->return_code_ = 2;
+    CHI_CO_RETURN;
+  }
+
+  // Primary copies only; collected first since linking writes the index
+  std::vector<std::string> blob_names;
+  chi::u32 replicas = GetTagReplicas(src_tag_id);
+  tag_blob_name_to_info_.ForEachTagBlob(
+      src_tag_id, pattern->GetPrefix(), [&](const std::string &blob_name) {
+        if (pattern->Match(blob_name) &&
+            !IsReplicaCopy(src_tag_id, blob_name, replicas)) {
+          blob_names.push_back(blob_name);
+        }
+        return true;
+      });
+
+  auto *ipc_manager = CHI_IPC;
+  for (const std::string &blob_name : blob_names) {
+    std::vector<chi::ContainerId> owners =
+        GetBlobReplicas(dst_tag_id, blob_name, 1);
+    if (owners.empty() || IsLocalContainer(owners[0])) {
+      if (LinkBlob(src_tag_id, dst_tag_id, blob_name)) {
+        task->blobs_linked_++;
+      }
+      continue;
+    }
+
+    // Another container owns the new name (the destination tag does not
+    // follow the source): copy the data there
+    BlobInfo *blob_info_ptr = tag_blob_name_to_info_.Find(src_tag_id, blob_name);
+    if (!blob_info_ptr || blob_info_ptr->GetTotalSize() == 0) {
+      continue;
+    }
+    BlobInfo layout;
+    layout.blocks_ = blob_info_ptr->blocks_;
+    layout.CopyErasureLayout(*blob_info_ptr);
+    float score = blob_info_ptr->score_;
+    chi::u64 size = layout.GetLogicalSize();
+    hipc::FullPtr<char> buffer = ipc_manager->AllocateBuffer(size);
+    if (buffer.IsNull()) {
+      continue;
+    }
+    hipc::ShmPtr<> shm_ptr(buffer.shm_);
+    chi::u32 read_error = 0;
+    CHI_CO_AWAIT(ReadBlobData(layout, shm_ptr, size, 0, read_error));
+    if (read_error == 0) {
+      auto put_task = client_.AsyncPutBlob(
+          dst_tag_id, blob_name, 0, size, shm_ptr, score, Context(),
+          kPutBlobIfAbsent, chi::PoolQuery::DirectId(owners[0]));
+      CHI_CO_AWAIT(put_task);
+      if (put_task->GetReturnCode() == 0) {
+        task->blobs_copied_++;
+      }
+    }
+    ipc_manager->FreeBuffer(buffer);
+  }
+  HLOG(kDebug, "SpliceBlobs: linked {} and copied {} of {} blobs",
+       task->blobs_linked_, task->blobs_copied_, blob_names.size());
+  task->return_code_ = 0;
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+bool Runtime::LinkBlob(const TagId &src_tag_id, const TagId &dst_tag_id,
+                       const std::string &blob_name) {
+  BlobInfo *src_ptr = tag_blob_name_to_info_.Find(src_tag_id, blob_name);
+  if (!src_ptr || src_ptr->IsStub() ||
+      tag_blob_name_to_info_.Find(dst_tag_id, blob_name) != nullptr) {
+    return false;
+  }
+  // Snapshot the source before inserting, which may move it
+  BlobInfo source;
+  source.blocks_ = src_ptr->blocks_;
+  source.score_ = src_ptr->score_;
+  source.dirty_since_ = src_ptr->dirty_since_;
+  source.compress_lib_ = src_ptr->compress_lib_;
+  source.compress_preset_ = src_ptr->compress_preset_;
+  source.trace_key_ = src_ptr->trace_key_;
+  source.preallocated_size_ = src_ptr->preallocated_size_;
+  source.CopyErasureLayout(*src_ptr);
+
+  {
+    hshm::ScopedMutex guard(block_refs_lock_, 0);
+    for (const auto &block : source.blocks_) {
+      chi::u32 &refs = block_refs_[block];
+      refs = refs == 0 ? 2 : refs + 1;
+    }
+  }
+  BlobInfo *link_ptr = CreateNewBlob(blob_name, dst_tag_id, source.score_);
+  if (!link_ptr) {
+    return false;
+  }
+  link_ptr->blocks_ = source.blocks_;
+  link_ptr->dirty_since_ = source.dirty_since_;
+  link_ptr->compress_lib_ = source.compress_lib_;
+  link_ptr->compress_preset_ = source.compress_preset_;
+  link_ptr->trace_key_ = source.trace_key_;
+  link_ptr->preallocated_size_ = source.preallocated_size_;
+  link_ptr->CopyErasureLayout(source);
+  auto now = GetCurrentTimeNs();
+  link_ptr->last_modified_ = now;
+  StampExpiry(dst_tag_id, blob_name, *link_ptr, GetTagTtl(dst_tag_id), now);
+  LogBlobBlocks(dst_tag_id, blob_name, *link_ptr);
+  {
+    chi::ScopedCoRwReadLock lock(tag_map_lock_);
+    TagInfo *tag_info_ptr = tag_id_to_info_.find(dst_tag_id);
+    if (tag_info_ptr) {
+      tag_info_ptr->last_modified_ = now;
+      tag_info_ptr->total_size_ += link_ptr->GetLogicalSize();
+    }
+  }
+  MarkTagDirty(dst_tag_id);
+  UpdateWriteBackState(dst_tag_id, blob_name, *link_ptr);
+  return true;
+}
+
+void Runtime::SettleDeferredBlocks(const BlobInfo &blob_info) {
+  if (restart_blocks_.empty() ||
+      tag_blob_name_to_info_.NumDeferredTags() == 0) {
+    return;
+  }
+  for (const auto &block : blob_info.blocks_) {
+    if (restart_blocks_.count(block) != 0) {
+      tag_blob_name_to_info_.MaterializeAll();
+      return;
+    }
+  }
+}
+
+bool Runtime::IsBlobShared(const BlobInfo &blob_info) {
+  SettleDeferredBlocks(blob_info);
+  hshm::ScopedMutex guard(block_refs_lock_, 0);
+  if (block_refs_.empty()) {
+    return false;
+  }
+  for (const auto &block : blob_info.blocks_) {
+    if (block_refs_.count(block) > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Runtime::RebuildBlockRefs() {
+  // Deferred tags shared no block when their image was written; their
+  // blocks are counted by LoadDeferredTag against restart_blocks_
+  bool deferred = tag_blob_name_to_info_.NumDeferredTags() != 0;
+  std::unordered_map<BlobBlock, chi::u32, BlobBlockHash> refs;
+  tag_blob_name_to_info_.ForEachLoaded(
+      [&](const BlobKey &, const BlobInfo &blob_info) {
+        for (const auto &block : blob_info.blocks_) {
+          // Placeholders of lost erasure-code shards are nobody's extent
+          if (!block.target_id_.IsNull()) {
+            refs[block]++;
+          }
+        }
+      });
+  if (deferred) {
+    restart_blocks_.clear();
+    for (const auto &entry : refs) {
+      restart_blocks_.insert(entry.first);
+    }
+  }
+  for (auto it = refs.begin(); it != refs.end();) {
+    it = it->second < 2 ? refs.erase(it) : std::next(it);
+  }
+  if (!refs.empty()) {
+    HLOG(kInfo, "RebuildBlockRefs: {} blocks shared between blobs",
+         refs.size());
+  }
+  hshm::ScopedMutex guard(block_refs_lock_, 0);
+  block_refs_ = std::move(refs);
+}
+
+void Runtime::RebuildPackSegments() {
+  if (restored_pack_segments_.empty()) {
+    return;
+  }
+  // A segment is only freed once no blob references it, so every tag must
+  // be counted, including those an attached base image still defers
+  tag_blob_name_to_info_.MaterializeAll();
+  auto volatile_targets = SnapshotVolatileTargets();
+  hshm::ScopedMutex guard(pack_lock_, 0);
+  size_t restored = 0;
+  for (const auto &target : restored_pack_segments_) {
+    if (volatile_targets.count(target.first) != 0) {
+      continue;  // Lost with the target's contents
+    }
+    for (const auto &seg : target.second) {
+      pack_segments_.Restore(target.first, seg.first, seg.second);
+      restored++;
+    }
+  }
+  restored_pack_segments_.clear();
+  if (restored == 0) {
+    return;
+  }
+  tag_blob_name_to_info_.ForEachLoaded(
+      [&](const BlobKey &, const BlobInfo &blob_info) {
+        for (const auto &block : blob_info.blocks_) {
+          if (block.target_id_.IsNull() ||
+              !PackSegmentTable::IsPackedOffset(block.target_offset_)) {
+            continue;
+          }
+          chi::u64 seg_id = pack_segments_.Find(
+              block.target_id_, block.target_offset_, block.size_);
+          if (seg_id != 0) {
+            pack_segments_.Retain(seg_id, block.size_);
+          }
+        }
+      });
+  HLOG(kInfo, "RebuildPackSegments: Restored {} small-object segments",
+       restored);
+}
+
+chi::u64 Runtime::GetTagTtl(const TagId &tag_id) {
+  chi::ScopedCoRwReadLock lock(ttl_lock_);
+  auto it = tag_ttl_.find(tag_id);
+  return it != tag_ttl_.end() ? it->second : 0;
+}
+
+void Runtime::StampExpiry(const TagId &tag_id, const std::string &blob_name,
+                          BlobInfo &blob_info, chi::u64 ttl_ms,
+                          Timestamp now) {
+  if (ttl_ms == 0) {
+    return;
+  }
+  blob_info.expire_time_ = now + ttl_ms * 1000000ULL;
+  hshm::ScopedMutex guard(expiry_lock_, 0);
+  expiry_wheel_.Schedule(BlobKey(tag_id, blob_name), blob_info.expire_time_);
+}
+
+Context Runtime::KeepTtl(const BlobInfo &blob_info, Context ctx) {
+  if (blob_info.expire_time_ == 0) {
+    return ctx;
+  }
+  // Round up so the copy never expires early; at least 1ms if already due
+  Timestamp now = GetCurrentTimeNs();
+  Timestamp left =
+      blob_info.expire_time_ > now ? blob_info.expire_time_ - now : 0;
+  ctx.ttl_ms_ = std::max<chi::u64>((left + 999999ULL) / 1000000ULL, 1);
+  return ctx;
+}
+
+chi::u64 Runtime::GetTagDedupChunk(const TagId &tag_id) {
+  chi::ScopedCoRwReadLock lock(dedup_lock_);
+  auto it = tag_dedup_.find(tag_id);
+  return it != tag_dedup_.end() ? it->second : 0;
+}
+
+TxnTagPolicy Runtime::GetTagPolicy(const TagId &tag_id) {
+  TxnTagPolicy txn;
+  txn.tag_major_ = tag_id.major_;
+  txn.tag_minor_ = tag_id.minor_;
+  txn.replicas_ = 1;
+  {
+    chi::ScopedCoRwReadLock lock(replication_lock_);
+    auto it = tag_replicas_.find(tag_id);
+    if (it != tag_replicas_.end()) {
+      txn.replicas_ = it->second;
+    }
+  }
+  TagPlacement placement = GetTagPlacement(tag_id);
+  txn.placement_policy_ = static_cast<chi::u32>(placement.policy_);
+  txn.stripe_pages_ = placement.stripe_pages_;
+  txn.pin_container_ = placement.pin_container_;
+  txn.follow_major_ = placement.follow_tag_.major_;
+  txn.follow_minor_ = placement.follow_tag_.minor_;
+  txn.dedup_chunk_ = GetTagDedupChunk(tag_id);
+  return txn;
+}
+
+void Runtime::ApplyTagPolicy(const TxnTagPolicy &txn) {
+  TagId tag_id{txn.tag_major_, txn.tag_minor_};
+  {
+    chi::ScopedCoRwWriteLock lock(replication_lock_);
+    if (txn.replicas_ <= 1) {
+      tag_replicas_.erase(tag_id);
+    } else {
+      tag_replicas_[tag_id] = txn.replicas_;
+    }
+  }
+  TagPlacement placement(
+      static_cast<TagPlacementPolicy>(txn.placement_policy_),
+      txn.stripe_pages_);
+  placement.pin_container_ = txn.pin_container_;
+  placement.follow_tag_ = TagId{txn.follow_major_, txn.follow_minor_};
+  {
+    chi::ScopedCoRwWriteLock lock(placement_lock_);
+    if (placement.IsDefault()) {
+      tag_placement_.erase(tag_id);
+    } else {
+      tag_placement_[tag_id] = placement;
+    }
+  }
+  {
+    chi::ScopedCoRwWriteLock lock(dedup_lock_);
+    if (txn.dedup_chunk_ == 0) {
+      tag_dedup_.erase(tag_id);
+    } else {
+      tag_dedup_[tag_id] = txn.dedup_chunk_;
+    }
+  }
+}
+
+void Runtime::LogTagPolicy(const TagId &tag_id) {
+  // The policy maps are not part of any tag entry, so the next checkpoint
+  // is written even when no tag or blob is dirty
+  tag_policy_dirty_.store(true);
+  if (tag_txn_logs_.empty()) {
+    return;
+  }
+  size_t log = std::hash<TagId>{}(tag_id) % tag_txn_logs_.size();
+  tag_txn_logs_[log]->Log(TxnType::kSetTagPolicy, GetTagPolicy(tag_id));
+}
+
+chi::TaskResume Runtime::DedupWriteBlob(BlobInfo &blob_info,
+                                        hipc::ShmPtr<> blob_data,
+                                        chi::u64 size, chi::u64 chunk_size,
+                                        float blob_score,
+                                        int min_persistence_level,
+                                        chi::u32 qos_class,
+                                        chi::u32 &error_code) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  error_code = 0;
+  auto *ipc_manager = CHI_IPC;
+  hipc::FullPtr<char> data =
+      ipc_manager->ToFullPtr<char>(blob_data.template Cast<char>());
+  if (data.IsNull()) {
+    error_code = 21;
+    CHI_CO_RETURN;
+  }
+
+  // Chunks stored by this write, by fingerprint, so repeats within the
+  // blob are matched before their bytes reach the target
+  struct StoredChunk {
+    chi::u64 offset_;
+    BlobBlock block_;
+  };
+  std::unordered_map<chi::u64, StoredChunk> stored;
+  std::vector<std::pair<chi::u64, chi::u64>> write_runs;  // (offset, size)
+  hipc::FullPtr<char> verify;  // Bytes of an indexed candidate
+  chi::u64 hits = 0;
+  chi::u64 saved = 0;
+
+  for (chi::u64 off = 0; off < size; off += chunk_size) {
+    chi::u64 len = std::min(chunk_size, size - off);
+    const char *bytes = data.ptr_ + off;
+    chi::u64 fp = hshm::HashBytes(bytes, len);
+
+    // A repeat of an earlier chunk of this write is compared in memory
+    auto local = stored.find(fp);
+    if (local != stored.end() && local->second.block_.size_ == len &&
+        std::memcmp(data.ptr_ + local->second.offset_, bytes, len) == 0) {
+      {
+        hshm::ScopedMutex guard(block_refs_lock_, 0);
+        chi::u32 &refs = block_refs_[local->second.block_];
+        refs = refs == 0 ? 2 : refs + 1;
+      }
+      blob_info.blocks_.push_back(local->second.block_);
+      ++hits;
+      saved += len;
+      continue;
+    }
+
+    // An indexed extent is read back and compared, since fingerprints can
+    // collide. The reference is taken only if the entry is still there,
+    // i.e. the extent was neither freed nor rewritten meanwhile.
+    BlobBlock candidate;
+    bool indexed = false;
+    {
+      hshm::ScopedMutex guard(block_refs_lock_, 0);
+      auto it = dedup_index_.find(fp);
+      if (it != dedup_index_.end() && it->second.size_ == len) {
+        candidate = it->second;
+        indexed = true;
+      }
+    }
+    bool hit = false;
+    if (indexed) {
+      if (verify.IsNull()) {
+        verify = ipc_manager->AllocateBuffer(chunk_size);
+      }
+      if (!verify.IsNull()) {
+        BlobBlockList candidate_blocks(HSHM_MALLOC);
+        candidate_blocks.push_back(candidate);
+        chi::u32 read_result = 0;
+        CHI_CO_AWAIT(ReadData(candidate_blocks,
+                              verify.shm_.template Cast<void>(), len, 0,
+                              read_result, qos_class));
+        if (read_result == 0 && std::memcmp(verify.ptr_, bytes, len) == 0) {
+          hshm::ScopedMutex guard(block_refs_lock_, 0);
+          auto it = dedup_index_.find(fp);
+          if (it != dedup_index_.end() && it->second == candidate) {
+            chi::u32 &refs = block_refs_[candidate];
+            refs = refs == 0 ? 2 : refs + 1;
+            hit = true;
+          }
+        }
+      }
+    }
+    if (hit) {
+      blob_info.blocks_.push_back(candidate);
+      ++hits;
+      saved += len;
+      continue;
+    }
+
+    // Otherwise the chunk gets extents of its own. They are appended
+    // without merging so that each chunk's extent stays a unit of sharing.
+    BlobInfo chunk_layout;
+    chi::u32 alloc_result = 0;
+    CHI_CO_AWAIT(ExtendBlob(chunk_layout, 0, len, blob_score, alloc_result,
+                            min_persistence_level));
+    for (const auto &block : chunk_layout.blocks_) {
+      blob_info.blocks_.push_back(block);
+    }
+    if (alloc_result != 0) {
+      error_code = 10 + alloc_result;
+      break;
+    }
+    if (chunk_layout.blocks_.size() == 1 && local == stored.end()) {
+      stored.emplace(fp, StoredChunk{off, chunk_layout.blocks_[0]});
+    }
+    if (!write_runs.empty() &&
+        write_runs.back().first + write_runs.back().second == off) {
+      write_runs.back().second += len;
+    } else {
+      write_runs.emplace_back(off, len);
+    }
+  }
+  if (!verify.IsNull()) {
+    ipc_manager->FreeBuffer(verify);
+  }
+  if (error_code != 0) {
+    CHI_CO_RETURN;
+  }
+
+  // Write the chunks that were not matched, one run of adjacent ones at a
+  // time, then make them available to later writes
+  for (const auto &run : write_runs) {
+    chi::u32 write_result = 0;
+    CHI_CO_AWAIT(ModifyExistingData(blob_info.blocks_, blob_data + run.first,
+                                    run.second, run.first, write_result,
+                                    qos_class));
+    if (write_result != 0) {
+      error_code = 20 + write_result;
+      CHI_CO_RETURN;
+    }
+  }
+  {
+    hshm::ScopedMutex guard(block_refs_lock_, 0);
+    for (const auto &entry : stored) {
+      if (dedup_index_.emplace(entry.first, entry.second.block_).second) {
+        dedup_fingerprints_[entry.second.block_] = entry.first;
+      }
+    }
+  }
+  if (hits > 0) {
+    dedup_chunks_hit_.fetch_add(hits, std::memory_order_relaxed);
+    dedup_bytes_saved_.fetch_add(saved, std::memory_order_relaxed);
+  }
+  CHI_CO_RETURN;
+}
+
+void Runtime::DropBlobFingerprints(const BlobInfo &blob_info) {
+  hshm::ScopedMutex guard(block_refs_lock_, 0);
+  for (const auto &block : blob_info.blocks_) {
+    EraseFingerprint(block);
+  }
+}
+
+void Runtime::EraseFingerprint(const BlobBlock &block) {
+  if (dedup_fingerprints_.empty()) {
+    return;
+  }
+  auto it = dedup_fingerprints_.find(block);
+  if (it == dedup_fingerprints_.end()) {
+    return;
+  }
+  auto entry = dedup_index_.find(it->second);
+  if (entry != dedup_index_.end() && entry->second == block) {
+    dedup_index_.erase(entry);
+  }
+  dedup_fingerprints_.erase(it);
+}
+
+bool Runtime::HasPackedBlocks(const BlobInfo &blob_info) {
+  for (const auto &block : blob_info.blocks_) {
+    if (!block.target_id_.IsNull() &&
+        PackSegmentTable::IsPackedOffset(block.target_offset_)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+chi::TaskResume Runtime::PackWriteBlob(BlobInfo &blob_info,
+                                       hipc::ShmPtr<> blob_data,
+                                       chi::u64 size, float blob_score,
+                                       int min_persistence_level,
+                                       bool &packed) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  packed = false;
+  auto *ipc_manager = CHI_IPC;
+  hipc::FullPtr<char> data =
+      ipc_manager->ToFullPtr<char>(blob_data.template Cast<char>());
+  if (data.IsNull() || pack_open_.empty()) {
+    CHI_CO_RETURN;
+  }
+
+  // The object goes where ExtendBlob would have put it: the first target
+  // the DPE ranks that meets the persistence level and has room. Only file
+  // and NVMe targets pack; memory tiers gain nothing from large writes.
+  std::vector<TargetInfo> available_targets;
+  {
+    chi::ScopedCoRwReadLock read_lock(target_lock_);
+    registered_targets_.for_each(
+        [&available_targets](const chi::PoolId &, const TargetInfo &info) {
+          available_targets.push_back(info);
+        });
+  }
+  if (available_targets.empty()) {
+    CHI_CO_RETURN;
+  }
+  const Config &config = GetConfig();
+  std::unique_ptr<DataPlacementEngine> dpe =
+      DpeFactory::CreateDpe(config.dpe_.dpe_type_);
+  std::vector<TargetInfo> ordered_targets =
+      dpe->SelectTargets(available_targets, blob_score, size);
+  PreferLocalTargets(ordered_targets, nullptr);
+  const TargetInfo *target = nullptr;
+  for (const TargetInfo &candidate : ordered_targets) {
+    if (static_cast<int>(candidate.persistence_level_) >=
+            min_persistence_level &&
+        candidate.remaining_space_ >= size) {
+      target = &candidate;
+      break;
+    }
+  }
+  if (target == nullptr ||
+      (target->bdev_type_ != chimaera::bdev::BdevType::kFile &&
+       target->bdev_type_ != chimaera::bdev::BdevType::kNvme)) {
+    CHI_CO_RETURN;
+  }
+  chi::PoolId target_id = target->bdev_client_.pool_id_;
+  size_t slot =
+      CHI_CUR_WORKER->GetWorkerStats().worker_id_ % pack_open_.size();
+
+  // The open segment takes the object unless it is full; a full one is
+  // sealed and replaced once
+  chi::u64 packed_seg = 0;
+  chi::u64 packed_end = 0;  // End of the object within its segment
+  for (int attempt = 0; attempt < 2 && !packed; ++attempt) {
+    chi::u64 sealed_id = 0;
+    bool has_open = false;
+    {
+      hshm::ScopedMutex guard(pack_lock_, 0);
+      auto it = pack_open_[slot].find(target_id);
+      if (it != pack_open_[slot].end()) {
+        has_open = true;
+        chi::u64 offset = 0;
+        PackSegment *seg = pack_segments_.Get(it->second);
+        if (seg != nullptr &&
+            pack_segments_.Reserve(it->second, size, offset)) {
+          memcpy(seg->buffer_.ptr_ + offset, data.ptr_, size);
+          blob_info.blocks_.push_back(
+              BlobBlock(target_id, seg->base_ + offset, size));
+          packed = true;
+          packed_seg = it->second;
+          packed_end = offset + size;
+        } else {
+          sealed_id = it->second;
+          pack_segments_.Seal(sealed_id);
+          pack_open_[slot].erase(it);
+          has_open = false;
+        }
+      }
+    }
+    if (sealed_id != 0) {
+      CHI_CO_AWAIT(FlushPackSegment(sealed_id));
+    }
+    if (!packed && !has_open && attempt == 0) {
+      bool opened = false;
+      CHI_CO_AWAIT(OpenPackSegment(*target, slot, opened));
+      if (!opened) {
+        break;
+      }
+    }
+  }
+  if (!packed) {
+    CHI_CO_RETURN;
+  }
+
+  // The caller logs the extent and acknowledges the write, so the object
+  // must be on the target first. Writes appended meanwhile go out in the
+  // same segment write.
+  CHI_CO_AWAIT(FlushPackSegment(packed_seg, packed_end));
+  std::vector<BlobBlock> unpacked;
+  std::vector<chi::u64> reclaim;
+  {
+    hshm::ScopedMutex guard(pack_lock_, 0);
+    PackSegment *seg = pack_segments_.Get(packed_seg);
+    if (seg == nullptr || seg->durable_ < packed_end) {
+      unpacked.push_back(blob_info.blocks_.back());
+    }
+  }
+  if (!unpacked.empty()) {
+    // The segment write failed: store the blob in blocks of its own
+    blob_info.blocks_.pop_back();
+    ReleasePackedBlocks(unpacked, reclaim);
+    packed = false;
+    for (chi::u64 seg_id : reclaim) {
+      CHI_CO_AWAIT(FreePackSegment(seg_id));
+    }
+    CHI_CO_RETURN;
+  }
+  pack_objects_.fetch_add(1, std::memory_order_relaxed);
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::OpenPackSegment(const TargetInfo &target,
+                                         size_t slot, bool &opened) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  opened = false;
+  chi::u64 segment_size = GetConfig().performance_.small_segment_size_;
+  TargetInfo target_copy = target;
+  std::vector<chimaera::bdev::Block> blocks;
+  bool alloc_success = false;
+  CHI_CO_AWAIT(
+      AllocateFromTarget(target_copy, segment_size, blocks, alloc_success));
+  if (!alloc_success) {
+    CHI_CO_RETURN;
+  }
+  chi::PoolId target_id = target.bdev_client_.pool_id_;
+  auto *ipc_manager = CHI_IPC;
+  hipc::FullPtr<char> buffer;
+  // A segment must be one extent, so that object offsets are target offsets
+  if (blocks.size() == 1 && blocks[0].size_ == segment_size &&
+      !PackSegmentTable::IsPackedOffset(blocks[0].offset_)) {
+    buffer = ipc_manager->AllocateBuffer(segment_size);
+  }
+  bool keep = !buffer.IsNull();
+  if (keep) {
+    memset(buffer.ptr_, 0, segment_size);
+    hshm::ScopedMutex guard(pack_lock_, 0);
+    // Another write of this worker may have opened one meanwhile
+    keep = pack_open_[slot].count(target_id) == 0;
+    if (keep) {
+      chi::u64 seg_id =
+          pack_segments_.Add(target_id, blocks[0].offset_, segment_size);
+      pack_segments_.Get(seg_id)->buffer_ = buffer;
+      pack_open_[slot][target_id] = seg_id;
+    }
+    opened = true;
+  }
+  if (keep) {
+    LogPackSegment(TxnType::kAddPackSegment, target_id, blocks[0].offset_,
+                   segment_size);
+  }
+  if (!keep) {
+    if (!buffer.IsNull()) {
+      ipc_manager->FreeBuffer(buffer);
+    }
+    BlobInfo layout;
+    for (const auto &block : blocks) {
+      layout.blocks_.push_back(
+          BlobBlock(target_id, block.offset_, block.size_));
+    }
+    chi::u32 free_result = 0;
+    CHI_CO_AWAIT(FreeAllBlobBlocks(layout, free_result));
+  }
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::FlushPackSegment(chi::u64 seg_id, chi::u64 until) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  auto *ipc_manager = CHI_IPC;
+  bool reclaim = false;
+  while (true) {
+    chi::PoolId target_id;
+    chi::u64 base = 0;
+    chi::u64 start = 0;  // Range to write, relative to the segment
+    chi::u64 end = 0;
+    chi::u64 fill = 0;
+    hipc::FullPtr<char> buffer;
+    bool wait = false;
+    {
+      hshm::ScopedMutex guard(pack_lock_, 0);
+      PackSegment *seg = pack_segments_.Get(seg_id);
+      if (seg == nullptr) {
+        break;
+      }
+      if (seg->flushing_) {
+        wait = true;
+      } else if (seg->durable_ >= seg->fill_) {
+        if (seg->sealed_ && !seg->buffer_.IsNull()) {
+          ipc_manager->FreeBuffer(seg->buffer_);
+          seg->buffer_ = hipc::FullPtr<char>();
+        }
+        reclaim = PackSegmentTable::IsReclaimable(*seg);
+        break;
+      } else if (seg->durable_ >= until) {
+        // The caller's bytes are out; later appends are left to others
+        break;
+      } else {
+        // Whole units from the last one written, so writes stay aligned;
+        // the bytes they repeat are unchanged
+        constexpr chi::u64 kUnit = PackSegmentTable::kUnit;
+        target_id = seg->target_id_;
+        fill = seg->fill_;
+        base = seg->base_;
+        start = seg->durable_ / kUnit * kUnit;
+        end = std::min(seg->size_, (fill + kUnit - 1) / kUnit * kUnit);
+        buffer = seg->buffer_;
+        seg->flushing_ = true;
+      }
+    }
+    if (wait) {
+      CHI_CO_AWAIT(chi::yield(kPackFlushPollUs));
+      continue;
+    }
+
+    BlobBlockList run_blocks(HSHM_MALLOC);
+    run_blocks.push_back(BlobBlock(target_id, base + start, end - start));
+    chi::u32 write_result = 0;
+    CHI_CO_AWAIT(ModifyExistingData(run_blocks,
+                                    hipc::ShmPtr<>(buffer.shm_) + start,
+                                    end - start, 0, write_result));
+    {
+      hshm::ScopedMutex guard(pack_lock_, 0);
+      PackSegment *seg = pack_segments_.Get(seg_id);
+      seg->flushing_ = false;
+      if (write_result == 0) {
+        seg->durable_ = std::max(seg->durable_, fill);
+      }
+    }
+    if (write_result != 0) {
+      HLOG(kWarning, "FlushPackSegment: write of segment {} on ({},{}) failed",
+           seg_id, target_id.major_, target_id.minor_);
+      break;
+    }
+    pack_flushes_.fetch_add(1, std::memory_order_relaxed);
+    pack_flushed_bytes_.fetch_add(end - start, std::memory_order_relaxed);
+  }
+  if (reclaim) {
+    CHI_CO_AWAIT(FreePackSegment(seg_id));
+  }
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::FlushPackSegments() {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  std::vector<chi::u64> pending;
+  {
+    hshm::ScopedMutex guard(pack_lock_, 0);
+    pack_segments_.ForEach([&pending](chi::u64 id, const PackSegment &seg) {
+      if (seg.durable_ < seg.fill_) {
+        pending.push_back(id);
+      }
+    });
+  }
+  for (chi::u64 seg_id : pending) {
+    CHI_CO_AWAIT(FlushPackSegment(seg_id));
+  }
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::FreePackSegment(chi::u64 seg_id) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  PackSegment removed;
+  {
+    hshm::ScopedMutex guard(pack_lock_, 0);
+    PackSegment *seg = pack_segments_.Get(seg_id);
+    if (seg == nullptr || !PackSegmentTable::IsReclaimable(*seg) ||
+        !pack_segments_.Remove(seg_id, removed)) {
+      CHI_CO_RETURN;
+    }
+    if (!removed.buffer_.IsNull()) {
+      auto *ipc_manager = CHI_IPC;
+      ipc_manager->FreeBuffer(removed.buffer_);
+    }
+  }
+  // Logged first: once freed, the space may hold another blob's blocks
+  LogPackSegment(TxnType::kFreePackSegment, removed.target_id_, removed.base_,
+                 removed.size_);
+  BlobInfo layout;
+  layout.blocks_.push_back(
+      BlobBlock(removed.target_id_, removed.base_, removed.size_));
+  chi::u32 free_result = 0;
+  CHI_CO_AWAIT(FreeAllBlobBlocks(layout, free_result));
+  pack_segments_freed_.fetch_add(1, std::memory_order_relaxed);
+  CHI_CO_RETURN;
+}
+
+void Runtime::LogPackSegment(TxnType type, const chi::PoolId &target_id,
+                             chi::u64 base, chi::u64 size) {
+  if (tag_txn_logs_.empty()) {
+    return;
+  }
+  TxnPackSegment txn;
+  txn.bdev_major_ = target_id.major_;
+  txn.bdev_minor_ = target_id.minor_;
+  txn.base_ = base;
+  txn.size_ = size;
+  tag_txn_logs_[0]->Log(type, txn);
+  tag_txn_logs_[0]->Sync();
+}
+
+void Runtime::ReleasePackedBlocks(std::vector<BlobBlock> &blocks,
+                                  std::vector<chi::u64> &reclaim) {
+  auto is_packed = [](const BlobBlock &block) {
+    return PackSegmentTable::IsPackedOffset(block.target_offset_);
+  };
+  if (std::none_of(blocks.begin(), blocks.end(), is_packed)) {
+    return;
+  }
+  hshm::ScopedMutex guard(pack_lock_, 0);
+  for (const auto &block : blocks) {
+    if (!is_packed(block)) {
+      continue;
+    }
+    // A block of a segment no log recorded (written before segments were
+    // logged) simply stays allocated
+    chi::u64 seg_id = pack_segments_.Find(block.target_id_,
+                                          block.target_offset_, block.size_);
+    if (seg_id != 0 && pack_segments_.Release(seg_id, block.size_)) {
+      reclaim.push_back(seg_id);
+    }
+  }
+  blocks.erase(std::remove_if(blocks.begin(), blocks.end(), is_packed),
+               blocks.end());
+}
+
+chi::TaskResume Runtime::ReadPackedData(const BlobBlockList &blocks,
+                                        hipc::ShmPtr<> data, size_t data_size,
+                                        size_t data_offset_in_blob,
+                                        bool &copied) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  copied = false;
+  std::vector<chi::u64> pending;
+  {
+    hshm::ScopedMutex guard(pack_lock_, 0);
+    if (pack_segments_.Size() == 0) {
+      CHI_CO_RETURN;
+    }
+    if (blocks.size() == 1 &&
+        data_offset_in_blob + data_size <= blocks[0].size_) {
+      const BlobBlock &block = blocks[0];
+      chi::u64 seg_id = pack_segments_.Find(block.target_id_,
+                                            block.target_offset_, block.size_);
+      PackSegment *seg = seg_id != 0 ? pack_segments_.Get(seg_id) : nullptr;
+      if (seg != nullptr && !seg->buffer_.IsNull()) {
+        auto *ipc_manager = CHI_IPC;
+        hipc::FullPtr<char> out =
+            ipc_manager->ToFullPtr<char>(data.template Cast<char>());
+        if (!out.IsNull()) {
+          memcpy(out.ptr_,
+                 seg->buffer_.ptr_ + (block.target_offset_ - seg->base_) +
+                     data_offset_in_blob,
+                 data_size);
+          copied = true;
+          pack_buffer_reads_.fetch_add(1, std::memory_order_relaxed);
+          CHI_CO_RETURN;
+        }
+      }
+    }
+    // Segments whose bytes the read needs are written out first
+    chi::u64 pos = 0;
+    for (const auto &block : blocks) {
+      chi::u64 block_end = pos + block.size_;
+      if (block_end > data_offset_in_blob &&
+          pos < data_offset_in_blob + data_size &&
+          PackSegmentTable::IsPackedOffset(block.target_offset_)) {
+        chi::u64 seg_id = pack_segments_.Find(
+            block.target_id_, block.target_offset_, block.size_);
+        PackSegment *seg = seg_id != 0 ? pack_segments_.Get(seg_id) : nullptr;
+        if (seg != nullptr &&
+            seg->base_ + seg->durable_ < block.target_offset_ + block.size_) {
+          pending.push_back(seg_id);
+        }
+      }
+      pos = block_end;
+    }
+  }
+  for (chi::u64 seg_id : pending) {
+    CHI_CO_AWAIT(FlushPackSegment(seg_id));
+  }
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::CleanPackSegments(chi::u64 &blobs_moved,
+                                           chi::u64 &bytes_moved) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  blobs_moved = 0;
+  bytes_moved = 0;
+  // Restored segments whose objects were all deleted go back first
+  std::vector<chi::u64> empty;
+  {
+    hshm::ScopedMutex guard(pack_lock_, 0);
+    pack_segments_.CollectReclaimable(empty);
+  }
+  for (chi::u64 seg_id : empty) {
+    CHI_CO_AWAIT(FreePackSegment(seg_id));
+  }
+  std::unordered_set<chi::u64> sparse;
+  {
+    std::vector<chi::u64> ids;
+    hshm::ScopedMutex guard(pack_lock_, 0);
+    pack_segments_.CollectSparse(
+        GetConfig().performance_.small_segment_clean_ratio_, ids);
+    sparse.insert(ids.begin(), ids.end());
+  }
+  if (sparse.empty()) {
+    CHI_CO_RETURN;
+  }
+
+  // The live objects of those segments, found by scanning the blobs
+  std::vector<std::pair<BlobKey, BlobBlock>> packed;
+  tag_blob_name_to_info_.ForEach([&](const BlobKey &key,
+                                     const BlobInfo &blob_info) {
+    if (blob_info.blocks_.size() == 1 && HasPackedBlocks(blob_info)) {
+      packed.emplace_back(key, blob_info.blocks_[0]);
+    }
+  });
+  std::vector<std::pair<TagId, std::string>> candidates;
+  {
+    hshm::ScopedMutex guard(pack_lock_, 0);
+    for (const auto &entry : packed) {
+      const BlobBlock &block = entry.second;
+      chi::u64 seg_id = pack_segments_.Find(block.target_id_,
+                                            block.target_offset_, block.size_);
+      if (sparse.count(seg_id) != 0) {
+        candidates.emplace_back(entry.first.GetTagId(),
+                                entry.first.GetName());
+      }
+    }
+  }
+
+  for (const auto &candidate : candidates) {
+    chi::u64 moved = 0;
+    CHI_CO_AWAIT(RepackBlob(candidate.first, candidate.second, moved));
+    if (moved > 0) {
+      blobs_moved++;
+      bytes_moved += moved;
+    }
+  }
+  pack_objects_cleaned_.fetch_add(blobs_moved, std::memory_order_relaxed);
+  HLOG(kDebug,
+       "CleanPackSegments: moved {} objects ({} bytes) out of {} segments",
+       blobs_moved, bytes_moved, sparse.size());
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::RepackBlob(const TagId &tag_id,
+                                    const std::string &blob_name,
+                                    chi::u64 &bytes_moved) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  bytes_moved = 0;
+  BlobInfo *blob_info_ptr = tag_blob_name_to_info_.Find(tag_id, blob_name);
+  if (!blob_info_ptr || blob_info_ptr->blocks_.size() != 1 ||
+      !HasPackedBlocks(*blob_info_ptr)) {
+    CHI_CO_RETURN;
+  }
+  BlobInfo old_layout;
+  old_layout.blocks_ = blob_info_ptr->blocks_;
+  Timestamp old_modified = blob_info_ptr->last_modified_;
+  float score = blob_info_ptr->score_;
+  chi::u64 size = old_layout.GetTotalSize();
+  int min_persistence_level = 0;
+  {
+    chi::ScopedCoRwReadLock read_lock(target_lock_);
+    TargetInfo *tinfo =
+        registered_targets_.find(old_layout.blocks_[0].target_id_);
+    if (tinfo != nullptr) {
+      min_persistence_level = static_cast<int>(tinfo->persistence_level_);
+    }
+  }
+
+  auto *ipc_manager = CHI_IPC;
+  hipc::FullPtr<char> buffer = ipc_manager->AllocateBuffer(size);
+  if (buffer.IsNull()) {
+    CHI_CO_RETURN;
+  }
+  hipc::ShmPtr<> shm_ptr(buffer.shm_);
+  chi::u32 read_result = 0;
+  CHI_CO_AWAIT(ReadData(old_layout.blocks_, shm_ptr, size, 0, read_result));
+  BlobInfo new_layout;
+  bool packed = false;
+  if (read_result == 0) {
+    CHI_CO_AWAIT(PackWriteBlob(new_layout, shm_ptr, size, score,
+                               min_persistence_level, packed));
+  }
+  ipc_manager->FreeBuffer(buffer);
+  if (!packed) {
+    CHI_CO_RETURN;
+  }
+
+  // Only swap if no writer touched the blob while the copy was made
+  blob_info_ptr = tag_blob_name_to_info_.Find(tag_id, blob_name);
+  bool swap = blob_info_ptr != nullptr &&
+              blob_info_ptr->last_modified_ == old_modified &&
+              blob_info_ptr->blocks_.size() == 1 &&
+              blob_info_ptr->blocks_[0] == old_layout.blocks_[0];
+  chi::u32 free_result = 0;
+  if (!swap) {
+    CHI_CO_AWAIT(FreeAllBlobBlocks(new_layout, free_result));
+    CHI_CO_RETURN;
+  }
+  blob_info_ptr->blocks_ = new_layout.blocks_;
+  LogBlobBlocks(tag_id, blob_name, *blob_info_ptr);
+  UpdateWriteBackState(tag_id, blob_name, *blob_info_ptr);
+  CHI_CO_AWAIT(FreeAllBlobBlocks(old_layout, free_result));
+  bytes_moved = size;
+  CHI_CO_RETURN;
+}
+
+void Runtime::GetTagErasure(const TagId &tag_id, chi::u32 &data_shards,
+                            chi::u32 &parity_shards) {
+  chi::ScopedCoRwReadLock lock(erasure_lock_);
+  auto it = tag_erasure_.find(tag_id);
+  data_shards = it != tag_erasure_.end() ? it->second.first : 0;
+  parity_shards = it != tag_erasure_.end() ? it->second.second : 0;
+}
+
+chi::TaskResume Runtime::ErasureWriteBlob(BlobInfo &blob_info,
+                                          hipc::ShmPtr<> blob_data,
+                                          chi::u64 offset, chi::u64 size,
+                                          chi::u32 data_shards,
+                                          chi::u32 parity_shards,
+                                          float blob_score,
+                                          int min_persistence_level,
+                                          chi::u32 qos_class,
+                                          chi::u32 &error_code) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  error_code = 0;
+  auto *ipc_manager = CHI_IPC;
+  hipc::FullPtr<char> data =
+      ipc_manager->ToFullPtr<char>(blob_data.template Cast<char>());
+  if (data.IsNull()) {
+    error_code = 21;
+    CHI_CO_RETURN;
+  }
+
+  // Stage the whole stripe: the current bytes patched with the write, zero
+  // padding up to k shards, then the parity shards
+  chi::u64 old_size =
+      blob_info.blocks_.empty() ? 0 : blob_info.GetLogicalSize();
+  chi::u64 new_size = std::max(old_size, offset + size);
+  chi::u32 total_shards = data_shards + parity_shards;
+  chi::u64 shard_size = ErasureCode::ShardSize(new_size, data_shards);
+  chi::u64 stripe_size = shard_size * total_shards;
+  hipc::FullPtr<char> stripe = ipc_manager->AllocateBuffer(stripe_size);
+  if (stripe.IsNull()) {
+    error_code = 21;
+    CHI_CO_RETURN;
+  }
+  hipc::ShmPtr<> stripe_ptr(stripe.shm_);
+  std::memset(stripe.ptr_, 0, stripe_size);
+  if (old_size > 0) {
+    chi::u32 read_result = 0;
+    CHI_CO_AWAIT(ReadBlobData(blob_info, stripe_ptr, old_size, 0, read_result,
+                              qos_class));
+    if (read_result != 0) {
+      ipc_manager->FreeBuffer(stripe);
+      error_code = 40 + read_result;
+      CHI_CO_RETURN;
+    }
+  }
+  std::memcpy(stripe.ptr_ + offset, data.ptr_, size);
+
+  ErasureCode code(data_shards, parity_shards);
+  uint8_t *base = reinterpret_cast<uint8_t *>(stripe.ptr_);
+  std::vector<const uint8_t *> data_ptrs;
+  std::vector<uint8_t *> parity_ptrs;
+  for (chi::u32 i = 0; i < total_shards; ++i) {
+    if (i < data_shards) {
+      data_ptrs.push_back(base + i * shard_size);
+    } else {
+      parity_ptrs.push_back(base + i * shard_size);
+    }
+  }
+  code.Encode(data_ptrs.data(), parity_ptrs.data(), shard_size);
+
+  // Release the old layout. Each shard then gets extents of its own, on
+  // targets no earlier shard uses while the DPE offers others, and they are
+  // appended without merging so shard i stays bytes [i, i + 1) * shard.
+  if (!blob_info.blocks_.empty()) {
+    chi::u32 free_result = 0;
+    CHI_CO_AWAIT(FreeAllBlobBlocks(blob_info, free_result));
+  }
+  blob_info.ClearErasureLayout();
+  std::unordered_set<chi::PoolId> used_targets;
+  for (chi::u32 i = 0; i < total_shards && error_code == 0; ++i) {
+    BlobInfo shard_layout;
+    chi::u32 alloc_result = 0;
+    CHI_CO_AWAIT(ExtendBlob(shard_layout, 0, shard_size, blob_score,
+                            alloc_result, min_persistence_level,
+                            &used_targets));
+    for (const auto &block : shard_layout.blocks_) {
+      blob_info.blocks_.push_back(block);
+      used_targets.insert(block.target_id_);
+    }
+    if (alloc_result != 0) {
+      error_code = 10 + alloc_result;
+    }
+  }
+  if (error_code == 0) {
+    chi::u32 write_result = 0;
+    CHI_CO_AWAIT(ModifyExistingData(blob_info.blocks_, stripe_ptr, stripe_size,
+                                    0, write_result, qos_class));
+    if (write_result != 0) {
+      error_code = 20 + write_result;
+    }
+  }
+  ipc_manager->FreeBuffer(stripe);
+  if (error_code == 0) {
+    blob_info.erasure_data_ = data_shards;
+    blob_info.erasure_parity_ = parity_shards;
+    blob_info.erasure_shard_ = shard_size;
+    blob_info.erasure_size_ = new_size;
+  }
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::ReadErasureData(const BlobInfo &layout,
+                                         hipc::ShmPtr<> data, chi::u64 size,
+                                         chi::u64 offset, chi::u32 qos_class,
+                                         chi::u32 &error_code) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  error_code = 0;
+  if (offset + size > layout.erasure_size_) {
+    error_code = 1;
+    CHI_CO_RETURN;
+  }
+  chi::u32 data_shards = layout.erasure_data_;
+  chi::u32 total_shards = data_shards + layout.erasure_parity_;
+  chi::u64 shard_size = layout.erasure_shard_;
+  std::unordered_set<chi::PoolId> reachable = SnapshotReachableTargets();
+  BlobBlockList shard_blocks(HSHM_MALLOC);
+  auto shard_reachable = [&](chi::u32 shard) {
+    GetShardBlocks(layout, shard, shard_blocks);
+    for (const auto &block : shard_blocks) {
+      if (reachable.count(block.target_id_) == 0) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // Healthy read straight from the data shards covering the range
+  bool healthy = true;
+  for (chi::u64 shard = offset / shard_size;
+       healthy && shard <= (offset + size - 1) / shard_size; ++shard) {
+    healthy = shard_reachable(static_cast<chi::u32>(shard));
+  }
+  if (healthy) {
+    chi::u32 read_result = 0;
+    CHI_CO_AWAIT(ReadData(layout.blocks_, data, size, offset, read_result,
+                          qos_class));
+    if (read_result == 0) {
+      CHI_CO_RETURN;
+    }
+  }
+
+  // Degraded read: any k shards, data shards first, rebuild the rest
+  erasure_degraded_reads_.fetch_add(1, std::memory_order_relaxed);
+  auto *ipc_manager = CHI_IPC;
+  hipc::FullPtr<char> stripe =
+      ipc_manager->AllocateBuffer(shard_size * total_shards);
+  if (stripe.IsNull()) {
+    error_code = 2;
+    CHI_CO_RETURN;
+  }
+  hipc::ShmPtr<> stripe_ptr(stripe.shm_);
+  std::vector<bool> present(total_shards, false);
+  chi::u32 have = 0;
+  for (chi::u32 shard = 0; shard < total_shards && have < data_shards;
+       ++shard) {
+    if (!shard_reachable(shard)) {
+      continue;
+    }
+    chi::u32 read_result = 0;
+    CHI_CO_AWAIT(ReadData(shard_blocks, stripe_ptr + shard * shard_size,
+                          shard_size, 0, read_result, qos_class));
+    if (read_result == 0) {
+      present[shard] = true;
+      ++have;
+    }
+  }
+  ErasureCode code(data_shards, layout.erasure_parity_);
+  uint8_t *base = reinterpret_cast<uint8_t *>(stripe.ptr_);
+  std::vector<uint8_t *> shards;
+  for (chi::u32 shard = 0; shard < total_shards; ++shard) {
+    shards.push_back(base + shard * shard_size);
+  }
+  if (have < data_shards ||
+      !code.Reconstruct(shards.data(), present, shard_size, true)) {
+    HLOG(kError, "ReadErasureData: only {} of {} shards readable", have,
+         data_shards);
+    error_code = 2;
+  } else {
+    auto out = ipc_manager->ToFullPtr<char>(data.template Cast<char>());
+    std::memcpy(out.ptr_, stripe.ptr_ + offset, size);
+  }
+  ipc_manager->FreeBuffer(stripe);
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::ReadBlobData(const BlobInfo &layout,
+                                      hipc::ShmPtr<> data, size_t data_size,
+                                      size_t data_offset_in_blob,
+                                      chi::u32 &error_code,
+                                      chi::u32 qos_class) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  if (layout.IsErasureCoded()) {
+    CHI_CO_AWAIT(ReadErasureData(layout, data, data_size, data_offset_in_blob,
+                                 qos_class, error_code));
+  } else if (layout.IsEncrypted()) {
+    CHI_CO_AWAIT(ReadEncryptedData(layout, data, data_size,
+                                   data_offset_in_blob, qos_class,
+                                   error_code));
+  } else {
+    CHI_CO_AWAIT(ReadData(layout.blocks_, data, data_size,
+                          data_offset_in_blob, error_code, qos_class));
+  }
+  CHI_CO_RETURN;
+}
+
+bool Runtime::LoadEncryptionKey() {
+#if HSHM_ENABLE_ENCRYPT
+  static_assert(kSealOverhead == hshm::AesGcm::kOverhead,
+                "kSealOverhead must match the AES-GCM nonce and tag");
+  const std::string &path = config_.performance_.encryption_key_path_;
+  std::ifstream ifs(path, std::ios::binary);
+  if (!ifs.is_open()) {
+    HLOG(kError, "LoadEncryptionKey: Cannot open key file {}", path);
+    return false;
+  }
+  std::string secret((std::istreambuf_iterator<char>(ifs)),
+                     std::istreambuf_iterator<char>());
+  bool loaded = false;
+  if (secret.size() == hshm::AesGcm::kKeySize) {
+    loaded = cipher_.SetKey(secret);
+  } else {
+    // A passphrase file usually ends in a newline that is not part of it
+    while (!secret.empty() &&
+           (secret.back() == '\n' || secret.back() == '\r')) {
+      secret.pop_back();
+    }
+    loaded = !secret.empty() && cipher_.GenerateKey(secret, "wrp_cte_core");
+  }
+  if (!loaded) {
+    HLOG(kError, "LoadEncryptionKey: No usable key in {}", path);
+    return false;
+  }
+  HLOG(kInfo, "LoadEncryptionKey: Loaded the key for encrypted tags");
+  return true;
+#else
+  HLOG(kError,
+       "LoadEncryptionKey: encryption_key_path is set, but CTE was built "
+       "without WRP_CORE_ENABLE_ENCRYPT");
+  return false;
+#endif
+}
+
+chi::u32 Runtime::GetTagEncryptChunk(const TagId &tag_id) {
+  chi::ScopedCoRwReadLock lock(encrypt_lock_);
+  auto it = tag_encrypt_.find(tag_id);
+  return it != tag_encrypt_.end() ? it->second : 0;
+}
+
+chi::u64 Runtime::GetSealedSize(chi::u64 size, chi::u64 chunk) {
+  chi::u64 chunks = (size + chunk - 1) / chunk;
+  return size + chunks * kSealOverhead;
+}
+
+chi::TaskResume Runtime::EncryptWriteBlob(BlobInfo &blob_info,
+                                          hipc::ShmPtr<> blob_data,
+                                          chi::u64 offset, chi::u64 size,
+                                          chi::u32 chunk, float blob_score,
+                                          int min_persistence_level,
+                                          chi::u32 qos_class,
+                                          chi::u32 &error_code) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  error_code = 0;
+#if HSHM_ENABLE_ENCRYPT
+  auto *ipc_manager = CHI_IPC;
+  hipc::FullPtr<char> data =
+      ipc_manager->ToFullPtr<char>(blob_data.template Cast<char>());
+  if (data.IsNull() || !cipher_.HasKey()) {
+    error_code = 21;
+    CHI_CO_RETURN;
+  }
+
+  // Blocks in any other layout are read back, patched with the write, and
+  // sealed into new blocks as a whole
+  hipc::FullPtr<char> staged;
+  if (!blob_info.blocks_.empty() &&
+      (!blob_info.IsEncrypted() || blob_info.encrypt_chunk_ != chunk)) {
+    chi::u64 old_size = blob_info.GetLogicalSize();
+    chi::u64 staged_size = std::max(old_size, offset + size);
+    staged = ipc_manager->AllocateBuffer(staged_size);
+    if (staged.IsNull()) {
+      error_code = 21;
+      CHI_CO_RETURN;
+    }
+    std::memset(staged.ptr_ + old_size, 0, staged_size - old_size);
+    if (old_size > 0) {
+      chi::u32 read_result = 0;
+      CHI_CO_AWAIT(ReadBlobData(blob_info, hipc::ShmPtr<>(staged.shm_),
+                                old_size, 0, read_result, qos_class));
+      if (read_result != 0) {
+        ipc_manager->FreeBuffer(staged);
+        error_code = 40 + read_result;
+        CHI_CO_RETURN;
+      }
+    }
+    std::memcpy(staged.ptr_ + offset, data.ptr_, size);
+    chi::u32 free_result = 0;
+    CHI_CO_AWAIT(FreeAllBlobBlocks(blob_info, free_result));
+    blob_info.ClearErasureLayout();
+    data = staged;
+    offset = 0;
+    size = staged_size;
+  }
+
+  // Reseal from the write start, or from the old end if the write leaves a
+  // hole (sealed as zeros), through the write end
+  chi::u64 old_size = blob_info.blocks_.empty() ? 0 : blob_info.encrypt_size_;
+  chi::u64 end = offset + size;
+  chi::u64 new_size = std::max(old_size, end);
+  chi::u64 stride = chunk + kSealOverhead;
+  chi::u64 first = std::min(offset, old_size) / chunk;
+  chi::u64 last = (end - 1) / chunk;
+  chi::u64 last_len = std::min<chi::u64>(chunk, new_size - last * chunk);
+  chi::u64 seal_offset = first * stride;
+  chi::u64 seal_size = (last - first) * stride + last_len + kSealOverhead;
+  hipc::FullPtr<char> plain =
+      ipc_manager->AllocateBuffer((last - first + 1) * chunk);
+  hipc::FullPtr<char> sealed = ipc_manager->AllocateBuffer(seal_size);
+  if (plain.IsNull() || sealed.IsNull()) {
+    error_code = 21;
+  } else {
+    std::memset(plain.ptr_, 0, (last - first + 1) * chunk);
+  }
+
+  // The chunks at either end keep the old bytes the write does not cover
+  chi::u64 edges[2] = {first, last};
+  for (int e = 0; e < (first == last ? 1 : 2) && error_code == 0; ++e) {
+    chi::u64 start = edges[e] * chunk;
+    chi::u64 stop = std::min(old_size, start + chunk);
+    if (start >= old_size || (offset <= start && end >= stop)) {
+      continue;
+    }
+    chi::u32 read_result = 0;
+    CHI_CO_AWAIT(ReadEncryptedData(
+        blob_info, hipc::ShmPtr<>(plain.shm_) + (start - first * chunk),
+        stop - start, start, qos_class, read_result));
+    if (read_result != 0) {
+      error_code = 40 + read_result;
+    }
+  }
+  if (error_code == 0) {
+    std::memcpy(plain.ptr_ + (offset - first * chunk), data.ptr_, size);
+    for (chi::u64 i = first; i <= last && error_code == 0; ++i) {
+      chi::u64 len = std::min<chi::u64>(chunk, new_size - i * chunk);
+      if (!cipher_.Seal(sealed.ptr_ + (i - first) * stride,
+                        plain.ptr_ + (i - first) * chunk, len, i)) {
+        error_code = 21;
+      }
+    }
+  }
+  chi::u64 sealed_total = GetSealedSize(new_size, chunk);
+  if (error_code == 0 && blob_info.GetTotalSize() < sealed_total) {
+    chi::u32 alloc_result = 0;
+    CHI_CO_AWAIT(ExtendBlob(blob_info, 0, sealed_total, blob_score,
+                            alloc_result, min_persistence_level));
+    if (alloc_result != 0) {
+      error_code = 10 + alloc_result;
+    }
+  }
+  if (error_code == 0) {
+    chi::u32 write_result = 0;
+    CHI_CO_AWAIT(ModifyExistingData(blob_info.blocks_,
+                                    hipc::ShmPtr<>(sealed.shm_), seal_size,
+                                    seal_offset, write_result, qos_class));
+    if (write_result != 0) {
+      error_code = 20 + write_result;
+    }
+  }
+  if (error_code == 0) {
+    blob_info.encrypt_chunk_ = chunk;
+    blob_info.encrypt_size_ = new_size;
+  }
+  if (!plain.IsNull()) {
+    ipc_manager->FreeBuffer(plain);
+  }
+  if (!sealed.IsNull()) {
+    ipc_manager->FreeBuffer(sealed);
+  }
+  if (!staged.IsNull()) {
+    ipc_manager->FreeBuffer(staged);
+  }
+#else
+  (void)blob_info;
+  (void)blob_data;
+  (void)offset;
+  (void)size;
+  (void)chunk;
+  (void)blob_score;
+  (void)min_persistence_level;
+  (void)qos_class;
+  error_code = 21;
+#endif
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::ReadEncryptedData(const BlobInfo &layout,
+                                           hipc::ShmPtr<> data, chi::u64 size,
+                                           chi::u64 offset, chi::u32 qos_class,
+                                           chi::u32 &error_code) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  error_code = 0;
+  if (offset + size > layout.encrypt_size_) {
+    error_code = 1;
+    CHI_CO_RETURN;
+  }
+  if (size == 0) {
+    CHI_CO_RETURN;
+  }
+#if HSHM_ENABLE_ENCRYPT
+  if (!cipher_.HasKey()) {
+    error_code = 4;
+    CHI_CO_RETURN;
+  }
+  chi::u64 chunk = layout.encrypt_chunk_;
+  chi::u64 stride = chunk + kSealOverhead;
+  chi::u64 end = offset + size;
+  chi::u64 first = offset / chunk;
+  chi::u64 last = (end - 1) / chunk;
+  chi::u64 last_len =
+      std::min<chi::u64>(chunk, layout.encrypt_size_ - last * chunk);
+  chi::u64 seal_size = (last - first) * stride + last_len + kSealOverhead;
+  auto *ipc_manager = CHI_IPC;
+  hipc::FullPtr<char> sealed = ipc_manager->AllocateBuffer(seal_size);
+  if (sealed.IsNull()) {
+    error_code = 2;
+    CHI_CO_RETURN;
+  }
+  chi::u32 read_result = 0;
+  CHI_CO_AWAIT(ReadData(layout.blocks_, hipc::ShmPtr<>(sealed.shm_),
+                        seal_size, first * stride, read_result, qos_class));
+  if (read_result != 0) {
+    ipc_manager->FreeBuffer(sealed);
+    error_code = 10 + read_result;
+    CHI_CO_RETURN;
+  }
+
+  // Whole chunks open straight into the output, the ends through scratch
+  auto out = ipc_manager->ToFullPtr<char>(data.template Cast<char>());
+  std::vector<char> scratch;
+  for (chi::u64 i = first; i <= last; ++i) {
+    chi::u64 start = i * chunk;
+    chi::u64 len = std::min<chi::u64>(chunk, layout.encrypt_size_ - start);
+    chi::u64 lo = std::max(offset, start);
+    chi::u64 hi = std::min(end, start + len);
+    const char *src = sealed.ptr_ + (i - first) * stride;
+    bool opened;
+    if (lo == start && hi == start + len) {
+      opened = cipher_.Open(out.ptr_ + (start - offset), src,
+                            len + kSealOverhead, i);
+    } else {
+      scratch.resize(len);
+      opened = cipher_.Open(scratch.data(), src, len + kSealOverhead, i);
+      if (opened) {
+        std::memcpy(out.ptr_ + (lo - offset), scratch.data() + (lo - start),
+                    hi - lo);
+      }
+    }
+    if (!opened) {
+      encrypt_auth_failures_.fetch_add(1, std::memory_order_relaxed);
+      HLOG(kError, "ReadEncryptedData: Chunk {} failed authentication", i);
+      error_code = 3;
+      break;
+    }
+  }
+  ipc_manager->FreeBuffer(sealed);
+#else
+  (void)data;
+  (void)qos_class;
+  error_code = 4;
+#endif
+  CHI_CO_RETURN;
+}
+
+void Runtime::GetShardBlocks(const BlobInfo &layout, chi::u32 shard,
+                             BlobBlockList &blocks) {
+  blocks.clear();
+  chi::u64 start = static_cast<chi::u64>(shard) * layout.erasure_shard_;
+  chi::u64 end = start + layout.erasure_shard_;
+  chi::u64 pos = 0;
+  for (const auto &block : layout.blocks_) {
+    chi::u64 block_end = pos + block.size_;
+    if (block_end > start && pos < end) {
+      chi::u64 lo = std::max(pos, start);
+      chi::u64 hi = std::min(block_end, end);
+      blocks.push_back(BlobBlock(block.target_id_,
+                                 block.target_offset_ + (lo - pos), hi - lo));
+    }
+    if (block_end >= end) {
+      break;
+    }
+    pos = block_end;
+  }
+}
+
+std::unordered_set<chi::PoolId> Runtime::SnapshotReachableTargets() {
+  std::unordered_set<chi::PoolId> reachable;
+  auto *ipc_manager = CHI_IPC;
+  chi::u64 self = ipc_manager->GetNodeId();
+  chi::ScopedCoRwReadLock read_lock(target_lock_);
+  registered_targets_.for_each(
+      [&](const chi::PoolId &target_id, const TargetInfo &info) {
+        const chi::PoolQuery &query = info.target_query_;
+        if (query.IsPhysicalMode() && query.GetNodeId() != self &&
+            !ipc_manager->IsAlive(query.GetNodeId())) {
+          return;
+        }
+        reachable.insert(target_id);
+      });
+  return reachable;
+}
+
+chi::TaskResume Runtime::RepairErasureBlobs(chi::u64 &blobs_repaired,
+                                            chi::u64 &bytes_repaired) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  std::unordered_set<chi::PoolId> reachable = SnapshotReachableTargets();
+  std::vector<std::pair<TagId, std::string>> damaged;
+  tag_blob_name_to_info_.ForEach(
+      [&](const BlobKey &key, const BlobInfo &blob_info) {
+        if (!blob_info.IsErasureCoded()) {
+          return;
+        }
+        for (const auto &block : blob_info.blocks_) {
+          if (reachable.count(block.target_id_) == 0) {
+            damaged.emplace_back(key.GetTagId(), key.GetName());
+            return;
+          }
+        }
+      });
+  for (const auto &entry : damaged) {
+    chi::u64 bytes = 0;
+    CHI_CO_AWAIT(
+        RepairErasureBlob(entry.first, entry.second, reachable, bytes));
+    if (bytes > 0) {
+      ++blobs_repaired;
+      bytes_repaired += bytes;
+    }
+  }
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::RepairErasureBlob(
+    const TagId &tag_id, const std::string &blob_name,
+    const std::unordered_set<chi::PoolId> &reachable,
+    chi::u64 &bytes_repaired) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  bytes_repaired = 0;
+  BlobInfo *blob_info_ptr = tag_blob_name_to_info_.Find(tag_id, blob_name);
+  if (!blob_info_ptr || !blob_info_ptr->IsErasureCoded()) {
+    CHI_CO_RETURN;
+  }
+  BlobInfo old_layout;
+  old_layout.blocks_ = blob_info_ptr->blocks_;
+  old_layout.CopyErasureLayout(*blob_info_ptr);
+  Timestamp old_modified = blob_info_ptr->last_modified_;
+  float score = blob_info_ptr->score_;
+  chi::u32 data_shards = old_layout.erasure_data_;
+  chi::u32 total_shards = data_shards + old_layout.erasure_parity_;
+  chi::u64 shard_size = old_layout.erasure_shard_;
+
+  // Shards with a block on an unreachable target are lost; the targets of
+  // the others are avoided for the replacements
+  std::vector<bool> lost(total_shards, false);
+  std::unordered_set<chi::PoolId> used_targets;
+  BlobBlockList shard_blocks(HSHM_MALLOC);
+  chi::u32 num_lost = 0;
+  for (chi::u32 shard = 0; shard < total_shards; ++shard) {
+    GetShardBlocks(old_layout, shard, shard_blocks);
+    for (const auto &block : shard_blocks) {
+      lost[shard] = lost[shard] || reachable.count(block.target_id_) == 0;
+    }
+    if (lost[shard]) {
+      ++num_lost;
+      continue;
+    }
+    for (const auto &block : shard_blocks) {
+      used_targets.insert(block.target_id_);
+    }
+  }
+  if (num_lost == 0) {
+    CHI_CO_RETURN;
+  }
+  if (total_shards - num_lost < data_shards) {
+    HLOG(kError, "RepairErasureBlob: {} lost {} of {} shards, cannot rebuild",
+         blob_name, num_lost, total_shards);
+    CHI_CO_RETURN;
+  }
+
+  // Read any k surviving shards and rebuild every other one
+  auto *ipc_manager = CHI_IPC;
+  hipc::FullPtr<char> stripe =
+      ipc_manager->AllocateBuffer(shard_size * total_shards);
+  if (stripe.IsNull()) {
+    CHI_CO_RETURN;
+  }
+  hipc::ShmPtr<> stripe_ptr(stripe.shm_);
+  std::vector<bool> present(total_shards, false);
+  chi::u32 have = 0;
+  for (chi::u32 shard = 0; shard < total_shards && have < data_shards;
+       ++shard) {
+    if (lost[shard]) {
+      continue;
+    }
+    GetShardBlocks(old_layout, shard, shard_blocks);
+    chi::u32 read_result = 0;
+    CHI_CO_AWAIT(ReadData(shard_blocks, stripe_ptr + shard * shard_size,
+                          shard_size, 0, read_result));
+    if (read_result == 0) {
+      present[shard] = true;
+      ++have;
+    }
+  }
+  ErasureCode code(data_shards, old_layout.erasure_parity_);
+  uint8_t *base = reinterpret_cast<uint8_t *>(stripe.ptr_);
+  std::vector<uint8_t *> shards;
+  for (chi::u32 shard = 0; shard < total_shards; ++shard) {
+    shards.push_back(base + shard * shard_size);
+  }
+  bool swap = have == data_shards &&
+              code.Reconstruct(shards.data(), present, shard_size);
+
+  // Write each lost shard to fresh extents and splice them into the layout
+  BlobInfo new_layout;
+  BlobInfo fresh;
+  for (chi::u32 shard = 0; swap && shard < total_shards; ++shard) {
+    if (!lost[shard]) {
+      GetShardBlocks(old_layout, shard, shard_blocks);
+      for (const auto &block : shard_blocks) {
+        new_layout.blocks_.push_back(block);
+      }
+      continue;
+    }
+    BlobInfo shard_layout;
+    chi::u32 io_error = 0;
+    CHI_CO_AWAIT(ExtendBlob(shard_layout, 0, shard_size, score, io_error, 0,
+                            &used_targets));
+    for (const auto &block : shard_layout.blocks_) {
+      fresh.blocks_.push_back(block);
+      new_layout.blocks_.push_back(block);
+      used_targets.insert(block.target_id_);
+    }
+    if (io_error == 0) {
+      CHI_CO_AWAIT(ModifyExistingData(shard_layout.blocks_,
+                                      stripe_ptr + shard * shard_size,
+                                      shard_size, 0, io_error));
+    }
+    swap = io_error == 0;
+  }
+  ipc_manager->FreeBuffer(stripe);
+
+  // Only swap if no writer touched the blob while the rebuild was in flight
+  if (swap) {
+    blob_info_ptr = tag_blob_name_to_info_.Find(tag_id, blob_name);
+    swap = blob_info_ptr != nullptr &&
+           blob_info_ptr->last_modified_ == old_modified &&
+           blob_info_ptr->blocks_.size() == old_layout.blocks_.size();
+    for (size_t i = 0; swap && i < old_layout.blocks_.size(); ++i) {
+      swap = blob_info_ptr->blocks_[i] == old_layout.blocks_[i];
+    }
+  }
+  if (!swap) {
+    chi::u32 free_result = 0;
+    CHI_CO_AWAIT(FreeAllBlobBlocks(fresh, free_result));
+    CHI_CO_RETURN;
+  }
+  // The lost blocks are not freed: their target can no longer be reached
+  blob_info_ptr->blocks_ = new_layout.blocks_;
+  LogBlobBlocks(tag_id, blob_name, *blob_info_ptr);
+  UpdateWriteBackState(tag_id, blob_name, *blob_info_ptr);
+  bytes_repaired = static_cast<chi::u64>(num_lost) * shard_size;
+  erasure_shards_rebuilt_.fetch_add(num_lost, std::memory_order_relaxed);
+  HLOG(kInfo, "RepairErasureBlob: rebuilt {} of {} shards of {}", num_lost,
+       total_shards, blob_name);
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::RepairReplicas(hipc::FullPtr<RepairReplicasTask> task,
+                                        chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  task->blobs_repaired_ = 0;
+  task->bytes_repaired_ = 0;
+  task->return_code_ = 0;
+
+  // Erasure-coded blobs rebuild the shards of targets that went away
+  std::vector<chi::u32> nodes = SnapshotContainerNodes();
+  bool erasure_rescan = erasure_rescan_.exchange(false);
+  if (task->force_ || erasure_rescan || nodes != erasure_node_map_) {
+    erasure_node_map_ = nodes;
+    CHI_CO_AWAIT(
+        RepairErasureBlobs(task->blobs_repaired_, task->bytes_repaired_));
+  }
+
+  std::vector<TagId> tags;
+  {
+    chi::ScopedCoRwReadLock lock(replication_lock_);
+    for (const auto &entry : tag_replicas_) {
+      tags.push_back(entry.first);
+    }
+  }
+  if (tags.empty()) {
+    CHI_CO_RETURN;
+  }
+
+  // Only scan after RecoverContainers moved a container or a factor changed
+  bool rescan = replica_rescan_.exchange(false);
+  if (!task->force_ && !rescan && nodes == repair_node_map_) {
+    CHI_CO_RETURN;
+  }
+  repair_node_map_ = nodes;
+
+  for (const TagId &tag_id : tags) {
+    chi::u32 replicas = GetTagReplicas(tag_id);
+    if (replicas <= 1) continue;
+    std::vector<std::string> blob_names;
+    tag_blob_name_to_info_.ForEachTagBlob(
+        tag_id, "", [&blob_names](const std::string &blob_name) {
+          blob_names.push_back(blob_name);
+          return true;
+        });
+    for (const auto &blob_name : blob_names) {
+      chi::u64 bytes = 0;
+      CHI_CO_AWAIT(RepairBlobReplicas(tag_id, blob_name, replicas, bytes));
+      if (bytes > 0) {
+        task->blobs_repaired_++;
+        task->bytes_repaired_ += bytes;
+      }
+    }
+  }
+
+  HLOG(kDebug, "RepairReplicas: repaired {} blobs ({} bytes)",
+       task->blobs_repaired_, task->bytes_repaired_);
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+chi::TaskResume Runtime::RepairBlobReplicas(const TagId &tag_id,
+                                            const std::string &blob_name,
+                                            chi::u32 replicas,
+                                            chi::u64 &bytes_repaired) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  bytes_repaired = 0;
+  std::vector<chi::ContainerId> containers =
+      GetBlobReplicas(tag_id, blob_name, replicas);
+  auto self_it = std::find_if(
+      containers.begin(), containers.end(),
+      [&](chi::ContainerId id) { return IsLocalContainer(id); });
+  BlobInfo *blob_info_ptr = tag_blob_name_to_info_.Find(tag_id, blob_name);
+  if (self_it == containers.end() || !blob_info_ptr) {
+    CHI_CO_RETURN;
+  }
+  size_t self = static_cast<size_t>(self_it - containers.begin());
+  chi::u64 total_size = blob_info_ptr->GetLogicalSize();
+  if (total_size == 0) {
+    CHI_CO_RETURN;
+  }
+
+  // Probe the other replicas; a missing or differently sized copy is stale
+  std::vector<bool> present(containers.size(), false);
+  present[self] = true;
+  std::vector<size_t> probed;
+  std::vector<chi::Future<GetBlobSizeTask>> probes;
+  for (size_t i = 0; i < containers.size(); ++i) {
+    if (i == self) continue;
+    probed.push_back(i);
+    probes.push_back(client_.AsyncGetBlobSize(
+        tag_id, blob_name, chi::PoolQuery::DirectId(containers[i])));
+  }
+  for (size_t i = 0; i < probes.size(); ++i) {
+    CHI_CO_AWAIT(probes[i]);
+    present[probed[i]] =
+        probes[i]->GetReturnCode() == 0 && probes[i]->size_ == total_size;
+  }
+
+  // Each stale replica is repaired by the first holder after it in ring
+  // order, so only one container copies it
+  std::vector<chi::ContainerId> targets;
+  for (size_t i = 0; i < containers.size(); ++i) {
+    if (present[i]) continue;
+    size_t holder = (i + 1) % containers.size();
+    while (!present[holder]) holder = (holder + 1) % containers.size();
+    if (holder == self) targets.push_back(containers[i]);
+  }
+  if (targets.empty()) {
+    CHI_CO_RETURN;
+  }
+
+  BlobInfo layout;
+  layout.blocks_ = blob_info_ptr->blocks_;
+  layout.CopyErasureLayout(*blob_info_ptr);
+  float score = blob_info_ptr->score_;
+  Context put_ctx = KeepTtl(*blob_info_ptr);
+  auto *ipc_manager = CHI_IPC;
+  hipc::FullPtr<char> buffer = ipc_manager->AllocateBuffer(total_size);
+  if (buffer.IsNull()) {
+    CHI_CO_RETURN;
+  }
+  hipc::ShmPtr<> shm_ptr(buffer.shm_);
+  chi::u32 read_error = 0;
+  CHI_CO_AWAIT(ReadBlobData(layout, shm_ptr, total_size, 0, read_error));
+  if (read_error == 0) {
+    std::vector<chi::Future<PutBlobTask>> put_tasks;
+    for (chi::ContainerId target : targets) {
+      put_tasks.push_back(client_.AsyncPutBlob(
+          tag_id, blob_name, 0, total_size, shm_ptr, score, put_ctx, 0,
+          chi::PoolQuery::DirectId(target)));
+    }
+    for (auto &put_task : put_tasks) {
+      CHI_CO_AWAIT(put_task);
+      if (put_task->GetReturnCode() == 0) {
+        bytes_repaired += total_size;
+      }
+    }
+  }
+  ipc_manager->FreeBuffer(buffer);
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::SetPlacementWeights(
+    hipc::FullPtr<SetPlacementWeightsTask> task, chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  std::vector<chi::u32> weights(task->weights_.begin(), task->weights_.end());
+  auto *pool_manager = CHI_POOL_MANAGER;
+  const chi::PoolInfo *pool_info = pool_manager->GetPoolInfo(pool_id_);
+  if (pool_info == nullptr || weights.size() > pool_info->num_containers_) {
+    task->return_code_ = 1;
+    CHI_CO_RETURN;
+  }
+
+  // Empty weights go back to modulo hashing; containers past the end of
+  // the list get weight 0
+  std::shared_ptr<const HashRing> ring;
+  if (!weights.empty()) {
+    chi::u32 vnodes = task->vnodes_;
+    if (vnodes == 0) vnodes = config_.performance_.placement_vnodes_;
+    if (vnodes == 0) vnodes = kDefaultPlacementVnodes;
+    weights.resize(pool_info->num_containers_, 0);
+    ring = std::make_shared<const HashRing>(weights, vnodes);
+    if (ring->Empty()) {
+      task->return_code_ = 2;  // Every weight is zero
+      CHI_CO_RETURN;
+    }
+  }
+
+  {
+    chi::ScopedCoRwWriteLock lock(placement_lock_);
+    previous_ring_ = placement_ring_;
+    placement_ring_ = ring;
+    placement_changed_ = true;
+  }
+  rebalance_pending_.store(true);
+  replica_rescan_.store(true);
+  HLOG(kInfo, "SetPlacementWeights: {} weighted containers, {} vnodes",
+       weights.size(), ring ? ring->GetVnodes() : 0);
+  task->return_code_ = 0;
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+chi::TaskResume Runtime::RebalanceBlobs(hipc::FullPtr<RebalanceBlobsTask> task,
+                                        chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  task->blobs_moved_ = 0;
+  task->bytes_moved_ = 0;
+  task->return_code_ = 0;
+  if (!rebalance_pending_.load()) {
+    CHI_CO_RETURN;
+  }
+
+  // Collect local blobs this container no longer holds under the new ring
+  struct Move {
+    TagId tag_id_;
+    std::string blob_name_;
+    chi::ContainerId owner_;
+  };
+  std::vector<Move> moves;
+  size_t max_blobs = task->max_blobs_ > 0 ? task->max_blobs_ : 1;
+  tag_blob_name_to_info_.ForEach([&](const BlobKey &key,
+                                     const BlobInfo &) {
+    if (moves.size() >= max_blobs) {
+      return;
+    }
+    Move move;
+    move.tag_id_ = key.GetTagId();
+    move.blob_name_ = key.GetName();
+    std::vector<chi::ContainerId> holders = GetBlobReplicas(
+        move.tag_id_, move.blob_name_, GetTagReplicas(move.tag_id_));
+    if (holders.empty() ||
+        std::any_of(holders.begin(), holders.end(),
+                    [&](chi::ContainerId id) { return IsLocalContainer(id); })) {
+      return;
+    }
+    move.owner_ = holders[0];
+    moves.push_back(std::move(move));
+  });
+  if (moves.empty()) {
+    rebalance_pending_.store(false);
+    CHI_CO_RETURN;
+  }
+
+  for (const Move &move : moves) {
+    chi::u64 bytes = 0;
+    CHI_CO_AWAIT(MoveBlob(move.tag_id_, move.blob_name_, move.owner_, bytes));
+    if (bytes > 0) {
+      task->blobs_moved_++;
+      task->bytes_moved_ += bytes;
+    }
+  }
+  HLOG(kDebug, "RebalanceBlobs: moved {} of {} blobs ({} bytes)",
+       task->blobs_moved_, moves.size(), task->bytes_moved_);
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+bool Runtime::GetPreviousOwner(const TagId &tag_id,
+                               const std::string &blob_name,
+                               chi::ContainerId &owner) {
+  std::shared_ptr<const HashRing> previous;
+  {
+    chi::ScopedCoRwReadLock lock(placement_lock_);
+    if (!placement_changed_) {
+      return false;
+    }
+    previous = previous_ring_;
+  }
+  TagPlacement placement = GetTagPlacement(tag_id);
+  if (placement.policy_ == TagPlacementPolicy::kPinCreator) {
+    return false;  // Pinned blobs never move with the ring
+  }
+  chi::u32 key = PlacementKey(tag_id, blob_name, placement, previous.get());
+  if (previous) {
+    owner = previous->Lookup(key);
+  } else {
+    auto *pool_manager = CHI_POOL_MANAGER;
+    const chi::PoolInfo *pool_info = pool_manager->GetPoolInfo(pool_id_);
+    if (pool_info == nullptr || pool_info->num_containers_ == 0) {
+      return false;
+    }
+    owner = key % pool_info->num_containers_;
+  }
+  return !IsLocalContainer(owner);
+}
+
+bool Runtime::FindRedirectTarget(const TagId &tag_id,
+                                 const std::string &blob_name,
+                                 chi::ContainerId &holder) {
+  if (GetPreviousOwner(tag_id, blob_name, holder)) {
+    return true;
+  }
+  chi::u32 replicas = GetTagReplicas(tag_id);
+  if (!IsReplicaCopy(tag_id, blob_name, replicas)) {
+    return false;
+  }
+  holder = GetBlobReplicas(tag_id, blob_name, replicas)[0];
+  return true;
+}
+
+chi::TaskResume Runtime::PullFromPreviousOwner(const TagId &tag_id,
+                                               const std::string &blob_name,
+                                               chi::ContainerId owner) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  chi::PoolQuery previous = chi::PoolQuery::DirectId(owner);
+  auto size_task = client_.AsyncGetBlobSize(tag_id, blob_name, previous);
+  CHI_CO_AWAIT(size_task);
+  chi::u64 size = size_task->size_;
+  if (size_task->GetReturnCode() != 0 || size == 0) {
+    CHI_CO_RETURN;
+  }
+  auto *ipc_manager = CHI_IPC;
+  hipc::FullPtr<char> buffer = ipc_manager->AllocateBuffer(size);
+  if (buffer.IsNull()) {
+    CHI_CO_RETURN;
+  }
+  hipc::ShmPtr<> shm_ptr(buffer.shm_);
+  auto get_task = client_.AsyncGetBlob(tag_id, blob_name, 0, size,
+                                       kGetBlobNoRedirect, shm_ptr, previous);
+  CHI_CO_AWAIT(get_task);
+  if (get_task->GetReturnCode() == 0) {
+    auto put_task = client_.AsyncPutBlob(
+        tag_id, blob_name, 0, size, shm_ptr, -1.0f, Context(),
+        kPutBlobIfAbsent, chi::PoolQuery::DirectId(container_id_));
+    CHI_CO_AWAIT(put_task);
+    if (put_task->GetReturnCode() == 0) {
+      auto del_task = client_.AsyncDelBlob(tag_id, blob_name, previous);
+      CHI_CO_AWAIT(del_task);
+    }
+  }
+  ipc_manager->FreeBuffer(buffer);
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::MoveBlob(const TagId &tag_id,
+                                  const std::string &blob_name,
+                                  chi::ContainerId owner,
+                                  chi::u64 &bytes_moved) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  bytes_moved = 0;
+  BlobInfo *blob_info_ptr = tag_blob_name_to_info_.Find(tag_id, blob_name);
+  if (!blob_info_ptr) {
+    CHI_CO_RETURN;
+  }
+  BlobInfo layout;
+  layout.blocks_ = blob_info_ptr->blocks_;
+  layout.CopyErasureLayout(*blob_info_ptr);
+  Timestamp modified = blob_info_ptr->last_modified_;
+  float score = blob_info_ptr->score_;
+  Context put_ctx = KeepTtl(*blob_info_ptr);
+  chi::u64 size = layout.GetLogicalSize();
+  if (size == 0) {
+    CHI_CO_RETURN;
+  }
+
+  auto *ipc_manager = CHI_IPC;
+  hipc::FullPtr<char> buffer = ipc_manager->AllocateBuffer(size);
+  if (buffer.IsNull()) {
+    CHI_CO_RETURN;
+  }
+  hipc::ShmPtr<> shm_ptr(buffer.shm_);
+  chi::u32 read_error = 0;
+  CHI_CO_AWAIT(ReadBlobData(layout, shm_ptr, size, 0, read_error));
+  chi::u32 put_error = 1;
+  if (read_error == 0) {
+    // A write that already reached the new owner is newer than this copy
+    auto put_task = client_.AsyncPutBlob(
+        tag_id, blob_name, 0, size, shm_ptr, score, put_ctx,
+        kPutBlobIfAbsent, chi::PoolQuery::DirectId(owner));
+    CHI_CO_AWAIT(put_task);
+    put_error = put_task->GetReturnCode();
+  }
+  ipc_manager->FreeBuffer(buffer);
+
+  bool evicted = false;
+  if (put_error == 0) {
+    CHI_CO_AWAIT(EvictBlob(tag_id, blob_name, modified, evicted));
+  }
+  if (evicted) {
+    bytes_moved = size;
+  }
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::EvictBlob(const TagId &tag_id,
+                                   const std::string &blob_name,
+                                   Timestamp expected_modified,
+                                   bool &evicted) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  evicted = false;
+  BlobInfo *blob_info_ptr = tag_blob_name_to_info_.Find(tag_id, blob_name);
+  if (!blob_info_ptr || blob_info_ptr->last_modified_ != expected_modified) {
+    CHI_CO_RETURN;  // Rewritten while moving; the next pass retries
+  }
+  BlobInfo layout;
+  layout.blocks_ = blob_info_ptr->blocks_;
+  layout.CopyErasureLayout(*blob_info_ptr);
+  chi::u64 blob_size = layout.GetLogicalSize();
+
+  // Unlink before freeing so no reader sees blocks that are being reused.
+  // Only the previous primary counted the blob in its tag size.
+  tag_blob_name_to_info_.Erase(tag_id, blob_name);
+  chi::ContainerId previous_owner;
+  if (!GetPreviousOwner(tag_id, blob_name, previous_owner)) {
+    chi::ScopedCoRwWriteLock lock(tag_map_lock_);
+    TagInfo *tag_info_ptr = tag_id_to_info_.find(tag_id);
+    if (tag_info_ptr != nullptr) {
+      tag_info_ptr->total_size_ -=
+          std::min(blob_size, tag_info_ptr->total_size_);
+    }
+  }
+  MarkBlobDirty(tag_id, blob_name);
+  MarkTagDirty(tag_id);
+  if (!blob_txn_logs_.empty()) {
+    chi::u32 wid = CHI_CUR_WORKER->GetWorkerStats().worker_id_;
+    TxnDelBlob txn;
+    txn.tag_major_ = tag_id.major_;
+    txn.tag_minor_ = tag_id.minor_;
+    txn.blob_name_ = blob_name;
+    blob_txn_logs_[wid % blob_txn_logs_.size()]->Log(TxnType::kDelBlob, txn);
+  }
+
+  chi::u32 free_result = 0;
+  CHI_CO_AWAIT(FreeAllBlobBlocks(layout, free_result));
+  if (free_result != 0) {
+    HLOG(kWarning, "EvictBlob: failed to free some blocks for blob={}",
+         blob_name);
+  }
+  evicted = true;
+  CHI_CO_RETURN;
+}
 
-    // Create the expected target name based on how targets are registered
-    std::string expected_target_name = "storage_device_" + std::to_string(i);
+chi::TaskResume Runtime::CopyBlobToNode(const TagId &tag_id,
+                                        const std::string &blob_name,
+                                        chi::u32 node_id, bool &copied) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  copied = false;
+  chi::PoolQuery dest = chi::PoolQuery::Physical(node_id);
+  BlobInfo *blob_info_ptr = tag_blob_name_to_info_.Find(tag_id, blob_name);
+  if (!blob_info_ptr) {
+    // Deleted since it was copied; a miss there means it never arrived
+    auto del_task = client_.AsyncDelBlob(tag_id, blob_name, dest);
+    CHI_CO_AWAIT(del_task);
+    copied = true;
+    CHI_CO_RETURN;
+  }
+  BlobInfo layout;
+  layout.blocks_ = blob_info_ptr->blocks_;
+  layout.CopyErasureLayout(*blob_info_ptr);
+  float score = blob_info_ptr->score_;
+  Context put_ctx = KeepTtl(*blob_info_ptr);
+  chi::u64 size = layout.GetLogicalSize();
+  if (size == 0) {
+    copied = true;  // Nothing in blocks to copy, as in MoveBlob
+    CHI_CO_RETURN;
+  }
 
-    // Check if target name matches:
-    // 1. Exact match with "storage_device_N"
-    // 2. Exact match with device path
-    // 3. Starts with device path (to handle "_nodeX" suffix added during
-    // registration)
-    if (target_name == expected_target_name || target_name == device.path_ ||
-        (target_name.rfind(device.path_, 0) == 0 &&
-         (target_name.size() == device.path_.size() ||
-          target_name[device.path_.size()] == '_'))) {
-      return device.score_;  // Return configured score (-1.0f if not set)
+  auto *ipc_manager = CHI_IPC;
+  hipc::FullPtr<char> buffer = ipc_manager->AllocateBuffer(size);
+  if (buffer.IsNull()) {
+    CHI_CO_RETURN;
+  }
+  hipc::ShmPtr<> shm_ptr(buffer.shm_);
+  chi::u32 read_error = 0;
+  CHI_CO_AWAIT(ReadBlobData(layout, shm_ptr, size, 0, read_error));
+  if (read_error == 0) {
+    // A write at offset 0 replaces the whole blob there
+    auto put_task = client_.AsyncPutBlob(tag_id, blob_name, 0, size, shm_ptr,
+                                         score, put_ctx, 0, dest);
+    CHI_CO_AWAIT(put_task);
+    copied = put_task->GetReturnCode() == 0;
+  }
+  ipc_manager->FreeBuffer(buffer);
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::MigratePrecopy(chi::u32 dest_node_id,
+                                        bool final_round,
+                                        chi::u64 &remaining,
+                                        chi::RunContext &rctx) {
+  (void)rctx;
+  remaining = 0;
+  std::vector<std::string> blob_keys;
+  std::vector<TagId> tag_ids;
+
+  // The first round copies everything. Tracking starts before the scan so
+  // that writes racing with it are caught by the next round.
+  bool full_copy = !migration_active_.load(std::memory_order_acquire) ||
+                   migration_dest_ != dest_node_id;
+  if (full_copy) {
+    migration_dest_ = dest_node_id;
+    migration_active_.store(true, std::memory_order_release);
+    migration_dirty_.Drain(blob_keys, tag_ids);
+    blob_keys.clear();
+    tag_ids.clear();
+    {
+      chi::ScopedCoRwReadLock lock(tag_map_lock_);
+      tag_id_to_info_.for_each([&](const TagId &tag_id, const TagInfo &) {
+        tag_ids.push_back(tag_id);
+      });
     }
+    tag_blob_name_to_info_.ForEach([&](const BlobKey &key, const BlobInfo &) {
+      blob_keys.push_back(key.ToString());
+    });
+  } else {
+    migration_dirty_.Drain(blob_keys, tag_ids);
   }
 
-  return -1.0f;  // No manual score configured for this target
+  // Tags first so the blobs have somewhere to go. Deleted tags are left
+  // alone: DelTag would also delete the tag's blobs on other containers.
+  chi::PoolQuery dest = chi::PoolQuery::Physical(dest_node_id);
+  for (const TagId &tag_id : tag_ids) {
+    std::string tag_name;
+    {
+      chi::ScopedCoRwReadLock lock(tag_map_lock_);
+      TagInfo *tag_info_ptr = tag_id_to_info_.find(tag_id);
+      if (tag_info_ptr != nullptr) {
+        tag_name = tag_info_ptr->tag_name_.str();
+      }
+    }
+    if (tag_name.empty()) {
+      continue;
+    }
+    auto tag_task = client_.AsyncGetOrCreateTag(tag_name, tag_id, dest);
+    CHI_CO_AWAIT(tag_task);
+    if (tag_task->GetReturnCode() != 0) {
+      migration_dirty_.MarkTag(tag_id);  // Retried next round
+    }
+  }
+
+  size_t copied_blobs = 0;
+  for (const std::string &key : blob_keys) {
+    TagId tag_id;
+    std::string blob_name;
+    if (!BlobMetadataIndex::ParseKey(key, tag_id, blob_name)) {
+      continue;
+    }
+    bool copied = false;
+    CHI_CO_AWAIT(CopyBlobToNode(tag_id, blob_name, dest_node_id, copied));
+    if (copied) {
+      copied_blobs++;
+    } else {
+      migration_dirty_.MarkBlob(key);  // Retried next round
+    }
+  }
+  remaining = migration_dirty_.Size();
+  HLOG(kDebug,
+       "MigratePrecopy: container {} copied {} of {} blobs to node {}, "
+       "{} changed since",
+       container_id_, copied_blobs, blob_keys.size(), dest_node_id,
+       remaining);
+  if (!final_round) {
+    CHI_CO_RETURN;
+  }
+
+  // Plugged, so nothing changed since; what is left failed to copy. The
+  // destination serves everything else from now on, so free it here.
+  migration_active_.store(false, std::memory_order_release);
+  std::vector<std::string> unsynced_keys;
+  std::vector<TagId> unsynced_tags;
+  migration_dirty_.Drain(unsynced_keys, unsynced_tags);
+  std::unordered_set<std::string> unsynced(unsynced_keys.begin(),
+                                           unsynced_keys.end());
+  struct Local {
+    TagId tag_id_;
+    std::string blob_name_;
+    Timestamp modified_;
+  };
+  std::vector<Local> locals;
+  tag_blob_name_to_info_.ForEach(
+      [&](const BlobKey &key, const BlobInfo &blob_info) {
+        if (unsynced.count(key.ToString()) == 0) {
+          locals.push_back(
+              {key.GetTagId(), key.GetName(), blob_info.last_modified_});
+        }
+      });
+  for (const Local &local : locals) {
+    bool evicted = false;
+    CHI_CO_AWAIT(
+        EvictBlob(local.tag_id_, local.blob_name_, local.modified_, evicted));
+  }
+  if (!unsynced.empty() || !unsynced_tags.empty()) {
+    HLOG(kWarning,
+         "MigratePrecopy: container {} left {} blobs and {} tags on this "
+         "node that could not be copied to node {}",
+         container_id_, unsynced.size(), unsynced_tags.size(), dest_node_id);
+  }
+  CHI_CO_RETURN;
 }
 
-chimaera::bdev::PersistenceLevel Runtime::GetPersistenceLevelForTarget(
-    const std::string &target_name) {
-  for (size_t i = 0; i < storage_devices_.size(); ++i) {
-    const auto &device = storage_devices_[i];
-    std::string expected_target_name = "storage_device_" + std::to_string(i);
-    if (target_name == expected_target_name || target_name == device.path_ ||
-        (target_name.rfind(device.path_, 0) == 0 &&
-         (target_name.size() == device.path_.size() ||
-          target_name[device.path_.size()] == '_'))) {
-      // Convert string persistence level to enum
-      if (device.persistence_level_ == "temporary") {
-        return chimaera::bdev::PersistenceLevel::kTemporaryNonVolatile;
-      } else if (device.persistence_level_ == "long_term") {
-        return chimaera::bdev::PersistenceLevel::kLongTerm;
+chi::TaskResume Runtime::FlushData(hipc::FullPtr<FlushDataTask> task,
+                                   chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  task->bytes_flushed_ = 0;
+  task->blobs_flushed_ = 0;
+
+  // Packed objects reach their segment's target before anything is copied
+  CHI_CO_AWAIT(FlushPackSegments());
+
+  int target_level = task->target_persistence_level_;
+  size_t max_inflight = std::max<chi::u32>(task->max_inflight_, 1);
+
+  // Find non-volatile targets that meet the persistence level requirement
+  bool has_target = false;
+  {
+    chi::ScopedCoRwReadLock read_lock(target_lock_);
+    registered_targets_.for_each(
+        [&](const chi::PoolId &, const TargetInfo &info) {
+          if (static_cast<int>(info.persistence_level_) >= target_level) {
+            has_target = true;
+          }
+        });
+  }
+
+  if (!has_target) {
+    HLOG(kDebug, "FlushData: No non-volatile targets available at level >= {}",
+         target_level);
+    task->return_code_ = 0;
+    CHI_CO_RETURN;
+  }
+
+  // Take the dirty queue; blobs dirtied from here on wait for the next pass.
+  // A level other than the tracked one falls back to a full scan.
+  bool tracked =
+      target_level == config_.performance_.flush_data_min_persistence_;
+  std::deque<DirtyBlob> work;
+  if (!tracked) {
+    work = ScanDirtyBlobs(target_level, false);
+  } else {
+    if (!write_back_seeded_) {
+      ScanDirtyBlobs(target_level, true);
+      write_back_seeded_ = true;
+    }
+    hshm::ScopedMutex guard(write_back_lock_, 0);
+    work.swap(write_back_queue_);
+  }
+
+  HLOG(kDebug, "FlushData: {} dirty blobs queued for write-back", work.size());
+
+  // Two-stage pipeline: the next batch is read from the volatile tier while
+  // the current batch is written to the persistent tier
+  auto *ipc_manager = CHI_IPC;
+  Context flush_ctx;
+  flush_ctx.min_persistence_level_ = target_level;
+  std::vector<FlushItem> items;
+  CHI_CO_AWAIT(ReadFlushBatch(work, max_inflight, target_level, items));
+  while (!items.empty()) {
+    std::vector<FlushItem> writing;
+    std::vector<chi::Future<PutBlobTask>> put_tasks;
+    for (auto &item : items) {
+      // Do not overwrite a write that landed while the blob was being read
+      BlobInfo *blob_info_ptr = tag_blob_name_to_info_.Find(
+          item.blob_.tag_id_, item.blob_.blob_name_);
+      if (!blob_info_ptr ||
+          blob_info_ptr->last_modified_ != item.last_modified_) {
+        if (tracked && blob_info_ptr) RequeueWriteBack(item.blob_);
+        ipc_manager->FreeBuffer(item.buffer_);
+        continue;
       }
-      return chimaera::bdev::PersistenceLevel::kVolatile;
+      hipc::ShmPtr<> shm_ptr(item.buffer_.shm_);
+      put_tasks.push_back(client_.AsyncPutBlob(
+          item.blob_.tag_id_, item.blob_.blob_name_, 0, item.size_, shm_ptr,
+          item.score_, KeepTtl(*blob_info_ptr, flush_ctx), 0,
+          SelfQuery()));
+      writing.push_back(std::move(item));
+    }
+    items.clear();
+    CHI_CO_AWAIT(ReadFlushBatch(work, max_inflight, target_level, items));
+
+    for (size_t i = 0; i < put_tasks.size(); ++i) {
+      CHI_CO_AWAIT(put_tasks[i]);
+      if (put_tasks[i]->GetReturnCode() != 0) {
+        HLOG(kError, "FlushData: PutBlob failed for blob {} (error {})",
+             writing[i].blob_.blob_name_, put_tasks[i]->GetReturnCode());
+        if (tracked) RequeueWriteBack(writing[i].blob_);
+      } else {
+        task->blobs_flushed_++;
+        task->bytes_flushed_ += writing[i].size_;
+      }
+      ipc_manager->FreeBuffer(writing[i].buffer_);
     }
   }
-  return chimaera::bdev::PersistenceLevel::kVolatile;
+
+  task->return_code_ = 0;
+  HLOG(kDebug, "FlushData: Flushed {} blobs ({} bytes)", task->blobs_flushed_,
+       task->bytes_flushed_);
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
 }
 
-TagId Runtime::GetOrAssignTagId(const std::string &tag_name,
-                                const TagId &preferred_id) {
-  chi::ScopedCoRwWriteLock write_lock(tag_map_lock_);
+bool Runtime::HasBlocksBelow(const BlobInfo &blob_info, int level) {
+  for (const auto &block : blob_info.blocks_) {
+    TargetInfo *tinfo = registered_targets_.find(block.target_id_);
+    if (tinfo && static_cast<int>(tinfo->persistence_level_) < level) {
+      return true;
+    }
+  }
+  return false;
+}
 
-  // Check if tag already exists
-  TagId *existing_tag_id_ptr = tag_name_to_id_.find(tag_name);
-  if (existing_tag_id_ptr != nullptr) {
-    return *existing_tag_id_ptr;
+void Runtime::UpdateWriteBackState(const TagId &tag_id,
+                                   const std::string &blob_name,
+                                   BlobInfo &blob_info) {
+  bool dirty;
+  {
+    chi::ScopedCoRwReadLock read_lock(target_lock_);
+    dirty = HasBlocksBelow(blob_info,
+                           config_.performance_.flush_data_min_persistence_);
+  }
+  if (!dirty) {
+    blob_info.dirty_since_ = 0;
+    return;
+  }
+  if (blob_info.dirty_since_ != 0) {
+    return;  // Already queued
   }
+  blob_info.dirty_since_ = GetCurrentTimeNs();
+  hshm::ScopedMutex guard(write_back_lock_, 0);
+  write_back_queue_.push_back(
+      DirtyBlob{tag_id, blob_name, blob_info.dirty_since_});
+}
 
-  // Assign new tag ID
-  TagId tag_id;
-  if ((preferred_id.major_ != 0 || preferred_id.minor_ != 0) &&
-      !tag_id_to_info_.contains(preferred_id)) {
-    tag_id = preferred_id;
-  } else {
-    tag_id = GenerateNewTagId();
+std::deque<Runtime::DirtyBlob> Runtime::ScanDirtyBlobs(int level,
+                                                       bool track) {
+  std::vector<std::pair<Timestamp, DirtyBlob>> found;
+  {
+    chi::ScopedCoRwReadLock read_lock(target_lock_);
+    tag_blob_name_to_info_.ForEach([&](const BlobKey &key,
+                                       const BlobInfo &blob_info) {
+      bool queued = track && blob_info.dirty_since_ != 0;
+      if (queued || !HasBlocksBelow(blob_info, level)) {
+        return;
+      }
+      DirtyBlob blob;
+      blob.tag_id_ = key.GetTagId();
+      blob.blob_name_ = key.GetName();
+      found.emplace_back(blob_info.last_modified_, std::move(blob));
+    });
   }
+  std::stable_sort(found.begin(), found.end(),
+                   [](const auto &a, const auto &b) {
+                     return a.first < b.first;
+                   });
+
+  std::deque<DirtyBlob> blobs;
+  Timestamp now = GetCurrentTimeNs();
+  for (auto &entry : found) {
+    if (track) {
+      BlobInfo *blob_info_ptr = tag_blob_name_to_info_.Find(
+          entry.second.tag_id_, entry.second.blob_name_);
+      if (!blob_info_ptr || blob_info_ptr->dirty_since_ != 0) continue;
+      blob_info_ptr->dirty_since_ = entry.first != 0 ? entry.first : now;
+      entry.second.dirty_since_ = blob_info_ptr->dirty_since_;
+    }
+    blobs.push_back(std::move(entry.second));
+  }
+  if (track) {
+    hshm::ScopedMutex guard(write_back_lock_, 0);
+    write_back_queue_.insert(write_back_queue_.begin(), blobs.begin(),
+                             blobs.end());
+  }
+  return blobs;
+}
 
-  // Create tag info (use default constructor, allocator not used in struct)
-  TagInfo tag_info;
-  tag_info.tag_name_ = tag_name;
-  tag_info.tag_id_ = tag_id;
+chi::TaskResume Runtime::ReadFlushBatch(std::deque<DirtyBlob> &work,
+                                        size_t max_items, int level,
+                                        std::vector<FlushItem> &items) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  auto *ipc_manager = CHI_IPC;
+  while (items.size() < max_items && !work.empty()) {
+    DirtyBlob blob = std::move(work.front());
+    work.pop_front();
+
+    // Skip deleted blobs, blobs already flushed and stale queue entries
+    BlobInfo *blob_info_ptr =
+        tag_blob_name_to_info_.Find(blob.tag_id_, blob.blob_name_);
+    if (!blob_info_ptr) continue;
+    if (blob.dirty_since_ != 0) {
+      if (blob_info_ptr->dirty_since_ != blob.dirty_since_) continue;
+    } else {
+      chi::ScopedCoRwReadLock read_lock(target_lock_);
+      if (!HasBlocksBelow(*blob_info_ptr, level)) continue;
+    }
+
+    // Snapshot the layout so a concurrent rewrite cannot free it mid-read
+    FlushItem item;
+    BlobInfo layout;
+    layout.blocks_ = blob_info_ptr->blocks_;
+    layout.CopyErasureLayout(*blob_info_ptr);
+    item.size_ = layout.GetLogicalSize();
+    item.score_ = blob_info_ptr->score_;
+    item.last_modified_ = blob_info_ptr->last_modified_;
+    if (item.size_ == 0) continue;
+    item.buffer_ = ipc_manager->AllocateBuffer(item.size_);
+    if (item.buffer_.IsNull()) {
+      HLOG(kError,
+           "FlushData: Failed to allocate buffer of size {} for blob {}",
+           item.size_, blob.blob_name_);
+      if (blob.dirty_since_ != 0) RequeueWriteBack(blob);
+      continue;
+    }
+    hipc::ShmPtr<> shm_ptr(item.buffer_.shm_);
+    chi::u32 read_error = 0;
+    CHI_CO_AWAIT(ReadBlobData(layout, shm_ptr, item.size_, 0, read_error));
+    if (read_error != 0) {
+      HLOG(kError, "FlushData: Failed to read blob data for {}",
+           blob.blob_name_);
+      ipc_manager->FreeBuffer(item.buffer_);
+      continue;
+    }
+    item.blob_ = std::move(blob);
+    items.push_back(std::move(item));
+  }
+  CHI_CO_RETURN;
+}
+
+void Runtime::RequeueWriteBack(const DirtyBlob &blob) {
+  hshm::ScopedMutex guard(write_back_lock_, 0);
+  write_back_queue_.push_front(blob);
+}
+
+chi::TaskResume Runtime::DefragBlobs(hipc::FullPtr<DefragBlobsTask> task,
+                                     chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  task->blobs_defragmented_ = 0;
+  task->bytes_moved_ = 0;
+
+  // A single block cannot be made any more contiguous
+  size_t min_blocks = std::max<size_t>(task->min_blocks_, 2);
+
+  // Collect fragmented blobs first; data is rewritten outside the scan
+  std::vector<std::pair<TagId, std::string>> candidates;
+  tag_blob_name_to_info_.ForEach([&](const BlobKey &key,
+                                     const BlobInfo &blob_info) {
+    if (blob_info.blocks_.size() < min_blocks) return;
+    candidates.emplace_back(key.GetTagId(), key.GetName());
+  });
+
+  for (const auto &candidate : candidates) {
+    chi::u64 bytes_moved = 0;
+    CHI_CO_AWAIT(DefragBlob(candidate.first, candidate.second, min_blocks,
+                            bytes_moved));
+    if (bytes_moved > 0) {
+      task->blobs_defragmented_++;
+      task->bytes_moved_ += bytes_moved;
+    }
+  }
+
+  // Packing segments mostly freed by deletes and overwrites
+  chi::u64 objects_moved = 0;
+  chi::u64 object_bytes = 0;
+  CHI_CO_AWAIT(CleanPackSegments(objects_moved, object_bytes));
+  task->blobs_defragmented_ += objects_moved;
+  task->bytes_moved_ += object_bytes;
+
+  task->return_code_ = 0;
+  HLOG(kDebug, "DefragBlobs: Rewrote {} of {} fragmented blobs ({} bytes)",
+       task->blobs_defragmented_, candidates.size(), task->bytes_moved_);
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
+
+chi::TaskResume Runtime::DefragBlob(const TagId &tag_id,
+                                    const std::string &blob_name,
+                                    size_t min_blocks, chi::u64 &bytes_moved) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  bytes_moved = 0;
+  BlobInfo *blob_info_ptr = tag_blob_name_to_info_.Find(tag_id, blob_name);
+  if (!blob_info_ptr || blob_info_ptr->blocks_.size() < min_blocks) {
+    CHI_CO_RETURN;
+  }
+
+  // Keep the data at least as durable as its least durable block
+  int min_persistence_level = 0;
+  {
+    chi::ScopedCoRwReadLock read_lock(target_lock_);
+    bool first = true;
+    for (const auto &block : blob_info_ptr->blocks_) {
+      TargetInfo *tinfo = registered_targets_.find(block.target_id_);
+      if (tinfo == nullptr) continue;
+      int level = static_cast<int>(tinfo->persistence_level_);
+      min_persistence_level =
+          first ? level : std::min(min_persistence_level, level);
+      first = false;
+    }
+  }
+
+  // Only worth it if the copy is less fragmented
+  CHI_CO_AWAIT(RelocateBlob(
+      tag_id, blob_name, blob_info_ptr->score_, min_persistence_level,
+      [](const BlobInfo &old_layout, const BlobInfo &new_layout) {
+        return new_layout.blocks_.size() < old_layout.blocks_.size();
+      },
+      bytes_moved));
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::RelocateBlob(
+    const TagId &tag_id, const std::string &blob_name, float score,
+    int min_persistence_level,
+    const std::function<bool(const BlobInfo &, const BlobInfo &)> &accept,
+    chi::u64 &bytes_moved,
+    const std::unordered_set<chi::PoolId> *exclude_targets) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  bytes_moved = 0;
+  BlobInfo *blob_info_ptr = tag_blob_name_to_info_.Find(tag_id, blob_name);
+  // A single allocation would put an erasure-coded blob's shards on
+  // shared targets; such blobs move by being rewritten instead
+  if (!blob_info_ptr || blob_info_ptr->IsErasureCoded()) {
+    CHI_CO_RETURN;
+  }
+
+  // Snapshot the current layout and modification time
+  BlobInfo old_layout;
+  old_layout.blocks_ = blob_info_ptr->blocks_;
+  Timestamp old_modified = blob_info_ptr->last_modified_;
+  chi::u64 total_size = old_layout.GetTotalSize();
+  if (total_size == 0) {
+    CHI_CO_RETURN;
+  }
+
+  // Place the copy first: a rejected layout costs no read, and the staging
+  // buffer can depend on where both copies live
+  BlobInfo new_layout;
+  chi::u32 io_error = 0;
+  CHI_CO_AWAIT(ExtendBlob(new_layout, 0, total_size, score, io_error,
+                          min_persistence_level, exclude_targets));
+  bool swap = io_error == 0 && accept(old_layout, new_layout);
+  if (swap) {
+    // Between hbm and gds targets the data stays in device memory: the
+    // bdevs DMA it with cudaMemcpy and cuFile instead of through DRAM
+    auto *ipc_manager = CHI_IPC;
+    hipc::FullPtr<char> buffer;
+    char *device_buffer = nullptr;
+#if HSHM_ENABLE_CUDA
+    if (IsDeviceLayout(old_layout) && IsDeviceLayout(new_layout) &&
+        cudaMalloc(reinterpret_cast<void **>(&device_buffer), total_size) !=
+            cudaSuccess) {
+      cudaGetLastError();
+      device_buffer = nullptr;
+    }
+#endif
+    hipc::ShmPtr<> shm_ptr;
+    if (device_buffer != nullptr) {
+      shm_ptr = hipc::ShmPtr<>::FromRaw(device_buffer);
+    } else {
+      buffer = ipc_manager->AllocateBuffer(total_size);
+      if (buffer.IsNull()) {
+        HLOG(kError,
+             "RelocateBlob: Failed to allocate buffer of size {} for {}",
+             total_size, blob_name);
+        io_error = 1;
+      } else {
+        shm_ptr = hipc::ShmPtr<>(buffer.shm_);
+      }
+    }
+    if (io_error == 0) {
+      CHI_CO_AWAIT(
+          ReadData(old_layout.blocks_, shm_ptr, total_size, 0, io_error));
+    }
+    if (io_error == 0) {
+      CHI_CO_AWAIT(ModifyExistingData(new_layout.blocks_, shm_ptr, total_size,
+                                      0, io_error));
+    }
+    swap = io_error == 0;
+#if HSHM_ENABLE_CUDA
+    if (device_buffer != nullptr) {
+      cudaFree(device_buffer);
+    }
+#endif
+    if (!buffer.IsNull()) {
+      ipc_manager->FreeBuffer(buffer);
+    }
+  }
 
-  // Store mappings
-  tag_name_to_id_.insert_or_assign(tag_name, tag_id);
-  tag_id_to_info_.insert_or_assign(tag_id, tag_info);
+  // Only swap if no writer touched the blob while the copy was in flight
+  if (swap) {
+    blob_info_ptr = tag_blob_name_to_info_.Find(tag_id, blob_name);
+    swap = blob_info_ptr != nullptr &&
+           blob_info_ptr->last_modified_ == old_modified &&
+           blob_info_ptr->blocks_.size() == old_layout.blocks_.size();
+    for (size_t i = 0; swap && i < old_layout.blocks_.size(); ++i) {
+      swap = blob_info_ptr->blocks_[i] == old_layout.blocks_[i];
+    }
+  }
+  chi::u32 free_result = 0;
+  if (!swap) {
+    CHI_CO_AWAIT(FreeAllBlobBlocks(new_layout, free_result));
+    CHI_CO_RETURN;
+  }
+  size_t old_count = old_layout.blocks_.size();
+  size_t new_count = new_layout.blocks_.size();
+  blob_info_ptr->blocks_ = new_layout.blocks_;
+  blob_info_ptr->score_ = score;
+  LogBlobBlocks(tag_id, blob_name, *blob_info_ptr);
+  UpdateWriteBackState(tag_id, blob_name, *blob_info_ptr);
+  CHI_CO_AWAIT(FreeAllBlobBlocks(old_layout, free_result));
+  bytes_moved = total_size;
+  HLOG(kDebug, "RelocateBlob: {} rewritten from {} to {} blocks (score {})",
+       blob_name, old_count, new_count, score);
+  CHI_CO_RETURN;
+}
 
-  // WAL: log tag creation
-  if (!tag_txn_logs_.empty()) {
-    chi::u32 wid = CHI_CUR_WORKER->GetWorkerStats().worker_id_;
-    TxnCreateTag txn;
-    txn.tag_name_ = tag_name;
-    txn.tag_major_ = tag_id.major_;
-    txn.tag_minor_ = tag_id.minor_;
-    tag_txn_logs_[wid % tag_txn_logs_.size()]->Log(TxnType::kCreateTag, txn);
+bool Runtime::IsDeviceLayout(const BlobInfo &layout) {
+  chi::ScopedCoRwReadLock read_lock(target_lock_);
+  for (const BlobBlock &block : layout.blocks_) {
+    TargetInfo *target_info = registered_targets_.find(block.target_id_);
+    if (target_info == nullptr ||
+        (target_info->bdev_type_ != chimaera::bdev::BdevType::kHbm &&
+         target_info->bdev_type_ != chimaera::bdev::BdevType::kGds)) {
+      return false;
+    }
   }
+  return !layout.blocks_.empty();
+}
 
-  return tag_id;
+bool Runtime::IsDramLayout(const BlobInfo &layout) {
+  chi::ScopedCoRwReadLock read_lock(target_lock_);
+  for (const BlobBlock &block : layout.blocks_) {
+    TargetInfo *target_info = registered_targets_.find(block.target_id_);
+    if (target_info == nullptr ||
+        (target_info->bdev_type_ != chimaera::bdev::BdevType::kRam &&
+         target_info->bdev_type_ != chimaera::bdev::BdevType::kHbm &&
+         target_info->bdev_type_ != chimaera::bdev::BdevType::kPinned)) {
+      return false;
+    }
+  }
+  return true;
 }
 
-chi::TaskResume Runtime::FlushMetadata(hipc::FullPtr<FlushMetadataTask> task,
-                                       chi::RunContext &ctx) {
+chi::TaskResume Runtime::MigrateBlobs(hipc::FullPtr<MigrateBlobsTask> task,
+                                      chi::RunContext &ctx) {
 #ifdef __NVCOMPILER
   chi::RunContext& rctx = ctx;
 #else
   (void)ctx;
 #endif
   CHI_TASK_BODY_BEGIN
-  task->entries_flushed_ = 0;
-
-  const std::string &log_path = config_.performance_.metadata_log_path_;
-  if (log_path.empty()) {
+  task->blobs_promoted_ = 0;
+  task->blobs_demoted_ = 0;
+  task->bytes_moved_ = 0;
+
+  // Decay heat and refill the bandwidth budget for the time since the last
+  // pass. Unused budget carries over, up to a few seconds' worth.
+  Timestamp now = GetCurrentTimeNs();
+  double elapsed_ms =
+      migrate_last_pass_ == 0 ? 0.0 : (now - migrate_last_pass_) / 1e6;
+  migrate_last_pass_ = now;
+  double half_life_ms = std::max<double>(task->half_life_ms_, 1.0);
+  UpdateBlobHeat(std::exp2(-elapsed_ms / half_life_ms));
+  double bytes_per_ms = task->bandwidth_mbps_ * 1024.0 * 1024.0 / 1000.0;
+  migrate_credit_bytes_ =
+      std::min(migrate_credit_bytes_ + elapsed_ms * bytes_per_ms,
+               kMigrateMaxCreditMs * bytes_per_ms);
+
+  // Tiers are the score range of the registered targets
+  std::unordered_map<chi::PoolId, float> target_scores;
+  float fastest = 0.0f;
+  float slowest = 1.0f;
+  {
+    chi::ScopedCoRwReadLock read_lock(target_lock_);
+    registered_targets_.for_each(
+        [&](const chi::PoolId &target_id, const TargetInfo &target_info) {
+          target_scores[target_id] = target_info.target_score_;
+          fastest = std::max(fastest, target_info.target_score_);
+          slowest = std::min(slowest, target_info.target_score_);
+        });
+  }
+  float min_diff = GetConfig().performance_.score_difference_threshold_;
+  if (target_scores.empty() || fastest - slowest < min_diff) {
     task->return_code_ = 0;
     CHI_CO_RETURN;
   }
 
-  try {
-    namespace fs = std::filesystem;
-    fs::create_directories(fs::path(log_path).parent_path());
-
-    std::ofstream ofs(log_path, std::ios::binary | std::ios::trunc);
-    if (!ofs.is_open()) {
-      HLOG(kError, "FlushMetadata: Failed to open log file: {}", log_path);
-      task->return_code_ = 1;
-      CHI_CO_RETURN;
-    }
-
-    // Write TagInfo entries (entry_type 0)
-    tag_id_to_info_.for_each([&](const TagId &id, const TagInfo &info) {
-      uint8_t entry_type = 0;
-      uint32_t name_len = static_cast<uint32_t>(info.tag_name_.size());
-      chi::u64 total_size = info.total_size_;
-      ofs.write(reinterpret_cast<const char *>(&entry_type),
-                sizeof(entry_type));
-      ofs.write(reinterpret_cast<const char *>(&name_len), sizeof(name_len));
-      ofs.write(info.tag_name_.data(), name_len);
-      ofs.write(reinterpret_cast<const char *>(&id), sizeof(id));
-      ofs.write(reinterpret_cast<const char *>(&total_size),
-                sizeof(total_size));
-      task->entries_flushed_++;
-    });
-
-    // Write BlobInfo entries (entry_type 1)
-    tag_blob_name_to_info_.for_each([&](const std::string &key,
-                                        const BlobInfo &blob_info) {
-      uint8_t entry_type = 1;
-      uint32_t key_len = static_cast<uint32_t>(key.size());
-      uint32_t blob_name_len =
-          static_cast<uint32_t>(blob_info.blob_name_.size());
-      float score = blob_info.score_;
-      int32_t compress_lib = blob_info.compress_lib_;
-      int32_t compress_preset = blob_info.compress_preset_;
-      chi::u64 trace_key = blob_info.trace_key_;
-      uint32_t num_blocks = static_cast<uint32_t>(blob_info.blocks_.size());
-
-      ofs.write(reinterpret_cast<const char *>(&entry_type),
-                sizeof(entry_type));
-      ofs.write(reinterpret_cast<const char *>(&key_len), sizeof(key_len));
-      ofs.write(key.data(), key_len);
-      ofs.write(reinterpret_cast<const char *>(&blob_name_len),
-                sizeof(blob_name_len));
-      ofs.write(blob_info.blob_name_.data(), blob_name_len);
-      ofs.write(reinterpret_cast<const char *>(&score), sizeof(score));
-      ofs.write(reinterpret_cast<const char *>(&compress_lib),
-                sizeof(compress_lib));
-      ofs.write(reinterpret_cast<const char *>(&compress_preset),
-                sizeof(compress_preset));
-      ofs.write(reinterpret_cast<const char *>(&trace_key), sizeof(trace_key));
-      ofs.write(reinterpret_cast<const char *>(&num_blocks),
-                sizeof(num_blocks));
-
-      // Write per-block data
-      for (const auto &block : blob_info.blocks_) {
-        chi::u32 bdev_major = block.bdev_client_.pool_id_.major_;
-        chi::u32 bdev_minor = block.bdev_client_.pool_id_.minor_;
-        ofs.write(reinterpret_cast<const char *>(&bdev_major),
-                  sizeof(bdev_major));
-        ofs.write(reinterpret_cast<const char *>(&bdev_minor),
-                  sizeof(bdev_minor));
-
-        // Write target_query as raw bytes (POD-like struct)
-        ofs.write(reinterpret_cast<const char *>(&block.target_query_),
-                  sizeof(chi::PoolQuery));
-
-        chi::u64 offset = block.target_offset_;
-        chi::u64 size = block.size_;
-        ofs.write(reinterpret_cast<const char *>(&offset), sizeof(offset));
-        ofs.write(reinterpret_cast<const char *>(&size), sizeof(size));
-      }
-      task->entries_flushed_++;
-    });
-
-    ofs.close();
+  // Pick hot blobs off slow tiers and cold blobs off fast ones
+  struct Candidate {
+    TagId tag_id_;
+    std::string blob_name_;
+    double heat_;
+    float tier_;
+  };
+  std::vector<Candidate> promote, demote;
+  tag_blob_name_to_info_.ForEach([&](const BlobKey &key,
+                                     const BlobInfo &blob_info) {
+    auto it = blob_heat_.find(key);
+    if (it == blob_heat_.end() || blob_info.blocks_.empty()) return;
+    double heat = it->second.heat_;
+    bool hot = heat >= task->promote_heat_;
+    bool cold = heat <= task->demote_heat_;
+    if (!hot && !cold) return;
+    float tier = LayoutTierScore(blob_info.blocks_, target_scores);
+    if (hot ? tier > fastest - min_diff : tier < slowest + min_diff) return;
+    Candidate candidate;
+    candidate.tag_id_ = key.GetTagId();
+    candidate.blob_name_ = key.GetName();
+    candidate.heat_ = heat;
+    candidate.tier_ = tier;
+    (hot ? promote : demote).push_back(std::move(candidate));
+  });
+  std::sort(promote.begin(), promote.end(),
+            [](const Candidate &a, const Candidate &b) {
+              return a.heat_ > b.heat_;
+            });
+  std::sort(demote.begin(), demote.end(),
+            [](const Candidate &a, const Candidate &b) {
+              return a.heat_ < b.heat_;
+            });
 
-    // WAL: sync and compact transaction logs after snapshot
-    if (!blob_txn_logs_.empty()) {
-      chi::u64 total_wal_size = 0;
-      for (auto &log : blob_txn_logs_) {
-        if (log) {
-          log->Sync();
-          total_wal_size += log->Size();
-        }
-      }
-      for (auto &log : tag_txn_logs_) {
-        if (log) {
-          log->Sync();
-          total_wal_size += log->Size();
-        }
-      }
-      if (total_wal_size >
-          config_.performance_.transaction_log_capacity_bytes_) {
-        for (auto &log : blob_txn_logs_) {
-          if (log) log->Truncate();
-        }
-        for (auto &log : tag_txn_logs_) {
-          if (log) log->Truncate();
-        }
-        HLOG(kDebug, "FlushMetadata: Truncated WAL files (was {} bytes)",
-             total_wal_size);
+  // Demote first so the fast tier has room for the promotions. A blob moves
+  // only if the budget covers it and the copy really changed tier.
+  for (int phase = 0; phase < 2; ++phase) {
+    bool promoting = phase == 1;
+    float score = promoting ? fastest : slowest;
+    for (const auto &candidate : promoting ? promote : demote) {
+      BlobInfo *blob_info_ptr =
+          tag_blob_name_to_info_.Find(candidate.tag_id_, candidate.blob_name_);
+      if (blob_info_ptr == nullptr ||
+          blob_info_ptr->GetTotalSize() > migrate_credit_bytes_) {
+        continue;
       }
+      float old_tier = candidate.tier_;
+      chi::u64 bytes_moved = 0;
+      CHI_CO_AWAIT(RelocateBlob(
+          candidate.tag_id_, candidate.blob_name_, score, 0,
+          [&](const BlobInfo &, const BlobInfo &new_layout) {
+            float new_tier = LayoutTierScore(new_layout.blocks_, target_scores);
+            return promoting ? new_tier > old_tier : new_tier < old_tier;
+          },
+          bytes_moved));
+      if (bytes_moved == 0) continue;
+      migrate_credit_bytes_ -= static_cast<double>(bytes_moved);
+      task->bytes_moved_ += bytes_moved;
+      (promoting ? task->blobs_promoted_ : task->blobs_demoted_)++;
     }
-
-    task->return_code_ = 0;
-    HLOG(kDebug, "FlushMetadata: Flushed {} entries to {}",
-         task->entries_flushed_, log_path);
-  } catch (const std::exception &e) {
-    HLOG(kError, "FlushMetadata: Exception: {}", e.what());
-    task->return_code_ = 99;
   }
+
+  task->return_code_ = 0;
+  HLOG(kDebug, "MigrateBlobs: Promoted {} and demoted {} blobs ({} bytes)",
+       task->blobs_promoted_, task->blobs_demoted_, task->bytes_moved_);
   CHI_CO_RETURN;
   CHI_TASK_BODY_END
 }
 
-chi::TaskResume Runtime::FlushData(hipc::FullPtr<FlushDataTask> task,
-                                   chi::RunContext &ctx) {
+chi::TaskResume Runtime::EvictTargets(hipc::FullPtr<EvictTargetsTask> task,
+                                      chi::RunContext &ctx) {
 #ifdef __NVCOMPILER
   chi::RunContext& rctx = ctx;
 #else
   (void)ctx;
 #endif
   CHI_TASK_BODY_BEGIN
-  task->bytes_flushed_ = 0;
-  task->blobs_flushed_ = 0;
-
-  int target_level = task->target_persistence_level_;
-
-  // Find non-volatile targets that meet the persistence level requirement
-  std::vector<chi::PoolId> nonvolatile_targets;
+  task->blobs_evicted_ = 0;
+  task->bytes_evicted_ = 0;
+
+  // Every tier but the slowest caches data for the tiers below it
+  struct TargetUsage {
+    float score_;
+    chi::u64 capacity_;
+    chi::u64 remaining_;
+  };
+  std::unordered_map<chi::PoolId, TargetUsage> usage;
+  float slowest = 1.0f;
   {
     chi::ScopedCoRwReadLock read_lock(target_lock_);
     registered_targets_.for_each(
-        [&](const chi::PoolId &id, const TargetInfo &info) {
-          if (static_cast<int>(info.persistence_level_) >= target_level) {
-            nonvolatile_targets.push_back(id);
-          }
+        [&](const chi::PoolId &target_id, const TargetInfo &target_info) {
+          usage[target_id] = {target_info.target_score_,
+                              target_info.capacity_,
+                              target_info.remaining_space_};
+          slowest = std::min(slowest, target_info.target_score_);
         });
   }
-
-  if (nonvolatile_targets.empty()) {
-    HLOG(kDebug, "FlushData: No non-volatile targets available at level >= {}",
-         target_level);
+  float min_diff = GetConfig().performance_.score_difference_threshold_;
+  std::unordered_set<chi::PoolId> fast_targets;
+  std::unordered_set<chi::PoolId> pressured;
+  chi::u64 cache_bytes = 0;
+  for (const auto &[target_id, target] : usage) {
+    if (target.capacity_ == 0 || target.score_ < slowest + min_diff) continue;
+    fast_targets.insert(target_id);
+    cache_bytes += target.capacity_;
+    chi::u64 used =
+        target.capacity_ - std::min(target.remaining_, target.capacity_);
+    if (used > task->high_watermark_ * target.capacity_) {
+      pressured.insert(target_id);
+    }
+  }
+  if (fast_targets.empty()) {
     task->return_code_ = 0;
     CHI_CO_RETURN;
   }
 
-  // Collect blobs that have volatile blocks
-  struct FlushEntry {
-    std::string composite_key;
-    std::string blob_name;
-    TagId tag_id;
-    chi::u64 total_size;
-    float score;
-  };
-  std::vector<FlushEntry> blobs_to_flush;
-
-  {
-    chi::ScopedCoRwReadLock read_lock(target_lock_);
-    tag_blob_name_to_info_.for_each([&](const std::string &key,
-                                        const BlobInfo &blob_info) {
-      if (blob_info.blocks_.empty()) return;
-
-      bool has_volatile_blocks = false;
-      for (const auto &block : blob_info.blocks_) {
-        chi::PoolId pool_id = block.bdev_client_.pool_id_;
-        TargetInfo *tinfo = registered_targets_.find(pool_id);
-        if (tinfo &&
-            static_cast<int>(tinfo->persistence_level_) < target_level) {
-          has_volatile_blocks = true;
-          break;
-        }
+  // Show the policy every blob, with its reads since the previous pass.
+  // A read blob counts once, or its share of the tag's reads if higher.
+  std::unordered_map<TagId, chi::u64> tag_reads =
+      CountTagReads(evict_logical_time_);
+  std::unordered_map<TagId, chi::u64> tag_read_blobs;
+  std::unordered_map<BlobKey, Timestamp, BlobKeyHash> last_reads;
+  std::vector<EvictionCandidate> blobs;
+  std::unordered_map<chi::PoolId, std::vector<size_t>> victims_on;
+  tag_blob_name_to_info_.ForEach([&](const BlobKey &key,
+                                     const BlobInfo &blob_info) {
+    EvictionCandidate blob;
+    blob.key_ = key;
+    blob.last_access_ =
+        std::max(blob_info.last_read_, blob_info.last_modified_);
+    auto it = evict_last_read_.find(key);
+    if (it != evict_last_read_.end() && blob_info.last_read_ > it->second) {
+      blob.reads_ = 1;
+      tag_read_blobs[key.GetTagId()]++;
+    }
+    last_reads.emplace(key, blob_info.last_read_);
+    std::unordered_set<chi::PoolId> holders;
+    for (const auto &block : blob_info.blocks_) {
+      if (fast_targets.count(block.target_id_) != 0) {
+        blob.size_ += block.size_;
+        holders.insert(block.target_id_);
       }
-
-      if (has_volatile_blocks) {
-        FlushEntry entry;
-        entry.composite_key = key;
-        entry.blob_name = blob_info.blob_name_.str();
-        entry.total_size = blob_info.GetTotalSize();
-        entry.score = blob_info.score_;
-
-        // Parse tag_id from composite key: "major.minor.blob_name"
-        size_t first_dot = key.find('.');
-        size_t second_dot = key.find('.', first_dot + 1);
-        if (first_dot != std::string::npos && second_dot != std::string::npos) {
-          entry.tag_id.major_ =
-              static_cast<chi::u32>(std::stoul(key.substr(0, first_dot)));
-          entry.tag_id.minor_ = static_cast<chi::u32>(std::stoul(
-              key.substr(first_dot + 1, second_dot - first_dot - 1)));
+    }
+    blob.resident_ = blob.size_ > 0;
+    // RelocateBlob leaves erasure-coded blobs in place
+    if (!blob_info.IsErasureCoded()) {
+      for (const chi::PoolId &holder : holders) {
+        if (pressured.count(holder) != 0) {
+          victims_on[holder].push_back(blobs.size());
         }
-
-        blobs_to_flush.push_back(std::move(entry));
       }
-    });
+    }
+    blobs.push_back(std::move(blob));
+  });
+  for (auto &blob : blobs) {
+    if (blob.reads_ == 0) continue;
+    TagId tag_id = blob.key_.GetTagId();
+    blob.reads_ = std::max<chi::u64>(
+        1, tag_reads[tag_id] / std::max<chi::u64>(1, tag_read_blobs[tag_id]));
+  }
+  evict_last_read_ = std::move(last_reads);
+  evict_policy_->Update(blobs, cache_bytes);
+
+  // Demote victims to the next lower tier until each target is drained to
+  // its low watermark. Copies avoid every target under pressure.
+  for (const chi::PoolId &target_id : pressured) {
+    const TargetUsage &target = usage[target_id];
+    float demote_score = slowest;
+    for (const auto &entry : usage) {
+      if (entry.second.score_ < target.score_ - min_diff) {
+        demote_score = std::max(demote_score, entry.second.score_);
+      }
+    }
+    std::vector<EvictionCandidate> victims;
+    for (size_t index : victims_on[target_id]) {
+      victims.push_back(blobs[index]);
+    }
+    evict_policy_->RankVictims(victims);
+    chi::u64 low_used =
+        static_cast<chi::u64>(task->low_watermark_ * target.capacity_);
+    for (const auto &victim : victims) {
+      chi::u64 remaining = 0;
+      {
+        chi::ScopedCoRwReadLock read_lock(target_lock_);
+        TargetInfo *target_info = registered_targets_.find(target_id);
+        if (target_info == nullptr) break;
+        remaining = target_info->remaining_space_;
+      }
+      if (target.capacity_ - std::min(remaining, target.capacity_) <=
+          low_used) {
+        break;
+      }
+      chi::u64 bytes_moved = 0;
+      CHI_CO_AWAIT(RelocateBlob(
+          victim.key_.GetTagId(), victim.key_.GetName(), demote_score, 0,
+          [&](const BlobInfo &, const BlobInfo &new_layout) {
+            for (const auto &block : new_layout.blocks_) {
+              if (block.target_id_ == target_id) return false;
+            }
+            return true;
+          },
+          bytes_moved, &pressured));
+      if (bytes_moved == 0) continue;
+      evict_policy_->OnEvict(victim.key_);
+      task->blobs_evicted_++;
+      task->bytes_evicted_ += bytes_moved;
+    }
   }
 
-  HLOG(kDebug, "FlushData: Found {} blobs with volatile blocks to flush",
-       blobs_to_flush.size());
-
-  // Flush each blob: read data, free volatile blocks, re-put with persistence
-  for (const auto &entry : blobs_to_flush) {
-    BlobInfo *blob_info_ptr = tag_blob_name_to_info_.find(entry.composite_key);
-    if (!blob_info_ptr || blob_info_ptr->blocks_.empty()) continue;
-
-    chi::u64 total_size = entry.total_size;
-    if (total_size == 0) continue;
+  evict_blobs_.fetch_add(task->blobs_evicted_, std::memory_order_relaxed);
+  evict_bytes_.fetch_add(task->bytes_evicted_, std::memory_order_relaxed);
+  task->return_code_ = 0;
+  if (task->blobs_evicted_ > 0) {
+    HLOG(kDebug, "EvictTargets: Demoted {} blobs ({} bytes) off {} targets",
+         task->blobs_evicted_, task->bytes_evicted_, pressured.size());
+  }
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
 
-    // Step 1: Allocate buffer and read data from current blocks
-    auto *ipc_manager = CHI_IPC;
-    hipc::FullPtr<char> buffer = ipc_manager->AllocateBuffer(total_size);
-    if (buffer.IsNull()) {
-      HLOG(kError,
-           "FlushData: Failed to allocate buffer of size {} for blob {}",
-           total_size, entry.blob_name);
-      continue;
-    }
+chi::TaskResume Runtime::ExpireBlobs(hipc::FullPtr<ExpireBlobsTask> task,
+                                     chi::RunContext &ctx) {
+#ifdef __NVCOMPILER
+  chi::RunContext& rctx = ctx;
+#else
+  (void)ctx;
+#endif
+  CHI_TASK_BODY_BEGIN
+  task->blobs_expired_ = 0;
+  task->bytes_expired_ = 0;
+  std::vector<std::pair<BlobKey, Timestamp>> due;
+  {
+    hshm::ScopedMutex guard(expiry_lock_, 0);
+    expiry_wheel_.Advance(GetCurrentTimeNs(),
+                          [&due](const BlobKey &key, chi::u64 deadline) {
+                            due.emplace_back(key, deadline);
+                          });
+  }
 
-    hipc::ShmPtr<> shm_ptr(buffer.shm_);
-    chi::u32 read_error = 0;
-    CHI_CO_AWAIT(ReadData(blob_info_ptr->blocks_, shm_ptr, total_size, 0,
-                      read_error));
-    if (read_error != 0) {
-      HLOG(kError, "FlushData: Failed to read blob data for {}",
-           entry.blob_name);
-      ipc_manager->FreeBuffer(buffer);
+  // The blocks of every expired blob are freed together, one FreeBlocks
+  // per target
+  BlobInfo freed;
+  for (const auto &[key, deadline] : due) {
+    const TagId &tag_id = key.GetTagId();
+    std::string blob_name = key.GetName();
+    // Entries left behind by a rewrite or a delete no longer match; replica
+    // copies go when their primary deletes them
+    BlobInfo *blob_info_ptr = CheckBlobExists(blob_name, tag_id);
+    if (blob_info_ptr == nullptr || blob_info_ptr->expire_time_ != deadline ||
+        IsReplicaCopy(tag_id, blob_name, GetTagReplicas(tag_id))) {
       continue;
     }
+    chi::u64 blob_size = 0;
+    CHI_CO_AWAIT(
+        RemoveBlob(tag_id, blob_name, *blob_info_ptr, &freed, blob_size));
+    task->blobs_expired_++;
+    task->bytes_expired_ += blob_size;
+  }
+  if (!freed.blocks_.empty()) {
+    chi::u32 free_result = 0;
+    CHI_CO_AWAIT(FreeAllBlobBlocks(freed, free_result));
+  }
 
-    // Step 2: Free only volatile blocks
-    chi::priv::vector<BlobBlock> nonvolatile_blocks(CHI_PRIV_ALLOC);
-    std::unordered_map<
-        chi::PoolId,
-        std::pair<chi::PoolQuery, std::vector<chimaera::bdev::Block>>>
-        volatile_blocks_by_pool;
+  expired_blobs_.fetch_add(task->blobs_expired_, std::memory_order_relaxed);
+  expired_bytes_.fetch_add(task->bytes_expired_, std::memory_order_relaxed);
+  task->return_code_ = 0;
+  if (task->blobs_expired_ > 0) {
+    HLOG(kDebug, "ExpireBlobs: Freed {} blobs ({} bytes)",
+         task->blobs_expired_, task->bytes_expired_);
+  }
+  CHI_CO_RETURN;
+  CHI_TASK_BODY_END
+}
 
-    {
-      chi::ScopedCoRwReadLock read_lock(target_lock_);
-      for (const auto &block : blob_info_ptr->blocks_) {
-        chi::PoolId pool_id = block.bdev_client_.pool_id_;
-        TargetInfo *tinfo = registered_targets_.find(pool_id);
-        if (tinfo &&
-            static_cast<int>(tinfo->persistence_level_) < target_level) {
-          // Volatile block - collect for freeing
-          chimaera::bdev::Block bdev_block;
-          bdev_block.offset_ = block.target_offset_;
-          bdev_block.size_ = block.size_;
-          bdev_block.block_type_ = 0;
-          if (volatile_blocks_by_pool.find(pool_id) ==
-              volatile_blocks_by_pool.end()) {
-            volatile_blocks_by_pool[pool_id] = std::make_pair(
-                block.target_query_, std::vector<chimaera::bdev::Block>());
-          }
-          volatile_blocks_by_pool[pool_id].second.push_back(bdev_block);
-        } else {
-          // Nonvolatile block - keep
-          nonvolatile_blocks.push_back(block);
-        }
-      }
+void Runtime::UpdateBlobHeat(double decay) {
+  // GetBlob calls per tag since the previous pass
+  std::unordered_map<TagId, chi::u64> tag_reads =
+      CountTagReads(heat_logical_time_);
+
+  // Decay every blob and note which were read since the previous pass
+  chi::u64 pass = ++migrate_pass_;
+  std::vector<std::pair<BlobHeat *, TagId>> read_blobs;
+  std::unordered_map<TagId, chi::u64> tag_read_blobs;
+  tag_blob_name_to_info_.ForEach([&](const BlobKey &key,
+                                     const BlobInfo &blob_info) {
+    auto inserted = blob_heat_.try_emplace(key);
+    BlobHeat &heat = inserted.first->second;
+    heat.pass_ = pass;
+    if (inserted.second) {
+      heat.last_read_ = blob_info.last_read_;
+      return;
     }
-
-    // Free volatile blocks from bdevs
-    for (const auto &pool_entry : volatile_blocks_by_pool) {
-      const chi::PoolId &pool_id = pool_entry.first;
-      const chi::PoolQuery &target_query = pool_entry.second.first;
-      const std::vector<chimaera::bdev::Block> &blocks =
-          pool_entry.second.second;
-
-      chi::u64 bytes_freed = 0;
-      for (const auto &block : blocks) {
-        bytes_freed += block.size_;
-      }
-
-      chimaera::bdev::Client bdev_client(pool_id);
-      auto free_task = bdev_client.AsyncFreeBlocks(target_query, blocks);
-      CHI_CO_AWAIT(free_task);
-      if (free_task->GetReturnCode() == 0) {
-        chi::ScopedCoRwWriteLock write_lock(target_lock_);
-        TargetInfo *target_info = registered_targets_.find(pool_id);
-        if (target_info) {
-          target_info->remaining_space_ += bytes_freed;
-        }
-      }
+    heat.heat_ *= decay;
+    if (blob_info.last_read_ > heat.last_read_) {
+      heat.last_read_ = blob_info.last_read_;
+      read_blobs.emplace_back(&heat, key.GetTagId());
+      tag_read_blobs[key.GetTagId()]++;
     }
+  });
 
-    // Update blob blocks to only keep nonvolatile blocks
-    blob_info_ptr->blocks_ = nonvolatile_blocks;
+  // Each read blob counts once, or its share of the tag's reads if higher
+  for (auto &read_blob : read_blobs) {
+    double share = static_cast<double>(tag_reads[read_blob.second]) /
+                   tag_read_blobs[read_blob.second];
+    read_blob.first->heat_ += std::max(1.0, share);
+  }
 
-    // Step 3: Re-put data using AsyncPutBlob with persistence context
-    Context flush_ctx;
-    flush_ctx.min_persistence_level_ = target_level;
-    auto put_task =
-        client_.AsyncPutBlob(entry.tag_id, entry.blob_name, 0, total_size,
-                             shm_ptr, entry.score, flush_ctx);
-    CHI_CO_AWAIT(put_task);
+  // Forget blobs that no longer exist
+  for (auto it = blob_heat_.begin(); it != blob_heat_.end();) {
+    it = it->second.pass_ == pass ? std::next(it) : blob_heat_.erase(it);
+  }
+}
 
-    if (put_task->GetReturnCode() != 0) {
-      HLOG(kError, "FlushData: PutBlob failed for blob {} (error {})",
-           entry.blob_name, put_task->GetReturnCode());
-    } else {
-      task->blobs_flushed_++;
-      task->bytes_flushed_ += total_size;
+std::unordered_map<TagId, chi::u64> Runtime::CountTagReads(
+    std::uint64_t &logical_time) {
+  std::vector<CteTelemetry> entries;
+  GetTelemetryEntries(entries, logical_time + 1, SIZE_MAX);
+  std::unordered_map<TagId, chi::u64> tag_reads;
+  chi::u64 weight = telemetry_log_.GetSampleRate();
+  for (const auto &entry : entries) {
+    logical_time = std::max(logical_time, entry.logical_time_);
+    if (entry.op_ == CteOp::kGetBlob) {
+      tag_reads[entry.tag_id_] += weight;
     }
-
-    ipc_manager->FreeBuffer(buffer);
   }
+  return tag_reads;
+}
 
-  task->return_code_ = 0;
-  HLOG(kDebug, "FlushData: Flushed {} blobs ({} bytes)", task->blobs_flushed_,
-       task->bytes_flushed_);
-  CHI_CO_RETURN;
-  CHI_TASK_BODY_END
+float Runtime::LayoutTierScore(
+    const BlobBlockList &blocks,
+    const std::unordered_map<chi::PoolId, float> &target_scores) {
+  double weighted = 0.0;
+  double total = 0.0;
+  for (const auto &block : blocks) {
+    auto it = target_scores.find(block.target_id_);
+    if (it == target_scores.end()) continue;
+    weighted += static_cast<double>(it->second) * block.size_;
+    total += static_cast<double>(block.size_);
+  }
+  return total > 0 ? static_cast<float>(weighted / total) : 0.0f;
 }
 
 void Runtime::RestoreMetadataFromLog() {
@@ -1887,143 +6711,440 @@ void Runtime::RestoreMetadataFromLog() {
     return;
   }
 
+  chi::u32 max_minor = 0;
+  chi::u32 tags_restored = 0;
+  chi::u32 blobs_restored = 0;
+
+  // Base image first, then the deltas written since it, oldest first
   namespace fs = std::filesystem;
-  if (!fs::exists(log_path)) {
+  std::vector<chi::u64> deltas = MetadataCheckpoint::ListDeltas(log_path);
+  if (!fs::exists(log_path) && deltas.empty()) {
     HLOG(kInfo, "RestoreMetadataFromLog: No log file found at {}", log_path);
     return;
   }
+  // A snapshot written before the hash was recorded was placed by kLegacy
+  auto volatile_targets = SnapshotVolatileTargets();
+  BlobHashId hash_id = BlobHashId::kLegacy;
+  size_t deferred = 0;
+  if (fs::exists(log_path) &&
+      !AttachBaseImage(log_path, volatile_targets, max_minor, tags_restored,
+                       hash_id, deferred)) {
+    LoadCheckpointFile(log_path, volatile_targets, max_minor, tags_restored,
+                       blobs_restored, hash_id);
+  }
+  for (chi::u64 seq : deltas) {
+    LoadCheckpointFile(MetadataCheckpoint::DeltaPath(log_path, seq),
+                       volatile_targets, max_minor, tags_restored,
+                       blobs_restored, hash_id);
+  }
+  if (!deltas.empty()) {
+    next_delta_seq_ = deltas.back() + 1;
+  }
+  blob_hash_id_ = hash_id;
 
-  std::ifstream ifs(log_path, std::ios::binary);
-  if (!ifs.is_open()) {
-    HLOG(kError, "RestoreMetadataFromLog: Failed to open log file: {}",
-         log_path);
-    return;
+  // Update next_tag_id_minor_ to be past any restored tag IDs
+  chi::u32 current_minor = next_tag_id_minor_.load();
+  if (max_minor > current_minor) {
+    next_tag_id_minor_.store(max_minor);
   }
 
-  chi::u32 max_minor = 0;
-  chi::u32 tags_restored = 0;
+  HLOG(kInfo,
+       "RestoreMetadataFromLog: Restored {} tags and {} blobs from {} "
+       "({} deltas, {} tags deferred, blob hash id {})",
+       tags_restored, blobs_restored, log_path, deltas.size(), deferred,
+       static_cast<chi::u32>(blob_hash_id_));
+}
+
+bool Runtime::AttachBaseImage(
+    const std::string &path,
+    const std::unordered_set<chi::PoolId> &volatile_targets,
+    chi::u32 &max_minor, chi::u32 &tags_restored, BlobHashId &hash_id,
+    size_t &deferred) {
+  auto image = std::make_unique<MappedFile>();
+  CheckpointTagIndex index;
+  if (!image->Open(path) || !index.Parse(image->data(), image->size())) {
+    // Written before images carried an index, or torn
+    return false;
+  }
+  if ((index.flags_ & CheckpointTagIndex::kNoSharedBlocks) == 0) {
+    // Counting shared extents needs every blob, so load them all
+    return false;
+  }
+
+  // The hash id and the tags precede the blob sections
+  CheckpointReader reader(image->data(), index.blobs_begin_);
   chi::u32 blobs_restored = 0;
+  LoadCheckpointEntries(reader, path, volatile_targets, max_minor,
+                        tags_restored, blobs_restored, hash_id);
+
+  std::vector<TagId> tag_ids;
+  tag_ids.reserve(index.sections_.size());
+  for (const auto &section : index.sections_) {
+    deferred_sections_[section.tag_id_] = section;
+    tag_ids.push_back(section.tag_id_);
+  }
+  deferred_volatile_targets_ = volatile_targets;
+  base_image_ = std::move(image);
+  tag_blob_name_to_info_.DeferTags(
+      tag_ids, [this](const TagId &tag_id) { return LoadDeferredTag(tag_id); });
+  deferred = tag_ids.size();
+  return true;
+}
 
-  while (ifs.peek() != EOF) {
-    uint8_t entry_type;
-    ifs.read(reinterpret_cast<char *>(&entry_type), sizeof(entry_type));
-    if (!ifs.good()) break;
-
-    if (entry_type == 0) {
-      // TagInfo entry
-      uint32_t name_len;
-      ifs.read(reinterpret_cast<char *>(&name_len), sizeof(name_len));
-      std::string tag_name(name_len, '\0');
-      ifs.read(tag_name.data(), name_len);
-      TagId tag_id;
-      ifs.read(reinterpret_cast<char *>(&tag_id), sizeof(tag_id));
-      chi::u64 total_size;
-      ifs.read(reinterpret_cast<char *>(&total_size), sizeof(total_size));
+std::vector<BlobPatch> Runtime::LoadDeferredTag(const TagId &tag_id) {
+  std::vector<BlobPatch> patches;
+  auto it = deferred_sections_.find(tag_id);
+  if (it == deferred_sections_.end() || !base_image_) {
+    return patches;
+  }
+  const CheckpointTagIndex::Section &section = it->second;
+  if (!CheckpointTagIndex::Verify(base_image_->data(), section)) {
+    HLOG(kError,
+         "LoadDeferredTag: Checksum mismatch in the blobs of tag ({},{}), "
+         "they are not restored",
+         tag_id.major_, tag_id.minor_);
+    return patches;
+  }
+
+  CheckpointReader reader(base_image_->data() + section.begin_,
+                          section.end_ - section.begin_);
+  while (reader.HasMore()) {
+    uint8_t entry_type = 0;
+    reader.Read(entry_type);
+    auto kind = static_cast<CheckpointEntry>(entry_type);
+    if (kind != CheckpointEntry::kBlob && kind != CheckpointEntry::kBlobStub &&
+        kind != CheckpointEntry::kBlobErasure &&
+        kind != CheckpointEntry::kBlobEncrypted) {
+      break;
+    }
+    std::string composite_key;
+    BlobPatch patch;
+    if (!ReadBlobEntry(reader, deferred_volatile_targets_, composite_key,
+                       patch.info_, kind == CheckpointEntry::kBlobStub,
+                       kind == CheckpointEntry::kBlobErasure,
+                       kind == CheckpointEntry::kBlobEncrypted)) {
+      break;
+    }
+    if (BlobMetadataIndex::ParseKey(composite_key, patch.tag_id_,
+                                    patch.blob_name_)) {
+      patch.insert_ = true;
+      patches.push_back(std::move(patch));
+    }
+  }
+
+  // A blob the restart replayed may have linked one of these extents
+  if (!restart_blocks_.empty()) {
+    hshm::ScopedMutex guard(block_refs_lock_, 0);
+    for (const auto &patch : patches) {
+      for (const auto &block : patch.info_.blocks_) {
+        if (restart_blocks_.count(block) != 0) {
+          chi::u32 &refs = block_refs_[block];
+          refs = refs == 0 ? 2 : refs + 1;
+        }
+      }
+    }
+  }
+  HLOG(kDebug, "LoadDeferredTag: Loaded {} blobs of tag ({},{})",
+       patches.size(), tag_id.major_, tag_id.minor_);
+  return patches;
+}
+
+std::unordered_set<chi::PoolId> Runtime::SnapshotVolatileTargets() {
+  std::unordered_set<chi::PoolId> volatile_targets;
+  chi::ScopedCoRwReadLock read_lock(target_lock_);
+  registered_targets_.for_each(
+      [&](const chi::PoolId &target_id, const TargetInfo &info) {
+        if (info.persistence_level_ ==
+            chimaera::bdev::PersistenceLevel::kVolatile) {
+          volatile_targets.insert(target_id);
+        }
+      });
+  return volatile_targets;
+}
+
+bool Runtime::LoadCheckpointFile(
+    const std::string &path,
+    const std::unordered_set<chi::PoolId> &volatile_targets,
+    chi::u32 &max_minor, chi::u32 &tags_restored, chi::u32 &blobs_restored,
+    BlobHashId &hash_id) {
+  MappedFile file;
+  if (!file.Open(path)) {
+    HLOG(kError, "RestoreMetadataFromLog: Failed to open log file: {}", path);
+    return false;
+  }
+  CheckpointReader reader(file);
+  LoadCheckpointEntries(reader, path, volatile_targets, max_minor,
+                        tags_restored, blobs_restored, hash_id);
+  return true;
+}
+
+void Runtime::LoadCheckpointEntries(
+    CheckpointReader &reader, const std::string &path,
+    const std::unordered_set<chi::PoolId> &volatile_targets,
+    chi::u32 &max_minor, chi::u32 &tags_restored, chi::u32 &blobs_restored,
+    BlobHashId &hash_id) {
+  // Blob entries are inserted in bulk, into tables sized for all of them
+  std::vector<BlobPatch> patches;
+  auto apply_patches = [&]() {
+    tag_blob_name_to_info_.Reserve(tag_blob_name_to_info_.Size() +
+                                   patches.size());
+    tag_blob_name_to_info_.ApplyPatches(patches);
+    patches.clear();
+  };
 
-      if (!ifs.good()) break;
+  while (reader.HasMore()) {
+    uint8_t entry_type = 0;
+    reader.Read(entry_type);
 
-      // Populate maps
+    if (entry_type == static_cast<uint8_t>(CheckpointEntry::kTag)) {
+      uint32_t name_len = 0;
+      reader.Read(name_len);
+      std::string tag_name;
+      reader.ReadString(tag_name, name_len);
+      TagId tag_id;
+      reader.Read(tag_id);
+      chi::u64 total_size = 0;
+      reader.Read(total_size);
+      if (!reader.good()) break;
+
+      // A deferred tag rewritten by a delta is loaded, so that
+      // ReplayTransactionLogs recounts its size
+      tag_blob_name_to_info_.Materialize(tag_id);
       tag_name_to_id_.insert_or_assign(tag_name, tag_id);
       TagInfo tag_info(tag_name, tag_id);
       tag_info.total_size_ = total_size;
       tag_id_to_info_.insert_or_assign(tag_id, tag_info);
-
       if (tag_id.minor_ >= max_minor) {
         max_minor = tag_id.minor_ + 1;
       }
       tags_restored++;
 
-    } else if (entry_type == 1) {
-      // BlobInfo entry
-      uint32_t key_len;
-      ifs.read(reinterpret_cast<char *>(&key_len), sizeof(key_len));
-      std::string composite_key(key_len, '\0');
-      ifs.read(composite_key.data(), key_len);
-
-      uint32_t blob_name_len;
-      ifs.read(reinterpret_cast<char *>(&blob_name_len), sizeof(blob_name_len));
-      std::string blob_name(blob_name_len, '\0');
-      ifs.read(blob_name.data(), blob_name_len);
-
-      float score;
-      ifs.read(reinterpret_cast<char *>(&score), sizeof(score));
-      int32_t compress_lib;
-      ifs.read(reinterpret_cast<char *>(&compress_lib), sizeof(compress_lib));
-      int32_t compress_preset;
-      ifs.read(reinterpret_cast<char *>(&compress_preset),
-               sizeof(compress_preset));
-      chi::u64 trace_key;
-      ifs.read(reinterpret_cast<char *>(&trace_key), sizeof(trace_key));
-      uint32_t num_blocks;
-      ifs.read(reinterpret_cast<char *>(&num_blocks), sizeof(num_blocks));
-
-      if (!ifs.good()) break;
-
-      BlobInfo blob_info;
-      blob_info.blob_name_ = blob_name;
-      blob_info.score_ = score;
-      blob_info.compress_lib_ = compress_lib;
-      blob_info.compress_preset_ = compress_preset;
-      blob_info.trace_key_ = trace_key;
-
-      // Read per-block data
-      for (uint32_t i = 0; i < num_blocks; i++) {
-        chi::u32 bdev_major, bdev_minor;
-        ifs.read(reinterpret_cast<char *>(&bdev_major), sizeof(bdev_major));
-        ifs.read(reinterpret_cast<char *>(&bdev_minor), sizeof(bdev_minor));
-
-        // Read target_query as raw bytes (POD-like struct)
-        chi::PoolQuery target_query;
-        ifs.read(reinterpret_cast<char *>(&target_query),
-                 sizeof(chi::PoolQuery));
-
-        chi::u64 offset, size;
-        ifs.read(reinterpret_cast<char *>(&offset), sizeof(offset));
-        ifs.read(reinterpret_cast<char *>(&size), sizeof(size));
-
-        if (!ifs.good()) break;
-
-        // Filter by persistence level: skip volatile blocks
-        chi::PoolId bdev_pool_id(bdev_major, bdev_minor);
-        bool is_volatile = false;
-        {
-          chi::ScopedCoRwReadLock read_lock(target_lock_);
-          TargetInfo *tinfo = registered_targets_.find(bdev_pool_id);
-          if (tinfo && tinfo->persistence_level_ ==
-                           chimaera::bdev::PersistenceLevel::kVolatile) {
-            is_volatile = true;
-          }
-        }
-        if (is_volatile) {
-          continue;  // Volatile data is lost on restart
+    } else if (entry_type == static_cast<uint8_t>(CheckpointEntry::kBlob) ||
+               entry_type ==
+                   static_cast<uint8_t>(CheckpointEntry::kBlobStub) ||
+               entry_type ==
+                   static_cast<uint8_t>(CheckpointEntry::kBlobErasure) ||
+               entry_type ==
+                   static_cast<uint8_t>(CheckpointEntry::kBlobEncrypted)) {
+      std::string composite_key;
+      BlobPatch patch;
+      bool is_stub =
+          entry_type == static_cast<uint8_t>(CheckpointEntry::kBlobStub);
+      bool is_erasure =
+          entry_type == static_cast<uint8_t>(CheckpointEntry::kBlobErasure);
+      bool is_encrypted =
+          entry_type == static_cast<uint8_t>(CheckpointEntry::kBlobEncrypted);
+      if (!ReadBlobEntry(reader, volatile_targets, composite_key,
+                         patch.info_, is_stub, is_erasure, is_encrypted)) {
+        break;
+      }
+      if (BlobMetadataIndex::ParseKey(composite_key, patch.tag_id_,
+                                      patch.blob_name_)) {
+        patch.insert_ = true;
+        patches.push_back(std::move(patch));
+        blobs_restored++;
+      }
+
+    } else if (entry_type == static_cast<uint8_t>(CheckpointEntry::kDelTag)) {
+      TagId tag_id;
+      reader.Read(tag_id);
+      if (!reader.good()) break;
+      apply_patches();  // Earlier blob entries may belong to the tag
+      TagInfo *tag_info = tag_id_to_info_.find(tag_id);
+      if (tag_info != nullptr) {
+        std::string tag_name = tag_info->tag_name_.str();
+        TagId *mapped_id = tag_name_to_id_.find(tag_name);
+        if (mapped_id != nullptr && *mapped_id == tag_id) {
+          tag_name_to_id_.erase(tag_name);
         }
+        tag_id_to_info_.erase(tag_id);
+      }
+      tag_blob_name_to_info_.EraseTag(tag_id);
+
+    } else if (entry_type ==
+               static_cast<uint8_t>(CheckpointEntry::kDelBlob)) {
+      uint32_t key_len = 0;
+      reader.Read(key_len);
+      std::string composite_key;
+      reader.ReadString(composite_key, key_len);
+      if (!reader.good()) break;
+      BlobPatch patch;
+      if (BlobMetadataIndex::ParseKey(composite_key, patch.tag_id_,
+                                      patch.blob_name_)) {
+        patch.erase_ = true;
+        patches.push_back(std::move(patch));
+      }
+
+    } else if (entry_type == static_cast<uint8_t>(CheckpointEntry::kHashId)) {
+      uint32_t id = 0;
+      reader.Read(id);
+      if (!reader.good()) break;
+      if (id > static_cast<uint32_t>(BlobHashId::kHashBytes)) {
+        HLOG(kError,
+             "RestoreMetadataFromLog: Unknown blob hash id {} in {}, "
+             "blobs may be routed to the wrong container",
+             id, path);
+      } else {
+        hash_id = static_cast<BlobHashId>(id);
+      }
 
-        // Reconstruct block
-        chimaera::bdev::Client bdev_client(bdev_pool_id);
-        BlobBlock block(bdev_client, target_query, offset, size);
-        blob_info.blocks_.push_back(block);
+    } else if (entry_type ==
+               static_cast<uint8_t>(CheckpointEntry::kPackSegments)) {
+      // Each file lists every segment allocated when it was written
+      uint32_t count = 0;
+      reader.Read(count);
+      std::unordered_map<chi::PoolId, std::map<chi::u64, chi::u64>> segments;
+      for (uint32_t i = 0; i < count && reader.good(); ++i) {
+        chi::u32 bdev_major = 0, bdev_minor = 0;
+        chi::u64 base = 0, size = 0;
+        reader.Read(bdev_major);
+        reader.Read(bdev_minor);
+        reader.Read(base);
+        reader.Read(size);
+        segments[chi::PoolId(bdev_major, bdev_minor)][base] = size;
+      }
+      if (!reader.good()) break;
+      restored_pack_segments_ = std::move(segments);
+
+    } else if (entry_type ==
+               static_cast<uint8_t>(CheckpointEntry::kTagPolicies)) {
+      // Each file lists every tag policy set when it was written
+      uint32_t count = 0;
+      reader.Read(count);
+      std::vector<TxnTagPolicy> policies;
+      for (uint32_t i = 0; i < count && reader.good(); ++i) {
+        TxnTagPolicy txn;
+        reader.Read(txn.tag_major_);
+        reader.Read(txn.tag_minor_);
+        reader.Read(txn.replicas_);
+        reader.Read(txn.placement_policy_);
+        reader.Read(txn.stripe_pages_);
+        reader.Read(txn.pin_container_);
+        reader.Read(txn.follow_major_);
+        reader.Read(txn.follow_minor_);
+        reader.Read(txn.dedup_chunk_);
+        policies.push_back(txn);
+      }
+      if (!reader.good()) break;
+      {
+        chi::ScopedCoRwWriteLock lock(replication_lock_);
+        tag_replicas_.clear();
+      }
+      {
+        chi::ScopedCoRwWriteLock lock(placement_lock_);
+        tag_placement_.clear();
+      }
+      {
+        chi::ScopedCoRwWriteLock lock(dedup_lock_);
+        tag_dedup_.clear();
+      }
+      for (const auto &txn : policies) {
+        ApplyTagPolicy(txn);
       }
 
-      tag_blob_name_to_info_.insert_or_assign(composite_key, blob_info);
-      blobs_restored++;
+    } else if (entry_type ==
+               static_cast<uint8_t>(CheckpointEntry::kTagIndex)) {
+      break;  // The index closes a base image
 
     } else {
-      HLOG(kWarning, "RestoreMetadataFromLog: Unknown entry type {}",
-           entry_type);
+      HLOG(kWarning, "RestoreMetadataFromLog: Unknown entry type {} in {}",
+           entry_type, path);
       break;
     }
   }
+  apply_patches();
+}
 
-  ifs.close();
-
-  // Update next_tag_id_minor_ to be past any restored tag IDs
-  chi::u32 current_minor = next_tag_id_minor_.load();
-  if (max_minor > current_minor) {
-    next_tag_id_minor_.store(max_minor);
+bool Runtime::ReadBlobEntry(
+    CheckpointReader &reader,
+    const std::unordered_set<chi::PoolId> &volatile_targets, std::string &key,
+    BlobInfo &blob_info, bool is_stub, bool is_erasure, bool is_encrypted) {
+  uint32_t key_len = 0;
+  reader.Read(key_len);
+  reader.ReadString(key, key_len);
+
+  uint32_t blob_name_len = 0;
+  reader.Read(blob_name_len);
+  std::string blob_name;
+  reader.ReadString(blob_name, blob_name_len);
+
+  float score = 0;
+  reader.Read(score);
+  int32_t compress_lib = 0;
+  reader.Read(compress_lib);
+  int32_t compress_preset = 0;
+  reader.Read(compress_preset);
+  chi::u64 trace_key = 0;
+  reader.Read(trace_key);
+  uint32_t num_blocks = 0;
+  reader.Read(num_blocks);
+
+  if (!reader.good()) return false;
+
+  blob_info.blob_name_ = blob_name;
+  blob_info.score_ = score;
+  blob_info.compress_lib_ = compress_lib;
+  blob_info.compress_preset_ = compress_preset;
+  blob_info.trace_key_ = trace_key;
+
+  // Read per-block data
+  for (uint32_t i = 0; i < num_blocks; i++) {
+    chi::u32 bdev_major = 0, bdev_minor = 0;
+    reader.Read(bdev_major);
+    reader.Read(bdev_minor);
+
+    // Read target_query as raw bytes (POD-like struct); the registered
+    // target's query supersedes it at I/O time
+    chi::PoolQuery target_query;
+    reader.Read(target_query);
+
+    chi::u64 offset = 0, size = 0;
+    reader.Read(offset);
+    reader.Read(size);
+
+    if (!reader.good()) return false;
+
+    // Filter by persistence level: volatile data is lost on restart. An
+    // erasure-coded blob keeps the bytes' place on a null target so its
+    // shards stay aligned; the shard is then rebuilt from the others. An
+    // encrypted blob does the same so its other chunks stay readable.
+    chi::PoolId bdev_pool_id(bdev_major, bdev_minor);
+    if (volatile_targets.count(bdev_pool_id) != 0) {
+      if ((is_erasure || is_encrypted) && size != 0) {
+        blob_info.blocks_.push_back(
+            BlobBlock(chi::PoolId::GetNull(), 0, size));
+      }
+      continue;
+    }
+    // Lists are restored as written: dedup chunks keep their own extents
+    // even when adjacent, since other blobs reference them one by one
+    if (size != 0) {
+      blob_info.blocks_.push_back(BlobBlock(bdev_pool_id, offset, size));
+    }
   }
-
-  HLOG(kInfo, "RestoreMetadataFromLog: Restored {} tags and {} blobs from {}",
-       tags_restored, blobs_restored, log_path);
+  if (is_erasure) {
+    reader.Read(blob_info.erasure_data_);
+    reader.Read(blob_info.erasure_parity_);
+    reader.Read(blob_info.erasure_shard_);
+    reader.Read(blob_info.erasure_size_);
+    return reader.good();
+  }
+  if (is_encrypted) {
+    reader.Read(blob_info.encrypt_chunk_);
+    reader.Read(blob_info.encrypt_size_);
+    return reader.good();
+  }
+  if (!is_stub) return true;
+
+  uint32_t path_len = 0;
+  reader.Read(path_len);
+  std::string stub_path;
+  reader.ReadString(stub_path, path_len);
+  reader.Read(blob_info.stub_offset_);
+  reader.Read(blob_info.stub_size_);
+  reader.Read(blob_info.stub_flags_);
+  blob_info.stub_path_ = stub_path;
+  return reader.good();
 }
 
 void Runtime::ReplayTransactionLogs() {
@@ -2037,21 +7158,21 @@ void Runtime::ReplayTransactionLogs() {
   // Phase 1: Replay all tag logs first (tags must exist before blob ops)
   for (size_t i = 0;; ++i) {
     std::string tag_log_path = log_path + ".tag." + std::to_string(i);
-    if (!std::filesystem::exists(tag_log_path)) break;
+    if (!TransactionLog::Exists(tag_log_path)) break;
 
     TransactionLog loader;
     loader.Open(tag_log_path, 0);
-    auto entries = loader.Load();
-    loader.Close();
-
-    for (const auto &[type, payload] : entries) {
+    loader.ForEachRecord([&](TxnType type, const char *payload, size_t) {
       if (type == TxnType::kCreateTag) {
         auto txn = TransactionLog::DeserializeCreateTag(payload);
         TagId tag_id{txn.tag_major_, txn.tag_minor_};
+        // Phase 4 recounts the size of the tag, so its blobs must be loaded
+        tag_blob_name_to_info_.Materialize(tag_id);
         tag_name_to_id_.insert_or_assign(txn.tag_name_, tag_id);
         TagInfo tag_info(txn.tag_name_, tag_id);
         tag_id_to_info_.insert_or_assign(tag_id, tag_info);
         if (tag_id.minor_ >= max_minor) max_minor = tag_id.minor_ + 1;
+        if (base_image_) replayed_tag_ids_.push_back(tag_id);
         tags_replayed++;
       } else if (type == TxnType::kDelTag) {
         auto txn = TransactionLog::DeserializeDelTag(payload);
@@ -2059,128 +7180,225 @@ void Runtime::ReplayTransactionLogs() {
         // Erase tag name mapping
         tag_name_to_id_.erase(txn.tag_name_);
         // Erase all blobs belonging to this tag
-        std::string tag_prefix = std::to_string(tag_id.major_) + "." +
-                                 std::to_string(tag_id.minor_) + ".";
-        std::vector<std::string> keys_to_erase;
-        tag_blob_name_to_info_.for_each(
-            [&tag_prefix, &keys_to_erase](const std::string &key,
-                                          const BlobInfo &) {
-              if (key.compare(0, tag_prefix.length(), tag_prefix) == 0) {
-                keys_to_erase.push_back(key);
-              }
-            });
-        for (const auto &key : keys_to_erase) {
-          tag_blob_name_to_info_.erase(key);
-        }
+        tag_blob_name_to_info_.EraseTag(tag_id);
         tag_id_to_info_.erase(tag_id);
+        if (base_image_) replayed_tag_ids_.push_back(tag_id);
+        tags_replayed++;
+      } else if (type == TxnType::kAddPackSegment) {
+        auto txn = TransactionLog::DeserializePackSegment(payload);
+        chi::PoolId target_id(txn.bdev_major_, txn.bdev_minor_);
+        restored_pack_segments_[target_id][txn.base_] = txn.size_;
+      } else if (type == TxnType::kFreePackSegment) {
+        auto txn = TransactionLog::DeserializePackSegment(payload);
+        chi::PoolId target_id(txn.bdev_major_, txn.bdev_minor_);
+        auto it = restored_pack_segments_.find(target_id);
+        if (it != restored_pack_segments_.end()) {
+          it->second.erase(txn.base_);
+        }
+      } else if (type == TxnType::kSetTagPolicy) {
+        ApplyTagPolicy(TransactionLog::DeserializeTagPolicy(payload));
+        // The first checkpoint after the restart lists it again
+        tag_policy_dirty_.store(true);
         tags_replayed++;
       }
-    }
+    });
+    loader.Close();
   }
 
-  // Phase 2: Replay all blob logs
+  // Phase 2: Fold each worker's blob log into per-blob patches, one log
+  // per thread. Folding only reads the mapped log, so logs are independent.
+  std::vector<std::string> blob_log_paths;
   for (size_t i = 0;; ++i) {
     std::string blob_log_path = log_path + ".blob." + std::to_string(i);
-    if (!std::filesystem::exists(blob_log_path)) break;
-
-    TransactionLog loader;
-    loader.Open(blob_log_path, 0);
-    auto entries = loader.Load();
-    loader.Close();
-
-    for (const auto &[type, payload] : entries) {
-      if (type == TxnType::kCreateNewBlob) {
-        auto txn = TransactionLog::DeserializeCreateNewBlob(payload);
-        TagId tag_id{txn.tag_major_, txn.tag_minor_};
-        std::string composite_key = std::to_string(tag_id.major_) + "." +
-                                    std::to_string(tag_id.minor_) + "." +
-                                    txn.blob_name_;
-        BlobInfo blob_info;
-        blob_info.blob_name_ = txn.blob_name_;
-        blob_info.score_ = txn.score_;
-        tag_blob_name_to_info_.insert_or_assign(composite_key, blob_info);
-        blobs_replayed++;
-
-      } else if (type == TxnType::kExtendBlob) {
-        auto txn = TransactionLog::DeserializeExtendBlob(payload);
-        TagId tag_id{txn.tag_major_, txn.tag_minor_};
-        std::string composite_key = std::to_string(tag_id.major_) + "." +
-                                    std::to_string(tag_id.minor_) + "." +
-                                    txn.blob_name_;
-        BlobInfo *blob_info_ptr = tag_blob_name_to_info_.find(composite_key);
-        if (blob_info_ptr) {
-          // Replace blocks with replayed blocks (full replacement semantics)
-          blob_info_ptr->blocks_.clear();
-          for (const auto &tb : txn.new_blocks_) {
-            chi::PoolId bdev_pool_id(tb.bdev_major_, tb.bdev_minor_);
-            // Filter volatile targets (matching RestoreMetadataFromLog)
-            bool is_volatile = false;
-            {
-              chi::ScopedCoRwReadLock read_lock(target_lock_);
-              TargetInfo *tinfo = registered_targets_.find(bdev_pool_id);
-              if (tinfo && tinfo->persistence_level_ ==
-                               chimaera::bdev::PersistenceLevel::kVolatile) {
-                is_volatile = true;
-              }
-            }
-            if (is_volatile) {
-              continue;
-            }
-            chimaera::bdev::Client bdev_client(bdev_pool_id);
-            BlobBlock block(bdev_client, tb.target_query_, tb.target_offset_,
-                            tb.size_);
-            blob_info_ptr->blocks_.push_back(block);
-          }
-        }
-        blobs_replayed++;
-
-      } else if (type == TxnType::kClearBlob) {
-        auto txn = TransactionLog::DeserializeClearBlob(payload);
-        TagId tag_id{txn.tag_major_, txn.tag_minor_};
-        std::string composite_key = std::to_string(tag_id.major_) + "." +
-                                    std::to_string(tag_id.minor_) + "." +
-                                    txn.blob_name_;
-        BlobInfo *blob_info_ptr = tag_blob_name_to_info_.find(composite_key);
-        if (blob_info_ptr) {
-          blob_info_ptr->blocks_.clear();
-        }
-        blobs_replayed++;
-
-      } else if (type == TxnType::kDelBlob) {
-        auto txn = TransactionLog::DeserializeDelBlob(payload);
-        TagId tag_id{txn.tag_major_, txn.tag_minor_};
-        std::string composite_key = std::to_string(tag_id.major_) + "." +
-                                    std::to_string(tag_id.minor_) + "." +
-                                    txn.blob_name_;
-        tag_blob_name_to_info_.erase(composite_key);
-        blobs_replayed++;
+    if (!TransactionLog::Exists(blob_log_path)) break;
+    blob_log_paths.push_back(blob_log_path);
+  }
+  std::vector<std::vector<BlobPatch>> log_patches(blob_log_paths.size());
+  std::vector<chi::u32> log_ops(blob_log_paths.size(), 0);
+  auto volatile_targets = SnapshotVolatileTargets();
+  size_t num_threads = std::min<size_t>(
+      blob_log_paths.size(),
+      std::max<unsigned>(std::thread::hardware_concurrency(), 1));
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (size_t i = t; i < blob_log_paths.size(); i += num_threads) {
+        log_patches[i] =
+            FoldBlobLog(blob_log_paths[i], volatile_targets, log_ops[i]);
       }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  // Phase 3: Apply the logs in order, in bulk, into tables grown once to
+  // their final size
+  size_t total_patches = 0;
+  for (const auto &patches : log_patches) {
+    total_patches += patches.size();
+  }
+  tag_blob_name_to_info_.Reserve(tag_blob_name_to_info_.Size() +
+                                 total_patches);
+  for (size_t i = 0; i < log_patches.size(); ++i) {
+    tag_blob_name_to_info_.ApplyPatches(log_patches[i]);
+    blobs_replayed += log_ops[i];
+    if (!base_image_) continue;
+    for (const auto &patch : log_patches[i]) {
+      replayed_blob_keys_.push_back(
+          BlobMetadataIndex::MakeKey(patch.tag_id_, patch.blob_name_));
+      replayed_tag_ids_.push_back(patch.tag_id_);
     }
   }
 
-  // Phase 3: Recompute tag total_size_ from blob blocks
+  // Phase 4: Recompute tag total_size_ from blob blocks in one pass. A tag
+  // still deferred was not touched since its image and keeps that size.
+  std::unordered_map<TagId, chi::u64> tag_sizes;
+  tag_blob_name_to_info_.ForEachLoaded(
+      [&](const BlobKey &key, const BlobInfo &blob_info) {
+        tag_sizes[key.GetTagId()] += blob_info.GetLogicalSize();
+      });
   tag_id_to_info_.for_each([&](const TagId &tag_id, TagInfo &tag_info) {
-    chi::u64 total = 0;
-    std::string tag_prefix = std::to_string(tag_id.major_) + "." +
-                             std::to_string(tag_id.minor_) + ".";
-    tag_blob_name_to_info_.for_each(
-        [&tag_prefix, &total](const std::string &key,
-                              const BlobInfo &blob_info) {
-          if (key.compare(0, tag_prefix.length(), tag_prefix) == 0) {
-            total += blob_info.GetTotalSize();
-          }
-        });
-    tag_info.total_size_ = total;
+    if (tag_blob_name_to_info_.IsDeferred(tag_id)) return;
+    auto it = tag_sizes.find(tag_id);
+    tag_info.total_size_ = it == tag_sizes.end() ? 0 : it->second;
   });
 
-  // Phase 4: Update next_tag_id_minor_
+  // Phase 5: Update next_tag_id_minor_
   chi::u32 current_minor = next_tag_id_minor_.load();
   if (max_minor > current_minor) {
     next_tag_id_minor_.store(max_minor);
   }
 
-  HLOG(kInfo, "ReplayTransactionLogs: Replayed {} tag ops and {} blob ops",
-       tags_replayed, blobs_replayed);
+  HLOG(kInfo,
+       "ReplayTransactionLogs: Replayed {} tag ops and {} blob ops from {} "
+       "blob logs",
+       tags_replayed, blobs_replayed, blob_log_paths.size());
+}
+
+std::vector<BlobPatch> Runtime::FoldBlobLog(
+    const std::string &path,
+    const std::unordered_set<chi::PoolId> &volatile_targets, chi::u32 &ops) {
+  std::unordered_map<std::string, BlobPatch> patches;
+  auto patch_of = [&patches](chi::u32 major, chi::u32 minor,
+                             const std::string &blob_name) -> BlobPatch & {
+    TagId tag_id{major, minor};
+    auto [it, inserted] =
+        patches.try_emplace(BlobMetadataIndex::MakeKey(tag_id, blob_name));
+    if (inserted) {
+      it->second.tag_id_ = tag_id;
+      it->second.blob_name_ = blob_name;
+    }
+    return it->second;
+  };
+  // Blocks (or none, for a clear) replace those of a live blob; a layout
+  // record after them marks them as erasure-code shards
+  auto set_blocks = [](BlobPatch &patch) {
+    patch.info_.blocks_.clear();
+    patch.info_.ClearErasureLayout();
+    if (!patch.insert_) {
+      patch.set_blocks_ = !patch.erase_;
+    }
+  };
+
+  TransactionLog loader;
+  loader.Open(path, 0);
+  loader.ForEachRecord([&](TxnType type, const char *payload, size_t) {
+    ++ops;
+    if (type == TxnType::kCreateNewBlob) {
+      auto txn = TransactionLog::DeserializeCreateNewBlob(payload);
+      BlobPatch &patch =
+          patch_of(txn.tag_major_, txn.tag_minor_, txn.blob_name_);
+      patch.insert_ = true;
+      patch.set_blocks_ = false;
+      patch.set_stub_ = false;
+      patch.info_ = BlobInfo();
+      patch.info_.blob_name_ = txn.blob_name_;
+      patch.info_.score_ = txn.score_;
+    } else if (type == TxnType::kExtendBlob) {
+      auto txn = TransactionLog::DeserializeExtendBlob(payload);
+      BlobPatch &patch =
+          patch_of(txn.tag_major_, txn.tag_minor_, txn.blob_name_);
+      set_blocks(patch);
+      if (patch.erase_ && !patch.insert_) return;  // Blob is gone
+      for (const auto &tb : txn.new_blocks_) {
+        chi::PoolId bdev_pool_id(tb.bdev_major_, tb.bdev_minor_);
+        if (tb.size_ == 0) {
+          continue;
+        }
+        // Lost volatile blocks hold their place until the layout is known
+        // (see ReadBlobEntry); plain blobs drop them below
+        if (volatile_targets.count(bdev_pool_id) != 0) {
+          bdev_pool_id = chi::PoolId::GetNull();
+        }
+        patch.info_.blocks_.push_back(
+            BlobBlock(bdev_pool_id, tb.target_offset_, tb.size_));
+      }
+      // Blocks are only logged for a stub once its source is dropped
+      if (!txn.new_blocks_.empty()) {
+        patch.info_.CopyStub(BlobInfo());
+        patch.set_stub_ = !patch.insert_;
+      }
+    } else if (type == TxnType::kSetBlobStub) {
+      auto txn = TransactionLog::DeserializeBlobStub(payload);
+      BlobPatch &patch =
+          patch_of(txn.tag_major_, txn.tag_minor_, txn.blob_name_);
+      if (patch.erase_ && !patch.insert_) return;  // Blob is gone
+      patch.info_.stub_path_ = txn.source_path_;
+      patch.info_.stub_offset_ = txn.source_offset_;
+      patch.info_.stub_size_ = txn.size_;
+      patch.info_.stub_flags_ = txn.flags_;
+      patch.info_.score_ = txn.score_;
+      patch.set_stub_ = !patch.insert_;
+    } else if (type == TxnType::kSetBlobLayout) {
+      auto txn = TransactionLog::DeserializeBlobLayout(payload);
+      BlobPatch &patch =
+          patch_of(txn.tag_major_, txn.tag_minor_, txn.blob_name_);
+      if (patch.erase_ && !patch.insert_) return;  // Blob is gone
+      patch.info_.erasure_data_ = txn.data_shards_;
+      patch.info_.erasure_parity_ = txn.parity_shards_;
+      patch.info_.erasure_shard_ = txn.shard_size_;
+      patch.info_.erasure_size_ = txn.blob_size_;
+    } else if (type == TxnType::kSetBlobCipher) {
+      auto txn = TransactionLog::DeserializeBlobCipher(payload);
+      BlobPatch &patch =
+          patch_of(txn.tag_major_, txn.tag_minor_, txn.blob_name_);
+      if (patch.erase_ && !patch.insert_) return;  // Blob is gone
+      patch.info_.encrypt_chunk_ = txn.chunk_size_;
+      patch.info_.encrypt_size_ = txn.blob_size_;
+    } else if (type == TxnType::kClearBlob) {
+      auto txn = TransactionLog::DeserializeClearBlob(payload);
+      set_blocks(patch_of(txn.tag_major_, txn.tag_minor_, txn.blob_name_));
+    } else if (type == TxnType::kDelBlob) {
+      auto txn = TransactionLog::DeserializeDelBlob(payload);
+      BlobPatch &patch =
+          patch_of(txn.tag_major_, txn.tag_minor_, txn.blob_name_);
+      patch.erase_ = true;
+      patch.insert_ = false;
+      patch.set_blocks_ = false;
+      patch.set_stub_ = false;
+      patch.info_.blocks_.clear();
+      patch.info_.ClearErasureLayout();
+    }
+  });
+  loader.Close();
+
+  std::vector<BlobPatch> result;
+  result.reserve(patches.size());
+  for (auto &entry : patches) {
+    BlobInfo &info = entry.second.info_;
+    if (!info.IsErasureCoded() && !info.IsEncrypted()) {
+      BlobBlockList kept(HSHM_MALLOC);
+      for (const auto &block : info.blocks_) {
+        if (!block.target_id_.IsNull()) {
+          kept.push_back(block);
+        }
+      }
+      info.blocks_ = kept;
+    }
+    result.push_back(std::move(entry.second));
+  }
+  return result;
 }
 
 // GetWorkRemaining implementation (required pure virtual method)
@@ -2190,27 +7408,6 @@ chi::u64 Runtime::GetWorkRemaining() const {
   return 0;  // For now, always return 0 work remaining
 }
 
-// Helper methods for lock index calculation
-size_t Runtime::GetTargetLockIndex(const chi::PoolId &target_id) const {
-  // Use hash of target_id to distribute locks evenly
-  std::hash<chi::PoolId> hasher;
-  return hasher(target_id) % target_locks_.size();
-}
-
-size_t Runtime::GetTagLockIndex(const std::string &tag_name) const {
-  // Use same hash function as hshm::priv::unordered_map_ll to ensure lock maps
-  // to same bucket
-  std::hash<std::string> hasher;
-  return hasher(tag_name) % tag_locks_.size();
-}
-
-size_t Runtime::GetTagLockIndex(const TagId &tag_id) const {
-  // Use same hash function as hshm::priv::unordered_map_ll for TagId keys
-  // std::hash<chi::UniqueId> is defined in types.h
-  std::hash<TagId> hasher;
-  return hasher(tag_id) % tag_locks_.size();
-}
-
 TagId Runtime::GenerateNewTagId() {
   // Get node_id from IPC manager as the major component
   auto *ipc_manager = CHI_IPC;
@@ -2234,18 +7431,8 @@ BlobInfo *Runtime::CheckBlobExists(const std::string &blob_name,
     return nullptr;
   }
 
-  // Construct composite key for lookup
-  std::string composite_key = std::to_string(tag_id.major_) + "." +
-                              std::to_string(tag_id.minor_) + "." + blob_name;
-
-  // Acquire read lock for map lookup (single lock for map-wide safety)
-  chi::ScopedCoRwReadLock lock(blob_map_lock_);
-
-  // Search by composite key in tag_blob_name_to_info_
-  BlobInfo *blob_info_ptr = tag_blob_name_to_info_.find(composite_key);
-
-  // Return result (lock released automatically at scope exit)
-  return blob_info_ptr;
+  // Search the owning shard (takes only that shard's read lock)
+  return tag_blob_name_to_info_.Find(tag_id, blob_name);
 }
 
 BlobInfo *Runtime::CreateNewBlob(const std::string &blob_name,
@@ -2261,20 +7448,10 @@ BlobInfo *Runtime::CreateNewBlob(const std::string &blob_name,
   new_blob_info.blob_name_ = blob_name;
   new_blob_info.score_ = blob_score;
 
-  // Construct composite key for blob storage
-  std::string composite_key = std::to_string(tag_id.major_) + "." +
-                              std::to_string(tag_id.minor_) + "." + blob_name;
-
-  // Acquire write lock for map insertion (single lock for map-wide safety)
-  BlobInfo *blob_info_ptr = nullptr;
-  {
-    chi::ScopedCoRwWriteLock lock(blob_map_lock_);
-
-    // Store blob info directly in tag_blob_name_to_info_
-    auto insert_result =
-        tag_blob_name_to_info_.insert_or_assign(composite_key, new_blob_info);
-    blob_info_ptr = insert_result.value;
-  }  // Release lock immediately after insertion
+  // Insert into the owning shard (takes only that shard's write lock)
+  BlobInfo *blob_info_ptr =
+      tag_blob_name_to_info_.InsertOrAssign(tag_id, blob_name, new_blob_info);
+  MarkBlobDirty(tag_id, blob_name);
 
   // WAL: log blob creation
   if (!blob_txn_logs_.empty()) {
@@ -2291,10 +7468,10 @@ BlobInfo *Runtime::CreateNewBlob(const std::string &blob_name,
   return blob_info_ptr;
 }
 
-chi::TaskResume Runtime::ExtendBlob(BlobInfo &blob_info, chi::u64 offset,
-                                    chi::u64 size, float blob_score,
-                                    chi::u32 &error_code,
-                                    int min_persistence_level) {
+chi::TaskResume Runtime::ExtendBlob(
+    BlobInfo &blob_info, chi::u64 offset, chi::u64 size, float blob_score,
+    chi::u32 &error_code, int min_persistence_level,
+    const std::unordered_set<chi::PoolId> *exclude_targets) {
 #ifdef __NVCOMPILER
   thread_local chi::RunContext _fb_rctx;
   chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
@@ -2328,25 +7505,46 @@ chi::TaskResume Runtime::ExtendBlob(BlobInfo &blob_info, chi::u64 offset,
     error_code = 1;
     CHI_CO_RETURN;
   }
+  if (exclude_targets != nullptr && !exclude_targets->empty()) {
+    std::vector<TargetInfo> others;
+    for (const TargetInfo &target : available_targets) {
+      if (exclude_targets->count(target.bdev_client_.pool_id_) == 0 &&
+          static_cast<int>(target.persistence_level_) >=
+              min_persistence_level) {
+        others.push_back(target);
+      }
+    }
+    if (!others.empty()) {
+      available_targets = std::move(others);
+    }
+  }
 
   // Create Data Placement Engine based on configuration
   const Config &config = GetConfig();
   std::unique_ptr<DataPlacementEngine> dpe =
       DpeFactory::CreateDpe(config.dpe_.dpe_type_);
 
-  // DPE selects targets from ALL available targets
+  // DPE selects targets from ALL available targets. Engines that stripe
+  // also return how many bytes they planned for each selected target.
   std::vector<TargetInfo> ordered_targets =
       dpe->SelectTargets(available_targets, blob_score, additional_size);
+  std::vector<chi::u64> planned_sizes = dpe->GetPlacementSizes();
+  planned_sizes.resize(ordered_targets.size(), 0);
+  PreferLocalTargets(ordered_targets, &planned_sizes);
 
   // Filter AFTER DPE by persistence level
   if (min_persistence_level > 0) {
-    ordered_targets.erase(
-        std::remove_if(ordered_targets.begin(), ordered_targets.end(),
-                       [min_persistence_level](const TargetInfo &t) {
-                         return static_cast<int>(t.persistence_level_) <
-                                min_persistence_level;
-                       }),
-        ordered_targets.end());
+    size_t kept = 0;
+    for (size_t i = 0; i < ordered_targets.size(); ++i) {
+      if (static_cast<int>(ordered_targets[i].persistence_level_) >=
+          min_persistence_level) {
+        ordered_targets[kept] = ordered_targets[i];
+        planned_sizes[kept] = planned_sizes[i];
+        ++kept;
+      }
+    }
+    ordered_targets.resize(kept);
+    planned_sizes.resize(kept);
   }
 
   if (ordered_targets.empty()) {
@@ -2354,191 +7552,847 @@ chi::TaskResume Runtime::ExtendBlob(BlobInfo &blob_info, chi::u64 offset,
     CHI_CO_RETURN;
   }
 
-  // Allocate from pre-selected targets in order
+  // Allocate from pre-selected targets in order. When the DPE planned a
+  // stripe, the first pass holds each target to its planned share and the
+  // second pass places whatever those shares could not absorb.
+  bool has_plan = std::any_of(planned_sizes.begin(), planned_sizes.end(),
+                              [](chi::u64 planned) { return planned > 0; });
+  bool track_inflight =
+      StringToDpeType(config.dpe_.dpe_type_) == DpeType::kMinCompletion;
+  std::vector<chi::u64> allocated_sizes(ordered_targets.size(), 0);
   chi::u64 remaining_to_allocate = additional_size;
-  for (const auto &selected_target_info : ordered_targets) {
-    if (remaining_to_allocate == 0) {
+  for (int pass = has_plan ? 0 : 1; pass < 2; ++pass) {
+    for (size_t i = 0; i < ordered_targets.size(); ++i) {
+      if (remaining_to_allocate == 0) {
+        break;
+      }
+
+      chi::PoolId selected_target_id =
+          ordered_targets[i].bdev_client_.pool_id_;
+
+      // Copy target info under lock (can't hold lock across co_await)
+      TargetInfo target_info_copy;
+      bool found = false;
+      {
+        chi::ScopedCoRwReadLock read_lock(target_lock_);
+        TargetInfo *target_info = registered_targets_.find(selected_target_id);
+        if (target_info != nullptr) {
+          target_info_copy = *target_info;
+          found = true;
+        }
+      }
+      if (!found) {
+        continue;
+      }
+
+      // Calculate how much we can allocate from this target, less what an
+      // earlier pass already took from it
+      if (target_info_copy.remaining_space_ <= allocated_sizes[i]) {
+        continue;
+      }
+      target_info_copy.remaining_space_ -= allocated_sizes[i];
+      chi::u64 allocate_size =
+          std::min(remaining_to_allocate, target_info_copy.remaining_space_);
+      if (pass == 0) {
+        allocate_size = std::min(allocate_size, planned_sizes[i]);
+      }
+
+      if (allocate_size == 0) {
+        continue;
+      }
+
+      // Allocate space using bdev client
+      std::vector<chimaera::bdev::Block> allocated_blocks;
+      bool alloc_success = false;
+      CHI_CO_AWAIT(AllocateFromTarget(target_info_copy, allocate_size,
+                                      allocated_blocks, alloc_success));
+      if (!alloc_success) {
+        // Allocation failed, try next target
+        continue;
+      }
+
+      // Record the allocated space, merging extents that are adjacent on the
+      // target so the block list stays short
+      for (const auto &bdev_block : allocated_blocks) {
+        AppendBlobBlock(blob_info.blocks_,
+                        BlobBlock(selected_target_id, bdev_block.offset_,
+                                  bdev_block.size_));
+      }
+
+      // Project the new bytes onto the target's queue so placements made
+      // before the next StatTargets see them
+      if (track_inflight) {
+        chi::ScopedCoRwWriteLock write_lock(target_lock_);
+        TargetInfo *target_info = registered_targets_.find(selected_target_id);
+        if (target_info != nullptr) {
+          target_info->inflight_bytes_ += allocate_size;
+        }
+      }
+
+      allocated_sizes[i] += allocate_size;
+      remaining_to_allocate -= allocate_size;
+    }
+  }
+
+  // Error condition: if we've exhausted all targets but still have remaining
+  // space
+  if (remaining_to_allocate > 0) {
+    error_code = 3;
+    CHI_CO_RETURN;
+  }
+
+  error_code = 0;  // Success
+  CHI_CO_RETURN;
+}
+
+void Runtime::LogBlobStub(const TagId &tag_id, const std::string &blob_name,
+                          const BlobInfo &blob_info) {
+  if (blob_txn_logs_.empty()) {
+    return;
+  }
+  chi::u32 wid = CHI_CUR_WORKER->GetWorkerStats().worker_id_;
+  TxnBlobStub txn;
+  txn.tag_major_ = tag_id.major_;
+  txn.tag_minor_ = tag_id.minor_;
+  txn.blob_name_ = blob_name;
+  txn.source_path_ = blob_info.stub_path_.str();
+  txn.source_offset_ = blob_info.stub_offset_;
+  txn.size_ = blob_info.stub_size_;
+  txn.flags_ = blob_info.stub_flags_;
+  txn.score_ = blob_info.score_;
+  blob_txn_logs_[wid % blob_txn_logs_.size()]->Log(TxnType::kSetBlobStub,
+                                                   txn);
+}
+
+void Runtime::LogBlobBlocks(const TagId &tag_id, const std::string &blob_name,
+                            const BlobInfo &blob_info) {
+  MarkBlobDirty(tag_id, blob_name);
+  if (blob_txn_logs_.empty() || blob_info.blocks_.empty()) {
+    return;
+  }
+  chi::u32 wid = CHI_CUR_WORKER->GetWorkerStats().worker_id_;
+  TxnExtendBlob txn;
+  txn.tag_major_ = tag_id.major_;
+  txn.tag_minor_ = tag_id.minor_;
+  txn.blob_name_ = blob_name;
+  for (const auto &blk : blob_info.blocks_) {
+    TxnExtendBlobBlock tb;
+    tb.bdev_major_ = blk.target_id_.major_;
+    tb.bdev_minor_ = blk.target_id_.minor_;
+    GetTargetQuery(blk.target_id_, tb.target_query_);
+    tb.target_offset_ = blk.target_offset_;
+    tb.size_ = blk.size_;
+    txn.new_blocks_.push_back(tb);
+  }
+  TransactionLog *log = blob_txn_logs_[wid % blob_txn_logs_.size()].get();
+  log->Log(TxnType::kExtendBlob, txn);
+  if (blob_info.IsErasureCoded()) {
+    TxnBlobLayout layout;
+    layout.tag_major_ = tag_id.major_;
+    layout.tag_minor_ = tag_id.minor_;
+    layout.blob_name_ = blob_name;
+    layout.data_shards_ = blob_info.erasure_data_;
+    layout.parity_shards_ = blob_info.erasure_parity_;
+    layout.shard_size_ = blob_info.erasure_shard_;
+    layout.blob_size_ = blob_info.erasure_size_;
+    log->Log(TxnType::kSetBlobLayout, layout);
+  } else if (blob_info.IsEncrypted()) {
+    TxnBlobCipher cipher;
+    cipher.tag_major_ = tag_id.major_;
+    cipher.tag_minor_ = tag_id.minor_;
+    cipher.blob_name_ = blob_name;
+    cipher.chunk_size_ = blob_info.encrypt_chunk_;
+    cipher.blob_size_ = blob_info.encrypt_size_;
+    log->Log(TxnType::kSetBlobCipher, cipher);
+  }
+}
+
+bool Runtime::GetTargetQuery(const chi::PoolId &target_id,
+                             chi::PoolQuery &target_query) {
+  chi::ScopedCoRwReadLock read_lock(target_lock_);
+  TargetInfo *target_info = registered_targets_.find(target_id);
+  if (target_info == nullptr) {
+    return false;
+  }
+  target_query = target_info->target_query_;
+  return true;
+}
+
+Runtime::TargetMetricSlot *Runtime::FindTargetMetrics(
+    const chi::PoolId &target_id) {
+  chi::u64 key = target_id.ToU64();
+  chi::u32 count = num_target_metrics_.load(std::memory_order_acquire);
+  for (chi::u32 i = 0; i < count; ++i) {
+    if (target_metrics_[i].target_id_.load(std::memory_order_relaxed) == key) {
+      return &target_metrics_[i];
+    }
+  }
+  return nullptr;
+}
+
+Runtime::TargetMetricSlot *Runtime::ClaimTargetMetrics(
+    const chi::PoolId &target_id, const std::string &target_name) {
+  std::lock_guard<std::mutex> guard(target_metrics_lock_);
+  TargetMetricSlot *slot = FindTargetMetrics(target_id);
+  if (slot) return slot;
+  chi::u32 idx = num_target_metrics_.load(std::memory_order_relaxed);
+  if (idx >= kMaxTargetMetrics) {
+    HLOG(kWarning, "Metrics: no slot left for target '{}'", target_name);
+    return nullptr;
+  }
+  slot = &target_metrics_[idx];
+  std::snprintf(slot->name_, TargetMetricSlot::kNameSize, "%s",
+                target_name.c_str());
+  slot->target_id_.store(target_id.ToU64(), std::memory_order_relaxed);
+  // Publishing the count releases the name and id to the metrics thread
+  num_target_metrics_.store(idx + 1, std::memory_order_release);
+  return slot;
+}
+
+void Runtime::CountTargetIo(const chi::PoolId &target_id, chi::u64 bytes,
+                            bool is_write) {
+  TargetMetricSlot *slot = FindTargetMetrics(target_id);
+  if (!slot) return;
+  if (is_write) {
+    slot->bytes_written_.fetch_add(bytes, std::memory_order_relaxed);
+    slot->ops_written_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    slot->bytes_read_.fetch_add(bytes, std::memory_order_relaxed);
+    slot->ops_read_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+std::string Runtime::MetricsKey() const {
+  return "wrp_cte_core/" + pool_id_.ToString();
+}
+
+void Runtime::CollectMetrics(chi::MetricsWriter &w) {
+  std::string pool = pool_id_.ToString();
+  chi::u32 count = num_target_metrics_.load(std::memory_order_acquire);
+  for (chi::u32 i = 0; i < count; ++i) {
+    const TargetMetricSlot &slot = target_metrics_[i];
+    if (!slot.live_.load(std::memory_order_relaxed)) continue;
+    std::string target = slot.name_;
+    w.Family("cte_target_read_bytes", chi::MetricType::kCounter,
+             "Bytes read from the target");
+    w.Sample({{"pool", pool}, {"target", target}},
+             slot.bytes_read_.load(std::memory_order_relaxed));
+    w.Family("cte_target_written_bytes", chi::MetricType::kCounter,
+             "Bytes written to the target");
+    w.Sample({{"pool", pool}, {"target", target}},
+             slot.bytes_written_.load(std::memory_order_relaxed));
+    w.Family("cte_target_read_ops", chi::MetricType::kCounter,
+             "Bdev read tasks completed on the target");
+    w.Sample({{"pool", pool}, {"target", target}},
+             slot.ops_read_.load(std::memory_order_relaxed));
+    w.Family("cte_target_write_ops", chi::MetricType::kCounter,
+             "Bdev write tasks completed on the target");
+    w.Sample({{"pool", pool}, {"target", target}},
+             slot.ops_written_.load(std::memory_order_relaxed));
+    w.Family("cte_target_capacity_bytes", chi::MetricType::kGauge,
+             "Size the target was registered with");
+    w.Sample({{"pool", pool}, {"target", target}},
+             slot.capacity_.load(std::memory_order_relaxed));
+    w.Family("cte_target_remaining_bytes", chi::MetricType::kGauge,
+             "Allocatable space left at the last StatTargets");
+    w.Sample({{"pool", pool}, {"target", target}},
+             slot.remaining_space_.load(std::memory_order_relaxed));
+    w.Family("cte_target_read_bandwidth_mbps", chi::MetricType::kGauge,
+             "Read bandwidth the bdev reported at the last StatTargets");
+    w.Sample({{"pool", pool}, {"target", target}},
+             slot.read_bw_mbps_.load(std::memory_order_relaxed));
+    w.Family("cte_target_write_bandwidth_mbps", chi::MetricType::kGauge,
+             "Write bandwidth the bdev reported at the last StatTargets");
+    w.Sample({{"pool", pool}, {"target", target}},
+             slot.write_bw_mbps_.load(std::memory_order_relaxed));
+  }
+
+  // WAL vectors are sized in Create before this collector is registered
+  // and cleared in Destroy after it is unregistered
+  auto emit_logs = [&](const char *kind,
+                       const std::vector<std::unique_ptr<TransactionLog>>
+                           &logs) {
+    for (size_t i = 0; i < logs.size(); ++i) {
+      if (!logs[i]) continue;
+      std::string worker = std::to_string(i);
+      w.Family("cte_wal_size_bytes", chi::MetricType::kGauge,
+               "Committed size of a write-ahead log");
+      w.Sample({{"pool", pool}, {"log", kind}, {"worker", worker}},
+               logs[i]->DurableBytes());
+      w.Family("cte_wal_committed_bytes", chi::MetricType::kCounter,
+               "Bytes made durable in a write-ahead log");
+      w.Sample({{"pool", pool}, {"log", kind}, {"worker", worker}},
+               logs[i]->CommittedBytesTotal());
+    }
+  };
+  emit_logs("blob", blob_txn_logs_);
+  emit_logs("tag", tag_txn_logs_);
+
+  size_t index_entries = 0;
+  {
+    hshm::ScopedMutex guard(block_refs_lock_, 0);
+    index_entries = dedup_index_.size();
+  }
+  w.Family("cte_dedup_chunks_hit", chi::MetricType::kCounter,
+           "Chunks of dedup writes that referenced an existing extent");
+  w.Sample({{"pool", pool}},
+           dedup_chunks_hit_.load(std::memory_order_relaxed));
+  w.Family("cte_dedup_saved_bytes", chi::MetricType::kCounter,
+           "Bytes dedup writes did not store again");
+  w.Sample({{"pool", pool}},
+           dedup_bytes_saved_.load(std::memory_order_relaxed));
+  w.Family("cte_dedup_index_entries", chi::MetricType::kGauge,
+           "Extents in the dedup fingerprint index");
+  w.Sample({{"pool", pool}}, static_cast<chi::u64>(index_entries));
+
+  size_t pack_segments = 0;
+  chi::u64 pack_live_bytes = 0;
+  {
+    hshm::ScopedMutex guard(pack_lock_, 0);
+    pack_segments = pack_segments_.Size();
+    pack_segments_.ForEach(
+        [&pack_live_bytes](chi::u64, const PackSegment &seg) {
+          pack_live_bytes += seg.live_bytes_;
+        });
+  }
+  w.Family("cte_pack_objects", chi::MetricType::kCounter,
+           "Small PutBlobs appended to a packing segment");
+  w.Sample({{"pool", pool}}, pack_objects_.load(std::memory_order_relaxed));
+  w.Family("cte_pack_flushes", chi::MetricType::kCounter,
+           "Writes of packing segments to their targets");
+  w.Sample({{"pool", pool}}, pack_flushes_.load(std::memory_order_relaxed));
+  w.Family("cte_pack_flushed_bytes", chi::MetricType::kCounter,
+           "Bytes those writes carried");
+  w.Sample({{"pool", pool}},
+           pack_flushed_bytes_.load(std::memory_order_relaxed));
+  w.Family("cte_pack_buffer_reads", chi::MetricType::kCounter,
+           "Reads of packed objects served from a segment in memory");
+  w.Sample({{"pool", pool}},
+           pack_buffer_reads_.load(std::memory_order_relaxed));
+  w.Family("cte_pack_objects_cleaned", chi::MetricType::kCounter,
+           "Live objects DefragBlobs copied out of sparse segments");
+  w.Sample({{"pool", pool}},
+           pack_objects_cleaned_.load(std::memory_order_relaxed));
+  w.Family("cte_pack_segments_freed", chi::MetricType::kCounter,
+           "Packing segments given back to their targets");
+  w.Sample({{"pool", pool}},
+           pack_segments_freed_.load(std::memory_order_relaxed));
+  w.Family("cte_pack_segments", chi::MetricType::kGauge,
+           "Packing segments allocated");
+  w.Sample({{"pool", pool}}, static_cast<chi::u64>(pack_segments));
+  w.Family("cte_pack_live_bytes", chi::MetricType::kGauge,
+           "Bytes of packed objects still referenced");
+  w.Sample({{"pool", pool}}, pack_live_bytes);
+  w.Family("cte_erasure_degraded_reads", chi::MetricType::kCounter,
+           "Erasure-coded reads that rebuilt data from parity");
+  w.Sample({{"pool", pool}},
+           erasure_degraded_reads_.load(std::memory_order_relaxed));
+  w.Family("cte_erasure_shards_rebuilt", chi::MetricType::kCounter,
+           "Erasure-code shards rewritten after their target was lost");
+  w.Sample({{"pool", pool}},
+           erasure_shards_rebuilt_.load(std::memory_order_relaxed));
+  w.Family("cte_encrypt_auth_failures", chi::MetricType::kCounter,
+           "Encrypted chunks that failed authentication on read");
+  w.Sample({{"pool", pool}},
+           encrypt_auth_failures_.load(std::memory_order_relaxed));
+  w.Family("cte_evict_blobs", chi::MetricType::kCounter,
+           "Blobs demoted off targets above their high watermark");
+  w.Sample({{"pool", pool}}, evict_blobs_.load(std::memory_order_relaxed));
+  w.Family("cte_evict_bytes", chi::MetricType::kCounter,
+           "Bytes demoted off targets above their high watermark");
+  w.Sample({{"pool", pool}}, evict_bytes_.load(std::memory_order_relaxed));
+  w.Family("cte_expired_blobs", chi::MetricType::kCounter,
+           "Blobs freed because their TTL ran out");
+  w.Sample({{"pool", pool}}, expired_blobs_.load(std::memory_order_relaxed));
+  w.Family("cte_expired_bytes", chi::MetricType::kCounter,
+           "Bytes freed because their TTL ran out");
+  w.Sample({{"pool", pool}}, expired_bytes_.load(std::memory_order_relaxed));
+  w.Family("cte_put_in_place", chi::MetricType::kCounter,
+           "PutBlob calls that overwrote existing blocks in place");
+  w.Sample({{"pool", pool}}, put_in_place_.load(std::memory_order_relaxed));
+  w.Family("cte_reads_coalesced", chi::MetricType::kCounter,
+           "GetBlob reads served from a concurrent read of the same blob");
+  w.Sample({{"pool", pool}},
+           reads_coalesced_.load(std::memory_order_relaxed));
+  w.Family("cte_bytes_coalesced", chi::MetricType::kCounter,
+           "Bytes GetBlob copied from a concurrent read instead of a bdev");
+  w.Sample({{"pool", pool}},
+           bytes_coalesced_.load(std::memory_order_relaxed));
+  w.Family("cte_read_cache_hits", chi::MetricType::kCounter,
+           "GetBlob reads served from the DRAM read cache");
+  w.Sample({{"pool", pool}},
+           read_cache_hits_.load(std::memory_order_relaxed));
+  w.Family("cte_read_cache_misses", chi::MetricType::kCounter,
+           "GetBlob reads of slow-target blobs the read cache missed");
+  w.Sample({{"pool", pool}},
+           read_cache_misses_.load(std::memory_order_relaxed));
+  w.Family("cte_read_cache_fills", chi::MetricType::kCounter,
+           "Blobs copied into the DRAM read cache");
+  w.Sample({{"pool", pool}},
+           read_cache_fills_.load(std::memory_order_relaxed));
+  w.Family("cte_blob_views", chi::MetricType::kCounter,
+           "Blob ranges pinned for local clients to read in place");
+  w.Sample({{"pool", pool}}, views_served_.load(std::memory_order_relaxed));
+  w.Family("cte_reserved_bytes", chi::MetricType::kCounter,
+           "Bytes allocated ahead of writes by ReserveBlob");
+  w.Sample({{"pool", pool}}, reserved_bytes_.load(std::memory_order_relaxed));
+}
+
+Runtime::BlockIoRun *Runtime::FindBlockIoRun(std::vector<BlockIoRun> &runs,
+                                             const chi::PoolId &target_id,
+                                             size_t piece_offset,
+                                             size_t piece_size,
+                                             bool merge_interleaved) {
+  if (!runs.empty() && runs.back().target_id_ == target_id) {
+    return &runs.back();
+  }
+  if (!merge_interleaved) {
+    return nullptr;
+  }
+  // Joining an earlier run sends the gap to its target as well, so only
+  // join while the gaps are no larger than the payload
+  for (size_t i = runs.size(); i-- > 0;) {
+    BlockIoRun &run = runs[i];
+    if (run.target_id_ != target_id) {
+      continue;
+    }
+    size_t span = piece_offset + piece_size - run.data_offset_;
+    return span <= 2 * (run.size_ + piece_size) ? &run : nullptr;
+  }
+  return nullptr;
+}
+
+void Runtime::BuildBlockIoRuns(const BlobBlockList &blocks,
+                               size_t data_offset_in_blob, size_t data_size,
+                               std::vector<BlockIoRun> &runs,
+                               bool merge_interleaved) {
+  runs.clear();
+  size_t data_end_in_blob = data_offset_in_blob + data_size;
+  size_t block_offset_in_blob = 0;
+  for (size_t block_idx = 0; block_idx < blocks.size(); ++block_idx) {
+    const BlobBlock &block = blocks[block_idx];
+    if (block_offset_in_blob >= data_end_in_blob) {
+      break;
+    }
+    size_t block_end_in_blob = block_offset_in_blob + block.size_;
+    if (data_offset_in_blob < block_end_in_blob) {
+      // Clamp [data_offset, data_end) to this block's range in the blob
+      size_t io_start_in_blob =
+          std::max(data_offset_in_blob, block_offset_in_blob);
+      size_t io_end_in_blob = std::min(data_end_in_blob, block_end_in_blob);
+      size_t io_size = io_end_in_blob - io_start_in_blob;
+      size_t io_start_in_block = io_start_in_blob - block_offset_in_blob;
+      size_t piece_offset = io_start_in_blob - data_offset_in_blob;
+
+      // Overlapping ranges are contiguous in the data buffer, so a block on
+      // the same target as the previous one just extends the current run
+      BlockIoRun *run = FindBlockIoRun(runs, block.target_id_, piece_offset,
+                                       io_size, merge_interleaved);
+      if (run == nullptr) {
+        BlockIoRun new_run;
+        new_run.target_id_ = block.target_id_;
+        new_run.data_offset_ = piece_offset;
+        new_run.size_ = 0;
+        new_run.span_ = 0;
+        runs.push_back(std::move(new_run));
+        run = &runs.back();
+      }
+      size_t rel_offset = piece_offset - run->data_offset_;
+      if (run->block_offsets_.empty() && rel_offset != run->span_) {
+        // First gap: switch the run to explicit per-block offsets
+        chi::u64 offset = 0;
+        for (const auto &prev : run->blocks_) {
+          run->block_offsets_.push_back(offset);
+          offset += prev.size_;
+        }
+      }
+      if (!run->block_offsets_.empty()) {
+        run->block_offsets_.push_back(rel_offset);
+      }
+      run->blocks_.emplace_back(block.target_offset_ + io_start_in_block,
+                                io_size, 0);
+      run->size_ += io_size;
+      run->span_ = rel_offset + io_size;
+    }
+    block_offset_in_blob = block_end_in_blob;
+  }
+}
+
+chi::TaskResume Runtime::ModifyExistingData(
+    const BlobBlockList &blocks, hipc::ShmPtr<> data, size_t data_size,
+    size_t data_offset_in_blob, chi::u32 &error_code, chi::u32 qos_class) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  HLOG(kDebug,
+       "ModifyExistingData: blocks={}, data_size={}, data_offset_in_blob={}",
+       blocks.size(), data_size, data_offset_in_blob);
+
+  // Step 1: Group the blocks covering the write into per-target runs.
+  // Interleaved blocks of a target share a run, since the extra gap bytes a
+  // remote target receives are only ignored.
+  std::vector<BlockIoRun> runs;
+  BuildBlockIoRuns(blocks, data_offset_in_blob, data_size, runs, true);
+
+  // Step 2: Send one bdev write per run; the data is laid out sequentially
+  // across the run's target blocks
+  std::vector<chi::Future<chimaera::bdev::WriteTask>> write_tasks;
+  std::vector<size_t> expected_write_sizes;
+  bool targets_resolved = true;
+  for (const auto &run : runs) {
+    chi::PoolQuery target_query;
+    if (!GetTargetQuery(run.target_id_, target_query)) {
+      HLOG(kError, "ModifyExistingData: target ({},{}) is not registered",
+           run.target_id_.major_, run.target_id_.minor_);
+      targets_resolved = false;
       break;
     }
+    chi::priv::vector<chimaera::bdev::Block> bdev_blocks(HSHM_MALLOC);
+    for (const auto &bdev_block : run.blocks_) {
+      bdev_blocks.push_back(bdev_block);
+    }
+    if (qos_.Enabled()) {
+      CHI_CO_AWAIT(AdmitIo(qos_class, run.target_id_, run.size_));
+    }
+    chimaera::bdev::Client bdev_client(run.target_id_);
+    if (run.block_offsets_.empty()) {
+      write_tasks.push_back(bdev_client.AsyncWrite(
+          target_query, bdev_blocks, data + run.data_offset_, run.size_));
+    } else {
+      chi::priv::vector<chi::u64> block_offsets(HSHM_MALLOC);
+      for (chi::u64 offset : run.block_offsets_) {
+        block_offsets.push_back(offset);
+      }
+      write_tasks.push_back(bdev_client.AsyncWrite(
+          target_query, bdev_blocks, block_offsets, data + run.data_offset_,
+          run.span_));
+    }
+    expected_write_sizes.push_back(run.size_);
+  }
+
+  // Step 3: Wait for all Async write operations to complete. Every task is
+  // awaited so the caller can safely release the data buffer. Per-stage
+  // latency of these writes is reported by runtime.task_latency.
+  bool writes_ok = targets_resolved;
+  for (size_t task_idx = 0; task_idx < write_tasks.size(); ++task_idx) {
+    auto &task = write_tasks[task_idx];
+    CHI_CO_AWAIT(task);
+    CountTargetIo(runs[task_idx].target_id_, task->bytes_written_, true);
+    if (task->bytes_written_ != expected_write_sizes[task_idx]) {
+      writes_ok = false;
+    }
+  }
 
-    chi::PoolId selected_target_id = selected_target_info.bdev_client_.pool_id_;
+  error_code = writes_ok ? 0 : 1;
+  CHI_CO_RETURN;
+}
 
-    // Copy target info under lock (can't hold lock across co_await)
-    TargetInfo target_info_copy;
-    bool found = false;
-    {
-      chi::ScopedCoRwReadLock read_lock(target_lock_);
-      TargetInfo *target_info = registered_targets_.find(selected_target_id);
-      if (target_info != nullptr) {
-        target_info_copy = *target_info;
-        found = true;
+chi::TaskResume Runtime::ReadDataOnce(const TagId &tag_id,
+                                      const std::string &blob_name,
+                                      const BlobInfo &blob_info,
+                                      hipc::ShmPtr<> data, size_t data_size,
+                                      size_t data_offset_in_blob,
+                                      chi::u32 &error_code,
+                                      chi::u32 qos_class) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  error_code = 0;
+  BlobKey key(tag_id, blob_name);
+  chi::u64 version = blob_info.version_;
+  std::shared_ptr<ReadFlight> flight;
+  ReadFlightJoiner joiner;
+  bool leader = false;
+  {
+    hshm::ScopedMutex guard(read_flight_lock_, 0);
+    auto &flights = read_flights_[key];
+    for (const auto &candidate : flights) {
+      if (candidate->version_ == version &&
+          candidate->offset_ <= data_offset_in_blob &&
+          data_offset_in_blob + data_size <=
+              candidate->offset_ + candidate->size_) {
+        flight = candidate;
+        joiner.data_ = data;
+        joiner.offset_ = data_offset_in_blob;
+        joiner.size_ = data_size;
+        flight->joiners_.push_back(&joiner);
+        break;
+      }
+    }
+    if (!flight) {
+      flight = std::make_shared<ReadFlight>();
+      flight->offset_ = data_offset_in_blob;
+      flight->size_ = data_size;
+      flight->version_ = version;
+      flight->data_ = data;
+      flights.push_back(flight);
+      leader = true;
+    }
+  }
+
+  if (!leader) {
+    // Parked until the leader has copied into our buffer (or failed)
+    CHI_CO_AWAIT(flight->done_.Wait());
+    if (joiner.copied_) {
+      reads_coalesced_.fetch_add(1, std::memory_order_relaxed);
+      bytes_coalesced_.fetch_add(data_size, std::memory_order_relaxed);
+      CHI_CO_RETURN;
+    }
+    // The shared read failed: try on our own
+    CHI_CO_AWAIT(ReadData(blob_info.blocks_, data, data_size,
+                          data_offset_in_blob, error_code, qos_class));
+    CHI_CO_RETURN;
+  }
+
+  CHI_CO_AWAIT(ReadData(blob_info.blocks_, data, data_size,
+                        data_offset_in_blob, flight->result_, qos_class));
+  error_code = flight->result_;
+  std::vector<ReadFlightJoiner *> joiners;
+  {
+    // No reader joins once the flight is off the table
+    hshm::ScopedMutex guard(read_flight_lock_, 0);
+    auto it = read_flights_.find(key);
+    if (it != read_flights_.end()) {
+      auto &flights = it->second;
+      flights.erase(std::remove(flights.begin(), flights.end(), flight),
+                    flights.end());
+      if (flights.empty()) {
+        read_flights_.erase(it);
+      }
+    }
+    joiners.swap(flight->joiners_);
+  }
+  // Copy out while data is still ours, then wake the joined readers
+  if (flight->result_ == 0 && !joiners.empty()) {
+    auto *ipc_manager = CHI_IPC;
+    auto src = ipc_manager->ToFullPtr<char>(data.template Cast<char>());
+    for (ReadFlightJoiner *waiter : joiners) {
+      auto dst =
+          ipc_manager->ToFullPtr<char>(waiter->data_.template Cast<char>());
+      if (!src.IsNull() && !dst.IsNull()) {
+        memcpy(dst.ptr_, src.ptr_ + (waiter->offset_ - data_offset_in_blob),
+               waiter->size_);
+        waiter->copied_ = true;
+      }
+    }
+  }
+  flight->done_.Set();
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::ReadFromCache(const TagId &tag_id,
+                                       const std::string &blob_name,
+                                       const BlobInfo &blob_info,
+                                       hipc::ShmPtr<> data, size_t data_size,
+                                       size_t data_offset_in_blob, bool &hit) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  hit = false;
+  BlobKey key(tag_id, blob_name);
+  std::shared_ptr<ReadCacheCopy> copy;
+  std::vector<std::shared_ptr<ReadCacheCopy>> stale;
+  {
+    hshm::ScopedMutex guard(read_cache_lock_, 0);
+    read_cache_->Touch(key.Hash());
+    std::shared_ptr<ReadCacheCopy> *found = read_cache_->Find(key);
+    if (found != nullptr) {
+      if ((*found)->version_ == blob_info.version_) {
+        copy = *found;
+        copy->readers_.fetch_add(1);
+      } else {
+        // The blob changed without PutBlob (e.g. a reorganize or splice)
+        ReadCache::Evicted removed;
+        read_cache_->Erase(key, removed);
+        stale.push_back(std::move(removed.value_));
       }
     }
-    if (!found) {
-      continue;
-    }
-
-    // Calculate how much we can allocate from this target
-    chi::u64 allocate_size =
-        std::min(remaining_to_allocate, target_info_copy.remaining_space_);
+  }
+  if (!stale.empty()) {
+    CHI_CO_AWAIT(FreeReadCacheCopies(std::move(stale)));
+  }
+  if (!copy) {
+    read_cache_misses_.fetch_add(1, std::memory_order_relaxed);
+    CHI_CO_RETURN;
+  }
 
-    if (allocate_size == 0) {
-      continue;
+  // Cut the cached blocks down to the requested range
+  chi::priv::vector<chimaera::bdev::Block> blocks(HSHM_MALLOC);
+  chi::u64 skip = data_offset_in_blob;
+  chi::u64 remaining = data_size;
+  for (const chimaera::bdev::Block &cached : copy->blocks_) {
+    if (remaining == 0) {
+      break;
     }
-
-    // Allocate space using bdev client
-    chi::u64 allocated_offset;
-    bool alloc_success = false;
-    CHI_CO_AWAIT(AllocateFromTarget(target_info_copy, allocate_size,
-                                allocated_offset, alloc_success));
-    if (!alloc_success) {
-      // Allocation failed, try next target
+    if (skip >= cached.size_) {
+      skip -= cached.size_;
       continue;
     }
+    chimaera::bdev::Block block = cached;
+    block.offset_ += skip;
+    block.size_ = std::min<chi::u64>(cached.size_ - skip, remaining);
+    skip = 0;
+    remaining -= block.size_;
+    blocks.push_back(block);
+  }
+  if (remaining == 0) {
+    chimaera::bdev::Client cache_client(read_cache_id_);
+    auto read_task = cache_client.AsyncRead(chi::PoolQuery::Local(), blocks,
+                                            data, data_size);
+    CHI_CO_AWAIT(read_task);
+    hit = read_task->GetReturnCode() == 0 &&
+          read_task->bytes_read_ == data_size;
+  }
+  copy->readers_.fetch_sub(1, std::memory_order_release);
+  if (hit) {
+    read_cache_hits_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    read_cache_misses_.fetch_add(1, std::memory_order_relaxed);
+  }
+  CHI_CO_RETURN;
+}
 
-    // Create new block for the allocated space
-    BlobBlock new_block(target_info_copy.bdev_client_,
-                        target_info_copy.target_query_, allocated_offset,
-                        allocate_size);
-    blob_info.blocks_.push_back(new_block);
-
-    remaining_to_allocate -= allocate_size;
+chi::TaskResume Runtime::FillReadCache(const TagId &tag_id,
+                                       const std::string &blob_name,
+                                       chi::u64 version, hipc::ShmPtr<> data,
+                                       chi::u64 size) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  BlobKey key(tag_id, blob_name);
+  std::vector<ReadCache::Evicted> victims;
+  bool admitted = false;
+  {
+    hshm::ScopedMutex guard(read_cache_lock_, 0);
+    if (read_cache_->Find(key) == nullptr) {
+      admitted = read_cache_->Admit(key.Hash(), size, victims);
+    }
+  }
+  if (!victims.empty()) {
+    std::vector<std::shared_ptr<ReadCacheCopy>> evicted;
+    for (auto &victim : victims) {
+      evicted.push_back(std::move(victim.value_));
+    }
+    CHI_CO_AWAIT(FreeReadCacheCopies(std::move(evicted)));
+  }
+  if (!admitted) {
+    CHI_CO_RETURN;
   }
 
-  // Error condition: if we've exhausted all targets but still have remaining
-  // space
-  if (remaining_to_allocate > 0) {
-    error_code = 3;
+  // Admit reserved the bytes in the index; the bdev holds them
+  chimaera::bdev::Client cache_client(read_cache_id_);
+  auto copy = std::make_shared<ReadCacheCopy>();
+  copy->version_ = version;
+  auto alloc_task = cache_client.AsyncAllocateBlocks(chi::PoolQuery::Local(),
+                                                     size);
+  CHI_CO_AWAIT(alloc_task);
+  chi::u64 remaining = size;
+  chi::priv::vector<chimaera::bdev::Block> blocks(HSHM_MALLOC);
+  for (size_t i = 0; i < alloc_task->blocks_.size() && remaining > 0; ++i) {
+    chimaera::bdev::Block block = alloc_task->blocks_[i];
+    block.size_ = std::min<chi::u64>(block.size_, remaining);
+    remaining -= block.size_;
+    blocks.push_back(block);
+    copy->blocks_.push_back(block);
+  }
+  bool written = false;
+  if (alloc_task->GetReturnCode() == 0 && remaining == 0) {
+    auto write_task = cache_client.AsyncWrite(chi::PoolQuery::Local(), blocks,
+                                              data, size);
+    CHI_CO_AWAIT(write_task);
+    written = write_task->GetReturnCode() == 0 &&
+              write_task->bytes_written_ == size;
+  }
+  if (!written) {
+    {
+      hshm::ScopedMutex guard(read_cache_lock_, 0);
+      read_cache_->Cancel(size);
+    }
+    std::vector<std::shared_ptr<ReadCacheCopy>> unused(1, copy);
+    CHI_CO_AWAIT(FreeReadCacheCopies(std::move(unused)));
     CHI_CO_RETURN;
   }
 
-  error_code = 0;  // Success
+  ReadCache::Evicted replaced;
+  bool had = false;
+  {
+    hshm::ScopedMutex guard(read_cache_lock_, 0);
+    had = read_cache_->Insert(key, key.Hash(), size, copy, replaced);
+  }
+  read_cache_fills_.fetch_add(1, std::memory_order_relaxed);
+  if (had) {
+    std::vector<std::shared_ptr<ReadCacheCopy>> old_copy(
+        1, std::move(replaced.value_));
+    CHI_CO_AWAIT(FreeReadCacheCopies(std::move(old_copy)));
+  }
   CHI_CO_RETURN;
 }
 
-chi::TaskResume Runtime::ModifyExistingData(
-    const chi::priv::vector<BlobBlock> &blocks, hipc::ShmPtr<> data, size_t data_size,
-    size_t data_offset_in_blob, chi::u32 &error_code) {
+chi::TaskResume Runtime::InvalidateReadCache(const TagId &tag_id,
+                                             const std::string &blob_name) {
 #ifdef __NVCOMPILER
   thread_local chi::RunContext _fb_rctx;
   chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
   chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
 #endif
-  HLOG(kDebug,
-       "ModifyExistingData: blocks={}, data_size={}, data_offset_in_blob={}",
-       blocks.size(), data_size, data_offset_in_blob);
-
-  static thread_local size_t mod_count = 0;
-  static thread_local double t_setup_ms = 0, t_vec_alloc_ms = 0;
-  static thread_local double t_async_send_ms = 0, t_co_await_ms = 0;
-  hshm::Timer timer;
-
-  // Step 1: Initially store the remaining_size equal to data_size
-  size_t remaining_size = data_size;
-
-  // Vector to store async write tasks for later waiting
-  std::vector<chi::Future<chimaera::bdev::WriteTask>> write_tasks;
-  std::vector<size_t> expected_write_sizes;
-
-  // Step 2: Store the offset of the block in the blob. The first block is
-  // offset 0
-  size_t block_offset_in_blob = 0;
-
-  // Iterate over every block in the blob
-  for (size_t block_idx = 0; block_idx < blocks.size(); ++block_idx) {
-    const BlobBlock &block = blocks[block_idx];
-    HLOG(
-        kDebug,
-        "ModifyExistingData: block[{}] - target_offset={}, size={}, pool_id={}",
-        block_idx, block.target_offset_, block.size_,
-        block.bdev_client_.pool_id_.ToU64());
-
-    // Step 7: If remaining size is 0, quit the for loop
-    if (remaining_size == 0) {
-      break;
-    }
-
-    // Step 3: Check if the data we are writing is within the range
-    // [block_offset_in_blob, block_offset_in_blob + block.size)
-    size_t block_end_in_blob = block_offset_in_blob + block.size_;
-    size_t data_end_in_blob = data_offset_in_blob + data_size;
+  if (!read_cache_) {
+    CHI_CO_RETURN;
+  }
+  ReadCache::Evicted removed;
+  bool had = false;
+  {
+    hshm::ScopedMutex guard(read_cache_lock_, 0);
+    had = read_cache_->Erase(BlobKey(tag_id, blob_name), removed);
+  }
+  if (had) {
+    std::vector<std::shared_ptr<ReadCacheCopy>> old_copy(
+        1, std::move(removed.value_));
+    CHI_CO_AWAIT(FreeReadCacheCopies(std::move(old_copy)));
+  }
+  CHI_CO_RETURN;
+}
 
-    if (data_offset_in_blob < block_end_in_blob &&
-        data_end_in_blob > block_offset_in_blob) {
-      // Step 4: Clamp the range
-      timer.Resume();
-      size_t write_start_in_blob =
-          std::max(data_offset_in_blob, block_offset_in_blob);
-      size_t write_end_in_blob = std::min(data_end_in_blob, block_end_in_blob);
-      size_t write_size = write_end_in_blob - write_start_in_blob;
-      size_t write_start_in_block = write_start_in_blob - block_offset_in_blob;
-      size_t data_buffer_offset = write_start_in_blob - data_offset_in_blob;
-
-      chimaera::bdev::Block bdev_block(
-          block.target_offset_ + write_start_in_block, write_size, 0);
-      hipc::ShmPtr<> data_ptr = data + data_buffer_offset;
-      timer.Pause();
-      t_setup_ms += timer.GetMsec();
-      timer.Reset();
-
-      // Wrap single block in chi::priv::vector for AsyncWrite
-      timer.Resume();
-      chi::priv::vector<chimaera::bdev::Block> blocks(HSHM_MALLOC);
-      blocks.push_back(bdev_block);
-      timer.Pause();
-      t_vec_alloc_ms += timer.GetMsec();
-      timer.Reset();
-
-      // Create and send the async write task
-      timer.Resume();
-      chimaera::bdev::Client cte_clientcopy = block.bdev_client_;
-      auto write_task = cte_clientcopy.AsyncWrite(block.target_query_, blocks,
-                                                  data_ptr, write_size);
-      write_tasks.push_back(std::move(write_task));
-      expected_write_sizes.push_back(write_size);
-      timer.Pause();
-      t_async_send_ms += timer.GetMsec();
-      timer.Reset();
-
-      remaining_size -= write_size;
-    }
-
-    // Update block offset for next iteration
-    block_offset_in_blob += block.size_;
-  }
-
-  // Step 7: Wait for all Async write operations to complete
-  timer.Resume();
-  for (size_t task_idx = 0; task_idx < write_tasks.size(); ++task_idx) {
-    auto &task = write_tasks[task_idx];
-    size_t expected_size = expected_write_sizes[task_idx];
-    CHI_CO_AWAIT(task);
-    if (task->bytes_written_ != expected_size) {
-      error_code = 1;
-      CHI_CO_RETURN;
+chi::TaskResume Runtime::FreeReadCacheCopies(
+    std::vector<std::shared_ptr<ReadCacheCopy>> copies) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  std::vector<chimaera::bdev::Block> blocks;
+  for (const auto &copy : copies) {
+    // A hit read may still be copying out of these blocks
+    while (copy->readers_.load(std::memory_order_acquire) != 0) {
+      CHI_CO_AWAIT(chi::yield(kReadCachePollUs));
     }
+    blocks.insert(blocks.end(), copy->blocks_.begin(), copy->blocks_.end());
   }
-  timer.Pause();
-  t_co_await_ms += timer.GetMsec();
-  timer.Reset();
-
-  ++mod_count;
-  if (mod_count % 100 == 0) {
-    HLOG(kDebug,
-         "[ModifyExistingData] ops={} setup={:.3f} ms vec_alloc={:.3f} ms "
-         "async_send={:.3f} ms co_await={:.3f} ms",
-         mod_count, t_setup_ms, t_vec_alloc_ms, t_async_send_ms, t_co_await_ms);
-    t_setup_ms = t_vec_alloc_ms = t_async_send_ms = t_co_await_ms = 0;
+  if (blocks.empty()) {
+    CHI_CO_RETURN;
+  }
+  chimaera::bdev::Client cache_client(read_cache_id_);
+  auto free_task = cache_client.AsyncFreeBlocks(chi::PoolQuery::Local(),
+                                                blocks);
+  CHI_CO_AWAIT(free_task);
+  if (free_task->GetReturnCode() != 0) {
+    HLOG(kWarning, "FreeReadCacheCopies: failed to free {} cache blocks",
+         blocks.size());
   }
-
-  error_code = 0;  // Success
   CHI_CO_RETURN;
 }
 
-chi::TaskResume Runtime::ReadData(const chi::priv::vector<BlobBlock> &blocks,
+chi::TaskResume Runtime::ReadData(const BlobBlockList &blocks,
                                   hipc::ShmPtr<> data, size_t data_size,
                                   size_t data_offset_in_blob,
-                                  chi::u32 &error_code) {
+                                  chi::u32 &error_code, chi::u32 qos_class) {
 #ifdef __NVCOMPILER
   thread_local chi::RunContext _fb_rctx;
   chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
@@ -2547,119 +8401,105 @@ chi::TaskResume Runtime::ReadData(const chi::priv::vector<BlobBlock> &blocks,
   HLOG(kDebug, "ReadData: blocks={}, data_size={}, data_offset_in_blob={}",
        blocks.size(), data_size, data_offset_in_blob);
 
-  // Step 1: Initially store the remaining_size equal to data_size
-  size_t remaining_size = data_size;
+  // Packed objects may still be only in their segment's memory copy
+  if (!pack_open_.empty()) {
+    bool copied = false;
+    CHI_CO_AWAIT(ReadPackedData(blocks, data, data_size, data_offset_in_blob,
+                                copied));
+    if (copied) {
+      error_code = 0;
+      CHI_CO_RETURN;
+    }
+  }
+
+  // Step 1: Group the blocks covering the read into per-target runs. Reads
+  // never merge interleaved runs: a remote target would return its whole
+  // span and overwrite the gaps other targets fill.
+  std::vector<BlockIoRun> runs;
+  BuildBlockIoRuns(blocks, data_offset_in_blob, data_size, runs);
 
-  // Vector to store async read tasks for later waiting
+  // Step 2: Send one bdev read per run
   std::vector<chi::Future<chimaera::bdev::ReadTask>> read_tasks;
   std::vector<size_t> expected_read_sizes;
-
-  // Step 2: Store the offset of the block in the blob. The first block is
-  // offset 0
-  size_t block_offset_in_blob = 0;
-
-  // Iterate over every block in the blob
-  for (size_t block_idx = 0; block_idx < blocks.size(); ++block_idx) {
-    const BlobBlock &block = blocks[block_idx];
-    HLOG(kDebug, "ReadData: block[{}] - target_offset={}, size={}, pool_id={}",
-         block_idx, block.target_offset_, block.size_,
-         block.bdev_client_.pool_id_.ToU64());
-
-    // Step 7: If remaining size is 0, quit the for loop
-    if (remaining_size == 0) {
+  bool targets_resolved = true;
+  for (size_t run_idx = 0; run_idx < runs.size(); ++run_idx) {
+    const BlockIoRun &run = runs[run_idx];
+    HLOG(kDebug,
+         "ReadData: run[{}] - target=({},{}), blocks={}, size={}, "
+         "data_buffer_offset={}",
+         run_idx, run.target_id_.major_, run.target_id_.minor_,
+         run.blocks_.size(), run.size_, run.data_offset_);
+    chi::PoolQuery target_query;
+    if (!GetTargetQuery(run.target_id_, target_query)) {
+      HLOG(kError, "ReadData: target ({},{}) is not registered",
+           run.target_id_.major_, run.target_id_.minor_);
+      targets_resolved = false;
       break;
     }
-
-    // Step 3: Check if the data we are reading is within the range
-    // [block_offset_in_blob, block_offset_in_blob + block.size)
-    size_t block_end_in_blob = block_offset_in_blob + block.size_;
-    size_t data_end_in_blob = data_offset_in_blob + data_size;
-
-    if (data_offset_in_blob < block_end_in_blob &&
-        data_end_in_blob > block_offset_in_blob) {
-      // Step 4: Clamp the range [data_offset_in_blob, data_offset_in_blob +
-      // data_size) to the range [block_offset_in_blob, block_offset_in_blob +
-      // block.size)
-      size_t read_start_in_blob =
-          std::max(data_offset_in_blob, block_offset_in_blob);
-      size_t read_end_in_blob = std::min(data_end_in_blob, block_end_in_blob);
-      size_t read_size = read_end_in_blob - read_start_in_blob;
-
-      // Calculate offset within the block
-      size_t read_start_in_block = read_start_in_blob - block_offset_in_blob;
-
-      // Calculate offset into the data buffer
-      size_t data_buffer_offset = read_start_in_blob - data_offset_in_blob;
-
-      HLOG(kDebug,
-           "ReadData: block[{}] - reading read_size={}, "
-           "read_start_in_block={}, data_buffer_offset={}",
-           block_idx, read_size, read_start_in_block, data_buffer_offset);
-
-      // Step 5: Perform async read on the range
-      chimaera::bdev::Block bdev_block(
-          block.target_offset_ + read_start_in_block, read_size, 0);
-      hipc::ShmPtr<> data_ptr = data + data_buffer_offset;
-
-      // Wrap single block in chi::priv::vector for AsyncRead
-      chi::priv::vector<chimaera::bdev::Block> blocks(HSHM_MALLOC);
-      blocks.push_back(bdev_block);
-
-      chimaera::bdev::Client cte_clientcopy = block.bdev_client_;
-      auto read_task = cte_clientcopy.AsyncRead(block.target_query_, blocks,
-                                                data_ptr, read_size);
-
-      read_tasks.push_back(std::move(read_task));
-      expected_read_sizes.push_back(read_size);
-
-      // Step 6: Subtract the amount of data we have read from the
-      // remaining_size
-      remaining_size -= read_size;
+    chi::priv::vector<chimaera::bdev::Block> bdev_blocks(HSHM_MALLOC);
+    for (const auto &bdev_block : run.blocks_) {
+      bdev_blocks.push_back(bdev_block);
     }
-
-    // Update block offset for next iteration
-    block_offset_in_blob += block.size_;
+    if (qos_.Enabled()) {
+      CHI_CO_AWAIT(AdmitIo(qos_class, run.target_id_, run.size_));
+    }
+    chimaera::bdev::Client bdev_client(run.target_id_);
+    read_tasks.push_back(bdev_client.AsyncRead(
+        target_query, bdev_blocks, data + run.data_offset_, run.size_));
+    expected_read_sizes.push_back(run.size_);
   }
 
-  // Step 7: Wait for all Async read operations to complete
+  // Step 3: Wait for all Async read operations to complete. Every task is
+  // awaited to avoid use-after-free when buffers are freed by the caller.
   HLOG(kDebug, "ReadData: Waiting for {} async read tasks to complete",
        read_tasks.size());
+  bool reads_ok = targets_resolved;
   for (size_t task_idx = 0; task_idx < read_tasks.size(); ++task_idx) {
     auto &task = read_tasks[task_idx];
     size_t expected_size = expected_read_sizes[task_idx];
 
     CHI_CO_AWAIT(task);
-
-    HLOG(kDebug,
-         "ReadData: task[{}] completed - bytes_read={}, expected={}, status={}",
-         task_idx, task->bytes_read_, expected_size,
-         (task->bytes_read_ == expected_size ? "SUCCESS" : "FAILED"));
+    CountTargetIo(runs[task_idx].target_id_, task->bytes_read_, false);
 
     if (task->bytes_read_ != expected_size) {
       HLOG(kError,
            "ReadData: READ FAILED - task[{}] read {} bytes, expected {}",
            task_idx, task->bytes_read_, expected_size);
-      // Wait for all remaining in-flight tasks before returning to avoid
-      // use-after-free when buffers are freed by the caller.
-      for (size_t j = task_idx + 1; j < read_tasks.size(); ++j) {
-        co_await read_tasks[j];
-      }
-      error_code = 1;
-      CHI_CO_RETURN;
+      reads_ok = false;
     }
   }
 
+  if (!reads_ok) {
+    error_code = 1;
+    CHI_CO_RETURN;
+  }
   HLOG(kDebug, "ReadData: All read tasks completed successfully");
   error_code = 0;  // Success
   CHI_CO_RETURN;
 }
 
+chi::TaskResume Runtime::AdmitIo(chi::u32 qos_class,
+                                 const chi::PoolId &target_id,
+                                 chi::u64 bytes) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  QosScheduler::Ticket ticket =
+      qos_.Enqueue(qos_class, target_id, bytes, GetCurrentTimeNs());
+  double wait_us;
+  while ((wait_us = qos_.TryAdmit(ticket, GetCurrentTimeNs())) > 0) {
+    CHI_CO_AWAIT(chi::yield(wait_us));
+  }
+  CHI_CO_RETURN;
+}
+
 // Block management helper functions
 
-chi::TaskResume Runtime::AllocateFromTarget(TargetInfo &target_info,
-                                            chi::u64 size,
-                                            chi::u64 &allocated_offset,
-                                            bool &success) {
+chi::TaskResume Runtime::AllocateFromTarget(
+    TargetInfo &target_info, chi::u64 size,
+    std::vector<chimaera::bdev::Block> &allocated_blocks, bool &success) {
 #ifdef __NVCOMPILER
   thread_local chi::RunContext _fb_rctx;
   chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
@@ -2704,22 +8544,26 @@ chi::TaskResume Runtime::AllocateFromTarget(TargetInfo &target_info,
          "alloc_task->blocks_.size()={}, return_code={}",
          alloc_task->blocks_.size(), alloc_task->return_code_.load());
 
-    std::vector<chimaera::bdev::Block> allocated_blocks;
-    for (size_t i = 0; i < alloc_task->blocks_.size(); ++i) {
-      allocated_blocks.push_back(alloc_task->blocks_[i]);
+    // Large requests come back as several bdev blocks. Keep all of them,
+    // trimming each to the bytes this request actually uses (bdev may round
+    // block sizes up).
+    allocated_blocks.clear();
+    chi::u64 remaining = size;
+    for (size_t i = 0; i < alloc_task->blocks_.size() && remaining > 0; ++i) {
+      chimaera::bdev::Block block = alloc_task->blocks_[i];
+      block.size_ = std::min<chi::u64>(block.size_, remaining);
+      remaining -= block.size_;
+      allocated_blocks.push_back(block);
     }
 
-    // Check if we got any blocks
-    if (allocated_blocks.empty()) {
-      HLOG(kDebug, "AllocateFromTarget: FAILED - allocated_blocks is empty");
+    // Check if we got enough space
+    if (allocated_blocks.empty() || remaining > 0) {
+      HLOG(kDebug, "AllocateFromTarget: FAILED - allocated {} of {} bytes",
+           size - remaining, size);
       success = false;
       CHI_CO_RETURN;
     }
 
-    // Use the first block (for single allocation case)
-    chimaera::bdev::Block allocated_block = allocated_blocks[0];
-    allocated_offset = allocated_block.offset_;
-
     // Update remaining space
     target_info.remaining_space_ -= size;
     // HLOG(kInfo,
@@ -2736,6 +8580,41 @@ chi::TaskResume Runtime::AllocateFromTarget(TargetInfo &target_info,
   }
 }
 
+bool Runtime::CanWriteInPlace(const TagId &tag_id, const BlobInfo &blob_info,
+                              chi::u64 offset, chi::u64 size,
+                              float blob_score, int min_persistence_level) {
+  chi::u64 current_size = blob_info.GetTotalSize();
+  if (blob_info.IsStub() || blob_info.IsErasureCoded() ||
+      blob_info.IsEncrypted() || current_size == 0) {
+    return false;
+  }
+  // A reserved blob takes a write at offset 0 as one more chunk, not as a
+  // replacement that would give the reservation back
+  bool replaces = offset == 0 && blob_info.preallocated_size_ == 0;
+  if (replaces ? size != current_size : offset + size > current_size) {
+    return false;
+  }
+  // A replacement with a new score may belong on another tier
+  const Config &config = GetConfig();
+  if (replaces && std::abs(blob_score - blob_info.score_) >=
+                      config.performance_.score_difference_threshold_) {
+    return false;
+  }
+  chi::u32 erasure_data = 0;
+  chi::u32 erasure_parity = 0;
+  GetTagErasure(tag_id, erasure_data, erasure_parity);
+  if (erasure_data != 0 || GetTagEncryptChunk(tag_id) != 0 ||
+      (replaces && GetTagDedupChunk(tag_id) != 0)) {
+    return false;
+  }
+  // Packed objects are only ever appended
+  if (HasPackedBlocks(blob_info) || IsBlobShared(blob_info)) {
+    return false;
+  }
+  chi::ScopedCoRwReadLock read_lock(target_lock_);
+  return !HasBlocksBelow(blob_info, min_persistence_level);
+}
+
 chi::TaskResume Runtime::ClearBlob(BlobInfo &blob_info, float blob_score,
                                    chi::u64 offset, chi::u64 size,
                                    bool &cleared) {
@@ -2758,6 +8637,8 @@ chi::TaskResume Runtime::ClearBlob(BlobInfo &blob_info, float blob_score,
   chi::u32 free_result = 0;
   CHI_CO_AWAIT(FreeAllBlobBlocks(blob_info, free_result));
   if (free_result == 0) {
+    // The replacement gave the reserved blocks back
+    blob_info.preallocated_size_ = 0;
     cleared = true;
   }
   CHI_CO_RETURN;
@@ -2775,9 +8656,32 @@ chi::TaskResume Runtime::FreeAllBlobBlocks(BlobInfo &blob_info,
                                             std::vector<chimaera::bdev::Block>>>
       blocks_by_pool;
 
+  // A block another blob still references is only released; the last
+  // other holder then owns it alone
+  SettleDeferredBlocks(blob_info);
+  std::vector<BlobBlock> owned_blocks;
+  owned_blocks.reserve(blob_info.blocks_.size());
+  {
+    hshm::ScopedMutex guard(block_refs_lock_, 0);
+    for (const auto &blob_block : blob_info.blocks_) {
+      auto it = block_refs_.find(blob_block);
+      if (it != block_refs_.end()) {
+        if (--it->second <= 1) {
+          block_refs_.erase(it);
+        }
+        continue;
+      }
+      EraseFingerprint(blob_block);
+      owned_blocks.push_back(blob_block);
+    }
+  }
+  // Packed objects give their bytes back to the segment, not the target
+  std::vector<chi::u64> reclaim;
+  ReleasePackedBlocks(owned_blocks, reclaim);
+
   // Group blocks by PoolId
-  for (const auto &blob_block : blob_info.blocks_) {
-    chi::PoolId pool_id = blob_block.bdev_client_.pool_id_;
+  for (const auto &blob_block : owned_blocks) {
+    chi::PoolId pool_id = blob_block.target_id_;
     chimaera::bdev::Block block;
     block.offset_ = blob_block.target_offset_;
     block.size_ = blob_block.size_;
@@ -2785,8 +8689,14 @@ chi::TaskResume Runtime::FreeAllBlobBlocks(BlobInfo &blob_info,
 
     // Store target_query with blocks for this pool
     if (blocks_by_pool.find(pool_id) == blocks_by_pool.end()) {
+      chi::PoolQuery target_query;
+      if (!GetTargetQuery(pool_id, target_query)) {
+        HLOG(kWarning, "Skipping free of blocks on unregistered pool {}",
+             pool_id.major_);
+        continue;
+      }
       blocks_by_pool[pool_id] = std::make_pair(
-          blob_block.target_query_, std::vector<chimaera::bdev::Block>());
+          target_query, std::vector<chimaera::bdev::Block>());
     }
     blocks_by_pool[pool_id].second.push_back(block);
   }
@@ -2822,8 +8732,13 @@ chi::TaskResume Runtime::FreeAllBlobBlocks(BlobInfo &blob_info,
     }
   }
 
+  for (chi::u64 seg_id : reclaim) {
+    CHI_CO_AWAIT(FreePackSegment(seg_id));
+  }
+
   // Clear all blocks
   blob_info.blocks_.clear();
+  blob_info.ClearErasureLayout();
   error_code = 0;
   CHI_CO_RETURN;
 }
@@ -2831,51 +8746,18 @@ chi::TaskResume Runtime::FreeAllBlobBlocks(BlobInfo &blob_info,
 void Runtime::LogTelemetry(CteOp op, size_t off, size_t size,
                            const TagId &tag_id, const Timestamp &mod_time,
                            const Timestamp &read_time) {
-  // Increment atomic counter and get current logical time
-  std::uint64_t logical_time = telemetry_counter_.fetch_add(1) + 1;
-
-  // Create telemetry entry with logical time and enqueue it
-  CteTelemetry telemetry_entry(op, off, size, tag_id, mod_time, read_time,
-                               logical_time);
-
-  // Circular queue automatically overwrites oldest entries when full
-  telemetry_log_->Push(telemetry_entry);
+  // Each worker owns one ring; the log assigns the logical time
+  chi::u32 wid = CHI_CUR_WORKER->GetWorkerStats().worker_id_;
+  telemetry_log_.Log(wid, CteTelemetry(op, off, size, tag_id, mod_time,
+                                       read_time));
 }
 
-size_t Runtime::GetTelemetryQueueSize() { return telemetry_log_->Size(); }
+size_t Runtime::GetTelemetryQueueSize() { return telemetry_log_.Size(); }
 
 size_t Runtime::GetTelemetryEntries(std::vector<CteTelemetry> &entries,
+                                    std::uint64_t min_logical_time,
                                     size_t max_entries) {
-  entries.clear();
-  size_t queue_size = telemetry_log_->Size();
-  size_t entries_to_read = std::min(max_entries, queue_size);
-
-  entries.reserve(entries_to_read);
-
-  // Read entries by popping and re-pushing them (since peek may not be
-  // available)
-  std::vector<CteTelemetry> temp_entries;
-  temp_entries.reserve(entries_to_read);
-
-  // Pop entries temporarily
-  for (size_t i = 0; i < entries_to_read; ++i) {
-    CteTelemetry entry;
-    bool success = telemetry_log_->Pop(entry);
-    if (success) {
-      temp_entries.push_back(entry);
-    } else {
-      break;  // Queue is empty
-    }
-  }
-
-  // Re-push entries back to queue (in reverse order to maintain order)
-  for (auto it = temp_entries.rbegin(); it != temp_entries.rend(); ++it) {
-    telemetry_log_->Push(*it);
-  }
-
-  // Copy to output vector
-  entries = temp_entries;
-  return entries.size();
+  return telemetry_log_.Collect(entries, min_logical_time, max_entries);
 }
 
 chi::TaskResume Runtime::PollTelemetryLog(
@@ -2889,23 +8771,25 @@ chi::TaskResume Runtime::PollTelemetryLog(
   try {
     std::uint64_t minimum_logical_time = task->minimum_logical_time_;
 
-    // Get telemetry entries with logical time filtering
+    // Oldest entries at or after the minimum logical time, so a client
+    // that polls from last_logical_time_ + 1 pages through the log
     std::vector<CteTelemetry> all_entries;
-    size_t retrieved_count = GetTelemetryEntries(all_entries, 1000);
-    (void)retrieved_count;
+    GetTelemetryEntries(all_entries, minimum_logical_time, kTelemetryPollMax);
 
-    // Filter entries by minimum logical time
     task->entries_.clear();
     std::uint64_t max_logical_time = minimum_logical_time;
-
     for (const auto &entry : all_entries) {
-      if (entry.logical_time_ >= minimum_logical_time) {
-        task->entries_.push_back(entry);
-        max_logical_time = std::max(max_logical_time, entry.logical_time_);
-      }
+      task->entries_.push_back(entry);
+      max_logical_time = std::max(max_logical_time, entry.logical_time_);
     }
 
     task->last_logical_time_ = max_logical_time;
+
+    // QoS queueing is reported whole on every poll
+    task->qos_classes_.clear();
+    for (const QosClassTelemetry &stats : qos_.GetTelemetry()) {
+      task->qos_classes_.push_back(stats);
+    }
     task->return_code_ = 0;
 
   } catch (const std::exception &e) {
@@ -2936,6 +8820,10 @@ chi::TaskResume Runtime::GetBlobScore(hipc::FullPtr<GetBlobScoreTask> task,
     }
 
     // Step 1: Check if blob exists
+    BlobMetaTable::Ticket ticket;
+    if (blob_meta_) {
+      ticket = blob_meta_->GetTicket(tag_id, blob_name);
+    }
     BlobInfo *blob_info_ptr = CheckBlobExists(blob_name, tag_id);
 
     if (blob_info_ptr == nullptr) {
@@ -2945,6 +8833,7 @@ chi::TaskResume Runtime::GetBlobScore(hipc::FullPtr<GetBlobScoreTask> task,
 
     // Step 2: Return the blob score
     task->score_ = blob_info_ptr->score_;
+    PublishBlobMeta(tag_id, blob_name, ticket, *blob_info_ptr);
 
     // Step 3: Update timestamps and log telemetry
     auto now = GetCurrentTimeNs();
@@ -2987,6 +8876,10 @@ chi::TaskResume Runtime::GetBlobSize(hipc::FullPtr<GetBlobSizeTask> task,
     }
 
     // Step 1: Check if blob exists
+    BlobMetaTable::Ticket ticket;
+    if (blob_meta_) {
+      ticket = blob_meta_->GetTicket(tag_id, blob_name);
+    }
     BlobInfo *blob_info_ptr = CheckBlobExists(blob_name, tag_id);
     if (blob_info_ptr == nullptr) {
       task->return_code_ = 1;  // Blob not found
@@ -2994,7 +8887,8 @@ chi::TaskResume Runtime::GetBlobSize(hipc::FullPtr<GetBlobSizeTask> task,
     }
 
     // Step 2: Calculate and return the blob size
-    task->size_ = blob_info_ptr->GetTotalSize();
+    task->size_ = blob_info_ptr->GetLogicalSize();
+    PublishBlobMeta(tag_id, blob_name, ticket, *blob_info_ptr);
 
     // Step 3: Update timestamps and log telemetry
     auto now = GetCurrentTimeNs();
@@ -3037,6 +8931,10 @@ chi::TaskResume Runtime::GetBlobInfo(hipc::FullPtr<GetBlobInfoTask> task,
     }
 
     // Step 1: Check if blob exists
+    BlobMetaTable::Ticket ticket;
+    if (blob_meta_) {
+      ticket = blob_meta_->GetTicket(tag_id, blob_name);
+    }
     BlobInfo *blob_info_ptr = CheckBlobExists(blob_name, tag_id);
     if (blob_info_ptr == nullptr) {
       task->return_code_ = 2;  // Blob not found
@@ -3045,7 +8943,8 @@ chi::TaskResume Runtime::GetBlobInfo(hipc::FullPtr<GetBlobInfoTask> task,
 
     // Step 2: Populate output fields
     task->score_ = blob_info_ptr->score_;
-    task->total_size_ = blob_info_ptr->GetTotalSize();
+    task->total_size_ = blob_info_ptr->GetLogicalSize();
+    PublishBlobMeta(tag_id, blob_name, ticket, *blob_info_ptr);
 
     // Step 3: Populate block information
     // NOTE: Temporarily disabled to debug serialization issue
@@ -3098,20 +8997,16 @@ chi::TaskResume Runtime::GetContainedBlobs(
     // Clear output vector
     task->blob_names_.clear();
 
-    // Construct prefix for this tag's blobs
-    std::string prefix = std::to_string(tag_id.major_) + "." +
-                         std::to_string(tag_id.minor_) + ".";
-
-    // Iterate through tag_blob_name_to_info_ and filter by prefix
-    tag_blob_name_to_info_.for_each(
-        [&prefix, &task](const std::string &composite_key,
-                         const BlobInfo &blob_info) {
-          // Check if composite key starts with the tag prefix
-          if (composite_key.rfind(prefix, 0) == 0) {
-            // Extract blob name (everything after the prefix)
-            std::string blob_name = composite_key.substr(prefix.length());
+    // Walk only this tag's members via the per-tag index
+    // (replica copies are listed by their primary only)
+    task->blob_names_.reserve(tag_blob_name_to_info_.TagBlobCount(tag_id));
+    chi::u32 replicas = GetTagReplicas(tag_id);
+    tag_blob_name_to_info_.ForEachTagBlob(
+        tag_id, "", [&](const std::string &blob_name) {
+          if (!IsReplicaCopy(tag_id, blob_name, replicas)) {
             task->blob_names_.push_back(blob_name);
           }
+          return true;
         });
 
     // Success
@@ -3133,6 +9028,26 @@ chi::TaskResume Runtime::GetContainedBlobs(
   CHI_TASK_BODY_END
 }
 
+std::vector<std::pair<std::string, TagId>> Runtime::CollectMatchingTags(
+    const NamePattern &pattern) {
+  std::vector<std::pair<std::string, TagId>> matching_tags;
+  if (pattern.GetKind() == NamePattern::Kind::kLiteral) {
+    TagId *tag_id_ptr = tag_name_to_id_.find(pattern.GetPrefix());
+    if (tag_id_ptr != nullptr) {
+      matching_tags.emplace_back(pattern.GetPrefix(), *tag_id_ptr);
+    }
+    return matching_tags;
+  }
+  tag_name_to_id_.for_each(
+      [&pattern, &matching_tags](const std::string &tag_name,
+                                 const TagId &tag_id) {
+        if (pattern.Match(tag_name)) {
+          matching_tags.emplace_back(tag_name, tag_id);
+        }
+      });
+  return matching_tags;
+}
+
 chi::TaskResume Runtime::TagQuery(hipc::FullPtr<TagQueryTask> task,
                                   chi::RunContext &ctx) {
 #ifdef __NVCOMPILER
@@ -3144,18 +9059,12 @@ chi::TaskResume Runtime::TagQuery(hipc::FullPtr<TagQueryTask> task,
   try {
     std::string tag_regex = task->tag_regex_.str();
 
-    // Create regex pattern
-    std::regex pattern(tag_regex);
+    // Classify the pattern (compiled at most once per node)
+    auto pattern = NamePattern::Get(tag_regex);
 
     // Collect matching tags (name + id)
-    std::vector<std::pair<std::string, TagId>> matching_tags;
-    tag_name_to_id_.for_each(
-        [&pattern, &matching_tags](const std::string &tag_name,
-                                   const TagId &tag_id) {
-          if (std::regex_match(tag_name, pattern)) {
-            matching_tags.emplace_back(tag_name, tag_id);
-          }
-        });
+    std::vector<std::pair<std::string, TagId>> matching_tags =
+        CollectMatchingTags(*pattern);
 
     // Total matched tags (summed across replicas during Aggregate)
     task->total_tags_matched_ = matching_tags.size();
@@ -3195,54 +9104,79 @@ chi::TaskResume Runtime::BlobQuery(hipc::FullPtr<BlobQueryTask> task,
   try {
     std::string tag_regex = task->tag_regex_.str();
     std::string blob_regex = task->blob_regex_.str();
+    std::string cursor_tag = task->cursor_tag_.str();
+    std::string cursor_blob = task->cursor_blob_.str();
+
+    // Classify the patterns (compiled at most once per node). Literal and
+    // prefix blob patterns become range scans of each tag's sorted members.
+    auto tag_pattern = NamePattern::Get(tag_regex);
+    auto blob_pattern = NamePattern::Get(blob_regex);
+
+    // Find matching tags at or after the cursor, in name order
+    std::vector<std::pair<std::string, TagId>> matching_tags =
+        CollectMatchingTags(*tag_pattern);
+    std::sort(matching_tags.begin(), matching_tags.end(),
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+    if (!cursor_tag.empty()) {
+      matching_tags.erase(
+          matching_tags.begin(),
+          std::lower_bound(matching_tags.begin(), matching_tags.end(),
+                           cursor_tag, [](const auto &tn, const auto &name) {
+                             return tn.first < name;
+                           }));
+    }
 
-    // Create regex patterns
-    std::regex tag_pattern(tag_regex);
-    std::regex blob_pattern(blob_regex);
-
-    // Find matching tag IDs and names
-    std::vector<std::pair<std::string, TagId>> matching_tags;
-    tag_name_to_id_.for_each(
-        [&tag_pattern, &matching_tags](const std::string &tag_name,
-                                       const TagId &tag_id) {
-          if (std::regex_match(tag_name, tag_pattern)) {
-            matching_tags.emplace_back(tag_name, tag_id);
-          }
-        });
-
-    // Build results: pairs of (tag_name, blob_name) for matching blobs.
-    // Also compute total_blobs_matched_.
+    // Build results: pairs of (tag_name, blob_name) in order, stopping as
+    // soon as max_blobs_ results are held (early termination).
     task->tag_names_.clear();
     task->blob_names_.clear();
     task->total_blobs_matched_ = 0;
+    task->has_more_ = false;
+    size_t limit = task->max_blobs_ == 0
+                       ? std::numeric_limits<size_t>::max()
+                       : static_cast<size_t>(task->max_blobs_);
 
     for (const auto &tn : matching_tags) {
       const std::string &tag_name = tn.first;
       const TagId &tag_id = tn.second;
+      if (task->tag_names_.size() >= limit) {
+        task->has_more_ = true;
+        break;
+      }
+      // Resume strictly after the cursor blob within the cursor tag
+      const std::string *start_after =
+          (!cursor_tag.empty() && tag_name == cursor_tag) ? &cursor_blob
+                                                          : nullptr;
+      chi::u32 replicas = GetTagReplicas(tag_id);  // Skip replica copies
+
+      if (blob_pattern->GetKind() == NamePattern::Kind::kLiteral) {
+        const std::string &blob_name = blob_pattern->GetPrefix();
+        if ((start_after == nullptr || blob_name > *start_after) &&
+            tag_blob_name_to_info_.Find(tag_id, blob_name) != nullptr &&
+            !IsReplicaCopy(tag_id, blob_name, replicas)) {
+          task->total_blobs_matched_++;
+          task->tag_names_.push_back(tag_name);
+          task->blob_names_.push_back(blob_name);
+        }
+        continue;
+      }
 
-      // Construct prefix for this tag's blobs
-      std::string prefix = std::to_string(tag_id.major_) + "." +
-                           std::to_string(tag_id.minor_) + ".";
-
-      // Iterate and collect matching blobs for this tag
-      tag_blob_name_to_info_.for_each(
-          [&prefix, &blob_pattern, &tag_name, &task](
-              const std::string &composite_key, const BlobInfo &blob_info) {
-            (void)blob_info;
-            if (composite_key.rfind(prefix, 0) == 0) {
-              std::string blob_name = composite_key.substr(prefix.length());
-              if (std::regex_match(blob_name, blob_pattern)) {
-                // Increase total matched counter (counts all matches)
-                task->total_blobs_matched_++;
-                // Respect max_blobs_ if set
-                if (task->max_blobs_ == 0 ||
-                    task->tag_names_.size() <
-                        static_cast<size_t>(task->max_blobs_)) {
-                  task->tag_names_.push_back(tag_name);
-                  task->blob_names_.push_back(blob_name);
-                }
-              }
+      // Range-scan this tag's members that share the literal prefix
+      tag_blob_name_to_info_.ForEachTagBlob(
+          tag_id, blob_pattern->GetPrefix(), start_after,
+          [&, limit](const std::string &blob_name) {
+            if (!blob_pattern->Match(blob_name) ||
+                IsReplicaCopy(tag_id, blob_name, replicas)) {
+              return true;
+            }
+            if (task->tag_names_.size() >= limit) {
+              task->has_more_ = true;
+              return false;
             }
+            task->total_blobs_matched_++;
+            task->tag_names_.push_back(tag_name);
+            task->blob_names_.push_back(blob_name);
+            return true;
           });
     }
 
@@ -3267,7 +9201,33 @@ chi::TaskResume Runtime::BlobQuery(hipc::FullPtr<BlobQueryTask> task,
 
 chi::PoolQuery Runtime::HashBlobToContainer(const TagId &tag_id,
                                             const std::string &blob_name) {
-  // Compute hash from tag_id and blob_name
+  TagPlacement placement = GetTagPlacement(tag_id);
+  std::shared_ptr<const HashRing> ring = GetPlacementRing();
+  if (!ring && placement.IsDefault()) {
+    return chi::PoolQuery::DirectHash(HashBlobKey(tag_id, blob_name));
+  }
+  std::vector<chi::ContainerId> containers =
+      GetBlobReplicas(tag_id, blob_name, 1);
+  if (containers.empty()) {
+    return chi::PoolQuery::DirectHash(HashBlobKey(tag_id, blob_name));
+  }
+  return chi::PoolQuery::DirectId(containers[0]);
+}
+
+std::shared_ptr<const HashRing> Runtime::GetPlacementRing() {
+  chi::ScopedCoRwReadLock lock(placement_lock_);
+  return placement_ring_;
+}
+
+chi::u32 Runtime::HashBlobKey(const TagId &tag_id,
+                              const std::string &blob_name) {
+  if (blob_hash_id_ == BlobHashId::kHashBytes) {
+    chi::u64 seed = static_cast<chi::u64>(tag_id.major_) << 32 | tag_id.minor_;
+    return static_cast<chi::u32>(
+        hshm::HashBytes(blob_name.data(), blob_name.size(), seed));
+  }
+
+  // kLegacy: compute hash from tag_id and blob_name
   std::hash<std::string> string_hasher;
   std::hash<chi::u32> u32_hasher;
 
@@ -3277,8 +9237,220 @@ chi::PoolQuery Runtime::HashBlobToContainer(const TagId &tag_id,
                 (hash_value >> 2);
   hash_value ^= static_cast<chi::u32>(string_hasher(blob_name)) + 0x9e3779b9 +
                 (hash_value << 6) + (hash_value >> 2);
+  return hash_value;
+}
+
+TagPlacement Runtime::GetTagPlacement(const TagId &tag_id) {
+  chi::ScopedCoRwReadLock lock(placement_lock_);
+  auto it = tag_placement_.find(tag_id);
+  return it != tag_placement_.end() ? it->second : TagPlacement();
+}
+
+chi::u32 Runtime::PlacementKey(const TagId &tag_id,
+                               const std::string &blob_name,
+                               const TagPlacement &placement,
+                               const HashRing *ring) {
+  switch (placement.policy_) {
+    case TagPlacementPolicy::kHashTag:
+    case TagPlacementPolicy::kPinCreator:
+      return HashBlobKey(tag_id, "");
+    case TagPlacementPolicy::kStripe: {
+      // Blobs named by page index (the filesystem adapters) are grouped
+      // into stripes; other names fall back to the blob-name hash
+      chi::u64 page = 0;
+      const char *begin = blob_name.data();
+      const char *end = begin + blob_name.size();
+      auto [ptr, ec] = std::from_chars(begin, end, page);
+      if (placement.stripe_pages_ == 0 || blob_name.empty() ||
+          ec != std::errc() || ptr != end) {
+        break;
+      }
+      chi::u64 stripe = page / placement.stripe_pages_;
+      if (ring) {
+        return HashBlobKey(tag_id, std::to_string(stripe));
+      }
+      // Modulo placement deals consecutive stripes round-robin
+      return HashBlobKey(tag_id, "") + static_cast<chi::u32>(stripe);
+    }
+    case TagPlacementPolicy::kFollowTag: {
+      // GetOrCreateTag resolves chains, so the followed tag never follows
+      TagPlacement followed = GetTagPlacement(placement.follow_tag_);
+      if (followed.policy_ == TagPlacementPolicy::kFollowTag) {
+        followed = TagPlacement();
+      }
+      return PlacementKey(placement.follow_tag_, blob_name, followed, ring);
+    }
+    default:
+      break;
+  }
+  return HashBlobKey(tag_id, blob_name);
+}
+
+chi::u32 Runtime::GetTagReplicas(const TagId &tag_id) {
+  chi::u32 replicas = 1;
+  {
+    chi::ScopedCoRwReadLock lock(replication_lock_);
+    auto it = tag_replicas_.find(tag_id);
+    if (it != tag_replicas_.end()) {
+      replicas = it->second;
+    }
+  }
+  if (replicas <= 1) {
+    return 1;
+  }
+  auto *pool_manager = CHI_POOL_MANAGER;
+  const chi::PoolInfo *pool_info = pool_manager->GetPoolInfo(pool_id_);
+  if (pool_info == nullptr || pool_info->num_containers_ == 0) {
+    return 1;
+  }
+  return std::min(replicas, pool_info->num_containers_);
+}
+
+std::vector<chi::ContainerId> Runtime::GetBlobReplicas(
+    const TagId &tag_id, const std::string &blob_name, chi::u32 replicas) {
+  std::vector<chi::ContainerId> containers;
+  auto *pool_manager = CHI_POOL_MANAGER;
+  const chi::PoolInfo *pool_info = pool_manager->GetPoolInfo(pool_id_);
+  if (pool_info == nullptr || pool_info->num_containers_ == 0) {
+    return containers;
+  }
+  // Same primary as HashBlobToContainer, then the following containers.
+  // A pinned tag ignores the ring.
+  chi::u32 num_containers = pool_info->num_containers_;
+  TagPlacement placement = GetTagPlacement(tag_id);
+  chi::ContainerId primary;
+  if (placement.policy_ == TagPlacementPolicy::kPinCreator &&
+      placement.pin_container_ < num_containers) {
+    primary = placement.pin_container_;
+  } else {
+    std::shared_ptr<const HashRing> ring = GetPlacementRing();
+    chi::u32 key = PlacementKey(tag_id, blob_name, placement, ring.get());
+    if (ring) {
+      return ring->Successors(key, std::min(replicas, num_containers));
+    }
+    primary = key % num_containers;
+  }
+  for (chi::u32 i = 0; i < replicas && i < num_containers; ++i) {
+    containers.push_back((primary + i) % num_containers);
+  }
+  return containers;
+}
+
+bool Runtime::IsReplicaCopy(const TagId &tag_id, const std::string &blob_name,
+                            chi::u32 replicas) {
+  if (replicas <= 1) {
+    return false;
+  }
+  std::vector<chi::ContainerId> containers =
+      GetBlobReplicas(tag_id, blob_name, replicas);
+  return !containers.empty() && !IsLocalContainer(containers[0]);
+}
+
+bool Runtime::IsLocalContainer(chi::ContainerId container_id) const {
+  if (container_id == container_id_) {
+    return true;
+  }
+  auto *pool_manager = CHI_POOL_MANAGER;
+  auto *ipc_manager = CHI_IPC;
+  if (pool_manager->GetContainerNodeId(pool_id_, container_id) !=
+      ipc_manager->GetNodeId()) {
+    return false;
+  }
+  // Another shard on this node keeps its own metadata; only a container
+  // whose tasks fall back to this one is served here
+  bool is_plugged = false;
+  return pool_manager->GetContainer(pool_id_, container_id, is_plugged) ==
+         this;
+}
+
+chi::PoolQuery Runtime::ScheduleReplicaRead(const TagId &tag_id,
+                                            const std::string &blob_name) {
+  chi::u32 replicas = GetTagReplicas(tag_id);
+  if (replicas <= 1) {
+    return HashBlobToContainer(tag_id, blob_name);
+  }
+  std::vector<chi::ContainerId> containers =
+      GetBlobReplicas(tag_id, blob_name, replicas);
+  if (containers.empty()) {
+    return HashBlobToContainer(tag_id, blob_name);
+  }
+  // Closest first: a replica hosted on this node needs no network hop
+  auto *pool_manager = CHI_POOL_MANAGER;
+  for (chi::ContainerId container_id : containers) {
+    if (pool_manager->HasContainer(pool_id_, container_id)) {
+      return chi::PoolQuery::DirectId(container_id);
+    }
+  }
+  // Otherwise rotate across the replicas to spread the read load
+  chi::u32 pick = replica_read_rr_.fetch_add(1, std::memory_order_relaxed);
+  return chi::PoolQuery::DirectId(containers[pick % containers.size()]);
+}
+
+chi::TaskResume Runtime::ReplicateBlobWrite(hipc::FullPtr<PutBlobTask> task,
+                                            float score, chi::u32 replicas) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  std::string blob_name = task->blob_name_.str();
+  std::vector<chi::ContainerId> containers =
+      GetBlobReplicas(task->tag_id_, blob_name, replicas);
+  std::vector<chi::Future<PutBlobTask>> put_tasks;
+  for (size_t i = 1; i < containers.size(); ++i) {
+    put_tasks.push_back(client_.AsyncPutBlob(
+        task->tag_id_, blob_name, task->offset_, task->size_,
+        task->blob_data_, score, task->context_, task->flags_,
+        chi::PoolQuery::DirectId(containers[i])));
+  }
+  chi::u32 acks = 1;  // The primary already applied the write
+  for (auto &put_task : put_tasks) {
+    CHI_CO_AWAIT(put_task);
+    if (put_task->GetReturnCode() == 0) {
+      acks++;
+    } else {
+      HLOG(kWarning, "PutBlob: replica write of {} failed (error {})",
+           blob_name, put_task->GetReturnCode());
+    }
+  }
+  // Quorum: the write succeeds once a majority of the replicas hold it
+  if (acks * 2 <= containers.size()) {
+    task->return_code_ = 30;
+  }
+  CHI_CO_RETURN;
+}
+
+chi::TaskResume Runtime::ReplicateBlobDelete(
+    const TagId &tag_id, const std::string &blob_name,
+    const std::vector<chi::ContainerId> &replicas) {
+#ifdef __NVCOMPILER
+  thread_local chi::RunContext _fb_rctx;
+  chi::RunContext* _fp = chi::GetCurrentRunContextFromWorker();
+  chi::RunContext& rctx = _fp ? *_fp : _fb_rctx;
+#endif
+  std::vector<chi::Future<DelBlobTask>> del_tasks;
+  for (size_t i = 1; i < replicas.size(); ++i) {
+    del_tasks.push_back(client_.AsyncDelBlob(
+        tag_id, blob_name, chi::PoolQuery::DirectId(replicas[i])));
+  }
+  for (auto &del_task : del_tasks) {
+    CHI_CO_AWAIT(del_task);
+  }
+  CHI_CO_RETURN;
+}
 
-  return chi::PoolQuery::DirectHash(hash_value);
+std::vector<chi::u32> Runtime::SnapshotContainerNodes() {
+  std::vector<chi::u32> nodes;
+  auto *pool_manager = CHI_POOL_MANAGER;
+  const chi::PoolInfo *pool_info = pool_manager->GetPoolInfo(pool_id_);
+  if (pool_info == nullptr) {
+    return nodes;
+  }
+  nodes.reserve(pool_info->num_containers_);
+  for (chi::u32 i = 0; i < pool_info->num_containers_; ++i) {
+    nodes.push_back(pool_manager->GetContainerNodeId(pool_id_, i));
+  }
+  return nodes;
 }
 
 chi::TaskResume Runtime::Monitor(hipc::FullPtr<MonitorTask> task,
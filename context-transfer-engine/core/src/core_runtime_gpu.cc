@@ -388,22 +388,27 @@ HSHM_GPU_FUN void GpuRuntime::PutBlob(
   (void)rctx;
   if (!chi::gpu::IpcManager::IsWarpScheduler()) return;
   EnsureMetaInit();
-  TagId tag_id = task->tag_id_;
-  const char *blob_name = task->blob_name_.data();
-  int blob_name_len = static_cast<int>(task->blob_name_.size());
-  chi::u64 size = task->size_;
-  float blob_score = task->score_;
+  task->return_code_ = StoreBlob(
+      task->tag_id_, task->blob_name_.data(),
+      static_cast<int>(task->blob_name_.size()), task->size_, task->score_,
+      task->blob_data_);
+}
 
+HSHM_GPU_FUN chi::u32 GpuRuntime::StoreBlob(const TagId &tag_id,
+                                            const char *blob_name,
+                                            int blob_name_len, chi::u64 size,
+                                            float blob_score,
+                                            hipc::ShmPtr<> blob_data) {
   // Validate inputs
-  if (size == 0) { task->return_code_ = 2; return; }
-  if (task->blob_data_.IsNull()) { task->return_code_ = 3; return; }
-  if (blob_name_len == 0) { task->return_code_ = 4; return; }
+  if (size == 0) return 2;
+  if (blob_data.IsNull()) return 3;
+  if (blob_name_len == 0) return 4;
   if (blob_score < 0.0f) blob_score = 1.0f;
-  if (blob_score > 1.0f) { task->return_code_ = 5; return; }
+  if (blob_score > 1.0f) return 5;
 
   // Resolve blob data pointer
-  auto data_ptr = CHI_IPC->ToFullPtr(task->blob_data_);
-  if (data_ptr.IsNull()) { task->return_code_ = 6; return; }
+  auto data_ptr = CHI_IPC->ToFullPtr(blob_data);
+  if (data_ptr.IsNull()) return 6;
 
   // Build compound key and lock the blob map bucket
   chi::priv::string ck = MakeCompoundKey(tag_id, blob_name, blob_name_len);
@@ -418,8 +423,7 @@ HSHM_GPU_FUN void GpuRuntime::PutBlob(
       auto result = meta_->blob_map_.insert_locked(ck, GpuBlobEntry());
       if (result.value == nullptr) {
         meta_->blob_map_.unlock_key(ck);
-        task->return_code_ = 10;
-        return;
+        return 10;
       }
       entry = result.value;
       is_new_blob = true;
@@ -443,8 +447,7 @@ HSHM_GPU_FUN void GpuRuntime::PutBlob(
       }
     }
     if (!found) {
-      task->return_code_ = 7;  // No space available
-      return;
+      return 7;  // No space available
     }
   }
 
@@ -457,8 +460,7 @@ HSHM_GPU_FUN void GpuRuntime::PutBlob(
   alloc_future.WaitGpu();
 
   if (alloc_task_ptr->blocks_.empty()) {
-    task->return_code_ = 8;  // Allocation failed
-    return;
+    return 8;  // Allocation failed
   }
 
   // Copy data to allocated blocks via bdev
@@ -466,13 +468,12 @@ HSHM_GPU_FUN void GpuRuntime::PutBlob(
   warp_query.SetParallelism(32);
   auto write_task_ptr = CHI_IPC->NewTask<chimaera::bdev::WriteTask>(
       chi::CreateTaskId(), target_info.bdev_client_.pool_id_,
-      warp_query, alloc_task_ptr->blocks_, task->blob_data_, size);
+      warp_query, alloc_task_ptr->blocks_, blob_data, size);
   auto write_future = CHI_IPC->Send(write_task_ptr);
   write_future.WaitGpu();
 
   if (write_task_ptr->return_code_ != 0) {
-    task->return_code_ = 9;  // Write failed
-    return;
+    return 9;  // Write failed
   }
 
   // Re-lock blob key and update entry with blocks
@@ -483,16 +484,16 @@ HSHM_GPU_FUN void GpuRuntime::PutBlob(
     entry = meta_->blob_map_.find_locked(ck);
     if (entry == nullptr) {
       meta_->blob_map_.unlock_key(ck);
-      task->return_code_ = 11;
-      return;
+      return 11;
     }
 
-    // Create BlobBlock structs from allocated blocks
+    // Create BlobBlock structs from allocated blocks, merging adjacent ones
     entry->blocks_.clear();
     for (size_t i = 0; i < alloc_task_ptr->blocks_.size(); ++i) {
-      BlobBlock blk(target_info.bdev_client_, target_info.target_query_,
-                    alloc_task_ptr->blocks_[i].offset_, alloc_task_ptr->blocks_[i].size_);
-      entry->blocks_.push_back(blk);
+      BlobBlock blk(target_info.bdev_client_.pool_id_,
+                    alloc_task_ptr->blocks_[i].offset_,
+                    alloc_task_ptr->blocks_[i].size_);
+      AppendBlobBlock(entry->blocks_, blk);
     }
 
     entry->size_ = size;
@@ -533,7 +534,36 @@ HSHM_GPU_FUN void GpuRuntime::PutBlob(
     }
   }
 
+  return 0;
+}
+
+//==============================================================================
+// PutBlobBatch
+//==============================================================================
+
+HSHM_GPU_FUN void GpuRuntime::PutBlobBatch(
+    hipc::FullPtr<PutBlobBatchTask> task, chi::gpu::RunContext &rctx) {
+  (void)rctx;
+  if (!chi::gpu::IpcManager::IsWarpScheduler()) return;
+  EnsureMetaInit();
+  chi::u32 count = task->count_ < kMaxPutBlobBatch ? task->count_
+                                                   : kMaxPutBlobBatch;
+  chi::u32 failed = 0;
   task->return_code_ = 0;
+  char name_buf[PutBlobBatchTask::kMaxBlobName];
+  for (chi::u32 i = 0; i < count; ++i) {
+    const PutBlobBatchEntry &entry = task->entries_[i];
+    int len = task->GetBlobName(i, name_buf, sizeof(name_buf));
+    chi::u32 rc = len < 0 ? 4
+                          : StoreBlob(task->tag_id_, name_buf, len,
+                                      entry.size_, task->score_, entry.data_);
+    if (rc != 0) {
+      // Keep going; the return code is the last failure
+      ++failed;
+      task->return_code_ = rc;
+    }
+  }
+  task->failed_ = failed;
 }
 
 //==============================================================================
@@ -594,12 +624,25 @@ HSHM_GPU_FUN void GpuRuntime::GetBlob(
   chimaera::bdev::Block blk(blocks[0].target_offset_, blocks[0].size_, 0);
   read_blocks.push_back(blk);
 
+  // Resolve the block's target (write-once targets, no lock needed)
+  const TargetInfo *block_target = nullptr;
+  for (size_t i = 0; i < meta_->targets_.size(); ++i) {
+    if (meta_->targets_[i].bdev_client_.pool_id_ == blocks[0].target_id_) {
+      block_target = &meta_->targets_[i];
+      break;
+    }
+  }
+  if (block_target == nullptr) {
+    task->return_code_ = 5;  // Block target not registered
+    return;
+  }
+
   // Read the single block via bdev (full-warp parallelism)
-  chi::PoolQuery warp_query = blocks[0].target_query_;
+  chi::PoolQuery warp_query = block_target->target_query_;
   warp_query.SetParallelism(32);
   // Direct NewTask/Send — client Async* methods are host-only
   auto read_task_ptr = CHI_IPC->NewTask<chimaera::bdev::ReadTask>(
-      chi::CreateTaskId(), blocks[0].bdev_client_.pool_id_,
+      chi::CreateTaskId(), blocks[0].target_id_,
       warp_query, read_blocks, task->blob_data_, size);
   auto read_future = CHI_IPC->Send(read_task_ptr);
   read_future.WaitGpu();
@@ -31,15 +31,85 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <wrp_cte/core/blob_meta_table.h>
 #include <wrp_cte/core/core_client.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstring>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace wrp_cte::core {
 
-Tag::Tag(const std::string &tag_name) : tag_name_(tag_name) {
+/** Separates a tag name from a snapshot id in the snapshot's tag name */
+static constexpr const char *kSnapshotSeparator = "@snapshot.";
+
+namespace {
+
+/** Time between attempts to map a blob metadata table that is missing */
+constexpr std::chrono::seconds kBlobMetaAttachRetry{1};
+
+/**
+ * This process's mapping of the local runtime's blob metadata table
+ * @return nullptr while no live table can be mapped
+ */
+BlobMetaTable *AttachedBlobMeta() {
+  auto *table = hshm::Singleton<BlobMetaTable>::GetInstance();
+  if (table->IsLive()) {
+    return table;
+  }
+  static std::atomic<chi::i64> next_attempt_ns{0};
+  chi::i64 now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     std::chrono::steady_clock::now().time_since_epoch())
+                     .count();
+  chi::i64 due = next_attempt_ns.load(std::memory_order_relaxed);
+  if (now < due || !next_attempt_ns.compare_exchange_strong(
+                       due, now + std::chrono::nanoseconds(
+                                      kBlobMetaAttachRetry).count())) {
+    return nullptr;
+  }
+  // A table left behind by a runtime that exited is replaced by the new one
+  table->Detach();
+  if (!table->Attach(BlobMetaTable::SegmentName()) || !table->IsLive()) {
+    return nullptr;
+  }
+  return table;
+}
+
+/**
+ * Read a blob's size and score from the local runtime without a task
+ * @return false on a miss or conflict; the caller asks the runtime
+ */
+bool LookupBlobMeta(const TagId &tag_id, const std::string &blob_name,
+                    BlobMetaTable::Entry &entry) {
   auto *cte_client = WRP_CTE_CLIENT;
-  auto task = cte_client->AsyncGetOrCreateTag(tag_name);
+  // A recorded trace must see every query
+  if (!cte_client->UseBlobMetaReads() || WorkloadRecorder::IsEnabled()) {
+    return false;
+  }
+  BlobMetaTable *table = AttachedBlobMeta();
+  return table != nullptr && table->Lookup(tag_id, blob_name, entry) ==
+                                 BlobMetaTable::LookupResult::kHit;
+}
+
+}  // namespace
+
+Tag::Tag(const std::string &tag_name) : Tag(tag_name, TagPlacement()) {}
+
+Tag::Tag(const std::string &tag_name, const TagPlacement &placement)
+    : tag_name_(tag_name) {
+  // A recorded trace must see every open, so recording skips the cache
+  TagIdCache *tag_cache = Client::GetTagIdCache();
+  bool cacheable = placement.IsDefault() && !WorkloadRecorder::IsEnabled();
+  if (cacheable && tag_cache->Get(tag_name, tag_id_)) {
+    return;
+  }
+
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto task = cte_client->AsyncGetOrCreateTag(
+      tag_name, TagId::GetNull(), chi::PoolQuery::Dynamic(), placement);
   task.Wait();
 
   if (task->GetReturnCode() != 0) {
@@ -47,15 +117,81 @@ Tag::Tag(const std::string &tag_name) : tag_name_(tag_name) {
   }
 
   tag_id_ = task->tag_id_;
+  tag_cache->Put(tag_name, tag_id_);
+  WorkloadRecorder::BindTag(tag_name_, tag_id_);
 }
 
 Tag::Tag(const TagId &tag_id) : tag_id_(tag_id), tag_name_("") {}
 
+std::vector<Tag> Tag::GetOrCreateTags(const std::vector<std::string> &tag_names,
+                                      const TagPlacement &placement) {
+  TagIdCache *tag_cache = Client::GetTagIdCache();
+  bool cacheable = placement.IsDefault() && !WorkloadRecorder::IsEnabled();
+  std::vector<Tag> tags(tag_names.size(), Tag(TagId::GetNull()));
+  std::vector<std::string> missed;
+  std::vector<size_t> missed_idx;
+  for (size_t i = 0; i < tag_names.size(); ++i) {
+    tags[i].tag_name_ = tag_names[i];
+    if (!cacheable || !tag_cache->Get(tag_names[i], tags[i].tag_id_)) {
+      missed.push_back(tag_names[i]);
+      missed_idx.push_back(i);
+    }
+  }
+  if (missed.empty()) {
+    return tags;
+  }
+
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto task = cte_client->AsyncGetOrCreateTags(missed, placement);
+  task.Wait();
+
+  if (task->GetReturnCode() != 0 || task->tag_ids_.size() != missed.size()) {
+    throw std::runtime_error("GetOrCreateTags operation failed");
+  }
+  for (size_t i = 0; i < missed.size(); ++i) {
+    Tag &tag = tags[missed_idx[i]];
+    tag.tag_id_ = task->tag_ids_[i];
+    tag_cache->Put(tag.tag_name_, tag.tag_id_);
+    WorkloadRecorder::BindTag(tag.tag_name_, tag.tag_id_);
+  }
+  return tags;
+}
+
+bool Tag::ResolveShmBuffer(const char *data, size_t data_size,
+                           hipc::ShmPtr<> &shm_ptr) {
+  if (data == nullptr || data_size == 0) {
+    return false;
+  }
+  auto *ipc_manager = CHI_IPC;
+  char *begin = const_cast<char *>(data);
+  hipc::FullPtr<char> first = ipc_manager->ToFullPtr(begin);
+  if (first.shm_.alloc_id_ == hipc::AllocatorId::GetNull()) {
+    return false;
+  }
+  // The whole range must live in the same segment
+  hipc::FullPtr<char> last = ipc_manager->ToFullPtr(begin + data_size - 1);
+  if (last.shm_.alloc_id_ != first.shm_.alloc_id_) {
+    return false;
+  }
+  shm_ptr = hipc::ShmPtr<>(first.shm_);
+  return true;
+}
+
 void Tag::PutBlob(const std::string &blob_name, const char *data, size_t data_size,
                   size_t off, float score, const Context &context) {
-  // Allocate shared memory for the data
   auto *ipc_manager = CHI_IPC;
-  hipc::FullPtr<char> shm_fullptr = ipc_manager->AllocateBuffer(data_size);
+
+  // Data already in a registered segment (AllocateUserShm): no staging copy
+  hipc::ShmPtr<> user_ptr;
+  if (ResolveShmBuffer(data, data_size, user_ptr)) {
+    PutBlob(blob_name, user_ptr, data_size, off, score, context);
+    return;
+  }
+
+  // Allocate shared memory for the data
+  size_t capacity = 0;
+  hipc::FullPtr<char> shm_fullptr =
+      ipc_manager->AllocateStagingBuffer(data_size, capacity);
 
   if (shm_fullptr.IsNull()) {
     throw std::runtime_error("Failed to allocate shared memory for PutBlob");
@@ -70,8 +206,8 @@ void Tag::PutBlob(const std::string &blob_name, const char *data, size_t data_si
   // Call SHM version with provided score and context
   PutBlob(blob_name, shm_ptr, data_size, off, score, context);
 
-  // Explicitly free shared memory buffer
-  ipc_manager->FreeBuffer(shm_fullptr);
+  // Return the staging buffer to this thread's pool
+  ipc_manager->FreeStagingBuffer(shm_fullptr, capacity);
 }
 
 void Tag::PutBlob(const std::string &blob_name, const hipc::ShmPtr<> &data, size_t data_size,
@@ -102,6 +238,168 @@ chi::Future<PutBlobTask> Tag::AsyncPutBlob(const std::string &blob_name, const h
                                   off, data_size, data, score, context);
 }
 
+size_t Tag::PutBlobBatch(const std::vector<BlobExtent> &extents,
+                         const char *data, float score,
+                         const Context &context) {
+  auto *ipc_manager = CHI_IPC;
+  auto *cte_client = WRP_CTE_CLIENT;
+  size_t bytes_done = 0;
+  std::vector<chi::Future<PutBlobTask>> tasks;
+  tasks.reserve(std::min(extents.size(), kMaxBatchInflight));
+
+  for (size_t begin = 0; begin < extents.size(); begin += kMaxBatchInflight) {
+    size_t end = std::min(begin + kMaxBatchInflight, extents.size());
+
+    // One shared memory staging buffer per window of extents
+    size_t window_size = 0;
+    for (size_t i = begin; i < end; ++i) {
+      window_size += extents[i].size_;
+    }
+    hipc::FullPtr<char> shm_fullptr = ipc_manager->AllocateBuffer(window_size);
+    if (shm_fullptr.IsNull()) {
+      throw std::runtime_error("Failed to allocate shared memory for PutBlobBatch");
+    }
+    memcpy(shm_fullptr.ptr_, data + bytes_done, window_size);
+    hipc::ShmPtr<> shm_ptr(shm_fullptr.shm_);
+
+    // Issue the whole window, then await it together
+    tasks.clear();
+    size_t window_off = 0;
+    for (size_t i = begin; i < end; ++i) {
+      const BlobExtent &extent = extents[i];
+      tasks.emplace_back(cte_client->AsyncPutBlob(
+          tag_id_, extent.blob_name_, extent.blob_off_, extent.size_,
+          shm_ptr + window_off, score, context, 0, chi::PoolQuery::Dynamic()));
+      window_off += extent.size_;
+    }
+    bool failed = false;
+    for (size_t i = 0; i < tasks.size(); ++i) {
+      tasks[i].Wait();
+      if (!failed && tasks[i]->GetReturnCode() == 0) {
+        bytes_done += extents[begin + i].size_;
+      } else {
+        failed = true;
+      }
+    }
+    ipc_manager->FreeBuffer(shm_fullptr);
+    if (failed) {
+      break;
+    }
+  }
+  return bytes_done;
+}
+
+size_t Tag::GetBlobBatch(const std::vector<BlobExtent> &extents, char *data) {
+  auto *ipc_manager = CHI_IPC;
+  auto *cte_client = WRP_CTE_CLIENT;
+  size_t bytes_done = 0;
+  std::vector<chi::Future<GetBlobTask>> tasks;
+  tasks.reserve(std::min(extents.size(), kMaxBatchInflight));
+
+  for (size_t begin = 0; begin < extents.size(); begin += kMaxBatchInflight) {
+    size_t end = std::min(begin + kMaxBatchInflight, extents.size());
+
+    size_t window_size = 0;
+    for (size_t i = begin; i < end; ++i) {
+      window_size += extents[i].size_;
+    }
+    hipc::FullPtr<char> shm_fullptr = ipc_manager->AllocateBuffer(window_size);
+    if (shm_fullptr.IsNull()) {
+      throw std::runtime_error("Failed to allocate shared memory for GetBlobBatch");
+    }
+    hipc::ShmPtr<> shm_ptr(shm_fullptr.shm_);
+
+    tasks.clear();
+    size_t window_off = 0;
+    for (size_t i = begin; i < end; ++i) {
+      const BlobExtent &extent = extents[i];
+      tasks.emplace_back(cte_client->AsyncGetBlob(
+          tag_id_, extent.blob_name_, extent.blob_off_, extent.size_, 0,
+          shm_ptr + window_off));
+      window_off += extent.size_;
+    }
+
+    // Copy out the leading run of successful extents
+    bool failed = false;
+    size_t copy_size = 0;
+    for (size_t i = 0; i < tasks.size(); ++i) {
+      tasks[i].Wait();
+      if (!failed && tasks[i]->GetReturnCode() == 0) {
+        copy_size += extents[begin + i].size_;
+      } else {
+        failed = true;
+      }
+    }
+    memcpy(data + bytes_done, shm_fullptr.ptr_, copy_size);
+    bytes_done += copy_size;
+    ipc_manager->FreeBuffer(shm_fullptr);
+    if (failed) {
+      break;
+    }
+  }
+  return bytes_done;
+}
+
+size_t Tag::AppendBlob(const char *data, size_t data_size, size_t chunk_size,
+                       float score, const Context &context) {
+  auto *ipc_manager = CHI_IPC;
+  hipc::FullPtr<char> shm_fullptr = ipc_manager->AllocateBuffer(data_size);
+  if (shm_fullptr.IsNull()) {
+    throw std::runtime_error("Failed to allocate shared memory for AppendBlob");
+  }
+  memcpy(shm_fullptr.ptr_, data, data_size);
+
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto task = cte_client->AsyncAppendBlob(tag_id_, data_size, chunk_size,
+                                          hipc::ShmPtr<>(shm_fullptr.shm_),
+                                          score, context);
+  task.Wait();
+  ipc_manager->FreeBuffer(shm_fullptr);
+
+  if (task->GetReturnCode() != 0) {
+    throw std::runtime_error("AppendBlob operation failed");
+  }
+  return task->offset_;
+}
+
+void Tag::ReserveBlob(const std::string &blob_name, size_t size, float score) {
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto task = cte_client->AsyncReserveBlob(tag_id_, blob_name, size, score);
+  task.Wait();
+
+  if (task->GetReturnCode() != 0) {
+    throw std::runtime_error("ReserveBlob operation failed");
+  }
+}
+
+void Tag::ReserveBlobBatch(const std::vector<BlobExtent> &extents,
+                           float score) {
+  auto *cte_client = WRP_CTE_CLIENT;
+  std::vector<chi::Future<ReserveBlobTask>> tasks;
+  tasks.reserve(std::min(extents.size(), kMaxBatchInflight));
+
+  bool failed = false;
+  for (size_t begin = 0; begin < extents.size() && !failed;
+       begin += kMaxBatchInflight) {
+    size_t end = std::min(begin + kMaxBatchInflight, extents.size());
+    tasks.clear();
+    for (size_t i = begin; i < end; ++i) {
+      const BlobExtent &extent = extents[i];
+      tasks.emplace_back(cte_client->AsyncReserveBlob(
+          tag_id_, extent.blob_name_, extent.blob_off_ + extent.size_, score));
+    }
+    for (auto &task : tasks) {
+      task.Wait();
+      if (task->GetReturnCode() != 0) {
+        failed = true;
+      }
+    }
+  }
+  if (failed) {
+    throw std::runtime_error("ReserveBlobBatch operation failed");
+  }
+}
+
 void Tag::GetBlob(const std::string &blob_name, char *data, size_t data_size, size_t off) {
   // Validate input parameters
   if (data_size == 0) {
@@ -112,9 +410,33 @@ void Tag::GetBlob(const std::string &blob_name, char *data, size_t data_size, si
     throw std::invalid_argument("data buffer must be pre-allocated by caller");
   }
 
-  // Allocate shared memory for the data
   auto *ipc_manager = CHI_IPC;
-  hipc::FullPtr<char> shm_fullptr = ipc_manager->AllocateBuffer(data_size);
+
+  // Range on mappable RAM targets: copy once, straight from the target
+  auto *cte_client = WRP_CTE_CLIENT;
+  if (cte_client->UseBlobViews()) {
+    try {
+      BlobView view = GetBlobView(blob_name, data_size, off);
+      if (view.IsValid()) {
+        view.CopyTo(data);
+        return;
+      }
+    } catch (const std::runtime_error &) {
+      // Missing blobs are reported by the regular read below
+    }
+  }
+
+  // Output already in a registered segment (AllocateUserShm): no staging copy
+  hipc::ShmPtr<> user_ptr;
+  if (ResolveShmBuffer(data, data_size, user_ptr)) {
+    GetBlob(blob_name, user_ptr, data_size, off);
+    return;
+  }
+
+  // Allocate shared memory for the data
+  size_t capacity = 0;
+  hipc::FullPtr<char> shm_fullptr =
+      ipc_manager->AllocateStagingBuffer(data_size, capacity);
 
   if (shm_fullptr.IsNull()) {
     throw std::runtime_error("Failed to allocate shared memory for GetBlob");
@@ -129,8 +451,8 @@ void Tag::GetBlob(const std::string &blob_name, char *data, size_t data_size, si
   // Copy data from shared memory to output buffer
   memcpy(data, shm_fullptr.ptr_, data_size);
 
-  // Explicitly free shared memory buffer
-  ipc_manager->FreeBuffer(shm_fullptr);
+  // Return the staging buffer to this thread's pool
+  ipc_manager->FreeStagingBuffer(shm_fullptr, capacity);
 }
 
 void Tag::GetBlob(const std::string &blob_name, hipc::ShmPtr<> data, size_t data_size, size_t off) {
@@ -155,7 +477,45 @@ void Tag::GetBlob(const std::string &blob_name, hipc::ShmPtr<> data, size_t data
 
 }
 
+BlobView Tag::GetBlobView(const std::string &blob_name, size_t data_size,
+                          size_t off) {
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto task = cte_client->AsyncGetBlobView(tag_id_, blob_name, off, data_size);
+  task.Wait();
+
+  chi::u32 rc = task->GetReturnCode();
+  if (rc == 1) {
+    throw std::runtime_error("GetBlobView operation failed");
+  }
+  if (rc != 0) {
+    return BlobView();
+  }
+  std::vector<BlobViewPiece> pieces;
+  pieces.reserve(task->extents_.size());
+  bool mapped = true;
+  for (const auto &extent : task->extents_) {
+    const char *base =
+        BlobView::MapTarget(extent.target_id_, extent.segment_size_);
+    if (base == nullptr) {
+      mapped = false;
+      break;
+    }
+    pieces.push_back({base + extent.target_offset_, extent.size_});
+  }
+  BlobView view(tag_id_, blob_name, task->lease_id_, task->lease_ms_,
+                std::move(pieces));
+  if (!mapped) {
+    // Segment not reachable from this process: let GetBlob read it
+    view.Release();
+  }
+  return view;
+}
+
 float Tag::GetBlobScore(const std::string &blob_name) {
+  BlobMetaTable::Entry entry;
+  if (LookupBlobMeta(tag_id_, blob_name, entry)) {
+    return entry.score_;
+  }
   auto *cte_client = WRP_CTE_CLIENT;
   auto task = cte_client->AsyncGetBlobScore(tag_id_, blob_name);
   task.Wait();
@@ -165,6 +525,10 @@ float Tag::GetBlobScore(const std::string &blob_name) {
 }
 
 chi::u64 Tag::GetBlobSize(const std::string &blob_name) {
+  BlobMetaTable::Entry entry;
+  if (LookupBlobMeta(tag_id_, blob_name, entry)) {
+    return entry.size_;
+  }
   auto *cte_client = WRP_CTE_CLIENT;
   auto task = cte_client->AsyncGetBlobSize(tag_id_, blob_name);
   task.Wait();
@@ -192,4 +556,137 @@ void Tag::ReorganizeBlob(const std::string &blob_name, float new_score) {
   }
 }
 
+void Tag::SetReplication(chi::u32 replicas) {
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto task = cte_client->AsyncSetTagReplication(tag_id_, replicas);
+  task.Wait();
+
+  if (task->GetReturnCode() != 0) {
+    throw std::runtime_error("SetReplication operation failed");
+  }
+}
+
+void Tag::SetDedup(chi::u64 chunk_size) {
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto task = cte_client->AsyncSetTagDedup(tag_id_, chunk_size);
+  task.Wait();
+
+  if (task->GetReturnCode() != 0) {
+    throw std::runtime_error("SetDedup operation failed");
+  }
+}
+
+void Tag::SetErasureCoding(chi::u32 data_shards, chi::u32 parity_shards) {
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto task =
+      cte_client->AsyncSetTagErasure(tag_id_, data_shards, parity_shards);
+  task.Wait();
+
+  if (task->GetReturnCode() != 0) {
+    throw std::runtime_error("SetErasureCoding operation failed");
+  }
+}
+
+void Tag::SetEncryption(chi::u32 chunk_size) {
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto task = cte_client->AsyncSetTagEncryption(tag_id_, chunk_size);
+  task.Wait();
+
+  if (task->GetReturnCode() != 0) {
+    throw std::runtime_error("SetEncryption operation failed");
+  }
+}
+
+void Tag::SetTtl(chi::u64 ttl_ms) {
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto task = cte_client->AsyncSetTagTtl(tag_id_, ttl_ms);
+  task.Wait();
+
+  if (task->GetReturnCode() != 0) {
+    throw std::runtime_error("SetTtl operation failed");
+  }
+}
+
+std::string Tag::SnapshotName(const std::string &tag_name,
+                              chi::u64 snapshot_id) {
+  return tag_name + kSnapshotSeparator + std::to_string(snapshot_id);
+}
+
+chi::u64 Tag::Snapshot(chi::u64 retain_ms) {
+  if (tag_name_.empty()) {
+    throw std::runtime_error("Snapshot needs a tag opened by name");
+  }
+  std::vector<chi::u64> ids = ListSnapshots();
+  chi::u64 snapshot_id = ids.empty() ? 1 : ids.back() + 1;
+  // Following this tag's placement keeps every link on the container that
+  // already holds the extents
+  Tag snapshot(SnapshotName(tag_name_, snapshot_id),
+               TagPlacement::Follow(tag_id_));
+  if (retain_ms > 0) {
+    // Links take the snapshot tag's TTL, so ExpireBlobs collects them
+    snapshot.SetTtl(retain_ms);
+  }
+
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto task =
+      cte_client->AsyncSpliceBlobs(tag_id_, ".*", snapshot.GetTagId());
+  task.Wait();
+
+  if (task->GetReturnCode() != 0) {
+    throw std::runtime_error("Snapshot operation failed");
+  }
+  return snapshot_id;
+}
+
+std::vector<chi::u64> Tag::ListSnapshots() {
+  std::vector<chi::u64> ids;
+  if (tag_name_.empty()) {
+    return ids;
+  }
+  // Escape the tag name so that the pattern stays a literal prefix
+  std::string pattern;
+  for (char c : tag_name_ + kSnapshotSeparator) {
+    if (std::strchr(".[]{}()*+?^$|\\/-", c) != nullptr) {
+      pattern += '\\';
+    }
+    pattern += c;
+  }
+  pattern += ".*";
+
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto task = cte_client->AsyncTagQuery(pattern);
+  task.Wait();
+
+  size_t prefix_len = tag_name_.size() + std::strlen(kSnapshotSeparator);
+  for (const std::string &name : task->results_) {
+    std::string suffix = name.substr(prefix_len);
+    if (suffix.empty() ||
+        suffix.find_first_not_of("0123456789") != std::string::npos) {
+      continue;
+    }
+    ids.push_back(std::stoull(suffix));
+  }
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  return ids;
+}
+
+Tag Tag::OpenSnapshot(chi::u64 snapshot_id) {
+  std::vector<chi::u64> ids = ListSnapshots();
+  if (!std::binary_search(ids.begin(), ids.end(), snapshot_id)) {
+    throw std::runtime_error("OpenSnapshot: no such snapshot");
+  }
+  return Tag(SnapshotName(tag_name_, snapshot_id));
+}
+
+void Tag::DeleteSnapshot(chi::u64 snapshot_id) {
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto task = cte_client->AsyncDelTag(SnapshotName(tag_name_, snapshot_id));
+  task.Wait();
+
+  if (task->GetReturnCode() != 0) {
+    throw std::runtime_error("DeleteSnapshot operation failed");
+  }
+}
+
 } // namespace wrp_cte::core
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <chimaera/worker.h>
+#include <wrp_cte/core/workload_trace.h>
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace wrp_cte::core {
+
+std::atomic<bool> WorkloadRecorder::s_enabled_{false};
+
+namespace {
+
+/** Buffered bytes written to the file at once */
+constexpr size_t kFlushBytes = 1 << 20;
+
+/** Process-wide recorder state, guarded by mutex_ */
+struct RecorderState {
+  std::mutex mutex_;
+  FILE *file_ = nullptr;
+  std::vector<char> buf_;
+  std::chrono::steady_clock::time_point start_;
+  bool atexit_registered_ = false;
+};
+
+RecorderState &State() {
+  static RecorderState *state = new RecorderState();
+  return *state;
+}
+
+/** Stable small index of the calling thread */
+chi::u32 ThreadIndex() {
+  static std::atomic<chi::u32> next{0};
+  thread_local chi::u32 index = next.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+/** Write out the buffer; caller holds mutex_ */
+void FlushLocked(RecorderState &state) {
+  if (state.file_ != nullptr && !state.buf_.empty()) {
+    fwrite(state.buf_.data(), 1, state.buf_.size(), state.file_);
+  }
+  state.buf_.clear();
+}
+
+}  // namespace
+
+const char *WorkloadOpName(WorkloadOp op) {
+  switch (op) {
+    case WorkloadOp::kGetOrCreateTag: return "GetOrCreateTag";
+    case WorkloadOp::kTagBind: return "TagBind";
+    case WorkloadOp::kPutBlob: return "PutBlob";
+    case WorkloadOp::kAppendBlob: return "AppendBlob";
+    case WorkloadOp::kGetBlob: return "GetBlob";
+    case WorkloadOp::kReorganizeBlob: return "ReorganizeBlob";
+    case WorkloadOp::kDelBlob: return "DelBlob";
+    case WorkloadOp::kDelTag: return "DelTag";
+    case WorkloadOp::kGetTagSize: return "GetTagSize";
+    case WorkloadOp::kGetBlobScore: return "GetBlobScore";
+    case WorkloadOp::kGetBlobSize: return "GetBlobSize";
+    case WorkloadOp::kGetBlobInfo: return "GetBlobInfo";
+    case WorkloadOp::kGetContainedBlobs: return "GetContainedBlobs";
+    default: return "Unknown";
+  }
+}
+
+bool WorkloadRecorder::InitFromEnv() {
+  const char *prefix = std::getenv(kEnvVar);
+  if (prefix == nullptr || prefix[0] == '\0') {
+    return IsEnabled();
+  }
+  char host[64] = {};
+  gethostname(host, sizeof(host) - 1);
+  std::string path = std::string(prefix) + "." + host + "." +
+                     std::to_string(getpid()) + ".wlt";
+  if (!Start(path)) {
+    HLOG(kError, "WorkloadRecorder: cannot open {}", path);
+    return false;
+  }
+  HLOG(kInfo, "WorkloadRecorder: recording CTE operations to {}", path);
+  return true;
+}
+
+bool WorkloadRecorder::Start(const std::string &path) {
+  RecorderState &state = State();
+  std::lock_guard<std::mutex> lock(state.mutex_);
+  if (state.file_ != nullptr) {
+    FlushLocked(state);
+    fclose(state.file_);
+    state.file_ = nullptr;
+  }
+  FILE *file = fopen(path.c_str(), "wb");
+  if (file == nullptr) {
+    s_enabled_.store(false, std::memory_order_relaxed);
+    return false;
+  }
+
+  WorkloadTraceHeader header{};
+  std::memcpy(header.magic_, WorkloadTraceHeader::kMagic,
+              sizeof(header.magic_));
+  header.version_ = WorkloadTraceHeader::kVersion;
+  header.pid_ = static_cast<uint32_t>(getpid());
+  header.start_wall_ns_ = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count());
+  gethostname(header.host_, sizeof(header.host_) - 1);
+  fwrite(&header, sizeof(header), 1, file);
+
+  state.file_ = file;
+  state.buf_.reserve(kFlushBytes + 4096);
+  state.start_ = std::chrono::steady_clock::now();
+  if (!state.atexit_registered_) {
+    state.atexit_registered_ = true;
+    std::atexit([] { WorkloadRecorder::Stop(); });
+  }
+  s_enabled_.store(true, std::memory_order_release);
+  return true;
+}
+
+void WorkloadRecorder::Stop() {
+  RecorderState &state = State();
+  std::lock_guard<std::mutex> lock(state.mutex_);
+  s_enabled_.store(false, std::memory_order_relaxed);
+  if (state.file_ == nullptr) {
+    return;
+  }
+  FlushLocked(state);
+  fclose(state.file_);
+  state.file_ = nullptr;
+}
+
+void WorkloadRecorder::Record(WorkloadOp op, const TagId &tag_id,
+                              const char *name, chi::u64 offset,
+                              chi::u64 size, float score, chi::u32 flags) {
+  // Subtasks a container issues from a worker are runtime work, not workload
+  auto *chimaera_manager = CHI_CHIMAERA_MANAGER;
+  if (chimaera_manager && chimaera_manager->IsRuntime() &&
+      CHI_CUR_WORKER != nullptr) {
+    return;
+  }
+  size_t name_len = name != nullptr ? std::strlen(name) : 0;
+  if (name_len > UINT16_MAX) {
+    name_len = UINT16_MAX;
+  }
+  WorkloadRecord rec{};
+  rec.offset_ = offset;
+  rec.size_ = size;
+  rec.tag_major_ = tag_id.major_;
+  rec.tag_minor_ = tag_id.minor_;
+  rec.thread_ = ThreadIndex();
+  rec.score_ = score;
+  rec.name_len_ = static_cast<uint16_t>(name_len);
+  rec.op_ = static_cast<uint8_t>(op);
+  rec.flags_ = static_cast<uint8_t>(flags);
+
+  RecorderState &state = State();
+  std::lock_guard<std::mutex> lock(state.mutex_);
+  if (state.file_ == nullptr) {
+    return;
+  }
+  // Stamped under the lock so records are in timestamp order in the file
+  rec.ts_ns_ = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - state.start_)
+          .count());
+  const char *rec_bytes = reinterpret_cast<const char *>(&rec);
+  state.buf_.insert(state.buf_.end(), rec_bytes, rec_bytes + sizeof(rec));
+  state.buf_.insert(state.buf_.end(), name, name + name_len);
+  if (state.buf_.size() >= kFlushBytes) {
+    FlushLocked(state);
+  }
+}
+
+bool WorkloadTraceReader::Open(const std::string &path) {
+  Close();
+  file_ = fopen(path.c_str(), "rb");
+  if (file_ == nullptr) {
+    return false;
+  }
+  if (fread(&header_, sizeof(header_), 1, file_) != 1 ||
+      std::memcmp(header_.magic_, WorkloadTraceHeader::kMagic,
+                  sizeof(header_.magic_)) != 0 ||
+      header_.version_ != WorkloadTraceHeader::kVersion) {
+    Close();
+    return false;
+  }
+  header_.host_[sizeof(header_.host_) - 1] = '\0';
+  return true;
+}
+
+void WorkloadTraceReader::Close() {
+  if (file_ != nullptr) {
+    fclose(file_);
+    file_ = nullptr;
+  }
+}
+
+bool WorkloadTraceReader::Next(WorkloadEvent &event) {
+  if (file_ == nullptr ||
+      fread(&event.rec_, sizeof(event.rec_), 1, file_) != 1) {
+    return false;
+  }
+  event.name_.resize(event.rec_.name_len_);
+  if (event.rec_.name_len_ > 0 &&
+      fread(&event.name_[0], 1, event.rec_.name_len_, file_) !=
+          event.rec_.name_len_) {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace wrp_cte::core
@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -29,20 +30,31 @@ namespace kvcache {
  *     Before a prefill, call LookupPrefix().  If a cached block exists
  *     for a matching token prefix, the data is restored into the KV
  *     cache buffer and the matched length is returned so llama.cpp can
- *     skip computing those tokens.
+ *     skip computing those tokens.  Stored sequences are indexed in a
+ *     block-granular radix tree keyed by chained 128-bit block hashes
+ *     (see PrefixIndex), so a lookup hashes each query token once.
  *
  * Usage (from llama.cpp integration):
  *
  *   KVCacheManager mgr;
  *   mgr.Init();   // once at startup
  *
+ *   // When the scheduler queues a request (well before its prefill):
+ *   mgr.PrefetchPrefix(tokens, kv_size);
+ *
  *   // Before prefill:
  *   size_t matched = 0;
  *   if (mgr.LookupPrefix(tokens, kv_ptr, kv_size, true, matched))
  *       batch_start = matched;  // skip already-cached tokens
  *
  *   // After seq_rm eviction:
- *   mgr.OnEvict(evicted_tokens, kv_ptr, kv_size, true);
+ *   mgr.OnEvict(evicted_tokens, kv_ptr, kv_size, true, stream);
+ *
+ * Device-resident blocks are bounced through a ring of pinned shared-memory
+ * staging slots.  Copies run on a dedicated CUDA stream that is ordered
+ * against the caller's stream with events, and a background thread hands
+ * finished D2H copies to CTE, so an eviction never blocks the inference
+ * stream.  Call Flush() when stored blocks must be visible to lookups.
  */
 class KVCacheManager {
  public:
@@ -61,11 +73,43 @@ class KVCacheManager {
 
     /**
      * Maximum in-process hash index entries.
-     * Once full, the oldest entries are dropped from the index
-     * (the data remains in CTE, but prefix lookup won't find them
+     * Once full, the least recently used entries are dropped from the
+     * index (the data remains in CTE, but prefix lookup won't find them
      * until a full CTE scan is implemented).
      */
     size_t max_index_entries = 65536;
+
+    /** Tokens per prefix-tree level (1-64); sequences may end mid-block. */
+    size_t block_tokens = 16;
+
+    /** Independently locked shards of the prefix index. */
+    size_t index_shards = 16;
+
+    /**
+     * Pinned staging slots for on_gpu copies.  Each slot holds one block in
+     * flight; StoreBlock only waits when every slot is busy.
+     */
+    size_t staging_slots = 4;
+
+    /**
+     * Maximum PrefetchPrefix promotions in flight; a further hint waits
+     * for the oldest one to finish.
+     */
+    size_t max_inflight_prefetches = 64;
+  };
+
+  /** Prefetch counters; a snapshot is returned by GetStats(). */
+  struct Stats {
+    /** PrefetchPrefix calls. */
+    uint64_t prefetch_requests = 0;
+    /** Hints for which no stored prefix (small enough) was indexed. */
+    uint64_t prefetch_misses = 0;
+    /** Promotions queued to CTE (ReorganizeBlob to evicted_score). */
+    uint64_t prefetch_issued = 0;
+    /** Queued promotions that CTE rejected. */
+    uint64_t prefetch_failures = 0;
+    /** LookupPrefix calls served from a block promoted by a prefetch. */
+    uint64_t prefetch_hits = 0;
   };
 
   KVCacheManager();
@@ -98,12 +142,17 @@ class KVCacheManager {
    * @param tokens   Token sequence this block covers (used as cache key).
    * @param kv_data  Pointer to the raw KV data bytes.
    * @param size     Size in bytes of kv_data.
-   * @param on_gpu   If true, kv_data is a device pointer; a D2H copy is
-   *                 performed internally before handing to CTE.
-   * @return true on success.
+   * @param on_gpu   If true, kv_data is a device pointer.  The D2H copy is
+   *                 queued behind pending work on stream and the block is
+   *                 handed to CTE asynchronously; kernels queued on stream
+   *                 afterwards wait for the copy before touching kv_data.
+   * @param stream   cudaStream_t the block was produced on (nullptr = the
+   *                 default stream).  Ignored when on_gpu is false.
+   * @return true if the block was stored (or queued for storing).
    */
   bool StoreBlock(const std::vector<int32_t>& tokens,
-                  const void* kv_data, size_t size, bool on_gpu = true);
+                  const void* kv_data, size_t size, bool on_gpu = true,
+                  void* stream = nullptr);
 
   /**
    * Look up the longest cached prefix matching the supplied token sequence.
@@ -111,15 +160,32 @@ class KVCacheManager {
    * @param tokens      Full input token sequence.
    * @param dst         Destination buffer to write restored KV data into.
    * @param dst_size    Capacity of dst in bytes.
-   * @param on_gpu      If true, dst is a device pointer; an H2D copy is
-   *                    performed internally after reading from CTE.
+   * @param on_gpu      If true, dst is a device pointer; the H2D copy is
+   *                    enqueued on stream, so work queued there afterwards
+   *                    sees the restored data.
    * @param matched_len OUT: number of tokens whose KV data was restored.
    *                    0 if no prefix was found.
+   * @param stream      cudaStream_t to restore on (nullptr = the default
+   *                    stream).  Ignored when on_gpu is false.
    * @return true if any prefix was matched and data restored.
    */
   bool LookupPrefix(const std::vector<int32_t>& tokens,
                     void* dst, size_t dst_size, bool on_gpu,
-                    size_t& matched_len);
+                    size_t& matched_len, void* stream = nullptr);
+
+  /**
+   * Hint that a prefill for tokens is coming.  The longest stored prefix
+   * that fits max_bytes (the block LookupPrefix would pick for a buffer of
+   * that size) is asynchronously promoted back to evicted_score, so a
+   * block demoted to cold_score is in DRAM by the time it is looked up.
+   * Never blocks on the promotion itself.
+   *
+   * @param tokens    Token sequence of the queued request.
+   * @param max_bytes Capacity of the KV buffer the prefill will restore into.
+   * @return true if a stored prefix was found and a promotion queued.
+   */
+  bool PrefetchPrefix(const std::vector<int32_t>& tokens,
+                      size_t max_bytes = std::numeric_limits<size_t>::max());
 
   /**
    * Notify that a KV block has been evicted by llama.cpp.
@@ -127,7 +193,15 @@ class KVCacheManager {
    * Pass kv_data=nullptr to just remove the entry from the index.
    */
   void OnEvict(const std::vector<int32_t>& tokens,
-               const void* kv_data, size_t size, bool on_gpu = true);
+               const void* kv_data, size_t size, bool on_gpu = true,
+               void* stream = nullptr);
+
+  /**
+   * Wait until every queued on_gpu store has reached CTE and every staging
+   * slot is idle.
+   * @return true if all asynchronous stores since the last Flush succeeded.
+   */
+  bool Flush();
 
   // ---------------------------------------------------------------------------
   // Raw-key API
@@ -152,13 +226,17 @@ class KVCacheManager {
 
   /**
    * Compute a stable 64-bit FNV-1a hash of a token sequence and
-   * return it as a fixed-width hex string (blob name in CTE).
+   * return it as a fixed-width hex string.  Blob names of StoreBlock
+   * come from PrefixKey::ToHex() instead.
    */
   static std::string HashTokens(const std::vector<int32_t>& tokens);
 
   /** Return true if Init() completed successfully. */
   bool IsReady() const;
 
+  /** Snapshot of the prefetch counters. */
+  Stats GetStats() const;
+
  private:
   struct Impl;
   Config cfg_;
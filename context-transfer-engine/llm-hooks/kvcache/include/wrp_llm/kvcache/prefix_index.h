@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace wrp_llm {
+namespace kvcache {
+
+/**
+ * 128-bit chained hash of a token prefix.
+ *
+ * The key of a prefix is HashBlock(key of the prefix one block shorter,
+ * tokens of the last block), as in vLLM/SGLang prefix caching, so extending
+ * a prefix hashes only the new tokens.  The all-zero key is the empty prefix.
+ */
+struct PrefixKey {
+  uint64_t hi = 0;
+  uint64_t lo = 0;
+
+  bool operator==(const PrefixKey& other) const {
+    return hi == other.hi && lo == other.lo;
+  }
+  bool operator!=(const PrefixKey& other) const { return !(*this == other); }
+
+  /** True for the key of the empty prefix. */
+  bool IsRoot() const { return hi == 0 && lo == 0; }
+
+  /** Fixed-width 32-char hex form (CTE blob name). */
+  std::string ToHex() const;
+};
+
+struct PrefixKeyHash {
+  size_t operator()(const PrefixKey& key) const {
+    return static_cast<size_t>(key.lo ^ (key.hi * 0x9e3779b97f4a7c15ULL));
+  }
+};
+
+/**
+ * Block-granular radix tree over stored token sequences.
+ *
+ * Each node is a prefix ending on a block boundary, or a partial tail block
+ * hanging off one.  A node whose prefix was stored with StoreBlock carries
+ * the size of its KV blob.  FindPrefixes walks the query one block at a
+ * time, so it hashes each query token at most once per candidate tail
+ * length, and reports every stored sequence that is a prefix of the query.
+ *
+ * Nodes live in shards keyed by their PrefixKey, each behind a
+ * std::shared_mutex, so concurrent lookups only take reader locks.  Once
+ * the index holds more than max_entries nodes, the least recently used
+ * leaves are dropped (their CTE blobs are kept).
+ */
+class PrefixIndex {
+ public:
+  /** One stored sequence that prefixes a query. */
+  struct Match {
+    PrefixKey key;       // Blob key of the stored sequence
+    size_t token_count;  // Tokens it covers
+    size_t blob_size;    // Stored KV bytes
+  };
+
+  /**
+   * @param block_tokens Tokens per tree level (clamped to [1, 64])
+   * @param max_entries  Node budget before leaves are dropped
+   * @param num_shards   Independently locked shards (at least 1)
+   */
+  explicit PrefixIndex(size_t block_tokens = 16, size_t max_entries = 65536,
+                       size_t num_shards = 16);
+
+  /**
+   * Chain one block onto a prefix key.
+   * @param parent Key of the preceding prefix (root for the first block)
+   * @param tokens First token of the block
+   * @param count  Tokens in the block
+   */
+  static PrefixKey HashBlock(const PrefixKey& parent, const int32_t* tokens,
+                             size_t count);
+
+  /** Chained key of a whole token sequence at this index's block size. */
+  PrefixKey KeyOf(const std::vector<int32_t>& tokens) const;
+
+  /**
+   * Record that tokens' KV data is stored, creating its path in the tree.
+   * @return Key of the stored sequence
+   */
+  PrefixKey Insert(const std::vector<int32_t>& tokens, size_t blob_size);
+
+  /**
+   * Find every stored sequence that is a prefix of tokens.
+   * @param matches Output, longest first
+   */
+  void FindPrefixes(const std::vector<int32_t>& tokens,
+                    std::vector<Match>& matches) const;
+
+  /**
+   * Forget that tokens' KV data is stored.
+   * @return true if the sequence was indexed
+   */
+  bool Erase(const std::vector<int32_t>& tokens);
+
+  /** Number of nodes, excluding the root. */
+  size_t Size() const { return size_.load(std::memory_order_relaxed); }
+
+  size_t BlockTokens() const { return block_tokens_; }
+
+ private:
+  struct Node {
+    PrefixKey parent;                  // Key one tree level up
+    uint32_t tail_len = 0;             // Tokens if a partial tail, else 0
+    uint32_t children = 0;             // Child nodes (0 = leaf)
+    uint64_t tail_mask = 0;            // Bit n: a tail child of n tokens
+    size_t blob_size = 0;              // 0 = nothing stored at this prefix
+    std::atomic<uint64_t> last_use{0};  // Logical time of the last hit
+  };
+  struct Shard {
+    mutable std::shared_mutex mu;
+    std::unordered_map<PrefixKey, Node, PrefixKeyHash> nodes;
+  };
+
+  Shard& ShardOf(const PrefixKey& key) const {
+    return *shards_[key.lo % shards_.size()];
+  }
+
+  /** Create a node if absent and link it to its parent. */
+  void AddNode(const PrefixKey& key, const PrefixKey& parent,
+               uint32_t tail_len);
+
+  /** Remove key and any parents it leaves as empty leaves. */
+  void Prune(PrefixKey key, bool drop_blob, uint64_t expect_use);
+
+  /** Drop least recently used leaves until within budget. */
+  void Trim();
+
+  size_t block_tokens_;
+  size_t max_entries_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<size_t> size_{0};
+  mutable std::atomic<uint64_t> clock_{1};  // 0 = "any" in Prune
+  std::atomic<bool> trimming_{false};
+};
+
+}  // namespace kvcache
+}  // namespace wrp_llm
@@ -1,13 +1,21 @@
 #include "wrp_llm/kvcache/kvcache_manager.h"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <mutex>
+#include <shared_mutex>
 #include <stdexcept>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
+#include "wrp_llm/kvcache/prefix_index.h"
+
 // IOWarp CTE client API — Tag class wraps GetOrCreateTag + PutBlob + GetBlob.
 #include "wrp_cte/core/core_client.h"
 
@@ -15,25 +23,259 @@
 // Guarded so that the translation unit still compiles on CPU-only builds.
 #ifdef IOWARP_LLM_ENABLE_CUDA
 #include <cuda_runtime.h>
-#define CUDA_CHECK(expr)                                                 \
-  do {                                                                   \
-    cudaError_t _e = (expr);                                            \
-    if (_e != cudaSuccess)                                              \
-      fprintf(stderr, "CUDA error %s at %s:%d\n",                      \
-              cudaGetErrorString(_e), __FILE__, __LINE__);              \
-  } while (0)
+#define CUDA_CHECK(expr) ::wrp_llm::kvcache::CudaOk((expr), __FILE__, __LINE__)
 #endif
 
 namespace wrp_llm {
 namespace kvcache {
 
+#ifdef IOWARP_LLM_ENABLE_CUDA
+/** Report a failed CUDA call; returns true when err is cudaSuccess. */
+static bool CudaOk(cudaError_t err, const char* file, int line) {
+  if (err == cudaSuccess) return true;
+  fprintf(stderr, "CUDA error %s at %s:%d\n", cudaGetErrorString(err), file,
+          line);
+  return false;
+}
+
 // ---------------------------------------------------------------------------
-// Index entry
+// Pinned staging ring
+//
+// Each slot owns a shared-memory buffer from the IPC manager's pinned pool,
+// so a D2H copy lands directly in page-locked memory CTE can read
+// (PutBlob with a ShmPtr, no extra host memcpy) and runs truly async.
+// Copies are issued on a private non-blocking stream; events order them
+// against the caller's stream in both directions.  A drain thread waits
+// on each slot's completion event, hands pending stores to CTE, and
+// returns the slot to the ring.
+// ---------------------------------------------------------------------------
+struct StagingSlot {
+  hipc::FullPtr<char> buf;
+  size_t capacity = 0;
+  cudaEvent_t ready = nullptr;  // recorded on the caller's stream
+  cudaEvent_t done = nullptr;   // recorded after the slot's copy
+  // Pending store; key is empty for restore slots that only need releasing.
+  std::string key;
+  std::vector<int32_t> tokens;
+  size_t size = 0;
+};
+
+class StagingRing {
+ public:
+  /**
+   * Create the copy stream, slot events and the drain thread.
+   * @param num_slots Number of slots (at least 1).
+   * @param tag       CTE tag that drained stores are written to.
+   * @param index     Prefix index updated once a store reaches CTE.
+   * @param score     Blob score for drained stores.
+   * @return true on success; on failure the ring is left stopped.
+   */
+  bool Start(size_t num_slots, wrp_cte::core::Tag* tag, PrefixIndex* index,
+             float score) {
+    tag_ = tag;
+    index_ = index;
+    score_ = score;
+    if (!CUDA_CHECK(cudaStreamCreateWithFlags(&copy_stream_,
+                                              cudaStreamNonBlocking))) {
+      copy_stream_ = nullptr;
+      return false;
+    }
+    slots_.resize(std::max<size_t>(1, num_slots));
+    busy_.assign(slots_.size(), false);
+    for (auto& slot : slots_) {
+      if (!CUDA_CHECK(cudaEventCreateWithFlags(&slot.ready,
+                                               cudaEventDisableTiming)) ||
+          !CUDA_CHECK(cudaEventCreateWithFlags(&slot.done,
+                                               cudaEventDisableTiming))) {
+        Stop();
+        return false;
+      }
+    }
+    drain_ = std::thread([this] { DrainLoop(); });
+    return true;
+  }
+
+  /** Drain outstanding work, join the drain thread and free all slots. */
+  void Stop() {
+    if (drain_.joinable()) {
+      Flush();
+      {
+        std::lock_guard<std::mutex> lk(mu_);
+        stop_ = true;
+      }
+      work_cv_.notify_all();
+      drain_.join();
+    }
+    for (auto& slot : slots_) {
+      FreeSlotBuffer(slot);
+      if (slot.ready) cudaEventDestroy(slot.ready);
+      if (slot.done) cudaEventDestroy(slot.done);
+    }
+    slots_.clear();
+    busy_.clear();
+    if (copy_stream_) cudaStreamDestroy(copy_stream_);
+    copy_stream_ = nullptr;
+  }
+
+  /**
+   * Claim a free slot holding at least size bytes, waiting while every
+   * slot is in flight.
+   * @return Slot index, or -1 if the buffer could not be allocated.
+   */
+  int Acquire(size_t size) {
+    int idx = -1;
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      free_cv_.wait(lk, [this] { return in_use_ < slots_.size(); });
+      for (size_t n = 0; n < slots_.size(); ++n) {
+        size_t i = (next_ + n) % slots_.size();
+        if (!busy_[i]) {
+          idx = static_cast<int>(i);
+          break;
+        }
+      }
+      busy_[idx] = true;
+      ++in_use_;
+      next_ = (idx + 1) % slots_.size();
+    }
+    if (!EnsureCapacity(slots_[idx], size)) {
+      Release(idx);
+      return -1;
+    }
+    return idx;
+  }
+
+  StagingSlot& Slot(int idx) { return slots_[idx]; }
+  cudaStream_t CopyStream() const { return copy_stream_; }
+
+  /** Hand a slot whose completion event is recorded to the drain thread. */
+  void Submit(int idx) {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      pending_.push_back(idx);
+    }
+    work_cv_.notify_one();
+  }
+
+  /** Return a slot with no copy in flight to the ring. */
+  void Release(int idx) {
+    StagingSlot& slot = slots_[idx];
+    slot.key.clear();
+    slot.tokens.clear();
+    slot.size = 0;
+    bool idle;
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      busy_[idx] = false;
+      --in_use_;
+      idle = in_use_ == 0 && pending_.empty();
+    }
+    free_cv_.notify_one();
+    if (idle) idle_cv_.notify_all();
+  }
+
+  /**
+   * Return a slot to the ring after waiting for any copy still queued on
+   * stream; used when a submission fails part-way through.
+   */
+  void Abandon(int idx, cudaStream_t stream) {
+    cudaStreamSynchronize(stream);
+    cudaGetLastError();  // clear the sticky error from the failed call
+    Release(idx);
+  }
+
+  /**
+   * Wait until no slot is in flight.
+   * @return true if no drained store failed since the previous Flush.
+   */
+  bool Flush() {
+    std::unique_lock<std::mutex> lk(mu_);
+    idle_cv_.wait(lk, [this] { return pending_.empty() && in_use_ == 0; });
+    return failures_.exchange(0) == 0;
+  }
+
+ private:
+  /** (Re)allocate the slot buffer when it is smaller than size. */
+  bool EnsureCapacity(StagingSlot& slot, size_t size) {
+    if (slot.capacity >= size) return true;
+    FreeSlotBuffer(slot);
+    auto* ipc_manager = CHI_IPC;
+    // The pool falls back to pageable memory if it cannot page-lock; the
+    // copies still work, they just stop overlapping.
+    slot.buf = ipc_manager->AllocateBuffer(size, /*pinned=*/true);
+    if (slot.buf.IsNull()) return false;
+    slot.capacity = size;
+    return true;
+  }
+
+  static void FreeSlotBuffer(StagingSlot& slot) {
+    if (slot.buf.IsNull()) return;
+    auto* ipc_manager = CHI_IPC;
+    ipc_manager->FreeBuffer(slot.buf);
+    slot.buf = hipc::FullPtr<char>();
+    slot.capacity = 0;
+  }
+
+  /** Complete stores in submission order until Stop(). */
+  void DrainLoop() {
+    for (;;) {
+      int idx;
+      {
+        std::unique_lock<std::mutex> lk(mu_);
+        work_cv_.wait(lk, [this] { return stop_ || !pending_.empty(); });
+        if (pending_.empty()) return;
+        idx = pending_.front();
+        pending_.pop_front();
+      }
+      StagingSlot& slot = slots_[idx];
+      bool copied = CUDA_CHECK(cudaEventSynchronize(slot.done));
+      if (!slot.key.empty()) {
+        bool stored = false;
+        if (copied) {
+          try {
+            tag_->PutBlob(slot.key, hipc::ShmPtr<>(slot.buf.shm_), slot.size,
+                          /*off=*/0, score_);
+            stored = true;
+          } catch (const std::exception& e) {
+            fprintf(stderr, "kvcache_manager: async StoreBlock failed: %s\n",
+                    e.what());
+          }
+        }
+        if (stored) {
+          index_->Insert(slot.tokens, slot.size);
+        } else {
+          failures_.fetch_add(1);
+        }
+      }
+      Release(idx);
+    }
+  }
+
+  wrp_cte::core::Tag* tag_ = nullptr;
+  PrefixIndex* index_ = nullptr;
+  float score_ = 0.0f;
+  cudaStream_t copy_stream_ = nullptr;
+  std::vector<StagingSlot> slots_;
+
+  std::mutex mu_;
+  std::condition_variable free_cv_;  // a slot was released
+  std::condition_variable work_cv_;  // pending_ grew or stop_ was set
+  std::condition_variable idle_cv_;  // nothing in flight
+  std::vector<bool> busy_;
+  std::deque<int> pending_;
+  size_t in_use_ = 0;
+  size_t next_ = 0;
+  bool stop_ = false;
+  std::atomic<size_t> failures_{0};
+  std::thread drain_;
+};
+#endif  // IOWARP_LLM_ENABLE_CUDA
+
+// ---------------------------------------------------------------------------
+// Raw-key index entry
 // ---------------------------------------------------------------------------
 struct IndexEntry {
-  std::string blob_key;       // CTE blob name (hex hash of token prefix)
   size_t blob_size;           // stored size in bytes
-  size_t token_count;         // number of tokens this block covers
   std::chrono::steady_clock::time_point stored_at;
 };
 
@@ -47,45 +289,188 @@ struct KVCacheManager::Impl {
   // High-level CTE tag handle.  Null until Init() succeeds.
   std::unique_ptr<wrp_cte::core::Tag> tag;
 
-  // In-process index: hash → entry.
-  // Protected by a mutex because llama.cpp may call us from worker threads.
-  mutable std::mutex mu;
+  // Token-prefix index; internally sharded and locked, because llama.cpp
+  // may call us from worker threads.
+  std::unique_ptr<PrefixIndex> prefix_index;
+
+  // Raw-key index: key → entry.  Lookups take the reader lock.
+  mutable std::shared_mutex mu;
   std::unordered_map<std::string, IndexEntry> index;
 
-  // Staging buffer for GPU↔CPU copies.
-  // Resized on demand; protected by mu when accessed.
-  std::vector<uint8_t> staging;
+  void InitIndex() {
+    prefix_index = std::make_unique<PrefixIndex>(
+        cfg.block_tokens, cfg.max_index_entries, cfg.index_shards);
+  }
 
-  bool EnsureStaging(size_t sz) {
-    if (staging.size() < sz) staging.resize(sz);
-    return true;
+#ifdef IOWARP_LLM_ENABLE_CUDA
+  // Pinned staging ring for GPU↔CPU copies.  Started on first on_gpu use
+  // so CPU-only callers never create a CUDA context.
+  std::mutex ring_mu;
+  std::unique_ptr<StagingRing> ring;
+
+  StagingRing* Ring() {
+    std::lock_guard<std::mutex> lk(ring_mu);
+    if (!ring) {
+      auto fresh = std::make_unique<StagingRing>();
+      if (!fresh->Start(cfg.staging_slots, tag.get(), prefix_index.get(),
+                        cfg.evicted_score)) {
+        return nullptr;
+      }
+      ring = std::move(fresh);
+    }
+    return ring.get();
   }
 
-  // D2H copy using a pinned staging buffer; caller must hold no lock.
-  bool DeviceToHost(const void* dev_ptr, size_t size) {
+  void StopRing() {
+    std::lock_guard<std::mutex> lk(ring_mu);
+    if (ring) ring->Stop();
+    ring.reset();
+  }
+
+  bool FlushRing() {
+    std::lock_guard<std::mutex> lk(ring_mu);
+    return ring ? ring->Flush() : true;
+  }
+#endif
+
+  // Queue a D2H copy of a device block ordered after stream, then let the
+  // drain thread store it under key.  Caller must hold no lock.
+  bool StoreFromDevice(const std::vector<int32_t>& tokens,
+                       const std::string& key, const void* dev_ptr,
+                       size_t size, void* stream) {
 #ifdef IOWARP_LLM_ENABLE_CUDA
-    EnsureStaging(size);
-    CUDA_CHECK(cudaMemcpy(staging.data(), dev_ptr, size, cudaMemcpyDeviceToHost));
+    StagingRing* staging = Ring();
+    if (!staging) return false;
+    int idx = staging->Acquire(size);
+    if (idx < 0) return false;
+    StagingSlot& slot = staging->Slot(idx);
+    cudaStream_t caller = static_cast<cudaStream_t>(stream);
+    cudaStream_t copy = staging->CopyStream();
+    // Copy once the producer is done, and keep the caller from reusing the
+    // device block until the copy has read it.
+    bool ok = CUDA_CHECK(cudaEventRecord(slot.ready, caller)) &&
+              CUDA_CHECK(cudaStreamWaitEvent(copy, slot.ready, 0)) &&
+              CUDA_CHECK(cudaMemcpyAsync(slot.buf.ptr_, dev_ptr, size,
+                                         cudaMemcpyDeviceToHost, copy)) &&
+              CUDA_CHECK(cudaEventRecord(slot.done, copy)) &&
+              CUDA_CHECK(cudaStreamWaitEvent(caller, slot.done, 0));
+    if (!ok) {
+      staging->Abandon(idx, copy);
+      return false;
+    }
+    slot.key = key;
+    slot.tokens = tokens;
+    slot.size = size;
+    staging->Submit(idx);
     return true;
 #else
-    (void)dev_ptr; (void)size;
+    (void)tokens; (void)key; (void)dev_ptr; (void)size; (void)stream;
     fprintf(stderr, "kvcache_manager: on_gpu=true but CUDA not compiled in\n");
     return false;
 #endif
   }
 
-  // H2D copy from staging buffer to device; caller must hold no lock.
-  bool HostToDevice(void* dev_ptr, size_t size) {
+  // Read key from CTE into a staging slot and enqueue the H2D copy on
+  // stream; the slot is recycled once the copy completes.  Caller must
+  // hold no lock.
+  bool RestoreToDevice(const std::string& key, void* dev_ptr, size_t size,
+                       void* stream) {
 #ifdef IOWARP_LLM_ENABLE_CUDA
-    CUDA_CHECK(cudaMemcpy(dev_ptr, staging.data(), size, cudaMemcpyHostToDevice));
+    StagingRing* staging = Ring();
+    if (!staging) return false;
+    int idx = staging->Acquire(size);
+    if (idx < 0) return false;
+    StagingSlot& slot = staging->Slot(idx);
+    try {
+      tag->GetBlob(key, hipc::ShmPtr<>(slot.buf.shm_), size, /*off=*/0);
+    } catch (const std::exception&) {
+      staging->Release(idx);
+      return false;
+    }
+    cudaStream_t caller = static_cast<cudaStream_t>(stream);
+    bool ok = CUDA_CHECK(cudaMemcpyAsync(dev_ptr, slot.buf.ptr_, size,
+                                         cudaMemcpyHostToDevice, caller)) &&
+              CUDA_CHECK(cudaEventRecord(slot.done, caller));
+    if (!ok) {
+      staging->Abandon(idx, caller);
+      return false;
+    }
+    staging->Submit(idx);
     return true;
 #else
-    (void)dev_ptr; (void)size;
+    (void)key; (void)dev_ptr; (void)size; (void)stream;
     fprintf(stderr, "kvcache_manager: on_gpu=true but CUDA not compiled in\n");
     return false;
 #endif
   }
 
+  // Promotions queued by PrefetchPrefix, oldest first.
+  struct PendingPrefetch {
+    std::string key;
+    chi::Future<wrp_cte::core::ReorganizeBlobTask> future;
+  };
+  std::mutex prefetch_mu;
+  std::deque<PendingPrefetch> prefetch_inflight;
+  // Keys promoted by a prefetch and not yet served by a lookup.
+  std::unordered_set<std::string> prefetched;
+
+  std::atomic<uint64_t> prefetch_requests{0};
+  std::atomic<uint64_t> prefetch_misses{0};
+  std::atomic<uint64_t> prefetch_issued{0};
+  std::atomic<uint64_t> prefetch_failures{0};
+  std::atomic<uint64_t> prefetch_hits{0};
+
+  // Wait for the oldest promotion and record its outcome.  Caller must
+  // hold prefetch_mu.
+  void RetireOldestPrefetch() {
+    PendingPrefetch& front = prefetch_inflight.front();
+    front.future.Wait();
+    if (front.future->GetReturnCode() == 0) {
+      if (prefetched.size() >= cfg.max_index_entries) prefetched.clear();
+      prefetched.insert(front.key);
+    } else {
+      prefetch_failures.fetch_add(1);
+    }
+    prefetch_inflight.pop_front();
+  }
+
+  // Retire finished promotions in order (all of them when wait is set).
+  // Caller must hold prefetch_mu.
+  void ReapPrefetches(bool wait) {
+    while (!prefetch_inflight.empty() &&
+           (wait || prefetch_inflight.front().future.IsComplete())) {
+      RetireOldestPrefetch();
+    }
+  }
+
+  // Queue a promotion of key unless one is already pending or done.
+  bool QueuePrefetch(const std::string& key) {
+    std::lock_guard<std::mutex> lk(prefetch_mu);
+    ReapPrefetches(/*wait=*/false);
+    if (prefetched.count(key)) return true;
+    for (const auto& pending : prefetch_inflight) {
+      if (pending.key == key) return true;
+    }
+    // Back-pressure: bound the number of outstanding CTE tasks.
+    if (prefetch_inflight.size() >= std::max<size_t>(
+                                        1, cfg.max_inflight_prefetches)) {
+      RetireOldestPrefetch();
+    }
+    auto* cte_client = WRP_CTE_CLIENT;
+    prefetch_inflight.push_back(PendingPrefetch{
+        key, cte_client->AsyncReorganizeBlob(tag->GetTagId(), key,
+                                             cfg.evicted_score)});
+    prefetch_issued.fetch_add(1);
+    return true;
+  }
+
+  // Count a lookup served by a prefetched block.
+  void NotePrefetchUse(const std::string& key) {
+    std::lock_guard<std::mutex> lk(prefetch_mu);
+    ReapPrefetches(/*wait=*/false);
+    if (prefetched.erase(key)) prefetch_hits.fetch_add(1);
+  }
+
   void TrimIndex() {
     // Evict oldest entries when we exceed max_index_entries.
     if (index.size() <= cfg.max_index_entries) return;
@@ -108,11 +493,13 @@ struct KVCacheManager::Impl {
 KVCacheManager::KVCacheManager()
     : cfg_(Config()), impl_(std::make_unique<Impl>()) {
   impl_->cfg = cfg_;
+  impl_->InitIndex();
 }
 
 KVCacheManager::KVCacheManager(const Config& cfg)
     : cfg_(cfg), impl_(std::make_unique<Impl>()) {
   impl_->cfg = cfg;
+  impl_->InitIndex();
 }
 
 KVCacheManager::~KVCacheManager() { Shutdown(); }
@@ -145,12 +532,37 @@ bool KVCacheManager::Init() {
 
 void KVCacheManager::Shutdown() {
   if (!impl_->ready) return;
+#ifdef IOWARP_LLM_ENABLE_CUDA
+  impl_->StopRing();
+#endif
+  {
+    std::lock_guard<std::mutex> lk(impl_->prefetch_mu);
+    impl_->ReapPrefetches(/*wait=*/true);
+    impl_->prefetched.clear();
+  }
   impl_->tag.reset();
   impl_->ready = false;
 }
 
 bool KVCacheManager::IsReady() const { return impl_->ready; }
 
+KVCacheManager::Stats KVCacheManager::GetStats() const {
+  Stats stats;
+  stats.prefetch_requests = impl_->prefetch_requests.load();
+  stats.prefetch_misses = impl_->prefetch_misses.load();
+  stats.prefetch_issued = impl_->prefetch_issued.load();
+  stats.prefetch_failures = impl_->prefetch_failures.load();
+  stats.prefetch_hits = impl_->prefetch_hits.load();
+  return stats;
+}
+
+bool KVCacheManager::Flush() {
+#ifdef IOWARP_LLM_ENABLE_CUDA
+  if (impl_->ready) return impl_->FlushRing();
+#endif
+  return true;
+}
+
 // ---------------------------------------------------------------------------
 // Raw-key API
 // ---------------------------------------------------------------------------
@@ -168,9 +580,8 @@ bool KVCacheManager::StoreBlockRaw(const std::string& key,
   }
 
   {
-    std::lock_guard<std::mutex> lk(impl_->mu);
-    impl_->index[key] = IndexEntry{key, size, 0,
-                                    std::chrono::steady_clock::now()};
+    std::unique_lock<std::shared_mutex> lk(impl_->mu);
+    impl_->index[key] = IndexEntry{size, std::chrono::steady_clock::now()};
     impl_->TrimIndex();
   }
   return true;
@@ -182,7 +593,7 @@ bool KVCacheManager::LookupRaw(const std::string& key,
 
   size_t blob_size = 0;
   {
-    std::lock_guard<std::mutex> lk(impl_->mu);
+    std::shared_lock<std::shared_mutex> lk(impl_->mu);
     auto it = impl_->index.find(key);
     if (it == impl_->index.end()) return false;
     blob_size = it->second.blob_size;
@@ -223,17 +634,17 @@ std::string KVCacheManager::HashTokens(const std::vector<int32_t>& tokens) {
 // ---------------------------------------------------------------------------
 bool KVCacheManager::StoreBlock(const std::vector<int32_t>& tokens,
                                  const void* kv_data, size_t size,
-                                 bool on_gpu) {
+                                 bool on_gpu, void* stream) {
   if (!impl_->ready || tokens.empty() || !kv_data || size == 0) return false;
 
-  const char* host_ptr = reinterpret_cast<const char*>(kv_data);
+  std::string key = impl_->prefix_index->KeyOf(tokens).ToHex();
+
+  // Device blocks are indexed by the drain thread once they reach CTE.
   if (on_gpu) {
-    if (!impl_->DeviceToHost(kv_data, size)) return false;
-    host_ptr = reinterpret_cast<const char*>(impl_->staging.data());
+    return impl_->StoreFromDevice(tokens, key, kv_data, size, stream);
   }
 
-  std::string key = HashTokens(tokens);
-
+  const char* host_ptr = reinterpret_cast<const char*>(kv_data);
   try {
     impl_->tag->PutBlob(key, host_ptr, size, /*off=*/0, cfg_.evicted_score);
   } catch (const std::exception& e) {
@@ -241,13 +652,7 @@ bool KVCacheManager::StoreBlock(const std::vector<int32_t>& tokens,
     return false;
   }
 
-  {
-    std::lock_guard<std::mutex> lk(impl_->mu);
-    impl_->index[key] = IndexEntry{
-        key, size, tokens.size(),
-        std::chrono::steady_clock::now()};
-    impl_->TrimIndex();
-  }
+  impl_->prefix_index->Insert(tokens, size);
   return true;
 }
 
@@ -256,45 +661,35 @@ bool KVCacheManager::StoreBlock(const std::vector<int32_t>& tokens,
 // ---------------------------------------------------------------------------
 bool KVCacheManager::LookupPrefix(const std::vector<int32_t>& tokens,
                                    void* dst, size_t dst_size, bool on_gpu,
-                                   size_t& matched_len) {
+                                   size_t& matched_len, void* stream) {
   if (!impl_->ready || tokens.empty() || !dst) {
     matched_len = 0;
     return false;
   }
 
-  // Try progressively shorter prefixes, longest first.
-  for (size_t len = tokens.size(); len > 0; --len) {
-    std::string key = HashTokens(
-        std::vector<int32_t>(tokens.begin(), tokens.begin() + len));
-
-    std::string blob_key;
-    size_t blob_size = 0;
-    {
-      std::lock_guard<std::mutex> lk(impl_->mu);
-      auto it = impl_->index.find(key);
-      if (it == impl_->index.end()) continue;
-      blob_key = it->second.blob_key;
-      blob_size = it->second.blob_size;
-    }
+  // One walk down the prefix tree yields every stored prefix of tokens;
+  // try them longest first.
+  std::vector<PrefixIndex::Match> matches;
+  impl_->prefix_index->FindPrefixes(tokens, matches);
+  for (const auto& match : matches) {
+    std::string blob_key = match.key.ToHex();
+    size_t blob_size = match.blob_size;
 
     if (blob_size > dst_size) continue;  // would overflow destination
 
-    char* host_dst = on_gpu
-                         ? reinterpret_cast<char*>(impl_->staging.data())
-                         : reinterpret_cast<char*>(dst);
-    if (on_gpu) impl_->EnsureStaging(blob_size);
-
-    try {
-      impl_->tag->GetBlob(blob_key, host_dst, blob_size, /*off=*/0);
-    } catch (const std::exception&) {
-      continue;  // blob not available — try shorter prefix
-    }
-
     if (on_gpu) {
-      if (!impl_->HostToDevice(dst, blob_size)) continue;
+      if (!impl_->RestoreToDevice(blob_key, dst, blob_size, stream)) continue;
+    } else {
+      try {
+        impl_->tag->GetBlob(blob_key, reinterpret_cast<char*>(dst), blob_size,
+                            /*off=*/0);
+      } catch (const std::exception&) {
+        continue;  // blob not available — try shorter prefix
+      }
     }
 
-    matched_len = len;
+    impl_->NotePrefetchUse(blob_key);
+    matched_len = match.token_count;
     return true;
   }
 
@@ -302,22 +697,48 @@ bool KVCacheManager::LookupPrefix(const std::vector<int32_t>& tokens,
   return false;
 }
 
+// ---------------------------------------------------------------------------
+// PrefetchPrefix
+// ---------------------------------------------------------------------------
+bool KVCacheManager::PrefetchPrefix(const std::vector<int32_t>& tokens,
+                                     size_t max_bytes) {
+  if (!impl_->ready || tokens.empty()) return false;
+  impl_->prefetch_requests.fetch_add(1);
+
+  // Same selection as LookupPrefix: the longest prefix that fits.
+  std::vector<PrefixIndex::Match> matches;
+  impl_->prefix_index->FindPrefixes(tokens, matches);
+  for (const auto& match : matches) {
+    if (match.blob_size > max_bytes) continue;
+    try {
+      return impl_->QueuePrefetch(match.key.ToHex());
+    } catch (const std::exception& e) {
+      fprintf(stderr, "kvcache_manager: PrefetchPrefix failed: %s\n",
+              e.what());
+      impl_->prefetch_failures.fetch_add(1);
+      return false;
+    }
+  }
+
+  impl_->prefetch_misses.fetch_add(1);
+  return false;
+}
+
 // ---------------------------------------------------------------------------
 // OnEvict
 // ---------------------------------------------------------------------------
 void KVCacheManager::OnEvict(const std::vector<int32_t>& tokens,
-                              const void* kv_data, size_t size, bool on_gpu) {
+                              const void* kv_data, size_t size, bool on_gpu,
+                              void* stream) {
   if (!impl_->ready || tokens.empty()) return;
 
   if (kv_data && size > 0) {
-    StoreBlock(tokens, kv_data, size, on_gpu);
+    StoreBlock(tokens, kv_data, size, on_gpu, stream);
     return;
   }
 
   // kv_data == nullptr: just remove from index (data was already gone).
-  std::string key = HashTokens(tokens);
-  std::lock_guard<std::mutex> lk(impl_->mu);
-  impl_->index.erase(key);
+  impl_->prefix_index->Erase(tokens);
 }
 
 }  // namespace kvcache
@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "wrp_llm/kvcache/prefix_index.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <utility>
+
+namespace wrp_llm {
+namespace kvcache {
+
+namespace {
+
+constexpr uint64_t kPrime1 = 0x9e3779b185ebca87ULL;
+constexpr uint64_t kPrime2 = 0xc2b2ae3d27d4eb4fULL;
+constexpr uint64_t kPrime3 = 0x165667b19e3779f9ULL;
+constexpr uint64_t kPrime4 = 0x85ebca77c2b2ae63ULL;
+
+inline uint64_t Rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+// MurmurHash3 64-bit finalizer.
+inline uint64_t Mix64(uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+}  // namespace
+
+std::string PrefixKey::ToHex() const {
+  char buf[33];
+  snprintf(buf, sizeof(buf), "%016llx%016llx",
+           static_cast<unsigned long long>(hi),
+           static_cast<unsigned long long>(lo));
+  return std::string(buf, 32);
+}
+
+PrefixIndex::PrefixIndex(size_t block_tokens, size_t max_entries,
+                         size_t num_shards)
+    : block_tokens_(std::clamp<size_t>(block_tokens, 1, 64)),
+      max_entries_(max_entries) {
+  for (size_t i = 0; i < std::max<size_t>(num_shards, 1); ++i) {
+    shards_.emplace_back(std::make_unique<Shard>());
+  }
+  ShardOf(PrefixKey()).nodes.try_emplace(PrefixKey());
+}
+
+// ---------------------------------------------------------------------------
+// Hashing
+// ---------------------------------------------------------------------------
+// Two independent xxHash-style lanes, seeded by the parent key and the
+// block length so a tail block never collides with a full one.
+PrefixKey PrefixIndex::HashBlock(const PrefixKey& parent,
+                                 const int32_t* tokens, size_t count) {
+  uint64_t a = parent.lo + kPrime1 * (count + 1);
+  uint64_t b = parent.hi ^ (kPrime4 * (count + 1));
+  for (size_t i = 0; i < count; ++i) {
+    uint64_t t = static_cast<uint32_t>(tokens[i]);
+    a = Rotl(a + t * kPrime2, 31) * kPrime1;
+    b = Rotl(b ^ (t * kPrime3), 27) * kPrime4 + kPrime1;
+  }
+  PrefixKey key;
+  key.lo = Mix64(a ^ Rotl(b, 17));
+  key.hi = Mix64(b + a);
+  if (key.IsRoot()) key.lo = 1;  // Zero is reserved for the empty prefix
+  return key;
+}
+
+PrefixKey PrefixIndex::KeyOf(const std::vector<int32_t>& tokens) const {
+  PrefixKey key;
+  for (size_t pos = 0; pos < tokens.size(); pos += block_tokens_) {
+    size_t n = std::min(block_tokens_, tokens.size() - pos);
+    key = HashBlock(key, tokens.data() + pos, n);
+  }
+  return key;
+}
+
+// ---------------------------------------------------------------------------
+// Insert / lookup
+// ---------------------------------------------------------------------------
+void PrefixIndex::AddNode(const PrefixKey& key, const PrefixKey& parent,
+                          uint32_t tail_len) {
+  {
+    Shard& shard = ShardOf(key);
+    std::unique_lock<std::shared_mutex> lk(shard.mu);
+    auto [it, inserted] = shard.nodes.try_emplace(key);
+    if (!inserted) return;
+    it->second.parent = parent;
+    it->second.tail_len = tail_len;
+    it->second.last_use.store(clock_.fetch_add(1), std::memory_order_relaxed);
+  }
+  size_.fetch_add(1, std::memory_order_relaxed);
+
+  // Shards are locked one at a time, so no lock order is needed
+  Shard& shard = ShardOf(parent);
+  std::unique_lock<std::shared_mutex> lk(shard.mu);
+  auto it = shard.nodes.find(parent);
+  if (it == shard.nodes.end()) return;  // Parent pruned meanwhile
+  ++it->second.children;
+  if (tail_len != 0) it->second.tail_mask |= 1ULL << tail_len;
+}
+
+PrefixKey PrefixIndex::Insert(const std::vector<int32_t>& tokens,
+                              size_t blob_size) {
+  PrefixKey parent, key;
+  uint32_t tail_len = 0;
+  for (size_t pos = 0; pos < tokens.size(); pos += block_tokens_) {
+    size_t n = std::min(block_tokens_, tokens.size() - pos);
+    parent = key;
+    key = HashBlock(parent, tokens.data() + pos, n);
+    tail_len = n < block_tokens_ ? static_cast<uint32_t>(n) : 0;
+    AddNode(key, parent, tail_len);
+  }
+  if (key.IsRoot()) return key;
+
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    Shard& shard = ShardOf(key);
+    std::unique_lock<std::shared_mutex> lk(shard.mu);
+    auto it = shard.nodes.find(key);
+    if (it != shard.nodes.end()) {
+      it->second.blob_size = std::max<size_t>(blob_size, 1);
+      it->second.last_use.store(clock_.fetch_add(1),
+                                std::memory_order_relaxed);
+      break;
+    }
+    lk.unlock();
+    AddNode(key, parent, tail_len);  // An Erase pruned the empty leaf
+  }
+  if (Size() > max_entries_) Trim();
+  return key;
+}
+
+void PrefixIndex::FindPrefixes(const std::vector<int32_t>& tokens,
+                               std::vector<Match>& matches) const {
+  matches.clear();
+  uint64_t now = clock_.fetch_add(1);
+  // Look a node up under its shard's reader lock, recording a stored hit
+  auto visit = [&](const PrefixKey& key, size_t len, uint64_t* tail_mask) {
+    Shard& shard = ShardOf(key);
+    std::shared_lock<std::shared_mutex> lk(shard.mu);
+    auto it = shard.nodes.find(key);
+    if (it == shard.nodes.end()) return false;
+    Node& node = it->second;
+    if (tail_mask != nullptr) *tail_mask = node.tail_mask;
+    if (node.blob_size != 0 && len != 0) {
+      matches.push_back({key, len, node.blob_size});
+      node.last_use.store(now, std::memory_order_relaxed);
+    }
+    return true;
+  };
+
+  PrefixKey key;
+  size_t pos = 0;
+  uint64_t tail_mask = 0;
+  while (visit(key, pos, &tail_mask)) {
+    // Sequences that end inside the next block hang off this node as tails
+    size_t remaining = tokens.size() - pos;
+    for (size_t n = std::min(remaining, block_tokens_ - 1); n > 0; --n) {
+      if ((tail_mask >> n) & 1ULL) {
+        visit(HashBlock(key, tokens.data() + pos, n), pos + n, nullptr);
+      }
+    }
+    if (remaining < block_tokens_) break;
+    key = HashBlock(key, tokens.data() + pos, block_tokens_);
+    pos += block_tokens_;
+  }
+  std::sort(matches.begin(), matches.end(),
+            [](const Match& a, const Match& b) {
+              return a.token_count > b.token_count;
+            });
+}
+
+// ---------------------------------------------------------------------------
+// Removal
+// ---------------------------------------------------------------------------
+bool PrefixIndex::Erase(const std::vector<int32_t>& tokens) {
+  PrefixKey key = KeyOf(tokens);
+  if (key.IsRoot()) return false;
+  {
+    Shard& shard = ShardOf(key);
+    std::shared_lock<std::shared_mutex> lk(shard.mu);
+    auto it = shard.nodes.find(key);
+    if (it == shard.nodes.end() || it->second.blob_size == 0) return false;
+  }
+  Prune(key, true, 0);
+  return true;
+}
+
+void PrefixIndex::Prune(PrefixKey key, bool drop_blob, uint64_t expect_use) {
+  while (!key.IsRoot()) {
+    PrefixKey parent;
+    {
+      Shard& shard = ShardOf(key);
+      std::unique_lock<std::shared_mutex> lk(shard.mu);
+      auto it = shard.nodes.find(key);
+      if (it == shard.nodes.end()) return;
+      Node& node = it->second;
+      if (drop_blob) {
+        // A trim skips a leaf that was hit after it was picked
+        if (expect_use != 0 &&
+            node.last_use.load(std::memory_order_relaxed) != expect_use) {
+          return;
+        }
+        node.blob_size = 0;
+        drop_blob = false;
+      }
+      if (node.children != 0 || node.blob_size != 0) return;
+      parent = node.parent;
+      shard.nodes.erase(it);
+    }
+    size_.fetch_sub(1, std::memory_order_relaxed);
+
+    // tail_mask bits stand for a length, not one child, so they stay set;
+    // a stale bit costs one extra probe
+    Shard& shard = ShardOf(parent);
+    std::unique_lock<std::shared_mutex> lk(shard.mu);
+    auto it = shard.nodes.find(parent);
+    if (it == shard.nodes.end()) return;
+    if (it->second.children > 0) --it->second.children;
+    key = parent;
+  }
+}
+
+void PrefixIndex::Trim() {
+  if (trimming_.exchange(true, std::memory_order_acquire)) return;
+  // Drop a little below the budget so trims stay rare
+  size_t target = max_entries_ - max_entries_ / 16;
+  std::vector<std::pair<uint64_t, PrefixKey>> leaves;
+  for (auto& shard : shards_) {
+    std::shared_lock<std::shared_mutex> lk(shard->mu);
+    for (auto& [key, node] : shard->nodes) {
+      if (node.children == 0 && node.blob_size != 0) {
+        leaves.emplace_back(node.last_use.load(std::memory_order_relaxed),
+                            key);
+      }
+    }
+  }
+  size_t size = Size();
+  size_t excess = std::min(size > target ? size - target : 0, leaves.size());
+  std::nth_element(leaves.begin(), leaves.begin() + excess, leaves.end(),
+                   [](const auto& a, const auto& b) {
+                     return a.first < b.first;
+                   });
+  for (size_t i = 0; i < excess; ++i) {
+    Prune(leaves[i].second, true, leaves[i].first);
+  }
+  trimming_.store(false, std::memory_order_release);
+}
+
+}  // namespace kvcache
+}  // namespace wrp_llm
@@ -1,7 +1,10 @@
 #include <catch2/catch_test_macros.hpp>
 #include "wrp_llm/kvcache/kvcache_manager.h"
+#include "wrp_llm/kvcache/prefix_index.h"
 
 using wrp_llm::kvcache::KVCacheManager;
+using wrp_llm::kvcache::PrefixIndex;
+using wrp_llm::kvcache::PrefixKey;
 
 // ---------------------------------------------------------------------------
 // Hash utility tests (no CTE required)
@@ -27,6 +30,84 @@ TEST_CASE("KVCacheManager::HashTokens prefix of a longer sequence differs", "[kv
     REQUIRE(KVCacheManager::HashTokens(full) != KVCacheManager::HashTokens(prefix));
 }
 
+// ---------------------------------------------------------------------------
+// Prefix index tests (no CTE required)
+// ---------------------------------------------------------------------------
+
+static std::vector<int32_t> Iota(int32_t n) {
+    std::vector<int32_t> tokens(n);
+    for (int32_t i = 0; i < n; ++i) tokens[i] = i * 7 + 1;
+    return tokens;
+}
+
+TEST_CASE("PrefixIndex keys chain block by block", "[kvcache][unit]") {
+    PrefixIndex index(/*block_tokens=*/4);
+    std::vector<int32_t> tokens = Iota(10);
+    PrefixKey key = PrefixIndex::HashBlock(PrefixKey(), tokens.data(), 4);
+    key = PrefixIndex::HashBlock(key, tokens.data() + 4, 4);
+    key = PrefixIndex::HashBlock(key, tokens.data() + 8, 2);
+    REQUIRE(index.KeyOf(tokens) == key);
+    REQUIRE(key.ToHex().size() == 32);
+    REQUIRE(index.KeyOf(Iota(9)) != key);
+    REQUIRE(index.KeyOf({}).IsRoot());
+}
+
+TEST_CASE("PrefixIndex finds every stored prefix, longest first", "[kvcache][unit]") {
+    PrefixIndex index(/*block_tokens=*/4);
+    std::vector<int32_t> query = Iota(20);
+    index.Insert(std::vector<int32_t>(query.begin(), query.begin() + 3), 30);
+    index.Insert(std::vector<int32_t>(query.begin(), query.begin() + 8), 80);
+    index.Insert(std::vector<int32_t>(query.begin(), query.begin() + 13), 130);
+    index.Insert({99, 98, 97}, 5);  // Unrelated sequence
+
+    std::vector<PrefixIndex::Match> matches;
+    index.FindPrefixes(query, matches);
+    REQUIRE(matches.size() == 3);
+    REQUIRE(matches[0].token_count == 13);
+    REQUIRE(matches[0].blob_size == 130);
+    REQUIRE(matches[1].token_count == 8);
+    REQUIRE(matches[2].token_count == 3);
+
+    // A query that diverges mid-block only matches up to the divergence
+    std::vector<int32_t> diverged = query;
+    diverged[10] = -1;
+    index.FindPrefixes(diverged, matches);
+    REQUIRE(matches.size() == 2);
+    REQUIRE(matches[0].token_count == 8);
+}
+
+TEST_CASE("PrefixIndex Erase keeps longer sequences reachable", "[kvcache][unit]") {
+    PrefixIndex index(/*block_tokens=*/4);
+    std::vector<int32_t> query = Iota(12);
+    std::vector<int32_t> short_seq(query.begin(), query.begin() + 4);
+    index.Insert(short_seq, 40);
+    index.Insert(query, 120);
+
+    REQUIRE(index.Erase(short_seq));
+    REQUIRE_FALSE(index.Erase(short_seq));
+    std::vector<PrefixIndex::Match> matches;
+    index.FindPrefixes(query, matches);
+    REQUIRE(matches.size() == 1);
+    REQUIRE(matches[0].token_count == 12);
+
+    REQUIRE(index.Erase(query));
+    REQUIRE(index.Size() == 0);  // Empty interior nodes are pruned too
+}
+
+TEST_CASE("PrefixIndex drops least recently used leaves past its budget", "[kvcache][unit]") {
+    PrefixIndex index(/*block_tokens=*/2, /*max_entries=*/64, /*num_shards=*/4);
+    std::vector<int32_t> hot = {1000, 1001};
+    index.Insert(hot, 1);
+    std::vector<PrefixIndex::Match> matches;
+    for (int32_t i = 0; i < 200; ++i) {
+        index.Insert({i, i + 1}, 1);
+        index.FindPrefixes(hot, matches);  // Keep the hot entry in use
+    }
+    REQUIRE(index.Size() <= 64);
+    index.FindPrefixes(hot, matches);
+    REQUIRE(matches.size() == 1);
+}
+
 // ---------------------------------------------------------------------------
 // Integration tests (require CTE runtime — run inside the container)
 // ---------------------------------------------------------------------------
@@ -84,3 +165,38 @@ TEST_CASE("KVCacheManager LookupPrefix returns longest match", "[kvcache][integr
 
     mgr.Shutdown();
 }
+
+TEST_CASE("KVCacheManager PrefetchPrefix promotes stored prefixes", "[kvcache][integration]") {
+    KVCacheManager::Config cfg;
+    cfg.tag_name = "test_kvcache_prefetch";
+    KVCacheManager mgr(cfg);
+
+    if (!mgr.Init()) {
+        SKIP("CTE runtime not available — skipping integration test");
+    }
+
+    std::vector<int32_t> prefix = {7, 8, 9};
+    std::vector<uint8_t> kv(256, 0x5A);
+    REQUIRE(mgr.StoreBlock(prefix, kv.data(), kv.size(), /*on_gpu=*/false));
+
+    // Unknown sequence — nothing to promote.
+    REQUIRE_FALSE(mgr.PrefetchPrefix({42, 43}));
+    // Too small a destination buffer — same as a lookup miss.
+    REQUIRE_FALSE(mgr.PrefetchPrefix({7, 8, 9, 10}, kv.size() - 1));
+    REQUIRE(mgr.PrefetchPrefix({7, 8, 9, 10}, kv.size()));
+
+    std::vector<uint8_t> out(256);
+    size_t matched = 0;
+    REQUIRE(mgr.LookupPrefix({7, 8, 9, 10}, out.data(), out.size(),
+                             /*on_gpu=*/false, matched));
+    REQUIRE(matched == 3);
+    REQUIRE(out == kv);
+
+    KVCacheManager::Stats stats = mgr.GetStats();
+    REQUIRE(stats.prefetch_requests == 3);
+    REQUIRE(stats.prefetch_misses == 2);
+    REQUIRE(stats.prefetch_issued == 1);
+    REQUIRE(stats.prefetch_failures == 0);
+
+    mgr.Shutdown();
+}
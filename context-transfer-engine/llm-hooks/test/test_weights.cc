@@ -43,6 +43,45 @@ TEST_CASE("WeightManager RegisterLayer + PrepareLayer + ReleaseLayer", "[weights
     mgr.Shutdown();
 }
 
+TEST_CASE("WeightManager pins the most used experts", "[weights][integration]") {
+    WeightManager::Config cfg;
+    cfg.va_size_bytes            = 4ULL * 1024 * 1024 * 1024;
+    cfg.page_size                = 2 * 1024 * 1024;
+    cfg.use_cte                  = false;
+    cfg.device                   = 0;
+    cfg.pinned_experts_per_layer = 1;
+
+    WeightManager mgr(cfg);
+    REQUIRE(mgr.Init());
+
+    // One MoE layer: a dense page followed by four single-page experts.
+    mgr.RegisterLayer(0, /*page_start=*/0, /*page_count=*/1);
+    for (int e = 0; e < 4; ++e) {
+        mgr.RegisterExpert(0, e, /*page_start=*/1 + e, /*page_count=*/1);
+    }
+    REQUIRE(mgr.HasExperts(0));
+    REQUIRE_FALSE(mgr.HasExperts(1));
+
+    for (int pass = 0; pass < 4; ++pass) {
+        mgr.PrepareLayer(0);
+        mgr.PrepareExperts(0, {2, pass % 2 ? 1 : 3});
+        mgr.ReleaseLayer(0);
+        mgr.WaitTransfers();
+    }
+
+    // Expert 2 is routed every pass: pinned and never evicted.
+    REQUIRE(mgr.IsExpertPinned(0, 2));
+    REQUIRE_FALSE(mgr.IsExpertPinned(0, 0));
+    REQUIRE(mgr.Vmm().isMapped(1 + 2));
+    REQUIRE_FALSE(mgr.Vmm().isMapped(1 + 0));
+
+    WeightManager::Stats stats = mgr.GetStats();
+    REQUIRE(stats.pinned_experts == 1);
+    REQUIRE(stats.expert_hits + stats.expert_misses == 8);
+
+    mgr.Shutdown();
+}
+
 TEST_CASE("ggml_backend_iowarp_buffer_type returns non-null", "[weights][unit]") {
     WeightManager::Config cfg;
     cfg.va_size_bytes = 4ULL * 1024 * 1024 * 1024;
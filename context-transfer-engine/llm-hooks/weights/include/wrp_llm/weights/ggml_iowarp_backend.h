@@ -65,6 +65,10 @@ ggml_backend_t ggml_backend_iowarp_init(
  * falls inside the WeightManager's GpuVmm virtual-address range, extracts the
  * layer index from the tensor name (pattern "blk.N." → layer N), and calls
  * WeightManager::RegisterLayer() with the corresponding page range.
+ * Mixture-of-experts tensors ("*_exps", experts stacked along ne[2]) are
+ * registered per expert with WeightManager::RegisterExpert(), and such
+ * layers register only their dense pages, so unselected experts are never
+ * mapped.
  *
  * @param weight_mgr  Initialised WeightManager (Init() must have been called).
  * @param ctx         The ggml_context that owns the model weight tensors.
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <wrp_cte/core/core_client.h>
+
+#include "wrp_llm/weights/weight_manager.h"
+
+// Forward-declare ggml_context so callers don't need to include ggml.h
+struct ggml_context;
+
+namespace wrp_llm {
+namespace weights {
+
+/**
+ * Cold-start loader for model weights placed in a WeightManager's VMM.
+ *
+ * The GGUF file is assimilated into a CTE tag once, as consecutive
+ * chunk_size blobs named "chunk_<i>" (the layout the CAE binary
+ * assimilator produces, so a tag written by either is reused).  Loading
+ * then fetches every tensor's file range with many AsyncGetBlobs in
+ * flight and copies it straight into the tensor's VMM pages, instead of
+ * llama.cpp reading the file sequentially.
+ *
+ * Load() returns once the tensors outside any layer (embeddings, output
+ * head) and the first eager_layers layers are on the GPU.  The remaining
+ * layers stream in lazily: a background thread stages them into pinned
+ * host memory in layer order, and the WeightManager's first PrepareLayer
+ * of a layer copies it onto the GPU, fetching it on the spot if the
+ * stream has not reached it yet.  After that first use, the layer pages
+ * like any other.
+ *
+ * Usage (in llama-model.cpp, after the weight tensors were allocated in
+ * the IOWarp buffer type and before load_all_data()):
+ *
+ *   wrp_llm::weights::TensorLoader loader(weight_mgr, gguf_path);
+ *   if (loader.Assimilate() && loader.Load(ctx)) {
+ *     // skip load_all_data() for the IOWarp buffer
+ *   }
+ *   ggml_backend_iowarp_auto_register_layers(weight_mgr, ctx);
+ *
+ * The loader must outlive inference, since it serves the lazy layers.
+ */
+class TensorLoader {
+ public:
+  struct Config {
+    /** CTE tag holding the GGUF chunks ("" = "gguf::" + file path). */
+    std::string tag_name;
+
+    /** Bytes per chunk blob (1 MB, the CAE binary assimilator default). */
+    size_t chunk_size = 1024 * 1024;
+
+    /** AsyncGetBlob / AsyncPutBlob requests kept in flight. */
+    size_t max_inflight = 64;
+
+    /** Layers loaded before Load() returns. */
+    size_t eager_layers = 2;
+
+    /** Lazy layers the background stream may hold in pinned host memory. */
+    size_t max_staged_layers = 4;
+  };
+
+  /** Loading counters; a snapshot is returned by GetStats(). */
+  struct Stats {
+    /** Bytes written to CTE by Assimilate() (0 when the tag was reused). */
+    uint64_t assimilated_bytes = 0;
+    /** Bytes loaded by Load() before it returned. */
+    uint64_t eager_bytes = 0;
+    /** Seconds Load() spent fetching the eager tensors. */
+    double eager_s = 0.0;
+    /** Lazy layers copied onto the GPU so far. */
+    size_t lazy_layers = 0;
+    /** Lazy layers that were already staged when first used. */
+    size_t staged_hits = 0;
+  };
+
+  TensorLoader(WeightManager* mgr, const std::string& gguf_path);
+  TensorLoader(WeightManager* mgr, const std::string& gguf_path,
+               const Config& cfg);
+  ~TensorLoader();
+
+  TensorLoader(const TensorLoader&) = delete;
+  TensorLoader& operator=(const TensorLoader&) = delete;
+
+  /**
+   * Copy the GGUF file into the CTE tag unless the tag already holds as
+   * many bytes as the file.  Requires an initialized CTE client.
+   * @return false if the file could not be read or a put failed
+   */
+  bool Assimilate();
+
+  /**
+   * Load the weight tensors of ctx that live in the VMM and are stored in
+   * the GGUF file: the eager ones now, the rest lazily.
+   * @param ctx The ggml_context that owns the model weight tensors
+   * @return false if the GGUF metadata could not be read or a fetch failed
+   */
+  bool Load(struct ggml_context* ctx);
+
+  /**
+   * Copy a lazy layer onto the GPU if it is not there yet.  Blocks until
+   * it is; installed as the WeightManager's layer filler by Load().
+   */
+  void FillLayer(int layer_idx);
+
+  /** Return true once layer_idx's weights are on the GPU. */
+  bool IsLayerLoaded(int layer_idx) const;
+
+  /** Snapshot of the loading counters. */
+  Stats GetStats() const;
+
+ private:
+  /** A tensor's bytes in the GGUF file and their VMM destination. */
+  struct TensorSpan {
+    char* dst;
+    uint64_t file_offset;
+    size_t size;
+  };
+
+  enum class LayerStatus { kPending, kStaging, kStaged, kLoaded };
+
+  struct LayerPlan {
+    std::vector<TensorSpan> spans;
+    size_t bytes = 0;
+    LayerStatus status = LayerStatus::kPending;
+    char* staged = nullptr;  // Pinned host copy of the spans, back to back
+  };
+
+  /** Group the file-backed VMM tensors of ctx by layer (-1 = no layer). */
+  bool PlanTensors(struct ggml_context* ctx);
+
+  /**
+   * Fetch spans from CTE with max_inflight gets in flight.  Bytes go to
+   * host_dst (spans back to back) if set, else to each span's VMM pages.
+   */
+  bool FetchSpans(const std::vector<TensorSpan>& spans, char* host_dst);
+
+  /** Map a span's pages so it can be written. */
+  void MapSpan(const TensorSpan& span);
+
+  /** Background thread staging lazy layers in ascending order. */
+  void StreamLoop();
+
+  /** Stop the stream thread and free staged buffers. */
+  void Stop();
+
+  WeightManager* mgr_;
+  std::string gguf_path_;
+  Config cfg_;
+  wrp_cte::core::TagId tag_id_ = wrp_cte::core::TagId::GetNull();
+
+  std::map<int, LayerPlan> layers_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::thread stream_;
+  bool stop_ = false;
+  size_t staged_count_ = 0;
+
+  Stats stats_;
+};
+
+}  // namespace weights
+}  // namespace wrp_llm
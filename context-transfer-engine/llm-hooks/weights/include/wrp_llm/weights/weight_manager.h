@@ -1,7 +1,10 @@
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -32,6 +35,20 @@ namespace weights {
  *   - Before each transformer layer, PrepareLayer(layer_idx) is called to
  *     guarantee all pages are mapped.
  *   - After each layer, ReleaseLayer(layer_idx) evicts pages back to host.
+ *
+ * Access-pattern awareness:
+ *   - The layer that follows each layer is learned from the PrepareLayer
+ *     call order, so prefetch follows the real execution order (including
+ *     the wrap from the last layer back to the first between tokens).
+ *   - Mixture-of-experts layers register each expert's pages separately
+ *     (RegisterExpert).  Only experts the router selected are mapped
+ *     (PrepareExperts); a decayed per-expert access frequency keeps the
+ *     hottest experts of each layer pinned on the GPU across releases and
+ *     picks the experts prefetched for upcoming layers.  Router-side
+ *     predictions can be fed in with PrefetchExperts.
+ *   - With adaptive_window, the number of layers prefetched ahead is sized
+ *     from the measured host→GPU bandwidth against the measured per-layer
+ *     compute time, so transfers stay just ahead of compute.
  */
 class WeightManager {
  public:
@@ -61,6 +78,43 @@ class WeightManager {
 
     /** CTE tag name used by GpuVmm when use_cte=true. */
     std::string cte_tag_name = "llama_weights";
+
+    /**
+     * Size the prefetch window from measured bandwidth and compute time
+     * (prefetch_window is used until both have been measured).
+     */
+    bool adaptive_window = true;
+
+    /** Upper bound on the adaptive prefetch window (layers). */
+    size_t max_prefetch_window = 8;
+
+    /** Most frequently used experts kept mapped per MoE layer. */
+    size_t pinned_experts_per_layer = 2;
+
+    /** Most frequently used experts prefetched for each upcoming layer. */
+    size_t expert_prefetch_count = 2;
+
+    /**
+     * Per-pass decay of expert access frequency (0-1).  Lower values make
+     * pinning follow recent routing more closely.
+     */
+    double expert_decay = 0.9;
+  };
+
+  /** Paging counters and estimates; a snapshot is returned by GetStats(). */
+  struct Stats {
+    /** Prefetch window currently in use (layers). */
+    size_t prefetch_window = 0;
+    /** Smoothed host→GPU bandwidth (bytes/s); 0 until measured. */
+    double transfer_bytes_per_s = 0.0;
+    /** Smoothed per-layer compute time (s); 0 until measured. */
+    double layer_compute_s = 0.0;
+    /** Experts currently pinned, over all layers. */
+    size_t pinned_experts = 0;
+    /** Selected experts that were already fully mapped. */
+    uint64_t expert_hits = 0;
+    /** Selected experts that had to be paged in synchronously. */
+    uint64_t expert_misses = 0;
   };
 
   WeightManager();
@@ -81,8 +135,10 @@ class WeightManager {
 
   /**
    * Register the page range for a model layer.
-   * Called once per layer during model loading, after all tensors for
-   * that layer have been placed at virtual addresses inside the Vmm.
+   * Called during model loading, after all tensors for that layer have
+   * been placed at virtual addresses inside the Vmm.  Calling it again for
+   * the same layer adds another range (e.g. dense tensors of a MoE layer
+   * that are interleaved with expert tensors).
    *
    * @param layer_idx   Zero-based transformer layer index.
    * @param page_start  First page index occupied by this layer's tensors.
@@ -91,16 +147,56 @@ class WeightManager {
   void RegisterLayer(int layer_idx, size_t page_start, size_t page_count);
 
   /**
-   * Ensure all pages for layer_idx are physically mapped on the GPU.
-   * Blocks until the pages are ready.
-   * Also kicks off async prefetch for the next `prefetch_window` layers.
+   * Register a page range holding one expert's weights in a MoE layer.
+   * May be called once per expert tensor (gate/up/down); ranges add up.
+   * Expert pages are not mapped by PrepareLayer (unless pinned): call
+   * PrepareExperts with the router's selection before the expert kernels.
+   *
+   * @param layer_idx   Zero-based transformer layer index.
+   * @param expert_idx  Expert index within the layer.
+   * @param page_start  First page of the range.
+   * @param page_count  Number of pages in the range.
+   */
+  void RegisterExpert(int layer_idx, int expert_idx, size_t page_start,
+                      size_t page_count);
+
+  /** Return true if any expert was registered for layer_idx. */
+  bool HasExperts(int layer_idx) const;
+
+  /** Expert ids registered for layer_idx, ascending. */
+  std::vector<int> Experts(int layer_idx) const;
+
+  /**
+   * Ensure all dense (and pinned expert) pages for layer_idx are
+   * physically mapped on the GPU.  Blocks until the pages are ready.
+   * Also kicks off async prefetch for the predicted next layers (dense
+   * pages plus their most frequently used experts).
    *
    * Call this just before llama.cpp's graph executor computes layer_idx.
    */
   void PrepareLayer(int layer_idx);
 
+  /**
+   * Map the experts the router selected for layer_idx, blocking until
+   * they are ready, and record the accesses.  Unknown ids are ignored.
+   */
+  void PrepareExperts(int layer_idx, const std::vector<int>& experts);
+
+  /**
+   * Start async page-in of experts predicted for an upcoming layer.
+   * Non-blocking; pair with WaitTransfers() before they are used.
+   */
+  void PrefetchExperts(int layer_idx, const std::vector<int>& experts);
+
+  /**
+   * Wait for all queued async page-ins (GpuVmm::syncTransfer) and feed
+   * the wait into the bandwidth / compute estimates.
+   */
+  void WaitTransfers();
+
   /**
    * Evict layer_idx's pages back to host (or CTE if use_cte=true).
+   * Pages of the layer's pinned experts stay mapped.
    * Non-blocking: launches async D2H transfers and returns immediately.
    *
    * Call this after the layer's computation is complete.
@@ -122,17 +218,87 @@ class WeightManager {
   /** GpuVmm instance (direct access for the ggml backend). */
   wrp_cte::uvm::GpuVirtualMemoryManager& Vmm();
 
+  /** Return true if expert_idx of layer_idx is currently pinned. */
+  bool IsExpertPinned(int layer_idx, int expert_idx) const;
+
+  /** Snapshot of the paging counters and estimates. */
+  Stats GetStats() const;
+
+  /** Loads a layer's weights into its pages (see SetLayerFiller). */
+  using LayerFiller = std::function<void(int layer_idx)>;
+
+  /**
+   * Install a callback that fills a layer's pages on its first
+   * PrepareLayer, for weights that stream in after the model is
+   * registered (TensorLoader).  Layers are not prefetched until they have
+   * been filled.  Pass nullptr to remove it.
+   */
+  void SetLayerFiller(LayerFiller filler);
+
  private:
-  struct LayerRange {
-    int layer_idx;
+  using Clock = std::chrono::steady_clock;
+
+  struct PageRange {
     size_t page_start;
     size_t page_count;
   };
 
+  struct ExpertState {
+    std::vector<PageRange> ranges;
+    double score = 0.0;      // decayed access count as of stamp
+    uint64_t stamp = 0;      // layer pass the score was last updated at
+    bool pinned = false;
+  };
+
+  struct LayerState {
+    std::vector<PageRange> ranges;         // dense pages
+    std::map<int, ExpertState> experts;    // expert_idx -> state
+    uint64_t passes = 0;                   // PrepareLayer count
+    int successor = -1;                    // learned next layer, -1 unknown
+    bool filled = false;                   // filler_ has loaded its weights
+  };
+
+  /** Expert score decayed to the layer's current pass. */
+  double ExpertScore(const LayerState& layer, const ExpertState& e) const;
+  /** Expert ids of layer ordered by descending decayed score. */
+  std::vector<int> RankExperts(const LayerState& layer) const;
+  /** Re-pick the pinned experts of layer after new accesses. */
+  void RepinExperts(LayerState& layer);
+  /** Predicted layer to run after layer_idx, or -1. */
+  int NextLayer(int layer_idx) const;
+  /** Layers to prefetch ahead, from the bandwidth/compute model. */
+  size_t CurrentWindow();
+  /** Synchronously map ranges; returns true if every page was mapped. */
+  bool MapRanges(const std::vector<PageRange>& ranges);
+  /** Queue async page-in of ranges. */
+  void PrefetchRanges(const std::vector<PageRange>& ranges);
+  /** Fold a sample into an exponential moving average. */
+  static void Smooth(double& avg, double sample);
+  /** Run filler_ for a layer that was not filled yet. */
+  void FillLayer(int layer_idx, LayerState& layer);
+  /** False while filler_ has yet to load the layer. */
+  bool IsFilled(const LayerState& layer) const;
+
   Config cfg_;
   wrp_cte::uvm::GpuVirtualMemoryManager vmm_;
-  std::vector<LayerRange> layer_ranges_;
+  std::map<int, LayerState> layers_;
+  LayerFiller filler_;
   bool ready_ = false;
+
+  // Online estimates.
+  size_t window_ = 0;                 // last computed prefetch window
+  double avg_layer_bytes_ = 0.0;      // bytes prefetched per layer
+  bool layer_bytes_dirty_ = true;     // registrations changed
+  double transfer_bps_ = 0.0;
+  double layer_compute_s_ = 0.0;
+  size_t bytes_in_flight_ = 0;        // queued since the last WaitTransfers
+  Clock::time_point first_issue_;     // when bytes_in_flight_ became > 0
+  Clock::time_point last_prepare_;
+  double stall_s_ = 0.0;              // blocking time since last_prepare_
+  int last_layer_ = -1;
+
+  uint64_t expert_hits_ = 0;
+  uint64_t expert_misses_ = 0;
 };
 
 }  // namespace weights
@@ -9,8 +9,10 @@
 
 #include "ggml-impl.h"  // full ggml_cgraph struct for sub-graph views
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <map>
@@ -404,15 +406,69 @@ static void iowarp_be_synchronize(ggml_backend_t be) {
     ggml_backend_synchronize(ctx->cuda_be);
 }
 
+// Execute nodes [s, e) of gf as a CUDA sub-graph view.
+static enum ggml_status iowarp_execute_nodes(IOWarpCtx* ctx,
+                                             struct ggml_cgraph* gf,
+                                             int s, int e) {
+    if (s >= e) return GGML_STATUS_SUCCESS;
+    struct ggml_cgraph sub = *gf;
+    sub.nodes   = ggml_graph_nodes(gf) + s;
+    sub.n_nodes = e - s;
+    sub.n_leafs = 0;
+    return ggml_backend_graph_compute(ctx->cuda_be, &sub);
+}
+
+// Execute a MoE layer's nodes [seg_s, seg_e) with demand-paged experts.
+//
+// llama.cpp names the router's top-k expert ids "ffn_moe_topk-L".  The layer
+// runs up to and including that node, the ids are read back, only the
+// selected experts are mapped (WeightManager::PrepareExperts), and the rest
+// of the layer runs.  If the node is missing (other graph builders), every
+// expert is mapped before the whole layer runs.
+static enum ggml_status iowarp_execute_moe_layer(
+        IOWarpCtx* ctx, wrp_llm::weights::WeightManager* mgr,
+        struct ggml_cgraph* gf, int layer, int seg_s, int seg_e) {
+    char topk_name[32];
+    snprintf(topk_name, sizeof(topk_name), "ffn_moe_topk-%d", layer);
+    int topk_idx = -1;
+    for (int i = seg_s; i < seg_e; ++i) {
+        const char* name = ggml_get_name(ggml_graph_node(gf, i));
+        if (name && strcmp(name, topk_name) == 0) {
+            topk_idx = i;
+            break;
+        }
+    }
+
+    if (topk_idx < 0 ||
+        ggml_graph_node(gf, topk_idx)->type != GGML_TYPE_I32) {
+        mgr->PrepareExperts(layer, mgr->Experts(layer));
+        return iowarp_execute_nodes(ctx, gf, seg_s, seg_e);
+    }
+
+    enum ggml_status st = iowarp_execute_nodes(ctx, gf, seg_s, topk_idx + 1);
+    if (st != GGML_STATUS_SUCCESS) return st;
+    ggml_backend_synchronize(ctx->cuda_be);
+
+    struct ggml_tensor* topk = ggml_graph_node(gf, topk_idx);
+    std::vector<int32_t> ids(ggml_nelements(topk));
+    cudaMemcpy(ids.data(), topk->data, ids.size() * sizeof(int32_t),
+               cudaMemcpyDeviceToHost);
+    mgr->PrepareExperts(layer, std::vector<int>(ids.begin(), ids.end()));
+
+    return iowarp_execute_nodes(ctx, gf, topk_idx + 1, seg_e);
+}
+
 // Full FlexGen graph compute: weight paging + activation lifecycle.
 //
 // Weight paging (double-buffering pipeline with deferred release):
-//   Before loop: PrepareLayer(0) + syncTransfer() — prime pipeline.
+//   Before loop: PrepareLayer(0) + WaitTransfers() — prime pipeline.
 //   Per layer L (iteration i):
-//     1. execute_range(L)       — queue CUDA kernels [async]
+//     1. execute_range(L)       — queue CUDA kernels [async]; MoE layers run
+//                                 up to the router, map the selected experts
+//                                 (PrepareExperts), then run the rest
 //     2. PrepareLayer(L+1)      — H2D next-layer weights [overlaps step 1]
 //     3. synchronize(cuda_be)   — wait for L's kernels
-//     4. syncTransfer()         — wait for L+1's H2D
+//     4. WaitTransfers()        — wait for L+1's H2D
 //     5. ReleaseLayer(L-1)      — deferred async D2H evict for PREVIOUS layer
 //                                 [overlaps L+1 compute in next iteration]
 //   After loop: ReleaseLayer(last).
@@ -528,7 +584,7 @@ static enum ggml_status iowarp_be_graph_compute(ggml_backend_t be,
 
     // Prime the pipeline: map layer 0's pages before the loop starts.
     mgr->PrepareLayer(layers[0]);
-    mgr->Vmm().syncTransfer();  // wait until layer 0's pages are on-GPU
+    mgr->WaitTransfers();  // wait until layer 0's pages are on-GPU
 
     // -----------------------------------------------------------------------
     // Per-layer FlexGen loop: weight paging + activation lifecycle.
@@ -561,7 +617,10 @@ static enum ggml_status iowarp_be_graph_compute(ggml_backend_t be,
         // --- Step 1: Queue this layer's CUDA kernels (async) ---
         // Weight pages already mapped from PrepareLayer (primed or from prev iter).
         // Reads l_out-{L-1} from orig_data (restored in Step 0 if is_saved).
-        enum ggml_status st = execute_range(seg_s, seg_e);
+        enum ggml_status st = mgr->HasExperts(layer)
+                                  ? iowarp_execute_moe_layer(ctx, mgr, gf, layer,
+                                                             seg_s, seg_e)
+                                  : execute_range(seg_s, seg_e);
 
         // --- Step 2: Prefetch next layer's weights (overlaps with step 1) ---
         if (i + 1 < layers.size()) {
@@ -574,7 +633,7 @@ static enum ggml_status iowarp_be_graph_compute(ggml_backend_t be,
 
         // --- Step 4: Wait for next layer's weight H2D ---
         if (i + 1 < layers.size()) {
-            mgr->Vmm().syncTransfer();
+            mgr->WaitTransfers();
         }
 
         // --- Activation Step 4b: D2H save l_out-{L} ---
@@ -850,6 +909,10 @@ void ggml_backend_iowarp_auto_register_layers(
 
     // layer_idx → { min_page, max_page }  (exclusive upper bound)
     std::map<int, std::pair<size_t, size_t>> layer_pages;
+    // MoE layers: dense tensor page ranges (merged below) and per-expert
+    // slices of the "*_exps" tensors, which stack experts along ne[2].
+    std::map<int, std::vector<std::pair<size_t, size_t>>> dense_pages;
+    std::map<int, size_t> expert_count;
 
     for (struct ggml_tensor* t = ggml_get_first_tensor(ctx);
             t != nullptr;
@@ -859,7 +922,8 @@ void ggml_backend_iowarp_auto_register_layers(
         const char* p = static_cast<const char*>(t->data);
         if (p < base || p >= base + total) continue;  // not in our VMM
 
-        int layer = iowarp_extract_layer(ggml_get_name(t));
+        const char* name = ggml_get_name(t);
+        int layer = iowarp_extract_layer(name);
         if (layer < 0) continue;
 
         size_t offset = static_cast<size_t>(p - base);
@@ -867,6 +931,19 @@ void ggml_backend_iowarp_auto_register_layers(
         size_t p0     = offset / psz;
         size_t p1     = (offset + sz + psz - 1) / psz;
 
+        if (strstr(name, "_exps") && t->ne[2] > 1) {
+            for (int64_t e = 0; e < t->ne[2]; ++e) {
+                size_t e0 = offset + static_cast<size_t>(e) * t->nb[2];
+                size_t q0 = e0 / psz;
+                size_t q1 = (e0 + t->nb[2] + psz - 1) / psz;
+                mgr->RegisterExpert(layer, static_cast<int>(e), q0, q1 - q0);
+            }
+            expert_count[layer] = std::max(expert_count[layer],
+                                           static_cast<size_t>(t->ne[2]));
+        } else {
+            dense_pages[layer].push_back({p0, p1});
+        }
+
         auto& r = layer_pages[layer];
         if (r.first == 0 && r.second == 0) {
             r = {p0, p1};
@@ -878,11 +955,34 @@ void ggml_backend_iowarp_auto_register_layers(
 
     for (auto& [layer, r] : layer_pages) {
         size_t page_count = r.second - r.first;
-        mgr->RegisterLayer(layer, r.first, page_count);
+        auto experts = expert_count.find(layer);
+        if (experts == expert_count.end()) {
+            mgr->RegisterLayer(layer, r.first, page_count);
+            fprintf(stderr,
+                    "IOWarp weights: layer %3d -> pages [%zu, %zu)  %.1f MiB\n",
+                    layer, r.first, r.second,
+                    page_count * psz / (1024.0 * 1024.0));
+            continue;
+        }
+
+        // Register only the dense pages so unselected experts stay unmapped.
+        auto& ranges = dense_pages[layer];
+        std::sort(ranges.begin(), ranges.end());
+        size_t dense = 0;
+        for (size_t k = 0; k < ranges.size();) {
+            size_t s0 = ranges[k].first, s1 = ranges[k].second;
+            for (++k; k < ranges.size() && ranges[k].first <= s1; ++k) {
+                s1 = std::max(s1, ranges[k].second);
+            }
+            mgr->RegisterLayer(layer, s0, s1 - s0);
+            dense += s1 - s0;
+        }
         fprintf(stderr,
-                "IOWarp weights: layer %3d -> pages [%zu, %zu)  %.1f MiB\n",
+                "IOWarp weights: layer %3d -> pages [%zu, %zu)  %.1f MiB "
+                "(%zu experts, %.1f MiB dense)\n",
                 layer, r.first, r.second,
-                page_count * psz / (1024.0 * 1024.0));
+                page_count * psz / (1024.0 * 1024.0), experts->second,
+                dense * psz / (1024.0 * 1024.0));
     }
 
     fprintf(stderr,
@@ -0,0 +1,415 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "wrp_llm/weights/tensor_loader.h"
+
+// Public ggml tensor and GGUF metadata API (part of llama.cpp)
+#include "ggml.h"
+#include "gguf.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+
+namespace wrp_llm {
+namespace weights {
+
+using Clock = std::chrono::steady_clock;
+
+// Layer index of a "blk.N." tensor name, -1 for tensors outside the layers.
+static int ExtractLayer(const char* name) {
+  if (!name) return -1;
+  const char* blk = strstr(name, "blk.");
+  if (!blk) return -1;
+  int layer = atoi(blk + 4);
+  return layer >= 0 ? layer : -1;
+}
+
+static std::string ChunkName(uint64_t chunk_idx) {
+  return "chunk_" + std::to_string(chunk_idx);
+}
+
+TensorLoader::TensorLoader(WeightManager* mgr, const std::string& gguf_path)
+    : TensorLoader(mgr, gguf_path, Config{}) {}
+
+TensorLoader::TensorLoader(WeightManager* mgr, const std::string& gguf_path,
+                           const Config& cfg)
+    : mgr_(mgr), gguf_path_(gguf_path), cfg_(cfg) {
+  if (cfg_.tag_name.empty()) cfg_.tag_name = "gguf::" + gguf_path_;
+  cfg_.chunk_size = std::max<size_t>(cfg_.chunk_size, 1);
+  cfg_.max_inflight = std::max<size_t>(cfg_.max_inflight, 1);
+}
+
+TensorLoader::~TensorLoader() {
+  if (mgr_) mgr_->SetLayerFiller(nullptr);
+  Stop();
+}
+
+bool TensorLoader::Assimilate() {
+  auto* cte_client = WRP_CTE_CLIENT;
+  auto* ipc_manager = CHI_IPC;
+
+  auto tag_task = cte_client->AsyncGetOrCreateTag(cfg_.tag_name);
+  tag_task.Wait();
+  tag_id_ = tag_task->tag_id_;
+  if (tag_id_.IsNull()) {
+    fprintf(stderr, "IOWarp loader: failed to open tag %s\n",
+            cfg_.tag_name.c_str());
+    return false;
+  }
+
+  std::ifstream file(gguf_path_, std::ios::binary | std::ios::ate);
+  if (!file) {
+    fprintf(stderr, "IOWarp loader: cannot open %s\n", gguf_path_.c_str());
+    return false;
+  }
+  uint64_t file_size = static_cast<uint64_t>(file.tellg());
+  file.seekg(0);
+
+  // A tag holding the whole file was assimilated before (by us or CAE).
+  auto size_task = cte_client->AsyncGetTagSize(tag_id_);
+  size_task.Wait();
+  if (size_task->tag_size_ == file_size) {
+    fprintf(stderr, "IOWarp loader: reusing %s (%.1f MiB already in CTE)\n",
+            cfg_.tag_name.c_str(), file_size / (1024.0 * 1024.0));
+    return true;
+  }
+
+  struct Put {
+    hipc::FullPtr<char> buffer;
+    chi::Future<wrp_cte::core::PutBlobTask> task;
+  };
+  std::deque<Put> inflight;
+  bool ok = true;
+  auto retire = [&]() {
+    Put& put = inflight.front();
+    put.task.Wait();
+    if (put.task->GetReturnCode() != 0) ok = false;
+    ipc_manager->FreeBuffer(put.buffer);
+    inflight.pop_front();
+  };
+
+  uint64_t chunk_idx = 0;
+  for (uint64_t off = 0; ok && off < file_size; off += cfg_.chunk_size) {
+    size_t len = static_cast<size_t>(
+        std::min<uint64_t>(cfg_.chunk_size, file_size - off));
+    hipc::FullPtr<char> buffer = ipc_manager->AllocateBuffer(len);
+    if (buffer.IsNull()) {
+      ok = false;
+      break;
+    }
+    if (!file.read(buffer.ptr_, len)) {
+      ipc_manager->FreeBuffer(buffer);
+      ok = false;
+      break;
+    }
+    if (inflight.size() >= cfg_.max_inflight) retire();
+    inflight.push_back(
+        {buffer, cte_client->AsyncPutBlob(
+                     tag_id_, ChunkName(chunk_idx++), 0, len,
+                     hipc::ShmPtr<>(buffer.shm_), 1.0f)});
+    stats_.assimilated_bytes += len;
+  }
+  while (!inflight.empty()) retire();
+
+  if (!ok) {
+    fprintf(stderr, "IOWarp loader: assimilating %s into %s failed\n",
+            gguf_path_.c_str(), cfg_.tag_name.c_str());
+    return false;
+  }
+  fprintf(stderr, "IOWarp loader: assimilated %s (%.1f MiB, %llu chunks)\n",
+          gguf_path_.c_str(), file_size / (1024.0 * 1024.0),
+          static_cast<unsigned long long>(chunk_idx));
+  return true;
+}
+
+bool TensorLoader::Load(struct ggml_context* ctx) {
+  if (!mgr_ || !mgr_->IsReady() || !ctx || tag_id_.IsNull()) return false;
+  Stop();
+  if (!PlanTensors(ctx)) return false;
+
+  // Tensors outside the layers (key -1, first in the map) and the first
+  // eager_layers layers, all fetched in one batch for the most parallelism.
+  Clock::time_point start = Clock::now();
+  std::vector<TensorSpan> eager;
+  size_t eager_layers = 0;
+  uint64_t eager_bytes = 0;
+  for (auto& [layer, plan] : layers_) {
+    if (layer >= 0 && eager_layers++ >= cfg_.eager_layers) break;
+    eager.insert(eager.end(), plan.spans.begin(), plan.spans.end());
+    eager_bytes += plan.bytes;
+    plan.status = LayerStatus::kLoaded;
+  }
+  if (!FetchSpans(eager, nullptr)) {
+    fprintf(stderr, "IOWarp loader: fetching the eager tensors failed\n");
+    return false;
+  }
+  double eager_s = std::chrono::duration<double>(Clock::now() - start).count();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.eager_bytes = eager_bytes;
+    stats_.eager_s = eager_s;
+  }
+  size_t lazy = 0;
+  for (const auto& [layer, plan] : layers_) {
+    if (plan.status != LayerStatus::kLoaded) ++lazy;
+  }
+  fprintf(stderr,
+          "IOWarp loader: %.1f MiB eager in %.2f s, %zu layers stream lazily\n",
+          eager_bytes / (1024.0 * 1024.0), eager_s, lazy);
+
+  mgr_->SetLayerFiller([this](int layer_idx) { FillLayer(layer_idx); });
+  if (cfg_.max_staged_layers > 0) {
+    stop_ = false;
+    stream_ = std::thread(&TensorLoader::StreamLoop, this);
+  }
+  return true;
+}
+
+void TensorLoader::FillLayer(int layer_idx) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto it = layers_.find(layer_idx);
+  if (it == layers_.end()) return;
+  LayerPlan& plan = it->second;
+  cv_.wait(lock, [&] { return plan.status != LayerStatus::kStaging; });
+  if (plan.status == LayerStatus::kLoaded) return;
+
+  if (plan.status == LayerStatus::kStaged) {
+    // Only the pinned host -> GPU copy is left on the critical path.
+    char* staged = plan.staged;
+    plan.staged = nullptr;
+    lock.unlock();
+    size_t off = 0;
+    for (const TensorSpan& span : plan.spans) {
+      MapSpan(span);
+      cudaMemcpy(span.dst, staged + off, span.size, cudaMemcpyHostToDevice);
+      off += span.size;
+    }
+    cudaFreeHost(staged);
+    lock.lock();
+    --staged_count_;
+    ++stats_.staged_hits;
+  } else {
+    // The stream has not reached this layer: fetch it straight to the GPU.
+    plan.status = LayerStatus::kStaging;
+    lock.unlock();
+    if (!FetchSpans(plan.spans, nullptr)) {
+      fprintf(stderr, "IOWarp loader: fetching layer %d failed\n", layer_idx);
+    }
+    lock.lock();
+  }
+  plan.status = LayerStatus::kLoaded;
+  ++stats_.lazy_layers;
+  cv_.notify_all();
+}
+
+bool TensorLoader::IsLayerLoaded(int layer_idx) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = layers_.find(layer_idx);
+  return it != layers_.end() && it->second.status == LayerStatus::kLoaded;
+}
+
+TensorLoader::Stats TensorLoader::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+bool TensorLoader::PlanTensors(struct ggml_context* ctx) {
+  struct gguf_init_params params = {/*.no_alloc =*/true, /*.ctx =*/nullptr};
+  struct gguf_context* gguf = gguf_init_from_file(gguf_path_.c_str(), params);
+  if (!gguf) {
+    fprintf(stderr, "IOWarp loader: cannot read GGUF metadata of %s\n",
+            gguf_path_.c_str());
+    return false;
+  }
+  uint64_t data_offset = gguf_get_data_offset(gguf);
+
+  auto& vmm = mgr_->Vmm();
+  char* base = reinterpret_cast<char*>(vmm.getBasePtr());
+  size_t total = vmm.getPageSize() * vmm.getTotalPages();
+
+  layers_.clear();
+  for (struct ggml_tensor* t = ggml_get_first_tensor(ctx); t != nullptr;
+       t = ggml_get_next_tensor(ctx, t)) {
+    char* p = static_cast<char*>(t->data);
+    if (!p || p < base || p >= base + total) continue;  // not in our VMM
+    const char* name = ggml_get_name(t);
+    int64_t id = gguf_find_tensor(gguf, name);
+    if (id < 0) continue;  // not stored in the file
+    LayerPlan& plan = layers_[ExtractLayer(name)];
+    plan.spans.push_back(
+        {p, data_offset + gguf_get_tensor_offset(gguf, id), ggml_nbytes(t)});
+    plan.bytes += ggml_nbytes(t);
+  }
+  gguf_free(gguf);
+
+  // File order keeps consecutive gets on the same chunk blobs.
+  for (auto& [layer, plan] : layers_) {
+    std::sort(plan.spans.begin(), plan.spans.end(),
+              [](const TensorSpan& a, const TensorSpan& b) {
+                return a.file_offset < b.file_offset;
+              });
+  }
+  return true;
+}
+
+bool TensorLoader::FetchSpans(const std::vector<TensorSpan>& spans,
+                              char* host_dst) {
+  auto* cte_client = WRP_CTE_CLIENT;
+  auto* ipc_manager = CHI_IPC;
+
+  struct Get {
+    hipc::FullPtr<char> buffer;
+    char* dst;
+    size_t size;
+    chi::Future<wrp_cte::core::GetBlobTask> task;
+  };
+  std::deque<Get> inflight;
+  bool ok = true;
+  auto retire = [&]() {
+    Get& get = inflight.front();
+    get.task.Wait();
+    if (get.task->GetReturnCode() != 0) {
+      ok = false;
+    } else if (host_dst) {
+      memcpy(get.dst, get.buffer.ptr_, get.size);
+    } else {
+      cudaMemcpy(get.dst, get.buffer.ptr_, get.size, cudaMemcpyHostToDevice);
+    }
+    ipc_manager->FreeBuffer(get.buffer);
+    inflight.pop_front();
+  };
+
+  // Each span is split at chunk boundaries; every piece is one ranged get.
+  char* host_next = host_dst;
+  for (const TensorSpan& span : spans) {
+    if (!ok) break;
+    if (!host_dst) MapSpan(span);
+    char* dst = host_dst ? host_next : span.dst;
+    uint64_t off = span.file_offset;
+    size_t left = span.size;
+    while (ok && left > 0) {
+      uint64_t in_chunk = off % cfg_.chunk_size;
+      size_t len = static_cast<size_t>(
+          std::min<uint64_t>(left, cfg_.chunk_size - in_chunk));
+      hipc::FullPtr<char> buffer = ipc_manager->AllocateBuffer(len);
+      if (buffer.IsNull()) {
+        ok = false;
+        break;
+      }
+      if (inflight.size() >= cfg_.max_inflight) retire();
+      inflight.push_back(
+          {buffer, dst, len,
+           cte_client->AsyncGetBlob(tag_id_, ChunkName(off / cfg_.chunk_size),
+                                    in_chunk, len, 0,
+                                    hipc::ShmPtr<>(buffer.shm_))});
+      dst += len;
+      off += len;
+      left -= len;
+    }
+    host_next += host_dst ? span.size : 0;
+  }
+  while (!inflight.empty()) retire();
+  return ok;
+}
+
+void TensorLoader::MapSpan(const TensorSpan& span) {
+  auto& vmm = mgr_->Vmm();
+  size_t psz = vmm.getPageSize();
+  size_t offset = static_cast<size_t>(
+      span.dst - reinterpret_cast<char*>(vmm.getBasePtr()));
+  size_t p0 = offset / psz;
+  size_t p1 = (offset + span.size + psz - 1) / psz;
+  vmm.touchPages(p0, p1 - p0);
+}
+
+void TensorLoader::StreamLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (auto& [layer, plan] : layers_) {
+    cv_.wait(lock, [&] {
+      return stop_ || plan.status != LayerStatus::kPending ||
+             staged_count_ < cfg_.max_staged_layers;
+    });
+    if (stop_) return;
+    if (plan.status != LayerStatus::kPending) continue;
+
+    char* host = nullptr;
+    if (cudaMallocHost(reinterpret_cast<void**>(&host), plan.bytes) !=
+        cudaSuccess) {
+      // Later layers are fetched on their first use instead.
+      fprintf(stderr, "IOWarp loader: cudaMallocHost failed for layer %d\n",
+              layer);
+      return;
+    }
+    plan.status = LayerStatus::kStaging;
+    ++staged_count_;
+    lock.unlock();
+    bool ok = FetchSpans(plan.spans, host);
+    lock.lock();
+    if (ok) {
+      plan.staged = host;
+      plan.status = LayerStatus::kStaged;
+    } else {
+      fprintf(stderr, "IOWarp loader: staging layer %d failed\n", layer);
+      cudaFreeHost(host);
+      plan.status = LayerStatus::kPending;
+      --staged_count_;
+    }
+    cv_.notify_all();
+  }
+}
+
+void TensorLoader::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  if (stream_.joinable()) stream_.join();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& [layer, plan] : layers_) {
+    if (!plan.staged) continue;
+    cudaFreeHost(plan.staged);
+    plan.staged = nullptr;
+    plan.status = LayerStatus::kPending;
+  }
+  staged_count_ = 0;
+}
+
+}  // namespace weights
+}  // namespace wrp_llm
@@ -1,14 +1,24 @@
 #include "wrp_llm/weights/weight_manager.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstdio>
+#include <unordered_set>
+#include <utility>
 
 namespace wrp_llm {
 namespace weights {
 
-WeightManager::WeightManager() : cfg_(Config{}) {}
+// Weight of a new sample in the bandwidth / compute moving averages.
+static constexpr double kSmoothing = 0.2;
 
-WeightManager::WeightManager(const Config& cfg) : cfg_(cfg) {}
+WeightManager::WeightManager() : cfg_(Config{}) {
+  window_ = cfg_.prefetch_window;
+}
+
+WeightManager::WeightManager(const Config& cfg) : cfg_(cfg) {
+  window_ = cfg_.prefetch_window;
+}
 
 WeightManager::~WeightManager() { Shutdown(); }
 
@@ -37,42 +47,172 @@ void WeightManager::Shutdown() {
 void WeightManager::RegisterLayer(int layer_idx,
                                    size_t page_start,
                                    size_t page_count) {
-  layer_ranges_.push_back({layer_idx, page_start, page_count});
+  layers_[layer_idx].ranges.push_back({page_start, page_count});
+  layer_bytes_dirty_ = true;
+}
+
+void WeightManager::RegisterExpert(int layer_idx, int expert_idx,
+                                    size_t page_start, size_t page_count) {
+  layers_[layer_idx].experts[expert_idx].ranges.push_back(
+      {page_start, page_count});
+  layer_bytes_dirty_ = true;
+}
+
+bool WeightManager::HasExperts(int layer_idx) const {
+  auto it = layers_.find(layer_idx);
+  return it != layers_.end() && !it->second.experts.empty();
+}
+
+std::vector<int> WeightManager::Experts(int layer_idx) const {
+  std::vector<int> ids;
+  auto it = layers_.find(layer_idx);
+  if (it == layers_.end()) return ids;
+  for (const auto& [id, expert] : it->second.experts) ids.push_back(id);
+  return ids;
 }
 
 void WeightManager::PrepareLayer(int layer_idx) {
   if (!ready_) return;
 
-  // Touch all pages for this layer synchronously.
-  for (auto& lr : layer_ranges_) {
-    if (lr.layer_idx != layer_idx) continue;
-    for (size_t p = lr.page_start; p < lr.page_start + lr.page_count; ++p) {
-      vmm_.touchPage(p);
+  // Learn the execution order and time the previous layer.  Backward
+  // transitions (next token) include sampling and host work, so they only
+  // teach the successor.
+  Clock::time_point now = Clock::now();
+  auto prev = layers_.find(last_layer_);
+  if (prev != layers_.end()) {
+    prev->second.successor = layer_idx;
+    if (layer_idx > last_layer_) {
+      double step =
+          std::chrono::duration<double>(now - last_prepare_).count() - stall_s_;
+      if (step > 0.0) Smooth(layer_compute_s_, step);
     }
-    break;
   }
+  last_layer_ = layer_idx;
+  last_prepare_ = now;
+  stall_s_ = 0.0;
 
-  // Kick off async prefetch for the next prefetch_window layers.
-  for (size_t w = 1; w <= cfg_.prefetch_window; ++w) {
-    int next = layer_idx + static_cast<int>(w);
-    for (auto& lr : layer_ranges_) {
-      if (lr.layer_idx != next) continue;
-      for (size_t p = lr.page_start; p < lr.page_start + lr.page_count; ++p) {
-        vmm_.touchPageAsync(p);
-      }
-      break;
+  auto it = layers_.find(layer_idx);
+  if (it == layers_.end()) return;
+  LayerState& layer = it->second;
+  ++layer.passes;
+  FillLayer(layer_idx, layer);
+
+  // Dense weights and pinned experts must be resident for this layer.
+  MapRanges(layer.ranges);
+  for (auto& [id, expert] : layer.experts) {
+    if (expert.pinned) MapRanges(expert.ranges);
+  }
+
+  // Kick off async prefetch along the predicted layer order.
+  size_t window = CurrentWindow();
+  int next = layer_idx;
+  for (size_t w = 0; w < window; ++w) {
+    next = NextLayer(next);
+    if (next < 0 || next == layer_idx) break;
+    LayerState& ahead = layers_[next];
+    // An unfilled layer's pages hold no weights yet; it loads on first use.
+    if (!IsFilled(ahead)) continue;
+    PrefetchRanges(ahead.ranges);
+    std::vector<int> hot = RankExperts(ahead);
+    if (hot.size() > cfg_.expert_prefetch_count) {
+      hot.resize(cfg_.expert_prefetch_count);
+    }
+    for (int id : hot) PrefetchRanges(ahead.experts[id].ranges);
+  }
+}
+
+void WeightManager::PrepareExperts(int layer_idx,
+                                    const std::vector<int>& experts) {
+  if (!ready_) return;
+  auto it = layers_.find(layer_idx);
+  if (it == layers_.end()) return;
+  LayerState& layer = it->second;
+  FillLayer(layer_idx, layer);
+
+  std::vector<int> ids(experts);
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  for (int id : ids) {
+    auto e = layer.experts.find(id);
+    if (e == layer.experts.end()) continue;
+    e->second.score = ExpertScore(layer, e->second) + 1.0;
+    e->second.stamp = layer.passes;
+    if (MapRanges(e->second.ranges)) {
+      ++expert_hits_;
+    } else {
+      ++expert_misses_;
     }
   }
+  RepinExperts(layer);
+
+  // Experts paged in by an earlier prefetch may still be in flight.
+  if (bytes_in_flight_ > 0) WaitTransfers();
+}
+
+void WeightManager::PrefetchExperts(int layer_idx,
+                                     const std::vector<int>& experts) {
+  if (!ready_) return;
+  auto it = layers_.find(layer_idx);
+  if (it == layers_.end() || !IsFilled(it->second)) return;
+  for (int id : experts) {
+    auto e = it->second.experts.find(id);
+    if (e != it->second.experts.end()) PrefetchRanges(e->second.ranges);
+  }
+}
+
+void WeightManager::WaitTransfers() {
+  if (!ready_) return;
+  Clock::time_point start = Clock::now();
+  vmm_.syncTransfer();
+  Clock::time_point end = Clock::now();
+  stall_s_ += std::chrono::duration<double>(end - start).count();
+
+  // Bytes queued since first_issue_ are on the GPU now: a lower bound on
+  // the bandwidth, since the copies may have finished before we waited.
+  if (bytes_in_flight_ > 0) {
+    double elapsed = std::chrono::duration<double>(end - first_issue_).count();
+    if (elapsed > 0.0) Smooth(transfer_bps_, bytes_in_flight_ / elapsed);
+    bytes_in_flight_ = 0;
+  }
 }
 
 void WeightManager::ReleaseLayer(int layer_idx) {
   if (!ready_) return;
-  for (auto& lr : layer_ranges_) {
-    if (lr.layer_idx != layer_idx) continue;
-    for (size_t p = lr.page_start; p < lr.page_start + lr.page_count; ++p) {
-      vmm_.evictPageAsync(p);
+  auto it = layers_.find(layer_idx);
+  if (it == layers_.end()) return;
+  LayerState& layer = it->second;
+
+  // Pinned experts may share boundary pages with dense tensors.
+  std::unordered_set<size_t> keep;
+  for (auto& [id, expert] : layer.experts) {
+    if (!expert.pinned) continue;
+    for (const PageRange& r : expert.ranges) {
+      for (size_t p = r.page_start; p < r.page_start + r.page_count; ++p) {
+        keep.insert(p);
+      }
+    }
+  }
+
+  // Evict each run of non-pinned pages with one batched call.
+  auto evict = [&](const std::vector<PageRange>& ranges) {
+    for (const PageRange& r : ranges) {
+      size_t end = r.page_start + r.page_count;
+      size_t p = r.page_start;
+      while (p < end) {
+        if (keep.count(p)) {
+          ++p;
+          continue;
+        }
+        size_t run_end = p + 1;
+        while (run_end < end && !keep.count(run_end)) ++run_end;
+        vmm_.evictPages(p, run_end - p);
+        p = run_end;
+      }
     }
-    break;
+  };
+  evict(layer.ranges);
+  for (auto& [id, expert] : layer.experts) {
+    if (!expert.pinned) evict(expert.ranges);
   }
 }
 
@@ -87,5 +227,166 @@ bool WeightManager::IsReady() const { return ready_; }
 
 wrp_cte::uvm::GpuVirtualMemoryManager& WeightManager::Vmm() { return vmm_; }
 
+bool WeightManager::IsExpertPinned(int layer_idx, int expert_idx) const {
+  auto it = layers_.find(layer_idx);
+  if (it == layers_.end()) return false;
+  auto e = it->second.experts.find(expert_idx);
+  return e != it->second.experts.end() && e->second.pinned;
+}
+
+void WeightManager::SetLayerFiller(LayerFiller filler) {
+  filler_ = std::move(filler);
+}
+
+WeightManager::Stats WeightManager::GetStats() const {
+  Stats stats;
+  stats.prefetch_window = window_;
+  stats.transfer_bytes_per_s = transfer_bps_;
+  stats.layer_compute_s = layer_compute_s_;
+  for (const auto& [idx, layer] : layers_) {
+    for (const auto& [id, expert] : layer.experts) {
+      if (expert.pinned) ++stats.pinned_experts;
+    }
+  }
+  stats.expert_hits = expert_hits_;
+  stats.expert_misses = expert_misses_;
+  return stats;
+}
+
+// ---------------------------------------------------------------------------
+// Access-pattern model
+// ---------------------------------------------------------------------------
+
+double WeightManager::ExpertScore(const LayerState& layer,
+                                  const ExpertState& e) const {
+  return e.score *
+         std::pow(cfg_.expert_decay, static_cast<double>(layer.passes - e.stamp));
+}
+
+std::vector<int> WeightManager::RankExperts(const LayerState& layer) const {
+  std::vector<std::pair<double, int>> scored;
+  for (const auto& [id, expert] : layer.experts) {
+    double score = ExpertScore(layer, expert);
+    if (score > 0.0) scored.emplace_back(score, id);
+  }
+  std::sort(scored.begin(), scored.end(),
+            [](const auto& a, const auto& b) { return a.first > b.first; });
+  std::vector<int> ids;
+  ids.reserve(scored.size());
+  for (const auto& [score, id] : scored) ids.push_back(id);
+  return ids;
+}
+
+void WeightManager::RepinExperts(LayerState& layer) {
+  std::vector<int> ranked = RankExperts(layer);
+  if (ranked.size() > cfg_.pinned_experts_per_layer) {
+    ranked.resize(cfg_.pinned_experts_per_layer);
+  }
+  // Demoted experts are evicted by the layer's next ReleaseLayer.
+  for (auto& [id, expert] : layer.experts) expert.pinned = false;
+  for (int id : ranked) layer.experts[id].pinned = true;
+}
+
+int WeightManager::NextLayer(int layer_idx) const {
+  auto it = layers_.find(layer_idx);
+  if (it != layers_.end() && it->second.successor >= 0 &&
+      layers_.count(it->second.successor)) {
+    return it->second.successor;
+  }
+  // Nothing learned yet: assume ascending layer order.
+  auto next = layers_.upper_bound(layer_idx);
+  return next == layers_.end() ? -1 : next->first;
+}
+
+size_t WeightManager::CurrentWindow() {
+  if (!cfg_.adaptive_window || transfer_bps_ <= 0.0 ||
+      layer_compute_s_ <= 0.0) {
+    window_ = cfg_.prefetch_window;
+    return window_;
+  }
+
+  if (layer_bytes_dirty_) {
+    // Average bytes one prefetch step moves: dense pages plus the
+    // experts prefetched for the layer.
+    double total = 0.0;
+    for (const auto& [idx, layer] : layers_) {
+      size_t pages = 0;
+      for (const PageRange& r : layer.ranges) pages += r.page_count;
+      if (!layer.experts.empty()) {
+        size_t expert_pages = 0;
+        for (const auto& [id, expert] : layer.experts) {
+          for (const PageRange& r : expert.ranges) expert_pages += r.page_count;
+        }
+        size_t prefetched =
+            std::min(cfg_.expert_prefetch_count, layer.experts.size());
+        pages += expert_pages * prefetched / layer.experts.size();
+      }
+      total += static_cast<double>(pages) * cfg_.page_size;
+    }
+    avg_layer_bytes_ = layers_.empty() ? 0.0 : total / layers_.size();
+    layer_bytes_dirty_ = false;
+  }
+
+  // Enough layers in flight to cover one layer's transfer time.
+  double transfer_s = avg_layer_bytes_ / transfer_bps_;
+  size_t window =
+      static_cast<size_t>(std::ceil(transfer_s / layer_compute_s_));
+  window_ = std::clamp<size_t>(window, 1,
+                               std::max<size_t>(1, cfg_.max_prefetch_window));
+  return window_;
+}
+
+bool WeightManager::MapRanges(const std::vector<PageRange>& ranges) {
+  bool all_mapped = true;
+  for (const PageRange& r : ranges) {
+    size_t missing = 0, restores = 0;
+    for (size_t p = r.page_start; p < r.page_start + r.page_count; ++p) {
+      if (vmm_.isMapped(p)) continue;
+      ++missing;
+      if (vmm_.isEvictedToHost(p)) ++restores;
+    }
+    if (missing == 0) continue;
+    all_mapped = false;
+    Clock::time_point start = Clock::now();
+    vmm_.touchPages(r.page_start, r.page_count);
+    double dt = std::chrono::duration<double>(Clock::now() - start).count();
+    stall_s_ += dt;
+    // A synchronous restore is a direct bandwidth sample.
+    if (restores > 0 && dt > 0.0) {
+      Smooth(transfer_bps_, restores * cfg_.page_size / dt);
+    }
+  }
+  return all_mapped;
+}
+
+void WeightManager::PrefetchRanges(const std::vector<PageRange>& ranges) {
+  for (const PageRange& r : ranges) {
+    size_t missing = 0;
+    for (size_t p = r.page_start; p < r.page_start + r.page_count; ++p) {
+      if (!vmm_.isMapped(p)) ++missing;
+    }
+    if (missing == 0) continue;
+    if (bytes_in_flight_ == 0) first_issue_ = Clock::now();
+    vmm_.touchPagesAsync(r.page_start, r.page_count);
+    bytes_in_flight_ += missing * cfg_.page_size;
+  }
+}
+
+void WeightManager::FillLayer(int layer_idx, LayerState& layer) {
+  if (IsFilled(layer)) return;
+  Clock::time_point start = Clock::now();
+  filler_(layer_idx);
+  layer.filled = true;
+  stall_s_ += std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+bool WeightManager::IsFilled(const LayerState& layer) const {
+  return !filler_ || layer.filled;
+}
+
+void WeightManager::Smooth(double& avg, double sample) {
+  avg = avg == 0.0 ? sample : (1.0 - kSmoothing) * avg + kSmoothing * sample;
+}
+
 }  // namespace weights
 }  // namespace wrp_llm
@@ -747,5 +747,66 @@ TEST_CASE("ADIOS2 Comprehensive Integration", "[adios2][adapter][integration]")
   }
 }
 
+/**
+ * Test Case 11: Step Round Trip
+ *
+ * Verifies:
+ * - Large variables written through batched puts read back intact
+ * - Small variables packed into the step manifest read back intact
+ * - Deferred gets are served by EndStep
+ * - BeginStep reports EndOfStream after the last written step
+ */
+TEST_CASE("ADIOS2 Step Round Trip", "[adios2][adapter][roundtrip]") {
+  auto *fixture = hshm::Singleton<ADIOS2AdapterTestFixture>::GetInstance();
+
+  auto write_io = fixture->CreateTestIO();
+  auto output_path = fixture->GetTestOutputPath();
+  const size_t large_count = 4096;  // 32KB per step: its own blob
+  const size_t small_count = 8;     // Packed into the manifest
+  const size_t num_steps = 3;
+
+  {
+    auto var_large = write_io.DefineVariable<double>(
+        "field", {large_count}, {0}, {large_count});
+    auto var_small = write_io.DefineVariable<int>(
+        "params", {small_count}, {0}, {small_count});
+    auto engine = write_io.Open(output_path, adios2::Mode::Write);
+    REQUIRE(engine);
+
+    for (size_t t = 0; t < num_steps; ++t) {
+      auto large = fixture->CreateTestData<double>(large_count, 1000.0 * t);
+      auto small = fixture->CreateTestData<int>(small_count, 10 * t);
+      REQUIRE(engine.BeginStep() == adios2::StepStatus::OK);
+      engine.Put(var_large, large.data(), adios2::Mode::Deferred);
+      engine.Put(var_small, small.data(), adios2::Mode::Sync);
+      engine.EndStep();
+    }
+    engine.Close();
+  }
+
+  auto read_io = fixture->CreateTestIO();
+  auto var_large = read_io.DefineVariable<double>(
+      "field", {large_count}, {0}, {large_count});
+  auto var_small = read_io.DefineVariable<int>(
+      "params", {small_count}, {0}, {small_count});
+  auto engine = read_io.Open(output_path, adios2::Mode::Read);
+  REQUIRE(engine);
+
+  for (size_t t = 0; t < num_steps; ++t) {
+    REQUIRE(engine.BeginStep() == adios2::StepStatus::OK);
+    std::vector<double> large(large_count);
+    std::vector<int> small(small_count);
+    engine.Get(var_large, large.data(), adios2::Mode::Deferred);
+    engine.Get(var_small, small.data(), adios2::Mode::Sync);
+    engine.EndStep();
+
+    REQUIRE(fixture->VerifyTestData<double>(large, 1000.0 * t));
+    REQUIRE(fixture->VerifyTestData<int>(small, static_cast<int>(10 * t)));
+  }
+
+  REQUIRE(engine.BeginStep() == adios2::StepStatus::EndOfStream);
+  engine.Close();
+}
+
 // Main function using simple_test.h framework
 SIMPLE_TEST_MAIN()
@@ -408,6 +408,75 @@ TEST_CASE("FUSE CTE - Cross-page write simulation", "[fuse][cte]") {
   fixture->CleanupTag(tag_name);
 }
 
+TEST_CASE("FUSE CTE - Batched page write and read", "[fuse][cte]") {
+  auto *fixture = hshm::Singleton<FuseAdapterTestFixture>::GetInstance();
+  fixture->SetupTarget();
+
+  std::string tag_name = "/fuse_io_test/batched_pages";
+  auto tag_id = CteGetOrCreateTag(tag_name);
+  REQUIRE(!tag_id.IsNull());
+
+  // Unaligned start and more pages than one in-flight window
+  const size_t file_offset = 1000;
+  const size_t total_size = kDefaultPageSize * (kMaxPagesInflight + 6) + 17;
+  auto write_data = fixture->CreateTestData(total_size, 'B');
+
+  auto *ipc_manager = CHI_IPC;
+  hipc::FullPtr<char> shm = ipc_manager->AllocateBuffer(total_size);
+  REQUIRE(!shm.IsNull());
+  memcpy(shm.ptr_, write_data.data(), total_size);
+  REQUIRE(CtePutPages(tag_id, file_offset, shm, total_size) == total_size);
+  ipc_manager->FreeBuffer(shm);
+
+  std::vector<char> read_data(total_size);
+  REQUIRE(CteGetPages(tag_id, file_offset, read_data.data(), total_size) ==
+          total_size);
+  REQUIRE(fixture->VerifyTestData(read_data, 'B'));
+  REQUIRE(CteGetTagSize(tag_id) == file_offset + total_size);
+
+  fixture->CleanupTag(tag_name);
+}
+
+TEST_CASE("FUSE CTE - Metadata cache", "[fuse][cache]") {
+  FuseMetaCache cache;
+  cache.SetTtl(60.0);
+
+  struct stat st;
+  memset(&st, 0, sizeof(st));
+  st.st_size = 10;
+  cache.PutAttr("/a/b/file", st, 0);
+  cache.PutAttr("/a/missing", st, -ENOENT);
+  cache.PutDir("/a/b", {"file"});
+  cache.PutDir("/a", {"b", "missing"});
+
+  struct stat out;
+  int err = 1;
+  REQUIRE(cache.GetAttr("/a/b/file", out, err));
+  REQUIRE(err == 0);
+  REQUIRE(out.st_size == 10);
+  REQUIRE(cache.GetAttr("/a/missing", out, err));
+  REQUIRE(err == -ENOENT);
+
+  // Writes through the daemon only ever grow the cached size
+  cache.GrowFile("/a/b/file", 4096);
+  cache.GrowFile("/a/b/file", 100);
+  REQUIRE(cache.GetAttr("/a/b/file", out, err));
+  REQUIRE(out.st_size == 4096);
+
+  // A namespace change drops the path and every ancestor
+  std::vector<std::string> names;
+  cache.Invalidate("/a/b/new");
+  REQUIRE(!cache.GetDir("/a/b", names));
+  REQUIRE(!cache.GetDir("/a", names));
+  REQUIRE(cache.GetAttr("/a/b/file", out, err));
+  REQUIRE(cache.GetAttr("/a/missing", out, err));
+
+  // A zero TTL disables caching
+  cache.SetTtl(0.0);
+  cache.PutAttr("/a/b/file", st, 0);
+  REQUIRE(!cache.GetAttr("/a/b/file", out, err));
+}
+
 // ============================================================================
 // End-to-end integration
 // ============================================================================
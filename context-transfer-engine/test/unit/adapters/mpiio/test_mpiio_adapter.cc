@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * MPI-IO ADAPTER UNIT TESTS
+ *
+ * This test suite exercises the WRP CTE MPI-IO adapter across ranks. The
+ * adapter is linked directly into the executable instead of LD_PRELOAD, so
+ * MPI_Init and the MPI_File_* collectives below are the intercepted ones.
+ *
+ * Run with two or more ranks against a running Chimaera runtime:
+ *   mpirun -n 2 wrp_cte_mpiio_unit_tests
+ *
+ * Test Cases:
+ * 1. Interleaved write_all/read_all: every rank writes unaligned records in
+ *    round-robin order so two-phase aggregation needs several rounds, then
+ *    each rank reads back its neighbour's records and rank 0 the whole file
+ * 2. Interleaved write_at_all/read_at_all with the same layout and
+ *    aggregation left to the automatic heuristic
+ */
+
+#include <mpi.h>
+
+#include <catch2/catch_all.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "adapter/cae_config.h"
+#include "chimaera/chimaera.h"
+#include "wrp_cte/core/core_client.h"
+
+// Test constants
+const int kRecordSize = 1000;  // Deliberately not page aligned
+const int kRounds = 32;
+const char kCbBufferSize[] = "8192";  // Forces several aggregation rounds
+const std::string kTestFile = "/tmp/wrp_cte_mpiio_test.dat";
+const std::string kTargetFile = "/tmp/wrp_cte_mpiio_target.dat";
+const size_t kTargetSize = 64 * 1024 * 1024;
+
+/** Expected byte at absolute file offset \a off */
+static char PatternByte(MPI_Offset off) {
+  return static_cast<char>((off * 7 + off / kRecordSize) % 251);
+}
+
+/** File offset of record \a round written by \a rank out of \a nprocs */
+static MPI_Offset RecordOffset(int round, int rank, int nprocs) {
+  return static_cast<MPI_Offset>(round * nprocs + rank) * kRecordSize;
+}
+
+/** Fill \a buf with the pattern for the record at \a off */
+static void FillRecord(std::vector<char> &buf, MPI_Offset off) {
+  buf.resize(kRecordSize);
+  for (int i = 0; i < kRecordSize; ++i) {
+    buf[i] = PatternByte(off + i);
+  }
+}
+
+/** Count the bytes of \a buf that differ from the pattern at \a off */
+static size_t CountMismatches(const std::vector<char> &buf, MPI_Offset off) {
+  size_t bad = 0;
+  for (size_t i = 0; i < buf.size(); ++i) {
+    if (buf[i] != PatternByte(off + static_cast<MPI_Offset>(i))) {
+      ++bad;
+    }
+  }
+  return bad;
+}
+
+/** Build an info object with the given collective buffering mode */
+static MPI_Info MakeCbInfo(const char *mode) {
+  MPI_Info info;
+  MPI_Info_create(&info);
+  MPI_Info_set(info, "romio_cb_write", mode);
+  MPI_Info_set(info, "romio_cb_read", mode);
+  MPI_Info_set(info, "cb_buffer_size", kCbBufferSize);
+  return info;
+}
+
+/**
+ * Register the test target and track the test file
+ * MPI_Init has already brought up the CTE client through the adapter
+ */
+bool initializeRuntime(int rank) {
+  auto *cae_config = WRP_CAE_CONF;
+  cae_config->DisableInterception();
+
+  if (!wrp_cte::core::WRP_CTE_CLIENT_INIT()) {
+    return false;
+  }
+  if (rank == 0) {
+    auto *cte_client = WRP_CTE_CLIENT;
+    auto task = cte_client->AsyncRegisterTarget(
+        kTargetFile, chimaera::bdev::BdevType::kFile, kTargetSize);
+    task.Wait();
+    if (task->GetReturnCode() != 0) {
+      return false;
+    }
+  }
+  cae_config->AddIncludePattern("^" + kTestFile);
+  cae_config->EnableInterception();
+  MPI_Barrier(MPI_COMM_WORLD);
+  return true;
+}
+
+/** Sum \a value over all ranks */
+static long long AllSum(long long value) {
+  long long total = 0;
+  MPI_Allreduce(&value, &total, 1, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+  return total;
+}
+
+/** Delete the test file from rank 0 and wait for it */
+static void RemoveTestFile(int rank) {
+  if (rank == 0) {
+    std::remove(kTestFile.c_str());
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+/**
+ * MPI-IO Adapter Test: Interleaved write_all/read_all
+ *
+ * Records of every rank alternate through the file, so each collective
+ * round covers one contiguous but unaligned span that crosses page and
+ * aggregator boundaries.
+ */
+TEST_CASE("MPI-IO Adapter: Interleaved write_all/read_all",
+          "[mpiio][adapter]") {
+  int rank = 0, nprocs = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+  REQUIRE(nprocs >= 2);
+  RemoveTestFile(rank);
+
+  MPI_Info info = MakeCbInfo("enable");
+  std::vector<char> buf;
+
+  // Write this rank's records
+  MPI_File fh;
+  REQUIRE(MPI_File_open(MPI_COMM_WORLD, kTestFile.c_str(),
+                        MPI_MODE_CREATE | MPI_MODE_RDWR, info,
+                        &fh) == MPI_SUCCESS);
+  long long written = 0;
+  for (int r = 0; r < kRounds; ++r) {
+    MPI_Offset off = RecordOffset(r, rank, nprocs);
+    FillRecord(buf, off);
+    REQUIRE(MPI_File_seek(fh, off, MPI_SEEK_SET) == MPI_SUCCESS);
+    MPI_Status status;
+    REQUIRE(MPI_File_write_all(fh, buf.data(), kRecordSize, MPI_CHAR,
+                               &status) == MPI_SUCCESS);
+    int count = 0;
+    MPI_Get_count(&status, MPI_CHAR, &count);
+    written += count;
+  }
+  REQUIRE(MPI_File_close(&fh) == MPI_SUCCESS);
+  REQUIRE(written == static_cast<long long>(kRounds) * kRecordSize);
+  REQUIRE(AllSum(written) ==
+          static_cast<long long>(kRounds) * kRecordSize * nprocs);
+
+  // Read back the neighbour's records
+  REQUIRE(MPI_File_open(MPI_COMM_WORLD, kTestFile.c_str(), MPI_MODE_RDONLY,
+                        info, &fh) == MPI_SUCCESS);
+  int peer = (rank + 1) % nprocs;
+  long long read_bytes = 0;
+  size_t mismatches = 0;
+  for (int r = 0; r < kRounds; ++r) {
+    MPI_Offset off = RecordOffset(r, peer, nprocs);
+    buf.assign(kRecordSize, 0);
+    REQUIRE(MPI_File_seek(fh, off, MPI_SEEK_SET) == MPI_SUCCESS);
+    MPI_Status status;
+    REQUIRE(MPI_File_read_all(fh, buf.data(), kRecordSize, MPI_CHAR,
+                              &status) == MPI_SUCCESS);
+    int count = 0;
+    MPI_Get_count(&status, MPI_CHAR, &count);
+    read_bytes += count;
+    mismatches += CountMismatches(buf, off);
+  }
+  REQUIRE(read_bytes == static_cast<long long>(kRounds) * kRecordSize);
+  REQUIRE(mismatches == 0);
+
+  // Rank 0 reads the whole file in one collective; the others add nothing
+  MPI_Offset total = RecordOffset(kRounds, 0, nprocs);
+  int whole = rank == 0 ? static_cast<int>(total) : 0;
+  buf.assign(whole, 0);
+  REQUIRE(MPI_File_seek(fh, 0, MPI_SEEK_SET) == MPI_SUCCESS);
+  MPI_Status status;
+  REQUIRE(MPI_File_read_all(fh, buf.data(), whole, MPI_CHAR, &status) ==
+          MPI_SUCCESS);
+  int count = 0;
+  MPI_Get_count(&status, MPI_CHAR, &count);
+  REQUIRE(count == whole);
+  REQUIRE(CountMismatches(buf, 0) == 0);
+  REQUIRE(MPI_File_close(&fh) == MPI_SUCCESS);
+
+  MPI_Info_free(&info);
+  RemoveTestFile(rank);
+}
+
+/**
+ * MPI-IO Adapter Test: Interleaved write_at_all/read_at_all
+ *
+ * Same layout with explicit offsets and the automatic heuristic, which
+ * should aggregate this dense, unaligned pattern.
+ */
+TEST_CASE("MPI-IO Adapter: Interleaved write_at_all/read_at_all",
+          "[mpiio][adapter]") {
+  int rank = 0, nprocs = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+  REQUIRE(nprocs >= 2);
+  RemoveTestFile(rank);
+
+  MPI_Info info = MakeCbInfo("automatic");
+  std::vector<char> buf;
+
+  MPI_File fh;
+  REQUIRE(MPI_File_open(MPI_COMM_WORLD, kTestFile.c_str(),
+                        MPI_MODE_CREATE | MPI_MODE_RDWR, info,
+                        &fh) == MPI_SUCCESS);
+  long long written = 0;
+  for (int r = 0; r < kRounds; ++r) {
+    MPI_Offset off = RecordOffset(r, rank, nprocs);
+    FillRecord(buf, off);
+    MPI_Status status;
+    REQUIRE(MPI_File_write_at_all(fh, off, buf.data(), kRecordSize, MPI_CHAR,
+                                  &status) == MPI_SUCCESS);
+    int count = 0;
+    MPI_Get_count(&status, MPI_CHAR, &count);
+    written += count;
+  }
+  REQUIRE(AllSum(written) ==
+          static_cast<long long>(kRounds) * kRecordSize * nprocs);
+
+  // Read the neighbour's records through the same handle
+  int peer = (rank + 1) % nprocs;
+  long long read_bytes = 0;
+  size_t mismatches = 0;
+  for (int r = 0; r < kRounds; ++r) {
+    MPI_Offset off = RecordOffset(r, peer, nprocs);
+    buf.assign(kRecordSize, 0);
+    MPI_Status status;
+    REQUIRE(MPI_File_read_at_all(fh, off, buf.data(), kRecordSize, MPI_CHAR,
+                                 &status) == MPI_SUCCESS);
+    int count = 0;
+    MPI_Get_count(&status, MPI_CHAR, &count);
+    read_bytes += count;
+    mismatches += CountMismatches(buf, off);
+  }
+  REQUIRE(read_bytes == static_cast<long long>(kRounds) * kRecordSize);
+  REQUIRE(mismatches == 0);
+  REQUIRE(MPI_File_close(&fh) == MPI_SUCCESS);
+
+  MPI_Info_free(&info);
+  RemoveTestFile(rank);
+}
+
+int main(int argc, char **argv) {
+  MPI_Init(&argc, &argv);
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  int result = 1;
+  if (initializeRuntime(rank)) {
+    result = Catch::Session().run(argc, argv);
+  } else if (rank == 0) {
+    std::fprintf(stderr, "CTE initialization failed\n");
+  }
+
+  // Every rank must see the same verdict to avoid a hang in MPI_Finalize
+  int worst = 0;
+  MPI_Allreduce(&result, &worst, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+  MPI_Finalize();
+  return worst;
+}
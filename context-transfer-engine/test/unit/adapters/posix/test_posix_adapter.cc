@@ -39,12 +39,20 @@
  *
  * Test Cases:
  * 1. Open-Write-Read-Close: Basic file I/O operations with data verification
+ * 2. File Size Verification
+ * 3. mmap Read-Modify-Sync: CTE-backed memory mapping with write-back
+ * 4. Readahead and Write-Behind: small sequential/strided I/O through the
+ *    adapter page cache
+ * 5. Adaptive Mapper: sequential records grow extent blobs, random
+ *    overwrites stay correct across reopen
  */
 
+#include <algorithm>
 #include <catch2/catch_all.hpp>
 #include <cstdlib>
 #include <cstring>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <filesystem>
 #include <thread>
 #include <unistd.h>
@@ -249,4 +257,229 @@ TEST_CASE("POSIX Adapter: File Size Verification", "[posix][adapter]") {
     // Clean up
     stdfs::remove(kTestFile);
   }
-}
\ No newline at end of file
+}
+/**
+ * POSIX Adapter Test: mmap Read-Modify-Sync
+ *
+ * Maps a tracked file, verifies pages are faulted in from CTE, modifies the
+ * mapping, and checks that msync/munmap write the changes back.
+ */
+TEST_CASE("POSIX Adapter: mmap Read-Modify-Sync", "[posix][adapter][mmap]") {
+  REQUIRE(initializeRuntime());
+
+  if (stdfs::exists(kTestFile)) {
+    stdfs::remove(kTestFile);
+  }
+
+  SECTION("Fault in, modify, and write back a shared mapping") {
+    const size_t map_size = 4 * 1024 * 1024; // Spans several adapter pages
+    std::vector<char> data(map_size);
+    for (size_t i = 0; i < map_size; ++i) {
+      data[i] = static_cast<char>((i * 7) % 251);
+    }
+
+    int fd = open(kTestFile.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    REQUIRE(fd >= 0);
+    REQUIRE(write(fd, data.data(), map_size) ==
+            static_cast<ssize_t>(map_size));
+
+    // Map and read back every byte through page faults
+    void *addr = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      fd, 0);
+    REQUIRE(addr != MAP_FAILED);
+    char *mapped = static_cast<char *>(addr);
+    REQUIRE(memcmp(mapped, data.data(), map_size) == 0);
+
+    // The mapping stays valid after close(fd), as in POSIX
+    REQUIRE(close(fd) == 0);
+
+    // Modify the start and the last page, then flush
+    memset(mapped, 'X', 4096);
+    memset(mapped + map_size - 4096, 'Y', 4096);
+    memset(data.data(), 'X', 4096);
+    memset(data.data() + map_size - 4096, 'Y', 4096);
+    REQUIRE(msync(addr, map_size, MS_SYNC) == 0);
+    REQUIRE(munmap(addr, map_size) == 0);
+
+    // Read back through the adapter and compare
+    fd = open(kTestFile.c_str(), O_RDONLY);
+    REQUIRE(fd >= 0);
+    std::vector<char> read_data(map_size);
+    REQUIRE(read(fd, read_data.data(), map_size) ==
+            static_cast<ssize_t>(map_size));
+    REQUIRE(read_data == data);
+    REQUIRE(close(fd) == 0);
+
+    stdfs::remove(kTestFile);
+  }
+
+  SECTION("Partial munmap keeps the rest of the mapping") {
+    const size_t map_size = 4 * 1024 * 1024;
+    const size_t page = 4096;
+    std::vector<char> data(map_size);
+    for (size_t i = 0; i < map_size; ++i) {
+      data[i] = static_cast<char>((i * 13) % 251);
+    }
+    int fd = open(kTestFile.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    REQUIRE(fd >= 0);
+    REQUIRE(write(fd, data.data(), map_size) ==
+            static_cast<ssize_t>(map_size));
+    void *addr = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      fd, 0);
+    REQUIRE(addr != MAP_FAILED);
+    REQUIRE(close(fd) == 0);
+    char *mapped = static_cast<char *>(addr);
+
+    // The kernel reads an untouched mapped page on behalf of write()
+    int pipe_fds[2];
+    REQUIRE(pipe(pipe_fds) == 0);
+    REQUIRE(write(pipe_fds[1], mapped + map_size / 2, page) ==
+            static_cast<ssize_t>(page));
+    std::vector<char> piped(page);
+    REQUIRE(read(pipe_fds[0], piped.data(), page) ==
+            static_cast<ssize_t>(page));
+    REQUIRE(memcmp(piped.data(), data.data() + map_size / 2, page) == 0);
+    REQUIRE(close(pipe_fds[0]) == 0);
+    REQUIRE(close(pipe_fds[1]) == 0);
+
+    // Punch a hole in the middle; both sides stay usable and write back
+    REQUIRE(munmap(mapped + page, 2 * page) == 0);
+    memset(mapped, 'H', page);
+    memset(mapped + map_size - page, 'T', page);
+    memset(data.data(), 'H', page);
+    memset(data.data() + map_size - page, 'T', page);
+    REQUIRE(munmap(mapped, page) == 0);
+    REQUIRE(munmap(mapped + 3 * page, map_size - 3 * page) == 0);
+
+    fd = open(kTestFile.c_str(), O_RDONLY);
+    REQUIRE(fd >= 0);
+    std::vector<char> read_data(map_size);
+    REQUIRE(read(fd, read_data.data(), map_size) ==
+            static_cast<ssize_t>(map_size));
+    REQUIRE(read_data == data);
+    REQUIRE(close(fd) == 0);
+
+    stdfs::remove(kTestFile);
+  }
+}
+
+/**
+ * POSIX Adapter Test: Readahead and Write-Behind
+ *
+ * Streams a file in sub-page writes with write-behind enabled, then reads it
+ * back with small sequential and strided reads so the readahead path serves
+ * prefetched pages, and verifies every byte.
+ */
+TEST_CASE("POSIX Adapter: Readahead and Write-Behind",
+          "[posix][adapter][readahead]") {
+  REQUIRE(initializeRuntime());
+  auto *cae_config = WRP_CAE_CONF;
+  REQUIRE(cae_config != nullptr);
+  bool old_write_behind = cae_config->IsAdapterWriteBehindEnabled();
+  size_t old_readahead = cae_config->GetAdapterReadaheadPages();
+  cae_config->SetAdapterWriteBehind(true);
+  cae_config->SetAdapterReadaheadPages(8);
+
+  if (stdfs::exists(kTestFile)) {
+    stdfs::remove(kTestFile);
+  }
+
+  SECTION("Coalesced small writes, then sequential and strided reads") {
+    const size_t file_size = 1024 * 1024;
+    const size_t io_size = 1000; // Deliberately not page aligned
+    std::vector<char> data(file_size);
+    for (size_t i = 0; i < file_size; ++i) {
+      data[i] = static_cast<char>((i * 13) % 241);
+    }
+
+    int fd = open(kTestFile.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    REQUIRE(fd >= 0);
+    for (size_t off = 0; off < file_size; off += io_size) {
+      size_t len = std::min(io_size, file_size - off);
+      REQUIRE(write(fd, data.data() + off, len) == static_cast<ssize_t>(len));
+    }
+    REQUIRE(fsync(fd) == 0);
+    REQUIRE(close(fd) == 0);
+
+    // Sequential small reads
+    fd = open(kTestFile.c_str(), O_RDONLY);
+    REQUIRE(fd >= 0);
+    std::vector<char> read_data(file_size);
+    for (size_t off = 0; off < file_size; off += io_size) {
+      size_t len = std::min(io_size, file_size - off);
+      REQUIRE(read(fd, read_data.data() + off, len) ==
+              static_cast<ssize_t>(len));
+    }
+    REQUIRE(read_data == data);
+
+    // Strided reads skipping three records out of four
+    const size_t stride = 4 * io_size;
+    std::vector<char> record(io_size);
+    for (size_t off = 0; off + io_size <= file_size; off += stride) {
+      REQUIRE(pread(fd, record.data(), io_size, off) ==
+              static_cast<ssize_t>(io_size));
+      REQUIRE(memcmp(record.data(), data.data() + off, io_size) == 0);
+    }
+    REQUIRE(close(fd) == 0);
+
+    stdfs::remove(kTestFile);
+  }
+
+  cae_config->SetAdapterWriteBehind(old_write_behind);
+  cae_config->SetAdapterReadaheadPages(old_readahead);
+}
+
+TEST_CASE("POSIX Adapter: Adaptive Mapper", "[posix][adapter][mapper]") {
+  REQUIRE(initializeRuntime());
+  auto *cae_config = WRP_CAE_CONF;
+  REQUIRE(cae_config != nullptr);
+  std::string old_mapper = cae_config->GetAdapterMapper();
+  cae_config->SetAdapterMapper("adaptive");
+
+  if (stdfs::exists(kTestFile)) {
+    stdfs::remove(kTestFile);
+  }
+
+  SECTION("Sequential records, random overwrites, reopen and read back") {
+    const size_t file_size = 2 * 1024 * 1024;
+    const size_t io_size = 1000;
+    std::vector<char> data(file_size);
+    for (size_t i = 0; i < file_size; ++i) {
+      data[i] = static_cast<char>((i * 7) % 251);
+    }
+
+    int fd = open(kTestFile.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    REQUIRE(fd >= 0);
+    for (size_t off = 0; off < file_size; off += io_size) {
+      size_t len = std::min(io_size, file_size - off);
+      REQUIRE(write(fd, data.data() + off, len) == static_cast<ssize_t>(len));
+    }
+    // Unaligned overwrites land inside the extents
+    for (size_t off = 123; off + 5000 < file_size; off += 300007) {
+      for (size_t i = 0; i < 5000; ++i) {
+        data[off + i] = static_cast<char>(~data[off + i]);
+      }
+      REQUIRE(pwrite(fd, data.data() + off, 5000, off) == 5000);
+    }
+    REQUIRE(close(fd) == 0);
+
+    // A fresh open rebuilds the extent map from the tag
+    fd = open(kTestFile.c_str(), O_RDONLY);
+    REQUIRE(fd >= 0);
+    std::vector<char> read_data(file_size);
+    REQUIRE(pread(fd, read_data.data(), file_size, 0) ==
+            static_cast<ssize_t>(file_size));
+    REQUIRE(read_data == data);
+    REQUIRE(close(fd) == 0);
+
+    // 2MB of records fit in a few extents instead of 512 pages
+    wrp_cte::core::Tag file_tag(stdfs::absolute(kTestFile).string());
+    size_t num_blobs = file_tag.GetContainedBlobs().size();
+    INFO("Blobs in tag: " << num_blobs);
+    REQUIRE(num_blobs < file_size / cae_config->GetAdapterPageSize());
+
+    stdfs::remove(kTestFile);
+  }
+
+  cae_config->SetAdapterMapper(old_mapper);
+}
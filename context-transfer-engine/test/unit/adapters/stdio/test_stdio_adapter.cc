@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * STDIO ADAPTER UNIT TESTS
+ *
+ * This test suite exercises the user-space stream buffer of the WRP CTE
+ * STDIO adapter. The adapter is linked directly into the executable instead
+ * of LD_PRELOAD, so the stdio calls below are the intercepted ones, and the
+ * buffer of each FILE is inspected through the adapter metadata manager.
+ *
+ * Test Cases:
+ * 1. Coalescing: many fputc and small fwrite calls stay in one buffer
+ * 2. Line buffering: '\n' writes the buffer back under _IOLBF
+ * 3. Unbuffered: _IONBF writes every call through
+ * 4. Read after write on the same FILE
+ * 5. Append mode: writes land at the end and ftell reports it
+ * 6. fseek write-back: seeking writes the buffer back and overwrites work
+ * 7. fflush(NULL) writes back every intercepted stream
+ */
+
+#include <catch2/catch_all.hpp>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "adapter/cae_config.h"
+#include "adapter/stdio/stdio_fs_api.h"
+#include "chimaera/chimaera.h"
+#include "wrp_cte/core/core_client.h"
+
+namespace stdfs = std::filesystem;
+
+// Test constants
+const std::string kTestFile = "/tmp/wrp_cte_stdio_test.dat";
+const std::string kTestFile2 = "/tmp/wrp_cte_stdio_test2.dat";
+const std::string kTargetFile = "/tmp/wrp_cte_stdio_target.dat";
+const size_t kTargetSize = 64 * 1024 * 1024;
+
+/**
+ * Initialize CTE runtime, register a test target and track the test files
+ * Must be called before any STDIO adapter operations that use CTE
+ */
+bool initializeRuntime() {
+  static bool initialized = false;
+  if (initialized) {
+    return true;
+  }
+
+  // Disable interception during initialization
+  auto *cae_config = WRP_CAE_CONF;
+  cae_config->DisableInterception();
+
+  if (!chi::CHIMAERA_INIT(chi::ChimaeraMode::kClient, true)) {
+    return false;
+  }
+  if (!wrp_cte::core::WRP_CTE_CLIENT_INIT()) {
+    return false;
+  }
+
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto task = cte_client->AsyncRegisterTarget(
+      kTargetFile, chimaera::bdev::BdevType::kFile, kTargetSize);
+  task.Wait();
+  if (task->GetReturnCode() != 0) {
+    return false;
+  }
+
+  cae_config->AddIncludePattern("^/tmp/wrp_cte_stdio_test");
+  cae_config->EnableInterception();
+  initialized = true;
+  return true;
+}
+
+/** The adapter stream buffer of \a fp, or nullptr if it is not tracked */
+wrp::cae::StdioBuffer *GetStreamBuffer(FILE *fp) {
+  wrp::cae::File f;
+  f.hermes_fh_ = fp;
+  auto *mdm = WRP_CTE_FS_METADATA_MANAGER;
+  auto stat = mdm->Find(f);
+  return stat ? stat->stdio_buf_.get() : nullptr;
+}
+
+/** Read all of \a path through a fresh intercepted stream */
+std::string ReadAll(const std::string &path) {
+  FILE *fp = fopen(path.c_str(), "r");
+  if (fp == nullptr) {
+    return "";
+  }
+  std::string data;
+  char chunk[256];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), fp)) > 0) {
+    data.append(chunk, n);
+  }
+  fclose(fp);
+  return data;
+}
+
+/** Remove the test files */
+void RemoveTestFiles() {
+  stdfs::remove(kTestFile);
+  stdfs::remove(kTestFile2);
+}
+
+/**
+ * STDIO Adapter Test: Coalescing
+ *
+ * Single characters and small records are gathered in the stream buffer
+ * and only reach CTE on fflush.
+ */
+TEST_CASE("STDIO Adapter: fputc and fwrite coalescing", "[stdio][adapter]") {
+  REQUIRE(initializeRuntime());
+  RemoveTestFiles();
+
+  FILE *fp = fopen(kTestFile.c_str(), "w+");
+  REQUIRE(fp != nullptr);
+  wrp::cae::StdioBuffer *buf = GetStreamBuffer(fp);
+  REQUIRE(buf != nullptr);
+
+  std::string expected;
+  for (int i = 0; i < 100; ++i) {
+    char c = static_cast<char>('a' + i % 26);
+    REQUIRE(fputc(c, fp) == c);
+    expected.push_back(c);
+  }
+  const char record[] = "0123456789";
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(fwrite(record, 1, 10, fp) == 10);
+    expected.append(record, 10);
+  }
+
+  // Everything is still one dirty window starting at offset 0
+  REQUIRE(buf->IsDirty());
+  REQUIRE(buf->off_ == 0);
+  REQUIRE(buf->len_ == expected.size());
+  REQUIRE(ftell(fp) == static_cast<long>(expected.size()));
+
+  REQUIRE(fflush(fp) == 0);
+  REQUIRE_FALSE(buf->IsDirty());
+  REQUIRE(fclose(fp) == 0);
+  REQUIRE(ReadAll(kTestFile) == expected);
+
+  RemoveTestFiles();
+}
+
+/**
+ * STDIO Adapter Test: Line buffering
+ */
+TEST_CASE("STDIO Adapter: line-buffered newline flush", "[stdio][adapter]") {
+  REQUIRE(initializeRuntime());
+  RemoveTestFiles();
+
+  FILE *fp = fopen(kTestFile.c_str(), "w");
+  REQUIRE(fp != nullptr);
+  REQUIRE(setvbuf(fp, nullptr, _IOLBF, 0) == 0);
+  wrp::cae::StdioBuffer *buf = GetStreamBuffer(fp);
+  REQUIRE(buf != nullptr);
+  REQUIRE(buf->IsLineBuffered());
+
+  // No newline yet, so the bytes stay buffered
+  REQUIRE(fputs("first half, ", fp) >= 0);
+  REQUIRE(buf->IsDirty());
+
+  // The newline writes the whole line back
+  REQUIRE(fputs("second half\n", fp) >= 0);
+  REQUIRE_FALSE(buf->IsDirty());
+
+  REQUIRE(fputs("tail", fp) >= 0);
+  REQUIRE(buf->IsDirty());
+  REQUIRE(fputc('\n', fp) == '\n');
+  REQUIRE_FALSE(buf->IsDirty());
+
+  REQUIRE(fclose(fp) == 0);
+  REQUIRE(ReadAll(kTestFile) == "first half, second half\ntail\n");
+
+  RemoveTestFiles();
+}
+
+/**
+ * STDIO Adapter Test: Unbuffered streams
+ */
+TEST_CASE("STDIO Adapter: _IONBF writes through", "[stdio][adapter]") {
+  REQUIRE(initializeRuntime());
+  RemoveTestFiles();
+
+  FILE *fp = fopen(kTestFile.c_str(), "w+");
+  REQUIRE(fp != nullptr);
+  REQUIRE(setvbuf(fp, nullptr, _IONBF, 0) == 0);
+  wrp::cae::StdioBuffer *buf = GetStreamBuffer(fp);
+  REQUIRE(buf != nullptr);
+  REQUIRE(buf->IsUnbuffered());
+
+  REQUIRE(fputc('x', fp) == 'x');
+  REQUIRE_FALSE(buf->IsDirty());
+  REQUIRE(fwrite("yz", 1, 2, fp) == 2);
+  REQUIRE_FALSE(buf->IsDirty());
+  REQUIRE(buf->len_ == 0);
+  REQUIRE(ftell(fp) == 3);
+
+  // Reads bypass the buffer as well
+  rewind(fp);
+  char data[4] = {0};
+  REQUIRE(fread(data, 1, 3, fp) == 3);
+  REQUIRE(std::string(data) == "xyz");
+  REQUIRE(buf->len_ == 0);
+
+  REQUIRE(fclose(fp) == 0);
+  RemoveTestFiles();
+}
+
+/**
+ * STDIO Adapter Test: Read after write on the same FILE
+ */
+TEST_CASE("STDIO Adapter: read after write on one stream",
+          "[stdio][adapter]") {
+  REQUIRE(initializeRuntime());
+  RemoveTestFiles();
+
+  FILE *fp = fopen(kTestFile.c_str(), "w+");
+  REQUIRE(fp != nullptr);
+  std::string text = "buffered bytes must be visible to the same stream";
+  REQUIRE(fwrite(text.data(), 1, text.size(), fp) == text.size());
+
+  // The seek writes the dirty window back before the read refills it
+  REQUIRE(fseek(fp, 0, SEEK_SET) == 0);
+  std::vector<char> data(text.size());
+  REQUIRE(fread(data.data(), 1, data.size(), fp) == text.size());
+  REQUIRE(std::string(data.begin(), data.end()) == text);
+  REQUIRE(ftell(fp) == static_cast<long>(text.size()));
+
+  // A short read from the middle is served from the refilled window
+  REQUIRE(fseek(fp, 9, SEEK_SET) == 0);
+  char word[6] = {0};
+  REQUIRE(fread(word, 1, 5, fp) == 5);
+  REQUIRE(std::string(word) == "bytes");
+
+  REQUIRE(fclose(fp) == 0);
+  RemoveTestFiles();
+}
+
+/**
+ * STDIO Adapter Test: Append mode
+ */
+TEST_CASE("STDIO Adapter: append mode and ftell", "[stdio][adapter]") {
+  REQUIRE(initializeRuntime());
+  RemoveTestFiles();
+
+  FILE *fp = fopen(kTestFile.c_str(), "w");
+  REQUIRE(fp != nullptr);
+  REQUIRE(fputs("head-", fp) >= 0);
+  REQUIRE(fclose(fp) == 0);
+
+  fp = fopen(kTestFile.c_str(), "a");
+  REQUIRE(fp != nullptr);
+  REQUIRE(fputs("one-", fp) >= 0);
+  REQUIRE(fputs("two", fp) >= 0);
+
+  // ftell writes the appended bytes back to give them an offset
+  REQUIRE(ftell(fp) == 12);
+
+  // Further appends still go to the end
+  REQUIRE(fputs("-three", fp) >= 0);
+  REQUIRE(ftell(fp) == 18);
+  REQUIRE(fclose(fp) == 0);
+
+  REQUIRE(ReadAll(kTestFile) == "head-one-two-three");
+  RemoveTestFiles();
+}
+
+/**
+ * STDIO Adapter Test: fseek write-back
+ */
+TEST_CASE("STDIO Adapter: fseek writes back the buffer", "[stdio][adapter]") {
+  REQUIRE(initializeRuntime());
+  RemoveTestFiles();
+
+  FILE *fp = fopen(kTestFile.c_str(), "w+");
+  REQUIRE(fp != nullptr);
+  wrp::cae::StdioBuffer *buf = GetStreamBuffer(fp);
+  REQUIRE(buf != nullptr);
+
+  std::string text(64, '.');
+  REQUIRE(fwrite(text.data(), 1, text.size(), fp) == text.size());
+  REQUIRE(buf->IsDirty());
+
+  REQUIRE(fseek(fp, 10, SEEK_SET) == 0);
+  REQUIRE_FALSE(buf->IsDirty());
+  REQUIRE(ftell(fp) == 10);
+
+  // Overwrite in the middle, then seek relative to the end
+  REQUIRE(fwrite("MID", 1, 3, fp) == 3);
+  REQUIRE(buf->IsDirty());
+  REQUIRE(fseek(fp, -2, SEEK_END) == 0);
+  REQUIRE_FALSE(buf->IsDirty());
+  REQUIRE(ftell(fp) == 62);
+  REQUIRE(fwrite("END!", 1, 4, fp) == 4);
+  REQUIRE(fclose(fp) == 0);
+
+  text.replace(10, 3, "MID");
+  text.replace(62, 2, "END!");
+  REQUIRE(ReadAll(kTestFile) == text);
+  RemoveTestFiles();
+}
+
+/**
+ * STDIO Adapter Test: fflush(NULL)
+ */
+TEST_CASE("STDIO Adapter: fflush(NULL) writes back all streams",
+          "[stdio][adapter]") {
+  REQUIRE(initializeRuntime());
+  RemoveTestFiles();
+
+  FILE *fp1 = fopen(kTestFile.c_str(), "w");
+  FILE *fp2 = fopen(kTestFile2.c_str(), "w");
+  REQUIRE(fp1 != nullptr);
+  REQUIRE(fp2 != nullptr);
+  REQUIRE(fputs("stream one", fp1) >= 0);
+  REQUIRE(fputs("stream two", fp2) >= 0);
+  REQUIRE(GetStreamBuffer(fp1)->IsDirty());
+  REQUIRE(GetStreamBuffer(fp2)->IsDirty());
+
+  REQUIRE(fflush(nullptr) == 0);
+  REQUIRE_FALSE(GetStreamBuffer(fp1)->IsDirty());
+  REQUIRE_FALSE(GetStreamBuffer(fp2)->IsDirty());
+
+  REQUIRE(fclose(fp1) == 0);
+  REQUIRE(fclose(fp2) == 0);
+  REQUIRE(ReadAll(kTestFile) == "stream one");
+  REQUIRE(ReadAll(kTestFile2) == "stream two");
+  RemoveTestFiles();
+}
@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * HDF5 VFD ADAPTER UNIT TESTS
+ *
+ * This test suite exercises the metadata block cache of the WRP CTE HDF5
+ * VFD (H5FDhermes_meta_cache.h). The driver is linked directly into the
+ * executable and selected with H5Pset_driver.
+ *
+ * Test Cases:
+ * 1. Metadata cache in isolation: reads, write-back, eviction and raw
+ *    overlays against an in-memory file
+ * 2. Many objects round trip: create groups, datasets and attributes,
+ *    reopen, walk them with H5Literate and check every value, for a cache
+ *    that holds the whole file and one small enough to evict constantly
+ * 3. Attribute rewrite: dirty metadata reaches the file on close
+ */
+
+#include <hdf5.h>
+
+#include <catch2/catch_all.hpp>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "adapter/cae_config.h"
+#include "adapter/vfd/H5FDhermes.h"
+#include "adapter/vfd/H5FDhermes_meta_cache.h"
+#include "chimaera/chimaera.h"
+#include "wrp_cte/core/core_client.h"
+
+namespace stdfs = std::filesystem;
+
+// Test constants
+const std::string kTestFile = "/tmp/wrp_cte_vfd_test.h5";
+const std::string kTargetFile = "/tmp/wrp_cte_vfd_target.dat";
+const size_t kTargetSize = 64 * 1024 * 1024;
+const int kNumGroups = 200;
+const int kDatasetLen = 16;
+
+/**
+ * Initialize CTE runtime and register a test target
+ * Must be called before the VFD opens any file
+ */
+bool initializeRuntime() {
+  static bool initialized = false;
+  if (initialized) {
+    return true;
+  }
+
+  // Disable interception during initialization
+  auto *cae_config = WRP_CAE_CONF;
+  cae_config->DisableInterception();
+
+  if (!chi::CHIMAERA_INIT(chi::ChimaeraMode::kClient, true)) {
+    return false;
+  }
+  if (!wrp_cte::core::WRP_CTE_CLIENT_INIT()) {
+    return false;
+  }
+
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto task = cte_client->AsyncRegisterTarget(
+      kTargetFile, chimaera::bdev::BdevType::kFile, kTargetSize);
+  task.Wait();
+  if (task->GetReturnCode() != 0) {
+    return false;
+  }
+
+  cae_config->EnableInterception();
+  initialized = true;
+  return true;
+}
+
+/** A file access property list selecting the CTE VFD */
+hid_t MakeFapl() {
+  hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+  H5Pset_driver(fapl, H5FD_hermes_init(), nullptr);
+  return fapl;
+}
+
+/** Name of group \a i */
+std::string GroupName(int i) {
+  char name[16];
+  snprintf(name, sizeof(name), "g%03d", i);
+  return name;
+}
+
+/** Expected element \a j of the dataset in group \a i */
+int DatasetValue(int i, int j) { return i * kDatasetLen + j; }
+
+/** Write an integer attribute \a name on \a obj */
+void WriteIntAttr(hid_t obj, const char *name, int value) {
+  hid_t space = H5Screate(H5S_SCALAR);
+  hid_t attr = H5Aexists(obj, name) > 0
+                   ? H5Aopen(obj, name, H5P_DEFAULT)
+                   : H5Acreate2(obj, name, H5T_NATIVE_INT, space,
+                                H5P_DEFAULT, H5P_DEFAULT);
+  H5Awrite(attr, H5T_NATIVE_INT, &value);
+  H5Aclose(attr);
+  H5Sclose(space);
+}
+
+/** Read integer attribute \a name of \a obj, -1 if it cannot be read */
+int ReadIntAttr(hid_t obj, const char *name) {
+  int value = -1;
+  hid_t attr = H5Aopen(obj, name, H5P_DEFAULT);
+  if (attr < 0) {
+    return -1;
+  }
+  H5Aread(attr, H5T_NATIVE_INT, &value);
+  H5Aclose(attr);
+  return value;
+}
+
+/** Create kNumGroups groups, each with a dataset and attributes */
+void CreateObjects() {
+  hid_t fapl = MakeFapl();
+  hid_t file = H5Fcreate(kTestFile.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+  REQUIRE(file >= 0);
+  hsize_t dims[1] = {kDatasetLen};
+  hid_t space = H5Screate_simple(1, dims, nullptr);
+  std::vector<int> data(kDatasetLen);
+  for (int i = 0; i < kNumGroups; ++i) {
+    hid_t grp = H5Gcreate2(file, GroupName(i).c_str(), H5P_DEFAULT,
+                           H5P_DEFAULT, H5P_DEFAULT);
+    REQUIRE(grp >= 0);
+    WriteIntAttr(grp, "index", i);
+    for (int j = 0; j < kDatasetLen; ++j) {
+      data[j] = DatasetValue(i, j);
+    }
+    hid_t dset = H5Dcreate2(grp, "data", H5T_NATIVE_INT, space, H5P_DEFAULT,
+                            H5P_DEFAULT, H5P_DEFAULT);
+    REQUIRE(dset >= 0);
+    REQUIRE(H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+                     data.data()) >= 0);
+    WriteIntAttr(dset, "scale", i * 3);
+    H5Dclose(dset);
+    H5Gclose(grp);
+  }
+  H5Sclose(space);
+  REQUIRE(H5Fclose(file) >= 0);
+  H5Pclose(fapl);
+}
+
+/** H5Literate callback collecting link names */
+herr_t CollectLink(hid_t group, const char *name, const H5L_info_t *info,
+                   void *op_data) {
+  (void)group;
+  (void)info;
+  static_cast<std::vector<std::string> *>(op_data)->emplace_back(name);
+  return 0;
+}
+
+/**
+ * Reopen the file, walk the root group and check every object
+ * @param attr_bias Added to each expected "index" attribute
+ */
+void VerifyObjects(int attr_bias) {
+  hid_t fapl = MakeFapl();
+  hid_t file = H5Fopen(kTestFile.c_str(), H5F_ACC_RDONLY, fapl);
+  REQUIRE(file >= 0);
+
+  std::vector<std::string> names;
+  hsize_t idx = 0;
+  REQUIRE(H5Literate(file, H5_INDEX_NAME, H5_ITER_INC, &idx, CollectLink,
+                      &names) >= 0);
+  REQUIRE(names.size() == static_cast<size_t>(kNumGroups));
+
+  size_t bad_values = 0;
+  std::vector<int> data(kDatasetLen);
+  for (int i = 0; i < kNumGroups; ++i) {
+    REQUIRE(names[i] == GroupName(i));
+    hid_t grp = H5Gopen2(file, names[i].c_str(), H5P_DEFAULT);
+    REQUIRE(grp >= 0);
+    REQUIRE(ReadIntAttr(grp, "index") == i + attr_bias);
+    hid_t dset = H5Dopen2(grp, "data", H5P_DEFAULT);
+    REQUIRE(dset >= 0);
+    REQUIRE(ReadIntAttr(dset, "scale") == i * 3);
+    std::fill(data.begin(), data.end(), -1);
+    REQUIRE(H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+                    data.data()) >= 0);
+    for (int j = 0; j < kDatasetLen; ++j) {
+      if (data[j] != DatasetValue(i, j)) {
+        ++bad_values;
+      }
+    }
+    H5Dclose(dset);
+    H5Gclose(grp);
+  }
+  REQUIRE(bad_values == 0);
+  REQUIRE(H5Fclose(file) >= 0);
+  H5Pclose(fapl);
+}
+
+/**
+ * VFD Metadata Cache Test: in isolation
+ *
+ * The backend is a vector standing in for the file, so every read and
+ * write-back the cache issues can be checked directly.
+ */
+TEST_CASE("VFD Meta Cache: read, write-back and eviction",
+          "[vfd][adapter][meta_cache]") {
+  const size_t kBlock = 64;
+  std::vector<char> disk(8 * kBlock);
+  for (size_t i = 0; i < disk.size(); ++i) {
+    disk[i] = static_cast<char>(i);
+  }
+  size_t reads = 0, writes = 0;
+  wrp::cae::VfdMetaCache cache(
+      4 * kBlock, kBlock,
+      [&](void *buf, size_t off, size_t size) -> size_t {
+        ++reads;
+        size_t n = off < disk.size() ? std::min(size, disk.size() - off) : 0;
+        memcpy(buf, disk.data() + off, n);
+        return n;
+      },
+      [&](const void *buf, size_t off, size_t size) -> bool {
+        ++writes;
+        if (off + size > disk.size()) {
+          disk.resize(off + size);
+        }
+        memcpy(disk.data() + off, buf, size);
+        return true;
+      });
+  REQUIRE(cache.IsEnabled());
+
+  SECTION("Repeated reads hit the cache") {
+    char buf[kBlock];
+    REQUIRE(cache.Read(buf, 10, 20));
+    REQUIRE(cache.Read(buf, 30, 20));
+    REQUIRE(reads == 1);
+    REQUIRE(buf[0] == 30);
+  }
+
+  SECTION("Writes stay cached until Flush and merge into one write") {
+    std::vector<char> src(2 * kBlock, 'x');
+    REQUIRE(cache.Write(src.data(), kBlock, src.size()));
+    REQUIRE(writes == 0);
+    REQUIRE(disk[kBlock] != 'x');
+
+    // A raw read of the range sees the unflushed bytes
+    std::vector<char> raw(disk.begin() + kBlock, disk.begin() + 3 * kBlock);
+    cache.OverlayRaw(raw.data(), kBlock, raw.size());
+    REQUIRE(raw == src);
+
+    REQUIRE(cache.Flush());
+    REQUIRE(writes == 1);
+    REQUIRE(std::equal(src.begin(), src.end(), disk.begin() + kBlock));
+  }
+
+  SECTION("Evicted dirty blocks are written back") {
+    char c = 'y';
+    REQUIRE(cache.Write(&c, 5, 1));
+    char buf[kBlock];
+    for (size_t b = 1; b < 8; ++b) {
+      REQUIRE(cache.Read(buf, b * kBlock, kBlock));
+    }
+    REQUIRE(cache.NumBlocks() <= 4);
+    REQUIRE(disk[5] == 'y');
+
+    // The evicted block reloads with the written byte
+    REQUIRE(cache.Read(buf, 0, kBlock));
+    REQUIRE(buf[5] == 'y');
+  }
+
+  SECTION("Raw writes patch cached blocks") {
+    char buf[kBlock];
+    REQUIRE(cache.Read(buf, 0, kBlock));
+    std::vector<char> raw(16, 'z');
+    memcpy(disk.data() + 8, raw.data(), raw.size());
+    cache.PatchRaw(raw.data(), 8, raw.size());
+    REQUIRE(cache.Read(buf, 8, 16));
+    REQUIRE(std::string(buf, 16) == std::string(16, 'z'));
+    REQUIRE(reads == 1);
+  }
+}
+
+/**
+ * VFD Adapter Test: Many objects round trip through the metadata cache
+ */
+TEST_CASE("VFD Adapter: many objects round trip with the meta cache",
+          "[vfd][adapter][meta_cache]") {
+  REQUIRE(initializeRuntime());
+  auto *cae_config = WRP_CAE_CONF;
+  size_t old_cache_size = cae_config->GetVfdMetaCacheSize();
+  size_t old_block_size = cae_config->GetVfdMetaBlockSize();
+
+  // The whole file fits, or only a few blocks so lookups keep evicting
+  for (size_t cache_size : {size_t(16) << 20, size_t(16) << 10}) {
+    INFO("vfd_meta_cache_size=" << cache_size);
+    cae_config->SetVfdMetaCacheSize(cache_size);
+    cae_config->SetVfdMetaBlockSize(4 << 10);
+    stdfs::remove(kTestFile);
+
+    CreateObjects();
+    VerifyObjects(0);
+  }
+
+  cae_config->SetVfdMetaCacheSize(old_cache_size);
+  cae_config->SetVfdMetaBlockSize(old_block_size);
+  stdfs::remove(kTestFile);
+}
+
+/**
+ * VFD Adapter Test: rewritten attributes reach the file on close
+ */
+TEST_CASE("VFD Adapter: attribute rewrite is flushed on close",
+          "[vfd][adapter][meta_cache]") {
+  REQUIRE(initializeRuntime());
+  stdfs::remove(kTestFile);
+  CreateObjects();
+
+  // Rewrite every group's attribute with the cache on
+  hid_t fapl = MakeFapl();
+  hid_t file = H5Fopen(kTestFile.c_str(), H5F_ACC_RDWR, fapl);
+  REQUIRE(file >= 0);
+  for (int i = 0; i < kNumGroups; ++i) {
+    hid_t grp = H5Gopen2(file, GroupName(i).c_str(), H5P_DEFAULT);
+    REQUIRE(grp >= 0);
+    WriteIntAttr(grp, "index", i + 1000);
+    H5Gclose(grp);
+  }
+  REQUIRE(H5Fclose(file) >= 0);
+  H5Pclose(fapl);
+
+  VerifyObjects(1000);
+
+  // The same contents read back with the cache off
+  auto *cae_config = WRP_CAE_CONF;
+  size_t old_cache_size = cae_config->GetVfdMetaCacheSize();
+  cae_config->SetVfdMetaCacheSize(0);
+  VerifyObjects(1000);
+  cae_config->SetVfdMetaCacheSize(old_cache_size);
+  stdfs::remove(kTestFile);
+}
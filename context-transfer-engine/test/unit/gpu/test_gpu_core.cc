@@ -515,6 +515,11 @@ extern "C" int run_gpu_initiated_putblob_getblob_test(
     wrp_cte::core::TagId tag_id,
     chi::u64 blob_size);
 
+extern "C" int run_gpu_warp_getblob_test(
+    chi::PoolId pool_id,
+    wrp_cte::core::TagId tag_id,
+    chi::u64 blob_size);
+
 /**
  * Test: GPU-initiated PutBlob + GetBlob roundtrip.
  *
@@ -538,6 +543,27 @@ TEST_CASE("GpuCore - GPU-Initiated PutBlob+GetBlob", "[gpu][cte][core]") {
   REQUIRE(result == 1);  // 1 = success from kernel
 }
 
+/**
+ * Test: warp-cooperative GetBlob into a registered kernel buffer.
+ *
+ * The bdev read lands directly in the kernel's own device memory and every
+ * lane of the warp sees the data once the future's completion flag is set.
+ */
+TEST_CASE("GpuCore - GPU-Initiated WarpGetBlob", "[gpu][cte][core]") {
+  auto *f = hshm::Singleton<GpuCoreGpuFixture>::GetInstance();
+  if (!g_gpu_initialized) {
+    INFO("GPU not available; skipping GPU-initiated test");
+    return;
+  }
+
+  const chi::u64 kSize = 4096;
+
+  int result = run_gpu_warp_getblob_test(f->core_pool_id_, f->tag_id_, kSize);
+
+  INFO("GPU-initiated WarpGetBlob result: " << result);
+  REQUIRE(result == 1);
+}
+
 #endif  // HSHM_ENABLE_CUDA || HSHM_ENABLE_ROCM
 
 // ============================================================================
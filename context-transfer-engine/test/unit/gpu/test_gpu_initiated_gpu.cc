@@ -51,6 +51,7 @@
 #include <cereal/types/vector.hpp>
 #include <cereal/types/string.hpp>
 #include <wrp_cte/core/core_client.h>
+#include <wrp_cte/core/warp_batch.h>
 #include <chimaera/chimaera.h>
 #include <chimaera/singletons.h>
 #include <hermes_shm/util/gpu_api.h>
@@ -136,6 +137,74 @@ __global__ void gpu_putblob_getblob_kernel(
   __threadfence_system();
 }
 
+/**
+ * GPU kernel: PutBlob, then a warp-cooperative GetBlob into a registered
+ * kernel buffer.
+ *
+ * Lane 0 stores the blob; all 32 lanes then call WarpGetBlob, which reads
+ * straight into out_data and returns on every lane once the FutureShm
+ * completion flag is set. Each lane checks its own stripe of the result.
+ */
+__global__ void gpu_warp_getblob_kernel(
+    chi::IpcManagerGpuInfo gpu_info,
+    chi::PoolId pool_id,
+    wrp_cte::core::TagId tag_id,
+    char *blob_data,
+    char *out_data,
+    chi::u64 blob_size,
+    int *d_result) {
+  CHIMAERA_GPU_INIT(gpu_info);
+
+  auto *ipc = CHI_IPC;
+  chi::u32 lane = chi::gpu::IpcManager::GetLaneId();
+
+  int put_rc = -2;
+  if (lane == 0) {
+    auto put_task = ipc->NewTask<wrp_cte::core::PutBlobTask>(
+        chi::CreateTaskId(), pool_id, chi::PoolQuery::Local(),
+        tag_id, "gpu_warp_get_blob", chi::u64(0), blob_size,
+        hipc::ShmPtr<>::FromRaw(blob_data), 0.5f,
+        wrp_cte::core::Context(), chi::u32(0));
+    if (!put_task.IsNull()) {
+      auto put_future = ipc->Send(put_task);
+      put_future.WaitGpu();
+      put_rc = static_cast<int>(put_task->GetReturnCode());
+    }
+  }
+  put_rc = __shfl_sync(0xFFFFFFFF, put_rc, 0);
+  if (put_rc != 0) {
+    if (lane == 0) {
+      *d_result = (put_rc < 0) ? put_rc : -10 - put_rc;
+      __threadfence_system();
+    }
+    return;
+  }
+
+  chi::gpu::GpuUserBuffer out_buf =
+      chi::gpu::IpcManager::RegisterUserBuffer(out_data, blob_size);
+  chi::u32 get_rc = wrp_cte::core::WarpGetBlob(
+      pool_id, chi::PoolQuery::Local(), tag_id, "gpu_warp_get_blob",
+      chi::u64(0), blob_size, out_buf, 0);
+  if (get_rc != 0) {
+    if (lane == 0) {
+      *d_result = -20 - static_cast<int>(get_rc);
+      __threadfence_system();
+    }
+    return;
+  }
+
+  // Every lane must already see the data without a hand-off from lane 0
+  bool ok = true;
+  for (chi::u64 i = lane; i < blob_size; i += 32) {
+    if (out_data[i] != blob_data[i]) ok = false;
+  }
+  bool all_ok = __all_sync(0xFFFFFFFF, ok);
+  if (lane == 0) {
+    *d_result = all_ok ? 1 : -4;
+    __threadfence_system();
+  }
+}
+
 /**
  * Host wrapper: launches the GPU-initiated PutBlob+GetBlob kernel.
  *
@@ -147,12 +216,11 @@ __global__ void gpu_putblob_getblob_kernel(
  * @param pool_id   CTE core pool ID
  * @param tag_id    Tag ID for the blob
  * @param blob_size Size of the test blob
+ * @param warp_get  Launch gpu_warp_getblob_kernel (one warp) instead
  * @return 1 on success, negative on error
  */
-extern "C" int run_gpu_initiated_putblob_getblob_test(
-    chi::PoolId pool_id,
-    wrp_cte::core::TagId tag_id,
-    chi::u64 blob_size) {
+static int RunPutGetKernel(chi::PoolId pool_id, wrp_cte::core::TagId tag_id,
+                           chi::u64 blob_size, bool warp_get) {
 
   // Use the orchestrator's shared allocator backend
   chi::IpcManagerGpuInfo gpu_info =
@@ -186,9 +254,15 @@ extern "C" int run_gpu_initiated_putblob_getblob_test(
   *d_result = 0;
 
   void *stream = hshm::GpuApi::CreateStream();
-  gpu_putblob_getblob_kernel<<<1, 1, 0, static_cast<cudaStream_t>(stream)>>>(
-      gpu_info, pool_id, tag_id, blob_data, out_data, blob_size,
-      const_cast<int *>(d_result));
+  if (warp_get) {
+    gpu_warp_getblob_kernel<<<1, 32, 0, static_cast<cudaStream_t>(stream)>>>(
+        gpu_info, pool_id, tag_id, blob_data, out_data, blob_size,
+        const_cast<int *>(d_result));
+  } else {
+    gpu_putblob_getblob_kernel<<<1, 1, 0, static_cast<cudaStream_t>(stream)>>>(
+        gpu_info, pool_id, tag_id, blob_data, out_data, blob_size,
+        const_cast<int *>(d_result));
+  }
 
   cudaError_t launch_err = cudaGetLastError();
   if (launch_err != cudaSuccess) {
@@ -222,4 +296,20 @@ extern "C" int run_gpu_initiated_putblob_getblob_test(
   return (result == 0) ? -4 : result;  // 0 means timeout
 }
 
+/** GPU-initiated PutBlob + GetBlob from a single thread */
+extern "C" int run_gpu_initiated_putblob_getblob_test(
+    chi::PoolId pool_id,
+    wrp_cte::core::TagId tag_id,
+    chi::u64 blob_size) {
+  return RunPutGetKernel(pool_id, tag_id, blob_size, false);
+}
+
+/** GPU-initiated PutBlob + WarpGetBlob into a registered kernel buffer */
+extern "C" int run_gpu_warp_getblob_test(
+    chi::PoolId pool_id,
+    wrp_cte::core::TagId tag_id,
+    chi::u64 blob_size) {
+  return RunPutGetKernel(pool_id, tag_id, blob_size, true);
+}
+
 #endif  // HSHM_ENABLE_CUDA || HSHM_ENABLE_ROCM
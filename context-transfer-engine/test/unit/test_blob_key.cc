@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "simple_test.h"
+#include <wrp_cte/core/blob_index.h>
+
+#include <string>
+#include <vector>
+
+using namespace wrp_cte::core;
+
+TEST_CASE("BlobKey - Borrowed And Owned Keys Match", "[cte][blob_key]") {
+  TagId tag(3, 7);
+  std::string name = "checkpoint.bin";
+  BlobKey lookup(tag, name);
+  BlobKey stored(lookup);
+  name.assign("overwritten!!!");
+  REQUIRE(stored == BlobKey(tag, "checkpoint.bin"));
+  REQUIRE(stored.Hash() == BlobKey(tag, "checkpoint.bin").Hash());
+  REQUIRE(stored.GetName() == "checkpoint.bin");
+  REQUIRE(stored.ToString() == "3.7.checkpoint.bin");
+  REQUIRE(stored.GetTagId() == tag);
+}
+
+TEST_CASE("BlobKey - Page Names Round Trip", "[cte][blob_key]") {
+  TagId tag(1, 2);
+  REQUIRE(BlobKey(tag, "0").GetName() == "0");
+  REQUIRE(BlobKey(tag, "18446744073").GetName() == "18446744073");
+  // Non-canonical numbers stay distinct names
+  REQUIRE(!(BlobKey(tag, "017") == BlobKey(tag, "17")));
+  REQUIRE(BlobKey(tag, "017").GetName() == "017");
+  REQUIRE(!(BlobKey(tag, "+1") == BlobKey(tag, "1")));
+}
+
+TEST_CASE("BlobKey - Tag Is Part Of The Key", "[cte][blob_key]") {
+  REQUIRE(!(BlobKey(TagId(1, 1), "a") == BlobKey(TagId(1, 2), "a")));
+  REQUIRE(!(BlobKey(TagId(1, 1), "5") == BlobKey(TagId(2, 1), "5")));
+  REQUIRE(BlobKey(TagId(1, 1), "5") == BlobKey(TagId(1, 1), "5"));
+}
+
+TEST_CASE("BlobMetadataIndex - Deferred Tags Load On First Touch",
+          "[cte][blob_key]") {
+  BlobMetadataIndex index(64, 4);
+  TagId loaded(1, 1), lazy(1, 2), dropped(1, 3);
+  index.InsertOrAssign(loaded, "a", BlobInfo());
+
+  std::vector<TagId> load_calls;
+  index.DeferTags({lazy, dropped}, [&](const TagId &tag_id) {
+    load_calls.push_back(tag_id);
+    std::vector<BlobPatch> patches(2);
+    for (size_t i = 0; i < patches.size(); ++i) {
+      patches[i].tag_id_ = tag_id;
+      patches[i].blob_name_ = "blob" + std::to_string(i);
+      patches[i].insert_ = true;
+    }
+    return patches;
+  });
+  REQUIRE(index.NumDeferredTags() == 2);
+  REQUIRE(index.IsDeferred(lazy));
+  REQUIRE(!index.IsDeferred(loaded));
+
+  // Operations on other tags and loaded-only walks leave deferred tags be
+  REQUIRE(index.Find(loaded, "a") != nullptr);
+  size_t visited = 0;
+  index.ForEachLoaded([&](const BlobKey &, BlobInfo &) { ++visited; });
+  REQUIRE(visited == 1);
+  REQUIRE(load_calls.empty());
+
+  // The first touch loads the tag, once
+  REQUIRE(index.Find(lazy, "blob1") != nullptr);
+  REQUIRE(index.TagBlobCount(lazy) == 2);
+  REQUIRE(load_calls.size() == 1);
+  REQUIRE(!index.IsDeferred(lazy));
+
+  // Erasing a deferred tag never loads it
+  REQUIRE(index.EraseTag(dropped) == 0);
+  REQUIRE(index.NumDeferredTags() == 0);
+  REQUIRE(load_calls.size() == 1);
+  REQUIRE(index.Find(dropped, "blob0") == nullptr);
+  REQUIRE(index.Size() == 3);
+}
+
+TEST_CASE("BlobMetadataIndex - Walks Load Every Deferred Tag",
+          "[cte][blob_key]") {
+  BlobMetadataIndex index(64, 4);
+  std::vector<TagId> tags;
+  for (chi::u32 i = 0; i < 8; ++i) {
+    tags.emplace_back(2, i);
+  }
+  index.DeferTags(tags, [](const TagId &tag_id) {
+    std::vector<BlobPatch> patches(1);
+    patches[0].tag_id_ = tag_id;
+    patches[0].blob_name_ = "only";
+    patches[0].insert_ = true;
+    return patches;
+  });
+  size_t visited = 0;
+  index.ForEach([&](const BlobKey &, BlobInfo &) { ++visited; });
+  REQUIRE(visited == tags.size());
+  REQUIRE(index.NumDeferredTags() == 0);
+  REQUIRE(index.ListTags().size() == tags.size());
+}
+
+SIMPLE_TEST_MAIN()
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "simple_test.h"
+#include <wrp_cte/core/blob_meta_table.h>
+
+#include <unistd.h>
+
+using namespace wrp_cte::core;
+
+static std::string TestSegmentName() {
+  return "wrp_cte_blob_meta_test_" + std::to_string(getpid());
+}
+
+static BlobMetaTable::Entry MakeEntry(chi::u64 size, float score) {
+  BlobMetaTable::Entry entry;
+  entry.size_ = size;
+  entry.score_ = score;
+  return entry;
+}
+
+TEST_CASE("BlobMetaTable - Published Entries Reach Attached Clients",
+          "[cte][blob_meta]") {
+  std::string name = TestSegmentName();
+  BlobMetaTable runtime;
+  REQUIRE(runtime.Create(name));
+  REQUIRE(runtime.Create(name));  // A second container reuses the table
+
+  BlobMetaTable client;
+  REQUIRE(client.Attach(name));
+  REQUIRE(client.IsLive());
+
+  TagId tag(7, 1);
+  BlobMetaTable::Entry entry;
+  REQUIRE(client.Lookup(tag, "blob", entry) ==
+          BlobMetaTable::LookupResult::kMiss);
+
+  auto ticket = runtime.GetTicket(tag, "blob");
+  REQUIRE(runtime.Publish(tag, "blob", ticket, MakeEntry(4096, 0.5f)));
+  REQUIRE(client.Lookup(tag, "blob", entry) ==
+          BlobMetaTable::LookupResult::kHit);
+  REQUIRE(entry.size_ == 4096);
+  REQUIRE(entry.score_ == 0.5f);
+
+  // Same name in another tag is a different blob
+  REQUIRE(client.Lookup(TagId(7, 2), "blob", entry) ==
+          BlobMetaTable::LookupResult::kMiss);
+
+  // A change drops the entry
+  runtime.Invalidate(tag, "blob");
+  REQUIRE(client.Lookup(tag, "blob", entry) ==
+          BlobMetaTable::LookupResult::kMiss);
+
+  // A runtime that leaves takes its entries with it
+  ticket = runtime.GetTicket(tag, "blob");
+  REQUIRE(runtime.Publish(tag, "blob", ticket, MakeEntry(1, 1.0f)));
+  runtime.Detach();
+  REQUIRE(!client.IsLive());
+  REQUIRE(client.Lookup(tag, "blob", entry) ==
+          BlobMetaTable::LookupResult::kMiss);
+  client.Detach();
+  BlobMetaTable late;
+  REQUIRE(!late.Attach(name));
+}
+
+TEST_CASE("BlobMetaTable - Changes Racing A Publish Win",
+          "[cte][blob_meta]") {
+  BlobMetaTable runtime;
+  REQUIRE(runtime.Create(TestSegmentName()));
+  TagId tag(3, 9);
+  BlobMetaTable::Entry entry;
+
+  // The blob changed after its BlobInfo was read: the old copy is refused
+  auto ticket = runtime.GetTicket(tag, "page_0");
+  runtime.Invalidate(tag, "page_0");
+  REQUIRE(!runtime.Publish(tag, "page_0", ticket, MakeEntry(10, 0.1f)));
+  REQUIRE(runtime.Lookup(tag, "page_0", entry) ==
+          BlobMetaTable::LookupResult::kMiss);
+
+  // A tag removal after the ticket leaves the copy stale
+  ticket = runtime.GetTicket(tag, "page_0");
+  runtime.InvalidateAll();
+  REQUIRE(runtime.Publish(tag, "page_0", ticket, MakeEntry(10, 0.1f)));
+  REQUIRE(runtime.Lookup(tag, "page_0", entry) ==
+          BlobMetaTable::LookupResult::kMiss);
+
+  // Names too long for a slot are never published
+  std::string long_name(BlobMetaTable::kMaxNameLen + 1, 'x');
+  ticket = runtime.GetTicket(tag, long_name);
+  REQUIRE(!runtime.Publish(tag, long_name, ticket, MakeEntry(1, 0)));
+}
+
+TEST_CASE("BlobMetaTable - Unmapped Table Misses", "[cte][blob_meta]") {
+  BlobMetaTable table;
+  BlobMetaTable::Entry entry;
+  REQUIRE(!table.IsLive());
+  auto ticket = table.GetTicket(TagId(1, 1), "blob");
+  REQUIRE(!table.Publish(TagId(1, 1), "blob", ticket, MakeEntry(1, 0)));
+  table.Invalidate(TagId(1, 1), "blob");
+  REQUIRE(table.Lookup(TagId(1, 1), "blob", entry) ==
+          BlobMetaTable::LookupResult::kMiss);
+}
+
+SIMPLE_TEST_MAIN()
@@ -1,7 +1,9 @@
 #include "simple_test.h"
 #include <wrp_cte/core/core_config.h>
 #include <wrp_cte/core/core_dpe.h>
+#include <wrp_cte/core/core_eviction.h>
 #include <fstream>
+#include <cmath>
 #include <cstdlib>
 #include <filesystem>
 
@@ -661,6 +663,104 @@ TEST_CASE("MaxBwDpe SelectTargets - Score Filtering", "[cte][dpe]") {
   REQUIRE(result.size() > 0);
 }
 
+TEST_CASE("MinCompletionDpe SelectTargets - Avoids Busy Target", "[cte][dpe]") {
+  MinCompletionDpe dpe;
+  std::vector<TargetInfo> targets;
+
+  // The faster target has 1GB queued, so the slower idle one finishes first
+  for (int i = 0; i < 2; i++) {
+    TargetInfo target;
+    target.remaining_space_ = 1ULL * 1024 * 1024 * 1024;
+    target.target_score_ = 0.3f;
+    target.perf_metrics_.write_bandwidth_mbps_ = i == 0 ? 1000.0 : 500.0;
+    target.perf_metrics_.write_latency_us_ = 50.0;
+    target.inflight_bytes_ = i == 0 ? 1ULL * 1024 * 1024 * 1024 : 0;
+    targets.push_back(target);
+  }
+
+  std::vector<TargetInfo> result = dpe.SelectTargets(targets, 0.5f, 64 * 1024);
+  REQUIRE(result.size() == 2);
+  REQUIRE(result[0].perf_metrics_.write_bandwidth_mbps_ < 600.0);
+  REQUIRE(dpe.GetPlacementSizes().empty());
+}
+
+TEST_CASE("MinCompletionDpe SelectTargets - Stripes Large Blobs", "[cte][dpe]") {
+  MinCompletionDpe dpe;
+  std::vector<TargetInfo> targets;
+
+  for (int i = 0; i < 3; i++) {
+    TargetInfo target;
+    target.remaining_space_ = 1ULL * 1024 * 1024 * 1024;
+    target.target_score_ = i < 2 ? 0.3f : 0.9f;
+    target.perf_metrics_.write_bandwidth_mbps_ = 1000.0;
+    target.perf_metrics_.write_latency_us_ = 50.0;
+    targets.push_back(target);
+  }
+
+  // Two equal idle targets in the preferred tier split 64MB evenly; the
+  // higher-scored target is only a fallback
+  chi::u64 data_size = 64ULL * 1024 * 1024;
+  std::vector<TargetInfo> result = dpe.SelectTargets(targets, 0.5f, data_size);
+  const std::vector<chi::u64> &sizes = dpe.GetPlacementSizes();
+  REQUIRE(result.size() == 3);
+  REQUIRE(sizes.size() == 3);
+  REQUIRE(sizes[0] + sizes[1] == data_size);
+  REQUIRE(sizes[0] == data_size / 2);
+  REQUIRE(sizes[2] == 0);
+  REQUIRE(result[2].target_score_ > 0.5f);
+}
+
+TEST_CASE("MinCompletionDpe SelectTargets - Uses Fitted Curve", "[cte][dpe]") {
+  MinCompletionDpe dpe;
+  std::vector<TargetInfo> targets;
+
+  // Both report 1000 MB/s, but the first bdev's fitted curve says 100 MB/s
+  for (int i = 0; i < 2; i++) {
+    TargetInfo target;
+    target.remaining_space_ = 1ULL * 1024 * 1024 * 1024;
+    target.target_score_ = 0.3f;
+    target.perf_metrics_.write_bandwidth_mbps_ = 1000.0;
+    target.perf_metrics_.write_latency_us_ = 50.0;
+    if (i == 0) {
+      target.perf_model_.write_.base_us_ = 50.0;
+      target.perf_model_.write_.us_per_mb_ = 10000.0;
+    }
+    targets.push_back(target);
+  }
+
+  chi::u64 mb = 1024 * 1024;
+  REQUIRE(std::abs(MinCompletionDpe::PredictFinishUs(targets[0], mb) -
+                   10050.0) < 1e-6);
+  std::vector<TargetInfo> result = dpe.SelectTargets(targets, 0.5f, mb);
+  REQUIRE(result.size() == 2);
+  REQUIRE_FALSE(result[0].perf_model_.write_.IsFitted());
+}
+
+TEST_CASE("MaxBwDpe SelectTargets - Ranks By Fitted Curves", "[cte][dpe]") {
+  MaxBwDpe dpe;
+  std::vector<TargetInfo> targets;
+
+  // The first target has the lower fixed cost, the second the higher
+  // bandwidth: small blobs go to the first, large ones to the second
+  for (int i = 0; i < 2; i++) {
+    TargetInfo target;
+    target.remaining_space_ = 1ULL * 1024 * 1024 * 1024;
+    target.target_score_ = 0.3f;
+    target.perf_model_.write_.base_us_ = i == 0 ? 10.0 : 500.0;
+    target.perf_model_.write_.us_per_mb_ = i == 0 ? 5000.0 : 500.0;
+    target.perf_model_.read_ = target.perf_model_.write_;
+    targets.push_back(target);
+  }
+
+  std::vector<TargetInfo> small = dpe.SelectTargets(targets, 0.5f, 4096);
+  REQUIRE(small.size() == 2);
+  REQUIRE(small[0].perf_model_.write_.base_us_ == 10.0);
+  std::vector<TargetInfo> large =
+      dpe.SelectTargets(targets, 0.5f, 16ULL * 1024 * 1024);
+  REQUIRE(large.size() == 2);
+  REQUIRE(large[0].perf_model_.write_.base_us_ == 500.0);
+}
+
 TEST_CASE("DpeFactory CreateDpe - By Enum kRandom", "[cte][dpe]") {
   auto dpe = DpeFactory::CreateDpe(DpeType::kRandom);
   REQUIRE(dpe != nullptr);
@@ -709,6 +809,13 @@ TEST_CASE("DpeFactory CreateDpe - By String maxbw (no underscore)", "[cte][dpe]"
   REQUIRE(dpe->GetType() == DpeType::kMaxBW);
 }
 
+TEST_CASE("DpeFactory CreateDpe - By String min_completion", "[cte][dpe]") {
+  auto dpe = DpeFactory::CreateDpe("min_completion");
+  REQUIRE(dpe != nullptr);
+  REQUIRE(dpe->GetType() == DpeType::kMinCompletion);
+  REQUIRE(DpeTypeToString(DpeType::kMinCompletion) == "min_completion");
+}
+
 TEST_CASE("DpeFactory CreateDpe - Invalid String", "[cte][dpe]") {
   auto dpe = DpeFactory::CreateDpe("invalid_type");
   // Should default to RandomDpe
@@ -716,4 +823,133 @@ TEST_CASE("DpeFactory CreateDpe - Invalid String", "[cte][dpe]") {
   REQUIRE(dpe->GetType() == DpeType::kRandom);
 }
 
+// ============================================================================
+// Eviction Policy Tests
+// ============================================================================
+
+// Helper building one blob as an eviction pass sees it
+EvictionCandidate MakeCandidate(const std::string& name, Timestamp last_access,
+                                chi::u64 reads, bool resident = true) {
+  BlobKey key(TagId(1, 0), name);
+  EvictionCandidate candidate;
+  candidate.key_ = key;  // Copy assignment owns the name
+  candidate.size_ = 1024;
+  candidate.last_access_ = last_access;
+  candidate.reads_ = reads;
+  candidate.resident_ = resident;
+  return candidate;
+}
+
+std::vector<std::string> RankedNames(EvictionPolicy& policy,
+                                     std::vector<EvictionCandidate> victims) {
+  policy.RankVictims(victims);
+  std::vector<std::string> names;
+  for (const auto& victim : victims) {
+    names.push_back(victim.key_.GetName());
+  }
+  return names;
+}
+
+TEST_CASE("EvictionPolicyFactory CreatePolicy - By String", "[cte][eviction]") {
+  REQUIRE(EvictionPolicyFactory::CreatePolicy("lru")->GetType() ==
+          EvictionPolicyType::kLru);
+  REQUIRE(EvictionPolicyFactory::CreatePolicy("lfu")->GetType() ==
+          EvictionPolicyType::kLfu);
+  REQUIRE(EvictionPolicyFactory::CreatePolicy("arc")->GetType() ==
+          EvictionPolicyType::kArc);
+  // Unknown names fall back to ARC
+  REQUIRE(EvictionPolicyFactory::CreatePolicy("fifo")->GetType() ==
+          EvictionPolicyType::kArc);
+  REQUIRE(EvictionPolicyTypeToString(EvictionPolicyType::kLfu) == "lfu");
+}
+
+TEST_CASE("LruEvictionPolicy RankVictims - Oldest First", "[cte][eviction]") {
+  LruEvictionPolicy policy;
+  std::vector<EvictionCandidate> blobs = {MakeCandidate("a", 30, 0),
+                                          MakeCandidate("b", 10, 5),
+                                          MakeCandidate("c", 20, 0)};
+  policy.Update(blobs, 1 << 20);
+  auto names = RankedNames(policy, blobs);
+  REQUIRE(names == std::vector<std::string>({"b", "c", "a"}));
+}
+
+TEST_CASE("LfuEvictionPolicy RankVictims - Least Read First", "[cte][eviction]") {
+  LfuEvictionPolicy policy;
+  std::vector<EvictionCandidate> blobs = {MakeCandidate("hot", 10, 8),
+                                          MakeCandidate("warm", 30, 2),
+                                          MakeCandidate("cold", 20, 0)};
+  policy.Update(blobs, 1 << 20);
+  auto names = RankedNames(policy, blobs);
+  REQUIRE(names == std::vector<std::string>({"cold", "warm", "hot"}));
+
+  // Read counts age: after enough idle passes a fresh reader wins
+  for (auto& blob : blobs) blob.reads_ = 0;
+  for (int pass = 0; pass < 6; ++pass) policy.Update(blobs, 1 << 20);
+  blobs[0].reads_ = 0;
+  blobs[2].reads_ = 1;
+  policy.Update(blobs, 1 << 20);
+  names = RankedNames(policy, blobs);
+  REQUIRE(names.front() == "warm");
+  REQUIRE(names.back() == "cold");
+}
+
+TEST_CASE("ArcEvictionPolicy RankVictims - Scan Resistant", "[cte][eviction]") {
+  ArcEvictionPolicy policy;
+  const chi::u64 cache_bytes = 8 * 1024;
+
+  // The working set is written, then read again: it moves to T2
+  std::vector<EvictionCandidate> blobs = {MakeCandidate("work0", 10, 0),
+                                          MakeCandidate("work1", 11, 0)};
+  policy.Update(blobs, cache_bytes);
+  blobs[0] = MakeCandidate("work0", 20, 1);
+  blobs[1] = MakeCandidate("work1", 21, 1);
+
+  // A scan then writes newer blobs that are never read again
+  for (int i = 0; i < 3; ++i) {
+    blobs.push_back(MakeCandidate("scan" + std::to_string(i), 30 + i, 0));
+  }
+  policy.Update(blobs, cache_bytes);
+  auto names = RankedNames(policy, blobs);
+  REQUIRE(names == std::vector<std::string>(
+                       {"scan0", "scan1", "scan2", "work0", "work1"}));
+
+  // LRU would have evicted the working set first
+  LruEvictionPolicy lru;
+  REQUIRE(RankedNames(lru, blobs).front() == "work0");
+}
+
+TEST_CASE("ArcEvictionPolicy Update - Ghost Hits Adapt", "[cte][eviction]") {
+  ArcEvictionPolicy policy;
+  const chi::u64 cache_bytes = 8 * 1024;
+  std::vector<EvictionCandidate> blobs = {MakeCandidate("recent", 10, 0),
+                                          MakeCandidate("frequent", 10, 1)};
+  policy.Update(blobs, cache_bytes);
+  policy.OnEvict(blobs[0].key_);
+  policy.OnEvict(blobs[1].key_);
+  REQUIRE(policy.GetRecencyTarget() == 0.0);
+
+  // Reading a blob evicted from T1 gives T1 more room
+  blobs[0] = MakeCandidate("recent", 20, 1, false);
+  blobs[1] = MakeCandidate("frequent", 10, 0, false);
+  policy.Update(blobs, cache_bytes);
+  double grown = policy.GetRecencyTarget();
+  REQUIRE(grown > 0.0);
+
+  // Reading a blob evicted from T2 takes it back
+  blobs[1] = MakeCandidate("frequent", 30, 1, false);
+  policy.Update(blobs, cache_bytes);
+  REQUIRE(policy.GetRecencyTarget() < grown);
+}
+
+TEST_CASE("Config Validate - Eviction Watermarks", "[cte][eviction]") {
+  Config config;
+  REQUIRE(config.Validate());
+  config.performance_.evict_low_watermark_ = 0.95f;  // Above the high mark
+  REQUIRE_FALSE(config.Validate());
+  config.performance_.evict_period_ms_ = 0;  // Off: not checked
+  REQUIRE(config.Validate());
+  config.performance_.evict_policy_ = "fifo";
+  REQUIRE_FALSE(config.Validate());
+}
+
 SIMPLE_TEST_MAIN()
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "simple_test.h"
+#include <chimaera/expiry_wheel.h>
+
+#include <map>
+#include <vector>
+
+using chi::ExpiryWheel;
+
+static constexpr chi::u64 kTick = 1000;
+
+TEST_CASE("ExpiryWheel - Fires At Deadline", "[cte][expiry_wheel]") {
+  ExpiryWheel<int> wheel(kTick, 16);
+  wheel.Schedule(1, 5500);
+  wheel.Schedule(2, 7200);
+  wheel.Schedule(3, 5900);
+
+  std::vector<int> fired;
+  auto collect = [&](int key, chi::u64) { fired.push_back(key); };
+  REQUIRE(wheel.Advance(5000, collect) == 0);
+  // Same tick as a deadline, but before it
+  REQUIRE(wheel.Advance(5400, collect) == 0);
+  REQUIRE(wheel.Advance(6000, collect) == 2);
+  REQUIRE(fired.size() == 2);
+  REQUIRE(wheel.Size() == 1);
+  REQUIRE(wheel.Advance(7200, collect) == 1);
+  REQUIRE(fired.back() == 2);
+  REQUIRE(wheel.Size() == 0);
+}
+
+TEST_CASE("ExpiryWheel - Deadlines Past One Revolution", "[cte][expiry_wheel]") {
+  ExpiryWheel<int> wheel(kTick, 8);
+  // Same slot as tick 2, three revolutions later
+  wheel.Schedule(7, 26 * kTick);
+
+  std::vector<int> fired;
+  auto collect = [&](int key, chi::u64) { fired.push_back(key); };
+  for (chi::u64 t = 0; t < 26; ++t) {
+    wheel.Advance(t * kTick + kTick / 2, collect);
+  }
+  REQUIRE(fired.empty());
+  wheel.Advance(26 * kTick, collect);
+  REQUIRE(fired.size() == 1);
+  REQUIRE(fired[0] == 7);
+}
+
+TEST_CASE("ExpiryWheel - Long Gap Visits Every Slot", "[cte][expiry_wheel]") {
+  ExpiryWheel<int> wheel(kTick, 8);
+  wheel.Advance(0, [](int, chi::u64) {});
+  for (int i = 0; i < 32; ++i) {
+    wheel.Schedule(i, static_cast<chi::u64>(i) * kTick);
+  }
+  std::map<int, chi::u64> fired;
+  auto collect = [&](int key, chi::u64 deadline) { fired[key] = deadline; };
+  // Far more than a revolution later, only due entries fire
+  REQUIRE(wheel.Advance(20 * kTick, collect) == 21);
+  REQUIRE(fired.size() == 21);
+  REQUIRE(fired.count(20) == 1);
+  REQUIRE(fired.count(21) == 0);
+  REQUIRE(wheel.Advance(100 * kTick, collect) == 11);
+  REQUIRE(wheel.Size() == 0);
+}
+
+TEST_CASE("ExpiryWheel - Late Schedule Fires Next Advance",
+          "[cte][expiry_wheel]") {
+  ExpiryWheel<int> wheel(kTick, 8);
+  wheel.Advance(10 * kTick, [](int, chi::u64) {});
+  // Deadline in a tick that was already visited
+  wheel.Schedule(4, 3 * kTick);
+  size_t fired = wheel.Advance(10 * kTick + 1, [](int, chi::u64) {});
+  REQUIRE(fired == 1);
+}
+
+SIMPLE_TEST_MAIN()
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "simple_test.h"
+#include <wrp_cte/core/hash_ring.h>
+
+#include <set>
+
+using namespace wrp_cte::core;
+
+// Spread test keys over the full 32-bit range
+static chi::u32 KeyHash(chi::u32 i) { return i * 2654435761u; }
+
+TEST_CASE("HashRing - Weight Change Moves Few Keys", "[cte][ring]") {
+  HashRing before(std::vector<chi::u32>(8, 1), 64);
+  std::vector<chi::u32> weights(8, 1);
+  weights[3] = 2;
+  HashRing after(weights, 64);
+
+  const chi::u32 kKeys = 20000;
+  chi::u32 moved = 0;
+  for (chi::u32 i = 0; i < kKeys; ++i) {
+    chi::ContainerId old_owner = before.Lookup(KeyHash(i));
+    chi::ContainerId new_owner = after.Lookup(KeyHash(i));
+    if (old_owner != new_owner) {
+      ++moved;
+      // Keys only move to the container that gained weight
+      REQUIRE(new_owner == 3);
+    }
+  }
+  // Modulo hashing over a changed node count would move most keys
+  REQUIRE(moved > 0);
+  REQUIRE(moved < kKeys / 4);
+}
+
+TEST_CASE("HashRing - Zero Weight Owns Nothing", "[cte][ring]") {
+  HashRing ring({1, 0, 1, 1}, 32);
+  REQUIRE(!ring.Empty());
+  for (chi::u32 i = 0; i < 5000; ++i) {
+    REQUIRE(ring.Lookup(KeyHash(i)) != 1);
+  }
+  REQUIRE(HashRing({0, 0}, 32).Empty());
+  REQUIRE(HashRing({1, 1}, 0).Empty());
+}
+
+TEST_CASE("HashRing - Successors Are Distinct", "[cte][ring]") {
+  HashRing ring({1, 1, 1, 0, 1}, 16);
+  for (chi::u32 i = 0; i < 1000; ++i) {
+    std::vector<chi::ContainerId> ids = ring.Successors(KeyHash(i), 3);
+    REQUIRE(ids.size() == 3);
+    REQUIRE(ids[0] == ring.Lookup(KeyHash(i)));
+    std::set<chi::ContainerId> unique(ids.begin(), ids.end());
+    REQUIRE(unique.size() == 3);
+    REQUIRE(unique.count(3) == 0);
+  }
+  // Asking for more containers than have weight returns each once
+  REQUIRE(ring.Successors(KeyHash(7), 10).size() == 4);
+}
+
+TEST_CASE("HashRing - Weights Skew Ownership", "[cte][ring]") {
+  HashRing ring({1, 3}, 128);
+  chi::u32 owned[2] = {0, 0};
+  for (chi::u32 i = 0; i < 20000; ++i) {
+    owned[ring.Lookup(KeyHash(i))]++;
+  }
+  REQUIRE(owned[1] > owned[0] * 2);
+}
+
+SIMPLE_TEST_MAIN()
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "simple_test.h"
+#include <wrp_cte/core/metadata_lease.h>
+
+#include <unistd.h>
+
+using namespace wrp_cte::core;
+
+static std::string TestSegmentName() {
+  return "wrp_cte_lease_test_" + std::to_string(getpid());
+}
+
+TEST_CASE("MetadataLeaseTable - Revocations Reach Attached Clients",
+          "[cte][lease]") {
+  std::string name = TestSegmentName();
+  MetadataLeaseTable runtime;
+  REQUIRE(runtime.Create(name));
+  REQUIRE(runtime.Create(name));  // A second container reuses the table
+  REQUIRE(runtime.IsLive());
+
+  MetadataLeaseTable client;
+  REQUIRE(client.Attach(name));
+  REQUIRE(client.IsLive());
+
+  TagId a(7, 1), b(7, 2);
+  chi::u64 a0 = client.GetVersion(a);
+  chi::u64 b0 = client.GetVersion(b);
+  runtime.Revoke(a);
+  REQUIRE(client.GetVersion(a) == a0 + 1);
+  runtime.Revoke(a);
+  REQUIRE(client.GetVersion(a) == a0 + 2);
+  // Another tag only moves if it happens to share the slot
+  REQUIRE(client.GetVersion(b) == b0 ||
+          client.GetVersion(b) == client.GetVersion(a));
+
+  // A client still mapping the table sees the runtime leave
+  runtime.Detach();
+  REQUIRE(!runtime.IsLive());
+  REQUIRE(!client.IsLive());
+  client.Detach();
+  MetadataLeaseTable late;
+  REQUIRE(!late.Attach(name));
+}
+
+TEST_CASE("MetadataLeaseTable - Unmapped Table Reports Version Zero",
+          "[cte][lease]") {
+  MetadataLeaseTable table;
+  REQUIRE(!table.IsLive());
+  table.Revoke(TagId(1, 1));
+  REQUIRE(table.GetVersion(TagId(1, 1)) == 0);
+}
+
+SIMPLE_TEST_MAIN()
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "simple_test.h"
+#include <wrp_cte/core/pack_segments.h>
+
+#include <vector>
+
+using namespace wrp_cte::core;
+
+static const chi::PoolId kTarget(900, 0);
+static const chi::PoolId kOther(901, 0);
+static constexpr chi::u64 kSegSize = 64 * 1024;
+
+TEST_CASE("PackSegments - Appends Off Unit Boundaries",
+          "[cte][pack_segments]") {
+  PackSegmentTable table;
+  chi::u64 id = table.Add(kTarget, 1024 * 1024, kSegSize);
+  REQUIRE(id != 0);
+
+  chi::u64 prev_end = 0;
+  // Enough objects to cross several 4KB units
+  for (int i = 0; i < 100; ++i) {
+    chi::u64 offset = 0;
+    chi::u64 size = 100 + i * 7;
+    REQUIRE(table.Reserve(id, size, offset));
+    REQUIRE(offset >= prev_end);
+    REQUIRE(offset % PackSegmentTable::kAlign == 0);
+    REQUIRE(PackSegmentTable::IsPackedOffset(1024 * 1024 + offset));
+    prev_end = offset + size;
+  }
+  PackSegment *seg = table.Get(id);
+  REQUIRE(seg->fill_ == prev_end);
+  REQUIRE(seg->live_objects_ == 100);
+  REQUIRE(!PackSegmentTable::IsPackedOffset(1024 * 1024));
+}
+
+TEST_CASE("PackSegments - Full And Sealed Segments Refuse",
+          "[cte][pack_segments]") {
+  PackSegmentTable table;
+  chi::u64 id = table.Add(kTarget, 0, 8192);
+  chi::u64 offset = 0;
+  REQUIRE(table.Reserve(id, 4000, offset));
+  REQUIRE(table.Reserve(id, 4000, offset));
+  // Only 184 bytes are left
+  REQUIRE(!table.Reserve(id, 200, offset));
+  REQUIRE(table.Reserve(id, 64, offset));
+  table.Seal(id);
+  REQUIRE(!table.Reserve(id, 8, offset));
+}
+
+TEST_CASE("PackSegments - Find By Extent", "[cte][pack_segments]") {
+  PackSegmentTable table;
+  chi::u64 a = table.Add(kTarget, 0, kSegSize);
+  chi::u64 b = table.Add(kTarget, kSegSize, kSegSize);
+  chi::u64 c = table.Add(kOther, 0, kSegSize);
+  chi::u64 off_a = 0, off_b = 0, off_c = 0;
+  REQUIRE(table.Reserve(a, 500, off_a));
+  REQUIRE(table.Reserve(b, 500, off_b));
+  REQUIRE(table.Reserve(c, 500, off_c));
+
+  REQUIRE(table.Find(kTarget, off_a, 500) == a);
+  REQUIRE(table.Find(kTarget, kSegSize + off_b, 500) == b);
+  REQUIRE(table.Find(kOther, off_c, 500) == c);
+  // Past the appended bytes, or on an untracked target
+  REQUIRE(table.Find(kTarget, off_a + 500, 8) == 0);
+  REQUIRE(table.Find(chi::PoolId(902, 0), off_a, 500) == 0);
+}
+
+TEST_CASE("PackSegments - Reclaim After Last Release",
+          "[cte][pack_segments]") {
+  PackSegmentTable table;
+  chi::u64 id = table.Add(kTarget, 0, kSegSize);
+  chi::u64 off1 = 0, off2 = 0;
+  REQUIRE(table.Reserve(id, 1000, off1));
+  REQUIRE(table.Reserve(id, 2000, off2));
+
+  // An open segment is never reclaimed, even when empty
+  REQUIRE(!table.Release(id, 1000));
+  REQUIRE(table.Get(id)->live_bytes_ == 2000);
+  table.Seal(id);
+  table.Get(id)->flushing_ = true;
+  REQUIRE(!table.Release(id, 2000));
+  table.Get(id)->flushing_ = false;
+  REQUIRE(PackSegmentTable::IsReclaimable(*table.Get(id)));
+
+  PackSegment removed;
+  REQUIRE(table.Remove(id, removed));
+  REQUIRE(removed.base_ == 0);
+  REQUIRE(table.Size() == 0);
+  REQUIRE(table.Get(id) == nullptr);
+  REQUIRE(table.Find(kTarget, off2, 2000) == 0);
+}
+
+TEST_CASE("PackSegments - Sparse Segments Sparsest First",
+          "[cte][pack_segments]") {
+  PackSegmentTable table;
+  std::vector<chi::u64> ids;
+  for (int s = 0; s < 3; ++s) {
+    chi::u64 id = table.Add(kTarget, s * kSegSize, kSegSize);
+    ids.push_back(id);
+    chi::u64 offset = 0;
+    for (int i = 0; i < 16; ++i) {
+      REQUIRE(table.Reserve(id, 4000, offset));
+    }
+    table.Seal(id);
+    table.Get(id)->durable_ = table.Get(id)->fill_;
+  }
+  // Leave 2, 8 and 16 of 16 objects live
+  for (int i = 0; i < 14; ++i) table.Release(ids[0], 4000);
+  for (int i = 0; i < 8; ++i) table.Release(ids[1], 4000);
+
+  std::vector<chi::u64> sparse;
+  table.CollectSparse(0.5, sparse);
+  REQUIRE(sparse.size() == 2);
+  REQUIRE(sparse[0] == ids[0]);
+  REQUIRE(sparse[1] == ids[1]);
+
+  // Bytes not yet written out keep a segment from being cleaned
+  table.Get(ids[0])->durable_ = 0;
+  table.CollectSparse(0.5, sparse);
+  REQUIRE(sparse.size() == 1);
+  REQUIRE(sparse[0] == ids[1]);
+}
+
+TEST_CASE("PackSegments - Restored Segments Recount Live Objects",
+          "[cte][pack_segments]") {
+  PackSegmentTable table;
+  chi::u64 kept = table.Restore(kTarget, 0, kSegSize);
+  chi::u64 empty = table.Restore(kTarget, kSegSize, kSegSize);
+  REQUIRE(table.Get(kept)->sealed_);
+  REQUIRE(table.Get(kept)->durable_ == kSegSize);
+  // Any extent inside a restored segment resolves to it
+  REQUIRE(table.Find(kTarget, 4096, 1000) == kept);
+  table.Retain(kept, 1000);
+  table.Retain(kept, 3000);
+  REQUIRE(table.Get(kept)->live_bytes_ == 4000);
+
+  std::vector<chi::u64> reclaimable;
+  table.CollectReclaimable(reclaimable);
+  REQUIRE(reclaimable.size() == 1);
+  REQUIRE(reclaimable[0] == empty);
+  REQUIRE(!table.Release(kept, 1000));
+  REQUIRE(table.Release(kept, 3000));
+}
+
+SIMPLE_TEST_MAIN()
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "simple_test.h"
+#include <wrp_cte/core/qos_scheduler.h>
+
+#include <deque>
+
+using namespace wrp_cte::core;
+
+static constexpr chi::u64 kSec = 1000000000ULL;
+static constexpr chi::u64 kMB = 1024ULL * 1024ULL;
+
+static QosClassConfig MakeClass(const std::string &name, chi::u32 weight,
+                                chi::u64 rate, chi::u64 burst) {
+  QosClassConfig config;
+  config.name_ = name;
+  config.weight_ = weight;
+  config.rate_ = rate;
+  config.burst_ = burst;
+  return config;
+}
+
+TEST_CASE("QosScheduler - Unlimited Admits Immediately", "[cte][qos]") {
+  QosScheduler qos;
+  REQUIRE(!qos.Enabled());
+  qos.Configure({MakeClass("any", 1, 0, kMB)});
+  REQUIRE(qos.Enabled());
+
+  chi::PoolId target(512, 1);
+  for (int i = 0; i < 100; ++i) {
+    auto ticket = qos.Enqueue(1, target, 64 * kMB, kSec + i);
+    REQUIRE(qos.TryAdmit(ticket, kSec + i) == 0);
+  }
+  auto stats = qos.GetTelemetry();
+  REQUIRE(stats.size() == 2);
+  REQUIRE(stats[1].requests_ == 100);
+  REQUIRE(stats[1].queued_ == 0);
+}
+
+TEST_CASE("QosScheduler - Class Rate Limit", "[cte][qos]") {
+  QosScheduler qos;
+  qos.Configure({MakeClass("slow", 1, kMB, kMB)});
+  chi::PoolId target(512, 1);
+
+  auto first = qos.Enqueue(1, target, kMB, kSec);
+  REQUIRE(qos.TryAdmit(first, kSec) == 0);
+  auto second = qos.Enqueue(1, target, kMB, kSec);
+  REQUIRE(qos.TryAdmit(second, kSec) > 0);
+  REQUIRE(qos.TryAdmit(second, kSec + kSec / 2) > 0);
+  REQUIRE(qos.TryAdmit(second, 2 * kSec) == 0);
+
+  auto stats = qos.GetTelemetry();
+  REQUIRE(stats[1].requests_ == 2);
+  REQUIRE(stats[1].bytes_ == 2 * kMB);
+  REQUIRE(stats[1].max_wait_ns_ == kSec);
+}
+
+TEST_CASE("QosScheduler - Weighted Share Of A Busy Target", "[cte][qos]") {
+  QosScheduler qos;
+  qos.Configure({MakeClass("heavy", 3, 0, kMB), MakeClass("light", 1, 0, kMB)});
+  chi::PoolId target(512, 1);
+  const chi::u64 kIo = 64 * 1024;
+  qos.SetTargetRate(target, kMB, kIo);
+
+  // Both classes keep 40 submissions waiting on the target
+  std::deque<QosScheduler::Ticket> waiting;
+  for (int i = 0; i < 40; ++i) {
+    waiting.push_back(qos.Enqueue(1, target, kIo, kSec));
+    waiting.push_back(qos.Enqueue(2, target, kIo, kSec));
+  }
+  int admitted[3] = {0, 0, 0};
+  chi::u64 now = kSec;
+  while (admitted[1] + admitted[2] < 40) {
+    now += kSec / 1000;
+    for (auto it = waiting.begin(); it != waiting.end();) {
+      if (qos.TryAdmit(*it, now) == 0) {
+        admitted[it->class_id_]++;
+        it = waiting.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  REQUIRE(admitted[1] >= 28 && admitted[1] <= 32);
+  REQUIRE(admitted[2] >= 8 && admitted[2] <= 12);
+}
+
+TEST_CASE("QosScheduler - Throttled Class Does Not Block Others",
+          "[cte][qos]") {
+  QosScheduler qos;
+  qos.Configure({MakeClass("capped", 1, kMB, kMB), MakeClass("free", 1, 0, kMB)});
+  chi::PoolId target(512, 1);
+
+  auto drain = qos.Enqueue(1, target, kMB, kSec);
+  REQUIRE(qos.TryAdmit(drain, kSec) == 0);
+  // The capped class queues first and so holds the smaller finish tag
+  auto capped = qos.Enqueue(1, target, 4096, kSec);
+  auto other = qos.Enqueue(2, target, kMB, kSec);
+  REQUIRE(qos.TryAdmit(capped, kSec) > 0);
+  REQUIRE(qos.TryAdmit(other, kSec) == 0);
+  REQUIRE(qos.GetTelemetry()[1].queued_ == 1);
+}
+
+TEST_CASE("QosScheduler - Tags Select Classes", "[cte][qos]") {
+  QosScheduler qos;
+  QosClassConfig ckpt = MakeClass("checkpoint", 1, 0, kMB);
+  ckpt.tag_patterns_ = {".*\\.ckpt$"};
+  QosClassConfig home = MakeClass("interactive", 4, 0, kMB);
+  home.tag_patterns_ = {"^/home/.*"};
+  qos.Configure({ckpt, home});
+
+  TagId ckpt_tag(1, 1), home_tag(1, 2), other_tag(1, 3);
+  qos.AssignTag(ckpt_tag, "/scratch/run.ckpt");
+  qos.AssignTag(home_tag, "/home/user/notes.txt");
+  qos.AssignTag(other_tag, "/scratch/out.dat");
+  REQUIRE(qos.GetTagClass(ckpt_tag) == 1);
+  REQUIRE(qos.GetTagClass(home_tag) == 2);
+  REQUIRE(qos.GetTagClass(other_tag) == 0);
+  REQUIRE(qos.GetTagClass(TagId(9, 9)) == 0);
+}
+
+SIMPLE_TEST_MAIN()
@@ -43,6 +43,7 @@
  * 2. BlobQuery with tag and blob regex combinations
  * 3. Broadcast pool query behavior
  * 4. Empty result sets and edge cases
+ * 5. Pagination cursors and pattern classification
  *
  * Following CLAUDE.md requirements:
  * - Use simple_test.h framework (NOT Catch2 - Catch2 causes segfaults with Chimaera runtime)
@@ -76,6 +77,7 @@
  #include <wrp_cte/core/core_client.h>
  #include <wrp_cte/core/core_runtime.h>
  #include <wrp_cte/core/core_tasks.h>
+ #include <wrp_cte/core/name_pattern.h>
 
  namespace fs = std::filesystem;
 
@@ -547,5 +549,79 @@
    REQUIRE(blob_results.size() > 0);
  }
 
+/**
+ * Test BlobQuery pagination with early termination and cursors
+ */
+TEST_CASE("BlobQuery - Pagination", "[query][blobquery][pagination]") {
+  auto *fixture = hshm::Singleton<CTEQueryTestFixture>::GetInstance();
+  (void)fixture; // Suppress unused variable warning
+  INFO("Testing BlobQuery pagination cursors");
+
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto unpaged = CTEQueryTestFixture::BlobQueryAsync(
+      cte_client, "user_.*", ".*", 0, chi::PoolQuery::Broadcast());
+  REQUIRE(unpaged.size() >= 8);
+
+  // Walk pages of 3 and check global (tag, blob) order with no duplicates
+  std::vector<std::pair<std::string, std::string>> paged;
+  std::string cursor_tag, cursor_blob;
+  for (int page = 0; page < 100; ++page) {
+    auto task = cte_client->AsyncBlobQuery("user_.*", ".*", 3,
+                                           chi::PoolQuery::Broadcast(),
+                                           cursor_tag, cursor_blob);
+    task.Wait();
+    REQUIRE(task->tag_names_.size() <= 3);
+    for (size_t i = 0; i < task->tag_names_.size(); ++i) {
+      std::pair<std::string, std::string> entry(task->tag_names_[i],
+                                                task->blob_names_[i]);
+      if (!paged.empty()) {
+        REQUIRE(paged.back() < entry);
+      }
+      paged.push_back(entry);
+    }
+    if (!task->has_more_ || task->tag_names_.empty()) {
+      break;
+    }
+    cursor_tag = task->tag_names_.back();
+    cursor_blob = task->blob_names_.back();
+  }
+  REQUIRE(paged.size() == unpaged.size());
+}
+
+/**
+ * Test classification of query patterns into literal/prefix/glob/regex
+ */
+TEST_CASE("Query - Pattern Classification", "[query][pattern]") {
+  using wrp_cte::core::NamePattern;
+  INFO("Testing NamePattern classification and matching");
+
+  auto literal = NamePattern::Get("blob_001\\.dat");
+  REQUIRE(literal->GetKind() == NamePattern::Kind::kLiteral);
+  REQUIRE(literal->GetPrefix() == "blob_001.dat");
+  REQUIRE(literal->Match("blob_001.dat"));
+  REQUIRE(!literal->Match("blob_001xdat"));
+
+  auto prefix = NamePattern::Get("user_.*");
+  REQUIRE(prefix->GetKind() == NamePattern::Kind::kPrefix);
+  REQUIRE(prefix->GetPrefix() == "user_");
+  REQUIRE(prefix->Match("user_logs"));
+  REQUIRE(!prefix->Match("system_config"));
+
+  auto glob = NamePattern::Get("blob_.*\\.dat");
+  REQUIRE(glob->GetKind() == NamePattern::Kind::kGlob);
+  REQUIRE(glob->GetPrefix() == "blob_");
+  REQUIRE(glob->Match("blob_002.dat"));
+  REQUIRE(!glob->Match("blob_002.txt"));
+
+  auto regex = NamePattern::Get("user_(data|logs)");
+  REQUIRE(regex->GetKind() == NamePattern::Kind::kRegex);
+  REQUIRE(regex->GetPrefix().empty());
+  REQUIRE(regex->Match("user_logs"));
+  REQUIRE(!regex->Match("user_cache"));
+
+  // The same pattern text shares one compiled instance
+  REQUIRE(NamePattern::Get("user_.*") == prefix);
+}
+
 // Main function using simple_test.h framework
 SIMPLE_TEST_MAIN()
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "simple_test.h"
+#include <wrp_cte/core/read_cache.h>
+
+#include <string>
+#include <vector>
+
+using namespace wrp_cte::core;
+
+using Cache = TinyLfuCache<int, std::string>;
+
+static chi::u64 H(int key) { return static_cast<chi::u64>(key) * 7919 + 1; }
+
+/** Touch a key n times, then admit and insert it */
+static bool Fill(Cache &cache, int key, chi::u64 size, int touches,
+                 std::vector<Cache::Evicted> &victims) {
+  for (int i = 0; i < touches; ++i) {
+    cache.Touch(H(key));
+  }
+  if (!cache.Admit(H(key), size, victims)) {
+    return false;
+  }
+  Cache::Evicted replaced;
+  cache.Insert(key, H(key), size, std::to_string(key), replaced);
+  return true;
+}
+
+TEST_CASE("ReadCache - Hits After Insert", "[cte][read_cache]") {
+  Cache cache(1000);
+  std::vector<Cache::Evicted> victims;
+  REQUIRE(Fill(cache, 1, 400, 1, victims));
+  REQUIRE(victims.empty());
+  REQUIRE(cache.GetUsedBytes() == 400);
+  std::string *value = cache.Find(1);
+  REQUIRE(value != nullptr);
+  REQUIRE(*value == "1");
+  REQUIRE(cache.Find(2) == nullptr);
+
+  Cache::Evicted removed;
+  REQUIRE(cache.Erase(1, removed));
+  REQUIRE(removed.size_ == 400);
+  REQUIRE(cache.Size() == 0);
+  REQUIRE(cache.GetUsedBytes() == 0);
+  REQUIRE_FALSE(cache.Erase(1, removed));
+}
+
+TEST_CASE("ReadCache - Frequency Follows Touches", "[cte][read_cache]") {
+  Cache cache(1000);
+  REQUIRE(cache.Frequency(H(5)) == 0);
+  for (int i = 0; i < 3; ++i) {
+    cache.Touch(H(5));
+  }
+  REQUIRE(cache.Frequency(H(5)) >= 3);
+  // Counters saturate at 15
+  for (int i = 0; i < 100; ++i) {
+    cache.Touch(H(5));
+  }
+  REQUIRE(cache.Frequency(H(5)) == 15);
+}
+
+TEST_CASE("ReadCache - Scan Does Not Flush Hot Set", "[cte][read_cache]") {
+  Cache cache(1000);
+  std::vector<Cache::Evicted> victims;
+  REQUIRE(Fill(cache, 1, 500, 8, victims));
+  REQUIRE(Fill(cache, 2, 500, 8, victims));
+  // One-touch blobs lose to the frequently read ones
+  for (int key = 100; key < 150; ++key) {
+    REQUIRE_FALSE(Fill(cache, key, 500, 1, victims));
+  }
+  REQUIRE(cache.Find(1) != nullptr);
+  REQUIRE(cache.Find(2) != nullptr);
+  REQUIRE(cache.GetUsedBytes() == 1000);
+}
+
+TEST_CASE("ReadCache - Hotter Candidate Evicts LRU", "[cte][read_cache]") {
+  Cache cache(1000);
+  std::vector<Cache::Evicted> victims;
+  REQUIRE(Fill(cache, 1, 500, 2, victims));
+  REQUIRE(Fill(cache, 2, 500, 2, victims));
+  cache.Find(1);  // 2 is now least recently used
+  REQUIRE(Fill(cache, 3, 500, 6, victims));
+  REQUIRE(victims.size() == 1);
+  REQUIRE(victims[0].key_ == 2);
+  REQUIRE(victims[0].value_ == "2");
+  REQUIRE(cache.Find(2) == nullptr);
+  REQUIRE(cache.Find(1) != nullptr);
+  REQUIRE(cache.GetUsedBytes() == 1000);
+}
+
+TEST_CASE("ReadCache - Cancel Returns Held Bytes", "[cte][read_cache]") {
+  Cache cache(1000);
+  std::vector<Cache::Evicted> victims;
+  cache.Touch(H(1));
+  REQUIRE(cache.Admit(H(1), 800, victims));
+  // The held bytes count against the next candidate
+  cache.Touch(H(2));
+  REQUIRE_FALSE(cache.Admit(H(2), 800, victims));
+  cache.Cancel(800);
+  REQUIRE(cache.Admit(H(2), 800, victims));
+  REQUIRE_FALSE(cache.Admit(H(3), 2000, victims));
+}
+
+SIMPLE_TEST_MAIN()
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "simple_test.h"
+#include <wrp_cte/core/tag_id_cache.h>
+
+#include <thread>
+
+using namespace wrp_cte::core;
+
+TEST_CASE("TagIdCache - Hit After Put", "[cte][tag_id_cache]") {
+  TagIdCache cache;
+  TagId tag_id;
+  REQUIRE(!cache.Get("a", tag_id));
+  cache.Put("a", TagId(1, 7));
+  REQUIRE(cache.Get("a", tag_id));
+  REQUIRE(tag_id == TagId(1, 7));
+  // Null IDs are never cached
+  cache.Put("b", TagId::GetNull());
+  REQUIRE(!cache.Get("b", tag_id));
+}
+
+TEST_CASE("TagIdCache - Erase By Name And Id", "[cte][tag_id_cache]") {
+  TagIdCache cache;
+  TagId tag_id;
+  cache.Put("a", TagId(1, 1));
+  cache.Put("b", TagId(1, 2));
+  cache.Put("c", TagId(1, 2));
+  cache.Erase("a");
+  REQUIRE(!cache.Get("a", tag_id));
+  cache.Erase(TagId(1, 2));
+  REQUIRE(!cache.Get("b", tag_id));
+  REQUIRE(!cache.Get("c", tag_id));
+}
+
+TEST_CASE("TagIdCache - Entries Expire", "[cte][tag_id_cache]") {
+  TagIdCache cache;
+  TagId tag_id;
+  cache.SetTtl(20);
+  cache.Put("a", TagId(1, 1));
+  REQUIRE(cache.Get("a", tag_id));
+  std::this_thread::sleep_for(std::chrono::milliseconds(40));
+  REQUIRE(!cache.Get("a", tag_id));
+
+  // A zero lease time turns the cache off
+  cache.SetTtl(0);
+  cache.Put("a", TagId(1, 1));
+  REQUIRE(!cache.Get("a", tag_id));
+}
+
+SIMPLE_TEST_MAIN()
@@ -38,11 +38,15 @@
  * Focuses on exercising all public methods of the Tag class.
  */
 
+#include <algorithm>
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <filesystem>
 #include <memory>
+#include <stdexcept>
+#include <vector>
 
 #include "simple_test.h"
 
@@ -405,6 +409,41 @@ TEST_CASE("Tag - GetBlob SHM Version", "[cte][tag][getblob]") {
   INFO("GetBlob SHM version completed");
 }
 
+TEST_CASE("Tag - GetBlob Concurrent Same Blob", "[cte][tag][getblob]") {
+  TagTestFixture fixture;
+  fixture.SetupCTEWithTarget();
+
+  const size_t blob_size = 256 * 1024, num_readers = 16;
+  auto original_data = fixture.CreateTestData(blob_size, 'H');
+  wrp_cte::core::Tag tag("getblob_herd");
+  tag.PutBlob("herd_blob", original_data.data(), blob_size);
+
+  // Whole-blob and sub-range reads in flight together may share bdev reads
+  auto *ipc = CHI_IPC;
+  auto *cte_client = WRP_CTE_CLIENT;
+  std::vector<hipc::FullPtr<char>> buffers;
+  std::vector<chi::Future<wrp_cte::core::GetBlobTask>> reads;
+  for (size_t i = 0; i < num_readers; ++i) {
+    size_t off = (i % 2 == 0) ? 0 : 4096 * i;
+    size_t size = (i % 2 == 0) ? blob_size : 4096;
+    hipc::FullPtr<char> buffer = ipc->AllocateBuffer(size);
+    REQUIRE(!buffer.IsNull());
+    buffers.push_back(buffer);
+    reads.push_back(cte_client->AsyncGetBlob(
+        tag.GetTagId(), "herd_blob", off, size, 0,
+        hipc::ShmPtr<>(buffer.shm_)));
+  }
+  for (size_t i = 0; i < num_readers; ++i) {
+    reads[i].Wait();
+    REQUIRE(reads[i]->GetReturnCode() == 0);
+    size_t off = (i % 2 == 0) ? 0 : 4096 * i;
+    size_t size = (i % 2 == 0) ? blob_size : 4096;
+    REQUIRE(std::equal(buffers[i].ptr_, buffers[i].ptr_ + size,
+                       original_data.begin() + off));
+    ipc->FreeBuffer(buffers[i]);
+  }
+}
+
 // ============================================================================
 // Error Handling Tests
 // ============================================================================
@@ -619,6 +658,578 @@ TEST_CASE("Tag - AsyncPutBlob", "[cte][tag][async]") {
   REQUIRE(size == fixture.kSmallDataSize);
 }
 
+// ============================================================================
+// Append Tests
+// ============================================================================
+
+TEST_CASE("Tag - AppendBlob Sequential", "[cte][tag][append]") {
+  TagTestFixture fixture;
+  fixture.SetupCTEWithTarget();
+
+  wrp_cte::core::Tag tag("append_log");
+  const size_t chunk_size = 4096;
+  const size_t record_size = 1500;  // Records straddle chunk boundaries
+  const size_t num_records = 8;
+
+  // Each append lands right after the previous one
+  std::vector<char> expected;
+  for (size_t i = 0; i < num_records; ++i) {
+    auto record = fixture.CreateTestData(record_size, 'a' + (i % 4));
+    size_t off = tag.AppendBlob(record.data(), record.size(), chunk_size);
+    REQUIRE(off == i * record_size);
+    expected.insert(expected.end(), record.begin(), record.end());
+  }
+
+  // Read the stream back chunk by chunk
+  size_t total = expected.size();
+  std::vector<char> retrieved(total);
+  for (size_t off = 0; off < total; off += chunk_size) {
+    size_t len = std::min(chunk_size, total - off);
+    tag.GetBlob(std::to_string(off / chunk_size), retrieved.data() + off,
+                len);
+  }
+  REQUIRE(retrieved == expected);
+}
+
+TEST_CASE("Tag - AppendBlob Concurrent", "[cte][tag][append]") {
+  TagTestFixture fixture;
+  fixture.SetupCTEWithTarget();
+
+  wrp_cte::core::Tag tag("append_concurrent");
+  const size_t chunk_size = 4096;
+  const size_t record_size = 1000;
+  const size_t num_records = 16;
+
+  // Issue all appends before waiting on any: reserved ranges must not overlap
+  auto *ipc = CHI_IPC;
+  auto *cte_client = WRP_CTE_CLIENT;
+  std::vector<hipc::FullPtr<char>> buffers;
+  std::vector<chi::Future<wrp_cte::core::AppendBlobTask>> futures;
+  for (size_t i = 0; i < num_records; ++i) {
+    hipc::FullPtr<char> buf = ipc->AllocateBuffer(record_size);
+    REQUIRE(!buf.IsNull());
+    memset(buf.ptr_, static_cast<int>('A' + i), record_size);
+    buffers.push_back(buf);
+    futures.push_back(cte_client->AsyncAppendBlob(
+        tag.GetTagId(), record_size, chunk_size, hipc::ShmPtr<>(buf.shm_)));
+  }
+  std::vector<size_t> offsets;
+  for (auto &future : futures) {
+    future.Wait();
+    REQUIRE(future->GetReturnCode() == 0);
+    offsets.push_back(future->offset_);
+  }
+  for (auto &buf : buffers) {
+    ipc->FreeBuffer(buf);
+  }
+
+  // The offsets tile [0, num_records * record_size) exactly
+  std::vector<size_t> sorted = offsets;
+  std::sort(sorted.begin(), sorted.end());
+  for (size_t i = 0; i < num_records; ++i) {
+    REQUIRE(sorted[i] == i * record_size);
+  }
+
+  // Each record is found intact at the offset it was given
+  for (size_t i = 0; i < num_records; ++i) {
+    std::vector<char> record(record_size);
+    size_t done = 0;
+    while (done < record_size) {
+      size_t cur = offsets[i] + done;
+      size_t len = std::min(chunk_size - cur % chunk_size, record_size - done);
+      tag.GetBlob(std::to_string(cur / chunk_size), record.data() + done, len,
+                  cur % chunk_size);
+      done += len;
+    }
+    REQUIRE(record == std::vector<char>(record_size, 'A' + i));
+  }
+}
+
+TEST_CASE("Tag - PutBlobBatch Writes Every Entry", "[cte][tag][putblob]") {
+  TagTestFixture fixture;
+  fixture.SetupCTEWithTarget();
+
+  wrp_cte::core::Tag tag("putblob_batch");
+  const size_t blob_size = 2048;
+  const size_t num_blobs = 8;
+
+  // One buffer holds every blob back to back
+  auto *ipc = CHI_IPC;
+  auto *cte_client = WRP_CTE_CLIENT;
+  hipc::FullPtr<char> buf = ipc->AllocateBuffer(blob_size * num_blobs);
+  REQUIRE(!buf.IsNull());
+  std::vector<wrp_cte::core::PutBlobBatchEntry> entries(num_blobs);
+  for (size_t i = 0; i < num_blobs; ++i) {
+    memset(buf.ptr_ + i * blob_size, static_cast<int>('a' + i), blob_size);
+    entries[i].blob_index_ = 100 + i;
+    entries[i].size_ = blob_size;
+    entries[i].data_ = hipc::ShmPtr<>(buf.shm_) + i * blob_size;
+  }
+  auto future = cte_client->AsyncPutBlobBatch(tag.GetTagId(), "rec_",
+                                              entries);
+  future.Wait();
+  REQUIRE(future->GetReturnCode() == 0);
+  REQUIRE(future->failed_ == 0);
+  ipc->FreeBuffer(buf);
+
+  // Each entry became its own blob, named prefix + index
+  for (size_t i = 0; i < num_blobs; ++i) {
+    std::vector<char> retrieved(blob_size);
+    tag.GetBlob("rec_" + std::to_string(100 + i), retrieved.data(),
+                blob_size);
+    REQUIRE(retrieved == std::vector<char>(blob_size, 'a' + i));
+  }
+}
+
+TEST_CASE("Tag - DefragBlobs Interleaved Growth", "[cte][tag][defrag]") {
+  TagTestFixture fixture;
+  fixture.SetupCTEWithTarget();
+
+  wrp_cte::core::Tag tag("defrag_tag");
+  const size_t piece_size = 4096;
+  const size_t num_pieces = 8;
+
+  // Growing two blobs in lockstep interleaves their allocations so neither
+  // blob's blocks can be merged
+  std::vector<char> expected_a;
+  std::vector<char> expected_b;
+  for (size_t i = 0; i < num_pieces; ++i) {
+    auto piece_a = fixture.CreateTestData(piece_size, 'a' + (i % 8));
+    auto piece_b = fixture.CreateTestData(piece_size, 'A' + (i % 8));
+    tag.PutBlob("frag_a", piece_a.data(), piece_size, i * piece_size);
+    tag.PutBlob("frag_b", piece_b.data(), piece_size, i * piece_size);
+    expected_a.insert(expected_a.end(), piece_a.begin(), piece_a.end());
+    expected_b.insert(expected_b.end(), piece_b.begin(), piece_b.end());
+  }
+
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto defrag = cte_client->AsyncDefragBlobs(chi::PoolQuery::Local(), 2);
+  defrag.Wait();
+  REQUIRE(defrag->GetReturnCode() == 0);
+  INFO("Defragmented " << defrag->blobs_defragmented_ << " blobs");
+
+  // Contents are unchanged, whichever blobs were rewritten
+  std::vector<char> retrieved(expected_a.size());
+  tag.GetBlob("frag_a", retrieved.data(), retrieved.size());
+  REQUIRE(retrieved == expected_a);
+  tag.GetBlob("frag_b", retrieved.data(), retrieved.size());
+  REQUIRE(retrieved == expected_b);
+
+  // Partial reads still resolve across the new layout
+  std::vector<char> middle(piece_size);
+  tag.GetBlob("frag_a", middle.data(), piece_size, 3 * piece_size);
+  REQUIRE(std::equal(middle.begin(), middle.end(),
+                     expected_a.begin() + 3 * piece_size));
+}
+
+TEST_CASE("Tag - MigrateBlobs Preserves Data", "[cte][tag][migrate]") {
+  TagTestFixture fixture;
+  fixture.SetupCTEWithTarget();
+
+  wrp_cte::core::Tag tag("migrate_tag");
+  const size_t blob_size = 64 * 1024;
+  auto hot_data = fixture.CreateTestData(blob_size, 'h');
+  auto cold_data = fixture.CreateTestData(blob_size, 'c');
+  tag.PutBlob("hot", hot_data.data(), blob_size);
+  tag.PutBlob("cold", cold_data.data(), blob_size);
+
+  // The first pass records a heat baseline; reads before the second pass
+  // push the hot blob over a low promotion threshold
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto first = cte_client->AsyncMigrateBlobs(chi::PoolQuery::Local(), 1024,
+                                             1000, 2.0f, 0.5f);
+  first.Wait();
+  REQUIRE(first->GetReturnCode() == 0);
+  std::vector<char> retrieved(blob_size);
+  for (int i = 0; i < 4; ++i) {
+    tag.GetBlob("hot", retrieved.data(), blob_size);
+  }
+  auto second = cte_client->AsyncMigrateBlobs(chi::PoolQuery::Local(), 1024,
+                                              1000, 2.0f, 0.5f);
+  second.Wait();
+  REQUIRE(second->GetReturnCode() == 0);
+  INFO("Promoted " << second->blobs_promoted_ << ", demoted "
+                   << second->blobs_demoted_);
+
+  // Contents are unchanged wherever the blobs ended up
+  tag.GetBlob("hot", retrieved.data(), blob_size);
+  REQUIRE(retrieved == hot_data);
+  tag.GetBlob("cold", retrieved.data(), blob_size);
+  REQUIRE(retrieved == cold_data);
+}
+
+TEST_CASE("Tag - EvictTargets Preserves Data", "[cte][tag][evict]") {
+  TagTestFixture fixture;
+  fixture.SetupCTEWithTarget();
+
+  wrp_cte::core::Tag tag("evict_tag");
+  const size_t blob_size = 64 * 1024;
+  auto data = fixture.CreateTestData(blob_size, 'v');
+  tag.PutBlob("resident", data.data(), blob_size);
+
+  // Watermarks this low put every fast target under pressure. With a single
+  // tier there is nowhere to demote to, so the pass leaves blobs in place.
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto evict = cte_client->AsyncEvictTargets(chi::PoolQuery::Local(),
+                                             0.0001f, 0.00005f);
+  evict.Wait();
+  REQUIRE(evict->GetReturnCode() == 0);
+  INFO("Evicted " << evict->blobs_evicted_ << " blobs");
+
+  std::vector<char> retrieved(blob_size);
+  tag.GetBlob("resident", retrieved.data(), blob_size);
+  REQUIRE(retrieved == data);
+}
+
+TEST_CASE("Tag - TTL Expires Blobs", "[cte][tag][ttl]") {
+  TagTestFixture fixture;
+  fixture.SetupCTEWithTarget();
+  auto *cte_client = WRP_CTE_CLIENT;
+  const size_t blob_size = 16 * 1024;
+  auto data = fixture.CreateTestData(blob_size, 't');
+
+  // A TTL given with the write
+  wrp_cte::core::Tag tag("ttl_tag");
+  tag.PutBlob("short", data.data(), blob_size, 0, 1.0f,
+              wrp_cte::core::Context::Ttl(300));
+  tag.PutBlob("kept", data.data(), blob_size);
+  auto early = cte_client->AsyncExpireBlobs(chi::PoolQuery::Local());
+  early.Wait();
+  REQUIRE(early->GetReturnCode() == 0);
+  REQUIRE(tag.GetContainedBlobs().size() == 2);
+
+  // The tag's TTL, overridden by a longer one on a single write
+  wrp_cte::core::Tag ttl_tag("ttl_tag_default");
+  REQUIRE_NOTHROW(ttl_tag.SetTtl(300));
+  ttl_tag.PutBlob("default", data.data(), blob_size);
+  ttl_tag.PutBlob("longer", data.data(), blob_size, 0, 1.0f,
+                  wrp_cte::core::Context::Ttl(600000));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  auto expire = cte_client->AsyncExpireBlobs(chi::PoolQuery::Local());
+  expire.Wait();
+  REQUIRE(expire->GetReturnCode() == 0);
+
+  auto blobs = tag.GetContainedBlobs();
+  REQUIRE(blobs.size() == 1);
+  REQUIRE(blobs[0] == "kept");
+  blobs = ttl_tag.GetContainedBlobs();
+  REQUIRE(blobs.size() == 1);
+  REQUIRE(blobs[0] == "longer");
+  REQUIRE(ttl_tag.GetBlobSize("default") == 0);
+  REQUIRE_NOTHROW(ttl_tag.SetTtl(0));
+}
+
+TEST_CASE("Tag - Snapshot Keeps Old Contents", "[cte][tag][snapshot]") {
+  TagTestFixture fixture;
+  fixture.SetupCTEWithTarget();
+  const size_t blob_size = 16 * 1024;
+  auto step1 = fixture.CreateTestData(blob_size, '1');
+  auto step2 = fixture.CreateTestData(blob_size, '2');
+
+  wrp_cte::core::Tag tag("snapshot_tag");
+  tag.PutBlob("ckpt", step1.data(), blob_size);
+  REQUIRE(tag.ListSnapshots().empty());
+  chi::u64 first = tag.Snapshot();
+
+  // A full and a partial overwrite both leave the snapshot alone
+  tag.PutBlob("ckpt", step2.data(), blob_size);
+  tag.PutBlob("ckpt", step2.data(), 4096, 4096);
+  chi::u64 second = tag.Snapshot();
+  REQUIRE(second > first);
+  REQUIRE((tag.ListSnapshots() == std::vector<chi::u64>{first, second}));
+
+  std::vector<char> retrieved(blob_size);
+  wrp_cte::core::Tag snapshot = tag.OpenSnapshot(first);
+  snapshot.GetBlob("ckpt", retrieved.data(), blob_size);
+  REQUIRE(retrieved == step1);
+  tag.GetBlob("ckpt", retrieved.data(), blob_size);
+  REQUIRE(retrieved == step2);
+
+  // Dropping the older snapshot keeps the newer one and the live data
+  REQUIRE_NOTHROW(tag.DeleteSnapshot(first));
+  REQUIRE((tag.ListSnapshots() == std::vector<chi::u64>{second}));
+  tag.OpenSnapshot(second).GetBlob("ckpt", retrieved.data(), blob_size);
+  REQUIRE(retrieved == step2);
+  tag.GetBlob("ckpt", retrieved.data(), blob_size);
+  REQUIRE(retrieved == step2);
+
+  bool missing = false;
+  try {
+    tag.OpenSnapshot(first);
+  } catch (const std::runtime_error &) {
+    missing = true;
+  }
+  REQUIRE(missing);
+}
+
+TEST_CASE("Tag - Replication Round Trip", "[cte][tag][replication]") {
+  TagTestFixture fixture;
+  fixture.SetupCTEWithTarget();
+
+  // On a single node the factor is capped at one container, so writes,
+  // reads and listings behave exactly as for an unreplicated tag
+  wrp_cte::core::Tag tag("replicated_tag");
+  REQUIRE_NOTHROW(tag.SetReplication(3));
+  const size_t blob_size = 16 * 1024;
+  auto data = fixture.CreateTestData(blob_size, 'r');
+  tag.PutBlob("replicated", data.data(), blob_size);
+
+  std::vector<char> retrieved(blob_size);
+  tag.GetBlob("replicated", retrieved.data(), blob_size);
+  REQUIRE(retrieved == data);
+  auto blobs = tag.GetContainedBlobs();
+  REQUIRE(blobs.size() == 1);
+  REQUIRE(blobs[0] == "replicated");
+
+  // A forced repair pass finds no replica to copy
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto repair = cte_client->AsyncRepairReplicas(chi::PoolQuery::Local(), true);
+  repair.Wait();
+  REQUIRE(repair->GetReturnCode() == 0);
+  REQUIRE(repair->blobs_repaired_ == 0);
+
+  REQUIRE_NOTHROW(tag.SetReplication(1));
+  tag.GetBlob("replicated", retrieved.data(), blob_size);
+  REQUIRE(retrieved == data);
+}
+
+TEST_CASE("Tag - Dedup Shares Identical Chunks", "[cte][tag][dedup]") {
+  TagTestFixture fixture;
+  fixture.SetupCTEWithTarget();
+  auto *cte_client = WRP_CTE_CLIENT;
+
+  wrp_cte::core::Tag tag("dedup_tag");
+  bool rejected = false;
+  try {
+    tag.SetDedup(1000);  // Not a multiple of 4KB
+  } catch (const std::runtime_error &) {
+    rejected = true;
+  }
+  REQUIRE(rejected);
+  const size_t chunk_size = 16 * 1024;
+  REQUIRE_NOTHROW(tag.SetDedup(chunk_size));
+  const size_t blob_size = 4 * chunk_size;
+  auto data = fixture.CreateTestData(blob_size, 'd');
+  tag.PutBlob("first", data.data(), blob_size);
+  tag.PutBlob("second", data.data(), blob_size);
+
+  // The second blob references the extents of the first
+  auto first_info = cte_client->AsyncGetBlobInfo(tag.GetTagId(), "first");
+  first_info.Wait();
+  auto second_info = cte_client->AsyncGetBlobInfo(tag.GetTagId(), "second");
+  second_info.Wait();
+  REQUIRE(first_info->blocks_.size() == second_info->blocks_.size());
+  for (size_t i = 0; i < first_info->blocks_.size(); ++i) {
+    REQUIRE(first_info->blocks_[i].block_offset_ ==
+            second_info->blocks_[i].block_offset_);
+  }
+
+  // A partial write detaches the blob it targets
+  std::vector<char> patch(100, 'x');
+  tag.PutBlob("first", patch.data(), patch.size(), 1024);
+  std::vector<char> retrieved(blob_size);
+  tag.GetBlob("second", retrieved.data(), blob_size);
+  REQUIRE(retrieved == data);
+  auto expected = data;
+  std::copy(patch.begin(), patch.end(), expected.begin() + 1024);
+  tag.GetBlob("first", retrieved.data(), blob_size);
+  REQUIRE(retrieved == expected);
+
+  // Repeated chunks within one blob are stored once, and survive the
+  // deletion of another blob sharing them
+  std::vector<char> zeros(blob_size, 0);
+  tag.PutBlob("zeros", zeros.data(), blob_size);
+  tag.PutBlob("zeros_copy", zeros.data(), blob_size);
+  auto zeros_info = cte_client->AsyncGetBlobInfo(tag.GetTagId(), "zeros");
+  zeros_info.Wait();
+  REQUIRE(zeros_info->blocks_.size() == 4);
+  for (const auto &block : zeros_info->blocks_) {
+    REQUIRE(block.block_offset_ == zeros_info->blocks_[0].block_offset_);
+  }
+  auto del_task = cte_client->AsyncDelBlob(tag.GetTagId(), "zeros");
+  del_task.Wait();
+  REQUIRE(del_task->GetReturnCode() == 0);
+  tag.GetBlob("zeros_copy", retrieved.data(), blob_size);
+  REQUIRE(retrieved == zeros);
+
+  REQUIRE_NOTHROW(tag.SetDedup(0));
+}
+
+TEST_CASE("Tag - Erasure Coding Round Trip", "[cte][tag][erasure]") {
+  TagTestFixture fixture;
+  fixture.SetupCTEWithTarget();
+  auto *cte_client = WRP_CTE_CLIENT;
+
+  wrp_cte::core::Tag tag("erasure_tag");
+  bool rejected = false;
+  try {
+    tag.SetErasureCoding(1, 0);  // No parity shards
+  } catch (const std::runtime_error &) {
+    rejected = true;
+  }
+  REQUIRE(rejected);
+  rejected = false;
+  try {
+    tag.SetErasureCoding(200, 100);  // Wider than GF(2^8) allows
+  } catch (const std::runtime_error &) {
+    rejected = true;
+  }
+  REQUIRE(rejected);
+  REQUIRE_NOTHROW(tag.SetErasureCoding(2, 1));
+
+  // An odd size leaves the last data shard padded
+  const size_t blob_size = 64 * 1024 + 17;
+  auto data = fixture.CreateTestData(blob_size, 'e');
+  tag.PutBlob("coded", data.data(), blob_size);
+  std::vector<char> retrieved(blob_size);
+  tag.GetBlob("coded", retrieved.data(), blob_size);
+  REQUIRE(retrieved == data);
+
+  // The blob reports its logical size, not the stored shard bytes
+  auto size_task = cte_client->AsyncGetBlobSize(tag.GetTagId(), "coded");
+  size_task.Wait();
+  REQUIRE(size_task->size_ == blob_size);
+
+  // A partial write re-encodes the stripe in place
+  std::vector<char> patch(300, 'x');
+  tag.PutBlob("coded", patch.data(), patch.size(), 40000);
+  auto expected = data;
+  std::copy(patch.begin(), patch.end(), expected.begin() + 40000);
+  tag.GetBlob("coded", retrieved.data(), blob_size);
+  REQUIRE(retrieved == expected);
+
+  REQUIRE_NOTHROW(tag.SetErasureCoding(0, 0));
+}
+
+TEST_CASE("Tag - Placement Policy Round Trip", "[cte][tag][placement]") {
+  TagTestFixture fixture;
+  fixture.SetupCTEWithTarget();
+  using wrp_cte::core::TagPlacement;
+  using wrp_cte::core::TagPlacementPolicy;
+
+  // Page-named blobs of every policy must read back wherever they land
+  const TagPlacement placements[] = {
+      TagPlacement(TagPlacementPolicy::kHashTag),
+      TagPlacement(TagPlacementPolicy::kStripe, 4),
+      TagPlacement(TagPlacementPolicy::kPinCreator)};
+  const size_t blob_size = 8 * 1024;
+  int index = 0;
+  for (const TagPlacement &placement : placements) {
+    wrp_cte::core::Tag tag("placement_tag_" + std::to_string(index++),
+                           placement);
+    for (int page = 0; page < 10; ++page) {
+      auto data = fixture.CreateTestData(blob_size, 'a' + page);
+      tag.PutBlob(std::to_string(page), data.data(), blob_size);
+    }
+    for (int page = 0; page < 10; ++page) {
+      std::vector<char> retrieved(blob_size);
+      tag.GetBlob(std::to_string(page), retrieved.data(), blob_size);
+      REQUIRE(retrieved == fixture.CreateTestData(blob_size, 'a' + page));
+    }
+    REQUIRE(tag.GetContainedBlobs().size() == 10);
+  }
+}
+
+TEST_CASE("Tag - Blob Stub Fault In", "[cte][tag][stub]") {
+  TagTestFixture fixture;
+  fixture.SetupCTEWithTarget();
+
+  // Source file: a header followed by two stub ranges
+  const size_t header = 512, blob_size = 16 * 1024;
+  auto direct_data = fixture.CreateTestData(blob_size, 'd');
+  auto cached_data = fixture.CreateTestData(blob_size, 'c');
+  std::string path =
+      (std::filesystem::temp_directory_path() / "cte_stub_source.bin")
+          .string();
+  {
+    FILE *fp = std::fopen(path.c_str(), "wb");
+    REQUIRE(fp != nullptr);
+    std::vector<char> pad(header, 'h');
+    std::fwrite(pad.data(), 1, header, fp);
+    std::fwrite(direct_data.data(), 1, blob_size, fp);
+    std::fwrite(cached_data.data(), 1, blob_size, fp);
+    std::fclose(fp);
+  }
+
+  wrp_cte::core::Tag tag("stub_tag");
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto direct = cte_client->AsyncRegisterBlobStub(tag.GetTagId(), "direct",
+                                                  path, header, blob_size);
+  direct.Wait();
+  REQUIRE(direct->GetReturnCode() == 0);
+  auto cached = cte_client->AsyncRegisterBlobStub(
+      tag.GetTagId(), "cached", path, header + blob_size, blob_size, 1.0f,
+      wrp_cte::core::kBlobStubCache);
+  cached.Wait();
+  REQUIRE(cached->GetReturnCode() == 0);
+  REQUIRE(tag.GetBlobSize("direct") == blob_size);
+
+  // Reads are served from the file, at any offset
+  std::vector<char> retrieved(blob_size);
+  tag.GetBlob("direct", retrieved.data(), blob_size);
+  REQUIRE(retrieved == direct_data);
+  std::vector<char> tail(1024);
+  tag.GetBlob("direct", tail.data(), tail.size(), blob_size - tail.size());
+  REQUIRE(std::equal(tail.begin(), tail.end(),
+                     direct_data.end() - tail.size()));
+  tag.GetBlob("cached", retrieved.data(), blob_size);
+  REQUIRE(retrieved == cached_data);
+
+  // A partial write faults the direct stub in before applying the update
+  std::vector<char> patch(1024, 'p');
+  tag.PutBlob("direct", patch.data(), patch.size(), 4096);
+  std::copy(patch.begin(), patch.end(), direct_data.begin() + 4096);
+
+  // Both blobs now live in CTE and survive the source file going away
+  std::filesystem::remove(path);
+  tag.GetBlob("direct", retrieved.data(), blob_size);
+  REQUIRE(retrieved == direct_data);
+  tag.GetBlob("cached", retrieved.data(), blob_size);
+  REQUIRE(retrieved == cached_data);
+  REQUIRE(tag.GetBlobSize("direct") == blob_size);
+}
+
+TEST_CASE("Tag - Blob View Falls Back Off RAM", "[cte][tag][view]") {
+  TagTestFixture fixture;
+  fixture.SetupCTEWithTarget();
+
+  const size_t blob_size = 8 * 1024;
+  auto data = fixture.CreateTestData(blob_size, 'v');
+  wrp_cte::core::Tag tag("view_tag");
+  tag.PutBlob("on_file", data.data(), blob_size);
+
+  // The fixture's target is a file, so no view is granted
+  wrp_cte::core::BlobView view = tag.GetBlobView("on_file");
+  REQUIRE_FALSE(view.IsValid());
+  REQUIRE(view.GetSize() == 0);
+  bool rejected = false;
+  try {
+    tag.GetBlobView("no_such_blob");
+  } catch (const std::runtime_error &) {
+    rejected = true;
+  }
+  REQUIRE(rejected);
+
+  // With views enabled GetBlob still reads through the runtime
+  auto *cte_client = WRP_CTE_CLIENT;
+  cte_client->SetBlobViews(true);
+  std::vector<char> retrieved(blob_size);
+  tag.GetBlob("on_file", retrieved.data(), blob_size);
+  std::vector<char> tail(1024);
+  tag.GetBlob("on_file", tail.data(), tail.size(), blob_size - tail.size());
+  rejected = false;
+  try {
+    tag.GetBlob("no_such_blob", tail.data(), tail.size());
+  } catch (const std::runtime_error &) {
+    rejected = true;
+  }
+  REQUIRE(rejected);
+  cte_client->SetBlobViews(false);
+  REQUIRE(retrieved == data);
+  REQUIRE(std::equal(tail.begin(), tail.end(), data.end() - tail.size()));
+}
+
 // ============================================================================
 // Large Data Tests
 // ============================================================================
@@ -667,4 +1278,194 @@ TEST_CASE("Tag - Overwrite Blob", "[cte][tag][edge]") {
   REQUIRE(fixture.VerifyTestData(retrieved, 'S'));
 }
 
+TEST_CASE("Tag - Same-Size Overwrite Keeps Blocks", "[cte][tag][edge]") {
+  TagTestFixture fixture;
+  fixture.SetupCTEWithTarget();
+  auto *cte_client = WRP_CTE_CLIENT;
+
+  wrp_cte::core::Tag tag("overwrite_in_place");
+  const size_t blob_size = 64 * 1024;
+  auto data1 = fixture.CreateTestData(blob_size, 'F');
+  auto data2 = fixture.CreateTestData(blob_size, 'S');
+  tag.PutBlob("step", data1.data(), blob_size);
+  auto before = cte_client->AsyncGetBlobInfo(tag.GetTagId(), "step");
+  before.Wait();
+
+  // A same-size rewrite and a patch inside the blob reuse its blocks
+  tag.PutBlob("step", data2.data(), blob_size);
+  std::vector<char> patch(4096, 'p');
+  tag.PutBlob("step", patch.data(), patch.size(), 8192);
+  auto after = cte_client->AsyncGetBlobInfo(tag.GetTagId(), "step");
+  after.Wait();
+  REQUIRE(after->total_size_ == blob_size);
+  REQUIRE(before->blocks_.size() == after->blocks_.size());
+  for (size_t i = 0; i < before->blocks_.size(); ++i) {
+    REQUIRE(before->blocks_[i].target_pool_id_ ==
+            after->blocks_[i].target_pool_id_);
+    REQUIRE(before->blocks_[i].block_offset_ ==
+            after->blocks_[i].block_offset_);
+  }
+  std::copy(patch.begin(), patch.end(), data2.begin() + 8192);
+  std::vector<char> retrieved(blob_size);
+  tag.GetBlob("step", retrieved.data(), blob_size);
+  REQUIRE(retrieved == data2);
+
+  // A write of another size still replaces the blob
+  auto smaller = fixture.CreateTestData(blob_size / 2, 'H');
+  tag.PutBlob("step", smaller.data(), smaller.size());
+  REQUIRE(tag.GetBlobSize("step") == smaller.size());
+  retrieved.resize(smaller.size());
+  tag.GetBlob("step", retrieved.data(), retrieved.size());
+  REQUIRE(retrieved == smaller);
+}
+
+TEST_CASE("Tag - Reserve Blob Fills In Place", "[cte][tag][edge]") {
+  TagTestFixture fixture;
+  fixture.SetupCTEWithTarget();
+  auto *cte_client = WRP_CTE_CLIENT;
+
+  wrp_cte::core::Tag tag("reserve_blob");
+  const size_t blob_size = 64 * 1024;
+  const size_t chunk = 4096;
+  tag.ReserveBlob("dataset", blob_size);
+  REQUIRE(tag.GetBlobSize("dataset") == blob_size);
+  auto size_task = cte_client->AsyncGetTagSize(tag.GetTagId());
+  size_task.Wait();
+  REQUIRE(size_task->tag_size_ == blob_size);
+  auto before = cte_client->AsyncGetBlobInfo(tag.GetTagId(), "dataset");
+  before.Wait();
+
+  // The reserved range reads as zeros until written
+  std::vector<char> retrieved(blob_size);
+  tag.GetBlob("dataset", retrieved.data(), blob_size);
+  REQUIRE(retrieved == std::vector<char>(blob_size, 0));
+
+  // Chunked writes, including the one at offset 0, fill the reservation
+  std::vector<char> expected(blob_size, 0);
+  for (size_t off = 0; off < blob_size / 2; off += chunk) {
+    auto data = fixture.CreateTestData(chunk, 'a' + (off / chunk) % 26);
+    tag.PutBlob("dataset", data.data(), chunk, off);
+    std::copy(data.begin(), data.end(), expected.begin() + off);
+  }
+  auto after = cte_client->AsyncGetBlobInfo(tag.GetTagId(), "dataset");
+  after.Wait();
+  REQUIRE(after->total_size_ == blob_size);
+  REQUIRE(before->blocks_.size() == after->blocks_.size());
+  for (size_t i = 0; i < before->blocks_.size(); ++i) {
+    REQUIRE(before->blocks_[i].block_offset_ ==
+            after->blocks_[i].block_offset_);
+  }
+  tag.GetBlob("dataset", retrieved.data(), blob_size);
+  REQUIRE(retrieved == expected);
+
+  // Reserving less than the blob holds leaves it as it is
+  tag.ReserveBlob("dataset", chunk);
+  REQUIRE(tag.GetBlobSize("dataset") == blob_size);
+}
+
+TEST_CASE("Tag - GetOrCreateTags Batch", "[cte][tag][batch]") {
+  TagTestFixture fixture;
+  fixture.SetupCTEWithTarget();
+
+  std::vector<std::string> names;
+  for (int i = 0; i < 64; ++i) {
+    names.push_back("batch_tag_" + std::to_string(i));
+  }
+  wrp_cte::core::Tag existing(names[5]);
+  std::vector<wrp_cte::core::Tag> tags =
+      wrp_cte::core::Tag::GetOrCreateTags(names);
+  REQUIRE(tags.size() == names.size());
+  REQUIRE(tags[5].GetTagId() == existing.GetTagId());
+  for (size_t i = 0; i < tags.size(); ++i) {
+    REQUIRE(!tags[i].GetTagId().IsNull());
+    for (size_t j = 0; j < i; ++j) {
+      REQUIRE(!(tags[i].GetTagId() == tags[j].GetTagId()));
+    }
+  }
+
+  // A reopen hits the cache; deleting the tag drops the cached ID
+  wrp_cte::core::Tag reopened(names[7]);
+  REQUIRE(reopened.GetTagId() == tags[7].GetTagId());
+  auto *cte_client = WRP_CTE_CLIENT;
+  auto del_task = cte_client->AsyncDelTag(names[7]);
+  del_task.Wait();
+  wrp_cte::core::TagId cached;
+  REQUIRE(!wrp_cte::core::Client::GetTagIdCache()->Get(names[7], cached));
+  wrp_cte::core::Tag recreated(names[7]);
+  REQUIRE(!(recreated.GetTagId() == tags[7].GetTagId()));
+}
+
+TEST_CASE("Tag - NUMA Shards Own Their Hash Range", "[cte][tag][numa]") {
+  TagTestFixture fixture;
+
+  // Compose a CTE pool with two containers (shards) on every node
+  const chi::PoolId shard_pool_id(780, 0);
+  chi::PoolConfig pool_config;
+  pool_config.mod_name_ = "wrp_cte_core";
+  pool_config.pool_name_ = "cte_numa_shards";
+  pool_config.pool_id_ = shard_pool_id;
+  pool_config.pool_query_ = chi::PoolQuery::Local();
+  pool_config.containers_per_node_ = 2;
+  pool_config.config_ =
+      "storage:\n"
+      "  - path: \"ram::cte_numa_shard_tier\"\n"
+      "    bdev_type: \"ram\"\n"
+      "    capacity_limit: \"16MB\"\n"
+      "    score: 1.0\n";
+  auto *admin_client = CHI_ADMIN;
+  auto compose_task = admin_client->AsyncCompose(pool_config);
+  compose_task.Wait();
+  REQUIRE(compose_task->GetReturnCode() == 0);
+
+  // Shard k of this node is container node_id + k * num_nodes
+  auto *ipc = CHI_IPC;
+  auto *pool_manager = CHI_POOL_MANAGER;
+  const chi::u32 num_nodes = static_cast<chi::u32>(ipc->GetNumHosts());
+  const chi::u32 node_id = static_cast<chi::u32>(ipc->GetNodeId());
+  const chi::PoolInfo *pool_info = pool_manager->GetPoolInfo(shard_pool_id);
+  REQUIRE(pool_info != nullptr);
+  REQUIRE(pool_info->num_containers_ == 2 * num_nodes);
+  const chi::u32 shard_ids[2] = {node_id, node_id + num_nodes};
+  REQUIRE(pool_manager->HasContainer(shard_pool_id, shard_ids[0]));
+  REQUIRE(pool_manager->HasContainer(shard_pool_id, shard_ids[1]));
+
+  wrp_cte::core::Client shard_client(shard_pool_id);
+  auto tag_task = shard_client.AsyncGetOrCreateTag("numa_shard_tag");
+  tag_task.Wait();
+  REQUIRE(tag_task->GetReturnCode() == 0);
+  wrp_cte::core::TagId tag_id = tag_task->tag_id_;
+
+  // Write one blob through each shard's hash
+  auto data = fixture.CreateTestData(fixture.kSmallDataSize, 'N');
+  hipc::FullPtr<char> shm_fullptr = ipc->AllocateBuffer(data.size());
+  REQUIRE(!shm_fullptr.IsNull());
+  memcpy(shm_fullptr.ptr_, data.data(), data.size());
+  hipc::ShmPtr<> shm_ptr(shm_fullptr.shm_);
+  for (chi::u32 shard_id : shard_ids) {
+    std::string blob_name = "numa_blob_" + std::to_string(shard_id);
+    auto put_task = shard_client.AsyncPutBlob(
+        tag_id, blob_name, 0, data.size(), shm_ptr, 1.0f,
+        wrp_cte::core::Context(), 0, chi::PoolQuery::DirectHash(shard_id));
+    put_task.Wait();
+    REQUIRE(put_task->GetReturnCode() == 0);
+  }
+  ipc->FreeBuffer(shm_fullptr);
+
+  // Each blob is found through every hash of its own shard and nowhere else
+  for (int i = 0; i < 2; ++i) {
+    std::string blob_name = "numa_blob_" + std::to_string(shard_ids[i]);
+    auto own_task = shard_client.AsyncGetBlobSize(
+        tag_id, blob_name,
+        chi::PoolQuery::DirectHash(shard_ids[i] + 2 * num_nodes));
+    own_task.Wait();
+    REQUIRE(own_task->GetReturnCode() == 0);
+    REQUIRE(own_task->size_ == data.size());
+
+    auto other_task = shard_client.AsyncGetBlobSize(
+        tag_id, blob_name, chi::PoolQuery::DirectHash(shard_ids[1 - i]));
+    other_task.Wait();
+    REQUIRE(other_task->GetReturnCode() != 0);
+  }
+}
+
 SIMPLE_TEST_MAIN()
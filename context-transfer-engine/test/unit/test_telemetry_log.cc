@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "simple_test.h"
+#include <wrp_cte/core/telemetry_log.h>
+
+#include <thread>
+
+using namespace wrp_cte::core;
+
+static CteTelemetry MakeEntry(CteOp op, size_t off) {
+  return CteTelemetry(op, off, 0, TagId(1, 1), Timestamp(), Timestamp());
+}
+
+TEST_CASE("TelemetryLog - Merges Workers In Logical Time Order",
+          "[cte][telemetry]") {
+  TelemetryLog log;
+  log.Init(4, 100, 1);
+  REQUIRE(log.GetCapacity() == 128);
+
+  // Interleave the producers; the merge is sorted and keeps each
+  // worker's entries in issue order
+  for (size_t i = 0; i < 40; ++i) {
+    REQUIRE(log.Log(static_cast<chi::u32>(i % 4),
+                    MakeEntry(CteOp::kPutBlob, i)));
+  }
+  REQUIRE(log.Size() == 40);
+
+  std::vector<CteTelemetry> entries;
+  REQUIRE(log.Collect(entries, 0, SIZE_MAX) == 40);
+  for (size_t i = 1; i < entries.size(); ++i) {
+    REQUIRE(entries[i - 1].logical_time_ < entries[i].logical_time_);
+  }
+  std::vector<size_t> last_off(4, 0);
+  std::vector<bool> any(4, false);
+  for (const auto &entry : entries) {
+    size_t shard = entry.logical_time_ % TelemetryLog::kMaxShards;
+    REQUIRE(shard == entry.off_ % 4);
+    REQUIRE(!any[shard] || last_off[shard] < entry.off_);
+    any[shard] = true;
+    last_off[shard] = entry.off_;
+  }
+
+  // Paging from the last returned time sees every entry exactly once
+  size_t seen = 0;
+  std::uint64_t next = 0;
+  std::vector<CteTelemetry> page;
+  while (log.Collect(page, next, 7) > 0) {
+    seen += page.size();
+    next = page.back().logical_time_ + 1;
+  }
+  REQUIRE(seen == 40);
+}
+
+TEST_CASE("TelemetryLog - Keeps Newest Entries Per Worker",
+          "[cte][telemetry]") {
+  TelemetryLog log;
+  log.Init(2, 8, 1);
+  for (size_t i = 0; i < 20; ++i) {
+    log.Log(0, MakeEntry(CteOp::kGetBlob, i));
+  }
+  log.Log(1, MakeEntry(CteOp::kDelBlob, 100));
+
+  // Worker 0 wrapped, worker 1 still holds its single entry
+  std::vector<CteTelemetry> entries;
+  REQUIRE(log.Collect(entries, 0, SIZE_MAX) == 9);
+  REQUIRE(entries.front().off_ == 12);
+  REQUIRE(entries.back().off_ == 100);
+}
+
+TEST_CASE("TelemetryLog - Samples One In N", "[cte][telemetry]") {
+  TelemetryLog log;
+  log.Init(1, 1024, 10);
+  size_t recorded = 0;
+  for (size_t i = 0; i < 100; ++i) {
+    if (log.Log(0, MakeEntry(CteOp::kGetBlob, i))) ++recorded;
+  }
+  REQUIRE(recorded == 10);
+  REQUIRE(log.Size() == 10);
+  REQUIRE(log.GetSampleRate() == 10);
+}
+
+TEST_CASE("TelemetryLog - Concurrent Readers See Whole Entries",
+          "[cte][telemetry]") {
+  TelemetryLog log;
+  log.Init(2, 64, 1);
+  std::atomic<bool> done{false};
+
+  // off_ and size_ are written together; a torn copy would differ
+  auto produce = [&](chi::u32 shard) {
+    for (size_t i = 0; i < 200000; ++i) {
+      CteTelemetry entry(CteOp::kPutBlob, i, i, TagId(1, shard), Timestamp(),
+                         Timestamp());
+      log.Log(shard, entry);
+    }
+  };
+  std::thread p0(produce, 0);
+  std::thread p1(produce, 1);
+  std::thread reader([&]() {
+    std::vector<CteTelemetry> entries;
+    while (!done.load()) {
+      log.Collect(entries, 0, SIZE_MAX);
+      for (const auto &entry : entries) {
+        REQUIRE(entry.off_ == entry.size_);
+      }
+    }
+  });
+  p0.join();
+  p1.join();
+  done = true;
+  reader.join();
+  REQUIRE(log.Size() == 128);
+}
+
+SIMPLE_TEST_MAIN()
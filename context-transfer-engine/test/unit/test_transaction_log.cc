@@ -0,0 +1,443 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "simple_test.h"
+#include <wrp_cte/core/metadata_checkpoint.h>
+#include <wrp_cte/core/transaction_log.h>
+
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace wrp_cte::core;
+
+// Helper function to create a fresh WAL base path
+static std::string GetTempLogPath(const std::string &name) {
+  std::string dir = "/tmp/cte_wal_" + name + "_" +
+                    std::to_string(std::time(nullptr)) + "_" +
+                    std::to_string(rand());
+  std::filesystem::create_directories(dir);
+  return dir + "/log";
+}
+
+// Helper function to remove a WAL directory
+static void CleanupLog(const std::string &path) {
+  std::filesystem::remove_all(std::filesystem::path(path).parent_path());
+}
+
+static void LogBlobs(TransactionLog &log, chi::u32 first, chi::u32 count) {
+  for (chi::u32 i = first; i < first + count; ++i) {
+    TxnCreateNewBlob txn{1, i, "blob_" + std::to_string(i), 0.5f};
+    log.Log(TxnType::kCreateNewBlob, txn);
+  }
+}
+
+TEST_CASE("TransactionLog - Round Trip Across Segments", "[cte][wal]") {
+  std::string path = GetTempLogPath("roundtrip");
+  {
+    TransactionLog log;
+    log.Open(path, 1ULL << 20, TransactionLog::kMinSegmentBytes);
+    LogBlobs(log, 0, 4000);
+    REQUIRE(log.Sync());
+  }
+  REQUIRE(TransactionLog::Exists(path));
+  REQUIRE(std::filesystem::exists(path + ".seg1"));
+
+  TransactionLog loader;
+  loader.Open(path, 0);
+  auto entries = loader.Load();
+  REQUIRE(entries.size() == 4000);
+  for (size_t i = 0; i < entries.size(); ++i) {
+    REQUIRE(entries[i].first == TxnType::kCreateNewBlob);
+    auto txn = TransactionLog::DeserializeCreateNewBlob(entries[i].second);
+    REQUIRE(txn.tag_minor_ == i);
+    REQUIRE(txn.blob_name_ == "blob_" + std::to_string(i));
+  }
+  loader.Close();
+  CleanupLog(path);
+}
+
+TEST_CASE("TransactionLog - Reopen Appends After Last Record", "[cte][wal]") {
+  std::string path = GetTempLogPath("reopen");
+  {
+    TransactionLog log;
+    log.Open(path, 1ULL << 20);
+    LogBlobs(log, 0, 10);
+  }
+  {
+    TransactionLog log;
+    log.Open(path, 1ULL << 20);
+    TxnDelBlob txn{1, 3, "blob_3"};
+    log.Log(TxnType::kDelBlob, txn);
+  }
+  TransactionLog loader;
+  loader.Open(path, 0);
+  auto entries = loader.Load();
+  REQUIRE(entries.size() == 11);
+  REQUIRE(entries.back().first == TxnType::kDelBlob);
+  REQUIRE(TransactionLog::DeserializeDelBlob(entries.back().second)
+              .blob_name_ == "blob_3");
+  loader.Close();
+  CleanupLog(path);
+}
+
+TEST_CASE("TransactionLog - Blob Cipher Record Round Trip", "[cte][wal]") {
+  std::string path = GetTempLogPath("cipher");
+  {
+    TransactionLog log;
+    log.Open(path, 1ULL << 20);
+    TxnBlobCipher txn{1, 7, "sealed", 65536, 200000};
+    log.Log(TxnType::kSetBlobCipher, txn);
+  }
+  TransactionLog loader;
+  loader.Open(path, 0);
+  auto entries = loader.Load();
+  REQUIRE(entries.size() == 1);
+  REQUIRE(entries[0].first == TxnType::kSetBlobCipher);
+  auto txn = TransactionLog::DeserializeBlobCipher(entries[0].second);
+  REQUIRE(txn.tag_minor_ == 7);
+  REQUIRE(txn.blob_name_ == "sealed");
+  REQUIRE(txn.chunk_size_ == 65536);
+  REQUIRE(txn.blob_size_ == 200000);
+  loader.Close();
+  CleanupLog(path);
+}
+
+TEST_CASE("TransactionLog - Blob Stub Record Round Trip", "[cte][wal]") {
+  std::string path = GetTempLogPath("stub");
+  {
+    TransactionLog log;
+    log.Open(path, 1ULL << 20);
+    TxnBlobStub txn{1, 9, "page_3", "/data/input.h5", 4096, 1 << 20, 1, 0.25f};
+    log.Log(TxnType::kSetBlobStub, txn);
+  }
+  TransactionLog loader;
+  loader.Open(path, 0);
+  auto entries = loader.Load();
+  REQUIRE(entries.size() == 1);
+  REQUIRE(entries[0].first == TxnType::kSetBlobStub);
+  auto txn = TransactionLog::DeserializeBlobStub(entries[0].second);
+  REQUIRE(txn.tag_minor_ == 9);
+  REQUIRE(txn.blob_name_ == "page_3");
+  REQUIRE(txn.source_path_ == "/data/input.h5");
+  REQUIRE(txn.source_offset_ == 4096);
+  REQUIRE(txn.size_ == (1 << 20));
+  REQUIRE(txn.flags_ == 1);
+  REQUIRE(txn.score_ == 0.25f);
+  loader.Close();
+  CleanupLog(path);
+}
+
+TEST_CASE("TransactionLog - Tag Policy Record Round Trip", "[cte][wal]") {
+  std::string path = GetTempLogPath("policy");
+  {
+    TransactionLog log;
+    log.Open(path, 1ULL << 20);
+    TxnTagPolicy txn{1, 4, 3, 2, 16, 7, 1, 5, 65536};
+    log.Log(TxnType::kSetTagPolicy, txn);
+  }
+  TransactionLog loader;
+  loader.Open(path, 0);
+  auto entries = loader.Load();
+  REQUIRE(entries.size() == 1);
+  REQUIRE(entries[0].first == TxnType::kSetTagPolicy);
+  auto txn = TransactionLog::DeserializeTagPolicy(entries[0].second);
+  REQUIRE(txn.tag_minor_ == 4);
+  REQUIRE(txn.replicas_ == 3);
+  REQUIRE(txn.placement_policy_ == 2);
+  REQUIRE(txn.stripe_pages_ == 16);
+  REQUIRE(txn.pin_container_ == 7);
+  REQUIRE(txn.follow_minor_ == 5);
+  REQUIRE(txn.dedup_chunk_ == 65536);
+  loader.Close();
+  CleanupLog(path);
+}
+
+TEST_CASE("TransactionLog - Pack Segment Records Round Trip", "[cte][wal]") {
+  std::string path = GetTempLogPath("pack");
+  {
+    TransactionLog log;
+    log.Open(path, 1ULL << 20);
+    TxnPackSegment txn{512, 3, 1 << 20, 1 << 20};
+    log.Log(TxnType::kAddPackSegment, txn);
+    log.Log(TxnType::kFreePackSegment, txn);
+  }
+  TransactionLog loader;
+  loader.Open(path, 0);
+  auto entries = loader.Load();
+  REQUIRE(entries.size() == 2);
+  REQUIRE(entries[0].first == TxnType::kAddPackSegment);
+  REQUIRE(entries[1].first == TxnType::kFreePackSegment);
+  auto txn = TransactionLog::DeserializePackSegment(entries[1].second);
+  REQUIRE(txn.bdev_major_ == 512);
+  REQUIRE(txn.bdev_minor_ == 3);
+  REQUIRE(txn.base_ == (1 << 20));
+  REQUIRE(txn.size_ == (1 << 20));
+  loader.Close();
+  CleanupLog(path);
+}
+
+TEST_CASE("TransactionLog - Replay Stops At Corrupt Record", "[cte][wal]") {
+  std::string path = GetTempLogPath("corrupt");
+  {
+    TransactionLog log;
+    log.Open(path, 1ULL << 20);
+    LogBlobs(log, 0, 10);
+  }
+
+  // Flip a byte inside the sixth record's payload
+  std::fstream fs(path + ".seg0",
+                  std::ios::in | std::ios::out | std::ios::binary);
+  REQUIRE(fs.is_open());
+  TransactionLog probe;
+  probe.Open(path, 0);
+  auto entries = probe.Load();
+  probe.Close();
+  size_t off = TransactionLog::kSegmentHeaderSize;
+  for (size_t i = 0; i < 5; ++i) {
+    off += TransactionLog::kRecordHeaderSize + entries[i].second.size();
+  }
+  fs.seekp(off + TransactionLog::kRecordHeaderSize + 1);
+  fs.put('!');
+  fs.close();
+
+  TransactionLog loader;
+  loader.Open(path, 0);
+  REQUIRE(loader.Load().size() == 5);
+  loader.Close();
+  CleanupLog(path);
+}
+
+TEST_CASE("TransactionLog - Truncate Removes Segments", "[cte][wal]") {
+  std::string path = GetTempLogPath("truncate");
+  TransactionLog log;
+  log.Open(path, 1ULL << 20, TransactionLog::kMinSegmentBytes);
+  LogBlobs(log, 0, 4000);
+  REQUIRE(log.Sync());
+  REQUIRE(log.Size() > TransactionLog::kMinSegmentBytes);
+  log.Truncate();
+  REQUIRE(log.Size() == 0);
+  REQUIRE(!TransactionLog::Exists(path));
+
+  // The log is usable again after truncation
+  LogBlobs(log, 0, 3);
+  REQUIRE(log.Sync());
+  REQUIRE(log.Load().size() == 3);
+  log.Close();
+  CleanupLog(path);
+}
+
+TEST_CASE("TransactionLog - Legacy Log Is Replayed", "[cte][wal]") {
+  std::string path = GetTempLogPath("legacy");
+  {
+    // Pre-segment format: [u8 type][u32 size][payload]
+    std::ofstream ofs(path, std::ios::binary);
+    std::string name = "old_tag";
+    std::vector<char> payload;
+    chi::u32 len = static_cast<chi::u32>(name.size());
+    chi::u32 major = 1, minor = 2;
+    payload.insert(payload.end(), reinterpret_cast<char *>(&len),
+                   reinterpret_cast<char *>(&len) + sizeof(len));
+    payload.insert(payload.end(), name.begin(), name.end());
+    payload.insert(payload.end(), reinterpret_cast<char *>(&major),
+                   reinterpret_cast<char *>(&major) + sizeof(major));
+    payload.insert(payload.end(), reinterpret_cast<char *>(&minor),
+                   reinterpret_cast<char *>(&minor) + sizeof(minor));
+    uint8_t type = static_cast<uint8_t>(TxnType::kCreateTag);
+    chi::u32 size = static_cast<chi::u32>(payload.size());
+    ofs.write(reinterpret_cast<char *>(&type), sizeof(type));
+    ofs.write(reinterpret_cast<char *>(&size), sizeof(size));
+    ofs.write(payload.data(), payload.size());
+  }
+  REQUIRE(TransactionLog::Exists(path));
+
+  TransactionLog log;
+  log.Open(path, 1ULL << 20);
+  TxnDelTag txn{"old_tag", 1, 2};
+  log.Log(TxnType::kDelTag, txn);
+  REQUIRE(log.Sync());
+  auto entries = log.Load();
+  REQUIRE(entries.size() == 2);
+  REQUIRE(TransactionLog::DeserializeCreateTag(entries[0].second).tag_name_ ==
+          "old_tag");
+  REQUIRE(entries[1].first == TxnType::kDelTag);
+  log.Close();
+  CleanupLog(path);
+}
+
+TEST_CASE("TransactionLog - ForEachRecord Visits Mapped Payloads",
+          "[cte][wal]") {
+  std::string path = GetTempLogPath("foreach");
+  TransactionLog log;
+  log.Open(path, 1ULL << 20, TransactionLog::kMinSegmentBytes);
+  LogBlobs(log, 0, 2000);
+  REQUIRE(log.Sync());
+
+  size_t count = 0;
+  bool in_order = true;
+  log.ForEachRecord([&](TxnType type, const char *payload, size_t size) {
+    auto txn = TransactionLog::DeserializeCreateNewBlob(payload);
+    in_order = in_order && type == TxnType::kCreateNewBlob &&
+               txn.tag_minor_ == count &&
+               size == 4 + 4 + 4 + txn.blob_name_.size() + 4;
+    ++count;
+  });
+  REQUIRE(count == 2000);
+  REQUIRE(in_order);
+  log.Close();
+  CleanupLog(path);
+}
+
+TEST_CASE("MetadataCheckpoint - Reader Stops At Torn Tail", "[cte][wal]") {
+  std::string path = GetTempLogPath("reader");
+  {
+    std::ofstream ofs(path, std::ios::binary);
+    chi::u64 value = 42;
+    ofs.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    ofs.write("abc", 3);  // Torn: a second u64 was being written
+  }
+  MappedFile file;
+  REQUIRE(file.Open(path));
+  REQUIRE(file.size() == sizeof(chi::u64) + 3);
+
+  CheckpointReader reader(file);
+  chi::u64 first = 0;
+  reader.Read(first);
+  REQUIRE(reader.good());
+  REQUIRE(first == 42);
+  REQUIRE(reader.HasMore());
+
+  chi::u64 second = 7;
+  reader.Read(second);
+  REQUIRE(!reader.good());
+  REQUIRE(!reader.HasMore());
+  REQUIRE(second == 7);
+  CleanupLog(path);
+}
+
+TEST_CASE("MetadataCheckpoint - Dirty Set Drains Once", "[cte][wal]") {
+  DirtyMetadataSet dirty;
+  REQUIRE(!dirty.IsEnabled());
+  dirty.MarkBlob("1.2.ignored");  // No-op until Init()
+  dirty.Init(4);
+  REQUIRE(dirty.IsEnabled());
+
+  TagId tag_id{1, 2};
+  for (int round = 0; round < 3; ++round) {
+    dirty.MarkBlob(BlobMetadataIndex::MakeKey(tag_id, "a"));
+    dirty.MarkBlob(BlobMetadataIndex::MakeKey(tag_id, "b"));
+    dirty.MarkTag(tag_id);
+  }
+
+  std::vector<std::string> keys;
+  std::vector<TagId> tag_ids;
+  dirty.Drain(keys, tag_ids);
+  REQUIRE(keys.size() == 2);
+  REQUIRE(tag_ids.size() == 1);
+  REQUIRE(tag_ids[0] == tag_id);
+
+  keys.clear();
+  tag_ids.clear();
+  dirty.Drain(keys, tag_ids);
+  REQUIRE(keys.empty());
+  REQUIRE(tag_ids.empty());
+}
+
+TEST_CASE("MetadataCheckpoint - Delta Files", "[cte][wal]") {
+  std::string path = GetTempLogPath("checkpoint");
+  for (chi::u64 seq : {10, 2, 7}) {
+    std::string tmp = MetadataCheckpoint::DeltaPath(path, seq) + ".tmp";
+    std::ofstream(tmp) << "delta";
+    REQUIRE(MetadataCheckpoint::Publish(tmp, MetadataCheckpoint::DeltaPath(
+                                                 path, seq)));
+    REQUIRE(!std::filesystem::exists(tmp));
+  }
+  std::ofstream(path + ".delta.x") << "not a delta";
+
+  auto seqs = MetadataCheckpoint::ListDeltas(path);
+  REQUIRE(seqs.size() == 3);
+  REQUIRE(seqs[0] == 2);
+  REQUIRE(seqs[1] == 7);
+  REQUIRE(seqs[2] == 10);
+
+  MetadataCheckpoint::RemoveDeltas(path, {2, 7});
+  seqs = MetadataCheckpoint::ListDeltas(path);
+  REQUIRE(seqs.size() == 1);
+  REQUIRE(seqs[0] == 10);
+  CleanupLog(path);
+}
+
+TEST_CASE("MetadataCheckpoint - Tag Index Locates Sections", "[cte][wal]") {
+  std::ostringstream image;
+  image << "prefix";  // Hash id and tag entries
+  CheckpointTagIndex index;
+  index.blobs_begin_ = static_cast<chi::u64>(image.tellp());
+  index.flags_ = CheckpointTagIndex::kNoSharedBlocks;
+  index.AddSection(image, TagId{1, 2}, "first tag blobs");
+  index.AddSection(image, TagId{1, 3}, "");
+  index.AddSection(image, TagId{4, 5}, "third");
+  index.Write(image);
+  std::string bytes = std::move(image).str();
+
+  CheckpointTagIndex parsed;
+  REQUIRE(parsed.Parse(bytes.data(), bytes.size()));
+  REQUIRE(parsed.flags_ == CheckpointTagIndex::kNoSharedBlocks);
+  REQUIRE(parsed.blobs_begin_ == 6);
+  REQUIRE(parsed.sections_.size() == 3);
+  const auto &first = parsed.sections_[0];
+  REQUIRE(first.tag_id_ == (TagId{1, 2}));
+  REQUIRE(bytes.substr(first.begin_, first.end_ - first.begin_) ==
+          "first tag blobs");
+  REQUIRE(parsed.sections_[1].begin_ == parsed.sections_[1].end_);
+  for (const auto &section : parsed.sections_) {
+    REQUIRE(CheckpointTagIndex::Verify(bytes.data(), section));
+  }
+
+  // A flipped blob byte fails only its own section
+  std::string damaged = bytes;
+  damaged[first.begin_ + 2] ^= 0x20;
+  REQUIRE(parsed.Parse(damaged.data(), damaged.size()));
+  REQUIRE(!CheckpointTagIndex::Verify(damaged.data(), parsed.sections_[0]));
+  REQUIRE(CheckpointTagIndex::Verify(damaged.data(), parsed.sections_[2]));
+
+  // A damaged index, a truncated image and an image without one are rejected
+  damaged = bytes;
+  damaged[bytes.size() - CheckpointTagIndex::kTrailerSize - 3] ^= 1;
+  REQUIRE(!parsed.Parse(damaged.data(), damaged.size()));
+  REQUIRE(!parsed.Parse(bytes.data(), bytes.size() - 1));
+  REQUIRE(!parsed.Parse(bytes.data(), 6));
+}
+
+SIMPLE_TEST_MAIN()
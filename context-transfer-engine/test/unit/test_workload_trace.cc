@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "simple_test.h"
+#include <wrp_cte/core/workload_trace.h>
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wrp_cte::core;
+
+namespace {
+
+std::string TracePath(const char *name) {
+  return "/tmp/test_workload_trace_" + std::to_string(getpid()) + "_" + name +
+         ".wlt";
+}
+
+}  // namespace
+
+TEST_CASE("WorkloadTrace - Records Round Trip", "[cte][workload_trace]") {
+  std::string path = TracePath("roundtrip");
+  REQUIRE(!WorkloadRecorder::IsEnabled());
+  REQUIRE(WorkloadRecorder::Start(path));
+  REQUIRE(WorkloadRecorder::IsEnabled());
+  WorkloadRecorder::Record(WorkloadOp::kGetOrCreateTag, TagId::GetNull(),
+                           "dataset");
+  WorkloadRecorder::BindTag("dataset", TagId(4, 9));
+  WorkloadRecorder::Record(WorkloadOp::kPutBlob, TagId(4, 9), "chunk.0", 128,
+                           4096, 0.75f, 3);
+  WorkloadRecorder::Record(WorkloadOp::kGetTagSize, TagId(4, 9), nullptr);
+  WorkloadRecorder::Stop();
+  REQUIRE(!WorkloadRecorder::IsEnabled());
+  // Dropped once stopped
+  WorkloadRecorder::Record(WorkloadOp::kDelTag, TagId(4, 9), nullptr);
+
+  WorkloadTraceReader reader;
+  REQUIRE(reader.Open(path));
+  REQUIRE(reader.GetHeader().pid_ == static_cast<uint32_t>(getpid()));
+  REQUIRE(reader.GetHeader().start_wall_ns_ > 0);
+
+  std::vector<WorkloadEvent> events;
+  WorkloadEvent ev;
+  while (reader.Next(ev)) {
+    events.push_back(ev);
+  }
+  REQUIRE(events.size() == 4);
+  REQUIRE(events[0].GetOp() == WorkloadOp::kGetOrCreateTag);
+  REQUIRE(events[0].name_ == "dataset");
+  REQUIRE(events[0].GetTagId().IsNull());
+  REQUIRE(events[1].GetOp() == WorkloadOp::kTagBind);
+  REQUIRE(events[1].GetTagId() == TagId(4, 9));
+  REQUIRE(events[2].GetOp() == WorkloadOp::kPutBlob);
+  REQUIRE(events[2].name_ == "chunk.0");
+  REQUIRE(events[2].rec_.offset_ == 128);
+  REQUIRE(events[2].rec_.size_ == 4096);
+  REQUIRE(events[2].rec_.score_ == 0.75f);
+  REQUIRE(events[2].rec_.flags_ == 3);
+  REQUIRE(events[3].GetOp() == WorkloadOp::kGetTagSize);
+  REQUIRE(events[3].name_.empty());
+  for (size_t i = 1; i < events.size(); ++i) {
+    REQUIRE(events[i].rec_.ts_ns_ >= events[i - 1].rec_.ts_ns_);
+  }
+  reader.Close();
+  std::remove(path.c_str());
+}
+
+TEST_CASE("WorkloadTrace - Threads Get Distinct Indices",
+          "[cte][workload_trace]") {
+  std::string path = TracePath("threads");
+  REQUIRE(WorkloadRecorder::Start(path));
+  constexpr int kThreads = 4;
+  constexpr int kOpsPerThread = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([t] {
+      for (int i = 0; i < kOpsPerThread; ++i) {
+        WorkloadRecorder::Record(WorkloadOp::kGetBlob, TagId(1, t),
+                                 "blob", i, 64);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  WorkloadRecorder::Stop();
+
+  WorkloadTraceReader reader;
+  REQUIRE(reader.Open(path));
+  std::vector<int> per_tag(kThreads, 0);
+  std::vector<uint32_t> thread_of_tag(kThreads, UINT32_MAX);
+  uint64_t last_ts = 0;
+  size_t total = 0;
+  WorkloadEvent ev;
+  while (reader.Next(ev)) {
+    uint32_t t = ev.rec_.tag_minor_;
+    REQUIRE(t < static_cast<uint32_t>(kThreads));
+    // One writer thread per tag, so its index is stable
+    if (thread_of_tag[t] == UINT32_MAX) {
+      thread_of_tag[t] = ev.rec_.thread_;
+    }
+    REQUIRE(thread_of_tag[t] == ev.rec_.thread_);
+    REQUIRE(ev.rec_.offset_ == static_cast<uint64_t>(per_tag[t]));
+    REQUIRE(ev.rec_.ts_ns_ >= last_ts);
+    last_ts = ev.rec_.ts_ns_;
+    ++per_tag[t];
+    ++total;
+  }
+  REQUIRE(total == static_cast<size_t>(kThreads * kOpsPerThread));
+  for (int t = 0; t < kThreads; ++t) {
+    REQUIRE(per_tag[t] == kOpsPerThread);
+    for (int u = 0; u < t; ++u) {
+      REQUIRE(thread_of_tag[t] != thread_of_tag[u]);
+    }
+  }
+  reader.Close();
+  std::remove(path.c_str());
+}
+
+TEST_CASE("WorkloadTrace - Rejects Foreign Files", "[cte][workload_trace]") {
+  std::string path = TracePath("foreign");
+  FILE *file = fopen(path.c_str(), "wb");
+  REQUIRE(file != nullptr);
+  std::string junk(200, 'x');
+  fwrite(junk.data(), 1, junk.size(), file);
+  fclose(file);
+  WorkloadTraceReader reader;
+  REQUIRE(!reader.Open(path));
+  REQUIRE(!reader.Open(TracePath("missing")));
+  std::remove(path.c_str());
+}
+
+SIMPLE_TEST_MAIN()
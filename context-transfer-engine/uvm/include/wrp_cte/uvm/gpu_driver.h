@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef WRP_CTE_UVM_GPU_DRIVER_H_
+#define WRP_CTE_UVM_GPU_DRIVER_H_
+
+/**
+ * GPU driver/runtime API used by the VMM.
+ *
+ * CUDA builds include cuda.h / cuda_runtime.h unchanged. ROCm builds
+ * (WRP_CTE_UVM_ENABLE_ROCM, set by the wrp_cte_uvm target) map the CUDA
+ * names the VMM and its users rely on to the HIP virtual memory API
+ * (hipMemAddressReserve, hipMemCreate, hipMemMap, hipMemSetAccess, ...),
+ * so one source tree drives demand paging on NVIDIA and AMD GPUs.
+ *
+ * HIP takes void * device addresses where the CUDA driver API takes
+ * CUdeviceptr integers; the inline wrappers below do that conversion so
+ * page arithmetic (va_base_ + i * page_size_) stays integral.
+ */
+
+#if WRP_CTE_UVM_ENABLE_ROCM
+
+#include <hip/hip_runtime.h>
+
+#include <cstddef>
+
+// --- Driver API types and constants -----------------------------------------
+typedef hipError_t CUresult;
+typedef hipDevice_t CUdevice;
+typedef unsigned long long CUdeviceptr;
+typedef hipMemGenericAllocationHandle_t CUmemGenericAllocationHandle;
+typedef hipMemAllocationProp CUmemAllocationProp;
+typedef hipMemAccessDesc CUmemAccessDesc;
+
+#define CUDA_SUCCESS hipSuccess
+#define CUDA_ERROR_INVALID_VALUE hipErrorInvalidValue
+#define CUDA_ERROR_OUT_OF_MEMORY hipErrorOutOfMemory
+#define CUDA_ERROR_NOT_PERMITTED hipErrorNotSupported
+#define CU_MEM_ALLOCATION_TYPE_PINNED hipMemAllocationTypePinned
+#define CU_MEM_LOCATION_TYPE_DEVICE hipMemLocationTypeDevice
+#define CU_MEM_ALLOC_GRANULARITY_MINIMUM hipMemAllocationGranularityMinimum
+#define CU_MEM_ACCESS_FLAGS_PROT_READWRITE hipMemAccessFlagsProtReadWrite
+
+// --- Driver API functions ---------------------------------------------------
+inline CUresult cuInit(unsigned int flags) { return hipInit(flags); }
+
+inline CUresult cuDeviceGet(CUdevice *device, int ordinal) {
+  return hipDeviceGet(device, ordinal);
+}
+
+inline CUresult cuDevicePrimaryCtxRelease(CUdevice device) {
+  return hipDevicePrimaryCtxRelease(device);
+}
+
+inline CUresult cuMemGetAllocationGranularity(
+    size_t *granularity, const CUmemAllocationProp *prop,
+    hipMemAllocationGranularity_flags option) {
+  return hipMemGetAllocationGranularity(granularity, prop, option);
+}
+
+inline CUresult cuMemAddressReserve(CUdeviceptr *ptr, size_t size,
+                                    size_t alignment, CUdeviceptr addr,
+                                    unsigned long long flags) {
+  void *base = nullptr;
+  hipError_t res = hipMemAddressReserve(
+      &base, size, alignment, reinterpret_cast<void *>(addr), flags);
+  *ptr = reinterpret_cast<CUdeviceptr>(base);
+  return res;
+}
+
+inline CUresult cuMemAddressFree(CUdeviceptr ptr, size_t size) {
+  return hipMemAddressFree(reinterpret_cast<void *>(ptr), size);
+}
+
+inline CUresult cuMemCreate(CUmemGenericAllocationHandle *handle, size_t size,
+                            const CUmemAllocationProp *prop,
+                            unsigned long long flags) {
+  return hipMemCreate(handle, size, prop, flags);
+}
+
+inline CUresult cuMemRelease(CUmemGenericAllocationHandle handle) {
+  return hipMemRelease(handle);
+}
+
+inline CUresult cuMemMap(CUdeviceptr ptr, size_t size, size_t offset,
+                         CUmemGenericAllocationHandle handle,
+                         unsigned long long flags) {
+  return hipMemMap(reinterpret_cast<void *>(ptr), size, offset, handle, flags);
+}
+
+inline CUresult cuMemUnmap(CUdeviceptr ptr, size_t size) {
+  return hipMemUnmap(reinterpret_cast<void *>(ptr), size);
+}
+
+inline CUresult cuMemSetAccess(CUdeviceptr ptr, size_t size,
+                               const CUmemAccessDesc *desc, size_t count) {
+  return hipMemSetAccess(reinterpret_cast<void *>(ptr), size, desc, count);
+}
+
+inline CUresult cuMemsetD32(CUdeviceptr ptr, unsigned int value,
+                            size_t count) {
+  return hipMemsetD32(reinterpret_cast<hipDeviceptr_t>(ptr),
+                      static_cast<int>(value), count);
+}
+
+inline CUresult cuMemsetD32Async(CUdeviceptr ptr, unsigned int value,
+                                 size_t count, hipStream_t stream) {
+  return hipMemsetD32Async(reinterpret_cast<hipDeviceptr_t>(ptr),
+                           static_cast<int>(value), count, stream);
+}
+
+// --- Runtime API ------------------------------------------------------------
+typedef hipError_t cudaError_t;
+typedef hipStream_t cudaStream_t;
+typedef hipEvent_t cudaEvent_t;
+typedef hipGraph_t cudaGraph_t;
+typedef hipGraphExec_t cudaGraphExec_t;
+
+#define cudaSuccess hipSuccess
+#define cudaGetErrorString hipGetErrorString
+#define cudaDeviceSynchronize hipDeviceSynchronize
+#define cudaStreamCreate hipStreamCreate
+#define cudaStreamDestroy hipStreamDestroy
+#define cudaStreamSynchronize hipStreamSynchronize
+#define cudaEventCreateWithFlags hipEventCreateWithFlags
+#define cudaEventDisableTiming hipEventDisableTiming
+#define cudaEventRecord hipEventRecord
+#define cudaEventQuery hipEventQuery
+#define cudaEventDestroy hipEventDestroy
+#define cudaErrorNotReady hipErrorNotReady
+#define cudaMalloc hipMalloc
+#define cudaFree hipFree
+#define cudaMallocHost(ptr, size) hipHostMalloc(ptr, size, hipHostMallocDefault)
+#define cudaFreeHost hipHostFree
+#define cudaMemset hipMemset
+#define cudaMemcpy hipMemcpy
+#define cudaMemcpyAsync hipMemcpyAsync
+#define cudaMemcpyHostToDevice hipMemcpyHostToDevice
+#define cudaMemcpyDeviceToHost hipMemcpyDeviceToHost
+#define cudaMemcpyDeviceToDevice hipMemcpyDeviceToDevice
+#define cudaStreamBeginCapture hipStreamBeginCapture
+#define cudaStreamEndCapture hipStreamEndCapture
+#define cudaStreamCaptureModeThreadLocal hipStreamCaptureModeThreadLocal
+#define cudaGraphInstantiate hipGraphInstantiateWithFlags
+#define cudaGraphLaunch hipGraphLaunch
+#define cudaGraphExecDestroy hipGraphExecDestroy
+#define cudaGraphDestroy hipGraphDestroy
+
+#else
+
+#include <cuda.h>
+#include <cuda_runtime.h>
+
+#endif  // WRP_CTE_UVM_ENABLE_ROCM
+
+#endif  // WRP_CTE_UVM_GPU_DRIVER_H_
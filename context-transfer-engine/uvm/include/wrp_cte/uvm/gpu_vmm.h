@@ -34,17 +34,17 @@
 #ifndef WRP_CTE_UVM_GPU_VMM_H_
 #define WRP_CTE_UVM_GPU_VMM_H_
 
-#include <cuda.h>
-#include <cuda_runtime.h>
-
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "wrp_cte/uvm/gpu_driver.h"
+
 #ifdef WRP_CTE_AVAILABLE
 #include <wrp_cte/core/core_client.h>
 #endif
@@ -57,9 +57,46 @@ struct GpuVmmConfig {
   size_t page_size = 2ULL * 1024 * 1024;               // 2 MB (GPU granularity)
   int fill_value = 5;                                   // Default fill value
   int device = 0;                                       // CUDA device ordinal
-  size_t prefetch_window = 4;                           // Pages to prefetch ahead on touch
+  size_t prefetch_window = 4;                           // Initial prefetch degree (0 = off)
+  bool adaptive_prefetch = true;                         // Stride detection + accuracy feedback
+  size_t prefetch_max_degree = 16;                       // Adaptive degree cap (predicted accesses)
+  size_t prefetch_max_inflight = 32;                     // Pages in flight before prefetch throttles
   bool use_cte = false;                                  // Use CTE blob store instead of host RAM
   std::string cte_tag_name = "gpu_vmm_pages";            // CTE tag name for page blobs
+  size_t handle_pool_pages = 64;                         // Evicted physical pages kept for reuse
+  std::string page_codec = "";                           // nvCOMP codec for evicted pages: bitcomp, cascaded, lz4 ("" = raw)
+};
+
+/** Prefetcher counters and current tuning, see getPrefetchStats() */
+struct GpuVmmPrefetchStats {
+  uint64_t issued = 0;      // Pages mapped by prefetch
+  uint64_t useful = 0;      // Prefetched pages later touched on demand
+  uint64_t late = 0;        // Useful pages touched before their copy finished
+  uint64_t wasted = 0;      // Prefetched pages evicted or aged out untouched
+  uint64_t throttled = 0;   // Prefetches cut short by the in-flight cap
+  uint64_t suppressed = 0;  // Prefetches skipped for irregular access
+  size_t degree = 0;        // Predicted accesses prefetched per touch
+  size_t distance = 0;      // Accesses ahead of the touch the first one starts
+  int64_t stride = 0;       // Confirmed stride in pages (0 = none)
+
+  /** Fraction of resolved prefetched pages that were useful */
+  double accuracy() const {
+    uint64_t resolved = useful + wasted;
+    return resolved ? static_cast<double>(useful) / resolved : 0.0;
+  }
+};
+
+/** Eviction compression counters, see getCompressStats() */
+struct GpuVmmCompressStats {
+  uint64_t pages_compressed = 0;  // Evictions stored compressed
+  uint64_t pages_raw = 0;         // Evictions stored raw (no codec, or no gain)
+  uint64_t bytes_in = 0;          // Page bytes evicted
+  uint64_t bytes_out = 0;         // Bytes copied device-to-host and stored
+
+  /** Evicted bytes per stored byte (1.0 when nothing was compressed) */
+  double ratio() const {
+    return bytes_out ? static_cast<double>(bytes_in) / bytes_out : 1.0;
+  }
 };
 
 /**
@@ -74,6 +111,33 @@ struct GpuVmmConfig {
  * across eviction cycles. Async variants and prefetching allow overlapping
  * data transfer with GPU compute.
  *
+ * The range variants (touchPages, touchPagesAsync, evictPages) work on
+ * contiguous runs: each run gets one cuMemSetAccess / cuMemUnmap and one
+ * transfer-stream sync instead of one per page.  Physical pages released by
+ * eviction are kept in a bounded pool (handle_pool_pages) and reused by the
+ * next touch instead of a cuMemRelease / cuMemCreate round trip.
+ *
+ * Page mapping goes through cuMemMap / cuMemSetAccess, which cannot be
+ * recorded into a CUDA graph. Work that is replayed from a captured graph
+ * must only address pages made resident with pinPages(): pinned pages are
+ * skipped by evictPages and refused by evictPage / evictPageAsync until
+ * unpinPages() releases them.
+ *
+ * With page_codec set (nvCOMP builds only), evicted pages are compressed on
+ * the device before the D2H copy and expanded on the device after the H2D
+ * copy on refault, so only compressed bytes cross PCIe and sit in host RAM.
+ * Pages that do not shrink are stored raw.
+ *
+ * With adaptive_prefetch, demand touches feed a stride detector: once the
+ * same page delta repeats, prefetch follows that stride instead of the next
+ * sequential pages. Prefetched pages are resolved as useful when touched and
+ * as wasted when evicted or left untouched for a few accesses; the degree
+ * doubles while accuracy stays high and halves when it drops, and the
+ * distance grows when touches land on copies still in flight. Irregular
+ * access with poor accuracy suppresses prefetch apart from periodic probes,
+ * and no new prefetch is queued while prefetch_max_inflight pages are still
+ * copying on the transfer stream.
+ *
  * This runs entirely in userspace with no root privileges required.
  */
 class GpuVirtualMemoryManager {
@@ -118,6 +182,19 @@ class GpuVirtualMemoryManager {
    */
   CUresult touchPageAsync(size_t page_index);
 
+  /**
+   * Ensure pages [first_page, first_page+count) are backed (synchronous).
+   * Unmapped runs are mapped in one batch each. Triggers prefetchAhead
+   * past the end of the range.
+   */
+  CUresult touchPages(size_t first_page, size_t count);
+
+  /**
+   * Async variant of touchPages on the transfer stream. Does NOT trigger
+   * prefetch. Caller must syncTransfer() before accessing.
+   */
+  CUresult touchPagesAsync(size_t first_page, size_t count);
+
   /**
    * Touch all pages covering the given byte range [offset, offset+size).
    */
@@ -132,6 +209,7 @@ class GpuVirtualMemoryManager {
   /**
    * Evict a page (synchronous): save to host RAM, then unmap and release.
    * The VA slot remains reserved. Data is preserved for future touchPage.
+   * Returns CUDA_ERROR_NOT_PERMITTED for a pinned page.
    */
   CUresult evictPage(size_t page_index);
 
@@ -141,9 +219,53 @@ class GpuVirtualMemoryManager {
    */
   CUresult evictPageAsync(size_t page_index);
 
-  /** Prefetch pages [page_index+1 .. page_index+window] asynchronously */
+  /**
+   * Evict pages [first_page, first_page+count) that are mapped and not
+   * pinned. Each run of
+   * mapped pages is copied out with one transfer-stream sync and unmapped
+   * with a single cuMemUnmap.
+   */
+  CUresult evictPages(size_t first_page, size_t count);
+
+  /**
+   * Make pages [first_page, first_page+count) resident (synchronous) and
+   * pin them so that eviction leaves them mapped. Use this before capturing
+   * a CUDA graph that touches the range: the graph can then be replayed
+   * without any page-table changes in between.
+   */
+  CUresult pinPages(size_t first_page, size_t count);
+
+  /** Allow pages [first_page, first_page+count) to be evicted again */
+  CUresult unpinPages(size_t first_page, size_t count);
+
+  /** Check whether a page is pinned resident */
+  bool isPinned(size_t page_index) const;
+
+  /** Number of physical pages parked in the reuse pool */
+  size_t getPooledHandleCount() const;
+
+  /** Release pooled physical pages until at most keep remain */
+  void trimHandlePool(size_t keep = 0);
+
+  /**
+   * Prefetch the pages predicted to follow a touch of page_index
+   * asynchronously: the next prefetch_window pages, or the adaptive
+   * stride/degree/distance when adaptive_prefetch is set.
+   */
   void prefetchAhead(size_t page_index);
 
+  /** Snapshot of the eviction compression counters */
+  GpuVmmCompressStats getCompressStats() const;
+
+  /** Pinned host bytes currently held by the backing store */
+  size_t getHostBackingBytes() const;
+
+  /** Snapshot of the prefetch counters and current tuning */
+  GpuVmmPrefetchStats getPrefetchStats() const;
+
+  /** Zero the prefetch counters (tuning is kept) */
+  void resetPrefetchStats();
+
   /** Get the device pointer for a specific page */
   CUdeviceptr getPagePtr(size_t page_index) const;
 
@@ -167,18 +289,82 @@ class GpuVirtualMemoryManager {
   int fill_value_ = 5;
   CUdevice device_ = 0;
   size_t prefetch_window_ = 4;
+  size_t handle_pool_pages_ = 64;
 
   struct PageEntry {
     CUmemGenericAllocationHandle alloc_handle = 0;
     bool mapped = false;
     bool evicted_to_host = false;
+    bool pinned = false;  // Held resident for graph replay
+    uint64_t prefetch_batch = 0;  // Prefetch batch not yet resolved (0 = none)
+    size_t stored_bytes = 0;      // Bytes in the backing store (0 = page size)
+    bool compressed = false;      // Backing store holds page_codec output
+  };
+
+  /** A pinned host buffer holding one evicted page */
+  struct HostPage {
+    char *data = nullptr;
+    size_t capacity = 0;
+  };
+
+  /** Device-side page compressor (defined in gpu_vmm.cu) */
+  class PageCodec;
+
+  /** A batch of prefetch copies queued on the transfer stream */
+  struct PrefetchBatch {
+    cudaEvent_t done;  // Recorded after the batch's copies
+    uint64_t id;
+    size_t pages;
+  };
+
+  /** A prefetched page awaiting a demand touch */
+  struct PrefetchedPage {
+    size_t page_index;
+    uint64_t batch;
+    uint64_t expire_access;  // access_seq_ after which it counts as wasted
   };
 
+  static constexpr uint32_t kStrideConfirm = 2;   // Repeats that confirm a stride
+  static constexpr uint64_t kPrefetchEpoch = 16;  // Resolved pages per retune
+  static constexpr uint64_t kProbeInterval = 32;  // Suppressed calls per probe
+  static constexpr double kHighAccuracy = 0.75;
+  static constexpr double kLowAccuracy = 0.40;
+
+  // Adaptive prefetch state (guarded by mutex_)
+  bool adaptive_prefetch_ = true;
+  size_t prefetch_max_degree_ = 16;
+  size_t prefetch_max_inflight_ = 32;
+  size_t last_access_ = SIZE_MAX;  // First page of the previous demand touch
+  int64_t stride_ = 0;             // Last page delta between demand touches
+  uint32_t stride_hits_ = 0;       // Consecutive touches with that delta
+  size_t degree_ = 4;
+  size_t distance_ = 1;
+  double last_accuracy_ = 1.0;     // Accuracy of the last closed epoch
+  uint64_t epoch_useful_ = 0;
+  uint64_t epoch_wasted_ = 0;
+  uint64_t epoch_late_ = 0;
+  uint64_t suppress_run_ = 0;      // Suppressed prefetches since the last probe
+  uint64_t access_seq_ = 0;        // Demand touches seen
+  uint64_t next_batch_ = 1;
+  uint64_t completed_batch_ = 0;   // Newest batch whose copies finished
+  size_t inflight_pages_ = 0;
+  std::deque<PrefetchBatch> inflight_batches_;
+  std::deque<PrefetchedPage> outstanding_;
+  std::vector<cudaEvent_t> free_events_;
+  GpuVmmPrefetchStats prefetch_stats_;
+
   std::vector<PageEntry> page_table_;
   mutable std::mutex mutex_;
 
+  // Unmapped physical pages (page_size_ each) ready for reuse
+  std::vector<CUmemGenericAllocationHandle> free_handles_;
+
   // Host RAM backing store: page_index -> pinned host buffer
-  std::unordered_map<size_t, char *> host_backing_store_;
+  std::unordered_map<size_t, HostPage> host_backing_store_;
+
+  // Eviction compression (null without page_codec)
+  std::unique_ptr<PageCodec> codec_;
+  GpuVmmCompressStats compress_stats_;
 
   // CUDA streams for async overlap
   cudaStream_t transfer_stream_ = nullptr;
@@ -190,11 +376,51 @@ class GpuVirtualMemoryManager {
   std::unique_ptr<wrp_cte::core::Tag> cte_tag_;
 #endif
 
-  /** Allocate physical memory, map into VA, set access (no fill) */
-  CUresult mapAndBackPage_(size_t page_index);
+  /** Take a physical page from the pool, or create one */
+  CUresult acquireHandle_(CUmemGenericAllocationHandle *handle);
+
+  /** Return a physical page to the pool, releasing it when the pool is full */
+  void recycleHandle_(CUmemGenericAllocationHandle handle);
+
+  /** Back and map an unmapped run, one cuMemSetAccess for the run (no fill) */
+  CUresult mapRun_(size_t first_page, size_t count);
+
+  /** Restore a freshly mapped page from its backing store, or fill it */
+  void restorePage_(size_t page_index, bool async);
+
+  /** Map and restore every unmapped page in the range */
+  CUresult touchRun_(size_t first_page, size_t count, bool async);
+
+  /** Save, unmap and recycle a run of mapped pages */
+  CUresult evictRun_(size_t first_page, size_t count, bool async);
 
   /** Free all pinned host backing store buffers */
   void freeHostBackingStore_();
+
+  /**
+   * Pinned host buffer of at least bytes for a page, reusing the page's
+   * existing buffer when it is big enough and not more than twice as big.
+   * Returns nullptr if the allocation fails.
+   */
+  char *reserveHostPage_(size_t page_index, size_t bytes);
+
+  /** Copy stored bytes (host or SHM) into a mapped page, expanding them */
+  void loadPage_(size_t page_index, const char *src, bool async);
+
+  /** Resolve prefetched pages in a demand touch and update the detector */
+  void noteDemand_(size_t first_page, size_t count);
+
+  /** Prefetch after a demand touch of [first_page, first_page+count) */
+  void prefetch_(size_t first_page, size_t count);
+
+  /** Retire prefetch batches whose transfer-stream copies have finished */
+  void reapPrefetches_();
+
+  /** Count a still-unresolved prefetched page as wasted */
+  void wastePrefetch_(PageEntry &entry);
+
+  /** Close an accuracy epoch and retune degree and distance */
+  void adaptPrefetch_();
 };
 
 }  // namespace wrp_cte::uvm
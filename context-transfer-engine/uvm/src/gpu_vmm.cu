@@ -33,15 +33,121 @@
 
 #include "wrp_cte/uvm/gpu_vmm.h"
 
-#include <cuda.h>
-#include <cuda_runtime.h>
-
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
+#include <exception>
 #include <string>
 
+#ifdef WRP_CTE_UVM_ENABLE_NVCOMP
+#include <nvcomp/bitcomp.hpp>
+#include <nvcomp/cascaded.hpp>
+#include <nvcomp/lz4.hpp>
+#endif
+
 namespace wrp_cte::uvm {
 
+/**
+ * nvCOMP page compressor. Compresses a mapped page into a device scratch
+ * buffer and expands the scratch back into a page, both on the transfer
+ * stream, so only the compressed bytes are copied across PCIe.
+ */
+class GpuVirtualMemoryManager::PageCodec {
+ public:
+  /** Build the named codec; nullptr if unknown or nvCOMP is unavailable */
+  static std::unique_ptr<PageCodec> Create(const std::string &name,
+                                           size_t page_size,
+                                           cudaStream_t stream) {
+#ifdef WRP_CTE_UVM_ENABLE_NVCOMP
+    std::unique_ptr<PageCodec> codec(new PageCodec());
+    try {
+      if (name == "bitcomp") {
+        codec->manager_ = std::make_unique<nvcomp::BitcompManager>(
+            kChunkSize, nvcompBatchedBitcompDefaultOpts, stream);
+      } else if (name == "cascaded") {
+        codec->manager_ = std::make_unique<nvcomp::CascadedManager>(
+            kChunkSize, nvcompBatchedCascadedDefaultOpts, stream);
+      } else if (name == "lz4") {
+        codec->manager_ = std::make_unique<nvcomp::LZ4Manager>(
+            kChunkSize, nvcompBatchedLZ4DefaultOpts, stream);
+      } else {
+        return nullptr;
+      }
+      codec->comp_config_ = std::make_unique<nvcomp::CompressionConfig>(
+          codec->manager_->configure_compression(page_size));
+    } catch (const std::exception &e) {
+      fprintf(stderr, "GpuVmm: nvCOMP %s setup failed: %s\n", name.c_str(),
+              e.what());
+      return nullptr;
+    }
+    size_t scratch_size = codec->comp_config_->max_compressed_buffer_size;
+    if (cudaMalloc(&codec->scratch_, scratch_size) != cudaSuccess) {
+      codec->scratch_ = nullptr;
+      return nullptr;
+    }
+    return codec;
+#else
+    (void)name;
+    (void)page_size;
+    (void)stream;
+    return nullptr;
+#endif
+  }
+
+  ~PageCodec() {
+    if (scratch_) cudaFree(scratch_);
+  }
+
+  /** Device buffer holding compressed page bytes */
+  uint8_t *scratch() const { return scratch_; }
+
+  /**
+   * Compress a device page into scratch().
+   * @return Compressed bytes (stream synchronized), or 0 on failure
+   */
+  size_t compress(const void *d_page) {
+#ifdef WRP_CTE_UVM_ENABLE_NVCOMP
+    try {
+      manager_->compress(static_cast<const uint8_t *>(d_page), scratch_,
+                         *comp_config_);
+      return manager_->get_compressed_output_size(scratch_);
+    } catch (const std::exception &e) {
+      fprintf(stderr, "GpuVmm: nvCOMP compression failed: %s\n", e.what());
+    }
+#else
+    (void)d_page;
+#endif
+    return 0;
+  }
+
+  /** Expand scratch() into a device page, queued on the transfer stream */
+  bool decompress(void *d_page) {
+#ifdef WRP_CTE_UVM_ENABLE_NVCOMP
+    try {
+      nvcomp::DecompressionConfig config =
+          manager_->configure_decompression(scratch_);
+      manager_->decompress(static_cast<uint8_t *>(d_page), scratch_, config);
+      return true;
+    } catch (const std::exception &e) {
+      fprintf(stderr, "GpuVmm: nvCOMP decompression failed: %s\n", e.what());
+    }
+#else
+    (void)d_page;
+#endif
+    return false;
+  }
+
+ private:
+  PageCodec() = default;
+
+#ifdef WRP_CTE_UVM_ENABLE_NVCOMP
+  static constexpr size_t kChunkSize = 1 << 16;  // nvCOMP chunk (64 KB)
+  std::unique_ptr<nvcomp::nvcompManagerBase> manager_;
+  std::unique_ptr<nvcomp::CompressionConfig> comp_config_;
+#endif
+  uint8_t *scratch_ = nullptr;
+};
+
 GpuVirtualMemoryManager::GpuVirtualMemoryManager() = default;
 
 GpuVirtualMemoryManager::~GpuVirtualMemoryManager() { destroy(); }
@@ -90,6 +196,12 @@ CUresult GpuVirtualMemoryManager::init(const GpuVmmConfig &config) {
 
   fill_value_ = config.fill_value;
   prefetch_window_ = config.prefetch_window;
+  adaptive_prefetch_ = config.adaptive_prefetch;
+  prefetch_max_degree_ = std::max(config.prefetch_max_degree, prefetch_window_);
+  prefetch_max_inflight_ = config.prefetch_max_inflight;
+  degree_ = prefetch_window_;
+  distance_ = 1;
+  handle_pool_pages_ = config.handle_pool_pages;
   total_pages_ = va_size_ / page_size_;
 
   // Reserve virtual address range -- no physical memory is consumed here
@@ -110,6 +222,17 @@ CUresult GpuVirtualMemoryManager::init(const GpuVmmConfig &config) {
   cudaStreamCreate(&transfer_stream_);
   cudaStreamCreate(&compute_stream_);
 
+  // Device-side compression of evicted pages
+  compress_stats_ = GpuVmmCompressStats();
+  if (!config.page_codec.empty()) {
+    codec_ = PageCodec::Create(config.page_codec, page_size_, transfer_stream_);
+    if (!codec_) {
+      fprintf(stderr,
+              "GpuVmm: page_codec '%s' unavailable, evicting raw pages\n",
+              config.page_codec.c_str());
+    }
+  }
+
   // Initialize CTE backing store if requested
 #ifdef WRP_CTE_AVAILABLE
   use_cte_ = config.use_cte;
@@ -127,11 +250,13 @@ CUresult GpuVirtualMemoryManager::init(const GpuVmmConfig &config) {
           "  Page size:     %zu bytes (%.2f MB)\n"
           "  Total pages:   %zu\n"
           "  HW granularity: %zu bytes\n"
-          "  Prefetch window: %zu pages\n",
+          "  Prefetch window: %zu pages (%s)\n"
+          "  Page codec:    %s\n",
           (unsigned long long)va_base_, va_size_,
           (double)va_size_ / (1024.0 * 1024 * 1024 * 1024), page_size_,
           (double)page_size_ / (1024.0 * 1024), total_pages_, granularity,
-          prefetch_window_);
+          prefetch_window_, adaptive_prefetch_ ? "adaptive" : "sequential",
+          codec_ ? config.page_codec.c_str() : "none");
 
   return CUDA_SUCCESS;
 }
@@ -152,14 +277,32 @@ void GpuVirtualMemoryManager::destroy() {
     }
   }
 
-  // Free all host backing store buffers
+  // Release recycled physical pages
+  for (CUmemGenericAllocationHandle handle : free_handles_) {
+    cuMemRelease(handle);
+  }
+  free_handles_.clear();
+
+  // Free all host backing store buffers and the codec scratch
   freeHostBackingStore_();
+  codec_.reset();
 
   // Release CTE tag
 #ifdef WRP_CTE_AVAILABLE
   cte_tag_.reset();
 #endif
 
+  // Release prefetch completion events and detector state
+  for (PrefetchBatch &batch : inflight_batches_) cudaEventDestroy(batch.done);
+  for (cudaEvent_t event : free_events_) cudaEventDestroy(event);
+  inflight_batches_.clear();
+  free_events_.clear();
+  outstanding_.clear();
+  inflight_pages_ = 0;
+  last_access_ = SIZE_MAX;
+  stride_ = 0;
+  stride_hits_ = 0;
+
   // Destroy CUDA streams
   if (transfer_stream_) {
     cudaStreamDestroy(transfer_stream_);
@@ -199,200 +342,266 @@ size_t GpuVirtualMemoryManager::getEvictedPageCount() const {
   return count;
 }
 
-CUresult GpuVirtualMemoryManager::mapAndBackPage_(size_t page_index) {
+CUresult GpuVirtualMemoryManager::acquireHandle_(
+    CUmemGenericAllocationHandle *handle) {
   // Caller must hold mutex_
-  PageEntry &entry = page_table_[page_index];
+  if (!free_handles_.empty()) {
+    *handle = free_handles_.back();
+    free_handles_.pop_back();
+    return CUDA_SUCCESS;
+  }
 
-  // Allocate physical memory
   CUmemAllocationProp prop = {};
   prop.type = CU_MEM_ALLOCATION_TYPE_PINNED;
   prop.location.type = CU_MEM_LOCATION_TYPE_DEVICE;
   prop.location.id = device_;
+  return cuMemCreate(handle, page_size_, &prop, 0);
+}
 
-  CUresult res = cuMemCreate(&entry.alloc_handle, page_size_, &prop, 0);
-  if (res != CUDA_SUCCESS) {
-    fprintf(stderr, "GpuVmm: cuMemCreate failed for page %zu: %d\n",
-            page_index, res);
-    return res;
+void GpuVirtualMemoryManager::recycleHandle_(
+    CUmemGenericAllocationHandle handle) {
+  // Caller must hold mutex_
+  if (free_handles_.size() < handle_pool_pages_) {
+    free_handles_.push_back(handle);
+  } else {
+    cuMemRelease(handle);
   }
+}
 
-  // Map into VA slot
-  CUdeviceptr page_addr = va_base_ + page_index * page_size_;
-  res = cuMemMap(page_addr, page_size_, 0, entry.alloc_handle, 0);
-  if (res != CUDA_SUCCESS) {
-    fprintf(stderr, "GpuVmm: cuMemMap failed for page %zu: %d\n",
-            page_index, res);
-    cuMemRelease(entry.alloc_handle);
-    return res;
+CUresult GpuVirtualMemoryManager::mapRun_(size_t first_page, size_t count) {
+  // Caller must hold mutex_; every page in the run must be unmapped.
+  // Each page keeps its own physical handle so it can be evicted alone,
+  // but the whole run gets a single cuMemSetAccess.
+  CUdeviceptr run_addr = va_base_ + first_page * page_size_;
+  size_t done = 0;
+  CUresult res = CUDA_SUCCESS;
+  for (; done < count; ++done) {
+    size_t page_index = first_page + done;
+    PageEntry &entry = page_table_[page_index];
+    res = acquireHandle_(&entry.alloc_handle);
+    if (res != CUDA_SUCCESS) {
+      fprintf(stderr, "GpuVmm: cuMemCreate failed for page %zu: %d\n",
+              page_index, res);
+      break;
+    }
+    res = cuMemMap(run_addr + done * page_size_, page_size_, 0,
+                   entry.alloc_handle, 0);
+    if (res != CUDA_SUCCESS) {
+      fprintf(stderr, "GpuVmm: cuMemMap failed for page %zu: %d\n",
+              page_index, res);
+      recycleHandle_(entry.alloc_handle);
+      entry.alloc_handle = 0;
+      break;
+    }
   }
 
-  // Set access permissions
-  CUmemAccessDesc access = {};
-  access.location.type = CU_MEM_LOCATION_TYPE_DEVICE;
-  access.location.id = device_;
-  access.flags = CU_MEM_ACCESS_FLAGS_PROT_READWRITE;
+  if (res == CUDA_SUCCESS) {
+    CUmemAccessDesc access = {};
+    access.location.type = CU_MEM_LOCATION_TYPE_DEVICE;
+    access.location.id = device_;
+    access.flags = CU_MEM_ACCESS_FLAGS_PROT_READWRITE;
+    res = cuMemSetAccess(run_addr, count * page_size_, &access, 1);
+    if (res != CUDA_SUCCESS) {
+      fprintf(stderr, "GpuVmm: cuMemSetAccess failed for pages [%zu, %zu): %d\n",
+              first_page, first_page + count, res);
+    }
+  }
 
-  res = cuMemSetAccess(page_addr, page_size_, &access, 1);
   if (res != CUDA_SUCCESS) {
-    fprintf(stderr, "GpuVmm: cuMemSetAccess failed for page %zu: %d\n",
-            page_index, res);
-    cuMemUnmap(page_addr, page_size_);
-    cuMemRelease(entry.alloc_handle);
+    // Roll back the pages mapped so far
+    if (done > 0) cuMemUnmap(run_addr, done * page_size_);
+    for (size_t i = 0; i < done; ++i) {
+      PageEntry &entry = page_table_[first_page + i];
+      recycleHandle_(entry.alloc_handle);
+      entry.alloc_handle = 0;
+    }
     return res;
   }
 
-  entry.mapped = true;
+  for (size_t i = 0; i < count; ++i) {
+    page_table_[first_page + i].mapped = true;
+  }
   return CUDA_SUCCESS;
 }
 
-CUresult GpuVirtualMemoryManager::touchPage(size_t page_index) {
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    if (page_index >= total_pages_) {
-      fprintf(stderr, "GpuVmm: touchPage: page_index %zu out of range [0, %zu)\n",
-              page_index, total_pages_);
-      return CUDA_ERROR_INVALID_VALUE;
-    }
-
-    PageEntry &entry = page_table_[page_index];
-    if (entry.mapped) {
-      return CUDA_SUCCESS;  // Already backed
+void GpuVirtualMemoryManager::loadPage_(size_t page_index, const char *src,
+                                        bool async) {
+  // Caller must hold mutex_; the page must be mapped.
+  PageEntry &entry = page_table_[page_index];
+  void *page_addr = (void *)(va_base_ + page_index * page_size_);
+  if (!entry.compressed) {
+    if (async) {
+      cudaMemcpyAsync(page_addr, src, page_size_, cudaMemcpyHostToDevice,
+                      transfer_stream_);
+    } else {
+      cudaMemcpy(page_addr, src, page_size_, cudaMemcpyHostToDevice);
     }
+    return;
+  }
 
-    // Allocate + map + set access
-    CUresult res = mapAndBackPage_(page_index);
-    if (res != CUDA_SUCCESS) return res;
+  // Only the compressed bytes cross PCIe; the page is rebuilt on the device
+  cudaMemcpyAsync(codec_->scratch(), src, entry.stored_bytes,
+                  cudaMemcpyHostToDevice, transfer_stream_);
+  if (!codec_->decompress(page_addr)) {
+    fprintf(stderr, "GpuVmm: failed to expand page %zu on refault\n",
+            page_index);
+  }
+  if (!async) cudaStreamSynchronize(transfer_stream_);
+}
 
-    CUdeviceptr page_addr = va_base_ + page_index * page_size_;
+void GpuVirtualMemoryManager::restorePage_(size_t page_index, bool async) {
+  // Caller must hold mutex_; the page must be mapped.
+  PageEntry &entry = page_table_[page_index];
+  CUdeviceptr page_addr = va_base_ + page_index * page_size_;
 
-    // Restore from backing store or fill with default value
-    bool restored = false;
+  // Restore from backing store or fill with default value
+  bool restored = false;
 
 #ifdef WRP_CTE_AVAILABLE
-    if (use_cte_ && entry.evicted_to_host) {
-      // Restore from CTE: AsyncGetBlob → SHM → cudaMemcpy → GPU
-      std::string blob_name = "page_" + std::to_string(page_index);
-      hipc::FullPtr<char> shm = CHI_CPU_IPC->AllocateBuffer(page_size_);
-      auto future = WRP_CTE_CLIENT->AsyncGetBlob(
-          cte_tag_->GetTagId(), blob_name, 0, page_size_, 0, shm.shm_);
-      future.Wait();
-      cudaMemcpy((void *)page_addr, shm.ptr_, page_size_,
-                 cudaMemcpyHostToDevice);
-      CHI_CPU_IPC->FreeBuffer(shm);
-      entry.evicted_to_host = false;
-      restored = true;
-    }
+  if (use_cte_ && entry.evicted_to_host) {
+    // Restore from CTE: AsyncGetBlob → SHM → cudaMemcpy → GPU
+    std::string blob_name = "page_" + std::to_string(page_index);
+    size_t stored = entry.stored_bytes ? entry.stored_bytes : page_size_;
+    hipc::FullPtr<char> shm = CHI_CPU_IPC->AllocateBuffer(stored);
+    auto future = WRP_CTE_CLIENT->AsyncGetBlob(
+        cte_tag_->GetTagId(), blob_name, 0, stored, 0, shm.shm_);
+    future.Wait();
+    loadPage_(page_index, shm.ptr_, async);
+    // SHM is pageable, so the copy is staged before cudaMemcpyAsync returns
+    CHI_CPU_IPC->FreeBuffer(shm);
+    entry.evicted_to_host = false;
+    restored = true;
+  }
 #endif
 
-    if (!restored) {
-      auto it = host_backing_store_.find(page_index);
-      if (entry.evicted_to_host && it != host_backing_store_.end()) {
-        // Restore saved data from host RAM
-        cudaMemcpy((void *)page_addr, it->second, page_size_,
-                   cudaMemcpyHostToDevice);
-        cudaFreeHost(it->second);
-        host_backing_store_.erase(it);
-        entry.evicted_to_host = false;
-      } else {
-        // Fresh page: fill with configured value using driver API memset.
-        // cuMemsetD32 uses the same driver API context as cuMemMap/cuMemSetAccess,
-        // avoiding the runtime/driver context mismatch that causes fillKernel
-        // writes to appear as 0 when read back (A100 / Polaris).
-        size_t num_ints = page_size_ / sizeof(int);
-        CUresult fill_res = cuMemsetD32(page_addr, (unsigned int)fill_value_, num_ints);
-        if (fill_res != CUDA_SUCCESS) {
-          fprintf(stderr,
-                  "GpuVmm: cuMemsetD32 failed for page %zu: %d "
-                  "(page_addr=0x%llx, fill_value=%d)\n",
-                  page_index, fill_res,
-                  (unsigned long long)page_addr, fill_value_);
-        }
-        entry.evicted_to_host = false;
-      }
+  if (restored) return;
+
+  auto it = host_backing_store_.find(page_index);
+  if (entry.evicted_to_host && it != host_backing_store_.end()) {
+    // An async restore keeps the buffer alive for the in-flight copy; the
+    // next eviction of this page reuses it
+    loadPage_(page_index, it->second.data, async);
+    if (!async) {
+      cudaFreeHost(it->second.data);
+      host_backing_store_.erase(it);
     }
+    entry.evicted_to_host = false;
+    return;
   }
 
-  // Prefetch ahead (outside mutex)
-  prefetchAhead(page_index);
+  // Fresh page: fill with configured value using driver API memset.
+  // cuMemsetD32 uses the same driver API context as cuMemMap/cuMemSetAccess,
+  // avoiding the runtime/driver context mismatch that causes fillKernel
+  // writes to appear as 0 when read back (A100 / Polaris).
+  size_t num_ints = page_size_ / sizeof(int);
+  CUresult fill_res =
+      async ? cuMemsetD32Async(page_addr, (unsigned int)fill_value_, num_ints,
+                               transfer_stream_)
+            : cuMemsetD32(page_addr, (unsigned int)fill_value_, num_ints);
+  if (fill_res != CUDA_SUCCESS) {
+    fprintf(stderr,
+            "GpuVmm: cuMemsetD32%s failed for page %zu: %d "
+            "(page_addr=0x%llx, fill_value=%d)\n",
+            async ? "Async" : "", page_index, fill_res,
+            (unsigned long long)page_addr, fill_value_);
+  }
+  entry.evicted_to_host = false;
+}
+
+CUresult GpuVirtualMemoryManager::touchRun_(size_t first_page, size_t count,
+                                            bool async) {
+  // Caller must hold mutex_; maps and restores every unmapped page, one
+  // mapRun_ per contiguous run of unmapped pages.
+  size_t end = first_page + count;
+  size_t page = first_page;
+  while (page < end) {
+    if (page_table_[page].mapped) {
+      ++page;
+      continue;
+    }
+    size_t run_end = page + 1;
+    while (run_end < end && !page_table_[run_end].mapped) ++run_end;
 
+    CUresult res = mapRun_(page, run_end - page);
+    if (res != CUDA_SUCCESS) return res;
+    for (size_t i = page; i < run_end; ++i) restorePage_(i, async);
+    page = run_end;
+  }
   return CUDA_SUCCESS;
 }
 
-CUresult GpuVirtualMemoryManager::touchPageAsync(size_t page_index) {
+CUresult GpuVirtualMemoryManager::touchPage(size_t page_index) {
   std::lock_guard<std::mutex> lock(mutex_);
 
   if (page_index >= total_pages_) {
+    fprintf(stderr, "GpuVmm: touchPage: page_index %zu out of range [0, %zu)\n",
+            page_index, total_pages_);
     return CUDA_ERROR_INVALID_VALUE;
   }
 
-  PageEntry &entry = page_table_[page_index];
-  if (entry.mapped) {
+  noteDemand_(page_index, 1);
+  if (page_table_[page_index].mapped) {
+    // Already backed; keep an adaptive prefetch stream running ahead
+    if (adaptive_prefetch_) prefetch_(page_index, 1);
     return CUDA_SUCCESS;
   }
 
-  CUresult res = mapAndBackPage_(page_index);
+  CUresult res = touchRun_(page_index, 1, false);
   if (res != CUDA_SUCCESS) return res;
 
-  CUdeviceptr page_addr = va_base_ + page_index * page_size_;
+  prefetch_(page_index, 1);
+  return CUDA_SUCCESS;
+}
 
-  bool restored = false;
+CUresult GpuVirtualMemoryManager::touchPageAsync(size_t page_index) {
+  std::lock_guard<std::mutex> lock(mutex_);
 
-#ifdef WRP_CTE_AVAILABLE
-  if (use_cte_ && entry.evicted_to_host) {
-    // Restore from CTE (sync get, then async H2D)
-    std::string blob_name = "page_" + std::to_string(page_index);
-    hipc::FullPtr<char> shm = CHI_CPU_IPC->AllocateBuffer(page_size_);
-    auto future = WRP_CTE_CLIENT->AsyncGetBlob(
-        cte_tag_->GetTagId(), blob_name, 0, page_size_, 0, shm.shm_);
-    future.Wait();
-    cudaMemcpyAsync((void *)page_addr, shm.ptr_, page_size_,
-                    cudaMemcpyHostToDevice, transfer_stream_);
-    // SHM freed after transfer completes (caller must syncTransfer)
-    CHI_CPU_IPC->FreeBuffer(shm);
-    entry.evicted_to_host = false;
-    restored = true;
+  if (page_index >= total_pages_) {
+    return CUDA_ERROR_INVALID_VALUE;
   }
-#endif
 
-  if (!restored) {
-    auto it = host_backing_store_.find(page_index);
-    if (entry.evicted_to_host && it != host_backing_store_.end()) {
-      // Async restore from host
-      cudaMemcpyAsync((void *)page_addr, it->second, page_size_,
-                      cudaMemcpyHostToDevice, transfer_stream_);
-      // Note: host buffer freed after sync (kept alive for async safety)
-      entry.evicted_to_host = false;
-    } else {
-      // Async fill using driver API for context consistency with cuMemMap
-      size_t num_ints = page_size_ / sizeof(int);
-      CUresult fill_res = cuMemsetD32Async(page_addr, (unsigned int)fill_value_,
-                                           num_ints, transfer_stream_);
-      if (fill_res != CUDA_SUCCESS) {
-        fprintf(stderr,
-                "GpuVmm: cuMemsetD32Async failed for page %zu: %d "
-                "(page_addr=0x%llx, fill_value=%d)\n",
-                page_index, fill_res,
-                (unsigned long long)page_addr, fill_value_);
-      }
-      entry.evicted_to_host = false;
-    }
+  noteDemand_(page_index, 1);
+  if (page_table_[page_index].mapped) {
+    return CUDA_SUCCESS;
   }
 
+  return touchRun_(page_index, 1, true);
+}
+
+CUresult GpuVirtualMemoryManager::touchPages(size_t first_page, size_t count) {
+  if (count == 0) return CUDA_SUCCESS;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (first_page >= total_pages_ || count > total_pages_ - first_page) {
+    fprintf(stderr, "GpuVmm: touchPages: [%zu, %zu) out of range [0, %zu)\n",
+            first_page, first_page + count, total_pages_);
+    return CUDA_ERROR_INVALID_VALUE;
+  }
+  noteDemand_(first_page, count);
+  CUresult res = touchRun_(first_page, count, false);
+  if (res != CUDA_SUCCESS) return res;
+
+  prefetch_(first_page, count);
   return CUDA_SUCCESS;
 }
 
+CUresult GpuVirtualMemoryManager::touchPagesAsync(size_t first_page,
+                                                  size_t count) {
+  if (count == 0) return CUDA_SUCCESS;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (first_page >= total_pages_ || count > total_pages_ - first_page) {
+    return CUDA_ERROR_INVALID_VALUE;
+  }
+  noteDemand_(first_page, count);
+  return touchRun_(first_page, count, true);
+}
+
 CUresult GpuVirtualMemoryManager::touchRange(size_t offset, size_t size) {
   if (size == 0) return CUDA_SUCCESS;
 
   size_t first_page = offset / page_size_;
   size_t last_page = (offset + size - 1) / page_size_;
 
-  for (size_t i = first_page; i <= last_page; ++i) {
-    CUresult res = touchPage(i);
-    if (res != CUDA_SUCCESS) return res;
-  }
-  return CUDA_SUCCESS;
+  return touchPages(first_page, last_page - first_page + 1);
 }
 
 bool GpuVirtualMemoryManager::isMapped(size_t page_index) const {
@@ -407,75 +616,111 @@ bool GpuVirtualMemoryManager::isEvictedToHost(size_t page_index) const {
   return page_table_[page_index].evicted_to_host;
 }
 
-CUresult GpuVirtualMemoryManager::evictPage(size_t page_index) {
-  std::lock_guard<std::mutex> lock(mutex_);
-
-  if (page_index >= total_pages_) {
-    return CUDA_ERROR_INVALID_VALUE;
-  }
-
-  PageEntry &entry = page_table_[page_index];
-  if (!entry.mapped) {
-    return CUDA_SUCCESS;  // Nothing to evict
-  }
-
-  CUdeviceptr page_addr = va_base_ + page_index * page_size_;
-
-  // Save page contents to pinned host RAM
-  char *host_buf = nullptr;
-  auto it = host_backing_store_.find(page_index);
-  if (it != host_backing_store_.end()) {
-    host_buf = it->second;  // Reuse existing buffer
-  } else {
-    cudaError_t err = cudaMallocHost(&host_buf, page_size_);
-    if (err != cudaSuccess) {
-      fprintf(stderr, "GpuVmm: cudaMallocHost failed for page %zu: %d\n",
-              page_index, err);
+CUresult GpuVirtualMemoryManager::evictRun_(size_t first_page, size_t count,
+                                            bool async) {
+  // Caller must hold mutex_; every page in the run must be mapped.
+  CUdeviceptr run_addr = va_base_ + first_page * page_size_;
+
+  // Compress each page on the device when a codec is set, then copy the
+  // stored bytes into a pinned host buffer sized for them.  Copies are
+  // stream-ordered after the compression that fills the shared scratch, and
+  // the async variant waits once at the end; the wait is required before
+  // cuMemUnmap (driver API, not stream-able).
+  std::vector<char *> host_bufs(count, nullptr);
+  std::vector<size_t> stored(count, page_size_);
+  std::vector<bool> compressed(count, false);
+  bool staged = async || codec_ != nullptr;
+  for (size_t i = 0; i < count; ++i) {
+    void *page_addr = (void *)(run_addr + i * page_size_);
+    const void *src = page_addr;
+    if (codec_) {
+      size_t comp_size = codec_->compress(page_addr);
+      if (comp_size > 0 && comp_size < page_size_) {
+        stored[i] = comp_size;
+        compressed[i] = true;
+        src = codec_->scratch();
+      }
+    }
+    host_bufs[i] = reserveHostPage_(first_page + i, stored[i]);
+    if (host_bufs[i] == nullptr) {
+      fprintf(stderr, "GpuVmm: cudaMallocHost failed for page %zu\n",
+              first_page + i);
+      if (staged) cudaStreamSynchronize(transfer_stream_);
       return CUDA_ERROR_OUT_OF_MEMORY;
     }
+    if (staged) {
+      cudaMemcpyAsync(host_bufs[i], src, stored[i], cudaMemcpyDeviceToHost,
+                      transfer_stream_);
+    } else {
+      cudaMemcpy(host_bufs[i], src, stored[i], cudaMemcpyDeviceToHost);
+    }
+  }
+  if (staged) cudaStreamSynchronize(transfer_stream_);
+
+  for (size_t i = 0; i < count; ++i) {
+    PageEntry &entry = page_table_[first_page + i];
+    entry.stored_bytes = stored[i];
+    entry.compressed = compressed[i];
+    ++(compressed[i] ? compress_stats_.pages_compressed
+                     : compress_stats_.pages_raw);
+    compress_stats_.bytes_in += page_size_;
+    compress_stats_.bytes_out += stored[i];
   }
 
-  cudaMemcpy(host_buf, (void *)page_addr, page_size_, cudaMemcpyDeviceToHost);
-
-  // Store to CTE or keep in host RAM
+  // Store to CTE; otherwise the pinned buffers stay in host_backing_store_
 #ifdef WRP_CTE_AVAILABLE
-  if (use_cte_) {
+  for (size_t i = 0; use_cte_ && i < count; ++i) {
+    size_t page_index = first_page + i;
     // Copy pinned host → SHM → AsyncPutBlob → Wait → free both
     std::string blob_name = "page_" + std::to_string(page_index);
-    hipc::FullPtr<char> shm = CHI_CPU_IPC->AllocateBuffer(page_size_);
-    memcpy(shm.ptr_, host_buf, page_size_);
-    auto future = cte_tag_->AsyncPutBlob(blob_name, shm.shm_, page_size_);
+    hipc::FullPtr<char> shm = CHI_CPU_IPC->AllocateBuffer(stored[i]);
+    memcpy(shm.ptr_, host_bufs[i], stored[i]);
+    auto future = cte_tag_->AsyncPutBlob(blob_name, shm.shm_, stored[i]);
     future.Wait();
     CHI_CPU_IPC->FreeBuffer(shm);
-    cudaFreeHost(host_buf);
-  } else
-#endif
-  {
-    host_backing_store_[page_index] = host_buf;
+    cudaFreeHost(host_bufs[i]);
+    host_backing_store_.erase(page_index);
   }
+#endif
 
-  // Unmap and release GPU physical memory
-  CUresult res = cuMemUnmap(page_addr, page_size_);
+  // One unmap for the whole run; physical pages go back to the pool
+  CUresult res = cuMemUnmap(run_addr, count * page_size_);
   if (res != CUDA_SUCCESS) {
-    fprintf(stderr, "GpuVmm: cuMemUnmap failed for page %zu: %d\n",
-            page_index, res);
+    fprintf(stderr, "GpuVmm: cuMemUnmap failed for pages [%zu, %zu): %d\n",
+            first_page, first_page + count, res);
     return res;
   }
 
-  res = cuMemRelease(entry.alloc_handle);
-  if (res != CUDA_SUCCESS) {
-    fprintf(stderr, "GpuVmm: cuMemRelease failed for page %zu: %d\n",
-            page_index, res);
-    return res;
+  for (size_t i = 0; i < count; ++i) {
+    PageEntry &entry = page_table_[first_page + i];
+    wastePrefetch_(entry);
+    recycleHandle_(entry.alloc_handle);
+    entry.mapped = false;
+    entry.alloc_handle = 0;
+    entry.evicted_to_host = true;
   }
 
-  entry.mapped = false;
-  entry.alloc_handle = 0;
-  entry.evicted_to_host = true;
-
   return CUDA_SUCCESS;
 }
 
+CUresult GpuVirtualMemoryManager::evictPage(size_t page_index) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (page_index >= total_pages_) {
+    return CUDA_ERROR_INVALID_VALUE;
+  }
+
+  if (!page_table_[page_index].mapped) {
+    return CUDA_SUCCESS;  // Nothing to evict
+  }
+
+  if (page_table_[page_index].pinned) {
+    return CUDA_ERROR_NOT_PERMITTED;  // Held resident for graph replay
+  }
+
+  return evictRun_(page_index, 1, false);
+}
+
 CUresult GpuVirtualMemoryManager::evictPageAsync(size_t page_index) {
   std::lock_guard<std::mutex> lock(mutex_);
 
@@ -483,79 +728,296 @@ CUresult GpuVirtualMemoryManager::evictPageAsync(size_t page_index) {
     return CUDA_ERROR_INVALID_VALUE;
   }
 
-  PageEntry &entry = page_table_[page_index];
-  if (!entry.mapped) {
+  if (!page_table_[page_index].mapped) {
     return CUDA_SUCCESS;
   }
 
-  CUdeviceptr page_addr = va_base_ + page_index * page_size_;
+  if (page_table_[page_index].pinned) {
+    return CUDA_ERROR_NOT_PERMITTED;  // Held resident for graph replay
+  }
 
-  // Allocate or reuse pinned host buffer
-  char *host_buf = nullptr;
-  auto it = host_backing_store_.find(page_index);
-  if (it != host_backing_store_.end()) {
-    host_buf = it->second;
-  } else {
-    cudaError_t err = cudaMallocHost(&host_buf, page_size_);
-    if (err != cudaSuccess) {
-      fprintf(stderr, "GpuVmm: cudaMallocHost failed for page %zu: %d\n",
-              page_index, err);
-      return CUDA_ERROR_OUT_OF_MEMORY;
+  return evictRun_(page_index, 1, true);
+}
+
+CUresult GpuVirtualMemoryManager::evictPages(size_t first_page, size_t count) {
+  if (count == 0) return CUDA_SUCCESS;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (first_page >= total_pages_ || count > total_pages_ - first_page) {
+    return CUDA_ERROR_INVALID_VALUE;
+  }
+
+  // One evictRun_ per contiguous run of mapped, unpinned pages
+  auto evictable = [this](size_t i) {
+    return page_table_[i].mapped && !page_table_[i].pinned;
+  };
+  size_t end = first_page + count;
+  size_t page = first_page;
+  while (page < end) {
+    if (!evictable(page)) {
+      ++page;
+      continue;
     }
+    size_t run_end = page + 1;
+    while (run_end < end && evictable(run_end)) ++run_end;
+    CUresult res = evictRun_(page, run_end - page, true);
+    if (res != CUDA_SUCCESS) return res;
+    page = run_end;
   }
+  return CUDA_SUCCESS;
+}
 
-  // Async copy GPU -> host on transfer stream
-  cudaMemcpyAsync(host_buf, (void *)page_addr, page_size_,
-                  cudaMemcpyDeviceToHost, transfer_stream_);
+CUresult GpuVirtualMemoryManager::pinPages(size_t first_page, size_t count) {
+  if (count == 0) return CUDA_SUCCESS;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (first_page >= total_pages_ || count > total_pages_ - first_page) {
+    return CUDA_ERROR_INVALID_VALUE;
+  }
+  CUresult res = touchRun_(first_page, count, false);
+  if (res != CUDA_SUCCESS) return res;
+  for (size_t i = first_page; i < first_page + count; ++i) {
+    page_table_[i].pinned = true;
+  }
+  return CUDA_SUCCESS;
+}
 
-  // Must sync transfer stream before cuMemUnmap (driver API, not stream-able)
-  cudaStreamSynchronize(transfer_stream_);
+CUresult GpuVirtualMemoryManager::unpinPages(size_t first_page, size_t count) {
+  if (count == 0) return CUDA_SUCCESS;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (first_page >= total_pages_ || count > total_pages_ - first_page) {
+    return CUDA_ERROR_INVALID_VALUE;
+  }
+  for (size_t i = first_page; i < first_page + count; ++i) {
+    page_table_[i].pinned = false;
+  }
+  return CUDA_SUCCESS;
+}
 
-  // Store to CTE or keep in host RAM
-#ifdef WRP_CTE_AVAILABLE
-  if (use_cte_) {
-    std::string blob_name = "page_" + std::to_string(page_index);
-    hipc::FullPtr<char> shm = CHI_CPU_IPC->AllocateBuffer(page_size_);
-    memcpy(shm.ptr_, host_buf, page_size_);
-    auto future = cte_tag_->AsyncPutBlob(blob_name, shm.shm_, page_size_);
-    future.Wait();
-    CHI_CPU_IPC->FreeBuffer(shm);
-    cudaFreeHost(host_buf);
-  } else
-#endif
-  {
-    host_backing_store_[page_index] = host_buf;
+bool GpuVirtualMemoryManager::isPinned(size_t page_index) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (page_index >= total_pages_) return false;
+  return page_table_[page_index].pinned;
+}
+
+size_t GpuVirtualMemoryManager::getPooledHandleCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return free_handles_.size();
+}
+
+void GpuVirtualMemoryManager::trimHandlePool(size_t keep) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  while (free_handles_.size() > keep) {
+    cuMemRelease(free_handles_.back());
+    free_handles_.pop_back();
   }
+}
 
-  // Unmap and release
-  CUresult res = cuMemUnmap(page_addr, page_size_);
-  if (res != CUDA_SUCCESS) {
-    fprintf(stderr, "GpuVmm: cuMemUnmap failed for page %zu: %d\n",
-            page_index, res);
-    return res;
+void GpuVirtualMemoryManager::prefetchAhead(size_t page_index) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (page_index >= total_pages_) return;
+  prefetch_(page_index, 1);
+}
+
+GpuVmmPrefetchStats GpuVirtualMemoryManager::getPrefetchStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  GpuVmmPrefetchStats stats = prefetch_stats_;
+  stats.degree = adaptive_prefetch_ ? degree_ : prefetch_window_;
+  stats.distance = adaptive_prefetch_ ? distance_ : 1;
+  stats.stride = stride_hits_ >= kStrideConfirm ? stride_ : 0;
+  return stats;
+}
+
+void GpuVirtualMemoryManager::resetPrefetchStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  prefetch_stats_ = GpuVmmPrefetchStats();
+}
+
+void GpuVirtualMemoryManager::noteDemand_(size_t first_page, size_t count) {
+  // Caller must hold mutex_
+  reapPrefetches_();
+  ++access_seq_;
+  for (size_t i = first_page; i < first_page + count; ++i) {
+    PageEntry &entry = page_table_[i];
+    if (entry.prefetch_batch == 0) continue;
+    ++prefetch_stats_.useful;
+    ++epoch_useful_;
+    if (entry.prefetch_batch > completed_batch_) {
+      ++prefetch_stats_.late;
+      ++epoch_late_;
+    }
+    entry.prefetch_batch = 0;
   }
 
-  res = cuMemRelease(entry.alloc_handle);
-  if (res != CUDA_SUCCESS) {
-    fprintf(stderr, "GpuVmm: cuMemRelease failed for page %zu: %d\n",
-            page_index, res);
-    return res;
+  // Prefetched pages nobody touched within their horizon were wasted
+  while (!outstanding_.empty() &&
+         outstanding_.front().expire_access < access_seq_) {
+    PageEntry &entry = page_table_[outstanding_.front().page_index];
+    if (entry.prefetch_batch == outstanding_.front().batch) {
+      wastePrefetch_(entry);
+    }
+    outstanding_.pop_front();
   }
 
-  entry.mapped = false;
-  entry.alloc_handle = 0;
-  entry.evicted_to_host = true;
+  // Stride detector over the first page of each demand touch
+  if (last_access_ != SIZE_MAX && first_page != last_access_) {
+    int64_t delta = static_cast<int64_t>(first_page) -
+                    static_cast<int64_t>(last_access_);
+    if (delta == stride_) {
+      if (stride_hits_ < kStrideConfirm) ++stride_hits_;
+    } else {
+      stride_ = delta;
+      stride_hits_ = 1;
+    }
+  }
+  last_access_ = first_page;
+  adaptPrefetch_();
+}
 
-  return CUDA_SUCCESS;
+void GpuVirtualMemoryManager::prefetch_(size_t first_page, size_t count) {
+  // Caller must hold mutex_
+  if (prefetch_window_ == 0) return;
+  reapPrefetches_();
+
+  int64_t stride = 1;
+  size_t span = 1;
+  size_t degree = prefetch_window_;
+  size_t distance = 1;
+  size_t budget = SIZE_MAX;
+  if (!adaptive_prefetch_) {
+    // Fixed window past the end of the touch
+    first_page += count - 1;
+  } else {
+    span = count;
+    stride = static_cast<int64_t>(count);
+    if (stride_hits_ >= kStrideConfirm) {
+      stride = stride_;
+    } else if (last_accuracy_ < kLowAccuracy &&
+               ++suppress_run_ % kProbeInterval != 0) {
+      ++prefetch_stats_.suppressed;
+      return;
+    }
+    degree = degree_;
+    distance = distance_;
+    if (inflight_pages_ >= prefetch_max_inflight_) {
+      ++prefetch_stats_.throttled;
+      return;
+    }
+    budget = prefetch_max_inflight_ - inflight_pages_;
+  }
+
+  // Map one predicted range; false once the in-flight budget is spent
+  uint64_t batch = next_batch_;
+  size_t issued = 0;
+  auto issue = [&](size_t target, size_t n) {
+    size_t fresh = 0;
+    for (size_t i = target; i < target + n; ++i) {
+      if (!page_table_[i].mapped) ++fresh;
+    }
+    if (fresh == 0) return true;
+    if (issued + fresh > budget) {
+      ++prefetch_stats_.throttled;
+      return false;
+    }
+    for (size_t i = target; i < target + n; ++i) {
+      if (!page_table_[i].mapped) page_table_[i].prefetch_batch = batch;
+    }
+    CUresult res = touchRun_(target, n, true);
+    for (size_t i = target; i < target + n; ++i) {
+      PageEntry &entry = page_table_[i];
+      if (entry.prefetch_batch != batch) continue;
+      if (!entry.mapped) {
+        entry.prefetch_batch = 0;
+        continue;
+      }
+      ++issued;
+      outstanding_.push_back({i, batch, access_seq_ + 2 * (distance + degree)});
+    }
+    return res == CUDA_SUCCESS;
+  };
+
+  int64_t first = static_cast<int64_t>(first_page) +
+                  static_cast<int64_t>(distance) * stride;
+  if (stride == static_cast<int64_t>(span)) {
+    // Predicted accesses are back to back: one run, one cuMemSetAccess
+    if (first < static_cast<int64_t>(total_pages_)) {
+      size_t target = static_cast<size_t>(first);
+      size_t n = std::min(degree * span, total_pages_ - target);
+      if (n > budget) {
+        ++prefetch_stats_.throttled;
+        n = budget;
+      }
+      issue(target, n);
+    }
+  } else {
+    for (size_t k = 0; k < degree; ++k) {
+      int64_t start = first + static_cast<int64_t>(k) * stride;
+      if (start < 0 || static_cast<size_t>(start) >= total_pages_) break;
+      size_t target = static_cast<size_t>(start);
+      if (!issue(target, std::min(span, total_pages_ - target))) break;
+    }
+  }
+  if (issued == 0) return;
+
+  // One event per batch tells demand touches whether the copies landed
+  cudaEvent_t done = nullptr;
+  if (!free_events_.empty()) {
+    done = free_events_.back();
+    free_events_.pop_back();
+  } else if (cudaEventCreateWithFlags(&done, cudaEventDisableTiming) !=
+             cudaSuccess) {
+    done = nullptr;
+  }
+  if (done != nullptr) {
+    cudaEventRecord(done, transfer_stream_);
+    inflight_batches_.push_back({done, batch, issued});
+    inflight_pages_ += issued;
+  } else {
+    completed_batch_ = batch;  // Untracked: treat as landed
+  }
+  ++next_batch_;
+  prefetch_stats_.issued += issued;
 }
 
-void GpuVirtualMemoryManager::prefetchAhead(size_t page_index) {
-  for (size_t i = 1; i <= prefetch_window_; ++i) {
-    size_t target = page_index + i;
-    if (target >= total_pages_) break;
-    if (isMapped(target)) continue;
-    touchPageAsync(target);
+void GpuVirtualMemoryManager::reapPrefetches_() {
+  // Caller must hold mutex_; the transfer stream retires batches in order
+  while (!inflight_batches_.empty()) {
+    PrefetchBatch &front = inflight_batches_.front();
+    if (cudaEventQuery(front.done) == cudaErrorNotReady) break;
+    completed_batch_ = front.id;
+    inflight_pages_ -= front.pages;
+    free_events_.push_back(front.done);
+    inflight_batches_.pop_front();
+  }
+}
+
+void GpuVirtualMemoryManager::wastePrefetch_(PageEntry &entry) {
+  // Caller must hold mutex_
+  if (entry.prefetch_batch == 0) return;
+  ++prefetch_stats_.wasted;
+  ++epoch_wasted_;
+  entry.prefetch_batch = 0;
+}
+
+void GpuVirtualMemoryManager::adaptPrefetch_() {
+  // Caller must hold mutex_
+  if (!adaptive_prefetch_) return;
+  uint64_t resolved = epoch_useful_ + epoch_wasted_;
+  if (resolved < kPrefetchEpoch) return;
+
+  last_accuracy_ = static_cast<double>(epoch_useful_) / resolved;
+  if (last_accuracy_ >= kHighAccuracy) {
+    degree_ = std::min(std::max<size_t>(degree_ * 2, 1), prefetch_max_degree_);
+  } else if (last_accuracy_ < kLowAccuracy) {
+    degree_ = std::max<size_t>(degree_ / 2, 1);
   }
+  // Touches catching copies in flight need the prefetch issued earlier
+  if (epoch_late_ * 4 > epoch_useful_) {
+    distance_ = std::min(distance_ + 1, prefetch_max_degree_);
+  } else if (epoch_late_ == 0 && distance_ > 1) {
+    --distance_;
+  }
+  epoch_useful_ = 0;
+  epoch_wasted_ = 0;
+  epoch_late_ = 0;
 }
 
 CUdeviceptr GpuVirtualMemoryManager::getPagePtr(size_t page_index) const {
@@ -573,9 +1035,39 @@ void GpuVirtualMemoryManager::syncCompute() {
 
 void GpuVirtualMemoryManager::freeHostBackingStore_() {
   for (auto &pair : host_backing_store_) {
-    cudaFreeHost(pair.second);
+    cudaFreeHost(pair.second.data);
   }
   host_backing_store_.clear();
 }
 
+char *GpuVirtualMemoryManager::reserveHostPage_(size_t page_index,
+                                                size_t bytes) {
+  // Caller must hold mutex_
+  auto it = host_backing_store_.find(page_index);
+  if (it != host_backing_store_.end()) {
+    HostPage &host = it->second;
+    if (host.capacity >= bytes && host.capacity / 2 <= bytes) {
+      return host.data;
+    }
+    cudaFreeHost(host.data);
+    host_backing_store_.erase(it);
+  }
+  char *data = nullptr;
+  if (cudaMallocHost(&data, bytes) != cudaSuccess) return nullptr;
+  host_backing_store_[page_index] = HostPage{data, bytes};
+  return data;
+}
+
+GpuVmmCompressStats GpuVirtualMemoryManager::getCompressStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return compress_stats_;
+}
+
+size_t GpuVirtualMemoryManager::getHostBackingBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t bytes = 0;
+  for (const auto &pair : host_backing_store_) bytes += pair.second.capacity;
+  return bytes;
+}
+
 }  // namespace wrp_cte::uvm
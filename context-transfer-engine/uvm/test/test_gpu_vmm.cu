@@ -33,9 +33,6 @@
 
 #include "wrp_cte/uvm/gpu_vmm.h"
 
-#include <cuda.h>
-#include <cuda_runtime.h>
-
 #include <cassert>
 #include <cstdio>
 #include <cstring>
@@ -439,6 +436,55 @@ static void testEvictAndRestore() {
   printf("  Cleanup: PASSED\n\n");
 }
 
+static void testCompressedEviction() {
+  printf("=== Test: Compressed Eviction Store ===\n");
+
+  GpuVirtualMemoryManager vmm;
+  GpuVmmConfig cfg;
+  cfg.va_size_bytes = 64ULL * 1024 * 1024;
+  cfg.fill_value = 0;
+  cfg.prefetch_window = 0;
+  cfg.page_codec = "cascaded";
+
+  CUresult res = vmm.init(cfg);
+  assert(res == CUDA_SUCCESS);
+
+  // Uniform pages are the best case for a run-length/delta codec
+  const size_t kPages = 4;
+  for (size_t i = 0; i < kPages; ++i) {
+    res = vmm.touchPage(i);
+    assert(res == CUDA_SUCCESS);
+    fillPageWith(vmm.getPagePtr(i), vmm.getPageSize(), 100 + (int)i);
+  }
+  for (size_t i = 0; i < kPages; ++i) {
+    res = vmm.evictPage(i);
+    assert(res == CUDA_SUCCESS);
+  }
+
+  GpuVmmCompressStats stats = vmm.getCompressStats();
+  assert(stats.pages_compressed + stats.pages_raw == kPages);
+  assert(stats.bytes_in == kPages * vmm.getPageSize());
+  if (stats.pages_compressed > 0) {
+    assert(vmm.getHostBackingBytes() < kPages * vmm.getPageSize());
+    printf("  Host store: %zu bytes for %zu pages (ratio %.1fx): PASSED\n",
+           vmm.getHostBackingBytes(), kPages, stats.ratio());
+  } else {
+    printf("  nvCOMP unavailable, pages stored raw: SKIPPED\n");
+  }
+
+  // Refault: pages are expanded on the device and keep their contents
+  for (size_t i = 0; i < kPages; ++i) {
+    res = vmm.touchPage(i);
+    assert(res == CUDA_SUCCESS);
+    bool ok = verifyPage(vmm.getPagePtr(i), vmm.getPageSize(), 100 + (int)i);
+    assert(ok);
+  }
+  printf("  Compressed pages restored intact: PASSED\n");
+
+  vmm.destroy();
+  printf("  Cleanup: PASSED\n\n");
+}
+
 static void testPrefetch() {
   printf("=== Test: Prefetch Window ===\n");
 
@@ -479,6 +525,52 @@ static void testPrefetch() {
   printf("  Cleanup: PASSED\n\n");
 }
 
+static void testAdaptiveStridePrefetch() {
+  printf("=== Test: Adaptive Stride Prefetch ===\n");
+
+  GpuVirtualMemoryManager vmm;
+  GpuVmmConfig cfg;
+  cfg.va_size_bytes = 256ULL * 1024 * 1024;
+  cfg.fill_value = 5;
+  cfg.prefetch_window = 2;
+
+  CUresult res = vmm.init(cfg);
+  assert(res == CUDA_SUCCESS);
+
+  // Touches 0, 8, 16: the second repeat of delta 8 confirms the stride
+  for (size_t page = 0; page <= 16; page += 8) {
+    res = vmm.touchPage(page);
+    assert(res == CUDA_SUCCESS);
+  }
+  vmm.syncTransfer();
+  GpuVmmPrefetchStats stats = vmm.getPrefetchStats();
+  assert(stats.stride == 8);
+  assert(vmm.isMapped(24) && vmm.isMapped(32));
+  assert(!vmm.isMapped(17) && !vmm.isMapped(18));
+  printf("  Stride 8 detected, pages 24 and 32 prefetched: PASSED\n");
+
+  // Keep striding: the sequential guesses (1, 2, 9, 10) age out as wasted
+  for (size_t page = 24; page <= 72; page += 8) {
+    res = vmm.touchPage(page);
+    assert(res == CUDA_SUCCESS);
+  }
+  vmm.syncTransfer();
+  stats = vmm.getPrefetchStats();
+  assert(stats.useful >= 6);
+  assert(stats.wasted == 4);
+  assert(stats.accuracy() > 0.5 && stats.accuracy() < 1.0);
+  printf("  useful=%llu wasted=%llu late=%llu accuracy=%.2f: PASSED\n",
+         (unsigned long long)stats.useful, (unsigned long long)stats.wasted,
+         (unsigned long long)stats.late, stats.accuracy());
+
+  vmm.resetPrefetchStats();
+  assert(vmm.getPrefetchStats().issued == 0);
+  printf("  resetPrefetchStats: PASSED\n");
+
+  vmm.destroy();
+  printf("  Cleanup: PASSED\n\n");
+}
+
 static void testAsyncOverlap() {
   printf("=== Test: Async Overlap (Evict + Compute) ===\n");
 
@@ -590,6 +682,125 @@ static void testMultipleEvictRestore() {
   printf("  Cleanup: PASSED\n\n");
 }
 
+static void testBatchedRangeAndHandlePool() {
+  printf("=== Test: Batched Range Map/Evict + Handle Pool ===\n");
+
+  GpuVirtualMemoryManager vmm;
+  GpuVmmConfig cfg;
+  cfg.va_size_bytes = 64ULL * 1024 * 1024;
+  cfg.fill_value = 5;
+  cfg.prefetch_window = 0;
+  cfg.handle_pool_pages = 4;
+
+  CUresult res = vmm.init(cfg);
+  assert(res == CUDA_SUCCESS);
+
+  // Map pages 2-7 as one run and write distinct values
+  res = vmm.touchPages(2, 6);
+  assert(res == CUDA_SUCCESS);
+  assert(vmm.getMappedPageCount() == 6);
+  for (size_t i = 2; i < 8; ++i) {
+    assert(verifyPage(vmm.getPagePtr(i), vmm.getPageSize(), 5));
+    fillPageWith(vmm.getPagePtr(i), vmm.getPageSize(), 200 + (int)i);
+  }
+  printf("  touchPages mapped a 6-page run: PASSED\n");
+
+  // Punch a hole, then evict a range spanning two mapped runs
+  res = vmm.evictPage(4);
+  assert(res == CUDA_SUCCESS);
+  res = vmm.evictPages(0, 10);
+  assert(res == CUDA_SUCCESS);
+  assert(vmm.getMappedPageCount() == 0);
+  assert(vmm.getEvictedPageCount() == 6);
+  assert(vmm.getPooledHandleCount() == 4);  // capped by handle_pool_pages
+  printf("  evictPages evicted both runs, 4 handles pooled: PASSED\n");
+
+  // Restore asynchronously from pooled handles and check the data came back
+  res = vmm.touchPagesAsync(2, 6);
+  assert(res == CUDA_SUCCESS);
+  vmm.syncTransfer();
+  assert(vmm.getPooledHandleCount() == 0);
+  for (size_t i = 2; i < 8; ++i) {
+    assert(verifyPage(vmm.getPagePtr(i), vmm.getPageSize(), 200 + (int)i));
+  }
+  printf("  touchPagesAsync restored values 202-207: PASSED\n");
+
+  vmm.evictPages(2, 6);
+  vmm.trimHandlePool();
+  assert(vmm.getPooledHandleCount() == 0);
+  printf("  trimHandlePool released pooled pages: PASSED\n");
+
+  vmm.destroy();
+  printf("  Cleanup: PASSED\n\n");
+}
+
+static void testPinnedGraphReplay() {
+  printf("=== Test: Pinned Pages + CUDA Graph Replay ===\n");
+
+  GpuVirtualMemoryManager vmm;
+  GpuVmmConfig cfg;
+  cfg.va_size_bytes = 64ULL * 1024 * 1024;
+  cfg.fill_value = 5;
+  cfg.prefetch_window = 0;
+
+  CUresult res = vmm.init(cfg);
+  assert(res == CUDA_SUCCESS);
+  size_t page_ints = vmm.getPageSize() / sizeof(int);
+
+  // Pin pages 0-3 resident before capture; pages 4-5 stay evictable
+  res = vmm.pinPages(0, 4);
+  assert(res == CUDA_SUCCESS);
+  res = vmm.touchPages(4, 2);
+  assert(res == CUDA_SUCCESS);
+  assert(vmm.isPinned(0) && vmm.isPinned(3) && !vmm.isPinned(4));
+  printf("  pinPages mapped and pinned 4 pages: PASSED\n");
+
+  // Capture one write per pinned page into a graph
+  cudaStream_t stream = vmm.getComputeStream();
+  cudaGraph_t graph;
+  cudaGraphExec_t exec;
+  int threads = 256;
+  int blocks = (int)((page_ints + threads - 1) / threads);
+  cudaStreamBeginCapture(stream, cudaStreamCaptureModeThreadLocal);
+  for (size_t i = 0; i < 4; ++i) {
+    writeKernel<<<blocks, threads, 0, stream>>>(
+        (int *)vmm.getPagePtr(i), 300 + (int)i, page_ints);
+  }
+  cudaStreamEndCapture(stream, &graph);
+  cudaError_t err = cudaGraphInstantiate(&exec, graph, 0);
+  assert(err == cudaSuccess);
+
+  // Eviction must leave the pinned pages mapped between replays
+  for (int rep = 0; rep < 3; ++rep) {
+    res = vmm.evictPages(0, 8);
+    assert(res == CUDA_SUCCESS);
+    assert(vmm.getMappedPageCount() == 4);
+    res = vmm.evictPage(2);
+    assert(res == CUDA_ERROR_NOT_PERMITTED);
+    err = cudaGraphLaunch(exec, stream);
+    assert(err == cudaSuccess);
+    vmm.syncCompute();
+    for (size_t i = 0; i < 4; ++i) {
+      assert(verifyPage(vmm.getPagePtr(i), vmm.getPageSize(), 300 + (int)i));
+    }
+  }
+  printf("  3 graph replays across evictPages: PASSED\n");
+
+  cudaGraphExecDestroy(exec);
+  cudaGraphDestroy(graph);
+
+  // Unpinned pages become evictable again
+  res = vmm.unpinPages(0, 4);
+  assert(res == CUDA_SUCCESS);
+  res = vmm.evictPages(0, 4);
+  assert(res == CUDA_SUCCESS);
+  assert(vmm.getMappedPageCount() == 0);
+  printf("  unpinPages re-enabled eviction: PASSED\n");
+
+  vmm.destroy();
+  printf("  Cleanup: PASSED\n\n");
+}
+
 int main() {
   printf("GPU Virtual Memory Manager -- Demand Paging Tests\n");
   printf("==================================================\n\n");
@@ -603,9 +814,13 @@ int main() {
   testLargeVaReservation();
   testKernelAccessFullVaSpace();
   testEvictAndRestore();
+  testCompressedEviction();
   testPrefetch();
+  testAdaptiveStridePrefetch();
   testAsyncOverlap();
   testMultipleEvictRestore();
+  testBatchedRangeAndHandlePool();
+  testPinnedGraphReplay();
 
   printf("All tests PASSED.\n");
   return 0;
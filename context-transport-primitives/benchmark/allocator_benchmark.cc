@@ -41,7 +41,7 @@
  * - malloc (malloc): Standard C library malloc
  *
  * Usage:
- *   allocator_benchmark <allocator_type> <num_threads> <min_size> <max_size> [duration_sec]
+ *   allocator_benchmark <allocator_type> <num_threads> <min_size> <max_size> [duration_sec] [pattern]
  *
  * Parameters:
  *   allocator_type: "mp", "buddy", or "malloc"
@@ -49,6 +49,9 @@
  *   min_size: Minimum allocation size (supports K, M, G suffixes, e.g., "1K", "4K")
  *   max_size: Maximum allocation size (supports K, M, G suffixes, e.g., "1M", "16M")
  *   duration_sec: Duration to run benchmark in seconds (default: 10)
+ *   pattern: "random" (each thread allocates and frees its own blocks) or
+ *            "pc" (producer/consumer pairs: one thread allocates, the other
+ *            frees, like a client handing buffers to a runtime worker)
  *
  * Example:
  *   allocator_benchmark mp 8 4K 1M 30
@@ -118,7 +121,7 @@ struct SizeRange {
  */
 void PrintUsage(const char* program_name) {
   std::cerr << "Usage: " << program_name
-            << " <allocator_type> <num_threads> <min_size> <max_size> [duration_sec]\n\n"
+            << " <allocator_type> <num_threads> <min_size> <max_size> [duration_sec] [pattern]\n\n"
             << "Parameters:\n"
             << "  allocator_type: Allocator to benchmark\n"
             << "                  - mp: MultiProcessAllocator\n"
@@ -127,11 +130,14 @@ void PrintUsage(const char* program_name) {
             << "  num_threads:    Number of concurrent threads (1-64)\n"
             << "  min_size:       Minimum allocation size (supports K, M, G suffixes)\n"
             << "  max_size:       Maximum allocation size (supports K, M, G suffixes)\n"
-            << "  duration_sec:   Duration to run benchmark in seconds (default: 10)\n\n"
+            << "  duration_sec:   Duration to run benchmark in seconds (default: 10)\n"
+            << "  pattern:        random (default) or pc (thread A allocates,\n"
+            << "                  thread B frees; mp and malloc only)\n\n"
             << "Examples:\n"
             << "  " << program_name << " mp 8 4K 1M 30\n"
             << "  " << program_name << " buddy 4 1K 64K\n"
-            << "  " << program_name << " malloc 16 128 16K 60\n";
+            << "  " << program_name << " malloc 16 128 16K 60\n"
+            << "  " << program_name << " mp 8 1K 64K 10 pc\n";
   exit(1);
 }
 
@@ -154,6 +160,93 @@ class OperationCounter {
   uint64_t GetTotalOps() const { return GetAllocCount() + GetFreeCount(); }
 };
 
+/**
+ * Bounded single-producer/single-consumer ring used to hand allocations
+ * from a producer thread to the consumer thread that frees them
+ */
+template<typename T>
+class HandoffRing {
+ private:
+  std::vector<T> slots_;
+  std::atomic<size_t> head_;  // Next slot to pop (consumer)
+  std::atomic<size_t> tail_;  // Next slot to push (producer)
+
+ public:
+  explicit HandoffRing(size_t depth) : slots_(depth), head_(0), tail_(0) {}
+
+  bool Push(const T& val) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == slots_.size()) {
+      return false;
+    }
+    slots_[tail % slots_.size()] = val;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool Pop(T& val) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    val = slots_[head % slots_.size()];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+};
+
+/**
+ * Producer/consumer benchmark pair
+ *
+ * The producer allocates and writes blocks, the consumer frees them, so
+ * every free is a cross-thread free. AllocFn is (size_t, PtrT&) -> bool and
+ * writes the block; FreeFn is PtrT -> void.
+ */
+template<typename PtrT, typename AllocFn, typename FreeFn>
+void RunProducerConsumerPair(AllocFn alloc_fn, FreeFn free_fn,
+                             size_t min_size, size_t max_size,
+                             int duration_sec, OperationCounter* counter) {
+  HandoffRing<PtrT> ring(1024);
+  std::atomic<bool> done(false);
+
+  std::thread consumer([&]() {
+    PtrT ptr;
+    while (true) {
+      if (ring.Pop(ptr)) {
+        free_fn(ptr);
+        counter->RecordFree();
+      } else if (done.load(std::memory_order_acquire)) {
+        if (!ring.Pop(ptr)) {
+          break;
+        }
+        free_fn(ptr);
+        counter->RecordFree();
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  std::mt19937 rng(std::random_device{}());
+  std::uniform_int_distribution<size_t> size_dist(min_size, max_size);
+  auto end_time = std::chrono::steady_clock::now() +
+                  std::chrono::seconds(duration_sec);
+  while (std::chrono::steady_clock::now() < end_time) {
+    size_t alloc_size = size_dist(rng);
+    PtrT ptr;
+    if (!alloc_fn(alloc_size, ptr)) {
+      std::this_thread::yield();
+      continue;
+    }
+    counter->RecordAlloc();
+    while (!ring.Push(ptr)) {
+      std::this_thread::yield();
+    }
+  }
+  done.store(true, std::memory_order_release);
+  consumer.join();
+}
+
 /**
  * Benchmark worker for MultiProcessAllocator or BuddyAllocator
  *
@@ -303,6 +396,20 @@ class MallocBenchmarkWorker {
   }
 };
 
+/**
+ * Number of producer/consumer pairs for a thread count (at least one)
+ */
+int NumPairs(int num_threads) {
+  return num_threads < 2 ? 1 : num_threads / 2;
+}
+
+/**
+ * Printable name of the workload pattern
+ */
+const char* PatternName(bool producer_consumer) {
+  return producer_consumer ? "producer/consumer" : "random";
+}
+
 /**
  * Format a number with thousands separators
  */
@@ -348,10 +455,12 @@ std::string FormatSize(size_t size) {
  * @param num_threads Number of threads to use
  * @param size_range Size range configuration (min_size, max_size)
  * @param duration_sec Duration to run benchmark in seconds
+ * @param producer_consumer Pair threads so one allocates and the other frees
  */
 void BenchmarkMultiProcessAllocator(int num_threads,
                                    const SizeRange& size_range,
-                                   int duration_sec) {
+                                   int duration_sec,
+                                   bool producer_consumer) {
   size_t min_size = size_range.min_size;
   size_t max_size = size_range.max_size;
   // Initialize backend with sufficient memory
@@ -381,12 +490,30 @@ void BenchmarkMultiProcessAllocator(int num_threads,
 
   auto start_time = std::chrono::steady_clock::now();
 
-  for (int i = 0; i < num_threads; ++i) {
-    threads.emplace_back([alloc, min_size, max_size, duration_sec, &counter]() {
-      AllocatorBenchmarkWorker<hipc::MultiProcessAllocator> worker(
-          alloc, min_size, max_size, duration_sec, &counter);
-      worker.Run();
-    });
+  if (producer_consumer) {
+    auto alloc_fn = [alloc](size_t size, hipc::FullPtr<char>& ptr) {
+      ptr = alloc->template Allocate<char>(size);
+      if (ptr.IsNull()) {
+        return false;
+      }
+      std::memset(ptr.ptr_, 0xAB, size);
+      return true;
+    };
+    auto free_fn = [alloc](hipc::FullPtr<char> ptr) { alloc->Free(ptr); };
+    for (int i = 0; i < NumPairs(num_threads); ++i) {
+      threads.emplace_back([=, &counter]() {
+        RunProducerConsumerPair<hipc::FullPtr<char>>(
+            alloc_fn, free_fn, min_size, max_size, duration_sec, &counter);
+      });
+    }
+  } else {
+    for (int i = 0; i < num_threads; ++i) {
+      threads.emplace_back([alloc, min_size, max_size, duration_sec, &counter]() {
+        AllocatorBenchmarkWorker<hipc::MultiProcessAllocator> worker(
+            alloc, min_size, max_size, duration_sec, &counter);
+        worker.Run();
+      });
+    }
   }
 
   // Wait for all threads to complete
@@ -405,6 +532,7 @@ void BenchmarkMultiProcessAllocator(int num_threads,
 
   std::cout << "\n=== MultiProcessAllocator Benchmark Results ===\n";
   std::cout << "Threads:          " << num_threads << "\n";
+  std::cout << "Pattern:          " << PatternName(producer_consumer) << "\n";
   std::cout << "Size Range:       " << FormatSize(min_size) << " - " << FormatSize(max_size) << "\n";
   std::cout << "Duration:         " << duration_sec << " seconds (actual: "
             << elapsed_ms << " ms)\n";
@@ -493,9 +621,10 @@ void BenchmarkBuddyAllocator(int num_threads, const SizeRange& size_range,
  * @param num_threads Number of threads to use
  * @param size_range Size range configuration (min_size, max_size)
  * @param duration_sec Duration to run benchmark in seconds
+ * @param producer_consumer Pair threads so one allocates and the other frees
  */
 void BenchmarkMalloc(int num_threads, const SizeRange& size_range,
-                    int duration_sec) {
+                    int duration_sec, bool producer_consumer) {
   size_t min_size = size_range.min_size;
   size_t max_size = size_range.max_size;
   // Create operation counter
@@ -507,11 +636,29 @@ void BenchmarkMalloc(int num_threads, const SizeRange& size_range,
 
   auto start_time = std::chrono::steady_clock::now();
 
-  for (int i = 0; i < num_threads; ++i) {
-    threads.emplace_back([min_size, max_size, duration_sec, &counter]() {
-      MallocBenchmarkWorker worker(min_size, max_size, duration_sec, &counter);
-      worker.Run();
-    });
+  if (producer_consumer) {
+    auto alloc_fn = [](size_t size, void*& ptr) {
+      ptr = malloc(size);
+      if (ptr == nullptr) {
+        return false;
+      }
+      std::memset(ptr, 0xAB, size);
+      return true;
+    };
+    auto free_fn = [](void* ptr) { free(ptr); };
+    for (int i = 0; i < NumPairs(num_threads); ++i) {
+      threads.emplace_back([=, &counter]() {
+        RunProducerConsumerPair<void*>(alloc_fn, free_fn, min_size, max_size,
+                                       duration_sec, &counter);
+      });
+    }
+  } else {
+    for (int i = 0; i < num_threads; ++i) {
+      threads.emplace_back([min_size, max_size, duration_sec, &counter]() {
+        MallocBenchmarkWorker worker(min_size, max_size, duration_sec, &counter);
+        worker.Run();
+      });
+    }
   }
 
   // Wait for all threads to complete
@@ -530,6 +677,7 @@ void BenchmarkMalloc(int num_threads, const SizeRange& size_range,
 
   std::cout << "\n=== Standard malloc Benchmark Results ===\n";
   std::cout << "Threads:          " << num_threads << "\n";
+  std::cout << "Pattern:          " << PatternName(producer_consumer) << "\n";
   std::cout << "Size Range:       " << FormatSize(min_size) << " - " << FormatSize(max_size) << "\n";
   std::cout << "Duration:         " << duration_sec << " seconds (actual: "
             << elapsed_ms << " ms)\n";
@@ -545,7 +693,7 @@ void BenchmarkMalloc(int num_threads, const SizeRange& size_range,
 
 int main(int argc, char** argv) {
   // Parse command-line arguments
-  if (argc < 5 || argc > 6) {
+  if (argc < 5 || argc > 7) {
     bench::PrintUsage(argv[0]);
   }
 
@@ -553,7 +701,8 @@ int main(int argc, char** argv) {
   int num_threads = std::atoi(argv[2]);
   size_t min_size = hshm::ConfigParse::ParseSize(argv[3]);
   size_t max_size = hshm::ConfigParse::ParseSize(argv[4]);
-  int duration_sec = (argc == 6) ? std::atoi(argv[5]) : 10;
+  int duration_sec = (argc >= 6) ? std::atoi(argv[5]) : 10;
+  std::string pattern = (argc == 7) ? argv[6] : "random";
 
   // Validate parameters
   if (num_threads < 1 || num_threads > 64) {
@@ -571,17 +720,30 @@ int main(int argc, char** argv) {
     bench::PrintUsage(argv[0]);
   }
 
+  if (pattern != "random" && pattern != "pc") {
+    std::cerr << "Error: pattern must be 'random' or 'pc'\n";
+    bench::PrintUsage(argv[0]);
+  }
+  bool producer_consumer = pattern == "pc";
+  if (producer_consumer && alloc_type == "buddy") {
+    std::cerr << "Error: pc pattern requires a thread-safe allocator "
+              << "(mp or malloc)\n";
+    bench::PrintUsage(argv[0]);
+  }
+
   // Create size range configuration
   bench::SizeRange size_range(min_size, max_size);
 
   // Run the appropriate benchmark
   try {
     if (alloc_type == "mp") {
-      bench::BenchmarkMultiProcessAllocator(num_threads, size_range, duration_sec);
+      bench::BenchmarkMultiProcessAllocator(num_threads, size_range, duration_sec,
+                                            producer_consumer);
     } else if (alloc_type == "buddy") {
       bench::BenchmarkBuddyAllocator(num_threads, size_range, duration_sec);
     } else if (alloc_type == "malloc") {
-      bench::BenchmarkMalloc(num_threads, size_range, duration_sec);
+      bench::BenchmarkMalloc(num_threads, size_range, duration_sec,
+                             producer_consumer);
     } else {
       std::cerr << "Error: Unknown allocator type '" << alloc_type << "'\n";
       std::cerr << "Valid types: mp, buddy, malloc\n";
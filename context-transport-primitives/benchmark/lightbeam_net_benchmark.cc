@@ -0,0 +1,610 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * Lightbeam Transport Network Benchmark
+ *
+ * Measures request/ack round trips over the lightbeam Transport interface
+ * for every compiled-in TransportType. A sweep covers message sizes, the
+ * number of bulks each message is split into, and the number of concurrent
+ * client connections. For each step it reports latency percentiles,
+ * payload bandwidth, and CPU time per payload byte on the client and the
+ * server. The server puts its process CPU time in every ack, so per-byte
+ * server cost is known without a separate channel.
+ *
+ * Usage:
+ *   lightbeam_net_benchmark server <transport> <bind_addr> <port>
+ *                           [--protocol P] [--domain D]
+ *   lightbeam_net_benchmark client <transport> <server_addr> <port>
+ *                           [options]
+ *   lightbeam_net_benchmark local <transport> [options]
+ *
+ * Transports: zeromq, socket, libfabric, io_uring (server/client/local);
+ * shm and nixl are single-process and only run in local mode. server/client
+ * is the cross-node setup: start the server on one node and the client on
+ * another. local runs both ends in one process over loopback; there the
+ * client CPU column covers both ends and the server column is omitted.
+ *
+ * Client/local options:
+ *   --sizes 64,4k,64k,1m     Payload bytes per message (k/m suffixes)
+ *   --bulks 1,4              Bulks each payload is split into
+ *   --concurrency 1,4,16     Concurrent client connections (threads)
+ *   --iters N                Timed round trips per connection (default 1000)
+ *   --protocol P             Transport protocol (e.g. tcp, ipc, verbs)
+ *   --domain D               Libfabric domain
+ *   --keep-server            Do not stop the server when done
+ *
+ * Examples:
+ *   node1$ lightbeam_net_benchmark server socket 0.0.0.0 9500
+ *   node2$ lightbeam_net_benchmark client socket node1 9500 --sizes 4k,1m
+ *   lightbeam_net_benchmark local shm --sizes 4k,64k,1m
+ */
+
+#include <hermes_shm/lightbeam/transport_factory_impl.h>
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace hshm::lbm;
+
+static const int kWarmupIterations = 50;
+
+/** Request or ack exchanged by the benchmark */
+class BenchMeta : public LbmMeta<> {
+ public:
+  static constexpr uint32_t kData = 0;  /**< Payload in the bulks */
+  static constexpr uint32_t kStop = 1;  /**< Shut the server down */
+
+  uint32_t op_ = kData;
+  uint64_t seq_ = 0;
+  uint64_t server_cpu_ns_ = 0;  /**< Server process CPU time, in acks */
+
+  template <typename Ar>
+  void serialize(Ar& ar) {
+    LbmMeta<>::serialize(ar);
+    ar(op_, seq_, server_cpu_ns_);
+  }
+};
+
+/** User + system CPU time of this process in nanoseconds */
+static uint64_t ProcessCpuNs() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  auto ns = [](const struct timeval& tv) {
+    return static_cast<uint64_t>(tv.tv_sec) * 1000000000ull +
+           static_cast<uint64_t>(tv.tv_usec) * 1000ull;
+  };
+  return ns(usage.ru_utime) + ns(usage.ru_stime);
+}
+
+/** Parse a size with an optional k/K, m/M or g/G suffix */
+static size_t ParseSize(const std::string& str) {
+  char* end = nullptr;
+  double value = std::strtod(str.c_str(), &end);
+  size_t mult = 1;
+  if (end && (*end == 'k' || *end == 'K')) mult = 1024;
+  if (end && (*end == 'm' || *end == 'M')) mult = 1024 * 1024;
+  if (end && (*end == 'g' || *end == 'G')) mult = 1024ull * 1024 * 1024;
+  return static_cast<size_t>(value * mult);
+}
+
+/** Parse a comma-separated list of sizes */
+static std::vector<size_t> ParseList(const std::string& str) {
+  std::vector<size_t> out;
+  std::stringstream ss(str);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    size_t v = ParseSize(item);
+    if (v > 0) out.push_back(v);
+  }
+  return out;
+}
+
+/** Map a transport name to its type; false for unknown names */
+static bool ParseTransport(const std::string& name, TransportType& type) {
+  if (name == "zeromq") type = TransportType::kZeroMq;
+  else if (name == "socket") type = TransportType::kSocket;
+  else if (name == "shm") type = TransportType::kShm;
+  else if (name == "nixl") type = TransportType::kNixl;
+  else if (name == "libfabric") type = TransportType::kLibfabric;
+  else if (name == "io_uring") type = TransportType::kIoUring;
+  else return false;
+  return true;
+}
+
+/** Receive with a busy-poll retry (sleeping would dominate latency) */
+template <typename MetaT>
+static ClientInfo RecvSpin(Transport* transport, MetaT& meta,
+                           const LbmContext& ctx,
+                           const std::atomic<bool>* stop = nullptr) {
+  while (true) {
+    ClientInfo info = transport->Recv(meta, ctx);
+    if (info.rc != EAGAIN) return info;
+    if (stop && stop->load(std::memory_order_relaxed)) return info;
+    std::this_thread::yield();
+  }
+}
+
+/** Channel contexts of one end; only shm needs non-default ones */
+struct Channel {
+  LbmContext send_ctx_;
+  LbmContext recv_ctx_;
+};
+
+/** Copy space and transfer state for one shm direction */
+struct ShmLink {
+  static constexpr size_t kCopySpaceSize = 1 << 20;
+  std::vector<char> copy_space_ = std::vector<char>(kCopySpaceSize);
+  ShmTransferInfo info_;
+
+  ShmLink() { info_.copy_space_size_.store(kCopySpaceSize); }
+
+  LbmContext Ctx() {
+    LbmContext ctx;
+    ctx.copy_space = copy_space_.data();
+    ctx.shm_info_ = &info_;
+    return ctx;
+  }
+};
+
+/**
+ * Ack every request until a kStop arrives (or stop is set)
+ * @param server Server transport
+ * @param chan Contexts for receiving requests and sending acks
+ * @param stop Optional external stop flag
+ */
+static void ServeLoop(Transport* server, const Channel& chan,
+                      const std::atomic<bool>* stop = nullptr) {
+  while (true) {
+    BenchMeta req;
+    ClientInfo info = RecvSpin(server, req, chan.recv_ctx_, stop);
+    if (info.rc == EAGAIN) return;  // stop flag set
+    if (info.rc != 0) {
+      std::cerr << "Server recv failed: rc=" << info.rc << "\n";
+      return;
+    }
+    server->ClearRecvHandles(req);
+    BenchMeta ack;
+    ack.op_ = req.op_;
+    ack.seq_ = req.seq_;
+    ack.server_cpu_ns_ = ProcessCpuNs();
+    ack.client_info_ = info;
+    int rc = server->Send(ack, chan.send_ctx_);
+    if (rc != 0) {
+      std::cerr << "Server ack send failed: rc=" << rc << "\n";
+    }
+    if (req.op_ == BenchMeta::kStop) return;
+  }
+}
+
+/** Results of one connection in one sweep step */
+struct ConnResult {
+  std::vector<double> lat_us_;
+  uint64_t first_server_cpu_ns_ = 0;
+  uint64_t last_server_cpu_ns_ = 0;
+  int errors_ = 0;
+};
+
+/**
+ * Run warmup then timed round trips on one connection
+ * @param client Client transport
+ * @param chan Contexts for requests and acks
+ * @param buf Payload buffer of at least size bytes
+ * @param size Payload bytes per message
+ * @param bulks Bulks the payload is split into
+ * @param iters Timed round trips
+ * @param result Output latencies and server CPU stamps
+ */
+static void ClientLoop(Transport* client, const Channel& chan, char* buf,
+                       size_t size, size_t bulks, int iters,
+                       ConnResult& result) {
+  size_t chunk = size / bulks;
+  result.lat_us_.reserve(iters);
+  for (int i = 0; i < kWarmupIterations + iters; ++i) {
+    BenchMeta req;
+    req.seq_ = i;
+    for (size_t b = 0; b < bulks; ++b) {
+      size_t len = b + 1 == bulks ? size - chunk * b : chunk;
+      req.send.push_back(
+          client->Expose(hipc::FullPtr<char>(buf + chunk * b), len, BULK_XFER));
+    }
+    req.send_bulks = bulks;
+    auto start = std::chrono::steady_clock::now();
+    if (client->Send(req, chan.send_ctx_) != 0) {
+      ++result.errors_;
+      continue;
+    }
+    BenchMeta ack;
+    ClientInfo info = RecvSpin(client, ack, chan.recv_ctx_);
+    auto end = std::chrono::steady_clock::now();
+    if (info.rc != 0) {
+      ++result.errors_;
+      continue;
+    }
+    client->ClearRecvHandles(ack);
+    if (i < kWarmupIterations) continue;
+    if (result.lat_us_.empty()) {
+      result.first_server_cpu_ns_ = ack.server_cpu_ns_;
+    }
+    result.last_server_cpu_ns_ = ack.server_cpu_ns_;
+    result.lat_us_.push_back(
+        std::chrono::duration<double, std::micro>(end - start).count());
+  }
+}
+
+/** Send kStop on a connection and wait for its ack */
+static void StopServer(Transport* client, const Channel& chan) {
+  BenchMeta req;
+  req.op_ = BenchMeta::kStop;
+  if (client->Send(req, chan.send_ctx_) != 0) return;
+  BenchMeta ack;
+  RecvSpin(client, ack, chan.recv_ctx_);
+}
+
+/** Print the result table header */
+static void PrintHeader(const std::string& transport) {
+  std::cout << "=== Lightbeam " << transport << " Results ===\n";
+  std::cout << std::left << std::setw(10) << "size" << std::setw(7) << "bulks"
+            << std::setw(6) << "conc" << std::setw(10) << "p50_us"
+            << std::setw(10) << "p99_us" << std::setw(10) << "p99.9_us"
+            << std::setw(10) << "mean_us" << std::setw(11) << "MB/s"
+            << std::setw(14) << "cli_cpu_ns/B" << std::setw(14)
+            << "srv_cpu_ns/B"
+            << "errors\n";
+}
+
+/** Print one sweep step */
+static void PrintRow(size_t size, size_t bulks, size_t conc,
+                     std::vector<double>& lat, double wall_s,
+                     uint64_t client_cpu_ns, uint64_t server_cpu_ns,
+                     bool server_cpu_known, int errors) {
+  std::sort(lat.begin(), lat.end());
+  auto pct = [&](double q) {
+    return lat.empty() ? 0.0 : lat[static_cast<size_t>(q * (lat.size() - 1))];
+  };
+  double mean = lat.empty() ? 0.0
+                            : std::accumulate(lat.begin(), lat.end(), 0.0) /
+                                  lat.size();
+  double bytes = static_cast<double>(size) * lat.size();
+  std::cout << std::left << std::fixed << std::setprecision(2)
+            << std::setw(10) << size << std::setw(7) << bulks << std::setw(6)
+            << conc << std::setw(10) << pct(0.50) << std::setw(10)
+            << pct(0.99) << std::setw(10) << pct(0.999) << std::setw(10)
+            << mean << std::setw(11)
+            << (wall_s > 0 ? bytes / wall_s / (1024.0 * 1024.0) : 0.0)
+            << std::setprecision(4) << std::setw(14)
+            << (bytes > 0 ? client_cpu_ns / bytes : 0.0) << std::setw(14);
+  if (server_cpu_known) {
+    std::cout << (bytes > 0 ? server_cpu_ns / bytes : 0.0);
+  } else {
+    std::cout << "-";
+  }
+  std::cout << errors << "\n";
+}
+
+/** Sweep parameters shared by client and local modes */
+struct SweepConfig {
+  std::vector<size_t> sizes_ = {64, 4096, 65536, 1 << 20};
+  std::vector<size_t> bulks_ = {1};
+  std::vector<size_t> concurrency_ = {1};
+  int iters_ = 1000;
+  std::string protocol_;
+  std::string domain_;
+  bool keep_server_ = false;
+};
+
+/**
+ * Run the sweep against a server
+ * @param name Transport name (for the header)
+ * @param connect Callable returning a new client TransportPtr
+ * @param chans Contexts per connection index (one entry per connection)
+ * @param cfg Sweep parameters
+ * @param server_cpu_known Whether acks carry the server's CPU (false when
+ *        the server shares this process)
+ * @return Connections kept open (the first one can stop the server)
+ */
+template <typename ConnectFn>
+static std::vector<TransportPtr> RunSweep(const std::string& name,
+                                          ConnectFn connect,
+                                          std::vector<Channel>& chans,
+                                          const SweepConfig& cfg,
+                                          bool server_cpu_known) {
+  size_t max_size = *std::max_element(cfg.sizes_.begin(), cfg.sizes_.end());
+  size_t max_conc =
+      *std::max_element(cfg.concurrency_.begin(), cfg.concurrency_.end());
+  std::vector<TransportPtr> clients;
+  std::vector<std::vector<char>> bufs;
+  for (size_t c = 0; c < max_conc; ++c) {
+    clients.push_back(connect());
+    bufs.emplace_back(max_size, static_cast<char>('A' + c % 26));
+    clients.back()->RegisterMemory(bufs.back().data(), max_size);
+  }
+  PrintHeader(name);
+  for (size_t conc : cfg.concurrency_) {
+    for (size_t bulks : cfg.bulks_) {
+      for (size_t size : cfg.sizes_) {
+        if (bulks > size) continue;
+        std::vector<ConnResult> results(conc);
+        std::vector<std::thread> threads;
+        uint64_t cpu_start = ProcessCpuNs();
+        auto start = std::chrono::steady_clock::now();
+        for (size_t c = 0; c < conc; ++c) {
+          threads.emplace_back(ClientLoop, clients[c].get(),
+                               std::cref(chans[c]), bufs[c].data(), size,
+                               bulks, cfg.iters_, std::ref(results[c]));
+        }
+        for (auto& thread : threads) thread.join();
+        double wall_s = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+        uint64_t client_cpu = ProcessCpuNs() - cpu_start;
+        std::vector<double> lat;
+        uint64_t srv_first = UINT64_MAX, srv_last = 0;
+        int errors = 0;
+        for (auto& r : results) {
+          lat.insert(lat.end(), r.lat_us_.begin(), r.lat_us_.end());
+          if (!r.lat_us_.empty()) {
+            srv_first = std::min(srv_first, r.first_server_cpu_ns_);
+            srv_last = std::max(srv_last, r.last_server_cpu_ns_);
+          }
+          errors += r.errors_;
+        }
+        uint64_t server_cpu = srv_last > srv_first ? srv_last - srv_first : 0;
+        PrintRow(size, bulks, conc, lat, wall_s, client_cpu, server_cpu,
+                 server_cpu_known, errors);
+      }
+    }
+  }
+  for (size_t c = 0; c < clients.size(); ++c) {
+    clients[c]->DeregisterMemory(bufs[c].data());
+  }
+  return clients;
+}
+
+/**
+ * NIXL is a same-process copy engine: time Send() into pre-populated recv
+ * bulks for each size/bulk count
+ */
+static int RunNixlLocal(const SweepConfig& cfg) {
+#if HSHM_ENABLE_NIXL
+  auto xfer = TransportFactory::Get("", TransportType::kNixl,
+                                    TransportMode::kClient);
+  size_t max_size = *std::max_element(cfg.sizes_.begin(), cfg.sizes_.end());
+  std::vector<char> src(max_size, 'N');
+  std::vector<char> dst(max_size);
+  PrintHeader("nixl (local copy)");
+  for (size_t bulks : cfg.bulks_) {
+    for (size_t size : cfg.sizes_) {
+      if (bulks > size) continue;
+      size_t chunk = size / bulks;
+      std::vector<double> lat;
+      int errors = 0;
+      uint64_t cpu_start = ProcessCpuNs();
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < kWarmupIterations + cfg.iters_; ++i) {
+        LbmMeta<> meta;
+        for (size_t b = 0; b < bulks; ++b) {
+          size_t len = b + 1 == bulks ? size - chunk * b : chunk;
+          meta.send.push_back(xfer->Expose(
+              hipc::FullPtr<char>(src.data() + chunk * b), len, BULK_XFER));
+          meta.recv.push_back(xfer->Expose(
+              hipc::FullPtr<char>(dst.data() + chunk * b), len, BULK_XFER));
+        }
+        meta.send_bulks = meta.recv_bulks = bulks;
+        auto t0 = std::chrono::steady_clock::now();
+        if (xfer->Send(meta) != 0) ++errors;
+        auto t1 = std::chrono::steady_clock::now();
+        if (i == kWarmupIterations - 1) {
+          cpu_start = ProcessCpuNs();
+          start = std::chrono::steady_clock::now();
+        }
+        if (i >= kWarmupIterations) {
+          lat.push_back(
+              std::chrono::duration<double, std::micro>(t1 - t0).count());
+        }
+      }
+      double wall_s = std::chrono::duration<double>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+      PrintRow(size, bulks, 1, lat, wall_s, ProcessCpuNs() - cpu_start, 0,
+               false, errors);
+    }
+  }
+  return 0;
+#else
+  (void)cfg;
+  std::cerr << "NIXL support is not compiled in (HSHM_ENABLE_NIXL)\n";
+  return 1;
+#endif
+}
+
+static void PrintUsage(const char* prog) {
+  std::cerr << "Usage:\n"
+            << "  " << prog
+            << " server <transport> <bind_addr> <port> [--protocol P] "
+               "[--domain D]\n"
+            << "  " << prog
+            << " client <transport> <server_addr> <port> [options]\n"
+            << "  " << prog << " local <transport> [options]\n"
+            << "Transports: zeromq socket libfabric io_uring shm nixl\n"
+            << "Options: --sizes L --bulks L --concurrency L --iters N "
+               "--protocol P --domain D --keep-server\n";
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+  std::string mode = argv[1];
+  std::string transport_name = argv[2];
+  TransportType type;
+  if (!ParseTransport(transport_name, type)) {
+    std::cerr << "Unknown transport: " << transport_name << "\n";
+    return 1;
+  }
+  int argi = 3;
+  std::string addr = "127.0.0.1";
+  int port = 9500;
+  if (mode == "server" || mode == "client") {
+    if (argc < 5) {
+      PrintUsage(argv[0]);
+      return 1;
+    }
+    addr = argv[3];
+    port = std::atoi(argv[4]);
+    argi = 5;
+  } else if (mode != "local") {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  SweepConfig cfg;
+  for (; argi < argc; ++argi) {
+    std::string opt = argv[argi];
+    bool has_val = argi + 1 < argc;
+    if (opt == "--sizes" && has_val) cfg.sizes_ = ParseList(argv[++argi]);
+    else if (opt == "--bulks" && has_val) cfg.bulks_ = ParseList(argv[++argi]);
+    else if (opt == "--concurrency" && has_val)
+      cfg.concurrency_ = ParseList(argv[++argi]);
+    else if (opt == "--iters" && has_val) cfg.iters_ = std::atoi(argv[++argi]);
+    else if (opt == "--protocol" && has_val) cfg.protocol_ = argv[++argi];
+    else if (opt == "--domain" && has_val) cfg.domain_ = argv[++argi];
+    else if (opt == "--keep-server") cfg.keep_server_ = true;
+    else {
+      PrintUsage(argv[0]);
+      return 1;
+    }
+  }
+  if (cfg.sizes_.empty() || cfg.bulks_.empty() || cfg.concurrency_.empty() ||
+      cfg.iters_ <= 0) {
+    std::cerr << "Empty --sizes/--bulks/--concurrency or bad --iters\n";
+    return 1;
+  }
+
+  bool in_process = type == TransportType::kShm || type == TransportType::kNixl;
+  if (in_process && mode != "local") {
+    std::cerr << transport_name << " is single-process; use local mode\n";
+    return 1;
+  }
+  if (type == TransportType::kNixl) {
+    return RunNixlLocal(cfg);
+  }
+
+  auto make = [&](TransportMode tmode) {
+    return TransportFactory::Get(addr, type, tmode, cfg.protocol_, port,
+                                 cfg.domain_);
+  };
+
+  if (mode == "server") {
+    TransportPtr server = make(TransportMode::kServer);
+    if (!server) {
+      std::cerr << transport_name << " is not compiled in\n";
+      return 1;
+    }
+    std::cout << "Serving " << transport_name << " on "
+              << server->GetAddress() << ":" << port << "\n";
+    ServeLoop(server.get(), Channel());
+    return 0;
+  }
+
+  std::cout << "Lightbeam Network Benchmark\n"
+            << "  Transport: " << transport_name << "  mode: " << mode
+            << "  iters: " << cfg.iters_ << "  warmup: " << kWarmupIterations
+            << "\n\n";
+
+  if (type == TransportType::kShm) {
+    // One request and one ack link; a single connection
+    ShmLink req_link;
+    ShmLink ack_link;
+    Channel server_chan{ack_link.Ctx(), req_link.Ctx()};
+    std::vector<Channel> chans{Channel{req_link.Ctx(), ack_link.Ctx()}};
+    cfg.concurrency_ = {1};
+    TransportPtr server = make(TransportMode::kServer);
+    std::thread server_thread(ServeLoop, server.get(), std::cref(server_chan),
+                              nullptr);
+    auto clients = RunSweep(
+        transport_name, [&] { return make(TransportMode::kClient); }, chans,
+        cfg, false);
+    StopServer(clients[0].get(), chans[0]);
+    server_thread.join();
+    return 0;
+  }
+
+  TransportPtr local_server;
+  std::thread server_thread;
+  if (mode == "local") {
+    local_server = make(TransportMode::kServer);
+    if (!local_server) {
+      std::cerr << transport_name << " is not compiled in\n";
+      return 1;
+    }
+    server_thread = std::thread(ServeLoop, local_server.get(), Channel(),
+                                nullptr);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  size_t max_conc =
+      *std::max_element(cfg.concurrency_.begin(), cfg.concurrency_.end());
+  std::vector<Channel> chans(max_conc);
+  auto clients = RunSweep(
+      transport_name,
+      [&] {
+        TransportPtr client = make(TransportMode::kClient);
+        if (!client) {
+          std::cerr << transport_name << " is not compiled in\n";
+          std::exit(1);
+        }
+        return client;
+      },
+      chans, cfg, mode == "client");
+  if (mode == "local" || !cfg.keep_server_) {
+    StopServer(clients[0].get(), chans[0]);
+  }
+  if (server_thread.joinable()) server_thread.join();
+  return 0;
+}
@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Ring Buffer Contention Benchmark
+ *
+ * Measures push/pop throughput of the shared-memory ring buffers under
+ * producer contention. It supports:
+ * - mpsc: mpsc_ring_buffer (fetch_add tail, producers spin for space)
+ * - mpmc: mpmc_ring_buffer (per-slot sequence numbers, any number of
+ *         consumers)
+ *
+ * Usage:
+ *   ring_buffer_benchmark <ring_type> <num_producers> [num_consumers]
+ *                         [duration_sec] [depth]
+ *
+ * Parameters:
+ *   ring_type: "mpsc" or "mpmc"
+ *   num_producers: Number of pushing threads (1-256)
+ *   num_consumers: Number of popping threads (default: 1; mpsc requires 1)
+ *   duration_sec: Duration to run benchmark in seconds (default: 5)
+ *   depth: Ring depth in entries (default: 1024)
+ *
+ * Example:
+ *   ring_buffer_benchmark mpmc 64 4 10
+ *   This runs the MPMC ring with 64 producers and 4 consumers for 10 seconds.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hermes_shm/data_structures/ipc/mpmc_ring_buffer.h"
+#include "hermes_shm/data_structures/ipc/ring_buffer.h"
+#include "hermes_shm/memory/allocator/arena_allocator.h"
+#include "hermes_shm/memory/backend/malloc_backend.h"
+
+namespace bench {
+
+using RingAlloc = hipc::ArenaAllocator<false>;
+
+/**
+ * Print usage information and exit
+ */
+void PrintUsage(const char* program_name) {
+  std::cerr << "Usage: " << program_name
+            << " <ring_type> <num_producers> [num_consumers] [duration_sec]"
+               " [depth]\n\n"
+            << "Parameters:\n"
+            << "  ring_type:      Ring buffer to benchmark\n"
+            << "                  - mpsc: mpsc_ring_buffer\n"
+            << "                  - mpmc: mpmc_ring_buffer\n"
+            << "  num_producers:  Number of pushing threads (1-256)\n"
+            << "  num_consumers:  Number of popping threads (default: 1,"
+               " mpsc requires 1)\n"
+            << "  duration_sec:   Duration to run benchmark in seconds"
+               " (default: 5)\n"
+            << "  depth:          Ring depth in entries (default: 1024)\n\n"
+            << "Examples:\n"
+            << "  " << program_name << " mpsc 8\n"
+            << "  " << program_name << " mpmc 64 1 10\n"
+            << "  " << program_name << " mpmc 64 8 10\n";
+  exit(1);
+}
+
+/**
+ * Per-thread operation count padded to its own cache line so the counters
+ * themselves do not add contention
+ */
+struct ThreadCount {
+  uint64_t count_ = 0;
+  char pad_[64 - sizeof(uint64_t)];
+};
+
+/**
+ * Run producers and consumers against one ring
+ *
+ * Producers push until the duration expires. Consumers keep popping until
+ * every producer has exited and the ring is drained, so mpsc producers
+ * waiting for space always make progress.
+ *
+ * @param ring Ring buffer with Push(const u64&) and Pop(u64&)
+ * @param num_producers Number of pushing threads
+ * @param num_consumers Number of popping threads
+ * @param duration_sec Duration of the push phase
+ * @param pushes Receives the total number of pushes
+ * @param pops Receives the total number of pops
+ * @return Elapsed wall time in seconds
+ */
+template <typename RingT>
+double RunContention(RingT& ring, int num_producers, int num_consumers,
+                     int duration_sec, uint64_t& pushes, uint64_t& pops) {
+  std::vector<ThreadCount> push_counts(num_producers);
+  std::vector<ThreadCount> pop_counts(num_consumers);
+  std::atomic<bool> stop(false);
+  std::atomic<int> producers_left(num_producers);
+
+  auto start_time = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_consumers; ++i) {
+    threads.emplace_back([&, i]() {
+      hshm::u64 val;
+      uint64_t count = 0;
+      while (true) {
+        if (ring.Pop(val)) {
+          ++count;
+        } else if (producers_left.load(std::memory_order_acquire) == 0) {
+          if (!ring.Pop(val)) {
+            break;
+          }
+          ++count;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+      pop_counts[i].count_ = count;
+    });
+  }
+  for (int i = 0; i < num_producers; ++i) {
+    threads.emplace_back([&, i]() {
+      uint64_t count = 0;
+      hshm::u64 val = static_cast<hshm::u64>(i) << 40;
+      while (!stop.load(std::memory_order_relaxed)) {
+        if (ring.Push(val + count)) {
+          ++count;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+      push_counts[i].count_ = count;
+      producers_left.fetch_sub(1, std::memory_order_release);
+    });
+  }
+
+  std::this_thread::sleep_for(std::chrono::seconds(duration_sec));
+  stop.store(true, std::memory_order_relaxed);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto end_time = std::chrono::steady_clock::now();
+
+  pushes = 0;
+  pops = 0;
+  for (auto& c : push_counts) {
+    pushes += c.count_;
+  }
+  for (auto& c : pop_counts) {
+    pops += c.count_;
+  }
+  return std::chrono::duration<double>(end_time - start_time).count();
+}
+
+/**
+ * Benchmark one ring type and print the results
+ */
+template <typename RingT>
+int RunBenchmark(const std::string& ring_type, int num_producers,
+                 int num_consumers, int duration_sec, size_t depth) {
+  hipc::MallocBackend backend;
+  size_t arena_size = 2 * RingT::CalculateSize(depth) + 1024 * 1024;
+  if (!backend.shm_init(hipc::MemoryBackendId(0, 0), arena_size)) {
+    std::cerr << "Error: Failed to initialize memory backend\n";
+    return 1;
+  }
+  auto* alloc = backend.MakeAlloc<RingAlloc>();
+  if (alloc == nullptr) {
+    std::cerr << "Error: Failed to create allocator\n";
+    return 1;
+  }
+
+  uint64_t pushes, pops;
+  double elapsed;
+  {
+    RingT ring(alloc, depth);
+    elapsed = RunContention(ring, num_producers, num_consumers, duration_sec,
+                            pushes, pops);
+  }
+
+  std::cout << "\n========================================\n"
+            << "Ring Buffer Benchmark Results\n"
+            << "========================================\n"
+            << "Ring:              " << ring_type << "\n"
+            << "Producers:         " << num_producers << "\n"
+            << "Consumers:         " << num_consumers << "\n"
+            << "Depth:             " << depth << "\n"
+            << "Elapsed:           " << std::fixed << std::setprecision(2)
+            << elapsed << " s\n"
+            << "----------------------------------------\n"
+            << "Total pushes:      " << pushes << "\n"
+            << "Total pops:        " << pops << "\n"
+            << "Pop throughput:    " << std::setprecision(0)
+            << (pops / elapsed) << " ops/sec\n"
+            << "========================================\n\n";
+  if (pushes != pops) {
+    std::cerr << "Error: " << pushes - pops << " entries were lost\n";
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace bench
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    bench::PrintUsage(argv[0]);
+  }
+
+  std::string ring_type = argv[1];
+  int num_producers = std::atoi(argv[2]);
+  int num_consumers = argc > 3 ? std::atoi(argv[3]) : 1;
+  int duration_sec = argc > 4 ? std::atoi(argv[4]) : 5;
+  size_t depth = argc > 5 ? std::strtoull(argv[5], nullptr, 10) : 1024;
+
+  if (num_producers < 1 || num_producers > 256) {
+    std::cerr << "Error: num_producers must be between 1 and 256\n";
+    return 1;
+  }
+  if (num_consumers < 1 || num_consumers > 256) {
+    std::cerr << "Error: num_consumers must be between 1 and 256\n";
+    return 1;
+  }
+  if (duration_sec < 1 || depth < 2) {
+    std::cerr << "Error: duration_sec must be >= 1 and depth >= 2\n";
+    return 1;
+  }
+
+  if (ring_type == "mpsc") {
+    if (num_consumers != 1) {
+      std::cerr << "Error: mpsc supports exactly one consumer\n";
+      return 1;
+    }
+    return bench::RunBenchmark<hipc::mpsc_ring_buffer<hshm::u64,
+                                                      bench::RingAlloc>>(
+        ring_type, num_producers, num_consumers, duration_sec, depth);
+  } else if (ring_type == "mpmc") {
+    return bench::RunBenchmark<hipc::mpmc_ring_buffer<hshm::u64,
+                                                      bench::RingAlloc>>(
+        ring_type, num_producers, num_consumers, duration_sec, depth);
+  }
+  std::cerr << "Error: Unknown ring type '" << ring_type << "'\n";
+  bench::PrintUsage(argv[0]);
+  return 1;
+}
@@ -38,19 +38,25 @@
  * Client sends a message -> server receives -> server sends back -> client
  * receives. Reports min, max, median, mean, and p99 latency.
  *
+ * The shm transport runs the same ping-pong over two lightbeam ShmTransport
+ * SPSC rings (request and reply) as the baseline ZMQ IPC is compared to.
+ *
  * Usage:
- *   zmq_ipc_latency_benchmark [num_iterations] [message_size]
+ *   zmq_ipc_latency_benchmark [num_iterations] [message_size] [zmq|shm]
  *
  * Parameters:
  *   num_iterations: Number of round-trip iterations (default: 10000)
  *   message_size:   Message size in bytes (default: 256)
+ *   transport:      zmq (default) or shm
  *
  * Examples:
  *   zmq_ipc_latency_benchmark
  *   zmq_ipc_latency_benchmark 50000
  *   zmq_ipc_latency_benchmark 50000 1024
+ *   zmq_ipc_latency_benchmark 50000 1024 shm
  */
 
+#include <hermes_shm/lightbeam/shm_transport.h>
 #include <zmq.h>
 #include <unistd.h>
 
@@ -60,7 +66,9 @@
 #include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <numeric>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -85,6 +93,61 @@ void ServerThread(int num_iterations) {
   zmq_ctx_destroy(ctx);
 }
 
+/** Ring capacity for each direction of the shm transport */
+static const size_t kShmRingSize = 64 * 1024;
+
+/** One direction of the shm ping-pong: ring metadata plus copy space */
+struct ShmRing {
+  hshm::lbm::ShmTransferInfo info_;
+  std::vector<char> copy_space_;
+
+  ShmRing() : copy_space_(kShmRingSize) {
+    info_.copy_space_size_ = kShmRingSize;
+  }
+
+  hshm::lbm::LbmContext Ctx() {
+    hshm::lbm::LbmContext ctx;
+    ctx.copy_space = copy_space_.data();
+    ctx.shm_info_ = &info_;
+    return ctx;
+  }
+};
+
+/** Send one private-memory message as a BULK_XFER */
+static void ShmSendMessage(char* data, size_t size,
+                           const hshm::lbm::LbmContext& ctx) {
+  hshm::lbm::LbmMeta<> meta;
+  hshm::lbm::Bulk bulk;
+  bulk.data = hipc::FullPtr<char>(data);
+  bulk.size = size;
+  bulk.flags = hshm::bitfield32_t(BULK_XFER);
+  meta.send.push_back(bulk);
+  meta.send_bulks = 1;
+  hshm::lbm::ShmTransport::Send(meta, ctx);
+}
+
+/** Receive one message into dst; returns its size */
+static size_t ShmRecvMessage(char* dst, const hshm::lbm::LbmContext& ctx) {
+  hshm::lbm::LbmMeta<> meta;
+  hshm::lbm::ShmTransport::Recv(meta, ctx);
+  size_t size = meta.recv[0].size;
+  std::memcpy(dst, meta.recv[0].data.ptr_, size);
+  std::free(meta.recv[0].data.ptr_);
+  return size;
+}
+
+void ShmServerThread(ShmRing* req, ShmRing* rep, int num_iterations,
+                     size_t message_size) {
+  int total = kWarmupIterations + num_iterations;
+  std::vector<char> buf(message_size);
+  auto req_ctx = req->Ctx();
+  auto rep_ctx = rep->Ctx();
+  for (int i = 0; i < total; ++i) {
+    size_t nbytes = ShmRecvMessage(buf.data(), req_ctx);
+    ShmSendMessage(buf.data(), nbytes, rep_ctx);
+  }
+}
+
 int main(int argc, char** argv) {
   int num_iterations = 10000;
   int message_size = 256;
@@ -103,56 +166,93 @@ int main(int argc, char** argv) {
       return 1;
     }
   }
+  std::string transport = "zmq";
+  if (argc > 3) {
+    transport = argv[3];
+    if (transport != "zmq" && transport != "shm") {
+      std::cerr << "Error: transport must be zmq or shm\n";
+      return 1;
+    }
+  }
+  bool use_shm = transport == "shm";
 
-  std::cout << "ZMQ IPC Round-Trip Latency Benchmark\n";
+  std::cout << (use_shm ? "SHM" : "ZMQ IPC")
+            << " Round-Trip Latency Benchmark\n";
   std::cout << "  Iterations:   " << num_iterations << "\n";
   std::cout << "  Message size: " << message_size << " bytes\n";
   std::cout << "  Warmup:       " << kWarmupIterations << " iterations\n";
-  std::cout << "  Endpoint:     " << kEndpoint << "\n\n";
+  if (use_shm) {
+    std::cout << "  Ring size:    " << kShmRingSize << " bytes\n\n";
+  } else {
+    std::cout << "  Endpoint:     " << kEndpoint << "\n\n";
+  }
 
-  // Remove stale IPC endpoint file
-  unlink("/tmp/zmq_ipc_latency_bench");
+  std::vector<char> send_buf(message_size, 'A');
+  std::vector<char> recv_buf(message_size);
+  std::vector<double> latencies(num_iterations);
 
-  // Start server thread
-  std::thread server(ServerThread, num_iterations);
+  if (use_shm) {
+    auto req = std::make_unique<ShmRing>();
+    auto rep = std::make_unique<ShmRing>();
+    std::thread server(ShmServerThread, req.get(), rep.get(), num_iterations,
+                       static_cast<size_t>(message_size));
+    auto req_ctx = req->Ctx();
+    auto rep_ctx = rep->Ctx();
 
-  // Client setup
-  void* ctx = zmq_ctx_new();
-  void* sock = zmq_socket(ctx, ZMQ_REQ);
+    for (int i = 0; i < kWarmupIterations; ++i) {
+      ShmSendMessage(send_buf.data(), message_size, req_ctx);
+      ShmRecvMessage(recv_buf.data(), rep_ctx);
+    }
+    for (int i = 0; i < num_iterations; ++i) {
+      auto start = std::chrono::steady_clock::now();
+      ShmSendMessage(send_buf.data(), message_size, req_ctx);
+      ShmRecvMessage(recv_buf.data(), rep_ctx);
+      auto end = std::chrono::steady_clock::now();
+      latencies[i] =
+          std::chrono::duration<double, std::milli>(end - start).count();
+    }
+    server.join();
+  } else {
+    // Remove stale IPC endpoint file
+    unlink("/tmp/zmq_ipc_latency_bench");
 
-  // Brief sleep to let server bind
-  std::this_thread::sleep_for(std::chrono::milliseconds(100));
-  zmq_connect(sock, kEndpoint);
-  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // Start server thread
+    std::thread server(ServerThread, num_iterations);
 
-  std::vector<char> send_buf(message_size, 'A');
-  std::vector<char> recv_buf(message_size);
+    // Client setup
+    void* ctx = zmq_ctx_new();
+    void* sock = zmq_socket(ctx, ZMQ_REQ);
 
-  // Warmup phase
-  for (int i = 0; i < kWarmupIterations; ++i) {
-    zmq_send(sock, send_buf.data(), message_size, 0);
-    zmq_recv(sock, recv_buf.data(), recv_buf.size(), 0);
-  }
+    // Brief sleep to let server bind
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    zmq_connect(sock, kEndpoint);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
-  // Timed phase
-  std::vector<double> latencies(num_iterations);
+    // Warmup phase
+    for (int i = 0; i < kWarmupIterations; ++i) {
+      zmq_send(sock, send_buf.data(), message_size, 0);
+      zmq_recv(sock, recv_buf.data(), recv_buf.size(), 0);
+    }
 
-  for (int i = 0; i < num_iterations; ++i) {
-    auto start = std::chrono::steady_clock::now();
-    zmq_send(sock, send_buf.data(), message_size, 0);
-    zmq_recv(sock, recv_buf.data(), recv_buf.size(), 0);
-    auto end = std::chrono::steady_clock::now();
+    // Timed phase
+    for (int i = 0; i < num_iterations; ++i) {
+      auto start = std::chrono::steady_clock::now();
+      zmq_send(sock, send_buf.data(), message_size, 0);
+      zmq_recv(sock, recv_buf.data(), recv_buf.size(), 0);
+      auto end = std::chrono::steady_clock::now();
 
-    latencies[i] = std::chrono::duration<double, std::milli>(end - start).count();
-  }
+      latencies[i] =
+          std::chrono::duration<double, std::milli>(end - start).count();
+    }
 
-  // Cleanup client
-  zmq_close(sock);
-  zmq_ctx_destroy(ctx);
-  server.join();
+    // Cleanup client
+    zmq_close(sock);
+    zmq_ctx_destroy(ctx);
+    server.join();
 
-  // Remove IPC endpoint file
-  unlink("/tmp/zmq_ipc_latency_bench");
+    // Remove IPC endpoint file
+    unlink("/tmp/zmq_ipc_latency_bench");
+  }
 
   // Compute statistics
   std::sort(latencies.begin(), latencies.end());
@@ -36,6 +36,9 @@
 
 // #include "hermes_shm/data_structures/all.h"  // Deleted during hard refactoring
 
+#include <cstddef>
+#include <vector>
+
 namespace hshm {
 
 class Compressor {
@@ -54,6 +57,51 @@ class Compressor {
    * */
   virtual bool Decompress(void *output, size_t &output_size, void *input,
                           size_t input_size) = 0;
+
+  /**
+   * Whether BeginStream/Update/Finish stream natively. When false, the
+   * stream calls buffer the input and Finish runs the one-shot Compress.
+   * */
+  virtual bool SupportsStreaming() const { return false; }
+
+  /**
+   * Begin a new compression stream, discarding any unfinished one.
+   * The output of a finished stream decodes with the one-shot Decompress.
+   * */
+  virtual bool BeginStream() {
+    stream_buf_.clear();
+    return true;
+  }
+
+  /**
+   * Feed the next block of the stream. Up to output_size bytes of
+   * compressed data are written to output and output_size is set to the
+   * number written, which may be zero while the codec buffers. Returns
+   * false if the block could not be consumed within output_size.
+   * */
+  virtual bool Update(void *output, size_t &output_size, const void *input,
+                      size_t input_size) {
+    (void)output;
+    const char *bytes = static_cast<const char *>(input);
+    stream_buf_.insert(stream_buf_.end(), bytes, bytes + input_size);
+    output_size = 0;
+    return true;
+  }
+
+  /**
+   * Flush the rest of the stream into output. output_size is set to the
+   * number of bytes written. Without native streaming this is the whole
+   * compressed stream, so size output for the full input.
+   * */
+  virtual bool Finish(void *output, size_t &output_size) {
+    bool ret = Compress(output, output_size, stream_buf_.data(),
+                        stream_buf_.size());
+    stream_buf_.clear();
+    return ret;
+  }
+
+ protected:
+  std::vector<char> stream_buf_; /**< Input buffered by the default stream */
 };
 
 }  // namespace hshm
@@ -38,8 +38,10 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include "compress.h"
 #include "lossless_modes.h"
+#include "zstd_dict.h"
 #include "snappy.h"
 #include "blosc.h"
 
@@ -47,6 +49,10 @@
 #include "libpressio_modes.h"
 #endif
 
+#if HSHM_ENABLE_NVCOMP
+#include "nvcomp.h"
+#endif
+
 namespace hshm {
 
 /**
@@ -75,6 +81,8 @@ class CompressionFactory {
    *                     Supported: "bzip2", "zstd", "lz4", "zlib", "lzma",
    *                                "brotli", "snappy", "blosc2"
    *                                "zfp", "sz3", "fpzip" (if LibPressio enabled)
+   *                                "nvcomp_lz4", "nvcomp_cascaded",
+   *                                "nvcomp_bitcomp" (if nvCOMP enabled)
    * @param preset Compression preset level (FAST/BALANCED/BEST/DEFAULT)
    * @return Unique pointer to configured compressor instance,
    *         or nullptr if library not found
@@ -133,10 +141,65 @@ class CompressionFactory {
     }
 #endif
 
+#if HSHM_ENABLE_NVCOMP
+    // GPU compressors (default only)
+    if (lib_lower == "nvcomp_lz4") {
+      return std::make_unique<NvcompLz4>();
+    }
+    if (lib_lower == "nvcomp_cascaded") {
+      return std::make_unique<NvcompCascaded>();
+    }
+    if (lib_lower == "nvcomp_bitcomp") {
+      return std::make_unique<NvcompBitcomp>();
+    }
+#endif
+
     // Unknown library
     return nullptr;
   }
 
+  /**
+   * Get this thread's cached compressor for a library and preset.
+   *
+   * Compressors and the library contexts they hold (e.g., zstd stream
+   * contexts) are created once per worker thread and reused, so repeated
+   * calls skip setup. The compressor is owned by the thread and must not be
+   * shared with other threads or held across a task yield while streaming.
+   *
+   * @param library_name Name of compression library (case-insensitive)
+   * @param preset Compression preset level
+   * @return Thread-owned compressor, or nullptr if library not found
+   */
+  static Compressor* GetThreadLocal(
+      const std::string& library_name,
+      CompressionPreset preset = CompressionPreset::BALANCED) {
+    thread_local std::unordered_map<int, std::unique_ptr<Compressor>> cache;
+    int library_id = GetLibraryId(library_name, preset);
+    if (library_id == 0) {
+      return nullptr;
+    }
+    auto it = cache.find(library_id);
+    if (it == cache.end()) {
+      it = cache.emplace(library_id, GetPreset(library_name, preset)).first;
+    }
+    return it->second.get();
+  }
+
+  /**
+   * Check whether a library compresses on the GPU.
+   *
+   * GPU libraries work on device buffers in place, so they are the ones
+   * to use for data that already lives in HBM.
+   *
+   * @param library_name Name of compression library
+   * @return true for the nvCOMP libraries
+   */
+  static bool IsGpuLibrary(const std::string& library_name) {
+    std::string lib_lower = library_name;
+    for (auto& c : lib_lower) c = std::tolower(c);
+    return lib_lower.rfind("nvcomp_", 0) == 0;
+  }
+
   /**
    * Get library ID for a given library name and preset.
    * This ID can be used for model training and runtime compression selection.
@@ -148,6 +211,7 @@ class CompressionFactory {
    * ID encoding scheme:
    * - Lossless: base_id * 10 + preset (e.g., BZIP2_FAST=11, BZIP2_BALANCED=12, BZIP2_BEST=13)
    * - Lossy: base_id * 10 + preset (e.g., ZFP_FAST=101, ZFP_BALANCED=102, ZFP_BEST=103)
+   * - GPU: base_id 13-15, single mode (e.g., NVCOMP_LZ4=132)
    */
   static int GetLibraryId(const std::string& library_name, CompressionPreset preset) {
     std::string lib_lower = library_name;
@@ -168,11 +232,16 @@ class CompressionFactory {
     else if (lib_lower == "zfp") base_id = 10;
     else if (lib_lower == "sz3") base_id = 11;
     else if (lib_lower == "fpzip") base_id = 12;
+    // GPU base IDs (13+)
+    else if (lib_lower == "nvcomp_lz4") base_id = 13;
+    else if (lib_lower == "nvcomp_cascaded") base_id = 14;
+    else if (lib_lower == "nvcomp_bitcomp") base_id = 15;
 
     if (base_id == 0) return 0;  // Unknown library
 
-    // For single-mode libraries (SNAPPY, Blosc2), always use preset 2 (BALANCED)
-    if (base_id == 7 || base_id == 8) {
+    // For single-mode libraries (SNAPPY, Blosc2, nvCOMP), always use preset
+    // 2 (BALANCED)
+    if (base_id == 7 || base_id == 8 || base_id >= 13) {
       return base_id * 10 + 2;
     }
 
@@ -214,6 +283,10 @@ class CompressionFactory {
     else if (base_id == 10) library_name = "zfp";
     else if (base_id == 11) library_name = "sz3";
     else if (base_id == 12) library_name = "fpzip";
+    // GPU libraries
+    else if (base_id == 13) library_name = "nvcomp_lz4";
+    else if (base_id == 14) library_name = "nvcomp_cascaded";
+    else if (base_id == 15) library_name = "nvcomp_bitcomp";
 
     CompressionPreset preset = CompressionPreset::BALANCED;
     if (preset_id == 1) preset = CompressionPreset::FAST;
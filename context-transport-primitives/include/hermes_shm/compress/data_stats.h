@@ -41,12 +41,19 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <vector>
 #include <algorithm>
 #include <string>
 #include <type_traits>
 #include <random>
 
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace hshm {
 
 /**
@@ -59,6 +66,23 @@ enum class DataType {
   DOUBLE64
 };
 
+/**
+ * CompressionFeatureSet: Every feature DataStatistics computes for a buffer
+ *
+ * Filled in one read of the data by DataStatistics<T>::CalculateAllFeatures
+ * or from sampled blocks by BlockSampler<T>::SampleFeatures.
+ */
+struct CompressionFeatureSet {
+  double shannon_entropy = 0.0;
+  double mad = 0.0;
+  double mean = 0.0;
+  double first_derivative = 0.0;
+  double second_derivative = 0.0;
+  double byte_frequency_variance = 0.0;
+  size_t max_run_length = 0;
+  double zero_ratio = 0.0;
+};
+
 /**
  * DataStatistics: Templated statistics calculator for compression prediction
  *
@@ -79,6 +103,183 @@ enum class DataType {
 template<typename T>
 class DataStatistics {
  public:
+  /**
+   * Running sums behind a CompressionFeatureSet
+   *
+   * AccumulateFeatures can be called on several blocks of one buffer; the
+   * derivatives and runs are then measured within each block.
+   */
+  struct FeatureAccumulator {
+    size_t histogram[256] = {0};
+    size_t num_elements = 0;
+    double sum = 0.0;
+    double abs_dev_sum = 0.0;
+    double first_deriv_sum = 0.0;
+    size_t first_deriv_count = 0;
+    double second_deriv_sum = 0.0;
+    size_t second_deriv_count = 0;
+    size_t max_run_length = 0;
+
+    double Mean() const {
+      return num_elements ? sum / static_cast<double>(num_elements) : 0.0;
+    }
+
+    /** Turn the sums into features; abs_dev_sum must be filled first */
+    CompressionFeatureSet Finish() const {
+      CompressionFeatureSet features;
+      if (num_elements == 0) return features;
+      double num_bytes = static_cast<double>(num_elements * sizeof(T));
+      double mean_freq = num_bytes / 256.0;
+      double variance = 0.0;
+      for (size_t i = 0; i < 256; i++) {
+        double count = static_cast<double>(histogram[i]);
+        if (histogram[i] > 0) {
+          double p_i = count / num_bytes;
+          features.shannon_entropy += -p_i * std::log2(p_i);
+        }
+        variance += (count - mean_freq) * (count - mean_freq);
+      }
+      features.byte_frequency_variance = variance / 256.0;
+      features.zero_ratio = static_cast<double>(histogram[0]) / num_bytes;
+      features.mean = Mean();
+      features.mad = abs_dev_sum / static_cast<double>(num_elements);
+      if (first_deriv_count > 0) {
+        features.first_derivative =
+            first_deriv_sum / static_cast<double>(first_deriv_count);
+      }
+      if (second_deriv_count > 0) {
+        features.second_derivative =
+            second_deriv_sum / static_cast<double>(second_deriv_count);
+      }
+      features.max_run_length = max_run_length;
+      return features;
+    }
+  };
+
+  /**
+   * Calculate every compression feature with one read of the data
+   *
+   * The buffer is walked in L1-sized tiles. Each tile is histogrammed and
+   * scanned for the sum, derivatives and runs while it is in cache. MAD
+   * needs the mean, so it takes one more (vectorized) pass. Results match
+   * the individual Calculate* functions up to floating-point rounding.
+   *
+   * @param data Pointer to data buffer
+   * @param num_elements Number of elements
+   * @return All features of the buffer
+   */
+  static CompressionFeatureSet CalculateAllFeatures(const T* data, size_t num_elements) {
+    FeatureAccumulator acc;
+    AccumulateFeatures(data, num_elements, acc);
+    acc.abs_dev_sum = SumAbsDeviation(data, num_elements, acc.Mean());
+    return acc.Finish();
+  }
+
+  /**
+   * Add one block to a feature accumulator (everything except MAD)
+   *
+   * @param data Pointer to the block
+   * @param num_elements Number of elements in the block
+   * @param acc Accumulator to add to
+   */
+  static void AccumulateFeatures(const T* data, size_t num_elements,
+                                 FeatureAccumulator& acc) {
+    if (num_elements == 0) return;
+    constexpr size_t kTileElements =
+        (kFeatureTileBytes / sizeof(T)) > 0 ? kFeatureTileBytes / sizeof(T) : 1;
+    // One sub-histogram per byte of a 64-bit word, so equal bytes (such as
+    // the exponents of neighbouring floats) do not serialize on one counter.
+    // Flushed before a 32-bit counter could wrap.
+    uint32_t histograms[kHistogramLanes][256] = {};
+    size_t unflushed_bytes = 0;
+    size_t run = 1;
+    size_t max_run = std::max<size_t>(acc.max_run_length, 1);
+
+    for (size_t begin = 0; begin < num_elements; begin += kTileElements) {
+      size_t end = std::min(num_elements, begin + kTileElements);
+      size_t tile_bytes = (end - begin) * sizeof(T);
+      HistogramBytes(reinterpret_cast<const uint8_t*>(data + begin),
+                     tile_bytes, histograms);
+      AccumulateElementTile(data, begin, end, acc);
+      for (size_t i = std::max<size_t>(begin, 1); i < end; i++) {
+        if (data[i] == data[i - 1]) {
+          max_run = std::max(max_run, ++run);
+        } else {
+          run = 1;
+        }
+      }
+      unflushed_bytes += tile_bytes;
+      if (unflushed_bytes >= (size_t(1) << 30) || end == num_elements) {
+        for (size_t b = 0; b < 256; b++) {
+          for (size_t lane = 0; lane < kHistogramLanes; lane++) {
+            acc.histogram[b] += histograms[lane][b];
+          }
+        }
+        std::memset(histograms, 0, sizeof(histograms));
+        unflushed_bytes = 0;
+      }
+    }
+
+    acc.num_elements += num_elements;
+    acc.first_deriv_count += num_elements - 1;
+    acc.second_deriv_count += num_elements >= 2 ? num_elements - 2 : 0;
+    acc.max_run_length = max_run;
+  }
+
+  /**
+   * Sum of absolute deviations from a mean (the MAD numerator)
+   *
+   * @param data Pointer to data buffer
+   * @param num_elements Number of elements
+   * @param mean Mean to measure from
+   * @return Sum of |data[i] - mean|
+   */
+  static double SumAbsDeviation(const T* data, size_t num_elements, double mean) {
+    size_t i = 0;
+    double total = 0.0;
+#if defined(__AVX512F__)
+    if constexpr (kSimdLoad) {
+      __m512d vmean = _mm512_set1_pd(mean);
+      __m512d vsum = _mm512_setzero_pd();
+      for (; i + 8 <= num_elements; i += 8) {
+        vsum = _mm512_add_pd(vsum, _mm512_abs_pd(_mm512_sub_pd(Load8(data + i), vmean)));
+      }
+      total = _mm512_reduce_add_pd(vsum);
+    }
+#elif defined(__AVX2__)
+    if constexpr (kSimdLoad) {
+      const __m256d sign = _mm256_set1_pd(-0.0);
+      __m256d vmean = _mm256_set1_pd(mean);
+      __m256d vsum = _mm256_setzero_pd();
+      for (; i + 4 <= num_elements; i += 4) {
+        vsum = _mm256_add_pd(
+            vsum, _mm256_andnot_pd(sign, _mm256_sub_pd(Load4(data + i), vmean)));
+      }
+      total = HorizontalSum(vsum);
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    if constexpr (kSimdLoad) {
+      float64x2_t vmean = vdupq_n_f64(mean);
+      float64x2_t vsum = vdupq_n_f64(0.0);
+      for (; i + 2 <= num_elements; i += 2) {
+        vsum = vaddq_f64(vsum, vabsq_f64(vsubq_f64(Load2(data + i), vmean)));
+      }
+      total = vaddvq_f64(vsum);
+    }
+#endif
+    // Independent partial sums let the compiler vectorize integer types
+    double partial[4] = {0.0, 0.0, 0.0, 0.0};
+    for (; i + 4 <= num_elements; i += 4) {
+      for (size_t lane = 0; lane < 4; lane++) {
+        partial[lane] += std::abs(static_cast<double>(data[i + lane]) - mean);
+      }
+    }
+    for (; i < num_elements; i++) {
+      partial[0] += std::abs(static_cast<double>(data[i]) - mean);
+    }
+    return total + partial[0] + partial[1] + partial[2] + partial[3];
+  }
+
   /**
    * Calculate Shannon Entropy
    *
@@ -113,6 +314,53 @@ class DataStatistics {
     return entropy;
   }
 
+  /**
+   * Estimate the byte entropy of a buffer from a few evenly spaced blocks
+   *
+   * A cheap incompressibility check: only num_blocks * block_bytes bytes
+   * are read, into the same interleaved histograms as CalculateAllFeatures.
+   * The first and last blocks are always included.
+   *
+   * @param data Pointer to data buffer
+   * @param num_bytes Buffer size in bytes
+   * @param num_blocks Number of blocks to read
+   * @param block_bytes Bytes per block
+   * @return Shannon entropy in bits per byte; exact when the blocks cover
+   *         the buffer
+   */
+  static double SampleByteEntropy(const void* data, size_t num_bytes,
+                                  size_t num_blocks = 4,
+                                  size_t block_bytes = 1024) {
+    if (num_bytes == 0 || num_blocks == 0 || block_bytes == 0) return 0.0;
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint32_t histograms[kHistogramLanes][256] = {};
+    size_t sampled = 0;
+    if (num_blocks * block_bytes >= num_bytes) {
+      HistogramBytes(bytes, num_bytes, histograms);
+      sampled = num_bytes;
+    } else {
+      size_t max_start = num_bytes - block_bytes;
+      for (size_t i = 0; i < num_blocks; i++) {
+        size_t start = num_blocks == 1 ? 0 : i * max_start / (num_blocks - 1);
+        HistogramBytes(bytes + start, block_bytes, histograms);
+      }
+      sampled = num_blocks * block_bytes;
+    }
+
+    double entropy = 0.0;
+    for (size_t b = 0; b < 256; b++) {
+      uint64_t count = 0;
+      for (size_t lane = 0; lane < kHistogramLanes; lane++) {
+        count += histograms[lane][b];
+      }
+      if (count > 0) {
+        double p = static_cast<double>(count) / static_cast<double>(sampled);
+        entropy -= p * std::log2(p);
+      }
+    }
+    return entropy;
+  }
+
   /**
    * Calculate Mean Absolute Deviation (MAD)
    *
@@ -368,15 +616,144 @@ class DataStatistics {
    * @return Vector of [shannon_entropy, MAD, zero_ratio, first_derivative]
    */
   static std::vector<double> CalculateCompressionFeatures(const T* data, size_t num_elements) {
-    std::vector<double> features;
-    features.reserve(4);
+    CompressionFeatureSet all = CalculateAllFeatures(data, num_elements);
+    return {all.shannon_entropy, all.mad, all.zero_ratio, all.first_derivative};
+  }
+
+ private:
+  /** Tile size of CalculateAllFeatures; fits L1 with the histograms */
+  static constexpr size_t kFeatureTileBytes = 16384;
+  static constexpr size_t kHistogramLanes = 8;
+
+  /** Float and double are widened to double lanes by the SIMD kernels */
+  static constexpr bool kSimdLoad =
+      std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+#if defined(__AVX512F__)
+  static __m512d Load8(const T* ptr) {
+    if constexpr (std::is_same_v<T, float>) {
+      return _mm512_cvtps_pd(_mm256_loadu_ps(ptr));
+    } else {
+      return _mm512_loadu_pd(ptr);
+    }
+  }
+#elif defined(__AVX2__)
+  static __m256d Load4(const T* ptr) {
+    if constexpr (std::is_same_v<T, float>) {
+      return _mm256_cvtps_pd(_mm_loadu_ps(ptr));
+    } else {
+      return _mm256_loadu_pd(ptr);
+    }
+  }
 
-    features.push_back(CalculateShannonEntropy(data, num_elements));
-    features.push_back(CalculateMAD(data, num_elements));
-    features.push_back(CalculateZeroRatio(data, num_elements));
-    features.push_back(CalculateFirstDerivative(data, num_elements));
+  static double HorizontalSum(__m256d v) {
+    __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+  }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+  static float64x2_t Load2(const T* ptr) {
+    if constexpr (std::is_same_v<T, float>) {
+      return vcvt_f64_f32(vld1_f32(ptr));
+    } else {
+      return vld1q_f64(ptr);
+    }
+  }
+#endif
+
+  /** Count the bytes of one tile into interleaved histograms */
+  static void HistogramBytes(const uint8_t* bytes, size_t num_bytes,
+                             uint32_t (&histograms)[kHistogramLanes][256]) {
+    size_t i = 0;
+    for (; i + 8 <= num_bytes; i += 8) {
+      uint64_t word;
+      std::memcpy(&word, bytes + i, sizeof(word));
+      histograms[0][word & 0xff]++;
+      histograms[1][(word >> 8) & 0xff]++;
+      histograms[2][(word >> 16) & 0xff]++;
+      histograms[3][(word >> 24) & 0xff]++;
+      histograms[4][(word >> 32) & 0xff]++;
+      histograms[5][(word >> 40) & 0xff]++;
+      histograms[6][(word >> 48) & 0xff]++;
+      histograms[7][word >> 56]++;
+    }
+    for (; i < num_bytes; i++) {
+      histograms[0][bytes[i]]++;
+    }
+  }
 
-    return features;
+  /**
+   * Add the sum and the first and second derivatives of data[begin, end)
+   * to acc. Derivatives reach back into the previous tile.
+   */
+  static void AccumulateElementTile(const T* data, size_t begin, size_t end,
+                                    FeatureAccumulator& acc) {
+    size_t i = begin;
+    // The first two elements of the block lack one or both neighbours
+    for (; i < end && i < 2; i++) {
+      double x = static_cast<double>(data[i]);
+      acc.sum += x;
+      if (i == 1) {
+        acc.first_deriv_sum += std::abs(x - static_cast<double>(data[0]));
+      }
+    }
+    double sum = 0.0, first = 0.0, second = 0.0;
+#if defined(__AVX512F__)
+    if constexpr (kSimdLoad) {
+      __m512d vsum = _mm512_setzero_pd(), vfirst = vsum, vsecond = vsum;
+      for (; i + 8 <= end; i += 8) {
+        __m512d x = Load8(data + i), prev = Load8(data + i - 1);
+        __m512d prev2 = Load8(data + i - 2);
+        vsum = _mm512_add_pd(vsum, x);
+        vfirst = _mm512_add_pd(vfirst, _mm512_abs_pd(_mm512_sub_pd(x, prev)));
+        __m512d curve = _mm512_add_pd(_mm512_sub_pd(x, _mm512_add_pd(prev, prev)), prev2);
+        vsecond = _mm512_add_pd(vsecond, _mm512_abs_pd(curve));
+      }
+      sum = _mm512_reduce_add_pd(vsum);
+      first = _mm512_reduce_add_pd(vfirst);
+      second = _mm512_reduce_add_pd(vsecond);
+    }
+#elif defined(__AVX2__)
+    if constexpr (kSimdLoad) {
+      const __m256d sign = _mm256_set1_pd(-0.0);
+      __m256d vsum = _mm256_setzero_pd(), vfirst = vsum, vsecond = vsum;
+      for (; i + 4 <= end; i += 4) {
+        __m256d x = Load4(data + i), prev = Load4(data + i - 1);
+        __m256d prev2 = Load4(data + i - 2);
+        vsum = _mm256_add_pd(vsum, x);
+        vfirst = _mm256_add_pd(vfirst, _mm256_andnot_pd(sign, _mm256_sub_pd(x, prev)));
+        __m256d curve = _mm256_add_pd(_mm256_sub_pd(x, _mm256_add_pd(prev, prev)), prev2);
+        vsecond = _mm256_add_pd(vsecond, _mm256_andnot_pd(sign, curve));
+      }
+      sum = HorizontalSum(vsum);
+      first = HorizontalSum(vfirst);
+      second = HorizontalSum(vsecond);
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    if constexpr (kSimdLoad) {
+      float64x2_t vsum = vdupq_n_f64(0.0), vfirst = vsum, vsecond = vsum;
+      for (; i + 2 <= end; i += 2) {
+        float64x2_t x = Load2(data + i), prev = Load2(data + i - 1);
+        float64x2_t prev2 = Load2(data + i - 2);
+        vsum = vaddq_f64(vsum, x);
+        vfirst = vaddq_f64(vfirst, vabsq_f64(vsubq_f64(x, prev)));
+        float64x2_t curve = vaddq_f64(vsubq_f64(x, vaddq_f64(prev, prev)), prev2);
+        vsecond = vaddq_f64(vsecond, vabsq_f64(curve));
+      }
+      sum = vaddvq_f64(vsum);
+      first = vaddvq_f64(vfirst);
+      second = vaddvq_f64(vsecond);
+    }
+#endif
+    for (; i < end; i++) {
+      double x = static_cast<double>(data[i]);
+      double prev = static_cast<double>(data[i - 1]);
+      sum += x;
+      first += std::abs(x - prev);
+      second += std::abs(x - 2.0 * prev + static_cast<double>(data[i - 2]));
+    }
+    acc.sum += sum;
+    acc.first_deriv_sum += first;
+    acc.second_deriv_sum += second;
   }
 };
 
@@ -554,6 +931,30 @@ class DataStatisticsFactory {
     }
   }
 
+  /**
+   * Calculate all features in one read of the data (type-erased)
+   */
+  static CompressionFeatureSet CalculateAllFeatures(const void* data,
+                                                    size_t num_elements,
+                                                    DataType type) {
+    switch (type) {
+      case DataType::UINT8:
+        return DataStatistics<uint8_t>::CalculateAllFeatures(
+            static_cast<const uint8_t*>(data), num_elements);
+      case DataType::INT32:
+        return DataStatistics<int32_t>::CalculateAllFeatures(
+            static_cast<const int32_t*>(data), num_elements);
+      case DataType::FLOAT32:
+        return DataStatistics<float>::CalculateAllFeatures(
+            static_cast<const float*>(data), num_elements);
+      case DataType::DOUBLE64:
+        return DataStatistics<double>::CalculateAllFeatures(
+            static_cast<const double*>(data), num_elements);
+      default:
+        return CompressionFeatureSet();
+    }
+  }
+
   /**
    * Get DataType from string
    */
@@ -656,19 +1057,8 @@ class BlockSampler {
     if (block_size > num_elements) {
       block_size = num_elements;
     }
-
-    // Maximum valid start position for a block
-    size_t max_start = (num_elements > block_size) ? (num_elements - block_size) : 0;
-
-    // Initialize RNG
-    std::mt19937 gen;
-    if (seed == 0) {
-      std::random_device rd;
-      gen.seed(rd());
-    } else {
-      gen.seed(seed);
-    }
-    std::uniform_int_distribution<size_t> dist(0, max_start);
+    std::vector<size_t> starts =
+        PickBlockStarts(num_elements, num_blocks, block_size, seed);
 
     // Storage for per-block statistics
     std::vector<double> block_entropies;
@@ -689,32 +1079,22 @@ class BlockSampler {
     size_t total_byte_samples = 0;
 
     // Sample blocks
-    for (size_t b = 0; b < num_blocks; ++b) {
-      size_t start = dist(gen);
+    for (size_t start : starts) {
       const T* block = data + start;
 
-      // Compute block entropy
-      double entropy = DataStatistics<T>::CalculateShannonEntropy(block, block_size);
-      block_entropies.push_back(entropy);
-
-      // Compute block MAD
-      double mad = DataStatistics<T>::CalculateMAD(block, block_size);
-      block_mads.push_back(mad);
+      // Entropy, MAD, mean and first derivative of the block
+      CompressionFeatureSet features =
+          DataStatistics<T>::CalculateAllFeatures(block, block_size);
+      block_entropies.push_back(features.shannon_entropy);
+      block_mads.push_back(features.mad);
+      block_means.push_back(features.mean);
+      block_derivs.push_back(features.first_derivative);
 
-      // Compute block mean
-      double mean = 0.0;
+      // Track global min/max
       for (size_t i = 0; i < block_size; ++i) {
-        mean += static_cast<double>(block[i]);
-        // Track global min/max
         if (block[i] < global_min) global_min = block[i];
         if (block[i] > global_max) global_max = block[i];
       }
-      mean /= static_cast<double>(block_size);
-      block_means.push_back(mean);
-
-      // Compute block first derivative mean
-      double deriv = DataStatistics<T>::CalculateFirstDerivative(block, block_size);
-      block_derivs.push_back(deriv);
 
       // Add to byte histogram for concentration
       const uint8_t* bytes = reinterpret_cast<const uint8_t*>(block);
@@ -759,7 +1139,78 @@ class BlockSampler {
     return stats;
   }
 
+  /**
+   * Estimate the features of a whole buffer from random blocks
+   *
+   * The blocks are picked as in Sample and read once each. Byte
+   * statistics and the mean cover all sampled bytes; derivatives and runs
+   * are measured within blocks. MAD is taken around the sampled mean.
+   *
+   * @param data Pointer to data buffer
+   * @param num_elements Total number of elements
+   * @param num_blocks Number of blocks to sample (default: 16)
+   * @param block_size Elements per block (default: 4096)
+   * @param seed Random seed (0 = use random device)
+   * @return Estimated features; exact when the blocks cover the buffer
+   */
+  static CompressionFeatureSet SampleFeatures(const T* data, size_t num_elements,
+                                              size_t num_blocks = 16,
+                                              size_t block_size = 4096,
+                                              uint32_t seed = 0) {
+    if (num_elements == 0 || num_blocks == 0 || block_size == 0) {
+      return CompressionFeatureSet();
+    }
+    // Small buffers are cheaper to scan than to sample
+    if (num_blocks * block_size >= num_elements) {
+      return DataStatistics<T>::CalculateAllFeatures(data, num_elements);
+    }
+    std::vector<size_t> starts =
+        PickBlockStarts(num_elements, num_blocks, block_size, seed);
+    typename DataStatistics<T>::FeatureAccumulator acc;
+    for (size_t start : starts) {
+      DataStatistics<T>::AccumulateFeatures(data + start, block_size, acc);
+    }
+    double mean = acc.Mean();
+    for (size_t start : starts) {
+      acc.abs_dev_sum +=
+          DataStatistics<T>::SumAbsDeviation(data + start, block_size, mean);
+    }
+    return acc.Finish();
+  }
+
  private:
+  /**
+   * Pick random block start positions
+   * @param num_elements Total number of elements
+   * @param num_blocks Number of blocks
+   * @param block_size Elements per block (at most num_elements)
+   * @param seed Random seed (0 = use random device)
+   * @return Start index of each block
+   */
+  static std::vector<size_t> PickBlockStarts(size_t num_elements,
+                                             size_t num_blocks,
+                                             size_t block_size,
+                                             uint32_t seed) {
+    // Maximum valid start position for a block
+    size_t max_start = (num_elements > block_size) ? (num_elements - block_size) : 0;
+
+    // Initialize RNG
+    std::mt19937 gen;
+    if (seed == 0) {
+      std::random_device rd;
+      gen.seed(rd());
+    } else {
+      gen.seed(seed);
+    }
+    std::uniform_int_distribution<size_t> dist(0, max_start);
+
+    std::vector<size_t> starts(num_blocks);
+    for (size_t &start : starts) {
+      start = dist(gen);
+    }
+    return starts;
+  }
+
   static double ComputeMean(const std::vector<double>& values) {
     if (values.empty()) return 0.0;
     double sum = 0.0;
@@ -849,6 +1300,34 @@ class BlockSamplerFactory {
         return BlockSamplingStats();
     }
   }
+
+  static CompressionFeatureSet SampleFeatures(const void* data,
+                                              size_t num_elements,
+                                              DataType type,
+                                              size_t num_blocks = 16,
+                                              size_t block_size = 4096,
+                                              uint32_t seed = 0) {
+    switch (type) {
+      case DataType::UINT8:
+        return BlockSampler<uint8_t>::SampleFeatures(
+            static_cast<const uint8_t*>(data), num_elements,
+            num_blocks, block_size, seed);
+      case DataType::INT32:
+        return BlockSampler<int32_t>::SampleFeatures(
+            static_cast<const int32_t*>(data), num_elements,
+            num_blocks, block_size, seed);
+      case DataType::FLOAT32:
+        return BlockSampler<float>::SampleFeatures(
+            static_cast<const float*>(data), num_elements,
+            num_blocks, block_size, seed);
+      case DataType::DOUBLE64:
+        return BlockSampler<double>::SampleFeatures(
+            static_cast<const double*>(data), num_elements,
+            num_blocks, block_size, seed);
+      default:
+        return CompressionFeatureSet();
+    }
+  }
 };
 
 }  // namespace hshm
@@ -45,6 +45,9 @@
 #include <brotli/encode.h>
 #include <brotli/decode.h>
 
+#include <cstdint>
+#include <memory>
+
 #include "compress.h"
 
 namespace hshm {
@@ -66,6 +69,8 @@ enum class LosslessMode {
 class ZlibWithModes : public Compressor {
  private:
   int level_;
+  z_stream stream_;          /**< Deflate state reused across streams */
+  bool stream_init_ = false; /**< Whether stream_ has been initialized */
 
  public:
   explicit ZlibWithModes(LosslessMode mode) {
@@ -82,6 +87,58 @@ class ZlibWithModes : public Compressor {
     }
   }
 
+  ~ZlibWithModes() override {
+    if (stream_init_) {
+      deflateEnd(&stream_);
+    }
+  }
+
+  ZlibWithModes(const ZlibWithModes &) = delete;
+  ZlibWithModes &operator=(const ZlibWithModes &) = delete;
+
+  bool SupportsStreaming() const override { return true; }
+
+  /** Start a deflate stream, resetting the previous one's state */
+  bool BeginStream() override {
+    if (stream_init_) {
+      return deflateReset(&stream_) == Z_OK;
+    }
+    stream_.zalloc = Z_NULL;
+    stream_.zfree = Z_NULL;
+    stream_.opaque = Z_NULL;
+    stream_init_ = deflateInit(&stream_, level_) == Z_OK;
+    return stream_init_;
+  }
+
+  /** Deflate one block without flushing */
+  bool Update(void *output, size_t &output_size, const void *input,
+              size_t input_size) override {
+    stream_.next_in = reinterpret_cast<Bytef *>(const_cast<void *>(input));
+    stream_.avail_in = input_size;
+    stream_.next_out = reinterpret_cast<Bytef *>(output);
+    stream_.avail_out = output_size;
+    while (stream_.avail_in > 0) {
+      if (stream_.avail_out == 0 || deflate(&stream_, Z_NO_FLUSH) != Z_OK) {
+        return false;
+      }
+    }
+    output_size -= stream_.avail_out;
+    return true;
+  }
+
+  /** Flush the deflate stream and write the trailer */
+  bool Finish(void *output, size_t &output_size) override {
+    stream_.next_in = Z_NULL;
+    stream_.avail_in = 0;
+    stream_.next_out = reinterpret_cast<Bytef *>(output);
+    stream_.avail_out = output_size;
+    if (deflate(&stream_, Z_FINISH) != Z_STREAM_END) {
+      return false;
+    }
+    output_size -= stream_.avail_out;
+    return true;
+  }
+
   bool Compress(void *output, size_t &output_size, void *input,
                 size_t input_size) override {
     z_stream stream;
@@ -182,6 +239,20 @@ class Bzip2WithModes : public Compressor {
   }
 };
 
+/** Per-thread zstd compression context reused by one-shot calls */
+inline ZSTD_CCtx *ZstdThreadCCtx() {
+  thread_local std::unique_ptr<ZSTD_CCtx, size_t (*)(ZSTD_CCtx *)> ctx(
+      ZSTD_createCCtx(), ZSTD_freeCCtx);
+  return ctx.get();
+}
+
+/** Per-thread zstd decompression context reused by one-shot calls */
+inline ZSTD_DCtx *ZstdThreadDCtx() {
+  thread_local std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx *)> ctx(
+      ZSTD_createDCtx(), ZSTD_freeDCtx);
+  return ctx.get();
+}
+
 /**
  * ZSTD wrapper with compression level support.
  * Levels: 1 (fast) to 22 (best compression), default is 3
@@ -189,6 +260,7 @@ class Bzip2WithModes : public Compressor {
 class ZstdWithModes : public Compressor {
  private:
   int level_;
+  ZSTD_CCtx *stream_ctx_ = nullptr; /**< Context owned by the open stream */
 
  public:
   explicit ZstdWithModes(LosslessMode mode) {
@@ -205,19 +277,72 @@ class ZstdWithModes : public Compressor {
     }
   }
 
+  ~ZstdWithModes() override { ZSTD_freeCCtx(stream_ctx_); }
+
+  ZstdWithModes(const ZstdWithModes &) = delete;
+  ZstdWithModes &operator=(const ZstdWithModes &) = delete;
+
+  bool SupportsStreaming() const override { return true; }
+
+  /** Start a zstd frame, reusing this compressor's stream context */
+  bool BeginStream() override {
+    if (stream_ctx_ == nullptr) {
+      stream_ctx_ = ZSTD_createCCtx();
+      if (stream_ctx_ == nullptr) {
+        return false;
+      }
+    }
+    ZSTD_CCtx_reset(stream_ctx_, ZSTD_reset_session_only);
+    return !ZSTD_isError(ZSTD_CCtx_setParameter(
+        stream_ctx_, ZSTD_c_compressionLevel, level_));
+  }
+
+  /** Compress one block into the open frame */
+  bool Update(void *output, size_t &output_size, const void *input,
+              size_t input_size) override {
+    ZSTD_inBuffer in = {input, input_size, 0};
+    ZSTD_outBuffer out = {output, output_size, 0};
+    while (in.pos < in.size) {
+      if (out.pos == out.size ||
+          ZSTD_isError(
+              ZSTD_compressStream2(stream_ctx_, &out, &in, ZSTD_e_continue))) {
+        return false;
+      }
+    }
+    output_size = out.pos;
+    return true;
+  }
+
+  /** Flush the open frame and write its epilogue */
+  bool Finish(void *output, size_t &output_size) override {
+    ZSTD_inBuffer in = {nullptr, 0, 0};
+    ZSTD_outBuffer out = {output, output_size, 0};
+    size_t remaining = 0;
+    do {
+      remaining = ZSTD_compressStream2(stream_ctx_, &out, &in, ZSTD_e_end);
+      if (ZSTD_isError(remaining) || (remaining > 0 && out.pos == out.size)) {
+        return false;
+      }
+    } while (remaining > 0);
+    output_size = out.pos;
+    return true;
+  }
+
   bool Compress(void *output, size_t &output_size, void *input,
                 size_t input_size) override {
     if (ZSTD_compressBound(input_size) > output_size) {
       return false;
     }
-    output_size = ZSTD_compress(output, output_size, input, input_size, level_);
-    return output_size != 0;
+    output_size = ZSTD_compressCCtx(ZstdThreadCCtx(), output, output_size, input,
+                                    input_size, level_);
+    return !ZSTD_isError(output_size) && output_size != 0;
   }
 
   bool Decompress(void *output, size_t &output_size, void *input,
                   size_t input_size) override {
-    output_size = ZSTD_decompress(output, output_size, input, input_size);
-    return output_size != 0;
+    output_size = ZSTD_decompressDCtx(ZstdThreadDCtx(), output, output_size,
+                                      input, input_size);
+    return !ZSTD_isError(output_size) && output_size != 0;
   }
 };
 
@@ -229,6 +354,20 @@ class Lz4WithModes : public Compressor {
  private:
   LosslessMode mode_;
 
+  /** Per-thread LZ4 state, so calls skip the state reset allocation */
+  static void *ThreadState() {
+    thread_local std::unique_ptr<uint64_t[]> state(
+        new uint64_t[(LZ4_sizeofState() + 7) / 8]);
+    return state.get();
+  }
+
+  /** Per-thread LZ4 HC state */
+  static void *ThreadStateHC() {
+    thread_local std::unique_ptr<uint64_t[]> state(
+        new uint64_t[(LZ4_sizeofStateHC() + 7) / 8]);
+    return state.get();
+  }
+
  public:
   explicit Lz4WithModes(LosslessMode mode) : mode_(mode) {}
 
@@ -242,18 +381,21 @@ class Lz4WithModes : public Compressor {
     switch (mode_) {
       case LosslessMode::FAST:
         // Fast mode - use default LZ4
-        result = LZ4_compress_default((char *)input, (char *)output,
-                                      (int)input_size, (int)output_size);
+        result = LZ4_compress_fast_extState(ThreadState(), (char *)input,
+                                            (char *)output, (int)input_size,
+                                            (int)output_size, 1);
         break;
       case LosslessMode::BALANCED:
         // Balanced - use HC with moderate level
-        result = LZ4_compress_HC((char *)input, (char *)output,
-                                 (int)input_size, (int)output_size, 6);
+        result = LZ4_compress_HC_extStateHC(ThreadStateHC(), (char *)input,
+                                            (char *)output, (int)input_size,
+                                            (int)output_size, 6);
         break;
       case LosslessMode::BEST:
         // Best - use HC with high level
-        result = LZ4_compress_HC((char *)input, (char *)output,
-                                 (int)input_size, (int)output_size, 12);
+        result = LZ4_compress_HC_extStateHC(ThreadStateHC(), (char *)input,
+                                            (char *)output, (int)input_size,
+                                            (int)output_size, 12);
         break;
     }
 
@@ -276,6 +418,7 @@ class Lz4WithModes : public Compressor {
 class LzmaWithModes : public Compressor {
  private:
   uint32_t preset_;
+  lzma_stream stream_ = LZMA_STREAM_INIT; /**< Encoder reused across streams */
 
  public:
   explicit LzmaWithModes(LosslessMode mode) {
@@ -292,6 +435,47 @@ class LzmaWithModes : public Compressor {
     }
   }
 
+  ~LzmaWithModes() override { lzma_end(&stream_); }
+
+  LzmaWithModes(const LzmaWithModes &) = delete;
+  LzmaWithModes &operator=(const LzmaWithModes &) = delete;
+
+  bool SupportsStreaming() const override { return true; }
+
+  /** Start an xz stream; liblzma reuses the encoder's allocations */
+  bool BeginStream() override {
+    return lzma_easy_encoder(&stream_, preset_, LZMA_CHECK_CRC64) == LZMA_OK;
+  }
+
+  /** Encode one block into the open stream */
+  bool Update(void *output, size_t &output_size, const void *input,
+              size_t input_size) override {
+    stream_.next_in = static_cast<const uint8_t *>(input);
+    stream_.avail_in = input_size;
+    stream_.next_out = static_cast<uint8_t *>(output);
+    stream_.avail_out = output_size;
+    while (stream_.avail_in > 0) {
+      if (stream_.avail_out == 0 || lzma_code(&stream_, LZMA_RUN) != LZMA_OK) {
+        return false;
+      }
+    }
+    output_size -= stream_.avail_out;
+    return true;
+  }
+
+  /** Flush the encoder and write the stream footer */
+  bool Finish(void *output, size_t &output_size) override {
+    stream_.next_in = nullptr;
+    stream_.avail_in = 0;
+    stream_.next_out = static_cast<uint8_t *>(output);
+    stream_.avail_out = output_size;
+    if (lzma_code(&stream_, LZMA_FINISH) != LZMA_STREAM_END) {
+      return false;
+    }
+    output_size -= stream_.avail_out;
+    return true;
+  }
+
   bool Compress(void *output, size_t &output_size, void *input,
                 size_t input_size) override {
     lzma_stream stream = LZMA_STREAM_INIT;
@@ -348,6 +532,7 @@ class LzmaWithModes : public Compressor {
 class BrotliWithModes : public Compressor {
  private:
   int quality_;
+  BrotliEncoderState *stream_ = nullptr; /**< Encoder of the open stream */
 
  public:
   explicit BrotliWithModes(LosslessMode mode) {
@@ -364,6 +549,65 @@ class BrotliWithModes : public Compressor {
     }
   }
 
+  ~BrotliWithModes() override {
+    if (stream_ != nullptr) {
+      BrotliEncoderDestroyInstance(stream_);
+    }
+  }
+
+  BrotliWithModes(const BrotliWithModes &) = delete;
+  BrotliWithModes &operator=(const BrotliWithModes &) = delete;
+
+  bool SupportsStreaming() const override { return true; }
+
+  /** Start a brotli stream; the encoder has no reset, so recreate it */
+  bool BeginStream() override {
+    if (stream_ != nullptr) {
+      BrotliEncoderDestroyInstance(stream_);
+    }
+    stream_ = BrotliEncoderCreateInstance(nullptr, nullptr, nullptr);
+    return stream_ != nullptr &&
+           BrotliEncoderSetParameter(stream_, BROTLI_PARAM_QUALITY,
+                                     quality_) == BROTLI_TRUE;
+  }
+
+  /** Encode one block; output the encoder holds back is kept for later */
+  bool Update(void *output, size_t &output_size, const void *input,
+              size_t input_size) override {
+    ::size_t avail_in = input_size;
+    const uint8_t *next_in = static_cast<const uint8_t *>(input);
+    ::size_t avail_out = output_size;
+    uint8_t *next_out = static_cast<uint8_t *>(output);
+    while (avail_in > 0) {
+      if (avail_out == 0 ||
+          !BrotliEncoderCompressStream(stream_, BROTLI_OPERATION_PROCESS,
+                                       &avail_in, &next_in, &avail_out,
+                                       &next_out, nullptr)) {
+        return false;
+      }
+    }
+    output_size -= avail_out;
+    return true;
+  }
+
+  /** Flush the encoder and close the stream */
+  bool Finish(void *output, size_t &output_size) override {
+    ::size_t avail_in = 0;
+    const uint8_t *next_in = nullptr;
+    ::size_t avail_out = output_size;
+    uint8_t *next_out = static_cast<uint8_t *>(output);
+    while (!BrotliEncoderIsFinished(stream_)) {
+      if (avail_out == 0 ||
+          !BrotliEncoderCompressStream(stream_, BROTLI_OPERATION_FINISH,
+                                       &avail_in, &next_in, &avail_out,
+                                       &next_out, nullptr)) {
+        return false;
+      }
+    }
+    output_size -= avail_out;
+    return true;
+  }
+
   bool Compress(void *output, size_t &output_size, void *input,
                 size_t input_size) override {
     ::size_t encoded_size = output_size;
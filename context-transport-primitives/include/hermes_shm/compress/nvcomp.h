@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HSHM_SHM_INCLUDE_HSHM_SHM_COMPRESS_NVCOMP_H_
+#define HSHM_SHM_INCLUDE_HSHM_SHM_COMPRESS_NVCOMP_H_
+
+#if HSHM_ENABLE_COMPRESS && HSHM_ENABLE_NVCOMP
+
+#include <nvcomp/bitcomp.hpp>
+#include <nvcomp/cascaded.hpp>
+#include <nvcomp/lz4.hpp>
+
+#include <cstdint>
+#include <exception>
+
+#include "compress.h"
+#include "hermes_shm/util/gpu_api.h"
+#include "hermes_shm/util/logging.h"
+
+namespace hshm {
+
+/**
+ * nvCOMP GPU compressor wrapper.
+ *
+ * Buffers may live in device or host memory. Device buffers are used in
+ * place, so data already in HBM is compressed on the GPU and only the
+ * compressed bytes cross PCIe. Host buffers are staged through the device.
+ *
+ * @tparam ManagerT nvcomp::nvcompManagerBase subclass (LZ4Manager, ...)
+ * @tparam OptsT Format options type for ManagerT
+ */
+template <typename ManagerT, typename OptsT>
+class NvcompWithManager : public Compressor {
+ public:
+  /**
+   * Constructor
+   * @param opts nvCOMP format options
+   * @param chunk_size Uncompressed bytes per nvCOMP chunk (default 64KB)
+   */
+  explicit NvcompWithManager(const OptsT &opts, size_t chunk_size = 1 << 16)
+      : opts_(opts), chunk_size_(chunk_size), stream_(GpuApi::CreateStream()) {}
+
+  ~NvcompWithManager() override { GpuApi::DestroyStream(stream_); }
+
+  NvcompWithManager(const NvcompWithManager &) = delete;
+  NvcompWithManager &operator=(const NvcompWithManager &) = delete;
+
+  bool Compress(void *output, size_t &output_size, void *input,
+                size_t input_size) override {
+    if (input_size == 0) return false;
+    uint8_t *d_in = ToDevice(input, input_size);
+    uint8_t *d_out = nullptr;
+    bool ok = false;
+    try {
+      ManagerT manager(chunk_size_, opts_, Stream());
+      nvcomp::CompressionConfig config =
+          manager.configure_compression(input_size);
+      d_out = GpuApi::Malloc<uint8_t>(config.max_compressed_buffer_size);
+      manager.compress(d_in, d_out, config);
+      size_t comp_size = manager.get_compressed_output_size(d_out);
+      GpuApi::Synchronize(stream_);
+      if (comp_size <= output_size) {
+        GpuApi::Memcpy(static_cast<uint8_t *>(output), d_out, comp_size);
+        output_size = comp_size;
+        ok = true;
+      }
+    } catch (const std::exception &e) {
+      HLOG(kError, "nvCOMP compression failed: {}", e.what());
+    }
+    if (d_out) GpuApi::Free(d_out);
+    if (d_in != input) GpuApi::Free(d_in);
+    return ok;
+  }
+
+  bool Decompress(void *output, size_t &output_size, void *input,
+                  size_t input_size) override {
+    if (input_size == 0) return false;
+    uint8_t *d_in = ToDevice(input, input_size);
+    bool out_on_device = GpuApi::IsDevicePointer(output);
+    uint8_t *d_out = nullptr;
+    bool ok = false;
+    try {
+      ManagerT manager(chunk_size_, opts_, Stream());
+      nvcomp::DecompressionConfig config = manager.configure_decompression(d_in);
+      if (config.decomp_data_size <= output_size) {
+        d_out = out_on_device
+                    ? static_cast<uint8_t *>(output)
+                    : GpuApi::Malloc<uint8_t>(config.decomp_data_size);
+        manager.decompress(d_out, d_in, config);
+        GpuApi::Synchronize(stream_);
+        if (!out_on_device) {
+          GpuApi::Memcpy(static_cast<uint8_t *>(output), d_out,
+                         config.decomp_data_size);
+        }
+        output_size = config.decomp_data_size;
+        ok = true;
+      }
+    } catch (const std::exception &e) {
+      HLOG(kError, "nvCOMP decompression failed: {}", e.what());
+    }
+    if (d_out && !out_on_device) GpuApi::Free(d_out);
+    if (d_in != input) GpuApi::Free(d_in);
+    return ok;
+  }
+
+ private:
+  /** Return a device copy of a host buffer, or the buffer itself */
+  static uint8_t *ToDevice(void *ptr, size_t size) {
+    if (GpuApi::IsDevicePointer(ptr)) return static_cast<uint8_t *>(ptr);
+    uint8_t *d_ptr = GpuApi::Malloc<uint8_t>(size);
+    GpuApi::Memcpy(d_ptr, static_cast<uint8_t *>(ptr), size);
+    return d_ptr;
+  }
+
+  cudaStream_t Stream() const { return static_cast<cudaStream_t>(stream_); }
+
+  OptsT opts_;
+  size_t chunk_size_;
+  void *stream_;
+};
+
+/** nvCOMP LZ4: general-purpose lossless */
+class NvcompLz4
+    : public NvcompWithManager<nvcomp::LZ4Manager, nvcompBatchedLZ4Opts_t> {
+ public:
+  NvcompLz4() : NvcompWithManager(nvcompBatchedLZ4DefaultOpts) {}
+};
+
+/** nvCOMP Cascaded: run-length, delta and bit-packing for numeric arrays */
+class NvcompCascaded
+    : public NvcompWithManager<nvcomp::CascadedManager,
+                               nvcompBatchedCascadedOpts_t> {
+ public:
+  NvcompCascaded() : NvcompWithManager(nvcompBatchedCascadedDefaultOpts) {}
+};
+
+/** nvCOMP Bitcomp: lossless for scientific floating-point data */
+class NvcompBitcomp
+    : public NvcompWithManager<nvcomp::BitcompManager,
+                               nvcompBatchedBitcompFormatOpts> {
+ public:
+  NvcompBitcomp() : NvcompWithManager(nvcompBatchedBitcompDefaultOpts) {}
+};
+
+}  // namespace hshm
+
+#endif  // HSHM_ENABLE_COMPRESS && HSHM_ENABLE_NVCOMP
+
+#endif  // HSHM_SHM_INCLUDE_HSHM_SHM_COMPRESS_NVCOMP_H_
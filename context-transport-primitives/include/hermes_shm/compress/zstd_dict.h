@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HSHM_SHM_INCLUDE_HSHM_SHM_COMPRESS_ZSTD_DICT_H_
+#define HSHM_SHM_INCLUDE_HSHM_SHM_COMPRESS_ZSTD_DICT_H_
+
+#if HSHM_ENABLE_COMPRESS
+
+#include <zdict.h>
+#include <zstd.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "compress.h"
+#include "lossless_modes.h"
+
+namespace hshm {
+
+/**
+ * A trained zstd dictionary.
+ *
+ * Small, similar payloads (JSON records, KV cache headers) compress
+ * poorly on their own because each one starts with an empty window. A
+ * dictionary trained on samples of them primes the window. The digested
+ * decompression dictionary is built once; compression dictionaries are
+ * built once per level on first use.
+ */
+class ZstdDictionary {
+ public:
+  /**
+   * Train a dictionary from samples.
+   *
+   * @param samples Sample payloads, concatenated
+   * @param sample_sizes Size of each sample in samples
+   * @param max_dict_size Upper bound on the dictionary size in bytes
+   * @return The dictionary, or nullptr if training failed (e.g., too few
+   *         or too random samples)
+   */
+  static std::shared_ptr<ZstdDictionary> Train(
+      const std::vector<char> &samples, const std::vector<size_t> &sample_sizes,
+      size_t max_dict_size) {
+    if (sample_sizes.empty() || max_dict_size == 0) {
+      return nullptr;
+    }
+    std::vector<char> dict(max_dict_size);
+    size_t dict_size = ZDICT_trainFromBuffer(
+        dict.data(), dict.size(), samples.data(), sample_sizes.data(),
+        static_cast<unsigned>(sample_sizes.size()));
+    if (ZDICT_isError(dict_size)) {
+      return nullptr;
+    }
+    dict.resize(dict_size);
+    return Load(dict.data(), dict.size());
+  }
+
+  /**
+   * Load a dictionary from its serialized bytes.
+   *
+   * @param data Dictionary bytes, as returned by Data()
+   * @param size Number of bytes
+   * @return The dictionary, or nullptr if data is not a zstd dictionary
+   */
+  static std::shared_ptr<ZstdDictionary> Load(const void *data, size_t size) {
+    uint32_t id = ZDICT_getDictID(data, size);
+    if (id == 0) {
+      return nullptr;
+    }
+    const char *bytes = static_cast<const char *>(data);
+    auto dict = std::shared_ptr<ZstdDictionary>(
+        new ZstdDictionary(std::vector<char>(bytes, bytes + size), id));
+    if (dict->ddict_ == nullptr) {
+      return nullptr;
+    }
+    return dict;
+  }
+
+  ~ZstdDictionary() {
+    for (auto &[level, cdict] : cdicts_) {
+      ZSTD_freeCDict(cdict);
+    }
+    ZSTD_freeDDict(ddict_);
+  }
+
+  ZstdDictionary(const ZstdDictionary &) = delete;
+  ZstdDictionary &operator=(const ZstdDictionary &) = delete;
+
+  /** ID zstd stores in each frame compressed with this dictionary */
+  uint32_t Id() const { return id_; }
+
+  /** Serialized dictionary bytes, for storing and reloading it */
+  const std::vector<char> &Data() const { return data_; }
+
+  /**
+   * Get the digested compression dictionary for a level.
+   *
+   * @param level zstd compression level
+   * @return Compression dictionary owned by this object, or nullptr
+   */
+  const ZSTD_CDict *GetCDict(int level) const {
+    std::lock_guard<std::mutex> lock(cdict_lock_);
+    auto it = cdicts_.find(level);
+    if (it == cdicts_.end()) {
+      ZSTD_CDict *cdict = ZSTD_createCDict(data_.data(), data_.size(), level);
+      if (cdict == nullptr) {
+        return nullptr;
+      }
+      it = cdicts_.emplace(level, cdict).first;
+    }
+    return it->second;
+  }
+
+  /** Digested decompression dictionary */
+  const ZSTD_DDict *GetDDict() const { return ddict_; }
+
+ private:
+  ZstdDictionary(std::vector<char> data, uint32_t id)
+      : data_(std::move(data)),
+        id_(id),
+        ddict_(ZSTD_createDDict(data_.data(), data_.size())) {}
+
+  std::vector<char> data_; /**< Serialized dictionary */
+  uint32_t id_;            /**< Dictionary ID */
+  ZSTD_DDict *ddict_;      /**< Digested decompression dictionary */
+  mutable std::mutex cdict_lock_; /**< Guards cdicts_ */
+  mutable std::unordered_map<int, ZSTD_CDict *> cdicts_; /**< By level */
+};
+
+/**
+ * ZSTD with a trained dictionary.
+ * Uses the same levels as ZstdWithModes and its per-thread contexts.
+ */
+class ZstdDictCompressor : public Compressor {
+ private:
+  std::shared_ptr<const ZstdDictionary> dict_;
+  int level_;
+
+ public:
+  ZstdDictCompressor(std::shared_ptr<const ZstdDictionary> dict,
+                     LosslessMode mode)
+      : dict_(std::move(dict)) {
+    switch (mode) {
+      case LosslessMode::FAST:
+        level_ = 1;
+        break;
+      case LosslessMode::BALANCED:
+        level_ = 3;
+        break;
+      case LosslessMode::BEST:
+        level_ = 19;
+        break;
+    }
+  }
+
+  bool Compress(void *output, size_t &output_size, void *input,
+                size_t input_size) override {
+    const ZSTD_CDict *cdict = dict_->GetCDict(level_);
+    if (cdict == nullptr || ZSTD_compressBound(input_size) > output_size) {
+      return false;
+    }
+    output_size = ZSTD_compress_usingCDict(ZstdThreadCCtx(), output,
+                                           output_size, input, input_size,
+                                           cdict);
+    return !ZSTD_isError(output_size) && output_size != 0;
+  }
+
+  bool Decompress(void *output, size_t &output_size, void *input,
+                  size_t input_size) override {
+    output_size = ZSTD_decompress_usingDDict(ZstdThreadDCtx(), output,
+                                             output_size, input, input_size,
+                                             dict_->GetDDict());
+    return !ZSTD_isError(output_size) && output_size != 0;
+  }
+};
+
+}  // namespace hshm
+
+#endif  // HSHM_ENABLE_COMPRESS
+
+#endif  // HSHM_SHM_INCLUDE_HSHM_SHM_COMPRESS_ZSTD_DICT_H_
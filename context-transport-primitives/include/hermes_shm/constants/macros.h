@@ -42,6 +42,11 @@
 #define HSHM_IS_CUDA_GPU
 #endif
 
+/** CUDA device code for compute capability 7.0 (Volta) or newer */
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 700
+#define HSHM_CUDA_ARCH_GE_700
+#endif
+
 /** Function content selector for ROCm */
 #if __HIP_DEVICE_COMPILE__
 #define HSHM_IS_ROCM_GPU
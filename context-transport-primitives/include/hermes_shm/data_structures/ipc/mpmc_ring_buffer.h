@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HSHM_DATA_STRUCTURES_IPC_MPMC_RING_BUFFER_H_
+#define HSHM_DATA_STRUCTURES_IPC_MPMC_RING_BUFFER_H_
+
+#include "hermes_shm/constants/macros.h"
+#include "hermes_shm/data_structures/ipc/shm_container.h"
+#include "hermes_shm/data_structures/ipc/vector.h"
+#include "hermes_shm/memory/allocator/allocator.h"
+#include "hermes_shm/types/atomic.h"
+
+namespace hshm::ipc {
+
+/** Cache line size used to pad MPMC ring cells and counters */
+static constexpr size_t kMpmcCacheLine = 64;
+
+/** Sequence number and payload of an MPMC ring cell */
+template <typename T>
+struct MpmcRingCellBody {
+  hipc::atomic<u64> seq_; /**< Per-slot sequence number */
+  T data_;                /**< The actual data */
+
+  HSHM_INLINE_CROSS_FUN
+  MpmcRingCellBody() : seq_(0) {}
+};
+
+/**
+ * MPMC ring cell: a sequence number plus the payload.
+ *
+ * seq == pos        slot is free for the producer claiming position pos
+ * seq == pos + 1    slot holds the element written at position pos
+ *
+ * Cells are padded to a whole number of cache lines so neighbouring
+ * producers and consumers do not false-share. Padding is explicit rather
+ * than alignas because shared-memory allocators only guarantee 8-byte
+ * alignment.
+ *
+ * @tparam T The type of data to store in the cell
+ */
+template <typename T>
+struct MpmcRingCell : public MpmcRingCellBody<T> {
+  char pad_[kMpmcCacheLine - sizeof(MpmcRingCellBody<T>) % kMpmcCacheLine];
+};
+
+/**
+ * Bounded multi-producer multi-consumer ring buffer for shared memory.
+ *
+ * Vyukov-style queue: each slot carries a sequence number, producers and
+ * consumers each claim a position with a CAS on their own counter, and the
+ * slot's sequence number hands the element from one side to the other. No
+ * slot is reserved and there is no separate ready flag. Push and Pop never
+ * block: they return false when the ring is full or empty.
+ *
+ * The capacity is rounded up to a power of two. The producer and consumer
+ * counters live on separate cache lines. Storage is a hipc::vector, so the
+ * ring is process-independent and usable from GPU code (device-scope
+ * visibility; CPU-GPU rings should keep using ring_buffer's System calls).
+ *
+ * @tparam T The element type to store in the buffer
+ * @tparam AllocT The allocator type for shared memory allocation
+ */
+template <typename T, typename AllocT = hipc::Allocator>
+class mpmc_ring_buffer : public ShmContainer<AllocT> {
+ public:
+  using allocator_type = AllocT;
+  using value_type = T;
+  using size_type = size_t;
+  using cell_type = MpmcRingCell<T>;
+  using cell_vector = vector<cell_type, AllocT>;
+
+ private:
+  cell_vector cells_; /**< Slot storage (power-of-two length) */
+  u64 mask_;          /**< cells_.size() - 1 */
+  // Producer and consumer counters sit on their own cache lines
+  char pad0_[kMpmcCacheLine];
+  hipc::atomic<u64> tail_; /**< Next push position */
+  char pad1_[kMpmcCacheLine - sizeof(hipc::atomic<u64>)];
+  hipc::atomic<u64> head_; /**< Next pop position */
+  char pad2_[kMpmcCacheLine - sizeof(hipc::atomic<u64>)];
+
+ public:
+  /**
+   * Calculate exact size needed for an mpmc_ring_buffer with given depth
+   *
+   * @param depth The queue depth (rounded up to a power of two)
+   * @return Size in bytes needed to allocate this ring buffer
+   */
+  static size_t CalculateSize(size_t depth) {
+    return sizeof(mpmc_ring_buffer) + RoundDepth(depth) * sizeof(cell_type);
+  }
+
+  /**
+   * Constructor
+   *
+   * @param alloc The allocator to use for memory allocation
+   * @param depth Minimum capacity (rounded up to a power of two)
+   */
+  HSHM_CROSS_FUN
+  explicit mpmc_ring_buffer(AllocT *alloc, size_t depth = 1024)
+      : ShmContainer<AllocT>(alloc),
+        cells_(alloc, RoundDepth(depth)),
+        mask_(RoundDepth(depth) - 1),
+        tail_(0),
+        head_(0) {
+    for (u64 i = 0; i <= mask_; ++i) {
+      cells_[i].seq_.store(i);
+    }
+  }
+
+  /** Copying would split in-flight positions between two rings */
+  mpmc_ring_buffer(const mpmc_ring_buffer &other) = delete;
+  mpmc_ring_buffer(mpmc_ring_buffer &&other) noexcept = delete;
+
+  /**
+   * Push an element
+   *
+   * @param val The value to push
+   * @return True if pushed, false if the ring is full
+   */
+  HSHM_CROSS_FUN
+  bool Push(const T &val) {
+    u64 pos = tail_.load();
+    cell_type *cell;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      u64 seq = cell->seq_.load();
+      i64 diff = static_cast<i64>(seq - pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1,
+                                         std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = tail_.load();
+      }
+    }
+    cell->data_ = val;
+    // Publish data_ before the sequence number hands the slot to consumers
+    hipc::threadfence();
+    cell->seq_.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Try to push an element (alias for Push)
+   *
+   * @param val The value to push
+   * @return True if pushed, false if the ring is full
+   */
+  HSHM_INLINE_CROSS_FUN
+  bool TryPush(const T &val) { return Push(val); }
+
+  /**
+   * Pop an element
+   *
+   * @param val Reference to store the popped value
+   * @return True if popped, false if the ring is empty
+   */
+  HSHM_CROSS_FUN
+  bool Pop(T &val) {
+    u64 pos = head_.load();
+    cell_type *cell;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      u64 seq = cell->seq_.load();
+      i64 diff = static_cast<i64>(seq - (pos + 1));
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1,
+                                         std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = head_.load();
+      }
+    }
+    // GPU: keep the data_ read behind the sequence check
+    hipc::threadfence();
+    val = cell->data_;
+    // Release the slot to the producer one lap ahead
+    hipc::threadfence();
+    cell->seq_.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Try to pop an element (alias for Pop)
+   *
+   * @param val Reference to store the popped value
+   * @return True if popped, false if the ring is empty
+   */
+  HSHM_INLINE_CROSS_FUN
+  bool TryPop(T &val) { return Pop(val); }
+
+  /**
+   * Approximate number of elements (exact when quiescent)
+   *
+   * @return Number of items currently in the buffer
+   */
+  HSHM_INLINE_CROSS_FUN
+  size_t Size() const {
+    u64 head = head_.load();
+    u64 tail = tail_.load();
+    return tail > head ? static_cast<size_t>(tail - head) : 0;
+  }
+
+  /** Check if buffer is empty (approximate under concurrency) */
+  HSHM_INLINE_CROSS_FUN
+  bool Empty() const { return Size() == 0; }
+
+  /** Check if buffer is full (approximate under concurrency) */
+  HSHM_INLINE_CROSS_FUN
+  bool Full() const { return Size() >= Capacity(); }
+
+  /** Maximum number of items the buffer can hold */
+  HSHM_INLINE_CROSS_FUN
+  size_t Capacity() const { return static_cast<size_t>(mask_ + 1); }
+
+ private:
+  /** Round a requested depth up to a power of two (minimum 2) */
+  HSHM_INLINE_CROSS_FUN
+  static size_t RoundDepth(size_t depth) {
+    size_t cap = 2;
+    while (cap < depth) {
+      cap <<= 1;
+    }
+    return cap;
+  }
+};
+
+}  // namespace hshm::ipc
+
+#endif  // HSHM_DATA_STRUCTURES_IPC_MPMC_RING_BUFFER_H_
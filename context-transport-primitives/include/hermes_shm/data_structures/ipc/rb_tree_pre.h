@@ -340,6 +340,35 @@ class rb_tree {
     return FullPtr<NodeT>(alloc, node_off);
   }
 
+  /**
+   * Find the node with the smallest key that is not less than key
+   *
+   * @param alloc Allocator for address translation
+   * @param key Lower bound to search for
+   * @return FullPtr to the node, or null if every key is smaller
+   */
+  template<typename AllocT>
+  HSHM_CROSS_FUN
+  FullPtr<NodeT> lower_bound(AllocT *alloc, const KeyT &key) const {
+    OffsetPtr<NodeT> curr_off = root_;
+    OffsetPtr<NodeT> best_off = OffsetPtr<NodeT>::GetNull();
+
+    while (!curr_off.IsNull()) {
+      FullPtr<NodeT> curr(alloc, curr_off);
+      if (curr.ptr_->key < key) {
+        curr_off = OffsetPtr<NodeT>(curr.ptr_->right_);
+      } else {
+        best_off = curr_off;
+        curr_off = OffsetPtr<NodeT>(curr.ptr_->left_);
+      }
+    }
+
+    if (best_off.IsNull()) {
+      return FullPtr<NodeT>::GetNull();
+    }
+    return FullPtr<NodeT>(alloc, best_off);
+  }
+
  private:
   /**
    * Find node by key (internal helper)
@@ -475,6 +475,89 @@ class ring_buffer : public ShmContainer<AllocT> {
     return true;
   }
 
+  /**
+   * Push several elements with a single tail update.
+   *
+   * The tail is the doorbell a consumer polls. Advancing it once for the
+   * whole batch costs one PCIe transaction when the consumer is a GPU
+   * polling pinned host memory, instead of one per element. The data
+   * writes share one system-scope fence ahead of the ready flags.
+   *
+   * DynamicSize rings do not grow here, just as Push does not: a batch
+   * that does not fit is refused and the ring is left unchanged.
+   *
+   * @param vals Elements to push
+   * @param count Number of elements; at most Capacity()
+   * @return count, or 0 if nothing was pushed (count out of range, or no
+   * room for the whole batch when using ErrorOnNoSpace or DynamicSize)
+   */
+  HSHM_CROSS_FUN
+  size_t PushBatch(const T* vals, size_t count) {
+    if (count == 0 || count > Capacity()) {
+      return 0;
+    }
+    u64 head = head_.load_system();
+    u64 tail = tail_.fetch_add_system(count);
+    entry_vector& queue = queue_;
+
+    if constexpr (WaitForSpace) {
+      while (tail - head + count >= queue.size()) {
+        head = head_.load_system();
+      }
+    } else if constexpr (ErrorOnNoSpace || DynamicSize) {
+      if (tail - head + count >= queue.size()) {
+        // Same scope as the reservation: the peer may be on the GPU
+        tail_.fetch_sub_system(count);
+        return 0;
+      }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+      queue[(tail + i) % queue.size()].data_ = vals[i];
+    }
+    hshm::ipc::threadfence_system();
+    for (size_t i = 0; i < count; ++i) {
+      queue[(tail + i) % queue.size()].SetReadySystem();
+    }
+    return count;
+  }
+
+  /**
+   * Pop up to max_count elements with a single head update.
+   *
+   * Head and tail are read once and the new head is published with one
+   * store, so draining a batch from pinned host memory costs a few PCIe
+   * transactions instead of several per element. Stops at the first
+   * entry whose producer has not finished writing it.
+   *
+   * Only one consumer may use a ring this way: entries are claimed with
+   * plain stores rather than the compare-exchange Pop uses to arbitrate
+   * between consumers.
+   *
+   * @param vals Output array with room for max_count elements
+   * @param max_count Most elements to pop
+   * @return Number of elements popped
+   */
+  HSHM_CROSS_FUN
+  size_t PopBatch(T* vals, size_t max_count) {
+    u64 head = head_.load_system();
+    u64 tail = tail_.load_system();
+    size_t count = 0;
+    while (count < max_count && head + count < tail) {
+      entry_type& entry = queue_[(head + count) % queue_.size()];
+      if (!entry.IsReadySystem()) {
+        break;
+      }
+      vals[count] = entry.data_;
+      entry.flags_.bits_.store_system(0u);
+      ++count;
+    }
+    if (count > 0) {
+      head_.store_system(head + count);
+    }
+    return count;
+  }
+
   /**
    * Try to push an element (alias for Push)
    *
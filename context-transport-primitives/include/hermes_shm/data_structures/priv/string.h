@@ -681,6 +681,45 @@ class basic_string {
     return data_;
   }
 
+  /**
+   * Find a needle of len > 0 characters at or after pos.
+   * On the host, char strings jump between candidates with memchr on the
+   * first character instead of comparing at every position.
+   *
+   * @param s Needle
+   * @param len Needle length (pos + len <= size_)
+   * @param pos Starting position
+   * @return Position of the needle, or npos if not found
+   */
+  HSHM_CROSS_FUN
+  size_type FindRange(const T* s, size_type len, size_type pos) const {
+    const T* data = GetData();
+    size_type last = size_ - len;
+#if HSHM_IS_HOST
+    if constexpr (sizeof(T) == 1) {
+      while (pos <= last) {
+        const void* hit = ::memchr(data + pos, static_cast<unsigned char>(s[0]),
+                                   last - pos + 1);
+        if (!hit) {
+          return npos;
+        }
+        pos = static_cast<const T*>(hit) - data;
+        if (::memcmp(data + pos + 1, s + 1, len - 1) == 0) {
+          return pos;
+        }
+        ++pos;
+      }
+      return npos;
+    }
+#endif
+    for (size_type i = pos; i <= last; ++i) {
+      if (hshm_memcmp(&data[i], s, len * sizeof(T)) == 0) {
+        return i;
+      }
+    }
+    return npos;
+  }
+
   /**
    * Allocate a heap buffer of the given capacity (in elements) from the
    * custom allocator. Sets data_, storage_.heap_.capacity_, and
@@ -1947,13 +1986,7 @@ class basic_string {
       return npos;
     }
 
-    const T* data = GetData();
-    for (size_type i = pos; i <= size_ - str.size_; ++i) {
-      if (hshm_memcmp(&data[i], str.GetData(), str.size_ * sizeof(T)) == 0) {
-        return i;
-      }
-    }
-    return npos;
+    return FindRange(str.GetData(), str.size_, pos);
   }
 
   /**
@@ -1970,6 +2003,13 @@ class basic_string {
     }
 
     const T* data = GetData();
+#if HSHM_IS_HOST
+    if constexpr (sizeof(T) == 1) {
+      const void* hit = ::memchr(data + pos, static_cast<unsigned char>(c),
+                                 size_ - pos);
+      return hit ? static_cast<const T*>(hit) - data : npos;
+    }
+#endif
     for (size_type i = pos; i < size_; ++i) {
       if (data[i] == c) {
         return i;
@@ -1999,13 +2039,7 @@ class basic_string {
       return npos;
     }
 
-    const T* data = GetData();
-    for (size_type i = pos; i <= size_ - s_len; ++i) {
-      if (hshm_memcmp(&data[i], s, s_len * sizeof(T)) == 0) {
-        return i;
-      }
-    }
-    return npos;
+    return FindRange(s, s_len, pos);
   }
 
   /**
@@ -2344,19 +2378,13 @@ using string = basic_string<char, AllocT, SSOSize>;
 
 namespace hshm {
 
-/** FNV-1a hash specialization for priv::string */
+/** HashBytes specialization for priv::string (matches hash<std::string>) */
 template <typename AllocT, size_t SSOSize>
 struct hash<hshm::priv::basic_string<char, AllocT, SSOSize>> {
   HSHM_INLINE_CROSS_FUN
   std::size_t operator()(
       const hshm::priv::basic_string<char, AllocT, SSOSize> &s) const {
-    std::size_t h = 14695981039346656037ULL;
-    const char *data = s.data();
-    for (std::size_t i = 0; i < s.size(); ++i) {
-      h ^= static_cast<std::size_t>(static_cast<unsigned char>(data[i]));
-      h *= 1099511628211ULL;
-    }
-    return h;
+    return static_cast<std::size_t>(HashBytes(s.data(), s.size()));
   }
 };
 
@@ -37,7 +37,7 @@
 #include "hermes_shm/data_structures/priv/vector.h"
 #include "hermes_shm/types/hash.h"
 #include "hermes_shm/memory/allocator/malloc_allocator.h"
-#include "hermes_shm/thread/lock/mutex.h"
+#include "hermes_shm/thread/lock/rwlock.h"
 
 namespace hshm::priv {
 
@@ -51,10 +51,25 @@ struct InsertResult {
 /**
  * GPU-compatible unordered map using open addressing with linear probing.
  *
- * Backed by a single priv::vector of slots. Each slot is either empty,
- * occupied, or a tombstone. Uses fine-grained stripe locking: the slot
- * space is divided into num_locks stripes, each protected by its own
- * Mutex. Operations on different stripes proceed in parallel.
+ * Keys are partitioned by hash into num_locks stripes. Each stripe is an
+ * independent open-addressing table protected by its own RwLock, so
+ * operations on different stripes never touch the same slots and proceed
+ * in parallel. find() takes the stripe lock shared when the stripe is not
+ * migrating, so lookups of hot keys (e.g. GPU warps resolving the same
+ * tag) do not serialize behind each other.
+ *
+ * Each slot's control word holds its state plus a 31-bit tag of the key's
+ * hash. Probes compare keys only when the tag matches, and slots move
+ * between tables without rehashing their keys.
+ *
+ * Growth is incremental and per stripe. When a stripe passes 75% load it
+ * allocates a table twice as large and keeps the old one alongside it.
+ * Every later operation on that stripe migrates a few old slots until the
+ * old table is empty, so no operation ever copies a whole table. Lookups
+ * during a migration check the new table first, then the old one.
+ *
+ * Value pointers and references returned by the map stay valid until the
+ * entry is erased or its stripe next grows.
  *
  * @tparam Key      Key type (must support copy/move and operator==)
  * @tparam T        Mapped value type
@@ -76,9 +91,13 @@ class unordered_map_ll {
 
  private:
   static constexpr uint32_t kEmpty = 0;
-  static constexpr uint32_t kOccupied = 1;
-  static constexpr uint32_t kTombstone = 2;
+  static constexpr uint32_t kTombstone = 1;
+  /** Occupied slots store kOccupied | 31-bit hash tag */
+  static constexpr uint32_t kOccupied = 0x80000000u;
+  static constexpr uint32_t kTagMask = 0x7FFFFFFFu;
   static constexpr size_type kDefaultNumLocks = 64;
+  /** Old-table slots migrated by each operation on a growing stripe */
+  static constexpr size_type kMigrateBatch = 8;
 
   struct Slot {
     uint32_t state_;
@@ -98,12 +117,59 @@ class unordered_map_ll {
     }
   };
 
-  vector<Slot, AllocT> slots_;
+  using slot_vector = vector<Slot, AllocT, 1>;
+
+  /** One independently locked table (plus the table it is draining) */
+  struct Stripe {
+    hshm::RwLock lock_;
+    slot_vector slots_;      /**< Active table; all inserts land here */
+    slot_vector old_slots_;  /**< Table being migrated (empty if none) */
+    size_type live_;         /**< Entries in slots_ and old_slots_ */
+    size_type filled_;       /**< Occupied + tombstone slots in slots_ */
+    size_type old_live_;     /**< Entries still in old_slots_ */
+    size_type migrate_pos_;  /**< Next old_slots_ index to migrate */
+
+    HSHM_CROSS_FUN Stripe()
+        : live_(0), filled_(0), old_live_(0), migrate_pos_(0) {}
+    HSHM_CROSS_FUN Stripe(const Stripe &o)
+        : lock_(),
+          slots_(o.slots_),
+          old_slots_(o.old_slots_),
+          live_(o.live_),
+          filled_(o.filled_),
+          old_live_(o.old_live_),
+          migrate_pos_(o.migrate_pos_) {
+      lock_.Init();
+    }
+    HSHM_CROSS_FUN Stripe(Stripe &&o) noexcept
+        : lock_(),
+          slots_(static_cast<slot_vector &&>(o.slots_)),
+          old_slots_(static_cast<slot_vector &&>(o.old_slots_)),
+          live_(o.live_),
+          filled_(o.filled_),
+          old_live_(o.old_live_),
+          migrate_pos_(o.migrate_pos_) {
+      lock_.Init();
+    }
+    HSHM_CROSS_FUN Stripe &operator=(Stripe &&o) noexcept {
+      if (this != &o) {
+        slots_ = static_cast<slot_vector &&>(o.slots_);
+        old_slots_ = static_cast<slot_vector &&>(o.old_slots_);
+        live_ = o.live_;
+        filled_ = o.filled_;
+        old_live_ = o.old_live_;
+        migrate_pos_ = o.migrate_pos_;
+      }
+      return *this;
+    }
+  };
+
+  vector<Stripe, AllocT> stripes_;
   hshm::ipc::atomic<size_type> size_;
+  hshm::ipc::atomic<size_type> capacity_;
   AllocT *alloc_;
   Hash hash_fn_;
   KeyEqual key_eq_;
-  vector<hshm::Mutex, AllocT> locks_;
   size_type num_locks_;
 
   /** Get the stripe index for a hash value */
@@ -112,86 +178,234 @@ class unordered_map_ll {
     return h % num_locks_;
   }
 
+  /** Get the in-stripe tag for a hash value. Bits that chose the stripe
+   *  are divided out so slots within a stripe stay evenly used. */
+  HSHM_INLINE_CROSS_FUN
+  uint32_t tag_of(size_type h) const {
+    uint64_t local = static_cast<uint64_t>(h / num_locks_);
+    return static_cast<uint32_t>(local ^ (local >> 31)) & kTagMask;
+  }
+
+  /** Check whether a control word marks an occupied slot */
+  HSHM_INLINE_CROSS_FUN
+  static bool is_occupied(uint32_t state) {
+    return (state & kOccupied) != 0;
+  }
+
+  /** Advance a probe index with wrap-around */
+  HSHM_INLINE_CROSS_FUN
+  static size_type next_idx(size_type idx, size_type cap) {
+    return (idx + 1 == cap) ? 0 : idx + 1;
+  }
+
   /** Lock a stripe */
   HSHM_INLINE_CROSS_FUN
   void lock_stripe(size_type stripe) {
-    locks_[stripe].Lock(0);
+    stripes_[stripe].lock_.WriteLock(0);
   }
 
   /** Unlock a stripe */
   HSHM_INLINE_CROSS_FUN
   void unlock_stripe(size_type stripe) {
-    locks_[stripe].Unlock();
+    stripes_[stripe].lock_.WriteUnlock();
   }
 
-  /** Lock all stripes (for rehash/clear/for_each) */
+  /** Get the stripe owning a key */
   HSHM_INLINE_CROSS_FUN
-  void lock_all() {
-    for (size_type i = 0; i < num_locks_; ++i) {
-      locks_[i].Lock(0);
+  Stripe &stripe_for(size_type h) {
+    return stripes_[stripe_of(h)];
+  }
+
+  /**
+   * Find a key in one table (returns tbl.size() if not found).
+   * Slots below skip were already migrated and are jumped over. Every
+   * slot at or above skip is unchanged since the table stopped taking
+   * inserts, so stopping at an empty slot there is still correct.
+   */
+  HSHM_CROSS_FUN
+  size_type probe(const slot_vector &tbl, const Key &key, uint32_t tag,
+                  size_type skip) const {
+    size_type cap = tbl.size();
+    if (cap == 0) return cap;
+    uint32_t want = kOccupied | tag;
+    size_type idx = tag % cap;
+    size_type probed = 0;
+    while (probed < cap) {
+      if (idx < skip) {
+        probed += skip - idx;
+        idx = skip;
+        continue;
+      }
+      uint32_t state = tbl[idx].state_;
+      if (state == kEmpty) return cap;
+      if (state == want && key_eq_(tbl[idx].key_, key)) return idx;
+      ++probed;
+      idx = next_idx(idx, cap);
     }
+    return cap;
   }
 
-  /** Unlock all stripes */
+  /** Find the first non-occupied slot on the probe path for tag in the
+   *  active table. The caller guarantees one exists. */
   HSHM_INLINE_CROSS_FUN
-  void unlock_all() {
-    for (size_type i = 0; i < num_locks_; ++i) {
-      locks_[i].Unlock();
+  size_type free_slot(const slot_vector &tbl, uint32_t tag) const {
+    size_type cap = tbl.size();
+    size_type idx = tag % cap;
+    while (is_occupied(tbl[idx].state_)) {
+      idx = next_idx(idx, cap);
     }
+    return idx;
   }
 
-  /** Find the slot index for a key (returns capacity if not found).
-   *  Caller must hold the appropriate stripe lock. */
-  HSHM_INLINE_CROSS_FUN
-  size_type find_slot(const Key &key) const {
-    size_type cap = slots_.size();
-    if (cap == 0) return cap;
-    size_type h = hash_fn_(key) % cap;
-    for (size_type i = 0; i < cap; ++i) {
-      size_type idx = (h + i) % cap;
-      if (slots_[idx].state_ == kEmpty) return cap;
-      if (slots_[idx].state_ == kOccupied && key_eq_(slots_[idx].key_, key)) {
-        return idx;
-      }
+  /** Move an occupied slot into stripe s's active table. The source
+   *  becomes left_behind (kEmpty for sequential migration, kTombstone
+   *  when pulled out of the middle of a probe chain). */
+  HSHM_CROSS_FUN
+  size_type move_to_active(Stripe &s, Slot &src, uint32_t left_behind) {
+    size_type idx = free_slot(s.slots_, src.state_ & kTagMask);
+    Slot &dst = s.slots_[idx];
+    if (dst.state_ == kEmpty) {
+      ++s.filled_;
     }
-    return cap;
+    dst.state_ = src.state_;
+    dst.key_ = static_cast<Key &&>(src.key_);
+    dst.value_ = static_cast<T &&>(src.value_);
+    src.state_ = left_behind;
+    src.key_ = Key();
+    src.value_ = T();
+    --s.old_live_;
+    return idx;
   }
 
-  /** Find the first available slot (empty or tombstone) for insertion.
-   *  Caller must hold the appropriate stripe lock. */
+  /** Release stripe s's old table once it holds no entries */
   HSHM_INLINE_CROSS_FUN
-  void find_insert_slot(const Key &key, size_type &out_idx,
-                        bool &out_existing) const {
-    size_type cap = slots_.size();
-    size_type h = hash_fn_(key) % cap;
-    size_type first_avail = cap;
-    out_existing = false;
-    out_idx = cap;
-    for (size_type i = 0; i < cap; ++i) {
-      size_type idx = (h + i) % cap;
-      if (slots_[idx].state_ == kOccupied && key_eq_(slots_[idx].key_, key)) {
-        out_idx = idx;
-        out_existing = true;
-        return;
-      }
-      if (slots_[idx].state_ != kOccupied && first_avail == cap) {
-        first_avail = idx;
-      }
-      if (slots_[idx].state_ == kEmpty) {
-        break;
+  void maybe_finish_migration(Stripe &s) {
+    if (s.old_live_ == 0 && s.old_slots_.size() != 0) {
+      s.old_slots_ = slot_vector(alloc_);
+      s.migrate_pos_ = 0;
+    }
+  }
+
+  /** Migrate up to batch old-table slots of stripe s. Caller holds s. */
+  HSHM_CROSS_FUN
+  void migrate_step(Stripe &s, size_type batch) {
+    size_type old_cap = s.old_slots_.size();
+    if (old_cap == 0) return;
+    size_type end = s.migrate_pos_ + batch;
+    if (end > old_cap) end = old_cap;
+    for (; s.migrate_pos_ < end && s.old_live_ > 0; ++s.migrate_pos_) {
+      Slot &src = s.old_slots_[s.migrate_pos_];
+      if (is_occupied(src.state_)) {
+        move_to_active(s, src, kEmpty);
       }
     }
-    out_idx = first_avail;
+    maybe_finish_migration(s);
+  }
+
+  /**
+   * Start growing stripe s into a table of new_cap slots. Any migration
+   * already in flight is finished first (it normally completes long
+   * before the next growth is due). Caller holds s.
+   * @return false if the new table could not be allocated
+   */
+  HSHM_CROSS_FUN
+  bool begin_grow(Stripe &s, size_type new_cap) {
+    slot_vector fresh(alloc_);
+    if (!fresh.resize(new_cap)) {
+      return false;  // Allocation failed; keep existing tables intact
+    }
+    migrate_step(s, s.old_slots_.size());
+    size_type old_cap = s.slots_.size();
+    s.old_slots_ = static_cast<slot_vector &&>(s.slots_);
+    s.slots_ = static_cast<slot_vector &&>(fresh);
+    s.old_live_ = s.live_;
+    s.filled_ = 0;
+    s.migrate_pos_ = 0;
+    capacity_.fetch_add(new_cap - old_cap);
+    maybe_finish_migration(s);
+    return true;
+  }
+
+  /** Make room for one more insert into stripe s's active table.
+   *  Entries still waiting in the old table count against the load so a
+   *  migration can always finish. Doubles when live entries need it;
+   *  otherwise rebuilds at the same size to drop tombstones. */
+  HSHM_CROSS_FUN
+  bool reserve_one(Stripe &s) {
+    size_type cap = s.slots_.size();
+    if ((s.filled_ + s.old_live_ + 1) * 4 <= cap * 3) {
+      return true;
+    }
+    size_type new_cap = cap;
+    if ((s.live_ + 1) * 2 > cap) {
+      new_cap = (cap == 0) ? 2 : cap * 2;
+    }
+    return begin_grow(s, new_cap);
+  }
+
+  /**
+   * Locate a key in stripe s, pulling it into the active table if it is
+   * still in the old one. Also advances the stripe's migration.
+   * @return Index in s.slots_, or s.slots_.size() if absent
+   */
+  HSHM_CROSS_FUN
+  size_type locate(Stripe &s, const Key &key, uint32_t tag) {
+    migrate_step(s, kMigrateBatch);
+    size_type idx = probe(s.slots_, key, tag, 0);
+    if (idx < s.slots_.size() || s.old_slots_.size() == 0) {
+      return idx;
+    }
+    size_type old_idx = probe(s.old_slots_, key, tag, s.migrate_pos_);
+    if (old_idx >= s.old_slots_.size()) {
+      return s.slots_.size();
+    }
+    idx = move_to_active(s, s.old_slots_[old_idx], kTombstone);
+    maybe_finish_migration(s);
+    return idx;
+  }
+
+  /**
+   * Insert a key known to be absent into stripe s
+   * @return Index in s.slots_, or s.slots_.size() if allocation failed
+   */
+  template <typename... Args>
+  HSHM_CROSS_FUN size_type place_new(Stripe &s, const Key &key, uint32_t tag,
+                                     Args &&...value) {
+    if (!reserve_one(s)) {
+      return s.slots_.size();
+    }
+    size_type idx = free_slot(s.slots_, tag);
+    Slot &dst = s.slots_[idx];
+    if (dst.state_ == kEmpty) {
+      ++s.filled_;
+    }
+    dst.state_ = kOccupied | tag;
+    dst.key_ = key;
+    dst.value_ = T(static_cast<Args &&>(value)...);
+    ++s.live_;
+    size_.fetch_add(1);
+    return idx;
   }
 
-  /** Initialize stripe locks */
+  /** Initialize stripes and their tables */
   HSHM_CROSS_FUN
-  void init_locks(size_type num_locks) {
+  void init_stripes(size_type capacity, size_type num_locks) {
+    if (num_locks > capacity) num_locks = capacity;
+    if (num_locks == 0) num_locks = 1;
     num_locks_ = num_locks;
-    locks_.resize(num_locks_);
+    stripes_.resize(num_locks_);
+    size_type per_stripe = (capacity + num_locks_ - 1) / num_locks_;
+    size_type total = 0;
     for (size_type i = 0; i < num_locks_; ++i) {
-      locks_[i].Init();
+      Stripe &s = stripes_[i];
+      s.lock_.Init();
+      s.slots_ = slot_vector(alloc_);
+      s.old_slots_ = slot_vector(alloc_);
+      if (s.slots_.resize(per_stripe)) {
+        total += per_stripe;
+      }
     }
+    capacity_ = total;
   }
 
  public:
@@ -203,101 +417,58 @@ class unordered_map_ll {
 #if HSHM_IS_HOST
   explicit unordered_map_ll(size_type capacity = 16,
                             size_type num_locks = kDefaultNumLocks)
-      : slots_(HSHM_MALLOC), size_(0), alloc_(HSHM_MALLOC),
-        hash_fn_(), key_eq_(), locks_(HSHM_MALLOC), num_locks_(0) {
-    slots_.resize(capacity);
-    init_locks(num_locks < capacity ? num_locks : capacity);
+      : stripes_(HSHM_MALLOC), size_(0), capacity_(0), alloc_(HSHM_MALLOC),
+        hash_fn_(), key_eq_(), num_locks_(0) {
+    init_stripes(capacity, num_locks);
   }
 #endif
 
   /**
    * Constructor with explicit allocator
-   * @param alloc Allocator for the backing vector
+   * @param alloc Allocator for the backing vectors
    * @param capacity Initial number of slots (hash table size)
    * @param num_locks Number of stripe locks (default: 64)
    */
   HSHM_CROSS_FUN
   explicit unordered_map_ll(AllocT *alloc, size_type capacity = 16,
                             size_type num_locks = kDefaultNumLocks)
-      : slots_(alloc), size_(0), alloc_(alloc),
-        hash_fn_(), key_eq_(), locks_(alloc), num_locks_(0) {
-    slots_.resize(capacity);
-    init_locks(num_locks < capacity ? num_locks : capacity);
+      : stripes_(alloc), size_(0), capacity_(0), alloc_(alloc),
+        hash_fn_(), key_eq_(), num_locks_(0) {
+    init_stripes(capacity, num_locks);
   }
 
   HSHM_CROSS_FUN ~unordered_map_ll() = default;
 
-  /** Rehash the map to a new capacity, re-inserting all occupied entries.
-   *  Acquires all stripe locks. Returns false if allocation fails. */
+  /** Grow the map to at least new_cap slots (thread-safe). Stripes are
+   *  resized one at a time and fully migrated before returning, so this
+   *  is the one call that moves a whole table; use it to pre-size.
+   *  Returns false if allocation fails. */
   HSHM_CROSS_FUN
   bool rehash(size_type new_cap) {
-    lock_all();
-    bool result = rehash_no_lock(new_cap);
-    unlock_all();
-    return result;
-  }
-
- private:
-  /** Rehash without locking (caller must hold all locks) */
-  HSHM_CROSS_FUN
-  bool rehash_no_lock(size_type new_cap) {
-    // Try to allocate new slots first (before destroying old)
-    vector<Slot, AllocT> new_slots(alloc_);
-    if (!new_slots.resize(new_cap)) {
-      return false;  // Allocation failed; keep existing map intact
-    }
-
-    // Move old slots out; slots_ becomes empty after move
-    vector<Slot, AllocT> old_slots(static_cast<vector<Slot, AllocT>&&>(slots_));
-    size_type old_size = old_slots.size();
-    // Install the new (empty) slots
-    slots_ = static_cast<vector<Slot, AllocT>&&>(new_slots);
-    size_ = 0;
-    for (size_type i = 0; i < old_size; ++i) {
-      if (old_slots[i].state_ == kOccupied) {
-        insert_no_rehash(old_slots[i].key_, old_slots[i].value_);
+    size_type per_stripe = (new_cap + num_locks_ - 1) / num_locks_;
+    bool result = true;
+    for (size_type i = 0; i < num_locks_; ++i) {
+      Stripe &s = stripes_[i];
+      lock_stripe(i);
+      if (s.slots_.size() < per_stripe) {
+        if (begin_grow(s, per_stripe)) {
+          migrate_step(s, s.old_slots_.size());
+        } else {
+          result = false;
+        }
       }
+      unlock_stripe(i);
     }
-    return true;
-  }
-
-  /** Check load factor and rehash if needed (>75% full).
-   *  Caller must hold all locks. */
-  HSHM_INLINE_CROSS_FUN
-  void maybe_rehash_locked() {
-    size_type cur_size = size_.load();
-    if (cur_size * 4 > slots_.size() * 3) {
-      rehash_no_lock(slots_.size() * 2);
-    }
-  }
-
-  /** Insert without rehash check (used internally by rehash) */
-  HSHM_CROSS_FUN
-  InsertResult<T> insert_no_rehash(const Key &key, const T &value) {
-    size_type idx;
-    bool existing;
-    find_insert_slot(key, idx, existing);
-    if (idx >= slots_.size()) {
-      return {false, nullptr};
-    }
-    if (existing) {
-      return {false, &slots_[idx].value_};
-    }
-    slots_[idx].state_ = kOccupied;
-    slots_[idx].key_ = key;
-    slots_[idx].value_ = value;
-    size_.fetch_add(1);
-    return {true, &slots_[idx].value_};
+    return result;
   }
 
- public:
   /** Insert or update a key-value pair (thread-safe) */
   HSHM_CROSS_FUN
   InsertResult<T> insert_or_assign(const Key &key, const T &value) {
     size_type h = hash_fn_(key);
     size_type stripe = stripe_of(h);
     lock_stripe(stripe);
-    InsertResult<T> result = insert_or_assign_no_lock(key, value);
+    InsertResult<T> result = insert_or_assign_no_lock(h, key, value);
     unlock_stripe(stripe);
     return result;
   }
@@ -308,7 +479,7 @@ class unordered_map_ll {
     size_type h = hash_fn_(key);
     size_type stripe = stripe_of(h);
     lock_stripe(stripe);
-    InsertResult<T> result = insert_no_lock(key, value);
+    InsertResult<T> result = insert_no_lock(h, key, value);
     unlock_stripe(stripe);
     return result;
   }
@@ -319,7 +490,13 @@ class unordered_map_ll {
     size_type h = hash_fn_(key);
     size_type stripe = stripe_of(h);
     lock_stripe(stripe);
-    T &ref = subscript_no_lock(key);
+    Stripe &s = stripes_[stripe];
+    uint32_t tag = tag_of(h);
+    size_type idx = locate(s, key, tag);
+    if (idx >= s.slots_.size()) {
+      idx = place_new(s, key, tag);
+    }
+    T &ref = s.slots_[idx].value_;
     unlock_stripe(stripe);
     return ref;
   }
@@ -340,14 +517,28 @@ class unordered_map_ll {
     unlock_stripe(s);
   }
 
-  /** Find an element (thread-safe, returns pointer valid while map lives) */
+  /**
+   * Find an element (thread-safe). The returned pointer is valid until the
+   * entry is erased or its stripe next grows. Probes under a shared stripe
+   * lock unless the stripe is migrating, in which case the key may need
+   * pulling into the active table and the lookup retakes the lock
+   * exclusively.
+   */
   HSHM_CROSS_FUN
   T *find(const Key &key) {
     size_type h = hash_fn_(key);
     size_type stripe = stripe_of(h);
+    Stripe &s = stripes_[stripe];
+    s.lock_.ReadLock(0);
+    if (s.old_slots_.size() == 0) {
+      size_type idx = probe(s.slots_, key, tag_of(h), 0);
+      T *result = (idx < s.slots_.size()) ? &s.slots_[idx].value_ : nullptr;
+      s.lock_.ReadUnlock();
+      return result;
+    }
+    s.lock_.ReadUnlock();
     lock_stripe(stripe);
-    size_type idx = find_slot(key);
-    T *result = (idx < slots_.size()) ? &slots_[idx].value_ : nullptr;
+    T *result = find_no_lock(h, key);
     unlock_stripe(stripe);
     return result;
   }
@@ -355,40 +546,25 @@ class unordered_map_ll {
   /** Find while holding the stripe lock. Caller must have called lock_key(). */
   HSHM_CROSS_FUN
   T *find_locked(const Key &key) {
-    size_type idx = find_slot(key);
-    return (idx < slots_.size()) ? &slots_[idx].value_ : nullptr;
+    return find_no_lock(hash_fn_(key), key);
   }
 
   /** Insert while holding the stripe lock. Caller must have called lock_key(). */
   HSHM_CROSS_FUN
   InsertResult<T> insert_locked(const Key &key, const T &value) {
-    return insert_no_lock(key, value);
+    return insert_no_lock(hash_fn_(key), key, value);
   }
 
   /** Erase while holding the stripe lock. Caller must have called lock_key(). */
   HSHM_CROSS_FUN
   size_type erase_locked(const Key &key) {
-    size_type idx = find_slot(key);
-    if (idx < slots_.size()) {
-      slots_[idx].state_ = kTombstone;
-      slots_[idx].key_ = Key();
-      slots_[idx].value_ = T();
-      size_.fetch_sub(1);
-      return 1;
-    }
-    return 0;
+    return erase_no_lock(hash_fn_(key), key);
   }
 
   /** Find an element (const, thread-safe) */
   HSHM_CROSS_FUN
   const T *find(const Key &key) const {
-    size_type h = hash_fn_(key);
-    size_type stripe = stripe_of(h);
-    const_cast<unordered_map_ll*>(this)->lock_stripe(stripe);
-    size_type idx = find_slot(key);
-    const T *result = (idx < slots_.size()) ? &slots_[idx].value_ : nullptr;
-    const_cast<unordered_map_ll*>(this)->unlock_stripe(stripe);
-    return result;
+    return const_cast<unordered_map_ll *>(this)->find(key);
   }
 
   /** Check if key exists (thread-safe) */
@@ -409,32 +585,33 @@ class unordered_map_ll {
     size_type h = hash_fn_(key);
     size_type stripe = stripe_of(h);
     lock_stripe(stripe);
-    size_type idx = find_slot(key);
-    size_type result = 0;
-    if (idx < slots_.size()) {
-      slots_[idx].state_ = kTombstone;
-      slots_[idx].key_ = Key();
-      slots_[idx].value_ = T();
-      size_.fetch_sub(1);
-      result = 1;
-    }
+    size_type result = erase_no_lock(h, key);
     unlock_stripe(stripe);
     return result;
   }
 
-  /** Clear all elements (thread-safe, acquires all locks) */
+  /** Clear all elements (thread-safe, locks one stripe at a time).
+   *  Table capacity is kept; any in-flight migration is dropped. */
   HSHM_CROSS_FUN
   void clear() {
-    lock_all();
-    for (size_type i = 0; i < slots_.size(); ++i) {
-      if (slots_[i].state_ == kOccupied) {
-        slots_[i].key_ = Key();
-        slots_[i].value_ = T();
+    for (size_type i = 0; i < num_locks_; ++i) {
+      Stripe &s = stripes_[i];
+      lock_stripe(i);
+      for (size_type j = 0; j < s.slots_.size(); ++j) {
+        if (is_occupied(s.slots_[j].state_)) {
+          s.slots_[j].key_ = Key();
+          s.slots_[j].value_ = T();
+        }
+        s.slots_[j].state_ = kEmpty;
       }
-      slots_[i].state_ = kEmpty;
+      s.old_slots_ = slot_vector(alloc_);
+      size_.fetch_sub(s.live_);
+      s.live_ = 0;
+      s.filled_ = 0;
+      s.old_live_ = 0;
+      s.migrate_pos_ = 0;
+      unlock_stripe(i);
     }
-    size_ = 0;
-    unlock_all();
   }
 
   /** Total number of elements */
@@ -445,169 +622,104 @@ class unordered_map_ll {
   HSHM_INLINE_CROSS_FUN
   bool empty() const { return size() == 0; }
 
-  /** Number of slots */
+  /** Number of slots in the active tables of all stripes */
   HSHM_INLINE_CROSS_FUN
-  size_type bucket_count() const { return slots_.size(); }
+  size_type bucket_count() const { return capacity_.load(); }
 
-  /** Apply function to each occupied entry (thread-safe, acquires all locks) */
+  /** Apply function to each occupied entry (thread-safe, locks one stripe
+   *  at a time) */
   template <typename Func>
   HSHM_CROSS_FUN void for_each(Func fn) {
-    lock_all();
-    for (size_type i = 0; i < slots_.size(); ++i) {
-      if (slots_[i].state_ == kOccupied) {
-        fn(slots_[i].key_, slots_[i].value_);
-      }
+    for (size_type i = 0; i < num_locks_; ++i) {
+      Stripe &s = stripes_[i];
+      lock_stripe(i);
+      for_each_in(s.slots_, fn);
+      for_each_in(s.old_slots_, fn);
+      unlock_stripe(i);
     }
-    unlock_all();
   }
 
   /** Apply function to each occupied entry (const, thread-safe) */
   template <typename Func>
   HSHM_CROSS_FUN void for_each(Func fn) const {
-    const_cast<unordered_map_ll*>(this)->lock_all();
-    for (size_type i = 0; i < slots_.size(); ++i) {
-      if (slots_[i].state_ == kOccupied) {
-        fn(slots_[i].key_, slots_[i].value_);
-      }
+    auto *self = const_cast<unordered_map_ll *>(this);
+    for (size_type i = 0; i < num_locks_; ++i) {
+      const Stripe &s = stripes_[i];
+      self->lock_stripe(i);
+      for_each_in(s.slots_, fn);
+      for_each_in(s.old_slots_, fn);
+      self->unlock_stripe(i);
     }
-    const_cast<unordered_map_ll*>(this)->unlock_all();
   }
 
  private:
+  /** Visit occupied slots of one table */
+  template <typename TableT, typename Func>
+  HSHM_CROSS_FUN static void for_each_in(TableT &tbl, Func &fn) {
+    for (size_type j = 0; j < tbl.size(); ++j) {
+      if (is_occupied(tbl[j].state_)) {
+        fn(tbl[j].key_, tbl[j].value_);
+      }
+    }
+  }
+
+  /** Find without locking (caller holds stripe lock) */
+  HSHM_CROSS_FUN
+  T *find_no_lock(size_type h, const Key &key) {
+    Stripe &s = stripe_for(h);
+    size_type idx = locate(s, key, tag_of(h));
+    return (idx < s.slots_.size()) ? &s.slots_[idx].value_ : nullptr;
+  }
+
   /** Insert or assign without locking (caller holds stripe lock) */
   HSHM_CROSS_FUN
-  InsertResult<T> insert_or_assign_no_lock(const Key &key, const T &value) {
-    size_type idx;
-    bool existing;
-    find_insert_slot(key, idx, existing);
-    if (existing) {
-      slots_[idx].value_ = value;
-      return {false, &slots_[idx].value_};
-    }
-    if (idx >= slots_.size()) {
-      // Need rehash — must acquire all locks
-      // Release our stripe lock first to avoid deadlock
-      size_type h = hash_fn_(key);
-      size_type stripe = stripe_of(h);
-      unlock_stripe(stripe);
-      lock_all();
-      if (!rehash_no_lock(slots_.size() * 2)) {
-        unlock_all();
-        lock_stripe(stripe);
-        return {false, nullptr};
-      }
-      // Re-do insert under all locks
-      InsertResult<T> result = insert_no_rehash(key, value);
-      unlock_all();
-      lock_stripe(stripe);
-      return result;
+  InsertResult<T> insert_or_assign_no_lock(size_type h, const Key &key,
+                                           const T &value) {
+    Stripe &s = stripe_for(h);
+    uint32_t tag = tag_of(h);
+    size_type idx = locate(s, key, tag);
+    if (idx < s.slots_.size()) {
+      s.slots_[idx].value_ = value;
+      return {false, &s.slots_[idx].value_};
     }
-    slots_[idx].state_ = kOccupied;
-    slots_[idx].key_ = key;
-    slots_[idx].value_ = value;
-    size_.fetch_add(1);
-    // Check if rehash needed
-    size_type cur_size = size_.load();
-    if (cur_size * 4 > slots_.size() * 3) {
-      size_type h = hash_fn_(key);
-      size_type stripe = stripe_of(h);
-      unlock_stripe(stripe);
-      lock_all();
-      maybe_rehash_locked();
-      unlock_all();
-      lock_stripe(stripe);
+    idx = place_new(s, key, tag, value);
+    if (idx >= s.slots_.size()) {
+      return {false, nullptr};
     }
-    return {true, &slots_[idx].value_};
+    return {true, &s.slots_[idx].value_};
   }
 
   /** Insert without locking (caller holds stripe lock) */
   HSHM_CROSS_FUN
-  InsertResult<T> insert_no_lock(const Key &key, const T &value) {
-    size_type idx;
-    bool existing;
-    find_insert_slot(key, idx, existing);
-    if (existing) {
-      return {false, &slots_[idx].value_};
+  InsertResult<T> insert_no_lock(size_type h, const Key &key,
+                                 const T &value) {
+    Stripe &s = stripe_for(h);
+    uint32_t tag = tag_of(h);
+    size_type idx = locate(s, key, tag);
+    if (idx < s.slots_.size()) {
+      return {false, &s.slots_[idx].value_};
     }
-    if (idx >= slots_.size()) {
-      size_type h = hash_fn_(key);
-      size_type stripe = stripe_of(h);
-      unlock_stripe(stripe);
-      lock_all();
-      if (!rehash_no_lock(slots_.size() * 2)) {
-        unlock_all();
-        lock_stripe(stripe);
-        return {false, nullptr};
-      }
-      InsertResult<T> result = insert_no_rehash(key, value);
-      unlock_all();
-      lock_stripe(stripe);
-      return result;
-    }
-    slots_[idx].state_ = kOccupied;
-    slots_[idx].key_ = key;
-    slots_[idx].value_ = value;
-    size_.fetch_add(1);
-    size_type cur_size = size_.load();
-    if (cur_size * 4 > slots_.size() * 3) {
-      size_type h = hash_fn_(key);
-      size_type stripe = stripe_of(h);
-      unlock_stripe(stripe);
-      lock_all();
-      maybe_rehash_locked();
-      unlock_all();
-      lock_stripe(stripe);
+    idx = place_new(s, key, tag, value);
+    if (idx >= s.slots_.size()) {
+      return {false, nullptr};
     }
-    return {true, &slots_[idx].value_};
+    return {true, &s.slots_[idx].value_};
   }
 
-  /** operator[] without locking (caller holds stripe lock) */
+  /** Erase without locking (caller holds stripe lock) */
   HSHM_CROSS_FUN
-  T &subscript_no_lock(const Key &key) {
-    size_type idx;
-    bool existing;
-    find_insert_slot(key, idx, existing);
-    if (existing) {
-      return slots_[idx].value_;
-    }
-    if (idx >= slots_.size()) {
-      size_type h = hash_fn_(key);
-      size_type stripe = stripe_of(h);
-      unlock_stripe(stripe);
-      lock_all();
-      rehash_no_lock(slots_.size() * 2);
-      // Re-find after rehash
-      find_insert_slot(key, idx, existing);
-      if (existing) {
-        unlock_all();
-        lock_stripe(stripe);
-        return slots_[idx].value_;
-      }
-      slots_[idx].state_ = kOccupied;
-      slots_[idx].key_ = key;
-      slots_[idx].value_ = T();
-      size_.fetch_add(1);
-      maybe_rehash_locked();
-      T &ref = slots_[idx].value_;
-      unlock_all();
-      lock_stripe(stripe);
-      return ref;
-    }
-    slots_[idx].state_ = kOccupied;
-    slots_[idx].key_ = key;
-    slots_[idx].value_ = T();
-    size_.fetch_add(1);
-    size_type cur_size = size_.load();
-    if (cur_size * 4 > slots_.size() * 3) {
-      size_type h = hash_fn_(key);
-      size_type stripe = stripe_of(h);
-      unlock_stripe(stripe);
-      lock_all();
-      maybe_rehash_locked();
-      unlock_all();
-      lock_stripe(stripe);
+  size_type erase_no_lock(size_type h, const Key &key) {
+    Stripe &s = stripe_for(h);
+    size_type idx = locate(s, key, tag_of(h));
+    if (idx >= s.slots_.size()) {
+      return 0;
     }
-    return slots_[idx].value_;
+    s.slots_[idx].state_ = kTombstone;
+    s.slots_[idx].key_ = Key();
+    s.slots_[idx].value_ = T();
+    --s.live_;
+    size_.fetch_sub(1);
+    return 1;
   }
 };
 
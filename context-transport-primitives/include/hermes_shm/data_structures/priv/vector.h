@@ -570,6 +570,39 @@ class vector {
    */
   static constexpr bool kIsPod = std::is_trivial_v<T>;
 
+  /**
+   * Elements may be copied, moved, and relocated with memcpy/memmove.
+   * Wider than kIsPod: types with a default constructor (e.g. a zeroing
+   * one) still qualify, but only kIsPod types are zero-filled by resize().
+   */
+  static constexpr bool kIsBitwise = std::is_trivially_copyable_v<T> &&
+                                     std::is_trivially_destructible_v<T>;
+
+  /**
+   * Copy every element of other into this (empty) vector
+   *
+   * @param other Vector to copy from
+   */
+  HSHM_INLINE_CROSS_FUN
+  void CopyFrom(const vector& other) {
+    if (alloc_ == nullptr && other.size_ > SVO_SIZE) {
+      return;
+    }
+    if (!reserve(other.size_)) {
+      return;
+    }
+    if constexpr (kIsBitwise) {
+      if (other.size_ > 0) {
+        memcpy(data_.ptr_, other.data_.ptr_, other.size_ * sizeof(T));
+      }
+      size_ = other.size_;
+    } else {
+      for (const auto& val : other) {
+        push_back(val);
+      }
+    }
+  }
+
   /**
    * Get typed pointer to the SVO buffer
    */
@@ -653,7 +686,7 @@ class vector {
    */
   HSHM_INLINE_CROSS_FUN
   void Destroy(size_type pos) {
-    if constexpr (!kIsPod) {
+    if constexpr (!kIsBitwise) {
       data_.ptr_[pos].~T();
     }
   }
@@ -667,7 +700,7 @@ class vector {
    */
   HSHM_INLINE_CROSS_FUN
   void DestroyRange(size_type first, size_type last) {
-    if constexpr (!kIsPod) {
+    if constexpr (!kIsBitwise) {
       for (size_type i = first; i < last; ++i) {
         Destroy(i);
       }
@@ -788,12 +821,7 @@ class vector {
   vector(const vector& other)
       : size_(0), alloc_(other.alloc_) {
     InitSvo();
-    if (alloc_ != nullptr || other.size_ <= SVO_SIZE) {
-      reserve(other.size_);
-      for (const auto& val : other) {
-        push_back(val);
-      }
-    }
+    CopyFrom(other);
   }
 
   /**
@@ -808,7 +836,7 @@ class vector {
       : size_(0), alloc_(other.alloc_) {
     if (other.IsUsingSvo()) {
       InitSvo();
-      if constexpr (kIsPod) {
+      if constexpr (kIsBitwise) {
         memcpy(svo_, other.svo_, other.size_ * sizeof(T));
       } else {
         for (size_type i = 0; i < other.size_; ++i) {
@@ -844,12 +872,7 @@ class vector {
       }
       alloc_ = other.alloc_;
       InitSvo();
-      if (alloc_ != nullptr || other.size_ <= SVO_SIZE) {
-        reserve(other.size_);
-        for (const auto& val : other) {
-          push_back(val);
-        }
-      }
+      CopyFrom(other);
     }
     return *this;
   }
@@ -871,7 +894,7 @@ class vector {
       alloc_ = other.alloc_;
       if (other.IsUsingSvo()) {
         InitSvo();
-        if constexpr (kIsPod) {
+        if constexpr (kIsBitwise) {
           memcpy(svo_, other.svo_, other.size_ * sizeof(T));
         } else {
           for (size_type i = 0; i < other.size_; ++i) {
@@ -1208,7 +1231,7 @@ class vector {
 
     // Copy existing elements from current buffer (SVO or heap)
     if (size_ > 0) {
-      if constexpr (kIsPod) {
+      if constexpr (kIsBitwise) {
         memcpy(new_data.ptr_, data_.ptr_, size_ * sizeof(T));
       } else {
         for (size_type i = 0; i < size_; ++i) {
@@ -1243,7 +1266,7 @@ class vector {
         InitSvo();
       } else if (!IsUsingSvo() && size_ <= SVO_SIZE) {
         // Move from heap back to SVO
-        if constexpr (kIsPod) {
+        if constexpr (kIsBitwise) {
           memcpy(svo_, data_.ptr_, size_ * sizeof(T));
         } else {
           for (size_type i = 0; i < size_; ++i) {
@@ -1257,7 +1280,7 @@ class vector {
         capacity_ = SVO_SIZE;
       } else if (!IsUsingSvo() && size_ < capacity_) {
         auto new_data = alloc_->template AllocateObjs<T>(size_);
-        if constexpr (kIsPod) {
+        if constexpr (kIsBitwise) {
           memcpy(new_data.ptr_, data_.ptr_, size_ * sizeof(T));
         } else {
           for (size_type i = 0; i < size_; ++i) {
@@ -1335,7 +1358,7 @@ class vector {
       Grow(size_ + 1);
     }
 
-    if constexpr (kIsPod) {
+    if constexpr (kIsBitwise) {
       memmove(&data_.ptr_[idx + 1], &data_.ptr_[idx], (size_ - idx) * sizeof(T));
       data_.ptr_[idx] = val;
     } else {
@@ -1365,7 +1388,7 @@ class vector {
       Grow(size_ + 1);
     }
 
-    if constexpr (kIsPod) {
+    if constexpr (kIsBitwise) {
       memmove(&data_.ptr_[idx + 1], &data_.ptr_[idx], (size_ - idx) * sizeof(T));
       data_.ptr_[idx] = std::move(val);
     } else {
@@ -1399,7 +1422,7 @@ class vector {
       Grow(size_ + count);
     }
 
-    if constexpr (kIsPod) {
+    if constexpr (kIsBitwise) {
       memmove(&data_.ptr_[idx + count], &data_.ptr_[idx], (size_ - idx) * sizeof(T));
       memcpy(&data_.ptr_[idx], first.get(), count * sizeof(T));
     } else {
@@ -1428,7 +1451,7 @@ class vector {
   iterator erase(const_iterator pos) {
     size_type idx = pos.get() - data_.ptr_;
 
-    if constexpr (kIsPod) {
+    if constexpr (kIsBitwise) {
       memmove(&data_.ptr_[idx], &data_.ptr_[idx + 1], (size_ - idx - 1) * sizeof(T));
     } else {
       Destroy(idx);
@@ -1456,7 +1479,7 @@ class vector {
     size_type last_idx = last.get() - data_.ptr_;
     size_type count = last_idx - first_idx;
 
-    if constexpr (kIsPod) {
+    if constexpr (kIsBitwise) {
       memmove(&data_.ptr_[first_idx], &data_.ptr_[last_idx],
                    (size_ - last_idx) * sizeof(T));
     } else {
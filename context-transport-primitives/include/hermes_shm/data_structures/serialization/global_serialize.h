@@ -47,6 +47,11 @@
 
 namespace hshm::ipc {
 
+/** True if a field is written as its raw bytes (arithmetic or enum) */
+template <typename T>
+constexpr bool is_flat_field_v =
+    std::is_arithmetic_v<std::decay_t<T>> || std::is_enum_v<std::decay_t<T>>;
+
 /**
  * Architecture-portable binary serializer.
  *
@@ -98,10 +103,22 @@ class GlobalSerialize {
     return *this;
   }
 
-  /** range() — portable: serialize each field individually */
+  /**
+   * range() — portable: serialize each field individually.
+   * When every field is flat, the fields are packed back to back after a
+   * single capacity check. The bytes are the same as the per-field path.
+   */
   template <typename... Args>
   HSHM_INLINE GlobalSerialize &range(Args &&...args) {
-    return (*this)(std::forward<Args>(args)...);
+    if constexpr (sizeof...(Args) > 1 && (is_flat_field_v<Args> && ...)) {
+      char *dst = reserve_binary((sizeof(std::decay_t<Args>) + ...));
+      ((memcpy(dst, &args, sizeof(std::decay_t<Args>)),
+        dst += sizeof(std::decay_t<Args>)),
+       ...);
+      return *this;
+    } else {
+      return (*this)(std::forward<Args>(args)...);
+    }
   }
 
   /** Save function */
@@ -137,20 +154,31 @@ class GlobalSerialize {
     write_binary(begin, static_cast<size_t>(end - begin));
   }
 
-  /** Save function (binary data) */
+  /**
+   * Claim size bytes at the write offset, growing the buffer geometrically.
+   * @return Pointer to the claimed bytes, valid until the next write
+   */
   HSHM_INLINE
-  GlobalSerialize &write_binary(const char *data, size_t size) {
+  char *reserve_binary(size_t size) {
     size_t new_off = cur_off_ + size;
     if (new_off > data_.size()) {
       size_t new_cap = data_.size();
       if (new_cap == 0) new_cap = 64;
       while (new_cap < new_off) new_cap *= 2;
-      data_.resize(new_cap);
+      resize_for_overwrite(data_, new_cap);
     }
+    char *dst = data_.data() + cur_off_;
+    cur_off_ = new_off;
+    return dst;
+  }
+
+  /** Save function (binary data) */
+  HSHM_INLINE
+  GlobalSerialize &write_binary(const char *data, size_t size) {
+    char *dst = reserve_binary(size);
     if (size > 0) {
-      memcpy(data_.data() + cur_off_, data, size);
+      memcpy(dst, data, size);
     }
-    cur_off_ = new_off;
     return *this;
   }
 
@@ -158,23 +186,29 @@ class GlobalSerialize {
    *  Uses direct store for size prefix to avoid memcpy overhead. */
   HSHM_INLINE
   void save_string_fused(const char *str_data, size_t len) {
-    size_t total = sizeof(size_t) + len;
-    size_t new_off = cur_off_ + total;
-    if (new_off > data_.size()) {
-      size_t new_cap = data_.size();
-      if (new_cap == 0) new_cap = 64;
-      while (new_cap < new_off) new_cap *= 2;
-      data_.resize(new_cap);
-    }
-    char *dst = data_.data() + cur_off_;
+    char *dst = reserve_binary(sizeof(size_t) + len);
     memcpy(dst, &len, sizeof(size_t));
     if (len > 0) {
       memcpy(dst + sizeof(size_t), str_data, len);
     }
-    cur_off_ = new_off;
   }
 };
 
+/**
+ * Non-owning view of received bytes, so GlobalDeserialize can read a
+ * message in place instead of copying it into a vector first.
+ */
+class ByteView {
+ public:
+  const char *data_;
+  size_t size_;
+
+  ByteView(const char *data, size_t size) : data_(data), size_(size) {}
+
+  HSHM_INLINE const char *data() const { return data_; }
+  HSHM_INLINE size_t size() const { return size_; }
+};
+
 /**
  * Architecture-portable binary deserializer.
  *
@@ -214,10 +248,28 @@ class GlobalDeserialize {
     return *this;
   }
 
-  /** range() — portable: deserialize each field individually */
+  /**
+   * range() — portable: deserialize each field individually.
+   * Flat fields are unpacked after a single bounds check.
+   */
   template <typename... Args>
   HSHM_INLINE GlobalDeserialize &range(Args &&...args) {
-    return (*this)(std::forward<Args>(args)...);
+    if constexpr (sizeof...(Args) > 1 && (is_flat_field_v<Args> && ...)) {
+      size_t size = (sizeof(std::decay_t<Args>) + ...);
+      if (cur_off_ + size > data_.size()) {
+        HLOG(kError,
+             "GlobalDeserialize::range: Attempted to read beyond end of data");
+        return *this;
+      }
+      const char *src = data_.data() + cur_off_;
+      ((memcpy(&args, src, sizeof(std::decay_t<Args>)),
+        src += sizeof(std::decay_t<Args>)),
+       ...);
+      cur_off_ += size;
+      return *this;
+    } else {
+      return (*this)(std::forward<Args>(args)...);
+    }
   }
 
   /** Load function */
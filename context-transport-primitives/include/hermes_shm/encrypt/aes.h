@@ -40,9 +40,12 @@
 #include <openssl/evp.h>
 #include <openssl/rand.h>
 
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <string>
 
-#include "hermes_shm/data_structures/all.h"
+#include "hermes_shm/util/logging.h"
 
 namespace hshm {
 
@@ -128,6 +131,162 @@ class AES {
   }
 };
 
+/**
+ * AES-256-GCM over independent chunks. A sealed chunk is a random nonce,
+ * the ciphertext and the tag, so any chunk opens without the others. The
+ * chunk index is bound in as associated data, so chunks cannot be swapped.
+ * Each thread keeps one encrypt and one decrypt context and only rekeys
+ * them per chunk; OpenSSL selects AES-NI and carry-less multiply itself.
+ */
+class AesGcm {
+ public:
+  static constexpr size_t kKeySize = 32;
+  static constexpr size_t kNonceSize = 12;
+  static constexpr size_t kTagSize = 16;
+  static constexpr size_t kOverhead = kNonceSize + kTagSize;
+  static constexpr int kKdfIterations = 100000;
+
+  std::string key_;
+
+ public:
+  /**
+   * Use raw key bytes
+   * @param key kKeySize bytes
+   * @return false if the key has the wrong size
+   */
+  bool SetKey(const std::string &key) {
+    if (key.size() != kKeySize) {
+      return false;
+    }
+    key_ = key;
+    return true;
+  }
+
+  /**
+   * Derive the key from a passphrase with PBKDF2-HMAC-SHA256
+   * @param password Passphrase
+   * @param salt Salt mixed into the derivation
+   * @return false if the derivation failed
+   */
+  bool GenerateKey(const std::string &password, const std::string &salt) {
+    std::string key(kKeySize, 0);
+    int ret = PKCS5_PBKDF2_HMAC(
+        password.data(), static_cast<int>(password.size()),
+        reinterpret_cast<const unsigned char *>(salt.data()),
+        static_cast<int>(salt.size()), kKdfIterations, EVP_sha256(),
+        static_cast<int>(kKeySize), reinterpret_cast<unsigned char *>(&key[0]));
+    if (ret != 1) {
+      HLOG(kError, "Failed to derive key");
+      return false;
+    }
+    key_ = std::move(key);
+    return true;
+  }
+
+  /** @return true once a key is set */
+  bool HasKey() const { return key_.size() == kKeySize; }
+
+  /**
+   * Encrypt one chunk
+   * @param output input_size + kOverhead bytes: nonce, ciphertext, tag
+   * @param input Plaintext
+   * @param input_size Plaintext bytes
+   * @param chunk_id Associated data the chunk is opened with
+   * @return false on failure
+   */
+  bool Seal(char *output, const char *input, size_t input_size,
+            uint64_t chunk_id) const {
+    EVP_CIPHER_CTX *ctx = GetContext(true);
+    unsigned char *nonce = reinterpret_cast<unsigned char *>(output);
+    unsigned char *body = nonce + kNonceSize;
+    int len = 0;
+    if (ctx == nullptr || !HasKey() || RAND_bytes(nonce, kNonceSize) != 1 ||
+        EVP_EncryptInit_ex(ctx, nullptr, nullptr, Key(), nonce) != 1 ||
+        EVP_EncryptUpdate(ctx, nullptr, &len, AssocData(chunk_id).data(),
+                          sizeof(uint64_t)) != 1 ||
+        EVP_EncryptUpdate(ctx, body, &len,
+                          reinterpret_cast<const unsigned char *>(input),
+                          static_cast<int>(input_size)) != 1 ||
+        EVP_EncryptFinal_ex(ctx, body + len, &len) != 1 ||
+        EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, kTagSize,
+                            body + input_size) != 1) {
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * Decrypt and authenticate one chunk
+   * @param output sealed_size - kOverhead bytes of plaintext
+   * @param input Sealed chunk from Seal
+   * @param sealed_size Sealed bytes
+   * @param chunk_id Associated data the chunk was sealed with
+   * @return false if the chunk was altered or the key is wrong
+   */
+  bool Open(char *output, const char *input, size_t sealed_size,
+            uint64_t chunk_id) const {
+    if (sealed_size < kOverhead) {
+      return false;
+    }
+    EVP_CIPHER_CTX *ctx = GetContext(false);
+    const unsigned char *nonce = reinterpret_cast<const unsigned char *>(input);
+    const unsigned char *body = nonce + kNonceSize;
+    size_t body_size = sealed_size - kOverhead;
+    unsigned char *out = reinterpret_cast<unsigned char *>(output);
+    int len = 0;
+    if (ctx == nullptr || !HasKey() ||
+        EVP_DecryptInit_ex(ctx, nullptr, nullptr, Key(), nonce) != 1 ||
+        EVP_DecryptUpdate(ctx, nullptr, &len, AssocData(chunk_id).data(),
+                          sizeof(uint64_t)) != 1 ||
+        EVP_DecryptUpdate(ctx, out, &len, body,
+                          static_cast<int>(body_size)) != 1 ||
+        EVP_CIPHER_CTX_ctrl(
+            ctx, EVP_CTRL_GCM_SET_TAG, kTagSize,
+            const_cast<unsigned char *>(body + body_size)) != 1 ||
+        EVP_DecryptFinal_ex(ctx, out + len, &len) != 1) {
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  const unsigned char *Key() const {
+    return reinterpret_cast<const unsigned char *>(key_.data());
+  }
+
+  /** Little-endian chunk index */
+  static std::array<unsigned char, sizeof(uint64_t)> AssocData(
+      uint64_t chunk_id) {
+    std::array<unsigned char, sizeof(uint64_t)> aad;
+    for (size_t i = 0; i < aad.size(); ++i) {
+      aad[i] = static_cast<unsigned char>(chunk_id >> (8 * i));
+    }
+    return aad;
+  }
+
+  /** This thread's context, bound to AES-256-GCM on first use */
+  static EVP_CIPHER_CTX *GetContext(bool encrypt) {
+    using CtxPtr = std::unique_ptr<EVP_CIPHER_CTX, void (*)(EVP_CIPHER_CTX *)>;
+    auto make = [](bool enc) {
+      CtxPtr ctx(EVP_CIPHER_CTX_new(), &EVP_CIPHER_CTX_free);
+      int ret = 0;
+      if (ctx) {
+        ret = enc ? EVP_EncryptInit_ex(ctx.get(), EVP_aes_256_gcm(), nullptr,
+                                       nullptr, nullptr)
+                  : EVP_DecryptInit_ex(ctx.get(), EVP_aes_256_gcm(), nullptr,
+                                       nullptr, nullptr);
+      }
+      if (ret != 1) {
+        ctx.reset();
+      }
+      return ctx;
+    };
+    thread_local CtxPtr enc_ctx = make(true);
+    thread_local CtxPtr dec_ctx = make(false);
+    return encrypt ? enc_ctx.get() : dec_ctx.get();
+  }
+};
+
 }  // namespace hshm
 
 #endif  // HSHM_ENABLE_ENCRYPT
@@ -56,6 +56,7 @@
 #include "util/errors.h"
 #include "util/formatter.h"
 #include "util/gpu_api.h"
+#include "util/gpu_graph.h"
 #include "util/logging.h"
 #include "util/random.h"
 #include "util/real_api.h"
@@ -116,6 +117,7 @@
 // Data structures
 // IPC data structures (inter-process communication containers)
 #include "data_structures/ipc/algorithm.h"
+#include "data_structures/ipc/mpmc_ring_buffer.h"
 #include "data_structures/ipc/multi_ring_buffer.h"
 #include "data_structures/ipc/rb_tree_pre.h"
 #include "data_structures/ipc/ring_buffer.h"
@@ -110,8 +110,10 @@ class SystemInfo {
   int uid_;
   int gid_;
   size_t ram_size_;
+  int numa_nodes_;
 #if HSHM_IS_HOST
   std::vector<size_t> cur_cpu_freq_;
+  std::vector<int> cpu_numa_node_;
 #endif
 
  public:
@@ -129,6 +131,8 @@ class SystemInfo {
     ram_size_ = GetRamCapacity();
     cur_cpu_freq_.resize(ncpu_);
     RefreshCpuFreqKhz();
+    numa_nodes_ = GetNumaNodeCount();
+    RefreshNumaTopology();
 #endif
   }
 
@@ -154,6 +158,83 @@ class SystemInfo {
 
   HSHM_DLL static int GetCpuCount();
 
+  /** Number of NUMA nodes (1 when the topology is unknown) */
+  HSHM_DLL static int GetNumaNodeCount();
+
+  /** Rebuild the cached CPU -> NUMA node table from sysfs */
+  HSHM_DLL void RefreshNumaTopology();
+
+  /** NUMA node of a CPU from the cached table (0 if unknown) */
+  HSHM_DLL int GetNumaNodeOfCpu(int cpu) const;
+
+  /** NUMA node of the CPU the calling thread is running on */
+  HSHM_DLL int GetCurrentNumaNode() const;
+
+  /** CPUs sharing a core with cpu, including cpu ({cpu} if unknown) */
+  HSHM_DLL static std::vector<int> GetCpuSiblings(int cpu);
+
+  /**
+   * NUMA node of a device under /sys/class
+   * @param dev_class Device class, e.g. "net", "infiniband", "nvme"
+   * @param name Device name within the class, e.g. "eth0", "mlx5_0"
+   * @return Node of the device's bus, or -1 if unknown
+   */
+  HSHM_DLL static int GetDeviceNumaNode(const std::string &dev_class,
+                                        const std::string &name);
+
+  /**
+   * Distinct NUMA nodes of the devices of a /sys/class. Devices without a
+   * bus (virtual interfaces, loopback) are skipped.
+   * @param dev_class Device class, e.g. "nvme"
+   * @return Sorted node ids (empty if none are known)
+   */
+  HSHM_DLL static std::vector<int> GetDeviceClassNumaNodes(
+      const std::string &dev_class);
+
+  /** Distinct NUMA nodes of the NVIDIA and AMD GPUs on the PCI bus */
+  HSHM_DLL static std::vector<int> GetGpuNumaNodes();
+
+  /**
+   * NUMA node of the block device holding a file system path. A path that
+   * does not exist yet is looked up through its parent directory.
+   * @param path File or directory path
+   * @return Node of the device's bus, or -1 if unknown (e.g. tmpfs)
+   */
+  HSHM_DLL static int GetPathNumaNode(const std::string &path);
+
+  /**
+   * Pin the calling thread to one CPU
+   * @return true on success
+   */
+  HSHM_DLL static bool PinThreadToCpu(int cpu);
+
+  /**
+   * Set the NUMA policy of a memory range to a single node. Already
+   * faulted pages are migrated; later faults allocate on the node.
+   * @param strict MPOL_BIND (fail when the node is full) instead of
+   *        MPOL_PREFERRED (fall back to other nodes)
+   */
+  HSHM_DLL static bool BindMemoryToNumaNode(void *ptr, size_t size, int node,
+                                            bool strict = false);
+
+  /** Interleave the pages of a memory range across all NUMA nodes */
+  HSHM_DLL static bool InterleaveMemory(void *ptr, size_t size);
+
+  /**
+   * Make the calling thread's later page faults prefer one NUMA node
+   * (MPOL_PREFERRED), or restore the default policy
+   * @param node NUMA node, or -1 for the default (local) policy
+   * @return true on success
+   */
+  HSHM_DLL static bool SetThreadNumaPreference(int node);
+
+  /**
+   * Fault in every page of a memory range for writing without changing its
+   * contents, so later first touches do not pay the page-fault cost. Safe to
+   * run while other threads use the range.
+   */
+  HSHM_DLL static bool PrefaultMemory(void *ptr, size_t size);
+
   HSHM_DLL static int GetPageSize();
 
   HSHM_DLL static int GetTid();
@@ -180,14 +261,31 @@ class SystemInfo {
 
   HSHM_DLL static void YieldThread();
 
+  /** Sleep until another process wakes the 32-bit word at addr, unless it
+   * no longer equals expected. Shared (non-private) futex on Linux;
+   * falls back to a yield elsewhere. May return spuriously. A non-zero
+   * timeout_us bounds the sleep. */
+  HSHM_DLL static void FutexWait(void *addr, u32 expected,
+                                 u32 timeout_us = 0);
+
+  /** Wake up to count threads (any process) sleeping in FutexWait on addr */
+  HSHM_DLL static void FutexWake(void *addr, int count);
+
   HSHM_DLL static bool CreateTls(ThreadLocalKey &key, void *data);
 
   HSHM_DLL static bool SetTls(const ThreadLocalKey &key, void *data);
 
   HSHM_DLL static void *GetTls(const ThreadLocalKey &key);
 
+  /**
+   * Create a named shared memory object
+   *
+   * @param huge_page_size 0 for base pages, otherwise the hugetlb page size
+   *        (2MB or 1GB) backing the object. size must be a multiple of it.
+   */
   HSHM_DLL static bool CreateNewSharedMemory(File &fd, const std::string &name,
-                                             size_t size);
+                                             size_t size,
+                                             size_t huge_page_size = 0);
 
   HSHM_DLL static bool OpenSharedMemory(File &fd, const std::string &name);
 
@@ -197,8 +295,26 @@ class SystemInfo {
 
   HSHM_DLL static void *MapPrivateMemory(size_t size);
 
+  /**
+   * Map anonymous private memory backed by explicit hugetlb pages
+   *
+   * @return nullptr when the huge page pool cannot satisfy the request
+   */
+  HSHM_DLL static void *MapHugePrivateMemory(size_t size,
+                                             size_t huge_page_size);
+
+  /** Ask the kernel to back a range with transparent huge pages */
+  HSHM_DLL static bool AdviseHugePages(void *ptr, size_t size);
+
+  /** Page size backing a shared memory object (st_blksize of the file) */
+  HSHM_DLL static size_t GetSharedMemoryPageSize(const File &fd);
+
   HSHM_DLL static void *MapSharedMemory(const File &fd, size_t size, i64 off);
 
+  /** Map a shared memory object without write access (nullptr on failure) */
+  HSHM_DLL static void *MapSharedMemoryReadOnly(const File &fd, size_t size,
+                                                i64 off);
+
   HSHM_DLL static void UnmapMemory(void *ptr, size_t size);
 
   HSHM_DLL static void *AlignedAlloc(size_t alignment, size_t size);
@@ -50,6 +50,21 @@ struct IoResult {
   int error_code;             /**< 0 on success, errno on failure */
 };
 
+/** One memory segment of a vectored I/O */
+struct IoVec {
+  void *base_;   /**< Start of the segment */
+  size_t size_;  /**< Length of the segment in bytes */
+};
+
+/** Backend tuning options. Backends ignore the ones they do not support. */
+struct AsyncIoOptions {
+  bool fixed_buffers_ = false;      /**< Use registered (fixed) buffers */
+  bool batch_submit_ = false;       /**< Defer submission until Flush() */
+  bool sqpoll_ = false;             /**< Kernel thread polls the submit queue */
+  int sqpoll_cpu_ = -1;             /**< CPU for the SQ poll thread (-1: any) */
+  uint32_t sqpoll_idle_ms_ = 1000;  /**< Idle time before the SQ thread sleeps */
+};
+
 class AsyncIO {
  public:
   AsyncIO() = default;
@@ -68,14 +83,58 @@ class AsyncIO {
   /** Truncate/extend file. Returns true on success. */
   virtual bool Truncate(size_t size) = 0;
 
-  /** Submit async write. Automatically selects O_DIRECT fd if buffer and
-   *  size are aligned, otherwise uses regular fd.
+  /** Alignment of buffer, size and file offset required for O_DIRECT */
+  static constexpr size_t kDirectAlignment = 4096;
+
+  /** @return true if Open got an O_DIRECT fd, so aligned I/O bypasses the
+   *  page cache */
+  virtual bool SupportsDirectIo() const { return false; }
+
+  /** @return true if the transfer can go through the O_DIRECT fd */
+  static bool IsDirectAligned(const void *buffer, size_t size, off_t offset) {
+    return reinterpret_cast<uintptr_t>(buffer) % kDirectAlignment == 0 &&
+           size % kDirectAlignment == 0 &&
+           static_cast<size_t>(offset) % kDirectAlignment == 0;
+  }
+
+  /** @return true if every segment can go through the O_DIRECT fd */
+  static bool IsDirectAligned(const IoVec *iov, size_t count, off_t offset) {
+    for (size_t i = 0; i < count; ++i) {
+      if (!IsDirectAligned(iov[i].base_, iov[i].size_, offset)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /** Submit async write. Automatically selects O_DIRECT fd if buffer, size
+   *  and offset are aligned, otherwise uses regular fd.
    *  @return IoToken for tracking, or kInvalidIoToken on failure */
   virtual IoToken Write(void *buffer, size_t size, off_t offset) = 0;
 
   /** Submit async read. Same alignment-adaptive logic as Write. */
   virtual IoToken Read(void *buffer, size_t size, off_t offset) = 0;
 
+  /** Most segments accepted by WriteV/ReadV (the kernel's IOV_MAX) */
+  static constexpr size_t kMaxIoVecs = 1024;
+
+  /** Submit async vectored write: the segments land back to back in the file
+   *  starting at offset, as one operation with one token. Uses O_DIRECT only
+   *  if every segment is aligned. The default handles a single segment and
+   *  returns kInvalidIoToken for more; callers then submit one Write each.
+   *  @param iov Segments (only needs to stay valid during the call)
+   *  @param count Number of segments, at most kMaxIoVecs */
+  virtual IoToken WriteV(const IoVec *iov, size_t count, off_t offset) {
+    if (count != 1) return kInvalidIoToken;
+    return Write(iov[0].base_, iov[0].size_, offset);
+  }
+
+  /** Submit async vectored read. Same rules as WriteV. */
+  virtual IoToken ReadV(const IoVec *iov, size_t count, off_t offset) {
+    if (count != 1) return kInvalidIoToken;
+    return Read(iov[0].base_, iov[0].size_, offset);
+  }
+
   /** Non-blocking check: is this I/O operation complete?
    *  @param token Token from Write/Read
    *  @param result Filled on completion
@@ -87,6 +146,24 @@ class AsyncIO {
 
   /** Get the eventfd for epoll integration (returns -1 if not supported) */
   virtual int GetEventFd() const = 0;
+
+  /** Declare a long-lived memory region that I/O buffers are taken from.
+   *  Backends with registered buffers pin parts of it on first use.
+   *  @return true if the backend will use registered I/O for the region */
+  virtual bool RegisterBuffer(void *base, size_t size) {
+    (void)base;
+    (void)size;
+    return false;
+  }
+
+  /** Forget every region passed to RegisterBuffer. Call it when one of them
+   *  may have been unmapped, so a new mapping at the same address is not
+   *  served from the old pinned pages */
+  virtual void UnregisterBuffers() {}
+
+  /** Submit I/O queued by Write/Read in batch mode. IsComplete also flushes.
+   *  @return Number of operations submitted */
+  virtual int Flush() { return 0; }
 };
 
 }  // namespace hshm
@@ -43,6 +43,7 @@
 
 #if HSHM_ENABLE_IO_URING
 #include "iouring_io.h"
+#include "nvme_passthru_io.h"
 #endif
 
 #if !defined(_WIN32)
@@ -65,6 +66,7 @@ enum class AsyncIoBackend {
   kPosixAio,   /**< POSIX aio_read/aio_write */
   kIocp,       /**< Windows I/O Completion Ports */
   kNixl,       /**< NIXL (Network Interface eXtension Layer) */
+  kNvmePassthru, /**< NVMe commands over io_uring URING_CMD (Linux 5.19+) */
   kDefault     /**< Auto-select best available for platform */
 };
 
@@ -72,7 +74,9 @@ class AsyncIoFactory {
  public:
   static std::unique_ptr<AsyncIO> Get(
       uint32_t io_depth,
-      AsyncIoBackend backend = AsyncIoBackend::kDefault) {
+      AsyncIoBackend backend = AsyncIoBackend::kDefault,
+      const AsyncIoOptions &opts = AsyncIoOptions()) {
+    (void)opts;  // Only the io_uring backend takes options
     if (backend == AsyncIoBackend::kDefault) {
       backend = GetDefaultBackend();
     }
@@ -85,7 +89,12 @@ class AsyncIoFactory {
 
 #if HSHM_ENABLE_IO_URING
       case AsyncIoBackend::kIoUring:
-        return std::make_unique<IoUringAsyncIO>(io_depth);
+        return std::make_unique<IoUringAsyncIO>(io_depth, opts);
+#endif
+
+#if HSHM_ENABLE_NVME_PASSTHRU
+      case AsyncIoBackend::kNvmePassthru:
+        return std::make_unique<NvmePassthruAsyncIO>(io_depth);
 #endif
 
 #if HSHM_ENABLE_NIXL
@@ -40,21 +40,42 @@
 #include <liburing.h>
 #include <sys/eventfd.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <algorithm>
 #include <cstring>
 #include <atomic>
 #include <mutex>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace hshm {
 
+/**
+ * io_uring backend. The file descriptors are registered as fixed files.
+ * AsyncIoOptions enables three further modes:
+ * - fixed_buffers_: regions passed to RegisterBuffer are pinned in chunks of
+ *   kFixedChunkSize on first use and accessed with READ_FIXED/WRITE_FIXED,
+ *   so the kernel does not map and pin the pages again on every I/O.
+ * - batch_submit_: Write/Read only fill SQEs. Flush() or the next
+ *   IsComplete submits all of them with one io_uring_enter.
+ * - sqpoll_: a kernel thread polls the SQ. Rings opened on the same path
+ *   share one thread (IORING_SETUP_ATTACH_WQ), pinned to sqpoll_cpu_ if set.
+ */
 class IoUringAsyncIO : public AsyncIO {
  public:
-  IoUringAsyncIO(uint32_t io_depth)
+  /** Largest piece of a region pinned as one fixed buffer (kernel max 1GB) */
+  static constexpr size_t kFixedChunkSize = 256ULL * 1024 * 1024;
+  /** Slots in the sparse fixed-buffer table */
+  static constexpr unsigned kMaxFixedBuffers = 1024;
+
+  explicit IoUringAsyncIO(uint32_t io_depth,
+                          const AsyncIoOptions &opts = AsyncIoOptions())
       : initialized_(false), event_fd_(-1), direct_fd_(-1), regular_fd_(-1),
-        io_depth_(io_depth), next_token_(1) {
+        io_depth_(io_depth), opts_(opts), next_token_(1) {
     memset(&ring_, 0, sizeof(ring_));
   }
 
@@ -74,17 +95,21 @@ class IoUringAsyncIO : public AsyncIO {
 
     direct_fd_ = open(path.c_str(), base_flags | O_DIRECT, mode);
 
-    int ret = io_uring_queue_init(io_depth_, &ring_, 0);
-    if (ret < 0) {
+    if (!InitRing(path)) {
       close(regular_fd_); regular_fd_ = -1;
       if (direct_fd_ >= 0) { close(direct_fd_); direct_fd_ = -1; }
       return false;
     }
     initialized_ = true;
+    RegisterFiles();
+    if (opts_.fixed_buffers_) {
+      fixed_buffers_ =
+          io_uring_register_buffers_sparse(&ring_, kMaxFixedBuffers) == 0;
+    }
 
     event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
     if (event_fd_ >= 0) {
-      ret = io_uring_register_eventfd(&ring_, event_fd_);
+      int ret = io_uring_register_eventfd(&ring_, event_fd_);
       if (ret < 0) {
         close(event_fd_);
         event_fd_ = -1;
@@ -116,6 +141,14 @@ class IoUringAsyncIO : public AsyncIO {
     return SubmitIO(buffer, size, offset, false);
   }
 
+  IoToken WriteV(const IoVec *iov, size_t count, off_t offset) override {
+    return SubmitIOV(iov, count, offset, true);
+  }
+
+  IoToken ReadV(const IoVec *iov, size_t count, off_t offset) override {
+    return SubmitIOV(iov, count, offset, false);
+  }
+
   bool IsComplete(IoToken token, IoResult &result) override {
     std::lock_guard<std::mutex> lock(mutex_);
 
@@ -127,6 +160,7 @@ class IoUringAsyncIO : public AsyncIO {
       return true;
     }
 
+    SubmitPending();
     HarvestCompletions();
 
     it = completed_.find(token);
@@ -147,6 +181,7 @@ class IoUringAsyncIO : public AsyncIO {
       event_fd_ = -1;
     }
     if (initialized_) {
+      ReleaseSqPollOwner();
       io_uring_queue_exit(&ring_);
       initialized_ = false;
     }
@@ -158,68 +193,307 @@ class IoUringAsyncIO : public AsyncIO {
       close(regular_fd_);
       regular_fd_ = -1;
     }
+    fixed_files_ = false;
+    fixed_buffers_ = false;
+    sqpoll_ = false;
+    pending_ = 0;
+    fixed_regions_.clear();
+    fixed_chunks_.clear();
+    next_fixed_slot_ = 0;
     in_flight_.clear();
     completed_.clear();
+    iovecs_.clear();
   }
 
   int GetEventFd() const override {
     return event_fd_;
   }
 
+  bool SupportsDirectIo() const override {
+    return direct_fd_ >= 0;
+  }
+
+  bool RegisterBuffer(void *base, size_t size) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!fixed_buffers_ || base == nullptr || size == 0) {
+      return false;
+    }
+    uintptr_t addr = reinterpret_cast<uintptr_t>(base);
+    for (const FixedRegion &region : fixed_regions_) {
+      if (region.base_ == addr && region.size_ == size) {
+        return true;
+      }
+    }
+    fixed_regions_.push_back(FixedRegion{addr, size});
+    return true;
+  }
+
+  void UnregisterBuffers() override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fixed_buffers_ && next_fixed_slot_ > 0) {
+      // Empty iovecs clear the slots; in-flight I/O keeps its pages pinned
+      std::vector<struct iovec> empty(next_fixed_slot_);
+      memset(empty.data(), 0, empty.size() * sizeof(struct iovec));
+      io_uring_register_buffers_update_tag(&ring_, 0, empty.data(), nullptr,
+                                           next_fixed_slot_);
+    }
+    fixed_regions_.clear();
+    fixed_chunks_.clear();
+    next_fixed_slot_ = 0;
+  }
+
+  int Flush() override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::max(SubmitPending(), 0);
+  }
+
+  /** @return true if a kernel SQ poll thread serves this ring */
+  bool IsSqPoll() const { return sqpoll_; }
+
+  /** @return true if fixed buffers were requested and the kernel took them */
+  bool HasFixedBuffers() const { return fixed_buffers_; }
+
  private:
+  /** Region declared through RegisterBuffer */
+  struct FixedRegion {
+    uintptr_t base_;
+    size_t size_;
+  };
+
+  /** SQ poll rings by file path, so the rings of one device share a thread */
+  struct SqPollRegistry {
+    std::mutex lock_;
+    std::unordered_map<std::string, int> owners_;
+  };
+
+  static SqPollRegistry &GetSqPollRegistry() {
+    static SqPollRegistry registry;
+    return registry;
+  }
+
+  /**
+   * Create the ring. With sqpoll_ set, attach to the device's existing SQ
+   * thread or become its owner, and fall back to a plain ring if the kernel
+   * refuses SQPOLL (e.g. missing privileges before Linux 5.11).
+   * @return true if a ring was created
+   */
+  bool InitRing(const std::string &path) {
+    if (!opts_.sqpoll_) {
+      return io_uring_queue_init(io_depth_, &ring_, 0) == 0;
+    }
+    SqPollRegistry &registry = GetSqPollRegistry();
+    std::lock_guard<std::mutex> lock(registry.lock_);
+    auto owner = registry.owners_.find(path);
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_SQPOLL;
+    params.sq_thread_idle = opts_.sqpoll_idle_ms_;
+    if (opts_.sqpoll_cpu_ >= 0) {
+      params.flags |= IORING_SETUP_SQ_AFF;
+      params.sq_thread_cpu = static_cast<uint32_t>(opts_.sqpoll_cpu_);
+    }
+    if (owner != registry.owners_.end()) {
+      struct io_uring_params attach = params;
+      attach.flags |= IORING_SETUP_ATTACH_WQ;
+      attach.wq_fd = static_cast<uint32_t>(owner->second);
+      if (io_uring_queue_init_params(io_depth_, &ring_, &attach) == 0) {
+        sqpoll_ = true;
+        return true;
+      }
+    }
+    if (io_uring_queue_init_params(io_depth_, &ring_, &params) == 0) {
+      sqpoll_ = true;
+      if (owner == registry.owners_.end()) {
+        sqpoll_path_ = path;
+        registry.owners_[path] = ring_.ring_fd;
+      }
+      return true;
+    }
+    return io_uring_queue_init(io_depth_, &ring_, 0) == 0;
+  }
+
+  /** Drop this ring from the SQ poll registry if it owns the entry */
+  void ReleaseSqPollOwner() {
+    if (sqpoll_path_.empty()) {
+      return;
+    }
+    SqPollRegistry &registry = GetSqPollRegistry();
+    std::lock_guard<std::mutex> lock(registry.lock_);
+    auto owner = registry.owners_.find(sqpoll_path_);
+    if (owner != registry.owners_.end() && owner->second == ring_.ring_fd) {
+      registry.owners_.erase(owner);
+    }
+    sqpoll_path_.clear();
+  }
+
+  /** Register the file descriptors: slot 0 is regular, slot 1 O_DIRECT */
+  void RegisterFiles() {
+    int fds[2] = {regular_fd_, direct_fd_};
+    unsigned count = direct_fd_ >= 0 ? 2 : 1;
+    fixed_files_ = io_uring_register_files(&ring_, fds, count) == 0;
+  }
+
   IoToken SubmitIO(void *buffer, size_t size, off_t offset, bool is_write) {
     std::lock_guard<std::mutex> lock(mutex_);
+    if (!initialized_) return kInvalidIoToken;
 
-    struct io_uring_sqe *sqe = io_uring_get_sqe(&ring_);
+    struct io_uring_sqe *sqe = GetSqe();
     if (!sqe) return kInvalidIoToken;
 
-    int fd = SelectFd(buffer, size);
+    int fd = SelectFd(IsDirectAligned(buffer, size, offset));
+    int buf_index = FindFixedBuffer(buffer, size);
     IoToken token = next_token_.fetch_add(1);
 
-    if (is_write) {
+    if (buf_index >= 0 && is_write) {
+      io_uring_prep_write_fixed(sqe, fd, buffer, size, offset, buf_index);
+    } else if (buf_index >= 0) {
+      io_uring_prep_read_fixed(sqe, fd, buffer, size, offset, buf_index);
+    } else if (is_write) {
       io_uring_prep_write(sqe, fd, buffer, size, offset);
     } else {
       io_uring_prep_read(sqe, fd, buffer, size, offset);
     }
+    return Enqueue(sqe, token) ? token : kInvalidIoToken;
+  }
+
+  IoToken SubmitIOV(const IoVec *iov, size_t count, off_t offset,
+                    bool is_write) {
+    if (count == 0 || count > kMaxIoVecs) return kInvalidIoToken;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!initialized_) return kInvalidIoToken;
 
+    struct io_uring_sqe *sqe = GetSqe();
+    if (!sqe) return kInvalidIoToken;
+
+    // The kernel reads the iovec array when it consumes the SQE, which may be
+    // after this call returns (batch mode, SQPOLL), so keep it until the CQE
+    IoToken token = next_token_.fetch_add(1);
+    std::vector<struct iovec> &iovecs = iovecs_[token];
+    iovecs.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+      iovecs[i].iov_base = iov[i].base_;
+      iovecs[i].iov_len = iov[i].size_;
+    }
+
+    int fd = SelectFd(IsDirectAligned(iov, count, offset));
+    if (is_write) {
+      io_uring_prep_writev(sqe, fd, iovecs.data(),
+                           static_cast<unsigned>(count), offset);
+    } else {
+      io_uring_prep_readv(sqe, fd, iovecs.data(),
+                          static_cast<unsigned>(count), offset);
+    }
+    return Enqueue(sqe, token) ? token : kInvalidIoToken;
+  }
+
+  /** Tag a prepared SQE and submit it unless batching. @return success */
+  bool Enqueue(struct io_uring_sqe *sqe, IoToken token) {
+    if (fixed_files_) {
+      sqe->flags |= IOSQE_FIXED_FILE;
+    }
     io_uring_sqe_set_data64(sqe, token);
+    ++pending_;
 
-    int ret = io_uring_submit(&ring_);
-    if (ret <= 0) return kInvalidIoToken;
+    if (!opts_.batch_submit_ && SubmitPending() <= 0) return false;
 
     in_flight_.insert(token);
-    return token;
+    return true;
+  }
+
+  /** Get an SQE, submitting the queued batch first if the SQ is full */
+  struct io_uring_sqe *GetSqe() {
+    struct io_uring_sqe *sqe = io_uring_get_sqe(&ring_);
+    if (!sqe && pending_ > 0 && SubmitPending() > 0) {
+      sqe = io_uring_get_sqe(&ring_);
+    }
+    return sqe;
+  }
+
+  /** Submit every queued SQE. @return io_uring_submit result, 0 if none */
+  int SubmitPending() {
+    if (pending_ == 0) return 0;
+    int ret = io_uring_submit(&ring_);
+    if (ret >= 0) pending_ = 0;
+    return ret;
+  }
+
+  /** @return fd (or fixed-file slot), O_DIRECT if aligned and available */
+  int SelectFd(bool aligned) const {
+    bool direct = aligned && direct_fd_ >= 0;
+    if (fixed_files_) {
+      return direct ? 1 : 0;
+    }
+    return direct ? direct_fd_ : regular_fd_;
   }
 
-  int SelectFd(void *buffer, size_t size) const {
-    if (direct_fd_ >= 0 &&
-        (reinterpret_cast<uintptr_t>(buffer) % 4096 == 0) &&
-        (size % 4096 == 0)) {
-      return direct_fd_;
+  /**
+   * Find the fixed buffer covering [buffer, buffer + size), pinning the
+   * chunk of its region on first use.
+   * @return Fixed buffer index, or -1 to use a plain read/write
+   */
+  int FindFixedBuffer(void *buffer, size_t size) {
+    if (!fixed_buffers_) return -1;
+    uintptr_t addr = reinterpret_cast<uintptr_t>(buffer);
+    for (const FixedRegion &region : fixed_regions_) {
+      uintptr_t end = region.base_ + region.size_;
+      if (addr < region.base_ || addr + size > end) continue;
+      uintptr_t chunk = region.base_ + (addr - region.base_) /
+                                           kFixedChunkSize * kFixedChunkSize;
+      size_t chunk_size = std::min<size_t>(kFixedChunkSize, end - chunk);
+      if (addr + size > chunk + chunk_size) return -1;  // Spans two chunks
+      return PinChunk(chunk, chunk_size);
     }
-    return regular_fd_;
+    return -1;
+  }
+
+  /**
+   * Install a chunk in the next free fixed-buffer slot. A chunk the kernel
+   * refuses (e.g. over RLIMIT_MEMLOCK) is remembered and not retried.
+   * @return Fixed buffer index, or -1 if the chunk cannot be registered
+   */
+  int PinChunk(uintptr_t chunk, size_t chunk_size) {
+    auto it = fixed_chunks_.find(chunk);
+    if (it != fixed_chunks_.end()) return it->second;
+    if (next_fixed_slot_ >= kMaxFixedBuffers) return -1;
+    struct iovec iov;
+    iov.iov_base = reinterpret_cast<void *>(chunk);
+    iov.iov_len = chunk_size;
+    int slot = -1;
+    if (io_uring_register_buffers_update_tag(&ring_, next_fixed_slot_, &iov,
+                                             nullptr, 1) == 1) {
+      slot = static_cast<int>(next_fixed_slot_++);
+    }
+    fixed_chunks_[chunk] = slot;
+    return slot;
   }
 
   void HarvestCompletions() {
-    const int kMaxEvents = 32;
+    const unsigned kMaxEvents = 32;
     struct io_uring_cqe *cqes[kMaxEvents];
-    unsigned count = io_uring_peek_batch_cqe(&ring_, cqes, kMaxEvents);
-
-    for (unsigned i = 0; i < count; ++i) {
-      IoToken token = io_uring_cqe_get_data64(cqes[i]);
-      IoResult res;
-      if (cqes[i]->res < 0) {
-        res.bytes_transferred = -1;
-        res.error_code = -cqes[i]->res;
-      } else {
-        res.bytes_transferred = cqes[i]->res;
-        res.error_code = 0;
+    unsigned total = 0;
+    unsigned count;
+    do {
+      count = io_uring_peek_batch_cqe(&ring_, cqes, kMaxEvents);
+      for (unsigned i = 0; i < count; ++i) {
+        IoToken token = io_uring_cqe_get_data64(cqes[i]);
+        IoResult res;
+        if (cqes[i]->res < 0) {
+          res.bytes_transferred = -1;
+          res.error_code = -cqes[i]->res;
+        } else {
+          res.bytes_transferred = cqes[i]->res;
+          res.error_code = 0;
+        }
+        completed_[token] = res;
+        if (!iovecs_.empty()) {
+          iovecs_.erase(token);
+        }
       }
-      completed_[token] = res;
-      io_uring_cqe_seen(&ring_, cqes[i]);
-    }
+      io_uring_cq_advance(&ring_, count);
+      total += count;
+    } while (count == kMaxEvents);
 
-    if (count > 0 && event_fd_ >= 0) {
+    if (total > 0 && event_fd_ >= 0) {
       uint64_t val;
       ssize_t ret = read(event_fd_, &val, sizeof(val));
       (void)ret;
@@ -232,10 +506,20 @@ class IoUringAsyncIO : public AsyncIO {
   int direct_fd_;
   int regular_fd_;
   uint32_t io_depth_;
+  AsyncIoOptions opts_;
+  bool fixed_files_ = false;
+  bool fixed_buffers_ = false;
+  bool sqpoll_ = false;
+  std::string sqpoll_path_;      /**< Set if this ring owns the SQ thread */
+  unsigned pending_ = 0;         /**< SQEs filled but not yet submitted */
+  std::vector<FixedRegion> fixed_regions_;
+  std::unordered_map<uintptr_t, int> fixed_chunks_;  /**< chunk -> slot */
+  unsigned next_fixed_slot_ = 0;
   std::atomic<IoToken> next_token_;
   std::mutex mutex_;
   std::unordered_set<IoToken> in_flight_;
   std::unordered_map<IoToken, IoResult> completed_;
+  std::unordered_map<IoToken, std::vector<struct iovec>> iovecs_;  /**< ReadV/WriteV */
 };
 
 }  // namespace hshm
@@ -48,6 +48,7 @@
 #include <mutex>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace hshm {
 
@@ -123,6 +124,14 @@ class LinuxAioAsyncIO : public AsyncIO {
     return SubmitIO(buffer, size, offset, false);
   }
 
+  IoToken WriteV(const IoVec *iov, size_t count, off_t offset) override {
+    return SubmitIOV(iov, count, offset, true);
+  }
+
+  IoToken ReadV(const IoVec *iov, size_t count, off_t offset) override {
+    return SubmitIOV(iov, count, offset, false);
+  }
+
   bool IsComplete(IoToken token, IoResult &result) override {
     std::lock_guard<std::mutex> lock(mutex_);
 
@@ -176,12 +185,16 @@ class LinuxAioAsyncIO : public AsyncIO {
     return event_fd_;
   }
 
+  bool SupportsDirectIo() const override {
+    return direct_fd_ >= 0;
+  }
+
  private:
   IoToken SubmitIO(void *buffer, size_t size, off_t offset, bool is_write) {
     std::lock_guard<std::mutex> lock(mutex_);
 
     // Select fd based on alignment
-    int fd = SelectFd(buffer, size);
+    int fd = SelectFd(buffer, size, offset);
 
     IoToken token = next_token_.fetch_add(1);
 
@@ -208,11 +221,51 @@ class LinuxAioAsyncIO : public AsyncIO {
     return token;
   }
 
-  int SelectFd(void *buffer, size_t size) const {
-    // Use O_DIRECT fd if available and buffer+size are page-aligned
-    if (direct_fd_ >= 0 &&
-        (reinterpret_cast<uintptr_t>(buffer) % 4096 == 0) &&
-        (size % 4096 == 0)) {
+  IoToken SubmitIOV(const IoVec *iov, size_t count, off_t offset,
+                    bool is_write) {
+    if (count == 0 || count > kMaxIoVecs) return kInvalidIoToken;
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    int fd = regular_fd_;
+    if (direct_fd_ >= 0 && IsDirectAligned(iov, count, offset)) {
+      fd = direct_fd_;
+    }
+
+    IoToken token = next_token_.fetch_add(1);
+
+    // io_submit copies the iovec array, so a local one is enough
+    std::vector<struct iovec> iovecs(count);
+    for (size_t i = 0; i < count; ++i) {
+      iovecs[i].iov_base = iov[i].base_;
+      iovecs[i].iov_len = iov[i].size_;
+    }
+
+    struct iocb iocb_storage;
+    struct iocb *iocb = &iocb_storage;
+    memset(iocb, 0, sizeof(struct iocb));
+
+    if (is_write) {
+      io_prep_pwritev(iocb, fd, iovecs.data(), static_cast<int>(count), offset);
+    } else {
+      io_prep_preadv(iocb, fd, iovecs.data(), static_cast<int>(count), offset);
+    }
+
+    io_set_eventfd(iocb, event_fd_);
+    iocb->data = reinterpret_cast<void *>(token);
+
+    struct iocb *iocbs[1] = {iocb};
+    int submitted = io_submit(aio_ctx_, 1, iocbs);
+    if (submitted != 1) {
+      return kInvalidIoToken;
+    }
+
+    in_flight_.insert(token);
+    return token;
+  }
+
+  int SelectFd(void *buffer, size_t size, off_t offset) const {
+    // Use O_DIRECT fd if available and buffer, size and offset are aligned
+    if (direct_fd_ >= 0 && IsDirectAligned(buffer, size, offset)) {
       return direct_fd_;
     }
     return regular_fd_;
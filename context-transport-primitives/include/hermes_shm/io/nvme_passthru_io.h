@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HSHM_SHM_INCLUDE_HSHM_SHM_IO_NVME_PASSTHRU_IO_H_
+#define HSHM_SHM_INCLUDE_HSHM_SHM_IO_NVME_PASSTHRU_IO_H_
+
+#if HSHM_ENABLE_IO_URING
+
+#include "async_io.h"
+#include <liburing.h>
+#include <linux/nvme_ioctl.h>
+#include <sys/ioctl.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#ifdef NVME_URING_CMD_IO
+#define HSHM_ENABLE_NVME_PASSTHRU 1
+
+namespace hshm {
+
+/**
+ * NVMe backend over io_uring passthrough (IORING_OP_URING_CMD, Linux 5.19+).
+ * Open takes the namespace's generic char device (/dev/ngXnY) and reads the
+ * LBA format with Identify Namespace. Write/Read become NVMe Write/Read
+ * commands sent straight to the driver's queues, bypassing the block layer
+ * and the page cache, split at the controller's max transfer size (MDTS).
+ * The ring is polled (IORING_SETUP_IOPOLL) when the kernel allows it, so
+ * IsComplete reaps completions without interrupts; this needs poll queues
+ * (nvme.poll_queues=N), else the ring falls back to interrupt completions.
+ * Offset and size must be multiples of the LBA size and the buffer must
+ * stay valid until completion.
+ */
+class NvmePassthruAsyncIO : public AsyncIO {
+ public:
+  /** Transfer cap when the controller reports no MDTS limit */
+  static constexpr size_t kDefaultMaxTransfer = 1024 * 1024;
+
+  explicit NvmePassthruAsyncIO(uint32_t io_depth)
+      : initialized_(false), fd_(-1), nsid_(0), lba_size_(0), num_lbas_(0),
+        max_transfer_(kDefaultMaxTransfer), io_depth_(io_depth),
+        next_token_(1) {
+    memset(&ring_, 0, sizeof(ring_));
+  }
+
+  ~NvmePassthruAsyncIO() override {
+    Close();
+  }
+
+  /** Open an NVMe generic char device. flags/mode are ignored: the device
+   *  is always opened read-write and never created. */
+  bool Open(const std::string &path, int flags, mode_t mode) override {
+    (void)flags;
+    (void)mode;
+    std::lock_guard<std::mutex> lock(mutex_);
+    fd_ = open(path.c_str(), O_RDWR);
+    if (fd_ < 0) {
+      return false;
+    }
+    int nsid = ioctl(fd_, NVME_IOCTL_ID);
+    if (nsid <= 0 || !IdentifyNamespace(static_cast<uint32_t>(nsid))) {
+      close(fd_); fd_ = -1;
+      return false;
+    }
+    nsid_ = static_cast<uint32_t>(nsid);
+    IdentifyController();
+    if (!InitRing()) {
+      close(fd_); fd_ = -1;
+      return false;
+    }
+    initialized_ = true;
+    return true;
+  }
+
+  /** @return Namespace capacity in bytes */
+  ssize_t GetFileSize() const override {
+    if (fd_ < 0) return -1;
+    return static_cast<ssize_t>(num_lbas_ * lba_size_);
+  }
+
+  /** The namespace has a fixed size: succeeds if it is large enough */
+  bool Truncate(size_t size) override {
+    return fd_ >= 0 && size <= num_lbas_ * lba_size_;
+  }
+
+  bool SupportsDirectIo() const override {
+    return fd_ >= 0;
+  }
+
+  IoToken Write(void *buffer, size_t size, off_t offset) override {
+    return SubmitIO(buffer, size, offset, true);
+  }
+
+  IoToken Read(void *buffer, size_t size, off_t offset) override {
+    return SubmitIO(buffer, size, offset, false);
+  }
+
+  bool IsComplete(IoToken token, IoResult &result) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ops_.find(token);
+    if (it == ops_.end()) {
+      return false;
+    }
+    if (it->second.remaining_ > 0) {
+      HarvestCompletions();
+    }
+    if (it->second.remaining_ > 0) {
+      return false;
+    }
+    result.error_code = it->second.error_;
+    result.bytes_transferred =
+        it->second.error_ ? -1 : static_cast<ssize_t>(it->second.bytes_);
+    ops_.erase(it);
+    return true;
+  }
+
+  void Close() override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (initialized_) {
+      io_uring_queue_exit(&ring_);
+      initialized_ = false;
+    }
+    if (fd_ >= 0) {
+      close(fd_);
+      fd_ = -1;
+    }
+    polled_ = false;
+    ops_.clear();
+  }
+
+  /** Completions are polled, so there is nothing to wait on */
+  int GetEventFd() const override {
+    return -1;
+  }
+
+  /** @return Bytes per logical block of the namespace */
+  size_t GetLbaSize() const { return lba_size_; }
+
+  /** @return true if completions are polled (IORING_SETUP_IOPOLL) */
+  bool IsPolled() const { return polled_; }
+
+ private:
+  /** NVMe opcodes used by this backend */
+  static constexpr uint8_t kNvmeCmdWrite = 0x01;
+  static constexpr uint8_t kNvmeCmdRead = 0x02;
+  static constexpr uint8_t kNvmeAdminIdentify = 0x06;
+  static constexpr uint32_t kCnsNamespace = 0x00;
+  static constexpr uint32_t kCnsController = 0x01;
+  static constexpr size_t kIdentifySize = 4096;
+
+  /** An I/O split into remaining_ NVMe commands sharing one token */
+  struct PassthruOp {
+    uint32_t remaining_;
+    size_t bytes_;
+    int error_;
+  };
+
+  /** Run an Identify admin command into a 4KB buffer. @return success */
+  bool Identify(uint32_t nsid, uint32_t cns, void *data) {
+    struct nvme_passthru_cmd cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.opcode = kNvmeAdminIdentify;
+    cmd.nsid = nsid;
+    cmd.addr = reinterpret_cast<uint64_t>(data);
+    cmd.data_len = kIdentifySize;
+    cmd.cdw10 = cns;
+    return ioctl(fd_, NVME_IOCTL_ADMIN_CMD, &cmd) == 0;
+  }
+
+  /** Read the namespace size and the LBA size of its current format */
+  bool IdentifyNamespace(uint32_t nsid) {
+    void *data = nullptr;
+    if (posix_memalign(&data, kDirectAlignment, kIdentifySize) != 0) {
+      return false;
+    }
+    bool ok = Identify(nsid, kCnsNamespace, data);
+    if (ok) {
+      const uint8_t *id = static_cast<const uint8_t *>(data);
+      memcpy(&num_lbas_, id, sizeof(num_lbas_));  // NSZE, bytes 0-7
+      uint8_t flbas = id[26];
+      uint32_t format = (flbas & 0x0F) | (((flbas >> 5) & 0x03) << 4);
+      uint8_t lbads = id[128 + 4 * format + 2];  // LBAF[format].LBADS
+      lba_size_ = lbads >= 9 ? (static_cast<size_t>(1) << lbads) : 0;
+      ok = lba_size_ != 0 && num_lbas_ != 0;
+    }
+    free(data);
+    return ok;
+  }
+
+  /** Read MDTS to cap the size of one command. Failure keeps the default. */
+  void IdentifyController() {
+    void *data = nullptr;
+    if (posix_memalign(&data, kDirectAlignment, kIdentifySize) != 0) {
+      return;
+    }
+    // MDTS (byte 77) is a power of two in units of the minimum page size,
+    // assumed to be 4KB (CAP.MPSMIN is not visible through the char device)
+    if (Identify(0, kCnsController, data)) {
+      uint8_t mdts = static_cast<const uint8_t *>(data)[77];
+      if (mdts != 0 && mdts < 20) {
+        max_transfer_ = static_cast<size_t>(4096) << mdts;
+      }
+    }
+    max_transfer_ = std::max(max_transfer_ / lba_size_ * lba_size_,
+                             lba_size_);
+    free(data);
+  }
+
+  /** Create the 128-byte-SQE / 32-byte-CQE ring passthrough requires,
+   *  polled if the kernel accepts IOPOLL for it. @return success */
+  bool InitRing() {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_SQE128 | IORING_SETUP_CQE32 |
+                   IORING_SETUP_IOPOLL;
+    if (io_uring_queue_init_params(io_depth_, &ring_, &params) == 0) {
+      polled_ = true;
+      return true;
+    }
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_SQE128 | IORING_SETUP_CQE32;
+    return io_uring_queue_init_params(io_depth_, &ring_, &params) == 0;
+  }
+
+  IoToken SubmitIO(void *buffer, size_t size, off_t offset, bool is_write) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!initialized_ || size == 0 || size % lba_size_ != 0 ||
+        static_cast<size_t>(offset) % lba_size_ != 0 ||
+        static_cast<size_t>(offset) + size > num_lbas_ * lba_size_) {
+      return kInvalidIoToken;
+    }
+    IoToken token = next_token_.fetch_add(1);
+    PassthruOp &op = ops_[token];
+    op.remaining_ = 0;
+    op.bytes_ = 0;
+    op.error_ = 0;
+    char *data = static_cast<char *>(buffer);
+    for (size_t done = 0; done < size;) {
+      size_t len = std::min(max_transfer_, size - done);
+      struct io_uring_sqe *sqe = GetSqe();
+      if (!sqe) {
+        op.error_ = EAGAIN;
+        break;
+      }
+      PrepCommand(sqe, data + done, len, offset + done, is_write);
+      io_uring_sqe_set_data64(sqe, token);
+      ++op.remaining_;
+      op.bytes_ += len;
+      done += len;
+    }
+    if (op.remaining_ == 0) {
+      ops_.erase(token);
+      return kInvalidIoToken;
+    }
+    // A failed submit leaves the SQEs queued; the next submit sends them
+    io_uring_submit(&ring_);
+    return token;
+  }
+
+  /** Fill a URING_CMD SQE with one NVMe Read/Write command */
+  void PrepCommand(struct io_uring_sqe *sqe, void *data, size_t len,
+                   size_t offset, bool is_write) {
+    sqe->opcode = IORING_OP_URING_CMD;
+    sqe->fd = fd_;
+    sqe->cmd_op = NVME_URING_CMD_IO;
+    struct nvme_uring_cmd *cmd =
+        reinterpret_cast<struct nvme_uring_cmd *>(sqe->cmd);
+    memset(cmd, 0, sizeof(*cmd));
+    uint64_t slba = offset / lba_size_;
+    cmd->opcode = is_write ? kNvmeCmdWrite : kNvmeCmdRead;
+    cmd->nsid = nsid_;
+    cmd->addr = reinterpret_cast<uint64_t>(data);
+    cmd->data_len = static_cast<uint32_t>(len);
+    cmd->cdw10 = static_cast<uint32_t>(slba);
+    cmd->cdw11 = static_cast<uint32_t>(slba >> 32);
+    cmd->cdw12 = static_cast<uint32_t>(len / lba_size_ - 1);  // 0-based NLB
+  }
+
+  /** Get an SQE, submitting and reaping first if the SQ is full */
+  struct io_uring_sqe *GetSqe() {
+    struct io_uring_sqe *sqe = io_uring_get_sqe(&ring_);
+    if (!sqe && io_uring_submit(&ring_) >= 0) {
+      HarvestCompletions();
+      sqe = io_uring_get_sqe(&ring_);
+    }
+    return sqe;
+  }
+
+  /** Reap CQEs. On a polled ring this enters the kernel to poll the NVMe
+   *  completion queue; otherwise it only reads the CQ ring. */
+  void HarvestCompletions() {
+    if (polled_) {
+      io_uring_submit_and_get_events(&ring_);
+    }
+    const unsigned kMaxEvents = 32;
+    struct io_uring_cqe *cqes[kMaxEvents];
+    unsigned count;
+    do {
+      count = io_uring_peek_batch_cqe(&ring_, cqes, kMaxEvents);
+      for (unsigned i = 0; i < count; ++i) {
+        auto it = ops_.find(io_uring_cqe_get_data64(cqes[i]));
+        if (it == ops_.end()) continue;
+        PassthruOp &op = it->second;
+        // res < 0 is an errno, res > 0 an NVMe status code
+        if (cqes[i]->res != 0 && op.error_ == 0) {
+          op.error_ = cqes[i]->res < 0 ? -cqes[i]->res : EIO;
+        }
+        --op.remaining_;
+      }
+      io_uring_cq_advance(&ring_, count);
+    } while (count == kMaxEvents);
+  }
+
+  struct io_uring ring_;
+  bool initialized_;
+  bool polled_ = false;
+  int fd_;
+  uint32_t nsid_;
+  size_t lba_size_;
+  uint64_t num_lbas_;
+  size_t max_transfer_;  /**< Largest single NVMe command in bytes */
+  uint32_t io_depth_;
+  std::atomic<IoToken> next_token_;
+  std::mutex mutex_;
+  std::unordered_map<IoToken, PassthruOp> ops_;
+};
+
+}  // namespace hshm
+
+#endif  // NVME_URING_CMD_IO
+
+#endif  // HSHM_ENABLE_IO_URING
+
+#endif  // HSHM_SHM_INCLUDE_HSHM_SHM_IO_NVME_PASSTHRU_IO_H_
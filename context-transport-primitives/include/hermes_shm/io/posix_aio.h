@@ -47,6 +47,7 @@
 #include <mutex>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 
 namespace hshm {
 
@@ -96,23 +97,37 @@ class PosixAsyncIO : public AsyncIO {
     return SubmitIO(buffer, size, offset, false);
   }
 
+  /** POSIX AIO has no vectored call: each segment gets its own aiocb and
+   *  the token completes when all of them have */
+  IoToken WriteV(const IoVec *iov, size_t count, off_t offset) override {
+    return SubmitIOV(iov, count, offset, true);
+  }
+
+  IoToken ReadV(const IoVec *iov, size_t count, off_t offset) override {
+    return SubmitIOV(iov, count, offset, false);
+  }
+
   bool IsComplete(IoToken token, IoResult &result) override {
     std::lock_guard<std::mutex> lock(mutex_);
 
     auto it = pending_.find(token);
     if (it == pending_.end()) return false;
 
-    int err = aio_error(it->second.get());
-    if (err == EINPROGRESS) return false;
-
-    if (err == 0) {
-      ssize_t bytes = aio_return(it->second.get());
-      result.bytes_transferred = bytes;
-      result.error_code = 0;
-    } else {
-      aio_return(it->second.get());
-      result.bytes_transferred = -1;
-      result.error_code = err;
+    for (const auto &cb : it->second) {
+      if (aio_error(cb.get()) == EINPROGRESS) return false;
+    }
+
+    result.bytes_transferred = 0;
+    result.error_code = 0;
+    for (const auto &cb : it->second) {
+      int err = aio_error(cb.get());
+      ssize_t bytes = aio_return(cb.get());
+      if (err != 0 && result.error_code == 0) {
+        result.bytes_transferred = -1;
+        result.error_code = err;
+      } else if (result.error_code == 0) {
+        result.bytes_transferred += bytes;
+      }
     }
 
     pending_.erase(it);
@@ -124,7 +139,9 @@ class PosixAsyncIO : public AsyncIO {
 
     // Cancel pending operations
     for (auto &kv : pending_) {
-      aio_cancel(regular_fd_, kv.second.get());
+      for (auto &cb : kv.second) {
+        aio_cancel(cb->aio_fildes, cb.get());
+      }
     }
     pending_.clear();
 
@@ -142,50 +159,75 @@ class PosixAsyncIO : public AsyncIO {
     return -1;  // POSIX AIO does not support eventfd
   }
 
+  bool SupportsDirectIo() const override {
+    return direct_fd_ >= 0;
+  }
+
  private:
   IoToken SubmitIO(void *buffer, size_t size, off_t offset, bool is_write) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    int fd = SelectFd(buffer, size);
-    IoToken token = next_token_.fetch_add(1);
-
-    auto cb = std::make_unique<struct aiocb>();
-    memset(cb.get(), 0, sizeof(struct aiocb));
+    IoVec iov{buffer, size};
+    return SubmitIOV(&iov, 1, offset, is_write);
+  }
 
-    cb->aio_fildes = fd;
-    cb->aio_buf = buffer;
-    cb->aio_nbytes = size;
-    cb->aio_offset = offset;
+  IoToken SubmitIOV(const IoVec *iov, size_t count, off_t offset,
+                    bool is_write) {
+    if (count == 0 || count > kMaxIoVecs) return kInvalidIoToken;
+    std::lock_guard<std::mutex> lock(mutex_);
 
-    int ret;
-    if (is_write) {
-      ret = aio_write(cb.get());
-    } else {
-      ret = aio_read(cb.get());
+    int fd = regular_fd_;
+    if (direct_fd_ >= 0 && IsDirectAligned(iov, count, offset)) {
+      fd = direct_fd_;
     }
+    IoToken token = next_token_.fetch_add(1);
 
-    if (ret != 0) {
-      return kInvalidIoToken;
+    std::vector<std::unique_ptr<struct aiocb>> cbs;
+    cbs.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      auto cb = std::make_unique<struct aiocb>();
+      memset(cb.get(), 0, sizeof(struct aiocb));
+
+      cb->aio_fildes = fd;
+      cb->aio_buf = iov[i].base_;
+      cb->aio_nbytes = iov[i].size_;
+      cb->aio_offset = offset;
+      offset += static_cast<off_t>(iov[i].size_);
+
+      int ret;
+      if (is_write) {
+        ret = aio_write(cb.get());
+      } else {
+        ret = aio_read(cb.get());
+      }
+
+      if (ret != 0) {
+        // Segments already queued still reference the caller's buffers
+        WaitAll(cbs);
+        return kInvalidIoToken;
+      }
+      cbs.push_back(std::move(cb));
     }
 
-    pending_[token] = std::move(cb);
+    pending_[token] = std::move(cbs);
     return token;
   }
 
-  int SelectFd(void *buffer, size_t size) const {
-    if (direct_fd_ >= 0 &&
-        (reinterpret_cast<uintptr_t>(buffer) % 4096 == 0) &&
-        (size % 4096 == 0)) {
-      return direct_fd_;
+  /** Block until every queued aiocb has finished, then reap them */
+  static void WaitAll(const std::vector<std::unique_ptr<struct aiocb>> &cbs) {
+    for (const auto &cb : cbs) {
+      const struct aiocb *list[1] = {cb.get()};
+      while (aio_error(cb.get()) == EINPROGRESS) {
+        aio_suspend(list, 1, nullptr);
+      }
+      aio_return(cb.get());
     }
-    return regular_fd_;
   }
 
   int direct_fd_;
   int regular_fd_;
   std::atomic<IoToken> next_token_;
   std::mutex mutex_;
-  std::unordered_map<IoToken, std::unique_ptr<struct aiocb>> pending_;
+  std::unordered_map<IoToken, std::vector<std::unique_ptr<struct aiocb>>>
+      pending_;
 };
 
 }  // namespace hshm
@@ -33,7 +33,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <unordered_map>
+#include <vector>
 
 #include "hermes_shm/util/logging.h"
 
@@ -148,6 +148,28 @@ class EventManager {
     return fired;
   }
 
+  /**
+   * Register an action the owning loop runs once per iteration via Flush,
+   * for transports that defer submissions until the iteration ends.
+   */
+  void AddFlushAction(EventAction *action) {
+    if (std::find(flush_actions_.begin(), flush_actions_.end(), action) ==
+        flush_actions_.end()) {
+      flush_actions_.push_back(action);
+    }
+  }
+
+  /** Run every flush action; called by the loop each iteration */
+  void Flush() {
+    for (EventAction *action : flush_actions_) {
+      EventInfo info;
+      info.trigger_ = {-1, -1};
+      info.events_ = 0;
+      info.action_ = action;
+      action->Run(info);
+    }
+  }
+
   int GetEpollFd() const { return -1; }
 
   int GetSignalFd() const { return -1; }
@@ -165,6 +187,7 @@ class EventManager {
 
   std::vector<WSAPOLLFD> poll_fds_;
   std::vector<EventRegistration> registrations_;
+  std::vector<EventAction *> flush_actions_;
 };
 
 }  // namespace hshm::lbm
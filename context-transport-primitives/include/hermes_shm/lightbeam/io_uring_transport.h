@@ -0,0 +1,1039 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+#if HSHM_ENABLE_IO_URING && !defined(_WIN32)
+
+#include <endian.h>
+#include <liburing.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "hermes_shm/util/logging.h"
+#include "lightbeam.h"
+#include "posix_socket.h"
+
+namespace hshm::lbm {
+
+/**
+ * A serialized message waiting for the wire. The header, metadata and any
+ * staged bulks live in head_; bulks sent in place are referenced by pointer.
+ * Wire format: [4B BE meta_len][8B BE bulk_len][meta][bulk0][bulk1]...
+ */
+struct IoUringFrame {
+  struct Segment {
+    const char *ptr_;  // caller memory, or null for head_ bytes
+    size_t off_;       // offset into head_ when ptr_ is null
+    size_t len_;
+  };
+  std::vector<char> head_;
+  std::vector<Segment> segs_;
+  bool zero_copy_ = false;  // some segment references caller memory
+  u64 seq_ = 0;
+};
+
+/** Per-connection state, shared by its transport and in-flight operations */
+struct IoUringConn {
+  int fd_ = -1;
+  bool closed_ = false;         // peer hung up, socket failed or transport gone
+  bool recv_armed_ = false;     // a multishot recv is outstanding
+  bool send_inflight_ = false;  // a batched sendmsg is outstanding
+  bool dirty_ = false;          // listed in the ring's flush queue
+  std::vector<char> inbox_;     // received bytes not yet parsed into frames
+  size_t inbox_off_ = 0;
+  std::vector<std::unique_ptr<IoUringFrame>> pending_;  // queued, not sent
+  u64 queued_seq_ = 0;  // seq of the newest queued frame
+  u64 done_seq_ = 0;    // seq of the newest frame handed to the kernel
+};
+
+/** One outstanding SQE and the state its completions need */
+struct IoUringOp {
+  enum Kind { kRecv, kSend };
+  Kind kind_;
+  std::shared_ptr<IoUringConn> conn_;
+  std::vector<std::unique_ptr<IoUringFrame>> frames_;  // kSend: the batch
+  std::vector<struct iovec> iov_;
+  size_t iov_idx_ = 0;  // first iovec not fully written
+  struct msghdr msg_;
+  bool zero_copy_ = false;   // batch references caller memory
+  bool zc_issued_ = false;   // last SQE was SENDMSG_ZC
+  int notifs_ = 0;           // zero-copy notifications still owed
+  bool done_ = false;        // the kernel accepted every byte
+};
+
+/**
+ * io_uring instance shared by every IoUringTransport a thread uses.
+ *
+ * Receives are multishot recvs that pick buffers from one provided buffer
+ * ring (PROVIDE_BUFFERS where rings are unavailable), so an idle
+ * connection costs no syscalls. Sends are queued per
+ * connection and written as one sendmsg per connection when the ring is
+ * flushed; a thread whose event loop calls Poll once per iteration (see
+ * SetDriven) submits all of them with a single io_uring_enter.
+ */
+class IoUringRing {
+ public:
+  static constexpr unsigned kSqEntries = 256;
+  static constexpr unsigned kCqEntries = 4096;
+  static constexpr unsigned kNumBufs = 128;  // power of two
+  static constexpr unsigned kBufSize = 32 * 1024;
+  static constexpr int kBufGroup = 0;
+  static constexpr size_t kZeroCopyMin = 16 * 1024;  // in-place bulk size
+  static constexpr size_t kMaxBatchIov = 1024;       // IOV_MAX
+  static constexpr u64 kProbeTag = 1;  // user_data of BufferSelectWorks
+
+  IoUringRing() {
+    struct io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_COOP_TASKRUN |
+                   IORING_SETUP_TASKRUN_FLAG;
+    params.cq_entries = kCqEntries;
+    int rc = io_uring_queue_init_params(kSqEntries, &ring_, &params);
+    if (rc == -EINVAL) {
+      // Pre-5.19 kernels lack cooperative task running
+      std::memset(&params, 0, sizeof(params));
+      params.flags = IORING_SETUP_CQSIZE;
+      params.cq_entries = kCqEntries;
+      rc = io_uring_queue_init_params(kSqEntries, &ring_, &params);
+    }
+    if (rc < 0) {
+      throw std::runtime_error(std::string("IoUringRing: queue init failed: ") +
+                               strerror(-rc));
+    }
+    bufs_ = static_cast<char *>(std::aligned_alloc(4096, kNumBufs * kBufSize));
+    if (!LegacyBuffers()) {
+      buf_ring_ = io_uring_setup_buf_ring(&ring_, kNumBufs, kBufGroup, 0, &rc);
+    }
+    if (buf_ring_) {
+      for (unsigned i = 0; i < kNumBufs; ++i) {
+        io_uring_buf_ring_add(buf_ring_, bufs_ + i * kBufSize, kBufSize, i,
+                              io_uring_buf_ring_mask(kNumBufs), i);
+      }
+      io_uring_buf_ring_advance(buf_ring_, kNumBufs);
+    } else {
+      // Pre-5.19 kernels: hand the buffers over with PROVIDE_BUFFERS
+      ProvideBuffers(0, kNumBufs);
+      io_uring_submit(&ring_);
+    }
+  }
+
+  ~IoUringRing() {
+    if (buf_ring_) {
+      io_uring_free_buf_ring(&ring_, buf_ring_, kNumBufs, kBufGroup);
+    }
+    io_uring_queue_exit(&ring_);
+    std::free(bufs_);
+    for (IoUringOp *op : ops_) {
+      delete op;
+    }
+  }
+
+  IoUringRing(const IoUringRing &) = delete;
+  IoUringRing &operator=(const IoUringRing &) = delete;
+
+  /** The calling thread's ring, created on first use */
+  static std::shared_ptr<IoUringRing> ForThread() {
+    thread_local std::shared_ptr<IoUringRing> ring;
+    if (!ring) {
+      ring = std::make_shared<IoUringRing>();
+    }
+    return ring;
+  }
+
+  /** Whether this kernel supports everything the ring needs (probed once) */
+  static bool Supported() {
+    static std::once_flag once;
+    static bool supported = false;
+    std::call_once(once, []() {
+      try {
+        IoUringRing probe;
+        if (!probe.BufferSelectWorks()) {
+          // Some kernels accept a buffer ring but never pick from it
+          LegacyBuffers() = true;
+          IoUringRing legacy;
+          if (!legacy.BufferSelectWorks()) {
+            throw std::runtime_error("recv buffer selection failed");
+          }
+        }
+        supported = true;
+      } catch (const std::exception &e) {
+        HLOG(kWarning, "io_uring transport unavailable: {}", e.what());
+      }
+    });
+    return supported;
+  }
+
+  /**
+   * Flush and reap the calling thread's ring and mark it driven, so later
+   * sends from this thread wait for the next call instead of submitting.
+   */
+  static void PollThisThread() {
+    std::shared_ptr<IoUringRing> ring = ForThread();
+    ring->driven_ = true;
+    ring->Poll();
+  }
+
+  /** True once an event loop polls this ring every iteration */
+  bool IsDriven() const { return driven_; }
+
+  /** Arm a multishot recv on a connection unless one is outstanding */
+  void ArmRecv(const std::shared_ptr<IoUringConn> &conn) {
+    if (conn->recv_armed_ || conn->closed_) return;
+    struct io_uring_sqe *sqe = GetSqe();
+    if (!sqe) return;
+    auto *op = new IoUringOp();
+    op->kind_ = IoUringOp::kRecv;
+    op->conn_ = conn;
+    io_uring_prep_recv_multishot(sqe, conn->fd_, nullptr, 0, 0);
+    sqe->flags |= IOSQE_BUFFER_SELECT;
+    sqe->buf_group = kBufGroup;
+    io_uring_sqe_set_data(sqe, op);
+    ops_.insert(op);
+    conn->recv_armed_ = true;
+  }
+
+  /** Queue a frame on a connection; returns its sequence number */
+  u64 QueueFrame(const std::shared_ptr<IoUringConn> &conn,
+                 std::unique_ptr<IoUringFrame> frame) {
+    frame->seq_ = ++conn->queued_seq_;
+    conn->pending_.push_back(std::move(frame));
+    MarkDirty(conn);
+    return conn->queued_seq_;
+  }
+
+  /** Cancel a connection's outstanding operations before its fd closes */
+  void CancelConn(IoUringConn &conn) {
+    conn.closed_ = true;
+    conn.pending_.clear();
+    if (!conn.recv_armed_ && !conn.send_inflight_) return;
+    struct io_uring_sqe *sqe = GetSqe();
+    if (!sqe) return;
+    io_uring_prep_cancel_fd(sqe, conn.fd_, IORING_ASYNC_CANCEL_ALL);
+    io_uring_sqe_set_data(sqe, nullptr);
+    io_uring_submit(&ring_);
+  }
+
+  /**
+   * One polling pass: batch queued sends, enter the kernel only if there is
+   * something to submit or deferred completion work, then reap every CQE.
+   */
+  void Poll() {
+    FlushSends();
+    if (NeedEnter()) {
+      io_uring_submit_and_get_events(&ring_);
+    }
+    Reap();
+    if (!driven_ && !dirty_.empty()) {
+      // Nobody polls this ring per iteration: push follow-up batches now
+      FlushSends();
+      io_uring_submit(&ring_);
+    }
+  }
+
+  /** Like Poll, but sleep up to timeout_us for at least one completion */
+  void Wait(int timeout_us) {
+    FlushSends();
+    io_uring_submit(&ring_);
+    struct __kernel_timespec ts;
+    ts.tv_sec = timeout_us / 1000000;
+    ts.tv_nsec = (timeout_us % 1000000) * 1000L;
+    struct io_uring_cqe *cqe = nullptr;
+    io_uring_wait_cqe_timeout(&ring_, &cqe, &ts);
+    Reap();
+  }
+
+ private:
+  /** Get an SQE, submitting queued ones if the SQ is full */
+  struct io_uring_sqe *GetSqe() {
+    struct io_uring_sqe *sqe = io_uring_get_sqe(&ring_);
+    if (!sqe) {
+      io_uring_submit(&ring_);
+      sqe = io_uring_get_sqe(&ring_);
+      if (!sqe) {
+        HLOG(kError, "IoUringRing: submission queue full");
+      }
+    }
+    return sqe;
+  }
+
+  /** Rings use PROVIDE_BUFFERS instead of a buffer ring (set by Supported) */
+  static bool &LegacyBuffers() {
+    static bool legacy = false;
+    return legacy;
+  }
+
+  /** Queue a PROVIDE_BUFFERS for count buffers starting at bid */
+  void ProvideBuffers(unsigned bid, unsigned count) {
+    struct io_uring_sqe *sqe = GetSqe();
+    if (!sqe) return;
+    io_uring_prep_provide_buffers(sqe, bufs_ + static_cast<size_t>(bid) * kBufSize,
+                                  kBufSize, count, kBufGroup, bid);
+    io_uring_sqe_set_data(sqe, nullptr);
+  }
+
+  /** Return a consumed buffer to the kernel */
+  void RecycleBuffer(unsigned bid) {
+    if (buf_ring_) {
+      io_uring_buf_ring_add(buf_ring_, bufs_ + static_cast<size_t>(bid) * kBufSize,
+                            kBufSize, bid, io_uring_buf_ring_mask(kNumBufs), 0);
+      io_uring_buf_ring_advance(buf_ring_, 1);
+    } else {
+      ProvideBuffers(bid, 1);
+    }
+  }
+
+  /** Receive one byte over a socketpair through the buffer group */
+  bool BufferSelectWorks() {
+    int sv[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) return false;
+    bool ok = false;
+    struct io_uring_sqe *sqe = GetSqe();
+    if (sqe && ::write(sv[1], "x", 1) == 1) {
+      io_uring_prep_recv(sqe, sv[0], nullptr, 0, 0);
+      sqe->flags |= IOSQE_BUFFER_SELECT;
+      sqe->buf_group = kBufGroup;
+      io_uring_sqe_set_data64(sqe, kProbeTag);
+      io_uring_submit(&ring_);
+      struct io_uring_cqe *cqe = nullptr;
+      // Skip PROVIDE_BUFFERS completions queued by the constructor
+      while (io_uring_wait_cqe(&ring_, &cqe) == 0) {
+        bool probe = io_uring_cqe_get_data64(cqe) == kProbeTag;
+        if (probe) {
+          ok = cqe->res == 1;
+          if (ok) RecycleBuffer(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+        }
+        io_uring_cqe_seen(&ring_, cqe);
+        if (probe) break;
+      }
+    }
+    ::close(sv[0]);
+    ::close(sv[1]);
+    return ok;
+  }
+
+  /** Put a connection on the flush queue once */
+  void MarkDirty(const std::shared_ptr<IoUringConn> &conn) {
+    if (conn->dirty_) return;
+    conn->dirty_ = true;
+    dirty_.push_back(conn);
+  }
+
+  /** Syscall needed: SQEs to submit, task work to run or CQ overflow */
+  bool NeedEnter() const {
+    if (io_uring_sq_ready(&ring_) > 0) return true;
+    unsigned flags = IO_URING_READ_ONCE(*ring_.sq.kflags);
+    return (flags & (IORING_SQ_TASKRUN | IORING_SQ_CQ_OVERFLOW)) != 0;
+  }
+
+  /** Turn each idle dirty connection's queued frames into one sendmsg */
+  void FlushSends() {
+    std::vector<std::shared_ptr<IoUringConn>> dirty;
+    dirty.swap(dirty_);
+    for (auto &conn : dirty) {
+      conn->dirty_ = false;
+      if (conn->closed_) {
+        conn->pending_.clear();
+        continue;
+      }
+      // A busy connection is re-queued when its batch completes
+      if (conn->send_inflight_ || conn->pending_.empty()) continue;
+      auto *op = new IoUringOp();
+      op->kind_ = IoUringOp::kSend;
+      op->conn_ = conn;
+      size_t take = 0;
+      for (auto &frame : conn->pending_) {
+        if (take > 0 && op->iov_.size() + frame->segs_.size() > kMaxBatchIov) {
+          break;
+        }
+        for (const auto &seg : frame->segs_) {
+          char *base = seg.ptr_ ? const_cast<char *>(seg.ptr_)
+                                : frame->head_.data() + seg.off_;
+          op->iov_.push_back({base, seg.len_});
+        }
+        op->zero_copy_ |= frame->zero_copy_;
+        ++take;
+      }
+      for (size_t i = 0; i < take; ++i) {
+        op->frames_.push_back(std::move(conn->pending_[i]));
+      }
+      conn->pending_.erase(conn->pending_.begin(),
+                           conn->pending_.begin() + take);
+      conn->send_inflight_ = true;
+      ops_.insert(op);
+      PrepSend(op);
+    }
+  }
+
+  /** Queue the unsent remainder of a batch */
+  void PrepSend(IoUringOp *op) {
+    struct io_uring_sqe *sqe = op->conn_->closed_ ? nullptr : GetSqe();
+    if (!sqe) {
+      FinishSend(op, false);
+      return;
+    }
+    std::memset(&op->msg_, 0, sizeof(op->msg_));
+    op->msg_.msg_iov = op->iov_.data() + op->iov_idx_;
+    op->msg_.msg_iovlen = op->iov_.size() - op->iov_idx_;
+    op->zc_issued_ = op->zero_copy_ && zero_copy_ok_;
+    // MSG_WAITALL lets the kernel retry short stream writes itself
+    unsigned flags = MSG_NOSIGNAL | MSG_WAITALL;
+    if (op->zc_issued_) {
+      io_uring_prep_sendmsg_zc(sqe, op->conn_->fd_, &op->msg_, flags);
+    } else {
+      io_uring_prep_sendmsg(sqe, op->conn_->fd_, &op->msg_, flags);
+    }
+    io_uring_sqe_set_data(sqe, op);
+  }
+
+  /** Drain the completion queue */
+  void Reap() {
+    unsigned head;
+    unsigned count = 0;
+    struct io_uring_cqe *cqe;
+    io_uring_for_each_cqe(&ring_, head, cqe) {
+      ++count;
+      auto *op = static_cast<IoUringOp *>(io_uring_cqe_get_data(cqe));
+      if (!op) continue;  // cancellations and PROVIDE_BUFFERS
+      if (op->kind_ == IoUringOp::kRecv) {
+        OnRecv(op, cqe);
+      } else {
+        OnSend(op, cqe);
+      }
+    }
+    io_uring_cq_advance(&ring_, count);
+  }
+
+  /** Append received bytes to the inbox and hand the buffer back */
+  void OnRecv(IoUringOp *op, const struct io_uring_cqe *cqe) {
+    IoUringConn &conn = *op->conn_;
+    if (cqe->res > 0 && (cqe->flags & IORING_CQE_F_BUFFER)) {
+      unsigned bid = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+      const char *buf = bufs_ + static_cast<size_t>(bid) * kBufSize;
+      if (!conn.closed_) {
+        conn.inbox_.insert(conn.inbox_.end(), buf, buf + cqe->res);
+      }
+      RecycleBuffer(bid);
+    } else if (cqe->res != -ENOBUFS) {
+      // 0 = orderly shutdown; < 0 = error or cancellation
+      conn.closed_ = true;
+    }
+    if (!(cqe->flags & IORING_CQE_F_MORE)) {
+      // Multishot ended (ENOBUFS included); the next Recv re-arms it
+      conn.recv_armed_ = false;
+      ops_.erase(op);
+      delete op;
+    }
+  }
+
+  /** Advance a batch past the bytes the kernel took; resubmit the rest */
+  void OnSend(IoUringOp *op, const struct io_uring_cqe *cqe) {
+    if (cqe->flags & IORING_CQE_F_NOTIF) {
+      // Zero-copy buffers released
+      --op->notifs_;
+      MaybeRetire(op);
+      return;
+    }
+    if (op->zc_issued_ && (cqe->flags & IORING_CQE_F_MORE)) {
+      ++op->notifs_;
+    }
+    int res = cqe->res;
+    if (res == -EAGAIN || res == -EINTR) {
+      PrepSend(op);
+      return;
+    }
+    if (op->zc_issued_ && (res == -EOPNOTSUPP || res == -EINVAL)) {
+      HLOG(kWarning, "IoUringRing: SENDMSG_ZC unsupported, copying bulks");
+      zero_copy_ok_ = false;
+      PrepSend(op);
+      return;
+    }
+    if (res < 0 || (res == 0 && op->iov_idx_ < op->iov_.size())) {
+      HLOG(kError, "IoUringRing: sendmsg on fd {} failed: {}", op->conn_->fd_,
+           strerror(-res));
+      FinishSend(op, false);
+      return;
+    }
+    size_t n = static_cast<size_t>(res);
+    while (n > 0 && op->iov_idx_ < op->iov_.size()) {
+      struct iovec &iov = op->iov_[op->iov_idx_];
+      if (n >= iov.iov_len) {
+        n -= iov.iov_len;
+        ++op->iov_idx_;
+      } else {
+        iov.iov_base = static_cast<char *>(iov.iov_base) + n;
+        iov.iov_len -= n;
+        n = 0;
+      }
+    }
+    if (op->iov_idx_ < op->iov_.size()) {
+      PrepSend(op);
+      return;
+    }
+    FinishSend(op, true);
+  }
+
+  /** Close out a batch and release the connection for its next one */
+  void FinishSend(IoUringOp *op, bool ok) {
+    IoUringConn &conn = *op->conn_;
+    conn.send_inflight_ = false;
+    if (ok) {
+      conn.done_seq_ = op->frames_.back()->seq_;
+    } else {
+      conn.closed_ = true;
+      conn.pending_.clear();
+    }
+    if (!conn.pending_.empty()) {
+      MarkDirty(op->conn_);
+    }
+    op->done_ = true;
+    MaybeRetire(op);
+  }
+
+  /** Free a send once it is written and its zero-copy buffers are back */
+  void MaybeRetire(IoUringOp *op) {
+    if (!op->done_ || op->notifs_ > 0) return;
+    ops_.erase(op);
+    delete op;
+  }
+
+  struct io_uring ring_;
+  struct io_uring_buf_ring *buf_ring_ = nullptr;
+  char *bufs_ = nullptr;
+  bool driven_ = false;
+  bool zero_copy_ok_ = true;
+  std::vector<std::shared_ptr<IoUringConn>> dirty_;
+  std::unordered_set<IoUringOp *> ops_;
+};
+
+/** Flush action an event loop runs once per iteration for io_uring rings */
+class IoUringFlushAction : public EventAction {
+ public:
+  void Run(const EventInfo &event) override {
+    (void)event;
+    IoUringRing::PollThisThread();
+  }
+
+  /** Stateless, so every transport shares one and loops dedupe it */
+  static IoUringFlushAction *Get() {
+    static IoUringFlushAction action;
+    return &action;
+  }
+};
+
+/**
+ * Stream transport over io_uring. Same addressing as SocketTransport
+ * (tcp host:port or ipc path), different wire format.
+ */
+class IoUringTransport : public Transport {
+ public:
+  static constexpr size_t kHeaderSize = sizeof(uint32_t) + sizeof(uint64_t);
+
+  explicit IoUringTransport(TransportMode mode, const std::string &addr,
+                            const std::string &protocol = "tcp",
+                            int port = 8195)
+      : Transport(mode),
+        addr_(addr),
+        protocol_(protocol),
+        port_(port),
+        listen_fd_(sock::kInvalidSocket),
+        em_(nullptr),
+        rr_(0) {
+    type_ = TransportType::kIoUring;
+    if (!IoUringRing::Supported()) {
+      throw std::runtime_error(
+          "IoUringTransport: io_uring with provided buffer rings is "
+          "unavailable (needs Linux 6.0+)");
+    }
+    if (mode == TransportMode::kClient) {
+      conn_ = std::make_shared<IoUringConn>();
+      conn_->fd_ = Connect();
+      conns_.push_back(conn_);
+      HLOG(kDebug, "IoUringTransport(client) connected to {}:{}", addr_,
+           port_);
+    } else {
+      listen_fd_ = Listen();
+      HLOG(kDebug, "IoUringTransport(server) listening on {}:{}", addr_,
+           port_);
+    }
+  }
+
+  ~IoUringTransport() {
+    for (auto &conn : conns_) {
+      DrainSends(*conn);
+      CloseConn(*conn);
+    }
+    if (IsServer()) {
+      sock::Close(listen_fd_);
+      if (protocol_ == "ipc") {
+        sock::UnlinkPath(addr_.c_str());
+      }
+    }
+  }
+
+  Bulk Expose(const hipc::FullPtr<char> &ptr, size_t data_size, u32 flags) {
+    Bulk bulk;
+    bulk.data = ptr;
+    bulk.size = data_size;
+    bulk.flags = hshm::bitfield32_t(flags);
+    return bulk;
+  }
+
+  void ClearRecvHandles(LbmMeta<> &meta) {
+    for (auto &bulk : meta.recv) {
+      // Buffers from an LbmContext::recv_alloc_ belong to the caller
+      if (bulk.data.ptr_ && !bulk.flags.Any(BULK_RECV_ALLOC)) {
+        std::free(bulk.data.ptr_);
+        bulk.data.ptr_ = nullptr;
+      }
+    }
+  }
+
+  std::string GetAddress() const { return addr_; }
+
+  /** Check if the server is still alive via a connect probe */
+  bool IsServerAlive(const LbmContext &ctx = LbmContext()) const {
+    (void)ctx;
+    sock::socket_t fd;
+    int rc;
+    if (protocol_ == "ipc") {
+      fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+      if (fd == sock::kInvalidSocket) return false;
+      struct sockaddr_un sun = UnixAddr();
+      rc = ::connect(fd, reinterpret_cast<struct sockaddr *>(&sun),
+                     sizeof(sun));
+    } else {
+      fd = ::socket(AF_INET, SOCK_STREAM, 0);
+      if (fd == sock::kInvalidSocket) return false;
+      struct timeval tv;
+      tv.tv_sec = 0;
+      tv.tv_usec = 500000;
+      setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+      struct sockaddr_in sin;
+      if (!InetAddr(sin)) {
+        sock::Close(fd);
+        return false;
+      }
+      rc = ::connect(fd, reinterpret_cast<struct sockaddr *>(&sin),
+                     sizeof(sin));
+    }
+    sock::Close(fd);
+    return rc == 0;
+  }
+
+  /**
+   * Wake the loop on socket readiness and flush this thread's ring once per
+   * loop iteration, which batches every send made during the iteration.
+   */
+  void RegisterEventManager(EventManager &em) {
+    em_ = &em;
+    if (IsServer()) {
+      em.AddEvent(listen_fd_, kDefaultReadEvent, nullptr);
+    }
+    for (auto &conn : conns_) {
+      em.AddEvent(conn->fd_, kDefaultReadEvent, nullptr);
+    }
+    em.AddFlushAction(IoUringFlushAction::Get());
+  }
+
+  /**
+   * Queue a message. It is written by the next flush of the calling
+   * thread's ring, or right away if no event loop drives that ring. Bulks of
+   * kZeroCopyMin bytes or more are sent in place with SENDMSG_ZC and must
+   * stay valid until the reply, unless ctx has LBM_STAGE_BULKS; LBM_SYNC
+   * waits until the kernel has taken the whole message.
+   */
+  template <typename MetaT>
+  int Send(MetaT &meta, const LbmContext &ctx = LbmContext()) {
+    std::shared_ptr<IoUringConn> conn =
+        IsClient() ? conn_ : FindConn(meta.client_info_.fd_);
+    if (!conn) {
+      HLOG(kError, "IoUringTransport::Send - no connection for fd {}",
+           meta.client_info_.fd_);
+      return -1;
+    }
+    if (conn->closed_) return ECONNRESET;
+    BindRing();
+    u64 seq = ring_->QueueFrame(conn, BuildFrame(meta, ctx));
+    if (ctx.IsSync()) {
+      return WaitSent(*conn, seq, ctx);
+    }
+    if (!ring_->IsDriven()) {
+      ring_->Poll();
+    }
+    return 0;
+  }
+
+  /** Return one complete buffered message, polling the ring if needed */
+  template <typename MetaT>
+  ClientInfo Recv(MetaT &meta, const LbmContext &ctx = LbmContext()) {
+    ClientInfo info;
+    BindRing();
+    if (IsServer()) {
+      AcceptNewClients();
+    }
+    for (auto &conn : conns_) {
+      ring_->ArmRecv(conn);
+    }
+    // Frames already buffered are returned without entering the kernel
+    if (NextFrame(meta, ctx, info)) return info;
+    ring_->Poll();
+    if (NextFrame(meta, ctx, info)) return info;
+    info.rc = EAGAIN;
+    return info;
+  }
+
+ private:
+  /** Bind to the ring of the first thread that sends or receives */
+  void BindRing() {
+    if (!ring_) {
+      ring_ = IoUringRing::ForThread();
+    }
+  }
+
+  /** Serialize a message into a frame, staging small bulks into its head */
+  template <typename MetaT>
+  std::unique_ptr<IoUringFrame> BuildFrame(MetaT &meta,
+                                           const LbmContext &ctx) {
+    std::vector<char> meta_buf;
+    {
+      hshm::ipc::GlobalSerialize<std::vector<char>> ar(meta_buf);
+      ar(meta);
+      ar.Finalize();
+    }
+    bool stage = (ctx.flags & LBM_STAGE_BULKS) != 0;
+    uint64_t bulk_len = 0;
+    for (size_t i = 0; i < meta.send.size(); ++i) {
+      if (meta.send[i].flags.Any(BULK_XFER)) bulk_len += meta.send[i].size;
+    }
+    auto frame = std::make_unique<IoUringFrame>();
+    std::vector<char> &head = frame->head_;
+    uint32_t net_meta_len = htonl(static_cast<uint32_t>(meta_buf.size()));
+    uint64_t net_bulk_len = htobe64(bulk_len);
+    const char *hdr = reinterpret_cast<const char *>(&net_meta_len);
+    head.insert(head.end(), hdr, hdr + sizeof(net_meta_len));
+    hdr = reinterpret_cast<const char *>(&net_bulk_len);
+    head.insert(head.end(), hdr, hdr + sizeof(net_bulk_len));
+    head.insert(head.end(), meta_buf.begin(), meta_buf.end());
+
+    size_t seg_start = 0;
+    for (size_t i = 0; i < meta.send.size(); ++i) {
+      const Bulk &bulk = meta.send[i];
+      if (!bulk.flags.Any(BULK_XFER) || bulk.size == 0) continue;
+      const char *data = bulk.data.ptr_;
+      if (stage || bulk.size < IoUringRing::kZeroCopyMin) {
+        head.insert(head.end(), data, data + bulk.size);
+        continue;
+      }
+      if (head.size() > seg_start) {
+        frame->segs_.push_back({nullptr, seg_start, head.size() - seg_start});
+      }
+      frame->segs_.push_back({data, 0, bulk.size});
+      frame->zero_copy_ = true;
+      seg_start = head.size();
+    }
+    if (head.size() > seg_start) {
+      frame->segs_.push_back({nullptr, seg_start, head.size() - seg_start});
+    }
+    return frame;
+  }
+
+  /** Block until frame seq of a connection is on the wire */
+  int WaitSent(IoUringConn &conn, u64 seq, const LbmContext &ctx) {
+    auto start = std::chrono::steady_clock::now();
+    while (conn.done_seq_ < seq && !conn.closed_) {
+      ring_->Wait(1000);
+      if (ctx.HasTimeout() &&
+          std::chrono::steady_clock::now() - start >
+              std::chrono::milliseconds(ctx.timeout_ms)) {
+        return ETIMEDOUT;
+      }
+    }
+    return conn.done_seq_ >= seq ? 0 : ECONNRESET;
+  }
+
+  /** Give queued sends up to a second to leave before a connection closes */
+  void DrainSends(IoUringConn &conn) {
+    if (!ring_) return;
+    auto start = std::chrono::steady_clock::now();
+    while ((conn.send_inflight_ || !conn.pending_.empty()) && !conn.closed_ &&
+           std::chrono::steady_clock::now() - start < std::chrono::seconds(1)) {
+      ring_->Wait(1000);
+    }
+  }
+
+  /** Cancel a connection's operations and close its socket */
+  void CloseConn(IoUringConn &conn) {
+    if (ring_) {
+      ring_->CancelConn(conn);
+    } else {
+      conn.closed_ = true;
+    }
+    sock::Close(conn.fd_);
+  }
+
+  /** Find the accepted connection a reply should go back on */
+  std::shared_ptr<IoUringConn> FindConn(int fd) const {
+    for (const auto &conn : conns_) {
+      if (conn->fd_ == fd) return conn;
+    }
+    return nullptr;
+  }
+
+  /**
+   * Parse the next complete frame, round-robin over connections. Server
+   * connections that closed with nothing left to parse are dropped and
+   * reported with rc = -1, as SocketTransport does.
+   */
+  template <typename MetaT>
+  bool NextFrame(MetaT &meta, const LbmContext &ctx, ClientInfo &info) {
+    for (size_t n = 0; n < conns_.size(); ++n) {
+      size_t i = (rr_ + n) % conns_.size();
+      IoUringConn &conn = *conns_[i];
+      int rc = ParseFrame(conn, meta, ctx);
+      if (rc == EAGAIN && !conn.closed_) continue;
+      info.rc = rc == EAGAIN ? -1 : rc;
+      info.fd_ = conn.fd_;
+      if (info.rc != 0 && IsServer()) {
+        CloseConn(conn);
+        conns_.erase(conns_.begin() + i);
+      }
+      rr_ = i + 1;
+      return true;
+    }
+    return false;
+  }
+
+  /** Deserialize one frame from a connection's inbox if it is complete */
+  template <typename MetaT>
+  int ParseFrame(IoUringConn &conn, MetaT &meta, const LbmContext &ctx) {
+    size_t avail = conn.inbox_.size() - conn.inbox_off_;
+    if (avail < kHeaderSize) return EAGAIN;
+    const char *frame = conn.inbox_.data() + conn.inbox_off_;
+    uint32_t net_meta_len;
+    uint64_t net_bulk_len;
+    std::memcpy(&net_meta_len, frame, sizeof(net_meta_len));
+    std::memcpy(&net_bulk_len, frame + sizeof(net_meta_len),
+                sizeof(net_bulk_len));
+    size_t meta_len = ntohl(net_meta_len);
+    size_t bulk_len = be64toh(net_bulk_len);
+    size_t total = kHeaderSize + meta_len + bulk_len;
+    if (avail < total) return EAGAIN;
+
+    const char *meta_ptr = frame + kHeaderSize;
+    try {
+      hshm::ipc::ByteView meta_buf(meta_ptr, meta_len);
+      hshm::ipc::GlobalDeserialize<hshm::ipc::ByteView> ar(meta_buf);
+      ar(meta);
+    } catch (const std::exception &e) {
+      HLOG(kFatal, "IoUring ParseFrame: Deserialization failed - {} (len={})",
+           e.what(), meta_len);
+      return -1;
+    }
+    size_t xfer_len = 0;
+    for (const auto &send_bulk : meta.send) {
+      if (send_bulk.flags.Any(BULK_XFER)) xfer_len += send_bulk.size;
+    }
+    if (xfer_len != bulk_len) {
+      HLOG(kError, "IoUring ParseFrame: bulk bytes {} != header {}", xfer_len,
+           bulk_len);
+      return -1;
+    }
+    meta.client_info_.fd_ = conn.fd_;
+    const char *src = meta_ptr + meta_len;
+    for (const auto &send_bulk : meta.send) {
+      Bulk recv_bulk;
+      recv_bulk.size = send_bulk.size;
+      recv_bulk.flags = send_bulk.flags;
+      recv_bulk.data = hipc::FullPtr<char>::GetNull();
+      if (send_bulk.flags.Any(BULK_XFER)) {
+        CopyOutBulk(recv_bulk, src, ctx);
+        src += recv_bulk.size;
+      }
+      meta.recv.push_back(recv_bulk);
+    }
+    ConsumeInbox(conn, total);
+    return 0;
+  }
+
+  /** Copy a bulk out of the inbox into ctx.recv_alloc_ memory or malloc */
+  void CopyOutBulk(Bulk &bulk, const char *src, const LbmContext &ctx) {
+    if (ctx.recv_alloc_) {
+      bulk.data = ctx.recv_alloc_->Allocate(bulk.size);
+    }
+    if (bulk.data.ptr_) {
+      bulk.flags.SetBits(BULK_RECV_ALLOC);
+    } else {
+      char *buf = static_cast<char *>(std::malloc(bulk.size));
+      bulk.data.ptr_ = buf;
+      bulk.data.shm_.alloc_id_ = hipc::AllocatorId::GetNull();
+      bulk.data.shm_.off_ = reinterpret_cast<size_t>(buf);
+    }
+    std::memcpy(bulk.data.ptr_, src, bulk.size);
+  }
+
+  /** Drop parsed bytes, compacting once they dominate the inbox */
+  static void ConsumeInbox(IoUringConn &conn, size_t len) {
+    conn.inbox_off_ += len;
+    if (conn.inbox_off_ == conn.inbox_.size()) {
+      conn.inbox_.clear();
+      conn.inbox_off_ = 0;
+    } else if (conn.inbox_off_ > conn.inbox_.size() / 2) {
+      conn.inbox_.erase(conn.inbox_.begin(),
+                        conn.inbox_.begin() + conn.inbox_off_);
+      conn.inbox_off_ = 0;
+    }
+  }
+
+  /** Accept every pending connection */
+  void AcceptNewClients() {
+    while (true) {
+      // Accepted sockets stay blocking: io_uring waits for readiness itself
+      sock::socket_t fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+      if (fd == sock::kInvalidSocket) return;
+      if (protocol_ != "ipc") {
+        sock::SetTcpNoDelay(fd);
+      }
+      sock::SetRecvBuf(fd, 4 * 1024 * 1024);
+      auto conn = std::make_shared<IoUringConn>();
+      conn->fd_ = fd;
+      conns_.push_back(conn);
+      if (em_) {
+        em_->AddEvent(fd, kDefaultReadEvent, nullptr);
+      }
+    }
+  }
+
+  /** Resolve addr_:port_ for tcp */
+  bool InetAddr(struct sockaddr_in &sin) const {
+    std::memset(&sin, 0, sizeof(sin));
+    sin.sin_family = AF_INET;
+    sin.sin_port = htons(static_cast<uint16_t>(port_));
+    return ::inet_pton(AF_INET, addr_.c_str(), &sin.sin_addr) > 0;
+  }
+
+  /** Build the sockaddr for an ipc path */
+  struct sockaddr_un UnixAddr() const {
+    struct sockaddr_un sun;
+    std::memset(&sun, 0, sizeof(sun));
+    sun.sun_family = AF_UNIX;
+    std::strncpy(sun.sun_path, addr_.c_str(), sizeof(sun.sun_path) - 1);
+    return sun;
+  }
+
+  /** Connect a blocking client socket */
+  sock::socket_t Connect() {
+    bool ipc = protocol_ == "ipc";
+    sock::socket_t fd = ::socket(ipc ? AF_UNIX : AF_INET, SOCK_STREAM, 0);
+    if (fd == sock::kInvalidSocket) {
+      throw std::runtime_error("IoUringTransport: failed to create socket");
+    }
+    int rc;
+    if (ipc) {
+      struct sockaddr_un sun = UnixAddr();
+      rc = ::connect(fd, reinterpret_cast<struct sockaddr *>(&sun),
+                     sizeof(sun));
+    } else {
+      sock::SetTcpNoDelay(fd);
+      sock::SetSendBuf(fd, 4 * 1024 * 1024);
+      struct sockaddr_in sin;
+      if (!InetAddr(sin)) {
+        sock::Close(fd);
+        throw std::runtime_error("IoUringTransport: invalid address " + addr_);
+      }
+      rc = ::connect(fd, reinterpret_cast<struct sockaddr *>(&sin),
+                     sizeof(sin));
+    }
+    if (rc < 0) {
+      sock::Close(fd);
+      throw std::runtime_error("IoUringTransport: failed to connect to " +
+                               addr_ + ":" + std::to_string(port_));
+    }
+    return fd;
+  }
+
+  /** Bind and listen; the listening socket is non-blocking for accept */
+  sock::socket_t Listen() {
+    bool ipc = protocol_ == "ipc";
+    if (ipc) {
+      sock::UnlinkPath(addr_.c_str());
+    }
+    sock::socket_t fd = ::socket(ipc ? AF_UNIX : AF_INET, SOCK_STREAM, 0);
+    if (fd == sock::kInvalidSocket) {
+      throw std::runtime_error("IoUringTransport: failed to create socket");
+    }
+    int rc;
+    if (ipc) {
+      struct sockaddr_un sun = UnixAddr();
+      rc = ::bind(fd, reinterpret_cast<struct sockaddr *>(&sun), sizeof(sun));
+    } else {
+      sock::SetReuseAddr(fd);
+      sock::SetRecvBuf(fd, 4 * 1024 * 1024);
+      struct sockaddr_in sin;
+      std::memset(&sin, 0, sizeof(sin));
+      sin.sin_family = AF_INET;
+      sin.sin_port = htons(static_cast<uint16_t>(port_));
+      sin.sin_addr.s_addr = INADDR_ANY;
+      rc = ::bind(fd, reinterpret_cast<struct sockaddr *>(&sin), sizeof(sin));
+    }
+    if (rc < 0 || ::listen(fd, 16) < 0) {
+      sock::Close(fd);
+      throw std::runtime_error("IoUringTransport: failed to listen on " +
+                               addr_ + ":" + std::to_string(port_));
+    }
+    sock::SetNonBlocking(fd, true);
+    return fd;
+  }
+
+  std::string addr_;
+  std::string protocol_;
+  int port_;
+  sock::socket_t listen_fd_;                        // Server mode
+  std::shared_ptr<IoUringConn> conn_;               // Client mode
+  std::vector<std::shared_ptr<IoUringConn>> conns_; // Client: conn_ only
+  EventManager *em_;
+  std::shared_ptr<IoUringRing> ring_;
+  size_t rr_;  // Next connection NextFrame starts from
+};
+
+}  // namespace hshm::lbm
+
+#endif  // HSHM_ENABLE_IO_URING && !defined(_WIN32)
@@ -0,0 +1,983 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+#if HSHM_ENABLE_LIBFABRIC
+
+#include <rdma/fabric.h>
+#include <rdma/fi_cm.h>
+#include <rdma/fi_domain.h>
+#include <rdma/fi_endpoint.h>
+#include <rdma/fi_errno.h>
+#include <rdma/fi_rma.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "hermes_shm/util/logging.h"
+#include "lightbeam.h"
+
+namespace hshm::lbm {
+
+/** libfabric API version requested by the transport */
+constexpr uint32_t kFabricVersion = FI_VERSION(1, 18);
+
+/** Message kinds carried in FabricMsgHeader::kind_ */
+constexpr uint32_t kFabricMsgData = 1; /**< Metadata plus inline bulks */
+constexpr uint32_t kFabricMsgFin = 2;  /**< Receiver finished its reads */
+
+/** Wire header preceding every libfabric message */
+struct FabricMsgHeader {
+  uint32_t kind_;        /**< kFabricMsgData or kFabricMsgFin */
+  uint32_t name_len_;    /**< Length of the sender's endpoint name */
+  uint64_t seq_;         /**< Rendezvous sequence number (0 = none) */
+  uint64_t meta_len_;    /**< Serialized LbmMeta bytes */
+  uint64_t inline_len_;  /**< Inline bulk bytes following the metadata */
+};
+
+/** A registered memory region */
+struct FabricMr {
+  uintptr_t begin_ = 0;    /**< First registered byte */
+  size_t size_ = 0;        /**< Registered length */
+  fid_mr *mr_ = nullptr;   /**< libfabric handle */
+  void *desc_ = nullptr;   /**< Local descriptor (FI_MR_LOCAL) */
+  uint64_t key_ = 0;       /**< Remote key */
+};
+
+/**
+ * Completion context for every operation posted on an endpoint.
+ * Registered pool buffers use the same object, so a receive slot or an
+ * eager send buffer is its own completion context.
+ */
+struct FabricOp {
+  fi_context2 ctx_;          /**< Must be first: owned by libfabric while posted */
+  enum Kind { kRecv, kSend, kRead } kind_ = kSend;
+  char *buf_ = nullptr;      /**< Registered buffer (pool ops only) */
+  size_t capacity_ = 0;      /**< Buffer capacity */
+  size_t class_ = 0;         /**< Pool size class */
+  FabricMr mr_;              /**< Registration of buf_ */
+  size_t len_ = 0;           /**< Received length */
+  int status_ = 0;           /**< Completion status (0 = success) */
+  bool done_ = false;        /**< Set on completion when waited_ */
+  bool waited_ = false;      /**< Caller polls done_ instead of recycling */
+};
+
+/**
+ * Fabric and domain shared by every LibfabricTransport of a provider.
+ *
+ * Memory registrations belong to the domain, so sharing it lets the
+ * registration cache cover all endpoints of the process. Whole shared-memory
+ * backends are registered once through RegisterMemory(); buffers outside
+ * every cached region are registered per message.
+ */
+class FabricDomain {
+ public:
+  /**
+   * Get (or open) the shared domain for a provider
+   * @param provider libfabric provider name ("" = let libfabric choose)
+   * @param domain Domain (NIC) name ("" = first matching)
+   * @return Shared domain, or nullptr if no provider matches
+   */
+  static std::shared_ptr<FabricDomain> Get(const std::string &provider,
+                                           const std::string &domain) {
+    static std::mutex mtx;
+    static std::map<std::string, std::weak_ptr<FabricDomain>> domains;
+    std::lock_guard<std::mutex> lock(mtx);
+    std::string key = provider + "/" + domain;
+    auto shared = domains[key].lock();
+    if (!shared) {
+      shared = std::make_shared<FabricDomain>();
+      if (!shared->Open(provider, domain)) {
+        return nullptr;
+      }
+      domains[key] = shared;
+    }
+    return shared;
+  }
+
+  ~FabricDomain() {
+    for (auto &pair : regions_) {
+      fi_close(&pair.second.mr_->fid);
+    }
+    if (domain_) fi_close(&domain_->fid);
+    if (fabric_) fi_close(&fabric_->fid);
+    if (info_) fi_freeinfo(info_);
+  }
+
+  /**
+   * Register a region for the lifetime of the domain (idempotent per base)
+   * @param base First byte of the region
+   * @param size Region length
+   * @return true if the region is registered
+   */
+  bool RegisterMemory(char *base, size_t size) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    uintptr_t begin = reinterpret_cast<uintptr_t>(base);
+    auto it = regions_.find(begin);
+    if (it != regions_.end()) {
+      if (it->second.size_ >= size) {
+        return true;
+      }
+      fi_close(&it->second.mr_->fid);
+      regions_.erase(it);
+    }
+    FabricMr mr;
+    if (!Register(base, size, mr)) {
+      return false;
+    }
+    regions_[begin] = mr;
+    HLOG(kDebug, "[LibfabricTransport] Registered region {:x} ({} bytes)",
+         begin, size);
+    return true;
+  }
+
+  /**
+   * Drop a cached registration before its memory is unmapped
+   * @param base Base passed to RegisterMemory
+   */
+  void DeregisterMemory(char *base) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = regions_.find(reinterpret_cast<uintptr_t>(base));
+    if (it != regions_.end()) {
+      fi_close(&it->second.mr_->fid);
+      regions_.erase(it);
+    }
+  }
+
+  /**
+   * Find a cached registration covering [ptr, ptr + size)
+   * @param ptr Buffer start
+   * @param size Buffer length
+   * @param out Matching registration
+   * @return true on a cache hit
+   */
+  bool FindMr(const char *ptr, size_t size, FabricMr &out) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    uintptr_t begin = reinterpret_cast<uintptr_t>(ptr);
+    auto it = regions_.upper_bound(begin);
+    if (it == regions_.begin()) {
+      return false;
+    }
+    --it;
+    if (begin + size > it->second.begin_ + it->second.size_) {
+      return false;
+    }
+    out = it->second;
+    return true;
+  }
+
+  /**
+   * Register a buffer outside the cache (caller closes it with Close)
+   * @param ptr Buffer start
+   * @param size Buffer length
+   * @param out Registration
+   * @return true on success
+   */
+  bool Register(char *ptr, size_t size, FabricMr &out) {
+    uint64_t requested_key = next_key_.fetch_add(1, std::memory_order_relaxed);
+    int rc = fi_mr_reg(domain_, ptr, size,
+                       FI_SEND | FI_RECV | FI_READ | FI_REMOTE_READ, 0,
+                       requested_key, 0, &out.mr_, nullptr);
+    if (rc != 0) {
+      HLOG(kError, "[LibfabricTransport] fi_mr_reg({} bytes) failed: {}",
+           size, fi_strerror(-rc));
+      out.mr_ = nullptr;
+      return false;
+    }
+    out.begin_ = reinterpret_cast<uintptr_t>(ptr);
+    out.size_ = size;
+    out.desc_ = fi_mr_desc(out.mr_);
+    out.key_ = fi_mr_key(out.mr_);
+    return true;
+  }
+
+  /** Close a registration returned by Register */
+  static void Close(FabricMr &mr) {
+    if (mr.mr_) {
+      fi_close(&mr.mr_->fid);
+      mr.mr_ = nullptr;
+    }
+  }
+
+  /**
+   * Address a peer passes to fi_read for ptr
+   * @param mr Registration covering ptr
+   * @param ptr Buffer start
+   * @return Virtual address or region offset, per the domain's mr_mode
+   */
+  uint64_t RemoteAddr(const FabricMr &mr, const char *ptr) const {
+    uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
+    if (info_->domain_attr->mr_mode & FI_MR_VIRT_ADDR) {
+      return addr;
+    }
+    return addr - mr.begin_;
+  }
+
+  fi_info *info_ = nullptr;        /**< Provider info shared by endpoints */
+  fid_fabric *fabric_ = nullptr;   /**< Fabric handle */
+  fid_domain *domain_ = nullptr;   /**< Domain handle */
+
+ private:
+  /** Select a provider and open its fabric and domain */
+  bool Open(const std::string &provider, const std::string &domain) {
+    fi_info *hints = fi_allocinfo();
+    hints->caps = FI_MSG | FI_RMA | FI_READ | FI_REMOTE_READ;
+    hints->mode = FI_CONTEXT | FI_CONTEXT2;
+    hints->ep_attr->type = FI_EP_RDM;
+    hints->domain_attr->mr_mode =
+        FI_MR_LOCAL | FI_MR_VIRT_ADDR | FI_MR_ALLOCATED | FI_MR_PROV_KEY;
+    hints->domain_attr->threading = FI_THREAD_SAFE;
+    if (!provider.empty()) {
+      hints->fabric_attr->prov_name = strdup(provider.c_str());
+    }
+    if (!domain.empty()) {
+      hints->domain_attr->name = strdup(domain.c_str());
+    }
+    int rc = fi_getinfo(kFabricVersion, nullptr, nullptr, 0, hints, &info_);
+    fi_freeinfo(hints);
+    if (rc != 0 || !info_) {
+      HLOG(kError, "[LibfabricTransport] No provider matches '{}': {}",
+           provider, fi_strerror(-rc));
+      info_ = nullptr;
+      return false;
+    }
+    rc = fi_fabric(info_->fabric_attr, &fabric_, nullptr);
+    if (rc == 0) {
+      rc = fi_domain(fabric_, info_, &domain_, nullptr);
+    }
+    if (rc != 0) {
+      HLOG(kError, "[LibfabricTransport] Opening fabric/domain failed: {}",
+           fi_strerror(-rc));
+      return false;
+    }
+    HLOG(kInfo, "[LibfabricTransport] provider={} domain={}",
+         info_->fabric_attr->prov_name, info_->domain_attr->name);
+    return true;
+  }
+
+  std::mutex mtx_;                          /**< Guards regions_ */
+  std::map<uintptr_t, FabricMr> regions_;   /**< Cached registrations */
+  std::atomic<uint64_t> next_key_{1};       /**< Keys when !FI_MR_PROV_KEY */
+};
+
+/**
+ * Power-of-two pool of registered buffers.
+ * Backs receive slots, eager sends, staged bulks and receive-side bulk
+ * destinations, so none of them are registered per message.
+ */
+class FabricBufferPool {
+ public:
+  static constexpr size_t kMinShift = 12;  /**< Smallest class: 4 KiB */
+  static constexpr size_t kClasses = 16;   /**< Largest class: 128 MiB */
+  static constexpr size_t kDepth = 16;     /**< Cached buffers per class */
+
+  explicit FabricBufferPool(FabricDomain *dom) : dom_(dom) {}
+
+  ~FabricBufferPool() {
+    for (auto &klass : free_) {
+      for (FabricOp *op : klass) {
+        Destroy(op);
+      }
+    }
+  }
+
+  /**
+   * Get a registered buffer of at least size bytes
+   * @param size Minimum capacity
+   * @return The buffer, or nullptr if allocation or registration failed
+   */
+  FabricOp *Get(size_t size) {
+    size_t klass = 0;
+    while (klass < kClasses && (size_t(1) << (kMinShift + klass)) < size) {
+      ++klass;
+    }
+    if (klass < kClasses && !free_[klass].empty()) {
+      FabricOp *op = free_[klass].back();
+      free_[klass].pop_back();
+      op->status_ = 0;
+      op->done_ = false;
+      op->waited_ = false;
+      return op;
+    }
+    size_t capacity =
+        klass < kClasses ? (size_t(1) << (kMinShift + klass)) : size;
+    auto *op = new FabricOp();
+    op->class_ = klass;
+    op->capacity_ = capacity;
+    op->buf_ = static_cast<char *>(std::aligned_alloc(
+        4096, (capacity + 4095) & ~static_cast<size_t>(4095)));
+    if (!op->buf_ || !dom_->Register(op->buf_, capacity, op->mr_)) {
+      Destroy(op);
+      return nullptr;
+    }
+    return op;
+  }
+
+  /** Return a buffer obtained from Get */
+  void Put(FabricOp *op) {
+    if (op->class_ < kClasses && free_[op->class_].size() < kDepth) {
+      free_[op->class_].push_back(op);
+    } else {
+      Destroy(op);
+    }
+  }
+
+ private:
+  /** Deregister and free a buffer */
+  static void Destroy(FabricOp *op) {
+    FabricDomain::Close(op->mr_);
+    std::free(op->buf_);
+    delete op;
+  }
+
+  FabricDomain *dom_;
+  std::vector<FabricOp *> free_[kClasses];
+};
+
+/**
+ * libfabric RDM transport with one-sided bulk pulls.
+ *
+ * Each message is a single fi_send of FabricMsgHeader, the sender's endpoint
+ * name, the serialized LbmMeta and any inline bulks. BULK_XFER bulks up to
+ * kInlineMax travel inline; larger ones are marked BULK_RMA and carry
+ * raddr/rkey, and the receiver pulls them with fi_read inside Recv() before
+ * sending a FIN so the sender can release its rendezvous state.
+ *
+ * Rendezvous bulks are read from the caller's buffer, which must stay valid
+ * until the peer has received the message (true for requests, whose task
+ * outlives the reply). With LBM_STAGE_BULKS the transport copies them into
+ * its own registered buffers instead, so the caller may free them as soon as
+ * Send returns.
+ *
+ * Servers reply to the identity_ returned by Recv (the peer's endpoint
+ * name). Address resolution uses node/service names, so the provider must
+ * accept IP-style addressing (verbs;ofi_rxm, tcp, psm3); providers that need
+ * FI_MR_ENDPOINT are not selected.
+ */
+class LibfabricTransport : public Transport {
+ public:
+  static constexpr size_t kEagerMsgSize = 256 * 1024; /**< Receive slot size */
+  static constexpr size_t kRecvDepth = 16;            /**< Posted receives */
+  static constexpr size_t kInlineMax = 8 * 1024;      /**< Largest inline bulk */
+
+  /**
+   * Open an endpoint
+   * @param mode Client (connects to addr:port) or server (binds addr:port)
+   * @param addr Host address
+   * @param provider libfabric provider ("" = let libfabric choose)
+   * @param port Service port
+   * @param domain Domain (NIC) name ("" = first matching)
+   */
+  LibfabricTransport(TransportMode mode, const std::string &addr,
+                     const std::string &provider, int port,
+                     const std::string &domain = "")
+      : Transport(mode), addr_(addr), port_(port) {
+    type_ = TransportType::kLibfabric;
+    dom_ = FabricDomain::Get(provider, domain);
+    if (!dom_) {
+      throw std::runtime_error("LibfabricTransport: no usable provider '" +
+                               provider + "'");
+    }
+    pool_ = std::make_unique<FabricBufferPool>(dom_.get());
+    OpenEndpoint(mode);
+    for (size_t i = 0; i < kRecvDepth; ++i) {
+      FabricOp *slot = pool_->Get(max_msg_);
+      if (!slot || PostRecv(slot) != 0) {
+        if (slot) pool_->Put(slot);
+        Close();
+        throw std::runtime_error("LibfabricTransport: posting receives failed");
+      }
+      posted_.push_back(slot);
+    }
+    HLOG(kDebug, "LibfabricTransport({}) ready on {}:{}",
+         IsServer() ? "server" : "client", addr_, port_);
+  }
+
+  ~LibfabricTransport() { Close(); }
+
+  /** Create a Bulk descriptor; registration happens at Send time */
+  Bulk Expose(const hipc::FullPtr<char> &ptr, size_t data_size, u32 flags) {
+    Bulk bulk;
+    bulk.data = ptr;
+    bulk.size = data_size;
+    bulk.flags = hshm::bitfield32_t(flags);
+    return bulk;
+  }
+
+  /**
+   * Send metadata and bulks as one message
+   * @param meta Metadata; servers route by meta.client_info_.identity_
+   * @param ctx LBM_SYNC waits for local completion, LBM_STAGE_BULKS copies
+   *            rendezvous bulks into transport-owned buffers
+   * @return 0 on success, an errno-style code otherwise
+   */
+  template <typename MetaT>
+  int Send(MetaT &meta, const LbmContext &ctx = LbmContext()) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    Progress();
+    fi_addr_t dest;
+    if (!ResolveDest(meta, dest)) {
+      return EHOSTUNREACH;
+    }
+
+    // Inline small bulks, expose the rest for the peer to pull
+    Rendezvous rndv;
+    size_t inline_len = 0;
+    meta.send_bulks = 0;
+    for (size_t i = 0; i < meta.send.size(); ++i) {
+      Bulk &bulk = meta.send[i];
+      bulk.flags.UnsetBits(BULK_RMA);
+      if (!bulk.flags.Any(BULK_XFER)) {
+        continue;
+      }
+      meta.send_bulks++;
+      if (bulk.size <= kInlineMax && inline_len + bulk.size <= max_msg_ / 2) {
+        inline_len += bulk.size;
+        continue;
+      }
+      if (!ExposeForRead(bulk, (ctx.flags & LBM_STAGE_BULKS) != 0, rndv)) {
+        Release(rndv);
+        return ENOMEM;
+      }
+    }
+
+    std::vector<char> meta_buf;
+    {
+      hshm::ipc::GlobalSerialize<std::vector<char>> ar(meta_buf);
+      ar(meta);
+      ar.Finalize();
+    }
+    FabricMsgHeader hdr{kFabricMsgData,
+                        static_cast<uint32_t>(self_name_.size()),
+                        rndv.empty() ? 0 : next_seq_, meta_buf.size(),
+                        inline_len};
+    size_t total = sizeof(hdr) + self_name_.size() + meta_buf.size() +
+                   inline_len;
+    if (total > max_msg_) {
+      HLOG(kError, "LibfabricTransport::Send - message of {} bytes exceeds {}",
+           total, max_msg_);
+      Release(rndv);
+      return E2BIG;
+    }
+    FabricOp *op = pool_->Get(total);
+    if (!op) {
+      Release(rndv);
+      return ENOMEM;
+    }
+    char *cur = op->buf_;
+    std::memcpy(cur, &hdr, sizeof(hdr));
+    cur += sizeof(hdr);
+    std::memcpy(cur, self_name_.data(), self_name_.size());
+    cur += self_name_.size();
+    std::memcpy(cur, meta_buf.data(), meta_buf.size());
+    cur += meta_buf.size();
+    for (size_t i = 0; i < meta.send.size(); ++i) {
+      const Bulk &bulk = meta.send[i];
+      if (bulk.flags.Any(BULK_XFER) && !bulk.flags.Any(BULK_RMA)) {
+        std::memcpy(cur, bulk.data.ptr_, bulk.size);
+        cur += bulk.size;
+      }
+    }
+
+    op->waited_ = ctx.IsSync();
+    int rc = PostSend(op, total, dest);
+    if (rc != 0) {
+      HLOG(kError, "LibfabricTransport::Send - fi_send FAILED: {}",
+           fi_strerror(rc));
+      pool_->Put(op);
+      Release(rndv);
+      return rc;
+    }
+    if (!rndv.empty()) {
+      pending_[next_seq_++] = std::move(rndv);
+    }
+    if (op->waited_) {
+      rc = Wait(op);
+      pool_->Put(op);
+    }
+    return rc;
+  }
+
+  /**
+   * Receive one message, pulling its rendezvous bulks
+   * @param meta Metadata to fill; recv bulks point at transport-owned
+   *             buffers until ClearRecvHandles
+   * @param ctx Unused
+   * @return ClientInfo with rc = EAGAIN when nothing is pending
+   */
+  template <typename MetaT>
+  ClientInfo Recv(MetaT &meta, const LbmContext &ctx = LbmContext()) {
+    (void)ctx;
+    ClientInfo info;
+    std::lock_guard<std::mutex> lock(mtx_);
+    Progress();
+    if (ready_.empty()) {
+      ArmWait();
+      info.rc = EAGAIN;
+      return info;
+    }
+    FabricOp *slot = ready_.front();
+    ready_.pop_front();
+    info.rc = Unpack(slot, meta);
+#if !HSHM_IS_GPU
+    info.identity_ = meta.client_info_.identity_;
+#endif
+    int rc = PostRecv(slot);
+    if (rc != 0) {
+      HLOG(kError, "LibfabricTransport::Recv - repost FAILED: {}",
+           fi_strerror(rc));
+    }
+    return info;
+  }
+
+  /** Return the transport-owned buffers behind meta.recv */
+  void ClearRecvHandles(LbmMeta<> &meta) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    for (auto &bulk : meta.recv) {
+      if (bulk.desc) {
+        pool_->Put(static_cast<FabricOp *>(bulk.desc));
+        bulk.desc = nullptr;
+        bulk.data = hipc::FullPtr<char>::GetNull();
+      }
+    }
+  }
+
+  /** Register a long-lived region (e.g. a shared-memory backend) */
+  void RegisterMemory(char *base, size_t size) {
+    dom_->RegisterMemory(base, size);
+  }
+
+  /** Drop a region registered with RegisterMemory */
+  void DeregisterMemory(char *base) { dom_->DeregisterMemory(base); }
+
+  /** Watch the completion queue's wait fd, when the provider has one */
+  void RegisterEventManager(EventManager &em) {
+    if (wait_fd_ >= 0) {
+      em.AddEvent(wait_fd_, kDefaultReadEvent, nullptr);
+    }
+  }
+
+  std::string GetAddress() const { return addr_; }
+
+  /** RDM endpoints are connectionless; an open endpoint is alive */
+  bool IsServerAlive(const LbmContext &ctx = LbmContext()) const {
+    (void)ctx;
+    return ep_ != nullptr;
+  }
+
+ private:
+  /** Buffers a sender keeps until the peer's FIN */
+  struct Rendezvous {
+    std::vector<FabricMr> temp_mrs_;   /**< Per-message registrations */
+    std::vector<FabricOp *> staged_;   /**< LBM_STAGE_BULKS copies */
+    bool empty() const { return temp_mrs_.empty() && staged_.empty(); }
+  };
+
+  /** Open AV, CQ and endpoint; clients resolve the server address */
+  void OpenEndpoint(TransportMode mode) {
+    fi_info *hints = fi_dupinfo(dom_->info_);
+    std::free(hints->src_addr);
+    hints->src_addr = nullptr;
+    hints->src_addrlen = 0;
+    std::free(hints->dest_addr);
+    hints->dest_addr = nullptr;
+    hints->dest_addrlen = 0;
+    std::string service = std::to_string(port_);
+    uint64_t flags = mode == TransportMode::kServer ? FI_SOURCE : 0;
+    int rc = fi_getinfo(kFabricVersion, addr_.c_str(), service.c_str(), flags,
+                        hints, &info_);
+    fi_freeinfo(hints);
+    if (rc != 0 || !info_) {
+      info_ = nullptr;
+      throw std::runtime_error("LibfabricTransport: fi_getinfo(" + addr_ +
+                               ":" + service + ") failed: " +
+                               fi_strerror(-rc));
+    }
+    max_msg_ = std::min(kEagerMsgSize, info_->ep_attr->max_msg_size);
+    max_rma_ = info_->ep_attr->max_msg_size;
+
+    fi_av_attr av_attr = {};
+    av_attr.type = FI_AV_TABLE;
+    fi_cq_attr cq_attr = {};
+    cq_attr.format = FI_CQ_FORMAT_MSG;
+    cq_attr.size = 4 * kRecvDepth;
+    cq_attr.wait_obj = FI_WAIT_FD;
+    rc = fi_av_open(dom_->domain_, &av_attr, &av_, nullptr);
+    if (rc == 0 && fi_cq_open(dom_->domain_, &cq_attr, &cq_, nullptr) != 0) {
+      // Provider has no wait fd; the worker polls instead
+      cq_attr.wait_obj = FI_WAIT_NONE;
+      rc = fi_cq_open(dom_->domain_, &cq_attr, &cq_, nullptr);
+    }
+    if (rc == 0) rc = fi_endpoint(dom_->domain_, info_, &ep_, nullptr);
+    if (rc == 0) rc = fi_ep_bind(ep_, &av_->fid, 0);
+    if (rc == 0) rc = fi_ep_bind(ep_, &cq_->fid, FI_TRANSMIT | FI_RECV);
+    if (rc == 0) rc = fi_enable(ep_);
+    if (rc == 0 && mode == TransportMode::kClient) {
+      rc = fi_av_insert(av_, info_->dest_addr, 1, &server_addr_, 0,
+                        nullptr) == 1
+               ? 0
+               : -FI_EADDRNOTAVAIL;
+    }
+    if (rc == 0) {
+      char name[256];
+      size_t name_len = sizeof(name);
+      rc = fi_getname(&ep_->fid, name, &name_len);
+      self_name_.assign(name, name_len);
+    }
+    if (rc != 0) {
+      Close();
+      throw std::runtime_error("LibfabricTransport: opening endpoint on " +
+                               addr_ + ":" + service + " failed: " +
+                               fi_strerror(-rc));
+    }
+    if (cq_attr.wait_obj == FI_WAIT_FD &&
+        fi_control(&cq_->fid, FI_GETWAIT, &wait_fd_) != 0) {
+      wait_fd_ = -1;
+    }
+  }
+
+  /** Release every libfabric resource owned by this endpoint */
+  void Close() {
+    if (ep_) fi_close(&ep_->fid);
+    ep_ = nullptr;
+    for (FabricOp *slot : posted_) pool_->Put(slot);
+    posted_.clear();
+    for (auto &pair : pending_) Release(pair.second);
+    pending_.clear();
+    if (cq_) fi_close(&cq_->fid);
+    cq_ = nullptr;
+    if (av_) fi_close(&av_->fid);
+    av_ = nullptr;
+    if (info_) fi_freeinfo(info_);
+    info_ = nullptr;
+  }
+
+  /** Pick the destination: the server for clients, identity_ for servers */
+  template <typename MetaT>
+  bool ResolveDest(MetaT &meta, fi_addr_t &dest) {
+    if (IsClient()) {
+      dest = server_addr_;
+      return true;
+    }
+#if !HSHM_IS_GPU
+    if (!meta.client_info_.identity_.empty()) {
+      return LookupPeer(meta.client_info_.identity_, dest);
+    }
+#endif
+    HLOG(kError, "LibfabricTransport::Send(server) - no peer identity");
+    return false;
+  }
+
+  /** Resolve (and cache) a peer endpoint name */
+  bool LookupPeer(const std::string &name, fi_addr_t &addr) {
+    auto it = peers_.find(name);
+    if (it != peers_.end()) {
+      addr = it->second;
+      return true;
+    }
+    if (fi_av_insert(av_, name.data(), 1, &addr, 0, nullptr) != 1) {
+      HLOG(kError, "LibfabricTransport - fi_av_insert of peer failed");
+      return false;
+    }
+    peers_[name] = addr;
+    return true;
+  }
+
+  /** Mark a bulk BULK_RMA and fill its raddr/rkey */
+  bool ExposeForRead(Bulk &bulk, bool stage, Rendezvous &rndv) {
+    const char *ptr = bulk.data.ptr_;
+    FabricMr mr;
+    if (stage) {
+      FabricOp *copy = pool_->Get(bulk.size);
+      if (!copy) return false;
+      std::memcpy(copy->buf_, bulk.data.ptr_, bulk.size);
+      rndv.staged_.push_back(copy);
+      mr = copy->mr_;
+      ptr = copy->buf_;
+    } else if (!dom_->FindMr(ptr, bulk.size, mr)) {
+      if (!dom_->Register(bulk.data.ptr_, bulk.size, mr)) return false;
+      rndv.temp_mrs_.push_back(mr);
+    }
+    bulk.raddr = dom_->RemoteAddr(mr, ptr);
+    bulk.rkey = mr.key_;
+    bulk.flags.SetBits(BULK_RMA);
+    return true;
+  }
+
+  /** Free what a sender held for a rendezvous */
+  void Release(Rendezvous &rndv) {
+    for (auto &mr : rndv.temp_mrs_) FabricDomain::Close(mr);
+    for (FabricOp *copy : rndv.staged_) pool_->Put(copy);
+    rndv.temp_mrs_.clear();
+    rndv.staged_.clear();
+  }
+
+  /** Parse a received message into meta, pulling rendezvous bulks */
+  template <typename MetaT>
+  int Unpack(FabricOp *slot, MetaT &meta) {
+    FabricMsgHeader hdr;
+    std::memcpy(&hdr, slot->buf_, sizeof(hdr));
+    const char *cur = slot->buf_ + sizeof(hdr);
+    std::string name(cur, hdr.name_len_);
+    cur += hdr.name_len_;
+    try {
+      hshm::ipc::ByteView meta_buf(cur, hdr.meta_len_);
+      hshm::ipc::GlobalDeserialize<hshm::ipc::ByteView> ar(meta_buf);
+      ar(meta);
+    } catch (const std::exception &e) {
+      HLOG(kFatal, "LibfabricTransport::Recv - deserialization failed: {}",
+           e.what());
+      return -1;
+    }
+    cur += hdr.meta_len_;
+#if !HSHM_IS_GPU
+    meta.client_info_.identity_ = name;
+#endif
+    fi_addr_t src;
+    if (!LookupPeer(name, src)) {
+      return EHOSTUNREACH;
+    }
+
+    std::vector<FabricOp *> reads;
+    int rc = 0;
+    for (const auto &send_bulk : meta.send) {
+      Bulk recv_bulk;
+      recv_bulk.size = send_bulk.size;
+      recv_bulk.flags = send_bulk.flags;
+      recv_bulk.flags.UnsetBits(BULK_RMA);
+      recv_bulk.data = hipc::FullPtr<char>::GetNull();
+      if (send_bulk.flags.Any(BULK_XFER) && rc == 0) {
+        FabricOp *dst = pool_->Get(send_bulk.size);
+        if (!dst) {
+          rc = ENOMEM;
+        } else {
+          recv_bulk.data.ptr_ = dst->buf_;
+          recv_bulk.data.shm_.alloc_id_ = hipc::AllocatorId::GetNull();
+          recv_bulk.data.shm_.off_ = reinterpret_cast<size_t>(dst->buf_);
+          recv_bulk.desc = dst;
+          if (send_bulk.flags.Any(BULK_RMA)) {
+            rc = PostRead(dst, send_bulk, src, reads);
+          } else {
+            std::memcpy(dst->buf_, cur, send_bulk.size);
+            cur += send_bulk.size;
+          }
+        }
+      }
+      meta.recv.push_back(recv_bulk);
+    }
+    for (FabricOp *read : reads) {
+      int read_rc = Wait(read);
+      if (read_rc != 0 && rc == 0) rc = read_rc;
+      delete read;
+    }
+    if (hdr.seq_ != 0) {
+      SendFin(src, hdr.seq_);
+    }
+    return rc;
+  }
+
+  /** Pull a BULK_RMA bulk into dst, chunked by the provider limit */
+  int PostRead(FabricOp *dst, const Bulk &bulk, fi_addr_t src,
+               std::vector<FabricOp *> &reads) {
+    for (size_t off = 0; off < bulk.size; off += max_rma_) {
+      size_t len = std::min(max_rma_, bulk.size - off);
+      auto *read = new FabricOp();
+      read->kind_ = FabricOp::kRead;
+      read->waited_ = true;
+      ssize_t rc;
+      while ((rc = fi_read(ep_, dst->buf_ + off, len, dst->mr_.desc_, src,
+                           bulk.raddr + off, bulk.rkey, read)) == -FI_EAGAIN) {
+        Progress();
+      }
+      if (rc != 0) {
+        HLOG(kError, "LibfabricTransport - fi_read FAILED: {}",
+             fi_strerror(static_cast<int>(-rc)));
+        delete read;
+        return static_cast<int>(-rc);
+      }
+      reads.push_back(read);
+    }
+    return 0;
+  }
+
+  /** Tell a sender its rendezvous buffers may be released */
+  void SendFin(fi_addr_t dest, uint64_t seq) {
+    FabricOp *op = pool_->Get(sizeof(FabricMsgHeader));
+    if (!op) return;
+    FabricMsgHeader hdr{kFabricMsgFin, 0, seq, 0, 0};
+    std::memcpy(op->buf_, &hdr, sizeof(hdr));
+    int rc = PostSend(op, sizeof(hdr), dest);
+    if (rc != 0) {
+      HLOG(kError, "LibfabricTransport - FIN send FAILED: {}", fi_strerror(rc));
+      pool_->Put(op);
+    }
+  }
+
+  /** Post a send, progressing the CQ while the provider is busy */
+  int PostSend(FabricOp *op, size_t len, fi_addr_t dest) {
+    op->kind_ = FabricOp::kSend;
+    ssize_t rc;
+    while ((rc = fi_send(ep_, op->buf_, len, op->mr_.desc_, dest, op)) ==
+           -FI_EAGAIN) {
+      Progress();
+    }
+    return static_cast<int>(-rc);
+  }
+
+  /** Post a receive slot */
+  int PostRecv(FabricOp *slot) {
+    slot->kind_ = FabricOp::kRecv;
+    ssize_t rc;
+    while ((rc = fi_recv(ep_, slot->buf_, slot->capacity_, slot->mr_.desc_,
+                         FI_ADDR_UNSPEC, slot)) == -FI_EAGAIN) {
+      Progress();
+    }
+    return static_cast<int>(-rc);
+  }
+
+  /** Progress the CQ until op completes */
+  int Wait(FabricOp *op) {
+    while (!op->done_) {
+      Progress();
+    }
+    return op->status_;
+  }
+
+  /** Re-arm the wait fd before the caller blocks on it */
+  void ArmWait() {
+    if (wait_fd_ >= 0) {
+      fid *fids[1] = {&cq_->fid};
+      fi_trywait(dom_->fabric_, fids, 1);
+    }
+  }
+
+  /** Drain the completion queue */
+  void Progress() {
+    fi_cq_msg_entry entries[16];
+    while (true) {
+      ssize_t n = fi_cq_read(cq_, entries, 16);
+      if (n == -FI_EAGAIN) {
+        return;
+      }
+      if (n == -FI_EAVAIL) {
+        fi_cq_err_entry err = {};
+        fi_cq_readerr(cq_, &err, 0);
+        HLOG(kError, "LibfabricTransport - completion error: {}",
+             fi_strerror(err.err));
+        if (err.op_context) {
+          Complete(static_cast<FabricOp *>(err.op_context), err.err, 0);
+        }
+        continue;
+      }
+      if (n < 0) {
+        HLOG(kError, "LibfabricTransport - fi_cq_read FAILED: {}",
+             fi_strerror(static_cast<int>(-n)));
+        return;
+      }
+      for (ssize_t i = 0; i < n; ++i) {
+        Complete(static_cast<FabricOp *>(entries[i].op_context), 0,
+                 entries[i].len);
+      }
+    }
+  }
+
+  /** Dispatch one completion */
+  void Complete(FabricOp *op, int status, size_t len) {
+    if (op->waited_) {
+      op->status_ = status;
+      op->done_ = true;
+      return;
+    }
+    switch (op->kind_) {
+      case FabricOp::kRecv: {
+        FabricMsgHeader hdr;
+        if (status != 0 || len < sizeof(hdr)) {
+          PostRecv(op);
+          return;
+        }
+        std::memcpy(&hdr, op->buf_, sizeof(hdr));
+        if (hdr.kind_ == kFabricMsgFin) {
+          auto it = pending_.find(hdr.seq_);
+          if (it != pending_.end()) {
+            Release(it->second);
+            pending_.erase(it);
+          }
+          PostRecv(op);
+          return;
+        }
+        op->len_ = len;
+        ready_.push_back(op);
+        return;
+      }
+      case FabricOp::kSend:
+        pool_->Put(op);
+        return;
+      case FabricOp::kRead:
+        return;
+    }
+  }
+
+  std::string addr_;                       /**< Host address */
+  int port_;                               /**< Service port */
+  std::shared_ptr<FabricDomain> dom_;      /**< Shared fabric/domain */
+  std::unique_ptr<FabricBufferPool> pool_; /**< Registered buffers */
+  fi_info *info_ = nullptr;                /**< Endpoint info */
+  fid_av *av_ = nullptr;                   /**< Address vector */
+  fid_cq *cq_ = nullptr;                   /**< Transmit + receive CQ */
+  fid_ep *ep_ = nullptr;                   /**< RDM endpoint */
+  int wait_fd_ = -1;                       /**< CQ wait fd, if any */
+  size_t max_msg_ = kEagerMsgSize;         /**< Largest message */
+  size_t max_rma_ = kEagerMsgSize;         /**< Largest single fi_read */
+  fi_addr_t server_addr_ = FI_ADDR_UNSPEC; /**< Server address (clients) */
+  std::string self_name_;                  /**< Own endpoint name */
+  std::unordered_map<std::string, fi_addr_t> peers_; /**< Peer name cache */
+  std::vector<FabricOp *> posted_;         /**< Receive slots we own */
+  std::deque<FabricOp *> ready_;           /**< Received, not yet consumed */
+  std::map<uint64_t, Rendezvous> pending_; /**< Awaiting FIN, by sequence */
+  uint64_t next_seq_ = 1;                  /**< Next rendezvous sequence */
+  std::mutex mtx_;                         /**< Serializes CQ access */
+};
+
+}  // namespace hshm::lbm
+
+#endif  // HSHM_ENABLE_LIBFABRIC
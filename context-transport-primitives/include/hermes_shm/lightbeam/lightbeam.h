@@ -59,6 +59,9 @@ struct ShmTransferInfo;
 #define BULK_EXPOSE \
   BIT_OPT(hshm::u32, 0)                  // Bulk metadata sent, no data transfer
 #define BULK_XFER BIT_OPT(hshm::u32, 1)  // Bulk marked for data transmission
+#define BULK_RMA BIT_OPT(hshm::u32, 2)   // Receiver pulls via raddr/rkey
+#define BULK_RECV_ALLOC \
+  BIT_OPT(hshm::u32, 3)  // Recv buffer came from LbmContext::recv_alloc_
 
 // --- Types ---
 struct Bulk {
@@ -67,11 +70,13 @@ struct Bulk {
   hshm::bitfield32_t flags;  // BULK_EXPOSE or BULK_XFER
   void* desc = nullptr;      // For RDMA memory registration
   void* mr = nullptr;        // For RDMA memory region handle (fid_mr*)
+  hshm::u64 raddr = 0;       // Remote address for BULK_RMA reads
+  hshm::u64 rkey = 0;        // Remote key for BULK_RMA reads
 
-  /** Serialize bulk descriptor metadata (size and flags only) */
+  /** Serialize bulk descriptor metadata (no data pointers) */
   template <typename Ar>
   HSHM_CROSS_FUN void serialize(Ar& ar) {
-    ar(size, flags);
+    ar(size, flags, raddr, rkey);
   }
 };
 
@@ -149,9 +154,25 @@ class LbmMeta {
   }
 };
 
+// --- Receive buffer allocation ---
+/**
+ * Supplies the buffers that received bulks are written into, so stream
+ * transports can land remote data once in its final home (e.g. a shared
+ * memory allocator) instead of transport-owned memory. Allocate may return
+ * a null FullPtr, in which case the transport falls back to its own buffer.
+ */
+class RecvAllocator {
+ public:
+  virtual ~RecvAllocator() = default;
+  virtual hipc::FullPtr<char> Allocate(size_t size) = 0;
+  virtual void Free(const hipc::FullPtr<char>& buf) = 0;
+};
+
 // --- LbmContext ---
 constexpr uint32_t LBM_SYNC =
     0x1; /**< Synchronous send (wait for completion) */
+constexpr uint32_t LBM_STAGE_BULKS =
+    0x2; /**< Caller may free bulk buffers as soon as Send returns */
 
 struct LbmContext {
   uint32_t flags;      /**< Combination of LBM_* flags */
@@ -164,6 +185,7 @@ struct LbmContext {
   int server_pid_ = 0;                             /**< Server PID for SHM liveness check */
   int dst_fd_ = -1;                                /**< Destination file descriptor for CPU→storage (-1 = none) */
   size_t dst_offset_ = 0;                          /**< Offset within destination file for CPU→storage */
+  RecvAllocator* recv_alloc_ = nullptr;            /**< Home for received bulks (null = transport-owned) */
 
   HSHM_CROSS_FUN LbmContext() : flags(0), timeout_ms(0) {}
 
@@ -182,7 +204,14 @@ struct LbmContext {
 };
 
 // --- Transport Type Enum ---
-enum class TransportType { kZeroMq, kSocket, kShm, kNixl };
+enum class TransportType {
+  kZeroMq,
+  kSocket,
+  kShm,
+  kNixl,
+  kLibfabric,
+  kIoUring
+};
 
 // --- Transport Mode Enum ---
 enum class TransportMode { kClient, kServer };
@@ -216,6 +245,10 @@ class Transport {
   // Event registration API
   void RegisterEventManager(EventManager &em);
 
+  // Long-lived memory registration (no-op unless the transport does RDMA)
+  void RegisterMemory(char* base, size_t size);
+  void DeregisterMemory(char* base);
+
   // Liveness check
   bool IsServerAlive(const LbmContext& ctx = LbmContext()) const;
 };
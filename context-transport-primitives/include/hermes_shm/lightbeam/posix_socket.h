@@ -109,6 +109,13 @@ HSHM_DLL ssize_t SendV(socket_t fd, const IoBuffer* iov, int count);
 /** Receive exactly len bytes. Returns 0 on success, -1 on error/short read. */
 HSHM_DLL int RecvExact(socket_t fd, char* buf, size_t len);
 
+/**
+ * Scatter-gather receive: fill every buffer in iov, in order, using as few
+ * recvmsg calls as the socket allows. Waits for readability between partial
+ * reads. Returns 0 on success, -1 on error/short read.
+ */
+HSHM_DLL int RecvExactV(socket_t fd, const IoBuffer* iov, int count);
+
 /** Poll a single fd for readability. Returns >0 if ready, 0 on timeout, -1 on error. */
 HSHM_DLL int PollRead(socket_t fd, int timeout_ms);
 
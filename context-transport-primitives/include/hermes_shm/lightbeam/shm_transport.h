@@ -45,6 +45,8 @@
 #include <csignal>
 #include "hermes_shm/data_structures/serialization/local_serialize.h"
 #include "hermes_shm/data_structures/priv/array_vector.h"
+#include "hermes_shm/data_structures/priv/wrap_vector.h"
+#include "hermes_shm/thread/lock/futex.h"
 #include "hermes_shm/thread/thread_model_manager.h"
 #include "lightbeam.h"
 
@@ -59,6 +61,8 @@ struct ShmTransferInfo {
   hipc::atomic<size_t> total_read_;      // Total bytes read by consumer
   hipc::atomic<size_t> copy_space_size_; // Ring buffer capacity (atomic for
                                          // cross-SM L2 visibility on GPU)
+  hshm::Futex notify_;                   // Parks a host side waiting on an
+                                         // empty or full ring
 
   HSHM_CROSS_FUN ShmTransferInfo() {
     total_written_.store(0);
@@ -73,6 +77,12 @@ class ShmTransport
 #endif
 {
  public:
+  /**
+   * Cap on each futex sleep while waiting for the peer. GPU producers
+   * never call WakeAll(), so host waiters must poll at this period.
+   */
+  static constexpr u32 kParkUs = 100;
+
 #if HSHM_IS_HOST
   explicit ShmTransport(TransportMode mode) : Transport(mode) {
     type_ = TransportType::kShm;
@@ -112,7 +122,9 @@ class ShmTransport
   /**
    * GPU-compatible static Send.
    * Serializes metadata and bulk descriptors through the SPSC ring buffer.
-   * Uses the meta's allocator for temporary serialization buffers.
+   * On the host, metadata that fits the free contiguous ring space is
+   * serialized in place; otherwise the meta's allocator backs a temporary
+   * serialization buffer.
    *
    * @tparam MetaT Metadata type (must have allocator_type and alloc_ member)
    * @param meta Metadata with send bulk descriptors to transfer
@@ -125,18 +137,25 @@ class ShmTransport
     using AllocT = typename MetaT::allocator_type;
     using CharVec = hshm::priv::vector<char, AllocT>;
 
-    // 1. Serialize metadata using LocalSerialize with allocator-backed buffer
-    CharVec meta_buf(meta.alloc_);
-    meta_buf.reserve(ctx.shm_info_->copy_space_size_.load());
-    hshm::ipc::LocalSerialize<CharVec> ar(meta_buf);
-    ar(meta);
-    ar.Finalize();
-
-    // 2. Transfer serialized size then metadata
-    uint32_t meta_len = static_cast<uint32_t>(meta_buf.size());
-    WriteTransfer(reinterpret_cast<const char*>(&meta_len), sizeof(meta_len),
-                  ctx);
-    WriteTransfer(meta_buf.data(), meta_buf.size(), ctx);
+#if HSHM_IS_HOST
+    bool sent_in_place = SendMetaInPlace(meta, ctx);
+#else
+    bool sent_in_place = false;
+#endif
+    if (!sent_in_place) {
+      // 1. Serialize metadata using LocalSerialize with allocator-backed buffer
+      CharVec meta_buf(meta.alloc_);
+      meta_buf.reserve(ctx.shm_info_->copy_space_size_.load());
+      hshm::ipc::LocalSerialize<CharVec> ar(meta_buf);
+      ar(meta);
+      ar.Finalize();
+
+      // 2. Transfer serialized size then metadata
+      uint32_t meta_len = static_cast<uint32_t>(meta_buf.size());
+      WriteTransfer(reinterpret_cast<const char*>(&meta_len), sizeof(meta_len),
+                    ctx);
+      WriteTransfer(meta_buf.data(), meta_buf.size(), ctx);
+    }
 
     // 3. Send each bulk with BULK_XFER or BULK_EXPOSE flag
     for (size_t i = 0; i < meta.send.size(); ++i) {
@@ -181,13 +200,19 @@ class ShmTransport
     uint32_t meta_len = 0;
     ReadTransfer(reinterpret_cast<char*>(&meta_len), sizeof(meta_len), ctx);
 
-    // 2. Receive metadata bytes into allocator-backed buffer
-    CharVec meta_buf(meta_len, meta.alloc_);
-    ReadTransfer(meta_buf.data(), meta_len, ctx);
-
-    // 3. Deserialize using LocalDeserialize
-    hshm::ipc::LocalDeserialize<CharVec> ar(meta_buf);
-    ar(meta);
+    // 2-3. Deserialize straight out of the ring when the whole message has
+    // landed contiguously, otherwise stage it in an allocator-backed buffer
+#if HSHM_IS_HOST
+    bool recv_in_place = RecvMetaInPlace(meta, meta_len, ctx);
+#else
+    bool recv_in_place = false;
+#endif
+    if (!recv_in_place) {
+      CharVec meta_buf(meta_len, meta.alloc_);
+      ReadTransfer(meta_buf.data(), meta_len, ctx);
+      hshm::ipc::LocalDeserialize<CharVec> ar(meta_buf);
+      ar(meta);
+    }
 
     // 4. Set up recv entries from send descriptors
     for (size_t i = 0; i < meta.send.size(); ++i) {
@@ -339,6 +364,95 @@ class ShmTransport
   }
 
  private:
+#if HSHM_IS_HOST
+  /**
+   * Serialize metadata directly into the next ring slot.
+   *
+   * Sizes the metadata with CalculateSizeArchive (the task payload is a
+   * single opaque blob at this level, so this does not re-walk the task),
+   * then serializes into copy_space behind the length prefix and publishes
+   * both with one total_written_ store. Skips the per-send scratch buffer
+   * and its extra copy. Only used when the message fits in the free,
+   * contiguous part of the ring; the caller falls back to chunked writes.
+   *
+   * @return true if the metadata was written; false to use the slow path
+   */
+  template <typename MetaT>
+  static bool SendMetaInPlace(MetaT& meta, const LbmContext& ctx) {
+    size_t ring_size = ctx.shm_info_->copy_space_size_.load_system();
+    if (ring_size <= sizeof(uint32_t)) {
+      return false;
+    }
+    hshm::ipc::CalculateSizeArchive calc;
+    calc(meta);
+    size_t need = sizeof(uint32_t) + calc.size();
+    size_t total_written = ctx.shm_info_->total_written_.load_system();
+    size_t total_read = ctx.shm_info_->total_read_.load_system();
+    size_t write_pos = total_written % ring_size;
+    size_t free_space = ring_size - (total_written - total_read);
+    size_t contig = ring_size - write_pos;
+    size_t room = (free_space < contig) ? free_space : contig;
+    if (need > room) {
+      return false;
+    }
+
+    // Bound the view by the free region rather than the estimate, and take
+    // the length from what was actually written
+    char* slot = ctx.copy_space + write_pos;
+    hipc::FullPtr<char> body;
+    body.ptr_ = slot + sizeof(uint32_t);
+    body.shm_.alloc_id_.SetNull();
+    body.shm_.off_ = reinterpret_cast<size_t>(body.ptr_);
+    hshm::priv::wrap_vector buf(body, room - sizeof(uint32_t));
+    hshm::ipc::LocalSerialize<hshm::priv::wrap_vector> ar(buf);
+    ar(meta);
+    ar.Finalize();
+
+    uint32_t meta_len = static_cast<uint32_t>(buf.size());
+    std::memcpy(slot, &meta_len, sizeof(meta_len));
+    ctx.shm_info_->total_written_.store_system(total_written +
+                                               sizeof(uint32_t) + meta_len);
+    ctx.shm_info_->notify_.WakeAll();
+    return true;
+  }
+
+  /**
+   * Deserialize metadata in place from the ring if all meta_len bytes are
+   * already readable without wrapping. Releases the bytes to the writer
+   * only after deserialization has copied everything it needs.
+   *
+   * @return true if metadata was consumed; false to use the slow path
+   */
+  template <typename MetaT>
+  static bool RecvMetaInPlace(MetaT& meta, uint32_t meta_len,
+                              const LbmContext& ctx) {
+    size_t ring_size = ctx.shm_info_->copy_space_size_.load_system();
+    size_t total_read = ctx.shm_info_->total_read_.load_system();
+    size_t total_written = ctx.shm_info_->total_written_.load_system();
+    size_t read_pos = total_read % ring_size;
+    if (total_written - total_read < meta_len ||
+        ring_size - read_pos < meta_len) {
+      return false;
+    }
+    hipc::FullPtr<char> body;
+    body.ptr_ = ctx.copy_space + read_pos;
+    body.shm_.alloc_id_.SetNull();
+    body.shm_.off_ = reinterpret_cast<size_t>(body.ptr_);
+    hshm::priv::wrap_vector buf(body, meta_len);
+    buf.resize(meta_len);
+#if defined(__has_feature)
+#if __has_feature(memory_sanitizer)
+    __msan_unpoison(body.ptr_, meta_len);
+#endif
+#endif
+    hshm::ipc::LocalDeserialize<hshm::priv::wrap_vector> ar(buf);
+    ar(meta);
+    ctx.shm_info_->total_read_.store_system(total_read + meta_len);
+    ctx.shm_info_->notify_.WakeAll();
+    return true;
+  }
+#endif
+
   // GPU-safe min of three values
   HSHM_CROSS_FUN
   static size_t Min3(size_t a, size_t b, size_t c) {
@@ -401,7 +515,11 @@ class ShmTransport
       size_t space = ring_size - (total_written - total_read);
       if (space == 0) {
 #if HSHM_IS_HOST
-        HSHM_THREAD_MODEL->Yield();
+        ctx.shm_info_->notify_.Wait(
+            [&]() {
+              return ctx.shm_info_->total_read_.load_system() != total_read;
+            },
+            kParkUs);
 #endif
         continue;
       }
@@ -412,6 +530,9 @@ class ShmTransport
       offset += chunk;
       total_written += chunk;
       ctx.shm_info_->total_written_.store_system(total_written);
+#if HSHM_IS_HOST
+      ctx.shm_info_->notify_.WakeAll();
+#endif
     }
   }
 
@@ -457,7 +578,12 @@ class ShmTransport
       size_t avail = total_written - total_read;
       if (avail == 0) {
 #if HSHM_IS_HOST
-        HSHM_THREAD_MODEL->Yield();
+        ctx.shm_info_->notify_.Wait(
+            [&]() {
+              return ctx.shm_info_->total_written_.load_system() !=
+                     total_written;
+            },
+            kParkUs);
 #endif
         continue;
       }
@@ -468,6 +594,9 @@ class ShmTransport
       offset += chunk;
       total_read += chunk;
       ctx.shm_info_->total_read_.store_system(total_read);
+#if HSHM_IS_HOST
+      ctx.shm_info_->notify_.WakeAll();
+#endif
     }
   }
 
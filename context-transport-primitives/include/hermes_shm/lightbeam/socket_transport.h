@@ -36,6 +36,7 @@
 #include <algorithm>
 #include <cstring>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include "hermes_shm/util/logging.h"
@@ -183,7 +184,8 @@ class SocketTransport : public Transport {
 
   void ClearRecvHandles(LbmMeta<>& meta) {
     for (auto& bulk : meta.recv) {
-      if (bulk.data.ptr_) {
+      // Buffers from an LbmContext::recv_alloc_ belong to the caller
+      if (bulk.data.ptr_ && !bulk.flags.Any(BULK_RECV_ALLOC)) {
         std::free(bulk.data.ptr_);
         bulk.data.ptr_ = nullptr;
       }
@@ -260,10 +262,9 @@ class SocketTransport : public Transport {
       ar(meta);
       ar.Finalize();
     }
-    std::string meta_str(meta_buf.begin(), meta_buf.end());
 
     // 2. Build iovec: [4-byte BE length prefix][metadata][bulk0][bulk1]...
-    uint32_t meta_len = htonl(static_cast<uint32_t>(meta_str.size()));
+    uint32_t meta_len = htonl(static_cast<uint32_t>(meta_buf.size()));
 
     int iov_count = 2;
     for (size_t i = 0; i < meta.send.size(); ++i) {
@@ -277,8 +278,8 @@ class SocketTransport : public Transport {
     iov[idx].base = &meta_len;
     iov[idx].len = sizeof(meta_len);
     idx++;
-    iov[idx].base = const_cast<char*>(meta_str.data());
-    iov[idx].len = meta_str.size();
+    iov[idx].base = meta_buf.data();
+    iov[idx].len = meta_buf.size();
     idx++;
 
     for (size_t i = 0; i < meta.send.size(); ++i) {
@@ -387,12 +388,11 @@ class SocketTransport : public Transport {
     if (rc != 0) return -1;
 
     uint32_t meta_len = ntohl(net_len);
-    std::string meta_str(meta_len, '\0');
-    rc = sock::RecvExact(fd, &meta_str[0], meta_len);
+    std::vector<char> meta_buf(meta_len);
+    rc = sock::RecvExact(fd, meta_buf.data(), meta_len);
     if (rc != 0) return -1;
 
     try {
-      std::vector<char> meta_buf(meta_str.begin(), meta_str.end());
       hshm::ipc::GlobalDeserialize<std::vector<char>> ar(meta_buf);
       ar(meta);
     } catch (const std::exception& e) {
@@ -403,40 +403,53 @@ class SocketTransport : public Transport {
     return 0;
   }
 
-  /** Pure recv bulks on a specific fd */
+  /**
+   * Pure recv bulks on a specific fd
+   * Every transferred bulk is read with one scatter recvmsg pass straight
+   * into its destination: the exposed buffer if the caller set one, else a
+   * buffer from ctx.recv_alloc_ (sized from the metadata), else malloc.
+   */
   template <typename MetaT>
   int RecvBulks(sock::socket_t fd, MetaT& meta, const LbmContext& ctx) {
-    (void)ctx;
+    std::vector<sock::IoBuffer> iov;
+    // recv indices whose buffer we allocated, and whether recv_alloc_ did
+    std::vector<std::pair<size_t, bool>> owned;
+    iov.reserve(meta.recv.size());
     for (size_t i = 0; i < meta.recv.size(); ++i) {
-      if (!meta.recv[i].flags.Any(BULK_XFER)) continue;
-
-      char* buf = meta.recv[i].data.ptr_;
-      bool allocated = false;
-      if (!buf) {
-        buf = static_cast<char*>(std::malloc(meta.recv[i].size));
-        allocated = true;
-      }
-
-      int rc;
-      while (true) {
-        rc = sock::RecvExact(fd, buf, meta.recv[i].size);
-        if (rc != EAGAIN) break;
-        if (sock::PollRead(fd, 1000) <= 0) {
-          rc = -1;
-          break;
+      Bulk& bulk = meta.recv[i];
+      if (!bulk.flags.Any(BULK_XFER)) continue;
+      if (!bulk.data.ptr_) {
+        if (ctx.recv_alloc_) {
+          bulk.data = ctx.recv_alloc_->Allocate(bulk.size);
         }
+        bool from_alloc = bulk.data.ptr_ != nullptr;
+        if (from_alloc) {
+          bulk.flags.SetBits(BULK_RECV_ALLOC);
+        } else {
+          char* buf = static_cast<char*>(std::malloc(bulk.size));
+          bulk.data.ptr_ = buf;
+          bulk.data.shm_.alloc_id_ = hipc::AllocatorId::GetNull();
+          bulk.data.shm_.off_ = reinterpret_cast<size_t>(buf);
+        }
+        owned.emplace_back(i, from_alloc);
       }
-
-      if (rc != 0) {
-        if (allocated) std::free(buf);
-        return sock::GetError();
-      }
-
-      if (allocated) {
-        meta.recv[i].data.ptr_ = buf;
-        meta.recv[i].data.shm_.alloc_id_ = hipc::AllocatorId::GetNull();
-        meta.recv[i].data.shm_.off_ = reinterpret_cast<size_t>(buf);
+      iov.push_back({bulk.data.ptr_, bulk.size});
+    }
+    if (iov.empty()) return 0;
+
+    if (sock::RecvExactV(fd, iov.data(), static_cast<int>(iov.size())) != 0) {
+      int err = sock::GetError();
+      for (const auto& [i, from_alloc] : owned) {
+        Bulk& bulk = meta.recv[i];
+        if (from_alloc) {
+          ctx.recv_alloc_->Free(bulk.data);
+          bulk.flags.UnsetBits(BULK_RECV_ALLOC);
+        } else {
+          std::free(bulk.data.ptr_);
+        }
+        bulk.data = hipc::FullPtr<char>::GetNull();
       }
+      return err;
     }
     return 0;
   }
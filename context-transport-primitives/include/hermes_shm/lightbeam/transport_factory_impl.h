@@ -48,6 +48,9 @@
 #if HSHM_ENABLE_NIXL
 #include "nixl_transport.h"
 #endif
+#if HSHM_ENABLE_IO_URING && !defined(_WIN32)
+#include "io_uring_transport.h"
+#endif
 
 namespace hshm::lbm {
 
@@ -71,6 +74,16 @@ inline void TransportDeleter::operator()(Transport* t) const {
     case TransportType::kNixl:
       delete static_cast<NixlTransport*>(t);
       break;
+#endif
+#if HSHM_ENABLE_LIBFABRIC
+    case TransportType::kLibfabric:
+      delete static_cast<LibfabricTransport*>(t);
+      break;
+#endif
+#if HSHM_ENABLE_IO_URING && !defined(_WIN32)
+    case TransportType::kIoUring:
+      delete static_cast<IoUringTransport*>(t);
+      break;
 #endif
     default:
       delete t;
@@ -92,6 +105,16 @@ inline Bulk Transport::Expose(const hipc::FullPtr<char>& ptr, size_t data_size,
 #if HSHM_ENABLE_NIXL
     case TransportType::kNixl:
       return static_cast<NixlTransport*>(this)->Expose(ptr, data_size, flags);
+#endif
+#if HSHM_ENABLE_LIBFABRIC
+    case TransportType::kLibfabric:
+      return static_cast<LibfabricTransport*>(this)->Expose(ptr, data_size,
+                                                            flags);
+#endif
+#if HSHM_ENABLE_IO_URING && !defined(_WIN32)
+    case TransportType::kIoUring:
+      return static_cast<IoUringTransport*>(this)->Expose(ptr, data_size,
+                                                          flags);
 #endif
     default:
       return Bulk{};
@@ -111,6 +134,14 @@ inline std::string Transport::GetAddress() const {
 #if HSHM_ENABLE_NIXL
     case TransportType::kNixl:
       return static_cast<const NixlTransport*>(this)->GetAddress();
+#endif
+#if HSHM_ENABLE_LIBFABRIC
+    case TransportType::kLibfabric:
+      return static_cast<const LibfabricTransport*>(this)->GetAddress();
+#endif
+#if HSHM_ENABLE_IO_URING && !defined(_WIN32)
+    case TransportType::kIoUring:
+      return static_cast<const IoUringTransport*>(this)->GetAddress();
 #endif
     default:
       return "";
@@ -134,6 +165,16 @@ inline void Transport::ClearRecvHandles(LbmMeta<>& meta) {
     case TransportType::kNixl:
       static_cast<NixlTransport*>(this)->ClearRecvHandles(meta);
       break;
+#endif
+#if HSHM_ENABLE_LIBFABRIC
+    case TransportType::kLibfabric:
+      static_cast<LibfabricTransport*>(this)->ClearRecvHandles(meta);
+      break;
+#endif
+#if HSHM_ENABLE_IO_URING && !defined(_WIN32)
+    case TransportType::kIoUring:
+      static_cast<IoUringTransport*>(this)->ClearRecvHandles(meta);
+      break;
 #endif
     default:
       break;
@@ -157,12 +198,49 @@ inline void Transport::RegisterEventManager(EventManager &em) {
     case TransportType::kNixl:
       static_cast<NixlTransport*>(this)->RegisterEventManager(em);
       break;
+#endif
+#if HSHM_ENABLE_LIBFABRIC
+    case TransportType::kLibfabric:
+      static_cast<LibfabricTransport*>(this)->RegisterEventManager(em);
+      break;
+#endif
+#if HSHM_ENABLE_IO_URING && !defined(_WIN32)
+    case TransportType::kIoUring:
+      static_cast<IoUringTransport*>(this)->RegisterEventManager(em);
+      break;
 #endif
     default:
       break;
   }
 }
 
+inline void Transport::RegisterMemory(char* base, size_t size) {
+  switch (type_) {
+#if HSHM_ENABLE_LIBFABRIC
+    case TransportType::kLibfabric:
+      static_cast<LibfabricTransport*>(this)->RegisterMemory(base, size);
+      break;
+#endif
+    default:
+      (void)base;
+      (void)size;
+      break;
+  }
+}
+
+inline void Transport::DeregisterMemory(char* base) {
+  switch (type_) {
+#if HSHM_ENABLE_LIBFABRIC
+    case TransportType::kLibfabric:
+      static_cast<LibfabricTransport*>(this)->DeregisterMemory(base);
+      break;
+#endif
+    default:
+      (void)base;
+      break;
+  }
+}
+
 inline bool Transport::IsServerAlive(const LbmContext& ctx) const {
   switch (type_) {
 #if HSHM_ENABLE_ZMQ
@@ -176,6 +254,14 @@ inline bool Transport::IsServerAlive(const LbmContext& ctx) const {
 #if HSHM_ENABLE_NIXL
     case TransportType::kNixl:
       return static_cast<const NixlTransport*>(this)->IsServerAlive(ctx);
+#endif
+#if HSHM_ENABLE_LIBFABRIC
+    case TransportType::kLibfabric:
+      return static_cast<const LibfabricTransport*>(this)->IsServerAlive(ctx);
+#endif
+#if HSHM_ENABLE_IO_URING && !defined(_WIN32)
+    case TransportType::kIoUring:
+      return static_cast<const IoUringTransport*>(this)->IsServerAlive(ctx);
 #endif
     default:
       return false;
@@ -199,6 +285,14 @@ int Transport::Send(MetaT& meta, const LbmContext& ctx) {
 #if HSHM_ENABLE_NIXL
     case TransportType::kNixl:
       return static_cast<NixlTransport*>(this)->Send(meta, ctx);
+#endif
+#if HSHM_ENABLE_LIBFABRIC
+    case TransportType::kLibfabric:
+      return static_cast<LibfabricTransport*>(this)->Send(meta, ctx);
+#endif
+#if HSHM_ENABLE_IO_URING && !defined(_WIN32)
+    case TransportType::kIoUring:
+      return static_cast<IoUringTransport*>(this)->Send(meta, ctx);
 #endif
     default:
       return -1;
@@ -219,6 +313,14 @@ ClientInfo Transport::Recv(MetaT& meta, const LbmContext& ctx) {
 #if HSHM_ENABLE_NIXL
     case TransportType::kNixl:
       return static_cast<NixlTransport*>(this)->Recv(meta, ctx);
+#endif
+#if HSHM_ENABLE_LIBFABRIC
+    case TransportType::kLibfabric:
+      return static_cast<LibfabricTransport*>(this)->Recv(meta, ctx);
+#endif
+#if HSHM_ENABLE_IO_URING && !defined(_WIN32)
+    case TransportType::kIoUring:
+      return static_cast<IoUringTransport*>(this)->Recv(meta, ctx);
 #endif
     default:
       return ClientInfo{-1, -1, {}};
@@ -245,6 +347,17 @@ inline TransportPtr TransportFactory::Get(
 #if HSHM_ENABLE_NIXL
     case TransportType::kNixl:
       return TransportPtr(new NixlTransport(mode, addr));
+#endif
+#if HSHM_ENABLE_LIBFABRIC
+    case TransportType::kLibfabric:
+      return TransportPtr(new LibfabricTransport(
+          mode, addr, protocol, port == 0 ? 8194 : port));
+#endif
+#if HSHM_ENABLE_IO_URING && !defined(_WIN32)
+    case TransportType::kIoUring:
+      return TransportPtr(new IoUringTransport(
+          mode, addr, protocol.empty() ? "tcp" : protocol,
+          port == 0 ? 8195 : port));
 #endif
     default:
       return nullptr;
@@ -254,7 +367,6 @@ inline TransportPtr TransportFactory::Get(
 inline TransportPtr TransportFactory::Get(
     const std::string& addr, TransportType t, TransportMode mode,
     const std::string& protocol, int port, const std::string& domain) {
-  (void)domain;
   switch (t) {
 #if HSHM_ENABLE_ZMQ
     case TransportType::kZeroMq:
@@ -271,6 +383,17 @@ inline TransportPtr TransportFactory::Get(
 #if HSHM_ENABLE_NIXL
     case TransportType::kNixl:
       return TransportPtr(new NixlTransport(mode, addr));
+#endif
+#if HSHM_ENABLE_LIBFABRIC
+    case TransportType::kLibfabric:
+      return TransportPtr(new LibfabricTransport(
+          mode, addr, protocol, port == 0 ? 8194 : port, domain));
+#endif
+#if HSHM_ENABLE_IO_URING && !defined(_WIN32)
+    case TransportType::kIoUring:
+      return TransportPtr(new IoUringTransport(
+          mode, addr, protocol.empty() ? "tcp" : protocol,
+          port == 0 ? 8195 : port));
 #endif
     default:
       return nullptr;
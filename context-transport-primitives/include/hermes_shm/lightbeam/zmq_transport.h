@@ -276,7 +276,6 @@ class ZeroMqTransport : public Transport {
       ar(meta);
       ar.Finalize();
     }
-    std::string meta_str(meta_buf.begin(), meta_buf.end());
     size_t write_bulk_count = meta.send_bulks;
 
     // ROUTER mode: prepend identity frame + empty delimiter
@@ -315,7 +314,7 @@ class ZeroMqTransport : public Transport {
       flags |= ZMQ_SNDMORE;
     }
 
-    int rc = zmq_send(socket_, meta_str.data(), meta_str.size(), flags);
+    int rc = zmq_send(socket_, meta_buf.data(), meta_buf.size(), flags);
     if (rc == -1) {
       HLOG(kError, "ZeroMqTransport::Send - meta FAILED: {}",
            zmq_strerror(zmq_errno()));
@@ -426,9 +425,9 @@ class ZeroMqTransport : public Transport {
 
     size_t msg_size = zmq_msg_size(&msg);
     try {
-      std::vector<char> meta_buf(static_cast<char*>(zmq_msg_data(&msg)),
-                                  static_cast<char*>(zmq_msg_data(&msg)) + msg_size);
-      hshm::ipc::GlobalDeserialize<std::vector<char>> ar(meta_buf);
+      hshm::ipc::ByteView meta_buf(static_cast<char*>(zmq_msg_data(&msg)),
+                                   msg_size);
+      hshm::ipc::GlobalDeserialize<hshm::ipc::ByteView> ar(meta_buf);
       ar(meta);
     } catch (const std::exception& e) {
       HLOG(kFatal,
@@ -441,9 +440,14 @@ class ZeroMqTransport : public Transport {
     return 0;
   }
 
+  /**
+   * Receive the bulk frames. A frame goes straight into its destination
+   * buffer with zmq_recv when there is one: the exposed buffer if the caller
+   * set it, else a buffer from ctx.recv_alloc_. Otherwise the zmq message is
+   * kept and referenced in place (released by ClearRecvHandles).
+   */
   template <typename MetaT>
   int RecvBulks(MetaT& meta, const LbmContext& ctx = LbmContext()) {
-    (void)ctx;
     size_t recv_count = 0;
     for (size_t i = 0; i < meta.recv.size(); ++i) {
       if (!meta.recv[i].flags.Any(BULK_XFER)) {
@@ -452,18 +456,32 @@ class ZeroMqTransport : public Transport {
       recv_count++;
       int flags = (recv_count < meta.send_bulks) ? ZMQ_RCVMORE : 0;
 
+      bool from_alloc = false;
+      if (!meta.recv[i].data.ptr_ && ctx.recv_alloc_) {
+        meta.recv[i].data = ctx.recv_alloc_->Allocate(meta.recv[i].size);
+        from_alloc = meta.recv[i].data.ptr_ != nullptr;
+        if (from_alloc) {
+          meta.recv[i].flags.SetBits(BULK_RECV_ALLOC);
+        }
+      }
+
       if (meta.recv[i].data.ptr_) {
-        zmq_msg_t zmq_msg;
-        zmq_msg_init(&zmq_msg);
-        int rc = zmq_msg_recv(&zmq_msg, socket_, flags);
-        if (rc == -1) {
-          int err = zmq_errno();
-          zmq_msg_close(&zmq_msg);
+        int rc = zmq_recv(socket_, meta.recv[i].data.ptr_, meta.recv[i].size,
+                          flags);
+        int err = (rc == -1) ? zmq_errno() : 0;
+        if (rc != -1 && static_cast<size_t>(rc) != meta.recv[i].size) {
+          HLOG(kError, "ZeroMQ RecvBulks: frame of {} bytes, expected {}", rc,
+               meta.recv[i].size);
+          err = -1;
+        }
+        if (err != 0) {
+          if (from_alloc) {
+            ctx.recv_alloc_->Free(meta.recv[i].data);
+            meta.recv[i].data = hipc::FullPtr<char>::GetNull();
+            meta.recv[i].flags.UnsetBits(BULK_RECV_ALLOC);
+          }
           return err;
         }
-        memcpy(meta.recv[i].data.ptr_,
-               zmq_msg_data(&zmq_msg), meta.recv[i].size);
-        zmq_msg_close(&zmq_msg);
       } else {
         zmq_msg_t *zmq_msg = new zmq_msg_t;
         zmq_msg_init(zmq_msg);
@@ -40,6 +40,9 @@
 #include "hermes_shm/data_structures/ipc/rb_tree_pre.h"
 #include <cmath>
 #include <vector>
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#endif
 
 namespace hshm::ipc {
 
@@ -107,6 +110,70 @@ struct CoalesceBuddyPage : public pre::rb_node {
   }
 };
 
+/**
+ * Best-fit key of a free large extent: ordered by size, then by offset so
+ * equally sized extents remain distinct tree keys.
+ */
+struct LargeExtentSizeKey {
+  size_t size_;  /**< Total extent size in bytes (header included) */
+  size_t off_;   /**< Offset of the extent header */
+
+  HSHM_INLINE_CROSS_FUN bool operator<(const LargeExtentSizeKey &other) const {
+    return size_ < other.size_ || (size_ == other.size_ && off_ < other.off_);
+  }
+  HSHM_INLINE_CROSS_FUN bool operator>(const LargeExtentSizeKey &other) const {
+    return other < *this;
+  }
+  HSHM_INLINE_CROSS_FUN bool operator==(const LargeExtentSizeKey &other) const {
+    return size_ == other.size_ && off_ == other.off_;
+  }
+};
+
+/** Node of the best-fit (size-ordered) free extent tree */
+struct LargeExtentSizeNode : public pre::rb_node {
+  LargeExtentSizeKey key;  /**< Size-major key */
+
+  HSHM_INLINE_CROSS_FUN bool operator<(const LargeExtentSizeNode &other) const {
+    return key < other.key;
+  }
+  HSHM_INLINE_CROSS_FUN bool operator>(const LargeExtentSizeNode &other) const {
+    return key > other.key;
+  }
+  HSHM_INLINE_CROSS_FUN bool operator==(const LargeExtentSizeNode &other) const {
+    return key == other.key;
+  }
+};
+
+/** Node of the address-ordered free extent tree (used for coalescing) */
+struct LargeExtentAddrNode : public pre::rb_node {
+  size_t key;  /**< Offset of the extent header */
+
+  HSHM_INLINE_CROSS_FUN bool operator<(const LargeExtentAddrNode &other) const {
+    return key < other.key;
+  }
+  HSHM_INLINE_CROSS_FUN bool operator>(const LargeExtentAddrNode &other) const {
+    return key > other.key;
+  }
+  HSHM_INLINE_CROSS_FUN bool operator==(const LargeExtentAddrNode &other) const {
+    return key == other.key;
+  }
+};
+
+/**
+ * Header of a free large extent.
+ *
+ * page_ keeps the extent walkable as an ordinary BuddyPage (Compact scans
+ * the heap page by page); the two tree nodes follow it. A free extent also
+ * stores its own offset in its last 8 bytes so the extent after it can find
+ * and merge with it on free.
+ */
+template <MemMode MODE = MemMode::kShared>
+struct LargeExtent {
+  BuddyPage<MODE> page_;         /**< Header shared with allocated extents */
+  LargeExtentSizeNode by_size_;  /**< Best-fit tree linkage */
+  LargeExtentAddrNode by_addr_;  /**< Address tree linkage */
+};
+
 /**
  * Maps old user-data offsets to new offsets after compaction.
  *
@@ -162,6 +229,12 @@ class ForwardingTable {
  * size classes. Small allocations (<16KB) use round-up sizing, while large
  * allocations (>16KB) use round-down sizing with best-fit search.
  *
+ * Allocations above the largest size class (1MB) bypass the free lists and
+ * use a page-granular extent segment carved from the same heap. Free
+ * extents are indexed by a best-fit tree and an address tree, coalesce with
+ * free neighbors, and have their interior pages returned to the OS with
+ * madvise(MADV_DONTNEED) so process RSS drops after bursts of large buffers.
+ *
  * @tparam MODE MemMode::kShared uses offset-based slist (shared memory safe),
  *              MemMode::kPrivate uses raw-pointer priv_slist with cached base
  *              pointer (faster, not shared-memory safe).
@@ -191,6 +264,12 @@ class _BuddyAllocator : public Allocator {
   static constexpr size_t kSmallArenaSize = 65536; /**< 64KB arena size */
   static constexpr size_t kSmallArenaPages = 128;  /**< Max pages in small arena */
 
+  static constexpr size_t kExtentPageSize = 4096;  /**< Large extent granularity */
+
+  using LargeExtentT = LargeExtent<MODE>;
+  using ExtentSizeTreeT = pre::rb_tree<LargeExtentSizeNode, false>;
+  using ExtentAddrTreeT = pre::rb_tree<LargeExtentAddrNode, false>;
+
   Heap<false> big_heap_;   /**< Heap for large allocations */
   Heap<false> small_arena_; /**< Arena for small allocations */
 
@@ -198,6 +277,11 @@ class _BuddyAllocator : public Allocator {
   PageListT large_pages_[kMaxLargePages]; /**< Free lists for sizes 16KB - 1MB */
   PageListT regions_;   /**< List of big_heap_ regions */
 
+  ExtentSizeTreeT extents_by_size_;  /**< Free extents (>1MB) by size */
+  ExtentAddrTreeT extents_by_addr_;  /**< Free extents (>1MB) by offset */
+  size_t extent_free_bytes_;         /**< Bytes held by free extents */
+  bool release_extents_;  /**< madvise() freed extents back to the OS */
+
   ArenaState cur_arena_;  /**< Current bump arena (if active) */
 
 #ifdef HSHM_BUDDY_ALLOC_DEBUG
@@ -268,6 +352,10 @@ class _BuddyAllocator : public Allocator {
     for (size_t i = 0; i < kMaxLargePages; ++i) {
       large_pages_[i].Init();
     }
+    extents_by_size_.Init();
+    extents_by_addr_.Init();
+    extent_free_bytes_ = 0;
+    release_extents_ = true;
 
     Expand(OffsetPtr<>(GetAllocatorDataOff()), GetAllocatorDataSize());
 #ifdef HSHM_BUDDY_ALLOC_DEBUG
@@ -329,6 +417,9 @@ class _BuddyAllocator : public Allocator {
     if (requested_size <= kSmallThreshold) {
       return AllocateSmall(requested_size);
     }
+    if (requested_size > kMaxSize) {
+      return AllocateExtent(requested_size);
+    }
     return AllocateLarge(requested_size);
   }
 
@@ -390,6 +481,11 @@ class _BuddyAllocator : public Allocator {
     dbg_net_bytes_ -= data_size;
 #endif
 
+    if (data_size > kMaxSize) {
+      FreeExtent(page_offset, data_size + sizeof(PageT));
+      return;
+    }
+
     size_t list_idx;
     if (data_size <= kSmallThreshold) {
       list_idx = GetSmallPageListIndexForFree(data_size);
@@ -400,6 +496,25 @@ class _BuddyAllocator : public Allocator {
     }
   }
 
+  /** Number of free large extents (after coalescing) */
+  HSHM_CROSS_FUN size_t GetFreeExtentCount() const {
+    return extents_by_addr_.size();
+  }
+
+  /** Total bytes held by free large extents */
+  HSHM_CROSS_FUN size_t GetFreeExtentBytes() const {
+    return extent_free_bytes_;
+  }
+
+  /**
+   * Enable or disable madvise(MADV_DONTNEED) of freed large extents.
+   * Disable for backends whose pages must stay resident (e.g. memory
+   * registered with a device as private anonymous pinned pages).
+   */
+  HSHM_CROSS_FUN void SetReleaseFreeExtents(bool enable) {
+    release_extents_ = enable;
+  }
+
   /** Push a new bump arena */
   HSHM_CROSS_FUN bool PushArenaState(ArenaState &prior, OffsetPtr<> &block, size_t size) {
     prior = cur_arena_;
@@ -483,6 +598,9 @@ class _BuddyAllocator : public Allocator {
 
     for (size_t i = 0; i < kMaxSmallPages; ++i) small_pages_[i].Init();
     for (size_t i = 0; i < kMaxLargePages; ++i) large_pages_[i].Init();
+    extents_by_size_.Init();
+    extents_by_addr_.Init();
+    extent_free_bytes_ = 0;
     small_arena_.Init(0, 0);
     big_heap_.Init(write_pos, big_heap_.GetMaxOffset());
     return table;
@@ -602,6 +720,155 @@ class _BuddyAllocator : public Allocator {
     return OffsetPtr<>::GetNull();
   }
 
+  /**
+   * Allocate a page-granular extent (>1MB) using best-fit, carving a fresh
+   * page-aligned extent from big_heap_ when no free extent is large enough
+   */
+  HSHM_CROSS_FUN OffsetPtr<> AllocateExtent(size_t size) {
+    size_t bytes = (size + sizeof(PageT) + kExtentPageSize - 1) &
+                   ~(kExtentPageSize - 1);
+    size_t off = TakeBestFitExtent(bytes);
+    if (off == 0) {
+      off = CarveExtent(bytes);
+    }
+    if (off == 0) {
+      return OffsetPtr<>::GetNull();
+    }
+    return FinalizeAllocation(off, bytes - sizeof(PageT));
+  }
+
+  /**
+   * Remove the smallest free extent of at least bytes from the trees,
+   * splitting off the page-granular tail. bytes is updated to the size
+   * actually handed out. Returns 0 if no free extent fits.
+   */
+  HSHM_CROSS_FUN size_t TakeBestFitExtent(size_t &bytes) {
+    if (extents_by_size_.empty()) {
+      return 0;
+    }
+    FullPtr<LargeExtentSizeNode> node =
+        extents_by_size_.lower_bound(this, LargeExtentSizeKey{bytes, 0});
+    if (node.IsNull()) {
+      return 0;
+    }
+    size_t off = node.ptr_->key.off_;
+    size_t ext_bytes = node.ptr_->key.size_;
+    UnlinkExtent(off, ext_bytes);
+    if (ext_bytes - bytes >= kExtentPageSize) {
+      LinkExtent(off + bytes, ext_bytes - bytes);
+    } else {
+      bytes = ext_bytes;
+    }
+    return off;
+  }
+
+  /**
+   * Carve a new extent from big_heap_, aligned so the extent header starts
+   * on a page boundary. Alignment padding is returned to the buddy lists.
+   */
+  HSHM_CROSS_FUN size_t CarveExtent(size_t bytes) {
+    size_t cur = big_heap_.GetOffset();
+    size_t addr = reinterpret_cast<size_t>(GetBackendData() + cur);
+    size_t pad = (kExtentPageSize - (addr & (kExtentPageSize - 1))) &
+                 (kExtentPageSize - 1);
+    if (pad != 0 && pad < sizeof(PageT) + kMinSize) {
+      pad += kExtentPageSize;
+    }
+    if (big_heap_.GetRemainingSize() < pad + bytes) {
+      return 0;
+    }
+    if (pad != 0) {
+      size_t pad_off = big_heap_.Allocate(pad);
+      if (pad_off == 0) {
+        return 0;
+      }
+      AddRemainderToFreeList(pad_off, pad);
+    }
+    return big_heap_.Allocate(bytes);
+  }
+
+  /**
+   * Return an extent to the segment: release its interior pages, merge it
+   * with free neighbors on either side, and index the result
+   */
+  HSHM_CROSS_FUN void FreeExtent(size_t off, size_t bytes) {
+    ReleaseExtentPages(off, bytes);
+
+    size_t next = off + bytes;
+    if (!extents_by_addr_.find(this, next).IsNull()) {
+      size_t next_bytes = OffsetToPage(next)->GetSize() + sizeof(PageT);
+      UnlinkExtent(next, next_bytes);
+      bytes += next_bytes;
+    }
+
+    if (off >= GetAllocatorDataOff() + sizeof(size_t)) {
+      // Candidate footer of the preceding extent; verified via the tree
+      size_t prev = *reinterpret_cast<size_t *>(GetBackendData() + off -
+                                                sizeof(size_t));
+      if (prev < off && !extents_by_addr_.find(this, prev).IsNull()) {
+        size_t prev_bytes = OffsetToPage(prev)->GetSize() + sizeof(PageT);
+        if (prev + prev_bytes == off) {
+          UnlinkExtent(prev, prev_bytes);
+          off = prev;
+          bytes += prev_bytes;
+        }
+      }
+    }
+    LinkExtent(off, bytes);
+  }
+
+  /** Write a free extent header and footer and insert it into both trees */
+  HSHM_CROSS_FUN void LinkExtent(size_t off, size_t bytes) {
+    char *base = GetBackendData();
+    LargeExtentT *ext = reinterpret_cast<LargeExtentT *>(base + off);
+    ext->page_.size_ = bytes - sizeof(PageT);
+    ext->page_.MarkFree();
+    new (&ext->by_size_) LargeExtentSizeNode();
+    ext->by_size_.key = LargeExtentSizeKey{bytes, off};
+    new (&ext->by_addr_) LargeExtentAddrNode();
+    ext->by_addr_.key = off;
+    *reinterpret_cast<size_t *>(base + off + bytes - sizeof(size_t)) = off;
+
+    size_t size_node_off = reinterpret_cast<char *>(&ext->by_size_) - base;
+    size_t addr_node_off = reinterpret_cast<char *>(&ext->by_addr_) - base;
+    extents_by_size_.emplace(
+        this, FullPtr<LargeExtentSizeNode>(this, size_node_off));
+    extents_by_addr_.emplace(
+        this, FullPtr<LargeExtentAddrNode>(this, addr_node_off));
+    extent_free_bytes_ += bytes;
+  }
+
+  /** Remove a free extent from both trees */
+  HSHM_CROSS_FUN void UnlinkExtent(size_t off, size_t bytes) {
+    extents_by_size_.pop(this, LargeExtentSizeKey{bytes, off});
+    extents_by_addr_.pop(this, off);
+    extent_free_bytes_ -= bytes;
+  }
+
+  /**
+   * Drop the resident pages of a freed extent, keeping the header and
+   * footer pages intact. On shared mappings this only unmaps the pages
+   * from this process; the shared object keeps its contents.
+   */
+  HSHM_CROSS_FUN void ReleaseExtentPages(size_t off, size_t bytes) {
+#if HSHM_IS_HOST && !defined(_WIN32)
+    if (!release_extents_) {
+      return;
+    }
+    char *base = GetBackendData();
+    size_t begin = reinterpret_cast<size_t>(base + off + sizeof(LargeExtentT));
+    size_t end = reinterpret_cast<size_t>(base + off + bytes - sizeof(size_t));
+    begin = (begin + kExtentPageSize - 1) & ~(kExtentPageSize - 1);
+    end &= ~(kExtentPageSize - 1);
+    if (end > begin) {
+      madvise(reinterpret_cast<void *>(begin), end - begin, MADV_DONTNEED);
+    }
+#else
+    (void)off;
+    (void)bytes;
+#endif
+  }
+
   /**
    * Find the first fit in a large page free list
    */
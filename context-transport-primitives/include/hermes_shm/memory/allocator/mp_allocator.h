@@ -65,17 +65,26 @@ typedef ProducerConsumerAllocator MultiProcessAllocator;
  *
  * Each thread has its own PcThreadBlock with a private BuddyAllocator,
  * enabling concurrent allocations without contention. When a PcThreadBlock
- * runs out of memory, it requests expansion from the global allocator.
+ * runs out of memory, it requests expansion from the global allocator in
+ * batches that grow with demand.
+ *
+ * Blocks freed by a thread other than the owner are pushed onto the owner's
+ * lock-free remote-free stack (linked through the BuddyPage header) and
+ * returned to the private allocator when the owner next allocates.
  */
 class PcThreadBlock : public pre::slist_node {
  public:
+  static constexpr size_t kNullOff = (size_t)-1;
+
   int tid_;                    /**< Thread ID */
+  hipc::atomic<size_t> remote_head_;  /**< First remotely freed page */
+  size_t refill_size_;         /**< Next expansion request to the global tier */
   BuddyAllocator alloc_;       /**< Private buddy allocator (MUST BE LAST) */
 
   /**
    * Default constructor
    */
-  PcThreadBlock() : tid_(-1) {}
+  PcThreadBlock() : tid_(-1), refill_size_(0) {}
 
   /**
    * Initialize the thread block.
@@ -87,6 +96,8 @@ class PcThreadBlock : public pre::slist_node {
    */
   bool shm_init(const MemoryBackend &backend, size_t region_size, int tid) {
     tid_ = tid;
+    remote_head_.store(kNullOff);
+    refill_size_ = region_size;
     size_t alloc_region_size = region_size - sizeof(PcThreadBlock);
     alloc_.shm_init(backend, alloc_region_size);
     return true;
@@ -101,6 +112,35 @@ class PcThreadBlock : public pre::slist_node {
   void Expand(OffsetPtr<> region, size_t region_size) {
     alloc_.Expand(region, region_size);
   }
+
+  /**
+   * Push a page freed by another thread onto the remote-free stack.
+   *
+   * Multi-producer safe. Only the owner pops, and it takes the whole stack
+   * at once, so the push needs no ABA protection.
+   *
+   * @param page Page header of the freed block
+   * @param page_off Offset of the page header from the backend data
+   */
+  void PushRemoteFree(BuddyPage<> *page, size_t page_off) {
+    size_t head = remote_head_.load();
+    do {
+      page->next_ = OffsetPtr<>(head);
+    } while (!remote_head_.compare_exchange_weak(head, page_off));
+  }
+
+  /**
+   * Detach the whole remote-free stack (owner thread only).
+   *
+   * @return Offset of the first page, or kNullOff if the stack is empty
+   */
+  size_t TakeRemoteFrees() {
+    size_t head = remote_head_.load();
+    while (head != kNullOff &&
+           !remote_head_.compare_exchange_weak(head, kNullOff)) {
+    }
+    return head;
+  }
 };
 
 /**
@@ -118,6 +158,12 @@ class PcThreadBlock : public pre::slist_node {
  * 1. Fast path: Allocate from thread-local PcThreadBlock (no locks)
  * 2. Slow path: Expand PcThreadBlock from global allocator (global lock)
  *
+ * Every block records its owning PcThreadBlock in the (otherwise unused)
+ * list link of its BuddyPage header. Frees from the owner go straight back
+ * to the private allocator; frees from any other thread or process (e.g. a
+ * runtime worker freeing a client allocation) go to the owner's remote-free
+ * stack, so memory does not migrate away from the allocating thread.
+ *
  * Memory Layout:
  * The allocator itself is placed at the beginning of shared memory.
  * The BuddyAllocator follows immediately after the allocator header.
@@ -250,13 +296,14 @@ class _ProducerConsumerAllocator : public Allocator {
       return OffsetPtr<>::GetNull();
     }
 
+    DrainRemoteFrees(tblock);
     OffsetPtr<> ptr = tblock->alloc_.AllocateOffset(size);
-    if (!ptr.IsNull()) {
-      return ptr;
+    if (ptr.IsNull()) {
+      // Tier 2: Expand PcThreadBlock from global and retry
+      ptr = ExpandAndAllocate(tblock, size);
     }
-
-    // Tier 2: Expand PcThreadBlock from global and retry
-    return ExpandAndAllocate(tblock, size);
+    StampOwner(ptr, tblock);
+    return ptr;
   }
 
   /**
@@ -277,16 +324,32 @@ class _ProducerConsumerAllocator : public Allocator {
   /**
    * Free memory allocated from the allocator.
    *
-   * Frees to the current thread's PcThreadBlock allocator.
+   * Returns the block to its owning PcThreadBlock: directly if the caller
+   * owns it, otherwise through the owner's remote-free stack.
    *
    * @param p The offset pointer to free
    */
   void FreeOffsetNoNullCheck(OffsetPtr<> p) {
-    PcThreadBlock *tblock = EnsureTls();
-    if (tblock == nullptr) {
+    size_t page_off = p.load() - sizeof(BuddyPage<>);
+    auto *page = reinterpret_cast<BuddyPage<>*>(GetBackendData() + page_off);
+    PcThreadBlock *owner = GetOwner(page);
+    if (owner == nullptr) {
+      // Not stamped: free into the caller's block
+      PcThreadBlock *tblock = EnsureTls();
+      if (tblock != nullptr) {
+        tblock->alloc_.FreeOffset(p);
+      } else {
+        ScopedMutex scoped_lock(lock_, 0);
+        alloc_.FreeOffset(p);
+      }
       return;
     }
-    tblock->alloc_.FreeOffset(p);
+    void *tblock_data = HSHM_THREAD_MODEL->GetTls<void>(tblock_key_);
+    if (tblock_data == owner) {
+      owner->alloc_.FreeOffset(p);
+      return;
+    }
+    owner->PushRemoteFree(page, page_off);
   }
 
   /**
@@ -306,6 +369,7 @@ class _ProducerConsumerAllocator : public Allocator {
     if (tblock != nullptr) {
       OffsetPtr<> new_offset = tblock->alloc_.ReallocateOffset(offset, new_size);
       if (!new_offset.IsNull()) {
+        StampOwner(new_offset, tblock);
         return new_offset;
       }
     }
@@ -340,16 +404,7 @@ class _ProducerConsumerAllocator : public Allocator {
     if (offset.IsNull()) {
       return;
     }
-
-    PcThreadBlock *tblock = EnsureTls();
-    if (tblock != nullptr) {
-      tblock->alloc_.FreeOffset(offset);
-      return;
-    }
-
-    // Fall back to global allocator
-    ScopedMutex scoped_lock(lock_, 0);
-    alloc_.FreeOffset(offset);
+    FreeOffsetNoNullCheck(offset);
   }
 
   /** No-op TLS management (handled by EnsureTls). */
@@ -367,9 +422,17 @@ class _ProducerConsumerAllocator : public Allocator {
   }
 
  private:
+  /** Largest batch a PcThreadBlock requests from the global tier at once */
+  static constexpr size_t kMaxRefillSize = 32 * 1024 * 1024;
+
   /**
    * Expand PcThreadBlock from global allocator and retry allocation.
    *
+   * Refills are batched: each expansion doubles the next request (up to
+   * kMaxRefillSize) so a busy thread takes the global lock less often.
+   * If the global tier cannot satisfy a batch, only the required size is
+   * requested and the batch size resets.
+   *
    * @param tblock The thread's PcThreadBlock to expand
    * @param size Size in bytes to allocate
    * @return Offset pointer to allocated memory, or null on failure
@@ -377,21 +440,73 @@ class _ProducerConsumerAllocator : public Allocator {
   OffsetPtr<> ExpandAndAllocate(PcThreadBlock *tblock, size_t size) {
     // Calculate expansion size with 25% overhead for metadata
     size_t required_size = size + (size / 4) + sizeof(BuddyPage<>);
-    size_t expand_size = (required_size > thread_unit_)
-                           ? required_size : thread_unit_;
+    size_t expand_size = (required_size > tblock->refill_size_)
+                           ? required_size : tblock->refill_size_;
 
     OffsetPtr<> expand_ptr;
     {
       ScopedMutex scoped_lock(lock_, 0);
       expand_ptr = alloc_.AllocateOffset(expand_size);
+      if (expand_ptr.IsNull() && expand_size > required_size) {
+        expand_size = required_size;
+        expand_ptr = alloc_.AllocateOffset(expand_size);
+      }
     }
     if (expand_ptr.IsNull()) {
+      tblock->refill_size_ = thread_unit_;
       return OffsetPtr<>::GetNull();
     }
+    if (expand_size == tblock->refill_size_ &&
+        tblock->refill_size_ < kMaxRefillSize) {
+      tblock->refill_size_ *= 2;
+    }
 
     tblock->Expand(expand_ptr, expand_size);
     return tblock->alloc_.AllocateOffset(size);
   }
+
+  /**
+   * Return remotely freed blocks to the owner's private allocator.
+   *
+   * @param tblock The calling thread's PcThreadBlock
+   */
+  void DrainRemoteFrees(PcThreadBlock *tblock) {
+    if (tblock->remote_head_.load() == PcThreadBlock::kNullOff) {
+      return;
+    }
+    size_t page_off = tblock->TakeRemoteFrees();
+    char *data = GetBackendData();
+    while (page_off != PcThreadBlock::kNullOff) {
+      auto *page = reinterpret_cast<BuddyPage<>*>(data + page_off);
+      size_t next = page->next_.load();
+      tblock->alloc_.FreeOffset(OffsetPtr<>(page_off + sizeof(BuddyPage<>)));
+      page_off = next;
+    }
+  }
+
+  /**
+   * Record the owning PcThreadBlock in an allocated block's page header.
+   *
+   * The BuddyPage list link is unused while a block is allocated.
+   */
+  void StampOwner(OffsetPtr<> ptr, PcThreadBlock *tblock) {
+    if (ptr.IsNull()) {
+      return;
+    }
+    char *data = GetBackendData();
+    auto *page = reinterpret_cast<BuddyPage<>*>(
+        data + ptr.load() - sizeof(BuddyPage<>));
+    page->next_ = OffsetPtr<>(reinterpret_cast<char*>(tblock) - data);
+  }
+
+  /** Owning PcThreadBlock recorded by StampOwner (nullptr if unstamped) */
+  PcThreadBlock *GetOwner(BuddyPage<> *page) {
+    size_t owner_off = page->next_.load();
+    if (owner_off == PcThreadBlock::kNullOff) {
+      return nullptr;
+    }
+    return reinterpret_cast<PcThreadBlock*>(GetBackendData() + owner_off);
+  }
 };
 
 }  // namespace hshm::ipc
@@ -92,10 +92,14 @@ class GpuShmMmap : public MemoryBackend, public UrlMemoryBackend {
    * @param backend_size Total size in bytes (headers + data)
    * @param url Identifier string (informational only)
    * @param gpu_id GPU device ID (informational only)
+   * @param huge Back the region with huge pages registered through
+   *        cudaHostRegister. Fewer, larger pages cut pinning and DMA
+   *        mapping cost. Falls back to cudaMallocHost on failure.
    * @return true on success, false on failure
    */
   bool shm_init(const MemoryBackendId &backend_id, size_t backend_size,
-                const std::string &url, int gpu_id = 0) {
+                const std::string &url, int gpu_id = 0,
+                HugePageMode huge = HugePageMode::kNone) {
     // Enforce minimum backend size of 1MB
     constexpr size_t kMinBackendSize = 1024 * 1024;
     if (backend_size < kMinBackendSize) {
@@ -119,11 +123,20 @@ class GpuShmMmap : public MemoryBackend, public UrlMemoryBackend {
     //     system-scope atomics (atomicExch_system, atomicAdd_system) immediately
     //     visible to CPU reads after cudaDeviceSynchronize() or via polling.
     void *pinned_ptr = nullptr;
-    cudaError_t cuda_err = cudaMallocHost(&pinned_ptr, backend_size);
-    if (cuda_err != cudaSuccess) {
-      HLOG(kError, "cudaMallocHost failed: {}",
-           cudaGetErrorString(cuda_err));
-      return false;
+    bool registered = false;
+    if (huge != HugePageMode::kNone) {
+      size_t align = GetHugePageSize(huge);
+      backend_size = (backend_size + align - 1) & ~(align - 1);
+      pinned_ptr = _MapRegisteredHuge(backend_size, huge);
+      registered = pinned_ptr != nullptr;
+    }
+    if (!registered) {
+      cudaError_t cuda_err = cudaMallocHost(&pinned_ptr, backend_size);
+      if (cuda_err != cudaSuccess) {
+        HLOG(kError, "cudaMallocHost failed: {}",
+             cudaGetErrorString(cuda_err));
+        return false;
+      }
     }
 
     // Zero-initialize so offset-based allocators start from a clean state.
@@ -140,6 +153,9 @@ class GpuShmMmap : public MemoryBackend, public UrlMemoryBackend {
     data_capacity_ = backend_size - kBackendHeaderSize;
     data_id_ = gpu_id;
     flags_.Clear();
+    if (registered) {
+      flags_.SetBits(MEMORY_BACKEND_HUGE_PAGES);
+    }
 
     // Copy header fields into the managed memory header region
     new (header_) MemoryBackendHeader();
@@ -172,14 +188,55 @@ class GpuShmMmap : public MemoryBackend, public UrlMemoryBackend {
     GpuApi::UnregisterHostMemory(ptr);
   }
 
+  /**
+   * Map huge-page host memory and pin it for the GPU
+   *
+   * Tries explicit hugetlb pages first (k2MB/k1GB), then transparent huge
+   * pages. Returns nullptr if the region cannot be mapped or registered.
+   */
+  void *_MapRegisteredHuge(size_t size, HugePageMode huge) {
+    void *ptr = nullptr;
+    if (huge == HugePageMode::k2MB || huge == HugePageMode::k1GB) {
+      ptr = SystemInfo::MapHugePrivateMemory(size, GetHugePageSize(huge));
+      if (!ptr) {
+        HLOG(kWarning,
+             "GpuShmMmap: hugetlb pages unavailable for {} ({} bytes), "
+             "falling back to transparent huge pages",
+             url_, size);
+      }
+    }
+    if (!ptr) {
+      ptr = SystemInfo::MapPrivateMemory(size);
+      if (ptr == nullptr || ptr == reinterpret_cast<void *>(-1)) {  // MAP_FAILED
+        return nullptr;
+      }
+      SystemInfo::AdviseHugePages(ptr, size);
+    }
+    cudaError_t cuda_err = cudaHostRegister(
+        ptr, size, cudaHostRegisterPortable | cudaHostRegisterMapped);
+    if (cuda_err != cudaSuccess) {
+      HLOG(kWarning, "GpuShmMmap: cudaHostRegister failed ({}), using "
+           "cudaMallocHost", cudaGetErrorString(cuda_err));
+      SystemInfo::UnmapMemory(ptr, size);
+      return nullptr;
+    }
+    return ptr;
+  }
+
   /** Detach from (and free) pinned host memory */
   void _Detach() {
     if (!flags_.Any(MEMORY_BACKEND_INITIALIZED)) {
       return;
     }
 
-    // Free pinned host memory allocated by shm_init via cudaMallocHost
-    if (region_) {
+    // Free pinned host memory allocated by shm_init
+    if (region_ && flags_.Any(MEMORY_BACKEND_HUGE_PAGES)) {
+      _UnregisterFromGpu(region_);
+      SystemInfo::UnmapMemory(region_, backend_size_);
+      region_ = nullptr;
+      header_ = nullptr;
+      data_ = nullptr;
+    } else if (region_) {
       cudaFreeHost(region_);
       region_ = nullptr;
       header_ = nullptr;
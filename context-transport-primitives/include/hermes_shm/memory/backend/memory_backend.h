@@ -154,6 +154,29 @@ struct MemoryBackendHeader {
 
 #define MEMORY_BACKEND_INITIALIZED BIT_OPT(u64, 0)
 #define MEMORY_BACKEND_OWNED BIT_OPT(u64, 1)
+/** Header and data share one mapping (required for hugetlb-backed files) */
+#define MEMORY_BACKEND_HUGE_PAGES BIT_OPT(u64, 2)
+
+/** Page size requested for a backend's memory */
+enum class HugePageMode {
+  kNone,         /**< Base pages */
+  kTransparent,  /**< Base mapping advised with MADV_HUGEPAGE */
+  k2MB,          /**< Explicit 2MB hugetlb pages, falls back to kTransparent */
+  k1GB,          /**< Explicit 1GB hugetlb pages, falls back to kTransparent */
+};
+
+/** Alignment a backend is rounded to for a huge page mode (0 for kNone) */
+static inline size_t GetHugePageSize(HugePageMode mode) {
+  switch (mode) {
+    case HugePageMode::k1GB:
+      return size_t{1} << 30;
+    case HugePageMode::k2MB:
+    case HugePageMode::kTransparent:
+      return size_t{1} << 21;
+    default:
+      return 0;
+  }
+}
 
 class UrlMemoryBackend {};
 
@@ -205,6 +228,15 @@ class MemoryBackend : public MemoryBackendHeader {
     return flags_.Any(MEMORY_BACKEND_OWNED) != 0;
   }
 
+  /**
+   * Check if this backend is mapped with huge pages
+   * @return true if MEMORY_BACKEND_HUGE_PAGES flag is set
+   */
+  HSHM_CROSS_FUN
+  bool IsHugePaged() const {
+    return flags_.Any(MEMORY_BACKEND_HUGE_PAGES) != 0;
+  }
+
   /**
    * Unset the MEMORY_BACKEND_OWNED flag
    * Called during shm_attach to indicate this process is attaching to
@@ -38,6 +38,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
 #include <string>
 
 #include "hermes_shm/constants/macros.h"
@@ -71,6 +72,8 @@ class PosixShmMmap : public MemoryBackend, public UrlMemoryBackend {
    * @param backend_id Unique identifier for this backend
    * @param backend_size Total size of the region (header + data)
    * @param url POSIX shared memory object name (e.g., "/my_shm")
+   * @param huge Page size backing the segment. Explicit hugetlb modes fall
+   *        back to transparent huge pages when the pool is exhausted.
    * @return true on success, false on failure
    *
    * File layout:
@@ -78,13 +81,29 @@ class PosixShmMmap : public MemoryBackend, public UrlMemoryBackend {
    *
    * header_ is mapped separately (MAP_SHARED) at file offset 0.
    * region_/data_ are mapped at file offset kBackendHeaderSize.
+   * Huge page modes map the whole file once instead, since hugetlb
+   * mappings must start on a huge page boundary.
    */
   bool shm_init(const MemoryBackendId &backend_id, size_t backend_size,
-                const std::string &url) {
+                const std::string &url,
+                HugePageMode huge = HugePageMode::kNone) {
     constexpr size_t kMinBackendSize = 1024 * 1024;
     if (backend_size < kMinBackendSize) {
       backend_size = kMinBackendSize;
     }
+    if (huge == HugePageMode::k2MB || huge == HugePageMode::k1GB) {
+      if (_InitHuge(backend_id, backend_size, url, GetHugePageSize(huge))) {
+        return true;
+      }
+      HLOG(kWarning,
+           "PosixShmMmap: hugetlb pages unavailable for {} ({} bytes), "
+           "falling back to transparent huge pages",
+           url, backend_size);
+      huge = HugePageMode::kTransparent;
+    }
+    if (huge == HugePageMode::kTransparent) {
+      return _InitHuge(backend_id, backend_size, url, 0);
+    }
 
     const size_t hdr_size = kBackendHeaderSize;
 
@@ -146,15 +165,39 @@ class PosixShmMmap : public MemoryBackend, public UrlMemoryBackend {
 
     const size_t hdr_size = kBackendHeaderSize;
 
-    // Map the backend header at file offset 0
+    // Map the backend header at file offset 0. hugetlb files cannot be
+    // mapped in pieces smaller than their page size.
+    size_t probe_size =
+        std::max(hdr_size, SystemInfo::GetSharedMemoryPageSize(fd_));
     header_ = reinterpret_cast<MemoryBackendHeader *>(
-        SystemInfo::MapSharedMemory(fd_, hdr_size, 0));
+        SystemInfo::MapSharedMemory(fd_, probe_size, 0));
     if (!header_) {
       HLOG(kError, "Failed to map backend header");
       SystemInfo::CloseSharedMemory(fd_);
       return false;
     }
     (MemoryBackendHeader &)*this = (*header_);
+    if (flags_.Any(MEMORY_BACKEND_HUGE_PAGES)) {
+      SystemInfo::UnmapMemory(header_, probe_size);
+      header_ = nullptr;
+      if (!_MapWhole()) {
+        HLOG(kError, "Failed to map huge page backend during attach");
+        SystemInfo::CloseSharedMemory(fd_);
+        return false;
+      }
+      UnsetOwner();
+      return true;
+    }
+    if (probe_size != hdr_size) {
+      SystemInfo::UnmapMemory(header_, probe_size);
+      header_ = reinterpret_cast<MemoryBackendHeader *>(
+          SystemInfo::MapSharedMemory(fd_, hdr_size, 0));
+      if (!header_) {
+        HLOG(kError, "Failed to map backend header");
+        SystemInfo::CloseSharedMemory(fd_);
+        return false;
+      }
+    }
 
     size_t backend_size = header_->backend_size_;
     if (backend_size < hdr_size) {
@@ -182,6 +225,55 @@ class PosixShmMmap : public MemoryBackend, public UrlMemoryBackend {
     return true;
   }
 
+  /**
+   * Place the pages of a data sub-range on one NUMA node
+   *
+   * The policy is stored on the shared memory object, so it holds for every
+   * process that maps the segment. Pages already touched are migrated.
+   *
+   * @param node NUMA node id
+   * @param off Byte offset into data_
+   * @param size Bytes to bind (0 = through the end of the data region)
+   * @param strict Fail allocations when the node is full instead of
+   *        falling back to other nodes
+   * @return true on success
+   */
+  bool BindNumaNode(int node, size_t off = 0, size_t size = 0,
+                    bool strict = false) {
+    if (!ClampDataRange(off, size)) {
+      return false;
+    }
+    return SystemInfo::BindMemoryToNumaNode(data_ + off, size, node, strict);
+  }
+
+  /**
+   * Interleave the pages of a data sub-range across all NUMA nodes
+   *
+   * @param off Byte offset into data_
+   * @param size Bytes to interleave (0 = through the end of the data region)
+   * @return true on success
+   */
+  bool InterleaveNumaNodes(size_t off = 0, size_t size = 0) {
+    if (!ClampDataRange(off, size)) {
+      return false;
+    }
+    return SystemInfo::InterleaveMemory(data_ + off, size);
+  }
+
+  /**
+   * Fault in the pages of a data sub-range ahead of first use
+   *
+   * @param off Byte offset into data_
+   * @param size Bytes to prefault (0 = through the end of the data region)
+   * @return true on success
+   */
+  bool Prefault(size_t off = 0, size_t size = 0) {
+    if (!ClampDataRange(off, size)) {
+      return false;
+    }
+    return SystemInfo::PrefaultMemory(data_ + off, size);
+  }
+
   /** Detach the mapped memory */
   void shm_detach() { _Detach(); }
 
@@ -189,6 +281,71 @@ class PosixShmMmap : public MemoryBackend, public UrlMemoryBackend {
   void shm_destroy() { _Destroy(); }
 
  protected:
+  /** Clamp [off, off + size) to the data region; size 0 means "to the end" */
+  bool ClampDataRange(size_t off, size_t &size) const {
+    if (data_ == nullptr || off >= data_capacity_) {
+      return false;
+    }
+    if (size == 0 || size > data_capacity_ - off) {
+      size = data_capacity_ - off;
+    }
+    return true;
+  }
+
+  /**
+   * Create the segment as one mapping backed by huge pages
+   *
+   * @param huge_page_size hugetlb page size, or 0 for transparent huge pages
+   * @return false if the file or mapping could not be created
+   */
+  bool _InitHuge(const MemoryBackendId &backend_id, size_t backend_size,
+                 const std::string &url, size_t huge_page_size) {
+    size_t align = huge_page_size ? huge_page_size
+                                  : GetHugePageSize(HugePageMode::kTransparent);
+    backend_size = (backend_size + align - 1) & ~(align - 1);
+
+    SystemInfo::DestroySharedMemory(url);
+    if (!SystemInfo::CreateNewSharedMemory(fd_, url, backend_size,
+                                           huge_page_size)) {
+      return false;
+    }
+    url_ = url;
+    backend_size_ = backend_size;
+    if (!_MapWhole()) {
+      SystemInfo::CloseSharedMemory(fd_);
+      SystemInfo::DestroySharedMemory(url);
+      return false;
+    }
+    if (huge_page_size == 0) {
+      SystemInfo::AdviseHugePages(header_, backend_size);
+    }
+
+    id_ = backend_id;
+    data_capacity_ = backend_size - kBackendHeaderSize;
+    data_id_ = -1;
+    flags_.Clear();
+    flags_.SetBits(MEMORY_BACKEND_HUGE_PAGES);
+
+    // Persist header fields into the shared mapping
+    (*header_) = (const MemoryBackendHeader &)*this;
+
+    SetOwner();
+    return true;
+  }
+
+  /** Map the whole file (backend_size_ bytes) with the header at its base */
+  bool _MapWhole() {
+    char *base = reinterpret_cast<char *>(
+        SystemInfo::MapSharedMemory(fd_, backend_size_, 0));
+    if (!base) {
+      return false;
+    }
+    header_ = reinterpret_cast<MemoryBackendHeader *>(base);
+    region_ = base + kBackendHeaderSize;
+    data_ = region_;
+    return true;
+  }
+
   /** Map shared memory */
   char *_ShmMap(size_t size, i64 off) {
     char *ptr =
@@ -205,6 +362,14 @@ class PosixShmMmap : public MemoryBackend, public UrlMemoryBackend {
       return;
     }
     const size_t hdr_size = kBackendHeaderSize;
+    if (flags_.Any(MEMORY_BACKEND_HUGE_PAGES)) {
+      // Header and data share the single mapping made by _MapWhole
+      SystemInfo::UnmapMemory(header_, backend_size_);
+      SystemInfo::CloseSharedMemory(fd_);
+      header_ = nullptr;
+      region_ = nullptr;
+      return;
+    }
     // Unmap the data region
     if (region_ != nullptr) {
       SystemInfo::UnmapMemory(region_, header_->backend_size_ - hdr_size);
@@ -0,0 +1,392 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef HSHM_THREAD_EPOCH_RECLAIMER_H_
+#define HSHM_THREAD_EPOCH_RECLAIMER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "hermes_shm/constants/macros.h"
+#include "hermes_shm/types/numbers.h"
+
+namespace hshm {
+
+/** Frees a retired pointer once no reader can still hold it */
+typedef void (*EbrDeleter)(void *ptr);
+
+/**
+ * Epoch-based reclamation (EBR) for process-local lock-free structures.
+ *
+ * Threads register as participants. A participant is either offline or
+ * pinned to the global epoch it last observed. Writers unlink a node and
+ * Retire() it; the node goes into the participant's limbo tagged with the
+ * current epoch. The global epoch advances only once every online
+ * participant has observed it, so a node retired in epoch e cannot be
+ * referenced once the global epoch reaches e + 2, and is freed then.
+ *
+ * Two ways to stay pinned:
+ *  - Enter()/Exit() (or EpochGuard) around each read-side section, for
+ *    client threads that touch lock-free structures occasionally.
+ *  - Quiesce() once per loop iteration, for runtime workers: between two
+ *    calls the worker counts as reading. Call Offline() before blocking,
+ *    or reclamation stalls for everyone.
+ *
+ * Host-only. Memory held in limbo is tracked for introspection.
+ */
+class EpochReclaimer {
+ public:
+  /** Epoch value of a participant that holds no references */
+  static constexpr u64 kOffline = ~0ULL;
+  /** Retires by one participant between attempts to advance the epoch */
+  static constexpr u32 kAdvanceInterval = 32;
+
+  /** A pointer waiting for two epoch advances */
+  struct Retired {
+    void *ptr_;
+    EbrDeleter deleter_;
+    size_t bytes_;
+  };
+
+  /** Per-thread reclamation state. Never freed; reused after Unregister */
+  struct Participant {
+    std::atomic<u64> epoch_{kOffline};
+    std::atomic<bool> in_use_{false};
+    Participant *next_ = nullptr;
+    std::vector<Retired> limbo_[3];  /**< Bucket i holds epoch % 3 == i */
+    u64 limbo_epoch_[3] = {0, 0, 0}; /**< Epoch of each bucket's entries */
+    u32 depth_ = 0;                  /**< Enter() nesting depth */
+    u32 since_advance_ = 0;          /**< Retires since last TryAdvance */
+  };
+
+ private:
+  /** A retired pointer left behind by a participant that unregistered */
+  struct Orphan {
+    Retired item_;
+    u64 epoch_;
+  };
+
+  std::atomic<u64> epoch_{0};
+  std::atomic<Participant *> head_{nullptr};
+  std::atomic<size_t> limbo_bytes_{0};
+  std::atomic<size_t> limbo_count_{0};
+  std::atomic<size_t> freed_count_{0};
+  std::mutex orphan_lock_;
+  std::vector<Orphan> orphans_;
+
+ public:
+  EpochReclaimer() = default;
+  EpochReclaimer(const EpochReclaimer &) = delete;
+  EpochReclaimer &operator=(const EpochReclaimer &) = delete;
+
+  /** Frees everything still in limbo; no reader may remain */
+  ~EpochReclaimer() {
+    FlushAll();
+    Participant *p = head_.load();
+    while (p) {
+      Participant *next = p->next_;
+      delete p;
+      p = next;
+    }
+  }
+
+  /** Process-wide instance */
+  static EpochReclaimer &Get() {
+    static EpochReclaimer ebr;
+    return ebr;
+  }
+
+  /**
+   * Participant for the calling thread, registered on first use and
+   * unregistered when the thread exits
+   */
+  static Participant *Local() {
+    struct Holder {
+      Participant *p_ = nullptr;
+      ~Holder() {
+        if (p_) {
+          Get().Unregister(p_);
+        }
+      }
+    };
+    static thread_local Holder holder;
+    if (!holder.p_) {
+      holder.p_ = Get().Register();
+    }
+    return holder.p_;
+  }
+
+  /** Claim a free participant slot or add a new one */
+  Participant *Register() {
+    for (Participant *p = head_.load(std::memory_order_acquire); p;
+         p = p->next_) {
+      bool expected = false;
+      if (!p->in_use_.load(std::memory_order_relaxed) &&
+          p->in_use_.compare_exchange_strong(expected, true)) {
+        return p;
+      }
+    }
+    auto *p = new Participant();
+    p->in_use_.store(true, std::memory_order_relaxed);
+    Participant *old_head = head_.load(std::memory_order_relaxed);
+    do {
+      p->next_ = old_head;
+    } while (!head_.compare_exchange_weak(old_head, p,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed));
+    return p;
+  }
+
+  /** Release a participant; its limbo moves to the shared orphan list */
+  void Unregister(Participant *p) {
+    p->epoch_.store(kOffline, std::memory_order_release);
+    p->depth_ = 0;
+    p->since_advance_ = 0;
+    {
+      std::lock_guard<std::mutex> guard(orphan_lock_);
+      for (int b = 0; b < 3; ++b) {
+        for (const Retired &item : p->limbo_[b]) {
+          orphans_.push_back(Orphan{item, p->limbo_epoch_[b]});
+        }
+        p->limbo_[b].clear();
+      }
+    }
+    p->in_use_.store(false, std::memory_order_release);
+  }
+
+  /** Pin p to the current epoch for a read-side section (nestable) */
+  void Enter(Participant *p) {
+    if (p->depth_++ == 0) {
+      Announce(p);
+    }
+  }
+
+  /** End a read-side section started with Enter() */
+  void Exit(Participant *p) {
+    if (--p->depth_ == 0) {
+      p->epoch_.store(kOffline, std::memory_order_release);
+    }
+  }
+
+  /**
+   * Quiescent point for loop-driven threads: drops every reference taken
+   * since the previous call and re-pins p to the current epoch. Also frees
+   * what p's limbo is now allowed to free.
+   */
+  void Quiesce(Participant *p) {
+    Announce(p);
+    if (HasLimbo(p)) {
+      TryAdvance();
+      Collect(p);
+    }
+  }
+
+  /** Mark p as holding no references, e.g. before a worker sleeps */
+  void Offline(Participant *p) {
+    p->epoch_.store(kOffline, std::memory_order_release);
+  }
+
+  /**
+   * Defer deleter(ptr) until no participant can still reference ptr.
+   * The caller must already have unlinked ptr from the shared structure.
+   *
+   * @param p Calling thread's participant
+   * @param ptr Unlinked node
+   * @param deleter Frees ptr
+   * @param bytes Size charged to the limbo accounting
+   */
+  void Retire(Participant *p, void *ptr, EbrDeleter deleter,
+              size_t bytes = 0) {
+    u64 e = epoch_.load(std::memory_order_acquire);
+    int b = static_cast<int>(e % 3);
+    if (!p->limbo_[b].empty() && p->limbo_epoch_[b] != e) {
+      FreeBucket(p, b);  // Retired at e - 3 or earlier
+    }
+    p->limbo_[b].push_back(Retired{ptr, deleter, bytes});
+    p->limbo_epoch_[b] = e;
+    limbo_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    limbo_count_.fetch_add(1, std::memory_order_relaxed);
+    if (++p->since_advance_ >= kAdvanceInterval) {
+      p->since_advance_ = 0;
+      TryAdvance();
+      Collect(p);
+    }
+  }
+
+  /** Retire a node allocated with new */
+  template <typename T>
+  void Retire(Participant *p, T *ptr) {
+    Retire(p, ptr, [](void *x) { delete static_cast<T *>(x); }, sizeof(T));
+  }
+
+  /**
+   * Advance the global epoch if every online participant has observed it.
+   * Also frees orphans that became safe.
+   *
+   * @return true if the epoch advanced
+   */
+  bool TryAdvance() {
+    u64 e = epoch_.load(std::memory_order_seq_cst);
+    for (Participant *p = head_.load(std::memory_order_acquire); p;
+         p = p->next_) {
+      u64 pe = p->epoch_.load(std::memory_order_seq_cst);
+      if (pe != kOffline && pe != e) {
+        return false;
+      }
+    }
+    if (!epoch_.compare_exchange_strong(e, e + 1)) {
+      return false;
+    }
+    CollectOrphans(e + 1);
+    return true;
+  }
+
+  /**
+   * Free everything in limbo regardless of epochs. Only for shutdown,
+   * once no thread can be reading any lock-free structure.
+   */
+  void FlushAll() {
+    for (Participant *p = head_.load(std::memory_order_acquire); p;
+         p = p->next_) {
+      for (int b = 0; b < 3; ++b) {
+        FreeBucket(p, b);
+      }
+    }
+    CollectOrphans(kOffline);
+  }
+
+  /** Current global epoch */
+  u64 GetEpoch() const { return epoch_.load(std::memory_order_acquire); }
+
+  /** Bytes retired but not yet freed */
+  size_t GetLimboBytes() const {
+    return limbo_bytes_.load(std::memory_order_relaxed);
+  }
+
+  /** Pointers retired but not yet freed */
+  size_t GetLimboCount() const {
+    return limbo_count_.load(std::memory_order_relaxed);
+  }
+
+  /** Pointers freed since construction */
+  size_t GetFreedCount() const {
+    return freed_count_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  /** Publish the current epoch as p's; seq_cst orders it before reads */
+  void Announce(Participant *p) {
+    p->epoch_.store(epoch_.load(std::memory_order_seq_cst),
+                    std::memory_order_seq_cst);
+  }
+
+  /** Whether p holds anything in limbo */
+  static bool HasLimbo(const Participant *p) {
+    return !p->limbo_[0].empty() || !p->limbo_[1].empty() ||
+           !p->limbo_[2].empty();
+  }
+
+  /** Free p's buckets retired at least two epochs ago */
+  void Collect(Participant *p) {
+    u64 e = epoch_.load(std::memory_order_acquire);
+    for (int b = 0; b < 3; ++b) {
+      if (!p->limbo_[b].empty() && p->limbo_epoch_[b] + 2 <= e) {
+        FreeBucket(p, b);
+      }
+    }
+  }
+
+  /** Run the deleters of one bucket */
+  void FreeBucket(Participant *p, int b) {
+    size_t bytes = 0;
+    for (const Retired &item : p->limbo_[b]) {
+      item.deleter_(item.ptr_);
+      bytes += item.bytes_;
+    }
+    size_t count = p->limbo_[b].size();
+    p->limbo_[b].clear();
+    Account(count, bytes);
+  }
+
+  /** Free orphans retired at least two epochs before e */
+  void CollectOrphans(u64 e) {
+    std::lock_guard<std::mutex> guard(orphan_lock_);
+    size_t kept = 0, count = 0, bytes = 0;
+    for (size_t i = 0; i < orphans_.size(); ++i) {
+      Orphan &o = orphans_[i];
+      if (e == kOffline || o.epoch_ + 2 <= e) {
+        o.item_.deleter_(o.item_.ptr_);
+        bytes += o.item_.bytes_;
+        ++count;
+      } else {
+        orphans_[kept++] = o;
+      }
+    }
+    orphans_.resize(kept);
+    Account(count, bytes);
+  }
+
+  /** Update limbo accounting after freeing */
+  void Account(size_t count, size_t bytes) {
+    if (count == 0) {
+      return;
+    }
+    limbo_count_.fetch_sub(count, std::memory_order_relaxed);
+    limbo_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+    freed_count_.fetch_add(count, std::memory_order_relaxed);
+  }
+};
+
+/** Pins the calling thread to the current epoch for the guard's scope */
+class EpochGuard {
+ public:
+  EpochGuard() : p_(EpochReclaimer::Local()) {
+    EpochReclaimer::Get().Enter(p_);
+  }
+  ~EpochGuard() { EpochReclaimer::Get().Exit(p_); }
+  EpochGuard(const EpochGuard &) = delete;
+  EpochGuard &operator=(const EpochGuard &) = delete;
+
+ private:
+  EpochReclaimer::Participant *p_;
+};
+
+}  // namespace hshm
+
+/** Process-wide epoch reclaimer */
+#define HSHM_EBR (&hshm::EpochReclaimer::Get())
+
+#endif  // HSHM_THREAD_EPOCH_RECLAIMER_H_
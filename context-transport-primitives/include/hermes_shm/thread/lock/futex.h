@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HSHM_THREAD_LOCK_FUTEX_H_
+#define HSHM_THREAD_LOCK_FUTEX_H_
+
+#include <climits>
+
+#include "hermes_shm/introspect/system_info.h"
+#include "hermes_shm/thread/thread_model_manager.h"
+#include "hermes_shm/types/atomic.h"
+#include "hermes_shm/types/numbers.h"
+
+namespace hshm {
+
+/**
+ * Parking word for locks that live in shared memory.
+ *
+ * Waiters spin for a short while and then sleep on a shared futex, so an
+ * oversubscribed host does not burn cores on contended locks. Waking is
+ * broadcast: locks built on this re-check their own state after every
+ * wake-up. GPU code and cooperative thread models (Argobots) never park;
+ * they keep yielding through the thread model as before.
+ */
+struct Futex {
+  /** Yield-spin iterations before a waiter parks */
+  static constexpr int kSpinCount = 64;
+
+  ipc::atomic<u32> word_;     /**< Bumped on every wake-up */
+  ipc::atomic<u32> waiters_;  /**< Threads parked (or about to park) */
+
+  /** Default constructor */
+  HSHM_INLINE_CROSS_FUN
+  Futex() : word_(0), waiters_(0) {}
+
+  /** Explicit initialization */
+  HSHM_INLINE_CROSS_FUN
+  void Init() {
+    word_ = 0;
+    waiters_ = 0;
+  }
+
+  /**
+   * Block until ready() returns true
+   *
+   * @param ready Predicate re-evaluated after each spin or wake-up
+   * @param park_us Cap on each sleep, for state a peer may change without
+   *        calling WakeAll() (e.g. a GPU producer). 0 sleeps until woken.
+   */
+  template <typename PredT>
+  HSHM_INLINE_CROSS_FUN void Wait(PredT &&ready, u32 park_us = 0) {
+    for (int i = 0; i < kSpinCount; ++i) {
+      if (ready()) {
+        return;
+      }
+      HSHM_THREAD_MODEL->Yield();
+    }
+#if HSHM_IS_HOST
+    if (CanPark()) {
+      // Register before re-checking so a concurrent Wake() either sees us
+      // or changed the state before our check
+      waiters_.fetch_add(1);
+      while (true) {
+        u32 word = word_.load();
+        if (ready()) {
+          break;
+        }
+        SystemInfo::FutexWait(&word_.x, word, park_us);
+      }
+      waiters_.fetch_sub(1);
+      return;
+    }
+#endif
+    (void)park_us;
+    while (!ready()) {
+      HSHM_THREAD_MODEL->Yield();
+    }
+  }
+
+  /** Wake every parked waiter. Call after publishing the state change. */
+  HSHM_INLINE_CROSS_FUN
+  void WakeAll() {
+#if HSHM_IS_HOST
+    if (waiters_.load() > 0) {
+      word_.fetch_add(1);
+      SystemInfo::FutexWake(&word_.x, INT_MAX);
+    }
+#endif
+  }
+
+ private:
+#if HSHM_IS_HOST
+  /** Whether blocking the OS thread is safe for the current thread model */
+  static bool CanPark() {
+    auto *thread_model = HSHM_THREAD_MODEL;
+    ThreadType type = thread_model->GetType();
+    return type == ThreadType::kPthread ||
+           type == ThreadType::kStdThread;
+  }
+#endif
+};
+
+}  // namespace hshm
+
+#endif  // HSHM_THREAD_LOCK_FUTEX_H_
@@ -34,6 +34,7 @@
 #ifndef HSHM_THREAD_MUTEX_H_
 #define HSHM_THREAD_MUTEX_H_
 
+#include "hermes_shm/thread/lock/futex.h"
 #include "hermes_shm/thread/thread_model_manager.h"
 #include "hermes_shm/types/atomic.h"
 #include "hermes_shm/types/numbers.h"
@@ -44,6 +45,7 @@ struct Mutex {
   ipc::atomic<hshm::min_u64> lock_;
   ipc::atomic<hshm::min_u64> head_;
   ipc::atomic<hshm::min_u32> try_lock_;
+  Futex futex_;
   /** Default constructor */
   HSHM_INLINE_CROSS_FUN
   Mutex() : lock_(0), head_(0), try_lock_(0) {}
@@ -57,23 +59,22 @@ struct Mutex {
   void Init() {
     lock_ = 0;
     head_ = 0;
+    futex_.Init();
   }
 
-  /** Acquire lock */
+  /** Acquire lock. Spins briefly, then parks on futex_ (host threads) */
   HSHM_INLINE_CROSS_FUN
   void Lock(u32 owner) {
     min_u64 tkt = lock_.fetch_add(1);
+#if HSHM_IS_GPU
     u32 spin_count = 0;
     do {
-      for (int i = 0; i < 1; ++i) {
-        // Use load_device() for cross-SM L2 visibility on GPU.
-        // Unlock() advances head_ via fetch_add (L2 atomic), but
-        // a volatile load() on a different SM reads stale L1 data.
-        if (tkt == head_.load_device()) {
-          return;
-        }
+      // Use load_device() for cross-SM L2 visibility on GPU.
+      // Unlock() advances head_ via fetch_add (L2 atomic), but
+      // a volatile load() on a different SM reads stale L1 data.
+      if (tkt == head_.load_device()) {
+        return;
       }
-#if HSHM_IS_GPU
       ++spin_count;
       if (spin_count == 5000000) {
         printf("[MUTEX] STUCK: tkt=%llu head=%llu this=%p\n",
@@ -82,9 +83,11 @@ struct Mutex {
                (void*)this);
         spin_count = 0;
       }
-#endif
       HSHM_THREAD_MODEL->Yield();
     } while (true);
+#else
+    futex_.Wait([&]() { return tkt == head_.load_device(); });
+#endif
   }
 
   /** Try to acquire the lock */
@@ -102,6 +105,7 @@ struct Mutex {
   HSHM_INLINE_CROSS_FUN
   void Unlock() {
     head_.fetch_add(1);
+    futex_.WakeAll();
   }
 };
 
@@ -36,6 +36,7 @@
 
 #include "hermes_shm/constants/macros.h"
 #include "hermes_shm/thread/lock.h"
+#include "hermes_shm/thread/lock/futex.h"
 #include "hermes_shm/thread/thread_model_manager.h"
 #include "hermes_shm/types/atomic.h"
 #include "hermes_shm/types/numbers.h"
@@ -57,6 +58,7 @@ struct RwLock {
   ipc::atomic<hshm::reg_uint> writers_;
   ipc::atomic<hshm::reg_uint> cur_writer_;
   ipc::atomic<hshm::big_uint> ticket_;
+  Futex futex_;
   /** Default constructor */
   HSHM_CROSS_FUN
   RwLock()
@@ -74,6 +76,7 @@ struct RwLock {
     ticket_ = 0;
     mode_ = RwLockMode::kNone;
     cur_writer_ = 0;
+    futex_.Init();
   }
 
   /** Delete copy constructor */
@@ -102,61 +105,58 @@ struct RwLock {
     return *this;
   }
 
-  /** Acquire read lock */
+  /** Acquire read lock. Spins briefly, then parks (host threads) */
   HSHM_CROSS_FUN
   void ReadLock(uint32_t owner) {
-    RwLockMode::Type mode;
-
     // Increment # readers. Check if in read mode.
     readers_.fetch_add(1);
 
     // Wait until we are in read mode
-    do {
+    futex_.Wait([&]() {
+      RwLockMode::Type mode;
       UpdateMode(mode);
       if (mode == RwLockMode::kRead) {
-        return;
+        return true;
       }
       if (mode == RwLockMode::kNone) {
-        bool ret = mode_.compare_exchange_weak(mode, RwLockMode::kRead);
-        if (ret) {
-          return;
-        }
+        // Strong CAS: a spurious failure here could park with no one
+        // left to wake us. On failure, mode holds the current value.
+        return mode_.compare_exchange_strong(mode, RwLockMode::kRead) ||
+               mode == RwLockMode::kRead;
       }
-      HSHM_THREAD_MODEL->Yield();
-    } while (true);
+      return false;
+    });
   }
 
   /** Release read lock */
   HSHM_CROSS_FUN
-  void ReadUnlock() { readers_.fetch_sub(1); }
+  void ReadUnlock() {
+    readers_.fetch_sub(1);
+    futex_.WakeAll();
+  }
 
-  /** Acquire write lock */
+  /** Acquire write lock. Spins briefly, then parks (host threads) */
   HSHM_CROSS_FUN
   void WriteLock(uint32_t owner) {
-    RwLockMode::Type mode;
-    uint32_t cur_writer;
-
     // Increment # writers & get ticket
     writers_.fetch_add(1);
     uint64_t tkt = ticket_.fetch_add(1);
 
-    // Wait until we are in read mode
-    do {
+    // Wait until we are in write mode and it is our turn
+    futex_.Wait([&]() {
+      RwLockMode::Type mode;
       UpdateMode(mode);
       if (mode == RwLockMode::kNone) {
-        mode_.compare_exchange_weak(mode, RwLockMode::kWrite);
+        mode_.compare_exchange_strong(mode, RwLockMode::kWrite);
         // Use load_device() for cross-SM L2 visibility on GPU.
         mode = mode_.load_device();
       }
       if (mode == RwLockMode::kWrite) {
         // Use load_device() for cross-SM L2 visibility on GPU.
-        cur_writer = cur_writer_.load_device();
-        if (cur_writer == tkt) {
-          return;
-        }
+        return cur_writer_.load_device() == tkt;
       }
-      HSHM_THREAD_MODEL->Yield();
-    } while (true);
+      return false;
+    });
   }
 
   /** Release write lock */
@@ -164,6 +164,7 @@ struct RwLock {
   void WriteUnlock() {
     writers_.fetch_sub(1);
     cur_writer_.fetch_add(1);
+    futex_.WakeAll();
   }
 
  private:
@@ -176,7 +177,9 @@ struct RwLock {
     mode = mode_.load_device();
     if ((readers_.load_device() == 0 && mode == RwLockMode::kRead) ||
         (writers_.load_device() == 0 && mode == RwLockMode::kWrite)) {
-      mode_.compare_exchange_weak(mode, RwLockMode::kNone);
+      if (mode_.compare_exchange_strong(mode, RwLockMode::kNone)) {
+        mode = RwLockMode::kNone;
+      }
     }
   }
 };
@@ -51,6 +51,13 @@ struct GpuIpcMemHandle {
 #endif
 };
 
+/** Native stream handle of the enabled GPU runtime (for kernel launches) */
+#if HSHM_ENABLE_ROCM
+typedef hipStream_t GpuStream;
+#elif HSHM_ENABLE_CUDA
+typedef cudaStream_t GpuStream;
+#endif
+
 class GpuApi {
  public:
   static void SetDevice(int gpu_id) {
@@ -85,6 +92,91 @@ class GpuApi {
     return ngpu;
   }
 
+  /** The calling thread's current device, or 0 without a GPU */
+  static int GetDevice() {
+    int gpu_id = 0;
+#if HSHM_ENABLE_ROCM
+    if (hipGetDevice(&gpu_id) != hipSuccess) {
+      gpu_id = 0;
+    }
+#elif HSHM_ENABLE_CUDA
+    if (cudaGetDevice(&gpu_id) != cudaSuccess) {
+      cudaGetLastError();  // Clear the error state
+      gpu_id = 0;
+    }
+#endif
+    return gpu_id;
+  }
+
+  /**
+   * Device that owns a pointer's memory
+   * @param ptr Any pointer
+   * @return Device id if ptr is device memory, -1 for host memory
+   */
+  static int GetPointerDevice(const void *ptr) {
+#if HSHM_ENABLE_ROCM
+    hipPointerAttribute_t attributes;
+    if (hipPointerGetAttributes(&attributes, ptr) != hipSuccess) {
+      return -1;
+    }
+    return attributes.type == hipMemoryTypeDevice ? attributes.device : -1;
+#elif HSHM_ENABLE_CUDA
+    cudaPointerAttributes attributes;
+    if (cudaPointerGetAttributes(&attributes, ptr) != cudaSuccess) {
+      cudaGetLastError();  // Clear the error state
+      return -1;
+    }
+    return attributes.type == cudaMemoryTypeDevice ? attributes.device : -1;
+#else
+    (void)ptr;
+    return -1;
+#endif
+  }
+
+  /**
+   * Let kernels and copies on one device address another device's memory
+   * directly (NVLink or PCIe peer-to-peer). Restores the current device.
+   * @param gpu_id Device that will access the memory
+   * @param peer_id Device that owns the memory
+   * @return true if peer access is enabled (now or before)
+   */
+  static bool EnablePeerAccess(int gpu_id, int peer_id) {
+    if (gpu_id == peer_id) {
+      return true;
+    }
+    int can_access = 0;
+    bool enabled = false;
+#if HSHM_ENABLE_ROCM
+    if (hipDeviceCanAccessPeer(&can_access, gpu_id, peer_id) != hipSuccess ||
+        !can_access) {
+      return false;
+    }
+    int prev = GetDevice();
+    if (hipSetDevice(gpu_id) == hipSuccess) {
+      hipError_t err = hipDeviceEnablePeerAccess(peer_id, 0);
+      enabled = err == hipSuccess || err == hipErrorPeerAccessAlreadyEnabled;
+      hipGetLastError();
+    }
+    hipSetDevice(prev);
+#elif HSHM_ENABLE_CUDA
+    if (cudaDeviceCanAccessPeer(&can_access, gpu_id, peer_id) != cudaSuccess ||
+        !can_access) {
+      cudaGetLastError();
+      return false;
+    }
+    int prev = GetDevice();
+    if (cudaSetDevice(gpu_id) == cudaSuccess) {
+      cudaError_t err = cudaDeviceEnablePeerAccess(peer_id, 0);
+      enabled = err == cudaSuccess || err == cudaErrorPeerAccessAlreadyEnabled;
+      cudaGetLastError();  // Clear cudaErrorPeerAccessAlreadyEnabled
+    }
+    cudaSetDevice(prev);
+#else
+    (void)can_access;
+#endif
+    return enabled;
+  }
+
   static void Synchronize() {
 #if HSHM_ENABLE_ROCM
     HIP_ERROR_CHECK(hipDeviceSynchronize());
@@ -95,6 +187,22 @@ class GpuApi {
 #endif
   }
 
+  /**
+   * Read and clear the runtime's sticky error state.
+   * @return Description of the pending error, or nullptr if there is none
+   */
+  static const char *PopLastError() {
+#if HSHM_ENABLE_ROCM
+    hipError_t err = hipGetLastError();
+    return err == hipSuccess ? nullptr : hipGetErrorString(err);
+#elif HSHM_ENABLE_CUDA
+    cudaError_t err = cudaGetLastError();
+    return err == cudaSuccess ? nullptr : cudaGetErrorString(err);
+#else
+    return nullptr;
+#endif
+  }
+
   /** Synchronize a specific GPU stream instead of the whole device */
   static void Synchronize(void *stream) {
 #if HSHM_ENABLE_ROCM
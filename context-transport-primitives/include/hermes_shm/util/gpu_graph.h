@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef HSHM_UTIL_GPU_GRAPH_H
+#define HSHM_UTIL_GPU_GRAPH_H
+
+#include "hermes_shm/constants/macros.h"
+#include "hermes_shm/util/logging.h"
+
+namespace hshm {
+
+/**
+ * Captured CUDA/HIP graph for a stream-ordered sequence that repeats
+ * unchanged across iterations (memsets + kernel launches of one
+ * timestep). Capture once with BeginCapture/EndCapture, then Launch
+ * replays the whole sequence with a single driver call instead of one
+ * call per operation.
+ *
+ * Re-capturing into a graph that is already instantiated first tries an
+ * in-place exec update (cheap when only kernel arguments changed) and
+ * falls back to re-instantiation when the topology differs.
+ *
+ * Host-side operations (host writes to pinned memory, driver VMM calls
+ * such as cuMemMap) cannot be captured; issue them outside the graph.
+ * On builds without CUDA/ROCm every method is a no-op returning false.
+ */
+class GpuGraph {
+ public:
+  GpuGraph() = default;
+  GpuGraph(const GpuGraph &) = delete;
+  GpuGraph &operator=(const GpuGraph &) = delete;
+
+  ~GpuGraph() { Reset(); }
+
+  /** Whether a graph has been captured and instantiated. */
+  bool IsReady() const { return exec_ != nullptr; }
+
+  /**
+   * Start capturing the work submitted to \a stream.
+   * Thread-local capture mode keeps other threads' unrelated CUDA calls
+   * (e.g. the runtime's own streams) legal while the capture is open.
+   * @param stream Non-default stream to record
+   * @return true when capture began
+   */
+  bool BeginCapture(void *stream) {
+#if HSHM_ENABLE_CUDA
+    return cudaStreamBeginCapture(static_cast<cudaStream_t>(stream),
+                                  cudaStreamCaptureModeThreadLocal) ==
+           cudaSuccess;
+#elif HSHM_ENABLE_ROCM
+    return hipStreamBeginCapture(static_cast<hipStream_t>(stream),
+                                 hipStreamCaptureModeThreadLocal) ==
+           hipSuccess;
+#else
+    (void)stream;
+    return false;
+#endif
+  }
+
+  /**
+   * Finish the capture started on \a stream and make it launchable.
+   * @param stream The stream passed to BeginCapture
+   * @return true when the graph is ready to launch
+   */
+  bool EndCapture(void *stream) {
+#if HSHM_ENABLE_CUDA
+    cudaGraph_t graph = nullptr;
+    if (cudaStreamEndCapture(static_cast<cudaStream_t>(stream), &graph) !=
+            cudaSuccess ||
+        graph == nullptr) {
+      HLOG(kError, "GpuGraph: stream capture failed");
+      return false;
+    }
+    if (exec_ != nullptr) {
+#if CUDART_VERSION >= 12000
+      cudaGraphExecUpdateResultInfo info;
+      bool updated = cudaGraphExecUpdate(static_cast<cudaGraphExec_t>(exec_),
+                                         graph, &info) == cudaSuccess;
+#else
+      cudaGraphNode_t err_node;
+      cudaGraphExecUpdateResult result;
+      bool updated =
+          cudaGraphExecUpdate(static_cast<cudaGraphExec_t>(exec_), graph,
+                              &err_node, &result) == cudaSuccess;
+#endif
+      if (!updated) {
+        cudaGetLastError();
+        cudaGraphExecDestroy(static_cast<cudaGraphExec_t>(exec_));
+        exec_ = nullptr;
+      }
+    }
+    if (exec_ == nullptr) {
+      cudaGraphExec_t exec;
+      if (cudaGraphInstantiate(&exec, graph, 0) != cudaSuccess) {
+        HLOG(kError, "GpuGraph: graph instantiation failed");
+        cudaGraphDestroy(graph);
+        return false;
+      }
+      exec_ = exec;
+    }
+    if (graph_ != nullptr) {
+      cudaGraphDestroy(static_cast<cudaGraph_t>(graph_));
+    }
+    graph_ = graph;
+    return true;
+#elif HSHM_ENABLE_ROCM
+    hipGraph_t graph = nullptr;
+    if (hipStreamEndCapture(static_cast<hipStream_t>(stream), &graph) !=
+            hipSuccess ||
+        graph == nullptr) {
+      HLOG(kError, "GpuGraph: stream capture failed");
+      return false;
+    }
+    if (exec_ != nullptr) {
+      hipGraphNode_t err_node;
+      hipGraphExecUpdateResult result;
+      if (hipGraphExecUpdate(static_cast<hipGraphExec_t>(exec_), graph,
+                             &err_node, &result) != hipSuccess) {
+        (void)hipGetLastError();
+        (void)hipGraphExecDestroy(static_cast<hipGraphExec_t>(exec_));
+        exec_ = nullptr;
+      }
+    }
+    if (exec_ == nullptr) {
+      hipGraphExec_t exec;
+      if (hipGraphInstantiate(&exec, graph, nullptr, nullptr, 0) !=
+          hipSuccess) {
+        HLOG(kError, "GpuGraph: graph instantiation failed");
+        (void)hipGraphDestroy(graph);
+        return false;
+      }
+      exec_ = exec;
+    }
+    if (graph_ != nullptr) {
+      (void)hipGraphDestroy(static_cast<hipGraph_t>(graph_));
+    }
+    graph_ = graph;
+    return true;
+#else
+    (void)stream;
+    return false;
+#endif
+  }
+
+  /**
+   * Replay the captured sequence on \a stream.
+   * @return true when the launch was accepted
+   */
+  bool Launch(void *stream) {
+    if (exec_ == nullptr) return false;
+#if HSHM_ENABLE_CUDA
+    return cudaGraphLaunch(static_cast<cudaGraphExec_t>(exec_),
+                           static_cast<cudaStream_t>(stream)) == cudaSuccess;
+#elif HSHM_ENABLE_ROCM
+    return hipGraphLaunch(static_cast<hipGraphExec_t>(exec_),
+                          static_cast<hipStream_t>(stream)) == hipSuccess;
+#else
+    (void)stream;
+    return false;
+#endif
+  }
+
+  /** Release the captured graph and its executable instance. */
+  void Reset() {
+#if HSHM_ENABLE_CUDA
+    if (exec_ != nullptr) {
+      cudaGraphExecDestroy(static_cast<cudaGraphExec_t>(exec_));
+    }
+    if (graph_ != nullptr) {
+      cudaGraphDestroy(static_cast<cudaGraph_t>(graph_));
+    }
+#elif HSHM_ENABLE_ROCM
+    if (exec_ != nullptr) {
+      (void)hipGraphExecDestroy(static_cast<hipGraphExec_t>(exec_));
+    }
+    if (graph_ != nullptr) {
+      (void)hipGraphDestroy(static_cast<hipGraph_t>(graph_));
+    }
+#endif
+    exec_ = nullptr;
+    graph_ = nullptr;
+  }
+
+ private:
+  void *graph_ = nullptr; /**< cudaGraph_t / hipGraph_t */
+  void *exec_ = nullptr;  /**< cudaGraphExec_t / hipGraphExec_t */
+};
+
+}  // namespace hshm
+
+#endif  // HSHM_UTIL_GPU_GRAPH_H
@@ -34,10 +34,21 @@
 #ifndef HSHM_SHM_INCLUDE_HSHM_SHM_UTIL_LOGGING_H_
 #define HSHM_SHM_INCLUDE_HSHM_SHM_UTIL_LOGGING_H_
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <climits>
+#include <cstdlib>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 #include "formatter.h"
 #include "hermes_shm/introspect/system_info.h"
 
@@ -101,6 +112,91 @@ namespace hshm {
     }                                                                     \
   } while (false)
 
+/** A log message waiting for the asynchronous writer */
+struct LogRecord {
+  int64_t time_ns_ = 0;        /**< steady_clock time of the HLOG call */
+  int level_ = 0;
+  int line_ = 0;
+  int tid_ = 0;
+  const char *path_ = nullptr; /**< __FILE__ (static storage) */
+  const char *func_ = nullptr; /**< __func__ (static storage) */
+  std::string msg_;            /**< Formatted user message */
+};
+
+/**
+ * Bounded single-producer single-consumer ring of log records. The owning
+ * thread pushes; the writer thread drains. A push never blocks: when the
+ * ring is full the record is dropped and counted.
+ */
+class LogRing {
+ public:
+  explicit LogRing(size_t depth) {
+    size_t cap = 1;
+    while (cap < depth) {
+      cap <<= 1;
+    }
+    slots_.resize(cap);
+    mask_ = cap - 1;
+  }
+
+  /**
+   * Enqueue a record (producer only)
+   * @param rec Record, moved from on success
+   * @return false if the ring was full and the record was dropped
+   */
+  bool TryPush(LogRecord &rec) {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) > mask_) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    slots_[tail & mask_] = std::move(rec);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Move every queued record into out (consumer only)
+   * @param out Destination
+   * @return Number of records drained
+   */
+  size_t Drain(std::vector<LogRecord> &out) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    for (uint64_t i = head; i < tail; ++i) {
+      out.emplace_back(std::move(slots_[i & mask_]));
+    }
+    head_.store(tail, std::memory_order_release);
+    return static_cast<size_t>(tail - head);
+  }
+
+  /** @return true if no record is queued */
+  bool Empty() const {
+    return head_.load(std::memory_order_acquire) ==
+           tail_.load(std::memory_order_acquire);
+  }
+
+  std::atomic<uint64_t> dropped_{0};   /**< Records lost to a full ring */
+  std::atomic<bool> retired_{false};   /**< Owning thread has exited */
+
+ private:
+  std::vector<LogRecord> slots_;
+  uint64_t mask_ = 0;
+  alignas(64) std::atomic<uint64_t> head_{0};
+  alignas(64) std::atomic<uint64_t> tail_{0};
+};
+
+/** Writer thread and ring registry of an asynchronous Logger (host only) */
+struct LogAsyncState {
+  std::thread writer_;
+  std::atomic<bool> stop_{false};
+  size_t depth_ = 0;                  /**< Depth of newly created rings */
+  std::mutex rings_lock_;             /**< Guards rings_ (not the records) */
+  std::vector<std::unique_ptr<LogRing>> rings_;
+  uint64_t dropped_retired_ = 0;      /**< Drops of freed rings */
+  uint64_t dropped_reported_ = 0;     /**< Writer thread only */
+};
+
 /**
  * Logger class for handling log output
  *
@@ -108,12 +204,19 @@ namespace hshm {
  * - Runtime log level filtering via HSHM_LOG_LEVEL environment variable
  * - File output via HSHM_LOG_OUT environment variable
  * - Routing to stdout (debug/info) or stderr (warning/error/fatal)
+ * - Asynchronous output via HSHM_LOG_ASYNC: HLOG formats the message and
+ *   pushes it to a per-thread ring; a writer thread decorates, orders and
+ *   writes batches. Workers never block on I/O, and a full ring drops the
+ *   record (see GetDroppedCount). kFatal is always written synchronously.
  */
 class Logger {
  public:
   FILE *fout_;
   int runtime_log_level_;  /**< Runtime log level threshold */
 
+  static constexpr size_t kDefaultAsyncDepth = 4096;
+  static constexpr int kAsyncIdleSleepUs = 1000;
+
   HSHM_CROSS_FUN
   Logger() {
 #if HSHM_IS_HOST
@@ -153,6 +256,84 @@ class Logger {
     if (!env.empty()) {
       fout_ = fopen(env.c_str(), "w");
     }
+
+    // Check for asynchronous output
+    std::string async_env = hshm::SystemInfo::Getenv(
+        "HSHM_LOG_ASYNC", hshm::Unit<size_t>::Megabytes(1));
+    if (async_env == "1" || async_env == "true" || async_env == "on") {
+      size_t depth = kDefaultAsyncDepth;
+      std::string depth_env = hshm::SystemInfo::Getenv(
+          "HSHM_LOG_ASYNC_DEPTH", hshm::Unit<size_t>::Megabytes(1));
+      if (!depth_env.empty()) {
+        try {
+          depth = std::max<size_t>(std::stoull(depth_env), 2);
+        } catch (...) {
+          // Keep default on parse failure
+        }
+      }
+      StartAsync(depth);
+    }
+#endif
+  }
+
+  /**
+   * Route HLOG output through per-thread rings and a writer thread
+   * @param depth Records each thread can queue (rounded up to a power of 2)
+   */
+  void StartAsync(size_t depth = kDefaultAsyncDepth) {
+#if HSHM_IS_HOST
+    std::lock_guard<std::mutex> lock(AsyncControlLock());
+    if (async_on_.load()) {
+      return;
+    }
+    bool first = async_ == nullptr;
+    if (first) {
+      async_ = new LogAsyncState();  // Lives as long as the singleton
+    }
+    async_->depth_ = depth;
+    async_->stop_.store(false);
+    async_->writer_ = std::thread([this]() { AsyncWriterLoop(); });
+    async_on_.store(true);
+    if (first) {
+      std::atexit([]() { HSHM_LOG->StopAsync(); });
+#ifndef _WIN32
+      pthread_atfork(nullptr, nullptr, []() { HSHM_LOG->OnForkChild(); });
+#endif
+    }
+#endif
+  }
+
+  /**
+   * Write every queued record and return to synchronous output
+   */
+  void StopAsync() {
+#if HSHM_IS_HOST
+    if (!async_on_.load()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(AsyncControlLock());
+    if (!async_on_.load()) {
+      return;
+    }
+    async_on_.store(false);
+    async_->stop_.store(true);
+    async_->writer_.join();
+#endif
+  }
+
+  /** @return true while HLOG output is asynchronous */
+  bool IsAsync() const { return async_on_.load(std::memory_order_relaxed); }
+
+  /** @return Records dropped because a thread's ring was full */
+  uint64_t GetDroppedCount() {
+#if HSHM_IS_HOST
+    if (async_ == nullptr) {
+      return 0;
+    }
+    std::lock_guard<std::mutex> lock(async_->rings_lock_);
+    return async_->dropped_retired_ + CountRingDrops();
+#else
+    return 0;
 #endif
   }
 
@@ -223,39 +404,201 @@ class Logger {
       return;
     }
 
-    const char* level = GetLevelString(LOG_CODE);
-    const char* color = GetLevelColor(LOG_CODE);
+    LogRecord rec;
+    rec.level_ = LOG_CODE;
+    rec.line_ = line;
+    rec.tid_ = SystemInfo::GetTid();
+    rec.path_ = path;
+    rec.func_ = func;
+    rec.msg_ = hshm::Formatter::format(fmt, std::forward<Args>(args)...);
+
+    if constexpr (LOG_CODE != kFatal) {
+      if (async_on_.load(std::memory_order_acquire)) {
+        rec.time_ns_ = NowNs();
+        GetThreadRing().TryPush(rec);
+        return;
+      }
+    } else {
+      // Earlier messages first, then the fatal one, before exiting
+      StopAsync();
+    }
+
+    WriteRecord(rec, true);
+
+    // Fatal errors terminate the program
+    if (LOG_CODE == kFatal) {
+      exit(1);
+    }
+#endif
+  }
+
+ private:
+  /** Format one record to the console (and log file) */
+  void WriteRecord(const LogRecord &rec, bool flush) {
+    const char* level = GetLevelString(rec.level_);
+    const char* color = GetLevelColor(rec.level_);
     const char* reset = "\033[0m";
-    std::string msg = hshm::Formatter::format(fmt, std::forward<Args>(args)...);
-    int tid = SystemInfo::GetTid();
     std::string out = hshm::Formatter::format(
         "{}{}:{} {} {} {} {}{}\n",
-        color, path, line, level, tid, func, msg, reset);
+        color, rec.path_, rec.line_, level, rec.tid_, rec.func_, rec.msg_,
+        reset);
 
     // Route to appropriate output stream
     // Debug, Info, and Success go to stdout; Warning/Error/Fatal go to stderr
-    if (LOG_CODE <= kSuccess) {
+    if (rec.level_ <= kSuccess) {
       std::cout << out;
-      fflush(stdout);
+      if (flush) fflush(stdout);
     } else {
       std::cerr << out;
-      fflush(stderr);
+      if (flush) fflush(stderr);
     }
 
     // Write to file without color codes
     if (fout_) {
       std::string file_out = hshm::Formatter::format(
-          "{}:{} {} {} {} {}\n", path, line, level, tid, func, msg);
+          "{}:{} {} {} {} {}\n", rec.path_, rec.line_, level, rec.tid_,
+          rec.func_, rec.msg_);
       fwrite(file_out.data(), 1, file_out.size(), fout_);
-      fflush(fout_);
+      if (flush) fflush(fout_);
     }
+  }
 
-    // Fatal errors terminate the program
-    if (LOG_CODE == kFatal) {
-      exit(1);
+  /**
+   * A forked child has no writer thread: fall back to synchronous output
+   * without touching locks the parent's writer may have held
+   */
+  void OnForkChild() {
+    if (async_on_.load()) {
+      async_on_.store(false);
+      async_->writer_.detach();
+    }
+  }
+
+  /** Monotonic timestamp used to merge per-thread rings */
+  static int64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  /** Retires the calling thread's ring when the thread exits */
+  struct RingHolder {
+    LogRing *ring_ = nullptr;
+    ~RingHolder() {
+      if (ring_ != nullptr) {
+        ring_->retired_.store(true, std::memory_order_release);
+      }
+    }
+  };
+
+  /** Serializes StartAsync and StopAsync */
+  static std::mutex &AsyncControlLock() {
+    static std::mutex lock;
+    return lock;
+  }
+
+  /** Ring of the calling thread, registered on first use */
+  LogRing &GetThreadRing() {
+    static thread_local RingHolder holder;
+    if (holder.ring_ == nullptr) {
+      auto ring = std::make_unique<LogRing>(async_->depth_);
+      holder.ring_ = ring.get();
+      std::lock_guard<std::mutex> lock(async_->rings_lock_);
+      async_->rings_.emplace_back(std::move(ring));
+    }
+    return *holder.ring_;
+  }
+
+  /** Sum of drops over live rings (rings_lock_ held) */
+  uint64_t CountRingDrops() const {
+    uint64_t total = 0;
+    for (const auto &ring : async_->rings_) {
+      total += ring->dropped_.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  /**
+   * Drain every ring once, write the batch in time order, and free rings
+   * whose threads have exited
+   * @return Number of records written
+   */
+  size_t AsyncDrainOnce(std::vector<LogRecord> &batch) {
+    batch.clear();
+    {
+      std::lock_guard<std::mutex> lock(async_->rings_lock_);
+      auto &rings = async_->rings_;
+      for (size_t i = 0; i < rings.size();) {
+        LogRing &ring = *rings[i];
+        // Check retirement before draining so no record is left behind
+        bool retired = ring.retired_.load(std::memory_order_acquire);
+        ring.Drain(batch);
+        if (retired && ring.Empty()) {
+          async_->dropped_retired_ +=
+              ring.dropped_.load(std::memory_order_relaxed);
+          rings[i] = std::move(rings.back());
+          rings.pop_back();
+        } else {
+          ++i;
+        }
+      }
+    }
+    if (batch.empty()) {
+      return 0;
+    }
+    // Sort (time, index) pairs: ADL would find hshm::swap for records.
+    // The index keeps each thread's records in push order on equal times.
+    std::vector<std::pair<int64_t, size_t>> order;
+    order.reserve(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+      order.emplace_back(batch[i].time_ns_, i);
+    }
+    std::sort(order.begin(), order.end());
+    for (const auto &entry : order) {
+      WriteRecord(batch[entry.second], false);
+    }
+    fflush(stdout);
+    fflush(stderr);
+    if (fout_) fflush(fout_);
+    return batch.size();
+  }
+
+  /** Report drops that happened since the last report */
+  void ReportDrops() {
+    uint64_t dropped = GetDroppedCount();
+    uint64_t &reported = async_->dropped_reported_;
+    if (dropped > reported) {
+      LogRecord rec;
+      rec.level_ = kWarning;
+      rec.path_ = __FILE__;
+      rec.line_ = __LINE__;
+      rec.tid_ = SystemInfo::GetTid();
+      rec.func_ = __func__;
+      rec.msg_ = hshm::Formatter::format(
+          "Async log rings full: dropped {} records ({} total)",
+          dropped - reported, dropped);
+      WriteRecord(rec, true);
+      reported = dropped;
     }
-#endif
   }
+
+  /** Body of the writer thread */
+  void AsyncWriterLoop() {
+    std::vector<LogRecord> batch;
+    while (!async_->stop_.load(std::memory_order_acquire)) {
+      if (AsyncDrainOnce(batch) == 0) {
+        ReportDrops();
+        std::this_thread::sleep_for(
+            std::chrono::microseconds(kAsyncIdleSleepUs));
+      }
+    }
+    // Producers may have seen async_on_ just before it was cleared
+    AsyncDrainOnce(batch);
+    ReportDrops();
+  }
+
+  std::atomic<bool> async_on_{false};
+  LogAsyncState *async_ = nullptr;  /**< Created by the first StartAsync */
 };
 
 }  // namespace hshm
@@ -139,6 +139,54 @@ ssize_t SendV(socket_t fd, const IoBuffer* iov, int count) {
   return sent;
 }
 
+int RecvExactV(socket_t fd, const IoBuffer* iov, int count) {
+  struct iovec local_iov[64];
+  int done = 0;
+  while (done < count) {
+    // Convert the next window of IoBuffers to iovecs for recvmsg
+    int local_count = (count - done) < 64 ? (count - done) : 64;
+    for (int i = 0; i < local_count; ++i) {
+      local_iov[i].iov_base = iov[done + i].base;
+      local_iov[i].iov_len = iov[done + i].len;
+    }
+    int iov_idx = 0;
+    while (iov_idx < local_count) {
+      if (local_iov[iov_idx].iov_len == 0) {
+        iov_idx++;
+        continue;
+      }
+      struct msghdr msg;
+      std::memset(&msg, 0, sizeof(msg));
+      msg.msg_iov = local_iov + iov_idx;
+      msg.msg_iovlen = static_cast<size_t>(local_count - iov_idx);
+      ssize_t n = ::recvmsg(fd, &msg, 0);
+      if (n < 0) {
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+          if (PollRead(fd, 1000) <= 0) return -1;
+          continue;
+        }
+        return -1;
+      }
+      if (n == 0) {
+        return -1;
+      }
+      while (iov_idx < local_count &&
+             n >= static_cast<ssize_t>(local_iov[iov_idx].iov_len)) {
+        n -= static_cast<ssize_t>(local_iov[iov_idx].iov_len);
+        iov_idx++;
+      }
+      if (iov_idx < local_count && n > 0) {
+        local_iov[iov_idx].iov_base =
+            static_cast<char*>(local_iov[iov_idx].iov_base) + n;
+        local_iov[iov_idx].iov_len -= n;
+      }
+    }
+    done += local_count;
+  }
+  return 0;
+}
+
 int RecvExact(socket_t fd, char* buf, size_t len) {
   size_t received = 0;
   while (received < len) {
@@ -149,6 +149,33 @@ ssize_t SendV(socket_t fd, const IoBuffer* iov, int count) {
   return static_cast<ssize_t>(total_sent);
 }
 
+int RecvExactV(socket_t fd, const IoBuffer* iov, int count) {
+  // Winsock has WSARecv scatter reads, but a short read per buffer keeps
+  // the partial-read bookkeeping simple and matches RecvExact semantics
+  for (int i = 0; i < count; ++i) {
+    size_t received = 0;
+    char* buf = static_cast<char*>(iov[i].base);
+    while (received < iov[i].len) {
+      int n = ::recv(fd, buf + received,
+                     static_cast<int>(iov[i].len - received), 0);
+      if (n == SOCKET_ERROR) {
+        int err = WSAGetLastError();
+        if (err == WSAEINTR) continue;
+        if (err == WSAEWOULDBLOCK) {
+          if (PollRead(fd, 1000) <= 0) return -1;
+          continue;
+        }
+        return -1;
+      }
+      if (n == 0) {
+        return -1;
+      }
+      received += static_cast<size_t>(n);
+    }
+  }
+  return 0;
+}
+
 int RecvExact(socket_t fd, char* buf, size_t len) {
   size_t received = 0;
   while (received < len) {
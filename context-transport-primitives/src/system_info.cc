@@ -36,6 +36,7 @@
 
 #include "hermes_shm/introspect/system_info.h"
 
+#include <algorithm>
 #include <climits>
 #ifdef __linux__
 #include <linux/limits.h>  // PATH_MAX on some Linux toolchains
@@ -47,6 +48,7 @@
 // LCOV_EXCL_STOP
 #include <cstdlib>
 #include <string>
+#include <vector>
 
 #include "hermes_shm/constants/macros.h"
 // MSan: inform sanitizer that mmap-backed memory is initialized by the kernel
@@ -71,12 +73,16 @@
 #include <sys/syscall.h>
 #if __linux__
 #include <sys/sysinfo.h>
+#include <sys/sysmacros.h>
 #else
 #include <sys/sysctl.h>
 #endif
 #include <sys/types.h>
 #include <unistd.h>
 #if __linux__
+#include <dirent.h>
+#include <sched.h>
+#include <linux/futex.h>
 #include <linux/memfd.h>
 #endif
 // WINDOWS
@@ -89,6 +95,75 @@
 
 namespace hshm {
 
+#if HSHM_ENABLE_PROCFS_SYSINFO && defined(__linux__)
+namespace {
+
+/** Linux mempolicy values (from <numaif.h>, which is not always installed) */
+constexpr int kMpolDefault = 0;
+constexpr int kMpolPreferred = 1;
+constexpr int kMpolBind = 2;
+constexpr int kMpolInterleave = 3;
+constexpr unsigned kMpolMfMove = 1u << 1;
+
+/** Nodes representable in the nodemask passed to mbind */
+constexpr int kMaxNumaNodes = 1024;
+constexpr int kMaskBits = 8 * sizeof(unsigned long);
+
+/** Parse a sysfs range list such as "0-3,8,10-11" */
+std::vector<int> ParseSysfsList(const std::string &list) {
+  std::vector<int> ids;
+  size_t pos = 0;
+  while (pos < list.size()) {
+    size_t end = list.find(',', pos);
+    if (end == std::string::npos) {
+      end = list.size();
+    }
+    std::string item = list.substr(pos, end - pos);
+    size_t dash = item.find('-');
+    try {
+      int lo = std::stoi(item.substr(0, dash));
+      int hi = dash == std::string::npos ? lo : std::stoi(item.substr(dash + 1));
+      for (int i = lo; i <= hi; ++i) {
+        ids.push_back(i);
+      }
+    } catch (const std::exception &) {
+      // Ignore malformed entries (e.g. trailing newline)
+    }
+    pos = end + 1;
+  }
+  return ids;
+}
+
+/** Read the first line of a sysfs file ("" if missing) */
+std::string ReadSysfsLine(const char *path) {
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+/** Apply an mbind() policy to the pages covering [ptr, ptr + size) */
+bool MbindRange(void *ptr, size_t size, int mode, const unsigned long *mask) {
+  size_t page = static_cast<size_t>(getpagesize());
+  size_t begin = reinterpret_cast<size_t>(ptr) & ~(page - 1);
+  size_t end = (reinterpret_cast<size_t>(ptr) + size + page - 1) & ~(page - 1);
+  long ret = syscall(SYS_mbind, begin, end - begin, mode, mask,
+                     kMaxNumaNodes + 1, kMpolMfMove);
+  return ret == 0;
+}
+
+/** log2 of a huge page size, as encoded by MFD_HUGE_* and MAP_HUGE_* */
+unsigned int HugePageShift(size_t huge_page_size) {
+  unsigned int shift = 0;
+  while ((size_t{1} << (shift + 1)) <= huge_page_size) {
+    ++shift;
+  }
+  return shift;
+}
+
+}  // namespace
+#endif
+
 void SystemInfo::RefreshCpuFreqKhz() {
 #if HSHM_IS_HOST
   for (int i = 0; i < ncpu_; ++i) {
@@ -218,6 +293,294 @@ int SystemInfo::GetCpuCount() {
 #endif
 }
 
+int SystemInfo::GetNumaNodeCount() {
+#if HSHM_ENABLE_PROCFS_SYSINFO && defined(__linux__)
+  std::vector<int> nodes =
+      ParseSysfsList(ReadSysfsLine("/sys/devices/system/node/online"));
+  return nodes.empty() ? 1 : nodes.back() + 1;
+#else
+  return 1;
+#endif
+}
+
+void SystemInfo::RefreshNumaTopology() {
+#if HSHM_IS_HOST
+  cpu_numa_node_.assign(ncpu_ > 0 ? ncpu_ : 0, 0);
+#if HSHM_ENABLE_PROCFS_SYSINFO && defined(__linux__)
+  for (int node = 0; node < numa_nodes_; ++node) {
+    char path[256];
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist",
+             node);
+    for (int cpu : ParseSysfsList(ReadSysfsLine(path))) {
+      if (cpu >= 0 && cpu < static_cast<int>(cpu_numa_node_.size())) {
+        cpu_numa_node_[cpu] = node;
+      }
+    }
+  }
+#endif
+#endif
+}
+
+int SystemInfo::GetNumaNodeOfCpu(int cpu) const {
+#if HSHM_IS_HOST
+  if (cpu < 0 || cpu >= static_cast<int>(cpu_numa_node_.size())) {
+    return 0;
+  }
+  return cpu_numa_node_[cpu];
+#else
+  (void)cpu;
+  return 0;
+#endif
+}
+
+int SystemInfo::GetCurrentNumaNode() const {
+#if HSHM_ENABLE_PROCFS_SYSINFO && defined(__linux__)
+  if (numa_nodes_ <= 1) {
+    return 0;
+  }
+  return GetNumaNodeOfCpu(sched_getcpu());
+#else
+  return 0;
+#endif
+}
+
+std::vector<int> SystemInfo::GetCpuSiblings(int cpu) {
+#if HSHM_ENABLE_PROCFS_SYSINFO && defined(__linux__)
+  char path[256];
+  snprintf(path, sizeof(path),
+           "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", cpu);
+  std::vector<int> siblings = ParseSysfsList(ReadSysfsLine(path));
+  if (!siblings.empty()) {
+    return siblings;
+  }
+#endif
+  return {cpu};
+}
+
+int SystemInfo::GetDeviceNumaNode(const std::string &dev_class,
+                                  const std::string &name) {
+#if HSHM_ENABLE_PROCFS_SYSINFO && defined(__linux__)
+  std::string path = "/sys/class/" + dev_class + "/" + name +
+                     "/device/numa_node";
+  std::string line = ReadSysfsLine(path.c_str());
+  try {
+    return line.empty() ? -1 : std::stoi(line);
+  } catch (const std::exception &) {
+    return -1;
+  }
+#else
+  (void)dev_class;
+  (void)name;
+  return -1;
+#endif
+}
+
+std::vector<int> SystemInfo::GetDeviceClassNumaNodes(
+    const std::string &dev_class) {
+  std::vector<int> nodes;
+#if HSHM_ENABLE_PROCFS_SYSINFO && defined(__linux__)
+  std::string dir_path = "/sys/class/" + dev_class;
+  DIR *dir = opendir(dir_path.c_str());
+  if (!dir) {
+    return nodes;
+  }
+  while (struct dirent *entry = readdir(dir)) {
+    if (entry->d_name[0] == '.') {
+      continue;
+    }
+    int node = GetDeviceNumaNode(dev_class, entry->d_name);
+    if (node >= 0) {
+      nodes.push_back(node);
+    }
+  }
+  closedir(dir);
+  std::sort(nodes.begin(), nodes.end());
+  nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+#else
+  (void)dev_class;
+#endif
+  return nodes;
+}
+
+std::vector<int> SystemInfo::GetGpuNumaNodes() {
+  std::vector<int> nodes;
+#if HSHM_ENABLE_PROCFS_SYSINFO && defined(__linux__)
+  const std::string pci = "/sys/bus/pci/devices/";
+  DIR *dir = opendir(pci.c_str());
+  if (!dir) {
+    return nodes;
+  }
+  while (struct dirent *entry = readdir(dir)) {
+    if (entry->d_name[0] == '.') {
+      continue;
+    }
+    std::string dev = pci + entry->d_name;
+    // PCI class 0x03xxxx is a display controller
+    std::string pci_class = ReadSysfsLine((dev + "/class").c_str());
+    std::string vendor = ReadSysfsLine((dev + "/vendor").c_str());
+    if (pci_class.compare(0, 4, "0x03") != 0 ||
+        (vendor != "0x10de" && vendor != "0x1002")) {
+      continue;
+    }
+    try {
+      int node = std::stoi(ReadSysfsLine((dev + "/numa_node").c_str()));
+      if (node >= 0) {
+        nodes.push_back(node);
+      }
+    } catch (const std::exception &) {
+    }
+  }
+  closedir(dir);
+  std::sort(nodes.begin(), nodes.end());
+  nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+#endif
+  return nodes;
+}
+
+int SystemInfo::GetPathNumaNode(const std::string &path) {
+#if HSHM_ENABLE_PROCFS_SYSINFO && defined(__linux__)
+  struct stat st;
+  std::string probe = path.empty() ? "." : path;
+  while (stat(probe.c_str(), &st) != 0) {
+    size_t slash = probe.find_last_of('/');
+    if (slash == std::string::npos) {
+      probe = ".";
+    } else if (slash == 0) {
+      probe = "/";
+    } else {
+      probe.resize(slash);
+      continue;
+    }
+    if (stat(probe.c_str(), &st) != 0) {
+      return -1;
+    }
+    break;
+  }
+  // Device files (e.g. /dev/nvme0n1, /dev/ng0n1) name the device itself;
+  // any other file lives on the device of its file system
+  bool is_dev = S_ISBLK(st.st_mode) || S_ISCHR(st.st_mode);
+  dev_t dev = is_dev ? st.st_rdev : st.st_dev;
+  std::string sys = std::string("/sys/dev/") +
+                    (S_ISCHR(st.st_mode) ? "char/" : "block/") +
+                    std::to_string(major(dev)) + ":" +
+                    std::to_string(minor(dev));
+  // A partition's bus is its disk's; an NVMe namespace's is its controller's
+  for (const char *rel : {"/device/numa_node", "/../device/numa_node",
+                          "/device/device/numa_node",
+                          "/../device/device/numa_node"}) {
+    std::string line = ReadSysfsLine((sys + rel).c_str());
+    try {
+      int node = line.empty() ? -1 : std::stoi(line);
+      if (node >= 0) {
+        return node;
+      }
+    } catch (const std::exception &) {
+    }
+  }
+  return -1;
+#else
+  (void)path;
+  return -1;
+#endif
+}
+
+bool SystemInfo::PinThreadToCpu(int cpu) {
+#if HSHM_ENABLE_PROCFS_SYSINFO && defined(__linux__)
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(cpu, &cpuset);
+  return sched_setaffinity(0, sizeof(cpuset), &cpuset) == 0;
+#else
+  (void)cpu;
+  return false;
+#endif
+}
+
+bool SystemInfo::BindMemoryToNumaNode(void *ptr, size_t size, int node,
+                                      bool strict) {
+#if HSHM_ENABLE_PROCFS_SYSINFO && defined(__linux__) && defined(SYS_mbind)
+  if (node < 0 || node >= kMaxNumaNodes || size == 0) {
+    return false;
+  }
+  unsigned long mask[kMaxNumaNodes / kMaskBits] = {};
+  mask[node / kMaskBits] |= 1UL << (node % kMaskBits);
+  return MbindRange(ptr, size, strict ? kMpolBind : kMpolPreferred, mask);
+#else
+  (void)ptr;
+  (void)size;
+  (void)node;
+  (void)strict;
+  return false;
+#endif
+}
+
+bool SystemInfo::InterleaveMemory(void *ptr, size_t size) {
+#if HSHM_ENABLE_PROCFS_SYSINFO && defined(__linux__) && defined(SYS_mbind)
+  if (size == 0) {
+    return false;
+  }
+  unsigned long mask[kMaxNumaNodes / kMaskBits] = {};
+  for (int node : ParseSysfsList(
+           ReadSysfsLine("/sys/devices/system/node/online"))) {
+    if (node >= 0 && node < kMaxNumaNodes) {
+      mask[node / kMaskBits] |= 1UL << (node % kMaskBits);
+    }
+  }
+  return MbindRange(ptr, size, kMpolInterleave, mask);
+#else
+  (void)ptr;
+  (void)size;
+  return false;
+#endif
+}
+
+bool SystemInfo::SetThreadNumaPreference(int node) {
+#if HSHM_ENABLE_PROCFS_SYSINFO && defined(__linux__) && \
+    defined(SYS_set_mempolicy)
+  if (node < 0) {
+    return syscall(SYS_set_mempolicy, kMpolDefault, nullptr, 0) == 0;
+  }
+  if (node >= kMaxNumaNodes) {
+    return false;
+  }
+  unsigned long mask[kMaxNumaNodes / kMaskBits] = {};
+  mask[node / kMaskBits] |= 1UL << (node % kMaskBits);
+  return syscall(SYS_set_mempolicy, kMpolPreferred, mask,
+                 kMaxNumaNodes + 1) == 0;
+#else
+  (void)node;
+  return false;
+#endif
+}
+
+bool SystemInfo::PrefaultMemory(void *ptr, size_t size) {
+#if HSHM_ENABLE_PROCFS_SYSINFO && defined(__linux__)
+  if (ptr == nullptr || size == 0) {
+    return false;
+  }
+  size_t page = static_cast<size_t>(getpagesize());
+  size_t begin = reinterpret_cast<size_t>(ptr) & ~(page - 1);
+  size_t end = (reinterpret_cast<size_t>(ptr) + size + page - 1) & ~(page - 1);
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23  // Linux 5.14+
+#endif
+  if (madvise(reinterpret_cast<void *>(begin), end - begin,
+              MADV_POPULATE_WRITE) == 0) {
+    return true;
+  }
+  // Older kernels: an atomic add of zero write-faults the page without
+  // racing with concurrent writers
+  for (size_t addr = begin; addr < end; addr += page) {
+    __atomic_fetch_add(reinterpret_cast<char *>(addr), 0, __ATOMIC_RELAXED);
+  }
+  return true;
+#else
+  (void)ptr;
+  (void)size;
+  return false;
+#endif
+}
+
 int SystemInfo::GetPageSize() {
 #if HSHM_ENABLE_PROCFS_SYSINFO
   return getpagesize();
@@ -364,6 +727,35 @@ void SystemInfo::YieldThread() {
 #endif
 }
 
+void SystemInfo::FutexWait(void *addr, u32 expected, u32 timeout_us) {
+#if HSHM_ENABLE_PROCFS_SYSINFO && defined(__linux__)
+  // No FUTEX_PRIVATE_FLAG: the word lives in shared memory and the waker
+  // may be another process
+  struct timespec ts;
+  struct timespec *tsp = nullptr;
+  if (timeout_us > 0) {
+    ts.tv_sec = timeout_us / 1000000;
+    ts.tv_nsec = static_cast<long>(timeout_us % 1000000) * 1000;
+    tsp = &ts;
+  }
+  syscall(SYS_futex, addr, FUTEX_WAIT, expected, tsp, nullptr, 0);
+#else
+  (void)addr;
+  (void)expected;
+  (void)timeout_us;
+  YieldThread();
+#endif
+}
+
+void SystemInfo::FutexWake(void *addr, int count) {
+#if HSHM_ENABLE_PROCFS_SYSINFO && defined(__linux__)
+  syscall(SYS_futex, addr, FUTEX_WAKE, count, nullptr, nullptr, 0);
+#else
+  (void)addr;
+  (void)count;
+#endif
+}
+
 bool SystemInfo::CreateTls(ThreadLocalKey &key, void *data) {
 #if HSHM_ENABLE_PROCFS_SYSINFO
   int ret = pthread_key_create(&key.pthread_key_, nullptr);
@@ -419,10 +811,18 @@ void SystemInfo::EnsureMemfdDir() {
 }
 
 bool SystemInfo::CreateNewSharedMemory(File &fd, const std::string &name,
-                                       size_t size) {
+                                       size_t size, size_t huge_page_size) {
 #if HSHM_ENABLE_PROCFS_SYSINFO
 #if __linux__
-  fd.posix_fd_ = memfd_create(name.c_str(), 0);
+  unsigned int memfd_flags = 0;
+  if (huge_page_size != 0) {
+#ifdef MFD_HUGETLB
+    memfd_flags = MFD_HUGETLB | (HugePageShift(huge_page_size) << 26);
+#else
+    return false;
+#endif
+  }
+  fd.posix_fd_ = memfd_create(name.c_str(), memfd_flags);
   if (fd.posix_fd_ < 0) {
     return false;
   }
@@ -442,6 +842,9 @@ bool SystemInfo::CreateNewSharedMemory(File &fd, const std::string &name,
   }
   return true;
 #else
+  if (huge_page_size != 0) {
+    return false;
+  }
   fd.posix_fd_ = shm_open(name.c_str(), O_CREAT | O_RDWR, 0666);
   if (fd.posix_fd_ < 0) {
     return false;
@@ -454,6 +857,9 @@ bool SystemInfo::CreateNewSharedMemory(File &fd, const std::string &name,
   return true;
 #endif
 #elif HSHM_ENABLE_WINDOWS_SYSINFO
+  if (huge_page_size != 0) {
+    return false;
+  }
   fd.windows_fd_ =
       CreateFileMapping(INVALID_HANDLE_VALUE,  // use paging file
                         nullptr,               // default security
@@ -523,6 +929,45 @@ void *SystemInfo::MapPrivateMemory(size_t size) {
 #endif
 }
 
+void *SystemInfo::MapHugePrivateMemory(size_t size, size_t huge_page_size) {
+#if HSHM_ENABLE_PROCFS_SYSINFO && defined(MAP_HUGETLB)
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB |
+              static_cast<int>(HugePageShift(huge_page_size) << 26);
+  void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+  if (ptr == MAP_FAILED) {
+    return nullptr;
+  }
+  HSHM_MSAN_UNPOISON(ptr, size);
+  return ptr;
+#else
+  (void)size;
+  (void)huge_page_size;
+  return nullptr;
+#endif
+}
+
+bool SystemInfo::AdviseHugePages(void *ptr, size_t size) {
+#if HSHM_ENABLE_PROCFS_SYSINFO && defined(MADV_HUGEPAGE)
+  return madvise(ptr, size, MADV_HUGEPAGE) == 0;
+#else
+  (void)ptr;
+  (void)size;
+  return false;
+#endif
+}
+
+size_t SystemInfo::GetSharedMemoryPageSize(const File &fd) {
+#if HSHM_ENABLE_PROCFS_SYSINFO
+  struct stat st;
+  if (fstat(fd.posix_fd_, &st) == 0 && st.st_blksize > 0) {
+    return static_cast<size_t>(st.st_blksize);
+  }
+#else
+  (void)fd;
+#endif
+  return 4096;
+}
+
 void *SystemInfo::MapSharedMemory(const File &fd, size_t size, i64 off) {
 #if HSHM_ENABLE_PROCFS_SYSINFO
   void *ptr = mmap64(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
@@ -556,6 +1001,23 @@ void *SystemInfo::MapSharedMemory(const File &fd, size_t size, i64 off) {
 #endif
 }
 
+void *SystemInfo::MapSharedMemoryReadOnly(const File &fd, size_t size,
+                                          i64 off) {
+#if HSHM_ENABLE_PROCFS_SYSINFO
+  void *ptr = mmap64(nullptr, size, PROT_READ, MAP_SHARED, fd.posix_fd_, off);
+  if (ptr == MAP_FAILED) {
+    return nullptr;
+  }
+  HSHM_MSAN_UNPOISON(ptr, size);
+  return ptr;
+#elif HSHM_ENABLE_WINDOWS_SYSINFO
+  DWORD highDword = (DWORD)((off >> 32) & 0xFFFFFFFF);
+  DWORD lowDword = (DWORD)(off & 0xFFFFFFFF);
+  return MapViewOfFile(fd.windows_fd_, FILE_MAP_READ, highDword, lowDword,
+                       size);
+#endif
+}
+
 void SystemInfo::UnmapMemory(void *ptr, size_t size) {
 #if HSHM_ENABLE_PROCFS_SYSINFO
   munmap(ptr, size);
@@ -578,3 +578,96 @@ TEST_CASE("BuddyAllocator Regression - Fix7and8: AllocateSmall finds larger free
     alloc->Free(p);
   }
 }
+
+/**
+ * Large extents: allocations above the 1MB size class are page-granular,
+ * page-aligned, and coalesce with free neighbors so a later allocation can
+ * reuse the merged space instead of growing the heap.
+ */
+TEST_CASE("BuddyAllocator - Large extents coalesce and reuse space",
+          "[BuddyAllocator][large_extent]") {
+  hipc::MallocBackend backend;
+  constexpr size_t kAllocSize = sizeof(hipc::BuddyAllocator);
+  constexpr size_t kHeapSize = 256UL * 1024UL * 1024UL;  // 256 MB
+  backend.shm_init(hipc::MemoryBackendId(0, 0), kAllocSize + kHeapSize);
+  auto *alloc = backend.MakeAlloc<hipc::BuddyAllocator>();
+
+  constexpr size_t k1MB = 1024UL * 1024UL;
+  constexpr size_t kPage = 4096;
+  constexpr size_t kBuddyPageHdr = 16;
+  std::vector<hipc::FullPtr<char>> ptrs;
+  for (int i = 0; i < 4; ++i) {
+    auto p = alloc->template Allocate<char>(16 * k1MB);
+    REQUIRE_FALSE(p.IsNull());
+    // Extent headers start on a page boundary
+    REQUIRE(reinterpret_cast<size_t>(p.ptr_ - kBuddyPageHdr) % kPage == 0);
+    std::memset(p.ptr_, 0x10 + i, 16 * k1MB);
+    ptrs.push_back(p);
+  }
+  REQUIRE(alloc->GetFreeExtentCount() == 0);
+
+  // Free two non-adjacent extents, then the one between them
+  alloc->Free(ptrs[0]);
+  alloc->Free(ptrs[2]);
+  REQUIRE(alloc->GetFreeExtentCount() == 2);
+  alloc->Free(ptrs[1]);
+  REQUIRE(alloc->GetFreeExtentCount() == 1);
+  REQUIRE(alloc->GetFreeExtentBytes() >= 48 * k1MB);
+
+  // A 40MB request fits only in the merged extent
+  auto merged = alloc->template Allocate<char>(40 * k1MB);
+  REQUIRE_FALSE(merged.IsNull());
+  REQUIRE(merged.ptr_ == ptrs[0].ptr_);
+  std::memset(merged.ptr_, 0x5A, 40 * k1MB);
+
+  // The surviving neighbor is untouched
+  for (size_t off = 0; off < 16 * k1MB; off += kPage) {
+    REQUIRE(ptrs[3].ptr_[off] == 0x13);
+  }
+
+  alloc->Free(merged);
+  alloc->Free(ptrs[3]);
+  REQUIRE(alloc->GetFreeExtentCount() == 1);
+}
+
+/**
+ * Large extents: the best-fit tree hands out the smallest free extent that
+ * satisfies a request, and the split-off tail stays allocatable.
+ */
+TEST_CASE("BuddyAllocator - Large extents use best fit",
+          "[BuddyAllocator][large_extent]") {
+  hipc::MallocBackend backend;
+  constexpr size_t kAllocSize = sizeof(hipc::BuddyAllocator);
+  constexpr size_t kHeapSize = 256UL * 1024UL * 1024UL;  // 256 MB
+  backend.shm_init(hipc::MemoryBackendId(0, 0), kAllocSize + kHeapSize);
+  auto *alloc = backend.MakeAlloc<hipc::BuddyAllocator>();
+
+  constexpr size_t k1MB = 1024UL * 1024UL;
+  auto big = alloc->template Allocate<char>(64 * k1MB);
+  auto sep1 = alloc->template Allocate<char>(2 * k1MB);
+  auto small = alloc->template Allocate<char>(20 * k1MB);
+  auto sep2 = alloc->template Allocate<char>(2 * k1MB);
+  REQUIRE_FALSE(big.IsNull());
+  REQUIRE_FALSE(sep1.IsNull());
+  REQUIRE_FALSE(small.IsNull());
+  REQUIRE_FALSE(sep2.IsNull());
+
+  alloc->Free(big);
+  alloc->Free(small);
+  REQUIRE(alloc->GetFreeExtentCount() == 2);
+
+  // 18MB fits both free extents; best fit picks the 20MB one
+  auto fit = alloc->template Allocate<char>(18 * k1MB);
+  REQUIRE(fit.ptr_ == small.ptr_);
+  std::memset(fit.ptr_, 0x3C, 18 * k1MB);
+
+  // The 64MB extent is still whole
+  auto whole = alloc->template Allocate<char>(64 * k1MB);
+  REQUIRE(whole.ptr_ == big.ptr_);
+  std::memset(whole.ptr_, 0x4D, 64 * k1MB);
+
+  alloc->Free(whole);
+  alloc->Free(fit);
+  alloc->Free(sep1);
+  alloc->Free(sep2);
+}
@@ -129,3 +129,40 @@ TEST_CASE("ProducerConsumerAllocator - Multi-threaded Random", "[ProducerConsume
 
   alloc->shm_detach();
 }
+
+TEST_CASE("ProducerConsumerAllocator - Cross-thread Free", "[ProducerConsumerAllocator][multithread]") {
+  // Far less memory than the total allocated over all rounds: blocks freed
+  // by the consumer thread must flow back to the producer's thread block
+  hipc::PosixMmap backend;
+  size_t heap_size = 64 * 1024 * 1024;  // 64 MB heap
+  size_t alloc_size = sizeof(hipc::ProducerConsumerAllocator);
+  backend.shm_init(hipc::MemoryBackendId(0, 0), alloc_size + heap_size);
+
+  auto *alloc = backend.MakeAlloc<hipc::ProducerConsumerAllocator>();
+
+  constexpr size_t kRounds = 64;
+  constexpr size_t kBatch = 1000;
+  constexpr size_t kSize = 4096;
+  for (size_t round = 0; round < kRounds; ++round) {
+    std::vector<hipc::FullPtr<char>> ptrs;
+    ptrs.reserve(kBatch);
+    for (size_t i = 0; i < kBatch; ++i) {
+      auto ptr = alloc->Allocate<char>(kSize);
+      REQUIRE_FALSE(ptr.IsNull());
+      memset(ptr.ptr_, static_cast<int>(round & 0xFF), kSize);
+      ptrs.push_back(ptr);
+    }
+
+    bool intact = true;
+    std::thread consumer([&]() {
+      for (auto &ptr : ptrs) {
+        intact &= ptr.ptr_[kSize - 1] == static_cast<char>(round & 0xFF);
+        alloc->Free(ptr);
+      }
+    });
+    consumer.join();
+    REQUIRE(intact);
+  }
+
+  alloc->shm_detach();
+}
@@ -48,3 +48,49 @@ TEST_CASE("BackendReserve") {
 
   // Destroy SHMEM
 }
+
+TEST_CASE("BackendNumaBind") {
+  PosixShmMmap b1;
+  REQUIRE(b1.shm_init(hipc::MemoryBackendId::GetRoot(),
+                      hshm::Unit<size_t>::Megabytes(16), "shmem_numa_test"));
+
+  // Out-of-range sub-ranges are rejected
+  REQUIRE_FALSE(b1.BindNumaNode(0, b1.data_capacity_));
+
+#ifdef __linux__
+  // Node 0 always exists; binding a sub-range and interleaving succeed
+  if (access("/sys/devices/system/node/online", F_OK) == 0) {
+    REQUIRE(b1.BindNumaNode(0, hshm::Unit<size_t>::Megabytes(1),
+                            hshm::Unit<size_t>::Megabytes(4)));
+    REQUIRE(b1.InterleaveNumaNodes());
+  }
+#endif
+
+  // The mapping stays usable after a policy change
+  memset(b1.data_, 1, hshm::Unit<size_t>::Megabytes(8));
+  REQUIRE(b1.data_[hshm::Unit<size_t>::Megabytes(8) - 1] == 1);
+  b1.shm_destroy();
+}
+
+TEST_CASE("BackendHugePages") {
+  // 2MB hugetlb falls back to transparent huge pages when the pool is empty;
+  // either way the segment is one huge-page-aligned mapping
+  PosixShmMmap b1;
+  REQUIRE(b1.shm_init(hipc::MemoryBackendId::GetRoot(),
+                      hshm::Unit<size_t>::Megabytes(3), "shmem_huge_test",
+                      hipc::HugePageMode::k2MB));
+  REQUIRE(b1.IsHugePaged());
+  REQUIRE(b1.backend_size_ % hipc::GetHugePageSize(hipc::HugePageMode::k2MB) == 0);
+  REQUIRE(b1.data_ == reinterpret_cast<char *>(b1.header_) +
+                        hipc::kBackendHeaderSize);
+  memset(b1.data_, 7, b1.data_capacity_);
+
+  // A second mapping of the segment sees the same header and data
+  PosixShmMmap b2;
+  REQUIRE(b2.shm_attach("shmem_huge_test"));
+  REQUIRE(b2.IsHugePaged());
+  REQUIRE(b2.backend_size_ == b1.backend_size_);
+  REQUIRE(b2.data_[b2.data_capacity_ - 1] == 7);
+  b2.shm_detach();
+  b1.shm_destroy();
+}
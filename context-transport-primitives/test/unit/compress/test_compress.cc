@@ -33,7 +33,10 @@
 
 #include "basic_test.h"
 #include "hermes_shm/compress/compress_factory.h"
+#include <algorithm>
+#include <thread>
 #include <utility>
+#include <vector>
 
 TEST_CASE("TestCompress") {
   std::string raw = "Hello, World!";
@@ -130,3 +133,66 @@ TEST_CASE("TestCompress") {
     REQUIRE(raw == std::string(decompressed.data(), raw_size));
   }
 }
+
+/** Stream a buffer through a compressor in blocks and return the output */
+static std::vector<char> StreamCompress(hshm::Compressor &compressor,
+                                        const std::vector<char> &raw,
+                                        size_t block_size) {
+  std::vector<char> out;
+  std::vector<char> buf(raw.size() + raw.size() / 2 + 4096);
+  REQUIRE(compressor.BeginStream());
+  for (size_t off = 0; off < raw.size(); off += block_size) {
+    size_t len = std::min(block_size, raw.size() - off);
+    size_t out_size = buf.size();
+    REQUIRE(compressor.Update(buf.data(), out_size, raw.data() + off, len));
+    out.insert(out.end(), buf.data(), buf.data() + out_size);
+  }
+  size_t out_size = buf.size();
+  REQUIRE(compressor.Finish(buf.data(), out_size));
+  out.insert(out.end(), buf.data(), buf.data() + out_size);
+  return out;
+}
+
+TEST_CASE("TestStreamCompress") {
+  std::vector<char> raw(1 << 20);
+  for (size_t i = 0; i < raw.size(); ++i) {
+    raw[i] = static_cast<char>((i / 64) % 17 + (i % 3));
+  }
+
+  for (const char *lib : {"zstd", "lz4", "zlib", "lzma", "brotli", "bzip2",
+                          "snappy", "blosc2"}) {
+    auto compressor =
+        hshm::CompressionFactory::GetPreset(lib, hshm::CompressionPreset::FAST);
+    REQUIRE(compressor != nullptr);
+    // Stream twice so the reused stream state is exercised
+    for (int round = 0; round < 2; ++round) {
+      std::vector<char> cmpr = StreamCompress(*compressor, raw, 64 * 1024);
+      std::vector<char> decompressed(raw.size());
+      size_t raw_size = decompressed.size();
+      REQUIRE(compressor->Decompress(decompressed.data(), raw_size,
+                                     cmpr.data(), cmpr.size()));
+      REQUIRE(raw_size == raw.size());
+      REQUIRE(decompressed == raw);
+    }
+  }
+}
+
+TEST_CASE("TestThreadLocalCompressor") {
+  hshm::Compressor *zstd = hshm::CompressionFactory::GetThreadLocal(
+      "zstd", hshm::CompressionPreset::FAST);
+  REQUIRE(zstd != nullptr);
+  REQUIRE(zstd == hshm::CompressionFactory::GetThreadLocal(
+                      "ZSTD", hshm::CompressionPreset::FAST));
+  REQUIRE(zstd != hshm::CompressionFactory::GetThreadLocal(
+                      "zstd", hshm::CompressionPreset::BEST));
+  REQUIRE(hshm::CompressionFactory::GetThreadLocal("unknown") == nullptr);
+
+  hshm::Compressor *other = nullptr;
+  std::thread worker([&other]() {
+    other = hshm::CompressionFactory::GetThreadLocal(
+        "zstd", hshm::CompressionPreset::FAST);
+  });
+  worker.join();
+  REQUIRE(other != nullptr);
+  REQUIRE(other != zstd);
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "basic_test.h"
+#include "hermes_shm/compress/data_stats.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+/** Smooth signal with plateaus, so runs and derivatives are non-trivial */
+template <typename T>
+static std::vector<T> MakeSignal(size_t num_elements) {
+  std::vector<T> data(num_elements);
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> noise(0, 3);
+  for (size_t i = 0; i < num_elements; ++i) {
+    double value = 50.0 + 40.0 * std::sin(static_cast<double>(i / 8) * 0.05);
+    data[i] = static_cast<T>(value + noise(gen));
+  }
+  return data;
+}
+
+template <typename T>
+static void CheckFusedMatchesSeparate(size_t num_elements) {
+  using Stats = hshm::DataStatistics<T>;
+  std::vector<T> data = MakeSignal<T>(num_elements);
+  const T *ptr = data.data();
+  hshm::CompressionFeatureSet all = Stats::CalculateAllFeatures(ptr, num_elements);
+
+  auto close = [](double expected) {
+    return Catch::Approx(expected).epsilon(1e-9).margin(1e-9);
+  };
+  REQUIRE(all.shannon_entropy == close(Stats::CalculateShannonEntropy(ptr, num_elements)));
+  REQUIRE(all.mad == close(Stats::CalculateMAD(ptr, num_elements)));
+  REQUIRE(all.first_derivative == close(Stats::CalculateFirstDerivative(ptr, num_elements)));
+  REQUIRE(all.second_derivative ==
+          close(Stats::CalculateSecondDerivative(ptr, num_elements)));
+  REQUIRE(all.byte_frequency_variance ==
+          close(Stats::CalculateByteFrequencyVariance(ptr, num_elements)));
+  REQUIRE(all.zero_ratio == close(Stats::CalculateZeroRatio(ptr, num_elements)));
+  REQUIRE(all.max_run_length == Stats::CalculateMaxRunLength(ptr, num_elements));
+}
+
+TEST_CASE("DataStatistics - Fused Features Match Separate Passes") {
+  // Sizes below, at and across the tile and SIMD widths
+  for (size_t num_elements : {1, 2, 3, 7, 64, 4097, 100003}) {
+    CheckFusedMatchesSeparate<uint8_t>(num_elements);
+    CheckFusedMatchesSeparate<int32_t>(num_elements);
+    CheckFusedMatchesSeparate<float>(num_elements);
+    CheckFusedMatchesSeparate<double>(num_elements);
+  }
+  hshm::CompressionFeatureSet empty =
+      hshm::DataStatistics<float>::CalculateAllFeatures(nullptr, 0);
+  REQUIRE(empty.shannon_entropy == 0.0);
+  REQUIRE(empty.max_run_length == 0);
+}
+
+TEST_CASE("DataStatistics - Bundle And Factory Use Fused Pass") {
+  std::vector<float> data = MakeSignal<float>(10000);
+  std::vector<double> bundle = hshm::DataStatisticsFactory::CalculateCompressionFeatures(
+      data.data(), data.size(), hshm::DataType::FLOAT32);
+  hshm::CompressionFeatureSet all = hshm::DataStatisticsFactory::CalculateAllFeatures(
+      data.data(), data.size(), hshm::DataType::FLOAT32);
+  REQUIRE(bundle.size() == 4);
+  REQUIRE(bundle[0] == all.shannon_entropy);
+  REQUIRE(bundle[1] == all.mad);
+  REQUIRE(bundle[2] == all.zero_ratio);
+  REQUIRE(bundle[3] == all.first_derivative);
+}
+
+TEST_CASE("BlockSampler - Sampled Features") {
+  std::vector<float> data = MakeSignal<float>(1 << 20);
+  hshm::CompressionFeatureSet full =
+      hshm::DataStatistics<float>::CalculateAllFeatures(data.data(), data.size());
+
+  // Blocks covering the buffer fall back to the exact scan
+  hshm::CompressionFeatureSet covered = hshm::BlockSampler<float>::SampleFeatures(
+      data.data(), 1000, 16, 4096, 1);
+  hshm::CompressionFeatureSet exact =
+      hshm::DataStatistics<float>::CalculateAllFeatures(data.data(), 1000);
+  REQUIRE(covered.mad == exact.mad);
+
+  // A stationary signal is estimated closely from 64 of 256 blocks
+  hshm::CompressionFeatureSet sampled = hshm::BlockSamplerFactory::SampleFeatures(
+      data.data(), data.size(), hshm::DataType::FLOAT32, 64, 4096, 1);
+  REQUIRE(sampled.shannon_entropy == Catch::Approx(full.shannon_entropy).epsilon(0.05));
+  REQUIRE(sampled.mad == Catch::Approx(full.mad).epsilon(0.1));
+  REQUIRE(sampled.first_derivative == Catch::Approx(full.first_derivative).epsilon(0.1));
+}
+
+TEST_CASE("DataStatistics - Sampled Byte Entropy") {
+  using Stats = hshm::DataStatistics<uint8_t>;
+  std::vector<uint8_t> random(1 << 20);
+  std::mt19937 gen(11);
+  for (auto &b : random) {
+    b = static_cast<uint8_t>(gen());
+  }
+  // Random bytes read as incompressible from 4KB
+  REQUIRE(Stats::SampleByteEntropy(random.data(), random.size(), 4, 1024) >
+          7.9);
+
+  std::vector<uint8_t> signal = MakeSignal<uint8_t>(1 << 20);
+  REQUIRE(Stats::SampleByteEntropy(signal.data(), signal.size(), 4, 1024) <
+          7.0);
+
+  // Blocks covering the buffer give the exact entropy
+  REQUIRE(Stats::SampleByteEntropy(signal.data(), 3000, 4, 1024) ==
+          Catch::Approx(Stats::CalculateShannonEntropy(signal.data(), 3000)));
+  REQUIRE(Stats::SampleByteEntropy(signal.data(), 0) == 0.0);
+}
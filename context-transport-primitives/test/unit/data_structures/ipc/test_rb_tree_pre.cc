@@ -710,3 +710,37 @@ TEST_CASE("rb_tree_pre - String Keys", "[rb_tree_pre][string_keys]") {
     REQUIRE(tree.size() == keys.size() - 1);
   }
 }
+
+TEST_CASE("rb_tree_pre - Lower Bound", "[rb_tree_pre][lower_bound]") {
+  MallocBackend backend;
+  size_t arena_size = 10 * 1024 * 1024;
+  auto *alloc = CreateTestAllocator<false>(backend, arena_size);
+
+  SECTION("Smallest key not less than the query") {
+    pre::rb_tree<TestRBNode<int>, false> tree;
+    tree.Init();
+    REQUIRE(tree.lower_bound(alloc, 0).IsNull());
+
+    // Insert 10, 20, ..., 100 in shuffled order
+    std::vector<int> keys = {50, 20, 80, 10, 30, 70, 90, 40, 60, 100};
+    for (int k : keys) {
+      auto node_ptr = alloc->Allocate<TestRBNode<int>>(sizeof(TestRBNode<int>));
+      new (node_ptr.ptr_) TestRBNode<int>(k, k * 2);
+      hipc::ShmPtrBase<TestRBNode<int>> test_shm(node_ptr.shm_.alloc_id_, node_ptr.shm_.off_.load());
+      FullPtr<TestRBNode<int>> test_ptr(alloc, test_shm);
+      test_ptr.ptr_ = node_ptr.ptr_;
+      tree.emplace(alloc, test_ptr);
+    }
+
+    REQUIRE(tree.lower_bound(alloc, 1).ptr_->key == 10);
+    REQUIRE(tree.lower_bound(alloc, 10).ptr_->key == 10);
+    REQUIRE(tree.lower_bound(alloc, 11).ptr_->key == 20);
+    REQUIRE(tree.lower_bound(alloc, 55).ptr_->key == 60);
+    REQUIRE(tree.lower_bound(alloc, 100).ptr_->value_ == 200);
+    REQUIRE(tree.lower_bound(alloc, 101).IsNull());
+
+    // Removing the match moves the bound to the next key
+    tree.pop(alloc, 60);
+    REQUIRE(tree.lower_bound(alloc, 55).ptr_->key == 70);
+  }
+}
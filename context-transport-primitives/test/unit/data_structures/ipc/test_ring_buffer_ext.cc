@@ -153,4 +153,27 @@ TEST_CASE("Extensible RingBuffer: FIFO ordering", "[ring_buffer][ext]") {
 
 }
 
+TEST_CASE("Extensible RingBuffer: batched push refused when full",
+          "[ring_buffer][ext]") {
+  MallocBackend backend;
+  auto *alloc = CreateTestAllocator(backend, 1024 * 1024);
+
+  ext_ring_buffer<int, ArenaAllocator<false>> rb(alloc, 8);
+
+  // Batches do not grow the ring: one that does not fit is refused whole
+  int vals[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+  REQUIRE(rb.PushBatch(vals, 6) == 6);
+  REQUIRE(rb.PushBatch(vals, 3) == 0);
+  REQUIRE(rb.Size() == 6);
+  REQUIRE(rb.PushBatch(vals + 6, 2) == 2);
+
+  for (int i = 0; i < 8; ++i) {
+    int val;
+    REQUIRE(rb.Pop(val));
+    REQUIRE(val == i);
+  }
+  REQUIRE(rb.Empty());
+  REQUIRE(rb.PushBatch(vals, 8) == 8);
+}
+
 SIMPLE_TEST_MAIN()
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "../../../context-runtime/test/simple_test.h"
+#include "hermes_shm/data_structures/ipc/mpmc_ring_buffer.h"
+#include "hermes_shm/memory/backend/malloc_backend.h"
+#include "hermes_shm/memory/allocator/arena_allocator.h"
+#include <thread>
+#include <atomic>
+#include <vector>
+
+using namespace hshm::ipc;
+
+/**
+ * Helper function to create an ArenaAllocator for testing
+ */
+ArenaAllocator<false>* CreateTestAllocator(MallocBackend &backend,
+                                           size_t arena_size) {
+  backend.shm_init(MemoryBackendId(0, 0), arena_size);
+  return backend.MakeAlloc<ArenaAllocator<false>>();
+}
+
+// ============================================================================
+// MPMC Ring Buffer Tests (Multiple Producer Multiple Consumer)
+// ============================================================================
+
+TEST_CASE("MPMC RingBuffer: FIFO and capacity", "[ring_buffer][mpmc]") {
+  MallocBackend backend;
+  auto *alloc = CreateTestAllocator(backend, 1024 * 1024);
+
+  // Depth rounds up to a power of two and every slot is usable
+  mpmc_ring_buffer<int, ArenaAllocator<false>> rb(alloc, 50);
+  REQUIRE(rb.Capacity() == 64);
+  for (int i = 0; i < 64; ++i) {
+    REQUIRE(rb.Push(i));
+  }
+  REQUIRE(rb.Full());
+  REQUIRE(!rb.Push(64));
+
+  for (int i = 0; i < 64; ++i) {
+    int val;
+    REQUIRE(rb.Pop(val));
+    REQUIRE(val == i);
+  }
+  int val;
+  REQUIRE(!rb.Pop(val));
+  REQUIRE(rb.Empty());
+}
+
+TEST_CASE("MPMC RingBuffer: wrap-around", "[ring_buffer][mpmc]") {
+  MallocBackend backend;
+  auto *alloc = CreateTestAllocator(backend, 1024 * 1024);
+
+  // Keep the ring partly full so positions lap the 8 slots many times
+  mpmc_ring_buffer<int, ArenaAllocator<false>> rb(alloc, 8);
+  int next_pop = 0;
+  for (int i = 0; i < 1000; ++i) {
+    REQUIRE(rb.Push(i));
+    if (rb.Size() > 5) {
+      int val;
+      REQUIRE(rb.Pop(val));
+      REQUIRE(val == next_pop++);
+    }
+  }
+  int val;
+  while (rb.Pop(val)) {
+    REQUIRE(val == next_pop++);
+  }
+  REQUIRE(next_pop == 1000);
+}
+
+TEST_CASE("MPMC RingBuffer: concurrent producers and consumers",
+          "[ring_buffer][mpmc]") {
+  MallocBackend backend;
+  auto *alloc = CreateTestAllocator(backend, 1024 * 1024);
+
+  // Small ring so producers and consumers contend on full/empty
+  mpmc_ring_buffer<int, ArenaAllocator<false>> rb(alloc, 16);
+  constexpr int kProducers = 4;
+  constexpr int kConsumers = 4;
+  constexpr int kPerProducer = 20000;
+  constexpr int kTotal = kProducers * kPerProducer;
+
+  std::vector<std::atomic<int>> seen(kTotal);
+  for (auto &s : seen) {
+    s.store(0);
+  }
+  std::atomic<int> popped(0);
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < kProducers; ++p) {
+    threads.emplace_back([&rb, p]() {
+      for (int i = 0; i < kPerProducer; ++i) {
+        while (!rb.Push(p * kPerProducer + i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (int c = 0; c < kConsumers; ++c) {
+    threads.emplace_back([&rb, &seen, &popped]() {
+      int val;
+      while (popped.load(std::memory_order_relaxed) < kTotal) {
+        if (rb.Pop(val)) {
+          seen[val].fetch_add(1, std::memory_order_relaxed);
+          popped.fetch_add(1, std::memory_order_relaxed);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  // Every value was delivered exactly once
+  REQUIRE(popped.load() == kTotal);
+  bool exactly_once = true;
+  for (auto &s : seen) {
+    exactly_once &= s.load() == 1;
+  }
+  REQUIRE(exactly_once);
+  REQUIRE(rb.Empty());
+}
+
+SIMPLE_TEST_MAIN()
@@ -267,4 +267,114 @@ TEST_CASE("MPSC RingBuffer: stress test with varying producer count",
 
 }
 
+TEST_CASE("MPSC RingBuffer: batched push and pop", "[ring_buffer][mpsc]") {
+  MallocBackend backend;
+  auto *alloc = CreateTestAllocator(backend, 1024 * 1024);
+
+  mpsc_ring_buffer<int, ArenaAllocator<false>> rb(alloc, 16);
+
+  // Batches wrap around the 17-slot vector several times
+  int next = 0;
+  int expected = 0;
+  for (int round = 0; round < 10; ++round) {
+    int vals[12];
+    for (int &v : vals) {
+      v = next++;
+    }
+    REQUIRE(rb.PushBatch(vals, 12) == 12);
+    REQUIRE(rb.Size() == 12);
+
+    int out[16];
+    REQUIRE(rb.PopBatch(out, 5) == 5);
+    REQUIRE(rb.PopBatch(out + 5, 16) == 7);
+    for (int i = 0; i < 12; ++i) {
+      REQUIRE(out[i] == expected++);
+    }
+    REQUIRE(rb.Empty());
+  }
+
+  // Batches mix with single-element calls
+  REQUIRE(rb.Push(100));
+  int pair[2] = {101, 102};
+  REQUIRE(rb.PushBatch(pair, 2) == 2);
+  int val;
+  REQUIRE(rb.Pop(val));
+  REQUIRE(val == 100);
+  int out[4];
+  REQUIRE(rb.PopBatch(out, 4) == 2);
+  REQUIRE(out[0] == 101);
+  REQUIRE(out[1] == 102);
+  REQUIRE(rb.PopBatch(out, 4) == 0);
+
+  // A batch larger than the ring is refused
+  int big[17] = {};
+  REQUIRE(rb.PushBatch(big, 17) == 0);
+  REQUIRE(rb.Empty());
+}
+
+TEST_CASE("MPSC RingBuffer: batched push refused when full",
+          "[ring_buffer][mpsc]") {
+  MallocBackend backend;
+  auto *alloc = CreateTestAllocator(backend, 1024 * 1024);
+
+  using test_mpsc_no_wait = ring_buffer<int, ArenaAllocator<false>,
+      (RING_BUFFER_MPSC_FLAGS | RING_BUFFER_FIXED_SIZE | RING_BUFFER_ERROR_ON_NO_SPACE)>;
+  test_mpsc_no_wait rb(alloc, 8);
+
+  int vals[6] = {0, 1, 2, 3, 4, 5};
+  REQUIRE(rb.PushBatch(vals, 6) == 6);
+  // Only two slots are free, so the whole batch is refused
+  REQUIRE(rb.PushBatch(vals, 3) == 0);
+  REQUIRE(rb.Size() == 6);
+  REQUIRE(rb.PushBatch(vals, 2) == 2);
+
+  int out[8];
+  REQUIRE(rb.PopBatch(out, 8) == 8);
+  REQUIRE(out[5] == 5);
+  REQUIRE(out[6] == 0);
+  REQUIRE(out[7] == 1);
+}
+
+TEST_CASE("MPSC RingBuffer: batched producers with one batch consumer",
+          "[ring_buffer][mpsc]") {
+  MallocBackend backend;
+  auto *alloc = CreateTestAllocator(backend, 1024 * 1024);
+
+  mpsc_ring_buffer<int, ArenaAllocator<false>> rb(alloc, 64);
+
+  constexpr int kProducers = 4;
+  constexpr int kBatches = 200;
+  constexpr int kBatchSize = 8;
+  std::vector<std::thread> producers;
+  for (int producer_id = 0; producer_id < kProducers; ++producer_id) {
+    producers.emplace_back([&rb, producer_id]() {
+      for (int b = 0; b < kBatches; ++b) {
+        int vals[kBatchSize];
+        for (int i = 0; i < kBatchSize; ++i) {
+          vals[i] = (producer_id << 20) | (b * kBatchSize + i);
+        }
+        rb.PushBatch(vals, kBatchSize);
+      }
+    });
+  }
+
+  // Each producer's values must arrive in order and exactly once
+  std::vector<int> next_seq(kProducers, 0);
+  int total = 0;
+  int out[16];
+  while (total < kProducers * kBatches * kBatchSize) {
+    size_t n = rb.PopBatch(out, 16);
+    for (size_t i = 0; i < n; ++i) {
+      int producer_id = out[i] >> 20;
+      REQUIRE((out[i] & 0xFFFFF) == next_seq[producer_id]);
+      ++next_seq[producer_id];
+    }
+    total += static_cast<int>(n);
+  }
+  for (auto &t : producers) {
+    t.join();
+  }
+  REQUIRE(rb.Empty());
+}
+
 SIMPLE_TEST_MAIN()
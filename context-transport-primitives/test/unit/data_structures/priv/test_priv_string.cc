@@ -448,6 +448,29 @@ TEST_CASE("String: find with position", "[priv_string]") {
   REQUIRE(pos == 7);
 }
 
+TEST_CASE("String: find matches std::string", "[priv_string]") {
+  // Small alphabet so candidates of the first character often fail later
+  const std::string hay = "abaabbabaaabababbbaabababaaab";
+  const char* needles[] = {"a", "b", "ab", "ba", "aab", "abab", "bbb",
+                           "aaab", "abba", "c", "abaabbabaaabababbbaabababaaab"};
+  basic_string<char, SimpleHeapAllocator> str(hay.c_str(), &g_allocator);
+  for (const char* needle : needles) {
+    basic_string<char, SimpleHeapAllocator> sub(needle, &g_allocator);
+    for (size_t pos = 0; pos <= hay.size() + 1; ++pos) {
+      size_t expect = hay.find(needle, pos);
+      size_t got = str.find(needle, pos);
+      REQUIRE((expect == std::string::npos ? got == str.npos : got == expect));
+      got = str.find(sub, pos);
+      REQUIRE((expect == std::string::npos ? got == str.npos : got == expect));
+    }
+  }
+  for (size_t pos = 0; pos <= hay.size(); ++pos) {
+    size_t expect = hay.find('b', pos);
+    size_t got = str.find('b', pos);
+    REQUIRE((expect == std::string::npos ? got == str.npos : got == expect));
+  }
+}
+
 TEST_CASE("String: starts_with", "[priv_string]") {
   basic_string<char, SimpleHeapAllocator> str("hello world", &g_allocator);
 
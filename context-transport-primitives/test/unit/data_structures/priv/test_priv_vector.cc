@@ -970,6 +970,54 @@ TEST_CASE("Vector: SVO clear stays in SVO", "[priv_vector][svo]") {
   REQUIRE(alloc.alloc_count == 0);
 }
 
+/** Trivially copyable but not trivial: its constructor zeroes the fields */
+struct BlockLike {
+  uint64_t target_ = 0;
+  uint64_t offset_ = 0;
+  uint64_t size_ = 0;
+  BlockLike() = default;
+  BlockLike(uint64_t t, uint64_t o, uint64_t s)
+      : target_(t), offset_(o), size_(s) {}
+};
+
+TEST_CASE("Vector: trivially copyable copy and grow", "[priv_vector][svo]") {
+  CountingAllocator alloc;
+  vector<BlockLike, CountingAllocator, 2> vec(&alloc);
+  vec.push_back(BlockLike(1, 0, 4096));
+  vec.push_back(BlockLike(1, 4096, 4096));
+  REQUIRE(alloc.alloc_count == 0);
+
+  // Copies of a small vector stay inline
+  vector<BlockLike, CountingAllocator, 2> copy(vec);
+  REQUIRE(alloc.alloc_count == 0);
+  REQUIRE(copy.size() == 2);
+  REQUIRE(copy[1].offset_ == 4096);
+
+  // Growing past the inline slots relocates the elements to the heap
+  for (uint64_t i = 2; i < 10; ++i) {
+    vec.push_back(BlockLike(2, i * 4096, 4096));
+  }
+  REQUIRE(alloc.alloc_count > 0);
+  REQUIRE(vec.size() == 10);
+  REQUIRE(vec[0].size_ == 4096);
+  REQUIRE(vec[1].offset_ == 4096);
+  REQUIRE(vec[9].offset_ == 9 * 4096);
+
+  copy = vec;
+  REQUIRE(copy.size() == 10);
+  for (size_t i = 0; i < copy.size(); ++i) {
+    REQUIRE(copy[i].offset_ == vec[i].offset_);
+  }
+  copy.erase(copy.begin());
+  REQUIRE(copy.size() == 9);
+  REQUIRE(copy[0].offset_ == 4096);
+
+  // resize() still runs the default constructor's zeroing
+  vector<BlockLike, CountingAllocator, 2> sized(&alloc);
+  sized.resize(3);
+  REQUIRE(sized[2].size_ == 0);
+}
+
 TEST_CASE("Vector: SVO reserve within SVO_SIZE is no-op", "[priv_vector][svo]") {
   CountingAllocator alloc;
   vector<int, CountingAllocator> vec(&alloc);
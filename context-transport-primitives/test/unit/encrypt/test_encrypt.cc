@@ -51,3 +51,29 @@ void CryptoTest() {
 }
 
 TEST_CASE("TestAES") { CryptoTest<hshm::AES>(); }
+
+TEST_CASE("TestAesGcmChunks") {
+  hshm::AesGcm gcm;
+  REQUIRE(!gcm.SetKey("short"));
+  REQUIRE(gcm.GenerateKey("passwd", "salt"));
+  std::vector<char> data(4096);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<char>(i * 7);
+  }
+  std::vector<char> sealed(data.size() + hshm::AesGcm::kOverhead);
+  std::vector<char> opened(data.size());
+  REQUIRE(gcm.Seal(sealed.data(), data.data(), data.size(), 3));
+  REQUIRE(gcm.Open(opened.data(), sealed.data(), sealed.size(), 3));
+  REQUIRE(opened == data);
+
+  // The chunk index and every byte are authenticated
+  REQUIRE(!gcm.Open(opened.data(), sealed.data(), sealed.size(), 4));
+  sealed[hshm::AesGcm::kNonceSize + 10] ^= 1;
+  REQUIRE(!gcm.Open(opened.data(), sealed.data(), sealed.size(), 3));
+
+  // Each seal draws a fresh nonce
+  std::vector<char> again(sealed.size());
+  REQUIRE(gcm.Seal(again.data(), data.data(), data.size(), 3));
+  REQUIRE(!std::equal(again.begin(), again.begin() + hshm::AesGcm::kNonceSize,
+                      sealed.begin()));
+}
@@ -45,6 +45,7 @@
 #include <cstring>
 #include <string>
 #include <filesystem>
+#include <vector>
 
 static const size_t kBlockSize = 4096;
 static const size_t kIoDepth = 32;
@@ -209,6 +210,191 @@ static bool RunUnalignedWriteReadTest(hshm::AsyncIoBackend backend) {
   return match;
 }
 
+/**
+ * Helper: write an aligned buffer at a file offset that is not sector
+ * aligned, which must not go through the O_DIRECT fd, then read it back.
+ * Returns true if the data matches.
+ */
+static bool RunMisalignedOffsetTest(hshm::AsyncIoBackend backend) {
+  auto aio = hshm::AsyncIoFactory::Get(kIoDepth, backend);
+  if (!aio) {
+    return false;
+  }
+
+  std::string path = CreateTempFile("test_async_io_offset");
+  REQUIRE(aio->Open(path, O_RDWR, 0644));
+  REQUIRE(aio->Truncate(2 * kBlockSize));
+
+  const off_t kOffset = 512;
+  void *write_buf = AlignedMalloc(kBlockSize, kBlockSize);
+  void *read_buf = AlignedMalloc(kBlockSize, kBlockSize);
+  REQUIRE(write_buf != nullptr);
+  REQUIRE(read_buf != nullptr);
+  memset(write_buf, 0x3C, kBlockSize);
+  memset(read_buf, 0, kBlockSize);
+
+  hshm::IoResult result;
+  auto token = aio->Write(write_buf, kBlockSize, kOffset);
+  REQUIRE(token != hshm::kInvalidIoToken);
+  while (!aio->IsComplete(token, result)) {
+  }
+  REQUIRE(result.error_code == 0);
+
+  token = aio->Read(read_buf, kBlockSize, kOffset);
+  REQUIRE(token != hshm::kInvalidIoToken);
+  while (!aio->IsComplete(token, result)) {
+  }
+  REQUIRE(result.error_code == 0);
+
+  bool match = memcmp(write_buf, read_buf, kBlockSize) == 0;
+
+  aio->Close();
+  std::filesystem::remove(path);
+  AlignedFree(write_buf);
+  AlignedFree(read_buf);
+  return match;
+}
+
+/**
+ * Helper: write three scattered aligned segments with one WriteV, then read
+ * them back with a ReadV that splits the extent differently.
+ * Returns true if the file holds the segments back to back.
+ */
+static bool RunVectoredWriteReadTest(hshm::AsyncIoBackend backend) {
+  auto aio = hshm::AsyncIoFactory::Get(kIoDepth, backend);
+  if (!aio) {
+    return false;
+  }
+
+  std::string path = CreateTempFile("test_async_io_vectored");
+  REQUIRE(aio->Open(path, O_RDWR, 0644));
+  REQUIRE(aio->Truncate(4 * kBlockSize));
+
+  // Segments of 1, 2 and 1 blocks in separate allocations
+  const size_t kSegBlocks[3] = {1, 2, 1};
+  std::vector<char *> segs;
+  std::vector<hshm::IoVec> iov;
+  for (size_t i = 0; i < 3; ++i) {
+    size_t size = kSegBlocks[i] * kBlockSize;
+    char *seg = static_cast<char *>(AlignedMalloc(4096, size));
+    REQUIRE(seg != nullptr);
+    memset(seg, static_cast<int>(0x10 + i), size);
+    segs.push_back(seg);
+    iov.push_back(hshm::IoVec{seg, size});
+  }
+
+  auto token = aio->WriteV(iov.data(), iov.size(), 0);
+  REQUIRE(token != hshm::kInvalidIoToken);
+  hshm::IoResult result;
+  while (!aio->IsComplete(token, result)) {
+  }
+  REQUIRE(result.error_code == 0);
+  REQUIRE(result.bytes_transferred == static_cast<ssize_t>(4 * kBlockSize));
+
+  // Read the whole extent back as two halves
+  char *read_buf = static_cast<char *>(AlignedMalloc(4096, 4 * kBlockSize));
+  REQUIRE(read_buf != nullptr);
+  memset(read_buf, 0, 4 * kBlockSize);
+  hshm::IoVec halves[2] = {{read_buf, 2 * kBlockSize},
+                           {read_buf + 2 * kBlockSize, 2 * kBlockSize}};
+  token = aio->ReadV(halves, 2, 0);
+  REQUIRE(token != hshm::kInvalidIoToken);
+  while (!aio->IsComplete(token, result)) {
+  }
+  REQUIRE(result.error_code == 0);
+  REQUIRE(result.bytes_transferred == static_cast<ssize_t>(4 * kBlockSize));
+
+  bool match = true;
+  size_t off = 0;
+  for (size_t i = 0; i < 3; ++i) {
+    match = match && memcmp(read_buf + off, segs[i], iov[i].size_) == 0;
+    off += iov[i].size_;
+  }
+
+  aio->Close();
+  std::filesystem::remove(path);
+  for (char *seg : segs) {
+    AlignedFree(seg);
+  }
+  AlignedFree(read_buf);
+  return match;
+}
+
+#if HSHM_ENABLE_IO_URING
+/**
+ * Helper: write kNumBlocks blocks from a registered region through an
+ * io_uring backend with the given options, then read them back into the
+ * same region.
+ * Returns true if every block reads back with its own pattern.
+ */
+static bool RunIoUringOptionsTest(const hshm::AsyncIoOptions &opts) {
+  const size_t kNumBlocks = 8;
+  const size_t kRegionSize = 2 * kNumBlocks * kBlockSize;
+  auto aio = hshm::AsyncIoFactory::Get(kIoDepth, hshm::AsyncIoBackend::kIoUring,
+                                       opts);
+  REQUIRE(aio != nullptr);
+
+  std::string path = CreateTempFile("test_async_io_uring_opts");
+  REQUIRE(aio->Open(path, O_RDWR, 0644));
+  REQUIRE(aio->Truncate(kNumBlocks * kBlockSize));
+
+  // First half of the region is written from, second half is read into
+  char *region = static_cast<char *>(AlignedMalloc(4096, kRegionSize));
+  REQUIRE(region != nullptr);
+  bool registered = aio->RegisterBuffer(region, kRegionSize);
+  REQUIRE(registered == opts.fixed_buffers_);
+  char *write_buf = region;
+  char *read_buf = region + kNumBlocks * kBlockSize;
+  memset(read_buf, 0, kNumBlocks * kBlockSize);
+
+  // Submit every block before waiting on any, as the bdev does
+  std::vector<hshm::IoToken> tokens;
+  for (size_t i = 0; i < kNumBlocks; ++i) {
+    memset(write_buf + i * kBlockSize, static_cast<int>(i + 1), kBlockSize);
+    tokens.push_back(aio->Write(write_buf + i * kBlockSize, kBlockSize,
+                                static_cast<off_t>(i * kBlockSize)));
+    REQUIRE(tokens.back() != hshm::kInvalidIoToken);
+  }
+  aio->Flush();
+  hshm::IoResult result;
+  for (hshm::IoToken token : tokens) {
+    while (!aio->IsComplete(token, result)) {
+    }
+    REQUIRE(result.error_code == 0);
+    REQUIRE(result.bytes_transferred == static_cast<ssize_t>(kBlockSize));
+  }
+
+  // Reads rely on IsComplete to submit the batch
+  tokens.clear();
+  for (size_t i = 0; i < kNumBlocks; ++i) {
+    tokens.push_back(aio->Read(read_buf + i * kBlockSize, kBlockSize,
+                               static_cast<off_t>(i * kBlockSize)));
+    REQUIRE(tokens.back() != hshm::kInvalidIoToken);
+  }
+  for (hshm::IoToken token : tokens) {
+    while (!aio->IsComplete(token, result)) {
+    }
+    REQUIRE(result.error_code == 0);
+  }
+
+  bool match = memcmp(write_buf, read_buf, kNumBlocks * kBlockSize) == 0;
+
+  // Dropped registrations fall back to plain reads
+  aio->UnregisterBuffers();
+  memset(read_buf, 0, kBlockSize);
+  hshm::IoToken token = aio->Read(read_buf, kBlockSize, 0);
+  REQUIRE(token != hshm::kInvalidIoToken);
+  while (!aio->IsComplete(token, result)) {
+  }
+  match = match && memcmp(write_buf, read_buf, kBlockSize) == 0;
+
+  aio->Close();
+  std::filesystem::remove(path);
+  AlignedFree(region);
+  return match;
+}
+#endif
+
 TEST_CASE("TestAsyncIO") {
   PAGE_DIVIDE("Default") {
     bool ok = RunAlignedWriteReadTest(hshm::AsyncIoBackend::kDefault);
@@ -220,6 +406,13 @@ TEST_CASE("TestAsyncIO") {
     REQUIRE(ok);
   }
 
+#if !HSHM_ENABLE_NIXL
+  PAGE_DIVIDE("DefaultVectored") {
+    bool ok = RunVectoredWriteReadTest(hshm::AsyncIoBackend::kDefault);
+    REQUIRE(ok);
+  }
+#endif
+
 #if HSHM_ENABLE_LIBAIO
   PAGE_DIVIDE("LinuxAio") {
     bool ok = RunAlignedWriteReadTest(hshm::AsyncIoBackend::kLinuxAio);
@@ -230,6 +423,16 @@ TEST_CASE("TestAsyncIO") {
     bool ok = RunUnalignedWriteReadTest(hshm::AsyncIoBackend::kLinuxAio);
     REQUIRE(ok);
   }
+
+  PAGE_DIVIDE("LinuxAioVectored") {
+    bool ok = RunVectoredWriteReadTest(hshm::AsyncIoBackend::kLinuxAio);
+    REQUIRE(ok);
+  }
+
+  PAGE_DIVIDE("LinuxAioMisalignedOffset") {
+    bool ok = RunMisalignedOffsetTest(hshm::AsyncIoBackend::kLinuxAio);
+    REQUIRE(ok);
+  }
 #endif
 
 #if HSHM_ENABLE_IO_URING
@@ -242,6 +445,46 @@ TEST_CASE("TestAsyncIO") {
     bool ok = RunUnalignedWriteReadTest(hshm::AsyncIoBackend::kIoUring);
     REQUIRE(ok);
   }
+
+  PAGE_DIVIDE("IoUringVectored") {
+    bool ok = RunVectoredWriteReadTest(hshm::AsyncIoBackend::kIoUring);
+    REQUIRE(ok);
+  }
+
+  PAGE_DIVIDE("IoUringMisalignedOffset") {
+    bool ok = RunMisalignedOffsetTest(hshm::AsyncIoBackend::kIoUring);
+    REQUIRE(ok);
+  }
+
+  PAGE_DIVIDE("IoUringFixedBuffersBatched") {
+    hshm::AsyncIoOptions opts;
+    opts.fixed_buffers_ = true;
+    opts.batch_submit_ = true;
+    bool ok = RunIoUringOptionsTest(opts);
+    REQUIRE(ok);
+  }
+
+  PAGE_DIVIDE("IoUringSqPoll") {
+    hshm::AsyncIoOptions opts;
+    opts.sqpoll_ = true;
+    opts.sqpoll_idle_ms_ = 10;
+    bool ok = RunIoUringOptionsTest(opts);
+    REQUIRE(ok);
+  }
+#endif
+
+#if HSHM_ENABLE_NVME_PASSTHRU
+  PAGE_DIVIDE("NvmePassthruRejectsRegularFile") {
+    // Only an NVMe generic char device answers the namespace ioctls
+    std::string path = CreateTempFile("test_nvme_passthru");
+    auto io = hshm::AsyncIoFactory::Get(kIoDepth,
+                                        hshm::AsyncIoBackend::kNvmePassthru);
+    REQUIRE(io != nullptr);
+    REQUIRE(!io->Open(path, O_RDWR, 0644));
+    REQUIRE(io->GetFileSize() == -1);
+    REQUIRE(io->Write(nullptr, kBlockSize, 0) == hshm::kInvalidIoToken);
+    std::filesystem::remove(path);
+  }
 #endif
 
 #if !defined(_WIN32)
@@ -254,6 +497,16 @@ TEST_CASE("TestAsyncIO") {
     bool ok = RunUnalignedWriteReadTest(hshm::AsyncIoBackend::kPosixAio);
     REQUIRE(ok);
   }
+
+  PAGE_DIVIDE("PosixAioVectored") {
+    bool ok = RunVectoredWriteReadTest(hshm::AsyncIoBackend::kPosixAio);
+    REQUIRE(ok);
+  }
+
+  PAGE_DIVIDE("PosixAioMisalignedOffset") {
+    bool ok = RunMisalignedOffsetTest(hshm::AsyncIoBackend::kPosixAio);
+    REQUIRE(ok);
+  }
 #endif
 
 #ifdef _WIN32
@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <hermes_shm/lightbeam/io_uring_transport.h>
+#include <hermes_shm/lightbeam/transport_factory_impl.h>
+
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace hshm::lbm;
+
+// Custom metadata class that inherits from LbmMeta
+class TestMeta : public LbmMeta<> {
+ public:
+  int request_id;
+  std::string operation;
+
+  template <typename Ar>
+  void serialize(Ar& ar) {
+    LbmMeta<>::serialize(ar);
+    ar(request_id, operation);
+  }
+};
+
+// Poll a transport until a message arrives; false on error or timeout
+template <typename MetaT>
+bool RecvWithRetry(IoUringTransport& transport, MetaT& meta,
+                   const LbmContext& ctx = LbmContext()) {
+  for (int attempts = 0; attempts < 5000; ++attempts) {
+    auto info = transport.Recv(meta, ctx);
+    if (info.rc == 0) return true;
+    if (info.rc != EAGAIN) {
+      std::cerr << "Recv failed with error: " << info.rc << "\n";
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  std::cerr << "Recv timed out\n";
+  return false;
+}
+
+void TestBasicTcpTransfer() {
+  std::cout << "\n==== Testing io_uring Basic TCP Transfer ====\n";
+
+  std::string addr = "127.0.0.1";
+  int port = 8210;
+
+  auto server = std::make_unique<IoUringTransport>(TransportMode::kServer, addr, "tcp", port);
+  auto client = std::make_unique<IoUringTransport>(TransportMode::kClient, addr, "tcp", port);
+
+  const char* data1 = "Hello, World!";
+  const char* data2 = "Testing io_uring Transport";
+
+  TestMeta send_meta;
+  send_meta.request_id = 42;
+  send_meta.operation = "test_op";
+  send_meta.send.push_back(client->Expose(
+      hipc::FullPtr<char>(const_cast<char*>(data1)), strlen(data1), BULK_XFER));
+  send_meta.send.push_back(client->Expose(
+      hipc::FullPtr<char>(const_cast<char*>(data2)), strlen(data2), BULK_XFER));
+  send_meta.send_bulks = 2;
+
+  int rc = client->Send(send_meta);
+  assert(rc == 0);
+
+  TestMeta recv_meta;
+  bool ok = RecvWithRetry(*server, recv_meta);
+  assert(ok);
+  assert(recv_meta.request_id == 42);
+  assert(recv_meta.operation == "test_op");
+  assert(recv_meta.recv.size() == 2);
+  assert(std::string(recv_meta.recv[0].data.ptr_, recv_meta.recv[0].size) == data1);
+  assert(std::string(recv_meta.recv[1].data.ptr_, recv_meta.recv[1].size) == data2);
+
+  server->ClearRecvHandles(recv_meta);
+  std::cout << "[io_uring TCP Basic] Test passed!\n";
+}
+
+void TestLargeBulks() {
+  std::cout << "\n==== Testing io_uring Zero-Copy Bulks ====\n";
+
+  std::string addr = "127.0.0.1";
+  int port = 8211;
+
+  auto server = std::make_unique<IoUringTransport>(TransportMode::kServer, addr, "tcp", port);
+  auto client = std::make_unique<IoUringTransport>(TransportMode::kClient, addr, "tcp", port);
+
+  // Large bulks go out in place and span many provided buffers
+  std::vector<std::string> data_chunks = {std::string(256 * 1024, 'a'),
+                                          "small in between",
+                                          std::string(1024 * 1024 + 7, 'b')};
+  for (size_t i = 0; i < data_chunks[2].size(); i += 4096) {
+    data_chunks[2][i] = static_cast<char>('c' + (i / 4096) % 16);
+  }
+
+  LbmMeta<> send_meta;
+  for (const auto& chunk : data_chunks) {
+    send_meta.send.push_back(client->Expose(
+        hipc::FullPtr<char>(const_cast<char*>(chunk.data())), chunk.size(),
+        BULK_XFER));
+    send_meta.send_bulks++;
+  }
+  int rc = client->Send(send_meta, LbmContext(LBM_SYNC));
+  assert(rc == 0);
+
+  LbmMeta<> recv_meta;
+  bool ok = RecvWithRetry(*server, recv_meta);
+  assert(ok);
+  assert(recv_meta.recv.size() == data_chunks.size());
+  for (size_t i = 0; i < data_chunks.size(); ++i) {
+    assert(std::string(recv_meta.recv[i].data.ptr_, recv_meta.recv[i].size) ==
+           data_chunks[i]);
+  }
+
+  server->ClearRecvHandles(recv_meta);
+  std::cout << "[io_uring Zero-Copy Bulks] Test passed!\n";
+}
+
+void TestUnixDomainSocket() {
+  std::cout << "\n==== Testing io_uring IPC (Unix Domain Socket) ====\n";
+
+  std::string sock_path = "/tmp/lightbeam_io_uring_test.sock";
+
+  auto server = std::make_unique<IoUringTransport>(TransportMode::kServer, sock_path, "ipc", 0);
+  auto client = std::make_unique<IoUringTransport>(TransportMode::kClient, sock_path, "ipc", 0);
+
+  const char* data = "IPC test data over Unix socket";
+  TestMeta send_meta;
+  send_meta.request_id = 99;
+  send_meta.operation = "ipc_test";
+  send_meta.send.push_back(client->Expose(
+      hipc::FullPtr<char>(const_cast<char*>(data)), strlen(data), BULK_XFER));
+  send_meta.send_bulks = 1;
+
+  int rc = client->Send(send_meta);
+  assert(rc == 0);
+
+  TestMeta recv_meta;
+  bool ok = RecvWithRetry(*server, recv_meta);
+  assert(ok);
+  assert(recv_meta.request_id == 99);
+  assert(std::string(recv_meta.recv[0].data.ptr_, recv_meta.recv[0].size) == data);
+
+  server->ClearRecvHandles(recv_meta);
+  std::cout << "[io_uring IPC] Test passed!\n";
+}
+
+void TestBatchedSmallMessages() {
+  std::cout << "\n==== Testing io_uring Batched Small Messages ====\n";
+
+  std::string addr = "127.0.0.1";
+  int port = 8212;
+
+  auto server = std::make_unique<IoUringTransport>(TransportMode::kServer, addr, "tcp", port);
+  auto client = std::make_unique<IoUringTransport>(TransportMode::kClient, addr, "tcp", port);
+
+  // Once an event loop flushes this thread's ring, sends wait for the flush
+  EventManager em;
+  server->RegisterEventManager(em);
+  em.Flush();
+
+  constexpr int kNumMessages = 2000;
+  for (int i = 0; i < kNumMessages; ++i) {
+    TestMeta send_meta;
+    send_meta.request_id = i;
+    send_meta.operation = "heartbeat";
+    int rc = client->Send(send_meta);
+    assert(rc == 0);
+  }
+  em.Flush();
+
+  for (int i = 0; i < kNumMessages; ++i) {
+    TestMeta recv_meta;
+    bool ok = RecvWithRetry(*server, recv_meta);
+    assert(ok);
+    assert(recv_meta.request_id == i);
+    assert(recv_meta.operation == "heartbeat");
+  }
+  std::cout << "[io_uring Batched Small Messages] Test passed!\n";
+}
+
+void TestServerReply() {
+  std::cout << "\n==== Testing io_uring Server Reply ====\n";
+
+  std::string addr = "127.0.0.1";
+  int port = 8213;
+
+  auto server = std::make_unique<IoUringTransport>(TransportMode::kServer, addr, "tcp", port);
+  auto client = std::make_unique<IoUringTransport>(TransportMode::kClient, addr, "tcp", port);
+
+  TestMeta request;
+  request.request_id = 1;
+  request.operation = "request";
+  int rc = client->Send(request);
+  assert(rc == 0);
+
+  TestMeta server_meta;
+  bool ok = RecvWithRetry(*server, server_meta);
+  assert(ok);
+
+  // The reply goes back on the connection the request came in on
+  std::string payload(64 * 1024, 'r');
+  TestMeta reply;
+  reply.request_id = 2;
+  reply.operation = "reply";
+  reply.client_info_ = server_meta.client_info_;
+  reply.send.push_back(server->Expose(
+      hipc::FullPtr<char>(payload.data()), payload.size(), BULK_XFER));
+  reply.send_bulks = 1;
+  rc = server->Send(reply, LbmContext(LBM_STAGE_BULKS));
+  assert(rc == 0);
+
+  TestMeta client_meta;
+  ok = RecvWithRetry(*client, client_meta);
+  assert(ok);
+  assert(client_meta.request_id == 2);
+  assert(std::string(client_meta.recv[0].data.ptr_, client_meta.recv[0].size) ==
+         payload);
+
+  client->ClearRecvHandles(client_meta);
+  std::cout << "[io_uring Server Reply] Test passed!\n";
+}
+
+// Hands out receive buffers from one contiguous arena
+class ArenaRecvAllocator : public RecvAllocator {
+ public:
+  std::vector<char> arena_ = std::vector<char>(4096);
+  size_t used_ = 0;
+  int allocs_ = 0;
+
+  hipc::FullPtr<char> Allocate(size_t size) override {
+    if (used_ + size > arena_.size()) return hipc::FullPtr<char>::GetNull();
+    char* buf = arena_.data() + used_;
+    used_ += size;
+    allocs_++;
+    return hipc::FullPtr<char>(buf);
+  }
+  void Free(const hipc::FullPtr<char>& buf) override { (void)buf; }
+};
+
+void TestRecvAllocator() {
+  std::cout << "\n==== Testing io_uring Receive Into Allocator Buffers ====\n";
+
+  std::string addr = "127.0.0.1";
+  int port = 8214;
+
+  auto server = std::make_unique<IoUringTransport>(TransportMode::kServer, addr, "tcp", port);
+  auto client = std::make_unique<IoUringTransport>(TransportMode::kClient, addr, "tcp", port);
+
+  std::vector<std::string> data_chunks = {"first bulk", "second bulk"};
+  LbmMeta<> send_meta;
+  for (const auto& chunk : data_chunks) {
+    send_meta.send.push_back(client->Expose(
+        hipc::FullPtr<char>(const_cast<char*>(chunk.data())), chunk.size(),
+        BULK_XFER));
+    send_meta.send_bulks++;
+  }
+  int rc = client->Send(send_meta);
+  assert(rc == 0);
+
+  ArenaRecvAllocator alloc;
+  LbmContext ctx;
+  ctx.recv_alloc_ = &alloc;
+  LbmMeta<> recv_meta;
+  bool ok = RecvWithRetry(*server, recv_meta, ctx);
+  assert(ok);
+  assert(alloc.allocs_ == static_cast<int>(data_chunks.size()));
+  for (size_t i = 0; i < data_chunks.size(); ++i) {
+    const Bulk& bulk = recv_meta.recv[i];
+    assert(bulk.flags.Any(BULK_RECV_ALLOC));
+    assert(std::string(bulk.data.ptr_, bulk.size) == data_chunks[i]);
+  }
+
+  server->ClearRecvHandles(recv_meta);
+  std::cout << "[io_uring Recv Allocator] Test passed!\n";
+}
+
+int main() {
+  if (!IoUringRing::Supported()) {
+    std::cout << "\n[Skipped] io_uring transport not supported by this kernel\n";
+    return 0;
+  }
+  TestBasicTcpTransfer();
+  TestLargeBulks();
+  TestUnixDomainSocket();
+  TestBatchedSmallMessages();
+  TestServerReply();
+  TestRecvAllocator();
+  std::cout << "\nAll io_uring transport tests passed!" << std::endl;
+  return 0;
+}
@@ -273,6 +273,85 @@ void TestMetadataOnly() {
   std::cout << "[Socket Metadata Only] Test passed!\n";
 }
 
+// Hands out receive buffers from one contiguous arena
+class ArenaRecvAllocator : public RecvAllocator {
+ public:
+  std::vector<char> arena_ = std::vector<char>(4096);
+  size_t used_ = 0;
+  int allocs_ = 0;
+  int frees_ = 0;
+
+  hipc::FullPtr<char> Allocate(size_t size) override {
+    if (used_ + size > arena_.size()) return hipc::FullPtr<char>::GetNull();
+    char* buf = arena_.data() + used_;
+    used_ += size;
+    allocs_++;
+    return hipc::FullPtr<char>(buf);
+  }
+  void Free(const hipc::FullPtr<char>& buf) override {
+    (void)buf;
+    frees_++;
+  }
+};
+
+void TestRecvAllocator() {
+  std::cout << "\n==== Testing Socket Receive Into Allocator Buffers ====\n";
+
+  std::string addr = "127.0.0.1";
+  int port = 8196;
+
+  auto server = std::make_unique<SocketTransport>(TransportMode::kServer, addr, "tcp", port);
+  auto client = std::make_unique<SocketTransport>(TransportMode::kClient, addr, "tcp", port);
+
+  std::vector<std::string> data_chunks = {"first bulk", "second, longer bulk",
+                                          "third"};
+  LbmMeta<> send_meta;
+  for (const auto& chunk : data_chunks) {
+    send_meta.send.push_back(client->Expose(
+        hipc::FullPtr<char>(const_cast<char*>(chunk.data())), chunk.size(),
+        BULK_XFER));
+    send_meta.send_bulks++;
+  }
+  int rc = client->Send(send_meta);
+  assert(rc == 0);
+
+  ArenaRecvAllocator alloc;
+  LbmContext ctx;
+  ctx.recv_alloc_ = &alloc;
+  LbmMeta<> recv_meta;
+  int attempts = 0;
+  while (true) {
+    auto info = server->Recv(recv_meta, ctx);
+    rc = info.rc;
+    if (rc == 0) break;
+    if (rc != EAGAIN) {
+      std::cerr << "Recv failed with error: " << rc << "\n";
+      return;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    if (++attempts > 5000) {
+      std::cerr << "Recv timed out\n";
+      return;
+    }
+  }
+
+  // Every bulk was written straight into the arena, back to back
+  assert(alloc.allocs_ == static_cast<int>(data_chunks.size()));
+  size_t offset = 0;
+  for (size_t i = 0; i < data_chunks.size(); ++i) {
+    const Bulk& bulk = recv_meta.recv[i];
+    assert(bulk.flags.Any(BULK_RECV_ALLOC));
+    assert(bulk.data.ptr_ == alloc.arena_.data() + offset);
+    assert(std::string(bulk.data.ptr_, bulk.size) == data_chunks[i]);
+    offset += bulk.size;
+  }
+
+  // The buffers belong to the allocator's owner, not the transport
+  server->ClearRecvHandles(recv_meta);
+  assert(alloc.frees_ == 0);
+  std::cout << "[Socket Recv Allocator] Test passed!\n";
+}
+
 int main() {
   TestBasicTcpTransfer();
   TestMultipleBulks();
@@ -282,6 +361,7 @@ int main() {
   std::cout << "\n[Skipped] Unix Domain Socket (not supported on Windows)\n";
 #endif
   TestMetadataOnly();
+  TestRecvAllocator();
   std::cout << "\nAll socket transport tests passed!" << std::endl;
   return 0;
 }
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "basic_test.h"
+#include "hermes_shm/thread/epoch_reclaimer.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using hshm::EpochGuard;
+using hshm::EpochReclaimer;
+
+namespace {
+
+/** Counts deletions so tests can observe when limbo drains */
+std::atomic<int> g_freed{0};
+
+void CountingFree(void *ptr) {
+  delete static_cast<int *>(ptr);
+  g_freed.fetch_add(1);
+}
+
+/** Node swapped in and out of a shared slot by the stress test */
+struct Node {
+  static constexpr int kAlive = 0x600D;
+  static constexpr int kDead = 0xDEAD;
+  int canary_ = kAlive;
+};
+
+void PoisonFree(void *ptr) {
+  auto *node = static_cast<Node *>(ptr);
+  node->canary_ = Node::kDead;
+  delete node;
+}
+
+}  // namespace
+
+TEST_CASE("EpochReclaimer: pinned reader defers free") {
+  EpochReclaimer ebr;
+  auto *reader = ebr.Register();
+  auto *writer = ebr.Register();
+  g_freed = 0;
+
+  ebr.Enter(reader);
+  ebr.Retire(writer, new int(7), CountingFree, sizeof(int));
+  REQUIRE(ebr.GetLimboCount() == 1);
+  REQUIRE(ebr.GetLimboBytes() == sizeof(int));
+
+  // The reader pins the epoch: at most one advance, never enough to free
+  for (int i = 0; i < 8; ++i) {
+    ebr.TryAdvance();
+    ebr.Quiesce(writer);
+  }
+  REQUIRE(g_freed.load() == 0);
+
+  ebr.Exit(reader);
+  for (int i = 0; i < 3; ++i) {
+    ebr.TryAdvance();
+  }
+  ebr.Quiesce(writer);
+  REQUIRE(g_freed.load() == 1);
+  REQUIRE(ebr.GetLimboCount() == 0);
+  REQUIRE(ebr.GetLimboBytes() == 0);
+  REQUIRE(ebr.GetFreedCount() == 1);
+}
+
+TEST_CASE("EpochReclaimer: offline participants do not block advance") {
+  EpochReclaimer ebr;
+  auto *worker = ebr.Register();
+  ebr.Quiesce(worker);
+  hshm::u64 e = ebr.GetEpoch();
+  REQUIRE(ebr.TryAdvance());
+  // Online at the old epoch: blocks the next advance until it quiesces
+  REQUIRE_FALSE(ebr.TryAdvance());
+  ebr.Offline(worker);
+  REQUIRE(ebr.TryAdvance());
+  REQUIRE(ebr.GetEpoch() == e + 2);
+}
+
+TEST_CASE("EpochReclaimer: unregistered limbo is adopted") {
+  EpochReclaimer ebr;
+  g_freed = 0;
+  auto *p = ebr.Register();
+  for (int i = 0; i < 4; ++i) {
+    ebr.Retire(p, new int(i), CountingFree, sizeof(int));
+  }
+  ebr.Unregister(p);
+  REQUIRE(ebr.GetLimboCount() == 4);
+
+  // The slot is reused without inheriting the old limbo
+  auto *q = ebr.Register();
+  REQUIRE(q == p);
+  for (int i = 0; i < 3; ++i) {
+    ebr.TryAdvance();
+  }
+  REQUIRE(g_freed.load() == 4);
+  REQUIRE(ebr.GetLimboCount() == 0);
+  ebr.Unregister(q);
+}
+
+TEST_CASE("EpochReclaimer: concurrent readers never see freed nodes") {
+  auto *ebr = HSHM_EBR;
+  std::atomic<Node *> slot{new Node()};
+  std::atomic<bool> done{false};
+  std::atomic<int> bad{0};
+
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&]() {
+      while (!done.load(std::memory_order_acquire)) {
+        EpochGuard guard;
+        Node *node = slot.load(std::memory_order_acquire);
+        for (int i = 0; i < 16; ++i) {
+          if (node->canary_ != Node::kAlive) {
+            bad.fetch_add(1);
+          }
+        }
+      }
+    });
+  }
+
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 2; ++t) {
+    writers.emplace_back([&]() {
+      auto *self = EpochReclaimer::Local();
+      for (int i = 0; i < 20000; ++i) {
+        Node *old = slot.exchange(new Node(), std::memory_order_acq_rel);
+        ebr->Retire(self, old, PoisonFree, sizeof(Node));
+      }
+    });
+  }
+  for (auto &w : writers) {
+    w.join();
+  }
+  done.store(true, std::memory_order_release);
+  for (auto &r : readers) {
+    r.join();
+  }
+
+  REQUIRE(bad.load() == 0);
+  // Everything but the writers' last few buckets has been freed
+  REQUIRE(ebr->GetFreedCount() > 0);
+  delete slot.load();
+}
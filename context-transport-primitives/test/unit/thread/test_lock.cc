@@ -35,6 +35,12 @@
 #include "hermes_shm/thread/lock.h"
 #include "omp.h"
 
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <new>
+
 using hshm::Mutex;
 using hshm::RwLock;
 
@@ -95,12 +101,64 @@ void RwLockTest(int producers, int consumers, size_t loop_count) {
 
 TEST_CASE("Mutex") { MutexTest(8); }
 
+TEST_CASE("MutexOversubscribed") {
+  // More threads than cores forces waiters past the spin phase and onto
+  // the futex
+  auto *sys_info = HSHM_SYSTEM_INFO;
+  MutexTest(4 * sys_info->ncpu_ + 4);
+}
+
+TEST_CASE("MutexCrossProcess") {
+  // Lock and counter live in a shared mapping so the parent and child park
+  // and wake each other through the same futex word
+  struct Shared {
+    Mutex lock_;
+    size_t count_;
+  };
+  const size_t kLoopCount = 20000;
+  void *region = mmap(nullptr, sizeof(Shared), PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  REQUIRE(region != MAP_FAILED);
+  auto *shared = new (region) Shared();
+  shared->count_ = 0;
+
+  auto work = [&]() {
+    for (size_t i = 0; i < kLoopCount; ++i) {
+      shared->lock_.Lock(0);
+      size_t count = shared->count_;
+      if (i % 64 == 0) {
+        sched_yield();
+      }
+      shared->count_ = count + 1;
+      shared->lock_.Unlock();
+    }
+  };
+  pid_t pid = fork();
+  REQUIRE(pid >= 0);
+  if (pid == 0) {
+    work();
+    _exit(0);
+  }
+  work();
+  int status = 0;
+  waitpid(pid, &status, 0);
+  REQUIRE(WIFEXITED(status));
+  REQUIRE(shared->count_ == 2 * kLoopCount);
+  munmap(region, sizeof(Shared));
+}
+
 TEST_CASE("RwLock") {
   RwLockTest(8, 0, 1000000);
   RwLockTest(7, 1, 1000000);
   RwLockTest(4, 4, 1000000);
 }
 
+TEST_CASE("RwLockOversubscribed") {
+  auto *sys_info = HSHM_SYSTEM_INFO;
+  int nthreads = 2 * sys_info->ncpu_ + 2;
+  RwLockTest(nthreads, nthreads, 10000);
+}
+
 #if HSHM_ENABLE_THALLIUM
 TEST_CASE("AbtThread") {
   hshm::thread::Argobots argobots;
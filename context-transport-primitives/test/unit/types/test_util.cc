@@ -121,6 +121,25 @@ TEST_CASE("TestSystemInfo") {
   REQUIRE((sep == ':' || sep == ';'));
 }
 
+TEST_CASE("TestNumaTopology") {
+  auto *sys_info = HSHM_SYSTEM_INFO;
+  REQUIRE(sys_info->numa_nodes_ >= 1);
+  REQUIRE(sys_info->numa_nodes_ == hshm::SystemInfo::GetNumaNodeCount());
+
+  // Every CPU maps to a valid node; out-of-range CPUs fall back to node 0
+  for (int cpu = 0; cpu < sys_info->ncpu_; ++cpu) {
+    int node = sys_info->GetNumaNodeOfCpu(cpu);
+    REQUIRE(node >= 0);
+    REQUIRE(node < sys_info->numa_nodes_);
+  }
+  REQUIRE(sys_info->GetNumaNodeOfCpu(-1) == 0);
+  REQUIRE(sys_info->GetNumaNodeOfCpu(sys_info->ncpu_) == 0);
+
+  int cur = sys_info->GetCurrentNumaNode();
+  REQUIRE(cur >= 0);
+  REQUIRE(cur < sys_info->numa_nodes_);
+}
+
 TEST_CASE("TestTerminal") {
   std::cout << "\033[1m" << "Bold text" << "\033[0m" << std::endl;
   std::cout << "\033[4m" << "Underlined text" << "\033[0m" << std::endl;
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "basic_test.h"
+#include "hermes_shm/types/hash.h"
+
+#include <string>
+#include <unordered_set>
+
+TEST_CASE("HashBytesReferenceVectors") {
+  // wyhash final4 test vectors, seeded with their index
+  const char *inputs[] = {
+      "",
+      "a",
+      "abc",
+      "message digest",
+      "abcdefghijklmnopqrstuvwxyz",
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+      "1234567890123456789012345678901234567890123456789012345678901234567890"
+      "1234567890"};
+  const uint64_t expected[] = {
+      0x93228a4de0eec5a2ULL, 0xc5bac3db178713c4ULL, 0xa97f2f7b1d9b3314ULL,
+      0x786d1f1df3801df4ULL, 0xdca5a8138ad37c87ULL, 0xb9e734f117cfaf70ULL,
+      0x6cc5eab49a92d617ULL};
+  for (size_t i = 0; i < 7; ++i) {
+    REQUIRE(hshm::HashBytes(inputs[i], strlen(inputs[i]), i) == expected[i]);
+  }
+}
+
+TEST_CASE("HashBytesStringSpecializations") {
+  std::string key = "tag.7.blob_0123";
+  std::string_view view(key);
+  size_t h = static_cast<size_t>(hshm::HashBytes(key.data(), key.size()));
+  REQUIRE(hshm::hash<std::string>{}(key) == h);
+  REQUIRE(hshm::hash<std::string_view>{}(view) == h);
+}
+
+TEST_CASE("HashBytesDistinguishesLengthsAndTails") {
+  // Every length crosses a different short/long path; all must differ
+  std::string buf(200, 'x');
+  std::unordered_set<uint64_t> seen;
+  for (size_t len = 0; len <= buf.size(); ++len) {
+    REQUIRE(seen.insert(hshm::HashBytes(buf.data(), len)).second);
+  }
+  // Flipping the last byte changes the hash on the overlapped tail path
+  std::string a(50, 'q'), b(50, 'q');
+  b.back() = 'r';
+  REQUIRE(hshm::HashBytes(a.data(), a.size()) !=
+          hshm::HashBytes(b.data(), b.size()));
+}
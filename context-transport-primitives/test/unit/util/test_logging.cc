@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024, Gnosis Research Center, Illinois Institute of Technology
+ * All rights reserved.
+ *
+ * This file is part of IOWarp Core.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "basic_test.h"
+#include "hermes_shm/util/logging.h"
+
+TEST_CASE("LogRing - Full Ring Drops And Counts") {
+  hshm::LogRing ring(2);
+  for (int i = 0; i < 3; ++i) {
+    hshm::LogRecord rec;
+    rec.line_ = i;
+    REQUIRE(ring.TryPush(rec) == (i < 2));
+  }
+  REQUIRE(ring.dropped_.load() == 1);
+
+  std::vector<hshm::LogRecord> out;
+  REQUIRE(ring.Drain(out) == 2);
+  REQUIRE(out[0].line_ == 0);
+  REQUIRE(out[1].line_ == 1);
+  REQUIRE(ring.Empty());
+}
+
+TEST_CASE("Logger - Async Output Keeps Every Record In Thread Order") {
+  constexpr int kThreads = 4;
+  constexpr int kPerThread = 200;
+  auto *logger = HSHM_LOG;
+  FILE *saved = logger->fout_;
+  FILE *file = tmpfile();
+  REQUIRE(file != nullptr);
+  logger->fout_ = file;
+
+  logger->StartAsync(kThreads * kPerThread);
+  REQUIRE(logger->IsAsync());
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([t]() {
+      for (int i = 0; i < kPerThread; ++i) {
+        HLOG(kInfo, "async-test {} {}", t, i);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  logger->StopAsync();
+  REQUIRE(!logger->IsAsync());
+  REQUIRE(logger->GetDroppedCount() == 0);
+  logger->fout_ = saved;
+
+  std::vector<int> next(kThreads, 0);
+  int total = 0;
+  char line[512];
+  rewind(file);
+  while (fgets(line, sizeof(line), file) != nullptr) {
+    const char *msg = strstr(line, "async-test ");
+    if (msg == nullptr) {
+      continue;
+    }
+    int t = -1, i = -1;
+    REQUIRE(sscanf(msg, "async-test %d %d", &t, &i) == 2);
+    REQUIRE(t >= 0);
+    REQUIRE(t < kThreads);
+    REQUIRE(i == next[t]);
+    next[t]++;
+    total++;
+  }
+  fclose(file);
+  REQUIRE(total == kThreads * kPerThread);
+}
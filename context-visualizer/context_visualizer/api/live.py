@@ -0,0 +1,15 @@
+"""GET /api/live -- latest cluster stats from the streaming subscription."""
+
+from flask import Blueprint, jsonify
+
+from .. import stat_stream
+
+bp = Blueprint("live", __name__)
+
+
+@bp.route("/live")
+def get_live():
+    snapshot = stat_stream.get_stream().snapshot()
+    if snapshot["error"] and not snapshot["nodes"]:
+        return jsonify(snapshot), 503
+    return jsonify(snapshot)
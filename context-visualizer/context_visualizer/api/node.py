@@ -1,10 +1,11 @@
-"""Per-node API endpoints: workers, system_stats, bdev_stats."""
+"""Per-node API endpoints: workers, worker_samples, system_stats, bdev_stats."""
 
 import os
 
 from flask import Blueprint, jsonify, request
 
 from .. import chimaera_client
+from .workers import flatten_samples, summarize_samples
 
 bp = Blueprint("node", __name__)
 
@@ -83,6 +84,24 @@ def get_node_workers(node_id):
     })
 
 
+@bp.route("/node/<int:node_id>/worker_samples")
+def get_node_worker_samples(node_id):
+    if not _node_is_alive(node_id):
+        return jsonify({"error": "node_down", "entries": [], "summary": []}), 503
+
+    min_event_id = request.args.get("min_event_id", 0, type=int)
+    try:
+        if node_id == 0:
+            raw = chimaera_client.get_worker_samples("local", min_event_id)
+        else:
+            raw = chimaera_client.get_worker_samples_for_node(node_id, min_event_id)
+    except Exception as exc:
+        return jsonify({"error": str(exc)}), 503
+
+    entries = flatten_samples(raw)
+    return jsonify({"entries": entries, "summary": summarize_samples(entries)})
+
+
 @bp.route("/node/<int:node_id>/system_stats")
 def get_node_system_stats(node_id):
     if not _node_is_alive(node_id):
@@ -1,6 +1,6 @@
-"""GET /api/workers -- live worker statistics."""
+"""GET /api/workers -- live worker statistics and sampled counters."""
 
-from flask import Blueprint, jsonify
+from flask import Blueprint, jsonify, request
 
 from .. import chimaera_client
 
@@ -35,3 +35,68 @@ def get_workers():
             "processed": total_processed,
         },
     })
+
+
+def flatten_samples(raw):
+    """Flatten Monitor(worker_samples) results into one entry list."""
+    entries = []
+    for _cid, data in raw.items():
+        if isinstance(data, list):
+            entries.extend(e for e in data if isinstance(e, dict) and e)
+    entries.sort(key=lambda e: e.get("event_id", 0))
+    return entries
+
+
+def summarize_samples(entries):
+    """Per-worker rates between the last two samples of each worker.
+
+    Counters in a sample are cumulative, so the busy, idle and sleep
+    fractions and the task rates come from the difference of the two
+    newest samples. A worker with only one sample reports no rates.
+    """
+    by_worker = {}
+    for entry in entries:
+        by_worker.setdefault(entry.get("worker_id", 0), []).append(entry)
+    summary = []
+    for worker_id in sorted(by_worker):
+        samples = by_worker[worker_id]
+        cur = samples[-1]
+        row = {
+            "worker_id": worker_id,
+            "lane_depth": cur.get("lane_depth", 0),
+            "blocked_tasks": cur.get("blocked_tasks", 0),
+            "periodic_tasks": cur.get("periodic_tasks", 0),
+            "retry_tasks": cur.get("retry_tasks", 0),
+            "load_us": cur.get("load_us", 0),
+        }
+        if len(samples) > 1:
+            prev = samples[-2]
+            dt_us = (cur["timestamp_ns"] - prev["timestamp_ns"]) / 1000.0
+            if dt_us > 0:
+                def frac(key):
+                    return max(0.0, (cur.get(key, 0) - prev.get(key, 0)) / dt_us)
+                row["busy_frac"] = min(1.0, frac("busy_us"))
+                row["idle_frac"] = min(1.0, frac("idle_cpu_us"))
+                row["sleep_frac"] = min(1.0, frac("sleep_us"))
+                row["tasks_per_sec"] = frac("tasks_processed") * 1e6
+                row["resumes_per_sec"] = frac("resumes") * 1e6
+                prev_methods = prev.get("method_tasks", {})
+                row["method_tasks_per_sec"] = {
+                    str(m): (n - prev_methods.get(m, 0)) / dt_us * 1e6
+                    for m, n in cur.get("method_tasks", {}).items()
+                    if n != prev_methods.get(m, 0)
+                }
+        summary.append(row)
+    return summary
+
+
+@bp.route("/workers/samples")
+def get_worker_samples():
+    min_event_id = request.args.get("min_event_id", 0, type=int)
+    try:
+        raw = chimaera_client.get_worker_samples("local", min_event_id)
+    except Exception as exc:
+        return jsonify({"error": str(exc)}), 503
+
+    entries = flatten_samples(raw)
+    return jsonify({"entries": entries, "summary": summarize_samples(entries)})
@@ -17,6 +17,7 @@ def create_app():
     from .api.system import bp as system_bp
     from .api.topology import bp as topology_bp
     from .api.node import bp as node_bp
+    from .api.live import bp as live_bp
 
     app.register_blueprint(workers_bp, url_prefix="/api")
     app.register_blueprint(pools_bp, url_prefix="/api")
@@ -24,6 +25,7 @@ def create_app():
     app.register_blueprint(system_bp, url_prefix="/api")
     app.register_blueprint(topology_bp, url_prefix="/api")
     app.register_blueprint(node_bp, url_prefix="/api")
+    app.register_blueprint(live_bp, url_prefix="/api")
 
     # Template routes
     @app.route("/")
@@ -34,6 +36,10 @@ def create_app():
     def pools():
         return render_template("pools.html")
 
+    @app.route("/live")
+    def live():
+        return render_template("live.html")
+
     @app.route("/config")
     def config():
         return render_template("config.html")
@@ -120,6 +120,16 @@ def get_pool_worker_stats(pool_id_str, routing="local"):
     return _monitor("local", f"pool_stats://{pool_id_str}:{routing}:worker_stats")
 
 
+def get_worker_samples(pool_query="local", min_event_id=0):
+    """Query the per-worker counter samples ring from the admin pool."""
+    return _monitor(pool_query, f"worker_samples:{min_event_id}")
+
+
+def get_worker_samples_for_node(node_id, min_event_id=0):
+    """Query worker_samples for a specific node."""
+    return _monitor(f"physical:{node_id}", f"worker_samples:{min_event_id}")
+
+
 def get_status():
     """Query general status from the admin pool."""
     return _monitor("local", "status")
@@ -135,6 +145,19 @@ def get_system_stats_all(min_event_id=0):
     return _monitor("broadcast", f"system_stats:{min_event_id}")
 
 
+def subscribe_stats(subscriber_id, round_num, wait_ms=1000,
+                    pool_query="broadcast"):
+    """Long-poll the admin ``subscribe`` query for stat deltas.
+
+    Each node returns the values that changed since this subscriber's
+    previous call, once it has a snapshot it has not sent yet or after
+    wait_ms.  round_num numbers the calls; 0 asks for full snapshots.
+    """
+    return _monitor(pool_query,
+                    f"subscribe:{subscriber_id}:{round_num}:{wait_ms}",
+                    timeout=_MONITOR_TIMEOUT + wait_ms / 1000.0)
+
+
 def check_nodes_alive(ip_list, port=9413, timeout=1):
     """Check which nodes are alive by attempting a TCP connection to their RPC port.
 
@@ -0,0 +1,191 @@
+"""Live cluster stats kept current by the admin ``subscribe`` query.
+
+One background thread long-polls every node with a broadcast.  Nodes
+answer with only the values that changed since the previous round, so a
+refresh costs one task per node no matter how many browsers watch.
+"""
+
+import threading
+import time
+import uuid
+
+from . import chimaera_client
+
+# How long each node may hold a round open waiting for a new snapshot
+_WAIT_MS = 1500
+# Pause after a failed round before trying again
+_RETRY_S = 2.0
+
+
+class _NodeState:
+    """Flat stats of one node, plus the previous values for rates."""
+
+    def __init__(self):
+        self.values = {}
+        self.prev_values = {}
+        self.timestamp_ns = 0
+        self.prev_timestamp_ns = 0
+        self.hostname = ""
+        self.applied_round = 0
+
+
+class StatStream:
+    """Merge per-node stat deltas into the latest view of the cluster."""
+
+    def __init__(self):
+        self._id = uuid.uuid4().hex[:16]
+        self._lock = threading.Lock()
+        self._nodes = {}
+        self._round = 0
+        self._full_next = True
+        self._error = None
+        self._thread = None
+
+    def start(self):
+        """Start the subscription thread if it is not running."""
+        with self._lock:
+            if self._thread is not None:
+                return
+            self._thread = threading.Thread(target=self._run, daemon=True)
+            self._thread.start()
+
+    def _run(self):
+        while True:
+            try:
+                self._poll_round()
+                self._error = None
+            except Exception as exc:
+                # Replies of the failed round may have been lost
+                self._full_next = True
+                self._error = str(exc)
+                time.sleep(_RETRY_S)
+
+    def _poll_round(self):
+        self._round += 1
+        round_num = 0 if self._full_next else self._round
+        self._full_next = False
+        raw = chimaera_client.subscribe_stats(self._id, round_num, _WAIT_MS)
+        resync = []
+        with self._lock:
+            for reply in raw.values():
+                if not isinstance(reply, dict) or "node_id" not in reply:
+                    continue
+                node = self._nodes.setdefault(reply["node_id"], _NodeState())
+                if not self._apply(node, reply, round_num):
+                    resync.append(reply["node_id"])
+        # A node whose delta builds on a reply we never got starts over
+        for node_id in resync:
+            raw = chimaera_client.subscribe_stats(
+                self._id, 0, 0, pool_query=f"physical:{node_id}")
+            with self._lock:
+                for reply in raw.values():
+                    if isinstance(reply, dict) and "node_id" in reply:
+                        node = self._nodes.setdefault(reply["node_id"],
+                                                      _NodeState())
+                        self._apply(node, reply, 0)
+
+    @staticmethod
+    def _apply(node, reply, round_num):
+        """Apply one node's reply; False if it has to be resent in full."""
+        if not reply.get("full") and \
+                reply.get("base_round") != node.applied_round:
+            return False
+        if reply.get("full"):
+            values = {}
+        else:
+            values = dict(node.values)
+        values.update(reply.get("set", {}))
+        for key in reply.get("removed", []):
+            values.pop(key, None)
+        node.applied_round = round_num
+        node.hostname = reply.get("hostname", node.hostname)
+        timestamp_ns = reply.get("timestamp_ns", 0)
+        if timestamp_ns != node.timestamp_ns:
+            node.prev_values = node.values
+            node.prev_timestamp_ns = node.timestamp_ns
+            node.timestamp_ns = timestamp_ns
+        node.values = values
+        return True
+
+    def snapshot(self):
+        """Per-node workers, targets and net queues with derived rates."""
+        with self._lock:
+            nodes = [(node_id, self._nodes[node_id])
+                     for node_id in sorted(self._nodes)]
+            return {
+                "error": self._error,
+                "nodes": [_summarize(node_id, node) for node_id, node in nodes],
+            }
+
+
+def _summarize(node_id, node):
+    """Group a node's flat keys and turn counters into rates."""
+    dt_s = (node.timestamp_ns - node.prev_timestamp_ns) / 1e9
+    if node.prev_timestamp_ns == 0 or dt_s <= 0:
+        dt_s = None
+
+    def rate(key):
+        if dt_s is None or key not in node.prev_values:
+            return None
+        return max(0.0, (node.values.get(key, 0) - node.prev_values[key]) / dt_s)
+
+    workers = {}
+    targets = {}
+    net_queues = []
+    for key, value in node.values.items():
+        kind, _, rest = key.partition(".")
+        name, _, field = rest.rpartition(".")
+        if kind == "worker":
+            workers.setdefault(int(name), {})[field] = value
+        elif kind == "target":
+            targets.setdefault(name, {})[field] = value
+        elif kind == "net_queue":
+            shard, _, prio = rest.partition(".")
+            net_queues.append({"shard": int(shard), "priority": int(prio),
+                               "depth": value})
+
+    worker_rows = []
+    for worker_id in sorted(workers):
+        prefix = f"worker.{worker_id}."
+        busy = rate(prefix + "busy_us")
+        worker_rows.append({
+            "worker_id": worker_id,
+            "tasks_per_s": rate(prefix + "tasks_processed"),
+            "busy_frac": None if busy is None else min(1.0, busy / 1e6),
+            "lane_depth": workers[worker_id].get("lane_depth", 0),
+            "blocked_tasks": workers[worker_id].get("blocked_tasks", 0),
+        })
+
+    target_rows = []
+    for name in sorted(targets):
+        stats = targets[name]
+        target_rows.append({
+            "name": name,
+            "read_latency_us": stats.get("read_latency_us"),
+            "write_latency_us": stats.get("write_latency_us"),
+            "read_bandwidth_mbps": stats.get("read_bandwidth_mbps"),
+            "write_bandwidth_mbps": stats.get("write_bandwidth_mbps"),
+            "iops": stats.get("iops"),
+            "remaining_capacity": stats.get("remaining_capacity"),
+        })
+
+    return {
+        "node_id": node_id,
+        "hostname": node.hostname,
+        "timestamp_ns": node.timestamp_ns,
+        "cpu_usage_pct": node.values.get("system.cpu_usage_pct"),
+        "ram_usage_pct": node.values.get("system.ram_usage_pct"),
+        "workers": worker_rows,
+        "targets": target_rows,
+        "net_queues": sorted(net_queues,
+                             key=lambda q: (q["shard"], q["priority"])),
+    }
+
+
+_stream = StatStream()
+
+
+def get_stream():
+    """Return the process-wide stream, starting it on first use."""
+    _stream.start()
+    return _stream
@@ -0,0 +1,97 @@
+/* Live page -- heatmaps of per-node stats from the stat subscription */
+
+(function () {
+    "use strict";
+
+    var POLL_MS = 1000;
+
+    /** Cell color from dark blue (low) to accent red (high). */
+    function heatColor(value, max) {
+        if (value === null || value === undefined) return "transparent";
+        var t = max > 0 ? Math.min(1, value / max) : 0;
+        var r = Math.round(15 + t * (233 - 15));
+        var g = Math.round(52 + t * (69 - 52));
+        return "rgb(" + r + "," + g + ",96)";
+    }
+
+    function formatValue(value) {
+        if (value === null || value === undefined) return "-";
+        return value >= 100 ? Math.round(value).toString() : value.toFixed(1);
+    }
+
+    /**
+     * Render one row per node and one cell per column key.
+     * rows: [{label, cells: {key: value}}]
+     */
+    function renderHeatmap(elementId, columns, rows) {
+        var max = 0;
+        rows.forEach(function (row) {
+            columns.forEach(function (col) {
+                var v = row.cells[col];
+                if (v !== null && v !== undefined && v > max) max = v;
+            });
+        });
+
+        var html = "<table><thead><tr><th>Node</th>";
+        columns.forEach(function (col) { html += "<th>" + col + "</th>"; });
+        html += "</tr></thead><tbody>";
+        rows.forEach(function (row) {
+            html += "<tr><td>" + row.label + "</td>";
+            columns.forEach(function (col) {
+                var v = row.cells[col];
+                html += '<td class="heat-cell" style="background:' +
+                    heatColor(v, max) + '">' + formatValue(v) + "</td>";
+            });
+            html += "</tr>";
+        });
+        html += "</tbody></table>";
+        document.getElementById(elementId).innerHTML = html;
+    }
+
+    function update(data) {
+        var workerCols = {};
+        var targetCols = {};
+        var workerRows = [];
+        var targetRows = [];
+        data.nodes.forEach(function (node) {
+            var label = node.node_id + (node.hostname ? " (" + node.hostname + ")" : "");
+            var wcells = {};
+            node.workers.forEach(function (w) {
+                var key = "W" + w.worker_id;
+                workerCols[key] = w.worker_id;
+                wcells[key] = w.tasks_per_s;
+            });
+            workerRows.push({ label: label, cells: wcells });
+            var tcells = {};
+            node.targets.forEach(function (t) {
+                targetCols[t.name] = true;
+                tcells[t.name] = t.read_latency_us;
+            });
+            targetRows.push({ label: label, cells: tcells });
+        });
+        var wkeys = Object.keys(workerCols).sort(function (a, b) {
+            return workerCols[a] - workerCols[b];
+        });
+        renderHeatmap("throughputHeatmap", wkeys, workerRows);
+        renderHeatmap("latencyHeatmap", Object.keys(targetCols).sort(), targetRows);
+    }
+
+    function poll() {
+        fetch("/api/live")
+            .then(function (r) { return r.json(); })
+            .then(function (data) {
+                var banner = document.getElementById("live-error");
+                if (data.error) {
+                    banner.textContent = data.error;
+                    banner.style.display = "block";
+                } else {
+                    banner.style.display = "none";
+                }
+                if (data.nodes) update(data);
+            })
+            .catch(function () {})
+            .finally(function () { setTimeout(poll, POLL_MS); });
+    }
+
+    document.addEventListener("DOMContentLoaded", poll);
+})();
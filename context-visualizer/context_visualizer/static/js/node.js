@@ -379,6 +379,7 @@
                         var mapeLabel = modelMode === "wall" ? "Wall MAPE" : "CPU MAPE";
                         tableHtml += '<table class="method-table"><thead><tr>' +
                             '<th>ID</th><th>Method</th><th>' + coeffLabel + '</th><th>' + mapeLabel + '</th>' +
+                            '<th>Avg Cost (us)</th>' +
                             '</tr></thead><tbody>';
                         activeMethods.forEach(function (m) {
                             var coeff = modelMode === "wall" ? (m.wall_coefficient || 0) : (m.coefficient || 0);
@@ -391,6 +392,7 @@
                                 '<td>' + coeff.toFixed(4) + '</td>' +
                                 '<td style="color:' + mapeColor + '">' +
                                     (mape * 100).toFixed(1) + '%</td>' +
+                                '<td>' + (m.avg_cost_us || 0).toFixed(1) + '</td>' +
                                 '</tr>';
                         });
                         tableHtml += '</tbody></table>';
@@ -0,0 +1,3 @@
+"""
+WRP Performance Regression Harness Package for IOWarp
+"""
@@ -0,0 +1,169 @@
+"""
+IOWarp Performance Regression Harness Package
+
+Runs the benchmark suite in CI/perf/suite.yaml through CI/perf/wrp_perf.py.
+It writes a JSON result file with an environment fingerprint and can compare
+it against a stored baseline.
+"""
+from jarvis_cd.core.pkg import Application
+import os
+import subprocess
+
+
+class WrpPerf(Application):
+    """
+    IOWarp Performance Regression Harness
+
+    Runs the selected suite benchmarks (by tag or name), writes
+    machine-readable JSON results, and, if a baseline is given, writes a
+    Markdown comparison report. The package fails when a metric regresses
+    beyond the threshold with statistical significance, or when a
+    benchmark fails.
+
+    Assumes the benchmark executables are in bin_dir or PATH.
+    """
+
+    def _init(self):
+        """Initialize harness variables"""
+        self.results_file = None
+        self.report_file = None
+
+    def _configure_menu(self):
+        """Define configuration options for the harness"""
+        return [
+            {
+                'name': 'repo_dir',
+                'msg': 'IOWarp core source directory (holds CI/perf)',
+                'type': str,
+                'default': os.path.expanduser('~/iowarp/core')
+            },
+            {
+                'name': 'bin_dir',
+                'msg': 'Directory holding the benchmark executables',
+                'type': str,
+                'default': '',
+                'help': 'Empty: look the executables up in PATH'
+            },
+            {
+                'name': 'suite',
+                'msg': 'Suite file (default: CI/perf/suite.yaml)',
+                'type': str,
+                'default': ''
+            },
+            {
+                'name': 'tags',
+                'msg': 'Run benchmarks having any of these tags',
+                'type': str,
+                'default': 'cpu net',
+                'help': 'Space-separated: cpu, net, runtime, cte, gpu'
+            },
+            {
+                'name': 'only',
+                'msg': 'Run only these benchmark names (space-separated)',
+                'type': str,
+                'default': ''
+            },
+            {
+                'name': 'repeat',
+                'msg': 'Repetitions per benchmark (0 = suite default)',
+                'type': int,
+                'default': 0
+            },
+            {
+                'name': 'label',
+                'msg': 'Label stored with the results',
+                'type': str,
+                'default': ''
+            },
+            {
+                'name': 'results',
+                'msg': 'Results JSON file name (in shared_dir)',
+                'type': str,
+                'default': 'perf_results.json'
+            },
+            {
+                'name': 'baseline',
+                'msg': 'Baseline results JSON to compare against',
+                'type': str,
+                'default': '',
+                'help': 'Empty: only run and record'
+            },
+            {
+                'name': 'threshold',
+                'msg': 'Relative change counted as a regression',
+                'type': float,
+                'default': 0.05
+            },
+            {
+                'name': 'alpha',
+                'msg': 'Significance level of the t-test',
+                'type': float,
+                'default': 0.05
+            },
+            {
+                'name': 'strict_env',
+                'msg': 'Fail if the environment fingerprints differ',
+                'type': bool,
+                'default': False
+            }
+        ]
+
+    def _configure(self, **kwargs):
+        """Resolve the harness, suite and output paths"""
+        self.harness = os.path.join(self.config['repo_dir'], 'CI', 'perf',
+                                    'wrp_perf.py')
+        self.suite = self.config['suite'] or os.path.join(
+            self.config['repo_dir'], 'CI', 'perf', 'suite.yaml')
+        self.results_file = os.path.join(self.shared_dir,
+                                         self.config['results'])
+        self.report_file = os.path.splitext(self.results_file)[0] + '.md'
+        if self.config['threshold'] <= 0:
+            raise ValueError('threshold must be > 0')
+        self.log(f"Perf harness: {self.harness}")
+        self.log(f"Results will be saved to: {self.results_file}")
+
+    def start(self):
+        """Run the suite, then compare against the baseline if one is set"""
+        cmd = ['python3', self.harness, 'run', '--suite', self.suite,
+               '-o', self.results_file]
+        if self.config['bin_dir']:
+            cmd += ['--bin-dir', self.config['bin_dir']]
+        if self.config['tags']:
+            cmd += ['--tags'] + self.config['tags'].split()
+        if self.config['only']:
+            cmd += ['--only'] + self.config['only'].split()
+        if self.config['repeat'] > 0:
+            cmd += ['--repeat', str(self.config['repeat'])]
+        if self.config['label']:
+            cmd += ['--label', self.config['label']]
+        self.log(f"Executing: {' '.join(cmd)}")
+        run_rc = subprocess.run(cmd, env=self.mod_env).returncode
+
+        if not self.config['baseline']:
+            if run_rc != 0:
+                raise RuntimeError(f'Benchmark failure; see {self.results_file}')
+            return
+        cmd = ['python3', self.harness, 'compare', self.config['baseline'],
+               self.results_file, '--suite', self.suite,
+               '--threshold', str(self.config['threshold']),
+               '--alpha', str(self.config['alpha']),
+               '--report', self.report_file]
+        if self.config['strict_env']:
+            cmd.append('--strict-env')
+        self.log(f"Executing: {' '.join(cmd)}")
+        cmp_rc = subprocess.run(cmd, env=self.mod_env).returncode
+        self.log(f"Comparison report: {self.report_file}")
+        if run_rc != 0 or cmp_rc != 0:
+            raise RuntimeError('Performance regression or benchmark failure; '
+                               f'see {self.report_file}')
+
+    def stop(self):
+        """The harness runs to completion"""
+        return True
+
+    def clean(self):
+        """Remove the results and report files"""
+        for path in (self.results_file, self.report_file):
+            if path and os.path.exists(path):
+                os.remove(path)
+                self.log(f"Removed: {path}")
@@ -0,0 +1,3 @@
+"""
+WRP Configuration Autotuner Package for IOWarp
+"""
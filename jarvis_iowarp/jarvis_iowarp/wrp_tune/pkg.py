@@ -0,0 +1,153 @@
+"""
+IOWarp Configuration Autotuner Package
+
+Runs CI/perf/wrp_tune.py over the search space in CI/perf/tune_space.yaml,
+scoring candidates with the perf suite or a recorded workload trace, and
+writes the best runtime YAML for this node.
+"""
+from jarvis_cd.core.pkg import Application
+import os
+import subprocess
+
+
+class WrpTune(Application):
+    """
+    IOWarp Configuration Autotuner
+
+    Searches worker counts, bdev queue depths, adapter page size, wire
+    compression and CTE stat periods with successive halving and writes the
+    winning config to shared_dir. The state file lives in shared_dir too,
+    so restarting the package resumes an interrupted search.
+
+    Assumes the benchmark executables are in bin_dir or PATH.
+    """
+
+    def _init(self):
+        """Initialize tuner variables"""
+        self.work_dir = None
+        self.output_file = None
+
+    def _configure_menu(self):
+        """Define configuration options for the tuner"""
+        return [
+            {
+                'name': 'repo_dir',
+                'msg': 'IOWarp core source directory (holds CI/perf)',
+                'type': str,
+                'default': os.path.expanduser('~/iowarp/core')
+            },
+            {
+                'name': 'bin_dir',
+                'msg': 'Directory holding the benchmark executables',
+                'type': str,
+                'default': '',
+                'help': 'Empty: look the executables up in PATH'
+            },
+            {
+                'name': 'space',
+                'msg': 'Space file (default: CI/perf/tune_space.yaml)',
+                'type': str,
+                'default': ''
+            },
+            {
+                'name': 'base_config',
+                'msg': 'Runtime YAML candidates start from',
+                'type': str,
+                'default': '',
+                'help': "Empty: the space file's base_config"
+            },
+            {
+                'name': 'trace',
+                'msg': 'Workload traces to tune against (space-separated)',
+                'type': str,
+                'default': '',
+                'help': 'Empty: use the objective benchmarks of the suite'
+            },
+            {
+                'name': 'candidates',
+                'msg': 'Configs tried in the first rung (base included)',
+                'type': int,
+                'default': 16
+            },
+            {
+                'name': 'eta',
+                'msg': 'Keep 1/eta of the candidates per rung',
+                'type': int,
+                'default': 2
+            },
+            {
+                'name': 'min_repeat',
+                'msg': 'Repetitions per benchmark in the first rung',
+                'type': int,
+                'default': 1
+            },
+            {
+                'name': 'seed',
+                'msg': 'Seed for drawing candidates',
+                'type': int,
+                'default': 0
+            },
+            {
+                'name': 'output',
+                'msg': 'Tuned config file name (in shared_dir)',
+                'type': str,
+                'default': 'tuned_chimaera.yaml'
+            },
+            {
+                'name': 'fresh',
+                'msg': 'Discard a previous search instead of resuming it',
+                'type': bool,
+                'default': False
+            }
+        ]
+
+    def _configure(self, **kwargs):
+        """Resolve the tuner, work and output paths"""
+        self.tuner = os.path.join(self.config['repo_dir'], 'CI', 'perf',
+                                  'wrp_tune.py')
+        self.work_dir = os.path.join(self.shared_dir, 'wrp_tune')
+        self.output_file = os.path.join(self.shared_dir,
+                                        self.config['output'])
+        if self.config['candidates'] < 2 or self.config['eta'] < 2:
+            raise ValueError('candidates and eta must be >= 2')
+        self.log(f"Tuner: {self.tuner}")
+        self.log(f"Tuned config will be saved to: {self.output_file}")
+
+    def start(self):
+        """Run or resume the search"""
+        cmd = ['python3', self.tuner, 'run', '--work-dir', self.work_dir,
+               '-o', self.output_file,
+               '--candidates', str(self.config['candidates']),
+               '--eta', str(self.config['eta']),
+               '--min-repeat', str(self.config['min_repeat']),
+               '--seed', str(self.config['seed'])]
+        if self.config['bin_dir']:
+            cmd += ['--bin-dir', self.config['bin_dir']]
+        if self.config['space']:
+            cmd += ['--space', self.config['space']]
+        if self.config['base_config']:
+            cmd += ['--base-config', self.config['base_config']]
+        if self.config['trace']:
+            cmd += ['--trace'] + self.config['trace'].split()
+        if self.config['fresh']:
+            cmd.append('--fresh')
+        self.log(f"Executing: {' '.join(cmd)}")
+        if subprocess.run(cmd, env=self.mod_env).returncode != 0:
+            raise RuntimeError(f'Tuning failed; see {self.work_dir}')
+
+    def stop(self):
+        """The tuner runs to completion"""
+        return True
+
+    def clean(self):
+        """Remove the search state, candidate configs and tuned config"""
+        if self.work_dir and os.path.isdir(self.work_dir):
+            for name in os.listdir(self.work_dir):
+                os.remove(os.path.join(self.work_dir, name))
+            os.rmdir(self.work_dir)
+            self.log(f"Removed: {self.work_dir}")
+        base = os.path.splitext(self.output_file or '')[0]
+        for path in (self.output_file, base + '.adapter.yaml'):
+            if path and os.path.exists(path):
+                os.remove(path)
+                self.log(f"Removed: {path}")